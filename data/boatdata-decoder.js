@@ -0,0 +1,273 @@
+/**
+ * Decoder for the /boatdata stream, shared by data/stream.html and the Node viewer
+ *
+ * The ESP32 sends /boatdata in one of three formats:
+ * - full JSON frames (no parameter)
+ * - ?mode=delta: a "keyframe" JSON frame, then "delta" frames holding the changed
+ *   fields of the changed groups
+ * - ?fmt=bin: one BoatDataSnapshot record per frame (src/utils/BoatDataSnapshot.h;
+ *   little-endian, no padding, fixed-point values, version 3, 122 bytes)
+ *
+ * A BoatDataDatagram is the "P2BD" magic and a uint32 sequence number followed
+ * by the same record. It is the UDP format, and a ?since= replay burst is a
+ * run of them in one binary frame.
+ *
+ * BoatDataStream keeps the state of one connection. decode() takes any of
+ * these messages and returns the frames in the full JSON frame's object
+ * shape, so the dashboard code never depends on the format. Keep
+ * SNAPSHOT_FIELDS in the struct's member order.
+ *
+ * Browser: <script src="/boatdata-decoder.js"> defines window.BoatDataDecoder.
+ * Node: require() of this file (nodejs-boatdata-viewer/server.js).
+ */
+(function (root, factory) {
+    if (typeof module === 'object' && module.exports) {
+        module.exports = factory();
+    } else {
+        root.BoatDataDecoder = factory();
+    }
+}(typeof self !== 'undefined' ? self : this, function () {
+    'use strict';
+
+    const SNAPSHOT_VERSION = 3;
+    const SNAPSHOT_SIZE = 122;
+    const ANGLE = 1e-4;  // rad per count
+    const DATAGRAM_MAGIC = 0x44423250;  // "P2BD" little-endian
+    const DATAGRAM_HEADER = 8;
+    const DATAGRAM_SIZE = DATAGRAM_HEADER + SNAPSHOT_SIZE;
+
+    // BoatDataGroup bits of the present bitmap
+    const SNAPSHOT_GROUPS = {
+        gps: 1 << 0,
+        compass: 1 << 1,
+        wind: 1 << 2,
+        dst: 1 << 3,
+        rudder: 1 << 4,
+        engine: 1 << 5,
+        saildrive: 1 << 6,
+        battery: 1 << 7,
+        shorePower: 1 << 8,
+        derived: 1 << 10
+    };
+
+    // Boolean fields in the flags byte (BoatDataSnapshotFlag)
+    const SNAPSHOT_FLAGS = [
+        ['saildrive', 'saildriveEngaged', 1 << 0],
+        ['battery', 'shoreChargerOnA', 1 << 1],
+        ['battery', 'engineChargerOnA', 1 << 2],
+        ['battery', 'shoreChargerOnB', 1 << 3],
+        ['battery', 'engineChargerOnB', 1 << 4],
+        ['shorePower', 'shorePowerOn', 1 << 5]
+    ];
+
+    // [group, key, type, scale] after the 8-byte header
+    const SNAPSHOT_FIELDS = [
+        ['gps', 'latitude', 'i32', 1e-7], ['gps', 'longitude', 'i32', 1e-7],
+        ['gps', 'cog', 'u16', ANGLE], ['gps', 'sog', 'u16', 0.01], ['gps', 'variation', 'i16', ANGLE],
+        ['gps', 'fixQuality', 'u8', 1], ['gps', 'satellites', 'u8', 1], ['gps', 'hdop', 'u16', 0.01],
+        ['compass', 'trueHeading', 'u16', ANGLE], ['compass', 'magneticHeading', 'u16', ANGLE],
+        ['compass', 'rateOfTurn', 'i16', ANGLE], ['compass', 'heelAngle', 'i16', ANGLE],
+        ['compass', 'pitchAngle', 'i16', ANGLE], ['compass', 'heave', 'i16', 0.001],
+        ['wind', 'apparentWindAngle', 'i16', ANGLE], ['wind', 'apparentWindSpeed', 'u16', 0.01],
+        ['dst', 'depth', 'u16', 0.01], ['dst', 'measuredBoatSpeed', 'u16', 0.01], ['dst', 'seaTemperature', 'i16', 0.01],
+        ['rudder', 'steeringAngle', 'i16', ANGLE],
+        ['engine', 'engineRev', 'u16', 1], ['engine', 'oilTemperature', 'i16', 0.1],
+        ['engine', 'alternatorVoltage', 'u16', 0.01],
+        ['battery', 'voltageA', 'u16', 0.01], ['battery', 'amperageA', 'i16', 0.1], ['battery', 'stateOfChargeA', 'u16', 0.1],
+        ['battery', 'voltageB', 'u16', 0.01], ['battery', 'amperageB', 'i16', 0.1], ['battery', 'stateOfChargeB', 'u16', 0.1],
+        ['shorePower', 'power', 'u16', 1],
+        ['derived', 'awaOffset', 'i16', ANGLE], ['derived', 'awaHeel', 'i16', ANGLE], ['derived', 'leeway', 'i16', ANGLE],
+        ['derived', 'stw', 'u16', 0.01], ['derived', 'tws', 'u16', 0.01], ['derived', 'twa', 'i16', ANGLE],
+        ['derived', 'wdir', 'u16', ANGLE], ['derived', 'vmg', 'i16', 0.01], ['derived', 'soc', 'u16', 0.01],
+        ['derived', 'doc', 'u16', ANGLE], ['derived', 'polarSpeed', 'u16', 0.01], ['derived', 'polarPerformance', 'u16', 0.1],
+        ['derived', 'targetTwa', 'i16', ANGLE], ['derived', 'targetVmg', 'i16', 0.01],
+        ['derived', 'twsAvg10s', 'u16', 0.01], ['derived', 'twsAvg1m', 'u16', 0.01], ['derived', 'twsAvg10m', 'u16', 0.01],
+        ['derived', 'wdirAvg10s', 'u16', ANGLE], ['derived', 'wdirAvg1m', 'u16', ANGLE], ['derived', 'wdirAvg10m', 'u16', ANGLE],
+        ['derived', 'vmgAvg10s', 'i16', 0.01], ['derived', 'vmgAvg1m', 'i16', 0.01], ['derived', 'vmgAvg10m', 'i16', 0.01],
+        ['derived', 'gust10s', 'u16', 0.01], ['derived', 'gust1m', 'u16', 0.01], ['derived', 'gust10m', 'u16', 0.01]
+    ];
+
+    function viewOf(bytes) {
+        return bytes instanceof ArrayBuffer
+            ? new DataView(bytes)
+            : new DataView(bytes.buffer, bytes.byteOffset, bytes.byteLength);
+    }
+
+    /**
+     * Decode one binary frame (ArrayBuffer, Buffer or typed array)
+     *
+     * @returns Object shaped like the JSON frame, or null for a short frame or another version
+     */
+    function decodeSnapshot(bytes) {
+        const view = viewOf(bytes);
+        if (view.byteLength < SNAPSHOT_SIZE || view.getUint8(0) !== SNAPSHOT_VERSION) {
+            return null;
+        }
+
+        const flags = view.getUint8(1);
+        const present = view.getUint16(2, true);
+        const timestamp = view.getUint32(4, true);
+
+        const data = { timestamp: timestamp };
+        for (const group in SNAPSHOT_GROUPS) {
+            data[group] = { available: (present & SNAPSHOT_GROUPS[group]) !== 0, lastUpdate: timestamp };
+        }
+
+        let offset = 8;
+        for (const [group, key, type, scale] of SNAPSHOT_FIELDS) {
+            let raw;
+            switch (type) {
+                case 'i32': raw = view.getInt32(offset, true); offset += 4; break;
+                case 'u16': raw = view.getUint16(offset, true); offset += 2; break;
+                case 'i16': raw = view.getInt16(offset, true); offset += 2; break;
+                default: raw = view.getUint8(offset); offset += 1; break;
+            }
+            data[group][key] = raw * scale;
+        }
+
+        for (const [group, key, bit] of SNAPSHOT_FLAGS) {
+            data[group][key] = (flags & bit) !== 0;
+        }
+
+        // 0 = no polar loaded
+        if (data.derived.polarSpeed === 0) {
+            data.derived.polarSpeed = null;
+        }
+        return data;
+    }
+
+    /**
+     * Decode one BoatDataDatagram (a UDP datagram)
+     *
+     * @returns { sequence, data }, or null for a foreign datagram, a short one or another version
+     */
+    function decodeDatagram(bytes) {
+        const view = viewOf(bytes);
+        if (view.byteLength < DATAGRAM_SIZE || view.getUint32(0, true) !== DATAGRAM_MAGIC) {
+            return null;
+        }
+        const data = decodeSnapshot(new Uint8Array(view.buffer, view.byteOffset + DATAGRAM_HEADER, SNAPSHOT_SIZE));
+        return data ? { sequence: view.getUint32(4, true), data: data } : null;
+    }
+
+    /**
+     * Decode a run of BoatDataDatagrams (a ?since= replay burst), oldest first
+     *
+     * @returns Decoded snapshots, or null if the frame does not start with the magic
+     */
+    function decodeReplay(bytes) {
+        const view = viewOf(bytes);
+        if (view.byteLength < DATAGRAM_SIZE || view.getUint32(0, true) !== DATAGRAM_MAGIC) {
+            return null;
+        }
+        const frames = [];
+        for (let offset = 0; offset + DATAGRAM_SIZE <= view.byteLength; offset += DATAGRAM_SIZE) {
+            const datagram = decodeDatagram(new Uint8Array(view.buffer, view.byteOffset + offset, DATAGRAM_SIZE));
+            if (datagram) frames.push(datagram.data);
+        }
+        return frames;
+    }
+
+    /**
+     * State of one /boatdata connection: the last full frame with every later delta merged in
+     *
+     * Usage pattern:
+     *     const stream = new BoatDataStream();
+     *     ws.onmessage = (event) => {
+     *         const result = stream.decode(event.data);
+     *         if (result.message) handleOther(result.message);           // status, subscribe reply
+     *         if (result.frames.length) updateDashboard(stream.state);
+     *     };
+     *
+     * Call reset() on every reconnect; a delta before the first keyframe is dropped.
+     */
+    class BoatDataStream {
+        constructor() {
+            this.state = null;
+            this.timestamp = null;  // Device timestamp of the newest frame, for ?since=
+            this.deltas = 0;
+            this.dropped = 0;       // Deltas before a keyframe, unknown binary frames
+        }
+
+        reset() {
+            this.state = null;
+        }
+
+        /**
+         * Apply one WebSocket message: a string, an ArrayBuffer or a Node Buffer
+         *
+         * @p isBinary is only needed for a Node Buffer (ws passes it); without it, a
+         * string is text and anything else binary.
+         *
+         * @returns { frames, changed, message }. frames holds each snapshot the message
+         * brought, oldest first. For a delta that is the merged state (the same
+         * object as this.state), and for a replay burst every replayed snapshot.
+         * changed is the delta message itself for a delta, else null (everything may
+         * have changed). message is any other JSON message (proxy status, subscribe
+         * reply), else null.
+         */
+        decode(data, isBinary) {
+            const binary = isBinary !== undefined ? isBinary : typeof data !== 'string';
+            if (binary) {
+                const replay = decodeReplay(data);
+                const frames = replay || [decodeSnapshot(data)].filter((frame) => frame !== null);
+                if (frames.length === 0) {
+                    this.dropped++;
+                    return { frames: frames, changed: null, message: null };
+                }
+                return { frames: frames.map((frame) => this.replace(frame)), changed: null, message: null };
+            }
+
+            const message = JSON.parse(typeof data === 'string' ? data : new TextDecoder().decode(data));
+            if (message.type === 'delta') {
+                if (!this.state) {
+                    this.dropped++;  // Wait for the first keyframe
+                    return { frames: [], changed: null, message: null };
+                }
+                this.merge(message);
+                this.deltas++;
+                return { frames: [this.state], changed: message, message: null };
+            }
+            if (message.type === 'keyframe' || (message.type === undefined && message.status === undefined)) {
+                return { frames: [this.replace(message)], changed: null, message: null };
+            }
+            return { frames: [], changed: null, message: message };
+        }
+
+        /** The state as a keyframe object (the proxy sends it to a browser that connects mid-stream) */
+        keyframe() {
+            return this.state ? Object.assign({}, this.state, { type: 'keyframe' }) : null;
+        }
+
+        replace(frame) {
+            this.state = frame;
+            if (typeof frame.timestamp === 'number') this.timestamp = frame.timestamp;
+            return frame;
+        }
+
+        merge(delta) {
+            for (const key in delta) {
+                const value = delta[key];
+                if (key === 'type') {
+                    continue;
+                }
+                if (value !== null && typeof value === 'object' && this.state[key]) {
+                    Object.assign(this.state[key], value);
+                } else {
+                    this.state[key] = value;
+                }
+            }
+            if (typeof delta.timestamp === 'number') this.timestamp = delta.timestamp;
+        }
+    }
+
+    return {
+        SNAPSHOT_VERSION: SNAPSHOT_VERSION,
+        SNAPSHOT_SIZE: SNAPSHOT_SIZE,
+        DATAGRAM_SIZE: DATAGRAM_SIZE,
+        decodeSnapshot: decodeSnapshot,
+        decodeDatagram: decodeDatagram,
+        decodeReplay: decodeReplay,
+        BoatDataStream: BoatDataStream
+    };
+}));
@@ -0,0 +1,58 @@
+/**
+ * Service worker of the BoatData dashboard: versioned app shell cache
+ *
+ * Registered by stream.html (ESP32 /stream, Node viewer /stream.html) with
+ * its own path in `?shell=`. On install it caches the page and
+ * /boatdata-decoder.js. From then on it answers those requests from the
+ * cache without asking the server, so a reload or a reconnect costs the
+ * gateway only the WebSocket handshake, and the page even opens while the
+ * gateway is offline (it shows "disconnected" and keeps retrying).
+ *
+ * SHELL_VERSION is the hash of the shell files. tools/gzip_assets.py stamps
+ * it into stream-sw.js.gz, and the Node viewer stamps it when serving, so a
+ * changed dashboard changes this script. The browser checks the script on
+ * navigation, at most once per HTTP max-age (STREAM_SW_MAX_AGE_S on the
+ * ESP32). A new version installs the new shell beside the old one,
+ * takes over, and deletes the old cache; stream.html then reloads once. An
+ * unstamped copy (the uncompressed file, served to a client without gzip)
+ * caches nothing and leaves every request to the network.
+ */
+
+const SHELL_VERSION = '__SHELL_VERSION__';
+const CACHE_PREFIX = 'poseidon2-shell-';
+const CACHE_NAME = CACHE_PREFIX + SHELL_VERSION;
+const STAMPED = SHELL_VERSION.indexOf('__') !== 0;
+
+const shellPage = new URL(self.location.href).searchParams.get('shell') || '/stream';
+const SHELL = [shellPage, '/boatdata-decoder.js'];
+
+self.addEventListener('install', (event) => {
+    if (!STAMPED) {
+        self.skipWaiting();
+        return;
+    }
+    // no-cache: revalidate with the server (304 if unchanged) rather than copy a stale HTTP cache entry
+    event.waitUntil(caches.open(CACHE_NAME)
+        .then((cache) => cache.addAll(SHELL.map((url) => new Request(url, { cache: 'no-cache' }))))
+        .then(() => self.skipWaiting()));
+});
+
+self.addEventListener('activate', (event) => {
+    event.waitUntil(caches.keys()
+        .then((names) => Promise.all(names
+            .filter((name) => name.indexOf(CACHE_PREFIX) === 0 && name !== CACHE_NAME)
+            .map((name) => caches.delete(name))))
+        .then(() => self.clients.claim()));
+});
+
+self.addEventListener('fetch', (event) => {
+    const url = new URL(event.request.url);
+    if (!STAMPED || event.request.method !== 'GET' || url.origin !== self.location.origin ||
+        SHELL.indexOf(url.pathname) < 0) {
+        return;  // Everything else (APIs, other pages) goes to the network as usual
+    }
+    // ignoreSearch: /stream?fmt=bin is the same page
+    event.respondWith(caches.open(CACHE_NAME)
+        .then((cache) => cache.match(url.pathname, { ignoreSearch: true }))
+        .then((cached) => cached || fetch(event.request)));
+});
@@ -0,0 +1,339 @@
+/**
+ * Gateway connections and the merge of several gateways into one stream
+ *
+ * A Gateway is one Poseidon2 unit. Over WebSocket ("json", "delta" or "bin")
+ * it connects to /boatdata and reconnects on its own timer. With "udp" it is
+ * fed the multicast datagrams from its address (see handleDatagram()). Each
+ * gateway has its own BoatDataStream decoder (`stream`). It emits 'frame'
+ * (data, isBinary) for every message and 'status' (connected) when its
+ * connection changes.
+ *
+ * Backpressure is per gateway. Above maxRateHz frames per second, a WebSocket
+ * gateway's TCP socket is paused until the frame is due. The window then
+ * fills, and that ESP32 skips frames for this client as it does for any slow
+ * client (a delta client gets a keyframe once it catches up). A burst from
+ * one unit, such as a replay or a firmware at a higher rate, therefore never
+ * delays the others. UDP datagrams above the rate are dropped; each one is a
+ * full snapshot.
+ *
+ * GatewayMerger builds the unified stream: last writer wins per field.
+ * - A delta writes the fields it holds.
+ * - A full frame writes every field of each available group whose lastUpdate
+ *   advanced.
+ * - A group is available while any gateway reports it available. Each group
+ *   carries `source`, the gateway that wrote it last; sources() has the
+ *   writer of every field.
+ * - flush() returns the fields changed since the last flush as one "delta"
+ *   message. keyframe() returns the whole state for a browser that connects.
+ */
+
+const EventEmitter = require('events');
+const path = require('path');
+const WebSocket = require('ws');
+const { BoatDataStream } = require(path.join(__dirname, '..', 'data', 'boatdata-decoder.js'));
+
+class Gateway extends EventEmitter {
+    constructor(options) {
+        super();
+        this.name = options.name || options.ip;
+        this.ip = options.ip;
+        this.port = options.port || 80;
+        this.wsPath = options.wsPath || '/boatdata';
+        this.format = options.format || 'json';
+        this.reconnectInterval = options.reconnectInterval || 5000;
+        this.minIntervalMs = options.maxRateHz > 0 ? 1000 / options.maxRateHz : 0;
+
+        this.stream = new BoatDataStream();
+        this.client = null;
+        this.connected = false;
+        this.stopped = false;
+        this.reconnectTimer = null;
+        this.resumeTimer = null;
+        this.udpTimeoutTimer = null;
+        this.lastFrameMs = 0;
+
+        this.stats = { frames: 0, connects: 0, paused: 0, dropped: 0, lastMessageTime: null };
+        this.udp = { received: 0, lost: 0, outOfOrder: 0, lastSequence: null };
+    }
+
+    get udpFormat() {
+        return this.format === 'udp';
+    }
+
+    /** Connect (WebSocket formats); a UDP gateway waits for handleDatagram() */
+    start() {
+        this.stopped = false;
+        if (!this.udpFormat) {
+            this.connect();
+        }
+    }
+
+    stop() {
+        this.stopped = true;
+        clearTimeout(this.reconnectTimer);
+        clearTimeout(this.resumeTimer);
+        clearTimeout(this.udpTimeoutTimer);
+        if (this.client) {
+            this.client.close();
+        }
+    }
+
+    connect() {
+        if (this.client) {
+            this.client.terminate();
+            this.client = null;
+        }
+        const query = this.format === 'bin' ? '?fmt=bin' : (this.format === 'delta' ? '?mode=delta' : '');
+        const url = `ws://${this.ip}:${this.port}${this.wsPath}${query}`;
+        console.log(`[${this.name}] Connecting to ${url}...`);
+
+        try {
+            this.client = new WebSocket(url, {
+                handshakeTimeout: 5000,
+                perMessageDeflate: false,
+                skipUTF8Validation: true  // Text is relayed unread; the browsers validate it
+            });
+        } catch (error) {
+            console.error(`[${this.name}] Failed to create WebSocket:`, error.message);
+            this.scheduleReconnect();
+            return;
+        }
+
+        this.client.on('open', () => {
+            this.stats.connects++;
+            this.stream.reset();  // The ESP32 starts a delta connection with a keyframe
+            console.log(`[${this.name}] ✓ Connected to ${this.ip}`);
+            this.setConnected(true);
+        });
+
+        // A frame ahead of the rate is still processed (deltas cannot be skipped); the
+        // socket then pauses for the difference
+        this.client.on('message', (data, isBinary) => {
+            const wait = this.minIntervalMs - (Date.now() - this.lastFrameMs);
+            this.receive(data, isBinary);
+            if (wait > 0) {
+                this.pause(wait);
+            }
+        });
+
+        this.client.on('close', () => {
+            console.log(`[${this.name}] ✗ Connection closed`);
+            clearTimeout(this.resumeTimer);
+            this.setConnected(false);
+            this.scheduleReconnect();
+        });
+
+        // 'close' follows and schedules the reconnect
+        this.client.on('error', (error) => {
+            console.error(`[${this.name}] Connection error:`, error.message);
+        });
+    }
+
+    /**
+     * Feed one UDP datagram from this gateway's address (already decoded once by the caller)
+     *
+     * Sequence numbers: stale/duplicate datagrams are skipped and gaps counted;
+     * a large step back is a reboot.
+     */
+    handleDatagram(message, datagram) {
+        const last = this.udp.lastSequence;
+        if (last !== null) {
+            const step = (datagram.sequence - last) >>> 0;
+            if (step === 0 || (step > 0x80000000 && last - datagram.sequence < 1000)) {
+                this.udp.outOfOrder++;
+                return;
+            }
+            if (step < 0x80000000) {
+                this.udp.lost += step - 1;
+            }
+        }
+        this.udp.lastSequence = datagram.sequence;
+        this.udp.received++;
+
+        if (!this.connected) {
+            console.log(`[${this.name}] ✓ Receiving datagrams from ${this.ip}`);
+            this.setConnected(true);
+        }
+        clearTimeout(this.udpTimeoutTimer);
+        this.udpTimeoutTimer = setTimeout(() => {
+            console.log(`[${this.name}] ✗ No datagrams received`);
+            this.setConnected(false);
+        }, this.reconnectInterval);
+
+        const now = Date.now();
+        if (this.minIntervalMs > 0 && now - this.lastFrameMs < this.minIntervalMs) {
+            this.stats.dropped++;
+            return;
+        }
+        this.receive(message, true);  // A datagram is a one-record replay burst to the decoder
+    }
+
+    receive(data, isBinary) {
+        this.stats.lastMessageTime = Date.now();
+        this.lastFrameMs = this.stats.lastMessageTime;
+        this.stats.frames++;
+        this.emit('frame', data, isBinary);
+    }
+
+    // Stop reading the socket for @p ms (WebSocket gateways above maxRateHz)
+    pause(ms) {
+        const socket = this.client && this.client._socket;
+        if (!socket || this.resumeTimer) {
+            return;
+        }
+        this.stats.paused++;
+        socket.pause();
+        this.resumeTimer = setTimeout(() => {
+            this.resumeTimer = null;
+            socket.resume();
+        }, ms);
+    }
+
+    setConnected(connected) {
+        if (this.connected === connected) {
+            return;
+        }
+        this.connected = connected;
+        this.emit('status', connected);
+    }
+
+    scheduleReconnect() {
+        if (this.stopped) {
+            return;
+        }
+        clearTimeout(this.reconnectTimer);
+        console.log(`[${this.name}] Reconnecting in ${this.reconnectInterval / 1000} seconds...`);
+        this.reconnectTimer = setTimeout(() => this.connect(), this.reconnectInterval);
+    }
+
+    /** GET /api/gateways entry */
+    toJSON() {
+        return {
+            name: this.name,
+            ip: this.ip,
+            port: this.port,
+            format: this.format,
+            connected: this.connected,
+            frames: this.stats.frames,
+            connects: this.stats.connects,
+            paused: this.stats.paused,
+            dropped: this.stats.dropped,
+            lastMessageTime: this.stats.lastMessageTime ? new Date(this.stats.lastMessageTime).toISOString() : null,
+            udp: this.udpFormat ? Object.assign({}, this.udp) : null
+        };
+    }
+}
+
+class GatewayMerger {
+    constructor() {
+        this.state = {};
+        this.fieldSources = {};   // group -> key -> gateway name
+        this.availableBy = {};    // group -> Set of gateway names reporting it available
+        this.lastUpdates = {};    // gateway name -> group -> lastUpdate of its last write
+        this.pending = {};        // group -> changed fields since the last flush
+    }
+
+    /**
+     * Merge one decoded message of gateway @p name
+     *
+     * @p frame is the gateway's state after the message (BoatDataStream), and
+     * @p changed the delta itself or null for a full frame.
+     */
+    apply(name, frame, changed) {
+        const seen = this.lastUpdates[name] || (this.lastUpdates[name] = {});
+        const groups = changed || frame;
+        for (const group in groups) {
+            const values = groups[group];
+            if (values === null || typeof values !== 'object') {
+                continue;  // timestamp, type
+            }
+            const full = frame[group] || values;
+            if (full.available === false) {
+                this.setAvailable(name, group, false);
+                continue;
+            }
+            if (!changed && full.lastUpdate !== undefined && seen[group] === full.lastUpdate) {
+                continue;  // Not updated since the gateway's previous frame
+            }
+            seen[group] = full.lastUpdate;
+            this.setAvailable(name, group, true);
+            for (const key in values) {
+                if (key !== 'available' && key !== 'source') {
+                    this.write(name, group, key, values[key]);
+                }
+            }
+        }
+    }
+
+    /** Gateway @p name went away: its groups no longer count as available */
+    drop(name) {
+        for (const group in this.availableBy) {
+            this.setAvailable(name, group, false);
+        }
+        delete this.lastUpdates[name];
+    }
+
+    /** Fields changed since the last call as a "delta" message, or null */
+    flush() {
+        if (Object.keys(this.pending).length === 0) {
+            return null;
+        }
+        const delta = Object.assign({ type: 'delta', timestamp: Date.now() }, this.pending);
+        this.pending = {};
+        return delta;
+    }
+
+    /** Whole state as a "keyframe" message, or null before the first frame */
+    keyframe() {
+        if (Object.keys(this.state).length === 0) {
+            return null;
+        }
+        return Object.assign({ type: 'keyframe', timestamp: Date.now() }, this.state);
+    }
+
+    /** Writer of each field: { "gps.sog": "aft", ... } */
+    sources() {
+        const result = {};
+        for (const group in this.fieldSources) {
+            for (const key in this.fieldSources[group]) {
+                result[`${group}.${key}`] = this.fieldSources[group][key];
+            }
+        }
+        return result;
+    }
+
+    write(name, group, key, value) {
+        const values = this.state[group] || (this.state[group] = {});
+        const sources = this.fieldSources[group] || (this.fieldSources[group] = {});
+        sources[key] = name;
+        if (values[key] !== value) {
+            values[key] = value;
+            this.change(group, key, value);
+        }
+        if (values.source !== name) {
+            values.source = name;
+            this.change(group, 'source', name);
+        }
+    }
+
+    setAvailable(name, group, available) {
+        const set = this.availableBy[group] || (this.availableBy[group] = new Set());
+        if (available) {
+            set.add(name);
+        } else {
+            set.delete(name);
+        }
+        const values = this.state[group] || (this.state[group] = {});
+        if (values.available !== set.size > 0) {
+            values.available = set.size > 0;
+            this.change(group, 'available', values.available);
+        }
+    }
+
+    change(group, key, value) {
+        const fields = this.pending[group] || (this.pending[group] = {});
+        fields[key] = value;
+    }
+}
+
+module.exports = { Gateway, GatewayMerger };
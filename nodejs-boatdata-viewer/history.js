@@ -0,0 +1,308 @@
+/**
+ * History of the relayed snapshots, kept by the proxy
+ *
+ * Every snapshot the proxy relays passes through here, so the dashboard's
+ * graphs come from the proxy and never from the ESP32. At most one snapshot
+ * per intervalMs is recorded. Its numeric fields ("group.key": gps.sog,
+ * derived.tws, ...; booleans as 0/1) go into a ring of `capacity` rows with
+ * one Float64Array per field. A group that is not available records NaN,
+ * which queries skip. A field first seen later gets NaN for the older rows.
+ *
+ * query() downsamples on the server: a time range is cut into buckets of
+ * `step` ms and each bucket reports min, max and mean. The response therefore
+ * stays small, whether the range holds a minute or a day of data.
+ *
+ * With `file` set, each row is also appended to that file as one JSON line,
+ * and the rows are loaded back on start. A line `{"fields":[...]}` names the
+ * columns of the array lines `[t, v0, v1, ...]` that follow it (null is NaN).
+ * Once the file holds twice `capacity` rows it is rewritten with the ring's
+ * contents.
+ */
+
+const fs = require('fs');
+
+const DEFAULT_BUCKETS = 500;
+const MAX_BUCKETS = 5000;
+
+class HistoryStore {
+    constructor(options = {}) {
+        this.capacity = options.capacity || 21600;
+        this.intervalMs = options.intervalMs || 1000;
+        this.file = options.file || null;
+
+        this.times = new Float64Array(this.capacity);
+        this.columns = new Map();  // "group.key" -> Float64Array(capacity)
+        this.head = 0;             // Next row to write
+        this.count = 0;
+        this.lastRecordMs = -Infinity;
+
+        this.fd = null;
+        this.fileRows = 0;
+        this.fileFields = null;    // Column order of the file's current header
+        this.writeErrors = 0;
+
+        if (this.file) {
+            this.load();
+            this.compact();
+        }
+    }
+
+    /** True if a snapshot taken at @p nowMs would be recorded (check before parsing one) */
+    due(nowMs = Date.now()) {
+        return nowMs - this.lastRecordMs >= this.intervalMs;
+    }
+
+    /**
+     * Record @p snapshot (the relayed object: { gps: {...}, wind: {...}, ... })
+     *
+     * @returns false if the last row is less than intervalMs old
+     */
+    record(snapshot, nowMs = Date.now()) {
+        if (!this.due(nowMs) || snapshot === null || typeof snapshot !== 'object') {
+            return false;
+        }
+        this.lastRecordMs = nowMs;
+
+        const row = this.head;
+        this.times[row] = nowMs;
+        for (const column of this.columns.values()) {
+            column[row] = NaN;
+        }
+        for (const group in snapshot) {
+            const values = snapshot[group];
+            if (values === null || typeof values !== 'object' || values.available === false) {
+                continue;
+            }
+            for (const key in values) {
+                const value = values[key];
+                if (key === 'lastUpdate' || key === 'available') {
+                    continue;
+                }
+                if (typeof value === 'number' || typeof value === 'boolean') {
+                    this.column(`${group}.${key}`)[row] = Number(value);
+                }
+            }
+        }
+
+        this.head = (this.head + 1) % this.capacity;
+        this.count = Math.min(this.count + 1, this.capacity);
+        this.append(row);
+        return true;
+    }
+
+    /** Recorded field names */
+    fields() {
+        return Array.from(this.columns.keys());
+    }
+
+    /** Time of the oldest and newest row (null when empty) */
+    range() {
+        if (this.count === 0) {
+            return { from: null, to: null };
+        }
+        return { from: this.times[this.index(0)], to: this.times[this.index(this.count - 1)] };
+    }
+
+    /**
+     * Downsample @p field between @p from and @p to (ms since the epoch)
+     *
+     * @p step is the bucket width in ms. By default the range is split into
+     * DEFAULT_BUCKETS buckets, and never into more than MAX_BUCKETS. Returns
+     * null for an unknown field. Otherwise the result is columnar: t (bucket
+     * start), min, max, mean and n (values in the bucket). Buckets without
+     * values are left out.
+     */
+    query(field, from, to, step) {
+        const column = this.columns.get(field);
+        if (!column) {
+            return null;
+        }
+        const range = this.range();
+        to = Number.isFinite(to) ? to : (range.to !== null ? range.to : Date.now());
+        from = Number.isFinite(from) ? from : to - 3600 * 1000;
+        const span = Math.max(to - from, 1);
+        if (!Number.isFinite(step) || step <= 0) {
+            step = Math.ceil(span / DEFAULT_BUCKETS);
+        }
+        step = Math.max(step, Math.ceil(span / MAX_BUCKETS), 1);
+
+        const result = { field: field, from: from, to: to, step: step, t: [], min: [], max: [], mean: [], n: [] };
+        let bucket = -1;
+        let min = 0, max = 0, sum = 0, n = 0;
+        const flush = () => {
+            if (n > 0) {
+                result.t.push(from + bucket * step);
+                result.min.push(min);
+                result.max.push(max);
+                result.mean.push(sum / n);
+                result.n.push(n);
+            }
+        };
+
+        for (let i = this.lowerBound(from); i < this.count; i++) {
+            const row = this.index(i);
+            const t = this.times[row];
+            if (t > to) {
+                break;
+            }
+            const value = column[row];
+            if (Number.isNaN(value)) {
+                continue;
+            }
+            const b = Math.floor((t - from) / step);
+            if (b !== bucket) {
+                flush();
+                bucket = b;
+                min = max = sum = value;
+                n = 1;
+                continue;
+            }
+            min = Math.min(min, value);
+            max = Math.max(max, value);
+            sum += value;
+            n++;
+        }
+        flush();
+        return result;
+    }
+
+    /** Close the file */
+    close() {
+        if (this.fd !== null) {
+            fs.closeSync(this.fd);
+            this.fd = null;
+        }
+    }
+
+    // Ring position of the i-th oldest row
+    index(i) {
+        return (this.head - this.count + i + this.capacity) % this.capacity;
+    }
+
+    // First row (by age) at or after @p t; rows are in time order
+    lowerBound(t) {
+        let lo = 0, hi = this.count;
+        while (lo < hi) {
+            const mid = (lo + hi) >> 1;
+            if (this.times[this.index(mid)] < t) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        return lo;
+    }
+
+    column(field) {
+        let column = this.columns.get(field);
+        if (!column) {
+            column = new Float64Array(this.capacity).fill(NaN);
+            this.columns.set(field, column);
+        }
+        return column;
+    }
+
+    rowValues(row) {
+        return Array.from(this.columns.values(), (column) => (Number.isNaN(column[row]) ? null : column[row]));
+    }
+
+    // Write @p row to the file, with a new header whenever the field set has grown
+    append(row) {
+        if (!this.file) {
+            return;
+        }
+        if (this.fileRows >= 2 * this.capacity) {
+            this.compact();
+            return;
+        }
+        let text = '';
+        if (this.fileFields === null || this.fileFields.length !== this.columns.size) {
+            this.fileFields = this.fields();
+            text += JSON.stringify({ fields: this.fileFields }) + '\n';
+        }
+        text += JSON.stringify([this.times[row]].concat(this.rowValues(row))) + '\n';
+        // One small synchronous write per row: a crash loses at most the row being written
+        try {
+            if (this.fd === null) {
+                this.fd = fs.openSync(this.file, 'a');
+            }
+            fs.writeSync(this.fd, text);
+            this.fileRows++;
+        } catch (error) {
+            this.writeErrors++;
+            console.error(`[HISTORY] Write to ${this.file} failed:`, error.message);
+        }
+    }
+
+    // Replace the file by the ring's rows
+    compact() {
+        this.close();
+        const lines = [];
+        if (this.count > 0) {
+            this.fileFields = this.fields();
+            lines.push(JSON.stringify({ fields: this.fileFields }));
+            for (let i = 0; i < this.count; i++) {
+                const row = this.index(i);
+                lines.push(JSON.stringify([this.times[row]].concat(this.rowValues(row))));
+            }
+        } else {
+            this.fileFields = null;
+        }
+        try {
+            fs.writeFileSync(this.file + '.tmp', lines.length ? lines.join('\n') + '\n' : '');
+            fs.renameSync(this.file + '.tmp', this.file);
+            this.fileRows = this.count;
+        } catch (error) {
+            this.writeErrors++;
+            console.error(`[HISTORY] Rewrite of ${this.file} failed:`, error.message);
+        }
+    }
+
+    // Read the rows of the file into the ring (the newest `capacity` rows stay)
+    load() {
+        let text;
+        try {
+            text = fs.readFileSync(this.file, 'utf8');
+        } catch (error) {
+            if (error.code !== 'ENOENT') {
+                console.error(`[HISTORY] Cannot read ${this.file}:`, error.message);
+            }
+            return;
+        }
+        let fields = null;
+        let skipped = 0;
+        for (const line of text.split('\n')) {
+            if (line === '') {
+                continue;
+            }
+            let entry;
+            try {
+                entry = JSON.parse(line);
+            } catch (error) {
+                skipped++;  // A line cut short by a crash
+                continue;
+            }
+            if (!Array.isArray(entry)) {
+                fields = Array.isArray(entry.fields) ? entry.fields : null;
+                continue;
+            }
+            if (fields === null || entry.length !== fields.length + 1) {
+                skipped++;
+                continue;
+            }
+            const row = this.head;
+            this.times[row] = entry[0];
+            for (const column of this.columns.values()) {
+                column[row] = NaN;
+            }
+            fields.forEach((field, i) => {
+                this.column(field)[row] = entry[i + 1] === null ? NaN : entry[i + 1];
+            });
+            this.head = (this.head + 1) % this.capacity;
+            this.count = Math.min(this.count + 1, this.capacity);
+        }
+        console.log(`[HISTORY] Loaded ${this.count} rows from ${this.file}` + (skipped ? ` (${skipped} bad lines)` : ''));
+    }
+}
+
+module.exports = { HistoryStore, DEFAULT_BUCKETS, MAX_BUCKETS };
@@ -0,0 +1,256 @@
+/**
+ * Per-subscription field projection and rate limiting for browser clients
+ *
+ * A browser asks for part of the stream in the /boatdata query:
+ *
+ *     ws://proxy:3000/boatdata?fields=derived.tws,derived.twa,gps&maxHz=1
+ *
+ * `fields` lists whole groups ("gps") or single fields ("derived.tws");
+ * `maxHz` caps the messages per second. Clients with the same subscription
+ * share one Projection: the proxy projects the state once per subscription,
+ * not once per client, and builds each message once for all its clients.
+ *
+ * A Projection keeps the values it last sent. When the state changes it
+ * sends a "delta" with the projected fields that differ, at most every
+ * 1/maxHz seconds; changes in between are collected into the next delta,
+ * so a slow subscription gets the latest values, not a backlog. A client
+ * that connects gets a "keyframe" with the projection's whole state. Each
+ * projected group carries `available` and `lastUpdate` (and `source` when
+ * gateways are merged), so the dashboard's staleness display keeps working.
+ *
+ * Deltas only make sense in order, so a client that skipped one (socket
+ * above maxBufferedBytes) gets a keyframe once it has caught up.
+ */
+
+// Sent with every projected group; the dashboard needs them to judge the values
+const GROUP_META = ['available', 'lastUpdate', 'source'];
+const MAX_FIELDS = 64;
+
+/**
+ * The subscription of a /boatdata request, or null for the full stream
+ *
+ * @param query URLSearchParams of the request
+ * @param defaultMaxHz Rate of a client without maxHz (0 = unlimited)
+ * @throws Error for bad parameters
+ */
+function parseSubscription(query, defaultMaxHz = 0) {
+    const fieldsParam = query.get('fields');
+    const hzParam = query.get('maxHz');
+    const maxRateHz = hzParam !== null ? Number(hzParam) : defaultMaxHz;
+    if (!Number.isFinite(maxRateHz) || maxRateHz < 0) {
+        throw new Error(`maxHz must be a number >= 0, got "${hzParam}"`);
+    }
+
+    let fields = null;
+    if (fieldsParam !== null) {
+        const names = fieldsParam.split(',').map((name) => name.trim()).filter((name) => name !== '');
+        if (names.length === 0 || names.length > MAX_FIELDS) {
+            throw new Error(`fields must list 1 to ${MAX_FIELDS} groups or group.field names`);
+        }
+        for (const name of names) {
+            if (!/^[A-Za-z0-9_]+(\.[A-Za-z0-9_]+)?$/.test(name)) {
+                throw new Error(`bad field "${name}" (use group or group.field)`);
+            }
+        }
+        // Canonical form, so equal subscriptions share a projection whatever their order
+        const groups = new Set(names.filter((name) => name.indexOf('.') < 0));
+        fields = Array.from(new Set(names.filter((name) => name.indexOf('.') < 0 || !groups.has(name.split('.')[0])))).sort();
+    }
+    if (fields === null && maxRateHz === 0) {
+        return null;
+    }
+    return {
+        fields: fields,
+        maxRateHz: maxRateHz,
+        key: (fields ? fields.join(',') : '*') + '@' + maxRateHz
+    };
+}
+
+class Projection {
+    /**
+     * @param subscription parseSubscription() result
+     * @param send (projection, message object, clients) writes one message to the clients
+     */
+    constructor(subscription, send) {
+        this.subscription = subscription;
+        this.intervalMs = subscription.maxRateHz > 0 ? 1000 / subscription.maxRateHz : 0;
+        this.send = send;
+        this.clients = new Set();
+        this.sent = {};           // group -> key -> value last sent
+        this.lastSentAt = 0;
+        this.timer = null;
+        this.messages = 0;
+        this.coalesced = 0;       // Updates folded into a later delta by the rate limit
+
+        // null = every field of the group
+        this.groups = null;
+        if (subscription.fields) {
+            this.groups = {};
+            for (const name of subscription.fields) {
+                const [group, key] = name.split('.');
+                if (key === undefined) {
+                    this.groups[group] = null;
+                } else if (this.groups[group] !== null) {
+                    (this.groups[group] || (this.groups[group] = new Set())).add(key);
+                }
+            }
+        }
+    }
+
+    /**
+     * The state changed; send the projected changes now or when the rate allows
+     *
+     * @param getState Returns the current state when called (at the send, not now)
+     */
+    update(getState) {
+        if (this.timer) {
+            this.coalesced++;
+            return;  // A send is scheduled; it reads the state then
+        }
+        const wait = this.lastSentAt + this.intervalMs - Date.now();
+        if (wait <= 0) {
+            this.flush(getState());
+            return;
+        }
+        this.timer = setTimeout(() => {
+            this.timer = null;
+            this.flush(getState());
+        }, wait);
+    }
+
+    /** Send the projected fields that differ from the last message, if any */
+    flush(state) {
+        const delta = this.project(state);
+        if (delta === null) {
+            return;
+        }
+        this.lastSentAt = Date.now();
+        this.messages++;
+        this.send(this, Object.assign({ type: 'delta', timestamp: this.lastSentAt }, delta), this.clients);
+    }
+
+    /** Everything sent so far as a "keyframe" message, or null before the first value */
+    keyframe() {
+        if (Object.keys(this.sent).length === 0) {
+            return null;
+        }
+        const frame = { type: 'keyframe', timestamp: Date.now() };
+        for (const group in this.sent) {
+            frame[group] = Object.assign({}, this.sent[group]);
+        }
+        return frame;
+    }
+
+    /** Take the state as sent without sending it (a new projection's starting point) */
+    prime(state) {
+        if (state) {
+            this.project(state);
+        }
+    }
+
+    /** Projected fields of @p state that differ from this.sent, or null; updates this.sent */
+    project(state) {
+        let delta = null;
+        for (const group in state) {
+            const values = state[group];
+            if (values === null || typeof values !== 'object') {
+                continue;  // type, timestamp
+            }
+            const keys = this.groups === null ? null : this.groups[group];
+            if (keys === undefined) {
+                continue;
+            }
+            const sent = this.sent[group] || (this.sent[group] = {});
+            for (const key in values) {
+                if (keys !== null && !keys.has(key) && GROUP_META.indexOf(key) < 0) {
+                    continue;
+                }
+                const value = values[key];
+                if (sent[key] !== value) {
+                    sent[key] = value;
+                    delta = delta || {};
+                    (delta[group] || (delta[group] = {}))[key] = value;
+                }
+            }
+        }
+        return delta;
+    }
+
+    stop() {
+        clearTimeout(this.timer);
+        this.timer = null;
+    }
+
+    toJSON() {
+        return {
+            fields: this.subscription.fields,
+            maxRateHz: this.subscription.maxRateHz,
+            clients: this.clients.size,
+            messages: this.messages,
+            coalesced: this.coalesced
+        };
+    }
+}
+
+/**
+ * The projections of all connected clients, one per distinct subscription
+ */
+class ProjectionSet {
+    /**
+     * @param send (projection, message, clients) as for Projection
+     * @param maxProjections Most distinct subscriptions at a time
+     */
+    constructor(send, maxProjections) {
+        this.send = send;
+        this.maxProjections = maxProjections;
+        this.projections = new Map();  // subscription key -> Projection
+    }
+
+    get size() {
+        return this.projections.size;
+    }
+
+    /**
+     * Join @p client to the projection of @p subscription
+     *
+     * @param state Current state, the starting point of a new projection
+     * @returns The projection, or null if maxProjections are in use
+     */
+    add(client, subscription, state) {
+        let projection = this.projections.get(subscription.key);
+        if (!projection) {
+            if (this.projections.size >= this.maxProjections) {
+                return null;
+            }
+            projection = new Projection(subscription, this.send);
+            projection.prime(state);
+            this.projections.set(subscription.key, projection);
+        }
+        projection.clients.add(client);
+        return projection;
+    }
+
+    /** @p client left; its projection ends with its last client */
+    remove(client, projection) {
+        projection.clients.delete(client);
+        if (projection.clients.size === 0) {
+            projection.stop();
+            this.projections.delete(projection.subscription.key);
+        }
+    }
+
+    /** The state changed (getState returns it when a projection sends) */
+    update(getState) {
+        this.projections.forEach((projection) => projection.update(getState));
+    }
+
+    stop() {
+        this.projections.forEach((projection) => projection.stop());
+    }
+
+    toJSON() {
+        return Array.from(this.projections.values()).map((projection) => projection.toJSON());
+    }
+}
+
+module.exports = { parseSubscription, Projection, ProjectionSet };
@@ -4,14 +4,26 @@
  * Node.js WebSocket Proxy Server for ESP32 BoatData
  *
  * Connects to ESP32 WebSocket endpoint and relays data to multiple browser clients.
+ * With several gateways ("gateways" in the config) their streams are merged into one.
  * Provides HTTP server for serving dashboard HTML.
  */
 
 const express = require('express');
 const WebSocket = require('ws');
 const http = require('http');
+const dgram = require('dgram');
 const fs = require('fs');
 const path = require('path');
+const crypto = require('crypto');
+// Shared with the ESP32's dashboard, which serves the same file from LittleFS
+const decoderPath = path.join(__dirname, '..', 'data', 'boatdata-decoder.js');
+const serviceWorkerPath = path.join(__dirname, '..', 'data', 'stream-sw.js');
+// The firmware's CalculationEngine as WebAssembly, when built with `pio run -e wasm`
+const boatcalcDir = path.join(__dirname, '..', '.pio', 'build', 'wasm');
+const { decodeDatagram } = require(decoderPath);
+const { HistoryStore } = require('./history');
+const { Gateway, GatewayMerger } = require('./gateway');
+const { parseSubscription, ProjectionSet } = require('./projection');
 
 // Load configuration
 let config;
@@ -32,6 +44,31 @@ try {
 // Override with environment variables if provided
 if (process.env.ESP32_IP) config.esp32.ip = process.env.ESP32_IP;
 if (process.env.PORT) config.server.port = parseInt(process.env.PORT);
+if (process.env.ESP32_FORMAT) config.esp32.format = process.env.ESP32_FORMAT;
+
+// Gateways: "gateways": [{ "name", "ip", "port", "wsPath", "format", "maxRateHz" }, ...], else the one "esp32".
+// Formats: "json"; "bin": binary snapshot frames; "delta": a keyframe, then changed fields only;
+// "udp": no WebSocket to the ESP32; listen to its multicast datagrams instead
+const gatewayConfigs = Array.isArray(config.gateways) && config.gateways.length > 0
+    ? config.gateways
+    : [Object.assign({ name: 'esp32' }, config.esp32)];
+const gateways = gatewayConfigs.map((options) => new Gateway(Object.assign({ reconnectInterval: config.server.reconnectInterval }, options)));
+const udpGateways = gateways.filter((gateway) => gateway.udpFormat);
+// One gateway is relayed as it is; several are merged (last writer wins per field) into one delta stream
+const merger = gateways.length > 1 ? new GatewayMerger() : null;
+const mergeIntervalMs = config.server.mergeIntervalMs || 100;
+const udpConfig = Object.assign({ group: '239.255.42.1', port: 10120 }, config.udp);
+// A browser with more than this many bytes still unsent skips frames until it catches up
+const maxBufferedBytes = config.server.maxBufferedBytes || 65536;
+// Browsers may ask for ?fields=...&maxHz=...; each distinct subscription is projected once
+const maxProjections = config.server.maxProjections || 32;
+// maxHz of a browser that gives none (0 = every frame, relayed as it is)
+const defaultClientMaxHz = config.server.defaultClientMaxHz || 0;
+// "raw": relay the ESP32's frames as they are (browsers decode them); "json": full JSON frames
+const relayJson = config.server.relay === 'json';
+// Snapshot history for /api/history ("enabled": false turns it off)
+const historyConfig = Object.assign({ enabled: true, capacity: 21600, intervalMs: 1000, file: null }, config.history);
+const history = historyConfig.enabled ? new HistoryStore(historyConfig) : null;
 
 // Create Express app
 const app = express();
@@ -39,56 +76,197 @@ const server = http.createServer(app);
 
 // Serve static files from public directory
 app.use(express.static('public'));
+app.get('/boatdata-decoder.js', (req, res) => res.sendFile(decoderPath));
+
+// The dashboard's service worker, stamped with a hash of the shell it caches (as
+// tools/gzip_assets.py does for the ESP32). no-cache: each check is a cheap 304-sized
+// request here, and an edited dashboard reaches the browsers on their next load.
+app.get('/stream-sw.js', (req, res) => {
+    let files;
+    try {
+        files = [serviceWorkerPath, path.join(__dirname, 'public', 'stream.html'), decoderPath]
+            .map((file) => fs.readFileSync(file));
+    } catch (error) {
+        res.status(404).json({ error: error.message });
+        return;
+    }
+    const version = crypto.createHash('sha1').update(Buffer.concat(files)).digest('hex').slice(0, 12);
+    res.set('Cache-Control', 'no-cache');
+    res.type('application/javascript');
+    res.send(files[0].toString('utf8').replace('__SHELL_VERSION__', version));
+});
+
+// Module and wasm binary of tools/wasm; 404 until env:wasm has been built
+app.get(['/boatcalc.js', '/boatcalc.wasm'], (req, res) => {
+    res.sendFile(path.join(boatcalcDir, path.basename(req.path)), (error) => {
+        if (error && !res.headersSent) {
+            res.status(404).json({ error: 'not built: pio run -e wasm' });
+        }
+    });
+});
 
 // API endpoint for configuration status
 app.get('/api/config', (req, res) => {
+    const first = gateways[0];
     res.json({
         esp32: {
-            ip: config.esp32.ip,
-            port: config.esp32.port,
-            connected: esp32Connected,
-            lastMessageTime: lastMessageTime ? new Date(lastMessageTime).toISOString() : null
+            ip: first.ip,
+            port: first.port,
+            connected: first.connected,
+            lastMessageTime: first.stats.lastMessageTime ? new Date(first.stats.lastMessageTime).toISOString() : null
         },
+        udp: first.udpFormat ? Object.assign({ group: udpConfig.group, port: udpConfig.port }, first.udp) : null,
+        gateways: gateways.map((gateway) => gateway.toJSON()),
         server: {
             port: config.server.port,
             connectedClients: browserClients.size,
+            broadcast: {
+                frames: broadcastStats.frames,
+                skipped: broadcastStats.skipped,
+                slowClients: broadcastStats.slowClients,
+                maxBufferedBytes: maxBufferedBytes
+            },
+            projections: projections.size,
             uptime: Math.floor((Date.now() - serverStartTime) / 1000)
-        }
+        },
+        history: history ? {
+            rows: history.count,
+            capacity: history.capacity,
+            intervalMs: history.intervalMs,
+            file: history.file,
+            writeErrors: history.writeErrors
+        } : null
+    });
+});
+
+// Gateway connections and, when merging, the gateway that wrote each field last
+app.get('/api/gateways', (req, res) => {
+    res.json({
+        gateways: gateways.map((gateway) => gateway.toJSON()),
+        mergeIntervalMs: merger ? mergeIntervalMs : null,
+        sources: merger ? merger.sources() : null
+    });
+});
+
+// Browser connections: the full relay and each projection (subscription) with its clients
+app.get('/api/clients', (req, res) => {
+    res.json({
+        clients: browserClients.size,
+        relay: relayClients.size,
+        maxProjections: maxProjections,
+        defaultClientMaxHz: defaultClientMaxHz,
+        projections: projections.toJSON()
     });
 });
 
-// WebSocket Server (for browser clients)
-const wss = new WebSocket.Server({ server, path: '/boatdata' });
+// Parse a time parameter: ms since the epoch or an ISO 8601 date
+function parseTime(value) {
+    if (value === undefined || value === '') {
+        return undefined;
+    }
+    const number = Number(value);
+    return Number.isFinite(number) ? number : Date.parse(value);
+}
 
-// Track connected browser clients
+// History query: /api/history lists the fields, /api/history?field=derived.tws&from=&to=&step= downsamples one
+app.get('/api/history', (req, res) => {
+    if (!history) {
+        res.status(404).json({ error: 'history disabled' });
+        return;
+    }
+    const field = req.query.field;
+    if (!field) {
+        res.json(Object.assign({ fields: history.fields(), rows: history.count, intervalMs: history.intervalMs }, history.range()));
+        return;
+    }
+    const from = parseTime(req.query.from);
+    const to = parseTime(req.query.to);
+    const step = req.query.step !== undefined ? Number(req.query.step) : undefined;
+    if (Number.isNaN(from) || Number.isNaN(to) || Number.isNaN(step)) {
+        res.status(400).json({ error: 'from/to must be ms since the epoch or ISO dates, step a number of ms' });
+        return;
+    }
+    const result = history.query(field, from, to, step);
+    if (!result) {
+        res.status(404).json({ error: `unknown field ${field}`, fields: history.fields() });
+        return;
+    }
+    res.json(result);
+});
+
+// WebSocket Server (for browser clients). No compression: broadcastToBrowsers()
+// writes pre-built frames to the sockets, which only the uncompressed path allows.
+const wss = new WebSocket.Server({ server, path: '/boatdata', perMessageDeflate: false });
+
+// Track connected browser clients: all of them, and those that get the full stream
 const browserClients = new Set();
+const relayClients = new Set();
+const broadcastStats = { frames: 0, skipped: 0, slowClients: 0 };
 
-// ESP32 WebSocket client state
-let esp32Client = null;
-let esp32Connected = false;
-let reconnectTimer = null;
-let lastMessageTime = null;
 const serverStartTime = Date.now();
 
+// UDP listener state (shared by the "udp" gateways)
+let udpSocket = null;
+let mergeTimer = null;
+// Last self-contained frame of a single gateway, for browsers that connect
+let lastFullFrame = null;
+
+// Subscribed browsers get their projection's messages, built once per subscription
+const projections = new ProjectionSet((projection, message, clients) => {
+    broadcastToBrowsers(JSON.stringify(message), false, clients);
+}, maxProjections);
+
+// The state the projections read: the merged one, or the single gateway's decoder
+function currentState() {
+    return merger ? merger.state : gateways[0].stream.state;
+}
+
 // Handle browser client connections
 wss.on('connection', (ws, req) => {
     const clientId = `${req.socket.remoteAddress}:${req.socket.remotePort}`;
+    let subscription;
+    try {
+        subscription = parseSubscription(new URL(req.url, 'http://localhost').searchParams, defaultClientMaxHz);
+    } catch (error) {
+        console.log(`[BROWSER] Rejected ${clientId}: ${error.message}`);
+        ws.close(1008, error.message.slice(0, 120));
+        return;
+    }
+    if (subscription) {
+        ws.projection = projections.add(ws, subscription, currentState());
+        if (!ws.projection) {
+            console.log(`[BROWSER] Rejected ${clientId}: ${maxProjections} subscriptions in use`);
+            ws.close(1013, 'Too many distinct subscriptions');
+            return;
+        }
+    } else {
+        relayClients.add(ws);
+    }
     browserClients.add(ws);
 
-    console.log(`[BROWSER] Client connected: ${clientId} (total: ${browserClients.size})`);
+    console.log(`[BROWSER] Client connected: ${clientId}` +
+        (subscription ? ` (fields ${subscription.fields ? subscription.fields.join(',') : 'all'}, maxHz ${subscription.maxRateHz || '-'})` : '') +
+        ` (total: ${browserClients.size})`);
 
-    // Send connection status to new client
+    // Send connection status to new client, then the current state: deltas alone show nothing
     sendStatusUpdate(ws);
+    sendCurrentState(ws);
 
     // Handle browser client disconnect
     ws.on('close', () => {
         browserClients.delete(ws);
+        relayClients.delete(ws);
+        if (ws.projection) {
+            projections.remove(ws, ws.projection);
+        }
+        if (ws.slow) {
+            broadcastStats.slowClients--;
+        }
         console.log(`[BROWSER] Client disconnected: ${clientId} (total: ${browserClients.size})`);
     });
 
     ws.on('error', (error) => {
         console.error(`[BROWSER] Client error: ${clientId}:`, error.message);
-        browserClients.delete(ws);
     });
 });
 
@@ -96,8 +274,9 @@ wss.on('connection', (ws, req) => {
 function sendStatusUpdate(client = null) {
     const statusMessage = JSON.stringify({
         type: 'status',
-        esp32Connected: esp32Connected,
-        esp32Ip: config.esp32.ip,
+        esp32Connected: gateways.some((gateway) => gateway.connected),
+        esp32Ip: gateways.map((gateway) => gateway.ip).join(', '),
+        gateways: gateways.map((gateway) => ({ name: gateway.name, connected: gateway.connected })),
         timestamp: Date.now()
     });
 
@@ -112,112 +291,197 @@ function sendStatusUpdate(client = null) {
     }
 }
 
-// Broadcast message to all connected browser clients
-function broadcastToBrowsers(message) {
-    let successCount = 0;
-    let failCount = 0;
-
-    browserClients.forEach((client) => {
-        if (client.readyState === WebSocket.OPEN) {
-            try {
-                client.send(message);
-                successCount++;
-            } catch (error) {
-                console.error('[BROADCAST] Failed to send to client:', error.message);
-                failCount++;
-            }
-        } else {
-            failCount++;
+// Send a client that has just connected what it needs to show the boat before the next frame
+function sendCurrentState(client) {
+    const gateway = gateways[0];
+    if (client.projection) {
+        const keyframe = client.projection.keyframe();
+        if (keyframe) {
+            client.send(JSON.stringify(keyframe));
         }
-    });
-
-    // Only log if there are clients and failures
-    if (failCount > 0) {
-        console.log(`[BROADCAST] Sent to ${successCount}/${browserClients.size} clients (${failCount} failed)`);
+    } else if (merger || relayJson || gateway.format === 'delta') {
+        const state = merger ? merger.keyframe() : (relayJson ? gateway.stream.state : gateway.stream.keyframe());
+        if (state) {
+            client.send(JSON.stringify(state));
+        }
+    } else if (lastFullFrame) {
+        client.send(lastFullFrame.data, { binary: lastFullFrame.isBinary });
     }
 }
 
-// Connect to ESP32 WebSocket
-function connectToESP32() {
-    if (esp32Client) {
-        // Close existing connection
-        esp32Client.terminate();
-        esp32Client = null;
+// Relay one frame of the single gateway (WebSocket or UDP) to the browsers. It is
+// decoded only when needed: deltas to keep the state, the json relay to re-encode,
+// subscriptions to project, and one frame per history interval.
+function relayFrame(gateway, data, isBinary) {
+    const deltaFormat = gateway.format === 'delta';
+    const project = projections.size > 0;
+    if (deltaFormat || relayJson || project || (history && history.due())) {
+        let frames;
+        try {
+            frames = gateway.stream.decode(data, isBinary).frames;
+        } catch (error) {
+            console.error(`[${gateway.name}] Ignored frame (${data.length} bytes):`, error.message);
+            return;
+        }
+        if (frames.length === 0) {
+            if (isBinary) {
+                console.error(`[${gateway.name}] Ignored binary frame (${data.length} bytes, unknown version or size)`);
+            }
+            return;  // A delta before the first keyframe, or not a snapshot
+        }
+        recordHistory(frames[frames.length - 1]);
+    }
+    if (project) {
+        projections.update(currentState);
     }
 
-    const esp32Url = `ws://${config.esp32.ip}:${config.esp32.port}${config.esp32.wsPath}`;
-    console.log(`[ESP32] Connecting to ${esp32Url}...`);
+    if (relayJson) {
+        broadcastToBrowsers(JSON.stringify(gateway.stream.state), false, relayClients);
+        return;
+    }
+    if (!deltaFormat) {
+        lastFullFrame = { data: data, isBinary: isBinary };
+    }
+    broadcastToBrowsers(data, isBinary, relayClients);
+}
 
+// Decode one frame of a merged gateway into the unified state; flushMerged() sends the changes
+function mergeFrame(gateway, data, isBinary) {
+    let result;
     try {
-        esp32Client = new WebSocket(esp32Url, {
-            handshakeTimeout: 5000,
-            perMessageDeflate: false
-        });
-
-        esp32Client.on('open', () => {
-            esp32Connected = true;
-            console.log(`[ESP32] ✓ Connected to ${config.esp32.ip}`);
-
-            // Notify all browser clients
-            sendStatusUpdate();
-        });
+        result = gateway.stream.decode(data, isBinary);
+    } catch (error) {
+        console.error(`[${gateway.name}] Ignored frame (${data.length} bytes):`, error.message);
+        return;
+    }
+    for (const frame of result.frames) {
+        merger.apply(gateway.name, frame, result.changed);
+    }
+}
 
-        esp32Client.on('message', (data) => {
-            lastMessageTime = Date.now();
+// Every mergeIntervalMs: one delta with the fields any gateway changed, whatever their rates
+function flushMerged() {
+    const delta = merger.flush();
+    if (delta) {
+        broadcastToBrowsers(JSON.stringify(delta), false, relayClients);
+        projections.update(currentState);
+        recordHistory(merger.state);
+    }
+}
 
-            // Relay message to all browser clients
-            broadcastToBrowsers(data.toString());
-        });
+gateways.forEach((gateway) => {
+    gateway.on('frame', (data, isBinary) => {
+        if (merger) {
+            mergeFrame(gateway, data, isBinary);
+        } else {
+            relayFrame(gateway, data, isBinary);
+        }
+    });
+    gateway.on('status', (connected) => {
+        if (!connected && merger) {
+            merger.drop(gateway.name);
+        }
+        sendStatusUpdate();
+    });
+});
 
-        esp32Client.on('close', () => {
-            esp32Connected = false;
-            console.log('[ESP32] ✗ Connection closed');
+// Broadcast a message (string or Buffer) to browser clients (default: all).
+// The WebSocket frame is built once and written to every socket as is, so a
+// frame costs the same for 1 or 500 browsers apart from the socket writes.
+// A client that is not reading (bufferedAmount above maxBufferedBytes) skips
+// frames instead of growing the proxy's memory; each message is a complete
+// snapshot, so it simply shows the next one it can take. A subscribed client
+// gets deltas, which need every predecessor, so once it catches up it gets
+// its projection's keyframe instead.
+function broadcastToBrowsers(message, isBinary = false, clients = browserClients) {
+    if (clients.size === 0) {
+        return;
+    }
+    const frame = WebSocket.Sender.frame(Buffer.isBuffer(message) ? message : Buffer.from(message), {
+        fin: true,
+        rsv1: false,
+        opcode: isBinary ? 2 : 1,
+        mask: false,
+        readOnly: true
+    });
+    broadcastStats.frames++;
 
-            // Notify browser clients
-            sendStatusUpdate();
+    clients.forEach((client) => {
+        if (client.readyState !== WebSocket.OPEN) {
+            return;
+        }
+        const slow = client.bufferedAmount > maxBufferedBytes;
+        if (slow !== Boolean(client.slow)) {
+            client.slow = slow;
+            broadcastStats.slowClients += slow ? 1 : -1;
+            console.log(`[BROADCAST] Client ${slow ? 'too slow, skipping frames' : 'caught up'} (${client.bufferedAmount} bytes buffered)`);
+        }
+        if (slow) {
+            broadcastStats.skipped++;
+            client.resync = Boolean(client.projection);
+            return;
+        }
+        if (client.resync) {
+            client.resync = false;
+            sendCurrentState(client);
+            return;
+        }
+        // Write errors arrive as the client's 'error' event
+        const socket = client._socket;
+        socket.cork();
+        for (const part of frame) {
+            socket.write(part);
+        }
+        socket.uncork();
+    });
+}
 
-            // Schedule reconnect
-            scheduleReconnect();
-        });
+// Listen to the ESP32s' UDP datagrams (BoatDataUdpPublisher); each goes to the gateway of its sender
+function listenToUDP() {
+    udpSocket = dgram.createSocket({ type: 'udp4', reuseAddr: true });
 
-        esp32Client.on('error', (error) => {
-            console.error('[ESP32] Connection error:', error.message);
-            esp32Connected = false;
+    udpSocket.on('message', (message, rinfo) => {
+        const datagram = decodeDatagram(message);
+        if (!datagram) {
+            return;  // Not ours, or another snapshot version
+        }
+        const gateway = udpGateways.find((candidate) => candidate.ip === rinfo.address)
+            || (udpGateways.length === 1 ? udpGateways[0] : null);
+        if (gateway) {
+            gateway.handleDatagram(message, datagram);
+        }
+    });
 
-            // Don't schedule reconnect here - let 'close' event handle it
-        });
+    udpSocket.on('error', (error) => {
+        console.error('[UDP] Socket error:', error.message);
+    });
 
-    } catch (error) {
-        console.error('[ESP32] Failed to create WebSocket:', error.message);
-        scheduleReconnect();
-    }
+    udpSocket.bind(udpConfig.port, () => {
+        udpSocket.addMembership(udpConfig.group);
+        console.log(`[UDP] Listening on ${udpConfig.group}:${udpConfig.port}`);
+    });
 }
 
-// Schedule reconnection attempt
-function scheduleReconnect() {
-    if (reconnectTimer) {
-        clearTimeout(reconnectTimer);
+// Add a relayed snapshot to the history
+function recordHistory(snapshot) {
+    if (history) {
+        history.record(snapshot);
     }
-
-    console.log(`[ESP32] Reconnecting in ${config.server.reconnectInterval / 1000} seconds...`);
-
-    reconnectTimer = setTimeout(() => {
-        connectToESP32();
-    }, config.server.reconnectInterval);
 }
 
 // Graceful shutdown
 function shutdown() {
     console.log('\n[SERVER] Shutting down gracefully...');
 
-    // Clear reconnect timer
-    if (reconnectTimer) {
-        clearTimeout(reconnectTimer);
+    // Close the gateway connections (and their reconnect timers)
+    gateways.forEach((gateway) => gateway.stop());
+    clearInterval(mergeTimer);
+    projections.stop();
+    if (udpSocket) {
+        udpSocket.close();
     }
-
-    // Close ESP32 connection
-    if (esp32Client) {
-        esp32Client.close();
+    if (history) {
+        history.close();
     }
 
     // Close all browser connections
@@ -250,10 +514,24 @@ server.listen(config.server.port, () => {
     console.log(`\n[SERVER] HTTP server listening on port ${config.server.port}`);
     console.log(`[SERVER] Dashboard: http://localhost:${config.server.port}/stream.html`);
     console.log(`[SERVER] WebSocket: ws://localhost:${config.server.port}/boatdata`);
-    console.log(`[ESP32]  Target: ${config.esp32.ip}:${config.esp32.port}${config.esp32.wsPath}\n`);
+    for (const gateway of gateways) {
+        if (gateway.udpFormat) {
+            console.log(`[${gateway.name}]  Source: UDP datagrams from ${gateway.ip} on ${udpConfig.group}:${udpConfig.port}`);
+        } else {
+            console.log(`[${gateway.name}]  Target: ${gateway.ip}:${gateway.port}${gateway.wsPath} (${gateway.format} frames)`);
+        }
+    }
+    console.log(merger ? `[SERVER] Merging ${gateways.length} gateways every ${mergeIntervalMs} ms\n`
+        : `[SERVER] Relaying ${relayJson ? 'as JSON' : 'raw'}\n`);
 
-    // Connect to ESP32
-    connectToESP32();
+    // Connect to the gateways
+    gateways.forEach((gateway) => gateway.start());
+    if (udpGateways.length > 0) {
+        listenToUDP();
+    }
+    if (merger) {
+        mergeTimer = setInterval(flushMerged, mergeIntervalMs);
+    }
 });
 
 // Handle server errors
@@ -0,0 +1,65 @@
+/**
+ * @file AisWebServer.cpp
+ * @brief Implementation of the AIS endpoints
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "AisWebServer.h"
+
+AisWebServer::AisWebServer(const AisTargetTable* table)
+    : table(table) {
+}
+
+void AisWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || table == nullptr) {
+        return;
+    }
+
+    // GET /ais/risks - Collision-risk list of the last pass
+    server->on("/ais/risks", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetRisks(request);
+    });
+
+    // GET /ais/targets - Every tracked vessel
+    server->on("/ais/targets", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        GetChunkedJsonResponder().send(request, writeTargetsStep, this);
+    });
+}
+
+void AisWebServer::handleGetRisks(AsyncWebServerRequest* request) {
+    if (!table->readRisks(risks)) {
+        request->send(503, "application/json", "{\"error\":\"AIS targets busy\"}");
+        return;
+    }
+
+    body.reset();
+    AisTargetTable::writeRisksJson(body, risks, &table->stats());
+    request->send(200, "application/json", body.c_str());
+}
+
+bool AisWebServer::writeTargetsStep(JsonWriter& json, uint16_t step, void* context) {
+    const AisWebServer* self = static_cast<const AisWebServer*>(context);
+
+    if (step == 0) {
+        json.beginObject()
+            .add("count", static_cast<unsigned int>(self->table->count()))
+            .beginArray("targets");
+        return true;
+    }
+
+    uint32_t now = millis();
+    uint16_t first = (step - 1) * AIS_TARGETS_PER_STEP;
+    for (uint16_t slot = first; slot < first + AIS_TARGETS_PER_STEP && slot < AIS_MAX_TARGETS; slot++) {
+        AisTarget target;
+        if (self->table->readTarget(slot, target)) {
+            AisTargetTable::writeTargetJson(json, target, now);
+        }
+    }
+    if (first + AIS_TARGETS_PER_STEP < AIS_MAX_TARGETS) {
+        return true;
+    }
+    json.endArray().endObject();
+    return false;
+}
@@ -0,0 +1,82 @@
+/**
+ * @file AisWebServer.h
+ * @brief HTTP read-out of the AIS target table
+ *
+ * Provides:
+ * - GET /ais/risks: the collision-risk list of the last evaluation pass
+ *   (the document the /ais WebSocket streams at 1 Hz) with table counters
+ * - GET /ais/targets: every tracked vessel with its last CPA/TCPA
+ *
+ * /ais/targets is a chunked response written AIS_TARGETS_PER_STEP slots
+ * per step (ChunkedJsonResponder), so a full table needs no body buffer.
+ * Each slot is copied through the table's SeqLock; a slot rewritten while
+ * it is copied is skipped from that document.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): no body buffer, zero heap allocation
+ * - Principle V (Network Debugging): target table inspectable over WiFi
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef AIS_WEB_SERVER_H
+#define AIS_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../utils/AisTargetTable.h"
+#include "ChunkedJsonResponder.h"
+
+/**
+ * @brief Web server routes for the AIS targets
+ */
+class AisWebServer {
+private:
+    static constexpr uint16_t AIS_TARGETS_PER_STEP = 8;
+
+    const AisTargetTable* table;
+    AisRiskList risks;                                ///< GET /ais/risks copy (async_tcp task only, off its stack)
+    StaticJsonWriter<AIS_WS_JSON_SIZE + 192> body;    ///< GET /ais/risks document, risk list + counters
+
+    /**
+     * @brief Handle GET /ais/risks
+     *
+     * Returns (ranges and CPA in nautical miles, TCPA in seconds, angles in radians true):
+     * {
+     *   "targets": 42, "evaluated": 7, "own_ship": true, "last_update": 123456,
+     *   "risks": [{"mmsi": 244670316, "range": 2.413, "bearing": 0.7854, "cpa": 0.212,
+     *              "tcpa": 540, "cog": 3.9270, "sog": 11.2, "class": "A"}],
+     *   "stats": {"reports": 1200, "added": 45, "expired": 3, "evicted": 0, "evaluations": 5400, "passes": 600}
+     * }
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetRisks(AsyncWebServerRequest* request);
+
+    /**
+     * @brief GET /ais/targets body, AIS_TARGETS_PER_STEP slots per step (ChunkedJsonGenerator)
+     *
+     * {"count": 42, "targets": [{"mmsi": ..., "latitude": ..., "cpa": ..., "age_ms": 2100}, ...]}
+     */
+    static bool writeTargetsStep(JsonWriter& json, uint16_t step, void* context);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param table AIS target table to report (must outlive the server)
+     */
+    explicit AisWebServer(const AisTargetTable* table);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // AIS_WEB_SERVER_H
@@ -0,0 +1,109 @@
+/**
+ * @file AlarmRuleConfig.cpp
+ * @brief Implementation of the alarm rule file loader
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "AlarmRuleConfig.h"
+#include "../utils/AtomicFile.h"
+#include "../utils/ScratchArena.h"
+
+bool AlarmRuleConfig::load(const char* path, AlarmEngine* engine, WebSocketLogger* logger) {
+    if (engine == nullptr || logger == nullptr) {
+        return false;
+    }
+
+    AlarmRule rules[ALARM_MAX_RULES];
+    uint8_t count = 0;
+    uint8_t skipped = 0;
+    if (!LittleFS.exists(path)) {
+        installBuiltin(path, engine, logger);
+        return true;
+    }
+    if (!parse(path, logger, rules, count, skipped)) {
+        installBuiltin(path, engine, logger);  // Never boot without a watch
+        return false;
+    }
+
+    engine->setRules(rules, count);
+    logger->broadcastLogf(skipped > 0 ? LogLevel::WARN : LogLevel::INFO, LogComponent::ALARM, LogEvent::ALARM_RULES_LOADED,
+        "{\"path\":\"%s\",\"rules\":%u,\"skipped\":%u,\"max\":%d}",
+        path, (unsigned)count, (unsigned)skipped, ALARM_MAX_RULES);
+    return true;
+}
+
+bool AlarmRuleConfig::reload(const char* path, const char* candidate, AlarmEngine* engine, WebSocketLogger* logger) {
+    if (engine == nullptr || logger == nullptr) {
+        return false;
+    }
+
+    AlarmRule rules[ALARM_MAX_RULES];
+    uint8_t count = 0;
+    uint8_t skipped = 0;
+    if (candidate != nullptr && LittleFS.exists(candidate)) {
+        // Uploaded: becomes the rule file only if it holds a valid rule
+        if (!parse(candidate, logger, rules, count, skipped)) {
+            LittleFS.remove(candidate);
+            return false;
+        }
+        if (!AtomicFileReplace(candidate, path)) {
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::ALARM, LogEvent::CONFIG_SAVE_FAILED,
+                "{\"path\":\"%s\",\"reason\":\"rename failed, applied until reboot\"}", path);
+        }
+    } else if (!LittleFS.exists(path)) {
+        installBuiltin(path, engine, logger);
+        return true;
+    } else if (!parse(path, logger, rules, count, skipped)) {
+        return false;
+    }
+
+    engine->setRules(rules, count);
+    logger->broadcastLogf(skipped > 0 ? LogLevel::WARN : LogLevel::INFO, LogComponent::ALARM, LogEvent::ALARM_RULES_LOADED,
+        "{\"path\":\"%s\",\"rules\":%u,\"skipped\":%u,\"max\":%d}",
+        path, (unsigned)count, (unsigned)skipped, ALARM_MAX_RULES);
+    return true;
+}
+
+bool AlarmRuleConfig::parse(const char* path, WebSocketLogger* logger, AlarmRule* rules, uint8_t& count,
+                            uint8_t& skipped) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
+    }
+    if (file.size() > ALARM_RULES_MAX_BYTES) {
+        file.close();
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::ALARM, LogEvent::ALARM_RULES_INVALID,
+            "{\"path\":\"%s\",\"reason\":\"larger than %d bytes\"}", path, ALARM_RULES_MAX_BYTES);
+        return false;
+    }
+
+    // Released when the reaction (or setup step) returns
+    ScratchScope scratch(GetLoopArena());
+    char* text = scratch.arena().allocArray<char>(ALARM_RULES_MAX_BYTES + 1);
+    if (text == nullptr) {
+        file.close();
+        return false;
+    }
+    size_t length = file.read(reinterpret_cast<uint8_t*>(text), ALARM_RULES_MAX_BYTES);
+    file.close();
+    text[length] = '\0';
+
+    count = AlarmEngine::parseRules(text, rules, ALARM_MAX_RULES, &skipped);
+    if (count == 0) {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::ALARM, LogEvent::ALARM_RULES_INVALID,
+            "{\"path\":\"%s\",\"reason\":\"no valid rules\",\"skipped\":%u}", path, (unsigned)skipped);
+        return false;
+    }
+    return true;
+}
+
+void AlarmRuleConfig::installBuiltin(const char* path, AlarmEngine* engine, WebSocketLogger* logger) {
+    AlarmRule rules[ALARM_MAX_RULES];
+    uint8_t count = AlarmEngine::defaultRules(rules, ALARM_MAX_RULES);
+    engine->setRules(rules, count);
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::ALARM, LogEvent::ALARM_RULES_LOADED,
+        "{\"path\":\"%s\",\"rules\":%u,\"skipped\":0,\"max\":%d,\"builtin\":true}",
+        path, (unsigned)count, ALARM_MAX_RULES);
+}
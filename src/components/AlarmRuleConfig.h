@@ -0,0 +1,68 @@
+/**
+ * @file AlarmRuleConfig.h
+ * @brief Loads the alarm rule file from LittleFS into the AlarmEngine
+ *
+ * File format (ALARM_RULES_FILE, /alarms.conf): see AlarmEngine.h. A file
+ * larger than ALARM_RULES_MAX_BYTES, or one without a single valid rule,
+ * is logged (ALARM_RULES_INVALID) and ignored as a whole, so a typo never
+ * disarms the watch; invalid single lines are skipped and counted. Without
+ * a file the built-in rules (AlarmEngine::defaultRules()) apply.
+ *
+ * Live reload (ConfigService ALARMS, main loop): an upload is staged as
+ * ALARM_RULES_FILE ALARM_RULES_UPLOAD_SUFFIX and only renamed over the rule
+ * file once it parsed, as for the NMEA 0183 routing file.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ALARM_RULE_CONFIG_H
+#define ALARM_RULE_CONFIG_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "../utils/AlarmEngine.h"
+#include "../utils/WebSocketLogger.h"
+
+/**
+ * @brief Rule file loader
+ *
+ * Usage pattern (after LittleFS.begin(), before the BoatData subscription):
+ * @code
+ * AlarmRuleConfig::load(ALARM_RULES_FILE, &alarmEngine, &logger);
+ * @endcode
+ */
+class AlarmRuleConfig {
+public:
+    /**
+     * @brief Install the rules of @p path, or the built-in rules if it is missing or invalid
+     *
+     * Logs ALARM_RULES_LOADED (INFO, WARN with skipped lines) or ALARM_RULES_INVALID (ERROR).
+     *
+     * @return false if the file was invalid
+     */
+    static bool load(const char* path, AlarmEngine* engine, WebSocketLogger* logger);
+
+    /**
+     * @brief Install a changed rule file at runtime (main loop)
+     *
+     * If @p candidate exists it is parsed and, when valid, renamed over
+     * @p path; an invalid candidate is deleted. Otherwise @p path is read
+     * again, and a missing @p path restores the built-in rules. Invalid
+     * input keeps the installed rules.
+     *
+     * @return false if the candidate or the file was invalid
+     */
+    static bool reload(const char* path, const char* candidate, AlarmEngine* engine, WebSocketLogger* logger);
+
+private:
+    /**
+     * @brief Parse @p path into @p rules
+     * @return false if the file cannot be read, is too large or holds no valid rule (logged)
+     */
+    static bool parse(const char* path, WebSocketLogger* logger, AlarmRule* rules, uint8_t& count, uint8_t& skipped);
+
+    static void installBuiltin(const char* path, AlarmEngine* engine, WebSocketLogger* logger);
+};
+
+#endif // ALARM_RULE_CONFIG_H
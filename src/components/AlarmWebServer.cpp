@@ -0,0 +1,173 @@
+/**
+ * @file AlarmWebServer.cpp
+ * @brief Implementation of the alarm endpoints
+ *
+ * @see AlarmWebServer.h
+ */
+
+#include "AlarmWebServer.h"
+#include "../utils/ConfigService.h"
+#include "../utils/JsonWriter.h"
+#include "../utils/OtaUpdate.h"
+#include "../utils/ScratchArena.h"
+
+namespace {
+
+// Eight rules with their state: ~1.4 KB, taken from the HTTP scratch arena
+constexpr size_t ALARMS_RESPONSE_BYTES = 1792;
+
+constexpr float MAX_ANCHOR_RADIUS_M = 1852.0f;
+
+const char* const RULES_UPLOAD_PATH = ALARM_RULES_FILE ALARM_RULES_UPLOAD_SUFFIX;
+
+const char* const SCRATCH_EXHAUSTED = "{\"status\":\"error\",\"message\":\"Scratch memory exhausted\"}";
+
+}  // namespace
+
+AlarmWebServer::AlarmWebServer(AlarmEngine* alarmEngine)
+    : engine(alarmEngine),
+      rulesUploadBytes(0) {
+}
+
+void AlarmWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || engine == nullptr) {
+        return;
+    }
+
+    // GET /alarms - Rules, states and the anchor position
+    server->on("/alarms", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetAlarms(request);
+    });
+
+    // POST /alarms/anchor?action=drop[&radius=<m>]|raise - Arm or disarm the anchor watch
+    server->on("/alarms/anchor", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        this->handleAnchor(request);
+    });
+
+    // POST /alarms/reset - Clear every alarm
+    server->on("/alarms/reset", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        this->handleReset(request);
+    });
+
+    // POST /alarms/rules - Upload a rule file (response sent by the upload handler)
+    server->on("/alarms/rules", HTTP_POST,
+        [](AsyncWebServerRequest* request) {},
+        [this](AsyncWebServerRequest* request, const String& filename, size_t index, uint8_t* data, size_t len, bool final) {
+            this->handleRulesUpload(request, filename, index, data, len, final);
+        }
+    );
+}
+
+void AlarmWebServer::handleGetAlarms(AsyncWebServerRequest* request) {
+    AlarmStatus status;
+    if (!engine->readStatus(status)) {
+        request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Status busy, retry\"}");
+        return;
+    }
+
+    ScratchScope scratch(GetHttpArena());
+    char* body = scratch.arena().allocArray<char>(ALARMS_RESPONSE_BYTES);
+    if (body == nullptr) {
+        request->send(503, "application/json", SCRATCH_EXHAUSTED);
+        return;
+    }
+    JsonWriter json(body, ALARMS_RESPONSE_BYTES);
+    AlarmEngine::writeJson(json, status);
+    request->send(200, "application/json", json.c_str());
+}
+
+void AlarmWebServer::handleAnchor(AsyncWebServerRequest* request) {
+    StaticJsonWriter<128> json;
+    const char* action = request->hasParam("action") ? request->getParam("action")->value().c_str() : "";
+
+    if (strcmp(action, "raise") == 0) {
+        engine->requestRaise();
+        json.beginObject().add("status", "raising").endObject();
+        request->send(202, "application/json", json.c_str());
+        return;
+    }
+
+    float radius = 0.0f;
+    if (request->hasParam("radius")) {
+        radius = request->getParam("radius")->value().toFloat();
+        if (!(radius > 0.0f && radius <= MAX_ANCHOR_RADIUS_M)) {
+            json.beginObject()
+                .add("status", "error")
+                .add("error", "radius must be in (0, 1852] m")
+                .endObject();
+            request->send(400, "application/json", json.c_str());
+            return;
+        }
+    }
+    if (strcmp(action, "drop") != 0) {
+        json.beginObject().add("status", "error").add("error", "action must be drop or raise").endObject();
+        request->send(400, "application/json", json.c_str());
+        return;
+    }
+
+    engine->requestDrop(radius);
+    json.beginObject().add("status", "dropping").add("radius_m", static_cast<double>(radius), 1).endObject();
+    request->send(202, "application/json", json.c_str());
+}
+
+void AlarmWebServer::handleReset(AsyncWebServerRequest* request) {
+    engine->requestReset();
+    request->send(202, "application/json", "{\"status\":\"resetting\"}");
+}
+
+void AlarmWebServer::handleRulesUpload(AsyncWebServerRequest* request, const String& filename,
+                                       size_t index, uint8_t* data, size_t len, bool final) {
+    (void)filename;
+    if (index == 0) {
+        if (rulesUpload) {
+            rulesUpload.close();  // Previous upload aborted
+        }
+        if (!OtaFilesystemLocked()) {
+            rulesUpload = LittleFS.open(RULES_UPLOAD_PATH, "w");
+        }
+        rulesUploadBytes = 0;
+    }
+
+    rulesUploadBytes += len;
+    if (rulesUpload && rulesUploadBytes <= ALARM_RULES_MAX_BYTES &&
+        rulesUpload.write(data, len) != len) {
+        rulesUpload.close();  // Write error: reported below
+    }
+
+    if (!final) {
+        return;
+    }
+
+    bool written = static_cast<bool>(rulesUpload);
+    if (rulesUpload) {
+        rulesUpload.close();
+    }
+
+    StaticJsonWriter<192> response;
+    if (rulesUploadBytes > ALARM_RULES_MAX_BYTES) {
+        LittleFS.remove(RULES_UPLOAD_PATH);
+        char error[48];
+        snprintf(error, sizeof(error), "File larger than %d bytes", ALARM_RULES_MAX_BYTES);
+        response.beginObject().add("status", "error").add("error", error).endObject();
+        request->send(400, "application/json", response.c_str());
+        return;
+    }
+    if (!written) {
+        if (!OtaFilesystemLocked()) {
+            LittleFS.remove(RULES_UPLOAD_PATH);
+        }
+        response.beginObject().add("status", "error").add("error", "Failed to save rule file").endObject();
+        request->send(500, "application/json", response.c_str());
+        return;
+    }
+
+    // Validated by the main loop: an invalid file is deleted and the rules stay as they are
+    uint32_t version = GetConfigService().publish(ConfigDomain::ALARMS);
+    response.beginObject()
+        .add("status", "success")
+        .add("message", "Rule file uploaded. Applied if valid, see GET /alarms.")
+        .add("bytes", (unsigned long)rulesUploadBytes)
+        .add("version", (unsigned long)version)
+        .endObject();
+    request->send(202, "application/json", response.c_str());
+}
@@ -0,0 +1,91 @@
+/**
+ * @file AlarmWebServer.h
+ * @brief HTTP endpoints for the anchor watch and threshold alarms
+ *
+ * Provides:
+ * - GET /alarms: Rules, states, last values and the anchor position (AlarmEngine)
+ * - POST /alarms/anchor?action=drop[&radius=<m>]|raise: Arm or disarm the anchor watch
+ * - POST /alarms/reset: Clear every alarm (shore_power_lost re-arms when shore power returns)
+ * - POST /alarms/rules: Upload a rule file (ALARM_RULES_FILE, applied live if valid)
+ *
+ * Requests are taken by the main loop at the next evaluation; a drop takes
+ * the position of the next GPS fix. The rule file goes through ConfigService
+ * (domain "alarms"), so POST /config/reload?domain=alarms re-reads it too.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef ALARM_WEB_SERVER_H
+#define ALARM_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
+#include "../utils/AlarmEngine.h"
+
+/**
+ * @brief Web server routes for the alarm engine
+ */
+class AlarmWebServer {
+private:
+    AlarmEngine* engine;
+    File rulesUpload;                   ///< Staged rule file being received (async_tcp)
+    size_t rulesUploadBytes;
+
+    /**
+     * @brief Handle GET /alarms
+     *
+     * AlarmEngine::writeJson() of the last published status, 503 while the
+     * main loop is publishing.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetAlarms(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle POST /alarms/anchor
+     *
+     * 202 {"status":"dropping","radius_m":30.0} or {"status":"raising"},
+     * 400 for a missing action or a radius outside (0, 1852] m.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleAnchor(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle POST /alarms/reset
+     *
+     * 202 {"status":"resetting"}
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleReset(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle POST /alarms/rules (file upload chunks)
+     *
+     * 202 {"status":"success","bytes":142,"version":3} once staged; the main
+     * loop validates it and deletes an invalid file, keeping the rules.
+     */
+    void handleRulesUpload(AsyncWebServerRequest* request, const String& filename,
+                           size_t index, uint8_t* data, size_t len, bool final);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param alarmEngine Engine evaluated by the main loop
+     */
+    explicit AlarmWebServer(AlarmEngine* alarmEngine);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // ALARM_WEB_SERVER_H
@@ -6,11 +6,59 @@
  */
 
 #include "BoatData.h"
+#include "../utils/HotPath.h"
+
+namespace {
+
+/**
+ * @brief Staleness timeout of one group (BoatDataSchemaGroupId, 0 ms = never expires)
+ */
+struct StaleTimeout {
+    uint8_t group;
+    uint16_t timeoutMs;
+};
+
+const StaleTimeout STALE_TIMEOUTS[] = {
+    {BOATDATA_SCHEMA_GROUP_GPS, BOATDATA_STALE_GPS_MS},
+    {BOATDATA_SCHEMA_GROUP_COMPASS, BOATDATA_STALE_COMPASS_MS},
+    {BOATDATA_SCHEMA_GROUP_WIND, BOATDATA_STALE_WIND_MS},
+    {BOATDATA_SCHEMA_GROUP_DST, BOATDATA_STALE_DST_MS},
+    {BOATDATA_SCHEMA_GROUP_RUDDER, BOATDATA_STALE_RUDDER_MS},
+    {BOATDATA_SCHEMA_GROUP_ENGINE, BOATDATA_STALE_ENGINE_MS},
+    {BOATDATA_SCHEMA_GROUP_SAILDRIVE, BOATDATA_STALE_SAILDRIVE_MS},
+    {BOATDATA_SCHEMA_GROUP_BATTERY, BOATDATA_STALE_BATTERY_MS},
+    {BOATDATA_SCHEMA_GROUP_SHORE_POWER, BOATDATA_STALE_SHORE_POWER_MS},
+    {BOATDATA_SCHEMA_GROUP_DERIVED, BOATDATA_STALE_DERIVED_MS},
+};
+
+/**
+ * @brief Copy the selected fields of an engine patch into @p engine
+ */
+void applyEngineFields(EngineData& engine, uint16_t fields, const BoatDataPatch& patch) {
+    if (fields & EngineField::ENGINE_REV) engine.engineRev = patch.engine.engineRev;
+    if (fields & EngineField::OIL_TEMPERATURE) engine.oilTemperature = patch.engine.oilTemperature;
+    if (fields & EngineField::ALTERNATOR_VOLTAGE) engine.alternatorVoltage = patch.engine.alternatorVoltage;
+    engine.available = patch.engine.available;
+    engine.lastUpdate = patch.timestamp;
+}
+
+}  // namespace
 
 BoatData::BoatData(ISourcePrioritizer* prioritizer)
-    : sourcePrioritizer(prioritizer) {
+    : sourcePrioritizer(prioritizer), lastSourceReevalMs(0), patchQueue(nullptr),
+      writeObserver(nullptr), writeObserverContext(nullptr),
+      fusionMode(static_cast<SourceFusionMode>(SOURCE_FUSION_MODE)),
+      latitudeFilter(OUTLIER_FLOOR_POSITION_DEG), longitudeFilter(OUTLIER_FLOOR_POSITION_DEG),
+      cogFilter(OUTLIER_FLOOR_HEADING_RAD, true), sogFilter(OUTLIER_FLOOR_SPEED_KN),
+      trueHeadingFilter(OUTLIER_FLOOR_HEADING_RAD, true), magneticHeadingFilter(OUTLIER_FLOOR_HEADING_RAD, true),
+      awaFilter(OUTLIER_FLOOR_WIND_ANGLE_RAD, true), awsFilter(OUTLIER_FLOOR_WIND_SPEED_KN),
+      heelFilter(OUTLIER_FLOOR_HEEL_RAD), boatSpeedFilter(OUTLIER_FLOOR_SPEED_KN),
+      rudderFilter(OUTLIER_FLOOR_RUDDER_RAD) {
     // Initialize all data to zero/false
     memset(&data, 0, sizeof(BoatDataStructure));
+    for (int t = 0; t < SENSOR_TYPE_COUNT; t++) {
+        sourceRequests[t].store(NO_SOURCE_REQUEST);
+    }
 
     // Set calibration defaults
     data.calibration.leewayCalibrationFactor = DEFAULT_LEEWAY_K_FACTOR;
@@ -23,127 +71,427 @@ BoatData::BoatData(ISourcePrioritizer* prioritizer)
 // =============================================================================
 
 GPSData BoatData::getGPSData() {
-    return data.gps;
+    GPSData snapshot;
+    data.versions.gps.read(data.gps, snapshot);
+    return snapshot;
 }
 
 void BoatData::setGPSData(const GPSData& gpsData) {
+    data.versions.gps.writeBegin();
     data.gps = gpsData;
+    data.versions.gps.writeEnd();
+    noteChanged(BoatDataGroup::GPS);
 }
 
 CompassData BoatData::getCompassData() {
-    return data.compass;
+    CompassData snapshot;
+    data.versions.compass.read(data.compass, snapshot);
+    return snapshot;
 }
 
 void BoatData::setCompassData(const CompassData& compassData) {
+    data.versions.compass.writeBegin();
     data.compass = compassData;
+    data.versions.compass.writeEnd();
+    noteChanged(BoatDataGroup::COMPASS);
 }
 
 WindData BoatData::getWindData() {
-    return data.wind;
+    WindData snapshot;
+    data.versions.wind.read(data.wind, snapshot);
+    return snapshot;
 }
 
 void BoatData::setWindData(const WindData& windData) {
+    data.versions.wind.writeBegin();
     data.wind = windData;
+    data.versions.wind.writeEnd();
+    noteChanged(BoatDataGroup::WIND);
 }
 
 SpeedData BoatData::getSpeedData() {
-    return data.dst;  // Updated for v2.0.0: SpeedData renamed to DSTData
+    SpeedData snapshot;
+    data.versions.dst.read(data.dst, snapshot);  // Updated for v2.0.0: SpeedData renamed to DSTData
+    return snapshot;
 }
 
 void BoatData::setSpeedData(const SpeedData& speedData) {
+    data.versions.dst.writeBegin();
     data.dst = speedData;  // Updated for v2.0.0: SpeedData renamed to DSTData
+    data.versions.dst.writeEnd();
+    noteChanged(BoatDataGroup::DST);
 }
 
 RudderData BoatData::getRudderData() {
-    return data.rudder;
+    RudderData snapshot;
+    data.versions.rudder.read(data.rudder, snapshot);
+    return snapshot;
 }
 
 void BoatData::setRudderData(const RudderData& rudderData) {
+    data.versions.rudder.writeBegin();
     data.rudder = rudderData;
+    data.versions.rudder.writeEnd();
+    noteChanged(BoatDataGroup::RUDDER);
 }
 
 DerivedData BoatData::getDerivedData() {
-    return data.derived;
+    DerivedData snapshot;
+    data.versions.derived.read(data.derived, snapshot);
+    return snapshot;
 }
 
 void BoatData::setDerivedData(const DerivedData& derivedData) {
+    data.versions.derived.writeBegin();
     data.derived = derivedData;
+    data.versions.derived.writeEnd();
+    noteChanged(BoatDataGroup::DERIVED);
 }
 
 CalibrationData BoatData::getCalibration() {
-    return data.calibration;
+    CalibrationData snapshot;
+    data.versions.calibration.read(data.calibration, snapshot);
+    return snapshot;
 }
 
 void BoatData::setCalibration(const CalibrationData& calibrationData) {
+    data.versions.calibration.writeBegin();
     data.calibration = calibrationData;
+    data.versions.calibration.writeEnd();
+    noteChanged(BoatDataGroup::CALIBRATION);
 }
 
 // === NEW in v2.0.0 - Enhanced BoatData structures ===
 
 EngineData BoatData::getEngineData() {
-    return data.engine;
+    EngineData snapshot;
+    data.versions.engine.read(data.engine, snapshot);
+    return snapshot;
 }
 
 void BoatData::setEngineData(const EngineData& engineData) {
+    data.versions.engine.writeBegin();
     data.engine = engineData;
+    data.versions.engine.writeEnd();
+    noteChanged(BoatDataGroup::ENGINE);
 }
 
 SaildriveData BoatData::getSaildriveData() {
-    return data.saildrive;
+    SaildriveData snapshot;
+    data.versions.saildrive.read(data.saildrive, snapshot);
+    return snapshot;
 }
 
 void BoatData::setSaildriveData(const SaildriveData& saildriveData) {
+    data.versions.saildrive.writeBegin();
     data.saildrive = saildriveData;
+    data.versions.saildrive.writeEnd();
+    noteChanged(BoatDataGroup::SAILDRIVE);
 }
 
 BatteryData BoatData::getBatteryData() {
-    return data.battery;
+    BatteryData snapshot;
+    data.versions.battery.read(data.battery, snapshot);
+    return snapshot;
 }
 
 void BoatData::setBatteryData(const BatteryData& batteryData) {
+    data.versions.battery.writeBegin();
     data.battery = batteryData;
+    data.versions.battery.writeEnd();
+    noteChanged(BoatDataGroup::BATTERY);
 }
 
 ShorePowerData BoatData::getShorePowerData() {
-    return data.shorePower;
+    ShorePowerData snapshot;
+    data.versions.shorePower.read(data.shorePower, snapshot);
+    return snapshot;
 }
 
 void BoatData::setShorePowerData(const ShorePowerData& shorePowerData) {
+    data.versions.shorePower.writeBegin();
     data.shorePower = shorePowerData;
+    data.versions.shorePower.writeEnd();
+    noteChanged(BoatDataGroup::SHORE_POWER);
 }
 
 // =============================================================================
-// ISensorUpdate IMPLEMENTATION
+// PARTIAL (FIELD-LEVEL) UPDATES
 // =============================================================================
 
-bool BoatData::updateGPS(double lat, double lon, double cog, double sog, const char* sourceId) {
-    // Validate and update
-    if (!validateAndUpdateGPS(lat, lon, cog, sog)) {
-        return false;
-    }
+void HOT_PATH_ATTR BoatData::patchGPS(uint8_t fields, const GPSData& values, int source) {
+    BoatDataPatch patch;
+    patch.group = BoatDataPatch::Group::GPS;
+    patch.fields = fields;
+    patch.timestamp = millis();
+    patch.producedUs = micros();
+    stampSource(patch, SensorType::GPS, source);
+    patch.gps = values;
+    submitPatch(patch);
+}
+
+void HOT_PATH_ATTR BoatData::patchCompass(uint8_t fields, const CompassData& values, int source) {
+    BoatDataPatch patch;
+    patch.group = BoatDataPatch::Group::COMPASS;
+    patch.fields = fields;
+    patch.timestamp = millis();
+    patch.producedUs = micros();
+    stampSource(patch, SensorType::COMPASS, source);
+    patch.compass = values;
+    submitPatch(patch);
+}
 
-    // Update source prioritizer timestamp (if provided)
-    if (sourcePrioritizer != nullptr && sourceId != nullptr) {
-        // Note: In full implementation, would lookup source index by sourceId
-        // For now, simplified - assumes source already registered
-        // sourcePrioritizer->updateSourceTimestamp(sourceIndex, millis());
+void HOT_PATH_ATTR BoatData::stampSource(BoatDataPatch& patch, SensorType type, int source) {
+    patch.source = static_cast<int8_t>(source);
+    patch.sourceActive = true;
+    patch.sourceWeight = 1.0f;
+    if (fusionMode == SourceFusionMode::BLEND && source >= 0) {
+        // Resolved here, in the producing context that owns the prioritizer
+        patch.sourceActive = isActiveSource(type, source);
+        patch.sourceWeight = static_cast<float>(fusionWeight(source));
     }
+}
 
-    return true;
+void HOT_PATH_ATTR BoatData::patchWind(uint8_t fields, const WindData& values) {
+    BoatDataPatch patch;
+    patch.group = BoatDataPatch::Group::WIND;
+    patch.fields = fields;
+    patch.timestamp = millis();
+    patch.producedUs = micros();
+    patch.source = -1;
+    patch.sourceActive = true;
+    patch.sourceWeight = 1.0f;
+    patch.wind = values;
+    submitPatch(patch);
 }
 
-bool BoatData::updateCompass(double trueHdg, double magHdg, double variation, const char* sourceId) {
-    // Validate and update
-    if (!validateAndUpdateCompass(trueHdg, magHdg, variation)) {
-        return false;
+void HOT_PATH_ATTR BoatData::patchDST(uint8_t fields, const DSTData& values) {
+    BoatDataPatch patch;
+    patch.group = BoatDataPatch::Group::DST;
+    patch.fields = fields;
+    patch.timestamp = millis();
+    patch.producedUs = micros();
+    patch.source = -1;
+    patch.sourceActive = true;
+    patch.sourceWeight = 1.0f;
+    patch.dst = values;
+    submitPatch(patch);
+}
+
+void HOT_PATH_ATTR BoatData::patchEngine(uint8_t fields, const EngineData& values, uint8_t instance) {
+    BoatDataPatch patch;
+    patch.group = BoatDataPatch::Group::ENGINE;
+    patch.instance = instance;
+    patch.fields = fields;
+    patch.timestamp = millis();
+    patch.producedUs = micros();
+    patch.source = -1;
+    patch.sourceActive = true;
+    patch.sourceWeight = 1.0f;
+    patch.engine = values;
+    submitPatch(patch);
+}
+
+void HOT_PATH_ATTR BoatData::patchBattery(uint16_t fields, const BatteryData& values) {
+    BoatDataPatch patch;
+    patch.group = BoatDataPatch::Group::BATTERY;
+    patch.fields = fields;
+    patch.timestamp = millis();
+    patch.producedUs = micros();
+    patch.source = -1;
+    patch.sourceActive = true;
+    patch.sourceWeight = 1.0f;
+    patch.battery = values;
+    submitPatch(patch);
+}
+
+void HOT_PATH_ATTR BoatData::patchTank(uint8_t fields, const TankData& values) {
+    BoatDataPatch patch;
+    patch.group = BoatDataPatch::Group::TANK;
+    patch.instance = values.instance;
+    patch.fields = fields;
+    patch.timestamp = millis();
+    patch.producedUs = micros();
+    patch.source = -1;
+    patch.sourceActive = true;
+    patch.sourceWeight = 1.0f;
+    patch.tank = values;
+    submitPatch(patch);
+}
+
+void HOT_PATH_ATTR BoatData::submitPatch(const BoatDataPatch& patch) {
+    if (patchQueue != nullptr) {
+        patchQueue->push(patch);  // Full queue: dropped and counted by the queue
+    } else {
+        applyPatch(patch);
     }
+}
+
+void BoatData::deferPatches(BoatDataPatchQueue* queue) {
+    patchQueue = queue;
+}
 
-    // Update source prioritizer timestamp (if provided)
-    if (sourcePrioritizer != nullptr && sourceId != nullptr) {
-        // Note: Similar to updateGPS - would lookup source index
+void BoatData::applyPatch(const BoatDataPatch& patch) {
+    const uint16_t fields = patch.fields;
+
+    switch (patch.group) {
+        case BoatDataPatch::Group::GPS: {
+            applySourceRequest(SensorType::GPS);
+            double lat = patch.gps.latitude;
+            double lon = patch.gps.longitude;
+            double cog = patch.gps.cog;
+            uint8_t gpsFields = fields;
+            if (fusionMode == SourceFusionMode::BLEND && patch.source >= 0) {
+                gpsFields = blendGPS(patch.source, patch.sourceWeight, patch.sourceActive, fields,
+                                     lat, lon, cog, patch.timestamp);
+                if (gpsFields == 0) {
+                    break;  // Only fields of the active source
+                }
+            }
+
+            GPSData& gps = data.gps;
+            data.versions.gps.writeBegin();
+            if (gpsFields & GPSField::LATITUDE) gps.latitude = lat;
+            if (gpsFields & GPSField::LONGITUDE) gps.longitude = lon;
+            if (gpsFields & GPSField::COG) gps.cog = cog;
+            if (gpsFields & GPSField::SOG) gps.sog = patch.gps.sog;
+            if (gpsFields & GPSField::VARIATION) gps.variation = patch.gps.variation;
+            if (gpsFields & GPSField::FIX_QUALITY) gps.fixQuality = patch.gps.fixQuality;
+            if (gpsFields & GPSField::SATELLITES) gps.satellites = patch.gps.satellites;
+            if (gpsFields & GPSField::HDOP) gps.hdop = patch.gps.hdop;
+            gps.available = patch.gps.available;
+            gps.lastUpdate = patch.timestamp;
+            data.versions.gps.writeEnd();
+            noteChanged(BoatDataGroup::GPS, patch.producedUs);
+            break;
+        }
+
+        case BoatDataPatch::Group::COMPASS: {
+            applySourceRequest(SensorType::COMPASS);
+            double trueHdg = patch.compass.trueHeading;
+            double magHdg = patch.compass.magneticHeading;
+            uint8_t compassFields = fields;
+            if (fusionMode == SourceFusionMode::BLEND && patch.source >= 0) {
+                compassFields = blendCompass(patch.source, patch.sourceWeight, patch.sourceActive, fields,
+                                             trueHdg, magHdg, patch.timestamp);
+                if (compassFields == 0) {
+                    break;
+                }
+            }
+
+            CompassData& compass = data.compass;
+            data.versions.compass.writeBegin();
+            if (compassFields & CompassField::TRUE_HEADING) compass.trueHeading = trueHdg;
+            if (compassFields & CompassField::MAGNETIC_HEADING) compass.magneticHeading = magHdg;
+            if (compassFields & CompassField::RATE_OF_TURN) compass.rateOfTurn = patch.compass.rateOfTurn;
+            if (compassFields & CompassField::HEEL_ANGLE) compass.heelAngle = patch.compass.heelAngle;
+            if (compassFields & CompassField::PITCH_ANGLE) compass.pitchAngle = patch.compass.pitchAngle;
+            if (compassFields & CompassField::HEAVE) compass.heave = patch.compass.heave;
+            compass.available = patch.compass.available;
+            compass.lastUpdate = patch.timestamp;
+            data.versions.compass.writeEnd();
+            noteChanged(BoatDataGroup::COMPASS, patch.producedUs);
+            break;
+        }
+
+        case BoatDataPatch::Group::WIND: {
+            WindData& wind = data.wind;
+            data.versions.wind.writeBegin();
+            if (fields & WindField::APPARENT_ANGLE) wind.apparentWindAngle = patch.wind.apparentWindAngle;
+            if (fields & WindField::APPARENT_SPEED) wind.apparentWindSpeed = patch.wind.apparentWindSpeed;
+            wind.available = patch.wind.available;
+            wind.lastUpdate = patch.timestamp;
+            data.versions.wind.writeEnd();
+            noteChanged(BoatDataGroup::WIND, patch.producedUs);
+            break;
+        }
+
+        case BoatDataPatch::Group::DST: {
+            DSTData& dst = data.dst;
+            data.versions.dst.writeBegin();
+            if (fields & DSTField::DEPTH) dst.depth = patch.dst.depth;
+            if (fields & DSTField::BOAT_SPEED) dst.measuredBoatSpeed = patch.dst.measuredBoatSpeed;
+            if (fields & DSTField::SEA_TEMPERATURE) dst.seaTemperature = patch.dst.seaTemperature;
+            dst.available = patch.dst.available;
+            dst.lastUpdate = patch.timestamp;
+            data.versions.dst.writeEnd();
+            noteChanged(BoatDataGroup::DST, patch.producedUs);
+            break;
+        }
+
+        case BoatDataPatch::Group::ENGINE: {
+            const uint8_t instance = patch.instance;
+            BoatDataInstanceMask slots = {0, 0};
+            if (instance < BOATDATA_ENGINE_INSTANCES) {
+                data.versions.instances.writeBegin();
+                applyEngineFields(data.instances.engines[instance], fields, patch);
+                data.instances.enginesSeen = static_cast<uint8_t>(data.instances.enginesSeen | (1u << instance));
+                data.versions.instances.writeEnd();
+                slots.engines = static_cast<uint8_t>(1u << instance);
+            }
+            if (instance == N2K_ENGINE_PRIMARY_INSTANCE) {
+                data.versions.engine.writeBegin();
+                applyEngineFields(data.engine, fields, patch);
+                data.versions.engine.writeEnd();
+            } else if (!slots.any()) {
+                break;  // No slot for this instance
+            }
+            noteChanged(BoatDataGroup::ENGINE, slots, patch.producedUs);
+            break;
+        }
+
+        case BoatDataPatch::Group::TANK: {
+            uint8_t slot = tankSlot(patch.tank.fluidType, patch.tank.instance);
+            if (slot >= BOATDATA_TANK_INSTANCES) {
+                break;  // Every slot belongs to another tank
+            }
+            TankData& tank = data.instances.tanks[slot];
+            data.versions.instances.writeBegin();
+            if (fields & TankField::LEVEL) tank.level = patch.tank.level;
+            if (fields & TankField::CAPACITY) tank.capacity = patch.tank.capacity;
+            tank.available = patch.tank.available;
+            tank.lastUpdate = patch.timestamp;
+            data.versions.instances.writeEnd();
+            BoatDataInstanceMask slots = {0, static_cast<uint8_t>(1u << slot)};
+            noteChanged(BoatDataGroup::ENGINE, slots, patch.producedUs);  // Tanks ride the engine room group
+            break;
+        }
+
+        case BoatDataPatch::Group::BATTERY: {
+            BatteryData& battery = data.battery;
+            data.versions.battery.writeBegin();
+            if (fields & BatteryField::VOLTAGE_A) battery.voltageA = patch.battery.voltageA;
+            if (fields & BatteryField::AMPERAGE_A) battery.amperageA = patch.battery.amperageA;
+            if (fields & BatteryField::SOC_A) battery.stateOfChargeA = patch.battery.stateOfChargeA;
+            if (fields & BatteryField::SHORE_CHARGER_A) battery.shoreChargerOnA = patch.battery.shoreChargerOnA;
+            if (fields & BatteryField::ENGINE_CHARGER_A) battery.engineChargerOnA = patch.battery.engineChargerOnA;
+            if (fields & BatteryField::VOLTAGE_B) battery.voltageB = patch.battery.voltageB;
+            if (fields & BatteryField::AMPERAGE_B) battery.amperageB = patch.battery.amperageB;
+            if (fields & BatteryField::SOC_B) battery.stateOfChargeB = patch.battery.stateOfChargeB;
+            if (fields & BatteryField::SHORE_CHARGER_B) battery.shoreChargerOnB = patch.battery.shoreChargerOnB;
+            if (fields & BatteryField::ENGINE_CHARGER_B) battery.engineChargerOnB = patch.battery.engineChargerOnB;
+            battery.available = patch.battery.available;
+            battery.lastUpdate = patch.timestamp;
+            data.versions.battery.writeEnd();
+            noteChanged(BoatDataGroup::BATTERY, patch.producedUs);
+            break;
+        }
     }
+}
 
-    return true;
+// =============================================================================
+// ISensorUpdate IMPLEMENTATION
+// =============================================================================
+
+bool BoatData::updateGPS(double lat, double lon, double cog, double sog, const char* sourceId) {
+    // Unarbitrated: producers with a registered source use the handle overload
+    SourceRejection reason;
+    return validateAndUpdateGPS(lat, lon, cog, sog, GPSField::LATITUDE | GPSField::LONGITUDE | GPSField::COG | GPSField::SOG, reason);
+}
+
+bool BoatData::updateCompass(double trueHdg, double magHdg, double variation, const char* sourceId) {
+    SourceRejection reason;
+    return validateAndUpdateCompass(trueHdg, magHdg, variation, CompassField::TRUE_HEADING | CompassField::MAGNETIC_HEADING, reason);
 }
 
 bool BoatData::updateWind(double awa, double aws, const char* sourceId) {
@@ -152,24 +500,22 @@ bool BoatData::updateWind(double awa, double aws, const char* sourceId) {
         return false;
     }
 
-    // Rate-of-change validation (if previous data exists)
-    if (data.wind.available && data.wind.lastUpdate > 0) {
-        unsigned long deltaTime = millis() - data.wind.lastUpdate;
-
-        if (!DataValidator::isValidWindAngleRateOfChange(data.wind.apparentWindAngle, awa, deltaTime)) {
-            return false;
-        }
-
-        if (!DataValidator::isValidWindSpeedRateOfChange(data.wind.apparentWindSpeed, aws, deltaTime)) {
-            return false;
-        }
+    // Outliers against the recent history (both filters see every sample)
+    unsigned long now = millis();
+    bool awaOk = awaFilter.check(awa, now);
+    bool awsOk = awsFilter.check(aws, now);
+    if (!awaOk || !awsOk) {
+        return false;
     }
 
     // Accept and store
+    data.versions.wind.writeBegin();
     data.wind.apparentWindAngle = awa;
     data.wind.apparentWindSpeed = aws;
     data.wind.available = true;
     data.wind.lastUpdate = millis();
+    data.versions.wind.writeEnd();
+    noteChanged(BoatDataGroup::WIND);
 
     return true;
 }
@@ -180,26 +526,26 @@ bool BoatData::updateSpeed(double heelAngle, double boatSpeed, const char* sourc
         return false;
     }
 
-    // Rate-of-change validation (if previous data exists)
-    // NOTE v2.0.0: heelAngle moved to CompassData, but validation still uses old logic for backward compatibility
-    if (data.dst.available && data.dst.lastUpdate > 0) {
-        unsigned long deltaTime = millis() - data.dst.lastUpdate;
-
-        if (!DataValidator::isValidHeelRateOfChange(data.compass.heelAngle, heelAngle, deltaTime)) {
-            return false;
-        }
-
-        if (!DataValidator::isValidSpeedRateOfChange(data.dst.measuredBoatSpeed, boatSpeed, deltaTime, 5.0)) {
-            return false;
-        }
+    // Outliers against the recent history
+    unsigned long now = millis();
+    bool heelOk = heelFilter.check(heelAngle, now);
+    bool speedOk = boatSpeedFilter.check(boatSpeed, now);
+    if (!heelOk || !speedOk) {
+        return false;
     }
 
     // Accept and store
     // NOTE v2.0.0: heelAngle now stored in CompassData, boatSpeed stored in DSTData
+    data.versions.compass.writeBegin();
     data.compass.heelAngle = heelAngle;
+    data.versions.compass.writeEnd();
+    noteChanged(BoatDataGroup::COMPASS);
+    data.versions.dst.writeBegin();
     data.dst.measuredBoatSpeed = boatSpeed;
     data.dst.available = true;
     data.dst.lastUpdate = millis();
+    data.versions.dst.writeEnd();
+    noteChanged(BoatDataGroup::DST);
 
     return true;
 }
@@ -210,23 +556,144 @@ bool BoatData::updateRudder(double angle, const char* sourceId) {
         return false;
     }
 
-    // Rate-of-change validation (if previous data exists)
-    if (data.rudder.available && data.rudder.lastUpdate > 0) {
-        unsigned long deltaTime = millis() - data.rudder.lastUpdate;
-
-        if (!DataValidator::isValidRudderRateOfChange(data.rudder.steeringAngle, angle, deltaTime)) {
-            return false;
-        }
+    // Outliers against the recent history
+    if (!rudderFilter.check(angle, millis())) {
+        return false;
     }
 
     // Accept and store
+    data.versions.rudder.writeBegin();
     data.rudder.steeringAngle = angle;
     data.rudder.available = true;
     data.rudder.lastUpdate = millis();
+    data.versions.rudder.writeEnd();
+    noteChanged(BoatDataGroup::RUDDER);
 
     return true;
 }
 
+// =============================================================================
+// ARBITRATED (HANDLE-BASED) UPDATES
+// =============================================================================
+
+BoatDataSourceHandle BoatData::registerSource(const char* sourceId, SensorType type, ProtocolType protocol) {
+    BoatDataSourceHandle handle;
+    handle.type = type;
+    if (sourcePrioritizer != nullptr) {
+        int index = sourcePrioritizer->registerSource(sourceId, type, protocol);
+        handle.index = static_cast<int8_t>(index < 0 ? -1 : index);
+    }
+    return handle;
+}
+
+bool BoatData::updateGPS(const BoatDataSourceHandle& source, double lat, double lon, double cog, double sog,
+                         uint8_t fields) {
+    unsigned long now = millis();
+    bool active = true;
+    if (!acceptSource(source, now, active)) {
+        return false;  // Not the active GPS - dropped before validation
+    }
+
+    bool stored;
+    SourceRejection reason = SourceRejection::INVALID;
+    if (fusionMode == SourceFusionMode::BLEND && source.valid()) {
+        // Values the source did not supply are the stored ones
+        const GPSData& gps = data.gps;
+        if (!(fields & GPSField::LATITUDE)) lat = gps.latitude;
+        if (!(fields & GPSField::LONGITUDE)) lon = gps.longitude;
+        if (!(fields & GPSField::COG)) cog = gps.cog;
+        if (!active) fields &= ~GPSField::SOG;
+        if (!(fields & GPSField::SOG)) sog = gps.sog;
+        stored = isValidGPSUpdate(lat, lon, cog, sog, fields, reason);
+        if (stored) {
+            blendGPS(source.index, fusionWeight(source.index), active, fields, lat, lon, cog, now);
+            storeGPS(lat, lon, cog, sog);
+        }
+    } else {
+        stored = validateAndUpdateGPS(lat, lon, cog, sog, fields, reason);
+    }
+    if (!stored && source.valid()) {
+        sourcePrioritizer->recordRejection(source.index, reason);
+    }
+    return stored;
+}
+
+bool BoatData::updateCompass(const BoatDataSourceHandle& source, double trueHdg, double magHdg, double variation,
+                             uint8_t fields) {
+    unsigned long now = millis();
+    bool active = true;
+    if (!acceptSource(source, now, active)) {
+        return false;
+    }
+
+    bool stored;
+    SourceRejection reason = SourceRejection::INVALID;
+    if (fusionMode == SourceFusionMode::BLEND && source.valid()) {
+        if (!(fields & CompassField::TRUE_HEADING)) trueHdg = data.compass.trueHeading;
+        if (!(fields & CompassField::MAGNETIC_HEADING)) magHdg = data.compass.magneticHeading;
+        if (!active) variation = data.gps.variation;
+        stored = isValidCompassUpdate(trueHdg, magHdg, fields, reason);
+        if (stored) {
+            blendCompass(source.index, fusionWeight(source.index), active, fields, trueHdg, magHdg, now);
+            storeCompass(trueHdg, magHdg, variation);
+        }
+    } else {
+        stored = validateAndUpdateCompass(trueHdg, magHdg, variation, fields, reason);
+    }
+    if (!stored && source.valid()) {
+        sourcePrioritizer->recordRejection(source.index, reason);
+    }
+    return stored;
+}
+
+bool BoatData::updateBattery(const BoatDataSourceHandle& source, const BatteryData& battery) {
+    bool active = true;
+    if (!acceptSource(source, millis(), active)) {
+        return false;
+    }
+    if (!active) {
+        // BLEND passes inactive sources, but bank readings are not blended
+        sourcePrioritizer->recordRejection(source.index, SourceRejection::INACTIVE);
+        return false;
+    }
+    setBatteryData(battery);
+    return true;
+}
+
+bool BoatData::updateAttitude(const BoatDataSourceHandle& source, double heel, double pitch) {
+    bool active = true;
+    if (!acceptSource(source, millis(), active)) {
+        return false;
+    }
+    if (!active) {
+        // BLEND passes inactive sources, but attitude is not blended
+        sourcePrioritizer->recordRejection(source.index, SourceRejection::INACTIVE);
+        return false;
+    }
+
+    CompassData patch;
+    patch.heelAngle = DataValidation::clampHeelAngle(heel);
+    patch.available = DataValidation::PitchRange::check(pitch) == RangeResult::VALID;
+    patch.pitchAngle = pitch;
+    patchCompass(CompassField::HEEL_ANGLE | CompassField::PITCH_ANGLE, patch);
+    return true;
+}
+
+void BoatData::setFusionMode(SourceFusionMode mode) {
+    fusionMode = mode;
+    positionFusion.reset();
+    cogFusion.reset();
+    trueHeadingFusion.reset();
+    magneticHeadingFusion.reset();
+}
+
+void BoatData::reportSourceQuality(const BoatDataSourceHandle& source, uint8_t fixQuality, uint8_t satellites,
+                                   double hdop) {
+    if (source.valid()) {
+        sourcePrioritizer->updateSourceQuality(source.index, fixQuality, satellites, hdop);
+    }
+}
+
 // =============================================================================
 // ADDITIONAL PUBLIC METHODS
 // =============================================================================
@@ -251,8 +718,120 @@ void BoatData::incrementActisenseCount() {
 // PRIVATE HELPER METHODS
 // =============================================================================
 
-bool BoatData::validateAndUpdateGPS(double lat, double lon, double cog, double sog) {
+bool BoatData::acceptSource(const BoatDataSourceHandle& source, unsigned long now, bool& active) {
+    // Handles are only valid when a prioritizer issued them
+    active = true;
+    if (!source.valid()) {
+        return true;
+    }
+
+    applySourceRequest(source.type);
+    if (now - lastSourceReevalMs >= BOATDATA_SOURCE_REEVAL_MS) {
+        lastSourceReevalMs = now;
+        sourcePrioritizer->checkStale(now);
+        sourcePrioritizer->updatePriorities();
+    }
+
+    // Recorded before the active check, so a dropped source stays a failover candidate
+    sourcePrioritizer->updateSourceTimestamp(source.index, now);
+
+    int activeIndex = sourcePrioritizer->getActiveSource(source.type);
+    if (activeIndex < 0) {
+        // Startup or failover gap: pick a source now instead of waiting for the re-evaluation
+        sourcePrioritizer->updatePriorities();
+        activeIndex = sourcePrioritizer->getActiveSource(source.type);
+    }
+
+    active = activeIndex < 0 || activeIndex == source.index;
+    if (!active && fusionMode != SourceFusionMode::BLEND) {
+        sourcePrioritizer->recordRejection(source.index, SourceRejection::INACTIVE);
+        return false;
+    }
+    return true;
+}
+
+bool BoatData::requestSourceOverride(SensorType type, int sourceIndex) {
+    if (sourcePrioritizer == nullptr || static_cast<int>(type) >= SENSOR_TYPE_COUNT) {
+        return false;
+    }
+    if (sourceIndex >= 0) {
+        // Registered sources never move, so their type is safe to read from here
+        SensorSource source = sourcePrioritizer->getSource(sourceIndex);
+        if (source.sourceId[0] == '\0' || source.sensorType != type) {
+            return false;
+        }
+    }
+    sourceRequests[static_cast<int>(type)].store(static_cast<int8_t>(sourceIndex < 0 ? -1 : sourceIndex));
+    return true;
+}
+
+void BoatData::applySourceRequest(SensorType type) {
+    std::atomic<int8_t>& pending = sourceRequests[static_cast<int>(type)];
+    if (pending.load(std::memory_order_relaxed) == NO_SOURCE_REQUEST) {
+        return;  // Common case: one relaxed load per update
+    }
+    int8_t request = pending.exchange(NO_SOURCE_REQUEST);
+    if (request == NO_SOURCE_REQUEST || sourcePrioritizer == nullptr) {
+        return;
+    }
+
+    sourcePrioritizer->clearManualOverride(type);
+    if (request >= 0) {
+        sourcePrioritizer->setManualOverride(request);
+    } else {
+        sourcePrioritizer->updatePriorities();  // Back to the best scoring source now
+    }
+}
+
+uint8_t BoatData::blendGPS(int source, double weight, bool active, uint8_t fields,
+                           double& lat, double& lon, double& cog, unsigned long now) {
+    const uint8_t position = GPSField::LATITUDE | GPSField::LONGITUDE;
+    if ((fields & position) == position) {
+        positionFusion.update(source, lat, lon, weight, now);
+    }
+    if (fields & GPSField::COG) {
+        cog = cogFusion.update(source, cog, weight, now);
+    }
+    return active ? fields : (fields & (position | GPSField::COG));
+}
+
+uint8_t BoatData::blendCompass(int source, double weight, bool active, uint8_t fields,
+                               double& trueHdg, double& magHdg, unsigned long now) {
+    const uint8_t headings = CompassField::TRUE_HEADING | CompassField::MAGNETIC_HEADING;
+    if (fields & CompassField::TRUE_HEADING) {
+        trueHdg = trueHeadingFusion.update(source, trueHdg, weight, now);
+    }
+    if (fields & CompassField::MAGNETIC_HEADING) {
+        magHdg = magneticHeadingFusion.update(source, magHdg, weight, now);
+    }
+    return active ? fields : (fields & headings);
+}
+
+double BoatData::fusionWeight(int source) {
+    return sourcePrioritizer != nullptr ? sourcePrioritizer->getSource(source).quality : 1.0;
+}
+
+bool BoatData::isActiveSource(SensorType type, int source) {
+    if (sourcePrioritizer == nullptr) {
+        return true;
+    }
+    int active = sourcePrioritizer->getActiveSource(type);
+    return active < 0 || active == source;
+}
+
+bool BoatData::validateAndUpdateGPS(double lat, double lon, double cog, double sog, uint8_t fields,
+                                    SourceRejection& reason) {
+    if (!isValidGPSUpdate(lat, lon, cog, sog, fields, reason)) {
+        return false;
+    }
+    storeGPS(lat, lon, cog, sog);
+    return true;
+}
+
+bool BoatData::isValidGPSUpdate(double lat, double lon, double cog, double sog, uint8_t fields,
+                                SourceRejection& reason) {
     // Range validation
+    reason = SourceRejection::INVALID;
     if (!DataValidator::isValidLatitude(lat) ||
         !DataValidator::isValidLongitude(lon) ||
         !DataValidator::isValidCOG(cog) ||
@@ -260,73 +839,244 @@ bool BoatData::validateAndUpdateGPS(double lat, double lon, double cog, double s
         return false;
     }
 
-    // Rate-of-change validation (if previous data exists)
-    if (data.gps.available && data.gps.lastUpdate > 0) {
-        unsigned long deltaTime = millis() - data.gps.lastUpdate;
-
-        // Skip rate check if data is stale (>5 seconds old)
-        if (deltaTime < 5000) {
-            if (!DataValidator::isValidGPSRateOfChange(
-                    data.gps.latitude, lat,
-                    data.gps.longitude, lon,
-                    deltaTime)) {
-                return false;
-            }
-
-            if (!DataValidator::isValidHeadingRateOfChange(data.gps.cog, cog, deltaTime)) {
-                return false;
-            }
-
-            if (!DataValidator::isValidSpeedRateOfChange(data.gps.sog, sog, deltaTime, 10.0)) {
-                return false;
-            }
-        }
+    // Outliers against the recent history of each supplied field
+    unsigned long now = millis();
+    bool accepted = true;
+    if (fields & GPSField::LATITUDE) accepted &= latitudeFilter.check(lat, now);
+    if (fields & GPSField::LONGITUDE) accepted &= longitudeFilter.check(lon, now);
+    if (fields & GPSField::COG) accepted &= cogFilter.check(cog, now);
+    if (fields & GPSField::SOG) accepted &= sogFilter.check(sog, now);
+    if (!accepted) {
+        reason = SourceRejection::OUTLIER;
     }
+    return accepted;
+}
 
-    // Accept and store
+void BoatData::storeGPS(double lat, double lon, double cog, double sog) {
+    data.versions.gps.writeBegin();
     data.gps.latitude = lat;
     data.gps.longitude = lon;
     data.gps.cog = cog;
     data.gps.sog = sog;
     data.gps.available = true;
     data.gps.lastUpdate = millis();
+    data.versions.gps.writeEnd();
+    noteChanged(BoatDataGroup::GPS);
+}
 
+bool BoatData::validateAndUpdateCompass(double trueHdg, double magHdg, double variation, uint8_t fields,
+                                        SourceRejection& reason) {
+    if (!isValidCompassUpdate(trueHdg, magHdg, fields, reason)) {
+        return false;
+    }
+    storeCompass(trueHdg, magHdg, variation);
     return true;
 }
 
-bool BoatData::validateAndUpdateCompass(double trueHdg, double magHdg, double variation) {
+bool BoatData::isValidCompassUpdate(double trueHdg, double magHdg, uint8_t fields, SourceRejection& reason) {
     // Range validation
+    reason = SourceRejection::INVALID;
     if (!DataValidator::isValidHeading(trueHdg) || !DataValidator::isValidHeading(magHdg)) {
         return false;
     }
 
-    // Rate-of-change validation (if previous data exists)
-    if (data.compass.available && data.compass.lastUpdate > 0) {
-        unsigned long deltaTime = millis() - data.compass.lastUpdate;
-
-        // Skip rate check if data is stale (>5 seconds old)
-        if (deltaTime < 5000) {
-            if (!DataValidator::isValidHeadingRateOfChange(data.compass.trueHeading, trueHdg, deltaTime)) {
-                return false;
-            }
-
-            if (!DataValidator::isValidHeadingRateOfChange(data.compass.magneticHeading, magHdg, deltaTime)) {
-                return false;
-            }
-        }
+    // Outliers against the recent history of each supplied heading
+    unsigned long now = millis();
+    bool accepted = true;
+    if (fields & CompassField::TRUE_HEADING) accepted &= trueHeadingFilter.check(trueHdg, now);
+    if (fields & CompassField::MAGNETIC_HEADING) accepted &= magneticHeadingFilter.check(magHdg, now);
+    if (!accepted) {
+        reason = SourceRejection::OUTLIER;
     }
+    return accepted;
+}
 
-    // Accept and store
+void BoatData::storeCompass(double trueHdg, double magHdg, double variation) {
+    data.versions.compass.writeBegin();
     data.compass.trueHeading = trueHdg;
     data.compass.magneticHeading = magHdg;
-    // NOTE v2.0.0: variation moved to GPSData
-    data.gps.variation = variation;
     data.compass.available = true;
     data.compass.lastUpdate = millis();
+    data.versions.compass.writeEnd();
+    noteChanged(BoatDataGroup::COMPASS);
 
-    return true;
+    // NOTE v2.0.0: variation moved to GPSData
+    data.versions.gps.writeBegin();
+    data.gps.variation = variation;
+    data.versions.gps.writeEnd();
+    noteChanged(BoatDataGroup::GPS);
 }
 
 BoatDataStructure* BoatData::getDataStructure() {
     return &data;
 }
+
+bool BoatData::getField(uint8_t id, double& value) const {
+    if (id >= BOATDATA_FIELD_COUNT) {
+        return false;
+    }
+    return BoatDataSchema::readValue(data, id, value);
+}
+
+bool BoatData::setField(uint8_t id, double value, unsigned long nowMs) {
+    if (id >= BOATDATA_FIELD_COUNT || isnan(value)) {
+        return false;
+    }
+    uint8_t group = BoatDataSchema::fieldInfo(id).group;
+    SeqLock& lock = BoatDataSchema::lock(data, group);
+
+    lock.writeBegin();
+    BoatDataSchema::setValue(data, id, BoatDataSchema::clamp(id, value));
+    BoatDataSchema::stamp(data, group, nowMs);
+    lock.writeEnd();
+    noteChanged(BoatDataSchema::groupInfo(group).mask);
+    return true;
+}
+
+void BoatData::getSnapshot(BoatDataStructure& out) const {
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        BoatDataSchema::readGroup(data, g, out);
+    }
+    getInstances(out.instances);
+}
+
+void BoatData::getInstances(BoatDataInstances& out) const {
+    data.versions.instances.read(data.instances, out);
+}
+
+uint8_t BoatData::tankSlot(uint8_t fluidType, uint8_t instance) {
+    BoatDataInstances& instances = data.instances;
+    for (uint8_t i = 0; i < instances.tankCount; i++) {
+        if (instances.tanks[i].fluidType == fluidType && instances.tanks[i].instance == instance) {
+            return i;
+        }
+    }
+    if (instances.tankCount >= BOATDATA_TANK_INSTANCES) {
+        return BOATDATA_TANK_INSTANCES;
+    }
+
+    // Key and count published with the slot's first values (the caller's write)
+    uint8_t slot = instances.tankCount;
+    data.versions.instances.writeBegin();
+    instances.tanks[slot].fluidType = fluidType;
+    instances.tanks[slot].instance = instance;
+    instances.tanks[slot].capacity = NAN;
+    instances.tankCount++;
+    data.versions.instances.writeEnd();
+    return slot;
+}
+
+const BoatDataVersions& BoatData::getVersions() const {
+    return data.versions;
+}
+
+const BoatDataChangeTracker& BoatData::getChanges() const {
+    return changes;
+}
+
+void BoatData::markChanged(uint16_t groups) {
+    noteChanged(groups);
+}
+
+void BoatData::setWriteObserver(BoatDataWriteObserver observer, void* context) {
+    writeObserverContext = context;
+    writeObserver = observer;
+}
+
+void BoatData::noteChanged(uint16_t groups, uint32_t originUs) {
+    changes.markChanged(groups);
+    if (writeObserver != nullptr) {
+        writeObserver(writeObserverContext, groups, originUs);
+    }
+}
+
+void BoatData::noteChanged(uint16_t groups) {
+    changes.markChanged(groups);
+    if (writeObserver != nullptr) {
+        writeObserver(writeObserverContext, groups, micros());
+    }
+}
+
+void BoatData::noteChanged(uint16_t groups, BoatDataInstanceMask instances, uint32_t originUs) {
+    changes.markChanged(groups, instances);
+    if (writeObserver != nullptr) {
+        writeObserver(writeObserverContext, groups, originUs);
+    }
+}
+
+uint16_t BoatData::sweepStale(unsigned long nowMs) {
+    uint16_t expired = 0;
+    for (size_t i = 0; i < sizeof(STALE_TIMEOUTS) / sizeof(STALE_TIMEOUTS[0]); i++) {
+        const StaleTimeout& entry = STALE_TIMEOUTS[i];
+        if (entry.timeoutMs == 0 || !BoatDataSchema::isAvailable(data, entry.group) ||
+            nowMs - BoatDataSchema::lastUpdate(data, entry.group) <= entry.timeoutMs) {
+            continue;
+        }
+
+        SeqLock& lock = BoatDataSchema::lock(data, entry.group);
+        lock.writeBegin();
+        BoatDataSchema::setAvailable(data, entry.group, false);
+        lock.writeEnd();
+        expired |= BoatDataSchema::groupInfo(entry.group).mask;
+    }
+
+    BoatDataInstanceMask expiredSlots = sweepStaleInstances(nowMs);
+    if (expiredSlots.any()) {
+        expired |= BoatDataGroup::ENGINE;
+    }
+    if (expired != 0) {
+        changes.markChanged(expired, expiredSlots);
+    }
+    return expired;
+}
+
+BoatDataInstanceMask BoatData::sweepStaleInstances(unsigned long nowMs) {
+    BoatDataInstanceMask expired = {0, 0};
+    BoatDataInstances& instances = data.instances;
+    for (uint8_t i = 0; i < BOATDATA_ENGINE_INSTANCES; i++) {
+        if (instances.engines[i].available && nowMs - instances.engines[i].lastUpdate > BOATDATA_STALE_ENGINE_MS) {
+            expired.engines = static_cast<uint8_t>(expired.engines | (1u << i));
+        }
+    }
+    for (uint8_t i = 0; i < instances.tankCount; i++) {
+        if (instances.tanks[i].available && nowMs - instances.tanks[i].lastUpdate > BOATDATA_STALE_ENGINE_MS) {
+            expired.tanks = static_cast<uint8_t>(expired.tanks | (1u << i));
+        }
+    }
+    if (!expired.any()) {
+        return expired;
+    }
+
+    data.versions.instances.writeBegin();
+    for (uint8_t i = 0; i < BOATDATA_ENGINE_INSTANCES; i++) {
+        if (expired.engines & (1u << i)) instances.engines[i].available = false;
+    }
+    for (uint8_t i = 0; i < BOATDATA_TANK_INSTANCES; i++) {
+        if (expired.tanks & (1u << i)) instances.tanks[i].available = false;
+    }
+    data.versions.instances.writeEnd();
+    return expired;
+}
+
+int BoatData::subscribe(uint16_t groups, uint32_t minIntervalMs, BoatDataChangeCallback callback,
+                        void* context, uint32_t maxIntervalMs) {
+    int id = subscriptions.subscribe(groups, minIntervalMs, callback, context);
+    subscriptions.setMaxInterval(id, maxIntervalMs);
+    return id;
+}
+
+uint32_t BoatData::getSubscriptionWaitMs(int id) const {
+    return subscriptions.getWaitMs(id);
+}
+
+void BoatData::setSubscriptionMinInterval(int id, uint32_t minIntervalMs) {
+    subscriptions.setMinInterval(id, minIntervalMs);
+}
+
+void BoatData::unsubscribe(int id) {
+    subscriptions.unsubscribe(id);
+}
+
+uint8_t BoatData::dispatchChanges(uint32_t nowMs) {
+    return subscriptions.dispatch(changes, nowMs);
+}
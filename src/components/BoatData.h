@@ -9,10 +9,17 @@
  * Features:
  * - Implements IBoatDataStore for read/write access to all sensor data
  * - Implements ISensorUpdate for NMEA/1-Wire message handlers
- * - Validates all incoming data (range + rate-of-change)
+ * - Validates all incoming data (range + outliers against the recent history)
  * - Integrates with SourcePrioritizer for multi-source GPS/compass
  * - Tracks diagnostic counters (message counts, rejections)
- * - Thread-safe for single-threaded ReactESP event loop
+ * - One writer task (main loop); get*() snapshots are consistent from any
+ *   task through per-group sequence counters (see SeqLock)
+ * - Stamps every accepted write with a change generation per group, so
+ *   consumers skip unchanged data (see BoatDataChangeTracker)
+ * - Notifies subscribers of changed groups, coalesced to a minimum
+ *   interval per subscriber (see BoatDataSubscriptions)
+ * - view*() accessors give in-process readers the stored group without a
+ *   copy, paired with its version counter (see BoatDataView)
  *
  * @see specs/003-boatdata-feature-as/data-model.md lines 26-126
  * @see test/contract/test_iboatdatastore_contract.cpp
@@ -24,11 +31,50 @@
 #ifndef BOAT_DATA_H
 #define BOAT_DATA_H
 
+#include <atomic>
+
 #include "../hal/interfaces/IBoatDataStore.h"
 #include "../hal/interfaces/ISensorUpdate.h"
 #include "../hal/interfaces/ISourcePrioritizer.h"
 #include "../utils/DataValidator.h"
 #include "../types/BoatDataTypes.h"
+#include "../utils/SPSCQueue.h"
+#include "../utils/BoatDataChangeTracker.h"
+#include "../utils/BoatDataSubscriptions.h"
+#include "../utils/BoatDataSchema.h"
+#include "../utils/SourceFusion.h"
+#include "../utils/HampelFilter.h"
+#include "../config.h"
+
+/**
+ * @brief Queue of partial updates produced outside the main loop
+ */
+typedef SPSCQueue<BoatDataPatch, N2K_PATCH_QUEUE_CAPACITY> BoatDataPatchQueue;
+
+/**
+ * @brief Write callback (see BoatData::setWriteObserver())
+ *
+ * @param context Pointer passed to setWriteObserver()
+ * @param groups BoatDataGroup bits of the write
+ * @param originUs micros() when the written data was produced
+ */
+typedef void (*BoatDataWriteObserver)(void* context, uint16_t groups, uint32_t originUs);
+
+/**
+ * @brief Opaque handle of a registered GPS/compass producer
+ *
+ * Returned by BoatData::registerSource() and passed back with every
+ * update, so arbitration compares an index instead of a source ID string.
+ * A default-constructed handle is unregistered: its updates are accepted
+ * without arbitration or statistics.
+ */
+struct BoatDataSourceHandle {
+    int8_t index;     ///< Prioritizer source index, -1 = unregistered
+    SensorType type;  ///< Sensor type the source competes as
+
+    BoatDataSourceHandle() : index(-1), type(SensorType::GPS) {}
+    bool valid() const { return index >= 0; }
+};
 
 /**
  * @brief Central boat data repository
@@ -40,14 +86,25 @@
  * @code
  * BoatData boatData(sourcePrioritizer);
  *
- * // NMEA handler updates GPS
- * boatData.updateGPS(40.7128, -74.0060, 1.571, 5.5, "GPS-NMEA0183");
+ * // NMEA handler registers its GPS once, then updates through the handle
+ * BoatDataSourceHandle gps = boatData.registerSource("GPS-NMEA0183", SensorType::GPS,
+ *                                                    ProtocolType::NMEA0183);
+ * boatData.updateGPS(gps, 40.7128, -74.0060, 1.571, 5.5);
  *
  * // Display reads GPS
  * GPSData gps = boatData.getGPSData();
  * if (gps.available) {
  *     Serial.printf("Lat: %.4f, Lon: %.4f\n", gps.latitude, gps.longitude);
  * }
+ *
+ * // In-process reader uses two fields without copying the group
+ * BoatDataView<WindData> wind = boatData.viewWindData();
+ * double aws = wind->apparentWindSpeed;
+ * if (wind.valid()) { ... }
+ *
+ * // Reader on another core skips unchanged groups
+ * uint16_t version = boatData.getVersions().wind.version();
+ * if (version != lastWindVersion) { ... }
  * @endcode
  */
 class BoatData : public IBoatDataStore, public ISensorUpdate {
@@ -97,6 +154,118 @@ public:
     CalibrationData getCalibration() override;
     void setCalibration(const CalibrationData& data) override;
 
+    // =========================================================================
+    // ZERO-COPY VIEWS (see BoatDataView)
+    // =========================================================================
+
+    BoatDataView<GPSData> viewGPSData() const override {
+        return BoatDataView<GPSData>(data.gps, data.versions.gps);
+    }
+    BoatDataView<CompassData> viewCompassData() const override {
+        return BoatDataView<CompassData>(data.compass, data.versions.compass);
+    }
+    BoatDataView<WindData> viewWindData() const override {
+        return BoatDataView<WindData>(data.wind, data.versions.wind);
+    }
+    BoatDataView<SpeedData> viewSpeedData() const override {
+        return BoatDataView<SpeedData>(data.dst, data.versions.dst);
+    }
+    BoatDataView<RudderData> viewRudderData() const override {
+        return BoatDataView<RudderData>(data.rudder, data.versions.rudder);
+    }
+    BoatDataView<DerivedData> viewDerivedData() const override {
+        return BoatDataView<DerivedData>(data.derived, data.versions.derived);
+    }
+    BoatDataView<CalibrationData> viewCalibration() const override {
+        return BoatDataView<CalibrationData>(data.calibration, data.versions.calibration);
+    }
+    BoatDataView<EngineData> viewEngineData() const {
+        return BoatDataView<EngineData>(data.engine, data.versions.engine);
+    }
+    BoatDataView<SaildriveData> viewSaildriveData() const {
+        return BoatDataView<SaildriveData>(data.saildrive, data.versions.saildrive);
+    }
+    BoatDataView<BatteryData> viewBatteryData() const {
+        return BoatDataView<BatteryData>(data.battery, data.versions.battery);
+    }
+    BoatDataView<ShorePowerData> viewShorePowerData() const {
+        return BoatDataView<ShorePowerData>(data.shorePower, data.versions.shorePower);
+    }
+
+    // =========================================================================
+    // PARTIAL (FIELD-LEVEL) UPDATES
+    // =========================================================================
+
+    /**
+     * @brief Update selected fields of a sensor group in place
+     *
+     * Only the fields selected in @p fields are copied from @p values; the
+     * rest of the stored group is left untouched. The group's availability
+     * flag is taken from @p values.available and lastUpdate is set to
+     * millis(). Avoids the get/modify/set round trip (two full struct copies)
+     * for high-rate PGNs that carry one or two fields.
+     *
+     * In SourceFusionMode::BLEND, a GPS/compass patch with a @p source has
+     * its position, COG and headings replaced by the blend of all fresh
+     * sources; from a source other than the active one only those fields
+     * are written.
+     *
+     * @param fields Bitmask of GPSField / CompassField / ... selectors
+     * @param values Source of the selected fields and availability flag
+     * @param source Prioritizer source index of the producer (-1 = unarbitrated)
+     *
+     * @code
+     * CompassData patch;
+     * patch.rateOfTurn = rateOfTurn;
+     * patch.available = true;
+     * boatData->patchCompass(CompassField::RATE_OF_TURN, patch);
+     * @endcode
+     */
+    void patchGPS(uint8_t fields, const GPSData& values, int source = -1);
+    void patchCompass(uint8_t fields, const CompassData& values, int source = -1);
+    void patchWind(uint8_t fields, const WindData& values);
+    void patchDST(uint8_t fields, const DSTData& values);
+    void patchBattery(uint16_t fields, const BatteryData& values);
+
+    /**
+     * @brief Update selected fields of engine @p instance (PGN 127488/127489)
+     *
+     * Written to instances.engines[instance] (instances from
+     * BOATDATA_ENGINE_INSTANCES up are dropped), and for
+     * N2K_ENGINE_PRIMARY_INSTANCE also to the single-engine group, so a
+     * second engine no longer overwrites the first.
+     */
+    void patchEngine(uint8_t fields, const EngineData& values, uint8_t instance = N2K_ENGINE_PRIMARY_INSTANCE);
+
+    /**
+     * @brief Update selected fields of the tank @p values.fluidType / @p values.instance (PGN 127505)
+     *
+     * A tank not seen before takes the next free instances.tanks slot; with
+     * all BOATDATA_TANK_INSTANCES slots assigned it is dropped.
+     *
+     * @param fields Bitmask of TankField selectors
+     */
+    void patchTank(uint8_t fields, const TankData& values);
+
+    /**
+     * @brief Route patch*() calls into a queue instead of applying them
+     *
+     * Used when the NMEA2000 handlers run in their own task: BoatData is
+     * then only written on the main loop, by the queue owner popping
+     * patches and passing them to applyPatch(). While deferred, patch*()
+     * must be called from a single producer task.
+     *
+     * @param queue Queue to push into, or nullptr to apply immediately again
+     */
+    void deferPatches(BoatDataPatchQueue* queue);
+
+    /**
+     * @brief Write the selected fields of a patch into the stored group
+     *
+     * Stamps the group's lastUpdate with the patch timestamp.
+     */
+    void applyPatch(const BoatDataPatch& patch);
+
     // =========================================================================
     // ISensorUpdate IMPLEMENTATION
     // =========================================================================
@@ -107,6 +276,108 @@ public:
     bool updateSpeed(double heelAngle, double boatSpeed, const char* sourceId) override;
     bool updateRudder(double angle, const char* sourceId) override;
 
+    // =========================================================================
+    // ARBITRATED (HANDLE-BASED) UPDATES
+    // =========================================================================
+
+    /**
+     * @brief Register a GPS/compass/battery producer with the source prioritizer
+     *
+     * Call once per source (e.g. on its first sentence) and keep the handle.
+     *
+     * @return Handle for updateGPS()/updateCompass()/updateBattery(); unregistered if there is
+     *         no prioritizer or its table for @p type is full
+     */
+    BoatDataSourceHandle registerSource(const char* sourceId, SensorType type, ProtocolType protocol);
+
+    /**
+     * @brief Arbitrated GPS update
+     *
+     * Records the source's timestamp and update interval, then drops the
+     * update before validation if another source of the handle's type is
+     * active. Dropped and invalid updates are counted per source
+     * (SensorSource::droppedCount / rejectedCount; outliers flagged by the
+     * per-field HampelFilter also in outlierCount). The string-ID
+     * ISensorUpdate overloads stay unarbitrated.
+     *
+     * In SourceFusionMode::BLEND no source is dropped: after validation the
+     * position and COG named in @p fields are blended with the other fresh
+     * sources (see SourceFusion.h), and only the active source writes SOG.
+     *
+     * @param fields GPSField bits of the values this source supplied (the
+     *        others are the stored values passed back); only these are
+     *        outlier-filtered, and only these are blended in BLEND
+     * @return true if the update was stored
+     */
+    bool updateGPS(const BoatDataSourceHandle& source, double lat, double lon, double cog, double sog,
+                   uint8_t fields = GPSField::LATITUDE | GPSField::LONGITUDE | GPSField::COG | GPSField::SOG);
+
+    /**
+     * @brief Arbitrated compass update (see updateGPS(const BoatDataSourceHandle&, ...))
+     *
+     * @param fields CompassField heading bits this source supplied; in BLEND
+     *        only the active source writes the variation
+     */
+    bool updateCompass(const BoatDataSourceHandle& source, double trueHdg, double magHdg, double variation,
+                       uint8_t fields = CompassField::TRUE_HEADING | CompassField::MAGNETIC_HEADING);
+
+    /**
+     * @brief Arbitrated battery update (both banks of one battery monitor)
+     *
+     * Drops the update if another SensorType::BATTERY source is active (e.g.
+     * an NMEA2000 battery monitor tracked by N2kSourceTracker), in every
+     * fusion mode: bank readings of two monitors are never blended.
+     *
+     * @return true if the update was stored
+     */
+    bool updateBattery(const BoatDataSourceHandle& source, const BatteryData& battery);
+
+    /**
+     * @brief Arbitrated heel and pitch update (CompassData.heelAngle / pitchAngle)
+     *
+     * Drops the update if another SensorType::ATTITUDE source is active (a
+     * PGN 127257 sender tracked by N2kSourceTracker), in every fusion mode.
+     * Heel is clamped to its range; a pitch outside its range is clamped and
+     * leaves the compass group unavailable, as for PGN 127257.
+     *
+     * @param heel Radians, positive = starboard
+     * @param pitch Radians, positive = bow up
+     * @return true if the update was stored
+     */
+    bool updateAttitude(const BoatDataSourceHandle& source, double heel, double pitch);
+
+    /**
+     * @brief Select or blend redundant GPS/compass sources (default SOURCE_FUSION_MODE)
+     *
+     * Switching mode forgets the blends.
+     */
+    void setFusionMode(SourceFusionMode mode);
+    SourceFusionMode getFusionMode() const { return fusionMode; }
+
+    /**
+     * @brief Forward a GPS source's fix details to the source prioritizer
+     *
+     * Call for every GGA/fix report of the source, active or not, so the
+     * prioritizer can weigh it (ISourcePrioritizer::updateSourceQuality()).
+     * Unregistered handles are ignored.
+     */
+    void reportSourceQuality(const BoatDataSourceHandle& source, uint8_t fixQuality, uint8_t satellites, double hdop);
+
+    /**
+     * @brief Ask for a manual source override, or its end; any task (HTTP handlers)
+     *
+     * Only records the request. The main loop applies it before the next
+     * GPS/compass update of @p type reaches arbitration (handle update or
+     * applied patch), so the switch lands between two updates and needs no
+     * polling. A newer request of the same type replaces a pending one.
+     *
+     * @param type Sensor type of the override
+     * @param sourceIndex Source of @p type to force, -1 = back to automatic
+     * @return false if there is no prioritizer, or @p sourceIndex is not a
+     *         registered source of @p type
+     */
+    bool requestSourceOverride(SensorType type, int sourceIndex);
+
     // =========================================================================
     // ADDITIONAL PUBLIC METHODS
     // =========================================================================
@@ -140,37 +411,317 @@ public:
      * CalculationEngine to perform derived parameter calculations.
      *
      * @return Pointer to internal BoatDataStructure
-     * @note This is intended for CalculationEngine use only
+     * @note This is intended for CalculationEngine use only. Writes through
+     *       the pointer must be bracketed by the group's
+     *       versions.<group>.writeBegin()/writeEnd(), be reported with
+     *       markChanged() and stay on the writer task.
      */
     BoatDataStructure* getDataStructure();
 
+    /**
+     * @brief Read one field by schema ID (safe from any task)
+     *
+     * @param id BoatDataFieldId (see BoatDataSchema.h)
+     * @param value Field value as double (bool = 0/1)
+     * @return false if @p id is invalid or the read overlapped writes on every attempt
+     */
+    bool getField(uint8_t id, double& value) const;
+
+    /**
+     * @brief Write one field by schema ID (writer task only)
+     *
+     * The value is clamped to the field's schema range. Marks the group
+     * available, stamps its lastUpdate with @p nowMs and reports the change.
+     *
+     * @return false if @p id is invalid or @p value is NaN
+     */
+    bool setField(uint8_t id, double value, unsigned long nowMs);
+
+    /**
+     * @brief Copy every published group (BOATDATA_SCHEMA_GROUPS) into @p out (safe from any task)
+     *
+     * Each group, and the engine and tank slots (instances), is a
+     * consistent snapshot of its own; calibration, diagnostics and versions
+     * in @p out are left untouched.
+     */
+    void getSnapshot(BoatDataStructure& out) const;
+
+    /**
+     * @brief Per-group sequence counters
+     *
+     * version() of a group advances once per completed write, so readers
+     * can detect "unchanged since version N" without copying the group.
+     * For a snapshot tied to its version use
+     * getVersions().<group>.read(getDataStructure()-><group>, out, &version).
+     *
+     * Safe to call from any task.
+     */
+    const BoatDataVersions& getVersions() const;
+
+    /**
+     * @brief Per-group change generations
+     *
+     * Every set*(), update*() and applied patch stamps the groups it wrote.
+     * Consumers keep the generation they last processed and call
+     * getChanges().changedSince(generation) for the dirty mask
+     * (BoatDataGroup bits). Safe to call from any task.
+     */
+    const BoatDataChangeTracker& getChanges() const;
+
+    /**
+     * @brief Copy the engine and tank slots as one consistent snapshot (any task)
+     *
+     * getChanges().instancesChangedSince() tells which slots moved.
+     */
+    void getInstances(BoatDataInstances& out) const;
+
+    /**
+     * @brief Mark groups unavailable that have not been updated within their timeout
+     *
+     * Walks the BOATDATA_STALE_<GROUP>_MS table once; each expired group gets
+     * available = false under its sequence counter and a change mark, so
+     * subscribers (CalculationEngine) react to a sensor going quiet. Call
+     * periodically from the writer task (every BOATDATA_STALE_SWEEP_MS).
+     * Engine and tank slots expire after BOATDATA_STALE_ENGINE_MS and
+     * report as the ENGINE group.
+     *
+     * @param nowMs millis()
+     * @return BoatDataGroup bits expired by this pass (0 = none)
+     */
+    uint16_t sweepStale(unsigned long nowMs);
+
+    /**
+     * @brief Record a write made through getDataStructure() (writer task only)
+     *
+     * @param groups BoatDataGroup bits of the groups written
+     */
+    void markChanged(uint16_t groups);
+
+    /**
+     * @brief Be told of every write (writer task only; one observer, nullptr = none)
+     *
+     * @p originUs is micros() of the producing call: for a queued patch the
+     * time it was made in the receive context, not the time it was applied.
+     * Stale sweeps are not reported (no new data).
+     */
+    void setWriteObserver(BoatDataWriteObserver observer, void* context);
+
+    /**
+     * @brief Get a callback when any of @p groups changes (writer task only)
+     *
+     * The first dispatchChanges() reports every subscribed group written so
+     * far; later callbacks come at most every @p minIntervalMs and carry all
+     * groups written since the previous one. With @p maxIntervalMs the
+     * subscriber is also called (changed = 0) after that long without changes.
+     *
+     * @return Subscription ID, or -1 if all BOATDATA_MAX_SUBSCRIBERS slots are taken
+     */
+    int subscribe(uint16_t groups, uint32_t minIntervalMs, BoatDataChangeCallback callback,
+                  void* context, uint32_t maxIntervalMs = 0);
+
+    /**
+     * @brief How long the changes of subscription @p id's latest callback were held back
+     *
+     * See BoatDataSubscriptions::getWaitMs(); call from the callback.
+     */
+    uint32_t getSubscriptionWaitMs(int id) const;
+
+    /**
+     * @brief Change the minimum interval of subscription @p id (writer task only)
+     *
+     * See BoatDataSubscriptions::setMinInterval(); used by the power profiles.
+     */
+    void setSubscriptionMinInterval(int id, uint32_t minIntervalMs);
+
+    /**
+     * @brief Release a subscription from subscribe()
+     */
+    void unsubscribe(int id);
+
+    /**
+     * @brief Call due subscribers (main loop, every BOATDATA_DISPATCH_INTERVAL_MS)
+     *
+     * @return Number of callbacks made
+     */
+    uint8_t dispatchChanges(uint32_t nowMs);
+
 private:
     // Central data structure
     BoatDataStructure data;
 
+    // Change generations of the groups in data
+    BoatDataChangeTracker changes;
+
+    // Change-notification subscribers
+    BoatDataSubscriptions subscriptions;
+
     // Source prioritizer for GPS/compass
     ISourcePrioritizer* sourcePrioritizer;
 
+    // Last stale check / priority update of the handle update path (millis)
+    unsigned long lastSourceReevalMs;
+
+    // Pending override per SensorType (requestSourceOverride(); NO_SOURCE_REQUEST = none, -1 = clear)
+    static constexpr int8_t NO_SOURCE_REQUEST = -2;
+    std::atomic<int8_t> sourceRequests[SENSOR_TYPE_COUNT];
+
+    // Deferred partial updates (nullptr = patch*() applies immediately)
+    BoatDataPatchQueue* patchQueue;
+
+    // Write observer (setWriteObserver(); nullptr = none)
+    BoatDataWriteObserver writeObserver;
+    void* writeObserverContext;
+
+    // Blends of redundant GPS/compass sources (SourceFusionMode::BLEND)
+    SourceFusionMode fusionMode;
+    PositionFusion positionFusion;
+    AngleFusion cogFusion;
+    AngleFusion trueHeadingFusion;
+    AngleFusion magneticHeadingFusion;
+
+    // Outlier filters of the validated update paths (one history per field)
+    HampelFilter latitudeFilter;
+    HampelFilter longitudeFilter;
+    HampelFilter cogFilter;
+    HampelFilter sogFilter;
+    HampelFilter trueHeadingFilter;
+    HampelFilter magneticHeadingFilter;
+    HampelFilter awaFilter;
+    HampelFilter awsFilter;
+    HampelFilter heelFilter;
+    HampelFilter boatSpeedFilter;
+    HampelFilter rudderFilter;
+
+    /**
+     * @brief Record the producing source of a GPS/compass patch (weight and active flag in BLEND)
+     */
+    void stampSource(BoatDataPatch& patch, SensorType type, int source);
+
+    /**
+     * @brief Mark @p groups changed and tell the write observer
+     *
+     * @param originUs When the data was produced (micros())
+     */
+    void noteChanged(uint16_t groups, uint32_t originUs);
+    void noteChanged(uint16_t groups);
+    void noteChanged(uint16_t groups, BoatDataInstanceMask instances, uint32_t originUs);
+
+    /**
+     * @brief Slot of the tank (@p fluidType, @p instance), assigned on first use
+     *
+     * @return Slot index, BOATDATA_TANK_INSTANCES if every slot belongs to another tank
+     */
+    uint8_t tankSlot(uint8_t fluidType, uint8_t instance);
+
+    /**
+     * @brief Expire engine and tank slots not updated within BOATDATA_STALE_ENGINE_MS
+     */
+    BoatDataInstanceMask sweepStaleInstances(unsigned long nowMs);
+
+    /**
+     * @brief Queue a patch if deferred, otherwise apply it now
+     */
+    void submitPatch(const BoatDataPatch& patch);
+
+    /**
+     * @brief Apply a pending requestSourceOverride() of @p type (main loop)
+     */
+    void applySourceRequest(SensorType type);
+
+    /**
+     * @brief Record an update from @p source and decide whether to use it
+     *
+     * Re-evaluates priorities every BOATDATA_SOURCE_REEVAL_MS, and at once
+     * when no source of the type is active (startup, failover gap).
+     *
+     * @param active Output: @p source is the active source of its type (or none is)
+     * @return false if another source is active (counted as INACTIVE); in
+     *         BLEND always true for a registered source
+     */
+    bool acceptSource(const BoatDataSourceHandle& source, unsigned long now, bool& active);
+
+    /**
+     * @brief Blend the GPS fields of a reading from @p source (BLEND mode)
+     *
+     * Replaces the position (LATITUDE and LONGITUDE both set) and COG named
+     * in @p fields by their blends. Touches no prioritizer state, so queued
+     * patches carry @p weight and @p active from the producing context.
+     *
+     * @param weight Blend weight of the source (fusionWeight())
+     * @param active The source is the active one (isActiveSource())
+     * @return The fields to write: all of @p fields from the active source,
+     *         only the blended ones from any other
+     */
+    uint8_t blendGPS(int source, double weight, bool active, uint8_t fields,
+                     double& lat, double& lon, double& cog, unsigned long now);
+
+    /**
+     * @brief Blend the headings of a reading from @p source (see blendGPS())
+     */
+    uint8_t blendCompass(int source, double weight, bool active, uint8_t fields,
+                         double& trueHdg, double& magHdg, unsigned long now);
+
+    /**
+     * @brief Blend weight of a source: its prioritizer quality (0-1)
+     */
+    double fusionWeight(int source);
+
+    /**
+     * @brief Source is the active one of @p type, or none is active
+     */
+    bool isActiveSource(SensorType type, int source);
+
+    /**
+     * @brief Range validation of a GPS update, then the outlier filters of the supplied fields
+     *
+     * @param fields GPSField bits tested against their history (every
+     *        supplied one is recorded, even when another fails)
+     * @param reason Output on failure: INVALID (range) or OUTLIER
+     */
+    bool isValidGPSUpdate(double lat, double lon, double cog, double sog, uint8_t fields,
+                          SourceRejection& reason);
+
+    /**
+     * @brief Range validation of a compass update, then the outlier filters (see isValidGPSUpdate())
+     */
+    bool isValidCompassUpdate(double trueHdg, double magHdg, uint8_t fields, SourceRejection& reason);
+
+    /**
+     * @brief Store a validated GPS update (SeqLock write, change mark)
+     */
+    void storeGPS(double lat, double lon, double cog, double sog);
+
+    /**
+     * @brief Store a validated compass update; the variation goes to GPSData
+     */
+    void storeCompass(double trueHdg, double magHdg, double variation);
+
     /**
-     * @brief Validate and update GPS data with rate-of-change check
+     * @brief Validate and update GPS data (range check and outlier filters)
      *
      * @param lat Latitude (degrees)
      * @param lon Longitude (degrees)
      * @param cog Course over ground (radians)
      * @param sog Speed over ground (knots)
+     * @param fields GPSField bits the source supplied (outlier-filtered)
+     * @param reason Output on failure: INVALID or OUTLIER
      * @return true if valid and accepted, false if rejected
      */
-    bool validateAndUpdateGPS(double lat, double lon, double cog, double sog);
+    bool validateAndUpdateGPS(double lat, double lon, double cog, double sog, uint8_t fields,
+                              SourceRejection& reason);
 
     /**
-     * @brief Validate and update compass data with rate-of-change check
+     * @brief Validate and update compass data (range check and outlier filters)
      *
      * @param trueHdg True heading (radians)
      * @param magHdg Magnetic heading (radians)
      * @param variation Magnetic variation (radians)
+     * @param fields CompassField bits the source supplied (outlier-filtered)
+     * @param reason Output on failure: INVALID or OUTLIER
      * @return true if valid and accepted, false if rejected
      */
-    bool validateAndUpdateCompass(double trueHdg, double magHdg, double variation);
+    bool validateAndUpdateCompass(double trueHdg, double magHdg, double variation, uint8_t fields,
+                                  SourceRejection& reason);
 };
 
 #endif // BOAT_DATA_H
@@ -0,0 +1,119 @@
+/**
+ * @file BoatDataApiWebServer.cpp
+ * @brief Implementation of the BoatData REST snapshot endpoint
+ *
+ * @see BoatDataApiWebServer.h
+ */
+
+#include "BoatDataApiWebServer.h"
+#include <esp_system.h>
+#include "BoatDataSerializer.h"
+#include "../utils/BoatDataSchema.h"
+#include "../utils/BoatDataSnapshot.h"
+#include "../utils/JsonWriter.h"
+#include "../utils/ScratchArena.h"
+#include "../utils/UtcClock.h"
+
+static_assert(sizeof(BoatDataStructure) + BoatDataSerializer::JSON_BUFFER_SIZE + 2 * ScratchArena::DEFAULT_ALIGNMENT
+                  <= SCRATCH_HTTP_ARENA_BYTES,
+              "SCRATCH_HTTP_ARENA_BYTES too small for GET /api/boatdata");
+
+BoatDataApiWebServer::BoatDataApiWebServer(BoatData* boatDataInstance)
+    : boatData(boatDataInstance), bootTag(esp_random()) {
+}
+
+void BoatDataApiWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || boatData == nullptr) {
+        return;
+    }
+
+    // GET /api/boatdata[?groups=gps,wind][&fmt=bin] - Current values with ETag
+    server->on("/api/boatdata", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGet(request);
+    });
+}
+
+void BoatDataApiWebServer::handleGet(AsyncWebServerRequest* request) {
+    uint16_t groups = BoatDataGroup::ALL;
+    if (request->hasParam("groups") && !parseGroups(request->getParam("groups")->value(), groups)) {
+        request->send(400, "application/json", "{\"status\":\"unknown group\"}");
+        return;
+    }
+    bool binary = request->hasParam("fmt") && request->getParam("fmt")->value() == "bin";
+
+    // Version of the requested groups: checked before anything is copied
+    char etag[40];
+    snprintf(etag, sizeof(etag), "W/\"%08lx-%lx-%x%s\"", (unsigned long)bootTag,
+             (unsigned long)boatData->getChanges().latestOf(groups), (unsigned)groups, binary ? "b" : "");
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match").indexOf(etag) >= 0) {
+        AsyncWebServerResponse* response = request->beginResponse(304);
+        response->addHeader("ETag", etag);
+        request->send(response);
+        return;
+    }
+
+    ScratchScope scratch(GetHttpArena());
+    BoatDataStructure* snapshot = scratch.arena().make<BoatDataStructure>();
+    if (snapshot == nullptr) {
+        request->send(503, "application/json", "{\"status\":\"no scratch memory\"}");
+        return;
+    }
+    // A write racing the copy leaves the body newer than the ETag: the next poll fetches again
+    boatData->getSnapshot(*snapshot);
+    unsigned long now = millis();
+
+    // Streamed responses copy the body, so nothing refers to the arena after return
+    AsyncResponseStream* response;
+    if (binary) {
+        BoatDataSnapshot record;
+        record.fill(*snapshot, now);
+        response = request->beginResponseStream("application/octet-stream", sizeof(record));
+        response->write(reinterpret_cast<const uint8_t*>(&record), sizeof(record));
+    } else {
+        char* buffer = static_cast<char*>(scratch.arena().allocate(BoatDataSerializer::JSON_BUFFER_SIZE, 1));
+        if (buffer == nullptr) {
+            request->send(503, "application/json", "{\"status\":\"no scratch memory\"}");
+            return;
+        }
+        JsonWriter json(buffer, BoatDataSerializer::JSON_BUFFER_SIZE);
+        json.beginObject().add("timestamp", now);
+        uint64_t utc = GetUtcClock().toUtc(now);
+        if (utc != 0) {
+            json.add("utc", static_cast<double>(utc), 0);
+        }
+        BoatDataSchema::writeJson(json, *snapshot, groups);
+        if (groups & BoatDataGroup::ENGINE) {
+            BoatDataSchema::writeInstances(json, snapshot->instances,
+                                           BoatDataSchema::assignedInstances(snapshot->instances));
+        }
+        json.endObject();
+        if (json.overflowed()) {
+            request->send(500, "application/json", "{\"status\":\"snapshot too large\"}");
+            return;
+        }
+        response = request->beginResponseStream("application/json", json.length());
+        response->write(reinterpret_cast<const uint8_t*>(json.c_str()), json.length());
+    }
+    response->addHeader("ETag", etag);
+    response->addHeader("Cache-Control", "no-cache");
+    request->send(response);
+}
+
+bool BoatDataApiWebServer::parseGroups(const String& list, uint16_t& groups) {
+    char names[96];
+    if (list.length() == 0 || list.length() >= sizeof(names)) {
+        return false;
+    }
+    strncpy(names, list.c_str(), sizeof(names));
+
+    groups = 0;
+    char* saveptr = nullptr;
+    for (char* name = strtok_r(names, ",", &saveptr); name != nullptr; name = strtok_r(nullptr, ",", &saveptr)) {
+        uint8_t group = BoatDataSchema::findGroup(name);
+        if (group == BOATDATA_SCHEMA_GROUP_COUNT) {
+            return false;
+        }
+        groups = static_cast<uint16_t>(groups | BoatDataSchema::groupInfo(group).mask);
+    }
+    return groups != 0;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file BoatDataApiWebServer.h
+ * @brief REST snapshot of BoatData with version-based conditional GET
+ *
+ * Provides:
+ * - GET /api/boatdata[?groups=gps,wind][&fmt=bin]: the current values as
+ *   the /boatdata JSON frame (limited to @c groups), or with fmt=bin the
+ *   122-byte BoatDataSnapshot record (always every group)
+ *
+ * For scripts and home-automation integrations that poll instead of
+ * holding the /boatdata WebSocket open. Every response carries a weak
+ * ETag built from the BoatData change generations of the requested
+ * groups (BoatDataChangeTracker::latestOf()), the mask, the format and a
+ * per-boot tag. A request whose If-None-Match still matches is answered
+ * 304 before anything is copied or serialized, so polling static data
+ * costs a few loads.
+ *
+ * Runs on async_tcp: the snapshot copy (seqlocked reads) and the JSON body
+ * come from GetHttpArena().
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): body in the HTTP scratch arena, no heap beyond the response
+ * - Principle V (Network Debugging): current values inspectable with curl
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOATDATA_API_WEB_SERVER_H
+#define BOATDATA_API_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "BoatData.h"
+
+/**
+ * @brief Web server route for the BoatData REST snapshot
+ */
+class BoatDataApiWebServer {
+private:
+    BoatData* boatData;
+    uint32_t bootTag;    ///< Random per boot, so generations of an earlier boot never match
+
+    /**
+     * @brief Handle GET /api/boatdata
+     *
+     * 200 with the body and ETag, 304 if If-None-Match matches, 400 on an
+     * unknown group, 503 if the scratch arena cannot hold the snapshot.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGet(AsyncWebServerRequest* request);
+
+    /**
+     * @brief BoatDataGroup mask of a comma-separated group list ("gps,wind")
+     * @return false on an unknown or empty group name
+     */
+    static bool parseGroups(const String& list, uint16_t& groups);
+
+public:
+    /**
+     * @param boatDataInstance Repository to snapshot
+     */
+    explicit BoatDataApiWebServer(BoatData* boatDataInstance);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // BOATDATA_API_WEB_SERVER_H
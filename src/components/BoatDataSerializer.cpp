@@ -1,183 +1,184 @@
 #include "BoatDataSerializer.h"
 #include "utils/WebSocketLogger.h"
+#include "utils/BoatDataSchema.h"
+#include "utils/JsonWriter.h"
+#include "utils/SignalKDelta.h"
+#include "utils/ScratchArena.h"
+#include "utils/UtcClock.h"
 
 // External logger reference (defined in main.cpp)
 extern WebSocketLogger logger;
 
+BoatDataStructure* BoatDataSerializer::snapshotFromArena(ScratchArena& arena) {
+    BoatDataStructure* snapshot = arena.make<BoatDataStructure>();
+    if (snapshot == nullptr) {
+        logger.broadcastLogf(LogLevel::WARN, LogComponent::BOATDATA_SERIALIZER, LogEvent::BUFFER_OVERFLOW,
+            "{\"scratch_bytes\":%u,\"needed\":%u,\"action\":\"increase SCRATCH_LOOP_ARENA_BYTES\"}",
+            (unsigned)arena.getCapacity(), (unsigned)sizeof(BoatDataStructure));
+    }
+    return snapshot;
+}
+
+char BoatDataSerializer::jsonBuffer_[BoatDataSerializer::JSON_BUFFER_SIZE];
+
 String BoatDataSerializer::toJSON(BoatData* boatData) {
+    JsonWriter json(jsonBuffer_, sizeof(jsonBuffer_));
+    if (toJSON(boatData, json) == 0) {
+        return String("");
+    }
+    return String(json.c_str());
+}
+
+size_t BoatDataSerializer::toJSON(BoatData* boatData, JsonWriter& json, uint16_t groups) {
     // Validate input
     if (boatData == nullptr) {
-        logger.broadcastLog(LogLevel::ERROR, "BoatDataSerializer", "NULL_POINTER",
+        logger.broadcastLog(LogLevel::ERROR, LogComponent::BOATDATA_SERIALIZER, LogEvent::NULL_POINTER,
             F("{\"reason\":\"boatData pointer is null\"}"));
-        return String("");
+        return 0;
     }
 
     // Performance tracking
     unsigned long startTime = micros();
 
-    // Create static JSON document (no heap allocation)
-    StaticJsonDocument<JSON_BUFFER_SIZE> doc;
-
-    // Add root timestamp
-    doc["timestamp"] = millis();
-
-    // Serialize all sensor groups
-    serializeGPS(doc, boatData->getGPSData());
-    serializeCompass(doc, boatData->getCompassData());
-    serializeWind(doc, boatData->getWindData());
-    serializeDST(doc, boatData->getSpeedData());  // SpeedData is typedef for DSTData
-    serializeRudder(doc, boatData->getRudderData());
-    serializeEngine(doc, boatData->getEngineData());
-    serializeSaildrive(doc, boatData->getSaildriveData());
-    serializeBattery(doc, boatData->getBatteryData());
-    serializeShorePower(doc, boatData->getShorePowerData());
-    serializeDerived(doc, boatData->getDerivedData());
+    // Consistent copy of every group, then one pass over the schema
+    ScratchScope scratch(GetLoopArena());
+    BoatDataStructure* snapshot = snapshotFromArena(scratch.arena());
+    if (snapshot == nullptr) {
+        return 0;
+    }
+    boatData->getSnapshot(*snapshot);
+
+    json.reset();
+    unsigned long now = millis();
+    json.beginObject().add("timestamp", now);
+    uint64_t utc = GetUtcClock().toUtc(now);
+    if (utc != 0) {
+        json.add("utc", static_cast<double>(utc), 0);
+    }
+    BoatDataSchema::writeJson(json, *snapshot, groups);
+    if (groups & BoatDataGroup::ENGINE) {
+        BoatDataSchema::writeInstances(json, snapshot->instances, BoatDataSchema::assignedInstances(snapshot->instances));
+    }
+    json.endObject();
 
     // Check for buffer overflow
-    if (doc.overflowed()) {
-        logger.broadcastLog(LogLevel::WARN, "BoatDataSerializer", "BUFFER_OVERFLOW",
-            String(F("{\"buffer_size\":")) + String(JSON_BUFFER_SIZE) +
-            F(",\"action\":\"increase buffer size\"}"));
-        return String("");
+    if (json.overflowed()) {
+        logger.broadcastLogf(LogLevel::WARN, LogComponent::BOATDATA_SERIALIZER, LogEvent::BUFFER_OVERFLOW,
+            "{\"buffer_size\":%u,\"action\":\"increase buffer size\"}", (unsigned)JSON_BUFFER_SIZE);
+        return 0;
     }
 
-    // Serialize to string
-    String output;
-    size_t jsonSize = serializeJson(doc, output);
+    size_t jsonSize = json.length();
 
     // Performance check (<50ms requirement)
     unsigned long elapsedTime = micros() - startTime;
     if (elapsedTime > 50000) {  // 50ms = 50000 microseconds
-        logger.broadcastLog(LogLevel::WARN, "BoatDataSerializer", "PERFORMANCE_EXCEEDED",
-            String(F("{\"elapsed_us\":")) + String(elapsedTime) +
-            F(",\"threshold_us\":50000}"));
+        logger.broadcastLogf(LogLevel::WARN, LogComponent::BOATDATA_SERIALIZER, LogEvent::PERFORMANCE_EXCEEDED,
+            "{\"elapsed_us\":%lu,\"threshold_us\":50000}", elapsedTime);
     }
 
     // Success log (DEBUG level, optional in production)
-    logger.broadcastLog(LogLevel::DEBUG, "BoatDataSerializer", "SERIALIZATION_SUCCESS",
-        String(F("{\"size_bytes\":")) + String(jsonSize) +
-        F(",\"elapsed_us\":") + String(elapsedTime) + F("}"));
+    LOG_DEBUGF(&logger, LogComponent::BOATDATA_SERIALIZER, LogEvent::SERIALIZATION_SUCCESS,
+        "{\"size_bytes\":%u,\"elapsed_us\":%lu}", (unsigned)jsonSize, elapsedTime);
 
-    return output;
+    return jsonSize;
 }
 
-void BoatDataSerializer::serializeGPS(JsonDocument& doc, const GPSData& data) {
-    JsonObject gps = doc.createNestedObject("gps");
-    gps["latitude"] = data.latitude;
-    gps["longitude"] = data.longitude;
-    gps["cog"] = data.cog;
-    gps["sog"] = data.sog;
-    gps["variation"] = data.variation;
-    gps["available"] = data.available;
-    gps["lastUpdate"] = data.lastUpdate;
+String BoatDataSerializer::toDeltaJSON(BoatData* boatData, BoatDataDeltaEncoder& encoder) {
+    JsonWriter json(jsonBuffer_, sizeof(jsonBuffer_));
+    if (toDeltaJSON(boatData, encoder, json) == 0) {
+        return String("");
+    }
+    return String(json.c_str());
 }
 
-void BoatDataSerializer::serializeCompass(JsonDocument& doc, const CompassData& data) {
-    JsonObject compass = doc.createNestedObject("compass");
-    compass["trueHeading"] = data.trueHeading;
-    compass["magneticHeading"] = data.magneticHeading;
-    compass["rateOfTurn"] = data.rateOfTurn;
-    compass["heelAngle"] = data.heelAngle;
-    compass["pitchAngle"] = data.pitchAngle;
-    compass["heave"] = data.heave;
-    compass["available"] = data.available;
-    compass["lastUpdate"] = data.lastUpdate;
+size_t BoatDataSerializer::toDeltaJSON(BoatData* boatData, BoatDataDeltaEncoder& encoder, JsonWriter& json) {
+    ScratchScope scratch(GetLoopArena());
+    BoatDataStructure* snapshot = snapshotFromArena(scratch.arena());
+    BoatDataDeltaSet set;
+    if (snapshot == nullptr || !updateDelta(boatData, encoder, *snapshot, set)) {
+        return 0;
+    }
+    size_t length = toDeltaJSON(*snapshot, set, json);
+    if (length == 0) {
+        encoder.requestKeyframe();  // Baseline already advanced; resynchronise the clients
+    }
+    return length;
 }
 
-void BoatDataSerializer::serializeWind(JsonDocument& doc, const WindData& data) {
-    JsonObject wind = doc.createNestedObject("wind");
-    wind["apparentWindAngle"] = data.apparentWindAngle;
-    wind["apparentWindSpeed"] = data.apparentWindSpeed;
-    wind["available"] = data.available;
-    wind["lastUpdate"] = data.lastUpdate;
-}
+bool BoatDataSerializer::updateDelta(BoatData* boatData, BoatDataDeltaEncoder& encoder,
+                                     BoatDataStructure& snapshot, BoatDataDeltaSet& set) {
+    if (boatData == nullptr) {
+        logger.broadcastLog(LogLevel::ERROR, LogComponent::BOATDATA_SERIALIZER, LogEvent::NULL_POINTER,
+            F("{\"reason\":\"boatData pointer is null\"}"));
+        return false;
+    }
 
-void BoatDataSerializer::serializeDST(JsonDocument& doc, const DSTData& data) {
-    JsonObject dst = doc.createNestedObject("dst");
-    dst["depth"] = data.depth;
-    dst["measuredBoatSpeed"] = data.measuredBoatSpeed;
-    dst["seaTemperature"] = data.seaTemperature;
-    dst["available"] = data.available;
-    dst["lastUpdate"] = data.lastUpdate;
-}
+    // Generation first: anything written during the copy is dirty again next time
+    const BoatDataChangeTracker& changes = boatData->getChanges();
+    uint32_t generation = changes.getGeneration();
+    uint16_t dirty = changes.changedSince(encoder.getGeneration());
+    BoatDataInstanceMask slots = changes.instancesChangedSince(encoder.getGeneration());
 
-void BoatDataSerializer::serializeRudder(JsonDocument& doc, const RudderData& data) {
-    JsonObject rudder = doc.createNestedObject("rudder");
-    rudder["steeringAngle"] = data.steeringAngle;
-    rudder["available"] = data.available;
-    rudder["lastUpdate"] = data.lastUpdate;
+    boatData->getSnapshot(snapshot);
+    encoder.update(snapshot, dirty, slots, generation, millis(), set);
+    return true;
 }
 
-void BoatDataSerializer::serializeEngine(JsonDocument& doc, const EngineData& data) {
-    JsonObject engine = doc.createNestedObject("engine");
-    engine["engineRev"] = data.engineRev;
-    engine["oilTemperature"] = data.oilTemperature;
-    engine["alternatorVoltage"] = data.alternatorVoltage;
-    engine["available"] = data.available;
-    engine["lastUpdate"] = data.lastUpdate;
-}
+size_t BoatDataSerializer::toDeltaJSON(const BoatDataStructure& snapshot, const BoatDataDeltaSet& set,
+                                       JsonWriter& json) {
+    json.reset();
+    BoatDataDeltaEncoder::writeJson(json, snapshot, set);
 
-void BoatDataSerializer::serializeSaildrive(JsonDocument& doc, const SaildriveData& data) {
-    JsonObject saildrive = doc.createNestedObject("saildrive");
-    saildrive["saildriveEngaged"] = data.saildriveEngaged;
-    saildrive["available"] = data.available;
-    saildrive["lastUpdate"] = data.lastUpdate;
-}
+    if (json.overflowed()) {
+        logger.broadcastLogf(LogLevel::WARN, LogComponent::BOATDATA_SERIALIZER, LogEvent::BUFFER_OVERFLOW,
+            "{\"buffer_size\":%u,\"action\":\"increase buffer size\"}", (unsigned)JSON_BUFFER_SIZE);
+        return 0;
+    }
 
-void BoatDataSerializer::serializeBattery(JsonDocument& doc, const BatteryData& data) {
-    JsonObject battery = doc.createNestedObject("battery");
-
-    // Battery A (House Bank)
-    battery["voltageA"] = data.voltageA;
-    battery["amperageA"] = data.amperageA;
-    battery["stateOfChargeA"] = data.stateOfChargeA;
-    battery["shoreChargerOnA"] = data.shoreChargerOnA;
-    battery["engineChargerOnA"] = data.engineChargerOnA;
-
-    // Battery B (Starter Bank)
-    battery["voltageB"] = data.voltageB;
-    battery["amperageB"] = data.amperageB;
-    battery["stateOfChargeB"] = data.stateOfChargeB;
-    battery["shoreChargerOnB"] = data.shoreChargerOnB;
-    battery["engineChargerOnB"] = data.engineChargerOnB;
-
-    // Common metadata
-    battery["available"] = data.available;
-    battery["lastUpdate"] = data.lastUpdate;
-}
+    LOG_DEBUGF(&logger, LogComponent::BOATDATA_SERIALIZER, LogEvent::DELTA_SUCCESS,
+        "{\"size_bytes\":%u,\"keyframe\":%s}", (unsigned)json.length(), set.keyframe ? "true" : "false");
 
-void BoatDataSerializer::serializeShorePower(JsonDocument& doc, const ShorePowerData& data) {
-    JsonObject shorePower = doc.createNestedObject("shorePower");
-    shorePower["shorePowerOn"] = data.shorePowerOn;
-    shorePower["power"] = data.power;
-    shorePower["available"] = data.available;
-    shorePower["lastUpdate"] = data.lastUpdate;
+    return json.length();
 }
 
-void BoatDataSerializer::serializeDerived(JsonDocument& doc, const DerivedData& data) {
-    JsonObject derived = doc.createNestedObject("derived");
+size_t BoatDataSerializer::toSignalK(const BoatDataStructure& snapshot, const BoatDataDeltaSet& set,
+                                     JsonWriter& json, const char* timestamp) {
+    json.reset();
+    uint8_t values = SignalKDelta::write(json, snapshot, set, timestamp);
 
-    // Corrected apparent wind angles
-    derived["awaOffset"] = data.awaOffset;
-    derived["awaHeel"] = data.awaHeel;
+    if (json.overflowed()) {
+        logger.broadcastLogf(LogLevel::WARN, LogComponent::BOATDATA_SERIALIZER, LogEvent::BUFFER_OVERFLOW,
+            "{\"buffer_size\":%u,\"action\":\"increase buffer size\"}", (unsigned)SIGNALK_BUFFER_SIZE);
+        return 0;
+    }
 
-    // Leeway and speed
-    derived["leeway"] = data.leeway;
-    derived["stw"] = data.stw;
+    LOG_DEBUGF(&logger, LogComponent::BOATDATA_SERIALIZER, LogEvent::SIGNALK_SUCCESS,
+        "{\"size_bytes\":%u,\"values\":%u}", (unsigned)json.length(), (unsigned)values);
 
-    // True wind
-    derived["tws"] = data.tws;
-    derived["twa"] = data.twa;
-    derived["wdir"] = data.wdir;
+    return json.length();
+}
 
-    // Performance
-    derived["vmg"] = data.vmg;
+bool BoatDataSerializer::toBinary(BoatData* boatData, BoatDataSnapshot& frame, uint16_t groups) {
+    if (boatData == nullptr) {
+        logger.broadcastLog(LogLevel::ERROR, LogComponent::BOATDATA_SERIALIZER, LogEvent::NULL_POINTER,
+            F("{\"reason\":\"boatData pointer is null\"}"));
+        return false;
+    }
+
+    unsigned long startTime = micros();
+    ScratchScope scratch(GetLoopArena());
+    BoatDataStructure* snapshot = snapshotFromArena(scratch.arena());
+    if (snapshot == nullptr) {
+        return false;
+    }
+    boatData->getSnapshot(*snapshot);
+    frame.fill(*snapshot, static_cast<uint32_t>(millis()));
+    frame.present = static_cast<uint16_t>(frame.present & groups);  // Fixed layout: unsubscribed groups read unavailable
+    unsigned long elapsedTime = micros() - startTime;
 
-    // Current
-    derived["soc"] = data.soc;
-    derived["doc"] = data.doc;
+    LOG_DEBUGF(&logger, LogComponent::BOATDATA_SERIALIZER, LogEvent::BINARY_SUCCESS,
+        "{\"size_bytes\":%u,\"elapsed_us\":%lu}", (unsigned)sizeof(frame), elapsedTime);
 
-    // Common metadata
-    derived["available"] = data.available;
-    derived["lastUpdate"] = data.lastUpdate;
+    return true;
 }
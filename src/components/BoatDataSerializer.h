@@ -2,16 +2,25 @@
 #define BOAT_DATA_SERIALIZER_H
 
 #include <Arduino.h>
-#include <ArduinoJson.h>
 #include "types/BoatDataTypes.h"
 #include "components/BoatData.h"
+#include "utils/BoatDataDelta.h"
+#include "utils/BoatDataSnapshot.h"
+#include "utils/JsonWriter.h"
+
+class ScratchArena;
 
 /**
  * @file BoatDataSerializer.h
  * @brief JSON serialization component for BoatData structures
  *
  * Converts the complete BoatData repository to JSON format for WebSocket streaming.
- * Uses ArduinoJson v6.x with static allocation for memory safety.
+ * Groups, keys and number precision come from the BoatDataSchema field table
+ * (BoatDataSchema::writeJson()); output goes into a caller-owned JsonWriter,
+ * or for the String variants one static document reused per call.
+ * JSON_BUFFER_SIZE is computed from the schema, so it grows with it.
+ * The BoatDataStructure copies are taken from the loop scratch arena
+ * (GetLoopArena()): call from main-loop reactions only.
  *
  * @note Part of Feature 011-simple-webui-as (Simple WebUI for BoatData Streaming)
  * @see specs/011-simple-webui-as/contracts/BoatDataSerializerContract.md
@@ -30,7 +39,8 @@ public:
      * @return String JSON-formatted string (~1500-1800 bytes), empty string on error
      *
      * @note Performance: <50ms on ESP32 @ 240 MHz
-     * @note Memory: Uses static buffer (2048 bytes), no heap allocations
+     * @note Memory: JSON in the static document (JSON_BUFFER_SIZE), the BoatDataStructure
+     *       copy in the loop scratch arena; the returned String is the only heap use
      * @note Error Handling: Returns empty string on null pointer or buffer overflow
      *
      * @example
@@ -39,79 +49,92 @@ public:
      */
     static String toJSON(BoatData* boatData);
 
-private:
-    // Static JSON buffer size (sufficient for all BoatData fields + 27% margin)
-    static constexpr size_t JSON_BUFFER_SIZE = 2048;
-
     /**
-     * @brief Serialize GPS data group
-     * @param doc ArduinoJson document
-     * @param data GPS data structure
+     * @brief Serialize complete BoatData structure into a caller-owned writer
+     *
+     * Same output as toJSON(BoatData*) without the String copy: the broadcast
+     * loop points @p json at a pooled WebSocket buffer and sends that buffer
+     * to every full-frame client.
+     *
+     * @param boatData Pointer to BoatData repository (must not be nullptr)
+     * @param json Writer to reset and fill (JSON_BUFFER_SIZE bytes suffice)
+     * @param groups BoatDataGroup mask of the groups to write (a client subscription)
+     * @return Bytes written (excluding the terminator), 0 on error
      */
-    static void serializeGPS(JsonDocument& doc, const GPSData& data);
+    static size_t toJSON(BoatData* boatData, JsonWriter& json, uint16_t groups = BoatDataGroup::ALL);
 
     /**
-     * @brief Serialize Compass data group
-     * @param doc ArduinoJson document
-     * @param data Compass data structure
+     * @brief Serialize the next keyframe or delta of the /boatdata?mode=delta stream
+     *
+     * Copies the groups after reading the change generation, so a write that
+     * races the copy is compared again on the next call.
+     *
+     * @param boatData Pointer to BoatData repository (must not be nullptr)
+     * @param encoder Shared encoder of the delta clients (broadcast loop only)
+     * @return String keyframe (~1.8 KB) or delta (typically <200 bytes), empty string on error
      */
-    static void serializeCompass(JsonDocument& doc, const CompassData& data);
+    static String toDeltaJSON(BoatData* boatData, BoatDataDeltaEncoder& encoder);
 
-    /**
-     * @brief Serialize Wind data group
-     * @param doc ArduinoJson document
-     * @param data Wind data structure
-     */
-    static void serializeWind(JsonDocument& doc, const WindData& data);
+    /// toDeltaJSON() into a caller-owned writer; returns bytes written, 0 on error
+    static size_t toDeltaJSON(BoatData* boatData, BoatDataDeltaEncoder& encoder, JsonWriter& json);
 
     /**
-     * @brief Serialize DST (Depth/Speed/Temperature) data group
-     * @param doc ArduinoJson document
-     * @param data DST data structure
+     * @brief Copy BoatData and compare it once with the shared delta baseline
+     *
+     * The resulting @p set feeds both toDeltaJSON(snapshot, set, ...) for
+     * /boatdata?mode=delta and toSignalK() for /signalk/v1/stream, so the
+     * second protocol costs one more render, not another comparison.
+     *
+     * @param snapshot Receives the copy the set refers to
+     * @param set Receives the changed fields (keyframe: all)
+     * @return false on null pointer
      */
-    static void serializeDST(JsonDocument& doc, const DSTData& data);
+    static bool updateDelta(BoatData* boatData, BoatDataDeltaEncoder& encoder,
+                            BoatDataStructure& snapshot, BoatDataDeltaSet& set);
 
-    /**
-     * @brief Serialize Rudder data group
-     * @param doc ArduinoJson document
-     * @param data Rudder data structure
-     */
-    static void serializeRudder(JsonDocument& doc, const RudderData& data);
+    /// Render @p set as a /boatdata?mode=delta frame; bytes written, 0 on overflow (request a keyframe)
+    static size_t toDeltaJSON(const BoatDataStructure& snapshot, const BoatDataDeltaSet& set, JsonWriter& json);
 
     /**
-     * @brief Serialize Engine data group
-     * @param doc ArduinoJson document
-     * @param data Engine data structure
+     * @brief Render @p set as a Signal K delta message (SignalKDelta)
+     *
+     * @param timestamp ISO 8601 UTC time, nullptr to omit it
+     * @return Bytes written, 0 on overflow (SIGNALK_BUFFER_SIZE bytes suffice)
      */
-    static void serializeEngine(JsonDocument& doc, const EngineData& data);
+    static size_t toSignalK(const BoatDataStructure& snapshot, const BoatDataDeltaSet& set,
+                            JsonWriter& json, const char* timestamp);
 
     /**
-     * @brief Serialize Saildrive data group
-     * @param doc ArduinoJson document
-     * @param data Saildrive data structure
+     * @brief Encode BoatData as one binary frame for /boatdata?fmt=bin clients
+     *
+     * The frame is the packed BoatDataSnapshot (122 bytes, fixed-point values,
+     * present bitmap, little-endian) sent as-is; see BoatDataSnapshot.h for
+     * the layout the JavaScript decoders follow.
+     *
+     * @param boatData Pointer to BoatData repository (must not be nullptr)
+     * @param frame Output record
+     * @param groups BoatDataGroup mask; other groups are cleared from the present bitmap
+     * @return false on null pointer
+     *
+     * @note Performance: tens of microseconds (snapshot copy + one fixed-point pass)
      */
-    static void serializeSaildrive(JsonDocument& doc, const SaildriveData& data);
+    static bool toBinary(BoatData* boatData, BoatDataSnapshot& frame, uint16_t groups = BoatDataGroup::ALL);
 
-    /**
-     * @brief Serialize Battery data group (dual banks A and B)
-     * @param doc ArduinoJson document
-     * @param data Battery data structure
-     */
-    static void serializeBattery(JsonDocument& doc, const BatteryData& data);
+    // Longest /boatdata document or delta keyframe (every field at the longest value of
+    // its schema range, ~1.8 KB), the "utc" stamp once the UtcClock is synced (13 digits
+    // until 2286) and the terminator; callers size their send buffers with it
+    static constexpr size_t JSON_BUFFER_SIZE =
+        BoatDataDeltaEncoder::JSON_MAX_BYTES + sizeof(",\"utc\":4102444800000") - 1 + 1;
 
-    /**
-     * @brief Serialize Shore Power data group
-     * @param doc ArduinoJson document
-     * @param data Shore Power data structure
-     */
-    static void serializeShorePower(JsonDocument& doc, const ShorePowerData& data);
+    // Signal K keyframe (every mapped path, ~2.1 KB) + margin
+    static constexpr size_t SIGNALK_BUFFER_SIZE = 3072;
 
-    /**
-     * @brief Serialize Derived data group (calculated sailing parameters)
-     * @param doc ArduinoJson document
-     * @param data Derived data structure
-     */
-    static void serializeDerived(JsonDocument& doc, const DerivedData& data);
+private:
+    /// Document of the String variants, cleared (reset()) per call; main loop only
+    static char jsonBuffer_[JSON_BUFFER_SIZE];
+
+    /// BoatDataStructure from @p arena, nullptr (logged) if it is exhausted
+    static BoatDataStructure* snapshotFromArena(ScratchArena& arena);
 };
 
 #endif // BOAT_DATA_SERIALIZER_H
@@ -0,0 +1,100 @@
+/**
+ * @file BoatDataStreamStatsWebServer.cpp
+ * @brief Implementation of the /boatdata client statistics endpoint
+ *
+ * @see BoatDataStreamStatsWebServer.h
+ */
+
+#include "BoatDataStreamStatsWebServer.h"
+#include "../utils/JsonWriter.h"
+
+BoatDataStreamStatsWebServer::BoatDataStreamStatsWebServer(const BoatDataStreamClients* streamClients,
+                                                           AsyncWebSocket* boatDataSocket,
+                                                           const BoatDataRateGovernor* rateGovernor)
+    : clients(streamClients), socket(boatDataSocket), governor(rateGovernor), replay(nullptr) {
+}
+
+void BoatDataStreamStatsWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || clients == nullptr || socket == nullptr) {
+        return;
+    }
+
+    // GET /boatdata/stats - per-client frame counters
+    server->on("/boatdata/stats", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetStats(request);
+    });
+}
+
+void BoatDataStreamStatsWebServer::handleGetStats(AsyncWebServerRequest* request) {
+    uint32_t now = millis();
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+
+    response->printf("{\"uptime_ms\":%lu,\"clients\":%u,\"dropped_total\":%lu,\"evicted\":%lu,"
+                     "\"max_queued\":%u,\"evict_ms\":%lu,\"streams\":[",
+        (unsigned long)now, (unsigned)clients->count(), (unsigned long)clients->getDroppedTotal(),
+        (unsigned long)clients->getEvicted(), (unsigned)BOATDATA_STREAM_MAX_QUEUED,
+        (unsigned long)BOATDATA_STREAM_EVICT_MS);
+
+    bool first = true;
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        BoatDataStreamClientStats stats;
+        if (!clients->getStats(i, stats, now)) {
+            continue;
+        }
+        AsyncWebSocketClient* client = socket->client(stats.id);
+        const char* mode = stats.mode == BoatDataStreamMode::BINARY ? "bin"
+                         : stats.mode == BoatDataStreamMode::DELTA ? "delta" : "full";
+
+        StaticJsonWriter<192> item;
+        item.beginObject()
+            .add("id", (unsigned long)stats.id)
+            .add("mode", mode)
+            .add("groups", (unsigned long)stats.groups)
+            .add("interval_ms", (unsigned long)stats.intervalMs)
+            .add("queued", (unsigned long)(client != nullptr ? client->queueLen() : 0))
+            .add("sent", (unsigned long)stats.sent)
+            .add("dropped", (unsigned long)stats.dropped)
+            .add("behind_ms", (unsigned long)stats.behindMs)
+            .endObject();
+        if (!first) {
+            response->print(',');
+        }
+        response->print(item.c_str());
+        first = false;
+    }
+
+    response->print(']');
+
+    // Why the default rate is what it is
+    StaticJsonWriter<256> rate;
+    rate.beginObject()
+        .add("default_interval_ms", (unsigned long)clients->getDefaultTicks() * BOATDATA_STREAM_TICK_MS);
+    if (governor != nullptr) {
+        const BoatDataGovernorInputs& inputs = governor->getInputs();
+        rate.beginObject("governor")
+            .add("state", BoatDataRateGovernor::stateName(governor->getState()))
+            .add("keyframe_ms", (unsigned long)governor->getKeyframeMs())
+            .add("floor_interval_ms", (unsigned long)governor->getFloorTicks() * BOATDATA_STREAM_TICK_MS)
+            .add("changes", (unsigned long)governor->getChanges())
+            .add("loop_hz", (unsigned long)inputs.loopHz);
+        if (inputs.cpuIdlePct == CPU_IDLE_UNKNOWN) {
+            rate.add("cpu_idle_pct", static_cast<const char*>(nullptr));
+        } else {
+            rate.add("cpu_idle_pct", (unsigned int)inputs.cpuIdlePct);
+        }
+        rate.add("free_heap", (unsigned long)inputs.freeHeap)
+            .add("max_queued", (unsigned long)inputs.maxQueued)
+            .endObject();
+    }
+    rate.endObject();
+    response->print(",\"rate\":");
+    response->print(rate.c_str());
+    if (replay != nullptr) {
+        StaticJsonWriter<192> ring;
+        replay->writeJson(ring);
+        response->print(",\"replay\":");
+        response->print(ring.c_str());
+    }
+    response->print('}');
+    request->send(response);
+}
@@ -0,0 +1,90 @@
+/**
+ * @file BoatDataStreamStatsWebServer.h
+ * @brief HTTP endpoint for the /boatdata WebSocket client counters
+ *
+ * Provides:
+ * - GET /boatdata/stats: per-client format, subscription, queue depth and
+ *   sent/dropped frame counts, totals and evictions since boot, and the
+ *   default rate with the governor state and inputs behind it, and the
+ *   ?since= replay ring
+ *
+ * Registered by setupBoatDataWebSocket() next to the /boatdata socket.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef BOATDATA_STREAM_STATS_WEB_SERVER_H
+#define BOATDATA_STREAM_STATS_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../utils/BoatDataStreamClients.h"
+#include "../utils/BoatDataRateGovernor.h"
+#include "../utils/BoatDataReplay.h"
+
+/**
+ * @brief Web server routes for the /boatdata client table
+ */
+class BoatDataStreamStatsWebServer {
+private:
+    const BoatDataStreamClients* clients;
+    AsyncWebSocket* socket;
+    const BoatDataRateGovernor* governor;
+    const BoatDataReplay* replay;
+
+    /**
+     * @brief Handle GET /boatdata/stats
+     *
+     * Returns:
+     * {
+     *   "uptime_ms": 123456, "clients": 2, "dropped_total": 37, "evicted": 1,
+     *   "max_queued": 2, "evict_ms": 10000,
+     *   "streams": [
+     *     {"id": 3, "mode": "full", "groups": 6, "interval_ms": 100, "queued": 0,
+     *      "sent": 9120, "dropped": 12, "behind_ms": 0},
+     *     ...
+     *   ],
+     *   "rate": {
+     *     "default_interval_ms": 2000,
+     *     "governor": {"state": "pressure", "keyframe_ms": 20000, "floor_interval_ms": 2000,
+     *                  "changes": 3, "loop_hz": 140, "free_heap": 61234, "max_queued": 2}
+     *   },
+     *   "replay": {"records": 30, "capacity": 30, "interval_ms": 2000, "sequence": 1234,
+     *              "oldest_ms": 61234, "bursts": 3, "replayed": 71}
+     * }
+     *
+     * "governor" is absent when it is disabled (BOATDATA_GOVERNOR_ENABLED 0),
+     * "replay" without setReplay() (BOATDATA_REPLAY_ENABLED 0).
+     *
+     * Counters are read without locking while the broadcast loop updates
+     * them; a value may lag by one frame.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetStats(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param streamClients Client table of the broadcast loop
+     * @param boatDataSocket The /boatdata socket (queue depths)
+     * @param rateGovernor Default-rate governor, nullptr if disabled
+     */
+    BoatDataStreamStatsWebServer(const BoatDataStreamClients* streamClients, AsyncWebSocket* boatDataSocket,
+                                 const BoatDataRateGovernor* rateGovernor = nullptr);
+
+    /// Report @p replayRing as "replay" (before registerRoutes())
+    void setReplay(const BoatDataReplay* replayRing) { replay = replayRing; }
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // BOATDATA_STREAM_STATS_WEB_SERVER_H
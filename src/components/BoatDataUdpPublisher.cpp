@@ -0,0 +1,85 @@
+/**
+ * @file BoatDataUdpPublisher.cpp
+ * @brief Implementation of the BoatData UDP publisher
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BoatDataUdpPublisher.h"
+#include <string.h>
+
+BoatDataUdpPublisher::BoatDataUdpPublisher()
+    : logger(nullptr), started(false), sent(0), failed(0) {
+    memset(&datagram, 0, sizeof(datagram));
+    datagram.magic = BOATDATA_DATAGRAM_MAGIC;
+}
+
+bool BoatDataUdpPublisher::begin(WebSocketLogger* log) {
+    if (log == nullptr || started) {
+        return false;
+    }
+    logger = log;
+
+    if (!group.fromString(BOATDATA_UDP_GROUP)) {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::BOATDATA_UDP, LogEvent::INVALID_GROUP,
+            "{\"group\":\"%s\"}", BOATDATA_UDP_GROUP);
+        return false;
+    }
+
+#if !BOATDATA_UDP_BROADCAST
+    // Joining the group also sets the multicast TTL of the pcb (lwIP default: 255)
+    if (!udp.listenMulticast(group, BOATDATA_UDP_PORT, BOATDATA_UDP_TTL)) {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::BOATDATA_UDP, LogEvent::MULTICAST_FAILED,
+            "{\"group\":\"%s\",\"port\":%d}", BOATDATA_UDP_GROUP, BOATDATA_UDP_PORT);
+        return false;
+    }
+#endif
+    started = true;
+
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::BOATDATA_UDP, LogEvent::BOATDATA_UDP_STARTED,
+        "{\"destination\":\"%s\",\"port\":%d,\"interval_ms\":%d,\"size\":%u}",
+        BOATDATA_UDP_BROADCAST ? "broadcast" : BOATDATA_UDP_GROUP, BOATDATA_UDP_PORT,
+        BOATDATA_UDP_INTERVAL_MS, (unsigned)sizeof(datagram));
+    return true;
+}
+
+void BoatDataUdpPublisher::publish(const BoatDataStructure& data, uint32_t nowMs) {
+    if (!started) {
+        return;
+    }
+
+    BoatDataSnapshot snapshot;
+    snapshot.fill(data, nowMs);
+    publish(snapshot);
+}
+
+void BoatDataUdpPublisher::publish(const BoatDataSnapshot& snapshot) {
+    if (!started) {
+        return;
+    }
+
+    datagram.snapshot = snapshot;
+    datagram.sequence++;
+
+    uint8_t* bytes = reinterpret_cast<uint8_t*>(&datagram);
+#if BOATDATA_UDP_BROADCAST
+    size_t written = udp.broadcastTo(bytes, sizeof(datagram), BOATDATA_UDP_PORT);
+#else
+    size_t written = udp.writeTo(bytes, sizeof(datagram), group, BOATDATA_UDP_PORT);
+#endif
+    if (written == sizeof(datagram)) {
+        sent++;
+    } else {
+        failed++;  // The sequence number still advances: listeners count it as lost
+    }
+}
+
+void BoatDataUdpPublisher::logStats() const {
+    if (logger == nullptr || !started) {
+        return;
+    }
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::BOATDATA_UDP, LogEvent::BOATDATA_UDP_STATS,
+        "{\"sent\":%lu,\"failed\":%lu,\"sequence\":%lu}",
+        (unsigned long)sent, (unsigned long)failed, (unsigned long)datagram.sequence);
+}
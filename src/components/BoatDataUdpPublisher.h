@@ -0,0 +1,90 @@
+/**
+ * @file BoatDataUdpPublisher.h
+ * @brief BoatData binary snapshot over UDP multicast (or subnet broadcast)
+ *
+ * Every BOATDATA_UDP_INTERVAL_MS the publisher fills one BoatDataDatagram
+ * (magic, sequence number, 122-byte BoatDataSnapshot) and sends it once to
+ * BOATDATA_UDP_GROUP:BOATDATA_UDP_PORT. Any number of displays can listen:
+ * the ESP32 sends the same single datagram whether there are none or fifty,
+ * with no per-listener TCP state, queue or heap in lwIP.
+ *
+ * UDP is lossy and unordered; listeners use the sequence number to drop
+ * stale or duplicated datagrams and to count losses. Each datagram holds the
+ * complete state, so a lost one costs nothing but its own update.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): one static 130-byte datagram, one AsyncUDP pcb
+ * - Principle V (Network Debugging): BOATDATA_UDP_STARTED and BOATDATA_UDP_STATS log events
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOATDATA_UDP_PUBLISHER_H
+#define BOATDATA_UDP_PUBLISHER_H
+
+#include <Arduino.h>
+#include <AsyncUDP.h>
+#include "../types/BoatDataTypes.h"
+#include "../utils/BoatDataSnapshot.h"
+#include "../utils/WebSocketLogger.h"
+#include "../config.h"
+
+/**
+ * @class BoatDataUdpPublisher
+ * @brief Fixed-rate BoatDataDatagram sender (main loop)
+ *
+ * Usage pattern:
+ * @code
+ * boatDataUdpPublisher.begin(&logger);                 // once WiFi is up
+ * outputPipeline.add("udp", BoatDataGroup::ALL, BOATDATA_UDP_INTERVAL_MS, BOATDATA_UDP_INTERVAL_MS,
+ *     OutputEncoding::SNAPSHOT, [](void*, const OutputBatch& batch) {
+ *         boatDataUdpPublisher.publish(batch.snapshot());
+ *     }, nullptr);
+ * @endcode
+ */
+class BoatDataUdpPublisher {
+public:
+    BoatDataUdpPublisher();
+
+    /**
+     * @brief Open the UDP pcb (multicast TTL BOATDATA_UDP_TTL)
+     * @param logger WebSocket logger for start and stats events
+     * @return false if logger is nullptr, already started, or the group address is invalid
+     */
+    bool begin(WebSocketLogger* logger);
+
+    /**
+     * @brief Send one datagram with the current state (no-op before begin())
+     * @param data BoatData structure (consistent: main loop)
+     * @param nowMs Current millis()
+     */
+    void publish(const BoatDataStructure& data, uint32_t nowMs);
+
+    /**
+     * @brief Send one datagram with an already filled snapshot (OutputPipeline sink)
+     * @param snapshot State to send (copied into the datagram)
+     */
+    void publish(const BoatDataSnapshot& snapshot);
+
+    /**
+     * @brief Log BOATDATA_UDP_STATS (sent, failed, sequence)
+     */
+    void logStats() const;
+
+    bool isStarted() const { return started; }
+    uint32_t getSequence() const { return datagram.sequence; }
+    uint32_t getSent() const { return sent; }
+    uint32_t getFailed() const { return failed; }
+
+private:
+    AsyncUDP udp;
+    WebSocketLogger* logger;
+    IPAddress group;
+    BoatDataDatagram datagram;
+    bool started;
+    uint32_t sent;
+    uint32_t failed;   ///< Datagrams lwIP refused (no buffer, interface down)
+};
+
+#endif // BOATDATA_UDP_PUBLISHER_H
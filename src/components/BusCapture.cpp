@@ -0,0 +1,313 @@
+/**
+ * @file BusCapture.cpp
+ * @brief Implementation of the double-buffered raw bus recorder
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BusCapture.h"
+#include "../utils/BufferPlacement.h"
+#include "../utils/OtaUpdate.h"
+#include "../utils/UtcClock.h"
+
+BusCapture::BusCapture()
+    : bufferSize_(0), fillIndex_(0), fillLength_(0), fillStartMs_(0),
+      writeLength_(0), truncatePending_(false), closePending_(false),
+      bytesWritten_(0), writeErrors_(0),
+      state_(STATE_IDLE), startRequested_(false), stopRequested_(false), stopReason_(""),
+      startMs_(0), lastRecordMs_(0), encodedBytes_(0),
+      records_(0), lines_(0), frames_(0), dropped_(0), queueDroppedBase_(0), utcSteps_(0),
+      nextObserver_(nullptr), nextObserverContext_(nullptr),
+      logger_(nullptr), taskHandle_(nullptr) {
+    buffers_[0] = nullptr;
+    buffers_[1] = nullptr;
+}
+
+bool BusCapture::begin(WebSocketLogger* logger) {
+    if (logger == nullptr || logger_ != nullptr) {
+        return false;
+    }
+    logger_ = logger;
+
+    // Both buffers in one block: PSRAM-sized when the board has it
+    uint32_t bytes = 0;
+    uint8_t* block = GetBufferPlacement().place<uint8_t>("bus_capture",
+        2 * BUS_CAPTURE_PSRAM_BUFFER_SIZE, 2 * BUS_CAPTURE_BUFFER_SIZE, bytes);
+    if (block == nullptr) {
+        logger_->broadcastLogf(LogLevel::ERROR, LogComponent::BUS_CAPTURE, LogEvent::CAPTURE_ALLOC_FAILED,
+            "{\"bytes\":%u}", (unsigned)(2 * BUS_CAPTURE_BUFFER_SIZE));
+        return false;
+    }
+    bufferSize_ = bytes / 2;
+    buffers_[0] = block;
+    buffers_[1] = block + bufferSize_;
+
+    BaseType_t created = xTaskCreatePinnedToCore(taskEntry, "capture", BUS_CAPTURE_TASK_STACK, this,
+                                                 BUS_CAPTURE_TASK_PRIORITY, &taskHandle_,
+                                                 BUS_CAPTURE_TASK_CORE);
+    if (created != pdPASS) {
+        taskHandle_ = nullptr;
+        logger_->broadcastLog(LogLevel::ERROR, LogComponent::BUS_CAPTURE, LogEvent::CAPTURE_TASK_FAILED,
+            "{\"reason\":\"xTaskCreatePinnedToCore failed\"}");
+        return false;
+    }
+    return true;
+}
+
+void BusCapture::observeFrame(void* context, unsigned long id, unsigned char len,
+                              const unsigned char* buf, uint32_t nowMs) {
+    BusCapture* self = static_cast<BusCapture*>(context);
+
+    if (self->state_.load(std::memory_order_acquire) == STATE_CAPTURING && len <= 8) {
+        CapturedFrame frame;
+        frame.id = static_cast<uint32_t>(id);
+        frame.nowMs = nowMs;
+        frame.len = len;
+        memcpy(frame.data, buf, len);
+        self->frameQueue_.push(frame);  // Full queue: counted as dropped
+    }
+
+    if (self->nextObserver_ != nullptr) {
+        self->nextObserver_(self->nextObserverContext_, id, len, buf, nowMs);
+    }
+}
+
+void BusCapture::observeLine(void* context, uint8_t port, const char* line, size_t length,
+                             uint32_t nowMs) {
+    static_cast<BusCapture*>(context)->recordLine(port, line, length, nowMs);
+}
+
+void BusCapture::service(uint32_t nowMs) {
+    if (logger_ == nullptr) {
+        return;
+    }
+
+    if (startRequested_.exchange(false)) {
+        if (state_.load() == STATE_IDLE) {
+            start(nowMs);
+        } else {
+            logger_->broadcastLog(LogLevel::WARN, LogComponent::BUS_CAPTURE, LogEvent::CAPTURE_START_IGNORED,
+                "{\"reason\":\"capture already active\"}");
+        }
+    }
+    if (stopRequested_.exchange(false) && state_.load() == STATE_CAPTURING) {
+        stop("request");
+    }
+
+    switch (state_.load()) {
+        case STATE_CAPTURING:
+            drainFrames();
+            recordUtcMark(nowMs);
+            if (state_.load() == STATE_CAPTURING && fillLength_ > 0 &&
+                static_cast<int32_t>(nowMs - fillStartMs_) >= BUS_CAPTURE_FLUSH_MS) {
+                handOff(false);  // Writer busy: retried on the next pass
+            }
+            break;
+
+        case STATE_STOPPING:
+            if (handOff(true)) {
+                state_.store(STATE_CLOSING);
+            }
+            break;
+
+        case STATE_CLOSING:
+            if (writeLength_.load(std::memory_order_acquire) == 0 && !closePending_.load()) {
+                state_.store(STATE_IDLE);
+                uint32_t dropped = getDroppedCount();
+                logger_->broadcastLogf(dropped > 0 || writeErrors_.load() > 0 ? LogLevel::WARN : LogLevel::INFO,
+                    LogComponent::BUS_CAPTURE, LogEvent::CAPTURE_STOPPED,
+                    "{\"reason\":\"%s\",\"records\":%lu,\"lines\":%lu,\"frames\":%lu,\"bytes\":%lu,"
+                    "\"dropped\":%lu,\"write_errors\":%lu,\"duration_ms\":%lu}",
+                    stopReason_, (unsigned long)records_, (unsigned long)lines_,
+                    (unsigned long)frames_, (unsigned long)bytesWritten_.load(),
+                    (unsigned long)dropped, (unsigned long)writeErrors_.load(),
+                    (unsigned long)getDurationMs());
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+void BusCapture::start(uint32_t nowMs) {
+    // Frames left over from the previous capture
+    CapturedFrame stale;
+    while (frameQueue_.pop(stale)) {
+    }
+
+    fillIndex_ = 0;
+    fillLength_ = BusCaptureWriteHeader(buffers_[0], bufferSize_);
+    fillStartMs_ = nowMs;
+    startMs_ = nowMs;
+    lastRecordMs_ = nowMs;
+    encodedBytes_ = fillLength_;
+    records_ = 0;
+    lines_ = 0;
+    frames_ = 0;
+    dropped_ = 0;
+    queueDroppedBase_ = frameQueue_.getDroppedCount();
+    utcSteps_ = 0;  // First service() pass marks the start if the clock is synced
+    bytesWritten_.store(0);
+    writeErrors_.store(0);
+    truncatePending_.store(true);
+    stopReason_ = "";
+    state_.store(STATE_CAPTURING, std::memory_order_release);
+
+    logger_->broadcastLogf(LogLevel::INFO, LogComponent::BUS_CAPTURE, LogEvent::CAPTURE_STARTED,
+        "{\"path\":\"%s\",\"buffer\":%u,\"max_bytes\":%lu}",
+        BUS_CAPTURE_PATH, (unsigned)bufferSize_, (unsigned long)BUS_CAPTURE_MAX_BYTES);
+}
+
+void BusCapture::stop(const char* reason) {
+    drainFrames();
+    stopReason_ = reason;
+    state_.store(STATE_STOPPING, std::memory_order_release);
+}
+
+void BusCapture::drainFrames() {
+    CapturedFrame frame;
+    while (state_.load() == STATE_CAPTURING && frameQueue_.pop(frame)) {
+        if (!reserve(BUS_CAPTURE_MAX_RECORD)) {
+            continue;
+        }
+        size_t n = BusCaptureEncodeFrame(buffers_[fillIndex_] + fillLength_,
+                                         bufferSize_ - fillLength_,
+                                         nextDelta(frame.nowMs), frame.id, frame.len, frame.data);
+        fillLength_ += n;
+        encodedBytes_ += n;
+        records_++;
+        frames_++;
+        if (encodedBytes_ >= BUS_CAPTURE_MAX_BYTES) {
+            stop("size_limit");
+        }
+    }
+}
+
+void BusCapture::recordLine(uint8_t port, const char* line, size_t length, uint32_t nowMs) {
+    if (state_.load() != STATE_CAPTURING) {
+        return;
+    }
+
+    // Queued frames arrived before this line; keep the file in arrival order
+    drainFrames();
+    if (state_.load() != STATE_CAPTURING || !reserve(BUS_CAPTURE_MAX_RECORD)) {
+        return;
+    }
+
+    size_t n = BusCaptureEncodeLine(buffers_[fillIndex_] + fillLength_,
+                                    bufferSize_ - fillLength_,
+                                    nextDelta(nowMs), port, line, length);
+    if (n == 0) {
+        dropped_++;  // Longer than BUS_CAPTURE_MAX_LINE
+        return;
+    }
+    fillLength_ += n;
+    encodedBytes_ += n;
+    records_++;
+    lines_++;
+    if (encodedBytes_ >= BUS_CAPTURE_MAX_BYTES) {
+        stop("size_limit");
+    }
+}
+
+void BusCapture::recordUtcMark(uint32_t nowMs) {
+    const UtcClock& clock = GetUtcClock();
+    uint32_t steps = clock.getSteps();
+    if (state_.load() != STATE_CAPTURING || !clock.synced() || steps == utcSteps_ ||
+        !reserve(BUS_CAPTURE_MAX_RECORD)) {
+        return;
+    }
+
+    uint32_t delta = nextDelta(nowMs);
+    size_t n = BusCaptureEncodeUtc(buffers_[fillIndex_] + fillLength_, bufferSize_ - fillLength_,
+                                   delta, clock.toUtc(lastRecordMs_));
+    fillLength_ += n;
+    encodedBytes_ += n;
+    records_++;
+    utcSteps_ = steps;
+}
+
+uint32_t BusCapture::nextDelta(uint32_t nowMs) {
+    int32_t delta = static_cast<int32_t>(nowMs - lastRecordMs_);
+    if (delta <= 0) {
+        return 0;
+    }
+    lastRecordMs_ = nowMs;
+    return static_cast<uint32_t>(delta);
+}
+
+bool BusCapture::reserve(size_t bytes) {
+    if (fillLength_ + bytes <= bufferSize_) {
+        return true;
+    }
+    if (handOff(false)) {
+        return true;
+    }
+    dropped_++;
+    return false;
+}
+
+bool BusCapture::handOff(bool close) {
+    if (writeLength_.load(std::memory_order_acquire) != 0 || closePending_.load()) {
+        return false;
+    }
+    if (fillLength_ == 0 && !close) {
+        return true;
+    }
+
+    // Swap first: the writer takes the buffer the main loop no longer fills
+    uint32_t length = fillLength_;
+    fillIndex_ ^= 1;
+    fillLength_ = 0;
+    closePending_.store(close);
+    writeLength_.store(length, std::memory_order_release);
+    fillStartMs_ = lastRecordMs_;
+    xTaskNotifyGive(taskHandle_);
+    return true;
+}
+
+void BusCapture::taskEntry(void* param) {
+    BusCapture* self = static_cast<BusCapture*>(param);
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Filesystem image being installed (POST /update): hand-offs are dropped
+        if (OtaFilesystemLocked()) {
+            if (self->writeLength_.load(std::memory_order_acquire) > 0) {
+                self->writeErrors_.fetch_add(1);
+            }
+            self->writeLength_.store(0, std::memory_order_release);
+            continue;
+        }
+
+        if (self->truncatePending_.load()) {
+            if (self->file_) {
+                self->file_.close();
+            }
+            self->file_ = LittleFS.open(BUS_CAPTURE_PATH, "w");
+            self->truncatePending_.store(false);
+        }
+
+        // Handed off buffer is the one the main loop is not filling
+        uint32_t length = self->writeLength_.load(std::memory_order_acquire);
+        if (length > 0) {
+            const uint8_t* data = self->buffers_[self->fillIndex_ ^ 1];
+            size_t written = self->file_ ? self->file_.write(data, length) : 0;
+            self->bytesWritten_.fetch_add(written);
+            if (written != length) {
+                self->writeErrors_.fetch_add(1);
+            }
+        }
+
+        if (self->closePending_.load()) {
+            if (self->file_) {
+                self->file_.close();
+            }
+            self->closePending_.store(false);
+        }
+        self->writeLength_.store(0, std::memory_order_release);
+    }
+}
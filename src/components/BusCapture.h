@@ -0,0 +1,204 @@
+/**
+ * @file BusCapture.h
+ * @brief Records raw NMEA 0183 lines and NMEA 2000 frames to LittleFS
+ *
+ * Capture mode writes every line the NMEA0183Handler reads and every CAN
+ * frame the driver receives, with its arrival time, to BUS_CAPTURE_PATH in
+ * the BusCaptureFormat record format. BusReplay feeds such a file back into
+ * the handlers, so a field problem or an on-device throughput benchmark can
+ * be reproduced with the exact same input.
+ *
+ * Write path (the main loop never waits on flash):
+ * - Lines are encoded on the main loop (NMEA0183Handler line observer)
+ * - Frames are copied by the receive context into an SPSC queue and encoded
+ *   by the main loop, so the capture buffer has a single writer
+ * - Records fill one of two buffers (BUS_CAPTURE_PSRAM_BUFFER_SIZE each in
+ *   PSRAM, BUS_CAPTURE_BUFFER_SIZE without it, placed by begin()); a full buffer
+ *   (or one older than BUS_CAPTURE_FLUSH_MS) is handed to a writer task and
+ *   the other buffer takes over
+ * - If the writer still holds the other buffer, records are dropped and
+ *   counted instead of blocking (flash slower than the bus)
+ *
+ * Start/stop requests are flags (safe from the web server task) applied by
+ * service(). Capture stops by itself at BUS_CAPTURE_MAX_BYTES.
+ *
+ * service() writes a UTC mark (BusCaptureType::UTC_MARK) once GetUtcClock()
+ * is synced and again after each of its steps, so the records of a capture
+ * map to UTC without a mark per record.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): double buffer placed once at boot, static frame queue
+ * - Principle VII (Fail-Safe): overload drops records and counts them, never stalls
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BUS_CAPTURE_H
+#define BUS_CAPTURE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config.h"
+#include "../hal/implementations/ESP32N2kCanDriver.h"
+#include "../utils/BusCaptureFormat.h"
+#include "../utils/SPSCQueue.h"
+#include "../utils/WebSocketLogger.h"
+
+/**
+ * @class BusCapture
+ * @brief Double-buffered raw bus recorder
+ *
+ * Usage pattern:
+ * @code
+ * busCapture.begin(&logger);
+ * busCapture.chainFrameObserver(N2kFastPacketMonitor::observe, &GetN2kFastPacketMonitor());
+ * nmea2000->setFrameObserver(BusCapture::observeFrame, &busCapture);
+ * nmea0183Handler->setLineObserver(BusCapture::observeLine, &busCapture);
+ * app.onRepeat(BUS_CAPTURE_SERVICE_INTERVAL_MS, []() { busCapture.service(millis()); });
+ * @endcode
+ */
+class BusCapture {
+public:
+    BusCapture();
+
+    /**
+     * @brief Place the double buffer and start the writer task
+     * @return false on null logger, if already started, or if the buffers or the task cannot be created
+     */
+    bool begin(WebSocketLogger* logger);
+
+    /**
+     * @brief Frame observer called after capturing (e.g. N2kFastPacketMonitor)
+     *
+     * The driver has a single observer slot; set before the receive context starts.
+     */
+    void chainFrameObserver(N2kFrameObserver observer, void* context) {
+        nextObserver_ = observer;
+        nextObserverContext_ = context;
+    }
+
+    /**
+     * @brief ESP32N2kCanDriver frame observer (receive context)
+     */
+    static void observeFrame(void* context, unsigned long id, unsigned char len,
+                             const unsigned char* buf, uint32_t nowMs);
+
+    /**
+     * @brief NMEA0183Handler line observer (main loop)
+     */
+    static void observeLine(void* context, uint8_t port, const char* line, size_t length,
+                            uint32_t nowMs);
+
+    /**
+     * @brief Ask for a new capture (truncates BUS_CAPTURE_PATH); any context
+     */
+    void requestStart() { startRequested_.store(true); }
+
+    /**
+     * @brief Ask the running capture to stop; any context
+     */
+    void requestStop() { stopRequested_.store(true); }
+
+    /**
+     * @brief Main-loop hook: applies requests, encodes frames, hands off buffers
+     */
+    void service(uint32_t nowMs);
+
+    /// Capturing, or the last buffer is still being written
+    bool isActive() const { return state_.load() != STATE_IDLE; }
+
+    uint32_t getRecordCount() const { return records_; }
+    uint32_t getLineCount() const { return lines_; }
+    uint32_t getFrameCount() const { return frames_; }
+    uint32_t getDroppedCount() const {
+        return dropped_ + (frameQueue_.getDroppedCount() - queueDroppedBase_);
+    }
+    uint32_t getBytesWritten() const { return bytesWritten_.load(); }
+    uint32_t getWriteErrors() const { return writeErrors_.load(); }
+    TaskHandle_t getTaskHandle() const { return taskHandle_; }
+    uint32_t getDurationMs() const { return lastRecordMs_ - startMs_; }
+
+private:
+    /// Frame copied by the receive context
+    struct CapturedFrame {
+        uint32_t id;
+        uint32_t nowMs;
+        uint8_t len;
+        uint8_t data[8];
+    };
+
+    enum : uint8_t {
+        STATE_IDLE = 0,
+        STATE_CAPTURING = 1,
+        STATE_STOPPING = 2,    ///< Final buffer not handed off yet (writer busy)
+        STATE_CLOSING = 3      ///< Final buffer handed off, waiting for the file to close
+    };
+
+    SPSCQueue<CapturedFrame, BUS_CAPTURE_FRAME_QUEUE> frameQueue_;
+    uint8_t* buffers_[2];           ///< Halves of one BufferPlacement block
+    uint32_t bufferSize_;           ///< Bytes per buffer
+    uint8_t fillIndex_;             ///< Buffer the main loop appends to
+    uint32_t fillLength_;
+    uint32_t fillStartMs_;          ///< First record of the fill buffer (flush age)
+
+    // Writer task handoff: writeLength_ != 0 means buffers_[1 - fillIndex_] is owned by the task
+    std::atomic<uint32_t> writeLength_;
+    std::atomic<bool> truncatePending_;   ///< Open BUS_CAPTURE_PATH "w" before the next write
+    std::atomic<bool> closePending_;      ///< Close the file after the next write
+    std::atomic<uint32_t> bytesWritten_;
+    std::atomic<uint32_t> writeErrors_;
+    File file_;                     ///< Writer task only
+
+    std::atomic<uint8_t> state_;
+    std::atomic<bool> startRequested_;
+    std::atomic<bool> stopRequested_;
+    const char* stopReason_;
+
+    uint32_t startMs_;
+    uint32_t lastRecordMs_;
+    uint32_t encodedBytes_;
+    uint32_t records_;
+    uint32_t lines_;
+    uint32_t frames_;
+    uint32_t dropped_;
+    uint32_t queueDroppedBase_;     ///< Frame queue drop count when the capture started
+    uint32_t utcSteps_;             ///< UtcClock::getSteps() of the last UTC mark (0 = none yet)
+
+    N2kFrameObserver nextObserver_;
+    void* nextObserverContext_;
+    WebSocketLogger* logger_;
+    TaskHandle_t taskHandle_;
+
+    void start(uint32_t nowMs);
+    void stop(const char* reason);
+    void drainFrames();
+    void recordLine(uint8_t port, const char* line, size_t length, uint32_t nowMs);
+
+    /// UTC mark if the clock synced or stepped since the last one
+    void recordUtcMark(uint32_t nowMs);
+
+    /**
+     * @brief Delta to the previous record (clamped: frames are queued, lines are not)
+     */
+    uint32_t nextDelta(uint32_t nowMs);
+
+    /**
+     * @brief Space for @p bytes in the fill buffer, swapping buffers if needed
+     * @return false if the writer still holds the other buffer (record dropped)
+     */
+    bool reserve(size_t bytes);
+
+    /**
+     * @brief Hand the fill buffer to the writer task
+     * @return false if the writer is busy
+     */
+    bool handOff(bool close);
+
+    static void taskEntry(void* param);
+};
+
+#endif // BUS_CAPTURE_H
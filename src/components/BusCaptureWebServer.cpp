@@ -0,0 +1,175 @@
+/**
+ * @file BusCaptureWebServer.cpp
+ * @brief Implementation of the bus capture and replay endpoints
+ *
+ * @see BusCaptureWebServer.h
+ */
+
+#include "BusCaptureWebServer.h"
+#include "../utils/JsonWriter.h"
+#include "../utils/OtaUpdate.h"
+
+BusCaptureWebServer::BusCaptureWebServer(BusCapture* busCapture, BusReplay* busReplay)
+    : capture(busCapture), replay(busReplay), latency(nullptr), uploadFailed(false) {
+}
+
+void BusCaptureWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || capture == nullptr || replay == nullptr) {
+        return;
+    }
+
+    // POST /capture/start - Record raw lines and frames
+    server->on("/capture/start", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        if (busy()) {
+            sendResult(request, 409, "busy");
+            return;
+        }
+        capture->requestStart();
+        sendResult(request, 202, "starting");
+    });
+
+    // POST /capture/stop
+    server->on("/capture/stop", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        capture->requestStop();
+        sendResult(request, 202, "stopping");
+    });
+
+    // GET /capture/status
+    server->on("/capture/status", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetStatus(request);
+    });
+
+    // GET /capture/file - Download the capture
+    server->on("/capture/file", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        if (busy()) {
+            sendResult(request, 409, "busy");
+            return;
+        }
+        if (!LittleFS.exists(BUS_CAPTURE_PATH)) {
+            sendResult(request, 404, "no capture");
+            return;
+        }
+        request->send(LittleFS, BUS_CAPTURE_PATH, "application/octet-stream", true);
+    });
+
+    // POST /capture/file - Replace the capture with an uploaded one
+    server->on("/capture/file", HTTP_POST,
+        [this](AsyncWebServerRequest* request) {
+            if (uploadFailed) {
+                sendResult(request, 409, "busy or write failed");
+            } else {
+                sendResult(request, 200, "uploaded");
+            }
+        },
+        [this](AsyncWebServerRequest* request, const String& filename, size_t index, uint8_t* data,
+               size_t len, bool final) {
+            handleUpload(request, filename, index, data, len, final);
+        }
+    );
+
+    // POST /replay/start?speed=1..20|max
+    server->on("/replay/start", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        this->handleReplayStart(request);
+    });
+
+    // POST /replay/stop
+    server->on("/replay/stop", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        replay->requestStop();
+        sendResult(request, 202, "stopping");
+    });
+
+    // GET /replay/latency - latency percentiles of the last (or running) replay
+    server->on("/replay/latency", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        if (latency == nullptr) {
+            sendResult(request, 404, "latency probe disabled");
+            return;
+        }
+        StaticJsonWriter<1536> json;  // ~110 bytes per output, ~80 per group
+        latency->writeJson(json, micros());
+        request->send(200, "application/json", json.c_str());
+    });
+}
+
+void BusCaptureWebServer::handleGetStatus(AsyncWebServerRequest* request) {
+    StaticJsonWriter<512> json;
+    json.beginObject()
+        .beginObject("capture")
+            .add("active", capture->isActive())
+            .add("records", (unsigned long)capture->getRecordCount())
+            .add("lines", (unsigned long)capture->getLineCount())
+            .add("frames", (unsigned long)capture->getFrameCount())
+            .add("dropped", (unsigned long)capture->getDroppedCount())
+            .add("bytes", (unsigned long)capture->getBytesWritten())
+            .add("write_errors", (unsigned long)capture->getWriteErrors())
+            .add("duration_ms", (unsigned long)capture->getDurationMs())
+        .endObject()
+        .beginObject("replay")
+            .add("active", replay->isActive())
+            .add("speed", (unsigned)replay->getSpeed())
+            .add("records", (unsigned long)replay->getRecordCount())
+            .add("lines", (unsigned long)replay->getLineCount())
+            .add("frames", (unsigned long)replay->getFrameCount())
+            .add("skipped", (unsigned long)replay->getSkippedCount())
+            .add("capture_ms", (unsigned long)replay->getCaptureMs())
+        .endObject();
+
+    // Size of an open capture lags until its file is closed
+    unsigned long fileBytes = 0;
+    if (!capture->isActive() && LittleFS.exists(BUS_CAPTURE_PATH)) {
+        File file = LittleFS.open(BUS_CAPTURE_PATH, "r");
+        fileBytes = file ? (unsigned long)file.size() : 0;
+        file.close();
+    }
+    json.add("file_bytes", fileBytes).endObject();
+
+    request->send(200, "application/json", json.c_str());
+}
+
+void BusCaptureWebServer::handleReplayStart(AsyncWebServerRequest* request) {
+    uint8_t speed = 1;
+    if (request->hasParam("speed")) {
+        const String& value = request->getParam("speed")->value();  // No copy
+        long multiplier = value.toInt();
+        if (value == "max") {
+            speed = 0;
+        } else if (multiplier >= 1 && multiplier <= BUS_REPLAY_MAX_SPEED) {
+            speed = static_cast<uint8_t>(multiplier);
+        } else {
+            sendResult(request, 400, "speed must be 1-20 or max");
+            return;
+        }
+    }
+
+    if (capture->isActive()) {
+        sendResult(request, 409, "capture active");
+        return;
+    }
+    replay->requestStart(speed);
+    sendResult(request, 202, "starting");
+}
+
+void BusCaptureWebServer::handleUpload(AsyncWebServerRequest* request, const String& filename,
+                                       size_t index, uint8_t* data, size_t len, bool final) {
+    (void)request;
+    (void)filename;
+
+    if (index == 0) {
+        uploadFailed = busy() || OtaFilesystemLocked();
+        if (!uploadFailed) {
+            uploadFile = LittleFS.open(BUS_CAPTURE_PATH, "w");
+            uploadFailed = !uploadFile;
+        }
+    }
+    if (!uploadFailed && uploadFile.write(data, len) != len) {
+        uploadFailed = true;
+    }
+    if (final && uploadFile) {
+        uploadFile.close();
+    }
+}
+
+void BusCaptureWebServer::sendResult(AsyncWebServerRequest* request, int code, const char* status) {
+    StaticJsonWriter<96> json;
+    json.beginObject().add("status", status).endObject();
+    request->send(code, "application/json", json.c_str());
+}
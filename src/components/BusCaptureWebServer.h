@@ -0,0 +1,103 @@
+/**
+ * @file BusCaptureWebServer.h
+ * @brief HTTP endpoints controlling raw bus capture and replay
+ *
+ * Provides:
+ * - POST /capture/start: Start recording to BUS_CAPTURE_PATH (truncates it)
+ * - POST /capture/stop: Stop recording
+ * - GET /capture/status: Capture and replay state and counters
+ * - GET /capture/file: Download the capture file
+ * - POST /capture/file: Upload a capture file (multipart, e.g. from the field)
+ * - POST /replay/start?speed=1..20|max: Replay the capture file
+ * - POST /replay/stop: Stop the replay
+ * - GET /replay/latency: Write-to-WebSocket latency of the last replay (PipelineLatency)
+ *
+ * Capture and replay exclude each other, and the file is not served or
+ * replaced while either is active (409). Start/stop only set request flags;
+ * the main loop applies them (see BusCapture, BusReplay).
+ *
+ * @version 1.0.0
+ */
+
+#ifndef BUS_CAPTURE_WEB_SERVER_H
+#define BUS_CAPTURE_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
+#include "BusCapture.h"
+#include "BusReplay.h"
+#include "../utils/PipelineLatency.h"
+
+/**
+ * @brief Web server routes for bus capture and replay
+ */
+class BusCaptureWebServer {
+private:
+    BusCapture* capture;
+    BusReplay* replay;
+    const PipelineLatency* latency;   ///< nullptr = no /replay/latency data
+    File uploadFile;          ///< Open during POST /capture/file (async_tcp task only)
+    bool uploadFailed;
+
+    /**
+     * @brief Handle GET /capture/status
+     *
+     * Returns:
+     * {
+     *   "capture": {"active": false, "records": 5120, "lines": 1800, "frames": 3320,
+     *               "dropped": 0, "bytes": 48213, "write_errors": 0, "duration_ms": 60000},
+     *   "replay": {"active": true, "speed": 10, "records": 812, "lines": 290,
+     *              "frames": 522, "skipped": 0, "capture_ms": 9500},
+     *   "file_bytes": 48213
+     * }
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetStatus(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle POST /replay/start
+     *
+     * Query parameter speed: 1 (default) to BUS_REPLAY_MAX_SPEED, or "max". 400 on other values.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleReplayStart(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Upload chunk handler of POST /capture/file
+     */
+    void handleUpload(AsyncWebServerRequest* request, const String& filename, size_t index,
+                      uint8_t* data, size_t len, bool final);
+
+    /// Capture or replay running (file in use)
+    bool busy() const { return capture->isActive() || replay->isActive(); }
+
+    static void sendResult(AsyncWebServerRequest* request, int code, const char* status);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param busCapture Recorder controlled by the /capture routes
+     * @param busReplay Replay source controlled by the /replay routes
+     */
+    BusCaptureWebServer(BusCapture* busCapture, BusReplay* busReplay);
+
+    /**
+     * @brief Serve @p pipelineLatency on GET /replay/latency (call before registerRoutes())
+     */
+    void setPipelineLatency(const PipelineLatency* pipelineLatency) { latency = pipelineLatency; }
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // BUS_CAPTURE_WEB_SERVER_H
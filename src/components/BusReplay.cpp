@@ -0,0 +1,171 @@
+/**
+ * @file BusReplay.cpp
+ * @brief Implementation of the BusCapture replay source
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BusReplay.h"
+
+static_assert(BUS_REPLAY_CHUNK_SIZE >= BUS_CAPTURE_MAX_RECORD,
+              "BUS_REPLAY_CHUNK_SIZE must hold the largest record");
+
+BusReplay::BusReplay()
+    : chunkLength_(0), chunkPos_(0), endOfFile_(false), hasPending_(false),
+      active_(false), startRequested_(false), stopRequested_(false), requestedSpeed_(1),
+      speed_(1), startMs_(0), captureMs_(0),
+      records_(0), lines_(0), frames_(0), skipped_(0), frameRetries_(0),
+      handler_(nullptr), driver_(nullptr), logger_(nullptr) {
+}
+
+bool BusReplay::begin(NMEA0183Handler* handler, ESP32N2kCanDriver* driver, WebSocketLogger* logger) {
+    if (logger == nullptr || logger_ != nullptr) {
+        return false;
+    }
+    handler_ = handler;
+    driver_ = driver;
+    logger_ = logger;
+    return true;
+}
+
+void BusReplay::service(uint32_t nowMs) {
+    if (logger_ == nullptr) {
+        return;
+    }
+
+    if (startRequested_.exchange(false)) {
+        if (active_.load()) {
+            finish(nowMs, "restarted");
+        }
+        start(nowMs);
+    }
+    if (stopRequested_.exchange(false) && active_.load()) {
+        finish(nowMs, "request");
+    }
+    if (!active_.load()) {
+        return;
+    }
+
+    uint64_t elapsed = static_cast<uint64_t>(nowMs - startMs_) * speed_;
+    for (uint16_t n = 0; n < BUS_REPLAY_MAX_RECORDS_PER_PASS; n++) {
+        bool corrupt = false;
+        if (!hasPending_ && !next(corrupt)) {
+            finish(nowMs, corrupt ? "corrupt" : "done");
+            return;
+        }
+
+        uint32_t due = captureMs_ + pending_.deltaMs;
+        if (speed_ != 0 && elapsed < due) {
+            return;  // Not due yet
+        }
+        if (!release()) {
+            frameRetries_++;
+            return;  // CAN RX queue full: let the receive context catch up
+        }
+        captureMs_ = due;
+        hasPending_ = false;
+    }
+}
+
+void BusReplay::start(uint32_t nowMs) {
+    file_ = LittleFS.open(BUS_CAPTURE_PATH, "r");
+    uint8_t header[BUS_CAPTURE_HEADER_SIZE];
+    if (!file_ || file_.read(header, sizeof(header)) != sizeof(header) ||
+        !BusCaptureCheckHeader(header, sizeof(header))) {
+        if (file_) {
+            file_.close();
+        }
+        logger_->broadcastLogf(LogLevel::ERROR, LogComponent::BUS_REPLAY, LogEvent::REPLAY_FAILED,
+            "{\"path\":\"%s\",\"reason\":\"missing file or unsupported header\"}", BUS_CAPTURE_PATH);
+        return;
+    }
+
+    chunkLength_ = 0;
+    chunkPos_ = 0;
+    endOfFile_ = false;
+    hasPending_ = false;
+    speed_ = requestedSpeed_.load();
+    startMs_ = nowMs;
+    captureMs_ = 0;
+    records_ = 0;
+    lines_ = 0;
+    frames_ = 0;
+    skipped_ = 0;
+    frameRetries_ = 0;
+    active_.store(true);
+
+    logger_->broadcastLogf(LogLevel::INFO, LogComponent::BUS_REPLAY, LogEvent::REPLAY_STARTED,
+        "{\"path\":\"%s\",\"bytes\":%lu,\"speed\":%u}",
+        BUS_CAPTURE_PATH, (unsigned long)file_.size(), (unsigned)speed_);
+}
+
+void BusReplay::finish(uint32_t nowMs, const char* reason) {
+    file_.close();
+    active_.store(false);
+
+    uint32_t elapsed = nowMs - startMs_;
+    logger_->broadcastLogf(strcmp(reason, "corrupt") == 0 ? LogLevel::ERROR : LogLevel::INFO,
+        LogComponent::BUS_REPLAY, LogEvent::REPLAY_DONE,
+        "{\"reason\":\"%s\",\"speed\":%u,\"records\":%lu,\"lines\":%lu,\"frames\":%lu,"
+        "\"skipped\":%lu,\"frame_retries\":%lu,\"capture_ms\":%lu,\"elapsed_ms\":%lu,"
+        "\"records_per_s\":%lu}",
+        reason, (unsigned)speed_, (unsigned long)records_, (unsigned long)lines_,
+        (unsigned long)frames_, (unsigned long)skipped_, (unsigned long)frameRetries_,
+        (unsigned long)captureMs_, (unsigned long)elapsed,
+        (unsigned long)(elapsed > 0 ? (uint64_t)records_ * 1000 / elapsed : 0));
+}
+
+bool BusReplay::next(bool& corrupt) {
+    for (;;) {
+        int32_t used = BusCaptureDecode(chunk_ + chunkPos_, chunkLength_ - chunkPos_, pending_);
+        if (used > 0) {
+            chunkPos_ += static_cast<size_t>(used);
+            hasPending_ = true;
+            return true;
+        }
+        if (used < 0) {
+            corrupt = true;
+            return false;
+        }
+
+        // Incomplete: move the tail to the front and read more
+        if (endOfFile_) {
+            corrupt = chunkPos_ != chunkLength_;  // Truncated last record
+            return false;
+        }
+        size_t remaining = chunkLength_ - chunkPos_;
+        memmove(chunk_, chunk_ + chunkPos_, remaining);
+        chunkLength_ = remaining;
+        chunkPos_ = 0;
+        size_t got = file_.read(chunk_ + chunkLength_, sizeof(chunk_) - chunkLength_);
+        if (got == 0) {
+            endOfFile_ = true;
+        }
+        chunkLength_ += got;
+    }
+}
+
+bool BusReplay::release() {
+    if (pending_.type == BusCaptureType::UTC_MARK) {
+        // Capture-time UTC: timing only, the live UtcClock is held during replay
+    } else if (pending_.type == BusCaptureType::CAN_FRAME) {
+        if (driver_ == nullptr) {
+            skipped_++;
+        } else if (driver_->injectFrame(pending_.canId, pending_.length, pending_.data)) {
+            frames_++;
+        } else {
+            return false;
+        }
+#if POSEIDON_FEATURE_NMEA0183
+    } else if (handler_ != nullptr &&
+               handler_->injectLine(pending_.port, reinterpret_cast<const char*>(pending_.data),
+                                    pending_.length)) {
+        lines_++;
+#endif
+    } else {
+        skipped_++;  // Port not configured on this unit (or no NMEA 0183 in this build)
+    }
+    records_++;
+    return true;
+}
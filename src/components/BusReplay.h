@@ -0,0 +1,135 @@
+/**
+ * @file BusReplay.h
+ * @brief Feeds a BusCapture file back into the NMEA 0183 and NMEA 2000 input paths
+ *
+ * Lines go through NMEA0183Handler::injectLine() (same parse, stats and
+ * fix-fusion path as live input, on the recorded port) and frames through
+ * ESP32N2kCanDriver::injectFrame() (the CAN RX queue, so handlers run in
+ * the configured N2K_RX_MODE). Live input keeps running alongside; unplug
+ * the buses for a clean reproduction. Built without POSEIDON_FEATURE_NMEA0183,
+ * lines are counted as skipped.
+ *
+ * Speed (requestStart()):
+ * - 1 .. BUS_REPLAY_MAX_SPEED (20): records are released when (elapsed × speed)
+ *   reaches their capture time, so rates and inter-arrival timing match the recording
+ * - 0 (max): records are released as fast as the handlers take them, bounded
+ *   by BUS_REPLAY_MAX_RECORDS_PER_PASS and a full CAN RX queue; REPLAY_DONE
+ *   reports records_per_s as a throughput benchmark
+ *
+ * The file is read in BUS_REPLAY_CHUNK_SIZE pieces on the main loop; replay
+ * is a bench tool, so the short flash reads are accepted there.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): one static read chunk, no heap
+ * - Principle VII (Fail-Safe): corrupt records end the replay with an error event
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BUS_REPLAY_H
+#define BUS_REPLAY_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <atomic>
+#include "../config.h"
+#include "NMEA0183Handler.h"
+#include "../hal/implementations/ESP32N2kCanDriver.h"
+#include "../utils/BusCaptureFormat.h"
+#include "../utils/WebSocketLogger.h"
+
+/**
+ * @class BusReplay
+ * @brief Timed replay source for BusCapture files
+ *
+ * Usage pattern:
+ * @code
+ * busReplay.begin(nmea0183Handler, nmea2000, &logger);
+ * busReplay.requestStart(10);   // 10x real time
+ * app.onRepeat(BUS_CAPTURE_SERVICE_INTERVAL_MS, []() { busReplay.service(millis()); });
+ * @endcode
+ */
+class BusReplay {
+public:
+    BusReplay();
+
+    /**
+     * @param handler Receives replayed lines (nullptr = lines skipped)
+     * @param driver Receives replayed frames (nullptr = frames skipped)
+     * @return false on null logger or if already started
+     */
+    bool begin(NMEA0183Handler* handler, ESP32N2kCanDriver* driver, WebSocketLogger* logger);
+
+    /**
+     * @brief Ask for a replay of BUS_CAPTURE_PATH; any context
+     * @param speed Time multiplier (1, 10, ...), 0 = as fast as possible
+     */
+    void requestStart(uint8_t speed) {
+        requestedSpeed_.store(speed);
+        startRequested_.store(true);
+    }
+
+    /**
+     * @brief Ask the running replay to stop; any context
+     */
+    void requestStop() { stopRequested_.store(true); }
+
+    /**
+     * @brief Main-loop hook: releases the records that are due
+     */
+    void service(uint32_t nowMs);
+
+    bool isActive() const { return active_.load(); }
+    uint8_t getSpeed() const { return speed_; }
+    uint32_t getRecordCount() const { return records_; }
+    uint32_t getLineCount() const { return lines_; }
+    uint32_t getFrameCount() const { return frames_; }
+    uint32_t getSkippedCount() const { return skipped_; }
+    uint32_t getCaptureMs() const { return captureMs_; }
+
+private:
+    uint8_t chunk_[BUS_REPLAY_CHUNK_SIZE];
+    size_t chunkLength_;
+    size_t chunkPos_;
+    File file_;
+    bool endOfFile_;
+
+    BusCaptureRecord pending_;   ///< Decoded, not yet due (data points into chunk_)
+    bool hasPending_;
+
+    std::atomic<bool> active_;
+    std::atomic<bool> startRequested_;
+    std::atomic<bool> stopRequested_;
+    std::atomic<uint8_t> requestedSpeed_;
+    uint8_t speed_;
+
+    uint32_t startMs_;
+    uint32_t captureMs_;         ///< Capture time of the last released record
+    uint32_t records_;
+    uint32_t lines_;
+    uint32_t frames_;
+    uint32_t skipped_;           ///< Records without a target (unknown port, no driver)
+    uint32_t frameRetries_;      ///< Passes that found the CAN RX queue full
+
+    NMEA0183Handler* handler_;
+    ESP32N2kCanDriver* driver_;
+    WebSocketLogger* logger_;
+
+    void start(uint32_t nowMs);
+    void finish(uint32_t nowMs, const char* reason);
+
+    /**
+     * @brief Decode the next record into pending_, reading more of the file if needed
+     * @return false at the end of the file or on corrupt data (sets @p corrupt)
+     */
+    bool next(bool& corrupt);
+
+    /**
+     * @brief Hand pending_ to its input path
+     * @return false if the target cannot take it now (retry on the next pass)
+     */
+    bool release();
+};
+
+#endif // BUS_REPLAY_H
@@ -0,0 +1,244 @@
+/**
+ * @file CalculationBenchmark.cpp
+ * @brief Implementation of the calculation cycle micro-benchmark
+ *
+ * @see CalculationBenchmark.h
+ */
+
+#include "CalculationBenchmark.h"
+#include <algorithm>
+#include <string.h>
+
+namespace {
+
+/**
+ * @brief One sailing situation of the corpus (degrees, knots)
+ */
+struct CorpusCase {
+    float awaDeg;
+    float aws;
+    float heelDeg;
+    float boatSpeed;
+    float headingDeg;
+    float sog;
+    float cogDeg;
+};
+
+const CorpusCase CORPUS[CALC_BENCH_CORPUS] = {
+    {  32.0f, 16.0f,  18.0f, 6.2f,  10.0f, 6.0f,  14.0f},  // Close-hauled, starboard
+    { -33.0f, 15.5f, -17.0f, 6.1f, 280.0f, 6.3f, 276.0f},  // Close-hauled, port
+    {  45.0f, 14.0f,  14.0f, 6.8f,  25.0f, 7.1f,  22.0f},  // Footing
+    {  70.0f, 12.0f,  10.0f, 7.3f,  95.0f, 7.0f,  99.0f},  // Close reach
+    { -95.0f, 11.0f,  -6.0f, 7.6f, 200.0f, 8.2f, 203.0f},  // Beam reach, port
+    { 120.0f,  9.5f,   4.0f, 7.1f, 140.0f, 6.6f, 137.0f},  // Broad reach
+    {-150.0f,  8.0f,  -2.0f, 6.4f, 330.0f, 6.9f, 333.0f},  // Running, port
+    { 175.0f,  6.5f,   1.0f, 5.9f,  60.0f, 5.5f,  58.0f},  // Dead run
+    {  25.0f,  4.0f,   3.0f, 0.0f,   0.0f, 0.2f,  90.0f},  // Stopped (leeway singularity)
+    {  -5.0f, 22.0f,   0.0f, 0.0f, 180.0f, 0.0f, 180.0f},  // Head to wind, at the dock
+    {  38.0f, 24.0f,  28.0f, 6.9f, 350.0f, 7.4f, 345.0f},  // Overpowered upwind
+    { -60.0f, 18.0f, -20.0f, 8.1f, 120.0f, 9.0f, 118.0f},  // Fast reach, port, current
+};
+
+const BoatScalar DEG = static_cast<BoatScalar>(0.017453292519943295);
+
+volatile BoatScalar sink;  // Keeps timed results from being optimized away
+
+}  // namespace
+
+/// Time the statement once per iteration, corpus case p in turn
+#define CALC_BENCH_LOOP(...)                                                \
+    for (uint16_t n = 0; n < iterations; n++) {                             \
+        const Prepared& p = prepared_[n % CALC_BENCH_CORPUS];               \
+        uint32_t start = counter_();                                        \
+        __VA_ARGS__;                                                        \
+        samples_[n] = counter_() - start;                                   \
+    }
+
+CalculationBenchmark::CalculationBenchmark(CycleCounter counter)
+    : counter_(counter), overhead_(0), polar_(nullptr) {
+    memset(&data_, 0, sizeof(data_));
+    data_.gps.available = data_.compass.available = data_.wind.available = data_.dst.available = true;
+    data_.calibration.leewayCalibrationFactor = DEFAULT_LEEWAY_K_FACTOR;
+    data_.calibration.windAngleOffset = DEFAULT_WIND_ANGLE_OFFSET;
+    data_.calibration.loaded = true;
+
+    // Formula inputs of every case, from the reference functions
+    for (uint8_t i = 0; i < CALC_BENCH_CORPUS; i++) {
+        loadCase(i);
+        Prepared& p = prepared_[i];
+        p.awa = data_.wind.apparentWindAngle;
+        p.aws = data_.wind.apparentWindSpeed;
+        p.heel = data_.compass.heelAngle;
+        p.boatSpeed = data_.dst.measuredBoatSpeed;
+        p.heading = data_.compass.magneticHeading;
+        p.sog = data_.gps.sog;
+        p.cog = data_.gps.cog;
+
+        p.awaOffset = engine_.calculateAWAOffset(p.awa, data_.calibration.windAngleOffset);
+        p.awaHeel = engine_.calculateAWAHeel(p.awaOffset, p.heel);
+        p.leeway = engine_.calculateLeeway(p.awaHeel, p.heel, p.boatSpeed,
+                                           data_.calibration.leewayCalibrationFactor);
+        p.stw = engine_.calculateSTW(p.boatSpeed, p.leeway);
+        BoatScalar cartesianAWA = AngleUtils::normalizeToZeroTwoPi(BoatScalar(3) * BoatMath::HALF_PI_RAD - p.awaHeel);
+        p.twsX = p.aws * std::cos(cartesianAWA) + p.stw * std::sin(p.leeway);
+        p.twsY = p.aws * std::sin(cartesianAWA) + p.boatSpeed;
+        p.twa = engine_.calculateTWA(p.twsX, p.twsY, p.awaHeel);
+    }
+}
+
+void CalculationBenchmark::setPolar(const PolarTable* polar) {
+    polar_ = polar;
+    engine_.setPolar(polar);
+}
+
+void CalculationBenchmark::loadCase(uint8_t index) {
+    const CorpusCase& c = CORPUS[index];
+    data_.wind.apparentWindAngle = c.awaDeg * DEG;
+    data_.wind.apparentWindSpeed = c.aws;
+    data_.compass.heelAngle = c.heelDeg * DEG;
+    data_.compass.magneticHeading = c.headingDeg * DEG;
+    data_.dst.measuredBoatSpeed = c.boatSpeed;
+    data_.gps.sog = c.sog;
+    data_.gps.cog = c.cogDeg * DEG;
+}
+
+uint32_t CalculationBenchmark::measureOverhead() {
+    uint32_t best = UINT32_MAX;
+    for (uint8_t i = 0; i < 32; i++) {
+        uint32_t start = counter_();
+        uint32_t cycles = counter_() - start;
+        best = std::min(best, cycles);
+    }
+    return best;
+}
+
+bool CalculationBenchmark::runStage(uint8_t stage, uint16_t iterations, CalcBenchStats& out) {
+    if (stage >= STAGE_COUNT || counter_ == nullptr) {
+        return false;
+    }
+    if (iterations < 1) {
+        iterations = 1;
+    }
+    if (iterations > CALC_BENCH_MAX_ITERATIONS) {
+        iterations = CALC_BENCH_MAX_ITERATIONS;
+    }
+    overhead_ = measureOverhead();
+
+    CalculationEngine& e = engine_;
+    const BoatScalar K = data_.calibration.leewayCalibrationFactor;
+    const BoatScalar offset = data_.calibration.windAngleOffset;
+
+    switch (stage) {
+        case 0:  // calculate(): the staged pipeline including damping and polar stages
+            for (uint16_t n = 0; n < iterations; n++) {
+                loadCase(n % CALC_BENCH_CORPUS);
+                uint32_t start = counter_();
+                e.calculate(&data_);
+                samples_[n] = counter_() - start;
+            }
+            sink = data_.derived.tws;
+            break;
+        case 1:  // Chained reference functions (the pre-pipeline calculate())
+            CALC_BENCH_LOOP({
+                BoatScalar awaOffset = e.calculateAWAOffset(p.awa, offset);
+                BoatScalar awaHeel = e.calculateAWAHeel(awaOffset, p.heel);
+                BoatScalar leeway = e.calculateLeeway(awaHeel, p.heel, p.boatSpeed, K);
+                BoatScalar stw = e.calculateSTW(p.boatSpeed, leeway);
+                BoatScalar tws = e.calculateTWS(p.aws, awaHeel, stw, p.boatSpeed, leeway);
+                BoatScalar cartesianAWA = AngleUtils::normalizeToZeroTwoPi(BoatScalar(3) * BoatMath::HALF_PI_RAD - awaHeel);
+                BoatScalar twsX = p.aws * std::cos(cartesianAWA) + stw * std::sin(leeway);
+                BoatScalar twsY = p.aws * std::sin(cartesianAWA) + p.boatSpeed;
+                BoatScalar twa = e.calculateTWA(twsX, twsY, awaHeel);
+                BoatScalar wdir = e.calculateWDIR(p.heading, twa);
+                BoatScalar vmg = e.calculateVMG(stw, twa, leeway);
+                BoatScalar soc, doc;
+                e.calculateCurrent(p.sog, p.cog, stw, p.heading, leeway, BoatScalar(0), soc, doc);
+                sink = tws + wdir + vmg + soc + doc;
+            })
+            break;
+        case 2:
+            CALC_BENCH_LOOP(sink = e.calculateAWAOffset(p.awa, offset))
+            break;
+        case 3:
+            CALC_BENCH_LOOP(sink = e.calculateAWAHeel(p.awaOffset, p.heel))
+            break;
+        case 4:
+            CALC_BENCH_LOOP(sink = e.calculateLeeway(p.awaHeel, p.heel, p.boatSpeed, K))
+            break;
+        case 5:
+            CALC_BENCH_LOOP(sink = e.calculateSTW(p.boatSpeed, p.leeway))
+            break;
+        case 6:
+            CALC_BENCH_LOOP(sink = e.calculateTWS(p.aws, p.awaHeel, p.stw, p.boatSpeed, p.leeway))
+            break;
+        case 7:
+            CALC_BENCH_LOOP(sink = e.calculateTWA(p.twsX, p.twsY, p.awaHeel))
+            break;
+        case 8:
+            CALC_BENCH_LOOP(sink = e.calculateWDIR(p.heading, p.twa))
+            break;
+        case 9:
+            CALC_BENCH_LOOP(sink = e.calculateVMG(p.stw, p.twa, p.leeway))
+            break;
+        case 10:
+            CALC_BENCH_LOOP({
+                BoatScalar soc, doc;
+                e.calculateCurrent(p.sog, p.cog, p.stw, p.heading, p.leeway, BoatScalar(0), soc, doc);
+                sink = soc + doc;
+            })
+            break;
+        default:  // 11: polar lookup (target speed + VMG target)
+            if (polar_ == nullptr || !polar_->loaded()) {
+                return false;
+            }
+            CALC_BENCH_LOOP({
+                PolarTarget target;
+                float tws = static_cast<float>(std::sqrt(p.twsX * p.twsX + p.twsY * p.twsY));
+                polar_->target(tws, std::fabs(p.twa) > BoatMath::HALF_PI_RAD, target);
+                sink = polar_->targetSpeed(tws, static_cast<float>(p.twa)) + target.twa;
+            })
+            break;
+    }
+
+    for (uint16_t n = 0; n < iterations; n++) {
+        samples_[n] = samples_[n] > overhead_ ? samples_[n] - overhead_ : 0;
+    }
+    summarize(samples_, iterations, out);
+    return true;
+}
+
+#undef CALC_BENCH_LOOP
+
+const char* CalculationBenchmark::stageName(uint8_t stage) {
+    static const char* const NAMES[STAGE_COUNT] = {
+        "calculate", "reference", "awa_offset", "awa_heel", "leeway", "stw",
+        "tws", "twa", "wdir", "vmg", "current", "polar"
+    };
+    return stage < STAGE_COUNT ? NAMES[stage] : "";
+}
+
+void CalculationBenchmark::writeStage(JsonWriter& json, uint8_t stage, const CalcBenchStats& stats) {
+    json.beginObject()
+        .add("stage", stageName(stage))
+        .add("min", stats.min)
+        .add("median", stats.median)
+        .add("p99", stats.p99)
+        .add("max", stats.max)
+        .endObject();
+}
+
+void CalculationBenchmark::summarize(uint32_t* samples, uint16_t count, CalcBenchStats& out) {
+    if (samples == nullptr || count == 0) {
+        out.min = out.median = out.p99 = out.max = 0;
+        return;
+    }
+    std::sort(samples, samples + count);
+
+    // Nearest rank: smallest sample with at least p% of samples at or below it
+    uint32_t medianRank = (static_cast<uint32_t>(count) * 50 + 99) / 100;
+    uint32_t p99Rank = (static_cast<uint32_t>(count) * 99 + 99) / 100;
+    out.min = samples[0];
+    out.median = samples[medianRank - 1];
+    out.p99 = samples[p99Rank - 1];
+    out.max = samples[count - 1];
+}
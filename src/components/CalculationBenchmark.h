@@ -0,0 +1,131 @@
+/**
+ * @file CalculationBenchmark.h
+ * @brief CPU-cycle micro-benchmark of CalculationEngine over a fixed input corpus
+ *
+ * Times calculate(), the chain of per-formula reference functions and each
+ * formula function on its own, one call at a time, over CALC_BENCH_CORPUS
+ * fixed sailing situations (upwind, reaching, running, both tacks, stopped).
+ * Every stage reports min / median / p99 / max cycles per call, with the
+ * cost of reading the counter subtracted. Comparing builds shows the effect
+ * of BOATDATA_FLOAT_STORAGE (float vs double), CALC_FAST_MATH (trig kernels)
+ * and the staged pipeline ("calculate" vs "reference").
+ *
+ * The benchmark owns its engine and input structure, so it can run in any
+ * context without touching the live BoatData. The cycle counter is injected
+ * (ESP.getCycleCount() on the ESP32, the CCOUNT register read by
+ * xthal_get_ccount()), which keeps the class Arduino-free.
+ *
+ * Enabled with CALC_BENCHMARK_ENABLED (env:esp32dev_bench), which serves
+ * the JSON at GET /calc/benchmark (CalculationBenchmarkWebServer).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed sample buffer, zero heap allocation; not built by default
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CALCULATION_BENCHMARK_H
+#define CALCULATION_BENCHMARK_H
+
+#include <stdint.h>
+#include "CalculationEngine.h"
+#include "../utils/JsonWriter.h"
+#include "../config.h"
+
+/// Returns a free-running CPU cycle count
+typedef uint32_t (*CycleCounter)();
+
+/**
+ * @brief Cycles per call of one stage
+ */
+struct CalcBenchStats {
+    uint32_t min;
+    uint32_t median;
+    uint32_t p99;
+    uint32_t max;
+};
+
+/**
+ * @class CalculationBenchmark
+ * @brief Per-stage cycle statistics of the calculation cycle
+ *
+ * Usage:
+ * @code
+ * CalculationBenchmark bench([]() -> uint32_t { return ESP.getCycleCount(); });
+ * StaticJsonWriter<160> json;
+ * CalcBenchStats stats;
+ * for (uint8_t s = 0; s < CalculationBenchmark::STAGE_COUNT; s++) {
+ *     bench.runStage(s, 128, stats);
+ *     CalculationBenchmark::writeStage(json, s, stats);
+ * }
+ * @endcode
+ */
+class CalculationBenchmark {
+public:
+    /// calculate, reference, awa_offset, awa_heel, leeway, stw, tws, twa, wdir, vmg, current, polar
+    static constexpr uint8_t STAGE_COUNT = 12;
+
+    explicit CalculationBenchmark(CycleCounter counter);
+
+    /**
+     * @brief Include the polar lookup (stage "polar" and calculate()); nullptr = none
+     */
+    void setPolar(const PolarTable* polar);
+
+    /**
+     * @brief Time @p iterations calls of @p stage (corpus cases in turn)
+     *
+     * @param iterations Clamped to [1, CALC_BENCH_MAX_ITERATIONS]
+     * @return false if @p stage is out of range
+     */
+    bool runStage(uint8_t stage, uint16_t iterations, CalcBenchStats& out);
+
+    /// Cycles of one counter read pair, subtracted from every sample
+    uint32_t getOverhead() const { return overhead_; }
+
+    /// JSON name of @p stage ("" if out of range)
+    static const char* stageName(uint8_t stage);
+
+    /**
+     * @brief One stage as an object: {"stage":"tws","min":..,"median":..,"p99":..,"max":..}
+     */
+    static void writeStage(JsonWriter& json, uint8_t stage, const CalcBenchStats& stats);
+
+    /**
+     * @brief Sort @p samples and take min/median/p99/max (nearest rank)
+     */
+    static void summarize(uint32_t* samples, uint16_t count, CalcBenchStats& out);
+
+private:
+    /// Per-case formula inputs: sensor values, and intermediates precomputed with the reference functions
+    struct Prepared {
+        BoatScalar awa;
+        BoatScalar aws;
+        BoatScalar heel;
+        BoatScalar boatSpeed;
+        BoatScalar heading;
+        BoatScalar sog;
+        BoatScalar cog;
+        BoatScalar awaOffset;
+        BoatScalar awaHeel;
+        BoatScalar leeway;
+        BoatScalar stw;
+        BoatScalar twsX;
+        BoatScalar twsY;
+        BoatScalar twa;
+    };
+
+    CycleCounter counter_;
+    uint32_t overhead_;
+    const PolarTable* polar_;
+    CalculationEngine engine_;
+    BoatDataStructure data_;
+    Prepared prepared_[CALC_BENCH_CORPUS];
+    uint32_t samples_[CALC_BENCH_MAX_ITERATIONS];
+
+    void loadCase(uint8_t index);
+    uint32_t measureOverhead();
+};
+
+#endif // CALCULATION_BENCHMARK_H
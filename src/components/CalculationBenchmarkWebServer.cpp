@@ -0,0 +1,72 @@
+/**
+ * @file CalculationBenchmarkWebServer.cpp
+ * @brief Implementation of the calculation benchmark endpoint
+ *
+ * @see CalculationBenchmarkWebServer.h
+ */
+
+#include "CalculationBenchmarkWebServer.h"
+
+namespace {
+
+uint32_t readCycleCount() {
+    return ESP.getCycleCount();  // CCOUNT (xthal_get_ccount())
+}
+
+}  // namespace
+
+CalculationBenchmarkWebServer::CalculationBenchmarkWebServer(const PolarTable* polar)
+    : benchmark(readCycleCount) {
+    benchmark.setPolar(polar);
+}
+
+void CalculationBenchmarkWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr) {
+        return;
+    }
+
+    // GET /calc/benchmark - Cycles per call of calculate() and each formula
+    server->on("/calc/benchmark", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetBenchmark(request);
+    });
+}
+
+void CalculationBenchmarkWebServer::handleGetBenchmark(AsyncWebServerRequest* request) {
+    uint16_t iterations = CALC_BENCH_DEFAULT_ITERATIONS;
+    if (request->hasParam("iterations")) {
+        long requested = request->getParam("iterations")->value().toInt();
+        iterations = static_cast<uint16_t>(requested < 1 ? 1
+            : requested > CALC_BENCH_MAX_ITERATIONS ? CALC_BENCH_MAX_ITERATIONS : requested);
+    }
+
+    // Run every stage before streaming, so the response does not interleave with the timing
+    CalcBenchStats stats[CalculationBenchmark::STAGE_COUNT];
+    bool ran[CalculationBenchmark::STAGE_COUNT];
+    for (uint8_t s = 0; s < CalculationBenchmark::STAGE_COUNT; s++) {
+        ran[s] = benchmark.runStage(s, iterations, stats[s]);
+    }
+
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+    response->printf("{\"storage\":\"%s\",\"fast_math\":%d,\"cpu_mhz\":%lu,\"iterations\":%u,"
+        "\"corpus\":%d,\"overhead_cycles\":%lu,\"stages\":[",
+        sizeof(BoatScalar) == sizeof(float) ? "float" : "double", CALC_FAST_MATH,
+        (unsigned long)ESP.getCpuFreqMHz(), (unsigned)iterations, CALC_BENCH_CORPUS,
+        (unsigned long)benchmark.getOverhead());
+
+    bool first = true;
+    for (uint8_t s = 0; s < CalculationBenchmark::STAGE_COUNT; s++) {
+        if (!ran[s]) {
+            continue;  // Polar without a loaded table
+        }
+        StaticJsonWriter<128> item;
+        CalculationBenchmark::writeStage(item, s, stats[s]);
+        if (!first) {
+            response->print(',');
+        }
+        response->print(item.c_str());
+        first = false;
+    }
+
+    response->print("]}");
+    request->send(response);
+}
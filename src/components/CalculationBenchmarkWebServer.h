@@ -0,0 +1,70 @@
+/**
+ * @file CalculationBenchmarkWebServer.h
+ * @brief HTTP trigger for the CalculationEngine cycle benchmark
+ *
+ * Provides (only with CALC_BENCHMARK_ENABLED, env:esp32dev_bench):
+ * - GET /calc/benchmark[?iterations=N]: runs CalculationBenchmark and
+ *   returns cycles per call of every stage
+ *
+ * The run takes roughly iterations x 12 stages x a few thousand cycles
+ * (~100 ms at 240 MHz for the default 128) inside the web server task. It
+ * uses its own engine and inputs, so the live calculation cycle is not
+ * disturbed, but it competes with it for the CPU: compare medians, not
+ * maxima, and benchmark a quiet system.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef CALCULATION_BENCHMARK_WEB_SERVER_H
+#define CALCULATION_BENCHMARK_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "CalculationBenchmark.h"
+
+/**
+ * @brief Web server route for the calculation benchmark
+ */
+class CalculationBenchmarkWebServer {
+private:
+    CalculationBenchmark benchmark;
+
+    /**
+     * @brief Handle GET /calc/benchmark
+     *
+     * Returns:
+     * {
+     *   "storage": "float", "fast_math": 1, "cpu_mhz": 240,
+     *   "iterations": 128, "corpus": 12, "overhead_cycles": 12,
+     *   "stages": [
+     *     {"stage": "calculate", "min": 2810, "median": 2950, "p99": 3400, "max": 5120},
+     *     {"stage": "reference", ...}, {"stage": "awa_offset", ...}, ...
+     *   ]
+     * }
+     *
+     * "polar" is listed only when a polar is loaded. Cycles exclude the
+     * counter reads (overhead_cycles).
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetBenchmark(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param polar Polar table to include (nullptr = none)
+     */
+    explicit CalculationBenchmarkWebServer(const PolarTable* polar);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // CALCULATION_BENCHMARK_WEB_SERVER_H
@@ -8,293 +8,477 @@
 
 #include "CalculationEngine.h"
 
+#ifndef ARDUINO
+unsigned long millis();  // Host builds: defined by the test or tool
+#endif
+
+CalculationEngine::CalculationEngine() : polar_(nullptr), scratch_() {
+}
+
+void CalculationEngine::setPolar(const PolarTable* polar) {
+    polar_ = polar;
+}
+
 void CalculationEngine::calculate(BoatDataStructure* boatData) {
+    calculate(boatData, static_cast<uint32_t>(millis()));
+}
+
+void CalculationEngine::calculate(BoatDataStructure* boatData, uint32_t now) {
+    // The cycle works on the scratch copy; readers keep the last published set.
+    // Starting from the published values keeps fields a cycle does not write.
+    scratch_ = boatData->derived;
+
     // Check if we have minimum required sensor data
     if (!boatData->gps.available ||
         !boatData->compass.available ||
         !boatData->wind.available ||
         !boatData->dst.available) {  // Updated for v2.0.0: speed → dst
         // Insufficient data - mark derived as unavailable
-        boatData->derived.available = false;
+        scratch_.available = false;
+        filters_.reset();
+        aligner_.reset();
+        publish(boatData);
         return;
     }
 
-    // Get calibration parameters
-    double K = boatData->calibration.leewayCalibrationFactor;
-    double windOffset = boatData->calibration.windAngleOffset;
-
-    // Extract sensor data
-    double awa = boatData->wind.apparentWindAngle;
-    double aws = boatData->wind.apparentWindSpeed;
-    double heel = boatData->compass.heelAngle;  // Updated for v2.0.0: moved to CompassData
-    double boatSpeed = boatData->dst.measuredBoatSpeed;  // Updated for v2.0.0: speed → dst
-    double heading = boatData->compass.magneticHeading;
-    double variation = boatData->gps.variation;  // Updated for v2.0.0: moved to GPSData
-    double sog = boatData->gps.sog;
-    double cog = boatData->gps.cog;
-
-    // =========================================================================
-    // STEP 1: AWA Offset Correction
-    // =========================================================================
-    double awaOffset = calculateAWAOffset(awa, windOffset);
-    boatData->derived.awaOffset = awaOffset;
-
-    // =========================================================================
-    // STEP 2: AWA Heel Correction
-    // =========================================================================
-    double awaHeel = calculateAWAHeel(awaOffset, heel);
-    boatData->derived.awaHeel = awaHeel;
+    Intermediates im;
 
-    // =========================================================================
-    // STEP 3: Leeway Calculation
-    // =========================================================================
-    double leeway = calculateLeeway(awaHeel, heel, boatSpeed, K);
-    boatData->derived.leeway = leeway;
+    // Inputs at a common reference time, then damped (calibration.damping)
+    alignInputs(boatData, im);
+    filterInputs(boatData, im, now);
 
-    // =========================================================================
-    // STEP 4: Speed Through Water
-    // =========================================================================
-    double stw = calculateSTW(boatSpeed, leeway);
-    boatData->derived.stw = stw;
+    // STEP 1 & 2: AWA Offset and Heel Correction
+    stageApparentWind(boatData, im);
 
-    // =========================================================================
-    // STEP 5 & 6: True Wind Speed and Angle
-    // =========================================================================
-    double tws = calculateTWS(aws, awaHeel, stw, boatSpeed, leeway);
-    boatData->derived.tws = tws;
+    // STEP 3 & 4: Leeway and Speed Through Water
+    stageLeeway(boatData, im);
 
-    // Calculate TWS vector components (needed for TWA)
-    double cartesianAWA = AngleUtils::normalizeToZeroTwoPi(3 * M_PI / 2 - awaHeel);
-    double aws_x = aws * cos(cartesianAWA);
-    double aws_y = aws * sin(cartesianAWA);
-    double lateral_speed = stw * sin(leeway);
-    double tws_x = aws_x + lateral_speed;
-    double tws_y = aws_y + boatSpeed;
+    // STEP 5 - 8: True Wind Speed/Angle, Wind Direction, VMG
+    stageTrueWind(boatData, im);
 
-    double twa = calculateTWA(tws_x, tws_y, awaHeel);
-    boatData->derived.twa = twa;
+    // STEP 9 & 10: Current Speed and Direction
+    stageCurrent(boatData, im);
 
-    // =========================================================================
-    // STEP 7: Wind Direction
-    // =========================================================================
-    double wdir = calculateWDIR(heading, twa);
-    boatData->derived.wdir = wdir;
+    // Damped outputs
+    filterOutputs(boatData, now);
 
-    // =========================================================================
-    // STEP 8: Velocity Made Good
-    // =========================================================================
-    double vmg = calculateVMG(stw, twa, leeway);
-    boatData->derived.vmg = vmg;
+    // Polar targets for the damped true wind
+    stagePolar(boatData);
 
-    // =========================================================================
-    // STEP 9 & 10: Current Speed and Direction
-    // =========================================================================
-    double soc, doc;
-    calculateCurrent(sog, cog, stw, heading, leeway, variation, soc, doc);
-    boatData->derived.soc = soc;
-    boatData->derived.doc = doc;
+    // 10 s / 1 min / 10 min averages and gusts
+    stats_.update(scratch_, now);
 
     // =========================================================================
     // Mark as available and update timestamp
     // =========================================================================
-    boatData->derived.available = true;
-    boatData->derived.lastUpdate = millis();
+    scratch_.available = true;
+    scratch_.lastUpdate = now;
+    publish(boatData);
 
     // Update diagnostics
     boatData->diagnostics.calculationCount++;
 }
 
+void CalculationEngine::publish(BoatDataStructure* boatData) {
+    // One copy inside the derived counter: the write window is the copy, not the cycle
+    boatData->versions.derived.writeBegin();
+    boatData->derived = scratch_;
+    boatData->versions.derived.writeEnd();
+}
+
+// =============================================================================
+// PIPELINE STAGES
+// =============================================================================
+
+void CalculationEngine::alignInputs(const BoatDataStructure* boatData, Intermediates& im) {
+    const WindData& wind = boatData->wind;
+    const CompassData& compass = boatData->compass;
+    const DSTData& dst = boatData->dst;  // Updated for v2.0.0: speed → dst
+    const GPSData& gps = boatData->gps;
+
+#if CALC_ALIGN_INPUTS
+    aligner_.record(ALIGN_AWA, wind.lastUpdate, wind.apparentWindAngle);
+    aligner_.record(ALIGN_AWS, wind.lastUpdate, wind.apparentWindSpeed);
+    aligner_.record(ALIGN_HEADING, compass.lastUpdate, compass.magneticHeading);
+    aligner_.record(ALIGN_HEEL, compass.lastUpdate, compass.heelAngle);  // Updated for v2.0.0: moved to CompassData
+    aligner_.record(ALIGN_BOAT_SPEED, dst.lastUpdate, dst.measuredBoatSpeed);
+    aligner_.record(ALIGN_SOG, gps.lastUpdate, gps.sog);
+    aligner_.record(ALIGN_COG, gps.lastUpdate, gps.cog);
+
+    // The older of the two angular groups: the faster one is interpolated
+    // back to it, boat speed and GPS are extrapolated (limited) to it
+    uint32_t refMs = static_cast<int32_t>(wind.lastUpdate - compass.lastUpdate) < 0
+                         ? wind.lastUpdate : compass.lastUpdate;
+
+    im.awa = alignedValue(ALIGN_AWA, refMs, wind.apparentWindAngle);
+    im.aws = alignedValue(ALIGN_AWS, refMs, wind.apparentWindSpeed);
+    im.heading = alignedValue(ALIGN_HEADING, refMs, compass.magneticHeading);
+    im.heel = alignedValue(ALIGN_HEEL, refMs, compass.heelAngle);
+    im.boatSpeed = alignedValue(ALIGN_BOAT_SPEED, refMs, dst.measuredBoatSpeed);
+    im.sog = alignedValue(ALIGN_SOG, refMs, gps.sog);
+    im.cog = alignedValue(ALIGN_COG, refMs, gps.cog);
+#else
+    im.awa = wind.apparentWindAngle;
+    im.aws = wind.apparentWindSpeed;
+    im.heading = compass.magneticHeading;
+    im.heel = compass.heelAngle;
+    im.boatSpeed = dst.measuredBoatSpeed;
+    im.sog = gps.sog;
+    im.cog = gps.cog;
+#endif
+}
+
+BoatScalar CalculationEngine::alignedValue(AlignedInput input, uint32_t refMs, BoatScalar raw) const {
+    // A non-finite reading is passed on rather than hidden by older samples
+    return std::isfinite(raw) ? aligner_.valueAt(input, refMs) : raw;
+}
+
+void CalculationEngine::filterInputs(const BoatDataStructure* boatData, Intermediates& im, uint32_t nowMs) {
+    const DampingConfig& damping = boatData->calibration.damping;
+    im.awa = filters_.apply(DAMPING_AWA, im.awa, damping, nowMs);
+    im.aws = filters_.apply(DAMPING_AWS, im.aws, damping, nowMs);
+    im.boatSpeed = filters_.apply(DAMPING_BOAT_SPEED, im.boatSpeed, damping, nowMs);
+    im.heading = filters_.apply(DAMPING_HEADING, im.heading, damping, nowMs);
+    im.heel = filters_.apply(DAMPING_HEEL, im.heel, damping, nowMs);
+}
+
+void CalculationEngine::filterOutputs(BoatDataStructure* boatData, uint32_t nowMs) {
+    const DampingConfig& damping = boatData->calibration.damping;
+    DerivedData& derived = scratch_;
+    derived.tws = filters_.apply(DAMPING_TWS, derived.tws, damping, nowMs);
+    derived.twa = filters_.apply(DAMPING_TWA, derived.twa, damping, nowMs);
+    derived.wdir = filters_.apply(DAMPING_WDIR, derived.wdir, damping, nowMs);
+    derived.vmg = filters_.apply(DAMPING_VMG, derived.vmg, damping, nowMs);
+    derived.soc = filters_.apply(DAMPING_SOC, derived.soc, damping, nowMs);
+    derived.doc = filters_.apply(DAMPING_DOC, derived.doc, damping, nowMs);
+}
+
+void CalculationEngine::stageApparentWind(BoatDataStructure* boatData, Intermediates& im) {
+    BoatScalar awaOffset = calculateAWAOffset(im.awa, boatData->calibration.windAngleOffset);
+    scratch_.awaOffset = awaOffset;
+
+    AngleUtils::sincos(awaOffset, im.sinAwaOffset, im.cosAwaOffset);
+    im.cosHeel = AngleUtils::cos(im.heel);
+
+    BoatScalar awaHeel = awaOffset;
+    im.sinAwaHeel = im.sinAwaOffset;
+    im.cosAwaHeel = im.cosAwaOffset;
+
+    // Same guards as calculateAWAHeel(): non-finite input, extreme heel (near 90°)
+    if (std::isfinite(awaOffset) && std::fabs(im.cosHeel) >= BoatScalar(0.0001)) {
+        BoatScalar y = im.sinAwaOffset;
+        BoatScalar x = im.cosAwaOffset * im.cosHeel;
+        BoatScalar r = std::sqrt(x * x + y * y);  // >= 0.0001 (sin² + cos² = 1)
+        awaHeel = AngleUtils::normalizeToPiMinusPi(AngleUtils::atan2(y, x));
+        im.sinAwaHeel = y / r;
+        im.cosAwaHeel = x / r;
+    }
+    scratch_.awaHeel = awaHeel;
+}
+
+void CalculationEngine::stageLeeway(BoatDataStructure* boatData, Intermediates& im) {
+    BoatScalar boatSpeed = im.boatSpeed;
+    BoatScalar leeway = calculateLeeway(scratch_.awaHeel, im.heel, boatSpeed,
+                                        boatData->calibration.leewayCalibrationFactor);
+    scratch_.leeway = leeway;
+    scratch_.stw = calculateSTW(boatSpeed, leeway);
+
+    if (leeway == BoatScalar(0)) {
+        // Stopped, or wind and heel on the same side
+        im.sinLeeway = BoatScalar(0);
+        im.cosLeeway = BoatScalar(1);
+    } else {
+        AngleUtils::sincos(leeway, im.sinLeeway, im.cosLeeway);
+    }
+}
+
+void CalculationEngine::stageTrueWind(BoatDataStructure* boatData, Intermediates& im) {
+    BoatScalar aws = im.aws;
+    BoatScalar stw = scratch_.stw;
+
+    // Apparent wind vector at Cartesian angle 270° - awaHeel, plus boat motion
+    im.twsX = -aws * im.sinAwaHeel + stw * im.sinLeeway;
+    im.twsY = -aws * im.cosAwaHeel + im.boatSpeed;
+
+    BoatScalar tws = std::sqrt(im.twsX * im.twsX + im.twsY * im.twsY);
+    scratch_.tws = tws;
+
+    // TWA = 270° - atan2(twsY, twsX), signed by the tack (as calculateTWA())
+    BoatScalar twa;
+    BoatScalar twa_cartesian = AngleUtils::atan2(im.twsY, im.twsX);
+    if (std::isnan(twa_cartesian)) {
+        twa = im.twsY < BoatScalar(0) ? BoatMath::PI_RAD : BoatScalar(0);
+    } else {
+        twa = AngleUtils::normalizeToZeroTwoPi(BoatScalar(3) * BoatMath::HALF_PI_RAD - twa_cartesian);
+        if (scratch_.awaHeel < BoatScalar(0)) {
+            twa -= BoatMath::TWO_PI_RAD;  // Port tack
+        }
+        twa = AngleUtils::normalizeToPiMinusPi(twa);
+    }
+    scratch_.twa = twa;
+
+    // TWA = 270° - atan2(twsY, twsX) (mod 2π); atan2(0, 0) = 0
+    BoatScalar cosCart = BoatScalar(1);
+    BoatScalar sinCart = BoatScalar(0);
+    if (tws > BoatScalar(0)) {
+        cosCart = im.twsX / tws;
+        sinCart = im.twsY / tws;
+    }
+    im.cosTwa = -sinCart;
+    im.sinTwa = -cosCart;
+
+    scratch_.wdir = calculateWDIR(im.heading, twa);
+
+    // VMG = STW * cos(leeway - TWA)
+    scratch_.vmg = stw * (im.cosLeeway * im.cosTwa + im.sinLeeway * im.sinTwa);
+}
+
+void CalculationEngine::stageCurrent(BoatDataStructure* boatData, Intermediates& im) {
+    BoatScalar sog = im.sog;
+    BoatScalar stw = scratch_.stw;
+    BoatScalar heading = im.heading;
+
+    AngleUtils::sincos(heading, im.sinHeading, im.cosHeading);
+
+    // COG (true) to magnetic; variation moved to GPSData in v2.0.0
+    BoatScalar cogMag = im.cog + boatData->gps.variation;
+
+    // GPS velocity at Cartesian angle 90° - cog_mag
+    BoatScalar sinCog, cosCog;
+    AngleUtils::sincos(cogMag, sinCog, cosCog);
+    BoatScalar sog_x = sog * sinCog;
+    BoatScalar sog_y = sog * cosCog;
+
+    // Water velocity at Cartesian angle 90° - (heading + leeway)
+    BoatScalar stw_x = stw * (im.sinHeading * im.cosLeeway + im.cosHeading * im.sinLeeway);
+    BoatScalar stw_y = stw * (im.cosHeading * im.cosLeeway - im.sinHeading * im.sinLeeway);
+
+    // Current vector = GPS velocity - Water velocity
+    BoatScalar curr_x = sog_x - stw_x;
+    BoatScalar curr_y = sog_y - stw_y;
+
+    scratch_.soc = std::sqrt(curr_x * curr_x + curr_y * curr_y);
+
+    BoatScalar doc_cartesian = AngleUtils::atan2(curr_y, curr_x);
+    if (std::isnan(doc_cartesian)) {
+        // Singularity: zero current
+        scratch_.doc = curr_y < BoatScalar(0) ? BoatMath::PI_RAD : BoatScalar(0);
+    } else {
+        // Convert from Cartesian to nautical: DOC = 90° - doc_cartesian
+        scratch_.doc = AngleUtils::normalizeToZeroTwoPi(BoatMath::HALF_PI_RAD - doc_cartesian);
+    }
+}
+
+void CalculationEngine::stagePolar(BoatDataStructure* boatData) {
+    DerivedData& derived = scratch_;
+    PolarTarget target;
+    if (polar_ == nullptr ||
+        !polar_->target(derived.tws, std::fabs(derived.twa) > BoatMath::HALF_PI_RAD, target)) {
+        derived.polarSpeed = NAN;
+        derived.polarPerformance = NAN;
+        derived.targetTwa = NAN;
+        derived.targetVmg = NAN;
+        return;
+    }
+
+    BoatScalar polarSpeed = polar_->targetSpeed(derived.tws, derived.twa);
+    derived.polarSpeed = polarSpeed;
+    derived.polarPerformance = polarSpeed > BoatScalar(0) ? derived.stw / polarSpeed * BoatScalar(100) : NAN;
+    derived.targetTwa = derived.twa < BoatScalar(0) ? -target.twa : target.twa;  // Same tack
+    derived.targetVmg = target.vmg;
+}
+
 // =============================================================================
-// PRIVATE CALCULATION METHODS
+// PER-FORMULA REFERENCE IMPLEMENTATIONS
 // =============================================================================
 
-double CalculationEngine::calculateAWAOffset(double awa, double offset) {
+BoatScalar CalculationEngine::calculateAWAOffset(BoatScalar awa, BoatScalar offset) {
     // Add offset and normalize to [-π, π]
-    double awaOffset = awa + offset;
+    BoatScalar awaOffset = awa + offset;
     return AngleUtils::normalizeToPiMinusPi(awaOffset);
 }
 
-double CalculationEngine::calculateAWAHeel(double awaOffset, double heel) {
-    // Calculate tan(AWA) - check for singularity
-    double tan_awa = tan(awaOffset);
+BoatScalar CalculationEngine::calculateAWAHeel(BoatScalar awaOffset, BoatScalar heel) {
+    // Calculate std::tan(AWA) - check for singularity
+    BoatScalar tan_awa = std::tan(awaOffset);
 
-    if (isnan(tan_awa) || isinf(tan_awa)) {
+    if (std::isnan(tan_awa) || std::isinf(tan_awa)) {
         // Singularity: wind directly ahead (0°) or astern (±180°)
         // No heel correction needed
         return awaOffset;
     }
 
     // Calculate heel-corrected AWA
-    double cos_heel = cos(heel);
-    if (fabs(cos_heel) < 0.0001) {
+    BoatScalar cos_heel = std::cos(heel);
+    if (std::fabs(cos_heel) < BoatScalar(0.0001)) {
         // Extreme heel (near 90°) - no correction
         return awaOffset;
     }
 
-    double awaHeel = atan(tan_awa / cos_heel);
+    BoatScalar awaHeel = std::atan(tan_awa / cos_heel);
 
     // Quadrant correction (atan only returns [-π/2, π/2])
-    if (awaOffset >= 0.0) {
+    if (awaOffset >= BoatScalar(0)) {
         // Starboard tack
-        if (awaOffset > M_PI / 2) {
+        if (awaOffset > BoatMath::HALF_PI_RAD) {
             // Aft quadrant - add 180°
-            awaHeel += M_PI;
+            awaHeel += BoatMath::PI_RAD;
         }
     } else {
         // Port tack
-        if (awaOffset < -M_PI / 2) {
+        if (awaOffset < -BoatMath::HALF_PI_RAD) {
             // Aft quadrant - subtract 180°
-            awaHeel -= M_PI;
+            awaHeel -= BoatMath::PI_RAD;
         }
     }
 
     return AngleUtils::normalizeToPiMinusPi(awaHeel);
 }
 
-double CalculationEngine::calculateLeeway(double awaHeel, double heel, double boatSpeed, double K) {
+BoatScalar CalculationEngine::calculateLeeway(BoatScalar awaHeel, BoatScalar heel, BoatScalar boatSpeed, BoatScalar K) {
     // No leeway if boat is stopped (avoid divide-by-zero)
-    if (boatSpeed < 0.1) {
-        return 0.0;
+    if (boatSpeed < BoatScalar(0.1)) {
+        return BoatScalar(0);
     }
 
     // No leeway if wind and heel are on the same side (physical impossibility)
     // Wind on starboard (AWA > 0) with starboard heel (heel > 0) = no leeway
     // Wind on port (AWA < 0) with port heel (heel < 0) = no leeway
-    if ((awaHeel > 0.0 && heel > 0.0) || (awaHeel < 0.0 && heel < 0.0)) {
-        return 0.0;
+    if ((awaHeel > BoatScalar(0) && heel > BoatScalar(0)) || (awaHeel < BoatScalar(0) && heel < BoatScalar(0))) {
+        return BoatScalar(0);
     }
 
     // Calculate leeway: K * heel / (boat_speed^2)
-    double leeway = K * heel / (boatSpeed * boatSpeed);
+    BoatScalar leeway = K * heel / (boatSpeed * boatSpeed);
 
     // Clamp to ±45° (π/4 radians) for very low speeds
-    if (leeway > M_PI / 4) {
-        leeway = M_PI / 4;
-    } else if (leeway < -M_PI / 4) {
-        leeway = -M_PI / 4;
+    if (leeway > BoatMath::QUARTER_PI_RAD) {
+        leeway = BoatMath::QUARTER_PI_RAD;
+    } else if (leeway < -BoatMath::QUARTER_PI_RAD) {
+        leeway = -BoatMath::QUARTER_PI_RAD;
     }
 
     return leeway;
 }
 
-double CalculationEngine::calculateSTW(double boatSpeed, double leeway) {
+BoatScalar CalculationEngine::calculateSTW(BoatScalar boatSpeed, BoatScalar leeway) {
     // Simplified: STW = measured boat speed
     // More complex implementations might adjust for leeway:
-    // stw = boatSpeed / cos(leeway)
+    // stw = boatSpeed / std::cos(leeway)
     return boatSpeed;
 }
 
-double CalculationEngine::calculateTWS(double aws, double awaHeel, double stw, double boatSpeed, double leeway) {
+BoatScalar CalculationEngine::calculateTWS(BoatScalar aws, BoatScalar awaHeel, BoatScalar stw, BoatScalar boatSpeed, BoatScalar leeway) {
     // Convert AWA to Cartesian coordinates (0° = East, 90° = North)
     // Cartesian AWA = 270° - awaHeel
-    double cartesianAWA = AngleUtils::normalizeToZeroTwoPi(3 * M_PI / 2 - awaHeel);
+    BoatScalar cartesianAWA = AngleUtils::normalizeToZeroTwoPi(BoatScalar(3) * BoatMath::HALF_PI_RAD - awaHeel);
 
     // Apparent wind vector
-    double aws_x = aws * cos(cartesianAWA);
-    double aws_y = aws * sin(cartesianAWA);
+    BoatScalar aws_x = aws * std::cos(cartesianAWA);
+    BoatScalar aws_y = aws * std::sin(cartesianAWA);
 
     // Boat motion vector (forward + lateral from leeway)
-    double lateral_speed = stw * sin(leeway);
+    BoatScalar lateral_speed = stw * std::sin(leeway);
     // double forward_speed = boatSpeed;  // Already in Y direction
 
     // True wind vector = Apparent wind + Boat motion
-    double tws_x = aws_x + lateral_speed;
-    double tws_y = aws_y + boatSpeed;
+    BoatScalar tws_x = aws_x + lateral_speed;
+    BoatScalar tws_y = aws_y + boatSpeed;
 
     // True wind speed = magnitude of true wind vector
-    double tws = sqrt(tws_x * tws_x + tws_y * tws_y);
+    BoatScalar tws = std::sqrt(tws_x * tws_x + tws_y * tws_y);
 
     return tws;
 }
 
-double CalculationEngine::calculateTWA(double tws_x, double tws_y, double awaHeel) {
+BoatScalar CalculationEngine::calculateTWA(BoatScalar tws_x, BoatScalar tws_y, BoatScalar awaHeel) {
     // Calculate TWA in Cartesian coordinates
-    double twa_cartesian = atan2(tws_y, tws_x);
+    BoatScalar twa_cartesian = std::atan2(tws_y, tws_x);
 
     // Check for singularity (zero wind)
-    if (isnan(twa_cartesian)) {
+    if (std::isnan(twa_cartesian)) {
         // Zero wind - default based on boat direction
-        if (tws_y < 0.0) {
-            return M_PI;  // 180° (wind astern)
+        if (tws_y < BoatScalar(0)) {
+            return BoatMath::PI_RAD;  // 180° (wind astern)
         } else {
-            return 0.0;   // 0° (wind ahead)
+            return BoatScalar(0);   // 0° (wind ahead)
         }
     }
 
     // Convert from Cartesian to nautical
     // TWA = 270° - twa_cartesian
-    double twa = AngleUtils::normalizeToZeroTwoPi(3 * M_PI / 2 - twa_cartesian);
+    BoatScalar twa = AngleUtils::normalizeToZeroTwoPi(BoatScalar(3) * BoatMath::HALF_PI_RAD - twa_cartesian);
 
     // Normalize to [-π, π] with proper sign based on AWA
-    if (awaHeel >= 0.0) {
+    if (awaHeel >= BoatScalar(0)) {
         // Starboard tack
-        twa = fmod(twa, 2 * M_PI);
+        twa = std::fmod(twa, BoatMath::TWO_PI_RAD);
     } else {
         // Port tack
-        twa -= 2 * M_PI;
+        twa -= BoatMath::TWO_PI_RAD;
     }
 
     // Final normalization to [-π, π]
     return AngleUtils::normalizeToPiMinusPi(twa);
 }
 
-double CalculationEngine::calculateWDIR(double heading, double twa) {
+BoatScalar CalculationEngine::calculateWDIR(BoatScalar heading, BoatScalar twa) {
     // Wind direction = heading + true wind angle
-    double wdir = heading + twa;
+    BoatScalar wdir = heading + twa;
 
     // Normalize to [0, 2π]
     return AngleUtils::normalizeToZeroTwoPi(wdir);
 }
 
-double CalculationEngine::calculateVMG(double stw, double twa, double leeway) {
+BoatScalar CalculationEngine::calculateVMG(BoatScalar stw, BoatScalar twa, BoatScalar leeway) {
     // VMG = component of STW in the wind direction
-    // VMG = STW * cos(-TWA + leeway)
-    double vmg = stw * cos(-twa + leeway);
+    // VMG = STW * std::cos(-TWA + leeway)
+    BoatScalar vmg = stw * std::cos(-twa + leeway);
 
     return vmg;
 }
 
-void CalculationEngine::calculateCurrent(double sog, double cog, double stw, double heading,
-                                          double leeway, double variation,
-                                          double& outSOC, double& outDOC) {
+void CalculationEngine::calculateCurrent(BoatScalar sog, BoatScalar cog, BoatScalar stw, BoatScalar heading,
+                                          BoatScalar leeway, BoatScalar variation,
+                                          BoatScalar& outSOC, BoatScalar& outDOC) {
     // Convert COG (true) to magnetic
-    double cog_mag = cog + variation;
+    BoatScalar cog_mag = cog + variation;
     cog_mag = AngleUtils::normalizeToZeroTwoPi(cog_mag);
 
     // Convert to Cartesian coordinates (0° = East, 90° = North)
     // Boat heading in Cartesian: alpha = 90° - (heading + leeway)
-    double alpha = AngleUtils::normalizeToZeroTwoPi(M_PI / 2 - (heading + leeway));
+    BoatScalar alpha = AngleUtils::normalizeToZeroTwoPi(BoatMath::HALF_PI_RAD - (heading + leeway));
 
     // GPS motion in Cartesian: gamma = 90° - cog_mag
-    double gamma = AngleUtils::normalizeToZeroTwoPi(M_PI / 2 - cog_mag);
+    BoatScalar gamma = AngleUtils::normalizeToZeroTwoPi(BoatMath::HALF_PI_RAD - cog_mag);
 
     // GPS velocity vector
-    double sog_x = sog * cos(gamma);
-    double sog_y = sog * sin(gamma);
+    BoatScalar sog_x = sog * std::cos(gamma);
+    BoatScalar sog_y = sog * std::sin(gamma);
 
     // Water velocity vector
-    double stw_x = stw * cos(alpha);
-    double stw_y = stw * sin(alpha);
+    BoatScalar stw_x = stw * std::cos(alpha);
+    BoatScalar stw_y = stw * std::sin(alpha);
 
     // Current vector = GPS velocity - Water velocity
-    double curr_x = sog_x - stw_x;
-    double curr_y = sog_y - stw_y;
+    BoatScalar curr_x = sog_x - stw_x;
+    BoatScalar curr_y = sog_y - stw_y;
 
     // Current speed (magnitude)
-    outSOC = sqrt(curr_x * curr_x + curr_y * curr_y);
+    outSOC = std::sqrt(curr_x * curr_x + curr_y * curr_y);
 
     // Current direction
-    double doc_cartesian = atan2(curr_y, curr_x);
+    BoatScalar doc_cartesian = std::atan2(curr_y, curr_x);
 
-    if (isnan(doc_cartesian)) {
+    if (std::isnan(doc_cartesian)) {
         // Singularity: zero current
-        if (curr_y < 0.0) {
-            outDOC = M_PI;  // 180°
+        if (curr_y < BoatScalar(0)) {
+            outDOC = BoatMath::PI_RAD;  // 180°
         } else {
-            outDOC = 0.0;   // 0°
+            outDOC = BoatScalar(0);   // 0°
         }
     } else {
         // Convert from Cartesian to nautical: DOC = 90° - doc_cartesian
-        outDOC = AngleUtils::normalizeToZeroTwoPi(M_PI / 2 - doc_cartesian);
+        outDOC = AngleUtils::normalizeToZeroTwoPi(BoatMath::HALF_PI_RAD - doc_cartesian);
     }
 }
@@ -16,6 +16,36 @@
  *
  * Formulas validated from examples/Calculations/calc.cpp and referenced blog posts.
  * All singularities (divide-by-zero, atan2 NaN, tan(±90°)) are handled gracefully.
+ * Math runs in BoatScalar precision (float on the FPU with BOATDATA_FLOAT_STORAGE).
+ *
+ * calculate() is a staged pipeline (apparent wind, leeway, true wind,
+ * current) that carries the sines/cosines it has computed in an
+ * Intermediates struct and derives the rest by angle identities, so each
+ * transcendental is evaluated once per cycle. The per-formula functions are
+ * public, unchanged reference implementations (the pipeline is tested
+ * against them). The pipeline's sin/cos/atan2 go through AngleUtils, so
+ * CALC_FAST_MATH swaps in the FastMath kernels (error bounds in FastMath.h).
+ *
+ * Inputs arrive at different rates, so before the pipeline an alignment
+ * stage evaluates them all at one reference time, the older of the wind
+ * and compass lastUpdate: the faster of the two is interpolated back to
+ * it, boat speed and GPS are extrapolated to it, limited to
+ * CALC_ALIGN_MAX_EXTRAPOLATION_MS (InputAligner.h; CALC_ALIGN_INPUTS 0 =
+ * latest values).
+ *
+ * A filter stage damps the inputs (AWA, AWS, boat speed, heading, heel)
+ * before the pipeline and the outputs (TWS, TWA, WDIR, VMG, SOC, DOC)
+ * after it, with the time constants of calibration.damping (see
+ * DampingConfig.h; all 0 = unfiltered). BoatData keeps the raw sensor values.
+ *
+ * With a polar (setPolar()), a last stage looks up the target speed,
+ * %polar and best-VMG angle for the damped TWS/TWA (PolarTable.h);
+ * without one those DerivedData fields are NaN.
+ *
+ * Finally DerivedStatistics folds the damped TWS, WDIR and VMG into its
+ * 10 s / 1 min / 10 min windows and publishes the averages and gusts.
+ * It is not reset when inputs become unavailable: a dropout ages out of
+ * the windows.
  *
  * @see specs/003-boatdata-feature-as/research.md lines 67-191
  * @see test/integration/test_derived_calculation.cpp
@@ -28,13 +58,24 @@
 
 #include "../types/BoatDataTypes.h"
 #include "../utils/AngleUtils.h"
+#include "../utils/DampingFilters.h"
+#include "../utils/DerivedStatistics.h"
+#include "../utils/InputAligner.h"
+#include "../utils/PolarTable.h"
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
+#include <cmath>
 
 /**
  * @brief Calculation engine for derived parameters
  *
- * Stateless calculation engine - all calculations are pure functions of input data.
- * Call calculate() every 200ms to update derived parameters.
+ * All calculations are pure functions of input data; the only state is
+ * the input sample history, the damping filters (fixed size, reset
+ * when inputs become unavailable) and the statistics windows.
+ * Call calculate() when its inputs change (main.cpp: BoatData subscription).
+ * The engine has no Arduino dependency: host builds (native tests, the
+ * tools/calc_batch log runner) pass their own clock to calculate(data, nowMs).
  *
  * Usage:
  * @code
@@ -45,6 +86,15 @@
  */
 class CalculationEngine {
 public:
+    CalculationEngine();
+
+    /**
+     * @brief Use @p polar for the polar targets (nullptr = none)
+     *
+     * @param polar Loaded table, must outlive the engine
+     */
+    void setPolar(const PolarTable* polar);
+
     /**
      * @brief Calculate all derived parameters
      *
@@ -52,6 +102,13 @@ public:
      * Updates boatData->derived structure. Marks derived.available = false if
      * insufficient sensor data is available.
      *
+     * The stages write a private scratch DerivedData. The finished set is
+     * copied into boatData->derived in one write of the derived counter
+     * (versions.derived), so a reader on another task never sees a new TWS
+     * with the previous TWA, and retries only for the copy, not the cycle.
+     * Each call publishes once: versions.derived.version() is the cycle's
+     * generation. The caller must not hold the derived counter.
+     *
      * Required sensor data:
      * - GPS: latitude, longitude, COG, SOG (for current calculations)
      * - Compass: true heading, magnetic heading, variation
@@ -63,7 +120,18 @@ public:
      */
     void calculate(BoatDataStructure* boatData);
 
-private:
+    /**
+     * @brief calculate() at @p nowMs instead of millis()
+     *
+     * For replaying recorded inputs at their recorded times (damping and
+     * statistics windows follow the log clock, not the host clock).
+     */
+    void calculate(BoatDataStructure* boatData, uint32_t nowMs);
+
+    // =========================================================================
+    // Per-formula reference implementations (not used by calculate())
+    // =========================================================================
+
     /**
      * @brief Calculate AWA offset correction
      *
@@ -76,7 +144,7 @@ private:
      * @param offset Masthead offset from calibration (radians)
      * @return Corrected AWA (radians, [-π, π])
      */
-    double calculateAWAOffset(double awa, double offset);
+    BoatScalar calculateAWAOffset(BoatScalar awa, BoatScalar offset);
 
     /**
      * @brief Calculate AWA heel correction
@@ -92,7 +160,7 @@ private:
      * @param heel Heel angle (radians, positive = starboard)
      * @return Corrected AWA (radians, [-π, π])
      */
-    double calculateAWAHeel(double awaOffset, double heel);
+    BoatScalar calculateAWAHeel(BoatScalar awaOffset, BoatScalar heel);
 
     /**
      * @brief Calculate leeway angle
@@ -113,7 +181,7 @@ private:
      * @param K Leeway calibration factor
      * @return Leeway angle (radians, [-π/4, π/4])
      */
-    double calculateLeeway(double awaHeel, double heel, double boatSpeed, double K);
+    BoatScalar calculateLeeway(BoatScalar awaHeel, BoatScalar heel, BoatScalar boatSpeed, BoatScalar K);
 
     /**
      * @brief Calculate speed through water
@@ -127,7 +195,7 @@ private:
      * @param leeway Leeway angle (radians)
      * @return Speed through water (knots)
      */
-    double calculateSTW(double boatSpeed, double leeway);
+    BoatScalar calculateSTW(BoatScalar boatSpeed, BoatScalar leeway);
 
     /**
      * @brief Calculate true wind speed
@@ -148,7 +216,7 @@ private:
      * @param leeway Leeway angle (radians)
      * @return True wind speed (knots)
      */
-    double calculateTWS(double aws, double awaHeel, double stw, double boatSpeed, double leeway);
+    BoatScalar calculateTWS(BoatScalar aws, BoatScalar awaHeel, BoatScalar stw, BoatScalar boatSpeed, BoatScalar leeway);
 
     /**
      * @brief Calculate true wind angle
@@ -168,7 +236,7 @@ private:
      * @param awaHeel AWA corrected for heel (radians, for normalization)
      * @return True wind angle (radians, [-π, π])
      */
-    double calculateTWA(double tws_x, double tws_y, double awaHeel);
+    BoatScalar calculateTWA(BoatScalar tws_x, BoatScalar tws_y, BoatScalar awaHeel);
 
     /**
      * @brief Calculate wind direction
@@ -182,7 +250,7 @@ private:
      * @param twa True wind angle (radians)
      * @return Wind direction (radians, [0, 2π], magnetic)
      */
-    double calculateWDIR(double heading, double twa);
+    BoatScalar calculateWDIR(BoatScalar heading, BoatScalar twa);
 
     /**
      * @brief Calculate velocity made good
@@ -197,7 +265,7 @@ private:
      * @param leeway Leeway angle (radians)
      * @return VMG (knots, signed: positive = toward wind, negative = away)
      */
-    double calculateVMG(double stw, double twa, double leeway);
+    BoatScalar calculateVMG(BoatScalar stw, BoatScalar twa, BoatScalar leeway);
 
     /**
      * @brief Calculate current speed and direction
@@ -224,9 +292,104 @@ private:
      * @param outSOC Output: Speed of current (knots)
      * @param outDOC Output: Direction of current (radians, [0, 2π], magnetic)
      */
-    void calculateCurrent(double sog, double cog, double stw, double heading,
-                          double leeway, double variation,
-                          double& outSOC, double& outDOC);
+    void calculateCurrent(BoatScalar sog, BoatScalar cog, BoatScalar stw, BoatScalar heading,
+                          BoatScalar leeway, BoatScalar variation,
+                          BoatScalar& outSOC, BoatScalar& outDOC);
+
+private:
+    /**
+     * @brief Values shared between pipeline stages (one cycle)
+     *
+     * Every sine/cosine is computed once, by the stage that first needs it.
+     */
+    struct Intermediates {
+        // Aligned, damped inputs
+        BoatScalar awa;
+        BoatScalar aws;
+        BoatScalar boatSpeed;
+        BoatScalar heading;
+        BoatScalar heel;
+        BoatScalar sog;
+        BoatScalar cog;
+
+        BoatScalar sinAwaOffset;
+        BoatScalar cosAwaOffset;
+        BoatScalar cosHeel;
+        BoatScalar sinAwaHeel;
+        BoatScalar cosAwaHeel;
+        BoatScalar sinLeeway;
+        BoatScalar cosLeeway;
+        BoatScalar twsX;        ///< True wind vector, Cartesian (knots)
+        BoatScalar twsY;
+        BoatScalar sinTwa;
+        BoatScalar cosTwa;
+        BoatScalar sinHeading;
+        BoatScalar cosHeading;
+    };
+
+    /**
+     * @brief Alignment stage: sensor values at the reference time into @p im
+     */
+    void alignInputs(const BoatDataStructure* boatData, Intermediates& im);
+
+    /// Aligned @p input, or @p raw itself if it is not finite
+    BoatScalar alignedValue(AlignedInput input, uint32_t refMs, BoatScalar raw) const;
+
+    /**
+     * @brief Filter stage (inputs): damp the aligned values in @p im in place
+     */
+    void filterInputs(const BoatDataStructure* boatData, Intermediates& im, uint32_t nowMs);
+
+    /**
+     * @brief Filter stage (outputs): damp the computed derived values in place
+     */
+    void filterOutputs(BoatDataStructure* boatData, uint32_t nowMs);
+
+    /**
+     * @brief Stage 1: AWA offset and heel correction (derived.awaOffset, awaHeel)
+     *
+     * atan2(sin(awa) , cos(awa) * cos(heel)) equals the reference
+     * atan(tan(awa) / cos(heel)) with quadrant correction for the clamped
+     * heel range (cos(heel) >= 0), and yields sin/cos of awaHeel with one sqrt.
+     */
+    void stageApparentWind(BoatDataStructure* boatData, Intermediates& im);
+
+    /**
+     * @brief Stage 2: Leeway and STW (derived.leeway, stw)
+     */
+    void stageLeeway(BoatDataStructure* boatData, Intermediates& im);
+
+    /**
+     * @brief Stage 3: TWS, TWA, WDIR and VMG
+     *
+     * cos/sin(270° - x) = -sin/-cos(x), and sin/cos of TWA come from the
+     * normalized true wind vector, so this stage needs only sqrt and atan2.
+     */
+    void stageTrueWind(BoatDataStructure* boatData, Intermediates& im);
+
+    /**
+     * @brief Stage 4: Current speed and direction (derived.soc, doc)
+     *
+     * cos/sin(90° - x) = sin/cos(x); heading + leeway is expanded from the
+     * heading and leeway terms.
+     */
+    void stageCurrent(BoatDataStructure* boatData, Intermediates& im);
+
+    /**
+     * @brief Stage 5: Polar targets from the damped TWS/TWA and STW
+     */
+    void stagePolar(BoatDataStructure* boatData);
+
+    /**
+     * @brief Copy the scratch set into boatData->derived under its counter
+     */
+    void publish(BoatDataStructure* boatData);
+
+    InputAligner aligner_;
+    DampingFilters filters_;
+    DerivedStatistics stats_;
+    const PolarTable* polar_;   ///< nullptr = no polar
+    DerivedData scratch_;       ///< Set under construction (published by publish())
 };
 
 #endif // CALCULATION_ENGINE_H
@@ -0,0 +1,47 @@
+/**
+ * @file CalculationTimingWebServer.cpp
+ * @brief Implementation of the calculation cycle timing endpoint
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "CalculationTimingWebServer.h"
+
+CalculationTimingWebServer::CalculationTimingWebServer(CalculationTiming* calculationTiming, BoatData* boatDataInstance)
+    : timing(calculationTiming), boatData(boatDataInstance) {
+}
+
+void CalculationTimingWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || timing == nullptr) {
+        return;
+    }
+
+    // GET /calc/stats - Calculation cycle duration, period, jitter, deadline misses
+    server->on("/calc/stats", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetStats(request);
+    });
+}
+
+void CalculationTimingWebServer::handleGetStats(AsyncWebServerRequest* request) {
+    StaticJsonWriter<768> json;
+    if (!timing->writeStats(json)) {
+        request->send(500, "application/json", "{\"error\":\"stats too large\"}");
+        return;
+    }
+
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+    // Splice the DiagnosticData latency in before the closing brace
+    response->write(reinterpret_cast<const uint8_t*>(json.c_str()), json.length() - 1);
+    if (boatData != nullptr) {
+        DiagnosticData diag = boatData->getDiagnostics();
+        response->printf(",\"latency_us\":{\"last\":%lu,\"max\":%lu}",
+            (unsigned long)diag.lastCalculationLatency, (unsigned long)diag.maxCalculationLatency);
+    }
+    response->print('}');
+    request->send(response);
+
+    if (request->hasParam("reset") && request->getParam("reset")->value() == "1") {
+        timing->requestReset();
+    }
+}
@@ -0,0 +1,74 @@
+/**
+ * @file CalculationTimingWebServer.h
+ * @brief HTTP endpoint for the live calculation cycle timing
+ *
+ * Provides:
+ * - GET /calc/stats[?reset=1]: execution time, period and jitter
+ *   distributions of the calculation cycle, deadline misses against
+ *   CALC_DEADLINE_US, and the input-to-output latency from DiagnosticData;
+ *   reset=1 starts new statistics after this report
+ *
+ * Unlike /calc/benchmark this measures the running system, so it is
+ * always available.
+ *
+ * Constitutional Compliance:
+ * - Principle V (Network Debugging): cycle timing inspectable over WiFi
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CALCULATION_TIMING_WEB_SERVER_H
+#define CALCULATION_TIMING_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "BoatData.h"
+#include "../utils/CalculationTiming.h"
+
+/**
+ * @brief Web server route for the calculation cycle timing
+ */
+class CalculationTimingWebServer {
+private:
+    CalculationTiming* timing;
+    BoatData* boatData;
+
+    /**
+     * @brief Handle GET /calc/stats
+     *
+     * Returns:
+     * {
+     *   "deadline_us": 5000, "cycles": 9120, "deadline_misses": 2, "miss_pct": 0.02,
+     *   "duration": {"n": 9120, "min_us": 610, "avg_us": 702, "p50_us": 768,
+     *                "p95_us": 1024, "p99_us": 1536, "max_us": 6210},
+     *   "period": {...}, "jitter": {...},
+     *   "latency_us": {"last": 10820, "max": 48200}
+     * }
+     *
+     * Percentiles are LatencyHistogram bucket edges (within 50%).
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetStats(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param calculationTiming Statistics filled by calculateDerivedParameters()
+     * @param boatDataInstance Source of the calculation latency diagnostics
+     */
+    CalculationTimingWebServer(CalculationTiming* calculationTiming, BoatData* boatDataInstance);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // CALCULATION_TIMING_WEB_SERVER_H
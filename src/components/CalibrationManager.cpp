@@ -6,16 +6,35 @@
  */
 
 #include "CalibrationManager.h"
+#include "../utils/AtomicFile.h"
+#include "../utils/WriteBehind.h"
 
 const char* CalibrationManager::CALIBRATION_FILE = "/calibration.json";
 
-CalibrationManager::CalibrationManager() {
+namespace {
+
+const char* const CALIBRATION_RECORD_KEY = "calibration";
+const uint16_t CALIBRATION_RECORD_SCHEMA = 1;
+
+}  // namespace
+
+CalibrationManager::CalibrationManager(IConfigStore* store)
+    : pendingMux(portMUX_INITIALIZER_UNLOCKED),
+      store(store),
+      loadSource("defaults"),
+      recordStatus(ConfigRecordStatus::EMPTY) {
     // Initialize with defaults
     currentParams.leewayCalibrationFactor = DEFAULT_LEEWAY_K_FACTOR;
     currentParams.windAngleOffset = DEFAULT_WIND_ANGLE_OFFSET;
+    currentParams.damping = DampingConfig();
     currentParams.version = 1;
     currentParams.lastModified = 0;
     currentParams.valid = false;
+    pendingParams = currentParams;
+
+    persistEntry = GetWriteBehind().add("calibration", [](void* context) {
+        return static_cast<CalibrationManager*>(context)->savePending();
+    }, this);
 }
 
 // =============================================================================
@@ -50,10 +69,133 @@ bool CalibrationManager::validateCalibration(const CalibrationParameters& params
         return false;
     }
 
+    // Damping time constants must be in range [0, DAMPING_MAX_TIME_CONSTANT_S]
+    if (!validateDamping(params.damping)) {
+        return false;
+    }
+
     return true;
 }
 
+bool CalibrationManager::validateDamping(const DampingConfig& damping) {
+    for (uint8_t i = 0; i < DAMPING_FIELD_COUNT; i++) {
+        float tau = damping.timeConstant[i];
+        if (!(tau >= 0.0f && tau <= DAMPING_MAX_TIME_CONSTANT_S)) {
+            return false;  // Also rejects NaN
+        }
+    }
+    return true;
+}
+
+bool CalibrationManager::readDamping(JsonVariantConst in, DampingConfig& out) {
+    out = DampingConfig();
+    if (in.isNull()) {
+        return true;  // No damping configured - all off
+    }
+    if (!in.is<JsonObjectConst>()) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < DAMPING_FIELD_COUNT; i++) {
+        out.timeConstant[i] = in[DampingFilters::key(static_cast<DampingField>(i))] | 0.0f;
+    }
+
+    for (JsonVariantConst name : in["kalman"].as<JsonArrayConst>()) {
+        const char* key = name.as<const char*>();
+        for (uint8_t i = 0; key != nullptr && i < DAMPING_FIELD_COUNT; i++) {
+            DampingField field = static_cast<DampingField>(i);
+            if (strcmp(key, DampingFilters::key(field)) == 0 &&
+                DampingFilters::kind(field) == DAMPING_KIND_SCALAR) {
+                out.kalmanMask |= static_cast<uint16_t>(1u << i);
+            }
+        }
+    }
+    return true;
+}
+
+void CalibrationManager::writeDamping(JsonObject out, const DampingConfig& damping) {
+    for (uint8_t i = 0; i < DAMPING_FIELD_COUNT; i++) {
+        out[DampingFilters::key(static_cast<DampingField>(i))] = damping.timeConstant[i];
+    }
+    JsonArray kalman = out.createNestedArray("kalman");
+    for (uint8_t i = 0; i < DAMPING_FIELD_COUNT; i++) {
+        if (damping.kalmanMask & (1u << i)) {
+            kalman.add(DampingFilters::key(static_cast<DampingField>(i)));
+        }
+    }
+}
+
+size_t CalibrationManager::encodeRecord(const CalibrationParameters& params, uint8_t* out, size_t size) {
+    ConfigRecordWriter record(out, size);
+    record.putF64(params.leewayCalibrationFactor)
+        .putF64(params.windAngleOffset)
+        .putU8(DAMPING_FIELD_COUNT);
+    for (uint8_t i = 0; i < DAMPING_FIELD_COUNT; i++) {
+        record.putF32(params.damping.timeConstant[i]);
+    }
+    record.putU16(params.damping.kalmanMask)
+        .putU32(static_cast<uint32_t>(params.version))
+        .putU32(static_cast<uint32_t>(params.lastModified));
+    return record.finish(CALIBRATION_RECORD_SCHEMA);
+}
+
+ConfigRecordStatus CalibrationManager::decodeRecord(const uint8_t* record, size_t length, CalibrationParameters& out) {
+    ConfigRecordReader in(record, length);
+    uint16_t schema = 0;
+    ConfigRecordStatus status = in.open(schema);
+    if (status != ConfigRecordStatus::OK) {
+        return status;
+    }
+
+    // A newer schema only appends fields: its schema 1 prefix is read as usual
+    CalibrationParameters loaded;
+    loaded.leewayCalibrationFactor = in.getF64();
+    loaded.windAngleOffset = in.getF64();
+    loaded.damping = DampingConfig();
+    uint8_t fields = in.getU8();
+    for (uint8_t i = 0; i < fields; i++) {
+        float tau = in.getF32();
+        if (i < DAMPING_FIELD_COUNT) {
+            loaded.damping.timeConstant[i] = tau;  // Fields added later stay off
+        }
+    }
+    loaded.damping.kalmanMask = in.getU16() & static_cast<uint16_t>((1u << DAMPING_FIELD_COUNT) - 1);
+    loaded.version = in.getU32();
+    loaded.lastModified = in.getU32();
+    loaded.valid = true;
+
+    if (schema == 0 || !in.ok()) {
+        return ConfigRecordStatus::TRUNCATED;
+    }
+    out = loaded;
+    return ConfigRecordStatus::OK;
+}
+
 bool CalibrationManager::loadFromFlash() {
+    if (store != nullptr) {
+        uint8_t record[CONFIG_RECORD_MAX_BYTES];
+        size_t length = store->read(CALIBRATION_RECORD_KEY, record, sizeof(record));
+        CalibrationParameters loaded;
+        recordStatus = decodeRecord(record, length, loaded);
+        if (recordStatus == ConfigRecordStatus::OK && validateCalibration(loaded)) {
+            currentParams = loaded;
+            loadSource = "nvs";
+            return true;
+        }
+    }
+
+    // No usable record: the JSON file of earlier firmware (or the only storage without a store)
+    if (!loadFile()) {
+        return false;
+    }
+    loadSource = "file";
+    if (store != nullptr && writeRecord(currentParams)) {
+        LittleFS.remove(CALIBRATION_FILE);  // Imported: a stale file must not shadow later saves
+    }
+    return true;
+}
+
+bool CalibrationManager::loadFile() {
     // Check if file exists
     if (!LittleFS.exists(CALIBRATION_FILE)) {
         // File not found - keep defaults
@@ -67,7 +209,7 @@ bool CalibrationManager::loadFromFlash() {
     }
 
     // Parse JSON
-    StaticJsonDocument<256> doc;
+    StaticJsonDocument<CALIBRATION_JSON_CAPACITY> doc;
     DeserializationError error = deserializeJson(doc, file);
     file.close();
 
@@ -85,6 +227,11 @@ bool CalibrationManager::loadFromFlash() {
     double windAngleOffsetDegrees = doc["windAngleOffset"] | 0.0;
     loaded.windAngleOffset = windAngleOffsetDegrees * DEG_TO_RAD;
 
+    if (!readDamping(doc["damping"], loaded.damping)) {
+        // Malformed damping - keep defaults
+        return false;
+    }
+
     loaded.lastModified = doc["lastModified"] | 0;
     loaded.valid = true;
 
@@ -105,30 +252,48 @@ bool CalibrationManager::saveToFlash(const CalibrationParameters& params) {
     if (!validateCalibration(params)) {
         return false;
     }
+    if (persistEntry < 0) {
+        return store != nullptr ? writeRecord(params) : writeFile(params);
+    }
 
+    // Written by the write-behind reaction once the parameters stop changing
+    portENTER_CRITICAL(&pendingMux);
+    pendingParams = params;
+    portEXIT_CRITICAL(&pendingMux);
+    GetWriteBehind().markDirty(persistEntry, millis());
+    return true;
+}
+
+bool CalibrationManager::savePending() {
+    portENTER_CRITICAL(&pendingMux);
+    CalibrationParameters params = pendingParams;
+    portEXIT_CRITICAL(&pendingMux);
+    return store != nullptr ? writeRecord(params) : writeFile(params);
+}
+
+bool CalibrationManager::writeRecord(const CalibrationParameters& params) {
+    uint8_t record[CONFIG_RECORD_MAX_BYTES];
+    size_t length = encodeRecord(params, record, sizeof(record));
+    return length > 0 && store->write(CALIBRATION_RECORD_KEY, record, length);
+}
+
+bool CalibrationManager::writeFile(const CalibrationParameters& params) {
     // Create JSON document
-    StaticJsonDocument<256> doc;
+    StaticJsonDocument<CALIBRATION_JSON_CAPACITY> doc;
     doc["version"] = params.version;
     doc["leewayKFactor"] = params.leewayCalibrationFactor;
 
     // Convert windAngleOffset from radians (internal) to degrees (JSON)
     doc["windAngleOffset"] = params.windAngleOffset * RAD_TO_DEG;
 
-    doc["lastModified"] = params.lastModified;
-
-    // Open file for writing
-    File file = LittleFS.open(CALIBRATION_FILE, "w");
-    if (!file) {
-        return false;
-    }
+    writeDamping(doc.createNestedObject("damping"), params.damping);
 
-    // Serialize JSON to file
-    size_t bytesWritten = serializeJson(doc, file);
-    file.close();
+    doc["lastModified"] = params.lastModified;
 
-    if (bytesWritten == 0) {
+    // Write next to the file, replace it only once complete
+    AtomicFileWriter out(CALIBRATION_FILE);
+    if (!out.isOpen() || serializeJson(doc, out.file()) == 0) {
         return false;
     }
-
-    return true;
+    return out.commit();
 }
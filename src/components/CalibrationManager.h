@@ -3,12 +3,16 @@
  * @brief Calibration parameter management with LittleFS persistence
  *
  * This class implements the ICalibration interface, managing calibration
- * parameters (leeway K factor, wind angle offset) with persistence to flash
- * filesystem using LittleFS and ArduinoJson.
+ * parameters (leeway K factor, wind angle offset) with persistence to a
+ * binary NVS record (IConfigStore, ConfigRecord.h) or, without a store, to
+ * the LittleFS file using ArduinoJson.
  *
  * Features:
- * - Load from /calibration.json on LittleFS
- * - Save to /calibration.json with validation
+ * - Load the "calibration" NVS record (CRC checked, no parse); if there is
+ *   none, import /calibration.json once into NVS and delete the file
+ * - Save with validation, written behind (GetWriteBehind()): saveToFlash()
+ *   returns at once, the record (or file: temp file + rename) is replaced
+ *   once the parameters stopped changing for WRITE_BEHIND_QUIET_MS
  * - Default values if file missing (K=1.0, offset=0.0)
  * - Validation: K > 0, wind offset [-2π, 2π]
  * - Atomic updates (via ReactESP deferred callback)
@@ -23,26 +27,40 @@
 #define CALIBRATION_MANAGER_H
 
 #include "../hal/interfaces/ICalibration.h"
+#include "../hal/interfaces/IConfigStore.h"
 #include "../types/BoatDataTypes.h"
+#include "../utils/ConfigRecord.h"
+#include "../utils/DampingFilters.h"
+#include "../config.h"
 #include <LittleFS.h>
 #include <ArduinoJson.h>
+#include <freertos/FreeRTOS.h>
 
 /**
  * @brief Calibration parameter manager with persistence
  *
- * Manages calibration parameters with JSON persistence to LittleFS.
+ * Manages calibration parameters with binary persistence to NVS.
  *
- * File format (/calibration.json):
+ * NVS record "calibration" (schema 1, after the ConfigRecord header):
+ *   f64 leewayKFactor, f64 windAngleOffset (radians), u8 damping field count,
+ *   f32 time constant per field, u16 kalman mask, u32 version, u32 lastModified
+ *
+ * Legacy file format (/calibration.json, import and store-less builds):
  * {
  *   "version": 1,
  *   "leewayKFactor": 0.65,
  *   "windAngleOffset": 5.0,
+ *   "damping": { "awa": 2.0, "aws": 2.0, "boatSpeed": 3.0, "kalman": ["boatSpeed"] },
  *   "lastModified": 1696608000
  * }
  *
  * NOTE: windAngleOffset is stored in DEGREES in the JSON file for user convenience,
  * but converted to radians internally for calculations.
  *
+ * "damping" is optional: time constants in seconds per DampingField key
+ * (missing key = 0 = off), and "kalman" lists the scalar fields that use
+ * the Kalman filter instead of the EMA (see DampingConfig.h).
+ *
  * Usage:
  * @code
  * CalibrationManager calibMgr;
@@ -71,8 +89,9 @@ class CalibrationManager : public ICalibration {
 public:
     /**
      * @brief Constructor
+     * @param store NVS record store (nullptr: /calibration.json only)
      */
-    CalibrationManager();
+    explicit CalibrationManager(IConfigStore* store = nullptr);
 
     // =========================================================================
     // ICalibration IMPLEMENTATION
@@ -84,10 +103,66 @@ public:
     bool loadFromFlash() override;
     bool saveToFlash(const CalibrationParameters& params) override;
 
+    /**
+     * @brief Read a "damping" object into @p out (missing keys = off)
+     *
+     * @return false if @p in is present but not an object
+     */
+    static bool readDamping(JsonVariantConst in, DampingConfig& out);
+
+    /**
+     * @brief Write @p damping as a "damping" object into @p out
+     */
+    static void writeDamping(JsonObject out, const DampingConfig& damping);
+
+    /**
+     * @brief Check every time constant is in [0, DAMPING_MAX_TIME_CONSTANT_S]
+     */
+    static bool validateDamping(const DampingConfig& damping);
+
+    /**
+     * @brief Encode @p params as a "calibration" record
+     * @return Record length, 0 if @p size is too small
+     */
+    static size_t encodeRecord(const CalibrationParameters& params, uint8_t* out, size_t size);
+
+    /**
+     * @brief Decode a "calibration" record (not validated)
+     * @return OK if @p out holds the record
+     */
+    static ConfigRecordStatus decodeRecord(const uint8_t* record, size_t length, CalibrationParameters& out);
+
+    /// Where loadFromFlash() found the calibration: "nvs", "file" or "defaults"
+    const char* getLoadSource() const { return loadSource; }
+
+    /// Result of reading the NVS record at the last loadFromFlash()
+    ConfigRecordStatus getRecordStatus() const { return recordStatus; }
+
 private:
+    /// Write @p params to CALIBRATION_FILE (temp file + rename)
+    bool writeFile(const CalibrationParameters& params);
+
+    /// Write @p params to the NVS record
+    bool writeRecord(const CalibrationParameters& params);
+
+    /// Read CALIBRATION_FILE into currentParams
+    bool loadFile();
+
+    /// GetWriteBehind() save: the parameters of the latest saveToFlash()
+    bool savePending();
+
     // Current calibration parameters (in memory)
     CalibrationParameters currentParams;
 
+    // Parameters waiting for the deferred write (set on async_tcp, read on the main loop)
+    CalibrationParameters pendingParams;
+    portMUX_TYPE pendingMux;
+    int8_t persistEntry;  ///< GetWriteBehind() entry, -1 = table full (writes synchronously)
+
+    IConfigStore* store;
+    const char* loadSource;
+    ConfigRecordStatus recordStatus;
+
     // Calibration file path on LittleFS
     static const char* CALIBRATION_FILE;
 };
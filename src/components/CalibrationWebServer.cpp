@@ -6,10 +6,48 @@
  */
 
 #include "CalibrationWebServer.h"
+#include "../utils/ScratchJson.h"
 #include <math.h>
 
+namespace {
+
+const char* const SCRATCH_EXHAUSTED = "{\"status\":\"error\",\"message\":\"Scratch memory exhausted\"}";
+
+}  // namespace
+
 CalibrationWebServer::CalibrationWebServer(CalibrationManager* calibMgr, BoatData* boat)
-    : calibrationManager(calibMgr), boatData(boat) {
+    : calibrationManager(calibMgr), boatData(boat), learner(nullptr) {
+    GetConfigService().subscribe(ConfigDomain::CALIBRATION, "calibration", applyCalibration, this);
+}
+
+void CalibrationWebServer::applyToBoatData(const CalibrationParameters& params, BoatData* boat) {
+    CalibrationData boatCalib;
+    boatCalib.leewayCalibrationFactor = params.leewayCalibrationFactor;
+    boatCalib.windAngleOffset = params.windAngleOffset;
+    boatCalib.damping = params.damping;
+    boatCalib.loaded = true;
+    boat->setCalibration(boatCalib);
+}
+
+ConfigApplyResult CalibrationWebServer::applyCalibration(void* context, uint32_t version) {
+    (void)version;
+    CalibrationWebServer* self = static_cast<CalibrationWebServer*>(context);
+    CalibrationParameters params;
+    bool busy = false;
+    if (!self->stage.take(params, busy)) {
+        if (busy) {
+            return ConfigApplyResult::BUSY;
+        }
+        // Reload request: the file as written last
+        if (!self->calibrationManager->loadFromFlash()) {
+            return ConfigApplyResult::REJECTED;  // Missing or invalid: the running calibration stays
+        }
+        params = self->calibrationManager->getCalibration();
+    } else if (!self->calibrationManager->setCalibration(params)) {
+        return ConfigApplyResult::REJECTED;
+    }
+    applyToBoatData(params, self->boatData);
+    return ConfigApplyResult::APPLIED;
 }
 
 void CalibrationWebServer::registerRoutes(AsyncWebServer* server) {
@@ -17,6 +55,21 @@ void CalibrationWebServer::registerRoutes(AsyncWebServer* server) {
         return;
     }
 
+    // Longer paths first: /api/calibration also matches its subpaths
+    if (learner != nullptr) {
+        server->on("/api/calibration/learned/apply", HTTP_POST, [this](AsyncWebServerRequest* request) {
+            this->handleApplyLearned(request);
+        });
+        server->on("/api/calibration/learned/reset", HTTP_POST, [this](AsyncWebServerRequest* request) {
+            learner->requestReset();
+            request->send(200, "application/json",
+                "{\"status\":\"success\",\"message\":\"Learned statistics reset\"}");
+        });
+        server->on("/api/calibration/learned", HTTP_GET, [this](AsyncWebServerRequest* request) {
+            this->handleGetLearned(request);
+        });
+    }
+
     // GET /api/calibration - Retrieve current calibration
     server->on("/api/calibration", HTTP_GET, [this](AsyncWebServerRequest* request) {
         this->handleGetCalibration(request);
@@ -39,15 +92,27 @@ void CalibrationWebServer::handleGetCalibration(AsyncWebServerRequest* request)
     // Get current calibration
     CalibrationParameters calib = calibrationManager->getCalibration();
 
+    // Document and response body live until the handler returns
+    ScratchScope scratch(GetHttpArena());
+    ScratchJsonDocument doc(CALIBRATION_JSON_CAPACITY, ScratchJsonAllocator(&scratch.arena()));
+    char* response = scratch.arena().allocArray<char>(CALIBRATION_JSON_CAPACITY);
+    if (doc.capacity() == 0 || response == nullptr) {
+        request->send(503, "application/json", SCRATCH_EXHAUSTED);
+        return;
+    }
+
     // Build JSON response
-    StaticJsonDocument<256> doc;
     doc["leewayKFactor"] = calib.leewayCalibrationFactor;
     doc["windAngleOffset"] = calib.windAngleOffset;
+    CalibrationManager::writeDamping(doc.createNestedObject("damping"), calib.damping);
     doc["valid"] = calib.valid;
     doc["lastModified"] = calib.lastModified;
 
-    String response;
-    serializeJson(doc, response);
+    if (measureJson(doc) >= CALIBRATION_JSON_CAPACITY) {
+        request->send(500, "application/json", "{\"status\":\"error\",\"message\":\"Response too large\"}");
+        return;
+    }
+    serializeJson(doc, response, CALIBRATION_JSON_CAPACITY);
 
     request->send(200, "application/json", response);
 }
@@ -58,8 +123,14 @@ void CalibrationWebServer::handlePostCalibration(AsyncWebServerRequest* request,
         return;  // Wait for complete data
     }
 
+    ScratchScope scratch(GetHttpArena());
+    ScratchJsonDocument doc(CALIBRATION_JSON_CAPACITY, ScratchJsonAllocator(&scratch.arena()));
+    if (doc.capacity() == 0) {
+        request->send(503, "application/json", SCRATCH_EXHAUSTED);
+        return;
+    }
+
     // Parse JSON
-    StaticJsonDocument<256> doc;
     DeserializationError error = deserializeJson(doc, data, len);
 
     if (error) {
@@ -93,10 +164,22 @@ void CalibrationWebServer::handlePostCalibration(AsyncWebServerRequest* request,
         return;
     }
 
+    // Damping is optional - keep the current settings when absent
+    DampingConfig damping = calibrationManager->getCalibration().damping;
+    if (doc.containsKey("damping")) {
+        if (!CalibrationManager::readDamping(doc["damping"], damping) ||
+            !CalibrationManager::validateDamping(damping)) {
+            request->send(400, "application/json",
+                "{\"status\":\"error\",\"message\":\"damping time constants must be in range [0, 60] s\"}");
+            return;
+        }
+    }
+
     // Create new calibration parameters
     CalibrationParameters newCalib;
     newCalib.leewayCalibrationFactor = kFactor;
     newCalib.windAngleOffset = windOffset;
+    newCalib.damping = damping;
     newCalib.valid = true;
     newCalib.version = 1;
     newCalib.lastModified = millis() / 1000;
@@ -108,15 +191,6 @@ void CalibrationWebServer::handlePostCalibration(AsyncWebServerRequest* request,
         return;
     }
 
-    // Apply atomically to BoatData (during calculation cycle pause)
-    // Note: In ReactESP single-threaded model, this is atomic by design
-    // Convert CalibrationParameters to CalibrationData for BoatData
-    CalibrationData boatCalib;
-    boatCalib.leewayCalibrationFactor = newCalib.leewayCalibrationFactor;
-    boatCalib.windAngleOffset = newCalib.windAngleOffset;
-    boatCalib.loaded = true;
-    boatData->setCalibration(boatCalib);
-
     // Persist to flash
     if (!calibrationManager->saveToFlash(newCalib)) {
         request->send(500, "application/json",
@@ -124,15 +198,124 @@ void CalibrationWebServer::handlePostCalibration(AsyncWebServerRequest* request,
         return;
     }
 
-    // Success response
-    StaticJsonDocument<256> responseDoc;
-    responseDoc["status"] = "success";
-    responseDoc["message"] = "Calibration updated and saved";
-    responseDoc["leewayKFactor"] = kFactor;
-    responseDoc["windAngleOffset"] = windOffset;
+    // Applied by the main loop, between calculation cycles (this handler runs on async_tcp)
+    if (!stage.stage(newCalib)) {
+        request->send(503, "application/json",
+            "{\"status\":\"error\",\"message\":\"Calibration busy, retry\"}");
+        return;
+    }
+    uint32_t version = GetConfigService().publish(ConfigDomain::CALIBRATION);
+
+    // Success response: the request document is no longer needed, reuse its pool
+    doc.clear();
+    doc["status"] = "success";
+    doc["message"] = "Calibration updated and saved";
+    doc["leewayKFactor"] = kFactor;
+    doc["windAngleOffset"] = windOffset;
+    doc["version"] = version;
+
+    char* response = scratch.arena().allocArray<char>(256);  // Fixed keys, two numbers: always fits
+    if (response == nullptr) {
+        request->send(503, "application/json", SCRATCH_EXHAUSTED);
+        return;
+    }
+    serializeJson(doc, response, 256);
+
+    request->send(200, "application/json", response);
+}
+
+bool CalibrationWebServer::applyLearned(const CalibrationProposal& proposal, uint8_t fields) {
+    CalibrationParameters params = calibrationManager->getCalibration();
+    if ((fields & LearnedField::WIND_OFFSET) && proposal.windOffsetReady) {
+        params.windAngleOffset = proposal.windAngleOffset;
+    } else {
+        fields &= ~LearnedField::WIND_OFFSET;
+    }
+    if ((fields & LearnedField::LEEWAY_K) && proposal.leewayReady) {
+        params.leewayCalibrationFactor = proposal.leewayK;
+    } else {
+        fields &= ~LearnedField::LEEWAY_K;
+    }
+    if (fields == 0) {
+        return false;
+    }
+    params.valid = true;
+    params.lastModified = millis() / 1000;
+
+    if (!calibrationManager->validateCalibration(params) || !calibrationManager->saveToFlash(params) ||
+        !stage.stage(params)) {
+        return false;
+    }
+    GetConfigService().publish(ConfigDomain::CALIBRATION);
+    return true;
+}
+
+void CalibrationWebServer::handleGetLearned(AsyncWebServerRequest* request) {
+    CalibrationProposal proposal;
+    if (!learner->readProposal(proposal)) {
+        request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Learner busy, retry\"}");
+        return;
+    }
+    CalibrationParameters calib = calibrationManager->getCalibration();
+
+    ScratchScope scratch(GetHttpArena());
+    ScratchJsonDocument doc(CALIBRATION_JSON_CAPACITY, ScratchJsonAllocator(&scratch.arena()));
+    char* response = scratch.arena().allocArray<char>(CALIBRATION_JSON_CAPACITY);
+    if (doc.capacity() == 0 || response == nullptr) {
+        request->send(503, "application/json", SCRATCH_EXHAUSTED);
+        return;
+    }
+
+    // NaN (not enough samples yet) serializes as null
+    JsonObject wind = doc.createNestedObject("windAngleOffset");
+    wind["ready"] = proposal.windOffsetReady;
+    wind["proposed"] = proposal.windAngleOffset;
+    wind["current"] = calib.windAngleOffset;
+    wind["twdSplit"] = proposal.twdSplit;
+    wind["port"] = proposal.portSamples;
+    wind["starboard"] = proposal.starboardSamples;
+
+    JsonObject leeway = doc.createNestedObject("leewayKFactor");
+    leeway["ready"] = proposal.leewayReady;
+    leeway["proposed"] = proposal.leewayK;
+    leeway["current"] = calib.leewayCalibrationFactor;
+    leeway["fit"] = proposal.leewayFit;
+    leeway["currentSet"] = proposal.leewayCurrent;
+    leeway["portHeel"] = proposal.portHeelSamples;
+    leeway["starboardHeel"] = proposal.starboardHeelSamples;
+
+    doc["samples"] = proposal.samples;
+    doc["accepted"] = proposal.accepted;
+    doc["autoApply"] = CALIB_LEARN_AUTO_APPLY != 0;
+
+    serializeJson(doc, response, CALIBRATION_JSON_CAPACITY);
+    request->send(200, "application/json", response);
+}
 
-    String response;
-    serializeJson(responseDoc, response);
+void CalibrationWebServer::handleApplyLearned(AsyncWebServerRequest* request) {
+    CalibrationProposal proposal;
+    if (!learner->readProposal(proposal)) {
+        request->send(503, "application/json", "{\"status\":\"error\",\"message\":\"Learner busy, retry\"}");
+        return;
+    }
+    if (!proposal.windOffsetReady && !proposal.leewayReady) {
+        request->send(409, "application/json",
+            "{\"status\":\"error\",\"message\":\"No learned calibration ready\"}");
+        return;
+    }
+    if (!applyLearned(proposal, LearnedField::WIND_OFFSET | LearnedField::LEEWAY_K)) {
+        request->send(503, "application/json",
+            "{\"status\":\"error\",\"message\":\"Calibration busy or invalid, retry\"}");
+        return;
+    }
 
+    char response[160];
+    CalibrationParameters calib = calibrationManager->getCalibration();
+    snprintf(response, sizeof(response),
+             "{\"status\":\"success\",\"windAngleOffset\":%.4f,\"leewayKFactor\":%.3f,"
+             "\"windApplied\":%s,\"leewayApplied\":%s}",
+             proposal.windOffsetReady ? proposal.windAngleOffset : calib.windAngleOffset,
+             proposal.leewayReady ? proposal.leewayK : calib.leewayCalibrationFactor,
+             proposal.windOffsetReady ? "true" : "false", proposal.leewayReady ? "true" : "false");
     request->send(200, "application/json", response);
 }
@@ -5,10 +5,18 @@
  * Provides HTTP API endpoints for calibration parameters:
  * - GET /api/calibration: Retrieve current calibration parameters
  * - POST /api/calibration: Update calibration parameters
+ * - GET /api/calibration/learned: CalibrationLearner proposal and statistics
+ * - POST /api/calibration/learned/apply: Apply the ready learned values
+ * - POST /api/calibration/learned/reset: Forget the learned statistics
  *
  * Uses ESPAsyncWebServer for non-blocking HTTP handling.
  * Integrates with CalibrationManager for persistence.
  *
+ * A validated POST is saved (write-behind) and published to the
+ * ConfigService; the main loop applies it to BoatData and the
+ * CalibrationManager, so the calculation cycle never sees a half-copied
+ * calibration.
+ *
  * @see specs/003-boatdata-feature-as/tasks.md T039
  * @version 1.0.0
  * @date 2025-10-07
@@ -23,6 +31,8 @@
 #include "CalibrationManager.h"
 #include "BoatData.h"
 #include "../config.h"
+#include "../utils/ConfigService.h"
+#include "../utils/CalibrationLearner.h"
 
 /**
  * @brief Web server for calibration parameter API
@@ -34,6 +44,8 @@ class CalibrationWebServer {
 private:
     CalibrationManager* calibrationManager;
     BoatData* boatData;
+    ConfigStage<CalibrationParameters> stage;   ///< Validated POST, applied by the main loop
+    CalibrationLearner* learner;                ///< nullptr = no /api/calibration/learned routes
 
     /**
      * @brief Handle GET /api/calibration
@@ -72,9 +84,36 @@ private:
      */
     void handlePostCalibration(AsyncWebServerRequest* request, uint8_t* json, size_t len, size_t index, size_t total);
 
+    /**
+     * @brief Handle GET /api/calibration/learned
+     *
+     * {"windAngleOffset":{"ready":true,"proposed":0.037,"current":0.0,"twdSplit":0.024,
+     *  "port":240,"starboard":310},
+     *  "leewayKFactor":{"ready":false,"proposed":0.82,"current":1.0,"fit":0.31,
+     *  "currentSet":0.011,"portHeel":90,"starboardHeel":150},
+     *  "samples":3600,"accepted":1450,"autoApply":false}
+     *
+     * Angles in radians, like GET /api/calibration ("currentSet": COG offset
+     * of the water current, the regression intercept); null until both
+     * tacks have samples.
+     */
+    void handleGetLearned(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle POST /api/calibration/learned/apply: ready fields replace the current ones
+     *
+     * Returns 200 with the applied values, 409 if no learned value is ready.
+     */
+    void handleApplyLearned(AsyncWebServerRequest* request);
+
+    /**
+     * @brief ConfigService CALIBRATION apply (main loop): the staged POST, else the calibration file
+     */
+    static ConfigApplyResult applyCalibration(void* context, uint32_t version);
+
 public:
     /**
-     * @brief Constructor
+     * @brief Constructor (subscribes the CALIBRATION configuration domain)
      *
      * @param calibMgr Calibration manager instance
      * @param boat BoatData instance (for atomic updates)
@@ -90,6 +129,29 @@ public:
      * @param server Existing AsyncWebServer instance (from ConfigWebServer)
      */
     void registerRoutes(AsyncWebServer* server);
+
+    /**
+     * @brief Serve the proposals of @p calibrationLearner (call before registerRoutes())
+     */
+    void setLearner(CalibrationLearner* calibrationLearner) { learner = calibrationLearner; }
+
+    /**
+     * @brief Save and publish the LearnedField @p fields of @p proposal
+     *
+     * Same path as POST /api/calibration: validated, saved (write-behind)
+     * and applied to BoatData by the main loop. Any task (HTTP handler,
+     * CALIB_LEARN_AUTO_APPLY on the main loop).
+     *
+     * @return false if nothing was applied (no field, invalid, save or stage failed)
+     */
+    bool applyLearned(const CalibrationProposal& proposal, uint8_t fields);
+
+    /**
+     * @brief Install @p params in @p boat (CalibrationParameters to CalibrationData)
+     *
+     * Main loop only (boot, ConfigService CALIBRATION apply).
+     */
+    static void applyToBoatData(const CalibrationParameters& params, BoatData* boat);
 };
 
 #endif // CALIBRATION_WEB_SERVER_H
@@ -0,0 +1,89 @@
+/**
+ * @file ChunkedJsonResponder.cpp
+ * @brief Implementation of the chunked JSON response pool
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "ChunkedJsonResponder.h"
+
+ChunkedJsonResponder::ChunkedJsonResponder() : refused_(0), overflows_(0) {
+    for (uint8_t i = 0; i < CHUNKED_JSON_STREAMS; i++) {
+        slots_[i].busy = false;
+        slots_[i].generation = 0;
+        slots_[i].lastReadMs = 0;
+    }
+}
+
+ChunkedJsonResponder::Slot* ChunkedJsonResponder::acquire(uint32_t nowMs) {
+    for (uint8_t i = 0; i < CHUNKED_JSON_STREAMS; i++) {
+        if (slots_[i].busy && nowMs - slots_[i].lastReadMs >= CHUNKED_JSON_STALE_MS) {
+            release(&slots_[i]);  // Client went away mid-document
+        }
+        if (!slots_[i].busy) {
+            return &slots_[i];
+        }
+    }
+    return nullptr;
+}
+
+void ChunkedJsonResponder::release(Slot* slot) {
+    slot->busy = false;
+    slot->generation++;
+}
+
+bool ChunkedJsonResponder::send(AsyncWebServerRequest* request, ChunkedJsonGenerator generator,
+                                void* context) {
+    uint32_t now = millis();
+    Slot* slot = acquire(now);
+    if (slot == nullptr) {
+        refused_++;
+        AsyncWebServerResponse* response = request->beginResponse(503, "application/json",
+            "{\"status\":\"error\",\"message\":\"Server busy\"}");
+        response->addHeader("Retry-After", "1");
+        request->send(response);
+        return false;
+    }
+
+    slot->busy = true;
+    slot->lastReadMs = now;
+    slot->stream.begin(generator, context);
+    uint32_t generation = slot->generation;
+
+    AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+        [this, slot, generation](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            return fill(slot, generation, buffer, maxLen);
+        });
+    response->addHeader("Cache-Control", "no-store");
+    request->send(response);
+    return true;
+}
+
+size_t ChunkedJsonResponder::fill(Slot* slot, uint32_t generation, uint8_t* buffer, size_t maxLen) {
+    if (slot->generation != generation) {
+        return 0;  // Reclaimed as stale: the slot serves another request now
+    }
+    slot->lastReadMs = millis();
+    size_t n = slot->stream.read(reinterpret_cast<char*>(buffer), maxLen);
+    if (slot->stream.isComplete()) {
+        if (slot->stream.overflowed()) {
+            overflows_++;
+        }
+        release(slot);
+    }
+    return n;
+}
+
+uint8_t ChunkedJsonResponder::getInUse() const {
+    uint8_t inUse = 0;
+    for (uint8_t i = 0; i < CHUNKED_JSON_STREAMS; i++) {
+        inUse += slots_[i].busy ? 1 : 0;
+    }
+    return inUse;
+}
+
+ChunkedJsonResponder& GetChunkedJsonResponder() {
+    static ChunkedJsonResponder chunkedJsonResponder;
+    return chunkedJsonResponder;
+}
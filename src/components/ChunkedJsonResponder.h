@@ -0,0 +1,86 @@
+/**
+ * @file ChunkedJsonResponder.h
+ * @brief Chunked JSON responses on AsyncWebServer from a generator callback
+ *
+ * send() answers a request with beginChunkedResponse(): the library asks
+ * for the next chunk whenever the TCP window has room, and the
+ * ChunkedJsonStream of the request runs the generator for as many pieces
+ * as fit. Nothing is buffered beyond one piece, so the body can be larger
+ * than any buffer of the gateway.
+ *
+ * The streams are static (CHUNKED_JSON_STREAMS): a request while all of
+ * them are in use is answered 503 + Retry-After. A stream is released when
+ * its document is complete. request->onDisconnect() is left to the request
+ * middleware (completion timing), so a client that goes away mid-document
+ * is noticed by age instead: a stream not read for CHUNKED_JSON_STALE_MS is
+ * reclaimed, and the generation check keeps a late chunk callback of the
+ * old response from reading the new document.
+ *
+ * All calls on the async_tcp task.
+ *
+ * Usage pattern:
+ * @code
+ * server->on("/config", HTTP_GET, [this](AsyncWebServerRequest* request) {
+ *     GetChunkedJsonResponder().send(request, writeConfigStep, this);
+ * });
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed stream pool, no body buffer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CHUNKED_JSON_RESPONDER_H
+#define CHUNKED_JSON_RESPONDER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../utils/ChunkedJsonStream.h"
+
+/**
+ * @class ChunkedJsonResponder
+ * @brief Pool of ChunkedJsonStreams serving chunked responses
+ */
+class ChunkedJsonResponder {
+public:
+    ChunkedJsonResponder();
+
+    /**
+     * @brief Answer @p request with the document of @p generator (200, application/json)
+     * @param context Passed to every step; must outlive the response (a component, not a local)
+     * @return false if every stream was in use (503 sent instead)
+     */
+    bool send(AsyncWebServerRequest* request, ChunkedJsonGenerator generator, void* context);
+
+    /// Streams currently serving a response
+    uint8_t getInUse() const;
+
+    /// Requests answered 503 because every stream was in use
+    uint32_t getRefused() const { return refused_; }
+
+    /// Documents cut short by a step larger than CHUNKED_JSON_PIECE_BYTES
+    uint32_t getOverflows() const { return overflows_; }
+
+private:
+    struct Slot {
+        ChunkedJsonStream stream;
+        bool busy;
+        uint32_t generation;    ///< Incremented on every release (stale chunk callbacks)
+        uint32_t lastReadMs;
+    };
+
+    Slot slots_[CHUNKED_JSON_STREAMS];
+    uint32_t refused_;
+    uint32_t overflows_;
+
+    Slot* acquire(uint32_t nowMs);
+    size_t fill(Slot* slot, uint32_t generation, uint8_t* buffer, size_t maxLen);
+    void release(Slot* slot);
+};
+
+/// Process-wide responder (async_tcp task)
+ChunkedJsonResponder& GetChunkedJsonResponder();
+
+#endif // CHUNKED_JSON_RESPONDER_H
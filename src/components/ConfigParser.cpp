@@ -60,9 +60,10 @@ bool ConfigParser::parseFile(const String& fileContent, WiFiConfigFile& config)
     int lineEnd = 0;
     int linesParsed = 0;
     int validNetworks = 0;
+    bool lastAdded = false;  // "@ip" applies to the network line right above
 
     // Process lines until end of file or max networks reached
-    while (lineStart < fileContent.length() && validNetworks < MAX_NETWORKS) {
+    while (lineStart < fileContent.length()) {
         // Find end of line (handle both LF and CRLF)
         lineEnd = fileContent.indexOf('\n', lineStart);
         if (lineEnd == -1) {
@@ -80,6 +81,23 @@ bool ConfigParser::parseFile(const String& fileContent, WiFiConfigFile& config)
         // Trim whitespace
         line = trimWhitespace(line);
 
+        if (line.startsWith("@ip ") && line.indexOf(',') < 0) {
+            if (!lastAdded) {
+                lastError = F("Static IP without a network above it");
+                errorCount++;
+            } else if (!WiFiParseStaticIP(line.c_str() + 4, config.networks[config.count - 1].staticIP)) {
+                lastError = F("Invalid static IP (expected: @ip <ip> <subnet> <gateway> [<dns>])");
+                errorCount++;
+            }
+            lastAdded = false;
+            lineStart = lineEnd + 1;
+            continue;
+        }
+
+        if (line.length() > 0 && validNetworks >= MAX_NETWORKS) {
+            break;
+        }
+
         // Parse line if not empty
         if (line.length() > 0) {
             WiFiCredentials creds;
@@ -87,7 +105,8 @@ bool ConfigParser::parseFile(const String& fileContent, WiFiConfigFile& config)
             // Store current error count
             int prevErrorCount = errorCount;
 
-            if (parseLine(line, creds)) {
+            lastAdded = parseLine(line, creds);
+            if (lastAdded) {
                 // Valid line - add to config
                 config.addNetwork(creds);
                 validNetworks++;
@@ -8,9 +8,12 @@
  * File format:
  *   SSID1,password1
  *   SSID2,password2
+ *   @ip 192.168.1.50 255.255.255.0 192.168.1.1
  *   SSID3,
  *
- * Maximum 3 lines enforced. Lines exceeding limit are ignored.
+ * Maximum 3 networks enforced. Lines exceeding limit are ignored.
+ * An "@ip <ip> <subnet> <gateway> [<dns>]" line sets a static address for
+ * the network on the line above it (see WiFiParseStaticIP()).
  */
 
 #ifndef CONFIG_PARSER_H
@@ -60,7 +63,9 @@ public:
      * @return true if at least one valid network was parsed
      *
      * Behavior:
-     * - Processes max 3 lines
+     * - Processes max 3 network lines
+     * - "@ip" lines apply to the valid network right above them; a bad
+     *   address is an error and leaves that network on DHCP
      * - Invalid lines are skipped (logged as errors)
      * - Valid lines are added to config
      * - Returns true if ANY valid networks found
@@ -4,14 +4,32 @@
  */
 
 #include "ConfigWebServer.h"
+#include "ChunkedJsonResponder.h"
+#include "../utils/ScratchArena.h"
+#include "../utils/OtaUpdate.h"
+
+namespace {
+
+// Response bodies are taken from the HTTP scratch arena (released when the handler returns)
+constexpr size_t UPLOAD_RESPONSE_BYTES = 256;
+constexpr size_t SERVICE_RESPONSE_BYTES = 512;
+
+const char* const ROUTES_UPLOAD_PATH = NMEA0183_ROUTES_FILE NMEA0183_ROUTES_UPLOAD_SUFFIX;
+
+const char* const SCRATCH_EXHAUSTED = "{\"status\":\"error\",\"message\":\"Scratch memory exhausted\"}";
+
+}  // namespace
 
 ConfigWebServer::ConfigWebServer(WiFiManager* mgr, WiFiConfigFile* cfg, WiFiConnectionState* st, int port)
     : wifiManager(mgr),
       config(cfg),
       state(st),
+      apFallback(nullptr),
       rebootScheduled(false),
-      rebootTime(0) {
+      rebootTime(0),
+      routesUploadBytes(0) {
     server = new AsyncWebServer(port);
+    GetConfigService().subscribe(ConfigDomain::WIFI, "wifi", applyWiFiConfig, this);
 }
 
 ConfigWebServer::~ConfigWebServer() {
@@ -60,6 +78,32 @@ void ConfigWebServer::setupRoutes() {
     server->on("/wifi-status", HTTP_GET, [this](AsyncWebServerRequest* request) {
         handleGetStatus(request);
     });
+
+    // POST /upload-nmea0183-routes - Upload routing file (response sent by the upload handler)
+    server->on("/upload-nmea0183-routes", HTTP_POST,
+        [](AsyncWebServerRequest* request) {},
+        [this](AsyncWebServerRequest* request, const String& filename, size_t index, uint8_t* data, size_t len, bool final) {
+            handleRoutesUpload(request, filename, index, data, len, final);
+        }
+    );
+
+    // GET /config - Versions of the live configuration domains
+    server->on("/config", HTTP_GET, [](AsyncWebServerRequest* request) {
+        ScratchScope scratch(GetHttpArena());
+        char* body = scratch.arena().allocArray<char>(SERVICE_RESPONSE_BYTES);
+        if (body == nullptr) {
+            request->send(503, "application/json", SCRATCH_EXHAUSTED);
+            return;
+        }
+        JsonWriter response(body, SERVICE_RESPONSE_BYTES);
+        GetConfigService().writeJson(response);
+        request->send(200, "application/json", response.c_str());
+    });
+
+    // POST /config/reload?domain=<name> - Re-apply a domain from flash
+    server->on("/config/reload", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        handleReload(request);
+    });
 }
 
 // ============================================================================
@@ -68,101 +112,235 @@ void ConfigWebServer::setupRoutes() {
 
 void ConfigWebServer::handleUpload(AsyncWebServerRequest* request, const String& filename,
                                    size_t index, uint8_t* data, size_t len, bool final) {
-    static String uploadBuffer;
+    static FixedString<WIFI_CONFIG_MAX_BYTES + 1> uploadBuffer;  // No per-chunk reallocation
 
     // First chunk - initialize buffer
     if (index == 0) {
-        uploadBuffer = "";
+        uploadBuffer.clear();
     }
 
     // Append data to buffer
-    for (size_t i = 0; i < len; i++) {
-        uploadBuffer += (char)data[i];
-    }
+    uploadBuffer.append(reinterpret_cast<const char*>(data), len);
 
     // Final chunk - process complete upload
     if (final) {
+        ScratchScope scratch(GetHttpArena());
+        char* body = scratch.arena().allocArray<char>(UPLOAD_RESPONSE_BYTES);
+        if (body == nullptr) {
+            request->send(503, "application/json", SCRATCH_EXHAUSTED);
+            uploadBuffer.clear();
+            return;
+        }
+        JsonWriter response(body, UPLOAD_RESPONSE_BYTES);
+
+        if (uploadBuffer.truncated()) {
+            char error[48];
+            snprintf(error, sizeof(error), "File larger than %d bytes", WIFI_CONFIG_MAX_BYTES);
+            buildErrorResponse(response, "Invalid configuration file", error);
+            request->send(400, "application/json", response.c_str());
+            uploadBuffer.clear();
+            return;
+        }
+
         // Parse uploaded config
         WiFiConfigFile newConfig;
         ConfigParser parser;
 
-        bool parseResult = parser.parseFile(uploadBuffer, newConfig);
+        bool parseResult = parser.parseFile(String(uploadBuffer.c_str()), newConfig);
 
         if (!parseResult || newConfig.isEmpty()) {
             // Parse failed or no valid networks
-            String errors = "{\"errors\":[\"" + parser.getLastError() + "\"]}";
-            String response = buildErrorResponse("Invalid configuration file", errors);
-            request->send(400, "application/json", response);
-            uploadBuffer = "";
+            buildErrorResponse(response, "Invalid configuration file", parser.getLastError().c_str());
+            request->send(400, "application/json", response.c_str());
+            uploadBuffer.clear();
             return;
         }
 
         // Validate all networks
         for (int i = 0; i < newConfig.count; i++) {
             if (!newConfig.networks[i].isValid()) {
-                String error = "Line " + String(i + 1) + ": " + newConfig.networks[i].getValidationError();
-                String errors = "{\"errors\":[\"" + error + "\"]}";
-                String response = buildErrorResponse("Invalid configuration file", errors);
-                request->send(400, "application/json", response);
-                uploadBuffer = "";
+                char error[96];
+                snprintf(error, sizeof(error), "Line %d: %s", i + 1,
+                         newConfig.networks[i].getValidationError().c_str());
+                buildErrorResponse(response, "Invalid configuration file", error);
+                request->send(400, "application/json", response.c_str());
+                uploadBuffer.clear();
                 return;
             }
         }
 
-        // Save configuration
+        // Save configuration, then hand it to the main loop (which owns *config and *state)
         if (wifiManager->saveConfig(newConfig)) {
-            // Update current config reference
-            *config = newConfig;
-
-            // Schedule reboot
-            scheduleReboot(REBOOT_DELAY_MS);
+            wifiStage.stage(newConfig);  // Slot busy: the apply re-reads the file just saved
+            uint32_t version = GetConfigService().publish(ConfigDomain::WIFI);
 
             // Build success response
-            String response = "{";
-            response += "\"status\":\"success\",";
-            response += "\"message\":\"Configuration uploaded successfully. Device will reboot in 5 seconds.\",";
-            response += "\"networks_count\":" + String(newConfig.count);
-            response += "}";
-
-            request->send(200, "application/json", response);
+            response.beginObject()
+                .add("status", "success")
+                .add("message", "Configuration uploaded successfully. Applying without reboot.")
+                .add("networks_count", newConfig.count)
+                .add("version", (unsigned long)version)
+                .endObject();
+
+            request->send(200, "application/json", response.c_str());
         } else {
-            String response = buildErrorResponse("Failed to save configuration");
-            request->send(500, "application/json", response);
+            buildErrorResponse(response, "Failed to save configuration");
+            request->send(500, "application/json", response.c_str());
         }
 
-        uploadBuffer = "";
+        uploadBuffer.clear();
     }
 }
 
+// ============================================================================
+// Live configuration: routing file upload, reload, WIFI apply
+// ============================================================================
+
+void ConfigWebServer::handleRoutesUpload(AsyncWebServerRequest* request, const String& filename,
+                                         size_t index, uint8_t* data, size_t len, bool final) {
+    (void)filename;
+    if (index == 0) {
+        if (routesUpload) {
+            routesUpload.close();  // Previous upload aborted
+        }
+        if (!OtaFilesystemLocked()) {
+            routesUpload = LittleFS.open(ROUTES_UPLOAD_PATH, "w");
+        }
+        routesUploadBytes = 0;
+    }
+
+    routesUploadBytes += len;
+    if (routesUpload && routesUploadBytes <= NMEA0183_ROUTES_MAX_BYTES &&
+        routesUpload.write(data, len) != len) {
+        routesUpload.close();  // Write error: reported below
+    }
+
+    if (!final) {
+        return;
+    }
+
+    bool written = static_cast<bool>(routesUpload);
+    if (routesUpload) {
+        routesUpload.close();
+    }
+
+    ScratchScope scratch(GetHttpArena());
+    char* body = scratch.arena().allocArray<char>(UPLOAD_RESPONSE_BYTES);
+    if (body == nullptr) {
+        request->send(503, "application/json", SCRATCH_EXHAUSTED);
+        return;
+    }
+    JsonWriter response(body, UPLOAD_RESPONSE_BYTES);
+    if (routesUploadBytes > NMEA0183_ROUTES_MAX_BYTES) {
+        LittleFS.remove(ROUTES_UPLOAD_PATH);
+        char error[48];
+        snprintf(error, sizeof(error), "File larger than %d bytes", NMEA0183_ROUTES_MAX_BYTES);
+        buildErrorResponse(response, "Invalid routing file", error);
+        request->send(400, "application/json", response.c_str());
+        return;
+    }
+    if (!written) {
+        if (!OtaFilesystemLocked()) {
+            LittleFS.remove(ROUTES_UPLOAD_PATH);
+        }
+        buildErrorResponse(response, "Failed to save routing file");
+        request->send(500, "application/json", response.c_str());
+        return;
+    }
+
+    // Validated by the main loop: an invalid file is deleted and the routes stay as they are
+    uint32_t version = GetConfigService().publish(ConfigDomain::NMEA0183_ROUTES);
+    response.beginObject()
+        .add("status", "success")
+        .add("message", "Routing file uploaded. Applied if valid, see GET /config.")
+        .add("bytes", (unsigned long)routesUploadBytes)
+        .add("version", (unsigned long)version)
+        .endObject();
+    request->send(202, "application/json", response.c_str());
+}
+
+void ConfigWebServer::handleReload(AsyncWebServerRequest* request) {
+    ScratchScope scratch(GetHttpArena());
+    char* body = scratch.arena().allocArray<char>(UPLOAD_RESPONSE_BYTES);
+    if (body == nullptr) {
+        request->send(503, "application/json", SCRATCH_EXHAUSTED);
+        return;
+    }
+    JsonWriter response(body, UPLOAD_RESPONSE_BYTES);
+
+    ConfigDomain domain;
+    if (!request->hasParam("domain") || !ConfigDomainFromName(request->getParam("domain")->value().c_str(), domain)) {
+        buildErrorResponse(response, "Missing or unknown domain", "domain: wifi, calibration or nmea0183_routes");
+        request->send(400, "application/json", response.c_str());
+        return;
+    }
+
+    uint32_t version = GetConfigService().publish(domain);
+    response.beginObject()
+        .add("status", "success")
+        .add("domain", ConfigDomainName(domain))
+        .add("version", (unsigned long)version)
+        .endObject();
+    request->send(202, "application/json", response.c_str());
+}
+
+ConfigApplyResult ConfigWebServer::applyWiFiConfig(void* context, uint32_t version) {
+    (void)version;
+    ConfigWebServer* self = static_cast<ConfigWebServer*>(context);
+    WiFiConfigFile updated;
+    bool busy = false;
+    if (!self->wifiStage.take(updated, busy)) {
+        if (busy) {
+            return ConfigApplyResult::BUSY;
+        }
+        // Reload request (or the staging slot was busy during the upload)
+        if (!self->wifiManager->loadConfig(updated) || updated.isEmpty()) {
+            return ConfigApplyResult::REJECTED;  // Logged by loadConfig(); the running list stays
+        }
+    }
+    return self->wifiManager->applyConfig(*self->state, *self->config, updated) ? ConfigApplyResult::APPLIED
+                                                                                : ConfigApplyResult::REJECTED;
+}
+
 // ============================================================================
 // T042: handleGetConfig() Implementation
 // ============================================================================
 
 void ConfigWebServer::handleGetConfig(AsyncWebServerRequest* request) {
-    String response = "{";
+    GetChunkedJsonResponder().send(request, writeConfigStep, this);
+}
+
+bool ConfigWebServer::writeConfigStep(JsonWriter& json, uint16_t step, void* context) {
+    const ConfigWebServer* self = static_cast<const ConfigWebServer*>(context);
+    const WiFiConfigFile* config = self->config;
 
     // Networks array
-    response += "\"networks\":[";
-    for (int i = 0; i < config->count; i++) {
-        if (i > 0) {
-            response += ",";
-        }
-        response += "{";
-        response += "\"ssid\":\"" + config->networks[i].ssid + "\",";
-        response += "\"priority\":" + String(i + 1);
-        response += "}";
+    if (step == 0) {
+        json.beginObject().beginArray("networks");
+        return true;
     }
-    response += "],";
+    int i = step - 1;
+    if (i < config->count) {
+        char address[64];
+        bool isStatic = config->networks[i].staticIP.enabled() &&
+                        WiFiFormatStaticIP(config->networks[i].staticIP, address, sizeof(address)) > 0;
+        json.beginObject()
+            .add("ssid", config->networks[i].ssid)
+            .add("priority", i + 1)
+            .add("static_ip", isStatic ? address : (const char*)nullptr)
+            .endObject();
+        return true;
+    }
+    json.endArray();
 
     // Max networks
-    response += "\"max_networks\":" + String(MAX_NETWORKS) + ",";
+    json.add("max_networks", MAX_NETWORKS);
 
     // Current connection
-    response += "\"current_connection\":\"" + state->connectedSSID + "\"";
-
-    response += "}";
+    json.add("current_connection", self->state->connectedSSID);
 
-    request->send(200, "application/json", response);
+    json.endObject();
+    return false;
 }
 
 // ============================================================================
@@ -170,68 +348,87 @@ void ConfigWebServer::handleGetConfig(AsyncWebServerRequest* request) {
 // ============================================================================
 
 void ConfigWebServer::handleGetStatus(AsyncWebServerRequest* request) {
-    String response = "{";
+    GetChunkedJsonResponder().send(request, writeStatusStep, this);
+}
+
+bool ConfigWebServer::writeStatusStep(JsonWriter& json, uint16_t step, void* context) {
+    const ConfigWebServer* self = static_cast<const ConfigWebServer*>(context);
+    const WiFiConnectionState* state = self->state;
+    const WiFiConfigFile* config = self->config;
+
+    if (step == 1) {
+        // Time-to-connect: directed (cached BSSID/channel) vs scanned attempts
+        self->wifiManager->getConnectStats().writeJson(json, "connect");
+        return true;
+    }
+    if (step == 2) {
+        // Own access point while no configured network is reachable
+        if (self->apFallback != nullptr) {
+            self->apFallback->writeJson(json, millis(), "ap");
+        }
+        json.endObject();
+        return false;
+    }
+
+    json.beginObject();
 
     // Status
-    response += "\"status\":\"" + state->getStatusString() + "\"";
+    json.add("status", state->getStatusString());
 
     if (state->status == ConnectionStatus::CONNECTED) {
         // Connected - include SSID, IP, signal strength
-        response += ",\"ssid\":\"" + state->connectedSSID + "\"";
+        json.add("ssid", state->connectedSSID);
 
         // Get IP address from WiFi (would need WiFi adapter reference)
         // For now, use placeholder
-        response += ",\"ip_address\":\"0.0.0.0\"";
+        json.add("ip_address", "0.0.0.0");
 
         // Signal strength (would need WiFi adapter reference)
-        response += ",\"signal_strength\":0";
+        json.add("signal_strength", 0);
 
         // Uptime
-        response += ",\"uptime_seconds\":" + String(millis() / 1000);
+        json.add("uptime_seconds", millis() / 1000);
 
     } else if (state->status == ConnectionStatus::CONNECTING) {
         // Connecting - include current attempt and time remaining
         if (state->currentNetworkIndex < config->count) {
-            response += ",\"current_attempt\":\"" + config->networks[state->currentNetworkIndex].ssid + "\"";
+            json.add("current_attempt", config->networks[state->currentNetworkIndex].ssid);
         }
-        response += ",\"attempt_number\":" + String(state->retryCount + 1);
+        json.add("attempt_number", state->retryCount + 1);
 
         // Calculate time remaining
         unsigned long elapsed = state->getElapsedTime();
-        unsigned long remaining = (elapsed < WIFI_TIMEOUT_MS) ? (WIFI_TIMEOUT_MS - elapsed) / 1000 : 0;
-        response += ",\"time_remaining_seconds\":" + String(remaining);
+        unsigned long timeoutMs = state->fastConnect ? WIFI_FAST_CONNECT_TIMEOUT_MS : WIFI_TIMEOUT_MS;
+        unsigned long remaining = (elapsed < timeoutMs) ? (timeoutMs - elapsed) / 1000 : 0;
+        json.add("time_remaining_seconds", remaining);
 
     } else if (state->status == ConnectionStatus::DISCONNECTED) {
         // Disconnected - include retry count and reboot countdown
-        response += ",\"retry_count\":" + String(state->retryCount);
+        json.add("retry_count", state->retryCount);
 
         // Reboot countdown (if scheduled)
-        if (rebootScheduled) {
-            unsigned long countdown = (millis() < rebootTime) ? (rebootTime - millis()) / 1000 : 0;
-            response += ",\"next_reboot_in_seconds\":" + String(countdown);
+        if (self->rebootScheduled) {
+            unsigned long countdown = (millis() < self->rebootTime) ? (self->rebootTime - millis()) / 1000 : 0;
+            json.add("next_reboot_in_seconds", countdown);
         }
     }
-
-    response += "}";
-
-    request->send(200, "application/json", response);
+    return true;
 }
 
 // ============================================================================
 // Helper Methods
 // ============================================================================
 
-String ConfigWebServer::buildErrorResponse(const String& message, const String& errors) {
-    String response = "{";
-    response += "\"status\":\"error\",";
-    response += "\"message\":\"" + message + "\"";
+void ConfigWebServer::buildErrorResponse(JsonWriter& out, const char* message, const char* error) {
+    out.beginObject()
+        .add("status", "error")
+        .add("message", message);
 
-    if (errors.length() > 0) {
-        response += "," + errors;
+    if (error != nullptr && error[0] != '\0') {
+        out.beginArray("errors").add(error).endArray();
     }
 
-    response += "}";
-    return response;
+    out.endObject();
 }
 
 String ConfigWebServer::redactPassword(const String& password) {
@@ -3,9 +3,16 @@
  * @brief Web server for WiFi configuration management
  *
  * Provides HTTP API endpoints for WiFi configuration and status:
- * - POST /upload-wifi-config: Upload new WiFi configuration
+ * - POST /upload-wifi-config: Upload new WiFi configuration (applied live)
  * - GET /wifi-config: Retrieve current configuration (passwords redacted)
  * - GET /wifi-status: Get current connection status
+ * - POST /upload-nmea0183-routes: Upload a routing file (applied live)
+ * - GET /config: Live configuration versions (ConfigService)
+ * - POST /config/reload?domain=<name>: Re-apply a domain from flash
+ *
+ * Uploads are validated here, saved, and published to the ConfigService;
+ * the main loop applies them (WiFi reconnects only if the connected
+ * network was removed). No upload reboots the device.
  *
  * Uses ESPAsyncWebServer for non-blocking HTTP handling.
  */
@@ -15,10 +22,15 @@
 
 #include <Arduino.h>
 #include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
 #include "WiFiManager.h"
 #include "WiFiConfigFile.h"
 #include "WiFiConnectionState.h"
 #include "../config.h"
+#include "../utils/JsonWriter.h"
+#include "../utils/FixedString.h"
+#include "../utils/ConfigService.h"
+#include "../utils/WiFiApFallback.h"
 
 /**
  * @brief Web server for WiFi configuration API
@@ -32,12 +44,16 @@ private:
     WiFiManager* wifiManager;
     WiFiConfigFile* config;
     WiFiConnectionState* state;
+    const WiFiApFallback* apFallback;       ///< SoftAP state for /wifi-status (nullptr = none)
     bool rebootScheduled;
     unsigned long rebootTime;
+    ConfigStage<WiFiConfigFile> wifiStage;  ///< Validated upload, applied by the main loop
+    File routesUpload;                      ///< Staged routing file being received (async_tcp)
+    size_t routesUploadBytes;
 
 public:
     /**
-     * @brief Constructor
+     * @brief Constructor (subscribes the WIFI configuration domain)
      * @param mgr WiFi manager instance
      * @param cfg WiFi configuration reference
      * @param st Connection state reference
@@ -57,6 +73,8 @@ public:
      * - POST /upload-wifi-config
      * - GET /wifi-config
      * - GET /wifi-status
+     * - POST /upload-nmea0183-routes
+     * - GET /config, POST /config/reload
      */
     void setupRoutes();
 
@@ -70,6 +88,7 @@ public:
      * @return true if reboot should happen now
      *
      * Call this periodically from main loop to handle scheduled reboots.
+     * Configuration uploads no longer schedule one (see ConfigService).
      */
     bool shouldReboot();
 
@@ -79,6 +98,12 @@ public:
      */
     void scheduleReboot(unsigned long delayMs);
 
+    /**
+     * @brief Report the SoftAP fallback under "ap" in GET /wifi-status
+     * @param fallback Fallback policy of the main loop (nullptr = not reported)
+     */
+    void setApFallback(const WiFiApFallback* fallback) { apFallback = fallback; }
+
     /**
      * @brief Get the underlying AsyncWebServer instance
      * @return Pointer to AsyncWebServer
@@ -98,11 +123,37 @@ private:
      * @param final True if this is the last chunk
      *
      * Parses multipart form data, validates config, saves to filesystem,
-     * schedules reboot after 5 seconds.
+     * stages it and publishes ConfigDomain::WIFI (applied within
+     * CONFIG_SERVICE_INTERVAL_MS, no reboot).
      */
     void handleUpload(AsyncWebServerRequest* request, const String& filename,
                      size_t index, uint8_t* data, size_t len, bool final);
 
+    /**
+     * @brief Handle POST /upload-nmea0183-routes
+     *
+     * Streams the file to NMEA0183_ROUTES_FILE NMEA0183_ROUTES_UPLOAD_SUFFIX
+     * (at most NMEA0183_ROUTES_MAX_BYTES) and publishes
+     * ConfigDomain::NMEA0183_ROUTES; the main loop validates it and only
+     * then replaces the routing file (NMEA0183RouteConfig::reload()).
+     */
+    void handleRoutesUpload(AsyncWebServerRequest* request, const String& filename,
+                            size_t index, uint8_t* data, size_t len, bool final);
+
+    /**
+     * @brief Handle POST /config/reload?domain=<name>
+     *
+     * Publishes the domain without staging an object: its subscribers
+     * re-read their file (after it was edited or restored on flash).
+     * 400 for a missing or unknown domain.
+     */
+    void handleReload(AsyncWebServerRequest* request);
+
+    /**
+     * @brief ConfigService WIFI apply (main loop): the staged upload, else wifi.conf
+     */
+    static ConfigApplyResult applyWiFiConfig(void* context, uint32_t version);
+
     /**
      * @brief Handle GET /wifi-config
      * @param request HTTP request
@@ -120,13 +171,23 @@ private:
      */
     void handleGetStatus(AsyncWebServerRequest* request);
 
+    /**
+     * @brief GET /wifi-config body, one network per step (ChunkedJsonGenerator)
+     */
+    static bool writeConfigStep(JsonWriter& json, uint16_t step, void* context);
+
+    /**
+     * @brief GET /wifi-status body: state, connect statistics, access point (ChunkedJsonGenerator)
+     */
+    static bool writeStatusStep(JsonWriter& json, uint16_t step, void* context);
+
     /**
      * @brief Build JSON error response
+     * @param out Destination writer
      * @param message Error message
-     * @param errors Array of error details (optional)
-     * @return JSON string
+     * @param error Single entry for the "errors" array (optional)
      */
-    String buildErrorResponse(const String& message, const String& errors = "");
+    void buildErrorResponse(JsonWriter& out, const char* message, const char* error = nullptr);
 
     /**
      * @brief Redact password from credentials (security)
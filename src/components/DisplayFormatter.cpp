@@ -35,3 +35,15 @@ void DisplayFormatter::formatFrequency(uint32_t frequency, char* buffer) {
         snprintf(buffer, 8, "%.1fk", kHz);
     }
 }
+
+void DisplayFormatter::formatDuration(uint32_t micros, char* buffer) {
+    if (micros < 1000) {
+        snprintf(buffer, 6, "%luu", (unsigned long)micros);
+    } else if (micros < 10000) {
+        snprintf(buffer, 6, "%lu.%lum", (unsigned long)(micros / 1000), (unsigned long)(micros / 100 % 10));
+    } else if (micros < 1000000) {
+        snprintf(buffer, 6, "%lum", (unsigned long)(micros / 1000));
+    } else {
+        snprintf(buffer, 6, "%lus", (unsigned long)(micros / 1000000));
+    }
+}
@@ -128,6 +128,20 @@ public:
      * Constitutional compliance: FR-045 (integer display unless >999 Hz)
      */
     static void formatFrequency(uint32_t frequency, char* buffer);
+
+    /**
+     * @brief Format a duration in microseconds in at most 5 characters
+     *
+     * Examples:
+     * - formatDuration(840) → "840u"
+     * - formatDuration(4500) → "4.5m"
+     * - formatDuration(120000) → "120m"
+     * - formatDuration(3200000) → "3s"
+     *
+     * @param micros Duration in microseconds
+     * @param buffer Output buffer (must be at least 6 chars)
+     */
+    static void formatDuration(uint32_t micros, char* buffer);
 };
 
 #endif // DISPLAY_FORMATTER_H
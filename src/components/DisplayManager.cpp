@@ -8,6 +8,8 @@
 
 #include "DisplayManager.h"
 #include "utils/DisplayLayout.h"
+#include "utils/HeapMonitor.h"
+#include <stdio.h>
 #include <string.h>
 
 DisplayManager::DisplayManager(IDisplayAdapter* displayAdapter, ISystemMetrics* systemMetrics, WebSocketLogger* logger)
@@ -15,13 +17,18 @@ DisplayManager::DisplayManager(IDisplayAdapter* displayAdapter, ISystemMetrics*
       _systemMetrics(systemMetrics),
       _metricsCollector(nullptr),
       _progressTracker(nullptr),
-      _logger(logger) {
+      _logger(logger),
+      _busMonitor(nullptr),
+      _shownPage(OledPage::STATUS) {
 
     // Initialize current metrics to safe defaults
     _currentMetrics.freeRamBytes = 0;
     _currentMetrics.sketchSizeBytes = 0;
     _currentMetrics.freeFlashBytes = 0;
     _currentMetrics.loopFrequency = 0;
+    _currentMetrics.cpuIdlePercent = CPU_IDLE_UNKNOWN;
+    _currentMetrics.coreIdlePercent[0] = CPU_IDLE_UNKNOWN;
+    _currentMetrics.coreIdlePercent[1] = CPU_IDLE_UNKNOWN;
     _currentMetrics.animationState = 0;
     _currentMetrics.lastUpdate = 0;
 
@@ -56,7 +63,7 @@ bool DisplayManager::init() {
     if (_displayAdapter == nullptr) {
         // Log ERROR: DisplayAdapter is null
         if (_logger != nullptr) {
-            _logger->broadcastLog(LogLevel::ERROR, "DisplayManager", "INIT_FAILED",
+            _logger->broadcastLog(LogLevel::ERROR, LogComponent::DISPLAY_MANAGER, LogEvent::INIT_FAILED,
                                   F("{\"reason\":\"DisplayAdapter is null\"}"));
         }
         return false;
@@ -67,13 +74,13 @@ bool DisplayManager::init() {
     if (success) {
         // Log INFO: Display initialized successfully
         if (_logger != nullptr) {
-            _logger->broadcastLog(LogLevel::INFO, "DisplayManager", "INIT_SUCCESS",
+            _logger->broadcastLog(LogLevel::INFO, LogComponent::DISPLAY_MANAGER, LogEvent::INIT_SUCCESS,
                                   F("{\"display\":\"SSD1306\",\"resolution\":\"128x64\"}"));
         }
     } else {
         // Log ERROR: Display initialization failed (I2C error)
         if (_logger != nullptr) {
-            _logger->broadcastLog(LogLevel::ERROR, "DisplayManager", "INIT_FAILED",
+            _logger->broadcastLog(LogLevel::ERROR, LogComponent::DISPLAY_MANAGER, LogEvent::INIT_FAILED,
                                   F("{\"reason\":\"I2C communication error\"}"));
         }
     }
@@ -154,8 +161,8 @@ void DisplayManager::renderStatusPage() {
 
     // Log rendering event (DEBUG level to avoid flooding logs every 5 seconds)
     if (_logger != nullptr) {
-        _logger->broadcastLog(LogLevel::DEBUG, "DisplayManager", "RENDER_STATUS_PAGE",
-                              F("{\"page\":\"status\"}"));
+        LOG_DEBUG(_logger, LogComponent::DISPLAY_MANAGER, LogEvent::RENDER_STATUS_PAGE,
+                  F("{\"page\":\"status\"}"));
     }
 
     // Render using internal status (updated externally via progressTracker)
@@ -168,6 +175,7 @@ void DisplayManager::renderStatusPage(const SubsystemStatus& status) {
         return;
     }
 
+    _shownPage = OledPage::STATUS;
     _displayAdapter->clear();
     _displayAdapter->setTextSize(1);
 
@@ -189,18 +197,37 @@ void DisplayManager::renderStatusPage(const SubsystemStatus& status) {
     DisplayFormatter::formatIPAddress(status.wifiIPAddress, buffer);
     _displayAdapter->print(buffer);
 
-    // Line 2: Free RAM
+    // Line 2: Free RAM and the largest block ("RAM: 120KB blk 38KB"); "!" once fragmented
     _displayAdapter->setCursor(0, getLineY(2));
     _displayAdapter->print("RAM: ");
     DisplayFormatter::formatBytes(_currentMetrics.freeRamBytes, buffer);
     _displayAdapter->print(buffer);
+    _displayAdapter->print(" blk ");
+    DisplayFormatter::formatBytes(_currentMetrics.largestFreeBlockBytes, buffer);
+    _displayAdapter->print(buffer);
+    if (HeapMonitor::fragmentationPercent(_currentMetrics.freeRamBytes,
+                                          _currentMetrics.largestFreeBlockBytes) >= HEAP_FRAG_WARN_PCT) {
+        _displayAdapter->print("!");
+    }
 
-    // Line 3: Flash usage
+    // Line 3: Bus load over 1 s and its peak, error state unless active ("N2k: 34% pk 61% WARN");
+    // flash usage without a bus monitor
     _displayAdapter->setCursor(0, getLineY(3));
-    _displayAdapter->print("Flash: ");
-    uint32_t totalFlash = _currentMetrics.sketchSizeBytes + _currentMetrics.freeFlashBytes;
-    DisplayFormatter::formatFlashUsage(_currentMetrics.sketchSizeBytes, totalFlash, buffer);
-    _displayAdapter->print(buffer);
+    if (_busMonitor != nullptr) {
+        static const char* const STATES[] = {"", " WARN", " PASV", " OFF"};
+        _displayAdapter->print("N2k: ");
+        DisplayFormatter::formatPercent(_busMonitor->loadPercent(_currentMetrics.lastUpdate, CAN_BUS_LOAD_SHORT_MS), buffer);
+        _displayAdapter->print(buffer);
+        _displayAdapter->print(" pk ");
+        DisplayFormatter::formatPercent(_busMonitor->getPeakPercent(), buffer);
+        _displayAdapter->print(buffer);
+        _displayAdapter->print(STATES[static_cast<uint8_t>(_busMonitor->getState()) & 3]);
+    } else {
+        _displayAdapter->print("Flash: ");
+        uint32_t totalFlash = _currentMetrics.sketchSizeBytes + _currentMetrics.freeFlashBytes;
+        DisplayFormatter::formatFlashUsage(_currentMetrics.sketchSizeBytes, totalFlash, buffer);
+        _displayAdapter->print(buffer);
+    }
 
     // Line 4: Loop frequency
     _displayAdapter->setCursor(0, getLineY(4));
@@ -209,7 +236,14 @@ void DisplayManager::renderStatusPage(const SubsystemStatus& status) {
     _displayAdapter->print(buffer);
     _displayAdapter->print(" Hz");
 
-    // Line 5: Animation icon (right corner)
+    // Line 5: CPU idle per core, animation icon (right corner)
+    _displayAdapter->setCursor(0, getLineY(5));
+    _displayAdapter->print("CPU Idle: ");
+    DisplayFormatter::formatPercent(_currentMetrics.coreIdlePercent[0], buffer);
+    _displayAdapter->print(buffer);
+    _displayAdapter->print(" ");
+    DisplayFormatter::formatPercent(_currentMetrics.coreIdlePercent[1], buffer);
+    _displayAdapter->print(buffer);
     _displayAdapter->setCursor(118, getLineY(5));  // 128 - 10 pixels for " X " (bugfix-001)
     char icon = DisplayFormatter::getAnimationIcon(_currentMetrics.animationState);
     char iconStr[2] = {icon, '\0'};
@@ -218,6 +252,118 @@ void DisplayManager::renderStatusPage(const SubsystemStatus& status) {
     _displayAdapter->display();
 }
 
+void DisplayManager::renderAlarm(const char* title, const char* detail, const char* value, bool visible) {
+    // Graceful degradation: skip if display not ready (FR-027)
+    if (_displayAdapter == nullptr || !_displayAdapter->isReady()) {
+        return;
+    }
+
+    _shownPage = OledPage::COUNT;  // No page: the next render starts over
+    _displayAdapter->clear();
+    if (visible) {
+        _displayAdapter->setTextSize(2);
+        _displayAdapter->setCursor(0, getLineY(0));
+        _displayAdapter->print(title);
+        _displayAdapter->setTextSize(1);
+        _displayAdapter->setCursor(0, getLineY(3));
+        _displayAdapter->print(detail);
+        _displayAdapter->setCursor(0, getLineY(4));
+        _displayAdapter->print(value);
+    }
+    _displayAdapter->display();
+}
+
+void DisplayManager::renderReactionPage(const ReactionProfiler& profiler, uint32_t cpuMhz, uint32_t nowMs) {
+    // Graceful degradation: skip if display not ready (FR-027)
+    if (_displayAdapter == nullptr || !_displayAdapter->isReady()) {
+        return;
+    }
+    if (cpuMhz == 0) {
+        cpuMhz = 1;
+    }
+
+    _shownPage = OledPage::REACTIONS;
+    _displayAdapter->clear();
+    _displayAdapter->setTextSize(1);
+
+    char line[22];
+    char avg[6];
+    char max[6];
+
+    // Line 0: header
+    _displayAdapter->setCursor(0, getLineY(0));
+    _displayAdapter->print("Reaction    avg   max");
+
+    // Lines 1-4: most expensive reactions first
+    uint8_t order[4];
+    uint8_t n = profiler.top(order, 4);
+    for (uint8_t i = 0; i < n; i++) {
+        const ReactionStats* stats = profiler.at(order[i]);
+        uint32_t avgUs = stats->calls > 0 ? static_cast<uint32_t>(stats->totalCycles / stats->calls / cpuMhz) : 0;
+        DisplayFormatter::formatDuration(avgUs, avg);
+        DisplayFormatter::formatDuration(stats->maxCycles / cpuMhz, max);
+        snprintf(line, sizeof(line), "%-9.9s %5s %5s", stats->name, avg, max);
+        _displayAdapter->setCursor(0, getLineY(1 + i));
+        _displayAdapter->print(line);
+    }
+
+    // Line 5: total share of the loop (animation icon stays in the corner)
+    _displayAdapter->setCursor(0, getLineY(5));
+    snprintf(line, sizeof(line), "Busy: %.1f%%", profiler.busyPercent(cpuMhz, nowMs));
+    _displayAdapter->print(line);
+    char icon = DisplayFormatter::getAnimationIcon(_currentMetrics.animationState);
+    char iconStr[2] = {icon, '\0'};
+    _displayAdapter->setCursor(118, getLineY(5));
+    _displayAdapter->print(iconStr);
+
+    _displayAdapter->display();
+}
+
+void DisplayManager::renderInstrumentPage(OledPage page, const BoatDataStructure& data) {
+    // Graceful degradation: skip if display not ready (FR-027)
+    const InstrumentPageSpec* spec = GetInstrumentPageSpec(page);
+    if (_displayAdapter == nullptr || !_displayAdapter->isReady() || spec == nullptr) {
+        return;
+    }
+
+    static const uint8_t VALUE_PAGE[INSTRUMENT_PAGE_FIELDS] = {2, 5};  // Rows 16-31 and 40-55
+    static const uint8_t VALUE_X = 44;  // After a 7-char label; 6 big digits end at x=116, left of the icon
+
+    bool redraw = page != _shownPage;
+    if (redraw) {
+        _shownPage = page;
+        _fieldCache.invalidate();
+        _displayAdapter->clear();
+        _displayAdapter->setTextSize(1);
+        _displayAdapter->setCursor(0, getLineY(0));
+        _displayAdapter->print(spec->title);
+        for (uint8_t i = 0; i < INSTRUMENT_PAGE_FIELDS; i++) {
+            _displayAdapter->setCursor(0, VALUE_PAGE[i] * 8 + 4);
+            _displayAdapter->print(spec->labels[i]);
+        }
+        char icon = DisplayFormatter::getAnimationIcon(_currentMetrics.animationState);
+        char iconStr[2] = {icon, '\0'};
+        _displayAdapter->setCursor(118, getLineY(5));
+        _displayAdapter->print(iconStr);
+    }
+
+    // Values: redrawn from the digit atlas only when the displayed text changed
+    bool changed = redraw;
+    for (uint8_t i = 0; i < INSTRUMENT_PAGE_FIELDS; i++) {
+        InstrumentField field = spec->fields[i];
+        double value = 0;
+        bool available = InstrumentFieldValue(field, data, value);
+        if (_fieldCache.update(field, available, value)) {
+            _displayAdapter->drawBigNumber(VALUE_X, VALUE_PAGE[i], _fieldCache.text(field));
+            changed = true;
+        }
+    }
+
+    if (changed) {
+        _displayAdapter->display();
+    }
+}
+
 void DisplayManager::updateAnimationIcon(const DisplayMetrics& metrics) {
     // Graceful degradation: skip if display not ready (FR-027)
     if (_displayAdapter == nullptr || !_displayAdapter->isReady()) {
@@ -227,9 +373,7 @@ void DisplayManager::updateAnimationIcon(const DisplayMetrics& metrics) {
     // Update internal state for next call
     _currentMetrics.animationState = metrics.animationState;
 
-    // Render only the animation icon (partial update)
-    // Note: Full clear and redraw is simpler for SSD1306
-    // Optimization: Could just update the corner, but full refresh is <10ms
+    // Render only the animation icon: no clear(), so display() sends just its two page spans
     _displayAdapter->setCursor(118, getLineY(5));  // Bugfix-001: adjusted from 108 to 118
     char icon = DisplayFormatter::getAnimationIcon(metrics.animationState);
     char iconStr[2] = {icon, '\0'};
@@ -25,6 +25,9 @@
 #include "DisplayFormatter.h"
 #include "StartupProgressTracker.h"
 #include "utils/WebSocketLogger.h"
+#include "utils/ReactionProfiler.h"
+#include "utils/InstrumentPages.h"
+#include "utils/CanBusMonitor.h"
 
 /**
  * @brief Orchestrates OLED display operations
@@ -43,6 +46,11 @@ private:
     DisplayMetrics _currentMetrics;        ///< Current system metrics (static allocation)
     SubsystemStatus _currentStatus;        ///< Current subsystem status (static allocation)
 
+    const CanBusMonitor* _busMonitor;      ///< NMEA 2000 load and error state (optional)
+
+    OledPage _shownPage;                ///< Page currently on the screen
+    InstrumentFieldCache _fieldCache;      ///< Value texts of the instrument pages
+
 public:
     /**
      * @brief Constructor with dependency injection
@@ -94,7 +102,7 @@ public:
      * - Line 0: WiFi SSID or "Disconnected"
      * - Line 1: IP address or "---"
      * - Line 2: Free RAM (KB)
-     * - Line 3: Flash usage (used/total KB)
+     * - Line 3: NMEA 2000 load, peak and error state with a bus monitor, else flash usage (used/total KB)
      * - Line 4: CPU idle percentage
      * - Line 5: Animation icon (rotating)
      *
@@ -114,6 +122,60 @@ public:
      */
     void renderStatusPage(const SubsystemStatus& status);
 
+    /**
+     * @brief Render the reaction profiler debug page
+     *
+     * The four most expensive ReactESP reactions since the last reset:
+     * - Line 0: "Reaction   avg   max"
+     * - Lines 1-4: name (9 chars), average and maximum execution time
+     * - Line 5: share of the window spent in profiled reactions
+     *
+     * Part of the page rotation when REACTION_PROFILER_OLED_PAGE is set.
+     *
+     * @param profiler Profiler filled by the main loop
+     * @param cpuMhz CPU clock (cycles per microsecond)
+     * @param nowMs millis()
+     */
+    void renderReactionPage(const ReactionProfiler& profiler, uint32_t cpuMhz, uint32_t nowMs);
+
+    /**
+     * @brief Render an instrument page (two values in 12x16 digits)
+     *
+     * - Line 0: page title
+     * - Pages 2-3 and 5-6: field label (name and unit) and value (drawBigNumber())
+     *
+     * The page is drawn from scratch when it was not already shown.
+     * Otherwise only values whose text changed are redrawn (opaque digits
+     * over the old ones), so display() sends just those spans, and a call
+     * without a visible change sends nothing.
+     *
+     * @param page One of the instrument pages (others are ignored)
+     * @param data Current BoatData
+     */
+    void renderInstrumentPage(OledPage page, const BoatDataStructure& data);
+
+    /**
+     * @brief Render one phase of the flashing alarm screen
+     *
+     * - Lines 0-1: @p title in double-size text ("ALARM", "WARNING", ...)
+     * - Line 3: @p detail (alarm type), line 4: @p value ("52.3 m")
+     *
+     * The "off" phase (@p visible false) blanks the screen. Either phase
+     * leaves no page shown, so the next page render redraws from scratch.
+     *
+     * @param title Severity text
+     * @param detail Alarm type text
+     * @param value Value text
+     * @param visible On phase
+     */
+    void renderAlarm(const char* title, const char* detail, const char* value, bool visible);
+
+    /// Page currently on the screen
+    OledPage getShownPage() const { return _shownPage; }
+
+    /// Value texts of the instrument pages (for testing and statistics)
+    const InstrumentFieldCache& getFieldCache() const { return _fieldCache; }
+
     /**
      * @brief Update animation icon only (partial render)
      *
@@ -133,6 +195,11 @@ public:
      */
     void updateAnimationIcon();
 
+    /**
+     * @brief Show the bus load on the status page instead of the flash usage (nullptr = flash)
+     */
+    void setBusMonitor(const CanBusMonitor* monitor) { _busMonitor = monitor; }
+
     /**
      * @brief Update WiFi connection status
      *
@@ -0,0 +1,195 @@
+/**
+ * @file EngineJournalStore.cpp
+ * @brief Implementation of the engine journal ring file
+ *
+ * @see EngineJournalStore.h
+ */
+
+#include "EngineJournalStore.h"
+#include <LittleFS.h>
+
+namespace {
+
+constexpr size_t FILE_BYTES = static_cast<size_t>(ENGINE_JOURNAL_CAPACITY) * ENGINE_JOURNAL_RECORD_SIZE;
+
+constexpr size_t slotOffset(uint16_t slot) {
+    return static_cast<size_t>(slot) * ENGINE_JOURNAL_RECORD_SIZE;
+}
+
+}  // namespace
+
+EngineJournalStore::EngineJournalStore()
+    : newest_(0),
+      writes_(0),
+      writeErrors_(0),
+      lastWriteUs_(0),
+      recovered_(0),
+      ready_(false) {
+}
+
+bool EngineJournalStore::begin(uint32_t time, bool utc) {
+    index_.clear();
+    uint32_t newest = 0;
+    recovered_ = 0;
+
+    File file = LittleFS.exists(ENGINE_JOURNAL_FILE) ? LittleFS.open(ENGINE_JOURNAL_FILE, "r") : File();
+    if (file && file.size() == FILE_BYTES) {
+        // Slot order: the first slot of each block restarts its range, older laps only widen it
+        uint8_t raw[ENGINE_JOURNAL_RECORD_SIZE];
+        EngineJournalRecord record;
+        for (uint16_t slot = 0; slot < ENGINE_JOURNAL_CAPACITY; slot++) {
+            if (file.read(raw, sizeof(raw)) != sizeof(raw)) {
+                break;
+            }
+            if (!EngineJournalDecode(raw, record) || EngineJournalSlot(record.sequence) != slot) {
+                continue;
+            }
+            index_.note(record);
+            recovered_++;
+            if (record.sequence > newest) {
+                newest = record.sequence;
+            }
+        }
+        file.close();
+    } else {
+        if (file) {
+            file.close();  // Other capacity or cut short: start over
+        }
+        if (!create()) {
+            ready_ = false;
+            return false;
+        }
+    }
+
+    newest_.store(newest);
+    journal_.start(newest + 1, time, utc);
+    ready_ = true;
+    return true;
+}
+
+bool EngineJournalStore::create() {
+    File file = LittleFS.open(ENGINE_JOURNAL_FILE, "w");
+    if (!file) {
+        return false;
+    }
+    uint8_t zeros[64] = {0};  // Sequence 0 = empty slot
+    bool ok = true;
+    for (size_t written = 0; ok && written < FILE_BYTES; written += sizeof(zeros)) {
+        ok = file.write(zeros, sizeof(zeros)) == sizeof(zeros);
+    }
+    file.close();
+    return ok;
+}
+
+uint8_t EngineJournalStore::observe(const BoatDataStructure& data, uint32_t time, bool utc) {
+    return ready_ ? journal_.observe(data, time, utc) : 0;
+}
+
+bool EngineJournalStore::save() {
+    uint8_t count = journal_.pending();
+    if (!ready_ || count == 0) {
+        return true;
+    }
+
+    uint32_t startUs = micros();
+    File file = LittleFS.open(ENGINE_JOURNAL_FILE, "r+");
+    if (!file) {
+        writeErrors_++;
+        return false;  // Records stay queued for the retry
+    }
+
+    uint8_t raw[ENGINE_JOURNAL_RECORD_SIZE];
+    uint8_t written = 0;
+    while (written < count) {
+        const EngineJournalRecord& record = journal_.peek(written);
+        EngineJournalEncode(record, raw);
+        if (!file.seek(slotOffset(EngineJournalSlot(record.sequence))) ||
+            file.write(raw, sizeof(raw)) != sizeof(raw)) {
+            break;
+        }
+        index_.note(record);
+        newest_.store(record.sequence);
+        written++;
+    }
+    file.close();
+
+    journal_.release(written);
+    lastWriteUs_ = micros() - startUs;
+    if (written < count) {
+        writeErrors_++;
+        return false;
+    }
+    writes_++;
+    return true;
+}
+
+uint32_t EngineJournalStore::getOldestSequence() const {
+    uint32_t newest = newest_.load();
+    if (newest == 0) {
+        return 0;
+    }
+    return newest > ENGINE_JOURNAL_CAPACITY ? newest - ENGINE_JOURNAL_CAPACITY + 1 : 1;
+}
+
+uint8_t EngineJournalStore::query(uint32_t afterSequence, uint32_t fromUtc, uint32_t toUtc,
+                                  EngineJournalRecord* out, uint8_t max, uint32_t& next) const {
+    next = 0;
+    uint32_t newest = newest_.load();
+    if (!ready_ || newest == 0 || max == 0 || afterSequence >= newest) {
+        return 0;
+    }
+    File file = LittleFS.open(ENGINE_JOURNAL_FILE, "r");
+    if (!file) {
+        return 0;
+    }
+
+    bool filtered = fromUtc != 0 || toUtc != UINT32_MAX;
+    uint32_t oldest = getOldestSequence();
+    uint32_t sequence = afterSequence < oldest ? oldest : afterSequence + 1;
+    int32_t position = -1;  // File position, -1 = seek before the next read
+    uint8_t found = 0;
+    uint8_t raw[ENGINE_JOURNAL_RECORD_SIZE];
+
+    while (sequence <= newest && found < max) {
+        uint16_t slot = EngineJournalSlot(sequence);
+        if (filtered && !index_.overlaps(slot / ENGINE_JOURNAL_BLOCK_RECORDS, fromUtc, toUtc)) {
+            sequence += ENGINE_JOURNAL_BLOCK_RECORDS - slot % ENGINE_JOURNAL_BLOCK_RECORDS;
+            position = -1;
+            continue;
+        }
+        if (position != static_cast<int32_t>(slotOffset(slot))) {
+            if (!file.seek(slotOffset(slot))) {
+                break;
+            }
+        }
+        if (file.read(raw, sizeof(raw)) != sizeof(raw)) {
+            break;
+        }
+        position = static_cast<int32_t>(slotOffset(slot) + sizeof(raw));
+
+        EngineJournalRecord& record = out[found];
+        if (EngineJournalDecode(raw, record) && record.sequence == sequence &&
+            (!filtered || (record.utc && record.time >= fromUtc && record.time <= toUtc))) {
+            found++;
+        }
+        sequence++;
+    }
+    file.close();
+
+    next = sequence <= newest ? sequence - 1 : 0;
+    return found;
+}
+
+void EngineJournalStore::writeJson(JsonWriter& json) const {
+    json.add("ready", ready_)
+        .add("band", (unsigned int)journal_.getBand())
+        .add("recorded", (unsigned long)journal_.getRecorded())
+        .add("dropped", (unsigned long)journal_.getDropped())
+        .add("pending", (unsigned int)journal_.pending())
+        .add("oldest", (unsigned long)getOldestSequence())
+        .add("newest", (unsigned long)newest_.load())
+        .add("recovered", (unsigned int)recovered_)
+        .add("writes", (unsigned long)writes_)
+        .add("write_errors", (unsigned long)writeErrors_)
+        .add("last_write_us", (unsigned long)lastWriteUs_);
+}
@@ -0,0 +1,94 @@
+/**
+ * @file EngineJournalStore.h
+ * @brief LittleFS ring file of the engine and saildrive event journal
+ *
+ * Owns the EngineJournal (transition detector and RAM queue) and its ring
+ * file ENGINE_JOURNAL_FILE, ENGINE_JOURNAL_CAPACITY fixed 16-byte slots
+ * (EngineJournal.h). begin() creates the file zero-filled at full size, so
+ * a record is always written in place: one seek and a 16-byte write, no
+ * append or rename.
+ *
+ * - observe(): main loop (BoatData subscription); RAM only
+ * - save(): main loop (write-behind entry "engine_journal"); writes every
+ *   queued record and updates the block index
+ * - query(): any task (GET /journal/engine on async_tcp); opens the file
+ *   read-only and skips the blocks the index rules out
+ *
+ * A reader racing save() may see a half-written record; it fails the CRC
+ * and is skipped like an empty slot, and the next page returns it.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): 8 KB of flash, fixed RAM, no heap
+ * - Principle VII (Fail-Safe): a missing or damaged file is recreated, the gateway runs without it
+ *
+ * @version 1.0.0
+ */
+
+#ifndef ENGINE_JOURNAL_STORE_H
+#define ENGINE_JOURNAL_STORE_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "../utils/EngineJournal.h"
+#include "../utils/JsonWriter.h"
+
+/**
+ * @class EngineJournalStore
+ * @brief Engine journal with its ring file and block index
+ */
+class EngineJournalStore {
+public:
+    EngineJournalStore();
+
+    /**
+     * @brief Open (or create) the ring file, rebuild the index and queue the boot record
+     *
+     * @param time UTC seconds or seconds since boot
+     * @param utc @p time is UTC
+     * @return false if the file cannot be created (journal off)
+     */
+    bool begin(uint32_t time, bool utc);
+
+    bool isReady() const { return ready_; }
+
+    /// Queue the transitions of @p data (main loop); returns records queued
+    uint8_t observe(const BoatDataStructure& data, uint32_t time, bool utc);
+
+    /// Write the queued records (write-behind save, main loop)
+    bool save();
+
+    /**
+     * @brief Records after @p afterSequence, oldest first
+     *
+     * @param afterSequence Return records with a higher sequence (0 = from the oldest)
+     * @param fromUtc, toUtc Only UTC records within this range (0, UINT32_MAX = every record)
+     * @param out Up to @p max records
+     * @param next Sequence to pass as @p afterSequence for the next page (0 = no more)
+     * @return Records written to @p out
+     */
+    uint8_t query(uint32_t afterSequence, uint32_t fromUtc, uint32_t toUtc,
+                  EngineJournalRecord* out, uint8_t max, uint32_t& next) const;
+
+    /// Newest record on flash (0 = none)
+    uint32_t getNewestSequence() const { return newest_.load(); }
+
+    /// Oldest record still in the ring (0 = none)
+    uint32_t getOldestSequence() const;
+
+    /// Counters and state ("band", "recorded", "dropped", ...) as members of the open object
+    void writeJson(JsonWriter& json) const;
+
+private:
+    bool create();
+
+    EngineJournal journal_;
+    EngineJournalIndex index_;
+    std::atomic<uint32_t> newest_;
+    uint32_t writes_;                ///< save() calls that wrote records
+    uint32_t writeErrors_;
+    uint32_t lastWriteUs_;           ///< Duration of the last save()
+    uint16_t recovered_;             ///< Records found by begin()
+    bool ready_;
+};
+
+#endif // ENGINE_JOURNAL_STORE_H
@@ -0,0 +1,104 @@
+/**
+ * @file EngineJournalWebServer.cpp
+ * @brief Implementation of the engine journal endpoint
+ *
+ * @see EngineJournalWebServer.h
+ */
+
+#include "EngineJournalWebServer.h"
+#include "../utils/JsonWriter.h"
+#include "../utils/ScratchArena.h"
+
+namespace {
+
+// At most ~112 bytes per record plus the counters; body and records share the HTTP scratch arena
+constexpr size_t JOURNAL_RESPONSE_BYTES = 2560;
+
+static_assert(ENGINE_JOURNAL_QUERY_MAX * 112 + 320 <= JOURNAL_RESPONSE_BYTES,
+              "ENGINE_JOURNAL_QUERY_MAX records do not fit the response buffer");
+
+const char* const SCRATCH_EXHAUSTED = "{\"status\":\"error\",\"message\":\"Scratch memory exhausted\"}";
+
+/// Optional unsigned parameter @p name into @p value; false if present but not a number
+bool readU32(AsyncWebServerRequest* request, const char* name, uint32_t& value) {
+    if (!request->hasParam(name)) {
+        return true;
+    }
+    const String& text = request->getParam(name)->value();  // No copy
+    char* end = nullptr;
+    unsigned long parsed = strtoul(text.c_str(), &end, 10);
+    if (text.length() == 0 || end == nullptr || *end != '\0') {
+        return false;
+    }
+    value = static_cast<uint32_t>(parsed);
+    return true;
+}
+
+}  // namespace
+
+EngineJournalWebServer::EngineJournalWebServer(EngineJournalStore* journalStore)
+    : store(journalStore) {
+}
+
+void EngineJournalWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || store == nullptr) {
+        return;
+    }
+
+    // GET /journal/engine[?after=<seq>][&from=<utc_s>][&to=<utc_s>] - One page of journal records
+    server->on("/journal/engine", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetJournal(request);
+    });
+}
+
+void EngineJournalWebServer::handleGetJournal(AsyncWebServerRequest* request) {
+    uint32_t after = 0;
+    uint32_t from = 0;
+    uint32_t to = UINT32_MAX;
+    if (!readU32(request, "after", after) || !readU32(request, "from", from) ||
+        !readU32(request, "to", to) || from > to) {
+        request->send(400, "application/json",
+                      "{\"status\":\"error\",\"message\":\"after, from and to must be numbers, from <= to\"}");
+        return;
+    }
+
+    ScratchScope scratch(GetHttpArena());
+    char* body = scratch.arena().allocArray<char>(JOURNAL_RESPONSE_BYTES);
+    EngineJournalRecord* records = scratch.arena().allocArray<EngineJournalRecord>(ENGINE_JOURNAL_QUERY_MAX);
+    if (body == nullptr || records == nullptr) {
+        request->send(503, "application/json", SCRATCH_EXHAUSTED);
+        return;
+    }
+
+    uint32_t next = 0;
+    uint8_t count = store->query(after, from, to, records, ENGINE_JOURNAL_QUERY_MAX, next);
+
+    JsonWriter json(body, JOURNAL_RESPONSE_BYTES);
+    json.beginObject();
+    store->writeJson(json);
+    json.beginArray("records");
+    for (uint8_t i = 0; i < count; i++) {
+        const EngineJournalRecord& record = records[i];
+        json.beginObject()
+            .add("seq", (unsigned long)record.sequence)
+            .add("time", (unsigned long)record.time)
+            .add("utc", record.utc)
+            .add("event", EngineJournalEventName(record.event))
+            .add("detail", (unsigned int)record.detail)
+            .add("rpm", (unsigned int)record.rpm);
+        if (record.oilDeciC == ENGINE_JOURNAL_NO_TEMPERATURE) {
+            json.add("oil_c", (const char*)nullptr);
+        } else {
+            json.add("oil_c", record.oilDeciC / 10.0, 1);
+        }
+        json.endObject();
+    }
+    json.endArray();
+    if (next == 0) {
+        json.add("next", (const char*)nullptr);
+    } else {
+        json.add("next", (unsigned long)next);
+    }
+    json.endObject();
+    request->send(200, "application/json", json.c_str());
+}
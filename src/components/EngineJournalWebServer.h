@@ -0,0 +1,65 @@
+/**
+ * @file EngineJournalWebServer.h
+ * @brief HTTP endpoint reading the engine and saildrive event journal
+ *
+ * Provides:
+ * - GET /journal/engine[?after=<seq>][&from=<utc_s>][&to=<utc_s>]: One page of records
+ *
+ * A page holds at most ENGINE_JOURNAL_QUERY_MAX records, oldest first.
+ * Pass "next" back as after= for the following page (null = done). With
+ * from/to only records with a UTC time in that range are returned;
+ * records of a boot without UTC (seconds since boot) only show without a
+ * range. Records still waiting for the write-behind save are counted in
+ * "pending" and appear once written.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef ENGINE_JOURNAL_WEB_SERVER_H
+#define ENGINE_JOURNAL_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "EngineJournalStore.h"
+
+/**
+ * @brief Web server route for the engine journal
+ */
+class EngineJournalWebServer {
+private:
+    EngineJournalStore* store;
+
+    /**
+     * @brief Handle GET /journal/engine
+     *
+     * {"ready":true,"band":2,"recorded":41,"dropped":0,"pending":0,"oldest":1,"newest":41,
+     *  "recovered":38,"writes":12,"write_errors":0,"last_write_us":910,
+     *  "records":[{"seq":39,"time":1760451200,"utc":true,"event":"engine_start","detail":1,
+     *              "rpm":820,"oil_c":41.5},...],
+     *  "next":null}
+     *
+     * 400 for a non-numeric parameter or from > to, 503 without scratch memory.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetJournal(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param journalStore Journal written by the main loop
+     */
+    explicit EngineJournalWebServer(EngineJournalStore* journalStore);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // ENGINE_JOURNAL_WEB_SERVER_H
@@ -0,0 +1,161 @@
+/**
+ * @file HistoryRecorder.cpp
+ * @brief Implementation of the BoatData field history
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "HistoryRecorder.h"
+#include <string.h>
+#include "../utils/BoatDataSchema.h"
+#include "../utils/BufferPlacement.h"
+
+namespace {
+
+struct FieldInfo {
+    const char* name;
+    uint8_t schemaField;  ///< BoatDataFieldId of the recorded value
+    float scale;          ///< Value of one stored step
+    bool circular;
+};
+
+const FieldInfo FIELDS[HISTORY_FIELD_COUNT] = {
+    {"depth", BOATDATA_FIELD_DST_DEPTH, 0.01f, false},
+    {"tws", BOATDATA_FIELD_DERIVED_TWS, 0.01f, false},
+    {"heading", BOATDATA_FIELD_COMPASS_MAGNETIC_HEADING, 0.001f, true},
+    {"battery_a", BOATDATA_FIELD_BATTERY_VOLTAGE_A, 0.01f, false},
+    {"boat_speed", BOATDATA_FIELD_DERIVED_STW, 0.01f, false},
+    {"sog", BOATDATA_FIELD_GPS_SOG, 0.01f, false},
+    {"aws", BOATDATA_FIELD_WIND_AWS, 0.01f, false},
+    {"battery_b", BOATDATA_FIELD_BATTERY_VOLTAGE_B, 0.01f, false},
+};
+
+const uint32_t TIER_PERIOD_MS[HistorySeries::TIER_COUNT] = {
+    HISTORY_TIER0_PERIOD_MS, HISTORY_TIER1_PERIOD_MS, HISTORY_TIER2_PERIOD_MS
+};
+
+}  // namespace
+
+HistoryRecorder::HistoryRecorder() : storage_(nullptr), storageBytes_(0), psram_(false) {
+    for (uint8_t i = 0; i < HISTORY_FIELD_COUNT; i++) {
+        enabled_[i] = false;
+    }
+}
+
+bool HistoryRecorder::begin(WebSocketLogger* logger) {
+    if (storage_ != nullptr) {
+        return true;
+    }
+
+    uint8_t fieldCount = 0;
+    for (uint8_t i = 0; i < HISTORY_FIELD_COUNT; i++) {
+        if (HISTORY_FIELD_MASK & (1u << i)) {
+            fieldCount++;
+        }
+    }
+    if (fieldCount == 0) {
+        return false;
+    }
+
+    uint16_t capacity[HistorySeries::TIER_COUNT] = {
+        HISTORY_TIER0_CAPACITY, HISTORY_TIER1_CAPACITY, HISTORY_TIER2_CAPACITY
+    };
+    uint16_t reduced[HistorySeries::TIER_COUNT];
+    for (uint8_t t = 0; t < HistorySeries::TIER_COUNT; t++) {
+        // No PSRAM: same periods, shorter history
+        reduced[t] = static_cast<uint16_t>(capacity[t] / HISTORY_INTERNAL_RAM_DIVISOR);
+        if (reduced[t] == 0) {
+            reduced[t] = 1;
+        }
+    }
+    const size_t fullBytes = HistorySeries::storageBytes(capacity) * fieldCount;
+    const size_t reducedBytes = HistorySeries::storageBytes(reduced) * fieldCount;
+
+    uint32_t bytes = 0;
+    BufferRegion region = BufferRegion::NONE;
+    storage_ = GetBufferPlacement().placeBytes("history", 1, 4, static_cast<uint32_t>(fullBytes),
+                                               static_cast<uint32_t>(reducedBytes), bytes, &region);
+    psram_ = region == BufferRegion::PSRAM;
+    if (storage_ == nullptr) {
+        if (logger != nullptr) {
+            logger->broadcastLogf(LogLevel::ERROR, LogComponent::HISTORY_RECORDER, LogEvent::HISTORY_ALLOC_FAILED,
+                "{\"bytes\":%u}", (unsigned)reducedBytes);
+        }
+        return false;
+    }
+    if (!psram_) {
+        memcpy(capacity, reduced, sizeof(capacity));
+    }
+    storageBytes_ = bytes;
+
+    const size_t seriesBytes = HistorySeries::storageBytes(capacity);
+    uint8_t* slot = static_cast<uint8_t*>(storage_);
+    for (uint8_t i = 0; i < HISTORY_FIELD_COUNT; i++) {
+        if (!(HISTORY_FIELD_MASK & (1u << i))) {
+            continue;
+        }
+        enabled_[i] = series_[i].begin(slot, capacity, TIER_PERIOD_MS, FIELDS[i].scale, FIELDS[i].circular);
+        slot += seriesBytes;
+    }
+
+    if (logger != nullptr) {
+        logger->broadcastLogf(LogLevel::INFO, LogComponent::HISTORY_RECORDER, LogEvent::HISTORY_READY,
+            "{\"fields\":%u,\"bytes\":%u,\"psram\":%s,\"capacity\":[%u,%u,%u]}",
+            (unsigned)fieldCount, (unsigned)bytes, psram_ ? "true" : "false",
+            (unsigned)capacity[0], (unsigned)capacity[1], (unsigned)capacity[2]);
+    }
+    return true;
+}
+
+void HistoryRecorder::sample(const BoatDataStructure& data, uint32_t nowMs) {
+    if (storage_ == nullptr) {
+        return;
+    }
+    for (uint8_t i = 0; i < HISTORY_FIELD_COUNT; i++) {
+        if (!enabled_[i]) {
+            continue;
+        }
+        float value;
+        if (readField(i, data, nowMs, value)) {
+            series_[i].addSample(value, nowMs);
+        } else {
+            series_[i].advance(nowMs);  // Gap
+        }
+    }
+}
+
+const HistorySeries* HistoryRecorder::getSeries(uint8_t field) const {
+    if (field >= HISTORY_FIELD_COUNT || !enabled_[field]) {
+        return nullptr;
+    }
+    return &series_[field];
+}
+
+uint8_t HistoryRecorder::findField(const char* name) {
+    if (name == nullptr) {
+        return HISTORY_FIELD_COUNT;
+    }
+    for (uint8_t i = 0; i < HISTORY_FIELD_COUNT; i++) {
+        if (strcmp(name, FIELDS[i].name) == 0) {
+            return i;
+        }
+    }
+    return HISTORY_FIELD_COUNT;
+}
+
+const char* HistoryRecorder::fieldName(uint8_t field) {
+    return field < HISTORY_FIELD_COUNT ? FIELDS[field].name : "";
+}
+
+const char* HistoryRecorder::fieldUnit(uint8_t field) {
+    return field < HISTORY_FIELD_COUNT ? BoatDataSchema::fieldInfo(FIELDS[field].schemaField).unit : "";
+}
+
+bool HistoryRecorder::readField(uint8_t field, const BoatDataStructure& data, uint32_t nowMs, float& value) {
+    uint8_t id = FIELDS[field].schemaField;
+    uint8_t group = BoatDataSchema::fieldInfo(id).group;
+    value = static_cast<float>(BoatDataSchema::getValue(data, id));
+    return BoatDataSchema::isAvailable(data, group) &&
+           nowMs - static_cast<uint32_t>(BoatDataSchema::lastUpdate(data, group)) <= HISTORY_STALE_MS;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file HistoryRecorder.h
+ * @brief Time-series history of selected BoatData fields for trend graphs
+ *
+ * Keeps one HistorySeries (1 s / 10 s / 60 s min/max/mean tiers) per field
+ * enabled in HISTORY_FIELD_MASK, so the web UI can draw depth, wind or
+ * battery trends without polling /boatdata at full rate:
+ *
+ *   tier 0: HISTORY_TIER0_CAPACITY x 1 s   (10 min)
+ *   tier 1: HISTORY_TIER1_CAPACITY x 10 s  (1 h)
+ *   tier 2: HISTORY_TIER2_CAPACITY x 60 s  (24 h)
+ *
+ * All series share one block placed once by begin() (BufferPlacement): in PSRAM when the
+ * board has it, otherwise in internal RAM with every capacity divided by
+ * HISTORY_INTERNAL_RAM_DIVISOR (shorter history, same periods).
+ *
+ * Values, units and freshness come from the BoatDataSchema field table.
+ * sample() runs on the main loop (the BoatData writer), so it reads the
+ * structure directly. A field whose group is unavailable or older than
+ * HISTORY_STALE_MS records a gap.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): single allocation at startup, sized by config.h
+ * - Principle VII (Fail-Safe): no PSRAM degrades to a shorter history, not to none
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef HISTORY_RECORDER_H
+#define HISTORY_RECORDER_H
+
+#include <Arduino.h>
+#include "../config.h"
+#include "../types/BoatDataTypes.h"
+#include "../utils/HistorySeries.h"
+#include "../utils/WebSocketLogger.h"
+
+/**
+ * @brief Fields that can be recorded (bit positions of HISTORY_FIELD_MASK)
+ */
+enum HistoryField : uint8_t {
+    HISTORY_FIELD_DEPTH = 0,        ///< BOATDATA_FIELD_DST_DEPTH, m
+    HISTORY_FIELD_TWS = 1,          ///< BOATDATA_FIELD_DERIVED_TWS, kn
+    HISTORY_FIELD_HEADING = 2,      ///< BOATDATA_FIELD_COMPASS_MAGNETIC_HEADING, rad (circular)
+    HISTORY_FIELD_BATTERY_A = 3,    ///< BOATDATA_FIELD_BATTERY_VOLTAGE_A, V
+    HISTORY_FIELD_BOAT_SPEED = 4,   ///< BOATDATA_FIELD_DERIVED_STW, kn
+    HISTORY_FIELD_SOG = 5,          ///< BOATDATA_FIELD_GPS_SOG, kn
+    HISTORY_FIELD_AWS = 6,          ///< BOATDATA_FIELD_WIND_AWS, kn
+    HISTORY_FIELD_BATTERY_B = 7,    ///< BOATDATA_FIELD_BATTERY_VOLTAGE_B, V
+    HISTORY_FIELD_COUNT = 8
+};
+
+/**
+ * @class HistoryRecorder
+ * @brief Owns the history series and their storage
+ *
+ * Usage pattern:
+ * @code
+ * historyRecorder.begin(&logger);
+ * app.onRepeat(HISTORY_SAMPLE_INTERVAL_MS, []() {
+ *     historyRecorder.sample(*boatData->getDataStructure(), millis());
+ * });
+ * @endcode
+ */
+class HistoryRecorder {
+public:
+    HistoryRecorder();
+
+    /**
+     * @brief Allocate storage and set up the enabled series
+     *
+     * @param logger Logger for HISTORY_READY / HISTORY_ALLOC_FAILED
+     * @return false if no field is enabled or allocation failed
+     */
+    bool begin(WebSocketLogger* logger);
+
+    /**
+     * @brief Record the current value of every enabled field
+     *
+     * @param data BoatData structure (main loop only)
+     * @param nowMs millis()
+     */
+    void sample(const BoatDataStructure& data, uint32_t nowMs);
+
+    /**
+     * @brief Series of @p field, or nullptr if it is not recorded
+     */
+    const HistorySeries* getSeries(uint8_t field) const;
+
+    /**
+     * @brief Field index for a name ("depth", "tws", ...), or HISTORY_FIELD_COUNT
+     */
+    static uint8_t findField(const char* name);
+
+    /// Name used by the /history routes
+    static const char* fieldName(uint8_t field);
+
+    /// Unit of the stored values (schema unit: "m", "kn", "rad", "V")
+    static const char* fieldUnit(uint8_t field);
+
+    bool isReady() const { return storage_ != nullptr; }
+
+    /// History block in PSRAM (false: internal RAM, reduced capacities)
+    bool inPsram() const { return psram_; }
+
+    size_t getStorageBytes() const { return storageBytes_; }
+
+private:
+    HistorySeries series_[HISTORY_FIELD_COUNT];
+    bool enabled_[HISTORY_FIELD_COUNT];
+    void* storage_;
+    size_t storageBytes_;
+    bool psram_;
+
+    /**
+     * @brief Current value of @p field
+     *
+     * @return false if the field's group is unavailable or stale
+     */
+    static bool readField(uint8_t field, const BoatDataStructure& data, uint32_t nowMs, float& value);
+};
+
+#endif // HISTORY_RECORDER_H
@@ -0,0 +1,146 @@
+/**
+ * @file HistoryWebServer.cpp
+ * @brief Implementation of the field history endpoints
+ *
+ * @see HistoryWebServer.h
+ */
+
+#include "HistoryWebServer.h"
+#include <string.h>
+#include "../utils/JsonWriter.h"
+
+namespace {
+
+const size_t HEADER_SIZE = 24;
+const uint16_t CHUNK_BUCKETS = 64;  ///< Buckets per write (stack buffer of 128 bytes)
+
+void putU16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void putU32(uint8_t* out, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+}  // namespace
+
+HistoryWebServer::HistoryWebServer(const HistoryRecorder* historyRecorder) : recorder(historyRecorder) {
+}
+
+void HistoryWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || recorder == nullptr) {
+        return;
+    }
+
+    // GET /history/series - Binary min/max/mean buckets of one field and tier
+    // (registered first: "/history" also matches "/history/series" as a prefix)
+    server->on("/history/series", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetSeries(request);
+    });
+
+    // GET /history - Recorded fields and tiers
+    server->on("/history", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetIndex(request);
+    });
+}
+
+void HistoryWebServer::handleGetIndex(AsyncWebServerRequest* request) {
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+    response->printf("{\"psram\":%s,\"bytes\":%u,\"fields\":[",
+        recorder->inPsram() ? "true" : "false", (unsigned)recorder->getStorageBytes());
+
+    bool first = true;
+    for (uint8_t i = 0; i < HISTORY_FIELD_COUNT; i++) {
+        const HistorySeries* series = recorder->getSeries(i);
+        if (series == nullptr) {
+            continue;
+        }
+
+        StaticJsonWriter<384> item;
+        item.beginObject()
+            .add("name", HistoryRecorder::fieldName(i))
+            .add("unit", HistoryRecorder::fieldUnit(i))
+            .add("scale", static_cast<double>(series->scale()), 3)
+            .add("circular", series->isCircular())
+            .beginArray("tiers");
+        for (uint8_t t = 0; t < HistorySeries::TIER_COUNT; t++) {
+            item.beginObject()
+                .add("period_ms", (unsigned long)series->periodMs(t))
+                .add("capacity", (unsigned)series->capacity(t))
+                .add("count", (unsigned)series->size(t))
+                .endObject();
+        }
+        item.endArray().endObject();
+
+        if (!first) {
+            response->print(',');
+        }
+        response->print(item.c_str());
+        first = false;
+    }
+
+    response->print("]}");
+    request->send(response);
+}
+
+void HistoryWebServer::handleGetSeries(AsyncWebServerRequest* request) {
+    if (!request->hasParam("field") || !request->hasParam("tier")) {
+        sendResult(request, 400, "field and tier required");
+        return;
+    }
+    const String& tierParam = request->getParam("tier")->value();  // No copy
+    if (tierParam.length() != 1 || tierParam[0] < '0' || tierParam[0] >= '0' + HistorySeries::TIER_COUNT) {
+        sendResult(request, 400, "tier must be 0, 1 or 2");
+        return;
+    }
+    uint8_t tier = static_cast<uint8_t>(tierParam[0] - '0');
+    uint8_t field = HistoryRecorder::findField(request->getParam("field")->value().c_str());
+    const HistorySeries* series = recorder->getSeries(field);
+    if (series == nullptr) {
+        sendResult(request, 404, "field not recorded");
+        return;
+    }
+
+    // Header and count are taken once; buckets closed after this are left for the next request
+    uint16_t count = series->size(tier);
+    uint32_t age = millis() - series->currentBucketStartMs(tier);
+    float scale = series->scale();
+    uint32_t scaleBits;
+    memcpy(&scaleBits, &scale, sizeof(scaleBits));
+
+    uint8_t header[HEADER_SIZE] = {'P', '2', 'H', 'S'};
+    header[4] = HISTORY_SERIES_FORMAT_VERSION;
+    header[5] = tier;
+    header[6] = series->isCircular() ? 0x01 : 0x00;
+    putU32(header + 8, series->periodMs(tier));
+    putU32(header + 12, scaleBits);
+    putU32(header + 16, age);
+    putU16(header + 20, count);
+
+    AsyncResponseStream* response = request->beginResponseStream("application/octet-stream");
+    response->write(header, HEADER_SIZE);
+
+    // Struct-of-arrays body: all minima, all maxima, all means
+    uint8_t chunk[CHUNK_BUCKETS * sizeof(int16_t)];
+    for (uint8_t array = 0; array < 3; array++) {
+        for (uint16_t start = 0; start < count; start += CHUNK_BUCKETS) {
+            uint16_t n = count - start < CHUNK_BUCKETS ? count - start : CHUNK_BUCKETS;
+            for (uint16_t k = 0; k < n; k++) {
+                int16_t values[3] = {HISTORY_NO_DATA, HISTORY_NO_DATA, HISTORY_NO_DATA};
+                series->read(tier, static_cast<uint16_t>(start + k), values[0], values[1], values[2]);
+                putU16(chunk + 2 * k, static_cast<uint16_t>(values[array]));
+            }
+            response->write(chunk, 2 * n);
+        }
+    }
+    request->send(response);
+}
+
+void HistoryWebServer::sendResult(AsyncWebServerRequest* request, int code, const char* status) {
+    StaticJsonWriter<96> json;
+    json.beginObject().add("status", status).endObject();
+    request->send(code, "application/json", json.c_str());
+}
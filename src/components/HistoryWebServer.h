@@ -0,0 +1,93 @@
+/**
+ * @file HistoryWebServer.h
+ * @brief HTTP endpoints serving the BoatData field history
+ *
+ * Provides:
+ * - GET /history: Recorded fields and their tiers (JSON)
+ * - GET /history/series?field=<name>&tier=0|1|2: One tier of one field (binary)
+ *
+ * Binary series format (little-endian), a 24-byte header followed by three
+ * int16 arrays of @c count buckets each, oldest first:
+ *
+ * | Offset | Size | Field                                                   |
+ * |--------|------|---------------------------------------------------------|
+ * | 0      | 4    | Magic "P2HS"                                            |
+ * | 4      | 1    | Format version (HISTORY_SERIES_FORMAT_VERSION)          |
+ * | 5      | 1    | Tier                                                    |
+ * | 6      | 1    | Flags: bit 0 = circular (radians, [0, 2π))              |
+ * | 7      | 1    | Reserved (0)                                            |
+ * | 8      | 4    | Bucket period, ms                                       |
+ * | 12     | 4    | Scale, float32 (value = stored * scale)                 |
+ * | 16     | 4    | Age of the newest bucket's end, ms (0 = ends now)       |
+ * | 20     | 2    | count                                                   |
+ * | 22     | 2    | Reserved (0)                                            |
+ * | 24     | 2n   | min[count], then max[count], then mean[count]           |
+ *
+ * A stored value of -32768 (HISTORY_NO_DATA) is a bucket without data.
+ * The series is copied while the main loop keeps recording, so a bucket
+ * closed during the copy may be missed; the next request catches up.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef HISTORY_WEB_SERVER_H
+#define HISTORY_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "HistoryRecorder.h"
+
+/// Version byte of the /history/series format
+#define HISTORY_SERIES_FORMAT_VERSION 1
+
+/**
+ * @brief Web server routes for the field history
+ */
+class HistoryWebServer {
+private:
+    const HistoryRecorder* recorder;
+
+    /**
+     * @brief Handle GET /history
+     *
+     * Returns:
+     * {
+     *   "psram": true, "bytes": 57600,
+     *   "fields": [{"name": "depth", "unit": "m", "scale": 0.01, "circular": false,
+     *               "tiers": [{"period_ms": 1000, "capacity": 600, "count": 412}, ...]}, ...]
+     * }
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetIndex(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle GET /history/series
+     *
+     * 400 on a missing or invalid tier, 404 on a field that is not recorded.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetSeries(AsyncWebServerRequest* request);
+
+    static void sendResult(AsyncWebServerRequest* request, int code, const char* status);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param historyRecorder Recorder whose series are served
+     */
+    explicit HistoryWebServer(const HistoryRecorder* historyRecorder);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // HISTORY_WEB_SERVER_H
@@ -0,0 +1,88 @@
+/**
+ * @file ImuAttitudeSource.cpp
+ * @brief Implementation of the onboard IMU attitude source
+ *
+ * @see ImuAttitudeSource.h
+ */
+
+#include "ImuAttitudeSource.h"
+
+ImuAttitudeSource::ImuAttitudeSource(Icm20948* imu, BoatData* boatData)
+    : imu_(imu),
+      boatData_(boatData),
+      registered_(false),
+      present_(false),
+      batches_(0),
+      samples_(0),
+      lastBatch_(0),
+      maxBatch_(0),
+      stored_(0),
+      dropped_(0) {
+}
+
+bool ImuAttitudeSource::begin() {
+    present_ = imu_ != nullptr && imu_->begin(IMU_SAMPLE_RATE_HZ);
+    return present_;
+}
+
+uint8_t ImuAttitudeSource::poll() {
+    if (!present_) {
+        return 0;
+    }
+
+    uint8_t count = imu_->readBatch(batch_, IMU_BATCH_MAX);
+    lastBatch_ = count;
+    if (count == 0) {
+        return 0;
+    }
+    if (count > maxBatch_) {
+        maxBatch_ = count;
+    }
+    batches_++;
+    samples_ += count;
+
+    double dt = imu_->getSamplePeriodS();
+    for (uint8_t i = 0; i < count; i++) {
+        filter_.update(batch_[i], dt);
+    }
+    if (!filter_.isValid() || boatData_ == nullptr) {
+        return count;
+    }
+
+    if (!registered_) {
+        // Competes with NMEA2000 attitude senders (N2kSourceGroup::ATTITUDE)
+        source_ = boatData_->registerSource("IMU", SensorType::ATTITUDE, ProtocolType::I2C);
+        registered_ = true;
+    }
+    if (boatData_->updateAttitude(source_, filter_.getHeel(), filter_.getPitch())) {
+        stored_++;
+    } else {
+        dropped_++;
+    }
+    return count;
+}
+
+void ImuAttitudeSource::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("present", present_);
+    if (present_) {
+        json.add("rate_hz", imu_->getSampleRateHz(), 1)
+            .add("heel", filter_.getHeel(), 4)
+            .add("pitch", filter_.getPitch(), 4)
+            .add("batches", (unsigned long)batches_)
+            .add("samples", (unsigned long)samples_)
+            .add("last_batch", (unsigned int)lastBatch_)
+            .add("max_batch", (unsigned int)maxBatch_)
+            .add("transactions", (unsigned long)imu_->getTransactions())
+            .add("overflows", (unsigned long)imu_->getOverflows())
+            .add("errors", (unsigned long)imu_->getErrors())
+            .add("accel_rejected", (unsigned long)filter_.getRejected())
+            .add("stored", (unsigned long)stored_)
+            .add("dropped", (unsigned long)dropped_);
+    }
+    json.endObject();
+}
@@ -0,0 +1,101 @@
+/**
+ * @file ImuAttitudeSource.h
+ * @brief Heel and pitch from the onboard ICM-20948, arbitrated as an attitude source
+ *
+ * Every IMU_READ_INTERVAL_MS the main loop drains the IMU FIFO in one burst
+ * (Icm20948::readBatch()), runs each sample through the AttitudeFilter at
+ * the sensor's own sample period, and stores the filtered angles once per
+ * batch with BoatData::updateAttitude(). calculateAWAHeel() then corrects
+ * apparent wind with a heel sampled at 100 Hz instead of the last PGN
+ * 127257.
+ *
+ * The source registers as "IMU" (SensorType::ATTITUDE, ProtocolType::I2C)
+ * on the first batch. An N2k attitude sender (heel/pitch PGN 127257) competes
+ * with it in the same sensor type: whichever the prioritizer makes active
+ * supplies the angles, the other one's updates are dropped. Attitude is not
+ * blended in fusion mode. The filter keeps running while the IMU is
+ * inactive, so it is converged the moment it takes over.
+ *
+ * Arduino-free (unit tested natively). Main loop only.
+ *
+ * Usage:
+ * @code
+ * ImuAttitudeSource source(&imu, boatData);
+ * if (source.begin()) {
+ *     app.onRepeat(IMU_READ_INTERVAL_MS, []() { source.poll(); });
+ * }
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef IMU_ATTITUDE_SOURCE_H
+#define IMU_ATTITUDE_SOURCE_H
+
+#include <stdint.h>
+#include "BoatData.h"
+#include "../utils/AttitudeFilter.h"
+#include "../utils/Icm20948.h"
+#include "../utils/JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @class ImuAttitudeSource
+ * @brief FIFO drain, attitude filter and BoatData update for the onboard IMU
+ */
+class ImuAttitudeSource {
+public:
+    ImuAttitudeSource(Icm20948* imu, BoatData* boatData);
+
+    /**
+     * @brief Probe and configure the IMU at IMU_SAMPLE_RATE_HZ
+     *
+     * @return false if no ICM-20948 answered (poll() then does nothing)
+     */
+    bool begin();
+
+    /// The IMU answered begin()
+    bool isPresent() const { return present_; }
+
+    /**
+     * @brief Drain one batch, filter it and store the angles
+     *
+     * @return Samples read
+     */
+    uint8_t poll();
+
+    const AttitudeFilter& getFilter() const { return filter_; }
+
+    /// Batches whose angles BoatData accepted (the IMU was the active attitude source)
+    uint32_t getStored() const { return stored_; }
+
+    /// Batches dropped because another attitude source was active
+    uint32_t getDropped() const { return dropped_; }
+
+    /**
+     * @brief Write the IMU state as a JSON object
+     *
+     * {"present":true,"rate_hz":102.3,"heel":0.0524,"pitch":-0.0087,"batches":1200,
+     *  "samples":12273,"last_batch":10,"max_batch":11,"transactions":2411,
+     *  "overflows":0,"errors":0,"accel_rejected":14,"stored":1200,"dropped":0}
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    Icm20948* imu_;
+    BoatData* boatData_;
+    BoatDataSourceHandle source_;   ///< "IMU", registered on the first batch
+    AttitudeFilter filter_;
+    ImuSample batch_[IMU_BATCH_MAX];
+    bool registered_;
+    bool present_;
+    uint32_t batches_;
+    uint32_t samples_;
+    uint8_t lastBatch_;
+    uint8_t maxBatch_;
+    uint32_t stored_;
+    uint32_t dropped_;
+};
+
+#endif // IMU_ATTITUDE_SOURCE_H
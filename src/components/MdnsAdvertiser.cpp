@@ -0,0 +1,82 @@
+/**
+ * @file MdnsAdvertiser.cpp
+ * @brief Implementation of the mDNS responder owner
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "MdnsAdvertiser.h"
+#include <mdns.h>
+
+MdnsAdvertiser::MdnsAdvertiser()
+    : logger(nullptr), started(false) {
+}
+
+bool MdnsAdvertiser::begin(const MdnsAdvertConfig& config, WebSocketLogger* log) {
+    if (log == nullptr || started) {
+        return false;
+    }
+    logger = log;
+
+    esp_err_t err = mdns_init();
+    if (err == ESP_OK) {
+        err = mdns_hostname_set(MDNS_HOSTNAME);
+    }
+    if (err == ESP_OK) {
+        err = mdns_instance_name_set(MDNS_INSTANCE_NAME);
+    }
+    if (err != ESP_OK) {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::MDNS, LogEvent::MDNS_FAILED,
+            "{\"step\":\"init\",\"error\":%d}", (int)err);
+        return false;
+    }
+    started = true;
+
+    advertisement.build(config);
+    if (!publish()) {
+        return false;
+    }
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::MDNS, LogEvent::MDNS_STARTED,
+        "{\"hostname\":\"%s.local\",\"services\":%u,\"fingerprint\":\"%08lx\"}",
+        MDNS_HOSTNAME, (unsigned)advertisement.getServiceCount(),
+        (unsigned long)advertisement.getFingerprint());
+    return true;
+}
+
+bool MdnsAdvertiser::update(const MdnsAdvertConfig& config) {
+    if (!started || !advertisement.build(config)) {
+        return false;
+    }
+    mdns_service_remove_all();
+    if (!publish()) {
+        return false;
+    }
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::MDNS, LogEvent::MDNS_TXT_UPDATED,
+        "{\"services\":%u,\"fingerprint\":\"%08lx\",\"changes\":%lu}",
+        (unsigned)advertisement.getServiceCount(), (unsigned long)advertisement.getFingerprint(),
+        (unsigned long)advertisement.getChanges());
+    return true;
+}
+
+bool MdnsAdvertiser::publish() {
+    bool ok = true;
+    mdns_txt_item_t txt[MDNS_TXT_MAX_ITEMS];
+    for (uint8_t i = 0; i < advertisement.getServiceCount(); i++) {
+        const MdnsServiceRecord* service = advertisement.getService(i);
+        for (uint8_t t = 0; t < service->count; t++) {
+            txt[t].key = service->items[t].key;
+            txt[t].value = service->items[t].value;
+        }
+        // The responder copies the items: the stack array only lives for the call
+        esp_err_t err = mdns_service_add(MDNS_INSTANCE_NAME, service->type, service->proto,
+                                         service->port, txt, service->count);
+        if (err != ESP_OK) {
+            logger->broadcastLogf(LogLevel::ERROR, LogComponent::MDNS, LogEvent::MDNS_FAILED,
+                "{\"step\":\"service\",\"service\":\"%s.%s\",\"error\":%d}",
+                service->type, service->proto, (int)err);
+            ok = false;
+        }
+    }
+    return ok;
+}
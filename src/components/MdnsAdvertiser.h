@@ -0,0 +1,71 @@
+/**
+ * @file MdnsAdvertiser.h
+ * @brief mDNS responder: <MDNS_HOSTNAME>.local and the DNS-SD services of MdnsAdvertisement
+ *
+ * Started once the network is up. The ESP-IDF responder owns the records
+ * it is handed and answers queries, probes and announcements in its own
+ * task, so serving a query never reaches this component or the main loop.
+ * update() rebuilds the TXT records (after a configuration change) and only
+ * passes them to the responder when the fingerprint moved: an unchanged
+ * rebuild costs one format pass and no network traffic.
+ *
+ * Address changes (reconnect, new DHCP lease) are re-announced by the
+ * responder itself.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): records formatted once into MdnsAdvertisement
+ * - Principle V (Network Debugging): MDNS_STARTED, MDNS_FAILED and MDNS_TXT_UPDATED log events
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef MDNS_ADVERTISER_H
+#define MDNS_ADVERTISER_H
+
+#include <Arduino.h>
+#include "../utils/MdnsAdvertisement.h"
+#include "../utils/WebSocketLogger.h"
+#include "../config.h"
+
+/**
+ * @class MdnsAdvertiser
+ * @brief Owner of the mDNS responder (main loop / WiFi event task)
+ *
+ * Usage pattern:
+ * @code
+ * mdnsAdvertiser.begin(mdnsConfig(), &logger);                     // once WiFi is up
+ * mdnsAdvertiser.update(mdnsConfig());                              // configuration applied
+ * @endcode
+ */
+class MdnsAdvertiser {
+public:
+    MdnsAdvertiser();
+
+    /**
+     * @brief Start the responder and register the services of @p config
+     * @param logger WebSocket logger for start and failure events
+     * @return false if logger is nullptr, already started, or the responder failed to start
+     */
+    bool begin(const MdnsAdvertConfig& config, WebSocketLogger* logger);
+
+    /**
+     * @brief Rebuild the records; re-register them only if they changed
+     * @return true if the responder got new records
+     */
+    bool update(const MdnsAdvertConfig& config);
+
+    bool isStarted() const { return started; }
+
+    const MdnsAdvertisement& getAdvertisement() const { return advertisement; }
+
+private:
+    /// Register every service with its TXT items
+    bool publish();
+
+    MdnsAdvertisement advertisement;
+    WebSocketLogger* logger;
+    bool started;
+};
+
+#endif // MDNS_ADVERTISER_H
@@ -0,0 +1,114 @@
+/**
+ * @file MemoryWebServer.cpp
+ * @brief Implementation of the memory report endpoint
+ *
+ * @see MemoryWebServer.h
+ */
+
+#include "MemoryWebServer.h"
+#include "../utils/AllocTracker.h"
+#include "../utils/BufferPlacement.h"
+#include "../utils/JsonWriter.h"
+#include "../utils/ScratchArena.h"
+#include "../utils/StaticInstance.h"
+#include "../utils/WsBufferPool.h"
+
+// Section bounds from the ESP-IDF linker script
+extern int _data_start, _data_end, _bss_start, _bss_end;
+
+MemoryWebServer::MemoryWebServer(const MemoryBudget* memoryBudget, const TaskMonitor* taskMonitor,
+                                 const HeapMonitor* heapMonitor, uint32_t freeHeapAtBoot)
+    : budget(memoryBudget), tasks(taskMonitor), heap(heapMonitor), bootFreeHeap(freeHeapAtBoot) {
+}
+
+void MemoryWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || budget == nullptr) {
+        return;
+    }
+
+    // GET /memory - Reservations per component, heap and stack watermarks
+    server->on("/memory", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetMemory(request);
+    });
+}
+
+void MemoryWebServer::handleGetMemory(AsyncWebServerRequest* request) {
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+
+    response->printf("{\"uptime_ms\":%lu,\"dram\":{\"data\":%lu,\"bss\":%lu,\"heap_total\":%lu,"
+        "\"heap_free_at_boot\":%lu},\"psram\":{\"size\":%lu,\"free\":%lu},\"components\":[",
+        (unsigned long)millis(),
+        (unsigned long)(reinterpret_cast<uintptr_t>(&_data_end) - reinterpret_cast<uintptr_t>(&_data_start)),
+        (unsigned long)(reinterpret_cast<uintptr_t>(&_bss_end) - reinterpret_cast<uintptr_t>(&_bss_start)),
+        (unsigned long)ESP.getHeapSize(), (unsigned long)bootFreeHeap,
+        (unsigned long)ESP.getPsramSize(), (unsigned long)ESP.getFreePsram());
+
+    for (uint8_t i = 0; i < budget->getCount(); i++) {
+        StaticJsonWriter<128> item;
+        budget->writeEntry(item, i);
+        if (i > 0) {
+            response->print(',');
+        }
+        response->print(item.c_str());
+    }
+
+    StaticJsonWriter<640> section;  // Largest: the task table, ~70 bytes per task
+    budget->writeTotals(section);
+    response->print("],\"totals\":");
+    response->print(section.c_str());
+
+    section.reset();
+    GetStaticFootprint().writeJson(section);
+    response->print(",\"static_instances\":");
+    response->print(section.c_str());
+
+    section.reset();
+    GetBufferPlacement().writeJson(section);
+    response->print(",\"placement\":");
+    response->print(section.c_str());
+
+    section.reset();
+    section.beginObject();
+    GetLoopArena().writeJson(section, "loop");
+    GetHttpArena().writeJson(section, "http");
+    section.endObject();
+    response->print(",\"scratch\":");
+    response->print(section.c_str());
+
+    section.reset();
+    GetWsBufferPool().writeJson(section);
+    response->print(",\"ws_pool\":");
+    response->print(section.c_str());
+
+    if (heap != nullptr) {
+        section.reset();
+        heap->writeJson(section);
+        response->print(",\"heap\":");
+        response->print(section.c_str());
+    }
+    if (tasks != nullptr) {
+        section.reset();
+        tasks->writeJson(section);
+        response->print(",\"stacks\":");
+        response->print(section.c_str());
+    }
+
+#if ALLOC_TRACK_ENABLED
+    // Streamed tag by tag (up to ALLOC_TRACK_MAX_TAGS objects)
+    const AllocTracker& allocs = GetAllocTracker();
+    response->printf(",\"allocs\":{\"untagged\":%lu,\"dropped\":%lu,\"tags\":[",
+        (unsigned long)allocs.getUntaggedAllocs(), (unsigned long)allocs.getDropped());
+    for (uint8_t i = 0; i < allocs.count(); i++) {
+        StaticJsonWriter<192> item;
+        AllocTracker::writeTagJson(item, *allocs.ranked(i));
+        if (i > 0) {
+            response->print(',');
+        }
+        response->print(item.c_str());
+    }
+    response->print("]}");
+#endif
+
+    response->print('}');
+    request->send(response);
+}
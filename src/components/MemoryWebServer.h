@@ -0,0 +1,88 @@
+/**
+ * @file MemoryWebServer.h
+ * @brief HTTP endpoint for the memory budget of this build
+ *
+ * Provides:
+ * - GET /memory: per-component reservations (MemoryBudget), the DRAM
+ *   sections, heap watermarks and per-task stack high-water marks; with
+ *   ALLOC_TRACK_ENABLED (test and soak builds) also "allocs", the
+ *   allocations per ALLOC_SCOPE() tag and per reaction (AllocTracker)
+ *
+ * Registered on the ConfigWebServer instance alongside the other stats
+ * endpoints. The response is streamed section by section, so its size does
+ * not depend on a fixed JSON document buffer.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef MEMORY_WEB_SERVER_H
+#define MEMORY_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "TaskMonitor.h"
+#include "../utils/MemoryBudget.h"
+#include "../utils/HeapMonitor.h"
+
+/**
+ * @brief Web server route for the memory report
+ */
+class MemoryWebServer {
+private:
+    const MemoryBudget* budget;
+    const TaskMonitor* tasks;
+    const HeapMonitor* heap;
+    uint32_t bootFreeHeap;
+
+    /**
+     * @brief Handle GET /memory
+     *
+     * Returns:
+     * {
+     *   "uptime_ms": 123456,
+     *   "dram": {"data": 14200, "bss": 61800, "heap_total": 290000, "heap_free_at_boot": 182000},
+     *   "psram": {"size": 4194252, "free": 4121000},
+     *   "components": [
+     *     {"name": "boat_data", "bytes": 2240, "region": "static"},
+     *     {"name": "log_ring", "bytes": 4352, "region": "static", "part_of": "logger"}, ...
+     *   ],
+     *   "totals": {"static": 41234, "rtc": 2100, "boot_heap": 26624, "psram": 62464, "stack_peak": 3072},
+     *   "static_instances": {"reserved_bytes": 5120, "slots": 25, "placed_bytes": 4980, "placed": 23},
+     *   "placement": {"buffers": [{"name": "trace_ring", "region": "psram", ...}], ...},
+     *   "scratch": {"loop": {"capacity": 2048, "used": 0, "high_water": 712, "overflows": 0, ...}, "http": {...}},
+     *   "ws_pool": {...}, "heap": {...}, "stacks": {"tasks": [...], "min_free": 1800, "min_task": "n2k_rx"}
+     * }
+     *
+     * dram.data/bss are the linker's section sizes (everything static in
+     * the image, not only the listed components). psram is 0/0 on boards
+     * without PSRAM. scratch.*.high_water is the most a single reaction
+     * (loop) or request (http) took from its arena; overflows counts
+     * allocations that did not fit.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetMemory(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param memoryBudget Listed reservations (filled at the end of setup())
+     * @param taskMonitor Registered tasks, optional
+     * @param heapMonitor Last heap sample (ESP32SystemMetrics::getHeapMonitor()), optional
+     * @param freeHeapAtBoot Free heap once setup() was done
+     */
+    MemoryWebServer(const MemoryBudget* memoryBudget, const TaskMonitor* taskMonitor,
+                    const HeapMonitor* heapMonitor, uint32_t freeHeapAtBoot);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // MEMORY_WEB_SERVER_H
@@ -20,9 +20,13 @@ void MetricsCollector::collectMetrics(DisplayMetrics* metrics) {
 
     // Query all system metrics via HAL interface
     metrics->freeRamBytes = _systemMetrics->getFreeHeapBytes();
+    metrics->largestFreeBlockBytes = _systemMetrics->getLargestFreeBlockBytes();
     metrics->sketchSizeBytes = _systemMetrics->getSketchSizeBytes();
     metrics->freeFlashBytes = _systemMetrics->getFreeFlashBytes();
     metrics->loopFrequency = _systemMetrics->getLoopFrequency();
+    metrics->cpuIdlePercent = _systemMetrics->getCpuIdlePercent();
+    metrics->coreIdlePercent[0] = _systemMetrics->getCoreIdlePercent(0);
+    metrics->coreIdlePercent[1] = _systemMetrics->getCoreIdlePercent(1);
 
     // Update timestamp
     metrics->lastUpdate = _systemMetrics->getMillis();
@@ -43,6 +43,7 @@ public:
      *
      * Queries all system metrics via ISystemMetrics interface:
      * - Free heap bytes (RAM)
+     * - Largest free heap block (fragmentation)
      * - Sketch size bytes (uploaded code size)
      * - Free flash bytes (available for OTA updates)
      * - CPU idle percentage (0-100)
@@ -0,0 +1,62 @@
+/**
+ * @file MetricsWebServer.cpp
+ * @brief Implementation of the Prometheus metrics endpoint
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "MetricsWebServer.h"
+
+MetricsWebServer::MetricsWebServer(MetricRegistry* metricRegistry, const TelemetryRegistry* telemetryRegistry)
+    : registry(metricRegistry), telemetry(telemetryRegistry), scrapes(), refused(0) {
+}
+
+void MetricsWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || registry == nullptr) {
+        return;
+    }
+
+    // GET /metrics - All counters and gauges for Prometheus
+    server->on("/metrics", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetMetrics(request);
+    });
+
+    // GET /stats - Telemetry snapshot of the last aggregation
+    if (telemetry != nullptr) {
+        server->on("/stats", HTTP_GET, [this](AsyncWebServerRequest* request) {
+            StaticJsonWriter<2048> json;  // ~65 bytes per counter, ~30 per gauge, ~80 per histogram
+            telemetry->writeJson(json);
+            request->send(200, "application/json", json.c_str());
+        });
+    }
+}
+
+void MetricsWebServer::handleGetMetrics(AsyncWebServerRequest* request) {
+    Scrape* scrape = nullptr;
+    for (uint8_t i = 0; i < METRICS_MAX_SCRAPES; i++) {
+        if (!scrapes[i].busy) {
+            scrape = &scrapes[i];
+            break;
+        }
+    }
+    if (scrape == nullptr) {
+        refused++;
+        request->send(503, "text/plain", "metrics scrape in progress\n");
+        return;
+    }
+
+    scrape->busy = true;
+    scrape->writer.begin(*registry);
+
+    // Released on close only: a slot reused after the last chunk could be freed by this request's close
+    AsyncWebServerResponse* response = request->beginChunkedResponse("text/plain; version=0.0.4",
+        [scrape](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            return scrape->writer.read(reinterpret_cast<char*>(buffer), maxLen);
+        });
+    response->addHeader("Cache-Control", "no-store");
+    request->onDisconnect([scrape]() {
+        scrape->busy = false;
+    });
+    request->send(response);
+}
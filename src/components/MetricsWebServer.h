@@ -0,0 +1,81 @@
+/**
+ * @file MetricsWebServer.h
+ * @brief HTTP endpoint for the metric registry in the Prometheus text format
+ *
+ * Provides:
+ * - GET /metrics: every registered counter and gauge (text/plain; version=0.0.4)
+ * - GET /stats: the TelemetryRegistry snapshot as JSON (totals, rates, quantiles)
+ *
+ * The body is a chunked response filled by a MetricWriter, one exposition
+ * line at a time, so a scrape needs one line buffer whatever the number of
+ * series. The writers are static (METRICS_MAX_SCRAPES): a scrape while all
+ * of them are in use is answered 503. A writer is released when its
+ * connection closes.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): no heap per scrape, bounded concurrency
+ * - Principle V (Network Debugging): Prometheus scrapes over WiFi
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef METRICS_WEB_SERVER_H
+#define METRICS_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../utils/MetricRegistry.h"
+#include "../utils/TelemetryRegistry.h"
+
+/**
+ * @brief Web server route for the Prometheus metrics
+ */
+class MetricsWebServer {
+private:
+    struct Scrape {
+        MetricWriter writer;
+        bool busy;
+    };
+
+    MetricRegistry* registry;
+    const TelemetryRegistry* telemetry;
+    Scrape scrapes[METRICS_MAX_SCRAPES];
+    uint32_t refused;
+
+    /**
+     * @brief Handle GET /metrics
+     *
+     * Returns:
+     * # HELP poseidon2_loop_frequency_hz Main loop iterations per second
+     * # TYPE poseidon2_loop_frequency_hz gauge
+     * poseidon2_loop_frequency_hz 412
+     * ...
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetMetrics(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param metricRegistry Families registered in setup()
+     * @param telemetryRegistry Snapshot served by GET /stats (nullptr = no route)
+     */
+    MetricsWebServer(MetricRegistry* metricRegistry, const TelemetryRegistry* telemetryRegistry = nullptr);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+
+    /// Scrapes answered 503 because every writer was in use
+    uint32_t getRefused() const { return refused; }
+};
+
+#endif // METRICS_WEB_SERVER_H
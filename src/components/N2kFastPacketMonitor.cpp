@@ -0,0 +1,150 @@
+/**
+ * @file N2kFastPacketMonitor.cpp
+ * @brief Implementation of the shadow fast-packet reassembly tracker
+ *
+ * Fast-packet framing: byte 0 = sequence counter (bits 7-5) | frame index
+ * (bits 4-0). Frame 0 carries the total payload length in byte 1 and six
+ * payload bytes; every following frame carries seven.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "N2kFastPacketMonitor.h"
+#include <string.h>
+
+N2kFastPacketMonitor::N2kFastPacketMonitor()
+    : table(nullptr), stats(nullptr), completed(0), failed(0), active(0), peakActive(0) {
+    memset(sequences, 0, sizeof(sequences));
+}
+
+void N2kFastPacketMonitor::begin(const N2kPGNTable* pgnTable, N2kPGNStats* pgnStats) {
+    table = pgnTable;
+    stats = pgnStats;
+}
+
+uint32_t N2kFastPacketMonitor::pgnFromCanId(uint32_t canId) {
+    uint32_t dataPage = (canId >> 24) & 0x03;  // Extended data page + data page
+    uint32_t pduFormat = (canId >> 16) & 0xFF;
+    uint32_t pduSpecific = (canId >> 8) & 0xFF;
+
+    // PDU1 (PF < 240): PS is the destination address, not part of the PGN
+    return (dataPage << 16) | (pduFormat << 8) | (pduFormat < 240 ? 0 : pduSpecific);
+}
+
+bool N2kFastPacketMonitor::isFastPacket(uint32_t pgn) const {
+    if (table == nullptr) {
+        return false;
+    }
+    const N2kPGNEntry* entry = table->find(pgn);
+    return entry != nullptr && entry->enabled && entry->fastPacket;
+}
+
+N2kFastPacketMonitor::Sequence* N2kFastPacketMonitor::findOpen(uint32_t pgn, uint8_t source) {
+    for (uint8_t i = 0; i < BUFFERS; i++) {
+        if (sequences[i].open && sequences[i].pgn == pgn && sequences[i].source == source) {
+            return &sequences[i];
+        }
+    }
+    return nullptr;
+}
+
+void N2kFastPacketMonitor::close(Sequence& seq) {
+    seq.open = false;
+    active--;
+}
+
+void N2kFastPacketMonitor::fail(Sequence& seq, N2kFastPacketError error) {
+    failed++;
+    if (stats != nullptr) {
+        stats->recordFastPacketError(seq.pgn, seq.source, error);
+    }
+    close(seq);
+}
+
+void N2kFastPacketMonitor::expire(uint32_t nowMs) {
+    for (uint8_t i = 0; i < BUFFERS; i++) {
+        if (sequences[i].open && (nowMs - sequences[i].lastFrameMs) > N2K_FAST_PACKET_TIMEOUT_MS) {
+            fail(sequences[i], N2kFastPacketError::TIMEOUT);
+        }
+    }
+}
+
+void N2kFastPacketMonitor::observeFrame(uint32_t canId, uint8_t len, const uint8_t* data,
+                                        uint32_t nowMs) {
+    if (len == 0 || data == nullptr) {
+        return;
+    }
+
+    uint32_t pgn = pgnFromCanId(canId);
+    if (!isFastPacket(pgn)) {
+        return;
+    }
+
+    uint8_t source = static_cast<uint8_t>(canId & 0xFF);
+    uint8_t counter = data[0] >> 5;
+    uint8_t frame = data[0] & 0x1F;
+
+    // Timeouts first, so a stale sequence frees its buffer for this frame
+    expire(nowMs);
+    Sequence* seq = findOpen(pgn, source);
+
+    if (frame == 0) {
+        if (seq != nullptr) {
+            fail(*seq, N2kFastPacketError::INCOMPLETE);
+        }
+        if (len < 2) {
+            return;
+        }
+
+        seq = nullptr;
+        for (uint8_t i = 0; i < BUFFERS; i++) {
+            if (!sequences[i].open) {
+                seq = &sequences[i];
+                break;
+            }
+        }
+        if (seq == nullptr) {
+            failed++;
+            if (stats != nullptr) {
+                stats->recordFastPacketError(pgn, source, N2kFastPacketError::NO_BUFFER);
+            }
+            return;
+        }
+
+        seq->pgn = pgn;
+        seq->source = source;
+        seq->counter = counter;
+        seq->nextFrame = 1;
+        seq->totalLen = data[1];
+        seq->receivedLen = static_cast<uint8_t>(len - 2);
+        seq->lastFrameMs = nowMs;
+        seq->open = true;
+        active++;
+        if (active > peakActive) {
+            peakActive = active;
+        }
+    } else {
+        if (seq == nullptr) {
+            return;  // Start never tracked (no buffer, or lost before we saw it)
+        }
+        if (frame != seq->nextFrame || counter != seq->counter) {
+            fail(*seq, N2kFastPacketError::OUT_OF_ORDER);
+            return;
+        }
+        seq->nextFrame++;
+        seq->receivedLen = static_cast<uint8_t>(seq->receivedLen + (len - 1));
+        seq->lastFrameMs = nowMs;
+    }
+
+    if (seq->receivedLen >= seq->totalLen) {
+        completed++;
+        close(*seq);
+    }
+}
+
+void N2kFastPacketMonitor::observe(void* context, unsigned long canId, unsigned char len,
+                                   const unsigned char* data, uint32_t nowMs) {
+    static_cast<N2kFastPacketMonitor*>(context)->observeFrame(static_cast<uint32_t>(canId), len,
+                                                              data, nowMs);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file N2kFastPacketMonitor.h
+ * @brief Shadow fast-packet reassembly tracker for NMEA2000 diagnostics
+ *
+ * The NMEA2000 library reassembles fast-packet PGNs (e.g. 129029, 127489)
+ * in a fixed number of message buffers and silently drops a sequence
+ * when a frame is missing, arrives out of order or no buffer is free. This
+ * monitor sees every raw CAN frame (ESP32N2kCanDriver frame observer) and
+ * follows the sequences of table PGNs marked fast-packet with the same
+ * number of buffers (N2K_FAST_PACKET_BUFFERS, also passed to the library),
+ * so losses become visible per (PGN, source) in N2kPGNStats:
+ * - incomplete: a new sequence started before the previous one completed
+ * - timeout: no next frame within N2K_FAST_PACKET_TIMEOUT_MS
+ * - out of order: frame index or 3-bit sequence counter mismatch
+ * - no buffer: every buffer was busy when a sequence started
+ *
+ * It only tracks frame indices and lengths (no payload copy). The peak of
+ * concurrently open sequences tells how many library buffers the network
+ * really needs.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed sequence pool, zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef N2K_FAST_PACKET_MONITOR_H
+#define N2K_FAST_PACKET_MONITOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "N2kPGNTable.h"
+#include "N2kPGNStats.h"
+#include "../config.h"
+
+/**
+ * @class N2kFastPacketMonitor
+ * @brief Receive-context observer of fast-packet frame sequences
+ *
+ * Usage pattern:
+ * @code
+ * GetN2kFastPacketMonitor().begin(&GetN2kPGNTable(), &GetN2kPGNStats());
+ * nmea2000->setFrameObserver(N2kFastPacketMonitor::observe, &GetN2kFastPacketMonitor());
+ * @endcode
+ */
+class N2kFastPacketMonitor {
+public:
+    static constexpr uint8_t BUFFERS = N2K_FAST_PACKET_BUFFERS;
+
+    N2kFastPacketMonitor();
+
+    /**
+     * @brief Attach the PGN table (which PGNs are fast-packet) and stats sink
+     */
+    void begin(const N2kPGNTable* table, N2kPGNStats* stats);
+
+    /**
+     * @brief Follow one received CAN frame (receive context only)
+     * @param canId 29-bit extended CAN identifier
+     * @param len Frame data length
+     * @param data Frame data
+     * @param nowMs Current millis()
+     */
+    void observeFrame(uint32_t canId, uint8_t len, const uint8_t* data, uint32_t nowMs);
+
+    /**
+     * @brief Frame observer trampoline (context = N2kFastPacketMonitor*)
+     */
+    static void observe(void* context, unsigned long canId, unsigned char len,
+                        const unsigned char* data, uint32_t nowMs);
+
+    /**
+     * @brief PGN encoded in a 29-bit NMEA2000 CAN identifier
+     */
+    static uint32_t pgnFromCanId(uint32_t canId);
+
+    uint32_t getCompleted() const { return completed; }
+    uint32_t getFailed() const { return failed; }
+    uint8_t getActive() const { return active; }
+    uint8_t getPeakActive() const { return peakActive; }
+
+private:
+    struct Sequence {
+        uint32_t pgn;
+        uint32_t lastFrameMs;
+        uint8_t source;
+        uint8_t counter;        ///< 3-bit sequence counter from the first frame
+        uint8_t nextFrame;      ///< Expected frame index
+        uint8_t totalLen;       ///< Payload length announced by the first frame
+        uint8_t receivedLen;
+        bool open;
+    };
+
+    const N2kPGNTable* table;
+    N2kPGNStats* stats;
+    Sequence sequences[BUFFERS];
+    uint32_t completed;
+    uint32_t failed;
+    uint8_t active;
+    uint8_t peakActive;
+
+    bool isFastPacket(uint32_t pgn) const;
+    Sequence* findOpen(uint32_t pgn, uint8_t source);
+    void expire(uint32_t nowMs);
+    void fail(Sequence& seq, N2kFastPacketError error);
+    void close(Sequence& seq);
+};
+
+#endif // N2K_FAST_PACKET_MONITOR_H
@@ -0,0 +1,302 @@
+/**
+ * @file N2kLoadGenerator.cpp
+ * @brief Implementation of the synthetic NMEA 2000 load generator
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "N2kLoadGenerator.h"
+#include <N2kMessages.h>
+#include <string.h>
+#include "NMEA2000Handlers.h"
+
+namespace {
+
+constexpr uint8_t MAX_IGNORED_PCT = 90;
+
+}  // namespace
+
+N2kLoadGenerator::N2kLoadGenerator()
+    : startRequested_(false), stopRequested_(false), active_(false),
+      loadPct_(0), ignoredPct_(0), durationS_(0), startMs_(0), endMs_(0),
+      injected_(0), dropped_(0), loopHzMin_(0), loopHz_(0), reason_("none"),
+      start_(), end_(), driver_(nullptr), logger_(nullptr) {
+    memset(&pending_, 0, sizeof(pending_));
+}
+
+bool N2kLoadGenerator::begin(ESP32N2kCanDriver* driver, WebSocketLogger* logger) {
+    if (driver == nullptr || logger == nullptr || logger_ != nullptr) {
+        return false;
+    }
+    driver_ = driver;
+    logger_ = logger;
+    return true;
+}
+
+const char* N2kLoadGenerator::validate(const N2kLoadRequest& request) {
+    if (request.loadPct == 0 || request.loadPct > 100) {
+        return "load must be 1-100";
+    }
+    if (request.ignoredPct > MAX_IGNORED_PCT) {
+        return "ignored must be 0-90";
+    }
+    if (request.durationS == 0 || request.durationS > N2K_LOAD_MAX_DURATION_S) {
+        return "duration out of range";
+    }
+    if (request.mix[0] != '\0') {
+        N2kLoadPlan plan;
+        if (!plan.parseMix(request.mix)) {
+            return "mix must be pgn[:weight],...";
+        }
+    }
+    return nullptr;
+}
+
+bool N2kLoadGenerator::requestStart(const N2kLoadRequest& request) {
+    if (logger_ == nullptr || startRequested_.load()) {
+        return false;
+    }
+    pending_ = request;
+    pending_.mix[sizeof(pending_.mix) - 1] = '\0';
+    startRequested_.store(true);  // Published after the request: service() reads a complete copy
+    return true;
+}
+
+void N2kLoadGenerator::service(uint32_t nowMs, uint32_t loopHz) {
+    if (logger_ == nullptr) {
+        return;
+    }
+
+    if (startRequested_.load()) {
+        if (active_.load()) {
+            finish(nowMs, "restarted");
+        }
+        start(nowMs);
+        startRequested_.store(false);
+    }
+    if (stopRequested_.exchange(false) && active_.load()) {
+        finish(nowMs, "request");
+    }
+    if (!active_.load()) {
+        return;
+    }
+
+    if (loopHz > 0) {
+        loopHz_ = loopHz;
+        if (loopHzMin_ == 0 || loopHz < loopHzMin_) {
+            loopHzMin_ = loopHz;
+        }
+    }
+
+    endMs_ = nowMs;
+    if (nowMs - startMs_ >= static_cast<uint32_t>(durationS_) * 1000) {
+        finish(nowMs, "done");
+        return;
+    }
+
+    uint32_t due = plan_.framesDue(nowMs);
+    while (due > 0) {
+        uint8_t frames = send(messages_[plan_.next()]);
+        plan_.sent(frames);
+        due = due > frames ? due - frames : 0;
+    }
+}
+
+void N2kLoadGenerator::start(uint32_t nowMs) {
+    bool mixed = pending_.mix[0] != '\0' ? plan_.parseMix(pending_.mix) : plan_.parseMix(N2K_LOAD_DEFAULT_MIX);
+    if (!mixed) {
+        logger_->broadcastLog(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::N2K_LOAD_DONE,
+            "{\"reason\":\"invalid mix\"}");
+        return;
+    }
+
+    // Ignored PGNs share out ignored% of the messages
+    if (pending_.ignoredPct > 0) {
+        N2kLoadPlan ignored;
+        ignored.parseMix(N2K_LOAD_IGNORED_PGNS);
+        uint32_t handledWeight = 0;
+        for (uint8_t i = 0; i < plan_.count(); i++) {
+            handledWeight += plan_.entry(i).weight;
+        }
+        uint32_t ignoredWeight = handledWeight * pending_.ignoredPct / (100 - pending_.ignoredPct);
+        uint32_t each = ignoredWeight / ignored.count();
+        each = each < 1 ? 1 : (each > 1000 ? 1000 : each);
+        for (uint8_t i = 0; i < ignored.count(); i++) {
+            plan_.add(ignored.entry(i).pgn, static_cast<uint16_t>(each));  // A full mix keeps what fits
+        }
+    }
+    for (uint8_t i = 0; i < plan_.count(); i++) {
+        build(plan_.entry(i).pgn, messages_[i]);
+    }
+
+    loadPct_ = pending_.loadPct;
+    ignoredPct_ = pending_.ignoredPct;
+    durationS_ = pending_.durationS;
+    startMs_ = nowMs;
+    endMs_ = nowMs;
+    injected_ = 0;
+    dropped_ = 0;
+    loopHzMin_ = 0;
+    loopHz_ = 0;
+    reason_ = "";
+    readTotals(start_);
+    plan_.start(N2kLoadPlan::framesPerSecond(loadPct_), nowMs);
+    active_.store(true);
+
+    logger_->broadcastLogf(LogLevel::INFO, LogComponent::NMEA2000, LogEvent::N2K_LOAD_STARTED,
+        "{\"load_pct\":%u,\"target_fps\":%lu,\"ignored_pct\":%u,\"pgns\":%u,\"duration_s\":%u}",
+        (unsigned)loadPct_, (unsigned long)plan_.getTargetFps(), (unsigned)ignoredPct_,
+        (unsigned)plan_.count(), (unsigned)durationS_);
+}
+
+void N2kLoadGenerator::finish(uint32_t nowMs, const char* reason) {
+    endMs_ = nowMs;
+    reason_ = reason;
+    readTotals(end_);
+    active_.store(false);
+
+    StaticJsonWriter<640> report;  // ~480 bytes: above a queue slot, so sent at once
+    writeReport(report, end_);
+    logger_->broadcastLog(dropped_ > 0 || plan_.getLate() > 0 ? LogLevel::WARN : LogLevel::INFO,
+        LogComponent::NMEA2000, LogEvent::N2K_LOAD_DONE, report.c_str());
+}
+
+void N2kLoadGenerator::build(uint32_t pgn, Message& message) {
+    tN2kMsg msg;
+    switch (pgn) {
+        case 127250UL: SetN2kPGN127250(msg, 1, 1.5102, N2kDoubleNA, N2kDoubleNA, N2khr_true); break;
+        case 127251UL: SetN2kPGN127251(msg, 1, 0.0175); break;
+        case 127252UL: SetN2kPGN127252(msg, 1, 0.12); break;
+        case 127257UL: SetN2kPGN127257(msg, 1, N2kDoubleNA, -0.0175, 0.2094); break;
+        case 127258UL: SetN2kPGN127258(msg, 1, N2kmagvar_Manual, 0, 0.0541); break;
+        case 127488UL: SetN2kPGN127488(msg, 0, 1850); break;
+        case 127505UL: SetN2kPGN127505(msg, 0, N2kft_Fuel, 62.5, 120.0); break;
+        case 127506UL: SetN2kPGN127506(msg, 1, N2K_BATTERY_INSTANCE_A, N2kDCt_Battery, 86, 95, N2kDoubleNA); break;
+        case 127508UL: SetN2kPGN127508(msg, N2K_BATTERY_INSTANCE_A, 12.84, -4.2, N2kDoubleNA, 1); break;
+        case 127489UL:
+            SetN2kPGN127489(msg, 0, N2kDoubleNA, CToKelvin(82.5), CToKelvin(75.0), 14.2, N2kDoubleNA,
+                            3600.0 * 1234, N2kDoubleNA, N2kDoubleNA, N2kInt8NA, N2kInt8NA,
+                            tN2kEngineDiscreteStatus1(), tN2kEngineDiscreteStatus2());
+            break;
+        case 128259UL: SetN2kPGN128259(msg, 1, 3.1); break;
+        case 128267UL: SetN2kPGN128267(msg, 1, 12.4, 0.3); break;
+        case 129025UL: SetN2kPGN129025(msg, 48.1173, 11.5167); break;
+        case 129026UL: SetN2kPGN129026(msg, 1, N2khr_true, 1.4731, 3.19); break;
+        case 129029UL:
+            SetN2kPGN129029(msg, 1, 20000, 45296.0, 48.1173, 11.5167, 12.0, N2kGNSSt_GPS,
+                            N2kGNSSm_GNSSfix, 8, 0.9);
+            break;
+        case 129539UL: SetN2kPGN129539(msg, 1, N2kGNSSdm_Auto, N2kGNSSdm_3D, 0.9, 1.4, N2kDoubleNA); break;
+        case 129284UL:
+            SetN2kPGN129284(msg, 1, 1852.0, N2khr_true, false, false, N2kdct_GreatCircle, N2kDoubleNA,
+                            N2kInt16NA, 1.2, 1.25, 1, 2, 48.1340, 11.5480, 3.0);
+            break;
+        case 130306UL: SetN2kPGN130306(msg, 1, 7.36, 0.6109, N2kWind_Apparent); break;
+        case 130310UL: SetN2kPGN130310(msg, 1, CToKelvin(17.8)); break;
+        case 130311UL: SetN2kPGN130311(msg, 1, N2kts_SeaTemperature, CToKelvin(17.8)); break;
+        case 130312UL: SetN2kPGN130312(msg, 1, 0, N2kts_SeaTemperature, CToKelvin(17.8)); break;
+        case 130316UL: SetN2kPGN130316(msg, 1, 0, N2kts_SeaTemperature, CToKelvin(17.8)); break;
+        default:
+            // Not handled here: content never parsed, only counted
+            msg.SetPGN(pgn);
+            msg.Priority = 6;
+            for (uint8_t i = 0; i < 8; i++) {
+                msg.AddByte(0xFF);
+            }
+            break;
+    }
+
+    const N2kPGNEntry* entry = GetN2kPGNTable().find(pgn);
+    message.pgn = pgn;
+    message.canId = N2kLoadPlan::canId(msg.Priority, pgn, N2K_LOAD_SOURCE);
+    message.length = static_cast<uint8_t>(msg.DataLen < MAX_MESSAGE_BYTES ? msg.DataLen : MAX_MESSAGE_BYTES);
+    message.fastPacket = (entry != nullptr && entry->fastPacket) || message.length > 8;
+    message.frames = N2kLoadPlan::frameCount(message.length, message.fastPacket);
+    message.sequence = 0;
+    memcpy(message.data, msg.Data, message.length);
+}
+
+uint8_t N2kLoadGenerator::send(Message& message) {
+    if (!message.fastPacket) {
+        if (driver_->injectFrame(message.canId, message.length, message.data)) {
+            injected_++;
+        } else {
+            dropped_++;
+        }
+        return 1;
+    }
+
+    uint8_t frames[N2kLoadPlan::MAX_FRAMES_PER_MESSAGE][8];
+    uint8_t count = N2kLoadPlan::splitFastPacket(message.data, message.length, message.sequence, frames);
+    message.sequence = (message.sequence + 1) & 0x07;
+    for (uint8_t i = 0; i < count; i++) {
+        if (driver_->injectFrame(message.canId, 8, frames[i])) {
+            injected_++;
+        } else {
+            dropped_++;
+        }
+    }
+    return count;
+}
+
+void N2kLoadGenerator::readTotals(Totals& totals) const {
+    memset(&totals, 0, sizeof(totals));
+    totals.delivered = driver_->getFramesReceived();
+    totals.fastPacketFailed = GetN2kFastPacketMonitor().getFailed();
+    // Only our sender's entries: live traffic on the bus is left out
+    GetN2kPGNStats().forEach([&totals](const N2kPGNStatsEntry& entry) {
+        if (entry.source != N2K_LOAD_SOURCE) {
+            return;
+        }
+        if (entry.handled) {
+            totals.handled += entry.received - entry.inactiveSource;
+        } else {
+            totals.unhandled += entry.received;
+        }
+        totals.inactive += entry.inactiveSource;
+        totals.parseFailures += entry.parseFailures;
+        totals.handlerUs += entry.handlerUsTotal;
+    });
+}
+
+void N2kLoadGenerator::writeJson(JsonWriter& json) const {
+    Totals now;
+    if (active_.load()) {
+        readTotals(now);
+    } else {
+        now = end_;
+    }
+    writeReport(json, now);
+}
+
+void N2kLoadGenerator::writeReport(JsonWriter& json, const Totals& now) const {
+    uint32_t elapsed = endMs_ - startMs_;
+    uint32_t handled = now.handled - start_.handled;
+    uint64_t handlerUs = now.handlerUs - start_.handlerUs;
+    json.beginObject()
+        .add("active", active_.load())
+        .add("reason", reason_)
+        .add("load_pct", (unsigned)loadPct_)
+        .add("ignored_pct", (unsigned)ignoredPct_)
+        .add("target_fps", (unsigned long)plan_.getTargetFps())
+        .add("pgns", (unsigned)plan_.count())
+        .add("duration_s", (unsigned)durationS_)
+        .add("elapsed_ms", (unsigned long)elapsed)
+        .add("injected", (unsigned long)injected_)
+        .add("dropped", (unsigned long)dropped_)
+        .add("late", (unsigned long)plan_.getLate())
+        .add("achieved_fps", (unsigned long)(elapsed > 0 ? (uint64_t)injected_ * 1000 / elapsed : 0))
+        .add("delivered", (unsigned long)(now.delivered - start_.delivered))
+        .add("handled", (unsigned long)handled)
+        .add("unhandled", (unsigned long)(now.unhandled - start_.unhandled))
+        .add("inactive", (unsigned long)(now.inactive - start_.inactive))
+        .add("parse_failures", (unsigned long)(now.parseFailures - start_.parseFailures))
+        .add("fast_packet_failed", (unsigned long)(now.fastPacketFailed - start_.fastPacketFailed))
+        .add("handler_us_total", (unsigned long)handlerUs)
+        .add("handler_us_avg", handled > 0 ? (double)handlerUs / handled : 0.0, 1)
+        .add("rx_queue_high_water", driver_ != nullptr ? (unsigned long)driver_->getRxQueueHighWater() : 0UL)
+        .add("loop_hz_min", (unsigned long)loopHzMin_)
+        .add("loop_hz", (unsigned long)loopHz_)
+        .endObject();
+}
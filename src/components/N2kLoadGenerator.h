@@ -0,0 +1,177 @@
+/**
+ * @file N2kLoadGenerator.h
+ * @brief Synthetic NMEA 2000 traffic into the CAN receive path, for throughput tests
+ *
+ * Finds the frame rate a firmware build sustains without a second device:
+ * frames go through ESP32N2kCanDriver::injectFrame() (the CAN RX queue, like
+ * BusReplay), so the library, the PGN dispatchers, the statistics and the
+ * fast-packet monitor all run as for bus traffic, in the configured
+ * N2K_RX_MODE.
+ *
+ * A run (POST /n2k/load/start) sends a weighted mix of PGNs at a share of
+ * the bus capacity for a fixed time:
+ * - load: percent of N2K_LOAD_BITRATE (100% is about 1900 frames/s)
+ * - mix: "pgn[:weight],..." (default N2K_LOAD_DEFAULT_MIX, every handled PGN
+ *   at typical rates); table PGNs carry valid payloads built with the
+ *   library's SetN2kPGN* functions, fast-packet ones are split into frames
+ * - ignored: percent of messages drawn from N2K_LOAD_IGNORED_PGNS, which the
+ *   firmware does not handle (the library's catch-all still counts them)
+ *
+ * Frames carry source address N2K_LOAD_SOURCE, so the report can pick their
+ * counters out of N2kPGNStats while live traffic continues. A GPS or compass
+ * PGN from that source is only parsed if no other sender is active for the
+ * sensor type; unplug the bus for a clean measurement.
+ *
+ * The report (GET /n2k/load/status, N2K_LOAD_DONE log event):
+ * injected/dropped frames (dropped = RX queue full), late frames (the
+ * generator itself fell behind), frames the driver delivered, messages the
+ * dispatchers handled, handler time, fast-packet losses, RX queue high water
+ * and the lowest loop frequency seen. Plotting "handled" against "load" per
+ * build gives its sustainable frame rate.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): messages built once per run in a static table
+ * - Principle V (Observability): every loss in the receive path is counted
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef N2K_LOAD_GENERATOR_H
+#define N2K_LOAD_GENERATOR_H
+
+#include <Arduino.h>
+#include <atomic>
+#include "../config.h"
+#include "../hal/implementations/ESP32N2kCanDriver.h"
+#include "../utils/JsonWriter.h"
+#include "../utils/N2kLoadPlan.h"
+#include "../utils/WebSocketLogger.h"
+
+/**
+ * @brief Parameters of one run
+ */
+struct N2kLoadRequest {
+    static constexpr size_t MIX_BYTES = 256;
+
+    uint8_t loadPct;      ///< 1..100
+    uint8_t ignoredPct;   ///< 0..90
+    uint16_t durationS;   ///< 1..N2K_LOAD_MAX_DURATION_S
+    char mix[MIX_BYTES];  ///< "pgn[:weight],..." (empty = N2K_LOAD_DEFAULT_MIX)
+};
+
+/**
+ * @class N2kLoadGenerator
+ * @brief Timed synthetic frame source with a throughput report
+ *
+ * Usage pattern:
+ * @code
+ * n2kLoadGenerator.begin(nmea2000, &logger);
+ * app.onRepeat(N2K_LOAD_SERVICE_INTERVAL_MS, []() {
+ *     n2kLoadGenerator.service(millis(), systemMetrics->getLoopFrequency());
+ * });
+ * // HTTP: n2kLoadGenerator.requestStart(request) / requestStop()
+ * @endcode
+ */
+class N2kLoadGenerator {
+public:
+    static constexpr uint8_t MAX_MESSAGE_BYTES = 64;
+
+    N2kLoadGenerator();
+
+    /// @return false on null driver or logger, or if already started
+    bool begin(ESP32N2kCanDriver* driver, WebSocketLogger* logger);
+
+    /**
+     * @brief Check a request (HTTP handler, before requestStart())
+     * @return nullptr if valid, else the reason
+     */
+    static const char* validate(const N2kLoadRequest& request);
+
+    /**
+     * @brief Ask for a run with @p request (any context; a running one is replaced)
+     * @return false before begin() or while a start is still pending
+     */
+    bool requestStart(const N2kLoadRequest& request);
+
+    /// Ask the running load to stop (any context)
+    void requestStop() { stopRequested_.store(true); }
+
+    /**
+     * @brief Main-loop hook: sends the frames that are due
+     * @param loopHz Current loop frequency (MetricsCollector), 0 = unknown
+     */
+    void service(uint32_t nowMs, uint32_t loopHz);
+
+    bool isActive() const { return active_.load(); }
+
+    /**
+     * @brief The running or last run as a JSON object (GET /n2k/load/status)
+     *
+     * {"active":true,"reason":"","load_pct":60,"ignored_pct":10,"target_fps":1145,"pgns":19,
+     *  "duration_s":30,"elapsed_ms":12000,"injected":13740,"dropped":0,"late":0,"achieved_fps":1145,
+     *  "delivered":13740,"handled":12100,"unhandled":1200,"inactive":0,"parse_failures":0,
+     *  "fast_packet_failed":0,"handler_us_total":480000,"handler_us_avg":39.6,
+     *  "rx_queue_high_water":18,"loop_hz_min":212,"loop_hz":230}
+     */
+    void writeJson(JsonWriter& json) const;
+
+private:
+    struct Message {
+        uint32_t pgn;
+        uint32_t canId;
+        uint8_t length;
+        uint8_t frames;      ///< CAN frames per message
+        uint8_t sequence;    ///< Fast-packet counter of the next send (0..7)
+        bool fastPacket;
+        uint8_t data[MAX_MESSAGE_BYTES];
+    };
+
+    /// Counters of our source in N2kPGNStats and the driver, at the start of a run
+    struct Totals {
+        uint32_t delivered;
+        uint32_t handled;
+        uint32_t unhandled;
+        uint32_t inactive;
+        uint32_t parseFailures;
+        uint32_t fastPacketFailed;
+        uint64_t handlerUs;
+    };
+
+    N2kLoadRequest pending_;
+    std::atomic<bool> startRequested_;
+    std::atomic<bool> stopRequested_;
+    std::atomic<bool> active_;
+
+    N2kLoadPlan plan_;
+    Message messages_[N2kLoadPlan::MAX_ENTRIES];
+    uint8_t loadPct_;
+    uint8_t ignoredPct_;
+    uint16_t durationS_;
+    uint32_t startMs_;
+    uint32_t endMs_;             ///< Last pass (running) or end of the run
+    uint32_t injected_;
+    uint32_t dropped_;
+    uint32_t loopHzMin_;
+    uint32_t loopHz_;
+    const char* reason_;         ///< Why the last run ended ("" while running)
+    Totals start_;
+    Totals end_;                 ///< At the end of the last run
+
+    ESP32N2kCanDriver* driver_;
+    WebSocketLogger* logger_;
+
+    void start(uint32_t nowMs);
+    void finish(uint32_t nowMs, const char* reason);
+
+    /// Build the payload of @p pgn (unknown PGNs get 8 bytes of 0xFF)
+    void build(uint32_t pgn, Message& message);
+
+    /// Inject one message; @return frames sent (injected or dropped)
+    uint8_t send(Message& message);
+
+    void readTotals(Totals& totals) const;
+    void writeReport(JsonWriter& json, const Totals& now) const;
+};
+
+#endif // N2K_LOAD_GENERATOR_H
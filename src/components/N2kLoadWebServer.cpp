@@ -0,0 +1,83 @@
+/**
+ * @file N2kLoadWebServer.cpp
+ * @brief Implementation of the load generator endpoints
+ *
+ * @see N2kLoadWebServer.h
+ */
+
+#include "N2kLoadWebServer.h"
+#include <string.h>
+
+N2kLoadWebServer::N2kLoadWebServer(N2kLoadGenerator* loadGenerator)
+    : generator(loadGenerator) {
+}
+
+void N2kLoadWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || generator == nullptr) {
+        return;
+    }
+
+    // POST /n2k/load/start?load=&ignored=&duration=&mix=
+    server->on("/n2k/load/start", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        this->handleStart(request);
+    });
+
+    // POST /n2k/load/stop
+    server->on("/n2k/load/stop", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        generator->requestStop();
+        sendResult(request, 202, "stopping");
+    });
+
+    // GET /n2k/load/status
+    server->on("/n2k/load/status", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        StaticJsonWriter<640> json;
+        generator->writeJson(json);
+        request->send(200, "application/json", json.c_str());
+    });
+}
+
+void N2kLoadWebServer::handleStart(AsyncWebServerRequest* request) {
+    static N2kLoadRequest load;  // async_tcp task only; too large for its stack
+    memset(&load, 0, sizeof(load));
+    load.durationS = N2K_LOAD_DEFAULT_DURATION_S;
+
+    if (!request->hasParam("load")) {
+        sendResult(request, 400, "load required");
+        return;
+    }
+    long value = request->getParam("load")->value().toInt();
+    load.loadPct = static_cast<uint8_t>(value > 0 && value <= 100 ? value : 0);
+    if (request->hasParam("ignored")) {
+        value = request->getParam("ignored")->value().toInt();
+        load.ignoredPct = static_cast<uint8_t>(value >= 0 && value <= 100 ? value : 255);
+    }
+    if (request->hasParam("duration")) {
+        value = request->getParam("duration")->value().toInt();
+        load.durationS = static_cast<uint16_t>(value > 0 && value <= N2K_LOAD_MAX_DURATION_S ? value : 0);
+    }
+    if (request->hasParam("mix")) {
+        const String& mix = request->getParam("mix")->value();  // No copy
+        if (mix.length() >= sizeof(load.mix)) {
+            sendResult(request, 400, "mix too long");
+            return;
+        }
+        memcpy(load.mix, mix.c_str(), mix.length() + 1);
+    }
+
+    const char* reason = N2kLoadGenerator::validate(load);
+    if (reason != nullptr) {
+        sendResult(request, 400, reason);
+        return;
+    }
+    if (!generator->requestStart(load)) {
+        sendResult(request, 409, "start pending");
+        return;
+    }
+    sendResult(request, 202, "starting");
+}
+
+void N2kLoadWebServer::sendResult(AsyncWebServerRequest* request, int code, const char* status) {
+    StaticJsonWriter<96> json;
+    json.beginObject().add("status", status).endObject();
+    request->send(code, "application/json", json.c_str());
+}
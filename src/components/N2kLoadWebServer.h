@@ -0,0 +1,58 @@
+/**
+ * @file N2kLoadWebServer.h
+ * @brief HTTP endpoints controlling the synthetic NMEA 2000 load generator
+ *
+ * Provides:
+ * - POST /n2k/load/start?load=60&ignored=10&duration=30&mix=130306:10,129025:10
+ *   Start a run (load 1-100 %, ignored 0-90 %, duration in s, mix optional);
+ *   400 with the reason on an invalid parameter
+ * - POST /n2k/load/stop: Stop the run
+ * - GET /n2k/load/status: The running or last run (see N2kLoadGenerator::writeJson())
+ *
+ * Start/stop only set request flags; the main loop applies them.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef N2K_LOAD_WEB_SERVER_H
+#define N2K_LOAD_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "N2kLoadGenerator.h"
+
+/**
+ * @brief Web server routes for the load generator
+ */
+class N2kLoadWebServer {
+private:
+    N2kLoadGenerator* generator;
+
+    /**
+     * @brief Handle POST /n2k/load/start
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleStart(AsyncWebServerRequest* request);
+
+    static void sendResult(AsyncWebServerRequest* request, int code, const char* status);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param loadGenerator Generator controlled by the /n2k/load routes
+     */
+    explicit N2kLoadWebServer(N2kLoadGenerator* loadGenerator);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // N2K_LOAD_WEB_SERVER_H
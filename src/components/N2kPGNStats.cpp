@@ -0,0 +1,155 @@
+/**
+ * @file N2kPGNStats.cpp
+ * @brief Implementation of the per-(PGN, source) statistics table
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "N2kPGNStats.h"
+#include "../utils/HotPath.h"
+#include <string.h>
+
+N2kPGNStats::N2kPGNStats() {
+    reset();
+}
+
+void N2kPGNStats::reset() {
+    memset(slots, 0, sizeof(slots));
+    entryCount = 0;
+    overflow = 0;
+    totalReceived = 0;
+}
+
+uint8_t N2kPGNStats::hashSlot(uint32_t pgn, uint8_t source) {
+    // Multiplicative hash of the packed key, top bits select the slot
+    uint32_t key = (pgn << 8) | source;
+    return static_cast<uint8_t>((key * 2654435761u) >> 24) & (SLOTS - 1);
+}
+
+N2kPGNStatsEntry* N2kPGNStats::lookup(uint32_t pgn, uint8_t source) {
+    uint8_t slot = hashSlot(pgn, source);
+    while (slots[slot].used) {
+        if (slots[slot].pgn == pgn && slots[slot].source == source) {
+            return &slots[slot];
+        }
+        slot = (slot + 1) & (SLOTS - 1);
+    }
+
+    if (entryCount >= MAX_ENTRIES) {
+        return nullptr;
+    }
+
+    N2kPGNStatsEntry& e = slots[slot];
+    memset(&e, 0, sizeof(e));
+    e.pgn = pgn;
+    e.source = source;
+    e.used = true;  // Last, so a concurrent reader never sees a half-filled key
+    entryCount++;
+    return &e;
+}
+
+N2kPGNStatsEntry* N2kPGNStats::touch(uint32_t pgn, uint8_t source, uint32_t nowMs) {
+    totalReceived++;
+
+    N2kPGNStatsEntry* e = lookup(pgn, source);
+    if (e == nullptr) {
+        overflow++;
+        return nullptr;
+    }
+
+    if (e->received > 0) {
+        float interval = static_cast<float>(nowMs - e->lastRxMs);
+        e->intervalMs = (e->intervalMs == 0.0f)
+            ? interval
+            : e->intervalMs + N2K_STATS_RATE_ALPHA * (interval - e->intervalMs);
+    }
+    e->lastRxMs = nowMs;
+    e->received++;
+    return e;
+}
+
+void HOT_PATH_ATTR N2kPGNStats::recordHandled(uint32_t pgn, uint8_t source, N2kHandlerResult result,
+                                uint32_t handlerUs, uint32_t nowMs) {
+    N2kPGNStatsEntry* e = touch(pgn, source, nowMs);
+    if (e == nullptr) {
+        return;
+    }
+
+    e->handled = true;
+    e->handlerUsTotal += handlerUs;
+    if (handlerUs > e->handlerUsPeak) {
+        e->handlerUsPeak = handlerUs;
+    }
+
+    switch (result) {
+        case N2kHandlerResult::PARSE_FAILED:  e->parseFailures++; break;
+        case N2kHandlerResult::NOT_AVAILABLE: e->notAvailable++;  break;
+        case N2kHandlerResult::IGNORED:       e->ignored++;       break;
+        case N2kHandlerResult::INACTIVE_SOURCE: e->inactiveSource++; break;
+        case N2kHandlerResult::COALESCED:     e->coalesced++;     break;
+        case N2kHandlerResult::UPDATED:       break;
+    }
+}
+
+void N2kPGNStats::recordUnhandled(uint32_t pgn, uint8_t source, uint32_t nowMs) {
+    touch(pgn, source, nowMs);
+}
+
+void N2kPGNStats::recordFastPacketError(uint32_t pgn, uint8_t source, N2kFastPacketError error) {
+    N2kPGNStatsEntry* e = lookup(pgn, source);
+    if (e == nullptr) {
+        return;
+    }
+
+    switch (error) {
+        case N2kFastPacketError::INCOMPLETE:   e->fpIncomplete++; break;
+        case N2kFastPacketError::TIMEOUT:      e->fpTimeout++;    break;
+        case N2kFastPacketError::OUT_OF_ORDER: e->fpOutOfOrder++; break;
+        case N2kFastPacketError::NO_BUFFER:    e->fpNoBuffer++;   break;
+    }
+}
+
+const N2kPGNStatsEntry* N2kPGNStats::find(uint32_t pgn, uint8_t source) const {
+    uint8_t slot = hashSlot(pgn, source);
+    while (slots[slot].used) {
+        if (slots[slot].pgn == pgn && slots[slot].source == source) {
+            return &slots[slot];
+        }
+        slot = (slot + 1) & (SLOTS - 1);
+    }
+    return nullptr;
+}
+
+float N2kPGNStats::rateHz(const N2kPGNStatsEntry& entry, uint32_t nowMs) {
+    if (entry.intervalMs <= 0.0f) {
+        return 0.0f;
+    }
+
+    // A pair that has gone quiet decays towards 0 instead of freezing
+    float sinceLast = static_cast<float>(nowMs - entry.lastRxMs);
+    float interval = sinceLast > entry.intervalMs ? sinceLast : entry.intervalMs;
+    return 1000.0f / interval;
+}
+
+void N2kPGNStats::writeEntry(JsonWriter& out, const N2kPGNStatsEntry& e, uint32_t nowMs) {
+    out.beginObject()
+        .add("pgn", (unsigned long)e.pgn)
+        .add("src", (unsigned)e.source)
+        .add("handled", e.handled)
+        .add("count", (unsigned long)e.received)
+        .add("rate_hz", (double)rateHz(e, nowMs), 2)
+        .add("parse_failures", (unsigned long)e.parseFailures)
+        .add("na", (unsigned long)e.notAvailable)
+        .add("ignored", (unsigned long)e.ignored)
+        .add("inactive", (unsigned long)e.inactiveSource)
+        .add("coalesced", (unsigned long)e.coalesced)
+        .add("fp_incomplete", (unsigned long)e.fpIncomplete)
+        .add("fp_timeout", (unsigned long)e.fpTimeout)
+        .add("fp_out_of_order", (unsigned long)e.fpOutOfOrder)
+        .add("fp_no_buffer", (unsigned long)e.fpNoBuffer)
+        .add("handler_us_total", (double)e.handlerUsTotal, 0)
+        .add("handler_us_peak", (unsigned long)e.handlerUsPeak)
+        .add("last_rx_ms_ago", (unsigned long)(nowMs - e.lastRxMs))
+        .endObject();
+}
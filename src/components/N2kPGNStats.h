@@ -0,0 +1,161 @@
+/**
+ * @file N2kPGNStats.h
+ * @brief Fixed-size per-(PGN, source address) receive statistics
+ *
+ * Answers "which PGNs dominate the bus and our CPU" without per-frame logs.
+ * For each (PGN, source) pair seen on the bus it keeps the receive count,
+ * an EWMA receive rate, parse-failure / not-available / filtered /
+ * inactive-source / coalesced counts, fast-packet reassembly failures and
+ * cumulative and peak handler time in µs. Served as JSON on GET /n2k/stats.
+ *
+ * Pairs live in an open-addressed hash table; lookup is one multiply and
+ * usually one probe. Entries are never moved or removed (except reset()),
+ * so a reader in another task sees at worst a counter that lags by a frame.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed table, zero heap allocation
+ * - Principle VII (Fail-Safe): a full table counts new pairs as overflow
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef N2K_PGN_STATS_H
+#define N2K_PGN_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "N2kPGNTable.h"
+#include "../utils/JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Why a fast-packet reassembly was lost (see N2kFastPacketMonitor)
+ */
+enum class N2kFastPacketError : uint8_t {
+    INCOMPLETE = 0,    ///< A new sequence started before the previous one completed
+    TIMEOUT = 1,       ///< No next frame within N2K_FAST_PACKET_TIMEOUT_MS
+    OUT_OF_ORDER = 2,  ///< Frame index or sequence counter did not match
+    NO_BUFFER = 3      ///< All reassembly buffers were busy
+};
+
+/**
+ * @brief Counters for one (PGN, source address) pair
+ */
+struct N2kPGNStatsEntry {
+    uint32_t pgn;
+    uint8_t source;            ///< N2k source address (tN2kMsg::Source)
+    bool used;
+    bool handled;              ///< A table handler processed these frames
+    uint32_t received;
+    uint32_t parseFailures;
+    uint32_t notAvailable;
+    uint32_t ignored;          ///< Parsed but filtered by the handler
+    uint32_t inactiveSource;   ///< Dropped unparsed: sender not the active source
+    uint32_t coalesced;        ///< Redundant fields skipped (e.g. 129029 position)
+    uint32_t fpIncomplete;     ///< Fast-packet sequences abandoned mid-way
+    uint32_t fpTimeout;        ///< Fast-packet sequences timed out
+    uint32_t fpOutOfOrder;     ///< Fast-packet sequences with a wrong frame index
+    uint32_t fpNoBuffer;       ///< Fast-packet sequences refused for lack of a buffer
+    uint32_t lastRxMs;
+    float intervalMs;          ///< EWMA of the inter-arrival time (0 = < 2 frames)
+    uint64_t handlerUsTotal;
+    uint32_t handlerUsPeak;
+};
+
+/**
+ * @class N2kPGNStats
+ * @brief Single-writer statistics table (receive context writes, HTTP reads)
+ */
+class N2kPGNStats {
+public:
+    static constexpr uint8_t SLOTS = N2K_STATS_SLOTS;
+    static constexpr uint8_t MAX_ENTRIES = N2K_STATS_MAX_ENTRIES;
+
+    static_assert((SLOTS & (SLOTS - 1)) == 0, "N2K_STATS_SLOTS must be a power of two");
+    static_assert(MAX_ENTRIES < SLOTS, "N2K_STATS_MAX_ENTRIES must leave free hash slots");
+
+    N2kPGNStats();
+
+    /**
+     * @brief Count a frame handled by a table handler
+     * @param handlerUs Time spent in the handler
+     */
+    void recordHandled(uint32_t pgn, uint8_t source, N2kHandlerResult result,
+                       uint32_t handlerUs, uint32_t nowMs);
+
+    /**
+     * @brief Count a frame no enabled handler is registered for
+     */
+    void recordUnhandled(uint32_t pgn, uint8_t source, uint32_t nowMs);
+
+    /**
+     * @brief Count a lost fast-packet reassembly (not a received frame)
+     */
+    void recordFastPacketError(uint32_t pgn, uint8_t source, N2kFastPacketError error);
+
+    /**
+     * @brief Look up a pair
+     * @return Entry, or nullptr if never seen (or not tracked due to overflow)
+     */
+    const N2kPGNStatsEntry* find(uint32_t pgn, uint8_t source) const;
+
+    /**
+     * @brief Smoothed receive rate, decaying once the pair goes quiet
+     * @return Frames per second (0 until two frames have been seen)
+     */
+    static float rateHz(const N2kPGNStatsEntry& entry, uint32_t nowMs);
+
+    /**
+     * @brief Write one entry as a JSON object (unkeyed - for use in an array)
+     */
+    static void writeEntry(JsonWriter& out, const N2kPGNStatsEntry& entry, uint32_t nowMs);
+
+    /**
+     * @brief Visit every tracked entry (slot order)
+     */
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (uint8_t i = 0; i < SLOTS; i++) {
+            if (slots[i].used) {
+                fn(slots[i]);
+            }
+        }
+    }
+
+    /// Entry in hash slot @p slot, nullptr when free (indexed walk, e.g. GET /metrics)
+    const N2kPGNStatsEntry* getSlot(uint8_t slot) const {
+        return slot < SLOTS && slots[slot].used ? &slots[slot] : nullptr;
+    }
+
+    uint8_t getEntryCount() const { return entryCount; }
+    uint32_t getOverflowCount() const { return overflow; }
+    uint32_t getTotalReceived() const { return totalReceived; }
+
+    /**
+     * @brief Forget all pairs (receive context only)
+     */
+    void reset();
+
+private:
+    N2kPGNStatsEntry slots[SLOTS];
+    uint8_t entryCount;
+    uint32_t overflow;        ///< Frames from pairs that did not fit
+    uint32_t totalReceived;
+
+    static uint8_t hashSlot(uint32_t pgn, uint8_t source);
+
+    /**
+     * @brief Find or insert the entry for a pair, without counting a frame
+     * @return Entry, or nullptr if the table is full
+     */
+    N2kPGNStatsEntry* lookup(uint32_t pgn, uint8_t source);
+
+    /**
+     * @brief Find or insert the entry for a pair, updating rate bookkeeping
+     * @return Entry, or nullptr if the table is full (overflow counted)
+     */
+    N2kPGNStatsEntry* touch(uint32_t pgn, uint8_t source, uint32_t nowMs);
+};
+
+#endif // N2K_PGN_STATS_H
@@ -0,0 +1,112 @@
+/**
+ * @file N2kPGNTable.cpp
+ * @brief Implementation of the sorted PGN handler table
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "N2kPGNTable.h"
+
+N2kPGNTable::N2kPGNTable() : entryCount(0) {
+}
+
+uint8_t N2kPGNTable::lowerBound(unsigned long pgn) const {
+    uint8_t low = 0;
+    uint8_t high = entryCount;
+    while (low < high) {
+        uint8_t mid = (low + high) / 2;
+        if (entries[mid].pgn < pgn) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return low;
+}
+
+bool N2kPGNTable::add(unsigned long pgn, N2kPGNHandler handler, const char* name, bool enabled) {
+    if (handler == nullptr) {
+        return false;
+    }
+
+    uint8_t index = lowerBound(pgn);
+    if (index < entryCount && entries[index].pgn == pgn) {
+        // Replace existing handler, keeping its source group and framing
+        entries[index] = {pgn, handler, name, enabled, entries[index].sourceGroup,
+                          entries[index].fastPacket};
+        return true;
+    }
+
+    if (entryCount >= CAPACITY) {
+        return false;
+    }
+
+    // Shift the tail up to keep the table sorted
+    for (uint8_t i = entryCount; i > index; i--) {
+        entries[i] = entries[i - 1];
+    }
+    entries[index] = {pgn, handler, name, enabled, N2kSourceGroup::NONE, false};
+    entryCount++;
+    return true;
+}
+
+bool N2kPGNTable::setEnabled(unsigned long pgn, bool enabled) {
+    uint8_t index = lowerBound(pgn);
+    if (index >= entryCount || entries[index].pgn != pgn) {
+        return false;
+    }
+    entries[index].enabled = enabled;
+    return true;
+}
+
+bool N2kPGNTable::setSourceGroup(unsigned long pgn, N2kSourceGroup group) {
+    uint8_t index = lowerBound(pgn);
+    if (index >= entryCount || entries[index].pgn != pgn) {
+        return false;
+    }
+    entries[index].sourceGroup = group;
+    return true;
+}
+
+bool N2kPGNTable::setFastPacket(unsigned long pgn, bool fastPacket) {
+    uint8_t index = lowerBound(pgn);
+    if (index >= entryCount || entries[index].pgn != pgn) {
+        return false;
+    }
+    entries[index].fastPacket = fastPacket;
+    return true;
+}
+
+const N2kPGNEntry* N2kPGNTable::find(unsigned long pgn) const {
+    uint8_t index = lowerBound(pgn);
+    if (index < entryCount && entries[index].pgn == pgn) {
+        return &entries[index];
+    }
+    return nullptr;
+}
+
+uint8_t N2kPGNTable::buildReceiveList(unsigned long* out, uint8_t maxEntries) const {
+    if (out == nullptr || maxEntries == 0) {
+        return 0;
+    }
+
+    uint8_t written = 0;
+    for (uint8_t i = 0; i < entryCount && written + 1 < maxEntries; i++) {
+        if (entries[i].enabled) {
+            out[written++] = entries[i].pgn;
+        }
+    }
+    out[written] = 0;  // Terminator
+    return written;
+}
+
+uint8_t N2kPGNTable::enabledCount() const {
+    uint8_t enabled = 0;
+    for (uint8_t i = 0; i < entryCount; i++) {
+        if (entries[i].enabled) {
+            enabled++;
+        }
+    }
+    return enabled;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file N2kPGNTable.h
+ * @brief Registrable, sorted table of NMEA2000 PGN handlers
+ *
+ * Single source of truth for which PGNs the firmware handles. The table
+ * drives the library receive list (tNMEA2000::ExtendReceiveMessages), the
+ * per-PGN message handlers attached to the library, and the
+ * HANDLERS_REGISTERED log. Adding a PGN is one add() call.
+ *
+ * Entries are kept sorted by PGN, so lookup is a binary search. Disabled
+ * entries stay in the table (for status reporting) but are left out of the
+ * receive list and are never attached, so the library drops those frames
+ * before they reach our code.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed capacity, zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef N2K_PGN_TABLE_H
+#define N2K_PGN_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+class tN2kMsg;
+class BoatData;
+class WebSocketLogger;
+
+/**
+ * @brief What a PGN handler did with a frame (feeds N2kPGNStats)
+ */
+enum class N2kHandlerResult : uint8_t {
+    UPDATED = 0,        ///< Parsed and BoatData updated
+    NOT_AVAILABLE = 1,  ///< Parsed, but the value was N2k "not available"
+    PARSE_FAILED = 2,   ///< Library parser rejected the frame
+    IGNORED = 3,        ///< Parsed but filtered (instance, reference, source type)
+    INACTIVE_SOURCE = 4,///< Dropped unparsed: sender is not the active source
+    COALESCED = 5       ///< Only fields no other PGN provides were applied
+};
+
+/**
+ * @brief Multi-source arbitration group of a PGN (see N2kSourceTracker)
+ *
+ * Frames of a grouped PGN are only handled when their sender is the active
+ * SourcePrioritizer source for that sensor type.
+ */
+enum class N2kSourceGroup : uint8_t {
+    NONE = 0,     ///< Every sender is handled
+    GPS = 1,
+    COMPASS = 2,
+    BATTERY = 3,  ///< Battery monitors (one sender supplies both banks)
+    ATTITUDE = 4  ///< Heel/pitch senders (competes with the onboard IMU)
+};
+
+/**
+ * @brief PGN handler signature (same as the HandleN2kPGNxxxxx functions)
+ */
+typedef N2kHandlerResult (*N2kPGNHandler)(const tN2kMsg& N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+
+/**
+ * @brief One registered PGN
+ */
+struct N2kPGNEntry {
+    unsigned long pgn;
+    N2kPGNHandler handler;
+    const char* name;     ///< Short description (static string)
+    bool enabled;
+    N2kSourceGroup sourceGroup;
+    bool fastPacket;      ///< Multi-frame fast-packet PGN (reassembly monitored)
+};
+
+/**
+ * @class N2kPGNTable
+ * @brief Sorted fixed-capacity PGN -> handler map
+ *
+ * Usage pattern:
+ * @code
+ * N2kPGNTable& table = GetN2kPGNTable();          // Built-in handlers
+ * table.add(128275L, HandleN2kPGN128275, "Distance Log");
+ * table.setEnabled(127252L, false);                // Heave not needed
+ * RegisterN2kHandlers(nmea2000, boatData, &logger);
+ * @endcode
+ */
+class N2kPGNTable {
+public:
+    static constexpr uint8_t CAPACITY = N2K_MAX_PGN_HANDLERS;
+
+    N2kPGNTable();
+
+    /**
+     * @brief Register (or replace) the handler for a PGN
+     * @param pgn Parameter Group Number
+     * @param handler Handler function (non-null)
+     * @param name Short description for status output
+     * @param enabled false = keep listed but reject at the library layer
+     * @return false if the table is full or handler is null
+     */
+    bool add(unsigned long pgn, N2kPGNHandler handler, const char* name, bool enabled = true);
+
+    /**
+     * @brief Enable or disable a registered PGN
+     * @return false if the PGN is not registered
+     */
+    bool setEnabled(unsigned long pgn, bool enabled);
+
+    /**
+     * @brief Put a registered PGN under multi-source arbitration
+     *
+     * Kept when the PGN's handler is later replaced with add().
+     *
+     * @return false if the PGN is not registered
+     */
+    bool setSourceGroup(unsigned long pgn, N2kSourceGroup group);
+
+    /**
+     * @brief Mark a registered PGN as a fast-packet (multi-frame) message
+     *
+     * Kept when the PGN's handler is later replaced with add().
+     *
+     * @return false if the PGN is not registered
+     */
+    bool setFastPacket(unsigned long pgn, bool fastPacket);
+
+    /**
+     * @brief Binary search for a PGN
+     * @return Entry (enabled or not), or nullptr if not registered
+     */
+    const N2kPGNEntry* find(unsigned long pgn) const;
+
+    /**
+     * @brief Write enabled PGNs, ascending, followed by a 0 terminator
+     * @param out Destination (library receive-list format)
+     * @param maxEntries Capacity of @p out including the terminator
+     * @return Number of PGNs written (excluding the terminator)
+     */
+    uint8_t buildReceiveList(unsigned long* out, uint8_t maxEntries) const;
+
+    uint8_t count() const { return entryCount; }
+    uint8_t enabledCount() const;
+    const N2kPGNEntry& entry(uint8_t index) const { return entries[index]; }
+
+private:
+    N2kPGNEntry entries[CAPACITY];
+    uint8_t entryCount;
+
+    /**
+     * @brief Index of the first entry with pgn >= @p pgn
+     */
+    uint8_t lowerBound(unsigned long pgn) const;
+};
+
+#endif // N2K_PGN_TABLE_H
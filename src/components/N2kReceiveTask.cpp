@@ -0,0 +1,163 @@
+/**
+ * @file N2kReceiveTask.cpp
+ * @brief Implementation of NMEA2000 receive scheduling
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "N2kReceiveTask.h"
+
+namespace {
+
+const char* modeToString(N2kReceiveMode mode) {
+    switch (mode) {
+        case N2kReceiveMode::MAIN_LOOP:          return "main_loop";
+        case N2kReceiveMode::TASK_POLL:          return "task_poll";
+        case N2kReceiveMode::TASK_WAKE_ON_FRAME: return "task_wake";
+        default:                                 return "unknown";
+    }
+}
+
+}  // namespace
+
+N2kReceiveTask::N2kReceiveTask()
+    : driver(nullptr), boatData(nullptr), logger(nullptr), transmitScheduler(nullptr),
+      stallWatchdog(nullptr), stallSlot(-1), taskHandle(nullptr),
+      mode(N2kReceiveMode::MAIN_LOOP), parsePasses(0), lastPassUs(0), maxApplyBatch(0) {
+}
+
+bool N2kReceiveTask::begin(ESP32N2kCanDriver* can, BoatData* data, WebSocketLogger* log,
+                           N2kReceiveMode requested) {
+    if (can == nullptr || data == nullptr || log == nullptr || driver != nullptr) {
+        return false;
+    }
+
+    driver = can;
+    boatData = data;
+    logger = log;
+    mode = N2kReceiveMode::MAIN_LOOP;
+    lastPassUs = micros();
+
+    if (requested != N2kReceiveMode::MAIN_LOOP) {
+        // Divert handler updates before the task starts producing them
+        boatData->deferPatches(&queue);
+        mode = requested;
+
+        BaseType_t created = xTaskCreatePinnedToCore(taskEntry, "n2k_rx", N2K_RX_TASK_STACK, this,
+                                                     N2K_RX_TASK_PRIORITY, &taskHandle, N2K_RX_TASK_CORE);
+        if (created != pdPASS) {
+            taskHandle = nullptr;
+            boatData->deferPatches(nullptr);
+            mode = N2kReceiveMode::MAIN_LOOP;
+            logger->broadcastLog(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::RX_TASK_FAILED,
+                "{\"reason\":\"xTaskCreatePinnedToCore failed\",\"fallback\":\"main_loop\"}");
+        }
+    }
+
+    if (mode == N2kReceiveMode::MAIN_LOOP) {
+        logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA2000, LogEvent::RX_MODE,
+            "{\"mode\":\"%s\",\"interval_ms\":%d}", modeToString(mode), IO_PUMP_INTERVAL_MS);
+    } else {
+        logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA2000, LogEvent::RX_MODE,
+            "{\"mode\":\"%s\",\"core\":%d,\"priority\":%d,\"queue\":%u}",
+            modeToString(mode), N2K_RX_TASK_CORE, N2K_RX_TASK_PRIORITY,
+            (unsigned)BoatDataPatchQueue::CAPACITY);
+    }
+    return true;
+}
+
+void N2kReceiveTask::parsePass(bool woken) {
+    uint32_t passStartUs = micros();
+
+    // Woken: the frame arrived just now. Polling: it arrived at some point
+    // since the previous pass started, so charge it from there.
+    driver->setFrameArrival(woken ? passStartUs : lastPassUs);
+    lastPassUs = passStartUs;
+
+    driver->ParseMessages();
+    driver->endPass();
+    driver->sampleController(millis());
+    if (transmitScheduler != nullptr) {
+        transmitScheduler->flush(driver);
+    }
+    parsePasses = parsePasses + 1;
+}
+
+void N2kReceiveTask::taskEntry(void* param) {
+    N2kReceiveTask* self = static_cast<N2kReceiveTask*>(param);
+
+    for (;;) {
+        bool woken = false;
+        if (self->mode == N2kReceiveMode::TASK_WAKE_ON_FRAME) {
+            // Timeout still runs a pass so the library's address claim and
+            // heartbeat housekeeping keep going on a silent bus
+            woken = self->driver->waitForFrame(pdMS_TO_TICKS(N2K_RX_WAKE_TIMEOUT_MS));
+        }
+
+        if (self->stallWatchdog != nullptr) {
+            self->stallWatchdog->enter(self->stallSlot, "parse", millis());
+        }
+        self->parsePass(woken);
+        if (self->stallWatchdog != nullptr) {
+            self->stallWatchdog->exit(self->stallSlot);
+        }
+
+        if (self->mode != N2kReceiveMode::TASK_WAKE_ON_FRAME) {
+            vTaskDelay(pdMS_TO_TICKS(N2K_RX_TASK_INTERVAL_MS));
+        }
+    }
+}
+
+bool N2kReceiveTask::service(uint32_t maxPatches) {
+    if (driver == nullptr) {
+        return false;
+    }
+
+    if (mode == N2kReceiveMode::MAIN_LOOP) {
+        parsePass(false);
+        return driver->getRxQueueDepth() > 0;
+    }
+
+    uint32_t applied = 0;
+    BoatDataPatch patch;
+    while ((maxPatches == 0 || applied < maxPatches) && queue.pop(patch)) {
+        boatData->applyPatch(patch);
+        handoffLatency.record(micros() - patch.producedUs);
+        applied++;
+    }
+    if (applied > maxApplyBatch) {
+        maxApplyBatch = applied;
+    }
+    return queue.size() > 0;
+}
+
+void N2kReceiveTask::logStats() {
+    if (logger == nullptr || driver == nullptr) {
+        return;
+    }
+
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA2000, LogEvent::N2K_RX_STATS,
+        "{\"mode\":\"%s\",\"frames\":%lu,\"rx_queue_high_water\":%lu,\"queue_high_water\":%lu,"
+        "\"queue_overruns\":%lu,\"max_apply_batch\":%lu,\"parse_passes\":%lu,\"stack_free\":%u}",
+        modeToString(mode), (unsigned long)driver->getFramesReceived(),
+        (unsigned long)driver->getRxQueueHighWater(), (unsigned long)queue.getHighWater(),
+        (unsigned long)queue.getDroppedCount(), (unsigned long)maxApplyBatch,
+        (unsigned long)parsePasses,
+        taskHandle != nullptr ? (unsigned)uxTaskGetStackHighWaterMark(taskHandle) : 0u);
+
+    // Written by the receive context; a torn read only skews one interval
+    const LatencyHistogram& rx = driver->getRxLatency();
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA2000, LogEvent::N2K_RX_LATENCY,
+        "{\"mode\":\"%s\",\"rx_us\":{\"n\":%lu,\"min\":%lu,\"avg\":%lu,\"p99\":%lu,\"max\":%lu},"
+        "\"handoff_us\":{\"n\":%lu,\"min\":%lu,\"avg\":%lu,\"p99\":%lu,\"max\":%lu}}",
+        modeToString(mode),
+        (unsigned long)rx.getCount(), (unsigned long)rx.getMin(), (unsigned long)rx.getAverage(),
+        (unsigned long)rx.getPercentile(99), (unsigned long)rx.getMax(),
+        (unsigned long)handoffLatency.getCount(), (unsigned long)handoffLatency.getMin(),
+        (unsigned long)handoffLatency.getAverage(), (unsigned long)handoffLatency.getPercentile(99),
+        (unsigned long)handoffLatency.getMax());
+
+    driver->requestRxLatencyReset();
+    handoffLatency.reset();
+}
@@ -0,0 +1,152 @@
+/**
+ * @file N2kReceiveTask.h
+ * @brief NMEA2000 receive scheduling: main-loop polling or a dedicated task
+ *
+ * By default nmea2000->ParseMessages() runs from a 10 ms ReactESP reactor on
+ * the main loop, shared with the web server, display and 1-Wire polling, so
+ * any stall there backs up the CAN receive queue. N2K_RX_MODE selects:
+ * - MAIN_LOOP: poll from the main loop (I/O pump, every IO_PUMP_INTERVAL_MS; default)
+ * - TASK_POLL: poll from a task pinned to N2K_RX_TASK_CORE
+ * - TASK_WAKE_ON_FRAME: that task sleeps until the CAN ISR queues a frame
+ *
+ * In the task modes the handlers keep running unchanged in the task; their
+ * patch*() calls are diverted into a lock-free SPSC queue
+ * (BoatData::deferPatches()) and applied on the main loop by service(), so
+ * BoatData keeps a single writer.
+ *
+ * Latency instrumentation (reported by logStats()):
+ * - rx: frame arrival estimate -> PGN handler returned (see ESP32N2kCanDriver)
+ * - handoff: patch produced in the task -> applied to BoatData (task modes)
+ * Frame-to-BoatData latency is rx in MAIN_LOOP mode and rx + handoff otherwise.
+ *
+ * Transmit: messages queued by N2kTransmitScheduler are sent after each parse
+ * pass, so every call into the CAN driver stays in the receive context.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed-size handoff queue, static task stack
+ * - Principle VII (Fail-Safe): full handoff queue drops updates and counts them
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef N2K_RECEIVE_TASK_H
+#define N2K_RECEIVE_TASK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "BoatData.h"
+#include "N2kTransmitScheduler.h"
+#include "../hal/implementations/ESP32N2kCanDriver.h"
+#include "../utils/LatencyHistogram.h"
+#include "../utils/StallWatchdog.h"
+#include "../utils/WebSocketLogger.h"
+
+/**
+ * @brief Where and when NMEA2000 frames are parsed (values match N2K_RX_MODE)
+ */
+enum class N2kReceiveMode : uint8_t {
+    MAIN_LOOP = 0,
+    TASK_POLL = 1,
+    TASK_WAKE_ON_FRAME = 2
+};
+
+/**
+ * @class N2kReceiveTask
+ * @brief Owns the receive task, the update handoff queue and receive stats
+ *
+ * Usage pattern:
+ * @code
+ * RegisterN2kHandlers(nmea2000, boatData, &logger);
+ * n2kReceiveTask.begin(nmea2000, boatData, &logger, N2kReceiveMode::TASK_WAKE_ON_FRAME);
+ * ioPump.add("n2k", [](void*) { return n2kReceiveTask.service(IO_PUMP_N2K_PATCHES); }, nullptr);
+ * @endcode
+ */
+class N2kReceiveTask {
+public:
+    N2kReceiveTask();
+
+    /**
+     * @brief Select the receive mode; start the pinned task for task modes
+     *
+     * Falls back to MAIN_LOOP if the task cannot be created.
+     *
+     * @param driver Opened CAN driver (only the receive context calls into it afterwards)
+     * @param boatData BoatData instance the handlers update
+     * @param logger WebSocket logger for status events
+     * @param mode Requested receive mode
+     * @return false on null arguments or if already started
+     */
+    bool begin(ESP32N2kCanDriver* driver, BoatData* boatData, WebSocketLogger* logger,
+               N2kReceiveMode mode);
+
+    /**
+     * @brief Send this scheduler's queued messages after every parse pass
+     *
+     * Call before begin(); nullptr disables transmitting.
+     */
+    void setTransmitScheduler(N2kTransmitScheduler* scheduler) { transmitScheduler = scheduler; }
+
+    /**
+     * @brief Bracket every parse pass of the task in @p slot ("parse")
+     *
+     * Call before begin(); task modes only.
+     */
+    void setStallWatchdog(StallWatchdog* watchdog, int8_t slot) {
+        stallWatchdog = watchdog;
+        stallSlot = slot;
+    }
+
+    /**
+     * @brief Main-loop hook (an I/O pump step)
+     *
+     * MAIN_LOOP: one ParseMessages() pass. Task modes: applies queued updates.
+     *
+     * @param maxPatches Updates applied at most in task modes (0 = all queued)
+     * @return true if frames or updates are still waiting
+     */
+    bool service(uint32_t maxPatches = 0);
+
+    /**
+     * @brief Log N2K_RX_STATS (queue/task counters) and N2K_RX_LATENCY events
+     *
+     * Latency histograms are reset afterwards, so each event covers one
+     * reporting interval.
+     */
+    void logStats();
+
+    N2kReceiveMode getMode() const { return mode; }
+    bool isTaskRunning() const { return taskHandle != nullptr; }
+    TaskHandle_t getTaskHandle() const { return taskHandle; }  ///< nullptr in main-loop mode
+
+    uint32_t getQueueHighWater() const { return queue.getHighWater(); }
+    uint32_t getQueueOverruns() const { return queue.getDroppedCount(); }
+    uint32_t getParsePasses() const { return parsePasses; }
+
+private:
+    BoatDataPatchQueue queue;
+    ESP32N2kCanDriver* driver;
+    BoatData* boatData;
+    WebSocketLogger* logger;
+    N2kTransmitScheduler* transmitScheduler;
+    StallWatchdog* stallWatchdog;
+    int8_t stallSlot;
+    TaskHandle_t taskHandle;
+    N2kReceiveMode mode;
+
+    volatile uint32_t parsePasses;  ///< Written by the receive context only
+    uint32_t lastPassUs;            ///< Start of the previous poll pass (arrival upper bound)
+    uint32_t maxApplyBatch;         ///< Most patches applied in one main-loop pass
+    LatencyHistogram handoffLatency;
+
+    /**
+     * @brief One ParseMessages() pass with arrival bookkeeping
+     * @param woken true if called right after waitForFrame() succeeded
+     */
+    void parsePass(bool woken);
+
+    static void taskEntry(void* param);
+};
+
+#endif // N2K_RECEIVE_TASK_H
@@ -0,0 +1,223 @@
+/**
+ * @file N2kSourceTracker.cpp
+ * @brief Implementation of per-sender NMEA2000 source arbitration
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "N2kSourceTracker.h"
+#include "../utils/HotPath.h"
+#include "../utils/WebSocketLogger.h"
+#include <stdio.h>
+#include <string.h>
+
+// Sender address that no device holds after losing an address claim
+static const uint8_t N2K_NULL_ADDRESS = 254;
+
+N2kSourceTracker::N2kSourceTracker()
+    : prioritizer(nullptr), logger(nullptr), sourceCount(0),
+      claimCount(0), nextClaimSlot(0), lastReevalMs(0),
+      blending(SOURCE_FUSION_MODE == 1), lastSource(-1) {
+    memset(sources, 0, sizeof(sources));
+    memset(slots, -1, sizeof(slots));
+    memset(claims, 0, sizeof(claims));
+}
+
+void N2kSourceTracker::begin(ISourcePrioritizer* p, WebSocketLogger* log) {
+    prioritizer = p;
+    logger = log;
+}
+
+SensorType N2kSourceTracker::sensorTypeFor(N2kSourceGroup group) {
+    switch (group) {
+        case N2kSourceGroup::COMPASS: return SensorType::COMPASS;
+        case N2kSourceGroup::BATTERY: return SensorType::BATTERY;
+        case N2kSourceGroup::ATTITUDE: return SensorType::ATTITUDE;
+        default:                      return SensorType::GPS;
+    }
+}
+
+const char* N2kSourceTracker::groupTag(N2kSourceGroup group) {
+    switch (group) {
+        case N2kSourceGroup::COMPASS: return "HDG";
+        case N2kSourceGroup::BATTERY: return "BAT";
+        case N2kSourceGroup::ATTITUDE: return "ATT";
+        default:                      return "GPS";
+    }
+}
+
+uint8_t N2kSourceTracker::hashSlot(N2kSourceGroup group, uint8_t address) {
+    // Multiplicative hash of the packed key, top bits select the slot
+    uint32_t key = (static_cast<uint32_t>(group) << 8) | address;
+    return static_cast<uint8_t>((key * 2654435761u) >> 24) & (SLOTS - 1);
+}
+
+N2kTrackedSource* N2kSourceTracker::lookup(N2kSourceGroup group, uint8_t address) {
+    uint8_t slot = hashSlot(group, address);
+    while (slots[slot] >= 0) {
+        N2kTrackedSource& src = sources[slots[slot]];
+        if (src.address == address && src.group == group) {
+            return &src;
+        }
+        slot = (slot + 1) & (SLOTS - 1);
+    }
+    return nullptr;
+}
+
+void N2kSourceTracker::indexSource(uint8_t index) {
+    uint8_t slot = hashSlot(sources[index].group, sources[index].address);
+    while (slots[slot] >= 0) {
+        slot = (slot + 1) & (SLOTS - 1);
+    }
+    slots[slot] = static_cast<int8_t>(index);
+}
+
+void N2kSourceTracker::rebuildIndex() {
+    memset(slots, -1, sizeof(slots));
+    for (uint8_t i = 0; i < sourceCount; i++) {
+        indexSource(i);
+    }
+}
+
+const N2kTrackedSource* N2kSourceTracker::find(N2kSourceGroup group, uint8_t address) const {
+    return const_cast<N2kSourceTracker*>(this)->lookup(group, address);
+}
+
+uint64_t N2kSourceTracker::claimedName(uint8_t address) const {
+    for (uint8_t i = 0; i < claimCount; i++) {
+        if (claims[i].address == address) {
+            return claims[i].name;
+        }
+    }
+    return 0;
+}
+
+N2kTrackedSource* N2kSourceTracker::registerSender(N2kSourceGroup group, uint8_t address) {
+    if (sourceCount >= MAX_SOURCES) {
+        return nullptr;
+    }
+
+    // "N2K-GPS-023": fits SensorSource::sourceId (15 characters)
+    char sourceId[16];
+    snprintf(sourceId, sizeof(sourceId), "N2K-%s-%03u", groupTag(group), (unsigned)address);
+
+    int index = prioritizer->registerSource(sourceId, sensorTypeFor(group), ProtocolType::NMEA2000);
+    if (index < 0) {
+        return nullptr;
+    }
+
+    N2kTrackedSource& src = sources[sourceCount++];
+    src.group = group;
+    src.address = address;
+    src.name = claimedName(address);
+    src.sourceIndex = index;
+    indexSource(sourceCount - 1);
+
+    if (logger != nullptr) {
+        logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA2000, LogEvent::SOURCE_REGISTERED,
+            "{\"id\":\"%s\",\"address\":%u,\"name\":\"%08lx%08lx\",\"index\":%d}",
+            sourceId, (unsigned)address,
+            (unsigned long)(src.name >> 32), (unsigned long)(src.name & 0xFFFFFFFFUL), index);
+    }
+    return &src;
+}
+
+void N2kSourceTracker::reevaluate(unsigned long now) {
+    if (now - lastReevalMs < N2K_SOURCE_REEVAL_MS) {
+        return;
+    }
+    lastReevalMs = now;
+
+    prioritizer->checkStale(now);
+    prioritizer->updatePriorities();
+}
+
+bool HOT_PATH_ATTR N2kSourceTracker::accept(N2kSourceGroup group, uint8_t address, unsigned long now) {
+    lastSource = -1;
+    if (group == N2kSourceGroup::NONE || prioritizer == nullptr) {
+        return true;
+    }
+
+    reevaluate(now);
+
+    SensorType type = sensorTypeFor(group);
+    N2kTrackedSource* src = lookup(group, address);
+    if (src == nullptr) {
+        src = registerSender(group, address);
+        if (src == nullptr) {
+            // Untracked sender: only used while no tracked source is active
+            return prioritizer->getActiveSource(type) < 0;
+        }
+    }
+
+    prioritizer->updateSourceTimestamp(src->sourceIndex, now);
+    lastSource = src->sourceIndex;
+
+    int active = prioritizer->getActiveSource(type);
+    if (active < 0) {
+        // Startup or failover gap: pick a source now instead of waiting for reevaluate()
+        prioritizer->updatePriorities();
+        active = prioritizer->getActiveSource(type);
+    }
+
+    // Bank readings of two battery monitors, and attitude, are never blended
+    bool blend = blending && group != N2kSourceGroup::BATTERY && group != N2kSourceGroup::ATTITUDE;
+    return blend || active < 0 || active == src->sourceIndex;
+}
+
+void N2kSourceTracker::noteQuality(uint8_t address, uint8_t fixQuality, uint8_t satellites, double hdop) {
+    if (prioritizer == nullptr) {
+        return;
+    }
+    N2kTrackedSource* src = lookup(N2kSourceGroup::GPS, address);
+    if (src != nullptr) {
+        prioritizer->updateSourceQuality(src->sourceIndex, fixQuality, satellites, hdop);
+    }
+}
+
+void N2kSourceTracker::noteAddressClaim(uint8_t address, uint64_t name) {
+    if (name == 0) {
+        return;
+    }
+
+    // Remember the claim (update in place, append, or replace round-robin)
+    uint8_t slot = claimCount;
+    for (uint8_t i = 0; i < claimCount; i++) {
+        if (claims[i].address == address || claims[i].name == name) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot == claimCount) {
+        if (claimCount < NAME_CACHE_SIZE) {
+            claimCount++;
+        } else {
+            slot = nextClaimSlot;
+            nextClaimSlot = (nextClaimSlot + 1) % NAME_CACHE_SIZE;
+        }
+    }
+    claims[slot].address = address;
+    claims[slot].name = name;
+
+    bool moved = false;
+    for (uint8_t i = 0; i < sourceCount; i++) {
+        N2kTrackedSource& src = sources[i];
+        if (src.name == name) {
+            // Same device, possibly at a new address: follow it
+            moved |= src.address != address;
+            src.address = address;
+        } else if (src.address == address) {
+            if (src.name == 0) {
+                src.name = name;  // First claim seen for a sender we already track
+            } else {
+                // Address taken over by another device: the old source stops matching
+                src.address = N2K_NULL_ADDRESS;
+                moved = true;
+            }
+        }
+    }
+    if (moved) {
+        rebuildIndex();  // Rare (address claims); keeps lookup() a single probe sequence
+    }
+}
@@ -0,0 +1,175 @@
+/**
+ * @file N2kSourceTracker.h
+ * @brief Per-sender NMEA2000 source arbitration for GPS, compass and battery PGNs
+ *
+ * Each sender on the backbone (N2k source address, identified by its NAME
+ * once its ISO Address Claim has been seen) becomes its own
+ * SourcePrioritizer source, registered automatically the first time it sends
+ * a GPS, compass or battery PGN. Only frames from the active source are handed to the
+ * PGN handlers; frames from redundant sensors are dropped before any parsing,
+ * validation or unit conversion, costing one hash lookup each.
+ *
+ * If a device re-claims a different address, its NAME moves the existing
+ * source to the new address so priority history and manual overrides survive.
+ *
+ * Battery senders (PGNs 127506/127508) compete as SensorType::BATTERY with
+ * the 1-Wire battery monitor (BoatData::updateBattery()), so the bus monitor
+ * wins on its higher update rate and the 1-Wire readings are dropped before
+ * they reach BoatData. One sender supplies both banks. Attitude senders
+ * (PGN 127257) compete the same way as SensorType::ATTITUDE with the onboard
+ * IMU (ImuAttitudeSource).
+ *
+ * In SourceFusionMode::BLEND (SOURCE_FUSION_MODE 1) no tracked GPS/compass
+ * sender is dropped; currentSource() tags the handlers' patches so BoatData
+ * can blend position, COG and headings of all senders. Battery and attitude
+ * senders are still selected.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed tables, zero heap allocation
+ * - Principle VII (Fail-Safe): with no active source (startup, all stale)
+ *   every sender is accepted
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef N2K_SOURCE_TRACKER_H
+#define N2K_SOURCE_TRACKER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "N2kPGNTable.h"
+#include "../hal/interfaces/ISourcePrioritizer.h"
+#include "../utils/SourceFusion.h"
+#include "../config.h"
+
+class WebSocketLogger;
+
+/**
+ * @brief One sender mapped to a SourcePrioritizer source
+ */
+struct N2kTrackedSource {
+    N2kSourceGroup group;
+    uint8_t address;      ///< Current N2k source address
+    uint64_t name;        ///< ISO NAME (0 = no address claim seen yet)
+    int sourceIndex;      ///< SourcePrioritizer index
+};
+
+/**
+ * @class N2kSourceTracker
+ * @brief Maps (group, sender) to prioritizer sources and filters inactive senders
+ *
+ * Usage pattern:
+ * @code
+ * tracker.begin(sourcePrioritizer, &logger);
+ *
+ * // Per frame, before parsing (receive context)
+ * if (!tracker.accept(N2kSourceGroup::GPS, N2kMsg.Source, millis())) {
+ *     return;  // Redundant GPS
+ * }
+ * @endcode
+ *
+ * All calls must come from the NMEA2000 receive context: it also runs the
+ * prioritizer's periodic stale check and re-ranking, so the prioritizer has a
+ * single writer.
+ */
+class N2kSourceTracker {
+public:
+    static constexpr uint8_t MAX_SOURCES = N2K_TRACKED_SOURCES;
+    static constexpr uint8_t NAME_CACHE_SIZE = N2K_NAME_CACHE_SIZE;
+    static constexpr uint8_t SLOTS = N2K_SOURCE_SLOTS;
+
+    static_assert((SLOTS & (SLOTS - 1)) == 0, "N2K_SOURCE_SLOTS must be a power of two");
+    static_assert(MAX_SOURCES < SLOTS, "N2K_SOURCE_SLOTS must leave free hash slots");
+
+    N2kSourceTracker();
+
+    /**
+     * @brief Attach the prioritizer (nullptr = accept everything)
+     */
+    void begin(ISourcePrioritizer* prioritizer, WebSocketLogger* logger);
+
+    /**
+     * @brief Decide whether a frame should be handled
+     *
+     * Registers unseen senders, feeds the prioritizer timestamp and returns
+     * whether the sender is the active source for @p group.
+     *
+     * @param group Arbitration group of the PGN (NONE = always accepted)
+     * @param address N2k source address of the frame
+     * @param now millis()
+     * @return true to handle the frame, false to drop it
+     */
+    bool accept(N2kSourceGroup group, uint8_t address, unsigned long now);
+
+    /**
+     * @brief Prioritizer source index of the frame accept() last passed (-1 = untracked or NONE)
+     *
+     * Passed by the GPS/compass handlers to BoatData::patchGPS()/patchCompass().
+     */
+    int currentSource() const { return lastSource; }
+
+    /**
+     * @brief Pass every tracked sender (BLEND) or only the active one (SELECT)
+     */
+    void setFusionMode(SourceFusionMode mode) { blending = mode == SourceFusionMode::BLEND; }
+
+    /**
+     * @brief Forward the fix details of a tracked GPS sender to the prioritizer
+     *
+     * Called for PGN 129029 from every GPS sender, including the ones whose
+     * frames accept() drops, so redundant receivers are ranked on quality too.
+     * Untracked senders are ignored.
+     */
+    void noteQuality(uint8_t address, uint8_t fixQuality, uint8_t satellites, double hdop);
+
+    /**
+     * @brief Record an ISO Address Claim (PGN 60928)
+     * @param address Claimed source address
+     * @param name 64-bit ISO NAME from the claim
+     */
+    void noteAddressClaim(uint8_t address, uint64_t name);
+
+    /**
+     * @brief Tracked sender for a group and address
+     * @return Entry, or nullptr if not seen
+     */
+    const N2kTrackedSource* find(N2kSourceGroup group, uint8_t address) const;
+
+    uint8_t count() const { return sourceCount; }
+    const N2kTrackedSource& source(uint8_t index) const { return sources[index]; }
+
+private:
+    struct NameClaim {
+        uint8_t address;
+        uint64_t name;
+    };
+
+    ISourcePrioritizer* prioritizer;
+    WebSocketLogger* logger;
+
+    N2kTrackedSource sources[MAX_SOURCES];
+    uint8_t sourceCount;
+    int8_t slots[SLOTS];      ///< Index into sources per (group, address) hash slot (-1 = empty)
+
+    NameClaim claims[NAME_CACHE_SIZE];
+    uint8_t claimCount;
+    uint8_t nextClaimSlot;    ///< Round-robin replacement once the cache is full
+
+    unsigned long lastReevalMs;
+    bool blending;            ///< SourceFusionMode::BLEND: no sender is dropped
+    int lastSource;           ///< currentSource()
+
+    N2kTrackedSource* lookup(N2kSourceGroup group, uint8_t address);
+    void indexSource(uint8_t index);
+    void rebuildIndex();
+    N2kTrackedSource* registerSender(N2kSourceGroup group, uint8_t address);
+    uint64_t claimedName(uint8_t address) const;
+    void reevaluate(unsigned long now);
+
+    static SensorType sensorTypeFor(N2kSourceGroup group);
+    static const char* groupTag(N2kSourceGroup group);
+    static uint8_t hashSlot(N2kSourceGroup group, uint8_t address);
+};
+
+#endif // N2K_SOURCE_TRACKER_H
@@ -0,0 +1,57 @@
+/**
+ * @file N2kStatsWebServer.cpp
+ * @brief Implementation of the NMEA2000 statistics endpoint
+ *
+ * @see N2kStatsWebServer.h
+ */
+
+#include "N2kStatsWebServer.h"
+#include "../utils/JsonWriter.h"
+
+N2kStatsWebServer::N2kStatsWebServer(const N2kPGNStats* pgnStats,
+                                     const N2kFastPacketMonitor* fastPacketMonitor)
+    : stats(pgnStats), fastPackets(fastPacketMonitor) {
+}
+
+void N2kStatsWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || stats == nullptr) {
+        return;
+    }
+
+    // GET /n2k/stats - Per-(PGN, source) receive statistics
+    server->on("/n2k/stats", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetStats(request);
+    });
+}
+
+void N2kStatsWebServer::handleGetStats(AsyncWebServerRequest* request) {
+    uint32_t now = millis();
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+
+    response->printf("{\"uptime_ms\":%lu,\"frames\":%lu,\"entries\":%u,\"overflow\":%lu,",
+        (unsigned long)now, (unsigned long)stats->getTotalReceived(),
+        (unsigned)stats->getEntryCount(), (unsigned long)stats->getOverflowCount());
+
+    if (fastPackets != nullptr) {
+        response->printf("\"fast_packet\":{\"buffers\":%u,\"active\":%u,\"peak_active\":%u,"
+            "\"completed\":%lu,\"failed\":%lu},",
+            (unsigned)N2kFastPacketMonitor::BUFFERS, (unsigned)fastPackets->getActive(),
+            (unsigned)fastPackets->getPeakActive(), (unsigned long)fastPackets->getCompleted(),
+            (unsigned long)fastPackets->getFailed());
+    }
+    response->print("\"pgns\":[");
+
+    bool first = true;
+    stats->forEach([&](const N2kPGNStatsEntry& entry) {
+        StaticJsonWriter<512> item;  // Worst case entry is ~420 bytes
+        N2kPGNStats::writeEntry(item, entry, now);
+        if (!first) {
+            response->print(',');
+        }
+        response->print(item.c_str());
+        first = false;
+    });
+
+    response->print("]}");
+    request->send(response);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file N2kStatsWebServer.h
+ * @brief HTTP endpoint for per-PGN NMEA2000 receive statistics
+ *
+ * Provides:
+ * - GET /n2k/stats: Per-(PGN, source) counters, rates and handler timing
+ *
+ * Registered on the ConfigWebServer instance alongside CalibrationWebServer.
+ * The response is streamed one entry at a time, so its size does not depend
+ * on a fixed JSON document buffer.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef N2K_STATS_WEB_SERVER_H
+#define N2K_STATS_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "N2kPGNStats.h"
+#include "N2kFastPacketMonitor.h"
+
+/**
+ * @brief Web server routes for the NMEA2000 statistics table
+ */
+class N2kStatsWebServer {
+private:
+    const N2kPGNStats* stats;
+    const N2kFastPacketMonitor* fastPackets;
+
+    /**
+     * @brief Handle GET /n2k/stats
+     *
+     * Returns:
+     * {
+     *   "uptime_ms": 123456, "frames": 9876, "entries": 12, "overflow": 0,
+     *   "fast_packet": {"buffers": 5, "active": 0, "peak_active": 3,
+     *                   "completed": 4321, "failed": 2},
+     *   "pgns": [
+     *     {"pgn": 129025, "src": 3, "handled": true, "count": 1234,
+     *      "rate_hz": 10.02, "parse_failures": 0, "na": 0, "ignored": 0, "inactive": 0,
+     *      "coalesced": 0, "fp_incomplete": 0, "fp_timeout": 0, "fp_out_of_order": 0,
+     *      "fp_no_buffer": 0,
+     *      "handler_us_total": 45678, "handler_us_peak": 210,
+     *      "last_rx_ms_ago": 40},
+     *     ...
+     *   ]
+     * }
+     *
+     * Counters are read without locking while the receive context updates
+     * them; a single value may lag by one frame.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetStats(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param pgnStats Statistics table (see GetN2kPGNStats())
+     * @param fastPacketMonitor Reassembly tracker (see GetN2kFastPacketMonitor()), optional
+     */
+    explicit N2kStatsWebServer(const N2kPGNStats* pgnStats,
+                               const N2kFastPacketMonitor* fastPacketMonitor = nullptr);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // N2K_STATS_WEB_SERVER_H
@@ -0,0 +1,223 @@
+/**
+ * @file N2kTransmitScheduler.cpp
+ * @brief Implementation of the NMEA2000 transmit scheduler
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "N2kTransmitScheduler.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+constexpr uint32_t N2K_BUS_BITRATE = 250000;
+constexpr uint32_t BURST_MILLI_FRAMES = static_cast<uint32_t>(N2K_TX_BURST_FRAMES) * 1000;
+
+}  // namespace
+
+N2kTransmitScheduler::N2kTransmitScheduler()
+    : jobCount(0), tokensMilliFrames(BURST_MILLI_FRAMES), lastRefillMs(0), started(false), eventsQueued(0),
+      busMonitor(nullptr), sharePercent(N2K_TX_BUS_LOAD_PCT), loadThrottled(0),
+      sent(0), sendFailures(0) {
+    memset(jobs, 0, sizeof(jobs));
+}
+
+bool N2kTransmitScheduler::addJob(uint32_t pgn, N2kTxBuilder build, const char* name,
+                                  uint32_t periodMs, uint8_t priority) {
+    if (build == nullptr || periodMs == 0 || priority > 7 || jobCount >= MAX_JOBS) {
+        return false;
+    }
+    for (uint8_t i = 0; i < jobCount; i++) {
+        if (jobs[i].pgn == pgn) {
+            return false;
+        }
+    }
+
+    N2kTxJob& job = jobs[jobCount++];
+    memset(&job, 0, sizeof(job));
+    job.pgn = pgn;
+    job.build = build;
+    job.name = name;
+    job.periodMs = periodMs;
+    job.priority = priority;
+    job.frames = 1;
+    return true;
+}
+
+uint8_t N2kTransmitScheduler::buildTransmitList(unsigned long* out, uint8_t maxEntries) const {
+    if (out == nullptr || maxEntries == 0) {
+        return 0;
+    }
+
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < jobCount && count + 1 < maxEntries; i++) {
+        out[count++] = jobs[i].pgn;
+    }
+    out[count] = 0;
+    return count;
+}
+
+uint8_t N2kTransmitScheduler::framesFor(int dataLen) {
+    if (dataLen <= 8) {
+        return 1;
+    }
+    // Fast packet: 6 payload bytes in the first frame, 7 in each following one
+    return static_cast<uint8_t>(1 + (dataLen - 6 + 7 - 1) / 7);
+}
+
+uint32_t N2kTransmitScheduler::budgetFramesPerSecond() {
+    return budgetFramesPerSecond(N2K_TX_BUS_LOAD_PCT);
+}
+
+uint32_t N2kTransmitScheduler::budgetFramesPerSecond(uint8_t percent) {
+    return N2K_BUS_BITRATE * percent / 100 / N2K_CAN_FRAME_BITS;
+}
+
+bool N2kTransmitScheduler::isDue(const N2kTxJob& job, uint32_t nowMs) {
+    return static_cast<int32_t>(nowMs - job.nextDueMs) >= 0;
+}
+
+void N2kTransmitScheduler::refill(uint32_t nowMs) {
+    uint32_t elapsedMs = nowMs - lastRefillMs;
+    lastRefillMs = nowMs;
+
+    sharePercent = N2K_TX_BUS_LOAD_PCT;
+    if (busMonitor != nullptr) {
+        uint8_t load = busMonitor->loadPercent(nowMs, CAN_BUS_LOAD_SHORT_MS);
+        uint8_t headroom = load >= N2K_TX_MAX_BUS_LOAD_PCT ? 0 : N2K_TX_MAX_BUS_LOAD_PCT - load;
+        if (headroom < sharePercent) {
+            sharePercent = headroom;
+            loadThrottled++;
+        }
+        if (sharePercent == 0) {
+            tokensMilliFrames = 0;  // Not even the saved-up burst on a saturated bus
+            return;
+        }
+    }
+
+    // frames/s * ms == milli-frames
+    uint32_t add = budgetFramesPerSecond(sharePercent) * elapsedMs;
+    if (add >= BURST_MILLI_FRAMES || tokensMilliFrames + add >= BURST_MILLI_FRAMES) {
+        tokensMilliFrames = BURST_MILLI_FRAMES;
+    } else {
+        tokensMilliFrames += add;
+    }
+}
+
+void N2kTransmitScheduler::schedule(const BoatDataStructure& data, uint32_t nowMs) {
+    if (!started) {
+        // Stagger first transmissions so jobs with equal periods don't burst together
+        for (uint8_t i = 0; i < jobCount; i++) {
+            jobs[i].nextDueMs = nowMs + (jobs[i].periodMs * i) / (jobCount + 1);
+        }
+        lastRefillMs = nowMs;
+        started = true;
+    }
+
+    refill(nowMs);
+
+    for (;;) {
+        // Highest-priority due job (lowest value; table order breaks ties)
+        N2kTxJob* next = nullptr;
+        for (uint8_t i = 0; i < jobCount; i++) {
+            if (isDue(jobs[i], nowMs) && (next == nullptr || jobs[i].priority < next->priority)) {
+                next = &jobs[i];
+            }
+        }
+        if (next == nullptr) {
+            return;
+        }
+
+        // A message larger than the burst still goes out once the bucket is full
+        uint32_t cost = static_cast<uint32_t>(next->frames) * 1000;
+        if (cost > BURST_MILLI_FRAMES) {
+            cost = BURST_MILLI_FRAMES;
+        }
+        if (cost > tokensMilliFrames) {
+            // Strict priority: lower-priority jobs wait too, so the bus share stays bounded
+            next->deferred++;
+            return;
+        }
+
+        // Catch-up after a stall restarts the period instead of sending a backlog
+        next->nextDueMs += next->periodMs;
+        if (isDue(*next, nowMs)) {
+            next->nextDueMs = nowMs + next->periodMs;
+        }
+
+        tN2kMsg msg;
+        if (!next->build(msg, data, next->sid)) {
+            next->notAvailable++;
+            continue;
+        }
+
+        msg.Priority = next->priority;
+        next->sid++;
+        next->frames = framesFor(msg.DataLen);
+        cost = static_cast<uint32_t>(next->frames) * 1000;
+        tokensMilliFrames = cost > tokensMilliFrames ? 0 : tokensMilliFrames - cost;
+
+        if (outbox.push(msg)) {
+            next->queued++;
+        } else {
+            next->queueFull++;
+        }
+    }
+}
+
+bool N2kTransmitScheduler::queue(const tN2kMsg& msg) {
+    if (!outbox.push(msg)) {
+        return false;
+    }
+    eventsQueued++;
+    return true;
+}
+
+void N2kTransmitScheduler::flush(tNMEA2000* bus) {
+    if (bus == nullptr) {
+        return;
+    }
+
+    tN2kMsg msg;
+    while (outbox.pop(msg)) {
+        if (bus->SendMsg(msg)) {
+            sent = sent + 1;
+        } else {
+            sendFailures = sendFailures + 1;
+        }
+    }
+}
+
+void N2kTransmitScheduler::logStats(WebSocketLogger* logger, uint32_t canTxQueueHighWater) const {
+    if (logger == nullptr) {
+        return;
+    }
+
+    // Compact per-job tuples: [pgn, queued, not_available, deferred, queue_full]
+    char jobsJson[160];
+    size_t pos = 0;
+    jobsJson[pos++] = '[';
+    for (uint8_t i = 0; i < jobCount; i++) {
+        const N2kTxJob& job = jobs[i];
+        int written = snprintf(jobsJson + pos, sizeof(jobsJson) - pos, "%s[%lu,%lu,%lu,%lu,%lu]",
+                               i > 0 ? "," : "", (unsigned long)job.pgn, (unsigned long)job.queued,
+                               (unsigned long)job.notAvailable, (unsigned long)job.deferred,
+                               (unsigned long)job.queueFull);
+        if (written < 0 || pos + written >= sizeof(jobsJson) - 1) {
+            break;  // Truncate the list rather than emit invalid JSON
+        }
+        pos += written;
+    }
+    jobsJson[pos++] = ']';
+    jobsJson[pos] = '\0';
+
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA2000, LogEvent::N2K_TX_STATS,
+        "{\"sent\":%lu,\"failed\":%lu,\"events\":%lu,\"outbox_hw\":%lu,\"outbox_drops\":%lu,"
+        "\"can_txq_hw\":%lu,\"budget_fps\":%lu,\"share_pct\":%u,\"throttled\":%lu,\"jobs\":%s}",
+        (unsigned long)sent, (unsigned long)sendFailures, (unsigned long)eventsQueued,
+        (unsigned long)outbox.getHighWater(),
+        (unsigned long)outbox.getDroppedCount(), (unsigned long)canTxQueueHighWater,
+        (unsigned long)budgetFramesPerSecond(), (unsigned)sharePercent, (unsigned long)loadThrottled, jobsJson);
+}
@@ -0,0 +1,183 @@
+/**
+ * @file N2kTransmitScheduler.h
+ * @brief Rate-controlled NMEA2000 transmit scheduler for derived data
+ *
+ * Publishes periodic PGNs (CalculationEngine results) on the bus. Each job has
+ * its own period and N2k priority; a due job builds its message from the
+ * BoatData snapshot and queues it for the receive context, which owns the CAN
+ * driver and performs the actual sends.
+ *
+ * Bus-load budget: a token bucket refilled at N2K_TX_BUS_LOAD_PCT of the
+ * 250 kbit/s bus (in frames, N2K_CAN_FRAME_BITS per frame) and capped at
+ * N2K_TX_BURST_FRAMES. Due jobs are served in priority order; a job whose
+ * frame cost exceeds the remaining budget is deferred to the next pass and
+ * nothing of lower priority overtakes it.
+ *
+ * Load gate (setBusMonitor()): the refill share shrinks to the headroom
+ * between the measured bus load (CAN_BUS_LOAD_SHORT_MS, our own frames
+ * included) and N2K_TX_MAX_BUS_LOAD_PCT, down to nothing once the bus is
+ * that busy, so our periodic PGNs never push a loaded bus past the limit.
+ *
+ * Event messages (PGN 126983 alerts) go through queue(): the same outbox,
+ * outside the periodic budget, since they are rare and must not wait.
+ *
+ * Threading:
+ * - schedule(), queue(): main loop (reads BoatData, single producer of the outbox)
+ * - flush(): receive context, right after ParseMessages() (single consumer)
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed job table and outbox, zero heap allocation
+ * - Principle VII (Fail-Safe): stale/unavailable data is skipped, a full outbox is counted
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef N2K_TRANSMIT_SCHEDULER_H
+#define N2K_TRANSMIT_SCHEDULER_H
+
+#include <Arduino.h>
+#include <NMEA2000.h>
+#include "../types/BoatDataTypes.h"
+#include "../utils/SPSCQueue.h"
+#include "../utils/CanBusMonitor.h"
+#include "../utils/WebSocketLogger.h"
+#include "../config.h"
+
+/**
+ * @brief Builds one periodic message from the current BoatData snapshot
+ * @param msg Message to fill
+ * @param data BoatData snapshot
+ * @param sid Sequence ID for this transmission
+ * @return false if the source data is unavailable (nothing is sent)
+ */
+typedef bool (*N2kTxBuilder)(tN2kMsg& msg, const BoatDataStructure& data, unsigned char sid);
+
+/**
+ * @brief One periodic transmit PGN and its counters
+ */
+struct N2kTxJob {
+    uint32_t pgn;
+    N2kTxBuilder build;
+    const char* name;
+    uint32_t periodMs;
+    uint8_t priority;          ///< N2k priority, 0 = highest
+    uint32_t nextDueMs;
+    uint8_t sid;
+    uint8_t frames;            ///< CAN frames of the last built message (budget cost)
+    uint32_t queued;           ///< Messages handed to the outbox
+    uint32_t notAvailable;     ///< Periods skipped: source data unavailable or stale
+    uint32_t deferred;         ///< Passes held back by the bus-load budget
+    uint32_t queueFull;        ///< Messages dropped: outbox full
+};
+
+typedef SPSCQueue<tN2kMsg, N2K_TX_QUEUE_CAPACITY> N2kTxQueue;
+
+/**
+ * @class N2kTransmitScheduler
+ * @brief Periodic, prioritised, bus-load-limited N2k transmits
+ *
+ * Usage pattern:
+ * @code
+ * RegisterN2kTransmitters(nmea2000, n2kTransmitScheduler);   // before Open()
+ * n2kReceiveTask.setTransmitScheduler(&n2kTransmitScheduler);
+ * app.onRepeat(N2K_TX_SCHEDULE_INTERVAL_MS, []() {
+ *     n2kTransmitScheduler.schedule(*boatData->getDataStructure(), millis());
+ * });
+ * @endcode
+ */
+class N2kTransmitScheduler {
+public:
+    static constexpr uint8_t MAX_JOBS = N2K_TX_MAX_JOBS;
+
+    N2kTransmitScheduler();
+
+    /**
+     * @brief Add a periodic transmit PGN
+     * @return false if the table is full, the PGN is already scheduled or arguments are invalid
+     */
+    bool addJob(uint32_t pgn, N2kTxBuilder build, const char* name, uint32_t periodMs, uint8_t priority);
+
+    /**
+     * @brief Write the scheduled PGNs as a 0-terminated list (for ExtendTransmitMessages)
+     * @param out Destination array
+     * @param maxEntries Capacity of out, including the terminator
+     * @return Number of PGNs written (excluding the terminator)
+     */
+    uint8_t buildTransmitList(unsigned long* out, uint8_t maxEntries) const;
+
+    /**
+     * @brief Limit the periodic budget by the measured bus load (nullptr = fixed share)
+     */
+    void setBusMonitor(const CanBusMonitor* monitor) { busMonitor = monitor; }
+
+    /**
+     * @brief Build and queue due messages within the bus-load budget (main loop)
+     * @param data BoatData snapshot
+     * @param nowMs Current millis()
+     */
+    void schedule(const BoatDataStructure& data, uint32_t nowMs);
+
+    /**
+     * @brief Queue one event message for the receive context (main loop)
+     * @return false if the outbox is full (counted in outbox_drops)
+     */
+    bool queue(const tN2kMsg& msg);
+
+    /**
+     * @brief Send queued messages (receive context only)
+     * @param bus Opened NMEA2000 instance
+     */
+    void flush(tNMEA2000* bus);
+
+    /**
+     * @brief Log N2K_TX_STATS (send counters, queue depths, per-PGN counters)
+     * @param logger WebSocket logger
+     * @param canTxQueueHighWater Driver TX queue high-water (frames)
+     */
+    void logStats(WebSocketLogger* logger, uint32_t canTxQueueHighWater) const;
+
+    /**
+     * @brief CAN frames needed for a payload (single frame or fast packet)
+     */
+    static uint8_t framesFor(int dataLen);
+
+    /**
+     * @brief Budget refill rate in frames per second (N2K_TX_BUS_LOAD_PCT, or @p percent of the bus)
+     */
+    static uint32_t budgetFramesPerSecond();
+    static uint32_t budgetFramesPerSecond(uint8_t percent);
+
+    /// Bus share (%) of the last refill, N2K_TX_BUS_LOAD_PCT unless the load gate cut it
+    uint8_t getSharePercent() const { return sharePercent; }
+
+    /// Passes whose share the load gate reduced
+    uint32_t getLoadThrottled() const { return loadThrottled; }
+
+    uint8_t getJobCount() const { return jobCount; }
+    const N2kTxJob* getJob(uint8_t index) const { return index < jobCount ? &jobs[index] : nullptr; }
+    uint32_t getSent() const { return sent; }
+    uint32_t getSendFailures() const { return sendFailures; }
+    uint32_t getEventsQueued() const { return eventsQueued; }
+
+private:
+    N2kTxJob jobs[MAX_JOBS];
+    uint8_t jobCount;
+    N2kTxQueue outbox;
+
+    uint32_t tokensMilliFrames;   ///< Remaining budget, 1/1000 frame units
+    uint32_t lastRefillMs;
+    bool started;
+    uint32_t eventsQueued;           ///< queue() messages handed to the outbox
+    const CanBusMonitor* busMonitor;
+    uint8_t sharePercent;
+    uint32_t loadThrottled;
+
+    volatile uint32_t sent;          ///< Written by the receive context only
+    volatile uint32_t sendFailures;  ///< Written by the receive context only
+
+    void refill(uint32_t nowMs);
+    static bool isDue(const N2kTxJob& job, uint32_t nowMs);
+};
+
+#endif // N2K_TRANSMIT_SCHEDULER_H
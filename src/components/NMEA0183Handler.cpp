@@ -1,100 +1,195 @@
 #include "NMEA0183Handler.h"
 #include "utils/UnitConverter.h"
+#include "utils/DataValidation.h"
 #include "utils/NMEA0183Parsers.h"
-#include <NMEA0183Messages.h>
+#include "utils/TraceRecorder.h"
+#include "utils/AllocTracker.h"
+#include "utils/AisVdmDecoder.h"
+#include "utils/UtcClock.h"
 #include <cmath>
-#include <cstring>
+#include <stdio.h>
+#include <string.h>
 
 // ***** TEMPORARY DEBUG FLAG - REMOVE AFTER DEBUGGING *****
 #define DEBUG_RAW_SERIAL2 0  // Set to 1 to enable raw serial dump
 // **********************************************************
 
-// Static instance pointer for callback (single instance pattern)
-static NMEA0183Handler* s_instance = nullptr;
-
-// Handler dispatch table
-const NMEA0183Handler::HandlerEntry NMEA0183Handler::handlers_[] = {
-    {"RSA", &NMEA0183Handler::handleRSA},
-    {"HDM", &NMEA0183Handler::handleHDM},
-    {"GGA", &NMEA0183Handler::handleGGA},
-    {"RMC", &NMEA0183Handler::handleRMC},
-    {"VTG", &NMEA0183Handler::handleVTG}
+// Handler dispatch table - keep sorted by message code (checked at compile time)
+constexpr NMEA0183Handler::HandlerEntry NMEA0183Handler::handlers_[] = {
+    {NMEA0183PackCode("GGA"), {{NMEA0183PackTalker("VH")}}, true, SensorType::GPS,
+     &NMEA0183Handler::handleGGA, "NMEA0183Handler::handleGGA"},
+    {NMEA0183PackCode("HDM"), {{NMEA0183PackTalker("AP")}}, true, SensorType::COMPASS,
+     &NMEA0183Handler::handleHDM, "NMEA0183Handler::handleHDM"},
+    {NMEA0183PackCode("RMC"), {{NMEA0183PackTalker("VH")}}, true, SensorType::GPS,
+     &NMEA0183Handler::handleRMC, "NMEA0183Handler::handleRMC"},
+    {NMEA0183PackCode("RSA"), {{NMEA0183PackTalker("AP")}}, false, SensorType::COMPASS,
+     &NMEA0183Handler::handleRSA, "NMEA0183Handler::handleRSA"},
+    {NMEA0183PackCode("VDM"), {{NMEA0183PackTalker("AI"), NMEA0183PackTalker("AB")}}, false, SensorType::GPS,
+     &NMEA0183Handler::handleVDM, "NMEA0183Handler::handleVDM"},
+    {NMEA0183PackCode("VTG"), {{NMEA0183PackTalker("VH")}}, true, SensorType::GPS,
+     &NMEA0183Handler::handleVTG, "NMEA0183Handler::handleVTG"}
 };
 
-const size_t NMEA0183Handler::handlersCount_ = sizeof(handlers_) / sizeof(handlers_[0]);
+namespace {
+
+/**
+ * @brief Address a sentence claims, for counting one that failed tokenizing
+ *
+ * Same key layout as NMEA0183Tokens; both keys 0 if the address is unreadable
+ * or proprietary.
+ */
+void claimedAddress(const char* line, size_t length, uint32_t& code, uint16_t& talker) {
+    code = 0;
+    talker = 0;
+    if (length < 7 || (line[0] != '$' && line[0] != '!') || line[6] != ',' || line[1] == 'P') {
+        return;
+    }
+    for (size_t i = 1; i < 6; i++) {
+        if (line[i] < 'A' || line[i] > 'Z') {
+            return;
+        }
+    }
+    talker = static_cast<uint16_t>((static_cast<uint8_t>(line[1]) << 8) | static_cast<uint8_t>(line[2]));
+    code = (static_cast<uint32_t>(static_cast<uint8_t>(line[3])) << 16) |
+           (static_cast<uint32_t>(static_cast<uint8_t>(line[4])) << 8) |
+           static_cast<uint32_t>(static_cast<uint8_t>(line[5]));
+}
+
+/**
+ * @brief Fix epoch key of an RMC/GGA sentence (UTC time, field 0)
+ */
+uint32_t fixTime(const NMEA0183Tokens& tokens) {
+    uint32_t centiseconds;
+    return NMEA0183FieldToTime(tokens.field(0), centiseconds) ? centiseconds
+                                                              : NMEA0183FixFusion::NO_TIME;
+}
 
-// Static callback for NMEA0183 library
-void NMEA0183MsgHandler(const tNMEA0183Msg &msg) {
-    if (s_instance != nullptr) {
-        s_instance->dispatchMessage(msg);
+/**
+ * @brief UTC of an RMC sentence: time (field 0) on date ddmmyy (field 8)
+ * @return 0 if either field is missing or invalid
+ */
+uint64_t rmcUtc(const NMEA0183Tokens& tokens) {
+    uint32_t centiseconds;
+    int32_t date;
+    if (tokens.field(8).len != 6 || !NMEA0183FieldToInt(tokens.field(8), date) || date < 0 ||
+        !NMEA0183FieldToTime(tokens.field(0), centiseconds)) {
+        return 0;
     }
+    int32_t year = date % 100;
+    year += year < 80 ? 2000 : 1900;
+    return UtcClock::fromCivil(year, static_cast<uint8_t>(date / 100 % 100), static_cast<uint8_t>(date / 10000),
+                               centiseconds * 10);
 }
 
-NMEA0183Handler::NMEA0183Handler(tNMEA0183* nmea0183, ISerialPort* serialPort,
-                                 BoatData* boatData, WebSocketLogger* logger)
-    : nmea0183_(nmea0183), serialPort_(serialPort), boatData_(boatData), logger_(logger) {
-    s_instance = this;  // Register this instance for callbacks
+}  // namespace
+
+NMEA0183Handler::NMEA0183Handler(ISerialPort* serialPort, BoatData* boatData,
+                                 WebSocketLogger* logger)
+    : boatData_(boatData), logger_(logger), portCount_(0),
+      current_(nullptr), sourceId_(nullptr), route_(nullptr),
+      lineObserver_(nullptr), lineObserverContext_(nullptr), aisTargets_(nullptr) {
+    // Port 0 keeps the original Serial2 configuration and "NMEA0183-AP"/"NMEA0183-VH" sources
+    NMEA0183PortConfig serial2 = {serialPort, 38400, "Serial2", "NMEA0183", {{0, 0}}};
+    addPort(serial2);
 }
 
-void NMEA0183Handler::init() {
-    // Initialize Serial2 at 38400 baud (project configuration)
-    serialPort_->begin(38400);
-
-    // Get underlying Stream for NMEA0183 library (required for ParseMessages)
-    Stream* stream = serialPort_->getStream();
-    if (stream == nullptr) {
-        logger_->broadcastLog(LogLevel::ERROR, "NMEA0183", "INIT_FAILED",
-                             "{\"reason\":\"Stream pointer is null\"}");
-        return;
+bool NMEA0183Handler::addPort(const NMEA0183PortConfig& config) {
+    if (config.port == nullptr || portCount_ >= NMEA0183_MAX_PORTS) {
+        return false;
     }
 
-    // Set message stream for NMEA0183 library (critical - library reads from this stream)
-    nmea0183_->SetMessageStream(stream);
+    Port& port = ports_[portCount_++];
+    port.config = config;
+    port.lineLength = 0;
+    port.lineOverflow = false;
+    port.lastDataMs = 0;
+    port.lastAvailableLog = 0;
+    port.sourceCount = 0;
+    memset(&port.stats, 0, sizeof(port.stats));
+    port.fusion = NMEA0183FixFusion();
+    port.fixSource = nullptr;
+    port.fixHandle = BoatDataSourceHandle();
+    return true;
+}
 
-    // Register message handler callback
-    nmea0183_->SetMsgHandler(NMEA0183MsgHandler);
+void NMEA0183Handler::init() {
+    for (uint8_t i = 0; i < portCount_; i++) {
+        Port& port = ports_[i];
+        port.config.port->begin(port.config.baud);
+
+        // A byte port without a stream failed to start (e.g. UART driver install failed)
+        if (!port.config.port->isSentencePort() && port.config.port->getStream() == nullptr) {
+            logger_->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA0183, LogEvent::INIT_FAILED,
+                                   "{\"port\":\"%s\",\"reason\":\"Stream pointer is null\"}",
+                                   port.config.name);
+            continue;
+        }
 
-    // Open/initialize NMEA0183 library (critical - prepares parser)
-    nmea0183_->Open();
+        port.lineLength = 0;
+        port.lineOverflow = false;
+        port.lastDataMs = millis();
 
-    logger_->broadcastLog(LogLevel::INFO, "NMEA0183", "INIT",
-                         "{\"port\":\"Serial2\",\"baud\":38400,\"stream\":\"configured\"}");
+        logger_->broadcastLogf(LogLevel::INFO, LogComponent::NMEA0183, LogEvent::INIT,
+                               "{\"port\":\"%s\",\"baud\":%lu,\"source_prefix\":\"%s\","
+                               "\"stream\":\"configured\"}",
+                               port.config.name, port.config.baud, port.config.sourcePrefix);
+    }
 }
 
 void NMEA0183Handler::processSentences() {
-    // Check if any data is available on Serial2 (basic connectivity check)
-    int bytesAvailable = serialPort_->available();
+    pumpSentences(0);
+}
+
+bool NMEA0183Handler::pumpSentences(uint8_t maxLinesPerPort) {
+    // One pass over all ports; each port keeps its own partial line between passes
+    bool more = false;
+    for (uint8_t i = 0; i < portCount_; i++) {
+        more |= drainPort(ports_[i], maxLinesPerPort);
 
-    // Log data availability periodically (every ~5 seconds at 10ms polling = 500 calls)
-    static uint16_t callCount = 0;
-    static unsigned long lastAvailableLog = 0;
-    callCount++;
+        // A fix whose remaining sentences never arrived is published incomplete
+        ports_[i].fusion.expire(millis());
+        publishFixes(ports_[i]);
+    }
+    return more;
+}
+
+bool NMEA0183Handler::drainPort(Port& port, uint8_t maxLines) {
+    ISerialPort* serial = port.config.port;
 
-    if (bytesAvailable > 0 && (millis() - lastAvailableLog > 5000)) {
-        String logData = String("{\"bytes_available\":") + String(bytesAvailable) + String("}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "SERIAL_DATA_AVAILABLE", logData);
-        lastAvailableLog = millis();
+    // Check if any data is available on the port (basic connectivity check)
+    int bytesAvailable = serial->available();
+    unsigned long now = millis();
+
+    // Log data availability periodically (every ~5 seconds)
+    if (bytesAvailable > 0 && (now - port.lastAvailableLog > 5000)) {
+        LOG_DEBUGF(logger_, LogComponent::NMEA0183, LogEvent::SERIAL_DATA_AVAILABLE,
+                   "{\"port\":\"%s\",\"bytes_available\":%d}", port.config.name, bytesAvailable);
+        port.lastAvailableLog = now;
     }
 
     // Log if no data for extended period (every 30 seconds)
-    static unsigned long lastNoDataLog = 0;
-    if (bytesAvailable == 0 && (millis() - lastNoDataLog > 30000)) {
-        logger_->broadcastLog(LogLevel::WARN, "NMEA0183", "NO_SERIAL_DATA",
-                             "{\"warning\":\"No data on Serial2 for 30+ seconds\"}");
-        lastNoDataLog = millis();
+    if (bytesAvailable > 0) {
+        port.lastDataMs = now;
+    } else if (now - port.lastDataMs > 30000) {
+        logger_->broadcastLogf(LogLevel::WARN, LogComponent::NMEA0183, LogEvent::NO_SERIAL_DATA,
+                               "{\"port\":\"%s\",\"warning\":\"No data for 30+ seconds\"}",
+                               port.config.name);
+        port.lastDataMs = now;
     }
 
 #if DEBUG_RAW_SERIAL2
-    // ***** TEMPORARY DEBUG CODE - Print raw Serial2 bytes to Serial (USB) *****
+    // ***** TEMPORARY DEBUG CODE - Print raw port bytes to Serial (USB) *****
     // Print all available bytes to help diagnose sentence parsing issues
     if (bytesAvailable > 0) {
         Serial.print("RAW[");
+        Serial.print(port.config.name);
+        Serial.print(":");
         Serial.print(bytesAvailable);
         Serial.print("]: ");
 
         // Read and echo all available bytes
-        while (serialPort_->available() > 0) {
-            int byte = serialPort_->read();
+        while (serial->available() > 0) {
+            int byte = serial->read();
             if (byte >= 32 && byte <= 126) {
                 // Printable ASCII
                 Serial.write(byte);
@@ -115,246 +210,519 @@ void NMEA0183Handler::processSentences() {
         // WARNING: We've consumed the bytes! Parser won't see them.
         // This is intentional for debugging - we want to see RAW data before parsing
     }
+    return false;
 #else
-    // Process all available NMEA 0183 messages
-    // The NMEA0183 library's ParseMessages() reads from the stream and calls
-    // the message handler callback for each complete sentence
-    nmea0183_->ParseMessages();
+    // Sentence ports (network input) deliver whole lines - no byte-wise assembly
+    uint8_t lines = 0;
+    if (serial->isSentencePort()) {
+        size_t length;
+        while ((length = serial->readSentence(port.line, sizeof(port.line))) > 0) {
+            port.stats.bytes += length;
+            processLine(port, port.line, length);
+            if (maxLines != 0 && ++lines >= maxLines) {
+                return true;  // No cheap "more waiting" check; at worst one empty call
+            }
+        }
+        return false;
+    }
+
+    // Assemble available bytes into lines; each complete line is tokenized in place
+    while (serial->available() > 0) {
+        int byte = serial->read();
+        if (byte < 0) {
+            break;
+        }
+        port.stats.bytes++;
+        if (addByte(port, static_cast<char>(byte)) && maxLines != 0 && ++lines >= maxLines) {
+            return serial->available() > 0;
+        }
+    }
+    return false;
 #endif
 }
 
-void NMEA0183Handler::dispatchMessage(const tNMEA0183Msg& msg) {
-    // Look up handler in dispatch table
-    const char* msgCode = msg.MessageCode();
-    bool handled = false;
+bool NMEA0183Handler::addByte(Port& port, char c) {
+    if (c == '$' || c == '!') {
+        // Start of sentence - resynchronizes after garbage or a lost line end
+        port.line[0] = c;
+        port.lineLength = 1;
+        port.lineOverflow = false;
+        return false;
+    }
 
-    for (size_t i = 0; i < handlersCount_; i++) {
-        if (strcmp(msgCode, handlers_[i].messageCode) == 0) {
-            // Call handler function
-            (this->*(handlers_[i].handler))(msg);
-            handled = true;
-            break;
+    if (c == '\r' || c == '\n') {
+        bool dispatched = port.lineLength > 0 && !port.lineOverflow;
+        if (dispatched) {
+            processLine(port, port.line, port.lineLength);
         }
+        port.lineLength = 0;
+        port.lineOverflow = false;
+        return dispatched;
     }
 
-    // Log unhandled message codes (FR-007 - silently ignore, but log for visibility)
-    if (!handled) {
-        String logData = String("{\"talker\":\"") + String(msg.Sender()) +
-                        String("\",\"message_code\":\"") + String(msgCode) + String("\"}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "MESSAGE_NOT_HANDLED", logData);
+    if (port.lineLength == 0) {
+        return false;  // Outside a sentence
+    }
+    if (port.lineLength >= sizeof(port.line)) {
+        if (!port.lineOverflow) {
+            port.stats.overflows++;
+        }
+        port.lineOverflow = true;  // Discard until the next line end
+        return false;
     }
+    port.line[port.lineLength++] = c;
+    return false;
 }
 
-void NMEA0183Handler::handleRSA(const tNMEA0183Msg& msg) {
-    double rudderAngle;
+bool NMEA0183Handler::injectLine(uint8_t index, const char* line, size_t length) {
+    if (index >= portCount_) {
+        return false;
+    }
+    ports_[index].stats.bytes += length;
+    processLine(ports_[index], line, length);
+    return true;
+}
 
-    // Parse RSA sentence (validates talker ID and status internally)
-    if (!NMEA0183ParseRSA(msg, rudderAngle)) {
-        return;  // Silent discard - invalid sentence or wrong talker ID
+void NMEA0183Handler::processLine(Port& port, const char* line, size_t length) {
+    uint8_t index = static_cast<uint8_t>(&port - ports_);
+    if (lineObserver_ != nullptr) {
+        lineObserver_(lineObserverContext_, index, line, length, millis());
     }
 
-    // Validate range: ±90° (FR-026)
-    if (fabs(rudderAngle) > 90.0) {
-        return;  // Silent discard - out of range
+    // Routed port: decide on the raw address bytes, before the checksum/field pass
+    const NMEA0183Route* route = nullptr;
+    if (routes_.routesPort(index)) {
+        uint32_t code;
+        uint16_t talker;
+        claimedAddress(line, length, code, talker);
+        switch (routes_.check(index, code, talker, millis(), route)) {
+            case NMEA0183RouteDecision::ROUTED:
+                break;
+            case NMEA0183RouteDecision::RATE_LIMITED:
+                port.stats.rateLimited++;
+                return;
+            default:
+                port.stats.unrouted++;
+                sentenceStats_.recordTalkerRejected(code, talker, length, millis());
+                return;  // Silent discard - not routed on this port
+        }
     }
 
-    // Convert to radians
-    double angleRadians = UnitConverter::degreesToRadians(rudderAngle);
+    NMEA0183Tokens tokens;
+    if (!tokens.tokenize(line, length)) {
+        port.stats.rejected++;
+        uint32_t code;
+        uint16_t talker;
+        claimedAddress(line, length, code, talker);
+        sentenceStats_.recordChecksumFailed(code, talker, length, millis());
+        LOG_DEBUGF(logger_, LogComponent::NMEA0183, LogEvent::SENTENCE_REJECTED,
+                   "{\"port\":\"%s\",\"reason\":\"framing or checksum\",\"length\":%u}",
+                   port.config.name, (unsigned)length);
+        return;  // Silent discard - corrupt sentence
+    }
+    port.stats.sentences++;
 
-    // Update BoatData
-    bool accepted = boatData_->updateRudder(angleRadians, "NMEA0183-AP");
+    current_ = &port;
+    route_ = route;
+    dispatchMessage(tokens);
+    route_ = nullptr;
+    current_ = nullptr;
+}
 
-    // Log if accepted (DEBUG level for valid sentences)
-    if (accepted) {
-        String logData = String("{\"type\":\"RSA\",\"source\":\"NMEA0183-AP\",\"value\":") +
-                        String(angleRadians, 4) + String("}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "SENTENCE_PROCESSED", logData);
+void NMEA0183Handler::logStats() {
+    for (uint8_t i = 0; i < portCount_; i++) {
+        const Port& port = ports_[i];
+        const NMEA0183PortStats& s = port.stats;
+        logger_->broadcastLogf(LogLevel::INFO, LogComponent::NMEA0183, LogEvent::N0183_PORT_STATS,
+                               "{\"port\":\"%s\",\"bytes\":%lu,\"sentences\":%lu,\"rejected\":%lu,"
+                               "\"overflows\":%lu,\"wrong_talker\":%lu,\"unhandled\":%lu,"
+                               "\"unrouted\":%lu,\"rate_limited\":%lu,\"sources\":%u,"
+                               "\"gps_sentences\":%lu,\"gps_fixes\":%lu}",
+                               port.config.name, (unsigned long)s.bytes, (unsigned long)s.sentences,
+                               (unsigned long)s.rejected, (unsigned long)s.overflows,
+                               (unsigned long)s.wrongTalker, (unsigned long)s.unhandled,
+                               (unsigned long)s.unrouted, (unsigned long)s.rateLimited,
+                               (unsigned)port.sourceCount,
+                               (unsigned long)port.fusion.getSentenceCount(),
+                               (unsigned long)port.fusion.getFixCount());
+
+        SerialPortStats stats;
+        if (!port.config.port->getStats(stats)) {
+            continue;
+        }
+
+        logger_->broadcastLogf(LogLevel::INFO, LogComponent::NMEA0183, LogEvent::UART_RX_STATS,
+                               "{\"port\":\"%s\",\"sentences\":%lu,\"dropped\":%lu,"
+                               "\"fifo_overflows\":%lu,\"buffer_full\":%lu,\"framing_errors\":%lu,"
+                               "\"buffer_high_water\":%lu}",
+                               port.config.name, (unsigned long)stats.sentences,
+                               (unsigned long)stats.droppedSentences,
+                               (unsigned long)stats.fifoOverflows, (unsigned long)stats.bufferFull,
+                               (unsigned long)stats.framingErrors, (unsigned long)stats.bufferHighWater);
+    }
+}
+
+bool NMEA0183Handler::getPortStats(uint8_t index, NMEA0183PortStats& stats) const {
+    if (index >= portCount_) {
+        return false;
     }
+    stats = ports_[index].stats;
+    stats.gpsSentences = ports_[index].fusion.getSentenceCount();
+    stats.gpsFixes = ports_[index].fusion.getFixCount();
+    return true;
 }
 
-void NMEA0183Handler::handleHDM(const tNMEA0183Msg& msg) {
-    // Validate talker ID is "AP" (autopilot)
-    if (strcmp(msg.Sender(), "AP") != 0) {
-        // Log rejection due to wrong talker ID
-        String logData = String("{\"talker\":\"") + String(msg.Sender()) +
-                        String("\",\"expected\":\"AP\",\"message_code\":\"HDM\"}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "WRONG_TALKER_REJECTED", logData);
+bool NMEA0183Handler::getPortSerialStats(uint8_t index, SerialPortStats& stats) const {
+    if (index >= portCount_ || ports_[index].config.port == nullptr) {
+        return false;
+    }
+    return ports_[index].config.port->getStats(stats);
+}
+
+void NMEA0183Handler::dispatchMessage(const NMEA0183Tokens& tokens) {
+    static_assert(NMEA0183IsSortedByCode(handlers_), "handlers_ must be sorted by message code");
+
+    // Sentences dispatched directly (not via processSentences) belong to port 0
+    if (portCount_ == 0) {
+        return;
+    }
+    Port* port = current_ != nullptr ? current_ : &ports_[0];
+
+    // One integer lookup selects the handler and its accepted talkers
+    const HandlerEntry* entry = NMEA0183FindByCode(handlers_, tokens.code());
+
+    uint32_t now = millis();
+
+    // Unhandled message codes are counted, not logged (FR-007 - silently ignore)
+    if (entry == nullptr) {
+        port->stats.unhandled++;
+        sentenceStats_.recordUnhandled(tokens.code(), tokens.talker(), tokens.length(), now);
+        return;
+    }
+
+    // A routed sentence passed its talker check on the header; otherwise a
+    // port whitelist replaces the entry's default talkers
+    const NMEA0183TalkerSet& talkers = port->config.talkers.talkers[0] != 0
+        ? port->config.talkers : entry->talkers;
+    if (route_ == nullptr && !talkers.accepts(tokens.talker())) {
+        port->stats.wrongTalker++;
+        sentenceStats_.recordTalkerRejected(tokens.code(), tokens.talker(), tokens.length(), now);
         return;  // Silent discard - wrong talker ID
     }
 
-    double heading;
+    Port* previous = current_;
+    current_ = port;
+    PortSource* source = findSource(tokens.talker(), entry->arbitrated, entry->sensor,
+                                    route_ != nullptr ? route_->source : nullptr);
+    if (source == nullptr) {
+        current_ = previous;
+        return;  // Source table full - untagged data is not accepted
+    }
 
-    // Parse HDM sentence using library parser
-    if (!NMEA0183ParseHDM_nc(msg, heading)) {
-        return;  // Silent discard - malformed sentence
+    sourceId_ = source->id;
+    sourceHandle_ = source->handle;
+    TRACE_BEGIN(TraceId::N0183_SENTENCE, tokens.code());
+    NMEA0183Result result;
+    {
+        ALLOC_SCOPE(entry->name);  // Allocations per sentence of this type
+        result = (this->*(entry->handler))(tokens);
     }
+    TRACE_END(TraceId::N0183_SENTENCE);
+    sourceId_ = nullptr;
+    sourceHandle_ = BoatDataSourceHandle();
+    current_ = previous;
 
-    // Validate range: [0°, 360°]
-    if (heading < 0.0 || heading > 360.0) {
-        return;  // Silent discard - out of range
+    sentenceStats_.recordHandled(tokens.code(), tokens.talker(), result, tokens.length(), now);
+}
+
+NMEA0183Handler::PortSource* NMEA0183Handler::findSource(uint16_t talker, bool arbitrated,
+                                                         SensorType sensor, const char* sourceId) {
+    Port& port = *current_;
+    char id[sizeof(port.sources[0].id)];
+    if (sourceId != nullptr && sourceId[0] != '\0') {
+        strncpy(id, sourceId, sizeof(id) - 1);
+        id[sizeof(id) - 1] = '\0';
+    } else {
+        snprintf(id, sizeof(id), "%s-%c%c", port.config.sourcePrefix,
+                 static_cast<char>(talker >> 8), static_cast<char>(talker & 0xFF));
     }
 
-    // Convert to radians
-    double headingRadians = UnitConverter::degreesToRadians(heading);
+    for (uint8_t i = 0; i < port.sourceCount; i++) {
+        PortSource& source = port.sources[i];
+        if (source.talker == talker && source.arbitrated == arbitrated &&
+            (!arbitrated || source.sensor == sensor) && strcmp(source.id, id) == 0) {
+            return &source;
+        }
+    }
 
-    // Update BoatData (trueHdg=0.0 not updated by HDM, variation=0.0 not updated)
-    bool accepted = boatData_->updateCompass(0.0, headingRadians, 0.0, "NMEA0183-AP");
+    if (port.sourceCount >= NMEA0183_MAX_PORT_SOURCES) {
+        LOG_DEBUGF(logger_, LogComponent::NMEA0183, LogEvent::SOURCE_TABLE_FULL,
+                   "{\"port\":\"%s\",\"max\":%d}", port.config.name, NMEA0183_MAX_PORT_SOURCES);
+        return nullptr;
+    }
 
-    // Log if accepted
-    if (accepted) {
-        String logData = String("{\"type\":\"HDM\",\"source\":\"NMEA0183-AP\",\"value\":") +
-                        String(headingRadians, 4) + String("}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "SENTENCE_PROCESSED", logData);
+    PortSource& source = port.sources[port.sourceCount++];
+    source.talker = talker;
+    source.arbitrated = arbitrated;
+    source.sensor = sensor;
+    source.handle = BoatDataSourceHandle();
+    memcpy(source.id, id, sizeof(source.id));
+
+    // Registered once per port/talker/sensor so each port competes as its own source
+    if (arbitrated) {
+        source.handle = boatData_->registerSource(source.id, sensor, ProtocolType::NMEA0183);
+        if (source.handle.valid()) {
+            logger_->broadcastLogf(LogLevel::INFO, LogComponent::NMEA0183, LogEvent::SOURCE_REGISTERED,
+                                   "{\"port\":\"%s\",\"source\":\"%s\",\"index\":%d}",
+                                   port.config.name, source.id, source.handle.index);
+        }
     }
+    return &source;
 }
 
-void NMEA0183Handler::handleGGA(const tNMEA0183Msg& msg) {
-    // Validate talker ID is "VH" (VHF radio)
-    if (strcmp(msg.Sender(), "VH") != 0) {
-        // Log rejection due to wrong talker ID
-        String logData = String("{\"talker\":\"") + String(msg.Sender()) +
-                        String("\",\"expected\":\"VH\",\"message_code\":\"GGA\"}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "WRONG_TALKER_REJECTED", logData);
-        return;  // Silent discard - wrong talker ID
+NMEA0183Result NMEA0183Handler::handleRSA(const NMEA0183Tokens& tokens) {
+    double rudderAngle;
+
+    // Parse RSA sentence (validates status; talker checked by dispatch)
+    if (!NMEA0183ParseRSA(tokens, rudderAngle)) {
+        return NMEA0183Result::PARSE_FAILED;  // Silent discard - invalid sentence
     }
 
-    double GPSTime;
-    double Latitude, Longitude, Altitude, GeoidalSeparation, DGPSAge;
-    int SatelliteCount;
-    double HDOP;
-    int GPSQualityIndicator;
-    int DGPSReferenceStationID;
+    // Convert to radians, validate range: ±90° (FR-026)
+    double angleRadians = UnitConverter::degreesToRadians(rudderAngle);
+    if (!DataValidation::RudderAngleRange::contains(angleRadians)) {
+        return NMEA0183Result::RANGE_REJECTED;  // Silent discard - out of range
+    }
+
+    // Update BoatData
+    bool accepted = boatData_->updateRudder(angleRadians, sourceId_);
 
-    // Parse GGA sentence using library parser
-    if (!NMEA0183ParseGGA_nc(msg, GPSTime, Latitude, Longitude, GPSQualityIndicator,
-                              SatelliteCount, HDOP, Altitude, GeoidalSeparation,
-                              DGPSAge, DGPSReferenceStationID)) {
-        return;  // Silent discard - malformed sentence
+    // Log if accepted (DEBUG level for valid sentences)
+    if (accepted) {
+        LOG_DEBUGF(logger_, LogComponent::NMEA0183, LogEvent::SENTENCE_PROCESSED,
+                   "{\"type\":\"RSA\",\"source\":\"%s\",\"value\":%.4f}", sourceId_, angleRadians);
     }
 
-    // Validate fix quality (must have valid fix)
-    if (GPSQualityIndicator == 0) {
-        return;  // Silent discard - no fix
+    return accepted ? NMEA0183Result::ACCEPTED : NMEA0183Result::RANGE_REJECTED;
+}
+
+NMEA0183Result NMEA0183Handler::handleHDM(const NMEA0183Tokens& tokens) {
+    double heading;
+
+    // Parse HDM sentence (zero-copy field view)
+    if (!NMEA0183ParseHDM(tokens, heading)) {
+        return NMEA0183Result::PARSE_FAILED;  // Silent discard - malformed sentence
     }
 
-    // Validate range: latitude [-90, 90], longitude [-180, 180]
-    if (fabs(Latitude) > 90.0 || fabs(Longitude) > 180.0) {
-        return;  // Silent discard - out of range
+    // Convert to radians, validate range: [0°, 360°]
+    double headingRadians = UnitConverter::degreesToRadians(heading);
+    if (!DataValidation::CourseRange::contains(headingRadians)) {
+        return NMEA0183Result::RANGE_REJECTED;  // Silent discard - out of range
     }
 
-    // Update BoatData (COG/SOG not in GGA, set to 0.0)
-    bool accepted = boatData_->updateGPS(Latitude, Longitude, 0.0, 0.0, "NMEA0183-VH");
+    // Update BoatData (trueHdg=0.0 not updated by HDM, variation=0.0 not updated)
+    bool accepted = boatData_->updateCompass(sourceHandle_, 0.0, headingRadians, 0.0,
+                                             CompassField::MAGNETIC_HEADING);
 
     // Log if accepted
     if (accepted) {
-        String logData = String("{\"type\":\"GGA\",\"source\":\"NMEA0183-VH\",\"lat\":") +
-                        String(Latitude, 6) + String(",\"lon\":") + String(Longitude, 6) + String("}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "SENTENCE_PROCESSED", logData);
+        LOG_DEBUGF(logger_, LogComponent::NMEA0183, LogEvent::SENTENCE_PROCESSED,
+                   "{\"type\":\"HDM\",\"source\":\"%s\",\"value\":%.4f}", sourceId_, headingRadians);
     }
+
+    return accepted ? NMEA0183Result::ACCEPTED : NMEA0183Result::RANGE_REJECTED;
 }
 
-void NMEA0183Handler::handleRMC(const tNMEA0183Msg& msg) {
-    // Validate talker ID is "VH" (VHF radio)
-    if (strcmp(msg.Sender(), "VH") != 0) {
-        // Log rejection due to wrong talker ID
-        String logData = String("{\"talker\":\"") + String(msg.Sender()) +
-                        String("\",\"expected\":\"VH\",\"message_code\":\"RMC\"}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "WRONG_TALKER_REJECTED", logData);
-        return;  // Silent discard - wrong talker ID
+NMEA0183Result NMEA0183Handler::handleGGA(const NMEA0183Tokens& tokens) {
+    double Latitude, Longitude;
+    int32_t GPSQualityIndicator;
+
+    // Parse GGA sentence (zero-copy field views)
+    if (!NMEA0183ParseGGA(tokens, Latitude, Longitude, GPSQualityIndicator)) {
+        return NMEA0183Result::PARSE_FAILED;  // Silent discard - malformed sentence
+    }
+
+    // Fix details rank this source in SourcePrioritizer, also while it is not active
+    if (sourceHandle_.valid()) {
+        int32_t satellites = 0;
+        double hdop = 0.0;
+        if (tokens.fieldCount() < 7 || !NMEA0183FieldToInt(tokens.field(6), satellites) || satellites < 0) {
+            satellites = 0;  // Unknown
+        }
+        if (tokens.fieldCount() < 8 || !NMEA0183FieldToDouble(tokens.field(7), hdop)) {
+            hdop = 0.0;
+        }
+        boatData_->reportSourceQuality(sourceHandle_, static_cast<uint8_t>(GPSQualityIndicator < 0 ? 0 : GPSQualityIndicator),
+                                       static_cast<uint8_t>(satellites > 255 ? 255 : satellites), hdop);
+    }
+
+    // Validate fix quality (must have valid fix)
+    if (GPSQualityIndicator == 0) {
+        return NMEA0183Result::RANGE_REJECTED;  // Silent discard - no fix
+    }
+
+    // Validate range: latitude [-90, 90], longitude [-180, 180]
+    if (!DataValidation::LatitudeRange::contains(Latitude) || !DataValidation::LongitudeRange::contains(Longitude)) {
+        return NMEA0183Result::RANGE_REJECTED;  // Silent discard - out of range
     }
 
-    double GPSTime;
+    // Position only - COG/SOG come from RMC/VTG of the same fix
+    NMEA0183FixInput fields = {};
+    fields.hasPosition = true;
+    fields.latitude = Latitude;
+    fields.longitude = Longitude;
+    return mergeFix(NMEA0183FixFusion::PART_GGA, fixTime(tokens), fields);
+}
+
+NMEA0183Result NMEA0183Handler::handleRMC(const NMEA0183Tokens& tokens) {
     double Latitude, Longitude, TrueCourse, SpeedOverGround;
-    unsigned long GPSDate;
     double Variation;
 
-    // Parse RMC sentence using library parser
-    if (!NMEA0183ParseRMC_nc(msg, GPSTime, Latitude, Longitude, TrueCourse,
-                              SpeedOverGround, GPSDate, Variation)) {
-        return;  // Silent discard - malformed sentence
+    // Parse RMC sentence (zero-copy field views, status must be 'A')
+    if (!NMEA0183ParseRMC(tokens, Latitude, Longitude, TrueCourse, SpeedOverGround, Variation)) {
+        return NMEA0183Result::PARSE_FAILED;  // Silent discard - malformed sentence
     }
 
     // Validate coordinate ranges
-    if (fabs(Latitude) > 90.0 || fabs(Longitude) > 180.0) {
-        return;  // Silent discard - out of range
+    if (!DataValidation::LatitudeRange::contains(Latitude) || !DataValidation::LongitudeRange::contains(Longitude)) {
+        return NMEA0183Result::RANGE_REJECTED;  // Silent discard - out of range
     }
 
     // Validate SOG range [0, 100 knots]
-    if (SpeedOverGround < 0.0 || SpeedOverGround > 100.0) {
-        return;  // Silent discard - invalid speed
+    if (!DataValidation::SogRange::contains(SpeedOverGround)) {
+        return NMEA0183Result::RANGE_REJECTED;  // Silent discard - invalid speed
     }
 
     // Validate variation range: ±30° (FR-026)
-    if (fabs(Variation) > 30.0) {
-        return;  // Silent discard - invalid variation
-    }
-
-    // Convert units
-    double cogRadians = UnitConverter::degreesToRadians(TrueCourse);
     double variationRadians = UnitConverter::degreesToRadians(Variation);
-
-    // Update GPS data
-    bool gpsAccepted = boatData_->updateGPS(Latitude, Longitude, cogRadians,
-                                            SpeedOverGround, "NMEA0183-VH");
-
-    // Update compass variation
-    bool compassAccepted = boatData_->updateCompass(0.0, 0.0, variationRadians, "NMEA0183-VH");
-
-    // Log if accepted
-    if (gpsAccepted || compassAccepted) {
-        String logData = String("{\"type\":\"RMC\",\"source\":\"NMEA0183-VH\",\"lat\":") +
-                        String(Latitude, 6) + String(",\"lon\":") + String(Longitude, 6) +
-                        String(",\"cog\":") + String(cogRadians, 4) + String(",\"sog\":") +
-                        String(SpeedOverGround, 2) + String(",\"var\":") + String(variationRadians, 4) + String("}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "SENTENCE_PROCESSED", logData);
+    if (!DataValidation::VariationRange::contains(variationRadians)) {
+        return NMEA0183Result::RANGE_REJECTED;  // Silent discard - invalid variation
     }
-}
 
-void NMEA0183Handler::handleVTG(const tNMEA0183Msg& msg) {
-    // Validate talker ID is "VH" (VHF radio)
-    if (strcmp(msg.Sender(), "VH") != 0) {
-        // Log rejection due to wrong talker ID
-        String logData = String("{\"talker\":\"") + String(msg.Sender()) +
-                        String("\",\"expected\":\"VH\",\"message_code\":\"VTG\"}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "WRONG_TALKER_REJECTED", logData);
-        return;  // Silent discard - wrong talker ID
+    // Convert units; an empty variation field leaves the current variation alone
+    NMEA0183FixInput fields = {};
+    fields.hasPosition = true;
+    fields.latitude = Latitude;
+    fields.longitude = Longitude;
+    fields.hasCourse = true;
+    fields.cog = UnitConverter::degreesToRadians(TrueCourse);
+    fields.sog = SpeedOverGround;
+    fields.hasVariation = !tokens.field(9).empty();
+    fields.variation = variationRadians;
+
+    // Date and time of a valid fix discipline the UTC clock (behind PGN 126992)
+    uint64_t utcMs = rmcUtc(tokens);
+    if (utcMs != 0) {
+        GetUtcClock().offer(UtcSource::NMEA0183_RMC, utcMs, millis());
     }
+    return mergeFix(NMEA0183FixFusion::PART_RMC, fixTime(tokens), fields);
+}
 
+NMEA0183Result NMEA0183Handler::handleVTG(const NMEA0183Tokens& tokens) {
     double TrueCourse, MagneticCourse, SpeedKnots;
 
-    // Parse VTG sentence using library parser (only 3 parameters)
-    if (!NMEA0183ParseVTG_nc(msg, TrueCourse, MagneticCourse, SpeedKnots)) {
-        return;  // Silent discard - malformed sentence
+    // Parse VTG sentence (zero-copy field views)
+    if (!NMEA0183ParseVTG(tokens, TrueCourse, MagneticCourse, SpeedKnots)) {
+        return NMEA0183Result::PARSE_FAILED;  // Silent discard - malformed sentence
     }
 
     // Calculate variation from COG difference
     double variation = UnitConverter::calculateVariation(TrueCourse, MagneticCourse);
 
     // Validate variation range: ±30° (FR-026)
-    if (fabs(variation) > 30.0) {
-        return;  // Silent discard - calculated variation out of range
+    double variationRadians = UnitConverter::degreesToRadians(variation);
+    if (!DataValidation::VariationRange::contains(variationRadians)) {
+        return NMEA0183Result::RANGE_REJECTED;  // Silent discard - calculated variation out of range
     }
 
     // Validate SOG range [0, 100 knots]
-    if (SpeedKnots < 0.0 || SpeedKnots > 100.0) {
-        return;  // Silent discard - invalid speed
+    if (!DataValidation::SogRange::contains(SpeedKnots)) {
+        return NMEA0183Result::RANGE_REJECTED;  // Silent discard - invalid speed
     }
 
-    // Convert units
-    double trueCOGRadians = UnitConverter::degreesToRadians(TrueCourse);
-    double variationRadians = UnitConverter::degreesToRadians(variation);
+    // Convert units (VTG has no position and no UTC time - joins the open fix)
+    NMEA0183FixInput fields = {};
+    fields.hasCourse = true;
+    fields.cog = UnitConverter::degreesToRadians(TrueCourse);
+    fields.sog = SpeedKnots;
+    fields.hasVariation = true;
+    fields.variation = variationRadians;
+    return mergeFix(NMEA0183FixFusion::PART_VTG, NMEA0183FixFusion::NO_TIME, fields);
+}
 
-    // Update GPS data (lat/lon not in VTG, set to 0.0)
-    bool gpsAccepted = boatData_->updateGPS(0.0, 0.0, trueCOGRadians, SpeedKnots, "NMEA0183-VH");
+NMEA0183Result NMEA0183Handler::mergeFix(uint8_t part, uint32_t timeKey,
+                                         const NMEA0183FixInput& fields) {
+    current_->fixSource = sourceId_;
+    current_->fixHandle = sourceHandle_;
+    current_->fusion.add(part, timeKey, fields, millis());
+    return publishFixes(*current_) ? NMEA0183Result::ACCEPTED : NMEA0183Result::RANGE_REJECTED;
+}
 
-    // Update compass variation
-    bool compassAccepted = boatData_->updateCompass(0.0, 0.0, variationRadians, "NMEA0183-VH");
+bool NMEA0183Handler::publishFixes(Port& port) {
+    bool allAccepted = true;
+    NMEA0183FixInput fix;
+
+    while (port.fusion.take(fix)) {
+        // Main loop is the BoatData writer: the view needs no copy and no valid() check
+        BoatDataView<GPSData> current = boatData_->viewGPSData();
+        bool gpsAccepted = false;
+        bool compassAccepted = false;
+
+        if (fix.hasPosition || fix.hasCourse) {
+            gpsAccepted = boatData_->updateGPS(port.fixHandle,
+                fix.hasPosition ? fix.latitude : current->latitude,
+                fix.hasPosition ? fix.longitude : current->longitude,
+                fix.hasCourse ? fix.cog : current->cog,
+                fix.hasCourse ? fix.sog : current->sog,
+                (fix.hasPosition ? GPSField::LATITUDE | GPSField::LONGITUDE : 0) |
+                (fix.hasCourse ? GPSField::COG | GPSField::SOG : 0));
+        }
+        // Variation follows its fix: not written when the fix came from an inactive GPS
+        if (fix.hasVariation && (gpsAccepted || !(fix.hasPosition || fix.hasCourse))) {
+            compassAccepted = boatData_->updateCompass(BoatDataSourceHandle(), 0.0, 0.0, fix.variation);
+        }
 
-    // Log if accepted
-    if (gpsAccepted || compassAccepted) {
-        String logData = String("{\"type\":\"VTG\",\"source\":\"NMEA0183-VH\",\"cog\":") +
-                        String(trueCOGRadians, 4) + String(",\"sog\":") + String(SpeedKnots, 2) +
-                        String(",\"var\":") + String(variationRadians, 4) + String("}");
-        logger_->broadcastLog(LogLevel::DEBUG, "NMEA0183", "SENTENCE_PROCESSED", logData);
+        if (gpsAccepted || compassAccepted) {
+            LOG_DEBUGF(logger_, LogComponent::NMEA0183, LogEvent::GPS_FIX_PUBLISHED,
+                       "{\"source\":\"%s\",\"parts\":%u,\"lat\":%.6f,\"lon\":%.6f,"
+                       "\"cog\":%.4f,\"sog\":%.2f,\"var\":%.4f}",
+                       port.fixSource != nullptr ? port.fixSource : "", (unsigned)fix.parts,
+                       fix.latitude, fix.longitude, fix.cog, fix.sog, fix.variation);
+        } else {
+            allAccepted = false;
+        }
+    }
+    return allAccepted;
+}
+
+NMEA0183Result NMEA0183Handler::handleVDM(const NMEA0183Tokens& tokens) {
+    // !AIVDM,<fragments>,<fragment>,<sequence>,<channel>,<payload>,<fill bits>
+    int32_t fragments, fillBits;
+    NMEA0183Field payload = tokens.field(4);
+    if (!NMEA0183FieldToInt(tokens.field(0), fragments) || payload.len == 0 ||
+        !NMEA0183FieldToInt(tokens.field(5), fillBits)) {
+        return NMEA0183Result::PARSE_FAILED;  // Silent discard - malformed sentence
+    }
+    if (fragments != 1 || aisTargets_ == nullptr) {
+        return NMEA0183Result::RANGE_REJECTED;  // Multi-sentence message, or AIS not tracked
+    }
+
+    AisPositionReport report;
+    switch (AisDecodePositionReport(payload.data, payload.len, static_cast<uint8_t>(fillBits), report)) {
+        case AisDecodeResult::OK:
+            break;
+        case AisDecodeResult::INVALID:
+            return NMEA0183Result::PARSE_FAILED;
+        default:
+            return NMEA0183Result::RANGE_REJECTED;  // Other message type or no position
     }
+    report.receivedMs = millis();
+    if (!aisTargets_->update(report)) {
+        return NMEA0183Result::RANGE_REJECTED;
+    }
+
+    LOG_DEBUGF(logger_, LogComponent::NMEA0183, LogEvent::SENTENCE_PROCESSED,
+               "{\"type\":\"VDM\",\"source\":\"%s\",\"mmsi\":%lu}", sourceId_,
+               (unsigned long)report.mmsi);
+    return NMEA0183Result::ACCEPTED;
 }
@@ -1,31 +1,63 @@
 #ifndef NMEA0183HANDLER_H
 #define NMEA0183HANDLER_H
 
-#include <NMEA0183.h>
 #include "hal/interfaces/ISerialPort.h"
 #include "components/BoatData.h"
+#include "components/NMEA0183SentenceStats.h"
 #include "utils/WebSocketLogger.h"
+#include "utils/NMEA0183FixFusion.h"
+#include "utils/NMEA0183RouteTable.h"
+#include "utils/NMEA0183SentenceKey.h"
+#include "utils/NMEA0183Tokenizer.h"
+#include "utils/AisTargetTable.h"
+#include "config.h"
 
 /**
  * @file NMEA0183Handler.h
  * @brief NMEA 0183 sentence handler component
  *
  * Coordinates NMEA 0183 sentence reception, parsing, and BoatData integration.
- * Processes 5 sentence types from 2 talker IDs:
+ * Processes 6 sentence types from 4 talker IDs:
  * - AP (autopilot): RSA (rudder angle), HDM (magnetic heading)
  * - VH (VHF radio): GGA (GPS position), RMC (GPS + variation), VTG (COG/SOG + variation)
+ * - AI/AB (AIS receiver): !VDM position reports into the AIS target table (setAisTargets())
  *
  * Architecture:
  * - Non-blocking: Processes available sentences in <50ms per ReactESP cycle
- * - HAL abstracted: Uses ISerialPort for Serial2 access
- * - Stateless: No buffering beyond Serial2 receive FIFO
- * - Silent discard: Invalid/out-of-range sentences logged at DEBUG, not ERROR
+ * - HAL abstracted: Uses ISerialPort for each input port (Serial2 by default)
+ * - Zero-copy parsing: bytes are assembled into one line buffer; NMEA0183Tokens
+ *   validates the checksum and records field offsets in a single pass, and
+ *   the parsers read fields in place with a fixed-point decimal parser
+ * - Minimal state: one line buffer beyond the serial port's receive buffer
+ * - Silent discard: Invalid/out-of-range sentences are counted per sentence
+ *   type and talker (NMEA0183SentenceStats, GET /nmea0183/stats), not logged
+ * - Integer dispatch: message code and talker ID are packed into integers and
+ *   looked up in a table sorted by code; each entry lists its accepted talkers,
+ *   so unknown sentences and wrong talkers are rejected by the same lookup
+ * - Multi-port input: up to NMEA0183_MAX_PORTS serial ports, each with its own
+ *   baud rate, talker whitelist and source ID prefix, drained by the same
+ *   processSentences() call. Every sentence is tagged with its port's source
+ *   ("<prefix>-<talker>", e.g. "NMEA0183-VH"); GPS/compass sources are
+ *   registered with BoatData on first use and their cached handle is passed
+ *   with every update, so BoatData records their rate and drops data from
+ *   sources that are not active
+ * - GPS fix fusion: RMC, GGA and VTG of one fix (same UTC time) are merged per
+ *   port (NMEA0183FixFusion) and published with one updateGPS() call, so the
+ *   GPS validation runs once per fix and no sentence overwrites fields it
+ *   does not carry
+ * - Routing: with a route table (setRoutes(), loaded from LittleFS by
+ *   NMEA0183RouteConfig) a port only accepts its routed (talker, sentence)
+ *   pairs. The decision is made on the raw header bytes before tokenizing;
+ *   routes also set the source ID and a maximum rate
  *
  * Usage:
  * @code
- * tNMEA0183 nmea0183;
  * ISerialPort* serialPort = new ESP32SerialPort(&Serial2);
- * NMEA0183Handler handler(&nmea0183, serialPort, boatData, &logger);
+ * NMEA0183Handler handler(serialPort, boatData, &logger);  // Port 0: Serial2, "NMEA0183"
+ *
+ * NMEA0183PortConfig gps = {gpsPort, 4800, "Serial1", "N0183-P2",
+ *                           {{NMEA0183PackTalker("GP")}}};
+ * handler.addPort(gps);
  * handler.init();
  *
  * // In ReactESP loop (10ms interval)
@@ -34,23 +66,68 @@
  * });
  * @endcode
  */
+/**
+ * @brief Raw line callback (main loop), e.g. BusCapture
+ *
+ * @param port Index of the input port the line arrived on
+ * @param line Line as received (not NUL-terminated, checksum not verified)
+ */
+typedef void (*NMEA0183LineObserver)(void* context, uint8_t port, const char* line,
+                                     size_t length, uint32_t nowMs);
+
+/**
+ * @brief Configuration of one NMEA 0183 input port
+ */
+struct NMEA0183PortConfig {
+    ISerialPort* port;          ///< Serial port (not owned)
+    unsigned long baud;         ///< Baud rate passed to begin() by init()
+    const char* name;           ///< Port name for logs (e.g., "Serial2")
+    const char* sourcePrefix;   ///< Source ID prefix; source = "<prefix>-<talker>" (max 12 chars)
+    NMEA0183TalkerSet talkers;  ///< Talker whitelist; all 0 = per-sentence defaults (AP/VH)
+};
+
+/**
+ * @brief Receive counters of one input port (main loop only)
+ */
+struct NMEA0183PortStats {
+    uint32_t bytes;          ///< Bytes read from the port
+    uint32_t sentences;      ///< Checksum-valid sentences
+    uint32_t rejected;       ///< Framing or checksum errors
+    uint32_t overflows;      ///< Lines longer than NMEA0183_MAX_LINE
+    uint32_t wrongTalker;    ///< Talker not accepted by the whitelist/dispatch entry
+    uint32_t unhandled;      ///< Message codes without a handler
+    uint32_t unrouted;       ///< Not routed or route disabled (discarded before tokenizing)
+    uint32_t rateLimited;    ///< Above the route's maximum rate (discarded before tokenizing)
+    uint32_t gpsSentences;   ///< RMC/GGA/VTG merged by the fix fusion stage
+    uint32_t gpsFixes;       ///< Consolidated GPS updates published
+};
+
 class NMEA0183Handler {
 public:
     /**
      * @brief Constructor
      *
-     * @param nmea0183 NMEA0183 library instance (for sentence parsing)
      * @param serialPort Serial port interface (ISerialPort wrapper for Serial2)
      * @param boatData BoatData repository (for sensor updates via ISensorUpdate)
      * @param logger WebSocket logger (for network debugging)
      */
-    NMEA0183Handler(tNMEA0183* nmea0183, ISerialPort* serialPort,
-                    BoatData* boatData, WebSocketLogger* logger);
+    NMEA0183Handler(ISerialPort* serialPort, BoatData* boatData, WebSocketLogger* logger);
+
+    /**
+     * @brief Add another input port (before init())
+     *
+     * The constructor's port is port 0 ("Serial2", 38400 baud, prefix
+     * "NMEA0183", default talkers).
+     *
+     * @param config Port configuration (strings must outlive the handler)
+     * @return false if config.port is nullptr or NMEA0183_MAX_PORTS are in use
+     */
+    bool addPort(const NMEA0183PortConfig& config);
 
     /**
-     * @brief Initialize Serial2 and NMEA parser
+     * @brief Initialize all ports and the NMEA parser
      *
-     * Starts Serial2 at 4800 baud (NMEA 0183 standard rate) and prepares parser.
+     * Starts each port at its configured baud rate and resets its line buffer.
      * Must be called before processSentences().
      */
     void init();
@@ -58,43 +135,213 @@ public:
     /**
      * @brief Process pending NMEA sentences (called from ReactESP loop)
      *
-     * Reads available bytes from Serial2, feeds to NMEA parser, and dispatches
-     * complete sentences to handler functions. Non-blocking operation - processes
+     * Drains every port in turn into its own line buffer, tokenizes each
+     * complete line and dispatches it to handler functions, then publishes GPS
+     * fixes whose epoch timed out. Non-blocking operation - processes
      * all available sentences or returns within 50ms budget (FR-027).
      *
-     * Called every 10ms by ReactESP event loop.
+     * The firmware's I/O pump uses the bounded pumpSentences() instead.
      */
     void processSentences();
 
+    /**
+     * @brief Bounded processSentences() for the I/O pump
+     *
+     * Reads at most @p maxLinesPerPort complete lines from each port, so one
+     * busy port cannot hold the loop, then publishes timed-out fixes as
+     * processSentences() does.
+     *
+     * @return true if a port still has bytes waiting (call again)
+     */
+    bool pumpSentences(uint8_t maxLinesPerPort);
+
+    /**
+     * @brief Log N0183_PORT_STATS per port (throughput and error counters)
+     *
+     * Ports with driver-level counters (ESP32UartEventPort) also log
+     * UART_RX_STATS.
+     */
+    void logStats();
+
+    /**
+     * @brief Call @p observer for every complete line of every port (nullptr = none)
+     */
+    void setLineObserver(NMEA0183LineObserver observer, void* context) {
+        lineObserver_ = observer;
+        lineObserverContext_ = context;
+    }
+
+    /**
+     * @brief Process one line as if it had arrived on port @p index (replay)
+     *
+     * @return false if index >= getPortCount()
+     */
+    bool injectLine(uint8_t index, const char* line, size_t length);
+
+    /**
+     * @brief Replace the routing table (main loop, typically once before init())
+     *
+     * Route port indices refer to addPort() order (0 = constructor's Serial2).
+     */
+    void setRoutes(const NMEA0183RouteTable& routes) { routes_ = routes; }
+
+    const NMEA0183RouteTable& getRoutes() const { return routes_; }
+
+    /**
+     * @brief AIS target table for !AIVDM position reports (nullptr = VDM not applied)
+     *
+     * The table is updated directly: sentences are processed on the main
+     * loop, the table's writer.
+     */
+    void setAisTargets(AisTargetTable* targets) { aisTargets_ = targets; }
+
+    /// Number of configured ports
+    uint8_t getPortCount() const { return portCount_; }
+
+    /**
+     * @brief Receive counters of port @p index
+     * @return false if index >= getPortCount()
+     */
+    bool getPortStats(uint8_t index, NMEA0183PortStats& stats) const;
+
+    /**
+     * @brief Driver counters of port @p index (ISerialPort::getStats())
+     * @return false if index >= getPortCount() or the port keeps none
+     */
+    bool getPortSerialStats(uint8_t index, SerialPortStats& stats) const;
+
+    /// Name of port @p index (NMEA0183PortConfig::name), nullptr if out of range
+    const char* getPortName(uint8_t index) const {
+        return index < portCount_ ? ports_[index].config.name : nullptr;
+    }
+
+    /**
+     * @brief Per-(sentence type, talker) parse-quality table (GET /nmea0183/stats)
+     */
+    const NMEA0183SentenceStats& getSentenceStats() const { return sentenceStats_; }
+
     /**
      * @brief Dispatch message to appropriate handler
      *
-     * Called by static callback from NMEA0183 library. Looks up handler in
-     * dispatch table and calls appropriate handler function.
+     * Called for every checksum-valid line. Binary searches the
+     * dispatch table by packed message code, rejects talkers not accepted by
+     * the port whitelist (or the entry's default talkers) unless the line was
+     * routed, tags the sentence with its route or port source and calls the
+     * entry's handler function.
      *
-     * @param msg NMEA0183 message object
+     * @param tokens Tokenized sentence (fields view into the line buffer)
      */
-    void dispatchMessage(const tNMEA0183Msg& msg);
+    void dispatchMessage(const NMEA0183Tokens& tokens);
 
 private:
-    tNMEA0183* nmea0183_;           ///< NMEA0183 library instance
-    ISerialPort* serialPort_;       ///< Serial port interface
+    /**
+     * @brief One talker (per sensor type) seen on a port
+     */
+    struct PortSource {
+        uint16_t talker;        ///< Packed talker ID
+        bool arbitrated;        ///< Registered with BoatData (GPS/compass sentences)
+        SensorType sensor;      ///< Sensor type (if arbitrated)
+        BoatDataSourceHandle handle;  ///< Arbitrated update handle (unregistered if not arbitrated)
+        char id[16];            ///< "<prefix>-<talker>" (SourcePrioritizer ID length)
+    };
+
+    /**
+     * @brief Input port: configuration, line buffer, sources and counters
+     */
+    struct Port {
+        NMEA0183PortConfig config;
+        char line[NMEA0183_MAX_LINE];   ///< Sentence being assembled
+        size_t lineLength;              ///< Bytes in line (0 = waiting for '$')
+        bool lineOverflow;              ///< Line too long - discard until line end
+        unsigned long lastDataMs;       ///< Last time bytes were available
+        unsigned long lastAvailableLog; ///< Last SERIAL_DATA_AVAILABLE event
+        PortSource sources[NMEA0183_MAX_PORT_SOURCES];
+        uint8_t sourceCount;
+        NMEA0183PortStats stats;
+        NMEA0183FixFusion fusion;       ///< RMC/GGA/VTG of one fix merged into one update
+        const char* fixSource;          ///< Source ID of the last merged GPS sentence
+        BoatDataSourceHandle fixHandle; ///< Source handle of the last merged GPS sentence
+    };
+
     BoatData* boatData_;            ///< BoatData repository
     WebSocketLogger* logger_;       ///< WebSocket logger
+    Port ports_[NMEA0183_MAX_PORTS];
+    uint8_t portCount_;
+    Port* current_;                 ///< Port of the sentence being dispatched
+    const char* sourceId_;          ///< Source ID of the sentence being dispatched
+    BoatDataSourceHandle sourceHandle_;  ///< Source handle of the sentence being dispatched
+    const NMEA0183Route* route_;    ///< Route of the sentence being dispatched (nullptr = unrouted port)
+    NMEA0183RouteTable routes_;     ///< Talker/sentence routing (empty = built-in talkers)
+    NMEA0183SentenceStats sentenceStats_;  ///< Counters per (sentence type, talker), all ports
+    NMEA0183LineObserver lineObserver_;    ///< Optional raw line tap (capture)
+    void* lineObserverContext_;
+    AisTargetTable* aisTargets_;    ///< VDM position reports (nullptr = not applied)
+
+    /**
+     * @brief Read available bytes of one port
+     *
+     * @param maxLines Stop after this many complete lines (0 = read everything)
+     * @return true if it stopped at @p maxLines with bytes still waiting
+     */
+    bool drainPort(Port& port, uint8_t maxLines);
+
+    /**
+     * @brief Add one received byte; a line end tokenizes and dispatches the line
+     *
+     * @return true if a complete line was dispatched
+     */
+    bool addByte(Port& port, char c);
+
+    /**
+     * @brief Tokenize one line in place and dispatch it
+     */
+    void processLine(Port& port, const char* line, size_t length);
+
+    /**
+     * @brief Source of (talker, sensor) on the current port, created on first use
+     *
+     * @param sourceId Source ID from the route, nullptr/"" = "<prefix>-<talker>"
+     * @return Source slot, nullptr if the port's source table is full
+     */
+    PortSource* findSource(uint16_t talker, bool arbitrated, SensorType sensor,
+                           const char* sourceId);
+
+    /**
+     * @brief Merge a validated GPS sentence into the current port's fix and publish
+     *
+     * @param part NMEA0183FixFusion::PART_* of the sentence
+     * @param timeKey UTC time (hundredths of a second), NMEA0183FixFusion::NO_TIME if absent
+     * @param fields Validated sentence fields in BoatData units
+     * @return ACCEPTED, or RANGE_REJECTED if BoatData rejected a fix published now
+     */
+    NMEA0183Result mergeFix(uint8_t part, uint32_t timeKey, const NMEA0183FixInput& fields);
+
+    /**
+     * @brief Publish the port's ready fixes with one updateGPS()/updateCompass() each
+     *
+     * Fields a fix lacks keep their current BoatData values.
+     *
+     * @return false if BoatData rejected a published fix
+     */
+    bool publishFixes(Port& port);
 
     /**
      * @brief Handler dispatch table entry
      *
-     * Maps NMEA message codes to handler function pointers for efficient dispatch.
+     * Maps packed NMEA message codes to handler function pointers and the
+     * talker IDs the handler accepts.
      */
     struct HandlerEntry {
-        const char* messageCode;    ///< NMEA message code (e.g., "RSA", "HDM")
-        void (NMEA0183Handler::*handler)(const tNMEA0183Msg&);  ///< Handler function
+        uint32_t code;              ///< Packed message code (NMEA0183PackCode("RSA"))
+        NMEA0183TalkerSet talkers;  ///< Accepted talker IDs (NMEA0183PackTalker("AP"))
+        bool arbitrated;            ///< Source competes in SourcePrioritizer (sensor below)
+        SensorType sensor;          ///< Prioritizer sensor type of the sentence
+        NMEA0183Result (NMEA0183Handler::*handler)(const NMEA0183Tokens&);  ///< Handler function
+        const char* name;           ///< Handler name (AllocTracker tag of a sentence)
     };
 
-    /// Handler dispatch table (5 supported message types)
+    /// Handler dispatch table (6 supported message types, sorted by code)
     static const HandlerEntry handlers_[];
-    static const size_t handlersCount_;
 
     // Sentence-specific handler functions
 
@@ -102,54 +349,72 @@ private:
      * @brief Handle RSA (Rudder Sensor Angle) sentence from autopilot
      *
      * Extracts rudder angle, converts to radians, updates BoatData.RudderData.
-     * Validates talker ID="AP", range ±90°, status='A'.
+     * Talker ID="AP" (dispatch table), validates range ±90°, status='A'.
      *
-     * @param msg NMEA0183 message object
+     * @param tokens Tokenized sentence
+     * @return ACCEPTED, PARSE_FAILED or RANGE_REJECTED (sentence statistics)
      */
-    void handleRSA(const tNMEA0183Msg& msg);
+    NMEA0183Result handleRSA(const NMEA0183Tokens& tokens);
 
     /**
      * @brief Handle HDM (Heading Magnetic) sentence from autopilot
      *
      * Extracts magnetic heading, converts to radians, updates BoatData.CompassData.
-     * Validates talker ID="AP", range [0°, 360°].
+     * Talker ID="AP" (dispatch table), validates range [0°, 360°].
      *
-     * @param msg NMEA0183 message object
+     * @param tokens Tokenized sentence
+     * @return ACCEPTED, PARSE_FAILED or RANGE_REJECTED (sentence statistics)
      */
-    void handleHDM(const tNMEA0183Msg& msg);
+    NMEA0183Result handleHDM(const NMEA0183Tokens& tokens);
 
     /**
      * @brief Handle GGA (GPS Fix Data) sentence from VHF
      *
-     * Extracts lat/lon in DDMM.MMMM format, converts to decimal degrees,
-     * updates BoatData.GPSData. Validates talker ID="VH", fix quality > 0,
-     * coordinate ranges.
+     * Extracts lat/lon in DDMM.MMMM format, converts to decimal degrees and
+     * merges them into the port's fix (mergeFix). Talker ID="VH" (dispatch
+     * table), validates fix quality > 0, coordinate ranges.
      *
-     * @param msg NMEA0183 message object
+     * @param tokens Tokenized sentence
+     * @return ACCEPTED, PARSE_FAILED or RANGE_REJECTED (sentence statistics)
      */
-    void handleGGA(const tNMEA0183Msg& msg);
+    NMEA0183Result handleGGA(const NMEA0183Tokens& tokens);
 
     /**
      * @brief Handle RMC (Recommended Minimum Navigation) sentence from VHF
      *
-     * Extracts lat/lon/COG/SOG/variation, converts units, updates
-     * BoatData.GPSData and BoatData.CompassData. Validates talker ID="VH",
+     * Extracts lat/lon/COG/SOG/variation, converts units and merges them into
+     * the port's fix (mergeFix). Talker ID="VH" (dispatch table), validates
      * status='A', variation range ±30°.
      *
-     * @param msg NMEA0183 message object
+     * @param tokens Tokenized sentence
+     * @return ACCEPTED, PARSE_FAILED or RANGE_REJECTED (sentence statistics)
      */
-    void handleRMC(const tNMEA0183Msg& msg);
+    NMEA0183Result handleRMC(const NMEA0183Tokens& tokens);
 
     /**
      * @brief Handle VTG (Track Made Good) sentence from VHF
      *
-     * Extracts true/magnetic COG and SOG, calculates variation from difference,
-     * updates BoatData.GPSData and BoatData.CompassData. Validates talker ID="VH",
-     * calculated variation range ±30°.
+     * Extracts true/magnetic COG and SOG, calculates variation from difference
+     * and merges them into the port's fix (mergeFix). Talker ID="VH"
+     * (dispatch table), validates calculated variation range ±30°.
+     *
+     * @param tokens Tokenized sentence
+     * @return ACCEPTED, PARSE_FAILED or RANGE_REJECTED (sentence statistics)
+     */
+    NMEA0183Result handleVTG(const NMEA0183Tokens& tokens);
+
+    /**
+     * @brief Handle VDM (AIS VHF Data-link Message) sentence from an AIS receiver
+     *
+     * Decodes single-sentence position reports (types 1-3, 18; AisVdmDecoder)
+     * into the AIS target table. Talker ID="AI"/"AB" (dispatch table).
+     * Multi-sentence messages (static data) are not reassembled.
      *
-     * @param msg NMEA0183 message object
+     * @param tokens Tokenized sentence
+     * @return ACCEPTED; PARSE_FAILED for a malformed payload; RANGE_REJECTED
+     *         for other message types, fragments, no position or no table
      */
-    void handleVTG(const tNMEA0183Msg& msg);
+    NMEA0183Result handleVDM(const NMEA0183Tokens& tokens);
 };
 
 #endif // NMEA0183HANDLER_H
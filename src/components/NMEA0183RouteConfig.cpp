@@ -0,0 +1,128 @@
+/**
+ * @file NMEA0183RouteConfig.cpp
+ * @brief Implementation of the NMEA 0183 routing file loader
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "NMEA0183RouteConfig.h"
+#include "../utils/AtomicFile.h"
+
+namespace {
+
+/// Port index of a configured port name, -1 if unknown
+int portIndex(const NMEA0183Handler* handler, const char* name) {
+    for (uint8_t i = 0; i < handler->getPortCount(); i++) {
+        if (strcmp(handler->getPortName(i), name) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+bool NMEA0183RouteConfig::load(const char* path, NMEA0183Handler* handler, WebSocketLogger* logger) {
+    if (handler == nullptr || logger == nullptr || !LittleFS.exists(path)) {
+        return false;  // No file - built-in talkers
+    }
+
+    NMEA0183RouteTable routes;
+    uint8_t skipped = 0;
+    if (!parse(path, handler, logger, routes, skipped)) {
+        return false;
+    }
+    handler->setRoutes(routes);
+    logLoaded(path, routes, skipped, logger);
+    return true;
+}
+
+bool NMEA0183RouteConfig::reload(const char* path, const char* candidate, NMEA0183Handler* handler,
+                                 WebSocketLogger* logger) {
+    if (handler == nullptr || logger == nullptr) {
+        return false;
+    }
+
+    NMEA0183RouteTable routes;
+    uint8_t skipped = 0;
+    if (candidate != nullptr && LittleFS.exists(candidate)) {
+        // Uploaded: becomes the routing file only if the handler takes it
+        if (!parse(candidate, handler, logger, routes, skipped)) {
+            LittleFS.remove(candidate);
+            return false;
+        }
+        if (!AtomicFileReplace(candidate, path)) {
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA0183, LogEvent::CONFIG_SAVE_FAILED,
+                "{\"path\":\"%s\",\"reason\":\"rename failed, applied until reboot\"}", path);
+        }
+    } else if (!LittleFS.exists(path)) {
+        handler->setRoutes(routes);  // Empty table - built-in talkers
+        logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA0183, LogEvent::ROUTES_LOADED,
+            "{\"path\":\"%s\",\"routes\":0,\"skipped\":0,\"max\":%d,\"builtin\":true}",
+            path, NMEA0183_MAX_ROUTES);
+        return true;
+    } else if (!parse(path, handler, logger, routes, skipped)) {
+        return false;
+    }
+
+    handler->setRoutes(routes);
+    logLoaded(path, routes, skipped, logger);
+    return true;
+}
+
+bool NMEA0183RouteConfig::parse(const char* path, NMEA0183Handler* handler, WebSocketLogger* logger,
+                                NMEA0183RouteTable& routes, uint8_t& skipped) {
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    // Released before the routes are installed
+    DynamicJsonDocument doc(NMEA0183_ROUTES_JSON_CAPACITY);
+    DeserializationError error = deserializeJson(doc, file);
+    file.close();
+
+    JsonObject ports = doc["ports"];
+    if (error || ports.isNull()) {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA0183, LogEvent::ROUTES_INVALID,
+            "{\"path\":\"%s\",\"reason\":\"%s\"}", path, error ? error.c_str() : "missing ports object");
+        return false;
+    }
+
+    skipped = 0;
+    for (JsonPair entry : ports) {
+        int port = portIndex(handler, entry.key().c_str());
+        JsonArray list = entry.value().as<JsonArray>();
+        if (port < 0 || list.isNull()) {
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA0183, LogEvent::ROUTES_PORT_UNKNOWN,
+                "{\"port\":\"%s\"}", entry.key().c_str());
+            continue;
+        }
+
+        for (JsonObject route : list) {
+            uint32_t code = NMEA0183PackCode(route["sentence"] | "");
+            uint16_t talker = NMEA0183PackTalker(route["talker"] | "");
+            if (!routes.add(static_cast<uint8_t>(port), code, talker, route["source"] | "",
+                            route["enabled"] | true, route["max_rate_hz"] | 0.0f)) {
+                skipped++;  // Bad talker/sentence or table full
+            }
+        }
+    }
+
+    if (routes.size() == 0) {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA0183, LogEvent::ROUTES_INVALID,
+            "{\"path\":\"%s\",\"reason\":\"no valid routes\",\"skipped\":%u}", path, (unsigned)skipped);
+        return false;
+    }
+
+    routes.finalize();
+    return true;
+}
+
+void NMEA0183RouteConfig::logLoaded(const char* path, const NMEA0183RouteTable& routes, uint8_t skipped,
+                                    WebSocketLogger* logger) {
+    logger->broadcastLogf(skipped > 0 ? LogLevel::WARN : LogLevel::INFO, LogComponent::NMEA0183, LogEvent::ROUTES_LOADED,
+        "{\"path\":\"%s\",\"routes\":%u,\"skipped\":%u,\"max\":%d}",
+        path, (unsigned)routes.size(), (unsigned)skipped, NMEA0183_MAX_ROUTES);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file NMEA0183RouteConfig.h
+ * @brief Loads the NMEA 0183 talker/sentence routing table from LittleFS
+ *
+ * File format (NMEA0183_ROUTES_FILE, /nmea0183-routes.json):
+ * {
+ *   "version": 1,
+ *   "ports": {
+ *     "Serial2": [
+ *       {"talker": "AP", "sentence": "HDM", "source": "AP-HDG", "max_rate_hz": 10},
+ *       {"talker": "AP", "sentence": "RSA"},
+ *       {"talker": "VH", "sentence": "RMC", "max_rate_hz": 1},
+ *       {"talker": "VH", "sentence": "GGA", "enabled": false}
+ *     ],
+ *     "Serial1": [
+ *       {"talker": "GP", "sentence": "RMC"}
+ *     ]
+ *   }
+ * }
+ *
+ * - Port keys are NMEA0183PortConfig names; a listed port accepts only its
+ *   routes, ports not listed keep the built-in talkers (AP, VH)
+ * - "source" (optional, max 15 characters) replaces "<prefix>-<talker>"
+ * - "enabled" defaults to true, "max_rate_hz" to 0 (unlimited)
+ *
+ * A missing file leaves the built-in talkers in place. An invalid file is
+ * logged (ROUTES_INVALID) and ignored as a whole, so a typo never silences
+ * a port; invalid single routes are skipped and counted.
+ *
+ * Live reload (ConfigService NMEA0183_ROUTES, main loop): an upload is
+ * staged as NMEA0183_ROUTES_FILE NMEA0183_ROUTES_UPLOAD_SUFFIX and only
+ * renamed over the routing file once it parsed, so flash never holds a
+ * file that the running table did not accept.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef NMEA0183_ROUTE_CONFIG_H
+#define NMEA0183_ROUTE_CONFIG_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <ArduinoJson.h>
+#include "NMEA0183Handler.h"
+#include "../utils/WebSocketLogger.h"
+
+/**
+ * @brief Routing file loader
+ *
+ * Usage pattern (after addPort(), before handler.init()):
+ * @code
+ * NMEA0183RouteConfig::load(NMEA0183_ROUTES_FILE, nmea0183Handler, &logger);
+ * @endcode
+ */
+class NMEA0183RouteConfig {
+public:
+    /**
+     * @brief Parse @p path and install its routes in @p handler
+     *
+     * Logs ROUTES_LOADED (INFO) or ROUTES_INVALID (ERROR).
+     *
+     * @return true if routes were installed, false if the file is missing or invalid
+     */
+    static bool load(const char* path, NMEA0183Handler* handler, WebSocketLogger* logger);
+
+    /**
+     * @brief Install a changed routing file at runtime (main loop)
+     *
+     * If @p candidate exists it is parsed and, when valid, renamed over
+     * @p path; an invalid candidate is deleted. Otherwise @p path is read
+     * again, and a missing @p path restores the built-in talkers. Invalid
+     * input keeps the installed routes.
+     *
+     * @return false if the candidate or the file was invalid
+     */
+    static bool reload(const char* path, const char* candidate, NMEA0183Handler* handler, WebSocketLogger* logger);
+
+private:
+    /**
+     * @brief Parse @p path into @p routes (finalized)
+     * @return false if the file cannot be read or holds no valid route (logged)
+     */
+    static bool parse(const char* path, NMEA0183Handler* handler, WebSocketLogger* logger,
+                      NMEA0183RouteTable& routes, uint8_t& skipped);
+
+    static void logLoaded(const char* path, const NMEA0183RouteTable& routes, uint8_t skipped,
+                          WebSocketLogger* logger);
+};
+
+#endif // NMEA0183_ROUTE_CONFIG_H
@@ -0,0 +1,174 @@
+/**
+ * @file NMEA0183SentenceStats.cpp
+ * @brief Implementation of the per-(sentence type, talker) statistics table
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "NMEA0183SentenceStats.h"
+#include <string.h>
+
+NMEA0183SentenceStats::NMEA0183SentenceStats() {
+    reset();
+}
+
+void NMEA0183SentenceStats::reset() {
+    memset(slots, 0, sizeof(slots));
+    entryCount = 0;
+    overflow = 0;
+    totalReceived = 0;
+}
+
+uint8_t NMEA0183SentenceStats::hashSlot(uint32_t code, uint16_t talker) {
+    // Multiplicative hash of code and talker, top bits select the slot
+    uint32_t key = (code * 0x9E3779B1u) ^ talker;
+    return static_cast<uint8_t>((key * 2654435761u) >> 24) & (SLOTS - 1);
+}
+
+NMEA0183SentenceStatsEntry* NMEA0183SentenceStats::touch(uint32_t code, uint16_t talker,
+                                                         size_t bytes, uint32_t nowMs) {
+    totalReceived++;
+
+    uint8_t slot = hashSlot(code, talker);
+    NMEA0183SentenceStatsEntry* e = nullptr;
+    while (slots[slot].used) {
+        if (slots[slot].code == code && slots[slot].talker == talker) {
+            e = &slots[slot];
+            break;
+        }
+        slot = (slot + 1) & (SLOTS - 1);
+    }
+
+    if (e == nullptr) {
+        if (entryCount >= MAX_ENTRIES) {
+            overflow++;
+            return nullptr;
+        }
+        e = &slots[slot];
+        memset(e, 0, sizeof(*e));
+        e->code = code;
+        e->talker = talker;
+        e->used = true;  // Last, so a concurrent reader never sees a half-filled key
+        entryCount++;
+    }
+
+    if (e->received > 0) {
+        float interval = static_cast<float>(nowMs - e->lastRxMs);
+        e->intervalMs = (e->intervalMs == 0.0f)
+            ? interval
+            : e->intervalMs + NMEA0183_STATS_RATE_ALPHA * (interval - e->intervalMs);
+    }
+    e->lastRxMs = nowMs;
+    e->received++;
+    e->bytes += static_cast<uint32_t>(bytes);
+    return e;
+}
+
+void NMEA0183SentenceStats::recordHandled(uint32_t code, uint16_t talker, NMEA0183Result result,
+                                          size_t bytes, uint32_t nowMs) {
+    NMEA0183SentenceStatsEntry* e = touch(code, talker, bytes, nowMs);
+    if (e == nullptr) {
+        return;
+    }
+
+    e->handled = true;
+    switch (result) {
+        case NMEA0183Result::ACCEPTED:       e->accepted++;      break;
+        case NMEA0183Result::PARSE_FAILED:   e->parseFailed++;   break;
+        case NMEA0183Result::RANGE_REJECTED: e->rangeRejected++; break;
+    }
+}
+
+void NMEA0183SentenceStats::recordChecksumFailed(uint32_t code, uint16_t talker, size_t bytes,
+                                                 uint32_t nowMs) {
+    NMEA0183SentenceStatsEntry* e = touch(code, talker, bytes, nowMs);
+    if (e != nullptr) {
+        e->checksumFailed++;
+    }
+}
+
+void NMEA0183SentenceStats::recordTalkerRejected(uint32_t code, uint16_t talker, size_t bytes,
+                                                 uint32_t nowMs) {
+    NMEA0183SentenceStatsEntry* e = touch(code, talker, bytes, nowMs);
+    if (e != nullptr) {
+        e->talkerRejected++;
+    }
+}
+
+void NMEA0183SentenceStats::recordUnhandled(uint32_t code, uint16_t talker, size_t bytes,
+                                            uint32_t nowMs) {
+    NMEA0183SentenceStatsEntry* e = touch(code, talker, bytes, nowMs);
+    if (e != nullptr) {
+        e->unhandled++;
+    }
+}
+
+const NMEA0183SentenceStatsEntry* NMEA0183SentenceStats::find(uint32_t code, uint16_t talker) const {
+    uint8_t slot = hashSlot(code, talker);
+    while (slots[slot].used) {
+        if (slots[slot].code == code && slots[slot].talker == talker) {
+            return &slots[slot];
+        }
+        slot = (slot + 1) & (SLOTS - 1);
+    }
+    return nullptr;
+}
+
+float NMEA0183SentenceStats::rateHz(const NMEA0183SentenceStatsEntry& entry, uint32_t nowMs) {
+    if (entry.intervalMs <= 0.0f) {
+        return 0.0f;
+    }
+
+    // A pair that has gone quiet decays towards 0 instead of freezing
+    float sinceLast = static_cast<float>(nowMs - entry.lastRxMs);
+    float interval = sinceLast > entry.intervalMs ? sinceLast : entry.intervalMs;
+    return 1000.0f / interval;
+}
+
+float NMEA0183SentenceStats::bytesPerSecond(const NMEA0183SentenceStatsEntry& entry, uint32_t nowMs) {
+    if (entry.received == 0) {
+        return 0.0f;
+    }
+    float meanLength = static_cast<float>(entry.bytes) / static_cast<float>(entry.received);
+    return rateHz(entry, nowMs) * meanLength;
+}
+
+void NMEA0183SentenceStats::unpackKey(const NMEA0183SentenceStatsEntry& e, char* type, char* talker) {
+    type[0] = '\0';
+    talker[0] = '\0';
+    if (e.code != 0) {
+        type[0] = static_cast<char>((e.code >> 16) & 0xFF);
+        type[1] = static_cast<char>((e.code >> 8) & 0xFF);
+        type[2] = static_cast<char>(e.code & 0xFF);
+        type[3] = '\0';
+    }
+    if (e.talker != 0) {
+        talker[0] = static_cast<char>(e.talker >> 8);
+        talker[1] = static_cast<char>(e.talker & 0xFF);
+        talker[2] = '\0';
+    }
+}
+
+void NMEA0183SentenceStats::writeEntry(JsonWriter& out, const NMEA0183SentenceStatsEntry& e,
+                                       uint32_t nowMs) {
+    char type[4];
+    char talker[3];
+    unpackKey(e, type, talker);
+
+    out.beginObject()
+        .add("type", type)
+        .add("talker", talker)
+        .add("handled", e.handled)
+        .add("count", (unsigned long)e.received)
+        .add("accepted", (unsigned long)e.accepted)
+        .add("checksum_failed", (unsigned long)e.checksumFailed)
+        .add("parse_failed", (unsigned long)e.parseFailed)
+        .add("range_rejected", (unsigned long)e.rangeRejected)
+        .add("talker_rejected", (unsigned long)e.talkerRejected)
+        .add("unhandled", (unsigned long)e.unhandled)
+        .add("rate_hz", (double)rateHz(e, nowMs), 2)
+        .add("bytes_per_s", (double)bytesPerSecond(e, nowMs), 1)
+        .add("last_rx_ms_ago", (unsigned long)(nowMs - e.lastRxMs))
+        .endObject();
+}
@@ -0,0 +1,172 @@
+/**
+ * @file NMEA0183SentenceStats.h
+ * @brief Fixed-size per-(sentence type, talker) NMEA 0183 parse-quality statistics
+ *
+ * Tells a noisy wire from a quiet one without per-sentence logs. For each
+ * (message code, talker ID) pair received it keeps accepted, checksum-failed,
+ * parse-failed, range-rejected, talker-rejected and unhandled counts, the
+ * bytes received and an EWMA sentence rate. Served as JSON on
+ * GET /nmea0183/stats.
+ *
+ * A sentence with a bad checksum is counted under the address it claims
+ * (the address may itself be corrupt); one whose framing is unreadable is
+ * counted under the empty key (code 0, talker 0).
+ *
+ * Pairs live in an open-addressed hash table, like N2kPGNStats. Entries are
+ * never moved or removed (except reset()), so a reader in another task sees
+ * at worst a counter that lags by a sentence.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed table, zero heap allocation
+ * - Principle VII (Fail-Safe): a full table counts new pairs as overflow
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef NMEA0183_SENTENCE_STATS_H
+#define NMEA0183_SENTENCE_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../utils/JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Outcome of a sentence handler
+ */
+enum class NMEA0183Result : uint8_t {
+    ACCEPTED = 0,       ///< Parsed, in range and applied to BoatData
+    PARSE_FAILED = 1,   ///< Field missing, not numeric or status not valid
+    RANGE_REJECTED = 2  ///< Parsed, but out of range (handler or BoatData) or from an inactive source
+};
+
+/**
+ * @brief Counters for one (message code, talker) pair
+ */
+struct NMEA0183SentenceStatsEntry {
+    uint32_t code;             ///< Packed message code (NMEA0183PackCode), 0 = unreadable
+    uint16_t talker;           ///< Packed talker ID (NMEA0183PackTalker), 0 = none/proprietary
+    bool used;
+    bool handled;              ///< A table handler processed these sentences
+    uint32_t received;         ///< All sentences, including the rejected ones
+    uint32_t accepted;
+    uint32_t checksumFailed;   ///< Framing or checksum invalid
+    uint32_t parseFailed;
+    uint32_t rangeRejected;
+    uint32_t talkerRejected;   ///< Talker not accepted by the port whitelist/dispatch entry
+    uint32_t unhandled;        ///< No handler for the message code
+    uint32_t bytes;            ///< Bytes of all received sentences (without line end)
+    uint32_t lastRxMs;
+    float intervalMs;          ///< EWMA of the inter-arrival time (0 = < 2 sentences)
+};
+
+/**
+ * @class NMEA0183SentenceStats
+ * @brief Single-writer statistics table (main loop writes, HTTP reads)
+ */
+class NMEA0183SentenceStats {
+public:
+    static constexpr uint8_t SLOTS = NMEA0183_STATS_SLOTS;
+    static constexpr uint8_t MAX_ENTRIES = NMEA0183_STATS_MAX_ENTRIES;
+
+    static_assert((SLOTS & (SLOTS - 1)) == 0, "NMEA0183_STATS_SLOTS must be a power of two");
+    static_assert(MAX_ENTRIES < SLOTS, "NMEA0183_STATS_MAX_ENTRIES must leave free hash slots");
+
+    NMEA0183SentenceStats();
+
+    /**
+     * @brief Count a sentence a table handler processed
+     */
+    void recordHandled(uint32_t code, uint16_t talker, NMEA0183Result result,
+                       size_t bytes, uint32_t nowMs);
+
+    /**
+     * @brief Count a sentence with invalid framing or checksum
+     *
+     * @param code Claimed message code (0 if unreadable)
+     * @param talker Claimed talker ID (0 if unreadable)
+     */
+    void recordChecksumFailed(uint32_t code, uint16_t talker, size_t bytes, uint32_t nowMs);
+
+    /**
+     * @brief Count a sentence rejected for its talker ID
+     */
+    void recordTalkerRejected(uint32_t code, uint16_t talker, size_t bytes, uint32_t nowMs);
+
+    /**
+     * @brief Count a sentence no handler is registered for
+     */
+    void recordUnhandled(uint32_t code, uint16_t talker, size_t bytes, uint32_t nowMs);
+
+    /**
+     * @brief Look up a pair
+     * @return Entry, or nullptr if never seen (or not tracked due to overflow)
+     */
+    const NMEA0183SentenceStatsEntry* find(uint32_t code, uint16_t talker) const;
+
+    /**
+     * @brief Smoothed sentence rate, decaying once the pair goes quiet
+     * @return Sentences per second (0 until two sentences have been seen)
+     */
+    static float rateHz(const NMEA0183SentenceStatsEntry& entry, uint32_t nowMs);
+
+    /**
+     * @brief Smoothed byte rate (sentence rate x mean sentence length)
+     */
+    static float bytesPerSecond(const NMEA0183SentenceStatsEntry& entry, uint32_t nowMs);
+
+    /**
+     * @brief Unpack the keys of @p entry back to text ("" for unreadable/proprietary addresses)
+     * @param type At least 4 bytes ("HDM")
+     * @param talker At least 3 bytes ("AP")
+     */
+    static void unpackKey(const NMEA0183SentenceStatsEntry& entry, char* type, char* talker);
+
+    /**
+     * @brief Write one entry as a JSON object (unkeyed - for use in an array)
+     */
+    static void writeEntry(JsonWriter& out, const NMEA0183SentenceStatsEntry& entry, uint32_t nowMs);
+
+    /**
+     * @brief Visit every tracked entry (slot order)
+     */
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        for (uint8_t i = 0; i < SLOTS; i++) {
+            if (slots[i].used) {
+                fn(slots[i]);
+            }
+        }
+    }
+
+    /// Entry in hash slot @p slot, nullptr when free (indexed walk, e.g. GET /metrics)
+    const NMEA0183SentenceStatsEntry* getSlot(uint8_t slot) const {
+        return slot < SLOTS && slots[slot].used ? &slots[slot] : nullptr;
+    }
+
+    uint8_t getEntryCount() const { return entryCount; }
+    uint32_t getOverflowCount() const { return overflow; }
+    uint32_t getTotalReceived() const { return totalReceived; }
+
+    /**
+     * @brief Forget all pairs (main loop only)
+     */
+    void reset();
+
+private:
+    NMEA0183SentenceStatsEntry slots[SLOTS];
+    uint8_t entryCount;
+    uint32_t overflow;        ///< Sentences from pairs that did not fit
+    uint32_t totalReceived;
+
+    static uint8_t hashSlot(uint32_t code, uint16_t talker);
+
+    /**
+     * @brief Find or insert the entry for a pair, updating rate and byte bookkeeping
+     * @return Entry, or nullptr if the table is full (overflow counted)
+     */
+    NMEA0183SentenceStatsEntry* touch(uint32_t code, uint16_t talker, size_t bytes, uint32_t nowMs);
+};
+
+#endif // NMEA0183_SENTENCE_STATS_H
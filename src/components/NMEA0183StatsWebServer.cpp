@@ -0,0 +1,74 @@
+/**
+ * @file NMEA0183StatsWebServer.cpp
+ * @brief Implementation of the NMEA 0183 statistics endpoint
+ *
+ * @see NMEA0183StatsWebServer.h
+ */
+
+#include "NMEA0183StatsWebServer.h"
+#include "../utils/JsonWriter.h"
+
+NMEA0183StatsWebServer::NMEA0183StatsWebServer(const NMEA0183Handler* nmea0183Handler)
+    : handler(nmea0183Handler) {
+}
+
+void NMEA0183StatsWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || handler == nullptr) {
+        return;
+    }
+
+    // GET /nmea0183/stats - Per-port and per-(sentence type, talker) statistics
+    server->on("/nmea0183/stats", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetStats(request);
+    });
+}
+
+void NMEA0183StatsWebServer::handleGetStats(AsyncWebServerRequest* request) {
+    uint32_t now = millis();
+    const NMEA0183SentenceStats& stats = handler->getSentenceStats();
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+
+    response->printf("{\"uptime_ms\":%lu,\"sentences\":%lu,\"entries\":%u,\"overflow\":%lu,",
+        (unsigned long)now, (unsigned long)stats.getTotalReceived(),
+        (unsigned)stats.getEntryCount(), (unsigned long)stats.getOverflowCount());
+
+    response->print("\"ports\":[");
+    for (uint8_t i = 0; i < handler->getPortCount(); i++) {
+        NMEA0183PortStats port;
+        if (!handler->getPortStats(i, port)) {
+            continue;
+        }
+
+        StaticJsonWriter<256> item;
+        item.beginObject()
+            .add("name", handler->getPortName(i))
+            .add("bytes", (unsigned long)port.bytes)
+            .add("sentences", (unsigned long)port.sentences)
+            .add("rejected", (unsigned long)port.rejected)
+            .add("overflows", (unsigned long)port.overflows)
+            .add("wrong_talker", (unsigned long)port.wrongTalker)
+            .add("unhandled", (unsigned long)port.unhandled)
+            .add("unrouted", (unsigned long)port.unrouted)
+            .add("rate_limited", (unsigned long)port.rateLimited)
+            .endObject();
+        if (i > 0) {
+            response->print(',');
+        }
+        response->print(item.c_str());
+    }
+    response->print("],\"types\":[");
+
+    bool first = true;
+    stats.forEach([&](const NMEA0183SentenceStatsEntry& entry) {
+        StaticJsonWriter<384> item;  // Worst case entry is ~300 bytes
+        NMEA0183SentenceStats::writeEntry(item, entry, now);
+        if (!first) {
+            response->print(',');
+        }
+        response->print(item.c_str());
+        first = false;
+    });
+
+    response->print("]}");
+    request->send(response);
+}
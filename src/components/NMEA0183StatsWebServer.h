@@ -0,0 +1,76 @@
+/**
+ * @file NMEA0183StatsWebServer.h
+ * @brief HTTP endpoint for NMEA 0183 parse-quality statistics
+ *
+ * Provides:
+ * - GET /nmea0183/stats: Per-port counters and per-(sentence type, talker)
+ *   accepted/rejected counts and rates
+ *
+ * Registered on the ConfigWebServer instance alongside N2kStatsWebServer.
+ * The response is streamed one entry at a time, so its size does not depend
+ * on a fixed JSON document buffer.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef NMEA0183_STATS_WEB_SERVER_H
+#define NMEA0183_STATS_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "NMEA0183Handler.h"
+
+/**
+ * @brief Web server routes for the NMEA 0183 statistics table
+ */
+class NMEA0183StatsWebServer {
+private:
+    const NMEA0183Handler* handler;
+
+    /**
+     * @brief Handle GET /nmea0183/stats
+     *
+     * Returns:
+     * {
+     *   "uptime_ms": 123456, "sentences": 9876, "entries": 6, "overflow": 0,
+     *   "ports": [
+     *     {"name": "Serial2", "bytes": 456789, "sentences": 9876, "rejected": 3,
+     *      "overflows": 0, "wrong_talker": 12, "unhandled": 40, "unrouted": 0,
+     *      "rate_limited": 0},
+     *     ...
+     *   ],
+     *   "types": [
+     *     {"type": "RMC", "talker": "VH", "handled": true, "count": 1234,
+     *      "accepted": 1220, "checksum_failed": 2, "parse_failed": 0,
+     *      "range_rejected": 12, "talker_rejected": 0, "unhandled": 0,
+     *      "rate_hz": 1.00, "bytes_per_s": 70.0, "last_rx_ms_ago": 400},
+     *     ...
+     *   ]
+     * }
+     *
+     * Counters are read without locking while the main loop updates them;
+     * a single value may lag by one sentence.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetStats(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param nmea0183Handler Handler owning the port counters and sentence table
+     */
+    explicit NMEA0183StatsWebServer(const NMEA0183Handler* nmea0183Handler);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // NMEA0183_STATS_WEB_SERVER_H
@@ -0,0 +1,374 @@
+/**
+ * @file NMEA0183TcpGateway.cpp
+ * @brief Implementation of the NMEA 0183 TCP stream
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "NMEA0183TcpGateway.h"
+#include "../utils/DataValidation.h"
+#include "../utils/UnitConverter.h"
+#include <math.h>
+#include <stdio.h>
+
+namespace {
+
+bool isFresh(bool available, unsigned long lastUpdate, uint32_t nowMs) {
+    return available && (nowMs - lastUpdate) <= N0183_TCP_MAX_DATA_AGE_MS;
+}
+
+double toDegrees360(double radians) {
+    return UnitConverter::radiansToDegrees(UnitConverter::normalizeAngle(radians));
+}
+
+double variationDegrees(const GPSData& gps, uint32_t nowMs) {
+    return isFresh(gps.available, gps.lastUpdate, nowMs)
+        ? UnitConverter::radiansToDegrees(gps.variation) : NAN;
+}
+
+size_t encodeHDG(char* buf, size_t size, const BoatDataStructure& data, uint32_t nowMs) {
+    const CompassData& compass = data.compass;
+    if (!isFresh(compass.available, compass.lastUpdate, nowMs)) {
+        return 0;
+    }
+    return NMEA0183EncodeHDG(buf, size, N0183_TCP_TALKER, toDegrees360(compass.magneticHeading),
+                             variationDegrees(data.gps, nowMs));
+}
+
+size_t encodeHDM(char* buf, size_t size, const BoatDataStructure& data, uint32_t nowMs) {
+    const CompassData& compass = data.compass;
+    if (!isFresh(compass.available, compass.lastUpdate, nowMs)) {
+        return 0;
+    }
+    return NMEA0183EncodeHDM(buf, size, N0183_TCP_TALKER, toDegrees360(compass.magneticHeading));
+}
+
+size_t encodeRSA(char* buf, size_t size, const BoatDataStructure& data, uint32_t nowMs) {
+    const RudderData& rudder = data.rudder;
+    if (!isFresh(rudder.available, rudder.lastUpdate, nowMs)) {
+        return 0;
+    }
+    // Signed angle, positive = starboard (same convention as RudderData)
+    return NMEA0183EncodeRSA(buf, size, N0183_TCP_TALKER,
+                             UnitConverter::radiansToDegrees(rudder.steeringAngle));
+}
+
+size_t encodeApparentMWV(char* buf, size_t size, const BoatDataStructure& data, uint32_t nowMs) {
+    const WindData& wind = data.wind;
+    if (!isFresh(wind.available, wind.lastUpdate, nowMs)) {
+        return 0;
+    }
+    return NMEA0183EncodeMWV(buf, size, N0183_TCP_TALKER, toDegrees360(wind.apparentWindAngle), 'R',
+                             wind.apparentWindSpeed);
+}
+
+size_t encodeTrueMWV(char* buf, size_t size, const BoatDataStructure& data, uint32_t nowMs) {
+    const DerivedData& derived = data.derived;
+    if (!isFresh(derived.available, derived.lastUpdate, nowMs)) {
+        return 0;
+    }
+    return NMEA0183EncodeMWV(buf, size, N0183_TCP_TALKER, toDegrees360(derived.twa), 'T',
+                             derived.tws);
+}
+
+size_t encodeMWD(char* buf, size_t size, const BoatDataStructure& data, uint32_t nowMs) {
+    const DerivedData& derived = data.derived;
+    if (!isFresh(derived.available, derived.lastUpdate, nowMs)) {
+        return 0;
+    }
+
+    // DerivedData.wdir is magnetic; the true direction needs a fresh variation
+    double variation = variationDegrees(data.gps, nowMs);
+    double magnetic = toDegrees360(derived.wdir);
+    double trueDir = NAN;
+    if (!isnan(variation)) {
+        trueDir = fmod(magnetic + variation + 360.0, 360.0);
+    }
+    return NMEA0183EncodeMWD(buf, size, N0183_TCP_TALKER, trueDir, magnetic, derived.tws);
+}
+
+size_t encodeDPT(char* buf, size_t size, const BoatDataStructure& data, uint32_t nowMs) {
+    const DSTData& dst = data.dst;
+    if (!isFresh(dst.available, dst.lastUpdate, nowMs)) {
+        return 0;
+    }
+    // DSTData.depth already includes the transducer offset (below waterline)
+    return NMEA0183EncodeDPT(buf, size, N0183_TCP_TALKER, dst.depth, 0.0);
+}
+
+size_t encodeVHW(char* buf, size_t size, const BoatDataStructure& data, uint32_t nowMs) {
+    const DSTData& dst = data.dst;
+    if (!isFresh(dst.available, dst.lastUpdate, nowMs)) {
+        return 0;
+    }
+
+    const CompassData& compass = data.compass;
+    bool headingFresh = isFresh(compass.available, compass.lastUpdate, nowMs);
+    return NMEA0183EncodeVHW(buf, size, N0183_TCP_TALKER,
+                             headingFresh ? toDegrees360(compass.trueHeading) : NAN,
+                             headingFresh ? toDegrees360(compass.magneticHeading) : NAN,
+                             DataValidation::mpsToKnots(dst.measuredBoatSpeed));
+}
+
+size_t encodeRMC(char* buf, size_t size, const BoatDataStructure& data, uint32_t nowMs) {
+    const GPSData& gps = data.gps;
+    if (!isFresh(gps.available, gps.lastUpdate, nowMs)) {
+        return 0;
+    }
+    return NMEA0183EncodeRMC(buf, size, N0183_TCP_TALKER, gps.latitude, gps.longitude, gps.sog,
+                             toDegrees360(gps.cog), UnitConverter::radiansToDegrees(gps.variation),
+                             true);
+}
+
+}  // namespace
+
+NMEA0183TcpGateway::NMEA0183TcpGateway()
+    : server(nullptr), logger(nullptr),
+      sentences{
+          {"HDG",   encodeHDG,         N0183_TCP_INTERVAL_HDG_MS, 0, 0, 0},
+          {"HDM",   encodeHDM,         N0183_TCP_INTERVAL_HDM_MS, 0, 0, 0},
+          {"RSA",   encodeRSA,         N0183_TCP_INTERVAL_RSA_MS, 0, 0, 0},
+          {"MWV/R", encodeApparentMWV, N0183_TCP_INTERVAL_MWV_MS, 0, 0, 0},
+          {"MWV/T", encodeTrueMWV,     N0183_TCP_INTERVAL_MWV_MS, 0, 0, 0},
+          {"MWD",   encodeMWD,         N0183_TCP_INTERVAL_MWD_MS, 0, 0, 0},
+          {"DPT",   encodeDPT,         N0183_TCP_INTERVAL_DPT_MS, 0, 0, 0},
+          {"VHW",   encodeVHW,         N0183_TCP_INTERVAL_VHW_MS, 0, 0, 0},
+          {"RMC",   encodeRMC,         N0183_TCP_INTERVAL_RMC_MS, 0, 0, 0},
+      },
+      refusedClients(0), lostBytesTotal(0), droppedClients(0) {
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        slots[i].state.store(SLOT_FREE, std::memory_order_relaxed);
+        slots[i].client = nullptr;
+        slots[i].cursor = 0;
+        slots[i].lostBytes = 0;
+        slots[i].stalledSinceMs = 0;
+        slots[i].stalled = false;
+    }
+    line[0] = '\0';
+}
+
+bool NMEA0183TcpGateway::begin(WebSocketLogger* log) {
+    if (log == nullptr || server != nullptr) {
+        return false;
+    }
+
+    logger = log;
+    server = new AsyncServer(N0183_TCP_PORT);
+    server->onClient([](void* arg, AsyncClient* client) {
+        static_cast<NMEA0183TcpGateway*>(arg)->onClient(client);
+    }, this);
+    server->setNoDelay(true);
+    server->begin();
+
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA0183, LogEvent::TCP_STREAM_STARTED,
+        "{\"port\":%d,\"max_clients\":%d,\"buffer\":%u}",
+        N0183_TCP_PORT, N0183_TCP_MAX_CLIENTS, (unsigned)NMEA0183StreamBuffer::CAPACITY);
+    return true;
+}
+
+void NMEA0183TcpGateway::onClient(AsyncClient* client) {
+    // AsyncTCP task: claim a free slot; the main loop adopts it in updateSlots()
+    // (only this task moves a slot out of SLOT_FREE, so no CAS is needed)
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        ClientSlot& slot = slots[i];
+        if (slot.state.load(std::memory_order_acquire) != SLOT_FREE) {
+            continue;
+        }
+
+        slot.client = client;
+        client->onDisconnect([](void* arg, AsyncClient*) {
+            static_cast<ClientSlot*>(arg)->state.store(SLOT_CLOSED, std::memory_order_release);
+        }, &slot);
+        // Input from clients is ignored (output-only stream)
+        client->onData([](void*, AsyncClient*, void*, size_t) {}, nullptr);
+
+        slot.state.store(SLOT_PENDING, std::memory_order_release);
+        return;
+    }
+
+    // All slots busy - refuse; the client frees itself once closed
+    refusedClients.fetch_add(1, std::memory_order_relaxed);
+    client->onDisconnect([](void*, AsyncClient* c) {
+        delete c;
+    }, nullptr);
+    client->close(true);
+}
+
+void NMEA0183TcpGateway::updateSlots() {
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        ClientSlot& slot = slots[i];
+        uint8_t state = slot.state.load(std::memory_order_acquire);
+
+        if (state == SLOT_PENDING) {
+            // New clients start at the live end of the stream
+            slot.cursor = stream.head();
+            slot.lostBytes = 0;
+            slot.stalled = false;
+            uint8_t expected = SLOT_PENDING;
+            if (slot.state.compare_exchange_strong(expected, SLOT_CONNECTED, std::memory_order_acq_rel)) {
+                logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA0183, LogEvent::TCP_CLIENT_CONNECTED,
+                    "{\"slot\":%u,\"ip\":\"%s\",\"clients\":%u}", (unsigned)i,
+                    slot.client->remoteIP().toString().c_str(), (unsigned)getClientCount());
+                continue;
+            }
+            state = slot.state.load(std::memory_order_acquire);
+        }
+
+        if (state == SLOT_CLOSED) {
+            logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA0183, LogEvent::TCP_CLIENT_DISCONNECTED,
+                "{\"slot\":%u,\"lost_bytes\":%lu}", (unsigned)i, (unsigned long)slot.lostBytes);
+            delete slot.client;
+            slot.client = nullptr;
+            slot.state.store(SLOT_FREE, std::memory_order_release);
+        }
+    }
+}
+
+void NMEA0183TcpGateway::encodeDue(const BoatDataStructure& data, uint32_t nowMs) {
+    for (uint8_t i = 0; i < SENTENCE_TYPES; i++) {
+        SentenceType& type = sentences[i];
+        if (static_cast<int32_t>(nowMs - type.nextDueMs) < 0) {
+            continue;
+        }
+        type.nextDueMs = nowMs + type.intervalMs;
+
+        size_t len = type.encode(line, sizeof(line), data, nowMs);
+        if (len == 0) {
+            type.unavailable++;
+            continue;
+        }
+        if (stream.append(line, len)) {
+            type.sent++;
+        }
+    }
+}
+
+void NMEA0183TcpGateway::sendPending(uint32_t nowMs) {
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        ClientSlot& slot = slots[i];
+        if (slot.state.load(std::memory_order_acquire) != SLOT_CONNECTED) {
+            continue;
+        }
+
+        AsyncClient* client = slot.client;
+        bool queued = false;
+        bool blocked = false;
+        bool overrun = false;
+
+        // At most two spans: up to the ring end, then from the ring start
+        for (uint8_t span = 0; span < 2; span++) {
+            const char* data;
+            uint32_t lost;
+            size_t pending = stream.peek(slot.cursor, data, lost);
+            if (lost > 0) {
+                // Overwritten mid-stream - the client would receive a torn sentence
+                slot.lostBytes += lost;
+                lostBytesTotal += lost;
+                overrun = true;
+                break;
+            }
+            if (pending == 0) {
+                break;
+            }
+
+            size_t room = client->space();
+            size_t take = pending < room ? pending : room;
+            if (take == 0) {
+                blocked = true;
+                break;
+            }
+
+            // lwIP copies into its send buffer; nothing is staged per client here
+            size_t added = client->add(data, take);
+            NMEA0183StreamBuffer::consume(slot.cursor, added);
+            queued = queued || added > 0;
+            if (added < pending) {
+                blocked = true;
+                break;
+            }
+        }
+
+        if (queued) {
+            client->send();
+        }
+
+        // Send buffer full with data pending: tolerate short stalls, drop persistent ones
+        if (overrun) {
+            dropClient(i, "overrun");
+        } else if (!blocked || queued) {
+            slot.stalled = false;
+        } else if (!slot.stalled) {
+            slot.stalled = true;
+            slot.stalledSinceMs = nowMs;
+        } else if (nowMs - slot.stalledSinceMs >= N0183_TCP_STALL_TIMEOUT_MS) {
+            dropClient(i, "stalled");
+        }
+    }
+}
+
+void NMEA0183TcpGateway::dropClient(uint8_t index, const char* reason) {
+    ClientSlot& slot = slots[index];
+    droppedClients++;
+    logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA0183, LogEvent::TCP_CLIENT_DROPPED,
+        "{\"slot\":%u,\"reason\":\"%s\",\"lost_bytes\":%lu}",
+        (unsigned)index, reason, (unsigned long)slot.lostBytes);
+
+    // updateSlots() deletes the client on the next pass
+    slot.state.store(SLOT_CLOSED, std::memory_order_release);
+    slot.client->close(true);
+}
+
+void NMEA0183TcpGateway::service(const BoatDataStructure& data, uint32_t nowMs) {
+    if (server == nullptr) {
+        return;
+    }
+
+    updateSlots();
+    if (getClientCount() == 0) {
+        return;  // Nothing to convert for
+    }
+
+    encodeDue(data, nowMs);
+    sendPending(nowMs);
+}
+
+uint8_t NMEA0183TcpGateway::getClientCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < MAX_CLIENTS; i++) {
+        if (slots[i].state.load(std::memory_order_acquire) == SLOT_CONNECTED) {
+            count++;
+        }
+    }
+    return count;
+}
+
+void NMEA0183TcpGateway::logStats() const {
+    if (logger == nullptr) {
+        return;
+    }
+
+    // Compact per-type counters: {"HDG":[sent,unavailable],...}
+    char typesJson[256];
+    size_t pos = 0;
+    typesJson[pos++] = '{';
+    for (uint8_t i = 0; i < SENTENCE_TYPES; i++) {
+        int written = snprintf(typesJson + pos, sizeof(typesJson) - pos, "%s\"%s\":[%lu,%lu]",
+                               i > 0 ? "," : "", sentences[i].name,
+                               (unsigned long)sentences[i].sent,
+                               (unsigned long)sentences[i].unavailable);
+        if (written < 0 || pos + written >= sizeof(typesJson) - 1) {
+            break;  // Truncate the list rather than emit invalid JSON
+        }
+        pos += written;
+    }
+    typesJson[pos++] = '}';
+    typesJson[pos] = '\0';
+
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::NMEA0183, LogEvent::N0183_TCP_STATS,
+        "{\"clients\":%u,\"refused\":%lu,\"dropped\":%lu,\"bytes\":%lu,\"lost_bytes\":%lu,"
+        "\"sentences\":%s}",
+        (unsigned)getClientCount(), (unsigned long)refusedClients.load(std::memory_order_relaxed),
+        (unsigned long)droppedClients, (unsigned long)stream.getBytesWritten(),
+        (unsigned long)lostBytesTotal, typesJson);
+}
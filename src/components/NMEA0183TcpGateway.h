@@ -0,0 +1,138 @@
+/**
+ * @file NMEA0183TcpGateway.h
+ * @brief NMEA 0183 sentence stream over TCP (port 10110) for chartplotter apps
+ *
+ * Converts the decoded BoatData (NMEA2000 and other sources) and DerivedData
+ * into HDG, HDM, RSA, MWV, MWD, DPT, VHW and RMC sentences and streams them
+ * to every connected TCP client.
+ *
+ * Pipeline (all on the main loop, never inside a PGN handler):
+ * 1. Each sentence type has its own minimum interval; a due type whose source
+ *    data is available and fresh is encoded once into a preallocated line
+ *    buffer. At most one sentence per type per pass, so the work per pass is
+ *    bounded and the CAN parse is never starved.
+ * 2. The line is appended once to a shared ring (NMEA0183StreamBuffer).
+ * 3. Every client sends straight from the ring at its own cursor as its TCP
+ *    window allows. A client whose send buffer stays full for
+ *    N0183_TCP_STALL_TIMEOUT_MS, or that falls a full ring behind, is
+ *    disconnected - it never blocks the loop or receives torn sentences.
+ *
+ * Client accept/disconnect arrive on the AsyncTCP task; they only flip the
+ * slot state, and the main loop finishes the transition, so ring and cursors
+ * keep a single owner.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed client slots, ring and line buffer
+ * - Principle V (Network Debugging): connect/disconnect and N0183_TCP_STATS log events
+ * - Principle VII (Fail-Safe): excess clients are refused, stalled clients are dropped
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef NMEA0183_TCP_GATEWAY_H
+#define NMEA0183_TCP_GATEWAY_H
+
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <atomic>
+#include "../types/BoatDataTypes.h"
+#include "../utils/NMEA0183Encoder.h"
+#include "../utils/NMEA0183StreamBuffer.h"
+#include "../utils/WebSocketLogger.h"
+#include "../config.h"
+
+/**
+ * @class NMEA0183TcpGateway
+ * @brief Rate-limited BoatData → NMEA 0183 converter with a shared TCP fan-out
+ *
+ * Usage pattern:
+ * @code
+ * nmea0183TcpGateway.begin(&logger);                  // once WiFi is up
+ * app.onRepeat(N0183_TCP_SERVICE_INTERVAL_MS, []() {
+ *     nmea0183TcpGateway.service(*boatData->getDataStructure(), millis());
+ * });
+ * @endcode
+ */
+class NMEA0183TcpGateway {
+public:
+    static constexpr uint8_t MAX_CLIENTS = N0183_TCP_MAX_CLIENTS;
+
+    NMEA0183TcpGateway();
+
+    /**
+     * @brief Start listening on N0183_TCP_PORT
+     * @param logger WebSocket logger for client and stats events
+     * @return false if logger is nullptr or already started
+     */
+    bool begin(WebSocketLogger* logger);
+
+    /**
+     * @brief Encode due sentences and send pending ring bytes (main loop)
+     * @param data BoatData snapshot
+     * @param nowMs Current millis()
+     */
+    void service(const BoatDataStructure& data, uint32_t nowMs);
+
+    /**
+     * @brief Log N0183_TCP_STATS (clients, bytes, per-sentence counters)
+     */
+    void logStats() const;
+
+    uint8_t getClientCount() const;
+    bool isStarted() const { return server != nullptr; }
+    uint32_t getBytesWritten() const { return stream.getBytesWritten(); }
+
+    /**
+     * @brief Encodes one sentence type from a BoatData snapshot
+     * @return Sentence length, 0 if the source data is unavailable or stale
+     */
+    typedef size_t (*SentenceEncoder)(char* buf, size_t size, const BoatDataStructure& data,
+                                      uint32_t nowMs);
+
+private:
+    enum SlotState : uint8_t {
+        SLOT_FREE = 0,
+        SLOT_PENDING,     ///< Accepted on the AsyncTCP task, main loop has not adopted it yet
+        SLOT_CONNECTED,
+        SLOT_CLOSED       ///< Disconnected, main loop deletes the client
+    };
+
+    struct ClientSlot {
+        std::atomic<uint8_t> state;
+        AsyncClient* client;
+        uint32_t cursor;
+        uint32_t lostBytes;   ///< Bytes overwritten before this client sent them
+        uint32_t stalledSinceMs;  ///< When the send buffer filled up (valid while stalled)
+        bool stalled;
+    };
+
+    struct SentenceType {
+        const char* name;
+        SentenceEncoder encode;
+        uint32_t intervalMs;
+        uint32_t nextDueMs;
+        uint32_t sent;
+        uint32_t unavailable;
+    };
+
+    static constexpr uint8_t SENTENCE_TYPES = 9;
+
+    AsyncServer* server;
+    WebSocketLogger* logger;
+    NMEA0183StreamBuffer stream;
+    ClientSlot slots[MAX_CLIENTS];
+    SentenceType sentences[SENTENCE_TYPES];
+    char line[NMEA0183_MAX_SENTENCE_SIZE];
+    std::atomic<uint32_t> refusedClients;
+    uint32_t lostBytesTotal;
+    uint32_t droppedClients;  ///< Clients disconnected for stalling or overrun
+
+    void onClient(AsyncClient* client);
+    void updateSlots();
+    void encodeDue(const BoatDataStructure& data, uint32_t nowMs);
+    void sendPending(uint32_t nowMs);
+    void dropClient(uint8_t index, const char* reason);
+};
+
+#endif // NMEA0183_TCP_GATEWAY_H
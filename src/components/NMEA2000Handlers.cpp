@@ -12,14 +12,34 @@
  */
 
 #include "NMEA2000Handlers.h"
+#include "../utils/AutopilotForward.h"
+#include "../utils/BootTimeline.h"
+#include "../utils/StaticInstance.h"
+#include "../utils/TelemetryRegistry.h"
 #include "../utils/DataValidation.h"
+#include "../utils/HotPath.h"
+#include "../utils/JsonWriter.h"
+#include "../utils/TraceRecorder.h"
+
+// Last accepted PGN 129025 (receive context only). While rapid position is
+// current, PGN 129029 contributes only the fields 129025 does not carry.
+static unsigned long lastRapidPositionMs = 0;
+static bool rapidPositionSeen = false;
+
+static bool isRapidPositionCurrent() {
+#if N2K_POSITION_POLICY == 1
+    return rapidPositionSeen && (millis() - lastRapidPositionMs) < N2K_RAPID_POSITION_TIMEOUT_MS;
+#else
+    return false;
+#endif
+}
 
 // ============================================================================
 // PGN 127251 - Rate of Turn
 // ============================================================================
 
-void HandleN2kPGN127251(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HOT_PATH_ATTR HandleN2kPGN127251(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     double rateOfTurn;
@@ -27,40 +47,38 @@ void HandleN2kPGN127251(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
     if (ParseN2kPGN127251(N2kMsg, SID, rateOfTurn)) {
         // Check if data is valid (not N2kDoubleNA)
         if (N2kIsNA(rateOfTurn)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127251_NA",
-                F("{\"reason\":\"Rate of turn not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127251_NA,
+                "{\"reason\":\"Rate of turn not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Validate and clamp rate of turn
-        bool valid = DataValidation::isValidRateOfTurn(rateOfTurn);
+        double received = rateOfTurn;
+        bool valid = DataValidation::RateOfTurnRange::check(rateOfTurn) == RangeResult::VALID;
         if (!valid) {
-            logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN127251_OUT_OF_RANGE",
-                String(F("{\"rateOfTurn\":")) + rateOfTurn + F(",\"clamped\":") +
-                DataValidation::clampRateOfTurn(rateOfTurn) + F("}"));
-            rateOfTurn = DataValidation::clampRateOfTurn(rateOfTurn);
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127251_OUT_OF_RANGE,
+                "{\"rateOfTurn\":%.2f,\"clamped\":%.2f}",
+                received, rateOfTurn);
         }
 
-        // Get current compass data
-        CompassData compass = boatData->getCompassData();
-
-        // Update rate of turn
-        compass.rateOfTurn = rateOfTurn;
-        compass.available = true;
-        compass.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setCompassData(compass);
+        // Update rate of turn in place
+        CompassData patch;
+        patch.rateOfTurn = rateOfTurn;
+        patch.available = true;
+        boatData->patchCompass(CompassField::RATE_OF_TURN, patch, GetN2kSourceTracker().currentSource());
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127251_UPDATE",
-            String(F("{\"rateOfTurn\":")) + rateOfTurn + F(",\"rad_per_sec\":true}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127251_UPDATE,
+            "{\"rateOfTurn\":%.2f,\"rad_per_sec\":true}", rateOfTurn);
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN127251_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 127251\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN127251_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 127251\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -68,8 +86,8 @@ void HandleN2kPGN127251(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 127252 - Heave
 // ============================================================================
 
-void HandleN2kPGN127252(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HandleN2kPGN127252(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     double heave, delay;
@@ -78,43 +96,40 @@ void HandleN2kPGN127252(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
     if (ParseN2kPGN127252(N2kMsg, SID, heave, delay, delaySource)) {
         // Check if heave data is valid (not N2kDoubleNA)
         if (N2kIsNA(heave)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127252_NA",
-                F("{\"reason\":\"Heave not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127252_NA,
+                "{\"reason\":\"Heave not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Convert from centimeters to meters (NMEA2000 reports in cm)
         heave = heave / 100.0;
 
         // Validate and clamp heave
-        bool valid = DataValidation::isValidHeave(heave);
+        double received = heave;
+        bool valid = DataValidation::HeaveRange::check(heave) == RangeResult::VALID;
         if (!valid) {
-            logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN127252_OUT_OF_RANGE",
-                String(F("{\"heave\":")) + heave + F(",\"clamped\":") +
-                DataValidation::clampHeave(heave) + F("}"));
-            heave = DataValidation::clampHeave(heave);
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127252_OUT_OF_RANGE,
+                "{\"heave\":%.2f,\"clamped\":%.2f}", received, heave);
         }
 
-        // Get current compass data
-        CompassData compass = boatData->getCompassData();
-
-        // Update heave
-        compass.heave = heave;
-        compass.available = true;
-        compass.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setCompassData(compass);
+        // Update heave in place
+        CompassData patch;
+        patch.heave = heave;
+        patch.available = true;
+        boatData->patchCompass(CompassField::HEAVE, patch, GetN2kSourceTracker().currentSource());
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127252_UPDATE",
-            String(F("{\"heave\":")) + heave + F(",\"meters\":true}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127252_UPDATE,
+            "{\"heave\":%.2f,\"meters\":true}", heave);
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN127252_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 127252\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN127252_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 127252\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -122,28 +137,28 @@ void HandleN2kPGN127252(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 127257 - Attitude (Heel, Pitch, Heave)
 // ============================================================================
 
-void HandleN2kPGN127257(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HOT_PATH_ATTR HandleN2kPGN127257(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     double yaw, pitch, roll;
 
     if (ParseN2kPGN127257(N2kMsg, SID, yaw, pitch, roll)) {
-        // Get current compass data
-        CompassData compass = boatData->getCompassData();
+        CompassData patch;
+        uint8_t fields = 0;
         bool dataValid = true;
 
         // Process pitch angle (bow up/down)
         if (!N2kIsNA(pitch)) {
-            bool validPitch = DataValidation::isValidPitchAngle(pitch);
-            if (!validPitch) {
-                logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN127257_PITCH_OUT_OF_RANGE",
-                    String(F("{\"pitch\":")) + pitch + F(",\"max\":") + (M_PI/6) +
-                    F(",\"clamped\":") + DataValidation::clampPitchAngle(pitch) + F("}"));
-                pitch = DataValidation::clampPitchAngle(pitch);
+            double received = pitch;
+            if (DataValidation::PitchRange::check(pitch) != RangeResult::VALID) {
+                logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127257_PITCH_OUT_OF_RANGE,
+                    "{\"pitch\":%.2f,\"max\":%.2f,\"clamped\":%.2f}",
+                    received, DataValidation::PitchRange::hi(), pitch);
                 dataValid = false;
             }
-            compass.pitchAngle = pitch;
+            patch.pitchAngle = pitch;
+            fields |= CompassField::PITCH_ANGLE;
         }
 
         // Process heel angle (roll = heel in marine context)
@@ -151,33 +166,36 @@ void HandleN2kPGN127257(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
             bool validHeel = DataValidation::isValidHeelAngle(roll);
             if (!validHeel) {
                 // Warning if exceeds ±45° but still within ±90° range
-                logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN127257_HEEL_EXCESSIVE",
-                    String(F("{\"heel\":")) + roll + F(",\"degrees\":") + (roll * 180.0 / M_PI) + F("}"));
+                logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127257_HEEL_EXCESSIVE,
+                    "{\"heel\":%.2f,\"degrees\":%.2f}", roll, roll * 180.0 / M_PI);
             }
-            compass.heelAngle = DataValidation::clampHeelAngle(roll);
+            patch.heelAngle = DataValidation::clampHeelAngle(roll);
+            fields |= CompassField::HEEL_ANGLE;
         }
 
         // Note: PGN 127257 doesn't include heave in standard parsing
         // Heave may come from a different PGN or require extended parsing
         // For now, we'll leave heave unchanged
 
-        // Update availability and timestamp
-        compass.available = dataValid;
-        compass.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setCompassData(compass);
+        // Update heel/pitch in place, availability and timestamp
+        patch.available = dataValid;
+        boatData->patchCompass(fields, patch, GetN2kSourceTracker().currentSource());
 
-        // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127257_UPDATE",
-            String(F("{\"heel\":")) + compass.heelAngle + F(",\"pitch\":") +
-            compass.pitchAngle + F(",\"valid\":") + (dataValid ? F("true") : F("false")) + F("}"));
+        // Log update (DEBUG level) - parsed values, BoatData may be written later
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127257_UPDATE,
+            "{\"heel\":%.2f,\"pitch\":%.2f,\"valid\":%s}",
+            (fields & CompassField::HEEL_ANGLE) ? patch.heelAngle : 0.0,
+            (fields & CompassField::PITCH_ANGLE) ? patch.pitchAngle : 0.0,
+            dataValid ? "true" : "false");
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN127257_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 127257\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN127257_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 127257\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -185,8 +203,8 @@ void HandleN2kPGN127257(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 129029 - GNSS Position Data (Enhanced for Variation)
 // ============================================================================
 
-void HandleN2kPGN129029(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HandleN2kPGN129029(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     uint16_t DaysSince1970;
@@ -210,46 +228,64 @@ void HandleN2kPGN129029(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
                           nReferenceStations, ReferenceStationType,
                           ReferenceStationID, AgeOfCorrection)) {
 
-        // Check if position data is valid
-        if (N2kIsNA(Latitude) || N2kIsNA(Longitude)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN129029_NA",
-                F("{\"reason\":\"Position not available\"}"));
-            return;
+        bool coalesce = isRapidPositionCurrent();
+
+        // Check if position data is valid (not needed while 129025 provides it)
+        if (!coalesce && (N2kIsNA(Latitude) || N2kIsNA(Longitude))) {
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN129029_NA,
+                "{\"reason\":\"Position not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
-        // Get current GPS data
-        GPSData gps = boatData->getGPSData();
+        GPSData patch;
+        uint8_t fields = 0;
 
-        // Update position data
-        gps.latitude = Latitude;
-        gps.longitude = Longitude;
+        // Fix details only this PGN carries
+        if (GNSSmethod != N2kGNSSm_Unavailable) {
+            patch.fixQuality = static_cast<uint8_t>(GNSSmethod);
+            fields |= GPSField::FIX_QUALITY;
+        }
+        if (nSatellites != N2kUInt8NA) {
+            patch.satellites = nSatellites;
+            fields |= GPSField::SATELLITES;
+        }
+        if (!N2kIsNA(HDOP)) {
+            patch.hdop = HDOP;
+            fields |= GPSField::HDOP;
+        }
 
-        // Note: PGN 129029 doesn't include COG/SOG in standard parsing
-        // Those come from PGN 129026 (COG & SOG, Rapid Update)
-        // For now, we'll preserve existing COG/SOG values
+        // Position only when rapid 129025 is not already providing it
+        if (!coalesce) {
+            if (!DataValidation::isValidLatitude(Latitude) || !DataValidation::isValidLongitude(Longitude)) {
+                logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN129029_OUT_OF_RANGE,
+                    "{\"latitude\":%.2f,\"longitude\":%.2f}", Latitude, Longitude);
+                Latitude = DataValidation::clampLatitude(Latitude);
+                Longitude = DataValidation::clampLongitude(Longitude);
+            }
+            patch.latitude = Latitude;
+            patch.longitude = Longitude;
+            fields |= GPSField::LATITUDE | GPSField::LONGITUDE;
+        }
 
-        // Note: PGN 129029 doesn't include magnetic variation in standard parsing
-        // Variation typically comes from PGN 127258 (Magnetic Variation) or
-        // can be calculated from position using WMM model
-        // For now, we'll preserve existing variation value
+        // Note: PGN 129029 doesn't include COG/SOG or magnetic variation in
+        // standard parsing - those come from PGN 129026 and PGN 127258
 
         // Update availability and timestamp
-        gps.available = true;
-        gps.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setGPSData(gps);
+        patch.available = true;
+        boatData->patchGPS(fields, patch, GetN2kSourceTracker().currentSource());
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN129029_UPDATE",
-            String(F("{\"lat\":")) + Latitude + F(",\"lon\":") + Longitude +
-            F(",\"sats\":") + nSatellites + F("}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN129029_UPDATE,
+            "{\"lat\":%.2f,\"lon\":%.2f,\"sats\":%u}", Latitude, Longitude, (unsigned)nSatellites);
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return coalesce ? N2kHandlerResult::COALESCED : N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN129029_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 129029\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN129029_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 129029\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -257,8 +293,8 @@ void HandleN2kPGN129029(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 128267 - Water Depth
 // ============================================================================
 
-void HandleN2kPGN128267(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HandleN2kPGN128267(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     double DepthBelowTransducer;
@@ -268,9 +304,9 @@ void HandleN2kPGN128267(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
     if (ParseN2kPGN128267(N2kMsg, SID, DepthBelowTransducer, Offset, Range)) {
         // Check if depth is valid
         if (N2kIsNA(DepthBelowTransducer)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN128267_NA",
-                F("{\"reason\":\"Depth not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN128267_NA,
+                "{\"reason\":\"Depth not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Calculate depth below waterline (transducer depth + offset)
@@ -280,34 +316,31 @@ void HandleN2kPGN128267(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
         }
 
         // Validate depth
-        bool valid = DataValidation::isValidDepth(depth);
+        double received = depth;
+        bool valid = DataValidation::DepthRange::check(depth) == RangeResult::VALID;
         if (!valid) {
-            logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN128267_INVALID_DEPTH",
-                String(F("{\"depth\":")) + depth + F(",\"reason\":\"negative or excessive\"}"));
-            depth = DataValidation::clampDepth(depth);
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN128267_INVALID_DEPTH,
+                "{\"depth\":%.2f,\"reason\":\"negative or excessive\"}", received);
         }
 
-        // Get current DST data
-        DSTData dst = boatData->getSpeedData(); // Using compatibility method
-
-        // Update depth
-        dst.depth = depth;
-        dst.available = valid;
-        dst.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setSpeedData(dst);
+        // Update depth in place
+        DSTData patch;
+        patch.depth = depth;
+        patch.available = valid;
+        boatData->patchDST(DSTField::DEPTH, patch);
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN128267_UPDATE",
-            String(F("{\"depth\":")) + depth + F(",\"offset\":") + Offset +
-            F(",\"valid\":") + (valid ? F("true") : F("false")) + F("}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN128267_UPDATE,
+            "{\"depth\":%.2f,\"offset\":%.2f,\"valid\":%s}", depth, Offset, valid ? "true" : "false");
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN128267_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 128267\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN128267_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 128267\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -315,8 +348,8 @@ void HandleN2kPGN128267(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 128259 - Speed (Water Referenced)
 // ============================================================================
 
-void HandleN2kPGN128259(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HOT_PATH_ATTR HandleN2kPGN128259(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     double WaterReferenced;
@@ -326,41 +359,38 @@ void HandleN2kPGN128259(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
     if (ParseN2kPGN128259(N2kMsg, SID, WaterReferenced, GroundReferenced, SWRT)) {
         // Check if water-referenced speed is valid
         if (N2kIsNA(WaterReferenced)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN128259_NA",
-                F("{\"reason\":\"Water speed not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN128259_NA,
+                "{\"reason\":\"Water speed not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Validate boat speed (NMEA2000 reports in m/s)
-        bool valid = DataValidation::isValidBoatSpeed(WaterReferenced);
+        double received = WaterReferenced;
+        bool valid = DataValidation::BoatSpeedRange::check(WaterReferenced) == RangeResult::VALID;
         if (!valid) {
-            logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN128259_OUT_OF_RANGE",
-                String(F("{\"speed\":")) + WaterReferenced + F(",\"clamped\":") +
-                DataValidation::clampBoatSpeed(WaterReferenced) + F("}"));
-            WaterReferenced = DataValidation::clampBoatSpeed(WaterReferenced);
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN128259_OUT_OF_RANGE,
+                "{\"speed\":%.2f,\"clamped\":%.2f}",
+                received, WaterReferenced);
         }
 
-        // Get current DST data
-        DSTData dst = boatData->getSpeedData();
-
-        // Update measured boat speed (in m/s, matching NMEA2000 unit)
-        dst.measuredBoatSpeed = WaterReferenced;
-        dst.available = valid;
-        dst.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setSpeedData(dst);
+        // Update measured boat speed in place (in m/s, matching NMEA2000 unit)
+        DSTData patch;
+        patch.measuredBoatSpeed = WaterReferenced;
+        patch.available = valid;
+        boatData->patchDST(DSTField::BOAT_SPEED, patch);
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN128259_UPDATE",
-            String(F("{\"speed_m_s\":")) + WaterReferenced + F(",\"valid\":") +
-            (valid ? F("true") : F("false")) + F("}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN128259_UPDATE,
+            "{\"speed_m_s\":%.2f,\"valid\":%s}", WaterReferenced, valid ? "true" : "false");
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN128259_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 128259\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN128259_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 128259\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -368,8 +398,8 @@ void HandleN2kPGN128259(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 130316 - Temperature Extended Range
 // ============================================================================
 
-void HandleN2kPGN130316(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HandleN2kPGN130316(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     unsigned char TempInstance;
@@ -383,49 +413,46 @@ void HandleN2kPGN130316(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
         // We're only interested in sea temperature
         if (TempSource != N2kts_SeaTemperature) {
             // Ignore other temperature sources (exhaust, engine room, etc.)
-            return;
+            return N2kHandlerResult::IGNORED;
         }
 
         // Check if temperature is valid
         if (N2kIsNA(ActualTemperature)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN130316_NA",
-                F("{\"reason\":\"Sea temperature not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN130316_NA,
+                "{\"reason\":\"Sea temperature not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Convert from Kelvin to Celsius
         double tempCelsius = DataValidation::kelvinToCelsius(ActualTemperature);
 
         // Validate water temperature
-        bool valid = DataValidation::isValidWaterTemperature(tempCelsius);
+        double received = tempCelsius;
+        bool valid = DataValidation::WaterTemperatureRange::check(tempCelsius) == RangeResult::VALID;
         if (!valid) {
-            logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN130316_OUT_OF_RANGE",
-                String(F("{\"temp_celsius\":")) + tempCelsius + F(",\"clamped\":") +
-                DataValidation::clampWaterTemperature(tempCelsius) + F("}"));
-            tempCelsius = DataValidation::clampWaterTemperature(tempCelsius);
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN130316_OUT_OF_RANGE,
+                "{\"temp_celsius\":%.2f,\"clamped\":%.2f}",
+                received, tempCelsius);
         }
 
-        // Get current DST data
-        DSTData dst = boatData->getSpeedData();
-
-        // Update sea temperature
-        dst.seaTemperature = tempCelsius;
-        dst.available = valid;
-        dst.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setSpeedData(dst);
+        // Update sea temperature in place
+        DSTData patch;
+        patch.seaTemperature = tempCelsius;
+        patch.available = valid;
+        boatData->patchDST(DSTField::SEA_TEMPERATURE, patch);
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN130316_UPDATE",
-            String(F("{\"sea_temp_c\":")) + tempCelsius + F(",\"valid\":") +
-            (valid ? F("true") : F("false")) + F("}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN130316_UPDATE,
+            "{\"sea_temp_c\":%.2f,\"valid\":%s}", tempCelsius, valid ? "true" : "false");
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN130316_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 130316\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN130316_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 130316\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -433,8 +460,8 @@ void HandleN2kPGN130316(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 127488 - Engine Parameters, Rapid Update
 // ============================================================================
 
-void HandleN2kPGN127488(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HOT_PATH_ATTR HandleN2kPGN127488(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char EngineInstance;
     double EngineSpeed;
@@ -446,39 +473,38 @@ void HandleN2kPGN127488(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 
         // Check if engine speed is valid
         if (N2kIsNA(EngineSpeed)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127488_NA",
-                F("{\"reason\":\"Engine speed not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127488_NA,
+                "{\"reason\":\"Engine speed not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Validate engine RPM
-        bool valid = DataValidation::isValidEngineRPM(EngineSpeed);
+        double received = EngineSpeed;
+        bool valid = DataValidation::EngineRpmRange::check(EngineSpeed) == RangeResult::VALID;
         if (!valid) {
-            logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN127488_RPM_OUT_OF_RANGE",
-                String(F("{\"rpm\":")) + EngineSpeed + F(",\"clamped\":") +
-                DataValidation::clampEngineRPM(EngineSpeed) + F("}"));
-            EngineSpeed = DataValidation::clampEngineRPM(EngineSpeed);
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127488_RPM_OUT_OF_RANGE,
+                "{\"rpm\":%.2f,\"clamped\":%.2f}", received, EngineSpeed);
         }
 
-        // Get current engine data
-        EngineData engine = boatData->getEngineData();
-        engine.engineRev = EngineSpeed;
-        engine.available = valid;
-        engine.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setEngineData(engine);
+        // Update engine RPM in place
+        EngineData patch;
+        patch.engineRev = EngineSpeed;
+        patch.available = valid;
+        boatData->patchEngine(EngineField::ENGINE_REV, patch, EngineInstance);
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127488_UPDATE",
-            String(F("{\"rpm\":")) + EngineSpeed + F(",\"instance\":") +
-            EngineInstance + F(",\"valid\":") + (valid ? F("true") : F("false")) + F("}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127488_UPDATE,
+            "{\"rpm\":%.2f,\"instance\":%u,\"valid\":%s}",
+            EngineSpeed, (unsigned)EngineInstance, valid ? "true" : "false");
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN127488_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 127488\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN127488_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 127488\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -486,8 +512,8 @@ void HandleN2kPGN127488(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 127489 - Engine Parameters, Dynamic
 // ============================================================================
 
-void HandleN2kPGN127489(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HandleN2kPGN127489(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char EngineInstance;
     double EngineOilPress;
@@ -509,6 +535,7 @@ void HandleN2kPGN127489(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
                           Status1, Status2)) {
 
         EngineData engine;
+        uint8_t fields = 0;
         bool hasValidData = false;
 
         // Process oil temperature if available
@@ -516,63 +543,120 @@ void HandleN2kPGN127489(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
             // Convert from Kelvin to Celsius
             double oilTempCelsius = DataValidation::kelvinToCelsius(EngineOilTemp);
 
-            bool valid = DataValidation::isValidOilTemperature(oilTempCelsius);
+            double received = oilTempCelsius;
+            bool valid = DataValidation::OilTemperatureRange::check(oilTempCelsius) == RangeResult::VALID;
             if (!valid) {
-                logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN127489_OIL_TEMP_OUT_OF_RANGE",
-                    String(F("{\"temp_celsius\":")) + oilTempCelsius + F(",\"clamped\":") +
-                    DataValidation::clampOilTemperature(oilTempCelsius) + F("}"));
-                oilTempCelsius = DataValidation::clampOilTemperature(oilTempCelsius);
+                logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127489_OIL_TEMP_OUT_OF_RANGE,
+                    "{\"temp_celsius\":%.2f,\"clamped\":%.2f}",
+                    received, oilTempCelsius);
             }
 
             engine.oilTemperature = oilTempCelsius;
+            fields |= EngineField::OIL_TEMPERATURE;
             hasValidData = true;
 
             // Warn if oil temperature is excessively high (>120°C)
             if (oilTempCelsius > 120.0) {
-                logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN127489_OIL_TEMP_HIGH",
-                    String(F("{\"temp_celsius\":")) + oilTempCelsius + F(",\"threshold\":120}"));
+                logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127489_OIL_TEMP_HIGH,
+                    "{\"temp_celsius\":%.2f,\"threshold\":120}", oilTempCelsius);
             }
         }
 
         // Process alternator voltage if available
         if (!N2kIsNA(AltenatorVoltage)) {
-            bool valid = DataValidation::isWithinVoltageRange(AltenatorVoltage);
+            double received = AltenatorVoltage;
+            bool valid = DataValidation::VoltageRange::check(AltenatorVoltage) == RangeResult::VALID;
             if (!valid) {
-                logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN127489_VOLTAGE_OUT_OF_RANGE",
-                    String(F("{\"voltage\":")) + AltenatorVoltage + F(",\"clamped\":") +
-                    DataValidation::clampBatteryVoltage(AltenatorVoltage) + F("}"));
-                AltenatorVoltage = DataValidation::clampBatteryVoltage(AltenatorVoltage);
+                logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127489_VOLTAGE_OUT_OF_RANGE,
+                    "{\"voltage\":%.2f,\"clamped\":%.2f}",
+                    received, AltenatorVoltage);
             }
 
             // Warn if voltage is outside normal 12V system range [12-15V]
             if (!DataValidation::isValidBatteryVoltage(AltenatorVoltage)) {
-                logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN127489_VOLTAGE_ABNORMAL",
-                    String(F("{\"voltage\":")) + AltenatorVoltage +
-                    F(",\"expected_range\":\"12-15V\"}"));
+                logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127489_VOLTAGE_ABNORMAL,
+                    "{\"voltage\":%.2f,\"expected_range\":\"12-15V\"}", AltenatorVoltage);
             }
 
             engine.alternatorVoltage = AltenatorVoltage;
+            fields |= EngineField::ALTERNATOR_VOLTAGE;
             hasValidData = true;
         }
 
-        // Update availability and timestamp
+        // Update only the parsed fields, availability and timestamp
         engine.available = hasValidData;
-        engine.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setEngineData(engine);
+        boatData->patchEngine(fields, engine, EngineInstance);
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127489_UPDATE",
-            String(F("{\"oil_temp_c\":")) + engine.oilTemperature +
-            F(",\"alt_voltage\":") + engine.alternatorVoltage +
-            F(",\"instance\":") + EngineInstance + F("}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127489_UPDATE,
+            "{\"oil_temp_c\":%.2f,\"alt_voltage\":%.2f,\"instance\":%u}",
+            engine.oilTemperature, engine.alternatorVoltage, (unsigned)EngineInstance);
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
+    } else {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN127489_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 127489\"}");
+        return N2kHandlerResult::PARSE_FAILED;
+    }
+}
+
+// ============================================================================
+// PGN 127505 - Fluid Level
+// ============================================================================
+
+N2kHandlerResult HandleN2kPGN127505(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
+
+    unsigned char Instance;
+    tN2kFluidType FluidType;
+    double Level;
+    double Capacity;
+
+    if (ParseN2kPGN127505(N2kMsg, Instance, FluidType, Level, Capacity)) {
+
+        if (N2kIsNA(Level)) {
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127505_NA,
+                "{\"reason\":\"Tank level not available\",\"type\":%u,\"instance\":%u}",
+                (unsigned)FluidType, (unsigned)Instance);
+            return N2kHandlerResult::NOT_AVAILABLE;
+        }
+
+        // Level is a percentage; a sender outside 0-100 is clamped and flagged
+        bool valid = Level >= 0.0 && Level <= 100.0;
+        if (!valid) {
+            double received = Level;
+            Level = Level < 0.0 ? 0.0 : 100.0;
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127505_LEVEL_OUT_OF_RANGE,
+                "{\"level\":%.2f,\"clamped\":%.2f}", received, Level);
+        }
+
+        // One slot per (fluid type, instance)
+        TankData tank;
+        tank.fluidType = static_cast<uint8_t>(FluidType);
+        tank.instance = Instance;
+        tank.level = Level;
+        uint8_t fields = TankField::LEVEL;
+        if (!N2kIsNA(Capacity) && Capacity >= 0.0 && Capacity <= 10000.0) {
+            tank.capacity = Capacity;
+            fields |= TankField::CAPACITY;
+        }
+        tank.available = valid;
+        boatData->patchTank(fields, tank);
+
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127505_UPDATE,
+            "{\"type\":%u,\"instance\":%u,\"level\":%.1f,\"capacity_l\":%.1f}",
+            (unsigned)FluidType, (unsigned)Instance, Level, Capacity);
+
+        boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN127489_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 127489\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN127505_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 127505\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -580,17 +664,17 @@ void HandleN2kPGN127489(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 129025 - Position, Rapid Update
 // ============================================================================
 
-void HandleN2kPGN129025(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HOT_PATH_ATTR HandleN2kPGN129025(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     double Latitude, Longitude;
 
     if (ParseN2kPGN129025(N2kMsg, Latitude, Longitude)) {
         // Check if position data is valid
         if (N2kIsNA(Latitude) || N2kIsNA(Longitude)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN129025_NA",
-                F("{\"reason\":\"Position not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN129025_NA,
+                "{\"reason\":\"Position not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Validate latitude and longitude
@@ -598,33 +682,35 @@ void HandleN2kPGN129025(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
         bool validLon = DataValidation::isValidLongitude(Longitude);
 
         if (!validLat || !validLon) {
-            logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN129025_OUT_OF_RANGE",
-                String(F("{\"latitude\":")) + Latitude + F(",\"longitude\":") + Longitude + F("}"));
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN129025_OUT_OF_RANGE,
+                "{\"latitude\":%.2f,\"longitude\":%.2f}", Latitude, Longitude);
             Latitude = DataValidation::clampLatitude(Latitude);
             Longitude = DataValidation::clampLongitude(Longitude);
         }
 
-        // Get current GPS data
-        GPSData gps = boatData->getGPSData();
-
-        // Update position
-        gps.latitude = Latitude;
-        gps.longitude = Longitude;
-        gps.available = true;
-        gps.lastUpdate = millis();
+        // Update position in place
+        GPSData patch;
+        patch.latitude = Latitude;
+        patch.longitude = Longitude;
+        patch.available = true;
+        boatData->patchGPS(GPSField::LATITUDE | GPSField::LONGITUDE, patch,
+                           GetN2kSourceTracker().currentSource());
 
-        // Store updated data
-        boatData->setGPSData(gps);
+        lastRapidPositionMs = millis();
+        rapidPositionSeen = true;
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN129025_UPDATE",
-            String(F("{\"latitude\":")) + Latitude + F(",\"longitude\":") + Longitude + F("}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN129025_UPDATE,
+            "{\"latitude\":%.2f,\"longitude\":%.2f}", Latitude, Longitude);
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN129025_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 129025\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN129025_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 129025\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -632,8 +718,8 @@ void HandleN2kPGN129025(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 129026 - COG & SOG, Rapid Update
 // ============================================================================
 
-void HandleN2kPGN129026(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HOT_PATH_ATTR HandleN2kPGN129026(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     tN2kHeadingReference COGReference;
@@ -642,9 +728,9 @@ void HandleN2kPGN129026(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
     if (ParseN2kPGN129026(N2kMsg, SID, COGReference, COG, SOG)) {
         // Check if COG/SOG data is valid
         if (N2kIsNA(COG) || N2kIsNA(SOG)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN129026_NA",
-                F("{\"reason\":\"COG/SOG not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN129026_NA,
+                "{\"reason\":\"COG/SOG not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Validate COG (wrap to [0, 2π])
@@ -654,35 +740,32 @@ void HandleN2kPGN129026(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
         double SOGKnots = DataValidation::mpsToKnots(SOG);
 
         // Validate and clamp SOG
-        bool validSOG = DataValidation::isValidSOG(SOGKnots);
+        double received = SOGKnots;
+        bool validSOG = DataValidation::SogRange::check(SOGKnots) == RangeResult::VALID;
         if (!validSOG) {
-            logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN129026_SOG_OUT_OF_RANGE",
-                String(F("{\"sog_knots\":")) + SOGKnots + F(",\"clamped\":") +
-                DataValidation::clampSOG(SOGKnots) + F("}"));
-            SOGKnots = DataValidation::clampSOG(SOGKnots);
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN129026_SOG_OUT_OF_RANGE,
+                "{\"sog_knots\":%.2f,\"clamped\":%.2f}", received, SOGKnots);
         }
 
-        // Get current GPS data
-        GPSData gps = boatData->getGPSData();
-
-        // Update COG and SOG
-        gps.cog = COG;
-        gps.sog = SOGKnots;
-        gps.available = true;
-        gps.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setGPSData(gps);
+        // Update COG and SOG in place
+        GPSData patch;
+        patch.cog = COG;
+        patch.sog = SOGKnots;
+        patch.available = true;
+        boatData->patchGPS(GPSField::COG | GPSField::SOG, patch, GetN2kSourceTracker().currentSource());
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN129026_UPDATE",
-            String(F("{\"cog_rad\":")) + COG + F(",\"sog_knots\":") + SOGKnots + F("}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN129026_UPDATE,
+            "{\"cog_rad\":%.2f,\"sog_knots\":%.2f}", COG, SOGKnots);
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN129026_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 129026\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN129026_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 129026\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -690,8 +773,8 @@ void HandleN2kPGN129026(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 127250 - Vessel Heading
 // ============================================================================
 
-void HandleN2kPGN127250(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HOT_PATH_ATTR HandleN2kPGN127250(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     double Heading, Deviation, Variation;
@@ -700,45 +783,45 @@ void HandleN2kPGN127250(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
     if (ParseN2kPGN127250(N2kMsg, SID, Heading, Deviation, Variation, Reference)) {
         // Check if heading is valid
         if (N2kIsNA(Heading)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127250_NA",
-                F("{\"reason\":\"Heading not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127250_NA,
+                "{\"reason\":\"Heading not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Wrap heading to [0, 2π]
         Heading = DataValidation::wrapAngle2Pi(Heading);
 
-        // Get current compass data
-        CompassData compass = boatData->getCompassData();
-
         // Route to appropriate field based on reference type
+        CompassData patch;
+        uint8_t field;
         if (Reference == N2khr_true) {
-            compass.trueHeading = Heading;
+            patch.trueHeading = Heading;
+            field = CompassField::TRUE_HEADING;
         } else if (Reference == N2khr_magnetic) {
-            compass.magneticHeading = Heading;
+            patch.magneticHeading = Heading;
+            field = CompassField::MAGNETIC_HEADING;
         } else {
             // Unknown reference type - ignore
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127250_UNKNOWN_REF",
-                F("{\"reason\":\"Unknown heading reference type\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127250_UNKNOWN_REF,
+                "{\"reason\":\"Unknown heading reference type\"}");
+            return N2kHandlerResult::IGNORED;
         }
 
-        compass.available = true;
-        compass.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setCompassData(compass);
+        patch.available = true;
+        boatData->patchCompass(field, patch, GetN2kSourceTracker().currentSource());
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127250_UPDATE",
-            String(F("{\"heading\":")) + Heading + F(",\"reference\":\"") +
-            (Reference == N2khr_true ? F("true") : F("magnetic")) + F("\"}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127250_UPDATE,
+            "{\"heading\":%.2f,\"reference\":\"%s\"}", Heading, Reference == N2khr_true ? "true" : "magnetic");
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN127250_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 127250\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN127250_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 127250\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -746,8 +829,8 @@ void HandleN2kPGN127250(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 127258 - Magnetic Variation
 // ============================================================================
 
-void HandleN2kPGN127258(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HandleN2kPGN127258(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     tN2kMagneticVariation Source;
@@ -757,40 +840,37 @@ void HandleN2kPGN127258(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
     if (ParseN2kPGN127258(N2kMsg, SID, Source, DaysSince1970, Variation)) {
         // Check if variation is valid
         if (N2kIsNA(Variation)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127258_NA",
-                F("{\"reason\":\"Variation not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127258_NA,
+                "{\"reason\":\"Variation not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Validate variation
-        bool valid = DataValidation::isValidVariation(Variation);
+        double received = Variation;
+        bool valid = DataValidation::VariationRange::check(Variation) == RangeResult::VALID;
         if (!valid) {
-            logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN127258_OUT_OF_RANGE",
-                String(F("{\"variation\":")) + Variation + F(",\"clamped\":") +
-                DataValidation::clampVariation(Variation) + F("}"));
-            Variation = DataValidation::clampVariation(Variation);
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN127258_OUT_OF_RANGE,
+                "{\"variation\":%.2f,\"clamped\":%.2f}", received, Variation);
         }
 
-        // Get current GPS data
-        GPSData gps = boatData->getGPSData();
-
-        // Update variation
-        gps.variation = Variation;
-        gps.available = true;
-        gps.lastUpdate = millis();
-
-        // Store updated data
-        boatData->setGPSData(gps);
+        // Update variation in place
+        GPSData patch;
+        patch.variation = Variation;
+        patch.available = true;
+        boatData->patchGPS(GPSField::VARIATION, patch, GetN2kSourceTracker().currentSource());
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN127258_UPDATE",
-            String(F("{\"variation_rad\":")) + Variation + F("}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN127258_UPDATE,
+            "{\"variation_rad\":%.2f}", Variation);
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN127258_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 127258\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN127258_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 127258\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
@@ -798,8 +878,8 @@ void HandleN2kPGN127258(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
 // PGN 130306 - Wind Data
 // ============================================================================
 
-void HandleN2kPGN130306(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
-    if (boatData == nullptr || logger == nullptr) return;
+N2kHandlerResult HOT_PATH_ATTR HandleN2kPGN130306(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
     unsigned char SID;
     double WindSpeed, WindAngle;
@@ -810,16 +890,16 @@ void HandleN2kPGN130306(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
         if (WindReference != N2kWind_Apparent) {
             // Silently ignore non-apparent wind
              
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN130306_IGNORED",
-                String(F("{\"wind_ref\":")) + WindReference + F("},"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN130306_IGNORED,
+                "{\"wind_ref\":%d}", (int)WindReference);
+            return N2kHandlerResult::IGNORED;
         }
 
         // Check if wind data is valid
         if (N2kIsNA(WindSpeed) || N2kIsNA(WindAngle)) {
-            logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN130306_NA",
-                F("{\"reason\":\"Wind data not available\"}"));
-            return;
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN130306_NA,
+                "{\"reason\":\"Wind data not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
         }
 
         // Wrap wind angle to [-π, π]
@@ -829,163 +909,556 @@ void HandleN2kPGN130306(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
         double WindSpeedKnots = DataValidation::mpsToKnots(WindSpeed);
 
         // Validate and clamp wind speed
-        bool valid = DataValidation::isValidWindSpeed(WindSpeedKnots);
+        double received = WindSpeedKnots;
+        bool valid = DataValidation::WindSpeedRange::check(WindSpeedKnots) == RangeResult::VALID;
         if (!valid) {
-            logger->broadcastLog(LogLevel::WARN, "NMEA2000", "PGN130306_OUT_OF_RANGE",
-                String(F("{\"wind_speed_knots\":")) + WindSpeedKnots + F(",\"clamped\":") +
-                DataValidation::clampWindSpeed(WindSpeedKnots) + F("}"));
-            WindSpeedKnots = DataValidation::clampWindSpeed(WindSpeedKnots);
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN130306_OUT_OF_RANGE,
+                "{\"wind_speed_knots\":%.2f,\"clamped\":%.2f}",
+                received, WindSpeedKnots);
         }
 
-        // Get current wind data
-        WindData wind = boatData->getWindData();
+        // Update wind angle and speed in place
+        WindData patch;
+        patch.apparentWindAngle = WindAngle;
+        patch.apparentWindSpeed = WindSpeedKnots;
+        patch.available = true;
+        boatData->patchWind(WindField::APPARENT_ANGLE | WindField::APPARENT_SPEED, patch);
+
+        // Log update (DEBUG level)
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN130306_UPDATE,
+            "{\"angle_rad\":%.2f,\"speed_knots\":%.2f}", WindAngle, WindSpeedKnots);
+
+        // Increment message counter
+        boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
+    } else {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN130306_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 130306\"}");
+        return N2kHandlerResult::PARSE_FAILED;
+    }
+}
+
+// ============================================================================
+// PGN 129284 - Navigation Data
+// ============================================================================
 
-        // Update wind angle and speed
-        wind.apparentWindAngle = WindAngle;
-        wind.apparentWindSpeed = WindSpeedKnots;
-        wind.available = true;
-        wind.lastUpdate = millis();
+N2kHandlerResult HandleN2kPGN129284(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
 
-        // Store updated data
-        boatData->setWindData(wind);
+    unsigned char SID;
+    double DistanceToWaypoint, BearingOriginToDestination, BearingPositionToDestination;
+    double DestinationLatitude, DestinationLongitude, WaypointClosingVelocity;
+    tN2kHeadingReference BearingReference;
+    bool PerpendicularCrossed, ArrivalCircleEntered;
+    tN2kDistanceCalculationType CalculationType;
+    double ETATime;
+    int16_t ETADate;
+    uint32_t OriginWaypointNumber, DestinationWaypointNumber;
+
+    if (ParseN2kPGN129284(N2kMsg, SID, DistanceToWaypoint, BearingReference,
+                          PerpendicularCrossed, ArrivalCircleEntered, CalculationType,
+                          ETATime, ETADate, BearingOriginToDestination, BearingPositionToDestination,
+                          OriginWaypointNumber, DestinationWaypointNumber,
+                          DestinationLatitude, DestinationLongitude, WaypointClosingVelocity)) {
+        // Only the destination position is used (laylines are computed from our own fix)
+        if (N2kIsNA(DestinationLatitude) || N2kIsNA(DestinationLongitude)) {
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN129284_NA,
+                "{\"reason\":\"Destination position not available\"}");
+            return N2kHandlerResult::NOT_AVAILABLE;
+        }
+
+        if (!DataValidation::isValidLatitude(DestinationLatitude) ||
+            !DataValidation::isValidLongitude(DestinationLongitude)) {
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN129284_OUT_OF_RANGE,
+                "{\"latitude\":%.2f,\"longitude\":%.2f}", DestinationLatitude, DestinationLongitude);
+            return N2kHandlerResult::IGNORED;
+        }
+
+        // Held outside BoatData for the navigation stage (NavigationEngine)
+        WaypointData waypoint;
+        waypoint.latitude = DestinationLatitude;
+        waypoint.longitude = DestinationLongitude;
+        waypoint.number = N2kIsNA(DestinationWaypointNumber) ? 0 : DestinationWaypointNumber;
+        waypoint.available = true;
+        waypoint.lastUpdate = millis();
+        GetActiveWaypoint().set(waypoint);
 
         // Log update (DEBUG level)
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN130306_UPDATE",
-            String(F("{\"angle_rad\":")) + WindAngle + F(",\"speed_knots\":") +
-            WindSpeedKnots + F("}"));
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN129284_UPDATE,
+            "{\"waypoint\":%lu,\"latitude\":%.5f,\"longitude\":%.5f}",
+            (unsigned long)waypoint.number, DestinationLatitude, DestinationLongitude);
 
         // Increment message counter
         boatData->incrementNMEA2000Count();
+
+        return N2kHandlerResult::UPDATED;
     } else {
-        logger->broadcastLog(LogLevel::ERROR, "NMEA2000", "PGN130306_PARSE_FAILED",
-            F("{\"reason\":\"Failed to parse PGN 130306\"}"));
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN129284_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 129284\"}");
+        return N2kHandlerResult::PARSE_FAILED;
     }
 }
 
+// ============================================================================
+// PGN 129038 / 129039 - AIS Class A / Class B Position Report
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Fields shared by the two position reports
+ *
+ * Read with the tN2kMsg field getters instead of ParseN2kPGN129038/129039,
+ * whose parameter lists differ between NMEA2000 library versions. Both
+ * PGNs start: message ID/repeat, user ID, longitude, latitude,
+ * accuracy/RAIM/seconds, COG, SOG, 19-bit communication state and
+ * transceiver information, true heading; class A continues with rate of
+ * turn and navigational status.
+ *
+ * @return false if the message is too short
+ */
+bool parseAisPosition(const tN2kMsg &N2kMsg, bool classA, AisPositionReport& report) {
+    if (N2kMsg.DataLen < (classA ? 26 : 23)) {
+        return false;
+    }
+
+    int Index = 1;  // Byte 0: message ID and repeat indicator
+    report.mmsi = N2kMsg.Get4ByteUInt(Index);
+    double Longitude = N2kMsg.Get4ByteDouble(1e-07, Index);
+    double Latitude = N2kMsg.Get4ByteDouble(1e-07, Index);
+    Index++;  // Position accuracy, RAIM, time stamp
+    double COG = N2kMsg.Get2ByteUDouble(1e-04, Index);
+    double SOG = N2kMsg.Get2ByteUDouble(0.01, Index);
+    Index += 3;  // Communication state, transceiver information
+    double Heading = N2kMsg.Get2ByteUDouble(1e-04, Index);
+    Index += 2;  // Rate of turn (class A) or regional use (class B)
+    report.navStatus = classA ? (N2kMsg.GetByte(Index) & 0x0F) : AIS_NAV_STATUS_UNDEFINED;
+
+    report.latitude = N2kIsNA(Latitude) ? NAN : Latitude;
+    report.longitude = N2kIsNA(Longitude) ? NAN : Longitude;
+    report.cog = N2kIsNA(COG) ? NAN : static_cast<float>(COG);
+    report.sog = N2kIsNA(SOG) ? NAN : static_cast<float>(DataValidation::mpsToKnots(SOG));
+    report.heading = N2kIsNA(Heading) ? NAN : static_cast<float>(Heading);
+    report.aisClass = classA ? AIS_CLASS_A : AIS_CLASS_B;
+    report.receivedMs = millis();
+    return true;
+}
+
+N2kHandlerResult handleAisPosition(const tN2kMsg &N2kMsg, bool classA, BoatData* boatData,
+                                   WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
+
+    AisPositionReport report;
+    if (!parseAisPosition(N2kMsg, classA, report)) {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000,
+            classA ? LogEvent::PGN129038_PARSE_FAILED : LogEvent::PGN129039_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN %lu\"}", (unsigned long)N2kMsg.PGN);
+        return N2kHandlerResult::PARSE_FAILED;
+    }
+
+    // 91°/181° (position not available) fail the range check as well
+    if (report.mmsi == 0 || !DataValidation::isValidLatitude(report.latitude) ||
+        !DataValidation::isValidLongitude(report.longitude)) {
+        LOG_DEBUGF(logger, LogComponent::NMEA2000,
+            classA ? LogEvent::PGN129038_NA : LogEvent::PGN129039_NA,
+            "{\"mmsi\":%lu,\"reason\":\"Position not available\"}", (unsigned long)report.mmsi);
+        return N2kHandlerResult::NOT_AVAILABLE;
+    }
+
+    // Held outside BoatData for the AIS target table (main loop)
+    if (!GetAisReportQueue().push(report)) {
+        return N2kHandlerResult::IGNORED;  // Queue full (counted by the queue)
+    }
+
+    LOG_DEBUGF(logger, LogComponent::NMEA2000,
+        classA ? LogEvent::PGN129038_UPDATE : LogEvent::PGN129039_UPDATE,
+        "{\"mmsi\":%lu,\"latitude\":%.5f,\"longitude\":%.5f}",
+        (unsigned long)report.mmsi, report.latitude, report.longitude);
+
+    // Increment message counter
+    boatData->incrementNMEA2000Count();
+
+    return N2kHandlerResult::UPDATED;
+}
+
+}  // namespace
+
+N2kHandlerResult HandleN2kPGN129038(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    return handleAisPosition(N2kMsg, true, boatData, logger);
+}
+
+N2kHandlerResult HandleN2kPGN129039(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    return handleAisPosition(N2kMsg, false, boatData, logger);
+}
+
+// ============================================================================
+// PGN 126992 - System Time
+// ============================================================================
+
+N2kHandlerResult HandleN2kPGN126992(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
+
+    unsigned char SID;
+    uint16_t SystemDate;
+    double SystemTime;
+    tN2kTimeSource TimeSource;
+
+    if (!ParseN2kPGN126992(N2kMsg, SID, SystemDate, SystemTime, TimeSource)) {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN126992_PARSE_FAILED,
+            "{\"reason\":\"Failed to parse PGN 126992\"}");
+        return N2kHandlerResult::PARSE_FAILED;
+    }
+
+    // Date 0xFFFF or time NA: the sender has no clock yet
+    if (SystemDate == N2kUInt16NA || N2kIsNA(SystemTime) || SystemTime < 0.0 || SystemTime >= 86400.0) {
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN126992_NA,
+            "{\"reason\":\"System time not available\"}");
+        return N2kHandlerResult::NOT_AVAILABLE;
+    }
+
+    // Held outside BoatData: the main loop disciplines the clock (GetUtcClock().update())
+    uint64_t utcMs = UtcClock::fromDays(SystemDate, static_cast<uint32_t>(SystemTime * 1000.0 + 0.5));
+    if (!GetUtcClock().offer(UtcSource::N2K_SYSTEM_TIME, utcMs, static_cast<uint32_t>(N2kMsg.MsgTime))) {
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN126992_NA,
+            "{\"days\":%u,\"reason\":\"Clock not set\"}", (unsigned)SystemDate);
+        return N2kHandlerResult::NOT_AVAILABLE;
+    }
+
+    LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN126992_UPDATE,
+        "{\"days\":%u,\"seconds\":%.3f,\"source\":%u}",
+        (unsigned)SystemDate, SystemTime, (unsigned)TimeSource);
+
+    // Increment message counter
+    boatData->incrementNMEA2000Count();
+
+    return N2kHandlerResult::UPDATED;
+}
+
+// ============================================================================
+// Table-decoded PGNs (N2kFieldDecoder layouts)
+// ============================================================================
+
+N2kHandlerResult HandleN2kDecodedPGN(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger) {
+    if (boatData == nullptr || logger == nullptr) return N2kHandlerResult::IGNORED;
+
+    N2kDecodeStatus status;
+    const N2kPgnLayout* layout = N2kFieldDecoder::select(N2kMsg.PGN, N2kMsg.Data, N2kMsg.DataLen, status);
+    if (layout == nullptr) {
+        if (status == N2kDecodeStatus::TOO_SHORT) {
+            logger->broadcastLogf(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::PGN_DECODED_PARSE_FAILED,
+                "{\"pgn\":%lu,\"length\":%d}", (unsigned long)N2kMsg.PGN, N2kMsg.DataLen);
+            return N2kHandlerResult::PARSE_FAILED;
+        }
+        return N2kHandlerResult::IGNORED;  // Another battery instance or temperature source
+    }
+
+    // Fields land in the patch struct of the layout's group, no parse variables
+    union {
+        GPSData gps;
+        DSTData dst;
+        BatteryData battery;
+    } values;
+    N2kDecodeResult result = N2kFieldDecoder::decode(*layout, N2kMsg.Data, &values);
+    if (result.status == N2kDecodeStatus::NOT_AVAILABLE) {
+        LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN_DECODED_NA,
+            "{\"pgn\":%lu,\"reason\":\"No field available\"}", (unsigned long)N2kMsg.PGN);
+        return N2kHandlerResult::NOT_AVAILABLE;
+    }
+    if (result.clamped > 0) {
+        const BoatDataFieldInfo& info = BoatDataSchema::fieldInfo(result.clampedField);
+        logger->broadcastLogf(LogLevel::WARN, LogComponent::NMEA2000, LogEvent::PGN_DECODED_OUT_OF_RANGE,
+            "{\"pgn\":%lu,\"field\":\"%s\",\"value\":%.2f,\"clamped\":%.2f}", (unsigned long)N2kMsg.PGN,
+            info.key, result.clampedValue, BoatDataSchema::clamp(result.clampedField, result.clampedValue));
+    }
+
+    switch (layout->group) {
+        case BOATDATA_SCHEMA_GROUP_GPS:
+            values.gps.available = true;
+            boatData->patchGPS(static_cast<uint8_t>(result.fields), values.gps,
+                               GetN2kSourceTracker().currentSource());
+            break;
+        case BOATDATA_SCHEMA_GROUP_DST:
+            values.dst.available = true;
+            boatData->patchDST(static_cast<uint8_t>(result.fields), values.dst);
+            break;
+        case BOATDATA_SCHEMA_GROUP_BATTERY:
+            values.battery.available = true;
+            boatData->patchBattery(result.fields, values.battery);
+            break;
+        default:
+            return N2kHandlerResult::IGNORED;  // No patch*() for the group
+    }
+
+    LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN_DECODED_UPDATE,
+        "{\"pgn\":%lu,\"fields\":\"0x%03X\"}", (unsigned long)N2kMsg.PGN, (unsigned)result.fields);
+
+    // Increment message counter
+    boatData->incrementNMEA2000Count();
+
+    return N2kHandlerResult::UPDATED;
+}
+
 // ============================================================================
 // Handler Registration
 // ============================================================================
 
-// Message handler class for NMEA2000 library
-class N2kBoatDataHandler : public tNMEA2000::tMsgHandler {
+// Fix method, satellites and HDOP of a PGN 129029 for the source tracker
+// (about 1 Hz per GPS, so the second parse of the accepted sender is cheap).
+static void noteGnssQuality(const tN2kMsg& N2kMsg) {
+    unsigned char SID;
+    uint16_t DaysSince1970;
+    double SecondsSinceMidnight, Latitude, Longitude, Altitude;
+    tN2kGNSStype GNSStype;
+    tN2kGNSSmethod GNSSmethod;
+    unsigned char nSatellites;
+    double HDOP, PDOP, GeoidalSeparation;
+    unsigned char nReferenceStations;
+    tN2kGNSStype ReferenceStationType;
+    uint16_t ReferenceStationID;
+    double AgeOfCorrection;
+    if (!ParseN2kPGN129029(N2kMsg, SID, DaysSince1970, SecondsSinceMidnight, Latitude, Longitude, Altitude,
+                           GNSStype, GNSSmethod, nSatellites, HDOP, PDOP, GeoidalSeparation,
+                           nReferenceStations, ReferenceStationType, ReferenceStationID, AgeOfCorrection) ||
+        GNSSmethod == N2kGNSSm_Unavailable) {
+        return;
+    }
+    GetN2kSourceTracker().noteQuality(N2kMsg.Source, static_cast<uint8_t>(GNSSmethod),
+                                      nSatellites != N2kUInt8NA ? nSatellites : 0,
+                                      N2kIsNA(HDOP) ? 0.0 : HDOP);
+}
+
+// Library message handler bound to one table entry. The library only calls
+// it for messages whose PGN matches, so unregistered and disabled PGNs never
+// reach the handler functions. Every handled frame is counted and timed in
+// the per-(PGN, source) statistics table.
+class N2kPGNDispatcher : public tNMEA2000::tMsgHandler {
 private:
+    const N2kPGNEntry* entry;
     BoatData* boatData;
     WebSocketLogger* logger;
 
 public:
-    N2kBoatDataHandler(BoatData* bd, WebSocketLogger* log)
-        : boatData(bd), logger(log) {}
+    N2kPGNDispatcher(const N2kPGNEntry* e, tNMEA2000* nmea2000, BoatData* bd, WebSocketLogger* log)
+        : tNMEA2000::tMsgHandler(e->pgn, nmea2000), entry(e), boatData(bd), logger(log) {}
+
+    void HOT_PATH_ATTR HandleMsg(const tN2kMsg &N2kMsg) override {
+        if (!entry->enabled) return;  // Disabled after registration (counted by the catch-all)
+
+        // Redundant GPS/compass senders are dropped before any parsing
+        if (entry->sourceGroup != N2kSourceGroup::NONE) {
+            uint32_t now = millis();
+            bool accepted = GetN2kSourceTracker().accept(entry->sourceGroup, N2kMsg.Source, now);
+            if (N2kMsg.PGN == 129029UL) {
+                noteGnssQuality(N2kMsg);  // Every GPS sender is ranked on its fix, active or not
+            }
+            if (!accepted) {
+                GetN2kPGNStats().recordHandled(N2kMsg.PGN, N2kMsg.Source,
+                                               N2kHandlerResult::INACTIVE_SOURCE, 0, now);
+                return;
+            }
+        }
+
+#if AP_FORWARD_ENABLED
+        // Autopilot sentences leave before the regular handling (active compass only)
+        AutopilotForward& autopilot = GetAutopilotForward();
+        if (autopilot.handles(N2kMsg.PGN)) {
+            autopilot.forward(N2kMsg.PGN, N2kMsg.Data, N2kMsg.DataLen);
+        }
+#endif
+
+        uint32_t start = micros();
+        TRACE_BEGIN(TraceId::N2K_PARSE, N2kMsg.PGN);
+        N2kHandlerResult result = entry->handler(N2kMsg, boatData, logger);
+        TRACE_END(TraceId::N2K_PARSE);
+        uint32_t elapsed = micros() - start;
+        TELEMETRY_INCREMENT(TelemetryCounter::N2K_DISPATCHED);
+        TELEMETRY_RECORD(TelemetryHistogram::N2K_HANDLER_US, elapsed);
+
+        uint32_t now = millis();
+        GetN2kPGNStats().recordHandled(N2kMsg.PGN, N2kMsg.Source, result, elapsed, now);
+        GetBootTimeline().milestone(BootMilestone::FIRST_N2K_FRAME, now);  // First one only (GET /status)
+    }
+};
+
+// Catch-all handler that counts PGNs without an enabled table entry, so the
+// statistics show everything on the bus, not only what we decode.
+class N2kUnhandledPGNCounter : public tNMEA2000::tMsgHandler {
+private:
+    WebSocketLogger* logger;
+
+public:
+    N2kUnhandledPGNCounter(tNMEA2000* nmea2000, WebSocketLogger* log)
+        : tNMEA2000::tMsgHandler(0, nmea2000), logger(log) {}
 
     void HandleMsg(const tN2kMsg &N2kMsg) override {
-        // Log every PGN received for debugging
-        logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN_RECEIVED",
-            String(F("{\"pgn\":")) + String(N2kMsg.PGN) + F("}"));
-
-        switch (N2kMsg.PGN) {
-            // GPS handlers (4 PGNs)
-            case 129025L:
-                HandleN2kPGN129025(N2kMsg, boatData, logger);
-                break;
-            case 129026L:
-                HandleN2kPGN129026(N2kMsg, boatData, logger);
-                break;
-            case 129029L:
-                HandleN2kPGN129029(N2kMsg, boatData, logger);
-                break;
-            case 127258L:
-                HandleN2kPGN127258(N2kMsg, boatData, logger);
-                break;
-
-            // Compass handlers (4 PGNs)
-            case 127250L:
-                HandleN2kPGN127250(N2kMsg, boatData, logger);
-                break;
-            case 127251L:
-                HandleN2kPGN127251(N2kMsg, boatData, logger);
-                break;
-            case 127252L:
-                HandleN2kPGN127252(N2kMsg, boatData, logger);
-                break;
-            case 127257L:
-                HandleN2kPGN127257(N2kMsg, boatData, logger);
-                break;
-
-            // DST handlers (3 PGNs)
-            case 128267L:
-                HandleN2kPGN128267(N2kMsg, boatData, logger);
-                break;
-            case 128259L:
-                HandleN2kPGN128259(N2kMsg, boatData, logger);
-                break;
-            case 130316L:
-                HandleN2kPGN130316(N2kMsg, boatData, logger);
-                break;
-
-            // Engine handlers (2 PGNs)
-            case 127488L:
-                HandleN2kPGN127488(N2kMsg, boatData, logger);
-                break;
-            case 127489L:
-                HandleN2kPGN127489(N2kMsg, boatData, logger);
-                break;
-
-            // Wind handlers (1 PGN)
-            case 130306L:
-                HandleN2kPGN130306(N2kMsg, boatData, logger);
-                break;
-
-            default:
-                // Log ignored PGNs for debugging
-                logger->broadcastLog(LogLevel::DEBUG, "NMEA2000", "PGN_IGNORED",
-                    String(F("{\"pgn\":")) + String(N2kMsg.PGN) + F("}"));
-                break;
+        const N2kPGNEntry* entry = GetN2kPGNTable().find(N2kMsg.PGN);
+        if (entry == nullptr || !entry->enabled) {
+            GetN2kPGNStats().recordUnhandled(N2kMsg.PGN, N2kMsg.Source, millis());
+            LOG_DEBUGF(logger, LogComponent::NMEA2000, LogEvent::PGN_IGNORED,
+                "{\"pgn\":%lu,\"src\":%u}", (unsigned long)N2kMsg.PGN, (unsigned)N2kMsg.Source);
         }
     }
 };
 
-// Global handler instance (will be initialized in RegisterN2kHandlers)
-static N2kBoatDataHandler* globalHandler = nullptr;
+// ISO Address Claim observer: ties source addresses to device NAMEs so a
+// sensor keeps its prioritizer source when it re-claims another address.
+// The library answers claims itself; this only listens.
+class N2kAddressClaimObserver : public tNMEA2000::tMsgHandler {
+public:
+    explicit N2kAddressClaimObserver(tNMEA2000* nmea2000)
+        : tNMEA2000::tMsgHandler(60928L, nmea2000) {}
+
+    void HandleMsg(const tN2kMsg &N2kMsg) override {
+        if (N2kMsg.DataLen < 8) return;
 
-void RegisterN2kHandlers(tNMEA2000* nmea2000, BoatData* boatData, WebSocketLogger* logger) {
-    if (nmea2000 == nullptr || boatData == nullptr || logger == nullptr) {
-        return;
+        int index = 0;
+        uint64_t name = N2kMsg.GetUInt64(index);
+        GetN2kSourceTracker().noteAddressClaim(N2kMsg.Source, name);
     }
+};
+
+N2kSourceTracker& GetN2kSourceTracker() {
+    static N2kSourceTracker tracker;
+    return tracker;
+}
+
+N2kFastPacketMonitor& GetN2kFastPacketMonitor() {
+    static N2kFastPacketMonitor monitor;
+    return monitor;
+}
+
+N2kPGNStats& GetN2kPGNStats() {
+    static N2kPGNStats stats;
+    return stats;
+}
+
+ActiveWaypoint& GetActiveWaypoint() {
+    static ActiveWaypoint waypoint;
+    return waypoint;
+}
+
+AisReportQueue& GetAisReportQueue() {
+    static AisReportQueue queue;
+    return queue;
+}
+
+N2kPGNTable& GetN2kPGNTable() {
+    static N2kPGNTable table;
+    static bool populated = false;
+
+    if (!populated) {
+        populated = true;
 
-    // Extend receive message list to include all handled PGNs
-    const unsigned long ReceiveMessages[] PROGMEM = {
         // GPS (4 PGNs)
-        129025L,  // Position, Rapid Update
-        129026L,  // COG & SOG, Rapid Update
-        129029L,  // GNSS Position Data
-        127258L,  // Magnetic Variation
+        table.add(129025L, HandleN2kPGN129025, "Position, Rapid Update");
+        table.add(129026L, HandleN2kPGN129026, "COG & SOG, Rapid Update");
+        table.add(129029L, HandleN2kPGN129029, "GNSS Position Data");
+        table.add(127258L, HandleN2kPGN127258, "Magnetic Variation");
 
         // Compass (4 PGNs)
-        127250L,  // Vessel Heading
-        127251L,  // Rate of Turn
-        127252L,  // Heave
-        127257L,  // Attitude
+        table.add(127250L, HandleN2kPGN127250, "Vessel Heading");
+        table.add(127251L, HandleN2kPGN127251, "Rate of Turn");
+        table.add(127252L, HandleN2kPGN127252, "Heave");
+        table.add(127257L, HandleN2kPGN127257, "Attitude");
 
         // DST (3 PGNs)
-        128267L,  // Water Depth
-        128259L,  // Speed (Water Referenced)
-        130316L,  // Temperature Extended Range
+        table.add(128267L, HandleN2kPGN128267, "Water Depth");
+        table.add(128259L, HandleN2kPGN128259, "Speed (Water Referenced)");
+        table.add(130316L, HandleN2kPGN130316, "Temperature Extended Range");
 
-        // Engine (2 PGNs)
-        127488L,  // Engine Parameters, Rapid Update
-        127489L,  // Engine Parameters, Dynamic
+        // Engine (3 PGNs)
+        table.add(127488L, HandleN2kPGN127488, "Engine Parameters, Rapid Update");
+        table.add(127489L, HandleN2kPGN127489, "Engine Parameters, Dynamic");
+        table.add(127505L, HandleN2kPGN127505, "Fluid Level");
 
         // Wind (1 PGN)
-        130306L,  // Wind Data
+        table.add(130306L, HandleN2kPGN130306, "Wind Data");
+
+        // Navigation (1 PGN)
+        table.add(129284L, HandleN2kPGN129284, "Navigation Data");
+
+        // System (1 PGN)
+        table.add(126992L, HandleN2kPGN126992, "System Time");
+
+        // Table-decoded (6 PGNs, layouts in N2kFieldDecoder)
+        table.add(127506L, HandleN2kDecodedPGN, "DC Detailed Status");
+        table.add(127508L, HandleN2kDecodedPGN, "Battery Status");
+        table.add(129539L, HandleN2kDecodedPGN, "GNSS DOPs");
+        table.add(130310L, HandleN2kDecodedPGN, "Environmental Parameters (obsolete)");
+        table.add(130311L, HandleN2kDecodedPGN, "Environmental Parameters");
+        table.add(130312L, HandleN2kDecodedPGN, "Temperature");
+
+#if AIS_ENABLED
+        // AIS (2 PGNs)
+        table.add(129038L, HandleN2kPGN129038, "AIS Class A Position Report");
+        table.add(129039L, HandleN2kPGN129039, "AIS Class B Position Report");
+#endif
+
+        // Multi-source arbitration: one active sender per sensor type
+        table.setSourceGroup(129025L, N2kSourceGroup::GPS);
+        table.setSourceGroup(129026L, N2kSourceGroup::GPS);
+        table.setSourceGroup(129029L, N2kSourceGroup::GPS);
+        table.setSourceGroup(127258L, N2kSourceGroup::GPS);
+        table.setSourceGroup(129539L, N2kSourceGroup::GPS);
+        table.setSourceGroup(127250L, N2kSourceGroup::COMPASS);
+        table.setSourceGroup(127251L, N2kSourceGroup::COMPASS);
+        table.setSourceGroup(127252L, N2kSourceGroup::COMPASS);
+        table.setSourceGroup(127257L, N2kSourceGroup::ATTITUDE);
+        table.setSourceGroup(127506L, N2kSourceGroup::BATTERY);
+        table.setSourceGroup(127508L, N2kSourceGroup::BATTERY);
+
+        // Multi-frame fast-packet PGNs (reassembly losses are monitored)
+        table.setFastPacket(129029L, true);
+        table.setFastPacket(127489L, true);
+        table.setFastPacket(129284L, true);
+        table.setFastPacket(127506L, true);
+#if AIS_ENABLED
+        table.setFastPacket(129038L, true);
+        table.setFastPacket(129039L, true);
+#endif
+    }
+
+    return table;
+}
+
+void RegisterN2kHandlers(tNMEA2000* nmea2000, BoatData* boatData, WebSocketLogger* logger) {
+    if (nmea2000 == nullptr || boatData == nullptr || logger == nullptr) {
+        return;
+    }
 
-        0  // Terminator
-    };
+    const N2kPGNTable& table = GetN2kPGNTable();
+
+    // The library keeps the pointer, so the receive list must stay alive
+    static unsigned long receiveMessages[N2kPGNTable::CAPACITY + 1];
+    table.buildReceiveList(receiveMessages, N2kPGNTable::CAPACITY + 1);
+    nmea2000->ExtendReceiveMessages(receiveMessages);
+
+    // One library handler per enabled PGN (attached by the constructor), in static storage
+    static StaticInstance<N2kPGNDispatcher> dispatchers[N2kPGNTable::CAPACITY];
+    static StaticInstance<N2kUnhandledPGNCounter> unhandledCounter;
+    static StaticInstance<N2kAddressClaimObserver> addressClaimObserver;
+    for (uint8_t i = 0; i < table.count(); i++) {
+        const N2kPGNEntry& entry = table.entry(i);
+        if (entry.enabled) {
+            dispatchers[i].emplace(&entry, nmea2000, boatData, logger);
+        }
+    }
 
-    nmea2000->ExtendReceiveMessages(ReceiveMessages);
+    unhandledCounter.emplace(nmea2000, logger);
+    addressClaimObserver.emplace(nmea2000);
 
-    // Create and attach handler
-    globalHandler = new N2kBoatDataHandler(boatData, logger);
-    nmea2000->AttachMsgHandler(globalHandler);
+    StaticJsonWriter<LOG_RECORD_DATA_SIZE> payload;
+    payload.beginObject();
+    payload.add("count", (unsigned)table.enabledCount());
+    payload.beginArray("pgns");
+    for (uint8_t i = 0; i < table.count(); i++) {
+        if (table.entry(i).enabled) {
+            payload.add(table.entry(i).pgn);
+        }
+    }
+    payload.endArray();
+    payload.endObject();
 
-    logger->broadcastLog(LogLevel::INFO, "NMEA2000", "HANDLERS_REGISTERED",
-        F("{\"count\":13,\"pgns\":[129025,129026,129029,127258,127250,127251,127252,127257,128267,128259,130316,127488,127489,130306]}"));
+    logger->broadcastLog(LogLevel::INFO, LogComponent::NMEA2000, LogEvent::HANDLERS_REGISTERED, payload.c_str());
 }
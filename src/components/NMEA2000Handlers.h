@@ -9,11 +9,14 @@
  * - Updates the global BoatData instance
  * - Logs events via WebSocket for debugging
  *
- * PGN Handlers (13 total):
+ * Handlers are registered in a sorted PGN table (N2kPGNTable) that drives both
+ * the library receive list and per-PGN dispatch. See GetN2kPGNTable().
+ *
+ * PGN Handlers (18 total, plus 6 table-decoded):
  * GPS (4 PGNs):
  * - PGN 129025: Position, Rapid Update → GPSData lat/lon
  * - PGN 129026: COG & SOG, Rapid Update → GPSData cog/sog
- * - PGN 129029: GNSS Position Data → GPSData lat/lon
+ * - PGN 129029: GNSS Position Data → GPSData fix/satellites/HDOP (+ lat/lon without 129025)
  * - PGN 127258: Magnetic Variation → GPSData.variation
  *
  * Compass (4 PGNs):
@@ -27,13 +30,32 @@
  * - PGN 128259: Speed (Water Referenced) → DSTData.measuredBoatSpeed
  * - PGN 130316: Temperature Extended Range → DSTData.seaTemperature
  *
- * Engine (2 PGNs):
+ * Engine (3 PGNs, engines and tanks by instance in BoatDataInstances):
  * - PGN 127488: Engine Parameters, Rapid → EngineData.engineRev
  * - PGN 127489: Engine Parameters, Dynamic → EngineData oil temp/voltage
+ * - PGN 127505: Fluid Level → TankData level/capacity
  *
  * Wind (1 PGN):
  * - PGN 130306: Wind Data → WindData apparent wind angle/speed
  *
+ * Navigation (1 PGN):
+ * - PGN 129284: Navigation Data → ActiveWaypoint destination (GetActiveWaypoint())
+ *
+ * System (1 PGN):
+ * - PGN 126992: System Time → GetUtcClock() (UTC ↔ millis() mapping)
+ *
+ * Table-decoded (6 PGNs, HandleN2kDecodedPGN(), layouts in N2kFieldDecoder):
+ * - PGN 127506: DC Detailed Status → BatteryData state of charge A/B
+ * - PGN 127508: Battery Status → BatteryData voltage/current A/B
+ * - PGN 129539: GNSS DOPs → GPSData.hdop
+ * - PGN 130310: Environmental Parameters (obsolete) → DSTData.seaTemperature
+ * - PGN 130311: Environmental Parameters (sea source) → DSTData.seaTemperature
+ * - PGN 130312: Temperature (sea source) → DSTData.seaTemperature
+ *
+ * AIS (2 PGNs, AIS_ENABLED):
+ * - PGN 129038: AIS Class A Position Report → GetAisReportQueue()
+ * - PGN 129039: AIS Class B Position Report → GetAisReportQueue()
+ *
  * @see specs/010-nmea-2000-handling/
  * @version 1.0.0
  * @date 2025-10-12
@@ -48,6 +70,18 @@
 #include "../components/BoatData.h"
 #include "../utils/WebSocketLogger.h"
 #include "../utils/DataValidation.h"
+#include "N2kPGNTable.h"
+#include "N2kPGNStats.h"
+#include "N2kSourceTracker.h"
+#include "N2kFastPacketMonitor.h"
+#include "NavigationEngine.h"
+#include "../types/AisTypes.h"
+#include "../utils/SPSCQueue.h"
+#include "../utils/UtcClock.h"
+#include "../utils/N2kFieldDecoder.h"
+
+/// AIS position reports from the NMEA2000 receive context to the main loop (AisTargetTable)
+typedef SPSCQueue<AisPositionReport, AIS_REPORT_QUEUE_CAPACITY> AisReportQueue;
 
 /**
  * @brief Handle PGN 127251 - Rate of Turn
@@ -58,8 +92,9 @@
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN127251(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN127251(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 127252 - Heave
@@ -80,6 +115,7 @@ void HandleN2kPGN127251(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @param N2kMsg NMEA2000 message (const reference, not modified)
  * @param boatData BoatData instance to update (must not be nullptr)
  * @param logger WebSocket logger for debug output (must not be nullptr)
+ * @return Frame outcome (counted in the per-PGN statistics)
  *
  * @pre boatData != nullptr
  * @pre logger != nullptr
@@ -89,7 +125,7 @@ void HandleN2kPGN127251(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @see DataValidation::clampHeave
  * @see DataValidation::isValidHeave
  */
-void HandleN2kPGN127252(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN127252(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 127257 - Attitude
@@ -105,20 +141,24 @@ void HandleN2kPGN127252(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN127257(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN127257(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 129029 - GNSS Position Data (Enhanced)
  *
- * Updates GPSData with latitude, longitude, altitude, and magnetic variation.
- * This is an enhancement to existing GPS handling to add variation field.
+ * Updates GPSData fix quality, satellite count and HDOP. Latitude/longitude
+ * are only taken (and validated) when PGN 129025 has not been received within
+ * N2K_RAPID_POSITION_TIMEOUT_MS; otherwise the duplicate position is skipped
+ * and the frame counts as COALESCED (N2K_POSITION_POLICY 0 disables this).
  *
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN129029(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN129029(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 128267 - Water Depth
@@ -129,8 +169,9 @@ void HandleN2kPGN129029(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN128267(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN128267(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 128259 - Speed (Water Referenced)
@@ -141,8 +182,9 @@ void HandleN2kPGN128267(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN128259(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN128259(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 130316 - Temperature Extended Range
@@ -153,32 +195,49 @@ void HandleN2kPGN128259(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN130316(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN130316(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 127488 - Engine Parameters, Rapid Update
  *
- * Updates EngineData.engineRev with engine RPM.
+ * Updates EngineData.engineRev of the message's engine instance with engine RPM.
  * Validates RPM is within [0, 6000] range.
  *
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN127488(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN127488(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 127489 - Engine Parameters, Dynamic
  *
- * Updates EngineData with oil temperature and alternator voltage.
+ * Updates EngineData of the message's engine instance with oil temperature
+ * and alternator voltage.
  * Validates temperature ([-10, 150]°C) and voltage ([0, 30]V) ranges.
  *
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
+ */
+N2kHandlerResult HandleN2kPGN127489(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+
+/**
+ * @brief Handle PGN 127505 - Fluid Level
+ *
+ * Updates the TankData slot of the message's fluid type and instance with
+ * level (percent, clamped to [0, 100]) and capacity (litres).
+ *
+ * @param N2kMsg NMEA2000 message
+ * @param boatData BoatData instance to update
+ * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN127489(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN127505(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 129025 - Position, Rapid Update
@@ -189,8 +248,9 @@ void HandleN2kPGN127489(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN129025(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN129025(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 129026 - COG & SOG, Rapid Update
@@ -201,8 +261,9 @@ void HandleN2kPGN129025(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN129026(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN129026(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 127250 - Vessel Heading
@@ -213,8 +274,9 @@ void HandleN2kPGN129026(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN127250(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN127250(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 127258 - Magnetic Variation
@@ -225,8 +287,9 @@ void HandleN2kPGN127250(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
  */
-void HandleN2kPGN127258(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kHandlerResult HandleN2kPGN127258(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
 
 /**
  * @brief Handle PGN 130306 - Wind Data
@@ -238,13 +301,149 @@ void HandleN2kPGN127258(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogg
  * @param N2kMsg NMEA2000 message
  * @param boatData BoatData instance to update
  * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
+ */
+N2kHandlerResult HandleN2kPGN130306(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+
+/**
+ * @brief Handle PGN 129284 - Navigation Data
+ *
+ * Stores the destination waypoint position and number in
+ * GetActiveWaypoint() for the layline calculation. BoatData is not
+ * changed; a destination outside the valid lat/lon range is ignored.
+ *
+ * @param N2kMsg NMEA2000 message
+ * @param boatData BoatData instance (message counter)
+ * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
+ */
+N2kHandlerResult HandleN2kPGN129284(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+
+/**
+ * @brief Handle PGN 126992 - System Time
+ *
+ * Offers the date and time to GetUtcClock() (UtcSource::N2K_SYSTEM_TIME),
+ * stamped with the frame's receive time. BoatData is not changed; a date or
+ * time not available, or before 2020, is NOT_AVAILABLE.
+ *
+ * @param N2kMsg NMEA2000 message
+ * @param boatData BoatData instance (message counter)
+ * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
+ */
+N2kHandlerResult HandleN2kPGN126992(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+
+/**
+ * @brief Handle a PGN described by an N2kFieldDecoder layout
+ *
+ * Decodes the fields of the layout whose selector (battery instance,
+ * temperature source) matches straight from N2kMsg.Data and patches them
+ * into their group (patchGPS/patchDST/patchBattery). Another instance or
+ * source is IGNORED, a payload shorter than the layout is PARSE_FAILED,
+ * a message with every field not available is NOT_AVAILABLE. Values
+ * outside the schema range are clamped and logged.
+ *
+ * @param N2kMsg NMEA2000 message (PGN selects the layout)
+ * @param boatData BoatData instance to update
+ * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
+ */
+N2kHandlerResult HandleN2kDecodedPGN(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+
+/**
+ * @brief Handle PGN 129038 - AIS Class A Position Report
+ *
+ * Queues the report in GetAisReportQueue() for the AIS target table (main
+ * loop). BoatData is not changed; a report without a valid position is
+ * NOT_AVAILABLE, a full queue drops it (counted by the queue).
+ *
+ * @param N2kMsg NMEA2000 message
+ * @param boatData BoatData instance (message counter)
+ * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
+ */
+N2kHandlerResult HandleN2kPGN129038(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+
+/**
+ * @brief Handle PGN 129039 - AIS Class B Position Report
+ *
+ * As HandleN2kPGN129038(); class B reports carry no navigational status.
+ *
+ * @param N2kMsg NMEA2000 message
+ * @param boatData BoatData instance (message counter)
+ * @param logger WebSocket logger for debug output
+ * @return Frame outcome (counted in the per-PGN statistics)
+ */
+N2kHandlerResult HandleN2kPGN129039(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+
+/**
+ * @brief PGN handler table, pre-populated with the built-in handlers
+ *
+ * Add, replace or disable entries before calling RegisterN2kHandlers().
+ *
+ * @return Process-wide handler table
+ */
+N2kPGNTable& GetN2kPGNTable();
+
+/**
+ * @brief Per-(PGN, source address) receive statistics
+ *
+ * Written by the NMEA2000 receive context, read by GET /n2k/stats.
+ *
+ * @return Process-wide statistics table
  */
-void HandleN2kPGN130306(const tN2kMsg &N2kMsg, BoatData* boatData, WebSocketLogger* logger);
+N2kPGNStats& GetN2kPGNStats();
 
 /**
- * @brief Register all PGN handlers with NMEA2000 library
+ * @brief Per-sender GPS/compass arbitration
  *
- * Calls SetN2kPGNHandler() for all implemented handlers.
+ * Call begin() with the SourcePrioritizer before NMEA2000 messages are
+ * parsed. Senders are registered as sources automatically.
+ *
+ * @return Process-wide source tracker
+ */
+N2kSourceTracker& GetN2kSourceTracker();
+
+/**
+ * @brief Destination waypoint from PGN 129284
+ *
+ * Written by the NMEA2000 receive context, read by the navigation stage.
+ *
+ * @return Process-wide active waypoint
+ */
+ActiveWaypoint& GetActiveWaypoint();
+
+/**
+ * @brief AIS position reports from PGN 129038/129039
+ *
+ * Pushed by the NMEA2000 receive context, drained by the main loop into the
+ * AIS target table.
+ *
+ * @return Process-wide report queue
+ */
+AisReportQueue& GetAisReportQueue();
+
+/**
+ * @brief Fast-packet reassembly loss tracker
+ *
+ * Follows the table PGNs marked fast-packet; attach it to the CAN driver
+ * with ESP32N2kCanDriver::setFrameObserver(). Losses are counted in
+ * GetN2kPGNStats().
+ *
+ * @return Process-wide fast-packet monitor
+ */
+N2kFastPacketMonitor& GetN2kFastPacketMonitor();
+
+/**
+ * @brief Register all enabled PGN handlers with NMEA2000 library
+ *
+ * Extends the receive list with the enabled table entries and attaches one
+ * library message handler per enabled PGN, so the library filters messages
+ * by PGN before any handler code runs. GPS and compass PGNs from senders
+ * other than the active source are dropped before parsing (see
+ * GetN2kSourceTracker()). A catch-all handler counts unhandled PGNs in
+ * GetN2kPGNStats() (and logs PGN_IGNORED in debug builds), and an ISO
+ * Address Claim observer maps sender addresses to device NAMEs.
  * Should be called once during setup() after NMEA2000 initialization.
  *
  * @param nmea2000 NMEA2000 instance
@@ -0,0 +1,126 @@
+/**
+ * @file NMEA2000Transmitters.cpp
+ * @brief NMEA2000 message builders for derived data
+ *
+ * @see NMEA2000Transmitters.h
+ * @version 1.0.0
+ */
+
+#include "NMEA2000Transmitters.h"
+#include "../utils/DataValidation.h"
+#include "../utils/UnitConverter.h"
+
+namespace {
+
+bool isDerivedCurrent(const DerivedData& derived) {
+    return derived.available && (millis() - derived.lastUpdate) <= N2K_TX_MAX_DATA_AGE_MS;
+}
+
+/// PGN 126983 alert type of @p severity
+unsigned char alertType(AlarmSeverity severity) {
+    switch (severity) {
+        case AlarmSeverity::ALARM:   return 2;
+        case AlarmSeverity::WARNING: return 5;
+        default:                     return 8;   // Caution
+    }
+}
+
+}  // namespace
+
+bool BuildN2kPGN130306(tN2kMsg& msg, const BoatDataStructure& data, unsigned char sid) {
+    if (!isDerivedCurrent(data.derived)) {
+        return false;
+    }
+
+    SetN2kPGN130306(msg, sid, DataValidation::knotsToMps(data.derived.tws),
+                    UnitConverter::normalizeAngle(data.derived.twa), N2kWind_True_water);
+    return true;
+}
+
+bool BuildN2kPGN128000(tN2kMsg& msg, const BoatDataStructure& data, unsigned char sid) {
+    if (!isDerivedCurrent(data.derived)) {
+        return false;
+    }
+
+    SetN2kPGN128000(msg, sid, data.derived.leeway);
+    return true;
+}
+
+bool BuildN2kPGN130577(tN2kMsg& msg, const BoatDataStructure& data, unsigned char sid) {
+    if (!isDerivedCurrent(data.derived)) {
+        return false;
+    }
+
+    const GPSData& gps = data.gps;
+    const CompassData& compass = data.compass;
+
+    double cog = gps.available ? gps.cog : N2kDoubleNA;
+    double sog = gps.available ? DataValidation::knotsToMps(gps.sog) : N2kDoubleNA;
+    double heading = compass.available ? compass.trueHeading : N2kDoubleNA;
+
+    // Derived direction of current is magnetic; 130577 carries it true-referenced
+    double set = UnitConverter::normalizeAngle(data.derived.doc + gps.variation);
+
+    SetN2kPGN130577(msg, N2kDD025_Estimated, N2khr_true, sid, cog, sog, heading,
+                    DataValidation::knotsToMps(data.derived.stw), set,
+                    DataValidation::knotsToMps(data.derived.soc));
+    return true;
+}
+
+void SetN2kPGN126983(tN2kMsg& msg, const AlarmRuleStatus& alarm, uint16_t alertId, uint64_t sourceName) {
+    const unsigned char ALERT_CATEGORY_NAVIGATIONAL = 0;
+    const unsigned char ALERT_CATEGORY_TECHNICAL = 1;
+    const unsigned char TRIGGER_AUTO = 1;
+    const unsigned char THRESHOLD_NORMAL = 0;
+    const unsigned char THRESHOLD_EXCEEDED = 1;
+    const unsigned char THRESHOLD_LOW_EXCEEDED = 3;
+    const unsigned char STATE_NORMAL = 1;
+    const unsigned char STATE_ACTIVE = 2;
+
+    AlarmType type = alarm.rule.type;
+    bool navigational = type == AlarmType::ANCHOR_DRAG || type == AlarmType::SHALLOW_DEPTH;
+    bool active = alarm.state == AlarmState::ACTIVE;
+    unsigned char threshold = !active ? THRESHOLD_NORMAL
+                            : type == AlarmType::ANCHOR_DRAG ? THRESHOLD_EXCEEDED : THRESHOLD_LOW_EXCEEDED;
+
+    msg.SetPGN(126983L);
+    msg.Priority = 2;
+    msg.AddByte((alertType(AlarmTypeSeverity(type)) & 0x0F) |
+                ((navigational ? ALERT_CATEGORY_NAVIGATIONAL : ALERT_CATEGORY_TECHNICAL) << 4));
+    msg.AddByte(ALARM_N2K_ALERT_SYSTEM);
+    msg.AddByte(static_cast<unsigned char>(type));   // Sub-system: alarm type
+    msg.Add2ByteUInt(alertId);
+    msg.AddUInt64(sourceName);
+    msg.AddByte(alarm.rule.instance);                // Data source instance
+    msg.AddByte(0);                                  // Data source index-source
+    msg.AddByte(alarm.occurrence);
+    msg.AddByte(0xC0);                               // No silence/acknowledge/escalation, reserved bits set
+    msg.AddUInt64(0xFFFFFFFFFFFFFFFFULL);            // Acknowledge source: not available
+    msg.AddByte(TRIGGER_AUTO | (threshold << 4));
+    msg.AddByte(static_cast<unsigned char>(AlarmTypeSeverity(type)));   // Alert priority: 0 = highest
+    msg.AddByte(active ? STATE_ACTIVE : STATE_NORMAL);
+}
+
+void RegisterN2kTransmitters(tNMEA2000* nmea2000, N2kTransmitScheduler& scheduler) {
+    if (nmea2000 == nullptr) {
+        return;
+    }
+
+    scheduler.addJob(130306L, BuildN2kPGN130306, "true_wind",
+                     N2K_TX_PERIOD_130306_MS, N2K_TX_PRIORITY_130306);
+    scheduler.addJob(128000L, BuildN2kPGN128000, "leeway",
+                     N2K_TX_PERIOD_128000_MS, N2K_TX_PRIORITY_128000);
+    scheduler.addJob(130577L, BuildN2kPGN130577, "set_drift",
+                     N2K_TX_PERIOD_130577_MS, N2K_TX_PRIORITY_130577);
+
+    // The library keeps the pointer, so the transmit list must stay alive
+    static unsigned long transmitMessages[N2kTransmitScheduler::MAX_JOBS + 2];
+    uint8_t count = scheduler.buildTransmitList(transmitMessages, N2kTransmitScheduler::MAX_JOBS + 1);
+#if ALARM_ENABLED
+    transmitMessages[count++] = 126983L;   // Alerts, sent by the main loop
+    transmitMessages[count] = 0;
+#else
+    (void)count;
+#endif
+    nmea2000->ExtendTransmitMessages(transmitMessages);
+}
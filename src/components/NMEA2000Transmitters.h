@@ -0,0 +1,84 @@
+/**
+ * @file NMEA2000Transmitters.h
+ * @brief NMEA2000 message builders for derived (calculated) data
+ *
+ * Builders for the periodic transmit PGNs run by N2kTransmitScheduler. Each
+ * reads the CalculationEngine results in the BoatData snapshot and converts
+ * them to N2k units (m/s, radians in [0, 2π)). A builder returns false while
+ * the derived data is unavailable or older than N2K_TX_MAX_DATA_AGE_MS, so
+ * nothing stale is ever put on the bus.
+ *
+ * Transmit PGNs (3 total):
+ * - PGN 130306: Wind Data, true (water referenced) ← DerivedData tws/twa
+ * - PGN 128000: Leeway Angle ← DerivedData.leeway
+ * - PGN 130577: Direction Data (set & drift) ← DerivedData soc/doc, GPS, compass, STW
+ *
+ * PGN 126983 (Alert) is not periodic data: SetN2kPGN126983() builds it
+ * from an alarm rule, sent by the main loop on each transition and every
+ * ALARM_N2K_REPEAT_MS while the alarm is active.
+ *
+ * @see N2kTransmitScheduler.h
+ * @version 1.0.0
+ */
+
+#ifndef NMEA2000_TRANSMITTERS_H
+#define NMEA2000_TRANSMITTERS_H
+
+#include <Arduino.h>
+#include <NMEA2000.h>
+#include <N2kMessages.h>
+#include "../types/BoatDataTypes.h"
+#include "N2kTransmitScheduler.h"
+#include "../utils/AlarmEngine.h"
+
+/**
+ * @brief Build PGN 130306 - Wind Data (true wind, water referenced)
+ * @return false if derived data is unavailable or stale
+ */
+bool BuildN2kPGN130306(tN2kMsg& msg, const BoatDataStructure& data, unsigned char sid);
+
+/**
+ * @brief Build PGN 128000 - Leeway Angle
+ * @return false if derived data is unavailable or stale
+ */
+bool BuildN2kPGN128000(tN2kMsg& msg, const BoatDataStructure& data, unsigned char sid);
+
+/**
+ * @brief Build PGN 130577 - Direction Data (set & drift, estimated)
+ *
+ * Set is sent true-referenced (derived direction of current + magnetic
+ * variation). COG/SOG and heading are included when their sources are
+ * available, otherwise sent as not available.
+ *
+ * @return false if derived data is unavailable or stale
+ */
+bool BuildN2kPGN130577(tN2kMsg& msg, const BoatDataStructure& data, unsigned char sid);
+
+/**
+ * @brief Build PGN 126983 - Alert
+ *
+ * Alert type from the rule severity (alarm, warning, caution), category
+ * navigational (anchor, depth) or technical (battery, shore power), alert
+ * system ALARM_N2K_ALERT_SYSTEM. State ACTIVE is "active" with the
+ * threshold exceeded (low threshold for the below-threshold types); CLEAR
+ * and PENDING are "normal". Acknowledge and silence are not supported.
+ *
+ * @param alarm Rule and state
+ * @param alertId Alert ID, unique per rule (rule index + 1)
+ * @param sourceName 64-bit NAME of this device (data source network ID)
+ */
+void SetN2kPGN126983(tN2kMsg& msg, const AlarmRuleStatus& alarm, uint16_t alertId, uint64_t sourceName);
+
+/**
+ * @brief Add the derived-data transmit jobs and announce them to the library
+ *
+ * Must be called before nmea2000->Open() so the PGNs appear in the
+ * transmit list reported in response to ISO requests (126983 too, with
+ * ALARM_ENABLED).
+ *
+ * @param nmea2000 NMEA2000 instance
+ * @param scheduler Scheduler that will run the jobs
+ */
+void RegisterN2kTransmitters(tNMEA2000* nmea2000, N2kTransmitScheduler& scheduler);
+
+#endif // NMEA2000_TRANSMITTERS_H
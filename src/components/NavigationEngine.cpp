@@ -0,0 +1,194 @@
+/**
+ * @file NavigationEngine.cpp
+ * @brief Implementation of the tack/gybe heading and layline stage
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "NavigationEngine.h"
+#include <math.h>
+#include "../utils/AngleUtils.h"
+
+namespace {
+
+const float HALF_PI_F = 1.5707963f;
+const float NM_PER_DEGREE = 60.0f;
+const float MIN_LAYLINE_DETERMINANT = 1e-3f;  ///< sin(2 x target) below this: laylines (nearly) parallel
+const float MIN_STW_KN = 0.1f;                ///< No time to the layline when not moving
+const double DEG_TO_RAD_D = 0.017453292519943295;
+
+/// Signed a - b of two millis() timestamps
+inline int32_t elapsed(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b);
+}
+
+inline float wrap(float angle) {
+    return static_cast<float>(AngleUtils::normalizeToZeroTwoPi(static_cast<BoatScalar>(angle)));
+}
+
+/// 1 min average if it has samples, else the instantaneous value
+inline float preferAverage(float average, BoatScalar value) {
+    return isfinite(average) ? average : static_cast<float>(value);
+}
+
+void clearWaypointOutputs(NavigationData& nav) {
+    nav.waypointBearing = nav.waypointDistance = NAN;
+    nav.laylineStarboard = nav.laylinePort = NAN;
+    nav.distanceToLayline = nav.timeToLayline = NAN;
+    nav.upwindLeg = false;
+}
+
+}  // namespace
+
+// =============================================================================
+// ActiveWaypoint
+// =============================================================================
+
+ActiveWaypoint::ActiveWaypoint() : lock_() {
+    waypoint_.latitude = waypoint_.longitude = NAN;
+    waypoint_.number = 0;
+    waypoint_.available = false;
+    waypoint_.lastUpdate = 0;
+}
+
+void ActiveWaypoint::set(const WaypointData& waypoint) {
+    lock_.writeBegin();
+    waypoint_ = waypoint;
+    lock_.writeEnd();
+}
+
+bool ActiveWaypoint::get(WaypointData& out) const {
+    return lock_.read(waypoint_, out);
+}
+
+// =============================================================================
+// NavigationEngine
+// =============================================================================
+
+NavigationEngine::NavigationEngine() : polar_(nullptr), lock_() {
+    data_.oppositeHeading = data_.targetAngle = NAN;
+    clearWaypointOutputs(data_);
+    data_.available = false;
+    data_.lastUpdate = 0;
+}
+
+void NavigationEngine::setPolar(const PolarTable* polar) {
+    polar_ = polar;
+}
+
+bool NavigationEngine::read(NavigationData& out) const {
+    return lock_.read(data_, out);
+}
+
+float NavigationEngine::targetAngle(float tws, bool downwind, float fallback) const {
+    PolarTarget target;
+    if (polar_ != nullptr && polar_->target(tws, downwind, target) && isfinite(target.twa)) {
+        return target.twa;
+    }
+    return fallback;
+}
+
+void NavigationEngine::update(const BoatDataStructure& data, const WaypointData& waypoint, uint32_t nowMs) {
+    NavigationData nav;
+    nav.oppositeHeading = nav.targetAngle = NAN;
+    clearWaypointOutputs(nav);
+    nav.available = false;
+    nav.lastUpdate = nowMs;
+
+    const DerivedData& derived = data.derived;
+    float twa = static_cast<float>(derived.twa);
+    float twd = preferAverage(derived.wdirAvg1m, derived.wdir);
+    float tws = preferAverage(derived.twsAvg1m, derived.tws);
+
+    if (derived.available && isfinite(twa) && isfinite(twd) && isfinite(tws)) {
+        // Mirror the current best-VMG course about the wind (TWD = heading + TWA)
+        float absTwa = fabsf(twa);
+        nav.targetAngle = targetAngle(tws, absTwa > HALF_PI_F, absTwa);
+        nav.oppositeHeading = wrap(twa >= 0.0f ? twd + nav.targetAngle : twd - nav.targetAngle);
+        nav.available = true;
+
+        bool fresh = waypoint.available && elapsed(nowMs, static_cast<uint32_t>(waypoint.lastUpdate)) <= NAV_WAYPOINT_TIMEOUT_MS;
+        if (fresh && data.gps.available) {
+            updateLaylines(data, waypoint, twd, tws, nav);
+        }
+    }
+
+    lock_.writeBegin();
+    data_ = nav;
+    lock_.writeEnd();
+}
+
+void NavigationEngine::updateLaylines(const BoatDataStructure& data, const WaypointData& waypoint,
+                                      float twd, float tws, NavigationData& nav) const {
+    const GPSData& gps = data.gps;
+    if (!isfinite(waypoint.latitude) || !isfinite(waypoint.longitude) ||
+        !isfinite(gps.latitude) || !isfinite(gps.longitude)) {
+        return;
+    }
+
+    // Local flat-earth vector to the waypoint, nautical miles
+    double dLon = waypoint.longitude - gps.longitude;
+    if (dLon > 180.0) {
+        dLon -= 360.0;
+    } else if (dLon < -180.0) {
+        dLon += 360.0;
+    }
+    double meanLat = 0.5 * (waypoint.latitude + gps.latitude) * DEG_TO_RAD_D;
+    float north = static_cast<float>(waypoint.latitude - gps.latitude) * NM_PER_DEGREE;
+    float east = static_cast<float>(dLon * cos(meanLat)) * NM_PER_DEGREE;
+    float distance = sqrtf(north * north + east * east);
+
+    // True to magnetic as for COG (CalculationEngine::stageCurrent)
+    float variation = isfinite(gps.variation) ? static_cast<float>(gps.variation) : 0.0f;
+    float bearing = wrap(atan2f(east, north) + variation);
+    nav.waypointDistance = distance;
+    nav.waypointBearing = bearing;
+
+    // Leg type by the bearing off the wind, target angle for that leg
+    float offWind = static_cast<float>(AngleUtils::angleDifference(bearing, twd));
+    nav.upwindLeg = fabsf(offWind) < HALF_PI_F;
+    float fallback = fabsf(static_cast<float>(data.derived.twa));
+    float target = targetAngle(tws, !nav.upwindLeg, fallback);
+    float starboard = wrap(twd - target);
+    float port = wrap(twd + target);
+    nav.laylineStarboard = starboard;
+    nav.laylinePort = port;
+
+    // D·u(bearing) = a·u(starboard) + b·u(port), u(h) = (sin h, cos h)
+    float determinant = sinf(starboard - port);
+    if (fabsf(determinant) < MIN_LAYLINE_DETERMINANT) {
+        return;
+    }
+    float onStarboard = distance * sinf(bearing - port) / determinant;
+    float onPort = distance * sinf(starboard - bearing) / determinant;
+    float toLayline = data.derived.twa >= BoatScalar(0) ? onStarboard : onPort;
+    nav.distanceToLayline = toLayline > 0.0f ? toLayline : 0.0f;
+
+    float stw = static_cast<float>(data.derived.stw);
+    if (isfinite(stw) && stw > MIN_STW_KN) {
+        nav.timeToLayline = nav.distanceToLayline / stw * 3600.0f;
+    }
+}
+
+void NavigationEngine::writeJson(JsonWriter& json, const NavigationData& nav) {
+    json.beginObject();
+    json.add("available", nav.available);
+    json.add("opposite_heading", static_cast<double>(nav.oppositeHeading), 4);
+    json.add("target_angle", static_cast<double>(nav.targetAngle), 4);
+    if (isfinite(nav.waypointBearing)) {
+        json.beginObject("waypoint");
+        json.add("bearing", static_cast<double>(nav.waypointBearing), 4);
+        json.add("distance", static_cast<double>(nav.waypointDistance), 3);
+        json.add("upwind", nav.upwindLeg);
+        json.add("layline_starboard", static_cast<double>(nav.laylineStarboard), 4);
+        json.add("layline_port", static_cast<double>(nav.laylinePort), 4);
+        json.add("distance_to_layline", static_cast<double>(nav.distanceToLayline), 3);
+        json.add("time_to_layline", static_cast<double>(nav.timeToLayline), 0);
+        json.endObject();
+    } else {
+        json.addRaw("waypoint", "null");
+    }
+    json.add("last_update", nav.lastUpdate);
+    json.endObject();
+}
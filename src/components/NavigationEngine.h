@@ -0,0 +1,140 @@
+/**
+ * @file NavigationEngine.h
+ * @brief Tack/gybe heading prediction and laylines to the active waypoint
+ *
+ * A slower stage after the calculation cycle (main.cpp: BoatData
+ * subscription on DERIVED/GPS, at most every NAV_MIN_INTERVAL_MS), so the
+ * core wind calculation is never delayed by it:
+ * - oppositeHeading: magnetic heading after a tack (upwind) or gybe
+ *   (downwind), at the polar best-VMG angle for the TWS, mirrored about
+ *   the averaged wind direction (derived.wdirAvg1m)
+ * - with an active waypoint (PGN 129284, ActiveWaypoint): bearing and
+ *   distance from the GPS position, the two laylines through the waypoint
+ *   for the leg towards it (upwind or downwind), and the distance and time
+ *   to sail on the current tack before the layline is reached
+ *
+ * The laylines are the best-VMG headings on either tack: TWD - target
+ * (starboard) and TWD + target (port). The vector to the waypoint is split
+ * into those two headings; the current tack's share is the distance to the
+ * layline (0 once on or past it). Without a polar the current |TWA| is
+ * used as the target angle. Current and leeway are not modelled.
+ *
+ * Bearings are converted to magnetic with gps.variation as in the current
+ * calculation; distances use a local flat-earth approximation (error < 0.5%
+ * within 100 nm).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed state, zero heap allocation
+ * - Principle VII (Fail-Safe): outputs NaN when an input is missing or stale
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef NAVIGATION_ENGINE_H
+#define NAVIGATION_ENGINE_H
+
+#include <stdint.h>
+#include "../types/BoatDataTypes.h"
+#include "../utils/PolarTable.h"
+#include "../utils/SeqLock.h"
+#include "../utils/JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Destination waypoint (PGN 129284 Navigation Data)
+ */
+struct WaypointData {
+    double latitude;           ///< Decimal degrees
+    double longitude;
+    uint32_t number;           ///< Destination waypoint number (0 = none sent)
+    bool available;
+    unsigned long lastUpdate;  ///< millis() of the last PGN 129284
+};
+
+/**
+ * @class ActiveWaypoint
+ * @brief Latest waypoint, written by the NMEA2000 receive context, read by the navigation stage
+ */
+class ActiveWaypoint {
+public:
+    ActiveWaypoint();
+
+    /// Replace the waypoint (single writer)
+    void set(const WaypointData& waypoint);
+
+    /// Consistent copy; false if it could not be read (see SeqLock::read())
+    bool get(WaypointData& out) const;
+
+private:
+    WaypointData waypoint_;
+    SeqLock lock_;
+};
+
+/**
+ * @brief Navigation stage outputs (NaN = not available)
+ */
+struct NavigationData {
+    float oppositeHeading;     ///< Heading after a tack/gybe, radians, [0, 2π), magnetic
+    float targetAngle;         ///< |TWA| used for oppositeHeading, radians
+    float waypointBearing;     ///< Bearing to the waypoint, radians, [0, 2π), magnetic
+    float waypointDistance;    ///< Nautical miles
+    float laylineStarboard;    ///< Starboard-tack layline heading, radians, [0, 2π), magnetic
+    float laylinePort;         ///< Port-tack layline heading, radians, [0, 2π), magnetic
+    float distanceToLayline;   ///< On the current tack, nautical miles (0 = on/past it)
+    float timeToLayline;       ///< At the current STW, seconds
+    bool upwindLeg;            ///< Waypoint is upwind (laylines use the beat angle)
+    bool available;            ///< oppositeHeading valid
+    unsigned long lastUpdate;  ///< millis() of the last update
+};
+
+/**
+ * @class NavigationEngine
+ * @brief Opposite-tack heading and waypoint laylines from DerivedData and the polar
+ *
+ * Usage:
+ * @code
+ * NavigationEngine navigation;
+ * navigation.setPolar(&polar);
+ * WaypointData waypoint;
+ * GetActiveWaypoint().get(waypoint);
+ * navigation.update(*boatData->getDataStructure(), waypoint, millis());
+ * @endcode
+ */
+class NavigationEngine {
+public:
+    NavigationEngine();
+
+    /**
+     * @brief Use @p polar for the target angles (nullptr = current |TWA|)
+     */
+    void setPolar(const PolarTable* polar);
+
+    /**
+     * @brief Recompute from @p data (main loop) and @p waypoint at @p nowMs
+     *
+     * A waypoint older than NAV_WAYPOINT_TIMEOUT_MS is ignored.
+     */
+    void update(const BoatDataStructure& data, const WaypointData& waypoint, uint32_t nowMs);
+
+    /// Consistent copy of the outputs (any task)
+    bool read(NavigationData& out) const;
+
+    /**
+     * @brief {"available":true,"opposite_heading":4.1234,...,"waypoint":{...}|null}
+     */
+    static void writeJson(JsonWriter& json, const NavigationData& nav);
+
+private:
+    const PolarTable* polar_;
+    NavigationData data_;
+    SeqLock lock_;
+
+    /// Best-VMG |TWA| for @p tws on the given leg, or @p fallback
+    float targetAngle(float tws, bool downwind, float fallback) const;
+
+    void updateLaylines(const BoatDataStructure& data, const WaypointData& waypoint,
+                        float twd, float tws, NavigationData& nav) const;
+};
+
+#endif // NAVIGATION_ENGINE_H
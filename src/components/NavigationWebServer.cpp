@@ -0,0 +1,35 @@
+/**
+ * @file NavigationWebServer.cpp
+ * @brief Implementation of the navigation endpoint
+ *
+ * @see NavigationWebServer.h
+ */
+
+#include "NavigationWebServer.h"
+
+NavigationWebServer::NavigationWebServer(const NavigationEngine* engine)
+    : engine(engine) {
+}
+
+void NavigationWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr) {
+        return;
+    }
+
+    // GET /navigation - Opposite-tack heading and waypoint laylines
+    server->on("/navigation", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetNavigation(request);
+    });
+}
+
+void NavigationWebServer::handleGetNavigation(AsyncWebServerRequest* request) {
+    NavigationData nav;
+    if (engine == nullptr || !engine->read(nav)) {
+        request->send(503, "application/json", "{\"error\":\"Navigation data unavailable\"}");
+        return;
+    }
+
+    StaticJsonWriter<384> json;
+    NavigationEngine::writeJson(json, nav);
+    request->send(200, "application/json", json.c_str());
+}
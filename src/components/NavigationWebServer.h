@@ -0,0 +1,64 @@
+/**
+ * @file NavigationWebServer.h
+ * @brief HTTP read-out of the navigation stage (opposite-tack heading, laylines)
+ *
+ * Provides:
+ * - GET /navigation: latest NavigationEngine outputs
+ *
+ * @version 1.0.0
+ */
+
+#ifndef NAVIGATION_WEB_SERVER_H
+#define NAVIGATION_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "NavigationEngine.h"
+
+/**
+ * @brief Web server route for the navigation outputs
+ */
+class NavigationWebServer {
+private:
+    const NavigationEngine* engine;
+
+    /**
+     * @brief Handle GET /navigation
+     *
+     * Returns (angles in radians, magnetic; distances in nautical miles):
+     * {
+     *   "available": true, "opposite_heading": 4.1234, "target_angle": 0.7330,
+     *   "waypoint": {
+     *     "bearing": 0.5236, "distance": 3.214, "upwind": true,
+     *     "layline_starboard": 5.8643, "layline_port": 1.3305,
+     *     "distance_to_layline": 1.102, "time_to_layline": 661
+     *   },
+     *   "last_update": 123456
+     * }
+     *
+     * "waypoint" is null without a current PGN 129284 destination or GPS
+     * fix; unavailable values are null.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetNavigation(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param engine Navigation stage to report (must outlive the server)
+     */
+    explicit NavigationWebServer(const NavigationEngine* engine);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // NAVIGATION_WEB_SERVER_H
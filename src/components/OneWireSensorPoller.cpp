@@ -7,7 +7,73 @@
 #include <Arduino.h>
 
 OneWireSensorPoller::OneWireSensorPoller(ESP32OneWireSensors* sensors, BoatData* data, WebSocketLogger* log)
-    : oneWireSensors(sensors), boatData(data), logger(log) {
+    : oneWireSensors(sensors), boatData(data), logger(log), socSource(nullptr),
+      batteryRegistered(false) {
+}
+
+bool OneWireSensorPoller::pollConversion() {
+    if (oneWireSensors == nullptr || boatData == nullptr) {
+        return false;
+    }
+
+    OneWireConversion& conversion = oneWireSensors->getConversion();
+    if (conversion.isIdle() && oneWireSensors->serviceSearch(millis())) {
+        return false;  // This tick's bus time went to the background ROM search
+    }
+    if (!conversion.step(millis())) {
+        return false;
+    }
+
+    SaildriveData saildrive;
+    BatteryMonitorData batteryA, batteryB;
+    ShorePowerData shorePower;
+    bool saildriveOk, batteryAOk, batteryBOk, shorePowerOk;
+    uint8_t devices = collectConversion(conversion, millis(), saildriveOk, saildrive, batteryAOk, batteryA,
+                                        batteryBOk, batteryB, shorePowerOk, shorePower);
+
+    if (devices & (1u << static_cast<uint8_t>(OneWireDevice::SAILDRIVE))) {
+        applySaildriveData(saildriveOk, saildrive);
+    }
+    if (cycleHasBatteries(devices)) {
+        applyBatteryData(batteryAOk, batteryA, batteryBOk, batteryB);
+    }
+    if (devices & (1u << static_cast<uint8_t>(OneWireDevice::SHORE_POWER))) {
+        applyShorePowerData(shorePowerOk, shorePower);
+    }
+    return false;
+}
+
+uint8_t OneWireSensorPoller::collectConversion(const OneWireConversion& conversion, uint32_t nowMs,
+                                               bool& saildriveOk, SaildriveData& saildrive,
+                                               bool& batteryAOk, BatteryMonitorData& batteryA,
+                                               bool& batteryBOk, BatteryMonitorData& batteryB,
+                                               bool& shorePowerOk, ShorePowerData& shorePower) {
+    const OneWireResult& sail = conversion.getResult(OneWireDevice::SAILDRIVE);
+    saildriveOk = sail.ok;
+    saildrive.saildriveEngaged = sail.ok && DS2438DigitalState(sail.reading);
+    saildrive.available = sail.ok;
+    saildrive.lastUpdate = nowMs;
+
+    const OneWireResult& battA = conversion.getResult(OneWireDevice::BATTERY_A);
+    batteryAOk = battA.ok;
+    if (battA.ok) {
+        DS2438ToBattery(battA.reading, batteryA);
+    }
+
+    const OneWireResult& battB = conversion.getResult(OneWireDevice::BATTERY_B);
+    batteryBOk = battB.ok;
+    if (battB.ok) {
+        DS2438ToBattery(battB.reading, batteryB);
+    }
+
+    const OneWireResult& shore = conversion.getResult(OneWireDevice::SHORE_POWER);
+    shorePowerOk = shore.ok;
+    if (shore.ok) {
+        DS2438ToShorePower(shore.reading, shorePower);
+        shorePower.lastUpdate = nowMs;
+    }
+
+    return conversion.getCycleDevices();
 }
 
 void OneWireSensorPoller::pollSaildriveData() {
@@ -16,13 +82,22 @@ void OneWireSensorPoller::pollSaildriveData() {
     }
 
     SaildriveData saildriveData;
-    if (oneWireSensors->readSaildriveStatus(saildriveData)) {
+    bool ok = oneWireSensors->readSaildriveStatus(saildriveData);
+    applySaildriveData(ok, saildriveData);
+}
+
+void OneWireSensorPoller::applySaildriveData(bool ok, const SaildriveData& saildriveData) {
+    if (boatData == nullptr) {
+        return;
+    }
+
+    if (ok) {
         boatData->setSaildriveData(saildriveData);
-        logger->broadcastLog(LogLevel::DEBUG, "OneWire", "SAILDRIVE_UPDATE",
-            String(F("{\"engaged\":")) + (saildriveData.saildriveEngaged ? F("true") : F("false")) + F("}"));
+        LOG_DEBUGF(logger, LogComponent::ONE_WIRE, LogEvent::SAILDRIVE_UPDATE,
+            "{\"engaged\":%s}", saildriveData.saildriveEngaged ? "true" : "false");
     } else {
-        logger->broadcastLog(LogLevel::WARN, "OneWire", "SAILDRIVE_READ_FAILED",
-            F("{\"reason\":\"Sensor read error or CRC failure\"}"));
+        logger->broadcastLogf(LogLevel::WARN, LogComponent::ONE_WIRE, LogEvent::SAILDRIVE_READ_FAILED,
+            "{\"reason\":\"Sensor read error or CRC failure\"}");
     }
 }
 
@@ -34,6 +109,14 @@ void OneWireSensorPoller::pollBatteryData() {
     BatteryMonitorData batteryA, batteryB;
     bool successA = oneWireSensors->readBatteryA(batteryA);
     bool successB = oneWireSensors->readBatteryB(batteryB);
+    applyBatteryData(successA, batteryA, successB, batteryB);
+}
+
+void OneWireSensorPoller::applyBatteryData(bool successA, const BatteryMonitorData& batteryA,
+                                           bool successB, const BatteryMonitorData& batteryB) {
+    if (boatData == nullptr) {
+        return;
+    }
 
     if (successA && successB) {
         // Combine into BatteryData structure
@@ -50,20 +133,34 @@ void OneWireSensorPoller::pollBatteryData() {
         batteryData.engineChargerOnB = batteryB.engineChargerOn;
         batteryData.available = true;
         batteryData.lastUpdate = millis();
+        if (socSource != nullptr) {
+            // Coulomb counting: the voltage estimate is only right at rest
+            if (socSource->getEstimator(0).isValid()) {
+                batteryData.stateOfChargeA = socSource->getEstimator(0).getStateOfCharge();
+            }
+            if (socSource->getEstimator(1).isValid()) {
+                batteryData.stateOfChargeB = socSource->getEstimator(1).getStateOfCharge();
+            }
+        }
 
-        boatData->setBatteryData(batteryData);
+        if (!batteryRegistered) {
+            // Competes with NMEA2000 battery monitors (N2kSourceGroup::BATTERY)
+            batterySource = boatData->registerSource("1W-BAT", SensorType::BATTERY, ProtocolType::ONEWIRE);
+            batteryRegistered = true;
+        }
+        if (!boatData->updateBattery(batterySource, batteryData)) {
+            return;  // A faster battery monitor is active
+        }
 
-        logger->broadcastLog(LogLevel::DEBUG, "OneWire", "BATTERY_UPDATE",
-            String(F("{\"battA_V\":")) + batteryA.voltage +
-            F(",\"battA_A\":") + batteryA.amperage +
-            F(",\"battA_SOC\":") + batteryA.stateOfCharge +
-            F(",\"battB_V\":") + batteryB.voltage +
-            F(",\"battB_A\":") + batteryB.amperage +
-            F(",\"battB_SOC\":") + batteryB.stateOfCharge + F("}"));
+        LOG_DEBUGF(logger, LogComponent::ONE_WIRE, LogEvent::BATTERY_UPDATE,
+            "{\"battA_V\":%.2f,\"battA_A\":%.2f,\"battA_SOC\":%.2f,"
+            "\"battB_V\":%.2f,\"battB_A\":%.2f,\"battB_SOC\":%.2f}",
+            batteryA.voltage, batteryA.amperage, batteryA.stateOfCharge,
+            batteryB.voltage, batteryB.amperage, batteryB.stateOfCharge);
     } else {
-        logger->broadcastLog(LogLevel::WARN, "OneWire", "BATTERY_READ_FAILED",
-            String(F("{\"battA_success\":")) + (successA ? F("true") : F("false")) +
-            F(",\"battB_success\":") + (successB ? F("true") : F("false")) + F("}"));
+        logger->broadcastLogf(LogLevel::WARN, LogComponent::ONE_WIRE, LogEvent::BATTERY_READ_FAILED,
+            "{\"battA_success\":%s,\"battB_success\":%s}",
+            successA ? "true" : "false", successB ? "true" : "false");
     }
 }
 
@@ -73,13 +170,22 @@ void OneWireSensorPoller::pollShorePowerData() {
     }
 
     ShorePowerData shorePower;
-    if (oneWireSensors->readShorePower(shorePower)) {
+    bool ok = oneWireSensors->readShorePower(shorePower);
+    applyShorePowerData(ok, shorePower);
+}
+
+void OneWireSensorPoller::applyShorePowerData(bool ok, const ShorePowerData& shorePower) {
+    if (boatData == nullptr) {
+        return;
+    }
+
+    if (ok) {
         boatData->setShorePowerData(shorePower);
-        logger->broadcastLog(LogLevel::DEBUG, "OneWire", "SHORE_POWER_UPDATE",
-            String(F("{\"connected\":")) + (shorePower.shorePowerOn ? F("true") : F("false")) +
-            F(",\"power_W\":") + shorePower.power + F("}"));
+        LOG_DEBUGF(logger, LogComponent::ONE_WIRE, LogEvent::SHORE_POWER_UPDATE,
+            "{\"connected\":%s,\"power_W\":%.2f}",
+            shorePower.shorePowerOn ? "true" : "false", shorePower.power);
     } else {
-        logger->broadcastLog(LogLevel::WARN, "OneWire", "SHORE_POWER_READ_FAILED",
-            F("{\"reason\":\"Sensor read error or CRC failure\"}"));
+        logger->broadcastLogf(LogLevel::WARN, LogComponent::ONE_WIRE, LogEvent::SHORE_POWER_READ_FAILED,
+            "{\"reason\":\"Sensor read error or CRC failure\"}");
     }
 }
@@ -7,7 +7,11 @@
  * - Dual battery bank monitoring (A/B)
  * - Shore power connection and draw
  *
- * Designed to be called from ReactESP event loops.
+ * Designed to be called from ReactESP event loops. pollConversion() steps
+ * the sensors' OneWireConversion cycle (about 1 ms of bus time per call)
+ * and applies the results when a cycle completes; the blocking poll*()
+ * methods read one sensor group each. With TASK_LAYOUT 1 the cycle runs in
+ * OneWireSensorTask and only apply*() runs on the main loop.
  */
 
 #ifndef ONEWIRE_SENSOR_POLLER_H
@@ -15,6 +19,7 @@
 
 #include "hal/implementations/ESP32OneWireSensors.h"
 #include "components/BoatData.h"
+#include "utils/TripCounters.h"
 #include "utils/WebSocketLogger.h"
 
 /**
@@ -24,9 +29,9 @@
  * Usage:
  * @code
  * OneWireSensorPoller* poller = new OneWireSensorPoller(sensors, boatData, &logger);
- * app.onRepeat(1000, [&]() { poller->pollSaildriveData(); });
- * app.onRepeat(2000, [&]() { poller->pollBatteryData(); });
- * app.onRepeat(2000, [&]() { poller->pollShorePowerData(); });
+ * ioPump.add("ow_conv", [](void* ctx) {
+ *     return static_cast<OneWireSensorPoller*>(ctx)->pollConversion();
+ * }, poller, 0);
  * @endcode
  */
 class OneWireSensorPoller {
@@ -39,6 +44,47 @@ public:
      */
     OneWireSensorPoller(ESP32OneWireSensors* sensors, BoatData* data, WebSocketLogger* log);
 
+    /**
+     * @brief Step the conversion cycle; apply its results when it completes
+     *
+     * Each group is applied when the cycle read it (per-device periods,
+     * ONEWIRE_*_PERIOD_MS). Between cycles a running background ROM search
+     * (ESP32OneWireSensors::serviceSearch()) takes the tick instead. Call
+     * every I/O pump tick.
+     *
+     * @return false (a step is bounded; no more work is pending this tick)
+     */
+    bool pollConversion();
+
+    /**
+     * @brief Publish the coulomb-counting state of charge instead of the voltage estimate
+     *
+     * applyBatteryData() then stores each bank's BatterySocEstimator value
+     * in BatteryData.stateOfChargeA/B once it is valid (BATTERY_SOC_ENABLED).
+     *
+     * @param counters Owner of the estimators (nullptr = voltage estimate)
+     */
+    void setStateOfChargeSource(const TripCounters* counters) { socSource = counters; }
+
+    /**
+     * @brief Convert the results of a completed cycle into readings
+     *
+     * Shared with OneWireSensorTask, which queues them instead of applying.
+     *
+     * @return Devices of the cycle (bit per OneWireDevice)
+     */
+    static uint8_t collectConversion(const OneWireConversion& conversion, uint32_t nowMs,
+                                     bool& saildriveOk, SaildriveData& saildrive,
+                                     bool& batteryAOk, BatteryMonitorData& batteryA,
+                                     bool& batteryBOk, BatteryMonitorData& batteryB,
+                                     bool& shorePowerOk, ShorePowerData& shorePower);
+
+    /// A completed cycle read battery A or B
+    static bool cycleHasBatteries(uint8_t devices) {
+        return (devices & ((1u << static_cast<uint8_t>(OneWireDevice::BATTERY_A)) |
+                           (1u << static_cast<uint8_t>(OneWireDevice::BATTERY_B)))) != 0;
+    }
+
     /**
      * @brief Poll saildrive engagement status (1 Hz recommended)
      *
@@ -64,10 +110,37 @@ public:
      */
     void pollShorePowerData();
 
+    /**
+     * @brief Store a saildrive reading in BoatData (main loop only)
+     * @param ok Result of readSaildriveStatus()
+     */
+    void applySaildriveData(bool ok, const SaildriveData& saildriveData);
+
+    /**
+     * @brief Store both battery readings in BoatData (main loop only)
+     *
+     * Arbitrated as the "1W-BAT" SensorType::BATTERY source: dropped while an
+     * NMEA2000 battery monitor (update rate x quality) is the active one.
+     *
+     * @param successA Result of readBatteryA()
+     * @param successB Result of readBatteryB()
+     */
+    void applyBatteryData(bool successA, const BatteryMonitorData& batteryA,
+                          bool successB, const BatteryMonitorData& batteryB);
+
+    /**
+     * @brief Store a shore power reading in BoatData (main loop only)
+     * @param ok Result of readShorePower()
+     */
+    void applyShorePowerData(bool ok, const ShorePowerData& shorePower);
+
 private:
     ESP32OneWireSensors* oneWireSensors;
     BoatData* boatData;
     WebSocketLogger* logger;
+    const TripCounters* socSource;
+    BoatDataSourceHandle batterySource;   ///< "1W-BAT", registered on the first battery reading
+    bool batteryRegistered;
 };
 
 #endif // ONEWIRE_SENSOR_POLLER_H
@@ -0,0 +1,110 @@
+/**
+ * @file OneWireSensorTask.cpp
+ * @brief Implementation of the 1-Wire reader task
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "OneWireSensorTask.h"
+
+OneWireSensorTask::OneWireSensorTask()
+    : sensors_(nullptr), poller_(nullptr), stallWatchdog_(nullptr), stallSlot_(-1), taskHandle_(nullptr) {
+}
+
+bool OneWireSensorTask::begin(ESP32OneWireSensors* sensors, OneWireSensorPoller* poller,
+                              WebSocketLogger* logger) {
+    if (sensors == nullptr || poller == nullptr || taskHandle_ != nullptr) {
+        return false;
+    }
+    sensors_ = sensors;
+    poller_ = poller;
+
+    BaseType_t created = xTaskCreatePinnedToCore(taskEntry, "onewire", ONEWIRE_TASK_STACK, this,
+                                                 ONEWIRE_TASK_PRIORITY, &taskHandle_,
+                                                 ONEWIRE_TASK_CORE);
+    if (created != pdPASS) {
+        taskHandle_ = nullptr;
+        logger->broadcastLog(LogLevel::ERROR, LogComponent::ONE_WIRE, LogEvent::ONEWIRE_TASK_FAILED,
+            "{\"reason\":\"xTaskCreatePinnedToCore failed\",\"fallback\":\"main_loop\"}");
+        return false;
+    }
+
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::ONE_WIRE, LogEvent::ONEWIRE_TASK_STARTED,
+        "{\"core\":%d,\"priority\":%d,\"stack\":%d,\"queue\":%d}",
+        ONEWIRE_TASK_CORE, ONEWIRE_TASK_PRIORITY, ONEWIRE_TASK_STACK, ONEWIRE_TASK_QUEUE_CAPACITY);
+    return true;
+}
+
+void OneWireSensorTask::service() {
+    OneWireReading reading;
+    while (queue_.pop(reading)) {
+        switch (reading.kind) {
+            case OneWireReading::SAILDRIVE:
+                poller_->applySaildriveData(reading.ok, reading.saildrive);
+                break;
+            case OneWireReading::BATTERY:
+                poller_->applyBatteryData(reading.ok, reading.batteryA, reading.okB, reading.batteryB);
+                break;
+            case OneWireReading::SHORE_POWER:
+                poller_->applyShorePowerData(reading.ok, reading.shorePower);
+                break;
+        }
+    }
+}
+
+void OneWireSensorTask::watch(const char* activity) {
+    if (stallWatchdog_ == nullptr) {
+        return;
+    }
+    if (activity != nullptr) {
+        stallWatchdog_->enter(stallSlot_, activity, millis());
+    } else {
+        stallWatchdog_->exit(stallSlot_);
+    }
+}
+
+void OneWireSensorTask::taskEntry(void* param) {
+    OneWireSensorTask* self = static_cast<OneWireSensorTask*>(param);
+    OneWireConversion& conversion = self->sensors_->getConversion();
+
+    for (;;) {
+        // Between cycles a background ROM search (missing device) takes the step
+        if (conversion.isIdle()) {
+            self->watch("1w_search");
+            bool searching = self->sensors_->serviceSearch(millis());
+            self->watch(nullptr);
+            if (searching) {
+                vTaskDelay(pdMS_TO_TICKS(ONEWIRE_TASK_STEP_MS));
+                continue;
+            }
+        }
+
+        self->watch("1w_step");
+        bool completed = conversion.step(millis());
+        self->watch(nullptr);
+
+        if (completed) {
+            OneWireReading sail, battery, shore;
+            uint8_t devices = OneWireSensorPoller::collectConversion(
+                conversion, millis(), sail.ok, sail.saildrive, battery.ok, battery.batteryA,
+                battery.okB, battery.batteryB, shore.ok, shore.shorePower);
+
+            // Only the groups this cycle read (full queue: counted as dropped)
+            if (devices & (1u << static_cast<uint8_t>(OneWireDevice::SAILDRIVE))) {
+                sail.kind = OneWireReading::SAILDRIVE;
+                self->queue_.push(sail);
+            }
+            if (OneWireSensorPoller::cycleHasBatteries(devices)) {
+                battery.kind = OneWireReading::BATTERY;
+                self->queue_.push(battery);
+            }
+            if (devices & (1u << static_cast<uint8_t>(OneWireDevice::SHORE_POWER))) {
+                shore.kind = OneWireReading::SHORE_POWER;
+                self->queue_.push(shore);
+            }
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(ONEWIRE_TASK_STEP_MS));
+    }
+}
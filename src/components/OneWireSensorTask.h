@@ -0,0 +1,108 @@
+/**
+ * @file OneWireSensorTask.h
+ * @brief 1-Wire sensor reads in a FreeRTOS task (TASK_LAYOUT 1)
+ *
+ * The 1-Wire cycle (OneWireConversion) keeps the bus busy for some 30 ms
+ * per device read, in steps of about 1 ms. In the default layout the steps
+ * run on the main loop (OneWireSensorPoller::pollConversion); with
+ * ONEWIRE_TASK_ENABLED this task takes them over:
+ * - The task owns the bus: one step every ONEWIRE_TASK_STEP_MS on
+ *   ONEWIRE_TASK_CORE (saildrive every 1 s, batteries and shore power
+ *   every 2 s), sleeping in between
+ * - Each result of a completed cycle is pushed into an SPSC queue (task -> main loop); a full
+ *   queue drops the reading and counts it
+ * - service() on the main loop pops the readings and hands them to
+ *   OneWireSensorPoller::apply*(), the only writer of the 1-Wire BoatData
+ *   groups, with the same log events as the polled layout
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): static reading queue, no heap after begin()
+ * - Principle VII (Fail-Safe): a stuck bus delays only this task, never the main loop
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ONEWIRE_SENSOR_TASK_H
+#define ONEWIRE_SENSOR_TASK_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config.h"
+#include "../utils/SPSCQueue.h"
+#include "../utils/StallWatchdog.h"
+#include "OneWireSensorPoller.h"
+
+/**
+ * @brief One sensor read, as queued from the task to the main loop
+ */
+struct OneWireReading {
+    enum Kind : uint8_t { SAILDRIVE = 0, BATTERY, SHORE_POWER };
+
+    Kind kind;
+    bool ok;                     ///< Read result (saildrive, shore power, battery A)
+    bool okB;                    ///< Battery B read result
+    SaildriveData saildrive;
+    BatteryMonitorData batteryA;
+    BatteryMonitorData batteryB;
+    ShorePowerData shorePower;
+};
+
+/**
+ * @class OneWireSensorTask
+ * @brief Reads the 1-Wire sensors off the main loop
+ *
+ * Usage pattern:
+ * @code
+ * oneWireTask.begin(oneWireSensors, oneWirePoller, &logger);
+ * app.onRepeat(ONEWIRE_APPLY_INTERVAL_MS, []() { oneWireTask.service(); });
+ * @endcode
+ */
+class OneWireSensorTask {
+public:
+    OneWireSensorTask();
+
+    /**
+     * @brief Start the reader task
+     *
+     * @param sensors Initialized bus (owned by the task from now on)
+     * @param poller Applies the readings (main loop)
+     * @return false if already started or the task could not be created
+     */
+    bool begin(ESP32OneWireSensors* sensors, OneWireSensorPoller* poller, WebSocketLogger* logger);
+
+    /**
+     * @brief Bracket every conversion step of the task in @p slot ("1w_step", "1w_search")
+     *
+     * Call before begin().
+     */
+    void setStallWatchdog(StallWatchdog* watchdog, int8_t slot) {
+        stallWatchdog_ = watchdog;
+        stallSlot_ = slot;
+    }
+
+    /**
+     * @brief Apply all queued readings (main loop only)
+     */
+    void service();
+
+    TaskHandle_t getTaskHandle() const { return taskHandle_; }
+    uint32_t getQueueHighWater() const { return queue_.getHighWater(); }
+    uint32_t getDropped() const { return queue_.getDroppedCount(); }
+
+private:
+    SPSCQueue<OneWireReading, ONEWIRE_TASK_QUEUE_CAPACITY> queue_;
+    ESP32OneWireSensors* sensors_;
+    OneWireSensorPoller* poller_;
+    StallWatchdog* stallWatchdog_;
+    int8_t stallSlot_;
+    TaskHandle_t taskHandle_;
+
+    /// Stall watchdog bracket (no-op without a watchdog; nullptr = step finished)
+    void watch(const char* activity);
+
+    static void taskEntry(void* param);
+};
+
+#endif // ONEWIRE_SENSOR_TASK_H
@@ -0,0 +1,188 @@
+/**
+ * @file OtaWebServer.cpp
+ * @brief Implementation of the OTA update endpoints
+ *
+ * @see OtaWebServer.h
+ */
+
+#include "OtaWebServer.h"
+#include "../utils/JsonWriter.h"
+
+OtaWebServer::OtaWebServer(IFirmwareUpdater* firmwareUpdater, WebSocketLogger* webSocketLogger)
+    : session(firmwareUpdater),
+      updater(firmwareUpdater),
+      logger(webSocketLogger),
+      owner(nullptr),
+      uploadTask(nullptr),
+      savedPriority(0),
+      priorityLowered(false),
+      rebootScheduled(false),
+      rebootTime(0) {
+}
+
+void OtaWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || updater == nullptr) {
+        return;
+    }
+
+    // POST /update - Stream an image into flash (response sent once the body is in)
+    server->on("/update", HTTP_POST,
+        [this](AsyncWebServerRequest* request) {
+            this->handleUploadComplete(request);
+        },
+        [this](AsyncWebServerRequest* request, const String& filename, size_t index, uint8_t* data, size_t len, bool final) {
+            this->handleUpload(request, filename, index, data, len, final);
+        }
+    );
+
+    // GET /update - Last or running upload
+    server->on("/update", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetStatus(request);
+    });
+}
+
+bool OtaWebServer::shouldReboot() const {
+    return rebootScheduled && millis() >= rebootTime;
+}
+
+void OtaWebServer::handleUpload(AsyncWebServerRequest* request, const String& filename,
+                                size_t index, uint8_t* data, size_t len, bool final) {
+    (void)filename;
+    if (index == 0 && owner == nullptr && !rebootScheduled && !startUpload(request)) {
+        return;
+    }
+    if (request != owner) {
+        return;  // Refused (busy) or a second file in the same request
+    }
+
+    session.write(data, len);  // Ignored once the session failed
+    if (final) {
+        session.finish(millis());
+        endUpload();
+    }
+}
+
+bool OtaWebServer::startUpload(AsyncWebServerRequest* request) {
+    OtaTarget target = OtaTarget::FIRMWARE;
+    if (request->hasParam("target") && !OtaTargetFromName(request->getParam("target")->value().c_str(), target)) {
+        return false;  // Answered 400 by handleUploadComplete (no owner)
+    }
+    const char* md5 = request->hasParam("md5") ? request->getParam("md5")->value().c_str() : nullptr;
+
+    owner = request;
+    request->onDisconnect([this, request]() {
+        if (request != owner) {
+            return;
+        }
+        owner = nullptr;
+        if (session.isReceiving()) {
+            session.abort();  // Client gone mid-upload
+            endUpload();
+        }
+    });
+
+    // Below the HTTP task's usual priority: the Arduino loop keeps its share during flash writes
+    uploadTask = xTaskGetCurrentTaskHandle();
+    savedPriority = uxTaskPriorityGet(nullptr);
+    priorityLowered = savedPriority > OTA_UPLOAD_TASK_PRIORITY;
+    if (priorityLowered) {
+        vTaskPrioritySet(nullptr, OTA_UPLOAD_TASK_PRIORITY);
+    }
+
+    bool started = session.begin(target, md5, millis());
+    if (started && logger != nullptr) {
+        logger->broadcastLogf(LogLevel::INFO, LogComponent::OTA_UPDATE, LogEvent::UPDATE_STARTED,
+            "{\"target\":\"%s\",\"md5\":%s,\"capacity\":%lu}",
+            OtaTargetName(target), md5 != nullptr ? "true" : "false", (unsigned long)updater->capacity(target));
+    }
+    return true;  // A failed begin() is reported when the body is in
+}
+
+void OtaWebServer::endUpload() {
+    restorePriority();
+    if (logger != nullptr) {
+        if (session.getState() == OtaState::INSTALLED) {
+            logger->broadcastLogf(LogLevel::INFO, LogComponent::OTA_UPDATE, LogEvent::UPDATE_INSTALLED,
+                "{\"target\":\"%s\",\"bytes\":%lu,\"duration_ms\":%lu}",
+                OtaTargetName(session.getTarget()), (unsigned long)session.getBytes(),
+                (unsigned long)session.getDurationMs());
+        } else {
+            logger->broadcastLogf(LogLevel::WARN, LogComponent::OTA_UPDATE, LogEvent::UPDATE_FAILED,
+                "{\"target\":\"%s\",\"error\":\"%s\",\"bytes\":%lu,\"reboot\":%s}",
+                OtaTargetName(session.getTarget()), OtaErrorName(session.getError()),
+                (unsigned long)session.getBytes(), session.requiresReboot() ? "true" : "false");
+        }
+    }
+    if (session.requiresReboot() && !rebootScheduled) {
+        rebootScheduled = true;
+        rebootTime = millis() + OTA_REBOOT_DELAY_MS;
+    }
+}
+
+void OtaWebServer::restorePriority() {
+    if (priorityLowered) {
+        vTaskPrioritySet(uploadTask, savedPriority);
+        priorityLowered = false;
+    }
+}
+
+void OtaWebServer::handleUploadComplete(AsyncWebServerRequest* request) {
+    StaticJsonWriter<256> json;
+    int code = 200;
+
+    if (request != owner) {
+        // No upload chunk reached the session for this request
+        bool busy = owner != nullptr || rebootScheduled;
+        const char* error = busy ? "busy" : "no image";
+        OtaTarget target;
+        if (!busy && request->hasParam("target") &&
+            !OtaTargetFromName(request->getParam("target")->value().c_str(), target)) {
+            error = "target must be firmware or filesystem";
+        }
+        code = busy ? 409 : 400;
+        json.beginObject().add("status", "error").add("error", error).endObject();
+        request->send(code, "application/json", json.c_str());
+        return;
+    }
+    owner = nullptr;
+
+    if (session.getState() == OtaState::INSTALLED) {
+        json.beginObject()
+            .add("status", "installed")
+            .add("target", OtaTargetName(session.getTarget()))
+            .add("bytes", (unsigned long)session.getBytes())
+            .add("duration_ms", (unsigned long)session.getDurationMs())
+            .add("reboot_ms", (unsigned long)OTA_REBOOT_DELAY_MS)
+            .endObject();
+    } else {
+        OtaError error = session.getError();
+        bool flashError = error == OtaError::BEGIN_FAILED || error == OtaError::WRITE_FAILED ||
+                          error == OtaError::HASH_MISMATCH || error == OtaError::VERIFY_FAILED;
+        code = statusCode(error);
+        json.beginObject()
+            .add("status", "error")
+            .add("error", OtaErrorName(error))
+            .add("detail", flashError ? updater->lastError() : (const char*)nullptr)
+            .add("reboot", session.requiresReboot())
+            .endObject();
+    }
+    request->send(code, "application/json", json.c_str());
+}
+
+void OtaWebServer::handleGetStatus(AsyncWebServerRequest* request) {
+    StaticJsonWriter<320> json;
+    json.beginObject();
+    session.writeJson(json, "session");
+    json.add("reboot_pending", rebootScheduled).endObject();
+    request->send(200, "application/json", json.c_str());
+}
+
+int OtaWebServer::statusCode(OtaError error) {
+    switch (error) {
+        case OtaError::BEGIN_FAILED:
+        case OtaError::WRITE_FAILED:
+            return 500;
+        default:
+            return 400;  // The image or the request was refused
+    }
+}
@@ -0,0 +1,111 @@
+/**
+ * @file OtaWebServer.h
+ * @brief HTTP endpoints for over-the-air firmware and filesystem updates
+ *
+ * Provides:
+ * - POST /update?target=firmware|filesystem&md5=<hex>: Upload an image (multipart "image" file)
+ * - GET /update: State of the last or running upload
+ *
+ * The upload handler streams each body chunk into OtaSession, which writes
+ * it to the inactive OTA slot (firmware.bin) or the LittleFS partition
+ * (littlefs.bin from "pio run -t buildfs", e.g. a new stream.html). The
+ * image is never held in RAM.
+ *
+ * While an image is received the HTTP task (async_tcp, above the Arduino
+ * loop) drops to OTA_UPLOAD_TASK_PRIORITY, so the flash erases and writes
+ * share the CPU with BoatData processing instead of preempting it; the
+ * upload just takes longer. Only one upload runs at a time (409 for a
+ * second one). On success, or when a failed filesystem image already
+ * overwrote the old one, the device restarts after OTA_REBOOT_DELAY_MS.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef OTA_WEB_SERVER_H
+#define OTA_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config.h"
+#include "../hal/interfaces/IFirmwareUpdater.h"
+#include "../utils/OtaUpdate.h"
+#include "../utils/WebSocketLogger.h"
+
+/**
+ * @brief Web server routes for OTA updates
+ */
+class OtaWebServer {
+private:
+    OtaSession session;
+    IFirmwareUpdater* updater;
+    WebSocketLogger* logger;
+    AsyncWebServerRequest* owner;   ///< Request whose image is being written (nullptr = none)
+    TaskHandle_t uploadTask;
+    UBaseType_t savedPriority;
+    bool priorityLowered;
+    bool rebootScheduled;
+    unsigned long rebootTime;
+
+    /**
+     * @brief Upload chunk of POST /update (HTTP task)
+     *
+     * The first chunk starts the session with the target and md5 query
+     * parameters; the last one verifies and activates the image.
+     */
+    void handleUpload(AsyncWebServerRequest* request, const String& filename,
+                      size_t index, uint8_t* data, size_t len, bool final);
+
+    /**
+     * @brief Handle the end of POST /update
+     *
+     * 200 {"status":"installed","target":"firmware","bytes":1048576,"duration_ms":21400,"reboot_ms":1000}
+     * 400/409/500 {"status":"error","error":"hash_mismatch","detail":"MD5 Check Failed","reboot":false}
+     *
+     * detail is the flash writer's message (null for a refused request or
+     * image); reboot is true when a failed filesystem image restarts the device.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleUploadComplete(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle GET /update
+     *
+     * {"session":{"state":"receiving","target":"firmware","bytes":524288,...},"reboot_pending":false}
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetStatus(AsyncWebServerRequest* request);
+
+    bool startUpload(AsyncWebServerRequest* request);
+    void endUpload();
+    void restorePriority();
+    static int statusCode(OtaError error);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param firmwareUpdater Flash writer (ESP32FirmwareUpdater)
+     * @param webSocketLogger Logger for UPDATE_* events
+     */
+    OtaWebServer(IFirmwareUpdater* firmwareUpdater, WebSocketLogger* webSocketLogger);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+
+    /**
+     * @brief An update needs the restart now (main loop)
+     */
+    bool shouldReboot() const;
+};
+
+#endif // OTA_WEB_SERVER_H
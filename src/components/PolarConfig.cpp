@@ -0,0 +1,47 @@
+/**
+ * @file PolarConfig.cpp
+ * @brief Implementation of the polar file loader
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "PolarConfig.h"
+
+bool PolarConfig::load(const char* path, PolarTable& polar, WebSocketLogger* logger) {
+    polar.clear();
+    if (logger == nullptr || !LittleFS.exists(path)) {
+        return false;  // No polar - targets stay NaN
+    }
+
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+        return false;
+    }
+
+    char line[POLAR_LINE_MAX];
+    uint16_t lineNumber = 0;
+    bool ok = true;
+    while (ok && file.available()) {
+        size_t len = file.readBytesUntil('\n', line, sizeof(line) - 1);
+        line[len] = '\0';
+        lineNumber++;
+        ok = polar.parseLine(line);
+    }
+    file.close();
+
+    if (ok) {
+        ok = polar.finalize();
+        lineNumber = 0;  // Whole-table error
+    }
+    if (!ok) {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::POLAR, LogEvent::POLAR_INVALID,
+            "{\"path\":\"%s\",\"line\":%u,\"reason\":\"%s\"}", path, (unsigned)lineNumber, polar.error());
+        polar.clear();
+        return false;
+    }
+
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::POLAR, LogEvent::POLAR_LOADED,
+        "{\"path\":\"%s\",\"tws\":%u,\"twa\":%u}", path, (unsigned)polar.twsCount(), (unsigned)polar.twaCount());
+    return true;
+}
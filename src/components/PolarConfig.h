@@ -0,0 +1,47 @@
+/**
+ * @file PolarConfig.h
+ * @brief Loads the boat polar (POLAR_FILE) from LittleFS into a PolarTable
+ *
+ * The file is read line by line into a POLAR_LINE_MAX stack buffer and
+ * parsed by PolarTable::parseLine() (format in PolarTable.h), so loading
+ * needs no heap.
+ *
+ * A missing file leaves the table unloaded: the polar outputs of
+ * DerivedData stay NaN. An invalid file is logged (POLAR_INVALID) and
+ * ignored as a whole.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef POLAR_CONFIG_H
+#define POLAR_CONFIG_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "../utils/PolarTable.h"
+#include "../utils/WebSocketLogger.h"
+
+/**
+ * @brief Polar file loader
+ *
+ * Usage pattern (at boot, before the first calculation cycle):
+ * @code
+ * if (PolarConfig::load(POLAR_FILE, polarTable, &logger)) {
+ *     calculationEngine->setPolar(&polarTable);
+ * }
+ * @endcode
+ */
+class PolarConfig {
+public:
+    /**
+     * @brief Parse @p path into @p polar
+     *
+     * Logs POLAR_LOADED (INFO) or POLAR_INVALID (ERROR).
+     *
+     * @return true if @p polar is loaded, false if the file is missing or invalid
+     */
+    static bool load(const char* path, PolarTable& polar, WebSocketLogger* logger);
+};
+
+#endif // POLAR_CONFIG_H
@@ -0,0 +1,51 @@
+/**
+ * @file ReactionProfilerWebServer.cpp
+ * @brief Implementation of the reaction profile endpoint
+ *
+ * @see ReactionProfilerWebServer.h
+ */
+
+#include "ReactionProfilerWebServer.h"
+#include "../utils/JsonWriter.h"
+
+ReactionProfilerWebServer::ReactionProfilerWebServer(ReactionProfiler* reactionProfiler)
+    : profiler(reactionProfiler) {
+}
+
+void ReactionProfilerWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || profiler == nullptr) {
+        return;
+    }
+
+    // GET /reactions - Cost and lateness of each main-loop reaction
+    server->on("/reactions", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetReactions(request);
+    });
+}
+
+void ReactionProfilerWebServer::handleGetReactions(AsyncWebServerRequest* request) {
+    uint32_t now = millis();
+    uint32_t cpuMhz = ESP.getCpuFreqMHz();
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+
+    response->printf("{\"uptime_ms\":%lu,\"cpu_mhz\":%lu,\"window_ms\":%lu,\"busy_pct\":%.2f,\"reactions\":[",
+        (unsigned long)now, (unsigned long)cpuMhz, (unsigned long)(now - profiler->getWindowStartMs()),
+        profiler->busyPercent(cpuMhz, now));
+
+    uint8_t order[REACTION_PROFILER_MAX_REACTIONS];
+    uint8_t n = profiler->top(order, REACTION_PROFILER_MAX_REACTIONS);
+    for (uint8_t i = 0; i < n; i++) {
+        StaticJsonWriter<256> item;
+        profiler->writeEntry(item, order[i], cpuMhz, now);
+        if (i > 0) {
+            response->print(',');
+        }
+        response->print(item.c_str());
+    }
+    response->print("]}");
+    request->send(response);
+
+    if (request->hasParam("reset") && request->getParam("reset")->value() == "1") {
+        profiler->requestReset();
+    }
+}
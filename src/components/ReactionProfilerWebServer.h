@@ -0,0 +1,68 @@
+/**
+ * @file ReactionProfilerWebServer.h
+ * @brief HTTP endpoint for the per-reaction ReactESP loop profile
+ *
+ * Provides:
+ * - GET /reactions[?reset=1]: execution time and lateness of every
+ *   registered app.onRepeat() reaction, most expensive first; reset=1
+ *   starts a new measurement window after this report
+ *
+ * The response is streamed one reaction at a time.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef REACTION_PROFILER_WEB_SERVER_H
+#define REACTION_PROFILER_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../utils/ReactionProfiler.h"
+
+/**
+ * @brief Web server route for the reaction profile
+ */
+class ReactionProfilerWebServer {
+private:
+    ReactionProfiler* profiler;
+
+    /**
+     * @brief Handle GET /reactions
+     *
+     * Returns:
+     * {
+     *   "uptime_ms": 123456, "cpu_mhz": 240, "window_ms": 60000, "busy_pct": 3.12,
+     *   "reactions": [
+     *     {"name": "boatdata_tick", "interval_ms": 100, "calls": 600, "total_us": 1201,
+     *      "avg_us": 2, "max_us": 40, "last_us": 2, "cpu_pct": 2.00,
+     *      "late_avg_ms": 0, "late_max_ms": 7},
+     *     ...
+     *   ]
+     * }
+     *
+     * busy_pct is the share of the window spent in profiled reactions; the
+     * rest is the ReactESP scheduler, the log drain of unprofiled work and idle.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetReactions(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param reactionProfiler Profiler filled by the main loop
+     */
+    explicit ReactionProfilerWebServer(ReactionProfiler* reactionProfiler);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // REACTION_PROFILER_WEB_SERVER_H
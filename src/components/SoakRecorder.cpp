@@ -0,0 +1,121 @@
+/**
+ * @file SoakRecorder.cpp
+ * @brief Implementation of the soak CSV recorder
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "SoakRecorder.h"
+#include <LittleFS.h>
+#include "../utils/OtaUpdate.h"
+
+namespace {
+
+/// Longest CSV line (header: ~150 characters; row: 12 x 10 digits + commas)
+constexpr size_t SOAK_LINE_BYTES = 192;
+
+}  // namespace
+
+SoakRecorder::SoakRecorder()
+    : logger_(nullptr), bytes_(0), rows_(0), rotations_(0), writeErrors_(0) {
+}
+
+bool SoakRecorder::begin(WebSocketLogger* logger) {
+    if (logger == nullptr || logger_ != nullptr) {
+        return false;
+    }
+    logger_ = logger;
+
+    // A reboot continues the file: the uptime_s column restarting marks it
+    if (LittleFS.exists(SOAK_CSV_PATH)) {
+        File file = LittleFS.open(SOAK_CSV_PATH, "r");
+        bytes_ = file ? static_cast<uint32_t>(file.size()) : 0;
+    }
+
+    logger_->broadcastLogf(LogLevel::INFO, LogComponent::PERFORMANCE, LogEvent::SOAK_STARTED,
+        "{\"path\":\"%s\",\"bytes\":%lu,\"interval_ms\":%lu,\"window\":%u,"
+        "\"replay_speed\":%u,\"n2k_load_pct\":%u}",
+        SOAK_CSV_PATH, (unsigned long)bytes_, (unsigned long)SOAK_SAMPLE_INTERVAL_MS,
+        (unsigned)SoakMonitor::WINDOW, (unsigned)SOAK_REPLAY_SPEED, (unsigned)SOAK_N2K_LOAD_PCT);
+    return true;
+}
+
+void SoakRecorder::record(const SoakSample& sample) {
+    if (logger_ == nullptr) {
+        return;
+    }
+    reportTrends(monitor_.add(sample));
+
+    char line[SOAK_LINE_BYTES];
+    size_t length = SoakMonitor::writeCsvRow(sample, line, sizeof(line));
+    if (length == 0 || OtaFilesystemLocked()) {
+        writeErrors_++;  // Filesystem image being installed: the row is lost
+        return;
+    }
+    if (bytes_ > 0 && bytes_ + length > SOAK_CSV_MAX_BYTES) {
+        rotate();
+    }
+    if (!append(line, length)) {
+        writeErrors_++;
+        logger_->broadcastLogf(LogLevel::WARN, LogComponent::PERFORMANCE, LogEvent::SOAK_WRITE_FAILED,
+            "{\"path\":\"%s\",\"errors\":%lu}", SOAK_CSV_PATH, (unsigned long)writeErrors_);
+        return;
+    }
+    rows_++;
+}
+
+bool SoakRecorder::append(const char* text, size_t length) {
+    File file = LittleFS.open(SOAK_CSV_PATH, "a");
+    if (!file) {
+        return false;
+    }
+    if (bytes_ == 0) {
+        char header[SOAK_LINE_BYTES];
+        size_t headerLength = SoakMonitor::writeCsvHeader(header, sizeof(header));
+        if (file.write(reinterpret_cast<const uint8_t*>(header), headerLength) != headerLength) {
+            file.close();
+            return false;
+        }
+        bytes_ += headerLength;
+    }
+    size_t written = file.write(reinterpret_cast<const uint8_t*>(text), length);
+    bytes_ += written;
+    file.close();
+    return written == length;
+}
+
+void SoakRecorder::rotate() {
+    LittleFS.remove(SOAK_CSV_PREVIOUS_PATH);
+    if (!LittleFS.rename(SOAK_CSV_PATH, SOAK_CSV_PREVIOUS_PATH)) {
+        LittleFS.remove(SOAK_CSV_PATH);  // Never grow past the limit
+    }
+    bytes_ = 0;
+    rotations_++;
+}
+
+void SoakRecorder::reportTrends(uint16_t raised) {
+    for (uint8_t c = 0; c < SoakSample::COLUMNS && raised != 0; c++) {
+        if ((raised & (1u << c)) == 0) {
+            continue;
+        }
+        SoakColumn column = static_cast<SoakColumn>(c);
+        logger_->broadcastLogf(LogLevel::WARN, LogComponent::PERFORMANCE, LogEvent::SOAK_TREND,
+            "{\"column\":\"%s\",\"change\":%lld,\"tau\":%.2f,\"window_s\":%lu,\"uptime_s\":%lu}",
+            SoakMonitor::columnName(column), (long long)monitor_.getChange(column),
+            monitor_.getTauPct(column) / 100.0,
+            (unsigned long)(SoakMonitor::WINDOW * (SOAK_SAMPLE_INTERVAL_MS / 1000UL)),
+            (unsigned long)(monitor_.last() != nullptr ? monitor_.last()->uptimeS : 0));
+    }
+}
+
+void SoakRecorder::writeJson(JsonWriter& json) const {
+    json.beginObject()
+        .add("path", SOAK_CSV_PATH)
+        .add("bytes", (unsigned long)bytes_)
+        .add("rows", (unsigned long)rows_)
+        .add("rotations", (unsigned long)rotations_)
+        .add("write_errors", (unsigned long)writeErrors_);
+    monitor_.writeJson(json, "trends");
+    json.endObject();
+}
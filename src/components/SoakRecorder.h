@@ -0,0 +1,98 @@
+/**
+ * @file SoakRecorder.h
+ * @brief Soak runs: one metric row per minute to a LittleFS CSV, with trend flags
+ *
+ * The bugs of long runs (heap leaks, fragmentation, drop counters that keep
+ * growing) need days of operation to show. In a soak build (SOAK_ENABLED,
+ * env esp32dev_soak) the main loop calls record() every
+ * SOAK_SAMPLE_INTERVAL_MS with a SoakSample (heap, largest block, loop
+ * percentiles, drop counters). Each sample:
+ * - is appended to SOAK_CSV_PATH as one CSV row (header on a new file), so a
+ *   run can be plotted after the fact; before the file would pass
+ *   SOAK_CSV_MAX_BYTES it becomes SOAK_CSV_PREVIOUS_PATH and a new file starts
+ * - goes through SoakMonitor's trend test: a column moving monotonically in
+ *   its bad direction is logged once as WARN SOAK_TREND (and cleared quietly)
+ *
+ * The load is kept running by the soak reaction in main.cpp (bus capture
+ * replayed in a loop at SOAK_REPLAY_SPEED, and/or the synthetic NMEA 2000
+ * load at SOAK_N2K_LOAD_PCT).
+ *
+ * A row is ~90 bytes, written once a minute on the main loop
+ * (open/append/close); the soak's own loop_max_us includes it. Rows are
+ * skipped and counted while a filesystem image is being installed.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed sample window, bounded CSV files
+ * - Principle V (Observability): GET /soak, WARN SOAK_TREND while running
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef SOAK_RECORDER_H
+#define SOAK_RECORDER_H
+
+#include <Arduino.h>
+#include "../config.h"
+#include "../utils/JsonWriter.h"
+#include "../utils/SoakMonitor.h"
+#include "../utils/WebSocketLogger.h"
+
+/**
+ * @class SoakRecorder
+ * @brief CSV writer and trend reporter of the soak samples
+ *
+ * Usage pattern:
+ * @code
+ * soakRecorder.begin(&logger);
+ * app.onRepeat(SOAK_SAMPLE_INTERVAL_MS, []() {
+ *     SoakSample sample = {};
+ *     ... fill ...
+ *     soakRecorder.record(sample);
+ * });
+ * @endcode
+ */
+class SoakRecorder {
+public:
+    SoakRecorder();
+
+    /**
+     * @brief Start a run: continue SOAK_CSV_PATH or create it with a header
+     * @return false on null logger or if already started
+     */
+    bool begin(WebSocketLogger* logger);
+
+    /// Append @p sample to the CSV and test it for trends (main loop)
+    void record(const SoakSample& sample);
+
+    const SoakMonitor& getMonitor() const { return monitor_; }
+    uint32_t getRows() const { return rows_; }
+    uint32_t getRotations() const { return rotations_; }
+    uint32_t getWriteErrors() const { return writeErrors_; }
+
+    /**
+     * @brief Run state
+     *
+     * {"path":"/soak.csv","bytes":8190,"rows":90,"rotations":0,"write_errors":0,
+     *  "trends":{...SoakMonitor::writeJson()...}}
+     */
+    void writeJson(JsonWriter& json) const;
+
+private:
+    WebSocketLogger* logger_;
+    SoakMonitor monitor_;
+    uint32_t bytes_;         ///< Size of SOAK_CSV_PATH
+    uint32_t rows_;          ///< Written this boot
+    uint32_t rotations_;
+    uint32_t writeErrors_;
+
+    /// Append @p text to SOAK_CSV_PATH (header first on an empty file)
+    bool append(const char* text, size_t length);
+
+    /// Move SOAK_CSV_PATH to SOAK_CSV_PREVIOUS_PATH
+    void rotate();
+
+    void reportTrends(uint16_t raised);
+};
+
+#endif // SOAK_RECORDER_H
@@ -0,0 +1,53 @@
+/**
+ * @file SoakWebServer.cpp
+ * @brief Implementation of the soak run endpoints
+ *
+ * @see SoakWebServer.h
+ */
+
+#include "SoakWebServer.h"
+#include <LittleFS.h>
+#include "../utils/JsonWriter.h"
+#include "../utils/OtaUpdate.h"
+
+SoakWebServer::SoakWebServer(const SoakRecorder* soakRecorder)
+    : recorder(soakRecorder) {
+}
+
+void SoakWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || recorder == nullptr) {
+        return;
+    }
+
+    // GET /soak - CSV state and trend flags
+    server->on("/soak", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        StaticJsonWriter<2048> json;  // ~100 bytes per column
+        recorder->writeJson(json);
+        request->send(200, "application/json", json.c_str());
+    });
+
+    // GET /soak/csv[?previous=1] - Download the metric rows
+    server->on("/soak/csv", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetCsv(request);
+    });
+}
+
+void SoakWebServer::handleGetCsv(AsyncWebServerRequest* request) {
+    const char* path = SOAK_CSV_PATH;
+    if (request->hasParam("previous") && request->getParam("previous")->value() == "1") {
+        path = SOAK_CSV_PREVIOUS_PATH;
+    }
+
+    StaticJsonWriter<96> json;
+    if (OtaFilesystemLocked()) {
+        json.beginObject().add("status", "filesystem update").endObject();
+        request->send(409, "application/json", json.c_str());
+        return;
+    }
+    if (!LittleFS.exists(path)) {
+        json.beginObject().add("status", "no file").endObject();
+        request->send(404, "application/json", json.c_str());
+        return;
+    }
+    request->send(LittleFS, path, "text/csv", true);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file SoakWebServer.h
+ * @brief HTTP endpoints of a soak run
+ *
+ * Provides:
+ * - GET /soak: CSV state and the trend test of every column (SoakRecorder::writeJson)
+ * - GET /soak/csv: Download the metric CSV (?previous=1: the rotated-out file)
+ *
+ * Only registered in soak builds (SOAK_ENABLED).
+ *
+ * @version 1.0.0
+ */
+
+#ifndef SOAK_WEB_SERVER_H
+#define SOAK_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "SoakRecorder.h"
+
+/**
+ * @brief Web server routes of the soak recorder
+ */
+class SoakWebServer {
+private:
+    const SoakRecorder* recorder;
+
+    /**
+     * @brief Handle GET /soak/csv
+     *
+     * 404 if the file does not exist (yet), 409 while a filesystem image is installed.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetCsv(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param soakRecorder Recorder whose state and files are served
+     */
+    explicit SoakWebServer(const SoakRecorder* soakRecorder);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // SOAK_WEB_SERVER_H
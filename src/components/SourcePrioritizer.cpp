@@ -6,14 +6,30 @@
  */
 
 #include "SourcePrioritizer.h"
+#include <math.h>
+
+namespace {
+
+/**
+ * @brief Milliseconds from @p since to @p now across the 49.7-day millis() wrap
+ *
+ * 32-bit like millis() on every build (unsigned long is 64 bits on the host);
+ * negative when @p now is older than @p since.
+ */
+inline int32_t elapsedMs(unsigned long now, unsigned long since) {
+    return static_cast<int32_t>(static_cast<uint32_t>(now) - static_cast<uint32_t>(since));
+}
+
+}  // namespace
 
 SourcePrioritizer::SourcePrioritizer() {
     // Initialize manager structure
     memset(&manager, 0, sizeof(SourceManager));
-    manager.activeGpsSourceIndex = -1;
-    manager.activeCompassSourceIndex = -1;
-    manager.gpsSourceCount = 0;
-    manager.compassSourceCount = 0;
+    for (int t = 0; t < SENSOR_TYPE_COUNT; t++) {
+        manager.types[t].activeIndex = -1;
+    }
+    memset(manager.lookupSlots, -1, sizeof(manager.lookupSlots));
+    manager.sourceCount = 0;
     manager.lastPriorityUpdate = 0;
 }
 
@@ -22,129 +38,201 @@ SourcePrioritizer::SourcePrioritizer() {
 // =============================================================================
 
 int SourcePrioritizer::registerSource(const char* sourceId, SensorType type, ProtocolType protocol) {
-    int count, activeIndex;
-    SensorSource* sources = getSourceArray(type, count, activeIndex);
+    if (static_cast<int>(type) >= SENSOR_TYPE_COUNT) {
+        return -1;
+    }
+
+    // Registering the same source again keeps its index and history
+    int existing = findSource(sourceId, type);
+    if (existing >= 0) {
+        return existing;
+    }
 
-    // Check if array is full
-    if (count >= MAX_GPS_SOURCES) {
+    // Check if the table or the type's list is full
+    SourceTypeList& list = typeList(type);
+    if (manager.sourceCount >= MAX_SENSOR_SOURCES || list.count >= MAX_SOURCES_PER_TYPE) {
         return -1;  // Registration failed
     }
 
     // Get next available index
-    int index = count;
+    int index = manager.sourceCount;
+    SensorSource& source = manager.sources[index];
 
     // Initialize source
-    strncpy(sources[index].sourceId, sourceId, 15);
-    sources[index].sourceId[15] = '\0';
-    sources[index].sensorType = type;
-    sources[index].protocolType = protocol;
-    sources[index].updateFrequency = 0.0;
-    sources[index].priority = -1;  // Automatic prioritization
-    sources[index].manualOverride = false;
-    sources[index].active = false;
-    sources[index].available = false;
-    sources[index].lastUpdateTime = 0;
-    sources[index].updateCount = 0;
-    sources[index].rejectedCount = 0;
-    sources[index].avgUpdateInterval = 0.0;
-
-    // Increment count
-    if (type == SensorType::GPS) {
-        manager.gpsSourceCount++;
-    } else {
-        manager.compassSourceCount++;
+    strncpy(source.sourceId, sourceId, 15);
+    source.sourceId[15] = '\0';
+    source.sensorType = type;
+    source.protocolType = protocol;
+    source.updateFrequency = 0.0;
+    source.priority = -1;  // Automatic prioritization
+    source.manualOverride = false;
+    source.active = false;
+    source.available = false;
+    source.lastUpdateTime = 0;
+    source.updateCount = 0;
+    source.rejectedCount = 0;
+    source.droppedCount = 0;
+    source.outlierCount = 0;
+    source.avgUpdateInterval = 0.0;
+    source.intervalJitter = 0.0;
+    source.rejectionRate = 0.0;
+    source.qualityReported = false;
+    source.fixQuality = 0;
+    source.satellites = 0;
+    source.hdop = 0.0;
+    source.quality = 1.0;
+    source.score = 0.0;
+
+    // Hash slot (linear probing; the table holds fewer sources than slots)
+    uint32_t hash = hashId(source.sourceId, type);
+    manager.idHashes[index] = hash;
+    uint32_t slot = hash & (SOURCE_LOOKUP_SLOTS - 1);
+    while (manager.lookupSlots[slot] >= 0) {
+        slot = (slot + 1) & (SOURCE_LOOKUP_SLOTS - 1);
     }
+    manager.lookupSlots[slot] = static_cast<int8_t>(index);
+
+    list.members[list.count++] = static_cast<int8_t>(index);
+    manager.sourceCount++;
 
     return index;
 }
 
+int SourcePrioritizer::findSource(const char* sourceId, SensorType type) {
+    if (sourceId == nullptr) {
+        return -1;
+    }
+
+    uint32_t hash = hashId(sourceId, type);
+    uint32_t slot = hash & (SOURCE_LOOKUP_SLOTS - 1);
+    for (int probe = 0; probe < SOURCE_LOOKUP_SLOTS; probe++) {
+        int index = manager.lookupSlots[slot];
+        if (index < 0) {
+            return -1;  // Empty slot ends the probe sequence
+        }
+        const SensorSource& source = manager.sources[index];
+        if (manager.idHashes[index] == hash && source.sensorType == type &&
+            strncmp(source.sourceId, sourceId, 15) == 0) {
+            return index;
+        }
+        slot = (slot + 1) & (SOURCE_LOOKUP_SLOTS - 1);
+    }
+    return -1;
+}
+
 void SourcePrioritizer::updateSourceTimestamp(int sourceIndex, unsigned long timestamp) {
-    // Determine which array this source is in
-    if (sourceIndex < manager.gpsSourceCount) {
-        // GPS source
-        manager.gpsSources[sourceIndex].lastUpdateTime = timestamp;
-        manager.gpsSources[sourceIndex].updateCount++;
-        manager.gpsSources[sourceIndex].available = true;
-    } else if (sourceIndex < manager.gpsSourceCount + manager.compassSourceCount) {
-        // Compass source (offset by GPS count)
-        int compassIndex = sourceIndex - manager.gpsSourceCount;
-        manager.compassSources[compassIndex].lastUpdateTime = timestamp;
-        manager.compassSources[compassIndex].updateCount++;
-        manager.compassSources[compassIndex].available = true;
+    SensorSource* source = resolve(sourceIndex);
+    if (source == nullptr) {
+        return;
     }
+
+    // Running average of the interval between updates and of its deviation (first update has none)
+    int32_t sinceLast = elapsedMs(timestamp, source->lastUpdateTime);
+    if (source->updateCount > 0 && sinceLast >= 0) {
+        double interval = (double)sinceLast;
+        if (source->avgUpdateInterval <= 0.0) {
+            source->avgUpdateInterval = interval;
+        } else {
+            double deviation = fabs(interval - source->avgUpdateInterval);
+            source->intervalJitter += (deviation - source->intervalJitter) / (1 << INTERVAL_AVERAGE_SHIFT);
+            source->avgUpdateInterval += (interval - source->avgUpdateInterval) / (1 << INTERVAL_AVERAGE_SHIFT);
+        }
+        source->updateFrequency = source->avgUpdateInterval > 0.0 ? 1000.0 / source->avgUpdateInterval : 0.0;
+    }
+
+    // Every update counts as accepted here; recordRejection(INVALID) takes it back
+    source->rejectionRate -= source->rejectionRate / (1 << REJECTION_AVERAGE_SHIFT);
+
+    source->lastUpdateTime = timestamp;
+    source->updateCount++;
+    source->available = true;
 }
 
-int SourcePrioritizer::getActiveSource(SensorType type) {
-    if (type == SensorType::GPS) {
-        return manager.activeGpsSourceIndex;
+void SourcePrioritizer::recordRejection(int sourceIndex, SourceRejection reason) {
+    SensorSource* source = resolve(sourceIndex);
+    if (source == nullptr) {
+        return;
+    }
+
+    if (reason == SourceRejection::INACTIVE) {
+        source->droppedCount++;
     } else {
-        return manager.activeCompassSourceIndex;
+        if (reason == SourceRejection::OUTLIER) {
+            source->outlierCount++;
+        }
+        source->rejectedCount++;
+        source->rejectionRate += 1.0 / (1 << REJECTION_AVERAGE_SHIFT);
+        if (source->rejectionRate > 1.0) {
+            source->rejectionRate = 1.0;
+        }
+    }
+}
+
+void SourcePrioritizer::updateSourceQuality(int sourceIndex, uint8_t fixQuality, uint8_t satellites, double hdop) {
+    SensorSource* source = resolve(sourceIndex);
+    if (source == nullptr) {
+        return;
+    }
+
+    source->qualityReported = true;
+    source->fixQuality = fixQuality;
+    source->satellites = satellites;
+    source->hdop = hdop;
+}
+
+int SourcePrioritizer::getActiveSource(SensorType type) {
+    if (static_cast<int>(type) >= SENSOR_TYPE_COUNT) {
+        return -1;
     }
+    return typeList(type).activeIndex;
 }
 
 void SourcePrioritizer::setManualOverride(int sourceIndex) {
-    // Determine sensor type from source index
-    if (sourceIndex < manager.gpsSourceCount) {
-        // GPS source
-        manager.gpsSources[sourceIndex].manualOverride = true;
-        manager.gpsSources[sourceIndex].active = true;
-        manager.activeGpsSourceIndex = sourceIndex;
-
-        // Deactivate other GPS sources
-        for (int i = 0; i < manager.gpsSourceCount; i++) {
-            if (i != sourceIndex) {
-                manager.gpsSources[i].active = false;
-            }
-        }
-    } else if (sourceIndex < manager.gpsSourceCount + manager.compassSourceCount) {
-        // Compass source
-        int compassIndex = sourceIndex - manager.gpsSourceCount;
-        manager.compassSources[compassIndex].manualOverride = true;
-        manager.compassSources[compassIndex].active = true;
-        manager.activeCompassSourceIndex = compassIndex;
-
-        // Deactivate other compass sources
-        for (int i = 0; i < manager.compassSourceCount; i++) {
-            if (i != compassIndex) {
-                manager.compassSources[i].active = false;
-            }
+    SensorSource* source = resolve(sourceIndex);
+    if (source == nullptr) {
+        return;
+    }
+
+    SensorType type = source->sensorType;
+    source->manualOverride = true;
+    source->active = true;
+    setActiveIndex(type, sourceIndex, millis());
+
+    // Deactivate other sources of the same type
+    const SourceTypeList& list = typeList(type);
+    for (int i = 0; i < list.count; i++) {
+        if (list.members[i] != sourceIndex) {
+            manager.sources[list.members[i]].active = false;
         }
     }
 }
 
 void SourcePrioritizer::clearManualOverride(SensorType type) {
-    int count, activeIndex;
-    SensorSource* sources = getSourceArray(type, count, activeIndex);
+    if (static_cast<int>(type) >= SENSOR_TYPE_COUNT) {
+        return;
+    }
 
     // Clear manual override flag for all sources of this type
-    for (int i = 0; i < count; i++) {
-        sources[i].manualOverride = false;
+    const SourceTypeList& list = typeList(type);
+    for (int i = 0; i < list.count; i++) {
+        manager.sources[list.members[i]].manualOverride = false;
     }
 }
 
 bool SourcePrioritizer::isSourceStale(int sourceIndex, unsigned long currentTime) {
-    if (sourceIndex < manager.gpsSourceCount) {
-        // GPS source
-        unsigned long lastUpdate = manager.gpsSources[sourceIndex].lastUpdateTime;
-        if (lastUpdate == 0) return true;  // Never updated
-        return (currentTime - lastUpdate) > STALE_THRESHOLD_MS;
-    } else if (sourceIndex < manager.gpsSourceCount + manager.compassSourceCount) {
-        // Compass source
-        int compassIndex = sourceIndex - manager.gpsSourceCount;
-        unsigned long lastUpdate = manager.compassSources[compassIndex].lastUpdateTime;
-        if (lastUpdate == 0) return true;  // Never updated
-        return (currentTime - lastUpdate) > STALE_THRESHOLD_MS;
-    }
-
-    return true;  // Unknown source is stale
+    SensorSource* source = resolve(sourceIndex);
+    if (source == nullptr) {
+        return true;  // Unknown source is stale
+    }
+
+    if (source->updateCount == 0) return true;  // Never updated (0 is a valid millis())
+    return elapsedMs(currentTime, source->lastUpdateTime) > (int32_t)STALE_THRESHOLD_MS;
 }
 
 SensorSource SourcePrioritizer::getSource(int sourceIndex) {
-    if (sourceIndex < manager.gpsSourceCount) {
-        return manager.gpsSources[sourceIndex];
-    } else if (sourceIndex < manager.gpsSourceCount + manager.compassSourceCount) {
-        int compassIndex = sourceIndex - manager.gpsSourceCount;
-        return manager.compassSources[compassIndex];
+    SensorSource* source = resolve(sourceIndex);
+    if (source != nullptr) {
+        return *source;
     }
 
     // Return empty source if invalid index
@@ -154,43 +242,30 @@ SensorSource SourcePrioritizer::getSource(int sourceIndex) {
 }
 
 void SourcePrioritizer::updatePriorities() {
-    unsigned long currentTime = millis();
-
-    // Update GPS priorities
-    selectBestSource(SensorType::GPS);
+    updatePriorities(millis());
+}
 
-    // Update compass priorities
-    selectBestSource(SensorType::COMPASS);
+void SourcePrioritizer::updatePriorities(unsigned long currentTime) {
+    for (int t = 0; t < SENSOR_TYPE_COUNT; t++) {
+        if (manager.types[t].count > 0) {
+            selectBestSource(static_cast<SensorType>(t), currentTime);
+        }
+    }
 
     manager.lastPriorityUpdate = currentTime;
 }
 
 void SourcePrioritizer::checkStale(unsigned long currentTime) {
-    // Check GPS sources
-    for (int i = 0; i < manager.gpsSourceCount; i++) {
+    for (int i = 0; i < manager.sourceCount; i++) {
+        SensorSource& source = manager.sources[i];
         if (isSourceStale(i, currentTime)) {
-            manager.gpsSources[i].available = false;
-
-            // If this was the active source, trigger failover
-            if (manager.gpsSources[i].active) {
-                manager.gpsSources[i].active = false;
-                manager.activeGpsSourceIndex = -1;
-                selectBestSource(SensorType::GPS);  // Select next best
-            }
-        }
-    }
-
-    // Check compass sources
-    for (int i = 0; i < manager.compassSourceCount; i++) {
-        int globalIndex = i + manager.gpsSourceCount;
-        if (isSourceStale(globalIndex, currentTime)) {
-            manager.compassSources[i].available = false;
+            source.available = false;
 
             // If this was the active source, trigger failover
-            if (manager.compassSources[i].active) {
-                manager.compassSources[i].active = false;
-                manager.activeCompassSourceIndex = -1;
-                selectBestSource(SensorType::COMPASS);  // Select next best
+            if (source.active) {
+                source.active = false;
+                typeList(source.sensorType).activeIndex = -1;
+                selectBestSource(source.sensorType, currentTime);  // Select next best
             }
         }
     }
@@ -200,87 +275,120 @@ void SourcePrioritizer::checkStale(unsigned long currentTime) {
 // PRIVATE HELPER METHODS
 // =============================================================================
 
-SensorSource* SourcePrioritizer::getSourceArray(SensorType type, int& outCount, int& outActiveIndex) {
-    if (type == SensorType::GPS) {
-        outCount = manager.gpsSourceCount;
-        outActiveIndex = manager.activeGpsSourceIndex;
-        return manager.gpsSources;
-    } else {
-        outCount = manager.compassSourceCount;
-        outActiveIndex = manager.activeCompassSourceIndex;
-        return manager.compassSources;
+SensorSource* SourcePrioritizer::resolve(int sourceIndex) {
+    if (sourceIndex >= 0 && sourceIndex < manager.sourceCount) {
+        return &manager.sources[sourceIndex];
     }
+    return nullptr;
 }
 
-void SourcePrioritizer::setActiveIndex(SensorType type, int index) {
-    if (type == SensorType::GPS) {
-        manager.activeGpsSourceIndex = index;
-    } else {
-        manager.activeCompassSourceIndex = index;
+SourceTypeList& SourcePrioritizer::typeList(SensorType type) {
+    return manager.types[static_cast<int>(type)];
+}
+
+uint32_t SourcePrioritizer::hashId(const char* sourceId, SensorType type) {
+    uint32_t hash = 2166136261UL;
+    for (int i = 0; i < 15 && sourceId[i] != '\0'; i++) {
+        hash = (hash ^ static_cast<uint8_t>(sourceId[i])) * 16777619UL;
     }
+    return (hash ^ static_cast<uint8_t>(type)) * 16777619UL;
 }
 
-void SourcePrioritizer::calculateFrequency(SensorSource* source, unsigned long currentTime) {
-    if (source->updateCount == 0 || source->lastUpdateTime == 0) {
-        source->updateFrequency = 0.0;
-        return;
+void SourcePrioritizer::setActiveIndex(SensorType type, int index, unsigned long currentTime) {
+    SourceTypeList& list = typeList(type);
+    if (index != list.activeIndex) {
+        list.activeSince = currentTime;
     }
+    list.activeIndex = static_cast<int8_t>(index);
+}
 
-    // Calculate elapsed time since first update (approximate)
-    // Note: This is simplified - real implementation would track firstUpdateTime
-    unsigned long elapsed = currentTime - source->lastUpdateTime + 10000;  // Approximate 10s window
+double SourcePrioritizer::fixFactor(uint8_t fixQuality) {
+    switch (fixQuality) {
+        case 0: return 0.0;    // No fix
+        case 1: return 0.7;    // GNSS
+        case 2: return 0.85;   // DGNSS
+        case 3: return 0.9;    // Precise GNSS / PPS
+        case 4: return 1.0;    // RTK fixed
+        case 5: return 0.95;   // RTK float
+        case 6: return 0.2;    // Dead reckoning
+        default: return 0.1;   // Manual, simulator, unknown
+    }
+}
+
+double SourcePrioritizer::qualityFactor(const SensorSource& source) {
+    double quality = 1.0 - source.rejectionRate;
+    if (source.avgUpdateInterval > 0.0) {
+        quality /= 1.0 + source.intervalJitter / source.avgUpdateInterval;
+    }
+    if (source.qualityReported) {
+        quality *= fixFactor(source.fixQuality);
+        if (source.hdop > SOURCE_GOOD_HDOP) {
+            quality *= SOURCE_GOOD_HDOP / source.hdop;
+        }
+        if (source.satellites > 0 && source.satellites < SOURCE_GOOD_SATELLITES) {
+            quality *= (double)source.satellites / SOURCE_GOOD_SATELLITES;
+        }
+    }
+    return quality < 0.0 ? 0.0 : quality;
+}
 
-    if (elapsed > 0) {
-        source->updateFrequency = (double)source->updateCount / (elapsed / 1000.0);
+void SourcePrioritizer::calculateScore(SensorSource* source, unsigned long currentTime) {
+    double interval = source->avgUpdateInterval;
+    int32_t sinceLast = elapsedMs(currentTime, source->lastUpdateTime);
+    if (interval > 0.0 && source->updateCount > 0 && (double)sinceLast > interval) {
+        interval = (double)sinceLast;  // Late: the rate decays until stale
     }
+    source->updateFrequency = interval > 0.0 ? 1000.0 / interval : 0.0;
+    source->quality = qualityFactor(*source);
+    source->score = source->updateFrequency * source->quality;
 }
 
-void SourcePrioritizer::selectBestSource(SensorType type) {
-    int count, activeIndex;
-    SensorSource* sources = getSourceArray(type, count, activeIndex);
+void SourcePrioritizer::selectBestSource(SensorType type, unsigned long currentTime) {
+    SourceTypeList& list = typeList(type);
+    SensorSource* sources = manager.sources;
 
-    if (count == 0) {
-        setActiveIndex(type, -1);
+    if (list.count == 0) {
+        setActiveIndex(type, -1, currentTime);
         return;
     }
 
     // Check for manual override first
-    for (int i = 0; i < count; i++) {
-        if (sources[i].manualOverride && sources[i].available) {
+    for (int i = 0; i < list.count; i++) {
+        int index = list.members[i];
+        if (sources[index].manualOverride && sources[index].available) {
             // Manual override - force this source active
-            for (int j = 0; j < count; j++) {
-                sources[j].active = (j == i);
+            for (int j = 0; j < list.count; j++) {
+                sources[list.members[j]].active = (j == i);
             }
-            setActiveIndex(type, i);
+            setActiveIndex(type, index, currentTime);
             return;
         }
     }
 
-    // Calculate frequencies for all sources
-    unsigned long currentTime = millis();
-    for (int i = 0; i < count; i++) {
-        calculateFrequency(&sources[i], currentTime);
-    }
-
-    // Find highest frequency available source
+    // Score all sources; the best available one wins (the first of equals)
     int bestIndex = -1;
-    double bestFreq = 0.0;
-
-    for (int i = 0; i < count; i++) {
-        if (sources[i].available && sources[i].updateFrequency > bestFreq) {
-            bestFreq = sources[i].updateFrequency;
-            bestIndex = i;
+    for (int i = 0; i < list.count; i++) {
+        int index = list.members[i];
+        calculateScore(&sources[index], currentTime);
+        if (sources[index].available && (bestIndex < 0 || sources[index].score > sources[bestIndex].score)) {
+            bestIndex = index;
         }
     }
 
-    // Set active source
-    if (bestIndex >= 0) {
-        for (int i = 0; i < count; i++) {
-            sources[i].active = (i == bestIndex);
+    // Hysteresis: a running source with a usable fix stays through its dwell
+    // time, and afterwards until a challenger clearly beats it
+    int activeIndex = list.activeIndex;
+    if (bestIndex >= 0 && activeIndex >= 0 && activeIndex != bestIndex &&
+        sources[activeIndex].available && sources[activeIndex].quality > 0.0) {
+        if (elapsedMs(currentTime, list.activeSince) < (int32_t)SOURCE_MIN_DWELL_MS ||
+            sources[bestIndex].score <= sources[activeIndex].score * (1.0 + SOURCE_SWITCH_HYSTERESIS)) {
+            bestIndex = activeIndex;
         }
-        setActiveIndex(type, bestIndex);
-    } else {
-        // No available sources
-        setActiveIndex(type, -1);
     }
+
+    // Set active source (-1: no available sources)
+    for (int i = 0; i < list.count; i++) {
+        sources[list.members[i]].active = (list.members[i] == bestIndex);
+    }
+    setActiveIndex(type, bestIndex, currentTime);
 }
@@ -3,15 +3,30 @@
  * @brief Multi-source data prioritization and failover management
  *
  * This class implements the ISourcePrioritizer interface, managing multiple
- * data sources for GPS and compass sensors with automatic prioritization based
- * on update frequency, manual override capability, and failover on stale detection.
+ * data sources for every sensor type with automatic prioritization based
+ * on update rate and quality, manual override capability, and failover on
+ * stale detection.
  *
  * Features:
- * - Automatic priority: highest update frequency wins
+ * - Automatic priority: highest score wins, score = update rate × quality
+ * - Update rate: EWMA of the inter-arrival intervals (weight 1/8), decaying
+ *   while a source is late
+ * - Quality (0-1): share of recent updates not rejected as invalid, interval
+ *   jitter, and for GPS sources the reported fix quality, HDOP and satellites
+ * - Hysteresis: a running source is kept for SOURCE_MIN_DWELL_MS, then only
+ *   replaced by one scoring SOURCE_SWITCH_HYSTERESIS above it
  * - Manual override: user can force specific source active (volatile, resets on reboot)
- * - Stale detection: 5-second threshold triggers failover
- * - Frequency calculation: tracks update count and timing
- * - Diagnostics: rejection counts, average update intervals
+ * - Stale detection: 5-second threshold triggers failover (no dwell)
+ * - Diagnostics: rejection counts, average update intervals, scores
+ *
+ * Recomputation is O(sources) with no allocation; updates are O(1).
+ *
+ * Sources of all types share one flat table (MAX_SENSOR_SOURCES); the source
+ * index is the table position, stable for the lifetime of the prioritizer, so
+ * sources can be registered at runtime in any order (see N2kSourceTracker).
+ * Each type keeps the list of its members (MAX_SOURCES_PER_TYPE) and its
+ * active source. findSource() and duplicate registration are resolved through
+ * an open-addressing hash of (type, sourceId) in constant time.
  *
  * @see specs/003-boatdata-feature-as/data-model.md lines 167-284
  * @see test/contract/test_isourceprioritizer_contract.cpp
@@ -24,12 +39,13 @@
 
 #include "../hal/interfaces/ISourcePrioritizer.h"
 #include "../types/BoatDataTypes.h"
+#include "../config.h"
 
 /**
  * @brief Source prioritization and failover manager
  *
- * Manages up to 5 GPS sources and 5 compass sources with automatic
- * frequency-based prioritization and failover.
+ * Manages up to 5 sources per sensor type (16 in total) with automatic
+ * score-based prioritization and failover.
  *
  * Usage:
  * @code
@@ -39,8 +55,9 @@
  * int gpsA = prioritizer.registerSource("GPS-NMEA0183", SensorType::GPS, ProtocolType::NMEA0183);
  * int gpsB = prioritizer.registerSource("GPS-NMEA2000", SensorType::GPS, ProtocolType::NMEA2000);
  *
- * // Update timestamps on each data reception
+ * // Update timestamps on each data reception, fix details when a GGA/129029 arrives
  * prioritizer.updateSourceTimestamp(gpsA, millis());
+ * prioritizer.updateSourceQuality(gpsA, 2, 9, 0.9);
  *
  * // Periodic priority recalculation (every 10 seconds)
  * prioritizer.updatePriorities();
@@ -64,7 +81,10 @@ public:
     // =========================================================================
 
     int registerSource(const char* sourceId, SensorType type, ProtocolType protocol) override;
+    int findSource(const char* sourceId, SensorType type) override;
     void updateSourceTimestamp(int sourceIndex, unsigned long timestamp) override;
+    void recordRejection(int sourceIndex, SourceRejection reason) override;
+    void updateSourceQuality(int sourceIndex, uint8_t fixQuality, uint8_t satellites, double hdop) override;
     int getActiveSource(SensorType type) override;
     void setManualOverride(int sourceIndex) override;
     void clearManualOverride(SensorType type) override;
@@ -73,6 +93,11 @@ public:
     void updatePriorities() override;
     void checkStale(unsigned long currentTime) override;
 
+    /**
+     * @brief updatePriorities() at an explicit time (dwell time and late-source decay)
+     */
+    void updatePriorities(unsigned long currentTime);
+
 private:
     // Source management data
     SourceManager manager;
@@ -80,38 +105,70 @@ private:
     // Stale threshold: 5 seconds
     static const unsigned long STALE_THRESHOLD_MS = 5000;
 
+    // Weight of the newest interval in avgUpdateInterval and intervalJitter (1/8)
+    static const int INTERVAL_AVERAGE_SHIFT = 3;
+
+    // Weight of the newest update in rejectionRate (1/16)
+    static const int REJECTION_AVERAGE_SHIFT = 4;
+
     /**
-     * @brief Get source array and metadata for a sensor type
-     *
-     * @param type Sensor type (GPS or COMPASS)
-     * @param outCount Output: current source count
-     * @param outActiveIndex Output: current active source index
-     * @return Pointer to source array
+     * @brief Source for a source index
+     * @return Pointer into the source table, or nullptr if not registered
+     */
+    SensorSource* resolve(int sourceIndex);
+
+    /**
+     * @brief Member list of a sensor type
      */
-    SensorSource* getSourceArray(SensorType type, int& outCount, int& outActiveIndex);
+    SourceTypeList& typeList(SensorType type);
+
+    /**
+     * @brief Hash of (type, sourceId), FNV-1a over the first 15 characters
+     */
+    static uint32_t hashId(const char* sourceId, SensorType type);
 
     /**
      * @brief Set active source index for a sensor type
      *
      * @param type Sensor type
-     * @param index Source index to set as active
+     * @param index Source index to set as active (-1 = none)
+     * @param currentTime Start of the dwell time if the index changes
      */
-    void setActiveIndex(SensorType type, int index);
+    void setActiveIndex(SensorType type, int index, unsigned long currentTime);
 
     /**
-     * @brief Recalculate frequency for a source
+     * @brief Recalculate rate, quality and score of a source
+     *
+     * The rate is 1000 / avgUpdateInterval, or 1000 / the time since the
+     * last update once that is longer (a source that slows down or stops
+     * loses rank before it goes stale).
      *
      * @param source Pointer to source structure
      * @param currentTime Current time (millis())
      */
-    void calculateFrequency(SensorSource* source, unsigned long currentTime);
+    void calculateScore(SensorSource* source, unsigned long currentTime);
 
     /**
-     * @brief Select highest priority available source for a sensor type
+     * @brief Quality factor of a source (0-1)
+     *
+     * (1 - rejectionRate) / (1 + intervalJitter / avgUpdateInterval), times
+     * for reported fix details: the fix-quality factor, SOURCE_GOOD_HDOP / hdop
+     * (above SOURCE_GOOD_HDOP) and satellites / SOURCE_GOOD_SATELLITES (below it).
+     */
+    static double qualityFactor(const SensorSource& source);
+
+    /**
+     * @brief Weight of a GNSS fix method (0 = no fix ... 4 = RTK fixed = 1.0)
+     */
+    static double fixFactor(uint8_t fixQuality);
+
+    /**
+     * @brief Select highest scoring available source for a sensor type
      *
      * @param type Sensor type
+     * @param currentTime Current time (millis())
      */
-    void selectBestSource(SensorType type);
+    void selectBestSource(SensorType type, unsigned long currentTime);
 };
 
 #endif // SOURCE_PRIORITIZER_H
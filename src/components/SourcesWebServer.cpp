@@ -0,0 +1,140 @@
+/**
+ * @file SourcesWebServer.cpp
+ * @brief Implementation of the source table and override endpoints
+ *
+ * @see SourcesWebServer.h
+ */
+
+#include "SourcesWebServer.h"
+#include "../utils/JsonWriter.h"
+
+namespace {
+
+/// JSON names of SensorType, indexed by its value
+const char* const SENSOR_TYPE_NAMES[SENSOR_TYPE_COUNT] = {
+    "gps", "compass", "wind", "dst", "rudder", "engine", "battery", "attitude"
+};
+
+const char* protocolName(ProtocolType protocol) {
+    switch (protocol) {
+        case ProtocolType::NMEA0183: return "nmea0183";
+        case ProtocolType::NMEA2000: return "nmea2000";
+        case ProtocolType::ONEWIRE: return "onewire";
+        case ProtocolType::I2C: return "i2c";
+        default: return "unknown";
+    }
+}
+
+}  // namespace
+
+SourcesWebServer::SourcesWebServer(ISourcePrioritizer* sourcePrioritizer, BoatData* boatDataInstance)
+    : prioritizer(sourcePrioritizer), boatData(boatDataInstance) {
+}
+
+void SourcesWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || prioritizer == nullptr || boatData == nullptr) {
+        return;
+    }
+
+    // GET /sources - Source table and active source per type
+    server->on("/sources", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetSources(request);
+    });
+
+    // POST /sources/override?index=N | ?type=gps&clear=1
+    server->on("/sources/override", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        this->handleOverride(request);
+    });
+}
+
+void SourcesWebServer::handleGetSources(AsyncWebServerRequest* request) {
+    unsigned long now = millis();
+    AsyncResponseStream* response = request->beginResponseStream("application/json");
+
+    StaticJsonWriter<192> active;
+    active.beginObject();
+    for (int t = 0; t < SENSOR_TYPE_COUNT; t++) {
+        active.add(SENSOR_TYPE_NAMES[t], prioritizer->getActiveSource(static_cast<SensorType>(t)));
+    }
+    active.endObject();
+    response->printf("{\"uptime_ms\":%lu,\"active\":%s,\"sources\":[", now, active.c_str());
+
+    bool first = true;
+    for (int i = 0; i < MAX_SENSOR_SOURCES; i++) {
+        SensorSource source = prioritizer->getSource(i);
+        if (source.sourceId[0] == '\0') {
+            break;  // Sources are registered in index order
+        }
+        int type = static_cast<int>(source.sensorType);
+
+        StaticJsonWriter<512> item;
+        item.beginObject()
+            .add("index", i)
+            .add("id", source.sourceId)
+            .add("type", type < SENSOR_TYPE_COUNT ? SENSOR_TYPE_NAMES[type] : "unknown")
+            .add("protocol", protocolName(source.protocolType))
+            .add("active", source.active)
+            .add("available", source.available)
+            .add("manual_override", source.manualOverride)
+            .add("rate_hz", source.updateFrequency)
+            .add("quality", source.quality)
+            .add("score", source.score)
+            .add("interval_ms", source.avgUpdateInterval, 1)
+            .add("jitter_ms", source.intervalJitter, 1)
+            .add("updates", source.updateCount)
+            .add("rejected", source.rejectedCount)
+            .add("outliers", source.outlierCount)
+            .add("dropped", source.droppedCount)
+            .add("rejection_rate", source.rejectionRate)
+            .add("last_update_ms_ago", source.updateCount > 0
+                 ? (unsigned long)(uint32_t)(now - source.lastUpdateTime) : 0UL)  // millis() wrap
+            .endObject();
+        if (!first) {
+            response->print(',');
+        }
+        response->print(item.c_str());
+        first = false;
+    }
+
+    response->print("]}");
+    request->send(response);
+}
+
+void SourcesWebServer::handleOverride(AsyncWebServerRequest* request) {
+    if (request->hasParam("index")) {
+        const String& value = request->getParam("index")->value();  // No copy
+        int index = value.toInt();
+        if (value.length() == 0 || (index == 0 && value != "0")) {
+            sendResult(request, 400, "index must be a number");
+            return;
+        }
+        SensorSource source = prioritizer->getSource(index);
+        if (source.sourceId[0] == '\0' || !boatData->requestSourceOverride(source.sensorType, index)) {
+            sendResult(request, 400, "unknown source");
+            return;
+        }
+        sendResult(request, 202, "pending");
+        return;
+    }
+
+    if (request->hasParam("type") && request->hasParam("clear")) {
+        const String& name = request->getParam("type")->value();
+        for (int t = 0; t < SENSOR_TYPE_COUNT; t++) {
+            if (name == SENSOR_TYPE_NAMES[t]) {
+                boatData->requestSourceOverride(static_cast<SensorType>(t), -1);
+                sendResult(request, 202, "pending");
+                return;
+            }
+        }
+        sendResult(request, 400, "unknown type");
+        return;
+    }
+
+    sendResult(request, 400, "index or type and clear required");
+}
+
+void SourcesWebServer::sendResult(AsyncWebServerRequest* request, int code, const char* status) {
+    StaticJsonWriter<96> json;
+    json.beginObject().add("status", status).endObject();
+    request->send(code, "application/json", json.c_str());
+}
@@ -0,0 +1,94 @@
+/**
+ * @file SourcesWebServer.h
+ * @brief HTTP endpoints for source arbitration diagnostics and live source switching
+ *
+ * Provides:
+ * - GET /sources: every registered source with its rate, quality, score,
+ *   availability and rejection counts, plus the active source per type
+ * - POST /sources/override?index=N: force source N (manual override)
+ * - POST /sources/override?type=gps|compass&clear=1: back to automatic
+ *
+ * An override is only requested here (BoatData::requestSourceOverride());
+ * the main loop switches before the next update of the type, without a
+ * reboot and without a polling reaction. Responds 202 "pending".
+ *
+ * Constitutional Compliance:
+ * - Principle V (Network Debugging): arbitration inspectable and steerable over WiFi
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef SOURCES_WEB_SERVER_H
+#define SOURCES_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "BoatData.h"
+
+/**
+ * @brief Web server routes for the source table
+ */
+class SourcesWebServer {
+private:
+    ISourcePrioritizer* prioritizer;
+    BoatData* boatData;
+
+    /**
+     * @brief Handle GET /sources
+     *
+     * Returns:
+     * {
+     *   "uptime_ms": 123456,
+     *   "active": {"gps": 1, "compass": 0, "wind": -1, "dst": -1, "rudder": -1, "engine": -1, "battery": -1},
+     *   "sources": [
+     *     {"index": 1, "id": "N2K-GPS-012", "type": "gps", "protocol": "nmea2000",
+     *      "active": true, "available": true, "manual_override": false,
+     *      "rate_hz": 10.00, "quality": 0.85, "score": 8.50, "interval_ms": 100.0,
+     *      "jitter_ms": 2.1, "updates": 98765, "rejected": 3, "outliers": 2,
+     *      "dropped": 0, "rejection_rate": 0.00, "last_update_ms_ago": 40},
+     *     ...
+     *   ]
+     * }
+     *
+     * Read without locking while the main loop updates the table; a value
+     * may lag by one update.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetSources(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle POST /sources/override
+     *
+     * 400 on a missing/unknown index or type, 202 once the request is recorded.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleOverride(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Send {"status": ...} with an HTTP status code
+     */
+    static void sendResult(AsyncWebServerRequest* request, int code, const char* status);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param sourcePrioritizer Source table read by GET /sources
+     * @param boatDataInstance Applies override requests in the main loop
+     */
+    SourcesWebServer(ISourcePrioritizer* sourcePrioritizer, BoatData* boatDataInstance);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // SOURCES_WEB_SERVER_H
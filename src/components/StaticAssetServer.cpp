@@ -0,0 +1,156 @@
+/**
+ * @file StaticAssetServer.cpp
+ * @brief Implementation of the static asset routes
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "StaticAssetServer.h"
+#include "../utils/WebSocketLogger.h"
+#include <LittleFS.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+extern WebSocketLogger logger;
+
+namespace {
+
+uint32_t fnv1a(uint32_t hash, const uint8_t* data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+}  // namespace
+
+StaticAssetServer::StaticAssetServer() : count(0) {
+}
+
+bool StaticAssetServer::add(const char* uri, const char* path, const char* contentType, uint32_t maxAgeS) {
+    if (count >= STATIC_ASSET_MAX_ASSETS) {
+        logger.broadcastLogf(LogLevel::ERROR, LogComponent::HTTP_FILE_SERVER, LogEvent::ASSET_TABLE_FULL,
+            "{\"uri\":\"%s\",\"max\":%d}", uri, STATIC_ASSET_MAX_ASSETS);
+        return false;
+    }
+
+    Asset& asset = assets[count++];
+    asset.uri = uri;
+    asset.path = path;
+    asset.contentType = contentType;
+    asset.maxAgeS = maxAgeS;
+    asset.resident = nullptr;
+    asset.size = 0;
+    asset.etag[0] = '\0';
+
+    asset.servedPath.format("%s.gz", path);
+    if (asset.servedPath.truncated()) {
+        logger.broadcastLogf(LogLevel::ERROR, LogComponent::HTTP_FILE_SERVER, LogEvent::PATH_TOO_LONG,
+            "{\"path\":\"%s\",\"max\":%d}", path, STATIC_ASSET_MAX_PATH - 1);
+        return false;
+    }
+    asset.gzip = LittleFS.exists(asset.servedPath.c_str());
+    if (!asset.gzip) {
+        asset.servedPath = path;
+    }
+    asset.found = asset.gzip || LittleFS.exists(path);
+    if (!asset.found) {
+        logger.broadcastLogf(LogLevel::ERROR, LogComponent::HTTP_FILE_SERVER, LogEvent::FILE_NOT_FOUND,
+            "{\"path\":\"%s\"}", path);
+        return false;
+    }
+
+    // One pass over the served file: ETag, and the RAM copy of a small asset
+    File file = LittleFS.open(asset.servedPath.c_str(), "r");
+    if (!file) {
+        asset.found = false;
+        logger.broadcastLogf(LogLevel::ERROR, LogComponent::HTTP_FILE_SERVER, LogEvent::FILE_OPEN_FAILED,
+            "{\"path\":\"%s\"}", path);
+        return false;
+    }
+    asset.size = file.size();
+    if (asset.size <= STATIC_ASSET_RESIDENT_MAX_BYTES) {
+        asset.resident = static_cast<uint8_t*>(malloc(asset.size > 0 ? asset.size : 1));  // nullptr: stream instead
+    }
+
+    uint32_t hash = 2166136261u;
+    uint8_t chunk[256];
+    size_t offset = 0;
+    while (offset < asset.size) {
+        size_t n = file.read(chunk, sizeof(chunk));
+        if (n == 0) {
+            break;
+        }
+        hash = fnv1a(hash, chunk, n);
+        if (asset.resident != nullptr) {
+            memcpy(asset.resident + offset, chunk, n);
+        }
+        offset += n;
+    }
+    file.close();
+    if (offset != asset.size && asset.resident != nullptr) {
+        free(asset.resident);  // Short read: keep streaming from the file
+        asset.resident = nullptr;
+    }
+    snprintf(asset.etag, sizeof(asset.etag), "\"%08lx\"", static_cast<unsigned long>(hash));
+
+    logger.broadcastLogf(LogLevel::INFO, LogComponent::HTTP_FILE_SERVER, LogEvent::STATIC_ASSET_ADDED,
+        "{\"uri\":\"%s\",\"path\":\"%s%s\",\"bytes\":%u,\"resident\":%s,\"etag\":%s}",
+        uri, path, asset.gzip ? ".gz" : "", (unsigned)asset.size,
+        asset.resident != nullptr ? "true" : "false", asset.etag);
+    return true;
+}
+
+void StaticAssetServer::registerRoutes(AsyncWebServer* server) {
+    for (uint8_t i = 0; i < count; i++) {
+        const Asset* asset = &assets[i];
+        server->on(asset->uri, HTTP_GET, [this, asset](AsyncWebServerRequest* request) {
+            handle(request, *asset);
+        });
+    }
+}
+
+void StaticAssetServer::handle(AsyncWebServerRequest* request, const Asset& asset) const {
+    if (!asset.found) {
+        logger.broadcastLogf(LogLevel::ERROR, LogComponent::HTTP_FILE_SERVER, LogEvent::FILE_NOT_FOUND,
+            "{\"path\":\"%s\"}", asset.path);
+        request->send(404, "text/plain", "Dashboard file not found in LittleFS");
+        return;
+    }
+
+    char cacheControl[32];
+    snprintf(cacheControl, sizeof(cacheControl), "public, max-age=%lu", static_cast<unsigned long>(asset.maxAgeS));
+
+    // Revalidation: the client's copy is current
+    if (request->hasHeader("If-None-Match") && request->header("If-None-Match").indexOf(asset.etag) >= 0) {
+        AsyncWebServerResponse* response = request->beginResponse(304);
+        response->addHeader("ETag", asset.etag);
+        response->addHeader("Cache-Control", cacheControl);
+        request->send(response);
+        return;
+    }
+
+    // A client without gzip gets the uncompressed file, if the image has it
+    if (asset.gzip && request->hasHeader("Accept-Encoding") &&
+        request->header("Accept-Encoding").indexOf("gzip") < 0 && LittleFS.exists(asset.path)) {
+        request->send(LittleFS, asset.path, asset.contentType);
+        return;
+    }
+
+    AsyncWebServerResponse* response = asset.resident != nullptr
+        ? request->beginResponse(200, asset.contentType, asset.resident, asset.size)
+        : request->beginResponse(LittleFS, asset.servedPath.c_str(), asset.contentType);
+    if (asset.gzip) {
+        response->addHeader("Content-Encoding", "gzip");
+    }
+    response->addHeader("ETag", asset.etag);
+    response->addHeader("Cache-Control", cacheControl);
+    request->send(response);
+
+    LOG_DEBUGF(&logger, LogComponent::HTTP_FILE_SERVER, LogEvent::FILE_SERVED,
+        "{\"path\":\"%s\",\"bytes\":%u,\"resident\":%s,\"clientIP\":\"%s\"}",
+        asset.path, (unsigned)asset.size, asset.resident != nullptr ? "true" : "false",
+        request->client()->remoteIP().toString().c_str());
+}
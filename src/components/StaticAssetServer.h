@@ -0,0 +1,92 @@
+/**
+ * @file StaticAssetServer.h
+ * @brief Cacheable, pre-compressed static files (the /stream dashboard)
+ *
+ * The build (tools/gzip_assets.py, a PlatformIO pre-script) writes
+ * data/<file>.gz next to each dashboard file, so the LittleFS image holds
+ * both. add() prefers the .gz at boot and, in the same single read:
+ * - computes a strong ETag (FNV-1a of the served bytes)
+ * - keeps the file in RAM if it is at most STATIC_ASSET_RESIDENT_MAX_BYTES
+ *
+ * Each GET is then answered with:
+ * - 304 Not Modified (no body) when If-None-Match carries the ETag
+ * - otherwise 200 from RAM or LittleFS, with Content-Encoding: gzip when
+ *   the .gz is served, ETag, and Cache-Control max-age
+ *   STATIC_ASSET_MAX_AGE_S (a reconnecting tablet then uses its cache
+ *   without asking, and revalidates with a 304 once that has expired) or
+ *   the asset's own max-age (the service worker, STREAM_SW_MAX_AGE_S)
+ *
+ * Files are read at boot only: upload a new filesystem image and reboot.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): resident copies allocated once at boot, bounded size
+ * - Principle V (Network Debugging): STATIC_ASSET_ADDED / FILE_NOT_FOUND log events
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef STATIC_ASSET_SERVER_H
+#define STATIC_ASSET_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../config.h"
+#include "../utils/FixedString.h"
+
+/**
+ * @class StaticAssetServer
+ * @brief Routes that serve a few LittleFS files with gzip, ETag and caching
+ *
+ * Usage pattern:
+ * @code
+ * staticAssetServer.add("/stream", "/stream.html", "text/html");  // LittleFS mounted
+ * staticAssetServer.registerRoutes(server);
+ * @endcode
+ */
+class StaticAssetServer {
+public:
+    StaticAssetServer();
+
+    /**
+     * @brief Register @p path (or @p path.gz) to be served at @p uri
+     *
+     * @param uri Request path
+     * @param path LittleFS file (uncompressed name; must outlive the server)
+     * @param contentType MIME type of the uncompressed file
+     * @param maxAgeS Cache-Control max-age in seconds
+     * @return false if the table is full or neither file exists (the URI then answers 404)
+     */
+    bool add(const char* uri, const char* path, const char* contentType,
+             uint32_t maxAgeS = STATIC_ASSET_MAX_AGE_S);
+
+    /**
+     * @brief Register a GET route for every asset added so far
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+
+private:
+    struct Asset {
+        const char* uri;
+        const char* path;
+        const char* contentType;
+        uint32_t maxAgeS;   ///< Cache-Control max-age
+        uint8_t* resident;  ///< RAM copy of the served bytes, nullptr = stream from LittleFS
+        size_t size;        ///< Served bytes (compressed size when gzip)
+        bool gzip;          ///< path.gz is served
+        FixedString<STATIC_ASSET_MAX_PATH> servedPath;  ///< path or path.gz, built once in add()
+        bool found;
+        char etag[11];      ///< "\"%08x\""
+    };
+
+    Asset assets[STATIC_ASSET_MAX_ASSETS];
+    uint8_t count;
+
+    void handle(AsyncWebServerRequest* request, const Asset& asset) const;
+};
+
+#endif // STATIC_ASSET_SERVER_H
@@ -0,0 +1,68 @@
+/**
+ * @file TaskMonitor.cpp
+ * @brief Implementation of the task stack report
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "TaskMonitor.h"
+
+TaskMonitor::TaskMonitor() : count_(0) {
+}
+
+bool TaskMonitor::add(const char* name, TaskHandle_t handle, uint32_t stackBytes, int core) {
+    if (handle == nullptr || count_ >= TASK_MONITOR_MAX_TASKS) {
+        return false;
+    }
+    tasks_[count_++] = {name, handle, stackBytes, core};
+    return true;
+}
+
+uint32_t TaskMonitor::getFreeStack(uint8_t index) const {
+    return index < count_ ? uxTaskGetStackHighWaterMark(tasks_[index].handle) : 0;
+}
+
+uint32_t TaskMonitor::writeJson(JsonWriter& json, const char* key) const {
+    uint32_t minFree = UINT32_MAX;
+    const char* minTask = "";
+
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.beginArray("tasks");
+    for (uint8_t i = 0; i < count_; i++) {
+        const Entry& task = tasks_[i];
+        uint32_t freeBytes = uxTaskGetStackHighWaterMark(task.handle);
+        if (freeBytes < minFree) {
+            minFree = freeBytes;
+            minTask = task.name;
+        }
+        json.beginObject()
+            .add("name", task.name)
+            .add("core", task.core)
+            .add("priority", (unsigned int)uxTaskPriorityGet(task.handle))
+            .add("stack", (unsigned long)task.stackBytes)
+            .add("free", (unsigned long)freeBytes)
+            .endObject();
+    }
+    json.endArray();
+    if (count_ > 0) {
+        json.add("min_free", (unsigned long)minFree).add("min_task", minTask);
+    }
+    json.endObject();
+    return minFree;
+}
+
+void TaskMonitor::logStats(WebSocketLogger* logger) const {
+    StaticJsonWriter<640> json;  // ~70 bytes per task
+    uint32_t minFree = writeJson(json);
+
+    if (count_ > 0 && minFree < TASK_STACK_WARN_BYTES) {
+        logger->broadcastLog(LogLevel::WARN, LogComponent::TASKS, LogEvent::TASK_STACKS, json.c_str());
+    } else {
+        LOG_DEBUG(logger, LogComponent::TASKS, LogEvent::TASK_STACKS, json.c_str());
+    }
+}
@@ -0,0 +1,98 @@
+/**
+ * @file TaskMonitor.h
+ * @brief Stack high-water reporting for the firmware's FreeRTOS tasks
+ *
+ * Every task the firmware creates (and the Arduino loop task) is registered
+ * once at boot with its stack size and core. logStats() then emits one
+ * TASK_STACKS event listing, per task, the priority and the smallest
+ * amount of stack that has ever been free (uxTaskGetStackHighWaterMark,
+ * bytes on ESP-IDF). The event is a WARN when any task is below
+ * TASK_STACK_WARN_BYTES, so a stack that is sized too tightly shows up in
+ * the log before it overflows.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed task table, no heap
+ * - Principle V (Network Debugging): TASK_STACKS log event
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config.h"
+#include "../utils/WebSocketLogger.h"
+#include "../utils/JsonWriter.h"
+
+/**
+ * @class TaskMonitor
+ * @brief Table of monitored tasks (main loop only)
+ *
+ * Usage pattern:
+ * @code
+ * taskMonitor.add("loop", xTaskGetCurrentTaskHandle(), CONFIG_ARDUINO_LOOP_STACK_SIZE, TASK_APP_CORE);
+ * taskMonitor.add("n2k_rx", n2kReceiveTask.getTaskHandle(), N2K_RX_TASK_STACK, N2K_RX_TASK_CORE);
+ * app.onRepeat(TASK_STATS_INTERVAL_MS, []() { taskMonitor.logStats(&logger); });
+ * @endcode
+ */
+class TaskMonitor {
+public:
+    TaskMonitor();
+
+    /**
+     * @brief Register a task
+     *
+     * @param name Shown in TASK_STACKS (must outlive the monitor)
+     * @param handle Task handle; nullptr is ignored (task not running)
+     * @param stackBytes Configured stack size
+     * @param core Pinned core
+     * @return false if @p handle is nullptr or the table is full
+     */
+    bool add(const char* name, TaskHandle_t handle, uint32_t stackBytes, int core);
+
+    /**
+     * @brief Log TASK_STACKS (WARN if a task is low on stack, DEBUG otherwise)
+     */
+    void logStats(WebSocketLogger* logger) const;
+
+    /**
+     * @brief Write the task table as a JSON object (TASK_STACKS payload)
+     *
+     * {"tasks":[{"name":"loop","core":1,"priority":1,"stack":8192,"free":5123},...],
+     *  "min_free":1800,"min_task":"n2k_rx"}
+     * With @p key the object is a member of the enclosing one (GET /memory).
+     *
+     * @return Smallest free stack of any task, UINT32_MAX with no tasks
+     */
+    uint32_t writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+    uint8_t getCount() const { return count_; }
+
+    /// Name of task @p index (nullptr past getCount())
+    const char* getName(uint8_t index) const { return index < count_ ? tasks_[index].name : nullptr; }
+
+    /// Stack size of task @p index in bytes
+    uint32_t getStackBytes(uint8_t index) const { return index < count_ ? tasks_[index].stackBytes : 0; }
+
+    int getCore(uint8_t index) const { return index < count_ ? tasks_[index].core : -1; }
+
+    /// Smallest free stack task @p index ever had (high water mark), bytes
+    uint32_t getFreeStack(uint8_t index) const;
+
+private:
+    struct Entry {
+        const char* name;
+        TaskHandle_t handle;
+        uint32_t stackBytes;
+        int core;
+    };
+
+    Entry tasks_[TASK_MONITOR_MAX_TASKS];
+    uint8_t count_;
+};
+
+#endif // TASK_MONITOR_H
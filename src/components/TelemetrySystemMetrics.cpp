@@ -0,0 +1,76 @@
+/**
+ * @file TelemetrySystemMetrics.cpp
+ * @brief Implementation of the telemetry-backed ISystemMetrics
+ *
+ * @see TelemetrySystemMetrics.h
+ */
+
+#include "TelemetrySystemMetrics.h"
+
+TelemetrySystemMetrics::TelemetrySystemMetrics(const TelemetryRegistry* telemetry, Clock clock)
+    : telemetry_(telemetry), clock_(clock) {}
+
+uint32_t TelemetrySystemMetrics::gauge(TelemetryGauge id) const {
+    if (telemetry_ == nullptr) {
+        return 0;
+    }
+    uint32_t value = telemetry_->getGauge(id);
+    return value != TelemetryRegistry::NO_VALUE ? value : 0;
+}
+
+uint32_t TelemetrySystemMetrics::getFreeHeapBytes() {
+    return gauge(TelemetryGauge::HEAP_FREE);
+}
+
+uint32_t TelemetrySystemMetrics::getLargestFreeBlockBytes() {
+    return gauge(TelemetryGauge::HEAP_LARGEST);
+}
+
+uint32_t TelemetrySystemMetrics::getMinFreeHeapBytes() {
+    return gauge(TelemetryGauge::HEAP_MIN);
+}
+
+uint32_t TelemetrySystemMetrics::getHeapAllocsPerSecond() {
+    return telemetry_ != nullptr ? telemetry_->getCounter(TelemetryCounter::HEAP_ALLOCS).ratePerSec : 0;
+}
+
+uint32_t TelemetrySystemMetrics::getHeapFreesPerSecond() {
+    return telemetry_ != nullptr ? telemetry_->getCounter(TelemetryCounter::HEAP_FREES).ratePerSec : 0;
+}
+
+uint32_t TelemetrySystemMetrics::getSketchSizeBytes() {
+    return gauge(TelemetryGauge::SKETCH_BYTES);
+}
+
+uint32_t TelemetrySystemMetrics::getFreeFlashBytes() {
+    return gauge(TelemetryGauge::SKETCH_FREE);
+}
+
+uint32_t TelemetrySystemMetrics::getLoopFrequency() {
+    return gauge(TelemetryGauge::LOOP_FREQUENCY);
+}
+
+uint8_t TelemetrySystemMetrics::getCpuIdlePercent() {
+    uint32_t sum = 0;
+    uint8_t cores = 0;
+    for (uint8_t core = 0; core < 2; core++) {
+        uint8_t percent = getCoreIdlePercent(core);
+        if (percent != CPU_IDLE_UNKNOWN) {
+            sum += percent;
+            cores++;
+        }
+    }
+    return cores > 0 ? static_cast<uint8_t>((sum + cores / 2) / cores) : CPU_IDLE_UNKNOWN;
+}
+
+uint8_t TelemetrySystemMetrics::getCoreIdlePercent(uint8_t core) {
+    if (telemetry_ == nullptr || core > 1) {
+        return CPU_IDLE_UNKNOWN;
+    }
+    uint32_t value = telemetry_->getGauge(core == 0 ? TelemetryGauge::CPU_IDLE_CORE0 : TelemetryGauge::CPU_IDLE_CORE1);
+    return value <= 100 ? static_cast<uint8_t>(value) : CPU_IDLE_UNKNOWN;
+}
+
+unsigned long TelemetrySystemMetrics::getMillis() {
+    return clock_ != nullptr ? clock_() : 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file TelemetrySystemMetrics.h
+ * @brief ISystemMetrics backed by the TelemetryRegistry snapshot (OLED status page)
+ *
+ * The status page reads the same published values as /metrics, /stats and
+ * the soak CSV instead of querying the heap, loop and idle monitors itself:
+ * - heap, flash, loop frequency and per-core idle: gauges
+ * - allocations / frees per second: counter rates of the last interval
+ * - average idle: mean of the measured cores
+ * Values without a gauge value (before the first aggregation) read 0, idle
+ * reads CPU_IDLE_UNKNOWN.
+ *
+ * Arduino-free (the millisecond clock is injected, unit tested natively).
+ *
+ * Usage:
+ * @code
+ * TelemetrySystemMetrics telemetryMetrics(&telemetry, millis);
+ * displayManagerStorage.emplace(displayAdapter, &telemetryMetrics, &logger);
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef TELEMETRY_SYSTEM_METRICS_H
+#define TELEMETRY_SYSTEM_METRICS_H
+
+#include "hal/interfaces/ISystemMetrics.h"
+#include "utils/TelemetryRegistry.h"
+
+/**
+ * @class TelemetrySystemMetrics
+ * @brief Read-only ISystemMetrics view of the published telemetry
+ */
+class TelemetrySystemMetrics : public ISystemMetrics {
+public:
+    typedef unsigned long (*Clock)();
+
+    /**
+     * @param telemetry Registry to read (must outlive this object)
+     * @param clock Milliseconds since boot (getMillis())
+     */
+    TelemetrySystemMetrics(const TelemetryRegistry* telemetry, Clock clock);
+
+    uint32_t getFreeHeapBytes() override;
+    uint32_t getLargestFreeBlockBytes() override;
+    uint32_t getMinFreeHeapBytes() override;
+    uint32_t getHeapAllocsPerSecond() override;
+    uint32_t getHeapFreesPerSecond() override;
+    uint32_t getSketchSizeBytes() override;
+    uint32_t getFreeFlashBytes() override;
+    uint32_t getLoopFrequency() override;
+    uint8_t getCpuIdlePercent() override;
+    uint8_t getCoreIdlePercent(uint8_t core) override;
+    unsigned long getMillis() override;
+
+private:
+    /// Gauge value, 0 without one
+    uint32_t gauge(TelemetryGauge id) const;
+
+    const TelemetryRegistry* telemetry_;
+    Clock clock_;
+};
+
+#endif // TELEMETRY_SYSTEM_METRICS_H
@@ -0,0 +1,62 @@
+/**
+ * @file TraceWebServer.cpp
+ * @brief Implementation of the trace dump endpoint
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "TraceWebServer.h"
+
+TraceWebServer::TraceWebServer(TraceRecorder* traceRecorder)
+    : recorder(traceRecorder), writer(nullptr), clearAfter(false) {
+}
+
+void TraceWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || recorder == nullptr) {
+        return;
+    }
+
+    // GET /trace - Recent trace events as Chrome trace_event JSON
+    server->on("/trace", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetTrace(request);
+    });
+}
+
+void TraceWebServer::handleGetTrace(AsyncWebServerRequest* request) {
+    if (writer != nullptr) {
+        request->send(503, "application/json", "{\"error\":\"trace dump in progress\"}");
+        return;
+    }
+
+    recorder->pause();
+    writer = new TraceChromeWriter(*recorder, ESP.getCpuFreqMHz());
+    clearAfter = request->hasParam("clear") && request->getParam("clear")->value() == "1";
+
+    AsyncWebServerResponse* response = request->beginChunkedResponse("application/json",
+        [this](uint8_t* buffer, size_t maxLen, size_t index) -> size_t {
+            size_t n = writer != nullptr ? writer->read(reinterpret_cast<char*>(buffer), maxLen) : 0;
+            if (n == 0) {
+                finish();
+            }
+            return n;
+        });
+    response->addHeader("Content-Disposition", "attachment; filename=\"poseidon2-trace.json\"");
+    response->addHeader("Cache-Control", "no-store");
+    request->onDisconnect([this]() {
+        finish();
+    });
+    request->send(response);
+}
+
+void TraceWebServer::finish() {
+    if (writer == nullptr) {
+        return;
+    }
+    delete writer;
+    writer = nullptr;
+    if (clearAfter) {
+        recorder->clear();
+    }
+    recorder->resume();
+}
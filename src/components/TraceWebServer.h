@@ -0,0 +1,65 @@
+/**
+ * @file TraceWebServer.h
+ * @brief HTTP endpoint that dumps the trace event ring as Chrome trace JSON
+ *
+ * Provides:
+ * - GET /trace[?clear=1]: the last TRACE_RING_EVENTS events in Chrome
+ *   trace_event format, as a download (poseidon2-trace.json) for
+ *   ui.perfetto.dev or chrome://tracing; clear=1 empties the ring afterwards
+ *
+ * Recording is paused while the response is sent (a chunked response,
+ * about 100 bytes per event, so the ring is never copied to the heap) and
+ * resumes when it completes or the client disconnects. A second dump
+ * during the first is answered 503.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): streamed in chunks, no copy of the ring
+ * - Principle V (Network Debugging): timelines downloadable over WiFi
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef TRACE_WEB_SERVER_H
+#define TRACE_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../utils/TraceRecorder.h"
+
+/**
+ * @brief Web server route for the trace dump
+ */
+class TraceWebServer {
+private:
+    TraceRecorder* recorder;
+    TraceChromeWriter* writer;  ///< Dump in progress (web server task only)
+    bool clearAfter;
+
+    /**
+     * @brief Handle GET /trace
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetTrace(AsyncWebServerRequest* request);
+
+    /// End the dump in progress: free the writer, resume recording
+    void finish();
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param traceRecorder Ring written by the instrumented code
+     */
+    explicit TraceWebServer(TraceRecorder* traceRecorder);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // TRACE_WEB_SERVER_H
@@ -0,0 +1,53 @@
+/**
+ * @file TripCountersWebServer.cpp
+ * @brief Implementation of the trip counter endpoints
+ *
+ * @see TripCountersWebServer.h
+ */
+
+#include "TripCountersWebServer.h"
+#include "../utils/JsonWriter.h"
+
+TripCountersWebServer::TripCountersWebServer(TripCounters* tripCounters)
+    : counters(tripCounters) {
+}
+
+void TripCountersWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || counters == nullptr) {
+        return;
+    }
+
+    // GET /counters - Totals and commit counters
+    server->on("/counters", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetCounters(request);
+    });
+
+    // POST /counters/reset?counter=<name>|all - Zero a counter
+    server->on("/counters/reset", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        this->handleReset(request);
+    });
+}
+
+void TripCountersWebServer::handleGetCounters(AsyncWebServerRequest* request) {
+    StaticJsonWriter<640> json;
+    counters->writeJson(json);
+    request->send(200, "application/json", json.c_str());
+}
+
+void TripCountersWebServer::handleReset(AsyncWebServerRequest* request) {
+    StaticJsonWriter<128> json;
+    TripCounter counter = TripCounter::COUNT;
+    if (!request->hasParam("counter") ||
+        !TripCounterFromName(request->getParam("counter")->value().c_str(), counter)) {
+        json.beginObject()
+            .add("status", "error")
+            .add("error", "counter must be engine_hours, distance, battery_a, battery_b, shore or all")
+            .endObject();
+        request->send(400, "application/json", json.c_str());
+        return;
+    }
+
+    counters->requestReset(counter);
+    json.beginObject().add("status", "resetting").add("counter", TripCounterName(counter)).endObject();
+    request->send(202, "application/json", json.c_str());
+}
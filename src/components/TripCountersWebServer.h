@@ -0,0 +1,69 @@
+/**
+ * @file TripCountersWebServer.h
+ * @brief HTTP endpoints for the engine hours, distance and energy counters
+ *
+ * Provides:
+ * - GET /counters: Totals and NVS commit counters (TripCounters)
+ * - POST /counters/reset?counter=<name>|all: Zero a counter
+ *
+ * Counter names: engine_hours, distance, battery_a, battery_b, shore. The
+ * reset is applied by the main loop at its next sample and committed to
+ * NVS right after, so it survives a power cut.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef TRIP_COUNTERS_WEB_SERVER_H
+#define TRIP_COUNTERS_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../utils/TripCounters.h"
+
+/**
+ * @brief Web server routes for the trip counters
+ */
+class TripCountersWebServer {
+private:
+    TripCounters* counters;
+
+    /**
+     * @brief Handle GET /counters
+     *
+     * {"engine_hours":412.35,"distance_nm":2210.4,"battery_a":{"ah_in":1520.2,"ah_out":1498.7},
+     *  "battery_b":{...},"shore_kwh":310.55,"commits":88,"forced_commits":2,"deferred":0,
+     *  "budget":19.5,"uncommitted":true}
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetCounters(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle POST /counters/reset
+     *
+     * 202 {"status":"resetting","counter":"distance"}, 400 for a missing or
+     * unknown counter name.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleReset(AsyncWebServerRequest* request);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param tripCounters Counters sampled by the main loop
+     */
+    explicit TripCountersWebServer(TripCounters* tripCounters);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // TRIP_COUNTERS_WEB_SERVER_H
@@ -0,0 +1,295 @@
+/**
+ * @file VoyageRecorder.cpp
+ * @brief Implementation of the rotating voyage log recorder
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "VoyageRecorder.h"
+#include "../utils/BufferPlacement.h"
+#include "../utils/OtaUpdate.h"
+
+VoyageRecorder::VoyageRecorder()
+    : encoder_(VOYAGE_LOG_KEYFRAME_RECORDS), bufferSize_(0), fillIndex_(0), fillLength_(0), fillStartMs_(0),
+      sequence_(0), slot_(-1), pendingOpen_(-1), segmentLength_(0), indexCount_(0), segmentRecords_(0),
+      writeLength_(0), openSlot_(-1), closePending_(false), writerSlot_(-1),
+      bytesWritten_(0), writeErrors_(0), activeSlot_(-1), rotateRequested_(false),
+      records_(0), keyframes_(0), dropped_(0), segments_(0),
+      logger_(nullptr), taskHandle_(nullptr) {
+    buffers_[0] = nullptr;
+    buffers_[1] = nullptr;
+    for (uint8_t i = 0; i < VOYAGE_LOG_SEGMENTS; i++) {
+        slotSequence_[i].store(0);
+        slotStartMs_[i].store(0);
+    }
+}
+
+bool VoyageRecorder::begin(WebSocketLogger* logger) {
+    if (logger == nullptr || logger_ != nullptr) {
+        return false;
+    }
+    logger_ = logger;
+
+    uint32_t bytes = 0;
+    uint8_t* block = GetBufferPlacement().place<uint8_t>("voyage_log",
+        2 * VOYAGE_LOG_BUFFER_SIZE, 2 * VOYAGE_LOG_BUFFER_SIZE, bytes);
+    if (block == nullptr) {
+        logger_->broadcastLogf(LogLevel::ERROR, LogComponent::VOYAGE_RECORDER, LogEvent::VOYAGE_ALLOC_FAILED,
+            "{\"bytes\":%u}", (unsigned)(2 * VOYAGE_LOG_BUFFER_SIZE));
+        return false;
+    }
+    bufferSize_ = bytes / 2;
+    buffers_[0] = block;
+    buffers_[1] = block + bufferSize_;
+
+    scanSegments();
+
+    BaseType_t created = xTaskCreatePinnedToCore(taskEntry, "voyage", VOYAGE_LOG_TASK_STACK, this,
+                                                 VOYAGE_LOG_TASK_PRIORITY, &taskHandle_,
+                                                 VOYAGE_LOG_TASK_CORE);
+    if (created != pdPASS) {
+        taskHandle_ = nullptr;
+        logger_->broadcastLog(LogLevel::ERROR, LogComponent::VOYAGE_RECORDER, LogEvent::VOYAGE_TASK_FAILED,
+            "{\"reason\":\"xTaskCreatePinnedToCore failed\"}");
+        return false;
+    }
+    return true;
+}
+
+void VoyageRecorder::segmentPath(uint8_t slot, char* out, size_t size) {
+    snprintf(out, size, "%s%u.bin", VOYAGE_LOG_PATH_PREFIX, (unsigned)slot);
+}
+
+int8_t VoyageRecorder::findSlot(uint32_t sequence) const {
+    if (sequence == 0) {
+        return -1;
+    }
+    uint8_t slot = static_cast<uint8_t>(sequence % VOYAGE_LOG_SEGMENTS);
+    return slotSequence_[slot].load() == sequence ? static_cast<int8_t>(slot) : -1;
+}
+
+void VoyageRecorder::scanSegments() {
+    char path[MAX_PATH];
+    for (uint8_t slot = 0; slot < VOYAGE_LOG_SEGMENTS; slot++) {
+        segmentPath(slot, path, sizeof(path));
+        if (!LittleFS.exists(path)) {
+            continue;
+        }
+        File file = LittleFS.open(path, "r");
+        uint8_t raw[VOYAGE_LOG_HEADER_SIZE];
+        VoyageLogHeader header;
+        if (file && file.read(raw, sizeof(raw)) == sizeof(raw) &&
+            VoyageLogReadHeader(raw, sizeof(raw), header)) {
+            slotSequence_[slot].store(header.sequence);
+            slotStartMs_[slot].store(header.startMs);
+            if (header.sequence > sequence_) {
+                sequence_ = header.sequence;
+            }
+        }
+        file.close();
+    }
+}
+
+void VoyageRecorder::sample(const BoatDataSnapshot& snapshot, uint32_t nowMs) {
+    if (taskHandle_ == nullptr) {
+        return;
+    }
+
+    if (rotateRequested_.exchange(false) && slot_ >= 0 && segmentRecords_ > 0 && !closeSegment()) {
+        rotateRequested_.store(true);  // Writer busy: next sample
+    }
+
+    if (snapshot.present != 0) {
+        append(snapshot, nowMs);
+    }
+
+    if (fillLength_ > 0 && static_cast<int32_t>(nowMs - fillStartMs_) >= VOYAGE_LOG_FLUSH_MS) {
+        handOff(false);  // Writer busy: retried on the next sample
+    }
+}
+
+void VoyageRecorder::append(const BoatDataSnapshot& snapshot, uint32_t nowMs) {
+    if (slot_ < 0 && !startSegment(nowMs)) {
+        drop();
+        return;
+    }
+
+    uint8_t record[VOYAGE_LOG_MAX_RECORD];
+    bool key = encoder_.nextIsKeyframe();
+    size_t n = encoder_.encode(snapshot, record, sizeof(record));
+    if (!fits(n, key)) {
+        // Segment full: this record becomes the first keyframe of the next one
+        if (!closeSegment() || !startSegment(nowMs)) {
+            drop();
+            return;
+        }
+        key = true;
+        n = encoder_.encode(snapshot, record, sizeof(record));
+    }
+    if (!reserve(n, nowMs)) {
+        drop();
+        return;
+    }
+
+    if (key) {
+        index_[indexCount_].offset = segmentLength_;
+        index_[indexCount_].timestampMs = snapshot.timestampMs;
+        indexCount_++;
+        keyframes_++;
+    }
+    memcpy(buffers_[fillIndex_] + fillLength_, record, n);
+    fillLength_ += n;
+    segmentLength_ += n;
+    segmentRecords_++;
+    records_++;
+}
+
+void VoyageRecorder::drop() {
+    dropped_++;
+    encoder_.reset();  // The next record must not build on the lost one
+}
+
+bool VoyageRecorder::fits(size_t length, bool key) const {
+    uint32_t entries = indexCount_ + (key ? 1 : 0);
+    return entries <= VOYAGE_LOG_INDEX_ENTRIES &&
+           segmentLength_ + length + VOYAGE_LOG_TRAILER_SIZE(entries) <= VOYAGE_LOG_SEGMENT_BYTES;
+}
+
+bool VoyageRecorder::startSegment(uint32_t nowMs) {
+    if (fillLength_ != 0) {
+        return false;
+    }
+
+    sequence_++;
+    uint8_t slot = static_cast<uint8_t>(sequence_ % VOYAGE_LOG_SEGMENTS);
+    fillLength_ = VoyageLogWriteHeader(buffers_[fillIndex_], bufferSize_, sequence_, nowMs);
+    fillStartMs_ = nowMs;
+    segmentLength_ = fillLength_;
+    indexCount_ = 0;
+    segmentRecords_ = 0;
+    slot_ = static_cast<int8_t>(slot);
+    pendingOpen_ = slot_;
+    slotSequence_[slot].store(sequence_);
+    slotStartMs_[slot].store(nowMs);
+    activeSlot_.store(slot_);
+    segments_++;
+    encoder_.reset();
+
+    logger_->broadcastLogf(LogLevel::INFO, LogComponent::VOYAGE_RECORDER, LogEvent::VOYAGE_SEGMENT_STARTED,
+        "{\"sequence\":%lu,\"slot\":%u,\"max_bytes\":%lu}",
+        (unsigned long)sequence_, (unsigned)slot, (unsigned long)VOYAGE_LOG_SEGMENT_BYTES);
+    return true;
+}
+
+bool VoyageRecorder::closeSegment() {
+    if (writerBusy()) {
+        return false;
+    }
+    size_t trailer = VOYAGE_LOG_TRAILER_SIZE(indexCount_);
+    if (fillLength_ + trailer > bufferSize_) {
+        handOff(false);  // The index goes into the other buffer once this one is written
+        return false;
+    }
+
+    fillLength_ += VoyageLogWriteTrailer(buffers_[fillIndex_] + fillLength_, bufferSize_ - fillLength_,
+                                         index_, indexCount_);
+    segmentLength_ += trailer;
+    handOff(true);  // Writer idle (checked above)
+
+    logger_->broadcastLogf(writeErrors_.load() > 0 ? LogLevel::WARN : LogLevel::INFO,
+        LogComponent::VOYAGE_RECORDER, LogEvent::VOYAGE_SEGMENT_CLOSED,
+        "{\"sequence\":%lu,\"records\":%lu,\"keyframes\":%lu,\"bytes\":%lu,\"dropped\":%lu,\"write_errors\":%lu}",
+        (unsigned long)sequence_, (unsigned long)segmentRecords_, (unsigned long)indexCount_,
+        (unsigned long)segmentLength_, (unsigned long)dropped_, (unsigned long)writeErrors_.load());
+
+    slot_ = -1;
+    activeSlot_.store(-1);  // writerSlot_ keeps the file busy until it is closed
+    return true;
+}
+
+bool VoyageRecorder::reserve(size_t bytes, uint32_t nowMs) {
+    if (fillLength_ + bytes > bufferSize_ && !handOff(false)) {
+        return false;
+    }
+    if (fillLength_ == 0) {
+        fillStartMs_ = nowMs;
+    }
+    return true;
+}
+
+bool VoyageRecorder::handOff(bool close) {
+    if (writerBusy()) {
+        return false;
+    }
+    if (fillLength_ == 0 && !close) {
+        return true;
+    }
+
+    // Swap first: the writer takes the buffer the main loop no longer fills
+    uint32_t length = fillLength_;
+    fillIndex_ ^= 1;
+    fillLength_ = 0;
+    if (pendingOpen_ >= 0) {
+        writerSlot_.store(pendingOpen_);
+        openSlot_.store(pendingOpen_);
+        pendingOpen_ = -1;
+    }
+    closePending_.store(close);
+    writeLength_.store(length, std::memory_order_release);
+    xTaskNotifyGive(taskHandle_);
+    return true;
+}
+
+void VoyageRecorder::taskEntry(void* param) {
+    VoyageRecorder* self = static_cast<VoyageRecorder*>(param);
+    char path[MAX_PATH];
+
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Filesystem image being installed (POST /update): hand-offs are dropped,
+        // segment open/close requests stay pending
+        if (OtaFilesystemLocked()) {
+            if (self->writeLength_.load(std::memory_order_acquire) > 0) {
+                self->writeErrors_.fetch_add(1);
+            }
+            self->writeLength_.store(0, std::memory_order_release);
+            continue;
+        }
+
+        // New segment: truncate its slot (the oldest segment)
+        int8_t open = self->openSlot_.exchange(-1);
+        if (open >= 0) {
+            if (self->file_) {
+                self->file_.close();
+            }
+            segmentPath(static_cast<uint8_t>(open), path, sizeof(path));
+            self->file_ = LittleFS.open(path, "w");
+        }
+
+        // Handed off buffer is the one the main loop is not filling
+        uint32_t length = self->writeLength_.load(std::memory_order_acquire);
+        if (length > 0) {
+            const uint8_t* data = self->buffers_[self->fillIndex_ ^ 1];
+            size_t written = 0;
+            if (self->file_) {
+                written = self->file_.write(data, length);
+                self->file_.flush();  // Committed: a reset loses the fill buffer only
+            }
+            self->bytesWritten_.fetch_add(written);
+            if (written != length) {
+                self->writeErrors_.fetch_add(1);
+            }
+        }
+
+        if (self->closePending_.load()) {
+            if (self->file_) {
+                self->file_.close();
+            }
+            self->writerSlot_.store(-1);
+            self->closePending_.store(false);
+        }
+        self->writeLength_.store(0, std::memory_order_release);
+    }
+}
@@ -0,0 +1,210 @@
+/**
+ * @file VoyageRecorder.h
+ * @brief Black-box voyage recorder: BoatData snapshots in rotating LittleFS segments
+ *
+ * Every VOYAGE_LOG_INTERVAL_MS the main loop passes a BoatDataSnapshot to
+ * sample(). Records are delta-compressed against the previous one
+ * (VoyageLogFormat), with a full keyframe every VOYAGE_LOG_KEYFRAME_RECORDS
+ * records as a seek point. Samples without any available group are skipped.
+ *
+ * Segments:
+ * - VOYAGE_LOG_SEGMENTS files VOYAGE_LOG_PATH_PREFIX<slot>.bin; segment
+ *   sequence s lives in slot s % VOYAGE_LOG_SEGMENTS, so starting a new
+ *   segment overwrites the oldest one
+ * - A segment is closed before it would grow past VOYAGE_LOG_SEGMENT_BYTES
+ *   or index more than VOYAGE_LOG_INDEX_ENTRIES keyframes; closing appends
+ *   the keyframe index and footer
+ * - Every boot starts a new segment after the newest one found in begin()
+ *
+ * Write path (the main loop never waits on flash), as in BusCapture:
+ * - Records fill one of two VOYAGE_LOG_BUFFER_SIZE buffers (placed by begin())
+ * - A full buffer, or one older than VOYAGE_LOG_FLUSH_MS, is handed to a
+ *   writer task, which appends and flushes it; a reset loses at most the
+ *   buffer being filled
+ * - A buffer never spans two segments; if the writer still holds the other
+ *   buffer, the record is dropped and counted and the next one is a keyframe
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): double buffer placed once at boot, fixed file set
+ * - Principle VII (Fail-Safe): overload drops records and counts them, never stalls;
+ *   unclosed segments still decode up to their last complete record
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef VOYAGE_RECORDER_H
+#define VOYAGE_RECORDER_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "../config.h"
+#include "../utils/BoatDataSnapshot.h"
+#include "../utils/VoyageLogFormat.h"
+#include "../utils/WebSocketLogger.h"
+
+static_assert(VOYAGE_LOG_BUFFER_SIZE >= VOYAGE_LOG_HEADER_SIZE + VOYAGE_LOG_MAX_RECORD,
+              "VOYAGE_LOG_BUFFER_SIZE must hold a header and the largest record");
+static_assert(VOYAGE_LOG_BUFFER_SIZE >= VOYAGE_LOG_TRAILER_SIZE(VOYAGE_LOG_INDEX_ENTRIES),
+              "VOYAGE_LOG_BUFFER_SIZE must hold a full index");
+static_assert(VOYAGE_LOG_SEGMENT_BYTES >= VOYAGE_LOG_HEADER_SIZE + VOYAGE_LOG_MAX_RECORD +
+              VOYAGE_LOG_TRAILER_SIZE(VOYAGE_LOG_INDEX_ENTRIES), "VOYAGE_LOG_SEGMENT_BYTES too small");
+
+/**
+ * @class VoyageRecorder
+ * @brief Double-buffered recorder of rotating voyage log segments
+ *
+ * Usage pattern:
+ * @code
+ * voyageRecorder.begin(&logger);
+ * app.onRepeat(VOYAGE_LOG_INTERVAL_MS, []() {
+ *     BoatDataSnapshot snapshot;
+ *     snapshot.fill(*boatData->getDataStructure(), millis());
+ *     voyageRecorder.sample(snapshot, millis());
+ * });
+ * @endcode
+ */
+class VoyageRecorder {
+public:
+    /// Longest segment path (VOYAGE_LOG_PATH_PREFIX + slot + ".bin")
+    static constexpr size_t MAX_PATH = 32;
+
+    VoyageRecorder();
+
+    /**
+     * @brief Place the double buffer, find the newest segment and start the writer task
+     * @return false on null logger, if already started, or if the buffers or the task cannot be created
+     */
+    bool begin(WebSocketLogger* logger);
+
+    /**
+     * @brief Main-loop hook: records @p snapshot, hands off an aged buffer
+     */
+    void sample(const BoatDataSnapshot& snapshot, uint32_t nowMs);
+
+    /**
+     * @brief Close the recording segment at the next sample (to download it); any context
+     */
+    void requestRotate() { rotateRequested_.store(true); }
+
+    /// Path of segment slot @p slot
+    static void segmentPath(uint8_t slot, char* out, size_t size);
+
+    /// Sequence number stored in @p slot (0 = no segment)
+    uint32_t getSlotSequence(uint8_t slot) const {
+        return slot < VOYAGE_LOG_SEGMENTS ? slotSequence_[slot].load() : 0;
+    }
+
+    /// millis() at which the segment in @p slot started (boot of that segment)
+    uint32_t getSlotStartMs(uint8_t slot) const {
+        return slot < VOYAGE_LOG_SEGMENTS ? slotStartMs_[slot].load() : 0;
+    }
+
+    /// Slot holding segment @p sequence, -1 if it was overwritten or never existed
+    int8_t findSlot(uint32_t sequence) const;
+
+    /// The segment in @p slot is being recorded or written (file in use)
+    bool isSlotBusy(uint8_t slot) const {
+        return activeSlot_.load() == static_cast<int8_t>(slot) || writerSlot_.load() == static_cast<int8_t>(slot);
+    }
+
+    /// Sequence of the recording segment (0 = none yet)
+    uint32_t getActiveSequence() const {
+        int8_t slot = activeSlot_.load();
+        return slot >= 0 ? slotSequence_[slot].load() : 0;
+    }
+
+    uint32_t getRecordCount() const { return records_; }
+    uint32_t getKeyframeCount() const { return keyframes_; }
+    uint32_t getDroppedCount() const { return dropped_; }
+    uint32_t getSegmentCount() const { return segments_; }
+    uint32_t getBytesWritten() const { return bytesWritten_.load(); }
+    uint32_t getWriteErrors() const { return writeErrors_.load(); }
+    TaskHandle_t getTaskHandle() const { return taskHandle_; }
+
+private:
+    VoyageLogEncoder encoder_;
+    VoyageLogIndexEntry index_[VOYAGE_LOG_INDEX_ENTRIES];  ///< Keyframes of the recording segment
+    uint8_t* buffers_[2];           ///< Halves of one BufferPlacement block
+    uint32_t bufferSize_;           ///< Bytes per buffer
+    uint8_t fillIndex_;             ///< Buffer the main loop appends to
+    uint32_t fillLength_;
+    uint32_t fillStartMs_;          ///< First record of the fill buffer (flush age)
+
+    // Recording segment (main loop)
+    uint32_t sequence_;             ///< Newest sequence number used
+    int8_t slot_;                   ///< -1 = no segment open
+    int8_t pendingOpen_;            ///< Slot the writer opens with the next handoff (-1 = none)
+    uint32_t segmentLength_;        ///< Bytes encoded into the segment, header included
+    uint32_t indexCount_;
+    uint32_t segmentRecords_;
+
+    // Writer task handoff: writeLength_ != 0 means buffers_[1 - fillIndex_] is owned by the task
+    std::atomic<uint32_t> writeLength_;
+    std::atomic<int8_t> openSlot_;        ///< Open (truncate) this slot before the next write
+    std::atomic<bool> closePending_;      ///< Close the file after the next write
+    std::atomic<int8_t> writerSlot_;      ///< Slot whose file the writer holds or is about to open
+    std::atomic<uint32_t> bytesWritten_;
+    std::atomic<uint32_t> writeErrors_;
+    File file_;                     ///< Writer task only
+
+    // Read by the web server
+    std::atomic<uint32_t> slotSequence_[VOYAGE_LOG_SEGMENTS];
+    std::atomic<uint32_t> slotStartMs_[VOYAGE_LOG_SEGMENTS];
+    std::atomic<int8_t> activeSlot_;
+    std::atomic<bool> rotateRequested_;
+
+    uint32_t records_;
+    uint32_t keyframes_;
+    uint32_t dropped_;
+    uint32_t segments_;             ///< Segments started since boot
+
+    WebSocketLogger* logger_;
+    TaskHandle_t taskHandle_;
+
+    /// Read the header of every slot (begin() only)
+    void scanSegments();
+
+    void append(const BoatDataSnapshot& snapshot, uint32_t nowMs);
+
+    /// Record lost: counted, and the next one is a keyframe
+    void drop();
+
+    /// @p length bytes (a keyframe when @p key) fit into the segment with its index
+    bool fits(size_t length, bool key) const;
+
+    /**
+     * @brief Start the next segment in the (empty) fill buffer
+     * @return false if the fill buffer still holds the previous segment
+     */
+    bool startSegment(uint32_t nowMs);
+
+    /**
+     * @brief Append the index and footer and hand the segment's last buffer off
+     * @return false if the writer is busy (retried at the next sample)
+     */
+    bool closeSegment();
+
+    /**
+     * @brief Space for @p bytes in the fill buffer, swapping buffers if needed
+     * @return false if the writer still holds the other buffer
+     */
+    bool reserve(size_t bytes, uint32_t nowMs);
+
+    /**
+     * @brief Hand the fill buffer to the writer task
+     * @return false if the writer is busy
+     */
+    bool handOff(bool close);
+
+    bool writerBusy() const {
+        return writeLength_.load(std::memory_order_acquire) != 0 || closePending_.load();
+    }
+
+    static void taskEntry(void* param);
+};
+
+#endif // VOYAGE_RECORDER_H
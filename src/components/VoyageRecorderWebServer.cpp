@@ -0,0 +1,137 @@
+/**
+ * @file VoyageRecorderWebServer.cpp
+ * @brief Implementation of the voyage log endpoints
+ *
+ * @see VoyageRecorderWebServer.h
+ */
+
+#include "VoyageRecorderWebServer.h"
+#include <stdlib.h>
+#include "../utils/JsonWriter.h"
+
+VoyageRecorderWebServer::VoyageRecorderWebServer(VoyageRecorder* voyageRecorder)
+    : recorder(voyageRecorder) {
+}
+
+void VoyageRecorderWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || recorder == nullptr) {
+        return;
+    }
+
+    // GET /voyage - Counters and stored segments
+    server->on("/voyage", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetStatus(request);
+    });
+
+    // GET /voyage/segment?seq=<n> - Download one segment
+    server->on("/voyage/segment", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetSegment(request);
+    });
+
+    // POST /voyage/rotate - Close the recording segment
+    server->on("/voyage/rotate", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        recorder->requestRotate();
+        sendResult(request, 202, "rotating");
+    });
+}
+
+void VoyageRecorderWebServer::handleGetStatus(AsyncWebServerRequest* request) {
+    // Slots ordered by sequence (oldest first); empty slots left out
+    uint8_t order[VOYAGE_LOG_SEGMENTS];
+    uint8_t count = 0;
+    for (uint8_t slot = 0; slot < VOYAGE_LOG_SEGMENTS; slot++) {
+        uint32_t sequence = recorder->getSlotSequence(slot);
+        if (sequence == 0) {
+            continue;
+        }
+        uint8_t i = count++;
+        while (i > 0 && recorder->getSlotSequence(order[i - 1]) > sequence) {
+            order[i] = order[i - 1];
+            i--;
+        }
+        order[i] = slot;
+    }
+
+    StaticJsonWriter<256 + 112 * VOYAGE_LOG_SEGMENTS> json;
+    json.beginObject()
+        .add("interval_ms", (unsigned long)VOYAGE_LOG_INTERVAL_MS)
+        .add("records", (unsigned long)recorder->getRecordCount())
+        .add("keyframes", (unsigned long)recorder->getKeyframeCount())
+        .add("dropped", (unsigned long)recorder->getDroppedCount())
+        .add("bytes", (unsigned long)recorder->getBytesWritten())
+        .add("write_errors", (unsigned long)recorder->getWriteErrors())
+        .add("segments_started", (unsigned long)recorder->getSegmentCount())
+        .add("recording", (unsigned long)recorder->getActiveSequence())
+        .beginArray("segments");
+
+    char path[VoyageRecorder::MAX_PATH];
+    for (uint8_t i = 0; i < count; i++) {
+        uint8_t slot = order[i];
+        bool busy = recorder->isSlotBusy(slot);
+        unsigned long bytes = 0;
+        bool closed = false;
+        uint32_t keyframes = 0;
+
+        VoyageRecorder::segmentPath(slot, path, sizeof(path));
+        File file = LittleFS.open(path, "r");
+        if (file) {
+            bytes = (unsigned long)file.size();
+            // The footer exists once the segment was closed
+            uint8_t footer[VOYAGE_LOG_FOOTER_SIZE];
+            closed = !busy && bytes >= VOYAGE_LOG_HEADER_SIZE + VOYAGE_LOG_FOOTER_SIZE &&
+                     file.seek(bytes - VOYAGE_LOG_FOOTER_SIZE) &&
+                     file.read(footer, sizeof(footer)) == sizeof(footer) &&
+                     VoyageLogReadFooter(footer, sizeof(footer), keyframes);
+            file.close();
+        }
+
+        json.beginObject()
+            .add("sequence", (unsigned long)recorder->getSlotSequence(slot))
+            .add("slot", (unsigned)slot)
+            .add("start_ms", (unsigned long)recorder->getSlotStartMs(slot))
+            .add("bytes", bytes);
+        if (closed) {
+            json.add("keyframes", (unsigned long)keyframes);
+        } else {
+            json.add("keyframes", (const char*)nullptr);
+        }
+        json.add("busy", busy).endObject();
+    }
+    json.endArray().endObject();
+
+    request->send(200, "application/json", json.c_str());
+}
+
+void VoyageRecorderWebServer::handleGetSegment(AsyncWebServerRequest* request) {
+    if (!request->hasParam("seq")) {
+        sendResult(request, 400, "seq required");
+        return;
+    }
+    const String& value = request->getParam("seq")->value();  // No copy
+    char* end = nullptr;
+    unsigned long sequence = strtoul(value.c_str(), &end, 10);
+    if (value.length() == 0 || end == nullptr || *end != '\0') {
+        sendResult(request, 400, "seq must be a segment number");
+        return;
+    }
+
+    int8_t slot = recorder->findSlot(static_cast<uint32_t>(sequence));
+    if (slot < 0) {
+        sendResult(request, 404, "no such segment");
+        return;
+    }
+    if (recorder->isSlotBusy(static_cast<uint8_t>(slot))) {
+        sendResult(request, 409, "recording");
+        return;
+    }
+
+    char path[VoyageRecorder::MAX_PATH];
+    VoyageRecorder::segmentPath(static_cast<uint8_t>(slot), path, sizeof(path));
+    request->send(LittleFS, path, "application/octet-stream", true);
+}
+
+void VoyageRecorderWebServer::sendResult(AsyncWebServerRequest* request, int code, const char* status) {
+    StaticJsonWriter<96> json;
+    json.beginObject().add("status", status).endObject();
+    request->send(code, "application/json", json.c_str());
+}
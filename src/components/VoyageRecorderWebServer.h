@@ -0,0 +1,85 @@
+/**
+ * @file VoyageRecorderWebServer.h
+ * @brief HTTP endpoints listing and downloading the voyage log segments
+ *
+ * Provides:
+ * - GET /voyage: Recorder counters and the stored segments, oldest first
+ * - GET /voyage/segment?seq=<n>: Download one segment (VoyageLogFormat)
+ * - POST /voyage/rotate: Close the recording segment at the next sample
+ *
+ * Downloads are served straight from LittleFS by AsyncFileResponse, which
+ * reads the file one TCP window at a time: the heap cost does not depend on
+ * the segment size. The segment being recorded is refused (409) since its
+ * writer still appends to it; POST /voyage/rotate closes it first.
+ *
+ * @version 1.0.0
+ */
+
+#ifndef VOYAGE_RECORDER_WEB_SERVER_H
+#define VOYAGE_RECORDER_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include <LittleFS.h>
+#include "VoyageRecorder.h"
+
+/**
+ * @brief Web server routes for the voyage recorder
+ */
+class VoyageRecorderWebServer {
+private:
+    VoyageRecorder* recorder;
+
+    /**
+     * @brief Handle GET /voyage
+     *
+     * Returns:
+     * {
+     *   "interval_ms": 2000, "records": 5120, "keyframes": 171, "dropped": 0,
+     *   "bytes": 301240, "write_errors": 0, "segments_started": 19, "recording": 19,
+     *   "segments": [
+     *     {"sequence": 16, "slot": 0, "start_ms": 3021, "bytes": 16342, "keyframes": 12, "busy": false},
+     *     ...
+     *     {"sequence": 19, "slot": 3, "start_ms": 5023, "bytes": 4096, "keyframes": null, "busy": true}
+     *   ]
+     * }
+     *
+     * keyframes is the index size of a closed segment, null while a segment
+     * is recorded or if it was cut short by a reset (decode it from the start).
+     * start_ms is millis() of the boot that recorded the segment.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetStatus(AsyncWebServerRequest* request);
+
+    /**
+     * @brief Handle GET /voyage/segment
+     *
+     * 400 without a numeric seq, 404 if the segment was overwritten,
+     * 409 while it is recorded.
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetSegment(AsyncWebServerRequest* request);
+
+    static void sendResult(AsyncWebServerRequest* request, int code, const char* status);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param voyageRecorder Recorder whose segments the routes serve
+     */
+    explicit VoyageRecorderWebServer(VoyageRecorder* voyageRecorder);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // VOYAGE_RECORDER_WEB_SERVER_H
@@ -0,0 +1,61 @@
+/**
+ * @file WebStatsWebServer.cpp
+ * @brief Implementation of the web traffic statistics endpoint
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "WebStatsWebServer.h"
+#include "../utils/WsLiveness.h"
+
+WebStatsWebServer::WebStatsWebServer(WebTrafficStats* trafficStats)
+    : stats(trafficStats), resetPending(false) {
+}
+
+void WebStatsWebServer::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr || stats == nullptr) {
+        return;
+    }
+
+    // GET /web/stats - Route timing and WebSocket rates and send queues
+    server->on("/web/stats", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGetStats(request);
+    });
+}
+
+void WebStatsWebServer::handleGetStats(AsyncWebServerRequest* request) {
+    if (request->hasParam("reset") && request->getParam("reset")->value() == "1") {
+        resetPending = true;  // After this report
+    }
+    GetChunkedJsonResponder().send(request, writeStatsStep, this);
+}
+
+bool WebStatsWebServer::writeStatsStep(JsonWriter& json, uint16_t step, void* context) {
+    WebStatsWebServer* self = static_cast<WebStatsWebServer*>(context);
+
+    if (step == 0) {
+        json.beginObject().beginObject("routes");
+        return true;
+    }
+    if (step <= WebTrafficStats::ROUTE_COUNT) {
+        self->stats->writeRouteJson(json, static_cast<WebRoute>(step - 1));
+        return true;
+    }
+
+    json.endObject().beginObject("websockets");
+    for (uint8_t i = 0; i < WebTrafficStats::SOCKET_COUNT; i++) {
+        self->stats->writeSocketJson(json, static_cast<AdmissionEndpoint>(i));
+    }
+    json.endObject();
+#if WS_LIVENESS_ENABLED
+    GetWsLiveness().writeJson(json, "liveness");
+#endif
+    json.endObject();
+
+    if (self->resetPending) {
+        self->resetPending = false;
+        self->stats->reset();
+    }
+    return false;
+}
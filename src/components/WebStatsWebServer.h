@@ -0,0 +1,77 @@
+/**
+ * @file WebStatsWebServer.h
+ * @brief HTTP endpoint for the web server and WebSocket traffic statistics
+ *
+ * Provides:
+ * - GET /web/stats[?reset=1]: per route requests, bytes and the first byte
+ *   and completion time distributions; per WebSocket endpoint upgrades,
+ *   clients, messages and bytes with their rate over the last
+ *   WEB_STATS_SAMPLE_MS, and the send queue depth (now and peak);
+ *   reset=1 starts new route statistics and queue peaks after this report
+ *
+ * The body is a chunked response written one route per step
+ * (ChunkedJsonResponder), so no buffer holds more than one route object
+ * whatever the length of WEB_ROUTE_LIST.
+ *
+ * Constitutional Compliance:
+ * - Principle V (Network Debugging): handler latency of the async_tcp task inspectable over WiFi
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef WEB_STATS_WEB_SERVER_H
+#define WEB_STATS_WEB_SERVER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../utils/WebTrafficStats.h"
+#include "ChunkedJsonResponder.h"
+
+/**
+ * @brief Web server route for the web traffic statistics
+ */
+class WebStatsWebServer {
+private:
+    WebTrafficStats* stats;
+    bool resetPending;   ///< reset=1: clear once the last piece is written
+
+    /**
+     * @brief Handle GET /web/stats
+     *
+     * Returns:
+     * {
+     *   "routes": {"api_boatdata": {"requests": 120, "completed": 120, "rx_bytes": 0, "tx_bytes": 98400,
+     *              "first_byte": {"avg_us": 910, ...}, "complete": {"avg_us": 14200, ...}}, ...},
+     *   "websockets": {"boatdata": {"upgrades": 3, "clients": 2, "msg_per_s": 2.0, "queued": 0, ...}, ...},
+     *   "liveness": {"interval_ms": 10000, "max_missed": 3, "watched": 2, "evicted": 1, "aborted": 1}
+     * }
+     *
+     * @param request AsyncWebServerRequest from ESPAsyncWebServer
+     */
+    void handleGetStats(AsyncWebServerRequest* request);
+
+    /**
+     * @brief GET /web/stats body, one route per step (ChunkedJsonGenerator)
+     */
+    static bool writeStatsStep(JsonWriter& json, uint16_t step, void* context);
+
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param trafficStats Statistics filled by the request middleware and the WebSocket senders
+     */
+    explicit WebStatsWebServer(WebTrafficStats* trafficStats);
+
+    /**
+     * @brief Register routes with existing web server
+     *
+     * Must be called before server->begin().
+     *
+     * @param server Existing AsyncWebServer instance (from ConfigWebServer)
+     */
+    void registerRoutes(AsyncWebServer* server);
+};
+
+#endif // WEB_STATS_WEB_SERVER_H
@@ -8,9 +8,13 @@
  * File format (plain text, comma-separated):
  *   SSID1,password1
  *   SSID2,password2
+ *   @ip 192.168.1.50 255.255.255.0 192.168.1.1
  *   SSID3,
  *
- * Memory footprint: ~289 bytes per instance
+ * An "@ip <ip> <subnet> <gateway> [<dns>]" line gives the network above it
+ * a static address (no comma: never mistaken for a network line).
+ *
+ * Memory footprint: ~337 bytes per instance
  */
 
 #ifndef WIFI_CONFIG_FILE_H
@@ -156,6 +160,7 @@ struct WiFiConfigFile {
      * Format:
      *   SSID1,password1\n
      *   SSID2,password2\n
+     *   @ip 192.168.1.50 255.255.255.0 192.168.1.1 192.168.1.1\n
      *   SSID3,\n
      */
     String toPlainText() const {
@@ -166,6 +171,13 @@ struct WiFiConfigFile {
             result += ",";
             result += networks[i].password;
             result += "\n";
+            if (networks[i].staticIP.enabled()) {
+                char address[64];
+                WiFiFormatStaticIP(networks[i].staticIP, address, sizeof(address));
+                result += "@ip ";
+                result += address;
+                result += "\n";
+            }
         }
 
         return result;
@@ -188,8 +200,9 @@ struct WiFiConfigFile {
         int lineStart = 0;
         int lineEnd = 0;
         int linesParsed = 0;
+        bool lastAdded = false;  // "@ip" applies to the network line right above
 
-        while (lineStart < plainText.length() && linesParsed < MAX_NETWORKS) {
+        while (lineStart < plainText.length()) {
             // Find end of line
             lineEnd = plainText.indexOf('\n', lineStart);
             if (lineEnd == -1) {
@@ -203,18 +216,27 @@ struct WiFiConfigFile {
             // Parse line if not empty
             if (line.length() > 0) {
                 int commaPos = line.indexOf(',');
-                if (commaPos > 0) {
+                if (line.startsWith("@ip ") && commaPos < 0) {
+                    if (lastAdded) {
+                        WiFiParseStaticIP(line.c_str() + 4, networks[count - 1].staticIP);
+                    }
+                    lastAdded = false;
+                } else if (linesParsed >= MAX_NETWORKS) {
+                    break;
+                } else if (commaPos > 0) {
                     String ssid = line.substring(0, commaPos);
                     String password = line.substring(commaPos + 1);
 
                     WiFiCredentials creds(ssid, password);
-                    if (creds.isValid()) {
+                    lastAdded = creds.isValid();
+                    if (lastAdded) {
                         addNetwork(creds);
                         linesParsed++;
                     }
                     // Invalid credentials are silently skipped
+                } else {
+                    lastAdded = false;  // Lines without comma are silently skipped
                 }
-                // Lines without comma are silently skipped
             }
 
             lineStart = lineEnd + 1;
@@ -12,7 +12,7 @@
  *                     ↓ (all networks exhausted)
  *                  DISCONNECTED (reboot)
  *
- * Memory footprint: ~45 bytes per instance
+ * Memory footprint: ~46 bytes per instance
  */
 
 #ifndef WIFI_CONNECTION_STATE_H
@@ -42,6 +42,7 @@ struct WiFiConnectionState {
     unsigned long attemptStartTime; ///< When current attempt started (millis)
     String connectedSSID;           ///< SSID of connected network (empty if not connected)
     int retryCount;                 ///< Number of retry attempts
+    bool fastConnect;               ///< Current attempt is directed to the cached BSSID/channel
 
     /**
      * @brief Default constructor - initializes to DISCONNECTED
@@ -51,7 +52,8 @@ struct WiFiConnectionState {
           currentNetworkIndex(0),
           attemptStartTime(0),
           connectedSSID(""),
-          retryCount(0) {}
+          retryCount(0),
+          fastConnect(false) {}
 
     /**
      * @brief Copy constructor
@@ -62,7 +64,8 @@ struct WiFiConnectionState {
           currentNetworkIndex(other.currentNetworkIndex),
           attemptStartTime(other.attemptStartTime),
           connectedSSID(other.connectedSSID),
-          retryCount(other.retryCount) {}
+          retryCount(other.retryCount),
+          fastConnect(other.fastConnect) {}
 
     /**
      * @brief Assignment operator
@@ -76,6 +79,7 @@ struct WiFiConnectionState {
             attemptStartTime = other.attemptStartTime;
             connectedSSID = other.connectedSSID;
             retryCount = other.retryCount;
+            fastConnect = other.fastConnect;
         }
         return *this;
     }
@@ -7,13 +7,17 @@
  * - SSID: 1-32 characters, non-empty
  * - Password: 0 (open network) or 8-63 characters (WPA2)
  *
- * Memory footprint: ~95 bytes per instance
+ * Optional static address (WiFiStaticIP, "@ip" line in wifi.conf): the
+ * network skips DHCP when it is set.
+ *
+ * Memory footprint: ~111 bytes per instance
  */
 
 #ifndef WIFI_CREDENTIALS_H
 #define WIFI_CREDENTIALS_H
 
 #include <Arduino.h>
+#include "../utils/WiFiFastConnect.h"
 
 /**
  * @brief WiFi network credentials structure
@@ -23,6 +27,7 @@
 struct WiFiCredentials {
     String ssid;        ///< Network SSID (1-32 characters)
     String password;    ///< WPA2 password (0 or 8-63 characters)
+    WiFiStaticIP staticIP; ///< Static address (all zero = DHCP)
 
     /**
      * @brief Default constructor
@@ -50,7 +55,7 @@ struct WiFiCredentials {
      * @param other WiFiCredentials to copy from
      */
     WiFiCredentials(const WiFiCredentials& other)
-        : ssid(other.ssid), password(other.password) {}
+        : ssid(other.ssid), password(other.password), staticIP(other.staticIP) {}
 
     /**
      * @brief Assignment operator
@@ -61,6 +66,7 @@ struct WiFiCredentials {
         if (this != &other) {
             ssid = other.ssid;
             password = other.password;
+            staticIP = other.staticIP;
         }
         return *this;
     }
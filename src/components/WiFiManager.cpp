@@ -4,12 +4,32 @@
  */
 
 #include "WiFiManager.h"
+#include "../utils/WriteBehind.h"
 
-WiFiManager::WiFiManager(IWiFiAdapter* wifi, IFileSystem* fs, WebSocketLogger* log, TimeoutManager* timeout)
+namespace {
+
+const char* const WIFI_RECORD_KEY = "wifi";
+const uint16_t WIFI_RECORD_SCHEMA = 1;
+
+}  // namespace
+
+WiFiManager::WiFiManager(IWiFiAdapter* wifi, IFileSystem* fs, WebSocketLogger* log, TimeoutManager* timeout,
+                         IConfigStore* store)
     : wifiAdapter(wifi),
       fileSystem(fs),
       logger(log),
-      timeoutManager(timeout) {
+      timeoutManager(timeout),
+      configStore(store),
+      cacheMux(portMUX_INITIALIZER_UNLOCKED),
+      cacheEntry(-1),
+      disconnectedAt(0) {
+    attemptSSID[0] = '\0';
+#if WIFI_FAST_CONNECT_ENABLED
+    // Table full: the cache still works, it is just rebuilt by scanning after a reboot
+    cacheEntry = GetWriteBehind().add("wifi_cache", [](void* context) {
+        return static_cast<WiFiManager*>(context)->saveConnectCache();
+    }, this);
+#endif
 }
 
 // ============================================================================
@@ -17,6 +37,17 @@ WiFiManager::WiFiManager(IWiFiAdapter* wifi, IFileSystem* fs, WebSocketLogger* l
 // ============================================================================
 
 bool WiFiManager::loadConfig(WiFiConfigFile& config) {
+    // Binary record, unless a wifi.conf was placed on the filesystem to be imported
+    bool importFile = fileSystem != nullptr && fileSystem->exists(CONFIG_FILE_PATH);
+    if (configStore != nullptr && !importFile) {
+        bool result = loadRecord(config);
+        if (logger != nullptr) {
+            logger->logConfigEvent(ConnectionEvent::CONFIG_LOADED, result, config.count,
+                                   result ? "" : "No valid NVS record");
+        }
+        return result;
+    }
+
     // Check if filesystem is available
     if (fileSystem == nullptr) {
         if (logger != nullptr) {
@@ -46,6 +77,13 @@ bool WiFiManager::loadConfig(WiFiConfigFile& config) {
     // Parse file content
     bool result = parser.parseFile(content, config);
 
+    if (result && configStore != nullptr) {
+        // Imported: the record is the storage from now on
+        if (saveRecord(config)) {
+            fileSystem->deleteFile(CONFIG_FILE_PATH);
+        }
+    }
+
     if (result) {
         // Log success
         if (logger != nullptr) {
@@ -54,8 +92,8 @@ bool WiFiManager::loadConfig(WiFiConfigFile& config) {
     } else {
         // Log failure
         if (logger != nullptr) {
-            String error = "Parse error: ";
-            error += parser.getLastError();
+            char error[96];
+            snprintf(error, sizeof(error), "Parse error: %s", parser.getLastError().c_str());
             logger->logConfigEvent(ConnectionEvent::CONFIG_LOADED, false, 0, error);
         }
     }
@@ -80,16 +118,23 @@ bool WiFiManager::saveConfig(const WiFiConfigFile& config) {
     for (int i = 0; i < config.count; i++) {
         if (!config.networks[i].isValid()) {
             if (logger != nullptr) {
-                String error = "Invalid network at index ";
-                error += String(i);
-                error += ": ";
-                error += config.networks[i].getValidationError();
+                char error[96];
+                snprintf(error, sizeof(error), "Invalid network at index %d: %s", i,
+                         config.networks[i].getValidationError().c_str());
                 logger->logConfigEvent(ConnectionEvent::CONFIG_SAVED, false, config.count, error);
             }
             return false;
         }
     }
 
+    if (configStore != nullptr) {
+        bool saved = saveRecord(config);
+        if (logger != nullptr) {
+            logger->logConfigEvent(ConnectionEvent::CONFIG_SAVED, saved, config.count, saved ? "" : "NVS write failed");
+        }
+        return saved;
+    }
+
     // Convert config to plain text
     String content = config.toPlainText();
 
@@ -118,6 +163,104 @@ bool WiFiManager::saveConfig(const WiFiConfigFile& config) {
     return result;
 }
 
+// ============================================================================
+// Binary network list (NVS)
+// ============================================================================
+
+bool WiFiManager::loadRecord(WiFiConfigFile& config) {
+    config.clear();
+    uint8_t record[CONFIG_RECORD_MAX_BYTES];
+    ConfigRecordReader in(record, configStore->read(WIFI_RECORD_KEY, record, sizeof(record)));
+    uint16_t schema = 0;
+    if (in.open(schema) != ConfigRecordStatus::OK || schema == 0) {
+        return false;
+    }
+
+    uint8_t count = in.getU8();
+    for (uint8_t i = 0; i < count && in.ok(); i++) {
+        char ssid[33];
+        char password[64];
+        WiFiCredentials creds;
+        in.getString(ssid, sizeof(ssid));
+        in.getString(password, sizeof(password));
+        uint8_t address[16];
+        in.getBytes(address, sizeof(address));
+        creds.ssid = ssid;
+        creds.password = password;
+        memcpy(creds.staticIP.ip, address, 4);
+        memcpy(creds.staticIP.subnet, address + 4, 4);
+        memcpy(creds.staticIP.gateway, address + 8, 4);
+        memcpy(creds.staticIP.dns, address + 12, 4);
+        if (in.ok()) {
+            config.addNetwork(creds);  // Skips an invalid entry like the text parser
+        }
+    }
+    if (!in.ok()) {
+        config.clear();
+        return false;
+    }
+    return !config.isEmpty();
+}
+
+bool WiFiManager::saveRecord(const WiFiConfigFile& config) {
+    uint8_t record[CONFIG_RECORD_MAX_BYTES];
+    ConfigRecordWriter out(record, sizeof(record));
+    out.putU8(static_cast<uint8_t>(config.count));
+    for (int i = 0; i < config.count; i++) {
+        const WiFiCredentials& creds = config.networks[i];
+        out.putString(creds.ssid.c_str())
+            .putString(creds.password.c_str())
+            .putBytes(creds.staticIP.ip, 4)
+            .putBytes(creds.staticIP.subnet, 4)
+            .putBytes(creds.staticIP.gateway, 4)
+            .putBytes(creds.staticIP.dns, 4);
+    }
+    size_t length = out.finish(WIFI_RECORD_SCHEMA);
+    return length > 0 && configStore->write(WIFI_RECORD_KEY, record, length);
+}
+
+// ============================================================================
+// Directed reconnect cache
+// ============================================================================
+
+uint8_t WiFiManager::loadConnectCache() {
+    if (fileSystem == nullptr || !fileSystem->exists(WIFI_CACHE_FILE)) {
+        return 0;
+    }
+    String content = fileSystem->readFile(WIFI_CACHE_FILE);
+    portENTER_CRITICAL(&cacheMux);
+    uint8_t count = connectCache.deserialize(content.c_str());
+    portEXIT_CRITICAL(&cacheMux);
+    return count;
+}
+
+bool WiFiManager::saveConnectCache() {
+    if (fileSystem == nullptr) {
+        return false;
+    }
+    char text[WiFiConnectCache::MAX_TEXT];
+    portENTER_CRITICAL(&cacheMux);
+    connectCache.serialize(text, sizeof(text));
+    portEXIT_CRITICAL(&cacheMux);
+    // Not atomic on purpose: a torn cache file only costs one scan
+    return fileSystem->writeFile(WIFI_CACHE_FILE, text);
+}
+
+void WiFiManager::fastConnectFailed(WiFiConnectionState& state) {
+    state.fastConnect = false;
+    portENTER_CRITICAL(&cacheMux);
+    bool changed = connectCache.markFailed(attemptSSID);
+    portEXIT_CRITICAL(&cacheMux);
+    if (changed) {
+        GetWriteBehind().markDirty(cacheEntry, millis());
+    }
+    connectStats.recordFallback();
+    if (logger != nullptr) {
+        logger->broadcastLogf(LogLevel::WARN, LogComponent::WIFI_MANAGER, LogEvent::CONNECTION_FAILED,
+            "{\"mode\":\"fast\",\"elapsed_ms\":%lu,\"action\":\"scan\"}", state.getElapsedTime());
+    }
+}
+
 // ============================================================================
 // T031: connect() Implementation
 // ============================================================================
@@ -129,7 +272,7 @@ bool WiFiManager::connect(WiFiConnectionState& state, const WiFiConfigFile& conf
     if (creds == nullptr) {
         // No valid network at current index
         if (logger != nullptr) {
-            logger->broadcastLog(LogLevel::ERROR, "WiFiManager", "CONNECT_FAILED", "{\"reason\":\"No network at index\"}");
+            logger->broadcastLog(LogLevel::ERROR, LogComponent::WIFI_MANAGER, LogEvent::CONNECT_FAILED, "{\"reason\":\"No network at index\"}");
         }
         return false;
     }
@@ -138,7 +281,7 @@ bool WiFiManager::connect(WiFiConnectionState& state, const WiFiConfigFile& conf
     if (!stateMachine.transition(state, ConnectionStatus::CONNECTING)) {
         // Invalid state transition
         if (logger != nullptr) {
-            logger->broadcastLog(LogLevel::ERROR, "WiFiManager", "CONNECT_FAILED", "{\"reason\":\"Invalid state transition\"}");
+            logger->broadcastLog(LogLevel::ERROR, LogComponent::WIFI_MANAGER, LogEvent::CONNECT_FAILED, "{\"reason\":\"Invalid state transition\"}");
         }
         return false;
     }
@@ -146,22 +289,41 @@ bool WiFiManager::connect(WiFiConnectionState& state, const WiFiConfigFile& conf
     // Call WiFi adapter to begin connection
     if (wifiAdapter == nullptr) {
         if (logger != nullptr) {
-            logger->broadcastLog(LogLevel::ERROR, "WiFiManager", "CONNECT_FAILED", "{\"reason\":\"WiFi adapter not available\"}");
+            logger->broadcastLog(LogLevel::ERROR, LogComponent::WIFI_MANAGER, LogEvent::CONNECT_FAILED, "{\"reason\":\"WiFi adapter not available\"}");
         }
         return false;
     }
 
-    bool result = wifiAdapter->begin(creds->ssid.c_str(), creds->password.c_str());
+    // Static address or DHCP, before the association starts
+    wifiAdapter->setStaticIP(creds->staticIP.enabled() ? &creds->staticIP : nullptr);
+
+    uint8_t bssid[6];
+    uint8_t channel = 0;
+    strncpy(attemptSSID, creds->ssid.c_str(), sizeof(attemptSSID) - 1);
+    attemptSSID[sizeof(attemptSSID) - 1] = '\0';
+    state.fastConnect = false;
+#if WIFI_FAST_CONNECT_ENABLED
+    portENTER_CRITICAL(&cacheMux);
+    state.fastConnect = connectCache.lookup(creds->ssid.c_str(), bssid, channel);
+    portEXIT_CRITICAL(&cacheMux);
+#endif
+
+    bool result = state.fastConnect
+        ? wifiAdapter->beginDirected(creds->ssid.c_str(), creds->password.c_str(), channel, bssid)
+        : wifiAdapter->begin(creds->ssid.c_str(), creds->password.c_str());
 
     if (result) {
+        unsigned long timeoutMs = state.fastConnect ? WIFI_FAST_CONNECT_TIMEOUT_MS : WIFI_TIMEOUT_MS;
+        connectStats.recordAttempt(state.fastConnect ? WiFiConnectMode::FAST : WiFiConnectMode::SCAN);
+
         // Log connection attempt
         if (logger != nullptr) {
-            logger->logConnectionEvent(ConnectionEvent::CONNECTION_ATTEMPT, creds->ssid, state.retryCount + 1, WIFI_TIMEOUT_MS / 1000);
+            logger->logConnectionEvent(ConnectionEvent::CONNECTION_ATTEMPT, creds->ssid, state.retryCount + 1, timeoutMs / 1000);
         }
 
         // Register timeout callback
         if (timeoutManager != nullptr) {
-            timeoutManager->registerTimeout(WIFI_TIMEOUT_MS, [this, &state, &config]() {
+            timeoutManager->registerTimeout(timeoutMs, [this, &state, &config]() {
                 // Timeout callback - handled by checkTimeout()
             });
         }
@@ -176,10 +338,20 @@ bool WiFiManager::connect(WiFiConnectionState& state, const WiFiConfigFile& conf
 
 bool WiFiManager::checkTimeout(WiFiConnectionState& state, WiFiConfigFile& config) {
     // Check if we should retry (timeout exceeded)
-    if (!stateMachine.shouldRetry(state, WIFI_TIMEOUT_MS)) {
+    unsigned long timeoutMs = state.fastConnect ? WIFI_FAST_CONNECT_TIMEOUT_MS : WIFI_TIMEOUT_MS;
+    if (!stateMachine.shouldRetry(state, timeoutMs)) {
         return false; // Timeout not exceeded
     }
 
+    if (state.status == ConnectionStatus::CONNECTING && state.fastConnect) {
+        // Cached access point gone or moved: same network, full scan
+        fastConnectFailed(state);
+        stateMachine.transition(state, ConnectionStatus::FAILED);
+        state.retryCount--;  // Not a failure of the network
+        connect(state, config);
+        return true;
+    }
+
     // Timeout exceeded - transition to FAILED
     stateMachine.transition(state, ConnectionStatus::FAILED);
 
@@ -198,12 +370,13 @@ bool WiFiManager::checkTimeout(WiFiConnectionState& state, WiFiConfigFile& confi
         // Connect to next network
         connect(state, config);
     } else {
-        // All networks exhausted - schedule reboot
+        // All networks exhausted - the main loop starts the SoftAP fallback or reboots
+#if !WIFI_AP_FALLBACK_ENABLED
         if (logger != nullptr) {
             logger->logRebootEvent(REBOOT_DELAY_MS / 1000, "All networks failed");
         }
+#endif
 
-        // Note: Actual reboot will be handled by main loop
         // This just sets the state
         stateMachine.transition(state, ConnectionStatus::DISCONNECTED);
     }
@@ -216,6 +389,22 @@ bool WiFiManager::checkTimeout(WiFiConnectionState& state, WiFiConfigFile& confi
 // ============================================================================
 
 void WiFiManager::handleDisconnect(WiFiConnectionState& state) {
+    if (state.status == ConnectionStatus::CONNECTING && state.fastConnect) {
+        // Directed attempt refused: the reconnect after this event scans
+        if (timeoutManager != nullptr) {
+            timeoutManager->cancelTimeout();
+        }
+        fastConnectFailed(state);
+        stateMachine.transition(state, ConnectionStatus::FAILED);
+        state.retryCount--;
+        stateMachine.transition(state, ConnectionStatus::DISCONNECTED);
+        return;
+    }
+
+    if (state.status == ConnectionStatus::CONNECTED) {
+        disconnectedAt = millis();
+    }
+
     // Log disconnect event
     if (logger != nullptr) {
         logger->logConnectionEvent(ConnectionEvent::CONNECTION_LOST, state.connectedSSID);
@@ -236,11 +425,101 @@ void WiFiManager::handleConnectionSuccess(WiFiConnectionState& state, const Stri
         timeoutManager->cancelTimeout();
     }
 
+    unsigned long now = millis();
+    uint32_t attemptMs = state.getElapsedTime();
+    uint32_t outageMs = disconnectedAt != 0 ? now - disconnectedAt : 0;
+    disconnectedAt = 0;
+    WiFiConnectMode mode = state.fastConnect ? WiFiConnectMode::FAST : WiFiConnectMode::SCAN;
+
     // Transition to CONNECTED
     stateMachine.transition(state, ConnectionStatus::CONNECTED, ssid);
 
+    // Remember the access point for the next reconnect
+    uint8_t bssid[6];
+    uint8_t channel = wifiAdapter != nullptr ? wifiAdapter->getChannel() : 0;
+    if (channel != 0 && wifiAdapter->getBSSID(bssid)) {
+        portENTER_CRITICAL(&cacheMux);
+        bool changed = connectCache.remember(ssid.c_str(), bssid, channel);
+        portEXIT_CRITICAL(&cacheMux);
+        if (changed) {
+            GetWriteBehind().markDirty(cacheEntry, now);
+        }
+    }
+    connectStats.recordConnected(mode, attemptMs, outageMs);
+
     // Log success
     if (logger != nullptr) {
         logger->logConnectionEvent(ConnectionEvent::CONNECTION_SUCCESS, ssid);
+
+        StaticJsonWriter<LogRecord::DATA_SIZE> data;
+        data.beginObject()
+            .add("ssid", ssid.c_str())
+            .add("mode", mode == WiFiConnectMode::FAST ? "fast" : "scan")
+            .add("attempt_ms", (unsigned long)attemptMs)
+            .add("outage_ms", (unsigned long)outageMs)
+            .add("channel", (unsigned int)channel)
+            .endObject();
+        logger->broadcastLog(LogLevel::INFO, LogComponent::WIFI_MANAGER, LogEvent::CONNECT_TIME, data.c_str());
+    }
+}
+
+// ============================================================================
+// applyConfig() Implementation (live reload)
+// ============================================================================
+
+bool WiFiManager::applyConfig(WiFiConnectionState& state, WiFiConfigFile& config, const WiFiConfigFile& updated) {
+    // Address the running link was set up with (a change needs a new association)
+    WiFiStaticIP connectedIP;
+    for (int i = 0; i < config.count; i++) {
+        if (config.networks[i].ssid == state.connectedSSID) {
+            connectedIP = config.networks[i].staticIP;
+            break;
+        }
+    }
+    config = updated;
+
+    const char* action = "connect";
+    bool result = false;
+    if (state.status == ConnectionStatus::CONNECTED) {
+        action = "reconnect";
+        for (int i = 0; i < config.count; i++) {
+            if (config.networks[i].ssid == state.connectedSSID && config.networks[i].staticIP == connectedIP) {
+                // Still listed: keep the link, failover continues from its new position
+                state.currentNetworkIndex = i;
+                action = "kept";
+                result = true;
+                break;
+            }
+        }
+        if (!result) {
+            // Removed or readdressed: the disconnect event reconnects to the first network
+            state.resetNetworkIndex();
+            state.retryCount = 0;
+            result = wifiAdapter != nullptr && wifiAdapter->disconnect();
+        }
+    } else {
+        if (state.status == ConnectionStatus::CONNECTING) {
+            // Abandon the attempt on the old list
+            if (timeoutManager != nullptr) {
+                timeoutManager->cancelTimeout();
+            }
+            stateMachine.transition(state, ConnectionStatus::FAILED);
+        }
+        state.resetNetworkIndex();
+        state.retryCount = 0;
+        result = connect(state, config);
     }
+
+    if (logger != nullptr) {
+        StaticJsonWriter<LogRecord::DATA_SIZE> data;
+        data.beginObject()
+            .add("networks_count", config.count)
+            .add("action", action)
+            .add("ssid", state.connectedSSID.c_str())
+            .add("success", result)
+            .endObject();
+        logger->broadcastLog(result ? LogLevel::INFO : LogLevel::ERROR, LogComponent::WIFI_MANAGER,
+                             LogEvent::CONFIG_APPLIED, data.c_str());
+    }
+    return result;
 }
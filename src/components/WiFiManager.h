@@ -6,6 +6,19 @@
  * Handles config loading/saving, connection attempts, timeout detection,
  * and network failover.
  *
+ * Reconnects are directed: the BSSID and channel of every network connected
+ * to are cached (WiFiConnectCache, WIFI_CACHE_FILE, written behind) and the
+ * next attempt on that network skips the channel scan. A directed attempt
+ * that fails (disconnect event or WIFI_FAST_CONNECT_TIMEOUT_MS) marks the
+ * entry failed and retries the same network with a scan. Time-to-connect is
+ * counted in WiFiConnectStats and logged as CONNECT_TIME.
+ *
+ * With an IConfigStore the network list is kept as the binary "wifi" NVS
+ * record (ConfigRecord.h): boot reads it without parsing, and it survives a
+ * reformatted LittleFS. A wifi.conf found on LittleFS at boot (data/ upload)
+ * is imported into the record and deleted. Without a store wifi.conf is the
+ * storage, as before.
+ *
  * Dependencies are injected via constructor for testability.
  */
 
@@ -13,14 +26,18 @@
 #define WIFI_MANAGER_H
 
 #include <Arduino.h>
+#include <freertos/FreeRTOS.h>
 #include "../hal/interfaces/IWiFiAdapter.h"
 #include "../hal/interfaces/IFileSystem.h"
+#include "../hal/interfaces/IConfigStore.h"
 #include "WiFiConfigFile.h"
 #include "WiFiConnectionState.h"
 #include "ConfigParser.h"
 #include "ConnectionStateMachine.h"
 #include "../utils/WebSocketLogger.h"
 #include "../utils/TimeoutManager.h"
+#include "../utils/WiFiFastConnect.h"
+#include "../utils/ConfigRecord.h"
 #include "../config.h"
 
 /**
@@ -37,6 +54,25 @@ private:
     ConnectionStateMachine stateMachine;
     WebSocketLogger* logger;
     TimeoutManager* timeoutManager;
+    IConfigStore* configStore;
+    WiFiConnectCache connectCache;   ///< Guarded by cacheMux (GOT_IP runs on the WiFi event task)
+    WiFiConnectStats connectStats;
+    portMUX_TYPE cacheMux;
+    int8_t cacheEntry;               ///< GetWriteBehind() entry of WIFI_CACHE_FILE, -1 = not persisted
+    unsigned long disconnectedAt;    ///< millis() of the last link loss (0 = none since boot)
+    char attemptSSID[33];            ///< Network of the current attempt
+
+    /// The directed attempt on attemptSSID failed: scan it next time
+    void fastConnectFailed(WiFiConnectionState& state);
+
+    /// GetWriteBehind() save: write the cache file
+    bool saveConnectCache();
+
+    /// Read the "wifi" NVS record into @p config (false: none or damaged)
+    bool loadRecord(WiFiConfigFile& config);
+
+    /// Replace the "wifi" NVS record with @p config
+    bool saveRecord(const WiFiConfigFile& config);
 
 public:
     /**
@@ -45,8 +81,10 @@ public:
      * @param fs Filesystem interface
      * @param log Dual logger (optional, can be null for testing)
      * @param timeout Timeout manager (optional, can be null for testing)
+     * @param store NVS record store (optional: null keeps wifi.conf as the storage)
      */
-    WiFiManager(IWiFiAdapter* wifi, IFileSystem* fs, WebSocketLogger* log = nullptr, TimeoutManager* timeout = nullptr);
+    WiFiManager(IWiFiAdapter* wifi, IFileSystem* fs, WebSocketLogger* log = nullptr, TimeoutManager* timeout = nullptr,
+                IConfigStore* store = nullptr);
 
     /**
      * @brief Load WiFi configuration from persistent storage
@@ -54,6 +92,8 @@ public:
      * @return true if config loaded successfully
      *
      * Reads CONFIG_FILE_PATH from filesystem and parses plain text format.
+     * With a store, a CONFIG_FILE_PATH that is present is imported into the
+     * "wifi" record and deleted; otherwise the record is read (no parse).
      * Logs errors via UDP if parsing fails.
      */
     bool loadConfig(WiFiConfigFile& config);
@@ -63,11 +103,24 @@ public:
      * @param config Configuration to save
      * @return true if config saved successfully
      *
-     * Validates config before writing. Writes to CONFIG_FILE_PATH.
+     * Validates config before writing. Writes the "wifi" record (with a
+     * store) or CONFIG_FILE_PATH.
      * Logs success/failure via UDP.
      */
     bool saveConfig(const WiFiConfigFile& config);
 
+    /**
+     * @brief Load the BSSID/channel cache from WIFI_CACHE_FILE
+     * @return Networks read (0 if the file is missing or unreadable: scans only)
+     */
+    uint8_t loadConnectCache();
+
+    /**
+     * @brief Time-to-connect counters (GET /wifi-status)
+     * @return Statistics of directed and scanned attempts
+     */
+    const WiFiConnectStats& getConnectStats() const { return connectStats; }
+
     /**
      * @brief Attempt to connect to current network
      * @param state Connection state to update
@@ -75,8 +128,11 @@ public:
      * @return true if connection attempt initiated
      *
      * Uses state.currentNetworkIndex to select network.
-     * Calls WiFi adapter begin() and transitions state to CONNECTING.
-     * Registers timeout callback via TimeoutManager.
+     * Applies the network's static address (or DHCP), then calls
+     * beginDirected() if the network is cached, else begin(), and
+     * transitions state to CONNECTING.
+     * Registers timeout callback via TimeoutManager (WIFI_FAST_CONNECT_TIMEOUT_MS
+     * for a directed attempt, WIFI_TIMEOUT_MS otherwise).
      */
     bool connect(WiFiConnectionState& state, const WiFiConfigFile& config);
 
@@ -87,6 +143,7 @@ public:
      * @return true if timeout handling performed
      *
      * Called periodically from ReactESP event loop.
+     * A directed attempt is retried on the same network with a scan.
      * Moves to next network on timeout, schedules reboot if all exhausted.
      */
     bool checkTimeout(WiFiConnectionState& state, WiFiConfigFile& config);
@@ -97,6 +154,8 @@ public:
      *
      * Called when WiFi disconnect event received.
      * Sets state to DISCONNECTED, keeps currentIndex unchanged (retry logic).
+     * A directed attempt that is refused ends here too (FAILED, then
+     * DISCONNECTED): the reconnect scans.
      * Logs disconnect event via UDP.
      */
     void handleDisconnect(WiFiConnectionState& state);
@@ -107,10 +166,27 @@ public:
      * @param ssid SSID of connected network
      *
      * Called when WiFi connection succeeds.
-     * Transitions state to CONNECTED, cancels timeout.
+     * Transitions state to CONNECTED, cancels timeout, caches the BSSID and
+     * channel, records the time-to-connect.
      * Logs success via UDP.
      */
     void handleConnectionSuccess(WiFiConnectionState& state, const String& ssid);
+
+    /**
+     * @brief Switch to an updated configuration without a reboot
+     * @param state Connection state to update
+     * @param config Running configuration (replaced by @p updated)
+     * @param updated Validated configuration (saved already)
+     * @return true if the connection is kept or a new attempt was started
+     *
+     * Main loop only (ConfigService WIFI apply). Only Wi-Fi reconnects:
+     * - CONNECTED to a network still listed: the connection is kept
+     * - CONNECTED to a removed network: disconnects; onWiFiDisconnected()
+     *   then connects to the first network of @p updated; a changed static
+     *   address of the connected network reconnects the same way
+     * - CONNECTING, FAILED or DISCONNECTED: starts over at the first network
+     */
+    bool applyConfig(WiFiConnectionState& state, WiFiConfigFile& config, const WiFiConfigFile& updated);
 };
 
 #endif // WIFI_MANAGER_H
@@ -0,0 +1,136 @@
+/**
+ * @file WiFiProfileManager.cpp
+ * @brief Implementation of the Wi-Fi power profile owner
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "WiFiProfileManager.h"
+#include <WiFi.h>
+#include <esp_wifi.h>
+#include <math.h>
+#include "../utils/JsonWriter.h"
+
+namespace {
+
+wifi_ps_type_t toDriver(WiFiPowerSave mode) {
+    switch (mode) {
+        case WiFiPowerSave::NONE:      return WIFI_PS_NONE;
+        case WiFiPowerSave::MAX_MODEM: return WIFI_PS_MAX_MODEM;
+        default:                       return WIFI_PS_MIN_MODEM;
+    }
+}
+
+const char* driverPowerSaveName(wifi_ps_type_t mode) {
+    switch (mode) {
+        case WIFI_PS_NONE:      return "none";
+        case WIFI_PS_MAX_MODEM: return "max_modem";
+        default:                return "min_modem";
+    }
+}
+
+}  // namespace
+
+WiFiProfileManager::WiFiProfileManager()
+    : logger(nullptr) {
+}
+
+bool WiFiProfileManager::begin(WebSocketLogger* log) {
+    if (log == nullptr) {
+        return false;
+    }
+    logger = log;
+    return true;
+}
+
+bool WiFiProfileManager::applyRadio() {
+    const WiFiPowerProfile& profile = selector.getActiveProfile();
+    esp_err_t psErr = esp_wifi_set_ps(toDriver(profile.powerSave));
+    esp_err_t txErr = esp_wifi_set_max_tx_power(static_cast<int8_t>(profile.txQuarterDbm));
+    if (logger == nullptr) {
+        return psErr == ESP_OK && txErr == ESP_OK;
+    }
+    if (psErr != ESP_OK || txErr != ESP_OK) {
+        logger->broadcastLogf(LogLevel::ERROR, LogComponent::WIFI_MANAGER, LogEvent::WIFI_PROFILE_FAILED,
+            "{\"profile\":\"%s\",\"ps_error\":%d,\"tx_error\":%d}", profile.name, (int)psErr, (int)txErr);
+        return false;
+    }
+    logger->broadcastLogf(LogLevel::INFO, LogComponent::WIFI_MANAGER, LogEvent::WIFI_PROFILE_APPLIED,
+        "{\"profile\":\"%s\",\"power_save\":\"%s\",\"tx_power_dbm\":%.2f,\"broadcast_ms\":%lu,\"udp_ms\":%lu}",
+        profile.name, WiFiProfileSelector::powerSaveName(profile.powerSave), profile.txQuarterDbm / 4.0,
+        (unsigned long)profile.broadcastMs, (unsigned long)profile.udpMs);
+    return true;
+}
+
+bool WiFiProfileManager::poll(uint32_t nowMs) {
+    WiFiProfile requested;
+    if (!selector.takeRequest(requested) || requested == selector.getActive()) {
+        return false;
+    }
+    selector.select(requested, nowMs);
+    applyRadio();
+    return true;
+}
+
+void WiFiProfileManager::ping(AsyncWebSocket& ws, uint32_t nowUs) {
+    if (ws.count() == 0) {
+        return;
+    }
+    selector.pingSent(nowUs);
+    ws.pingAll();
+}
+
+void WiFiProfileManager::registerRoutes(AsyncWebServer* server) {
+    if (server == nullptr) {
+        return;
+    }
+
+    // GET /wifi/profile - Active profile, per-profile round trip and the radio as set
+    server->on("/wifi/profile", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        this->handleGet(request);
+    });
+
+    // POST /wifi/profile?name=racing|balanced|anchor
+    server->on("/wifi/profile", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        this->handlePost(request);
+    });
+}
+
+void WiFiProfileManager::handleGet(AsyncWebServerRequest* request) {
+    wifi_ps_type_t powerSave = WIFI_PS_MIN_MODEM;
+    int8_t txQuarterDbm = 0;
+    bool psRead = esp_wifi_get_ps(&powerSave) == ESP_OK;
+    bool txRead = esp_wifi_get_max_tx_power(&txQuarterDbm) == ESP_OK;
+
+    StaticJsonWriter<1024> json;
+    json.beginObject()
+        .beginObject("radio")
+        .add("rssi", (int)WiFi.RSSI())
+        .add("power_save", psRead ? driverPowerSaveName(powerSave) : nullptr)
+        .add("tx_power_dbm", txRead ? txQuarterDbm / 4.0 : NAN)
+        .endObject();
+    selector.writeJson(json, millis(), "selection");
+    json.endObject();
+    request->send(json.overflowed() ? 500 : 200, "application/json", json.c_str());
+}
+
+void WiFiProfileManager::handlePost(AsyncWebServerRequest* request) {
+    if (!request->hasParam("name")) {
+        sendResult(request, 400, "name required");
+        return;
+    }
+    WiFiProfile profile;
+    if (!WiFiProfileSelector::fromName(request->getParam("name")->value().c_str(), profile)) {
+        sendResult(request, 400, "unknown profile");
+        return;
+    }
+    selector.request(profile);
+    sendResult(request, 202, "pending");
+}
+
+void WiFiProfileManager::sendResult(AsyncWebServerRequest* request, int code, const char* status) {
+    StaticJsonWriter<96> json;
+    json.beginObject().add("status", status).endObject();
+    request->send(code, "application/json", json.c_str());
+}
@@ -0,0 +1,104 @@
+/**
+ * @file WiFiProfileManager.h
+ * @brief Applies the Wi-Fi power profile to the radio and serves /wifi/profile
+ *
+ * The radio half of WiFiPowerProfile: power save (esp_wifi_set_ps) and the
+ * TX power limit (esp_wifi_set_max_tx_power), applied whenever the station
+ * connects (the driver forgets them when it restarts) and when the profile
+ * changes. The stream rates are applied by the caller of poll(), which owns
+ * the rate governor and the UDP publisher.
+ *
+ * Round trip: ping() sends a WebSocket ping to every /boatdata client; the
+ * pong events (async_tcp task) go to onPong(). A ping costs one 2-byte frame
+ * per client every WIFI_PROFILE_PING_INTERVAL_MS.
+ *
+ * HTTP API:
+ * - GET /wifi/profile: the selection, the per-profile statistics and the
+ *   radio settings read back from the driver, with the RSSI
+ * - POST /wifi/profile?name=racing|balanced|anchor: 202 once recorded, the
+ *   main loop switches within CONFIG_SERVICE_INTERVAL_MS
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): radio current and airtime follow the selected profile
+ * - Principle V (Network Debugging): WIFI_PROFILE_APPLIED / WIFI_PROFILE_FAILED log events
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef WIFI_PROFILE_MANAGER_H
+#define WIFI_PROFILE_MANAGER_H
+
+#include <Arduino.h>
+#include <ESPAsyncWebServer.h>
+#include "../utils/WiFiPowerProfile.h"
+#include "../utils/WebSocketLogger.h"
+#include "../config.h"
+
+/**
+ * @class WiFiProfileManager
+ * @brief Owner of the profile selection (main loop; routes on the async_tcp task)
+ *
+ * Usage pattern:
+ * @code
+ * wifiProfileManager.begin(&logger);
+ * wifiProfileManager.applyRadio();                     // on every station connect
+ * if (wifiProfileManager.poll(millis())) {             // main loop
+ *     applyRates(wifiProfileManager.getSelector().getActiveProfile());
+ * }
+ * wifiProfileManager.ping(wsBoatData, micros());       // every WIFI_PROFILE_PING_INTERVAL_MS
+ * // WS_EVT_PONG: wifiProfileManager.onPong(micros());
+ * @endcode
+ */
+class WiFiProfileManager {
+public:
+    WiFiProfileManager();
+
+    /**
+     * @brief Attach the logger (the radio is configured by applyRadio())
+     * @return false if logger is nullptr
+     */
+    bool begin(WebSocketLogger* logger);
+
+    /**
+     * @brief Set power save and TX power of the active profile
+     * @return false (WIFI_PROFILE_FAILED logged) if the driver refused one of them
+     */
+    bool applyRadio();
+
+    /**
+     * @brief Switch to a requested profile (main loop)
+     * @return true if the active profile changed: apply its rates and persist it
+     */
+    bool poll(uint32_t nowMs);
+
+    /// Ping every client of @p ws for the round-trip statistics
+    void ping(AsyncWebSocket& ws, uint32_t nowUs);
+
+    /// A client answered a ping (WS_EVT_PONG, async_tcp task)
+    void onPong(uint32_t nowUs) { selector.pongReceived(nowUs); }
+
+    /**
+     * @brief Register GET and POST /wifi/profile
+     * @param server AsyncWebServer instance
+     */
+    void registerRoutes(AsyncWebServer* server);
+
+    WiFiProfileSelector& getSelector() { return selector; }
+    const WiFiProfileSelector& getSelector() const { return selector; }
+
+private:
+    /// GET /wifi/profile
+    void handleGet(AsyncWebServerRequest* request);
+
+    /// POST /wifi/profile?name=<profile>
+    void handlePost(AsyncWebServerRequest* request);
+
+    /// Send {"status": ...} with an HTTP status code
+    static void sendResult(AsyncWebServerRequest* request, int code, const char* status);
+
+    WiFiProfileSelector selector;
+    WebSocketLogger* logger;
+};
+
+#endif // WIFI_PROFILE_MANAGER_H
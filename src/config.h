@@ -9,17 +9,156 @@
 #ifndef CONFIG_H
 #define CONFIG_H
 
+// Feature profiles: subsystems compiled out whole (components, reactions, tasks,
+// static storage). -D overrides; env:esp32dev_headless and env:esp32dev_n2k_gateway
+// also drop their sources and libraries (platformio.ini)
+#ifndef POSEIDON_FEATURE_DISPLAY
+#define POSEIDON_FEATURE_DISPLAY 1   // 0 = headless: no OLED adapter, DisplayManager, page reactions or flush task
+#endif
+#ifndef POSEIDON_FEATURE_ONEWIRE
+#define POSEIDON_FEATURE_ONEWIRE 1   // 0 = no 1-Wire sensors, poller, device map record or reader task
+#endif
+#ifndef POSEIDON_FEATURE_NMEA0183
+#define POSEIDON_FEATURE_NMEA0183 1  // 0 = no NMEA 0183 inputs (ports, handler, routes, /nmea0183/stats); the TCP output stays
+#endif
+#ifndef POSEIDON_PROFILE
+#define POSEIDON_PROFILE "full"      // Profile name in the BUILD_PROFILE event and GET /status
+#endif
+#ifndef HOT_PATH_IRAM
+#define HOT_PATH_IRAM 0              // 1 = receive hot path linked into IRAM (HOT_PATH_ATTR, utils/HotPath.h; env:esp32dev_iram)
+#endif
+
 // WiFi Connection Configuration
 #define WIFI_TIMEOUT_MS 30000        // 30 seconds timeout per network attempt
 #define MAX_NETWORKS 3               // Maximum number of WiFi networks in config
 #define CONFIG_FILE_PATH "/wifi.conf" // LittleFS path for WiFi configuration
+#define WIFI_CONFIG_MAX_BYTES 1024   // Largest accepted /upload-wifi-config file (static upload buffer)
+#define WIFI_FAST_CONNECT_ENABLED 1  // Reconnect directed to the cached BSSID/channel before scanning (WiFiConnectCache)
+#define WIFI_FAST_CONNECT_TIMEOUT_MS 4000 // A directed attempt without an address by then falls back to a full scan
+#define WIFI_RECONNECT_DELAY_MS 100  // Delay between a lost link and the reconnect attempt
+#define WIFI_CACHE_FILE "/wifi-cache.txt" // LittleFS path of the BSSID/channel cache (written behind)
+
+// SoftAP Fallback (WiFiApFallback: own access point instead of the reboot when every network fails)
+#define WIFI_AP_FALLBACK_ENABLED 1        // 0 = reboot after REBOOT_DELAY_MS when all networks failed
+#define WIFI_AP_SSID_PREFIX "Poseidon2-"  // Followed by the last 2 MAC bytes in hex
+#define WIFI_AP_PASSWORD "poseidon2"      // WPA2 passphrase, 8-63 characters ("" = open network)
+#define WIFI_AP_CHANNEL 6                 // Until the station associates (the AP then follows its channel)
+#define WIFI_AP_MAX_STATIONS 4            // Devices on the access point
+#define WIFI_AP_RETRY_INTERVAL_MS 60000   // First pause between station rounds while the AP is up
+#define WIFI_AP_RETRY_MAX_MS 600000       // Pause doubles after each failed round up to this
+#define WIFI_AP_LINGER_MS 30000           // AP kept this long without devices once the station connected
+
+// Wi-Fi Power Profiles (WiFiPowerProfile: power save, TX power and stream rates together)
+#define WIFI_PROFILE_ENABLED 1            // 0 = Arduino radio defaults, fixed stream rates, no /wifi/profile
+#define WIFI_PROFILE_DEFAULT 1            // Until one is stored: 0 = racing, 1 = balanced, 2 = anchor
+#define WIFI_PROFILE_RACING_TX_QDBM 78    // TX power in 0.25 dBm (78 = 19.5 dBm, the maximum)
+#define WIFI_PROFILE_BALANCED_TX_QDBM 68  // 17 dBm
+#define WIFI_PROFILE_ANCHOR_TX_QDBM 44    // 11 dBm (enough within the cockpit)
+#define WIFI_PROFILE_ANCHOR_INTERVAL_MS 2000 // Anchor profile /boatdata and UDP interval
+#define WIFI_PROFILE_ANCHOR_CALC_MS 1000  // Anchor profile calculation cycle at most this often (alarms keep their own rate)
+#define WIFI_PROFILE_ANCHOR_NAV_MS 5000   // Anchor profile navigation stage at most this often
+#define WIFI_PROFILE_PING_INTERVAL_MS 10000  // WebSocket ping to /boatdata clients (round trip per profile; WS_PING_INTERVAL_MS with WS_LIVENESS_ENABLED)
 
 // Network Debugging Configuration
 #define UDP_DEBUG_PORT 4444          // LEGACY: Unused - WebSocket logging now used (ws://<device-ip>/logs)
 
+// WebSocket Log Queue Configuration
+#define LOG_RING_CAPACITY 32         // Queued log records (power of two, ~270 bytes each)
+#define LOG_RECORD_DATA_SIZE 256     // Max JSON payload bytes per queued record
+#define LOG_LINE_BUFFER_SIZE 384     // Stack buffer for one encoded log line (payload + envelope)
+#define LOG_DRAIN_INTERVAL_MS 20     // Log queue drain reactor interval
+#define LOG_DRAIN_BATCH 8            // Max records encoded and sent per drain tick
+#define LOG_MAX_SUBSCRIPTIONS 4      // /logs clients that may hold their own filter
+#define LOG_BATCH_ENABLED true       // Coalesce log lines into newline-delimited frames
+#define LOG_BATCH_MAX_BYTES 1400     // Batch buffer size - frame sent when next line won't fit
+#define LOG_BATCH_FLUSH_MS 100       // Max age of a partially filled batch before sending
+#define LOG_RATE_LIMIT_SLOTS 32      // Distinct (component,event) pairs tracked for rate limiting
+#define LOG_RATE_LIMIT_PER_SEC 10    // Sustained messages/second allowed per (component,event)
+#define LOG_RATE_LIMIT_BURST 20      // Messages allowed back-to-back before limiting starts
+#define LOG_RATE_SUMMARY_MS 5000     // Interval between {"suppressed":N} summaries
+#define LOG_INTERN_MAX_NAMES 64      // Component/event names interned for binary /logs clients
+#define LOG_CRASH_RING_RECORDS 32    // Records kept in RTC memory across resets (64 bytes each)
+#define LOG_CRASH_RING_MIN_LEVEL 1   // Lowest LogLevel recorded in the crash ring (1 = INFO)
+
+// BoatData WebSocket Stream Configuration
+#define BOATDATA_BROADCAST_INTERVAL_MS 1000   // /boatdata default interval (clients without a subscription)
+#define BOATDATA_STREAM_TICK_MS 100           // /boatdata scheduler tick; fastest subscription rate (10 Hz)
+#define BOATDATA_BROADCAST_KEEPALIVE_MS 5000  // Max gap between broadcasts while no group changes
+#define BOATDATA_DELTA_KEYFRAME_MS 10000      // /boatdata?mode=delta: full keyframe at least this often
+#define BOATDATA_DELTA_DEADBAND_ANGLE 0.0017  // rad (0.1 deg); smaller angle changes are not sent
+#define BOATDATA_DELTA_DEADBAND_SPEED 0.05    // kn or m/s
+#define BOATDATA_DELTA_DEADBAND_POSITION 0.000001  // deg (~0.1 m); other fields: one unit of the last JSON decimal
+#define BOATDATA_STREAM_MAX_CLIENTS 10        // /boatdata clients (more are refused before the upgrade)
+#define BOATDATA_STREAM_MAX_QUEUED 2          // Frames queued for a client before new ones are skipped
+#define BOATDATA_STREAM_EVICT_MS 10000        // A client behind for this long is disconnected
+#define BOATDATA_REPLAY_ENABLED 1             // /boatdata?since=<timestamp>: missed snapshots first, in one binary frame
+#define BOATDATA_REPLAY_INTERVAL_MS 2000      // One snapshot recorded per interval (BoatDataReplay)
+#define BOATDATA_REPLAY_CAPACITY 30           // Snapshots kept (30 x 2 s = 60 s, 130 B each; one 4 KB pool buffer)
+#define SIGNALK_MAX_CLIENTS 4                 // /signalk/v1/stream clients (more are refused before the upgrade)
+#define SIGNALK_SOURCE_LABEL "poseidon2"      // Signal K update source label (also the hello "name")
+#define LOGS_MAX_CLIENTS 4                    // /logs clients (more are refused before the upgrade)
+#define ADMISSION_MAX_CLIENTS 16              // All WebSocket clients together, at most (AdmissionController)
+#define ADMISSION_HEAP_RESERVE 24000          // Free heap below this (bytes): every request is refused (503)
+#define ADMISSION_BYTES_PER_CLIENT 4096       // Heap budgeted per WebSocket client above the reserve
+#define ADMISSION_RETRY_AFTER_S 5             // Retry-After of a refused request
+#define WS_POOL_SMALL_BUFFERS 8               // 256 B WebSocket send buffers (log lines, binary frames), see WsBufferPool
+#define WS_POOL_MEDIUM_BUFFERS 8              // 1 KB send buffers (log batches, /boatdata JSON)
+#define WS_POOL_LARGE_BUFFERS 4               // 4 KB send buffers (keyframes, Signal K deltas)
+#define WS_LIVENESS_ENABLED 1                 // Ping WebSocket clients, close the ones that stop answering (WsLiveness)
+#define WS_PING_INTERVAL_MS 10000             // WebSocket ping interval (/boatdata, /signalk/v1/stream, /logs)
+#define WS_PING_MAX_MISSED 3                  // Silent for this many intervals: close (1001), abort an interval later
+#define WEB_STATS_ENABLED 1                   // Per-route HTTP timing and WebSocket rates (GET /web/stats)
+#define WEB_STATS_SAMPLE_MS 1000              // WebSocket rate and send queue sampling interval
+#define METRICS_ENABLED 1                     // GET /metrics (Prometheus text format, see MetricRegistry)
+#define METRICS_MAX_FAMILIES 64               // Registered metric names (20 B each)
+#define METRICS_MAX_SCRAPES 2                 // Concurrent /metrics responses (one line buffer each), 503 beyond
+#define METRICS_LINE_BYTES 160                // Longest exposition line; longer samples are left out
+#define TELEMETRY_INTERVAL_MS 1000            // TelemetryRegistry aggregation (rates, histogram quantiles, snapshot)
+#define TELEMETRY_MAX_SOURCES 8               // Functions mirroring owner-kept values into the TelemetryRegistry
+#define CHUNKED_JSON_STREAMS 2                // Concurrent chunked JSON responses (GET /config, /status, ...), 503 beyond
+#define CHUNKED_JSON_PIECE_BYTES 1280         // Largest piece a generator step writes (the /status boot timeline)
+#define CHUNKED_JSON_STALE_MS 10000           // A stream not read for this long is reclaimed (client gone)
+#define BOATDATA_GOVERNOR_ENABLED 1           // 0 = fixed BOATDATA_BROADCAST_INTERVAL_MS default rate
+#define BOATDATA_GOVERNOR_INTERVAL_MS 2000    // Load evaluation interval (BoatDataRateGovernor)
+#define BOATDATA_GOVERNOR_LOOP_HZ_LOW 200     // Main loop slower than this: back off
+#define BOATDATA_GOVERNOR_LOOP_HZ_IDLE 1000   // Main loop at least this fast: idle
+#define BOATDATA_GOVERNOR_HEAP_LOW 40000      // Free heap below this (bytes): back off
+#define BOATDATA_GOVERNOR_HEAP_IDLE 80000     // Free heap at least this: idle
+#define BOATDATA_GOVERNOR_CPU_IDLE_LOW 10     // Busiest core idle below this (%): back off
+#define BOATDATA_GOVERNOR_CPU_IDLE_IDLE 40    // Busiest core idle at least this (%): idle
+#define BOATDATA_GOVERNOR_IDLE_EVALUATIONS 3  // Idle evaluations in a row before one step faster
+
+// BoatData UDP publisher (BoatDataDatagram: sequence number + binary snapshot)
+#define BOATDATA_UDP_ENABLED 1                // 0 = no UDP datagrams
+#define BOATDATA_UDP_BROADCAST 0              // 0 = multicast to BOATDATA_UDP_GROUP, 1 = subnet broadcast
+#define BOATDATA_UDP_GROUP "239.255.42.1"     // Multicast group (administratively scoped)
+#define BOATDATA_UDP_PORT 10120               // Destination port
+#define BOATDATA_UDP_INTERVAL_MS 200          // Publish interval (5 Hz)
+#define BOATDATA_UDP_TTL 1                    // Multicast TTL (1 = stays on the local network)
+#define BOATDATA_UDP_STATS_INTERVAL_MS 30000  // Interval between BOATDATA_UDP_STATS log events
+
+// mDNS/DNS-SD advertisement (MdnsAdvertiser: <MDNS_HOSTNAME>.local, _poseidon2/_signalk-ws/_nmea-0183._tcp)
+#define MDNS_ENABLED 1                        // 0 = no mDNS responder
+#define MDNS_HOSTNAME "poseidon2"             // Host name (a name taken on the network gets a "-2" suffix)
+#define MDNS_INSTANCE_NAME "Poseidon2 Gateway" // Service instance name shown by browsers
+#define MDNS_TXT_MAX_ITEMS 8                  // TXT items per service
+#define MDNS_TXT_VALUE_MAX 32                 // Longest TXT value, terminator included
+
+// Static dashboard files (StaticAssetServer; .gz written by tools/gzip_assets.py)
+#define STATIC_ASSET_MAX_ASSETS 4             // Files served with gzip + ETag
+#define STATIC_ASSET_MAX_PATH 40              // Longest LittleFS path of a served file, ".gz" included
+#define STATIC_ASSET_RESIDENT_MAX_BYTES 16384 // Files up to this size (as served) are kept in RAM
+#define STATIC_ASSET_MAX_AGE_S 86400          // Cache-Control max-age; then revalidated (304)
+#define STREAM_SW_MAX_AGE_S 3600              // max-age of /stream-sw.js: how soon tablets pick up a new dashboard
+
 // Reboot Configuration
 #define REBOOT_DELAY_MS 5000         // 5 seconds delay before reboot
 
+// Over-the-air updates (OtaWebServer, POST /update)
+#define OTA_ENABLED 1                // 0 = no /update routes (firmware updates over USB only)
+#define OTA_UPLOAD_TASK_PRIORITY 1   // HTTP task priority while an image is received (Arduino loop task: 1)
+#define OTA_REBOOT_DELAY_MS 1000     // Restart after an installed image (the response is sent first)
+
 // OLED Display Configuration
 #define OLED_I2C_ADDRESS 0x3C        // I2C address for SSD1306 OLED (128x64)
 #define OLED_SCREEN_WIDTH 128        // Display width in pixels
@@ -27,11 +166,535 @@
 #define OLED_SDA_PIN 21              // GPIO21 for I2C Bus 2 SDA
 #define OLED_SCL_PIN 22              // GPIO22 for I2C Bus 2 SCL
 #define OLED_I2C_CLOCK 400000        // 400kHz I2C fast mode
+#define OLED_PARTIAL_UPDATE 1        // 1 = display() sends only the changed page spans, 0 = always the full 1 KB frame
+#define OLED_FLUSH_TASK_ENABLED 1    // 1 = I2C transfers in the "oled" task (display() only copies), 0 = inline in the caller
+#define OLED_FLUSH_TASK_STACK 2048   // Flush task stack size (bytes)
+#define OLED_FLUSH_TASK_PRIORITY 1   // Same as the Arduino loop task; sleeps on the I2C driver during transfers
+#define OLED_FLUSH_TASK_CORE TASK_IO_CORE // Off the loop core
 #define DISPLAY_ANIMATION_INTERVAL_MS 1000  // 1 second animation icon update
 #define DISPLAY_STATUS_INTERVAL_MS 5000     // 5 seconds status refresh
+#define DISPLAY_PAGE_ROTATE_MS 10000        // Next OLED page every 10 s (0 = button only)
+#define DISPLAY_BUTTON_PIN 13               // SH-ESP32 button: next OLED page (active low, pull-up; -1 = none)
+#define DISPLAY_INSTRUMENT_INTERVAL_MS 100  // Instrument page check for changed values (redrawn only on a visible change)
+#define LOOP_LATENCY_WARN_P99_US 20000      // LOOP_LATENCY is a WARN with the histogram when a window's p99 reaches this
+#define CPU_IDLE_ENABLED 1                  // 0 = no idle hooks, getCpuIdlePercent() stays CPU_IDLE_UNKNOWN
+#define CPU_IDLE_UNKNOWN 255                // getCpuIdlePercent(): no completed window yet (or core not measured)
+#define HEAP_SAMPLE_INTERVAL_MS 10000       // Heap sample (the largest-block query walks the heap) and HEAP_STATS log
+#define HEAP_FRAG_WARN_PCT 75               // Fragmentation (1 - largest block / free) at or above this: WARN HEAP_FRAGMENTED
+#define HEAP_FRAG_CLEAR_PCT 60              // Back below this: INFO HEAP_RECOVERED
+#define HEAP_RATE_UNKNOWN 0xFFFFFFFFu       // getHeapAllocsPerSecond(): no allocator hooks, or no sample window yet
+
+// Task layout (which core does bus I/O, see CLAUDE.md "Task Layout")
+#ifndef TASK_LAYOUT
+#define TASK_LAYOUT 0                // 0 = N2k and 1-Wire in the main loop, 1 = bus I/O tasks on TASK_IO_CORE (env:esp32dev_iocore); -D overrides
+#endif
+#define TASK_IO_CORE 0               // Bus I/O tasks in layout 1 (shared with WiFi/lwIP)
+#define TASK_APP_CORE 1              // Arduino loop: owns BoatData, runs calculation, serialization, display
+#define TASK_STATS_INTERVAL_MS 30000 // Interval between TASK_STACKS log events
+#define TASK_STACK_WARN_BYTES 512    // TASK_STACKS is a WARN when a task's stack high-water mark leaves less than this
+#define TASK_MONITOR_MAX_TASKS 8     // Tasks reported in TASK_STACKS (incl. the Arduino loop task)
+#define MEMORY_BUDGET_MAX_ENTRIES 48 // Components listed by GET /memory (MemoryBudget)
+#define BUFFER_PLACEMENT_MAX_ENTRIES 8 // Large buffers placed at boot, PSRAM first (BufferPlacement)
+#define SCRATCH_LOOP_ARENA_BYTES 2048 // Per-reaction scratch arena of the main loop (serialization snapshots), reset after each reaction
+#define SCRATCH_HTTP_ARENA_BYTES 4096 // Per-request scratch arena of the async_tcp HTTP handlers (JSON documents, response bodies, /api/boatdata snapshot)
+#define WRITE_BEHIND_QUIET_MS 2000    // A changed configuration file is written once no further change came for this long
+#define WRITE_BEHIND_MAX_DELAY_MS 10000 // ...or at the latest this long after its first unsaved change
+#define WRITE_BEHIND_INTERVAL_MS 250  // Write-behind poll reaction interval
+#define WRITE_BEHIND_MAX_ENTRIES 8    // Registered objects (log filter, calibration, Wi-Fi cache, trip counters, Wi-Fi profile, 1-Wire map, engine journal, N2k address)
+#define CONFIG_SERVICE_INTERVAL_MS 100 // Config apply poll reaction interval (live reload latency)
+#define CONFIG_SERVICE_MAX_SUBSCRIBERS 8 // Components applying published configuration (Wi-Fi, calibration, routes, alarms)
+#define NVS_CONFIG_NAMESPACE "poseidon2" // NVS namespace of the binary configuration records (calibration, Wi-Fi networks)
+#define CONFIG_RECORD_MAX_BYTES 384  // Largest binary configuration record (3 networks with static IPs: ~350 bytes)
+
+// I/O pump (one main-loop reaction for all bus inputs, see IoPump)
+#define IO_PUMP_INTERVAL_MS 5        // Pump reaction interval (NMEA 0183, NMEA2000, 1-Wire)
+#define IO_PUMP_BUDGET_US 3000       // A pump tick starts no further steps after this long
+#define IO_PUMP_MAX_SOURCES 8        // Registered input sources
+#define IO_PUMP_N0183_LINES 4        // NMEA 0183 lines per port per step
+#define IO_PUMP_N2K_PATCHES 16       // Queued NMEA2000 updates applied per step (task modes)
+#define IO_PUMP_STATS_INTERVAL_MS 30000  // Interval between IO_PUMP_STATS log events
+
+// Reaction scheduler (priority classes over the periodic main-loop work, see CLAUDE.md "Reaction Scheduler")
+#ifndef SCHED_ENABLED
+#define SCHED_ENABLED 1              // 0 = every reaction is a plain app.onRepeat() in registration order; -D overrides
+#endif
+#define SCHED_MAX_REACTIONS 32       // Scheduled reactions (~48 bytes each); later ones fall back to app.onRepeat()
+#define SCHED_BUDGET_REALTIME_US 4000    // Per loop pass: no further realtime I/O reactions after this much time in the class
+#define SCHED_BUDGET_CALCULATION_US 5000 // ... calculation class
+#define SCHED_BUDGET_UI_US 10000     // ... UI / network class
+#define SCHED_BUDGET_BACKGROUND_US 2000  // ... background class
+#define SCHED_BACKGROUND_MAX_DEFER_MS 2000  // Background work runs even with input pending once this late
+#define SCHED_STATS_INTERVAL_MS 30000    // Interval between SCHEDULER_STATS log events
+#define SCHED_OVER_BUDGET_FLAG_RUNS 3    // Runs in a row over the class budget that flag a reaction in SCHEDULER_STATS
+
+// Stall watchdog (software watchdog over reactions and I/O tasks, see StallWatchdog)
+#ifndef STALL_WATCHDOG_ENABLED
+#define STALL_WATCHDOG_ENABLED 1     // 0 = no stall detection; -D overrides
+#endif
+#define STALL_WATCH_SLOTS 4          // Watched contexts (main loop, I/O tasks)
+#define STALL_CHECK_INTERVAL_MS 250  // esp_timer period of the stall check
+#define STALL_LOOP_TIMEOUT_MS 2000   // One main-loop reaction running this long is a stall
+#define STALL_TASK_TIMEOUT_MS 5000   // One I/O task work item running this long is a stall
+#define STALL_RESET_MS 15000         // Restart once a stall has lasted this long (0 = never)
+#define STALL_BACKTRACE_DEPTH 12     // Return addresses kept in the RTC stall record
+
+// Boot timeline (elapsed time per setup() step, see BootTimeline)
+#define BOOT_TIMELINE_STEPS 20       // Recorded init steps
+#define BOOT_N2K_TARGET_MS 500       // First NMEA2000 frame handled this soon after reset (GET /status)
+#ifndef BOOT_SERIAL_WAIT_MS
+#define BOOT_SERIAL_WAIT_MS 2000     // Wait for the USB serial monitor at boot (0 = none, release build); -D overrides
+#endif
 
 // NMEA2000 CAN Bus Configuration (SH-ESP32 Board)
 #define CAN_TX_PIN 32                // GPIO32 for CAN TX
 #define CAN_RX_PIN 34                // GPIO34 for CAN RX
+#define N2K_MAX_PGN_HANDLERS 32      // Capacity of the registrable PGN handler table
+#define N2K_RX_MODE (TASK_LAYOUT == 1 ? 2 : 0)  // 0 = poll in main loop, 1 = poll in pinned task, 2 = task woken per frame
+#define N2K_RX_WAKE_TIMEOUT_MS 10    // Max wait for a frame before a housekeeping pass (mode 2)
+#define N2K_RX_TASK_CORE TASK_IO_CORE  // Core the receive task is pinned to (modes 1 and 2)
+#define N2K_RX_TASK_STACK 6144       // Receive task stack size (bytes)
+#define N2K_RX_TASK_PRIORITY 3       // Above the Arduino loop task (1), below WiFi/lwIP
+#define N2K_RX_TASK_INTERVAL_MS 2    // Delay between ParseMessages() passes in the receive task (mode 1)
+#define N2K_PATCH_QUEUE_CAPACITY 64  // Decoded updates queued from the receive task (power of two)
+#define N2K_BATTERY_INSTANCE_A 0     // Battery / DC instance of PGN 127506/127508 shown as battery A
+#define N2K_BATTERY_INSTANCE_B 1     // ... and as battery B (other instances are ignored)
+#define N2K_ENGINE_PRIMARY_INSTANCE 0  // Engine instance of PGN 127488/127489 also kept as BoatData engine
+#ifndef BOATDATA_FLOAT_STORAGE
+#define BOATDATA_FLOAT_STORAGE 0     // 1 = BoatData values as float (FPU math), lat/lon stay double; -D overrides
+#endif
+#ifndef CALC_FAST_MATH
+#define CALC_FAST_MATH 0             // Calculation trig: 0 = libm, 1 = FastMath polynomials, 2 = FastMath sine table; -D overrides
+#endif
+#define FASTMATH_LUT_SIZE 256        // Sine table entries per turn (power of two, 4 bytes each; CALC_FAST_MATH 2)
+#ifndef CALC_ALIGN_INPUTS
+#define CALC_ALIGN_INPUTS 1          // 1 = evaluate calculation inputs at a common reference time (InputAligner); -D overrides
+#endif
+#define CALC_ALIGN_HISTORY 4         // Samples kept per aligned input
+#define CALC_ALIGN_MAX_EXTRAPOLATION_MS 500  // Longest extrapolation past an input's newest sample (held beyond)
+#define CALC_ALIGN_MAX_GAP_MS 2500   // Samples further apart are not interpolated (nearest sample used)
+#define DAMPING_MAX_TIME_CONSTANT_S 60.0f  // Largest accepted damping time constant (calibration "damping")
+#define CALIBRATION_JSON_CAPACITY 768  // ArduinoJson document for /calibration.json and /api/calibration (with "damping")
+#define CALIB_LEARN_ENABLED 1        // 1 = learn the wind angle offset and leeway K in the background (CalibrationLearner)
+#define CALIB_LEARN_INTERVAL_MS 1000 // Learner sample period (BACKGROUND class)
+#define CALIB_LEARN_AUTO_APPLY 0     // 0 = propose only (POST /api/calibration/learned/apply), 1 = apply ready proposals
+#define CALIB_LEARN_WINDOW 1800      // Samples per statistic before its sums are halved (30 min at 1 Hz)
+#define CALIB_LEARN_MIN_SAMPLES 120  // Samples per tack (wind offset) and per heel side (K) before a proposal
+#define CALIB_LEARN_SETTLE_MS 30000  // Samples ignored this long after a tack or gybe
+#define CALIB_LEARN_MIN_SPEED 2.0    // Slowest boat speed sampled
+#define CALIB_LEARN_MIN_AWA_DEG 20.0 // Wind offset: close-hauled |AWA| range sampled ...
+#define CALIB_LEARN_MAX_AWA_DEG 60.0 // ... upper end
+#define CALIB_LEARN_MAX_TWD_SPLIT_DEG 10.0  // Port/starboard mean TWD further apart: wind shift, no offset proposal
+#define CALIB_LEARN_MAX_OFFSET_DEG 15.0     // Larger learned offsets are not proposed
+#define CALIB_LEARN_MIN_HEEL_DEG 5.0 // Leeway K: smallest |heel| sampled
+#define CALIB_LEARN_MAX_LEEWAY_DEG 15.0     // Larger COG - heading angles are turns or current, not leeway
+#define CALIB_LEARN_MAX_SPEED_DIFF 0.5      // |SOG - STW| above this: current too strong to sample K
+#define CALIB_LEARN_MIN_FIT 0.25     // Smallest r² of the leeway regression proposed
+#define CALIB_LEARN_MAX_K 5.0        // Larger learned K factors are not proposed
+#define CALIB_LEARN_APPLY_MIN_OFFSET_DEG 0.5  // Auto-apply: smallest wind offset change applied ...
+#define CALIB_LEARN_APPLY_MIN_K_CHANGE 0.05   // ... and smallest relative K change
+#define CALIB_LEARN_APPLY_INTERVAL_MS 600000  // Auto-apply at most this often
+#define POLAR_FILE "/polar.pol"      // Boat polar, TWS x TWA target speeds (optional)
+#define POLAR_MAX_TWS 16             // TWS columns of the polar table (incl. an implicit 0 kn column)
+#define POLAR_MAX_TWA 32             // TWA rows of the polar table (incl. an implicit 0 deg row)
+#define POLAR_TWS_BINS 256           // TWS index steps (0.25 kn each, up to 64 kn)
+#define POLAR_LINE_MAX 256           // Longest polar file line (bytes, stack buffer while loading)
+#define STATS_WINDOW_BUCKETS 20      // Buckets per derived statistics window (10 s / 1 min / 10 min: 0.5 s / 3 s / 30 s each)
+#define NAV_MIN_INTERVAL_MS 1000     // Navigation stage (NavigationEngine) runs on derived/GPS changes, at most this often
+#define NAV_MAX_INTERVAL_MS 5000     // ... and at least this often without changes
+#define NAV_WAYPOINT_TIMEOUT_MS 10000  // Active waypoint ignored this long after the last PGN 129284
+#ifndef CALC_BENCHMARK_ENABLED
+#define CALC_BENCHMARK_ENABLED 0     // 1 = GET /calc/benchmark cycle benchmark (env:esp32dev_bench); -D overrides
+#endif
+#define CALC_BENCH_CORPUS 12         // Fixed input cases of the calculation benchmark
+#define CALC_BENCH_MAX_ITERATIONS 256  // Samples per stage (4 bytes each)
+#define CALC_BENCH_DEFAULT_ITERATIONS 128  // /calc/benchmark without ?iterations=
+#define SEQLOCK_READ_ATTEMPTS 8      // BoatData snapshot retries before a reader gives up on a group
+#define BOATDATA_MAX_SUBSCRIBERS 8   // Change-notification slots (BoatData::subscribe)
+#define BOATDATA_DISPATCH_INTERVAL_MS 10  // Change-notification dispatch reactor interval
+#define OUTPUT_PIPELINE_MAX_SINKS 8  // Outputs fed by OutputPipeline after each dispatch (UDP, replay ring, voyage log)
+#define CALC_MIN_INTERVAL_MS 100     // Calculation cycle runs on input changes, at most this often (10 Hz)
+#define CALC_MAX_INTERVAL_MS 1000    // ... and at least this often without changes (0 = changes only)
+#define CALC_DEADLINE_US 5000        // Calculation cycle execution budget; longer cycles count as deadline misses (calculationOverruns)
+#define CALC_TIMING_STATS_INTERVAL_MS 30000  // CALC_TIMING log interval (WARN when the deadline was missed meanwhile)
+#define BOATDATA_SOURCE_REEVAL_MS 1000  // Stale check + priority re-evaluation on the handle update path
+#define SOURCE_SWITCH_HYSTERESIS 0.25   // A challenger must score this fraction above the active source
+#define SOURCE_MIN_DWELL_MS 10000       // An active source is kept this long unless it goes stale
+#define SOURCE_GOOD_SATELLITES 8        // Satellites for a full satellite factor in the GPS score
+#define SOURCE_GOOD_HDOP 1.0            // HDOP at or below this scores 1; above, the factor is SOURCE_GOOD_HDOP / HDOP
+#define SOURCE_FUSION_MODE 0            // 0 = use the active GPS/compass source, 1 = blend position, COG and heading of all fresh sources
+#define SOURCE_FUSION_MAX_AGE_MS 2000   // A source's last reading takes part in the blend for this long
+#define SOURCE_FUSION_HEADING_GATE_RAD 0.26  // Headings/COG further than this (~15°) from the blend are left out
+#define SOURCE_FUSION_POSITION_GATE_M 50.0   // Positions further than this from the blend are left out
+#define OUTLIER_WINDOW 7                     // Hampel filter history per field (samples, 3-7)
+#define OUTLIER_THRESHOLD 3.0                // Outlier beyond this many scaled MADs from the median
+#define OUTLIER_MIN_SAMPLES 3                // History needed before a sample can be flagged
+#define OUTLIER_RESET_MS 5000                // History restarts after a gap this long
+#define OUTLIER_FLOOR_POSITION_DEG 0.002     // Smallest flagged lat/lon deviation (~220 m)
+#define OUTLIER_FLOOR_HEADING_RAD 0.6        // Smallest flagged heading/COG deviation (~35°)
+#define OUTLIER_FLOOR_WIND_ANGLE_RAD 1.0     // Smallest flagged AWA deviation (~57°)
+#define OUTLIER_FLOOR_SPEED_KN 3.0           // Smallest flagged SOG/boat speed deviation
+#define OUTLIER_FLOOR_WIND_SPEED_KN 8.0      // Smallest flagged AWS deviation (gusts)
+#define OUTLIER_FLOOR_HEEL_RAD 0.35          // Smallest flagged heel deviation (~20°)
+#define OUTLIER_FLOOR_RUDDER_RAD 0.35        // Smallest flagged rudder deviation (~20°)
+#define BOATDATA_ENGINE_INSTANCES 2  // Engine slots by N2k instance (0 port/single, 1 starboard; max 8)
+#define BOATDATA_TANK_INSTANCES 4    // Tank slots by (fluid type, instance) (max 8)
+#define BOATDATA_STALE_SWEEP_MS 500  // Staleness sweeper interval (BoatData::sweepStale)
+#define BOATDATA_STALE_GPS_MS 5000   // Group marked unavailable after this long without an update (0 = never)
+#define BOATDATA_STALE_COMPASS_MS 3000
+#define BOATDATA_STALE_WIND_MS 3000
+#define BOATDATA_STALE_DST_MS 5000
+#define BOATDATA_STALE_RUDDER_MS 3000
+#define BOATDATA_STALE_ENGINE_MS 5000     // Also every engine and tank instance
+#define BOATDATA_STALE_SAILDRIVE_MS 5000      // 1-Wire polled every 1 s
+#define BOATDATA_STALE_BATTERY_MS 10000       // 1-Wire polled every 2 s
+#define BOATDATA_STALE_SHORE_POWER_MS 10000
+#define BOATDATA_STALE_DERIVED_MS 0  // CalculationEngine clears derived when its inputs go stale
+#define N2K_RX_STATS_INTERVAL_MS 10000  // Interval between N2K_RX_STATS log events
+#define N2K_STATS_SLOTS 64           // Per-(PGN, source) statistics hash slots (power of two)
+#define N2K_STATS_MAX_ENTRIES 48     // Entries tracked before new pairs are only counted as overflow
+#define N2K_STATS_RATE_ALPHA 0.1f    // EWMA weight of the newest inter-arrival time
+#define N2K_TRACKED_SOURCES 8        // GPS/compass senders mapped to SourcePrioritizer sources
+#define N2K_NAME_CACHE_SIZE 32       // Address -> NAME pairs remembered from ISO Address Claims
+#define N2K_SOURCE_SLOTS 16          // (group, address) -> tracked sender hash slots (power of two)
+#define N2K_SOURCE_REEVAL_MS 1000    // Stale check + priority re-evaluation interval
+#define N2K_POSITION_POLICY 1        // 0 = 129025 and 129029 both write lat/lon, 1 = prefer rapid 129025
+#define N2K_RAPID_POSITION_TIMEOUT_MS 2000  // 129029 position used again after this long without 129025
+#define N2K_FAST_PACKET_BUFFERS 5    // Library fast-packet reassembly buffers (SetN2kCANMsgBufSize)
+#define N2K_CAN_RX_FRAME_BUFFERS 50  // Driver CAN receive frame queue (SetN2kCANReceiveFrameBufSize)
+#define N2K_FAST_PACKET_TIMEOUT_MS 750  // Open sequence counted as timed out after this frame gap
+#define N2K_SOURCE_ADDRESS 22        // First address claimed without a stored one (N2kAddressMemory)
+#define N2K_ADDRESS_CHECK_MS 1000    // Interval between checks for a changed claimed address
+
+// Actisense NGT forward of the NMEA2000 bus over USB serial (canboat actisense-serial/analyzer)
+#ifndef ACTISENSE_FORWARD_ENABLED
+#define ACTISENSE_FORWARD_ENABLED 0      // 1 = the console port carries binary N2K frames (env esp32dev_actisense); -D overrides
+#endif
+#define ACTISENSE_FORWARD_BAUD 921600     // Console baud while forwarding (NGT-1 style high-speed link)
+#define ACTISENSE_FORWARD_TX_BUFFER 4096  // UART TX ring drained by the driver ISR (~44 ms at 921600)
+#define ACTISENSE_FORWARD_OWN_MESSAGES 1  // Also forward the derived PGNs this gateway transmits
+
+// NMEA 2000 bus load and CAN controller error state (CanBusMonitor, sampled by the receive context)
+#define CAN_BUS_BITRATE 250000           // NMEA 2000 bit rate (bit/s)
+#define CAN_BUS_LOAD_BUCKET_MS 100       // Load bucket width
+#define CAN_BUS_LOAD_BUCKETS 51          // Buckets kept, one of them filling: 5 s longest window
+#define CAN_BUS_LOAD_SHORT_MS 1000       // Short window: OLED, transmit gate, peak
+#define CAN_BUS_LOAD_LONG_MS 5000        // Long window (GET /status)
+#define CAN_BUS_SAMPLE_MS 100            // Error counter / status register read interval
+
+// 1-Wire sensors (OneWireConversion cycle; OneWireSensorPoller, OneWireSensorTask in layout 1)
+#define ONEWIRE_TASK_ENABLED (POSEIDON_FEATURE_ONEWIRE && TASK_LAYOUT == 1)  // 1-Wire reads in their own task instead of the main loop
+#define ONEWIRE_TASK_CORE TASK_IO_CORE  // Core of the 1-Wire reader task
+#define ONEWIRE_TASK_STACK 3072      // 1-Wire reader task stack size (bytes)
+#define ONEWIRE_TASK_PRIORITY 1      // Same as the Arduino loop task; reads block on bus delays
+#define ONEWIRE_TASK_QUEUE_CAPACITY 8  // Readings queued for the main loop (power of two)
+#define ONEWIRE_APPLY_INTERVAL_MS 100  // I/O pump interval for applying queued readings to BoatData
+#define ONEWIRE_CYCLE_MS 1000        // Bus schedule slot: a conversion/read cycle may start this often
+#define ONEWIRE_SAILDRIVE_PERIOD_MS 1000  // Saildrive read period (multiple of ONEWIRE_CYCLE_MS)
+#define ONEWIRE_BATTERY_PERIOD_MS 2000    // Battery A/B read period
+#define ONEWIRE_SHORE_PERIOD_MS 2000      // Shore power read period
+#define ONEWIRE_CONVERSION_MS 10     // Convert V to results (DS2438 max 10 ms; 750 for a DS18B20 at 12 bit)
+#define ONEWIRE_STEP_BUDGET_US 1000  // Bus time per step (a reset or one or two bytes)
+#define ONEWIRE_TASK_STEP_MS 2       // Task layout: delay between steps
+#define ONEWIRE_DIGITAL_ON_V 2.5     // Saildrive / shore power input on at or above this VAD voltage
+#define ONEWIRE_SHUNT_OHMS 0.001     // Battery and shore current sense resistor
+#define ONEWIRE_BATTERY_DIVIDER 2.0  // Battery voltage divider into VAD (DS2438 VAD max 10 V)
+#define ONEWIRE_SOC_EMPTY_V 11.8     // Resting voltage at 0% (voltage-based state of charge)
+#define ONEWIRE_SOC_FULL_V 12.7      // Resting voltage at 100%
+#define ONEWIRE_SHORE_VOLTAGE_V 230.0  // Mains voltage for shore power = current x voltage
+#define ONEWIRE_HEALTH_TIMEOUT_MS 5000     // isBusHealthy(): a valid page within this long
+#define ONEWIRE_HEALTH_MAX_CRC_PERCENT 20  // isBusHealthy(): CRC errors per scheduled read at most this
+#define ONEWIRE_STATS_INTERVAL_MS 30000    // Interval between ONEWIRE_STATS log events
+#define ONEWIRE_MAP_CAPACITY 8             // Devices in the persisted ROM -> role map (record "ow_map")
+#define ONEWIRE_MISSING_FAILURES 5         // Failed reads in a row before a mapped device counts as missing
+#define ONEWIRE_SEARCH_RETRY_MS 60000      // Background ROM search at most this often while a device is missing
+
+// Onboard IMU (ICM-20948 on the OLED I2C bus; ImuAttitudeSource, heel and pitch as SensorType::ATTITUDE)
+#ifndef IMU_ENABLED
+#define IMU_ENABLED 0                // 1 = heel/pitch from the onboard IMU; -D overrides
+#endif
+#define IMU_I2C_ADDRESS 0x69         // ICM-20948 with AD0 high (0x68 with AD0 low)
+#define IMU_SAMPLE_RATE_HZ 100       // Gyro and accelerometer FIFO rate (1125 / (1 + divider) Hz, 50-100)
+#define IMU_READ_INTERVAL_MS 100     // FIFO drained in one burst this often (10 samples at 100 Hz)
+#define IMU_BATCH_MAX 24             // Samples read per drain (12 bytes each); the rest wait for the next one
+#define IMU_I2C_CHUNK_BYTES 120      // Bytes per FIFO read transaction (10 samples, within the 128-byte Wire buffer)
+#define IMU_FILTER_TAU_S 2.0         // Complementary filter: gyro below this period, accelerometer above
+#define IMU_ACCEL_REJECT_G 0.15      // Accelerometer ignored while |a| is further than this from 1 g (slamming)
+
+// Read-only data tables (partition "tables" in partitions.csv, mapped in place; utils/DataTables.h)
+#define DATA_TABLES_PARTITION "tables"       // Partition label (data, subtype DATA_TABLES_SUBTYPE)
+#define DATA_TABLES_SUBTYPE 0x40             // Custom data subtype of the partition
+#define DATA_TABLES_MAX_ENTRIES 16           // Directory entries accepted in an image
+#define VARIATION_GRID_INTERVAL_MS 10000     // Grid variation (no variation source) checked this often ...
+#define VARIATION_GRID_GPS_FRESH_MS 5000     // ... and written only if the GPS position updated within this
+
+// NMEA2000 transmit (derived data published by N2kTransmitScheduler)
+#define N2K_TX_ENABLED 1                 // 0 = never transmit derived PGNs
+#define N2K_TX_SCHEDULE_INTERVAL_MS 50   // Main-loop scheduler pass interval
+#define N2K_TX_MAX_JOBS 8                // Periodic transmit PGNs
+#define N2K_TX_QUEUE_CAPACITY 8          // Built messages awaiting send (power of two)
+#define N2K_TX_BUS_LOAD_PCT 5            // Share of the 250 kbit/s bus our transmits may use
+#define N2K_TX_MAX_BUS_LOAD_PCT 70       // Periodic transmits only fill the headroom below this measured load (1 s)
+#define N2K_TX_BURST_FRAMES 12           // Frame budget that may be spent in one pass
+#define N2K_CAN_FRAME_BITS 128           // Extended frame incl. typical bit stuffing
+#define N2K_TX_MAX_DATA_AGE_MS 2000      // Derived data older than this is not sent
+#define N2K_TX_STATS_INTERVAL_MS 10000   // Interval between N2K_TX_STATS log events
+#define N2K_TX_PERIOD_130306_MS 1000     // True wind
+#define N2K_TX_PRIORITY_130306 2
+#define N2K_TX_PERIOD_128000_MS 1000     // Leeway
+#define N2K_TX_PRIORITY_128000 4
+#define N2K_TX_PERIOD_130577_MS 1000     // Set & drift (Direction Data)
+#define N2K_TX_PRIORITY_130577 3
+
+// Autopilot fast path (127250/127251 -> sentences on the NMEA 0183 TX line, utils/AutopilotForward.h)
+#ifndef AP_FORWARD_ENABLED
+#define AP_FORWARD_ENABLED 0             // 1 = forward heading/rate of turn from the N2k receive context (env:esp32dev_autopilot)
+#endif
+#define AP_FORWARD_SENTENCES 0x0B        // AutopilotSentence bits: 0x01 HDM, 0x02 HDG, 0x04 HDT, 0x08 ROT
+#define AP_FORWARD_TALKER "HC"           // Talker of the forwarded sentences (heading: magnetic compass)
+#define AP_FORWARD_MIN_INTERVAL_MS 50    // A sentence type is sent at most this often (20 Hz)
+#define AP_FORWARD_LATENCY_BUDGET_US 2000  // Frame arrival to UART FIFO; slower messages are counted
+
+// NMEA0183 serial input (Serial2, see ESP32UartEventPort)
+#define NMEA0183_UART_EVENT_MODE 1       // 0 = Arduino HardwareSerial polling, 1 = ESP-IDF UART event queue
+#define NMEA0183_UART_RX_BUFFER 4096     // IDF driver RX ring filled by the UART ISR (bytes)
+#define NMEA0183_UART_EVENT_QUEUE 20     // UART driver event queue depth
+#define NMEA0183_UART_PATTERN_QUEUE 16   // '\n' positions remembered by pattern detection
+#define NMEA0183_UART_SENTENCE_BUFFER 2048  // Complete sentences awaiting the parser (power of two)
+#define NMEA0183_UART_TASK_STACK 3072    // Sentence reader task stack size (bytes)
+#define NMEA0183_UART_TASK_PRIORITY 2    // Above the Arduino loop task (1), below the N2k receive task
+#define NMEA0183_UART_TASK_CORE (TASK_LAYOUT == 1 ? TASK_IO_CORE : TASK_APP_CORE)  // Core of the sentence reader task
+#define NMEA0183_UART_STATS_INTERVAL_MS 30000  // Interval between UART_RX_STATS/N0183_PORT_STATS log events
+
+// NMEA0183 multi-port input (NMEA0183Handler drains all ports from one reactor)
+#define NMEA0183_MAX_PORTS 3             // Serial2 + second serial input + network input
+#define NMEA0183_MAX_PORT_SOURCES 4      // Talker/sensor sources tracked per port
+#define NMEA0183_STATS_SLOTS 32          // Per-(sentence type, talker) statistics hash slots (power of two)
+#define NMEA0183_STATS_MAX_ENTRIES 24    // Entries tracked before new pairs are only counted as overflow
+#define NMEA0183_STATS_RATE_ALPHA 0.1f   // EWMA weight of the newest inter-arrival time
+#define NMEA0183_FIX_FUSION_TIMEOUT_MS 500  // RMC/GGA/VTG of one fix published incomplete after this
+#define NMEA0183_ROUTES_FILE "/nmea0183-routes.json"  // Talker/sentence routing table (optional)
+#define NMEA0183_MAX_ROUTES 32           // (port, talker, sentence) routes loaded from the file
+#define NMEA0183_ROUTES_JSON_CAPACITY 4096  // ArduinoJson document size for the routing file (boot and live reload, released after parsing)
+#define NMEA0183_ROUTES_MAX_BYTES 4096   // Largest routing file accepted by POST /upload-nmea0183-routes
+#define NMEA0183_ROUTES_UPLOAD_SUFFIX ".new" // Uploaded routing file staged next to NMEA0183_ROUTES_FILE until validated
+#define NMEA0183_PORT2_ENABLED 0         // 1 = second NMEA 0183 input on UART1
+#define NMEA0183_PORT2_RX_PIN 33         // Second input RX GPIO
+#define NMEA0183_PORT2_TX_PIN -1         // Input only (-1 = no TX pin; GPIO32 is CAN TX)
+#define NMEA0183_PORT2_BAUD 4800         // NMEA 0183 standard rate (e.g., standalone GPS)
+#define NMEA0183_PORT2_SOURCE_PREFIX "N0183-P2"  // Source IDs "N0183-P2-<talker>" (max 12 chars)
+#define NMEA0183_PORT2_TALKER_A "GP"     // Talker whitelist ("" = unused slot)
+#define NMEA0183_PORT2_TALKER_B "GN"
+
+// NMEA0183 network input from a Wi-Fi multiplexer (ESP32NetworkSentencePort)
+#define NMEA0183_NET_ENABLED 0           // 1 = network input as an additional NMEA0183Handler port
+#define NMEA0183_NET_MODE 0              // 0 = UDP broadcast listener, 1 = TCP client
+#define NMEA0183_NET_PORT 10110          // UDP listen port / TCP server port
+#define NMEA0183_NET_HOST "192.168.4.1"  // TCP server (multiplexer access point address)
+#define NMEA0183_NET_QUEUE_DEPTH 16      // Whole sentences awaiting the parser (power of two)
+#define NMEA0183_NET_RECONNECT_MS 5000   // TCP reconnect interval
+#define NMEA0183_NET_SOURCE_PREFIX "N0183-NET"  // Source IDs "N0183-NET-<talker>"
+
+// NMEA0183 TCP stream (N2k/BoatData converted by NMEA0183TcpGateway)
+#define N0183_TCP_ENABLED 1              // 0 = no TCP sentence stream
+#define N0183_TCP_PORT 10110             // Conventional NMEA-over-TCP port
+#define N0183_TCP_MAX_CLIENTS 4          // Simultaneous stream clients
+#define N0183_TCP_BUFFER_SIZE 2048       // Shared sentence ring (power of two)
+#define N0183_TCP_SERVICE_INTERVAL_MS 50 // Encode + send pass interval
+#define N0183_TCP_TALKER "II"            // Talker ID of converted sentences
+#define N0183_TCP_MAX_DATA_AGE_MS 3000   // Data older than this is not converted
+#define N0183_TCP_INTERVAL_HDG_MS 200    // Min interval per sentence type
+#define N0183_TCP_INTERVAL_HDM_MS 200
+#define N0183_TCP_INTERVAL_RSA_MS 200
+#define N0183_TCP_INTERVAL_MWV_MS 200
+#define N0183_TCP_INTERVAL_MWD_MS 1000
+#define N0183_TCP_INTERVAL_DPT_MS 1000
+#define N0183_TCP_INTERVAL_VHW_MS 500
+#define N0183_TCP_INTERVAL_RMC_MS 1000
+#define N0183_TCP_STALL_TIMEOUT_MS 2000  // Client with a full send buffer this long is dropped
+#define N0183_TCP_STATS_INTERVAL_MS 30000  // Interval between N0183_TCP_STATS log events
+
+// AIS collision check (AisTargetTable: !AIVDM on an NMEA 0183 port, PGN 129038/129039; /ais routes and WebSocket)
+// For an AIS receiver on port 2 set NMEA0183_PORT2_TALKER_A "AI" (and _B "AB" for an AIS base station feed)
+#define AIS_ENABLED 1                    // 0 = no target table, AIS handlers, routes or WebSocket
+#define AIS_MAX_TARGETS 200              // Vessels tracked (slab slots, 80 bytes each)
+#define AIS_HASH_SLOTS 512               // MMSI open-addressing hash (power of two, > 2 x AIS_MAX_TARGETS)
+#define AIS_GRID_CELL_NM 4.0f            // Grid cell edge: nautical miles north-south, minutes of longitude east-west
+#define AIS_GRID_BUCKETS 256             // Hashed grid cell buckets (power of two, above the cells a risk radius query covers)
+#define AIS_RISK_RADIUS_NM 12.0f         // Targets within this range are re-evaluated every pass (own ship moves)
+#define AIS_CPA_ALARM_NM 1.0f            // Collision risk: CPA below this ...
+#define AIS_TCPA_ALARM_S 1200.0f         // ... within this many seconds, or current range below AIS_CPA_ALARM_NM
+#define AIS_RISK_MAX 16                  // Risk list entries (most urgent by TCPA)
+#define AIS_TARGET_TIMEOUT_MS 360000     // Target dropped this long after its last position report (class B at anchor: 3 min)
+#define AIS_EXPIRE_SWEEP 32              // Slots checked for expiry per evaluation pass
+#define AIS_EVALUATE_INTERVAL_MS 1000    // CPA/TCPA pass and /ais WebSocket push (1 Hz)
+#define AIS_REPORT_QUEUE_CAPACITY 32     // PGN 129038/129039 reports from the NMEA2000 context awaiting the main loop (power of two)
+#define AIS_MAX_CLIENTS 2                // Simultaneous /ais WebSocket clients
+#define AIS_WS_JSON_SIZE 2048            // Risk list message buffer (WsBufferPool frame)
+
+// UTC clock from the bus (UtcClock): PGN 126992 first, then RMC date/time
+#define UTC_CLOCK_STEP_MS 2000             // Offset error above this steps the clock instead of slewing
+#define UTC_CLOCK_SLEW_DIVISOR 8           // Share (1/n) of a smaller error corrected per sample
+#define UTC_CLOCK_SOURCE_TIMEOUT_MS 10000  // A source silent this long yields to the next one
+#define UTC_CLOCK_UPDATE_INTERVAL_MS 1000  // Discipline pass and base refresh (main loop)
+
+// Raw bus capture/replay on LittleFS (BusCapture, BusReplay, /capture/* and /replay/*)
+#define BUS_CAPTURE_ENABLED 1            // 0 = no capture/replay routes or writer task
+#define BUS_CAPTURE_PATH "/capture.bin"  // Single capture file (replaced by each capture/upload)
+#define BUS_CAPTURE_PSRAM_BUFFER_SIZE 16384  // Each of the two write buffers in PSRAM (bytes)
+#define BUS_CAPTURE_BUFFER_SIZE 4096     // Each of the two write buffers without PSRAM (bytes)
+#define BUS_CAPTURE_FRAME_QUEUE 128      // CAN frames from the receive context awaiting encoding (power of two)
+#define BUS_CAPTURE_FLUSH_MS 1000        // A partly filled buffer is written after this
+#define BUS_CAPTURE_MAX_BYTES 524288     // Capture stops by itself at this file size
+#define BUS_CAPTURE_SERVICE_INTERVAL_MS 10  // Capture encode / replay release pass interval
+#define BUS_CAPTURE_TASK_STACK 3072      // Flash writer task stack size (bytes)
+#define BUS_CAPTURE_TASK_PRIORITY 1      // Same as the Arduino loop task; flash writes only
+#define BUS_CAPTURE_TASK_CORE 1          // Core of the flash writer task
+#define BUS_REPLAY_CHUNK_SIZE 512        // File read size per refill
+#define BUS_REPLAY_MAX_RECORDS_PER_PASS 64  // Records released per replay pass at most
+#define BUS_REPLAY_MAX_SPEED 20          // Highest ?speed= multiplier (besides max)
+#define PIPELINE_LATENCY_ENABLED 1       // BoatData write to WebSocket latency per replay (PipelineLatency, GET /replay/latency)
+
+// Synthetic NMEA 2000 load into the CAN RX queue for throughput tests (N2kLoadGenerator, /n2k/load/*)
+#define N2K_LOAD_ENABLED 1               // 0 = no load generator or routes
+#define N2K_LOAD_BITRATE 250000          // NMEA 2000 bus bit rate (bit/s)
+#define N2K_LOAD_BITS_PER_FRAME 131      // 8-byte extended frame without stuff bits: 100% = 1908 frames/s
+#define N2K_LOAD_SERVICE_INTERVAL_MS 5   // Generator pass interval (main loop)
+#define N2K_LOAD_MAX_FRAMES_PER_PASS 64  // Frames injected per pass at most
+#define N2K_LOAD_MAX_MIX 24              // PGNs in one mix
+#define N2K_LOAD_DEFAULT_DURATION_S 30   // Run length without ?duration=
+#define N2K_LOAD_MAX_DURATION_S 600      // Longest run
+#define N2K_LOAD_SOURCE 200              // Source address of generated frames
+#define N2K_LOAD_DEFAULT_MIX "127250:10,127251:10,127257:10,129025:10,130306:10,127488:10,129026:4,127489:2,127505:1,127252:1,127258:1,128259:1,128267:1,129029:1,129284:1,130316:1,127506:1,127508:1,129539:1,130310:1,130311:1,130312:1"  // Every handled PGN at typical bus rates (Hz)
+#define N2K_LOAD_IGNORED_PGNS "130314,128275,129283,129540"  // Unhandled PGNs behind ?ignored=
+
+// BoatData field history for trend graphs (HistoryRecorder, /history routes)
+#define HISTORY_ENABLED 1                // 0 = no history storage or routes
+#define HISTORY_FIELD_MASK 0x0F          // HistoryField bits: depth, TWS, heading, battery A (see HistoryRecorder.h)
+#define HISTORY_SAMPLE_INTERVAL_MS 250   // Main loop sampling interval
+#define HISTORY_STALE_MS 5000            // Older group data is recorded as a gap
+#define HISTORY_TIER0_PERIOD_MS 1000     // Bucket length of each tier (each a multiple of the previous)
+#define HISTORY_TIER1_PERIOD_MS 10000
+#define HISTORY_TIER2_PERIOD_MS 60000
+#define HISTORY_TIER0_CAPACITY 600       // Buckets per tier: 10 min of 1 s
+#define HISTORY_TIER1_CAPACITY 360       // 1 h of 10 s
+#define HISTORY_TIER2_CAPACITY 1440      // 24 h of 1 min (6 bytes per bucket, 14.4 KB per field)
+#define HISTORY_INTERNAL_RAM_DIVISOR 4   // Capacities are divided by this without PSRAM
+
+// On-device voyage recorder: rotating delta-compressed BoatData segments (VoyageRecorder, /voyage routes)
+#define VOYAGE_LOG_ENABLED 1             // 0 = no recorder task, segment files or routes
+#define VOYAGE_LOG_INTERVAL_MS 2000      // One record per interval (skipped while no group is available)
+#define VOYAGE_LOG_PATH_PREFIX "/voyage" // Segment files /voyage0.bin .. /voyage<N-1>.bin
+#define VOYAGE_LOG_SEGMENTS 4            // Rotating segment files; the oldest is overwritten
+#define VOYAGE_LOG_SEGMENT_BYTES 16384   // A segment is closed before it grows past this (min_spiffs: ~128 KB LittleFS)
+#define VOYAGE_LOG_KEYFRAME_RECORDS 30   // A full snapshot (seek point) every N records
+#define VOYAGE_LOG_INDEX_ENTRIES 32      // Keyframes indexed per segment; a full index closes the segment
+#define VOYAGE_LOG_BUFFER_SIZE 1024      // Each of the two write buffers (bytes, PSRAM when present)
+#define VOYAGE_LOG_FLUSH_MS 10000        // A partly filled buffer is written after this (lost on power cut)
+#define VOYAGE_LOG_TASK_STACK 3072       // Flash writer task stack size (bytes)
+#define VOYAGE_LOG_TASK_PRIORITY 1       // Same as the Arduino loop task; flash writes only
+#define VOYAGE_LOG_TASK_CORE 1           // Core of the flash writer task
+
+// Engine and saildrive event journal: transitions as 16-byte records in a LittleFS ring file (EngineJournal, /journal route)
+#define ENGINE_JOURNAL_ENABLED 1         // 0 = no journal subscription, ring file or route
+#define ENGINE_JOURNAL_FILE "/engine-journal.bin" // Ring file, record s in slot (s - 1) % ENGINE_JOURNAL_CAPACITY
+#define ENGINE_JOURNAL_CAPACITY 512      // Records kept (16 B each: 8 KB of LittleFS)
+#define ENGINE_JOURNAL_BLOCK_RECORDS 32  // Records per index block (UTC time range held in RAM for range queries)
+#define ENGINE_JOURNAL_PENDING 16        // Transitions held in RAM until the write-behind save (more are dropped and counted)
+#define ENGINE_JOURNAL_MIN_INTERVAL_MS 200 // Engine/saildrive changes checked at most this often
+#define ENGINE_JOURNAL_RUNNING_RPM 300   // Engine running at or above this RPM (start/stop)
+#define ENGINE_JOURNAL_CRUISE_RPM 1200   // RPM bands: idle below, cruise from here ...
+#define ENGINE_JOURNAL_HIGH_RPM 2400     // ... high from here ...
+#define ENGINE_JOURNAL_MAX_RPM 3000      // ... max from here
+#define ENGINE_JOURNAL_RPM_HYSTERESIS 100 // A band (or running) is left only this far below its lower edge
+#define ENGINE_JOURNAL_OVERTEMP_C 95.0f  // Oil temperature overtemperature event ...
+#define ENGINE_JOURNAL_OVERTEMP_HYSTERESIS_C 5.0f // ... cleared this far below it
+#define ENGINE_JOURNAL_QUERY_MAX 20      // Records per GET /journal/engine page
+
+// Engine hours, distance log, battery amp-hours and shore energy (TripCounters, /counters routes)
+#define TRIP_COUNTERS_ENABLED 1          // 0 = no counters, NVS record or routes
+#define TRIP_SAMPLE_INTERVAL_MS 1000     // Integration step (main loop reaction)
+#define TRIP_STALE_MS 5000               // A group not updated for this long adds nothing
+#define TRIP_MAX_GAP_MS 10000            // A longer gap between samples is skipped, not integrated
+#define TRIP_SOG_MIN_KN 0.3              // SOG below this is GPS jitter, not distance
+#define TRIP_COMMIT_INTERVAL_MS 600000   // Any change is written to NVS after 10 minutes
+#define TRIP_COMMIT_MIN_INTERVAL_MS 60000 // ...a significant one after 1 minute at the earliest
+#define TRIP_COMMIT_ENGINE_STEP_S 360    // Significant: 0.1 engine hours
+#define TRIP_COMMIT_DISTANCE_STEP_NM 1.0 // Significant: 1 nm
+#define TRIP_COMMIT_AH_STEP 5.0          // Significant: 5 Ah in or out of a bank
+#define TRIP_COMMIT_KWH_STEP 0.5         // Significant: 0.5 kWh of shore power
+#define TRIP_COMMIT_DAILY_BUDGET 200.0f  // NVS writes per day (token bucket refill; 60 B record, ~1 KB of flash wear per day)
+#define TRIP_COMMIT_BURST 20.0f          // Bucket size: commits possible back to back after a quiet period
+#define TRIP_SUPPLY_BANK 0               // Battery bank powering the gateway (0 = A, 1 = B)
+#define TRIP_LOW_VOLTAGE_V 11.0          // Supply below this forces a commit before a brownout (0 = off)
+#define TRIP_LOW_VOLTAGE_HYSTERESIS_V 0.3 // Re-armed once the supply is this far above the threshold
+
+// Coulomb-counting state of charge per bank (BatterySocEstimator, fed and persisted by TripCounters)
+#define BATTERY_SOC_ENABLED 1            // 0 = BatteryData keeps the monitors' voltage-based state of charge
+#define BATTERY_A_CAPACITY_AH 200.0      // Rated (20-hour) capacity of bank A
+#define BATTERY_B_CAPACITY_AH 100.0      // Rated capacity of bank B
+#define BATTERY_PEUKERT_RATED_H 20.0     // Discharge time of the rated capacity
+#define BATTERY_PEUKERT_EXPONENT 1.25    // Peukert k (1.0 = none; flooded lead-acid 1.2-1.3, LiFePO4 ~1.05)
+#define BATTERY_CHARGE_EFFICIENCY 0.90   // Fraction of the charge current stored
+#define BATTERY_REST_CURRENT_A 0.5       // Below this the bank is at rest (and no time to empty/full)
+#define BATTERY_REST_MS 1800000          // Rest this long on a voltage plateau re-anchors from the voltage
+#define BATTERY_REST_PLATEAU_V 0.02      // Plateau: resting voltage within this band (else the window restarts)
+#define BATTERY_TIME_TAU_MS 120000       // Time constant of the current average for time to empty/full
+#define BATTERY_SOC_COMMIT_STEP_PCT 2.0  // Significant: a re-anchor moving the estimate this far
+
+// Anchor watch and threshold alarms (AlarmEngine: rules from ALARM_RULES_FILE, PGN 126983, /alarms routes)
+#define ALARM_ENABLED 1                  // 0 = no alarm engine, subscription, alerts or routes
+#define ALARM_RULES_FILE "/alarms.conf"  // One rule per line: <type> <threshold> <hysteresis> <delay_s> [instance]
+#define ALARM_RULES_MAX_BYTES 1024       // Larger rule files are refused (boot, POST /alarms/rules)
+#define ALARM_RULES_UPLOAD_SUFFIX ".new" // Uploaded rule file staged next to ALARM_RULES_FILE until validated
+#define ALARM_MAX_RULES 8                // Rule table entries
+#define ALARM_EVENT_QUEUE 8              // Raised/cleared transitions awaiting the main loop (log, PGN 126983, OLED)
+#define ALARM_MIN_INTERVAL_MS 500        // Rules re-evaluated on input changes at most this often
+#define ALARM_HEARTBEAT_MS 1000          // Pending rules (delay running) re-checked this often without changes
+#define ALARM_N2K_REPEAT_MS 5000         // Active alarms re-sent as PGN 126983 this often (transitions at once)
+#define ALARM_N2K_ALERT_SYSTEM 1         // PGN 126983 alert system of this gateway's alerts
+#define ALARM_FLASH_INTERVAL_MS 500      // OLED alarm screen on/off phase while an alarm is active
+#define ALARM_DEFAULT_ANCHOR_RADIUS_M 40.0f  // Built-in rules without ALARM_RULES_FILE: drag radius ...
+#define ALARM_DEFAULT_SHALLOW_M 2.5f     // ... depth below the transducer
+#define ALARM_DEFAULT_BATTERY_LOW_V 11.8f  // ... house bank (A) voltage
+
+// Per-reaction ReactESP loop profiler (ReactionProfiler, GET /reactions)
+#define REACTION_PROFILER_ENABLED 1      // 0 = reactions registered unprofiled, no route
+#define REACTION_PROFILER_MAX_REACTIONS 32  // Profiled reactions (48 bytes each); later ones run unprofiled
+#define REACTION_PROFILER_OLED_PAGE 1    // 1 = the OLED page rotation includes the top reactions
+
+// Trace event timelines (TraceRecorder, GET /trace)
+#ifndef TRACE_ENABLED
+#define TRACE_ENABLED 1                  // 1 = TRACE_* spans recorded, GET /trace (Chrome trace JSON); -D overrides
+#endif
+#define TRACE_RING_EVENTS 512            // Trace events kept in PSRAM (power of two, 16 bytes each)
+#define TRACE_RING_INTERNAL_EVENTS 128   // Trace events kept without PSRAM (power of two)
+
+// Allocations per code section (AllocTracker, ALLOC_SCOPE, GET /memory "allocs")
+#ifndef ALLOC_TRACK_ENABLED
+#ifdef UNIT_TEST
+#define ALLOC_TRACK_ENABLED 1            // Host tests: scopes counted (test/helpers/alloc_hooks.h feeds them)
+#else
+#define ALLOC_TRACK_ENABLED 0            // 1 = heap hooks feed the scopes (test and soak builds); -D overrides
+#endif
+#endif
+#define ALLOC_TRACK_MAX_TAGS 32          // Tags counted (40 bytes each); later ones count as dropped
+#define ALLOC_TRACK_MAX_DEPTH 6          // Nested scopes counted (reaction > handler > helper)
+
+// Soak runs: one metric row per minute to a LittleFS CSV, trend flags (SoakRecorder, GET /soak)
+#ifndef SOAK_ENABLED
+#define SOAK_ENABLED 0                   // 1 = soak recorder and routes, load kept running (esp32dev_soak); -D overrides
+#endif
+#define SOAK_SAMPLE_INTERVAL_MS 60000    // One CSV row per interval
+#define SOAK_SERVICE_INTERVAL_MS 1000    // Soak reaction: keeps the load running, samples when due
+#define SOAK_CSV_PATH "/soak.csv"
+#define SOAK_CSV_PREVIOUS_PATH "/soak.prev.csv"  // The file before the last rotation
+#define SOAK_CSV_MAX_BYTES 49152         // Rotate before the CSV grows past this (~600 rows, 10 h)
+#define SOAK_TREND_WINDOW 30             // Samples in the trend test (30 min)
+#define SOAK_TREND_FLAG_PCT 80           // Kendall tau (%) in the bad direction that flags a column
+#define SOAK_TREND_CLEAR_PCT 50          // Flag cleared once tau falls below this
+#define SOAK_REPLAY_SPEED 10             // Bus capture replayed in a loop at this multiplier (0 = no replay)
+#ifndef SOAK_N2K_LOAD_PCT
+#define SOAK_N2K_LOAD_PCT 0              // Synthetic NMEA 2000 load kept running (% of the bus, 0 = none); -D overrides
+#endif
 
 #endif // CONFIG_H
@@ -0,0 +1,15 @@
+#include "ESP32ActisenseForwardPort.h"
+
+ESP32ActisenseForwardPort::ESP32ActisenseForwardPort(HardwareSerial& serial, size_t txBufferBytes)
+    : serial_(serial),
+      txBufferBytes_(txBufferBytes) {
+}
+
+size_t ESP32ActisenseForwardPort::write(const uint8_t* data, size_t size) {
+    int freeBytes = serial_.availableForWrite();
+    if (!stats_.admit(size, freeBytes > 0 ? static_cast<size_t>(freeBytes) : 0, txBufferBytes_)) {
+        return 0;
+    }
+    // Fits the ring: copied into it, no wait on the UART
+    return serial_.write(data, size);
+}
@@ -0,0 +1,72 @@
+#ifndef ESP32ACTISENSEFORWARDPORT_H
+#define ESP32ACTISENSEFORWARDPORT_H
+
+#include <Arduino.h>
+#include "utils/ActisenseForwardStats.h"
+
+/**
+ * @file ESP32ActisenseForwardPort.h
+ * @brief Non-blocking NMEA2000 forward stream over the USB serial console
+ *
+ * Forward stream for tNMEA2000::SetForwardStream() in Actisense mode: every
+ * received (and own transmitted) message leaves as an Actisense NGT N2K frame
+ * (command 0x93), the format canboat's actisense-serial and analyzer read
+ * from a real NGT-1. HardwareSerial::write() blocks while the UART TX ring is
+ * full; this wrapper instead drops a frame that does not fit whole
+ * (ActisenseForwardStats), so a slow or absent reader costs the receive
+ * context one memcpy per message and nothing else. The UART driver's
+ * interrupt drains the ring into the hardware FIFO at the configured baud.
+ *
+ * The TX ring is sized with HardwareSerial::setTxBufferSize() before
+ * begin(); pass the same size here for the high-water mark.
+ *
+ * Debug text printed on the same port lands between frames; the Actisense
+ * readers skip bytes outside DLE STX ... DLE ETX.
+ *
+ * Usage:
+ * @code
+ * Serial.setTxBufferSize(ACTISENSE_FORWARD_TX_BUFFER);
+ * Serial.begin(ACTISENSE_FORWARD_BAUD);
+ * ESP32ActisenseForwardPort forward(Serial, ACTISENSE_FORWARD_TX_BUFFER);
+ * nmea2000->SetForwardStream(&forward);
+ * nmea2000->SetForwardType(tNMEA2000::fwdt_Actisense);
+ * nmea2000->EnableForward(true);
+ * @endcode
+ *
+ * @note Write side only: available()/read()/peek() report an empty input.
+ */
+class ESP32ActisenseForwardPort : public Stream {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param serial Port already begun with its TX ring
+     * @param txBufferBytes Size of that TX ring (setTxBufferSize())
+     */
+    ESP32ActisenseForwardPort(HardwareSerial& serial, size_t txBufferBytes);
+
+    int available() override { return 0; }
+    int read() override { return -1; }
+    int peek() override { return -1; }
+    void flush() override {}  // Never wait for the UART
+
+    size_t write(uint8_t byte) override { return write(&byte, 1); }
+
+    /**
+     * @brief Queue one whole frame, or drop and count it if the ring lacks room
+     *
+     * @return @p size if queued, 0 if dropped
+     */
+    size_t write(const uint8_t* data, size_t size) override;
+
+    int availableForWrite() override { return serial_.availableForWrite(); }
+
+    const ActisenseForwardStats& getStats() const { return stats_; }
+
+private:
+    HardwareSerial& serial_;
+    size_t txBufferBytes_;
+    ActisenseForwardStats stats_;
+};
+
+#endif // ESP32ACTISENSEFORWARDPORT_H
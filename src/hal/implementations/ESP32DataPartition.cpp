@@ -0,0 +1,21 @@
+#include "ESP32DataPartition.h"
+#include "../../config.h"
+
+bool ESP32DataPartition::map() {
+    if (data_ != nullptr) {
+        return true;
+    }
+    const esp_partition_t* partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, static_cast<esp_partition_subtype_t>(DATA_TABLES_SUBTYPE), DATA_TABLES_PARTITION);
+    if (partition == nullptr) {
+        return false;
+    }
+
+    const void* mapped = nullptr;
+    if (esp_partition_mmap(partition, 0, partition->size, SPI_FLASH_MMAP_DATA, &mapped, &handle_) != ESP_OK) {
+        return false;
+    }
+    data_ = static_cast<const uint8_t*>(mapped);
+    size_ = partition->size;
+    return true;
+}
@@ -0,0 +1,46 @@
+#ifndef ESP32DATAPARTITION_H
+#define ESP32DATAPARTITION_H
+
+#include <Arduino.h>
+#include <esp_partition.h>
+
+/**
+ * @file ESP32DataPartition.h
+ * @brief Read-only mapping of the data tables partition
+ *
+ * Finds the DATA_TABLES_PARTITION partition (data, DATA_TABLES_SUBTYPE)
+ * and maps it into the data address space with esp_partition_mmap. Reads
+ * then go through the flash cache like const data of the firmware: no RAM
+ * beyond an MMU page entry, nothing copied at boot. The mapping is kept for
+ * the lifetime of the device, the tables point into it.
+ *
+ * Cached flash must be read with aligned 32-bit accesses; DataTables and
+ * its readers copy fields out with memcpy.
+ *
+ * Usage:
+ * @code
+ * ESP32DataPartition partition;
+ * if (partition.map()) tables.open(partition.data(), partition.size());
+ * @endcode
+ */
+class ESP32DataPartition {
+public:
+    ESP32DataPartition() : data_(nullptr), size_(0), handle_(0) {}
+
+    /**
+     * @brief Map the whole partition
+     *
+     * @return false if the partition table has no such partition or the map failed
+     */
+    bool map();
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+    spi_flash_mmap_handle_t handle_;
+};
+
+#endif // ESP32DATAPARTITION_H
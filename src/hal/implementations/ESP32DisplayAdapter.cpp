@@ -7,6 +7,8 @@
  */
 
 #include "ESP32DisplayAdapter.h"
+#include "utils/BigDigitFont.h"
+#include <string.h>
 
 #ifdef ARDUINO
 #include <Arduino.h>
@@ -19,14 +21,25 @@
 #define OLED_SDA 21           // GPIO21 for I2C Bus 2
 #define OLED_SCL 22           // GPIO22 for I2C Bus 2
 #define I2C_CLOCK_SPEED 400000  // 400kHz fast mode
+#define I2C_DATA_CHUNK 31       // Data bytes per I2C transaction (control byte + 31 fit the Wire buffer of any core)
 
 ESP32DisplayAdapter::ESP32DisplayAdapter()
-    : _display(nullptr), _isReady(false) {
+    : _display(nullptr),
+      _flushTask(nullptr),
+      _isReady(false),
+      _textSize(1),
+      _flushBusy(false),
+      _framesSent(0),
+      _framesSkipped(0) {
     // Create Adafruit_SSD1306 instance
     _display = new Adafruit_SSD1306(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 }
 
 ESP32DisplayAdapter::~ESP32DisplayAdapter() {
+    if (_flushTask != nullptr) {
+        vTaskDelete(_flushTask);
+        _flushTask = nullptr;
+    }
     // Clean up display object
     if (_display != nullptr) {
         delete _display;
@@ -52,10 +65,21 @@ bool ESP32DisplayAdapter::init() {
         // Configure display defaults
         _display->clearDisplay();
         _display->setTextSize(1);      // Font size 1 = 5x7 pixels
-        _display->setTextColor(SSD1306_WHITE);  // White text on black background
+        _display->setTextColor(SSD1306_WHITE, SSD1306_BLACK);  // Opaque: a reprinted character replaces the old one
         _display->setCursor(0, 0);
         _display->display();  // Push clear buffer to hardware
+        _textSize = 1;
+        _dirty.clear();
         _isReady = true;
+
+#if OLED_FLUSH_TASK_ENABLED
+        // From here on only the flush task talks to the panel
+        if (_flushTask == nullptr &&
+            xTaskCreatePinnedToCore(flushTaskEntry, "oled", OLED_FLUSH_TASK_STACK, this,
+                                    OLED_FLUSH_TASK_PRIORITY, &_flushTask, OLED_FLUSH_TASK_CORE) != pdPASS) {
+            _flushTask = nullptr;  // Frames sent inline
+        }
+#endif
     } else {
         _isReady = false;
     }
@@ -66,6 +90,7 @@ bool ESP32DisplayAdapter::init() {
 void ESP32DisplayAdapter::clear() {
     if (_display != nullptr && _isReady) {
         _display->clearDisplay();
+        _dirty.markAll();
     }
 }
 
@@ -78,18 +103,114 @@ void ESP32DisplayAdapter::setCursor(uint8_t x, uint8_t y) {
 void ESP32DisplayAdapter::setTextSize(uint8_t size) {
     if (_display != nullptr && _isReady) {
         _display->setTextSize(size);
+        _textSize = size;
     }
 }
 
 void ESP32DisplayAdapter::print(const char* text) {
     if (_display != nullptr && _isReady && text != nullptr) {
+        int16_t x = _display->getCursorX();
+        int16_t y = _display->getCursorY();
         _display->print(text);
+
+        // Characters are 6x8 pixels per size step; a wrapped line dirties full rows
+        int16_t height = 8 * _textSize;
+        int16_t endY = _display->getCursorY();
+        if (endY == y) {
+            _dirty.markRect(x, y, _display->getCursorX() - x, height);
+        } else {
+            _dirty.markRect(0, y, OLED_SCREEN_WIDTH, endY - y + height);
+        }
+    }
+}
+
+void ESP32DisplayAdapter::drawBigNumber(uint8_t x, uint8_t page, const char* text) {
+    if (_display != nullptr && _isReady && text != nullptr) {
+        uint8_t columns = BigDigitDraw(_display->getBuffer(), x, page, text);
+        _dirty.markRect(x, page * 8, columns, BIG_DIGIT_HEIGHT);
     }
 }
 
 void ESP32DisplayAdapter::display() {
-    if (_display != nullptr && _isReady) {
-        _display->display();  // Push framebuffer to OLED via I2C
+    if (_display == nullptr || !_isReady) {
+        return;
+    }
+    if (!OLED_PARTIAL_UPDATE) {
+        _dirty.markAll();
+    }
+    if (!_dirty.isDirty()) {
+        return;
+    }
+    if (_flushBusy.load(std::memory_order_acquire)) {
+        _framesSkipped.fetch_add(1);
+        return;  // Previous frame still on the bus: the changes stay marked for the next call
+    }
+
+    // The back buffer is ours until the flush task is woken
+    const uint8_t* frame = _display->getBuffer();
+    uint8_t first = 0;
+    uint8_t last = 0;
+    for (uint8_t page = 0; page < OledDirtyRegion::PAGES; page++) {
+        if (_dirty.span(page, first, last)) {
+            size_t offset = page * OledDirtyRegion::COLUMNS + first;
+            memcpy(_backBuffer + offset, frame + offset, last - first + 1);
+        }
+    }
+    _sending = _dirty;
+    _dirty.clear();
+
+    if (_flushTask != nullptr) {
+        _flushBusy.store(true, std::memory_order_release);
+        xTaskNotifyGive(_flushTask);
+    } else {
+        transmit();
+        _framesSent.fetch_add(1);
+    }
+}
+
+void ESP32DisplayAdapter::flushTaskEntry(void* param) {
+    ESP32DisplayAdapter* self = static_cast<ESP32DisplayAdapter*>(param);
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        self->transmit();  // Blocks this task on I2C, not the main loop
+        self->_framesSent.fetch_add(1);
+        self->_flushBusy.store(false, std::memory_order_release);
+    }
+}
+
+void ESP32DisplayAdapter::transmit() {
+    if (_sending.isFull()) {
+        sendWindow(0, OledDirtyRegion::PAGES - 1, 0, OledDirtyRegion::COLUMNS - 1, _backBuffer, sizeof(_backBuffer));
+        return;
+    }
+    uint8_t first = 0;
+    uint8_t last = 0;
+    for (uint8_t page = 0; page < OledDirtyRegion::PAGES; page++) {
+        if (_sending.span(page, first, last)) {
+            sendWindow(page, page, first, last, _backBuffer + page * OledDirtyRegion::COLUMNS + first,
+                       last - first + 1);
+        }
+    }
+}
+
+void ESP32DisplayAdapter::sendWindow(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn,
+                                     const uint8_t* data, size_t length) {
+    // Horizontal addressing (set by begin()) fills the window left to right, page by page
+    const uint8_t window[] = {SSD1306_PAGEADDR, firstPage, lastPage, SSD1306_COLUMNADDR, firstColumn, lastColumn};
+    Wire.beginTransmission(SCREEN_ADDRESS);
+    Wire.write((uint8_t)0x00);  // Control byte: command stream
+    Wire.write(window, sizeof(window));
+    Wire.endTransmission();
+
+    size_t remaining = length;
+    while (remaining > 0) {
+        size_t chunk = remaining < I2C_DATA_CHUNK ? remaining : I2C_DATA_CHUNK;
+        Wire.beginTransmission(SCREEN_ADDRESS);
+        Wire.write((uint8_t)0x40);  // Control byte: data stream
+        Wire.write(data, chunk);
+        Wire.endTransmission();
+        data += chunk;
+        remaining -= chunk;
     }
 }
 
@@ -99,13 +220,15 @@ bool ESP32DisplayAdapter::isReady() const {
 
 #else
 // Stub implementation for native platform (tests use MockDisplayAdapter)
-ESP32DisplayAdapter::ESP32DisplayAdapter() : _isReady(false) {}
+ESP32DisplayAdapter::ESP32DisplayAdapter()
+    : _isReady(false), _textSize(1), _flushBusy(false), _framesSent(0), _framesSkipped(0) {}
 ESP32DisplayAdapter::~ESP32DisplayAdapter() {}
 bool ESP32DisplayAdapter::init() { return false; }
 void ESP32DisplayAdapter::clear() {}
 void ESP32DisplayAdapter::setCursor(uint8_t x, uint8_t y) { (void)x; (void)y; }
 void ESP32DisplayAdapter::setTextSize(uint8_t size) { (void)size; }
 void ESP32DisplayAdapter::print(const char* text) { (void)text; }
+void ESP32DisplayAdapter::drawBigNumber(uint8_t x, uint8_t page, const char* text) { (void)x; (void)page; (void)text; }
 void ESP32DisplayAdapter::display() {}
 bool ESP32DisplayAdapter::isReady() const { return false; }
 #endif
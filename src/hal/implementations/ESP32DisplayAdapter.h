@@ -8,9 +8,24 @@
  * Hardware: SH-ESP32 board with SSD1306 OLED at I2C address 0x3C
  * Library: Adafruit_SSD1306, Adafruit_GFX, Wire (I2C)
  *
+ * Partial updates (OLED_PARTIAL_UPDATE): clear() and print() mark what they
+ * touch in an OledDirtyRegion, and display() sends only the dirty column
+ * span of each changed page through SSD1306 page/column addressing. A
+ * frame that is dirty everywhere (after clear()) goes out as one full
+ * transfer. Text is drawn with a black background, so a character printed
+ * over another replaces it without a clear(). drawBigNumber() copies atlas
+ * columns into the Adafruit framebuffer and marks them the same way.
+ *
+ * Background flush (OLED_FLUSH_TASK_ENABLED): display() copies the dirty
+ * spans into a back buffer and wakes the "oled" task, which owns Wire after
+ * init() and sends them. The caller returns after a memcpy instead of
+ * blocking ~25 ms on a full frame. While a frame is still being sent,
+ * display() skips (counted) and keeps its changes marked, so the next call
+ * sends them. Without the task (creation failed) the frame is sent inline.
+ *
  * Constitutional Compliance:
  * - Principle I (Hardware Abstraction): Implements IDisplayAdapter interface
- * - Principle II (Resource Management): 1KB framebuffer (justified for display)
+ * - Principle II (Resource Management): 1KB framebuffer + 1KB back buffer (justified for display)
  * - Principle VII (Fail-Safe): init() returns false on I2C error
  *
  * @version 1.0.0
@@ -20,11 +35,15 @@
 #ifndef ESP32_DISPLAY_ADAPTER_H
 #define ESP32_DISPLAY_ADAPTER_H
 
+#include <atomic>
 #include "hal/interfaces/IDisplayAdapter.h"
+#include "utils/OledDirtyRegion.h"
 
 #ifdef ARDUINO
 #include <Adafruit_SSD1306.h>
 #include <Wire.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 #endif
 
 /**
@@ -37,8 +56,31 @@ class ESP32DisplayAdapter : public IDisplayAdapter {
 private:
 #ifdef ARDUINO
     Adafruit_SSD1306* _display;  ///< Adafruit SSD1306 driver instance
+    TaskHandle_t _flushTask;     ///< nullptr = frames sent inline
 #endif
     bool _isReady;                ///< True if init() succeeded
+    uint8_t _textSize;            ///< Font scale of the next print() (dirty rectangle height)
+    OledDirtyRegion _dirty;       ///< Framebuffer changes not handed to the flush yet
+    OledDirtyRegion _sending;     ///< Spans of _backBuffer being sent (flush task while busy)
+    uint8_t _backBuffer[OledDirtyRegion::PAGES * OledDirtyRegion::COLUMNS];
+    std::atomic<bool> _flushBusy; ///< Back buffer owned by the flush task
+    std::atomic<uint32_t> _framesSent;
+    std::atomic<uint32_t> _framesSkipped;
+
+#ifdef ARDUINO
+    /**
+     * @brief Send the _sending spans of _backBuffer (flush task, or inline)
+     */
+    void transmit();
+
+    /**
+     * @brief Send @p length bytes into the page/column window
+     */
+    void sendWindow(uint8_t firstPage, uint8_t lastPage, uint8_t firstColumn, uint8_t lastColumn,
+                    const uint8_t* data, size_t length);
+
+    static void flushTaskEntry(void* param);
+#endif
 
 public:
     /**
@@ -59,8 +101,20 @@ public:
     void setCursor(uint8_t x, uint8_t y) override;
     void setTextSize(uint8_t size) override;
     void print(const char* text) override;
+    void drawBigNumber(uint8_t x, uint8_t page, const char* text) override;
     void display() override;
     bool isReady() const override;
+
+    /// Frames handed to I2C (full or partial)
+    uint32_t getFramesSent() const { return _framesSent.load(); }
+
+    /// display() calls skipped because the previous frame was still being sent
+    uint32_t getFramesSkipped() const { return _framesSkipped.load(); }
+
+#ifdef ARDUINO
+    /// Flush task (nullptr before init() or without the task), for TaskMonitor
+    TaskHandle_t getTaskHandle() const { return _flushTask; }
+#endif
 };
 
 #endif // ESP32_DISPLAY_ADAPTER_H
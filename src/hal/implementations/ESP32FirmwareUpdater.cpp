@@ -0,0 +1,68 @@
+/**
+ * @file ESP32FirmwareUpdater.cpp
+ * @brief Implementation of the OTA image writer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "ESP32FirmwareUpdater.h"
+#include <esp_ota_ops.h>
+#include <esp_partition.h>
+
+ESP32FirmwareUpdater::ESP32FirmwareUpdater() {
+}
+
+uint32_t ESP32FirmwareUpdater::capacity(OtaTarget target) {
+    const esp_partition_t* partition = nullptr;
+    if (target == OtaTarget::FIRMWARE) {
+        partition = esp_ota_get_next_update_partition(nullptr);
+    } else {
+        partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, nullptr);
+    }
+    return partition != nullptr ? partition->size : 0;
+}
+
+bool ESP32FirmwareUpdater::begin(OtaTarget target, const char* md5) {
+    if (Update.isRunning()) {
+        Update.abort();
+    }
+    if (!Update.begin(UPDATE_SIZE_UNKNOWN, target == OtaTarget::FILESYSTEM ? U_SPIFFS : U_FLASH)) {
+        return false;
+    }
+    if (md5 != nullptr && !Update.setMD5(md5)) {
+        Update.abort();
+        return false;
+    }
+    return true;
+}
+
+size_t ESP32FirmwareUpdater::write(const uint8_t* data, size_t length) {
+    // Erases and writes one 4 KB sector at a time; the chunk is not kept
+    return Update.write(const_cast<uint8_t*>(data), length);
+}
+
+OtaError ESP32FirmwareUpdater::end() {
+    // true: the image ends here, not at the partition size given to begin()
+    if (Update.end(true)) {
+        return OtaError::NONE;
+    }
+    switch (Update.getError()) {
+        case UPDATE_ERROR_MD5:
+            return OtaError::HASH_MISMATCH;
+        case UPDATE_ERROR_WRITE:
+            return OtaError::WRITE_FAILED;
+        default:
+            return OtaError::VERIFY_FAILED;  // Magic, checksum/SHA-256 (activate)
+    }
+}
+
+void ESP32FirmwareUpdater::abort() {
+    if (Update.isRunning()) {
+        Update.abort();
+    }
+}
+
+const char* ESP32FirmwareUpdater::lastError() {
+    return Update.errorString();
+}
@@ -0,0 +1,45 @@
+/**
+ * @file ESP32FirmwareUpdater.h
+ * @brief OTA image writer (Arduino Update library) implementation
+ *
+ * Wraps the Update library to implement IFirmwareUpdater. Firmware goes to
+ * the inactive app slot of the partition table (partitions.csv: app0/app1),
+ * a filesystem image to the LittleFS data partition. The size is not known
+ * in advance (multipart upload), so the whole partition is opened and the
+ * image ends where the upload ends.
+ *
+ * end() fails without changing the boot partition if the MD5 differs or the
+ * app image checksum/SHA-256 does not verify.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ESP32_FIRMWARE_UPDATER_H
+#define ESP32_FIRMWARE_UPDATER_H
+
+#include <Update.h>
+#include "../../hal/interfaces/IFirmwareUpdater.h"
+
+/**
+ * @brief OTA image writer
+ *
+ * Real hardware implementation (vs MockFirmwareUpdater for testing).
+ */
+class ESP32FirmwareUpdater : public IFirmwareUpdater {
+public:
+    /**
+     * @brief Constructor
+     */
+    ESP32FirmwareUpdater();
+
+    // IFirmwareUpdater interface implementation
+    uint32_t capacity(OtaTarget target) override;
+    bool begin(OtaTarget target, const char* md5) override;
+    size_t write(const uint8_t* data, size_t length) override;
+    OtaError end() override;
+    void abort() override;
+    const char* lastError() override;
+};
+
+#endif // ESP32_FIRMWARE_UPDATER_H
@@ -0,0 +1,27 @@
+#include "ESP32I2cDevice.h"
+
+bool ESP32I2cDevice::begin(int sda, int scl, uint32_t clockHz) {
+    if (!wire_.begin(sda, scl)) {
+        return false;
+    }
+    return wire_.setClock(clockHz);
+}
+
+bool ESP32I2cDevice::writeRegister(uint8_t reg, uint8_t value) {
+    wire_.beginTransmission(address_);
+    wire_.write(reg);
+    wire_.write(value);
+    return wire_.endTransmission() == 0;
+}
+
+bool ESP32I2cDevice::readRegisters(uint8_t reg, uint8_t* out, size_t length) {
+    wire_.beginTransmission(address_);
+    wire_.write(reg);
+    if (wire_.endTransmission(false) != 0) {
+        return false;
+    }
+    if (wire_.requestFrom(static_cast<uint16_t>(address_), length, true) != length) {
+        return false;
+    }
+    return wire_.readBytes(out, length) == length;
+}
@@ -0,0 +1,43 @@
+#ifndef ESP32I2CDEVICE_H
+#define ESP32I2CDEVICE_H
+
+#include <Arduino.h>
+#include <Wire.h>
+#include "hal/interfaces/II2cDevice.h"
+
+/**
+ * @file ESP32I2cDevice.h
+ * @brief II2cDevice on an Arduino TwoWire bus
+ *
+ * Used for the onboard IMU on the OLED bus. arduino-esp32 holds the bus
+ * lock from beginTransmission() to the STOP, including across the repeated
+ * START of a register read (endTransmission(false) keeps it until
+ * requestFrom()), so these transactions and the OLED flush task's
+ * (OLED_FLUSH_TASK_ENABLED) interleave whole, never byte by byte.
+ *
+ * A read is limited by the Wire buffer (128 bytes); Icm20948 reads the
+ * FIFO in IMU_I2C_CHUNK_BYTES pieces.
+ *
+ * Usage:
+ * @code
+ * ESP32I2cDevice device(Wire, IMU_I2C_ADDRESS);
+ * device.begin(OLED_SDA_PIN, OLED_SCL_PIN, OLED_I2C_CLOCK);
+ * Icm20948 imu(&device);
+ * @endcode
+ */
+class ESP32I2cDevice : public II2cDevice {
+public:
+    ESP32I2cDevice(TwoWire& wire, uint8_t address) : wire_(wire), address_(address) {}
+
+    /// Start the bus (a no-op if the display already started it)
+    bool begin(int sda, int scl, uint32_t clockHz);
+
+    bool writeRegister(uint8_t reg, uint8_t value) override;
+    bool readRegisters(uint8_t reg, uint8_t* out, size_t length) override;
+
+private:
+    TwoWire& wire_;
+    uint8_t address_;
+};
+
+#endif // ESP32I2CDEVICE_H
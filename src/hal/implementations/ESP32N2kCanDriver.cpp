@@ -0,0 +1,132 @@
+#include "ESP32N2kCanDriver.h"
+
+namespace {
+
+// ESP32 TWAI controller, SJA1000 PeliCAN layout (one register per 32-bit word)
+constexpr uintptr_t CAN_REG_BASE = 0x3FF6B000;  // DR_REG_TWAI_BASE
+constexpr uintptr_t CAN_CMR = CAN_REG_BASE + 0x04;    // Command (write only)
+constexpr uintptr_t CAN_SR = CAN_REG_BASE + 0x08;     // Status
+constexpr uintptr_t CAN_RXERR = CAN_REG_BASE + 0x38;  // Receive error counter
+constexpr uintptr_t CAN_TXERR = CAN_REG_BASE + 0x3C;  // Transmit error counter
+constexpr uint32_t SR_DATA_OVERRUN = 1u << 1;
+constexpr uint32_t SR_ERROR_WARNING = 1u << 6;
+constexpr uint32_t SR_BUS_OFF = 1u << 7;
+constexpr uint32_t CMR_CLEAR_DATA_OVERRUN = 1u << 3;
+
+inline uint32_t readCanRegister(uintptr_t address) {
+    return *reinterpret_cast<volatile uint32_t*>(address);
+}
+
+}  // namespace
+
+ESP32N2kCanDriver::ESP32N2kCanDriver(gpio_num_t txPin, gpio_num_t rxPin)
+    : tNMEA2000_esp32(txPin, rxPin),
+      frameArrivalUs(0),
+      rxQueueHighWater(0),
+      framesReceived(0),
+      frameInHandler(false),
+      rxLatencyResetPending(false),
+      txQueueHighWater(0),
+      framesSent(0),
+      sendFailures(0),
+      frameObserver(nullptr),
+      frameObserverContext(nullptr) {
+}
+
+bool ESP32N2kCanDriver::waitForFrame(TickType_t timeout) {
+    if (RxQueue == nullptr) {
+        return false;  // Not opened yet
+    }
+
+    tCANFrame frame;
+    return xQueuePeek(RxQueue, &frame, timeout) == pdTRUE;
+}
+
+bool ESP32N2kCanDriver::injectFrame(uint32_t id, uint8_t len, const uint8_t* data) {
+    if (RxQueue == nullptr || len > 8) {
+        return false;
+    }
+
+    tCANFrame frame;
+    frame.id = id;
+    frame.len = len;
+    memcpy(frame.buf, data, len);
+    return xQueueSend(RxQueue, &frame, 0) == pdTRUE;
+}
+
+uint32_t ESP32N2kCanDriver::getRxQueueDepth() const {
+    return RxQueue != nullptr ? uxQueueMessagesWaiting(RxQueue) : 0;
+}
+
+uint32_t ESP32N2kCanDriver::getTxQueueDepth() const {
+    return TxQueue != nullptr ? uxQueueMessagesWaiting(TxQueue) : 0;
+}
+
+bool ESP32N2kCanDriver::CANSendFrame(unsigned long id, unsigned char len, const unsigned char *buf,
+                                     bool wait_sent) {
+    bool queued = tNMEA2000_esp32::CANSendFrame(id, len, buf, wait_sent);
+    if (queued) {
+        framesSent++;
+        busMonitor.noteFrame(len, millis());
+    } else {
+        sendFailures++;
+    }
+
+    uint32_t depth = getTxQueueDepth();
+    if (depth > txQueueHighWater) {
+        txQueueHighWater = depth;
+    }
+    return queued;
+}
+
+bool ESP32N2kCanDriver::CANGetFrame(unsigned long &id, unsigned char &len, unsigned char *buf) {
+    // The library only asks for the next frame once the previous one is handled
+    endPass();
+
+    uint32_t depth = getRxQueueDepth();
+    if (depth > rxQueueHighWater) {
+        rxQueueHighWater = depth;
+    }
+
+    bool received = tNMEA2000_esp32::CANGetFrame(id, len, buf);
+    if (received) {
+        framesReceived++;
+        frameInHandler = true;
+        uint32_t nowMs = millis();
+        busMonitor.noteFrame(len, nowMs);
+        if (frameObserver != nullptr) {
+            frameObserver(frameObserverContext, id, len, buf, nowMs);
+        }
+    }
+    return received;
+}
+
+void ESP32N2kCanDriver::endPass() {
+    if (rxLatencyResetPending) {
+        rxLatency.reset();  // Done here so the histogram keeps a single writer
+        rxLatencyResetPending = false;
+    }
+    if (frameInHandler) {
+        rxLatency.record(micros() - frameArrivalUs);
+        frameInHandler = false;
+    }
+}
+
+void ESP32N2kCanDriver::sampleController(uint32_t nowMs) {
+    // No RX queue: Open() has not started the controller yet
+    if (RxQueue == nullptr || !busMonitor.sampleDue(nowMs)) {
+        return;
+    }
+
+    uint32_t status = readCanRegister(CAN_SR);
+    CanControllerSample reading;
+    reading.txErrors = static_cast<uint8_t>(readCanRegister(CAN_TXERR) & 0xFF);
+    reading.rxErrors = static_cast<uint8_t>(readCanRegister(CAN_RXERR) & 0xFF);
+    reading.errorWarning = (status & SR_ERROR_WARNING) != 0;
+    reading.busOff = (status & SR_BUS_OFF) != 0;
+    reading.overrun = (status & SR_DATA_OVERRUN) != 0;
+    if (busMonitor.sample(reading, nowMs)) {
+        // Only the clear bit is set: a transmit the ISR requested is not touched
+        *reinterpret_cast<volatile uint32_t*>(CAN_CMR) = CMR_CLEAR_DATA_OVERRUN;
+    }
+}
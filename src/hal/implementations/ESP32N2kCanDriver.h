@@ -0,0 +1,171 @@
+#ifndef ESP32N2KCANDRIVER_H
+#define ESP32N2KCANDRIVER_H
+
+#include <Arduino.h>
+#include <NMEA2000_esp32.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include "utils/LatencyHistogram.h"
+#include "utils/CanBusMonitor.h"
+
+/**
+ * @file ESP32N2kCanDriver.h
+ * @brief NMEA2000_esp32 driver with wake-on-frame and receive instrumentation
+ *
+ * Extends tNMEA2000_esp32 (whose CAN ISR fills the FreeRTOS RxQueue) with:
+ * - waitForFrame(): block a task until the ISR has queued a frame, without
+ *   consuming it, so ParseMessages() runs as soon as data arrives
+ * - RX queue depth high-water, sampled every time the library fetches a frame
+ * - arrival-to-handled latency: from the frame's arrival estimate until the
+ *   library asks for the next frame (i.e. its PGN handler has returned)
+ * - TX queue depth high-water and sent/failed frame counts, sampled on every
+ *   frame the library hands to the driver
+ * - optional raw frame observer (e.g. N2kFastPacketMonitor), called for every
+ *   received frame before the library processes it
+ * - injectFrame(): queue a recorded frame behind the ISR's (BusReplay), so
+ *   replayed traffic takes the same receive path as live traffic
+ * - bus load and controller error state (CanBusMonitor): every fetched and
+ *   sent frame is counted; sampleController() reads the TEC/REC counters and
+ *   the bus-off, error-warning and overrun status bits
+ *
+ * Arrival estimate per pass (see setFrameArrival()):
+ * - Wake-on-frame: the moment waitForFrame() returned (frames queued behind
+ *   the first are charged from the same instant, so latency is conservative)
+ * - Polling: the start of the previous poll pass (upper bound - the frame
+ *   arrived at some point between the two passes)
+ *
+ * Usage:
+ * @code
+ * ESP32N2kCanDriver* can = new ESP32N2kCanDriver((gpio_num_t)CAN_TX_PIN, (gpio_num_t)CAN_RX_PIN);
+ * // Receive task:
+ * if (can->waitForFrame(pdMS_TO_TICKS(10))) {
+ *     can->setFrameArrival(micros());
+ * }
+ * can->ParseMessages();
+ * can->endPass();
+ * can->sampleController(millis());
+ * @endcode
+ *
+ * @note All methods except the getters and injectFrame() must be called from
+ *       the context that runs ParseMessages().
+ */
+/**
+ * @brief Raw receive frame callback (runs in the receive context)
+ */
+typedef void (*N2kFrameObserver)(void* context, unsigned long id, unsigned char len,
+                                 const unsigned char* buf, uint32_t nowMs);
+
+class ESP32N2kCanDriver : public tNMEA2000_esp32 {
+public:
+    ESP32N2kCanDriver(gpio_num_t txPin, gpio_num_t rxPin);
+
+    /**
+     * @brief Call @p observer for every received frame (nullptr = none)
+     *
+     * Set before the receive context starts.
+     */
+    void setFrameObserver(N2kFrameObserver observer, void* context) {
+        frameObserver = observer;
+        frameObserverContext = context;
+    }
+
+    /**
+     * @brief Append a frame to the RX queue as if the ISR had received it
+     *
+     * Safe from any task (FreeRTOS queue); wakes waitForFrame().
+     *
+     * @return false before Open(), if @p len > 8 or if the RX queue is full
+     */
+    bool injectFrame(uint32_t id, uint8_t len, const uint8_t* data);
+
+    /**
+     * @brief Block until the RX queue holds a frame (frame stays queued)
+     * @param timeout Maximum ticks to wait
+     * @return true if a frame is waiting, false on timeout or before Open()
+     */
+    bool waitForFrame(TickType_t timeout);
+
+    /**
+     * @brief Arrival estimate (micros()) for frames fetched from now on
+     */
+    void setFrameArrival(uint32_t arrivalUs) { frameArrivalUs = arrivalUs; }
+
+    /// Arrival estimate of the frames being handled now
+    uint32_t getFrameArrival() const { return frameArrivalUs; }
+
+    /**
+     * @brief Close the latency measurement of the last frame of a pass
+     *
+     * Call right after ParseMessages() returns.
+     */
+    void endPass();
+
+    /**
+     * @brief Frames currently waiting in the driver RX queue
+     */
+    uint32_t getRxQueueDepth() const;
+
+    uint32_t getRxQueueHighWater() const { return rxQueueHighWater; }
+    uint32_t getFramesReceived() const { return framesReceived; }
+
+    /**
+     * @brief Arrival-to-handled latency of received frames (µs)
+     */
+    const LatencyHistogram& getRxLatency() const { return rxLatency; }
+
+    /**
+     * @brief Clear the latency histogram before its next sample (any context)
+     */
+    void requestRxLatencyReset() { rxLatencyResetPending = true; }
+
+    /**
+     * @brief Frames currently waiting in the driver TX queue
+     */
+    uint32_t getTxQueueDepth() const;
+
+    /**
+     * @brief Read the controller error counters and status (every CAN_BUS_SAMPLE_MS)
+     *
+     * The library drives the TWAI controller through its registers rather
+     * than the IDF TWAI driver, so they are read directly. A data overrun
+     * is counted and cleared.
+     */
+    void sampleController(uint32_t nowMs);
+
+    /**
+     * @brief Bus load windows and error state (any context, see CanBusMonitor)
+     */
+    const CanBusMonitor& getBusMonitor() const { return busMonitor; }
+
+    uint32_t getTxQueueHighWater() const { return txQueueHighWater; }
+    uint32_t getFramesSent() const { return framesSent; }
+    uint32_t getSendFailures() const { return sendFailures; }
+
+protected:
+    /**
+     * @brief Library frame fetch hook - instruments, then defers to the driver
+     */
+    bool CANGetFrame(unsigned long &id, unsigned char &len, unsigned char *buf) override;
+
+    /**
+     * @brief Library frame send hook - defers to the driver, then instruments
+     */
+    bool CANSendFrame(unsigned long id, unsigned char len, const unsigned char *buf,
+                      bool wait_sent = true) override;
+
+private:
+    LatencyHistogram rxLatency;
+    uint32_t frameArrivalUs;
+    uint32_t rxQueueHighWater;
+    uint32_t framesReceived;
+    bool frameInHandler;   ///< A fetched frame's handler has not been closed yet
+    volatile bool rxLatencyResetPending;
+    uint32_t txQueueHighWater;
+    uint32_t framesSent;
+    uint32_t sendFailures;
+    N2kFrameObserver frameObserver;
+    void* frameObserverContext;
+    CanBusMonitor busMonitor;
+};
+
+#endif // ESP32N2KCANDRIVER_H
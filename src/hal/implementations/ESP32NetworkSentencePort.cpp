@@ -0,0 +1,105 @@
+#include "ESP32NetworkSentencePort.h"
+
+ESP32NetworkSentencePort::ESP32NetworkSentencePort(NetworkSentenceMode mode, uint16_t port,
+                                                   const char* host)
+    : mode_(mode), port_(port), host_(host), started_(false), client_(nullptr),
+      connected_(false), connecting_(false), lastConnectAttempt_(0) {
+}
+
+int ESP32NetworkSentencePort::available() {
+    return static_cast<int>(sentences_.size());
+}
+
+int ESP32NetworkSentencePort::read() {
+    return -1;
+}
+
+void ESP32NetworkSentencePort::begin(unsigned long baud) {
+    (void)baud;
+    if (started_) {
+        return;
+    }
+
+    if (mode_ == NetworkSentenceMode::UDP_LISTEN) {
+        if (!udp_.listen(port_)) {
+            return;
+        }
+        // AsyncUDP task: one datagram = one or more whole sentences
+        udp_.onPacket([this](AsyncUDPPacket& packet) {
+            sentences_.feedDatagram(reinterpret_cast<const char*>(packet.data()), packet.length());
+        });
+        started_ = true;
+        return;
+    }
+
+    if (host_ == nullptr) {
+        return;
+    }
+
+    client_ = new AsyncClient();
+    client_->onConnect([](void* arg, AsyncClient*) {
+        ESP32NetworkSentencePort* self = static_cast<ESP32NetworkSentencePort*>(arg);
+        self->connected_.store(true, std::memory_order_release);
+        self->connecting_.store(false, std::memory_order_release);
+    }, this);
+    client_->onData([](void* arg, AsyncClient*, void* data, size_t length) {
+        static_cast<ESP32NetworkSentencePort*>(arg)->onData(static_cast<const char*>(data), length);
+    }, this);
+    client_->onDisconnect([](void* arg, AsyncClient*) {
+        static_cast<ESP32NetworkSentencePort*>(arg)->onDisconnect();
+    }, this);
+    client_->onError([](void* arg, AsyncClient*, int8_t) {
+        // A failed connect is followed by onDisconnect; keep the retry timer running
+        static_cast<ESP32NetworkSentencePort*>(arg)->connecting_.store(false, std::memory_order_release);
+    }, this);
+
+    started_ = true;
+    connect(millis());
+}
+
+Stream* ESP32NetworkSentencePort::getStream() {
+    return nullptr;
+}
+
+bool ESP32NetworkSentencePort::getStats(SerialPortStats& stats) const {
+    stats.fifoOverflows = 0;
+    stats.bufferFull = 0;
+    stats.framingErrors = 0;
+    stats.sentences = sentences_.getSentenceCount();
+    stats.droppedSentences = sentences_.getDroppedCount() + sentences_.getOversizedCount();
+    stats.bufferHighWater = sentences_.getHighWater();  // Sentences, not bytes
+    return true;
+}
+
+size_t ESP32NetworkSentencePort::readSentence(char* line, size_t size) {
+    if (mode_ == NetworkSentenceMode::TCP_CLIENT && started_ &&
+        !connected_.load(std::memory_order_acquire) &&
+        !connecting_.load(std::memory_order_acquire)) {
+        unsigned long now = millis();
+        if (now - lastConnectAttempt_ >= NMEA0183_NET_RECONNECT_MS) {
+            connect(now);
+        }
+    }
+    return sentences_.pop(line, size);
+}
+
+void ESP32NetworkSentencePort::connect(unsigned long now) {
+    // Main loop: non-blocking, completion arrives as onConnect/onError
+    lastConnectAttempt_ = now;
+    connecting_.store(true, std::memory_order_release);
+    if (!client_->connect(host_, port_)) {
+        connecting_.store(false, std::memory_order_release);
+    }
+}
+
+void ESP32NetworkSentencePort::onData(const char* data, size_t length) {
+    // AsyncTCP task: a segment may end inside a sentence
+    sentences_.feed(data, length);
+}
+
+void ESP32NetworkSentencePort::onDisconnect() {
+    // AsyncTCP task: the partial line belongs to the old connection
+    sentences_.resetPartial();
+    connecting_.store(false, std::memory_order_release);
+    connected_.store(false, std::memory_order_release);
+}
@@ -0,0 +1,110 @@
+#ifndef ESP32NETWORKSENTENCEPORT_H
+#define ESP32NETWORKSENTENCEPORT_H
+
+#include "hal/interfaces/ISerialPort.h"
+#include <Arduino.h>
+#include <AsyncTCP.h>
+#include <AsyncUDP.h>
+#include <atomic>
+#include "utils/NMEA0183SentenceQueue.h"
+#include "config.h"
+
+/**
+ * @file ESP32NetworkSentencePort.h
+ * @brief NMEA 0183 network input (UDP broadcast listener or TCP client) as ISerialPort
+ *
+ * Receives sentences from a Wi-Fi NMEA multiplexer and hands them to
+ * NMEA0183Handler as whole lines, so they take the same tokenize and
+ * dispatch path as Serial2:
+ * - UDP: listens on a port (usually 10110) for broadcast datagrams; each
+ *   datagram is split into its sentences
+ * - TCP: connects to the multiplexer and splits the byte stream at line
+ *   ends; a dropped connection is retried from the main loop
+ *
+ * Datagrams/segments arrive on the AsyncUDP/AsyncTCP task and are queued as
+ * whole sentences in an NMEA0183SentenceQueue (NMEA0183_NET_QUEUE_DEPTH);
+ * the main loop pops them with readSentence(). A full queue drops the
+ * sentence and counts it (getStats().droppedSentences).
+ *
+ * Constitutional Compliance:
+ * - Principle I (Hardware Abstraction): implements ISerialPort (sentence port)
+ * - Principle II (Resource Management): fixed sentence ring, one AsyncUDP/AsyncClient
+ * - Principle VII (Fail-Safe): bounded queue, automatic TCP reconnect
+ *
+ * Usage:
+ * @code
+ * ISerialPort* net = new ESP32NetworkSentencePort(NetworkSentenceMode::UDP_LISTEN, 10110);
+ * NMEA0183PortConfig config = {net, 0, "UDP", "N0183-NET", {{0, 0}}};
+ * nmea0183Handler->addPort(config);     // begin() via init(); baud is ignored
+ * @endcode
+ */
+
+/**
+ * @brief Network transport of an ESP32NetworkSentencePort
+ */
+enum class NetworkSentenceMode : uint8_t {
+    UDP_LISTEN = 0,  ///< Receive datagrams on a local port (broadcast or unicast)
+    TCP_CLIENT = 1   ///< Connect to host:port and read the stream
+};
+
+class ESP32NetworkSentencePort : public ISerialPort {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param mode UDP listener or TCP client
+     * @param port UDP listen port or TCP server port
+     * @param host TCP server host (ignored for UDP; must outlive the port)
+     */
+    ESP32NetworkSentencePort(NetworkSentenceMode mode, uint16_t port, const char* host = nullptr);
+
+    /**
+     * @brief Number of queued sentences (not bytes)
+     */
+    int available() override;
+
+    /**
+     * @brief Byte-wise reading is not supported, use readSentence()
+     * @return -1
+     */
+    int read() override;
+
+    /**
+     * @brief Start listening (UDP) or connecting (TCP); baud is ignored
+     */
+    void begin(unsigned long baud) override;
+
+    /**
+     * @brief nullptr (no byte stream)
+     */
+    Stream* getStream() override;
+
+    bool getStats(SerialPortStats& stats) const override;
+
+    bool isSentencePort() const override { return true; }
+
+    /**
+     * @brief Pop one queued sentence; also retries a lost TCP connection
+     */
+    size_t readSentence(char* line, size_t size) override;
+
+private:
+    NetworkSentenceMode mode_;
+    uint16_t port_;
+    const char* host_;
+    bool started_;
+    AsyncUDP udp_;
+    AsyncClient* client_;
+    std::atomic<bool> connected_;      ///< Written by the AsyncTCP task
+    std::atomic<bool> connecting_;     ///< Set by the main loop, cleared by the AsyncTCP task
+    unsigned long lastConnectAttempt_; ///< Main loop only
+
+    /// Whole sentences (network task → main loop)
+    NMEA0183SentenceQueue<NMEA0183_NET_QUEUE_DEPTH> sentences_;
+
+    void connect(unsigned long now);
+    void onData(const char* data, size_t length);
+    void onDisconnect();
+};
+
+#endif // ESP32NETWORKSENTENCEPORT_H
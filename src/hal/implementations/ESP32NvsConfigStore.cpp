@@ -0,0 +1,45 @@
+/**
+ * @file ESP32NvsConfigStore.cpp
+ * @brief Implementation of the NVS configuration store
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "ESP32NvsConfigStore.h"
+#include "../../config.h"
+
+ESP32NvsConfigStore::ESP32NvsConfigStore() : isOpen(false) {
+}
+
+bool ESP32NvsConfigStore::begin() {
+    if (!isOpen) {
+        isOpen = preferences.begin(NVS_CONFIG_NAMESPACE, false);
+    }
+    return isOpen;
+}
+
+size_t ESP32NvsConfigStore::read(const char* key, uint8_t* out, size_t size) {
+    if (!isOpen || out == nullptr) {
+        return 0;
+    }
+    size_t length = preferences.getBytesLength(key);
+    if (length == 0 || length > size) {
+        return 0;
+    }
+    return preferences.getBytes(key, out, length);
+}
+
+bool ESP32NvsConfigStore::write(const char* key, const uint8_t* data, size_t length) {
+    if (!isOpen || data == nullptr || length == 0) {
+        return false;
+    }
+    return preferences.putBytes(key, data, length) == length;
+}
+
+bool ESP32NvsConfigStore::remove(const char* key) {
+    if (!isOpen) {
+        return false;
+    }
+    return !preferences.isKey(key) || preferences.remove(key);
+}
@@ -0,0 +1,42 @@
+/**
+ * @file ESP32NvsConfigStore.h
+ * @brief NVS configuration store (Preferences) implementation
+ *
+ * Wraps the Arduino Preferences library to implement IConfigStore. All
+ * records share the NVS_CONFIG_NAMESPACE namespace. NVS writes are atomic
+ * per key and journaled by IDF: a reset mid-write keeps the previous blob.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ESP32_NVS_CONFIG_STORE_H
+#define ESP32_NVS_CONFIG_STORE_H
+
+#include <Preferences.h>
+#include "../../hal/interfaces/IConfigStore.h"
+
+/**
+ * @brief NVS configuration store
+ *
+ * Real hardware implementation (vs MockConfigStore for testing).
+ */
+class ESP32NvsConfigStore : public IConfigStore {
+private:
+    Preferences preferences;
+    bool isOpen;
+
+public:
+    /**
+     * @brief Constructor
+     */
+    ESP32NvsConfigStore();
+
+    // IConfigStore interface implementation
+    bool begin() override;
+    size_t read(const char* key, uint8_t* out, size_t size) override;
+    bool write(const char* key, const uint8_t* data, size_t length) override;
+    bool remove(const char* key) override;
+};
+
+#endif // ESP32_NVS_CONFIG_STORE_H
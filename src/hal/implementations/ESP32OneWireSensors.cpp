@@ -7,25 +7,40 @@
 
 #include "ESP32OneWireSensors.h"
 
-// Device family codes for 1-wire devices
-#define DS2438_FAMILY 0x26  // Smart Battery Monitor
-#define DS18B20_FAMILY 0x28  // Temperature sensor (if needed)
+// DS2438 function commands
+#define DS2438_CONVERT_V 0xB4
+#define DS2438_RECALL_MEMORY 0xB8
+#define DS2438_READ_SCRATCHPAD 0xBE
+
+namespace {
+
+uint32_t busMicros() {
+    return micros();
+}
+
+}  // namespace
 
 ESP32OneWireSensors::ESP32OneWireSensors(uint8_t pin)
-    : busPin(pin),
+    : oneWire(new OneWire(pin)),
+      bus(oneWire),
+      conversion(&bus, busMicros),
+      busPin(pin),
       initialized(false),
       hasSaildriveSensor(false),
       hasBatteryASensor(false),
       hasBatteryBSensor(false),
-      hasShorePowerSensor(false) {
+      hasShorePowerSensor(false),
+      mapChanged(nullptr),
+      mapChangedContext(nullptr),
+      searchPending(false),
+      searchActive(false),
+      searched(false),
+      lastSearchMs(0) {
     // Initialize device addresses to zero
     memset(&saildriveAddr, 0, sizeof(DeviceAddress));
     memset(&batteryAAddr, 0, sizeof(DeviceAddress));
     memset(&batteryBAddr, 0, sizeof(DeviceAddress));
     memset(&shorePowerAddr, 0, sizeof(DeviceAddress));
-
-    // Create OneWire bus instance
-    oneWire = new OneWire(busPin);
 }
 
 ESP32OneWireSensors::~ESP32OneWireSensors() {
@@ -50,8 +65,20 @@ bool ESP32OneWireSensors::initialize() {
         return false;
     }
 
-    // Enumerate all devices on the bus
-    int deviceCount = enumerateDevices();
+    // Known devices: check them by address instead of searching the bus
+    int deviceCount;
+    uint8_t mapped = deviceMap.count();
+    if (mapped > 0) {
+        deviceCount = verifyMappedDevices();
+        if (!deviceMap.allVerified()) {
+            Serial.printf("[1-Wire] %d of %d mapped device(s) missing - searching in the background\n",
+                          mapped - deviceCount, mapped);
+            searchPending = true;
+        }
+    } else {
+        deviceCount = enumerateDevices();
+    }
+    applyDeviceMap();
 
     // Log device discovery results
     Serial.printf("[1-Wire] Found %d device(s) on GPIO %d\n", deviceCount, busPin);
@@ -68,6 +95,15 @@ bool ESP32OneWireSensors::initialize() {
     if (hasShorePowerSensor) {
         Serial.println("[1-Wire] Shore power sensor detected");
     }
+    uint8_t probes = 0;
+    for (uint8_t i = 0; i < deviceMap.count(); i++) {
+        if (deviceMap.at(i).role == OneWireRole::TEMPERATURE) {
+            probes++;
+        }
+    }
+    if (probes > 0) {
+        Serial.printf("[1-Wire] %d temperature probe(s) mapped\n", probes);
+    }
 
     initialized = true;
     return true;
@@ -76,6 +112,7 @@ bool ESP32OneWireSensors::initialize() {
 int ESP32OneWireSensors::enumerateDevices() {
     uint8_t addr[8];
     int deviceCount = 0;
+    uint16_t version = deviceMap.version();
 
     // Reset search
     oneWire->reset_search();
@@ -83,47 +120,125 @@ int ESP32OneWireSensors::enumerateDevices() {
     // Search for all devices on the bus
     while (oneWire->search(addr)) {
         // Validate CRC of device address
-        if (!OneWire::crc8(addr, 7) == addr[7]) {
+        if (OneWire::crc8(addr, 7) != addr[7]) {
             Serial.println("[1-Wire] CRC mismatch on device address");
             continue;
         }
 
         deviceCount++;
 
-        // Identify device by family code
-        uint8_t familyCode = addr[0];
-
-        // For now, assign devices in discovery order
-        // TODO: Update with actual device addresses from hardware installation
-        if (familyCode == DS2438_FAMILY) {
-            if (!hasSaildriveSensor) {
-                copyAddress(saildriveAddr, addr);
-                hasSaildriveSensor = true;
-            } else if (!hasBatteryASensor) {
-                copyAddress(batteryAAddr, addr);
-                hasBatteryASensor = true;
-            } else if (!hasBatteryBSensor) {
-                copyAddress(batteryBAddr, addr);
-                hasBatteryBSensor = true;
-            } else if (!hasShorePowerSensor) {
-                copyAddress(shorePowerAddr, addr);
-                hasShorePowerSensor = true;
-            }
+        // Roles in discovery order; kept in the device map from now on
+        if (deviceMap.assign(addr) == OneWireRole::NONE) {
+            Serial.printf("[1-Wire] Unassigned device, family 0x%02X\n", addr[0]);
         }
     }
 
+    if (deviceMap.version() != version && mapChanged != nullptr) {
+        mapChanged(mapChangedContext);
+    }
     return deviceCount;
 }
 
+int ESP32OneWireSensors::verifyMappedDevices() {
+    int answered = 0;
+    for (uint8_t i = 0; i < deviceMap.count(); i++) {
+        bool present = verifyDevice(deviceMap.at(i).rom);
+        deviceMap.setVerified(i, present);
+        if (present) {
+            answered++;
+        }
+    }
+    return answered;
+}
+
+bool ESP32OneWireSensors::verifyDevice(const uint8_t rom[8]) {
+    if (!oneWire->reset()) {
+        return false;
+    }
+    oneWire->select(rom);
+    oneWire->write(DS2438_READ_SCRATCHPAD);  // Same command on a DS18B20
+    if (rom[0] == DS2438_FAMILY) {
+        oneWire->write(0x00);  // Page 0
+    }
+
+    uint8_t page[9];
+    oneWire->read_bytes(page, sizeof(page));
+    return validateCRC(page, sizeof(page));  // An absent device reads 0xFF: CRC mismatch
+}
+
+void ESP32OneWireSensors::applyDeviceMap() {
+    DeviceAddress* addresses[] = {&saildriveAddr, &batteryAAddr, &batteryBAddr, &shorePowerAddr};
+    bool* present[] = {&hasSaildriveSensor, &hasBatteryASensor, &hasBatteryBSensor, &hasShorePowerSensor};
+
+    // The conversion cycle reads the devices with a role (a missing one fails until it is back)
+    for (uint8_t role = 0; role < static_cast<uint8_t>(OneWireDevice::COUNT); role++) {
+        int8_t index = deviceMap.findRole(static_cast<OneWireRole>(role));
+        if (index < 0) {
+            continue;
+        }
+        copyAddress(*addresses[role], deviceMap.at(index).rom);
+        *present[role] = true;
+        conversion.setDevice(static_cast<OneWireDevice>(role), deviceMap.at(index).rom);
+    }
+}
+
+bool ESP32OneWireSensors::serviceSearch(uint32_t nowMs) {
+    if (!initialized || oneWire == nullptr) {
+        return false;
+    }
+
+    if (!searchActive) {
+        // A mapped device that stopped answering
+        for (uint8_t role = 0; role < static_cast<uint8_t>(OneWireDevice::COUNT); role++) {
+            if (deviceMap.findRole(static_cast<OneWireRole>(role)) >= 0 &&
+                conversion.getConsecutiveFailures(static_cast<OneWireDevice>(role)) >= ONEWIRE_MISSING_FAILURES) {
+                deviceMap.setRoleMissing(static_cast<OneWireRole>(role));
+                searchPending = true;
+            }
+        }
+        if (!searchPending || (searched && nowMs - lastSearchMs < ONEWIRE_SEARCH_RETRY_MS)) {
+            return false;
+        }
+        searchPending = false;
+        searchActive = true;
+        oneWire->reset_search();
+        return true;
+    }
+
+    // One device per call
+    uint8_t addr[8];
+    if (oneWire->search(addr)) {
+        if (OneWire::crc8(addr, 7) == addr[7]) {
+            uint16_t version = deviceMap.version();
+            OneWireRole role = deviceMap.assign(addr);
+            if (deviceMap.version() != version) {
+                Serial.printf("[1-Wire] New device for %s\n", OneWireRoleName(role));
+                applyDeviceMap();
+                if (mapChanged != nullptr) {
+                    mapChanged(mapChangedContext);
+                }
+            }
+        }
+        return true;
+    }
+
+    // Search complete; still missing: try again after the retry interval
+    searchActive = false;
+    searched = true;
+    lastSearchMs = nowMs;
+    searchPending = !deviceMap.allVerified();
+    return false;
+}
+
 bool ESP32OneWireSensors::readSaildriveStatus(SaildriveData& data) {
     if (!initialized || !hasSaildriveSensor) {
         data.available = false;
         return false;
     }
 
-    bool state = false;
-    if (readDigitalSensor(saildriveAddr, state)) {
-        data.saildriveEngaged = state;
+    DS2438Reading reading;
+    if (readPage(saildriveAddr, reading)) {
+        data.saildriveEngaged = DS2438DigitalState(reading);
         data.available = true;
         data.lastUpdate = millis();
         return true;
@@ -139,7 +254,13 @@ bool ESP32OneWireSensors::readBatteryA(BatteryMonitorData& data) {
         return false;
     }
 
-    return readBatteryMonitor(batteryAAddr, data);
+    DS2438Reading reading;
+    if (!readPage(batteryAAddr, reading)) {
+        data.available = false;
+        return false;
+    }
+    DS2438ToBattery(reading, data);
+    return true;
 }
 
 bool ESP32OneWireSensors::readBatteryB(BatteryMonitorData& data) {
@@ -148,7 +269,13 @@ bool ESP32OneWireSensors::readBatteryB(BatteryMonitorData& data) {
         return false;
     }
 
-    return readBatteryMonitor(batteryBAddr, data);
+    DS2438Reading reading;
+    if (!readPage(batteryBAddr, reading)) {
+        data.available = false;
+        return false;
+    }
+    DS2438ToBattery(reading, data);
+    return true;
 }
 
 bool ESP32OneWireSensors::readShorePower(ShorePowerData& data) {
@@ -157,26 +284,14 @@ bool ESP32OneWireSensors::readShorePower(ShorePowerData& data) {
         return false;
     }
 
-    bool connected = false;
-    double power = 0.0;
-
-    // Read connection status (digital)
-    if (!readDigitalSensor(shorePowerAddr, connected)) {
+    // Connection input and current from one page read
+    DS2438Reading reading;
+    if (!readPage(shorePowerAddr, reading)) {
         data.available = false;
         return false;
     }
 
-    // Read power consumption (analog) - only if connected
-    if (connected) {
-        if (!readPowerConsumption(shorePowerAddr, power)) {
-            data.available = false;
-            return false;
-        }
-    }
-
-    data.shorePowerOn = connected;
-    data.power = power;
-    data.available = true;
+    DS2438ToShorePower(reading, data);
     data.lastUpdate = millis();
 
     return true;
@@ -187,71 +302,56 @@ bool ESP32OneWireSensors::isBusHealthy() {
         return false;
     }
 
+    // Once the conversion cycle owns the bus, judge it by its results:
+    // a reset pulse here would break the transaction in progress
+    if (conversion.getCycles() > 0) {
+        return conversion.isHealthy(millis());
+    }
+
     // Quick bus health check - try to reset
     return oneWire->reset();
 }
 
 // Private helper methods
 
-bool ESP32OneWireSensors::readDigitalSensor(const DeviceAddress& addr, bool& state) {
+bool ESP32OneWireSensors::readPage(const DeviceAddress& addr, DS2438Reading& reading) {
     if (!isValidAddress(addr)) {
         return false;
     }
 
-    // Reset the bus
+    // Start the A/D conversion of this device
     if (!oneWire->reset()) {
         return false;
     }
-
-    // Select the device
     oneWire->select(addr.addr);
+    oneWire->write(DS2438_CONVERT_V);
+    delay(ONEWIRE_CONVERSION_MS);
 
-    // TODO: Implement actual DS2438 digital read commands
-    // For now, return a placeholder value
-    // This will be updated during hardware integration phase
-    state = false;  // Placeholder
-
-    return true;  // Stub implementation
-}
-
-bool ESP32OneWireSensors::readBatteryMonitor(const DeviceAddress& addr, BatteryMonitorData& data) {
-    if (!isValidAddress(addr)) {
-        return false;
-    }
-
-    // Reset the bus
+    // Copy page 0 to the scratchpad
     if (!oneWire->reset()) {
         return false;
     }
-
-    // Select the device
     oneWire->select(addr.addr);
+    oneWire->write(DS2438_RECALL_MEMORY);
+    oneWire->write(0x00);
 
-    // TODO: Implement actual DS2438 battery monitor read commands
-    // DS2438 provides: voltage (VAD), current (ISENSE), temperature
-    // For now, return placeholder values
-    // This will be updated during hardware integration phase
-
-    data.voltage = 12.6;  // Placeholder
-    data.amperage = 0.0;  // Placeholder
-    data.stateOfCharge = 85.0;  // Placeholder
-    data.shoreChargerOn = false;  // Placeholder
-    data.engineChargerOn = false;  // Placeholder
-    data.available = true;
-
-    return true;  // Stub implementation
-}
-
-bool ESP32OneWireSensors::readPowerConsumption(const DeviceAddress& addr, double& power) {
-    if (!isValidAddress(addr)) {
-        return false;
+    for (int attempt = 0; attempt < 2; attempt++) {
+        if (!oneWire->reset()) {
+            return false;
+        }
+        oneWire->select(addr.addr);
+        oneWire->write(DS2438_READ_SCRATCHPAD);
+        oneWire->write(0x00);
+
+        uint8_t page[9];
+        oneWire->read_bytes(page, sizeof(page));
+        if (validateCRC(page, sizeof(page))) {
+            reading = DS2438Decode(page);
+            return true;
+        }
     }
 
-    // TODO: Implement actual power consumption read
-    // This will be updated during hardware integration phase
-    power = 0.0;  // Placeholder
-
-    return true;  // Stub implementation
+    return false;  // CRC mismatch twice
 }
 
 bool ESP32OneWireSensors::validateCRC(const uint8_t* data, uint8_t len) {
@@ -6,9 +6,13 @@
  * using OneWire and DallasTemperature libraries on GPIO 4.
  *
  * Features:
- * - Sequential polling with 50ms spacing to avoid bus contention
- * - CRC validation with single retry on failure
- * - Device enumeration during initialization
+ * - DS2438 page 0 decode (voltage, current, temperature) with CRC8 and single retry
+ * - Persisted ROM -> role map (OneWireDeviceMap): at boot the mapped devices
+ *   are checked by direct addressing and the ROM search is skipped; a full
+ *   search runs only on first boot, and in the background (serviceSearch())
+ *   while a mapped device is missing
+ * - Non-blocking conversion cycle (getConversion()) for the pollers; the
+ *   read*() methods are the blocking equivalent for the HAL interface
  * - Graceful degradation on sensor failures
  *
  * Constitutional compliance: Principle I (HAL implementation)
@@ -23,6 +27,9 @@
 #define ESP32_ONEWIRE_SENSORS_H
 
 #include "../interfaces/IOneWireSensors.h"
+#include "../interfaces/IOneWireBus.h"
+#include "../../utils/OneWireConversion.h"
+#include "../../utils/OneWireDeviceMap.h"
 #include <OneWire.h>
 #include <Arduino.h>
 
@@ -35,6 +42,21 @@ struct DeviceAddress {
     uint8_t addr[8];
 };
 
+/**
+ * @brief IOneWireBus over the OneWire library (bit-banged GPIO)
+ */
+class ESP32OneWireBus : public IOneWireBus {
+public:
+    explicit ESP32OneWireBus(OneWire* oneWire) : oneWire_(oneWire) {}
+
+    bool reset() override { return oneWire_->reset() == 1; }
+    void write(uint8_t value) override { oneWire_->write(value); }
+    uint8_t read() override { return oneWire_->read(); }
+
+private:
+    OneWire* oneWire_;
+};
+
 /**
  * @brief ESP32 hardware implementation of 1-wire sensor interface
  *
@@ -49,7 +71,7 @@ struct DeviceAddress {
  * }
  * @endcode
  *
- * Memory footprint: ~200 bytes (OneWire bus + device addresses)
+ * Memory footprint: ~350 bytes (OneWire bus, device addresses, conversion cycle)
  */
 class ESP32OneWireSensors : public IOneWireSensors {
 public:
@@ -71,10 +93,54 @@ public:
     bool readBatteryA(BatteryMonitorData& data) override;
     bool readBatteryB(BatteryMonitorData& data) override;
     bool readShorePower(ShorePowerData& data) override;
+
+    /**
+     * @brief Bus health
+     *
+     * While the conversion cycle runs: OneWireConversion::isHealthy() (recent
+     * valid page, CRC-error rate). Before the first cycle: a reset pulse.
+     */
     bool isBusHealthy() override;
 
+    /**
+     * @brief Stepped conversion/read cycle over the devices found by initialize()
+     *
+     * Used by OneWireSensorPoller::pollConversion() and OneWireSensorTask
+     * instead of the blocking read*() methods.
+     */
+    OneWireConversion& getConversion() { return conversion; }
+
+    /**
+     * @brief ROM -> role map (restore with decodeRecord() before initialize())
+     */
+    OneWireDeviceMap& getDeviceMap() { return deviceMap; }
+
+    /**
+     * @brief Called from the bus owner whenever the map changes and should be saved
+     *
+     * Call before initialize().
+     */
+    void setMapChangedCallback(void (*callback)(void* context), void* context) {
+        mapChanged = callback;
+        mapChangedContext = context;
+    }
+
+    /**
+     * @brief Background ROM search, one device per call (bus owner, between conversion cycles)
+     *
+     * Starts when initialize() could not verify every mapped device, or a
+     * mapped device failed ONEWIRE_MISSING_FAILURES reads in a row, at most
+     * every ONEWIRE_SEARCH_RETRY_MS. Each call walks the ROM tree to the
+     * next device (~14 ms); a device found for a missing role takes it over.
+     *
+     * @return true while the search is running (the bus was used)
+     */
+    bool serviceSearch(uint32_t nowMs);
+
 private:
     OneWire* oneWire;              ///< OneWire bus instance
+    ESP32OneWireBus bus;           ///< Byte-level access for the conversion cycle
+    OneWireConversion conversion;  ///< Non-blocking cycle over the found devices
     uint8_t busPin;                ///< GPIO pin number
     bool initialized;              ///< Initialization state flag
 
@@ -90,49 +156,51 @@ private:
     bool hasBatteryBSensor;        ///< true if battery B monitor found
     bool hasShorePowerSensor;      ///< true if shore power sensor found
 
+    OneWireDeviceMap deviceMap;    ///< Persisted ROM -> role assignments
+    void (*mapChanged)(void* context);
+    void* mapChangedContext;
+    bool searchPending;            ///< A mapped device is missing: search when the retry interval allows
+    bool searchActive;             ///< serviceSearch() is walking the ROM tree
+    bool searched;                 ///< A background search has completed (retry interval applies)
+    uint32_t lastSearchMs;
+
     /**
      * @brief Enumerate all devices on the 1-wire bus
      *
-     * Scans bus for expected device family codes and stores addresses.
-     * Logs warnings for missing expected devices.
+     * Full ROM search (first boot, no stored map). Every device is assigned
+     * a role in the device map.
      *
-     * @return Number of devices found (0-4 expected)
+     * @return Number of devices found (0-4 expected, plus temperature probes)
      */
     int enumerateDevices();
 
     /**
-     * @brief Read digital sensor state (saildrive, shore power connection)
-     *
-     * Reads a single bit from a DS2438 device indicating on/off state.
-     *
-     * @param addr Device address
-     * @param[out] state Digital state (true/false)
-     * @return true if read successful (with valid CRC), false on error
+     * @brief Address every mapped ROM directly and mark the ones that answer
+     * @return Number of devices that answered
      */
-    bool readDigitalSensor(const DeviceAddress& addr, bool& state);
+    int verifyMappedDevices();
 
     /**
-     * @brief Read analog battery monitor data from DS2438
-     *
-     * Reads voltage, current, and calculated SOC from battery monitor IC.
-     * Implements single retry on CRC failure.
-     *
-     * @param addr Device address
-     * @param[out] data Battery monitor data structure
-     * @return true if read successful, false on sensor error
+     * @brief Check one device: Read Scratchpad with a valid CRC
      */
-    bool readBatteryMonitor(const DeviceAddress& addr, BatteryMonitorData& data);
+    bool verifyDevice(const uint8_t rom[8]);
 
     /**
-     * @brief Read shore power consumption from analog sensor
+     * @brief Copy the map's roles into the device addresses and the conversion cycle
+     */
+    void applyDeviceMap();
+
+    /**
+     * @brief Blocking read of DS2438 page 0 (convert, wait, recall, read)
      *
-     * Reads power draw in watts from analog current sensor.
+     * Takes ONEWIRE_CONVERSION_MS plus two transactions. Implements single
+     * retry on CRC failure.
      *
      * @param addr Device address
-     * @param[out] power Power consumption in watts
-     * @return true if read successful, false on error
+     * @param[out] reading Decoded voltage, current and temperature
+     * @return true if read successful (with valid CRC), false on error
      */
-    bool readPowerConsumption(const DeviceAddress& addr, double& power);
+    bool readPage(const DeviceAddress& addr, DS2438Reading& reading);
 
     /**
      * @brief Validate CRC for 1-wire data buffer
@@ -21,3 +21,10 @@ void ESP32SerialPort::begin(unsigned long baud) {
 Stream* ESP32SerialPort::getStream() {
     return serial_;
 }
+
+size_t ESP32SerialPort::writeNonBlocking(const uint8_t* data, size_t size) {
+    if (serial_->availableForWrite() < static_cast<int>(size)) {
+        return 0;
+    }
+    return serial_->write(data, size) == size ? size : 0;
+}
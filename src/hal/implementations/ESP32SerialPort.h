@@ -80,6 +80,11 @@ public:
      */
     Stream* getStream() override;
 
+    /**
+     * @brief Queue @p size bytes if the TX buffer has room for all of them, else none
+     */
+    size_t writeNonBlocking(const uint8_t* data, size_t size) override;
+
 private:
     HardwareSerial* serial_;  ///< Pointer to HardwareSerial instance (not owned)
     int8_t rxPin_;            ///< RX GPIO pin number
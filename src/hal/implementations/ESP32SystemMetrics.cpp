@@ -13,19 +13,156 @@
 #include <Esp.h>
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
+#include <esp_freertos_hooks.h>
+#include <esp_heap_caps.h>
+#include "utils/AllocTracker.h"
 
-ESP32SystemMetrics::ESP32SystemMetrics() {
-    // Constructor: No initialization needed
+namespace {
+
+CpuIdleMonitor* idleMonitor = nullptr;
+
+// Heap counters: written from any task or ISR that (fails to) allocate
+uint32_t heapAllocs = 0;
+uint32_t heapFrees = 0;
+uint32_t heapFailedAllocs = 0;
+uint32_t heapLastFailedSize = 0;
+
+#if ALLOC_TRACK_ENABLED
+// ALLOC_SCOPE() runs on the loop task; other tasks' allocations are not its own
+TaskHandle_t allocTrackTask = nullptr;
+
+inline bool allocTrackHere() {
+    return allocTrackTask != nullptr && !xPortInIsrContext() &&
+           xTaskGetCurrentTaskHandle() == allocTrackTask;
+}
+#endif
+
+void heapAllocFailed(size_t size, uint32_t caps, const char* functionName) {
+    (void)caps;
+    (void)functionName;
+    __atomic_fetch_add(&heapFailedAllocs, 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&heapLastFailedSize, static_cast<uint32_t>(size), __ATOMIC_RELAXED);
+}
+
+/**
+ * Idle hook: sleep until the next interrupt and count the cycles slept.
+ * Returns false so the idle task does not wait again, uncounted.
+ */
+template <uint8_t CORE>
+bool IRAM_ATTR idleHook() {
+    uint32_t start = ESP.getCycleCount();
+#if defined(__XTENSA__)
+    __asm__ __volatile__("waiti 0");
+#elif defined(__riscv)
+    __asm__ __volatile__("wfi");
+#endif
+    idleMonitor->addIdleCycles(CORE, ESP.getCycleCount() - start);
+    return false;
+}
+
+}  // namespace
+
+#ifdef CONFIG_HEAP_USE_HOOKS
+// Allocator hooks (IDF 5.1+ with CONFIG_HEAP_USE_HOOKS): called on every
+// heap_caps allocation and free, so only a counter each
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+    (void)ptr;
+    (void)size;
+    (void)caps;
+    __atomic_fetch_add(&heapAllocs, 1, __ATOMIC_RELAXED);
+#if ALLOC_TRACK_ENABLED
+    if (allocTrackHere()) {
+        GetAllocTracker().recordAlloc(size);
+    }
+#endif
+}
+
+extern "C" void IRAM_ATTR esp_heap_trace_free_hook(void* ptr) {
+    (void)ptr;
+    __atomic_fetch_add(&heapFrees, 1, __ATOMIC_RELAXED);
+#if ALLOC_TRACK_ENABLED
+    if (allocTrackHere()) {
+        GetAllocTracker().recordFree();
+    }
+#endif
+}
+#endif
+
+ESP32SystemMetrics::ESP32SystemMetrics() : _idleWindowSeen(0) {
+}
+
+void ESP32SystemMetrics::begin() {
+    heap_caps_register_failed_alloc_callback(heapAllocFailed);
+#ifdef CONFIG_HEAP_USE_HOOKS
+    _heap.setCountersAvailable(true);
+#if ALLOC_TRACK_ENABLED
+    allocTrackTask = xTaskGetCurrentTaskHandle();  // begin() runs from setup() on the loop task
+#endif
+#endif
+    sampleHeap(millis());  // Starts the rate window
+
+#if CPU_IDLE_ENABLED
+    if (idleMonitor != nullptr) {
+        return;
+    }
+    idleMonitor = &_cpuIdle;
+    if (esp_register_freertos_idle_hook_for_cpu(idleHook<0>, 0) == ESP_OK) {
+        _cpuIdle.enableCore(0);
+    }
+#if portNUM_PROCESSORS > 1
+    if (esp_register_freertos_idle_hook_for_cpu(idleHook<1>, 1) == ESP_OK) {
+        _cpuIdle.enableCore(1);
+    }
+#endif
+    _cpuIdle.closeWindow(micros(), ESP.getCpuFreqMHz());  // Start the first window
+    _idleWindowSeen = _loopMonitor.getWindowCount();
+#endif
 }
 
 ESP32SystemMetrics::~ESP32SystemMetrics() {
-    // Destructor: No cleanup needed
+#if CPU_IDLE_ENABLED
+    if (idleMonitor == &_cpuIdle) {
+        esp_deregister_freertos_idle_hook_for_cpu(idleHook<0>, 0);
+#if portNUM_PROCESSORS > 1
+        esp_deregister_freertos_idle_hook_for_cpu(idleHook<1>, 1);
+#endif
+        idleMonitor = nullptr;
+    }
+#endif
 }
 
 uint32_t ESP32SystemMetrics::getFreeHeapBytes() {
     return ESP.getFreeHeap();
 }
 
+uint32_t ESP32SystemMetrics::getLargestFreeBlockBytes() {
+    return ESP.getMaxAllocHeap();
+}
+
+uint32_t ESP32SystemMetrics::getMinFreeHeapBytes() {
+    return ESP.getMinFreeHeap();
+}
+
+uint32_t ESP32SystemMetrics::getHeapAllocsPerSecond() {
+    return _heap.getAllocsPerSecond();
+}
+
+uint32_t ESP32SystemMetrics::getHeapFreesPerSecond() {
+    return _heap.getFreesPerSecond();
+}
+
+HeapEvent ESP32SystemMetrics::sampleHeap(uint32_t nowMs) {
+    HeapSample sample;
+    sample.freeBytes = ESP.getFreeHeap();
+    sample.largestFreeBlock = ESP.getMaxAllocHeap();
+    sample.minFreeBytes = ESP.getMinFreeHeap();
+    sample.allocs = __atomic_load_n(&heapAllocs, __ATOMIC_RELAXED);
+    sample.frees = __atomic_load_n(&heapFrees, __ATOMIC_RELAXED);
+    sample.failedAllocs = __atomic_load_n(&heapFailedAllocs, __ATOMIC_RELAXED);
+    sample.lastFailedSize = __atomic_load_n(&heapLastFailedSize, __ATOMIC_RELAXED);
+    return _heap.update(sample, nowMs);
+}
+
 uint32_t ESP32SystemMetrics::getSketchSizeBytes() {
     return ESP.getSketchSize();
 }
@@ -54,12 +191,27 @@ void ESP32SystemMetrics::instrumentLoop() {
      * Instruments the main loop for performance measurement.
      *
      * Call this method at the END of each main loop iteration.
-     * Increments loop counter and calculates frequency every 5 seconds.
+     * Increments loop counter and calculates frequency every 5 seconds;
+     * records the iteration duration in the latency histogram.
      *
-     * Performance: ~5 µs per call (< 0.1% overhead for typical 5ms loops)
+     * Performance: < 2 µs per call (< 0.1% overhead for typical 5ms loops)
      * Constitutional compliance: FR-041 (loop iteration count measured)
      */
     _loopMonitor.endLoop();
+
+    // Idle windows follow the loop frequency windows
+    if (_loopMonitor.getWindowCount() != _idleWindowSeen) {
+        _idleWindowSeen = _loopMonitor.getWindowCount();
+        _cpuIdle.closeWindow(micros(), ESP.getCpuFreqMHz());
+    }
+}
+
+uint8_t ESP32SystemMetrics::getCpuIdlePercent() {
+    return _cpuIdle.getAverageIdlePercent();
+}
+
+uint8_t ESP32SystemMetrics::getCoreIdlePercent(uint8_t core) {
+    return _cpuIdle.getIdlePercent(core);
 }
 
 unsigned long ESP32SystemMetrics::getMillis() {
@@ -68,12 +220,20 @@ unsigned long ESP32SystemMetrics::getMillis() {
 
 #else
 // Stub implementation for native platform (tests use MockSystemMetrics)
-ESP32SystemMetrics::ESP32SystemMetrics() {}
+ESP32SystemMetrics::ESP32SystemMetrics() : _idleWindowSeen(0) {}
 ESP32SystemMetrics::~ESP32SystemMetrics() {}
+void ESP32SystemMetrics::begin() {}
 uint32_t ESP32SystemMetrics::getFreeHeapBytes() { return 250000; }
+uint32_t ESP32SystemMetrics::getLargestFreeBlockBytes() { return 110000; }
+uint32_t ESP32SystemMetrics::getMinFreeHeapBytes() { return 200000; }
+uint32_t ESP32SystemMetrics::getHeapAllocsPerSecond() { return _heap.getAllocsPerSecond(); }
+uint32_t ESP32SystemMetrics::getHeapFreesPerSecond() { return _heap.getFreesPerSecond(); }
+HeapEvent ESP32SystemMetrics::sampleHeap(uint32_t) { return HeapEvent::NONE; }
 uint32_t ESP32SystemMetrics::getSketchSizeBytes() { return 850000; }
 uint32_t ESP32SystemMetrics::getFreeFlashBytes() { return 1000000; }
 uint32_t ESP32SystemMetrics::getLoopFrequency() { return 212; }  // Typical value for tests
-void ESP32SystemMetrics::instrumentLoop() { _loopMonitor.endLoop(); }
+uint8_t ESP32SystemMetrics::getCpuIdlePercent() { return _cpuIdle.getAverageIdlePercent(); }
+uint8_t ESP32SystemMetrics::getCoreIdlePercent(uint8_t core) { return _cpuIdle.getIdlePercent(core); }
+void ESP32SystemMetrics::instrumentLoop() { _loopMonitor.endLoop(0, 0); }
 unsigned long ESP32SystemMetrics::getMillis() { return 0; }
 #endif
@@ -5,7 +5,7 @@
  * Implements ISystemMetrics using ESP32 platform APIs for memory and CPU metrics.
  *
  * Hardware: ESP32 (ESP32, ESP32-S2, ESP32-C3, ESP32-S3)
- * APIs: ESP.h (memory), FreeRTOS (CPU idle time)
+ * APIs: ESP.h (memory), FreeRTOS idle hooks (CPU idle time, see CpuIdleMonitor)
  *
  * Constitutional Compliance:
  * - Principle I (Hardware Abstraction): Implements ISystemMetrics interface
@@ -20,15 +20,19 @@
 
 #include "hal/interfaces/ISystemMetrics.h"
 #include "utils/LoopPerformanceMonitor.h"
+#include "utils/CpuIdleMonitor.h"
+#include "utils/HeapMonitor.h"
 
 /**
  * @brief ESP32 hardware implementation of ISystemMetrics
  *
  * Uses ESP32 platform APIs to retrieve system resource metrics:
- * - ESP.getFreeHeap() for RAM
+ * - ESP.getFreeHeap() for RAM, ESP.getMaxAllocHeap() / ESP.getMinFreeHeap() for fragmentation
+ * - allocator hooks and the failed-allocation callback for the heap rates (HeapMonitor)
  * - ESP.getSketchSize() for code size
  * - ESP.getFreeSketchSpace() for free flash
  * - LoopPerformanceMonitor for main loop frequency
+ * - idle hooks on both cores for CPU idle, windowed with the loop frequency
  * - millis() for timestamp
  */
 class ESP32SystemMetrics : public ISystemMetrics {
@@ -45,26 +49,73 @@ public:
 
     // ISystemMetrics interface implementation
     uint32_t getFreeHeapBytes() override;
+    uint32_t getLargestFreeBlockBytes() override;
+    uint32_t getMinFreeHeapBytes() override;
+    uint32_t getHeapAllocsPerSecond() override;
+    uint32_t getHeapFreesPerSecond() override;
     uint32_t getSketchSizeBytes() override;
     uint32_t getFreeFlashBytes() override;
     uint32_t getLoopFrequency() override;
+    uint8_t getCpuIdlePercent() override;
+    uint8_t getCoreIdlePercent(uint8_t core) override;
     unsigned long getMillis() override;
 
+    /**
+     * @brief Register the idle hooks of every core (CPU_IDLE_ENABLED)
+     *
+     * Each hook sleeps until the next interrupt itself and counts the cycles
+     * (instead of letting the idle task do the same wait uncounted). The
+     * first idle window closes with the first loop frequency window after this.
+     *
+     * Also registers the failed-allocation callback and, where the IDF
+     * has allocator hooks, enables the heap allocation rates.
+     *
+     * @note Call once from setup(); one instance only (the hooks are static)
+     */
+    void begin();
+
+    /**
+     * @brief Sample the heap (every HEAP_SAMPLE_INTERVAL_MS)
+     *
+     * Walks the free list for the largest block (short heap lock).
+     *
+     * @return Fragmentation state change since the previous sample
+     */
+    HeapEvent sampleHeap(uint32_t nowMs);
+
+    /**
+     * @brief Last heap sample, rates and fragmentation state
+     */
+    const HeapMonitor& getHeapMonitor() const { return _heap; }
+
     /**
      * @brief Instruments the main loop for performance measurement
      *
      * Call this method at the END of each main loop iteration.
      * Delegates to internal LoopPerformanceMonitor for frequency calculation.
      *
-     * Performance: ~5 µs per call (< 0.1% overhead for typical 5ms loops)
+     * Performance: < 2 µs per call (< 0.1% overhead for typical 5ms loops)
      *
      * @note Must be called every loop iteration for accurate frequency measurement
      * @note Call from main.cpp loop() function only (not thread-safe)
      */
     void instrumentLoop();
 
+    /**
+     * @brief Loop frequency and iteration latency percentiles of the last window
+     */
+    const LoopPerformanceMonitor& getLoopMonitor() const { return _loopMonitor; }
+
+    /**
+     * @brief Per-core idle percentages of the last window
+     */
+    const CpuIdleMonitor& getCpuIdleMonitor() const { return _cpuIdle; }
+
 private:
-    LoopPerformanceMonitor _loopMonitor;  ///< Performance monitoring utility (16 bytes)
+    LoopPerformanceMonitor _loopMonitor;  ///< Performance monitoring utility (~0.4 KB with latency histograms)
+    CpuIdleMonitor _cpuIdle;              ///< Idle cycles per core, fed by the idle hooks
+    HeapMonitor _heap;                    ///< Heap samples (fragmentation, rates)
+    uint32_t _idleWindowSeen;             ///< Loop window count at the last idle window close
 };
 
 #endif // ESP32_SYSTEM_METRICS_H
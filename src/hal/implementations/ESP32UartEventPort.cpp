@@ -0,0 +1,202 @@
+#include "ESP32UartEventPort.h"
+#include <hal/uart_ll.h>
+
+ESP32UartEventPort::ESP32UartEventPort(uart_port_t uart, int8_t rxPin, int8_t txPin)
+    : uart_(uart), rxPin_(rxPin), txPin_(txPin), installed_(false),
+      eventQueue_(nullptr), taskHandle_(nullptr), peeked_(-1),
+      fifoOverflows_(0), bufferFull_(0), framingErrors_(0),
+      sentenceCount_(0), droppedSentences_(0) {
+}
+
+int ESP32UartEventPort::available() {
+    return static_cast<int>(sentences_.size()) + (peeked_ >= 0 ? 1 : 0);
+}
+
+int ESP32UartEventPort::read() {
+    if (peeked_ >= 0) {
+        int byte = peeked_;
+        peeked_ = -1;
+        return byte;
+    }
+
+    uint8_t byte;
+    return sentences_.pop(byte) ? byte : -1;
+}
+
+int ESP32UartEventPort::peek() {
+    if (peeked_ < 0) {
+        uint8_t byte;
+        if (sentences_.pop(byte)) {
+            peeked_ = byte;
+        }
+    }
+    return peeked_;
+}
+
+size_t ESP32UartEventPort::write(uint8_t byte) {
+    if (!installed_) {
+        return 0;
+    }
+    return uart_write_bytes(uart_, &byte, 1) == 1 ? 1 : 0;
+}
+
+size_t ESP32UartEventPort::writeNonBlocking(const uint8_t* data, size_t size) {
+    // No TX ring is installed: only what fits in the hardware FIFO now is sent
+    if (!installed_ || uart_ll_get_txfifo_len(UART_LL_GET_HW(uart_)) < size) {
+        return 0;
+    }
+    return uart_tx_chars(uart_, reinterpret_cast<const char*>(data), size) == static_cast<int>(size) ? size : 0;
+}
+
+void ESP32UartEventPort::begin(unsigned long baud) {
+    if (installed_) {
+        uart_set_baudrate(uart_, baud);
+        return;
+    }
+
+    uart_config_t config = {};
+    config.baud_rate = static_cast<int>(baud);
+    config.data_bits = UART_DATA_8_BITS;
+    config.parity = UART_PARITY_DISABLE;
+    config.stop_bits = UART_STOP_BITS_1;
+    config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+    config.source_clk = UART_SCLK_APB;
+
+    // RX only needs the driver ring; TX (unused for NMEA input) writes straight to the FIFO
+    if (uart_driver_install(uart_, NMEA0183_UART_RX_BUFFER, 0, NMEA0183_UART_EVENT_QUEUE,
+                            &eventQueue_, 0) != ESP_OK) {
+        return;
+    }
+
+    if (uart_param_config(uart_, &config) != ESP_OK ||
+        uart_set_pin(uart_, txPin_ < 0 ? UART_PIN_NO_CHANGE : txPin_,
+                     rxPin_ < 0 ? UART_PIN_NO_CHANGE : rxPin_,
+                     UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE) != ESP_OK) {
+        uart_driver_delete(uart_);
+        return;
+    }
+
+    // One UART_PATTERN_DET event per '\n', also inside a continuous stream (no idle gaps)
+    uart_enable_pattern_det_baud_intr(uart_, '\n', 1, 9, 0, 0);
+    uart_pattern_queue_reset(uart_, NMEA0183_UART_PATTERN_QUEUE);
+
+    if (xTaskCreatePinnedToCore(taskEntry, "n0183_rx", NMEA0183_UART_TASK_STACK, this,
+                                NMEA0183_UART_TASK_PRIORITY, &taskHandle_,
+                                NMEA0183_UART_TASK_CORE) != pdPASS) {
+        taskHandle_ = nullptr;
+        uart_driver_delete(uart_);
+        return;
+    }
+
+    installed_ = true;
+}
+
+Stream* ESP32UartEventPort::getStream() {
+    return installed_ ? this : nullptr;
+}
+
+bool ESP32UartEventPort::getStats(SerialPortStats& stats) const {
+    stats.fifoOverflows = fifoOverflows_.load(std::memory_order_relaxed);
+    stats.bufferFull = bufferFull_.load(std::memory_order_relaxed);
+    stats.framingErrors = framingErrors_.load(std::memory_order_relaxed);
+    stats.sentences = sentenceCount_.load(std::memory_order_relaxed);
+    stats.droppedSentences = droppedSentences_.load(std::memory_order_relaxed);
+    stats.bufferHighWater = sentences_.getHighWater();
+    return true;
+}
+
+void ESP32UartEventPort::taskEntry(void* param) {
+    ESP32UartEventPort* self = static_cast<ESP32UartEventPort*>(param);
+
+    for (;;) {
+        uart_event_t event;
+        if (xQueueReceive(self->eventQueue_, &event, portMAX_DELAY) == pdTRUE) {
+            self->handleEvent(event);
+        }
+    }
+}
+
+void ESP32UartEventPort::handleEvent(const uart_event_t& event) {
+    switch (event.type) {
+        case UART_PATTERN_DET:
+            readSentences();
+            break;
+
+        case UART_FIFO_OVF:
+            // ISR could not keep up - the line in progress is corrupt
+            fifoOverflows_.fetch_add(1, std::memory_order_relaxed);
+            resync();
+            break;
+
+        case UART_BUFFER_FULL:
+            // Driver ring full - the reader task was starved
+            bufferFull_.fetch_add(1, std::memory_order_relaxed);
+            resync();
+            break;
+
+        case UART_FRAME_ERR:
+            // Bad byte stays in the stream; the sentence checksum rejects it
+            framingErrors_.fetch_add(1, std::memory_order_relaxed);
+            break;
+
+        default:
+            // UART_DATA: bytes stay in the driver ring until their '\n' arrives
+            break;
+    }
+}
+
+void ESP32UartEventPort::readSentences() {
+    int pos = uart_pattern_pop_pos(uart_);
+    if (pos == -1) {
+        // Pattern position queue overflowed - line boundaries are unknown
+        droppedSentences_.fetch_add(1, std::memory_order_relaxed);
+        resync();
+        return;
+    }
+
+    // Positions are relative to the current read point and shift as we read
+    while (pos != -1) {
+        size_t len = static_cast<size_t>(pos) + 1;  // Include the '\n'
+        if (len > MAX_SENTENCE) {
+            discard(len);
+            droppedSentences_.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            int read = uart_read_bytes(uart_, line_, len, pdMS_TO_TICKS(10));
+            if (read <= 0) {
+                return;
+            }
+            forward(static_cast<size_t>(read));
+        }
+        pos = uart_pattern_pop_pos(uart_);
+    }
+}
+
+void ESP32UartEventPort::forward(size_t len) {
+    // Whole sentence or nothing, so the parser never sees a truncated line
+    if (NMEA0183_UART_SENTENCE_BUFFER - sentences_.size() < len) {
+        droppedSentences_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    for (size_t i = 0; i < len; i++) {
+        sentences_.push(line_[i]);
+    }
+    sentenceCount_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ESP32UartEventPort::discard(size_t len) {
+    while (len > 0) {
+        size_t chunk = len < MAX_SENTENCE ? len : MAX_SENTENCE;
+        int read = uart_read_bytes(uart_, line_, chunk, pdMS_TO_TICKS(10));
+        if (read <= 0) {
+            return;
+        }
+        len -= static_cast<size_t>(read);
+    }
+}
+
+void ESP32UartEventPort::resync() {
+    // Drop buffered bytes and stale events (incl. pattern positions); restart at the next line
+    uart_flush_input(uart_);
+    xQueueReset(eventQueue_);
+}
@@ -0,0 +1,132 @@
+#ifndef ESP32UARTEVENTPORT_H
+#define ESP32UARTEVENTPORT_H
+
+#include "hal/interfaces/ISerialPort.h"
+#include <Arduino.h>
+#include <atomic>
+#include <driver/uart.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/queue.h>
+#include <freertos/task.h>
+#include "utils/SPSCQueue.h"
+#include "config.h"
+
+/**
+ * @file ESP32UartEventPort.h
+ * @brief ESP-IDF UART driver implementation of ISerialPort (event queue mode)
+ *
+ * Replaces the polled Arduino HardwareSerial path for NMEA 0183 input. At
+ * 38400 baud the 256-byte HardwareSerial buffer fills in ~65 ms, so one slow
+ * main-loop pass (web request, flash write) overflowed it and sentences were
+ * lost without a trace. Here:
+ * - The IDF UART driver's ISR empties the 128-byte hardware FIFO into a large
+ *   RX ring (NMEA0183_UART_RX_BUFFER) independent of the main loop
+ * - Pattern detection on '\n' posts a UART_PATTERN_DET event per line; a
+ *   reader task sleeps on the event queue and wakes only for complete
+ *   sentences, which it moves as a whole into a lock-free ring for the parser
+ * - FIFO overflow, RX buffer full and framing error events are counted
+ *   (getStats()) instead of silently dropping data
+ *
+ * The parser side keeps the ISerialPort/Stream interface (getStream()
+ * returns this object), so NMEA0183Handler runs unchanged on the main loop.
+ *
+ * Constitutional Compliance:
+ * - Principle I (Hardware Abstraction): implements ISerialPort
+ * - Principle II (Resource Management): fixed-size rings, allocated once in begin()
+ * - Principle VII (Fail-Safe): a full parser ring drops whole sentences, never partial ones
+ *
+ * Usage:
+ * @code
+ * ISerialPort* serial0183 = new ESP32UartEventPort(UART_NUM_2, 25, 27);
+ * NMEA0183Handler handler(serial0183, boatData, &logger);
+ * handler.init();                                   // begin(38400)
+ * @endcode
+ *
+ * @note Owns the UART - do not also begin() the HardwareSerial of the same port.
+ */
+class ESP32UartEventPort : public ISerialPort, public Stream {
+public:
+    /**
+     * @brief Constructor
+     *
+     * @param uart UART controller (e.g., UART_NUM_2)
+     * @param rxPin RX GPIO pin (-1 = keep current pin)
+     * @param txPin TX GPIO pin (-1 = keep current pin)
+     */
+    ESP32UartEventPort(uart_port_t uart, int8_t rxPin = -1, int8_t txPin = -1);
+
+    /**
+     * @brief Bytes of complete sentences waiting for the parser
+     */
+    int available() override;
+
+    /**
+     * @brief Read one byte of a complete sentence
+     *
+     * @return Byte value (0-255) or -1 if no sentence is pending
+     */
+    int read() override;
+
+    /**
+     * @brief Next byte without consuming it, -1 if none
+     */
+    int peek() override;
+
+    size_t write(uint8_t byte) override;
+
+    /**
+     * @brief Queue @p size bytes in the TX FIFO if they all fit now, else none
+     */
+    size_t writeNonBlocking(const uint8_t* data, size_t size) override;
+
+    /**
+     * @brief Install the UART driver (first call) or change the baud rate
+     *
+     * Configures 8N1, '\n' pattern detection and starts the reader task.
+     * On failure getStream() returns nullptr.
+     *
+     * @param baud Baud rate (38400 for the NMEA 0183 input)
+     */
+    void begin(unsigned long baud) override;
+
+    /**
+     * @brief This object as Stream once the driver is installed, else nullptr
+     */
+    Stream* getStream() override;
+
+    bool getStats(SerialPortStats& stats) const override;
+
+    /// Sentence reader task (nullptr until begin() succeeded)
+    TaskHandle_t getTaskHandle() const { return taskHandle_; }
+
+private:
+    static constexpr size_t MAX_SENTENCE = 128;  ///< Longer lines are discarded (NMEA max is 82)
+
+    uart_port_t uart_;
+    int8_t rxPin_;
+    int8_t txPin_;
+    bool installed_;
+    QueueHandle_t eventQueue_;
+    TaskHandle_t taskHandle_;
+    int peeked_;                   ///< Byte fetched by peek(), -1 if none (parser side)
+
+    /// Complete sentences (reader task → parser)
+    SPSCQueue<uint8_t, NMEA0183_UART_SENTENCE_BUFFER> sentences_;
+    uint8_t line_[MAX_SENTENCE];   ///< Reader task scratch line
+
+    // Written by the reader task only
+    std::atomic<uint32_t> fifoOverflows_;
+    std::atomic<uint32_t> bufferFull_;
+    std::atomic<uint32_t> framingErrors_;
+    std::atomic<uint32_t> sentenceCount_;
+    std::atomic<uint32_t> droppedSentences_;
+
+    static void taskEntry(void* param);
+    void handleEvent(const uart_event_t& event);
+    void readSentences();
+    void forward(size_t len);
+    void discard(size_t len);
+    void resync();
+};
+
+#endif // ESP32UARTEVENTPORT_H
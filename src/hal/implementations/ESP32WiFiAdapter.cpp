@@ -42,6 +42,33 @@ bool ESP32WiFiAdapter::begin(const char* ssid, const char* password) {
     return true;
 }
 
+bool ESP32WiFiAdapter::beginDirected(const char* ssid, const char* password, uint8_t channel, const uint8_t bssid[6]) {
+    if (ssid == nullptr || strlen(ssid) == 0 || bssid == nullptr || channel == 0) {
+        return false;
+    }
+
+    if (WiFi.status() == WL_CONNECTED) {
+        WiFi.disconnect();
+        delay(100);
+    }
+
+    // Channel and BSSID given: the driver associates without scanning
+    WiFi.begin(ssid, (password != nullptr && strlen(password) > 0) ? password : nullptr,
+               channel, bssid, true);
+    return true;
+}
+
+bool ESP32WiFiAdapter::setStaticIP(const WiFiStaticIP* config) {
+    if (config == nullptr || !config->enabled()) {
+        // All INADDR_NONE: DHCP client back on
+        return WiFi.config(INADDR_NONE, INADDR_NONE, INADDR_NONE, INADDR_NONE);
+    }
+    return WiFi.config(IPAddress(config->ip[0], config->ip[1], config->ip[2], config->ip[3]),
+                       IPAddress(config->gateway[0], config->gateway[1], config->gateway[2], config->gateway[3]),
+                       IPAddress(config->subnet[0], config->subnet[1], config->subnet[2], config->subnet[3]),
+                       IPAddress(config->dns[0], config->dns[1], config->dns[2], config->dns[3]));
+}
+
 WiFiStatus ESP32WiFiAdapter::status() {
     return convertStatus(WiFi.status());
 }
@@ -79,6 +106,53 @@ String ESP32WiFiAdapter::getSSID() {
     return "";
 }
 
+bool ESP32WiFiAdapter::getBSSID(uint8_t bssid[6]) {
+    if (WiFi.status() != WL_CONNECTED) {
+        return false;
+    }
+    const uint8_t* current = WiFi.BSSID();
+    if (current == nullptr) {
+        return false;
+    }
+    memcpy(bssid, current, 6);
+    return true;
+}
+
+uint8_t ESP32WiFiAdapter::getChannel() {
+    if (WiFi.status() == WL_CONNECTED) {
+        return static_cast<uint8_t>(WiFi.channel());
+    }
+    return 0;
+}
+
+bool ESP32WiFiAdapter::startAccessPoint(const char* ssid, const char* password, uint8_t channel) {
+    if (ssid == nullptr || strlen(ssid) == 0) {
+        return false;
+    }
+    // Station keeps running: attempts continue while the AP serves clients
+    if (!WiFi.mode(WIFI_AP_STA)) {
+        return false;
+    }
+    bool open = password == nullptr || strlen(password) == 0;
+    return WiFi.softAP(ssid, open ? nullptr : password, channel, 0, WIFI_AP_MAX_STATIONS);
+}
+
+bool ESP32WiFiAdapter::stopAccessPoint() {
+    if ((WiFi.getMode() & WIFI_AP) == 0) {
+        return false;
+    }
+    WiFi.softAPdisconnect(true);   // Also leaves AP+STA for station only
+    return true;
+}
+
+uint8_t ESP32WiFiAdapter::getAccessPointStations() {
+    return (WiFi.getMode() & WIFI_AP) != 0 ? WiFi.softAPgetStationNum() : 0;
+}
+
+String ESP32WiFiAdapter::getAccessPointIP() {
+    return WiFi.softAPIP().toString();
+}
+
 WiFiStatus ESP32WiFiAdapter::convertStatus(wl_status_t wifiStatus) {
     switch (wifiStatus) {
         case WL_IDLE_STATUS:
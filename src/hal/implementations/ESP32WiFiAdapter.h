@@ -30,12 +30,20 @@ public:
 
     // IWiFiAdapter interface implementation
     bool begin(const char* ssid, const char* password) override;
+    bool beginDirected(const char* ssid, const char* password, uint8_t channel, const uint8_t bssid[6]) override;
+    bool setStaticIP(const WiFiStaticIP* config) override;
     WiFiStatus status() override;
     bool disconnect() override;
     void onEvent(WiFiEventCallback callback) override;
     String getIPAddress() override;
     int getRSSI() override;
     String getSSID() override;
+    bool getBSSID(uint8_t bssid[6]) override;
+    uint8_t getChannel() override;
+    bool startAccessPoint(const char* ssid, const char* password, uint8_t channel) override;
+    bool stopAccessPoint() override;
+    uint8_t getAccessPointStations() override;
+    String getAccessPointIP() override;
 
 private:
     /**
@@ -4,6 +4,7 @@
  */
 
 #include "LittleFSAdapter.h"
+#include "../../utils/OtaUpdate.h"
 
 LittleFSAdapter::LittleFSAdapter() : isMounted(false) {
 }
@@ -54,7 +55,7 @@ String LittleFSAdapter::readFile(const char* path) {
 }
 
 bool LittleFSAdapter::writeFile(const char* path, const char* content) {
-    if (!isMounted) {
+    if (!isMounted || OtaFilesystemLocked()) {
         return false;
     }
 
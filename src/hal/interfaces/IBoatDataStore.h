@@ -9,6 +9,7 @@
  *
  * Usage:
  * - Read access: Components can retrieve current sensor data
+ * - In-process reads: view*() refer to the stored group without copying it
  * - Write access: Calculation engine can update derived parameters
  * - Mocking: Tests can use MockBoatDataStore for isolated testing
  *
@@ -22,6 +23,7 @@
 #define IBOAT_DATA_STORE_H
 
 #include "../../types/BoatDataTypes.h"
+#include "../../utils/BoatDataView.h"
 
 /**
  * @brief Abstract interface for boat data storage
@@ -145,6 +147,24 @@ public:
      * @param data Calibration data to store
      */
     virtual void setCalibration(const CalibrationData& data) = 0;
+
+    // =========================================================================
+    // ZERO-COPY VIEWS
+    // =========================================================================
+
+    /**
+     * @brief Views of the stored groups for in-process readers
+     *
+     * Same data as the get*() above without the copy; check valid() after
+     * reading through a view taken outside the writer task (BoatDataView).
+     */
+    virtual BoatDataView<GPSData> viewGPSData() const = 0;
+    virtual BoatDataView<CompassData> viewCompassData() const = 0;
+    virtual BoatDataView<WindData> viewWindData() const = 0;
+    virtual BoatDataView<SpeedData> viewSpeedData() const = 0;
+    virtual BoatDataView<RudderData> viewRudderData() const = 0;
+    virtual BoatDataView<DerivedData> viewDerivedData() const = 0;
+    virtual BoatDataView<CalibrationData> viewCalibration() const = 0;
 };
 
 #endif // IBOAT_DATA_STORE_H
@@ -121,9 +121,11 @@ public:
      *
      * Persists calibration parameters to /calibration.json on LittleFS.
      * Validates parameters before saving. Calibration survives system reboots.
+     * An implementation may defer the write (CalibrationManager writes
+     * behind, once the parameters stopped changing).
      *
      * @param params Parameters to persist
-     * @return true if saved successfully, false if validation failed or filesystem error
+     * @return true if saved (or accepted for a deferred write), false if validation failed or filesystem error
      *
      * @example
      * // After user updates calibration via web interface
@@ -0,0 +1,66 @@
+/**
+ * @file IConfigStore.h
+ * @brief Hardware abstraction interface for the key/blob configuration store (NVS)
+ *
+ * Holds the binary configuration records (ConfigRecord.h) of calibration and
+ * the Wi-Fi network list. The ESP32 implementation keeps them in the NVS
+ * partition, which is independent of LittleFS: a reformatted or corrupted
+ * filesystem leaves them intact.
+ *
+ * Usage:
+ * @code
+ * IConfigStore* store = new ESP32NvsConfigStore();
+ * store->begin();
+ * uint8_t buffer[CONFIG_RECORD_MAX_BYTES];
+ * size_t length = store->read("calibration", buffer, sizeof(buffer));  // 0 = none
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef I_CONFIG_STORE_H
+#define I_CONFIG_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Abstract interface for configuration blob storage
+ *
+ * Keys are at most 15 characters (NVS limit). Implementations must be safe
+ * to call from the main loop and the HTTP task.
+ */
+class IConfigStore {
+public:
+    virtual ~IConfigStore() {}
+
+    /**
+     * @brief Open the store
+     * @return true if the store can be used
+     */
+    virtual bool begin() = 0;
+
+    /**
+     * @brief Read the blob stored under @p key
+     * @param key Record name (1-15 characters)
+     * @param out Destination buffer
+     * @param size Capacity of @p out
+     * @return Bytes read, 0 if there is no blob or it is larger than @p size
+     */
+    virtual size_t read(const char* key, uint8_t* out, size_t size) = 0;
+
+    /**
+     * @brief Replace the blob stored under @p key
+     * @return true if all @p length bytes were written
+     */
+    virtual bool write(const char* key, const uint8_t* data, size_t length) = 0;
+
+    /**
+     * @brief Delete the blob stored under @p key
+     * @return true if it is gone (also if there was none)
+     */
+    virtual bool remove(const char* key) = 0;
+};
+
+#endif // I_CONFIG_STORE_H
@@ -108,6 +108,21 @@ public:
      */
     virtual void print(const char* text) = 0;
 
+    /**
+     * @brief Draw a number in 12x16 digits at a page-aligned position
+     *
+     * Copies glyphs from the BigDigitFont atlas straight into the
+     * framebuffer (24 bytes per character) instead of scaling the text font
+     * pixel by pixel. Characters: '0'-'9', '-', '.', ' '; others draw as a
+     * blank cell. Opaque, so a number replaces the one drawn before it. The
+     * text cursor and size are not changed.
+     *
+     * @param x Left column (0-127)
+     * @param page Top SSD1306 page (0-6, pixel row page * 8)
+     * @param text Characters to draw (right-align with spaces to erase a longer value)
+     */
+    virtual void drawBigNumber(uint8_t x, uint8_t page, const char* text) = 0;
+
     /**
      * @brief Push framebuffer to physical display
      *
@@ -117,6 +132,8 @@ public:
      * Performance:
      * - I2C transaction: ~10ms typical @ 400kHz
      * - Full screen refresh: Acceptable for 1-5 second update intervals (FR-016, FR-016a)
+     * - ESP32DisplayAdapter sends only what changed since the last call (a
+     *   reprinted character: a few bytes); after clear() the whole frame
      *
      * @note Must be called after rendering operations (clear, setCursor, print)
      * to make changes visible.
@@ -0,0 +1,69 @@
+/**
+ * @file IFirmwareUpdater.h
+ * @brief Hardware abstraction interface for writing an OTA image to flash
+ *
+ * Receives an image in chunks and writes it to the inactive OTA app slot or
+ * the LittleFS data partition. The ESP32 implementation uses the Arduino
+ * Update library; writes erase one sector at a time, so memory use does not
+ * depend on the image size.
+ *
+ * Usage:
+ * @code
+ * IFirmwareUpdater* updater = new ESP32FirmwareUpdater();
+ * updater->begin(OtaTarget::FIRMWARE, nullptr);
+ * updater->write(chunk, length);         // Repeated
+ * if (updater->end() == OtaError::NONE) { ... boots the new image after a restart ... }
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef I_FIRMWARE_UPDATER_H
+#define I_FIRMWARE_UPDATER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../../utils/OtaUpdate.h"
+
+/**
+ * @brief Abstract interface for OTA image writes
+ *
+ * One image at a time; called from one task.
+ */
+class IFirmwareUpdater {
+public:
+    virtual ~IFirmwareUpdater() {}
+
+    /**
+     * @brief Size of the partition @p target writes to
+     * @return Bytes, 0 if the partition table has none
+     */
+    virtual uint32_t capacity(OtaTarget target) = 0;
+
+    /**
+     * @brief Open @p target for a new image
+     * @param md5 Expected MD5 of the whole image (32 lowercase hex digits), nullptr = none
+     */
+    virtual bool begin(OtaTarget target, const char* md5) = 0;
+
+    /**
+     * @brief Append image bytes
+     * @return Bytes written (less than @p length on a flash error)
+     */
+    virtual size_t write(const uint8_t* data, size_t length) = 0;
+
+    /**
+     * @brief Verify the image and make it the next boot (firmware) or leave it in place (filesystem)
+     * @return NONE, HASH_MISMATCH, VERIFY_FAILED or WRITE_FAILED
+     */
+    virtual OtaError end() = 0;
+
+    /// Discard the image being written
+    virtual void abort() = 0;
+
+    /// Description of the last error (for logs)
+    virtual const char* lastError() = 0;
+};
+
+#endif // I_FIRMWARE_UPDATER_H
@@ -0,0 +1,50 @@
+/**
+ * @file II2cDevice.h
+ * @brief HAL interface for register access to one device on an I2C bus
+ *
+ * The two transactions a register-mapped sensor needs. Each call is one
+ * bus transaction (START ... STOP, a repeated START between the register
+ * address and the read), so a caller sharing the bus with another task
+ * never sees its transfer split by the other one.
+ *
+ * Implementations:
+ * - ESP32I2cDevice: Arduino Wire on the OLED bus (OLED_SDA_PIN / OLED_SCL_PIN)
+ * - MockIcm20948: scripted ICM-20948 register map and FIFO for native tests
+ *
+ * Constitutional compliance: Principle I (Hardware Abstraction Layer)
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef I_I2C_DEVICE_H
+#define I_I2C_DEVICE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @brief Register-mapped I2C device
+ */
+class II2cDevice {
+public:
+    virtual ~II2cDevice() = default;
+
+    /**
+     * @brief Write one register
+     * @return true if the device acknowledged address, register and value
+     */
+    virtual bool writeRegister(uint8_t reg, uint8_t value) = 0;
+
+    /**
+     * @brief Burst read starting at @p reg
+     *
+     * The device auto-increments the register address (or, for a FIFO data
+     * register, returns consecutive FIFO bytes).
+     *
+     * @return true if all @p length bytes were read
+     */
+    virtual bool readRegisters(uint8_t reg, uint8_t* out, size_t length) = 0;
+};
+
+#endif // I_I2C_DEVICE_H
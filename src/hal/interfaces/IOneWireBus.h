@@ -0,0 +1,44 @@
+/**
+ * @file IOneWireBus.h
+ * @brief HAL interface for byte-level 1-Wire bus access
+ *
+ * The three primitives every 1-Wire transaction is built from. Each call
+ * is short and bounded (reset ~1 ms, one byte ~0.6 ms at standard speed),
+ * so OneWireConversion can split a device read across loop ticks.
+ *
+ * Implementations:
+ * - ESP32OneWireBus: OneWire library on the sensor GPIO (ESP32OneWireSensors.h)
+ * - MockOneWireBus: scripted DS2438 devices for native tests
+ *
+ * Constitutional compliance: Principle I (Hardware Abstraction Layer)
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef I_ONEWIRE_BUS_H
+#define I_ONEWIRE_BUS_H
+
+#include <stdint.h>
+
+/**
+ * @brief Byte-level 1-Wire bus
+ */
+class IOneWireBus {
+public:
+    virtual ~IOneWireBus() = default;
+
+    /**
+     * @brief Reset pulse
+     * @return true if at least one device answered with a presence pulse
+     */
+    virtual bool reset() = 0;
+
+    /// Write one byte, LSB first
+    virtual void write(uint8_t value) = 0;
+
+    /// Read one byte, LSB first
+    virtual uint8_t read() = 0;
+};
+
+#endif // I_ONEWIRE_BUS_H
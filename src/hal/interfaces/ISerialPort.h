@@ -1,6 +1,9 @@
 #ifndef ISERIALPORT_H
 #define ISERIALPORT_H
 
+#include <stdint.h>
+#include <stddef.h>
+
 /**
  * @file ISerialPort.h
  * @brief Hardware Abstraction Layer interface for serial port communication
@@ -17,6 +20,19 @@
  *
  * Reference: specs/006-nmea-0183-handlers/contracts/ISerialPort.contract.md
  */
+
+/**
+ * @brief Receive error counters of a serial port (since begin())
+ */
+struct SerialPortStats {
+    uint32_t fifoOverflows;     ///< Hardware RX FIFO overflowed before the driver emptied it
+    uint32_t bufferFull;        ///< Driver RX buffer full (bytes discarded)
+    uint32_t framingErrors;     ///< Stop bit missing (baud mismatch or line noise)
+    uint32_t sentences;         ///< Complete sentences handed to the parser
+    uint32_t droppedSentences;  ///< Sentences discarded (parser buffer full or oversized)
+    uint32_t bufferHighWater;   ///< Deepest parser buffer fill (bytes)
+};
+
 class ISerialPort {
 public:
     /**
@@ -71,6 +87,58 @@ public:
      */
     virtual class Stream* getStream() = 0;
 
+    /**
+     * @brief Read receive error counters
+     *
+     * Ports without driver-level instrumentation keep the default.
+     *
+     * @param stats Output: counters since begin()
+     * @return false if this port does not provide counters
+     */
+    virtual bool getStats(SerialPortStats& stats) const {
+        (void)stats;
+        return false;
+    }
+
+    /**
+     * @brief Whether this port delivers whole sentences (readSentence()) instead of bytes
+     *
+     * Network inputs receive complete datagrams; reading them back byte by
+     * byte would only split what is already split. Sentence ports have no
+     * Stream (getStream() returns nullptr) and read() returns -1.
+     */
+    virtual bool isSentencePort() const { return false; }
+
+    /**
+     * @brief Pop one whole received sentence (sentence ports only)
+     *
+     * @param line Output buffer (not NUL-terminated, without line end)
+     * @param size Buffer size
+     * @return Sentence length, 0 if none is pending
+     */
+    virtual size_t readSentence(char* line, size_t size) {
+        (void)line;
+        (void)size;
+        return 0;
+    }
+
+    /**
+     * @brief Queue bytes for transmission whole, without waiting
+     *
+     * For latency-bound output (the autopilot fast path): the bytes go to
+     * the transmit buffer only if all of them fit, otherwise nothing is
+     * written. Receive-only ports keep the default.
+     *
+     * @param data Bytes to send
+     * @param size Byte count
+     * @return @p size if queued, 0 if dropped
+     */
+    virtual size_t writeNonBlocking(const uint8_t* data, size_t size) {
+        (void)data;
+        (void)size;
+        return 0;
+    }
+
     /**
      * @brief Virtual destructor for proper cleanup
      *
@@ -3,12 +3,15 @@
  * @brief Abstract interface for multi-source data management
  *
  * This interface defines the contract for managing multiple data sources for
- * GPS and compass sensors. It handles automatic prioritization based on update
+ * each sensor type (GPS, compass, wind, DST, rudder, engine, battery). It handles automatic prioritization based on update
  * frequency, manual override, failover, and stale detection.
  *
  * Usage:
  * - Startup: registerSource() for each available source
+ * - Lookup: findSource() for the index of a registered (type, ID)
  * - Data update: updateSourceTimestamp() on each sensor update
+ * - Rejection: recordRejection() for dropped or invalid updates
+ * - Fix details: updateSourceQuality() when a GPS source reports them
  * - Periodic: updatePriorities() to recalculate based on frequency
  * - Periodic: checkStale() to detect failed sources
  * - Query: getActiveSource() to determine which source to use
@@ -25,6 +28,15 @@
 
 #include "../../types/BoatDataTypes.h"
 
+/**
+ * @brief Why an update from a registered source was not used
+ */
+enum class SourceRejection : uint8_t {
+    INVALID = 0,   ///< Failed range validation
+    INACTIVE = 1,  ///< Another source of the same sensor type is active
+    OUTLIER = 2    ///< Flagged against the field's recent history (HampelFilter)
+};
+
 /**
  * @brief Abstract interface for source prioritization
  *
@@ -34,7 +46,10 @@
  *
  * Priority algorithm:
  * 1. Manual override (if set) always wins
- * 2. Automatic: highest update frequency (Hz) wins
+ * 2. Automatic: highest score wins, the update rate (EWMA of the intervals)
+ *    weighted by quality (fix, HDOP, satellites, rejection rate, jitter);
+ *    a running source is only replaced after a minimum dwell time and by a
+ *    clearly better one (hysteresis)
  * 3. Failover: switch to next-best available source when active becomes stale (>5s)
  */
 class ISourcePrioritizer {
@@ -44,14 +59,15 @@ public:
     /**
      * @brief Register a new data source
      *
-     * Registers a source for GPS or compass data. Call during system startup
-     * for each available sensor. Maximum 5 sources per sensor type.
+     * Registers a source of any sensor type. Call during system startup or
+     * when a sender is first seen. Maximum 5 sources per sensor type and 16
+     * in total. Registering a (type, sourceId) pair again returns its index.
      *
      * @param sourceId Human-readable identifier (e.g., "GPS-NMEA2000", "GPS-NMEA0183")
      *                 Maximum 15 characters
-     * @param type Sensor type (GPS or COMPASS)
+     * @param type Sensor type
      * @param protocol Protocol type (NMEA0183, NMEA2000, ONEWIRE)
-     * @return Source index (0-4 for GPS, 0-4 for compass), or -1 if registration failed
+     * @return Source index (unique across sensor types), or -1 if registration failed
      *
      * @example
      * int gpsA = prioritizer->registerSource("GPS-NMEA0183", SensorType::GPS, ProtocolType::NMEA0183);
@@ -59,6 +75,18 @@ public:
      */
     virtual int registerSource(const char* sourceId, SensorType type, ProtocolType protocol) = 0;
 
+    /**
+     * @brief Index of a registered source
+     *
+     * Constant time (hashed). Source IDs are unique per sensor type, so the
+     * same ID may be registered once for GPS and once for compass.
+     *
+     * @param sourceId Identifier passed to registerSource() (compared up to 15 characters)
+     * @param type Sensor type it was registered for
+     * @return Source index, or -1 if not registered
+     */
+    virtual int findSource(const char* sourceId, SensorType type) = 0;
+
     /**
      * @brief Update timestamp for a source
      *
@@ -75,14 +103,41 @@ public:
      */
     virtual void updateSourceTimestamp(int sourceIndex, unsigned long timestamp) = 0;
 
+    /**
+     * @brief Count an update from a source that was not used
+     *
+     * INVALID and OUTLIER increment rejectedCount (OUTLIER also
+     * outlierCount), INACTIVE increments droppedCount.
+     * The source's timestamp is still updated by the caller, so a dropped
+     * source stays available as a failover candidate.
+     *
+     * @param sourceIndex Index returned from registerSource()
+     * @param reason Why the update was not used
+     */
+    virtual void recordRejection(int sourceIndex, SourceRejection reason) = 0;
+
+    /**
+     * @brief Report the fix details of a GPS source
+     *
+     * Call when a sentence or PGN carries them (GGA, PGN 129029), also for
+     * sources that are not active so they can compete. A source that never
+     * reports them is scored on rate, rejections and jitter only.
+     *
+     * @param sourceIndex Index returned from registerSource()
+     * @param fixQuality GNSS method (0 = no fix, 1 = GNSS, 2 = DGNSS, 4/5 = RTK)
+     * @param satellites Satellites used in the fix (0 = unknown)
+     * @param hdop Horizontal dilution of precision (<= 0 = unknown)
+     */
+    virtual void updateSourceQuality(int sourceIndex, uint8_t fixQuality, uint8_t satellites, double hdop) = 0;
+
     /**
      * @brief Get active source for a sensor type
      *
      * Returns the index of the currently active (highest priority) source for
-     * GPS or compass. If manual override is set, returns the override source.
+     * a sensor type. If manual override is set, returns the override source.
      * Otherwise, returns the highest-frequency available source.
      *
-     * @param type Sensor type (GPS or COMPASS)
+     * @param type Sensor type
      * @return Source index of active source, or -1 if none available
      *
      * @example
@@ -113,7 +168,7 @@ public:
      * Removes manual override for a sensor type, restoring automatic frequency-based
      * prioritization.
      *
-     * @param type Sensor type to clear override for (GPS or COMPASS)
+     * @param type Sensor type to clear override for
      *
      * @example
      * // User clicks "Auto" in web interface
@@ -154,16 +209,17 @@ public:
     virtual SensorSource getSource(int sourceIndex) = 0;
 
     /**
-     * @brief Update priorities based on frequency
+     * @brief Update priorities based on rate and quality
      *
-     * Recalculates update frequencies for all sources and selects the highest-frequency
-     * available source as active (unless manual override is set). Call periodically
+     * Recomputes the score of every source and selects the best available
+     * source of each sensor type as active (unless manual override is set). Call periodically
      * (e.g., every 10 seconds) or after significant updates.
      *
      * Algorithm:
-     * 1. Calculate frequency for each source: updateCount / elapsed time
-     * 2. Sort by frequency (descending)
-     * 3. Select highest-frequency available source (no manual override)
+     * 1. Score each source: update rate × quality
+     * 2. Select the highest-scoring available source (no manual override)
+     * 3. Keep a running source within its dwell time, or unless the best
+     *    one beats it by the hysteresis margin
      *
      * @example
      * // In ReactESP event loop (every 10 seconds)
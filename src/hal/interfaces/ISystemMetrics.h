@@ -18,6 +18,7 @@
 #define I_SYSTEM_METRICS_H
 
 #include <stdint.h>
+#include "config.h"
 
 /**
  * @brief System metrics interface for ESP32 platform APIs
@@ -46,6 +47,43 @@ public:
      */
     virtual uint32_t getFreeHeapBytes() = 0;
 
+    /**
+     * @brief Get the largest heap block that can be allocated in one piece
+     *
+     * With a fragmented heap this is far below getFreeHeapBytes(): an
+     * allocation larger than it fails however much is free.
+     *
+     * Implementation: ESP.getMaxAllocHeap()
+     *
+     * @return Largest free block in bytes
+     */
+    virtual uint32_t getLargestFreeBlockBytes() = 0;
+
+    /**
+     * @brief Get the lowest free heap since boot
+     *
+     * Implementation: ESP.getMinFreeHeap()
+     *
+     * @return Free heap low-water mark in bytes
+     */
+    virtual uint32_t getMinFreeHeapBytes() = 0;
+
+    /**
+     * @brief Get heap allocations per second over the last sample window
+     *
+     * Counted by the allocator hooks (IDF with CONFIG_HEAP_USE_HOOKS), see HeapMonitor.
+     *
+     * @return Allocations per second, or HEAP_RATE_UNKNOWN without hooks or before the second sample
+     */
+    virtual uint32_t getHeapAllocsPerSecond() = 0;
+
+    /**
+     * @brief Get heap frees per second over the last sample window
+     *
+     * @return Frees per second, or HEAP_RATE_UNKNOWN (see getHeapAllocsPerSecond())
+     */
+    virtual uint32_t getHeapFreesPerSecond() = 0;
+
     /**
      * @brief Get sketch (uploaded code) size in bytes
      *
@@ -110,6 +148,27 @@ public:
      */
     virtual uint32_t getLoopFrequency() = 0;
 
+    /**
+     * @brief Get CPU idle percentage, averaged over the cores
+     *
+     * Share of the last 5-second window that the FreeRTOS idle tasks spent
+     * asleep waiting for an interrupt (see CpuIdleMonitor). Unlike the loop
+     * frequency, this is real headroom: a busy-polling loop still reads low.
+     *
+     * @return 0-100, or CPU_IDLE_UNKNOWN (255) before the first window completes
+     *
+     * @see getCoreIdlePercent()
+     */
+    virtual uint8_t getCpuIdlePercent() = 0;
+
+    /**
+     * @brief Get idle percentage of one core over the last 5-second window
+     *
+     * @param core 0 (PRO_CPU: WiFi, lwIP, bus I/O in TASK_LAYOUT 1) or 1 (APP_CPU: Arduino loop)
+     * @return 0-100, or CPU_IDLE_UNKNOWN (255) if not measured (yet)
+     */
+    virtual uint8_t getCoreIdlePercent(uint8_t core) = 0;
+
     /**
      * @brief Get current millisecond timestamp
      *
@@ -20,6 +20,7 @@
 #define I_WIFI_ADAPTER_H
 
 #include <Arduino.h>
+#include "../../utils/WiFiFastConnect.h"
 
 /**
  * @brief WiFi connection status enumeration
@@ -65,6 +66,23 @@ public:
      */
     virtual bool begin(const char* ssid, const char* password) = 0;
 
+    /**
+     * @brief Connection attempt to a known access point (no channel scan)
+     * @param ssid Network SSID (1-32 characters)
+     * @param password WPA2 password (0 or 8-63 characters)
+     * @param channel Channel the access point was seen on (1-14)
+     * @param bssid MAC address of the access point
+     * @return true if connection attempt started successfully
+     */
+    virtual bool beginDirected(const char* ssid, const char* password, uint8_t channel, const uint8_t bssid[6]) = 0;
+
+    /**
+     * @brief Address used by the next connection attempt
+     * @param config Static address, nullptr for DHCP
+     * @return true if the configuration was accepted
+     */
+    virtual bool setStaticIP(const WiFiStaticIP* config) = 0;
+
     /**
      * @brief Get current WiFi connection status
      * @return Current WiFi status
@@ -100,6 +118,46 @@ public:
      * @return SSID string (empty if not connected)
      */
     virtual String getSSID() = 0;
+
+    /**
+     * @brief Get BSSID of the access point currently connected to
+     * @param bssid Receives the MAC address
+     * @return false if not connected
+     */
+    virtual bool getBSSID(uint8_t bssid[6]) = 0;
+
+    /**
+     * @brief Get channel of the connected network
+     * @return Channel number (0 if not connected)
+     */
+    virtual uint8_t getChannel() = 0;
+
+    /**
+     * @brief Start the device's own access point next to the station (AP+STA)
+     * @param ssid Network name
+     * @param password WPA2 passphrase (8-63 characters; empty = open network)
+     * @param channel Channel until the station associates (then the AP follows it)
+     * @return false if the access point could not be started
+     */
+    virtual bool startAccessPoint(const char* ssid, const char* password, uint8_t channel) = 0;
+
+    /**
+     * @brief Stop the access point, station only again
+     * @return false if it was not running
+     */
+    virtual bool stopAccessPoint() = 0;
+
+    /**
+     * @brief Devices associated to the access point
+     * @return Station count (0 if the AP is not running)
+     */
+    virtual uint8_t getAccessPointStations() = 0;
+
+    /**
+     * @brief Address of the device on its access point
+     * @return IP address as string (e.g., "192.168.4.1")
+     */
+    virtual String getAccessPointIP() = 0;
 };
 
 #endif // I_WIFI_ADAPTER_H
@@ -0,0 +1,528 @@
+#!/usr/bin/env python3
+"""
+Log Analytics for Poseidon2 WebSocket Log Captures
+
+Reads captures in one streaming pass and reports what the gateway logged,
+how often and how late:
+
+    rates        count, rate, level and suppressed repeats per component:event
+    histograms   inter-arrival times (gateway millis()) per event, in
+                 power-of-two buckets, for the whole capture or --histogram
+                 events
+    PGNs         NMEA 2000 frequency table: ignored PGNs (PGN_IGNORED, with
+                 their sources) next to the handled ones (PGNnnnnnn_* events);
+                 --markdown writes it in the layout of pgn_ignored_summary.md
+    latency      --record captures only: arrival time against the frames'
+                 timestamps (relative, as in ws_scale_test.py: the smallest
+                 arrival-minus-timestamp of a connection counts as zero),
+                 plus how long the gateway batched records into one frame
+
+Inputs (by extension, optionally gzipped):
+    .p2wl / .p2wl.gz        ws_logger.py --record (text and --binary frames)
+    anything else           JSON lines: ws_logger.py --json, ws_log_view.py --json,
+                            /logs/previous
+    directories             their .p2wl, .jsonl and .log files, in name order
+
+Nothing is kept per record: counters and histograms are updated as records
+stream past, so the memory use depends on the number of distinct events and
+frames, not on the file size.
+
+Usage:
+    python3 ws_log_stats.py <FILE_OR_DIR>... [OPTIONS]
+
+Options:
+    --top N               Rows in the rate table (default: 25, 0: all)
+    --histogram EVENT     Inter-arrival histogram of COMPONENT:EVENT (repeatable;
+                          default: the whole capture)
+    --markdown FILE       Write the PGN frequency table as Markdown
+    --json                Print the full report as one JSON object
+    --no-color            Disable colored output
+
+Examples:
+    # Rates, PGNs and latency of a recording
+    python3 ws_log_stats.py logs/
+
+    # How regular is the wind PGN, and what is ignored on this bus?
+    python3 ws_log_stats.py logs/ --histogram NMEA2000:PGN130306_UPDATE --markdown pgn_ignored_summary.md
+
+    # A --json capture
+    python3 ws_log_stats.py capture.jsonl.gz --json > report.json
+"""
+
+import argparse
+import gzip
+import json
+import os
+import re
+import sys
+from array import array
+from datetime import datetime
+
+from ws_logger import (Colors, KIND_BINARY, KIND_CONNECT, KIND_TEXT, colorize,
+                       decode_binary_frame, read_records)
+
+HIST_BUCKETS = 18           # 0 ms, then [2^(i-1), 2^i) ms; the last one is open-ended
+REBOOT_STEP_MS = 1000       # A timestamp this far back starts a new gateway uptime
+PGN_EVENT = re.compile(r'PGN(\d+)_')
+
+# Category and name of the PGNs seen on Poseidon2 buses (pgn_ignored_summary.md, CANboat)
+PGN_NAMES = {
+    59392: ('System Management', 'ISO Acknowledgement'),
+    59904: ('System Management', 'ISO Request'),
+    60928: ('System Management', 'ISO Address Claim'),
+    126208: ('System Management', 'NMEA Request/Command/Acknowledge Group Function'),
+    126464: ('System Management', 'PGN List'),
+    126992: ('System Management', 'System Time'),
+    126993: ('System Management', 'Heartbeat'),
+    126996: ('System Management', 'Product Information'),
+    126998: ('System Management', 'Configuration Information'),
+    127237: ('Navigation', 'Heading/Track Control'),
+    127245: ('Navigation', 'Rudder'),
+    127250: ('Navigation', 'Vessel Heading'),
+    127251: ('Navigation', 'Rate of Turn'),
+    127252: ('Navigation', 'Heave'),
+    127257: ('Navigation', 'Attitude'),
+    127258: ('Navigation', 'Magnetic Variation'),
+    127488: ('Engine', 'Engine Parameters, Rapid Update'),
+    127489: ('Engine', 'Engine Parameters, Dynamic'),
+    127505: ('Engine', 'Fluid Level'),
+    127508: ('Engine', 'Battery Status'),
+    128259: ('Navigation', 'Speed, Water Referenced'),
+    128267: ('Navigation', 'Water Depth'),
+    128275: ('Navigation', 'Distance Log'),
+    129025: ('Navigation', 'Position, Rapid Update'),
+    129026: ('Navigation', 'COG & SOG, Rapid Update'),
+    129029: ('Navigation', 'GNSS Position Data'),
+    129033: ('Navigation', 'Time & Date'),
+    129038: ('AIS', 'AIS Class A Position Report'),
+    129039: ('AIS', 'AIS Class B Position Report'),
+    129040: ('AIS', 'AIS Class B Extended Position Report'),
+    129041: ('AIS', 'AIS Aids to Navigation (AtoN) Report'),
+    129283: ('Navigation', 'Cross Track Error'),
+    129284: ('Navigation', 'Navigation Data'),
+    129285: ('Navigation', 'Navigation - Route/WP Information'),
+    129539: ('Navigation', 'GNSS DOPs'),
+    129540: ('Navigation', 'GNSS Sats in View'),
+    129793: ('AIS', 'AIS UTC and Date Report'),
+    129794: ('AIS', 'AIS Class A Static and Voyage Related Data'),
+    129809: ('AIS', "AIS Class B 'CS' Static Data Report, Part A"),
+    129810: ('AIS', "AIS Class B 'CS' Static Data Report, Part B"),
+    130306: ('Environmental', 'Wind Data'),
+    130310: ('Environmental', 'Environmental Parameters (obsolete)'),
+    130311: ('Environmental', 'Environmental Parameters (deprecated)'),
+    130312: ('Environmental', 'Temperature (deprecated)'),
+    130313: ('Environmental', 'Humidity'),
+    130314: ('Environmental', 'Actual Pressure'),
+    130316: ('Environmental', 'Temperature, Extended Range'),
+    130822: ('Proprietary Fast-Packet', 'Proprietary: Navico/B&G/Simrad/Lowrance'),
+    130824: ('Proprietary Fast-Packet', 'Proprietary: B&G/Maretron'),
+}
+
+def pgn_info(pgn):
+    """(category, name) of a PGN, with the proprietary ranges named generically"""
+    if pgn in PGN_NAMES:
+        return PGN_NAMES[pgn]
+    if pgn == 61184 or 65280 <= pgn <= 65535:
+        return ('Proprietary Single-Frame', 'Proprietary: Manufacturer Specific (Single Frame)')
+    if pgn == 126720 or 130816 <= pgn <= 131071:
+        return ('Proprietary Fast-Packet', 'Proprietary: Manufacturer Specific (Fast Packet)')
+    return ('Other', 'Unknown PGN')
+
+def bucket(ms):
+    return 0 if ms <= 0 else min(int(ms).bit_length(), HIST_BUCKETS - 1)
+
+def bucket_label(i):
+    if i == 0:
+        return '0 ms'
+    low = 1 << (i - 1)
+    if i == HIST_BUCKETS - 1:
+        return f">= {low / 1000.0:g} s"
+    return f"{low}-{(1 << i) - 1} ms" if low < 1000 else f"{low / 1000.0:g}-{((1 << i) - 1) / 1000.0:g} s"
+
+def histogram_percentile(counts, p):
+    """Upper edge (ms) of the bucket holding percentile @p p"""
+    total = sum(counts)
+    if total == 0:
+        return None
+    target = total * p / 100.0
+    seen = 0
+    for i, n in enumerate(counts):
+        seen += n
+        if seen >= target:
+            return 0 if i == 0 else (1 << i) - 1
+    return None
+
+def percentile(sorted_values, p):
+    if not sorted_values:
+        return None
+    return sorted_values[min(len(sorted_values) - 1, int(len(sorted_values) * p / 100.0))]
+
+class EventStats:
+    """Counters of one component:event"""
+    __slots__ = ('level', 'count', 'suppressed', 'prev', 'gaps', 'gap_sum', 'gap_n', 'gap_max')
+
+    def __init__(self, level):
+        self.level = level
+        self.count = 0
+        self.suppressed = 0
+        self.prev = None
+        self.gaps = [0] * HIST_BUCKETS
+        self.gap_sum = 0
+        self.gap_n = 0
+        self.gap_max = 0
+
+class Analyzer:
+    def __init__(self, histogram_keys):
+        self.events = {}            # "component:event" -> EventStats
+        self.histogram_keys = set(histogram_keys)
+        self.all_gaps = [0] * HIST_BUCKETS
+        self.prev_ts = None         # Previous record, any event
+        self.seg_first = None       # Uptime segments (a reboot restarts millis())
+        self.span_ms = 0
+        self.reboots = 0
+        self.records = 0
+        self.frames = 0
+        self.bad_lines = 0
+        self.pgns = {}              # pgn -> {'handled', 'count', 'sources'}
+        self.connections = []       # Per --record connection: array of arrival-minus-timestamp
+        self.offsets = None
+        self.batch = [0] * HIST_BUCKETS
+        self.received_first = None
+        self.received_last = None
+
+    # --- input --------------------------------------------------------------
+
+    def add_file(self, path):
+        if path.endswith(('.p2wl', '.p2wl.gz')):
+            self._add_recording(path)
+        else:
+            self._add_json_lines(path)
+
+    def _add_recording(self, path):
+        names = {}
+        for received, kind, payload in read_records(path):
+            if kind == KIND_CONNECT:
+                names = {}
+                self.offsets = array('d')
+                self.connections.append(self.offsets)
+                continue
+            if kind == KIND_BINARY:
+                records = decode_binary_frame(payload, names)
+            elif kind == KIND_TEXT:
+                records = self._parse_lines(payload.splitlines())
+            else:
+                continue
+            first = last = None
+            for log_data in records:
+                ts = log_data.get('timestamp')
+                self.add(log_data)
+                if isinstance(ts, (int, float)):
+                    first = ts if first is None else first
+                    last = ts
+            self.frames += 1
+            if first is None:
+                continue
+            if self.offsets is None:         # Recording without a connect marker (first file missing)
+                self.offsets = array('d')
+                self.connections.append(self.offsets)
+            self.offsets.append(received * 1000.0 - first)
+            self.batch[bucket(last - first)] += 1
+            self.received_first = received if self.received_first is None else self.received_first
+            self.received_last = received
+
+    def _add_json_lines(self, path):
+        opener = gzip.open if path.endswith('.gz') else open
+        with opener(path, 'rb') as f:
+            for log_data in self._parse_lines(f):
+                self.add(log_data)
+
+    def _parse_lines(self, lines):
+        loads = json.loads
+        for line in lines:
+            if len(line) < 2:
+                continue
+            try:
+                log_data = loads(line)
+            except ValueError:
+                self.bad_lines += 1
+                continue
+            if isinstance(log_data, dict) and 'event' in log_data:
+                yield log_data
+
+    # --- per record ---------------------------------------------------------
+
+    def add(self, log_data):
+        self.records += 1
+        ts = log_data.get('timestamp')
+        component = log_data.get('component', 'Unknown')
+        event = log_data.get('event', 'Unknown')
+        key = f"{component}:{event}"
+        stats = self.events.get(key)
+        if stats is None:
+            stats = self.events[key] = EventStats(log_data.get('level', 'UNKNOWN'))
+        stats.count += 1
+        data = log_data.get('data')
+
+        if isinstance(ts, (int, float)):
+            if self.prev_ts is not None and ts < self.prev_ts - REBOOT_STEP_MS:
+                self._new_segment()
+            if self.seg_first is None:
+                self.seg_first = ts
+            if self.prev_ts is not None and ts >= self.prev_ts:
+                self.all_gaps[bucket(ts - self.prev_ts)] += 1
+            self.prev_ts = ts
+            if stats.prev is not None and ts >= stats.prev:
+                gap = ts - stats.prev
+                stats.gaps[bucket(gap)] += 1
+                stats.gap_sum += gap
+                stats.gap_n += 1
+                if gap > stats.gap_max:
+                    stats.gap_max = gap
+            stats.prev = ts
+
+        if isinstance(data, dict):
+            if 'suppressed' in data:            # LogRateLimiter summary
+                stats.count -= 1
+                stats.suppressed += data.get('suppressed') or 0
+            elif event == 'PGN_IGNORED' and 'pgn' in data:
+                self._add_pgn(data['pgn'], False, data.get('src'))
+                return
+        match = PGN_EVENT.match(event)
+        if match:
+            self._add_pgn(int(match.group(1)), True, None)
+
+    def _add_pgn(self, pgn, handled, source):
+        entry = self.pgns.get(pgn)
+        if entry is None:
+            entry = self.pgns[pgn] = {'handled': handled, 'count': 0, 'sources': set()}
+        entry['count'] += 1
+        entry['handled'] = entry['handled'] or handled
+        if source is not None:
+            entry['sources'].add(source)
+
+    def _new_segment(self):
+        self.reboots += 1
+        self.span_ms += self.prev_ts - self.seg_first
+        self.seg_first = None
+        self.prev_ts = None
+        for stats in self.events.values():
+            stats.prev = None
+
+    # --- report -------------------------------------------------------------
+
+    def report(self, top):
+        span_ms = self.span_ms + ((self.prev_ts - self.seg_first) if self.seg_first is not None else 0)
+        span_s = span_ms / 1000.0
+        rate = (lambda n: n / span_s) if span_s > 0 else (lambda n: None)
+
+        events = []
+        for key, stats in sorted(self.events.items(), key=lambda item: -item[1].count):
+            events.append({
+                'event': key,
+                'level': stats.level,
+                'count': stats.count,
+                'rate_hz': rate(stats.count),
+                'suppressed': stats.suppressed,
+                'gap_mean_ms': stats.gap_sum / stats.gap_n if stats.gap_n else None,
+                'gap_p50_ms': min(histogram_percentile(stats.gaps, 50), stats.gap_max) if stats.gap_n else None,
+                'gap_p99_ms': min(histogram_percentile(stats.gaps, 99), stats.gap_max) if stats.gap_n else None,
+                'gap_max_ms': stats.gap_max if stats.gap_n else None,
+            })
+
+        histograms = {'all': self.all_gaps}
+        for key in sorted(self.histogram_keys):
+            if key in self.events:
+                histograms[key] = self.events[key].gaps
+
+        pgns = []
+        for pgn, entry in sorted(self.pgns.items()):
+            category, name = pgn_info(pgn)
+            pgns.append({
+                'pgn': pgn,
+                'category': category,
+                'name': name,
+                'handled': entry['handled'],
+                'count': entry['count'],
+                'rate_hz': rate(entry['count']),
+                'sources': sorted(entry['sources']),
+            })
+
+        connections = []
+        for offsets in self.connections:
+            if len(offsets) == 0:
+                continue
+            base = min(offsets)
+            lags = sorted(o - base for o in offsets)
+            connections.append({
+                'frames': len(lags),
+                'lag_p50_ms': percentile(lags, 50),
+                'lag_p99_ms': percentile(lags, 99),
+                'lag_max_ms': lags[-1],
+            })
+
+        return {
+            'records': self.records,
+            'frames': self.frames,
+            'bad_lines': self.bad_lines,
+            'span_s': span_s,
+            'reboots': self.reboots,
+            'received_from': self.received_first,
+            'received_to': self.received_last,
+            'events': events if top <= 0 else events[:top],
+            'event_count': len(events),
+            'histograms': {key: {'buckets': [bucket_label(i) for i in range(HIST_BUCKETS)], 'counts': counts}
+                           for key, counts in histograms.items()},
+            'pgns': pgns,
+            'latency': {'connections': connections, 'batch_span': self.batch if self.frames else None},
+        }
+
+def format_value(value, width, digits=1):
+    if value is None:
+        return f"{'-':>{width}}"
+    if isinstance(value, float):
+        return f"{value:>{width}.{digits}f}"
+    return f"{value:>{width}}"
+
+def print_histogram(title, counts, use_color):
+    total = sum(counts)
+    print(f"\n{colorize(title, Colors.BOLD, use_color)} ({total} intervals)")
+    if total == 0:
+        return
+    last = max(i for i, n in enumerate(counts) if n)
+    first = min(i for i, n in enumerate(counts) if n)
+    peak = max(counts)
+    for i in range(first, last + 1):
+        bar = '#' * (round(40 * counts[i] / peak) if counts[i] else 0)
+        print(f"  {bucket_label(i):>14} {counts[i]:>10} {100.0 * counts[i] / total:5.1f}%  {bar}")
+
+def print_report(report, use_color):
+    head = lambda text: colorize(text, Colors.BOLD, use_color)
+    summary = f"{report['records']} in {report['span_s']:.0f} s of gateway uptime"
+    if report['reboots']:
+        summary += f" ({report['reboots']} reboots)"
+    if report['frames']:
+        summary += f", {report['frames']} frames"
+    if report['bad_lines']:
+        summary += f", {report['bad_lines']} bad lines"
+    print(f"{head('Records:')} {summary}")
+    if report['received_from'] is not None:
+        print(f"{head('Received:')} {datetime.fromtimestamp(report['received_from']):%Y-%m-%d %H:%M:%S} to "
+              f"{datetime.fromtimestamp(report['received_to']):%Y-%m-%d %H:%M:%S}")
+
+    print(f"\n{head('Events')} ({len(report['events'])} of {report['event_count']})")
+    print(f"  {'component:event':<44} {'level':<5} {'count':>9} {'Hz':>8} {'supp':>7} "
+          f"{'gap avg':>8} {'p50':>6} {'p99':>6} {'max':>7}")
+    for e in report['events']:
+        print(f"  {e['event'][:44]:<44} {e['level'][:5]:<5} {e['count']:>9} {format_value(e['rate_hz'], 8, 2)} "
+              f"{e['suppressed'] or '':>7} {format_value(e['gap_mean_ms'], 8)} {format_value(e['gap_p50_ms'], 6)} "
+              f"{format_value(e['gap_p99_ms'], 6)} {format_value(e['gap_max_ms'], 7)}")
+
+    for key, histogram in report['histograms'].items():
+        print_histogram(f"Inter-arrival {'(all records)' if key == 'all' else key}", histogram['counts'], use_color)
+
+    if report['pgns']:
+        print(f"\n{head('NMEA 2000 PGNs')}")
+        print(f"  {'PGN':>6}  {'handled':<7} {'count':>9} {'Hz':>8}  {'sources':<16} name")
+        for p in sorted(report['pgns'], key=lambda p: -p['count']):
+            sources = ','.join(str(s) for s in p['sources'])
+            print(f"  {p['pgn']:>6}  {'yes' if p['handled'] else 'no':<7} {p['count']:>9} "
+                  f"{format_value(p['rate_hz'], 8, 2)}  {sources[:16]:<16} {p['name']}")
+
+    latency = report['latency']
+    if latency['connections']:
+        print(f"\n{head('Latency')} (arrival against timestamp, relative to the best frame of each connection)")
+        for i, c in enumerate(latency['connections'], 1):
+            print(f"  connection {i}: {c['frames']} frames, lag p50 {c['lag_p50_ms']:.0f} ms, "
+                  f"p99 {c['lag_p99_ms']:.0f} ms, max {c['lag_max_ms']:.0f} ms")
+        print_histogram('Batch span (first to last record of a frame)', latency['batch_span'], use_color)
+
+def write_markdown(path, report, sources):
+    """The PGN table in the layout of pgn_ignored_summary.md"""
+    ignored = [p for p in report['pgns'] if not p['handled']]
+    handled = [p for p in report['pgns'] if p['handled']]
+    lines = ['# Ignored NMEA2000 PGNs - Summary', '',
+             'This file lists all unique PGNs that are ignored by the current NMEA2000Handlers implementation.',
+             f"Total unique PGNs: {len(ignored)}", '']
+    categories = []
+    for p in ignored:
+        if p['category'] not in categories:
+            categories.append(p['category'])
+    for category in categories:
+        lines += [f"## {category} PGNs", '']
+        for p in sorted((p for p in ignored if p['category'] == category), key=lambda p: p['pgn']):
+            lines.append(f"**{p['pgn']}** - {p['name']}")
+            rate = f", {p['rate_hz']:.2f} Hz" if p['rate_hz'] is not None else ''
+            lines.append(f"- {p['count']} messages{rate}")
+            if p['sources']:
+                lines.append(f"- Sources: {', '.join(str(s) for s in p['sources'])}")
+            lines.append('')
+    if handled:
+        lines += ['## Handled PGNs (for comparison)', '', '| PGN | Name | Log records | Hz |', '|---|---|---|---|']
+        for p in sorted(handled, key=lambda p: p['pgn']):
+            rate = f"{p['rate_hz']:.2f}" if p['rate_hz'] is not None else '-'
+            lines.append(f"| {p['pgn']} | {p['name']} | {p['count']} | {rate} |")
+        lines.append('')
+    lines += ['---', '',
+              f"**Generated**: {datetime.now():%Y-%m-%d} by src/helpers/ws_log_stats.py",
+              f"**Source Log**: {', '.join(sources)} ({report['span_s']:.0f} seconds of gateway uptime)",
+              '**References**:',
+              '- NMEA2000 Library Documentation: https://ttlappalainen.github.io/NMEA2000/list_msg.html',
+              '- CANboat PGN Database: https://github.com/canboat/canboat', '']
+    with open(path, 'w') as f:
+        f.write('\n'.join(lines))
+
+def input_files(paths):
+    files = []
+    for path in paths:
+        if os.path.isdir(path):
+            names = sorted(n for n in os.listdir(path)
+                           if n.endswith(('.p2wl', '.p2wl.gz', '.jsonl', '.jsonl.gz', '.log', '.log.gz')))
+            files.extend(os.path.join(path, n) for n in names)
+        else:
+            files.append(path)
+    return files
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Log analytics for Poseidon2 WebSocket log captures',
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__
+    )
+    parser.add_argument('paths', nargs='+', help='Capture files or directories')
+    parser.add_argument('--top', type=int, default=25,
+                        help='Rows in the rate table (default: 25, 0: all)')
+    parser.add_argument('--histogram', action='append', default=[], metavar='EVENT',
+                        help='Inter-arrival histogram of COMPONENT:EVENT (repeatable)')
+    parser.add_argument('--markdown', type=str, default=None, metavar='FILE',
+                        help='Write the PGN frequency table as Markdown')
+    parser.add_argument('--json', action='store_true',
+                        help='Print the report as one JSON object')
+    parser.add_argument('--no-color', action='store_true',
+                        help='Disable colored output')
+    args = parser.parse_args()
+
+    use_color = not args.no_color and sys.stdout.isatty()
+    files = input_files(args.paths)
+    if not files:
+        print(f"{colorize('✗ No captures found', Colors.ERROR, use_color)}", file=sys.stderr)
+        return 1
+
+    analyzer = Analyzer(args.histogram)
+    try:
+        for path in files:
+            analyzer.add_file(path)
+    except (OSError, ValueError) as e:
+        print(f"{colorize('✗', Colors.ERROR, use_color)} {e}", file=sys.stderr)
+        return 1
+    report = analyzer.report(args.top)
+
+    if args.markdown:
+        write_markdown(args.markdown, report, files)
+    if args.json:
+        print(json.dumps(report, separators=(',', ':')))
+    else:
+        print_report(report, use_color)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,209 @@
+#!/usr/bin/env python3
+"""
+Offline Viewer for ws_logger.py Recordings
+
+Reads the files written by `ws_logger.py --record` (.p2wl, or .p2wl.gz with
+--compress), decodes the text and binary frames, and prints the log records
+through the same formatting as the live logger. Filters apply here, after
+the capture, so a recording made with a wide server filter can be searched
+in many ways.
+
+Usage:
+    python3 ws_log_view.py <FILE_OR_DIR>... [OPTIONS]
+
+Options:
+    --level LEVEL         Minimum level: DEBUG, INFO, WARN, ERROR, FATAL (default: DEBUG)
+    --components COMP     Only these components (comma-separated)
+    --events EVENTS       Only events starting with one of these prefixes (comma-separated)
+    --grep TEXT           Only records whose JSON line contains TEXT
+    --since TIME          Only frames received at or after TIME (ISO 8601, host clock)
+    --until TIME          Only frames received before TIME
+    --received            Prefix each record with the host receive time
+    --json                Output one JSON line per record
+    --stats               Print counts per level, component and event instead of records
+    --no-color            Disable colored output
+
+Examples:
+    # Everything in a recording directory, oldest file first
+    python3 ws_log_view.py logs/
+
+    # One PGN's records as JSON lines
+    python3 ws_log_view.py logs/ --events PGN130306_ --json > pgn130306.jsonl
+
+    # What was logged, and how often
+    python3 ws_log_view.py logs/ws-20261014-101500-042.p2wl.gz --stats
+
+Note:
+    - A directory is read in file name (= start time) order
+    - Binary frames refer to component and event names sent once per
+      connection; read the files of a session in order, starting with the first
+"""
+
+import argparse
+import json
+import os
+import sys
+from collections import Counter
+from datetime import datetime
+
+from ws_logger import (Colors, KIND_BINARY, KIND_CONNECT, KIND_TEXT, colorize,
+                       decode_binary_frame, format_log_message, get_log_level_priority,
+                       read_records)
+
+def recording_files(paths):
+    """Expand directories into their recordings, oldest first"""
+    files = []
+    for path in paths:
+        if os.path.isdir(path):
+            names = sorted(n for n in os.listdir(path) if n.endswith(('.p2wl', '.p2wl.gz')))
+            files.extend(os.path.join(path, n) for n in names)
+        else:
+            files.append(path)
+    return files
+
+def parse_time(text):
+    """ISO 8601 (local time unless it has an offset) to seconds since the epoch"""
+    if text is None:
+        return None
+    return datetime.fromisoformat(text).timestamp()
+
+def log_records(files):
+    """
+    Decode the recordings
+
+    Yields:
+        (received, log dict) per log record; status and subscription replies are skipped
+    """
+    names = {}
+    for path in files:
+        for received, kind, payload in read_records(path):
+            if kind == KIND_CONNECT:
+                names = {}
+            elif kind == KIND_BINARY:
+                for log_data in decode_binary_frame(payload, names):
+                    yield received, log_data
+            elif kind == KIND_TEXT:
+                for line in payload.decode('utf-8', errors='replace').splitlines():
+                    if not line.strip():
+                        continue
+                    try:
+                        log_data = json.loads(line)
+                    except json.JSONDecodeError:
+                        log_data = {'level': 'UNKNOWN', 'component': 'RAW', 'event': line}
+                    if 'status' in log_data and 'level' not in log_data:
+                        continue
+                    yield received, log_data
+
+def make_filter(args):
+    """Predicate over (received, log dict) from the command line filters"""
+    min_priority = get_log_level_priority(args.level)
+    components = set(c for c in args.components.split(',') if c) if args.components else None
+    events = tuple(e for e in args.events.split(',') if e) if args.events else None
+    since = parse_time(args.since)
+    until = parse_time(args.until)
+
+    def accept(received, log_data):
+        if since is not None and received < since:
+            return False
+        if until is not None and received >= until:
+            return False
+        if get_log_level_priority(log_data.get('level', 'UNKNOWN')) < min_priority:
+            return False
+        if components is not None and log_data.get('component') not in components:
+            return False
+        if events is not None and not str(log_data.get('event', '')).startswith(events):
+            return False
+        if args.grep and args.grep not in json.dumps(log_data, separators=(',', ':')):
+            return False
+        return True
+
+    return accept
+
+def print_stats(counts, first, last, use_color):
+    levels, components, events = counts
+    total = sum(levels.values())
+    span = (last - first) if first is not None else 0.0
+    print(f"{colorize('Records:', Colors.BOLD, use_color)} {total}", end='')
+    if first is not None:
+        print(f"  from {datetime.fromtimestamp(first):%Y-%m-%d %H:%M:%S} to "
+              f"{datetime.fromtimestamp(last):%H:%M:%S} ({span:.0f} s, {total / max(span, 1e-6):.1f}/s)")
+    else:
+        print()
+    for title, counter in (('Levels', levels), ('Components', components), ('Events', events)):
+        print(f"\n{colorize(title + ':', Colors.BOLD, use_color)}")
+        for name, count in counter.most_common(30 if title == 'Events' else None):
+            print(f"  {count:>9}  {name}")
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Offline viewer for ws_logger.py recordings',
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__
+    )
+    parser.add_argument('paths', nargs='+', help='Recording files or directories')
+    parser.add_argument('--level', type=str, default='DEBUG',
+                        choices=['DEBUG', 'INFO', 'WARN', 'ERROR', 'FATAL'],
+                        help='Minimum log level (default: DEBUG)')
+    parser.add_argument('--components', type=str, default=None,
+                        help='Only these components (comma-separated)')
+    parser.add_argument('--events', type=str, default=None,
+                        help='Only events with one of these prefixes (comma-separated)')
+    parser.add_argument('--grep', type=str, default=None,
+                        help='Only records whose JSON contains this text')
+    parser.add_argument('--since', type=str, default=None,
+                        help='Only frames received at or after this time (ISO 8601)')
+    parser.add_argument('--until', type=str, default=None,
+                        help='Only frames received before this time (ISO 8601)')
+    parser.add_argument('--received', action='store_true',
+                        help='Prefix records with the host receive time')
+    parser.add_argument('--json', action='store_true',
+                        help='Output one JSON line per record')
+    parser.add_argument('--stats', action='store_true',
+                        help='Print counts per level, component and event')
+    parser.add_argument('--no-color', action='store_true',
+                        help='Disable colored output')
+    args = parser.parse_args()
+
+    use_color = not args.no_color and sys.stdout.isatty()
+    files = recording_files(args.paths)
+    if not files:
+        print(f"{colorize('✗ No recordings found', Colors.ERROR, use_color)}", file=sys.stderr)
+        return 1
+
+    try:
+        accept = make_filter(args)
+    except ValueError as e:
+        print(f"{colorize('✗ Bad time:', Colors.ERROR, use_color)} {e}", file=sys.stderr)
+        return 1
+
+    counts = (Counter(), Counter(), Counter())
+    first = last = None
+    try:
+        for received, log_data in log_records(files):
+            if not accept(received, log_data):
+                continue
+            if args.stats:
+                counts[0][log_data.get('level', 'UNKNOWN')] += 1
+                counts[1][log_data.get('component', 'Unknown')] += 1
+                counts[2][log_data.get('event', 'Unknown')] += 1
+                first = received if first is None else first
+                last = received
+            elif args.json:
+                print(json.dumps(log_data, separators=(',', ':')))
+            else:
+                line = format_log_message(log_data, use_color)
+                if args.received:
+                    stamp = datetime.fromtimestamp(received).strftime('%H:%M:%S.%f')[:-3]
+                    line = f"{colorize(stamp, Colors.TIMESTAMP, use_color)} {line}"
+                print(line)
+        if args.stats:
+            print_stats(counts, first, last, use_color)
+    except ValueError as e:
+        print(f"{colorize('✗', Colors.ERROR, use_color)} {e}", file=sys.stderr)
+        return 1
+    except BrokenPipeError:  # | head
+        sys.stderr.close()
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())
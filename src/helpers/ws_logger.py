@@ -19,6 +19,13 @@ Options:
     --no-color            Disable colored output
     --reconnect           Auto-reconnect on disconnect (default: exit on disconnect)
     --no-server-filter    Skip setting server-side filter (use existing server filter)
+    --subscribe           Apply --level/--components/--events to this connection only
+                          (per-client filter; other clients keep the shared filter)
+    --record DIR          Raw ingest: write every frame unchanged to rotating files in DIR
+                          (no formatting; read them with ws_log_view.py)
+    --rotate-mb MB        Start a new --record file after MB megabytes (default: 64)
+    --compress            gzip the --record files (level 1)
+    --stats-interval S    Receive rate and lag report interval for --record (default: 5)
 
 Examples:
     # Connect and display current server filter (no changes)
@@ -39,22 +46,46 @@ Examples:
     # Reset to defaults (INFO level, all components/events)
     python3 ws_logger.py 192.168.0.94 --level INFO --components "" --events ""
 
+    # DEBUG for NMEA2000 on this terminal only (dashboards are not flooded)
+    python3 ws_logger.py 192.168.0.94 --subscribe --level DEBUG --components NMEA2000
+
+    # Same, with compact binary (MessagePack) frames
+    python3 ws_logger.py 192.168.0.94 --binary --level DEBUG --components NMEA2000
+
+    # Show what was logged just before the last reset (watchdog, brownout, ...)
+    python3 ws_logger.py 192.168.0.94 --previous
+
+    # Capture DEBUG PGN logging at full rate, then filter it offline
+    python3 ws_logger.py 192.168.0.94 --subscribe --binary --level DEBUG --events PGN --record logs/ --compress
+    python3 ws_log_view.py logs/ --events PGN130306_
+
 Note:
     - If no filter args provided, fetches and displays current server filter
     - Server filter persists across ESP32 reboots (saved to /log-filter.json)
     - Client-side --filter provides additional filtering on top of server filter
+    - Printing every message is slower than DEBUG-level PGN logging on a busy
+      bus; the TCP window then closes and the ESP32 queues. --record keeps
+      up because frames are only written (text and binary alike, unparsed)
 """
 
 import asyncio
-import websockets
 import json
 import sys
+import os
+import gzip
+import struct
+import time
 import argparse
 import signal
 import urllib.request
 import urllib.parse
 import urllib.error
 
+try:
+    import websockets
+except ImportError:  # ws_log_view.py reads recordings without it
+    websockets = None
+
 # ANSI color codes
 class Colors:
     RESET = '\033[0m'
@@ -176,6 +207,39 @@ def get_server_filter(host, port, use_color=True):
         print(f"{colorize('✗ Error fetching filter:', Colors.ERROR, use_color)} {e}\n")
         return None
 
+def print_previous_boot_log(host, port, args, use_color=True):
+    """
+    Fetch records that survived the last reset via HTTP GET to /logs/previous
+
+    Args:
+        host: ESP32 IP address
+        port: HTTP port
+        args: Parsed arguments (for --json)
+        use_color: Whether to use colored output
+
+    Returns:
+        0 on success, 1 on failure
+    """
+    url = f"http://{host}:{port}/logs/previous"
+
+    try:
+        with urllib.request.urlopen(url, timeout=5) as response:
+            for line in response.read().decode('utf-8').splitlines():
+                if not line:
+                    continue
+                if args.json:
+                    print(line)
+                else:
+                    print(format_log_message(json.loads(line), use_color))
+        return 0
+
+    except urllib.error.URLError as e:
+        print(f"{colorize('✗ Connection Error:', Colors.ERROR, use_color)} {e.reason}")
+        return 1
+    except Exception as e:
+        print(f"{colorize('✗ Error fetching previous boot log:', Colors.ERROR, use_color)} {e}")
+        return 1
+
 def set_server_filter(host, port, level=None, components=None, events=None, use_color=True):
     """
     Set server-side log filter via HTTP POST to /log-filter endpoint
@@ -242,6 +306,275 @@ def set_server_filter(host, port, level=None, components=None, events=None, use_
         print(f"{colorize('✗ Error setting filter:', Colors.ERROR, use_color)} {e}\n")
         return False
 
+LEVEL_NAMES = ['DEBUG', 'INFO', 'WARN', 'ERROR', 'FATAL']
+
+def _msgpack_read(buf, pos):
+    """
+    Decode one MessagePack value (subset sent by the logger)
+
+    Returns:
+        (value, next_position)
+    """
+    tag = buf[pos]
+    pos += 1
+    if tag < 0x80:                      # positive fixint
+        return tag, pos
+    if 0x90 <= tag <= 0x9f or tag == 0xdc:  # fixarray / array 16
+        if tag == 0xdc:
+            count = int.from_bytes(buf[pos:pos + 2], 'big')
+            pos += 2
+        else:
+            count = tag & 0x0f
+        items = []
+        for _ in range(count):
+            item, pos = _msgpack_read(buf, pos)
+            items.append(item)
+        return items, pos
+    if 0xa0 <= tag <= 0xbf or tag in (0xd9, 0xda, 0xdb):  # str
+        if tag <= 0xbf:
+            length = tag & 0x1f
+        else:
+            width = {0xd9: 1, 0xda: 2, 0xdb: 4}[tag]
+            length = int.from_bytes(buf[pos:pos + width], 'big')
+            pos += width
+        return buf[pos:pos + length].decode('utf-8', errors='replace'), pos + length
+    if tag in (0xcc, 0xcd, 0xce):       # uint 8/16/32
+        width = {0xcc: 1, 0xcd: 2, 0xce: 4}[tag]
+        return int.from_bytes(buf[pos:pos + width], 'big'), pos + width
+    if tag == 0xc0:
+        return None, pos
+    raise ValueError(f"unsupported MessagePack tag 0x{tag:02x}")
+
+def decode_binary_frame(frame, names):
+    """
+    Decode a binary /logs frame into log dicts (same shape as the JSON lines)
+
+    Args:
+        frame: bytes of one WebSocket frame (one or more MessagePack arrays)
+        names: dict of interned id -> name, updated from dictionary entries
+
+    Yields:
+        log dicts with timestamp/level/component/event/data
+    """
+    pos = 0
+    while pos < len(frame):
+        item, pos = _msgpack_read(frame, pos)
+        if item[0] == 0:                # [0, id, name]
+            names[item[1]] = item[2]
+            continue
+
+        _, timestamp, level, component, event, data = item
+        log_data = {
+            'timestamp': timestamp,
+            'level': LEVEL_NAMES[level] if level < len(LEVEL_NAMES) else 'UNKNOWN',
+            'component': names.get(component, f"#{component}") if isinstance(component, int) else component,
+            'event': names.get(event, f"#{event}") if isinstance(event, int) else event,
+        }
+        if data is not None:
+            try:
+                log_data['data'] = json.loads(data)
+            except json.JSONDecodeError:
+                log_data['data'] = data
+        yield log_data
+
+# --record files: RECORD_MAGIC, then per frame RECORD_HEADER and the frame's bytes
+RECORD_MAGIC = b'P2WL\x01'
+RECORD_HEADER = struct.Struct('<dBI')   # host receive time (s since epoch), kind, length
+KIND_TEXT = 0       # Text frame (newline-delimited JSON lines), UTF-8
+KIND_BINARY = 1     # Binary frame (MessagePack, --binary)
+KIND_CONNECT = 2    # New connection (payload: URI); interned names start over
+
+class FrameRecorder:
+    """
+    Append received frames unchanged to rotating files in a directory
+
+    Files are named ws-YYYYmmdd-HHMMSS-mmm.p2wl (.p2wl.gz with compress) and hold
+    about rotate_bytes of frames each. Writes are buffered (1 MB, or gzip
+    level 1) and nothing is parsed, so a frame costs about one copy.
+    """
+
+    def __init__(self, directory, rotate_bytes, compress):
+        self.directory = directory
+        self.rotate_bytes = rotate_bytes
+        self.compress = compress
+        self.handle = None
+        self.path = None
+        self.size = 0           # Uncompressed bytes in the current file
+        self.files = 0
+        os.makedirs(directory, exist_ok=True)
+
+    def write(self, kind, payload, received):
+        if self.handle is None or self.size >= self.rotate_bytes:
+            self._open()
+        self.handle.write(RECORD_HEADER.pack(received, kind, len(payload)))
+        self.handle.write(payload)
+        self.size += RECORD_HEADER.size + len(payload)
+
+    def close(self):
+        if self.handle is not None:
+            self.handle.close()
+            self.handle = None
+
+    def _open(self):
+        self.close()
+        now = time.time()
+        stem = time.strftime('ws-%Y%m%d-%H%M%S', time.localtime(now)) + f"-{int(now * 1000) % 1000:03d}"
+        suffix = '.p2wl.gz' if self.compress else '.p2wl'
+        path = os.path.join(self.directory, stem + suffix)
+        while os.path.exists(path):
+            stem += 'x'  # Same millisecond; still sorts after the existing file
+            path = os.path.join(self.directory, stem + suffix)
+        if self.compress:
+            self.handle = gzip.open(path, 'wb', compresslevel=1)
+        else:
+            self.handle = open(path, 'wb', buffering=1 << 20)
+        self.handle.write(RECORD_MAGIC)
+        self.path = path
+        self.size = len(RECORD_MAGIC)
+        self.files += 1
+
+def read_records(path):
+    """
+    Read a --record file
+
+    Yields:
+        (received, kind, payload) per frame; a frame cut short by a crash ends the file
+    """
+    opener = gzip.open if path.endswith('.gz') else open
+    with opener(path, 'rb') as f:
+        if f.read(len(RECORD_MAGIC)) != RECORD_MAGIC:
+            raise ValueError(f"{path}: not a ws_logger recording")
+        while True:
+            try:
+                header = f.read(RECORD_HEADER.size)
+            except EOFError:    # gzip stream without its trailer
+                return
+            if len(header) < RECORD_HEADER.size:
+                return
+            received, kind, length = RECORD_HEADER.unpack(header)
+            try:
+                payload = f.read(length)
+            except EOFError:
+                return
+            if len(payload) < length:
+                return
+            yield received, kind, payload
+
+def frame_timestamp(kind, payload):
+    """Gateway millis() of the first log record in a frame, or None"""
+    try:
+        if kind == KIND_TEXT:
+            for line in payload.splitlines():
+                if line.strip():
+                    return json.loads(line).get('timestamp')
+        elif kind == KIND_BINARY:
+            for log_data in decode_binary_frame(payload, {}):
+                return log_data['timestamp']
+    except (ValueError, IndexError, AttributeError):
+        pass
+    return None
+
+class IngestStats:
+    """
+    Receive rate and lag of a --record session
+
+    Lag is the newest frame's gateway timestamp against its arrival time. As
+    in ws_scale_test.py the clocks are not synchronized, so the smallest
+    arrival-minus-timestamp since the connection counts as zero: the lag is
+    how far the stream has fallen behind its best moment (ESP32 queueing,
+    TCP window, this host).
+    """
+
+    def __init__(self):
+        self.frames = 0
+        self.bytes = 0
+        self.base_offset_ms = None
+        self.last_report = time.monotonic()
+        self.report_frames = 0
+        self.report_bytes = 0
+
+    def connected(self):
+        self.base_offset_ms = None  # The gateway may have rebooted (millis() restarts)
+
+    def add(self, size):
+        self.frames += 1
+        self.bytes += size
+
+    def lag_ms(self, kind, payload, received):
+        device_ms = frame_timestamp(kind, payload)
+        if device_ms is None:
+            return None
+        offset = received * 1000.0 - device_ms
+        if self.base_offset_ms is None or offset < self.base_offset_ms:
+            self.base_offset_ms = offset
+        return offset - self.base_offset_ms
+
+    def report(self, lag_ms, recorder):
+        """One status line (stderr) with the rates since the previous one"""
+        now = time.monotonic()
+        elapsed = max(now - self.last_report, 1e-6)
+        rate = (self.frames - self.report_frames) / elapsed
+        kbps = (self.bytes - self.report_bytes) / elapsed / 1024.0
+        self.last_report, self.report_frames, self.report_bytes = now, self.frames, self.bytes
+        lag = f"{lag_ms:.0f} ms" if lag_ms is not None else "n/a"
+        print(f"[record] {rate:7.1f} frames/s {kbps:8.1f} KB/s  lag {lag:>8}  "
+              f"total {self.frames} frames {self.bytes / 1048576.0:.1f} MB  -> {recorder.path}",
+              file=sys.stderr, flush=True)
+
+def subscription_message(args):
+    """The per-client filter sent after connecting (--subscribe / --binary)"""
+    subscription = {
+        'level': args.level or 'INFO',
+        'components': args.components or '',
+        'events': args.events or ''
+    }
+    if args.binary:
+        subscription['encoding'] = 'msgpack'
+    return subscription
+
+async def record_frames(uri, args, recorder, stats, use_color):
+    """
+    Raw ingest: write every frame to the recorder without looking at it
+
+    A deep receive queue (max_queue) absorbs disk hiccups, so the TCP
+    window stays open while a file rotates.
+    """
+    try:
+        async with websockets.connect(
+            uri,
+            ping_interval=20,
+            ping_timeout=60,
+            close_timeout=10,
+            max_queue=4096,
+            max_size=None
+        ) as websocket:
+            print(f"{colorize('Recording', Colors.BOLD, use_color)} {uri} -> {args.record}", file=sys.stderr)
+            if args.subscribe or args.binary:
+                await websocket.send(json.dumps(subscription_message(args), separators=(',', ':')))
+            recorder.write(KIND_CONNECT, uri.encode('utf-8'), time.time())
+            stats.connected()
+
+            interval = args.stats_interval
+            next_report = time.monotonic() + interval
+            kind, payload, received = None, b'', 0.0
+            async for message in websocket:
+                received = time.time()
+                if isinstance(message, bytes):
+                    kind, payload = KIND_BINARY, message
+                else:
+                    kind, payload = KIND_TEXT, message.encode('utf-8')
+                recorder.write(kind, payload, received)
+                stats.add(len(payload))
+                if interval > 0 and time.monotonic() >= next_report:
+                    stats.report(stats.lag_ms(kind, payload, received), recorder)
+                    next_report += interval
+
+    except websockets.exceptions.ConnectionClosed:
+        print(f"\n{colorize('Connection closed by server', Colors.WARN, use_color)}", file=sys.stderr)
+
+    except Exception as e:
+        print(f"\n{colorize('Error:', Colors.ERROR, use_color)} {e}", file=sys.stderr)
+
 async def receive_logs(uri, args, use_color, min_priority):
     """Connect to WebSocket and receive log messages"""
     packets_received = 0
@@ -255,41 +588,70 @@ async def receive_logs(uri, args, use_color, min_priority):
             close_timeout=10   # Wait 10 seconds for close handshake
         ) as websocket:
             print(f"{colorize('Connected to', Colors.BOLD, use_color)} {uri}")
-            if args.level or args.components or args.events:
+            if args.subscribe or args.binary:
+                subscription = subscription_message(args)
+                await websocket.send(json.dumps(subscription, separators=(',', ':')))
+                print(f"{colorize('Per-client filter requested:', Colors.BOLD, use_color)} {subscription}")
+            elif args.level or args.components or args.events:
                 print(f"{colorize('Server filter active', Colors.BOLD, use_color)} (see configuration above)")
             print(f"{colorize('Client-side filter:', Colors.BOLD, use_color)} {args.filter}+ (additional filtering)")
             print(f"{colorize('Press Ctrl+C to exit', Colors.BOLD, use_color)}\n")
 
+            names = {}  # Interned component/event IDs (binary encoding)
+
             async for message in websocket:
                 packets_received += 1
 
-                try:
-                    # Parse JSON message
-                    log_data = json.loads(message.strip())
-
-                    # Handle connection status message
-                    if 'status' in log_data and log_data['status'] == 'connected':
-                        if not args.json:
-                            print(f"{colorize('WebSocket handshake complete', Colors.BOLD, use_color)}\n")
+                if isinstance(message, bytes):
+                    for log_data in decode_binary_frame(message, names):
+                        if get_log_level_priority(log_data['level']) < min_priority:
+                            continue
+                        if args.json:
+                            print(json.dumps(log_data, separators=(',', ':')), flush=True)
+                        else:
+                            print(format_log_message(log_data, use_color), flush=True)
+                    continue
+
+                # Batched frames carry several newline-delimited log lines
+                for line in message.splitlines():
+                    if not line.strip():
                         continue
 
-                    # Filter by log level
-                    log_level = log_data.get('level', 'UNKNOWN')
-                    log_priority = get_log_level_priority(log_level)
-
-                    if log_priority < min_priority:
-                        continue  # Skip logs below filter level
-
-                    # Output
-                    if args.json:
-                        print(message.strip(), flush=True)
-                    else:
-                        formatted = format_log_message(log_data, use_color)
-                        print(formatted, flush=True)
-
-                except json.JSONDecodeError:
-                    # Not valid JSON, print raw
-                    print(f"{colorize('RAW:', Colors.ERROR, use_color)} {message}", flush=True)
+                    try:
+                        # Parse JSON message
+                        log_data = json.loads(line.strip())
+
+                        # Handle connection status message
+                        if 'status' in log_data and log_data['status'] == 'connected':
+                            if not args.json:
+                                print(f"{colorize('WebSocket handshake complete', Colors.BOLD, use_color)}\n")
+                            continue
+
+                        # Handle subscription command replies
+                        if log_data.get('status') in ('subscribed', 'unsubscribed', 'error'):
+                            if not args.json:
+                                color = Colors.ERROR if log_data['status'] == 'error' else Colors.BOLD
+                                print(f"{colorize('Subscription ' + log_data['status'] + ':', color, use_color)} "
+                                      f"{log_data.get('filter', log_data.get('reason', ''))}\n")
+                            continue
+
+                        # Filter by log level
+                        log_level = log_data.get('level', 'UNKNOWN')
+                        log_priority = get_log_level_priority(log_level)
+
+                        if log_priority < min_priority:
+                            continue  # Skip logs below filter level
+
+                        # Output
+                        if args.json:
+                            print(line.strip(), flush=True)
+                        else:
+                            formatted = format_log_message(log_data, use_color)
+                            print(formatted, flush=True)
+
+                    except json.JSONDecodeError:
+                        # Not valid JSON, print raw
+                        print(f"{colorize('RAW:', Colors.ERROR, use_color)} {line}", flush=True)
 
     except websockets.exceptions.ConnectionClosed:
         print(f"\n{colorize('Connection closed by server', Colors.WARN, use_color)}")
@@ -307,8 +669,16 @@ async def main_async(args):
     use_color = not args.no_color and sys.stdout.isatty()
     min_priority = get_log_level_priority(args.filter)
 
-    # Handle server-side filter (unless --no-server-filter specified)
-    if not args.no_server_filter:
+    if args.previous:
+        return print_previous_boot_log(args.host, args.port, args, use_color=use_color)
+
+    if websockets is None:
+        print(f"{colorize('✗ The websockets library is missing', Colors.ERROR, use_color)} "
+              f"(see src/helpers/README.md)", file=sys.stderr)
+        return 1
+
+    # Handle server-side filter (unless --no-server-filter or --subscribe specified)
+    if not args.no_server_filter and not args.subscribe and not args.binary:
         # If --level, --components, or --events specified, set server filter
         if args.level is not None or args.components is not None or args.events is not None:
             success = set_server_filter(
@@ -328,6 +698,9 @@ async def main_async(args):
     # Build WebSocket URI
     uri = f"ws://{args.host}:{args.port}{args.path}"
 
+    if args.record:
+        return await record_async(uri, args, use_color)
+
     total_packets = 0
 
     while True:
@@ -358,6 +731,23 @@ async def main_async(args):
 
     return 0
 
+async def record_async(uri, args, use_color):
+    """--record: raw ingest with the same reconnect behaviour as the viewer"""
+    recorder = FrameRecorder(args.record, int(args.rotate_mb * 1048576), args.compress)
+    stats = IngestStats()
+    try:
+        while True:
+            await record_frames(uri, args, recorder, stats, use_color)
+            if not args.reconnect:
+                break
+            print(f"{colorize('Reconnecting in 5 seconds...', Colors.WARN, use_color)}", file=sys.stderr)
+            await asyncio.sleep(5)
+    finally:
+        recorder.close()
+        print(f"{colorize('Recorded', Colors.BOLD, use_color)} {stats.frames} frames, "
+              f"{stats.bytes / 1048576.0:.1f} MB in {recorder.files} file(s)", file=sys.stderr)
+    return 0
+
 def main():
     parser = argparse.ArgumentParser(
         description='WebSocket Logger Client for Poseidon2',
@@ -380,6 +770,10 @@ def main():
                         help='Set server-side event prefix filter (comma-separated)')
     parser.add_argument('--no-server-filter', action='store_true',
                         help='Skip setting server-side filter (use existing server filter)')
+    parser.add_argument('--subscribe', action='store_true',
+                        help='Send --level/--components/--events as a per-connection filter')
+    parser.add_argument('--binary', action='store_true',
+                        help='Subscribe with MessagePack encoding (implies --subscribe)')
 
     # Client-side filter (deprecated, for backward compatibility)
     parser.add_argument('--filter', type=str, default='DEBUG',
@@ -393,6 +787,18 @@ def main():
                         help='Disable colored output')
     parser.add_argument('--reconnect', action='store_true',
                         help='Auto-reconnect on disconnect')
+    parser.add_argument('--previous', action='store_true',
+                        help='Print records from before the last reset (/logs/previous) and exit')
+
+    # Raw ingest
+    parser.add_argument('--record', type=str, default=None, metavar='DIR',
+                        help='Write every frame unchanged to rotating files in DIR (no formatting)')
+    parser.add_argument('--rotate-mb', type=float, default=64.0,
+                        help='Start a new --record file after this many MB (default: 64)')
+    parser.add_argument('--compress', action='store_true',
+                        help='gzip the --record files')
+    parser.add_argument('--stats-interval', type=float, default=5.0,
+                        help='Seconds between receive rate/lag reports with --record (default: 5, 0: off)')
 
     args = parser.parse_args()
 
@@ -0,0 +1,470 @@
+#!/usr/bin/env python3
+"""
+WebSocket Client Scale Test for Poseidon2
+
+Opens many concurrent /boatdata and /logs connections, each with a read
+behavior, and measures what every client gets while the gateway's heap and
+loop metrics are polled. Answers "how many dashboards does this build
+sustain, and what does a slow or frozen one cost the others?"
+
+Read behaviors:
+    fast      Reads every frame as it arrives (a healthy dashboard)
+    slow      Sleeps --slow-delay ms after every frame (a weak phone)
+    stalled   Reads like fast for --stall-after s, then stops reading
+              (a sleeping tab); TCP backs up and pongs stop, so the
+              gateway's send queue fills and WsLiveness should evict it
+
+Per client:
+    frames, bytes and frames/s while connected; latency p50/p99/max;
+    disconnects (close code and reason) and refused connects.
+
+Latency is the frame's "timestamp" (gateway millis()) against the arrival
+time on this host. The clocks are not synchronized, so the figures are
+relative: the smallest arrival-minus-timestamp of the run counts as zero.
+Binary (--format bin) frames carry no timestamp and report no latency.
+
+Gateway metrics are polled every --poll s from GET /metrics (heap free,
+largest block, minimum, loop frequency, loop latency max) and GET /web/stats
+(server-side clients, msg/s, queued and deepest queue per endpoint). One
+sample is taken before any client connects, so the report shows the change
+under load.
+
+Usage:
+    python3 ws_scale_test.py <ESP32_IP> [OPTIONS]
+
+Options:
+    --port PORT           HTTP port (default: 80)
+    --boatdata SPEC       /boatdata clients: N (all fast) or "fast=N,slow=N,stalled=N" (default: 4)
+    --logs SPEC           /logs clients, same syntax (default: 1)
+    --format FORMAT       /boatdata format: full, delta or bin (default: full)
+    --duration S          Test length in seconds (default: 60)
+    --poll S              Gateway metrics interval in seconds (default: 5)
+    --ramp MS             Delay between two connects (default: 100)
+    --slow-delay MS       Read delay of slow clients per frame (default: 500)
+    --stall-after S       Seconds a stalled client reads before it stops (default: 5)
+    --reconnect           Reconnect a client 2 s after the gateway closed it
+    --csv FILE            Write the gateway samples as CSV
+    --json                Print the report as one JSON object
+    --no-color            Disable colored output
+
+Examples:
+    # Ten full-format dashboards and two log viewers for two minutes
+    python3 ws_scale_test.py 192.168.0.94 --boatdata 10 --logs 2 --duration 120
+
+    # What do two frozen tabs and a slow phone cost six healthy dashboards?
+    python3 ws_scale_test.py 192.168.0.94 --boatdata fast=6,slow=1,stalled=2
+
+    # Delta clients up to the limit, samples into a spreadsheet
+    python3 ws_scale_test.py 192.168.0.94 --boatdata 8 --format delta --csv run.csv
+
+Note:
+    - Connects beyond BOATDATA_STREAM_MAX_CLIENTS / LOGS_MAX_CLIENTS are refused
+      by admission (HTTP 503 or close 1011) and counted as refused
+    - /logs sends nothing below the server-side log level: raise it with
+      ws_logger.py --level DEBUG for a heavier /logs load
+"""
+
+import argparse
+import asyncio
+import csv
+import json
+import math
+import sys
+import time
+import urllib.error
+import urllib.request
+
+import websockets
+
+BEHAVIORS = ('fast', 'slow', 'stalled')
+
+METRICS = {
+    'poseidon2_heap_free_bytes': 'heap_free',
+    'poseidon2_heap_largest_free_block_bytes': 'heap_largest',
+    'poseidon2_heap_min_free_bytes': 'heap_min',
+    'poseidon2_loop_frequency_hz': 'loop_hz',
+    'poseidon2_loop_latency_max_us': 'loop_max_us',
+}
+
+SAMPLE_FIELDS = ['t_s', 'clients', 'frames_per_s', 'heap_free', 'heap_largest', 'heap_min',
+                 'loop_hz', 'loop_max_us', 'boatdata_clients', 'boatdata_queued',
+                 'boatdata_deepest', 'logs_clients', 'logs_queued', 'logs_deepest']
+
+# ANSI color codes
+class Colors:
+    RESET = '\033[0m'
+    BOLD = '\033[1m'
+    WARN = '\033[33m'       # Yellow
+    ERROR = '\033[31m'      # Red
+
+def colorize(text, color, use_color=True):
+    """Apply color to text if color is enabled"""
+    if not use_color:
+        return text
+    return f"{color}{text}{Colors.RESET}"
+
+def parse_spec(text):
+    """
+    Parse a client spec: "N" (all fast) or "fast=N,slow=N,stalled=N"
+
+    Returns:
+        list of behaviors, one per client, interleaved (fast, slow, stalled, fast, ...)
+    """
+    counts = {}
+    if text.strip().isdigit():
+        counts['fast'] = int(text)
+    else:
+        for part in text.split(','):
+            name, _, count = part.strip().partition('=')
+            if name not in BEHAVIORS or not count.isdigit():
+                raise argparse.ArgumentTypeError(f"bad client spec '{part}' (use N or fast=N,slow=N,stalled=N)")
+            counts[name] = counts.get(name, 0) + int(count)
+
+    behaviors = []
+    while any(counts.values()):
+        for name in BEHAVIORS:
+            if counts.get(name, 0) > 0:
+                behaviors.append(name)
+                counts[name] -= 1
+    return behaviors
+
+def percentile(values, pct):
+    """Nearest-rank percentile of an unsorted list (None when empty)"""
+    if not values:
+        return None
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, max(0, math.ceil(pct / 100.0 * len(ordered)) - 1))
+    return ordered[index]
+
+class ClientStats:
+    """Counters of one test client"""
+
+    def __init__(self, name, endpoint, behavior):
+        self.name = name
+        self.endpoint = endpoint
+        self.behavior = behavior
+        self.frames = 0
+        self.bytes = 0
+        self.connected_s = 0.0
+        self.connected_since = None
+        self.connects = 0
+        self.refused = 0
+        self.disconnects = []       # (monotonic time, close code, reason)
+        self.offsets_ms = []        # arrival minus gateway timestamp
+
+    @property
+    def connected(self):
+        return self.connected_since is not None
+
+    def opened(self):
+        self.connects += 1
+        self.connected_since = time.monotonic()
+
+    def closed(self):
+        if self.connected_since is not None:
+            self.connected_s += time.monotonic() - self.connected_since
+            self.connected_since = None
+
+    def frame(self, message):
+        """Count one frame and the gateway timestamps it carries"""
+        self.frames += 1
+        self.bytes += len(message)
+        if isinstance(message, bytes):
+            return
+        arrival_ms = time.time() * 1000.0
+        for line in message.splitlines():
+            if '"timestamp"' not in line:
+                continue
+            try:
+                device_ms = json.loads(line).get('timestamp')
+            except json.JSONDecodeError:
+                continue
+            if isinstance(device_ms, (int, float)):
+                self.offsets_ms.append(arrival_ms - device_ms)
+
+    def report(self, base_offset_ms):
+        connected_s = self.connected_s
+        if self.connected_since is not None:
+            connected_s += time.monotonic() - self.connected_since
+        latencies = [offset - base_offset_ms for offset in self.offsets_ms]
+        return {
+            'name': self.name,
+            'endpoint': self.endpoint,
+            'behavior': self.behavior,
+            'frames': self.frames,
+            'bytes': self.bytes,
+            'frames_per_s': round(self.frames / connected_s, 2) if connected_s > 0 else 0.0,
+            'connected_s': round(connected_s, 1),
+            'latency_p50_ms': percentile(latencies, 50),
+            'latency_p99_ms': percentile(latencies, 99),
+            'latency_max_ms': max(latencies) if latencies else None,
+            'connects': self.connects,
+            'refused': self.refused,
+            'disconnects': len(self.disconnects),
+            'last_close': self.disconnects[-1][1:] if self.disconnects else None,
+        }
+
+async def run_client(uri, stats, args, stop_at):
+    """Connect and read with the client's behavior until stop_at (monotonic)"""
+    while time.monotonic() < stop_at:
+        try:
+            # Stalled clients buffer one frame, so not reading pauses the TCP stream
+            async with websockets.connect(
+                uri,
+                ping_interval=None,     # The gateway pings; its pings test liveness
+                close_timeout=2,
+                max_queue=1 if stats.behavior == 'stalled' else 32,
+            ) as websocket:
+                stats.opened()
+                opened_at = time.monotonic()
+                while True:
+                    remaining = stop_at - time.monotonic()
+                    if remaining <= 0:
+                        break
+                    if stats.behavior == 'stalled' and time.monotonic() - opened_at >= args.stall_after:
+                        # Keep the socket open without reading; the gateway decides its fate
+                        await asyncio.sleep(min(remaining, 1.0))
+                        if websocket.close_code is not None:
+                            raise websockets.exceptions.ConnectionClosed(
+                                websockets.frames.Close(websocket.close_code, websocket.close_reason or ''), None)
+                        continue
+                    try:
+                        message = await asyncio.wait_for(websocket.recv(), timeout=min(remaining, 1.0))
+                    except asyncio.TimeoutError:
+                        continue
+                    stats.frame(message)
+                    if stats.behavior == 'slow':
+                        await asyncio.sleep(args.slow_delay / 1000.0)
+                stats.closed()
+                return
+        except websockets.exceptions.ConnectionClosed as e:
+            stats.closed()
+            code = e.rcvd.code if e.rcvd is not None else None
+            reason = e.rcvd.reason if e.rcvd is not None else ''
+            if stats.frames == 0 and code == 1011:
+                stats.refused += 1      # Admitted together with others, closed at the limit
+            stats.disconnects.append((time.monotonic(), code, reason))
+        except (websockets.exceptions.InvalidHandshake, OSError):
+            stats.closed()
+            stats.refused += 1
+        if not args.reconnect:
+            return
+        await asyncio.sleep(2)
+
+def fetch(url, timeout=5):
+    """GET url, returning the body text or None"""
+    try:
+        with urllib.request.urlopen(url, timeout=timeout) as response:
+            return response.read().decode('utf-8', errors='replace')
+    except (urllib.error.URLError, OSError):
+        return None
+
+def sample_gateway(host, port):
+    """One reading of /metrics and /web/stats (missing values are None)"""
+    sample = {field: None for field in SAMPLE_FIELDS}
+    text = fetch(f"http://{host}:{port}/metrics")
+    if text:
+        for line in text.splitlines():
+            if line.startswith('#'):
+                continue
+            name, _, value = line.partition(' ')
+            if name in METRICS:
+                try:
+                    sample[METRICS[name]] = float(value)
+                except ValueError:
+                    pass
+
+    text = fetch(f"http://{host}:{port}/web/stats")
+    if text:
+        try:
+            sockets = json.loads(text).get('websockets', {})
+        except json.JSONDecodeError:
+            sockets = {}
+        for endpoint in ('boatdata', 'logs'):
+            socket = sockets.get(endpoint, {})
+            sample[f"{endpoint}_clients"] = socket.get('clients')
+            sample[f"{endpoint}_queued"] = socket.get('queued')
+            sample[f"{endpoint}_deepest"] = socket.get('deepest')
+    return sample
+
+def format_value(value, width):
+    if value is None:
+        return '-'.rjust(width)
+    if isinstance(value, float) and not value.is_integer():
+        return f"{value:.1f}".rjust(width)
+    return str(int(value)).rjust(width)
+
+def print_sample(sample, use_color):
+    row = (f"{sample['t_s']:>6.0f}s  clients {format_value(sample['clients'], 3)}  "
+           f"rx {format_value(sample['frames_per_s'], 6)}/s  "
+           f"heap {format_value(sample['heap_free'], 7)} (largest {format_value(sample['heap_largest'], 7)})  "
+           f"loop {format_value(sample['loop_hz'], 5)} Hz (max {format_value(sample['loop_max_us'], 6)} us)  "
+           f"queued bd {format_value(sample['boatdata_queued'], 3)}/{format_value(sample['boatdata_deepest'], 2)} "
+           f"logs {format_value(sample['logs_queued'], 3)}/{format_value(sample['logs_deepest'], 2)}")
+    low_loop = sample['loop_hz'] is not None and sample['loop_hz'] < 100
+    print(colorize(row, Colors.WARN, use_color) if low_loop else row, flush=True)
+
+async def poll_gateway(args, clients, samples, start, stop_at, use_color):
+    """Sample the gateway every --poll seconds with this run's delivered rate"""
+    last_frames = sum(c.frames for c in clients)
+    last_time = time.monotonic()
+    while time.monotonic() < stop_at:
+        await asyncio.sleep(min(args.poll, max(0.0, stop_at - time.monotonic())))
+        sample = await asyncio.to_thread(sample_gateway, args.host, args.port)
+        now = time.monotonic()
+        frames = sum(c.frames for c in clients)
+        sample['t_s'] = now - start
+        sample['clients'] = sum(1 for c in clients if c.connected)
+        sample['frames_per_s'] = round((frames - last_frames) / (now - last_time), 1) if now > last_time else 0.0
+        last_frames, last_time = frames, now
+        samples.append(sample)
+        if not args.json:
+            print_sample(sample, use_color)
+
+def summarize(baseline, samples):
+    """Gateway figures under load next to the idle baseline"""
+    def values(field):
+        return [s[field] for s in samples if s[field] is not None]
+
+    summary = {'baseline': {k: baseline[k] for k in ('heap_free', 'heap_largest', 'loop_hz', 'loop_max_us')}}
+    for field, pick in (('heap_free', min), ('heap_largest', min), ('heap_min', min),
+                        ('loop_hz', min), ('loop_max_us', max),
+                        ('boatdata_deepest', max), ('logs_deepest', max)):
+        found = values(field)
+        summary[f"{field}_{pick.__name__}"] = pick(found) if found else None
+    return summary
+
+def print_report(report, use_color):
+    print(f"\n{colorize('Clients', Colors.BOLD, use_color)}")
+    print(f"  {'name':<12} {'behavior':<8} {'frames':>7} {'fps':>6} {'KiB':>7} "
+          f"{'p50 ms':>7} {'p99 ms':>7} {'max ms':>7} {'conn':>4} {'refused':>7} {'closed':>6}  last close")
+    for c in report['clients']:
+        closed = c['disconnects']
+        line = (f"  {c['name']:<12} {c['behavior']:<8} {c['frames']:>7} {c['frames_per_s']:>6.1f} "
+                f"{c['bytes'] / 1024.0:>7.1f} {format_value(c['latency_p50_ms'], 7)} "
+                f"{format_value(c['latency_p99_ms'], 7)} {format_value(c['latency_max_ms'], 7)} "
+                f"{c['connects']:>4} {c['refused']:>7} {closed:>6}  "
+                f"{'' if c['last_close'] is None else c['last_close']}")
+        color = Colors.ERROR if c['refused'] else Colors.WARN if closed else None
+        print(colorize(line, color, use_color) if color else line)
+
+    g = report['gateway']
+    base = g['baseline']
+    print(f"\n{colorize('Gateway', Colors.BOLD, use_color)} (idle baseline -> worst under load)")
+    print(f"  heap free     {format_value(base['heap_free'], 8)} -> {format_value(g['heap_free_min'], 8)}"
+          f"  (lowest ever {format_value(g['heap_min_min'], 8)})")
+    print(f"  largest block {format_value(base['heap_largest'], 8)} -> {format_value(g['heap_largest_min'], 8)}")
+    print(f"  loop Hz       {format_value(base['loop_hz'], 8)} -> {format_value(g['loop_hz_min'], 8)}")
+    print(f"  loop max us   {format_value(base['loop_max_us'], 8)} -> {format_value(g['loop_max_us_max'], 8)}")
+    print(f"  deepest queue boatdata {format_value(g['boatdata_deepest_max'], 3)}, "
+          f"logs {format_value(g['logs_deepest_max'], 3)}")
+
+async def main_async(args):
+    use_color = not args.no_color and sys.stdout.isatty()
+    query = {'full': '', 'delta': '?mode=delta', 'bin': '?fmt=bin'}[args.format]
+
+    clients = []
+    for index, behavior in enumerate(args.boatdata):
+        clients.append((f"ws://{args.host}:{args.port}/boatdata{query}",
+                        ClientStats(f"boatdata-{index + 1}", 'boatdata', behavior)))
+    for index, behavior in enumerate(args.logs):
+        clients.append((f"ws://{args.host}:{args.port}/logs",
+                        ClientStats(f"logs-{index + 1}", 'logs', behavior)))
+    if not clients:
+        print(colorize('No clients requested', Colors.ERROR, use_color), file=sys.stderr)
+        return 1
+
+    baseline = await asyncio.to_thread(sample_gateway, args.host, args.port)
+    if baseline['heap_free'] is None and baseline['boatdata_clients'] is None:
+        print(f"{colorize('✗ Gateway not reachable:', Colors.ERROR, use_color)} "
+              f"http://{args.host}:{args.port}/metrics", file=sys.stderr)
+        return 1
+    baseline['t_s'] = 0.0
+    baseline['clients'] = 0
+    baseline['frames_per_s'] = 0.0
+
+    if not args.json:
+        counts = {b: sum(1 for _, c in clients if c.behavior == b) for b in BEHAVIORS}
+        print(f"{colorize('Scale test', Colors.BOLD, use_color)} {args.host}:{args.port}  "
+              f"{len(args.boatdata)} x /boatdata ({args.format}), {len(args.logs)} x /logs  "
+              f"fast {counts['fast']}, slow {counts['slow']}, stalled {counts['stalled']}  "
+              f"{args.duration} s")
+        print_sample(baseline, use_color)
+
+    start = time.monotonic()
+    stop_at = start + args.duration
+    stats = [c for _, c in clients]
+    samples = []
+    tasks = [asyncio.create_task(poll_gateway(args, stats, samples, start, stop_at, use_color))]
+    for uri, client in clients:
+        tasks.append(asyncio.create_task(run_client(uri, client, args, stop_at)))
+        await asyncio.sleep(args.ramp / 1000.0)
+    await asyncio.gather(*tasks)
+
+    offsets = [o for c in stats for o in c.offsets_ms]
+    base_offset = min(offsets) if offsets else 0.0
+    report = {
+        'host': args.host,
+        'format': args.format,
+        'duration_s': args.duration,
+        'clients': [c.report(base_offset) for c in stats],
+        'gateway': summarize(baseline, samples),
+        'samples': [baseline] + samples,
+    }
+
+    if args.csv:
+        with open(args.csv, 'w', newline='') as f:
+            writer = csv.DictWriter(f, fieldnames=SAMPLE_FIELDS)
+            writer.writeheader()
+            writer.writerows(report['samples'])
+
+    if args.json:
+        print(json.dumps(report, separators=(',', ':')))
+    else:
+        print_report(report, use_color)
+    return 0
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='WebSocket Client Scale Test for Poseidon2',
+        formatter_class=argparse.RawDescriptionHelpFormatter,
+        epilog=__doc__
+    )
+    parser.add_argument('host', help='ESP32 IP address (e.g., 192.168.0.94)')
+    parser.add_argument('--port', type=int, default=80,
+                        help='HTTP port (default: 80)')
+    parser.add_argument('--boatdata', type=parse_spec, default=parse_spec('4'),
+                        help='/boatdata clients: N or fast=N,slow=N,stalled=N (default: 4)')
+    parser.add_argument('--logs', type=parse_spec, default=parse_spec('1'),
+                        help='/logs clients, same syntax (default: 1)')
+    parser.add_argument('--format', default='full', choices=['full', 'delta', 'bin'],
+                        help='/boatdata format (default: full)')
+    parser.add_argument('--duration', type=int, default=60,
+                        help='Test length in seconds (default: 60)')
+    parser.add_argument('--poll', type=float, default=5.0,
+                        help='Gateway metrics interval in seconds (default: 5)')
+    parser.add_argument('--ramp', type=int, default=100,
+                        help='Delay between two connects in ms (default: 100)')
+    parser.add_argument('--slow-delay', type=int, default=500,
+                        help='Read delay of slow clients per frame in ms (default: 500)')
+    parser.add_argument('--stall-after', type=float, default=5.0,
+                        help='Seconds a stalled client reads before it stops (default: 5)')
+    parser.add_argument('--reconnect', action='store_true',
+                        help='Reconnect a client 2 s after the gateway closed it')
+    parser.add_argument('--csv', type=str, default=None,
+                        help='Write the gateway samples to this CSV file')
+    parser.add_argument('--json', action='store_true',
+                        help='Print the report as one JSON object')
+    parser.add_argument('--no-color', action='store_true',
+                        help='Disable colored output')
+
+    args = parser.parse_args()
+
+    try:
+        sys.exit(asyncio.run(main_async(args)))
+    except KeyboardInterrupt:
+        print("\nInterrupted")
+        sys.exit(130)
+
+if __name__ == '__main__':
+    main()
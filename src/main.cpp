@@ -17,15 +17,31 @@
 #include <Arduino.h>
 #include <ReactESP.h>
 #include <WiFi.h>
+#include <esp_timer.h>
+#include <sys/time.h>
 
 // HAL implementations
 #include "hal/implementations/ESP32WiFiAdapter.h"
 #include "hal/implementations/LittleFSAdapter.h"
+#include "hal/implementations/ESP32NvsConfigStore.h"
+#include "hal/implementations/ESP32FirmwareUpdater.h"
+#if POSEIDON_FEATURE_DISPLAY
 #include "hal/implementations/ESP32DisplayAdapter.h"
+#endif
+#include "hal/implementations/ESP32N2kCanDriver.h"
+#if ACTISENSE_FORWARD_ENABLED
+#include "hal/implementations/ESP32ActisenseForwardPort.h"
+#endif
 #include "hal/implementations/ESP32SystemMetrics.h"
+#if POSEIDON_FEATURE_ONEWIRE
 #include "hal/implementations/ESP32OneWireSensors.h"
 #include "hal/interfaces/IOneWireSensors.h"
+#endif
+#if POSEIDON_FEATURE_NMEA0183
 #include "hal/implementations/ESP32SerialPort.h"
+#include "hal/implementations/ESP32UartEventPort.h"
+#include "hal/implementations/ESP32NetworkSentencePort.h"
+#endif
 
 // Components
 #include "components/WiFiManager.h"
@@ -37,18 +53,130 @@
 #include "components/SourcePrioritizer.h"
 #include "components/CalibrationManager.h"
 #include "components/CalibrationWebServer.h"
+#include "components/N2kStatsWebServer.h"
+#if POSEIDON_FEATURE_NMEA0183
+#include "components/NMEA0183StatsWebServer.h"
+#endif
+#if POSEIDON_FEATURE_DISPLAY
 #include "components/DisplayManager.h"
+#endif
 #include "components/NMEA2000Handlers.h"
+#include "components/N2kReceiveTask.h"
+#include "components/N2kTransmitScheduler.h"
+#include "components/NMEA2000Transmitters.h"
+#include "components/NMEA0183TcpGateway.h"
+#include "components/BoatDataUdpPublisher.h"
+#include "components/MdnsAdvertiser.h"
+#include "components/WiFiProfileManager.h"
+#include "components/WebStatsWebServer.h"
+#include "components/MetricsWebServer.h"
+#include "components/ChunkedJsonResponder.h"
+#include "components/StaticAssetServer.h"
+#if POSEIDON_FEATURE_NMEA0183
 #include "components/NMEA0183Handler.h"
+#include "components/NMEA0183RouteConfig.h"
+#endif
+#include "components/PolarConfig.h"
+#include "utils/DataTables.h"
+#include "utils/VariationGrid.h"
+#include "hal/implementations/ESP32DataPartition.h"
+#include "components/NavigationEngine.h"
+#include "components/NavigationWebServer.h"
+#if AIS_ENABLED
+#include "components/AisWebServer.h"
+#include "utils/AisTargetTable.h"
+#endif
+#include "components/CalculationTimingWebServer.h"
+#if CALIB_LEARN_ENABLED
+#include "utils/CalibrationLearner.h"
+#endif
+#include "components/SourcesWebServer.h"
+#include "components/BoatDataApiWebServer.h"
+#if CALC_BENCHMARK_ENABLED
+#include "components/CalculationBenchmarkWebServer.h"
+#endif
+#if POSEIDON_FEATURE_ONEWIRE
 #include "components/OneWireSensorPoller.h"
+#include "components/OneWireSensorTask.h"
+#endif
+#if IMU_ENABLED
+#include "hal/implementations/ESP32I2cDevice.h"
+#include "components/ImuAttitudeSource.h"
+#endif
 #include "components/BoatDataSerializer.h"
+#include "components/BoatDataStreamStatsWebServer.h"
+#if REACTION_PROFILER_ENABLED
+#include "components/ReactionProfilerWebServer.h"
+#endif
+#if TRACE_ENABLED
+#include "components/TraceWebServer.h"
+#endif
+#include "components/TaskMonitor.h"
+#include "components/MemoryWebServer.h"
+#include "utils/BoatDataStreamClients.h"
+#include "utils/BoatDataRateGovernor.h"
+#include "utils/BoatDataReplay.h"
+#include "utils/IoPump.h"
+#include "utils/ReactionScheduler.h"
+#include "utils/StallWatchdog.h"
+#include "utils/BootTimeline.h"
+#include "utils/FixedString.h"
+#include "utils/WsBufferPool.h"
+#include "utils/BufferPlacement.h"
+#include "utils/ScratchJson.h"
+#include "utils/WriteBehind.h"
+#include "utils/OutputPipeline.h"
+#include "utils/WiFiApFallback.h"
+#include "utils/WebTrafficStats.h"
+#include "utils/MetricRegistry.h"
+#include "utils/ConfigService.h"
+#include "utils/AdmissionController.h"
+#include "utils/WsLiveness.h"
+#include "utils/StaticInstance.h"
+#include "utils/MemoryBudget.h"
+#include "utils/TraceRecorder.h"
+#include "utils/AllocTracker.h"
+#include "utils/BoatDataSchema.h"
+#include "components/BusCapture.h"
+#include "components/BusReplay.h"
+#include "components/BusCaptureWebServer.h"
+#include "utils/PipelineLatency.h"
+#include "components/N2kLoadGenerator.h"
+#include "components/N2kLoadWebServer.h"
+#include "components/HistoryRecorder.h"
+#include "components/HistoryWebServer.h"
+#include "components/VoyageRecorder.h"
+#include "components/VoyageRecorderWebServer.h"
+#include "components/TripCountersWebServer.h"
+#if ENGINE_JOURNAL_ENABLED
+#include "components/EngineJournalStore.h"
+#include "components/EngineJournalWebServer.h"
+#endif
+#if ALARM_ENABLED
+#include "components/AlarmRuleConfig.h"
+#include "components/AlarmWebServer.h"
+#include "utils/AlarmEngine.h"
+#endif
+#if SOAK_ENABLED
+#include "components/SoakRecorder.h"
+#include "components/SoakWebServer.h"
+#endif
+#include "components/OtaWebServer.h"
+#include "utils/OtaUpdate.h"
+#include "utils/TripCounters.h"
+#include "utils/N2kAddressMemory.h"
+#include "utils/UtcClock.h"
+#include "utils/AutopilotForward.h"
+#include "utils/TelemetryRegistry.h"
+#include "components/TelemetrySystemMetrics.h"
 
 // Utilities
 #include "utils/WebSocketLogger.h"
 #include "utils/TimeoutManager.h"
 
+#include <ArduinoJson.h>
+
 // NMEA libraries
-#include <NMEA0183.h>
 #include <NMEA2000.h>
 #include <NMEA2000_esp32.h>
 
@@ -63,9 +191,95 @@ using namespace reactesp;
 // Global ReactESP application
 ReactESP app;
 
-// HAL instances (hardware adapters) - initialized in setup() to avoid global constructor issues
+uint32_t readCycleCount() {
+    return ESP.getCycleCount();  // CCOUNT (xthal_get_ccount())
+}
+
+uint32_t readMicros() {
+    return micros();
+}
+
+#if REACTION_PROFILER_ENABLED
+// Per-reaction execution time and lateness (GET /reactions, OLED debug page)
+ReactionProfiler reactionProfiler(readCycleCount);
+ReactionProfilerWebServer reactionProfilerWebServer(&reactionProfiler);
+#endif
+
+#if TRACE_ENABLED
+// Begin/end events of the instrumented code paths (GET /trace, Perfetto)
+TraceRecorder traceRecorder(readCycleCount);
+TraceWebServer traceWebServer(&traceRecorder);
+#endif
+
+#if SCHED_ENABLED
+// Priority classes and per-class budgets for the repeating reactions (loop() runs a pass after app.tick())
+ReactionScheduler reactionScheduler(readMicros);
+#endif
+
+#if STALL_WATCHDOG_ENABLED
+// Software watchdog over the reactions and I/O tasks (GET /watchdog, stall record in RTC memory)
+StallWatchdog stallWatchdog(StallWatchdog::rtcStorage());
+int8_t loopStallSlot = -1;
+esp_timer_handle_t stallTimer = nullptr;
+#endif
+
+/**
+ * @brief app.onRepeat() in priority class @p cls, timed per invocation under @p name
+ *
+ * With SCHED_ENABLED the reaction is run by reactionScheduler (highest class
+ * first, per-class budgets); without it, or once the scheduler table is
+ * full, it is a plain app.onRepeat(). Without REACTION_PROFILER_ENABLED, or
+ * once the profiler table is full, it is not timed. With
+ * STALL_WATCHDOG_ENABLED every run is watched in the main-loop slot. The
+ * loop scratch arena is reset after every run.
+ */
+static void onRepeatProfiled(const char* name, uint32_t intervalMs, std::function<void()> callback,
+                             ReactionClass cls) {
+    // Scratch allocations of a reaction never outlive it
+    std::function<void()> reaction = [callback]() {
+        callback();
+        GetLoopArena().reset();
+    };
+#if REACTION_PROFILER_ENABLED
+    int8_t id = reactionProfiler.add(name, intervalMs);
+    if (id >= 0) {
+        reaction = [id, callback]() {
+            uint32_t start = reactionProfiler.begin(id, millis());
+            callback();
+            reactionProfiler.end(id, start);
+        };
+    }
+#endif
+#if ALLOC_TRACK_ENABLED
+    std::function<void()> counted = reaction;
+    reaction = [name, counted]() {
+        AllocScope scope(name);  // Allocations per reaction, including its handlers' scopes
+        counted();
+    };
+#endif
+#if STALL_WATCHDOG_ENABLED
+    std::function<void()> timed = reaction;
+    reaction = [name, timed]() {
+        stallWatchdog.enter(static_cast<uint8_t>(loopStallSlot), name, millis());
+        timed();
+        stallWatchdog.exit(static_cast<uint8_t>(loopStallSlot));
+    };
+#endif
+#if SCHED_ENABLED
+    if (reactionScheduler.add(cls, name, intervalMs, reaction, millis()) >= 0) {
+        return;
+    }
+#else
+    (void)name;
+    (void)cls;
+#endif
+    app.onRepeat(intervalMs, reaction);
+}
+
+// HAL instances (hardware adapters) - constructed in setup() (into *Storage below) to avoid global constructor issues
 ESP32WiFiAdapter* wifiAdapter = nullptr;
 LittleFSAdapter* fileSystem = nullptr;
+ESP32NvsConfigStore* configStore = nullptr;
 
 // Core components
 WebSocketLogger logger;
@@ -73,36 +287,527 @@ TimeoutManager timeoutManager;
 WiFiManager* wifiManager = nullptr;
 ConfigWebServer* webServer = nullptr;
 
+#if OTA_ENABLED
+// Streaming firmware/filesystem updates (POST /update)
+ESP32FirmwareUpdater firmwareUpdater;
+OtaWebServer otaWebServer(&firmwareUpdater, &logger);
+#endif
+
 // WiFi state
 WiFiConfigFile wifiConfig;
 WiFiConnectionState connectionState;
+WiFiApFallback wifiApFallback;  // Own access point while no configured network is reachable
 
 // BoatData components (T038)
 SourcePrioritizer* sourcePrioritizer = nullptr;
 BoatData* boatData = nullptr;
+SourcesWebServer* sourcesWebServer = nullptr;  // GET /sources, POST /sources/override
+BoatDataApiWebServer* boatDataApiWebServer = nullptr;  // GET /api/boatdata
 CalculationEngine* calculationEngine = nullptr;
+PolarTable polarTable;  // Boat polar (tables partition or /polar.pol), ~3 KB
+ESP32DataPartition dataPartition;  // "tables" partition, mapped read-only for the device's lifetime
+DataTables dataTables;             // Its verified directory
+VariationGrid variationGrid;       // Grid variation while no source sends one
+NavigationEngine navigationEngine;  // Opposite-tack heading and waypoint laylines
+NavigationWebServer* navigationWebServer = nullptr;
+#if CALIB_LEARN_ENABLED
+CalibrationLearner calibrationLearner;  // Wind offset / leeway K from tacks (main loop writer)
+uint32_t lastLearnedApplyMs = 0;        // CALIB_LEARN_AUTO_APPLY rate limit
+#endif
+#if AIS_ENABLED
+AisTargetTable aisTargets;  // AIS vessels and their CPA/TCPA (main loop writer), ~19 KB
+AisWebServer aisWebServer(&aisTargets);  // GET /ais/risks, GET /ais/targets
+#endif
+#if CALC_BENCHMARK_ENABLED
+CalculationBenchmarkWebServer* calcBenchmarkWebServer = nullptr;
+#endif
+int calculationSubscription = -1;  // BoatData subscription driving calculateDerivedParameters()
+int navigationSubscription = -1;   // BoatData subscription driving updateNavigation()
+CalculationTiming calculationTiming;  // Cycle period, jitter, duration, deadline misses (GET /calc/stats)
+CalculationTimingWebServer* calcTimingWebServer = nullptr;
 CalibrationManager* calibrationManager = nullptr;
 CalibrationWebServer* calibrationWebServer = nullptr;
+N2kStatsWebServer* n2kStatsWebServer = nullptr;
+#if POSEIDON_FEATURE_NMEA0183
+NMEA0183StatsWebServer* nmea0183StatsWebServer = nullptr;
+#endif
+
+ESP32SystemMetrics* systemMetrics = nullptr;
 
+#if POSEIDON_FEATURE_DISPLAY
 // Display components (T027)
 ESP32DisplayAdapter* displayAdapter = nullptr;
-ESP32SystemMetrics* systemMetrics = nullptr;
 DisplayManager* displayManager = nullptr;
+DisplayPager displayPager(DISPLAY_PAGE_ROTATE_MS, REACTION_PROFILER_ENABLED && REACTION_PROFILER_OLED_PAGE);
+#if ALARM_ENABLED
+bool alarmScreenShown = false;  // "oled_alarm" owns the screen while an alarm is active
+#endif
+#endif
 
+#if IMU_ENABLED
+// Onboard IMU on the OLED I2C bus (heel/pitch as the "IMU" attitude source)
+ESP32I2cDevice imuDevice(Wire, IMU_I2C_ADDRESS);
+Icm20948 imu(&imuDevice);
+ImuAttitudeSource* imuSource = nullptr;
+#endif
+
+#if POSEIDON_FEATURE_ONEWIRE
 // 1-Wire sensor components (T036)
 ESP32OneWireSensors* oneWireSensors = nullptr;
 OneWireSensorPoller* oneWirePoller = nullptr;
+int8_t oneWireMapEntry = -1;  // Write-behind entry of the device map (-1 = no NVS store)
+#if ONEWIRE_TASK_ENABLED
+OneWireSensorTask oneWireTask;  // Bus reads off the main loop (TASK_LAYOUT 1)
+#endif
+#endif
 
+#if POSEIDON_FEATURE_NMEA0183
 // NMEA0183 components (T036)
-tNMEA0183* nmea0183 = nullptr;
 ISerialPort* serial0183 = nullptr;
+ISerialPort* serial0183Port2 = nullptr;  // Optional second input (NMEA0183_PORT2_ENABLED)
+ISerialPort* net0183Port = nullptr;      // Optional network input (NMEA0183_NET_ENABLED)
 NMEA0183Handler* nmea0183Handler = nullptr;
+#endif
 
 // NMEA2000 components (T027)
-tNMEA2000* nmea2000 = nullptr;
+ESP32N2kCanDriver* nmea2000 = nullptr;
+N2kReceiveTask n2kReceiveTask;
+N2kTransmitScheduler n2kTransmitScheduler;
+#if ACTISENSE_FORWARD_ENABLED
+ESP32ActisenseForwardPort actisenseForward(Serial, ACTISENSE_FORWARD_TX_BUFFER);  // Console port, binary N2K
+#endif
+
+// NMEA0183 TCP stream on port 10110 (converted BoatData for chartplotter apps)
+NMEA0183TcpGateway nmea0183TcpGateway;
+BoatDataUdpPublisher boatDataUdpPublisher;  // Multicast BoatDataDatagram (any number of listeners)
+
+// Periodic BoatData outputs (UDP, replay ring, voyage log): one shared snapshot per dispatch batch
+OutputPipeline outputPipeline([]() -> uint32_t { return micros(); });
+int8_t udpOutputSink = -1;  // Re-rated by the Wi-Fi profile
+MdnsAdvertiser mdnsAdvertiser;              // poseidon2.local and the DNS-SD services
+
+// Wi-Fi power/latency profile: power save, TX power and stream rates (/wifi/profile)
+WiFiProfileManager wifiProfileManager;
+int8_t wifiProfileEntry = -1;  // Write-behind entry of the selection (-1 = no NVS store)
+
+// GET /web/stats: HTTP route timing and WebSocket rates (filled by measureRequest() and the senders)
+WebStatsWebServer webStatsWebServer(&GetWebTrafficStats());
+
+// Counters, gauges and histograms behind /metrics, /stats, the OLED status page and the soak CSV
+// (sources added by registerTelemetrySources(), aggregated by the "telemetry" reaction)
+TelemetryRegistry telemetry;
+TelemetrySystemMetrics telemetrySystemMetrics(&telemetry, millis);
+
+// GET /metrics: every counter and gauge in the Prometheus text format (families added by registerMetrics())
+// GET /stats: the telemetry snapshot as JSON
+MetricRegistry metricRegistry;
+MetricsWebServer metricsWebServer(&metricRegistry, &telemetry);
+
+// Dashboard files: gzip, ETag/304, small ones resident in RAM
+StaticAssetServer staticAssetServer;
+
+// Raw bus capture to LittleFS and replay into the handlers
+BusCapture busCapture;
+BusReplay busReplay;
+BusCaptureWebServer* busCaptureWebServer = nullptr;
+PipelineLatency pipelineLatency;  // BoatData write to WebSocket latency, armed while a replay runs
+
+// Synthetic NMEA 2000 traffic into the CAN receive queue (/n2k/load)
+N2kLoadGenerator n2kLoadGenerator;
+N2kLoadWebServer* n2kLoadWebServer = nullptr;
+
+// Downsampled history of selected BoatData fields (/history)
+HistoryRecorder historyRecorder;
+HistoryWebServer* historyWebServer = nullptr;
+
+// Black-box voyage recorder: delta-compressed snapshots in rotating LittleFS segments (/voyage)
+VoyageRecorder voyageRecorder;
+VoyageRecorderWebServer* voyageRecorderWebServer = nullptr;
+
+// Engine hours, distance log and energy counters, committed to NVS within a daily write budget (/counters)
+TripCounters tripCounters;
+TripCountersWebServer* tripCountersWebServer = nullptr;
+int8_t tripCountersEntry = -1;  // Write-behind entry (-1 = no NVS store)
+
+// Source address claimed last boot: the next claim starts there (NVS)
+N2kAddressMemory n2kAddressMemory;
+int8_t n2kAddressEntry = -1;    // Write-behind entry (-1 = no NVS store)
+
+#if ENGINE_JOURNAL_ENABLED
+// Engine and saildrive transitions as 16-byte records in a LittleFS ring file (/journal/engine)
+EngineJournalStore engineJournal;
+EngineJournalWebServer engineJournalWebServer(&engineJournal);
+int8_t engineJournalEntry = -1;     // Write-behind entry writing the queued records
+int engineJournalSubscription = -1; // BoatData subscription feeding the journal
+#endif
+
+#if ALARM_ENABLED
+// Anchor watch and threshold alarms, evaluated on input changes (/alarms, PGN 126983)
+AlarmEngine alarmEngine;
+AlarmWebServer alarmWebServer(&alarmEngine);
+int alarmSubscription = -1;  // BoatData subscription driving the alarm engine
+#endif
+
+#if SOAK_ENABLED
+// Soak runs: one metric row per minute to LittleFS, monotonic trends flagged (/soak)
+SoakRecorder soakRecorder;
+SoakWebServer* soakWebServer = nullptr;
+uint32_t soakLastSampleMs = 0;
+#endif
+
+// Storage of the objects setup() constructs (placement, no heap; see StaticInstance.h)
+StaticInstance<ESP32WiFiAdapter> wifiAdapterStorage;
+StaticInstance<LittleFSAdapter> fileSystemStorage;
+StaticInstance<ESP32NvsConfigStore> configStoreStorage;
+StaticInstance<WiFiManager> wifiManagerStorage;
+StaticInstance<ConfigWebServer> webServerStorage;
+StaticInstance<SourcePrioritizer> sourcePrioritizerStorage;
+StaticInstance<BoatData> boatDataStorage;
+StaticInstance<SourcesWebServer> sourcesWebServerStorage;
+StaticInstance<BoatDataApiWebServer> boatDataApiWebServerStorage;
+StaticInstance<CalculationEngine> calculationEngineStorage;
+StaticInstance<NavigationWebServer> navigationWebServerStorage;
+#if CALC_BENCHMARK_ENABLED
+StaticInstance<CalculationBenchmarkWebServer> calcBenchmarkWebServerStorage;
+#endif
+StaticInstance<CalculationTimingWebServer> calcTimingWebServerStorage;
+StaticInstance<CalibrationManager> calibrationManagerStorage;
+StaticInstance<CalibrationWebServer> calibrationWebServerStorage;
+StaticInstance<N2kStatsWebServer> n2kStatsWebServerStorage;
+StaticInstance<ESP32SystemMetrics> systemMetricsStorage;
+#if POSEIDON_FEATURE_DISPLAY
+StaticInstance<ESP32DisplayAdapter> displayAdapterStorage;
+StaticInstance<DisplayManager> displayManagerStorage;
+#endif
+#if POSEIDON_FEATURE_ONEWIRE
+StaticInstance<ESP32OneWireSensors> oneWireSensorsStorage;
+StaticInstance<OneWireSensorPoller> oneWirePollerStorage;
+#endif
+#if IMU_ENABLED
+StaticInstance<ImuAttitudeSource> imuSourceStorage;
+#endif
+#if POSEIDON_FEATURE_NMEA0183
+StaticInstance<NMEA0183StatsWebServer> nmea0183StatsWebServerStorage;
+#if NMEA0183_UART_EVENT_MODE
+StaticInstance<ESP32UartEventPort> serial0183Storage;
+#if NMEA0183_PORT2_ENABLED
+StaticInstance<ESP32UartEventPort> serial0183Port2Storage;
+#endif
+#else
+StaticInstance<ESP32SerialPort> serial0183Storage;
+#if NMEA0183_PORT2_ENABLED
+StaticInstance<ESP32SerialPort> serial0183Port2Storage;
+#endif
+#endif
+#if NMEA0183_NET_ENABLED
+StaticInstance<ESP32NetworkSentencePort> net0183PortStorage;
+#endif
+StaticInstance<NMEA0183Handler> nmea0183HandlerStorage;
+#endif
+StaticInstance<ESP32N2kCanDriver> nmea2000Storage;
+#if BUS_CAPTURE_ENABLED
+StaticInstance<BusCaptureWebServer> busCaptureWebServerStorage;
+#endif
+#if N2K_LOAD_ENABLED
+StaticInstance<N2kLoadWebServer> n2kLoadWebServerStorage;
+#endif
+#if HISTORY_ENABLED
+StaticInstance<HistoryWebServer> historyWebServerStorage;
+#endif
+#if VOYAGE_LOG_ENABLED
+StaticInstance<VoyageRecorderWebServer> voyageRecorderWebServerStorage;
+#endif
+#if TRIP_COUNTERS_ENABLED
+StaticInstance<TripCountersWebServer> tripCountersWebServerStorage;
+#endif
+#if SOAK_ENABLED
+StaticInstance<SoakWebServer> soakWebServerStorage;
+#endif
+StaticInstance<MemoryWebServer> memoryWebServerStorage;
+
+// Stack high-water marks of the firmware's tasks (TASK_STACKS)
+TaskMonitor taskMonitor;
+
+// Reservations per component (GET /memory), listed at the end of setup()
+MemoryBudget memoryBudget;
+MemoryWebServer* memoryWebServer = nullptr;
+
+// Every bus input drained by one budgeted reaction (io_pump)
+IoPump ioPump(readMicros);
 
 // WebUI components (Feature 011-simple-webui-as)
 AsyncWebSocket wsBoatData("/boatdata");
+BoatDataStreamClients boatDataStreamClients;  // Format, subscription and schedule of each client
+BoatDataDeltaEncoder boatDataDelta;           // Shared keyframe/delta baseline (broadcast loop only)
+#if BOATDATA_REPLAY_ENABLED
+BoatDataReplay boatDataReplay;                // Last 60 s of snapshots for clients that reconnect (?since=)
+#endif
+#if BOATDATA_GOVERNOR_ENABLED
+BoatDataRateGovernor boatDataRateGovernor;    // Default rate and keyframe interval under load
+BoatDataStreamStatsWebServer boatDataStreamStatsWebServer(&boatDataStreamClients, &wsBoatData,
+                                                          &boatDataRateGovernor);  // GET /boatdata/stats
+#else
+BoatDataStreamStatsWebServer boatDataStreamStatsWebServer(&boatDataStreamClients, &wsBoatData);  // GET /boatdata/stats
+#endif
+AsyncWebSocket wsSignalK("/signalk/v1/stream");  // Signal K delta stream (shares boatDataDelta)
+bool signalKClientJoined = false;                // Set on async_tcp, taken by the broadcast loop
+bool signalKResync = false;                      // A Signal K client skipped a delta (broadcast loop only)
+#if AIS_ENABLED
+AsyncWebSocket wsAis("/ais");                    // Collision-risk list at AIS_EVALUATE_INTERVAL_MS
+static char aisScratch[AIS_WS_JSON_SIZE];        // Risk list JSON before the pool copy (main loop only)
+#endif
+
+// JSON is encoded here first, then copied into a WsBufferPool buffer of its actual size (broadcast loop only)
+static char boatDataScratch[BoatDataSerializer::SIGNALK_BUFFER_SIZE];
+static_assert(BoatDataSerializer::JSON_BUFFER_SIZE <= sizeof(boatDataScratch), "boatDataScratch holds /boatdata JSON too");
+
+// Delta baseline values, placed in PSRAM when available (broadcast loop only; nullptr = no delta streams)
+static BoatDataStructure* deltaSnapshot = nullptr;
+
+/**
+ * @brief A pool buffer holding @p length bytes of @p data, nullptr if the pool is exhausted
+ */
+static AsyncWebSocketSharedBuffer pooledFrame(const void* data, size_t length) {
+    AsyncWebSocketSharedBuffer frame = GetWsBufferPool().acquire(length);
+    if (frame) {
+        memcpy(frame->data(), data, length);
+    }
+    return frame;
+}
+
+/**
+ * @brief ISO 8601 UTC time for Signal K updates, nullptr until the clock is set
+ */
+static const char* signalKTimestamp(char* buffer, size_t size) {
+    uint64_t utcMs = GetUtcClock().toUtc(millis());
+    if (utcMs != 0) {
+        return UtcClock::formatIso(utcMs, buffer, size) ? buffer : nullptr;
+    }
+    time_t now = time(nullptr);
+    struct tm utc;
+    if (now < 1577836800 || gmtime_r(&now, &utc) == nullptr) {  // Before 2020: never synchronised
+        return nullptr;
+    }
+    strftime(buffer, size, "%Y-%m-%dT%H:%M:%SZ", &utc);
+    return buffer;
+}
+
+/**
+ * @brief Apply a /boatdata subscription message and answer with its status
+ *
+ * {"subscribe":["compass","wind"],"rate":10} selects groups (JSON keys,
+ * default all) and a rate in Hz (default 1, at most 1000 / BOATDATA_STREAM_TICK_MS);
+ * {"unsubscribe":true} restores every group at the default rate.
+ */
+static void handleBoatDataCommand(AsyncWebSocketClient* client, const uint8_t* data, size_t len) {
+    ScratchScope scratch(GetHttpArena());  // WebSocket events also run on async_tcp
+    ScratchJsonDocument doc(384, ScratchJsonAllocator(&scratch.arena()));
+    DeserializationError error = deserializeJson(doc, data, len);
+    if (error || !doc.is<JsonObject>()) {
+        client->text("{\"status\":\"error\",\"reason\":\"invalid JSON command\"}");
+        return;
+    }
+
+    uint16_t groups = BoatDataGroup::ALL;
+    uint8_t ticks = 0;  // Follow the default (governed) rate
+    if (!(doc["unsubscribe"] | false)) {
+        JsonArray requested = doc["subscribe"].as<JsonArray>();
+        if (!requested.isNull()) {
+            groups = 0;
+            for (JsonVariant key : requested) {
+                uint8_t group = BoatDataSchema::findGroup(key.as<const char*>());
+                if (group == BOATDATA_SCHEMA_GROUP_COUNT) {
+                    client->text("{\"status\":\"error\",\"reason\":\"unknown group\"}");
+                    return;
+                }
+                groups = static_cast<uint16_t>(groups | BoatDataSchema::groupInfo(group).mask);
+            }
+        }
+        if (!doc["rate"].isNull()) {
+            ticks = BoatDataStreamClients::ticksForRate(doc["rate"].as<double>());
+            if (ticks == 0) {
+                client->text("{\"status\":\"error\",\"reason\":\"invalid rate\"}");
+                return;
+            }
+        }
+    }
+
+    if (!boatDataStreamClients.subscribe(client->id(), groups, ticks)) {
+        client->text("{\"status\":\"error\",\"reason\":\"no groups, or a delta stream\"}");
+        return;
+    }
+
+    unsigned intervalMs = (unsigned)(ticks != 0 ? ticks : boatDataStreamClients.getDefaultTicks()) *
+                          BOATDATA_STREAM_TICK_MS;
+    char reply[80];
+    snprintf(reply, sizeof(reply), "{\"status\":\"subscribed\",\"groups\":%u,\"intervalMs\":%u}",
+             (unsigned)groups, intervalMs);
+    client->text(reply);
+    logger.broadcastLogf(LogLevel::INFO, LogComponent::BOATDATA_STREAM, LogEvent::SUBSCRIBED,
+        "{\"clientId\":%u,\"groups\":%u,\"intervalMs\":%u}", (unsigned)client->id(),
+        (unsigned)groups, intervalMs);
+}
+
+/**
+ * @brief /boatdata client in @p slot if it can take another frame, else nullptr
+ *
+ * A client that still has BOATDATA_STREAM_MAX_QUEUED frames queued skips
+ * this one (counted per client); one that stays behind for
+ * BOATDATA_STREAM_EVICT_MS is closed before its queue eats the heap.
+ */
+static AsyncWebSocketClient* boatDataReadyClient(uint8_t slot, unsigned long now) {
+    AsyncWebSocketClient* client = wsBoatData.client(boatDataStreamClients.at(slot));
+    if (client == nullptr || client->status() != WS_CONNECTED) {
+        return nullptr;
+    }
+    if (client->queueLen() < BOATDATA_STREAM_MAX_QUEUED) {
+        return client;
+    }
+    if (boatDataStreamClients.recordDropped(slot, now)) {
+        BoatDataStreamClientStats stats;
+        boatDataStreamClients.getStats(slot, stats, now);
+        logger.broadcastLogf(LogLevel::WARN, LogComponent::BOATDATA_STREAM, LogEvent::CLIENT_EVICTED,
+            "{\"clientId\":%u,\"dropped\":%lu,\"behindMs\":%lu}", (unsigned)client->id(),
+            (unsigned long)stats.dropped, (unsigned long)stats.behindMs);
+        client->close(1008, "Too slow - frames dropped");
+    }
+    return nullptr;
+}
+
+#if BOATDATA_REPLAY_ENABLED
+/**
+ * @brief Send the pending ?since= replays, one binary burst per client (broadcast loop)
+ *
+ * Runs after buckets() and before the live frames of the tick, so a
+ * reconnected client gets the snapshots it missed ahead of its first live
+ * frame. The burst is one pooled buffer; with the pool exhausted the
+ * replay is dropped and the client just streams on.
+ */
+static void sendBoatDataReplays() {
+    uint32_t id;
+    uint32_t since;
+    while (boatDataReplay.takeRequest(id, since)) {
+        AsyncWebSocketClient* client = wsBoatData.client(id);
+        uint8_t records = boatDataReplay.countSince(since);
+        if (client == nullptr || client->status() != WS_CONNECTED || records == 0) {
+            continue;
+        }
+        size_t bytes = records * sizeof(BoatDataDatagram);
+        AsyncWebSocketSharedBuffer frame = GetWsBufferPool().acquire(bytes);
+        if (!frame) {
+            continue;  // Counted by the pool
+        }
+        boatDataReplay.copySince(since, frame->data(), bytes);
+        client->binary(frame);
+        boatDataReplay.recordSent(records);
+        GetWebTrafficStats().wsSent(AdmissionEndpoint::BOATDATA, bytes);
+        LOG_DEBUGF(&logger, LogComponent::BOATDATA_STREAM, LogEvent::BROADCAST,
+            "{\"clientId\":%u,\"replay\":%u,\"since\":%lu}", (unsigned)id, (unsigned)records,
+            (unsigned long)since);
+    }
+}
+#endif
+
+#if PIPELINE_LATENCY_ENABLED
+static_assert(static_cast<uint8_t>(PipelineOutput::DELTA) == static_cast<uint8_t>(BoatDataStreamMode::DELTA) &&
+              static_cast<uint8_t>(PipelineOutput::BINARY) == static_cast<uint8_t>(BoatDataStreamMode::BINARY),
+              "PipelineOutput lists the /boatdata modes in BoatDataStreamMode order");
+
+/**
+ * @brief Tell the latency probe which outputs have clients (broadcast loop, every tick)
+ */
+static void updatePipelineOutputs() {
+    uint8_t outputs = wsSignalK.count() > 0 ? 1u << static_cast<uint8_t>(PipelineOutput::SIGNALK) : 0;
+    for (uint8_t m = 0; m <= static_cast<uint8_t>(BoatDataStreamMode::BINARY); m++) {
+        if (boatDataStreamClients.count(static_cast<BoatDataStreamMode>(m)) > 0) {
+            outputs = static_cast<uint8_t>(outputs | (1u << m));
+        }
+    }
+    pipelineLatency.setOutputs(outputs);
+}
+
+/**
+ * @brief Log the latency of the replay that just ended (PIPELINE_LATENCY)
+ */
+static void reportPipelineLatency() {
+    pipelineLatency.disarm(micros());
+    StaticJsonWriter<1792> json;  // ~110 bytes per output, ~80 per group
+    const LatencyHistogram& rx = nmea2000->getRxLatency();
+    json.beginObject()
+        .add("n2k_rx_mode", (unsigned)N2K_RX_MODE)
+        .add("n2k_rx_p99_us", (unsigned long)rx.getPercentile(99))
+        .add("speed", (unsigned)busReplay.getSpeed())
+        .add("records", (unsigned long)busReplay.getRecordCount());
+    pipelineLatency.writeJson(json, micros(), "latency");
+    json.endObject();
+    logger.broadcastLog(LogLevel::INFO, LogComponent::BUS_REPLAY, LogEvent::PIPELINE_LATENCY, json.c_str());
+}
+#endif
+
+#if SOAK_ENABLED
+/**
+ * @brief Keep the soak load running (soak reaction, every SOAK_SERVICE_INTERVAL_MS)
+ *
+ * The bus capture, if there is one, is replayed in a loop at SOAK_REPLAY_SPEED
+ * (time through the handlers runs that much faster); SOAK_N2K_LOAD_PCT > 0
+ * adds back-to-back synthetic NMEA 2000 runs. Either stays off while the
+ * user runs a capture or load of their own.
+ */
+static void serviceSoakLoad() {
+#if BUS_CAPTURE_ENABLED
+    static bool hasCapture = LittleFS.exists(BUS_CAPTURE_PATH);
+    if (SOAK_REPLAY_SPEED > 0 && hasCapture && busCaptureWebServer != nullptr &&
+        !busReplay.isActive() && !busCapture.isActive()) {
+        busReplay.requestStart(SOAK_REPLAY_SPEED);
+    }
+#endif
+#if N2K_LOAD_ENABLED
+    if (SOAK_N2K_LOAD_PCT > 0 && n2kLoadWebServer != nullptr && !n2kLoadGenerator.isActive()) {
+        N2kLoadRequest request = {};
+        request.loadPct = SOAK_N2K_LOAD_PCT;
+        request.durationS = N2K_LOAD_MAX_DURATION_S;
+        n2kLoadGenerator.requestStart(request);  // false while the last start is pending
+    }
+#endif
+}
+
+/**
+ * @brief One soak CSV row: heap, loop latency and the drop counters
+ *
+ * From the last telemetry snapshot, so the row matches /metrics and /stats.
+ * @return false before the first aggregation (no row)
+ */
+static bool fillSoakSample(SoakSample& sample, uint32_t now) {
+    TelemetrySnapshot snapshot;
+    if (!telemetry.read(snapshot) || snapshot.generation == 0) {
+        return false;
+    }
+    memset(&sample, 0, sizeof(sample));
+    sample.uptimeS = now / 1000;
+
+    static const struct {
+        SoakColumn column;
+        TelemetryGauge gauge;
+    } GAUGES[] = {
+        {SoakColumn::HEAP_FREE, TelemetryGauge::HEAP_FREE},
+        {SoakColumn::HEAP_LARGEST, TelemetryGauge::HEAP_LARGEST},
+        {SoakColumn::HEAP_MIN, TelemetryGauge::HEAP_MIN},
+        {SoakColumn::LOOP_P50_US, TelemetryGauge::LOOP_P50},
+        {SoakColumn::LOOP_P99_US, TelemetryGauge::LOOP_P99},
+        {SoakColumn::LOOP_MAX_US, TelemetryGauge::LOOP_MAX},
+    };
+    for (const auto& g : GAUGES) {
+        uint32_t value = snapshot.get(g.gauge);
+        sample.set(g.column, value != TelemetryRegistry::NO_VALUE ? value : 0);
+    }
+    sample.set(SoakColumn::HEAP_FAILED, snapshot.get(TelemetryCounter::HEAP_FAILED).total);
+    sample.set(SoakColumn::CAN_DROPPED, snapshot.get(TelemetryCounter::CAN_DROPPED).total);
+    sample.set(SoakColumn::UART_DROPPED, snapshot.get(TelemetryCounter::UART_DROPPED).total);
+    sample.set(SoakColumn::WS_DROPPED, snapshot.get(TelemetryCounter::WS_DROPPED).total);
+    sample.set(SoakColumn::LOG_DROPPED, snapshot.get(TelemetryCounter::LOG_DROPPED).total);
+    return true;
+}
+#endif
 
 // Reboot management
 bool rebootScheduled = false;
@@ -114,8 +819,11 @@ unsigned long rebootTime = 0;
  *
  * Configures WebSocket event handlers for BoatData streaming.
  * - Logs client connections/disconnections
- * - Enforces maximum 10 concurrent clients
+ * - Enforces maximum BOATDATA_STREAM_MAX_CLIENTS concurrent clients (admitRequest() refuses the upgrade)
  * - Rejects connections if limit exceeded
+ * - Registers every client with its format: full, ?mode=delta (keyframe + delta) or ?fmt=bin (binary snapshot)
+ * - Applies subscription messages (groups + rate; handleBoatDataCommand())
+ * - Registers GET /boatdata/stats (per-client sent/dropped frame counters)
  *
  * Part of Feature 011-simple-webui-as (US1: Real-time BoatData Streaming)
  */
@@ -123,33 +831,528 @@ void setupBoatDataWebSocket(AsyncWebServer* server) {
     wsBoatData.onEvent([](AsyncWebSocket* server, AsyncWebSocketClient* client,
                           AwsEventType type, void* arg, uint8_t* data, size_t len) {
         if (type == WS_EVT_CONNECT) {
-            // Check maximum client limit (10 clients)
-            if (server->count() > 10) {
-                logger.broadcastLog(LogLevel::WARN, "BoatDataStream", "MAX_CLIENTS_EXCEEDED",
-                    String(F("{\"clientId\":")) + client->id() + F(",\"action\":\"rejected\"}"));
-                client->close(1011, "Server overload - max 10 clients");
+            // Admission refused the upgrade at the limit; this catches handshakes admitted together
+            if (!GetAdmissionController().opened(AdmissionEndpoint::BOATDATA)) {
+                logger.broadcastLogf(LogLevel::WARN, LogComponent::BOATDATA_STREAM, LogEvent::MAX_CLIENTS_EXCEEDED,
+                    "{\"clientId\":%u,\"action\":\"rejected\"}", (unsigned)client->id());
+                client->close(1011, "Server overload - max clients");
+                return;
+            }
+
+            // Opt-in formats: binary snapshot frames, or a keyframe then changed fields only
+            AsyncWebServerRequest* request = static_cast<AsyncWebServerRequest*>(arg);
+            BoatDataStreamMode mode = BoatDataStreamMode::FULL;
+            if (request != nullptr && request->hasParam("fmt") && request->getParam("fmt")->value() == "bin") {
+                mode = BoatDataStreamMode::BINARY;
+            } else if (request != nullptr && request->hasParam("mode") &&
+                       request->getParam("mode")->value() == "delta") {
+                mode = BoatDataStreamMode::DELTA;
+            }
+#if BOATDATA_REPLAY_ENABLED
+            // Reconnect after a drop: the snapshots missed since its last frame come first
+            if (request != nullptr && request->hasParam("since")) {
+                boatDataReplay.request(client->id(),
+                    strtoul(request->getParam("since")->value().c_str(), nullptr, 10));
+            }
+#endif
+            if (!boatDataStreamClients.add(client->id(), mode)) {
+                // Table full (a disconnect not processed yet): the client would never be scheduled
+                client->close(1011, "Server overload - max clients");
                 return;
             }
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().add(AdmissionEndpoint::BOATDATA, client->id(), millis());
+#endif
+            const char* modeName = mode == BoatDataStreamMode::BINARY ? "bin"
+                                 : mode == BoatDataStreamMode::DELTA ? "delta" : "full";
 
             // Log new connection
-            logger.broadcastLog(LogLevel::INFO, "BoatDataStream", "CLIENT_CONNECTED",
-                String(F("{\"clientId\":")) + client->id() +
-                F(",\"totalClients\":") + server->count() + F("}"));
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::BOATDATA_STREAM, LogEvent::CLIENT_CONNECTED,
+                "{\"clientId\":%u,\"totalClients\":%u,\"mode\":\"%s\"}", (unsigned)client->id(),
+                (unsigned)server->count(), modeName);
 
         } else if (type == WS_EVT_DISCONNECT) {
+            GetAdmissionController().closed(AdmissionEndpoint::BOATDATA);
+            boatDataStreamClients.remove(client->id());
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().remove(AdmissionEndpoint::BOATDATA, client->id());
+#endif
+
             // Log disconnection
-            logger.broadcastLog(LogLevel::INFO, "BoatDataStream", "CLIENT_DISCONNECTED",
-                String(F("{\"clientId\":")) + client->id() +
-                F(",\"totalClients\":") + server->count() + F("}"));
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::BOATDATA_STREAM, LogEvent::CLIENT_DISCONNECTED,
+                "{\"clientId\":%u,\"totalClients\":%u}", (unsigned)client->id(), (unsigned)server->count());
+
+        } else if (type == WS_EVT_PONG) {
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().seen(AdmissionEndpoint::BOATDATA, client->id(), millis());
+#endif
+#if WIFI_PROFILE_ENABLED
+            // Answer to the round-trip ping of the Wi-Fi profile statistics
+            wifiProfileManager.onPong(micros());
+#endif
+        } else if (type == WS_EVT_DATA) {
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().seen(AdmissionEndpoint::BOATDATA, client->id(), millis());
+#endif
+            // Subscription messages: single-frame text only
+            AwsFrameInfo* info = static_cast<AwsFrameInfo*>(arg);
+            if (info != nullptr && info->final && info->index == 0 &&
+                info->len == len && info->opcode == WS_TEXT) {
+                handleBoatDataCommand(client, data, len);
+            }
         }
     });
 
     server->addHandler(&wsBoatData);
+#if BOATDATA_REPLAY_ENABLED
+    boatDataStreamStatsWebServer.setReplay(&boatDataReplay);
+#endif
+    boatDataStreamStatsWebServer.registerRoutes(server);
 
-    logger.broadcastLog(LogLevel::INFO, "BoatDataStream", "ENDPOINT_REGISTERED",
-        F("{\"path\":\"/boatdata\",\"maxClients\":10}"));
+    logger.broadcastLogf(LogLevel::INFO, LogComponent::BOATDATA_STREAM, LogEvent::ENDPOINT_REGISTERED,
+        "{\"path\":\"/boatdata\",\"maxClients\":%u}", (unsigned)BOATDATA_STREAM_MAX_CLIENTS);
 }
 
+/**
+ * @brief Setup /signalk/v1/stream WebSocket endpoint
+ * @param server AsyncWebServer instance
+ *
+ * Signal K delta stream for chart plotters and Signal K clients.
+ * - Enforces maximum SIGNALK_MAX_CLIENTS concurrent clients (admitRequest() refuses the upgrade)
+ * - Sends the Signal K hello message on connect
+ * - Requests a keyframe so the newcomer gets every mapped path
+ * - Deltas are rendered by the /boatdata broadcast loop from the shared delta baseline
+ * - Registers GET /signalk (discovery document)
+ */
+void setupSignalKWebSocket(AsyncWebServer* server) {
+    wsSignalK.onEvent([](AsyncWebSocket* server, AsyncWebSocketClient* client,
+                         AwsEventType type, void* arg, uint8_t* data, size_t len) {
+        if (type == WS_EVT_CONNECT) {
+            if (!GetAdmissionController().opened(AdmissionEndpoint::SIGNALK)) {
+                logger.broadcastLogf(LogLevel::WARN, LogComponent::SIGNALK, LogEvent::MAX_CLIENTS_EXCEEDED,
+                    "{\"clientId\":%u,\"action\":\"rejected\"}", (unsigned)client->id());
+                client->close(1011, "Server overload - max clients");
+                return;
+            }
+
+            client->text("{\"name\":\"" SIGNALK_SOURCE_LABEL "\",\"version\":\"1.0.0\","
+                         "\"self\":\"vessels.self\",\"roles\":[\"master\",\"main\"]}");
+            __atomic_store_n(&signalKClientJoined, true, __ATOMIC_RELEASE);
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().add(AdmissionEndpoint::SIGNALK, client->id(), millis());
+#endif
+
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::SIGNALK, LogEvent::CLIENT_CONNECTED,
+                "{\"clientId\":%u,\"totalClients\":%u}", (unsigned)client->id(), (unsigned)server->count());
+
+        } else if (type == WS_EVT_DISCONNECT) {
+            GetAdmissionController().closed(AdmissionEndpoint::SIGNALK);
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().remove(AdmissionEndpoint::SIGNALK, client->id());
+#endif
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::SIGNALK, LogEvent::CLIENT_DISCONNECTED,
+                "{\"clientId\":%u,\"totalClients\":%u}", (unsigned)client->id(), (unsigned)server->count());
+#if WS_LIVENESS_ENABLED
+        } else if (type == WS_EVT_PONG || type == WS_EVT_DATA) {
+            GetWsLiveness().seen(AdmissionEndpoint::SIGNALK, client->id(), millis());
+#endif
+        }
+        // Incoming messages (subscribe/unsubscribe) are ignored: every client gets all paths
+    });
+
+    server->addHandler(&wsSignalK);
+
+    server->on("/signalk", HTTP_GET, [](AsyncWebServerRequest* request) {
+        FixedString<96> url;
+        url.format("ws://%s/signalk/v1/stream", request->host().c_str());
+        StaticJsonWriter<192> body;
+        body.beginObject()
+            .beginObject("endpoints").beginObject("v1")
+                .add("version", "1.0.0")
+                .add("signalk-ws", url.c_str())
+            .endObject().endObject()
+            .beginObject("server")
+                .add("id", SIGNALK_SOURCE_LABEL)
+                .add("version", "1.0.0")
+            .endObject()
+            .endObject();
+        request->send(200, "application/json", body.c_str());
+    });
+
+    logger.broadcastLogf(LogLevel::INFO, LogComponent::SIGNALK, LogEvent::ENDPOINT_REGISTERED,
+        "{\"path\":\"/signalk/v1/stream\",\"maxClients\":%u}", (unsigned)SIGNALK_MAX_CLIENTS);
+}
+
+/**
+ * @brief UtcClock discipline pass; a step also sets the system time (time(), file stamps)
+ */
+static void updateUtcClock() {
+    uint32_t now = millis();
+    UtcClock& clock = GetUtcClock();
+#if BUS_CAPTURE_ENABLED
+    clock.setHeld(busReplay.isActive(), now);  // Replayed sentences carry the capture's time
+#endif
+    if (!clock.update(now)) {
+        return;
+    }
+    uint64_t utc = clock.toUtc(now);
+    struct timeval tv = {static_cast<time_t>(utc / 1000), static_cast<suseconds_t>((utc % 1000) * 1000)};
+    settimeofday(&tv, nullptr);
+
+    char iso[25];
+    UtcClock::formatIso(utc, iso, sizeof(iso), true);
+    logger.broadcastLogf(LogLevel::INFO, LogComponent::MAIN, LogEvent::UTC_CLOCK_STEPPED,
+        "{\"utc\":\"%s\",\"source\":\"%s\",\"steps\":%lu,\"error_ms\":%ld}",
+        iso, UtcClock::sourceName(clock.getSource()), (unsigned long)clock.getSteps(),
+        (long)clock.getLastErrorMs());
+}
+
+#if CALIB_LEARN_ENABLED
+/**
+ * @brief Calibration learner sample (CALIB_LEARN_INTERVAL_MS, BACKGROUND class)
+ *
+ * Reads snapshots of the inputs and the last cycle's derived values, so
+ * the 5 Hz calculation is never waited on. With CALIB_LEARN_AUTO_APPLY a
+ * ready proposal that moved past the apply thresholds is applied at most
+ * every CALIB_LEARN_APPLY_INTERVAL_MS.
+ */
+static void updateCalibrationLearner() {
+    if (boatData == nullptr) {
+        return;
+    }
+    uint32_t now = millis();
+    calibrationLearner.add(boatData->getWindData(), boatData->getCompassData(), boatData->getGPSData(),
+                           boatData->getSpeedData(), boatData->getDerivedData(), now);
+    calibrationLearner.publish();
+
+#if CALIB_LEARN_AUTO_APPLY
+    if (calibrationWebServer == nullptr || now - lastLearnedApplyMs < CALIB_LEARN_APPLY_INTERVAL_MS) {
+        return;
+    }
+    CalibrationProposal proposal;
+    if (!calibrationLearner.readProposal(proposal)) {
+        return;
+    }
+    CalibrationData current = boatData->getCalibration();
+    uint8_t fields = CalibrationLearner::changes(proposal, current.windAngleOffset,
+                                                 current.leewayCalibrationFactor);
+    if (fields != 0 && calibrationWebServer->applyLearned(proposal, fields)) {
+        lastLearnedApplyMs = now;
+        logger.broadcastLogf(LogLevel::INFO, LogComponent::CALCULATION_ENGINE, LogEvent::CALIBRATION_LEARNED,
+            "{\"windAngleOffset\":%.4f,\"leewayKFactor\":%.3f,\"fields\":%u}",
+            proposal.windAngleOffset, proposal.leewayK, (unsigned)fields);
+    }
+#endif
+}
+#endif
+
+#if AIS_ENABLED
+/**
+ * @brief Setup /ais WebSocket endpoint and the /ais HTTP routes
+ * @param server AsyncWebServer instance
+ *
+ * Collision-risk stream for the dashboard and chart plotters.
+ * - Enforces maximum AIS_MAX_CLIENTS concurrent clients (admitRequest() refuses the upgrade)
+ * - Sends the current risk list on connect; the main loop sends every pass after that
+ * - Registers GET /ais/risks and GET /ais/targets (AisWebServer)
+ */
+void setupAisWebSocket(AsyncWebServer* server) {
+    wsAis.onEvent([](AsyncWebSocket* server, AsyncWebSocketClient* client,
+                     AwsEventType type, void* arg, uint8_t* data, size_t len) {
+        if (type == WS_EVT_CONNECT) {
+            if (!GetAdmissionController().opened(AdmissionEndpoint::AIS)) {
+                logger.broadcastLogf(LogLevel::WARN, LogComponent::AIS, LogEvent::MAX_CLIENTS_EXCEEDED,
+                    "{\"clientId\":%u,\"action\":\"rejected\"}", (unsigned)client->id());
+                client->close(1011, "Server overload - max clients");
+                return;
+            }
+
+            AisRiskList risks;
+            if (aisTargets.readRisks(risks)) {
+                StaticJsonWriter<AIS_WS_JSON_SIZE> json;
+                AisTargetTable::writeRisksJson(json, risks);
+                if (!json.overflowed()) {
+                    client->text(json.c_str());
+                }
+            }
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().add(AdmissionEndpoint::AIS, client->id(), millis());
+#endif
+
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::AIS, LogEvent::CLIENT_CONNECTED,
+                "{\"clientId\":%u,\"totalClients\":%u}", (unsigned)client->id(), (unsigned)server->count());
+
+        } else if (type == WS_EVT_DISCONNECT) {
+            GetAdmissionController().closed(AdmissionEndpoint::AIS);
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().remove(AdmissionEndpoint::AIS, client->id());
+#endif
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::AIS, LogEvent::CLIENT_DISCONNECTED,
+                "{\"clientId\":%u,\"totalClients\":%u}", (unsigned)client->id(), (unsigned)server->count());
+#if WS_LIVENESS_ENABLED
+        } else if (type == WS_EVT_PONG || type == WS_EVT_DATA) {
+            GetWsLiveness().seen(AdmissionEndpoint::AIS, client->id(), millis());
+#endif
+        }
+        // Incoming messages are ignored: every client gets the whole risk list
+    });
+
+    server->addHandler(&wsAis);
+    aisWebServer.registerRoutes(server);
+
+    logger.broadcastLogf(LogLevel::INFO, LogComponent::AIS, LogEvent::ENDPOINT_REGISTERED,
+        "{\"path\":\"/ais\",\"maxClients\":%u}", (unsigned)AIS_MAX_CLIENTS);
+}
+
+/**
+ * @brief AIS pass: apply the N2k reports, CPA/TCPA, stream the risk list (AIS_EVALUATE_INTERVAL_MS)
+ *
+ * !AIVDM reports reach the table directly (NMEA0183Handler, main loop);
+ * PGN 129038/129039 arrive through GetAisReportQueue() from the N2k task.
+ * The pass only computes the reported and the nearby targets
+ * (AisTargetTable), so its cost does not grow with a crowded anchorage.
+ */
+static void updateAis() {
+    AisPositionReport report;
+    while (GetAisReportQueue().pop(report)) {
+        aisTargets.update(report);
+    }
+
+    uint32_t now = millis();
+    AisOwnShip own = {0.0, 0.0, NAN, NAN, 0, false};
+    if (boatData != nullptr) {
+        const GPSData& gps = boatData->getDataStructure()->gps;
+        own = {gps.latitude, gps.longitude, static_cast<float>(gps.cog), static_cast<float>(gps.sog),
+               static_cast<uint32_t>(gps.lastUpdate), gps.available};
+    }
+    aisTargets.evaluate(own, now);
+
+    if (wsAis.count() == 0) {
+        return;
+    }
+    AisRiskList risks;
+    if (!aisTargets.readRisks(risks)) {
+        return;  // Same task as the writer: not reached
+    }
+    JsonWriter json(aisScratch, sizeof(aisScratch));
+    AisTargetTable::writeRisksJson(json, risks);
+    if (json.overflowed()) {
+        return;
+    }
+    size_t length = strlen(aisScratch);
+    AsyncWebSocketSharedBuffer frame = pooledFrame(aisScratch, length);
+    if (!frame) {
+        return;  // Pool exhausted (counted): next pass
+    }
+    uint32_t sent = 0;
+    for (AsyncWebSocketClient& client : wsAis.getClients()) {
+        if (client.status() == WS_CONNECTED && client.queueLen() < BOATDATA_STREAM_MAX_QUEUED) {
+            client.text(frame);  // A backed-up client skips this pass: the next list supersedes it
+            sent++;
+        }
+    }
+    GetWebTrafficStats().wsSent(AdmissionEndpoint::AIS, length, sent);
+}
+#endif
+
+#if WS_LIVENESS_ENABLED
+/**
+ * @brief Close the WebSocket clients that stopped answering, then ping every client (main loop)
+ *
+ * A client silent for WS_PING_MAX_MISSED pings gets a close frame; one that
+ * is still connected an interval later (no close handshake from a sleeping
+ * peer) has its TCP connection aborted. The /boatdata ping doubles as the
+ * Wi-Fi profile round trip.
+ */
+static void checkWebSocketLiveness(uint32_t nowMs) {
+    WsLivenessVerdict verdicts[WsLiveness::SLOTS];
+    uint8_t count = GetWsLiveness().check(nowMs, verdicts, WsLiveness::SLOTS);
+    for (uint8_t i = 0; i < count; i++) {
+        const WsLivenessVerdict& verdict = verdicts[i];
+        AsyncWebSocket* ws = verdict.endpoint == AdmissionEndpoint::BOATDATA ? &wsBoatData
+                           : verdict.endpoint == AdmissionEndpoint::SIGNALK ? &wsSignalK
+#if AIS_ENABLED
+                           : verdict.endpoint == AdmissionEndpoint::AIS ? &wsAis
+#endif
+                           : logger.getWebSocket();
+        AsyncWebSocketClient* client = ws != nullptr ? ws->client(verdict.id) : nullptr;
+        if (client == nullptr) {
+            continue;  // Disconnected meanwhile
+        }
+        bool abort = verdict.action == WsLivenessAction::ABORT;
+        logger.broadcastLogf(LogLevel::WARN, LogComponent::WEB_SERVER, LogEvent::CLIENT_EVICTED,
+            "{\"endpoint\":\"%s\",\"clientId\":%u,\"silentMs\":%lu,\"action\":\"%s\"}",
+            AdmissionEndpointName(verdict.endpoint), (unsigned)verdict.id,
+            (unsigned long)verdict.silentMs, abort ? "abort" : "close");
+        if (abort) {
+            client->client()->abort();
+        } else {
+            client->close(1001, "Ping timeout");
+        }
+    }
+
+    wsSignalK.pingAll();
+#if AIS_ENABLED
+    wsAis.pingAll();
+#endif
+    if (logger.getWebSocket() != nullptr) {
+        logger.getWebSocket()->pingAll();
+    }
+#if WIFI_PROFILE_ENABLED
+    wifiProfileManager.ping(wsBoatData, micros());
+#else
+    wsBoatData.pingAll();
+#endif
+}
+#endif
+
+#if WEB_STATS_ENABLED
+/**
+ * @brief Sample the send queues of one WebSocket endpoint (main loop)
+ *
+ * Walks the client list like the Signal K broadcast does; queueLen() is the
+ * number of frames the library still holds for the client.
+ */
+static void sampleWebSocket(AsyncWebSocket* ws, AdmissionEndpoint endpoint, uint32_t nowMs) {
+    uint16_t clients = 0;
+    uint16_t queued = 0;
+    uint16_t deepest = 0;
+    if (ws != nullptr) {
+        for (AsyncWebSocketClient& client : ws->getClients()) {
+            if (client.status() != WS_CONNECTED) {
+                continue;
+            }
+            uint16_t length = static_cast<uint16_t>(client.queueLen());
+            clients++;
+            queued = static_cast<uint16_t>(queued + length);
+            deepest = length > deepest ? length : deepest;
+        }
+    }
+    GetWebTrafficStats().sampleSocket(endpoint, clients, queued, deepest, nowMs);
+}
+#endif
+
+/**
+ * @brief Admission middleware, ahead of every handler (async_tcp task)
+ *
+ * Upgrades of /boatdata, /signalk/v1/stream, /logs and /ais count against their
+ * endpoint limit and the heap-scaled budget of AdmissionController; any
+ * request is refused while the heap is below ADMISSION_HEAP_RESERVE. A
+ * refused request gets 503 + Retry-After and no handler runs, so a refused
+ * WebSocket never reaches the handshake.
+ */
+static void admitRequest(AsyncWebServerRequest* request, ArMiddlewareNext next) {
+    AdmissionEndpoint endpoint = AdmissionController::endpointFor(request->url().c_str(),
+                                                                  request->hasHeader("Upgrade"));
+    AdmissionResult result = GetAdmissionController().admit(endpoint, ESP.getFreeHeap());
+    if (result == AdmissionResult::ADMITTED) {
+        next();
+        return;
+    }
+    logger.broadcastLogf(LogLevel::WARN, LogComponent::WEB_SERVER, LogEvent::MAX_CLIENTS_EXCEEDED,
+        "{\"url\":\"%s\",\"reason\":\"%s\"}", request->url().c_str(), AdmissionResultName(result));
+    AsyncWebServerResponse* response = request->beginResponse(503, "application/json",
+        "{\"status\":\"error\",\"message\":\"Server busy\"}");
+    response->addHeader("Retry-After", String(ADMISSION_RETRY_AFTER_S));
+    request->send(response);
+}
+
+#if WEB_STATS_ENABLED
+/**
+ * @brief Body length of a response
+ *
+ * The library keeps it protected; a member pointer formed in a derived
+ * class reads it without patching the library. Set by send() for sized
+ * bodies and by every write() of a response stream, 0 for chunked ones.
+ */
+struct ResponseBodyLength : AsyncWebServerResponse {
+    static size_t of(const AsyncWebServerResponse* response) {
+        return response != nullptr ? response->*(&ResponseBodyLength::_contentLength) : 0;
+    }
+};
+
+/**
+ * @brief Timing middleware, ahead of admission (async_tcp task)
+ *
+ * Records per route (WebTrafficStats) the time until the handler returned
+ * and until the connection closed, and the body bytes both ways; a
+ * WebSocket upgrade only counts as an upgrade of its endpoint.
+ */
+static void measureRequest(AsyncWebServerRequest* request, ArMiddlewareNext next) {
+    const char* path = request->url().c_str();
+    if (request->hasHeader("Upgrade")) {
+        GetWebTrafficStats().recordUpgrade(AdmissionController::endpointFor(path, true));
+        next();
+        return;
+    }
+    WebRoute route = WebTrafficStats::routeFor(path);
+    uint32_t start = micros();
+    request->onDisconnect([route, start]() {
+        GetWebTrafficStats().recordComplete(route, micros() - start);
+    });
+    next();
+    GetWebTrafficStats().recordResponse(route, micros() - start, request->contentLength(),
+                                        ResponseBodyLength::of(request->getResponse()));
+}
+#endif
+
+/**
+ * @brief What mDNS advertises: config.h endpoints and the network services that started
+ */
+static MdnsAdvertConfig mdnsConfig() {
+    MdnsAdvertConfig config;
+    config.httpPort = 80;
+    config.nmea0183Tcp = nmea0183TcpGateway.isStarted();
+    config.nmea0183Port = N0183_TCP_PORT;
+    config.nmea0183Clients = N0183_TCP_MAX_CLIENTS;
+    config.nmea0183Talker = N0183_TCP_TALKER;
+    config.udp = boatDataUdpPublisher.isStarted();
+    config.udpGroup = BOATDATA_UDP_BROADCAST ? "broadcast" : BOATDATA_UDP_GROUP;
+    config.udpPort = BOATDATA_UDP_PORT;
+    return config;
+}
+
+#if WIFI_PROFILE_ENABLED
+/**
+ * @brief Calculation and navigation rates of the active Wi-Fi profile
+ *
+ * Only the minimum intervals move; the heartbeats and the alarm subscription
+ * keep their rates. A no-op until the subscriptions exist.
+ */
+static void applyWiFiProfileIntervals() {
+    const WiFiPowerProfile& profile = wifiProfileManager.getSelector().getActiveProfile();
+    if (boatData != nullptr) {
+        boatData->setSubscriptionMinInterval(calculationSubscription, profile.calcMinMs);
+        boatData->setSubscriptionMinInterval(navigationSubscription, profile.navMinMs);
+    }
+}
+
+/**
+ * @brief Output sink rates of the active Wi-Fi profile (UDP datagrams)
+ */
+static void applyWiFiProfileOutputs() {
+    uint32_t udpMs = wifiProfileManager.getSelector().getActiveProfile().udpMs;
+    outputPipeline.setInterval(udpOutputSink, udpMs, udpMs);
+}
+
+/**
+ * @brief Stream rates of the active Wi-Fi profile: governor range, default ticks and keyframes
+ *
+ * The UDP interval is the rate of its output sink.
+ */
+static void applyWiFiProfileRates() {
+    const WiFiPowerProfile& profile = wifiProfileManager.getSelector().getActiveProfile();
+    boatDataRateGovernor.setRange(profile.broadcastMs, profile.fastestMs);
+    boatDataStreamClients.setDefaultTicks(boatDataRateGovernor.getTicks());
+    boatDataStreamClients.setFloorTicks(boatDataRateGovernor.getFloorTicks());
+    boatDataDelta.setKeyframeInterval(boatDataRateGovernor.getKeyframeMs());
+    applyWiFiProfileIntervals();
+    applyWiFiProfileOutputs();
+}
+#endif
+
+static void startNetworkServices(const String& ip);
+
 /**
  * @brief Handle WiFi connection success event
  *
@@ -162,6 +1365,7 @@ void onWiFiConnected() {
 
     // Update connection state
     wifiManager->handleConnectionSuccess(connectionState, ssid);
+    GetBootTimeline().milestone(BootMilestone::WIFI_CONNECTED, millis());
 
     // Print IP address to Serial
     Serial.print(F("WiFi connected! IP address: "));
@@ -170,14 +1374,138 @@ void onWiFiConnected() {
     // Log connection success
     logger.logConnectionEvent(ConnectionEvent::CONNECTION_SUCCESS, ssid);
 
+#if POSEIDON_FEATURE_DISPLAY
     // T-BUGFIX-001: Update display with WiFi connection status
     if (displayManager != nullptr) {
         displayManager->updateWiFiStatus(CONN_CONNECTED, ssid.c_str(), ip.c_str());
     }
+#endif
+
+#if WIFI_PROFILE_ENABLED
+    // Power save and TX power are reset with the driver: set them on every connect
+    wifiProfileManager.applyRadio();
+#endif
+
+    startNetworkServices(ip);
+}
+
+// Image size of the running firmware (read once at the end of setup())
+uint32_t sketchBytes = 0;
+uint32_t sketchFreeBytes = 0;
+
+/**
+ * @brief Feature profile of this build (POSEIDON_FEATURE_*) and its image size
+ *
+ * {"profile":"n2k_gateway","display":false,"onewire":false,"nmea0183":false,
+ * "hot_path_iram":false,"ap_forward":false,"sketch_bytes":1043216,"sketch_free":922864}; logged as BUILD_PROFILE at the
+ * end of setup() and part of GET /status, so profiles compare by their boot logs.
+ */
+static void writeBuildProfile(JsonWriter& json, const char* key = nullptr) {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("profile", POSEIDON_PROFILE)
+        .add("display", POSEIDON_FEATURE_DISPLAY != 0)
+        .add("onewire", POSEIDON_FEATURE_ONEWIRE != 0)
+        .add("nmea0183", POSEIDON_FEATURE_NMEA0183 != 0)
+        .add("hot_path_iram", HOT_PATH_IRAM != 0)
+        .add("ap_forward", AP_FORWARD_ENABLED != 0)
+        .add("sketch_bytes", (unsigned long)sketchBytes)
+        .add("sketch_free", (unsigned long)sketchFreeBytes)
+        .endObject();
+}
+
+/**
+ * @brief GET /status body, one group per step (ChunkedJsonGenerator, async_tcp task)
+ *
+ * The boot timeline is the largest step and sets CHUNKED_JSON_PIECE_BYTES.
+ */
+static bool writeStatusStep(JsonWriter& json, uint16_t step, void*) {
+    switch (step) {
+        case 0: {
+            uint32_t now = millis();
+            json.beginObject()
+                .add("uptime_ms", (unsigned long)now)
+                .add("free_heap", (unsigned long)ESP.getFreeHeap());
+            GetUtcClock().writeJson(json, now, "clock");  // clock.utc is the UTC of uptime_ms
+            if (systemMetrics != nullptr) {
+                systemMetrics->getHeapMonitor().writeJson(json, "heap");
+            }
+            return true;
+        }
+        case 1:
+            GetWsBufferPool().writeJson(json, "ws_pool");
+#if POSEIDON_FEATURE_DISPLAY
+            if (displayAdapter != nullptr) {
+                // OLED frames sent by the flush task, and refreshes skipped while it was busy
+                json.beginObject("display")
+                    .add("frames", (unsigned long)displayAdapter->getFramesSent())
+                    .add("skipped", (unsigned long)displayAdapter->getFramesSkipped())
+                    .endObject();
+            }
+#endif
+            GetWriteBehind().writeJson(json, "persistence");
+            json.beginObject("chunked")
+                .add("in_use", (unsigned int)GetChunkedJsonResponder().getInUse())
+                .add("refused", (unsigned long)GetChunkedJsonResponder().getRefused())
+                .add("overflows", (unsigned long)GetChunkedJsonResponder().getOverflows())
+                .endObject();
+            return true;
+        case 2:
+            GetStaticFootprint().writeJson(json, "static");
+            writeBuildProfile(json, "build");
+            return true;
+        case 3:
+            outputPipeline.writeJson(json, "outputs");
+#if ACTISENSE_FORWARD_ENABLED
+            actisenseForward.getStats().writeJson(json, "actisense_forward");
+#endif
+            return true;
+        case 4:
+            if (nmea2000 != nullptr) {
+                nmea2000->getBusMonitor().writeJson(json, millis(), "can_bus");
+            }
+            n2kAddressMemory.writeJson(json, "n2k_address");
+            dataTables.writeJson(json, "tables");
+            variationGrid.writeJson(json, "variation_grid");
+#if AP_FORWARD_ENABLED && POSEIDON_FEATURE_NMEA0183
+            GetAutopilotForward().writeJson(json, "autopilot_forward");
+#endif
+#if IMU_ENABLED
+            if (imuSource != nullptr) {
+                imuSource->writeJson(json, "imu");
+            }
+#endif
+            return true;
+        default:
+            GetBootTimeline().writeJson(json, millis(), "boot");
+            json.endObject();
+            return false;
+    }
+}
 
+/**
+ * @brief Start the web server, the streams and the network services (once)
+ *
+ * Called on the first station connect, or earlier when the SoftAP fallback
+ * brings up the gateway's own access point; the services listen on every
+ * interface, so they keep running when the station connects later.
+ *
+ * @param ip Address reported in the WEB_SERVER STARTED event
+ */
+static void startNetworkServices(const String& ip) {
     // Start web server if not already running
     if (webServer == nullptr) {
-        webServer = new ConfigWebServer(wifiManager, &wifiConfig, &connectionState);
+        webServer = webServerStorage.emplace(wifiManager, &wifiConfig, &connectionState);
+#if WEB_STATS_ENABLED
+        webServer->getServer()->addMiddleware(measureRequest);  // First: refused requests are timed too
+#endif
+        webServer->getServer()->addMiddleware(admitRequest);
+#if WIFI_AP_FALLBACK_ENABLED
+        webServer->setApFallback(&wifiApFallback);
+#endif
         webServer->setupRoutes();
 
         // T039: Register calibration API routes
@@ -185,29 +1513,169 @@ void onWiFiConnected() {
             calibrationWebServer->registerRoutes(webServer->getServer());
         }
 
+        // GET /n2k/stats - per-PGN receive statistics
+        if (n2kStatsWebServer != nullptr) {
+            n2kStatsWebServer->registerRoutes(webServer->getServer());
+        }
+
+        // GET /memory - reservations per component, heap and stack watermarks
+        if (memoryWebServer != nullptr) {
+            memoryWebServer->registerRoutes(webServer->getServer());
+        }
+
+#if POSEIDON_FEATURE_NMEA0183
+        // GET /nmea0183/stats - per-sentence parse-quality statistics
+        if (nmea0183StatsWebServer != nullptr) {
+            nmea0183StatsWebServer->registerRoutes(webServer->getServer());
+        }
+#endif
+
+        // /capture/* and /replay/* - raw bus capture and replay
+        if (busCaptureWebServer != nullptr) {
+            busCaptureWebServer->registerRoutes(webServer->getServer());
+        }
+
+        // /n2k/load/* - synthetic NMEA 2000 load runs
+        if (n2kLoadWebServer != nullptr) {
+            n2kLoadWebServer->registerRoutes(webServer->getServer());
+        }
+
+        // /history and /history/series - BoatData field trends
+        if (historyWebServer != nullptr) {
+            historyWebServer->registerRoutes(webServer->getServer());
+        }
+
+        // /voyage and /voyage/segment - voyage log segments
+        if (voyageRecorderWebServer != nullptr) {
+            voyageRecorderWebServer->registerRoutes(webServer->getServer());
+        }
+
+        // /counters and /counters/reset - engine hours, distance and energy totals
+        if (tripCountersWebServer != nullptr) {
+            tripCountersWebServer->registerRoutes(webServer->getServer());
+        }
+
+#if ENGINE_JOURNAL_ENABLED
+        // GET /journal/engine - engine and saildrive event journal
+        if (engineJournal.isReady()) {
+            engineJournalWebServer.registerRoutes(webServer->getServer());
+        }
+#endif
+
+#if ALARM_ENABLED
+        // /alarms, /alarms/anchor, /alarms/reset, /alarms/rules - anchor watch and threshold alarms
+        alarmWebServer.registerRoutes(webServer->getServer());
+#endif
+
+        // GET /navigation - opposite-tack heading and waypoint laylines
+        if (navigationWebServer != nullptr) {
+            navigationWebServer->registerRoutes(webServer->getServer());
+        }
+
+        // GET /calc/stats - calculation cycle timing and deadline misses
+        if (calcTimingWebServer != nullptr) {
+            calcTimingWebServer->registerRoutes(webServer->getServer());
+        }
+
+        // GET /sources and POST /sources/override - source arbitration and live switching
+        if (sourcesWebServer != nullptr) {
+            sourcesWebServer->registerRoutes(webServer->getServer());
+        }
+
+        // GET /api/boatdata - REST snapshot with ETag (If-None-Match answered 304)
+        if (boatDataApiWebServer != nullptr) {
+            boatDataApiWebServer->registerRoutes(webServer->getServer());
+        }
+
+#if WEB_STATS_ENABLED
+        // GET /web/stats - per-route handler timing, WebSocket rates and send queues
+        webStatsWebServer.registerRoutes(webServer->getServer());
+#endif
+
+#if METRICS_ENABLED
+        // GET /metrics - Prometheus scrape of the registered counters and gauges
+        metricsWebServer.registerRoutes(webServer->getServer());
+#endif
+
+#if WIFI_PROFILE_ENABLED
+        // GET /wifi/profile and POST /wifi/profile?name= - power/latency profile
+        wifiProfileManager.registerRoutes(webServer->getServer());
+#endif
+
+#if OTA_ENABLED
+        // POST /update and GET /update - firmware and filesystem images over the air
+        otaWebServer.registerRoutes(webServer->getServer());
+#endif
+
+#if REACTION_PROFILER_ENABLED
+        // GET /reactions - cost and lateness of each main-loop reaction
+        reactionProfilerWebServer.registerRoutes(webServer->getServer());
+#endif
+
+#if TRACE_ENABLED
+        // GET /trace - Chrome trace_event JSON of the recent trace events
+        traceWebServer.registerRoutes(webServer->getServer());
+#endif
+
+#if CALC_BENCHMARK_ENABLED
+        // GET /calc/benchmark - cycles per calculation stage
+        if (calcBenchmarkWebServer != nullptr) {
+            calcBenchmarkWebServer->registerRoutes(webServer->getServer());
+        }
+#endif
+
+#if SOAK_ENABLED
+        // GET /soak and /soak/csv - soak run trends and metric rows
+        if (soakWebServer != nullptr) {
+            soakWebServer->registerRoutes(webServer->getServer());
+        }
+#endif
+
         webServer->begin();
 
         // Attach WebSocket logger to web server for reliable logging
         logger.begin(webServer->getServer(), "/logs");
 
-        // Setup /boatdata WebSocket endpoint (Feature 011: US1)
-        setupBoatDataWebSocket(webServer->getServer());
+#if N0183_TCP_ENABLED
+        // NMEA0183 sentence stream for chartplotter apps (TCP 10110)
+        nmea0183TcpGateway.begin(&logger);
+#endif
 
-        // Setup /stream HTTP endpoint for HTML dashboard (Feature 011: US2)
-        webServer->getServer()->on("/stream", HTTP_GET, [](AsyncWebServerRequest *request) {
-            if (!LittleFS.exists("/stream.html")) {
-                logger.broadcastLog(LogLevel::ERROR, "HTTPFileServer", "FILE_NOT_FOUND",
-                    F("{\"path\":\"/stream.html\"}"));
-                request->send(404, "text/plain", "Dashboard file not found in LittleFS");
-                return;
-            }
+#if BOATDATA_UDP_ENABLED
+        // Binary snapshot datagrams for any number of displays (UDP multicast)
+        boatDataUdpPublisher.begin(&logger);
+#endif
 
-            request->send(LittleFS, "/stream.html", "text/html");
+#if MDNS_ENABLED
+        // poseidon2.local plus _poseidon2/_signalk-ws/_nmea-0183._tcp; the TXT records are
+        // formatted once and handed over again only when an applied configuration changes them
+        if (mdnsAdvertiser.begin(mdnsConfig(), &logger)) {
+            GetConfigService().subscribe(ConfigDomain::WIFI, "mdns", [](void*, uint32_t) {
+                mdnsAdvertiser.update(mdnsConfig());
+                return ConfigApplyResult::APPLIED;
+            }, nullptr);
+        }
+#endif
 
-            String clientIP = request->client()->remoteIP().toString();
-            logger.broadcastLog(LogLevel::DEBUG, "HTTPFileServer", "FILE_SERVED",
-                String(F("{\"path\":\"/stream.html\",\"clientIP\":\"")) + clientIP + F("\"}"));
-        });
+#if POSEIDON_FEATURE_NMEA0183
+        // NMEA0183 network input: (re)start now that the network is up (idempotent)
+        if (net0183Port != nullptr) {
+            net0183Port->begin(0);
+        }
+#endif
+
+        // Setup /boatdata and /signalk/v1/stream WebSocket endpoints (Feature 011: US1)
+        setupBoatDataWebSocket(webServer->getServer());
+        setupSignalKWebSocket(webServer->getServer());
+#if AIS_ENABLED
+        setupAisWebSocket(webServer->getServer());
+#endif
+
+        // Setup /stream HTTP endpoint for HTML dashboard (Feature 011: US2)
+        staticAssetServer.add("/stream", "/stream.html", "text/html");
+        staticAssetServer.add("/boatdata-decoder.js", "/boatdata-decoder.js", "application/javascript");
+        staticAssetServer.add("/stream-sw.js", "/stream-sw.js", "application/javascript", STREAM_SW_MAX_AGE_S);
+        staticAssetServer.registerRoutes(webServer->getServer());
 
         // Register log filter configuration endpoint
         webServer->getServer()->on("/log-filter", HTTP_POST, [](AsyncWebServerRequest *request) {
@@ -215,48 +1683,77 @@ void onWiFiConnected() {
 
             // Parse query parameters
             if (request->hasParam("level")) {
-                String levelStr = request->getParam("level")->value();
-                LogLevel level = parseLogLevel(levelStr);
+                LogLevel level = parseLogLevel(request->getParam("level")->value().c_str());
                 logger.setFilterLevel(level);
                 updated = true;
             }
 
             if (request->hasParam("components")) {
-                String components = request->getParam("components")->value();
-                logger.setFilterComponents(components);
+                logger.setFilterComponents(request->getParam("components")->value());
                 updated = true;
             }
 
             if (request->hasParam("events")) {
-                String events = request->getParam("events")->value();
-                logger.setFilterEvents(events);
+                logger.setFilterEvents(request->getParam("events")->value());
                 updated = true;
             }
 
             // If no params provided, return current filter
+            StaticJsonWriter<LogFilter::TEXT_SIZE * 2 + 96> response;
             if (!updated) {
-                request->send(200, "application/json", logger.getFilterConfig());
+                logger.writeFilterConfig(response);
+                request->send(200, "application/json", response.c_str());
                 return;
             }
 
             // Return success with new filter config
-            String response = "{\"status\":\"ok\",\"filter\":";
-            response += logger.getFilterConfig();
-            response += "}";
-            request->send(200, "application/json", response);
-
-            // Log filter change
-            logger.broadcastLog(LogLevel::INFO, "WebServer", "LOG_FILTER_UPDATED",
-                logger.getFilterConfig());
+            response.beginObject().add("status", "ok");
+            logger.writeFilterConfig(response, "filter");
+            response.endObject();
+            request->send(200, "application/json", response.c_str());
+
+            // Log filter change (the filter object inside the response)
+            StaticJsonWriter<LogFilter::TEXT_SIZE * 2 + 64> filter;
+            logger.writeFilterConfig(filter);
+            logger.broadcastLog(LogLevel::INFO, LogComponent::WEB_SERVER, LogEvent::LOG_FILTER_UPDATED, filter.c_str());
         });
 
         // Register GET endpoint to query current filter
         webServer->getServer()->on("/log-filter", HTTP_GET, [](AsyncWebServerRequest *request) {
-            request->send(200, "application/json", logger.getFilterConfig());
+            StaticJsonWriter<LogFilter::TEXT_SIZE * 2 + 64> filter;
+            logger.writeFilterConfig(filter);
+            request->send(200, "application/json", filter.c_str());
+        });
+
+        // Client counts, limits and refusals per endpoint (AdmissionController)
+        webServer->getServer()->on("/admission", HTTP_GET, [](AsyncWebServerRequest *request) {
+            StaticJsonWriter<512> json;
+            GetAdmissionController().writeJson(json, ESP.getFreeHeap());
+            request->send(200, "application/json", json.c_str());
+        });
+
+#if STALL_WATCHDOG_ENABLED
+        // Watched slots, and the stall of this and the previous boot
+        webServer->getServer()->on("/watchdog", HTTP_GET, [](AsyncWebServerRequest *request) {
+            StaticJsonWriter<1024> json;
+            stallWatchdog.writeStats(json, millis());
+            request->send(200, "application/json", json.c_str());
+        });
+#endif
+
+        // Uptime, heap (last sample: fragmentation, rates) and the boot timeline
+        webServer->getServer()->on("/status", HTTP_GET, [](AsyncWebServerRequest *request) {
+            GetChunkedJsonResponder().send(request, writeStatusStep, nullptr);
+        });
+
+        // Records that survived the last reset (RTC memory crash ring)
+        webServer->getServer()->on("/logs/previous", HTTP_GET, [](AsyncWebServerRequest *request) {
+            request->send(200, "application/x-ndjson", logger.getPreviousBootLog());
         });
 
-        logger.broadcastLog(LogLevel::INFO, "WebServer", "STARTED",
-            String("{\"ip\":\"") + ip + "\",\"port\":80}");
+        StaticJsonWriter<64> started;
+        started.beginObject().add("ip", ip).add("port", 80).endObject();
+        logger.broadcastLog(LogLevel::INFO, LogComponent::WEB_SERVER, LogEvent::STARTED, started.c_str());
     }
 }
 
@@ -264,18 +1761,21 @@ void onWiFiConnected() {
  * @brief Handle WiFi disconnection event
  *
  * Called when ESP32 WiFi disconnects.
- * Triggers retry logic for same network (no failover).
+ * Triggers retry logic for same network (no failover): directed to the cached
+ * access point if there is one, so the delay is kept short.
  */
 void onWiFiDisconnected() {
     wifiManager->handleDisconnect(connectionState);
 
+#if POSEIDON_FEATURE_DISPLAY
     // T-BUGFIX-001: Update display with WiFi disconnection
     if (displayManager != nullptr) {
         displayManager->updateWiFiStatus(CONN_DISCONNECTED);
     }
+#endif
 
     // Attempt to reconnect to same network
-    app.onDelay(1000, [&]() {
+    app.onDelay(WIFI_RECONNECT_DELAY_MS, [&]() {
         if (connectionState.status == ConnectionStatus::DISCONNECTED) {
             wifiManager->connect(connectionState, wifiConfig);
         }
@@ -291,15 +1791,21 @@ void onWiFiDisconnected() {
 void broadcastKeepAlive() {
     if (connectionState.status == ConnectionStatus::CONNECTED) {
         unsigned long uptime = millis() / 1000; // seconds
-        logger.broadcastLog(LogLevel::INFO, "KeepAlive", "HEARTBEAT",
-            String("{\"uptime\":") + uptime + ",\"ssid\":\"" + connectionState.connectedSSID + "\"}");
+        StaticJsonWriter<96> heartbeat;
+        heartbeat.beginObject()
+            .add("uptime", uptime)
+            .add("ssid", connectionState.connectedSSID)
+            .endObject();
+        logger.broadcastLog(LogLevel::INFO, LogComponent::KEEP_ALIVE, LogEvent::HEARTBEAT, heartbeat.c_str());
     }
 }
 
 /**
  * @brief Calculate derived sailing parameters (T038)
  *
- * Called every 200ms by ReactESP event loop to calculate all 11 derived parameters.
+ * Called by BoatData change dispatch when GPS, compass, wind, DST or
+ * calibration changed, at most every CALC_MIN_INTERVAL_MS, and at least every
+ * CALC_MAX_INTERVAL_MS (changed = 0) so stale inputs are still noticed.
  * Measures calculation duration and logs warnings if cycle exceeds 200ms.
  *
  * Constitutional requirement: Skip-and-continue strategy if overrun detected.
@@ -307,10 +1813,15 @@ void broadcastKeepAlive() {
  * Updates:
  * - boatData->derived (all 11 calculated parameters)
  * - boatData->diagnostics.calculationCount
- * - boatData->diagnostics.calculationOverruns (if duration > 200ms)
- * - boatData->diagnostics.lastCalculationDuration
+ * - boatData->diagnostics.calculationOverruns (if duration > CALC_DEADLINE_US)
+ * - boatData->diagnostics.lastCalculationDuration / maxCalculationDuration
+ * - boatData->diagnostics.lastCalculationPeriod
+ * - calculationTiming (period, jitter and duration histograms)
+ * - telemetry CALC_CYCLE_US (duration of the last TELEMETRY_INTERVAL_MS)
+ * - boatData->diagnostics.lastCalculationLatency / maxCalculationLatency
+ *   (first dispatch that saw the input change to derived output)
  */
-void calculateDerivedParameters() {
+void calculateDerivedParameters(void* context, uint16_t changed) {
     if (boatData == nullptr || calculationEngine == nullptr) {
         return;  // Not yet initialized
     }
@@ -319,23 +1830,142 @@ void calculateDerivedParameters() {
     unsigned long startMicros = micros();
 
     // Execute calculation cycle
-    // CalculationEngine operates directly on BoatData's internal structure
-    calculationEngine->calculate(boatData->getDataStructure());
+    // CalculationEngine computes into its own scratch set and publishes it
+    // into BoatData's structure in one write of the derived counter
+    BoatDataStructure* boatDataStructure = boatData->getDataStructure();
+    TRACE_BEGIN(TraceId::CALCULATE, 0);
+    calculationEngine->calculate(boatDataStructure);
+    TRACE_END(TraceId::CALCULATE);
+    boatData->markChanged(BoatDataGroup::DERIVED);
 
-    // Calculate duration in milliseconds
     unsigned long durationMicros = micros() - startMicros;
-    unsigned long durationMs = durationMicros / 1000;
+    bool missed = calculationTiming.record(startMicros, durationMicros);
+    TELEMETRY_RECORD(TelemetryHistogram::CALC_CYCLE_US, durationMicros);
+
+    // Update diagnostics (single words, written on the main loop only)
+    DiagnosticData& diag = boatDataStructure->diagnostics;
+    diag.lastCalculationDuration = durationMicros;
+    if (durationMicros > diag.maxCalculationDuration) {
+        diag.maxCalculationDuration = durationMicros;
+    }
+    diag.lastCalculationPeriod = calculationTiming.getLastPeriodUs();
+    if (missed) {
+        diag.calculationOverruns++;  // Reported by the CALC_TIMING log
+    }
+    diag.lastCalculationLatency = boatData->getSubscriptionWaitMs(calculationSubscription) * 1000UL + durationMicros;
+    if (diag.lastCalculationLatency > diag.maxCalculationLatency) {
+        diag.maxCalculationLatency = diag.lastCalculationLatency;
+    }
+}
+
+/**
+ * @brief Navigation stage: opposite-tack heading and laylines (~1 Hz)
+ *
+ * Runs after the calculation cycle on derived/GPS changes, at most every
+ * NAV_MIN_INTERVAL_MS, with the waypoint last received in PGN 129284.
+ */
+void updateNavigation(void* context, uint16_t changed) {
+    if (boatData == nullptr) {
+        return;
+    }
+
+    WaypointData waypoint;
+    if (!GetActiveWaypoint().get(waypoint)) {
+        waypoint.available = false;  // Writer stalled mid-update: laylines skipped this round
+    }
+    navigationEngine.update(*boatData->getDataStructure(), waypoint, millis());
+}
+
+#if ALARM_ENABLED
+/**
+ * @brief Send the state of rule @p index as PGN 126983 (transition or repeat)
+ */
+static void sendAlarmAlert(uint8_t index) {
+#if N2K_TX_ENABLED
+    if (nmea2000 == nullptr || index >= alarmEngine.getRuleCount()) {
+        return;
+    }
+    tN2kMsg msg;
+    SetN2kPGN126983(msg, alarmEngine.getRule(index), index + 1, nmea2000->GetDeviceInformation().GetName());
+    n2kTransmitScheduler.queue(msg);  // Sent by the receive context with the periodic PGNs
+#else
+    (void)index;
+#endif
+}
 
-    // Get diagnostics
-    DiagnosticData diag = boatData->getDiagnostics();
+/**
+ * @brief Alarm stage: rules whose inputs changed, at most every ALARM_MIN_INTERVAL_MS
+ *
+ * The ALARM_HEARTBEAT_MS heartbeat (changed = 0) runs the delay timers.
+ * Transitions are logged (/logs WebSocket) and sent as PGN 126983; the
+ * OLED picks active alarms up in "oled_alarm".
+ */
+void onAlarmInputs(void* context, uint16_t changed) {
+    AlarmEngine* engine = static_cast<AlarmEngine*>(context);
+    if (boatData == nullptr) {
+        return;
+    }
 
-    // Check for overrun (>200ms)
-    if (durationMs > 200) {
-        // Log warning
-        logger.broadcastLog(LogLevel::WARN, "CalculationEngine", "OVERRUN",
-            String("{\"duration_ms\":") + durationMs + ",\"overrun_count\":" + (diag.calculationOverruns + 1) + "}");
+    engine->evaluate(*boatData->getDataStructure(), changed, millis());
+    AlarmEvent event;
+    while (engine->takeEvent(event)) {
+        switch (event.kind) {
+            case AlarmEventKind::RAISED:
+                logger.broadcastLogf(LogLevel::WARN, LogComponent::ALARM, LogEvent::ALARM_RAISED,
+                    "{\"type\":\"%s\",\"instance\":%u,\"severity\":\"%s\",\"value\":%.2f,\"threshold\":%.2f,\"occurrence\":%u}",
+                    AlarmTypeName(event.type), (unsigned)event.instance,
+                    AlarmSeverityName(AlarmTypeSeverity(event.type)), event.value, event.threshold,
+                    (unsigned)event.occurrence);
+                sendAlarmAlert(event.rule);
+                break;
+            case AlarmEventKind::CLEARED:
+                logger.broadcastLogf(LogLevel::INFO, LogComponent::ALARM, LogEvent::ALARM_CLEARED,
+                    "{\"type\":\"%s\",\"instance\":%u,\"value\":%.2f,\"threshold\":%.2f}",
+                    AlarmTypeName(event.type), (unsigned)event.instance, event.value, event.threshold);
+                sendAlarmAlert(event.rule);
+                break;
+            case AlarmEventKind::ANCHOR_DROPPED:
+                logger.broadcastLogf(LogLevel::INFO, LogComponent::ALARM, LogEvent::ANCHOR_DROPPED,
+                    "{\"radius_m\":%.1f}", event.value);
+                break;
+            case AlarmEventKind::ANCHOR_RAISED:
+                logger.broadcastLog(LogLevel::INFO, LogComponent::ALARM, LogEvent::ANCHOR_RAISED, F("{}"));
+                break;
+        }
     }
+    engine->publish();
 }
+#endif
+
+#if ENGINE_JOURNAL_ENABLED
+/**
+ * @brief Journal time: UTC seconds once the clock is set, else seconds since boot
+ */
+static uint32_t engineJournalTime(bool& utc) {
+    uint32_t now = millis();
+    uint64_t utcMs = GetUtcClock().toUtc(now);
+    utc = utcMs != 0;
+    return static_cast<uint32_t>(utc ? utcMs / 1000 : now / 1000);
+}
+
+/**
+ * @brief Journal stage: engine/saildrive changes, at most every ENGINE_JOURNAL_MIN_INTERVAL_MS
+ *
+ * Only transitions are queued (a few compares otherwise); the write-behind
+ * entry writes them to the ring file.
+ */
+void onEngineJournalInputs(void* context, uint16_t changed) {
+    (void)changed;
+    if (boatData == nullptr) {
+        return;
+    }
+    bool utc = false;
+    uint32_t time = engineJournalTime(utc);
+    if (static_cast<EngineJournalStore*>(context)->observe(*boatData->getDataStructure(), time, utc) > 0) {
+        GetWriteBehind().markDirty(engineJournalEntry, millis());
+    }
+}
+#endif
 
 /**
  * @brief NMEA message handler integration point (T040 - placeholder)
@@ -373,6 +2003,21 @@ void calculateDerivedParameters() {
  * See CLAUDE.md "BoatData Integration" section for full documentation.
  */
 
+/**
+ * @brief Queue the trip counters for the restart flush
+ *
+ * Bypasses their interval and write budget: changes since the last commit
+ * would be lost with the restart.
+ */
+void commitTripCountersForRestart() {
+    if (tripCountersEntry >= 0) {
+        tripCounters.forceCommit();
+        if (tripCounters.commitDue(millis())) {
+            GetWriteBehind().markDirty(tripCountersEntry, millis());
+        }
+    }
+}
+
 /**
  * @brief Check for scheduled reboot
  *
@@ -380,14 +2025,32 @@ void calculateDerivedParameters() {
  */
 void checkScheduledReboot() {
     if (rebootScheduled && millis() >= rebootTime) {
+        commitTripCountersForRestart();
+        GetWriteBehind().flush(millis());  // Unsaved configuration changes first
         logger.logRebootEvent(0, F("All networks exhausted - rebooting"));
+        logger.flush();
         delay(100); // Allow UDP packet to send
         ESP.restart();
     }
 
+#if OTA_ENABLED
+    // Installed image (or a filesystem image that failed half-written)
+    if (otaWebServer.shouldReboot()) {
+        commitTripCountersForRestart();
+        GetWriteBehind().flush(millis());  // File entries are refused while the filesystem is replaced
+        logger.logRebootEvent(0, F("Update installed - rebooting"));
+        logger.flush();
+        delay(100); // Allow UDP packet to send
+        ESP.restart();
+    }
+#endif
+
     // Also check web server scheduled reboots
     if (webServer != nullptr && webServer->shouldReboot()) {
+        commitTripCountersForRestart();
+        GetWriteBehind().flush(millis());
         logger.logRebootEvent(0, F("Configuration updated - rebooting"));
+        logger.flush();
         delay(100); // Allow UDP packet to send
         ESP.restart();
     }
@@ -405,23 +2068,664 @@ void scheduleReboot(unsigned long delayMs, const String& reason) {
     logger.logRebootEvent(delayMs / 1000, reason);
 }
 
+#if WIFI_AP_FALLBACK_ENABLED
+/**
+ * @brief Feed the SoftAP fallback with the link state and carry out its action
+ *
+ * Runs once a second from checkConnectionTimeout(), so every radio call stays
+ * in the main loop. The SSID ends with the last two MAC bytes, which keeps
+ * the access points of two gateways apart.
+ */
+static void serviceApFallback() {
+    WiFiApInputs inputs;
+    inputs.staConnected = connectionState.status == ConnectionStatus::CONNECTED;
+    inputs.exhausted = connectionState.status == ConnectionStatus::DISCONNECTED &&
+                       connectionState.allNetworksExhausted(wifiConfig.count);
+    inputs.configured = wifiConfig.count > 0;
+    inputs.stations = wifiAdapter->getAccessPointStations();
+
+    switch (wifiApFallback.update(inputs, millis())) {
+        case WiFiApAction::START_AP: {
+            uint64_t mac = ESP.getEfuseMac();
+            char ssid[33];
+            snprintf(ssid, sizeof(ssid), "%s%02X%02X", WIFI_AP_SSID_PREFIX,
+                     (unsigned)((mac >> 32) & 0xFF), (unsigned)((mac >> 40) & 0xFF));
+            if (!wifiAdapter->startAccessPoint(ssid, WIFI_AP_PASSWORD, WIFI_AP_CHANNEL)) {
+                logger.broadcastLogf(LogLevel::ERROR, LogComponent::WIFI_MANAGER, LogEvent::SOFTAP_FAILED,
+                    "{\"ssid\":\"%s\"}", ssid);
+                break;
+            }
+            String ip = wifiAdapter->getAccessPointIP();
+            logger.broadcastLogf(LogLevel::WARN, LogComponent::WIFI_MANAGER, LogEvent::SOFTAP_STARTED,
+                "{\"ssid\":\"%s\",\"ip\":\"%s\",\"channel\":%d,\"networks\":%d}",
+                ssid, ip.c_str(), WIFI_AP_CHANNEL, wifiConfig.count);
+#if POSEIDON_FEATURE_DISPLAY
+            if (displayManager != nullptr) {
+                displayManager->updateWiFiStatus(CONN_CONNECTED, ssid, ip.c_str());
+            }
+#endif
+            startNetworkServices(ip);
+            break;
+        }
+        case WiFiApAction::RETRY_STA:
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::WIFI_MANAGER, LogEvent::SOFTAP_RETRY,
+                "{\"retry\":%lu,\"stations\":%u,\"next_interval_ms\":%lu}",
+                (unsigned long)wifiApFallback.getRetries(), (unsigned)inputs.stations,
+                (unsigned long)wifiApFallback.getRetryIntervalMs());
+            connectionState.resetNetworkIndex();
+            wifiManager->connect(connectionState, wifiConfig);
+            break;
+        case WiFiApAction::STOP_AP:
+            wifiAdapter->stopAccessPoint();
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::WIFI_MANAGER, LogEvent::SOFTAP_STOPPED,
+                "{\"linger_ms\":%lu}", (unsigned long)WIFI_AP_LINGER_MS);
+            break;
+        default:
+            break;
+    }
+}
+#endif
+
 /**
  * @brief Check WiFi connection timeout
  *
  * Called periodically to detect connection timeouts.
- * Moves to next network on timeout, schedules reboot if all exhausted.
+ * Moves to next network on timeout (or scans after a failed directed
+ * attempt). Once all are exhausted the SoftAP fallback takes over
+ * (WIFI_AP_FALLBACK_ENABLED), otherwise a reboot is scheduled.
+ */
+void checkConnectionTimeout() {
+    if (timeoutManager.checkTimeout()) {
+        // Timeout occurred: checkTimeout() starts the next attempt itself
+        wifiManager->checkTimeout(connectionState, wifiConfig);
+#if !WIFI_AP_FALLBACK_ENABLED
+        if (connectionState.status == ConnectionStatus::DISCONNECTED) {
+            // All networks exhausted, schedule reboot
+            scheduleReboot(REBOOT_DELAY_MS, F("All networks failed"));
+        }
+#endif
+    }
+#if WIFI_AP_FALLBACK_ENABLED
+    serviceApFallback();
+#endif
+}
+
+#if STALL_WATCHDOG_ENABLED
+/**
+ * @brief esp_timer callback: record newly stalled slots, restart on a lasting stall
+ *
+ * Runs in the esp_timer task, so it keeps running while the main loop or an
+ * I/O task is stuck. The record is in RTC memory before anything is logged.
+ */
+static void checkStalls(void*) {
+    uint32_t now = millis();
+    int8_t slot;
+    while ((slot = stallWatchdog.check(now)) >= 0) {
+        uint32_t pcs[STALL_BACKTRACE_DEPTH];
+        uint8_t depth = StallWatchdog::captureBacktrace(stallWatchdog.getTask(slot), pcs, STALL_BACKTRACE_DEPTH);
+        uint8_t traceId = static_cast<uint8_t>(TraceId::COUNT);
+#if TRACE_ENABLED
+        traceId = traceRecorder.lastOpen(stallWatchdog.getCore(slot));
+#endif
+        stallWatchdog.recordStall(slot, now, traceId, pcs, depth);
+
+        StaticJsonWriter<384> json;
+        StallWatchdog::writeRecord(json, nullptr, stallWatchdog.getRecord());
+        logger.broadcastLog(LogLevel::ERROR, LogComponent::WATCHDOG, LogEvent::REACTION_STALL, json.c_str());
+    }
+
+    if (stallWatchdog.resetDue(now)) {
+        stallWatchdog.markReset();
+        logger.broadcastLogf(LogLevel::FATAL, LogComponent::WATCHDOG, LogEvent::STALL_RESET,
+            "{\"slot\":\"%s\",\"activity\":\"%s\",\"stalled_ms\":%lu}",
+            stallWatchdog.getRecord().slot, stallWatchdog.getRecord().activity,
+            (unsigned long)(now - stallWatchdog.getRecord().enteredMs));
+        ESP.restart();
+    }
+}
+
+/**
+ * @brief Watch the main loop (this task) and start the periodic stall check
+ *
+ * Also logs PREVIOUS_STALL if the RTC record of the last boot is valid.
+ */
+static void startStallWatchdog() {
+    loopStallSlot = stallWatchdog.addSlot("loop", STALL_LOOP_TIMEOUT_MS);
+    stallWatchdog.setTask(static_cast<uint8_t>(loopStallSlot), xTaskGetCurrentTaskHandle(),
+                          static_cast<uint8_t>(xPortGetCoreID()));
+
+    if (stallWatchdog.hasPreviousStall()) {
+        StaticJsonWriter<384> json;
+        StallWatchdog::writeRecord(json, nullptr, stallWatchdog.getPreviousStall());
+        logger.broadcastLog(LogLevel::WARN, LogComponent::WATCHDOG, LogEvent::PREVIOUS_STALL, json.c_str());
+    }
+
+    esp_timer_create_args_t args = {};
+    args.callback = checkStalls;
+    args.name = "stall_wd";
+    if (esp_timer_create(&args, &stallTimer) != ESP_OK ||
+        esp_timer_start_periodic(stallTimer, STALL_CHECK_INTERVAL_MS * 1000ULL) != ESP_OK) {
+        logger.broadcastLog(LogLevel::ERROR, LogComponent::WATCHDOG, LogEvent::STALL_WATCHDOG_FAILED,
+            "{\"reason\":\"esp_timer\"}");
+        return;
+    }
+    logger.broadcastLogf(LogLevel::INFO, LogComponent::WATCHDOG, LogEvent::STALL_WATCHDOG_STARTED,
+        "{\"check_ms\":%d,\"loop_timeout_ms\":%d,\"task_timeout_ms\":%d,\"reset_ms\":%d}",
+        STALL_CHECK_INTERVAL_MS, STALL_LOOP_TIMEOUT_MS, STALL_TASK_TIMEOUT_MS, STALL_RESET_MS);
+}
+#endif
+
+/**
+ * @brief T028/T029: Open the NMEA2000 CAN bus and register the PGN handlers
+ *
+ * Runs right after BoatData, before the WiFi connect and the OLED/NMEA0183
+ * init: the bus is open (and the controller queues frames) while WiFi
+ * associates and the remaining subsystems start (BOOT_N2K_TARGET_MS).
+ */
+static void initNmea2000Bus(IConfigStore* recordStore) {
+    Serial.println(F("Initializing NMEA2000 CAN bus..."));
+
+    // Create NMEA2000 instance with ESP32 CAN driver
+    nmea2000 = nmea2000Storage.emplace((gpio_num_t)CAN_TX_PIN, (gpio_num_t)CAN_RX_PIN);
+
+    // Set product information
+    nmea2000->SetProductInformation(
+        "00000001",                    // Serial number
+        100,                           // Product code
+        "Poseidon2 Gateway",          // Model ID
+        "1.0.0",                      // Software version
+        "1.0.0"                       // Model version
+    );
+
+    // Set device information
+    nmea2000->SetDeviceInformation(
+        1,                            // Unique number (1-254)
+        130,                          // Device function: PC Gateway
+        25,                           // Device class: Network Device
+        2046                          // Manufacturer code: Self-assigned
+    );
+
+    // Claim from the address held last boot (same NAME), else N2K_SOURCE_ADDRESS:
+    // on a bus where that address is taken the join does not repeat the contention
+    if (recordStore != nullptr) {
+        uint8_t record[CONFIG_RECORD_MAX_BYTES];
+        size_t length = recordStore->read(N2K_ADDRESS_RECORD_KEY, record, sizeof(record));
+        ConfigRecordStatus addressRecord =
+            n2kAddressMemory.decodeRecord(record, length, nmea2000->GetDeviceInformation().GetName());
+        if (addressRecord != ConfigRecordStatus::OK && addressRecord != ConfigRecordStatus::EMPTY) {
+            logger.broadcastLogf(LogLevel::WARN, LogComponent::PERSISTENCE, LogEvent::CONFIG_INVALID,
+                "{\"record\":\"n2k_address\",\"status\":\"%s\",\"source\":\"default\"}",
+                ConfigRecordStatusName(addressRecord));
+        }
+        n2kAddressEntry = GetWriteBehind().add("n2k_address", [](void* context) {
+            uint8_t out[CONFIG_RECORD_MAX_BYTES];
+            size_t written = n2kAddressMemory.encodeRecord(out, sizeof(out));
+            return written != 0 && static_cast<IConfigStore*>(context)->write(N2K_ADDRESS_RECORD_KEY, out, written);
+        }, recordStore);
+    }
+
+    // Set mode to ListenAndNode (receive and transmit)
+    nmea2000->SetMode(tNMEA2000::N2km_ListenAndNode, n2kAddressMemory.getStartAddress());
+
+#if ACTISENSE_FORWARD_ENABLED
+    // Every message on the bus to the console as Actisense NGT frames (canboat tooling).
+    // Unknown and system PGNs are included; a full TX ring drops whole frames.
+    nmea2000->SetForwardStream(&actisenseForward);
+    nmea2000->SetForwardType(tNMEA2000::fwdt_Actisense);
+    nmea2000->SetForwardOnlyKnownMessages(false);
+    nmea2000->SetForwardSystemMessages(true);
+    nmea2000->SetForwardOwnMessages(ACTISENSE_FORWARD_OWN_MESSAGES != 0);
+    nmea2000->EnableForward(true);
+#else
+    // No PC link on the console (we're the gateway)
+    nmea2000->EnableForward(false);
+#endif
+
+    // Fast-packet reassembly buffers and CAN receive queue (allocated once by Open()).
+    // The monitor mirrors the buffer count and reports losses in /n2k/stats.
+    nmea2000->SetN2kCANMsgBufSize(N2K_FAST_PACKET_BUFFERS);
+    nmea2000->SetN2kCANReceiveFrameBufSize(N2K_CAN_RX_FRAME_BUFFERS);
+    GetN2kFastPacketMonitor().begin(&GetN2kPGNTable(), &GetN2kPGNStats());
+#if BUS_CAPTURE_ENABLED
+    // Single observer slot: the capture tap forwards every frame to the monitor
+    busCapture.chainFrameObserver(N2kFastPacketMonitor::observe, &GetN2kFastPacketMonitor());
+    nmea2000->setFrameObserver(BusCapture::observeFrame, &busCapture);
+#else
+    nmea2000->setFrameObserver(N2kFastPacketMonitor::observe, &GetN2kFastPacketMonitor());
+#endif
+
+#if N2K_TX_ENABLED
+    // Derived-data transmit PGNs must be announced before Open()
+    RegisterN2kTransmitters(nmea2000, n2kTransmitScheduler);
+    n2kReceiveTask.setTransmitScheduler(&n2kTransmitScheduler);
+    n2kTransmitScheduler.setBusMonitor(&nmea2000->getBusMonitor());  // Yield to a busy bus
+#endif
+
+    // Open CAN bus
+    if (nmea2000->Open()) {
+        Serial.println(F("NMEA2000 CAN bus initialized successfully"));
+        logger.broadcastLog(LogLevel::INFO, LogComponent::NMEA2000, LogEvent::INIT_SUCCESS,
+                            F("{\"can_tx\":32,\"can_rx\":34,\"baud\":250000}"));
+    } else {
+        Serial.println(F("WARNING: NMEA2000 CAN bus initialization failed"));
+        logger.broadcastLog(LogLevel::ERROR, LogComponent::NMEA2000, LogEvent::INIT_FAILED,
+                            F("{\"reason\":\"CAN bus open failed - check wiring and terminators\"}"));
+        // Graceful degradation: Continue operation without NMEA2000
+    }
+
+    // T030: NMEA2000 GPS/compass senders are registered with the prioritizer
+    // automatically (one source per N2k address/NAME); only the active one is parsed.
+    // DST, ENGINE, and WIND data are updated directly without multi-source prioritization
+    GetN2kSourceTracker().begin(sourcePrioritizer, &logger);
+
+    // T029: Register NMEA2000 message handlers
+    if (nmea2000 != nullptr) {
+        RegisterN2kHandlers(nmea2000, boatData, &logger);
+        Serial.printf("NMEA2000 handlers registered - processing %u PGNs\n",
+                      (unsigned)GetN2kPGNTable().enabledCount());
+    }
+}
+
+/**
+ * @brief Mirror the owner-kept values into the TelemetryRegistry (setup())
+ *
+ * Sources run at the start of every aggregation, on the main loop: the
+ * owners' single words are copied as they are, like the JSON endpoints
+ * read them. Hot-path values (N2K_DISPATCHED, the histograms) are updated
+ * where they happen and need no source.
+ */
+static void registerTelemetrySources() {
+    bool ok = true;
+
+    // DiagnosticData (main loop)
+    ok &= telemetry.addSource([](void*) {
+        if (boatData == nullptr) return;
+        const DiagnosticData& d = boatData->getDataStructure()->diagnostics;
+        telemetry.setTotal(TelemetryCounter::MESSAGES_NMEA0183, d.nmea0183MessageCount);
+        telemetry.setTotal(TelemetryCounter::MESSAGES_NMEA2000, d.nmea2000MessageCount);
+        telemetry.setTotal(TelemetryCounter::MESSAGES_ACTISENSE, d.actisenseMessageCount);
+        telemetry.setTotal(TelemetryCounter::CALC_CYCLES, d.calculationCount);
+        telemetry.setTotal(TelemetryCounter::CALC_OVERRUNS, d.calculationOverruns);
+        telemetry.set(TelemetryGauge::CALC_DURATION_LAST, d.lastCalculationDuration);
+        telemetry.set(TelemetryGauge::CALC_DURATION_MAX, d.maxCalculationDuration);
+        telemetry.set(TelemetryGauge::CALC_LATENCY_LAST, d.lastCalculationLatency);
+        telemetry.set(TelemetryGauge::CALC_LATENCY_MAX, d.maxCalculationLatency);
+        telemetry.set(TelemetryGauge::CALC_PERIOD, d.lastCalculationPeriod);
+    }, nullptr);
+
+    // LoopPerformanceMonitor, CPU idle, HeapMonitor (last heap sample) and the firmware image
+    ok &= telemetry.addSource([](void*) {
+        if (systemMetrics == nullptr) return;
+        const LoopPerformanceMonitor& loop = systemMetrics->getLoopMonitor();
+        telemetry.set(TelemetryGauge::LOOP_FREQUENCY, systemMetrics->getLoopFrequency());
+        telemetry.set(TelemetryGauge::LOOP_P50, loop.getLatencyPercentile(50));
+        telemetry.set(TelemetryGauge::LOOP_P95, loop.getLatencyPercentile(95));
+        telemetry.set(TelemetryGauge::LOOP_P99, loop.getLatencyPercentile(99));
+        telemetry.set(TelemetryGauge::LOOP_MAX, loop.getLatencyMax());
+        const TelemetryGauge CORES[] = {TelemetryGauge::CPU_IDLE_CORE0, TelemetryGauge::CPU_IDLE_CORE1};
+        for (uint8_t core = 0; core < 2; core++) {
+            uint8_t percent = systemMetrics->getCoreIdlePercent(core);
+            telemetry.set(CORES[core], percent != CPU_IDLE_UNKNOWN ? percent : TelemetryRegistry::NO_VALUE);
+        }
+
+        const HeapMonitor& heapMonitor = systemMetrics->getHeapMonitor();
+        const HeapSample& heap = heapMonitor.getLastSample();
+        telemetry.set(TelemetryGauge::HEAP_FREE, heap.freeBytes);
+        telemetry.set(TelemetryGauge::HEAP_LARGEST, heap.largestFreeBlock);
+        telemetry.set(TelemetryGauge::HEAP_MIN, heap.minFreeBytes);
+        telemetry.set(TelemetryGauge::HEAP_FRAGMENTATION, heapMonitor.getFragmentationPercent());
+        telemetry.setTotal(TelemetryCounter::HEAP_ALLOCS, heap.allocs);
+        telemetry.setTotal(TelemetryCounter::HEAP_FREES, heap.frees);
+        telemetry.setTotal(TelemetryCounter::HEAP_FAILED, heap.failedAllocs);
+        telemetry.set(TelemetryGauge::SKETCH_BYTES, sketchBytes);
+        telemetry.set(TelemetryGauge::SKETCH_FREE, sketchFreeBytes);
+    }, nullptr);
+
+    // Drop counters of the receive queues, the WebSocket pool and the log queue
+    ok &= telemetry.addSource([](void*) {
+        telemetry.setTotal(TelemetryCounter::CAN_DROPPED, n2kReceiveTask.getQueueOverruns());
+        uint32_t uartDropped = 0;
+#if POSEIDON_FEATURE_NMEA0183
+        for (uint8_t i = 0; nmea0183Handler != nullptr && i < nmea0183Handler->getPortCount(); i++) {
+            SerialPortStats stats;
+            if (nmea0183Handler->getPortSerialStats(i, stats)) {
+                uartDropped += stats.droppedSentences;
+            }
+        }
+#endif
+        telemetry.setTotal(TelemetryCounter::UART_DROPPED, uartDropped);
+        telemetry.setTotal(TelemetryCounter::WS_DROPPED, GetWsBufferPool().getDropped());
+        telemetry.setTotal(TelemetryCounter::LOG_MESSAGES, logger.getMessageCount());
+        telemetry.setTotal(TelemetryCounter::LOG_DROPPED, logger.getDroppedCount());
+    }, nullptr);
+
+    if (!ok) {
+        logger.broadcastLog(LogLevel::WARN, LogComponent::MAIN, LogEvent::INIT_FAILED,
+                            F("{\"component\":\"telemetry\",\"reason\":\"TELEMETRY_MAX_SOURCES\"}"));
+    }
+}
+
+#if METRICS_ENABLED
+/**
+ * @brief Register the GET /metrics families (end of setup())
+ *
+ * Samplers read the owners' own counters when a scrape reaches them, on
+ * the async_tcp task: single words written by the main loop or the bus
+ * tasks, read without locks like the JSON endpoints do. Components that
+ * are not running (null pointers) produce no samples.
+ */
+static void registerMetrics() {
+    MetricRegistry& r = metricRegistry;
+    const MetricType C = MetricType::COUNTER;
+    const MetricType G = MetricType::GAUGE;
+    bool ok = true;
+
+    ok &= r.add("poseidon2_uptime_seconds", "Time since boot", G,
+        [](MetricSample& s, uint16_t, const void*) { s.value(millis() / 1000.0); });
+
+    // TelemetryRegistry (diagnostics, loop, CPU, heap, drop counters, handler histograms)
+    ok &= telemetry.registerMetrics(r);
+
+    // TaskMonitor
+    ok &= r.add("poseidon2_task_stack_bytes", "Stack size per task", G,
+        [](MetricSample& s, uint16_t i, const void*) {
+            if (i < taskMonitor.getCount()) {
+                s.label("task", taskMonitor.getName(i)).label("core", (unsigned long)taskMonitor.getCore(i))
+                 .value(taskMonitor.getStackBytes(i));
+            }
+        }, TASK_MONITOR_MAX_TASKS);
+    ok &= r.add("poseidon2_task_stack_free_bytes", "Smallest free stack per task since it started", G,
+        [](MetricSample& s, uint16_t i, const void*) {
+            if (i < taskMonitor.getCount()) {
+                s.label("task", taskMonitor.getName(i)).label("core", (unsigned long)taskMonitor.getCore(i))
+                 .value(taskMonitor.getFreeStack(i));
+            }
+        }, TASK_MONITOR_MAX_TASKS);
+
+    // N2kPGNStats (one series per tracked PGN and source)
+    ok &= r.add("poseidon2_n2k_frames_total", "NMEA 2000 messages received per PGN and source", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            const N2kPGNStatsEntry* e = GetN2kPGNStats().getSlot(i);
+            if (e != nullptr) s.label("pgn", (unsigned long)e->pgn).label("source", (unsigned long)e->source).value(e->received);
+        }, N2kPGNStats::SLOTS);
+    ok &= r.add("poseidon2_n2k_parse_failures_total", "NMEA 2000 messages that failed to parse per PGN and source", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            const N2kPGNStatsEntry* e = GetN2kPGNStats().getSlot(i);
+            if (e != nullptr) s.label("pgn", (unsigned long)e->pgn).label("source", (unsigned long)e->source).value(e->parseFailures);
+        }, N2kPGNStats::SLOTS);
+    ok &= r.add("poseidon2_n2k_untracked_frames_total", "NMEA 2000 messages of pairs that did not fit the table", C,
+        [](MetricSample& s, uint16_t, const void*) { s.value(GetN2kPGNStats().getOverflowCount()); });
+
+    // CanBusMonitor (load windows and controller error state)
+    ok &= r.add("poseidon2_can_bus_load_percent", "NMEA 2000 bus utilisation (1 s, 5 s, peak 1 s since boot)", G,
+        [](MetricSample& s, uint16_t i, const void*) {
+            if (nmea2000 == nullptr) return;
+            static const char* const WINDOWS[] = {"1s", "5s", "peak"};
+            const CanBusMonitor& m = nmea2000->getBusMonitor();
+            uint32_t now = millis();
+            const uint8_t values[] = {m.loadPercent(now, CAN_BUS_LOAD_SHORT_MS),
+                                      m.loadPercent(now, CAN_BUS_LOAD_LONG_MS), m.getPeakPercent()};
+            s.label("window", WINDOWS[i]).value(values[i]);
+        }, 3);
+    ok &= r.add("poseidon2_can_error_counter", "CAN controller error counters (tec, rec)", G,
+        [](MetricSample& s, uint16_t i, const void*) {
+            if (nmea2000 == nullptr) return;
+            const CanBusMonitor& m = nmea2000->getBusMonitor();
+            s.label("counter", i == 0 ? "tec" : "rec").value(i == 0 ? m.getTxErrors() : m.getRxErrors());
+        }, 2);
+    ok &= r.add("poseidon2_can_bus_state", "CAN fault confinement state (0 active, 1 warning, 2 passive, 3 bus-off)", G,
+        [](MetricSample& s, uint16_t, const void*) {
+            if (nmea2000 != nullptr) s.value(static_cast<uint8_t>(nmea2000->getBusMonitor().getState()));
+        });
+    ok &= r.add("poseidon2_can_errors_total", "CAN controller state entries and RX FIFO overruns", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            if (nmea2000 == nullptr) return;
+            static const char* const EVENTS[] = {"warning", "passive", "bus_off", "overrun"};
+            const CanBusMonitor& m = nmea2000->getBusMonitor();
+            const uint32_t counts[] = {m.getWarnings(), m.getPassives(), m.getBusOffs(), m.getOverruns()};
+            s.label("event", EVENTS[i]).value(counts[i]);
+        }, 4);
+#if ACTISENSE_FORWARD_ENABLED
+    ok &= r.add("poseidon2_actisense_forward_frames_total", "NMEA 2000 messages forwarded to the console (sent, dropped on a full TX ring)", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            const ActisenseForwardStats& f = actisenseForward.getStats();
+            s.label("result", i == 0 ? "sent" : "dropped").value(i == 0 ? f.getFrames() : f.getDropped());
+        }, 2);
+#endif
+
+#if POSEIDON_FEATURE_NMEA0183
+    // NMEA0183SentenceStats (one series per sentence type and talker)
+    ok &= r.add("poseidon2_nmea0183_sentences_total", "NMEA 0183 sentences received per type and talker", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            const NMEA0183SentenceStatsEntry* e =
+                nmea0183Handler != nullptr ? nmea0183Handler->getSentenceStats().getSlot(i) : nullptr;
+            if (e == nullptr) return;
+            char type[4] = {0};
+            char talker[3] = {0};
+            NMEA0183SentenceStats::unpackKey(*e, type, talker);
+            s.label("sentence", type).label("talker", talker).value(e->received);
+        }, NMEA0183SentenceStats::SLOTS);
+    ok &= r.add("poseidon2_nmea0183_rejected_total", "NMEA 0183 sentences rejected per type, talker and reason", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            static const char* const REASONS[] = {"checksum", "parse", "range", "talker", "unhandled"};
+            const NMEA0183SentenceStatsEntry* e =
+                nmea0183Handler != nullptr ? nmea0183Handler->getSentenceStats().getSlot(i / 5) : nullptr;
+            if (e == nullptr) return;
+            const uint32_t counts[] = {e->checksumFailed, e->parseFailed, e->rangeRejected, e->talkerRejected, e->unhandled};
+            char type[4] = {0};
+            char talker[3] = {0};
+            NMEA0183SentenceStats::unpackKey(*e, type, talker);
+            s.label("sentence", type).label("talker", talker).label("reason", REASONS[i % 5]).value(counts[i % 5]);
+        }, NMEA0183SentenceStats::SLOTS * 5);
+    ok &= r.add("poseidon2_nmea0183_untracked_sentences_total", "NMEA 0183 sentences of pairs that did not fit the table", C,
+        [](MetricSample& s, uint16_t, const void*) {
+            if (nmea0183Handler != nullptr) s.value(nmea0183Handler->getSentenceStats().getOverflowCount());
+        });
+#endif
+
+    // SourcePrioritizer (sources are registered in index order)
+    ok &= r.add("poseidon2_source_updates_total", "Updates received per sensor source", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            if (sourcePrioritizer == nullptr) return;
+            SensorSource source = sourcePrioritizer->getSource(i);
+            if (source.sourceId[0] != '\0') s.label("source", source.sourceId).value(source.updateCount);
+        }, MAX_SENSOR_SOURCES);
+    ok &= r.add("poseidon2_source_rejected_total", "Invalid or outlier readings rejected per sensor source", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            if (sourcePrioritizer == nullptr) return;
+            SensorSource source = sourcePrioritizer->getSource(i);
+            if (source.sourceId[0] != '\0') s.label("source", source.sourceId).value(source.rejectedCount);
+        }, MAX_SENSOR_SOURCES);
+    ok &= r.add("poseidon2_source_dropped_total", "Updates dropped while another source was active", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            if (sourcePrioritizer == nullptr) return;
+            SensorSource source = sourcePrioritizer->getSource(i);
+            if (source.sourceId[0] != '\0') s.label("source", source.sourceId).value(source.droppedCount);
+        }, MAX_SENSOR_SOURCES);
+    ok &= r.add("poseidon2_source_rate_hz", "Measured update rate per sensor source", G,
+        [](MetricSample& s, uint16_t i, const void*) {
+            if (sourcePrioritizer == nullptr) return;
+            SensorSource source = sourcePrioritizer->getSource(i);
+            if (source.sourceId[0] != '\0') s.label("source", source.sourceId).value(source.updateFrequency);
+        }, MAX_SENSOR_SOURCES);
+    ok &= r.add("poseidon2_source_active", "1 while the source is selected for its sensor type", G,
+        [](MetricSample& s, uint16_t i, const void*) {
+            if (sourcePrioritizer == nullptr) return;
+            SensorSource source = sourcePrioritizer->getSource(i);
+            if (source.sourceId[0] != '\0') s.label("source", source.sourceId).value(source.active ? 1 : 0);
+        }, MAX_SENSOR_SOURCES);
+
+    // WebTrafficStats
+    ok &= r.add("poseidon2_http_requests_total", "HTTP requests per route", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            WebRoute route = static_cast<WebRoute>(i);
+            s.label("route", WebTrafficStats::routeName(route)).value(GetWebTrafficStats().getRoute(route).requests);
+        }, WebTrafficStats::ROUTE_COUNT);
+    ok &= r.add("poseidon2_http_response_bytes_total", "HTTP response body bytes per route (chunked responses not counted)", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            WebRoute route = static_cast<WebRoute>(i);
+            s.label("route", WebTrafficStats::routeName(route)).value(GetWebTrafficStats().getRoute(route).txBytes);
+        }, WebTrafficStats::ROUTE_COUNT);
+    ok &= r.add("poseidon2_http_first_byte_p99_us", "99th percentile of the handler time per route", G,
+        [](MetricSample& s, uint16_t i, const void*) {
+            WebRoute route = static_cast<WebRoute>(i);
+            s.label("route", WebTrafficStats::routeName(route))
+             .value(GetWebTrafficStats().getRoute(route).firstByte.getPercentile(99));
+        }, WebTrafficStats::ROUTE_COUNT);
+    ok &= r.add("poseidon2_websocket_clients", "Connected WebSocket clients per endpoint", G,
+        [](MetricSample& s, uint16_t i, const void*) {
+            AdmissionEndpoint endpoint = static_cast<AdmissionEndpoint>(i);
+            s.label("endpoint", WebTrafficStats::socketName(endpoint)).value(GetWebTrafficStats().getClients(endpoint));
+        }, WebTrafficStats::SOCKET_COUNT);
+    ok &= r.add("poseidon2_websocket_messages_total", "WebSocket messages queued to clients per endpoint", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            AdmissionEndpoint endpoint = static_cast<AdmissionEndpoint>(i);
+            s.label("endpoint", WebTrafficStats::socketName(endpoint)).value(GetWebTrafficStats().getMessages(endpoint));
+        }, WebTrafficStats::SOCKET_COUNT);
+    ok &= r.add("poseidon2_websocket_bytes_total", "WebSocket bytes queued to clients per endpoint", C,
+        [](MetricSample& s, uint16_t i, const void*) {
+            AdmissionEndpoint endpoint = static_cast<AdmissionEndpoint>(i);
+            s.label("endpoint", WebTrafficStats::socketName(endpoint)).value(GetWebTrafficStats().getBytes(endpoint));
+        }, WebTrafficStats::SOCKET_COUNT);
+    ok &= r.add("poseidon2_websocket_queue_peak", "Deepest client send queue per endpoint since the last reset", G,
+        [](MetricSample& s, uint16_t i, const void*) {
+            AdmissionEndpoint endpoint = static_cast<AdmissionEndpoint>(i);
+            s.label("endpoint", WebTrafficStats::socketName(endpoint)).value(GetWebTrafficStats().getQueuePeak(endpoint));
+        }, WebTrafficStats::SOCKET_COUNT);
+#if WS_LIVENESS_ENABLED
+    ok &= r.add("poseidon2_websocket_ping_timeouts_total", "WebSocket clients closed for missing WS_PING_MAX_MISSED pings", C,
+        [](MetricSample& s, uint16_t, const void*) { s.value(GetWsLiveness().getEvicted()); });
+#endif
+    ok &= r.add("poseidon2_metrics_refused_total", "Scrapes answered 503 (METRICS_MAX_SCRAPES in progress)", C,
+        [](MetricSample& s, uint16_t, const void*) { s.value(metricsWebServer.getRefused()); });
+
+    logger.broadcastLogf(ok ? LogLevel::INFO : LogLevel::WARN, LogComponent::WEB_SERVER, LogEvent::ENDPOINT_REGISTERED,
+        "{\"path\":\"/metrics\",\"families\":%u,\"complete\":%s}", (unsigned)r.getCount(), ok ? "true" : "false");
+}
+#endif
+
+/**
+ * @brief List what each component reserves for GET /memory (end of setup())
+ *
+ * sizeof of the globals and StaticInstance slots of this build; entries
+ * inside another one name it (part_of) and are not summed twice.
  */
-void checkConnectionTimeout() {
-    if (timeoutManager.checkTimeout()) {
-        // Timeout occurred, handled by timeout callback
-        if (wifiManager->checkTimeout(connectionState, wifiConfig)) {
-            // checkTimeout returns true if should try next network
-            wifiManager->connect(connectionState, wifiConfig);
-        } else {
-            // All networks exhausted, schedule reboot
-            scheduleReboot(REBOOT_DELAY_MS, F("All networks failed"));
-        }
+static void listMemoryBudget() {
+    MemoryBudget& m = memoryBudget;
+    const MemoryRegion S = MemoryRegion::STATIC;
+
+    m.add("static_instances", GetStaticFootprint().reservedBytes, S);
+    m.add("boat_data", sizeof(BoatData), S, "static_instances");
+    m.add("boat_data_structure", sizeof(BoatDataStructure), S, "boat_data");
+    m.add("source_prioritizer", sizeof(SourcePrioritizer), S, "static_instances");
+    m.add("calculation_engine", sizeof(CalculationEngine), S, "static_instances");
+#if POSEIDON_FEATURE_NMEA0183
+    m.add("nmea0183_handler", sizeof(NMEA0183Handler), S, "static_instances");
+#endif
+    m.add("n2k_driver", sizeof(ESP32N2kCanDriver), S, "static_instances");
+#if POSEIDON_FEATURE_DISPLAY
+    m.add("display_manager", sizeof(DisplayManager), S, "static_instances");
+    m.add("display_adapter", sizeof(ESP32DisplayAdapter), S, "static_instances");
+#endif
+#if POSEIDON_FEATURE_ONEWIRE
+    m.add("onewire_sensors", sizeof(ESP32OneWireSensors), S, "static_instances");
+    m.add("onewire_poller", sizeof(OneWireSensorPoller), S, "static_instances");
+#endif
+#if IMU_ENABLED
+    m.add("imu_source", sizeof(ImuAttitudeSource), S, "static_instances");   // Includes the FIFO batch
+#endif
+
+    m.add("logger", sizeof(logger), S);
+    m.add("log_ring", sizeof(LogRingBuffer), S, "logger");
+    m.add("n2k_pgn_stats", sizeof(N2kPGNStats), S);
+    m.add("boatdata_stream", sizeof(boatDataStreamClients) + sizeof(boatDataDelta), S);
+#if BOATDATA_REPLAY_ENABLED
+    m.add("boatdata_replay", sizeof(boatDataReplay), S);
+#endif
+    m.add("boatdata_scratch", sizeof(boatDataScratch), S);
+    m.add("boatdata_json", BoatDataSerializer::JSON_BUFFER_SIZE, S, "boatdata_scratch");
+    m.add("signalk_json", BoatDataSerializer::SIGNALK_BUFFER_SIZE, S, "boatdata_scratch");
+    m.add("polar_table", sizeof(polarTable), S);
+    m.add("data_tables", sizeof(dataPartition) + sizeof(dataTables) + sizeof(variationGrid), S);  // Tables stay in flash
+    m.add("navigation", sizeof(navigationEngine), S);
+#if CALIB_LEARN_ENABLED
+    m.add("calibration_learner", sizeof(calibrationLearner), S);
+#endif
+#if AIS_ENABLED
+    m.add("ais_targets", sizeof(aisTargets) + sizeof(aisScratch), S);
+#endif
+    m.add("calc_timing", sizeof(calculationTiming), S);
+    m.add("n2k_rx_tx", sizeof(n2kReceiveTask) + sizeof(n2kTransmitScheduler), S);
+    m.add("n2k_address", sizeof(n2kAddressMemory), S);
+#if ACTISENSE_FORWARD_ENABLED
+    m.add("actisense_forward", sizeof(actisenseForward) + ACTISENSE_FORWARD_TX_BUFFER, MemoryRegion::BOOT_HEAP);  // UART TX ring
+#endif
+    m.add("nmea0183_tcp", sizeof(nmea0183TcpGateway), S);
+    m.add("udp_publisher", sizeof(boatDataUdpPublisher), S);
+    m.add("mdns", sizeof(mdnsAdvertiser), S);
+#if WIFI_PROFILE_ENABLED
+    m.add("wifi_profile", sizeof(wifiProfileManager), S);
+#endif
+    m.add("wifi_ap", sizeof(wifiApFallback), S);
+    m.add("web_stats", sizeof(WebTrafficStats), S);
+    m.add("metrics", sizeof(metricRegistry) + sizeof(metricsWebServer), S);
+    m.add("telemetry", sizeof(telemetry) + sizeof(telemetrySystemMetrics), S);
+    m.add("chunked_json", sizeof(ChunkedJsonResponder), S);
+    m.add("ws_liveness", sizeof(WsLiveness), S);
+    m.add("static_assets", sizeof(staticAssetServer), S);
+    m.add("bus_capture", sizeof(busCapture) + sizeof(busReplay) + sizeof(pipelineLatency), S);
+    m.add("n2k_load", sizeof(n2kLoadGenerator), S);
+    m.add("history", sizeof(historyRecorder), S);
+    m.add("voyage_log", sizeof(voyageRecorder), S);
+    m.add("trip_counters", sizeof(tripCounters), S);
+#if ENGINE_JOURNAL_ENABLED
+    m.add("engine_journal", sizeof(engineJournal) + sizeof(engineJournalWebServer), S);
+#endif
+#if ALARM_ENABLED
+    m.add("alarm_engine", sizeof(alarmEngine) + sizeof(alarmWebServer), S);
+#endif
+    m.add("io_pump", sizeof(ioPump), S);
+    m.add("boot_timeline", sizeof(BootTimeline), S);
+    m.add("task_monitor", sizeof(taskMonitor), S);
+    m.add("memory_budget", sizeof(memoryBudget), S);
+    m.add("write_behind", sizeof(WriteBehind), S);
+    m.add("output_pipeline", sizeof(outputPipeline), S);
+#if OTA_ENABLED
+    m.add("ota_update", sizeof(otaWebServer), S);
+#endif
+#if REACTION_PROFILER_ENABLED
+    m.add("reaction_profiler", sizeof(reactionProfiler), S);
+#endif
+#if TRACE_ENABLED
+    m.add("trace_recorder", sizeof(traceRecorder), S);
+#endif
+#if ALLOC_TRACK_ENABLED
+    m.add("alloc_tracker", sizeof(AllocTracker), S);
+#endif
+#if SOAK_ENABLED
+    m.add("soak", sizeof(soakRecorder), S);
+#endif
+#if SCHED_ENABLED
+    m.add("reaction_scheduler", sizeof(reactionScheduler), S);
+#endif
+#if STALL_WATCHDOG_ENABLED
+    m.add("stall_watchdog", sizeof(stallWatchdog), S);
+    m.add("stall_record", sizeof(StallRecord), MemoryRegion::RTC);
+#endif
+    m.add("crash_log", sizeof(CrashLogStorage), MemoryRegion::RTC);
+
+    uint32_t poolBytes = 0;
+    for (uint8_t c = 0; c < WsBufferPool::CLASS_COUNT; c++) {
+        poolBytes += GetWsBufferPool().getBufferCount(c) * WsBufferPool::classBytes(c);
     }
+    m.add("scratch_loop", GetLoopArena().getCapacity(), S);
+    m.add("scratch_http", GetHttpArena().getCapacity(), S);
+    m.add("ws_pool", poolBytes, MemoryRegion::BOOT_HEAP);
+    GetBufferPlacement().addTo(m);  // PSRAM, or boot_heap when it fell back
+
+    // Per-call documents on the calling task's stack
+    m.add("log_line", LOG_LINE_BUFFER_SIZE, MemoryRegion::STACK);
+    m.add("status_json", 2048, MemoryRegion::STACK);
 }
 
 /**
@@ -432,313 +2736,1368 @@ void checkConnectionTimeout() {
  * 2. Create HAL adapter instances
  * 3. Create WiFiManager with dependencies
  * 4. Register ReactESP event loops
- * 5. Load WiFi configuration
- * 6. Attempt first network connection
- * 7. Register WiFi event handlers
+ * 5. Open the NMEA2000 bus (before WiFi: frames flow while WiFi associates)
+ * 6. Load WiFi configuration
+ * 7. Attempt first network connection
+ * 8. Register WiFi event handlers
+ *
+ * Each step is marked in the boot timeline (GET /status); the OLED init
+ * runs on the first loop pass instead of here.
  */
 void setup() {
     // Initialize serial for initial debugging (minimal use per constitution)
+#if ACTISENSE_FORWARD_ENABLED
+    // Same port carries the bus forward: TX ring sized before begin()
+    Serial.setTxBufferSize(ACTISENSE_FORWARD_TX_BUFFER);
+    Serial.begin(ACTISENSE_FORWARD_BAUD);
+#else
     Serial.begin(115200);
-    delay(2000); // Wait for Serial to initialize
+#endif
+#if BOOT_SERIAL_WAIT_MS > 0
+    delay(BOOT_SERIAL_WAIT_MS); // Wait for a serial monitor to attach (development builds)
+#endif
+    GetBootTimeline().mark("serial", millis());
 
-    
     Serial.println(F("Poseidon2 WiFi Gateway - Initializing..."));
 
+    // WebSocket send buffers first, while the heap is still unfragmented
+    if (!GetWsBufferPool().begin()) {
+        Serial.println(F("WARNING: WebSocket buffer pool incomplete"));
+    }
+
+    // Large, rarely touched buffers: PSRAM first, reduced capacities without it
+    // (history and bus capture place theirs in begin())
+    uint32_t placedCount = 0;
+    deltaSnapshot = GetBufferPlacement().place<BoatDataStructure>("delta_snapshot", 1, 1, placedCount);
+#if TRACE_ENABLED
+    traceRecorder.begin();
+#endif
+
     // T044: Create HAL instances (must be done in setup, not as globals, to avoid watchdog)
-    wifiAdapter = new ESP32WiFiAdapter();
-    fileSystem = new LittleFSAdapter();
+    wifiAdapter = wifiAdapterStorage.emplace();
+    fileSystem = fileSystemStorage.emplace();
+
+    // Calibration and Wi-Fi networks: binary records in NVS, independent of LittleFS
+    configStore = configStoreStorage.emplace();
+    bool configStoreOpen = configStore->begin();
+    if (!configStoreOpen) {
+        Serial.println(F("ERROR: NVS config store unavailable - using LittleFS files"));
+    }
 
     // Mount LittleFS
     if (!fileSystem->mount()) {
         Serial.println(F("ERROR: Failed to mount LittleFS"));
-        // Try to format and remount
-        Serial.println(F("Attempting to format LittleFS..."));
-        // Note: LittleFS.format() would be called inside LittleFSAdapter if mount fails
-        delay(5000);
-        ESP.restart();
+        if (!configStoreOpen) {
+            // Neither storage: nothing to connect with
+            Serial.println(F("Attempting to format LittleFS..."));
+            // Note: LittleFS.format() would be called inside LittleFSAdapter if mount fails
+            delay(5000);
+            ESP.restart();
+        }
+        // The configuration is in NVS: run without files (built-in routes, no polar)
+    } else {
+        Serial.println(F("LittleFS mounted successfully"));
     }
-    Serial.println(F("LittleFS mounted successfully"));
+    GetBootTimeline().mark("littlefs", millis());
 
     // Create WiFiManager with HAL dependencies
-    wifiManager = new WiFiManager(wifiAdapter, fileSystem, &logger, &timeoutManager);
+    IConfigStore* recordStore = configStoreOpen ? configStore : nullptr;
+    wifiManager = wifiManagerStorage.emplace(wifiAdapter, fileSystem, &logger, &timeoutManager, recordStore);
 
     // T038: Initialize BoatData components
     Serial.println(F("Initializing BoatData system..."));
-    sourcePrioritizer = new SourcePrioritizer();
-    boatData = new BoatData(sourcePrioritizer);
-    calculationEngine = new CalculationEngine();
-    calibrationManager = new CalibrationManager();
+    sourcePrioritizer = sourcePrioritizerStorage.emplace();
+    boatData = boatDataStorage.emplace(sourcePrioritizer);
+    sourcesWebServer = sourcesWebServerStorage.emplace(sourcePrioritizer, boatData);
+    boatDataApiWebServer = boatDataApiWebServerStorage.emplace(boatData);
+    calculationEngine = calculationEngineStorage.emplace();
+    calibrationManager = calibrationManagerStorage.emplace(recordStore);
 
     // Load calibration parameters from flash
     if (calibrationManager->loadFromFlash()) {
         CalibrationParameters calib = calibrationManager->getCalibration();
-
-        // Convert to CalibrationData for BoatData
-        CalibrationData boatCalib;
-        boatCalib.leewayCalibrationFactor = calib.leewayCalibrationFactor;
-        boatCalib.windAngleOffset = calib.windAngleOffset;
-        boatCalib.loaded = true;
-
-        boatData->setCalibration(boatCalib);
-        Serial.printf("Calibration loaded: K=%.2f, offset=%.3f deg\n",
+        CalibrationWebServer::applyToBoatData(calib, boatData);
+        Serial.printf("Calibration loaded (%s): K=%.2f, offset=%.3f deg\n", calibrationManager->getLoadSource(),
             calib.leewayCalibrationFactor, calib.windAngleOffset * RAD_TO_DEG);
     } else {
         Serial.println(F("No calibration found - using defaults"));
     }
+    ConfigRecordStatus calibrationRecord = calibrationManager->getRecordStatus();
+    if (recordStore != nullptr && calibrationRecord != ConfigRecordStatus::OK &&
+        calibrationRecord != ConfigRecordStatus::EMPTY) {
+        logger.broadcastLogf(LogLevel::WARN, LogComponent::PERSISTENCE, LogEvent::CONFIG_INVALID,
+            "{\"record\":\"calibration\",\"status\":\"%s\",\"source\":\"%s\"}",
+            ConfigRecordStatusName(calibrationRecord), calibrationManager->getLoadSource());
+    }
+
+#if TRIP_COUNTERS_ENABLED
+    // Trip counters: restored from their NVS record, committed through the write-behind table
+    if (recordStore != nullptr) {
+        uint8_t record[CONFIG_RECORD_MAX_BYTES];
+        size_t length = recordStore->read(TRIP_RECORD_KEY, record, sizeof(record));
+        ConfigRecordStatus tripRecord = tripCounters.decodeRecord(record, length);
+        if (tripRecord != ConfigRecordStatus::OK && tripRecord != ConfigRecordStatus::EMPTY) {
+            logger.broadcastLogf(LogLevel::WARN, LogComponent::PERSISTENCE, LogEvent::CONFIG_INVALID,
+                "{\"record\":\"trip\",\"status\":\"%s\",\"source\":\"zero\"}",
+                ConfigRecordStatusName(tripRecord));
+        }
+        tripCountersEntry = GetWriteBehind().add("trip_counters", [](void* context) {
+            uint8_t out[CONFIG_RECORD_MAX_BYTES];
+            size_t written = tripCounters.encodeRecord(out, sizeof(out));
+            if (written == 0 || !static_cast<IConfigStore*>(context)->write(TRIP_RECORD_KEY, out, written)) {
+                return false;
+            }
+            tripCounters.committed(millis());
+            return true;
+        }, recordStore);
+        tripCountersWebServer = tripCountersWebServerStorage.emplace(&tripCounters);
+    }
+#endif
+
+#if WIFI_PROFILE_ENABLED
+    // Wi-Fi power profile: the stored selection, else WIFI_PROFILE_DEFAULT
+    wifiProfileManager.begin(&logger);
+    if (recordStore != nullptr) {
+        uint8_t record[CONFIG_RECORD_MAX_BYTES];
+        size_t length = recordStore->read(WIFI_PROFILE_RECORD_KEY, record, sizeof(record));
+        ConfigRecordStatus profileRecord = wifiProfileManager.getSelector().decodeRecord(record, length);
+        if (profileRecord != ConfigRecordStatus::OK && profileRecord != ConfigRecordStatus::EMPTY) {
+            logger.broadcastLogf(LogLevel::WARN, LogComponent::PERSISTENCE, LogEvent::CONFIG_INVALID,
+                "{\"record\":\"wifi_profile\",\"status\":\"%s\",\"source\":\"default\"}",
+                ConfigRecordStatusName(profileRecord));
+        }
+        wifiProfileEntry = GetWriteBehind().add("wifi_profile", [](void* context) {
+            uint8_t out[CONFIG_RECORD_MAX_BYTES];
+            size_t written = wifiProfileManager.getSelector().encodeRecord(out, sizeof(out));
+            return written != 0 && static_cast<IConfigStore*>(context)->write(WIFI_PROFILE_RECORD_KEY, out, written);
+        }, recordStore);
+    }
+    applyWiFiProfileRates();
+#endif
+
+    // Read-only tables partition (partitions.csv, tools/data_tables.py), read in place
+    if (dataPartition.map()) {
+        DataTablesStatus tablesStatus = dataTables.open(dataPartition.data(), dataPartition.size());
+        if (tablesStatus == DataTablesStatus::OK) {
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::DATA_TABLES, LogEvent::CONFIG_LOADED,
+                "{\"partition\":\"%s\",\"tables\":%u,\"bytes\":%lu}", DATA_TABLES_PARTITION,
+                (unsigned)dataTables.count(), (unsigned long)dataTables.getImageBytes());
+        } else if (tablesStatus != DataTablesStatus::EMPTY) {
+            logger.broadcastLogf(LogLevel::WARN, LogComponent::DATA_TABLES, LogEvent::CONFIG_INVALID,
+                "{\"partition\":\"%s\",\"status\":\"%s\"}", DATA_TABLES_PARTITION,
+                DataTablesStatusName(tablesStatus));
+        }
+    }
+
+    // Boat polar: the partition's table, else the optional /polar.pol; without either the
+    // polar targets stay NaN
+    bool polarLoaded = false;
+    DataTableView table;
+    if (dataTables.find(DataTableType::POLAR, table)) {
+        polarLoaded = table.version == POLAR_TABLE_VERSION && polarTable.loadBinary(table.data, table.length);
+        if (polarLoaded) {
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::POLAR, LogEvent::POLAR_LOADED,
+                "{\"path\":\"%s\",\"tws\":%u,\"twa\":%u}", DATA_TABLES_PARTITION,
+                (unsigned)polarTable.twsCount(), (unsigned)polarTable.twaCount());
+        } else {
+            logger.broadcastLogf(LogLevel::ERROR, LogComponent::POLAR, LogEvent::POLAR_INVALID,
+                "{\"path\":\"%s\",\"version\":%u,\"reason\":\"%s\"}", DATA_TABLES_PARTITION,
+                (unsigned)table.version, table.version == POLAR_TABLE_VERSION ? polarTable.error() : "unsupported version");
+            polarTable.clear();
+        }
+    }
+    if (!polarLoaded) {
+        polarLoaded = PolarConfig::load(POLAR_FILE, polarTable, &logger);
+    }
+    if (polarLoaded) {
+        calculationEngine->setPolar(&polarTable);
+        navigationEngine.setPolar(&polarTable);
+    }
+    if (dataTables.find(DataTableType::VARIATION, table) && !variationGrid.attach(table)) {
+        logger.broadcastLogf(LogLevel::WARN, LogComponent::DATA_TABLES, LogEvent::CONFIG_INVALID,
+            "{\"table\":\"variation\",\"version\":%u,\"bytes\":%lu}",
+            (unsigned)table.version, (unsigned long)table.length);
+    }
+    navigationWebServer = navigationWebServerStorage.emplace(&navigationEngine);
+    calcTimingWebServer = calcTimingWebServerStorage.emplace(&calculationTiming, boatData);
+
+#if CALC_BENCHMARK_ENABLED
+    // GET /calc/benchmark - calculation cycle benchmark (env:esp32dev_bench)
+    calcBenchmarkWebServer = calcBenchmarkWebServerStorage.emplace(polarTable.loaded() ? &polarTable : nullptr);
+#endif
 
     // T039: Initialize calibration web server
-    calibrationWebServer = new CalibrationWebServer(calibrationManager, boatData);
+    calibrationWebServer = calibrationWebServerStorage.emplace(calibrationManager, boatData);
+#if CALIB_LEARN_ENABLED
+    calibrationWebServer->setLearner(&calibrationLearner);
+#endif
+    n2kStatsWebServer = n2kStatsWebServerStorage.emplace(&GetN2kPGNStats(), &GetN2kFastPacketMonitor());
 
     Serial.println(F("BoatData system initialized"));
+    GetBootTimeline().mark("boatdata", millis());
+
+    // T028: NMEA2000 CAN bus initialization (needs BoatData, before WiFi and ReactESP loops)
+    initNmea2000Bus(recordStore);
+    GetBootTimeline().mark("nmea2000", millis());
 
     // T045: WiFi initialization sequence
     Serial.println(F("Loading WiFi configuration..."));
+
+    // Register WiFi event handlers using Arduino's WiFi library directly
+    // (also without a configuration: one uploaded through the SoftAP is
+    // applied without a reboot)
+    WiFi.onEvent([](WiFiEvent_t event, WiFiEventInfo_t info) {
+        if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
+            onWiFiConnected();
+        } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
+            onWiFiDisconnected();
+        }
+    });
+
     if (!wifiManager->loadConfig(wifiConfig)) {
         Serial.println(F("ERROR: No valid WiFi configuration found"));
-        logger.logConfigEvent(ConnectionEvent::CONFIG_LOADED, false, 0, F("File not found or invalid"));
+        logger.logConfigEvent(ConnectionEvent::CONFIG_LOADED, false, 0, "File not found or invalid");
 
+#if WIFI_AP_FALLBACK_ENABLED
+        // No config available - the loop starts the access point, wifi.conf
+        // can be uploaded through it (POST /upload-wifi-config)
+        connectionState.status = ConnectionStatus::DISCONNECTED;
+#else
         // No config available - enter fail-safe mode (reboot loop until config uploaded)
         scheduleReboot(REBOOT_DELAY_MS, F("No WiFi configuration"));
+#endif
     } else {
         Serial.printf("WiFi config loaded: %d networks\n", wifiConfig.count);
         logger.logConfigEvent(ConnectionEvent::CONFIG_LOADED, true, wifiConfig.count);
+        Serial.printf("WiFi cache: %u access points (directed reconnect)\n",
+                      (unsigned)wifiManager->loadConnectCache());
 
         // Initialize connection state
         connectionState.status = ConnectionStatus::DISCONNECTED;
         connectionState.currentNetworkIndex = 0;
         connectionState.retryCount = 0;
 
-        // Register WiFi event handlers using Arduino's WiFi library directly
-        WiFi.onEvent([](WiFiEvent_t event, WiFiEventInfo_t info) {
-            if (event == ARDUINO_EVENT_WIFI_STA_GOT_IP) {
-                onWiFiConnected();
-            } else if (event == ARDUINO_EVENT_WIFI_STA_DISCONNECTED) {
-                onWiFiDisconnected();
-            }
-        });
-
         // Attempt first network connection
         Serial.println(F("Attempting WiFi connection..."));
         wifiManager->connect(connectionState, wifiConfig);
     }
+    GetBootTimeline().mark("wifi", millis());
 
-    // T027: OLED Display initialization (after WiFi, before NMEA)
-    Serial.println(F("Initializing OLED display..."));
-    displayAdapter = new ESP32DisplayAdapter();
-    systemMetrics = new ESP32SystemMetrics();
-    displayManager = new DisplayManager(displayAdapter, systemMetrics, &logger);
+    systemMetrics = systemMetricsStorage.emplace();
+    systemMetrics->begin();  // Idle hooks on both cores (CPU idle %)
 
-    if (displayManager->init()) {
-        Serial.println(F("OLED display initialized successfully"));
-        logger.broadcastLog(LogLevel::INFO, "Main", "DISPLAY_INIT_SUCCESS",
-                            F("{\"device\":\"SSD1306\",\"resolution\":\"128x64\"}"));
-    } else {
-        Serial.println(F("WARNING: OLED display initialization failed"));
-        logger.broadcastLog(LogLevel::ERROR, "Main", "DISPLAY_INIT_FAILED",
-                            F("{\"reason\":\"I2C communication error - continuing without display\"}"));
-        // Graceful degradation: Continue operation without display (FR-027)
-    }
+#if POSEIDON_FEATURE_DISPLAY
+    // T027: OLED Display (after WiFi, before NMEA). The panel init (I2C, first
+    // frame) runs on the first loop pass; until then every display call is a no-op.
+    displayAdapter = displayAdapterStorage.emplace();
+    displayManager = displayManagerStorage.emplace(displayAdapter, &telemetrySystemMetrics, &logger);
+#if DISPLAY_BUTTON_PIN >= 0
+    pinMode(DISPLAY_BUTTON_PIN, INPUT_PULLUP);
+#endif
+
+    app.onDelay(0, []() {
+        uint32_t start = millis();
+        if (nmea2000 != nullptr) {
+            displayManager->setBusMonitor(&nmea2000->getBusMonitor());  // Status page line 3
+        }
+        if (displayManager->init()) {
+            Serial.println(F("OLED display initialized successfully"));
+            taskMonitor.add("oled", displayAdapter->getTaskHandle(), OLED_FLUSH_TASK_STACK, OLED_FLUSH_TASK_CORE);
+            logger.broadcastLog(LogLevel::INFO, LogComponent::MAIN, LogEvent::DISPLAY_INIT_SUCCESS,
+                                F("{\"device\":\"SSD1306\",\"resolution\":\"128x64\"}"));
+        } else {
+            Serial.println(F("WARNING: OLED display initialization failed"));
+            logger.broadcastLog(LogLevel::ERROR, LogComponent::MAIN, LogEvent::DISPLAY_INIT_FAILED,
+                                F("{\"reason\":\"I2C communication error - continuing without display\"}"));
+            // Graceful degradation: Continue operation without display (FR-027)
+        }
+        GetBootTimeline().record("oled_init", start, millis());
+    });
+    GetBootTimeline().mark("display", millis());
+#endif
+
+#if IMU_ENABLED
+    // Onboard IMU: probed on the first loop pass, after the panel init has started
+    // the shared bus. Drained every IMU_READ_INTERVAL_MS, one burst per batch.
+    imuSource = imuSourceStorage.emplace(&imu, boatData);
+    app.onDelay(0, []() {
+        if (imuDevice.begin(OLED_SDA_PIN, OLED_SCL_PIN, OLED_I2C_CLOCK) && imuSource->begin()) {
+            logger.broadcastLogf(LogLevel::INFO, LogComponent::IMU, LogEvent::INIT_SUCCESS,
+                                 "{\"device\":\"ICM-20948\",\"rate_hz\":%.1f}", imu.getSampleRateHz());
+        } else {
+            logger.broadcastLog(LogLevel::WARN, LogComponent::IMU, LogEvent::INIT_FAILED,
+                                F("{\"reason\":\"No ICM-20948 on the I2C bus - heel from NMEA 2000 only\"}"));
+        }
+    });
+    onRepeatProfiled("imu", IMU_READ_INTERVAL_MS, []() {
+        imuSource->poll();
+    }, ReactionClass::REALTIME_IO);
+#endif
 
+#if POSEIDON_FEATURE_NMEA0183
     // T036: NMEA0183 Handler initialization (after display, before ReactESP loops)
     Serial.println(F("Initializing NMEA0183 handler..."));
     // Initialize Serial2 with explicit GPIO pins: RX=25, TX=27 (SH-ESP32 board)
-    serial0183 = new ESP32SerialPort(&Serial2, 25, 27);
-    nmea0183 = new tNMEA0183();
-    nmea0183Handler = new NMEA0183Handler(nmea0183, serial0183, boatData, &logger);
+#if NMEA0183_UART_EVENT_MODE
+    serial0183 = serial0183Storage.emplace(UART_NUM_2, 25, 27);
+#else
+    serial0183 = serial0183Storage.emplace(&Serial2, 25, 27);
+#endif
+    nmea0183Handler = nmea0183HandlerStorage.emplace(serial0183, boatData, &logger);
+
+#if NMEA0183_PORT2_ENABLED
+    // Second NMEA 0183 input (e.g., standalone GPS) with its own baud rate, talkers and sources
+#if NMEA0183_UART_EVENT_MODE
+    serial0183Port2 = serial0183Port2Storage.emplace(UART_NUM_1, NMEA0183_PORT2_RX_PIN, NMEA0183_PORT2_TX_PIN);
+#else
+    serial0183Port2 = serial0183Port2Storage.emplace(&Serial1, NMEA0183_PORT2_RX_PIN, NMEA0183_PORT2_TX_PIN);
+#endif
+    NMEA0183PortConfig port2 = {serial0183Port2, NMEA0183_PORT2_BAUD, "Serial1",
+                                NMEA0183_PORT2_SOURCE_PREFIX,
+                                {{NMEA0183PackTalker(NMEA0183_PORT2_TALKER_A),
+                                  NMEA0183PackTalker(NMEA0183_PORT2_TALKER_B)}}};
+    nmea0183Handler->addPort(port2);
+#endif
+
+#if NMEA0183_NET_ENABLED
+    // Network input from a Wi-Fi multiplexer; sentences take the Serial2 parse/dispatch path
+    net0183Port = net0183PortStorage.emplace(static_cast<NetworkSentenceMode>(NMEA0183_NET_MODE),
+                                               NMEA0183_NET_PORT, NMEA0183_NET_HOST);
+    NMEA0183PortConfig netPort = {net0183Port, 0,
+                                  NMEA0183_NET_MODE == 0 ? "UDP" : "TCP",
+                                  NMEA0183_NET_SOURCE_PREFIX, {{0, 0}}};
+    nmea0183Handler->addPort(netPort);
+#endif
 
-    // Initialize Serial2 at 38400 baud for NMEA 0183
+    // T039: NMEA0183 sources ("<prefix>-<talker>" per port) register with
+    // BoatData's prioritizer on their first sentence (see BoatData::registerSource)
+
+    // Optional talker/sentence routing (/nmea0183-routes.json); without it the
+    // built-in AP/VH talkers apply. An upload interrupted by a reset is dropped.
+    LittleFS.remove(NMEA0183_ROUTES_FILE NMEA0183_ROUTES_UPLOAD_SUFFIX);
+    NMEA0183RouteConfig::load(NMEA0183_ROUTES_FILE, nmea0183Handler, &logger);
+
+    // POST /upload-nmea0183-routes and /config/reload swap the table in the main loop
+    GetConfigService().subscribe(ConfigDomain::NMEA0183_ROUTES, "nmea0183_routes", [](void* context, uint32_t version) {
+        (void)version;
+        bool valid = NMEA0183RouteConfig::reload(NMEA0183_ROUTES_FILE, NMEA0183_ROUTES_FILE NMEA0183_ROUTES_UPLOAD_SUFFIX,
+                                                 static_cast<NMEA0183Handler*>(context), &logger);
+        return valid ? ConfigApplyResult::APPLIED : ConfigApplyResult::REJECTED;
+    }, nmea0183Handler);
+
+    // Initialize Serial2 at 38400 baud for NMEA 0183 (plus any added ports)
     nmea0183Handler->init();
+#if AP_FORWARD_ENABLED
+    // Autopilot fast path: heading/rate of turn from the N2k receive context
+    // straight to the Serial2 TX line (GPIO 27), at the input's 38400 baud
+    GetAutopilotForward().attach(
+        [](void* port, const uint8_t* data, size_t size) {
+            return static_cast<ISerialPort*>(port)->writeNonBlocking(data, size);
+        },
+        serial0183,
+        []() { return static_cast<uint32_t>(micros()); },
+        []() { return nmea2000 != nullptr ? nmea2000->getFrameArrival() : static_cast<uint32_t>(micros()); });
+#endif
+#if AIS_ENABLED
+    nmea0183Handler->setAisTargets(&aisTargets);
+#endif
 
-    logger.broadcastLog(LogLevel::INFO, "NMEA0183", "INIT",
-                        "{\"port\":\"Serial2\",\"baud\":38400}");
+    nmea0183StatsWebServer = nmea0183StatsWebServerStorage.emplace(nmea0183Handler);
     Serial.println(F("NMEA0183 handler initialized"));
+    GetBootTimeline().mark("nmea0183", millis());
+#endif
 
-    // T039: Register NMEA0183 sources with BoatData prioritizer
-    sourcePrioritizer->registerSource("NMEA0183-AP", SensorType::COMPASS, ProtocolType::NMEA0183);
-    sourcePrioritizer->registerSource("NMEA0183-VH", SensorType::GPS, ProtocolType::NMEA0183);
-    Serial.println(F("NMEA0183 sources registered (AP=autopilot, VH=VHF)"));
-
+#if POSEIDON_FEATURE_ONEWIRE
     // T036: 1-Wire sensors initialization (after I2C, before NMEA)
     Serial.println(F("Initializing 1-Wire sensors..."));
-    oneWireSensors = new ESP32OneWireSensors(4);  // GPIO 4
+    oneWireSensors = oneWireSensorsStorage.emplace(4);  // GPIO 4
+
+    // Known ROMs and roles: verified by address at initialize() instead of a full search
+    if (recordStore != nullptr) {
+        uint8_t record[CONFIG_RECORD_MAX_BYTES];
+        size_t length = recordStore->read(ONEWIRE_MAP_RECORD_KEY, record, sizeof(record));
+        ConfigRecordStatus mapRecord = oneWireSensors->getDeviceMap().decodeRecord(record, length);
+        if (mapRecord != ConfigRecordStatus::OK && mapRecord != ConfigRecordStatus::EMPTY) {
+            logger.broadcastLogf(LogLevel::WARN, LogComponent::PERSISTENCE, LogEvent::CONFIG_INVALID,
+                "{\"record\":\"ow_map\",\"status\":\"%s\",\"source\":\"search\"}",
+                ConfigRecordStatusName(mapRecord));
+        }
+        oneWireMapEntry = GetWriteBehind().add("onewire_map", [](void* context) {
+            uint8_t out[CONFIG_RECORD_MAX_BYTES];
+            size_t written = oneWireSensors->getDeviceMap().encodeRecord(out, sizeof(out));
+            return written != 0 && static_cast<IConfigStore*>(context)->write(ONEWIRE_MAP_RECORD_KEY, out, written);
+        }, recordStore);
+        oneWireSensors->setMapChangedCallback([](void*) {
+            GetWriteBehind().markDirty(oneWireMapEntry, millis());
+        }, nullptr);
+    }
 
     if (false && oneWireSensors->initialize()) {
         Serial.println(F("1-Wire bus initialized successfully"));
-        logger.broadcastLog(LogLevel::INFO, "Main", "ONEWIRE_INIT_SUCCESS",
+        logger.broadcastLog(LogLevel::INFO, LogComponent::MAIN, LogEvent::ONEWIRE_INIT_SUCCESS,
                             F("{\"bus\":\"GPIO4\",\"sensors\":\"saildrive,battery,shore_power\"}"));
 
          // Initialize 1-Wire sensor poller
-        oneWirePoller = new OneWireSensorPoller(oneWireSensors, boatData, &logger);
-        logger.broadcastLog(LogLevel::INFO, "OneWire", "POLLING_STARTED",
-                                F("{\"intervals\":{\"saildrive_ms\":1000,\"battery_ms\":2000,\"shore_power_ms\":2000}}"));
+        oneWirePoller = oneWirePollerStorage.emplace(oneWireSensors, boatData, &logger);
+#if TRIP_COUNTERS_ENABLED && BATTERY_SOC_ENABLED
+        if (tripCountersEntry >= 0) {
+            oneWirePoller->setStateOfChargeSource(&tripCounters);   // Estimators fed by the "trip" reaction
+        }
+#endif
+        logger.broadcastLog(LogLevel::INFO, LogComponent::ONE_WIRE, LogEvent::POLLING_STARTED,
+                                F("{\"intervals\":{\"saildrive_ms\":1000,\"battery_ms\":2000,\"shore_power_ms\":2000},\"step_budget_us\":1000}"));
     } else {
         Serial.println(F("WARNING: 1-Wire bus initialization failed"));
-        logger.broadcastLog(LogLevel::WARN, "Main", "ONEWIRE_INIT_FAILED",
+        logger.broadcastLog(LogLevel::WARN, LogComponent::MAIN, LogEvent::ONEWIRE_INIT_FAILED,
                             F("{\"reason\":\"No devices found or bus error - continuing without 1-wire sensors\"}"));
         // Graceful degradation: Continue operation without 1-wire sensors
         oneWirePoller = nullptr;
     }
+    GetBootTimeline().mark("onewire", millis());
+#endif
 
-   
+#if STALL_WATCHDOG_ENABLED
+    // Every reaction below is watched in the main-loop slot
+    startStallWatchdog();
+#endif
 
-    // T028: NMEA2000 CAN bus initialization (after NMEA0183, before ReactESP loops)
-    Serial.println(F("Initializing NMEA2000 CAN bus..."));
+    // T046: ReactESP loop integration
+    // Periodic timeout check every 1 second
+    onRepeatProfiled("wifi_tmo", 1000, checkConnectionTimeout, ReactionClass::UI_NETWORK);
 
-    // Create NMEA2000 instance with ESP32 CAN driver
-    nmea2000 = new tNMEA2000_esp32((gpio_num_t)CAN_TX_PIN, (gpio_num_t)CAN_RX_PIN);
+    // Periodic reboot check every 500ms
+    onRepeatProfiled("reboot", 500, checkScheduledReboot, ReactionClass::UI_NETWORK);
 
-    // Set product information
-    nmea2000->SetProductInformation(
-        "00000001",                    // Serial number
-        100,                           // Product code
-        "Poseidon2 Gateway",          // Model ID
-        "1.0.0",                      // Software version
-        "1.0.0"                       // Model version
-    );
+    // Configuration files (log filter, calibration) written once their settings stop changing
+    onRepeatProfiled("persist", WRITE_BEHIND_INTERVAL_MS, []() {
+        WriteBehind& writeBehind = GetWriteBehind();
+        if (OtaFilesystemLocked()) {
+            return;  // Filesystem image being installed: changes stay dirty (NVS records are saved by the reboot flush)
+        }
+        if (!writeBehind.poll(millis())) {
+            logger.broadcastLogf(LogLevel::WARN, LogComponent::PERSISTENCE, LogEvent::CONFIG_SAVE_FAILED,
+                "{\"entry\":\"%s\",\"action\":\"retry in %u ms\"}",
+                writeBehind.getLastFailed(), (unsigned)WRITE_BEHIND_QUIET_MS);
+        }
+    }, ReactionClass::BACKGROUND);
 
-    // Set device information
-    nmea2000->SetDeviceInformation(
-        1,                            // Unique number (1-254)
-        130,                          // Device function: PC Gateway
-        25,                           // Device class: Network Device
-        2046                          // Manufacturer code: Self-assigned
-    );
+#if TRIP_COUNTERS_ENABLED
+    // Trip counters: O(1) integration per sample; the counters pick the commit time, write-behind writes
+    if (tripCountersEntry >= 0) {
+        onRepeatProfiled("trip", TRIP_SAMPLE_INTERVAL_MS, []() {
+            uint32_t now = millis();
+            tripCounters.sample(*boatData->getDataStructure(), now);
+            if (!GetWriteBehind().isDirty(tripCountersEntry) && tripCounters.commitDue(now)) {
+                GetWriteBehind().markDirty(tripCountersEntry, now);
+            }
+        }, ReactionClass::BACKGROUND);
+    }
+#endif
 
-    // Set mode to ListenAndNode (receive and transmit)
-    nmea2000->SetMode(tNMEA2000::N2km_ListenAndNode, 22);  // Node address 22
+    // Claimed source address: a lost claim (or a commanded address) is persisted for the next boot
+    if (n2kAddressEntry >= 0) {
+        onRepeatProfiled("n2k_addr", N2K_ADDRESS_CHECK_MS, []() {
+            if (nmea2000 != nullptr && nmea2000->ReadResetAddressChanged() &&
+                n2kAddressMemory.claimed(nmea2000->GetN2kSource())) {
+                GetWriteBehind().markDirty(n2kAddressEntry, millis());
+            }
+        }, ReactionClass::BACKGROUND);
+    }
 
-    // Disable forwarding to PC (we're the gateway)
-    nmea2000->EnableForward(false);
+    // Published configuration (uploads, /config/reload) applied live by its subscribers
+    onRepeatProfiled("config", CONFIG_SERVICE_INTERVAL_MS, []() {
+        ConfigService& configService = GetConfigService();
+        if (configService.poll() > 0) {
+            logger.broadcastLogf(LogLevel::WARN, LogComponent::MAIN, LogEvent::CONFIG_REJECTED,
+                "{\"subscriber\":\"%s\",\"action\":\"running configuration kept\"}",
+                configService.getLastRejected());
+        }
+#if WIFI_PROFILE_ENABLED
+        // Profile switch requested over HTTP: radio, stream rates, then the stored selection
+        if (wifiProfileManager.poll(millis())) {
+            applyWiFiProfileRates();
+            if (wifiProfileEntry >= 0) {
+                GetWriteBehind().markDirty(wifiProfileEntry, millis());
+            }
+        }
+#endif
+    }, ReactionClass::UI_NETWORK);
 
-    // Open CAN bus
-    if (nmea2000->Open()) {
-        Serial.println(F("NMEA2000 CAN bus initialized successfully"));
-        logger.broadcastLog(LogLevel::INFO, "NMEA2000", "INIT_SUCCESS",
-                            F("{\"can_tx\":32,\"can_rx\":34,\"baud\":250000}"));
-    } else {
-        Serial.println(F("WARNING: NMEA2000 CAN bus initialization failed"));
-        logger.broadcastLog(LogLevel::ERROR, "NMEA2000", "INIT_FAILED",
-                            F("{\"reason\":\"CAN bus open failed - check wiring and terminators\"}"));
-        // Graceful degradation: Continue operation without NMEA2000
+    // WebSocket log queue drain - handlers only enqueue, sends happen here
+    onRepeatProfiled("log_drain", LOG_DRAIN_INTERVAL_MS, []() {
+        logger.drain();
+    }, ReactionClass::UI_NETWORK);
+
+    // Periodic keep-alive broadcast every 5 seconds
+    onRepeatProfiled("keepalive", 5000, broadcastKeepAlive, ReactionClass::UI_NETWORK);
+
+    // BoatData change notifications (coalesced per subscriber), then the outputs due after this batch
+    onRepeatProfiled("bd_notify", BOATDATA_DISPATCH_INTERVAL_MS, []() {
+        uint32_t now = millis();
+        boatData->dispatchChanges(now);
+        outputPipeline.run(*boatData->getDataStructure(), boatData->getChanges(), now);
+    }, ReactionClass::CALCULATION);
+
+    // Groups not updated within BOATDATA_STALE_<GROUP>_MS become unavailable
+    onRepeatProfiled("bd_stale", BOATDATA_STALE_SWEEP_MS, []() {
+        uint16_t expired = boatData->sweepStale(millis());
+        if (expired != 0) {
+            logger.broadcastLogf(LogLevel::WARN, LogComponent::BOAT_DATA, LogEvent::DATA_STALE,
+                "{\"groups\":\"0x%04X\"}", (unsigned)expired);
+        }
+    }, ReactionClass::CALCULATION);
+
+    // T038: Calculation cycle on input changes, between CALC_MAX_INTERVAL_MS and CALC_MIN_INTERVAL_MS apart
+    calculationSubscription = boatData->subscribe(
+        BoatDataGroup::GPS | BoatDataGroup::COMPASS | BoatDataGroup::WIND |
+        BoatDataGroup::DST | BoatDataGroup::CALIBRATION,
+        CALC_MIN_INTERVAL_MS, calculateDerivedParameters, nullptr, CALC_MAX_INTERVAL_MS);
+
+    // Calculation timing: WARN when cycles overran CALC_DEADLINE_US since the last report
+    onRepeatProfiled("calc_st", CALC_TIMING_STATS_INTERVAL_MS, []() {
+        static uint32_t reportedMisses = 0;
+        uint32_t misses = calculationTiming.getDeadlineMisses();
+        if (misses < reportedMisses) {
+            reportedMisses = 0;  // Statistics were reset (GET /calc/stats?reset=1)
+        }
+        StaticJsonWriter<768> json;
+        calculationTiming.writeStats(json);
+        logger.broadcastLog(misses > reportedMisses ? LogLevel::WARN : LogLevel::DEBUG,
+                            LogComponent::CALCULATION_ENGINE, LogEvent::CALC_TIMING, json.c_str());
+        reportedMisses = misses;
+    }, ReactionClass::BACKGROUND);
+
+    // Navigation stage on derived/GPS changes, between NAV_MAX_INTERVAL_MS and NAV_MIN_INTERVAL_MS apart
+    navigationSubscription = boatData->subscribe(BoatDataGroup::DERIVED | BoatDataGroup::GPS,
+        NAV_MIN_INTERVAL_MS, updateNavigation, nullptr, NAV_MAX_INTERVAL_MS);
+#if WIFI_PROFILE_ENABLED
+    applyWiFiProfileIntervals();  // A stored anchor profile slows both stages from boot
+#endif
+
+#if ENGINE_JOURNAL_ENABLED
+    // Engine journal: ring file continued from its newest record, written through the write-behind table
+    {
+        bool utc = false;
+        uint32_t time = engineJournalTime(utc);
+        if (engineJournal.begin(time, utc)) {
+            engineJournalEntry = GetWriteBehind().add("engine_journal", [](void* context) {
+                return static_cast<EngineJournalStore*>(context)->save();
+            }, &engineJournal);
+            GetWriteBehind().markDirty(engineJournalEntry, millis());  // Boot record
+            engineJournalSubscription = boatData->subscribe(BoatDataGroup::ENGINE | BoatDataGroup::SAILDRIVE,
+                ENGINE_JOURNAL_MIN_INTERVAL_MS, onEngineJournalInputs, &engineJournal);
+        } else {
+            logger.broadcastLog(LogLevel::WARN, LogComponent::PERSISTENCE, LogEvent::CONFIG_SAVE_FAILED,
+                F("{\"entry\":\"engine_journal\",\"action\":\"journal off\"}"));
+        }
     }
+#endif
 
-    // T029: Register NMEA2000 message handlers
-    if (nmea2000 != nullptr) {
-        RegisterN2kHandlers(nmea2000, boatData, &logger);
-        Serial.println(F("NMEA2000 handlers registered - processing 13 PGNs"));
+#if ALARM_ENABLED
+    // Alarm rules (/alarms.conf, built-in rules without it); an upload interrupted by a reset is dropped
+    LittleFS.remove(ALARM_RULES_FILE ALARM_RULES_UPLOAD_SUFFIX);
+    AlarmRuleConfig::load(ALARM_RULES_FILE, &alarmEngine, &logger);
+
+    // POST /alarms/rules and /config/reload swap the rule table in the main loop
+    GetConfigService().subscribe(ConfigDomain::ALARMS, "alarms", [](void* context, uint32_t version) {
+        (void)version;
+        bool valid = AlarmRuleConfig::reload(ALARM_RULES_FILE, ALARM_RULES_FILE ALARM_RULES_UPLOAD_SUFFIX,
+                                             static_cast<AlarmEngine*>(context), &logger);
+        return valid ? ConfigApplyResult::APPLIED : ConfigApplyResult::REJECTED;
+    }, &alarmEngine);
+
+    // Own subscription: every alarm input at its own rate, whatever the Wi-Fi profile did to
+    // the calculation and navigation stages; the heartbeat runs the delay timers
+    alarmSubscription = boatData->subscribe(AlarmEngine::allInputGroups(),
+        ALARM_MIN_INTERVAL_MS, onAlarmInputs, &alarmEngine, ALARM_HEARTBEAT_MS);
+
+#if N2K_TX_ENABLED
+    // Active alarms repeated as PGN 126983 (transitions are sent at once)
+    onRepeatProfiled("alarm_n2k", ALARM_N2K_REPEAT_MS, []() {
+        for (uint8_t i = 0; i < alarmEngine.getRuleCount(); i++) {
+            if (alarmEngine.getRule(i).state == AlarmState::ACTIVE) {
+                sendAlarmAlert(i);
+            }
+        }
+    }, ReactionClass::BACKGROUND);
+#endif
+#endif
+
+    // Variation from the tables partition's grid while the GPS sends position but no variation
+    if (variationGrid.isAttached()) {
+        onRepeatProfiled("var_grid", VARIATION_GRID_INTERVAL_MS, []() {
+            double variation;
+            if (variationGrid.fallback(boatData->getGPSData(), millis(), variation)) {
+                GPSData patch = boatData->getGPSData();
+                patch.variation = variation;
+                boatData->patchGPS(GPSField::VARIATION, patch);
+            }
+        }, ReactionClass::BACKGROUND);
     }
 
-    // T030: Register NMEA2000 sources with BoatData prioritizer
-    // Note: Currently only GPS and COMPASS sensor types are supported in SourcePrioritizer
-    // DST, ENGINE, and WIND data are updated directly without multi-source prioritization
-    sourcePrioritizer->registerSource("NMEA2000-GPS", SensorType::GPS, ProtocolType::NMEA2000);
-    sourcePrioritizer->registerSource("NMEA2000-COMPASS", SensorType::COMPASS, ProtocolType::NMEA2000);
-    Serial.println(F("NMEA2000 sources registered (GPS, COMPASS)"));
+    // UTC from PGN 126992 / RMC onto the millis() timeline (log, snapshot and capture stamps)
+    onRepeatProfiled("utc", UTC_CLOCK_UPDATE_INTERVAL_MS, updateUtcClock, ReactionClass::BACKGROUND);
 
-    // T046: ReactESP loop integration
-    // Periodic timeout check every 1 second
-    app.onRepeat(1000, checkConnectionTimeout);
+#if CALIB_LEARN_ENABLED
+    // Wind offset / leeway K statistics over tacks (proposals at GET /api/calibration/learned)
+    onRepeatProfiled("calib_learn", CALIB_LEARN_INTERVAL_MS, updateCalibrationLearner, ReactionClass::BACKGROUND);
+#endif
 
-    // Periodic reboot check every 500ms
-    app.onRepeat(500, checkScheduledReboot);
+#if AIS_ENABLED
+    // AIS targets: N2k report drain, CPA/TCPA pass and the /ais risk stream
+    onRepeatProfiled("ais", AIS_EVALUATE_INTERVAL_MS, updateAis, ReactionClass::BACKGROUND);
+#endif
 
-    // Periodic keep-alive broadcast every 5 seconds
-    app.onRepeat(5000, broadcastKeepAlive);
+#if HISTORY_ENABLED
+    // Field history (storage allocated once, PSRAM when present)
+    if (historyRecorder.begin(&logger)) {
+        historyWebServer = historyWebServerStorage.emplace(&historyRecorder);
+        onRepeatProfiled("history", HISTORY_SAMPLE_INTERVAL_MS, []() {
+            historyRecorder.sample(*boatData->getDataStructure(), millis());
+        }, ReactionClass::CALCULATION);
+    }
+#endif
 
-    // T038: Calculation cycle every 200ms (5 Hz)
-    app.onRepeat(200, calculateDerivedParameters);
+#if POSEIDON_FEATURE_ONEWIRE
+    // T037-T039: 1-Wire sensors, as I/O pump sources
+    bool oneWireInTask = false;
+#if ONEWIRE_TASK_ENABLED
+    // TASK_LAYOUT 1: the reads run in their own task, the pump only applies them
+#if STALL_WATCHDOG_ENABLED
+    int8_t oneWireSlot = stallWatchdog.addSlot("onewire", STALL_TASK_TIMEOUT_MS);
+    oneWireTask.setStallWatchdog(&stallWatchdog, oneWireSlot);
+#endif
+    oneWireInTask = oneWirePoller != nullptr && oneWireTask.begin(oneWireSensors, oneWirePoller, &logger);
+#if STALL_WATCHDOG_ENABLED
+    stallWatchdog.setTask(static_cast<uint8_t>(oneWireSlot), oneWireTask.getTaskHandle(), ONEWIRE_TASK_CORE);
+#endif
+    if (oneWireInTask) {
+        ioPump.add("ow_apply", [](void*) {
+            oneWireTask.service();
+            return false;
+        }, nullptr, ONEWIRE_APPLY_INTERVAL_MS);
+    }
+#endif
+    if (!oneWireInTask && oneWirePoller != nullptr) {
+        // T037-T039: one conversion cycle, ~1 ms of bus time per pump tick
+        ioPump.add("ow_conv", [](void* ctx) {
+            return static_cast<OneWireSensorPoller*>(ctx)->pollConversion();
+        }, oneWirePoller, 0);
+    }
+    if (oneWirePoller != nullptr) {
+        // Bus schedule health: utilization, CRC-error rate, per-device latency
+        onRepeatProfiled("ow_st", ONEWIRE_STATS_INTERVAL_MS, []() {
+            OneWireConversion& conversion = oneWireSensors->getConversion();
+            StaticJsonWriter<640> json;  // ~120 bytes per device
+            conversion.writeStats(json, millis());
+            logger.broadcastLog(conversion.isHealthy(millis()) ? LogLevel::INFO : LogLevel::WARN,
+                                LogComponent::ONE_WIRE, LogEvent::ONEWIRE_STATS, json.c_str());
+            conversion.requestStatsReset();
+        }, ReactionClass::BACKGROUND);
+    }
+#endif
 
-    // T037-T039: 1-Wire sensor polling loops
-    // T037: Saildrive polling (1000ms = 1 Hz)
-    app.onRepeat(1000, [&]() {
-        if (oneWirePoller != nullptr) {
-            oneWirePoller->pollSaildriveData();
-        }
-    });
+#if POSEIDON_FEATURE_NMEA0183
+    // T037: NMEA0183 sentences, a few lines per port per step
+    ioPump.add("n0183", [](void* ctx) {
+        return static_cast<NMEA0183Handler*>(ctx)->pumpSentences(IO_PUMP_N0183_LINES);
+    }, nmea0183Handler);
 
-    // T038: Battery polling (2000ms = 0.5 Hz)
-    app.onRepeat(2000, [&]() {
-        if (oneWirePoller != nullptr) {
-            oneWirePoller->pollBatteryData();
+    onRepeatProfiled("n0183_st", NMEA0183_UART_STATS_INTERVAL_MS, []() {
+        if (nmea0183Handler != nullptr) {
+            nmea0183Handler->logStats();
         }
-    });
+    }, ReactionClass::BACKGROUND);
+#endif
 
-    // T039: Shore power polling (2000ms = 0.5 Hz)
-    app.onRepeat(2000, [&]() {
-        if (oneWirePoller != nullptr) {
-            oneWirePoller->pollShorePowerData();
+    // NMEA2000 receive: main-loop polling or pinned task (N2K_RX_MODE)
+#if STALL_WATCHDOG_ENABLED
+    int8_t n2kSlot = -1;
+    if (N2K_RX_MODE != 0) {
+        n2kSlot = stallWatchdog.addSlot("n2k_rx", STALL_TASK_TIMEOUT_MS);
+        n2kReceiveTask.setStallWatchdog(&stallWatchdog, n2kSlot);
+    }
+#endif
+    if (nmea2000 != nullptr &&
+        n2kReceiveTask.begin(nmea2000, boatData, &logger, static_cast<N2kReceiveMode>(N2K_RX_MODE))) {
+#if STALL_WATCHDOG_ENABLED
+        if (n2kSlot >= 0) {
+            stallWatchdog.setTask(static_cast<uint8_t>(n2kSlot), n2kReceiveTask.getTaskHandle(), N2K_RX_TASK_CORE);
         }
-    });
+#endif
+        // Main-loop mode: one parse pass per step. Task modes: a batch of queued updates.
+        ioPump.add("n2k", [](void*) {
+            return n2kReceiveTask.service(IO_PUMP_N2K_PATCHES);
+        }, nullptr);
 
-    // T037: NMEA0183 sentence processing every 10ms
-    app.onRepeat(10, []() {
-        if (nmea0183Handler != nullptr) {
-            nmea0183Handler->processSentences();
+        onRepeatProfiled("n2k_rx_st", N2K_RX_STATS_INTERVAL_MS, []() {
+            n2kReceiveTask.logStats();
+        }, ReactionClass::BACKGROUND);
+
+#if N2K_TX_ENABLED
+        // Derived-data transmits: built here, sent by the receive context
+        onRepeatProfiled("n2k_tx", N2K_TX_SCHEDULE_INTERVAL_MS, []() {
+            if (boatData != nullptr) {
+                n2kTransmitScheduler.schedule(*boatData->getDataStructure(), millis());
+            }
+        }, ReactionClass::REALTIME_IO);
+
+        onRepeatProfiled("n2k_tx_st", N2K_TX_STATS_INTERVAL_MS, []() {
+            n2kTransmitScheduler.logStats(&logger, nmea2000->getTxQueueHighWater());
+        }, ReactionClass::BACKGROUND);
+#endif
+    }
+
+    // One reaction for all inputs: round-robin steps until drained or IO_PUMP_BUDGET_US is spent
+    onRepeatProfiled("io_pump", IO_PUMP_INTERVAL_MS, []() {
+        ioPump.run(millis(), IO_PUMP_BUDGET_US);
+    }, ReactionClass::REALTIME_IO);
+
+    onRepeatProfiled("pump_st", IO_PUMP_STATS_INTERVAL_MS, []() {
+        StaticJsonWriter<768> json;  // ~90 bytes per source
+        ioPump.writeStats(json);
+        logger.broadcastLog(LogLevel::INFO, LogComponent::IO_PUMP, LogEvent::IO_PUMP_STATS, json.c_str());
+        ioPump.clearStats();
+    }, ReactionClass::BACKGROUND);
+
+#if SCHED_ENABLED
+    // Background reactions wait while the pump leaves input behind
+    reactionScheduler.setPendingInputProbe([](void*) { return ioPump.hasPending(); }, nullptr);
+
+    onRepeatProfiled("sched_st", SCHED_STATS_INTERVAL_MS, []() {
+        StaticJsonWriter<1536> json;  // ~170 bytes per class, ~70 per flagged reaction
+        reactionScheduler.writeStats(json);
+        // WARN when a reaction keeps using up its class budget on its own
+        LogLevel level = reactionScheduler.getFlaggedCount() > 0 ? LogLevel::WARN : LogLevel::INFO;
+        logger.broadcastLog(level, LogComponent::SCHEDULER, LogEvent::SCHEDULER_STATS, json.c_str());
+        reactionScheduler.clearStats();
+    }, ReactionClass::BACKGROUND);
+#endif
+
+#if BUS_CAPTURE_ENABLED
+    // Raw bus capture (flash writes in their own task) and replay
+    if (busCapture.begin(&logger)) {
+#if POSEIDON_FEATURE_NMEA0183
+        nmea0183Handler->setLineObserver(BusCapture::observeLine, &busCapture);
+        busReplay.begin(nmea0183Handler, nmea2000, &logger);
+#else
+        busReplay.begin(nullptr, nmea2000, &logger);
+#endif
+        busCaptureWebServer = busCaptureWebServerStorage.emplace(&busCapture, &busReplay);
+#if PIPELINE_LATENCY_ENABLED
+        boatData->setWriteObserver(PipelineLatency::observeWrite, &pipelineLatency);
+        busCaptureWebServer->setPipelineLatency(&pipelineLatency);
+#endif
+
+        onRepeatProfiled("capture", BUS_CAPTURE_SERVICE_INTERVAL_MS, []() {
+            uint32_t now = millis();
+            busCapture.service(now);
+            busReplay.service(now);
+#if PIPELINE_LATENCY_ENABLED
+            // A replay is the benchmark input: measure for exactly its duration
+            if (busReplay.isActive() != pipelineLatency.isArmed()) {
+                if (busReplay.isActive()) {
+                    pipelineLatency.arm(micros());
+                } else {
+                    reportPipelineLatency();
+                }
+            }
+#endif
+        }, ReactionClass::REALTIME_IO);
+    }
+#endif
+
+#if N2K_LOAD_ENABLED
+    // Synthetic load into the CAN receive queue (throughput runs)
+    if (n2kLoadGenerator.begin(nmea2000, &logger)) {
+        n2kLoadWebServer = n2kLoadWebServerStorage.emplace(&n2kLoadGenerator);
+
+        onRepeatProfiled("n2k_load", N2K_LOAD_SERVICE_INTERVAL_MS, []() {
+            n2kLoadGenerator.service(millis(), systemMetrics != nullptr ? systemMetrics->getLoopFrequency() : 0);
+        }, ReactionClass::REALTIME_IO);
+    }
+#endif
+
+#if VOYAGE_LOG_ENABLED
+    // Voyage log (flash writes in their own task); the loop owns the BoatData structure
+    if (voyageRecorder.begin(&logger)) {
+        voyageRecorderWebServer = voyageRecorderWebServerStorage.emplace(&voyageRecorder);
+
+        outputPipeline.add("voyage", BoatDataGroup::ALL, VOYAGE_LOG_INTERVAL_MS, VOYAGE_LOG_INTERVAL_MS,
+            OutputEncoding::SNAPSHOT, [](void*, const OutputBatch& batch) {
+                voyageRecorder.sample(batch.snapshot(), batch.nowMs);
+            }, nullptr);
+    }
+#endif
+
+#if SOAK_ENABLED
+    // Soak run: keep the load going, one metric row per SOAK_SAMPLE_INTERVAL_MS
+    if (soakRecorder.begin(&logger)) {
+        soakWebServer = soakWebServerStorage.emplace(&soakRecorder);
+        soakLastSampleMs = millis();
+
+        onRepeatProfiled("soak", SOAK_SERVICE_INTERVAL_MS, []() {
+            serviceSoakLoad();
+            uint32_t now = millis();
+            if (now - soakLastSampleMs < SOAK_SAMPLE_INTERVAL_MS) {
+                return;
+            }
+            soakLastSampleMs = now;
+            SoakSample sample;
+            if (fillSoakSample(sample, now)) {
+                soakRecorder.record(sample);
+            }
+        }, ReactionClass::BACKGROUND);
+    }
+#endif
+
+    // Stack high-water marks of every task that started (TASK_STACKS)
+    taskMonitor.add("loop", xTaskGetCurrentTaskHandle(), CONFIG_ARDUINO_LOOP_STACK_SIZE, xPortGetCoreID());
+    taskMonitor.add("n2k_rx", n2kReceiveTask.getTaskHandle(), N2K_RX_TASK_STACK, N2K_RX_TASK_CORE);
+#if POSEIDON_FEATURE_NMEA0183 && NMEA0183_UART_EVENT_MODE
+    taskMonitor.add("n0183_rx", static_cast<ESP32UartEventPort*>(serial0183)->getTaskHandle(),
+                    NMEA0183_UART_TASK_STACK, NMEA0183_UART_TASK_CORE);
+#if NMEA0183_PORT2_ENABLED
+    taskMonitor.add("n0183_rx1", static_cast<ESP32UartEventPort*>(serial0183Port2)->getTaskHandle(),
+                    NMEA0183_UART_TASK_STACK, NMEA0183_UART_TASK_CORE);
+#endif
+#endif
+#if BUS_CAPTURE_ENABLED
+    taskMonitor.add("capture", busCapture.getTaskHandle(), BUS_CAPTURE_TASK_STACK, BUS_CAPTURE_TASK_CORE);
+#endif
+#if VOYAGE_LOG_ENABLED
+    taskMonitor.add("voyage", voyageRecorder.getTaskHandle(), VOYAGE_LOG_TASK_STACK, VOYAGE_LOG_TASK_CORE);
+#endif
+#if ONEWIRE_TASK_ENABLED
+    taskMonitor.add("onewire", oneWireTask.getTaskHandle(), ONEWIRE_TASK_STACK, ONEWIRE_TASK_CORE);
+#endif
+    logger.broadcastLogf(LogLevel::INFO, LogComponent::TASKS, LogEvent::TASK_LAYOUT_SELECTED,
+        "{\"layout\":%d,\"io_core\":%d,\"app_core\":%d,\"n2k_rx_mode\":%d,\"tasks\":%u}",
+        TASK_LAYOUT, TASK_IO_CORE, TASK_APP_CORE, N2K_RX_MODE, (unsigned)taskMonitor.getCount());
+
+    onRepeatProfiled("tasks", TASK_STATS_INTERVAL_MS, []() {
+        taskMonitor.logStats(&logger);
+    }, ReactionClass::BACKGROUND);
+
+    // Heap fragmentation: WARN once the largest free block falls behind the free heap
+    onRepeatProfiled("heap_st", HEAP_SAMPLE_INTERVAL_MS, []() {
+        if (systemMetrics == nullptr) {
+            return;
         }
-    });
+        HeapEvent event = systemMetrics->sampleHeap(millis());
+        const HeapMonitor& heap = systemMetrics->getHeapMonitor();
+        StaticJsonWriter<384> json;
+        heap.writeJson(json);
+        if (event == HeapEvent::FRAGMENTED) {
+            logger.broadcastLog(LogLevel::WARN, LogComponent::HEAP, LogEvent::HEAP_FRAGMENTED, json.c_str());
+        } else if (event == HeapEvent::RECOVERED) {
+            logger.broadcastLog(LogLevel::INFO, LogComponent::HEAP, LogEvent::HEAP_RECOVERED, json.c_str());
+        } else if (heap.getNewFailedAllocs() > 0) {
+            logger.broadcastLog(LogLevel::WARN, LogComponent::HEAP, LogEvent::HEAP_ALLOC_FAILED, json.c_str());
+        } else {
+            LOG_DEBUG(&logger, LogComponent::HEAP, LogEvent::HEAP_STATS, json.c_str());
+        }
+    }, ReactionClass::BACKGROUND);
 
-    logger.broadcastLog(LogLevel::DEBUG, "NMEA0183", "LOOP_REGISTERED",
-                        "{\"interval\":10}");
+    // Telemetry: run the sources, then publish rates, quantiles and the snapshot
+    registerTelemetrySources();
+    onRepeatProfiled("telemetry", TELEMETRY_INTERVAL_MS, []() {
+        telemetry.aggregate(millis());
+    }, ReactionClass::BACKGROUND);
 
-    // NMEA2000 message processing every 10ms
-    app.onRepeat(10, []() {
-        if (nmea2000 != nullptr) {
-            nmea2000->ParseMessages();
+#if N0183_TCP_ENABLED
+    // NMEA0183 TCP stream: rate-limited conversion + shared-buffer send
+    onRepeatProfiled("tcp_0183", N0183_TCP_SERVICE_INTERVAL_MS, []() {
+        if (boatData != nullptr) {
+            nmea0183TcpGateway.service(*boatData->getDataStructure(), millis());
         }
-    });
+    }, ReactionClass::REALTIME_IO);
+
+    onRepeatProfiled("tcp_st", N0183_TCP_STATS_INTERVAL_MS, []() {
+        nmea0183TcpGateway.logStats();
+    }, ReactionClass::BACKGROUND);
+#endif
+
+#if BOATDATA_UDP_ENABLED
+    // BoatData UDP publisher: one datagram per interval, whatever the number of listeners
+    udpOutputSink = outputPipeline.add("udp", BoatDataGroup::ALL, BOATDATA_UDP_INTERVAL_MS, BOATDATA_UDP_INTERVAL_MS,
+        OutputEncoding::SNAPSHOT, [](void*, const OutputBatch& batch) {
+            boatDataUdpPublisher.publish(batch.snapshot());
+        }, nullptr);
+#if WIFI_PROFILE_ENABLED
+    applyWiFiProfileOutputs();  // A stored profile's UDP rate from boot
+#endif
+
+    onRepeatProfiled("udp_st", BOATDATA_UDP_STATS_INTERVAL_MS, []() {
+        boatDataUdpPublisher.logStats();
+    }, ReactionClass::BACKGROUND);
+#endif
 
-    logger.broadcastLog(LogLevel::DEBUG, "NMEA2000", "LOOP_REGISTERED",
-                        "{\"interval\":10}");
+#if BOATDATA_REPLAY_ENABLED
+    // One snapshot per interval into the /boatdata?since= replay ring, with or without clients
+    outputPipeline.add("replay", BoatDataGroup::ALL, BOATDATA_REPLAY_INTERVAL_MS, BOATDATA_REPLAY_INTERVAL_MS,
+        OutputEncoding::SNAPSHOT, [](void*, const OutputBatch& batch) {
+            boatDataReplay.record(batch.snapshot());
+        }, nullptr);
+#endif
+
+#if WEB_STATS_ENABLED
+    // WebSocket message rates and send queue depths (GET /web/stats)
+    onRepeatProfiled("web_st", WEB_STATS_SAMPLE_MS, []() {
+        uint32_t now = millis();
+        sampleWebSocket(&wsBoatData, AdmissionEndpoint::BOATDATA, now);
+        sampleWebSocket(&wsSignalK, AdmissionEndpoint::SIGNALK, now);
+#if AIS_ENABLED
+        sampleWebSocket(&wsAis, AdmissionEndpoint::AIS, now);
+#endif
+        sampleWebSocket(logger.getWebSocket(), AdmissionEndpoint::LOGS, now);
+    }, ReactionClass::BACKGROUND);
+#endif
+
+#if WS_LIVENESS_ENABLED
+    // Evict the WebSocket clients that stopped answering, ping the others (also the
+    // per-profile /boatdata round trip, GET /wifi/profile)
+    onRepeatProfiled("ws_live", WS_PING_INTERVAL_MS, []() {
+        checkWebSocketLiveness(millis());
+    }, ReactionClass::BACKGROUND);
+#elif WIFI_PROFILE_ENABLED
+    // Round trip to the /boatdata clients, per Wi-Fi profile (GET /wifi/profile)
+    onRepeatProfiled("wifi_ping", WIFI_PROFILE_PING_INTERVAL_MS, []() {
+        wifiProfileManager.ping(wsBoatData, micros());
+    }, ReactionClass::BACKGROUND);
+#endif
+
+    // Feature 011: BoatData WebSocket broadcast loop; clients fall due at their subscribed rates
+    onRepeatProfiled("bd_stream", BOATDATA_STREAM_TICK_MS, []() {
+        static uint32_t tick = 0;
+        tick++;
+#if PIPELINE_LATENCY_ENABLED
+        if (pipelineLatency.isArmed()) {
+            updatePipelineOutputs();
+        }
+#endif
 
-    // Feature 011: BoatData WebSocket broadcast loop (1 Hz = 1000ms)
-    app.onRepeat(1000, []() {
         // Only broadcast if clients are connected (optimization)
-        if (wsBoatData.count() > 0 && boatData != nullptr) {
-            String json = BoatDataSerializer::toJSON(boatData);
+        if ((wsBoatData.count() == 0 && wsSignalK.count() == 0) || boatData == nullptr) {
+            return;
+        }
+
+        // Due clients grouped by payload; unchanged groups are skipped until the keepalive
+        const BoatDataChangeTracker& changes = boatData->getChanges();
+        uint32_t generation = changes.getGeneration();  // Before encoding: later writes stay dirty
+        unsigned long now = millis();
+        BoatDataStreamBucket buckets[BOATDATA_STREAM_MAX_CLIENTS];
+        uint8_t bucketCount = boatDataStreamClients.buckets(tick, now, changes, buckets);
+#if BOATDATA_REPLAY_ENABLED
+        sendBoatDataReplays();
+#endif
+
+        // Shared delta step at the default rate: one comparison feeds ?mode=delta and Signal K
+        BoatDataDeltaSet deltaSet;
+        bool deltaReady = false;
+        if (deltaSnapshot != nullptr && tick % boatDataStreamClients.getDefaultTicks() == 0 &&
+            (boatDataStreamClients.count(BoatDataStreamMode::DELTA) > 0 || wsSignalK.count() > 0)) {
+            // Keyframe for a newcomer, else the fields beyond their deadband
+            bool deltaJoined = boatDataStreamClients.takeDeltaJoined();
+            if (__atomic_exchange_n(&signalKClientJoined, false, __ATOMIC_ACQ_REL) || deltaJoined) {
+                boatDataDelta.requestKeyframe();
+            }
+            TRACE_SCOPE(TraceId::SERIALIZE, static_cast<uint32_t>(BoatDataStreamMode::DELTA));
+            deltaReady = BoatDataSerializer::updateDelta(boatData, boatDataDelta, *deltaSnapshot, deltaSet);
+        }
+
+        // One encode per bucket, shared by all of its clients
+        for (uint8_t b = 0; b < bucketCount; b++) {
+            const BoatDataStreamBucket& bucket = buckets[b];
+
+            if (bucket.mode == BoatDataStreamMode::BINARY) {
+                // The packed snapshot, no JSON at all
+                BoatDataSnapshot frame;
+                TRACE_BEGIN(TraceId::SERIALIZE, static_cast<uint32_t>(bucket.mode));
+                bool encoded = BoatDataSerializer::toBinary(boatData, frame, bucket.groups);
+                TRACE_END(TraceId::SERIALIZE);
+                if (!encoded) {
+                    continue;
+                }
+                AsyncWebSocketSharedBuffer pooled = pooledFrame(&frame, sizeof(frame));
+                if (!pooled) {
+                    continue;  // Pool exhausted (counted): the clients stay due
+                }
+                BoatDataStreamBucket delivered = bucket;
+                delivered.slots = 0;
+                TRACE_SCOPE(TraceId::WS_SEND, sizeof(frame));
+                for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+                    AsyncWebSocketClient* client = (bucket.slots & (1u << i)) ? boatDataReadyClient(i, now) : nullptr;
+                    if (client != nullptr) {
+                        client->binary(pooled);
+                        boatDataStreamClients.recordSent(i);
+                        delivered.slots = static_cast<uint16_t>(delivered.slots | (1u << i));
+                    }
+                }
+                GetWebTrafficStats().wsSent(AdmissionEndpoint::BOATDATA, sizeof(frame), __builtin_popcount(delivered.slots));
+#if PIPELINE_LATENCY_ENABLED
+                if (delivered.slots != 0) {
+                    pipelineLatency.recordSent(PipelineOutput::BINARY, bucket.groups, sizeof(frame), micros());
+                }
+#endif
+                boatDataStreamClients.markSent(delivered, generation, now);
+                continue;
+            }
+
+            // JSON into the scratch buffer, then one pooled copy shared by every client (no String)
+            JsonWriter json(boatDataScratch, BoatDataSerializer::JSON_BUFFER_SIZE);
+            size_t length;
+            TRACE_BEGIN(TraceId::SERIALIZE, static_cast<uint32_t>(bucket.mode));
+            if (bucket.mode == BoatDataStreamMode::DELTA) {
+                length = deltaReady ? BoatDataSerializer::toDeltaJSON(*deltaSnapshot, deltaSet, json) : 0;
+                if (length == 0) {
+                    boatDataDelta.requestKeyframe();  // Baseline already advanced; resynchronise the clients
+                }
+            } else {
+                length = BoatDataSerializer::toJSON(boatData, json, bucket.groups);
+            }
+            TRACE_END(TraceId::SERIALIZE);
 
             // Check for serialization failure
-            if (json.length() == 0) {
-                logger.broadcastLog(LogLevel::ERROR, "BoatDataStream", "SERIALIZATION_FAILED",
+            if (length == 0) {
+                logger.broadcastLog(LogLevel::ERROR, LogComponent::BOATDATA_STREAM, LogEvent::SERIALIZATION_FAILED,
                     F("{\"reason\":\"empty JSON returned\"}"));
-                return;
+                continue;
+            }
+            AsyncWebSocketSharedBuffer frame = pooledFrame(boatDataScratch, length);
+            if (!frame) {
+                continue;  // Pool exhausted (counted): the clients stay due
             }
 
-            // Broadcast to all connected clients
-            wsBoatData.textAll(json);
+            // Clients that skipped this frame stay due: they get the latest state once they drain
+            BoatDataStreamBucket delivered = bucket;
+            delivered.slots = 0;
+            TRACE_BEGIN(TraceId::WS_SEND, length);
+            for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+                AsyncWebSocketClient* client = (bucket.slots & (1u << i)) ? boatDataReadyClient(i, now) : nullptr;
+                if (client == nullptr) {
+                    continue;
+                }
+                client->text(frame);
+                if (boatDataStreamClients.recordSent(i) && bucket.mode == BoatDataStreamMode::DELTA) {
+                    boatDataDelta.requestKeyframe();  // It missed deltas: resynchronise on the next frame
+                }
+                delivered.slots = static_cast<uint16_t>(delivered.slots | (1u << i));
+            }
+            TRACE_END(TraceId::WS_SEND);
+            GetWebTrafficStats().wsSent(AdmissionEndpoint::BOATDATA, length, __builtin_popcount(delivered.slots));
+#if PIPELINE_LATENCY_ENABLED
+            if (delivered.slots != 0) {
+                pipelineLatency.recordSent(static_cast<PipelineOutput>(bucket.mode), bucket.groups, length, micros());
+            }
+#endif
+            boatDataStreamClients.markSent(delivered, generation, now);
 
             // Log broadcast event (DEBUG level - optional in production)
-            logger.broadcastLog(LogLevel::DEBUG, "BoatDataStream", "BROADCAST",
-                String(F("{\"clients\":")) + wsBoatData.count() +
-                F(",\"size\":") + json.length() + F("}"));
+            LOG_DEBUGF(&logger, LogComponent::BOATDATA_STREAM, LogEvent::BROADCAST,
+                "{\"tick\":%lu,\"groups\":%u,\"slots\":%u,\"size\":%u}", (unsigned long)tick,
+                (unsigned)bucket.groups, (unsigned)bucket.slots, (unsigned)length);
+        }
+
+        // Signal K consumers: the same change set, rendered as a Signal K delta
+        if (deltaReady && !deltaSet.empty() && wsSignalK.count() > 0) {
+            char timestamp[24];
+            JsonWriter json(boatDataScratch, sizeof(boatDataScratch));
+            TRACE_BEGIN(TraceId::SERIALIZE, static_cast<uint32_t>(BoatDataStreamMode::DELTA));
+            size_t length = BoatDataSerializer::toSignalK(*deltaSnapshot, deltaSet, json,
+                                                          signalKTimestamp(timestamp, sizeof(timestamp)));
+            TRACE_END(TraceId::SERIALIZE);
+            AsyncWebSocketSharedBuffer frame = length > 0 ? pooledFrame(boatDataScratch, length) : nullptr;
+            if (!frame) {
+                boatDataDelta.requestKeyframe();  // Overflow or pool exhausted: the clients missed this delta
+                return;
+            }
+            TRACE_SCOPE(TraceId::WS_SEND, length);
+            uint32_t sent = 0;
+            for (AsyncWebSocketClient& client : wsSignalK.getClients()) {
+                if (client.status() != WS_CONNECTED) {
+                    continue;
+                }
+                if (client.queueLen() >= BOATDATA_STREAM_MAX_QUEUED) {
+                    signalKResync = true;  // Missed a delta: keyframe once everyone drains
+                    continue;
+                }
+                client.text(frame);
+                sent++;
+            }
+            GetWebTrafficStats().wsSent(AdmissionEndpoint::SIGNALK, length, sent);
+#if PIPELINE_LATENCY_ENABLED
+            if (sent > 0) {
+                pipelineLatency.recordSent(PipelineOutput::SIGNALK, BoatDataGroup::ALL, length, micros());
+            }
+#endif
+        }
+        if (signalKResync && deltaReady) {
+            bool behind = false;
+            for (AsyncWebSocketClient& client : wsSignalK.getClients()) {
+                behind = behind || (client.status() == WS_CONNECTED && client.queueLen() >= BOATDATA_STREAM_MAX_QUEUED);
+            }
+            if (!behind) {
+                signalKResync = false;
+                boatDataDelta.requestKeyframe();
+            }
+        }
+    }, ReactionClass::UI_NETWORK);
+
+    logger.broadcastLogf(LogLevel::INFO, LogComponent::BOATDATA_STREAM, LogEvent::BROADCAST_TIMER_STARTED,
+                         "{\"tick_ms\":%u,\"default_interval_ms\":%u}",
+                         (unsigned)BOATDATA_STREAM_TICK_MS, (unsigned)BOATDATA_BROADCAST_INTERVAL_MS);
+
+#if BOATDATA_GOVERNOR_ENABLED
+    // Broadcast rate governor: slower under loop/heap/queue pressure, faster when idle
+    onRepeatProfiled("bd_govern", BOATDATA_GOVERNOR_INTERVAL_MS, []() {
+        static BoatDataGovernorState lastState = BoatDataGovernorState::NORMAL;
+
+        BoatDataGovernorInputs inputs;
+        inputs.loopHz = systemMetrics != nullptr ? systemMetrics->getLoopFrequency() : 0;
+        inputs.cpuIdlePct = systemMetrics != nullptr ? systemMetrics->getCpuIdleMonitor().getMinIdlePercent()
+                                                     : CPU_IDLE_UNKNOWN;
+        inputs.freeHeap = ESP.getFreeHeap();
+        inputs.maxQueued = 0;
+        for (AsyncWebSocketClient& client : wsBoatData.getClients()) {
+            if (client.status() == WS_CONNECTED && client.queueLen() > inputs.maxQueued) {
+                inputs.maxQueued = client.queueLen();
+            }
+        }
+        for (AsyncWebSocketClient& client : wsSignalK.getClients()) {
+            if (client.status() == WS_CONNECTED && client.queueLen() > inputs.maxQueued) {
+                inputs.maxQueued = client.queueLen();
+            }
         }
-    });
 
-    logger.broadcastLog(LogLevel::INFO, "BoatDataStream", "BROADCAST_TIMER_STARTED",
-                        "{\"interval_ms\":1000,\"frequency_hz\":1}");
+        bool changed = boatDataRateGovernor.evaluate(inputs);
+        if (changed) {
+            boatDataStreamClients.setDefaultTicks(boatDataRateGovernor.getTicks());
+            boatDataStreamClients.setFloorTicks(boatDataRateGovernor.getFloorTicks());
+            boatDataDelta.setKeyframeInterval(boatDataRateGovernor.getKeyframeMs());
+        }
+        if (changed || boatDataRateGovernor.getState() != lastState) {
+            lastState = boatDataRateGovernor.getState();
+            logger.broadcastLogf(changed ? LogLevel::INFO : LogLevel::DEBUG, LogComponent::BOATDATA_STREAM, LogEvent::GOVERNOR_STATE,
+                "{\"state\":\"%s\",\"interval_ms\":%lu,\"keyframe_ms\":%lu,\"loop_hz\":%lu,"
+                "\"cpu_idle_pct\":%u,\"free_heap\":%lu,\"max_queued\":%lu}",
+                BoatDataRateGovernor::stateName(lastState), (unsigned long)boatDataRateGovernor.getIntervalMs(),
+                (unsigned long)boatDataRateGovernor.getKeyframeMs(), (unsigned long)inputs.loopHz,
+                (unsigned)inputs.cpuIdlePct, (unsigned long)inputs.freeHeap, (unsigned long)inputs.maxQueued);
+        }
+    }, ReactionClass::BACKGROUND);
+#endif
 
-    // T028: Display refresh loops - 1s animation, 5s status
-    app.onRepeat(DISPLAY_ANIMATION_INTERVAL_MS, []() {
+#if POSEIDON_FEATURE_DISPLAY
+    // T028: Display refresh loops - 1s animation, 5s status, 100 ms instrument pages
+    onRepeatProfiled("oled_anim", DISPLAY_ANIMATION_INTERVAL_MS, []() {
         if (displayManager != nullptr) {
             displayManager->updateAnimationIcon();
         }
-    });
+    }, ReactionClass::UI_NETWORK);
 
-    app.onRepeat(DISPLAY_STATUS_INTERVAL_MS, []() {
-        if (displayManager != nullptr) {
+    // Page selection (rotation, button) and change-driven instrument pages: a page
+    // is only redrawn when one of its values moved by a displayed digit
+    onRepeatProfiled("oled_inst", DISPLAY_INSTRUMENT_INTERVAL_MS, []() {
+        if (displayManager == nullptr) {
+            return;
+        }
+#if DISPLAY_BUTTON_PIN >= 0
+        bool pressed = digitalRead(DISPLAY_BUTTON_PIN) == LOW;
+#else
+        bool pressed = false;
+#endif
+        bool switched = displayPager.poll(pressed, millis());
+        OledPage page = displayPager.page();
+#if ALARM_ENABLED
+        if (alarmScreenShown) {
+            return;  // Redrawn once the alarm screen is gone
+        }
+#endif
+
+        if (!IsInstrumentPage(page)) {
+            if (!switched) {
+                return;  // Status and reaction pages refresh in "oled_page"
+            }
+            TRACE_SCOPE(TraceId::DISPLAY_RENDER, 0);
+#if REACTION_PROFILER_ENABLED && REACTION_PROFILER_OLED_PAGE
+            if (page == OledPage::REACTIONS) {
+                displayManager->renderReactionPage(reactionProfiler, ESP.getCpuFreqMHz(), millis());
+                return;
+            }
+#endif
             displayManager->renderStatusPage();
+            return;
+        }
+        if (boatData == nullptr) {
+            return;
+        }
+
+        // Skip the value check while none of the page's groups was written; the
+        // status interval still catches a source timing out ("---")
+        static uint32_t seenGeneration = 0;
+        static uint32_t lastCheckMs = 0;
+        const BoatDataChangeTracker& changes = boatData->getChanges();
+        uint16_t groups = GetInstrumentPageSpec(page)->groups;
+        uint32_t now = millis();
+        if (!switched && (changes.changedSince(seenGeneration) & groups) == 0 &&
+            now - lastCheckMs < DISPLAY_STATUS_INTERVAL_MS) {
+            return;
+        }
+        seenGeneration = changes.getGeneration();
+        lastCheckMs = now;
+        TRACE_SCOPE(TraceId::DISPLAY_RENDER, 0);
+        displayManager->renderInstrumentPage(page, *boatData->getDataStructure());
+    }, ReactionClass::UI_NETWORK);
+
+#if ALARM_ENABLED
+    // Active alarms: the most severe one flashes full screen over the pages
+    onRepeatProfiled("oled_alarm", ALARM_FLASH_INTERVAL_MS, []() {
+        static bool visible = false;
+        if (displayManager == nullptr) {
+            return;
+        }
+
+        int shown = -1;
+        for (uint8_t i = 0; i < alarmEngine.getRuleCount(); i++) {
+            const AlarmRuleStatus& rule = alarmEngine.getRule(i);
+            if (rule.state == AlarmState::ACTIVE &&
+                (shown < 0 || AlarmTypeSeverity(rule.rule.type) < AlarmTypeSeverity(alarmEngine.getRule(shown).rule.type))) {
+                shown = i;
+            }
+        }
+        if (shown < 0) {
+            if (alarmScreenShown) {
+                alarmScreenShown = false;  // Instrument pages redraw in "oled_inst", others here
+                if (displayPager.page() == OledPage::STATUS) {
+                    displayManager->renderStatusPage();
+                }
+            }
+            return;
+        }
+
+        static const char* const TITLES[] = {"ALARM", "WARNING", "CAUTION"};
+        const AlarmRuleStatus& rule = alarmEngine.getRule(shown);
+        char value[16];
+        if (rule.rule.type == AlarmType::SHORE_POWER_LOST) {
+            snprintf(value, sizeof(value), "shore off");
+        } else {
+            snprintf(value, sizeof(value), "%.1f %s", rule.value, rule.rule.type == AlarmType::BATTERY_LOW ? "V" : "m");
+        }
+        alarmScreenShown = true;
+        visible = !visible;
+        TRACE_SCOPE(TraceId::DISPLAY_RENDER, 0);
+        displayManager->renderAlarm(TITLES[static_cast<uint8_t>(AlarmTypeSeverity(rule.rule.type))],
+                                    AlarmTypeName(rule.rule.type), value, visible);
+    }, ReactionClass::UI_NETWORK);
+#endif
+#endif
+
+    // Headless builds keep this reaction for the loop frequency and latency reports
+    onRepeatProfiled("oled_page", DISPLAY_STATUS_INTERVAL_MS, []() {
+#if POSEIDON_FEATURE_DISPLAY
+        if (displayManager != nullptr) {
+            // Refresh of the shown status or reaction page (instrument pages update on change)
+            TRACE_SCOPE(TraceId::DISPLAY_RENDER, 0);
+            OledPage page = displayPager.page();
+#if ALARM_ENABLED
+            if (alarmScreenShown) {
+                page = OledPage::COUNT;  // "oled_alarm" owns the screen
+            }
+#endif
+#if REACTION_PROFILER_ENABLED && REACTION_PROFILER_OLED_PAGE
+            if (page == OledPage::REACTIONS) {
+                displayManager->renderReactionPage(reactionProfiler, ESP.getCpuFreqMHz(), millis());
+            }
+#endif
+            if (page == OledPage::STATUS) {
+                displayManager->renderStatusPage();
+            }
         }
+#endif
 
         // R007: WebSocket loop frequency logging
         if (systemMetrics != nullptr) {
             uint32_t frequency = systemMetrics->getLoopFrequency();
             LogLevel level = (frequency == 0 || frequency >= 200)
                              ? LogLevel::DEBUG : LogLevel::WARN;
-            String data = String("{\"frequency\":") + frequency + "}";
-            logger.broadcastLog(level, "Performance", "LOOP_FREQUENCY", data);
+            // Idle share per core (null until the first window)
+            char idle[2][5];
+            for (uint8_t core = 0; core < 2; core++) {
+                uint8_t percent = systemMetrics->getCoreIdlePercent(core);
+                if (percent == CPU_IDLE_UNKNOWN) {
+                    snprintf(idle[core], sizeof(idle[core]), "null");
+                } else {
+                    snprintf(idle[core], sizeof(idle[core]), "%u", (unsigned)percent);
+                }
+            }
+            logger.broadcastLogf(level, LogComponent::PERFORMANCE, LogEvent::LOOP_FREQUENCY,
+                "{\"frequency\":%lu,\"cpu_idle_pct\":[%s,%s]}", (unsigned long)frequency, idle[0], idle[1]);
+
+            // Iteration latency of each completed window; the histogram when p99 is over the threshold
+            static uint32_t reportedWindow = 0;
+            const LoopPerformanceMonitor& loopMonitor = systemMetrics->getLoopMonitor();
+            if (loopMonitor.getWindowCount() != reportedWindow) {
+                reportedWindow = loopMonitor.getWindowCount();
+                const LatencyHistogram& window = loopMonitor.getLastWindow();
+                uint32_t p99 = window.getPercentile(99);
+                bool slow = p99 >= LOOP_LATENCY_WARN_P99_US;
+
+                StaticJsonWriter<768> json;
+                json.beginObject()
+                    .add("n", (unsigned long)window.getCount())
+                    .add("p50_us", (unsigned long)window.getPercentile(50))
+                    .add("p95_us", (unsigned long)window.getPercentile(95))
+                    .add("p99_us", (unsigned long)p99)
+                    .add("max_us", (unsigned long)window.getMax());
+                if (slow) {
+                    // Non-empty buckets as [upper edge us, count]
+                    json.add("threshold_us", (unsigned long)LOOP_LATENCY_WARN_P99_US).beginArray("buckets");
+                    for (uint8_t b = 0; b < LatencyHistogram::BUCKETS; b++) {
+                        if (window.getBucket(b) != 0) {
+                            json.beginArray()
+                                .add((unsigned long)LatencyHistogram::bucketUpperEdge(b))
+                                .add((unsigned long)window.getBucket(b))
+                                .endArray();
+                        }
+                    }
+                    json.endArray();
+                }
+                json.endObject();
+                if (slow) {
+                    logger.broadcastLog(LogLevel::WARN, LogComponent::PERFORMANCE, LogEvent::LOOP_LATENCY, json.c_str());
+                } else {
+                    LOG_DEBUG(&logger, LogComponent::PERFORMANCE, LogEvent::LOOP_LATENCY, json.c_str());
+                }
+            }
         }
-    });
+    }, ReactionClass::UI_NETWORK);
 
     // Log initialization complete
+    GetBootTimeline().mark("reactions", millis());
+    GetBootTimeline().milestone(BootMilestone::SETUP_DONE, millis());
+    StaticJsonWriter<1024> timeline;
+    GetBootTimeline().writeJson(timeline, millis());
+    logger.broadcastLog(LogLevel::INFO, LogComponent::MAIN, LogEvent::BOOT_TIMELINE, timeline.c_str());
+    StaticJsonWriter<128> footprint;
+    GetStaticFootprint().writeJson(footprint);
+    logger.broadcastLog(LogLevel::INFO, LogComponent::MAIN, LogEvent::STATIC_FOOTPRINT, footprint.c_str());
+    sketchBytes = ESP.getSketchSize();
+    sketchFreeBytes = ESP.getFreeSketchSpace();
+    StaticJsonWriter<192> profile;
+    writeBuildProfile(profile);
+    logger.broadcastLog(LogLevel::INFO, LogComponent::MAIN, LogEvent::BUILD_PROFILE, profile.c_str());
+    StaticJsonWriter<768> placement;  // ~90 bytes per placed buffer
+    GetBufferPlacement().writeJson(placement);
+    logger.broadcastLog(GetBufferPlacement().getFailed() > 0 ? LogLevel::WARN : LogLevel::INFO,
+                        LogComponent::MAIN, LogEvent::BUFFER_PLACEMENT, placement.c_str());
+
+    memoryWebServer = memoryWebServerStorage.emplace(&memoryBudget, &taskMonitor,
+                                                     &systemMetrics->getHeapMonitor(), ESP.getFreeHeap());
+    listMemoryBudget();
+#if METRICS_ENABLED
+    registerMetrics();
+#endif
     Serial.println(F("Setup complete - entering main loop"));
 }
 
@@ -762,10 +4121,12 @@ void loop() {
         systemMetrics->instrumentLoop();
     }
 
-    // Process ReactESP events
+    // Process ReactESP events, then one pass over the repeating reactions
     app.tick();
-
-
+#if SCHED_ENABLED
+    reactionScheduler.run(millis());
+#endif
+    GetBootTimeline().milestone(BootMilestone::FIRST_LOOP, millis());
 }
 
 #endif // UNIT_TEST
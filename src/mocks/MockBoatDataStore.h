@@ -97,6 +97,34 @@ public:
         data.calibration = calibrationData;
     }
 
+    BoatDataView<GPSData> viewGPSData() const override {
+        return BoatDataView<GPSData>(data.gps, data.versions.gps);
+    }
+
+    BoatDataView<CompassData> viewCompassData() const override {
+        return BoatDataView<CompassData>(data.compass, data.versions.compass);
+    }
+
+    BoatDataView<WindData> viewWindData() const override {
+        return BoatDataView<WindData>(data.wind, data.versions.wind);
+    }
+
+    BoatDataView<SpeedData> viewSpeedData() const override {
+        return BoatDataView<SpeedData>(data.dst, data.versions.dst);
+    }
+
+    BoatDataView<RudderData> viewRudderData() const override {
+        return BoatDataView<RudderData>(data.rudder, data.versions.rudder);
+    }
+
+    BoatDataView<DerivedData> viewDerivedData() const override {
+        return BoatDataView<DerivedData>(data.derived, data.versions.derived);
+    }
+
+    BoatDataView<CalibrationData> viewCalibration() const override {
+        return BoatDataView<CalibrationData>(data.calibration, data.versions.calibration);
+    }
+
     // =========================================================================
     // TEST HELPERS
     // =========================================================================
@@ -15,6 +15,7 @@
 
 #include "../hal/interfaces/ICalibration.h"
 #include "../types/BoatDataTypes.h"
+#include "../config.h"
 
 /**
  * @brief Mock calibration manager for testing
@@ -41,6 +42,7 @@ public:
         currentParams.version = 1;
         currentParams.leewayCalibrationFactor = DEFAULT_LEEWAY_K_FACTOR;
         currentParams.windAngleOffset = DEFAULT_WIND_ANGLE_OFFSET;
+        currentParams.damping = DampingConfig();
 
         flashLoadSuccess = true;
         flashSaveSuccess = true;
@@ -75,6 +77,14 @@ public:
             return false;
         }
 
+        // Damping time constants within [0, DAMPING_MAX_TIME_CONSTANT_S]
+        for (uint8_t i = 0; i < DAMPING_FIELD_COUNT; i++) {
+            float tau = params.damping.timeConstant[i];
+            if (!(tau >= 0.0f && tau <= DAMPING_MAX_TIME_CONSTANT_S)) {
+                return false;
+            }
+        }
+
         return true;
     }
 
@@ -109,6 +119,7 @@ public:
         currentParams.version = 1;
         currentParams.leewayCalibrationFactor = DEFAULT_LEEWAY_K_FACTOR;
         currentParams.windAngleOffset = DEFAULT_WIND_ANGLE_OFFSET;
+        currentParams.damping = DampingConfig();
         flashLoadCallCount = 0;
         flashSaveCallCount = 0;
         flashLoadSuccess = true;
@@ -0,0 +1,109 @@
+/**
+ * @file MockConfigStore.h
+ * @brief In-memory IConfigStore for unit/integration tests
+ *
+ * Holds up to MAX_KEYS blobs of up to CONFIG_RECORD_MAX_BYTES. Tests can
+ * corrupt a stored blob to exercise the CRC fallback.
+ *
+ * Usage in tests:
+ * @code
+ * MockConfigStore store;
+ * CalibrationManager calibration(&store);
+ * calibration.saveToFlash(params);
+ * store.corrupt("calibration", 14);     // Flip one payload byte
+ * TEST_ASSERT_FALSE(calibration.loadFromFlash());
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef MOCK_CONFIG_STORE_H
+#define MOCK_CONFIG_STORE_H
+
+#include <string.h>
+#include "hal/interfaces/IConfigStore.h"
+#include "config.h"
+
+/**
+ * @brief Mock configuration store for testing
+ */
+class MockConfigStore : public IConfigStore {
+public:
+    static constexpr uint8_t MAX_KEYS = 4;
+
+    MockConfigStore() : writes(0) { memset(slots, 0, sizeof(slots)); }
+
+    bool begin() override { return true; }
+
+    size_t read(const char* key, uint8_t* out, size_t size) override {
+        Slot* slot = find(key);
+        if (slot == nullptr || slot->length > size) {
+            return 0;
+        }
+        memcpy(out, slot->data, slot->length);
+        return slot->length;
+    }
+
+    bool write(const char* key, const uint8_t* data, size_t length) override {
+        if (key == nullptr || strlen(key) > 15 || length == 0 || length > CONFIG_RECORD_MAX_BYTES) {
+            return false;
+        }
+        Slot* slot = find(key);
+        for (uint8_t i = 0; slot == nullptr && i < MAX_KEYS; i++) {
+            if (slots[i].key[0] == '\0') {
+                slot = &slots[i];
+                strcpy(slot->key, key);
+            }
+        }
+        if (slot == nullptr) {
+            return false;
+        }
+        memcpy(slot->data, data, length);
+        slot->length = length;
+        writes++;
+        return true;
+    }
+
+    bool remove(const char* key) override {
+        Slot* slot = find(key);
+        if (slot != nullptr) {
+            memset(slot, 0, sizeof(*slot));
+        }
+        return true;
+    }
+
+    // Test helper methods
+
+    /// Flip the bits of byte @p offset of the blob under @p key
+    void corrupt(const char* key, size_t offset) {
+        Slot* slot = find(key);
+        if (slot != nullptr && offset < slot->length) {
+            slot->data[offset] ^= 0xFF;
+        }
+    }
+
+    /// Successful write() calls
+    uint32_t getWrites() const { return writes; }
+
+private:
+    struct Slot {
+        char key[16];
+        uint8_t data[CONFIG_RECORD_MAX_BYTES];
+        size_t length;
+    };
+
+    Slot* find(const char* key) {
+        for (uint8_t i = 0; key != nullptr && i < MAX_KEYS; i++) {
+            if (slots[i].key[0] != '\0' && strcmp(slots[i].key, key) == 0) {
+                return &slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    Slot slots[MAX_KEYS];
+    uint32_t writes;
+};
+
+#endif // MOCK_CONFIG_STORE_H
@@ -15,6 +15,10 @@
  * TEST_ASSERT_TRUE(mockDisplay.wasTextRendered("WiFi: Connected"));
  * @endcode
  *
+ * drawBigNumber() is rendered into a real framebuffer (the same atlas copy
+ * as on the device) so tests can check the pixels, and its text is added to
+ * the rendered text like print().
+ *
  * @version 1.0.0
  * @date 2025-10-08
  */
@@ -23,6 +27,7 @@
 #define MOCK_DISPLAY_ADAPTER_H
 
 #include "hal/interfaces/IDisplayAdapter.h"
+#include "utils/BigDigitFont.h"
 #include <string.h>  // For strstr, strlen
 
 /**
@@ -42,6 +47,16 @@ private:
     uint8_t _textSize;
     char _renderedText[512];  // Buffer to track all printed text
     int _renderedTextLen;
+    uint8_t _framebuffer[OLED_SCREEN_WIDTH * OLED_SCREEN_HEIGHT / 8];  // drawBigNumber() output
+    int _bigNumberCalls;
+
+    void appendText(const char* text) {
+        int textLen = strlen(text);
+        if (_renderedTextLen + textLen < sizeof(_renderedText) - 1) {
+            strcpy(_renderedText + _renderedTextLen, text);
+            _renderedTextLen += textLen;
+        }
+    }
 
 public:
     /**
@@ -55,8 +70,10 @@ public:
           _cursorX(0),
           _cursorY(0),
           _textSize(1),
-          _renderedTextLen(0) {
+          _renderedTextLen(0),
+          _bigNumberCalls(0) {
         _renderedText[0] = '\0';
+        memset(_framebuffer, 0, sizeof(_framebuffer));
     }
 
     /**
@@ -85,6 +102,8 @@ public:
         _textSize = 1;
         _renderedText[0] = '\0';
         _renderedTextLen = 0;
+        memset(_framebuffer, 0, sizeof(_framebuffer));
+        _bigNumberCalls = 0;
     }
 
     // Query methods for test verification
@@ -147,6 +166,21 @@ public:
         return _renderedText;
     }
 
+    /**
+     * @brief Get the framebuffer drawBigNumber() wrote to
+     * @return Page-major SSD1306 layout, byte = 8 rows of one column
+     */
+    const uint8_t* getFramebuffer() const {
+        return _framebuffer;
+    }
+
+    /**
+     * @brief Get drawBigNumber() call count since last reset
+     */
+    int getBigNumberCalls() const {
+        return _bigNumberCalls;
+    }
+
     // IDisplayAdapter interface implementation
 
     bool init() override {
@@ -158,6 +192,7 @@ public:
         _wasCleared = true;
         _renderedText[0] = '\0';
         _renderedTextLen = 0;
+        memset(_framebuffer, 0, sizeof(_framebuffer));
     }
 
     void setCursor(uint8_t x, uint8_t y) override {
@@ -171,14 +206,16 @@ public:
 
     void print(const char* text) override {
         // Append text to rendered buffer
-        int textLen = strlen(text);
-        if (_renderedTextLen + textLen < sizeof(_renderedText) - 1) {
-            strcpy(_renderedText + _renderedTextLen, text);
-            _renderedTextLen += textLen;
-        }
+        appendText(text);
         // Note: Real display advances cursor, but mock doesn't track precise position
     }
 
+    void drawBigNumber(uint8_t x, uint8_t page, const char* text) override {
+        BigDigitDraw(_framebuffer, x, page, text);
+        appendText(text);
+        _bigNumberCalls++;
+    }
+
     void display() override {
         _displayCalled = true;
     }
@@ -0,0 +1,103 @@
+/**
+ * @file MockFirmwareUpdater.h
+ * @brief In-memory IFirmwareUpdater for unit/integration tests
+ *
+ * Records the bytes written (up to MAX_IMAGE) and the MD5 it was given.
+ * Tests choose the partition size, a failing write and the result of end().
+ *
+ * Usage in tests:
+ * @code
+ * MockFirmwareUpdater updater;
+ * updater.setCapacity(4096);
+ * updater.setEndResult(OtaError::HASH_MISMATCH);
+ * OtaSession session(&updater);
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef MOCK_FIRMWARE_UPDATER_H
+#define MOCK_FIRMWARE_UPDATER_H
+
+#include <string.h>
+#include "hal/interfaces/IFirmwareUpdater.h"
+
+/**
+ * @brief Mock OTA image writer for testing
+ */
+class MockFirmwareUpdater : public IFirmwareUpdater {
+public:
+    static constexpr size_t MAX_IMAGE = 256;
+
+    MockFirmwareUpdater()
+        : capacityBytes(MAX_IMAGE), failWriteAt(0), endResult(OtaError::NONE),
+          running(false), aborted(0), ended(0), length(0), target(OtaTarget::FIRMWARE) {
+        md5[0] = '\0';
+    }
+
+    uint32_t capacity(OtaTarget) override { return capacityBytes; }
+
+    bool begin(OtaTarget imageTarget, const char* expectedMd5) override {
+        target = imageTarget;
+        running = true;
+        length = 0;
+        strncpy(md5, expectedMd5 != nullptr ? expectedMd5 : "", sizeof(md5) - 1);
+        md5[sizeof(md5) - 1] = '\0';
+        return true;
+    }
+
+    size_t write(const uint8_t* data, size_t count) override {
+        if (!running || (failWriteAt > 0 && length + count >= failWriteAt)) {
+            return 0;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (length < MAX_IMAGE) {
+                image[length] = data[i];
+            }
+            length++;
+        }
+        return count;
+    }
+
+    OtaError end() override {
+        running = false;
+        ended++;
+        return endResult;
+    }
+
+    void abort() override {
+        running = false;
+        aborted++;
+    }
+
+    const char* lastError() override { return "mock"; }
+
+    // Test setup
+    void setCapacity(uint32_t bytes) { capacityBytes = bytes; }
+    void setFailWriteAt(size_t offset) { failWriteAt = offset; }  ///< 0 = never
+    void setEndResult(OtaError result) { endResult = result; }
+
+    // Test inspection
+    bool isRunning() const { return running; }
+    uint32_t getAborted() const { return aborted; }
+    uint32_t getEnded() const { return ended; }
+    size_t getLength() const { return length; }
+    const uint8_t* getImage() const { return image; }
+    const char* getMd5() const { return md5; }
+    OtaTarget getTarget() const { return target; }
+
+private:
+    uint32_t capacityBytes;
+    size_t failWriteAt;
+    OtaError endResult;
+    bool running;
+    uint32_t aborted;
+    uint32_t ended;
+    size_t length;
+    OtaTarget target;
+    uint8_t image[MAX_IMAGE];
+    char md5[33];
+};
+
+#endif // MOCK_FIRMWARE_UPDATER_H
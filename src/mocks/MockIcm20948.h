@@ -0,0 +1,138 @@
+/**
+ * @file MockIcm20948.h
+ * @brief Mock implementation of II2cDevice with an ICM-20948 register map and FIFO
+ *
+ * Keeps the four register banks (REG_BANK_SEL switches them), answers
+ * WHO_AM_I, and models the FIFO: pushSample() appends a 12-byte packet,
+ * FIFO_COUNTH/L report its length, FIFO_R_W bursts pop bytes, FIFO_RST
+ * empties it. Like the device, a full FIFO drops its oldest bytes, so a
+ * push that overflows leaves the count above 500.
+ *
+ * Usage in tests:
+ * @code
+ * MockIcm20948 device;
+ * Icm20948 imu(&device);
+ * imu.begin(100);
+ * device.pushSample(0.0, 0.0, 1.0, 0.0, 0.0, 0.0);   // level, at rest
+ * @endcode
+ *
+ * @version 1.0.0
+ */
+
+#ifndef MOCK_ICM20948_H
+#define MOCK_ICM20948_H
+
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "hal/interfaces/II2cDevice.h"
+#include "utils/Icm20948.h"
+
+/**
+ * @brief Scripted ICM-20948 for native tests
+ */
+class MockIcm20948 : public II2cDevice {
+public:
+    MockIcm20948()
+        : _present(true), _bank(0), _fifoLength(0), _failReads(0), _writes(0), _reads(0), _fifoReads(0) {
+        memset(_registers, 0, sizeof(_registers));
+        memset(_fifo, 0, sizeof(_fifo));
+        _registers[0][Icm20948::REG_WHO_AM_I] = Icm20948::WHO_AM_I_VALUE;
+    }
+
+    /// false: every transaction NAKs
+    void setPresent(bool present) { _present = present; }
+
+    /// Fail the next @p count reads
+    void failReads(uint32_t count) { _failReads = count; }
+
+    /// Append one packet (g and rad/s, converted at the begin() ranges)
+    void pushSample(double ax, double ay, double az, double gx, double gy, double gz) {
+        double accel[3] = {ax, ay, az};
+        double gyro[3] = {gx, gy, gz};
+        uint8_t packet[Icm20948::PACKET_BYTES];
+        for (int axis = 0; axis < 3; axis++) {
+            put(packet + 2 * axis, accel[axis] * Icm20948::ACCEL_LSB_PER_G);
+            put(packet + 6 + 2 * axis, gyro[axis] * 180.0 / M_PI * Icm20948::GYRO_LSB_PER_DPS);
+        }
+        for (uint8_t i = 0; i < sizeof(packet); i++) {
+            if (_fifoLength == Icm20948::FIFO_BYTES) {
+                memmove(_fifo, _fifo + 1, Icm20948::FIFO_BYTES - 1);   // Stream mode: oldest byte lost
+                _fifoLength--;
+            }
+            _fifo[_fifoLength++] = packet[i];
+        }
+    }
+
+    uint8_t getRegister(uint8_t bank, uint8_t reg) const { return _registers[bank & 3][reg & 0x7F]; }
+    uint16_t getFifoLength() const { return _fifoLength; }
+    uint32_t getWrites() const { return _writes; }
+    uint32_t getReads() const { return _reads; }
+    uint32_t getFifoReads() const { return _fifoReads; }
+
+    bool writeRegister(uint8_t reg, uint8_t value) override {
+        if (!_present) {
+            return false;
+        }
+        _writes++;
+        if (reg == Icm20948::REG_BANK_SEL) {
+            _bank = (value >> 4) & 3;
+            return true;
+        }
+        _registers[_bank][reg & 0x7F] = value;
+        if (_bank == 0 && reg == Icm20948::REG_FIFO_RST && value != 0) {
+            _fifoLength = 0;
+        }
+        return true;
+    }
+
+    bool readRegisters(uint8_t reg, uint8_t* out, size_t length) override {
+        if (!_present) {
+            return false;
+        }
+        _reads++;
+        if (_failReads > 0) {
+            _failReads--;
+            return false;
+        }
+        if (_bank == 0 && reg == Icm20948::REG_FIFO_R_W) {
+            _fifoReads++;
+            size_t n = length < _fifoLength ? length : _fifoLength;
+            memcpy(out, _fifo, n);
+            memset(out + n, 0xFF, length - n);
+            memmove(_fifo, _fifo + n, _fifoLength - n);
+            _fifoLength = static_cast<uint16_t>(_fifoLength - n);
+            return true;
+        }
+        if (_bank == 0 && reg == Icm20948::REG_FIFO_COUNTH) {
+            _registers[0][Icm20948::REG_FIFO_COUNTH] = static_cast<uint8_t>(_fifoLength >> 8);
+            _registers[0][Icm20948::REG_FIFO_COUNTH + 1] = static_cast<uint8_t>(_fifoLength & 0xFF);
+        }
+        for (size_t i = 0; i < length; i++) {
+            out[i] = _registers[_bank][(reg + i) & 0x7F];
+        }
+        return true;
+    }
+
+private:
+    static void put(uint8_t* p, double counts) {
+        long value = lround(counts);
+        if (value > 32767) value = 32767;
+        if (value < -32768) value = -32768;
+        uint16_t raw = static_cast<uint16_t>(static_cast<int16_t>(value));
+        p[0] = static_cast<uint8_t>(raw >> 8);
+        p[1] = static_cast<uint8_t>(raw & 0xFF);
+    }
+
+    bool _present;
+    uint8_t _bank;
+    uint8_t _registers[4][128];
+    uint8_t _fifo[Icm20948::FIFO_BYTES];
+    uint16_t _fifoLength;
+    uint32_t _failReads;
+    uint32_t _writes;
+    uint32_t _reads;
+    uint32_t _fifoReads;
+};
+
+#endif // MOCK_ICM20948_H
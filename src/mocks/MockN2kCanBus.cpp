@@ -0,0 +1,146 @@
+#include "MockN2kCanBus.h"
+#include <string.h>
+#include "utils/N2kLoadPlan.h"
+
+MockN2kCanBus::MockN2kCanBus() {
+    SetMode(tNMEA2000::N2km_ListenOnly);
+    clear();
+}
+
+void MockN2kCanBus::clear() {
+    count_ = 0;
+    next_ = 0;
+    arrived_ = 0;
+    queued_ = 0;
+    rxCapacity_ = MAX_FRAMES;
+    queueHighWater_ = 0;
+    sequence_ = 0;
+    frameCostUs_ = 0;
+    delivered_ = 0;
+    overruns_ = 0;
+    sent_ = 0;
+    maxWaitUs_ = 0;
+    totalWaitUs_ = 0;
+}
+
+bool MockN2kCanBus::scheduleFrame(uint32_t atUs, uint32_t id, uint8_t len, const uint8_t* data) {
+    if (count_ >= MAX_FRAMES || len > 8 || (len > 0 && data == nullptr)) {
+        return false;
+    }
+    if (count_ > 0 && static_cast<int32_t>(atUs - frames_[count_ - 1].atUs) < 0) {
+        return false;
+    }
+
+    Frame& frame = frames_[count_++];
+    frame.atUs = atUs;
+    frame.id = id;
+    frame.len = len;
+    frame.dropped = false;
+    memset(frame.data, 0xFF, sizeof(frame.data));
+    if (len > 0) {
+        memcpy(frame.data, data, len);
+    }
+    return true;
+}
+
+uint8_t MockN2kCanBus::scheduleMessage(uint32_t atUs, const tN2kMsg& msg, uint32_t frameGapUs,
+                                       uint8_t skipFrame) {
+    uint32_t id = N2kLoadPlan::canId(msg.Priority, msg.PGN, msg.Source, msg.Destination);
+    if (msg.DataLen <= 8) {
+        return scheduleFrame(atUs, id, static_cast<uint8_t>(msg.DataLen), msg.Data) ? 1 : 0;
+    }
+
+    static uint8_t split[N2kLoadPlan::MAX_FRAMES_PER_MESSAGE][8];
+    uint8_t frames = N2kLoadPlan::splitFastPacket(msg.Data, static_cast<uint8_t>(msg.DataLen),
+                                                  sequence_, split);
+    uint8_t wanted = (skipFrame < frames) ? frames - 1 : frames;
+    if (frames == 0 || count_ + wanted > MAX_FRAMES) {
+        return 0;
+    }
+    sequence_ = (sequence_ + 1) & 0x07;
+
+    uint8_t scheduled = 0;
+    for (uint8_t i = 0; i < frames; i++) {
+        if (i == skipFrame) {
+            continue;
+        }
+        if (scheduleFrame(atUs + i * frameGapUs, id, 8, split[i])) {
+            scheduled++;
+        }
+    }
+    return scheduled;
+}
+
+void MockN2kCanBus::admitArrivals(uint32_t nowUs) {
+    // Between two fetches the queue only grows, so admitting everything that
+    // arrived by now before the next fetch drops exactly the frames the ISR would
+    while (arrived_ < count_ && static_cast<int32_t>(nowUs - frames_[arrived_].atUs) >= 0) {
+        if (queued_ >= rxCapacity_) {
+            frames_[arrived_].dropped = true;
+            overruns_++;
+        } else {
+            queued_++;
+            if (queued_ > queueHighWater_) {
+                queueHighWater_ = queued_;
+            }
+        }
+        arrived_++;
+    }
+}
+
+bool MockN2kCanBus::CANGetFrame(unsigned long& id, unsigned char& len, unsigned char* buf) {
+    VirtualClock& clock = GetVirtualClock();
+    admitArrivals(clock.micros());
+
+    while (next_ < arrived_ && frames_[next_].dropped) {
+        next_++;
+    }
+    if (next_ >= arrived_) {
+        return false;
+    }
+
+    const Frame& frame = frames_[next_++];
+    queued_--;
+    id = frame.id;
+    len = frame.len;
+    memcpy(buf, frame.data, frame.len);
+
+    uint32_t wait = clock.micros() - frame.atUs;
+    totalWaitUs_ += wait;
+    if (wait > maxWaitUs_) {
+        maxWaitUs_ = wait;
+    }
+    delivered_++;
+    clock.advanceUs(frameCostUs_);
+    return true;
+}
+
+bool MockN2kCanBus::CANSendFrame(unsigned long id, unsigned char len, const unsigned char* buf,
+                                 bool wait_sent) {
+    (void)id;
+    (void)len;
+    (void)buf;
+    (void)wait_sent;
+    sent_++;
+    return true;
+}
+
+uint32_t MockN2kCanBus::runUntil(uint32_t endUs, uint32_t passIntervalUs) {
+    VirtualClock& clock = GetVirtualClock();
+    if (passIntervalUs == 0) {
+        passIntervalUs = 1;
+    }
+    uint32_t passes = 0;
+    uint32_t passStart = clock.micros();
+
+    while (static_cast<int32_t>(endUs - clock.micros()) > 0) {
+        ParseMessages();
+        passes++;
+        passStart += passIntervalUs;
+        clock.advanceTo(passStart);   // Late pass: the next one starts at once
+        if (static_cast<int32_t>(clock.micros() - passStart) > 0) {
+            passStart = clock.micros();
+        }
+    }
+    return passes;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file MockN2kCanBus.h
+ * @brief Scripted CAN backend for tNMEA2000, for host timing and throughput tests
+ *
+ * The NMEA2000 library talks to hardware through three virtual methods
+ * (CANOpen, CANGetFrame, CANSendFrame). This mock implements them against a
+ * script of timed frames, so tests reach the handlers through the real
+ * library path: frame fetch, fast-packet reassembly, the receive list and
+ * the message handlers installed by RegisterN2kHandlers() (N2kPGNDispatcher,
+ * the catch-all counter, the statistics table).
+ *
+ * Time is GetVirtualClock() (VirtualClock.h):
+ * - scheduleFrame()/scheduleMessage() give every frame its arrival time;
+ *   messages longer than 8 bytes are split into fast-packet frames
+ *   (N2kLoadPlan::splitFastPacket), optionally spaced and with one frame left
+ *   out to script a reassembly loss
+ * - runUntil() runs ParseMessages() passes at a fixed interval, like the
+ *   n2k_rx reaction; a frame is only fetched once its arrival time is reached
+ * - setFrameCostUs() charges virtual time per fetched frame (the receive
+ *   path's cost), and setRxCapacity() bounds the frames waiting between two
+ *   fetches like the driver's RX queue: a frame arriving at a full queue is
+ *   dropped and counted as an overrun, as the CAN ISR does
+ *
+ * Everything is deterministic: the same script gives the same waits,
+ * overruns and handler calls on every run.
+ *
+ * Usage in tests:
+ * @code
+ * static MockN2kCanBus bus;
+ * RegisterN2kHandlers(&bus, &boatData, &logger);
+ *
+ * tN2kMsg msg;
+ * SetN2kPGN130306(msg, 0, 7.3, 0.61, N2kWind_Apparent);
+ * msg.Source = 10;
+ * bus.scheduleMessage(5000, msg);
+ * bus.runUntil(20000, 10000);        // Passes at 0 and 10 ms
+ * TEST_ASSERT_EQUAL_UINT32(1, bus.getDelivered());
+ * TEST_ASSERT_EQUAL_UINT32(5000, bus.getMaxWaitUs());  // Arrived at 5 ms, fetched at 10 ms
+ * @endcode
+ *
+ * @version 1.0.0
+ */
+
+#ifndef MOCK_N2K_CAN_BUS_H
+#define MOCK_N2K_CAN_BUS_H
+
+#include <NMEA2000.h>
+#include <N2kMsg.h>
+#include <stdint.h>
+#include "VirtualClock.h"
+
+/**
+ * @brief tNMEA2000 backend fed from a script of timed frames
+ */
+class MockN2kCanBus : public tNMEA2000 {
+public:
+    static constexpr uint16_t MAX_FRAMES = 1024;   ///< Script capacity (static, no heap)
+    static constexpr uint8_t NO_SKIP = 0xFF;
+
+    /// Listen-only node: the library claims no address and sends nothing by itself
+    MockN2kCanBus();
+
+    /// Forget the script, the counters and the fast-packet sequence (not the clock)
+    void clear();
+
+    /**
+     * @brief Add one frame arriving at @p atUs
+     * @return false when the script is full, @p len > 8, or @p atUs is before
+     *         the previous frame's arrival (the script is in arrival order)
+     */
+    bool scheduleFrame(uint32_t atUs, uint32_t id, uint8_t len, const uint8_t* data);
+
+    /**
+     * @brief Add @p msg as it appears on the wire, first frame at @p atUs
+     *
+     * Up to 8 bytes: one frame. Longer: fast-packet frames @p frameGapUs
+     * apart, with the next 3-bit sequence counter.
+     *
+     * @param skipFrame Index of a fast-packet frame to leave out (NO_SKIP = none)
+     * @return Frames scheduled; 0 if the message does not fit the script
+     */
+    uint8_t scheduleMessage(uint32_t atUs, const tN2kMsg& msg, uint32_t frameGapUs = 0,
+                            uint8_t skipFrame = NO_SKIP);
+
+    /// Virtual time charged for each fetched frame (default 0)
+    void setFrameCostUs(uint32_t us) { frameCostUs_ = us; }
+
+    /// Frames that may wait between two fetches (default MAX_FRAMES)
+    void setRxCapacity(uint16_t frames) { rxCapacity_ = frames > 0 ? frames : 1; }
+
+    /**
+     * @brief ParseMessages() every @p passIntervalUs until the clock reaches @p endUs
+     *
+     * A pass that overruns its interval starts the next one at once, as
+     * ReactESP does with a late reaction.
+     *
+     * @return Passes run
+     */
+    uint32_t runUntil(uint32_t endUs, uint32_t passIntervalUs);
+
+    uint16_t getScheduled() const { return count_; }
+    uint16_t getPending() const { return static_cast<uint16_t>(count_ - next_); }
+    uint32_t getDelivered() const { return delivered_; }
+    uint32_t getOverruns() const { return overruns_; }
+    uint32_t getSent() const { return sent_; }
+    uint16_t getQueueHighWater() const { return queueHighWater_; }
+
+    /// Longest arrival-to-fetch wait of a delivered frame (µs)
+    uint32_t getMaxWaitUs() const { return maxWaitUs_; }
+
+    /// Sum of the arrival-to-fetch waits (µs), for an average over getDelivered()
+    uint64_t getTotalWaitUs() const { return totalWaitUs_; }
+
+protected:
+    bool CANOpen() override { return true; }
+    bool CANSendFrame(unsigned long id, unsigned char len, const unsigned char* buf,
+                      bool wait_sent = true) override;
+    bool CANGetFrame(unsigned long& id, unsigned char& len, unsigned char* buf) override;
+
+private:
+    struct Frame {
+        uint32_t atUs;
+        uint32_t id;
+        uint8_t len;
+        bool dropped;   ///< Arrived at a full RX queue
+        uint8_t data[8];
+    };
+
+    Frame frames_[MAX_FRAMES];
+    uint16_t count_;
+    uint16_t next_;       ///< Next frame to fetch
+    uint16_t arrived_;    ///< Frames whose arrival has been processed
+    uint16_t queued_;     ///< Arrived, not dropped, not fetched
+    uint16_t rxCapacity_;
+    uint16_t queueHighWater_;
+    uint8_t sequence_;
+    uint32_t frameCostUs_;
+    uint32_t delivered_;
+    uint32_t overruns_;
+    uint32_t sent_;
+    uint32_t maxWaitUs_;
+    uint64_t totalWaitUs_;
+
+    /// Queue or drop the frames that have arrived by now
+    void admitArrivals(uint32_t nowUs);
+};
+
+#endif // MOCK_N2K_CAN_BUS_H
@@ -0,0 +1,179 @@
+/**
+ * @file MockOneWireBus.h
+ * @brief Mock implementation of IOneWireBus with scripted DS2438 devices
+ *
+ * Decodes the byte stream like the devices would: Skip ROM / Match ROM,
+ * Convert V, Recall Memory and Read Scratchpad of page 0. Read Scratchpad
+ * returns the device's page with a valid CRC unless corruption was
+ * requested.
+ *
+ * Usage in tests:
+ * @code
+ * MockOneWireBus bus;
+ * bus.addDevice(ROM_A);
+ * bus.setPage(0, 12.60, -410, 21.5);     // VAD volts, current register, temperature
+ * OneWireConversion conversion(&bus, clock);
+ * @endcode
+ *
+ * @version 1.0.0
+ */
+
+#ifndef MOCK_ONEWIRE_BUS_H
+#define MOCK_ONEWIRE_BUS_H
+
+#include <stdint.h>
+#include <string.h>
+#include "hal/interfaces/IOneWireBus.h"
+#include "utils/OneWireConversion.h"
+
+/**
+ * @brief Scripted 1-Wire bus for native tests
+ */
+class MockOneWireBus : public IOneWireBus {
+public:
+    static constexpr uint8_t MAX_DEVICES = 4;
+
+    MockOneWireBus()
+        : _clockUs(nullptr), _deviceCount(0), _present(true), _state(IDLE), _matchCount(0), _selected(-1),
+          _readIndex(0), _corruptReads(0), _resets(0), _writes(0), _reads(0), _conversions(0) {
+        memset(_roms, 0, sizeof(_roms));
+        memset(_pages, 0, sizeof(_pages));
+        memset(_match, 0, sizeof(_match));
+    }
+
+    /// Add a device; returns its index for setPage()
+    int addDevice(const uint8_t rom[8]) {
+        if (_deviceCount >= MAX_DEVICES) {
+            return -1;
+        }
+        memcpy(_roms[_deviceCount], rom, 8);
+        return _deviceCount++;
+    }
+
+    /// Page 0 of device @p index: VAD volts, current register, temperature (CRC computed)
+    void setPage(int index, float volts, int16_t currentRaw, float temperatureC) {
+        uint8_t* page = _pages[index];
+        int16_t temp = static_cast<int16_t>(temperatureC * 256.0f);
+        uint16_t vad = static_cast<uint16_t>(volts * 100.0f + 0.5f);
+        page[0] = 0x09;  // IAD | AD (VAD input)
+        page[1] = static_cast<uint8_t>(temp & 0xFF);
+        page[2] = static_cast<uint8_t>((temp >> 8) & 0xFF);
+        page[3] = static_cast<uint8_t>(vad & 0xFF);
+        page[4] = static_cast<uint8_t>((vad >> 8) & 0x03);
+        page[5] = static_cast<uint8_t>(currentRaw & 0xFF);
+        page[6] = static_cast<uint8_t>((currentRaw >> 8) & 0xFF);
+        page[7] = 0x00;
+        page[8] = OneWireCrc8(page, 8);
+    }
+
+    /// Advance @p clockUs by standard-speed timings on every operation (reset 960 us, byte 520 us)
+    void setClock(uint32_t* clockUs) { _clockUs = clockUs; }
+
+    /// No presence pulse from now on (bus unplugged)
+    void setPresent(bool present) { _present = present; }
+
+    /// Flip a bit in the CRC byte of the next @p count scratchpad reads
+    void corruptNextReads(int count) { _corruptReads = count; }
+
+    int getResets() const { return _resets; }
+    int getWrites() const { return _writes; }
+    int getReads() const { return _reads; }
+    int getConversions() const { return _conversions; }
+
+    // IOneWireBus interface implementation
+
+    bool reset() override {
+        advance(960);
+        _resets++;
+        _state = ROM_COMMAND;
+        _selected = -1;
+        return _present && _deviceCount > 0;
+    }
+
+    void write(uint8_t value) override {
+        advance(520);
+        _writes++;
+        switch (_state) {
+            case ROM_COMMAND:
+                if (value == 0xCC) {
+                    _state = FUNCTION;  // All devices
+                } else if (value == 0x55) {
+                    _state = MATCH;
+                    _matchCount = 0;
+                }
+                break;
+            case MATCH:
+                _match[_matchCount++] = value;
+                if (_matchCount == 8) {
+                    _selected = -1;
+                    for (int i = 0; i < _deviceCount; i++) {
+                        if (memcmp(_roms[i], _match, 8) == 0) {
+                            _selected = i;
+                        }
+                    }
+                    _state = FUNCTION;
+                }
+                break;
+            case FUNCTION:
+                if (value == 0xB4) {
+                    _conversions++;
+                    _state = IDLE;
+                } else if (value == 0xB8) {
+                    _state = RECALL_PAGE;
+                } else if (value == 0xBE) {
+                    _state = READ_PAGE;
+                }
+                break;
+            case RECALL_PAGE:
+                _state = IDLE;
+                break;
+            case READ_PAGE:
+                _state = STREAM;
+                _readIndex = 0;
+                break;
+            default:
+                break;
+        }
+    }
+
+    uint8_t read() override {
+        advance(520);
+        _reads++;
+        if (_state != STREAM || _selected < 0 || _readIndex >= 9) {
+            return 0xFF;  // Nobody driving the bus
+        }
+        uint8_t value = _pages[_selected][_readIndex++];
+        if (_readIndex == 9 && _corruptReads > 0) {
+            _corruptReads--;
+            value ^= 0x01;
+        }
+        return value;
+    }
+
+private:
+    enum State : uint8_t { IDLE = 0, ROM_COMMAND, MATCH, FUNCTION, RECALL_PAGE, READ_PAGE, STREAM };
+
+    void advance(uint32_t us) {
+        if (_clockUs != nullptr) {
+            *_clockUs += us;
+        }
+    }
+
+    uint32_t* _clockUs;
+    uint8_t _roms[MAX_DEVICES][8];
+    uint8_t _pages[MAX_DEVICES][9];
+    int _deviceCount;
+    bool _present;
+    State _state;
+    uint8_t _match[8];
+    int _matchCount;
+    int _selected;
+    int _readIndex;
+    int _corruptReads;
+    int _resets;
+    int _writes;
+    int _reads;
+    int _conversions;
+};
+
+#endif // MOCK_ONEWIRE_BUS_H
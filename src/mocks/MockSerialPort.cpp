@@ -1,19 +1,37 @@
 #include "MockSerialPort.h"
+#include "VirtualClock.h"
 
 MockSerialPort::MockSerialPort()
-    : mockData_(nullptr), position_(0) {
+    : mockData_(nullptr), position_(0), pacingBaud_(0), startUs_(0) {
 }
 
 void MockSerialPort::setMockData(const char* data) {
     mockData_ = data;
     position_ = 0;
+    startUs_ = GetVirtualClock().micros();
+}
+
+void MockSerialPort::setBaudPacing(unsigned long baud) {
+    pacingBaud_ = baud;
+    startUs_ = GetVirtualClock().micros();
+}
+
+size_t MockSerialPort::arrivedBytes() const {
+    size_t dataLength = strlen(mockData_);
+    if (pacingBaud_ == 0) {
+        return dataLength;
+    }
+    // 8N1: 10 bit times per byte
+    uint64_t elapsedUs = GetVirtualClock().micros() - startUs_;
+    uint64_t bytes = elapsedUs * pacingBaud_ / 10000000ULL;
+    return bytes < dataLength ? static_cast<size_t>(bytes) : dataLength;
 }
 
 int MockSerialPort::available() {
     if (mockData_ == nullptr) {
         return 0;
     }
-    size_t dataLength = strlen(mockData_);
+    size_t dataLength = arrivedBytes();
     if (position_ >= dataLength) {
         return 0;
     }
@@ -24,7 +42,7 @@ int MockSerialPort::read() {
     if (mockData_ == nullptr) {
         return -1;
     }
-    if (position_ >= strlen(mockData_)) {
+    if (position_ >= arrivedBytes()) {
         return -1;
     }
     return static_cast<int>(static_cast<unsigned char>(mockData_[position_++]));
@@ -42,4 +60,5 @@ Stream* MockSerialPort::getStream() {
 
 void MockSerialPort::reset() {
     position_ = 0;
+    startUs_ = GetVirtualClock().micros();
 }
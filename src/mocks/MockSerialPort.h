@@ -3,6 +3,7 @@
 
 #include "hal/interfaces/ISerialPort.h"
 #include <cstring>
+#include <stdint.h>
 
 /**
  * @file MockSerialPort.h
@@ -87,9 +88,23 @@ public:
      */
     void reset();
 
+    /**
+     * @brief Release bytes at @p baud on the virtual clock (0 = all at once)
+     *
+     * With pacing, only the bytes transmitted since setMockData() or reset()
+     * (10 bit times each, GetVirtualClock()) are available, so timing tests
+     * see a sentence arrive over its real transmission time.
+     */
+    void setBaudPacing(unsigned long baud);
+
 private:
     const char* mockData_;  ///< Pointer to mock data buffer
     size_t position_;       ///< Current read position in buffer
+    unsigned long pacingBaud_;  ///< 0 = no pacing
+    uint32_t startUs_;          ///< Virtual time the first byte started
+
+    /// Bytes transmitted so far (whole buffer without pacing)
+    size_t arrivedBytes() const;
 };
 
 #endif // MOCKSERIALPORT_H
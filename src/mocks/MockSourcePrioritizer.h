@@ -48,6 +48,10 @@ public:
     // =========================================================================
 
     int registerSource(const char* sourceId, SensorType type, ProtocolType protocol) override {
+        int existing = findSource(sourceId, type);
+        if (existing >= 0) {
+            return existing;  // Already registered
+        }
         if (sourceCount >= MAX_SOURCES) {
             return -1;  // No space
         }
@@ -60,11 +64,26 @@ public:
         sources[index].available = false;  // Available after first timestamp update
         sources[index].lastUpdate = 0;
         sources[index].manualOverride = false;
+        sources[index].rejected = 0;
+        sources[index].dropped = 0;
+        sources[index].fixQuality = 0;
+        sources[index].satellites = 0;
+        sources[index].hdop = 0.0;
+        sources[index].qualityReports = 0;
 
         sourceCount++;
         return index;
     }
 
+    int findSource(const char* sourceId, SensorType type) override {
+        for (int i = 0; i < sourceCount; i++) {
+            if (sources[i].type == type && strcmp(sources[i].sourceId, sourceId) == 0) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
     void updateSourceTimestamp(int sourceIndex, unsigned long timestamp) override {
         if (sourceIndex < 0 || sourceIndex >= sourceCount) {
             return;  // Invalid index
@@ -77,6 +96,29 @@ public:
         updateActiveSource(sources[sourceIndex].type);
     }
 
+    void recordRejection(int sourceIndex, SourceRejection reason) override {
+        if (sourceIndex < 0 || sourceIndex >= sourceCount) {
+            return;  // Invalid index
+        }
+
+        if (reason == SourceRejection::INACTIVE) {
+            sources[sourceIndex].dropped++;
+        } else {
+            sources[sourceIndex].rejected++;
+        }
+    }
+
+    void updateSourceQuality(int sourceIndex, uint8_t fixQuality, uint8_t satellites, double hdop) override {
+        if (sourceIndex < 0 || sourceIndex >= sourceCount) {
+            return;  // Invalid index
+        }
+
+        sources[sourceIndex].fixQuality = fixQuality;
+        sources[sourceIndex].satellites = satellites;
+        sources[sourceIndex].hdop = hdop;
+        sources[sourceIndex].qualityReports++;
+    }
+
     int getActiveSource(SensorType type) override {
         // Check for manual override first
         for (int i = 0; i < sourceCount; i++) {
@@ -149,7 +191,7 @@ public:
     void updatePriorities() override {
         // Simplified: no frequency calculation in mock
         // Just update active sources based on availability
-        for (int type = 0; type < 2; type++) {  // GPS and Compass only
+        for (int type = 0; type < SENSOR_TYPE_COUNT; type++) {
             updateActiveSource(static_cast<SensorType>(type));
         }
     }
@@ -214,6 +256,39 @@ public:
         return sources[index].manualOverride;
     }
 
+    /**
+     * @brief Get rejection count of a source
+     *
+     * @param index Source index
+     * @param reason Rejection reason to count
+     * @return Number of recordRejection() calls with @p reason
+     */
+    unsigned long getRejectionCount(int index, SourceRejection reason) const {
+        if (index < 0 || index >= sourceCount) {
+            return 0;
+        }
+        return reason == SourceRejection::INACTIVE ? sources[index].dropped : sources[index].rejected;
+    }
+
+    /**
+     * @brief Number of updateSourceQuality() calls for a source
+     *
+     * @param index Source index
+     * @param[out] fixQuality Last reported fix quality (optional)
+     * @param[out] satellites Last reported satellites (optional)
+     * @param[out] hdop Last reported HDOP (optional)
+     */
+    unsigned long getQualityReports(int index, uint8_t* fixQuality = nullptr, uint8_t* satellites = nullptr,
+                                    double* hdop = nullptr) const {
+        if (index < 0 || index >= sourceCount) {
+            return 0;
+        }
+        if (fixQuality != nullptr) *fixQuality = sources[index].fixQuality;
+        if (satellites != nullptr) *satellites = sources[index].satellites;
+        if (hdop != nullptr) *hdop = sources[index].hdop;
+        return sources[index].qualityReports;
+    }
+
 private:
     static const int MAX_SOURCES = 16;
     static const unsigned long STALE_THRESHOLD_MS = 5000;
@@ -225,6 +300,12 @@ private:
         unsigned long lastUpdate;
         bool available;
         bool manualOverride;
+        unsigned long rejected;
+        unsigned long dropped;
+        uint8_t fixQuality;
+        uint8_t satellites;
+        double hdop;
+        unsigned long qualityReports;
     };
 
     SourceInfo sources[MAX_SOURCES];
@@ -237,7 +318,7 @@ private:
      */
     void updateActiveSource(SensorType type) {
         // Simplified: just ensures consistency
-        // Real implementation would update manager.activeGpsSourceIndex etc.
+        // Real implementation would update manager.types[type].activeIndex
         getActiveSource(type);  // Calls prioritization logic
     }
 };
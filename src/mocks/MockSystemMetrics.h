@@ -30,6 +30,7 @@
 #define MOCK_SYSTEM_METRICS_H
 
 #include "hal/interfaces/ISystemMetrics.h"
+#include "config.h"
 
 /**
  * @brief Mock system metrics for testing
@@ -40,9 +41,14 @@
 class MockSystemMetrics : public ISystemMetrics {
 private:
     uint32_t _freeHeapBytes;
+    uint32_t _largestFreeBlockBytes;
+    uint32_t _minFreeHeapBytes;
+    uint32_t _heapAllocsPerSecond;
+    uint32_t _heapFreesPerSecond;
     uint32_t _sketchSizeBytes;
     uint32_t _freeFlashBytes;
     uint32_t _loopFrequency;
+    uint8_t _coreIdlePercent[2];
     unsigned long _millis;
 
 public:
@@ -51,9 +57,14 @@ public:
      */
     MockSystemMetrics()
         : _freeHeapBytes(250000),      // 244 KB free RAM (typical)
+          _largestFreeBlockBytes(110000),  // 107 KB largest block (typical, unfragmented)
+          _minFreeHeapBytes(200000),   // 195 KB low-water mark
+          _heapAllocsPerSecond(HEAP_RATE_UNKNOWN),
+          _heapFreesPerSecond(HEAP_RATE_UNKNOWN),
           _sketchSizeBytes(850000),    // 830 KB sketch size (typical)
           _freeFlashBytes(1000000),    // 976 KB free flash (typical)
           _loopFrequency(0),           // 0 Hz (not yet measured)
+          _coreIdlePercent{CPU_IDLE_UNKNOWN, CPU_IDLE_UNKNOWN},
           _millis(0) {
     }
 
@@ -62,9 +73,15 @@ public:
      */
     void reset() {
         _freeHeapBytes = 250000;
+        _largestFreeBlockBytes = 110000;
+        _minFreeHeapBytes = 200000;
+        _heapAllocsPerSecond = HEAP_RATE_UNKNOWN;
+        _heapFreesPerSecond = HEAP_RATE_UNKNOWN;
         _sketchSizeBytes = 850000;
         _freeFlashBytes = 1000000;
         _loopFrequency = 0;
+        _coreIdlePercent[0] = CPU_IDLE_UNKNOWN;
+        _coreIdlePercent[1] = CPU_IDLE_UNKNOWN;
         _millis = 0;
     }
 
@@ -78,6 +95,32 @@ public:
         _freeHeapBytes = bytes;
     }
 
+    /**
+     * @brief Set the largest free block
+     * @param bytes Largest allocatable block in bytes (<= free heap)
+     */
+    void setLargestFreeBlockBytes(uint32_t bytes) {
+        _largestFreeBlockBytes = bytes;
+    }
+
+    /**
+     * @brief Set the free heap low-water mark
+     * @param bytes Lowest free heap since boot in bytes
+     */
+    void setMinFreeHeapBytes(uint32_t bytes) {
+        _minFreeHeapBytes = bytes;
+    }
+
+    /**
+     * @brief Set the heap allocation and free rates
+     * @param allocs Allocations per second (HEAP_RATE_UNKNOWN = no hooks)
+     * @param frees Frees per second (HEAP_RATE_UNKNOWN = no hooks)
+     */
+    void setHeapRates(uint32_t allocs, uint32_t frees) {
+        _heapAllocsPerSecond = allocs;
+        _heapFreesPerSecond = frees;
+    }
+
     /**
      * @brief Set sketch size value
      * @param bytes Sketch size in bytes (500KB-1.5MB typical)
@@ -102,6 +145,26 @@ public:
         _loopFrequency = frequency;
     }
 
+    /**
+     * @brief Set the idle percentage of both cores
+     * @param percent 0-100, or CPU_IDLE_UNKNOWN
+     */
+    void setCpuIdlePercent(uint8_t percent) {
+        _coreIdlePercent[0] = percent;
+        _coreIdlePercent[1] = percent;
+    }
+
+    /**
+     * @brief Set the idle percentage of one core
+     * @param core 0 or 1
+     * @param percent 0-100, or CPU_IDLE_UNKNOWN
+     */
+    void setCoreIdlePercent(uint8_t core, uint8_t percent) {
+        if (core < 2) {
+            _coreIdlePercent[core] = percent;
+        }
+    }
+
     /**
      * @brief Set millis() timestamp
      * @param milliseconds Milliseconds since boot
@@ -124,6 +187,22 @@ public:
         return _freeHeapBytes;
     }
 
+    uint32_t getLargestFreeBlockBytes() override {
+        return _largestFreeBlockBytes;
+    }
+
+    uint32_t getMinFreeHeapBytes() override {
+        return _minFreeHeapBytes;
+    }
+
+    uint32_t getHeapAllocsPerSecond() override {
+        return _heapAllocsPerSecond;
+    }
+
+    uint32_t getHeapFreesPerSecond() override {
+        return _heapFreesPerSecond;
+    }
+
     uint32_t getSketchSizeBytes() override {
         return _sketchSizeBytes;
     }
@@ -136,6 +215,17 @@ public:
         return _loopFrequency;
     }
 
+    uint8_t getCpuIdlePercent() override {
+        if (_coreIdlePercent[0] == CPU_IDLE_UNKNOWN || _coreIdlePercent[1] == CPU_IDLE_UNKNOWN) {
+            return _coreIdlePercent[0] != CPU_IDLE_UNKNOWN ? _coreIdlePercent[0] : _coreIdlePercent[1];
+        }
+        return static_cast<uint8_t>((_coreIdlePercent[0] + _coreIdlePercent[1] + 1) / 2);
+    }
+
+    uint8_t getCoreIdlePercent(uint8_t core) override {
+        return core < 2 ? _coreIdlePercent[core] : CPU_IDLE_UNKNOWN;
+    }
+
     unsigned long getMillis() override {
         return _millis;
     }
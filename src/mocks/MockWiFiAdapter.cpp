@@ -13,7 +13,13 @@ MockWiFiAdapter::MockWiFiAdapter(bool shouldSucceed, unsigned long delay)
       ipAddress(""),
       rssi(0),
       shouldSucceed(shouldSucceed),
-      connectionDelay(delay) {
+      connectionDelay(delay),
+      channel(0),
+      directed(false),
+      staticIP(false),
+      accessPoint(false),
+      apStations(0) {
+    memset(bssid, 0, sizeof(bssid));
 }
 
 bool MockWiFiAdapter::begin(const char* ssid, const char* password) {
@@ -24,14 +30,37 @@ bool MockWiFiAdapter::begin(const char* ssid, const char* password) {
     currentSSID = String(ssid);
     currentPassword = String(password);
     currentStatus = WiFiStatus::IDLE;
+    directed = false;
+    // Scanned: report an access point as the radio would
+    const uint8_t scanned[6] = {0x02, 0x00, 0x00, 0x00, 0x00, 0x01};
+    memcpy(bssid, scanned, sizeof(bssid));
+    channel = 6;
 
-    // Simulate connection attempt
-    if (shouldSucceed) {
-        simulateConnectionSuccess();
-    } else {
-        simulateConnectionFailure();
+    simulateAttempt();
+    return true;
+}
+
+bool MockWiFiAdapter::beginDirected(const char* ssid, const char* password, uint8_t channel, const uint8_t bssid[6]) {
+    if (bssid == nullptr || channel == 0) {
+        return false;
+    }
+    if (ssid == nullptr || strlen(ssid) == 0) {
+        return false;
     }
 
+    currentSSID = String(ssid);
+    currentPassword = String(password);
+    currentStatus = WiFiStatus::IDLE;
+    directed = true;
+    memcpy(this->bssid, bssid, sizeof(this->bssid));
+    this->channel = channel;
+
+    simulateAttempt();
+    return true;
+}
+
+bool MockWiFiAdapter::setStaticIP(const WiFiStaticIP* config) {
+    staticIP = config != nullptr && config->enabled();
     return true;
 }
 
@@ -63,6 +92,35 @@ String MockWiFiAdapter::getSSID() {
     return currentSSID;
 }
 
+bool MockWiFiAdapter::getBSSID(uint8_t bssid[6]) {
+    if (currentStatus != WiFiStatus::CONNECTED) {
+        return false;
+    }
+    memcpy(bssid, this->bssid, sizeof(this->bssid));
+    return true;
+}
+
+uint8_t MockWiFiAdapter::getChannel() {
+    return currentStatus == WiFiStatus::CONNECTED ? channel : 0;
+}
+
+bool MockWiFiAdapter::startAccessPoint(const char* ssid, const char* password, uint8_t apChannel) {
+    (void)password;
+    (void)apChannel;
+    if (ssid == nullptr || strlen(ssid) == 0) {
+        return false;
+    }
+    accessPoint = true;
+    return true;
+}
+
+bool MockWiFiAdapter::stopAccessPoint() {
+    bool wasActive = accessPoint;
+    accessPoint = false;
+    apStations = 0;
+    return wasActive;
+}
+
 void MockWiFiAdapter::simulateConnectionSuccess(const char* ip, int signalStrength) {
     currentStatus = WiFiStatus::CONNECTED;
     ipAddress = String(ip);
@@ -75,6 +133,14 @@ void MockWiFiAdapter::simulateConnectionSuccess(const char* ip, int signalStreng
     }
 }
 
+void MockWiFiAdapter::simulateAttempt() {
+    if (shouldSucceed) {
+        simulateConnectionSuccess();
+    } else {
+        simulateConnectionFailure();
+    }
+}
+
 void MockWiFiAdapter::simulateConnectionFailure() {
     currentStatus = WiFiStatus::CONNECT_FAILED;
     ipAddress = "";
@@ -106,4 +172,10 @@ void MockWiFiAdapter::reset() {
     rssi = 0;
     shouldSucceed = true;
     connectionDelay = 0;
+    memset(bssid, 0, sizeof(bssid));
+    channel = 0;
+    directed = false;
+    staticIP = false;
+    accessPoint = false;
+    apStations = 0;
 }
@@ -28,6 +28,12 @@ private:
     int rssi;
     bool shouldSucceed;
     unsigned long connectionDelay; // Simulated connection time in ms
+    uint8_t bssid[6];              // Access point of the last attempt
+    uint8_t channel;               // Channel of the last attempt (0 = scanned)
+    bool directed;                 // Last attempt was beginDirected()
+    bool staticIP;                 // setStaticIP() with an address
+    bool accessPoint;              // startAccessPoint() without stopAccessPoint()
+    uint8_t apStations;            // Devices reported on the access point
 
 public:
     /**
@@ -39,12 +45,20 @@ public:
 
     // IWiFiAdapter interface implementation
     bool begin(const char* ssid, const char* password) override;
+    bool beginDirected(const char* ssid, const char* password, uint8_t channel, const uint8_t bssid[6]) override;
+    bool setStaticIP(const WiFiStaticIP* config) override;
     WiFiStatus status() override;
     bool disconnect() override;
     void onEvent(WiFiEventCallback callback) override;
     String getIPAddress() override;
     int getRSSI() override;
     String getSSID() override;
+    bool getBSSID(uint8_t bssid[6]) override;
+    uint8_t getChannel() override;
+    bool startAccessPoint(const char* ssid, const char* password, uint8_t channel) override;
+    bool stopAccessPoint() override;
+    uint8_t getAccessPointStations() override { return accessPoint ? apStations : 0; }
+    String getAccessPointIP() override { return String("192.168.4.1"); }
 
     // Test helper methods
     /**
@@ -70,10 +84,38 @@ public:
      */
     void setConnectionBehavior(bool succeed);
 
+    /**
+     * @brief Whether the last attempt skipped the scan
+     * @return true if it was started by beginDirected()
+     */
+    bool wasDirected() const { return directed; }
+
+    /**
+     * @brief Whether the next attempt uses a static address
+     * @return true if setStaticIP() was given an address
+     */
+    bool usesStaticIP() const { return staticIP; }
+
+    /**
+     * @brief Whether the access point is running
+     */
+    bool isAccessPointActive() const { return accessPoint; }
+
+    /**
+     * @brief Set the number of devices associated to the access point
+     */
+    void setAccessPointStations(uint8_t stations) { apStations = stations; }
+
     /**
      * @brief Reset mock to initial state
      */
     void reset();
+
+private:
+    /**
+     * @brief Complete an attempt according to the connection behavior
+     */
+    void simulateAttempt();
 };
 
 #endif // MOCK_WIFI_ADAPTER_H
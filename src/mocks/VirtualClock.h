@@ -0,0 +1,72 @@
+/**
+ * @file VirtualClock.h
+ * @brief Test-controlled time base for host timing and throughput tests
+ *
+ * Host tests define millis() and micros() from this clock, so every timing
+ * decision of the code under test (statistics intervals, source timeouts,
+ * fast-packet timeouts of the NMEA2000 library) follows the script of the
+ * test instead of the wall clock. Mocks that model transmission time
+ * (MockN2kCanBus, MockSerialPort pacing) advance the same clock.
+ *
+ * Usage in tests:
+ * @code
+ * unsigned long millis() { return GetVirtualClock().millis(); }
+ * unsigned long micros() { return GetVirtualClock().micros(); }
+ *
+ * GetVirtualClock().reset();
+ * GetVirtualClock().advanceUs(2500);
+ * TEST_ASSERT_EQUAL_UINT32(2, millis());
+ * @endcode
+ *
+ * @version 1.0.0
+ */
+
+#ifndef VIRTUAL_CLOCK_H
+#define VIRTUAL_CLOCK_H
+
+#include <stdint.h>
+
+/**
+ * @brief Microsecond clock that only moves when told to
+ *
+ * Counts in 64 bits and truncates like the Arduino core: micros() wraps
+ * after 71 minutes, millis() after 49.7 days. Wraparound tests start it just
+ * before either (resetMs(0xFFFFFFFF - 60000) = one minute before millis()
+ * wraps) and soak tests advance it by days.
+ */
+class VirtualClock {
+public:
+    VirtualClock() : nowUs_(0) {}
+
+    void reset(uint64_t nowUs = 0) { nowUs_ = nowUs; }
+    void resetMs(uint32_t nowMs) { nowUs_ = static_cast<uint64_t>(nowMs) * 1000; }
+    void advanceUs(uint32_t us) { nowUs_ += us; }
+    void advanceMs(uint32_t ms) { nowUs_ += static_cast<uint64_t>(ms) * 1000; }
+
+    /// Move forward to micros() == @p nowUs (never backwards; wraparound-safe)
+    void advanceTo(uint32_t nowUs) {
+        int32_t ahead = static_cast<int32_t>(nowUs - micros());
+        if (ahead > 0) {
+            nowUs_ += static_cast<uint32_t>(ahead);
+        }
+    }
+
+    uint32_t micros() const { return static_cast<uint32_t>(nowUs_); }
+    uint32_t millis() const { return static_cast<uint32_t>(nowUs_ / 1000); }
+
+    /// Time since reset(0), never wrapping
+    uint64_t elapsedUs() const { return nowUs_; }
+
+private:
+    uint64_t nowUs_;
+};
+
+/**
+ * @brief The clock shared by the mocks and the test's millis()/micros()
+ */
+inline VirtualClock& GetVirtualClock() {
+    static VirtualClock clock;
+    return clock;
+}
+
+#endif // VIRTUAL_CLOCK_H
@@ -0,0 +1,68 @@
+/**
+ * @file AisTypes.h
+ * @brief AIS position reports and the per-vessel target record
+ *
+ * An AisPositionReport is one decoded position message, whatever the bus:
+ * !AIVDM types 1/2/3 (class A) and 18 (class B) from NMEA 0183
+ * (AisVdmDecoder), or PGN 129038/129039 from NMEA2000. AisTargetTable
+ * keeps one AisTarget per MMSI from them. Units follow BoatData: decimal
+ * degrees, radians (true), knots.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef AIS_TYPES_H
+#define AIS_TYPES_H
+
+#include <stdint.h>
+
+#define AIS_CLASS_A 0
+#define AIS_CLASS_B 1
+
+#define AIS_NAV_STATUS_UNDEFINED 15  ///< Class B reports carry no navigational status
+
+/**
+ * @brief One decoded AIS position report
+ */
+struct AisPositionReport {
+    uint32_t mmsi;           ///< Maritime Mobile Service Identity (1..999999999)
+    double latitude;         ///< Decimal degrees
+    double longitude;
+    float cog;               ///< Course over ground, radians true [0, 2π), NaN = not available
+    float sog;               ///< Speed over ground, knots, NaN = not available
+    float heading;           ///< True heading, radians [0, 2π), NaN = not available
+    uint8_t navStatus;       ///< ITU-R M.1371 navigational status (AIS_NAV_STATUS_UNDEFINED = none)
+    uint8_t aisClass;        ///< AIS_CLASS_A or AIS_CLASS_B
+    uint32_t receivedMs;     ///< millis() when the report was received
+};
+
+/**
+ * @brief One tracked vessel (slot of AisTargetTable)
+ *
+ * range/bearing/cpa/tcpa are relative to the own ship at evaluatedMs, with
+ * both positions dead-reckoned to that time.
+ */
+struct AisTarget {
+    uint32_t mmsi;           ///< 0 = free slot
+    double latitude;         ///< Decimal degrees, at lastUpdate
+    double longitude;
+    float cog;               ///< Radians true, NaN = not available
+    float sog;               ///< Knots, NaN = not available
+    float heading;           ///< Radians true, NaN = not available
+    float range;             ///< Nautical miles, NaN = not evaluated
+    float bearing;           ///< True bearing from the own ship, radians [0, 2π)
+    float cpa;               ///< Closest point of approach, nautical miles
+    float tcpa;              ///< Seconds to the CPA (negative = CPA passed)
+    uint32_t lastUpdate;     ///< millis() of the last position report
+    uint32_t evaluatedMs;    ///< millis() of the last CPA/TCPA computation
+    uint32_t gridCell;       ///< Grid cell of the position (row << 16 | column)
+    uint16_t reports;        ///< Position reports received (saturating)
+    uint16_t gridNext;       ///< Next slot in the cell's grid bucket (AIS_NO_SLOT = last)
+    uint16_t evalEpoch;      ///< Evaluation pass that last computed this slot
+    uint8_t navStatus;
+    uint8_t aisClass;
+    bool dirty;              ///< Position changed since the last evaluation
+};
+
+#endif // AIS_TYPES_H
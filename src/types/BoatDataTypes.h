@@ -11,6 +11,9 @@
  * - Coordinates: decimal degrees
  * - Time: milliseconds (millis())
  *
+ * Precision: values are BoatScalar (double, or float with
+ * BOATDATA_FLOAT_STORAGE = 1); GPS latitude/longitude are always double.
+ *
  * Changes from v1.0.0:
  * - GPSData: Added variation field (moved from CompassData)
  * - CompassData: Added rateOfTurn, heelAngle, pitchAngle, heave; removed variation
@@ -28,7 +31,13 @@
 #ifndef BOATDATA_TYPES_H
 #define BOATDATA_TYPES_H
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
+#include <stdint.h>
+#include "../utils/SeqLock.h"
+#include "BoatScalar.h"
+#include "DampingConfig.h"
 
 // =============================================================================
 // ENUMERATIONS
@@ -40,9 +49,16 @@
 enum class SensorType : uint8_t {
     GPS = 0,      ///< GPS sensors (latitude, longitude, COG, SOG)
     COMPASS = 1,  ///< Compass sensors (heading, variation)
-    // Future: WIND, SPEED (if multi-source support needed)
+    WIND = 2,     ///< Wind sensors (apparent angle and speed)
+    DST = 3,      ///< Depth/speed/temperature transducers
+    RUDDER = 4,   ///< Rudder angle sensors
+    ENGINE = 5,   ///< Engine monitoring
+    BATTERY = 6,  ///< Battery monitoring
+    ATTITUDE = 7  ///< Heel and pitch (PGN 127257 senders, onboard IMU)
 };
 
+#define SENSOR_TYPE_COUNT 8  ///< Number of SensorType values
+
 /**
  * @brief Protocol type enumeration for source identification
  */
@@ -50,6 +66,7 @@ enum class ProtocolType : uint8_t {
     NMEA0183 = 0,  ///< NMEA 0183 (Serial)
     NMEA2000 = 1,  ///< NMEA 2000 (CAN bus)
     ONEWIRE = 2,   ///< 1-Wire sensors
+    I2C = 3,       ///< Onboard I2C sensors (IMU)
     UNKNOWN = 255  ///< Unknown/uninitialized protocol
 };
 
@@ -65,13 +82,19 @@ enum class ProtocolType : uint8_t {
  *
  * CHANGES v2.0.0:
  * - ADDED: double variation (magnetic variation from GPS)
+ *
+ * CHANGES v2.1.0:
+ * - ADDED: fixQuality, satellites, hdop (from NMEA2000 PGN 129029)
  */
 struct GPSData {
     double latitude;           ///< Decimal degrees, positive = North, range [-90, 90]
     double longitude;          ///< Decimal degrees, positive = East, range [-180, 180]
-    double cog;                ///< Course over ground, radians, range [0, 2π], true
-    double sog;                ///< Speed over ground, knots, range [0, 100]
-    double variation;          ///< Magnetic variation, radians, positive = East, negative = West (ADDED v2.0.0)
+    BoatScalar cog;            ///< Course over ground, radians, range [0, 2π], true
+    BoatScalar sog;            ///< Speed over ground, knots, range [0, 100]
+    BoatScalar variation;      ///< Magnetic variation, radians, positive = East, negative = West (ADDED v2.0.0)
+    uint8_t fixQuality;        ///< GNSS method: 0 = no fix, 1 = GNSS, 2 = DGNSS, 4 = RTK fixed... (ADDED v2.1.0)
+    uint8_t satellites;        ///< Satellites used in the fix (ADDED v2.1.0)
+    BoatScalar hdop;           ///< Horizontal dilution of precision, 0 = unknown (ADDED v2.1.0)
     bool available;            ///< Data validity flag
     unsigned long lastUpdate;  ///< millis() timestamp of last update
 };
@@ -90,12 +113,12 @@ struct GPSData {
  * - ADDED: double heave (meters)
  */
 struct CompassData {
-    double trueHeading;        ///< Radians, range [0, 2π]
-    double magneticHeading;    ///< Radians, range [0, 2π]
-    double rateOfTurn;         ///< Radians/second, positive = turning right (ADDED v2.0.0)
-    double heelAngle;          ///< Radians, range [-π/2, π/2], positive = starboard (ADDED v2.0.0)
-    double pitchAngle;         ///< Radians, range [-π/6, π/6], positive = bow up (ADDED v2.0.0)
-    double heave;              ///< Meters, range [-5.0, 5.0], positive = upward (ADDED v2.0.0)
+    BoatScalar trueHeading;    ///< Radians, range [0, 2π]
+    BoatScalar magneticHeading; ///< Radians, range [0, 2π]
+    BoatScalar rateOfTurn;     ///< Radians/second, positive = turning right (ADDED v2.0.0)
+    BoatScalar heelAngle;      ///< Radians, range [-π/2, π/2], positive = starboard (ADDED v2.0.0)
+    BoatScalar pitchAngle;     ///< Radians, range [-π/6, π/6], positive = bow up (ADDED v2.0.0)
+    BoatScalar heave;          ///< Meters, range [-5.0, 5.0], positive = upward (ADDED v2.0.0)
     bool available;            ///< Data validity flag
     unsigned long lastUpdate;  ///< millis() timestamp of last update
 };
@@ -107,8 +130,8 @@ struct CompassData {
  * Units: radians, knots
  */
 struct WindData {
-    double apparentWindAngle;  ///< AWA, radians, range [-π, π], positive = starboard, negative = port
-    double apparentWindSpeed;  ///< AWS, knots, range [0, 100]
+    BoatScalar apparentWindAngle;  ///< AWA, radians, range [-π, π], positive = starboard, negative = port
+    BoatScalar apparentWindSpeed;  ///< AWS, knots, range [0, 100]
     bool available;            ///< Data validity flag
     unsigned long lastUpdate;  ///< millis() timestamp of last update
 };
@@ -127,9 +150,9 @@ struct WindData {
  * - KEPT: double measuredBoatSpeed (changed from knots to m/s)
  */
 struct DSTData {
-    double depth;              ///< Depth below waterline, meters, range [0, 100] (ADDED v2.0.0)
-    double measuredBoatSpeed;  ///< Speed through water, m/s, range [0, 25] (changed from knots)
-    double seaTemperature;     ///< Water temperature, Celsius, range [-10, 50] (ADDED v2.0.0)
+    BoatScalar depth;          ///< Depth below waterline, meters, range [0, 100] (ADDED v2.0.0)
+    BoatScalar measuredBoatSpeed;  ///< Speed through water, m/s, range [0, 25] (changed from knots)
+    BoatScalar seaTemperature; ///< Water temperature, Celsius, range [-10, 50] (ADDED v2.0.0)
     bool available;            ///< Data validity flag
     unsigned long lastUpdate;  ///< millis() timestamp of last update
 };
@@ -141,7 +164,7 @@ struct DSTData {
  * Units: radians
  */
 struct RudderData {
-    double steeringAngle;      ///< Radians, range [-π/2, π/2], positive = starboard, negative = port
+    BoatScalar steeringAngle;  ///< Radians, range [-π/2, π/2], positive = starboard, negative = port
     bool available;            ///< Data validity flag
     unsigned long lastUpdate;  ///< millis() timestamp of last update
 };
@@ -153,13 +176,45 @@ struct RudderData {
  * Units: RPM, Celsius, volts
  */
 struct EngineData {
-    double engineRev;          ///< Engine RPM, range [0, 6000]
-    double oilTemperature;     ///< Oil temperature, Celsius, range [-10, 150]
-    double alternatorVoltage;  ///< Alternator output, volts, range [0, 30]
+    BoatScalar engineRev;      ///< Engine RPM, range [0, 6000]
+    BoatScalar oilTemperature; ///< Oil temperature, Celsius, range [-10, 150]
+    BoatScalar alternatorVoltage;  ///< Alternator output, volts, range [0, 30]
+    bool available;            ///< Data validity flag
+    unsigned long lastUpdate;  ///< millis() timestamp of last update
+};
+
+/**
+ * @brief Fluid level of one tank (PGN 127505)
+ *
+ * A tank is identified by its fluid type and instance together (fuel 0
+ * and fresh water 0 are different tanks).
+ * Units: percent, litres
+ */
+struct TankData {
+    uint8_t fluidType;         ///< tN2kFluidType: 0 fuel, 1 fresh water, 2 waste water, 3 live well, 4 oil, 5 black water, ...
+    uint8_t instance;          ///< Tank instance within its fluid type (0-15)
+    BoatScalar level;          ///< Percent full, range [0, 100]
+    BoatScalar capacity;       ///< Litres, range [0, 10000] (NaN = not reported)
     bool available;            ///< Data validity flag
     unsigned long lastUpdate;  ///< millis() timestamp of last update
 };
 
+/**
+ * @brief Per-instance engine and tank slots
+ *
+ * engines[i] holds engine instance i of PGN 127488/127489 (instances from
+ * BOATDATA_ENGINE_INSTANCES up are ignored). Tanks take the first free slot
+ * in the order their (fluid type, instance) is first seen.
+ * BoatDataStructure::engine stays the single-engine view
+ * (N2K_ENGINE_PRIMARY_INSTANCE) for consumers that know one engine.
+ */
+struct BoatDataInstances {
+    EngineData engines[BOATDATA_ENGINE_INSTANCES];
+    TankData tanks[BOATDATA_TANK_INSTANCES];
+    uint8_t enginesSeen;       ///< Bit n: engines[n] was written at least once
+    uint8_t tankCount;         ///< tanks[0 .. tankCount - 1] are assigned
+};
+
 /**
  * @brief Saildrive engagement status (NEW in v2.0.0)
  *
@@ -180,16 +235,16 @@ struct SaildriveData {
  */
 struct BatteryData {
     // Battery A (House Bank)
-    double voltageA;           ///< Volts, range [0, 30]
-    double amperageA;          ///< Amperes, range [-200, 200], positive = charging
-    double stateOfChargeA;     ///< Percent, range [0.0, 100.0]
+    BoatScalar voltageA;       ///< Volts, range [0, 30]
+    BoatScalar amperageA;      ///< Amperes, range [-200, 200], positive = charging
+    BoatScalar stateOfChargeA; ///< Percent, range [0.0, 100.0]
     bool shoreChargerOnA;      ///< true = shore charger active for Battery A
     bool engineChargerOnA;     ///< true = alternator charging Battery A
 
     // Battery B (Starter Bank)
-    double voltageB;           ///< Volts, range [0, 30]
-    double amperageB;          ///< Amperes, range [-200, 200], positive = charging
-    double stateOfChargeB;     ///< Percent, range [0.0, 100.0]
+    BoatScalar voltageB;       ///< Volts, range [0, 30]
+    BoatScalar amperageB;      ///< Amperes, range [-200, 200], positive = charging
+    BoatScalar stateOfChargeB; ///< Percent, range [0.0, 100.0]
     bool shoreChargerOnB;      ///< true = shore charger active for Battery B
     bool engineChargerOnB;     ///< true = alternator charging Battery B
 
@@ -206,7 +261,7 @@ struct BatteryData {
  */
 struct ShorePowerData {
     bool shorePowerOn;         ///< true = shore power connected and available
-    double power;              ///< Shore power draw, watts, range [0, 5000]
+    BoatScalar power;          ///< Shore power draw, watts, range [0, 5000]
     bool available;            ///< Data validity flag
     unsigned long lastUpdate;  ///< millis() timestamp of last update
 };
@@ -222,8 +277,9 @@ struct ShorePowerData {
  * Stored in /calibration.json on LittleFS.
  */
 struct CalibrationData {
-    double leewayCalibrationFactor;  ///< K factor in leeway formula, range (0, +∞), typical [0.1, 5.0]
-    double windAngleOffset;          ///< Radians, range [-2π, 2π], masthead misalignment correction
+    BoatScalar leewayCalibrationFactor;  ///< K factor in leeway formula, range (0, +∞), typical [0.1, 5.0]
+    BoatScalar windAngleOffset;          ///< Radians, range [-2π, 2π], masthead misalignment correction
+    DampingConfig damping;               ///< Filter time constants of the calculation inputs/outputs (0 = off)
     bool loaded;                     ///< True if loaded from flash, false if using defaults
 };
 
@@ -245,24 +301,44 @@ struct CalibrationData {
  */
 struct DerivedData {
     // Corrected apparent wind angles
-    double awaOffset;          ///< AWA corrected for masthead offset, radians, range [-π, π]
-    double awaHeel;            ///< AWA corrected for heel, radians, range [-π, π]
+    BoatScalar awaOffset;      ///< AWA corrected for masthead offset, radians, range [-π, π]
+    BoatScalar awaHeel;        ///< AWA corrected for heel, radians, range [-π, π]
 
     // Leeway and speed
-    double leeway;             ///< Leeway angle, radians, range [-π/4, π/4] (limited to ±45°)
-    double stw;                ///< Speed through water, knots, corrected for leeway
+    BoatScalar leeway;         ///< Leeway angle, radians, range [-π/4, π/4] (limited to ±45°)
+    BoatScalar stw;            ///< Speed through water, knots, corrected for leeway
 
     // True wind
-    double tws;                ///< True wind speed, knots, range [0, 100]
-    double twa;                ///< True wind angle, radians, range [-π, π], relative to boat heading
-    double wdir;               ///< Wind direction, radians, range [0, 2π], magnetic (true wind direction)
+    BoatScalar tws;            ///< True wind speed, knots, range [0, 100]
+    BoatScalar twa;            ///< True wind angle, radians, range [-π, π], relative to boat heading
+    BoatScalar wdir;           ///< Wind direction, radians, range [0, 2π], magnetic (true wind direction)
 
     // Performance
-    double vmg;                ///< Velocity made good, knots, signed (negative = away from wind)
+    BoatScalar vmg;            ///< Velocity made good, knots, signed (negative = away from wind)
 
     // Current
-    double soc;                ///< Speed of current, knots, range [0, 20]
-    double doc;                ///< Direction of current, radians, range [0, 2π], magnetic (direction current flows TO)
+    BoatScalar soc;            ///< Speed of current, knots, range [0, 20]
+    BoatScalar doc;            ///< Direction of current, radians, range [0, 2π], magnetic (direction current flows TO)
+
+    // Polar targets (NaN without a loaded polar, see PolarTable.h)
+    BoatScalar polarSpeed;     ///< Target boat speed at the current TWS/TWA, knots
+    BoatScalar polarPerformance;  ///< STW / polarSpeed, percent
+    BoatScalar targetTwa;      ///< Best-VMG TWA on the current tack and leg, radians, range [-π, π]
+    BoatScalar targetVmg;      ///< VMG at targetTwa, knots, signed like vmg
+
+    // Running statistics over 10 s / 1 min / 10 min (float in every build; NaN until a window has samples, see DerivedStatistics.h)
+    float twsAvg10s;           ///< Mean TWS, knots
+    float twsAvg1m;
+    float twsAvg10m;
+    float wdirAvg10s;          ///< Circular mean wind direction, radians, range [0, 2π], magnetic
+    float wdirAvg1m;
+    float wdirAvg10m;
+    float vmgAvg10s;           ///< Mean VMG, knots, signed
+    float vmgAvg1m;
+    float vmgAvg10m;
+    float gust10s;             ///< Maximum TWS, knots
+    float gust1m;
+    float gust10m;
 
     bool available;            ///< True if calculation completed successfully
     unsigned long lastUpdate;  ///< millis() timestamp of last calculation cycle
@@ -282,8 +358,36 @@ struct DiagnosticData {
     unsigned long nmea2000MessageCount;      ///< Total NMEA 2000 messages received
     unsigned long actisenseMessageCount;     ///< Total Actisense messages received
     unsigned long calculationCount;          ///< Total calculation cycles completed
-    unsigned long calculationOverruns;       ///< Count of cycles exceeding 200ms
+    unsigned long calculationOverruns;       ///< Count of cycles exceeding CALC_DEADLINE_US (deadline misses)
     unsigned long lastCalculationDuration;   ///< Duration of last calculation cycle (microseconds)
+    unsigned long maxCalculationDuration;    ///< Longest calculation cycle since startup (microseconds)
+    unsigned long lastCalculationPeriod;     ///< Start-to-start time of the last two cycles (microseconds)
+    unsigned long lastCalculationLatency;    ///< Input change to derived output, last cycle (microseconds)
+    unsigned long maxCalculationLatency;     ///< Largest lastCalculationLatency since startup (microseconds)
+};
+
+/**
+ * @brief Per-group sequence counters (see SeqLock)
+ *
+ * Every write to a group goes through its counter, so readers on another
+ * core take consistent snapshots and compare versions without a mutex.
+ * Diagnostic counters are single words and are not versioned.
+ *
+ * Memory footprint: 22 bytes
+ */
+struct BoatDataVersions {
+    SeqLock gps;
+    SeqLock compass;
+    SeqLock wind;
+    SeqLock dst;
+    SeqLock rudder;
+    SeqLock engine;
+    SeqLock saildrive;
+    SeqLock battery;
+    SeqLock shorePower;
+    SeqLock calibration;
+    SeqLock derived;
+    SeqLock instances;
 };
 
 // =============================================================================
@@ -296,8 +400,9 @@ struct DiagnosticData {
  * Statically allocated structure containing all sensor data,
  * derived parameters, calibration, and diagnostics.
  *
- * Thread safety: Single-threaded (ReactESP event loop)
- * Memory footprint: ~560 bytes (up from ~304 bytes in v1.0.0)
+ * Thread safety: one writer (main loop); readers on other tasks snapshot
+ * groups through versions (BoatDataVersions)
+ * Memory footprint: ~584 bytes (up from ~304 bytes in v1.0.0)
  *
  * CHANGES v2.0.0:
  * - RENAMED: SpeedData speed → DSTData dst
@@ -319,6 +424,117 @@ struct BoatDataStructure {
     CalibrationData calibration;   ///< Calibration parameters (unchanged)
     DerivedData derived;           ///< Calculated sailing parameters (unchanged)
     DiagnosticData diagnostics;    ///< Diagnostic counters (unchanged)
+    BoatDataInstances instances;   ///< Engines and tanks by instance (BoatDataGroup::ENGINE)
+    BoatDataVersions versions;     ///< Seqlock counter per group (NEW)
+};
+
+// =============================================================================
+// PARTIAL UPDATE FIELD MASKS
+// =============================================================================
+
+/**
+ * @brief Field selectors for BoatData::patchGPS()
+ */
+namespace GPSField {
+    constexpr uint8_t LATITUDE = 1 << 0;
+    constexpr uint8_t LONGITUDE = 1 << 1;
+    constexpr uint8_t COG = 1 << 2;
+    constexpr uint8_t SOG = 1 << 3;
+    constexpr uint8_t VARIATION = 1 << 4;
+    constexpr uint8_t FIX_QUALITY = 1 << 5;
+    constexpr uint8_t SATELLITES = 1 << 6;
+    constexpr uint8_t HDOP = 1 << 7;
+}
+
+/**
+ * @brief Field selectors for BoatData::patchCompass()
+ */
+namespace CompassField {
+    constexpr uint8_t TRUE_HEADING = 1 << 0;
+    constexpr uint8_t MAGNETIC_HEADING = 1 << 1;
+    constexpr uint8_t RATE_OF_TURN = 1 << 2;
+    constexpr uint8_t HEEL_ANGLE = 1 << 3;
+    constexpr uint8_t PITCH_ANGLE = 1 << 4;
+    constexpr uint8_t HEAVE = 1 << 5;
+}
+
+/**
+ * @brief Field selectors for BoatData::patchWind()
+ */
+namespace WindField {
+    constexpr uint8_t APPARENT_ANGLE = 1 << 0;
+    constexpr uint8_t APPARENT_SPEED = 1 << 1;
+}
+
+/**
+ * @brief Field selectors for BoatData::patchDST()
+ */
+namespace DSTField {
+    constexpr uint8_t DEPTH = 1 << 0;
+    constexpr uint8_t BOAT_SPEED = 1 << 1;
+    constexpr uint8_t SEA_TEMPERATURE = 1 << 2;
+}
+
+/**
+ * @brief Field selectors for BoatData::patchEngine()
+ */
+namespace EngineField {
+    constexpr uint8_t ENGINE_REV = 1 << 0;
+    constexpr uint8_t OIL_TEMPERATURE = 1 << 1;
+    constexpr uint8_t ALTERNATOR_VOLTAGE = 1 << 2;
+}
+
+/**
+ * @brief Field selectors for BoatData::patchTank()
+ */
+namespace TankField {
+    constexpr uint8_t LEVEL = 1 << 0;
+    constexpr uint8_t CAPACITY = 1 << 1;
+}
+
+/**
+ * @brief Field selectors for BoatData::patchBattery()
+ */
+namespace BatteryField {
+    constexpr uint16_t VOLTAGE_A = 1 << 0;
+    constexpr uint16_t AMPERAGE_A = 1 << 1;
+    constexpr uint16_t SOC_A = 1 << 2;
+    constexpr uint16_t SHORE_CHARGER_A = 1 << 3;
+    constexpr uint16_t ENGINE_CHARGER_A = 1 << 4;
+    constexpr uint16_t VOLTAGE_B = 1 << 5;
+    constexpr uint16_t AMPERAGE_B = 1 << 6;
+    constexpr uint16_t SOC_B = 1 << 7;
+    constexpr uint16_t SHORE_CHARGER_B = 1 << 8;
+    constexpr uint16_t ENGINE_CHARGER_B = 1 << 9;
+}
+
+/**
+ * @brief One queued partial update (see BoatData::deferPatches())
+ *
+ * Carries the same arguments as a patchGPS()/patchCompass()/... call plus
+ * the millis() timestamp at which the update was produced and, for GPS and
+ * compass, the producing source (blended in SourceFusionMode::BLEND).
+ */
+struct BoatDataPatch {
+    enum class Group : uint8_t { GPS, COMPASS, WIND, DST, ENGINE, BATTERY, TANK };
+
+    Group group;               ///< Sensor group the fields belong to
+    uint8_t instance;          ///< ENGINE: engine instance (TANK: key in tank.fluidType/instance)
+    uint16_t fields;           ///< GPSField / CompassField / ... bitmask
+    unsigned long timestamp;   ///< millis() when the update was produced
+    uint32_t producedUs;       ///< micros() when the update was produced (latency stats)
+    int8_t source;             ///< Prioritizer source index of the producer (-1 = unarbitrated)
+    bool sourceActive;         ///< Producer was the active source of its type when the patch was made
+    float sourceWeight;        ///< Producer's blend weight (quality 0-1) when the patch was made
+    union {
+        GPSData gps;
+        CompassData compass;
+        WindData wind;
+        DSTData dst;
+        EngineData engine;
+        BatteryData battery;
+        TankData tank;
+    };
 };
 
 // =============================================================================
@@ -329,14 +545,15 @@ struct BoatDataStructure {
  * @brief Sensor source metadata for multi-source prioritization
  *
  * Tracks multiple sources for the same sensor type (e.g., GPS-A, GPS-B).
- * Automatic priority based on update frequency, manual override supported.
+ * Automatic priority based on update frequency weighted by quality, manual
+ * override supported.
  *
- * Memory footprint: ~100 bytes per source
+ * Memory footprint: ~130 bytes per source
  */
 struct SensorSource {
     // Identification
     char sourceId[16];             ///< Human-readable ID (e.g., "GPS-NMEA2000", "GPS-NMEA0183")
-    SensorType sensorType;         ///< Sensor type (GPS, COMPASS)
+    SensorType sensorType;         ///< Sensor type (GPS, COMPASS, WIND, ...)
     ProtocolType protocolType;     ///< Protocol type (NMEA0183, NMEA2000, ONEWIRE)
 
     // Priority & Availability
@@ -352,31 +569,56 @@ struct SensorSource {
 
     // Statistics (for diagnostics)
     unsigned long rejectedCount;   ///< Count of invalid/outlier readings rejected
-    double avgUpdateInterval;      ///< Average time between updates (ms)
+    unsigned long droppedCount;    ///< Updates dropped while another source was active
+    unsigned long outlierCount;    ///< Of rejectedCount: flagged as outliers against the recent history
+    double avgUpdateInterval;      ///< Average time between updates (ms, EWMA)
+    double intervalJitter;         ///< Average deviation of an interval from avgUpdateInterval (ms, EWMA)
+    double rejectionRate;          ///< Share of recent updates rejected as invalid (EWMA, 0-1)
+
+    // Quality (GPS fix details, see ISourcePrioritizer::updateSourceQuality())
+    bool qualityReported;          ///< Fix details received at least once
+    uint8_t fixQuality;            ///< Last GNSS method (0 = no fix, 1 = GNSS, 2 = DGNSS, 4/5 = RTK)
+    uint8_t satellites;            ///< Last satellites used (0 = unknown)
+    double hdop;                   ///< Last HDOP (<= 0 = unknown)
+    double quality;                ///< Quality factor of the last recomputation (0-1)
+    double score;                  ///< Selection score of the last recomputation (rate × quality)
 };
 
 /**
- * @brief Source management arrays (static allocation)
+ * @brief Source management tables (static allocation)
+ */
+#define MAX_SENSOR_SOURCES 16    ///< Sources of all sensor types together
+#define MAX_SOURCES_PER_TYPE 5   ///< Sources competing for one sensor type
+#define SOURCE_LOOKUP_SLOTS 32   ///< sourceId hash slots (power of two, > MAX_SENSOR_SOURCES)
+
+/**
+ * @brief Sources competing for one sensor type
  */
-#define MAX_GPS_SOURCES 5
-#define MAX_COMPASS_SOURCES 5
+struct SourceTypeList {
+    int8_t members[MAX_SOURCES_PER_TYPE];  ///< Source indices in registration order
+    uint8_t count;                         ///< Registered sources of this type (0-5)
+    int8_t activeIndex;                    ///< Source index of the current primary source (-1 = none)
+    unsigned long activeSince;             ///< millis() when the active source was selected
+};
 
 /**
  * @brief Source manager structure
  *
- * Manages multiple sources for GPS and compass sensors.
- * Memory footprint: ~1050 bytes (10 sources * 100 bytes + metadata)
+ * One flat table of sources of every sensor type, indexed by the source
+ * index returned from registration, plus per-type member lists and an
+ * open-addressing (sensor type, sourceId) hash for constant-time lookup.
+ * Memory footprint: ~2.4 KB (16 sources * 130 bytes + lists and hash)
  */
 struct SourceManager {
-    SensorSource gpsSources[MAX_GPS_SOURCES];       ///< GPS source array
-    int gpsSourceCount;                             ///< Active GPS sources (0-5)
-    int activeGpsSourceIndex;                       ///< Index of current primary GPS source (-1 = none)
+    SensorSource sources[MAX_SENSOR_SOURCES];      ///< Flat source table
+    uint32_t idHashes[MAX_SENSOR_SOURCES];         ///< Hash of each source's (type, sourceId)
+    int sourceCount;                               ///< Registered sources (0-16)
+
+    SourceTypeList types[SENSOR_TYPE_COUNT];       ///< Per-type member lists, indexed by SensorType
 
-    SensorSource compassSources[MAX_COMPASS_SOURCES];  ///< Compass source array
-    int compassSourceCount;                         ///< Active compass sources (0-5)
-    int activeCompassSourceIndex;                   ///< Index of current primary compass source (-1 = none)
+    int8_t lookupSlots[SOURCE_LOOKUP_SLOTS];       ///< Source index per hash slot (-1 = empty)
 
-    unsigned long lastPriorityUpdate;               ///< millis() timestamp of last priority recalculation
+    unsigned long lastPriorityUpdate;              ///< millis() timestamp of last priority recalculation
 };
 
 // =============================================================================
@@ -399,6 +641,7 @@ struct CalibrationParameters {
     // === Parameters ===
     double leewayCalibrationFactor;  ///< K factor in leeway formula, range (0, +∞)
     double windAngleOffset;          ///< Masthead misalignment correction, radians (internal), range [-2π, 2π]
+    DampingConfig damping;           ///< Filter time constants, seconds, [0, DAMPING_MAX_TIME_CONSTANT_S]
 
     // === Metadata ===
     unsigned long version;           ///< Config format version (1)
@@ -0,0 +1,43 @@
+/**
+ * @file BoatScalar.h
+ * @brief Build-time storage precision for BoatData sensor and derived values
+ *
+ * BoatScalar is double by default. Building with BOATDATA_FLOAT_STORAGE = 1
+ * makes it float, so BoatDataStructure fields (except GPS latitude and
+ * longitude, which need double for metre resolution) and the math in
+ * CalculationEngine, DataValidator and AngleUtils run on the ESP32's
+ * single-precision FPU instead of software double emulation.
+ *
+ * Code generic over the precision uses BoatScalar for values, the
+ * BoatMath constants instead of M_PI, BoatScalar(x) instead of bare double
+ * literals, and the std:: math overloads (std::sin(float) is sinf).
+ * Build with -Wdouble-promotion to find accidental double math.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOAT_SCALAR_H
+#define BOAT_SCALAR_H
+
+#include <type_traits>
+#include "../config.h"
+
+/**
+ * @brief Storage and math type of BoatData values (float or double)
+ */
+typedef std::conditional<BOATDATA_FLOAT_STORAGE != 0, float, double>::type BoatScalar;
+
+/**
+ * @brief Angle constants in BoatScalar precision
+ *
+ * Named *_RAD because Arduino.h defines PI, HALF_PI and TWO_PI as macros.
+ */
+namespace BoatMath {
+    constexpr BoatScalar PI_RAD = static_cast<BoatScalar>(3.14159265358979323846);
+    constexpr BoatScalar TWO_PI_RAD = static_cast<BoatScalar>(6.28318530717958647692);
+    constexpr BoatScalar HALF_PI_RAD = static_cast<BoatScalar>(1.57079632679489661923);
+    constexpr BoatScalar QUARTER_PI_RAD = static_cast<BoatScalar>(0.78539816339744830962);
+}
+
+#endif // BOAT_SCALAR_H
@@ -0,0 +1,59 @@
+/**
+ * @file DampingConfig.h
+ * @brief Per-field damping settings of the calculation filter stage
+ *
+ * The filtered fields are listed once in BOATDATA_DAMPING_FIELDS (ID, JSON
+ * key under "damping" in /calibration.json, kind). Inputs are filtered
+ * before CalculationEngine uses them, outputs after they are calculated:
+ * - SCALAR: exponential moving average (or 1D Kalman, see kalmanMask)
+ * - SIGNED_ANGLE / BEARING: circular mean of sin/cos, returned in
+ *   [-π, π] / [0, 2π]
+ *
+ * A time constant of 0 disables the filter for that field (default), so an
+ * unconfigured boat sees unfiltered values.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef DAMPING_CONFIG_H
+#define DAMPING_CONFIG_H
+
+#include <stdint.h>
+
+#define DAMPING_KIND_SCALAR 0
+#define DAMPING_KIND_SIGNED_ANGLE 1
+#define DAMPING_KIND_BEARING 2
+
+// X(ID, key, kind)
+#define BOATDATA_DAMPING_FIELDS(X)        \
+    X(AWA, awa, SIGNED_ANGLE)             \
+    X(AWS, aws, SCALAR)                   \
+    X(BOAT_SPEED, boatSpeed, SCALAR)      \
+    X(HEADING, heading, BEARING)          \
+    X(HEEL, heel, SCALAR)                 \
+    X(TWS, tws, SCALAR)                   \
+    X(TWA, twa, SIGNED_ANGLE)             \
+    X(WDIR, wdir, BEARING)                \
+    X(VMG, vmg, SCALAR)                   \
+    X(SOC, soc, SCALAR)                   \
+    X(DOC, doc, BEARING)
+
+enum DampingField : uint8_t {
+#define BOATDATA_DAMPING_ENUM(id, key, kind) DAMPING_##id,
+    BOATDATA_DAMPING_FIELDS(BOATDATA_DAMPING_ENUM)
+#undef BOATDATA_DAMPING_ENUM
+    DAMPING_FIELD_COUNT
+};
+
+/**
+ * @brief Damping time constants (part of the calibration)
+ *
+ * Memory footprint: 48 bytes
+ */
+struct DampingConfig {
+    float timeConstant[DAMPING_FIELD_COUNT];  ///< Seconds, [0, DAMPING_MAX_TIME_CONSTANT_S], 0 = off
+    uint16_t kalmanMask;                      ///< Bit (1 << DampingField): SCALAR field uses the Kalman filter
+};
+
+#endif // DAMPING_CONFIG_H
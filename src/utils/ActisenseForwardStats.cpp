@@ -0,0 +1,49 @@
+/**
+ * @file ActisenseForwardStats.cpp
+ * @brief Implementation of the Actisense forward admission counters
+ *
+ * @see ActisenseForwardStats.h
+ */
+
+#include "ActisenseForwardStats.h"
+
+ActisenseForwardStats::ActisenseForwardStats()
+    : frames_(0),
+      bytes_(0),
+      dropped_(0),
+      droppedBytes_(0),
+      highWater_(0) {
+}
+
+bool ActisenseForwardStats::admit(size_t bytes, size_t freeBytes, size_t capacity) {
+    if (bytes == 0) {
+        return false;
+    }
+    if (freeBytes < bytes) {
+        dropped_++;
+        droppedBytes_ += static_cast<uint32_t>(bytes);
+        return false;
+    }
+
+    uint32_t queued = freeBytes < capacity ? static_cast<uint32_t>(capacity - freeBytes) : 0;
+    if (queued > highWater_) {
+        highWater_ = queued;
+    }
+    frames_++;
+    bytes_ += static_cast<uint32_t>(bytes);
+    return true;
+}
+
+void ActisenseForwardStats::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("frames", (unsigned long)frames_)
+        .add("bytes", (unsigned long)bytes_)
+        .add("dropped", (unsigned long)dropped_)
+        .add("dropped_bytes", (unsigned long)droppedBytes_)
+        .add("tx_high_water", (unsigned long)highWater_)
+        .endObject();
+}
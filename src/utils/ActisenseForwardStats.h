@@ -0,0 +1,75 @@
+/**
+ * @file ActisenseForwardStats.h
+ * @brief Whole-message admission and counters of the Actisense serial forward
+ *
+ * The NMEA2000 library hands each forwarded message to its stream as one
+ * Actisense NGT frame (DLE STX ... DLE ETX) in a single write. The forward
+ * must never stall the receive context, so a frame is only queued when the
+ * UART TX ring has room for all of it; otherwise it is dropped whole and
+ * counted. A reader (canboat actisense-serial / analyzer) then loses complete
+ * messages only, never half a frame that would desynchronise its parser.
+ *
+ * Arduino-free (free space is passed in, unit tested natively).
+ * Receive context; counters are read by the main loop without locking.
+ *
+ * Usage:
+ * @code
+ * size_t write(const uint8_t* data, size_t size) {
+ *     if (!stats.admit(size, serial.availableForWrite(), TX_RING_BYTES)) return 0;
+ *     return serial.write(data, size);
+ * }
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ACTISENSE_FORWARD_STATS_H
+#define ACTISENSE_FORWARD_STATS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "JsonWriter.h"
+
+/**
+ * @class ActisenseForwardStats
+ * @brief Drop-or-queue decision per frame, with sent/dropped counters and ring high water
+ */
+class ActisenseForwardStats {
+public:
+    ActisenseForwardStats();
+
+    /**
+     * @brief Decide whether a frame of @p bytes may be queued
+     *
+     * @param bytes Encoded frame length (escapes included)
+     * @param freeBytes Free space of the TX ring right now
+     * @param capacity Size of the TX ring (for the high water)
+     * @return true to write the frame, false if it was dropped (counted)
+     */
+    bool admit(size_t bytes, size_t freeBytes, size_t capacity);
+
+    uint32_t getFrames() const { return frames_; }
+    uint32_t getBytes() const { return bytes_; }
+    uint32_t getDropped() const { return dropped_; }
+    uint32_t getDroppedBytes() const { return droppedBytes_; }
+
+    /// Deepest TX ring fill seen before a frame was queued (bytes)
+    uint32_t getHighWater() const { return highWater_; }
+
+    /**
+     * @brief Write the counters as a JSON object
+     *
+     * {"frames":81234,"bytes":2143110,"dropped":12,"dropped_bytes":310,"tx_high_water":3990}
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    uint32_t frames_;
+    uint32_t bytes_;
+    uint32_t dropped_;
+    uint32_t droppedBytes_;
+    uint32_t highWater_;
+};
+
+#endif // ACTISENSE_FORWARD_STATS_H
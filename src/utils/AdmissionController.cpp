@@ -0,0 +1,188 @@
+/**
+ * @file AdmissionController.cpp
+ * @brief Implementation of the connection admission controller
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "AdmissionController.h"
+#include <string.h>
+
+namespace {
+
+const char* const ENDPOINT_NAMES[] = {
+#define ADMISSION_ENDPOINT_NAME(id, name, path, limit) name,
+    ADMISSION_ENDPOINT_LIST(ADMISSION_ENDPOINT_NAME)
+#undef ADMISSION_ENDPOINT_NAME
+};
+
+const uint8_t ENDPOINT_LIMITS[] = {
+#define ADMISSION_ENDPOINT_LIMIT(id, name, path, limit) limit,
+    ADMISSION_ENDPOINT_LIST(ADMISSION_ENDPOINT_LIMIT)
+#undef ADMISSION_ENDPOINT_LIMIT
+};
+
+const char* const ENDPOINT_PATHS[] = {
+#define ADMISSION_ENDPOINT_PATH(id, name, path, limit) path,
+    ADMISSION_ENDPOINT_LIST(ADMISSION_ENDPOINT_PATH)
+#undef ADMISSION_ENDPOINT_PATH
+};
+
+const char* const RESULT_NAMES[] = {"admitted", "endpoint_full", "global_full", "low_heap"};
+
+inline uint8_t indexOf(AdmissionEndpoint endpoint) {
+    return static_cast<uint8_t>(endpoint);
+}
+
+}  // namespace
+
+const char* AdmissionResultName(AdmissionResult result) {
+    uint8_t index = static_cast<uint8_t>(result);
+    return index < sizeof(RESULT_NAMES) / sizeof(RESULT_NAMES[0]) ? RESULT_NAMES[index] : "unknown";
+}
+
+const char* AdmissionEndpointName(AdmissionEndpoint endpoint) {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    return index < sizeof(ENDPOINT_NAMES) / sizeof(ENDPOINT_NAMES[0]) ? ENDPOINT_NAMES[index] : "unknown";
+}
+
+AdmissionController::AdmissionController() {
+    for (uint8_t i = 0; i < ENDPOINT_COUNT; i++) {
+        clients_[i].store(0, std::memory_order_relaxed);
+        admitted_[i].store(0, std::memory_order_relaxed);
+        rejected_[i].store(0, std::memory_order_relaxed);
+    }
+    for (uint8_t i = 0; i < REASON_COUNT; i++) {
+        reasons_[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+AdmissionResult AdmissionController::admit(AdmissionEndpoint endpoint, uint32_t freeHeap) {
+    uint8_t index = indexOf(endpoint);
+    if (index >= ENDPOINT_COUNT) {
+        return AdmissionResult::ENDPOINT_FULL;
+    }
+
+    AdmissionResult result = AdmissionResult::ADMITTED;
+    if (freeHeap < ADMISSION_HEAP_RESERVE) {
+        result = AdmissionResult::LOW_HEAP;
+    } else if (ENDPOINT_LIMITS[index] > 0) {
+        if (clients_[index].load(std::memory_order_relaxed) >= ENDPOINT_LIMITS[index]) {
+            result = AdmissionResult::ENDPOINT_FULL;
+        } else if (getTotalClients() >= connectionBudget(freeHeap)) {
+            result = AdmissionResult::GLOBAL_FULL;
+        }
+    }
+
+    if (result == AdmissionResult::ADMITTED) {
+        admitted_[index].fetch_add(1, std::memory_order_relaxed);
+    } else {
+        rejected_[index].fetch_add(1, std::memory_order_relaxed);
+        reasons_[static_cast<uint8_t>(result)].fetch_add(1, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+bool AdmissionController::opened(AdmissionEndpoint endpoint) {
+    uint8_t index = indexOf(endpoint);
+    if (index >= ENDPOINT_COUNT || ENDPOINT_LIMITS[index] == 0) {
+        return true;
+    }
+    uint16_t now = clients_[index].fetch_add(1, std::memory_order_relaxed) + 1;
+    return now <= ENDPOINT_LIMITS[index];
+}
+
+void AdmissionController::closed(AdmissionEndpoint endpoint) {
+    uint8_t index = indexOf(endpoint);
+    if (index >= ENDPOINT_COUNT || ENDPOINT_LIMITS[index] == 0) {
+        return;
+    }
+    // A disconnect without a matching connect (not seen before begin()) must not wrap
+    uint16_t current = clients_[index].load(std::memory_order_relaxed);
+    while (current > 0 &&
+           !clients_[index].compare_exchange_weak(current, current - 1, std::memory_order_relaxed)) {
+    }
+}
+
+AdmissionEndpoint AdmissionController::endpointFor(const char* path, bool upgrade) {
+    if (upgrade && path != nullptr) {
+        for (uint8_t i = 0; i < ENDPOINT_COUNT; i++) {
+            if (ENDPOINT_LIMITS[i] > 0 && strcmp(path, ENDPOINT_PATHS[i]) == 0) {
+                return static_cast<AdmissionEndpoint>(i);
+            }
+        }
+    }
+    return AdmissionEndpoint::HTTP;
+}
+
+uint16_t AdmissionController::connectionBudget(uint32_t freeHeap) {
+    if (freeHeap <= ADMISSION_HEAP_RESERVE) {
+        return 0;
+    }
+    uint32_t budget = (freeHeap - ADMISSION_HEAP_RESERVE) / ADMISSION_BYTES_PER_CLIENT;
+    return budget < ADMISSION_MAX_CLIENTS ? static_cast<uint16_t>(budget) : ADMISSION_MAX_CLIENTS;
+}
+
+uint8_t AdmissionController::getLimit(AdmissionEndpoint endpoint) const {
+    uint8_t index = indexOf(endpoint);
+    return index < ENDPOINT_COUNT ? ENDPOINT_LIMITS[index] : 0;
+}
+
+uint16_t AdmissionController::getClients(AdmissionEndpoint endpoint) const {
+    uint8_t index = indexOf(endpoint);
+    return index < ENDPOINT_COUNT ? clients_[index].load(std::memory_order_relaxed) : 0;
+}
+
+uint16_t AdmissionController::getTotalClients() const {
+    uint16_t total = 0;
+    for (uint8_t i = 0; i < ENDPOINT_COUNT; i++) {
+        total += clients_[i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint32_t AdmissionController::getAdmitted(AdmissionEndpoint endpoint) const {
+    uint8_t index = indexOf(endpoint);
+    return index < ENDPOINT_COUNT ? admitted_[index].load(std::memory_order_relaxed) : 0;
+}
+
+uint32_t AdmissionController::getRejected(AdmissionEndpoint endpoint) const {
+    uint8_t index = indexOf(endpoint);
+    return index < ENDPOINT_COUNT ? rejected_[index].load(std::memory_order_relaxed) : 0;
+}
+
+uint32_t AdmissionController::getRejected(AdmissionResult result) const {
+    uint8_t index = static_cast<uint8_t>(result);
+    return index > 0 && index < REASON_COUNT ? reasons_[index].load(std::memory_order_relaxed) : 0;
+}
+
+void AdmissionController::writeJson(JsonWriter& json, uint32_t freeHeap, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("budget", (unsigned int)connectionBudget(freeHeap))
+        .add("clients", (unsigned int)getTotalClients());
+    for (uint8_t i = 0; i < ENDPOINT_COUNT; i++) {
+        json.beginObject(ENDPOINT_NAMES[i]);
+        if (ENDPOINT_LIMITS[i] > 0) {
+            json.add("clients", (unsigned int)clients_[i].load(std::memory_order_relaxed))
+                .add("limit", (unsigned int)ENDPOINT_LIMITS[i]);
+        }
+        json.add("admitted", (unsigned long)admitted_[i].load(std::memory_order_relaxed))
+            .add("rejected", (unsigned long)rejected_[i].load(std::memory_order_relaxed))
+            .endObject();
+    }
+    json.beginObject("rejected");
+    for (uint8_t i = 1; i < REASON_COUNT; i++) {
+        json.add(RESULT_NAMES[i], (unsigned long)reasons_[i].load(std::memory_order_relaxed));
+    }
+    json.endObject().endObject();
+}
+
+AdmissionController& GetAdmissionController() {
+    static AdmissionController admissionController;
+    return admissionController;
+}
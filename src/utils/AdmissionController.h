@@ -0,0 +1,155 @@
+/**
+ * @file AdmissionController.h
+ * @brief Connection admission: per-endpoint client limits and a heap-scaled global budget
+ *
+ * The WebSocket endpoints used to accept a connection, finish the
+ * handshake (client object, queues, the welcome frame) and only then
+ * compare the client count with their limit; /logs and plain HTTP had no
+ * limit at all. The controller decides on the upgrade request instead,
+ * before the library creates the WebSocket client:
+ *
+ * - Per endpoint: at most getLimit() open clients (/boatdata, Signal K, /logs)
+ * - Global: all WebSocket clients together stay within connectionBudget()
+ *   of the free heap: (free - ADMISSION_HEAP_RESERVE) / ADMISSION_BYTES_PER_CLIENT,
+ *   capped at ADMISSION_MAX_CLIENTS
+ * - Every request (HTTP included) is refused while the free heap is below
+ *   ADMISSION_HEAP_RESERVE
+ *
+ * A refused request is answered 503 with Retry-After and never upgraded.
+ * opened()/closed() follow the WebSocket connect and disconnect events;
+ * opened() reports a client beyond the limit (two handshakes admitted at
+ * the same moment) so the caller can close it.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * server->addMiddleware([](AsyncWebServerRequest* request, ArMiddlewareNext next) {
+ *     AdmissionEndpoint endpoint = AdmissionController::endpointFor(request->url().c_str(),
+ *                                                                   request->hasHeader("Upgrade"));
+ *     if (GetAdmissionController().admit(endpoint, ESP.getFreeHeap()) != AdmissionResult::ADMITTED) {
+ *         request->send(503);   // Never upgraded
+ *         return;
+ *     }
+ *     next();
+ * });
+ * // WS_EVT_CONNECT: if (!GetAdmissionController().opened(AdmissionEndpoint::LOGS)) client->close(1011);
+ * // WS_EVT_DISCONNECT: GetAdmissionController().closed(AdmissionEndpoint::LOGS);
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): admission bounded by the heap that is actually free
+ * - Principle VII (Fail-Safe): overload is refused early instead of starving running clients
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ADMISSION_CONTROLLER_H
+#define ADMISSION_CONTROLLER_H
+
+#include <stdint.h>
+#include <atomic>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/// Admission endpoints: identifier, name (GET /status "admission"), WebSocket path, client limit (0 = not counted)
+#define ADMISSION_ENDPOINT_LIST(X) \
+    X(BOATDATA, "boatdata", "/boatdata", BOATDATA_STREAM_MAX_CLIENTS) \
+    X(SIGNALK, "signalk", "/signalk/v1/stream", SIGNALK_MAX_CLIENTS) \
+    X(LOGS, "logs", "/logs", LOGS_MAX_CLIENTS) \
+    X(AIS, "ais", "/ais", AIS_MAX_CLIENTS) \
+    X(HTTP, "http", "", 0)
+
+/**
+ * @brief Endpoints with their own client limit
+ */
+enum class AdmissionEndpoint : uint8_t {
+#define ADMISSION_ENDPOINT_ENUM(id, name, path, limit) id,
+    ADMISSION_ENDPOINT_LIST(ADMISSION_ENDPOINT_ENUM)
+#undef ADMISSION_ENDPOINT_ENUM
+    COUNT
+};
+
+/**
+ * @brief Decision on one request
+ */
+enum class AdmissionResult : uint8_t {
+    ADMITTED,
+    ENDPOINT_FULL,   ///< The endpoint has its limit of clients
+    GLOBAL_FULL,     ///< All WebSocket clients together use the heap budget
+    LOW_HEAP         ///< Free heap below ADMISSION_HEAP_RESERVE
+};
+
+/// Name of @p result ("admitted", "endpoint_full", ...)
+const char* AdmissionResultName(AdmissionResult result);
+
+/// Name of @p endpoint ("boatdata", "signalk", ...); "unknown" if out of range
+const char* AdmissionEndpointName(AdmissionEndpoint endpoint);
+
+/**
+ * @class AdmissionController
+ * @brief Client counts and admission decisions (async_tcp task; counters readable anywhere)
+ */
+class AdmissionController {
+public:
+    static constexpr uint8_t ENDPOINT_COUNT = static_cast<uint8_t>(AdmissionEndpoint::COUNT);
+
+    AdmissionController();
+
+    /**
+     * @brief Decide on a new connection or request to @p endpoint
+     * @param freeHeap Free heap bytes now
+     */
+    AdmissionResult admit(AdmissionEndpoint endpoint, uint32_t freeHeap);
+
+    /**
+     * @brief A WebSocket client of @p endpoint connected
+     * @return false if it is beyond the endpoint limit (close it; closed() follows)
+     */
+    bool opened(AdmissionEndpoint endpoint);
+
+    /// A WebSocket client of @p endpoint disconnected
+    void closed(AdmissionEndpoint endpoint);
+
+    /**
+     * @brief Endpoint of a request: a WebSocket endpoint for an upgrade of its path, else HTTP
+     * @param path URL path without the query
+     * @param upgrade The request carries an Upgrade header
+     */
+    static AdmissionEndpoint endpointFor(const char* path, bool upgrade);
+
+    /// WebSocket clients that fit @p freeHeap (all endpoints together)
+    static uint16_t connectionBudget(uint32_t freeHeap);
+
+    uint8_t getLimit(AdmissionEndpoint endpoint) const;
+    uint16_t getClients(AdmissionEndpoint endpoint) const;
+    uint16_t getTotalClients() const;
+    uint32_t getAdmitted(AdmissionEndpoint endpoint) const;
+    uint32_t getRejected(AdmissionEndpoint endpoint) const;
+
+    /// Rejections for @p result (ADMITTED: 0)
+    uint32_t getRejected(AdmissionResult result) const;
+
+    /**
+     * @brief Write the counts as a JSON object
+     *
+     * {"budget":12,"clients":3,"boatdata":{"clients":2,"limit":10,"admitted":5,"rejected":0},...,
+     *  "rejected":{"endpoint_full":0,"global_full":0,"low_heap":0}}
+     * With @p key the object is a member of the enclosing one (GET /status).
+     */
+    void writeJson(JsonWriter& json, uint32_t freeHeap, const char* key = nullptr) const;
+
+private:
+    static constexpr uint8_t REASON_COUNT = 4;
+
+    std::atomic<uint16_t> clients_[ENDPOINT_COUNT];
+    std::atomic<uint32_t> admitted_[ENDPOINT_COUNT];
+    std::atomic<uint32_t> rejected_[ENDPOINT_COUNT];
+    std::atomic<uint32_t> reasons_[REASON_COUNT];   ///< Indexed by AdmissionResult
+};
+
+/// Process-wide admission controller
+AdmissionController& GetAdmissionController();
+
+#endif // ADMISSION_CONTROLLER_H
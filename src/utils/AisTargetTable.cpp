@@ -0,0 +1,461 @@
+/**
+ * @file AisTargetTable.cpp
+ * @brief Implementation of the AIS target table and CPA/TCPA pass
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "AisTargetTable.h"
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+constexpr double DEG_TO_RAD_D = 0.017453292519943295;
+constexpr float TWO_PI_F = 6.2831853f;
+constexpr double NM_PER_DEGREE = 60.0;
+constexpr float MIN_RELATIVE_SPEED_KN = 0.05f;  ///< Slower relative motion: no closest approach, CPA = range
+
+/// Grid columns around the globe (cells are AIS_GRID_CELL_NM minutes of longitude wide)
+constexpr int32_t GRID_COLUMNS = static_cast<int32_t>(360.0 * 60.0 / AIS_GRID_CELL_NM);
+
+/// Signed a - b of two millis() timestamps
+inline int32_t elapsed(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b);
+}
+
+inline int32_t gridRow(double latitude) {
+    return static_cast<int32_t>(floor(latitude * NM_PER_DEGREE / AIS_GRID_CELL_NM));
+}
+
+inline int32_t gridColumn(double longitude) {
+    int32_t column = static_cast<int32_t>(floor(longitude * 60.0 / AIS_GRID_CELL_NM));
+    column %= GRID_COLUMNS;
+    return column < 0 ? column + GRID_COLUMNS : column;
+}
+
+inline uint32_t packCell(int32_t row, int32_t column) {
+    return (static_cast<uint32_t>(row) << 16) | static_cast<uint32_t>(column);
+}
+
+inline uint32_t cellOf(double latitude, double longitude) {
+    return packCell(gridRow(latitude), gridColumn(longitude));
+}
+
+inline uint16_t cellBucket(uint32_t cell) {
+    uint32_t h = cell * 2654435769u;
+    return static_cast<uint16_t>((h >> 16) & (AIS_GRID_BUCKETS - 1));
+}
+
+/// Velocity east/north in knots from COG/SOG (NaN = stationary)
+inline void velocity(float cog, float sog, float& east, float& north) {
+    if (!isfinite(cog) || !isfinite(sog)) {
+        east = north = 0.0f;
+        return;
+    }
+    east = sog * sinf(cog);
+    north = sog * cosf(cog);
+}
+
+}  // namespace
+
+AisTargetTable::AisTargetTable() : slotsLock_(), risksLock_() {
+    clear();
+}
+
+void AisTargetTable::clear() {
+    slotsLock_.writeBegin();
+    memset(slots_, 0, sizeof(slots_));
+    for (uint16_t i = 0; i < AIS_HASH_SLOTS; i++) {
+        hash_[i] = AIS_NO_SLOT;
+    }
+    for (uint16_t i = 0; i < AIS_GRID_BUCKETS; i++) {
+        grid_[i] = AIS_NO_SLOT;
+    }
+    // Lowest slots first
+    for (uint16_t i = 0; i < AIS_MAX_TARGETS; i++) {
+        free_[i] = static_cast<uint16_t>(AIS_MAX_TARGETS - 1 - i);
+    }
+    freeCount_ = AIS_MAX_TARGETS;
+    dirtyCount_ = 0;
+    count_ = 0;
+    epoch_ = 0;
+    sweep_ = 0;
+    slotsLock_.writeEnd();
+
+    memset(&stats_, 0, sizeof(stats_));
+    risksLock_.writeBegin();
+    memset(&risks_, 0, sizeof(risks_));
+    risksLock_.writeEnd();
+}
+
+// =============================================================================
+// MMSI hash and grid
+// =============================================================================
+
+uint16_t AisTargetTable::hashHome(uint32_t mmsi) {
+    // Fibonacci hashing: MMSIs share country prefixes, the multiply spreads the low digits
+    return static_cast<uint16_t>(((mmsi * 2654435769u) >> 16) & (AIS_HASH_SLOTS - 1));
+}
+
+uint16_t AisTargetTable::find(uint32_t mmsi) const {
+    if (mmsi == 0) {
+        return AIS_NO_SLOT;
+    }
+    for (uint16_t i = hashHome(mmsi);; i = (i + 1) & (AIS_HASH_SLOTS - 1)) {
+        uint16_t slot = hash_[i];
+        if (slot == AIS_NO_SLOT || slots_[slot].mmsi == mmsi) {
+            return slot;  // The table is never full, so an empty position ends every probe
+        }
+    }
+}
+
+void AisTargetTable::unhash(uint32_t mmsi) {
+    uint16_t i = hashHome(mmsi);
+    while (hash_[i] != AIS_NO_SLOT && slots_[hash_[i]].mmsi != mmsi) {
+        i = (i + 1) & (AIS_HASH_SLOTS - 1);
+    }
+    if (hash_[i] == AIS_NO_SLOT) {
+        return;
+    }
+
+    // Backward shift: move later entries of the run into the gap unless that puts them before their home
+    for (uint16_t j = (i + 1) & (AIS_HASH_SLOTS - 1); hash_[j] != AIS_NO_SLOT; j = (j + 1) & (AIS_HASH_SLOTS - 1)) {
+        uint16_t home = hashHome(slots_[hash_[j]].mmsi);
+        uint16_t fromHome = (j - home) & (AIS_HASH_SLOTS - 1);
+        uint16_t gap = (j - i) & (AIS_HASH_SLOTS - 1);
+        if (fromHome >= gap) {
+            hash_[i] = hash_[j];
+            i = j;
+        }
+    }
+    hash_[i] = AIS_NO_SLOT;
+}
+
+void AisTargetTable::gridLink(uint16_t slot) {
+    AisTarget& t = slots_[slot];
+    t.gridCell = cellOf(t.latitude, t.longitude);
+    uint16_t bucket = cellBucket(t.gridCell);
+    t.gridNext = grid_[bucket];
+    grid_[bucket] = slot;
+}
+
+void AisTargetTable::gridUnlink(uint16_t slot) {
+    uint16_t* link = &grid_[cellBucket(slots_[slot].gridCell)];
+    while (*link != AIS_NO_SLOT && *link != slot) {
+        link = &slots_[*link].gridNext;
+    }
+    if (*link == slot) {
+        *link = slots_[slot].gridNext;
+    }
+}
+
+// =============================================================================
+// Slab
+// =============================================================================
+
+uint16_t AisTargetTable::allocate() {
+    if (freeCount_ == 0) {
+        // Full: give the slot of the target heard least recently to the new one
+        uint16_t oldest = 0;
+        for (uint16_t i = 1; i < AIS_MAX_TARGETS; i++) {
+            if (elapsed(slots_[oldest].lastUpdate, slots_[i].lastUpdate) > 0) {
+                oldest = i;
+            }
+        }
+        remove(oldest);
+        stats_.evicted++;
+    }
+    return free_[--freeCount_];
+}
+
+void AisTargetTable::remove(uint16_t slot) {
+    AisTarget& t = slots_[slot];
+    unhash(t.mmsi);
+    gridUnlink(slot);
+    bool dirty = t.dirty;  // Still on the dirty stack; a reuse must not push it twice
+    memset(&t, 0, sizeof(t));
+    t.dirty = dirty;
+    free_[freeCount_++] = slot;
+    count_--;
+}
+
+bool AisTargetTable::update(const AisPositionReport& report) {
+    if (report.mmsi == 0 || !isfinite(report.latitude) || !isfinite(report.longitude) ||
+        fabs(report.latitude) > 90.0 || fabs(report.longitude) > 180.0) {
+        return false;
+    }
+
+    slotsLock_.writeBegin();
+    uint16_t slot = find(report.mmsi);
+    bool added = slot == AIS_NO_SLOT;
+    if (added) {
+        slot = allocate();
+        AisTarget& t = slots_[slot];
+        t.mmsi = report.mmsi;
+        t.range = t.bearing = t.cpa = t.tcpa = NAN;
+        uint16_t i = hashHome(report.mmsi);
+        while (hash_[i] != AIS_NO_SLOT) {
+            i = (i + 1) & (AIS_HASH_SLOTS - 1);
+        }
+        hash_[i] = slot;
+        count_++;
+        stats_.added++;
+    }
+
+    AisTarget& t = slots_[slot];
+    bool moved = added || cellOf(report.latitude, report.longitude) != t.gridCell;
+    if (moved && !added) {
+        gridUnlink(slot);
+    }
+    t.latitude = report.latitude;
+    t.longitude = report.longitude;
+    t.cog = report.cog;
+    t.sog = report.sog;
+    t.heading = report.heading;
+    t.navStatus = report.navStatus;
+    t.aisClass = report.aisClass;
+    t.lastUpdate = report.receivedMs;
+    if (t.reports < UINT16_MAX) {
+        t.reports++;
+    }
+    if (moved) {
+        gridLink(slot);
+    }
+    if (!t.dirty) {
+        t.dirty = true;
+        dirty_[dirtyCount_++] = slot;
+    }
+    slotsLock_.writeEnd();
+
+    stats_.reports++;
+    return true;
+}
+
+void AisTargetTable::expireSweep(uint32_t nowMs) {
+    for (uint16_t n = 0; n < AIS_EXPIRE_SWEEP && n < AIS_MAX_TARGETS; n++) {
+        uint16_t slot = sweep_;
+        sweep_ = static_cast<uint16_t>((sweep_ + 1) % AIS_MAX_TARGETS);
+        const AisTarget& t = slots_[slot];
+        if (t.mmsi != 0 && elapsed(nowMs, t.lastUpdate) > AIS_TARGET_TIMEOUT_MS) {
+            remove(slot);
+            stats_.expired++;
+        }
+    }
+}
+
+// =============================================================================
+// CPA/TCPA pass
+// =============================================================================
+
+void AisTargetTable::evaluateSlot(uint16_t slot, const AisOwnShip& own, uint32_t nowMs, AisRiskList& list) {
+    AisTarget& t = slots_[slot];
+    if (t.mmsi == 0 || t.evalEpoch == epoch_) {
+        return;  // Free, or already computed in this pass
+    }
+    t.evalEpoch = epoch_;
+    t.evaluatedMs = nowMs;
+    list.evaluated++;
+    stats_.evaluations++;
+
+    // Relative position (nm), both vessels dead-reckoned to nowMs
+    float ownEast, ownNorth, targetEast, targetNorth;
+    velocity(own.cog, own.sog, ownEast, ownNorth);
+    velocity(t.cog, t.sog, targetEast, targetNorth);
+    float targetHours = elapsed(nowMs, t.lastUpdate) / 3600000.0f;
+    float ownHours = elapsed(nowMs, own.fixMs) / 3600000.0f;
+
+    double dLon = t.longitude - own.longitude;
+    if (dLon > 180.0) {
+        dLon -= 360.0;
+    } else if (dLon < -180.0) {
+        dLon += 360.0;
+    }
+    float x = static_cast<float>(dLon * cos(own.latitude * DEG_TO_RAD_D) * NM_PER_DEGREE) +
+              targetEast * targetHours - ownEast * ownHours;
+    float y = static_cast<float>((t.latitude - own.latitude) * NM_PER_DEGREE) +
+              targetNorth * targetHours - ownNorth * ownHours;
+
+    float vx = targetEast - ownEast;
+    float vy = targetNorth - ownNorth;
+    float speed2 = vx * vx + vy * vy;
+    t.range = sqrtf(x * x + y * y);
+    float bearing = atan2f(x, y);
+    t.bearing = bearing < 0.0f ? bearing + TWO_PI_F : bearing;
+    if (speed2 < MIN_RELATIVE_SPEED_KN * MIN_RELATIVE_SPEED_KN) {
+        t.cpa = t.range;
+        t.tcpa = 0.0f;
+    } else {
+        float hours = -(x * vx + y * vy) / speed2;
+        float cx = x + vx * hours;
+        float cy = y + vy * hours;
+        t.cpa = sqrtf(cx * cx + cy * cy);
+        t.tcpa = hours * 3600.0f;
+    }
+
+    bool closing = t.cpa <= AIS_CPA_ALARM_NM && t.tcpa >= 0.0f && t.tcpa <= AIS_TCPA_ALARM_S;
+    bool close = t.range <= AIS_CPA_ALARM_NM;
+    if (!(closing || close) || elapsed(nowMs, t.lastUpdate) > AIS_TARGET_TIMEOUT_MS) {
+        return;
+    }
+
+    // Insert by TCPA; a full list keeps the most urgent
+    float key = t.tcpa > 0.0f ? t.tcpa : 0.0f;
+    uint8_t at = list.count;
+    while (at > 0 && list.risks[at - 1].tcpa > key) {
+        at--;
+    }
+    if (at >= AIS_RISK_MAX) {
+        return;
+    }
+    uint8_t last = list.count < AIS_RISK_MAX ? list.count : AIS_RISK_MAX - 1;
+    memmove(&list.risks[at + 1], &list.risks[at], (last - at) * sizeof(AisRisk));
+    AisRisk& risk = list.risks[at];
+    risk.mmsi = t.mmsi;
+    risk.range = t.range;
+    risk.bearing = t.bearing;
+    risk.cpa = t.cpa;
+    risk.tcpa = key;
+    risk.cog = t.cog;
+    risk.sog = t.sog;
+    risk.aisClass = t.aisClass;
+    if (list.count < AIS_RISK_MAX) {
+        list.count++;
+    }
+}
+
+void AisTargetTable::evaluateCell(int32_t row, int32_t column, const AisOwnShip& own, uint32_t nowMs,
+                                  AisRiskList& list) {
+    uint32_t cell = packCell(row, column);
+    for (uint16_t slot = grid_[cellBucket(cell)]; slot != AIS_NO_SLOT; slot = slots_[slot].gridNext) {
+        if (slots_[slot].gridCell == cell) {
+            evaluateSlot(slot, own, nowMs, list);  // Others share the bucket, not the cell
+        }
+    }
+}
+
+void AisTargetTable::evaluate(const AisOwnShip& own, uint32_t nowMs) {
+    stats_.passes++;
+    slotsLock_.writeBegin();
+    expireSweep(nowMs);
+
+    AisRiskList list;
+    list.count = 0;
+    list.evaluated = 0;
+    list.evaluatedMs = nowMs;
+    list.ownShipAvailable = own.available && isfinite(own.latitude) && isfinite(own.longitude);
+
+    if (list.ownShipAvailable) {
+        epoch_++;
+        if (epoch_ == 0) {
+            epoch_ = 1;  // 0 = never evaluated
+        }
+
+        // 1. Targets reported since the last pass, wherever they are
+        for (uint16_t i = 0; i < dirtyCount_; i++) {
+            uint16_t slot = dirty_[i];
+            slots_[slot].dirty = false;
+            evaluateSlot(slot, own, nowMs, list);
+        }
+        dirtyCount_ = 0;
+
+        // 2. Last pass's risks, so a target between reports stays listed
+        for (uint8_t i = 0; i < risks_.count; i++) {
+            uint16_t slot = find(risks_.risks[i].mmsi);
+            if (slot != AIS_NO_SLOT) {
+                evaluateSlot(slot, own, nowMs, list);
+            }
+        }
+
+        // 3. Everything in the grid cells within the risk radius
+        float cosLat = static_cast<float>(cos(own.latitude * DEG_TO_RAD_D));
+        int32_t rows = static_cast<int32_t>(ceilf(AIS_RISK_RADIUS_NM / AIS_GRID_CELL_NM));
+        int32_t columns = static_cast<int32_t>(ceilf(AIS_RISK_RADIUS_NM / (AIS_GRID_CELL_NM * fmaxf(cosLat, 0.01f))));
+        int32_t row0 = gridRow(own.latitude);
+        int32_t column0 = gridColumn(own.longitude);
+        if (2 * columns + 1 >= GRID_COLUMNS) {
+            columns = GRID_COLUMNS / 2;  // Polar: the rows all round
+        }
+        for (int32_t r = row0 - rows; r <= row0 + rows; r++) {
+            for (int32_t c = column0 - columns; c <= column0 + columns; c++) {
+                evaluateCell(r, ((c % GRID_COLUMNS) + GRID_COLUMNS) % GRID_COLUMNS, own, nowMs, list);
+            }
+        }
+    }
+    slotsLock_.writeEnd();
+
+    // Without a fix the dirty targets wait for the next pass that has one
+    list.targets = count_;
+    risksLock_.writeBegin();
+    risks_ = list;
+    risksLock_.writeEnd();
+}
+
+// =============================================================================
+// Readers
+// =============================================================================
+
+bool AisTargetTable::readTarget(uint16_t slot, AisTarget& out) const {
+    if (slot >= AIS_MAX_TARGETS) {
+        return false;
+    }
+    return slotsLock_.read(slots_[slot], out) && out.mmsi != 0;
+}
+
+bool AisTargetTable::readRisks(AisRiskList& out) const {
+    return risksLock_.read(risks_, out);
+}
+
+void AisTargetTable::writeRisksJson(JsonWriter& json, const AisRiskList& list, const AisTableStats* stats) {
+    json.beginObject();
+    json.add("targets", static_cast<unsigned int>(list.targets));
+    json.add("evaluated", static_cast<unsigned int>(list.evaluated));
+    json.add("own_ship", list.ownShipAvailable);
+    json.add("last_update", static_cast<unsigned long>(list.evaluatedMs));
+    json.beginArray("risks");
+    for (uint8_t i = 0; i < list.count; i++) {
+        const AisRisk& risk = list.risks[i];
+        json.beginObject();
+        json.add("mmsi", static_cast<unsigned long>(risk.mmsi));
+        json.add("range", static_cast<double>(risk.range), 3);
+        json.add("bearing", static_cast<double>(risk.bearing), 4);
+        json.add("cpa", static_cast<double>(risk.cpa), 3);
+        json.add("tcpa", static_cast<double>(risk.tcpa), 0);
+        json.add("cog", static_cast<double>(risk.cog), 4);
+        json.add("sog", static_cast<double>(risk.sog), 1);
+        json.add("class", risk.aisClass == AIS_CLASS_B ? "B" : "A");
+        json.endObject();
+    }
+    json.endArray();
+    if (stats != nullptr) {
+        json.beginObject("stats");
+        json.add("reports", static_cast<unsigned long>(stats->reports));
+        json.add("added", static_cast<unsigned long>(stats->added));
+        json.add("expired", static_cast<unsigned long>(stats->expired));
+        json.add("evicted", static_cast<unsigned long>(stats->evicted));
+        json.add("evaluations", static_cast<unsigned long>(stats->evaluations));
+        json.add("passes", static_cast<unsigned long>(stats->passes));
+        json.endObject();
+    }
+    json.endObject();
+}
+
+void AisTargetTable::writeTargetJson(JsonWriter& json, const AisTarget& target, uint32_t nowMs) {
+    json.beginObject();
+    json.add("mmsi", static_cast<unsigned long>(target.mmsi));
+    json.add("class", target.aisClass == AIS_CLASS_B ? "B" : "A");
+    json.add("latitude", target.latitude, 6);
+    json.add("longitude", target.longitude, 6);
+    json.add("cog", static_cast<double>(target.cog), 4);
+    json.add("sog", static_cast<double>(target.sog), 1);
+    json.add("heading", static_cast<double>(target.heading), 4);
+    json.add("nav_status", static_cast<unsigned int>(target.navStatus));
+    json.add("range", static_cast<double>(target.range), 3);
+    json.add("bearing", static_cast<double>(target.bearing), 4);
+    json.add("cpa", static_cast<double>(target.cpa), 3);
+    json.add("tcpa", static_cast<double>(target.tcpa), 0);
+    json.add("reports", static_cast<unsigned int>(target.reports));
+    json.add("age_ms", static_cast<unsigned long>(nowMs - target.lastUpdate));
+    json.endObject();
+}
@@ -0,0 +1,201 @@
+/**
+ * @file AisTargetTable.h
+ * @brief AIS targets in a fixed slab with an MMSI hash, a coarse grid and incremental CPA/TCPA
+ *
+ * Holds up to AIS_MAX_TARGETS vessels from AIS position reports and keeps
+ * the collision-risk list the /ais WebSocket streams at 1 Hz:
+ * - slab: AIS_MAX_TARGETS AisTarget slots, allocated from a free-slot stack;
+ *   a report for an unknown MMSI while the slab is full replaces the target
+ *   heard least recently (counted as an eviction)
+ * - MMSI index: open addressing (Fibonacci hash, linear probing, deletion by
+ *   backward shift), AIS_HASH_SLOTS > 2 x AIS_MAX_TARGETS so probes stay short
+ * - grid: every target is linked into the bucket of its AIS_GRID_CELL_NM
+ *   cell (cells hashed into AIS_GRID_BUCKETS lists); a query walks the
+ *   buckets of the cells around the own ship and skips the targets of other
+ *   cells sharing a bucket, so the far targets cost a compare, not a CPA
+ * - evaluate(): CPA/TCPA is recomputed only for targets reported since the
+ *   last pass (dirty stack) and for targets in the grid cells within
+ *   AIS_RISK_RADIUS_NM of the own ship (whose relative motion changes as the
+ *   own ship moves). A pass costs O(reports + nearby targets), never O(N²),
+ *   and expiry sweeps AIS_EXPIRE_SWEEP slots per pass instead of the slab
+ *
+ * CPA/TCPA dead-reckon both vessels to the pass time along COG/SOG in a
+ * local flat-earth frame around the own ship (ample within the risk
+ * radius). A vessel without COG/SOG is treated as stationary. A target is a
+ * risk when its CPA is below AIS_CPA_ALARM_NM within AIS_TCPA_ALARM_S
+ * seconds, or it is already that close; the AIS_RISK_MAX most urgent (lowest
+ * TCPA) form the published risk list.
+ *
+ * One writer (main loop: update(), evaluate()); readers in other tasks copy
+ * a slot (readTarget()) or the risk list (readRisks()) through SeqLocks.
+ * Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * static AisTargetTable ais;
+ * ais.update(report);                        // Per decoded position report
+ *
+ * AisOwnShip own = {gps.latitude, gps.longitude, gps.cog, gps.sog, gps.lastUpdate, gps.available};
+ * ais.evaluate(own, millis());               // 1 Hz
+ * AisRiskList risks;
+ * if (ais.readRisks(risks)) { AisTargetTable::writeRisksJson(json, risks); }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed slab and indexes (~19 KB), zero heap allocation
+ * - Principle VII (Fail-Safe): without an own-ship fix no risk is reported; a full table evicts the stalest target
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef AIS_TARGET_TABLE_H
+#define AIS_TARGET_TABLE_H
+
+#include <stdint.h>
+#include "../types/AisTypes.h"
+#include "JsonWriter.h"
+#include "SeqLock.h"
+#include "../config.h"
+
+#define AIS_NO_SLOT 0xFFFF  ///< Empty hash slot / end of a grid bucket list
+
+static_assert((AIS_HASH_SLOTS & (AIS_HASH_SLOTS - 1)) == 0, "AIS_HASH_SLOTS must be a power of two");
+static_assert(AIS_HASH_SLOTS > 2 * AIS_MAX_TARGETS, "AIS_HASH_SLOTS must exceed twice AIS_MAX_TARGETS");
+static_assert((AIS_GRID_BUCKETS & (AIS_GRID_BUCKETS - 1)) == 0, "AIS_GRID_BUCKETS must be a power of two");
+static_assert(AIS_MAX_TARGETS < AIS_NO_SLOT, "slot indices must fit below AIS_NO_SLOT");
+
+/**
+ * @brief Own-ship state for a pass (from GPSData)
+ */
+struct AisOwnShip {
+    double latitude;         ///< Decimal degrees
+    double longitude;
+    float cog;               ///< Radians true, NaN = stationary
+    float sog;               ///< Knots, NaN = stationary
+    uint32_t fixMs;          ///< millis() of the position
+    bool available;          ///< Position valid; false = no CPA/TCPA, empty risk list
+};
+
+/**
+ * @brief One entry of the collision-risk list
+ */
+struct AisRisk {
+    uint32_t mmsi;
+    float range;             ///< Nautical miles
+    float bearing;           ///< Radians true from the own ship
+    float cpa;               ///< Nautical miles
+    float tcpa;              ///< Seconds (0 for an already close, non-closing target)
+    float cog;               ///< Radians true, NaN = not available
+    float sog;               ///< Knots, NaN = not available
+    uint8_t aisClass;
+};
+
+/**
+ * @brief Result of the last evaluation pass
+ */
+struct AisRiskList {
+    AisRisk risks[AIS_RISK_MAX];  ///< Ascending TCPA
+    uint8_t count;
+    uint16_t targets;             ///< Targets in the table
+    uint16_t evaluated;           ///< CPA/TCPA computations of the pass
+    uint32_t evaluatedMs;         ///< millis() of the pass (0 = none yet)
+    bool ownShipAvailable;
+};
+
+/**
+ * @brief Table counters (writer-owned, read racily)
+ */
+struct AisTableStats {
+    uint32_t reports;        ///< Position reports applied
+    uint32_t added;          ///< Targets created
+    uint32_t expired;        ///< Targets dropped after AIS_TARGET_TIMEOUT_MS
+    uint32_t evicted;        ///< Targets replaced because the slab was full
+    uint32_t evaluations;    ///< CPA/TCPA computations
+    uint32_t passes;         ///< evaluate() calls
+};
+
+/**
+ * @class AisTargetTable
+ * @brief Per-MMSI AIS targets and their collision risk
+ */
+class AisTargetTable {
+public:
+    AisTargetTable();
+
+    /// Drop every target (writer)
+    void clear();
+
+    /**
+     * @brief Apply a position report (writer)
+     *
+     * Creates the target on its first report. Marks it for the next pass.
+     *
+     * @return false if @p report has MMSI 0 or no valid position
+     */
+    bool update(const AisPositionReport& report);
+
+    /**
+     * @brief CPA/TCPA pass, expiry sweep and risk list (writer, AIS_EVALUATE_INTERVAL_MS)
+     */
+    void evaluate(const AisOwnShip& own, uint32_t nowMs);
+
+    /// Slot of @p mmsi, AIS_NO_SLOT if not tracked (writer)
+    uint16_t find(uint32_t mmsi) const;
+
+    /// Writer's view of slot @p slot (free slots have mmsi 0)
+    const AisTarget& target(uint16_t slot) const { return slots_[slot]; }
+
+    /// Consistent copy of slot @p slot (any task); false if free, out of range or not readable
+    bool readTarget(uint16_t slot, AisTarget& out) const;
+
+    /// Consistent copy of the last pass (any task)
+    bool readRisks(AisRiskList& out) const;
+
+    uint16_t count() const { return count_; }
+    const AisTableStats& stats() const { return stats_; }
+
+    /**
+     * @brief {"targets":12,"evaluated":5,"own_ship":true,"last_update":123456,"risks":[{...}]}
+     * @param stats Appended as "stats" if given (GET /ais/risks; the WebSocket stream omits them)
+     */
+    static void writeRisksJson(JsonWriter& json, const AisRiskList& list, const AisTableStats* stats = nullptr);
+
+    /**
+     * @brief {"mmsi":244670316,"latitude":51.89,"longitude":4.38,"cog":..,"cpa":..,...}
+     */
+    static void writeTargetJson(JsonWriter& json, const AisTarget& target, uint32_t nowMs);
+
+private:
+    AisTarget slots_[AIS_MAX_TARGETS];
+    uint16_t hash_[AIS_HASH_SLOTS];       ///< Slot per MMSI hash position (AIS_NO_SLOT = empty)
+    uint16_t grid_[AIS_GRID_BUCKETS];     ///< First slot per grid bucket
+    uint16_t free_[AIS_MAX_TARGETS];      ///< Free-slot stack
+    uint16_t freeCount_;
+    uint16_t dirty_[AIS_MAX_TARGETS];     ///< Slots reported since the last pass (AisTarget::dirty = on the stack)
+    uint16_t dirtyCount_;
+    uint16_t count_;
+    uint16_t epoch_;                      ///< Pass counter (AisTarget::evalEpoch)
+    uint16_t sweep_;                      ///< Next slot of the expiry sweep
+    AisTableStats stats_;
+    SeqLock slotsLock_;                   ///< Guards slots_ for readTarget()
+    AisRiskList risks_;
+    SeqLock risksLock_;
+
+    static uint16_t hashHome(uint32_t mmsi);
+
+    uint16_t allocate();
+    void remove(uint16_t slot);
+    void unhash(uint32_t mmsi);
+    void gridLink(uint16_t slot);
+    void gridUnlink(uint16_t slot);
+    void expireSweep(uint32_t nowMs);
+
+    /// evaluateSlot() for the targets of grid cell (@p row, @p column)
+    void evaluateCell(int32_t row, int32_t column, const AisOwnShip& own, uint32_t nowMs, AisRiskList& list);
+
+    /// CPA/TCPA of @p slot at @p nowMs; adds it to @p list if it is a risk
+    void evaluateSlot(uint16_t slot, const AisOwnShip& own, uint32_t nowMs, AisRiskList& list);
+};
+
+#endif // AIS_TARGET_TABLE_H
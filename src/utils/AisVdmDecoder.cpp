@@ -0,0 +1,137 @@
+/**
+ * @file AisVdmDecoder.cpp
+ * @brief Implementation of the AIS position report decoder
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "AisVdmDecoder.h"
+#include <math.h>
+
+namespace {
+
+constexpr double DEG_TO_RAD_D = 0.017453292519943295;
+
+constexpr size_t POSITION_REPORT_BITS = 168;  // Types 1-3 and 18
+constexpr uint32_t SOG_NA = 1023;          // 1/10 kn
+constexpr uint32_t COG_NA = 3600;          // 1/10 deg
+constexpr int32_t LON_MAX = 180 * 600000;  // 1/10000 min; 181° = not available
+constexpr int32_t LAT_MAX = 90 * 600000;   // 91° = not available
+
+/// 6-bit value of an armored character, -1 outside the alphabet ('0'..'W', '`'..'w')
+int sixBits(char c) {
+    if (c < '0' || c > 'w' || (c > 'W' && c < '`')) {
+        return -1;
+    }
+    int value = c - '0';
+    return value > 40 ? value - 8 : value;
+}
+
+/**
+ * @brief Bit reader over the armored payload (MSB first)
+ */
+class PayloadBits {
+public:
+    PayloadBits(const char* payload, size_t length) : payload_(payload), length_(length) {}
+
+    /// All characters valid
+    bool valid() const {
+        for (size_t i = 0; i < length_; i++) {
+            if (sixBits(payload_[i]) < 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// @p count (<= 32) bits from bit @p start; the caller checks the length
+    uint32_t get(size_t start, uint8_t count) const {
+        uint32_t value = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            size_t bit = start + i;
+            uint32_t six = static_cast<uint32_t>(sixBits(payload_[bit / 6]));
+            value = (value << 1) | ((six >> (5 - bit % 6)) & 1u);
+        }
+        return value;
+    }
+
+    /// Two's complement field
+    int32_t getSigned(size_t start, uint8_t count) const {
+        uint32_t value = get(start, count);
+        if (value & (1u << (count - 1))) {
+            value |= ~((1u << count) - 1u);
+        }
+        return static_cast<int32_t>(value);
+    }
+
+private:
+    const char* payload_;
+    size_t length_;
+};
+
+float sogKnots(uint32_t raw) {
+    return raw == SOG_NA ? NAN : static_cast<float>(raw) * 0.1f;
+}
+
+float cogRadians(uint32_t raw) {
+    return raw >= COG_NA ? NAN : static_cast<float>(raw * 0.1 * DEG_TO_RAD_D);
+}
+
+/// 511 = not available
+float headingRadians(uint32_t raw) {
+    return raw >= 360 ? NAN : static_cast<float>(raw * DEG_TO_RAD_D);
+}
+
+}  // namespace
+
+uint8_t AisPayloadMessageType(const char* payload, size_t length) {
+    int six = length > 0 ? sixBits(payload[0]) : -1;
+    return six < 0 ? 0 : static_cast<uint8_t>(six);
+}
+
+AisDecodeResult AisDecodePositionReport(const char* payload, size_t length, uint8_t fillBits,
+                                        AisPositionReport& out) {
+    if (payload == nullptr || length == 0 || fillBits > 5) {
+        return AisDecodeResult::INVALID;
+    }
+    PayloadBits bits(payload, length);
+    if (!bits.valid()) {
+        return AisDecodeResult::INVALID;
+    }
+    size_t bitCount = length * 6 - fillBits;
+    uint8_t type = static_cast<uint8_t>(bits.get(0, 6));
+
+    // Field offsets of the two layouts (class B has 8 reserved bits instead of status and ROT)
+    size_t sogAt, lonAt;
+    if (type >= 1 && type <= 3) {
+        sogAt = 50;
+        lonAt = 61;
+    } else if (type == 18) {
+        sogAt = 46;
+        lonAt = 57;
+    } else {
+        return AisDecodeResult::UNSUPPORTED;
+    }
+    if (bitCount < POSITION_REPORT_BITS) {
+        return AisDecodeResult::INVALID;
+    }
+
+    uint32_t mmsi = bits.get(8, 30);
+    int32_t lon = bits.getSigned(lonAt, 28);
+    int32_t lat = bits.getSigned(lonAt + 28, 27);
+    if (mmsi == 0 || lon > LON_MAX || lon < -LON_MAX || lat > LAT_MAX || lat < -LAT_MAX) {
+        return AisDecodeResult::NO_POSITION;
+    }
+
+    size_t cogAt = lonAt + 55;
+    out.mmsi = mmsi;
+    out.longitude = lon / 600000.0;
+    out.latitude = lat / 600000.0;
+    out.sog = sogKnots(bits.get(sogAt, 10));
+    out.cog = cogRadians(bits.get(cogAt, 12));
+    out.heading = headingRadians(bits.get(cogAt + 12, 9));
+    out.aisClass = type == 18 ? AIS_CLASS_B : AIS_CLASS_A;
+    out.navStatus = type == 18 ? AIS_NAV_STATUS_UNDEFINED : static_cast<uint8_t>(bits.get(38, 4));
+    return AisDecodeResult::OK;
+}
@@ -0,0 +1,58 @@
+#ifndef AIS_VDM_DECODER_H
+#define AIS_VDM_DECODER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../types/AisTypes.h"
+
+/**
+ * @file AisVdmDecoder.h
+ * @brief Position reports from the 6-bit payload of !AIVDM sentences
+ *
+ * Decodes the ITU-R M.1371 position messages a collision check needs:
+ * - types 1, 2, 3: class A position report
+ * - type 18: standard class B position report
+ *
+ * Both fit one sentence (168 bits, 28 payload characters); multi-sentence
+ * messages (type 5 static data, type 19 extended class B) are reported as
+ * UNSUPPORTED without reassembly. The payload is read in place, bit by bit
+ * from the armored characters, without a decoded copy.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * // !AIVDM,1,1,,A,13aEOK?P00PD2wVMdLDRhgvL289?,0*26
+ * AisPositionReport report;
+ * if (AisDecodePositionReport(tokens.field(4).data, tokens.field(4).len, 0, report) == AisDecodeResult::OK) {
+ *     report.receivedMs = millis();
+ *     aisTargets.update(report);
+ * }
+ * @endcode
+ */
+
+/**
+ * @brief Outcome of decoding one payload
+ */
+enum class AisDecodeResult : uint8_t {
+    OK,              ///< @p out holds the report
+    UNSUPPORTED,     ///< Valid payload of another message type
+    INVALID,         ///< Character outside the 6-bit alphabet, or too short for its type
+    NO_POSITION      ///< Position not available (181° / 91°) or MMSI 0
+};
+
+/**
+ * @brief Decode a position report payload
+ *
+ * @param payload Armored payload (field 5 of !AIVDM), need not be NUL-terminated
+ * @param length Payload characters
+ * @param fillBits Padding bits at the end (field 6, 0..5)
+ * @param out Report (receivedMs left unchanged); unchanged unless OK
+ */
+AisDecodeResult AisDecodePositionReport(const char* payload, size_t length, uint8_t fillBits,
+                                        AisPositionReport& out);
+
+/// Message type of a payload (first 6 bits), 0 if the first character is invalid
+uint8_t AisPayloadMessageType(const char* payload, size_t length);
+
+#endif // AIS_VDM_DECODER_H
@@ -0,0 +1,504 @@
+/**
+ * @file AlarmEngine.cpp
+ * @brief Implementation of the anchor watch and threshold alarms
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "AlarmEngine.h"
+#include <cmath>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+constexpr double RADIANS_PER_DEGREE = M_PI / 180.0;
+constexpr double EARTH_RADIUS_M = 6371000.0;
+constexpr uint16_t MAX_DELAY_S = 3600;
+constexpr size_t MAX_LINE = 96;
+
+struct AlarmTypeInfo {
+    const char* name;
+    uint16_t group;
+    AlarmSeverity severity;
+    bool above;
+};
+
+const AlarmTypeInfo TYPES[] = {
+#define ALARM_TYPE_INFO(id, name, group, severity, above) {name, group, severity, above},
+    ALARM_TYPE_LIST(ALARM_TYPE_INFO)
+#undef ALARM_TYPE_INFO
+};
+
+const AlarmTypeInfo& info(AlarmType type) {
+    return TYPES[static_cast<uint8_t>(type)];
+}
+
+bool validRule(const AlarmRule& rule) {
+    if (!std::isfinite(rule.threshold) || !std::isfinite(rule.hysteresis) || rule.hysteresis < 0.0f ||
+        rule.delayS > MAX_DELAY_S) {
+        return false;
+    }
+    switch (rule.type) {
+        case AlarmType::BATTERY_LOW:
+            return rule.threshold > 0.0f && rule.instance <= 1;
+        case AlarmType::SHORE_POWER_LOST:
+            return rule.instance == 0;
+        default:
+            return rule.threshold > 0.0f && rule.instance == 0;
+    }
+}
+
+/// One rule from @p line (comments removed, NUL-terminated, modified)
+bool parseLine(char* line, AlarmRule& rule) {
+    char* save = nullptr;
+    char* name = strtok_r(line, " \t\r", &save);
+    char* threshold = strtok_r(nullptr, " \t\r", &save);
+    char* hysteresis = strtok_r(nullptr, " \t\r", &save);
+    char* delay = strtok_r(nullptr, " \t\r", &save);
+    char* instance = strtok_r(nullptr, " \t\r", &save);
+    if (delay == nullptr || strtok_r(nullptr, " \t\r", &save) != nullptr ||
+        !AlarmTypeFromName(name, rule.type)) {
+        return false;
+    }
+
+    char* end = nullptr;
+    rule.threshold = strtof(threshold, &end);
+    if (*end != '\0') {
+        return false;
+    }
+    rule.hysteresis = strtof(hysteresis, &end);
+    if (*end != '\0') {
+        return false;
+    }
+    unsigned long delayS = strtoul(delay, &end, 10);
+    if (*end != '\0' || *delay == '-' || delayS > MAX_DELAY_S) {
+        return false;
+    }
+    rule.delayS = static_cast<uint16_t>(delayS);
+    rule.instance = 0;
+    if (instance != nullptr) {
+        unsigned long value = strtoul(instance, &end, 10);
+        if (*end != '\0' || *instance == '-' || value > UINT8_MAX) {
+            return false;
+        }
+        rule.instance = static_cast<uint8_t>(value);
+    }
+    if (rule.type == AlarmType::SHORE_POWER_LOST) {
+        // On/off input: the alarm is "off", the clear "on"
+        rule.threshold = 0.5f;
+        rule.hysteresis = 0.0f;
+    }
+    return validRule(rule);
+}
+
+}  // namespace
+
+const char* AlarmTypeName(AlarmType type) {
+    return type < AlarmType::COUNT ? info(type).name : "unknown";
+}
+
+bool AlarmTypeFromName(const char* name, AlarmType& out) {
+    if (name == nullptr) {
+        return false;
+    }
+    for (uint8_t i = 0; i < static_cast<uint8_t>(AlarmType::COUNT); i++) {
+        if (strcmp(name, TYPES[i].name) == 0) {
+            out = static_cast<AlarmType>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+uint16_t AlarmTypeGroup(AlarmType type) {
+    return type < AlarmType::COUNT ? info(type).group : 0;
+}
+
+AlarmSeverity AlarmTypeSeverity(AlarmType type) {
+    return type < AlarmType::COUNT ? info(type).severity : AlarmSeverity::CAUTION;
+}
+
+const char* AlarmSeverityName(AlarmSeverity severity) {
+    switch (severity) {
+        case AlarmSeverity::ALARM:   return "alarm";
+        case AlarmSeverity::WARNING: return "warning";
+        default:                     return "caution";
+    }
+}
+
+const char* AlarmStateName(AlarmState state) {
+    switch (state) {
+        case AlarmState::PENDING: return "pending";
+        case AlarmState::ACTIVE:  return "active";
+        default:                  return "clear";
+    }
+}
+
+AlarmEngine::AlarmEngine()
+    : count_(0), inputGroups_(0), dirty_(0),
+      anchorSet_(false), anchorLatitude_(NAN), anchorLongitude_(NAN), cosAnchorLatitude_(1.0),
+      shoreSeen_(false), eventHead_(0), eventCount_(0),
+      evaluations_(0), skipped_(0), droppedEvents_(0) {
+    memset(rules_, 0, sizeof(rules_));
+    memset(pendingSinceMs_, 0, sizeof(pendingSinceMs_));
+    request_.store(NONE, std::memory_order_relaxed);
+    dropRadiusCm_.store(0, std::memory_order_relaxed);
+    lock_.seq = 0;
+    publish();
+}
+
+uint8_t AlarmEngine::parseRules(const char* text, AlarmRule* rules, uint8_t maxRules, uint8_t* invalid) {
+    uint8_t count = 0;
+    uint8_t skipped = 0;
+    while (text != nullptr && *text != '\0') {
+        const char* end = strchr(text, '\n');
+        size_t length = end != nullptr ? static_cast<size_t>(end - text) : strlen(text);
+        const char* comment = static_cast<const char*>(memchr(text, '#', length));
+        size_t used = comment != nullptr ? static_cast<size_t>(comment - text) : length;
+
+        char line[MAX_LINE];
+        bool blank = strspn(text, " \t\r") >= used;
+        if (!blank) {
+            AlarmRule rule;
+            if (used < sizeof(line) && count < maxRules) {
+                memcpy(line, text, used);
+                line[used] = '\0';
+                if (parseLine(line, rule)) {
+                    rules[count++] = rule;
+                } else {
+                    skipped++;
+                }
+            } else {
+                skipped++;
+            }
+        }
+        text = end != nullptr ? end + 1 : nullptr;
+    }
+    if (invalid != nullptr) {
+        *invalid = skipped;
+    }
+    return count;
+}
+
+uint8_t AlarmEngine::defaultRules(AlarmRule* rules, uint8_t maxRules) {
+    const AlarmRule defaults[] = {
+        {AlarmType::ANCHOR_DRAG, 0, ALARM_DEFAULT_ANCHOR_RADIUS_M, 5.0f, 10},
+        {AlarmType::SHALLOW_DEPTH, 0, ALARM_DEFAULT_SHALLOW_M, 0.5f, 5},
+        {AlarmType::BATTERY_LOW, 0, ALARM_DEFAULT_BATTERY_LOW_V, 0.4f, 60},
+        {AlarmType::SHORE_POWER_LOST, 0, 0.5f, 0.0f, 10},
+    };
+    uint8_t count = 0;
+    for (const AlarmRule& rule : defaults) {
+        if (count < maxRules) {
+            rules[count++] = rule;
+        }
+    }
+    return count;
+}
+
+void AlarmEngine::setRules(const AlarmRule* rules, uint8_t count) {
+    clearAll(inputGroups_);
+    count_ = count < ALARM_MAX_RULES ? count : ALARM_MAX_RULES;
+    inputGroups_ = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        rules_[i].rule = rules[i];
+        rules_[i].state = AlarmState::CLEAR;
+        rules_[i].occurrence = 0;
+        rules_[i].value = NAN;
+        inputGroups_ |= AlarmTypeGroup(rules[i].type);
+    }
+    dirty_ = inputGroups_;
+}
+
+uint16_t AlarmEngine::allInputGroups() {
+    uint16_t groups = 0;
+    for (const AlarmTypeInfo& type : TYPES) {
+        groups |= type.group;
+    }
+    return groups;
+}
+
+void AlarmEngine::requestDrop(float radiusM) {
+    uint32_t radiusCm = std::isfinite(radiusM) && radiusM > 0.0f ? static_cast<uint32_t>(radiusM * 100.0f) : 0;
+    dropRadiusCm_.store(radiusCm, std::memory_order_relaxed);
+    request_.store(DROP, std::memory_order_release);
+}
+
+void AlarmEngine::requestRaise() {
+    request_.store(RAISE, std::memory_order_release);
+}
+
+void AlarmEngine::requestReset() {
+    request_.store(RESET, std::memory_order_release);
+}
+
+void AlarmEngine::applyRequest(const BoatDataStructure& data, uint16_t& groups) {
+    uint8_t request = request_.load(std::memory_order_acquire);
+    if (request == NONE) {
+        return;
+    }
+    const GPSData& gps = data.gps;
+    if (request == DROP && (!gps.available || !std::isfinite(gps.latitude) || !std::isfinite(gps.longitude))) {
+        return;  // Kept until the next fix
+    }
+    uint8_t expected = request;
+    if (!request_.compare_exchange_strong(expected, NONE, std::memory_order_acq_rel)) {
+        return;  // Replaced by a newer request: taken next call
+    }
+
+    if (request == DROP) {
+        clearAll(BoatDataGroup::GPS);
+        anchorSet_ = true;
+        anchorLatitude_ = gps.latitude;
+        anchorLongitude_ = gps.longitude;
+        cosAnchorLatitude_ = cos(gps.latitude * RADIANS_PER_DEGREE);
+        uint32_t radiusCm = dropRadiusCm_.load(std::memory_order_relaxed);
+        float radius = NAN;
+        for (uint8_t i = 0; i < count_; i++) {
+            AlarmRule& rule = rules_[i].rule;
+            if (rule.type == AlarmType::ANCHOR_DRAG) {
+                if (radiusCm != 0) {
+                    rule.threshold = radiusCm / 100.0f;
+                }
+                radius = rule.threshold;
+            }
+        }
+        queue(AlarmEventKind::ANCHOR_DROPPED, ALARM_MAX_RULES, AlarmType::ANCHOR_DRAG, 0, 0, radius, radius);
+        groups |= BoatDataGroup::GPS;
+    } else if (request == RAISE) {
+        clearAll(BoatDataGroup::GPS);
+        bool wasSet = anchorSet_;
+        anchorSet_ = false;
+        anchorLatitude_ = NAN;
+        anchorLongitude_ = NAN;
+        if (wasSet) {
+            queue(AlarmEventKind::ANCHOR_RAISED, ALARM_MAX_RULES, AlarmType::ANCHOR_DRAG, 0, 0, NAN, NAN);
+        }
+    } else {
+        clearAll(inputGroups_);
+        shoreSeen_ = false;
+        groups |= inputGroups_;
+    }
+}
+
+uint8_t AlarmEngine::evaluate(const BoatDataStructure& data, uint16_t changed, uint32_t nowMs) {
+    uint8_t queuedBefore = eventCount_;
+    uint16_t groups = static_cast<uint16_t>((changed | dirty_) & inputGroups_);
+    dirty_ = 0;
+    applyRequest(data, groups);
+
+    for (uint8_t i = 0; i < count_; i++) {
+        AlarmRuleStatus& status = rules_[i];
+        if ((AlarmTypeGroup(status.rule.type) & groups) != 0) {
+            float value = NAN;
+            bool measured = measure(status.rule, data, value);
+            status.value = measured ? value : NAN;
+            update(i, measured, value, nowMs);
+            evaluations_++;
+        } else if (status.state == AlarmState::PENDING) {
+            // Heartbeat: same value, only the delay advances
+            if (nowMs - pendingSinceMs_[i] >= status.rule.delayS * 1000UL) {
+                transition(i, AlarmState::ACTIVE);
+            }
+        } else {
+            skipped_++;
+        }
+    }
+    return static_cast<uint8_t>(eventCount_ - queuedBefore);
+}
+
+bool AlarmEngine::measure(const AlarmRule& rule, const BoatDataStructure& data, float& value) {
+    switch (rule.type) {
+        case AlarmType::ANCHOR_DRAG:
+            if (!anchorSet_ || !data.gps.available || !std::isfinite(data.gps.latitude) ||
+                !std::isfinite(data.gps.longitude)) {
+                return false;
+            }
+            value = static_cast<float>(distanceFromAnchor(data.gps.latitude, data.gps.longitude));
+            return true;
+        case AlarmType::SHALLOW_DEPTH:
+            value = data.dst.depth;
+            return data.dst.available && std::isfinite(value);
+        case AlarmType::BATTERY_LOW:
+            value = rule.instance == 0 ? data.battery.voltageA : data.battery.voltageB;
+            return data.battery.available && std::isfinite(value);
+        case AlarmType::SHORE_POWER_LOST:
+            if (!data.shorePower.available) {
+                return false;
+            }
+            shoreSeen_ |= data.shorePower.shorePowerOn;
+            value = data.shorePower.shorePowerOn ? 1.0f : 0.0f;
+            return shoreSeen_;
+        default:
+            return false;
+    }
+}
+
+void AlarmEngine::update(uint8_t index, bool measured, float value, uint32_t nowMs) {
+    AlarmRuleStatus& status = rules_[index];
+    const AlarmRule& rule = status.rule;
+    if (!measured) {
+        if (status.state == AlarmState::PENDING) {
+            status.state = AlarmState::CLEAR;  // No delay on stale data; an active alarm stays
+        }
+        return;
+    }
+
+    bool above = info(rule.type).above;
+    bool crossed = above ? value > rule.threshold : value < rule.threshold;
+    bool cleared = above ? value < rule.threshold - rule.hysteresis : value > rule.threshold + rule.hysteresis;
+    switch (status.state) {
+        case AlarmState::CLEAR:
+            if (crossed) {
+                pendingSinceMs_[index] = nowMs;
+                if (rule.delayS == 0) {
+                    transition(index, AlarmState::ACTIVE);
+                } else {
+                    status.state = AlarmState::PENDING;
+                }
+            }
+            break;
+        case AlarmState::PENDING:
+            if (!crossed) {
+                status.state = AlarmState::CLEAR;
+            } else if (nowMs - pendingSinceMs_[index] >= rule.delayS * 1000UL) {
+                transition(index, AlarmState::ACTIVE);
+            }
+            break;
+        case AlarmState::ACTIVE:
+            if (cleared) {
+                transition(index, AlarmState::CLEAR);
+            }
+            break;
+    }
+}
+
+void AlarmEngine::transition(uint8_t index, AlarmState state) {
+    AlarmRuleStatus& status = rules_[index];
+    bool raised = state == AlarmState::ACTIVE;
+    if (raised) {
+        status.occurrence++;
+    }
+    status.state = state;
+    queue(raised ? AlarmEventKind::RAISED : AlarmEventKind::CLEARED, index, status.rule.type,
+          status.rule.instance, status.occurrence, status.value, status.rule.threshold);
+}
+
+void AlarmEngine::clearAll(uint16_t groups) {
+    for (uint8_t i = 0; i < count_; i++) {
+        AlarmRuleStatus& status = rules_[i];
+        if ((AlarmTypeGroup(status.rule.type) & groups) == 0) {
+            continue;
+        }
+        if (status.state == AlarmState::ACTIVE) {
+            transition(i, AlarmState::CLEAR);
+        }
+        status.state = AlarmState::CLEAR;
+        status.value = NAN;
+    }
+}
+
+void AlarmEngine::queue(AlarmEventKind kind, uint8_t rule, AlarmType type, uint8_t instance, uint8_t occurrence,
+                        float value, float threshold) {
+    if (eventCount_ >= ALARM_EVENT_QUEUE) {
+        droppedEvents_++;
+        return;
+    }
+    AlarmEvent& event = events_[(eventHead_ + eventCount_) % ALARM_EVENT_QUEUE];
+    event.kind = kind;
+    event.rule = rule;
+    event.type = type;
+    event.instance = instance;
+    event.occurrence = occurrence;
+    event.value = value;
+    event.threshold = threshold;
+    eventCount_++;
+}
+
+bool AlarmEngine::takeEvent(AlarmEvent& out) {
+    if (eventCount_ == 0) {
+        return false;
+    }
+    out = events_[eventHead_];
+    eventHead_ = static_cast<uint8_t>((eventHead_ + 1) % ALARM_EVENT_QUEUE);
+    eventCount_--;
+    return true;
+}
+
+double AlarmEngine::distanceFromAnchor(double latitude, double longitude) const {
+    double dLon = longitude - anchorLongitude_;
+    if (dLon > 180.0) {
+        dLon -= 360.0;
+    } else if (dLon < -180.0) {
+        dLon += 360.0;
+    }
+    double north = (latitude - anchorLatitude_) * RADIANS_PER_DEGREE;
+    double east = dLon * RADIANS_PER_DEGREE * cosAnchorLatitude_;
+    return EARTH_RADIUS_M * sqrt(north * north + east * east);
+}
+
+uint8_t AlarmEngine::getActiveCount() const {
+    uint8_t active = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        if (rules_[i].state == AlarmState::ACTIVE) {
+            active++;
+        }
+    }
+    return active;
+}
+
+void AlarmEngine::publish() {
+    lock_.writeBegin();
+    published_.count = count_;
+    published_.active = getActiveCount();
+    memcpy(published_.rules, rules_, sizeof(rules_));
+    published_.anchorSet = anchorSet_;
+    published_.dropPending = request_.load(std::memory_order_relaxed) == DROP;
+    published_.anchorLatitude = anchorLatitude_;
+    published_.anchorLongitude = anchorLongitude_;
+    published_.evaluations = evaluations_;
+    published_.skipped = skipped_;
+    published_.droppedEvents = droppedEvents_;
+    lock_.writeEnd();
+}
+
+bool AlarmEngine::readStatus(AlarmStatus& out) const {
+    return lock_.read(published_, out);
+}
+
+void AlarmEngine::writeJson(JsonWriter& json, const AlarmStatus& status, const char* key) {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("active", (unsigned int)status.active)
+        .add("evaluations", (unsigned long)status.evaluations)
+        .add("skipped", (unsigned long)status.skipped)
+        .add("dropped_events", (unsigned long)status.droppedEvents)
+        .beginObject("anchor")
+            .add("set", status.anchorSet)
+            .add("pending", status.dropPending)
+            .add("lat", status.anchorLatitude, 7)
+            .add("lon", status.anchorLongitude, 7)
+        .endObject()
+        .beginArray("rules");
+    for (uint8_t i = 0; i < status.count && i < ALARM_MAX_RULES; i++) {
+        const AlarmRuleStatus& rule = status.rules[i];
+        json.beginObject()
+            .add("type", AlarmTypeName(rule.rule.type))
+            .add("instance", (unsigned int)rule.rule.instance)
+            .add("severity", AlarmSeverityName(AlarmTypeSeverity(rule.rule.type)))
+            .add("threshold", static_cast<double>(rule.rule.threshold), 1)
+            .add("hysteresis", static_cast<double>(rule.rule.hysteresis), 1)
+            .add("delay_s", (unsigned int)rule.rule.delayS)
+            .add("state", AlarmStateName(rule.state))
+            .add("value", static_cast<double>(rule.value), 1)
+            .add("occurrence", (unsigned int)rule.occurrence)
+            .endObject();
+    }
+    json.endArray().endObject();
+}
@@ -0,0 +1,320 @@
+/**
+ * @file AlarmEngine.h
+ * @brief Anchor watch and threshold alarms evaluated on BoatData changes
+ *
+ * A small rule table (ALARM_MAX_RULES) of four alarm types:
+ *
+ * | Type               | Input group  | Value                        | Raised when        |
+ * |--------------------|--------------|------------------------------|--------------------|
+ * | anchor_drag        | GPS          | Distance from the anchor, m  | above threshold    |
+ * | shallow_depth      | DST          | Depth, m                     | below threshold    |
+ * | battery_low        | BATTERY      | Bank voltage (instance 0/1)  | below threshold    |
+ * | shore_power_lost   | SHORE_POWER  | Shore power on (1) / off (0) | off after being on |
+ *
+ * evaluate() is the BoatData subscription callback's work: only rules whose
+ * input group is in the changed mask read their value, so a 10 Hz compass
+ * costs nothing and a depth update costs one compare. A heartbeat call
+ * (changed = 0) only advances the delay timers of PENDING rules. That is
+ * what lets the calculation and navigation stages be slowed down in the
+ * anchor power profile while the watch keeps its own rate.
+ *
+ * Per rule: CLEAR → PENDING when the threshold is crossed, → ACTIVE once it
+ * stayed crossed for delay_s (0 = at once), and back to CLEAR only when the
+ * value is hysteresis past the threshold the other way. An unavailable
+ * input drops a PENDING rule back to CLEAR and holds an ACTIVE one. The
+ * anchor rules are armed by requestDrop() (position taken at the next GPS
+ * fix) and disarmed by requestRaise(); the distance is equirectangular from
+ * the anchor (cos of its latitude cached), well within a metre at swinging
+ * radius. shore_power_lost arms once shore power was seen on.
+ *
+ * Rule file (ALARM_RULES_FILE, parseRules()), one rule per line, # comments:
+ * @code
+ * # type            threshold  hysteresis  delay_s  [instance]
+ * anchor_drag       40         5           10
+ * shallow_depth     2.5        0.5         5
+ * battery_low       11.8       0.4         60       0
+ * shore_power_lost  0          0           10
+ * @endcode
+ * Invalid lines are skipped and counted; without a file the built-in rules
+ * (defaultRules()) apply.
+ *
+ * Thread model: setRules(), evaluate(), takeEvent() and publish() run in
+ * the main loop. requestDrop(), requestRaise(), requestReset() and
+ * readStatus() may be called from the HTTP task (atomic request, SeqLock
+ * status copy).
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * engine.setRules(rules, AlarmEngine::parseRules(text, rules, ALARM_MAX_RULES, &invalid));
+ * boatData->subscribe(AlarmEngine::allInputGroups(), ALARM_MIN_INTERVAL_MS, onAlarmInputs, &engine, ALARM_HEARTBEAT_MS);
+ *
+ * void onAlarmInputs(void* context, uint16_t changed) {
+ *     AlarmEngine* engine = static_cast<AlarmEngine*>(context);
+ *     engine->evaluate(*boatData->getDataStructure(), changed, millis());
+ *     AlarmEvent event;
+ *     while (engine->takeEvent(event)) { ... log, PGN 126983, OLED ... }
+ *     engine->publish();
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed rule table and event ring, zero heap allocation
+ * - Principle VII (Fail-Safe): hysteresis and delays against flapping; missing inputs hold an alarm
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ALARM_ENGINE_H
+#define ALARM_ENGINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "BoatDataChangeTracker.h"
+#include "JsonWriter.h"
+#include "SeqLock.h"
+#include "../config.h"
+#include "../types/BoatDataTypes.h"
+
+/**
+ * @brief How urgent an alarm type is (PGN 126983 alert type)
+ */
+enum class AlarmSeverity : uint8_t {
+    ALARM,      ///< Needs action now
+    WARNING,    ///< Needs action soon
+    CAUTION     ///< Awareness
+};
+
+/// X(id, name, input group, severity, raised above the threshold)
+#define ALARM_TYPE_LIST(X) \
+    X(ANCHOR_DRAG, "anchor_drag", BoatDataGroup::GPS, AlarmSeverity::ALARM, true) \
+    X(SHALLOW_DEPTH, "shallow_depth", BoatDataGroup::DST, AlarmSeverity::ALARM, false) \
+    X(BATTERY_LOW, "battery_low", BoatDataGroup::BATTERY, AlarmSeverity::WARNING, false) \
+    X(SHORE_POWER_LOST, "shore_power_lost", BoatDataGroup::SHORE_POWER, AlarmSeverity::CAUTION, false)
+
+/**
+ * @brief Alarm types (rule file names)
+ */
+enum class AlarmType : uint8_t {
+#define ALARM_TYPE_ENUM(id, name, group, severity, above) id,
+    ALARM_TYPE_LIST(ALARM_TYPE_ENUM)
+#undef ALARM_TYPE_ENUM
+    COUNT
+};
+
+/// Rule file name of @p type ("unknown" if out of range)
+const char* AlarmTypeName(AlarmType type);
+
+/// Type named @p name; false if there is none
+bool AlarmTypeFromName(const char* name, AlarmType& out);
+
+/// BoatDataGroup bit read by @p type
+uint16_t AlarmTypeGroup(AlarmType type);
+
+/// Severity of @p type
+AlarmSeverity AlarmTypeSeverity(AlarmType type);
+
+/// "alarm", "warning" or "caution"
+const char* AlarmSeverityName(AlarmSeverity severity);
+
+/**
+ * @brief One alarm rule
+ */
+struct AlarmRule {
+    AlarmType type;
+    uint8_t instance;      ///< battery_low: bank 0 = A, 1 = B (0 otherwise)
+    float threshold;       ///< Radius m, depth m or volts (shore_power_lost: unused)
+    float hysteresis;      ///< Same unit, >= 0: distance past the threshold that clears the alarm
+    uint16_t delayS;       ///< Crossing must last this long before the alarm is raised
+};
+
+/**
+ * @brief Rule state
+ */
+enum class AlarmState : uint8_t {
+    CLEAR,      ///< Threshold not crossed (or input not armed)
+    PENDING,    ///< Crossed, delay running
+    ACTIVE      ///< Alarm raised
+};
+
+/// "clear", "pending" or "active"
+const char* AlarmStateName(AlarmState state);
+
+/**
+ * @brief What an AlarmEvent reports
+ */
+enum class AlarmEventKind : uint8_t {
+    RAISED,
+    CLEARED,
+    ANCHOR_DROPPED,
+    ANCHOR_RAISED
+};
+
+/**
+ * @brief State transition for the main loop (log, PGN 126983, display)
+ */
+struct AlarmEvent {
+    AlarmEventKind kind;
+    uint8_t rule;          ///< Rule index (anchor events: ALARM_MAX_RULES)
+    AlarmType type;        ///< Anchor events: ANCHOR_DRAG
+    uint8_t instance;
+    uint8_t occurrence;    ///< Times the rule was raised (wraps)
+    float value;           ///< Value at the transition (anchor dropped: radius m)
+    float threshold;
+};
+
+/**
+ * @brief Rule with its state, as published for readers
+ */
+struct AlarmRuleStatus {
+    AlarmRule rule;
+    AlarmState state;
+    uint8_t occurrence;
+    float value;           ///< Last value read, NaN before the first or while unavailable
+};
+
+/**
+ * @brief Consistent copy of the engine for the HTTP task
+ */
+struct AlarmStatus {
+    uint8_t count;                          ///< Rules in use
+    uint8_t active;                         ///< Rules in ACTIVE
+    AlarmRuleStatus rules[ALARM_MAX_RULES];
+    bool anchorSet;
+    bool dropPending;                       ///< requestDrop() waiting for a GPS fix
+    double anchorLatitude;                  ///< Decimal degrees (NaN while not set)
+    double anchorLongitude;
+    uint32_t evaluations;                   ///< Rules evaluated against a new value
+    uint32_t skipped;                       ///< Rules left alone (input group unchanged)
+    uint32_t droppedEvents;                 ///< Transitions lost to a full event ring
+};
+
+/**
+ * @class AlarmEngine
+ * @brief Rule table, change-driven evaluation and the event ring
+ */
+class AlarmEngine {
+public:
+    AlarmEngine();
+
+    /**
+     * @brief Parse a rule file
+     *
+     * @param text NUL-terminated file contents
+     * @param rules Output table
+     * @param maxRules Capacity of @p rules (further rules count as invalid)
+     * @param invalid Lines skipped (optional)
+     * @return Rules parsed
+     */
+    static uint8_t parseRules(const char* text, AlarmRule* rules, uint8_t maxRules, uint8_t* invalid);
+
+    /**
+     * @brief Built-in rules (no rule file): anchor drag, shallow depth, bank A low, shore power lost
+     * @return Rules written
+     */
+    static uint8_t defaultRules(AlarmRule* rules, uint8_t maxRules);
+
+    /**
+     * @brief Install a rule table (main loop)
+     *
+     * Active alarms are cleared (CLEARED events) and every rule is evaluated
+     * at the next evaluate(), changed or not.
+     */
+    void setRules(const AlarmRule* rules, uint8_t count);
+
+    /// BoatDataGroup mask of the installed rules
+    uint16_t inputGroups() const { return inputGroups_; }
+
+    /// BoatDataGroup mask of every alarm type (subscription mask, unchanged by a rule reload)
+    static uint16_t allInputGroups();
+
+    /**
+     * @brief Arm the anchor watch at the next GPS fix (any task)
+     *
+     * @param radiusM Drag radius for the anchor_drag rules (0 = keep the rule threshold)
+     */
+    void requestDrop(float radiusM);
+
+    /// Disarm the anchor watch at the next evaluate() (any task)
+    void requestRaise();
+
+    /// Clear every alarm and disarm shore_power_lost at the next evaluate() (any task)
+    void requestReset();
+
+    /**
+     * @brief Evaluate the rules whose input group is in @p changed (main loop)
+     *
+     * Pending requests are taken first. With @p changed = 0 (heartbeat) only
+     * the delay timers of PENDING rules run.
+     *
+     * @return Events queued by this call
+     */
+    uint8_t evaluate(const BoatDataStructure& data, uint16_t changed, uint32_t nowMs);
+
+    /// Oldest queued transition; false when none is left
+    bool takeEvent(AlarmEvent& out);
+
+    /// Copy the state for readStatus() (main loop)
+    void publish();
+
+    /// Consistent copy of the last publish() (any task); false if no stable copy was read
+    bool readStatus(AlarmStatus& out) const;
+
+    /**
+     * @brief Write @p status as a JSON object
+     *
+     * {"active":1,"evaluations":812,"skipped":4410,"dropped_events":0,
+     *  "anchor":{"set":true,"pending":false,"lat":59.4372105,"lon":24.7453688},
+     *  "rules":[{"type":"anchor_drag","instance":0,"severity":"alarm","threshold":40.0,
+     *            "hysteresis":5.0,"delay_s":10,"state":"active","value":52.3,"occurrence":1},...]}
+     */
+    static void writeJson(JsonWriter& json, const AlarmStatus& status, const char* key = nullptr);
+
+    uint8_t getRuleCount() const { return count_; }
+    const AlarmRuleStatus& getRule(uint8_t index) const { return rules_[index]; }
+    uint8_t getActiveCount() const;
+    bool isAnchorSet() const { return anchorSet_; }
+
+private:
+    enum Request : uint8_t { NONE, DROP, RAISE, RESET };
+
+    void applyRequest(const BoatDataStructure& data, uint16_t& groups);
+    bool measure(const AlarmRule& rule, const BoatDataStructure& data, float& value);
+    void update(uint8_t index, bool measured, float value, uint32_t nowMs);
+    void transition(uint8_t index, AlarmState state);
+    void clearAll(uint16_t groups);
+    void queue(AlarmEventKind kind, uint8_t rule, AlarmType type, uint8_t instance, uint8_t occurrence,
+               float value, float threshold);
+    double distanceFromAnchor(double latitude, double longitude) const;
+
+    AlarmRuleStatus rules_[ALARM_MAX_RULES];
+    uint32_t pendingSinceMs_[ALARM_MAX_RULES];
+    uint8_t count_;
+    uint16_t inputGroups_;
+    uint16_t dirty_;                   ///< Groups evaluated at the next call regardless of changes
+
+    bool anchorSet_;
+    double anchorLatitude_;
+    double anchorLongitude_;
+    double cosAnchorLatitude_;
+    bool shoreSeen_;                   ///< shore_power_lost armed
+
+    std::atomic<uint8_t> request_;
+    std::atomic<uint32_t> dropRadiusCm_;
+
+    AlarmEvent events_[ALARM_EVENT_QUEUE];
+    uint8_t eventHead_;
+    uint8_t eventCount_;
+
+    uint32_t evaluations_;
+    uint32_t skipped_;
+    uint32_t droppedEvents_;
+
+    AlarmStatus published_;
+    SeqLock lock_;
+};
+
+#endif // ALARM_ENGINE_H
@@ -0,0 +1,185 @@
+/**
+ * @file AllocTracker.cpp
+ * @brief Implementation of the per-tag allocation counters
+ */
+
+#include "AllocTracker.h"
+#include <string.h>
+
+AllocTracker::AllocTracker() : count_(0), depth_(0), untaggedAllocs_(0), untaggedFrees_(0), dropped_(0) {
+    memset(tags_, 0, sizeof(tags_));
+    memset(stack_, 0, sizeof(stack_));
+}
+
+int8_t AllocTracker::lookup(const char* tag) {
+    // Tags are static strings: the pointer matches on every call but the first
+    for (uint8_t i = 0; i < count_; i++) {
+        if (tags_[i].tag == tag) {
+            return static_cast<int8_t>(i);
+        }
+    }
+    for (uint8_t i = 0; i < count_; i++) {
+        if (strcmp(tags_[i].tag, tag) == 0) {
+            return static_cast<int8_t>(i);
+        }
+    }
+    if (count_ >= MAX_TAGS) {
+        return -1;
+    }
+    AllocTagStats& stats = tags_[count_];
+    memset(&stats, 0, sizeof(stats));
+    stats.tag = tag;
+    return static_cast<int8_t>(count_++);
+}
+
+void AllocTracker::enter(const char* tag) {
+    if (depth_ < MAX_DEPTH) {
+        int8_t index = tag != nullptr ? lookup(tag) : -1;
+        stack_[depth_].tag = index;
+        stack_[depth_].allocsAtEntry = index >= 0 ? tags_[index].allocs : 0;
+        if (index < 0) {
+            dropped_++;
+        }
+    } else {
+        dropped_++;
+    }
+    if (depth_ < UINT8_MAX) {
+        depth_++;
+    }
+}
+
+void AllocTracker::leave() {
+    if (depth_ == 0) {
+        return;
+    }
+    depth_--;
+    if (depth_ >= MAX_DEPTH) {
+        return;
+    }
+    const Frame& frame = stack_[depth_];
+    if (frame.tag < 0) {
+        return;
+    }
+    AllocTagStats& stats = tags_[frame.tag];
+    stats.scopes++;
+    uint32_t allocs = stats.allocs - frame.allocsAtEntry;
+    if (allocs > stats.maxAllocsPerScope) {
+        stats.maxAllocsPerScope = allocs;
+    }
+}
+
+void AllocTracker::recordAlloc(size_t size) {
+    uint8_t open = depth_ < MAX_DEPTH ? depth_ : MAX_DEPTH;
+    bool counted = false;
+    for (uint8_t i = 0; i < open; i++) {
+        if (stack_[i].tag >= 0) {
+            AllocTagStats& stats = tags_[stack_[i].tag];
+            stats.allocs++;
+            stats.bytes += size;
+            counted = true;
+        }
+    }
+    if (!counted) {
+        untaggedAllocs_++;
+    }
+}
+
+void AllocTracker::recordFree() {
+    uint8_t open = depth_ < MAX_DEPTH ? depth_ : MAX_DEPTH;
+    bool counted = false;
+    for (uint8_t i = 0; i < open; i++) {
+        if (stack_[i].tag >= 0) {
+            tags_[stack_[i].tag].frees++;
+            counted = true;
+        }
+    }
+    if (!counted) {
+        untaggedFrees_++;
+    }
+}
+
+const AllocTagStats* AllocTracker::find(const char* tag) const {
+    if (tag == nullptr) {
+        return nullptr;
+    }
+    for (uint8_t i = 0; i < count_; i++) {
+        if (tags_[i].tag == tag || strcmp(tags_[i].tag, tag) == 0) {
+            return &tags_[i];
+        }
+    }
+    return nullptr;
+}
+
+void AllocTracker::reset() {
+    // Open scopes stay on the stack; their tags are re-registered from index 0
+    uint8_t open = depth_ < MAX_DEPTH ? depth_ : MAX_DEPTH;
+    const char* openTags[MAX_DEPTH];
+    for (uint8_t i = 0; i < open; i++) {
+        openTags[i] = stack_[i].tag >= 0 ? tags_[stack_[i].tag].tag : nullptr;
+    }
+    count_ = 0;
+    untaggedAllocs_ = 0;
+    untaggedFrees_ = 0;
+    dropped_ = 0;
+    for (uint8_t i = 0; i < open; i++) {
+        stack_[i].tag = openTags[i] != nullptr ? lookup(openTags[i]) : -1;
+        stack_[i].allocsAtEntry = 0;
+    }
+}
+
+void AllocTracker::rankOrder(uint8_t* order) const {
+    // Insertion sort of at most MAX_TAGS indices by allocations; ties keep first-seen order
+    for (uint8_t i = 0; i < count_; i++) {
+        uint8_t j = i;
+        while (j > 0 && tags_[order[j - 1]].allocs < tags_[i].allocs) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+}
+
+const AllocTagStats* AllocTracker::ranked(uint8_t rank) const {
+    if (rank >= count_) {
+        return nullptr;
+    }
+    uint8_t order[MAX_TAGS];
+    rankOrder(order);
+    return &tags_[order[rank]];
+}
+
+void AllocTracker::writeTagJson(JsonWriter& json, const AllocTagStats& stats) {
+    json.beginObject()
+        .add("tag", stats.tag)
+        .add("scopes", (unsigned long)stats.scopes)
+        .add("allocs", (unsigned long)stats.allocs)
+        .add("frees", (unsigned long)stats.frees)
+        .add("bytes", (double)stats.bytes, 0)
+        .add("per_scope", stats.scopes > 0 ? (double)stats.allocs / stats.scopes : 0.0, 2)
+        .add("max_per_scope", (unsigned long)stats.maxAllocsPerScope)
+        .endObject();
+}
+
+bool AllocTracker::writeJson(JsonWriter& json, const char* key) const {
+    uint8_t order[MAX_TAGS];
+    rankOrder(order);
+
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("untagged", (unsigned long)untaggedAllocs_)
+        .add("dropped", (unsigned long)dropped_)
+        .beginArray("tags");
+    for (uint8_t i = 0; i < count_; i++) {
+        writeTagJson(json, tags_[order[i]]);
+    }
+    json.endArray().endObject();
+    return !json.overflowed();
+}
+
+AllocTracker& GetAllocTracker() {
+    static AllocTracker tracker;
+    return tracker;
+}
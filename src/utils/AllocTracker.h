@@ -0,0 +1,161 @@
+/**
+ * @file AllocTracker.h
+ * @brief Heap allocations per code section, for soak runs and zero-allocation tests
+ *
+ * HeapMonitor counts every allocation on the device; this says where they
+ * come from. Code sections are bracketed with a static tag:
+ *
+ * @code
+ * ALLOC_SCOPE("NMEA0183Handler::handleRMC");   // counted until scope exit
+ * @endcode
+ *
+ * Per tag: scopes entered, allocations, frees and bytes inside them, and
+ * the most allocations of a single scope. A soak run then reads
+ * "handleRMC: 9 allocations per sentence" as allocs / scopes, and a unit
+ * test asserts 0 for a hot path. Nested scopes count inclusively: every
+ * open scope sees the allocations of the ones inside it, so a reaction's
+ * tag covers the handlers it runs. Allocations outside any scope are
+ * counted as untagged.
+ *
+ * The allocator calls recordAlloc()/recordFree():
+ * - device: the heap hooks in ESP32SystemMetrics (CONFIG_HEAP_USE_HOOKS),
+ *   for the loop task only, never from an ISR
+ * - host tests: replacement operator new/delete (test/helpers/alloc_hooks.h)
+ *
+ * Scopes are entered from one context only (the main loop). With
+ * ALLOC_TRACK_ENABLED 0 (the default outside test and soak builds)
+ * ALLOC_SCOPE() compiles to nothing. Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed tag table, no heap of its own
+ * - Principle V (Observability): GET /memory "allocs" per tag in soak builds
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ALLOC_TRACKER_H
+#define ALLOC_TRACKER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Counters of one tag
+ */
+struct AllocTagStats {
+    const char* tag;             ///< Static string (not copied)
+    uint32_t scopes;             ///< Scopes left (completed)
+    uint32_t allocs;
+    uint32_t frees;
+    uint64_t bytes;              ///< Requested bytes of the allocations
+    uint32_t maxAllocsPerScope;
+};
+
+/**
+ * @class AllocTracker
+ * @brief Fixed table of per-tag allocation counters
+ */
+class AllocTracker {
+public:
+    static constexpr uint8_t MAX_TAGS = ALLOC_TRACK_MAX_TAGS;
+    static constexpr uint8_t MAX_DEPTH = ALLOC_TRACK_MAX_DEPTH;
+
+    AllocTracker();
+
+    /**
+     * @brief Open a scope of @p tag (a static string)
+     *
+     * A tag that does not fit the table, or a scope deeper than MAX_DEPTH,
+     * is not counted (getDropped()); leave() must still be called.
+     */
+    void enter(const char* tag);
+
+    /// Close the innermost scope
+    void leave();
+
+    /// Count one allocation of @p size bytes in every open scope
+    void recordAlloc(size_t size);
+
+    /// Count one free in every open scope
+    void recordFree();
+
+    uint8_t count() const { return count_; }
+    const AllocTagStats* at(uint8_t index) const { return index < count_ ? &tags_[index] : nullptr; }
+
+    /// Counters of @p tag (same pointer or same text), nullptr if never entered
+    const AllocTagStats* find(const char* tag) const;
+
+    /// Allocations (frees) with no scope open
+    uint32_t getUntaggedAllocs() const { return untaggedAllocs_; }
+    uint32_t getUntaggedFrees() const { return untaggedFrees_; }
+
+    /// Scopes not counted (table full or too deep)
+    uint32_t getDropped() const { return dropped_; }
+
+    /// Open scopes (counted or not)
+    uint8_t getDepth() const { return depth_; }
+
+    /// Zero the counters and forget the tags (open scopes keep counting)
+    void reset();
+
+    /// Tag with the @p rank-th most allocations (0 = most), nullptr past count()
+    const AllocTagStats* ranked(uint8_t rank) const;
+
+    /// One tag as an object, for responses streamed tag by tag
+    static void writeTagJson(JsonWriter& json, const AllocTagStats& stats);
+
+    /**
+     * @brief Write the tags, most allocations first
+     *
+     * {"untagged":12,"dropped":0,"tags":[{"tag":"n2k_rx","scopes":6000,"allocs":0,"frees":0,
+     *  "bytes":0,"per_scope":0.00,"max_per_scope":0},...]}
+     *
+     * @param key Member name in the enclosing object, or nullptr
+     * @return false if @p json overflowed
+     */
+    bool writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    struct Frame {
+        int8_t tag;              ///< Index in tags_, -1 = not counted
+        uint32_t allocsAtEntry;
+    };
+
+    AllocTagStats tags_[MAX_TAGS];
+    Frame stack_[MAX_DEPTH];
+    uint8_t count_;
+    uint8_t depth_;              ///< May exceed MAX_DEPTH (frames beyond are not stored)
+    uint32_t untaggedAllocs_;
+    uint32_t untaggedFrees_;
+    uint32_t dropped_;
+
+    int8_t lookup(const char* tag);
+    void rankOrder(uint8_t* order) const;
+};
+
+/// The tracker the allocator hooks feed
+AllocTracker& GetAllocTracker();
+
+/**
+ * @brief Enter at construction, leave at scope exit
+ */
+class AllocScope {
+public:
+    explicit AllocScope(const char* tag) { GetAllocTracker().enter(tag); }
+    ~AllocScope() { GetAllocTracker().leave(); }
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+};
+
+#if ALLOC_TRACK_ENABLED
+#define ALLOC_CONCAT_(a, b) a##b
+#define ALLOC_CONCAT(a, b) ALLOC_CONCAT_(a, b)
+#define ALLOC_SCOPE(tag) AllocScope ALLOC_CONCAT(allocScope_, __LINE__)(tag)
+#else
+#define ALLOC_SCOPE(tag) ((void)0)
+#endif
+
+#endif // ALLOC_TRACKER_H
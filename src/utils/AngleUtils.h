@@ -9,6 +9,13 @@
  * - [0, 2π]: For headings/bearings (0 = North, clockwise)
  * - [-π, π]: For relative angles (positive = starboard, negative = port)
  *
+ * Values are BoatScalar, so the math follows the BoatData storage precision.
+ *
+ * sin()/cos()/sincos()/atan2() are the calculation cycle's trig entry points:
+ * libm by default, FastMath kernels with CALC_FAST_MATH 1 (polynomials) or
+ * 2 (sine table). With fast math enabled the normalizations reduce with
+ * floor() instead of fmod(), which is a software loop on the ESP32.
+ *
  * @see specs/003-boatdata-feature-as/research.md line 263 (wraparound handling)
  * @see test/unit/test_angle_utils.cpp
  * @version 1.0.0
@@ -18,7 +25,12 @@
 #ifndef ANGLE_UTILS_H
 #define ANGLE_UTILS_H
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
+#include <cmath>
+#include "../types/BoatScalar.h"
+#include "FastMath.h"
 
 /**
  * @brief Utility class for angle operations
@@ -45,13 +57,18 @@ public:
      * double heading = 7.0;  // > 2π
      * double normalized = AngleUtils::normalizeToZeroTwoPi(heading);  // 0.717 rad
      */
-    static double normalizeToZeroTwoPi(double angle) {
+    static BoatScalar normalizeToZeroTwoPi(BoatScalar angle) {
+#if CALC_FAST_MATH
+        // Reduce to [0, 2π] using floor
+        angle -= BoatMath::TWO_PI_RAD * std::floor(angle / BoatMath::TWO_PI_RAD);
+#else
         // Reduce to [0, 2π] using fmod
-        angle = fmod(angle, 2 * M_PI);
+        angle = std::fmod(angle, BoatMath::TWO_PI_RAD);
+#endif
 
         // Handle negative angles
-        if (angle < 0.0) {
-            angle += 2 * M_PI;
+        if (angle < BoatScalar(0)) {
+            angle += BoatMath::TWO_PI_RAD;
         }
 
         return angle;
@@ -75,13 +92,13 @@ public:
      * double awa = 4.0;  // > π
      * double normalized = AngleUtils::normalizeToPiMinusPi(awa);  // -2.283 rad
      */
-    static double normalizeToPiMinusPi(double angle) {
+    static BoatScalar normalizeToPiMinusPi(BoatScalar angle) {
         // First normalize to [0, 2π]
         angle = normalizeToZeroTwoPi(angle);
 
         // Then shift to [-π, π]
-        if (angle > M_PI) {
-            angle -= 2 * M_PI;
+        if (angle > BoatMath::PI_RAD) {
+            angle -= BoatMath::TWO_PI_RAD;
         }
 
         return angle;
@@ -108,19 +125,19 @@ public:
      * double heading2 = 0.175;  // 10°
      * double change = AngleUtils::angleDifference(heading1, heading2);  // 0.261 rad (15°)
      */
-    static double angleDifference(double a, double b) {
+    static BoatScalar angleDifference(BoatScalar a, BoatScalar b) {
         // Normalize both angles to [0, 2π]
         a = normalizeToZeroTwoPi(a);
         b = normalizeToZeroTwoPi(b);
 
         // Calculate difference
-        double diff = b - a;
+        BoatScalar diff = b - a;
 
         // Normalize difference to [-π, π]
-        if (diff > M_PI) {
-            diff -= 2 * M_PI;
-        } else if (diff < -M_PI) {
-            diff += 2 * M_PI;
+        if (diff > BoatMath::PI_RAD) {
+            diff -= BoatMath::TWO_PI_RAD;
+        } else if (diff < -BoatMath::PI_RAD) {
+            diff += BoatMath::TWO_PI_RAD;
         }
 
         return diff;
@@ -143,18 +160,72 @@ public:
      * double turn = 0.349;   // 20°
      * double newHeading = AngleUtils::angleAdd(heading, turn);  // 0.366 rad (10°)
      */
-    static double angleAdd(double a, double b) {
+    static BoatScalar angleAdd(BoatScalar a, BoatScalar b) {
         return normalizeToZeroTwoPi(a + b);
     }
 
+    /**
+     * @brief sin(x) for the calculation cycle (kernel selected by CALC_FAST_MATH)
+     *
+     * @see FastMath.h for the error bound of each kernel
+     */
+    static BoatScalar sin(BoatScalar x) {
+#if CALC_FAST_MATH == 1
+        return static_cast<BoatScalar>(FastMath::sin(static_cast<float>(x)));
+#elif CALC_FAST_MATH == 2
+        return static_cast<BoatScalar>(FastMath::sinLut(static_cast<float>(x)));
+#else
+        return std::sin(x);
+#endif
+    }
+
+    /**
+     * @brief cos(x) for the calculation cycle (kernel selected by CALC_FAST_MATH)
+     */
+    static BoatScalar cos(BoatScalar x) {
+#if CALC_FAST_MATH == 1
+        return static_cast<BoatScalar>(FastMath::cos(static_cast<float>(x)));
+#elif CALC_FAST_MATH == 2
+        return static_cast<BoatScalar>(FastMath::cosLut(static_cast<float>(x)));
+#else
+        return std::cos(x);
+#endif
+    }
+
+    /**
+     * @brief sin(x) and cos(x) (one range reduction with CALC_FAST_MATH 1)
+     */
+    static void sincos(BoatScalar x, BoatScalar& s, BoatScalar& c) {
+#if CALC_FAST_MATH == 1
+        float fs, fc;
+        FastMath::sincos(static_cast<float>(x), fs, fc);
+        s = static_cast<BoatScalar>(fs);
+        c = static_cast<BoatScalar>(fc);
+#else
+        s = sin(x);
+        c = cos(x);
+#endif
+    }
+
+    /**
+     * @brief atan2(y, x) for the calculation cycle (FastMath minimax with CALC_FAST_MATH)
+     */
+    static BoatScalar atan2(BoatScalar y, BoatScalar x) {
+#if CALC_FAST_MATH
+        return static_cast<BoatScalar>(FastMath::atan2(static_cast<float>(y), static_cast<float>(x)));
+#else
+        return std::atan2(y, x);
+#endif
+    }
+
     /**
      * @brief Convert degrees to radians
      *
      * @param degrees Angle in degrees
      * @return Angle in radians
      */
-    static double degreesToRadians(double degrees) {
-        return degrees * M_PI / 180.0;
+    static BoatScalar degreesToRadians(BoatScalar degrees) {
+        return degrees * BoatMath::PI_RAD / BoatScalar(180);
     }
 
     /**
@@ -163,8 +234,8 @@ public:
      * @param radians Angle in radians
      * @return Angle in degrees
      */
-    static double radiansToDegrees(double radians) {
-        return radians * 180.0 / M_PI;
+    static BoatScalar radiansToDegrees(BoatScalar radians) {
+        return radians * BoatScalar(180) / BoatMath::PI_RAD;
     }
 
 private:
@@ -0,0 +1,54 @@
+/**
+ * @file AtomicFile.cpp
+ * @brief Implementation of the temp-file-and-rename writer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "AtomicFile.h"
+#include "OtaUpdate.h"
+
+AtomicFileWriter::AtomicFileWriter(const char* path)
+    : path_(path), open_(false), committed_(false) {
+    int length = snprintf(tmpPath_, sizeof(tmpPath_), "%s.tmp", path);
+    if (length <= 0 || static_cast<size_t>(length) >= sizeof(tmpPath_) || OtaFilesystemLocked()) {
+        tmpPath_[0] = '\0';
+        return;  // Not open (also while a filesystem image is installed)
+    }
+    file_ = LittleFS.open(tmpPath_, "w");
+    open_ = static_cast<bool>(file_);
+}
+
+AtomicFileWriter::~AtomicFileWriter() {
+    if (open_ && !committed_) {
+        file_.close();
+        LittleFS.remove(tmpPath_);  // Half-written contents never replace the file
+    }
+}
+
+bool AtomicFileWriter::commit() {
+    if (!open_ || committed_) {
+        return false;
+    }
+    file_.close();
+    if (!AtomicFileReplace(tmpPath_, path_)) {
+        open_ = false;
+        return false;
+    }
+    committed_ = true;
+    return true;
+}
+
+bool AtomicFileReplace(const char* source, const char* target) {
+    // LittleFS renames over an existing file in one metadata commit; a VFS
+    // that refuses to replace gets the target removed first (not atomic)
+    if (!LittleFS.rename(source, target)) {
+        LittleFS.remove(target);
+        if (!LittleFS.rename(source, target)) {
+            LittleFS.remove(source);
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,77 @@
+/**
+ * @file AtomicFile.h
+ * @brief Replace a LittleFS file all at once: write "<path>.tmp", then rename it over the file
+ *
+ * Opening a configuration file with "w" truncates it first, so a reset or
+ * an error during the write leaves an empty or partial file behind and the
+ * next boot falls back to defaults. AtomicFileWriter writes the new
+ * contents next to it and only renames them into place once they were
+ * written completely; until commit() the previous file stays untouched.
+ *
+ * Usage pattern:
+ * @code
+ * AtomicFileWriter out("/log-filter.json");
+ * if (!out.isOpen() || serializeJson(doc, out.file()) == 0) {
+ *     return false;  // Temp file discarded, previous file unchanged
+ * }
+ * return out.commit();
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle VII (Fail-Safe): a file is either the old or the new version, never a partial one
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ATOMIC_FILE_H
+#define ATOMIC_FILE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+/**
+ * @class AtomicFileWriter
+ * @brief One replacement of one file (stack only, not copyable)
+ */
+class AtomicFileWriter {
+public:
+    /// Longest path handled (including ".tmp")
+    static constexpr size_t MAX_PATH = 48;
+
+    /// Opens "<path>.tmp" for writing; @p path must outlive the writer
+    explicit AtomicFileWriter(const char* path);
+
+    /// Discards the temp file unless commit() succeeded
+    ~AtomicFileWriter();
+
+    AtomicFileWriter(const AtomicFileWriter&) = delete;
+    AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+    /// The temp file could be created
+    bool isOpen() const { return open_; }
+
+    /// Temp file to write the new contents to
+    File& file() { return file_; }
+
+    /**
+     * @brief Close the temp file and rename it over the target
+     * @return false if the temp file could not be opened or renamed (target unchanged)
+     */
+    bool commit();
+
+private:
+    const char* path_;
+    char tmpPath_[MAX_PATH];
+    File file_;
+    bool open_;
+    bool committed_;
+};
+
+/**
+ * @brief Rename @p source over @p target (commit(), or a file staged as a whole elsewhere)
+ * @return false if the rename failed; @p source is removed then, @p target may be gone
+ */
+bool AtomicFileReplace(const char* source, const char* target);
+
+#endif // ATOMIC_FILE_H
@@ -0,0 +1,54 @@
+/**
+ * @file AttitudeFilter.cpp
+ * @brief Implementation of the heel and pitch complementary filter
+ *
+ * @see AttitudeFilter.h
+ */
+
+#include "AttitudeFilter.h"
+#include <math.h>
+
+AttitudeFilter::AttitudeFilter(double tauS, double rejectG)
+    : tauS_(tauS),
+      rejectG_(rejectG),
+      heel_(0.0),
+      pitch_(0.0),
+      seeded_(false),
+      rejected_(0) {
+}
+
+void AttitudeFilter::reset() {
+    heel_ = 0.0;
+    pitch_ = 0.0;
+    seeded_ = false;
+}
+
+void AttitudeFilter::update(const ImuSample& sample, double dtS) {
+    double ax = sample.accel[0];
+    double ay = sample.accel[1];
+    double az = sample.accel[2];
+    double norm = sqrt(ax * ax + ay * ay + az * az);
+    bool useAccel = fabs(norm - 1.0) <= rejectG_;
+
+    if (!seeded_) {
+        if (!useAccel) {
+            rejected_++;
+            return;  // Gyro alone has nothing to integrate from
+        }
+        heel_ = atan2(ay, az);
+        pitch_ = atan2(ax, sqrt(ay * ay + az * az));
+        seeded_ = true;
+        return;
+    }
+
+    heel_ += sample.gyro[0] * dtS;
+    pitch_ -= sample.gyro[1] * dtS;
+
+    if (!useAccel) {
+        rejected_++;
+        return;
+    }
+    double alpha = tauS_ / (tauS_ + dtS);
+    heel_ = alpha * heel_ + (1.0 - alpha) * atan2(ay, az);
+    pitch_ = alpha * pitch_ + (1.0 - alpha) * atan2(ax, sqrt(ay * ay + az * az));
+}
@@ -0,0 +1,87 @@
+/**
+ * @file AttitudeFilter.h
+ * @brief Complementary filter for heel and pitch from gyro and accelerometer samples
+ *
+ * The accelerometer gives heel and pitch against gravity, but on a boat it
+ * also measures every wave and slam. The gyro is clean over a few seconds
+ * and drifts beyond. Each sample integrates the gyro rates and pulls the
+ * result towards the accelerometer angles with
+ *   alpha = tau / (tau + dt)
+ * so motion faster than IMU_FILTER_TAU_S follows the gyro and the long-term
+ * angle follows gravity. Samples whose acceleration is further than
+ * IMU_ACCEL_REJECT_G from 1 g (slamming, a sharp tack) only integrate the
+ * gyro. The first accepted sample seeds both angles from the accelerometer.
+ *
+ * Mounting (sensor axes on the boat): X towards the bow, Y to port, Z up.
+ *   heel  = atan2(ay, az)                 positive = starboard down
+ *   pitch = atan2(ax, sqrt(ay^2 + az^2))  positive = bow up
+ * Heel rate is +gx, pitch rate is -gy (right-hand rule on those axes).
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * AttitudeFilter filter;
+ * for (uint8_t i = 0; i < count; i++) filter.update(samples[i], imu.getSamplePeriodS());
+ * if (filter.isValid()) boatData->updateAttitude(source, filter.getHeel(), filter.getPitch());
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ATTITUDE_FILTER_H
+#define ATTITUDE_FILTER_H
+
+#include <stdint.h>
+#include "../config.h"
+
+/**
+ * @brief One gyro and accelerometer reading in sensor axes
+ */
+struct ImuSample {
+    float accel[3];   ///< X, Y, Z acceleration in g
+    float gyro[3];    ///< X, Y, Z rate in rad/s
+};
+
+/**
+ * @class AttitudeFilter
+ * @brief Heel and pitch (radians) from a stream of ImuSample
+ */
+class AttitudeFilter {
+public:
+    /**
+     * @param tauS Crossover period between gyro and accelerometer
+     * @param rejectG Accelerometer used only while ||a| - 1 g| is at most this
+     */
+    explicit AttitudeFilter(double tauS = IMU_FILTER_TAU_S, double rejectG = IMU_ACCEL_REJECT_G);
+
+    /**
+     * @brief Advance by one sample
+     *
+     * @param dtS Time since the previous sample (the FIFO sample period)
+     */
+    void update(const ImuSample& sample, double dtS);
+
+    /// Forget the angles; the next accepted sample seeds them again
+    void reset();
+
+    /// Angles are seeded (at least one accepted accelerometer sample)
+    bool isValid() const { return seeded_; }
+
+    double getHeel() const { return heel_; }
+    double getPitch() const { return pitch_; }
+
+    /// Samples whose accelerometer was not used (outside the 1 g band)
+    uint32_t getRejected() const { return rejected_; }
+
+private:
+    double tauS_;
+    double rejectG_;
+    double heel_;
+    double pitch_;
+    bool seeded_;
+    uint32_t rejected_;
+};
+
+#endif // ATTITUDE_FILTER_H
@@ -0,0 +1,317 @@
+/**
+ * @file AutopilotForward.cpp
+ * @brief Implementation of the autopilot fast path
+ *
+ * @see AutopilotForward.h
+ */
+
+#include "AutopilotForward.h"
+#include <stdio.h>
+#include <string.h>
+#include "HotPath.h"
+
+namespace {
+
+// Payload scaling of 127250 / 127251 (NMEA 2000 fixed-point fields)
+const double HEADING_TENTHS_DEG_PER_LSB = 0.0001 * 572.9577951308232;      // 1e-4 rad
+const double ROT_TENTHS_DEG_MIN_PER_LSB = 3.125e-8 * 572.9577951308232 * 60.0;  // 3.125e-8 rad/s
+
+const uint16_t U16_NA = 0xFFFD;      // 0xFFFD-0xFFFF: reserved, error, not available
+const int16_t I16_NA = 0x7FFD;
+const int32_t I32_NA = 0x7FFFFFFD;
+
+const char HEX_DIGITS[] = "0123456789ABCDEF";
+const char* const SENTENCE_NAMES[AutopilotSentence::COUNT] = {"HDM", "HDG", "HDT", "ROT"};
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+int16_t readI16(const uint8_t* p) {
+    return static_cast<int16_t>(readU16(p));
+}
+
+int32_t readI32(const uint8_t* p) {
+    return static_cast<int32_t>(static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                                (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24));
+}
+
+int32_t roundTenths(double tenths) {
+    return static_cast<int32_t>(tenths < 0.0 ? tenths - 0.5 : tenths + 0.5);
+}
+
+/**
+ * @brief Sentence assembly with a running checksum
+ */
+struct SentenceOut {
+    char* p;
+    char* end;
+    uint8_t sum;
+    bool overflow;
+
+    SentenceOut(char* out, size_t size) : p(out), end(out + size), sum(0), overflow(false) {}
+
+    void put(const char* text, uint8_t length, uint8_t textSum) {
+        if (overflow || end - p < length) {
+            overflow = true;
+            return;
+        }
+        memcpy(p, text, length);
+        p += length;
+        sum ^= textSum;
+    }
+
+    void putChar(char c) {
+        if (overflow || p == end) {
+            overflow = true;
+            return;
+        }
+        *p++ = c;
+        sum ^= static_cast<uint8_t>(c);
+    }
+
+    /// "-12.3": integer digits, '.', one decimal
+    void putTenths(int32_t tenths) {
+        if (tenths < 0) {
+            putChar('-');
+            tenths = -tenths;
+        }
+        char digits[12];
+        int n = 0;
+        int32_t whole = tenths / 10;
+        do {
+            digits[n++] = static_cast<char>('0' + whole % 10);
+            whole /= 10;
+        } while (whole > 0);
+        while (n > 0) {
+            putChar(digits[--n]);
+        }
+        putChar('.');
+        putChar(static_cast<char>('0' + tenths % 10));
+    }
+
+    /// Magnitude and hemisphere of a signed value, or two empty fields
+    void putSigned(int16_t raw, char positive, char negative) {
+        putChar(',');
+        if (raw < I16_NA) {
+            int32_t tenths = roundTenths(raw * HEADING_TENTHS_DEG_PER_LSB);
+            putTenths(tenths < 0 ? -tenths : tenths);
+            putChar(',');
+            putChar(raw < 0 ? negative : positive);
+        } else {
+            putChar(',');
+        }
+    }
+
+    /// Checksum digits and CR/LF after the '*' of the closing piece
+    void close() {
+        if (overflow || end - p < 4) {
+            overflow = true;
+            return;
+        }
+        *p++ = HEX_DIGITS[sum >> 4];
+        *p++ = HEX_DIGITS[sum & 0x0F];
+        *p++ = '\r';
+        *p++ = '\n';
+        sum = 0;
+    }
+};
+
+}  // namespace
+
+AutopilotForward::AutopilotForward(uint8_t sentences, const char* talker)
+    : sentences_(sentences),
+      write_(nullptr),
+      context_(nullptr),
+      nowUs_(nullptr),
+      arrivalUs_(nullptr),
+      sent_(0),
+      dropped_(0),
+      rateLimited_(0),
+      overBudget_(0),
+      lastUs_(0),
+      maxUs_(0),
+      totalUs_(0) {
+    char text[12];
+    char t[3] = {talker[0], talker[0] != '\0' ? talker[1] : '\0', '\0'};
+    snprintf(text, sizeof(text), "$%sHDM,", t);
+    makePiece(hdm_[0], text);
+    makePiece(hdm_[1], ",M*");
+    snprintf(text, sizeof(text), "$%sHDG,", t);
+    makePiece(hdg_, text);
+    snprintf(text, sizeof(text), "$%sHDT,", t);
+    makePiece(hdt_[0], text);
+    makePiece(hdt_[1], ",T*");
+    snprintf(text, sizeof(text), "$%sROT,", t);
+    makePiece(rot_[0], text);
+    makePiece(rot_[1], ",A*");
+    memset(lastSentUs_, 0, sizeof(lastSentUs_));
+    memset(everSent_, 0, sizeof(everSent_));
+}
+
+void AutopilotForward::makePiece(Piece& piece, const char* text) {
+    size_t length = strlen(text);
+    if (length > sizeof(piece.text)) {
+        length = sizeof(piece.text);
+    }
+    memcpy(piece.text, text, length);
+    piece.length = static_cast<uint8_t>(length);
+    piece.sum = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (text[i] != '$' && text[i] != '*') {
+            piece.sum ^= static_cast<uint8_t>(text[i]);
+        }
+    }
+}
+
+void AutopilotForward::attach(AutopilotForwardWrite write, void* context, AutopilotForwardClock nowUs,
+                              AutopilotForwardClock arrivalUs) {
+    context_ = context;
+    nowUs_ = nowUs;
+    arrivalUs_ = arrivalUs;
+    write_ = write;
+}
+
+bool AutopilotForward::due(uint8_t index, uint32_t nowUs) const {
+    return !everSent_[index] || nowUs - lastSentUs_[index] >= AP_FORWARD_MIN_INTERVAL_MS * 1000UL;
+}
+
+size_t HOT_PATH_ATTR AutopilotForward::encodeAt(uint32_t pgn, const uint8_t* data, uint8_t length,
+                                                char* out, size_t size, uint32_t nowUs, bool limit,
+                                                uint8_t& included) {
+    included = 0;
+    SentenceOut s(out, size);
+
+    if (pgn == 127250UL && length >= 8) {
+        uint16_t heading = readU16(data + 1);
+        uint8_t reference = data[7] & 0x03;
+        if (heading >= U16_NA) {
+            return 0;
+        }
+        int32_t tenths = roundTenths(heading * HEADING_TENTHS_DEG_PER_LSB);
+        if (tenths >= 3600) {
+            tenths -= 3600;
+        }
+
+        uint8_t wanted = reference == 1 ? (AutopilotSentence::HDM | AutopilotSentence::HDG)
+                       : reference == 0 ? AutopilotSentence::HDT : 0;
+        wanted &= sentences_;
+        for (uint8_t i = 0; i < AutopilotSentence::COUNT; i++) {
+            uint8_t bit = static_cast<uint8_t>(1 << i);
+            if ((wanted & bit) != 0 && limit && !due(i, nowUs)) {
+                wanted &= static_cast<uint8_t>(~bit);
+                rateLimited_++;
+            }
+        }
+
+        if (wanted & AutopilotSentence::HDM) {
+            s.put(hdm_[0].text, hdm_[0].length, hdm_[0].sum);
+            s.putTenths(tenths);
+            s.put(hdm_[1].text, hdm_[1].length, hdm_[1].sum);
+            s.close();
+        }
+        if (wanted & AutopilotSentence::HDG) {
+            s.put(hdg_.text, hdg_.length, hdg_.sum);
+            s.putTenths(tenths);
+            s.putSigned(readI16(data + 3), 'E', 'W');   // Deviation
+            s.putSigned(readI16(data + 5), 'E', 'W');   // Variation
+            s.put("*", 1, 0);
+            s.close();
+        }
+        if (wanted & AutopilotSentence::HDT) {
+            s.put(hdt_[0].text, hdt_[0].length, hdt_[0].sum);
+            s.putTenths(tenths);
+            s.put(hdt_[1].text, hdt_[1].length, hdt_[1].sum);
+            s.close();
+        }
+        included = wanted;
+    } else if (pgn == 127251UL && length >= 5 && (sentences_ & AutopilotSentence::ROT) != 0) {
+        int32_t rate = readI32(data + 1);
+        if (rate >= I32_NA) {
+            return 0;
+        }
+        if (limit && !due(3, nowUs)) {
+            rateLimited_++;
+            return 0;
+        }
+        s.put(rot_[0].text, rot_[0].length, rot_[0].sum);
+        s.putTenths(roundTenths(rate * ROT_TENTHS_DEG_MIN_PER_LSB));
+        s.put(rot_[1].text, rot_[1].length, rot_[1].sum);
+        s.close();
+        included = AutopilotSentence::ROT;
+    }
+
+    if (s.overflow) {
+        included = 0;
+        return 0;
+    }
+    return static_cast<size_t>(s.p - out);
+}
+
+bool HOT_PATH_ATTR AutopilotForward::forward(uint32_t pgn, const uint8_t* data, uint8_t length) {
+    if (write_ == nullptr || data == nullptr) {
+        return false;
+    }
+    uint32_t inUs = arrivalUs_ != nullptr ? arrivalUs_() : nowUs_();
+
+    char out[MAX_OUTPUT];
+    uint8_t included;
+    size_t bytes = encodeAt(pgn, data, length, out, sizeof(out), nowUs_(), true, included);
+    if (bytes == 0) {
+        return false;
+    }
+    if (write_(context_, reinterpret_cast<const uint8_t*>(out), bytes) != bytes) {
+        dropped_++;
+        return false;
+    }
+
+    uint32_t outUs = nowUs_();
+    for (uint8_t i = 0; i < AutopilotSentence::COUNT; i++) {
+        if (included & (1 << i)) {
+            lastSentUs_[i] = outUs;
+            everSent_[i] = true;
+        }
+    }
+    uint32_t latency = outUs - inUs;
+    lastUs_ = latency;
+    if (latency > maxUs_) {
+        maxUs_ = latency;
+    }
+    if (latency > AP_FORWARD_LATENCY_BUDGET_US) {
+        overBudget_++;
+    }
+    totalUs_ += latency;
+    sent_++;
+    return true;
+}
+
+void AutopilotForward::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.beginArray("sentences");
+    for (uint8_t i = 0; i < AutopilotSentence::COUNT; i++) {
+        if (sentences_ & (1 << i)) {
+            json.add(SENTENCE_NAMES[i]);
+        }
+    }
+    json.endArray()
+        .add("sent", (unsigned long)sent_)
+        .add("dropped", (unsigned long)dropped_)
+        .add("rate_limited", (unsigned long)rateLimited_)
+        .beginObject("latency_us")
+        .add("last", (unsigned long)lastUs_)
+        .add("mean", (unsigned long)getMeanUs())
+        .add("max", (unsigned long)maxUs_)
+        .add("budget", (unsigned long)AP_FORWARD_LATENCY_BUDGET_US)
+        .add("over_budget", (unsigned long)overBudget_)
+        .endObject()
+        .endObject();
+}
+
+AutopilotForward& GetAutopilotForward() {
+    static AutopilotForward forward;
+    return forward;
+}
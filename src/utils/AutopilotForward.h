@@ -0,0 +1,184 @@
+/**
+ * @file AutopilotForward.h
+ * @brief Direct NMEA 2000 heading -> NMEA 0183 forward for an autopilot (receive context)
+ *
+ * The regular path takes a 127250 heading through parsing, validation,
+ * logging and BoatData, then waits for the next output timer: tens of
+ * milliseconds to the autopilot. This fast path converts the selected PGNs
+ * in the N2k receive context, before the BoatData handler runs, and queues
+ * the sentences on the NMEA 0183 TX line (Serial2, GPIO 27) at once:
+ * - 127250 magnetic: HDM and/or HDG (deviation and variation when sent)
+ * - 127250 true: HDT
+ * - 127251: ROT (degrees per minute)
+ * Only the active compass sender reaches it (N2kSourceTracker runs first).
+ *
+ * The constant parts of each sentence ("$HCHDM,", ",M*"...) are pre-encoded
+ * once, with their share of the checksum; a message writes its digits with
+ * integer arithmetic and folds them into the checksum, no printf and no heap.
+ * The raw PGN payload is decoded directly (fixed little-endian fields), so
+ * the library's parser is not on the path either.
+ *
+ * Output: one write per PGN with all of its sentences, queued whole or
+ * dropped whole (the writer never waits for the UART). A sentence type is
+ * sent at most every AP_FORWARD_MIN_INTERVAL_MS.
+ *
+ * Latency: from the frame's arrival estimate (the receive driver's, see
+ * ESP32N2kCanDriver::setFrameArrival()) until the sentences are in the UART
+ * FIFO. Last, mean and maximum are kept; every message above
+ * AP_FORWARD_LATENCY_BUDGET_US is counted. The wire time after that is the
+ * UART's (about 4.5 ms for an HDM at 38400 baud).
+ *
+ * Arduino-free (writer and clocks are injected, unit tested natively).
+ * forward(): receive context only. Getters and writeJson(): any context,
+ * unlocked (a value may lag by one message).
+ *
+ * Usage:
+ * @code
+ * AutopilotForward& ap = GetAutopilotForward();
+ * ap.attach(writeSerial2, serial0183, microsClock, frameArrivalClock);   // Before the receive task runs
+ * // N2kPGNDispatcher::HandleMsg():
+ * if (ap.handles(msg.PGN)) ap.forward(msg.PGN, msg.Data, msg.DataLen);
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef AUTOPILOT_FORWARD_H
+#define AUTOPILOT_FORWARD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Sentence selection bits (AP_FORWARD_SENTENCES)
+ */
+namespace AutopilotSentence {
+    constexpr uint8_t HDM = 1 << 0;
+    constexpr uint8_t HDG = 1 << 1;
+    constexpr uint8_t HDT = 1 << 2;
+    constexpr uint8_t ROT = 1 << 3;
+    constexpr uint8_t COUNT = 4;
+}
+
+/// Queue @p size bytes whole without waiting; @p size if queued, 0 if dropped
+typedef size_t (*AutopilotForwardWrite)(void* context, const uint8_t* data, size_t size);
+
+/// Microsecond clock (now, or the current frame's arrival estimate)
+typedef uint32_t (*AutopilotForwardClock)();
+
+/**
+ * @class AutopilotForward
+ * @brief Pre-encoded sentence templates, payload decode, rate limit and latency counters
+ */
+class AutopilotForward {
+public:
+    /**
+     * @param sentences AutopilotSentence bits to send
+     * @param talker Two-character talker of the sent sentences
+     */
+    explicit AutopilotForward(uint8_t sentences = AP_FORWARD_SENTENCES, const char* talker = AP_FORWARD_TALKER);
+
+    /**
+     * @brief Set the output and the clocks (nothing is sent before)
+     *
+     * @param arrivalUs Arrival estimate of the frame being handled (nullptr = @p nowUs)
+     */
+    void attach(AutopilotForwardWrite write, void* context, AutopilotForwardClock nowUs,
+                AutopilotForwardClock arrivalUs = nullptr);
+
+    uint8_t getSentences() const { return sentences_; }
+
+    /// @p pgn yields a selected sentence (cheap check before forward())
+    bool handles(uint32_t pgn) const {
+        return (pgn == 127250UL && (sentences_ & (AutopilotSentence::HDM | AutopilotSentence::HDG |
+                                                  AutopilotSentence::HDT)) != 0) ||
+               (pgn == 127251UL && (sentences_ & AutopilotSentence::ROT) != 0);
+    }
+
+    /**
+     * @brief Convert one received message and queue its sentences
+     *
+     * @param data PGN payload (tN2kMsg::Data)
+     * @return true if sentences were queued; false for unselected PGNs, NA
+     *         values, rate-limited sentences, a dropped write or no output
+     */
+    bool forward(uint32_t pgn, const uint8_t* data, uint8_t length);
+
+    /**
+     * @brief Encode @p pgn into @p out without sending or rate limiting
+     *
+     * @param size At least MAX_OUTPUT
+     * @return Bytes of the sentences (not terminated), 0 if nothing to send
+     */
+    size_t encode(uint32_t pgn, const uint8_t* data, uint8_t length, char* out, size_t size) {
+        uint8_t included;
+        return encodeAt(pgn, data, length, out, size, 0, false, included);
+    }
+
+    uint32_t getSent() const { return sent_; }
+    uint32_t getDropped() const { return dropped_; }
+    uint32_t getRateLimited() const { return rateLimited_; }
+    uint32_t getOverBudget() const { return overBudget_; }
+    uint32_t getLastUs() const { return lastUs_; }
+    uint32_t getMaxUs() const { return maxUs_; }
+    uint32_t getMeanUs() const { return sent_ > 0 ? static_cast<uint32_t>(totalUs_ / sent_) : 0; }
+
+    /**
+     * @brief Write the counters as a JSON object
+     *
+     * {"sentences":["HDM","HDG","ROT"],"sent":81234,"dropped":0,"rate_limited":1203,
+     *  "latency_us":{"last":180,"mean":175,"max":410,"budget":2000,"over_budget":0}}
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+    /// Longest output of one PGN (HDM + HDG)
+    static constexpr size_t MAX_OUTPUT = 96;
+
+private:
+    /**
+     * @brief Constant sentence part with its checksum share
+     */
+    struct Piece {
+        char text[12];
+        uint8_t length;
+        uint8_t sum;     ///< XOR of the characters that are inside the checksum
+    };
+
+    static void makePiece(Piece& piece, const char* text);
+    /// @param included Out: AutopilotSentence bits of the encoded sentences
+    size_t encodeAt(uint32_t pgn, const uint8_t* data, uint8_t length, char* out, size_t size,
+                    uint32_t nowUs, bool limit, uint8_t& included);
+    bool due(uint8_t index, uint32_t nowUs) const;
+
+    uint8_t sentences_;
+    Piece hdm_[2];       ///< "$HCHDM," / ",M*"
+    Piece hdg_;          ///< "$HCHDG,"
+    Piece hdt_[2];       ///< "$HCHDT," / ",T*"
+    Piece rot_[2];       ///< "$HCROT," / ",A*"
+
+    AutopilotForwardWrite write_;
+    void* context_;
+    AutopilotForwardClock nowUs_;
+    AutopilotForwardClock arrivalUs_;
+
+    uint32_t lastSentUs_[AutopilotSentence::COUNT];
+    bool everSent_[AutopilotSentence::COUNT];
+
+    uint32_t sent_;
+    uint32_t dropped_;
+    uint32_t rateLimited_;
+    uint32_t overBudget_;
+    uint32_t lastUs_;
+    uint32_t maxUs_;
+    uint64_t totalUs_;
+};
+
+/**
+ * @brief Process-wide autopilot forward (selection from AP_FORWARD_SENTENCES)
+ */
+AutopilotForward& GetAutopilotForward();
+
+#endif // AUTOPILOT_FORWARD_H
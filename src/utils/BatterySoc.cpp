@@ -0,0 +1,136 @@
+/**
+ * @file BatterySoc.cpp
+ * @brief Implementation of the coulomb-counting state-of-charge estimator
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BatterySoc.h"
+#include <math.h>
+
+namespace {
+
+constexpr double UAS_PER_AH = 3600.0 * 1000000.0;
+
+}  // namespace
+
+double BatteryRestingSoc(double volts) {
+    double soc = (volts - ONEWIRE_SOC_EMPTY_V) / (ONEWIRE_SOC_FULL_V - ONEWIRE_SOC_EMPTY_V) * 100.0;
+    return soc < 0.0 ? 0.0 : (soc > 100.0 ? 100.0 : soc);
+}
+
+BatterySocEstimator::BatterySocEstimator(double capacityAh, double peukertExponent, double chargeEfficiency)
+    : capacityUAs_(static_cast<int64_t>(capacityAh * UAS_PER_AH)),
+      ratedCurrentA_(capacityAh / BATTERY_PEUKERT_RATED_H),
+      peukertExponent_(peukertExponent),
+      chargeEfficiency_(chargeEfficiency),
+      chargeUAs_(0),
+      valid_(false),
+      averageA_(0.0),
+      averaged_(false),
+      restMs_(0),
+      restMinV_(0.0),
+      restMaxV_(0.0),
+      restAnchored_(false),
+      anchors_(0) {}
+
+bool BatterySocEstimator::sample(double amps, double volts, uint32_t elapsedMs) {
+    bool anchored = false;
+    if (!valid_) {
+        if (volts <= 0) {
+            return false;  // Nothing to start from
+        }
+        anchor(volts);
+        anchored = true;
+    } else if (elapsedMs > 0) {
+        // A × ms = mA·s; × 1000 = µA·s
+        double stored = amps;
+        if (amps < 0 && peukertExponent_ != 1.0 && ratedCurrentA_ > 0) {
+            stored = amps * pow(-amps / ratedCurrentA_, peukertExponent_ - 1.0);
+        } else if (amps > 0) {
+            stored = amps * chargeEfficiency_;
+        }
+        chargeUAs_ += static_cast<int64_t>(llround(stored * elapsedMs * 1000.0));
+        if (chargeUAs_ < 0) {
+            chargeUAs_ = 0;
+        } else if (chargeUAs_ > capacityUAs_) {
+            chargeUAs_ = capacityUAs_;
+        }
+    }
+
+    if (!averaged_) {
+        averageA_ = amps;
+        averaged_ = true;
+    } else if (elapsedMs > 0) {
+        averageA_ += (amps - averageA_) * (static_cast<double>(elapsedMs) / (BATTERY_TIME_TAU_MS + elapsedMs));
+    }
+
+    // Rest plateau: low current, voltage inside a narrow band for BATTERY_REST_MS
+    if (fabs(amps) >= BATTERY_REST_CURRENT_A || volts <= 0) {
+        restMs_ = 0;
+        restAnchored_ = false;
+        return anchored;
+    }
+    if (restMs_ == 0) {
+        restMinV_ = restMaxV_ = volts;
+    } else {
+        restMinV_ = volts < restMinV_ ? volts : restMinV_;
+        restMaxV_ = volts > restMaxV_ ? volts : restMaxV_;
+        if (restMaxV_ - restMinV_ > BATTERY_REST_PLATEAU_V) {
+            restMinV_ = restMaxV_ = volts;  // Still settling: the window starts again
+            restMs_ = 0;
+        }
+    }
+    restMs_ += elapsedMs > 0 ? elapsedMs : 1;   // Non-zero: the window has started
+    if (!restAnchored_ && restMs_ >= BATTERY_REST_MS) {
+        anchor(volts);
+        restAnchored_ = true;
+        anchors_++;
+        anchored = true;
+    }
+    return anchored;
+}
+
+void BatterySocEstimator::anchor(double volts) {
+    chargeUAs_ = static_cast<int64_t>(BatteryRestingSoc(volts) / 100.0 * capacityUAs_);
+    valid_ = true;
+}
+
+double BatterySocEstimator::getStateOfCharge() const {
+    if (!valid_ || capacityUAs_ <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(chargeUAs_) * 100.0 / static_cast<double>(capacityUAs_);
+}
+
+BatterySocStatus BatterySocEstimator::getStatus() const {
+    BatterySocStatus status;
+    status.valid = valid_;
+    status.stateOfCharge = getStateOfCharge();
+    status.averageCurrent = averageA_;
+    status.timeToEmptyS = NAN;
+    status.timeToFullS = NAN;
+    if (valid_ && averageA_ <= -BATTERY_REST_CURRENT_A) {
+        double effective = -averageA_;
+        if (peukertExponent_ != 1.0 && ratedCurrentA_ > 0) {
+            effective *= pow(-averageA_ / ratedCurrentA_, peukertExponent_ - 1.0);
+        }
+        status.timeToEmptyS = static_cast<double>(chargeUAs_) / (effective * 1000000.0);
+    } else if (valid_ && averageA_ >= BATTERY_REST_CURRENT_A && chargeEfficiency_ > 0) {
+        status.timeToFullS = static_cast<double>(capacityUAs_ - chargeUAs_) / (averageA_ * chargeEfficiency_ * 1000000.0);
+    }
+    return status;
+}
+
+void BatterySocEstimator::restore(int64_t chargeUAs) {
+    chargeUAs_ = chargeUAs < 0 ? 0 : (chargeUAs > capacityUAs_ ? capacityUAs_ : chargeUAs);
+    valid_ = true;
+}
+
+void BatterySocEstimator::invalidate() {
+    valid_ = false;
+    chargeUAs_ = 0;
+    restMs_ = 0;
+    restAnchored_ = false;
+}
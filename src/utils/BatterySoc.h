@@ -0,0 +1,130 @@
+/**
+ * @file BatterySoc.h
+ * @brief Coulomb-counting state of charge of one battery bank
+ *
+ * The DS2438 monitors report a voltage-based state of charge, which is only
+ * meaningful at rest: under a 20 A load a full bank reads half empty. This
+ * estimator integrates the bank current instead and uses the voltage only
+ * where it is trustworthy:
+ *
+ * - Charge: a fixed-point accumulator in µA·s (int64), so integration
+ *   neither drifts nor loses small currents; clamped to [0, capacity].
+ * - Discharge: Peukert correction relative to the rated 20-hour current,
+ *   I_eff = I × (|I| / (C / BATTERY_PEUKERT_RATED_H))^(k − 1), k = BATTERY_PEUKERT_EXPONENT.
+ * - Charge: only BATTERY_CHARGE_EFFICIENCY of the current is stored.
+ * - Re-anchor: with |I| below BATTERY_REST_CURRENT_A for BATTERY_REST_MS and
+ *   the voltage within a BATTERY_REST_PLATEAU_V band (a drifting voltage
+ *   restarts the window), the charge is set from the resting voltage
+ *   (linear between ONEWIRE_SOC_EMPTY_V and ONEWIRE_SOC_FULL_V), once per
+ *   rest period.
+ * - Time to empty / full: from an exponential average of the current
+ *   (time constant BATTERY_TIME_TAU_MS); NaN while the bank is at rest.
+ *
+ * Until the first sample (and after a record without estimator state) the
+ * estimate is invalid; the first sample starts from the voltage.
+ *
+ * One sample() call is O(1) with one pow(). TripCounters owns an estimator
+ * per bank, feeds it with every sample and persists the accumulator in its
+ * "trip" record.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * BatterySocEstimator soc(BATTERY_A_CAPACITY_AH);
+ * soc.sample(amps, volts, elapsedMs);      // Every TRIP_SAMPLE_INTERVAL_MS
+ * if (soc.isValid()) percent = soc.getStateOfCharge();
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed state, no heap
+ * - Principle VII (Fail-Safe): invalid until initialized; the accumulator is clamped to the capacity
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BATTERY_SOC_H
+#define BATTERY_SOC_H
+
+#include <stdint.h>
+#include "../config.h"
+
+/**
+ * @brief Published estimate of one bank (copied under TripCounters' SeqLock)
+ */
+struct BatterySocStatus {
+    bool valid;
+    double stateOfCharge;     ///< Percent
+    double averageCurrent;    ///< Amperes, exponential average (positive = charging)
+    double timeToEmptyS;      ///< NaN unless discharging
+    double timeToFullS;       ///< NaN unless charging
+};
+
+/// State of charge of a resting bank from its voltage, percent (0-100)
+double BatteryRestingSoc(double volts);
+
+/**
+ * @class BatterySocEstimator
+ * @brief Integrated charge of one bank with rest-voltage re-anchoring
+ *
+ * Single-threaded (TripCounters' main-loop sample).
+ */
+class BatterySocEstimator {
+public:
+    /**
+     * @param capacityAh Rated (20-hour) capacity
+     * @param peukertExponent k (1.0 = no correction)
+     * @param chargeEfficiency Stored fraction of the charge current (0-1]
+     */
+    explicit BatterySocEstimator(double capacityAh, double peukertExponent = BATTERY_PEUKERT_EXPONENT,
+                                 double chargeEfficiency = BATTERY_CHARGE_EFFICIENCY);
+
+    /**
+     * @brief Integrate @p amps over @p elapsedMs
+     * @param amps Bank current, positive = charging
+     * @param volts Bank voltage (<= 0: no reading, no initialization or anchoring)
+     * @return true when the charge was set from the voltage (first sample or re-anchor)
+     */
+    bool sample(double amps, double volts, uint32_t elapsedMs);
+
+    bool isValid() const { return valid_; }
+
+    /// Percent of capacity (0 while invalid)
+    double getStateOfCharge() const;
+
+    BatterySocStatus getStatus() const;
+
+    /// Accumulator, µA·s (persisted)
+    int64_t getCharge() const { return chargeUAs_; }
+
+    /// Restore a persisted accumulator (clamped to the capacity); the estimate becomes valid
+    void restore(int64_t chargeUAs);
+
+    /// Forget the estimate: the next sample starts from the voltage
+    void invalidate();
+
+    /// Re-anchors from a resting voltage since construction
+    uint32_t getAnchors() const { return anchors_; }
+
+private:
+    void anchor(double volts);
+
+    int64_t capacityUAs_;
+    double ratedCurrentA_;          ///< Capacity over BATTERY_PEUKERT_RATED_H
+    double peukertExponent_;
+    double chargeEfficiency_;
+
+    int64_t chargeUAs_;
+    bool valid_;
+    double averageA_;
+    bool averaged_;
+
+    uint32_t restMs_;               ///< Time at rest in the current plateau window
+    double restMinV_;
+    double restMaxV_;
+    bool restAnchored_;             ///< This rest period already re-anchored
+    uint32_t anchors_;
+};
+
+#endif // BATTERY_SOC_H
@@ -0,0 +1,139 @@
+/**
+ * @file BigDigitFont.h
+ * @brief Page-aligned 12x16 digit atlas for direct SSD1306 framebuffer blits
+ *
+ * The instrument pages print values in double-height digits. Drawn with
+ * Adafruit GFX at text size 2 every lit pixel becomes a 2x2 fillRect, i.e.
+ * some 400 pixel writes with bounds checks per character. This atlas holds
+ * the same glyphs pre-scaled in the SSD1306 memory layout: one byte is one
+ * column of an 8-row page, a glyph is 12 columns by 2 pages. Drawing a
+ * character at a page-aligned position is 24 byte copies.
+ *
+ * The atlas is generated at compile time from the 5x7 base glyphs of the
+ * GFX font (each column and row doubled by BigDigitStretch()), so it lives
+ * in flash and matches what setTextSize(2) printed before, pixel for pixel.
+ *
+ * Characters: '0'-'9', '-', '.', ' '. Anything else draws as a blank cell,
+ * so a stale digit never survives. Glyphs are opaque (unlit pixels are
+ * cleared): a number drawn over another replaces it.
+ *
+ * Header-only, Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * uint8_t columns = BigDigitDraw(framebuffer, 44, 2, "  12.3");   // Rows 16-31
+ * dirty.markRect(44, 16, columns, BIG_DIGIT_HEIGHT);
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): 312 bytes in flash, no RAM, no heap
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BIG_DIGIT_FONT_H
+#define BIG_DIGIT_FONT_H
+
+#include <stdint.h>
+#include <string.h>
+#include "../config.h"
+
+#define BIG_DIGIT_WIDTH 12                       ///< Columns per character (10 glyph + 2 spacing)
+#define BIG_DIGIT_HEIGHT 16                      ///< Rows per character
+#define BIG_DIGIT_PAGES (BIG_DIGIT_HEIGHT / 8)   ///< SSD1306 pages per character
+#define BIG_DIGIT_GLYPHS 13                      ///< "0123456789-. "
+
+/**
+ * @brief Double the four bits of @p nibble (bit n → bits 2n and 2n+1)
+ *
+ * One 5x7 column byte gives the upper page from its low nibble and the
+ * lower page from its high nibble.
+ */
+constexpr uint8_t BigDigitStretch(uint8_t nibble) {
+    return static_cast<uint8_t>(((nibble & 0x1) ? 0x03 : 0) | ((nibble & 0x2) ? 0x0C : 0) |
+                                ((nibble & 0x4) ? 0x30 : 0) | ((nibble & 0x8) ? 0xC0 : 0));
+}
+
+static_assert(BigDigitStretch(0x0F) == 0xFF && BigDigitStretch(0x05) == 0x33, "BigDigitStretch doubles each bit");
+
+// Page p of a 5x7 column: columns doubled, two blank spacing columns
+#define BIG_DIGIT_COLUMN(p, v) BigDigitStretch(static_cast<uint8_t>((p) == 0 ? ((v) & 0x0F) : ((v) >> 4)))
+#define BIG_DIGIT_PAGE(p, a, b, c, d, e)                                              \
+    {BIG_DIGIT_COLUMN(p, a), BIG_DIGIT_COLUMN(p, a), BIG_DIGIT_COLUMN(p, b), BIG_DIGIT_COLUMN(p, b), \
+     BIG_DIGIT_COLUMN(p, c), BIG_DIGIT_COLUMN(p, c), BIG_DIGIT_COLUMN(p, d), BIG_DIGIT_COLUMN(p, d), \
+     BIG_DIGIT_COLUMN(p, e), BIG_DIGIT_COLUMN(p, e), 0, 0}
+#define BIG_DIGIT_GLYPH(a, b, c, d, e) {BIG_DIGIT_PAGE(0, a, b, c, d, e), BIG_DIGIT_PAGE(1, a, b, c, d, e)}
+
+/**
+ * @brief The atlas: [glyph][page][column], glyphs in "0123456789-. " order
+ *
+ * A function-local constant, so every translation unit shares one copy.
+ */
+inline const uint8_t (*BigDigitAtlas())[BIG_DIGIT_PAGES][BIG_DIGIT_WIDTH] {
+    static const uint8_t atlas[BIG_DIGIT_GLYPHS][BIG_DIGIT_PAGES][BIG_DIGIT_WIDTH] = {
+        BIG_DIGIT_GLYPH(0x3E, 0x51, 0x49, 0x45, 0x3E),  // 0
+        BIG_DIGIT_GLYPH(0x00, 0x42, 0x7F, 0x40, 0x00),  // 1
+        BIG_DIGIT_GLYPH(0x72, 0x49, 0x49, 0x49, 0x46),  // 2
+        BIG_DIGIT_GLYPH(0x21, 0x41, 0x49, 0x4D, 0x33),  // 3
+        BIG_DIGIT_GLYPH(0x18, 0x14, 0x12, 0x7F, 0x10),  // 4
+        BIG_DIGIT_GLYPH(0x27, 0x45, 0x45, 0x45, 0x39),  // 5
+        BIG_DIGIT_GLYPH(0x3C, 0x4A, 0x49, 0x49, 0x31),  // 6
+        BIG_DIGIT_GLYPH(0x41, 0x21, 0x11, 0x09, 0x07),  // 7
+        BIG_DIGIT_GLYPH(0x36, 0x49, 0x49, 0x49, 0x36),  // 8
+        BIG_DIGIT_GLYPH(0x46, 0x49, 0x49, 0x29, 0x1E),  // 9
+        BIG_DIGIT_GLYPH(0x08, 0x08, 0x08, 0x08, 0x08),  // -
+        BIG_DIGIT_GLYPH(0x00, 0x60, 0x60, 0x00, 0x00),  // .
+        BIG_DIGIT_GLYPH(0x00, 0x00, 0x00, 0x00, 0x00),  // space (and unknown characters)
+    };
+    return atlas;
+}
+
+#undef BIG_DIGIT_GLYPH
+#undef BIG_DIGIT_PAGE
+#undef BIG_DIGIT_COLUMN
+
+/// Atlas index of @p c (the blank cell for characters without a glyph)
+inline uint8_t BigDigitIndex(char c) {
+    if (c >= '0' && c <= '9') {
+        return static_cast<uint8_t>(c - '0');
+    }
+    if (c == '-') {
+        return 10;
+    }
+    if (c == '.') {
+        return 11;
+    }
+    return 12;
+}
+
+/**
+ * @brief Copy @p text into an SSD1306 framebuffer
+ *
+ * @param framebuffer OLED_SCREEN_WIDTH x OLED_SCREEN_HEIGHT, page-major (Adafruit_SSD1306::getBuffer())
+ * @param x Left column
+ * @param page Top page (row page * 8); rows below the screen are clipped
+ * @param text Characters to draw
+ * @return Columns written from @p x (clipped at the right edge)
+ */
+inline uint8_t BigDigitDraw(uint8_t* framebuffer, uint8_t x, uint8_t page, const char* text) {
+    if (framebuffer == nullptr || text == nullptr || x >= OLED_SCREEN_WIDTH || page >= OLED_SCREEN_HEIGHT / 8) {
+        return 0;
+    }
+    uint8_t pages = page + BIG_DIGIT_PAGES <= OLED_SCREEN_HEIGHT / 8 ? BIG_DIGIT_PAGES
+                                                                      : static_cast<uint8_t>(OLED_SCREEN_HEIGHT / 8 - page);
+    const uint8_t (*atlas)[BIG_DIGIT_PAGES][BIG_DIGIT_WIDTH] = BigDigitAtlas();
+    uint16_t column = x;
+    for (; *text != '\0' && column < OLED_SCREEN_WIDTH; text++) {
+        const uint8_t (*glyph)[BIG_DIGIT_WIDTH] = atlas[BigDigitIndex(*text)];
+        uint8_t width = column + BIG_DIGIT_WIDTH <= OLED_SCREEN_WIDTH ? BIG_DIGIT_WIDTH
+                                                                      : static_cast<uint8_t>(OLED_SCREEN_WIDTH - column);
+        for (uint8_t p = 0; p < pages; p++) {
+            memcpy(framebuffer + (page + p) * OLED_SCREEN_WIDTH + column, glyph[p], width);
+        }
+        column += width;
+    }
+    return static_cast<uint8_t>(column - x);
+}
+
+#endif // BIG_DIGIT_FONT_H
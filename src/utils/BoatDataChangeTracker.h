@@ -0,0 +1,221 @@
+/**
+ * @file BoatDataChangeTracker.h
+ * @brief Per-group change generations for BoatData consumers
+ *
+ * Every accepted BoatData write stamps the groups it touched with the next
+ * value of one global generation counter. A consumer remembers the
+ * generation it last processed and asks changedSince() for the dirty mask
+ * of groups written after it, so the 1 Hz /boatdata broadcast, the
+ * calculation cycle and future delta streams each skip unchanged data
+ * without sharing (and clearing) a single dirty flag.
+ *
+ * The engine and tank slots of BoatDataInstances carry their own stamp of
+ * the same counter, so instancesChangedSince() gives the slots written
+ * after a generation as two bitmasks (serializers send only those).
+ *
+ * Generations are 32-bit and monotonically increasing; comparisons are
+ * wrap-safe. Counters are written by the BoatData writer task only and read
+ * with the __atomic builtins, so readers on the other core may poll them.
+ *
+ * Header-only, Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * uint32_t seen = 0;
+ * ...
+ * uint16_t dirty = tracker.changedSince(seen);
+ * seen = tracker.getGeneration();
+ * if (dirty & (BoatDataGroup::WIND | BoatDataGroup::COMPASS)) { ... }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): 72 bytes (2 engine, 4 tank slots), zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOATDATA_CHANGE_TRACKER_H
+#define BOATDATA_CHANGE_TRACKER_H
+
+#include <stdint.h>
+#include "../config.h"
+
+static_assert(BOATDATA_ENGINE_INSTANCES <= 8 && BOATDATA_TANK_INSTANCES <= 8, "Instance masks are 8-bit");
+
+/**
+ * @brief Group selectors for BoatDataChangeTracker masks
+ *
+ * Bit n corresponds to group index n (getGroupGeneration()).
+ */
+namespace BoatDataGroup {
+    constexpr uint16_t GPS = 1 << 0;
+    constexpr uint16_t COMPASS = 1 << 1;
+    constexpr uint16_t WIND = 1 << 2;
+    constexpr uint16_t DST = 1 << 3;
+    constexpr uint16_t RUDDER = 1 << 4;
+    constexpr uint16_t ENGINE = 1 << 5;
+    constexpr uint16_t SAILDRIVE = 1 << 6;
+    constexpr uint16_t BATTERY = 1 << 7;
+    constexpr uint16_t SHORE_POWER = 1 << 8;
+    constexpr uint16_t CALIBRATION = 1 << 9;
+    constexpr uint16_t DERIVED = 1 << 10;
+
+    constexpr uint8_t COUNT = 11;
+    constexpr uint16_t ALL = (1u << COUNT) - 1;
+}
+
+/**
+ * @brief Engine and tank slots of BoatDataInstances (bit n: slot n)
+ */
+struct BoatDataInstanceMask {
+    uint8_t engines;
+    uint8_t tanks;
+
+    bool any() const { return (engines | tanks) != 0; }
+};
+
+/**
+ * @class BoatDataChangeTracker
+ * @brief Global generation counter plus the generation of each group's last write
+ */
+class BoatDataChangeTracker {
+public:
+    BoatDataChangeTracker() : generation_(0) {
+        for (uint8_t i = 0; i < BoatDataGroup::COUNT; i++) {
+            groupGeneration_[i] = 0;
+        }
+        for (uint8_t i = 0; i < BOATDATA_ENGINE_INSTANCES; i++) {
+            engineGeneration_[i] = 0;
+        }
+        for (uint8_t i = 0; i < BOATDATA_TANK_INSTANCES; i++) {
+            tankGeneration_[i] = 0;
+        }
+    }
+
+    /**
+     * @brief Record a write to @p groups (writer task only)
+     *
+     * Advances the generation once, however many groups the write touched.
+     */
+    void markChanged(uint16_t groups) {
+        BoatDataInstanceMask none = {0, 0};
+        markChanged(groups, none);
+    }
+
+    /**
+     * @brief Record a write to @p groups that touched the slots in @p instances
+     */
+    void markChanged(uint16_t groups, BoatDataInstanceMask instances) {
+        groups &= BoatDataGroup::ALL;
+        if (groups == 0 && !instances.any()) {
+            return;
+        }
+
+        uint32_t next = generation_ + 1;
+        if (next == 0) {
+            next = 1;  // 0 is reserved for "never written"
+        }
+        for (uint8_t i = 0; i < BoatDataGroup::COUNT; i++) {
+            if (groups & (1u << i)) {
+                __atomic_store_n(&groupGeneration_[i], next, __ATOMIC_RELAXED);
+            }
+        }
+        for (uint8_t i = 0; i < BOATDATA_ENGINE_INSTANCES; i++) {
+            if (instances.engines & (1u << i)) {
+                __atomic_store_n(&engineGeneration_[i], next, __ATOMIC_RELAXED);
+            }
+        }
+        for (uint8_t i = 0; i < BOATDATA_TANK_INSTANCES; i++) {
+            if (instances.tanks & (1u << i)) {
+                __atomic_store_n(&tankGeneration_[i], next, __ATOMIC_RELAXED);
+            }
+        }
+        __atomic_store_n(&generation_, next, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * @brief Generation of the latest write (0 = nothing written yet)
+     */
+    uint32_t getGeneration() const {
+        return __atomic_load_n(&generation_, __ATOMIC_ACQUIRE);
+    }
+
+    /**
+     * @brief Generation of group @p index's latest write (0 = never written)
+     */
+    uint32_t getGroupGeneration(uint8_t index) const {
+        return index < BoatDataGroup::COUNT ? __atomic_load_n(&groupGeneration_[index], __ATOMIC_RELAXED) : 0;
+    }
+
+    /**
+     * @brief Newest generation among @p groups (0 = none of them written yet)
+     *
+     * Changes exactly when one of @p groups is written, so it versions a
+     * response built from them (GET /api/boatdata ETag).
+     */
+    uint32_t latestOf(uint16_t groups) const {
+        uint32_t latest = 0;
+        for (uint8_t i = 0; i < BoatDataGroup::COUNT; i++) {
+            uint32_t stamp = getGroupGeneration(i);
+            if ((groups & (1u << i)) && stamp != 0 && (latest == 0 || static_cast<int32_t>(stamp - latest) > 0)) {
+                latest = stamp;
+            }
+        }
+        return latest;
+    }
+
+    /**
+     * @brief Dirty mask: groups written after generation @p generation
+     *
+     * Pass 0 to get every group written at least once.
+     */
+    uint16_t changedSince(uint32_t generation) const {
+        if (getGeneration() == generation) {
+            return 0;  // Common case: nothing new
+        }
+
+        uint16_t dirty = 0;
+        for (uint8_t i = 0; i < BoatDataGroup::COUNT; i++) {
+            uint32_t stamp = getGroupGeneration(i);
+            if (stamp != 0 && static_cast<int32_t>(stamp - generation) > 0) {
+                dirty = static_cast<uint16_t>(dirty | (1u << i));
+            }
+        }
+        return dirty;
+    }
+
+    /**
+     * @brief Engine and tank slots written after generation @p generation
+     */
+    BoatDataInstanceMask instancesChangedSince(uint32_t generation) const {
+        BoatDataInstanceMask dirty = {0, 0};
+        if (getGeneration() == generation) {
+            return dirty;
+        }
+        for (uint8_t i = 0; i < BOATDATA_ENGINE_INSTANCES; i++) {
+            if (newer(engineGeneration_[i], generation)) {
+                dirty.engines = static_cast<uint8_t>(dirty.engines | (1u << i));
+            }
+        }
+        for (uint8_t i = 0; i < BOATDATA_TANK_INSTANCES; i++) {
+            if (newer(tankGeneration_[i], generation)) {
+                dirty.tanks = static_cast<uint8_t>(dirty.tanks | (1u << i));
+            }
+        }
+        return dirty;
+    }
+
+private:
+    static bool newer(const uint32_t& slotGeneration, uint32_t generation) {
+        uint32_t stamp = __atomic_load_n(&slotGeneration, __ATOMIC_RELAXED);
+        return stamp != 0 && static_cast<int32_t>(stamp - generation) > 0;
+    }
+
+    uint32_t generation_;
+    uint32_t groupGeneration_[BoatDataGroup::COUNT];
+    uint32_t engineGeneration_[BOATDATA_ENGINE_INSTANCES];
+    uint32_t tankGeneration_[BOATDATA_TANK_INSTANCES];
+};
+
+#endif // BOATDATA_CHANGE_TRACKER_H
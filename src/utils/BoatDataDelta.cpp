@@ -0,0 +1,183 @@
+/**
+ * @file BoatDataDelta.cpp
+ * @brief Implementation of the /boatdata keyframe + delta encoder
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BoatDataDelta.h"
+#include <math.h>
+
+BoatDataDeltaEncoder::BoatDataDeltaEncoder()
+    : sentEnginesAvailable_(0), sentTanksAvailable_(0), generation_(0), lastKeyframeMs_(0), keyframeIntervalMs_(BOATDATA_DELTA_KEYFRAME_MS), keyframePending_(true) {
+    for (uint8_t i = 0; i < BOATDATA_FIELD_COUNT; i++) {
+        sent_[i] = NAN;
+    }
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        sentAvailable_[g] = false;
+    }
+    for (uint8_t i = 0; i < BOATDATA_ENGINE_INSTANCES; i++) {
+        sentEngines_[i][0] = sentEngines_[i][1] = sentEngines_[i][2] = NAN;
+    }
+    for (uint8_t i = 0; i < BOATDATA_TANK_INSTANCES; i++) {
+        sentTanks_[i][0] = sentTanks_[i][1] = NAN;
+    }
+}
+
+void BoatDataDeltaEncoder::requestKeyframe() {
+    keyframePending_ = true;
+}
+
+double BoatDataDeltaEncoder::deadband(uint8_t id) {
+    return BoatDataSchema::fieldInfo(id).deadband;
+}
+
+bool BoatDataDeltaEncoder::moved(double last, double value, double band) {
+    if (isnan(value) || isnan(last)) {
+        return isnan(value) != isnan(last);  // Appeared or went missing
+    }
+    double diff = fabs(value - last);
+    return band <= 0.0 ? diff > 0.0 : diff >= band;
+}
+
+bool BoatDataDeltaEncoder::changed(uint8_t id, double value) const {
+    return moved(sent_[id], value, deadband(id));
+}
+
+bool BoatDataDeltaEncoder::write(JsonWriter& json, const BoatDataStructure& data, uint16_t dirty,
+                                 uint32_t generation, unsigned long nowMs) {
+    BoatDataDeltaSet set;
+    bool keyframe = update(data, dirty, generation, nowMs, set);
+    writeJson(json, data, set);
+    return keyframe;
+}
+
+bool BoatDataDeltaEncoder::update(const BoatDataStructure& data, uint16_t dirty, uint32_t generation,
+                                  unsigned long nowMs, BoatDataDeltaSet& set) {
+    return update(data, dirty, BoatDataInstanceMask{0, 0}, generation, nowMs, set);
+}
+
+bool BoatDataDeltaEncoder::update(const BoatDataStructure& data, uint16_t dirty, BoatDataInstanceMask slots,
+                                  uint32_t generation, unsigned long nowMs, BoatDataDeltaSet& set) {
+    set.keyframe = keyframePending_ || nowMs - lastKeyframeMs_ >= keyframeIntervalMs_;
+    set.timestampMs = nowMs;
+    set.fields = 0;
+    set.available = 0;
+    generation_ = generation;
+
+    if (set.keyframe) {
+        keyframePending_ = false;
+        lastKeyframeMs_ = nowMs;
+        dirty = BoatDataGroup::ALL;
+    }
+
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        const BoatDataGroupInfo& group = BoatDataSchema::groupInfo(g);
+        if ((dirty & group.mask) == 0) {
+            continue;
+        }
+        for (uint8_t i = group.firstField; i < group.firstField + group.fieldCount; i++) {
+            double value = BoatDataSchema::getValue(data, i);
+            if (set.keyframe || changed(i, value)) {
+                set.fields |= 1ull << i;
+                sent_[i] = value;
+            }
+        }
+        bool available = BoatDataSchema::isAvailable(data, g);
+        if (set.keyframe || available != sentAvailable_[g]) {
+            set.available = static_cast<uint16_t>(set.available | group.mask);
+            sentAvailable_[g] = available;
+        }
+    }
+    set.instances = updateInstances(data.instances, slots, set.keyframe);
+    return set.keyframe;
+}
+
+BoatDataInstanceMask BoatDataDeltaEncoder::updateInstances(const BoatDataInstances& instances,
+                                                           BoatDataInstanceMask slots, bool all) {
+    BoatDataInstanceMask assigned = BoatDataSchema::assignedInstances(instances);
+    if (all) {
+        slots = assigned;
+    }
+    BoatDataInstanceMask sent{0, 0};
+
+    for (uint8_t i = 0; i < BOATDATA_ENGINE_INSTANCES; i++) {
+        if ((slots.engines & assigned.engines & (1u << i)) == 0) {
+            continue;
+        }
+        const EngineData& engine = instances.engines[i];
+        double* last = sentEngines_[i];
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        if (all || engine.available != ((sentEnginesAvailable_ & bit) != 0) ||
+            moved(last[0], engine.engineRev, deadband(BOATDATA_FIELD_ENGINE_REV)) ||
+            moved(last[1], engine.oilTemperature, deadband(BOATDATA_FIELD_ENGINE_OIL_TEMPERATURE)) ||
+            moved(last[2], engine.alternatorVoltage, deadband(BOATDATA_FIELD_ENGINE_ALTERNATOR_VOLTAGE))) {
+            sent.engines = static_cast<uint8_t>(sent.engines | bit);
+            last[0] = engine.engineRev;
+            last[1] = engine.oilTemperature;
+            last[2] = engine.alternatorVoltage;
+            sentEnginesAvailable_ = static_cast<uint8_t>(engine.available ? sentEnginesAvailable_ | bit
+                                                                          : sentEnginesAvailable_ & ~bit);
+        }
+    }
+
+    for (uint8_t i = 0; i < BOATDATA_TANK_INSTANCES; i++) {
+        if ((slots.tanks & assigned.tanks & (1u << i)) == 0) {
+            continue;
+        }
+        const TankData& tank = instances.tanks[i];
+        double* last = sentTanks_[i];
+        uint8_t bit = static_cast<uint8_t>(1u << i);
+        if (all || tank.available != ((sentTanksAvailable_ & bit) != 0) ||
+            moved(last[0], tank.level, 0.1) || moved(last[1], tank.capacity, 0.1)) {
+            sent.tanks = static_cast<uint8_t>(sent.tanks | bit);
+            last[0] = tank.level;
+            last[1] = tank.capacity;
+            sentTanksAvailable_ = static_cast<uint8_t>(tank.available ? sentTanksAvailable_ | bit
+                                                                      : sentTanksAvailable_ & ~bit);
+        }
+    }
+    return sent;
+}
+
+void BoatDataDeltaEncoder::writeJson(JsonWriter& json, const BoatDataStructure& data, const BoatDataDeltaSet& set) {
+    json.beginObject().add("type", set.keyframe ? "keyframe" : "delta").add("timestamp", set.timestampMs);
+    if (set.keyframe) {
+        BoatDataSchema::writeJson(json, data);
+        BoatDataSchema::writeInstances(json, data.instances, set.instances);
+        json.endObject();
+        return;
+    }
+
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        const BoatDataGroupInfo& group = BoatDataSchema::groupInfo(g);
+
+        // Group object opened on its first change
+        bool open = false;
+        for (uint8_t i = group.firstField; i < group.firstField + group.fieldCount; i++) {
+            if (!set.has(i)) {
+                continue;
+            }
+            if (!open) {
+                json.beginObject(group.key);
+                open = true;
+            }
+            BoatDataSchema::writeField(json, data, i);
+        }
+
+        if (set.available & group.mask) {
+            if (!open) {
+                json.beginObject(group.key);
+                open = true;
+            }
+            json.add("available", BoatDataSchema::isAvailable(data, g));
+        }
+
+        if (open) {
+            json.add("lastUpdate", BoatDataSchema::lastUpdate(data, g)).endObject();
+        }
+    }
+    BoatDataSchema::writeInstances(json, data.instances, set.instances);
+    json.endObject();
+}
@@ -0,0 +1,162 @@
+/**
+ * @file BoatDataDelta.h
+ * @brief Keyframe + delta encoding of the /boatdata stream
+ *
+ * Clients that connect to /boatdata?mode=delta get a full keyframe first
+ * and then, on every broadcast tick, only the fields that moved beyond
+ * their deadband since the value last sent to them:
+ * @code
+ * {"type":"keyframe","timestamp":1234,"gps":{...},...,"derived":{...}}   // as the full frame
+ * {"type":"delta","timestamp":2234,"compass":{"magneticHeading":1.2345,"lastUpdate":2210}}
+ * @endcode
+ * Only groups the BoatDataChangeTracker reports dirty are compared. A group
+ * object appears in a delta when one of its fields or its available flag
+ * changed, and then also carries its lastUpdate. Differences are measured
+ * against the last value sent, not the last sample, so a slow drift is
+ * sent once it adds up to a deadband. A keyframe is sent at least every
+ * BOATDATA_DELTA_KEYFRAME_MS (setKeyframeInterval()) and on requestKeyframe()
+ * (new client).
+ *
+ * Deadbands (deadband()) come from the schema table (BOATDATA_SCHEMA_FIELDS):
+ * BOATDATA_DELTA_DEADBAND_ANGLE for rad and rad/s, _SPEED for kn and m/s,
+ * _POSITION for degrees, any change for counts and flags, one unit of the
+ * last JSON decimal for everything else.
+ *
+ * Engine and tank slots (BoatDataInstances) are compared the same way, per
+ * slot: only the slots the tracker reports changed, against the ENGINE
+ * deadbands (level and capacity 0.1). A slot that moved is sent whole in
+ * the "engines" / "tanks" arrays (BoatDataSchema::writeInstances()); a
+ * keyframe carries every assigned slot.
+ *
+ * All delta clients share one encoder (one baseline); a keyframe for a
+ * new client goes to every delta client. Which clients those are is kept
+ * in BoatDataStreamClients.
+ *
+ * The comparison and the output are separate steps: update() moves the
+ * baseline and returns the BoatDataDeltaSet of changed fields, which
+ * writeJson() renders as above and SignalKDelta::write() as Signal K.
+ * One comparison per tick serves both protocols.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): ~650 bytes of last-sent values, no heap
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOATDATA_DELTA_H
+#define BOATDATA_DELTA_H
+
+#include <stdint.h>
+#include "BoatDataSchema.h"
+#include "JsonWriter.h"
+#include "../config.h"
+
+static_assert(BOATDATA_FIELD_COUNT <= 64, "BoatDataDeltaSet::fields is a 64-bit mask");
+
+/**
+ * @brief What one update() found: changed fields and availability flags
+ */
+struct BoatDataDeltaSet {
+    uint64_t fields;            ///< Bit n: field n (BoatDataFieldId) moved beyond its deadband
+    uint16_t available;         ///< BoatDataGroup bits whose available flag changed
+    BoatDataInstanceMask instances;  ///< Engine and tank slots that moved or changed availability
+    bool keyframe;              ///< Everything is sent (fields/available then cover all)
+    unsigned long timestampMs;  ///< millis() of the update
+
+    bool has(uint8_t id) const { return (fields >> id) & 1u; }
+    bool empty() const { return !keyframe && fields == 0 && available == 0 && !instances.any(); }
+};
+
+/**
+ * @class BoatDataDeltaEncoder
+ * @brief Last-sent values of every schema field, and the keyframe schedule
+ *
+ * Usage (broadcast loop, one thread):
+ * @code
+ * uint32_t generation = changes.getGeneration();
+ * uint16_t dirty = changes.changedSince(encoder.getGeneration());
+ * BoatDataInstanceMask slots = changes.instancesChangedSince(encoder.getGeneration());
+ * boatData->getSnapshot(snapshot);  // after reading the generation
+ * encoder.write(json, snapshot, dirty, generation, millis());
+ *
+ * // Or compare once and render for several protocols
+ * BoatDataDeltaSet set;
+ * encoder.update(snapshot, dirty, slots, generation, millis(), set);
+ * BoatDataDeltaEncoder::writeJson(json, snapshot, set);
+ * SignalKDelta::write(signalK, snapshot, set, nullptr);
+ * @endcode
+ */
+class BoatDataDeltaEncoder {
+public:
+    /// Longest writeJson() output (a keyframe of every group), computed from the schema
+    static constexpr size_t JSON_MAX_BYTES =
+        BoatDataSchema::JSON_MAX_BYTES + BoatDataSchema::INSTANCE_JSON_MAX_BYTES
+        + sizeof("{\"type\":\"keyframe\",\"timestamp\":4294967295,}") - 1;
+
+    BoatDataDeltaEncoder();
+
+    /// Next write() sends a keyframe
+    void requestKeyframe();
+
+    /// Periodic keyframe interval (default BOATDATA_DELTA_KEYFRAME_MS; the rate governor scales it)
+    void setKeyframeInterval(uint32_t ms) { keyframeIntervalMs_ = ms; }
+    uint32_t getKeyframeInterval() const { return keyframeIntervalMs_; }
+
+    /// Change generation the last write() covered (0 before the first)
+    uint32_t getGeneration() const { return generation_; }
+
+    /**
+     * @brief Write a keyframe or delta object for @p data
+     *
+     * @param dirty BoatDataGroup bits written since getGeneration()
+     * @param generation Change generation read before @p data was copied
+     * @return true if a keyframe was written
+     */
+    bool write(JsonWriter& json, const BoatDataStructure& data, uint16_t dirty,
+               uint32_t generation, unsigned long nowMs);
+
+    /**
+     * @brief Compare @p data with the baseline, move the baseline, and report what changed
+     *
+     * Same arguments as write(); @p set receives the changes.
+     *
+     * @return true for a keyframe
+     */
+    bool update(const BoatDataStructure& data, uint16_t dirty, uint32_t generation,
+                unsigned long nowMs, BoatDataDeltaSet& set);
+
+    /**
+     * @brief update() that also compares the engine and tank slots in @p slots
+     *
+     * @param slots BoatDataChangeTracker::instancesChangedSince(getGeneration())
+     */
+    bool update(const BoatDataStructure& data, uint16_t dirty, BoatDataInstanceMask slots,
+                uint32_t generation, unsigned long nowMs, BoatDataDeltaSet& set);
+
+    /// Render @p set as the /boatdata?mode=delta keyframe or delta object
+    static void writeJson(JsonWriter& json, const BoatDataStructure& data, const BoatDataDeltaSet& set);
+
+    /// Smallest change of field @p id that is sent in a delta (0 = any change; schema deadband column)
+    static double deadband(uint8_t id);
+
+private:
+    static bool moved(double last, double value, double band);
+    bool changed(uint8_t id, double value) const;
+    BoatDataInstanceMask updateInstances(const BoatDataInstances& instances, BoatDataInstanceMask slots, bool all);
+
+    double sent_[BOATDATA_FIELD_COUNT];
+    bool sentAvailable_[BOATDATA_SCHEMA_GROUP_COUNT];
+    double sentEngines_[BOATDATA_ENGINE_INSTANCES][3];  ///< engineRev, oilTemperature, alternatorVoltage
+    double sentTanks_[BOATDATA_TANK_INSTANCES][2];      ///< level, capacity
+    uint8_t sentEnginesAvailable_;                       ///< Bit n: engine slot n sent as available
+    uint8_t sentTanksAvailable_;
+    uint32_t generation_;
+    unsigned long lastKeyframeMs_;
+    uint32_t keyframeIntervalMs_;
+    bool keyframePending_;
+};
+
+#endif // BOATDATA_DELTA_H
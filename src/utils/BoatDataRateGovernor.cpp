@@ -0,0 +1,122 @@
+/**
+ * @file BoatDataRateGovernor.cpp
+ * @brief Implementation of the /boatdata broadcast rate governor
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BoatDataRateGovernor.h"
+
+namespace {
+
+/// Default intervals, fastest first (5, 2, 1, 0.5 Hz)
+constexpr uint32_t INTERVALS_MS[] = {200, 500, 1000, 2000};
+constexpr uint8_t LEVELS = sizeof(INTERVALS_MS) / sizeof(INTERVALS_MS[0]);
+
+/// First level at least @p intervalMs long (the slowest for longer intervals)
+uint8_t levelFor(uint32_t intervalMs) {
+    for (uint8_t i = 0; i < LEVELS; i++) {
+        if (INTERVALS_MS[i] >= intervalMs) {
+            return i;
+        }
+    }
+    return LEVELS - 1;
+}
+
+static_assert(INTERVALS_MS[LEVELS - 1] / BOATDATA_STREAM_TICK_MS <= 255, "Governor intervals must fit uint8_t ticks");
+
+}  // namespace
+
+BoatDataRateGovernor::BoatDataRateGovernor()
+    : inputs_{0, CPU_IDLE_UNKNOWN, 0, 0}, state_(BoatDataGovernorState::NORMAL),
+      level_(levelFor(BOATDATA_BROADCAST_INTERVAL_MS)), minLevel_(0), idleCount_(0), changes_(0) {
+}
+
+bool BoatDataRateGovernor::evaluate(const BoatDataGovernorInputs& inputs) {
+    inputs_ = inputs;
+    bool measured = inputs.loopHz != 0;
+    bool idleMeasured = inputs.cpuIdlePct != CPU_IDLE_UNKNOWN;
+
+    if ((measured && inputs.loopHz < BOATDATA_GOVERNOR_LOOP_HZ_LOW) ||
+        (idleMeasured && inputs.cpuIdlePct < BOATDATA_GOVERNOR_CPU_IDLE_LOW) ||
+        inputs.freeHeap < BOATDATA_GOVERNOR_HEAP_LOW ||
+        inputs.maxQueued >= BOATDATA_STREAM_MAX_QUEUED) {
+        state_ = BoatDataGovernorState::PRESSURE;
+    } else if (measured && inputs.loopHz >= BOATDATA_GOVERNOR_LOOP_HZ_IDLE &&
+               (!idleMeasured || inputs.cpuIdlePct >= BOATDATA_GOVERNOR_CPU_IDLE_IDLE) &&
+               inputs.freeHeap >= BOATDATA_GOVERNOR_HEAP_IDLE && inputs.maxQueued == 0) {
+        state_ = BoatDataGovernorState::IDLE;
+    } else {
+        state_ = BoatDataGovernorState::NORMAL;
+    }
+
+    uint8_t level = level_;
+    if (state_ == BoatDataGovernorState::PRESSURE) {
+        idleCount_ = 0;
+        if (level < LEVELS - 1) {
+            level++;
+        }
+    } else if (state_ == BoatDataGovernorState::IDLE) {
+        if (++idleCount_ >= BOATDATA_GOVERNOR_IDLE_EVALUATIONS) {
+            idleCount_ = 0;
+            if (level > minLevel_) {
+                level--;
+            }
+        }
+    } else {
+        idleCount_ = 0;
+    }
+
+    if (level == level_) {
+        return false;
+    }
+    level_ = level;
+    changes_++;
+    return true;
+}
+
+bool BoatDataRateGovernor::setRange(uint32_t defaultMs, uint32_t fastestMs) {
+    minLevel_ = levelFor(fastestMs);
+    uint8_t level = levelFor(defaultMs);
+    if (level < minLevel_) {
+        level = minLevel_;
+    }
+    idleCount_ = 0;
+    if (level == level_) {
+        return false;
+    }
+    level_ = level;
+    changes_++;
+    return true;
+}
+
+uint32_t BoatDataRateGovernor::getIntervalMs() const {
+    return INTERVALS_MS[level_];
+}
+
+uint32_t BoatDataRateGovernor::getFastestMs() const {
+    return INTERVALS_MS[minLevel_];
+}
+
+uint8_t BoatDataRateGovernor::getTicks() const {
+    uint32_t ticks = INTERVALS_MS[level_] / BOATDATA_STREAM_TICK_MS;
+    return static_cast<uint8_t>(ticks > 0 ? ticks : 1);
+}
+
+uint8_t BoatDataRateGovernor::getFloorTicks() const {
+    return INTERVALS_MS[level_] > BOATDATA_BROADCAST_INTERVAL_MS ? getTicks() : 1;
+}
+
+uint32_t BoatDataRateGovernor::getKeyframeMs() const {
+    return static_cast<uint32_t>(static_cast<uint64_t>(BOATDATA_DELTA_KEYFRAME_MS) * INTERVALS_MS[level_] /
+                                 BOATDATA_BROADCAST_INTERVAL_MS);
+}
+
+const char* BoatDataRateGovernor::stateName(BoatDataGovernorState state) {
+    switch (state) {
+        case BoatDataGovernorState::IDLE:     return "idle";
+        case BoatDataGovernorState::PRESSURE: return "pressure";
+        default:                              return "normal";
+    }
+}
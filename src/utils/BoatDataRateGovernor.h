@@ -0,0 +1,123 @@
+/**
+ * @file BoatDataRateGovernor.h
+ * @brief Adapts the /boatdata default broadcast rate to the load of the ESP32
+ *
+ * Every BOATDATA_GOVERNOR_INTERVAL_MS the broadcast loop measures
+ * - the main loop frequency (headroom: ReactESP spins faster when idle)
+ * - the idle share of the busiest core (CpuIdleMonitor)
+ * - the free heap
+ * - the deepest WebSocket send queue of the stream clients
+ * and passes them to evaluate(), which steps the default interval along
+ * 200 / 500 / 1000 / 2000 ms (5 Hz ... 0.5 Hz):
+ * - PRESSURE (any input past its low threshold): one step slower per evaluation
+ * - IDLE (every input past its idle threshold) for BOATDATA_GOVERNOR_IDLE_EVALUATIONS
+ *   evaluations in a row: one step faster
+ * - NORMAL: hold
+ * so it backs off within seconds and speeds up only once the load has stayed
+ * low. It starts at BOATDATA_BROADCAST_INTERVAL_MS; setRange() restarts it
+ * elsewhere and caps the fastest step (Wi-Fi power profiles).
+ *
+ * Outputs:
+ * - getTicks(): default scheduler ticks (clients without a subscription,
+ *   delta and Signal K streams)
+ * - getFloorTicks(): while backed off below the default rate, subscribed
+ *   clients are slowed to it as well (1 = no floor)
+ * - getKeyframeMs(): delta keyframe interval, BOATDATA_DELTA_KEYFRAME_MS
+ *   scaled with the interval (the same number of frames between keyframes)
+ *
+ * A loop frequency of 0 or a CPU idle of CPU_IDLE_UNKNOWN (not measured yet)
+ * counts as neither busy nor idle.
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): sheds broadcast work before heap or loop time run out
+ * - Principle V (Network Debugging): state transitions are returned for logging (GOVERNOR_STATE)
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOATDATA_RATE_GOVERNOR_H
+#define BOATDATA_RATE_GOVERNOR_H
+
+#include <stdint.h>
+#include "../config.h"
+
+/**
+ * @brief Load classification of the last evaluation
+ */
+enum class BoatDataGovernorState : uint8_t {
+    NORMAL = 0,     ///< Hold the current rate
+    IDLE,           ///< Headroom on every input: speed up after a few evaluations
+    PRESSURE        ///< An input is past its low threshold: slow down
+};
+
+/**
+ * @brief Measurements of one evaluation
+ */
+struct BoatDataGovernorInputs {
+    uint32_t loopHz;        ///< Main loop frequency (0 = not measured yet)
+    uint8_t cpuIdlePct;     ///< Idle share of the busiest core (CPU_IDLE_UNKNOWN = not measured yet)
+    uint32_t freeHeap;      ///< Bytes
+    uint32_t maxQueued;     ///< Deepest send queue of a stream client (frames)
+};
+
+/**
+ * @class BoatDataRateGovernor
+ * @brief Hysteresis ladder of broadcast intervals (broadcast loop only)
+ */
+class BoatDataRateGovernor {
+public:
+    BoatDataRateGovernor();
+
+    /**
+     * @brief Classify @p inputs and move along the ladder
+     *
+     * @return true if the interval changed (apply the outputs)
+     */
+    bool evaluate(const BoatDataGovernorInputs& inputs);
+
+    /**
+     * @brief Restart at @p defaultMs and never speed up past @p fastestMs
+     *
+     * Both are rounded up to a ladder interval (Wi-Fi power profile). Under
+     * pressure the governor still backs off to the slowest interval.
+     *
+     * @return true if the interval changed (apply the outputs)
+     */
+    bool setRange(uint32_t defaultMs, uint32_t fastestMs);
+
+    /// Fastest interval the governor may reach, in ms
+    uint32_t getFastestMs() const;
+
+    BoatDataGovernorState getState() const { return state_; }
+    const BoatDataGovernorInputs& getInputs() const { return inputs_; }
+
+    /// Current default interval in ms
+    uint32_t getIntervalMs() const;
+
+    /// Current default interval in scheduler ticks (BOATDATA_STREAM_TICK_MS)
+    uint8_t getTicks() const;
+
+    /// Slowest allowed subscription, in ticks (1 = none)
+    uint8_t getFloorTicks() const;
+
+    /// Delta keyframe interval for the current rate
+    uint32_t getKeyframeMs() const;
+
+    /// Interval changes since boot
+    uint32_t getChanges() const { return changes_; }
+
+    /// "normal", "idle" or "pressure"
+    static const char* stateName(BoatDataGovernorState state);
+
+private:
+    BoatDataGovernorInputs inputs_;
+    BoatDataGovernorState state_;
+    uint8_t level_;         ///< Index into the interval ladder (0 = fastest)
+    uint8_t minLevel_;      ///< Fastest level allowed (setRange)
+    uint8_t idleCount_;     ///< IDLE evaluations in a row
+    uint32_t changes_;
+};
+
+#endif // BOATDATA_RATE_GOVERNOR_H
@@ -0,0 +1,116 @@
+/**
+ * @file BoatDataReplay.cpp
+ * @brief Implementation of the /boatdata replay ring
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BoatDataReplay.h"
+#include <string.h>
+
+BoatDataReplay::BoatDataReplay()
+    : head_(0), count_(0), sequence_(0), bursts_(0), replayed_(0) {
+    memset(ring_, 0, sizeof(ring_));
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        pending_[i].clientId.store(0, std::memory_order_relaxed);
+        pending_[i].sinceMs = 0;
+    }
+}
+
+void BoatDataReplay::record(const BoatDataSnapshot& snapshot) {
+    BoatDataDatagram& slot = ring_[head_];
+    slot.magic = BOATDATA_DATAGRAM_MAGIC;
+    slot.sequence = sequence_++;
+    slot.snapshot = snapshot;
+    head_ = static_cast<uint8_t>((head_ + 1) % CAPACITY);
+    if (count_ < CAPACITY) {
+        count_++;
+    }
+}
+
+const BoatDataDatagram& BoatDataReplay::at(uint8_t position) const {
+    return ring_[(head_ + CAPACITY - count_ + position) % CAPACITY];
+}
+
+uint8_t BoatDataReplay::firstSince(uint32_t sinceMs) const {
+    if (sinceMs == 0) {
+        return 0;
+    }
+    uint8_t position = 0;
+    // Wrap-safe: millis() rolls over after 49 days
+    while (position < count_ && static_cast<int32_t>(at(position).snapshot.timestampMs - sinceMs) <= 0) {
+        position++;
+    }
+    return position;
+}
+
+uint8_t BoatDataReplay::countSince(uint32_t sinceMs) const {
+    return static_cast<uint8_t>(count_ - firstSince(sinceMs));
+}
+
+size_t BoatDataReplay::copySince(uint32_t sinceMs, uint8_t* out, size_t capacity) const {
+    size_t written = 0;
+    for (uint8_t position = firstSince(sinceMs); position < count_; position++) {
+        if (written + sizeof(BoatDataDatagram) > capacity) {
+            break;
+        }
+        memcpy(out + written, &at(position), sizeof(BoatDataDatagram));
+        written += sizeof(BoatDataDatagram);
+    }
+    return written;
+}
+
+bool BoatDataReplay::request(uint32_t clientId, uint32_t sinceMs) {
+    if (clientId == 0) {
+        return false;
+    }
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (pending_[i].clientId.load(std::memory_order_acquire) != 0) {
+            continue;
+        }
+        pending_[i].sinceMs = sinceMs;
+        pending_[i].clientId.store(clientId, std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
+bool BoatDataReplay::takeRequest(uint32_t& clientId, uint32_t& sinceMs) {
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        uint32_t id = pending_[i].clientId.load(std::memory_order_acquire);
+        if (id == 0) {
+            continue;
+        }
+        clientId = id;
+        sinceMs = pending_[i].sinceMs;
+        pending_[i].clientId.store(0, std::memory_order_release);
+        return true;
+    }
+    return false;
+}
+
+void BoatDataReplay::recordSent(uint8_t records) {
+    bursts_++;
+    replayed_ += records;
+}
+
+void BoatDataReplay::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("records", (unsigned int)count_)
+        .add("capacity", (unsigned int)CAPACITY)
+        .add("interval_ms", (unsigned long)BOATDATA_REPLAY_INTERVAL_MS)
+        .add("sequence", (unsigned long)sequence_);
+    if (count_ > 0) {
+        json.add("oldest_ms", (unsigned long)at(0).snapshot.timestampMs);
+    } else {
+        json.add("oldest_ms", static_cast<const char*>(nullptr));
+    }
+    json.add("bursts", (unsigned long)bursts_)
+        .add("replayed", (unsigned long)replayed_)
+        .endObject();
+}
@@ -0,0 +1,132 @@
+/**
+ * @file BoatDataReplay.h
+ * @brief Recent BoatData snapshots for /boatdata clients that reconnect after a drop
+ *
+ * A tablet that loses Wi-Fi for a few seconds reconnects with a gap in its
+ * graphs. The broadcast loop records one BoatDataSnapshot every
+ * BOATDATA_REPLAY_INTERVAL_MS into a ring of BOATDATA_REPLAY_CAPACITY
+ * (60 s by default). A client that connects with
+ *
+ *   /boatdata?since=<timestamp>          (any format: ?mode=delta, ?fmt=bin)
+ *
+ * where timestamp is the "timestamp" (JSON) or timestampMs (binary) of the
+ * last frame it received, first gets one binary message with the recorded
+ * snapshots after that time, oldest first, then the live stream. Each
+ * record is a BoatDataDatagram (the UDP payload: "P2BD" magic, replay
+ * sequence, snapshot), so a reader tells the burst from a live binary frame
+ * by its magic and gaps by the sequence. since=0 asks for the whole ring.
+ *
+ * request() runs on the WebSocket event task; record(), takeRequest() and
+ * copySince() on the broadcast loop. A pending request's since is stored
+ * before its client ID, the ID is an atomic.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * // WS_EVT_CONNECT with ?since=: boatDataReplay.request(client->id(), since);
+ * // Broadcast loop, every BOATDATA_REPLAY_INTERVAL_MS:
+ * BoatDataSnapshot snapshot;
+ * snapshot.fill(*boatData->getDataStructure(), millis());
+ * boatDataReplay.record(snapshot);
+ * // Broadcast loop, before the live frames:
+ * uint32_t id, since;
+ * while (boatDataReplay.takeRequest(id, since)) {
+ *     size_t bytes = boatDataReplay.countSince(since) * sizeof(BoatDataDatagram);
+ *     WsBufferPool::Buffer frame = GetWsBufferPool().acquire(bytes);
+ *     boatDataReplay.copySince(since, frame->data(), bytes);
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed ring (130 B per record), burst sent from one pooled buffer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOATDATA_REPLAY_H
+#define BOATDATA_REPLAY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "BoatDataSnapshot.h"
+#include "JsonWriter.h"
+#include "WsBufferPool.h"
+#include "../config.h"
+
+static_assert(BOATDATA_REPLAY_CAPACITY * sizeof(BoatDataDatagram) <= WsBufferPool::MAX_BYTES,
+              "A whole replay ring must fit one WsBufferPool buffer");
+
+/**
+ * @class BoatDataReplay
+ * @brief Ring of recent snapshots and the replays the clients asked for
+ */
+class BoatDataReplay {
+public:
+    static constexpr uint8_t CAPACITY = BOATDATA_REPLAY_CAPACITY;
+
+    BoatDataReplay();
+
+    /// Append @p snapshot, overwriting the oldest record when full (broadcast loop)
+    void record(const BoatDataSnapshot& snapshot);
+
+    /// Records with a timestampMs after @p sinceMs (0 = all)
+    uint8_t countSince(uint32_t sinceMs) const;
+
+    /**
+     * @brief Copy the records after @p sinceMs, oldest first, as BoatDataDatagrams
+     *
+     * @param capacity Size of @p out; records that do not fit are left out (the newest)
+     * @return Bytes written (a multiple of sizeof(BoatDataDatagram))
+     */
+    size_t copySince(uint32_t sinceMs, uint8_t* out, size_t capacity) const;
+
+    /**
+     * @brief Queue a replay for client @p clientId (WebSocket event task)
+     *
+     * @return false for ID 0 or when BOATDATA_STREAM_MAX_CLIENTS replays are pending
+     */
+    bool request(uint32_t clientId, uint32_t sinceMs);
+
+    /// Take one pending replay (broadcast loop); false when there is none
+    bool takeRequest(uint32_t& clientId, uint32_t& sinceMs);
+
+    /// Count a burst of @p records sent to a client (broadcast loop)
+    void recordSent(uint8_t records);
+
+    /// Records held (up to CAPACITY)
+    uint8_t getCount() const { return count_; }
+
+    /// Sequence of the next record (records since boot)
+    uint32_t getSequence() const { return sequence_; }
+
+    /**
+     * @brief Write the ring and burst counters as a JSON object (GET /boatdata/stats)
+     *
+     * {"records":30,"capacity":30,"interval_ms":2000,"sequence":1234,"oldest_ms":61234,"bursts":3,"replayed":71}
+     * With @p key the object is a member of the enclosing one.
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    struct Pending {
+        std::atomic<uint32_t> clientId;   ///< 0 = free
+        uint32_t sinceMs;
+    };
+
+    BoatDataDatagram ring_[CAPACITY];
+    Pending pending_[BOATDATA_STREAM_MAX_CLIENTS];
+    uint8_t head_;          ///< Next record is written here
+    uint8_t count_;
+    uint32_t sequence_;
+    uint32_t bursts_;
+    uint32_t replayed_;
+
+    /// Position (0 = oldest) of the first record after @p sinceMs, count_ if none
+    uint8_t firstSince(uint32_t sinceMs) const;
+    const BoatDataDatagram& at(uint8_t position) const;
+};
+
+#endif // BOATDATA_REPLAY_H
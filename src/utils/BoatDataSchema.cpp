@@ -0,0 +1,351 @@
+/**
+ * @file BoatDataSchema.cpp
+ * @brief Field and group tables generated from the BoatData schema
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BoatDataSchema.h"
+#include <math.h>
+#include <string.h>
+#include <type_traits>
+#include <utility>
+
+// C++ type of each BoatDataFieldType (for the compile-time member checks)
+#define BOATDATA_SCHEMA_CTYPE_SCALAR BoatScalar
+#define BOATDATA_SCHEMA_CTYPE_DOUBLE double
+#define BOATDATA_SCHEMA_CTYPE_FLOAT float
+#define BOATDATA_SCHEMA_CTYPE_U8 uint8_t
+#define BOATDATA_SCHEMA_CTYPE_BOOL bool
+
+namespace {
+
+#define BOATDATA_SCHEMA_CHECK_TYPE(ID, GROUP, group, member, TYPE, unit, min, max, decimals, deadband) \
+    static_assert(std::is_same<decltype(std::declval<BoatDataStructure>().group.member), \
+                               BOATDATA_SCHEMA_CTYPE_##TYPE>::value, \
+                  "BoatDataSchema: " #group "." #member " is not " #TYPE);
+BOATDATA_SCHEMA_FIELDS(BOATDATA_SCHEMA_CHECK_TYPE)
+#undef BOATDATA_SCHEMA_CHECK_TYPE
+
+// Group of every field, to derive each group's field range at compile time
+constexpr uint8_t FIELD_GROUP[BOATDATA_FIELD_COUNT] = {
+#define BOATDATA_SCHEMA_FIELD_GROUP(ID, GROUP, group, member, TYPE, unit, min, max, decimals, deadband) \
+    BOATDATA_SCHEMA_GROUP_##GROUP,
+    BOATDATA_SCHEMA_FIELDS(BOATDATA_SCHEMA_FIELD_GROUP)
+#undef BOATDATA_SCHEMA_FIELD_GROUP
+};
+
+constexpr uint8_t firstFieldOf(uint8_t group, uint8_t i = 0) {
+    return i >= BOATDATA_FIELD_COUNT ? BOATDATA_FIELD_COUNT
+         : FIELD_GROUP[i] == group ? i
+         : firstFieldOf(group, static_cast<uint8_t>(i + 1));
+}
+
+constexpr uint8_t fieldCountOf(uint8_t group, uint8_t i = 0) {
+    return i >= BOATDATA_FIELD_COUNT ? 0
+         : static_cast<uint8_t>((FIELD_GROUP[i] == group ? 1 : 0) +
+                                fieldCountOf(group, static_cast<uint8_t>(i + 1)));
+}
+
+constexpr bool groupsInOrder(uint8_t i = 1) {
+    return i >= BOATDATA_FIELD_COUNT ||
+           (FIELD_GROUP[i] >= FIELD_GROUP[i - 1] && groupsInOrder(static_cast<uint8_t>(i + 1)));
+}
+
+static_assert(groupsInOrder(), "BoatDataSchema: fields must be listed group by group, in group order");
+static_assert(sizeof(BoatDataStructure) <= UINT16_MAX, "BoatDataSchema: offsets are 16-bit");
+
+const BoatDataFieldInfo FIELDS[BOATDATA_FIELD_COUNT] = {
+#define BOATDATA_SCHEMA_FIELD_INFO(ID, GROUP, group, member, TYPE, unit, min, max, decimals, deadband) \
+    {#member, unit, static_cast<uint16_t>(offsetof(BoatDataStructure, group.member)), \
+     BOATDATA_SCHEMA_GROUP_##GROUP, BOATDATA_TYPE_##TYPE, \
+     static_cast<float>(min), static_cast<float>(max), decimals, deadband},
+    BOATDATA_SCHEMA_FIELDS(BOATDATA_SCHEMA_FIELD_INFO)
+#undef BOATDATA_SCHEMA_FIELD_INFO
+};
+
+const BoatDataGroupInfo GROUPS[BOATDATA_SCHEMA_GROUP_COUNT] = {
+#define BOATDATA_SCHEMA_GROUP_INFO(ID, member) \
+    {#member, BoatDataGroup::ID, \
+     static_cast<uint16_t>(offsetof(BoatDataStructure, member)), \
+     static_cast<uint16_t>(sizeof(std::declval<BoatDataStructure>().member)), \
+     static_cast<uint16_t>(offsetof(BoatDataStructure, member.available)), \
+     static_cast<uint16_t>(offsetof(BoatDataStructure, member.lastUpdate)), \
+     static_cast<uint16_t>(offsetof(BoatDataStructure, versions.member)), \
+     firstFieldOf(BOATDATA_SCHEMA_GROUP_##ID), fieldCountOf(BOATDATA_SCHEMA_GROUP_##ID)},
+    BOATDATA_SCHEMA_GROUPS(BOATDATA_SCHEMA_GROUP_INFO)
+#undef BOATDATA_SCHEMA_GROUP_INFO
+};
+
+inline const uint8_t* at(const BoatDataStructure& data, uint16_t offset) {
+    return reinterpret_cast<const uint8_t*>(&data) + offset;
+}
+
+inline uint8_t* at(BoatDataStructure& data, uint16_t offset) {
+    return reinterpret_cast<uint8_t*>(&data) + offset;
+}
+
+/// Store @p value converted to field type @p type at @p p
+void store(uint8_t* p, uint8_t type, double value) {
+    switch (type) {
+        case BOATDATA_TYPE_SCALAR:
+            *reinterpret_cast<BoatScalar*>(p) = static_cast<BoatScalar>(value);
+            break;
+        case BOATDATA_TYPE_DOUBLE:
+            *reinterpret_cast<double*>(p) = value;
+            break;
+        case BOATDATA_TYPE_FLOAT:
+            *reinterpret_cast<float*>(p) = static_cast<float>(value);
+            break;
+        case BOATDATA_TYPE_U8:
+            *p = value <= 0.0 ? 0 : value >= 255.0 ? 255 : static_cast<uint8_t>(lround(value));
+            break;
+        case BOATDATA_TYPE_BOOL:
+            *reinterpret_cast<bool*>(p) = value != 0.0;
+            break;
+    }
+}
+
+}  // namespace
+
+namespace BoatDataSchema {
+
+const BoatDataFieldInfo& fieldInfo(uint8_t id) {
+    return FIELDS[id < BOATDATA_FIELD_COUNT ? id : 0];
+}
+
+const BoatDataGroupInfo& groupInfo(uint8_t group) {
+    return GROUPS[group < BOATDATA_SCHEMA_GROUP_COUNT ? group : 0];
+}
+
+uint8_t findField(const char* group, const char* key) {
+    if (group == nullptr || key == nullptr) {
+        return BOATDATA_FIELD_COUNT;
+    }
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        if (strcmp(group, GROUPS[g].key) != 0) {
+            continue;
+        }
+        for (uint8_t i = GROUPS[g].firstField; i < GROUPS[g].firstField + GROUPS[g].fieldCount; i++) {
+            if (strcmp(key, FIELDS[i].key) == 0) {
+                return i;
+            }
+        }
+        break;
+    }
+    return BOATDATA_FIELD_COUNT;
+}
+
+uint8_t findGroup(const char* key) {
+    if (key == nullptr) {
+        return BOATDATA_SCHEMA_GROUP_COUNT;
+    }
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        if (strcmp(key, GROUPS[g].key) == 0) {
+            return g;
+        }
+    }
+    return BOATDATA_SCHEMA_GROUP_COUNT;
+}
+
+double getValue(const BoatDataStructure& data, uint8_t id) {
+    const BoatDataFieldInfo& info = fieldInfo(id);
+    const uint8_t* p = at(data, info.offset);
+    switch (info.type) {
+        case BOATDATA_TYPE_SCALAR:
+            return static_cast<double>(*reinterpret_cast<const BoatScalar*>(p));
+        case BOATDATA_TYPE_DOUBLE:
+            return *reinterpret_cast<const double*>(p);
+        case BOATDATA_TYPE_FLOAT:
+            return static_cast<double>(*reinterpret_cast<const float*>(p));
+        case BOATDATA_TYPE_U8:
+            return *p;
+        case BOATDATA_TYPE_BOOL:
+            return *reinterpret_cast<const bool*>(p) ? 1.0 : 0.0;
+        default:
+            return NAN;
+    }
+}
+
+bool readValue(const BoatDataStructure& data, uint8_t id, double& value) {
+    const BoatDataFieldInfo& info = fieldInfo(id);
+    const SeqLock& guard = lock(data, info.group);
+    const uint8_t* p = at(data, info.offset);
+    bool consistent;
+    switch (info.type) {
+        case BOATDATA_TYPE_SCALAR: {
+            BoatScalar v;
+            consistent = guard.read(*reinterpret_cast<const BoatScalar*>(p), v);
+            value = static_cast<double>(v);
+            break;
+        }
+        case BOATDATA_TYPE_DOUBLE:
+            consistent = guard.read(*reinterpret_cast<const double*>(p), value);
+            break;
+        case BOATDATA_TYPE_FLOAT: {
+            float v;
+            consistent = guard.read(*reinterpret_cast<const float*>(p), v);
+            value = static_cast<double>(v);
+            break;
+        }
+        case BOATDATA_TYPE_U8: {
+            uint8_t v;
+            consistent = guard.read(*p, v);
+            value = v;
+            break;
+        }
+        case BOATDATA_TYPE_BOOL: {
+            bool v;
+            consistent = guard.read(*reinterpret_cast<const bool*>(p), v);
+            value = v ? 1.0 : 0.0;
+            break;
+        }
+        default:
+            value = NAN;
+            return false;
+    }
+    return consistent;
+}
+
+void setValue(BoatDataStructure& data, uint8_t id, double value) {
+    const BoatDataFieldInfo& info = fieldInfo(id);
+    store(at(data, info.offset), info.type, value);
+}
+
+void setMember(void* group, uint8_t id, double value) {
+    const BoatDataFieldInfo& info = fieldInfo(id);
+    store(static_cast<uint8_t*>(group) + (info.offset - groupInfo(info.group).offset), info.type, value);
+}
+
+bool inRange(uint8_t id, double value) {
+    const BoatDataFieldInfo& info = fieldInfo(id);
+    return value >= info.min && value <= info.max;
+}
+
+double clamp(uint8_t id, double value) {
+    const BoatDataFieldInfo& info = fieldInfo(id);
+    if (value < info.min) {
+        return info.min;
+    }
+    if (value > info.max) {
+        return info.max;
+    }
+    return value;
+}
+
+void stamp(BoatDataStructure& data, uint8_t group, unsigned long nowMs) {
+    const BoatDataGroupInfo& info = groupInfo(group);
+    *reinterpret_cast<bool*>(at(data, info.availableOffset)) = true;
+    *reinterpret_cast<unsigned long*>(at(data, info.lastUpdateOffset)) = nowMs;
+}
+
+bool isAvailable(const BoatDataStructure& data, uint8_t group) {
+    return *reinterpret_cast<const bool*>(at(data, groupInfo(group).availableOffset));
+}
+
+void setAvailable(BoatDataStructure& data, uint8_t group, bool available) {
+    *reinterpret_cast<bool*>(at(data, groupInfo(group).availableOffset)) = available;
+}
+
+unsigned long lastUpdate(const BoatDataStructure& data, uint8_t group) {
+    return *reinterpret_cast<const unsigned long*>(at(data, groupInfo(group).lastUpdateOffset));
+}
+
+const SeqLock& lock(const BoatDataStructure& data, uint8_t group) {
+    return *reinterpret_cast<const SeqLock*>(at(data, groupInfo(group).lockOffset));
+}
+
+SeqLock& lock(BoatDataStructure& data, uint8_t group) {
+    return *reinterpret_cast<SeqLock*>(at(data, groupInfo(group).lockOffset));
+}
+
+bool readGroup(const BoatDataStructure& shared, uint8_t group, BoatDataStructure& out) {
+    const BoatDataGroupInfo& info = groupInfo(group);
+    return lock(shared, group).readBytes(at(shared, info.offset), at(out, info.offset), info.size);
+}
+
+void writeField(JsonWriter& out, const BoatDataStructure& data, uint8_t id) {
+    const BoatDataFieldInfo& field = fieldInfo(id);
+    switch (field.type) {
+        case BOATDATA_TYPE_U8:
+            out.add(field.key, static_cast<unsigned>(*at(data, field.offset)));
+            break;
+        case BOATDATA_TYPE_BOOL:
+            out.add(field.key, *reinterpret_cast<const bool*>(at(data, field.offset)));
+            break;
+        default:
+            out.add(field.key, getValue(data, id), field.decimals);
+            break;
+    }
+}
+
+void writeJson(JsonWriter& out, const BoatDataStructure& data, uint16_t groups) {
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        const BoatDataGroupInfo& group = GROUPS[g];
+        if ((group.mask & groups) == 0) {
+            continue;
+        }
+        out.beginObject(group.key);
+        for (uint8_t i = group.firstField; i < group.firstField + group.fieldCount; i++) {
+            writeField(out, data, i);
+        }
+        out.add("available", isAvailable(data, g))
+           .add("lastUpdate", lastUpdate(data, g))
+           .endObject();
+    }
+}
+
+BoatDataInstanceMask assignedInstances(const BoatDataInstances& instances) {
+    BoatDataInstanceMask assigned;
+    assigned.engines = instances.enginesSeen;
+    assigned.tanks = static_cast<uint8_t>((1u << instances.tankCount) - 1);
+    return assigned;
+}
+
+void writeInstances(JsonWriter& out, const BoatDataInstances& instances, BoatDataInstanceMask slots) {
+    BoatDataInstanceMask assigned = assignedInstances(instances);
+    uint8_t engines = slots.engines & assigned.engines;
+    uint8_t tanks = slots.tanks & assigned.tanks;
+
+    if (engines != 0) {
+        out.beginArray("engines");
+        for (uint8_t i = 0; i < BOATDATA_ENGINE_INSTANCES; i++) {
+            if ((engines & (1u << i)) == 0) {
+                continue;
+            }
+            const EngineData& engine = instances.engines[i];
+            out.beginObject()
+               .add("instance", static_cast<unsigned>(i))
+               .add("engineRev", engine.engineRev, fieldInfo(BOATDATA_FIELD_ENGINE_REV).decimals)
+               .add("oilTemperature", engine.oilTemperature, fieldInfo(BOATDATA_FIELD_ENGINE_OIL_TEMPERATURE).decimals)
+               .add("alternatorVoltage", engine.alternatorVoltage,
+                    fieldInfo(BOATDATA_FIELD_ENGINE_ALTERNATOR_VOLTAGE).decimals)
+               .add("available", engine.available)
+               .add("lastUpdate", engine.lastUpdate)
+               .endObject();
+        }
+        out.endArray();
+    }
+
+    if (tanks != 0) {
+        out.beginArray("tanks");
+        for (uint8_t i = 0; i < BOATDATA_TANK_INSTANCES; i++) {
+            if ((tanks & (1u << i)) == 0) {
+                continue;
+            }
+            const TankData& tank = instances.tanks[i];
+            out.beginObject()
+               .add("fluidType", static_cast<unsigned>(tank.fluidType))
+               .add("instance", static_cast<unsigned>(tank.instance))
+               .add("level", tank.level, 1)
+               .add("capacity", tank.capacity, 1)
+               .add("available", tank.available)
+               .add("lastUpdate", tank.lastUpdate)
+               .endObject();
+        }
+        out.endArray();
+    }
+}
+
+}  // namespace BoatDataSchema
@@ -0,0 +1,340 @@
+/**
+ * @file BoatDataSchema.h
+ * @brief Compile-time field table of the BoatData sensor and derived groups
+ *
+ * BOATDATA_SCHEMA_GROUPS and BOATDATA_SCHEMA_FIELDS list every published
+ * BoatDataStructure group and value field once, with its JSON key, storage
+ * type, unit, valid range, output decimals and delta deadband. The tables
+ * generated from them (BoatDataSchema::fieldInfo(), groupInfo()) drive:
+ * - writeJson(): the /boatdata JSON (BoatDataSerializer), one flat loop over the table
+ * - BoatDataDeltaEncoder: the /boatdata?mode=delta keyframes and deltas
+ * - BoatData::getField()/setField()/getSnapshot(): generic access by field or group
+ * - HistoryRecorder: field values and freshness for the trend history
+ * - BoatDataSchema::inRange()/clamp(): the absolute range of every field
+ *
+ * Add a field by adding its member to BoatDataTypes.h and one
+ * BOATDATA_SCHEMA_FIELDS line here. The JSON key is the member name and
+ * fields of a group must stay contiguous; BoatDataSchema.cpp checks both
+ * the member types and the group order at compile time.
+ *
+ * FieldRange.h turns every min/max into a compile-time Range type for the
+ * handlers; group-specific warning thresholds (12 V band, wrap vs clamp of
+ * angles) stay in DataValidation.h next to the handlers that apply them.
+ *
+ * Implementation uses no Arduino calls (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * const BoatDataFieldInfo& info = BoatDataSchema::fieldInfo(BOATDATA_FIELD_DST_DEPTH);
+ * double depth = BoatDataSchema::getValue(data, BOATDATA_FIELD_DST_DEPTH);  // metres
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): tables in flash (const), no allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOATDATA_SCHEMA_H
+#define BOATDATA_SCHEMA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <math.h>
+#include "../config.h"
+#include "../types/BoatDataTypes.h"
+#include "BoatDataChangeTracker.h"
+#include "JsonWriter.h"
+
+/**
+ * @brief Published groups: G(ID, member)
+ *
+ * ID names the BoatDataGroup bit; member is the BoatDataStructure member
+ * and the JSON object key. Order = JSON order.
+ */
+#define BOATDATA_SCHEMA_GROUPS(G) \
+    G(GPS, gps) \
+    G(COMPASS, compass) \
+    G(WIND, wind) \
+    G(DST, dst) \
+    G(RUDDER, rudder) \
+    G(ENGINE, engine) \
+    G(SAILDRIVE, saildrive) \
+    G(BATTERY, battery) \
+    G(SHORE_POWER, shorePower) \
+    G(DERIVED, derived)
+
+/**
+ * @brief Value fields: F(ID, GROUP, group, member, TYPE, unit, min, max, decimals, deadband)
+ *
+ * TYPE is a BoatDataFieldType suffix. min/max are the absolute range
+ * (same units as the field; angles as exact multiples of M_PI, so the
+ * wrap spans of FieldRange.h are whole turns); decimals is the JSON output precision.
+ * deadband is the smallest change /boatdata?mode=delta and Signal K send
+ * (field units; 0 = any change): BOATDATA_DELTA_DEADBAND_* for angles,
+ * speeds and positions, otherwise one unit of the last decimal.
+ */
+#define BOATDATA_SCHEMA_FIELDS(F) \
+    F(GPS_LATITUDE, GPS, gps, latitude, DOUBLE, "deg", -90.0, 90.0, 6, BOATDATA_DELTA_DEADBAND_POSITION) \
+    F(GPS_LONGITUDE, GPS, gps, longitude, DOUBLE, "deg", -180.0, 180.0, 6, BOATDATA_DELTA_DEADBAND_POSITION) \
+    F(GPS_COG, GPS, gps, cog, SCALAR, "rad", 0.0, (2 * M_PI), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(GPS_SOG, GPS, gps, sog, SCALAR, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(GPS_VARIATION, GPS, gps, variation, SCALAR, "rad", (-M_PI / 6), (M_PI / 6), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(GPS_FIX_QUALITY, GPS, gps, fixQuality, U8, "", 0.0, 8.0, 0, 0.0) \
+    F(GPS_SATELLITES, GPS, gps, satellites, U8, "", 0.0, 255.0, 0, 0.0) \
+    F(GPS_HDOP, GPS, gps, hdop, SCALAR, "", 0.0, 100.0, 1, 0.1) \
+    F(COMPASS_TRUE_HEADING, COMPASS, compass, trueHeading, SCALAR, "rad", 0.0, (2 * M_PI), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(COMPASS_MAGNETIC_HEADING, COMPASS, compass, magneticHeading, SCALAR, "rad", 0.0, (2 * M_PI), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(COMPASS_RATE_OF_TURN, COMPASS, compass, rateOfTurn, SCALAR, "rad/s", (-M_PI), M_PI, 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(COMPASS_HEEL_ANGLE, COMPASS, compass, heelAngle, SCALAR, "rad", (-M_PI / 2), (M_PI / 2), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(COMPASS_PITCH_ANGLE, COMPASS, compass, pitchAngle, SCALAR, "rad", (-M_PI / 6), (M_PI / 6), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(COMPASS_HEAVE, COMPASS, compass, heave, SCALAR, "m", -5.0, 5.0, 2, 0.01) \
+    F(WIND_AWA, WIND, wind, apparentWindAngle, SCALAR, "rad", (-M_PI), M_PI, 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(WIND_AWS, WIND, wind, apparentWindSpeed, SCALAR, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DST_DEPTH, DST, dst, depth, SCALAR, "m", 0.0, 100.0, 2, 0.01) \
+    F(DST_BOAT_SPEED, DST, dst, measuredBoatSpeed, SCALAR, "m/s", 0.0, 25.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DST_SEA_TEMPERATURE, DST, dst, seaTemperature, SCALAR, "C", -10.0, 50.0, 1, 0.1) \
+    F(RUDDER_ANGLE, RUDDER, rudder, steeringAngle, SCALAR, "rad", (-M_PI / 2), (M_PI / 2), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(ENGINE_REV, ENGINE, engine, engineRev, SCALAR, "rpm", 0.0, 6000.0, 0, 1.0) \
+    F(ENGINE_OIL_TEMPERATURE, ENGINE, engine, oilTemperature, SCALAR, "C", -10.0, 150.0, 1, 0.1) \
+    F(ENGINE_ALTERNATOR_VOLTAGE, ENGINE, engine, alternatorVoltage, SCALAR, "V", 0.0, 30.0, 2, 0.01) \
+    F(SAILDRIVE_ENGAGED, SAILDRIVE, saildrive, saildriveEngaged, BOOL, "", 0.0, 1.0, 0, 0.0) \
+    F(BATTERY_VOLTAGE_A, BATTERY, battery, voltageA, SCALAR, "V", 0.0, 30.0, 2, 0.01) \
+    F(BATTERY_AMPERAGE_A, BATTERY, battery, amperageA, SCALAR, "A", -200.0, 200.0, 1, 0.1) \
+    F(BATTERY_SOC_A, BATTERY, battery, stateOfChargeA, SCALAR, "%", 0.0, 100.0, 1, 0.1) \
+    F(BATTERY_SHORE_CHARGER_A, BATTERY, battery, shoreChargerOnA, BOOL, "", 0.0, 1.0, 0, 0.0) \
+    F(BATTERY_ENGINE_CHARGER_A, BATTERY, battery, engineChargerOnA, BOOL, "", 0.0, 1.0, 0, 0.0) \
+    F(BATTERY_VOLTAGE_B, BATTERY, battery, voltageB, SCALAR, "V", 0.0, 30.0, 2, 0.01) \
+    F(BATTERY_AMPERAGE_B, BATTERY, battery, amperageB, SCALAR, "A", -200.0, 200.0, 1, 0.1) \
+    F(BATTERY_SOC_B, BATTERY, battery, stateOfChargeB, SCALAR, "%", 0.0, 100.0, 1, 0.1) \
+    F(BATTERY_SHORE_CHARGER_B, BATTERY, battery, shoreChargerOnB, BOOL, "", 0.0, 1.0, 0, 0.0) \
+    F(BATTERY_ENGINE_CHARGER_B, BATTERY, battery, engineChargerOnB, BOOL, "", 0.0, 1.0, 0, 0.0) \
+    F(SHORE_POWER_ON, SHORE_POWER, shorePower, shorePowerOn, BOOL, "", 0.0, 1.0, 0, 0.0) \
+    F(SHORE_POWER_WATTS, SHORE_POWER, shorePower, power, SCALAR, "W", 0.0, 5000.0, 0, 1.0) \
+    F(DERIVED_AWA_OFFSET, DERIVED, derived, awaOffset, SCALAR, "rad", (-M_PI), M_PI, 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(DERIVED_AWA_HEEL, DERIVED, derived, awaHeel, SCALAR, "rad", (-M_PI), M_PI, 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(DERIVED_LEEWAY, DERIVED, derived, leeway, SCALAR, "rad", (-M_PI / 4), (M_PI / 4), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(DERIVED_STW, DERIVED, derived, stw, SCALAR, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_TWS, DERIVED, derived, tws, SCALAR, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_TWA, DERIVED, derived, twa, SCALAR, "rad", (-M_PI), M_PI, 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(DERIVED_WDIR, DERIVED, derived, wdir, SCALAR, "rad", 0.0, (2 * M_PI), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(DERIVED_VMG, DERIVED, derived, vmg, SCALAR, "kn", -100.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_SOC, DERIVED, derived, soc, SCALAR, "kn", 0.0, 20.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_DOC, DERIVED, derived, doc, SCALAR, "rad", 0.0, (2 * M_PI), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(DERIVED_POLAR_SPEED, DERIVED, derived, polarSpeed, SCALAR, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_POLAR_PERFORMANCE, DERIVED, derived, polarPerformance, SCALAR, "%", 0.0, 1000.0, 1, 0.1) \
+    F(DERIVED_TARGET_TWA, DERIVED, derived, targetTwa, SCALAR, "rad", (-M_PI), M_PI, 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(DERIVED_TARGET_VMG, DERIVED, derived, targetVmg, SCALAR, "kn", -100.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_TWS_AVG_10S, DERIVED, derived, twsAvg10s, FLOAT, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_TWS_AVG_1M, DERIVED, derived, twsAvg1m, FLOAT, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_TWS_AVG_10M, DERIVED, derived, twsAvg10m, FLOAT, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_WDIR_AVG_10S, DERIVED, derived, wdirAvg10s, FLOAT, "rad", 0.0, (2 * M_PI), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(DERIVED_WDIR_AVG_1M, DERIVED, derived, wdirAvg1m, FLOAT, "rad", 0.0, (2 * M_PI), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(DERIVED_WDIR_AVG_10M, DERIVED, derived, wdirAvg10m, FLOAT, "rad", 0.0, (2 * M_PI), 4, BOATDATA_DELTA_DEADBAND_ANGLE) \
+    F(DERIVED_VMG_AVG_10S, DERIVED, derived, vmgAvg10s, FLOAT, "kn", -100.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_VMG_AVG_1M, DERIVED, derived, vmgAvg1m, FLOAT, "kn", -100.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_VMG_AVG_10M, DERIVED, derived, vmgAvg10m, FLOAT, "kn", -100.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_GUST_10S, DERIVED, derived, gust10s, FLOAT, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_GUST_1M, DERIVED, derived, gust1m, FLOAT, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED) \
+    F(DERIVED_GUST_10M, DERIVED, derived, gust10m, FLOAT, "kn", 0.0, 100.0, 2, BOATDATA_DELTA_DEADBAND_SPEED)
+
+/**
+ * @brief Field identifiers (BOATDATA_FIELD_<ID>), in table order
+ */
+enum BoatDataFieldId : uint8_t {
+#define BOATDATA_SCHEMA_FIELD_ID(ID, GROUP, group, member, TYPE, unit, min, max, decimals, deadband) \
+    BOATDATA_FIELD_##ID,
+    BOATDATA_SCHEMA_FIELDS(BOATDATA_SCHEMA_FIELD_ID)
+#undef BOATDATA_SCHEMA_FIELD_ID
+    BOATDATA_FIELD_COUNT
+};
+
+/**
+ * @brief Published group indices (BOATDATA_SCHEMA_GROUP_<ID>), in JSON order
+ */
+enum BoatDataSchemaGroupId : uint8_t {
+#define BOATDATA_SCHEMA_GROUP_ID(ID, member) BOATDATA_SCHEMA_GROUP_##ID,
+    BOATDATA_SCHEMA_GROUPS(BOATDATA_SCHEMA_GROUP_ID)
+#undef BOATDATA_SCHEMA_GROUP_ID
+    BOATDATA_SCHEMA_GROUP_COUNT
+};
+
+/**
+ * @brief Storage type of a field
+ */
+enum BoatDataFieldType : uint8_t {
+    BOATDATA_TYPE_SCALAR,   ///< BoatScalar (double or float, see BoatScalar.h)
+    BOATDATA_TYPE_DOUBLE,   ///< double (GPS position)
+    BOATDATA_TYPE_FLOAT,    ///< float in every build (display-only statistics)
+    BOATDATA_TYPE_U8,       ///< uint8_t
+    BOATDATA_TYPE_BOOL      ///< bool
+};
+
+/**
+ * @brief Descriptor of one value field
+ */
+struct BoatDataFieldInfo {
+    const char* key;        ///< JSON key (member name)
+    const char* unit;       ///< "" for counts, flags and ratios
+    uint16_t offset;        ///< offsetof(BoatDataStructure, <group>.<member>)
+    uint8_t group;          ///< BoatDataSchemaGroupId
+    uint8_t type;           ///< BoatDataFieldType
+    float min;              ///< Absolute range
+    float max;
+    uint8_t decimals;       ///< JSON output precision
+    double deadband;        ///< Smallest change a delta sends (0 = any change)
+};
+
+/**
+ * @brief Descriptor of one published group
+ */
+struct BoatDataGroupInfo {
+    const char* key;            ///< JSON object key (member name)
+    uint16_t mask;              ///< BoatDataGroup bit
+    uint16_t offset;            ///< offsetof(BoatDataStructure, <group>)
+    uint16_t size;              ///< sizeof the group struct
+    uint16_t availableOffset;   ///< offsetof(BoatDataStructure, <group>.available)
+    uint16_t lastUpdateOffset;  ///< offsetof(BoatDataStructure, <group>.lastUpdate)
+    uint16_t lockOffset;        ///< offsetof(BoatDataStructure, versions.<group>)
+    uint8_t firstField;         ///< BoatDataFieldId of the group's first field
+    uint8_t fieldCount;
+};
+
+namespace BoatDataSchema {
+
+/// Integer digits of @p value (>= 0)
+constexpr size_t jsonIntegerDigits(double value) {
+    return value < 10.0 ? 1 : 1 + jsonIntegerDigits(value / 10.0);
+}
+
+/// Longest text of a field value within its absolute range
+constexpr size_t jsonValueMaxBytes(uint8_t type, double min, double max, uint8_t decimals) {
+    return type == BOATDATA_TYPE_BOOL ? sizeof("false") - 1
+         : (min < 0.0 ? 1 : 0) + jsonIntegerDigits(-min > max ? -min : max) + (decimals > 0 ? 1 + decimals : 0);
+}
+
+/**
+ * @brief Longest writeJson() output of all groups, computed from the schema
+ *
+ * Every group available with every field at the longest value of its range:
+ * "key":value, per field plus "member":{...,"available":false,"lastUpdate":4294967295},
+ * per group (32-bit millis()). Out-of-range values are rejected by the
+ * handlers; the writers still report overflow if one gets through.
+ */
+constexpr size_t JSON_MAX_BYTES = 0
+#define BOATDATA_SCHEMA_FIELD_JSON(ID, GROUP, group, member, TYPE, unit, min, max, decimals, deadband) \
+    + (sizeof(#member) - 1 + 3) + jsonValueMaxBytes(BOATDATA_TYPE_##TYPE, min, max, decimals) + 1
+    BOATDATA_SCHEMA_FIELDS(BOATDATA_SCHEMA_FIELD_JSON)
+#undef BOATDATA_SCHEMA_FIELD_JSON
+#define BOATDATA_SCHEMA_GROUP_JSON(ID, member) \
+    + (sizeof(#member) - 1 + 4) + (sizeof("\"available\":false,\"lastUpdate\":4294967295},") - 1)
+    BOATDATA_SCHEMA_GROUPS(BOATDATA_SCHEMA_GROUP_JSON)
+#undef BOATDATA_SCHEMA_GROUP_JSON
+    ;
+
+/**
+ * @brief Longest writeInstances() output: every engine and tank slot at the longest value of its range
+ *
+ * Engine values use the ranges and decimals of the ENGINE fields.
+ */
+constexpr size_t INSTANCE_JSON_MAX_BYTES =
+    sizeof("\"engines\":[],\"tanks\":[],") - 1
+    + BOATDATA_ENGINE_INSTANCES * (sizeof("{\"instance\":255,\"engineRev\":6000,\"oilTemperature\":-10.0,"
+                                          "\"alternatorVoltage\":30.00,\"available\":false,\"lastUpdate\":4294967295},") - 1)
+    + BOATDATA_TANK_INSTANCES * (sizeof("{\"fluidType\":255,\"instance\":255,\"level\":100.0,\"capacity\":10000.0,"
+                                        "\"available\":false,\"lastUpdate\":4294967295},") - 1);
+
+/// Descriptor of @p id (< BOATDATA_FIELD_COUNT)
+const BoatDataFieldInfo& fieldInfo(uint8_t id);
+
+/// Descriptor of @p group (< BOATDATA_SCHEMA_GROUP_COUNT)
+const BoatDataGroupInfo& groupInfo(uint8_t group);
+
+/**
+ * @brief Field by group and member name ("dst", "depth")
+ *
+ * @return BoatDataFieldId, or BOATDATA_FIELD_COUNT if there is none
+ */
+uint8_t findField(const char* group, const char* key);
+
+/// Group by JSON key ("wind"); BOATDATA_SCHEMA_GROUP_COUNT if there is none
+uint8_t findGroup(const char* key);
+
+/// Value of @p id as double (bool = 0/1)
+double getValue(const BoatDataStructure& data, uint8_t id);
+
+/**
+ * @brief Value of @p id as one consistent read under the group's seqlock (any task)
+ *
+ * @return false if every attempt overlapped a write (@p value possibly torn)
+ */
+bool readValue(const BoatDataStructure& data, uint8_t id, double& value);
+
+/// Store @p value into @p id (converted to the field type; no range check, no locking)
+void setValue(BoatDataStructure& data, uint8_t id, double value);
+
+/**
+ * @brief Store @p value into @p id of a standalone group struct (a patch: GPSData, BatteryData, ...)
+ *
+ * @p group must be the struct of the field's group; no range check, no locking.
+ */
+void setMember(void* group, uint8_t id, double value);
+
+/// Mark @p group available and set its lastUpdate to @p nowMs
+void stamp(BoatDataStructure& data, uint8_t group, unsigned long nowMs);
+
+/// @p value within the absolute range of @p id (NaN = false)
+bool inRange(uint8_t id, double value);
+
+/// @p value limited to the absolute range of @p id
+double clamp(uint8_t id, double value);
+
+/// Group's available flag
+bool isAvailable(const BoatDataStructure& data, uint8_t group);
+
+/// Set the group's available flag (lastUpdate unchanged; no locking)
+void setAvailable(BoatDataStructure& data, uint8_t group, bool available);
+
+/// Group's lastUpdate millis() timestamp
+unsigned long lastUpdate(const BoatDataStructure& data, uint8_t group);
+
+/// Seqlock guarding @p group
+const SeqLock& lock(const BoatDataStructure& data, uint8_t group);
+SeqLock& lock(BoatDataStructure& data, uint8_t group);
+
+/**
+ * @brief Copy @p group from @p shared into the same group of @p out under its seqlock
+ *
+ * @return false if every attempt overlapped a write (copy possibly torn)
+ */
+bool readGroup(const BoatDataStructure& shared, uint8_t group, BoatDataStructure& out);
+
+/// Write @p id as a keyed member of the open object ("depth": 3.42), at the field's decimals
+void writeField(JsonWriter& out, const BoatDataStructure& data, uint8_t id);
+
+/**
+ * @brief Write every published group as a keyed object member of the open object
+ *
+ * "gps": {"latitude": ..., ..., "available": true, "lastUpdate": 1234}, "compass": {...}, ...
+ * Numbers use each field's decimals; NaN/Inf become null. @p groups
+ * (BoatDataGroup mask) limits the output to a /boatdata subscription.
+ */
+void writeJson(JsonWriter& out, const BoatDataStructure& data, uint16_t groups = BoatDataGroup::ALL);
+
+/// Every engine slot written so far and every assigned tank slot
+BoatDataInstanceMask assignedInstances(const BoatDataInstances& instances);
+
+/**
+ * @brief Write the engine and tank slots in @p slots as keyed arrays of the open object
+ *
+ * "engines": [{"instance": 1, "engineRev": 1850, ..., "available": true, "lastUpdate": 1234}],
+ * "tanks": [{"fluidType": 0, "instance": 0, "level": 62.5, "capacity": 120.0, ...}]
+ * Only slots in @p slots that are assigned are written; an array with none is omitted.
+ * Engine values use the decimals of the ENGINE fields, level and capacity one decimal.
+ */
+void writeInstances(JsonWriter& out, const BoatDataInstances& instances, BoatDataInstanceMask slots);
+
+}  // namespace BoatDataSchema
+
+#endif // BOATDATA_SCHEMA_H
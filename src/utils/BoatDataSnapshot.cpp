@@ -0,0 +1,255 @@
+/**
+ * @file BoatDataSnapshot.cpp
+ * @brief Fixed-point encoding of the BoatData wire record
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BoatDataSnapshot.h"
+#include <math.h>
+
+static_assert(sizeof(BoatDataSnapshot) == 122, "BoatDataSnapshot: layout changed, bump BOATDATA_SNAPSHOT_VERSION");
+
+namespace {
+
+const double ANGLE_SCALE = 1e4;     // 1e-4 rad
+const double COORD_SCALE = 1e7;     // 1e-7 deg
+
+/**
+ * @brief value * scale rounded and limited to [lo, hi] (NaN = 0)
+ */
+inline long toFixed(double value, double scale, long lo, long hi) {
+    double scaled = value * scale;
+    if (!(scaled == scaled)) {
+        return 0;
+    }
+    if (scaled <= static_cast<double>(lo)) {
+        return lo;
+    }
+    if (scaled >= static_cast<double>(hi)) {
+        return hi;
+    }
+    return lround(scaled);
+}
+
+inline int16_t toI16(double value, double scale) {
+    return static_cast<int16_t>(toFixed(value, scale, INT16_MIN, INT16_MAX));
+}
+
+inline uint16_t toU16(double value, double scale) {
+    return static_cast<uint16_t>(toFixed(value, scale, 0, UINT16_MAX));
+}
+
+inline int32_t toI32(double value, double scale) {
+    return static_cast<int32_t>(toFixed(value, scale, -2147483647L, 2147483647L));
+}
+
+inline uint8_t flag(bool set, uint8_t bit) {
+    return set ? bit : 0;
+}
+
+}  // namespace
+
+void BoatDataSnapshot::fill(const BoatDataStructure& data, uint32_t nowMs) {
+    version = BOATDATA_SNAPSHOT_VERSION;
+    timestampMs = nowMs;
+    present = 0;
+    flags = 0;
+
+    const GPSData& gps = data.gps;
+    if (gps.available) present |= BoatDataGroup::GPS;
+    latitude = toI32(gps.latitude, COORD_SCALE);
+    longitude = toI32(gps.longitude, COORD_SCALE);
+    cog = toU16(gps.cog, ANGLE_SCALE);
+    sog = toU16(gps.sog, 100.0);
+    variation = toI16(gps.variation, ANGLE_SCALE);
+    fixQuality = gps.fixQuality;
+    satellites = gps.satellites;
+    hdop = toU16(gps.hdop, 100.0);
+
+    const CompassData& compass = data.compass;
+    if (compass.available) present |= BoatDataGroup::COMPASS;
+    trueHeading = toU16(compass.trueHeading, ANGLE_SCALE);
+    magneticHeading = toU16(compass.magneticHeading, ANGLE_SCALE);
+    rateOfTurn = toI16(compass.rateOfTurn, ANGLE_SCALE);
+    heelAngle = toI16(compass.heelAngle, ANGLE_SCALE);
+    pitchAngle = toI16(compass.pitchAngle, ANGLE_SCALE);
+    heave = toI16(compass.heave, 1000.0);
+
+    const WindData& wind = data.wind;
+    if (wind.available) present |= BoatDataGroup::WIND;
+    apparentWindAngle = toI16(wind.apparentWindAngle, ANGLE_SCALE);
+    apparentWindSpeed = toU16(wind.apparentWindSpeed, 100.0);
+
+    const DSTData& dst = data.dst;
+    if (dst.available) present |= BoatDataGroup::DST;
+    depth = toU16(dst.depth, 100.0);
+    measuredBoatSpeed = toU16(dst.measuredBoatSpeed, 100.0);
+    seaTemperature = toI16(dst.seaTemperature, 100.0);
+
+    if (data.rudder.available) present |= BoatDataGroup::RUDDER;
+    steeringAngle = toI16(data.rudder.steeringAngle, ANGLE_SCALE);
+
+    const EngineData& engine = data.engine;
+    if (engine.available) present |= BoatDataGroup::ENGINE;
+    engineRev = toU16(engine.engineRev, 1.0);
+    oilTemperature = toI16(engine.oilTemperature, 10.0);
+    alternatorVoltage = toU16(engine.alternatorVoltage, 100.0);
+
+    if (data.saildrive.available) present |= BoatDataGroup::SAILDRIVE;
+    flags |= flag(data.saildrive.saildriveEngaged, BoatDataSnapshotFlag::SAILDRIVE_ENGAGED);
+
+    const BatteryData& battery = data.battery;
+    if (battery.available) present |= BoatDataGroup::BATTERY;
+    voltageA = toU16(battery.voltageA, 100.0);
+    amperageA = toI16(battery.amperageA, 10.0);
+    stateOfChargeA = toU16(battery.stateOfChargeA, 10.0);
+    voltageB = toU16(battery.voltageB, 100.0);
+    amperageB = toI16(battery.amperageB, 10.0);
+    stateOfChargeB = toU16(battery.stateOfChargeB, 10.0);
+    flags |= flag(battery.shoreChargerOnA, BoatDataSnapshotFlag::SHORE_CHARGER_A) |
+             flag(battery.engineChargerOnA, BoatDataSnapshotFlag::ENGINE_CHARGER_A) |
+             flag(battery.shoreChargerOnB, BoatDataSnapshotFlag::SHORE_CHARGER_B) |
+             flag(battery.engineChargerOnB, BoatDataSnapshotFlag::ENGINE_CHARGER_B);
+
+    if (data.shorePower.available) present |= BoatDataGroup::SHORE_POWER;
+    shorePower = toU16(data.shorePower.power, 1.0);
+    flags |= flag(data.shorePower.shorePowerOn, BoatDataSnapshotFlag::SHORE_POWER_ON);
+
+    const DerivedData& derived = data.derived;
+    if (derived.available) present |= BoatDataGroup::DERIVED;
+    awaOffset = toI16(derived.awaOffset, ANGLE_SCALE);
+    awaHeel = toI16(derived.awaHeel, ANGLE_SCALE);
+    leeway = toI16(derived.leeway, ANGLE_SCALE);
+    stw = toU16(derived.stw, 100.0);
+    tws = toU16(derived.tws, 100.0);
+    twa = toI16(derived.twa, ANGLE_SCALE);
+    wdir = toU16(derived.wdir, ANGLE_SCALE);
+    vmg = toI16(derived.vmg, 100.0);
+    soc = toU16(derived.soc, 100.0);
+    doc = toU16(derived.doc, ANGLE_SCALE);
+    polarSpeed = toU16(derived.polarSpeed, 100.0);
+    polarPerformance = toU16(derived.polarPerformance, 10.0);
+    targetTwa = toI16(derived.targetTwa, ANGLE_SCALE);
+    targetVmg = toI16(derived.targetVmg, 100.0);
+    twsAvg10s = toU16(derived.twsAvg10s, 100.0);
+    twsAvg1m = toU16(derived.twsAvg1m, 100.0);
+    twsAvg10m = toU16(derived.twsAvg10m, 100.0);
+    wdirAvg10s = toU16(derived.wdirAvg10s, ANGLE_SCALE);
+    wdirAvg1m = toU16(derived.wdirAvg1m, ANGLE_SCALE);
+    wdirAvg10m = toU16(derived.wdirAvg10m, ANGLE_SCALE);
+    vmgAvg10s = toI16(derived.vmgAvg10s, 100.0);
+    vmgAvg1m = toI16(derived.vmgAvg1m, 100.0);
+    vmgAvg10m = toI16(derived.vmgAvg10m, 100.0);
+    gust10s = toU16(derived.gust10s, 100.0);
+    gust1m = toU16(derived.gust1m, 100.0);
+    gust10m = toU16(derived.gust10m, 100.0);
+}
+
+bool BoatDataSnapshot::unpack(BoatDataStructure& out) const {
+    if (version != BOATDATA_SNAPSHOT_VERSION) {
+        return false;
+    }
+
+    GPSData& gps = out.gps;
+    gps.latitude = latitude / COORD_SCALE;
+    gps.longitude = longitude / COORD_SCALE;
+    gps.cog = static_cast<BoatScalar>(cog / ANGLE_SCALE);
+    gps.sog = static_cast<BoatScalar>(sog / 100.0);
+    gps.variation = static_cast<BoatScalar>(variation / ANGLE_SCALE);
+    gps.fixQuality = fixQuality;
+    gps.satellites = satellites;
+    gps.hdop = static_cast<BoatScalar>(hdop / 100.0);
+    gps.available = (present & BoatDataGroup::GPS) != 0;
+    gps.lastUpdate = timestampMs;
+
+    CompassData& compass = out.compass;
+    compass.trueHeading = static_cast<BoatScalar>(trueHeading / ANGLE_SCALE);
+    compass.magneticHeading = static_cast<BoatScalar>(magneticHeading / ANGLE_SCALE);
+    compass.rateOfTurn = static_cast<BoatScalar>(rateOfTurn / ANGLE_SCALE);
+    compass.heelAngle = static_cast<BoatScalar>(heelAngle / ANGLE_SCALE);
+    compass.pitchAngle = static_cast<BoatScalar>(pitchAngle / ANGLE_SCALE);
+    compass.heave = static_cast<BoatScalar>(heave / 1000.0);
+    compass.available = (present & BoatDataGroup::COMPASS) != 0;
+    compass.lastUpdate = timestampMs;
+
+    WindData& wind = out.wind;
+    wind.apparentWindAngle = static_cast<BoatScalar>(apparentWindAngle / ANGLE_SCALE);
+    wind.apparentWindSpeed = static_cast<BoatScalar>(apparentWindSpeed / 100.0);
+    wind.available = (present & BoatDataGroup::WIND) != 0;
+    wind.lastUpdate = timestampMs;
+
+    DSTData& dst = out.dst;
+    dst.depth = static_cast<BoatScalar>(depth / 100.0);
+    dst.measuredBoatSpeed = static_cast<BoatScalar>(measuredBoatSpeed / 100.0);
+    dst.seaTemperature = static_cast<BoatScalar>(seaTemperature / 100.0);
+    dst.available = (present & BoatDataGroup::DST) != 0;
+    dst.lastUpdate = timestampMs;
+
+    out.rudder.steeringAngle = static_cast<BoatScalar>(steeringAngle / ANGLE_SCALE);
+    out.rudder.available = (present & BoatDataGroup::RUDDER) != 0;
+    out.rudder.lastUpdate = timestampMs;
+
+    EngineData& engine = out.engine;
+    engine.engineRev = static_cast<BoatScalar>(engineRev);
+    engine.oilTemperature = static_cast<BoatScalar>(oilTemperature / 10.0);
+    engine.alternatorVoltage = static_cast<BoatScalar>(alternatorVoltage / 100.0);
+    engine.available = (present & BoatDataGroup::ENGINE) != 0;
+    engine.lastUpdate = timestampMs;
+
+    out.saildrive.saildriveEngaged = (flags & BoatDataSnapshotFlag::SAILDRIVE_ENGAGED) != 0;
+    out.saildrive.available = (present & BoatDataGroup::SAILDRIVE) != 0;
+    out.saildrive.lastUpdate = timestampMs;
+
+    BatteryData& battery = out.battery;
+    battery.voltageA = static_cast<BoatScalar>(voltageA / 100.0);
+    battery.amperageA = static_cast<BoatScalar>(amperageA / 10.0);
+    battery.stateOfChargeA = static_cast<BoatScalar>(stateOfChargeA / 10.0);
+    battery.shoreChargerOnA = (flags & BoatDataSnapshotFlag::SHORE_CHARGER_A) != 0;
+    battery.engineChargerOnA = (flags & BoatDataSnapshotFlag::ENGINE_CHARGER_A) != 0;
+    battery.voltageB = static_cast<BoatScalar>(voltageB / 100.0);
+    battery.amperageB = static_cast<BoatScalar>(amperageB / 10.0);
+    battery.stateOfChargeB = static_cast<BoatScalar>(stateOfChargeB / 10.0);
+    battery.shoreChargerOnB = (flags & BoatDataSnapshotFlag::SHORE_CHARGER_B) != 0;
+    battery.engineChargerOnB = (flags & BoatDataSnapshotFlag::ENGINE_CHARGER_B) != 0;
+    battery.available = (present & BoatDataGroup::BATTERY) != 0;
+    battery.lastUpdate = timestampMs;
+
+    out.shorePower.power = static_cast<BoatScalar>(shorePower);
+    out.shorePower.shorePowerOn = (flags & BoatDataSnapshotFlag::SHORE_POWER_ON) != 0;
+    out.shorePower.available = (present & BoatDataGroup::SHORE_POWER) != 0;
+    out.shorePower.lastUpdate = timestampMs;
+
+    DerivedData& derived = out.derived;
+    derived.awaOffset = static_cast<BoatScalar>(awaOffset / ANGLE_SCALE);
+    derived.awaHeel = static_cast<BoatScalar>(awaHeel / ANGLE_SCALE);
+    derived.leeway = static_cast<BoatScalar>(leeway / ANGLE_SCALE);
+    derived.stw = static_cast<BoatScalar>(stw / 100.0);
+    derived.tws = static_cast<BoatScalar>(tws / 100.0);
+    derived.twa = static_cast<BoatScalar>(twa / ANGLE_SCALE);
+    derived.wdir = static_cast<BoatScalar>(wdir / ANGLE_SCALE);
+    derived.vmg = static_cast<BoatScalar>(vmg / 100.0);
+    derived.soc = static_cast<BoatScalar>(soc / 100.0);
+    derived.doc = static_cast<BoatScalar>(doc / ANGLE_SCALE);
+    derived.polarSpeed = static_cast<BoatScalar>(polarSpeed / 100.0);
+    derived.polarPerformance = static_cast<BoatScalar>(polarPerformance / 10.0);
+    derived.targetTwa = static_cast<BoatScalar>(targetTwa / ANGLE_SCALE);
+    derived.targetVmg = static_cast<BoatScalar>(targetVmg / 100.0);
+    derived.twsAvg10s = static_cast<float>(twsAvg10s / 100.0);
+    derived.twsAvg1m = static_cast<float>(twsAvg1m / 100.0);
+    derived.twsAvg10m = static_cast<float>(twsAvg10m / 100.0);
+    derived.wdirAvg10s = static_cast<float>(wdirAvg10s / ANGLE_SCALE);
+    derived.wdirAvg1m = static_cast<float>(wdirAvg1m / ANGLE_SCALE);
+    derived.wdirAvg10m = static_cast<float>(wdirAvg10m / ANGLE_SCALE);
+    derived.vmgAvg10s = static_cast<float>(vmgAvg10s / 100.0);
+    derived.vmgAvg1m = static_cast<float>(vmgAvg1m / 100.0);
+    derived.vmgAvg10m = static_cast<float>(vmgAvg10m / 100.0);
+    derived.gust10s = static_cast<float>(gust10s / 100.0);
+    derived.gust1m = static_cast<float>(gust1m / 100.0);
+    derived.gust10m = static_cast<float>(gust10m / 100.0);
+    derived.available = (present & BoatDataGroup::DERIVED) != 0;
+    derived.lastUpdate = timestampMs;
+
+    return true;
+}
@@ -0,0 +1,174 @@
+/**
+ * @file BoatDataSnapshot.h
+ * @brief Compact, versioned wire format of the BoatData groups
+ *
+ * One packed 122-byte record with every published value as a fixed-point
+ * integer, for binary streaming (WebSocket, UDP) and LittleFS logging. The
+ * in-memory BoatDataStructure is ~768 bytes and its JSON ~2 KB.
+ *
+ * Layout rules:
+ * - Little-endian, no padding (ESP32 native order, sent as-is)
+ * - Units as in BoatData (radians, knots, m/s, metres), scaled so one
+ *   count is 1e-4 rad, 0.01 kn, 0.01 m/s, 1 cm, 0.01 V, 0.1 A ...
+ *   (see the member comments); values outside a field's range saturate
+ * - present: BoatDataGroup bits of the groups that were available; fields
+ *   of absent groups are zero
+ * - version changes whenever the layout does; readers reject other versions
+ *
+ * fill() walks the structure once, with no heap use. The caller passes a
+ * consistent structure (BoatData::getSnapshot() off the main loop, or
+ * getDataStructure() on it).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed 122-byte POD, zero heap allocation
+ * - Principle VII (Fail-Safe): out-of-range and NaN values saturate/zero instead of wrapping
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOAT_DATA_SNAPSHOT_H
+#define BOAT_DATA_SNAPSHOT_H
+
+#include <stdint.h>
+#include "../types/BoatDataTypes.h"
+#include "BoatDataChangeTracker.h"
+
+#define BOATDATA_SNAPSHOT_VERSION 3
+
+/**
+ * @brief Bits of BoatDataSnapshot::flags (boolean fields)
+ */
+namespace BoatDataSnapshotFlag {
+    static const uint8_t SAILDRIVE_ENGAGED = 1 << 0;
+    static const uint8_t SHORE_CHARGER_A = 1 << 1;
+    static const uint8_t ENGINE_CHARGER_A = 1 << 2;
+    static const uint8_t SHORE_CHARGER_B = 1 << 3;
+    static const uint8_t ENGINE_CHARGER_B = 1 << 4;
+    static const uint8_t SHORE_POWER_ON = 1 << 5;
+}
+
+/**
+ * @struct BoatDataSnapshot
+ * @brief Wire record (BOATDATA_SNAPSHOT_VERSION 3, 122 bytes)
+ */
+struct __attribute__((packed)) BoatDataSnapshot {
+    // Header
+    uint8_t version;            ///< BOATDATA_SNAPSHOT_VERSION
+    uint8_t flags;              ///< BoatDataSnapshotFlag bits
+    uint16_t present;           ///< BoatDataGroup bits of the available groups
+    uint32_t timestampMs;       ///< millis() when filled
+
+    // GPS
+    int32_t latitude;           ///< 1e-7 deg
+    int32_t longitude;          ///< 1e-7 deg
+    uint16_t cog;               ///< 1e-4 rad
+    uint16_t sog;               ///< 0.01 kn
+    int16_t variation;          ///< 1e-4 rad
+    uint8_t fixQuality;
+    uint8_t satellites;
+    uint16_t hdop;              ///< 0.01
+
+    // Compass
+    uint16_t trueHeading;       ///< 1e-4 rad
+    uint16_t magneticHeading;   ///< 1e-4 rad
+    int16_t rateOfTurn;         ///< 1e-4 rad/s
+    int16_t heelAngle;          ///< 1e-4 rad
+    int16_t pitchAngle;         ///< 1e-4 rad
+    int16_t heave;              ///< 1 mm
+
+    // Wind
+    int16_t apparentWindAngle;  ///< 1e-4 rad
+    uint16_t apparentWindSpeed; ///< 0.01 kn
+
+    // DST
+    uint16_t depth;             ///< 1 cm
+    uint16_t measuredBoatSpeed; ///< 0.01 m/s
+    int16_t seaTemperature;     ///< 0.01 C
+
+    // Rudder
+    int16_t steeringAngle;      ///< 1e-4 rad
+
+    // Engine
+    uint16_t engineRev;         ///< 1 rpm
+    int16_t oilTemperature;     ///< 0.1 C
+    uint16_t alternatorVoltage; ///< 0.01 V
+
+    // Battery
+    uint16_t voltageA;          ///< 0.01 V
+    int16_t amperageA;          ///< 0.1 A
+    uint16_t stateOfChargeA;    ///< 0.1 %
+    uint16_t voltageB;          ///< 0.01 V
+    int16_t amperageB;          ///< 0.1 A
+    uint16_t stateOfChargeB;    ///< 0.1 %
+
+    // Shore power
+    uint16_t shorePower;        ///< 1 W
+
+    // Derived
+    int16_t awaOffset;          ///< 1e-4 rad
+    int16_t awaHeel;            ///< 1e-4 rad
+    int16_t leeway;             ///< 1e-4 rad
+    uint16_t stw;               ///< 0.01 kn
+    uint16_t tws;               ///< 0.01 kn
+    int16_t twa;                ///< 1e-4 rad
+    uint16_t wdir;              ///< 1e-4 rad
+    int16_t vmg;                ///< 0.01 kn
+    uint16_t soc;               ///< 0.01 kn (speed of current)
+    uint16_t doc;               ///< 1e-4 rad (direction of current)
+    uint16_t polarSpeed;        ///< 0.01 kn (0 = no polar)
+    uint16_t polarPerformance;  ///< 0.1 %
+    int16_t targetTwa;          ///< 1e-4 rad
+    int16_t targetVmg;          ///< 0.01 kn
+    uint16_t twsAvg10s;         ///< 0.01 kn (running statistics)
+    uint16_t twsAvg1m;
+    uint16_t twsAvg10m;
+    uint16_t wdirAvg10s;        ///< 1e-4 rad
+    uint16_t wdirAvg1m;
+    uint16_t wdirAvg10m;
+    int16_t vmgAvg10s;          ///< 0.01 kn
+    int16_t vmgAvg1m;
+    int16_t vmgAvg10m;
+    uint16_t gust10s;           ///< 0.01 kn
+    uint16_t gust1m;
+    uint16_t gust10m;
+
+    /**
+     * @brief Encode @p data (one pass, saturating)
+     *
+     * @param data Consistent BoatData structure
+     * @param nowMs millis() stored as timestampMs
+     */
+    void fill(const BoatDataStructure& data, uint32_t nowMs);
+
+    /**
+     * @brief Decode into the groups of @p out (values, available flags)
+     *
+     * lastUpdate of every group is set to timestampMs; calibration,
+     * diagnostics and versions are left untouched.
+     *
+     * @return false if version is not BOATDATA_SNAPSHOT_VERSION (out untouched)
+     */
+    bool unpack(BoatDataStructure& out) const;
+};
+
+/// First four bytes of a BoatDataDatagram ("P2BD")
+#define BOATDATA_DATAGRAM_MAGIC 0x44423250u
+
+/**
+ * @struct BoatDataDatagram
+ * @brief UDP publisher payload: magic, sequence number, snapshot (130 bytes)
+ *
+ * sequence counts up by one per datagram sent since boot, so a listener
+ * detects lost, duplicated and reordered datagrams (and a reboot, when it
+ * goes back to 0)
+ */
+struct __attribute__((packed)) BoatDataDatagram {
+    uint32_t magic;             ///< BOATDATA_DATAGRAM_MAGIC
+    uint32_t sequence;
+    BoatDataSnapshot snapshot;
+};
+
+static_assert(sizeof(BoatDataDatagram) == 8 + sizeof(BoatDataSnapshot), "BoatDataDatagram must not be padded");
+
+#endif // BOAT_DATA_SNAPSHOT_H
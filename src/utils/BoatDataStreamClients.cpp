@@ -0,0 +1,270 @@
+/**
+ * @file BoatDataStreamClients.cpp
+ * @brief Implementation of the /boatdata client table and scheduler
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BoatDataStreamClients.h"
+#include <math.h>
+
+BoatDataStreamClients::BoatDataStreamClients()
+    : defaultTicks_(BOATDATA_STREAM_DEFAULT_TICKS), floorTicks_(1), deltaJoined_(false), droppedTotal_(0), evicted_(0) {
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        ids_[i] = 0;
+        generation_[i] = 0;
+        sentMs_[i] = 0;
+        groups_[i] = BoatDataGroup::ALL;
+        modes_[i] = BoatDataStreamMode::FULL;
+        ticks_[i] = 0;
+        sent_[i] = 0;
+        dropped_[i] = 0;
+        behindSinceMs_[i] = 0;
+        fresh_[i] = false;
+    }
+}
+
+uint32_t BoatDataStreamClients::id(uint8_t slot) const {
+    return __atomic_load_n(&ids_[slot], __ATOMIC_ACQUIRE);
+}
+
+bool BoatDataStreamClients::add(uint32_t clientId, BoatDataStreamMode mode) {
+    if (clientId == 0) {
+        return false;
+    }
+    remove(clientId);
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (id(i) == 0) {
+            modes_[i] = mode;
+            groups_[i] = BoatDataGroup::ALL;
+            ticks_[i] = 0;
+            sent_[i] = 0;
+            dropped_[i] = 0;
+            behindSinceMs_[i] = 0;
+            fresh_[i] = true;
+            __atomic_store_n(&ids_[i], clientId, __ATOMIC_RELEASE);
+            if (mode == BoatDataStreamMode::DELTA) {
+                __atomic_store_n(&deltaJoined_, true, __ATOMIC_RELEASE);
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BoatDataStreamClients::subscribe(uint32_t clientId, uint16_t groups, uint8_t ticks) {
+    groups &= BoatDataGroup::ALL;
+    if (clientId == 0 || groups == 0) {
+        return false;
+    }
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (id(i) == clientId) {
+            if (modes_[i] == BoatDataStreamMode::DELTA) {
+                return false;  // Shared baseline: every delta client gets the same frames
+            }
+            __atomic_store_n(&groups_[i], groups, __ATOMIC_RELAXED);
+            __atomic_store_n(&ticks_[i], ticks, __ATOMIC_RELAXED);
+            __atomic_store_n(&fresh_[i], true, __ATOMIC_RELEASE);
+            return true;
+        }
+    }
+    return false;
+}
+
+void BoatDataStreamClients::remove(uint32_t clientId) {
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (clientId != 0 && id(i) == clientId) {
+            __atomic_store_n(&ids_[i], 0u, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+BoatDataStreamMode BoatDataStreamClients::modeOf(uint32_t clientId) const {
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (clientId != 0 && id(i) == clientId) {
+            return modes_[i];
+        }
+    }
+    return BoatDataStreamMode::FULL;
+}
+
+uint8_t BoatDataStreamClients::count(BoatDataStreamMode mode) const {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (at(i, mode) != 0) {
+            n++;
+        }
+    }
+    return n;
+}
+
+uint8_t BoatDataStreamClients::count() const {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (id(i) != 0) {
+            n++;
+        }
+    }
+    return n;
+}
+
+uint32_t BoatDataStreamClients::at(uint8_t slot, BoatDataStreamMode mode) const {
+    if (slot >= BOATDATA_STREAM_MAX_CLIENTS) {
+        return 0;
+    }
+    uint32_t clientId = id(slot);
+    return clientId != 0 && modes_[slot] == mode ? clientId : 0;
+}
+
+uint32_t BoatDataStreamClients::at(uint8_t slot) const {
+    return slot < BOATDATA_STREAM_MAX_CLIENTS ? id(slot) : 0;
+}
+
+bool BoatDataStreamClients::takeDeltaJoined() {
+    return __atomic_exchange_n(&deltaJoined_, false, __ATOMIC_ACQ_REL);
+}
+
+void BoatDataStreamClients::setDefaultTicks(uint8_t ticks) {
+    __atomic_store_n(&defaultTicks_, ticks > 0 ? ticks : static_cast<uint8_t>(1), __ATOMIC_RELAXED);
+}
+
+void BoatDataStreamClients::setFloorTicks(uint8_t ticks) {
+    __atomic_store_n(&floorTicks_, ticks > 0 ? ticks : static_cast<uint8_t>(1), __ATOMIC_RELAXED);
+}
+
+uint8_t BoatDataStreamClients::ticksOf(uint8_t slot) const {
+    if (at(slot) == 0) {
+        return 0;
+    }
+    uint8_t ticks = __atomic_load_n(&ticks_[slot], __ATOMIC_RELAXED);
+    if (ticks == 0) {
+        ticks = __atomic_load_n(&defaultTicks_, __ATOMIC_RELAXED);
+    }
+    uint8_t floor = __atomic_load_n(&floorTicks_, __ATOMIC_RELAXED);
+    return ticks > floor ? ticks : floor;
+}
+
+bool BoatDataStreamClients::isDue(uint8_t slot, uint32_t tick, unsigned long nowMs,
+                                  const BoatDataChangeTracker& changes) const {
+    uint8_t ticks = ticksOf(slot);
+    if (ticks == 0 || tick % ticks != 0) {
+        return false;
+    }
+    if (__atomic_load_n(&fresh_[slot], __ATOMIC_ACQUIRE)) {
+        return true;
+    }
+    uint16_t groups = __atomic_load_n(&groups_[slot], __ATOMIC_RELAXED);
+    return (changes.changedSince(generation_[slot]) & groups) != 0 ||
+           static_cast<uint32_t>(nowMs) - sentMs_[slot] >= BOATDATA_BROADCAST_KEEPALIVE_MS;
+}
+
+uint8_t BoatDataStreamClients::buckets(uint32_t tick, unsigned long nowMs, const BoatDataChangeTracker& changes,
+                                       BoatDataStreamBucket* out) const {
+    uint8_t n = 0;
+    uint16_t deltaSlots = 0;
+    bool deltaDue = false;
+
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (id(i) == 0) {
+            continue;
+        }
+        BoatDataStreamMode mode = modes_[i];
+        if (mode == BoatDataStreamMode::DELTA) {
+            deltaSlots = static_cast<uint16_t>(deltaSlots | (1u << i));
+            deltaDue = deltaDue || isDue(i, tick, nowMs, changes);
+            continue;
+        }
+        if (!isDue(i, tick, nowMs, changes)) {
+            continue;
+        }
+
+        // Join the bucket with the same payload, or open one
+        uint16_t groups = __atomic_load_n(&groups_[i], __ATOMIC_RELAXED);
+        uint8_t b = 0;
+        while (b < n && (out[b].mode != mode || out[b].groups != groups)) {
+            b++;
+        }
+        if (b == n) {
+            out[n].mode = mode;
+            out[n].groups = groups;
+            out[n].slots = 0;
+            n++;
+        }
+        out[b].slots = static_cast<uint16_t>(out[b].slots | (1u << i));
+    }
+
+    // One shared baseline: all delta clients or none
+    if (deltaDue) {
+        out[n].mode = BoatDataStreamMode::DELTA;
+        out[n].groups = BoatDataGroup::ALL;
+        out[n].slots = deltaSlots;
+        n++;
+    }
+    return n;
+}
+
+void BoatDataStreamClients::markSent(const BoatDataStreamBucket& bucket, uint32_t generation, unsigned long nowMs) {
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (bucket.slots & (1u << i)) {
+            generation_[i] = generation;
+            sentMs_[i] = static_cast<uint32_t>(nowMs);
+            __atomic_store_n(&fresh_[i], false, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+bool BoatDataStreamClients::recordSent(uint8_t slot) {
+    if (slot >= BOATDATA_STREAM_MAX_CLIENTS) {
+        return false;
+    }
+    __atomic_store_n(&sent_[slot], sent_[slot] + 1, __ATOMIC_RELAXED);
+    bool wasBehind = behindSinceMs_[slot] != 0;
+    __atomic_store_n(&behindSinceMs_[slot], 0u, __ATOMIC_RELAXED);
+    return wasBehind;
+}
+
+bool BoatDataStreamClients::recordDropped(uint8_t slot, unsigned long nowMs) {
+    if (slot >= BOATDATA_STREAM_MAX_CLIENTS) {
+        return false;
+    }
+    __atomic_store_n(&dropped_[slot], dropped_[slot] + 1, __ATOMIC_RELAXED);
+    __atomic_store_n(&droppedTotal_, droppedTotal_ + 1, __ATOMIC_RELAXED);
+
+    uint32_t now = static_cast<uint32_t>(nowMs) | 1u;  // 0 means "keeping up"
+    if (behindSinceMs_[slot] == 0) {
+        __atomic_store_n(&behindSinceMs_[slot], now, __ATOMIC_RELAXED);
+        return false;
+    }
+    if (now - behindSinceMs_[slot] < BOATDATA_STREAM_EVICT_MS) {
+        return false;
+    }
+    __atomic_store_n(&evicted_, evicted_ + 1, __ATOMIC_RELAXED);
+    return true;
+}
+
+bool BoatDataStreamClients::getStats(uint8_t slot, BoatDataStreamClientStats& stats, unsigned long nowMs) const {
+    stats.id = at(slot);
+    if (stats.id == 0) {
+        return false;
+    }
+    stats.mode = modes_[slot];
+    stats.groups = __atomic_load_n(&groups_[slot], __ATOMIC_RELAXED);
+    stats.intervalMs = static_cast<uint32_t>(ticksOf(slot)) * BOATDATA_STREAM_TICK_MS;
+    stats.sent = __atomic_load_n(&sent_[slot], __ATOMIC_RELAXED);
+    stats.dropped = __atomic_load_n(&dropped_[slot], __ATOMIC_RELAXED);
+    uint32_t behindSince = __atomic_load_n(&behindSinceMs_[slot], __ATOMIC_RELAXED);
+    stats.behindMs = behindSince != 0 ? (static_cast<uint32_t>(nowMs) | 1u) - behindSince : 0;
+    return true;
+}
+
+uint8_t BoatDataStreamClients::ticksForRate(double hz) {
+    if (!(hz > 0.0)) {
+        return 0;
+    }
+    double ticks = round(1000.0 / (hz * BOATDATA_STREAM_TICK_MS));
+    if (ticks < 1.0) {
+        return 1;
+    }
+    return ticks > 255.0 ? 255 : static_cast<uint8_t>(ticks);
+}
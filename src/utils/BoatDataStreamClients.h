@@ -0,0 +1,204 @@
+/**
+ * @file BoatDataStreamClients.h
+ * @brief Stream format, subscription and schedule of each /boatdata WebSocket client
+ *
+ * A client picks its format with a query parameter when it connects:
+ * - /boatdata                 full JSON frame (BoatDataSerializer::toJSON)
+ * - /boatdata?mode=delta      JSON keyframe + deltas (BoatDataDeltaEncoder)
+ * - /boatdata?fmt=bin         binary BoatDataSnapshot frame (122 bytes)
+ *
+ * Full and binary clients may then send a subscription message to receive
+ * only some groups, at their own rate:
+ * - {"subscribe":["compass","wind"],"rate":10}   groups (default: all), Hz (default: 1)
+ * - {"unsubscribe":true}                         back to every group at 1 Hz
+ *
+ * The broadcast loop ticks every BOATDATA_STREAM_TICK_MS. A client is due
+ * on ticks that are a multiple of its interval (so clients at the same rate
+ * fall due together) when one of its groups changed, it just joined, or
+ * BOATDATA_BROADCAST_KEEPALIVE_MS passed. Clients without a rate follow the
+ * default interval, which the rate governor (BoatDataRateGovernor) moves
+ * with the load; while it is backed off it also sets a floor that slows
+ * subscribed clients (setDefaultTicks(), setFloorTicks()). buckets() groups the due clients
+ * by payload (mode + groups); each bucket is encoded once. Delta clients
+ * share one encoder baseline, so they always get every group at the default
+ * rate and are due together.
+ *
+ * Backpressure: the broadcast loop skips a frame for a client that still
+ * has BOATDATA_STREAM_MAX_QUEUED frames queued (recordDropped()); the client
+ * stays due, so once it drains it gets the latest state instead of a
+ * backlog. A client behind for BOATDATA_STREAM_EVICT_MS is disconnected.
+ * Sent and dropped counts per client are served by GET /boatdata/stats.
+ *
+ * add()/subscribe()/remove() run on the WebSocket event task and the
+ * broadcast loop reads: a slot's settings are stored before its ID and the
+ * ID is cleared first, each a single aligned store, so a reader sees each
+ * slot old or new (a subscription changed mid-tick applies from the next).
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): 29 bytes per client slot, no heap
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOATDATA_STREAM_CLIENTS_H
+#define BOATDATA_STREAM_CLIENTS_H
+
+#include <stdint.h>
+#include "../config.h"
+#include "BoatDataChangeTracker.h"
+
+static_assert(BOATDATA_STREAM_MAX_CLIENTS <= 16, "BoatDataStreamBucket::slots is a 16-bit mask");
+
+/// Scheduler ticks between frames of a client without a subscription (until the governor moves it)
+constexpr uint8_t BOATDATA_STREAM_DEFAULT_TICKS = BOATDATA_BROADCAST_INTERVAL_MS / BOATDATA_STREAM_TICK_MS;
+
+/**
+ * @brief Frame format of a /boatdata client
+ */
+enum class BoatDataStreamMode : uint8_t {
+    FULL = 0,   ///< Full JSON frame (default)
+    DELTA,      ///< JSON keyframe + deltas
+    BINARY      ///< BoatDataSnapshot binary frame
+};
+
+/**
+ * @brief Clients due on one tick that receive the same payload
+ */
+struct BoatDataStreamBucket {
+    BoatDataStreamMode mode;
+    uint16_t groups;    ///< BoatDataGroup mask of the payload
+    uint16_t slots;     ///< Bit n set: the client in slot n receives it
+};
+
+/**
+ * @brief Counters of one connected client (GET /boatdata/stats)
+ */
+struct BoatDataStreamClientStats {
+    uint32_t id;
+    BoatDataStreamMode mode;
+    uint16_t groups;        ///< BoatDataGroup mask
+    uint32_t intervalMs;    ///< Subscribed frame interval
+    uint32_t sent;          ///< Frames queued for the client
+    uint32_t dropped;       ///< Frames skipped because its queue was full
+    uint32_t behindMs;      ///< Time since the first frame skipped in a row (0 = keeping up)
+};
+
+/**
+ * @class BoatDataStreamClients
+ * @brief IDs, formats and subscriptions of the connected /boatdata clients
+ */
+class BoatDataStreamClients {
+public:
+    BoatDataStreamClients();
+
+    /**
+     * @brief Register client @p id with @p mode, every group at the default rate
+     *
+     * The client is due on the next default tick.
+     *
+     * @return false for ID 0 or a full table
+     */
+    bool add(uint32_t id, BoatDataStreamMode mode);
+
+    /**
+     * @brief Send only @p groups to client @p id, every @p ticks scheduler ticks
+     *
+     * @param ticks 0 = the default interval (follows setDefaultTicks())
+     * @return false if @p id is not registered, is a delta client, or @p groups selects nothing
+     */
+    bool subscribe(uint32_t id, uint16_t groups, uint8_t ticks);
+
+    /// Interval of clients without a rate, delta and Signal K streams (>= 1; broadcast loop)
+    void setDefaultTicks(uint8_t ticks);
+    uint8_t getDefaultTicks() const { return __atomic_load_n(&defaultTicks_, __ATOMIC_RELAXED); }
+
+    /// Slowest interval any client is sent at, in ticks (1 = no floor; broadcast loop)
+    void setFloorTicks(uint8_t ticks);
+
+    /// Interval of client @p slot in ticks, default and floor applied (0 if the slot is free)
+    uint8_t ticksOf(uint8_t slot) const;
+
+    /// Forget client @p id (no-op if it is not registered)
+    void remove(uint32_t id);
+
+    /// Format of client @p id (FULL if not registered)
+    BoatDataStreamMode modeOf(uint32_t id) const;
+
+    /// Registered clients using @p mode
+    uint8_t count(BoatDataStreamMode mode) const;
+
+    /// Registered clients of any mode
+    uint8_t count() const;
+
+    /// Client in @p slot if it uses @p mode, else 0 (slot < BOATDATA_STREAM_MAX_CLIENTS)
+    uint32_t at(uint8_t slot, BoatDataStreamMode mode) const;
+
+    /// Client in @p slot, 0 if free
+    uint32_t at(uint8_t slot) const;
+
+    /// A delta client joined since the last call (clears the flag)
+    bool takeDeltaJoined();
+
+    /**
+     * @brief Group the clients due on scheduler tick @p tick by payload
+     *
+     * @param out At least BOATDATA_STREAM_MAX_CLIENTS entries
+     * @return Number of buckets written (0 = nothing to send this tick)
+     */
+    uint8_t buckets(uint32_t tick, unsigned long nowMs, const BoatDataChangeTracker& changes,
+                    BoatDataStreamBucket* out) const;
+
+    /// Record that @p bucket was sent with data up to @p generation (broadcast loop only)
+    void markSent(const BoatDataStreamBucket& bucket, uint32_t generation, unsigned long nowMs);
+
+    /**
+     * @brief Count a frame queued for the client in @p slot (broadcast loop only)
+     *
+     * @return true if the client had been skipped before this frame (it caught up)
+     */
+    bool recordSent(uint8_t slot);
+
+    /**
+     * @brief Count a frame skipped for the client in @p slot because its queue is full
+     *
+     * @return true if it has now been behind for BOATDATA_STREAM_EVICT_MS: close it (counted as evicted)
+     */
+    bool recordDropped(uint8_t slot, unsigned long nowMs);
+
+    /// Counters of the client in @p slot; false if the slot is free
+    bool getStats(uint8_t slot, BoatDataStreamClientStats& stats, unsigned long nowMs) const;
+
+    /// Frames skipped for all clients since boot (disconnected clients included)
+    uint32_t getDroppedTotal() const { return __atomic_load_n(&droppedTotal_, __ATOMIC_RELAXED); }
+
+    /// Clients disconnected for staying behind since boot
+    uint32_t getEvicted() const { return __atomic_load_n(&evicted_, __ATOMIC_RELAXED); }
+
+    /// Scheduler ticks between frames for @p hz, limited to 1..255 (0 for a rate <= 0 or NaN)
+    static uint8_t ticksForRate(double hz);
+
+private:
+    uint32_t id(uint8_t slot) const;
+    bool isDue(uint8_t slot, uint32_t tick, unsigned long nowMs, const BoatDataChangeTracker& changes) const;
+
+    uint32_t ids_[BOATDATA_STREAM_MAX_CLIENTS];
+    uint32_t generation_[BOATDATA_STREAM_MAX_CLIENTS];  ///< Generation of the last frame (broadcast loop)
+    uint32_t sentMs_[BOATDATA_STREAM_MAX_CLIENTS];      ///< millis() of the last frame (broadcast loop)
+    uint16_t groups_[BOATDATA_STREAM_MAX_CLIENTS];
+    BoatDataStreamMode modes_[BOATDATA_STREAM_MAX_CLIENTS];
+    uint8_t ticks_[BOATDATA_STREAM_MAX_CLIENTS];        ///< Subscribed interval, 0 = default
+    uint32_t sent_[BOATDATA_STREAM_MAX_CLIENTS];
+    uint32_t dropped_[BOATDATA_STREAM_MAX_CLIENTS];
+    uint32_t behindSinceMs_[BOATDATA_STREAM_MAX_CLIENTS];  ///< millis() of the first skip in a row (0 = keeping up)
+    bool fresh_[BOATDATA_STREAM_MAX_CLIENTS];           ///< Joined or resubscribed; no frame sent yet
+    uint8_t defaultTicks_;
+    uint8_t floorTicks_;
+    bool deltaJoined_;
+    uint32_t droppedTotal_;
+    uint32_t evicted_;
+};
+
+#endif // BOATDATA_STREAM_CLIENTS_H
@@ -0,0 +1,122 @@
+/**
+ * @file BoatDataSubscriptions.cpp
+ * @brief Implementation of the BoatData change-notification table
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BoatDataSubscriptions.h"
+
+BoatDataSubscriptions::BoatDataSubscriptions() : notifyCount_(0) {
+    for (uint8_t i = 0; i < BOATDATA_MAX_SUBSCRIBERS; i++) {
+        subscribers_[i].callback = nullptr;
+    }
+}
+
+int BoatDataSubscriptions::subscribe(uint16_t groups, uint32_t minIntervalMs,
+                                     BoatDataChangeCallback callback, void* context,
+                                     uint32_t sinceGeneration) {
+    groups &= BoatDataGroup::ALL;
+    if (groups == 0 || callback == nullptr) {
+        return -1;
+    }
+
+    for (uint8_t i = 0; i < BOATDATA_MAX_SUBSCRIBERS; i++) {
+        Subscriber& sub = subscribers_[i];
+        if (sub.callback != nullptr) {
+            continue;
+        }
+        sub.callback = callback;
+        sub.context = context;
+        sub.groups = groups;
+        sub.minIntervalMs = minIntervalMs;
+        sub.maxIntervalMs = 0;
+        sub.seenGeneration = sinceGeneration;
+        sub.lastNotifyMs = 0;
+        sub.pendingSinceMs = 0;
+        sub.lastWaitMs = 0;
+        sub.notified = false;
+        sub.pending = false;
+        return i;
+    }
+    return -1;
+}
+
+void BoatDataSubscriptions::setMaxInterval(int id, uint32_t maxIntervalMs) {
+    if (id >= 0 && id < BOATDATA_MAX_SUBSCRIBERS) {
+        subscribers_[id].maxIntervalMs = maxIntervalMs;
+    }
+}
+
+void BoatDataSubscriptions::setMinInterval(int id, uint32_t minIntervalMs) {
+    if (id >= 0 && id < BOATDATA_MAX_SUBSCRIBERS) {
+        subscribers_[id].minIntervalMs = minIntervalMs;
+    }
+}
+
+void BoatDataSubscriptions::unsubscribe(int id) {
+    if (id >= 0 && id < BOATDATA_MAX_SUBSCRIBERS) {
+        subscribers_[id].callback = nullptr;
+    }
+}
+
+uint8_t BoatDataSubscriptions::dispatch(const BoatDataChangeTracker& tracker, uint32_t nowMs) {
+    uint32_t generation = tracker.getGeneration();
+    uint8_t calls = 0;
+
+    for (uint8_t i = 0; i < BOATDATA_MAX_SUBSCRIBERS; i++) {
+        Subscriber& sub = subscribers_[i];
+        if (sub.callback == nullptr) {
+            continue;
+        }
+
+        uint16_t changed = 0;
+        if (sub.seenGeneration != generation) {
+            changed = static_cast<uint16_t>(tracker.changedSince(sub.seenGeneration) & sub.groups);
+            if (changed == 0) {
+                sub.seenGeneration = generation;  // Only groups outside the mask changed
+            } else if (!sub.pending) {
+                sub.pending = true;
+                sub.pendingSinceMs = nowMs;
+            }
+        }
+
+        uint32_t sinceNotify = nowMs - sub.lastNotifyMs;
+        bool heartbeat = sub.maxIntervalMs != 0 && (!sub.notified || sinceNotify >= sub.maxIntervalMs);
+        if (changed == 0 && !heartbeat) {
+            continue;
+        }
+        if (sub.notified && sinceNotify < sub.minIntervalMs) {
+            continue;  // Coalesce: changes accumulate until the interval has passed
+        }
+
+        sub.seenGeneration = generation;
+        sub.lastWaitMs = sub.pending ? nowMs - sub.pendingSinceMs : 0;
+        sub.pending = false;
+        sub.notified = true;
+        sub.lastNotifyMs = nowMs;
+        sub.callback(sub.context, changed);
+        calls++;
+    }
+
+    notifyCount_ += calls;
+    return calls;
+}
+
+uint32_t BoatDataSubscriptions::getWaitMs(int id) const {
+    if (id < 0 || id >= BOATDATA_MAX_SUBSCRIBERS) {
+        return 0;
+    }
+    return subscribers_[id].lastWaitMs;
+}
+
+uint8_t BoatDataSubscriptions::getCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < BOATDATA_MAX_SUBSCRIBERS; i++) {
+        if (subscribers_[i].callback != nullptr) {
+            count++;
+        }
+    }
+    return count;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file BoatDataSubscriptions.h
+ * @brief Fixed-size change-notification table for BoatData consumers
+ *
+ * A subscriber registers a BoatDataGroup mask, a minimum interval and a
+ * callback. dispatch() runs on the BoatData writer task (main loop) and
+ * calls each subscriber at most once per interval with the groups in its
+ * mask written since its previous callback, so a 50 Hz heading source
+ * produces one callback per interval per consumer instead of fifty.
+ *
+ * A consumer that prefers to do its work on its own ReactESP event can pass
+ * a callback that only sets a flag (context = the flag).
+ *
+ * setMaxInterval() adds a heartbeat: the subscriber is also called (with
+ * changed = 0) when nothing in its mask changed for that long.
+ * setMinInterval() re-rates a subscriber at runtime. getWaitMs()
+ * reports how long the coalescing held back the changes of the latest
+ * callback, measured from the first dispatch() that saw them.
+ *
+ * Callbacks run on the dispatching task and must not subscribe or
+ * unsubscribe. Storage is BOATDATA_MAX_SUBSCRIBERS slots, no allocation.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * void onWind(void* context, uint16_t changed) { ... }
+ *
+ * int id = subscriptions.subscribe(BoatDataGroup::WIND | BoatDataGroup::COMPASS, 200, onWind, nullptr);
+ * ...
+ * subscriptions.dispatch(tracker, millis());  // Writer task, e.g. every 10 ms
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): static subscriber table, zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOATDATA_SUBSCRIPTIONS_H
+#define BOATDATA_SUBSCRIPTIONS_H
+
+#include <stdint.h>
+#include "BoatDataChangeTracker.h"
+#include "../config.h"
+
+/**
+ * @brief Change callback
+ *
+ * @param context Pointer passed to subscribe()
+ * @param changed BoatDataGroup bits (within the subscribed mask) written since the last call
+ */
+typedef void (*BoatDataChangeCallback)(void* context, uint16_t changed);
+
+/**
+ * @class BoatDataSubscriptions
+ * @brief Subscriber table with coalescing dispatch
+ */
+class BoatDataSubscriptions {
+public:
+    BoatDataSubscriptions();
+
+    /**
+     * @brief Register a subscriber
+     *
+     * The first dispatch() after subscribing reports groups written since
+     * @p sinceGeneration (0 = every group written so far).
+     *
+     * @param groups BoatDataGroup mask to watch
+     * @param minIntervalMs Minimum time between two callbacks (0 = every dispatch with changes)
+     * @param callback Called from dispatch()
+     * @param context Passed to @p callback
+     * @param sinceGeneration Generation the subscriber is already up to date with
+     * @return Subscription ID (>= 0), or -1 if the mask is empty, callback is
+     *         nullptr or all BOATDATA_MAX_SUBSCRIBERS slots are taken
+     */
+    int subscribe(uint16_t groups, uint32_t minIntervalMs, BoatDataChangeCallback callback,
+                  void* context, uint32_t sinceGeneration = 0);
+
+    /**
+     * @brief Call @p id at least every @p maxIntervalMs, with or without changes
+     *
+     * @param maxIntervalMs Longest time between two callbacks (0 = changes only, default)
+     */
+    void setMaxInterval(int id, uint32_t maxIntervalMs);
+
+    /**
+     * @brief Change the minimum interval of @p id (e.g. a power profile switch)
+     *
+     * Takes effect at the next dispatch(); changes already pending are kept.
+     */
+    void setMinInterval(int id, uint32_t minIntervalMs);
+
+    /**
+     * @brief Release a subscription (invalid IDs are ignored)
+     */
+    void unsubscribe(int id);
+
+    /**
+     * @brief Notify every due subscriber whose groups changed
+     *
+     * @return Number of callbacks made
+     */
+    uint8_t dispatch(const BoatDataChangeTracker& tracker, uint32_t nowMs);
+
+    /**
+     * @brief Time the changes of @p id's latest callback waited for it
+     *
+     * From the first dispatch() that saw a change in the mask to the
+     * callback (0 for a heartbeat). Valid inside the callback.
+     */
+    uint32_t getWaitMs(int id) const;
+
+    /// Callbacks made since startup
+    uint32_t getNotifyCount() const { return notifyCount_; }
+
+    /// Active subscriptions
+    uint8_t getCount() const;
+
+private:
+    struct Subscriber {
+        BoatDataChangeCallback callback;  ///< nullptr = free slot
+        void* context;
+        uint16_t groups;
+        uint32_t minIntervalMs;
+        uint32_t maxIntervalMs;           ///< Heartbeat interval (0 = none)
+        uint32_t seenGeneration;          ///< Generation reported by the last callback
+        uint32_t lastNotifyMs;
+        uint32_t pendingSinceMs;          ///< First dispatch() that saw an unreported change
+        uint32_t lastWaitMs;
+        bool notified;                    ///< lastNotifyMs is valid
+        bool pending;                     ///< pendingSinceMs is valid
+    };
+
+    Subscriber subscribers_[BOATDATA_MAX_SUBSCRIBERS];
+    uint32_t notifyCount_;
+};
+
+#endif // BOATDATA_SUBSCRIPTIONS_H
@@ -0,0 +1,93 @@
+/**
+ * @file BoatDataView.h
+ * @brief Zero-copy read access to one BoatData group
+ *
+ * The by-value getters (getGPSData(), getBatteryData(), ...) copy the whole
+ * group on every call. A view instead refers to the stored group and keeps
+ * the group's SeqLock counter from when it was taken, so an in-process
+ * reader can use only the fields it needs and then check that they were
+ * consistent:
+ *
+ * @code
+ * BoatDataView<GPSData> gps = boatData->viewGPSData();
+ * double lat = gps->latitude;
+ * double lon = gps->longitude;
+ * if (gps.valid()) {
+ *     // lat/lon belong to the same write
+ * }
+ * @endcode
+ *
+ * On the writer task (main loop) a view is always valid. Readers on another
+ * task retry with refresh() or fall back to copy() / the by-value getter if
+ * valid() fails. A view must not outlive the store it was taken from.
+ *
+ * Header-only, Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): no copy of the group, 12 bytes per view on the stack
+ * - Principle VII (Fail-Safe): torn reads are detected, never silently used
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOAT_DATA_VIEW_H
+#define BOAT_DATA_VIEW_H
+
+#include <stdint.h>
+#include "SeqLock.h"
+
+/**
+ * @class BoatDataView
+ * @brief Const reference to a stored group paired with its version counter
+ *
+ * @tparam T Group structure (GPSData, CompassData, ...)
+ */
+template <typename T>
+class BoatDataView {
+public:
+    /**
+     * @brief View @p group guarded by @p lock, starting now
+     */
+    BoatDataView(const T& group, const SeqLock& lock)
+        : group_(&group), lock_(&lock), begin_(lock.readBegin()) {}
+
+    /// Stored group (fields may change under a reader on another task, see valid())
+    const T& get() const { return *group_; }
+    const T& operator*() const { return *group_; }
+    const T* operator->() const { return group_; }
+
+    /**
+     * @brief Group version when the view was taken (see SeqLock::version())
+     */
+    uint16_t version() const { return static_cast<uint16_t>(begin_ >> 1); }
+
+    /**
+     * @brief Whether no write was in progress or completed since the view was taken
+     *
+     * Call after reading the fields; true means every field read through the
+     * view so far belongs to version().
+     */
+    bool valid() const { return lock_->readValid(begin_); }
+
+    /**
+     * @brief Restart the view at the current version (after valid() failed)
+     */
+    void refresh() { begin_ = lock_->readBegin(); }
+
+    /**
+     * @brief Consistent copy of the group, as the by-value getters return
+     *
+     * @param out Snapshot
+     * @param version Set to the snapshot's version if not nullptr
+     * @return true if @p out is consistent (see SeqLock::read())
+     */
+    bool copy(T& out, uint16_t* version = nullptr) const { return lock_->read(*group_, out, version); }
+
+private:
+    const T* group_;
+    const SeqLock* lock_;
+    uint16_t begin_;  ///< Raw counter at readBegin()
+};
+
+#endif // BOAT_DATA_VIEW_H
@@ -0,0 +1,105 @@
+/**
+ * @file BootTimeline.cpp
+ * @brief Implementation of the boot timeline
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BootTimeline.h"
+
+BootTimeline::BootTimeline() : count_(0), dropped_(0), lastMarkMs_(0) {
+    for (uint8_t i = 0; i < static_cast<uint8_t>(BootMilestone::COUNT); i++) {
+        milestones_[i].store(NOT_REACHED, std::memory_order_relaxed);
+    }
+}
+
+void BootTimeline::mark(const char* name, uint32_t nowMs) {
+    record(name, lastMarkMs_, nowMs);
+    lastMarkMs_ = nowMs;
+}
+
+void BootTimeline::record(const char* name, uint32_t startMs, uint32_t endMs) {
+    if (count_ >= BOOT_TIMELINE_STEPS) {
+        dropped_++;
+        return;
+    }
+    BootStep& step = steps_[count_++];
+    step.name = name;
+    step.startMs = startMs;
+    step.durationMs = endMs - startMs;
+}
+
+void BootTimeline::milestone(BootMilestone milestone, uint32_t nowMs) {
+    if (milestone >= BootMilestone::COUNT) {
+        return;
+    }
+    std::atomic<uint32_t>& slot = milestones_[static_cast<uint8_t>(milestone)];
+    // Cheap test first: called for every NMEA2000 message
+    if (slot.load(std::memory_order_relaxed) != NOT_REACHED) {
+        return;
+    }
+    uint32_t expected = NOT_REACHED;
+    slot.compare_exchange_strong(expected, nowMs, std::memory_order_relaxed);
+}
+
+uint32_t BootTimeline::getMilestone(BootMilestone milestone) const {
+    return milestone < BootMilestone::COUNT ? milestones_[static_cast<uint8_t>(milestone)].load(std::memory_order_relaxed)
+                                            : NOT_REACHED;
+}
+
+const char* BootTimeline::milestoneName(BootMilestone milestone) {
+    switch (milestone) {
+        case BootMilestone::SETUP_DONE:      return "setup_done";
+        case BootMilestone::FIRST_LOOP:      return "first_loop";
+        case BootMilestone::FIRST_N2K_FRAME: return "first_n2k_frame";
+        case BootMilestone::WIFI_CONNECTED:  return "wifi_connected";
+        default:                             return "unknown";
+    }
+}
+
+bool BootTimeline::writeJson(JsonWriter& json, uint32_t nowMs, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.beginArray("steps");
+    for (uint8_t i = 0; i < count_; i++) {
+        json.beginObject()
+            .add("name", steps_[i].name)
+            .add("start_ms", (unsigned long)steps_[i].startMs)
+            .add("ms", (unsigned long)steps_[i].durationMs)
+            .endObject();
+    }
+    json.endArray().beginObject("milestones_ms");
+    for (uint8_t i = 0; i < static_cast<uint8_t>(BootMilestone::COUNT); i++) {
+        BootMilestone milestone = static_cast<BootMilestone>(i);
+        uint32_t at = getMilestone(milestone);
+        if (at == NOT_REACHED) {
+            json.addRaw(milestoneName(milestone), "null");
+        } else {
+            json.add(milestoneName(milestone), (unsigned long)at);
+        }
+    }
+    json.endObject().add("n2k_target_ms", (unsigned long)BOOT_N2K_TARGET_MS);
+
+    uint32_t firstFrame = getMilestone(BootMilestone::FIRST_N2K_FRAME);
+    if (firstFrame != NOT_REACHED) {
+        json.add("n2k_target_met", firstFrame <= BOOT_N2K_TARGET_MS);
+    } else if (nowMs > BOOT_N2K_TARGET_MS) {
+        json.add("n2k_target_met", false);
+    } else {
+        json.addRaw("n2k_target_met", "null");
+    }
+    if (dropped_ > 0) {
+        json.add("dropped_steps", (unsigned int)dropped_);
+    }
+    json.endObject();
+    return !json.overflowed();
+}
+
+BootTimeline& GetBootTimeline() {
+    static BootTimeline timeline;
+    return timeline;
+}
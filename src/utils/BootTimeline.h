@@ -0,0 +1,117 @@
+/**
+ * @file BootTimeline.h
+ * @brief Elapsed time per setup() step and the first-event milestones of a boot
+ *
+ * setup() marks the end of each init step (LittleFS, BoatData, NMEA2000,
+ * WiFi start, ...); work moved out of setup() (the deferred OLED init) is
+ * recorded with its own start and end. Milestones are set once, from any
+ * task, the first time they happen:
+ * - setup_done / first_loop: setup() returned, first loop() pass
+ * - first_n2k_frame: first NMEA2000 message handled (N2kPGNDispatcher)
+ * - wifi_connected: first GOT_IP
+ *
+ * Times are millis() since the application started (the ROM and second
+ * stage bootloader, ~0.3 s, come before). GET /status reports the timeline
+ * and whether the first NMEA2000 frame met BOOT_N2K_TARGET_MS.
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed step table, no heap
+ * - Principle V (Network Debugging): boot time per subsystem over HTTP
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BOOT_TIMELINE_H
+#define BOOT_TIMELINE_H
+
+#include <stdint.h>
+#include <atomic>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief One-time boot events
+ */
+enum class BootMilestone : uint8_t {
+    SETUP_DONE = 0,
+    FIRST_LOOP,
+    FIRST_N2K_FRAME,
+    WIFI_CONNECTED,
+    COUNT
+};
+
+/**
+ * @brief One recorded init step
+ */
+struct BootStep {
+    const char* name;       ///< Static label
+    uint32_t startMs;
+    uint32_t durationMs;
+};
+
+/**
+ * @class BootTimeline
+ * @brief Steps (setup task only) and milestones (any task)
+ *
+ * Usage pattern:
+ * @code
+ * GetBootTimeline().mark("littlefs", millis());        // Step since the previous mark
+ * GetBootTimeline().milestone(BootMilestone::FIRST_N2K_FRAME, millis());
+ * @endcode
+ */
+class BootTimeline {
+public:
+    static constexpr uint32_t NOT_REACHED = UINT32_MAX;
+
+    BootTimeline();
+
+    /// End a step at @p nowMs; it started at the previous mark (0 for the first)
+    void mark(const char* name, uint32_t nowMs);
+
+    /// Add a step that ran outside the setup() sequence (does not move the mark)
+    void record(const char* name, uint32_t startMs, uint32_t endMs);
+
+    /// Set @p milestone to @p nowMs unless already reached
+    void milestone(BootMilestone milestone, uint32_t nowMs);
+
+    /// Time of @p milestone, or NOT_REACHED
+    uint32_t getMilestone(BootMilestone milestone) const;
+
+    uint8_t getStepCount() const { return count_; }
+    const BootStep& getStep(uint8_t index) const { return steps_[index]; }
+
+    /// Steps dropped because the table was full
+    uint8_t getDropped() const { return dropped_; }
+
+    /// "setup_done", "first_loop", "first_n2k_frame", "wifi_connected"
+    static const char* milestoneName(BootMilestone milestone);
+
+    /**
+     * @brief Write the timeline as a JSON object
+     *
+     * {"steps":[{"name":"littlefs","start_ms":2,"ms":38},...],
+     *  "milestones_ms":{"setup_done":212,"first_loop":213,"first_n2k_frame":96,"wifi_connected":null},
+     *  "n2k_target_ms":500,"n2k_target_met":true}
+     *
+     * n2k_target_met is null until the first frame, or once BOOT_N2K_TARGET_MS
+     * passed without one (@p nowMs), false. With @p key the object is a
+     * member of the enclosing one (GET /status).
+     *
+     * @return false if @p json overflowed
+     */
+    bool writeJson(JsonWriter& json, uint32_t nowMs, const char* key = nullptr) const;
+
+private:
+    BootStep steps_[BOOT_TIMELINE_STEPS];
+    uint8_t count_;
+    uint8_t dropped_;
+    uint32_t lastMarkMs_;
+    std::atomic<uint32_t> milestones_[static_cast<uint8_t>(BootMilestone::COUNT)];
+};
+
+/// The timeline of this boot
+BootTimeline& GetBootTimeline();
+
+#endif // BOOT_TIMELINE_H
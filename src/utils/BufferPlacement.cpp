@@ -0,0 +1,125 @@
+/**
+ * @file BufferPlacement.cpp
+ * @brief Implementation of the PSRAM-first large-buffer placement
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BufferPlacement.h"
+#include <stdlib.h>
+
+#ifdef ARDUINO
+#include <esp_heap_caps.h>
+#endif
+
+namespace {
+
+void* platformAllocate(size_t bytes, size_t alignment, BufferRegion region) {
+#ifdef ARDUINO
+    uint32_t caps = MALLOC_CAP_8BIT |
+        (region == BufferRegion::PSRAM ? MALLOC_CAP_SPIRAM : MALLOC_CAP_INTERNAL);
+    return heap_caps_aligned_alloc(alignment < 4 ? 4 : alignment, bytes, caps);
+#else
+    (void)alignment;  // malloc is aligned for any element type
+    (void)region;     // One memory off-target: every buffer gets its full capacity
+    return malloc(bytes);
+#endif
+}
+
+}  // namespace
+
+BufferPlacement::BufferPlacement(Allocator allocator)
+    : allocator_(allocator != nullptr ? allocator : platformAllocate), count_(0), failed_(0) {
+}
+
+void* BufferPlacement::placeBytes(const char* name, size_t elementSize, size_t alignment,
+                                  uint32_t psramCount, uint32_t internalCount, uint32_t& count,
+                                  BufferRegion* region) {
+    BufferRegion placed = BufferRegion::PSRAM;
+    count = psramCount;
+    void* block = psramCount > 0 ? allocator_(elementSize * psramCount, alignment, placed) : nullptr;
+    if (block == nullptr) {
+        // No PSRAM (or no room left in it): the configured internal capacity
+        placed = BufferRegion::INTERNAL_RAM;
+        count = internalCount;
+        block = internalCount > 0 ? allocator_(elementSize * internalCount, alignment, placed) : nullptr;
+    }
+    if (block == nullptr) {
+        placed = BufferRegion::NONE;
+        count = 0;
+        failed_++;
+    }
+    record(name, static_cast<uint32_t>(elementSize * (block != nullptr ? count : internalCount)), count,
+           placed, placed != BufferRegion::PSRAM && internalCount < psramCount);
+    if (region != nullptr) {
+        *region = placed;
+    }
+    return block;
+}
+
+void BufferPlacement::record(const char* name, uint32_t bytes, uint32_t count, BufferRegion region,
+                             bool reduced) {
+    if (count_ < BUFFER_PLACEMENT_MAX_ENTRIES) {
+        entries_[count_++] = {name, bytes, count, region, reduced};
+    }
+}
+
+uint32_t BufferPlacement::getBytes(BufferRegion region) const {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        if (entries_[i].region == region) {
+            total += entries_[i].bytes;
+        }
+    }
+    return total;
+}
+
+const char* BufferPlacement::regionName(BufferRegion region) {
+    switch (region) {
+        case BufferRegion::PSRAM:        return "psram";
+        case BufferRegion::INTERNAL_RAM: return "internal";
+        case BufferRegion::NONE:         return "none";
+        default:                         return "unknown";
+    }
+}
+
+void BufferPlacement::addTo(MemoryBudget& budget) const {
+    for (uint8_t i = 0; i < count_; i++) {
+        const Entry& entry = entries_[i];
+        if (entry.region == BufferRegion::PSRAM) {
+            budget.add(entry.name, entry.bytes, MemoryRegion::PSRAM);
+        } else if (entry.region == BufferRegion::INTERNAL_RAM) {
+            budget.add(entry.name, entry.bytes, MemoryRegion::BOOT_HEAP);
+        }
+    }
+}
+
+void BufferPlacement::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.beginArray("buffers");
+    for (uint8_t i = 0; i < count_; i++) {
+        const Entry& entry = entries_[i];
+        json.beginObject()
+            .add("name", entry.name)
+            .add("region", regionName(entry.region))
+            .add("bytes", (unsigned long)entry.bytes)
+            .add("count", (unsigned long)entry.count)
+            .add("reduced", entry.reduced)
+            .endObject();
+    }
+    json.endArray();
+    json.add("psram", (unsigned long)getBytes(BufferRegion::PSRAM))
+        .add("internal", (unsigned long)getBytes(BufferRegion::INTERNAL_RAM))
+        .add("failed", (unsigned int)failed_);
+    json.endObject();
+}
+
+BufferPlacement& GetBufferPlacement() {
+    static BufferPlacement placement;
+    return placement;
+}
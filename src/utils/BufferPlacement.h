@@ -0,0 +1,145 @@
+/**
+ * @file BufferPlacement.h
+ * @brief Boot-time placement of large buffers: PSRAM first, smaller internal fallback
+ *
+ * The policy for memory that is large but touched at low rates:
+ * - history rings, bus capture buffers, the trace ring and the delta
+ *   keyframe snapshot are placed here, at their full PSRAM capacity when
+ *   the board has PSRAM
+ * - without PSRAM (or with it exhausted) they fall back to internal RAM
+ *   with the reduced capacity configured for them, instead of failing
+ * - hot structures stay in internal SRAM and are never placed: the
+ *   BoatDataStructure, the CAN frame queues, the log ring (written from
+ *   every task, before PSRAM is up) and the WebSocket send pool
+ *
+ * Buffers are placed once from setup(): PSRAM is initialized after the
+ * global constructors run. They are never freed. Every placement is kept
+ * in a table for GET /memory (region, bytes, element count, reduced).
+ *
+ * PSRAM is reached through the flash cache: buffers placed there are not
+ * read from ISRs, and flash writes from them go through the IDF's bounce
+ * buffer. Arduino-free (unit tested natively with a fake allocator).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): internal SRAM is kept for hot paths
+ * - Principle VII (Fail-Safe): boards without PSRAM run with shorter buffers
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BUFFER_PLACEMENT_H
+#define BUFFER_PLACEMENT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include "JsonWriter.h"
+#include "MemoryBudget.h"
+#include "../config.h"
+
+/**
+ * @brief Where a placed buffer ended up
+ */
+enum class BufferRegion : uint8_t {
+    PSRAM = 0,
+    INTERNAL_RAM,
+    NONE            ///< Both allocations failed
+};
+
+/**
+ * @class BufferPlacement
+ * @brief Allocates large buffers by the PSRAM-first policy and records them
+ *
+ * Usage pattern:
+ * @code
+ * uint32_t count = 0;
+ * TraceEvent* events = GetBufferPlacement().place<TraceEvent>(
+ *     "trace_ring", TRACE_RING_EVENTS, TRACE_RING_INTERNAL_EVENTS, count);
+ * if (events == nullptr) {
+ *     // neither region had room: feature disabled
+ * }
+ * @endcode
+ */
+class BufferPlacement {
+public:
+    /// Returns @p bytes aligned to @p alignment from @p region, or nullptr
+    typedef void* (*Allocator)(size_t bytes, size_t alignment, BufferRegion region);
+
+    struct Entry {
+        const char* name;
+        uint32_t bytes;
+        uint32_t count;       ///< Elements placed
+        BufferRegion region;
+        bool reduced;         ///< Less than the PSRAM capacity (internal fallback, or failed)
+    };
+
+    /**
+     * @param allocator nullptr = heap_caps (on target), malloc for both regions (native)
+     */
+    explicit BufferPlacement(Allocator allocator = nullptr);
+
+    /**
+     * @brief Allocate @p psramCount elements in PSRAM, else @p internalCount in internal RAM
+     *
+     * @param name Listed in the table (string literal)
+     * @param elementSize Bytes per element
+     * @param alignment Alignment of the block
+     * @param count Output: elements placed (0 on failure)
+     * @param region Output, optional: where the block was placed
+     * @return Block (uninitialized), or nullptr if neither region had room
+     */
+    void* placeBytes(const char* name, size_t elementSize, size_t alignment,
+                     uint32_t psramCount, uint32_t internalCount, uint32_t& count,
+                     BufferRegion* region = nullptr);
+
+    /**
+     * @brief placeBytes() for @p T, elements value-initialized
+     */
+    template <typename T>
+    T* place(const char* name, uint32_t psramCount, uint32_t internalCount, uint32_t& count,
+             BufferRegion* region = nullptr) {
+        void* block = placeBytes(name, sizeof(T), alignof(T), psramCount, internalCount, count, region);
+        if (block == nullptr) {
+            return nullptr;
+        }
+        T* items = static_cast<T*>(block);
+        for (uint32_t i = 0; i < count; i++) {
+            new (&items[i]) T();
+        }
+        return items;
+    }
+
+    uint8_t getCount() const { return count_; }
+    const Entry& getEntry(uint8_t index) const { return entries_[index]; }
+
+    /// Placements that found no room in either region
+    uint8_t getFailed() const { return failed_; }
+
+    /// Bytes placed in @p region
+    uint32_t getBytes(BufferRegion region) const;
+
+    static const char* regionName(BufferRegion region);
+
+    /**
+     * @brief Add the placed buffers to @p budget (psram or boot_heap)
+     */
+    void addTo(MemoryBudget& budget) const;
+
+    /// {"buffers":[{"name":"trace_ring","region":"psram","bytes":8192,"count":512,"reduced":false}],
+    ///  "psram":N,"internal":N,"failed":n}
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    Allocator allocator_;
+    Entry entries_[BUFFER_PLACEMENT_MAX_ENTRIES];
+    uint8_t count_;
+    uint8_t failed_;
+
+    void record(const char* name, uint32_t bytes, uint32_t count, BufferRegion region, bool reduced);
+};
+
+/// Boot-time placements of this firmware (setup() only)
+BufferPlacement& GetBufferPlacement();
+
+#endif // BUFFER_PLACEMENT_H
@@ -0,0 +1,171 @@
+/**
+ * @file BusCaptureFormat.cpp
+ * @brief Implementation of the bus capture record format
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "BusCaptureFormat.h"
+#include <string.h>
+
+namespace {
+
+const uint8_t MAGIC[4] = {'P', '2', 'C', 'P'};
+
+constexpr uint8_t MAX_VARINT = 5;
+
+constexpr uint8_t UTC_PAYLOAD = 8;
+
+/// Writes the tag and delta; returns bytes written
+size_t writePrefix(uint8_t* out, BusCaptureType type, uint8_t port, uint32_t deltaMs) {
+    size_t pos = 0;
+    out[pos++] = static_cast<uint8_t>((static_cast<uint8_t>(type) << 4) | (port & 0x0F));
+    do {
+        uint8_t byte = static_cast<uint8_t>(deltaMs & 0x7F);
+        deltaMs >>= 7;
+        out[pos++] = deltaMs != 0 ? static_cast<uint8_t>(byte | 0x80) : byte;
+    } while (deltaMs != 0);
+    return pos;
+}
+
+size_t varintSize(uint32_t value) {
+    size_t n = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        n++;
+    }
+    return n;
+}
+
+}  // namespace
+
+size_t BusCaptureWriteHeader(uint8_t* out, size_t size) {
+    if (size < BUS_CAPTURE_HEADER_SIZE) {
+        return 0;
+    }
+    memcpy(out, MAGIC, sizeof(MAGIC));
+    out[4] = BUS_CAPTURE_VERSION;
+    out[5] = 0;
+    out[6] = 0;
+    out[7] = 0;
+    return BUS_CAPTURE_HEADER_SIZE;
+}
+
+bool BusCaptureCheckHeader(const uint8_t* in, size_t size) {
+    return size >= BUS_CAPTURE_HEADER_SIZE && memcmp(in, MAGIC, sizeof(MAGIC)) == 0 &&
+           in[4] >= 1 && in[4] <= BUS_CAPTURE_VERSION;
+}
+
+size_t BusCaptureEncodeLine(uint8_t* out, size_t size, uint32_t deltaMs, uint8_t port,
+                            const char* line, size_t length) {
+    if (port > 0x0F || length > BUS_CAPTURE_MAX_LINE ||
+        1 + varintSize(deltaMs) + 1 + length > size) {
+        return 0;
+    }
+
+    size_t pos = writePrefix(out, BusCaptureType::NMEA0183_LINE, port, deltaMs);
+    out[pos++] = static_cast<uint8_t>(length);
+    memcpy(out + pos, line, length);
+    return pos + length;
+}
+
+size_t BusCaptureEncodeFrame(uint8_t* out, size_t size, uint32_t deltaMs, uint32_t id,
+                             uint8_t length, const uint8_t* data) {
+    if (length > 8 || 1 + varintSize(deltaMs) + 4 + 1 + length > size) {
+        return 0;
+    }
+
+    size_t pos = writePrefix(out, BusCaptureType::CAN_FRAME, 0, deltaMs);
+    out[pos++] = static_cast<uint8_t>(id);
+    out[pos++] = static_cast<uint8_t>(id >> 8);
+    out[pos++] = static_cast<uint8_t>(id >> 16);
+    out[pos++] = static_cast<uint8_t>(id >> 24);
+    out[pos++] = length;
+    memcpy(out + pos, data, length);
+    return pos + length;
+}
+
+size_t BusCaptureEncodeUtc(uint8_t* out, size_t size, uint32_t deltaMs, uint64_t utcMs) {
+    if (1 + varintSize(deltaMs) + UTC_PAYLOAD > size) {
+        return 0;
+    }
+
+    size_t pos = writePrefix(out, BusCaptureType::UTC_MARK, 0, deltaMs);
+    for (uint8_t i = 0; i < UTC_PAYLOAD; i++) {
+        out[pos++] = static_cast<uint8_t>(utcMs >> (8 * i));
+    }
+    return pos;
+}
+
+int32_t BusCaptureDecode(const uint8_t* in, size_t size, BusCaptureRecord& record) {
+    if (size < 2) {
+        return 0;
+    }
+
+    uint8_t type = in[0] >> 4;
+    if (type != static_cast<uint8_t>(BusCaptureType::NMEA0183_LINE) &&
+        type != static_cast<uint8_t>(BusCaptureType::CAN_FRAME) &&
+        type != static_cast<uint8_t>(BusCaptureType::UTC_MARK)) {
+        return -1;
+    }
+
+    // Delta varint
+    size_t pos = 1;
+    uint32_t delta = 0;
+    for (uint8_t shift = 0;; shift += 7) {
+        if (pos >= size) {
+            return 0;
+        }
+        if (pos > MAX_VARINT) {
+            return -1;
+        }
+        uint8_t byte = in[pos++];
+        delta |= static_cast<uint32_t>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            break;
+        }
+    }
+
+    record.type = static_cast<BusCaptureType>(type);
+    record.port = in[0] & 0x0F;
+    record.deltaMs = delta;
+    record.canId = 0;
+    record.utcMs = 0;
+
+    if (record.type == BusCaptureType::UTC_MARK) {
+        if (size < pos + UTC_PAYLOAD) {
+            return 0;
+        }
+        for (uint8_t i = 0; i < UTC_PAYLOAD; i++) {
+            record.utcMs |= static_cast<uint64_t>(in[pos + i]) << (8 * i);
+        }
+        record.length = UTC_PAYLOAD;
+    } else if (record.type == BusCaptureType::CAN_FRAME) {
+        if (size < pos + 5) {
+            return 0;
+        }
+        record.canId = static_cast<uint32_t>(in[pos]) | (static_cast<uint32_t>(in[pos + 1]) << 8) |
+                       (static_cast<uint32_t>(in[pos + 2]) << 16) |
+                       (static_cast<uint32_t>(in[pos + 3]) << 24);
+        pos += 4;
+        record.length = in[pos++];
+        if (record.length > 8) {
+            return -1;
+        }
+    } else {
+        if (size < pos + 1) {
+            return 0;
+        }
+        record.length = in[pos++];
+        if (record.length > BUS_CAPTURE_MAX_LINE) {
+            return -1;
+        }
+    }
+
+    if (size < pos + record.length) {
+        return 0;
+    }
+    record.data = in + pos;
+    return static_cast<int32_t>(pos + record.length);
+}
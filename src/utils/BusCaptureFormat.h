@@ -0,0 +1,120 @@
+/**
+ * @file BusCaptureFormat.h
+ * @brief Compact binary record format of raw bus captures (NMEA 0183 + NMEA 2000)
+ *
+ * A capture file is an 8-byte header followed by variable-length records in
+ * arrival order:
+ *
+ * | Field   | Size   | Content                                             |
+ * |---------|--------|-----------------------------------------------------|
+ * | tag     | 1      | high nibble = record type, low nibble = port index  |
+ * | delta   | 1..5   | ms since the previous record (LEB128 varint)        |
+ * | payload |        | type NMEA0183: length (1) + sentence bytes          |
+ * |         |        | type CAN: 29-bit id (4, little endian) + dlc (1) + data |
+ * |         |        | type UTC: UTC ms since 1970 (8, little endian)      |
+ *
+ * A 1 Hz RMC costs ~70 bytes per record and a CAN frame at most 15, so an
+ * hour of a typical bus fits in a few MB. Deltas keep the timing needed for
+ * real-time replay without an absolute clock.
+ *
+ * Version 2 adds the UTC mark: the UtcClock time of the record's position in
+ * the stream, written when a capture starts with the clock synced and after
+ * every clock step. The summed deltas after the last mark give the UTC of any
+ * record. Readers of version 1 files never see one; replay skips them.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * uint8_t buf[BUS_CAPTURE_MAX_RECORD];
+ * size_t n = BusCaptureEncodeFrame(buf, sizeof(buf), 3, 0x09F80102UL, 8, data);
+ *
+ * BusCaptureRecord rec;
+ * int32_t used = BusCaptureDecode(buf, n, rec);   // > 0: record decoded
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef BUS_CAPTURE_FORMAT_H
+#define BUS_CAPTURE_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/// File header: "P2CP", format version, 3 reserved bytes
+#define BUS_CAPTURE_HEADER_SIZE 8
+#define BUS_CAPTURE_VERSION 2   ///< 2: UTC marks; version 1 files are still read
+
+/// Longest NMEA 0183 line stored (matches NMEA0183_MAX_LINE)
+#define BUS_CAPTURE_MAX_LINE 128
+
+/// Largest encoded record (tag + 5-byte delta + length + longest line)
+#define BUS_CAPTURE_MAX_RECORD (1 + 5 + 1 + BUS_CAPTURE_MAX_LINE)
+
+/**
+ * @brief Record types (tag high nibble)
+ */
+enum class BusCaptureType : uint8_t {
+    NMEA0183_LINE = 1,   ///< One raw sentence as received (checksum not verified)
+    CAN_FRAME = 2,       ///< One raw NMEA 2000 CAN frame
+    UTC_MARK = 3         ///< UTC of this point in the stream (version 2)
+};
+
+/**
+ * @brief One decoded record; data points into the caller's buffer
+ */
+struct BusCaptureRecord {
+    BusCaptureType type;
+    uint8_t port;          ///< NMEA 0183 input port index (0 for CAN)
+    uint32_t deltaMs;      ///< Time since the previous record
+    uint32_t canId;        ///< CAN frame identifier (CAN_FRAME only)
+    uint64_t utcMs;        ///< UTC ms since 1970 (UTC_MARK only)
+    uint8_t length;        ///< Sentence length, CAN data length or 8 (UTC_MARK)
+    const uint8_t* data;
+};
+
+/**
+ * @brief Write the file header
+ * @return BUS_CAPTURE_HEADER_SIZE, 0 if @p size is too small
+ */
+size_t BusCaptureWriteHeader(uint8_t* out, size_t size);
+
+/**
+ * @brief Whether @p in starts with a supported file header (version 1 to BUS_CAPTURE_VERSION)
+ */
+bool BusCaptureCheckHeader(const uint8_t* in, size_t size);
+
+/**
+ * @brief Encode one NMEA 0183 line record
+ *
+ * @param port Input port index (0-15)
+ * @return Encoded length, 0 if it does not fit, the port is > 15 or the line
+ *         is longer than BUS_CAPTURE_MAX_LINE
+ */
+size_t BusCaptureEncodeLine(uint8_t* out, size_t size, uint32_t deltaMs, uint8_t port,
+                            const char* line, size_t length);
+
+/**
+ * @brief Encode one CAN frame record
+ * @return Encoded length, 0 if it does not fit or @p length > 8
+ */
+size_t BusCaptureEncodeFrame(uint8_t* out, size_t size, uint32_t deltaMs, uint32_t id,
+                             uint8_t length, const uint8_t* data);
+
+/**
+ * @brief Encode one UTC mark record
+ * @return Encoded length, 0 if it does not fit
+ */
+size_t BusCaptureEncodeUtc(uint8_t* out, size_t size, uint32_t deltaMs, uint64_t utcMs);
+
+/**
+ * @brief Decode the record at the start of @p in
+ *
+ * @return Bytes consumed (> 0), 0 if the record is incomplete (read more),
+ *         -1 if the data is corrupt
+ */
+int32_t BusCaptureDecode(const uint8_t* in, size_t size, BusCaptureRecord& record);
+
+#endif // BUS_CAPTURE_FORMAT_H
@@ -0,0 +1,362 @@
+/**
+ * @file CalcBatchInput.cpp
+ * @brief Implementation of the recorded input decoder
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "CalcBatchInput.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "NMEA0183Tokenizer.h"
+#include "NMEA0183SentenceKey.h"
+#include "../config.h"
+
+namespace {
+
+const double MPS_TO_KNOTS = 1.9438444924406047516198704103672;
+const double DEG_TO_RAD_D = 0.017453292519943295;
+const double TWO_PI_D = 6.283185307179586;
+
+// NMEA 2000 field encodings (little endian, all-ones / max positive = not available)
+inline uint16_t u16(const uint8_t* d) {
+    return static_cast<uint16_t>(d[0] | (d[1] << 8));
+}
+
+inline int16_t i16(const uint8_t* d) {
+    return static_cast<int16_t>(u16(d));
+}
+
+inline int32_t i32(const uint8_t* d) {
+    return static_cast<int32_t>(static_cast<uint32_t>(d[0]) | (static_cast<uint32_t>(d[1]) << 8) |
+                                (static_cast<uint32_t>(d[2]) << 16) | (static_cast<uint32_t>(d[3]) << 24));
+}
+
+inline bool naU16(uint16_t v) { return v >= 0xFFFD; }    // NA, out of range, reserved
+inline bool naI16(int16_t v) { return v >= 0x7FFD; }
+inline bool naI32(int32_t v) { return v >= 0x7FFFFFFD; }
+
+/// AWA as the 130306 handler stores it, [-π, π]
+inline double wrapWindAngle(double angle) {
+    while (angle < -M_PI) angle += TWO_PI_D;
+    while (angle > M_PI) angle -= TWO_PI_D;
+    return angle;
+}
+
+/// A field that may be empty (value unchanged) but must be numeric if present
+inline bool optionalDouble(const NMEA0183Field& field, double& value) {
+    return field.empty() || NMEA0183FieldToDouble(field, value);
+}
+
+void stampGroups(uint16_t groups, uint32_t nowMs, BoatDataStructure& boat) {
+    if (groups & BoatDataGroup::GPS) {
+        boat.gps.available = true;
+        boat.gps.lastUpdate = nowMs;
+    }
+    if (groups & BoatDataGroup::COMPASS) {
+        boat.compass.available = true;
+        boat.compass.lastUpdate = nowMs;
+    }
+    if (groups & BoatDataGroup::WIND) {
+        boat.wind.available = true;
+        boat.wind.lastUpdate = nowMs;
+    }
+    if (groups & BoatDataGroup::DST) {
+        boat.dst.available = true;
+        boat.dst.lastUpdate = nowMs;
+    }
+}
+
+inline void expire(bool& available, unsigned long lastUpdate, uint32_t nowMs, uint32_t timeoutMs) {
+    if (timeoutMs != 0 && available && nowMs - static_cast<uint32_t>(lastUpdate) > timeoutMs) {
+        available = false;
+    }
+}
+
+}  // namespace
+
+CalcBatchInput::CalcBatchInput() : columnCount_(0) {
+    for (uint8_t i = 0; i < CALC_BATCH_MAX_COLUMNS; i++) {
+        columns_[i] = COL_IGNORED;
+    }
+}
+
+uint32_t CalcBatchInput::pgnOf(uint32_t canId) {
+    uint32_t pgn = (canId >> 8) & 0x3FFFF;
+    if (((pgn >> 8) & 0xFF) < 240) {
+        pgn &= 0x3FF00;  // PDU1: low byte is the destination address
+    }
+    return pgn;
+}
+
+// =============================================================================
+// NMEA 2000
+// =============================================================================
+
+uint16_t CalcBatchInput::applyFrame(uint32_t canId, const uint8_t* d, uint8_t length,
+                                    uint32_t nowMs, BoatDataStructure& boat) const {
+    if (d == nullptr || length < 8) {
+        return 0;  // Every decoded PGN is a full single frame
+    }
+
+    uint16_t groups = 0;
+    switch (pgnOf(canId)) {
+        case 130306: {  // Wind Data: SID, speed 0.01 m/s, angle 1e-4 rad, reference
+            uint16_t speed = u16(d + 1);
+            uint16_t angle = u16(d + 3);
+            if ((d[5] & 0x07) != 2 || naU16(speed) || naU16(angle)) {
+                break;  // Apparent wind only, as HandleN2kPGN130306
+            }
+            boat.wind.apparentWindAngle = wrapWindAngle(angle * 1e-4);
+            boat.wind.apparentWindSpeed = speed * 0.01 * MPS_TO_KNOTS;
+            groups = BoatDataGroup::WIND;
+            break;
+        }
+        case 127250: {  // Vessel Heading: SID, heading, deviation, variation, reference
+            uint16_t heading = u16(d + 1);
+            if (naU16(heading)) {
+                break;
+            }
+            if ((d[7] & 0x03) == 1) {
+                boat.compass.magneticHeading = heading * 1e-4;
+            } else if ((d[7] & 0x03) == 0) {
+                boat.compass.trueHeading = heading * 1e-4;
+            } else {
+                break;
+            }
+            groups = BoatDataGroup::COMPASS;
+            break;
+        }
+        case 127257: {  // Attitude: SID, yaw, pitch, roll (roll = heel)
+            int16_t pitch = i16(d + 3);
+            int16_t roll = i16(d + 5);
+            if (!naI16(pitch)) {
+                boat.compass.pitchAngle = pitch * 1e-4;
+                groups = BoatDataGroup::COMPASS;
+            }
+            if (!naI16(roll)) {
+                boat.compass.heelAngle = roll * 1e-4;
+                groups = BoatDataGroup::COMPASS;
+            }
+            break;
+        }
+        case 128259: {  // Speed: SID, water referenced 0.01 m/s (stored in m/s)
+            uint16_t speed = u16(d + 1);
+            if (naU16(speed)) {
+                break;
+            }
+            boat.dst.measuredBoatSpeed = speed * 0.01;
+            groups = BoatDataGroup::DST;
+            break;
+        }
+        case 129026: {  // COG & SOG Rapid: SID, reference, COG 1e-4 rad, SOG 0.01 m/s
+            uint16_t cog = u16(d + 2);
+            uint16_t sog = u16(d + 4);
+            if (naU16(cog) || naU16(sog)) {
+                break;
+            }
+            boat.gps.cog = cog * 1e-4;
+            boat.gps.sog = sog * 0.01 * MPS_TO_KNOTS;
+            groups = BoatDataGroup::GPS;
+            break;
+        }
+        case 127258: {  // Magnetic Variation: SID, source, days, variation 1e-4 rad
+            int16_t variation = i16(d + 4);
+            if (naI16(variation)) {
+                break;
+            }
+            boat.gps.variation = variation * 1e-4;
+            groups = BoatDataGroup::GPS;
+            break;
+        }
+        case 129025: {  // Position Rapid: lat, lon 1e-7 deg
+            int32_t lat = i32(d);
+            int32_t lon = i32(d + 4);
+            if (naI32(lat) || naI32(lon)) {
+                break;
+            }
+            boat.gps.latitude = lat * 1e-7;
+            boat.gps.longitude = lon * 1e-7;
+            groups = BoatDataGroup::GPS;
+            break;
+        }
+        default:
+            break;
+    }
+
+    stampGroups(groups, nowMs, boat);
+    return groups;
+}
+
+// =============================================================================
+// NMEA 0183
+// =============================================================================
+
+uint16_t CalcBatchInput::applyLine(const char* line, size_t length, uint32_t nowMs,
+                                   BoatDataStructure& boat) const {
+    NMEA0183Tokens tokens;
+    if (line == nullptr || !tokens.tokenize(line, length)) {
+        return 0;
+    }
+
+    uint16_t groups = 0;
+    double a, b, c, lat, lon;
+    switch (tokens.code()) {
+        case NMEA0183PackCode("HDM"):
+            if (NMEA0183FieldToDouble(tokens.field(0), a)) {
+                boat.compass.magneticHeading = a * DEG_TO_RAD_D;
+                groups = BoatDataGroup::COMPASS;
+            }
+            break;
+        case NMEA0183PackCode("RMC"):
+            // Position and status as NMEA0183ParseRMC; empty COG/SOG/variation keep the last value
+            a = boat.gps.sog;
+            b = boat.gps.cog / DEG_TO_RAD_D;
+            c = boat.gps.variation / DEG_TO_RAD_D;
+            if (tokens.fieldCount() >= 11 && tokens.field(1).is('A') &&
+                NMEA0183FieldToCoordinate(tokens.field(2), tokens.field(3), lat) &&
+                NMEA0183FieldToCoordinate(tokens.field(4), tokens.field(5), lon) &&
+                optionalDouble(tokens.field(6), a) && optionalDouble(tokens.field(7), b) &&
+                optionalDouble(tokens.field(9), c)) {
+                if (!tokens.field(9).empty() && tokens.field(10).is('W')) {
+                    c = -c;
+                }
+                boat.gps.latitude = lat;
+                boat.gps.longitude = lon;
+                boat.gps.sog = a;
+                boat.gps.cog = b * DEG_TO_RAD_D;
+                boat.gps.variation = c * DEG_TO_RAD_D;
+                groups = BoatDataGroup::GPS;
+            }
+            break;
+        case NMEA0183PackCode("VTG"):
+            if (tokens.fieldCount() >= 5 && NMEA0183FieldToDouble(tokens.field(0), a) &&
+                NMEA0183FieldToDouble(tokens.field(4), b)) {
+                boat.gps.cog = a * DEG_TO_RAD_D;
+                boat.gps.sog = b;
+                groups = BoatDataGroup::GPS;
+            }
+            break;
+        default:
+            break;
+    }
+
+    stampGroups(groups, nowMs, boat);
+    return groups;
+}
+
+// =============================================================================
+// CSV
+// =============================================================================
+
+bool CalcBatchInput::setCsvHeader(const char* line) {
+    static const struct {
+        const char* name;
+        Column column;
+    } NAMES[] = {
+        {"time_ms", COL_TIME}, {"awa_deg", COL_AWA}, {"aws_kn", COL_AWS},
+        {"boat_speed_ms", COL_BOAT_SPEED}, {"heading_deg", COL_HEADING}, {"heel_deg", COL_HEEL},
+        {"cog_deg", COL_COG}, {"sog_kn", COL_SOG}, {"variation_deg", COL_VARIATION},
+    };
+
+    columnCount_ = 0;
+    bool hasTime = false;
+    const char* p = line;
+    while (p != nullptr && *p != '\0' && *p != '\r' && *p != '\n' && columnCount_ < CALC_BATCH_MAX_COLUMNS) {
+        size_t len = strcspn(p, ",\r\n");
+        Column column = COL_IGNORED;
+        for (size_t i = 0; i < sizeof(NAMES) / sizeof(NAMES[0]); i++) {
+            if (strlen(NAMES[i].name) == len && strncmp(NAMES[i].name, p, len) == 0) {
+                column = NAMES[i].column;
+            }
+        }
+        hasTime = hasTime || column == COL_TIME;
+        columns_[columnCount_++] = column;
+        p = p[len] == ',' ? p + len + 1 : nullptr;
+    }
+    return hasTime;
+}
+
+uint16_t CalcBatchInput::applyCsvRow(const char* line, BoatDataStructure& boat, uint32_t& nowMs) const {
+    // Parse the whole row before touching boat, so a row without a time changes nothing
+    double values[CALC_BATCH_MAX_COLUMNS];
+    bool present[CALC_BATCH_MAX_COLUMNS];
+    bool hasTime = false;
+    const char* p = line;
+    for (uint8_t i = 0; i < columnCount_; i++) {
+        present[i] = false;
+        if (p == nullptr) {
+            continue;
+        }
+        size_t len = strcspn(p, ",\r\n");
+        if (len > 0 && columns_[i] != COL_IGNORED) {
+            char* end;
+            values[i] = strtod(p, &end);
+            present[i] = end == p + len && isfinite(values[i]);
+        }
+        if (present[i] && columns_[i] == COL_TIME && values[i] >= 0.0) {
+            nowMs = static_cast<uint32_t>(static_cast<uint64_t>(values[i]));
+            hasTime = true;
+        }
+        p = p[len] == ',' ? p + len + 1 : nullptr;
+    }
+    if (!hasTime) {
+        return 0;
+    }
+
+    uint16_t groups = 0;
+    for (uint8_t i = 0; i < columnCount_; i++) {
+        if (!present[i]) {
+            continue;
+        }
+        double v = values[i];
+        switch (columns_[i]) {
+            case COL_AWA:
+                boat.wind.apparentWindAngle = wrapWindAngle(v * DEG_TO_RAD_D);
+                groups |= BoatDataGroup::WIND;
+                break;
+            case COL_AWS:
+                boat.wind.apparentWindSpeed = v;
+                groups |= BoatDataGroup::WIND;
+                break;
+            case COL_BOAT_SPEED:
+                boat.dst.measuredBoatSpeed = v;
+                groups |= BoatDataGroup::DST;
+                break;
+            case COL_HEADING:
+                boat.compass.magneticHeading = v * DEG_TO_RAD_D;
+                groups |= BoatDataGroup::COMPASS;
+                break;
+            case COL_HEEL:
+                boat.compass.heelAngle = v * DEG_TO_RAD_D;
+                groups |= BoatDataGroup::COMPASS;
+                break;
+            case COL_COG:
+                boat.gps.cog = v * DEG_TO_RAD_D;
+                groups |= BoatDataGroup::GPS;
+                break;
+            case COL_SOG:
+                boat.gps.sog = v;
+                groups |= BoatDataGroup::GPS;
+                break;
+            case COL_VARIATION:
+                boat.gps.variation = v * DEG_TO_RAD_D;
+                groups |= BoatDataGroup::GPS;
+                break;
+            default:
+                break;
+        }
+    }
+
+    stampGroups(groups, nowMs, boat);
+    return groups;
+}
+
+void CalcBatchInput::expireStale(BoatDataStructure& boat, uint32_t nowMs) {
+    expire(boat.gps.available, boat.gps.lastUpdate, nowMs, BOATDATA_STALE_GPS_MS);
+    expire(boat.compass.available, boat.compass.lastUpdate, nowMs, BOATDATA_STALE_COMPASS_MS);
+    expire(boat.wind.available, boat.wind.lastUpdate, nowMs, BOATDATA_STALE_WIND_MS);
+    expire(boat.dst.available, boat.dst.lastUpdate, nowMs, BOATDATA_STALE_DST_MS);
+}
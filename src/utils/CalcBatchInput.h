@@ -0,0 +1,119 @@
+/**
+ * @file CalcBatchInput.h
+ * @brief Recorded calculation inputs (bus capture or CSV) decoded into BoatDataStructure
+ *
+ * Input side of the offline calculation runner (tools/calc_batch): every
+ * record updates the BoatData fields the calculation reads, in the units
+ * and conventions the live handlers store, stamped with the record time.
+ * CalculationEngine then runs on the result exactly as on the device.
+ *
+ * Bus capture records (BusCaptureFormat):
+ * - NMEA 2000 single-frame PGNs: 130306 (apparent wind only), 127250
+ *   (magnetic heading; true heading is kept but not used), 127257 (heel),
+ *   128259 (boat speed, m/s), 129026 (COG/SOG), 127258 (variation),
+ *   129025 (position). Fast-packet PGNs need reassembly and are skipped.
+ * - NMEA 0183 lines: HDM, RMC and VTG (checksum validated)
+ *
+ * CSV: a header row naming the columns present, then one row per time step
+ * (all listed inputs sampled together). Columns, in any order:
+ * time_ms (required), awa_deg, aws_kn, boat_speed_ms, heading_deg,
+ * heel_deg, cog_deg, sog_kn, variation_deg. Unknown columns are ignored;
+ * an empty cell leaves the value unchanged.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CALC_BATCH_INPUT_H
+#define CALC_BATCH_INPUT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../types/BoatDataTypes.h"
+#include "BoatDataChangeTracker.h"
+
+/// CSV columns recognised in the header row
+#define CALC_BATCH_MAX_COLUMNS 24
+
+/// BoatDataGroup bits of the groups CalculationEngine requires
+#define CALC_BATCH_REQUIRED_GROUPS (BoatDataGroup::GPS | BoatDataGroup::COMPASS | \
+                                    BoatDataGroup::WIND | BoatDataGroup::DST)
+
+/**
+ * @class CalcBatchInput
+ * @brief Stateless-per-record decoder of recorded inputs
+ *
+ * Usage:
+ * @code
+ * CalcBatchInput input;
+ * BoatDataStructure data;   // memset 0, calibration set
+ * uint16_t changed = input.applyFrame(rec.canId, rec.data, rec.length, nowMs, data);
+ * if (changed != 0) { CalcBatchInput::expireStale(data, nowMs); engine.calculate(&data, nowMs); }
+ * @endcode
+ */
+class CalcBatchInput {
+public:
+    CalcBatchInput();
+
+    /**
+     * @brief Decode one NMEA 2000 CAN frame received at @p nowMs
+     *
+     * @param canId 29-bit CAN identifier
+     * @return BoatDataGroup bits updated (0 = PGN not used or not available)
+     */
+    uint16_t applyFrame(uint32_t canId, const uint8_t* data, uint8_t length,
+                        uint32_t nowMs, BoatDataStructure& boat) const;
+
+    /**
+     * @brief Decode one raw NMEA 0183 sentence received at @p nowMs
+     *
+     * @return BoatDataGroup bits updated (0 = sentence not used or invalid)
+     */
+    uint16_t applyLine(const char* line, size_t length, uint32_t nowMs, BoatDataStructure& boat) const;
+
+    /**
+     * @brief Read the CSV header row
+     *
+     * @return false without a time_ms column
+     */
+    bool setCsvHeader(const char* line);
+
+    /**
+     * @brief Decode one CSV data row
+     *
+     * @param nowMs Output: the row's time_ms
+     * @return BoatDataGroup bits updated, 0 for a row without a valid time_ms
+     */
+    uint16_t applyCsvRow(const char* line, BoatDataStructure& boat, uint32_t& nowMs) const;
+
+    /**
+     * @brief Mark groups unavailable after BOATDATA_STALE_<GROUP>_MS without an update
+     *
+     * The live sweeper (BoatData::sweepStale()) on the log clock.
+     */
+    static void expireStale(BoatDataStructure& boat, uint32_t nowMs);
+
+    /// PGN of a 29-bit NMEA 2000 CAN identifier (PDU1 destination removed)
+    static uint32_t pgnOf(uint32_t canId);
+
+private:
+    enum Column : uint8_t {
+        COL_IGNORED = 0,
+        COL_TIME,
+        COL_AWA,
+        COL_AWS,
+        COL_BOAT_SPEED,
+        COL_HEADING,
+        COL_HEEL,
+        COL_COG,
+        COL_SOG,
+        COL_VARIATION
+    };
+
+    Column columns_[CALC_BATCH_MAX_COLUMNS];
+    uint8_t columnCount_;
+};
+
+#endif // CALC_BATCH_INPUT_H
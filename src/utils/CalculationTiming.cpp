@@ -0,0 +1,70 @@
+/**
+ * @file CalculationTiming.cpp
+ * @brief Implementation of the calculation cycle timing statistics
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "CalculationTiming.h"
+
+CalculationTiming::CalculationTiming(uint32_t deadlineUs)
+    : deadlineUs_(deadlineUs), misses_(0), lastStartUs_(0), lastPeriodUs_(0), hasStart_(false),
+      resetRequested_(false) {
+}
+
+bool CalculationTiming::record(uint32_t startUs, uint32_t durationUs) {
+    if (resetRequested_) {
+        resetRequested_ = false;
+        durations_.reset();
+        periods_.reset();
+        jitter_.reset();
+        misses_ = 0;
+        lastPeriodUs_ = 0;  // The period across the reset still counts; jitter restarts
+    }
+
+    durations_.record(durationUs);
+
+    if (hasStart_) {
+        uint32_t period = startUs - lastStartUs_;
+        periods_.record(period);
+        if (lastPeriodUs_ != 0) {
+            jitter_.record(period > lastPeriodUs_ ? period - lastPeriodUs_ : lastPeriodUs_ - period);
+        }
+        lastPeriodUs_ = period;
+    }
+    hasStart_ = true;
+    lastStartUs_ = startUs;
+
+    bool missed = durationUs > deadlineUs_;
+    if (missed) {
+        misses_++;
+    }
+    return missed;
+}
+
+void CalculationTiming::writeHistogram(JsonWriter& json, const char* key, const LatencyHistogram& histogram) {
+    json.beginObject(key)
+        .add("n", (unsigned long)histogram.getCount())
+        .add("min_us", (unsigned long)histogram.getMin())
+        .add("avg_us", (unsigned long)histogram.getAverage())
+        .add("p50_us", (unsigned long)histogram.getPercentile(50))
+        .add("p95_us", (unsigned long)histogram.getPercentile(95))
+        .add("p99_us", (unsigned long)histogram.getPercentile(99))
+        .add("max_us", (unsigned long)histogram.getMax())
+        .endObject();
+}
+
+bool CalculationTiming::writeStats(JsonWriter& json) const {
+    uint32_t cycles = getCycles();
+    json.beginObject()
+        .add("deadline_us", (unsigned long)deadlineUs_)
+        .add("cycles", (unsigned long)cycles)
+        .add("deadline_misses", (unsigned long)misses_)
+        .add("miss_pct", cycles > 0 ? 100.0 * misses_ / cycles : 0.0);
+    writeHistogram(json, "duration", durations_);
+    writeHistogram(json, "period", periods_);
+    writeHistogram(json, "jitter", jitter_);
+    json.endObject();
+    return !json.overflowed();
+}
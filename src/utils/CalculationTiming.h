@@ -0,0 +1,93 @@
+/**
+ * @file CalculationTiming.h
+ * @brief Period, jitter and execution time of the calculation cycle
+ *
+ * calculateDerivedParameters() passes the start and duration of every cycle
+ * to record(), which keeps three LatencyHistograms:
+ * - duration: execution time of CalculationEngine::calculate()
+ * - period: start-to-start time of consecutive cycles (CALC_MIN_INTERVAL_MS
+ *   while inputs change, up to CALC_MAX_INTERVAL_MS without)
+ * - jitter: difference between consecutive periods, |P(n) - P(n-1)|
+ * and counts the cycles longer than CALC_DEADLINE_US as deadline misses.
+ *
+ * Statistics run from boot until requestReset(); the next record() (on the
+ * main loop) performs the reset, so the web server never writes them.
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): ~0.6 KB static (three 42-bucket histograms)
+ * - Principle V (Network Debugging): GET /calc/stats and CALC_TIMING log events
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CALCULATION_TIMING_H
+#define CALCULATION_TIMING_H
+
+#include <stdint.h>
+#include "LatencyHistogram.h"
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @class CalculationTiming
+ * @brief Calculation cycle timing (single writer: the main loop)
+ */
+class CalculationTiming {
+public:
+    /**
+     * @param deadlineUs Execution budget per cycle
+     */
+    explicit CalculationTiming(uint32_t deadlineUs = CALC_DEADLINE_US);
+
+    /**
+     * @brief Account one cycle
+     *
+     * @param startUs micros() at the start of the cycle
+     * @param durationUs Execution time of the cycle
+     * @return true if the cycle missed the deadline
+     */
+    bool record(uint32_t startUs, uint32_t durationUs);
+
+    /**
+     * @brief Clear the statistics before the next record() (any context)
+     */
+    void requestReset() { resetRequested_ = true; }
+
+    const LatencyHistogram& getDurations() const { return durations_; }
+    const LatencyHistogram& getPeriods() const { return periods_; }
+    const LatencyHistogram& getJitter() const { return jitter_; }
+
+    uint32_t getDeadlineUs() const { return deadlineUs_; }
+    uint32_t getCycles() const { return durations_.getCount(); }
+    uint32_t getDeadlineMisses() const { return misses_; }
+
+    /// Start-to-start time of the last two cycles in µs (0 before the second cycle)
+    uint32_t getLastPeriodUs() const { return lastPeriodUs_; }
+
+    /**
+     * @brief Write {"deadline_us", "cycles", "deadline_misses", "miss_pct",
+     *        "duration": {...}, "period": {...}, "jitter": {...}}
+     *
+     * Each histogram is {"n", "min_us", "avg_us", "p50_us", "p95_us", "p99_us", "max_us"}.
+     *
+     * @return false if @p json overflowed
+     */
+    bool writeStats(JsonWriter& json) const;
+
+private:
+    LatencyHistogram durations_;
+    LatencyHistogram periods_;
+    LatencyHistogram jitter_;
+    uint32_t deadlineUs_;
+    uint32_t misses_;
+    uint32_t lastStartUs_;
+    uint32_t lastPeriodUs_;
+    bool hasStart_;
+    volatile bool resetRequested_;
+
+    static void writeHistogram(JsonWriter& json, const char* key, const LatencyHistogram& histogram);
+};
+
+#endif // CALCULATION_TIMING_H
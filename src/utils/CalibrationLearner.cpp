@@ -0,0 +1,229 @@
+/**
+ * @file CalibrationLearner.cpp
+ * @brief Implementation of the wind offset and leeway K estimators
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "CalibrationLearner.h"
+#include <cmath>
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+constexpr double RADIANS_PER_DEGREE = M_PI / 180.0;
+
+/// @p angle wrapped to [-π, π]
+double wrap(double angle) {
+    return atan2(sin(angle), cos(angle));
+}
+
+uint16_t samplesOf(double count) {
+    return count >= 65535.0 ? 65535 : static_cast<uint16_t>(count);
+}
+
+}  // namespace
+
+CalibrationLearner::CalibrationLearner() : resetRequested_(false) {
+    lock_.seq = 0;
+    reset();
+    propose(published_);
+}
+
+void CalibrationLearner::reset() {
+    memset(tacks_, 0, sizeof(tacks_));
+    memset(&leeway_, 0, sizeof(leeway_));
+    tack_ = 0;
+    tackChangeMs_ = 0;
+    samples_ = 0;
+    accepted_ = 0;
+}
+
+bool CalibrationLearner::add(const WindData& wind, const CompassData& compass, const GPSData& gps,
+                             const DSTData& dst, const DerivedData& derived, uint32_t nowMs) {
+    if (resetRequested_.exchange(false, std::memory_order_relaxed)) {
+        reset();
+    }
+    samples_++;
+
+    if (!wind.available || !compass.available || !gps.available || !dst.available ||
+        !std::isfinite(static_cast<double>(derived.awaOffset)) ||
+        !std::isfinite(static_cast<double>(dst.measuredBoatSpeed)) ||
+        dst.measuredBoatSpeed < CALIB_LEARN_MIN_SPEED) {
+        return false;
+    }
+
+    double awaOffset = derived.awaOffset;
+    if (!settled(awaOffset, nowMs)) {
+        return false;
+    }
+
+    bool used = addWind(wind.apparentWindAngle, awaOffset, derived.wdir);
+    used |= addLeeway(compass, gps, dst, derived);
+    if (used) {
+        accepted_++;
+    }
+    return used;
+}
+
+bool CalibrationLearner::settled(double awa, uint32_t nowMs) {
+    int8_t tack = awa < 0.0 ? -1 : 1;
+    if (tack != tack_) {
+        // Tack or gybe (or the first sample): wait for the boat to settle
+        tack_ = tack;
+        tackChangeMs_ = nowMs;
+        return false;
+    }
+    return nowMs - tackChangeMs_ >= CALIB_LEARN_SETTLE_MS;
+}
+
+bool CalibrationLearner::addWind(double awa, double awaOffset, double twd) {
+    double side = fabs(awaOffset);
+    if (side < CALIB_LEARN_MIN_AWA_DEG * RADIANS_PER_DEGREE || side > CALIB_LEARN_MAX_AWA_DEG * RADIANS_PER_DEGREE ||
+        !std::isfinite(awa) || !std::isfinite(twd)) {
+        return false;
+    }
+
+    TackSums& sums = tacks_[awaOffset < 0.0 ? 0 : 1];
+    if (sums.count >= CALIB_LEARN_WINDOW) {
+        halve(sums);
+    }
+    sums.count += 1.0;
+    sums.sinAwa += sin(awa);
+    sums.cosAwa += cos(awa);
+    sums.sinTwd += sin(twd);
+    sums.cosTwd += cos(twd);
+    return true;
+}
+
+bool CalibrationLearner::addLeeway(const CompassData& compass, const GPSData& gps, const DSTData& dst,
+                                   const DerivedData& derived) {
+    double heel = compass.heelAngle;
+    double boatSpeed = dst.measuredBoatSpeed;
+    double awa = derived.awaOffset;
+
+    // The engine computes no leeway with wind and heel on the same side
+    if (!std::isfinite(heel) || fabs(heel) < CALIB_LEARN_MIN_HEEL_DEG * RADIANS_PER_DEGREE || heel * awa >= 0.0) {
+        return false;
+    }
+    double sog = gps.sog;
+    double stw = derived.stw;
+    if (!std::isfinite(sog) || !std::isfinite(stw) || fabs(sog - stw) > CALIB_LEARN_MAX_SPEED_DIFF) {
+        return false;
+    }
+
+    // Same frame as CalculationEngine::stageCurrent(): magnetic COG against magnetic heading
+    double observed = wrap(gps.cog + gps.variation - compass.magneticHeading);
+    if (!std::isfinite(observed) || fabs(observed) > CALIB_LEARN_MAX_LEEWAY_DEG * RADIANS_PER_DEGREE) {
+        return false;
+    }
+
+    RegressionSums& sums = leeway_;
+    if (sums.count >= CALIB_LEARN_WINDOW) {
+        halve(sums);
+    }
+    double x = heel / (boatSpeed * boatSpeed);
+    sums.count += 1.0;
+    if (heel < 0.0) {
+        sums.portCount += 1.0;
+    }
+    sums.x += x;
+    sums.y += observed;
+    sums.xx += x * x;
+    sums.xy += x * observed;
+    sums.yy += observed * observed;
+    return true;
+}
+
+void CalibrationLearner::halve(TackSums& sums) {
+    sums.count *= 0.5;
+    sums.sinAwa *= 0.5;
+    sums.cosAwa *= 0.5;
+    sums.sinTwd *= 0.5;
+    sums.cosTwd *= 0.5;
+}
+
+void CalibrationLearner::halve(RegressionSums& sums) {
+    sums.count *= 0.5;
+    sums.portCount *= 0.5;
+    sums.x *= 0.5;
+    sums.y *= 0.5;
+    sums.xx *= 0.5;
+    sums.xy *= 0.5;
+    sums.yy *= 0.5;
+}
+
+void CalibrationLearner::propose(CalibrationProposal& out) const {
+    memset(&out, 0, sizeof(out));
+    out.samples = samples_;
+    out.accepted = accepted_;
+
+    // Wind offset: the corrected AWA of the two tacks should mirror each other
+    const TackSums& port = tacks_[0];
+    const TackSums& starboard = tacks_[1];
+    out.portSamples = samplesOf(port.count);
+    out.starboardSamples = samplesOf(starboard.count);
+    out.windAngleOffset = NAN;
+    out.twdSplit = NAN;
+    if (port.count > 0.0 && starboard.count > 0.0) {
+        double meanPort = atan2(port.sinAwa, port.cosAwa);
+        double meanStarboard = atan2(starboard.sinAwa, starboard.cosAwa);
+        double asymmetry = wrap(meanStarboard + meanPort);   // 0 when mirrored
+        out.windAngleOffset = -0.5 * asymmetry;
+        out.twdSplit = wrap(atan2(starboard.sinTwd, starboard.cosTwd) - atan2(port.sinTwd, port.cosTwd));
+        out.windOffsetReady = port.count >= CALIB_LEARN_MIN_SAMPLES &&
+                              starboard.count >= CALIB_LEARN_MIN_SAMPLES &&
+                              fabs(out.twdSplit) <= CALIB_LEARN_MAX_TWD_SPLIT_DEG * RADIANS_PER_DEGREE &&
+                              fabs(out.windAngleOffset) <= CALIB_LEARN_MAX_OFFSET_DEG * RADIANS_PER_DEGREE;
+    }
+
+    // Leeway K: slope of the least squares line, intercept = current
+    const RegressionSums& s = leeway_;
+    out.portHeelSamples = samplesOf(s.portCount);
+    out.starboardHeelSamples = samplesOf(s.count - s.portCount);
+    out.leewayK = NAN;
+    out.leewayFit = 0.0;
+    out.leewayCurrent = NAN;
+    if (s.count >= 2.0) {
+        double sxx = s.xx - s.x * s.x / s.count;
+        double sxy = s.xy - s.x * s.y / s.count;
+        double syy = s.yy - s.y * s.y / s.count;
+        if (sxx > 0.0) {
+            out.leewayK = sxy / sxx;
+            out.leewayCurrent = (s.y - out.leewayK * s.x) / s.count;
+            out.leewayFit = syy > 0.0 ? (sxy * sxy) / (sxx * syy) : 0.0;
+        }
+        out.leewayReady = std::isfinite(out.leewayK) &&
+                          s.portCount >= CALIB_LEARN_MIN_SAMPLES &&
+                          s.count - s.portCount >= CALIB_LEARN_MIN_SAMPLES &&
+                          out.leewayFit >= CALIB_LEARN_MIN_FIT &&
+                          out.leewayK > 0.0 && out.leewayK <= CALIB_LEARN_MAX_K;
+    }
+}
+
+void CalibrationLearner::publish() {
+    CalibrationProposal proposal;
+    propose(proposal);
+    lock_.writeBegin();
+    published_ = proposal;
+    lock_.writeEnd();
+}
+
+bool CalibrationLearner::readProposal(CalibrationProposal& out) const {
+    return lock_.read(published_, out);
+}
+
+uint8_t CalibrationLearner::changes(const CalibrationProposal& proposal, double windAngleOffset, double leewayK) {
+    uint8_t fields = 0;
+    double offsetChange = fabs(wrap(proposal.windAngleOffset - windAngleOffset));
+    if (proposal.windOffsetReady && offsetChange >= CALIB_LEARN_APPLY_MIN_OFFSET_DEG * RADIANS_PER_DEGREE) {
+        fields |= LearnedField::WIND_OFFSET;
+    }
+    if (proposal.leewayReady &&
+        (leewayK <= 0.0 || fabs(proposal.leewayK - leewayK) >= CALIB_LEARN_APPLY_MIN_K_CHANGE * leewayK)) {
+        fields |= LearnedField::LEEWAY_K;
+    }
+    return fields;
+}
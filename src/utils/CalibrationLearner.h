@@ -0,0 +1,180 @@
+/**
+ * @file CalibrationLearner.h
+ * @brief Background estimation of the wind angle offset and the leeway K factor over tacks
+ *
+ * CalibrationData.windAngleOffset and leewayCalibrationFactor are usually
+ * guessed. The learner samples the raw inputs once per
+ * CALIB_LEARN_INTERVAL_MS (BACKGROUND class, never inside the calculation
+ * cycle), folds each accepted sample into running sums in O(1) and derives
+ * proposals from the sums:
+ *
+ * - Wind angle offset: close-hauled (CALIB_LEARN_MIN/MAX_AWA_DEG), per tack,
+ *   circular sums of the raw AWA and of the TWD. Sailing the same angle on
+ *   both tacks, a misaligned masthead unit reads one tack wider than the
+ *   other, so the proposed offset is minus the circular mean of the port
+ *   and starboard mean AWA. The two tacks' mean TWD must agree within
+ *   CALIB_LEARN_MAX_TWD_SPLIT_DEG: a larger split is a wind shift between
+ *   the tacks, and no offset is proposed until the window has moved on.
+ * - Leeway K: the engine's leeway = K * heel / boatSpeed², so the observed
+ *   leeway (magnetic COG - heading) is regressed on heel / boatSpeed² with
+ *   an intercept. A current adds the same COG offset on both tacks while
+ *   heel changes sign, so the intercept absorbs it once both heel sides
+ *   have CALIB_LEARN_MIN_SAMPLES. Samples with |SOG - STW| above
+ *   CALIB_LEARN_MAX_SPEED_DIFF (strong current) are skipped.
+ *
+ * Samples within CALIB_LEARN_SETTLE_MS of a tack or gybe, below
+ * CALIB_LEARN_MIN_SPEED or with an input unavailable are skipped. Once a
+ * statistic holds CALIB_LEARN_WINDOW samples its sums are halved, so old
+ * conditions fade out with no history kept. Both estimates use the raw AWA,
+ * heading and COG, not the calibrated derived values, so applying a
+ * proposal does not invalidate the sums.
+ *
+ * The main loop writes, any task reads: publish() copies the proposal
+ * behind a SeqLock for GET /api/calibration/learned, and requestReset()
+ * only sets a flag that the next add() takes.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * // Main loop, every CALIB_LEARN_INTERVAL_MS
+ * learner.add(boatData->getWindData(), boatData->getCompassData(), boatData->getGPSData(),
+ *             boatData->getSpeedData(), boatData->getDerivedData(), millis());
+ * learner.publish();
+ *
+ * // HTTP task
+ * CalibrationProposal proposal;
+ * if (learner.readProposal(proposal) && proposal.windOffsetReady) { ... }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): ~250 bytes of sums, zero heap allocation
+ * - Principle VII (Fail-Safe): nothing is proposed without enough samples on both tacks
+ *   and within the plausible range; applying stays opt-in (CALIB_LEARN_AUTO_APPLY)
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CALIBRATION_LEARNER_H
+#define CALIBRATION_LEARNER_H
+
+#include <stdint.h>
+#include <atomic>
+#include "SeqLock.h"
+#include "../types/BoatDataTypes.h"
+#include "../config.h"
+
+/**
+ * @brief Learned calibration values and the statistics behind them
+ */
+struct CalibrationProposal {
+    bool windOffsetReady;          ///< windAngleOffset may be applied
+    double windAngleOffset;        ///< Proposed offset, radians (absolute, not a correction)
+    double twdSplit;               ///< Starboard minus port mean TWD, radians (NaN without both tacks)
+    uint16_t portSamples;          ///< Close-hauled samples per tack
+    uint16_t starboardSamples;
+
+    bool leewayReady;              ///< leewayK may be applied
+    double leewayK;                ///< Regression slope of leeway on heel / boatSpeed² (NaN if singular)
+    double leewayFit;              ///< r² of the regression
+    double leewayCurrent;          ///< Intercept: COG offset of the current, radians
+    uint16_t portHeelSamples;      ///< Leeway samples heeled to port ...
+    uint16_t starboardHeelSamples; ///< ... and to starboard
+
+    uint32_t samples;              ///< add() calls since reset()
+    uint32_t accepted;             ///< Samples folded into at least one statistic
+};
+
+/// CalibrationLearner::changes() bits
+namespace LearnedField {
+    constexpr uint8_t WIND_OFFSET = 1 << 0;
+    constexpr uint8_t LEEWAY_K    = 1 << 1;
+}
+
+/**
+ * @class CalibrationLearner
+ * @brief Running-sum estimators of the masthead offset and leeway K (main loop writer)
+ */
+class CalibrationLearner {
+public:
+    CalibrationLearner();
+
+    /// Forget all samples (main loop)
+    void reset();
+
+    /// Ask the main loop to reset() on its next add() (any task)
+    void requestReset() { resetRequested_.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief Fold one sample of the current inputs into the statistics
+     *
+     * @param derived awaOffset (tack side) and wdir (TWD) of the last cycle
+     * @return true if the sample fed at least one statistic
+     */
+    bool add(const WindData& wind, const CompassData& compass, const GPSData& gps, const DSTData& dst,
+             const DerivedData& derived, uint32_t nowMs);
+
+    /// Proposal from the current sums (main loop)
+    void propose(CalibrationProposal& out) const;
+
+    /// Store propose() for readProposal() (main loop)
+    void publish();
+
+    /**
+     * @brief Last published proposal (any task)
+     * @return false if the writer was busy for every attempt
+     */
+    bool readProposal(CalibrationProposal& out) const;
+
+    /**
+     * @brief Ready fields of @p proposal that differ from @p current by more than the apply thresholds
+     *
+     * (CALIB_LEARN_APPLY_MIN_OFFSET_DEG, CALIB_LEARN_APPLY_MIN_K_CHANGE)
+     *
+     * @return LearnedField bits
+     */
+    static uint8_t changes(const CalibrationProposal& proposal, double windAngleOffset, double leewayK);
+
+private:
+    /// Circular sums of one tack (weights halve with the window)
+    struct TackSums {
+        double count;
+        double sinAwa;
+        double cosAwa;
+        double sinTwd;
+        double cosTwd;
+    };
+
+    /// Least squares sums of leeway on heel / boatSpeed²
+    struct RegressionSums {
+        double count;
+        double portCount;        ///< Samples with heel < 0
+        double x;
+        double y;
+        double xx;
+        double xy;
+        double yy;
+    };
+
+    TackSums tacks_[2];          ///< [0] port (AWA < 0), [1] starboard
+    RegressionSums leeway_;
+    int8_t tack_;                ///< -1 port, +1 starboard, 0 unknown
+    uint32_t tackChangeMs_;
+    uint32_t samples_;
+    uint32_t accepted_;
+
+    SeqLock lock_;
+    CalibrationProposal published_;
+    std::atomic<bool> resetRequested_;
+
+    bool settled(double awa, uint32_t nowMs);
+    bool addWind(double awa, double awaOffset, double twd);
+    bool addLeeway(const CompassData& compass, const GPSData& gps, const DSTData& dst,
+                   const DerivedData& derived);
+
+    static void halve(TackSums& sums);
+    static void halve(RegressionSums& sums);
+};
+
+#endif // CALIBRATION_LEARNER_H
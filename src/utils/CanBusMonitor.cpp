@@ -0,0 +1,162 @@
+/**
+ * @file CanBusMonitor.cpp
+ * @brief Implementation of the bus load windows and controller error state
+ *
+ * @see CanBusMonitor.h
+ */
+
+#include "CanBusMonitor.h"
+#include <string.h>
+
+namespace {
+
+constexpr uint32_t BUCKET_CAPACITY_BITS =
+    static_cast<uint32_t>(CAN_BUS_BITRATE) / 1000 * CAN_BUS_LOAD_BUCKET_MS;
+constexpr uint8_t WARNING_LIMIT = 96;   // SJA1000 default error warning limit (EWLR)
+constexpr uint8_t PASSIVE_LIMIT = 128;
+
+static_assert(CAN_BUS_LOAD_BUCKETS >= 2 && CAN_BUS_LOAD_BUCKETS <= 255, "CAN_BUS_LOAD_BUCKETS out of range");
+static_assert(CAN_BUS_LOAD_SHORT_MS / CAN_BUS_LOAD_BUCKET_MS < CAN_BUS_LOAD_BUCKETS,
+              "Short load window needs more buckets");
+
+uint8_t percentOf(uint32_t bits, uint32_t buckets) {
+    uint64_t pct = static_cast<uint64_t>(bits) * 100 / (static_cast<uint64_t>(buckets) * BUCKET_CAPACITY_BITS);
+    return pct > 100 ? 100 : static_cast<uint8_t>(pct);
+}
+
+}  // namespace
+
+const char* CanBusStateName(CanBusState state) {
+    switch (state) {
+        case CanBusState::ERROR_ACTIVE:  return "active";
+        case CanBusState::ERROR_WARNING: return "warning";
+        case CanBusState::ERROR_PASSIVE: return "passive";
+        case CanBusState::BUS_OFF:       return "bus_off";
+        default:                         return "unknown";
+    }
+}
+
+CanBusMonitor::CanBusMonitor()
+    : currentSlot_(0),
+      frames_(0),
+      peakPercent_(0),
+      state_(CanBusState::ERROR_ACTIVE),
+      txErrors_(0),
+      rxErrors_(0),
+      warnings_(0),
+      passives_(0),
+      busOffs_(0),
+      overruns_(0),
+      lastSampleMs_(0),
+      sampled_(false) {
+    memset(buckets_, 0, sizeof(buckets_));
+}
+
+void CanBusMonitor::noteFrame(uint8_t dlc, uint32_t nowMs) {
+    uint32_t slot = nowMs / CAN_BUS_LOAD_BUCKET_MS;
+    if (slot != currentSlot_) {
+        closeSlot(currentSlot_);
+        currentSlot_ = slot;
+    }
+
+    Bucket& bucket = buckets_[slot % BUCKETS];
+    if (bucket.slot != slot) {
+        bucket.slot = slot;
+        bucket.bits = 0;
+    }
+    bucket.bits += CanFrameBits(dlc);
+    frames_++;
+}
+
+void CanBusMonitor::closeSlot(uint32_t closedSlot) {
+    constexpr uint32_t SHORT_BUCKETS = CAN_BUS_LOAD_SHORT_MS / CAN_BUS_LOAD_BUCKET_MS;
+    uint32_t first = closedSlot >= SHORT_BUCKETS - 1 ? closedSlot - (SHORT_BUCKETS - 1) : 0;
+    uint8_t pct = percentOf(bitsBetween(first, closedSlot), SHORT_BUCKETS);
+    if (pct > peakPercent_) {
+        peakPercent_ = pct;
+    }
+}
+
+uint32_t CanBusMonitor::bitsBetween(uint32_t firstSlot, uint32_t lastSlot) const {
+    uint32_t bits = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+        const Bucket& bucket = buckets_[i];
+        if (bucket.slot >= firstSlot && bucket.slot <= lastSlot) {
+            bits += bucket.bits;
+        }
+    }
+    return bits;
+}
+
+uint8_t CanBusMonitor::loadPercent(uint32_t nowMs, uint32_t windowMs) const {
+    uint32_t count = windowMs / CAN_BUS_LOAD_BUCKET_MS;
+    if (count == 0) {
+        count = 1;
+    }
+    if (count > BUCKETS - 1) {
+        count = BUCKETS - 1;  // One bucket is always the one still filling
+    }
+
+    uint32_t nowSlot = nowMs / CAN_BUS_LOAD_BUCKET_MS;
+    if (nowSlot == 0) {
+        return 0;
+    }
+    uint32_t first = nowSlot >= count ? nowSlot - count : 0;
+    return percentOf(bitsBetween(first, nowSlot - 1), count);
+}
+
+bool CanBusMonitor::sampleDue(uint32_t nowMs) const {
+    return !sampled_ || nowMs - lastSampleMs_ >= CAN_BUS_SAMPLE_MS;
+}
+
+bool CanBusMonitor::sample(const CanControllerSample& reading, uint32_t nowMs) {
+    lastSampleMs_ = nowMs;
+    sampled_ = true;
+    txErrors_ = reading.txErrors;
+    rxErrors_ = reading.rxErrors;
+
+    CanBusState state = CanBusState::ERROR_ACTIVE;
+    if (reading.busOff) {
+        state = CanBusState::BUS_OFF;
+    } else if (reading.txErrors >= PASSIVE_LIMIT || reading.rxErrors >= PASSIVE_LIMIT) {
+        state = CanBusState::ERROR_PASSIVE;
+    } else if (reading.errorWarning || reading.txErrors >= WARNING_LIMIT || reading.rxErrors >= WARNING_LIMIT) {
+        state = CanBusState::ERROR_WARNING;
+    }
+
+    // Entries into a worse state; recovering and falling back again counts again
+    if (static_cast<uint8_t>(state) > static_cast<uint8_t>(state_)) {
+        switch (state) {
+            case CanBusState::ERROR_WARNING: warnings_++; break;
+            case CanBusState::ERROR_PASSIVE: passives_++; break;
+            case CanBusState::BUS_OFF:       busOffs_++;  break;
+            default: break;
+        }
+    }
+    state_ = state;
+
+    if (reading.overrun) {
+        overruns_++;
+    }
+    return reading.overrun;
+}
+
+void CanBusMonitor::writeJson(JsonWriter& json, uint32_t nowMs, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("load_pct", (unsigned int)loadPercent(nowMs, CAN_BUS_LOAD_SHORT_MS))
+        .add("load_5s_pct", (unsigned int)loadPercent(nowMs, CAN_BUS_LOAD_LONG_MS))
+        .add("peak_pct", (unsigned int)peakPercent_)
+        .add("frames", (unsigned long)frames_)
+        .add("state", CanBusStateName(state_))
+        .add("tec", (unsigned int)txErrors_)
+        .add("rec", (unsigned int)rxErrors_)
+        .add("warnings", (unsigned long)warnings_)
+        .add("passives", (unsigned long)passives_)
+        .add("bus_offs", (unsigned long)busOffs_)
+        .add("overruns", (unsigned long)overruns_)
+        .endObject();
+}
@@ -0,0 +1,149 @@
+/**
+ * @file CanBusMonitor.h
+ * @brief NMEA 2000 bus utilisation over sliding windows and CAN controller error state
+ *
+ * Load: every frame the driver receives or queues for sending adds its bit
+ * length (extended frame, 67 + 8 * DLC bits, stuff bits not counted, the
+ * same model as N2K_LOAD_BITS_PER_FRAME) to a CAN_BUS_LOAD_BUCKET_MS
+ * bucket. A window's load is the bits of its completed buckets against the
+ * bits CAN_BUS_BITRATE could carry in that time. Buckets are stamped with
+ * their time slot, so a silent bus reads 0% without anyone rotating them.
+ *
+ * Error state: sample() classifies the controller's transmit/receive error
+ * counters and status bits (SJA1000 / TWAI fault confinement):
+ * - ERROR_ACTIVE: both counters below the warning limit
+ * - ERROR_WARNING: a counter reached the warning limit (96)
+ * - ERROR_PASSIVE: a counter reached 128 (the node no longer sends active error flags)
+ * - BUS_OFF: transmit errors passed 255, the controller left the bus
+ * Entries into each degraded state and observed RX FIFO overruns are counted.
+ *
+ * Arduino-free (times and register values are passed in, unit tested natively).
+ * noteFrame()/sample(): receive context. Getters: any context, unlocked
+ * (a value may lag by one frame).
+ *
+ * Usage:
+ * @code
+ * monitor.noteFrame(len, millis());                               // CANGetFrame / CANSendFrame
+ * if (monitor.sampleDue(now)) monitor.sample(readController(), now);
+ * uint8_t pct = monitor.loadPercent(now, CAN_BUS_LOAD_SHORT_MS);  // main loop
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CAN_BUS_MONITOR_H
+#define CAN_BUS_MONITOR_H
+
+#include <stdint.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief CAN fault confinement state
+ */
+enum class CanBusState : uint8_t {
+    ERROR_ACTIVE = 0,
+    ERROR_WARNING = 1,
+    ERROR_PASSIVE = 2,
+    BUS_OFF = 3
+};
+
+/// "active", "warning", "passive", "bus_off"
+const char* CanBusStateName(CanBusState state);
+
+/// Bits of an extended data frame with @p dlc data bytes, without stuff bits
+inline uint16_t CanFrameBits(uint8_t dlc) {
+    return static_cast<uint16_t>(67 + 8 * (dlc > 8 ? 8 : dlc));
+}
+
+/**
+ * @brief One reading of the controller registers
+ */
+struct CanControllerSample {
+    uint8_t txErrors;     ///< Transmit error counter (TEC)
+    uint8_t rxErrors;     ///< Receive error counter (REC)
+    bool errorWarning;    ///< Status: a counter reached the warning limit
+    bool busOff;          ///< Status: controller is bus-off
+    bool overrun;         ///< Status: RX FIFO overrun since the last clear
+};
+
+/**
+ * @class CanBusMonitor
+ * @brief Bucketed bit counts and controller error counters
+ */
+class CanBusMonitor {
+public:
+    static constexpr uint8_t BUCKETS = CAN_BUS_LOAD_BUCKETS;
+
+    CanBusMonitor();
+
+    /**
+     * @brief Count one frame on the bus (received or queued for sending)
+     */
+    void noteFrame(uint8_t dlc, uint32_t nowMs);
+
+    /// CAN_BUS_SAMPLE_MS passed since the last sample()
+    bool sampleDue(uint32_t nowMs) const;
+
+    /**
+     * @brief Record a controller reading
+     *
+     * @return true if @p reading showed an overrun (the caller clears the flag)
+     */
+    bool sample(const CanControllerSample& reading, uint32_t nowMs);
+
+    /**
+     * @brief Bus utilisation of the last @p windowMs (completed buckets)
+     *
+     * @param windowMs Window length, rounded down to buckets, at most BUCKETS buckets
+     * @return 0-100 (values above 100 are capped: injected load can exceed the wire)
+     */
+    uint8_t loadPercent(uint32_t nowMs, uint32_t windowMs) const;
+
+    /// Highest CAN_BUS_LOAD_SHORT_MS load since boot
+    uint8_t getPeakPercent() const { return peakPercent_; }
+
+    uint32_t getFrames() const { return frames_; }
+    CanBusState getState() const { return state_; }
+    uint8_t getTxErrors() const { return txErrors_; }
+    uint8_t getRxErrors() const { return rxErrors_; }
+    uint32_t getWarnings() const { return warnings_; }
+    uint32_t getPassives() const { return passives_; }
+    uint32_t getBusOffs() const { return busOffs_; }
+    uint32_t getOverruns() const { return overruns_; }
+
+    /**
+     * @brief Write load and error state as a JSON object
+     *
+     * {"load_pct":34,"load_5s_pct":31,"peak_pct":61,"frames":812345,"state":"active",
+     *  "tec":0,"rec":0,"warnings":0,"passives":0,"bus_offs":0,"overruns":0}
+     */
+    void writeJson(JsonWriter& json, uint32_t nowMs, const char* key = nullptr) const;
+
+private:
+    struct Bucket {
+        uint32_t slot;    ///< nowMs / CAN_BUS_LOAD_BUCKET_MS of its bits
+        uint32_t bits;
+    };
+
+    void closeSlot(uint32_t closedSlot);
+    uint32_t bitsBetween(uint32_t firstSlot, uint32_t lastSlot) const;
+
+    Bucket buckets_[BUCKETS];
+    uint32_t currentSlot_;
+    uint32_t frames_;
+    uint8_t peakPercent_;
+
+    CanBusState state_;
+    uint8_t txErrors_;
+    uint8_t rxErrors_;
+    uint32_t warnings_;
+    uint32_t passives_;
+    uint32_t busOffs_;
+    uint32_t overruns_;
+    uint32_t lastSampleMs_;
+    bool sampled_;
+};
+
+#endif // CAN_BUS_MONITOR_H
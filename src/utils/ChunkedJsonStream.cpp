@@ -0,0 +1,55 @@
+/**
+ * @file ChunkedJsonStream.cpp
+ * @brief Implementation of the piecewise JSON document
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "ChunkedJsonStream.h"
+#include <string.h>
+
+ChunkedJsonStream::ChunkedJsonStream()
+    : json_(piece_, sizeof(piece_)), generator_(nullptr), context_(nullptr), step_(0), more_(false),
+      overflow_(false), piecePos_(0) {
+}
+
+void ChunkedJsonStream::begin(ChunkedJsonGenerator generator, void* context) {
+    json_.reset();
+    generator_ = generator;
+    context_ = context;
+    step_ = 0;
+    more_ = generator != nullptr;
+    overflow_ = false;
+    piecePos_ = 0;
+}
+
+size_t ChunkedJsonStream::read(char* buffer, size_t maxLen) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (piecePos_ >= json_.length()) {
+            if (!more_) {
+                break;
+            }
+            json_.clearOutput();
+            piecePos_ = 0;
+            more_ = generator_(json_, step_++, context_);
+            if (json_.overflowed()) {
+                // A partial piece would break the document: stop before it
+                overflow_ = true;
+                more_ = false;
+                json_.clearOutput();
+                break;
+            }
+            continue;
+        }
+        size_t n = json_.length() - piecePos_;
+        if (n > maxLen - written) {
+            n = maxLen - written;
+        }
+        memcpy(buffer + written, json_.c_str() + piecePos_, n);
+        piecePos_ += n;
+        written += n;
+    }
+    return written;
+}
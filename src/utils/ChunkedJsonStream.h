@@ -0,0 +1,92 @@
+/**
+ * @file ChunkedJsonStream.h
+ * @brief JSON document produced piece by piece for chunked HTTP responses
+ *
+ * Endpoints used to build their whole body first (a scratch or stack
+ * buffer sized for the largest answer, or AsyncResponseStream, which
+ * grows a heap buffer to the full length). A ChunkedJsonStream calls a
+ * generator one step at a time instead, each step writing the next piece
+ * (the head, one network, one route, ...) into a buffer of
+ * CHUNKED_JSON_PIECE_BYTES, and read() hands the pieces out in whatever
+ * size the TCP window takes. The generator receives the same JsonWriter
+ * every step with its output cleared but its open containers kept
+ * (JsonWriter::clearOutput()), so commas and nesting continue across
+ * pieces as if the document had been written in one go.
+ *
+ * A step that does not fit its piece ends the document where it is
+ * (overflowed()): the steps must stay below CHUNKED_JSON_PIECE_BYTES.
+ * Arduino-free (unit tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * static bool writeStep(JsonWriter& json, uint16_t step, void* context) {
+ *     if (step == 0) { json.beginObject().beginArray("items"); return true; }
+ *     if (step <= items) { writeItem(json, step - 1); return true; }
+ *     json.endArray().endObject();
+ *     return false;                    // Last piece
+ * }
+ * stream.begin(writeStep, this);
+ * size_t n = stream.read(buffer, maxLen);   // until 0
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): body size independent of the buffer, no heap
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CHUNKED_JSON_STREAM_H
+#define CHUNKED_JSON_STREAM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Write piece @p step of a document
+ * @return true if more steps follow, false after the last piece
+ */
+typedef bool (*ChunkedJsonGenerator)(JsonWriter& json, uint16_t step, void* context);
+
+/**
+ * @class ChunkedJsonStream
+ * @brief Runs a generator into a fixed piece buffer and hands the bytes out in chunks
+ */
+class ChunkedJsonStream {
+public:
+    static constexpr size_t PIECE_BYTES = CHUNKED_JSON_PIECE_BYTES;
+
+    ChunkedJsonStream();
+
+    /// Start a new document (@p context must outlive it)
+    void begin(ChunkedJsonGenerator generator, void* context);
+
+    /**
+     * @brief Copy the next part of the document into @p buffer
+     * @return Bytes written; 0 once the document is complete
+     */
+    size_t read(char* buffer, size_t maxLen);
+
+    /// The last piece was handed out (or the document was cut short)
+    bool isComplete() const { return !more_ && piecePos_ >= json_.length(); }
+
+    /// A step did not fit CHUNKED_JSON_PIECE_BYTES: the document was cut short
+    bool overflowed() const { return overflow_; }
+
+    /// Generator steps run so far
+    uint16_t getSteps() const { return step_; }
+
+private:
+    char piece_[PIECE_BYTES];
+    JsonWriter json_;              ///< Over piece_, nesting kept between steps
+    ChunkedJsonGenerator generator_;
+    void* context_;
+    uint16_t step_;
+    bool more_;
+    bool overflow_;
+    size_t piecePos_;              ///< Bytes of the current piece already handed out
+};
+
+#endif // CHUNKED_JSON_STREAM_H
@@ -0,0 +1,247 @@
+/**
+ * @file ConfigRecord.cpp
+ * @brief Implementation of the binary configuration record
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "ConfigRecord.h"
+#include <string.h>
+
+namespace {
+
+// Nibble table of the reflected IEEE polynomial 0xEDB88320 (64 bytes instead of 1 KB)
+const uint32_t CRC_NIBBLE[16] = {
+    0x00000000UL, 0x1DB71064UL, 0x3B6E20C8UL, 0x26D930ACUL,
+    0x76DC4190UL, 0x6B6B51F4UL, 0x4DB26158UL, 0x5005713CUL,
+    0xEDB88320UL, 0xF00F9344UL, 0xD6D6A3E8UL, 0xCB61B38CUL,
+    0x9B64C2B0UL, 0x86D3D2D4UL, 0xA00AE278UL, 0xBDBDF21CUL
+};
+
+uint16_t readU16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t readU32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void writeU16(uint8_t* p, uint16_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void writeU32(uint8_t* p, uint32_t value) {
+    for (uint8_t i = 0; i < 4; i++) {
+        p[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+/// CRC over schema, length and payload (the header fields after the magic, minus the CRC)
+uint32_t recordCrc(const uint8_t* record, size_t payloadLength) {
+    uint32_t crc = ConfigCrc32(record + 4, 4);
+    return ConfigCrc32(record + ConfigRecordWriter::HEADER_SIZE, payloadLength, crc);
+}
+
+}  // namespace
+
+const char* ConfigRecordStatusName(ConfigRecordStatus status) {
+    switch (status) {
+        case ConfigRecordStatus::OK:        return "ok";
+        case ConfigRecordStatus::EMPTY:     return "empty";
+        case ConfigRecordStatus::TRUNCATED: return "truncated";
+        case ConfigRecordStatus::BAD_MAGIC: return "bad_magic";
+        case ConfigRecordStatus::BAD_CRC:   return "bad_crc";
+    }
+    return "unknown";
+}
+
+uint32_t ConfigCrc32(const uint8_t* data, size_t length, uint32_t crc) {
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ CRC_NIBBLE[crc & 0x0F];
+        crc = (crc >> 4) ^ CRC_NIBBLE[crc & 0x0F];
+    }
+    return ~crc;
+}
+
+// ============================================================================
+// ConfigRecordWriter
+// ============================================================================
+
+ConfigRecordWriter::ConfigRecordWriter(uint8_t* buffer, size_t size)
+    : buffer_(buffer), size_(size), pos_(HEADER_SIZE), overflow_(buffer == nullptr || size < HEADER_SIZE) {
+}
+
+bool ConfigRecordWriter::reserve(size_t length) {
+    if (overflow_ || length > size_ - pos_ || pos_ + length - HEADER_SIZE > 0xFFFF) {
+        overflow_ = true;
+        return false;
+    }
+    return true;
+}
+
+ConfigRecordWriter& ConfigRecordWriter::putU8(uint8_t value) {
+    if (reserve(1)) {
+        buffer_[pos_++] = value;
+    }
+    return *this;
+}
+
+ConfigRecordWriter& ConfigRecordWriter::putU16(uint16_t value) {
+    if (reserve(2)) {
+        writeU16(buffer_ + pos_, value);
+        pos_ += 2;
+    }
+    return *this;
+}
+
+ConfigRecordWriter& ConfigRecordWriter::putU32(uint32_t value) {
+    if (reserve(4)) {
+        writeU32(buffer_ + pos_, value);
+        pos_ += 4;
+    }
+    return *this;
+}
+
+ConfigRecordWriter& ConfigRecordWriter::putF32(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return putU32(bits);
+}
+
+ConfigRecordWriter& ConfigRecordWriter::putF64(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    putU32(static_cast<uint32_t>(bits));
+    return putU32(static_cast<uint32_t>(bits >> 32));
+}
+
+ConfigRecordWriter& ConfigRecordWriter::putBytes(const uint8_t* data, size_t length) {
+    if (reserve(length)) {
+        memcpy(buffer_ + pos_, data, length);
+        pos_ += length;
+    }
+    return *this;
+}
+
+ConfigRecordWriter& ConfigRecordWriter::putString(const char* text) {
+    size_t length = text != nullptr ? strlen(text) : 0;
+    if (length > 0xFF) {
+        overflow_ = true;
+        return *this;
+    }
+    putU8(static_cast<uint8_t>(length));
+    return putBytes(reinterpret_cast<const uint8_t*>(text), length);
+}
+
+size_t ConfigRecordWriter::finish(uint16_t schema) {
+    if (overflow_) {
+        return 0;
+    }
+    size_t payloadLength = pos_ - HEADER_SIZE;
+    writeU32(buffer_, CONFIG_RECORD_MAGIC);
+    writeU16(buffer_ + 4, schema);
+    writeU16(buffer_ + 6, static_cast<uint16_t>(payloadLength));
+    writeU32(buffer_ + 8, recordCrc(buffer_, payloadLength));
+    return pos_;
+}
+
+// ============================================================================
+// ConfigRecordReader
+// ============================================================================
+
+ConfigRecordReader::ConfigRecordReader(const uint8_t* data, size_t length)
+    : data_(data), length_(data != nullptr ? length : 0), pos_(0), end_(0), ok_(false) {
+}
+
+ConfigRecordStatus ConfigRecordReader::open(uint16_t& schema) {
+    ok_ = false;
+    pos_ = 0;
+    end_ = 0;
+    if (length_ == 0) {
+        return ConfigRecordStatus::EMPTY;
+    }
+    if (length_ < ConfigRecordWriter::HEADER_SIZE) {
+        return ConfigRecordStatus::TRUNCATED;
+    }
+    if (readU32(data_) != CONFIG_RECORD_MAGIC) {
+        return ConfigRecordStatus::BAD_MAGIC;
+    }
+    size_t payloadLength = readU16(data_ + 6);
+    if (payloadLength > length_ - ConfigRecordWriter::HEADER_SIZE) {
+        return ConfigRecordStatus::TRUNCATED;
+    }
+    if (readU32(data_ + 8) != recordCrc(data_, payloadLength)) {
+        return ConfigRecordStatus::BAD_CRC;
+    }
+    schema = readU16(data_ + 4);
+    pos_ = ConfigRecordWriter::HEADER_SIZE;
+    end_ = pos_ + payloadLength;
+    ok_ = true;
+    return ConfigRecordStatus::OK;
+}
+
+bool ConfigRecordReader::take(size_t length) {
+    if (!ok_ || length > end_ - pos_) {
+        ok_ = false;
+        return false;
+    }
+    pos_ += length;
+    return true;
+}
+
+uint8_t ConfigRecordReader::getU8() {
+    return take(1) ? data_[pos_ - 1] : 0;
+}
+
+uint16_t ConfigRecordReader::getU16() {
+    return take(2) ? readU16(data_ + pos_ - 2) : 0;
+}
+
+uint32_t ConfigRecordReader::getU32() {
+    return take(4) ? readU32(data_ + pos_ - 4) : 0;
+}
+
+float ConfigRecordReader::getF32() {
+    uint32_t bits = getU32();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+double ConfigRecordReader::getF64() {
+    uint64_t bits = getU32();
+    bits |= static_cast<uint64_t>(getU32()) << 32;
+    double value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+bool ConfigRecordReader::getBytes(uint8_t* out, size_t length) {
+    if (!take(length)) {
+        return false;
+    }
+    memcpy(out, data_ + pos_ - length, length);
+    return true;
+}
+
+bool ConfigRecordReader::getString(char* out, size_t size) {
+    uint8_t length = getU8();
+    if (!ok_ || size == 0 || length > size - 1) {
+        ok_ = false;
+        if (size > 0) {
+            out[0] = '\0';
+        }
+        return false;
+    }
+    if (!getBytes(reinterpret_cast<uint8_t*>(out), length)) {
+        out[0] = '\0';
+        return false;
+    }
+    out[length] = '\0';
+    return true;
+}
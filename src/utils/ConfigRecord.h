@@ -0,0 +1,164 @@
+/**
+ * @file ConfigRecord.h
+ * @brief Versioned binary configuration record with CRC-32 (NVS storage)
+ *
+ * Calibration and the Wi-Fi network list are kept in NVS as one blob each
+ * instead of JSON/text files on LittleFS: loading them at boot is a
+ * length-checked copy instead of a file open and a parse, and NVS lives in
+ * its own partition, so a corrupted LittleFS no longer loses them.
+ *
+ * Record layout (little-endian):
+ *   offset 0  uint32 magic   CONFIG_RECORD_MAGIC ("P2CF")
+ *   offset 4  uint16 schema  payload layout version of the owner
+ *   offset 6  uint16 length  payload bytes
+ *   offset 8  uint32 crc     CRC-32 (IEEE) of schema, length and payload
+ *   offset 12 payload        fields written with ConfigRecordWriter
+ *
+ * Fields are written one by one (no struct copies), so a record does not
+ * depend on padding or compiler. An owner that adds fields appends them and
+ * bumps its schema; readers of an older schema leave the new fields at their
+ * defaults.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * uint8_t buffer[CONFIG_RECORD_MAX_BYTES];
+ * ConfigRecordWriter out(buffer, sizeof(buffer));
+ * out.putF64(params.leewayCalibrationFactor);
+ * size_t length = out.finish(CALIBRATION_RECORD_SCHEMA);  // 0 = did not fit
+ * store->write("calibration", buffer, length);
+ *
+ * ConfigRecordReader in(buffer, store->read("calibration", buffer, sizeof(buffer)));
+ * uint16_t schema;
+ * if (in.open(schema) == ConfigRecordStatus::OK) {
+ *     double k = in.getF64();
+ *     if (in.ok()) { ... }   // Every get stayed inside the payload
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): caller buffers, no heap
+ * - Principle VII (Fail-Safe): a torn or foreign record fails the CRC and the
+ *   owner falls back to its file or defaults
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CONFIG_RECORD_H
+#define CONFIG_RECORD_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+/// "P2CF" read as a little-endian uint32
+#define CONFIG_RECORD_MAGIC 0x46433250UL
+
+/**
+ * @brief Result of ConfigRecordReader::open()
+ */
+enum class ConfigRecordStatus : uint8_t {
+    OK = 0,
+    EMPTY,       ///< No record stored
+    TRUNCATED,   ///< Shorter than its header or its declared length
+    BAD_MAGIC,   ///< Not a configuration record
+    BAD_CRC      ///< Damaged
+};
+
+/// Name of @p status (log events)
+const char* ConfigRecordStatusName(ConfigRecordStatus status);
+
+/// CRC-32 (IEEE 802.3, reflected, as zlib) of @p length bytes, continuing @p crc
+uint32_t ConfigCrc32(const uint8_t* data, size_t length, uint32_t crc = 0);
+
+/**
+ * @class ConfigRecordWriter
+ * @brief Append fields to a record payload, then seal the header
+ */
+class ConfigRecordWriter {
+public:
+    static constexpr size_t HEADER_SIZE = 12;
+
+    ConfigRecordWriter(uint8_t* buffer, size_t size);
+
+    ConfigRecordWriter& putU8(uint8_t value);
+    ConfigRecordWriter& putU16(uint16_t value);
+    ConfigRecordWriter& putU32(uint32_t value);
+    ConfigRecordWriter& putF32(float value);
+    ConfigRecordWriter& putF64(double value);
+    ConfigRecordWriter& putBytes(const uint8_t* data, size_t length);
+
+    /// Length byte (at most 255) followed by the characters, no terminator
+    ConfigRecordWriter& putString(const char* text);
+
+    /// A field did not fit (finish() then returns 0)
+    bool overflowed() const { return overflow_; }
+
+    /**
+     * @brief Write the header for @p schema
+     * @return Record length (header + payload), 0 if a field did not fit
+     */
+    size_t finish(uint16_t schema);
+
+private:
+    bool reserve(size_t length);
+
+    uint8_t* buffer_;
+    size_t size_;
+    size_t pos_;
+    bool overflow_;
+};
+
+/**
+ * @class ConfigRecordReader
+ * @brief Verify a record, then read its payload fields in order
+ *
+ * A get past the end of the payload returns 0/empty and clears ok(), so a
+ * caller reads every field and checks ok() once.
+ */
+class ConfigRecordReader {
+public:
+    /**
+     * @param data Record as stored
+     * @param length Bytes in @p data (0 = nothing stored)
+     */
+    ConfigRecordReader(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Check magic, length and CRC; on OK the getters read the payload
+     * @param[out] schema Payload layout version
+     */
+    ConfigRecordStatus open(uint16_t& schema);
+
+    uint8_t getU8();
+    uint16_t getU16();
+    uint32_t getU32();
+    float getF32();
+    double getF64();
+    bool getBytes(uint8_t* out, size_t length);
+
+    /**
+     * @brief Read a putString() field into @p out (terminated)
+     * @return false (and ok() cleared) if it is longer than @p size - 1
+     */
+    bool getString(char* out, size_t size);
+
+    /// Payload bytes not read yet
+    size_t remaining() const { return end_ - pos_; }
+
+    /// Every read so far was inside the payload
+    bool ok() const { return ok_; }
+
+private:
+    bool take(size_t length);
+
+    const uint8_t* data_;
+    size_t length_;
+    size_t pos_;
+    size_t end_;
+    bool ok_;
+};
+
+#endif // CONFIG_RECORD_H
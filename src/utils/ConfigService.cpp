@@ -0,0 +1,153 @@
+/**
+ * @file ConfigService.cpp
+ * @brief Implementation of the versioned live configuration service
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "ConfigService.h"
+#include <string.h>
+
+namespace {
+
+const char* const DOMAIN_NAMES[] = {
+#define CONFIG_DOMAIN_NAME(id, name) name,
+    CONFIG_DOMAIN_LIST(CONFIG_DOMAIN_NAME)
+#undef CONFIG_DOMAIN_NAME
+};
+
+const uint8_t DOMAIN_COUNT = static_cast<uint8_t>(ConfigDomain::COUNT);
+
+}  // namespace
+
+const char* ConfigDomainName(ConfigDomain domain) {
+    uint8_t index = static_cast<uint8_t>(domain);
+    return index < DOMAIN_COUNT ? DOMAIN_NAMES[index] : "unknown";
+}
+
+bool ConfigDomainFromName(const char* name, ConfigDomain& domain) {
+    if (name == nullptr) {
+        return false;
+    }
+    for (uint8_t i = 0; i < DOMAIN_COUNT; i++) {
+        if (strcmp(name, DOMAIN_NAMES[i]) == 0) {
+            domain = static_cast<ConfigDomain>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+ConfigService::ConfigService() : count_(0), lastRejected_("") {
+    for (uint8_t i = 0; i < DOMAIN_COUNT; i++) {
+        domains_[i].version.store(0, std::memory_order_relaxed);
+        domains_[i].applied.store(0, std::memory_order_relaxed);
+        domains_[i].rejected.store(0, std::memory_order_relaxed);
+        domains_[i].ok.store(true, std::memory_order_relaxed);
+    }
+}
+
+bool ConfigService::subscribe(ConfigDomain domain, const char* name, ConfigApply apply, void* context) {
+    uint8_t count = count_.load(std::memory_order_relaxed);
+    if (apply == nullptr || static_cast<uint8_t>(domain) >= DOMAIN_COUNT || count >= CONFIG_SERVICE_MAX_SUBSCRIBERS) {
+        return false;
+    }
+    Subscriber& subscriber = subscribers_[count];
+    subscriber.domain = domain;
+    subscriber.name = name;
+    subscriber.apply = apply;
+    subscriber.context = context;
+    count_.store(count + 1, std::memory_order_release);  // Entry first: poll() sees it complete
+    return true;
+}
+
+uint32_t ConfigService::publish(ConfigDomain domain) {
+    uint8_t index = static_cast<uint8_t>(domain);
+    if (index >= DOMAIN_COUNT) {
+        return 0;
+    }
+    // Release: the staged object is visible to the poll() that sees the version
+    return domains_[index].version.fetch_add(1, std::memory_order_acq_rel) + 1;
+}
+
+uint8_t ConfigService::poll() {
+    uint8_t rejected = 0;
+    uint8_t count = count_.load(std::memory_order_acquire);
+    for (uint8_t d = 0; d < DOMAIN_COUNT; d++) {
+        DomainState& state = domains_[d];
+        uint32_t version = state.version.load(std::memory_order_acquire);
+        if (version == state.applied.load(std::memory_order_relaxed)) {
+            continue;
+        }
+
+        bool busy = false;
+        bool ok = true;
+        for (uint8_t i = 0; i < count && !busy; i++) {
+            Subscriber& subscriber = subscribers_[i];
+            if (static_cast<uint8_t>(subscriber.domain) != d) {
+                continue;
+            }
+            ConfigApplyResult result = subscriber.apply(subscriber.context, version);
+            if (result == ConfigApplyResult::BUSY) {
+                busy = true;
+            } else if (result == ConfigApplyResult::REJECTED) {
+                ok = false;
+                rejected++;
+                state.rejected.fetch_add(1, std::memory_order_relaxed);
+                lastRejected_ = subscriber.name;
+            }
+        }
+        if (busy) {
+            continue;  // Still pending: the domain is applied again at the next poll
+        }
+        state.ok.store(ok, std::memory_order_relaxed);
+        state.applied.store(version, std::memory_order_release);
+    }
+    return rejected;
+}
+
+uint32_t ConfigService::getVersion(ConfigDomain domain) const {
+    uint8_t index = static_cast<uint8_t>(domain);
+    return index < DOMAIN_COUNT ? domains_[index].version.load(std::memory_order_acquire) : 0;
+}
+
+uint32_t ConfigService::getAppliedVersion(ConfigDomain domain) const {
+    uint8_t index = static_cast<uint8_t>(domain);
+    return index < DOMAIN_COUNT ? domains_[index].applied.load(std::memory_order_acquire) : 0;
+}
+
+uint32_t ConfigService::getRejected(ConfigDomain domain) const {
+    uint8_t index = static_cast<uint8_t>(domain);
+    return index < DOMAIN_COUNT ? domains_[index].rejected.load(std::memory_order_relaxed) : 0;
+}
+
+void ConfigService::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    uint8_t count = count_.load(std::memory_order_acquire);
+    for (uint8_t d = 0; d < DOMAIN_COUNT; d++) {
+        const DomainState& state = domains_[d];
+        unsigned int subscribers = 0;
+        for (uint8_t i = 0; i < count; i++) {
+            subscribers += static_cast<uint8_t>(subscribers_[i].domain) == d ? 1 : 0;
+        }
+        json.beginObject(DOMAIN_NAMES[d])
+            .add("version", (unsigned long)state.version.load(std::memory_order_relaxed))
+            .add("applied", (unsigned long)state.applied.load(std::memory_order_relaxed))
+            .add("ok", state.ok.load(std::memory_order_relaxed))
+            .add("rejected", (unsigned long)state.rejected.load(std::memory_order_relaxed))
+            .add("subscribers", subscribers)
+            .endObject();
+    }
+    json.add("last_rejected", lastRejected_);
+    json.endObject();
+}
+
+ConfigService& GetConfigService() {
+    static ConfigService configService;
+    return configService;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file ConfigService.h
+ * @brief Versioned live configuration: publish from any task, apply in the main loop
+ *
+ * Configuration changes used to take effect at the next boot (a wifi.conf
+ * upload scheduled a reboot, routing was read in setup() only). Instead, a
+ * producer validates the new object, stages it (ConfigStage) and publishes
+ * its domain, which bumps the domain version. poll(), called from one
+ * main-loop reaction, runs every subscriber of each domain whose version
+ * moved, so only the affected subsystem reacts (Wi-Fi reconnects, the
+ * router swaps its table) and it does so in the task that owns the state.
+ *
+ * - publish(): any task (HTTP handlers run on async_tcp); several publishes
+ *   before the next poll() are applied once, at the newest version
+ * - Publishing without staging an object asks the subscribers to re-read
+ *   their persisted configuration (POST /config/reload)
+ * - subscribe(): setup or the WiFi event task (web servers are created on
+ *   connect); apply functions run in the main loop only and must be
+ *   idempotent: a BUSY result applies the domain again at the next poll()
+ *
+ * Arduino-free (apply functions are injected, unit tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * GetConfigService().subscribe(ConfigDomain::CALIBRATION, "calibration", applyCalibration, this);
+ * stage.stage(calibration);                                        // HTTP handler, validated
+ * uint32_t version = GetConfigService().publish(ConfigDomain::CALIBRATION);
+ * app.onRepeat(CONFIG_SERVICE_INTERVAL_MS, []() { GetConfigService().poll(); });
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed subscriber table, no heap
+ * - Principle VII (Fail-Safe): objects are validated before they are staged; a
+ *   rejected apply keeps the running configuration and is counted
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CONFIG_SERVICE_H
+#define CONFIG_SERVICE_H
+
+#include <stdint.h>
+#include <atomic>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/// Configuration domains: identifier, name (GET /config, ?domain=)
+#define CONFIG_DOMAIN_LIST(X) \
+    X(WIFI, "wifi") \
+    X(CALIBRATION, "calibration") \
+    X(NMEA0183_ROUTES, "nmea0183_routes") \
+    X(ALARMS, "alarms")
+
+/**
+ * @brief Independently applied parts of the configuration
+ */
+enum class ConfigDomain : uint8_t {
+#define CONFIG_DOMAIN_ENUM(id, name) id,
+    CONFIG_DOMAIN_LIST(CONFIG_DOMAIN_ENUM)
+#undef CONFIG_DOMAIN_ENUM
+    COUNT
+};
+
+/// Name of @p domain ("unknown" if out of range)
+const char* ConfigDomainName(ConfigDomain domain);
+
+/// Domain called @p name; false if there is none
+bool ConfigDomainFromName(const char* name, ConfigDomain& domain);
+
+/**
+ * @brief Outcome of one apply call
+ */
+enum class ConfigApplyResult : uint8_t {
+    APPLIED,    ///< The subsystem runs the new configuration
+    REJECTED,   ///< Unusable (e.g. invalid file): the running configuration is kept
+    BUSY        ///< Cannot apply now: the whole domain is applied again at the next poll()
+};
+
+/// Apply the newest configuration of a domain (main loop)
+typedef ConfigApplyResult (*ConfigApply)(void* context, uint32_t version);
+
+/**
+ * @class ConfigStage
+ * @brief Single-slot handoff of a validated object from a producer task to the main loop
+ *
+ * Never spins: the HTTP task (priority above the loop) could otherwise wait
+ * forever on a loop preempted on the same core. stage() fails if take()
+ * holds the slot at that moment (answer 503), take() reports busy if
+ * stage() does (return ConfigApplyResult::BUSY). A newer stage() replaces
+ * an object not taken yet.
+ */
+template <typename T>
+class ConfigStage {
+public:
+    ConfigStage() : staged_(false) { lock_.clear(); }
+
+    /// Hand @p value over; false if the slot is being read right now
+    bool stage(const T& value) {
+        if (lock_.test_and_set(std::memory_order_acquire)) {
+            return false;
+        }
+        value_ = value;
+        staged_ = true;
+        lock_.clear(std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Take the staged object
+     *
+     * @param[out] busy Set if the slot is being written right now (try again)
+     * @return true if @p out holds a newly staged object
+     */
+    bool take(T& out, bool& busy) {
+        busy = lock_.test_and_set(std::memory_order_acquire);
+        if (busy) {
+            return false;
+        }
+        bool had = staged_;
+        if (had) {
+            out = value_;
+            staged_ = false;
+        }
+        lock_.clear(std::memory_order_release);
+        return had;
+    }
+
+private:
+    std::atomic_flag lock_;
+    T value_;
+    bool staged_;
+};
+
+/**
+ * @class ConfigService
+ * @brief Domain versions and the components that apply them
+ */
+class ConfigService {
+public:
+    ConfigService();
+
+    /**
+     * @brief Register @p apply for @p domain
+     *
+     * @param name Static label (GET /config, log events)
+     * @return false if the table is full (CONFIG_SERVICE_MAX_SUBSCRIBERS) or the arguments are invalid
+     */
+    bool subscribe(ConfigDomain domain, const char* name, ConfigApply apply, void* context);
+
+    /**
+     * @brief A new configuration of @p domain is staged or persisted (any task)
+     * @return The new version of @p domain (0 for an invalid domain)
+     */
+    uint32_t publish(ConfigDomain domain);
+
+    /**
+     * @brief Apply every domain whose version changed since the last poll (main loop)
+     * @return Subscribers that rejected their configuration
+     */
+    uint8_t poll();
+
+    /// Newest published version of @p domain (0 = boot configuration)
+    uint32_t getVersion(ConfigDomain domain) const;
+
+    /// Version the subscribers of @p domain ran last
+    uint32_t getAppliedVersion(ConfigDomain domain) const;
+
+    /// A published version of @p domain waits for poll()
+    bool isPending(ConfigDomain domain) const { return getVersion(domain) != getAppliedVersion(domain); }
+
+    /// Apply calls that returned REJECTED for @p domain
+    uint32_t getRejected(ConfigDomain domain) const;
+
+    uint8_t count() const { return count_.load(std::memory_order_acquire); }
+
+    /// Name of the subscriber that rejected last ("" = none yet)
+    const char* getLastRejected() const { return lastRejected_; }
+
+    /**
+     * @brief Write the domain states as a JSON object
+     *
+     * {"wifi":{"version":2,"applied":2,"ok":true,"rejected":0,"subscribers":1},...,"last_rejected":""}
+     * With @p key the object is a member of the enclosing one (GET /status).
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    struct Subscriber {
+        ConfigDomain domain;
+        const char* name;
+        ConfigApply apply;
+        void* context;
+    };
+
+    struct DomainState {
+        std::atomic<uint32_t> version;
+        std::atomic<uint32_t> applied;
+        std::atomic<uint32_t> rejected;
+        std::atomic<bool> ok;          ///< No subscriber rejected the applied version
+    };
+
+    Subscriber subscribers_[CONFIG_SERVICE_MAX_SUBSCRIBERS];
+    std::atomic<uint8_t> count_;       ///< Published after the entry is written
+    DomainState domains_[static_cast<uint8_t>(ConfigDomain::COUNT)];
+    const char* lastRejected_;
+};
+
+/// Live configuration of the firmware
+ConfigService& GetConfigService();
+
+#endif // CONFIG_SERVICE_H
@@ -0,0 +1,77 @@
+/**
+ * @file CpuIdleMonitor.cpp
+ * @brief Implementation of the per-core CPU idle windows
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "CpuIdleMonitor.h"
+
+CpuIdleMonitor::CpuIdleMonitor()
+    : windowStartUs_(0), enabled_(0), started_(false), windows_(0) {
+    for (uint8_t core = 0; core < MAX_CORES; core++) {
+        idleCycles_[core] = 0;
+        windowStartCycles_[core] = 0;
+        percent_[core] = CPU_IDLE_UNKNOWN;
+    }
+}
+
+void CpuIdleMonitor::enableCore(uint8_t core) {
+    if (core < MAX_CORES) {
+        enabled_ = static_cast<uint8_t>(enabled_ | (1u << core));
+    }
+}
+
+void CpuIdleMonitor::closeWindow(uint32_t nowUs, uint32_t cpuMhz) {
+    uint32_t elapsedUs = nowUs - windowStartUs_;
+    uint32_t cycles[MAX_CORES];
+    for (uint8_t core = 0; core < MAX_CORES; core++) {
+        cycles[core] = idleCycles_[core];
+    }
+
+    if (started_ && elapsedUs > 0 && cpuMhz > 0) {
+        uint64_t windowCycles = static_cast<uint64_t>(elapsedUs) * cpuMhz;
+        for (uint8_t core = 0; core < MAX_CORES; core++) {
+            if ((enabled_ & (1u << core)) == 0) {
+                continue;
+            }
+            uint64_t idle = static_cast<uint64_t>(cycles[core] - windowStartCycles_[core]) * 100;
+            uint64_t percent = (idle + windowCycles / 2) / windowCycles;
+            percent_[core] = static_cast<uint8_t>(percent > 100 ? 100 : percent);
+        }
+        windows_++;
+    }
+
+    started_ = true;
+    windowStartUs_ = nowUs;
+    for (uint8_t core = 0; core < MAX_CORES; core++) {
+        windowStartCycles_[core] = cycles[core];
+    }
+}
+
+uint8_t CpuIdleMonitor::getIdlePercent(uint8_t core) const {
+    return core < MAX_CORES ? percent_[core] : CPU_IDLE_UNKNOWN;
+}
+
+uint8_t CpuIdleMonitor::getMinIdlePercent() const {
+    uint8_t min = CPU_IDLE_UNKNOWN;
+    for (uint8_t core = 0; core < MAX_CORES; core++) {
+        if (percent_[core] != CPU_IDLE_UNKNOWN && (min == CPU_IDLE_UNKNOWN || percent_[core] < min)) {
+            min = percent_[core];
+        }
+    }
+    return min;
+}
+
+uint8_t CpuIdleMonitor::getAverageIdlePercent() const {
+    uint16_t sum = 0;
+    uint8_t n = 0;
+    for (uint8_t core = 0; core < MAX_CORES; core++) {
+        if (percent_[core] != CPU_IDLE_UNKNOWN) {
+            sum = static_cast<uint16_t>(sum + percent_[core]);
+            n++;
+        }
+    }
+    return n > 0 ? static_cast<uint8_t>((sum + n / 2) / n) : CPU_IDLE_UNKNOWN;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file CpuIdleMonitor.h
+ * @brief Per-core CPU idle percentage, measured by the FreeRTOS idle tasks
+ *
+ * The idle hook of each core (ESP32SystemMetrics) waits for the next
+ * interrupt itself, between two cycle counter reads, and passes the cycles
+ * it slept to addIdleCycles(). Time spent anywhere else - tasks, and the
+ * idle task's own bookkeeping - counts as busy. closeWindow() turns the
+ * idle cycles since the previous window into a percentage of the window's
+ * wall time, so a core is 100% idle only if it slept the whole window.
+ * Interrupt handlers that wake the core are counted as idle (they run
+ * before the hook reads the counter again).
+ *
+ * Windows are closed by the caller (the 5 s loop frequency windows); the
+ * 32-bit cycle totals allow windows up to 17 s at 240 MHz.
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): 40 bytes, two counter reads per idle wake-up
+ * - Principle V (Network Debugging): real headroom for the OLED, logs and the /boatdata governor
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CPU_IDLE_MONITOR_H
+#define CPU_IDLE_MONITOR_H
+
+#include <stdint.h>
+#include "../config.h"
+
+/**
+ * @class CpuIdleMonitor
+ * @brief Idle cycle totals per core (written by the idle hooks) and the last window's percentages
+ */
+class CpuIdleMonitor {
+public:
+    static constexpr uint8_t MAX_CORES = 2;
+
+    CpuIdleMonitor();
+
+    /**
+     * @brief Measure @p core (its idle hook is registered); other cores stay CPU_IDLE_UNKNOWN
+     */
+    void enableCore(uint8_t core);
+
+    /**
+     * @brief Add @p cycles slept by the idle task of @p core (that core's idle hook only)
+     */
+    void addIdleCycles(uint8_t core, uint32_t cycles) {
+        if (core < MAX_CORES) {
+            idleCycles_[core] += cycles;
+        }
+    }
+
+    /**
+     * @brief End the current window at @p nowUs (the first call only starts one)
+     *
+     * @param nowUs Wall clock in microseconds
+     * @param cpuMhz Cycle counter frequency
+     */
+    void closeWindow(uint32_t nowUs, uint32_t cpuMhz);
+
+    /// Idle share of @p core in the last window, 0-100, or CPU_IDLE_UNKNOWN
+    uint8_t getIdlePercent(uint8_t core) const;
+
+    /// Idle share of the busiest measured core, or CPU_IDLE_UNKNOWN
+    uint8_t getMinIdlePercent() const;
+
+    /// Mean idle share of the measured cores, or CPU_IDLE_UNKNOWN
+    uint8_t getAverageIdlePercent() const;
+
+    /// Completed windows since boot
+    uint32_t getWindowCount() const { return windows_; }
+
+private:
+    volatile uint32_t idleCycles_[MAX_CORES];  ///< Running totals, one writer per core
+    uint32_t windowStartCycles_[MAX_CORES];
+    uint32_t windowStartUs_;
+    uint8_t percent_[MAX_CORES];
+    uint8_t enabled_;                           ///< Bit per measured core
+    bool started_;
+    uint32_t windows_;
+};
+
+#endif // CPU_IDLE_MONITOR_H
@@ -0,0 +1,64 @@
+/**
+ * @file CrashLogRing.cpp
+ * @brief Implementation of the RTC-memory crash log ring
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "CrashLogRing.h"
+#include <string.h>
+
+#ifdef ARDUINO
+#include <esp_attr.h>
+
+RTC_NOINIT_ATTR static CrashLogStorage rtcCrashLog;
+
+CrashLogStorage& CrashLogRing::rtcStorage() {
+    return rtcCrashLog;
+}
+#endif
+
+CrashLogRing::CrashLogRing(CrashLogStorage& storage)
+    : storage(storage), previousCount(0) {
+    bool valid = storage.magic == MAGIC && storage.head < CAPACITY && storage.count <= CAPACITY &&
+                 storage.check == (storage.magic ^ storage.head ^ storage.count);
+
+    if (valid) {
+        // Oldest record sits at head once the ring has wrapped, else at 0
+        uint32_t start = (storage.count < CAPACITY) ? 0 : storage.head;
+        for (uint32_t i = 0; i < storage.count; i++) {
+            CrashLogEntry& entry = previous[previousCount++];
+            entry = storage.entries[(start + i) % CAPACITY];
+            // Record may have been cut short by the reset - force termination
+            entry.component[sizeof(entry.component) - 1] = '\0';
+            entry.event[sizeof(entry.event) - 1] = '\0';
+        }
+    }
+
+    storage.head = 0;
+    storage.count = 0;
+    storage.magic = MAGIC;
+    storage.check = MAGIC;
+}
+
+void CrashLogRing::record(uint8_t level, const char* component, const char* event, uint32_t now) {
+    if (level < LOG_CRASH_RING_MIN_LEVEL) {
+        return;
+    }
+
+    uint32_t slot = storage.head;
+    CrashLogEntry& entry = storage.entries[slot];
+    entry.timestamp = now;
+    entry.level = level;
+    strncpy(entry.component, component != nullptr ? component : "", sizeof(entry.component) - 1);
+    entry.component[sizeof(entry.component) - 1] = '\0';
+    strncpy(entry.event, event != nullptr ? event : "", sizeof(entry.event) - 1);
+    entry.event[sizeof(entry.event) - 1] = '\0';
+
+    storage.head = (slot + 1) % CAPACITY;
+    if (storage.count < CAPACITY) {
+        storage.count++;
+    }
+    storage.check = storage.magic ^ storage.head ^ storage.count;
+}
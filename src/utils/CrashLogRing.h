@@ -0,0 +1,118 @@
+/**
+ * @file CrashLogRing.h
+ * @brief Log ring in RTC slow memory that survives watchdog, panic and brownout resets
+ *
+ * /logs is live-only: whatever happened just before a reset is lost. The
+ * crash ring keeps the last LOG_CRASH_RING_RECORDS messages (level, component,
+ * event - no JSON payload) in RTC_NOINIT memory, which the ESP32 does not
+ * clear on a software or watchdog reset. On boot the previous contents are
+ * validated and copied aside, so the new boot can start recording at once.
+ *
+ * Recording is a level compare and two bounded string copies, with no
+ * formatting, locking or allocation, so it runs for every message regardless
+ * of connected clients.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed-size storage, zero heap allocation
+ * - Principle VII (Fail-Safe): garbage after power-on is detected and discarded
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef CRASH_LOG_RING_H
+#define CRASH_LOG_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+/**
+ * @brief One crash ring record (fixed 64 bytes)
+ */
+struct CrashLogEntry {
+    static constexpr size_t COMPONENT_SIZE = 23;  ///< Longest component name + NUL
+    static constexpr size_t EVENT_SIZE = 36;      ///< Longest event name + NUL
+
+    uint32_t timestamp;               ///< millis() when recorded
+    uint8_t level;                    ///< LogLevel value
+    char component[COMPONENT_SIZE];   ///< Component name (truncated if longer)
+    char event[EVENT_SIZE];           ///< Event name (truncated if longer)
+};
+
+static_assert(sizeof(CrashLogEntry) == 64, "CrashLogEntry layout changed - bump CrashLogRing::MAGIC");
+
+/**
+ * @brief Raw ring storage, placed in RTC memory on the target
+ */
+struct CrashLogStorage {
+    uint32_t magic;      ///< CrashLogRing::MAGIC when contents are valid
+    uint32_t head;       ///< Next slot to write
+    uint32_t count;      ///< Valid records (<= LOG_CRASH_RING_RECORDS)
+    uint32_t check;      ///< magic ^ head ^ count, updated on each record
+    CrashLogEntry entries[LOG_CRASH_RING_RECORDS];
+};
+
+/**
+ * @class CrashLogRing
+ * @brief Writer for the current boot, reader for the previous one
+ *
+ * Usage pattern:
+ * @code
+ * CrashLogRing crashLog(CrashLogRing::rtcStorage());  // Snapshot previous boot
+ *
+ * crashLog.record(level, "NMEA2000", "PGN_IGNORED", millis());
+ *
+ * for (uint16_t i = 0; i < crashLog.getPreviousCount(); i++) {
+ *     const CrashLogEntry& e = crashLog.getPrevious(i);  // Oldest first
+ * }
+ * @endcode
+ *
+ * @note record() is not synchronized; two tasks logging at the same instant
+ *       may overwrite each other's slot. Acceptable for post-mortem context.
+ */
+class CrashLogRing {
+public:
+    static constexpr uint32_t MAGIC = 0x4C4F4731;  ///< "LOG1"
+    static constexpr uint16_t CAPACITY = LOG_CRASH_RING_RECORDS;
+
+    /**
+     * @brief Take over @p storage: copy out valid previous-boot records, then reset it
+     * @param storage Ring storage (RTC memory on the target)
+     */
+    explicit CrashLogRing(CrashLogStorage& storage);
+
+    /**
+     * @brief Append a record for the current boot
+     * @param level LogLevel value (below LOG_CRASH_RING_MIN_LEVEL is ignored)
+     * @param component Component name
+     * @param event Event name
+     * @param now Current millis()
+     */
+    void record(uint8_t level, const char* component, const char* event, uint32_t now);
+
+    /**
+     * @brief Number of records recovered from the previous boot
+     */
+    uint16_t getPreviousCount() const { return previousCount; }
+
+    /**
+     * @brief Previous-boot record, oldest first
+     * @param index 0 .. getPreviousCount() - 1
+     */
+    const CrashLogEntry& getPrevious(uint16_t index) const { return previous[index]; }
+
+#ifdef ARDUINO
+    /**
+     * @brief Storage in RTC_NOINIT memory (preserved across non-power-on resets)
+     */
+    static CrashLogStorage& rtcStorage();
+#endif
+
+private:
+    CrashLogStorage& storage;
+    CrashLogEntry previous[CAPACITY];
+    uint16_t previousCount;
+};
+
+#endif // CRASH_LOG_RING_H
@@ -0,0 +1,163 @@
+/**
+ * @file DampingFilters.cpp
+ * @brief Implementation of the damping filters
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "DampingFilters.h"
+#include <cmath>
+#include "FastMath.h"
+
+namespace {
+
+const uint8_t FIELD_KINDS[DAMPING_FIELD_COUNT] = {
+#define BOATDATA_DAMPING_KIND(id, key, kind) DAMPING_KIND_##kind,
+    BOATDATA_DAMPING_FIELDS(BOATDATA_DAMPING_KIND)
+#undef BOATDATA_DAMPING_KIND
+};
+
+const char* const FIELD_KEYS[DAMPING_FIELD_COUNT] = {
+#define BOATDATA_DAMPING_KEY(id, key, kind) #key,
+    BOATDATA_DAMPING_FIELDS(BOATDATA_DAMPING_KEY)
+#undef BOATDATA_DAMPING_KEY
+};
+
+// Same kernels as the calculation cycle (CALC_FAST_MATH)
+inline void sinCos(float x, float& s, float& c) {
+#if CALC_FAST_MATH
+    FastMath::sincos(x, s, c);
+#else
+    s = std::sin(x);
+    c = std::cos(x);
+#endif
+}
+
+inline float arcTan2(float y, float x) {
+#if CALC_FAST_MATH
+    return FastMath::atan2(y, x);
+#else
+    return std::atan2(y, x);
+#endif
+}
+
+}  // namespace
+
+// =============================================================================
+// FILTERS
+// =============================================================================
+
+float Damping::ema(DampingState& state, float x, float dtS, float tauS) {
+    if (!state.primed) {
+        state.a = x;
+        state.primed = true;
+        return x;
+    }
+    float alpha = dtS / (tauS + dtS);
+    state.a += alpha * (x - state.a);
+    return state.a;
+}
+
+float Damping::circular(DampingState& state, float angle, float dtS, float tauS) {
+    float s, c;
+    sinCos(angle, s, c);
+    if (!state.primed) {
+        state.a = s;
+        state.b = c;
+        state.primed = true;
+    } else {
+        float alpha = dtS / (tauS + dtS);
+        state.a += alpha * (s - state.a);
+        state.b += alpha * (c - state.b);
+    }
+    return arcTan2(state.a, state.b);
+}
+
+float Damping::kalman(DampingState& state, float z, float dtS, float tauS) {
+    if (!state.primed) {
+        state.a = z;
+        state.b = 1.0f;  // Measurement variance of a 1 s sample
+        state.primed = true;
+        return z;
+    }
+
+    // Predict: random walk, process noise 1/tau² per second
+    float predicted = state.b + dtS / (tauS * tauS);
+
+    // Update: measurement variance 1/dt (noise density 1), so a sample
+    // arriving in the same millisecond (dt = 0) is ignored
+    float gain = predicted * dtS / (predicted * dtS + 1.0f);
+    state.a += gain * (z - state.a);
+    state.b = (1.0f - gain) * predicted;
+    return state.a;
+}
+
+// =============================================================================
+// FILTER BANK
+// =============================================================================
+
+DampingFilters::DampingFilters() {
+    reset();
+}
+
+void DampingFilters::reset() {
+    for (uint8_t i = 0; i < DAMPING_FIELD_COUNT; i++) {
+        slots_[i].state = DampingState();
+        slots_[i].lastMs = 0;
+        slots_[i].kalman = false;
+    }
+}
+
+BoatScalar DampingFilters::apply(DampingField field, BoatScalar value, const DampingConfig& config, uint32_t nowMs) {
+    if (field >= DAMPING_FIELD_COUNT) {
+        return value;
+    }
+    Slot& slot = slots_[field];
+
+    float tau = config.timeConstant[field];
+    if (!(tau > 0.0f)) {
+        slot.state.primed = false;  // Off: start fresh when re-enabled
+        return value;
+    }
+    if (!std::isfinite(value)) {
+        return value;
+    }
+
+    uint8_t fieldKind = FIELD_KINDS[field];
+    bool useKalman = fieldKind == DAMPING_KIND_SCALAR && (config.kalmanMask & (1u << field)) != 0;
+    if (useKalman != slot.kalman) {
+        slot.state = DampingState();
+        slot.kalman = useKalman;
+    }
+
+    float dt = slot.state.primed ? static_cast<float>(nowMs - slot.lastMs) * 0.001f : 0.0f;
+    slot.lastMs = nowMs;
+
+    float sample = static_cast<float>(value);
+    float filtered;
+    switch (fieldKind) {
+        case DAMPING_KIND_SIGNED_ANGLE:
+            filtered = Damping::circular(slot.state, sample, dt, tau);
+            break;
+        case DAMPING_KIND_BEARING:
+            filtered = Damping::circular(slot.state, sample, dt, tau);
+            if (filtered < 0.0f) {
+                filtered += FastMath::TWO_PI_F;
+            }
+            break;
+        default:
+            filtered = useKalman ? Damping::kalman(slot.state, sample, dt, tau)
+                                 : Damping::ema(slot.state, sample, dt, tau);
+            break;
+    }
+    return static_cast<BoatScalar>(filtered);
+}
+
+uint8_t DampingFilters::kind(DampingField field) {
+    return field < DAMPING_FIELD_COUNT ? FIELD_KINDS[field] : DAMPING_KIND_SCALAR;
+}
+
+const char* DampingFilters::key(DampingField field) {
+    return field < DAMPING_FIELD_COUNT ? FIELD_KEYS[field] : "";
+}
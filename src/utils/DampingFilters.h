@@ -0,0 +1,123 @@
+/**
+ * @file DampingFilters.h
+ * @brief O(1), fixed-state damping filters for noisy sensor and derived values
+ *
+ * Three single-value filters on a 12-byte DampingState, each parameterized
+ * by a time constant tau (seconds) and driven by the actual time between
+ * samples, so irregular update rates damp the same as a steady stream:
+ * - ema(): exponential moving average, alpha = dt / (tau + dt)
+ * - circular(): EMA of sin/cos accumulators and atan2 of the result, so
+ *   angles average correctly across ±π / 0-2π (350° and 10° give 0°)
+ * - kalman(): random-walk model with measurement noise density 1 and
+ *   process noise 1/tau², so its steady state is close to an EMA with the
+ *   same tau at any sample rate, while the error covariance lets it
+ *   converge at once after startup or a data gap
+ *
+ * DampingFilters holds one state per DampingField and applies the kind and
+ * time constant from a DampingConfig. Non-finite samples pass through
+ * without touching the state.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): 20 bytes per field, zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef DAMPING_FILTERS_H
+#define DAMPING_FILTERS_H
+
+#include <stdint.h>
+#include "../types/DampingConfig.h"
+#include "../types/BoatScalar.h"
+
+/**
+ * @brief State of one filter (meaning of a/b depends on the filter)
+ */
+struct DampingState {
+    float a;       ///< EMA/Kalman: estimate; circular: sin accumulator
+    float b;       ///< Kalman: error covariance; circular: cos accumulator
+    bool primed;   ///< a/b hold a previous sample
+
+    DampingState() : a(0.0f), b(0.0f), primed(false) {}
+};
+
+namespace Damping {
+
+/**
+ * @brief Exponential moving average
+ *
+ * @param state Filter state
+ * @param x Sample
+ * @param dtS Seconds since the previous sample
+ * @param tauS Time constant (seconds, > 0)
+ * @return Filtered value (the sample itself when not primed)
+ */
+float ema(DampingState& state, float x, float dtS, float tauS);
+
+/**
+ * @brief Circular mean of angles
+ *
+ * @param angle Sample, radians
+ * @return Filtered angle, radians [-π, π]
+ */
+float circular(DampingState& state, float angle, float dtS, float tauS);
+
+/**
+ * @brief Scalar Kalman filter (random walk)
+ *
+ * @return Filtered estimate
+ */
+float kalman(DampingState& state, float z, float dtS, float tauS);
+
+}  // namespace Damping
+
+/**
+ * @class DampingFilters
+ * @brief One filter per DampingField, configured by a DampingConfig
+ */
+class DampingFilters {
+public:
+    DampingFilters();
+
+    /**
+     * @brief Filter a new sample of @p field
+     *
+     * A time constant of 0 (off) resets the field's state and returns
+     * @p value unchanged, so re-enabling starts fresh. Filtering itself
+     * runs in float.
+     *
+     * @param field Which value
+     * @param value Sample (radians for angle fields)
+     * @param config Time constants and Kalman selection
+     * @param nowMs millis() of the sample
+     * @return Filtered value (angles in the field's range)
+     */
+    BoatScalar apply(DampingField field, BoatScalar value, const DampingConfig& config, uint32_t nowMs);
+
+    /**
+     * @brief Forget all history (e.g. after the inputs went stale)
+     */
+    void reset();
+
+    /**
+     * @brief Kind of @p field (DAMPING_KIND_*)
+     */
+    static uint8_t kind(DampingField field);
+
+    /**
+     * @brief JSON key of @p field ("awa", "boatSpeed", ...)
+     */
+    static const char* key(DampingField field);
+
+private:
+    struct Slot {
+        DampingState state;
+        uint32_t lastMs;   ///< millis() of the previous sample (valid when state.primed)
+        bool kalman;       ///< Filter the state was built with
+    };
+
+    Slot slots_[DAMPING_FIELD_COUNT];
+};
+
+#endif // DAMPING_FILTERS_H
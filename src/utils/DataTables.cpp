@@ -0,0 +1,130 @@
+/**
+ * @file DataTables.cpp
+ * @brief Implementation of the data table directory
+ *
+ * @see DataTables.h
+ */
+
+#include "DataTables.h"
+#include "ConfigRecord.h"
+
+namespace {
+
+constexpr size_t NAME_OFFSET = 0;
+constexpr size_t TYPE_OFFSET = 12;
+constexpr size_t VERSION_OFFSET = 14;
+constexpr size_t DATA_OFFSET = 16;
+constexpr size_t LENGTH_OFFSET = 20;
+constexpr size_t CRC_OFFSET = 24;
+
+static_assert(DATA_TABLES_NAME_MAX == TYPE_OFFSET - NAME_OFFSET, "Entry name field size");
+static_assert(DATA_TABLES_ENTRY_BYTES == CRC_OFFSET + 4, "Entry size");
+
+}  // namespace
+
+const char* DataTablesStatusName(DataTablesStatus status) {
+    switch (status) {
+        case DataTablesStatus::OK:         return "ok";
+        case DataTablesStatus::EMPTY:      return "empty";
+        case DataTablesStatus::TRUNCATED:  return "truncated";
+        case DataTablesStatus::BAD_MAGIC:  return "bad_magic";
+        case DataTablesStatus::BAD_FORMAT: return "bad_format";
+        case DataTablesStatus::BAD_CRC:    return "bad_crc";
+    }
+    return "unknown";
+}
+
+DataTables::DataTables()
+    : image_(nullptr),
+      imageBytes_(0),
+      count_(0),
+      status_(DataTablesStatus::EMPTY) {
+}
+
+DataTablesStatus DataTables::open(const uint8_t* image, size_t size) {
+    image_ = image;
+    imageBytes_ = 0;
+    count_ = 0;
+    status_ = DataTablesStatus::EMPTY;
+    if (image == nullptr || size == 0) {
+        return status_;
+    }
+    if (size < DATA_TABLES_HEADER_BYTES) {
+        return status_ = DataTablesStatus::TRUNCATED;
+    }
+
+    uint32_t magic = DataTableReadU32(image);
+    if (magic == 0xFFFFFFFFUL) {
+        return status_;  // Erased: nothing flashed yet
+    }
+    if (magic != DATA_TABLES_MAGIC) {
+        return status_ = DataTablesStatus::BAD_MAGIC;
+    }
+    if (DataTableReadU16(image + 4) != DATA_TABLES_FORMAT) {
+        return status_ = DataTablesStatus::BAD_FORMAT;
+    }
+
+    uint16_t count = DataTableReadU16(image + 6);
+    uint32_t bytes = DataTableReadU32(image + 8);
+    size_t directoryBytes = static_cast<size_t>(count) * DATA_TABLES_ENTRY_BYTES;
+    if (count > DATA_TABLES_MAX_ENTRIES || bytes > size ||
+        bytes < DATA_TABLES_HEADER_BYTES + directoryBytes) {
+        return status_ = DataTablesStatus::TRUNCATED;
+    }
+    if (ConfigCrc32(image + DATA_TABLES_HEADER_BYTES, directoryBytes) != DataTableReadU32(image + 12)) {
+        return status_ = DataTablesStatus::BAD_CRC;
+    }
+
+    for (uint16_t i = 0; i < count; i++) {
+        const uint8_t* e = image + DATA_TABLES_HEADER_BYTES + static_cast<size_t>(i) * DATA_TABLES_ENTRY_BYTES;
+        uint32_t offset = DataTableReadU32(e + DATA_OFFSET);
+        uint32_t length = DataTableReadU32(e + LENGTH_OFFSET);
+        if (offset > bytes || length > bytes - offset) {
+            return status_ = DataTablesStatus::TRUNCATED;
+        }
+        if (ConfigCrc32(image + offset, length) != DataTableReadU32(e + CRC_OFFSET)) {
+            return status_ = DataTablesStatus::BAD_CRC;
+        }
+    }
+
+    imageBytes_ = bytes;
+    count_ = count;
+    return status_ = DataTablesStatus::OK;
+}
+
+bool DataTables::find(DataTableType type, DataTableView& out) const {
+    for (uint16_t i = 0; i < count(); i++) {
+        const uint8_t* e = entry(i);
+        if (DataTableReadU16(e + TYPE_OFFSET) == static_cast<uint16_t>(type)) {
+            out.data = image_ + DataTableReadU32(e + DATA_OFFSET);
+            out.length = DataTableReadU32(e + LENGTH_OFFSET);
+            out.version = DataTableReadU16(e + VERSION_OFFSET);
+            return true;
+        }
+    }
+    return false;
+}
+
+void DataTables::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("status", DataTablesStatusName(status_))
+        .add("bytes", (unsigned long)getImageBytes())
+        .beginArray("tables");
+    for (uint16_t i = 0; i < count(); i++) {
+        const uint8_t* e = entry(i);
+        char name[DATA_TABLES_NAME_MAX + 1];
+        memcpy(name, e + NAME_OFFSET, DATA_TABLES_NAME_MAX);
+        name[DATA_TABLES_NAME_MAX] = '\0';
+        json.beginObject()
+            .add("name", name)
+            .add("type", (unsigned int)DataTableReadU16(e + TYPE_OFFSET))
+            .add("version", (unsigned int)DataTableReadU16(e + VERSION_OFFSET))
+            .add("bytes", (unsigned long)DataTableReadU32(e + LENGTH_OFFSET))
+            .endObject();
+    }
+    json.endArray().endObject();
+}
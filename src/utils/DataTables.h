@@ -0,0 +1,171 @@
+/**
+ * @file DataTables.h
+ * @brief Directory of read-only tables in the "tables" flash partition
+ *
+ * Large read-only tables (boat polar, magnetic variation grid) are built on
+ * the host by tools/data_tables.py and flashed to their own data partition
+ * (partitions.csv, DATA_TABLES_PARTITION), separately from firmware and
+ * LittleFS. The partition is mapped into the data address space once at
+ * boot (esp_partition_mmap) and the tables are read where they lie: no heap,
+ * no copy, no parse. Rebuilding a table does not rebuild the firmware.
+ *
+ * Image layout (little-endian):
+ *   offset 0   uint32 magic    DATA_TABLES_MAGIC ("PTBL")
+ *   offset 4   uint16 format   DATA_TABLES_FORMAT (directory layout)
+ *   offset 6   uint16 count    directory entries
+ *   offset 8   uint32 bytes    image length (header, directory and payloads)
+ *   offset 12  uint32 crc      CRC-32 (IEEE) of the directory
+ *   offset 16  count x 28-byte entries:
+ *              char[12] name (NUL padded), uint16 type, uint16 version,
+ *              uint32 offset, uint32 length (payload, from the image start),
+ *              uint32 crc (CRC-32 of the payload)
+ *
+ * open() checks the header, the directory CRC, every payload range and
+ * every payload CRC, so a half-flashed or stale image is rejected as a whole
+ * and the owners fall back to their files. A reader looks its table up by
+ * type and checks the version it understands; types it does not know are
+ * listed and ignored.
+ *
+ * Flash through the cache may only be read with aligned accesses: payload
+ * fields are copied out with DataTableRead*() (memcpy), never cast.
+ *
+ * Arduino-free (unit tested natively on a byte array). Main loop only.
+ *
+ * Usage:
+ * @code
+ * DataTables tables;
+ * if (tables.open(mapped, partitionSize) == DataTablesStatus::OK) {
+ *     DataTableView polar;
+ *     if (tables.find(DataTableType::POLAR, polar) && polar.version == POLAR_TABLE_VERSION) {
+ *         polarTable.loadBinary(polar.data, polar.length);
+ *     }
+ * }
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef DATA_TABLES_H
+#define DATA_TABLES_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/// "PTBL" read as a little-endian uint32
+#define DATA_TABLES_MAGIC 0x4C425450UL
+#define DATA_TABLES_FORMAT 1
+#define DATA_TABLES_HEADER_BYTES 16
+#define DATA_TABLES_ENTRY_BYTES 28
+#define DATA_TABLES_NAME_MAX 12
+
+/**
+ * @brief Payload kinds (entry type field)
+ */
+enum class DataTableType : uint16_t {
+    POLAR = 1,        ///< Boat polar grid (PolarTable::loadBinary())
+    VARIATION = 2     ///< Magnetic variation grid (VariationGrid::attach())
+};
+
+/**
+ * @brief Result of DataTables::open()
+ */
+enum class DataTablesStatus : uint8_t {
+    OK = 0,
+    EMPTY,        ///< No partition, or erased flash
+    TRUNCATED,    ///< Image or an entry extends past the partition
+    BAD_MAGIC,
+    BAD_FORMAT,   ///< Directory layout newer than this firmware
+    BAD_CRC       ///< Directory or a payload damaged
+};
+
+/// "ok", "empty", "truncated", "bad_magic", "bad_format", "bad_crc"
+const char* DataTablesStatusName(DataTablesStatus status);
+
+inline uint16_t DataTableReadU16(const uint8_t* p) {
+    uint8_t b[2];
+    memcpy(b, p, sizeof(b));
+    return static_cast<uint16_t>(b[0] | (b[1] << 8));
+}
+
+inline uint32_t DataTableReadU32(const uint8_t* p) {
+    uint8_t b[4];
+    memcpy(b, p, sizeof(b));
+    return static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) |
+           (static_cast<uint32_t>(b[2]) << 16) | (static_cast<uint32_t>(b[3]) << 24);
+}
+
+inline int16_t DataTableReadI16(const uint8_t* p) {
+    return static_cast<int16_t>(DataTableReadU16(p));
+}
+
+inline float DataTableReadF32(const uint8_t* p) {
+    uint32_t bits = DataTableReadU32(p);
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/**
+ * @brief One table in place
+ */
+struct DataTableView {
+    const uint8_t* data;   ///< Payload in the mapped partition
+    uint32_t length;       ///< Payload bytes
+    uint16_t version;      ///< Payload layout version of its type
+};
+
+/**
+ * @class DataTables
+ * @brief Verified directory of a mapped table image
+ */
+class DataTables {
+public:
+    DataTables();
+
+    /**
+     * @brief Verify the image at @p image
+     *
+     * @param size Bytes mapped (the partition size)
+     * @return OK if the directory and every payload verify (find() works only then)
+     */
+    DataTablesStatus open(const uint8_t* image, size_t size);
+
+    DataTablesStatus getStatus() const { return status_; }
+    bool isOpen() const { return status_ == DataTablesStatus::OK; }
+
+    /// Entries of the open image (0 if not open)
+    uint16_t count() const { return isOpen() ? count_ : 0; }
+
+    /// Image length in the partition (header, directory and payloads)
+    uint32_t getImageBytes() const { return isOpen() ? imageBytes_ : 0; }
+
+    /**
+     * @brief First table of @p type
+     *
+     * @return false if not open or no such table (out untouched)
+     */
+    bool find(DataTableType type, DataTableView& out) const;
+
+    /**
+     * @brief Write the directory as a JSON object
+     *
+     * {"status":"ok","bytes":5120,"tables":[{"name":"polar","type":1,"version":1,"bytes":2312}]}
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    const uint8_t* entry(uint16_t index) const {
+        return image_ + DATA_TABLES_HEADER_BYTES + static_cast<size_t>(index) * DATA_TABLES_ENTRY_BYTES;
+    }
+
+    const uint8_t* image_;
+    uint32_t imageBytes_;
+    uint16_t count_;
+    DataTablesStatus status_;
+};
+
+#endif // DATA_TABLES_H
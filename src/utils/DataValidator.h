@@ -10,6 +10,15 @@
  * Validation thresholds are based on marine sensor characteristics and boat
  * dynamics research.
  *
+ * BoatData's update paths use the range checks only and test the change
+ * against each field's recent history instead (HampelFilter.h); the
+ * rate-of-change checks remain for callers without a history.
+ *
+ * Values are BoatScalar (BoatData storage precision); latitude/longitude
+ * checks stay double. The ranges are the Range types of DataValidation.h
+ * (one definition per field, from BOATDATA_SCHEMA_FIELDS), compared in
+ * the argument's precision.
+ *
  * @see specs/003-boatdata-feature-as/research.md lines 236-274 (outlier detection)
  * @see specs/003-boatdata-feature-as/data-model.md lines 129-145 (validation rules)
  * @see test/unit/test_range_validation.cpp
@@ -21,8 +30,12 @@
 #ifndef DATA_VALIDATOR_H
 #define DATA_VALIDATOR_H
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
+#include <cmath>
 #include "AngleUtils.h"
+#include "DataValidation.h"
 
 /**
  * @brief Utility class for sensor data validation
@@ -49,7 +62,7 @@ public:
      * @return true if valid, false if out of range
      */
     static bool isValidLatitude(double lat) {
-        return lat >= -90.0 && lat <= 90.0;
+        return DataValidation::LatitudeRange::contains(lat);
     }
 
     /**
@@ -61,7 +74,7 @@ public:
      * @return true if valid, false if out of range
      */
     static bool isValidLongitude(double lon) {
-        return lon >= -180.0 && lon <= 180.0;
+        return DataValidation::LongitudeRange::contains(lon);
     }
 
     /**
@@ -72,8 +85,8 @@ public:
      * @param cog Course in radians
      * @return true if valid, false if out of range
      */
-    static bool isValidCOG(double cog) {
-        return cog >= 0.0 && cog <= 2 * M_PI;
+    static bool isValidCOG(BoatScalar cog) {
+        return DataValidation::CourseRange::contains(cog);
     }
 
     /**
@@ -84,8 +97,8 @@ public:
      * @param sog Speed in knots
      * @return true if valid, false if negative or excessive
      */
-    static bool isValidSOG(double sog) {
-        return sog >= 0.0 && sog <= 100.0;
+    static bool isValidSOG(BoatScalar sog) {
+        return DataValidation::SogRange::contains(sog);
     }
 
     /**
@@ -96,8 +109,8 @@ public:
      * @param heading Heading in radians
      * @return true if valid, false if out of range
      */
-    static bool isValidHeading(double heading) {
-        return heading >= 0.0 && heading <= 2 * M_PI;
+    static bool isValidHeading(BoatScalar heading) {
+        return DataValidation::CourseRange::contains(heading);
     }
 
     /**
@@ -108,8 +121,8 @@ public:
      * @param awa Apparent wind angle in radians
      * @return true if valid, false if out of range
      */
-    static bool isValidAWA(double awa) {
-        return awa >= -M_PI && awa <= M_PI;
+    static bool isValidAWA(BoatScalar awa) {
+        return DataValidation::WindAngleRange::contains(awa);
     }
 
     /**
@@ -120,8 +133,8 @@ public:
      * @param speed Wind speed in knots
      * @return true if valid, false if negative or excessive
      */
-    static bool isValidWindSpeed(double speed) {
-        return speed >= 0.0 && speed <= 100.0;
+    static bool isValidWindSpeed(BoatScalar speed) {
+        return DataValidation::WindSpeedRange::contains(speed);
     }
 
     /**
@@ -132,8 +145,8 @@ public:
      * @param heel Heel angle in radians
      * @return true if valid, false if out of range
      */
-    static bool isValidHeelAngle(double heel) {
-        return heel >= -M_PI / 2 && heel <= M_PI / 2;
+    static bool isValidHeelAngle(BoatScalar heel) {
+        return DataValidation::HeelRange::contains(heel);
     }
 
     /**
@@ -144,8 +157,8 @@ public:
      * @param speed Boat speed in knots
      * @return true if valid, false if negative or excessive
      */
-    static bool isValidBoatSpeed(double speed) {
-        return speed >= 0.0 && speed <= 50.0;
+    static bool isValidBoatSpeed(BoatScalar speed) {
+        return DataValidation::BoatSpeedKnotsBand::contains(speed);
     }
 
     /**
@@ -156,8 +169,8 @@ public:
      * @param angle Rudder angle in radians
      * @return true if valid, false if out of range
      */
-    static bool isValidRudderAngle(double angle) {
-        return angle >= -M_PI / 2 && angle <= M_PI / 2;
+    static bool isValidRudderAngle(BoatScalar angle) {
+        return DataValidation::RudderAngleRange::contains(angle);
     }
 
     // =========================================================================
@@ -182,8 +195,8 @@ public:
         if (deltaTime == 0) return true;  // Avoid divide-by-zero
 
         double deltaSeconds = deltaTime / 1000.0;
-        double latChange = fabs(newLat - prevLat);
-        double lonChange = fabs(newLon - prevLon);
+        double latChange = std::fabs(newLat - prevLat);
+        double lonChange = std::fabs(newLon - prevLon);
 
         // Maximum change per second: 0.1°
         const double MAX_CHANGE_PER_SEC = 0.1;
@@ -204,19 +217,19 @@ public:
      * @param deltaTime Time since last update (milliseconds)
      * @return true if change is reasonable, false if too fast
      */
-    static bool isValidHeadingRateOfChange(double prevHeading, double newHeading,
+    static bool isValidHeadingRateOfChange(BoatScalar prevHeading, BoatScalar newHeading,
                                             unsigned long deltaTime) {
         if (deltaTime == 0) return true;
 
-        double deltaSeconds = deltaTime / 1000.0;
+        BoatScalar deltaSeconds = static_cast<BoatScalar>(deltaTime) / BoatScalar(1000);
 
         // Calculate heading change with wraparound handling
-        double change = fabs(AngleUtils::angleDifference(prevHeading, newHeading));
+        BoatScalar change = std::fabs(AngleUtils::angleDifference(prevHeading, newHeading));
 
         // Maximum change per second: π radians (180°)
-        const double MAX_CHANGE_PER_SEC = M_PI;
+        const BoatScalar MAX_CHANGE_PER_SEC = BoatMath::PI_RAD;
 
-        double rate = change / deltaSeconds;
+        BoatScalar rate = change / deltaSeconds;
 
         return rate <= MAX_CHANGE_PER_SEC;
     }
@@ -233,14 +246,14 @@ public:
      * @param maxRate Maximum rate of change (knots/second), default 10.0
      * @return true if change is reasonable, false if too fast
      */
-    static bool isValidSpeedRateOfChange(double prevSpeed, double newSpeed,
+    static bool isValidSpeedRateOfChange(BoatScalar prevSpeed, BoatScalar newSpeed,
                                           unsigned long deltaTime,
-                                          double maxRate = 10.0) {
+                                          BoatScalar maxRate = BoatScalar(10)) {
         if (deltaTime == 0) return true;
 
-        double deltaSeconds = deltaTime / 1000.0;
-        double change = fabs(newSpeed - prevSpeed);
-        double rate = change / deltaSeconds;
+        BoatScalar deltaSeconds = static_cast<BoatScalar>(deltaTime) / BoatScalar(1000);
+        BoatScalar change = std::fabs(newSpeed - prevSpeed);
+        BoatScalar rate = change / deltaSeconds;
 
         return rate <= maxRate;
     }
@@ -255,19 +268,19 @@ public:
      * @param deltaTime Time since last update (milliseconds)
      * @return true if change is reasonable, false if too fast
      */
-    static bool isValidWindAngleRateOfChange(double prevAWA, double newAWA,
+    static bool isValidWindAngleRateOfChange(BoatScalar prevAWA, BoatScalar newAWA,
                                               unsigned long deltaTime) {
         if (deltaTime == 0) return true;
 
-        double deltaSeconds = deltaTime / 1000.0;
+        BoatScalar deltaSeconds = static_cast<BoatScalar>(deltaTime) / BoatScalar(1000);
 
         // Calculate angle change with wraparound
-        double change = fabs(AngleUtils::angleDifference(prevAWA, newAWA));
+        BoatScalar change = std::fabs(AngleUtils::angleDifference(prevAWA, newAWA));
 
         // Maximum change per second: 2π radians (360°)
-        const double MAX_CHANGE_PER_SEC = 2 * M_PI;
+        const BoatScalar MAX_CHANGE_PER_SEC = BoatMath::TWO_PI_RAD;
 
-        double rate = change / deltaSeconds;
+        BoatScalar rate = change / deltaSeconds;
 
         return rate <= MAX_CHANGE_PER_SEC;
     }
@@ -282,9 +295,9 @@ public:
      * @param deltaTime Time since last update (milliseconds)
      * @return true if change is reasonable, false if too fast
      */
-    static bool isValidWindSpeedRateOfChange(double prevAWS, double newAWS,
+    static bool isValidWindSpeedRateOfChange(BoatScalar prevAWS, BoatScalar newAWS,
                                               unsigned long deltaTime) {
-        return isValidSpeedRateOfChange(prevAWS, newAWS, deltaTime, 30.0);
+        return isValidSpeedRateOfChange(prevAWS, newAWS, deltaTime, BoatScalar(30));
     }
 
     /**
@@ -297,17 +310,17 @@ public:
      * @param deltaTime Time since last update (milliseconds)
      * @return true if change is reasonable, false if too fast
      */
-    static bool isValidHeelRateOfChange(double prevHeel, double newHeel,
+    static bool isValidHeelRateOfChange(BoatScalar prevHeel, BoatScalar newHeel,
                                          unsigned long deltaTime) {
         if (deltaTime == 0) return true;
 
-        double deltaSeconds = deltaTime / 1000.0;
-        double change = fabs(newHeel - prevHeel);
+        BoatScalar deltaSeconds = static_cast<BoatScalar>(deltaTime) / BoatScalar(1000);
+        BoatScalar change = std::fabs(newHeel - prevHeel);
 
         // Maximum change per second: π/4 radians (45°)
-        const double MAX_CHANGE_PER_SEC = M_PI / 4;
+        const BoatScalar MAX_CHANGE_PER_SEC = BoatMath::QUARTER_PI_RAD;
 
-        double rate = change / deltaSeconds;
+        BoatScalar rate = change / deltaSeconds;
 
         return rate <= MAX_CHANGE_PER_SEC;
     }
@@ -322,17 +335,17 @@ public:
      * @param deltaTime Time since last update (milliseconds)
      * @return true if change is reasonable, false if too fast
      */
-    static bool isValidRudderRateOfChange(double prevAngle, double newAngle,
+    static bool isValidRudderRateOfChange(BoatScalar prevAngle, BoatScalar newAngle,
                                            unsigned long deltaTime) {
         if (deltaTime == 0) return true;
 
-        double deltaSeconds = deltaTime / 1000.0;
-        double change = fabs(newAngle - prevAngle);
+        BoatScalar deltaSeconds = static_cast<BoatScalar>(deltaTime) / BoatScalar(1000);
+        BoatScalar change = std::fabs(newAngle - prevAngle);
 
         // Maximum change per second: π/3 radians (60°)
-        const double MAX_CHANGE_PER_SEC = M_PI / 3;
+        const BoatScalar MAX_CHANGE_PER_SEC = BoatMath::PI_RAD / BoatScalar(3);
 
-        double rate = change / deltaSeconds;
+        BoatScalar rate = change / deltaSeconds;
 
         return rate <= MAX_CHANGE_PER_SEC;
     }
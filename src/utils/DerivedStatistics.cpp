@@ -0,0 +1,193 @@
+/**
+ * @file DerivedStatistics.cpp
+ * @brief Implementation of the derived data sliding windows
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "DerivedStatistics.h"
+#include <math.h>
+#include "AngleUtils.h"
+
+namespace {
+
+const uint32_t WINDOW_MS[DerivedStatistics::WINDOW_COUNT] = {10000, 60000, 600000};
+
+/// Signed a - b of two millis() timestamps
+inline int32_t elapsed(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b);
+}
+
+}  // namespace
+
+// =============================================================================
+// StatsWindow
+// =============================================================================
+
+StatsWindow::StatsWindow() : bucketMs_(1000) {
+    reset();
+}
+
+void StatsWindow::begin(uint32_t bucketMs) {
+    bucketMs_ = bucketMs > 0 ? bucketMs : 1;
+    reset();
+}
+
+void StatsWindow::clearBucket(Bucket& bucket) {
+    bucket.twsSum = bucket.vmgSum = bucket.sinSum = bucket.cosSum = 0.0f;
+    bucket.twsMax = -1.0f;
+    bucket.count = 0;
+}
+
+void StatsWindow::reset() {
+    clearBucket(open_);
+    head_ = size_ = 0;
+    dequeHead_ = dequeSize_ = 0;
+    twsSum_ = vmgSum_ = sinSum_ = cosSum_ = 0.0;
+    count_ = 0;
+    openStartMs_ = 0;
+    started_ = false;
+}
+
+void StatsWindow::closeBucket() {
+    if (size_ == CLOSED) {
+        // Evict the oldest bucket (the slot about to be reused)
+        const Bucket& old = ring_[head_];
+        twsSum_ -= old.twsSum;
+        vmgSum_ -= old.vmgSum;
+        sinSum_ -= old.sinSum;
+        cosSum_ -= old.cosSum;
+        count_ -= old.count;
+        if (count_ == 0) {
+            twsSum_ = vmgSum_ = sinSum_ = cosSum_ = 0.0;  // Drop rounding residue
+        }
+        if (dequeSize_ > 0 && deque_[dequeHead_] == head_) {
+            dequeHead_ = (dequeHead_ + 1) % CLOSED;
+            dequeSize_--;
+        }
+        size_--;
+    }
+
+    uint8_t slot = head_;
+    ring_[slot] = open_;
+    twsSum_ += open_.twsSum;
+    vmgSum_ += open_.vmgSum;
+    sinSum_ += open_.sinSum;
+    cosSum_ += open_.cosSum;
+    count_ += open_.count;
+    head_ = (head_ + 1) % CLOSED;
+    size_++;
+
+    // Drop maxima the new bucket outlives and exceeds
+    while (dequeSize_ > 0 &&
+           ring_[deque_[(dequeHead_ + dequeSize_ - 1) % CLOSED]].twsMax <= open_.twsMax) {
+        dequeSize_--;
+    }
+    deque_[(dequeHead_ + dequeSize_) % CLOSED] = slot;
+    dequeSize_++;
+
+    clearBucket(open_);
+}
+
+void StatsWindow::advance(uint32_t nowMs) {
+    if (!started_) {
+        openStartMs_ = nowMs;
+        started_ = true;
+        return;
+    }
+
+    int32_t behind = elapsed(nowMs, openStartMs_);
+    if (behind < 0) {
+        return;  // Out of order: stays in the open bucket
+    }
+    if (static_cast<uint32_t>(behind) >= bucketMs_ * STATS_WINDOW_BUCKETS) {
+        // The whole window passed without samples
+        reset();
+        openStartMs_ = nowMs;
+        started_ = true;
+        return;
+    }
+    while (static_cast<uint32_t>(behind) >= bucketMs_) {
+        closeBucket();
+        openStartMs_ += bucketMs_;
+        behind -= static_cast<int32_t>(bucketMs_);
+    }
+}
+
+void StatsWindow::add(uint32_t nowMs, float tws, float wdir, float vmg) {
+    advance(nowMs);
+    if (!isfinite(tws) || !isfinite(wdir) || !isfinite(vmg)) {
+        return;
+    }
+    open_.twsSum += tws;
+    open_.vmgSum += vmg;
+    open_.sinSum += sinf(wdir);
+    open_.cosSum += cosf(wdir);
+    if (tws > open_.twsMax) {
+        open_.twsMax = tws;
+    }
+    if (open_.count < UINT16_MAX) {
+        open_.count++;
+    }
+}
+
+void StatsWindow::result(StatsResult& out) const {
+    uint32_t n = count_ + open_.count;
+    if (n == 0) {
+        out.twsAvg = out.wdirAvg = out.vmgAvg = out.gust = NAN;
+        return;
+    }
+    out.twsAvg = static_cast<float>((twsSum_ + open_.twsSum) / n);
+    out.vmgAvg = static_cast<float>((vmgSum_ + open_.vmgSum) / n);
+    out.wdirAvg = static_cast<float>(AngleUtils::normalizeToZeroTwoPi(static_cast<BoatScalar>(
+        atan2(sinSum_ + open_.sinSum, cosSum_ + open_.cosSum))));
+
+    float gust = open_.twsMax;
+    if (dequeSize_ > 0 && ring_[deque_[dequeHead_]].twsMax > gust) {
+        gust = ring_[deque_[dequeHead_]].twsMax;
+    }
+    out.gust = gust;
+}
+
+// =============================================================================
+// DerivedStatistics
+// =============================================================================
+
+DerivedStatistics::DerivedStatistics() {
+    for (uint8_t i = 0; i < WINDOW_COUNT; i++) {
+        windows_[i].begin(WINDOW_MS[i] / STATS_WINDOW_BUCKETS);
+    }
+}
+
+uint32_t DerivedStatistics::windowMs(uint8_t index) {
+    return index < WINDOW_COUNT ? WINDOW_MS[index] : 0;
+}
+
+void DerivedStatistics::reset() {
+    for (uint8_t i = 0; i < WINDOW_COUNT; i++) {
+        windows_[i].reset();
+    }
+}
+
+void DerivedStatistics::update(DerivedData& derived, uint32_t nowMs) {
+    StatsResult r[WINDOW_COUNT];
+    for (uint8_t i = 0; i < WINDOW_COUNT; i++) {
+        windows_[i].add(nowMs, static_cast<float>(derived.tws), static_cast<float>(derived.wdir),
+                        static_cast<float>(derived.vmg));
+        windows_[i].result(r[i]);
+    }
+
+    derived.twsAvg10s = r[0].twsAvg;
+    derived.twsAvg1m = r[1].twsAvg;
+    derived.twsAvg10m = r[2].twsAvg;
+    derived.wdirAvg10s = r[0].wdirAvg;
+    derived.wdirAvg1m = r[1].wdirAvg;
+    derived.wdirAvg10m = r[2].wdirAvg;
+    derived.vmgAvg10s = r[0].vmgAvg;
+    derived.vmgAvg1m = r[1].vmgAvg;
+    derived.vmgAvg10m = r[2].vmgAvg;
+    derived.gust10s = r[0].gust;
+    derived.gust1m = r[1].gust;
+    derived.gust10m = r[2].gust;
+}
@@ -0,0 +1,146 @@
+/**
+ * @file DerivedStatistics.h
+ * @brief Sliding-window averages and gust maxima of the derived true wind and VMG
+ *
+ * Three windows (10 s, 1 min, 10 min) each publish the mean TWS, the
+ * circular mean WDIR, the mean VMG and the TWS maximum (gust). A window is
+ * a ring of STATS_WINDOW_BUCKETS buckets of window / STATS_WINDOW_BUCKETS
+ * each (0.5 s, 3 s, 30 s). Every sample is folded into the open bucket;
+ * when the bucket closes its sums are added to the window's running sums
+ * and the sums of the bucket leaving the window are subtracted, so an
+ * update is O(1) whatever the sample rate:
+ * - TWS / VMG: running sums, mean = sum / count
+ * - WDIR: running sums of sin/cos, mean = atan2 (350° and 10° give 0°)
+ * - gust: monotonic deque of bucket maxima (front = window maximum), each
+ *   bucket pushed and popped at most once
+ *
+ * The window covers its closed buckets plus the open one, i.e. its length
+ * to within one bucket. Time without samples passes as empty buckets, so a
+ * data dropout ages out instead of freezing the averages; a window without
+ * samples publishes NaN. Non-finite samples are skipped.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed rings (~1.7 KB), zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef DERIVED_STATISTICS_H
+#define DERIVED_STATISTICS_H
+
+#include <stdint.h>
+#include "../types/BoatDataTypes.h"
+#include "../config.h"
+
+/**
+ * @brief Published values of one window (NaN without samples)
+ */
+struct StatsResult {
+    float twsAvg;    ///< knots
+    float wdirAvg;   ///< radians, [0, 2π)
+    float vmgAvg;    ///< knots, signed
+    float gust;      ///< TWS maximum, knots
+};
+
+/**
+ * @class StatsWindow
+ * @brief One sliding window of STATS_WINDOW_BUCKETS buckets
+ */
+class StatsWindow {
+public:
+    StatsWindow();
+
+    /**
+     * @brief Set the bucket length and start empty
+     *
+     * @param bucketMs Bucket length (window = STATS_WINDOW_BUCKETS x bucketMs)
+     */
+    void begin(uint32_t bucketMs);
+
+    /// Forget all samples
+    void reset();
+
+    /**
+     * @brief Fold one sample taken at @p nowMs into the window
+     *
+     * @param wdir Wind direction (radians)
+     */
+    void add(uint32_t nowMs, float tws, float wdir, float vmg);
+
+    /**
+     * @brief Close the buckets that ended before @p nowMs (called by add())
+     */
+    void advance(uint32_t nowMs);
+
+    /// Current window values
+    void result(StatsResult& out) const;
+
+private:
+    static constexpr uint8_t CLOSED = STATS_WINDOW_BUCKETS - 1;  ///< Closed buckets kept
+
+    struct Bucket {
+        float twsSum;
+        float vmgSum;
+        float sinSum;
+        float cosSum;
+        float twsMax;     ///< -1 when empty (TWS >= 0)
+        uint16_t count;
+    };
+
+    Bucket ring_[CLOSED];
+    Bucket open_;
+    uint8_t head_;        ///< Next ring slot (the oldest once full)
+    uint8_t size_;        ///< Closed buckets held
+
+    uint8_t deque_[CLOSED];  ///< Ring slots with decreasing twsMax, front = oldest
+    uint8_t dequeHead_;
+    uint8_t dequeSize_;
+
+    // Sums of the closed buckets (double: the add/subtract runs for hours)
+    double twsSum_;
+    double vmgSum_;
+    double sinSum_;
+    double cosSum_;
+    uint32_t count_;
+
+    uint32_t bucketMs_;
+    uint32_t openStartMs_;
+    bool started_;
+
+    void closeBucket();
+    static void clearBucket(Bucket& bucket);
+};
+
+/**
+ * @class DerivedStatistics
+ * @brief The 10 s, 1 min and 10 min windows over DerivedData
+ *
+ * Usage:
+ * @code
+ * DerivedStatistics stats;
+ * stats.update(boatData->derived, millis());  // After tws/wdir/vmg are set
+ * @endcode
+ */
+class DerivedStatistics {
+public:
+    static constexpr uint8_t WINDOW_COUNT = 3;
+
+    DerivedStatistics();
+
+    /**
+     * @brief Add derived.tws/wdir/vmg at @p nowMs and publish the window fields
+     */
+    void update(DerivedData& derived, uint32_t nowMs);
+
+    /// Forget all samples
+    void reset();
+
+    /// Window length of window @p index (ms)
+    static uint32_t windowMs(uint8_t index);
+
+private:
+    StatsWindow windows_[WINDOW_COUNT];
+};
+
+#endif // DERIVED_STATISTICS_H
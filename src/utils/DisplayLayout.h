@@ -83,7 +83,7 @@ inline void formatBytes(uint32_t bytes, char* buffer) {
  * Formats integer percentage value with "%" suffix.
  * Example: 87 → "87%"
  *
- * @param value Percentage value (0-100)
+ * @param value Percentage value (0-100; above 100 prints the "---" placeholder)
  * @param buffer Output buffer (must be at least 5 chars)
  *
  * Usage:
@@ -94,7 +94,11 @@ inline void formatBytes(uint32_t bytes, char* buffer) {
  * @endcode
  */
 inline void formatPercent(uint8_t value, char* buffer) {
-    snprintf(buffer, 5, "%u%%", value);
+    if (value > 100) {
+        snprintf(buffer, 5, "---");  // Not measured yet (CPU_IDLE_UNKNOWN)
+    } else {
+        snprintf(buffer, 5, "%u%%", value);
+    }
 }
 
 /**
@@ -0,0 +1,241 @@
+/**
+ * @file EngineJournal.cpp
+ * @brief Implementation of the engine and saildrive event journal
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "EngineJournal.h"
+#include <math.h>
+#include "ConfigRecord.h"
+
+namespace {
+
+const char* const EVENT_NAMES[] = {
+#define ENGINE_JOURNAL_EVENT_NAME(id, name) name,
+    ENGINE_JOURNAL_EVENT_LIST(ENGINE_JOURNAL_EVENT_NAME)
+#undef ENGINE_JOURNAL_EVENT_NAME
+};
+
+const uint8_t EVENT_COUNT = static_cast<uint8_t>(EngineJournalEvent::COUNT);
+
+constexpr uint8_t UTC_FLAG = 0x80;
+constexpr uint8_t TOP_BAND = 4;
+
+/// Lower edge of each band (band 0 = stopped)
+const float BAND_EDGES[TOP_BAND + 1] = {
+    0.0f, ENGINE_JOURNAL_RUNNING_RPM, ENGINE_JOURNAL_CRUISE_RPM, ENGINE_JOURNAL_HIGH_RPM, ENGINE_JOURNAL_MAX_RPM
+};
+
+void putU16(uint8_t* out, uint16_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void putU32(uint8_t* out, uint32_t value) {
+    putU16(out, static_cast<uint16_t>(value));
+    putU16(out + 2, static_cast<uint16_t>(value >> 16));
+}
+
+uint16_t getU16(const uint8_t* in) {
+    return static_cast<uint16_t>(in[0] | (in[1] << 8));
+}
+
+uint32_t getU32(const uint8_t* in) {
+    return getU16(in) | (static_cast<uint32_t>(getU16(in + 2)) << 16);
+}
+
+}  // namespace
+
+const char* EngineJournalEventName(EngineJournalEvent event) {
+    uint8_t index = static_cast<uint8_t>(event);
+    return index < EVENT_COUNT ? EVENT_NAMES[index] : "unknown";
+}
+
+void EngineJournalEncode(const EngineJournalRecord& record, uint8_t* out) {
+    putU32(out, record.sequence);
+    putU32(out + 4, record.time);
+    out[8] = static_cast<uint8_t>(static_cast<uint8_t>(record.event) | (record.utc ? UTC_FLAG : 0));
+    out[9] = record.detail;
+    putU16(out + 10, record.rpm);
+    putU16(out + 12, static_cast<uint16_t>(record.oilDeciC));
+    putU16(out + 14, static_cast<uint16_t>(ConfigCrc32(out, ENGINE_JOURNAL_RECORD_SIZE - 2)));
+}
+
+bool EngineJournalDecode(const uint8_t* in, EngineJournalRecord& out) {
+    uint32_t sequence = getU32(in);
+    if (sequence == 0 || sequence == UINT32_MAX) {
+        return false;  // Never written (or erased)
+    }
+    if (getU16(in + 14) != static_cast<uint16_t>(ConfigCrc32(in, ENGINE_JOURNAL_RECORD_SIZE - 2))) {
+        return false;  // Torn write
+    }
+    uint8_t event = in[8] & static_cast<uint8_t>(~UTC_FLAG);
+    if (event >= EVENT_COUNT) {
+        return false;
+    }
+
+    out.sequence = sequence;
+    out.time = getU32(in + 4);
+    out.utc = (in[8] & UTC_FLAG) != 0;
+    out.event = static_cast<EngineJournalEvent>(event);
+    out.detail = in[9];
+    out.rpm = getU16(in + 10);
+    out.oilDeciC = static_cast<int16_t>(getU16(in + 12));
+    return true;
+}
+
+uint8_t EngineJournalRpmBand(float rpm, uint8_t current) {
+    uint8_t band = current > TOP_BAND ? TOP_BAND : current;
+    while (band < TOP_BAND && rpm >= BAND_EDGES[band + 1]) {
+        band++;  // Up at the edge
+    }
+    while (band > 0 && rpm < BAND_EDGES[band] - ENGINE_JOURNAL_RPM_HYSTERESIS) {
+        band--;  // Down only past the hysteresis
+    }
+    return band;
+}
+
+// ============================================================================
+// EngineJournalIndex
+// ============================================================================
+
+EngineJournalIndex::EngineJournalIndex() {
+    clear();
+}
+
+void EngineJournalIndex::clear() {
+    for (Block& block : blocks_) {
+        block.minUtc = UINT32_MAX;
+        block.maxUtc = 0;
+    }
+}
+
+void EngineJournalIndex::note(const EngineJournalRecord& record) {
+    uint16_t slot = EngineJournalSlot(record.sequence);
+    Block& block = blocks_[slot / ENGINE_JOURNAL_BLOCK_RECORDS];
+    if (slot % ENGINE_JOURNAL_BLOCK_RECORDS == 0) {
+        block.minUtc = UINT32_MAX;
+        block.maxUtc = 0;
+    }
+    if (!record.utc) {
+        return;
+    }
+    if (record.time < block.minUtc) {
+        block.minUtc = record.time;
+    }
+    if (record.time > block.maxUtc) {
+        block.maxUtc = record.time;
+    }
+}
+
+bool EngineJournalIndex::overlaps(uint16_t block, uint32_t fromUtc, uint32_t toUtc) const {
+    if (block >= ENGINE_JOURNAL_BLOCKS) {
+        return false;
+    }
+    const Block& entry = blocks_[block];
+    return entry.minUtc <= entry.maxUtc && entry.minUtc <= toUtc && entry.maxUtc >= fromUtc;
+}
+
+// ============================================================================
+// EngineJournal
+// ============================================================================
+
+EngineJournal::EngineJournal()
+    : head_(0),
+      count_(0),
+      nextSequence_(1),
+      recorded_(0),
+      dropped_(0),
+      band_(0),
+      overtemp_(false),
+      saildriveKnown_(false),
+      saildriveEngaged_(false),
+      rpm_(0),
+      oilDeciC_(ENGINE_JOURNAL_NO_TEMPERATURE) {
+}
+
+void EngineJournal::start(uint32_t nextSequence, uint32_t time, bool utc) {
+    nextSequence_ = nextSequence == 0 ? 1 : nextSequence;
+    head_ = 0;
+    count_ = 0;
+    queue(EngineJournalEvent::BOOT, 0, time, utc);
+}
+
+uint8_t EngineJournal::observe(const BoatDataStructure& data, uint32_t time, bool utc) {
+    uint8_t before = count_;
+
+    const EngineData& engine = data.engine;
+    if (!engine.available || isnan(engine.engineRev)) {
+        if (band_ > 0) {
+            band_ = 0;
+            queue(EngineJournalEvent::ENGINE_STOP, 1, time, utc);  // Last RPM and temperature kept
+        }
+    } else {
+        float rpm = static_cast<float>(engine.engineRev);
+        rpm_ = rpm <= 0.0f ? 0 : (rpm >= 65535.0f ? 65535 : static_cast<uint16_t>(rpm + 0.5f));
+        float oil = static_cast<float>(engine.oilTemperature);
+        oilDeciC_ = isnan(oil) ? ENGINE_JOURNAL_NO_TEMPERATURE : static_cast<int16_t>(lroundf(oil * 10.0f));
+
+        uint8_t band = EngineJournalRpmBand(rpm, band_);
+        if (band != band_) {
+            EngineJournalEvent event = band_ == 0 ? EngineJournalEvent::ENGINE_START
+                                     : band == 0 ? EngineJournalEvent::ENGINE_STOP
+                                                 : EngineJournalEvent::RPM_BAND;
+            band_ = band;
+            queue(event, band, time, utc);
+        }
+
+        if (!isnan(oil)) {
+            if (!overtemp_ && oil > ENGINE_JOURNAL_OVERTEMP_C) {
+                overtemp_ = true;
+                queue(EngineJournalEvent::OVERTEMP, 0, time, utc);
+            } else if (overtemp_ && oil < ENGINE_JOURNAL_OVERTEMP_C - ENGINE_JOURNAL_OVERTEMP_HYSTERESIS_C) {
+                overtemp_ = false;
+                queue(EngineJournalEvent::OVERTEMP_CLEARED, 0, time, utc);
+            }
+        }
+    }
+
+    // The last recorded position survives a sensor dropout: no record for a flicker
+    if (data.saildrive.available &&
+        (!saildriveKnown_ || data.saildrive.saildriveEngaged != saildriveEngaged_)) {
+        saildriveKnown_ = true;
+        saildriveEngaged_ = data.saildrive.saildriveEngaged;
+        queue(saildriveEngaged_ ? EngineJournalEvent::SAILDRIVE_ENGAGED : EngineJournalEvent::SAILDRIVE_RETRACTED,
+              0, time, utc);
+    }
+
+    return static_cast<uint8_t>(count_ - before);
+}
+
+const EngineJournalRecord& EngineJournal::peek(uint8_t index) const {
+    return queue_[(head_ + index) % ENGINE_JOURNAL_PENDING];
+}
+
+void EngineJournal::release(uint8_t count) {
+    if (count > count_) {
+        count = count_;
+    }
+    head_ = static_cast<uint8_t>((head_ + count) % ENGINE_JOURNAL_PENDING);
+    count_ = static_cast<uint8_t>(count_ - count);
+}
+
+void EngineJournal::queue(EngineJournalEvent event, uint8_t detail, uint32_t time, bool utc) {
+    if (count_ >= ENGINE_JOURNAL_PENDING) {
+        dropped_++;  // The write-behind save is behind; the state is still tracked
+        return;
+    }
+
+    EngineJournalRecord& record = queue_[(head_ + count_) % ENGINE_JOURNAL_PENDING];
+    record.sequence = nextSequence_++;
+    record.time = time;
+    record.utc = utc;
+    record.event = event;
+    record.detail = detail;
+    record.rpm = rpm_;
+    record.oilDeciC = oilDeciC_;
+    count_++;
+    recorded_++;
+}
@@ -0,0 +1,229 @@
+/**
+ * @file EngineJournal.h
+ * @brief Engine and saildrive state transitions as compact records for an append-only ring file
+ *
+ * BoatData only keeps the latest EngineData and SaildriveData. For
+ * maintenance the transitions matter: when the engine ran, how long in
+ * which RPM band, when it ran hot, when the saildrive went down. observe()
+ * compares each change against the last recorded state and queues one
+ * record per transition (never samples):
+ *
+ * | Event               | detail                   | Raised when                                      |
+ * |---------------------|--------------------------|--------------------------------------------------|
+ * | boot                | 0                        | start() (time base of the records that follow)   |
+ * | engine_start        | RPM band                 | RPM reaches ENGINE_JOURNAL_RUNNING_RPM           |
+ * | engine_stop         | 0, 1 = engine data lost  | RPM below it (minus hysteresis) or data lost     |
+ * | rpm_band            | new band                 | Band edge crossed while running (hysteresis down)|
+ * | overtemp            | 0                        | Oil above ENGINE_JOURNAL_OVERTEMP_C              |
+ * | overtemp_cleared    | 0                        | Oil back below it minus the hysteresis           |
+ * | saildrive_engaged   | 0                        | Sensor reports engaged (first report included)   |
+ * | saildrive_retracted | 0                        | Sensor reports retracted (first report included) |
+ *
+ * RPM bands: 0 stopped, 1 idle, 2 cruise (ENGINE_JOURNAL_CRUISE_RPM),
+ * 3 high (ENGINE_JOURNAL_HIGH_RPM), 4 max (ENGINE_JOURNAL_MAX_RPM).
+ *
+ * Record (ENGINE_JOURNAL_RECORD_SIZE = 16 bytes, little endian):
+ *
+ * | Offset | Size | Content                                                   |
+ * |--------|------|-----------------------------------------------------------|
+ * | 0      | 4    | sequence (1-based, never reused; 0 / 0xFFFFFFFF = empty)  |
+ * | 4      | 4    | time: UTC seconds, or seconds since boot                  |
+ * | 8      | 1    | event, bit 7 set = time is UTC                            |
+ * | 9      | 1    | detail                                                    |
+ * | 10     | 2    | engine RPM                                                |
+ * | 12     | 2    | oil temperature, 0.1 °C, signed (INT16_MIN = unavailable) |
+ * | 14     | 2    | low 16 bits of ConfigCrc32() over bytes 0-13              |
+ *
+ * Record s lives in slot (s - 1) % ENGINE_JOURNAL_CAPACITY of the ring
+ * file, so the slot of any sequence is known without reading the file. A
+ * torn write fails the CRC and reads as empty. EngineJournalIndex keeps the
+ * UTC range of every ENGINE_JOURNAL_BLOCK_RECORDS slots, so a time range
+ * query reads only the blocks that can hold a match.
+ *
+ * observe() costs a few compares and, on a transition, a 16-byte encode
+ * into the RAM queue (ENGINE_JOURNAL_PENDING); the flash write is left to
+ * the write-behind save, which takes the queue with peek()/release().
+ *
+ * Arduino-free (unit tested natively). All calls from the main loop.
+ *
+ * Usage:
+ * @code
+ * journal.start(store.nextSequence(), nowS, utc);
+ * if (journal.observe(*boatData->getDataStructure(), nowS, utc) > 0) {
+ *     GetWriteBehind().markDirty(journalEntry, millis());
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed queue and index, zero heap allocation
+ * - Principle VII (Fail-Safe): hysteresis against flapping; a full queue drops and counts
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ENGINE_JOURNAL_H
+#define ENGINE_JOURNAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+#include "../types/BoatDataTypes.h"
+
+#define ENGINE_JOURNAL_RECORD_SIZE 16
+#define ENGINE_JOURNAL_BLOCKS (ENGINE_JOURNAL_CAPACITY / ENGINE_JOURNAL_BLOCK_RECORDS)
+
+static_assert(ENGINE_JOURNAL_CAPACITY % ENGINE_JOURNAL_BLOCK_RECORDS == 0,
+              "ENGINE_JOURNAL_CAPACITY must be a multiple of ENGINE_JOURNAL_BLOCK_RECORDS");
+
+/// X(id, name)
+#define ENGINE_JOURNAL_EVENT_LIST(X) \
+    X(BOOT, "boot") \
+    X(ENGINE_START, "engine_start") \
+    X(ENGINE_STOP, "engine_stop") \
+    X(RPM_BAND, "rpm_band") \
+    X(OVERTEMP, "overtemp") \
+    X(OVERTEMP_CLEARED, "overtemp_cleared") \
+    X(SAILDRIVE_ENGAGED, "saildrive_engaged") \
+    X(SAILDRIVE_RETRACTED, "saildrive_retracted")
+
+/**
+ * @brief Journal events
+ */
+enum class EngineJournalEvent : uint8_t {
+#define ENGINE_JOURNAL_EVENT_ENUM(id, name) id,
+    ENGINE_JOURNAL_EVENT_LIST(ENGINE_JOURNAL_EVENT_ENUM)
+#undef ENGINE_JOURNAL_EVENT_ENUM
+    COUNT
+};
+
+/// Name of @p event ("unknown" if out of range)
+const char* EngineJournalEventName(EngineJournalEvent event);
+
+/// Oil temperature field of a record without a reading
+constexpr int16_t ENGINE_JOURNAL_NO_TEMPERATURE = INT16_MIN;
+
+/**
+ * @brief One decoded record
+ */
+struct EngineJournalRecord {
+    uint32_t sequence;
+    uint32_t time;              ///< UTC seconds (utc) or seconds since boot
+    bool utc;
+    EngineJournalEvent event;
+    uint8_t detail;             ///< See the event table
+    uint16_t rpm;
+    int16_t oilDeciC;           ///< 0.1 °C, ENGINE_JOURNAL_NO_TEMPERATURE without a reading
+};
+
+/// Encode @p record into @p out (ENGINE_JOURNAL_RECORD_SIZE bytes)
+void EngineJournalEncode(const EngineJournalRecord& record, uint8_t* out);
+
+/// Decode ENGINE_JOURNAL_RECORD_SIZE bytes; false for an empty slot, a bad CRC or an unknown event
+bool EngineJournalDecode(const uint8_t* in, EngineJournalRecord& out);
+
+/// Ring file slot of @p sequence (>= 1)
+inline uint16_t EngineJournalSlot(uint32_t sequence) {
+    return static_cast<uint16_t>((sequence - 1) % ENGINE_JOURNAL_CAPACITY);
+}
+
+/**
+ * @brief RPM band of @p rpm, leaving @p current only past the hysteresis
+ *
+ * @param rpm Engine RPM
+ * @param current Band shown so far (0 = stopped)
+ * @return 0 stopped, 1 idle, 2 cruise, 3 high, 4 max
+ */
+uint8_t EngineJournalRpmBand(float rpm, uint8_t current);
+
+/**
+ * @class EngineJournalIndex
+ * @brief UTC time range of each ring file block
+ */
+class EngineJournalIndex {
+public:
+    EngineJournalIndex();
+
+    /// Forget every block
+    void clear();
+
+    /**
+     * @brief Account @p record, written to its slot
+     *
+     * The first slot of a block starts the block afresh: the records it
+     * held before were one lap older and are overwritten from here on.
+     */
+    void note(const EngineJournalRecord& record);
+
+    /// Block @p block may hold a UTC record within [fromUtc, toUtc]
+    bool overlaps(uint16_t block, uint32_t fromUtc, uint32_t toUtc) const;
+
+private:
+    struct Block {
+        uint32_t minUtc;        ///< UINT32_MAX while the block holds no UTC record
+        uint32_t maxUtc;
+    };
+
+    Block blocks_[ENGINE_JOURNAL_BLOCKS];
+};
+
+/**
+ * @class EngineJournal
+ * @brief Transition detector and RAM queue of records not written yet
+ */
+class EngineJournal {
+public:
+    EngineJournal();
+
+    /**
+     * @brief Continue the sequence after the ring file and queue a boot record
+     *
+     * @param nextSequence Sequence of the first new record (newest in the file + 1)
+     * @param time UTC seconds or seconds since boot
+     * @param utc @p time is UTC
+     */
+    void start(uint32_t nextSequence, uint32_t time, bool utc);
+
+    /**
+     * @brief Queue the transitions of @p data since the last call
+     *
+     * @return Records queued
+     */
+    uint8_t observe(const BoatDataStructure& data, uint32_t time, bool utc);
+
+    /// Records waiting for the ring file
+    uint8_t pending() const { return count_; }
+
+    /// Queued record @p index, oldest first (index < pending())
+    const EngineJournalRecord& peek(uint8_t index) const;
+
+    /// Drop the @p count oldest queued records (written)
+    void release(uint8_t count);
+
+    uint32_t getNextSequence() const { return nextSequence_; }
+    uint32_t getRecorded() const { return recorded_; }
+    uint32_t getDropped() const { return dropped_; }
+
+    /// RPM band of the last observe() (0 = stopped or unknown)
+    uint8_t getBand() const { return band_; }
+
+private:
+    void queue(EngineJournalEvent event, uint8_t detail, uint32_t time, bool utc);
+
+    EngineJournalRecord queue_[ENGINE_JOURNAL_PENDING];
+    uint8_t head_;
+    uint8_t count_;
+    uint32_t nextSequence_;
+    uint32_t recorded_;
+    uint32_t dropped_;
+
+    // Last recorded state
+    uint8_t band_;                 ///< 0 = stopped (or engine data unavailable)
+    bool overtemp_;
+    bool saildriveKnown_;
+    bool saildriveEngaged_;
+    uint16_t rpm_;                 ///< Values copied into the next record
+    int16_t oilDeciC_;
+};
+
+#endif // ENGINE_JOURNAL_H
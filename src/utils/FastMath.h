@@ -0,0 +1,154 @@
+/**
+ * @file FastMath.h
+ * @brief Single-precision sin/cos/atan2 approximations with a fixed error bound
+ *
+ * Kernels for the calculation cycle, selected at build time with
+ * CALC_FAST_MATH (see AngleUtils::sin()/cos()/atan2()):
+ * - sin(), cos(), sincos(): quadrant reduction plus degree 9/8 Taylor
+ *   polynomials on [-π/4, π/4]
+ * - atan2(): octant reduction plus a degree 11 minimax polynomial for atan on [0, 1]
+ * - sinLut(), cosLut(): FASTMATH_LUT_SIZE-entry sine table with linear
+ *   interpolation (4 bytes per entry, built on first use)
+ *
+ * Accuracy contract (absolute error against double libm, checked by
+ * test_boatdata_units/test_fast_math.cpp):
+ * | Function        | Domain       | Max error                   |
+ * |-----------------|--------------|-----------------------------|
+ * | sin/cos/sincos  | |x| <= 64    | 3e-6                        |
+ * | atan2           | all finite   | 3e-6 rad (0.0002°)          |
+ * | sinLut/cosLut   | |x| <= 64    | 1e-4 (256 entries, 0.006°)  |
+ * Outside the domain, and for NaN/inf, the functions fall back to libm, so
+ * NaN propagates as it does there. atan2(±0, ±0) also uses libm.
+ *
+ * Header-only, Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): no allocation; the table is static and only linked when used
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <stdint.h>
+#include <cmath>
+#include "../config.h"
+
+namespace FastMath {
+
+/// Largest |x| the sin/cos kernels reduce themselves (libm beyond)
+constexpr float MAX_ARG = 64.0f;
+
+constexpr float PI_F = 3.14159265358979323846f;
+constexpr float HALF_PI_F = 1.57079632679489661923f;
+constexpr float TWO_PI_F = 6.28318530717958647692f;
+
+/**
+ * @brief sin(x) and cos(x) in one reduction
+ */
+inline void sincos(float x, float& s, float& c) {
+    if (!(std::fabs(x) <= MAX_ARG)) {
+        s = std::sin(x);
+        c = std::cos(x);
+        return;
+    }
+
+    // x = k * π/2 + r, |r| <= π/4 (Cody-Waite split of π/2)
+    float k = std::floor(x * 0.636619772367581343f + 0.5f);
+    float r = (x - k * 1.57079637050628662109375f) - k * -4.37113900018624283e-8f;
+    float r2 = r * r;
+
+    float sr = r + r * r2 * (-1.66666667e-1f + r2 * (8.33333333e-3f + r2 * (-1.98412698e-4f + r2 * 2.75573192e-6f)));
+    float cr = 1.0f + r2 * (-0.5f + r2 * (4.16666667e-2f + r2 * (-1.38888889e-3f + r2 * 2.48015873e-5f)));
+
+    switch (static_cast<int32_t>(k) & 3) {
+        case 0:  s = sr;  c = cr;  break;
+        case 1:  s = cr;  c = -sr; break;
+        case 2:  s = -sr; c = -cr; break;
+        default: s = -cr; c = sr;  break;
+    }
+}
+
+inline float sin(float x) {
+    float s, c;
+    sincos(x, s, c);
+    return s;
+}
+
+inline float cos(float x) {
+    float s, c;
+    sincos(x, s, c);
+    return c;
+}
+
+/**
+ * @brief atan2(y, x) in [-π, π]
+ */
+inline float atan2(float y, float x) {
+    float ax = std::fabs(x);
+    float ay = std::fabs(y);
+    float hi = ax > ay ? ax : ay;
+    float lo = ax > ay ? ay : ax;
+    if (!(hi > 0.0f) || std::isinf(hi) || std::isnan(lo)) {
+        return std::atan2(y, x);  // Zero vector, inf, NaN
+    }
+
+    float z = lo / hi;
+    float z2 = z * z;
+    float a = z * (0.99997726f + z2 * (-0.33262347f + z2 * (0.19354346f +
+                   z2 * (-0.11643287f + z2 * (0.05265332f + z2 * -0.01172120f)))));
+    if (ay > ax) {
+        a = HALF_PI_F - a;
+    }
+    if (x < 0.0f) {
+        a = PI_F - a;
+    }
+    return std::signbit(y) ? -a : a;
+}
+
+/**
+ * @brief One period of sine, FASTMATH_LUT_SIZE + 1 samples (last = first)
+ */
+struct SinTable {
+    float value[FASTMATH_LUT_SIZE + 1];
+
+    SinTable() {
+        for (int i = 0; i <= FASTMATH_LUT_SIZE; i++) {
+            value[i] = static_cast<float>(std::sin(i * (6.28318530717958647692 / FASTMATH_LUT_SIZE)));
+        }
+    }
+};
+
+inline const SinTable& sinTable() {
+    static const SinTable table;  // Built on first call
+    return table;
+}
+
+/**
+ * @brief sin(x) by table lookup and linear interpolation
+ */
+inline float sinLut(float x) {
+    static_assert((FASTMATH_LUT_SIZE & (FASTMATH_LUT_SIZE - 1)) == 0, "FASTMATH_LUT_SIZE must be a power of two");
+    if (!(std::fabs(x) <= MAX_ARG)) {
+        return std::sin(x);
+    }
+    float t = x * (FASTMATH_LUT_SIZE / TWO_PI_F);
+    float f = std::floor(t);
+    float frac = t - f;
+    int32_t i = static_cast<int32_t>(f) & (FASTMATH_LUT_SIZE - 1);
+    const float* v = sinTable().value;
+    return v[i] + frac * (v[i + 1] - v[i]);
+}
+
+inline float cosLut(float x) {
+    if (!(std::fabs(x) <= MAX_ARG)) {
+        return std::cos(x);
+    }
+    return sinLut(x + HALF_PI_F);
+}
+
+}  // namespace FastMath
+
+#endif // FAST_MATH_H
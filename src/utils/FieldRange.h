@@ -0,0 +1,144 @@
+/**
+ * @file FieldRange.h
+ * @brief Compile-time range descriptors of the BoatData fields (clamp, wrap, NA)
+ *
+ * Range<Limits, Mode> carries a field's bounds in its type, so every check
+ * compiles to constant compares and selects with no table lookup and no
+ * loop: contains() and clamp() are constexpr, wrap() takes whole turns off
+ * with one floor(). FieldRange<BOATDATA_FIELD_<ID>> is generated from
+ * BOATDATA_SCHEMA_FIELDS, so the handlers check against the same absolute
+ * range the schema publishes (BoatDataSchema::inRange() is the runtime
+ * counterpart by field id). Bands that are not a schema range (the 12 V
+ * warning band, DataValidator's boat speed) are declared with
+ * FIELD_RANGE_LIMITS.
+ *
+ * Limits are types with constexpr lo()/hi() because C++14 has no
+ * floating-point template parameters.
+ *
+ * NaN (N2kDoubleNA after conversion, an empty NMEA 0183 field) is never
+ * contained and passes clamp()/wrap() unchanged; check() reports it as
+ * NOT_AVAILABLE so a handler needs one branch for "no value" and "out of
+ * range". Comparisons run in the argument type: a BoatScalar float is
+ * checked against the float-rounded bounds, so float(M_PI) stays inside
+ * [-π, π].
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * typedef FieldRange<BOATDATA_FIELD_WIND_AWA, RangeMode::WRAP> AwaRange;
+ * double awa = N2kAwa;
+ * if (AwaRange::check(awa) == RangeResult::LIMITED) { ... warn ... }
+ * static_assert(FieldRange<BOATDATA_FIELD_DST_DEPTH>::hi() == 100.0, "depth range");
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): header-only, no storage, no allocation
+ * - Principle VII (Fail-Safe): the handlers and the schema share one range per field
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef FIELD_RANGE_H
+#define FIELD_RANGE_H
+
+#include <stdint.h>
+#include <math.h>
+#include "BoatDataSchema.h"
+
+/// What Range::limit() and check() do with a value outside [lo, hi]
+enum class RangeMode : uint8_t {
+    CLAMP,   ///< Nearest bound
+    WRAP     ///< Whole turns of (hi - lo) added or removed (angles)
+};
+
+/// Range::check() outcome
+enum class RangeResult : uint8_t {
+    VALID,          ///< Within [lo, hi], unchanged
+    LIMITED,        ///< Was out of range, now clamped or wrapped
+    NOT_AVAILABLE   ///< NaN, left as is
+};
+
+/**
+ * @brief Limits type Name with bounds [min, max] for Range<Name>
+ */
+#define FIELD_RANGE_LIMITS(Name, min, max) \
+    struct Name { \
+        static constexpr double lo() { return min; } \
+        static constexpr double hi() { return max; } \
+    }
+
+/**
+ * @brief Closed range [Limits::lo(), Limits::hi()] and how to bring values into it
+ */
+template <typename Limits, RangeMode Mode = RangeMode::CLAMP>
+struct Range {
+    static_assert(Limits::lo() < Limits::hi(), "Range: lo must be below hi");
+
+    static constexpr double lo() { return Limits::lo(); }
+    static constexpr double hi() { return Limits::hi(); }
+    static constexpr RangeMode mode() { return Mode; }
+
+    /// @p value within [lo, hi] (NaN = false)
+    template <typename T>
+    static constexpr bool contains(T value) {
+        return value >= static_cast<T>(lo()) && value <= static_cast<T>(hi());
+    }
+
+    /// Nearest bound outside [lo, hi]; NaN stays NaN
+    template <typename T>
+    static constexpr T clamp(T value) {
+        return value < static_cast<T>(lo()) ? static_cast<T>(lo())
+             : value > static_cast<T>(hi()) ? static_cast<T>(hi()) : value;
+    }
+
+    /// Whole turns of (hi - lo) removed outside [lo, hi]; values inside and NaN unchanged
+    template <typename T>
+    static T wrap(T value) {
+        return contains(value) ? value
+             : static_cast<T>(value - (hi() - lo()) * floor((value - lo()) / (hi() - lo())));
+    }
+
+    /// clamp() or wrap(), as Mode says
+    template <typename T>
+    static T limit(T value) {
+        return Mode == RangeMode::WRAP ? wrap(value) : clamp(value);
+    }
+
+    /**
+     * @brief Range check of a received value, limited in place
+     *
+     * @return VALID, LIMITED (@p value clamped or wrapped) or NOT_AVAILABLE (NaN)
+     */
+    template <typename T>
+    static RangeResult check(T& value) {
+        if (contains(value)) {
+            return RangeResult::VALID;
+        }
+        if (value != value) {
+            return RangeResult::NOT_AVAILABLE;
+        }
+        value = limit(value);
+        return RangeResult::LIMITED;
+    }
+};
+
+/// Absolute range of schema field @p Id (BOATDATA_SCHEMA_FIELDS min/max)
+template <BoatDataFieldId Id>
+struct FieldLimits;
+
+#define BOATDATA_SCHEMA_FIELD_LIMITS(ID, GROUP, group, member, TYPE, unit, min, max, decimals, deadband) \
+    template <> \
+    struct FieldLimits<BOATDATA_FIELD_##ID> { \
+        static constexpr double lo() { return min; } \
+        static constexpr double hi() { return max; } \
+    };
+BOATDATA_SCHEMA_FIELDS(BOATDATA_SCHEMA_FIELD_LIMITS)
+#undef BOATDATA_SCHEMA_FIELD_LIMITS
+
+/// Range of schema field @p Id
+template <BoatDataFieldId Id, RangeMode Mode = RangeMode::CLAMP>
+using FieldRange = Range<FieldLimits<Id>, Mode>;
+
+#endif // FIELD_RANGE_H
@@ -0,0 +1,95 @@
+/**
+ * @file FixedString.cpp
+ * @brief Implementation of the fixed-capacity string buffer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "FixedString.h"
+#include <stdio.h>
+
+TextBuffer::TextBuffer(char* buffer, size_t size) : buffer_(buffer), size_(size) {
+    clear();
+}
+
+void TextBuffer::clear() {
+    length_ = 0;
+    truncated_ = (size_ == 0);
+    if (size_ > 0) {
+        buffer_[0] = '\0';
+    }
+}
+
+TextBuffer& TextBuffer::append(const char* text) {
+    return text != nullptr ? append(text, strlen(text)) : *this;
+}
+
+TextBuffer& TextBuffer::append(const char* text, size_t count) {
+    if (text == nullptr || size_ == 0) {
+        return *this;
+    }
+    size_t room = size_ - 1 - length_;
+    size_t n = strnlen(text, count);
+    if (n > room) {
+        n = room;
+        truncated_ = true;
+    }
+    memcpy(buffer_ + length_, text, n);
+    length_ += n;
+    buffer_[length_] = '\0';
+    return *this;
+}
+
+TextBuffer& TextBuffer::append(char c) {
+    return append(&c, 1);
+}
+
+TextBuffer& TextBuffer::append(unsigned long value) {
+    return appendf("%lu", value);
+}
+
+TextBuffer& TextBuffer::append(long value) {
+    return appendf("%ld", value);
+}
+
+TextBuffer& TextBuffer::vappendf(const char* format, va_list args) {
+    if (size_ == 0) {
+        return *this;
+    }
+    size_t room = size_ - length_;
+    int written = vsnprintf(buffer_ + length_, room, format, args);
+    if (written < 0) {
+        buffer_[length_] = '\0';  // Encoding error: keep the text so far
+        truncated_ = true;
+    } else if (static_cast<size_t>(written) >= room) {
+        length_ = size_ - 1;      // snprintf kept what fit
+        truncated_ = true;
+    } else {
+        length_ += static_cast<size_t>(written);
+    }
+    return *this;
+}
+
+TextBuffer& TextBuffer::appendf(const char* format, ...) {
+    va_list args;
+    va_start(args, format);
+    vappendf(format, args);
+    va_end(args);
+    return *this;
+}
+
+TextBuffer& TextBuffer::format(const char* format, ...) {
+    clear();
+    va_list args;
+    va_start(args, format);
+    vappendf(format, args);
+    va_end(args);
+    return *this;
+}
+
+void TextBuffer::copyFrom(const TextBuffer& other) {
+    clear();
+    append(other.buffer_, other.length_);
+    truncated_ = truncated_ || other.truncated_;
+}
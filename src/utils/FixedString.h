@@ -0,0 +1,128 @@
+/**
+ * @file FixedString.h
+ * @brief Fixed-capacity string with snprintf-style formatting, for transient text
+ *
+ * Replaces Arduino `String` temporaries (concatenated paths, response
+ * bodies, log fragments) in code that runs per request, per message or per
+ * frame. The text lives in a stack or member buffer, so building it
+ * performs no heap allocation; text that does not fit is cut at the
+ * capacity (like snprintf) and truncated() reports it.
+ *
+ * JSON payloads use JsonWriter instead (escaping, separators).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): zero heap allocation, no fragmentation over long uptimes
+ * - Principle VII (Fail-Safe): never written past the buffer, truncation is detectable
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+/**
+ * @class TextBuffer
+ * @brief Appends text to a caller-supplied buffer, always NUL-terminated
+ *
+ * Usage pattern:
+ * @code
+ * FixedString<48> path;
+ * path.format("%s.gz", asset.path);
+ * if (!path.truncated()) {
+ *     LittleFS.exists(path.c_str());
+ * }
+ * @endcode
+ */
+class TextBuffer {
+public:
+    /**
+     * @brief Constructor
+     * @param buffer Output buffer (written from the start)
+     * @param size Buffer size in bytes, including the terminating NUL
+     */
+    TextBuffer(char* buffer, size_t size);
+
+    /// Empty the text (clears truncated())
+    void clear();
+
+    TextBuffer& append(const char* text);                ///< nullptr appends nothing
+    TextBuffer& append(const char* text, size_t count);  ///< At most @p count characters
+    TextBuffer& append(char c);
+    TextBuffer& append(unsigned long value);
+    TextBuffer& append(long value);
+
+    /// snprintf() at the end of the text; output beyond the capacity is cut
+    TextBuffer& appendf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    TextBuffer& vappendf(const char* format, va_list args);
+
+    /// Replace the text with the formatted output
+    TextBuffer& format(const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+#ifdef ARDUINO
+    TextBuffer& append(const __FlashStringHelper* text) { return append(reinterpret_cast<const char*>(text)); }
+#endif
+
+    const char* c_str() const { return buffer_; }
+    size_t length() const { return length_; }
+    size_t capacity() const { return size_ > 0 ? size_ - 1 : 0; }
+    bool empty() const { return length_ == 0; }
+
+    /**
+     * @brief true if any text was cut since the last clear()/format()
+     */
+    bool truncated() const { return truncated_; }
+
+    bool equals(const char* text) const { return text != nullptr && strcmp(buffer_, text) == 0; }
+
+protected:
+    /// Replace the text with a copy of @p other's (FixedString copies)
+    void copyFrom(const TextBuffer& other);
+
+private:
+    char* buffer_;
+    size_t size_;
+    size_t length_;
+    bool truncated_;
+};
+
+/**
+ * @brief TextBuffer with its own storage: up to N - 1 characters
+ */
+template <size_t N>
+class FixedString : public TextBuffer {
+    static_assert(N > 0, "FixedString needs room for the terminating NUL");
+
+public:
+    FixedString() : TextBuffer(storage_, N) {}
+
+    explicit FixedString(const char* text) : TextBuffer(storage_, N) { append(text); }
+
+    FixedString(const FixedString& other) : TextBuffer(storage_, N) { copyFrom(other); }
+
+    FixedString& operator=(const FixedString& other) {
+        if (this != &other) {
+            copyFrom(other);
+        }
+        return *this;
+    }
+
+    FixedString& operator=(const char* text) {
+        clear();
+        append(text);
+        return *this;
+    }
+
+private:
+    char storage_[N];
+};
+
+#endif // FIXED_STRING_H
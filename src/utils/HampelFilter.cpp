@@ -0,0 +1,74 @@
+/**
+ * @file HampelFilter.cpp
+ * @brief Implementation of the median/MAD outlier test
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "HampelFilter.h"
+#include <algorithm>
+#include <math.h>
+
+namespace {
+
+/// Scale from MAD to the standard deviation of Gaussian noise
+constexpr double MAD_TO_SIGMA = 1.4826;
+
+/// Median of @p values (upper median for even @p count); reorders them
+double median(double* values, uint8_t count) {
+    std::nth_element(values, values + count / 2, values + count);
+    return values[count / 2];
+}
+
+}  // namespace
+
+HampelFilter::HampelFilter(double floor, bool circular)
+    : floor_(floor), circular_(circular), rejected_(0) {
+    reset();
+}
+
+void HampelFilter::reset() {
+    head_ = 0;
+    count_ = 0;
+    lastTime_ = 0;
+}
+
+bool HampelFilter::check(double value, unsigned long now) {
+    if (count_ > 0 && now - lastTime_ > OUTLIER_RESET_MS) {
+        reset();    // Stale history says nothing about this sample
+    }
+
+    bool accepted = true;
+    if (count_ >= OUTLIER_MIN_SAMPLES) {
+        // History as offsets from the sample: its deviation is |median|
+        double offsets[WINDOW];
+        for (uint8_t i = 0; i < count_; i++) {
+            double d = ring_[i] - value;
+            if (circular_) {
+                d = remainder(d, 2.0 * M_PI);
+            }
+            offsets[i] = d;
+        }
+        double center = median(offsets, count_);
+        for (uint8_t i = 0; i < count_; i++) {
+            offsets[i] = fabs(offsets[i] - center);
+        }
+        double limit = OUTLIER_THRESHOLD * MAD_TO_SIGMA * median(offsets, count_);
+        if (limit < floor_) {
+            limit = floor_;
+        }
+        accepted = fabs(center) <= limit;
+    }
+    if (!accepted) {
+        rejected_++;
+    }
+
+    ring_[head_] = value;
+    head_ = (head_ + 1) % WINDOW;
+    if (count_ < WINDOW) {
+        count_++;
+    }
+    lastTime_ = now;
+    return accepted;
+}
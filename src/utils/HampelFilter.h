@@ -0,0 +1,86 @@
+/**
+ * @file HampelFilter.h
+ * @brief Per-field outlier rejection from the recent history (Hampel filter)
+ *
+ * Fixed rate-of-change limits compare a sample with the stored value only:
+ * once a bad sample is stored, or the signal genuinely steps (a source
+ * switch, a reseeded position), every following good sample is rejected.
+ * HampelFilter instead keeps the last OUTLIER_WINDOW samples of a field and
+ * flags a new sample when it lies further from their median than
+ * OUTLIER_THRESHOLD scaled median absolute deviations (1.4826 × MAD, the
+ * standard deviation of Gaussian noise), never less than the field's floor:
+ *
+ * - Every sample enters the history, rejected or not, so a real step is
+ *   accepted once it holds the majority (after OUTLIER_WINDOW / 2 + 1
+ *   samples) and a lone spike never moves the median.
+ * - A steady ramp (turning, accelerating) spreads the history, so its MAD
+ *   grows with the rate of change.
+ * - Fewer than OUTLIER_MIN_SAMPLES samples, or a gap over OUTLIER_RESET_MS:
+ *   the history restarts and the sample is accepted.
+ * - Angles are filtered circularly (differences wrapped to [-π, π]).
+ *
+ * Each check is O(N) for N ≤ 7: two nth_element selections over a stack copy.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * HampelFilter heading(OUTLIER_FLOOR_HEADING_RAD, true);
+ * if (!heading.check(radians, millis())) { ... reject, count per source ... }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed ring, no heap
+ * - Principle VII (Fail-Safe): recovers by itself after a step or a gap
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef HAMPEL_FILTER_H
+#define HAMPEL_FILTER_H
+
+#include <stdint.h>
+#include "../config.h"
+
+/**
+ * @class HampelFilter
+ * @brief Median/MAD outlier test over a small ring of recent samples
+ */
+class HampelFilter {
+public:
+    static constexpr uint8_t WINDOW = OUTLIER_WINDOW;
+    static_assert(WINDOW >= 3 && WINDOW <= 7, "OUTLIER_WINDOW must be 3-7");
+
+    /**
+     * @param floor Smallest deviation ever flagged (field units)
+     * @param circular Values are angles in radians
+     */
+    explicit HampelFilter(double floor, bool circular = false);
+
+    /**
+     * @brief Record a sample and test it against the history before it
+     *
+     * @param value Sample (field units)
+     * @param now millis()
+     * @return true if accepted, false if an outlier
+     */
+    bool check(double value, unsigned long now);
+
+    /// Outliers flagged since construction
+    uint32_t getRejected() const { return rejected_; }
+
+    /// Forget the history
+    void reset();
+
+private:
+    double ring_[WINDOW];
+    uint8_t head_;              ///< Next slot to write
+    uint8_t count_;             ///< Samples in the ring
+    unsigned long lastTime_;    ///< millis() of the last sample
+    double floor_;
+    bool circular_;
+    uint32_t rejected_;
+};
+
+#endif // HAMPEL_FILTER_H
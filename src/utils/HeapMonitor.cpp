@@ -0,0 +1,74 @@
+/**
+ * @file HeapMonitor.cpp
+ * @brief Implementation of the heap fragmentation monitor
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "HeapMonitor.h"
+#include <string.h>
+
+HeapMonitor::HeapMonitor()
+    : lastMs_(0), samples_(0), allocRate_(HEAP_RATE_UNKNOWN), freeRate_(HEAP_RATE_UNKNOWN), newFailed_(0),
+      fragmentation_(0), maxFragmentation_(0), fragmented_(false), countersAvailable_(false) {
+    memset(&last_, 0, sizeof(last_));
+}
+
+uint32_t HeapMonitor::rate(uint32_t count, uint32_t elapsedMs) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(count) * 1000 + elapsedMs / 2) / elapsedMs);
+}
+
+HeapEvent HeapMonitor::update(const HeapSample& sample, uint32_t nowMs) {
+    uint32_t elapsedMs = nowMs - lastMs_;
+    if (samples_ > 0) {
+        newFailed_ = sample.failedAllocs - last_.failedAllocs;
+        if (countersAvailable_ && elapsedMs > 0) {
+            allocRate_ = rate(sample.allocs - last_.allocs, elapsedMs);
+            freeRate_ = rate(sample.frees - last_.frees, elapsedMs);
+        }
+    } else {
+        newFailed_ = sample.failedAllocs;
+    }
+    last_ = sample;
+    lastMs_ = nowMs;
+    samples_++;
+
+    fragmentation_ = fragmentationPercent(sample.freeBytes, sample.largestFreeBlock);
+    if (fragmentation_ > maxFragmentation_) {
+        maxFragmentation_ = fragmentation_;
+    }
+    if (!fragmented_ && fragmentation_ >= HEAP_FRAG_WARN_PCT) {
+        fragmented_ = true;
+        return HeapEvent::FRAGMENTED;
+    }
+    if (fragmented_ && fragmentation_ < HEAP_FRAG_CLEAR_PCT) {
+        fragmented_ = false;
+        return HeapEvent::RECOVERED;
+    }
+    return HeapEvent::NONE;
+}
+
+bool HeapMonitor::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("free", (unsigned long)last_.freeBytes)
+        .add("largest_block", (unsigned long)last_.largestFreeBlock)
+        .add("min_free", (unsigned long)last_.minFreeBytes)
+        .add("fragmentation_pct", (unsigned int)fragmentation_)
+        .add("max_fragmentation_pct", (unsigned int)maxFragmentation_)
+        .add("fragmented", fragmented_);
+    if (allocRate_ == HEAP_RATE_UNKNOWN) {
+        json.addRaw("allocs_per_s", "null").addRaw("frees_per_s", "null");
+    } else {
+        json.add("allocs_per_s", (unsigned long)allocRate_).add("frees_per_s", (unsigned long)freeRate_);
+    }
+    json.add("failed_allocs", (unsigned long)last_.failedAllocs)
+        .add("last_failed_size", (unsigned long)last_.lastFailedSize)
+        .add("sampled_ms", (unsigned long)lastMs_)
+        .endObject();
+    return !json.overflowed();
+}
@@ -0,0 +1,132 @@
+/**
+ * @file HeapMonitor.h
+ * @brief Heap fragmentation, low-water mark and allocation rates over sample windows
+ *
+ * Free heap alone hides the failure that ends a multi-day run: 60 KB free in
+ * pieces too small for a 2 KB WebSocket message. Each sample pairs the free
+ * heap with the largest free block; fragmentation is the share of free heap
+ * outside that block (0% = one contiguous block). Crossing
+ * HEAP_FRAG_WARN_PCT reports FRAGMENTED once, dropping below
+ * HEAP_FRAG_CLEAR_PCT reports RECOVERED.
+ *
+ * The allocation and free counters are running totals kept by the
+ * allocator hooks (ESP32SystemMetrics); the rates are their increase over
+ * the last window. Without hooks the rates stay HEAP_RATE_UNKNOWN. Failed
+ * allocations come from the failed-allocation callback, available on every
+ * IDF version. Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fragmentation visible before allocations fail
+ * - Principle V (Network Debugging): OLED, GET /status and HEAP_* logs
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef HEAP_MONITOR_H
+#define HEAP_MONITOR_H
+
+#include <stdint.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief One heap reading (ESP32SystemMetrics::sampleHeap)
+ */
+struct HeapSample {
+    uint32_t freeBytes;         ///< Free 8-bit capable heap
+    uint32_t largestFreeBlock;  ///< Largest single allocation that would succeed
+    uint32_t minFreeBytes;      ///< Lowest free heap since boot
+    uint32_t allocs;            ///< Allocations since boot (hooks)
+    uint32_t frees;             ///< Frees since boot (hooks)
+    uint32_t failedAllocs;      ///< Failed allocations since boot
+    uint32_t lastFailedSize;    ///< Size of the latest failed request (0 = none)
+};
+
+/**
+ * @brief Fragmentation state change reported by update()
+ */
+enum class HeapEvent : uint8_t {
+    NONE = 0,
+    FRAGMENTED,   ///< Reached HEAP_FRAG_WARN_PCT
+    RECOVERED     ///< Back below HEAP_FRAG_CLEAR_PCT
+};
+
+/**
+ * @class HeapMonitor
+ * @brief Last heap sample, per-window rates and the fragmentation state
+ *
+ * Usage pattern:
+ * @code
+ * HeapEvent event = monitor.update(sample, millis());   // Every HEAP_SAMPLE_INTERVAL_MS
+ * if (event == HeapEvent::FRAGMENTED) { ... WARN ... }
+ * @endcode
+ */
+class HeapMonitor {
+public:
+    HeapMonitor();
+
+    /// Allocation counters are maintained (allocator hooks registered)
+    void setCountersAvailable(bool available) { countersAvailable_ = available; }
+
+    /**
+     * @brief Take a sample; the first one only starts the rate window
+     *
+     * @return The fragmentation state change, if any
+     */
+    HeapEvent update(const HeapSample& sample, uint32_t nowMs);
+
+    /// Share of free heap outside the largest block, rounded down; 0 when nothing is free
+    static uint8_t fragmentationPercent(uint32_t freeBytes, uint32_t largestFreeBlock) {
+        if (freeBytes == 0 || largestFreeBlock >= freeBytes) {
+            return 0;
+        }
+        uint64_t contiguous = (static_cast<uint64_t>(largestFreeBlock) * 100 + freeBytes - 1) / freeBytes;
+        return static_cast<uint8_t>(100 - contiguous);
+    }
+
+    const HeapSample& getLastSample() const { return last_; }
+    uint8_t getFragmentationPercent() const { return fragmentation_; }
+    uint8_t getMaxFragmentationPercent() const { return maxFragmentation_; }
+    bool isFragmented() const { return fragmented_; }
+
+    /// Allocations (frees) per second over the last window, or HEAP_RATE_UNKNOWN
+    uint32_t getAllocsPerSecond() const { return allocRate_; }
+    uint32_t getFreesPerSecond() const { return freeRate_; }
+
+    /// Failed allocations during the last window
+    uint32_t getNewFailedAllocs() const { return newFailed_; }
+
+    /// Samples taken
+    uint32_t getSampleCount() const { return samples_; }
+
+    /**
+     * @brief Write the last sample as a JSON object
+     *
+     * {"free":61440,"largest_block":2036,"min_free":40212,"fragmentation_pct":96,
+     *  "max_fragmentation_pct":96,"fragmented":true,"allocs_per_s":412,"frees_per_s":409,
+     *  "failed_allocs":3,"last_failed_size":2048,"sampled_ms":86400000}
+     *
+     * The rates are null without hooks or before the second sample.
+     *
+     * @param key Member name in the enclosing object, or nullptr
+     * @return false if @p json overflowed
+     */
+    bool writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    static uint32_t rate(uint32_t count, uint32_t elapsedMs);
+
+    HeapSample last_;
+    uint32_t lastMs_;
+    uint32_t samples_;
+    uint32_t allocRate_;
+    uint32_t freeRate_;
+    uint32_t newFailed_;
+    uint8_t fragmentation_;
+    uint8_t maxFragmentation_;
+    bool fragmented_;
+    bool countersAvailable_;
+};
+
+#endif // HEAP_MONITOR_H
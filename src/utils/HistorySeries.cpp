@@ -0,0 +1,205 @@
+/**
+ * @file HistorySeries.cpp
+ * @brief Implementation of the three-tier min/max/mean history
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "HistorySeries.h"
+#include <math.h>
+
+namespace {
+
+const float TWO_PI_F = 6.28318530718f;
+const float PI_F = 3.14159265359f;
+
+}  // namespace
+
+HistorySeries::HistorySeries() : scale_(1.0f), circular_(false), started_(false) {
+    for (uint8_t i = 0; i < TIER_COUNT; i++) {
+        tiers_[i].min = nullptr;
+        tiers_[i].max = nullptr;
+        tiers_[i].mean = nullptr;
+        tiers_[i].capacity = 0;
+        tiers_[i].head = 0;
+        tiers_[i].count = 0;
+        tiers_[i].periodMs = 0;
+        tiers_[i].bucketStartMs = 0;
+        tiers_[i].acc.count = 0;
+    }
+}
+
+size_t HistorySeries::storageBytes(const uint16_t capacity[TIER_COUNT]) {
+    size_t bytes = 0;
+    for (uint8_t i = 0; i < TIER_COUNT; i++) {
+        bytes += static_cast<size_t>(capacity[i]) * 3 * sizeof(int16_t);
+    }
+    return bytes;
+}
+
+bool HistorySeries::begin(void* storage, const uint16_t capacity[TIER_COUNT],
+                          const uint32_t periodMs[TIER_COUNT], float scale, bool circular) {
+    if (storage == nullptr || !(scale > 0.0f)) {
+        return false;
+    }
+    for (uint8_t i = 0; i < TIER_COUNT; i++) {
+        if (capacity[i] == 0 || periodMs[i] == 0 || (i > 0 && periodMs[i] % periodMs[i - 1] != 0)) {
+            return false;
+        }
+    }
+
+    int16_t* slots = static_cast<int16_t*>(storage);
+    for (uint8_t i = 0; i < TIER_COUNT; i++) {
+        Tier& tier = tiers_[i];
+        tier.min = slots;
+        tier.max = slots + capacity[i];
+        tier.mean = slots + 2 * capacity[i];
+        slots += 3 * capacity[i];
+        tier.capacity = capacity[i];
+        tier.head = 0;
+        tier.count = 0;
+        tier.periodMs = periodMs[i];
+        tier.bucketStartMs = 0;
+        tier.acc.count = 0;
+    }
+    scale_ = scale;
+    circular_ = circular;
+    started_ = false;
+    return true;
+}
+
+void HistorySeries::addSample(float value, uint32_t nowMs) {
+    if (tiers_[0].capacity == 0 || isnan(value)) {
+        return;
+    }
+    advance(nowMs);
+    fold(0, value, value, value, 1);
+}
+
+void HistorySeries::advance(uint32_t nowMs) {
+    if (tiers_[0].capacity == 0) {
+        return;
+    }
+    if (!started_) {
+        start(nowMs);
+        return;
+    }
+
+    // Finest tier first: its closed buckets feed the next tier's open bucket
+    for (uint8_t i = 0; i < TIER_COUNT; i++) {
+        Tier& tier = tiers_[i];
+        uint32_t elapsed = nowMs - tier.bucketStartMs;
+        if (elapsed < tier.periodMs) {
+            continue;
+        }
+
+        uint32_t ended = elapsed / tier.periodMs;
+        close(i);  // The bucket in progress (data or gap)
+        uint32_t gaps = ended - 1;
+        if (gaps > tier.capacity) {
+            gaps = tier.capacity;  // Long outage: the whole ring becomes gap
+        }
+        for (uint32_t g = 0; g < gaps; g++) {
+            store(tier, HISTORY_NO_DATA, HISTORY_NO_DATA, HISTORY_NO_DATA);
+        }
+        tier.bucketStartMs += ended * tier.periodMs;
+    }
+}
+
+bool HistorySeries::read(uint8_t tier, uint16_t index, int16_t& min, int16_t& max, int16_t& mean) const {
+    if (tier >= TIER_COUNT || index >= tiers_[tier].count) {
+        return false;
+    }
+    const Tier& t = tiers_[tier];
+    uint16_t slot = static_cast<uint16_t>((t.head + t.capacity - t.count + index) % t.capacity);
+    min = t.min[slot];
+    max = t.max[slot];
+    mean = t.mean[slot];
+    return true;
+}
+
+int16_t HistorySeries::quantize(float value) const {
+    float steps = value / scale_;
+    if (steps >= 32767.0f) {
+        return 32767;
+    }
+    if (steps <= -32767.0f) {
+        return -32767;  // INT16_MIN is HISTORY_NO_DATA
+    }
+    return static_cast<int16_t>(lroundf(steps));
+}
+
+void HistorySeries::start(uint32_t nowMs) {
+    for (uint8_t i = 0; i < TIER_COUNT; i++) {
+        tiers_[i].bucketStartMs = nowMs - nowMs % tiers_[i].periodMs;
+    }
+    started_ = true;
+}
+
+void HistorySeries::fold(uint8_t tier, float min, float max, float mean, uint32_t count) {
+    Accumulator& acc = tiers_[tier].acc;
+    if (acc.count == 0) {
+        acc.reference = mean;
+        acc.min = min;
+        acc.max = max;
+        acc.sum = mean * static_cast<float>(count);
+        acc.count = count;
+        return;
+    }
+
+    if (circular_) {
+        // Shift the aggregate next to the reference so 359° and 1° are 2° apart
+        float shift = unwrap(mean, acc.reference) - mean;
+        min += shift;
+        max += shift;
+        mean += shift;
+    }
+    if (min < acc.min) acc.min = min;
+    if (max > acc.max) acc.max = max;
+    acc.sum += mean * static_cast<float>(count);
+    acc.count += count;
+}
+
+void HistorySeries::close(uint8_t tier) {
+    Tier& t = tiers_[tier];
+    if (t.acc.count == 0) {
+        store(t, HISTORY_NO_DATA, HISTORY_NO_DATA, HISTORY_NO_DATA);
+        return;
+    }
+
+    float mean = t.acc.sum / static_cast<float>(t.acc.count);
+    store(t, quantize(wrap(t.acc.min)), quantize(wrap(t.acc.max)), quantize(wrap(mean)));
+    if (tier + 1 < TIER_COUNT) {
+        fold(static_cast<uint8_t>(tier + 1), t.acc.min, t.acc.max, mean, t.acc.count);
+    }
+    t.acc.count = 0;
+}
+
+void HistorySeries::store(Tier& tier, int16_t min, int16_t max, int16_t mean) {
+    tier.min[tier.head] = min;
+    tier.max[tier.head] = max;
+    tier.mean[tier.head] = mean;
+    tier.head = static_cast<uint16_t>((tier.head + 1) % tier.capacity);
+    if (tier.count < tier.capacity) {
+        tier.count++;
+    }
+}
+
+float HistorySeries::unwrap(float value, float reference) const {
+    float diff = fmodf(value - reference, TWO_PI_F);
+    if (diff > PI_F) {
+        diff -= TWO_PI_F;
+    } else if (diff < -PI_F) {
+        diff += TWO_PI_F;
+    }
+    return reference + diff;
+}
+
+float HistorySeries::wrap(float value) const {
+    if (!circular_) {
+        return value;
+    }
+    float wrapped = fmodf(value, TWO_PI_F);
+    return wrapped < 0.0f ? wrapped + TWO_PI_F : wrapped;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file HistorySeries.h
+ * @brief Downsampled min/max/mean history of one value in three time tiers
+ *
+ * Samples are folded into buckets of the finest tier (e.g. 1 s). A closed
+ * bucket is stored and folded into the next tier's bucket (e.g. 10 s), and
+ * so on, so each tier holds min, max and mean over its own period:
+ *
+ *   samples -> tier 0 (1 s x 600) -> tier 1 (10 s x 360) -> tier 2 (60 s x 1440)
+ *
+ * Each tier is a ring in struct-of-arrays layout (all minima, then all
+ * maxima, then all means) of int16 values quantized by the series scale,
+ * 6 bytes per bucket. Buckets without samples are stored as
+ * HISTORY_NO_DATA, so gaps stay visible in the graph.
+ *
+ * Circular series (headings, wind direction) unwrap each sample relative to
+ * the bucket's first sample, so min/max/mean stay meaningful across 0/2π;
+ * the stored values are normalized back to [0, 2π).
+ *
+ * The series does not allocate: begin() takes caller-provided storage of
+ * storageBytes() bytes (HistoryRecorder places it in PSRAM when present).
+ * Written by one task; readers on other tasks may see a slot being
+ * replaced while they copy it.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * const uint16_t capacity[HistorySeries::TIER_COUNT] = {600, 360, 1440};
+ * const uint32_t periodMs[HistorySeries::TIER_COUNT] = {1000, 10000, 60000};
+ * static uint8_t storage[...];
+ * HistorySeries depth;
+ * depth.begin(storage, capacity, periodMs, 0.01f, false);
+ * depth.addSample(12.34f, millis());
+ * depth.advance(millis());  // Close buckets even while no samples arrive
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef HISTORY_SERIES_H
+#define HISTORY_SERIES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/// Stored for a bucket without samples
+#define HISTORY_NO_DATA INT16_MIN
+
+/**
+ * @class HistorySeries
+ * @brief Three-tier downsampling ring of quantized min/max/mean buckets
+ */
+class HistorySeries {
+public:
+    static constexpr uint8_t TIER_COUNT = 3;
+
+    HistorySeries();
+
+    /**
+     * @brief Bytes of storage needed for the given tier capacities
+     */
+    static size_t storageBytes(const uint16_t capacity[TIER_COUNT]);
+
+    /**
+     * @brief Attach storage and start empty
+     *
+     * @param storage storageBytes(capacity) bytes, 2-byte aligned
+     * @param capacity Buckets per tier (> 0)
+     * @param periodMs Bucket length per tier; each a multiple of the previous
+     * @param scale Value of one quantization step (e.g. 0.01 = centimetres for metres)
+     * @param circular true for angles in radians, [0, 2π)
+     * @return false if an argument is invalid
+     */
+    bool begin(void* storage, const uint16_t capacity[TIER_COUNT], const uint32_t periodMs[TIER_COUNT],
+               float scale, bool circular);
+
+    /**
+     * @brief Fold one sample into the current bucket(s)
+     *
+     * Closes buckets that ended before @p nowMs first (see advance()).
+     */
+    void addSample(float value, uint32_t nowMs);
+
+    /**
+     * @brief Close every bucket that ended at or before @p nowMs
+     *
+     * Call periodically so empty intervals are recorded as gaps.
+     */
+    void advance(uint32_t nowMs);
+
+    /// Buckets stored in tier @p tier (<= capacity)
+    uint16_t size(uint8_t tier) const { return tier < TIER_COUNT ? tiers_[tier].count : 0; }
+
+    uint16_t capacity(uint8_t tier) const { return tier < TIER_COUNT ? tiers_[tier].capacity : 0; }
+
+    uint32_t periodMs(uint8_t tier) const { return tier < TIER_COUNT ? tiers_[tier].periodMs : 0; }
+
+    /// Start time (ms) of the bucket being filled in tier @p tier = end of the newest stored bucket
+    uint32_t currentBucketStartMs(uint8_t tier) const {
+        return tier < TIER_COUNT ? tiers_[tier].bucketStartMs : 0;
+    }
+
+    float scale() const { return scale_; }
+
+    bool isCircular() const { return circular_; }
+
+    /**
+     * @brief Read stored bucket @p index of tier @p tier (0 = oldest)
+     *
+     * Values are quantized (multiply by scale()); HISTORY_NO_DATA marks a gap.
+     *
+     * @return false if @p index >= size(tier)
+     */
+    bool read(uint8_t tier, uint16_t index, int16_t& min, int16_t& max, int16_t& mean) const;
+
+    /// Quantize @p value with this series' scale (clamped, never HISTORY_NO_DATA)
+    int16_t quantize(float value) const;
+
+private:
+    struct Accumulator {
+        float min;
+        float max;
+        float sum;        ///< Sum of means, weighted by count
+        float reference;  ///< First value (circular unwrap reference)
+        uint32_t count;   ///< Samples folded in
+    };
+
+    struct Tier {
+        int16_t* min;
+        int16_t* max;
+        int16_t* mean;
+        uint16_t capacity;
+        uint16_t head;    ///< Next slot to write
+        uint16_t count;
+        uint32_t periodMs;
+        uint32_t bucketStartMs;
+        Accumulator acc;
+    };
+
+    Tier tiers_[TIER_COUNT];
+    float scale_;
+    bool circular_;
+    bool started_;    ///< bucketStartMs set by the first addSample()/advance()
+
+    void fold(uint8_t tier, float min, float max, float mean, uint32_t count);
+    void close(uint8_t tier);
+    void store(Tier& tier, int16_t min, int16_t max, int16_t mean);
+    void start(uint32_t nowMs);
+    float unwrap(float value, float reference) const;
+    float wrap(float value) const;
+};
+
+#endif // HISTORY_SERIES_H
@@ -0,0 +1,47 @@
+/**
+ * @file HotPath.h
+ * @brief HOT_PATH_ATTR: opt-in IRAM placement of the receive hot path
+ *
+ * Code runs from flash through a 32 KB cache per core. A miss stalls the
+ * CPU for the flash read (hundreds of cycles at 40/80 MHz QIO), and the
+ * Wi-Fi stack's own flash-resident code keeps evicting the lines the CAN
+ * and UART receive paths use between two frames. With HOT_PATH_IRAM 1
+ * (env:esp32dev_iram) the functions marked HOT_PATH_ATTR are linked into
+ * IRAM instead, so their instructions never miss:
+ * - N2k frame dispatch: N2kPGNDispatcher::HandleMsg(), source arbitration
+ *   (N2kSourceTracker::accept()) and the statistics update
+ * - the 10 Hz PGN handlers (heading, rate of turn, attitude, speed, rapid
+ *   position, COG/SOG, wind, engine rapid)
+ * - the autopilot fast path (AutopilotForward::forward(), AP_FORWARD_ENABLED)
+ * - the NMEA 0183 tokenizer
+ * - BoatData's patch producers (patchGPS() ... patchTank(), submitPatch())
+ * - the log ring's reserve/commit
+ *
+ * Only the instructions move. Constant data (tables, format strings) stays
+ * in flash, and the library code these functions call (ParseN2kPGN*,
+ * vsnprintf, libm) still runs from flash, so a marked function is not safe
+ * to call with the cache disabled (ISRs, flash writes). Each marked
+ * function costs its code size in IRAM, which the Wi-Fi and FreeRTOS IRAM
+ * code shares: tools/profile_sizes.py shows the IRAM left per build, and
+ * the cold-cache cycles of test_performance_hardware (HW-009) show the
+ * latency it buys.
+ *
+ * Native and default builds: HOT_PATH_ATTR is empty.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef HOT_PATH_H
+#define HOT_PATH_H
+
+#include "../config.h"
+
+#if defined(ARDUINO) && HOT_PATH_IRAM
+#include <esp_attr.h>
+#define HOT_PATH_ATTR IRAM_ATTR
+#else
+#define HOT_PATH_ATTR
+#endif
+
+#endif // HOT_PATH_H
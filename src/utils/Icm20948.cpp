@@ -0,0 +1,141 @@
+/**
+ * @file Icm20948.cpp
+ * @brief Implementation of the ICM-20948 setup and FIFO drain
+ *
+ * @see Icm20948.h
+ */
+
+#include "Icm20948.h"
+#include <math.h>
+
+namespace {
+
+constexpr uint8_t PWR_CLKSEL_AUTO = 0x01;       // Wake (SLEEP clear), best available clock
+constexpr uint8_t USER_CTRL_FIFO_EN = 0x40;
+constexpr uint8_t FIFO_EN_2_ACCEL_GYRO = 0x1E;  // ACCEL, GYRO_Z, GYRO_Y, GYRO_X (no temperature)
+constexpr uint8_t FIFO_RST_ALL = 0x1F;
+constexpr uint8_t FIFO_MODE_STREAM = 0x00;
+constexpr uint8_t GYRO_CONFIG_500DPS_DLPF = (3 << 3) | (1 << 1) | 0x01;   // DLPFCFG 3 (~51 Hz), ±500 dps, FCHOICE
+constexpr uint8_t ACCEL_CONFIG_4G_DLPF = (3 << 3) | (1 << 1) | 0x01;      // DLPFCFG 3 (~50 Hz), ±4 g, FCHOICE
+constexpr uint16_t FIFO_COUNT_MASK = 0x1FFF;
+constexpr double RAD_PER_DEG = M_PI / 180.0;
+
+static_assert(IMU_I2C_CHUNK_BYTES % Icm20948::PACKET_BYTES == 0, "IMU_I2C_CHUNK_BYTES must hold whole samples");
+static_assert(IMU_SAMPLE_RATE_HZ >= 5 && IMU_SAMPLE_RATE_HZ <= 1125, "IMU_SAMPLE_RATE_HZ out of range");
+
+int16_t be16(const uint8_t* p) {
+    return static_cast<int16_t>(static_cast<uint16_t>(p[0]) << 8 | p[1]);
+}
+
+}  // namespace
+
+Icm20948::Icm20948(II2cDevice* device)
+    : device_(device),
+      divider_(0),
+      bank_(0xFF),
+      transactions_(0),
+      overflows_(0),
+      errors_(0) {
+}
+
+bool Icm20948::write(uint8_t reg, uint8_t value) {
+    transactions_++;
+    if (!device_->writeRegister(reg, value)) {
+        errors_++;
+        return false;
+    }
+    return true;
+}
+
+bool Icm20948::read(uint8_t reg, uint8_t* out, size_t length) {
+    transactions_++;
+    if (!device_->readRegisters(reg, out, length)) {
+        errors_++;
+        return false;
+    }
+    return true;
+}
+
+bool Icm20948::selectBank(uint8_t bank) {
+    if (bank == bank_) {
+        return true;
+    }
+    if (!write(REG_BANK_SEL, static_cast<uint8_t>(bank << 4))) {
+        bank_ = 0xFF;  // Unknown: select again next time
+        return false;
+    }
+    bank_ = bank;
+    return true;
+}
+
+bool Icm20948::resetFifo() {
+    return selectBank(0) && write(REG_FIFO_RST, FIFO_RST_ALL) && write(REG_FIFO_RST, 0x00);
+}
+
+bool Icm20948::begin(uint16_t rateHz) {
+    bank_ = 0xFF;
+    uint8_t id = 0;
+    if (!selectBank(0) || !read(REG_WHO_AM_I, &id, 1) || id != WHO_AM_I_VALUE) {
+        return false;
+    }
+
+    uint16_t divider = rateHz == 0 ? 0 : static_cast<uint16_t>(lround(BASE_RATE_HZ / rateHz) - 1);
+    divider_ = divider > 255 ? 255 : divider;  // Both sensors: the gyro divider is 8 bits
+
+    bool ok = write(REG_PWR_MGMT_1, PWR_CLKSEL_AUTO)
+        && write(REG_PWR_MGMT_2, 0x00)
+        && write(REG_USER_CTRL, 0x00)          // FIFO off while configuring
+        && selectBank(2)
+        && write(REG_GYRO_SMPLRT_DIV, static_cast<uint8_t>(divider_))
+        && write(REG_GYRO_CONFIG_1, GYRO_CONFIG_500DPS_DLPF)
+        && write(REG_ACCEL_SMPLRT_DIV_1, 0x00)
+        && write(REG_ACCEL_SMPLRT_DIV_2, static_cast<uint8_t>(divider_))
+        && write(REG_ACCEL_CONFIG, ACCEL_CONFIG_4G_DLPF)
+        && selectBank(0)
+        && write(REG_FIFO_EN_1, 0x00)
+        && write(REG_FIFO_EN_2, FIFO_EN_2_ACCEL_GYRO)
+        && write(REG_FIFO_MODE, FIFO_MODE_STREAM)
+        && resetFifo()
+        && write(REG_USER_CTRL, USER_CTRL_FIFO_EN);
+    return ok;
+}
+
+void Icm20948::decode(const uint8_t* packet, ImuSample& sample) {
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        sample.accel[axis] = static_cast<float>(be16(packet + 2 * axis) / ACCEL_LSB_PER_G);
+        sample.gyro[axis] = static_cast<float>(be16(packet + 6 + 2 * axis) / GYRO_LSB_PER_DPS * RAD_PER_DEG);
+    }
+}
+
+uint8_t Icm20948::readBatch(ImuSample* out, uint8_t max) {
+    uint8_t countBytes[2];
+    if (!selectBank(0) || !read(REG_FIFO_COUNTH, countBytes, sizeof(countBytes))) {
+        return 0;
+    }
+    uint16_t count = static_cast<uint16_t>((countBytes[0] << 8 | countBytes[1]) & FIFO_COUNT_MASK);
+    if (count > FIFO_BYTES - PACKET_BYTES) {
+        overflows_++;   // Full: stream mode overwrote bytes, packet boundaries are lost
+        resetFifo();
+        return 0;
+    }
+
+    uint16_t available = count / PACKET_BYTES;
+    uint8_t samples = available < max ? static_cast<uint8_t>(available) : max;
+    uint8_t chunk[IMU_I2C_CHUNK_BYTES];
+    uint8_t done = 0;
+    while (done < samples) {
+        uint8_t inChunk = samples - done;
+        if (inChunk > IMU_I2C_CHUNK_BYTES / PACKET_BYTES) {
+            inChunk = IMU_I2C_CHUNK_BYTES / PACKET_BYTES;
+        }
+        if (!read(REG_FIFO_R_W, chunk, inChunk * PACKET_BYTES)) {
+            resetFifo();  // A short read leaves the FIFO mid-packet
+            return done;
+        }
+        for (uint8_t i = 0; i < inChunk; i++) {
+            decode(chunk + i * PACKET_BYTES, out[done + i]);
+        }
+        done += inChunk;
+    }
+    return done;
+}
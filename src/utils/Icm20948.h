@@ -0,0 +1,125 @@
+/**
+ * @file Icm20948.h
+ * @brief ICM-20948 setup and FIFO batch reads over an II2cDevice
+ *
+ * The IMU samples gyro and accelerometer at IMU_SAMPLE_RATE_HZ into its
+ * 512-byte FIFO (12 bytes per sample: accel X/Y/Z then gyro X/Y/Z, each a
+ * big-endian int16). A drain is one FIFO_COUNT read plus burst reads of
+ * FIFO_R_W in IMU_I2C_CHUNK_BYTES pieces, so 10 samples cost two
+ * transactions instead of ten register reads. The sensor keeps its own
+ * sample clock, so the poller's jitter does not reach the filter: every
+ * sample is getSamplePeriodS() after the previous one.
+ *
+ * Configuration (begin()):
+ * - Wake with the auto-selected PLL clock, gyro and accelerometer on
+ * - Gyro ±500 dps (65.5 LSB/dps), accelerometer ±4 g (8192 LSB/g), both
+ *   with the ~50 Hz digital low-pass filter
+ * - Sample rate divider 1125 / rate - 1 for both sensors
+ * - FIFO in stream mode with accel and gyro, then reset
+ *
+ * A FIFO that filled up (the poller fell behind by more than ~420 ms at
+ * 100 Hz) has overwritten its oldest bytes and lost its sample alignment:
+ * it is reset and the drain returns nothing (getOverflows()).
+ *
+ * The magnetometer (AK09916 behind the auxiliary I2C master) and the DMP
+ * are not used.
+ *
+ * Arduino-free (unit tested natively against MockIcm20948). Main loop only.
+ *
+ * Usage:
+ * @code
+ * Icm20948 imu(&device);
+ * if (imu.begin(IMU_SAMPLE_RATE_HZ)) {
+ *     ImuSample samples[IMU_BATCH_MAX];
+ *     uint8_t count = imu.readBatch(samples, IMU_BATCH_MAX);
+ * }
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ICM20948_H
+#define ICM20948_H
+
+#include <stdint.h>
+#include "AttitudeFilter.h"
+#include "../hal/interfaces/II2cDevice.h"
+#include "../config.h"
+
+/**
+ * @class Icm20948
+ * @brief Register setup and FIFO drain for one ICM-20948
+ */
+class Icm20948 {
+public:
+    // User bank 0
+    static constexpr uint8_t REG_WHO_AM_I = 0x00;
+    static constexpr uint8_t REG_USER_CTRL = 0x03;
+    static constexpr uint8_t REG_PWR_MGMT_1 = 0x06;
+    static constexpr uint8_t REG_PWR_MGMT_2 = 0x07;
+    static constexpr uint8_t REG_FIFO_EN_1 = 0x66;
+    static constexpr uint8_t REG_FIFO_EN_2 = 0x67;
+    static constexpr uint8_t REG_FIFO_RST = 0x68;
+    static constexpr uint8_t REG_FIFO_MODE = 0x69;
+    static constexpr uint8_t REG_FIFO_COUNTH = 0x70;
+    static constexpr uint8_t REG_FIFO_R_W = 0x72;
+    static constexpr uint8_t REG_BANK_SEL = 0x7F;   ///< Every bank, bank number in bits 5:4
+
+    // User bank 2
+    static constexpr uint8_t REG_GYRO_SMPLRT_DIV = 0x00;
+    static constexpr uint8_t REG_GYRO_CONFIG_1 = 0x01;
+    static constexpr uint8_t REG_ACCEL_SMPLRT_DIV_1 = 0x10;
+    static constexpr uint8_t REG_ACCEL_SMPLRT_DIV_2 = 0x11;
+    static constexpr uint8_t REG_ACCEL_CONFIG = 0x14;
+
+    static constexpr uint8_t WHO_AM_I_VALUE = 0xEA;
+    static constexpr uint8_t PACKET_BYTES = 12;
+    static constexpr uint16_t FIFO_BYTES = 512;
+    static constexpr double BASE_RATE_HZ = 1125.0;
+    static constexpr double ACCEL_LSB_PER_G = 8192.0;
+    static constexpr double GYRO_LSB_PER_DPS = 65.5;
+
+    explicit Icm20948(II2cDevice* device);
+
+    /**
+     * @brief Probe WHO_AM_I and configure sensors and FIFO
+     *
+     * @param rateHz Requested sample rate (the divider rounds it, see getSampleRateHz())
+     * @return false if the device is absent, is not an ICM-20948 or NAKs a write
+     */
+    bool begin(uint16_t rateHz);
+
+    /**
+     * @brief Read the complete samples waiting in the FIFO, oldest first
+     *
+     * Reads at most @p max; the rest stays for the next call.
+     *
+     * @return Samples written to @p out (0 on a bus error or after an overflow reset)
+     */
+    uint8_t readBatch(ImuSample* out, uint8_t max);
+
+    /// Actual FIFO rate, 1125 / (1 + divider)
+    double getSampleRateHz() const { return BASE_RATE_HZ / (1 + divider_); }
+    double getSamplePeriodS() const { return (1 + divider_) / BASE_RATE_HZ; }
+
+    uint32_t getTransactions() const { return transactions_; }
+    uint32_t getOverflows() const { return overflows_; }
+    uint32_t getErrors() const { return errors_; }
+
+private:
+    bool write(uint8_t reg, uint8_t value);
+    bool read(uint8_t reg, uint8_t* out, size_t length);
+    bool selectBank(uint8_t bank);
+    bool resetFifo();
+    static void decode(const uint8_t* packet, ImuSample& sample);
+
+    II2cDevice* device_;
+    uint16_t divider_;
+    uint8_t bank_;
+    uint32_t transactions_;
+    uint32_t overflows_;
+    uint32_t errors_;
+};
+
+#endif // ICM20948_H
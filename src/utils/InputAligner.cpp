@@ -0,0 +1,118 @@
+/**
+ * @file InputAligner.cpp
+ * @brief Implementation of the input sample history
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "InputAligner.h"
+#include <math.h>
+#include "AngleUtils.h"
+
+namespace {
+
+/// Signed a - b of two millis() timestamps
+inline int32_t elapsed(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b);
+}
+
+}  // namespace
+
+InputAligner::InputAligner() {
+    reset();
+}
+
+void InputAligner::reset() {
+    for (uint8_t i = 0; i < ALIGN_INPUT_COUNT; i++) {
+        history_[i].head = 0;
+        history_[i].count = 0;
+    }
+}
+
+uint8_t InputAligner::count(AlignedInput input) const {
+    return input < ALIGN_INPUT_COUNT ? history_[input].count : 0;
+}
+
+void InputAligner::record(AlignedInput input, uint32_t timeMs, BoatScalar value) {
+    if (input >= ALIGN_INPUT_COUNT || !isfinite(value)) {
+        return;
+    }
+    History& h = history_[input];
+
+    if (h.count > 0) {
+        uint8_t newest = (h.head + CALC_ALIGN_HISTORY - 1) % CALC_ALIGN_HISTORY;
+        int32_t age = elapsed(timeMs, h.timeMs[newest]);
+        if (age == 0) {
+            h.value[newest] = value;  // Same update seen again
+            return;
+        }
+        if (age < 0) {
+            return;  // Out of order
+        }
+    }
+
+    h.timeMs[h.head] = timeMs;
+    h.value[h.head] = value;
+    h.head = (h.head + 1) % CALC_ALIGN_HISTORY;
+    if (h.count < CALC_ALIGN_HISTORY) {
+        h.count++;
+    }
+}
+
+BoatScalar InputAligner::lerp(AlignedInput input, BoatScalar a, BoatScalar b, BoatScalar fraction) {
+    switch (input) {
+        case ALIGN_AWA:
+            return AngleUtils::normalizeToPiMinusPi(a + fraction * AngleUtils::angleDifference(a, b));
+        case ALIGN_HEADING:
+        case ALIGN_COG:
+            return AngleUtils::normalizeToZeroTwoPi(a + fraction * AngleUtils::angleDifference(a, b));
+        default:
+            return a + fraction * (b - a);
+    }
+}
+
+BoatScalar InputAligner::valueAt(AlignedInput input, uint32_t timeMs) const {
+    if (input >= ALIGN_INPUT_COUNT || history_[input].count == 0) {
+        return NAN;
+    }
+    const History& h = history_[input];
+
+    // Walk from the newest sample back to the first one at or before timeMs
+    uint8_t newer = (h.head + CALC_ALIGN_HISTORY - 1) % CALC_ALIGN_HISTORY;
+    if (elapsed(timeMs, h.timeMs[newer]) >= 0) {
+        // At or after the newest sample: extrapolate from the last two
+        int32_t ahead = elapsed(timeMs, h.timeMs[newer]);
+        if (ahead == 0 || h.count < 2) {
+            return h.value[newer];
+        }
+        uint8_t older = (newer + CALC_ALIGN_HISTORY - 1) % CALC_ALIGN_HISTORY;
+        int32_t span = elapsed(h.timeMs[newer], h.timeMs[older]);
+        if (span > CALC_ALIGN_MAX_GAP_MS) {
+            return h.value[newer];  // Slope too old to trust
+        }
+        if (ahead > CALC_ALIGN_MAX_EXTRAPOLATION_MS) {
+            ahead = CALC_ALIGN_MAX_EXTRAPOLATION_MS;
+        }
+        BoatScalar fraction = BoatScalar(span + ahead) / BoatScalar(span);
+        return lerp(input, h.value[older], h.value[newer], fraction);
+    }
+
+    for (uint8_t i = 1; i < h.count; i++) {
+        uint8_t older = (newer + CALC_ALIGN_HISTORY - 1) % CALC_ALIGN_HISTORY;
+        int32_t behind = elapsed(timeMs, h.timeMs[older]);
+        if (behind >= 0) {
+            // Between older and newer: interpolate
+            int32_t span = elapsed(h.timeMs[newer], h.timeMs[older]);
+            if (behind == 0) {
+                return h.value[older];
+            }
+            if (span > CALC_ALIGN_MAX_GAP_MS) {
+                return behind < span - behind ? h.value[older] : h.value[newer];  // Nearest across a gap
+            }
+            return lerp(input, h.value[older], h.value[newer], BoatScalar(behind) / BoatScalar(span));
+        }
+        newer = older;
+    }
+    return h.value[newer];  // Before the oldest sample
+}
@@ -0,0 +1,90 @@
+/**
+ * @file InputAligner.h
+ * @brief Per-input sample history for evaluating inputs at a common time
+ *
+ * The calculation inputs arrive at different rates (AWA 10 Hz, heading
+ * 20 Hz, boat speed and GPS 1 Hz). Combining whatever values are latest
+ * mixes instants that can be a second apart, which shows up as true wind
+ * spikes during tacks. InputAligner keeps the last CALC_ALIGN_HISTORY
+ * (timestamp, value) samples of every input, recorded from the group's
+ * lastUpdate, and evaluates an input at any reference time:
+ * - between two samples: linear interpolation
+ * - after the newest: linear extrapolation from the last two samples,
+ *   limited to CALC_ALIGN_MAX_EXTRAPOLATION_MS (held beyond)
+ * - before the oldest, with one sample, or across a gap longer than
+ *   CALC_ALIGN_MAX_GAP_MS: the nearest sample (no slope)
+ *
+ * Angles interpolate along the shorter arc and are returned in [-π, π]
+ * (AWA) or [0, 2π) (heading, COG). Timestamps compare wrap-safe.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed history per input, zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef INPUT_ALIGNER_H
+#define INPUT_ALIGNER_H
+
+#include <stdint.h>
+#include "../types/BoatScalar.h"
+#include "../config.h"
+
+/**
+ * @brief Aligned calculation inputs
+ */
+enum AlignedInput : uint8_t {
+    ALIGN_AWA = 0,       ///< wind.apparentWindAngle (signed angle)
+    ALIGN_AWS,           ///< wind.apparentWindSpeed
+    ALIGN_BOAT_SPEED,    ///< dst.measuredBoatSpeed
+    ALIGN_HEADING,       ///< compass.magneticHeading (bearing)
+    ALIGN_HEEL,          ///< compass.heelAngle
+    ALIGN_SOG,           ///< gps.sog
+    ALIGN_COG,           ///< gps.cog (bearing)
+    ALIGN_INPUT_COUNT
+};
+
+/**
+ * @class InputAligner
+ * @brief Short, fixed-size sample history per AlignedInput
+ */
+class InputAligner {
+public:
+    InputAligner();
+
+    /**
+     * @brief Add a sample of @p input taken at @p timeMs
+     *
+     * A sample at the newest timestamp replaces it; older timestamps are
+     * ignored (the history stays time-ordered).
+     */
+    void record(AlignedInput input, uint32_t timeMs, BoatScalar value);
+
+    /**
+     * @brief Value of @p input at @p timeMs
+     *
+     * @return NaN if @p input has no samples
+     */
+    BoatScalar valueAt(AlignedInput input, uint32_t timeMs) const;
+
+    /// Samples held for @p input
+    uint8_t count(AlignedInput input) const;
+
+    /// Forget all samples (e.g. after the inputs went stale)
+    void reset();
+
+private:
+    struct History {
+        uint32_t timeMs[CALC_ALIGN_HISTORY];   ///< Ring, oldest at (head - count)
+        BoatScalar value[CALC_ALIGN_HISTORY];
+        uint8_t head;                          ///< Next write position
+        uint8_t count;
+    };
+
+    History history_[ALIGN_INPUT_COUNT];
+
+    static BoatScalar lerp(AlignedInput input, BoatScalar a, BoatScalar b, BoatScalar fraction);
+};
+
+#endif // INPUT_ALIGNER_H
@@ -0,0 +1,179 @@
+/**
+ * @file InstrumentPages.cpp
+ * @brief Implementation of the instrument page table, text cache and pager
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "InstrumentPages.h"
+#include "BoatDataChangeTracker.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+constexpr double RADIANS_TO_DEGREES = 57.29577951308232;
+constexpr double MPS_TO_KNOTS = 1.9438444924406046;
+
+const InstrumentPageSpec PAGE_SPECS[] = {
+    {"SPEED / DEPTH", {InstrumentField::DEPTH, InstrumentField::STW}, {"Depth m", "STW kn"}, BoatDataGroup::DST},
+    {"APPARENT WIND", {InstrumentField::AWA, InstrumentField::AWS}, {"AWA deg", "AWS kn"}, BoatDataGroup::WIND},
+    {"TRUE WIND", {InstrumentField::TWS, InstrumentField::TWD}, {"TWS kn", "TWD deg"}, BoatDataGroup::DERIVED},
+    {"BATTERY A", {InstrumentField::BATTERY_V, InstrumentField::BATTERY_A}, {"Volt V", "Curr A"}, BoatDataGroup::BATTERY},
+};
+
+/// Display decimals of each field (its resolution)
+const uint8_t FIELD_DECIMALS[] = {1, 1, 0, 1, 1, 0, 1, 1};
+
+}  // namespace
+
+bool IsInstrumentPage(OledPage page) {
+    return page >= OledPage::SPEED_DEPTH && page < OledPage::COUNT;
+}
+
+const InstrumentPageSpec* GetInstrumentPageSpec(OledPage page) {
+    if (!IsInstrumentPage(page)) {
+        return nullptr;
+    }
+    return &PAGE_SPECS[static_cast<uint8_t>(page) - static_cast<uint8_t>(OledPage::SPEED_DEPTH)];
+}
+
+bool InstrumentFieldValue(InstrumentField field, const BoatDataStructure& data, double& value) {
+    bool available = false;
+    switch (field) {
+        case InstrumentField::DEPTH:
+            available = data.dst.available;
+            value = data.dst.depth;
+            break;
+        case InstrumentField::STW:
+            available = data.dst.available;
+            value = data.dst.measuredBoatSpeed * MPS_TO_KNOTS;
+            break;
+        case InstrumentField::AWA:
+            available = data.wind.available;
+            value = data.wind.apparentWindAngle * RADIANS_TO_DEGREES;
+            break;
+        case InstrumentField::AWS:
+            available = data.wind.available;
+            value = data.wind.apparentWindSpeed;
+            break;
+        case InstrumentField::TWS:
+            available = data.derived.available;
+            value = data.derived.tws;
+            break;
+        case InstrumentField::TWD:
+            available = data.derived.available;
+            value = data.derived.wdir * RADIANS_TO_DEGREES;
+            break;
+        case InstrumentField::BATTERY_V:
+            available = data.battery.available;
+            value = data.battery.voltageA;
+            break;
+        case InstrumentField::BATTERY_A:
+            available = data.battery.available;
+            value = data.battery.amperageA;
+            break;
+        default:
+            return false;
+    }
+    return available && isfinite(value);
+}
+
+InstrumentFieldCache::InstrumentFieldCache() : formats_(0) {
+    memset(quantized_, 0, sizeof(quantized_));
+    memset(text_, 0, sizeof(text_));
+    invalidate();
+}
+
+void InstrumentFieldCache::invalidate() {
+    for (uint8_t i = 0; i < static_cast<uint8_t>(InstrumentField::COUNT); i++) {
+        state_[i] = UNSET;
+    }
+}
+
+bool InstrumentFieldCache::update(InstrumentField field, bool available, double value) {
+    uint8_t i = static_cast<uint8_t>(field);
+    if (i >= static_cast<uint8_t>(InstrumentField::COUNT)) {
+        return false;
+    }
+
+    if (!available || !isfinite(value)) {
+        if (state_[i] == UNAVAILABLE) {
+            return false;
+        }
+        state_[i] = UNAVAILABLE;
+        snprintf(text_[i], sizeof(text_[i]), "%*s", INSTRUMENT_VALUE_CHARS, "---");
+        formats_++;
+        return true;
+    }
+
+    // Compare at the displayed resolution: a change below the last digit is not redrawn
+    uint8_t decimals = FIELD_DECIMALS[i];
+    double scaled = decimals == 0 ? value : value * 10.0;
+    // Clamped to what fits INSTRUMENT_VALUE_CHARS ("-999.9".."9999.9", "-9999".."99999")
+    if (scaled > 99999.0) {
+        scaled = 99999.0;
+    } else if (scaled < -9999.0) {
+        scaled = -9999.0;
+    }
+    int32_t quantized = static_cast<int32_t>(lround(scaled));
+    if (field == InstrumentField::TWD) {
+        quantized = ((quantized % 360) + 360) % 360;  // 359.6 shows as 0, not 360
+    }
+    if (state_[i] == SHOWN && quantized == quantized_[i]) {
+        return false;
+    }
+
+    state_[i] = SHOWN;
+    quantized_[i] = quantized;
+    snprintf(text_[i], sizeof(text_[i]), "%*.*f", INSTRUMENT_VALUE_CHARS, decimals,
+             decimals == 0 ? static_cast<double>(quantized) : quantized / 10.0);
+    formats_++;
+    return true;
+}
+
+const char* InstrumentFieldCache::text(InstrumentField field) const {
+    uint8_t i = static_cast<uint8_t>(field);
+    return i < static_cast<uint8_t>(InstrumentField::COUNT) ? text_[i] : "";
+}
+
+DisplayPager::DisplayPager(uint32_t rotateMs, bool reactionsPage)
+    : rotateMs_(rotateMs),
+      reactionsPage_(reactionsPage),
+      page_(OledPage::STATUS),
+      buttonWasPressed_(false),
+      started_(false),
+      shownSinceMs_(0),
+      presses_(0) {
+}
+
+bool DisplayPager::poll(bool buttonPressed, uint32_t nowMs) {
+    if (!started_) {
+        started_ = true;
+        shownSinceMs_ = nowMs;
+    }
+
+    bool pressed = buttonPressed && !buttonWasPressed_;
+    buttonWasPressed_ = buttonPressed;
+    if (pressed) {
+        presses_++;
+        next(nowMs);
+        return true;
+    }
+    if (rotateMs_ > 0 && nowMs - shownSinceMs_ >= rotateMs_) {
+        next(nowMs);
+        return true;
+    }
+    return false;
+}
+
+void DisplayPager::next(uint32_t nowMs) {
+    uint8_t index = static_cast<uint8_t>(page_);
+    do {
+        index = static_cast<uint8_t>((index + 1) % static_cast<uint8_t>(OledPage::COUNT));
+    } while (!reactionsPage_ && index == static_cast<uint8_t>(OledPage::REACTIONS));
+    page_ = static_cast<OledPage>(index);
+    shownSinceMs_ = nowMs;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file InstrumentPages.h
+ * @brief OLED instrument pages: field table, formatted-text cache and page selection
+ *
+ * Instrument pages show two BoatData values each in large digits:
+ *
+ * | Page | Fields | BoatData groups |
+ * |------|--------|-----------------|
+ * | SPEED_DEPTH | DEPTH (m), STW (kn) | DST |
+ * | APPARENT_WIND | AWA (deg, negative = port), AWS (kn) | WIND |
+ * | TRUE_WIND | TWS (kn), TWD (deg) | DERIVED |
+ * | BATTERY | BATTERY_V, BATTERY_A (bank A) | BATTERY |
+ *
+ * InstrumentFieldCache keeps each field's value quantized to its display
+ * resolution (1 or 0 decimals) together with the text formatted from it.
+ * update() formats only when the quantized value changed, and reports
+ * whether the text changed: a page redraws a value when it moved by at
+ * least one displayed digit, and snprintf runs once per visible change
+ * instead of once per refresh.
+ *
+ * DisplayPager cycles STATUS → (REACTIONS) → instrument pages every
+ * DISPLAY_PAGE_ROTATE_MS; a button press moves to the next page at once
+ * and restarts the rotation timer.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed tables, no heap; formatting only on change
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef INSTRUMENT_PAGES_H
+#define INSTRUMENT_PAGES_H
+
+#include <stdint.h>
+#include "../config.h"
+#include "../types/BoatDataTypes.h"
+
+/**
+ * @brief Values shown on the instrument pages
+ */
+enum class InstrumentField : uint8_t {
+    DEPTH = 0,
+    STW,
+    AWA,
+    AWS,
+    TWS,
+    TWD,
+    BATTERY_V,
+    BATTERY_A,
+    COUNT
+};
+
+/**
+ * @brief OLED pages in rotation order
+ */
+enum class OledPage : uint8_t {
+    STATUS = 0,
+    REACTIONS,       ///< Only with REACTION_PROFILER_OLED_PAGE
+    SPEED_DEPTH,
+    APPARENT_WIND,
+    TRUE_WIND,
+    BATTERY,
+    COUNT
+};
+
+/// Fields per instrument page
+#define INSTRUMENT_PAGE_FIELDS 2
+
+/// Characters of a value text (big digits, 12 columns each)
+#define INSTRUMENT_VALUE_CHARS 6
+
+/**
+ * @brief Layout and data dependencies of an instrument page
+ */
+struct InstrumentPageSpec {
+    const char* title;
+    InstrumentField fields[INSTRUMENT_PAGE_FIELDS];
+    const char* labels[INSTRUMENT_PAGE_FIELDS];   ///< Name and unit, size 1
+    uint16_t groups;                              ///< BoatDataGroup mask the fields come from
+};
+
+/// The page is one of the instrument pages
+bool IsInstrumentPage(OledPage page);
+
+/// Spec of instrument page @p page (nullptr for STATUS and REACTIONS)
+const InstrumentPageSpec* GetInstrumentPageSpec(OledPage page);
+
+/**
+ * @brief Current value of @p field in display units
+ * @return false if its group is unavailable or the value is not finite
+ */
+bool InstrumentFieldValue(InstrumentField field, const BoatDataStructure& data, double& value);
+
+/**
+ * @class InstrumentFieldCache
+ * @brief Formatted text of each field, reformatted only on a visible change
+ */
+class InstrumentFieldCache {
+public:
+    InstrumentFieldCache();
+
+    /**
+     * @brief Offer the field's current value
+     *
+     * @param available false shows "---"
+     * @return true if the text changed (the value must be redrawn)
+     */
+    bool update(InstrumentField field, bool available, double value);
+
+    /// Right-aligned text, INSTRUMENT_VALUE_CHARS wide (padding erases a longer old text)
+    const char* text(InstrumentField field) const;
+
+    /// The next update() of every field reports a change (page drawn from scratch)
+    void invalidate();
+
+    /// snprintf calls so far
+    uint32_t getFormats() const { return formats_; }
+
+private:
+    enum : uint8_t { UNSET = 0, UNAVAILABLE, SHOWN };
+
+    uint8_t state_[static_cast<uint8_t>(InstrumentField::COUNT)];
+    int32_t quantized_[static_cast<uint8_t>(InstrumentField::COUNT)];
+    char text_[static_cast<uint8_t>(InstrumentField::COUNT)][INSTRUMENT_VALUE_CHARS + 1];
+    uint32_t formats_;
+};
+
+/**
+ * @class DisplayPager
+ * @brief Selected page: timed rotation and a push button
+ */
+class DisplayPager {
+public:
+    /**
+     * @param rotateMs Rotation interval (0 = button only)
+     * @param reactionsPage Include OledPage::REACTIONS
+     */
+    DisplayPager(uint32_t rotateMs = DISPLAY_PAGE_ROTATE_MS, bool reactionsPage = true);
+
+    /**
+     * @brief Sample the button and the rotation timer
+     *
+     * A press is the released-to-pressed edge between two polls (the poll
+     * interval debounces the contact).
+     *
+     * @return true if the page changed
+     */
+    bool poll(bool buttonPressed, uint32_t nowMs);
+
+    OledPage page() const { return page_; }
+
+    /// Presses seen so far
+    uint32_t getPresses() const { return presses_; }
+
+private:
+    void next(uint32_t nowMs);
+
+    uint32_t rotateMs_;
+    bool reactionsPage_;
+    OledPage page_;
+    bool buttonWasPressed_;
+    bool started_;
+    uint32_t shownSinceMs_;
+    uint32_t presses_;
+};
+
+#endif // INSTRUMENT_PAGES_H
@@ -0,0 +1,137 @@
+/**
+ * @file IoPump.cpp
+ * @brief Implementation of the budgeted input pump
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "IoPump.h"
+
+IoPump::IoPump(MicrosClock clock)
+    : clock_(clock), count_(0), first_(0), pending_(false), ticks_(0), budgetHits_(0), maxTickUs_(0) {
+}
+
+int8_t IoPump::add(const char* name, IoPumpStep step, void* context, uint32_t intervalMs) {
+    if (step == nullptr || count_ >= IO_PUMP_MAX_SOURCES) {
+        return -1;
+    }
+    IoPumpSource& source = sources_[count_];
+    source.name = name;
+    source.step = step;
+    source.context = context;
+    source.intervalMs = intervalMs;
+    source.lastRunMs = 0;
+    source.hasRun = false;
+    source.steps = 0;
+    source.busyUs = 0;
+    source.maxStepUs = 0;
+    source.deferred = 0;
+    return static_cast<int8_t>(count_++);
+}
+
+bool IoPump::run(uint32_t nowMs, uint32_t budgetUs) {
+    if (count_ == 0) {
+        return false;
+    }
+    uint32_t startUs = clock_();
+    ticks_++;
+
+    // Due sources take part in this tick
+    bool pending[IO_PUMP_MAX_SOURCES];
+    bool anyPending = false;
+    for (uint8_t i = 0; i < count_; i++) {
+        const IoPumpSource& source = sources_[i];
+        pending[i] = source.intervalMs == 0 || !source.hasRun || nowMs - source.lastRunMs >= source.intervalMs;
+        anyPending |= pending[i];
+    }
+
+    uint8_t first = first_;
+    first_ = static_cast<uint8_t>((first_ + 1) % count_);
+
+    bool outOfBudget = false;
+    while (anyPending && !outOfBudget) {
+        anyPending = false;
+        for (uint8_t n = 0; n < count_; n++) {
+            uint8_t i = static_cast<uint8_t>((first + n) % count_);
+            if (!pending[i]) {
+                continue;
+            }
+            IoPumpSource& source = sources_[i];
+            source.lastRunMs = nowMs;
+            source.hasRun = true;
+
+            uint32_t stepStartUs = clock_();
+            pending[i] = source.step(source.context);
+            uint32_t stepUs = clock_() - stepStartUs;
+            source.steps++;
+            source.busyUs += stepUs;
+            if (stepUs > source.maxStepUs) {
+                source.maxStepUs = stepUs;
+            }
+            anyPending |= pending[i];
+
+            if (clock_() - startUs >= budgetUs) {
+                outOfBudget = true;
+                break;
+            }
+        }
+    }
+
+    // Budget spent: whatever is still due waits for the next tick
+    bool deferred = false;
+    if (outOfBudget) {
+        for (uint8_t i = 0; i < count_; i++) {
+            if (pending[i]) {
+                sources_[i].deferred++;
+                deferred = true;
+            }
+        }
+        if (deferred) {
+            budgetHits_++;
+        }
+    }
+
+    uint32_t tickUs = clock_() - startUs;
+    if (tickUs > maxTickUs_) {
+        maxTickUs_ = tickUs;
+    }
+    pending_ = deferred;
+    return deferred;
+}
+
+const IoPumpSource* IoPump::at(uint8_t id) const {
+    return id < count_ ? &sources_[id] : nullptr;
+}
+
+bool IoPump::writeStats(JsonWriter& json) const {
+    json.beginObject()
+        .add("ticks", (unsigned long)ticks_)
+        .add("budget_hits", (unsigned long)budgetHits_)
+        .add("max_tick_us", (unsigned long)maxTickUs_)
+        .beginArray("sources");
+    for (uint8_t i = 0; i < count_; i++) {
+        const IoPumpSource& source = sources_[i];
+        json.beginObject()
+            .add("name", source.name)
+            .add("steps", (unsigned long)source.steps)
+            .add("busy_us", (unsigned long)source.busyUs)
+            .add("max_us", (unsigned long)source.maxStepUs)
+            .add("deferred", (unsigned long)source.deferred)
+            .endObject();
+    }
+    json.endArray().endObject();
+    return !json.overflowed();
+}
+
+void IoPump::clearStats() {
+    for (uint8_t i = 0; i < count_; i++) {
+        sources_[i].steps = 0;
+        sources_[i].busyUs = 0;
+        sources_[i].maxStepUs = 0;
+        sources_[i].deferred = 0;
+    }
+    ticks_ = 0;
+    budgetHits_ = 0;
+    maxTickUs_ = 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file IoPump.h
+ * @brief One main-loop reaction that drains every bus input within a time budget
+ *
+ * Instead of one app.onRepeat() per input (NMEA 0183 sentences, NMEA2000
+ * frames or queued updates, 1-Wire), main.cpp registers each input as a
+ * source and calls run() from a single IO_PUMP_INTERVAL_MS reaction:
+ *
+ * @code
+ * ioPump.add("n0183", [](void* ctx) { return static_cast<NMEA0183Handler*>(ctx)->pumpSentences(4); },
+ *            nmea0183Handler);
+ * ioPump.add("ow_apply", [](void*) { oneWireTask.service(); return false; }, nullptr, ONEWIRE_APPLY_INTERVAL_MS);
+ * app.onRepeat(IO_PUMP_INTERVAL_MS, []() { ioPump.run(millis(), IO_PUMP_BUDGET_US); });
+ * @endcode
+ *
+ * A step does one bounded unit of work (a few lines, one parse pass, a
+ * batch of updates) and returns true if more is waiting. run():
+ * - gives every due source one step per round, starting one source later
+ *   each tick so no input is always served first
+ * - repeats rounds while a source reports more work
+ * - stops as soon as a tick has used @p budgetUs, leaving the rest for the
+ *   next tick (counted per source as "deferred")
+ *
+ * A source with an interval is only due once that long has passed since
+ * its last step (the 1-Wire readings in layout 1); interval 0 means every tick.
+ *
+ * Arduino-free (the microsecond clock is injected, unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed source table of IO_PUMP_MAX_SOURCES, no heap
+ * - Principle VII (Fail-Safe): a flooded input is cut off at the budget instead of stalling the loop
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef IO_PUMP_H
+#define IO_PUMP_H
+
+#include <stdint.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/// Returns a free-running microsecond count
+typedef uint32_t (*MicrosClock)();
+
+/// One bounded unit of work; returns true if more is waiting
+typedef bool (*IoPumpStep)(void* context);
+
+/**
+ * @brief Registration and counters of one source
+ */
+struct IoPumpSource {
+    const char* name;           ///< Static string (not copied)
+    IoPumpStep step;
+    void* context;
+    uint32_t intervalMs;        ///< 0 = every tick
+    uint32_t lastRunMs;         ///< nowMs of the last tick the source ran in
+    bool hasRun;
+    uint32_t steps;             ///< Since the last clearStats()
+    uint32_t busyUs;
+    uint32_t maxStepUs;
+    uint32_t deferred;          ///< Ticks that ended on the budget with this source still pending
+};
+
+/**
+ * @class IoPump
+ * @brief Budgeted round-robin over the input sources (main loop only)
+ */
+class IoPump {
+public:
+    explicit IoPump(MicrosClock clock);
+
+    /**
+     * @brief Register a source
+     *
+     * @param name Static label (IO_PUMP_STATS)
+     * @param intervalMs Minimum time between the ticks the source runs in (0 = every tick)
+     * @return Source ID, or -1 if the table is full
+     */
+    int8_t add(const char* name, IoPumpStep step, void* context, uint32_t intervalMs = 0);
+
+    /**
+     * @brief One pump tick
+     *
+     * @param nowMs millis() (source intervals)
+     * @param budgetUs Stop starting steps once the tick has run this long
+     * @return true if the budget ran out with work still pending
+     */
+    bool run(uint32_t nowMs, uint32_t budgetUs);
+
+    uint8_t count() const { return count_; }
+
+    /// Source @p id (nullptr if out of range)
+    const IoPumpSource* at(uint8_t id) const;
+
+    /// The last tick ended on the budget with input still waiting
+    bool hasPending() const { return pending_; }
+
+    uint32_t getTicks() const { return ticks_; }
+    uint32_t getBudgetHits() const { return budgetHits_; }
+    uint32_t getMaxTickUs() const { return maxTickUs_; }
+
+    /**
+     * @brief Write the counters as a JSON object
+     *
+     * {"ticks":6000,"budget_hits":2,"max_tick_us":3105,
+     *  "sources":[{"name":"n0183","steps":6100,"busy_us":90000,"max_us":900,"deferred":1},...]}
+     *
+     * @return false if @p json overflowed
+     */
+    bool writeStats(JsonWriter& json) const;
+
+    /// Zero the counters (registrations and intervals are kept)
+    void clearStats();
+
+private:
+    MicrosClock clock_;
+    IoPumpSource sources_[IO_PUMP_MAX_SOURCES];
+    uint8_t count_;
+    uint8_t first_;             ///< Source served first in the next tick
+    bool pending_;              ///< Result of the last run()
+    uint32_t ticks_;
+    uint32_t budgetHits_;
+    uint32_t maxTickUs_;
+};
+
+#endif // IO_PUMP_H
@@ -0,0 +1,276 @@
+/**
+ * @file JsonWriter.cpp
+ * @brief Implementation of the fixed-buffer JSON writer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "JsonWriter.h"
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <math.h>
+
+JsonWriter::JsonWriter(char* buffer, size_t size)
+    : buffer(buffer), size(size) {
+    reset();
+}
+
+void JsonWriter::reset() {
+    len = 0;
+    depth = 0;
+    hasMembers = 0;
+    overflow = (size == 0);
+    if (size > 0) {
+        buffer[0] = '\0';
+    }
+}
+
+void JsonWriter::clearOutput() {
+    len = 0;
+    overflow = (size == 0);
+    if (size > 0) {
+        buffer[0] = '\0';
+    }
+}
+
+void JsonWriter::put(char c) {
+    if (len + 1 >= size) {
+        overflow = true;
+        return;
+    }
+    buffer[len++] = c;
+    buffer[len] = '\0';
+}
+
+void JsonWriter::put(const char* text) {
+    while (*text != '\0') {
+        put(*text++);
+    }
+}
+
+void JsonWriter::putEscaped(const char* text) {
+    put('"');
+    for (const char* p = text; *p != '\0'; p++) {
+        char c = *p;
+        switch (c) {
+            case '"':  put("\\\""); break;
+            case '\\': put("\\\\"); break;
+            case '\n': put("\\n"); break;
+            case '\r': put("\\r"); break;
+            case '\t': put("\\t"); break;
+            default:
+                if (static_cast<uint8_t>(c) < 0x20) {
+                    putFormatted("\\u%04x", static_cast<unsigned>(static_cast<uint8_t>(c)));
+                } else {
+                    put(c);
+                }
+                break;
+        }
+    }
+    put('"');
+}
+
+void JsonWriter::putFormatted(const char* format, ...) {
+    if (len >= size) {
+        overflow = true;
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buffer + len, size - len, format, args);
+    va_end(args);
+
+    if (written < 0 || static_cast<size_t>(written) >= size - len) {
+        buffer[len] = '\0';  // Drop the partial token
+        overflow = true;
+        return;
+    }
+    len += written;
+}
+
+void JsonWriter::separator() {
+    if (depth == 0) {
+        return;
+    }
+    uint16_t bit = 1u << (depth - 1);
+    if (hasMembers & bit) {
+        put(',');
+    }
+    hasMembers |= bit;
+}
+
+void JsonWriter::key(const char* name) {
+    separator();
+    putEscaped(name != nullptr ? name : "");
+    put(':');
+}
+
+void JsonWriter::open(char bracket) {
+    put(bracket);
+    if (depth >= MAX_DEPTH) {
+        overflow = true;
+        return;
+    }
+    depth++;
+    hasMembers &= ~(1u << (depth - 1));
+}
+
+void JsonWriter::close(char bracket) {
+    if (depth > 0) {
+        depth--;
+    }
+    put(bracket);
+}
+
+void JsonWriter::putDouble(double value, uint8_t decimals) {
+    if (isnan(value) || isinf(value)) {
+        put("null");  // Not representable in JSON
+        return;
+    }
+
+    // Fixed point without printf: scale, round half away from zero, emit the digits.
+    // Exact while the scaled value fits the 53-bit mantissa; larger ones take printf.
+    static const double POW10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9};
+    double scaled = decimals < sizeof(POW10) / sizeof(POW10[0]) ? fabs(value) * POW10[decimals] : 1e16;
+    if (scaled >= 1e15) {
+        putFormatted("%.*f", static_cast<int>(decimals), value);
+        return;
+    }
+
+    uint64_t units = static_cast<uint64_t>(scaled + 0.5);
+    if (value < 0.0 && units != 0) {
+        put('-');  // No "-0.00" for values that round to zero
+    }
+    char digits[24];
+    uint8_t n = 0;
+    do {
+        digits[n++] = static_cast<char>('0' + units % 10);
+        units /= 10;
+    } while (units != 0 || n <= decimals);  // At least one integer digit
+
+    while (n > 0) {
+        if (n == decimals) {
+            put('.');
+        }
+        put(digits[--n]);
+    }
+}
+
+JsonWriter& JsonWriter::beginObject() { separator(); open('{'); return *this; }
+JsonWriter& JsonWriter::beginObject(const char* name) { key(name); open('{'); return *this; }
+JsonWriter& JsonWriter::endObject() { close('}'); return *this; }
+JsonWriter& JsonWriter::beginArray() { separator(); open('['); return *this; }
+JsonWriter& JsonWriter::beginArray(const char* name) { key(name); open('['); return *this; }
+JsonWriter& JsonWriter::endArray() { close(']'); return *this; }
+
+JsonWriter& JsonWriter::add(const char* name, const char* value) {
+    key(name);
+    if (value == nullptr) {
+        put("null");
+    } else {
+        putEscaped(value);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* name, bool value) {
+    key(name);
+    put(value ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* name, int value) {
+    key(name);
+    putFormatted("%d", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* name, unsigned int value) {
+    key(name);
+    putFormatted("%u", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* name, long value) {
+    key(name);
+    putFormatted("%ld", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* name, unsigned long value) {
+    key(name);
+    putFormatted("%lu", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* name, double value, uint8_t decimals) {
+    key(name);
+    putDouble(value, decimals);
+    return *this;
+}
+
+JsonWriter& JsonWriter::addRaw(const char* name, const char* json) {
+    key(name);
+    put(json != nullptr && json[0] != '\0' ? json : "null");
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(const char* value) {
+    separator();
+    if (value == nullptr) {
+        put("null");
+    } else {
+        putEscaped(value);
+    }
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(bool value) {
+    separator();
+    put(value ? "true" : "false");
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(int value) {
+    separator();
+    putFormatted("%d", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(unsigned int value) {
+    separator();
+    putFormatted("%u", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(long value) {
+    separator();
+    putFormatted("%ld", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(unsigned long value) {
+    separator();
+    putFormatted("%lu", value);
+    return *this;
+}
+
+JsonWriter& JsonWriter::add(double value, uint8_t decimals) {
+    separator();
+    putDouble(value, decimals);
+    return *this;
+}
+
+JsonWriter& JsonWriter::addRaw(const char* json) {
+    separator();
+    put(json != nullptr && json[0] != '\0' ? json : "null");
+    return *this;
+}
+
+JsonWriter& JsonWriter::appendRaw(const char* text) {
+    put(text);
+    return *this;
+}
@@ -0,0 +1,156 @@
+/**
+ * @file JsonWriter.h
+ * @brief Streaming JSON writer over a caller-supplied fixed buffer
+ *
+ * Replaces hand-built `String +=` JSON in log payloads and HTTP responses.
+ * Output goes straight into a stack or member buffer, so building a payload
+ * performs no heap allocation and cannot fragment the heap over long uptimes.
+ * Separators are inserted automatically and strings are escaped.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): zero heap allocation
+ * - Principle VII (Fail-Safe): overflow is detected and reported, never written past the buffer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef JSON_WRITER_H
+#define JSON_WRITER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+
+/**
+ * @class JsonWriter
+ * @brief Appends JSON tokens to a fixed buffer, always NUL-terminated
+ *
+ * Keyed add() calls are for object members, unkeyed ones for array elements.
+ *
+ * Usage pattern:
+ * @code
+ * StaticJsonWriter<128> json;
+ * json.beginObject()
+ *     .add("ssid", ssid)
+ *     .add("attempt", attempt)
+ *     .add("rssi", -67.5, 1)
+ *     .beginArray("sources").add("GPS-A").add("GPS-B").endArray()
+ *     .endObject();
+ * if (!json.overflowed()) {
+ *     send(json.c_str(), json.length());
+ * }
+ * @endcode
+ *
+ * @note Nesting is limited to MAX_DEPTH levels; deeper structures set overflowed().
+ */
+class JsonWriter {
+public:
+    static constexpr uint8_t MAX_DEPTH = 16;
+
+    /**
+     * @brief Constructor
+     * @param buffer Output buffer (written from the start)
+     * @param size Buffer size in bytes, including the terminating NUL
+     */
+    JsonWriter(char* buffer, size_t size);
+
+    /**
+     * @brief Discard output and start over
+     */
+    void reset();
+
+    /**
+     * @brief Discard output but keep the open containers
+     *
+     * For documents sent in pieces (ChunkedJsonStream): writing continues
+     * inside the same objects and arrays, with the right separators.
+     */
+    void clearOutput();
+
+    JsonWriter& beginObject();
+    JsonWriter& beginObject(const char* key);
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& beginArray(const char* key);
+    JsonWriter& endArray();
+
+    /** @name Object members */
+    ///@{
+    JsonWriter& add(const char* key, const char* value);  ///< Escaped string (nullptr = null)
+    JsonWriter& add(const char* key, bool value);
+    JsonWriter& add(const char* key, int value);
+    JsonWriter& add(const char* key, unsigned int value);
+    JsonWriter& add(const char* key, long value);
+    JsonWriter& add(const char* key, unsigned long value);
+    JsonWriter& add(const char* key, double value, uint8_t decimals = 2);  ///< NaN/Inf = null
+    JsonWriter& addRaw(const char* key, const char* json);  ///< Pre-encoded JSON value, copied verbatim
+    ///@}
+
+    /** @name Array elements */
+    ///@{
+    JsonWriter& add(const char* value);
+    JsonWriter& add(bool value);
+    JsonWriter& add(int value);
+    JsonWriter& add(unsigned int value);
+    JsonWriter& add(long value);
+    JsonWriter& add(unsigned long value);
+    JsonWriter& add(double value, uint8_t decimals = 2);
+    JsonWriter& addRaw(const char* json);
+    ///@}
+
+#ifdef ARDUINO
+    JsonWriter& add(const char* key, const String& value) { return add(key, value.c_str()); }
+    JsonWriter& add(const String& value) { return add(value.c_str()); }
+#endif
+
+    /**
+     * @brief Append raw characters with no separator handling
+     *
+     * For framing around the JSON (e.g. a trailing newline).
+     */
+    JsonWriter& appendRaw(const char* text);
+
+    const char* c_str() const { return buffer; }
+    size_t length() const { return len; }
+
+    /**
+     * @brief true if any output was lost (buffer too small or nesting too deep)
+     */
+    bool overflowed() const { return overflow; }
+
+private:
+    char* buffer;
+    size_t size;
+    size_t len;
+    uint8_t depth;
+    uint16_t hasMembers;  ///< Bit n set = container at depth n already has an element
+    bool overflow;
+
+    void put(char c);
+    void put(const char* text);
+    void putEscaped(const char* text);
+    void putFormatted(const char* format, ...) __attribute__((format(printf, 2, 3)));
+    void separator();
+    void key(const char* name);
+    void open(char bracket);
+    void close(char bracket);
+    void putDouble(double value, uint8_t decimals);
+};
+
+/**
+ * @brief JsonWriter with its own storage of N bytes
+ */
+template <size_t N>
+class StaticJsonWriter : public JsonWriter {
+public:
+    StaticJsonWriter() : JsonWriter(storage, N) {}
+
+private:
+    char storage[N];
+};
+
+#endif // JSON_WRITER_H
@@ -0,0 +1,95 @@
+/**
+ * @file LatencyHistogram.cpp
+ * @brief Implementation of the log-scale latency histogram
+ *
+ * Bucket layout: latencies 0-3 µs map to buckets 0-3. Above that, with
+ * msb = index of the highest set bit, the bucket is 2*msb plus the next
+ * lower bit, i.e. [2^msb, 1.5*2^msb) and [1.5*2^msb, 2^(msb+1)).
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "LatencyHistogram.h"
+#include <string.h>
+
+LatencyHistogram::LatencyHistogram() {
+    reset();
+}
+
+void LatencyHistogram::reset() {
+    memset(buckets, 0, sizeof(buckets));
+    count = 0;
+    totalUs = 0;
+    minUs = UINT32_MAX;
+    maxUs = 0;
+}
+
+uint8_t LatencyHistogram::bucketFor(uint32_t latencyUs) {
+    if (latencyUs < 4) {
+        return static_cast<uint8_t>(latencyUs);
+    }
+
+    uint8_t msb = static_cast<uint8_t>(31 - __builtin_clz(latencyUs));  // NSAU on Xtensa: one instruction
+    uint8_t half = (latencyUs >> (msb - 1)) & 1;
+    uint32_t bucket = 2u * msb + half;
+    return bucket < BUCKETS ? static_cast<uint8_t>(bucket) : BUCKETS - 1;
+}
+
+uint32_t LatencyHistogram::bucketUpperEdge(uint8_t bucket) {
+    if (bucket < 4) {
+        return bucket + 1;
+    }
+    if (bucket >= BUCKETS - 1) {
+        return UINT32_MAX;  // Overflow bucket
+    }
+
+    uint8_t msb = bucket / 2;
+    uint32_t lower = (1UL << msb) + (bucket & 1) * (1UL << (msb - 1));
+    return lower + (1UL << (msb - 1));
+}
+
+void LatencyHistogram::record(uint32_t latencyUs, uint32_t samples) {
+    if (samples == 0) {
+        return;
+    }
+
+    buckets[bucketFor(latencyUs)] += samples;
+    count += samples;
+    totalUs += static_cast<uint64_t>(latencyUs) * samples;
+    if (latencyUs < minUs) {
+        minUs = latencyUs;
+    }
+    if (latencyUs > maxUs) {
+        maxUs = latencyUs;
+    }
+}
+
+uint32_t LatencyHistogram::getAverage() const {
+    return count > 0 ? static_cast<uint32_t>(totalUs / count) : 0;
+}
+
+uint32_t LatencyHistogram::getPercentile(uint8_t percent) const {
+    if (count == 0) {
+        return 0;
+    }
+    if (percent > 100) {
+        percent = 100;
+    }
+
+    // Rank of the requested sample, 1-based, rounded up
+    uint64_t rank = (static_cast<uint64_t>(count) * percent + 99) / 100;
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (uint8_t i = 0; i < BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            uint32_t edge = bucketUpperEdge(i);
+            return edge - 1 < maxUs ? edge - 1 : maxUs;
+        }
+    }
+    return maxUs;
+}
@@ -0,0 +1,78 @@
+/**
+ * @file LatencyHistogram.h
+ * @brief Fixed-size log-scale latency histogram (min/avg/p99/max)
+ *
+ * Buckets split every power of two of microseconds in half, so resolution
+ * stays within 50% from a few µs up to about one second with 42 counters.
+ * Percentiles are reported as the upper edge of the bucket holding the
+ * requested rank (clamped to the observed maximum).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed storage, zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+
+/**
+ * @class LatencyHistogram
+ * @brief Single-writer latency accumulator
+ *
+ * @note record() from one context only; readers in another context may see
+ *       a sample counted in one field but not yet in another.
+ */
+class LatencyHistogram {
+public:
+    static constexpr uint8_t BUCKETS = 42;  ///< Covers 0 µs .. ~1.05 s, last bucket = overflow
+
+    LatencyHistogram();
+
+    /**
+     * @brief Add @p samples observations of @p latencyUs
+     */
+    void record(uint32_t latencyUs, uint32_t samples = 1);
+
+    /**
+     * @brief Forget all observations
+     */
+    void reset();
+
+    uint32_t getCount() const { return count; }
+    uint32_t getMin() const { return count > 0 ? minUs : 0; }
+    uint32_t getMax() const { return maxUs; }
+    uint32_t getAverage() const;
+
+    /// Observations in @p bucket (0 if out of range)
+    uint32_t getBucket(uint8_t bucket) const { return bucket < BUCKETS ? buckets[bucket] : 0; }
+
+    /**
+     * @brief Latency at or below which @p percent of samples fall
+     * @param percent 0-100 (e.g. 99 for p99)
+     * @return Bucket upper edge in µs, 0 if no samples
+     */
+    uint32_t getPercentile(uint8_t percent) const;
+
+    /**
+     * @brief Bucket index for a latency (exposed for tests)
+     */
+    static uint8_t bucketFor(uint32_t latencyUs);
+
+    /**
+     * @brief Exclusive upper edge of a bucket in µs
+     */
+    static uint32_t bucketUpperEdge(uint8_t bucket);
+
+private:
+    uint32_t buckets[BUCKETS];
+    uint32_t count;
+    uint64_t totalUs;
+    uint32_t minUs;
+    uint32_t maxUs;
+};
+
+#endif // LATENCY_HISTOGRAM_H
@@ -8,7 +8,12 @@
 #ifndef LOG_ENUMS_H
 #define LOG_ENUMS_H
 
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
+#include <string.h>
+#include <strings.h>
+#include "LogNames.h"
 
 /**
  * @brief Log level enumeration
@@ -56,35 +61,45 @@ inline const char* logLevelToString(LogLevel level) {
  * @param levelStr Log level as string (case-insensitive)
  * @return Parsed log level (defaults to INFO if unknown)
  */
-inline LogLevel parseLogLevel(const String& levelStr) {
-    String upper = levelStr;
-    upper.toUpperCase();
+inline LogLevel parseLogLevel(const char* levelStr) {
+    if (levelStr == nullptr) return LogLevel::INFO;
 
-    if (upper == "DEBUG") return LogLevel::DEBUG;
-    if (upper == "INFO")  return LogLevel::INFO;
-    if (upper == "WARN")  return LogLevel::WARN;
-    if (upper == "ERROR") return LogLevel::ERROR;
-    if (upper == "FATAL") return LogLevel::FATAL;
+    if (strcasecmp(levelStr, "DEBUG") == 0) return LogLevel::DEBUG;
+    if (strcasecmp(levelStr, "INFO") == 0)  return LogLevel::INFO;
+    if (strcasecmp(levelStr, "WARN") == 0)  return LogLevel::WARN;
+    if (strcasecmp(levelStr, "ERROR") == 0) return LogLevel::ERROR;
+    if (strcasecmp(levelStr, "FATAL") == 0) return LogLevel::FATAL;
 
     return LogLevel::INFO;  // Default to INFO if unknown
 }
 
+#ifdef ARDUINO
+/**
+ * @brief Parse log level from Arduino String
+ * @param levelStr Log level as string (case-insensitive)
+ * @return Parsed log level (defaults to INFO if unknown)
+ */
+inline LogLevel parseLogLevel(const String& levelStr) {
+    return parseLogLevel(levelStr.c_str());
+}
+#endif
+
 /**
- * @brief Convert connection event to string
+ * @brief Map a connection event to its log event ID
  * @param event Connection event
- * @return Event as string
+ * @return Event ID (the event names match the enumerator names)
  */
-inline const char* connectionEventToString(ConnectionEvent event) {
+inline LogEvent connectionEventToLogEvent(ConnectionEvent event) {
     switch (event) {
-        case ConnectionEvent::CONNECTION_ATTEMPT:  return "CONNECTION_ATTEMPT";
-        case ConnectionEvent::CONNECTION_SUCCESS:  return "CONNECTION_SUCCESS";
-        case ConnectionEvent::CONNECTION_FAILED:   return "CONNECTION_FAILED";
-        case ConnectionEvent::CONNECTION_LOST:     return "CONNECTION_LOST";
-        case ConnectionEvent::CONFIG_LOADED:       return "CONFIG_LOADED";
-        case ConnectionEvent::CONFIG_SAVED:        return "CONFIG_SAVED";
-        case ConnectionEvent::CONFIG_INVALID:      return "CONFIG_INVALID";
-        case ConnectionEvent::REBOOT_SCHEDULED:    return "REBOOT_SCHEDULED";
-        default:                                   return "UNKNOWN_EVENT";
+        case ConnectionEvent::CONNECTION_ATTEMPT:  return LogEvent::CONNECTION_ATTEMPT;
+        case ConnectionEvent::CONNECTION_SUCCESS:  return LogEvent::CONNECTION_SUCCESS;
+        case ConnectionEvent::CONNECTION_FAILED:   return LogEvent::CONNECTION_FAILED;
+        case ConnectionEvent::CONNECTION_LOST:     return LogEvent::CONNECTION_LOST;
+        case ConnectionEvent::CONFIG_LOADED:       return LogEvent::CONFIG_LOADED;
+        case ConnectionEvent::CONFIG_SAVED:        return LogEvent::CONFIG_SAVED;
+        case ConnectionEvent::CONFIG_INVALID:      return LogEvent::CONFIG_INVALID;
+        case ConnectionEvent::REBOOT_SCHEDULED:    return LogEvent::REBOOT_SCHEDULED;
+        default:                                   return LogEvent::COUNT;  // Resolves to "unknown"
     }
 }
 
@@ -0,0 +1,205 @@
+/**
+ * @file LogFilter.cpp
+ * @brief Implementation of the precompiled WebSocket log filter
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "LogFilter.h"
+#include <string.h>
+
+namespace {
+
+inline bool isSpace(char c) {
+    return c == ' ' || c == '\t';
+}
+
+/**
+ * @brief Iterate over trimmed, non-empty terms of a comma-separated list
+ */
+template <typename Fn>
+void forEachTerm(const char* list, Fn fn) {
+    const char* p = list;
+    while (*p != '\0') {
+        while (*p == ',' || isSpace(*p)) {
+            p++;
+        }
+
+        const char* start = p;
+        while (*p != '\0' && *p != ',') {
+            p++;
+        }
+
+        const char* end = p;
+        while (end > start && isSpace(end[-1])) {
+            end--;
+        }
+
+        if (end > start) {
+            fn(start, static_cast<size_t>(end - start));
+        }
+    }
+}
+
+}  // namespace
+
+LogFilter::LogFilter() {
+    clear();
+}
+
+void LogFilter::clear() {
+    minLevel = LogLevel::INFO;
+    setComponents("");
+    setEventPrefixes("");
+}
+
+void LogFilter::setComponents(const char* list) {
+    strncpy(components, list != nullptr ? list : "", sizeof(components) - 1);
+    components[sizeof(components) - 1] = '\0';  // Ensure null termination
+    compileComponents();
+}
+
+void LogFilter::setEventPrefixes(const char* list) {
+    strncpy(eventPrefixes, list != nullptr ? list : "", sizeof(eventPrefixes) - 1);
+    eventPrefixes[sizeof(eventPrefixes) - 1] = '\0';  // Ensure null termination
+    compileEventPrefixes();
+}
+
+uint32_t LogFilter::hashName(const char* name, size_t len) {
+    // FNV-1a, 32-bit
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash ^= static_cast<uint8_t>(name[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void LogFilter::compileComponents() {
+    componentCount = 0;
+    memset(componentTable, 0, sizeof(componentTable));
+
+    forEachTerm(components, [this](const char* term, size_t len) {
+        addComponentTerm(term, len);
+    });
+}
+
+void LogFilter::addComponentTerm(const char* term, size_t len) {
+    // Terms longer than any component name can never match - skip them
+    if (len >= COMPONENT_NAME_SIZE || componentCount >= MAX_COMPONENT_TERMS) {
+        return;
+    }
+
+    uint32_t hash = hashName(term, len);
+    uint8_t slot = hash & (COMPONENT_TABLE_SIZE - 1);
+
+    while (componentTable[slot] != 0) {
+        uint8_t idx = componentTable[slot] - 1;
+        if (componentHashes[idx] == hash && strncmp(componentNames[idx], term, len) == 0 &&
+            componentNames[idx][len] == '\0') {
+            return;  // Duplicate term
+        }
+        slot = (slot + 1) & (COMPONENT_TABLE_SIZE - 1);
+    }
+
+    uint8_t idx = componentCount++;
+    componentHashes[idx] = hash;
+    memcpy(componentNames[idx], term, len);
+    componentNames[idx][len] = '\0';
+    componentTable[slot] = idx + 1;
+}
+
+void LogFilter::compileEventPrefixes() {
+    trieNodeCount = 1;
+    trie[0] = {'\0', NO_NODE, NO_NODE, false};
+    matchAllEvents = (eventPrefixes[0] == '\0');
+
+    forEachTerm(eventPrefixes, [this](const char* prefix, size_t len) {
+        addEventPrefix(prefix, len);
+    });
+}
+
+void LogFilter::addEventPrefix(const char* prefix, size_t len) {
+    uint8_t node = 0;
+
+    for (size_t i = 0; i < len; i++) {
+        uint8_t child = trie[node].firstChild;
+        while (child != NO_NODE && trie[child].c != prefix[i]) {
+            child = trie[child].nextSibling;
+        }
+
+        if (child == NO_NODE) {
+            if (trieNodeCount >= MAX_TRIE_NODES) {
+                return;  // Cannot happen: nodes are bounded by the raw string length
+            }
+            child = trieNodeCount++;
+            trie[child] = {prefix[i], NO_NODE, trie[node].firstChild, false};
+            trie[node].firstChild = child;
+        }
+
+        node = child;
+    }
+
+    trie[node].terminal = true;
+}
+
+bool LogFilter::matchesComponent(LogLevel level, const char* component) const {
+    // Level check - message level must be >= minimum level
+    if (level < minLevel) {
+        return false;
+    }
+
+    // Component check (empty = match all)
+    if (components[0] == '\0') {
+        return true;
+    }
+    if (component == nullptr || componentCount == 0) {
+        return false;
+    }
+
+    size_t len = strlen(component);
+    uint32_t hash = hashName(component, len);
+    uint8_t slot = hash & (COMPONENT_TABLE_SIZE - 1);
+
+    while (componentTable[slot] != 0) {
+        uint8_t idx = componentTable[slot] - 1;
+        if (componentHashes[idx] == hash && strcmp(componentNames[idx], component) == 0) {
+            return true;
+        }
+        slot = (slot + 1) & (COMPONENT_TABLE_SIZE - 1);
+    }
+
+    return false;
+}
+
+bool LogFilter::matchesEvent(const char* event) const {
+    // Event prefix check (empty = match all)
+    if (matchAllEvents) {
+        return true;
+    }
+    if (event == nullptr) {
+        return false;
+    }
+
+    uint8_t node = 0;
+    for (const char* p = event; *p != '\0'; p++) {
+        uint8_t child = trie[node].firstChild;
+        while (child != NO_NODE && trie[child].c != *p) {
+            child = trie[child].nextSibling;
+        }
+        if (child == NO_NODE) {
+            return false;
+        }
+        if (trie[child].terminal) {
+            return true;
+        }
+        node = child;
+    }
+
+    return false;
+}
+
+bool LogFilter::matches(LogLevel level, const char* component, const char* event) const {
+    return matchesComponent(level, component) && matchesEvent(event);
+}
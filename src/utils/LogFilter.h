@@ -0,0 +1,129 @@
+/**
+ * @file LogFilter.h
+ * @brief Precompiled level/component/event filter for WebSocket logging
+ *
+ * The comma-separated filter strings set over HTTP are compiled once, when
+ * they change, into:
+ * - a small open-addressed hash set of component names (interned term IDs)
+ * - a character trie of event name prefixes
+ *
+ * A match check then allocates nothing and touches only a few bytes per
+ * character of the component/event name, independent of the number of terms.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed-size tables, zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef LOG_FILTER_H
+#define LOG_FILTER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "LogEnums.h"
+
+/**
+ * @class LogFilter
+ * @brief Single shared filter applied to all /logs clients
+ *
+ * Empty component/event lists match all messages. Component terms match
+ * exactly; event terms match as prefixes. Whitespace around terms is ignored.
+ */
+class LogFilter {
+public:
+    static constexpr size_t TEXT_SIZE = 128;            ///< Raw filter string buffer size
+    static constexpr uint8_t MAX_COMPONENT_TERMS = 16;  ///< Component names kept in the set
+    static constexpr size_t COMPONENT_NAME_SIZE = 24;   ///< Longest component term + NUL
+
+    LogLevel minLevel = LogLevel::INFO;  ///< Minimum log level (default: INFO)
+
+    LogFilter();
+
+    /**
+     * @brief Replace the component list and recompile the component set
+     * @param components Comma-separated component names (empty/nullptr = all)
+     */
+    void setComponents(const char* components);
+
+    /**
+     * @brief Replace the event prefix list and recompile the prefix trie
+     * @param events Comma-separated event prefixes (empty/nullptr = all)
+     */
+    void setEventPrefixes(const char* events);
+
+    /**
+     * @brief Reset to defaults (INFO level, all components/events)
+     */
+    void clear();
+
+    /**
+     * @brief Raw component list as configured (for persistence / status JSON)
+     */
+    const char* getComponents() const { return components; }
+
+    /**
+     * @brief Raw event prefix list as configured (for persistence / status JSON)
+     */
+    const char* getEventPrefixes() const { return eventPrefixes; }
+
+    /**
+     * @brief Check if a log message matches this filter
+     * @param level Message log level
+     * @param component Message component
+     * @param event Message event name
+     * @return true if message should be logged
+     */
+    bool matches(LogLevel level, const char* component, const char* event) const;
+
+    /**
+     * @brief Check level and component only (no event prefix walk)
+     * @param level Message log level
+     * @param component Message component
+     * @return true if level and component pass the filter
+     */
+    bool matchesComponent(LogLevel level, const char* component) const;
+
+    /**
+     * @brief Check event name against the event prefix trie only
+     * @param event Message event name
+     * @return true if event matches a prefix (or no prefix filter set)
+     */
+    bool matchesEvent(const char* event) const;
+
+private:
+    static constexpr uint8_t COMPONENT_TABLE_SIZE = 32;  ///< Hash slots (2x terms, power of two)
+    static constexpr uint8_t MAX_TRIE_NODES = TEXT_SIZE; ///< Bounded by total prefix characters
+    static constexpr uint8_t NO_NODE = 0xFF;
+
+    struct TrieNode {
+        char c;               ///< Character on the edge into this node
+        uint8_t firstChild;   ///< Index of first child (NO_NODE = leaf)
+        uint8_t nextSibling;  ///< Index of next sibling (NO_NODE = last)
+        bool terminal;        ///< A configured prefix ends here
+    };
+
+    char components[TEXT_SIZE];
+    char eventPrefixes[TEXT_SIZE];
+
+    // Compiled component set: table slot -> term index + 1 (0 = empty)
+    uint8_t componentCount;
+    uint8_t componentTable[COMPONENT_TABLE_SIZE];
+    uint32_t componentHashes[MAX_COMPONENT_TERMS];
+    char componentNames[MAX_COMPONENT_TERMS][COMPONENT_NAME_SIZE];
+
+    // Compiled event prefix trie, node 0 is the root
+    uint8_t trieNodeCount;
+    bool matchAllEvents;
+    TrieNode trie[MAX_TRIE_NODES];
+
+    static uint32_t hashName(const char* name, size_t len);
+
+    void compileComponents();
+    void compileEventPrefixes();
+    void addComponentTerm(const char* term, size_t len);
+    void addEventPrefix(const char* prefix, size_t len);
+};
+
+#endif // LOG_FILTER_H
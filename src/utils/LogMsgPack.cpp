@@ -0,0 +1,140 @@
+/**
+ * @file LogMsgPack.cpp
+ * @brief Implementation of the MessagePack writer and log name table
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "LogMsgPack.h"
+#include <string.h>
+
+MsgPackWriter::MsgPackWriter(uint8_t* buffer, size_t size)
+    : buffer(buffer), size(size) {
+    reset();
+}
+
+void MsgPackWriter::reset() {
+    len = 0;
+    overflow = false;
+}
+
+void MsgPackWriter::put(uint8_t byte) {
+    if (len >= size) {
+        overflow = true;
+        return;
+    }
+    buffer[len++] = byte;
+}
+
+void MsgPackWriter::putBytes(const void* bytes, size_t count) {
+    if (count > size - len) {
+        overflow = true;
+        return;
+    }
+    memcpy(buffer + len, bytes, count);
+    len += count;
+}
+
+MsgPackWriter& MsgPackWriter::array(uint8_t count) {
+    if (count < 16) {
+        put(0x90 | count);        // fixarray
+    } else {
+        put(0xDC);                // array 16
+        put(0);
+        put(count);
+    }
+    return *this;
+}
+
+MsgPackWriter& MsgPackWriter::integer(uint32_t value) {
+    if (value < 0x80) {
+        put(static_cast<uint8_t>(value));   // positive fixint
+    } else if (value <= 0xFF) {
+        put(0xCC);
+        put(static_cast<uint8_t>(value));
+    } else if (value <= 0xFFFF) {
+        put(0xCD);
+        put(static_cast<uint8_t>(value >> 8));
+        put(static_cast<uint8_t>(value));
+    } else {
+        put(0xCE);
+        put(static_cast<uint8_t>(value >> 24));
+        put(static_cast<uint8_t>(value >> 16));
+        put(static_cast<uint8_t>(value >> 8));
+        put(static_cast<uint8_t>(value));
+    }
+    return *this;
+}
+
+MsgPackWriter& MsgPackWriter::str(const char* value) {
+    return str(value != nullptr ? value : "", value != nullptr ? strlen(value) : 0);
+}
+
+MsgPackWriter& MsgPackWriter::str(const char* value, size_t count) {
+    if (count < 32) {
+        put(0xA0 | static_cast<uint8_t>(count));   // fixstr
+    } else if (count <= 0xFF) {
+        put(0xD9);
+        put(static_cast<uint8_t>(count));
+    } else if (count <= 0xFFFF) {
+        put(0xDA);
+        put(static_cast<uint8_t>(count >> 8));
+        put(static_cast<uint8_t>(count));
+    } else {
+        put(0xDB);
+        put(static_cast<uint8_t>(count >> 24));
+        put(static_cast<uint8_t>(count >> 16));
+        put(static_cast<uint8_t>(count >> 8));
+        put(static_cast<uint8_t>(count));
+    }
+    putBytes(value, count);
+    return *this;
+}
+
+MsgPackWriter& MsgPackWriter::nil() {
+    put(0xC0);
+    return *this;
+}
+
+LogNameTable::LogNameTable() : nameCount(0) {
+    memset(table, 0, sizeof(table));
+}
+
+uint8_t LogNameTable::intern(const char* name, bool& added) {
+    added = false;
+    if (name == nullptr) {
+        return NONE;
+    }
+
+    size_t len = strlen(name);
+    if (len >= NAME_SIZE) {
+        return NONE;
+    }
+
+    // FNV-1a, 32-bit (same as LogFilter)
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ static_cast<uint8_t>(name[i])) * 16777619u;
+    }
+
+    uint16_t slot = hash & (TABLE_SIZE - 1);
+    while (table[slot] != 0) {
+        uint8_t id = table[slot] - 1;
+        if (hashes[id] == hash && strcmp(names[id], name) == 0) {
+            return id;
+        }
+        slot = (slot + 1) & (TABLE_SIZE - 1);
+    }
+
+    if (nameCount >= MAX_NAMES) {
+        return NONE;
+    }
+
+    uint8_t id = nameCount++;
+    hashes[id] = hash;
+    memcpy(names[id], name, len + 1);
+    table[slot] = id + 1;
+    added = true;
+    return id;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file LogMsgPack.h
+ * @brief MessagePack encoding and name interning for binary /logs clients
+ *
+ * Binary clients receive a stream of MessagePack arrays (several may share
+ * one WebSocket frame; the format is self-delimiting):
+ *   [0, id, "name"]                                  dictionary entry
+ *   [1, timestamp, level, component, event, data]    log record
+ * component/event are dictionary IDs (uint) when interned, or plain strings
+ * when the table is full or the record was not sent from the drain context.
+ * data is the JSON payload text, or nil when the message has none.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed-size tables, zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef LOG_MSGPACK_H
+#define LOG_MSGPACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+/**
+ * @brief Message type tags (first element of every array)
+ */
+enum class LogMsgPackType : uint8_t {
+    DICTIONARY = 0,
+    RECORD = 1
+};
+
+/**
+ * @class MsgPackWriter
+ * @brief Appends MessagePack values to a caller-supplied buffer
+ *
+ * Only the types the log stream needs: array headers, unsigned integers,
+ * strings and nil. Overflow is flagged; nothing is written past the buffer.
+ */
+class MsgPackWriter {
+public:
+    MsgPackWriter(uint8_t* buffer, size_t size);
+
+    void reset();
+
+    MsgPackWriter& array(uint8_t count);
+    MsgPackWriter& integer(uint32_t value);
+    MsgPackWriter& str(const char* value);
+    MsgPackWriter& str(const char* value, size_t len);
+    MsgPackWriter& nil();
+
+    const uint8_t* data() const { return buffer; }
+    size_t length() const { return len; }
+    bool overflowed() const { return overflow; }
+
+private:
+    uint8_t* buffer;
+    size_t size;
+    size_t len;
+    bool overflow;
+
+    void put(uint8_t byte);
+    void putBytes(const void* bytes, size_t count);
+};
+
+/**
+ * @class LogNameTable
+ * @brief Interns component/event names to small integer IDs
+ *
+ * IDs are assigned in order of first use and never reused, so a client that
+ * has seen entries 0..N-1 can decode every record that refers to them.
+ *
+ * @note Call intern() from the drain context only.
+ */
+class LogNameTable {
+public:
+    static constexpr uint8_t MAX_NAMES = LOG_INTERN_MAX_NAMES;
+    static constexpr size_t NAME_SIZE = 40;  ///< Longest name in LogNames.h + NUL
+    static constexpr uint8_t NONE = 0xFF;    ///< Returned when a name cannot be interned
+
+    static_assert(MAX_NAMES < NONE, "LOG_INTERN_MAX_NAMES must be below 255");
+
+    LogNameTable();
+
+    /**
+     * @brief Look up or add a name
+     * @param name Component or event name
+     * @param added Output: true if the name was added by this call
+     * @return ID, or NONE if the table is full or the name too long
+     */
+    uint8_t intern(const char* name, bool& added);
+
+    /**
+     * @brief Number of interned names (IDs 0 .. count() - 1)
+     */
+    uint8_t count() const { return nameCount; }
+
+    /**
+     * @brief Name for an ID (nullptr if out of range)
+     */
+    const char* name(uint8_t id) const { return id < nameCount ? names[id] : nullptr; }
+
+private:
+    static constexpr uint16_t TABLE_SIZE = 128;  ///< Hash slots (2x names, power of two)
+
+    static_assert(TABLE_SIZE >= 2 * MAX_NAMES, "Name hash table too small");
+
+    uint8_t nameCount;
+    uint8_t table[TABLE_SIZE];       ///< Slot -> ID + 1 (0 = empty)
+    uint32_t hashes[MAX_NAMES];
+    char names[MAX_NAMES][NAME_SIZE];
+};
+
+#endif // LOG_MSGPACK_H
@@ -0,0 +1,40 @@
+/**
+ * @file LogNames.cpp
+ * @brief Name tables expanded from the LogNames.h lists
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "LogNames.h"
+#include <stddef.h>
+
+namespace {
+
+const char* const COMPONENT_NAMES[] = {
+#define LOG_COMPONENT_NAME_(id, name) name,
+    LOG_COMPONENT_LIST(LOG_COMPONENT_NAME_)
+#undef LOG_COMPONENT_NAME_
+};
+
+const char* const EVENT_NAMES[] = {
+#define LOG_EVENT_NAME_(id) #id,
+    LOG_EVENT_LIST(LOG_EVENT_NAME_)
+#undef LOG_EVENT_NAME_
+};
+
+static_assert(sizeof(COMPONENT_NAMES) / sizeof(COMPONENT_NAMES[0]) == static_cast<size_t>(LogComponent::COUNT),
+              "One name per LogComponent");
+static_assert(sizeof(EVENT_NAMES) / sizeof(EVENT_NAMES[0]) == static_cast<size_t>(LogEvent::COUNT),
+              "One name per LogEvent");
+static_assert(static_cast<size_t>(LogComponent::COUNT) <= UINT8_MAX, "LogComponent IDs are one byte");
+
+}  // namespace
+
+const char* LogComponentName(LogComponent component) {
+    return component < LogComponent::COUNT ? COMPONENT_NAMES[static_cast<uint8_t>(component)] : "unknown";
+}
+
+const char* LogEventName(LogEvent event) {
+    return event < LogEvent::COUNT ? EVENT_NAMES[static_cast<uint16_t>(event)] : "unknown";
+}
@@ -0,0 +1,327 @@
+/**
+ * @file LogNames.h
+ * @brief Compile-time tables of log component and event names (ID -> name)
+ *
+ * Log call sites name their component and event by enumerator:
+ *
+ * @code
+ * logger.broadcastLogf(LogLevel::DEBUG, LogComponent::NMEA2000, LogEvent::PGN127251_UPDATE,
+ *                      "{\"rateOfTurn\":%.2f}", rateOfTurn);
+ * @endcode
+ *
+ * Both enums and their name tables are expanded from the X-macro lists
+ * below, so an ID and its name cannot drift apart. The tables are const
+ * arrays of string literals: .rodata, read from flash on the ESP32 (no
+ * RAM copy, no PROGMEM needed). Queued log records carry the IDs (one
+ * and two bytes) instead of name copies; they are resolved to text only
+ * where names are needed: filter matching, the crash ring and encoding a
+ * message for its clients.
+ *
+ * IDs are only meaningful within one build (nothing persists them):
+ * add new names anywhere in the lists, in alphabetical order. Event
+ * enumerators must not collide with config.h macros (TASK_LAYOUT is
+ * logged as TASK_LAYOUT_SELECTED for that reason).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): names live in flash, records carry small IDs
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef LOG_NAMES_H
+#define LOG_NAMES_H
+
+#include <stdint.h>
+
+/// X(id, "name"): the component names of /logs messages and filters
+#define LOG_COMPONENT_LIST(X) \
+    X(AIS, "Ais") \
+    X(ALARM, "Alarm") \
+    X(BOAT_DATA, "BoatData") \
+    X(BOATDATA_SERIALIZER, "BoatDataSerializer") \
+    X(BOATDATA_STREAM, "BoatDataStream") \
+    X(BOATDATA_UDP, "BoatDataUdp") \
+    X(BUS_CAPTURE, "BusCapture") \
+    X(BUS_REPLAY, "BusReplay") \
+    X(CALCULATION_ENGINE, "CalculationEngine") \
+    X(DATA_TABLES, "DataTables") \
+    X(DISPLAY_MANAGER, "DisplayManager") \
+    X(HEAP, "Heap") \
+    X(HISTORY_RECORDER, "HistoryRecorder") \
+    X(HTTP_FILE_SERVER, "HTTPFileServer") \
+    X(IMU, "Imu") \
+    X(IO_PUMP, "IoPump") \
+    X(KEEP_ALIVE, "KeepAlive") \
+    X(LOGGER, "Logger") \
+    X(MAIN, "Main") \
+    X(MDNS, "Mdns") \
+    X(NMEA0183, "NMEA0183") \
+    X(NMEA2000, "NMEA2000") \
+    X(ONE_WIRE, "OneWire") \
+    X(OTA_UPDATE, "OtaUpdate") \
+    X(PERFORMANCE, "Performance") \
+    X(PERSISTENCE, "Persistence") \
+    X(POLAR, "Polar") \
+    X(SCHEDULER, "Scheduler") \
+    X(SIGNALK, "SignalK") \
+    X(TASKS, "Tasks") \
+    X(VOYAGE_RECORDER, "VoyageRecorder") \
+    X(WATCHDOG, "Watchdog") \
+    X(WEB_SERVER, "WebServer") \
+    X(WIFI_MANAGER, "WiFiManager")
+
+/// X(id): event names, the enumerator spelled as sent
+#define LOG_EVENT_LIST(X) \
+    X(ALARM_CLEARED) \
+    X(ALARM_RAISED) \
+    X(ALARM_RULES_INVALID) \
+    X(ALARM_RULES_LOADED) \
+    X(ANCHOR_DROPPED) \
+    X(ANCHOR_RAISED) \
+    X(ASSET_TABLE_FULL) \
+    X(BATTERY_READ_FAILED) \
+    X(BATTERY_UPDATE) \
+    X(BINARY_SUCCESS) \
+    X(BOATDATA_UDP_STARTED) \
+    X(BOATDATA_UDP_STATS) \
+    X(BOOT_TIMELINE) \
+    X(BROADCAST) \
+    X(BROADCAST_TIMER_STARTED) \
+    X(BUFFER_OVERFLOW) \
+    X(BUFFER_PLACEMENT) \
+    X(CALC_TIMING) \
+    X(CALIBRATION_LEARNED) \
+    X(CAPTURE_ALLOC_FAILED) \
+    X(CAPTURE_STARTED) \
+    X(CAPTURE_START_IGNORED) \
+    X(CAPTURE_STOPPED) \
+    X(CAPTURE_TASK_FAILED) \
+    X(CLIENT_CONNECTED) \
+    X(CLIENT_DISCONNECTED) \
+    X(CLIENT_EVICTED) \
+    X(CONFIG_APPLIED) \
+    X(CONFIG_INVALID) \
+    X(CONFIG_LOADED) \
+    X(CONFIG_REJECTED) \
+    X(CONFIG_SAVED) \
+    X(CONFIG_SAVE_FAILED) \
+    X(CONNECTION_ATTEMPT) \
+    X(CONNECTION_FAILED) \
+    X(CONNECTION_LOST) \
+    X(CONNECTION_SUCCESS) \
+    X(CONNECT_FAILED) \
+    X(CONNECT_TIME) \
+    X(DATA_STALE) \
+    X(DELTA_SUCCESS) \
+    X(DISPLAY_INIT_FAILED) \
+    X(DISPLAY_INIT_SUCCESS) \
+    X(ENDPOINT_REGISTERED) \
+    X(FILE_NOT_FOUND) \
+    X(FILE_OPEN_FAILED) \
+    X(FILE_SERVED) \
+    X(GOVERNOR_STATE) \
+    X(GPS_FIX_PUBLISHED) \
+    X(HANDLERS_REGISTERED) \
+    X(HEAP_ALLOC_FAILED) \
+    X(HEAP_FRAGMENTED) \
+    X(HEAP_RECOVERED) \
+    X(HEAP_STATS) \
+    X(HEARTBEAT) \
+    X(HISTORY_ALLOC_FAILED) \
+    X(HISTORY_READY) \
+    X(INIT) \
+    X(INIT_FAILED) \
+    X(INIT_SUCCESS) \
+    X(INVALID_GROUP) \
+    X(IO_PUMP_STATS) \
+    X(LOG_DROPPED) \
+    X(LOG_FILTER_UPDATED) \
+    X(LOOP_FREQUENCY) \
+    X(LOOP_LATENCY) \
+    X(MAX_CLIENTS_EXCEEDED) \
+    X(MDNS_FAILED) \
+    X(MDNS_STARTED) \
+    X(MDNS_TXT_UPDATED) \
+    X(MULTICAST_FAILED) \
+    X(N0183_PORT_STATS) \
+    X(N0183_TCP_STATS) \
+    X(N2K_LOAD_DONE) \
+    X(N2K_LOAD_STARTED) \
+    X(N2K_RX_LATENCY) \
+    X(N2K_RX_STATS) \
+    X(N2K_TX_STATS) \
+    X(NO_SERIAL_DATA) \
+    X(NULL_POINTER) \
+    X(ONEWIRE_INIT_FAILED) \
+    X(ONEWIRE_INIT_SUCCESS) \
+    X(ONEWIRE_STATS) \
+    X(ONEWIRE_TASK_FAILED) \
+    X(ONEWIRE_TASK_STARTED) \
+    X(PATH_TOO_LONG) \
+    X(PERFORMANCE_EXCEEDED) \
+    X(PGN126992_NA) \
+    X(PGN126992_PARSE_FAILED) \
+    X(PGN126992_UPDATE) \
+    X(PGN127250_NA) \
+    X(PGN127250_PARSE_FAILED) \
+    X(PGN127250_UNKNOWN_REF) \
+    X(PGN127250_UPDATE) \
+    X(PGN127251_NA) \
+    X(PGN127251_OUT_OF_RANGE) \
+    X(PGN127251_PARSE_FAILED) \
+    X(PGN127251_UPDATE) \
+    X(PGN127252_NA) \
+    X(PGN127252_OUT_OF_RANGE) \
+    X(PGN127252_PARSE_FAILED) \
+    X(PGN127252_UPDATE) \
+    X(PGN127257_HEEL_EXCESSIVE) \
+    X(PGN127257_PARSE_FAILED) \
+    X(PGN127257_PITCH_OUT_OF_RANGE) \
+    X(PGN127257_UPDATE) \
+    X(PGN127258_NA) \
+    X(PGN127258_OUT_OF_RANGE) \
+    X(PGN127258_PARSE_FAILED) \
+    X(PGN127258_UPDATE) \
+    X(PGN127488_NA) \
+    X(PGN127488_PARSE_FAILED) \
+    X(PGN127488_RPM_OUT_OF_RANGE) \
+    X(PGN127488_UPDATE) \
+    X(PGN127489_OIL_TEMP_HIGH) \
+    X(PGN127489_OIL_TEMP_OUT_OF_RANGE) \
+    X(PGN127489_PARSE_FAILED) \
+    X(PGN127489_UPDATE) \
+    X(PGN127489_VOLTAGE_ABNORMAL) \
+    X(PGN127489_VOLTAGE_OUT_OF_RANGE) \
+    X(PGN127505_LEVEL_OUT_OF_RANGE) \
+    X(PGN127505_NA) \
+    X(PGN127505_PARSE_FAILED) \
+    X(PGN127505_UPDATE) \
+    X(PGN128259_NA) \
+    X(PGN128259_OUT_OF_RANGE) \
+    X(PGN128259_PARSE_FAILED) \
+    X(PGN128259_UPDATE) \
+    X(PGN128267_INVALID_DEPTH) \
+    X(PGN128267_NA) \
+    X(PGN128267_PARSE_FAILED) \
+    X(PGN128267_UPDATE) \
+    X(PGN129025_NA) \
+    X(PGN129025_OUT_OF_RANGE) \
+    X(PGN129025_PARSE_FAILED) \
+    X(PGN129025_UPDATE) \
+    X(PGN129026_NA) \
+    X(PGN129026_PARSE_FAILED) \
+    X(PGN129026_SOG_OUT_OF_RANGE) \
+    X(PGN129026_UPDATE) \
+    X(PGN129029_NA) \
+    X(PGN129029_OUT_OF_RANGE) \
+    X(PGN129029_PARSE_FAILED) \
+    X(PGN129029_UPDATE) \
+    X(PGN129038_NA) \
+    X(PGN129038_PARSE_FAILED) \
+    X(PGN129038_UPDATE) \
+    X(PGN129039_NA) \
+    X(PGN129039_PARSE_FAILED) \
+    X(PGN129039_UPDATE) \
+    X(PGN129284_NA) \
+    X(PGN129284_OUT_OF_RANGE) \
+    X(PGN129284_PARSE_FAILED) \
+    X(PGN129284_UPDATE) \
+    X(PGN130306_IGNORED) \
+    X(PGN130306_NA) \
+    X(PGN130306_OUT_OF_RANGE) \
+    X(PGN130306_PARSE_FAILED) \
+    X(PGN130306_UPDATE) \
+    X(PGN130316_NA) \
+    X(PGN130316_OUT_OF_RANGE) \
+    X(PGN130316_PARSE_FAILED) \
+    X(PGN130316_UPDATE) \
+    X(PGN_DECODED_NA) \
+    X(PGN_DECODED_OUT_OF_RANGE) \
+    X(PGN_DECODED_PARSE_FAILED) \
+    X(PGN_DECODED_UPDATE) \
+    X(PGN_IGNORED) \
+    X(PIPELINE_LATENCY) \
+    X(POLAR_INVALID) \
+    X(POLAR_LOADED) \
+    X(POLLING_STARTED) \
+    X(PREVIOUS_BOOT_LOG) \
+    X(PREVIOUS_STALL) \
+    X(REACTION_STALL) \
+    X(REBOOT_SCHEDULED) \
+    X(RENDER_STATUS_PAGE) \
+    X(REPLAY_DONE) \
+    X(REPLAY_FAILED) \
+    X(REPLAY_STARTED) \
+    X(ROUTES_INVALID) \
+    X(ROUTES_LOADED) \
+    X(ROUTES_PORT_UNKNOWN) \
+    X(RX_MODE) \
+    X(RX_TASK_FAILED) \
+    X(SAILDRIVE_READ_FAILED) \
+    X(SAILDRIVE_UPDATE) \
+    X(SCHEDULER_STATS) \
+    X(SENTENCE_PROCESSED) \
+    X(SENTENCE_REJECTED) \
+    X(SERIALIZATION_FAILED) \
+    X(SERIALIZATION_SUCCESS) \
+    X(SERIAL_DATA_AVAILABLE) \
+    X(SHORE_POWER_READ_FAILED) \
+    X(SHORE_POWER_UPDATE) \
+    X(SIGNALK_SUCCESS) \
+    X(SOAK_STARTED) \
+    X(SOAK_TREND) \
+    X(SOAK_WRITE_FAILED) \
+    X(SOFTAP_FAILED) \
+    X(SOFTAP_RETRY) \
+    X(SOFTAP_STARTED) \
+    X(SOFTAP_STOPPED) \
+    X(SOURCE_REGISTERED) \
+    X(SOURCE_TABLE_FULL) \
+    X(STALL_RESET) \
+    X(STALL_WATCHDOG_FAILED) \
+    X(STALL_WATCHDOG_STARTED) \
+    X(STARTED) \
+    X(STATIC_ASSET_ADDED) \
+    X(STATIC_FOOTPRINT) \
+    X(BUILD_PROFILE) \
+    X(SUBSCRIBED) \
+    X(TASK_LAYOUT_SELECTED) \
+    X(TASK_STACKS) \
+    X(TCP_CLIENT_CONNECTED) \
+    X(TCP_CLIENT_DISCONNECTED) \
+    X(TCP_CLIENT_DROPPED) \
+    X(TCP_STREAM_STARTED) \
+    X(UART_RX_STATS) \
+    X(UPDATE_FAILED) \
+    X(UPDATE_INSTALLED) \
+    X(UPDATE_STARTED) \
+    X(UTC_CLOCK_STEPPED) \
+    X(VOYAGE_ALLOC_FAILED) \
+    X(VOYAGE_SEGMENT_CLOSED) \
+    X(VOYAGE_SEGMENT_STARTED) \
+    X(VOYAGE_TASK_FAILED) \
+    X(WIFI_PROFILE_APPLIED) \
+    X(WIFI_PROFILE_FAILED)
+
+enum class LogComponent : uint8_t {
+#define LOG_COMPONENT_ENUM_(id, name) id,
+    LOG_COMPONENT_LIST(LOG_COMPONENT_ENUM_)
+#undef LOG_COMPONENT_ENUM_
+    COUNT
+};
+
+enum class LogEvent : uint16_t {
+#define LOG_EVENT_ENUM_(id) id,
+    LOG_EVENT_LIST(LOG_EVENT_ENUM_)
+#undef LOG_EVENT_ENUM_
+    COUNT
+};
+
+/// Component name ("NMEA2000", ...); "unknown" if out of range
+const char* LogComponentName(LogComponent component);
+
+/// Event name ("PGN127251_UPDATE", ...); "unknown" if out of range
+const char* LogEventName(LogEvent event);
+
+#endif // LOG_NAMES_H
@@ -0,0 +1,112 @@
+/**
+ * @file LogRateLimiter.cpp
+ * @brief Implementation of the per-(component,event) log token bucket
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "LogRateLimiter.h"
+#include <string.h>
+
+namespace {
+
+void copyName(char* dest, size_t size, const char* src) {
+    strncpy(dest, src != nullptr ? src : "", size - 1);
+    dest[size - 1] = '\0';
+}
+
+}  // namespace
+
+LogRateLimiter::LogRateLimiter(uint16_t ratePerSec, uint16_t burst)
+    : ratePerSec(ratePerSec), capacity(static_cast<uint32_t>(burst) * 1000), suppressedTotal(0) {
+    reset();
+}
+
+void LogRateLimiter::reset() {
+    memset(entries, 0, sizeof(entries));
+    suppressedTotal = 0;
+}
+
+uint32_t LogRateLimiter::hashKey(const char* component, const char* event) {
+    // FNV-1a over "component/event"
+    uint32_t hash = 2166136261u;
+    for (const char* p = component; p != nullptr && *p != '\0'; p++) {
+        hash = (hash ^ static_cast<uint8_t>(*p)) * 16777619u;
+    }
+    hash = (hash ^ '/') * 16777619u;
+    for (const char* p = event; p != nullptr && *p != '\0'; p++) {
+        hash = (hash ^ static_cast<uint8_t>(*p)) * 16777619u;
+    }
+    return hash;
+}
+
+LogRateLimiter::Entry* LogRateLimiter::findOrCreate(const char* component, const char* event, uint32_t now) {
+    uint32_t hash = hashKey(component, event);
+    Entry* freeSlot = nullptr;
+    Entry* oldest = nullptr;
+
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        Entry& e = entries[i];
+        if (!e.used) {
+            if (freeSlot == nullptr) {
+                freeSlot = &e;
+            }
+            continue;
+        }
+        if (e.hash == hash && strncmp(e.component, component != nullptr ? component : "", COMPONENT_SIZE - 1) == 0 &&
+            strncmp(e.event, event != nullptr ? event : "", EVENT_SIZE - 1) == 0) {
+            return &e;
+        }
+        // Only entries with nothing left to report may be evicted
+        if (e.suppressed == 0 && (oldest == nullptr || now - e.lastSeen > now - oldest->lastSeen)) {
+            oldest = &e;
+        }
+    }
+
+    Entry* slot = (freeSlot != nullptr) ? freeSlot : oldest;
+    if (slot == nullptr) {
+        return nullptr;  // Every slot holds pending suppression counts
+    }
+
+    slot->used = true;
+    slot->hash = hash;
+    slot->tokens = capacity;
+    slot->lastRefill = now;
+    slot->lastSeen = now;
+    slot->suppressed = 0;
+    slot->suppressStart = now;
+    copyName(slot->component, sizeof(slot->component), component);
+    copyName(slot->event, sizeof(slot->event), event);
+    return slot;
+}
+
+bool LogRateLimiter::allow(uint8_t level, const char* component, const char* event, uint32_t now) {
+    Entry* e = findOrCreate(component, event, now);
+    if (e == nullptr) {
+        return true;  // Table full - fail open
+    }
+
+    // Refill: ratePerSec messages per 1000 ms = ratePerSec milli-tokens per ms
+    uint32_t elapsed = now - e->lastRefill;
+    if (elapsed > 0) {
+        uint32_t maxElapsed = (capacity / (ratePerSec > 0 ? ratePerSec : 1)) + 1;
+        uint32_t refill = (elapsed > maxElapsed ? maxElapsed : elapsed) * ratePerSec;
+        e->tokens = (e->tokens + refill > capacity) ? capacity : e->tokens + refill;
+        e->lastRefill = now;
+    }
+    e->lastSeen = now;
+
+    if (e->tokens >= 1000) {
+        e->tokens -= 1000;
+        return true;
+    }
+
+    if (e->suppressed == 0) {
+        e->suppressStart = now;
+    }
+    e->suppressed++;
+    e->level = level;
+    suppressedTotal++;
+    return false;
+}
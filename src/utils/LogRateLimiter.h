@@ -0,0 +1,136 @@
+/**
+ * @file LogRateLimiter.h
+ * @brief Per-(component,event) token bucket for WebSocket log suppression
+ *
+ * Events such as PGN_IGNORED or WRONG_TALKER_REJECTED can repeat at bus rate.
+ * Each distinct (component, event) pair gets a token bucket: the first
+ * LOG_RATE_LIMIT_BURST messages pass, then LOG_RATE_LIMIT_PER_SEC per second.
+ * Rejected messages are counted and reported periodically as one summary
+ * ({"suppressed":N}) so the channel stays useful without saturating the radio.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed table, zero heap allocation
+ * - Principle VII (Fail-Safe): table full = message allowed (never hides new events)
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef LOG_RATE_LIMITER_H
+#define LOG_RATE_LIMITER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+/**
+ * @class LogRateLimiter
+ * @brief Fixed-size table of token buckets keyed by (component, event)
+ *
+ * Usage pattern:
+ * @code
+ * LogRateLimiter limiter;
+ *
+ * if (limiter.allow(level, "NMEA2000", "PGN_IGNORED", millis())) {
+ *     // ... send message ...
+ * }
+ *
+ * // Periodically, from one context
+ * limiter.collectSummaries(millis(), [](const LogRateLimiter::Summary& s) {
+ *     // ... send {"suppressed":s.suppressed} for s.component / s.event ...
+ * });
+ * @endcode
+ *
+ * @note Not ISR-safe. Concurrent producers may miscount, but never corrupt
+ *       the table beyond a lost increment.
+ */
+class LogRateLimiter {
+public:
+    static constexpr uint8_t SLOTS = LOG_RATE_LIMIT_SLOTS;
+    static constexpr size_t COMPONENT_SIZE = 24;
+    static constexpr size_t EVENT_SIZE = 40;
+
+    /**
+     * @brief Suppression report for one (component, event) pair
+     */
+    struct Summary {
+        const char* component;
+        const char* event;
+        uint8_t level;          ///< LogLevel value of the last suppressed message
+        uint32_t suppressed;    ///< Messages dropped since the last summary
+        uint32_t windowMs;      ///< Time covered by this summary
+    };
+
+    /**
+     * @brief Constructor
+     * @param ratePerSec Sustained messages per second per key
+     * @param burst Bucket size (messages allowed back-to-back)
+     */
+    explicit LogRateLimiter(uint16_t ratePerSec = LOG_RATE_LIMIT_PER_SEC,
+                            uint16_t burst = LOG_RATE_LIMIT_BURST);
+
+    /**
+     * @brief Take a token for (component, event)
+     * @param level LogLevel value (remembered for the summary)
+     * @param component Component name
+     * @param event Event name
+     * @param now Current millis()
+     * @return true if the message may be sent, false if suppressed (counted)
+     */
+    bool allow(uint8_t level, const char* component, const char* event, uint32_t now);
+
+    /**
+     * @brief Report and reset suppression counters older than LOG_RATE_SUMMARY_MS
+     * @param now Current millis()
+     * @param fn Callback invoked with a Summary for each due entry
+     * @return Number of summaries reported
+     */
+    template <typename Fn>
+    uint8_t collectSummaries(uint32_t now, Fn fn) {
+        uint8_t reported = 0;
+        for (uint8_t i = 0; i < SLOTS; i++) {
+            Entry& e = entries[i];
+            if (e.used && e.suppressed > 0 && now - e.suppressStart >= LOG_RATE_SUMMARY_MS) {
+                Summary summary = {e.component, e.event, e.level, e.suppressed, now - e.suppressStart};
+                e.suppressed = 0;
+                fn(summary);
+                reported++;
+            }
+        }
+        return reported;
+    }
+
+    /**
+     * @brief Total messages suppressed since startup
+     */
+    uint32_t getSuppressedTotal() const { return suppressedTotal; }
+
+    /**
+     * @brief Forget all buckets and counters
+     */
+    void reset();
+
+private:
+    struct Entry {
+        bool used;
+        uint8_t level;
+        uint32_t hash;
+        uint32_t tokens;         ///< Milli-tokens (1000 = one message)
+        uint32_t lastRefill;     ///< millis() of the last refill
+        uint32_t lastSeen;       ///< millis() of the last allow() call (LRU eviction)
+        uint32_t suppressed;     ///< Suppressed since suppressStart
+        uint32_t suppressStart;  ///< millis() of the first suppression in this window
+        char component[COMPONENT_SIZE];
+        char event[EVENT_SIZE];
+    };
+
+    Entry entries[SLOTS];
+    uint32_t ratePerSec;
+    uint32_t capacity;           ///< Bucket size in milli-tokens
+    uint32_t suppressedTotal;
+
+    static uint32_t hashKey(const char* component, const char* event);
+    Entry* findOrCreate(const char* component, const char* event, uint32_t now);
+};
+
+#endif // LOG_RATE_LIMITER_H
@@ -0,0 +1,73 @@
+/**
+ * @file LogRingBuffer.cpp
+ * @brief Implementation of the lock-free log record queue
+ *
+ * Slot sequence protocol (bounded MPSC queue):
+ * - sequence == pos             : slot free for the producer claiming position pos
+ * - sequence == pos + 1         : slot committed, readable by the consumer at pos
+ * - sequence == pos + CAPACITY  : slot released, free for the next lap
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "LogRingBuffer.h"
+#include "HotPath.h"
+
+LogRingBuffer::LogRingBuffer()
+    : enqueuePos(0), dequeuePos(0), dropped(0) {
+    for (uint32_t i = 0; i < CAPACITY; i++) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+LogRecord* HOT_PATH_ATTR LogRingBuffer::tryReserve(uint32_t& ticket) {
+    uint32_t pos = enqueuePos.load(std::memory_order_relaxed);
+
+    for (;;) {
+        Slot& slot = slots[pos & (CAPACITY - 1)];
+        uint32_t seq = slot.sequence.load(std::memory_order_acquire);
+        int32_t diff = static_cast<int32_t>(seq - pos);
+
+        if (diff == 0) {
+            // Slot free for this position - try to claim it
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                ticket = pos;
+                return &slot.record;
+            }
+            // CAS failed: pos now holds the current enqueue position, retry
+        } else if (diff < 0) {
+            // Consumer has not released this slot yet - ring is full
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        } else {
+            // Another producer claimed this position, reload and retry
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void HOT_PATH_ATTR LogRingBuffer::commit(uint32_t ticket) {
+    slots[ticket & (CAPACITY - 1)].sequence.store(ticket + 1, std::memory_order_release);
+}
+
+const LogRecord* LogRingBuffer::front() const {
+    const Slot& slot = slots[dequeuePos & (CAPACITY - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+        return nullptr;  // Empty, or the producer has not committed yet
+    }
+    return &slot.record;
+}
+
+void LogRingBuffer::pop() {
+    Slot& slot = slots[dequeuePos & (CAPACITY - 1)];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+        return;
+    }
+    slot.sequence.store(dequeuePos + CAPACITY, std::memory_order_release);
+    dequeuePos++;
+}
+
+uint32_t LogRingBuffer::size() const {
+    return enqueuePos.load(std::memory_order_relaxed) - dequeuePos;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file LogRingBuffer.h
+ * @brief Fixed-size lock-free queue of pending WebSocket log records
+ *
+ * Decouples log producers (NMEA2000/NMEA0183 handlers, web server callbacks)
+ * from the WebSocket send path. Producers reserve a slot, format their payload
+ * directly into it and commit; a single consumer (the logger drain reactor)
+ * encodes and sends committed records in order.
+ *
+ * Bounded multi-producer / single-consumer queue using per-slot sequence
+ * numbers. A full queue never blocks: the record is dropped and counted.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): storage is statically sized, zero heap allocation
+ * - Principle VII (Fail-Safe): overflow drops records instead of stalling the event loop
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef LOG_RING_BUFFER_H
+#define LOG_RING_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "../config.h"
+
+/**
+ * @brief One queued log message (payload already formatted)
+ *
+ * Component and event are IDs into the LogNames.h tables; the consumer
+ * resolves them to names when it encodes the message.
+ */
+struct LogRecord {
+    static constexpr size_t DATA_SIZE = LOG_RECORD_DATA_SIZE;
+    static constexpr uint16_t CANCELLED = 0xFFFF;  ///< event of a slot given up after reserving
+
+    uint32_t timestamp;               ///< millis() when the record was produced
+    uint8_t level;                    ///< LogLevel value (kept Arduino-free for native tests)
+    uint8_t component;                ///< LogComponent ID
+    uint16_t event;                   ///< LogEvent ID, or CANCELLED
+    char data[DATA_SIZE];             ///< JSON payload (empty = no data)
+};
+
+/**
+ * @class LogRingBuffer
+ * @brief Preallocated MPSC ring of LogRecord slots
+ *
+ * Usage pattern:
+ * @code
+ * // Producer (any context)
+ * uint32_t ticket;
+ * LogRecord* rec = ring.tryReserve(ticket);
+ * if (rec != nullptr) {
+ *     // ... fill rec ...
+ *     ring.commit(ticket);
+ * }
+ *
+ * // Consumer (single reactor)
+ * while (const LogRecord* rec = ring.front()) {
+ *     send(*rec);
+ *     ring.pop();
+ * }
+ * @endcode
+ */
+class LogRingBuffer {
+public:
+    static constexpr uint32_t CAPACITY = LOG_RING_CAPACITY;
+
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "LOG_RING_CAPACITY must be a power of two");
+    static_assert(CAPACITY >= 2, "LOG_RING_CAPACITY must be at least 2");
+
+    /**
+     * @brief Constructor - all slots free, counters zero
+     */
+    LogRingBuffer();
+
+    /**
+     * @brief Reserve the next free slot for writing
+     *
+     * @param ticket Output: reservation handle to pass to commit()
+     * @return Slot to fill, or nullptr if the ring is full (drop counted)
+     *
+     * @note Lock-free, safe to call concurrently from several tasks
+     */
+    LogRecord* tryReserve(uint32_t& ticket);
+
+    /**
+     * @brief Publish a reserved slot to the consumer
+     * @param ticket Handle returned by tryReserve()
+     */
+    void commit(uint32_t ticket);
+
+    /**
+     * @brief Oldest committed record, without removing it
+     * @return Record pointer, or nullptr if nothing is ready
+     *
+     * @note Consumer side only (single consumer)
+     */
+    const LogRecord* front() const;
+
+    /**
+     * @brief Release the record returned by front()
+     *
+     * @note Consumer side only; no-op if nothing is ready
+     */
+    void pop();
+
+    /**
+     * @brief Records rejected because the ring was full (since startup)
+     */
+    uint32_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Approximate number of reserved or committed records
+     */
+    uint32_t size() const;
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence;   ///< Slot state relative to queue positions
+        LogRecord record;
+    };
+
+    Slot slots[CAPACITY];
+    std::atomic<uint32_t> enqueuePos;
+    uint32_t dequeuePos;                  ///< Owned by the single consumer
+    std::atomic<uint32_t> dropped;
+};
+
+#endif // LOG_RING_BUFFER_H
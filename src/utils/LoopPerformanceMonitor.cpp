@@ -7,22 +7,38 @@
  */
 
 #include "LoopPerformanceMonitor.h"
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
 
 LoopPerformanceMonitor::LoopPerformanceMonitor()
     : _loopCount(0),
       _lastReportTime(0),
       _currentFrequency(0),
-      _hasFirstMeasurement(false) {
+      _hasFirstMeasurement(false),
+      _hasLastLoop(false),
+      _lastLoopUs(0),
+      _windowCount(0) {
     // All members initialized via initializer list
     // No heap allocation - constitutional Principle II compliance
 }
 
+#ifdef ARDUINO
 void LoopPerformanceMonitor::endLoop() {
+    endLoop(millis(), micros());
+}
+#endif
+
+void LoopPerformanceMonitor::endLoop(uint32_t now, uint32_t nowUs) {
     // Increment loop counter
     _loopCount++;
 
-    // Get current timestamp
-    uint32_t now = millis();
+    // Duration of the iteration that just ended (unsigned difference survives micros() wrap)
+    if (_hasLastLoop) {
+        _window.record(nowUs - _lastLoopUs);
+    }
+    _lastLoopUs = nowUs;
+    _hasLastLoop = true;
 
     // Check if 5-second window has elapsed OR millis() has wrapped around
     // millis() wraps at UINT32_MAX (~49.7 days) - detect wrap via (now < _lastReportTime)
@@ -45,6 +61,11 @@ void LoopPerformanceMonitor::endLoop() {
         // Mark that we have at least one valid measurement
         // FR-049: Enables transition from "---" placeholder to numeric display
         _hasFirstMeasurement = true;
+
+        // Publish the window's latency histogram and start a new one
+        _lastWindow = _window;
+        _window.reset();
+        _windowCount++;
     }
 }
 
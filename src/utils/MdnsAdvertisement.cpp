@@ -0,0 +1,128 @@
+/**
+ * @file MdnsAdvertisement.cpp
+ * @brief Implementation of the mDNS service records
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "MdnsAdvertisement.h"
+#include "BoatDataSnapshot.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+constexpr uint32_t FNV_OFFSET = 2166136261u;
+constexpr uint32_t FNV_PRIME = 16777619u;
+
+/// FNV-1a of @p text, terminator included (separates adjacent strings)
+uint32_t hashText(uint32_t hash, const char* text) {
+    do {
+        hash = (hash ^ static_cast<uint8_t>(*text)) * FNV_PRIME;
+    } while (*text++ != '\0');
+    return hash;
+}
+
+}  // namespace
+
+MdnsAdvertisement::MdnsAdvertisement()
+    : count_(0), fingerprint_(0), changes_(0) {
+    memset(services_, 0, sizeof(services_));
+}
+
+bool MdnsAdvertisement::build(const MdnsAdvertConfig& config) {
+    count_ = 0;
+
+    MdnsServiceRecord& gateway = addService("_poseidon2", config.httpPort);
+    addTxt(gateway, "txtvers", "1");
+    addTxt(gateway, "ws", "/boatdata");
+    addTxt(gateway, "fmt", "json,delta,bin");
+    addTxt(gateway, "bin", "%d", BOATDATA_SNAPSHOT_VERSION);
+    addTxt(gateway, "api", "/api/boatdata");
+    addTxt(gateway, "signalk", "/signalk/v1/stream");
+    addTxt(gateway, "logs", "/logs");
+    if (config.udp) {
+        addTxt(gateway, "udp", "%s:%u", config.udpGroup, (unsigned)config.udpPort);
+    }
+
+    MdnsServiceRecord& signalK = addService("_signalk-ws", config.httpPort);
+    addTxt(signalK, "txtvers", "1");
+    addTxt(signalK, "roles", "master,main");
+    addTxt(signalK, "swname", "Poseidon2");
+    addTxt(signalK, "path", "/signalk/v1/stream");
+
+    if (config.nmea0183Tcp) {
+        MdnsServiceRecord& nmea = addService("_nmea-0183", config.nmea0183Port);
+        addTxt(nmea, "txtvers", "1");
+        addTxt(nmea, "talker", "%s", config.nmea0183Talker);
+        addTxt(nmea, "clients", "%u", (unsigned)config.nmea0183Clients);
+    }
+
+    uint32_t fingerprint = computeFingerprint();
+    bool changed = changes_ == 0 || fingerprint != fingerprint_;
+    fingerprint_ = fingerprint;
+    if (changed) {
+        changes_++;
+    }
+    return changed;
+}
+
+const MdnsServiceRecord* MdnsAdvertisement::getService(uint8_t index) const {
+    return index < count_ ? &services_[index] : nullptr;
+}
+
+const MdnsServiceRecord* MdnsAdvertisement::findService(const char* type) const {
+    for (uint8_t i = 0; i < count_; i++) {
+        if (strcmp(services_[i].type, type) == 0) {
+            return &services_[i];
+        }
+    }
+    return nullptr;
+}
+
+const char* MdnsAdvertisement::findTxt(const MdnsServiceRecord& service, const char* key) {
+    for (uint8_t i = 0; i < service.count; i++) {
+        if (strcmp(service.items[i].key, key) == 0) {
+            return service.items[i].value;
+        }
+    }
+    return nullptr;
+}
+
+MdnsServiceRecord& MdnsAdvertisement::addService(const char* type, uint16_t port) {
+    MdnsServiceRecord& service = services_[count_ < MAX_SERVICES ? count_++ : MAX_SERVICES - 1];
+    service.type = type;
+    service.proto = "_tcp";
+    service.port = port;
+    service.count = 0;
+    return service;
+}
+
+void MdnsAdvertisement::addTxt(MdnsServiceRecord& service, const char* key, const char* format, ...) {
+    if (service.count >= MDNS_TXT_MAX_ITEMS) {
+        return;
+    }
+    MdnsTxtItem& item = service.items[service.count++];
+    item.key = key;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(item.value, sizeof(item.value), format, args);   // Truncated, never unterminated
+    va_end(args);
+}
+
+uint32_t MdnsAdvertisement::computeFingerprint() const {
+    uint32_t hash = FNV_OFFSET;
+    for (uint8_t i = 0; i < count_; i++) {
+        const MdnsServiceRecord& service = services_[i];
+        hash = hashText(hash, service.type);
+        hash = (hash ^ (service.port & 0xFF)) * FNV_PRIME;
+        hash = (hash ^ (service.port >> 8)) * FNV_PRIME;
+        for (uint8_t t = 0; t < service.count; t++) {
+            hash = hashText(hash, service.items[t].key);
+            hash = hashText(hash, service.items[t].value);
+        }
+    }
+    return hash;
+}
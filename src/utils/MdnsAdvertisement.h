@@ -0,0 +1,121 @@
+/**
+ * @file MdnsAdvertisement.h
+ * @brief Precomputed mDNS/DNS-SD service records and TXT items
+ *
+ * Clients find the device as <MDNS_HOSTNAME>.local and browse three
+ * DNS-SD services instead of scanning for an IP:
+ *
+ * - _poseidon2._tcp (HTTP port): WebSocket path, formats, REST snapshot,
+ *   Signal K stream, logs and the UDP datagram group
+ * - _signalk-ws._tcp (HTTP port): Signal K delta stream for chart plotters
+ * - _nmea-0183._tcp (N0183_TCP_PORT): the converted sentence stream, when
+ *   the TCP gateway runs
+ *
+ * build() formats every TXT value once into fixed storage and keeps an
+ * FNV-1a fingerprint of the result. The responder answers queries from
+ * the records it was handed, so a query costs the firmware nothing; the
+ * records are handed over again only when a rebuild after a
+ * configuration change actually produces different records.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * MdnsAdvertisement advertisement;
+ * if (advertisement.build(config)) {
+ *     // push advertisement.getService(i) to the responder
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed record table, no heap
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef MDNS_ADVERTISEMENT_H
+#define MDNS_ADVERTISEMENT_H
+
+#include <stdint.h>
+#include "../config.h"
+
+/**
+ * @brief What the advertisement describes (config.h values plus the services that started)
+ */
+struct MdnsAdvertConfig {
+    uint16_t httpPort;            ///< Web server port (/boatdata, /api/boatdata, /signalk)
+    bool nmea0183Tcp;             ///< The NMEA 0183 TCP gateway is listening
+    uint16_t nmea0183Port;
+    uint8_t nmea0183Clients;      ///< Simultaneous stream clients
+    const char* nmea0183Talker;
+    bool udp;                     ///< BoatData datagrams are being published
+    const char* udpGroup;         ///< Multicast group ("broadcast" for subnet broadcast)
+    uint16_t udpPort;
+};
+
+/**
+ * @brief One TXT item (key is a static literal)
+ */
+struct MdnsTxtItem {
+    const char* key;
+    char value[MDNS_TXT_VALUE_MAX];
+};
+
+/**
+ * @brief One DNS-SD service (type and protocol are static literals)
+ */
+struct MdnsServiceRecord {
+    const char* type;     ///< "_poseidon2"
+    const char* proto;    ///< "_tcp"
+    uint16_t port;
+    uint8_t count;        ///< TXT items in use
+    MdnsTxtItem items[MDNS_TXT_MAX_ITEMS];
+};
+
+/**
+ * @class MdnsAdvertisement
+ * @brief The service records the responder publishes (main loop)
+ */
+class MdnsAdvertisement {
+public:
+    static constexpr uint8_t MAX_SERVICES = 3;
+
+    MdnsAdvertisement();
+
+    /**
+     * @brief Format the records for @p config
+     * @return true if they differ from the previous build (always for the first one)
+     */
+    bool build(const MdnsAdvertConfig& config);
+
+    uint8_t getServiceCount() const { return count_; }
+
+    /// Service @p index (nullptr if out of range)
+    const MdnsServiceRecord* getService(uint8_t index) const;
+
+    /// Service of @p type, e.g. "_nmea-0183" (nullptr if not advertised)
+    const MdnsServiceRecord* findService(const char* type) const;
+
+    /// Value of TXT item @p key of @p service (nullptr if absent)
+    static const char* findTxt(const MdnsServiceRecord& service, const char* key);
+
+    /// FNV-1a over every type, port, key and value
+    uint32_t getFingerprint() const { return fingerprint_; }
+
+    /// Builds that changed the records (the first one included)
+    uint32_t getChanges() const { return changes_; }
+
+private:
+    MdnsServiceRecord& addService(const char* type, uint16_t port);
+    void addTxt(MdnsServiceRecord& service, const char* key, const char* format, ...)
+        __attribute__((format(printf, 4, 5)));
+    uint32_t computeFingerprint() const;
+
+    MdnsServiceRecord services_[MAX_SERVICES];
+    uint8_t count_;
+    uint32_t fingerprint_;
+    uint32_t changes_;
+};
+
+#endif // MDNS_ADVERTISEMENT_H
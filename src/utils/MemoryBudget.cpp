@@ -0,0 +1,80 @@
+/**
+ * @file MemoryBudget.cpp
+ * @brief Implementation of the memory reservation table
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "MemoryBudget.h"
+
+MemoryBudget::MemoryBudget() : count_(0), dropped_(0) {
+}
+
+bool MemoryBudget::add(const char* name, uint32_t bytes, MemoryRegion region, const char* partOf) {
+    if (count_ >= MEMORY_BUDGET_MAX_ENTRIES || region >= MemoryRegion::COUNT) {
+        dropped_++;
+        return false;
+    }
+    entries_[count_++] = {name, bytes, region, partOf};
+    return true;
+}
+
+uint32_t MemoryBudget::getTotal(MemoryRegion region) const {
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        const MemoryBudgetEntry& entry = entries_[i];
+        if (entry.region != region || entry.partOf != nullptr) {
+            continue;
+        }
+        if (region == MemoryRegion::STACK) {
+            total = entry.bytes > total ? entry.bytes : total;
+        } else {
+            total += entry.bytes;
+        }
+    }
+    return total;
+}
+
+const char* MemoryBudget::regionName(MemoryRegion region) {
+    switch (region) {
+        case MemoryRegion::STATIC:    return "static";
+        case MemoryRegion::RTC:       return "rtc";
+        case MemoryRegion::BOOT_HEAP: return "boot_heap";
+        case MemoryRegion::PSRAM:     return "psram";
+        case MemoryRegion::STACK:     return "stack";
+        default:                      return "unknown";
+    }
+}
+
+void MemoryBudget::writeEntry(JsonWriter& json, uint8_t index) const {
+    if (index >= count_) {
+        return;
+    }
+    const MemoryBudgetEntry& entry = entries_[index];
+    json.beginObject()
+        .add("name", entry.name)
+        .add("bytes", (unsigned long)entry.bytes)
+        .add("region", regionName(entry.region));
+    if (entry.partOf != nullptr) {
+        json.add("part_of", entry.partOf);
+    }
+    json.endObject();
+}
+
+void MemoryBudget::writeTotals(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("static", (unsigned long)getTotal(MemoryRegion::STATIC))
+        .add("rtc", (unsigned long)getTotal(MemoryRegion::RTC))
+        .add("boot_heap", (unsigned long)getTotal(MemoryRegion::BOOT_HEAP))
+        .add("psram", (unsigned long)getTotal(MemoryRegion::PSRAM))
+        .add("stack_peak", (unsigned long)getTotal(MemoryRegion::STACK));
+    if (dropped_ > 0) {
+        json.add("dropped_entries", (unsigned int)dropped_);
+    }
+    json.endObject();
+}
@@ -0,0 +1,105 @@
+/**
+ * @file MemoryBudget.h
+ * @brief Table of the firmware's memory reservations, per component
+ *
+ * main.cpp lists, once at the end of setup(), what each component reserves
+ * (sizeof of its object or buffer) and where:
+ * - static: .bss/.data, for the whole uptime (globals, StaticInstance slots)
+ * - rtc: RTC slow memory (reset-surviving records)
+ * - boot_heap: allocated once at boot and never freed (WebSocket pool)
+ * - psram: allocated once at boot in external PSRAM (BufferPlacement)
+ * - stack: per-call buffers on the calling task's stack (JSON documents)
+ *
+ * An entry may name the entry it is part of (e.g. the log ring inside the
+ * logger): it is listed but not added to the totals again. GET /memory
+ * (MemoryWebServer) reports the table with the heap and task stack
+ * watermarks. Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): memory use per build is visible before features are enabled
+ * - Principle V (Network Debugging): reported over HTTP
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef MEMORY_BUDGET_H
+#define MEMORY_BUDGET_H
+
+#include <stdint.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Where a reservation lives
+ */
+enum class MemoryRegion : uint8_t {
+    STATIC = 0,
+    RTC,
+    BOOT_HEAP,
+    PSRAM,
+    STACK,
+    COUNT
+};
+
+/**
+ * @brief One listed reservation
+ */
+struct MemoryBudgetEntry {
+    const char* name;     ///< Static label
+    uint32_t bytes;
+    MemoryRegion region;
+    const char* partOf;   ///< Enclosing entry (not summed again), or nullptr
+};
+
+/**
+ * @class MemoryBudget
+ * @brief Fixed table of reservations (filled by the setup task, read by HTTP)
+ *
+ * Usage pattern:
+ * @code
+ * memoryBudget.add("logger", sizeof(logger), MemoryRegion::STATIC);
+ * memoryBudget.add("log_ring", sizeof(LogRingBuffer), MemoryRegion::STATIC, "logger");
+ * @endcode
+ */
+class MemoryBudget {
+public:
+    MemoryBudget();
+
+    /**
+     * @brief List a reservation
+     * @return false if the table is full (counted in getDropped())
+     */
+    bool add(const char* name, uint32_t bytes, MemoryRegion region, const char* partOf = nullptr);
+
+    uint8_t getCount() const { return count_; }
+    const MemoryBudgetEntry& getEntry(uint8_t index) const { return entries_[index]; }
+    uint8_t getDropped() const { return dropped_; }
+
+    /**
+     * @brief Sum of @p region's entries that are not part of another
+     *
+     * For STACK the largest entry: the buffers are per call, not held at once.
+     */
+    uint32_t getTotal(MemoryRegion region) const;
+
+    /// "static", "rtc", "boot_heap", "stack"
+    static const char* regionName(MemoryRegion region);
+
+    /// {"name":"logger","bytes":6120,"region":"static"} (plus "part_of" when set)
+    void writeEntry(JsonWriter& json, uint8_t index) const;
+
+    /**
+     * @brief {"static":41234,"rtc":2100,"boot_heap":26624,"stack_peak":3072}
+     *
+     * With @p key the object is a member of the enclosing one.
+     */
+    void writeTotals(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    MemoryBudgetEntry entries_[MEMORY_BUDGET_MAX_ENTRIES];
+    uint8_t count_;
+    uint8_t dropped_;
+};
+
+#endif // MEMORY_BUDGET_H
@@ -0,0 +1,183 @@
+/**
+ * @file MetricRegistry.cpp
+ * @brief Implementation of the metric registry and the Prometheus text writer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "MetricRegistry.h"
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+MetricSample::MetricSample(char* buffer, size_t capacity, const char* name)
+    : buffer_(buffer), capacity_(capacity), length_(0), labels_(false), done_(false), overflow_(false) {
+    append(name);
+}
+
+void MetricSample::appendChar(char c) {
+    if (length_ + 1 >= capacity_) {
+        overflow_ = true;
+        return;
+    }
+    buffer_[length_++] = c;
+    buffer_[length_] = '\0';
+}
+
+void MetricSample::append(const char* text) {
+    while (*text != '\0' && !overflow_) {
+        appendChar(*text++);
+    }
+}
+
+MetricSample& MetricSample::label(const char* key, const char* value) {
+    if (done_) {
+        return *this;
+    }
+    appendChar(labels_ ? ',' : '{');
+    labels_ = true;
+    append(key);
+    append("=\"");
+    for (const char* c = value != nullptr ? value : ""; *c != '\0' && !overflow_; c++) {
+        switch (*c) {
+            case '\\': append("\\\\"); break;
+            case '"':  append("\\\""); break;
+            case '\n': append("\\n"); break;
+            default:   appendChar(*c); break;
+        }
+    }
+    appendChar('"');
+    return *this;
+}
+
+MetricSample& MetricSample::label(const char* key, unsigned long value) {
+    char text[12];
+    snprintf(text, sizeof(text), "%lu", value);
+    return label(key, text);
+}
+
+void MetricSample::value(double v) {
+    if (done_) {
+        return;
+    }
+    if (labels_) {
+        appendChar('}');
+    }
+    char text[32];
+    if (isnan(v)) {
+        snprintf(text, sizeof(text), " NaN\n");
+    } else if (isinf(v)) {
+        snprintf(text, sizeof(text), v > 0 ? " +Inf\n" : " -Inf\n");
+    } else {
+        snprintf(text, sizeof(text), " %.15g\n", v);
+    }
+    append(text);
+    done_ = true;
+}
+
+MetricRegistry::MetricRegistry() : families_(), count_(0) {
+}
+
+bool MetricRegistry::add(const char* name, const char* help, MetricType type, MetricSampler sampler,
+                         uint16_t count, const void* context) {
+    if (count_ >= MAX_FAMILIES || name == nullptr || help == nullptr || sampler == nullptr) {
+        return false;
+    }
+    MetricFamily& family = families_[count_++];
+    family.name = name;
+    family.help = help;
+    family.type = type;
+    family.count = count;
+    family.sample = sampler;
+    family.context = context;
+    return true;
+}
+
+const char* MetricRegistry::typeName(MetricType type) {
+    return type == MetricType::COUNTER ? "counter" : "gauge";
+}
+
+MetricWriter::MetricWriter()
+    : registry_(nullptr), family_(0), index_(0), stage_(DONE), samples_(0), truncated_(0),
+      lineLen_(0), linePos_(0) {
+    line_[0] = '\0';
+}
+
+void MetricWriter::begin(const MetricRegistry& registry) {
+    registry_ = &registry;
+    family_ = 0;
+    index_ = 0;
+    stage_ = HELP;
+    samples_ = 0;
+    truncated_ = 0;
+    lineLen_ = 0;
+    linePos_ = 0;
+}
+
+size_t MetricWriter::read(char* buffer, size_t maxLen) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (linePos_ >= lineLen_ && !nextLine()) {
+            break;
+        }
+        size_t n = lineLen_ - linePos_;
+        if (n > maxLen - written) {
+            n = maxLen - written;
+        }
+        memcpy(buffer + written, line_ + linePos_, n);
+        linePos_ += n;
+        written += n;
+    }
+    return written;
+}
+
+bool MetricWriter::nextLine() {
+    lineLen_ = 0;
+    linePos_ = 0;
+    while (stage_ != DONE) {
+        if (registry_ == nullptr || family_ >= registry_->getCount()) {
+            stage_ = DONE;
+            break;
+        }
+        const MetricFamily& family = registry_->get(family_);
+        int n = 0;
+        switch (stage_) {
+            case HELP:
+                n = snprintf(line_, sizeof(line_), "# HELP %s %s\n", family.name, family.help);
+                stage_ = TYPE;
+                break;
+            case TYPE:
+                n = snprintf(line_, sizeof(line_), "# TYPE %s %s\n", family.name,
+                             MetricRegistry::typeName(family.type));
+                stage_ = SAMPLES;
+                index_ = 0;
+                break;
+            case SAMPLES: {
+                if (index_ >= family.count) {
+                    family_++;
+                    stage_ = HELP;
+                    continue;
+                }
+                MetricSample sample(line_, sizeof(line_), family.name);
+                family.sample(sample, index_++, family.context);
+                if (sample.overflowed()) {
+                    truncated_++;
+                    continue;
+                }
+                n = static_cast<int>(sample.length());
+                if (n > 0) {
+                    samples_++;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        if (n > 0 && static_cast<size_t>(n) < sizeof(line_)) {
+            lineLen_ = static_cast<size_t>(n);
+            return true;
+        }
+    }
+    return false;
+}
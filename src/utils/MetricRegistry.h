@@ -0,0 +1,184 @@
+/**
+ * @file MetricRegistry.h
+ * @brief Static registry of counters and gauges, written in the Prometheus text format
+ *
+ * Every statistic of the gateway already has a home (DiagnosticData,
+ * LoopPerformanceMonitor, HeapMonitor, N2kPGNStats, ...), each with its own
+ * JSON endpoint. GET /metrics exposes all of them in one scrape for the
+ * shore-side Prometheus/Grafana without copying them anywhere: setup()
+ * registers one MetricFamily per metric name with a sampler function that
+ * reads the value from its owner when the family is written.
+ *
+ * A family has @c count samples. The sampler is called for each index and
+ * may write labels and a value, or nothing (a free hash slot, a task not
+ * running): tables such as the N2kPGNStats slots become labelled series
+ * without an iterator of their own.
+ *
+ * MetricWriter renders the registry line by line into any buffer size
+ * (chunked HTTP response), so memory use is one line, whatever the number
+ * of series:
+ *
+ * @code
+ * # HELP poseidon2_n2k_frames_total Frames received per PGN and source
+ * # TYPE poseidon2_n2k_frames_total counter
+ * poseidon2_n2k_frames_total{pgn="127250",source="2"} 18234
+ * @endcode
+ *
+ * A line longer than METRICS_LINE_BYTES is left out (counted in
+ * getTruncated()). Arduino-free (unit tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * registry.add("poseidon2_heap_free_bytes", "Free heap", MetricType::GAUGE,
+ *     [](MetricSample& s, uint16_t, const void*) { s.value(ESP.getFreeHeap()); });
+ * writer.begin(registry);
+ * size_t n = writer.read(buffer, maxLen);   // until 0
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): static family table, one line buffer per scrape
+ * - Principle V (Network Debugging): every counter scrapeable over WiFi
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef METRIC_REGISTRY_H
+#define METRIC_REGISTRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+/**
+ * @brief Prometheus metric types used by the gateway
+ */
+enum class MetricType : uint8_t {
+    COUNTER = 0,   ///< Only increases (since boot)
+    GAUGE          ///< Current value
+};
+
+/**
+ * @class MetricSample
+ * @brief One exposition line being built: name{labels} value
+ *
+ * Labels must be added before value(). A sample without value() is not written.
+ */
+class MetricSample {
+public:
+    MetricSample(char* buffer, size_t capacity, const char* name);
+
+    /// Add label @p key="@p value" (quotes, backslashes and line ends escaped)
+    MetricSample& label(const char* key, const char* value);
+
+    /// Add label @p key="@p value" with a decimal value
+    MetricSample& label(const char* key, unsigned long value);
+
+    /// Set the value; integers up to 2^53 are written exactly, NaN as "NaN"
+    void value(double v);
+
+    /// Bytes of the finished line, 0 without value()
+    size_t length() const { return done_ && !overflow_ ? length_ : 0; }
+
+    /// The line did not fit the buffer
+    bool overflowed() const { return overflow_; }
+
+private:
+    char* buffer_;
+    size_t capacity_;
+    size_t length_;
+    bool labels_;    ///< '{' written
+    bool done_;
+    bool overflow_;
+
+    void append(const char* text);
+    void appendChar(char c);
+};
+
+/// Write sample @p index of a family (labels and value), or nothing to skip it
+typedef void (*MetricSampler)(MetricSample& sample, uint16_t index, const void* context);
+
+/**
+ * @brief One metric name with its samples
+ */
+struct MetricFamily {
+    const char* name;       ///< "poseidon2_..." (must outlive the registry)
+    const char* help;
+    MetricType type;
+    uint16_t count;         ///< Sampler indexes 0..count-1
+    MetricSampler sample;
+    const void* context;    ///< Passed to the sampler
+};
+
+/**
+ * @class MetricRegistry
+ * @brief Fixed table of metric families (filled in setup, read by the scrapes)
+ */
+class MetricRegistry {
+public:
+    static constexpr uint8_t MAX_FAMILIES = METRICS_MAX_FAMILIES;
+
+    MetricRegistry();
+
+    /**
+     * @brief Register a family (setup only, before the web server starts)
+     * @param count Samples of the family (1 for a single value)
+     * @return false when the table is full or an argument is null
+     */
+    bool add(const char* name, const char* help, MetricType type, MetricSampler sampler,
+             uint16_t count = 1, const void* context = nullptr);
+
+    uint8_t getCount() const { return count_; }
+    const MetricFamily& get(uint8_t index) const { return families_[index]; }
+
+    /// "counter" or "gauge"
+    static const char* typeName(MetricType type);
+
+private:
+    MetricFamily families_[MAX_FAMILIES];
+    uint8_t count_;
+};
+
+/**
+ * @class MetricWriter
+ * @brief Renders a registry in the Prometheus text format, in pieces
+ *
+ * read() fills any buffer size: # HELP and # TYPE of each family, then its
+ * samples. Samplers run inside read(), so values are current for the chunk.
+ */
+class MetricWriter {
+public:
+    MetricWriter();
+
+    /// Start a new document (the registry must outlive it)
+    void begin(const MetricRegistry& registry);
+
+    /**
+     * @brief Copy the next part of the document into @p buffer
+     * @return Bytes written; 0 once the document is complete
+     */
+    size_t read(char* buffer, size_t maxLen);
+
+    /// Samples written so far
+    uint32_t getSamples() const { return samples_; }
+
+    /// Samples left out because their line exceeded METRICS_LINE_BYTES
+    uint32_t getTruncated() const { return truncated_; }
+
+private:
+    enum Stage : uint8_t { HELP = 0, TYPE, SAMPLES, DONE };
+
+    const MetricRegistry* registry_;
+    uint8_t family_;
+    uint16_t index_;
+    Stage stage_;
+    uint32_t samples_;
+    uint32_t truncated_;
+    char line_[METRICS_LINE_BYTES];
+    size_t lineLen_;
+    size_t linePos_;
+
+    bool nextLine();
+};
+
+#endif // METRIC_REGISTRY_H
@@ -0,0 +1,87 @@
+/**
+ * @file N2kAddressMemory.cpp
+ * @brief Implementation of the persisted NMEA 2000 source address
+ *
+ * @see N2kAddressMemory.h
+ */
+
+#include "N2kAddressMemory.h"
+
+namespace {
+
+constexpr uint8_t NO_ADDRESS = 0xFF;
+
+static_assert(N2K_SOURCE_ADDRESS <= N2K_MAX_CLAIM_ADDRESS, "N2K_SOURCE_ADDRESS cannot be claimed");
+
+}  // namespace
+
+N2kAddressMemory::N2kAddressMemory()
+    : name_(0),
+      startAddress_(N2K_SOURCE_ADDRESS),
+      address_(N2K_SOURCE_ADDRESS),
+      storedAddress_(NO_ADDRESS),
+      restored_(false),
+      changes_(0) {
+}
+
+ConfigRecordStatus N2kAddressMemory::decodeRecord(const uint8_t* data, size_t length, uint64_t name) {
+    name_ = name;
+    ConfigRecordReader record(data, length);
+    uint16_t schema = 0;
+    ConfigRecordStatus status = record.open(schema);
+    if (status != ConfigRecordStatus::OK) {
+        return status;
+    }
+
+    uint8_t address = record.getU8();
+    uint64_t storedName = record.getU32();
+    storedName |= static_cast<uint64_t>(record.getU32()) << 32;
+    if (!record.ok() || address > N2K_MAX_CLAIM_ADDRESS) {
+        return ConfigRecordStatus::TRUNCATED;
+    }
+    if (storedName != name) {
+        return ConfigRecordStatus::EMPTY;  // Claimed by another identity: start over
+    }
+
+    startAddress_ = address;
+    address_ = address;
+    storedAddress_ = address;
+    restored_ = true;
+    return ConfigRecordStatus::OK;
+}
+
+size_t N2kAddressMemory::encodeRecord(uint8_t* out, size_t size) const {
+    ConfigRecordWriter record(out, size);
+    record.putU8(address_)
+          .putU32(static_cast<uint32_t>(name_))
+          .putU32(static_cast<uint32_t>(name_ >> 32));
+    return record.finish(N2K_ADDRESS_RECORD_SCHEMA);
+}
+
+bool N2kAddressMemory::claimed(uint8_t address) {
+    if (address > N2K_MAX_CLAIM_ADDRESS) {
+        return false;  // 254: no address could be claimed, keep the last good one
+    }
+    if (address != address_) {
+        changes_++;
+        address_ = address;
+    }
+    if (address == storedAddress_) {
+        return false;
+    }
+    storedAddress_ = address;
+    return true;
+}
+
+void N2kAddressMemory::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("address", (unsigned int)address_)
+        .add("start", (unsigned int)startAddress_)
+        .add("restored", restored_)
+        .add("changes", (unsigned long)changes_)
+        .endObject();
+}
@@ -0,0 +1,107 @@
+/**
+ * @file N2kAddressMemory.h
+ * @brief Last claimed NMEA 2000 source address, kept across boots
+ *
+ * At Open() the library claims the address passed to SetMode(). When another
+ * node with a higher-priority NAME already holds it, the gateway loses the
+ * claim and moves on to the next free address, so on a busy bus every boot
+ * repeats the contention (TX delayed, other devices see address churn).
+ * Starting from the address claimed last time joins at once.
+ *
+ * The address is stored with the NAME it was claimed under; a record of a
+ * different NAME (other device information or a new unit) is ignored and the
+ * claim starts at N2K_SOURCE_ADDRESS.
+ *
+ * Record (ConfigRecord under N2K_ADDRESS_RECORD_KEY, schema 1):
+ *   u8 address, u32 NAME low word, u32 NAME high word
+ *
+ * Arduino-free (unit tested natively). Main loop only.
+ *
+ * Usage:
+ * @code
+ * memory.decodeRecord(record, length, nmea2000->GetDeviceInformation().GetName());
+ * nmea2000->SetMode(tNMEA2000::N2km_ListenAndNode, memory.getStartAddress());
+ * // Later, main loop:
+ * if (nmea2000->ReadResetAddressChanged() && memory.claimed(nmea2000->GetN2kSource())) {
+ *     GetWriteBehind().markDirty(entry, millis());
+ * }
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef N2K_ADDRESS_MEMORY_H
+#define N2K_ADDRESS_MEMORY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ConfigRecord.h"
+#include "JsonWriter.h"
+#include "../config.h"
+
+#define N2K_ADDRESS_RECORD_KEY "n2k_addr"
+#define N2K_ADDRESS_RECORD_SCHEMA 1
+
+/// Highest address a node may claim (252-253 reserved, 254 cannot claim, 255 global)
+#define N2K_MAX_CLAIM_ADDRESS 251
+
+/**
+ * @class N2kAddressMemory
+ * @brief Start address for the claim and the address to persist
+ */
+class N2kAddressMemory {
+public:
+    N2kAddressMemory();
+
+    /**
+     * @brief Restore the start address from a stored record
+     *
+     * @param name NAME the gateway claims with this boot
+     * @return OK if the stored address is used; EMPTY also for a record of another
+     *         NAME; TRUNCATED for an address outside 0-251
+     */
+    ConfigRecordStatus decodeRecord(const uint8_t* data, size_t length, uint64_t name);
+
+    /**
+     * @brief Encode the current address and NAME
+     *
+     * @return Record length, 0 if @p size is too small
+     */
+    size_t encodeRecord(uint8_t* out, size_t size) const;
+
+    /// Address for SetMode(): the restored one, else N2K_SOURCE_ADDRESS
+    uint8_t getStartAddress() const { return startAddress_; }
+
+    /// The start address came from the record
+    bool isRestored() const { return restored_; }
+
+    /**
+     * @brief The library reports a new claimed address
+     *
+     * @return true if it differs from the stored one (persist it)
+     */
+    bool claimed(uint8_t address);
+
+    uint8_t getAddress() const { return address_; }
+
+    /// Address changes seen since boot (lost claims, commanded addresses)
+    uint32_t getChanges() const { return changes_; }
+
+    /**
+     * @brief Write the state as a JSON object
+     *
+     * {"address":35,"start":35,"restored":true,"changes":0}
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    uint64_t name_;
+    uint8_t startAddress_;
+    uint8_t address_;
+    uint8_t storedAddress_;     ///< Address in NVS (0xFF = none)
+    bool restored_;
+    uint32_t changes_;
+};
+
+#endif // N2K_ADDRESS_MEMORY_H
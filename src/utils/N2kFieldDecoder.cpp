@@ -0,0 +1,189 @@
+/**
+ * @file N2kFieldDecoder.cpp
+ * @brief Field layouts of the table-decoded PGNs and the decoder
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "N2kFieldDecoder.h"
+#include "../config.h"
+
+namespace {
+
+constexpr double KELVIN_OFFSET = -273.15;  // 0.01 K temperatures to °C
+
+// PGN 127508 Battery Status: instance, voltage 0.01 V, current 0.1 A (+ = charging), temperature, SID
+constexpr N2kFieldDescriptor BATTERY_STATUS_A[] = {
+    N2kUnsignedField(8, 16, 0.01, 0.0, BOATDATA_FIELD_BATTERY_VOLTAGE_A),
+    N2kSignedField(24, 16, 0.1, 0.0, BOATDATA_FIELD_BATTERY_AMPERAGE_A),
+};
+constexpr N2kFieldDescriptor BATTERY_STATUS_B[] = {
+    N2kUnsignedField(8, 16, 0.01, 0.0, BOATDATA_FIELD_BATTERY_VOLTAGE_B),
+    N2kSignedField(24, 16, 0.1, 0.0, BOATDATA_FIELD_BATTERY_AMPERAGE_B),
+};
+
+// PGN 127506 DC Detailed Status: SID, instance, DC type, state of charge 1 %, ... (fast packet)
+constexpr N2kFieldDescriptor DC_DETAILED_STATUS_A[] = {
+    N2kUnsignedField(24, 8, 1.0, 0.0, BOATDATA_FIELD_BATTERY_SOC_A),
+};
+constexpr N2kFieldDescriptor DC_DETAILED_STATUS_B[] = {
+    N2kUnsignedField(24, 8, 1.0, 0.0, BOATDATA_FIELD_BATTERY_SOC_B),
+};
+
+// PGN 129539 GNSS DOPs: SID, desired/actual mode, HDOP 0.01, VDOP, TDOP
+constexpr N2kFieldDescriptor GNSS_DOPS[] = {
+    N2kSignedField(16, 16, 0.01, 0.0, BOATDATA_FIELD_GPS_HDOP),
+};
+
+// PGN 130310 Environmental Parameters (obsolete): SID, water temperature 0.01 K, air, pressure
+constexpr N2kFieldDescriptor OUTSIDE_ENVIRONMENT[] = {
+    N2kUnsignedField(8, 16, 0.01, KELVIN_OFFSET, BOATDATA_FIELD_DST_SEA_TEMPERATURE),
+};
+
+// PGN 130311 Environmental Parameters: SID, temperature source (6 bits) + humidity source, temperature 0.01 K, ...
+constexpr N2kFieldDescriptor ENVIRONMENT[] = {
+    N2kUnsignedField(16, 16, 0.01, KELVIN_OFFSET, BOATDATA_FIELD_DST_SEA_TEMPERATURE),
+};
+
+// PGN 130312 Temperature: SID, instance, source, actual temperature 0.01 K, set temperature
+constexpr N2kFieldDescriptor TEMPERATURE[] = {
+    N2kUnsignedField(24, 16, 0.01, KELVIN_OFFSET, BOATDATA_FIELD_DST_SEA_TEMPERATURE),
+};
+
+constexpr uint8_t SEA_TEMPERATURE_SOURCE = 0;  // tN2kTempSource N2kts_SeaTemperature
+
+#define N2K_LAYOUT_FIELDS(fields) fields, static_cast<uint8_t>(sizeof(fields) / sizeof(fields[0]))
+
+// Sorted by PGN; layouts of one PGN are adjacent
+constexpr N2kPgnLayout LAYOUTS[] = {
+    {127506UL, BOATDATA_SCHEMA_GROUP_BATTERY, 4, 8, 8, N2K_BATTERY_INSTANCE_A, N2K_LAYOUT_FIELDS(DC_DETAILED_STATUS_A)},
+    {127506UL, BOATDATA_SCHEMA_GROUP_BATTERY, 4, 8, 8, N2K_BATTERY_INSTANCE_B, N2K_LAYOUT_FIELDS(DC_DETAILED_STATUS_B)},
+    {127508UL, BOATDATA_SCHEMA_GROUP_BATTERY, 5, 0, 8, N2K_BATTERY_INSTANCE_A, N2K_LAYOUT_FIELDS(BATTERY_STATUS_A)},
+    {127508UL, BOATDATA_SCHEMA_GROUP_BATTERY, 5, 0, 8, N2K_BATTERY_INSTANCE_B, N2K_LAYOUT_FIELDS(BATTERY_STATUS_B)},
+    {129539UL, BOATDATA_SCHEMA_GROUP_GPS, 4, 0, 0, 0, N2K_LAYOUT_FIELDS(GNSS_DOPS)},
+    {130310UL, BOATDATA_SCHEMA_GROUP_DST, 3, 0, 0, 0, N2K_LAYOUT_FIELDS(OUTSIDE_ENVIRONMENT)},
+    {130311UL, BOATDATA_SCHEMA_GROUP_DST, 4, 8, 6, SEA_TEMPERATURE_SOURCE, N2K_LAYOUT_FIELDS(ENVIRONMENT)},
+    {130312UL, BOATDATA_SCHEMA_GROUP_DST, 5, 16, 8, SEA_TEMPERATURE_SOURCE, N2K_LAYOUT_FIELDS(TEMPERATURE)},
+};
+
+#undef N2K_LAYOUT_FIELDS
+
+constexpr uint8_t LAYOUT_COUNT = sizeof(LAYOUTS) / sizeof(LAYOUTS[0]);
+
+/// Every field and selector within 1-32 bits and the layout's payload length
+constexpr bool layoutsFit() {
+    for (uint8_t i = 0; i < LAYOUT_COUNT; i++) {
+        const N2kPgnLayout& layout = LAYOUTS[i];
+        if (layout.selectorBitWidth > 8 ||
+            layout.selectorBitOffset + layout.selectorBitWidth > layout.minLength * 8) {
+            return false;
+        }
+        for (uint8_t f = 0; f < layout.fieldCount; f++) {
+            const N2kFieldDescriptor& field = layout.fields[f];
+            if (field.bitWidth == 0 || field.bitWidth > 32 || field.field >= BOATDATA_FIELD_COUNT ||
+                field.bitOffset + field.bitWidth > layout.minLength * 8) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static_assert(layoutsFit(), "an N2kFieldDecoder field or selector lies outside its layout's payload");
+
+}  // namespace
+
+namespace N2kFieldDecoder {
+
+uint32_t extract(const uint8_t* data, uint16_t bitOffset, uint8_t bitWidth) {
+    const uint8_t* p = data + bitOffset / 8;
+    uint8_t shift = bitOffset % 8;
+    uint8_t bytes = static_cast<uint8_t>((shift + bitWidth + 7) / 8);
+    uint64_t bits = 0;
+    for (uint8_t i = 0; i < bytes; i++) {
+        bits |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return static_cast<uint32_t>((bits >> shift) & ((1ULL << bitWidth) - 1));
+}
+
+bool handles(uint32_t pgn) {
+    for (uint8_t i = 0; i < LAYOUT_COUNT; i++) {
+        if (LAYOUTS[i].pgn == pgn) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const N2kPgnLayout* select(uint32_t pgn, const uint8_t* data, size_t length, N2kDecodeStatus& status) {
+    status = N2kDecodeStatus::NO_LAYOUT;
+    for (uint8_t i = 0; i < LAYOUT_COUNT; i++) {
+        const N2kPgnLayout& layout = LAYOUTS[i];
+        if (layout.pgn != pgn) {
+            continue;
+        }
+        if (length < layout.minLength) {
+            status = N2kDecodeStatus::TOO_SHORT;
+            continue;
+        }
+        if (layout.selectorBitWidth == 0 ||
+            extract(data, layout.selectorBitOffset, layout.selectorBitWidth) == layout.selectorValue) {
+            status = N2kDecodeStatus::DECODED;
+            return &layout;
+        }
+        if (status == N2kDecodeStatus::NO_LAYOUT) {
+            status = N2kDecodeStatus::NOT_SELECTED;
+        }
+    }
+    return nullptr;
+}
+
+N2kDecodeResult decode(const N2kPgnLayout& layout, const uint8_t* data, void* group) {
+    N2kDecodeResult result = {N2kDecodeStatus::NOT_AVAILABLE, 0, 0, BOATDATA_FIELD_COUNT, 0.0};
+    const uint8_t firstField = BoatDataSchema::groupInfo(layout.group).firstField;
+
+    for (uint8_t i = 0; i < layout.fieldCount; i++) {
+        const N2kFieldDescriptor& field = layout.fields[i];
+        uint32_t raw = extract(data, field.bitOffset, field.bitWidth);
+        uint32_t noValue = field.bitWidth >= 8 ? field.naRaw - 1 : field.naRaw;
+
+        double value;
+        if (field.isSigned) {
+            int32_t signedRaw = (raw >> (field.bitWidth - 1)) & 1
+                ? static_cast<int32_t>(static_cast<int64_t>(raw) - (1LL << field.bitWidth))
+                : static_cast<int32_t>(raw);
+            if (signedRaw >= static_cast<int32_t>(noValue)) {
+                continue;
+            }
+            value = signedRaw * field.scale + field.offset;
+        } else {
+            if (raw >= noValue) {
+                continue;
+            }
+            value = raw * field.scale + field.offset;
+        }
+
+        if (!BoatDataSchema::inRange(field.field, value)) {
+            if (result.clamped++ == 0) {
+                result.clampedField = field.field;
+                result.clampedValue = value;
+            }
+            value = BoatDataSchema::clamp(field.field, value);
+        }
+        BoatDataSchema::setMember(group, field.field, value);
+        result.fields |= static_cast<uint16_t>(1u << (field.field - firstField));
+    }
+
+    if (result.fields != 0) {
+        result.status = N2kDecodeStatus::DECODED;
+    }
+    return result;
+}
+
+const N2kPgnLayout* layouts(uint8_t& count) {
+    count = LAYOUT_COUNT;
+    return LAYOUTS;
+}
+
+}  // namespace N2kFieldDecoder
@@ -0,0 +1,150 @@
+/**
+ * @file N2kFieldDecoder.h
+ * @brief Table-driven NMEA 2000 decoding straight from the payload into BoatData fields
+ *
+ * PGNs that only carry a few plain numbers into existing BoatData fields
+ * (battery status, DOPs, environmental temperatures) are described by a
+ * constexpr layout instead of a hand-written HandleN2kPGN*() with its
+ * Parse call and locals:
+ *
+ * - N2kFieldDescriptor: bit offset, width, signedness, "not available"
+ *   code, scale and offset of one field, and the BoatDataFieldId it feeds
+ * - N2kPgnLayout: the descriptors of one PGN, the payload length they
+ *   need and an optional selector (instance, temperature source) that
+ *   must match; a PGN may have several layouts, one per selector value
+ *   (battery instance A and B)
+ *
+ * decode() reads every field in place from tN2kMsg::Data (little endian,
+ * least significant bit first), drops the "not available" and "out of
+ * range" codes, scales the raw value into the field's unit, clamps it to
+ * the BoatDataSchema range and stores it into the group struct a
+ * patch*() call takes. The result carries the patch field mask
+ * (bit = field - first field of the group).
+ *
+ * The layouts live in N2kFieldDecoder.cpp; a static_assert checks that
+ * every field and selector fits the layout's payload length. Adding a
+ * PGN is one layout plus one N2kPGNTable::add() of HandleN2kDecodedPGN.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * N2kDecodeStatus status;
+ * const N2kPgnLayout* layout = N2kFieldDecoder::select(N2kMsg.PGN, N2kMsg.Data, N2kMsg.DataLen, status);
+ * if (layout != nullptr) {
+ *     BatteryData values;   // Struct of layout->group
+ *     N2kDecodeResult result = N2kFieldDecoder::decode(*layout, N2kMsg.Data, &values);
+ *     if (result.fields != 0) { values.available = true; boatData->patchBattery(result.fields, values); }
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): layouts in flash (constexpr), no allocation, no copy of the payload
+ * - Principle VII (Fail-Safe): short payloads, NA codes and out-of-range values never reach BoatData unchecked
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef N2K_FIELD_DECODER_H
+#define N2K_FIELD_DECODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "BoatDataSchema.h"
+
+/**
+ * @brief One field of a PGN payload
+ *
+ * The raw codes naRaw ("not available") and, for 8 bits and wider,
+ * naRaw - 1 ("out of range") carry no value.
+ */
+struct N2kFieldDescriptor {
+    uint16_t bitOffset;     ///< First bit in the payload (byte * 8 + bit)
+    uint8_t bitWidth;       ///< 1-32
+    bool isSigned;          ///< Two's complement
+    uint32_t naRaw;         ///< All ones (unsigned) or the largest positive value (signed)
+    double scale;           ///< value = raw * scale + offset, in the unit of @p field
+    double offset;
+    uint8_t field;          ///< BoatDataFieldId written
+};
+
+/// Unsigned field of @p bitWidth bits at @p bitOffset
+constexpr N2kFieldDescriptor N2kUnsignedField(uint16_t bitOffset, uint8_t bitWidth, double scale,
+                                              double offset, uint8_t field) {
+    return {bitOffset, bitWidth, false, static_cast<uint32_t>((1ULL << bitWidth) - 1), scale, offset, field};
+}
+
+/// Two's complement field of @p bitWidth bits at @p bitOffset
+constexpr N2kFieldDescriptor N2kSignedField(uint16_t bitOffset, uint8_t bitWidth, double scale,
+                                            double offset, uint8_t field) {
+    return {bitOffset, bitWidth, true, static_cast<uint32_t>((1ULL << (bitWidth - 1)) - 1), scale, offset, field};
+}
+
+/**
+ * @brief Field descriptors of one PGN (for one selector value)
+ */
+struct N2kPgnLayout {
+    uint32_t pgn;
+    uint8_t group;                    ///< BoatDataSchemaGroupId of every field
+    uint8_t minLength;                ///< Payload bytes the fields and the selector span
+    uint16_t selectorBitOffset;       ///< Field that must equal selectorValue (instance, source)
+    uint8_t selectorBitWidth;         ///< 0 = no selector, every message
+    uint8_t selectorValue;
+    const N2kFieldDescriptor* fields;
+    uint8_t fieldCount;
+};
+
+/**
+ * @brief Outcome of select() and decode()
+ */
+enum class N2kDecodeStatus : uint8_t {
+    DECODED,         ///< At least one field has a value
+    NOT_AVAILABLE,   ///< Every field carried a "not available" or "out of range" code
+    NO_LAYOUT,       ///< PGN not in the table
+    NOT_SELECTED,    ///< Selector matches no layout (another instance or source)
+    TOO_SHORT        ///< Payload shorter than the layout
+};
+
+/**
+ * @brief Fields decode() stored
+ */
+struct N2kDecodeResult {
+    N2kDecodeStatus status;   ///< DECODED or NOT_AVAILABLE
+    uint16_t fields;          ///< patch*() selectors of the stored fields
+    uint8_t clamped;          ///< Stored fields that were outside their schema range
+    uint8_t clampedField;     ///< First clamped field (BOATDATA_FIELD_COUNT = none)
+    double clampedValue;      ///< Its value before clamping
+};
+
+namespace N2kFieldDecoder {
+
+/// @p bitWidth (1-32) bits at @p bitOffset of @p data, least significant first
+uint32_t extract(const uint8_t* data, uint16_t bitOffset, uint8_t bitWidth);
+
+/// A layout exists for @p pgn
+bool handles(uint32_t pgn);
+
+/**
+ * @brief Layout of @p pgn whose selector matches the payload
+ *
+ * @param status NO_LAYOUT, NOT_SELECTED or TOO_SHORT when nullptr is returned, DECODED otherwise
+ * @return nullptr if there is no matching layout
+ */
+const N2kPgnLayout* select(uint32_t pgn, const uint8_t* data, size_t length, N2kDecodeStatus& status);
+
+/**
+ * @brief Decode the fields of @p layout into @p group
+ *
+ * @p data must hold layout.minLength bytes (see select()); @p group is the
+ * struct of layout.group (GPSData, DSTData, BatteryData, ...). Fields
+ * without a value are left untouched and not selected.
+ */
+N2kDecodeResult decode(const N2kPgnLayout& layout, const uint8_t* data, void* group);
+
+/// Every layout (tests, registration checks)
+const N2kPgnLayout* layouts(uint8_t& count);
+
+}  // namespace N2kFieldDecoder
+
+#endif // N2K_FIELD_DECODER_H
@@ -0,0 +1,175 @@
+/**
+ * @file N2kLoadPlan.cpp
+ * @brief Implementation of the load generator's mix and pacing
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "N2kLoadPlan.h"
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+constexpr uint8_t FAST_PACKET_MAX_BYTES = 223;   // 6 + 31 * 7
+constexpr uint16_t MAX_WEIGHT = 1000;
+
+}  // namespace
+
+N2kLoadPlan::N2kLoadPlan() : count_(0), fps_(0), startMs_(0), sent_(0), scheduled_(0), late_(0) {
+}
+
+uint32_t N2kLoadPlan::framesPerSecond(uint8_t loadPct) {
+    if (loadPct > 100) {
+        loadPct = 100;
+    }
+    return static_cast<uint32_t>(static_cast<uint64_t>(N2K_LOAD_BITRATE) * loadPct /
+                                 (100ULL * N2K_LOAD_BITS_PER_FRAME));
+}
+
+uint32_t N2kLoadPlan::canId(uint8_t priority, uint32_t pgn, uint8_t source, uint8_t destination) {
+    uint32_t id = (static_cast<uint32_t>(priority & 0x07) << 26) | (static_cast<uint32_t>(source));
+    uint8_t pduFormat = static_cast<uint8_t>((pgn >> 8) & 0xFF);
+    if (pduFormat < 240) {
+        // PDU1: the low byte of the identifier's PGN field is the destination
+        id |= ((pgn & 0x3FF00UL) | destination) << 8;
+    } else {
+        id |= (pgn & 0x3FFFFUL) << 8;
+    }
+    return id;
+}
+
+uint8_t N2kLoadPlan::frameCount(uint8_t length, bool fastPacket) {
+    if (!fastPacket) {
+        return 1;
+    }
+    if (length <= 6) {
+        return 1;
+    }
+    return static_cast<uint8_t>(1 + (length - 6 + 6) / 7);   // Frame 0 holds 6 bytes, then 7 each
+}
+
+uint8_t N2kLoadPlan::splitFastPacket(const uint8_t* data, uint8_t length, uint8_t sequence,
+                                     uint8_t frames[][8]) {
+    if (length > FAST_PACKET_MAX_BYTES) {
+        return 0;
+    }
+    uint8_t count = frameCount(length, true);
+    uint8_t offset = 0;
+    for (uint8_t f = 0; f < count; f++) {
+        uint8_t* frame = frames[f];
+        memset(frame, 0xFF, 8);
+        frame[0] = static_cast<uint8_t>(((sequence & 0x07) << 5) | f);
+        uint8_t at = 1;
+        if (f == 0) {
+            frame[1] = length;
+            at = 2;
+        }
+        while (at < 8 && offset < length) {
+            frame[at++] = data[offset++];
+        }
+    }
+    return count;
+}
+
+void N2kLoadPlan::clear() {
+    count_ = 0;
+}
+
+bool N2kLoadPlan::add(uint32_t pgn, uint16_t weight) {
+    if (weight == 0) {
+        return true;
+    }
+    for (uint8_t i = 0; i < count_; i++) {
+        if (entries_[i].pgn == pgn) {
+            entries_[i].weight += weight;
+            return true;
+        }
+    }
+    if (count_ >= MAX_ENTRIES) {
+        return false;
+    }
+    entries_[count_++] = {pgn, weight, 0};
+    return true;
+}
+
+bool N2kLoadPlan::parseMix(const char* text) {
+    clear();
+    if (text == nullptr || *text == '\0') {
+        return false;
+    }
+    const char* p = text;
+    while (*p != '\0') {
+        char* end;
+        unsigned long pgn = strtoul(p, &end, 10);
+        if (end == p || pgn == 0 || pgn > 0x3FFFFUL) {
+            clear();
+            return false;
+        }
+        p = end;
+        unsigned long weight = 1;
+        if (*p == ':') {
+            p++;
+            weight = strtoul(p, &end, 10);
+            if (end == p || weight > MAX_WEIGHT) {
+                clear();
+                return false;
+            }
+            p = end;
+        }
+        if (!add(static_cast<uint32_t>(pgn), static_cast<uint16_t>(weight))) {
+            clear();
+            return false;
+        }
+        if (*p == ',') {
+            p++;
+        } else if (*p != '\0') {
+            clear();
+            return false;
+        }
+    }
+    return count_ > 0;
+}
+
+uint8_t N2kLoadPlan::next() {
+    // Smooth weighted round-robin: every entry gains its weight, the richest
+    // is picked and pays the total back
+    int32_t total = 0;
+    uint8_t best = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        entries_[i].current += entries_[i].weight;
+        total += entries_[i].weight;
+        if (entries_[i].current > entries_[best].current) {
+            best = i;
+        }
+    }
+    entries_[best].current -= total;
+    return best;
+}
+
+void N2kLoadPlan::start(uint32_t framesPerSecond, uint32_t nowMs) {
+    fps_ = framesPerSecond;
+    startMs_ = nowMs;
+    sent_ = 0;
+    scheduled_ = 0;
+    late_ = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        entries_[i].current = 0;
+    }
+}
+
+uint32_t N2kLoadPlan::framesDue(uint32_t nowMs, uint32_t maxFrames) {
+    uint64_t target = static_cast<uint64_t>(nowMs - startMs_) * fps_ / 1000;
+    if (target <= scheduled_) {
+        return 0;
+    }
+    uint64_t due = target - scheduled_;
+    if (due > 2ULL * maxFrames) {
+        uint64_t skipped = due - maxFrames;
+        late_ += static_cast<uint32_t>(skipped);
+        scheduled_ += skipped;
+        due = maxFrames;
+    }
+    return static_cast<uint32_t>(due < maxFrames ? due : maxFrames);
+}
@@ -0,0 +1,144 @@
+/**
+ * @file N2kLoadPlan.h
+ * @brief Frame schedule of the synthetic NMEA 2000 load generator
+ *
+ * The load generator (N2kLoadGenerator) pushes frames into the CAN receive
+ * queue at a fixed share of the bus capacity. This class holds the parts
+ * that need no hardware:
+ *
+ * - the message mix: PGNs with integer weights, picked by smooth weighted
+ *   round-robin, so a 10:1 mix interleaves instead of sending bursts
+ * - the pacing: framesDue() turns elapsed time and the target rate into the
+ *   frames to send now; a fast-packet message counts all of its frames
+ * - the frame layout: canId() and splitFastPacket() for multi-frame PGNs
+ *
+ * Load is a percentage of N2K_LOAD_BITRATE at N2K_LOAD_BITS_PER_FRAME
+ * (a full 8-byte extended frame without stuff bits), so 100% is about
+ * 1900 frames/s on a 250 kbit/s bus.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * N2kLoadPlan plan;
+ * plan.parseMix("130306:10,129025:10,129029:1");
+ * plan.start(N2kLoadPlan::framesPerSecond(60), millis());
+ * // Every pass:
+ * uint32_t due = plan.framesDue(millis());
+ * while (due > 0) {
+ *     uint8_t entry = plan.next();
+ *     // send the frames of plan.entry(entry).pgn, then:
+ *     plan.sent(frames);
+ *     due = due > frames ? due - frames : 0;
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed mix table, no heap
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef N2K_LOAD_PLAN_H
+#define N2K_LOAD_PLAN_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+/**
+ * @brief One PGN of the mix
+ */
+struct N2kLoadMixEntry {
+    uint32_t pgn;
+    uint16_t weight;
+    int32_t current;   ///< Smooth weighted round-robin state
+};
+
+/**
+ * @class N2kLoadPlan
+ * @brief Weighted PGN mix and frame pacing for the load generator
+ */
+class N2kLoadPlan {
+public:
+    static constexpr uint8_t MAX_ENTRIES = N2K_LOAD_MAX_MIX;
+    static constexpr uint8_t MAX_FRAMES_PER_MESSAGE = 32;   ///< Fast-packet limit (223 bytes)
+
+    N2kLoadPlan();
+
+    /// Frames per second at @p loadPct percent of the bus (capped at 100)
+    static uint32_t framesPerSecond(uint8_t loadPct);
+
+    /// 29-bit CAN identifier of a frame (PDU1 PGNs carry @p destination)
+    static uint32_t canId(uint8_t priority, uint32_t pgn, uint8_t source, uint8_t destination = 0xFF);
+
+    /**
+     * @brief Split a fast-packet payload into frames (8 bytes each, 0xFF padded)
+     *
+     * @param sequence 3-bit sequence counter of this message
+     * @param frames Output, room for MAX_FRAMES_PER_MESSAGE
+     * @return Frames written, 0 if @p length is above 223
+     */
+    static uint8_t splitFastPacket(const uint8_t* data, uint8_t length, uint8_t sequence,
+                                   uint8_t frames[][8]);
+
+    /// Frames of a message of @p length bytes (1 for a single-frame PGN)
+    static uint8_t frameCount(uint8_t length, bool fastPacket);
+
+    void clear();
+
+    /**
+     * @brief Add @p pgn with @p weight (weight 0 is dropped; a repeated PGN adds up)
+     * @return false when the mix is full
+     */
+    bool add(uint32_t pgn, uint16_t weight);
+
+    /**
+     * @brief Replace the mix from "pgn[:weight],..." (weight defaults to 1)
+     * @return false on a syntax error, a weight above 1000 or more than MAX_ENTRIES
+     *         PGNs; the mix is then empty
+     */
+    bool parseMix(const char* text);
+
+    uint8_t count() const { return count_; }
+    const N2kLoadMixEntry& entry(uint8_t index) const { return entries_[index]; }
+
+    /// Pick the next mix entry (count() must be > 0)
+    uint8_t next();
+
+    /// Begin pacing at @p framesPerSecond from @p nowMs
+    void start(uint32_t framesPerSecond, uint32_t nowMs);
+
+    /**
+     * @brief Frames to send now to stay on the target rate (at most @p maxFrames)
+     *
+     * When the sender falls behind by more than two passes' worth, all but
+     * one pass of the backlog is skipped and counted as late, so a stall is
+     * not followed by a burst far above the target rate.
+     */
+    uint32_t framesDue(uint32_t nowMs, uint32_t maxFrames = N2K_LOAD_MAX_FRAMES_PER_PASS);
+
+    /// Count @p frames as sent (any outcome: injected or dropped)
+    void sent(uint32_t frames) {
+        sent_ += frames;
+        scheduled_ += frames;
+    }
+
+    uint32_t getTargetFps() const { return fps_; }
+    uint64_t getSent() const { return sent_; }
+
+    /// Frames the schedule gave up on because the sender could not keep up
+    uint32_t getLate() const { return late_; }
+
+private:
+    N2kLoadMixEntry entries_[MAX_ENTRIES];
+    uint8_t count_;
+    uint32_t fps_;
+    uint32_t startMs_;
+    uint64_t sent_;
+    uint64_t scheduled_;   ///< Sent plus late, compared with the target
+    uint32_t late_;
+};
+
+#endif // N2K_LOAD_PLAN_H
@@ -0,0 +1,259 @@
+/**
+ * @file NMEA0183Encoder.cpp
+ * @brief Implementation of the allocation-free NMEA 0183 sentence encoder
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "NMEA0183Encoder.h"
+#include <math.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+
+NMEA0183SentenceWriter::NMEA0183SentenceWriter(char* buffer, size_t bufferSize)
+    : buf(buffer), size(bufferSize), len(0), overflow(buffer == nullptr || bufferSize == 0) {
+    if (!overflow) {
+        buf[0] = '\0';
+    }
+}
+
+void NMEA0183SentenceWriter::append(const char* text, size_t n) {
+    if (overflow) {
+        return;
+    }
+    // Keep room for the NUL
+    if (len + n >= size) {
+        overflow = true;
+        return;
+    }
+    memcpy(buf + len, text, n);
+    len += n;
+    buf[len] = '\0';
+}
+
+void NMEA0183SentenceWriter::appendf(const char* format, ...) {
+    if (overflow) {
+        return;
+    }
+
+    va_list args;
+    va_start(args, format);
+    int written = vsnprintf(buf + len, size - len, format, args);
+    va_end(args);
+
+    if (written < 0 || len + static_cast<size_t>(written) >= size) {
+        overflow = true;
+        return;
+    }
+    len += written;
+}
+
+void NMEA0183SentenceWriter::separator() {
+    append(",", 1);
+}
+
+NMEA0183SentenceWriter& NMEA0183SentenceWriter::begin(const char* talker, const char* code) {
+    len = 0;
+    overflow = (buf == nullptr || size == 0);
+    append("$", 1);
+    append(talker, strlen(talker));
+    append(code, strlen(code));
+    return *this;
+}
+
+NMEA0183SentenceWriter& NMEA0183SentenceWriter::addField(double value, uint8_t decimals) {
+    separator();
+    if (!isnan(value)) {
+        appendf("%.*f", static_cast<int>(decimals), value);
+    }
+    return *this;
+}
+
+NMEA0183SentenceWriter& NMEA0183SentenceWriter::addField(const char* text) {
+    separator();
+    if (text != nullptr) {
+        append(text, strlen(text));
+    }
+    return *this;
+}
+
+NMEA0183SentenceWriter& NMEA0183SentenceWriter::addField(char c) {
+    separator();
+    if (c != '\0') {
+        append(&c, 1);
+    }
+    return *this;
+}
+
+void NMEA0183SentenceWriter::addCoordinate(double value, uint8_t degreeDigits,
+                                           char positive, char negative) {
+    separator();
+    if (isnan(value)) {
+        separator();
+        return;
+    }
+
+    // Round once in 1/10000 minute units so 59.99995' carries into the degrees
+    unsigned long units = static_cast<unsigned long>(llround(fabs(value) * 600000.0));
+    unsigned long degrees = units / 600000UL;
+    unsigned long minutes = (units % 600000UL) / 10000UL;
+    unsigned long fraction = units % 10000UL;
+
+    appendf("%0*lu%02lu.%04lu", static_cast<int>(degreeDigits), degrees, minutes, fraction);
+    separator();
+    char hemisphere = value < 0.0 ? negative : positive;
+    append(&hemisphere, 1);
+}
+
+NMEA0183SentenceWriter& NMEA0183SentenceWriter::addPosition(double latitude, double longitude) {
+    addCoordinate(latitude, 2, 'N', 'S');
+    addCoordinate(longitude, 3, 'E', 'W');
+    return *this;
+}
+
+uint8_t NMEA0183SentenceWriter::checksum(const char* body, size_t n) {
+    uint8_t sum = 0;
+    for (size_t i = 0; i < n; i++) {
+        sum ^= static_cast<uint8_t>(body[i]);
+    }
+    return sum;
+}
+
+size_t NMEA0183SentenceWriter::finish() {
+    if (overflow || len < 1) {
+        return 0;
+    }
+
+    appendf("*%02X\r\n", checksum(buf + 1, len - 1));
+    if (overflow || len > NMEA0183_MAX_SENTENCE_SIZE - 1) {
+        overflow = true;
+        return 0;
+    }
+    return len;
+}
+
+// ============================================================================
+// Sentence encoders
+// ============================================================================
+
+namespace {
+
+/**
+ * @brief Magnitude of a signed variation plus its E/W letter ('\0' if unknown)
+ */
+char variationHemisphere(double variationDeg, double& magnitude) {
+    if (isnan(variationDeg)) {
+        magnitude = NAN;
+        return '\0';
+    }
+    magnitude = fabs(variationDeg);
+    return variationDeg < 0.0 ? 'W' : 'E';
+}
+
+}  // namespace
+
+size_t NMEA0183EncodeHDG(char* buf, size_t size, const char* talker,
+                         double headingDeg, double variationDeg) {
+    double variation;
+    char hemisphere = variationHemisphere(variationDeg, variation);
+
+    NMEA0183SentenceWriter w(buf, size);
+    w.begin(talker, "HDG")
+     .addField(headingDeg, 1)
+     .addField(static_cast<const char*>(nullptr))   // Deviation
+     .addField('\0')
+     .addField(variation, 1)
+     .addField(hemisphere);
+    return w.finish();
+}
+
+size_t NMEA0183EncodeHDM(char* buf, size_t size, const char* talker, double headingDeg) {
+    NMEA0183SentenceWriter w(buf, size);
+    w.begin(talker, "HDM")
+     .addField(headingDeg, 1)
+     .addField('M');
+    return w.finish();
+}
+
+size_t NMEA0183EncodeMWV(char* buf, size_t size, const char* talker,
+                         double angleDeg, char reference, double speedKnots) {
+    NMEA0183SentenceWriter w(buf, size);
+    w.begin(talker, "MWV")
+     .addField(angleDeg, 1)
+     .addField(reference)
+     .addField(speedKnots, 1)
+     .addField('N')
+     .addField('A');
+    return w.finish();
+}
+
+size_t NMEA0183EncodeDPT(char* buf, size_t size, const char* talker,
+                         double depthM, double offsetM) {
+    NMEA0183SentenceWriter w(buf, size);
+    w.begin(talker, "DPT")
+     .addField(depthM, 1)
+     .addField(offsetM, 1);
+    return w.finish();
+}
+
+size_t NMEA0183EncodeVHW(char* buf, size_t size, const char* talker,
+                         double trueHeadingDeg, double magneticHeadingDeg, double speedKnots) {
+    NMEA0183SentenceWriter w(buf, size);
+    w.begin(talker, "VHW")
+     .addField(trueHeadingDeg, 1)
+     .addField('T')
+     .addField(magneticHeadingDeg, 1)
+     .addField('M')
+     .addField(speedKnots, 1)
+     .addField('N')
+     .addField(isnan(speedKnots) ? speedKnots : speedKnots * 1.852, 1)
+     .addField('K');
+    return w.finish();
+}
+
+size_t NMEA0183EncodeRMC(char* buf, size_t size, const char* talker, double latitude,
+                         double longitude, double sogKnots, double cogDeg, double variationDeg,
+                         bool valid) {
+    double variation;
+    char hemisphere = variationHemisphere(variationDeg, variation);
+
+    NMEA0183SentenceWriter w(buf, size);
+    w.begin(talker, "RMC")
+     .addField(static_cast<const char*>(nullptr))   // UTC time
+     .addField(valid ? 'A' : 'V')
+     .addPosition(latitude, longitude)
+     .addField(sogKnots, 1)
+     .addField(cogDeg, 1)
+     .addField(static_cast<const char*>(nullptr))   // Date
+     .addField(variation, 1)
+     .addField(hemisphere)
+     .addField(valid ? 'A' : 'N');                  // Mode indicator (NMEA 2.3)
+    return w.finish();
+}
+
+size_t NMEA0183EncodeRSA(char* buf, size_t size, const char* talker, double angleDeg) {
+    NMEA0183SentenceWriter w(buf, size);
+    w.begin(talker, "RSA")
+     .addField(angleDeg, 1)
+     .addField(isnan(angleDeg) ? 'V' : 'A')
+     .addField(static_cast<const char*>(nullptr))   // Port rudder (not fitted)
+     .addField('V');
+    return w.finish();
+}
+
+size_t NMEA0183EncodeMWD(char* buf, size_t size, const char* talker, double trueDirectionDeg,
+                         double magneticDirectionDeg, double speedKnots) {
+    NMEA0183SentenceWriter w(buf, size);
+    w.begin(talker, "MWD")
+     .addField(trueDirectionDeg, 1)
+     .addField('T')
+     .addField(magneticDirectionDeg, 1)
+     .addField('M')
+     .addField(speedKnots, 1)
+     .addField('N')
+     .addField(isnan(speedKnots) ? speedKnots : speedKnots * 0.514444, 1)
+     .addField('M');
+    return w.finish();
+}
@@ -0,0 +1,175 @@
+/**
+ * @file NMEA0183Encoder.h
+ * @brief Allocation-free NMEA 0183 sentence encoder
+ *
+ * Formats sentences straight into a caller-provided buffer (no String, no
+ * heap) and appends the checksum and CR/LF. Unavailable values (NaN) become
+ * empty fields as the standard allows.
+ *
+ * Sentence encoders (inputs in display units - degrees, knots, meters):
+ * - HDG: heading, deviation & variation
+ * - HDM: magnetic heading
+ * - MWV: wind speed and angle (relative or true)
+ * - DPT: depth of water
+ * - VHW: water speed and heading
+ * - RMC: recommended minimum GNSS data (time/date fields left empty)
+ * - RSA: rudder sensor angle (single rudder)
+ * - MWD: true wind direction and speed
+ *
+ * Usage:
+ * @code
+ * char line[NMEA0183_MAX_SENTENCE_SIZE];
+ * size_t len = NMEA0183EncodeDPT(line, sizeof(line), "II", 12.4, 0.3);
+ * // line = "$IIDPT,12.4,0.3*hh\r\n"
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): zero heap allocation
+ * - Principle VII (Fail-Safe): a sentence that does not fit is rejected (length 0)
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef NMEA0183_ENCODER_H
+#define NMEA0183_ENCODER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/// Longest sentence the standard allows, including "$", "*hh\r\n" and a NUL
+constexpr size_t NMEA0183_MAX_SENTENCE_SIZE = 83;
+
+/**
+ * @class NMEA0183SentenceWriter
+ * @brief Field-by-field sentence builder over a fixed buffer
+ *
+ * Calls chain; after an overflow all further calls are no-ops and finish()
+ * returns 0.
+ */
+class NMEA0183SentenceWriter {
+public:
+    NMEA0183SentenceWriter(char* buffer, size_t size);
+
+    /**
+     * @brief Start a sentence: "$" + talker + code
+     */
+    NMEA0183SentenceWriter& begin(const char* talker, const char* code);
+
+    /**
+     * @brief Append a fixed-point number field (NaN = empty field)
+     */
+    NMEA0183SentenceWriter& addField(double value, uint8_t decimals);
+
+    /**
+     * @brief Append a text field (nullptr = empty field)
+     */
+    NMEA0183SentenceWriter& addField(const char* text);
+
+    /**
+     * @brief Append a single-character field ('\0' = empty field)
+     */
+    NMEA0183SentenceWriter& addField(char c);
+
+    /**
+     * @brief Append a latitude/longitude pair as ddmm.mmmm,N,dddmm.mmmm,E
+     */
+    NMEA0183SentenceWriter& addPosition(double latitude, double longitude);
+
+    /**
+     * @brief Append "*hh\r\n" and NUL-terminate
+     * @return Sentence length (excluding the NUL), 0 on overflow
+     */
+    size_t finish();
+
+    bool overflowed() const { return overflow; }
+
+    /**
+     * @brief XOR checksum of the characters between "$" and "*"
+     */
+    static uint8_t checksum(const char* body, size_t len);
+
+private:
+    char* buf;
+    size_t size;
+    size_t len;
+    bool overflow;
+
+    void append(const char* text, size_t n);
+    void appendf(const char* format, ...);
+    void separator();
+    void addCoordinate(double value, uint8_t degreeDigits, char positive, char negative);
+};
+
+/**
+ * @brief $--HDG,<magnetic heading>,,,<variation>,<E|W>
+ * @param headingDeg Magnetic sensor heading, degrees [0, 360)
+ * @param variationDeg Magnetic variation, degrees, positive = East (NaN = unknown)
+ */
+size_t NMEA0183EncodeHDG(char* buf, size_t size, const char* talker,
+                         double headingDeg, double variationDeg);
+
+/**
+ * @brief $--HDM,<magnetic heading>,M
+ * @param headingDeg Magnetic heading, degrees [0, 360)
+ */
+size_t NMEA0183EncodeHDM(char* buf, size_t size, const char* talker, double headingDeg);
+
+/**
+ * @brief $--MWV,<angle>,<R|T>,<speed>,N,A
+ * @param angleDeg Wind angle relative to the bow, degrees [0, 360)
+ * @param reference 'R' (relative/apparent) or 'T' (true)
+ * @param speedKnots Wind speed, knots
+ */
+size_t NMEA0183EncodeMWV(char* buf, size_t size, const char* talker,
+                         double angleDeg, char reference, double speedKnots);
+
+/**
+ * @brief $--DPT,<depth>,<offset>
+ * @param depthM Depth below transducer, meters
+ * @param offsetM Transducer offset, meters (positive = to waterline, NaN = unknown)
+ */
+size_t NMEA0183EncodeDPT(char* buf, size_t size, const char* talker,
+                         double depthM, double offsetM);
+
+/**
+ * @brief $--VHW,<true hdg>,T,<mag hdg>,M,<knots>,N,<km/h>,K
+ * @param trueHeadingDeg True heading, degrees (NaN = unknown)
+ * @param magneticHeadingDeg Magnetic heading, degrees (NaN = unknown)
+ * @param speedKnots Speed through water, knots
+ */
+size_t NMEA0183EncodeVHW(char* buf, size_t size, const char* talker,
+                         double trueHeadingDeg, double magneticHeadingDeg, double speedKnots);
+
+/**
+ * @brief $--RMC,,<A|V>,<lat>,<N|S>,<lon>,<E|W>,<sog>,<cog>,,<var>,<E|W>,<A|N>
+ *
+ * UTC time and date are not tracked by BoatData, so those fields are empty.
+ *
+ * @param latitude Decimal degrees, positive = North
+ * @param longitude Decimal degrees, positive = East
+ * @param sogKnots Speed over ground, knots
+ * @param cogDeg Course over ground, degrees true
+ * @param variationDeg Magnetic variation, degrees, positive = East (NaN = unknown)
+ * @param valid Fix valid ('A') or not ('V')
+ */
+size_t NMEA0183EncodeRMC(char* buf, size_t size, const char* talker, double latitude,
+                         double longitude, double sogKnots, double cogDeg, double variationDeg,
+                         bool valid);
+
+/**
+ * @brief $--RSA,<angle>,A,,V (starboard/single rudder only)
+ * @param angleDeg Rudder angle, degrees, positive = starboard (NaN = unknown, status V)
+ */
+size_t NMEA0183EncodeRSA(char* buf, size_t size, const char* talker, double angleDeg);
+
+/**
+ * @brief $--MWD,<dir>,T,<dir>,M,<knots>,N,<m/s>,M
+ * @param trueDirectionDeg Direction the wind blows from, degrees true (NaN = unknown)
+ * @param magneticDirectionDeg Direction the wind blows from, degrees magnetic (NaN = unknown)
+ * @param speedKnots True wind speed, knots
+ */
+size_t NMEA0183EncodeMWD(char* buf, size_t size, const char* talker, double trueDirectionDeg,
+                         double magneticDirectionDeg, double speedKnots);
+
+#endif // NMEA0183_ENCODER_H
@@ -0,0 +1,109 @@
+/**
+ * @file NMEA0183FixFusion.cpp
+ * @brief Implementation of the RMC/GGA/VTG per-epoch merge buffer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "NMEA0183FixFusion.h"
+#include <string.h>
+
+NMEA0183FixFusion::NMEA0183FixFusion()
+    : closedDue_(false), expected_(0), sentences_(0), fixes_(0) {
+    memset(&current_, 0, sizeof(current_));
+    memset(&closed_, 0, sizeof(closed_));
+}
+
+void NMEA0183FixFusion::add(uint8_t part, uint32_t timeKey, const NMEA0183FixInput& fields,
+                            uint32_t nowMs) {
+    sentences_++;
+
+    if (current_.open) {
+        bool timed = timeKey != NO_TIME && current_.timeKey != NO_TIME;
+        if ((timed && timeKey != current_.timeKey) ||
+            (timeKey == NO_TIME && (current_.fix.parts & part) != 0)) {
+            // New UTC time, or a second untimed sentence of the same type: next fix
+            close();
+        } else if (current_.timeKey == NO_TIME) {
+            current_.timeKey = timeKey;  // VTG arrived first; adopt the epoch time
+        }
+    }
+    if (!current_.open) {
+        start(timeKey, nowMs);
+    }
+
+    merge(part, fields);
+
+    // Learning (first epoch): release every merge; afterwards once, when complete
+    if (expected_ == 0 ||
+        (current_.releasedParts == 0 && (current_.fix.parts & expected_) == expected_)) {
+        current_.releasedParts = current_.fix.parts;
+        current_.due = true;
+    }
+}
+
+void NMEA0183FixFusion::expire(uint32_t nowMs) {
+    if (current_.open && nowMs - current_.startMs >= NMEA0183_FIX_FUSION_TIMEOUT_MS) {
+        close();
+    }
+}
+
+bool NMEA0183FixFusion::take(NMEA0183FixInput& fix) {
+    if (closedDue_) {
+        fix = closed_;
+        closedDue_ = false;
+        fixes_++;
+        return true;
+    }
+    if (current_.open && current_.due) {
+        fix = current_.fix;
+        current_.due = false;
+        fixes_++;
+        return true;
+    }
+    return false;
+}
+
+void NMEA0183FixFusion::start(uint32_t timeKey, uint32_t nowMs) {
+    memset(&current_.fix, 0, sizeof(current_.fix));
+    current_.timeKey = timeKey;
+    current_.startMs = nowMs;
+    current_.open = true;
+    current_.releasedParts = 0;
+    current_.due = false;
+}
+
+void NMEA0183FixFusion::close() {
+    // The receiver's sentence set: what this epoch received
+    expected_ = current_.fix.parts;
+
+    // Not released yet, not taken yet, or late sentences added fields since
+    if (current_.due || current_.fix.parts != current_.releasedParts) {
+        closed_ = current_.fix;
+        closedDue_ = true;
+    }
+    current_.open = false;
+    current_.due = false;
+}
+
+void NMEA0183FixFusion::merge(uint8_t part, const NMEA0183FixInput& fields) {
+    NMEA0183FixInput& fix = current_.fix;
+    fix.parts |= part;
+
+    if (fields.hasPosition) {
+        fix.hasPosition = true;
+        fix.latitude = fields.latitude;
+        fix.longitude = fields.longitude;
+    }
+    if (fields.hasCourse) {
+        fix.hasCourse = true;
+        fix.cog = fields.cog;
+        fix.sog = fields.sog;
+    }
+    // RMC transmits variation; VTG's (true - magnetic course) only fills a gap
+    if (fields.hasVariation && (part == PART_RMC || !fix.hasVariation)) {
+        fix.hasVariation = true;
+        fix.variation = fields.variation;
+    }
+}
@@ -0,0 +1,125 @@
+/**
+ * @file NMEA0183FixFusion.h
+ * @brief Merges the RMC/GGA/VTG sentences of one GNSS fix into one update
+ *
+ * A receiver (e.g., the VHF radio) emits RMC, GGA and VTG for the same fix.
+ * Publishing each sentence on its own runs the GPS validation three times per
+ * fix, and the sentences that lack a field (GGA: no COG/SOG, VTG: no position)
+ * would overwrite good values with placeholders. This stage buffers the
+ * fields of one epoch and releases one consolidated fix:
+ *
+ * - Epochs are keyed on the sentence UTC time (RMC/GGA field 0); VTG carries
+ *   no time and joins the open epoch
+ * - A fix is released once all sentence types seen in the previous epoch
+ *   have arrived, so the output follows whatever set the receiver sends
+ * - An incomplete epoch is released when the next epoch starts or after
+ *   NMEA0183_FIX_FUSION_TIMEOUT_MS (a lost sentence delays, never drops, a
+ *   fix); so is one that gained fields after it was released
+ * - Until the first epoch has closed the sentence set is unknown, so every
+ *   sentence of that epoch releases the merged fix so far
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * NMEA0183FixInput in = {};
+ * in.hasPosition = true; in.latitude = 52.5; in.longitude = 5.1;
+ * fusion.add(NMEA0183FixFusion::PART_GGA, timeKey, in, millis());
+ *
+ * NMEA0183FixInput fix;
+ * while (fusion.take(fix)) { publish(fix); }
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef NMEA0183_FIX_FUSION_H
+#define NMEA0183_FIX_FUSION_H
+
+#include <stdint.h>
+#include "../config.h"
+
+/**
+ * @brief Fields of one sentence or of one merged fix
+ *
+ * Units as stored in BoatData: decimal degrees, radians, knots.
+ */
+struct NMEA0183FixInput {
+    uint8_t parts;         ///< NMEA0183FixFusion::PART_* merged into this fix
+    bool hasPosition;
+    double latitude;
+    double longitude;
+    bool hasCourse;
+    double cog;            ///< Course over ground, radians true
+    double sog;            ///< Speed over ground, knots
+    bool hasVariation;
+    double variation;      ///< Magnetic variation, radians, positive = East
+};
+
+/**
+ * @class NMEA0183FixFusion
+ * @brief Per-epoch merge buffer of one GNSS source
+ */
+class NMEA0183FixFusion {
+public:
+    static constexpr uint8_t PART_RMC = 0x01;
+    static constexpr uint8_t PART_GGA = 0x02;
+    static constexpr uint8_t PART_VTG = 0x04;
+
+    /// Time key of a sentence without a UTC time field (VTG)
+    static constexpr uint32_t NO_TIME = 0xFFFFFFFFUL;
+
+    NMEA0183FixFusion();
+
+    /**
+     * @brief Merge one validated sentence into its epoch
+     *
+     * @param part PART_* of the sentence
+     * @param timeKey UTC time in hundredths of a second, NO_TIME if absent
+     * @param fields Sentence fields (has* flags select which are set)
+     * @param nowMs Current millis()
+     */
+    void add(uint8_t part, uint32_t timeKey, const NMEA0183FixInput& fields, uint32_t nowMs);
+
+    /**
+     * @brief Close an epoch open for NMEA0183_FIX_FUSION_TIMEOUT_MS or longer
+     */
+    void expire(uint32_t nowMs);
+
+    /**
+     * @brief Next fix ready for publishing
+     * @return false if no fix is ready
+     */
+    bool take(NMEA0183FixInput& fix);
+
+    /// Sentence types that complete an epoch (0 = not learned yet)
+    uint8_t getExpectedParts() const { return expected_; }
+
+    /// Sentences merged / fixes released (ratio = validations saved)
+    uint32_t getSentenceCount() const { return sentences_; }
+    uint32_t getFixCount() const { return fixes_; }
+
+private:
+    struct Epoch {
+        NMEA0183FixInput fix;
+        uint32_t timeKey;
+        uint32_t startMs;
+        bool open;
+        uint8_t releasedParts;  ///< Parts of the last queued fix (0 = not queued yet)
+        bool due;          ///< Waiting in take()
+    };
+
+    Epoch current_;
+    NMEA0183FixInput closed_;   ///< Unreleased fix of the epoch that just closed
+    bool closedDue_;
+    uint8_t expected_;
+    uint32_t sentences_;
+    uint32_t fixes_;
+
+    void start(uint32_t timeKey, uint32_t nowMs);
+    void close();
+    void merge(uint8_t part, const NMEA0183FixInput& fields);
+};
+
+#endif // NMEA0183_FIX_FUSION_H
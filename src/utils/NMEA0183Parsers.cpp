@@ -1,4 +1,5 @@
 #include "NMEA0183Parsers.h"
+#include "NMEA0183SentenceKey.h"
 #include <cstring>
 #include <cstdlib>
 
@@ -27,3 +28,69 @@ bool NMEA0183ParseRSA(const tNMEA0183Msg& msg, double& rudderAngle) {
     rudderAngle = atof(angleStr);
     return true;
 }
+
+namespace {
+
+// Optional numeric field: empty reads as 0 (as transmitted while stationary)
+bool optionalDouble(const NMEA0183Field& field, double& value) {
+    if (field.empty()) {
+        value = 0.0;
+        return true;
+    }
+    return NMEA0183FieldToDouble(field, value);
+}
+
+}  // namespace
+
+bool NMEA0183ParseRSA(const NMEA0183Tokens& tokens, double& rudderAngle) {
+    if (tokens.code() != NMEA0183PackCode("RSA") || !tokens.field(1).is('A')) {
+        return false;
+    }
+    return NMEA0183FieldToDouble(tokens.field(0), rudderAngle);
+}
+
+bool NMEA0183ParseHDM(const NMEA0183Tokens& tokens, double& heading) {
+    if (tokens.code() != NMEA0183PackCode("HDM")) {
+        return false;
+    }
+    return NMEA0183FieldToDouble(tokens.field(0), heading);
+}
+
+bool NMEA0183ParseGGA(const NMEA0183Tokens& tokens, double& latitude, double& longitude,
+                      int32_t& quality) {
+    if (tokens.code() != NMEA0183PackCode("GGA") || tokens.fieldCount() < 6) {
+        return false;
+    }
+    return NMEA0183FieldToCoordinate(tokens.field(1), tokens.field(2), latitude) &&
+           NMEA0183FieldToCoordinate(tokens.field(3), tokens.field(4), longitude) &&
+           NMEA0183FieldToInt(tokens.field(5), quality);
+}
+
+bool NMEA0183ParseRMC(const NMEA0183Tokens& tokens, double& latitude, double& longitude,
+                      double& cog, double& sog, double& variation) {
+    if (tokens.code() != NMEA0183PackCode("RMC") || tokens.fieldCount() < 11 ||
+        !tokens.field(1).is('A')) {
+        return false;
+    }
+    if (!NMEA0183FieldToCoordinate(tokens.field(2), tokens.field(3), latitude) ||
+        !NMEA0183FieldToCoordinate(tokens.field(4), tokens.field(5), longitude) ||
+        !optionalDouble(tokens.field(6), sog) ||
+        !optionalDouble(tokens.field(7), cog) ||
+        !optionalDouble(tokens.field(9), variation)) {
+        return false;
+    }
+    if (tokens.field(10).is('W')) {
+        variation = -variation;
+    }
+    return true;
+}
+
+bool NMEA0183ParseVTG(const NMEA0183Tokens& tokens, double& trueCourse, double& magneticCourse,
+                      double& sog) {
+    if (tokens.code() != NMEA0183PackCode("VTG") || tokens.fieldCount() < 5) {
+        return false;
+    }
+    return NMEA0183FieldToDouble(tokens.field(0), trueCourse) &&
+           NMEA0183FieldToDouble(tokens.field(2), magneticCourse) &&
+           NMEA0183FieldToDouble(tokens.field(4), sog);
+}
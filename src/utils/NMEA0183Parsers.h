@@ -2,6 +2,7 @@
 #define NMEA0183PARSERS_H
 
 #include <NMEA0183Msg.h>
+#include "NMEA0183Tokenizer.h"
 
 /**
  * @file NMEA0183Parsers.h
@@ -15,6 +16,12 @@
  * - Does not perform range validation (caller's responsibility)
  *
  * Reference: examples/poseidongw/src/NMEA0183Handlers.cpp:78-86 (RSA parser)
+ *
+ * Zero-copy variants take NMEA0183Tokens (checksum already validated by the
+ * tokenizer) and read fields as views with the fixed-point decimal parser.
+ * They check the message code and fields; the talker ID is checked by the
+ * NMEA0183Handler dispatch table. Angles are returned in degrees and speeds
+ * in knots, exactly as transmitted (W/negative for westerly variation).
  */
 
 /**
@@ -43,4 +50,64 @@
  */
 bool NMEA0183ParseRSA(const tNMEA0183Msg& msg, double& rudderAngle);
 
+/**
+ * @brief Parse RSA (Rudder Sensor Angle) from tokens
+ *
+ * @param tokens Tokenized sentence
+ * @param rudderAngle Output: starboard rudder angle in degrees
+ * @return true if code is RSA, status is 'A' and the angle is numeric
+ */
+bool NMEA0183ParseRSA(const NMEA0183Tokens& tokens, double& rudderAngle);
+
+/**
+ * @brief Parse HDM (Heading Magnetic) from tokens
+ *
+ * Format: $--HDM,<heading>,M*hh
+ *
+ * @param heading Output: magnetic heading in degrees
+ * @return true if code is HDM and the heading is numeric
+ */
+bool NMEA0183ParseHDM(const NMEA0183Tokens& tokens, double& heading);
+
+/**
+ * @brief Parse GGA (GPS Fix Data) from tokens
+ *
+ * Format: $--GGA,<time>,<lat>,<N|S>,<lon>,<E|W>,<quality>,<sats>,...*hh
+ *
+ * @param latitude Output: decimal degrees (negative = south)
+ * @param longitude Output: decimal degrees (negative = west)
+ * @param quality Output: fix quality indicator (0 = no fix)
+ * @return true if code is GGA and position and quality fields are valid
+ */
+bool NMEA0183ParseGGA(const NMEA0183Tokens& tokens, double& latitude, double& longitude,
+                      int32_t& quality);
+
+/**
+ * @brief Parse RMC (Recommended Minimum Navigation) from tokens
+ *
+ * Format: $--RMC,<time>,<A|V>,<lat>,<N|S>,<lon>,<E|W>,<sog>,<cog>,<date>,<var>,<E|W>*hh
+ *
+ * @param latitude Output: decimal degrees (negative = south)
+ * @param longitude Output: decimal degrees (negative = west)
+ * @param cog Output: true course over ground in degrees (0 if not transmitted)
+ * @param sog Output: speed over ground in knots (0 if not transmitted)
+ * @param variation Output: magnetic variation in degrees, west negative (0 if not transmitted)
+ * @return true if code is RMC, status is 'A' and the position is valid
+ */
+bool NMEA0183ParseRMC(const NMEA0183Tokens& tokens, double& latitude, double& longitude,
+                      double& cog, double& sog, double& variation);
+
+/**
+ * @brief Parse VTG (Track Made Good) from tokens
+ *
+ * Format: $--VTG,<true>,T,<magnetic>,M,<sog>,N,<kmh>,K*hh
+ *
+ * @param trueCourse Output: true course in degrees
+ * @param magneticCourse Output: magnetic course in degrees
+ * @param sog Output: speed over ground in knots
+ * @return true if code is VTG and both courses and the speed are numeric
+ */
+bool NMEA0183ParseVTG(const NMEA0183Tokens& tokens, double& trueCourse, double& magneticCourse,
+                      double& sog);
+
 #endif // NMEA0183PARSERS_H
@@ -0,0 +1,106 @@
+/**
+ * @file NMEA0183RouteTable.cpp
+ * @brief Implementation of the NMEA 0183 routing table
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "NMEA0183RouteTable.h"
+#include <string.h>
+
+NMEA0183RouteTable::NMEA0183RouteTable() : count_(0), routedPorts_(0) {
+}
+
+bool NMEA0183RouteTable::add(uint8_t port, uint32_t code, uint16_t talker, const char* source,
+                             bool enabled, float maxRateHz) {
+    if (port >= 8 || code == 0 || talker == 0) {
+        return false;
+    }
+
+    uint64_t key = makeKey(port, code, talker);
+    NMEA0183Route* route = nullptr;
+    for (uint8_t i = 0; i < count_; i++) {
+        if (routes_[i].key == key) {
+            route = &routes_[i];  // Later entries replace earlier ones
+            break;
+        }
+    }
+    if (route == nullptr) {
+        if (count_ >= NMEA0183_MAX_ROUTES) {
+            return false;
+        }
+        route = &routes_[count_++];
+    }
+
+    route->key = key;
+    route->source[0] = '\0';
+    if (source != nullptr) {
+        strncpy(route->source, source, sizeof(route->source) - 1);
+        route->source[sizeof(route->source) - 1] = '\0';
+    }
+    float interval = maxRateHz > 0.0f ? 1000.0f / maxRateHz : 0.0f;
+    route->minIntervalMs = static_cast<uint16_t>(interval > 65535.0f ? 65535.0f : interval);
+    route->enabled = enabled;
+    route->seen = false;
+    route->lastMs = 0;
+    routedPorts_ = static_cast<uint8_t>(routedPorts_ | (1u << port));
+    return true;
+}
+
+void NMEA0183RouteTable::finalize() {
+    // Insertion sort: at most NMEA0183_MAX_ROUTES entries, once at boot
+    for (uint8_t i = 1; i < count_; i++) {
+        NMEA0183Route route = routes_[i];
+        uint8_t j = i;
+        while (j > 0 && routes_[j - 1].key > route.key) {
+            routes_[j] = routes_[j - 1];
+            j--;
+        }
+        routes_[j] = route;
+    }
+}
+
+void NMEA0183RouteTable::clear() {
+    count_ = 0;
+    routedPorts_ = 0;
+}
+
+NMEA0183RouteDecision NMEA0183RouteTable::check(uint8_t port, uint32_t code, uint16_t talker,
+                                                uint32_t nowMs, const NMEA0183Route*& route) {
+    route = nullptr;
+    if (!routesPort(port)) {
+        return NMEA0183RouteDecision::PORT_UNROUTED;
+    }
+
+    NMEA0183Route* match = find(makeKey(port, code, talker));
+    if (match == nullptr || code == 0 || talker == 0) {
+        return NMEA0183RouteDecision::NOT_ROUTED;
+    }
+    route = match;
+    if (!match->enabled) {
+        return NMEA0183RouteDecision::DISABLED;
+    }
+    if (match->minIntervalMs > 0 && match->seen && nowMs - match->lastMs < match->minIntervalMs) {
+        return NMEA0183RouteDecision::RATE_LIMITED;
+    }
+    match->seen = true;
+    match->lastMs = nowMs;
+    return NMEA0183RouteDecision::ROUTED;
+}
+
+NMEA0183Route* NMEA0183RouteTable::find(uint64_t key) {
+    uint8_t low = 0;
+    uint8_t high = count_;
+    while (low < high) {
+        uint8_t mid = static_cast<uint8_t>(low + (high - low) / 2);
+        if (routes_[mid].key < key) {
+            low = static_cast<uint8_t>(mid + 1);
+        } else if (key < routes_[mid].key) {
+            high = mid;
+        } else {
+            return &routes_[mid];
+        }
+    }
+    return nullptr;
+}
@@ -0,0 +1,124 @@
+/**
+ * @file NMEA0183RouteTable.h
+ * @brief Per-port (talker, sentence) routing table for NMEA 0183 input
+ *
+ * Each route maps (input port, talker ID, message code) to a source ID, an
+ * enabled flag and a maximum sentence rate. Routes are loaded at boot from
+ * NMEA0183_ROUTES_FILE (NMEA0183RouteConfig), so a boat with different
+ * instruments needs a file edit instead of a rebuild.
+ *
+ * A port with at least one route only accepts routed sentences: the
+ * NMEA0183Handler reads talker and code from the raw header bytes and asks
+ * check() before the tokenizer scans the line, so unrouted, disabled and
+ * over-rate sentences cost a header lookup instead of a checksum and field
+ * pass. Ports without routes keep the built-in dispatch talkers.
+ *
+ * Storage is a fixed array of NMEA0183_MAX_ROUTES entries sorted by one
+ * 64-bit key (port, code, talker), searched with a binary search.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * NMEA0183RouteTable routes;
+ * routes.add(0, NMEA0183PackCode("HDM"), NMEA0183PackTalker("AP"), "AP-HDG", true, 10.0f);
+ * routes.finalize();
+ *
+ * const NMEA0183Route* route = nullptr;
+ * if (routes.check(0, code, talker, millis(), route) == NMEA0183RouteDecision::ROUTED) { ... }
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef NMEA0183_ROUTE_TABLE_H
+#define NMEA0183_ROUTE_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+/**
+ * @brief One (port, talker, sentence) route
+ */
+struct NMEA0183Route {
+    uint64_t key;            ///< NMEA0183RouteTable::makeKey(port, code, talker)
+    char source[16];         ///< Source ID ("" = port default "<prefix>-<talker>")
+    uint16_t minIntervalMs;  ///< 1000 / max rate (0 = unlimited)
+    bool enabled;
+    bool seen;               ///< lastMs holds a passed sentence
+    uint32_t lastMs;         ///< Last sentence passed by check()
+};
+
+/**
+ * @brief Outcome of NMEA0183RouteTable::check()
+ */
+enum class NMEA0183RouteDecision : uint8_t {
+    PORT_UNROUTED = 0,   ///< Port has no routes: built-in dispatch talkers apply
+    ROUTED,              ///< Pass to the tokenizer and dispatch
+    NOT_ROUTED,          ///< Port is routed, this (talker, sentence) is not
+    DISABLED,            ///< Route exists with enabled = false
+    RATE_LIMITED         ///< Sooner than the route's minimum interval
+};
+
+/**
+ * @class NMEA0183RouteTable
+ * @brief Sorted fixed-capacity route array
+ */
+class NMEA0183RouteTable {
+public:
+    NMEA0183RouteTable();
+
+    /**
+     * @brief Add or replace a route (before finalize())
+     *
+     * @param port Input port index (< 8)
+     * @param code Packed message code (NMEA0183PackCode)
+     * @param talker Packed talker ID (NMEA0183PackTalker)
+     * @param source Source ID (nullptr or "" = port default), truncated to 15 characters
+     * @param enabled false = route known but discarded
+     * @param maxRateHz Sentences per second passed at most (<= 0 = unlimited)
+     * @return false if the key is invalid or NMEA0183_MAX_ROUTES routes exist
+     */
+    bool add(uint8_t port, uint32_t code, uint16_t talker, const char* source, bool enabled,
+             float maxRateHz);
+
+    /**
+     * @brief Sort the routes for lookup (call once after the last add())
+     */
+    void finalize();
+
+    /// Remove all routes
+    void clear();
+
+    /**
+     * @brief Route decision for a sentence header; updates the route's rate state
+     *
+     * @param route Set to the matching route (ROUTED/DISABLED/RATE_LIMITED), else nullptr
+     */
+    NMEA0183RouteDecision check(uint8_t port, uint32_t code, uint16_t talker, uint32_t nowMs,
+                                const NMEA0183Route*& route);
+
+    /// Whether port @p port has any route
+    bool routesPort(uint8_t port) const { return port < 8 && (routedPorts_ & (1u << port)) != 0; }
+
+    uint8_t size() const { return count_; }
+
+    /// Route @p index in key order (nullptr if out of range)
+    const NMEA0183Route* at(uint8_t index) const { return index < count_ ? &routes_[index] : nullptr; }
+
+    static constexpr uint64_t makeKey(uint8_t port, uint32_t code, uint16_t talker) {
+        return (static_cast<uint64_t>(port) << 40) | (static_cast<uint64_t>(code & 0xFFFFFF) << 16) |
+               talker;
+    }
+
+private:
+    NMEA0183Route routes_[NMEA0183_MAX_ROUTES];
+    uint8_t count_;
+    uint8_t routedPorts_;    ///< Bit n = port n has routes
+
+    NMEA0183Route* find(uint64_t key);
+};
+
+#endif // NMEA0183_ROUTE_TABLE_H
@@ -0,0 +1,114 @@
+#ifndef NMEA0183SENTENCEKEY_H
+#define NMEA0183SENTENCEKEY_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file NMEA0183SentenceKey.h
+ * @brief Packed NMEA 0183 message codes/talker IDs and sorted dispatch lookup
+ *
+ * A 3-character message code ("RMC") packs into one uint32_t and a 2-character
+ * talker ID ("VH") into one uint16_t, so sentence dispatch compares integers
+ * instead of strings. Dispatch tables are sorted by packed code (checked at
+ * compile time with NMEA0183IsSortedByCode) and searched with a binary search;
+ * each entry carries its accepted talker set, so one lookup both selects the
+ * handler and rejects sentences from the wrong talker.
+ *
+ * Header-only and Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * struct Entry { uint32_t code; NMEA0183TalkerSet talkers; Handler handler; };
+ * constexpr Entry table[] = {
+ *     {NMEA0183PackCode("GGA"), {{NMEA0183PackTalker("VH")}}, handleGGA},
+ *     {NMEA0183PackCode("RSA"), {{NMEA0183PackTalker("AP")}}, handleRSA},
+ * };
+ * static_assert(NMEA0183IsSortedByCode(table), "table must be sorted by code");
+ *
+ * const Entry* entry = NMEA0183FindByCode(table, NMEA0183PackCode(msg.MessageCode()));
+ * @endcode
+ */
+
+/// Maximum accepted talker IDs per dispatch entry
+#define NMEA0183_MAX_TALKERS 2
+
+/**
+ * @brief Pack a 3-character message code into an integer key
+ *
+ * @param code NUL-terminated message code (e.g., "RMC")
+ * @return Packed key, 0 if code is nullptr or not exactly 3 characters
+ */
+constexpr uint32_t NMEA0183PackCode(const char* code) {
+    return (code == nullptr || code[0] == '\0' || code[1] == '\0' || code[2] == '\0' ||
+            code[3] != '\0')
+        ? 0
+        : (static_cast<uint32_t>(static_cast<uint8_t>(code[0])) << 16) |
+          (static_cast<uint32_t>(static_cast<uint8_t>(code[1])) << 8) |
+          static_cast<uint32_t>(static_cast<uint8_t>(code[2]));
+}
+
+/**
+ * @brief Pack a 2-character talker ID into an integer key
+ *
+ * @param talker NUL-terminated talker ID (e.g., "VH")
+ * @return Packed key, 0 if talker is nullptr or not exactly 2 characters
+ */
+constexpr uint16_t NMEA0183PackTalker(const char* talker) {
+    return (talker == nullptr || talker[0] == '\0' || talker[1] == '\0' || talker[2] != '\0')
+        ? 0
+        : static_cast<uint16_t>((static_cast<uint8_t>(talker[0]) << 8) |
+                                static_cast<uint8_t>(talker[1]));
+}
+
+/**
+ * @brief Accepted talker IDs of one dispatch entry (unused slots are 0)
+ */
+struct NMEA0183TalkerSet {
+    uint16_t talkers[NMEA0183_MAX_TALKERS];
+
+    constexpr bool accepts(uint16_t talker) const {
+        return talker != 0 && (talkers[0] == talker || talkers[1] == talker);
+    }
+};
+
+static_assert(NMEA0183_MAX_TALKERS == 2, "NMEA0183TalkerSet::accepts checks two talkers");
+
+/**
+ * @brief Whether a dispatch table is strictly ascending by packed code
+ *
+ * @tparam Entry Table entry type with a uint32_t `code` member
+ */
+template <typename Entry, size_t N>
+constexpr bool NMEA0183IsSortedByCode(const Entry (&table)[N]) {
+    for (size_t i = 1; i < N; i++) {
+        if (!(table[i - 1].code < table[i].code)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Binary search a sorted dispatch table by packed code
+ *
+ * @return Matching entry, nullptr if the code is not in the table
+ */
+template <typename Entry, size_t N>
+const Entry* NMEA0183FindByCode(const Entry (&table)[N], uint32_t code) {
+    size_t low = 0;
+    size_t high = N;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (table[mid].code < code) {
+            low = mid + 1;
+        } else if (code < table[mid].code) {
+            high = mid;
+        } else {
+            return &table[mid];
+        }
+    }
+    return nullptr;
+}
+
+#endif // NMEA0183SENTENCEKEY_H
@@ -0,0 +1,165 @@
+/**
+ * @file NMEA0183SentenceQueue.h
+ * @brief Bounded queue of whole NMEA 0183 sentences (network task → main loop)
+ *
+ * Network inputs receive sentences in chunks on the AsyncUDP/AsyncTCP task:
+ * a UDP datagram usually carries one or more complete sentences, a TCP
+ * segment may end in the middle of one. The producer side splits chunks at
+ * line ends into whole sentences and queues each as one fixed-size record, so
+ * the parser pops complete lines instead of reading byte by byte.
+ *
+ * A full queue drops the new sentence and counts it (never a partial line);
+ * lines longer than NMEA0183_MAX_LINE are discarded and counted separately.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed record ring, zero heap allocation
+ * - Principle VII (Fail-Safe): overflow drops whole sentences instead of blocking the network task
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef NMEA0183_SENTENCE_QUEUE_H
+#define NMEA0183_SENTENCE_QUEUE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "SPSCQueue.h"
+#include "NMEA0183Tokenizer.h"
+
+/**
+ * @brief One queued sentence (without line end)
+ */
+struct NMEA0183QueuedSentence {
+    uint8_t length;
+    char data[NMEA0183_MAX_LINE];
+};
+
+/**
+ * @class NMEA0183SentenceQueue
+ * @brief Line splitter + SPSC ring of whole sentences
+ *
+ * @tparam Depth Queued sentences (power of two)
+ *
+ * Usage pattern:
+ * @code
+ * // Network task (producer)
+ * queue.feedDatagram(packet.data(), packet.length());    // UDP: datagram end = line end
+ * queue.feed(data, len);                                  // TCP: lines may span segments
+ *
+ * // Main loop (consumer)
+ * char line[NMEA0183_MAX_LINE];
+ * size_t len;
+ * while ((len = queue.pop(line, sizeof(line))) > 0) { ... }
+ * @endcode
+ */
+template <uint32_t Depth>
+class NMEA0183SentenceQueue {
+public:
+    NMEA0183SentenceQueue() : partialLength(0), partialOverflow(false), sentences(0), oversized(0) {}
+
+    /**
+     * @brief Split a chunk of a byte stream into sentences (producer side only)
+     *
+     * A line without its end is kept and continued by the next chunk.
+     */
+    void feed(const char* data, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            char c = data[i];
+            if (c == '\r' || c == '\n') {
+                finishLine();
+            } else if (c == '$' || c == '!') {
+                // Start of sentence - resynchronizes after a lost line end
+                partial.data[0] = c;
+                partialLength = 1;
+                partialOverflow = false;
+            } else if (partialLength > 0) {
+                if (partialLength >= NMEA0183_MAX_LINE) {
+                    partialOverflow = true;
+                } else {
+                    partial.data[partialLength++] = c;
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Queue the sentences of one datagram (producer side only)
+     *
+     * The datagram end also ends a last sentence sent without CR/LF.
+     */
+    void feedDatagram(const char* data, size_t length) {
+        feed(data, length);
+        finishLine();
+    }
+
+    /**
+     * @brief Forget a partial line (producer side, e.g. after a reconnect)
+     */
+    void resetPartial() {
+        partialLength = 0;
+        partialOverflow = false;
+    }
+
+    /**
+     * @brief Pop one sentence (consumer side only)
+     *
+     * @param line Output buffer (not NUL-terminated)
+     * @param size Buffer size; a longer sentence is discarded
+     * @return Sentence length, 0 if the queue is empty
+     */
+    size_t pop(char* line, size_t size) {
+        NMEA0183QueuedSentence sentence;
+        while (queue.pop(sentence)) {
+            if (sentence.length <= size) {
+                for (uint8_t i = 0; i < sentence.length; i++) {
+                    line[i] = sentence.data[i];
+                }
+                return sentence.length;
+            }
+        }
+        return 0;
+    }
+
+    /// Queued sentences
+    uint32_t size() const { return queue.size(); }
+
+    /// Sentences queued since construction
+    uint32_t getSentenceCount() const { return sentences.load(std::memory_order_relaxed); }
+
+    /// Sentences dropped because the queue was full
+    uint32_t getDroppedCount() const { return queue.getDroppedCount(); }
+
+    /// Lines discarded for exceeding NMEA0183_MAX_LINE
+    uint32_t getOversizedCount() const { return oversized.load(std::memory_order_relaxed); }
+
+    /// Deepest queue fill (sentences)
+    uint32_t getHighWater() const { return queue.getHighWater(); }
+
+private:
+    // Producer side only
+    NMEA0183QueuedSentence partial;
+    size_t partialLength;
+    bool partialOverflow;
+
+    SPSCQueue<NMEA0183QueuedSentence, Depth> queue;
+    std::atomic<uint32_t> sentences;
+    std::atomic<uint32_t> oversized;
+
+    void finishLine() {
+        if (partialOverflow) {
+            oversized.fetch_add(1, std::memory_order_relaxed);
+        } else if (partialLength > 0) {
+            partial.length = static_cast<uint8_t>(partialLength);
+            if (queue.push(partial)) {
+                sentences.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        resetPartial();
+    }
+};
+
+#endif // NMEA0183_SENTENCE_QUEUE_H
@@ -0,0 +1,46 @@
+/**
+ * @file NMEA0183StreamBuffer.cpp
+ * @brief Implementation of the shared NMEA 0183 stream ring
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "NMEA0183StreamBuffer.h"
+#include <string.h>
+
+NMEA0183StreamBuffer::NMEA0183StreamBuffer() : writePos(0) {
+}
+
+bool NMEA0183StreamBuffer::append(const char* data, size_t len) {
+    if (data == nullptr || len > CAPACITY) {
+        return false;
+    }
+
+    uint32_t offset = writePos & (CAPACITY - 1);
+    size_t first = CAPACITY - offset;
+    if (first > len) {
+        first = len;
+    }
+    memcpy(ring + offset, data, first);
+    memcpy(ring, data + first, len - first);
+
+    writePos += static_cast<uint32_t>(len);
+    return true;
+}
+
+size_t NMEA0183StreamBuffer::peek(uint32_t& cursor, const char*& data, uint32_t& lostBytes) const {
+    lostBytes = 0;
+    uint32_t pending = writePos - cursor;
+    if (pending > CAPACITY) {
+        // Bytes at the cursor were overwritten - resume from the live end
+        lostBytes = pending;
+        cursor = writePos;
+        pending = 0;
+    }
+
+    uint32_t offset = cursor & (CAPACITY - 1);
+    data = ring + offset;
+    uint32_t contiguous = CAPACITY - offset;
+    return pending < contiguous ? pending : contiguous;
+}
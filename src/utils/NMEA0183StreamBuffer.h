@@ -0,0 +1,89 @@
+/**
+ * @file NMEA0183StreamBuffer.h
+ * @brief Shared byte ring of encoded NMEA 0183 sentences for stream clients
+ *
+ * Sentences are written once; every TCP client only keeps a read cursor into
+ * the ring and sends straight from ring memory, so the fan-out costs no
+ * per-client copy or queue. Positions are free-running 32-bit counters, so
+ * a cursor that fell more than CAPACITY bytes behind is detected exactly and
+ * moved to the live end (the lost bytes are returned for accounting).
+ *
+ * Single context: appends and reads must come from the same task (the main
+ * loop), so no atomics are needed.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): statically sized ring, zero heap allocation
+ * - Principle VII (Fail-Safe): a slow client skips ahead instead of holding back others
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef NMEA0183_STREAM_BUFFER_H
+#define NMEA0183_STREAM_BUFFER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+/**
+ * @class NMEA0183StreamBuffer
+ * @brief Single-producer, multi-cursor byte ring
+ *
+ * Usage pattern:
+ * @code
+ * uint32_t cursor = stream.head();          // new client starts live
+ * stream.append(line, len);                 // producer
+ * const char* data;
+ * size_t n = stream.peek(cursor, data, lost);
+ * size_t sent = client->add(data, n);
+ * stream.consume(cursor, sent);
+ * @endcode
+ */
+class NMEA0183StreamBuffer {
+public:
+    static constexpr uint32_t CAPACITY = N0183_TCP_BUFFER_SIZE;
+
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "N0183_TCP_BUFFER_SIZE must be a power of two");
+
+    NMEA0183StreamBuffer();
+
+    /**
+     * @brief Append one encoded sentence (whole or nothing)
+     * @return false if len exceeds the ring capacity
+     */
+    bool append(const char* data, size_t len);
+
+    /**
+     * @brief Write position - a cursor equal to head() has nothing to read
+     */
+    uint32_t head() const { return writePos; }
+
+    /**
+     * @brief Longest contiguous readable span at a cursor
+     *
+     * A cursor that was overrun is first moved to head().
+     *
+     * @param cursor Client read position (updated on overrun)
+     * @param data Output: start of the span inside the ring
+     * @param lostBytes Output: bytes skipped by an overrun (0 otherwise)
+     * @return Span length (0 = caught up)
+     */
+    size_t peek(uint32_t& cursor, const char*& data, uint32_t& lostBytes) const;
+
+    /**
+     * @brief Advance a cursor past bytes that were handed to the client
+     */
+    static void consume(uint32_t& cursor, size_t bytes) { cursor += static_cast<uint32_t>(bytes); }
+
+    /**
+     * @brief Total bytes ever appended
+     */
+    uint32_t getBytesWritten() const { return writePos; }
+
+private:
+    char ring[CAPACITY];
+    uint32_t writePos;
+};
+
+#endif // NMEA0183_STREAM_BUFFER_H
@@ -0,0 +1,248 @@
+/**
+ * @file NMEA0183Tokenizer.cpp
+ * @brief Implementation of the zero-copy NMEA 0183 tokenizer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "NMEA0183Tokenizer.h"
+#include "HotPath.h"
+
+namespace {
+
+constexpr uint8_t MAX_FRACTION_DIGITS = 9;     // Further fraction digits are ignored
+constexpr uint64_t MAX_MANTISSA = 100000000000000000ULL;  // 1e17, keeps *10 + 9 in range
+
+const uint64_t POW10_INT[MAX_FRACTION_DIGITS + 1] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL
+};
+
+const double POW10[MAX_FRACTION_DIGITS + 1] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9
+};
+
+/**
+ * @brief Decimal field as integer mantissa / 10^scale
+ */
+struct FixedPoint {
+    uint64_t mantissa;
+    uint8_t scale;
+    bool negative;
+    bool point;
+};
+
+bool parseFixed(const NMEA0183Field& field, FixedPoint& out) {
+    out.mantissa = 0;
+    out.scale = 0;
+    out.negative = false;
+    out.point = false;
+
+    uint8_t i = 0;
+    if (field.len > 0 && (field.data[0] == '-' || field.data[0] == '+')) {
+        out.negative = field.data[0] == '-';
+        i = 1;
+    }
+
+    bool digits = false;
+    for (; i < field.len; i++) {
+        char c = field.data[i];
+        if (c >= '0' && c <= '9') {
+            digits = true;
+            if (out.point) {
+                if (out.scale >= MAX_FRACTION_DIGITS) {
+                    continue;
+                }
+                out.scale++;
+            }
+            if (out.mantissa >= MAX_MANTISSA) {
+                return false;  // Not a plausible NMEA value
+            }
+            out.mantissa = out.mantissa * 10 + static_cast<uint64_t>(c - '0');
+        } else if (c == '.' && !out.point) {
+            out.point = true;
+        } else {
+            return false;
+        }
+    }
+    return digits;
+}
+
+uint8_t HOT_PATH_ATTR hexValue(char c) {
+    if (c >= '0' && c <= '9') {
+        return static_cast<uint8_t>(c - '0');
+    }
+    if (c >= 'A' && c <= 'F') {
+        return static_cast<uint8_t>(c - 'A' + 10);
+    }
+    if (c >= 'a' && c <= 'f') {
+        return static_cast<uint8_t>(c - 'a' + 10);
+    }
+    return 0xFF;
+}
+
+}  // namespace
+
+NMEA0183Tokens::NMEA0183Tokens() : line_(nullptr), count_(0), length_(0), talker_(0), code_(0) {
+    start_[0] = 0;
+    end_[0] = 0;
+}
+
+bool HOT_PATH_ATTR NMEA0183Tokens::tokenize(const char* line, size_t len) {
+    line_ = line;
+    count_ = 0;
+    length_ = 0;
+    talker_ = 0;
+    code_ = 0;
+    start_[0] = 0;
+    end_[0] = 0;
+
+    if (line == nullptr) {
+        return false;
+    }
+    while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+        len--;
+    }
+    if (len < 4 || len > NMEA0183_MAX_LINE || (line[0] != '$' && line[0] != '!')) {
+        return false;
+    }
+
+    // Single pass: XOR checksum and field boundaries up to '*'
+    uint8_t checksum = 0;
+    uint8_t current = 0;
+    bool full = false;
+    size_t i = 1;
+    start_[0] = 1;
+    for (; i < len; i++) {
+        char c = line[i];
+        if (c == '*') {
+            break;
+        }
+        checksum ^= static_cast<uint8_t>(c);
+        if (c == ',' && !full) {
+            end_[current] = static_cast<uint8_t>(i);
+            if (current < NMEA0183_MAX_FIELDS) {
+                current++;
+                start_[current] = static_cast<uint8_t>(i + 1);
+            } else {
+                full = true;
+            }
+        }
+    }
+
+    // '*' followed by exactly two hex digits must end the sentence
+    if (i + 3 != len) {
+        return false;
+    }
+    uint8_t high = hexValue(line[i + 1]);
+    uint8_t low = hexValue(line[i + 2]);
+    if (high > 0x0F || low > 0x0F || static_cast<uint8_t>((high << 4) | low) != checksum) {
+        return false;
+    }
+    if (!full) {
+        end_[current] = static_cast<uint8_t>(i);
+    }
+    count_ = current;
+    length_ = static_cast<uint8_t>(len);
+
+    // Standard address: 2-character talker + 3-character sentence code
+    // ('P' starts a proprietary address, e.g. "PGRME", which has no talker)
+    if (end_[0] - start_[0] == 5 && line[start_[0]] != 'P') {
+        const char* a = line + start_[0];
+        talker_ = static_cast<uint16_t>((static_cast<uint8_t>(a[0]) << 8) | static_cast<uint8_t>(a[1]));
+        code_ = (static_cast<uint32_t>(static_cast<uint8_t>(a[2])) << 16) |
+                (static_cast<uint32_t>(static_cast<uint8_t>(a[3])) << 8) |
+                static_cast<uint32_t>(static_cast<uint8_t>(a[4]));
+    }
+    return true;
+}
+
+NMEA0183Field HOT_PATH_ATTR NMEA0183Tokens::address() const {
+    NMEA0183Field field = {line_ != nullptr ? line_ + start_[0] : "",
+                           static_cast<uint8_t>(end_[0] - start_[0])};
+    return field;
+}
+
+NMEA0183Field HOT_PATH_ATTR NMEA0183Tokens::field(uint8_t index) const {
+    if (index >= count_) {
+        NMEA0183Field none = {"", 0};
+        return none;
+    }
+    uint8_t slot = static_cast<uint8_t>(index + 1);
+    NMEA0183Field field = {line_ + start_[slot], static_cast<uint8_t>(end_[slot] - start_[slot])};
+    return field;
+}
+
+bool NMEA0183FieldToDouble(const NMEA0183Field& field, double& value) {
+    FixedPoint fixed;
+    if (!parseFixed(field, fixed)) {
+        return false;
+    }
+    double result = static_cast<double>(fixed.mantissa) / POW10[fixed.scale];
+    value = fixed.negative ? -result : result;
+    return true;
+}
+
+bool NMEA0183FieldToInt(const NMEA0183Field& field, int32_t& value) {
+    FixedPoint fixed;
+    if (!parseFixed(field, fixed) || fixed.point || fixed.mantissa > 2147483647ULL) {
+        return false;
+    }
+    int32_t result = static_cast<int32_t>(fixed.mantissa);
+    value = fixed.negative ? -result : result;
+    return true;
+}
+
+bool NMEA0183FieldToCoordinate(const NMEA0183Field& value, const NMEA0183Field& hemisphere,
+                               double& degrees) {
+    bool negative;
+    if (hemisphere.is('N') || hemisphere.is('E')) {
+        negative = false;
+    } else if (hemisphere.is('S') || hemisphere.is('W')) {
+        negative = true;
+    } else {
+        return false;
+    }
+
+    FixedPoint fixed;
+    if (!parseFixed(value, fixed) || fixed.negative) {
+        return false;
+    }
+
+    // ddmm.mmmm: split whole degrees from minutes in integer arithmetic
+    uint64_t unit = POW10_INT[fixed.scale];
+    uint64_t wholeDegrees = fixed.mantissa / (100 * unit);
+    uint64_t minutesFixed = fixed.mantissa - wholeDegrees * 100 * unit;
+    double minutes = static_cast<double>(minutesFixed) / POW10[fixed.scale];
+    if (minutes >= 60.0) {
+        return false;
+    }
+
+    double result = static_cast<double>(wholeDegrees) + minutes / 60.0;
+    degrees = negative ? -result : result;
+    return true;
+}
+
+bool NMEA0183FieldToTime(const NMEA0183Field& field, uint32_t& centiseconds) {
+    FixedPoint fixed;
+    if (!parseFixed(field, fixed) || fixed.negative) {
+        return false;
+    }
+
+    // Whole seconds as hhmmss, fraction reduced to hundredths
+    uint64_t unit = POW10_INT[fixed.scale];
+    uint64_t whole = fixed.mantissa / unit;
+    uint64_t fraction = fixed.mantissa - whole * unit;
+    uint32_t hundredths = static_cast<uint32_t>(fixed.scale >= 2 ? fraction / (unit / 100)
+                                                                 : fraction * (100 / unit));
+    uint32_t hours = static_cast<uint32_t>(whole / 10000);
+    uint32_t minutes = static_cast<uint32_t>((whole / 100) % 100);
+    uint32_t seconds = static_cast<uint32_t>(whole % 100);
+    if (hours >= 24 || minutes >= 60 || seconds >= 60) {
+        return false;
+    }
+
+    centiseconds = ((hours * 60 + minutes) * 60 + seconds) * 100 + hundredths;
+    return true;
+}
@@ -0,0 +1,142 @@
+#ifndef NMEA0183TOKENIZER_H
+#define NMEA0183TOKENIZER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * @file NMEA0183Tokenizer.h
+ * @brief Zero-copy NMEA 0183 sentence tokenizer and fixed-point field parsers
+ *
+ * NMEA0183Tokens validates the checksum and records the offset of every field
+ * in one pass over the raw line, without copying the sentence or its fields.
+ * Fields are returned as views (pointer + length) into the caller's line
+ * buffer, which must stay unchanged while the tokens are used.
+ *
+ * Numeric fields are read with a fixed-point decimal parser (integer mantissa
+ * plus decimal scale) instead of atof()/strtod(): no locale, exponent or
+ * NaN/Inf handling, and a field that is not a plain decimal number is
+ * rejected instead of silently reading as 0.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * NMEA0183Tokens tokens;
+ * if (tokens.tokenize(line, len) && tokens.code() == NMEA0183PackCode("HDM")) {
+ *     double heading;
+ *     if (NMEA0183FieldToDouble(tokens.field(0), heading)) { ... }
+ * }
+ * @endcode
+ */
+
+/// Data fields recorded per sentence (GGA has 14, GSV 19); extra fields are ignored
+#define NMEA0183_MAX_FIELDS 24
+
+/// Longest line accepted by the tokenizer (NMEA 0183 maximum is 82 characters)
+#define NMEA0183_MAX_LINE 128
+
+/**
+ * @brief View of one sentence field (not NUL-terminated)
+ */
+struct NMEA0183Field {
+    const char* data;
+    uint8_t len;
+
+    bool empty() const { return len == 0; }
+
+    /// First character, '\0' for an empty field
+    char first() const { return len > 0 ? data[0] : '\0'; }
+
+    /// Whether the field is exactly the single character @p c
+    bool is(char c) const { return len == 1 && data[0] == c; }
+};
+
+/**
+ * @class NMEA0183Tokens
+ * @brief Field offsets of one checksum-validated sentence
+ */
+class NMEA0183Tokens {
+public:
+    NMEA0183Tokens();
+
+    /**
+     * @brief Validate and split one sentence in a single pass
+     *
+     * Accepts "$<address>,<field>,...*<hh>" with optional trailing CR/LF.
+     * The checksum is mandatory.
+     *
+     * @param line Raw sentence (need not be NUL-terminated)
+     * @param len Sentence length in bytes
+     * @return false if framing or checksum is invalid, or the line exceeds NMEA0183_MAX_LINE
+     */
+    bool tokenize(const char* line, size_t len);
+
+    /// Packed 2-character talker ID (NMEA0183PackTalker layout), 0 for proprietary/other addresses
+    uint16_t talker() const { return talker_; }
+
+    /// Packed 3-character message code (NMEA0183PackCode layout), 0 for proprietary/other addresses
+    uint32_t code() const { return code_; }
+
+    /// Address field without '$' (e.g. "VHRMC")
+    NMEA0183Field address() const;
+
+    /// Number of data fields after the address
+    uint8_t fieldCount() const { return count_; }
+
+    /// Sentence length without line end ("$" to checksum), 0 if tokenize() failed
+    uint8_t length() const { return length_; }
+
+    /**
+     * @brief Data field @p index (0 = first field after the address)
+     * @return Empty view if index >= fieldCount()
+     */
+    NMEA0183Field field(uint8_t index) const;
+
+private:
+    const char* line_;
+    uint8_t start_[NMEA0183_MAX_FIELDS + 1];  ///< Offset of the address and each data field
+    uint8_t end_[NMEA0183_MAX_FIELDS + 1];    ///< Offset one past the last character
+    uint8_t count_;
+    uint8_t length_;
+    uint16_t talker_;
+    uint32_t code_;
+};
+
+/**
+ * @brief Parse a decimal field ("-12.345") with the fixed-point parser
+ *
+ * @param field Field view
+ * @param value Output: parsed value (unchanged on failure)
+ * @return false if the field is empty or not a plain decimal number
+ */
+bool NMEA0183FieldToDouble(const NMEA0183Field& field, double& value);
+
+/**
+ * @brief Parse an integer field ("08")
+ *
+ * @return false if the field is empty, signed-invalid or has a fraction
+ */
+bool NMEA0183FieldToInt(const NMEA0183Field& field, int32_t& value);
+
+/**
+ * @brief Parse a (d)ddmm.mmmm coordinate with its hemisphere field
+ *
+ * @param value Coordinate field (e.g., "5230.5000")
+ * @param hemisphere 'N'/'S' or 'E'/'W' field; S and W give negative degrees
+ * @param degrees Output: decimal degrees (unchanged on failure)
+ * @return false if either field is empty or invalid, or minutes >= 60
+ */
+bool NMEA0183FieldToCoordinate(const NMEA0183Field& value, const NMEA0183Field& hemisphere,
+                               double& degrees);
+
+/**
+ * @brief Parse a hhmmss(.ss) UTC time field
+ *
+ * @param field Time field (e.g., "123519.50")
+ * @param centiseconds Output: hundredths of a second since midnight (unchanged on failure)
+ * @return false if the field is empty, invalid or out of range (hh >= 24, mm/ss >= 60)
+ */
+bool NMEA0183FieldToTime(const NMEA0183Field& field, uint32_t& centiseconds);
+
+#endif // NMEA0183TOKENIZER_H
@@ -0,0 +1,89 @@
+/**
+ * @file OledDirtyRegion.cpp
+ * @brief Implementation of the per-page dirty column spans
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "OledDirtyRegion.h"
+
+OledDirtyRegion::OledDirtyRegion() {
+    clear();
+}
+
+void OledDirtyRegion::markAll() {
+    for (uint8_t page = 0; page < PAGES; page++) {
+        first_[page] = 0;
+        last_[page] = COLUMNS - 1;
+    }
+}
+
+void OledDirtyRegion::markRect(int16_t x, int16_t y, int16_t width, int16_t height) {
+    int16_t x0 = x < 0 ? 0 : x;
+    int16_t y0 = y < 0 ? 0 : y;
+    int16_t x1 = x + width - 1;
+    int16_t y1 = y + height - 1;
+    if (x1 >= COLUMNS) {
+        x1 = COLUMNS - 1;
+    }
+    if (y1 >= PAGES * 8) {
+        y1 = PAGES * 8 - 1;
+    }
+    if (width <= 0 || height <= 0 || x0 > x1 || y0 > y1) {
+        return;
+    }
+
+    for (uint8_t page = static_cast<uint8_t>(y0 / 8); page <= y1 / 8; page++) {
+        if (first_[page] == COLUMNS) {
+            first_[page] = static_cast<uint8_t>(x0);
+            last_[page] = static_cast<uint8_t>(x1);
+            continue;
+        }
+        if (x0 < first_[page]) {
+            first_[page] = static_cast<uint8_t>(x0);
+        }
+        if (x1 > last_[page]) {
+            last_[page] = static_cast<uint8_t>(x1);
+        }
+    }
+}
+
+bool OledDirtyRegion::span(uint8_t page, uint8_t& first, uint8_t& last) const {
+    if (page >= PAGES || first_[page] == COLUMNS) {
+        return false;
+    }
+    first = first_[page];
+    last = last_[page];
+    return true;
+}
+
+bool OledDirtyRegion::isDirty() const {
+    for (uint8_t page = 0; page < PAGES; page++) {
+        if (first_[page] != COLUMNS) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool OledDirtyRegion::isFull() const {
+    return dirtyBytes() == static_cast<size_t>(PAGES) * COLUMNS;
+}
+
+size_t OledDirtyRegion::dirtyBytes() const {
+    size_t bytes = 0;
+    for (uint8_t page = 0; page < PAGES; page++) {
+        if (first_[page] != COLUMNS) {
+            bytes += last_[page] - first_[page] + 1;
+        }
+    }
+    return bytes;
+}
+
+void OledDirtyRegion::clear() {
+    for (uint8_t page = 0; page < PAGES; page++) {
+        first_[page] = COLUMNS;
+        last_[page] = 0;
+    }
+}
@@ -0,0 +1,86 @@
+/**
+ * @file OledDirtyRegion.h
+ * @brief Changed columns per SSD1306 page since the last display()
+ *
+ * The SSD1306 RAM is organized in pages of 8 pixel rows; one byte is one
+ * column of a page. The display adapter marks the rectangle of every
+ * drawing call here and display() sends each page's dirty column span
+ * with page/column addressing instead of the whole 1 KB framebuffer. A 1 s
+ * animation icon tick (one character across two pages) becomes 12 data
+ * bytes; clear() marks everything and is sent as a full frame.
+ *
+ * One span per page (first to last dirty column): two separate changes on
+ * the same page send the columns between them as well, which costs less
+ * than a second addressing command for short gaps.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * region.markRect(118, 50, 6, 8);   // Icon drawn
+ * uint8_t first, last;
+ * for (uint8_t page = 0; page < OledDirtyRegion::PAGES; page++) {
+ *     if (region.span(page, first, last)) { ... send buffer[page * 128 + first .. last] ... }
+ * }
+ * region.clear();
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): 16 bytes of state, fewer I2C bytes per refresh
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef OLED_DIRTY_REGION_H
+#define OLED_DIRTY_REGION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+/**
+ * @class OledDirtyRegion
+ * @brief Dirty column span of each display page
+ */
+class OledDirtyRegion {
+public:
+    static constexpr uint8_t PAGES = OLED_SCREEN_HEIGHT / 8;
+    static constexpr uint8_t COLUMNS = OLED_SCREEN_WIDTH;
+
+    /// Initially clean
+    OledDirtyRegion();
+
+    /// Everything changed (clear(), init)
+    void markAll();
+
+    /**
+     * @brief The pixels of a rectangle changed
+     *
+     * Clipped to the screen; an empty or off-screen rectangle marks nothing.
+     */
+    void markRect(int16_t x, int16_t y, int16_t width, int16_t height);
+
+    /**
+     * @brief Dirty columns of @p page
+     * @return false if the page is clean
+     */
+    bool span(uint8_t page, uint8_t& first, uint8_t& last) const;
+
+    bool isDirty() const;
+
+    /// Every byte of the framebuffer is dirty (send it in one transfer)
+    bool isFull() const;
+
+    /// Framebuffer bytes the dirty spans cover
+    size_t dirtyBytes() const;
+
+    /// Sent: all pages clean
+    void clear();
+
+private:
+    uint8_t first_[PAGES];   ///< COLUMNS = clean page
+    uint8_t last_[PAGES];
+};
+
+#endif // OLED_DIRTY_REGION_H
@@ -0,0 +1,434 @@
+/**
+ * @file OneWireConversion.cpp
+ * @brief Implementation of the stepped DS2438 conversion and read cycle
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "OneWireConversion.h"
+#include <string.h>
+
+namespace {
+
+// 1-Wire ROM and DS2438 function commands
+constexpr uint8_t CMD_SKIP_ROM = 0xCC;
+constexpr uint8_t CMD_MATCH_ROM = 0x55;
+constexpr uint8_t CMD_CONVERT_V = 0xB4;
+constexpr uint8_t CMD_RECALL_MEMORY = 0xB8;
+constexpr uint8_t CMD_READ_SCRATCHPAD = 0xBE;
+
+// Standard-speed timings until the first measurement (reset 480 + 480 us, 8 slots of ~65 us)
+constexpr uint32_t DEFAULT_COST_US[] = {960, 520, 520};
+
+}  // namespace
+
+const char* OneWireDeviceName(OneWireDevice device) {
+    switch (device) {
+        case OneWireDevice::SAILDRIVE: return "saildrive";
+        case OneWireDevice::BATTERY_A: return "battery_a";
+        case OneWireDevice::BATTERY_B: return "battery_b";
+        case OneWireDevice::SHORE_POWER: return "shore_power";
+        default: return "unknown";
+    }
+}
+
+uint32_t OneWireDefaultPeriodMs(OneWireDevice device) {
+    switch (device) {
+        case OneWireDevice::SAILDRIVE: return ONEWIRE_SAILDRIVE_PERIOD_MS;
+        case OneWireDevice::BATTERY_A:
+        case OneWireDevice::BATTERY_B: return ONEWIRE_BATTERY_PERIOD_MS;
+        case OneWireDevice::SHORE_POWER: return ONEWIRE_SHORE_PERIOD_MS;
+        default: return ONEWIRE_CYCLE_MS;
+    }
+}
+
+uint8_t OneWireCrc8(const uint8_t* data, uint8_t length) {
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < length; i++) {
+        uint8_t byte = data[i];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            uint8_t mix = (crc ^ byte) & 0x01;
+            crc >>= 1;
+            if (mix) {
+                crc ^= 0x8C;
+            }
+            byte >>= 1;
+        }
+    }
+    return crc;
+}
+
+DS2438Reading DS2438Decode(const uint8_t* page) {
+    DS2438Reading reading;
+    reading.temperatureC = static_cast<int16_t>((page[2] << 8) | page[1]) / 256.0f;
+    reading.voltage = (((page[4] & 0x03) << 8) | page[3]) * 0.01f;
+    reading.currentRaw = static_cast<int16_t>((page[6] << 8) | page[5]);
+    return reading;
+}
+
+bool DS2438DigitalState(const DS2438Reading& reading) {
+    return reading.voltage >= ONEWIRE_DIGITAL_ON_V;
+}
+
+double DS2438Current(const DS2438Reading& reading) {
+    return reading.currentRaw / (4096.0 * ONEWIRE_SHUNT_OHMS);
+}
+
+void DS2438ToBattery(const DS2438Reading& reading, BatteryMonitorData& data) {
+    data.voltage = reading.voltage * ONEWIRE_BATTERY_DIVIDER;
+    data.amperage = DS2438Current(reading);
+    double soc = (data.voltage - ONEWIRE_SOC_EMPTY_V) / (ONEWIRE_SOC_FULL_V - ONEWIRE_SOC_EMPTY_V) * 100.0;
+    data.stateOfCharge = soc < 0 ? 0 : (soc > 100 ? 100 : soc);
+    data.shoreChargerOn = false;
+    data.engineChargerOn = false;
+    data.available = true;
+}
+
+void DS2438ToShorePower(const DS2438Reading& reading, ShorePowerData& data) {
+    data.shorePowerOn = DS2438DigitalState(reading);
+    double amps = DS2438Current(reading);
+    data.power = data.shorePowerOn ? (amps < 0 ? -amps : amps) * ONEWIRE_SHORE_VOLTAGE_V : 0.0;
+    data.available = true;
+}
+
+OneWireConversion::OneWireConversion(IOneWireBus* bus, MicrosClock clock)
+    : bus_(bus),
+      clock_(clock),
+      present_(0),
+      phase_(Phase::IDLE),
+      opCount_(0),
+      opIndex_(0),
+      aborted_(false),
+      rxCount_(0),
+      started_(false),
+      cycleStartMs_(0),
+      convertedMs_(0),
+      pendingDevices_(0),
+      readingDevices_(0),
+      cycleDevices_(0),
+      device_(0),
+      retried_(false),
+      slot_(0),
+      cycles_(0),
+      lastOkMs_(0),
+      everOk_(false),
+      transactions_(0),
+      crcErrors_(0),
+      maxStepUs_(0),
+      busyUs_(0),
+      statsStartMs_(0),
+      resetRequested_(false) {
+    memset(roms_, 0, sizeof(roms_));
+    memset(results_, 0, sizeof(results_));
+    memset(deviceStats_, 0, sizeof(deviceStats_));
+    memset(consecutiveFailures_, 0, sizeof(consecutiveFailures_));
+    for (uint8_t i = 0; i < static_cast<uint8_t>(OneWireDevice::COUNT); i++) {
+        setDevicePeriod(i, OneWireDefaultPeriodMs(static_cast<OneWireDevice>(i)));
+    }
+    memset(ops_, 0, sizeof(ops_));
+    memset(rx_, 0, sizeof(rx_));
+    for (uint8_t kind = 0; kind < OP_KINDS; kind++) {
+        opCostUs_[kind] = DEFAULT_COST_US[kind];
+    }
+}
+
+void OneWireConversion::setDevice(OneWireDevice device, const uint8_t rom[8], uint32_t periodMs) {
+    uint8_t index = static_cast<uint8_t>(device);
+    if (index >= static_cast<uint8_t>(OneWireDevice::COUNT) || rom == nullptr) {
+        return;
+    }
+    memcpy(roms_[index], rom, 8);
+    present_ |= static_cast<uint8_t>(1u << index);
+    consecutiveFailures_[index] = 0;
+    setDevicePeriod(index, periodMs != 0 ? periodMs : OneWireDefaultPeriodMs(device));
+}
+
+void OneWireConversion::setDevicePeriod(uint8_t index, uint32_t periodMs) {
+    uint32_t slots = (periodMs + ONEWIRE_CYCLE_MS / 2) / ONEWIRE_CYCLE_MS;
+    periodSlots_[index] = static_cast<uint8_t>(slots < 1 ? 1 : (slots > 255 ? 255 : slots));
+}
+
+bool OneWireConversion::hasDevice(OneWireDevice device) const {
+    return (present_ >> static_cast<uint8_t>(device)) & 1;
+}
+
+const OneWireResult& OneWireConversion::getResult(OneWireDevice device) const {
+    uint8_t index = static_cast<uint8_t>(device);
+    return results_[index < static_cast<uint8_t>(OneWireDevice::COUNT) ? index : 0];
+}
+
+uint8_t OneWireConversion::getConsecutiveFailures(OneWireDevice device) const {
+    uint8_t index = static_cast<uint8_t>(device);
+    return index < static_cast<uint8_t>(OneWireDevice::COUNT) ? consecutiveFailures_[index] : 0;
+}
+
+const OneWireDeviceStats& OneWireConversion::getDeviceStats(OneWireDevice device) const {
+    uint8_t index = static_cast<uint8_t>(device);
+    return deviceStats_[index < static_cast<uint8_t>(OneWireDevice::COUNT) ? index : 0];
+}
+
+double OneWireConversion::getUtilization(uint32_t nowMs) const {
+    uint32_t wallMs = nowMs - statsStartMs_;
+    return wallMs == 0 ? 0.0 : busyUs_ / (wallMs * 10.0);
+}
+
+bool OneWireConversion::isHealthy(uint32_t nowMs) const {
+    if (!everOk_ || nowMs - lastOkMs_ > ONEWIRE_HEALTH_TIMEOUT_MS) {
+        return false;
+    }
+    return crcErrors_ * 100u <= transactions_ * static_cast<uint32_t>(ONEWIRE_HEALTH_MAX_CRC_PERCENT);
+}
+
+bool OneWireConversion::writeStats(JsonWriter& json, uint32_t nowMs) const {
+    json.beginObject()
+        .add("cycles", (unsigned long)cycles_)
+        .add("transactions", (unsigned long)transactions_)
+        .add("utilization_pct", getUtilization(nowMs), 1)
+        .add("crc_errors", (unsigned long)crcErrors_)
+        .add("crc_error_pct", transactions_ == 0 ? 0.0 : crcErrors_ * 100.0 / transactions_, 1)
+        .add("max_step_us", (unsigned long)maxStepUs_)
+        .add("healthy", isHealthy(nowMs))
+        .beginArray("devices");
+    for (uint8_t i = 0; i < static_cast<uint8_t>(OneWireDevice::COUNT); i++) {
+        if (((present_ >> i) & 1) == 0) {
+            continue;
+        }
+        const OneWireDeviceStats& stats = deviceStats_[i];
+        json.beginObject()
+            .add("name", OneWireDeviceName(static_cast<OneWireDevice>(i)))
+            .add("period_ms", (unsigned long)(periodSlots_[i] * ONEWIRE_CYCLE_MS))
+            .add("reads", (unsigned long)stats.reads)
+            .add("failures", (unsigned long)stats.failures)
+            .add("crc_errors", (unsigned long)stats.crcErrors)
+            .add("latency_ms", (unsigned long)stats.lastLatencyMs)
+            .add("max_latency_ms", (unsigned long)stats.maxLatencyMs)
+            .endObject();
+    }
+    json.endArray().endObject();
+    return !json.overflowed();
+}
+
+void OneWireConversion::clearStats(uint32_t nowMs) {
+    memset(deviceStats_, 0, sizeof(deviceStats_));
+    transactions_ = 0;
+    crcErrors_ = 0;
+    maxStepUs_ = 0;
+    busyUs_ = 0;
+    statsStartMs_ = nowMs;
+}
+
+void OneWireConversion::push(OpKind kind, uint8_t value) {
+    if (opCount_ < MAX_OPS) {
+        ops_[opCount_].kind = kind;
+        ops_[opCount_].value = value;
+        opCount_++;
+    }
+}
+
+void OneWireConversion::buildConvert() {
+    opCount_ = 0;
+    opIndex_ = 0;
+    aborted_ = false;
+    push(OP_RESET);
+    push(OP_WRITE, CMD_SKIP_ROM);
+    push(OP_WRITE, CMD_CONVERT_V);
+}
+
+void OneWireConversion::buildSelect(uint8_t command) {
+    opCount_ = 0;
+    opIndex_ = 0;
+    aborted_ = false;
+    rxCount_ = 0;
+    push(OP_RESET);
+    push(OP_WRITE, CMD_MATCH_ROM);
+    for (uint8_t i = 0; i < 8; i++) {
+        push(OP_WRITE, roms_[device_][i]);
+    }
+    push(OP_WRITE, command);
+    push(OP_WRITE, 0x00);  // Page 0: status, temperature, voltage, current
+}
+
+void OneWireConversion::buildRead() {
+    buildSelect(CMD_READ_SCRATCHPAD);
+    for (uint8_t i = 0; i < PAGE_BYTES; i++) {
+        push(OP_READ);
+    }
+}
+
+bool OneWireConversion::step(uint32_t nowMs) {
+    if (!started_ || resetRequested_.exchange(false, std::memory_order_relaxed)) {
+        clearStats(nowMs);
+    }
+    if (phase_ == Phase::IDLE) {
+        if (started_ && nowMs - cycleStartMs_ < ONEWIRE_CYCLE_MS) {
+            return false;
+        }
+        // Next schedule slot: the devices whose period is due
+        started_ = true;
+        cycleStartMs_ = nowMs;
+        readingDevices_ = 0;
+        for (uint8_t i = 0; i < static_cast<uint8_t>(OneWireDevice::COUNT); i++) {
+            if (slot_ % periodSlots_[i] == 0) {
+                readingDevices_ |= static_cast<uint8_t>(1u << i);
+            }
+        }
+        slot_++;
+        if (readingDevices_ == 0) {
+            return false;  // Nothing due: no convert either
+        }
+        pendingDevices_ = readingDevices_;
+        buildConvert();
+        phase_ = Phase::CONVERT;
+    }
+    if (phase_ == Phase::WAIT) {
+        if (nowMs - convertedMs_ < ONEWIRE_CONVERSION_MS) {
+            return false;  // Converting: no bus traffic
+        }
+        if (!nextDevice()) {
+            return finishPhase(nowMs);
+        }
+    }
+
+    // Operations of the phase until the next one would exceed the budget
+    uint32_t start = clock_();
+    uint32_t elapsed = 0;
+    bool completed = false;
+    while (!completed) {
+        if (opIndex_ >= opCount_ || aborted_) {
+            completed = finishPhase(nowMs);
+            if (phase_ == Phase::IDLE || phase_ == Phase::WAIT) {
+                break;  // Cycle done, or the devices are converting
+            }
+            continue;
+        }
+        const Op& op = ops_[opIndex_];
+        if (elapsed > 0 && elapsed + opCostUs_[op.kind] > ONEWIRE_STEP_BUDGET_US) {
+            break;  // Next tick
+        }
+
+        uint32_t opStart = clock_();
+        if (bus_ == nullptr) {
+            aborted_ = true;
+        } else if (op.kind == OP_RESET) {
+            aborted_ = !bus_->reset();
+        } else if (op.kind == OP_WRITE) {
+            bus_->write(op.value);
+        } else if (rxCount_ < PAGE_BYTES) {
+            rx_[rxCount_++] = bus_->read();
+        }
+        opCostUs_[op.kind] = clock_() - opStart;
+        busyUs_ += opCostUs_[op.kind];
+        opIndex_++;
+        elapsed = clock_() - start;
+        if (elapsed == 0) {
+            elapsed = 1;  // Ran one: the budget applies to the next
+        }
+    }
+
+    if (elapsed > maxStepUs_) {
+        maxStepUs_ = elapsed;
+    }
+    return completed;
+}
+
+bool OneWireConversion::finishPhase(uint32_t nowMs) {
+    switch (phase_) {
+        case Phase::CONVERT:
+            if (aborted_) {
+                // Nobody on the bus: every reading of the cycle fails
+                while (nextDevice()) {
+                    fail(device_);
+                }
+                break;
+            }
+            convertedMs_ = nowMs;
+            phase_ = Phase::WAIT;
+            return false;
+
+        case Phase::RECALL:
+            if (aborted_) {
+                fail(device_);
+                if (nextDevice()) {
+                    return false;
+                }
+                break;
+            }
+            buildRead();
+            phase_ = Phase::READ;
+            return false;
+
+        case Phase::READ: {
+            uint8_t index = device_;
+            bool valid = !aborted_ && rxCount_ == PAGE_BYTES &&
+                         OneWireCrc8(rx_, PAGE_BYTES - 1) == rx_[PAGE_BYTES - 1];
+            if (!valid && !aborted_) {
+                crcErrors_++;
+                deviceStats_[index].crcErrors++;
+                if (!retried_) {
+                    retried_ = true;
+                    buildRead();  // The scratchpad still holds the recalled page
+                    return false;
+                }
+            }
+            if (valid) {
+                results_[index].ok = true;
+                results_[index].reading = DS2438Decode(rx_);
+                OneWireDeviceStats& stats = deviceStats_[index];
+                stats.lastLatencyMs = nowMs - cycleStartMs_;
+                if (stats.lastLatencyMs > stats.maxLatencyMs) {
+                    stats.maxLatencyMs = stats.lastLatencyMs;
+                }
+                lastOkMs_ = nowMs;
+                everOk_ = true;
+                consecutiveFailures_[index] = 0;
+            } else {
+                fail(index);
+            }
+            if (nextDevice()) {
+                return false;
+            }
+            break;
+        }
+
+        case Phase::WAIT:
+        case Phase::IDLE:
+            break;
+    }
+
+    // Cycle complete
+    phase_ = Phase::IDLE;
+    cycleDevices_ = readingDevices_;
+    cycles_++;
+    return true;
+}
+
+bool OneWireConversion::nextDevice() {
+    while (pendingDevices_ != 0) {
+        uint8_t index = 0;
+        while (((pendingDevices_ >> index) & 1) == 0) {
+            index++;
+        }
+        pendingDevices_ &= static_cast<uint8_t>(~(1u << index));
+        device_ = index;
+        deviceStats_[index].reads++;
+        transactions_++;
+        if (((present_ >> index) & 1) == 0) {
+            fail(index);  // Not found at enumeration
+            continue;
+        }
+        retried_ = false;
+        buildSelect(CMD_RECALL_MEMORY);
+        phase_ = Phase::RECALL;
+        return true;
+    }
+    return false;
+}
+
+void OneWireConversion::fail(uint8_t device) {
+    results_[device].ok = false;
+    deviceStats_[device].failures++;
+    if (consecutiveFailures_[device] < 255) {
+        consecutiveFailures_[device]++;
+    }
+}
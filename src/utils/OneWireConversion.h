@@ -0,0 +1,286 @@
+/**
+ * @file OneWireConversion.h
+ * @brief Non-blocking DS2438 conversion and read cycle for the 1-Wire sensors
+ *
+ * A DS2438 only reports fresh values after a conversion (up to 10 ms for
+ * the A/D, longer for a DS18B20 on the same bus), and reading one device
+ * is two transactions of some 30 bytes. Done inline, a read cycle blocks
+ * the caller for tens of milliseconds. This state machine spreads it over
+ * many short steps:
+ *
+ * | Phase | Bus traffic |
+ * |-------|-------------|
+ * | CONVERT | reset, Skip ROM (0xCC), Convert V (0xB4): every device converts at once |
+ * | WAIT | none until ONEWIRE_CONVERSION_MS has passed; the caller keeps running |
+ * | RECALL | per device: reset, Match ROM (0x55) + ROM, Recall Memory page 0 (0xB8 0x00) |
+ * | READ | reset, Match ROM + ROM, Read Scratchpad page 0 (0xBE 0x00), 9 bytes; CRC8, one retry |
+ *
+ * step() runs reset/write/read operations until the next one would exceed
+ * ONEWIRE_STEP_BUDGET_US. The cost of each kind of operation is the last
+ * one measured (datasheet timings before the first), and a step always
+ * runs at least one operation. A step therefore holds the bus and the CPU
+ * for about 1 ms, whatever the phase.
+ *
+ * The whole bus runs on one repeating schedule. A cycle starts every
+ * ONEWIRE_CYCLE_MS (the schedule slot) and reads the devices whose period
+ * is due in that slot: every device has its own period (ONEWIRE_*_PERIOD_MS,
+ * a multiple of the slot), so the saildrive is read every cycle and the
+ * batteries and shore power every other one. A slot with no device due
+ * sends nothing, not even the convert. A device that was not found, or
+ * that fails twice, is reported as a failed read.
+ *
+ * Bus statistics (writeStats(), ONEWIRE_STATS): utilization (bus time per
+ * wall time), transactions and CRC-error rate, and per device the reads,
+ * failures and latency from the convert to its valid page. isHealthy()
+ * backs IOneWireSensors::isBusHealthy() without touching the bus.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * conversion.setDevice(OneWireDevice::BATTERY_A, rom);
+ * // Every I/O pump tick:
+ * if (conversion.step(millis())) {
+ *     uint8_t read = conversion.getCycleDevices();
+ *     ... conversion.getResult(OneWireDevice::BATTERY_A) ...
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed operation list, results and statistics, no heap
+ * - Principle VII (Fail-Safe): a missing device or bad CRC fails only that reading
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ONEWIRE_CONVERSION_H
+#define ONEWIRE_CONVERSION_H
+
+#include <stdint.h>
+#include <atomic>
+#include "IoPump.h"
+#include "JsonWriter.h"
+#include "../config.h"
+#include "../hal/interfaces/IOneWireBus.h"
+#include "../hal/interfaces/IOneWireSensors.h"
+
+/**
+ * @brief Sensors on the bus, in read order
+ */
+enum class OneWireDevice : uint8_t {
+    SAILDRIVE = 0,
+    BATTERY_A,
+    BATTERY_B,
+    SHORE_POWER,
+    COUNT
+};
+
+/**
+ * @brief Decoded DS2438 page 0
+ */
+struct DS2438Reading {
+    float temperatureC;
+    float voltage;        ///< VAD input, volts (10 mV resolution)
+    int16_t currentRaw;   ///< Current register (sign-extended)
+};
+
+/**
+ * @brief Latest read of a device
+ */
+struct OneWireResult {
+    bool ok;              ///< Present and CRC valid
+    DS2438Reading reading;
+};
+
+/// Name in ONEWIRE_STATS ("saildrive", "battery_a", "battery_b", "shore_power")
+const char* OneWireDeviceName(OneWireDevice device);
+
+/// Schedule period of @p device (ONEWIRE_SAILDRIVE/BATTERY/SHORE_PERIOD_MS)
+uint32_t OneWireDefaultPeriodMs(OneWireDevice device);
+
+/**
+ * @brief Per-device counters since the last statistics reset
+ */
+struct OneWireDeviceStats {
+    uint32_t reads;           ///< Scheduled reads
+    uint32_t failures;        ///< Absent, no presence, or CRC bad twice
+    uint32_t crcErrors;
+    uint32_t lastLatencyMs;   ///< Convert issued to valid page, last good read
+    uint32_t maxLatencyMs;
+};
+
+/// Dallas/Maxim CRC8 (polynomial x^8 + x^5 + x^4 + 1)
+uint8_t OneWireCrc8(const uint8_t* data, uint8_t length);
+
+/// Decode DS2438 page 0 (9 bytes including the CRC)
+DS2438Reading DS2438Decode(const uint8_t* page);
+
+/// Saildrive engaged / shore power connected: VAD at or above ONEWIRE_DIGITAL_ON_V
+bool DS2438DigitalState(const DS2438Reading& reading);
+
+/// Current through the ONEWIRE_SHUNT_OHMS sense resistor, amperes (positive = charging)
+double DS2438Current(const DS2438Reading& reading);
+
+/**
+ * @brief Battery monitor values from a DS2438 reading
+ *
+ * Voltage through the ONEWIRE_BATTERY_DIVIDER divider, current from the
+ * shunt. State of charge is estimated from the voltage between
+ * ONEWIRE_SOC_EMPTY_V and ONEWIRE_SOC_FULL_V. The charger flags are not
+ * measured by the monitor and stay false.
+ */
+void DS2438ToBattery(const DS2438Reading& reading, BatteryMonitorData& data);
+
+/// Shore power from a DS2438 reading: VAD as the connection input, current × ONEWIRE_SHORE_VOLTAGE_V
+void DS2438ToShorePower(const DS2438Reading& reading, ShorePowerData& data);
+
+/**
+ * @class OneWireConversion
+ * @brief Conversion/read cycle over all devices, in bounded steps
+ *
+ * Single-threaded: step() and the getters run in the task that owns the
+ * bus (main loop, or OneWireSensorTask with TASK_LAYOUT 1). writeStats()
+ * and isHealthy() may be called from the main loop while the task steps:
+ * a torn read only skews one statistics interval. requestStatsReset() is
+ * applied by the next step.
+ */
+class OneWireConversion {
+public:
+    /**
+     * @param bus Bus to drive (may be nullptr: every read fails)
+     * @param clock Microsecond clock for the step budget
+     */
+    OneWireConversion(IOneWireBus* bus, MicrosClock clock);
+
+    /**
+     * @brief Register the ROM of a device found on the bus (not set = read fails)
+     * @param periodMs Read period, rounded to whole ONEWIRE_CYCLE_MS slots (0 = OneWireDefaultPeriodMs())
+     */
+    void setDevice(OneWireDevice device, const uint8_t rom[8], uint32_t periodMs = 0);
+
+    bool hasDevice(OneWireDevice device) const;
+
+    /**
+     * @brief Advance the cycle by at most ~ONEWIRE_STEP_BUDGET_US of bus work
+     * @return true when a cycle just completed (results of getCycleDevices() are new)
+     */
+    bool step(uint32_t nowMs);
+
+    /// Between cycles: a step now would not interrupt a transaction
+    bool isIdle() const { return phase_ == Phase::IDLE; }
+
+    /// Failed reads of @p device in a row (0 after a valid page)
+    uint8_t getConsecutiveFailures(OneWireDevice device) const;
+
+    /// Devices read in the completed cycle (bit per OneWireDevice)
+    uint8_t getCycleDevices() const { return cycleDevices_; }
+
+    const OneWireResult& getResult(OneWireDevice device) const;
+
+    uint32_t getCycles() const { return cycles_; }
+    uint32_t getCrcErrors() const { return crcErrors_; }
+    uint32_t getMaxStepUs() const { return maxStepUs_; }
+
+    /// Scheduled device reads since the last statistics reset
+    uint32_t getTransactions() const { return transactions_; }
+
+    const OneWireDeviceStats& getDeviceStats(OneWireDevice device) const;
+
+    /// Bus time over wall time since the last statistics reset, percent
+    double getUtilization(uint32_t nowMs) const;
+
+    /**
+     * @brief Bus answering with valid data
+     *
+     * A valid page within ONEWIRE_HEALTH_TIMEOUT_MS and a CRC-error rate
+     * (errors per scheduled read) of at most ONEWIRE_HEALTH_MAX_CRC_PERCENT.
+     * False before the first valid page.
+     */
+    bool isHealthy(uint32_t nowMs) const;
+
+    /// Zero the statistics at the next step (any task)
+    void requestStatsReset() { resetRequested_.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief Write the statistics as a JSON object
+     *
+     * {"cycles":30,"transactions":45,"utilization_pct":5.2,"crc_errors":1,"crc_error_pct":2.2,
+     *  "max_step_us":1010,"healthy":true,
+     *  "devices":[{"name":"saildrive","period_ms":1000,"reads":30,"failures":0,"crc_errors":1,
+     *              "latency_ms":15,"max_latency_ms":40},...]}
+     *
+     * @return false if @p json overflowed
+     */
+    bool writeStats(JsonWriter& json, uint32_t nowMs) const;
+
+private:
+    enum class Phase : uint8_t { IDLE = 0, CONVERT, WAIT, RECALL, READ };
+    enum OpKind : uint8_t { OP_RESET = 0, OP_WRITE, OP_READ, OP_KINDS };
+
+    struct Op {
+        OpKind kind;
+        uint8_t value;
+    };
+
+    static constexpr uint8_t MAX_OPS = 32;
+    static constexpr uint8_t PAGE_BYTES = 9;
+
+    /// Queue the operations of the current phase (the current device for RECALL/READ)
+    void buildConvert();
+    void buildSelect(uint8_t command);
+    void buildRead();
+    void push(OpKind kind, uint8_t value = 0);
+
+    /// The operation list of the phase is done (or aborted: no presence)
+    bool finishPhase(uint32_t nowMs);
+
+    /// Move to the next device of the cycle; false when the cycle is complete
+    bool nextDevice();
+
+    void fail(uint8_t device);
+    void setDevicePeriod(uint8_t index, uint32_t periodMs);
+    void clearStats(uint32_t nowMs);
+
+    IOneWireBus* bus_;
+    MicrosClock clock_;
+    uint8_t roms_[static_cast<uint8_t>(OneWireDevice::COUNT)][8];
+    uint8_t present_;                 ///< Bit per device with a ROM
+    uint8_t periodSlots_[static_cast<uint8_t>(OneWireDevice::COUNT)];   ///< Read every Nth cycle
+    uint8_t consecutiveFailures_[static_cast<uint8_t>(OneWireDevice::COUNT)];
+    OneWireResult results_[static_cast<uint8_t>(OneWireDevice::COUNT)];
+
+    Phase phase_;
+    Op ops_[MAX_OPS];
+    uint8_t opCount_;
+    uint8_t opIndex_;
+    bool aborted_;                    ///< A reset of this phase saw no presence pulse
+    uint8_t rx_[PAGE_BYTES];
+    uint8_t rxCount_;
+    uint32_t opCostUs_[OP_KINDS];     ///< Last measured duration per operation kind
+
+    bool started_;
+    uint32_t cycleStartMs_;
+    uint32_t convertedMs_;
+    uint8_t pendingDevices_;          ///< Still to read in this cycle
+    uint8_t readingDevices_;          ///< All devices of this cycle
+    uint8_t cycleDevices_;            ///< Devices of the last completed cycle
+    uint8_t device_;                  ///< Device of RECALL/READ
+    bool retried_;
+
+    uint32_t slot_;                   ///< Schedule slots started (including empty ones)
+    uint32_t cycles_;
+    uint32_t lastOkMs_;
+    bool everOk_;
+
+    // Statistics (since clearStats())
+    OneWireDeviceStats deviceStats_[static_cast<uint8_t>(OneWireDevice::COUNT)];
+    uint32_t transactions_;
+    uint32_t crcErrors_;
+    uint32_t maxStepUs_;
+    uint32_t busyUs_;
+    uint32_t statsStartMs_;
+    std::atomic<bool> resetRequested_;
+};
+
+#endif // ONEWIRE_CONVERSION_H
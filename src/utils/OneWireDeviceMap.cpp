@@ -0,0 +1,163 @@
+/**
+ * @file OneWireDeviceMap.cpp
+ * @brief Implementation of the persisted 1-Wire device map
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "OneWireDeviceMap.h"
+#include "OneWireConversion.h"
+#include <string.h>
+
+const char* OneWireRoleName(OneWireRole role) {
+    switch (role) {
+        case OneWireRole::SAILDRIVE: return "saildrive";
+        case OneWireRole::BATTERY_A: return "battery_a";
+        case OneWireRole::BATTERY_B: return "battery_b";
+        case OneWireRole::SHORE_POWER: return "shore_power";
+        case OneWireRole::TEMPERATURE: return "temperature";
+        default: return "none";
+    }
+}
+
+OneWireDeviceMap::OneWireDeviceMap() {
+    memset(&entries_, 0, sizeof(entries_));
+    memset(&lock_, 0, sizeof(lock_));
+}
+
+int8_t OneWireDeviceMap::find(const uint8_t rom[8]) const {
+    for (uint8_t i = 0; i < entries_.count; i++) {
+        if (memcmp(entries_.entry[i].rom, rom, 8) == 0) {
+            return static_cast<int8_t>(i);
+        }
+    }
+    return -1;
+}
+
+int8_t OneWireDeviceMap::findRole(OneWireRole role) const {
+    for (uint8_t i = 0; i < entries_.count; i++) {
+        if (entries_.entry[i].role == role) {
+            return static_cast<int8_t>(i);
+        }
+    }
+    return -1;
+}
+
+bool OneWireDeviceMap::familyMatches(OneWireRole role, uint8_t family) {
+    return role == OneWireRole::TEMPERATURE ? family == DS18B20_FAMILY : family == DS2438_FAMILY;
+}
+
+OneWireRole OneWireDeviceMap::freeRole(uint8_t family) const {
+    if (family == DS18B20_FAMILY) {
+        return OneWireRole::TEMPERATURE;
+    }
+    if (family != DS2438_FAMILY) {
+        return OneWireRole::NONE;
+    }
+    for (uint8_t role = 0; role < static_cast<uint8_t>(OneWireRole::TEMPERATURE); role++) {
+        if (findRole(static_cast<OneWireRole>(role)) < 0) {
+            return static_cast<OneWireRole>(role);
+        }
+    }
+    return OneWireRole::NONE;
+}
+
+OneWireRole OneWireDeviceMap::assign(const uint8_t rom[8]) {
+    int8_t known = find(rom);
+    if (known >= 0) {
+        entries_.entry[known].verified = true;  // Runtime flag: no new version
+        return entries_.entry[known].role;
+    }
+
+    OneWireRole role = freeRole(rom[0]);
+    if (role != OneWireRole::NONE && entries_.count < ONEWIRE_MAP_CAPACITY) {
+        lock_.writeBegin();
+        OneWireMapEntry& entry = entries_.entry[entries_.count++];
+        memcpy(entry.rom, rom, 8);
+        entry.role = role;
+        entry.verified = true;
+        lock_.writeEnd();
+        return role;
+    }
+
+    // Roles taken: replace a device of the family that did not answer
+    for (uint8_t i = 0; i < entries_.count; i++) {
+        OneWireMapEntry& entry = entries_.entry[i];
+        if (!entry.verified && familyMatches(entry.role, rom[0])) {
+            lock_.writeBegin();
+            memcpy(entry.rom, rom, 8);
+            entry.verified = true;
+            lock_.writeEnd();
+            return entry.role;
+        }
+    }
+    return OneWireRole::NONE;
+}
+
+void OneWireDeviceMap::setVerified(uint8_t index, bool verified) {
+    if (index < entries_.count) {
+        entries_.entry[index].verified = verified;
+    }
+}
+
+void OneWireDeviceMap::setRoleMissing(OneWireRole role) {
+    int8_t index = findRole(role);
+    if (index >= 0) {
+        entries_.entry[index].verified = false;
+    }
+}
+
+bool OneWireDeviceMap::allVerified() const {
+    for (uint8_t i = 0; i < entries_.count; i++) {
+        if (!entries_.entry[i].verified) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t OneWireDeviceMap::encodeRecord(uint8_t* out, size_t size) const {
+    Entries copy;
+    lock_.read(entries_, copy);
+
+    ConfigRecordWriter record(out, size);
+    record.putU8(copy.count);
+    for (uint8_t i = 0; i < copy.count; i++) {
+        record.putBytes(copy.entry[i].rom, 8).putU8(static_cast<uint8_t>(copy.entry[i].role));
+    }
+    return record.finish(ONEWIRE_MAP_RECORD_SCHEMA);
+}
+
+ConfigRecordStatus OneWireDeviceMap::decodeRecord(const uint8_t* data, size_t length) {
+    ConfigRecordReader record(data, length);
+    uint16_t schema = 0;
+    ConfigRecordStatus status = record.open(schema);
+    if (status != ConfigRecordStatus::OK) {
+        return status;
+    }
+
+    Entries restored;
+    memset(&restored, 0, sizeof(restored));
+    uint8_t stored = record.getU8();
+    for (uint8_t i = 0; i < stored && record.ok(); i++) {
+        OneWireMapEntry entry;
+        memset(&entry, 0, sizeof(entry));
+        record.getBytes(entry.rom, 8);
+        uint8_t role = record.getU8();
+        bool valid = OneWireCrc8(entry.rom, 7) == entry.rom[7] && role < static_cast<uint8_t>(OneWireRole::NONE) &&
+                     familyMatches(static_cast<OneWireRole>(role), entry.rom[0]);
+        if (valid && restored.count < ONEWIRE_MAP_CAPACITY) {
+            entry.role = static_cast<OneWireRole>(role);
+            restored.entry[restored.count++] = entry;
+        }
+    }
+    if (!record.ok()) {
+        return ConfigRecordStatus::TRUNCATED;
+    }
+
+    lock_.writeBegin();
+    entries_ = restored;
+    lock_.writeEnd();
+    return ConfigRecordStatus::OK;
+}
@@ -0,0 +1,155 @@
+/**
+ * @file OneWireDeviceMap.h
+ * @brief Persisted ROM code to role map of the 1-Wire devices
+ *
+ * A full ROM search walks the 64-bit address tree once per device (some
+ * 14 ms each at standard speed), and assigning roles in search order
+ * moves a role to another device when the order changes (a device is
+ * added, or the bus is rewired). The map keeps the assignment in NVS
+ * (record "ow_map", ConfigRecord format) instead:
+ * - At boot every mapped ROM is checked by direct addressing; when all
+ *   answer, there is no search at all.
+ * - A new DS2438 takes the first free role in the order saildrive,
+ *   battery A, battery B, shore power; a DS18B20 is kept as an extra
+ *   temperature probe.
+ * - When roles are all taken, a new device of the same family replaces an
+ *   entry that did not answer (a sensor swapped for a new one), so the
+ *   replacement keeps the role of the device it replaced.
+ *
+ * The verified flags are runtime state only and are not persisted.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * map.decodeRecord(buffer, store->read(ONEWIRE_MAP_RECORD_KEY, buffer, sizeof(buffer)));
+ * int8_t index = map.find(rom);
+ * map.setVerified(index, verifyByAddress(rom));
+ * OneWireRole role = map.assign(foundRom);     // During a search
+ * size_t length = map.encodeRecord(buffer, sizeof(buffer));
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): ONEWIRE_MAP_CAPACITY entries, no heap
+ * - Principle VII (Fail-Safe): a damaged record is ignored and the bus is searched
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef ONEWIRE_DEVICE_MAP_H
+#define ONEWIRE_DEVICE_MAP_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ConfigRecord.h"
+#include "SeqLock.h"
+#include "../config.h"
+
+/// NVS key and payload layout of the map record
+#define ONEWIRE_MAP_RECORD_KEY "ow_map"
+#define ONEWIRE_MAP_RECORD_SCHEMA 1
+
+// Device family codes (first ROM byte)
+#define DS2438_FAMILY 0x26   // Smart Battery Monitor
+#define DS18B20_FAMILY 0x28  // Temperature sensor
+
+/**
+ * @brief Role of a mapped device
+ *
+ * The first four match OneWireDevice (static_cast between them).
+ */
+enum class OneWireRole : uint8_t {
+    SAILDRIVE = 0,
+    BATTERY_A,
+    BATTERY_B,
+    SHORE_POWER,
+    TEMPERATURE,  ///< Extra DS18B20 probe (any number, up to the capacity)
+    NONE
+};
+
+/// Name of @p role ("saildrive", "battery_a", "battery_b", "shore_power", "temperature")
+const char* OneWireRoleName(OneWireRole role);
+
+/**
+ * @brief One mapped device
+ */
+struct OneWireMapEntry {
+    uint8_t rom[8];
+    OneWireRole role;
+    bool verified;    ///< Answered at boot or was found by a search (not persisted)
+};
+
+/**
+ * @class OneWireDeviceMap
+ * @brief ROM to role assignments, kept across restarts
+ *
+ * Written by the task that owns the bus; encodeRecord() may run in the
+ * main loop (write-behind save) and copies the entries under a SeqLock.
+ */
+class OneWireDeviceMap {
+public:
+    OneWireDeviceMap();
+
+    uint8_t count() const { return entries_.count; }
+
+    /// Entry @p index (bus owner only)
+    const OneWireMapEntry& at(uint8_t index) const { return entries_.entry[index]; }
+
+    /// Index of @p rom, -1 if not mapped
+    int8_t find(const uint8_t rom[8]) const;
+
+    /// Index of the first entry with @p role, -1 if none
+    int8_t findRole(OneWireRole role) const;
+
+    /**
+     * @brief Role of a device found on the bus, assigning one if it is new
+     *
+     * A mapped ROM keeps its role and is marked verified. A new one takes
+     * the first free role of its family, or replaces an unverified entry of
+     * that family. NONE if the family is unknown or there is no room.
+     */
+    OneWireRole assign(const uint8_t rom[8]);
+
+    void setVerified(uint8_t index, bool verified);
+
+    /// Mark the device with @p role missing (it stopped answering)
+    void setRoleMissing(OneWireRole role);
+
+    /// Every mapped device answered
+    bool allVerified() const;
+
+    /// Bumped by every change that needs saving
+    uint16_t version() const { return lock_.version(); }
+
+    /**
+     * @brief Serialize the ROMs and roles
+     * @return Record length, 0 if @p size is too small
+     */
+    size_t encodeRecord(uint8_t* out, size_t size) const;
+
+    /**
+     * @brief Restore the map from a stored record (boot, before any search)
+     *
+     * Entries with an invalid ROM CRC or role are dropped.
+     *
+     * @return OK, or why the record was refused (the map stays empty)
+     */
+    ConfigRecordStatus decodeRecord(const uint8_t* data, size_t length);
+
+private:
+    struct Entries {
+        uint8_t count;
+        OneWireMapEntry entry[ONEWIRE_MAP_CAPACITY];
+    };
+
+    /// Free role for a new device of @p family, NONE if all are taken
+    OneWireRole freeRole(uint8_t family) const;
+
+    static bool familyMatches(OneWireRole role, uint8_t family);
+
+    Entries entries_;
+    SeqLock lock_;
+};
+
+#endif // ONEWIRE_DEVICE_MAP_H
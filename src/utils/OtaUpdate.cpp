@@ -0,0 +1,250 @@
+/**
+ * @file OtaUpdate.cpp
+ * @brief Implementation of the streaming update session
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "OtaUpdate.h"
+#include <atomic>
+#include <string.h>
+#include "../hal/interfaces/IFirmwareUpdater.h"
+
+namespace {
+
+/// Set from the first filesystem chunk until the reboot (or a failed upload)
+std::atomic<bool> filesystemLocked(false);
+
+/// LittleFS superblock: revision count, tag, then the magic
+const char LITTLEFS_MAGIC[] = "littlefs";
+constexpr size_t LITTLEFS_MAGIC_OFFSET = 8;
+
+/// esp_image_header_t: magic, segment count
+constexpr uint8_t APP_MAX_SEGMENTS = 16;
+
+}  // namespace
+
+const char* OtaTargetName(OtaTarget target) {
+    return target == OtaTarget::FILESYSTEM ? "filesystem" : "firmware";
+}
+
+const char* OtaStateName(OtaState state) {
+    switch (state) {
+        case OtaState::IDLE:      return "idle";
+        case OtaState::RECEIVING: return "receiving";
+        case OtaState::INSTALLED: return "installed";
+        case OtaState::FAILED:    return "failed";
+    }
+    return "unknown";
+}
+
+const char* OtaErrorName(OtaError error) {
+    switch (error) {
+        case OtaError::NONE:          return "none";
+        case OtaError::BAD_MD5:       return "bad_md5";
+        case OtaError::BAD_IMAGE:     return "bad_image";
+        case OtaError::TOO_LARGE:     return "too_large";
+        case OtaError::BEGIN_FAILED:  return "begin_failed";
+        case OtaError::WRITE_FAILED:  return "write_failed";
+        case OtaError::HASH_MISMATCH: return "hash_mismatch";
+        case OtaError::VERIFY_FAILED: return "verify_failed";
+        case OtaError::ABORTED:       return "aborted";
+    }
+    return "unknown";
+}
+
+bool OtaTargetFromName(const char* name, OtaTarget& target) {
+    if (name == nullptr) {
+        return false;
+    }
+    if (strcmp(name, "firmware") == 0) {
+        target = OtaTarget::FIRMWARE;
+        return true;
+    }
+    if (strcmp(name, "filesystem") == 0) {
+        target = OtaTarget::FILESYSTEM;
+        return true;
+    }
+    return false;
+}
+
+bool OtaParseMd5(const char* text, char* out) {
+    if (text == nullptr || strlen(text) != 32) {
+        return false;
+    }
+    for (uint8_t i = 0; i < 32; i++) {
+        char c = text[i];
+        if (c >= 'A' && c <= 'F') {
+            c = static_cast<char>(c - 'A' + 'a');
+        } else if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return false;
+        }
+        out[i] = c;
+    }
+    out[32] = '\0';
+    return true;
+}
+
+bool OtaCheckImageHeader(OtaTarget target, const uint8_t* header, size_t length) {
+    if (header == nullptr || length < OTA_HEADER_BYTES) {
+        return false;
+    }
+    if (target == OtaTarget::FIRMWARE) {
+        return header[0] == OTA_APP_IMAGE_MAGIC && header[1] >= 1 && header[1] <= APP_MAX_SEGMENTS;
+    }
+    return memcmp(header + LITTLEFS_MAGIC_OFFSET, LITTLEFS_MAGIC, sizeof(LITTLEFS_MAGIC) - 1) == 0;
+}
+
+bool OtaFilesystemLocked() {
+    return filesystemLocked.load();
+}
+
+// ============================================================================
+// OtaSession
+// ============================================================================
+
+OtaSession::OtaSession(IFirmwareUpdater* updater)
+    : updater_(updater),
+      state_(OtaState::IDLE),
+      target_(OtaTarget::FIRMWARE),
+      error_(OtaError::NONE),
+      headerFill_(0),
+      written_(false),
+      bytes_(0),
+      capacity_(0),
+      startMs_(0),
+      durationMs_(0),
+      installed_(0),
+      failed_(0) {
+}
+
+bool OtaSession::begin(OtaTarget target, const char* md5, uint32_t nowMs) {
+    if (state_ == OtaState::RECEIVING) {
+        return false;  // The running upload keeps its state; the caller answers BUSY
+    }
+    target_ = target;
+    error_ = OtaError::NONE;
+    headerFill_ = 0;
+    written_ = false;
+    bytes_ = 0;
+    startMs_ = nowMs;
+    durationMs_ = 0;
+    state_ = OtaState::RECEIVING;
+
+    char digest[33];
+    if (md5 != nullptr && !OtaParseMd5(md5, digest)) {
+        return fail(OtaError::BAD_MD5);
+    }
+    capacity_ = updater_ != nullptr ? updater_->capacity(target) : 0;
+    if (capacity_ == 0) {
+        return fail(OtaError::BEGIN_FAILED);
+    }
+    if (target == OtaTarget::FILESYSTEM) {
+        filesystemLocked.store(true);  // Before the partition is opened for writing
+    }
+    if (!updater_->begin(target, md5 != nullptr ? digest : nullptr)) {
+        return fail(OtaError::BEGIN_FAILED);
+    }
+    return true;
+}
+
+bool OtaSession::write(const uint8_t* data, size_t length) {
+    if (state_ != OtaState::RECEIVING) {
+        return false;
+    }
+    if (length > capacity_ - bytes_) {
+        updater_->abort();
+        return fail(OtaError::TOO_LARGE);
+    }
+    bytes_ += static_cast<uint32_t>(length);
+
+    // Hold the header back until the image type is known
+    if (headerFill_ < OTA_HEADER_BYTES) {
+        size_t take = OTA_HEADER_BYTES - headerFill_;
+        if (take > length) {
+            take = length;
+        }
+        memcpy(header_ + headerFill_, data, take);
+        headerFill_ = static_cast<uint8_t>(headerFill_ + take);
+        data += take;
+        length -= take;
+        if (headerFill_ < OTA_HEADER_BYTES) {
+            return true;
+        }
+        if (!OtaCheckImageHeader(target_, header_, headerFill_)) {
+            updater_->abort();
+            return fail(OtaError::BAD_IMAGE);
+        }
+        if (!forward(header_, headerFill_)) {
+            return false;
+        }
+    }
+    return length == 0 || forward(data, length);
+}
+
+bool OtaSession::finish(uint32_t nowMs) {
+    if (state_ != OtaState::RECEIVING) {
+        return false;
+    }
+    durationMs_ = nowMs - startMs_;
+    if (headerFill_ < OTA_HEADER_BYTES) {
+        updater_->abort();
+        return fail(OtaError::BAD_IMAGE);  // Empty or shorter than a header
+    }
+    OtaError result = updater_->end();
+    if (result != OtaError::NONE) {
+        return fail(result);
+    }
+    state_ = OtaState::INSTALLED;
+    installed_++;
+    return true;  // A filesystem lock stays until the reboot
+}
+
+void OtaSession::abort() {
+    if (state_ != OtaState::RECEIVING) {
+        return;
+    }
+    updater_->abort();
+    fail(OtaError::ABORTED);
+}
+
+bool OtaSession::forward(const uint8_t* data, size_t length) {
+    written_ = true;
+    if (updater_->write(data, length) != length) {
+        updater_->abort();
+        return fail(OtaError::WRITE_FAILED);
+    }
+    return true;
+}
+
+bool OtaSession::fail(OtaError error) {
+    state_ = OtaState::FAILED;
+    error_ = error;
+    failed_++;
+    if (!written_) {
+        filesystemLocked.store(false);  // Nothing reached the partition: the old image is intact
+    }
+    return false;
+}
+
+void OtaSession::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("state", OtaStateName(state_))
+        .add("target", OtaTargetName(target_))
+        .add("bytes", (unsigned long)bytes_)
+        .add("capacity", (unsigned long)capacity_)
+        .add("duration_ms", (unsigned long)durationMs_);
+    if (error_ == OtaError::NONE) {
+        json.add("error", (const char*)nullptr);
+    } else {
+        json.add("error", OtaErrorName(error_));
+    }
+    json.add("installed", (unsigned long)installed_)
+        .add("failed", (unsigned long)failed_)
+        .endObject();
+}
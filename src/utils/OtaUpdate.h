@@ -0,0 +1,201 @@
+/**
+ * @file OtaUpdate.h
+ * @brief Streaming firmware/filesystem update session (POST /update)
+ *
+ * The uploaded image is handed to an IFirmwareUpdater chunk by chunk as the
+ * HTTP body arrives: nothing is buffered beyond the first OTA_HEADER_BYTES,
+ * which are held back until the image type can be checked. A firmware image
+ * must start with the ESP32 app image header, a filesystem image with a
+ * LittleFS superblock, so an image uploaded with the wrong target is refused
+ * before the first sector is erased.
+ *
+ * The image hash is checked by the updater when the upload ends: the app
+ * image checksum and appended SHA-256 always, the MD5 of the upload when
+ * the client sent one. A failed firmware upload leaves the running firmware
+ * as it is. A failed filesystem upload does too if it is refused before its
+ * first bytes are written; later, the old filesystem is already overwritten
+ * and the device restarts (LittleFS is reformatted, NVS keeps the records).
+ *
+ * While a filesystem image is written, OtaFilesystemLocked() is true: the
+ * LittleFS writers (recorder tasks, write-behind, uploads) keep off the
+ * partition until the reboot that mounts the new image.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * OtaSession session(&updater);
+ * session.begin(OtaTarget::FIRMWARE, md5Hex, millis());  // md5Hex may be nullptr
+ * session.write(data, len);                              // Per upload chunk
+ * if (session.finish(millis())) { ... reboot ... }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): 16-byte header buffer, no heap
+ * - Principle VII (Fail-Safe): the boot partition only changes after a verified image
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef OTA_UPDATE_H
+#define OTA_UPDATE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "JsonWriter.h"
+
+class IFirmwareUpdater;
+
+/// Bytes held back to check the image type (app header, LittleFS superblock magic)
+#define OTA_HEADER_BYTES 16
+
+/// ESP32 app image header magic (esp_image_header_t::magic)
+#define OTA_APP_IMAGE_MAGIC 0xE9
+
+/**
+ * @brief Partition an image is written to
+ */
+enum class OtaTarget : uint8_t {
+    FIRMWARE = 0,   ///< Inactive OTA app slot
+    FILESYSTEM      ///< LittleFS data partition
+};
+
+/**
+ * @brief State of the update session
+ */
+enum class OtaState : uint8_t {
+    IDLE = 0,
+    RECEIVING,      ///< Upload in progress
+    INSTALLED,      ///< Verified, boots after the reboot
+    FAILED          ///< See OtaSession::getError()
+};
+
+/**
+ * @brief Why an update failed
+ */
+enum class OtaError : uint8_t {
+    NONE = 0,
+    BAD_MD5,        ///< md5 parameter is not 32 hex digits
+    BAD_IMAGE,      ///< Header does not match the target
+    TOO_LARGE,      ///< Larger than the target partition
+    BEGIN_FAILED,   ///< Partition could not be opened
+    WRITE_FAILED,   ///< Flash write error
+    HASH_MISMATCH,  ///< MD5 of the upload differs from the md5 parameter
+    VERIFY_FAILED,  ///< Image checksum/SHA-256 check failed
+    ABORTED         ///< Client went away before the end
+};
+
+const char* OtaTargetName(OtaTarget target);
+const char* OtaStateName(OtaState state);
+const char* OtaErrorName(OtaError error);
+
+/// "firmware" or "filesystem"
+bool OtaTargetFromName(const char* name, OtaTarget& target);
+
+/**
+ * @brief Check a hex MD5 digest and copy it lowercased
+ * @param out 33 bytes
+ * @return false unless @p text is exactly 32 hex digits
+ */
+bool OtaParseMd5(const char* text, char* out);
+
+/**
+ * @brief Whether the first OTA_HEADER_BYTES of an image fit @p target
+ *
+ * Firmware: app image magic and 1-16 segments. Filesystem: "littlefs"
+ * superblock magic at offset 8.
+ */
+bool OtaCheckImageHeader(OtaTarget target, const uint8_t* header, size_t length);
+
+/**
+ * @brief A filesystem image is being written or waits for the reboot
+ *
+ * Also stays set after a filesystem upload that failed once its first
+ * bytes were written, since the old filesystem is no longer intact.
+ *
+ * Safe to call from any task.
+ */
+bool OtaFilesystemLocked();
+
+/**
+ * @class OtaSession
+ * @brief One upload at a time, streamed into an IFirmwareUpdater
+ *
+ * Called from the HTTP task only. The counters are plain words, read by
+ * GET /update from the same task.
+ */
+class OtaSession {
+public:
+    explicit OtaSession(IFirmwareUpdater* updater);
+
+    /**
+     * @brief Start an upload
+     * @param md5 Expected MD5 of the image (32 hex digits), nullptr = none
+     * @return false if it cannot start (state FAILED), or while an upload is
+     *         received (state unchanged)
+     */
+    bool begin(OtaTarget target, const char* md5, uint32_t nowMs);
+
+    /**
+     * @brief Append an upload chunk
+     * @return false once the session failed (later chunks are ignored)
+     */
+    bool write(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Upload complete: verify and activate the image
+     * @return true if the image is installed
+     */
+    bool finish(uint32_t nowMs);
+
+    /// Upload cut short; the target partition is left unused
+    void abort();
+
+    bool isReceiving() const { return state_ == OtaState::RECEIVING; }
+
+    /**
+     * @brief The device must restart: an image is installed, or a failed
+     *        filesystem image already overwrote part of the old one (the
+     *        reboot reformats it; NVS keeps Wi-Fi and calibration)
+     */
+    bool requiresReboot() const {
+        return state_ == OtaState::INSTALLED || (state_ == OtaState::FAILED && OtaFilesystemLocked());
+    }
+
+    OtaState getState() const { return state_; }
+    OtaTarget getTarget() const { return target_; }
+    OtaError getError() const { return error_; }
+    uint32_t getBytes() const { return bytes_; }
+    uint32_t getDurationMs() const { return durationMs_; }
+    uint32_t getInstalled() const { return installed_; }
+    uint32_t getFailed() const { return failed_; }
+
+    /**
+     * @brief Write the session as a JSON object
+     *
+     * {"state":"receiving","target":"firmware","bytes":524288,"capacity":1900544,
+     *  "duration_ms":0,"error":null,"installed":0,"failed":1}
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    bool fail(OtaError error);
+    bool forward(const uint8_t* data, size_t length);
+
+    IFirmwareUpdater* updater_;
+    OtaState state_;
+    OtaTarget target_;
+    OtaError error_;
+    uint8_t header_[OTA_HEADER_BYTES];
+    uint8_t headerFill_;
+    bool written_;          ///< Bytes were handed to the updater
+    uint32_t bytes_;
+    uint32_t capacity_;
+    uint32_t startMs_;
+    uint32_t durationMs_;
+    uint32_t installed_;
+    uint32_t failed_;
+};
+
+#endif // OTA_UPDATE_H
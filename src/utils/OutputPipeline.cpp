@@ -0,0 +1,167 @@
+/**
+ * @file OutputPipeline.cpp
+ * @brief Implementation of the shared-encoding output dispatcher
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "OutputPipeline.h"
+#include <string.h>
+
+static_assert(OUTPUT_PIPELINE_MAX_SINKS <= 16, "run() keeps the due sinks in a 16-bit mask");
+
+OutputPipeline::OutputPipeline(OutputPipelineClock clock)
+    : count_(0),
+      clock_(clock),
+      snapshotFills_(0),
+      snapshotShares_(0),
+      lastEncodeUs_(0) {
+    memset(&snapshot_, 0, sizeof(snapshot_));
+}
+
+int8_t OutputPipeline::add(const char* name, uint16_t groups, uint32_t intervalMs, uint32_t heartbeatMs,
+                           uint8_t encodings, OutputSinkSend send, void* context) {
+    if (send == nullptr || count_ >= OUTPUT_PIPELINE_MAX_SINKS) {
+        return -1;
+    }
+    Sink& sink = sinks_[count_];
+    sink.name = name;
+    sink.send = send;
+    sink.context = context;
+    sink.groups = static_cast<uint16_t>(groups & BoatDataGroup::ALL);
+    sink.encodings = encodings;
+    sink.enabled = true;
+    sink.sent = false;
+    sink.intervalMs = intervalMs;
+    sink.heartbeatMs = heartbeatMs;
+    sink.dueMs = 0;
+    sink.slotMs = 0;
+    sink.seenGeneration = 0;
+    sink.sends = 0;
+    sink.lastSendUs = 0;
+    sink.maxSendUs = 0;
+    return static_cast<int8_t>(count_++);
+}
+
+void OutputPipeline::setInterval(int8_t id, uint32_t intervalMs, uint32_t heartbeatMs) {
+    if (id < 0 || id >= count_) {
+        return;
+    }
+    sinks_[id].intervalMs = intervalMs;
+    sinks_[id].heartbeatMs = heartbeatMs;
+    if (sinks_[id].sent) {
+        sinks_[id].dueMs = sinks_[id].slotMs + intervalMs;
+    }
+}
+
+void OutputPipeline::setEnabled(int8_t id, bool enabled) {
+    if (id >= 0 && id < count_) {
+        sinks_[id].enabled = enabled;
+    }
+}
+
+bool OutputPipeline::due(Sink& sink, const BoatDataChangeTracker& tracker, uint32_t nowMs, uint16_t& changed) {
+    if (!sink.enabled) {
+        return false;
+    }
+    if (sink.sent && static_cast<int32_t>(nowMs - sink.dueMs) < 0) {
+        return false;  // Common case: within the interval
+    }
+    changed = static_cast<uint16_t>(tracker.changedSince(sink.seenGeneration) & sink.groups);
+    bool heartbeat = sink.heartbeatMs != 0 && (!sink.sent || nowMs - sink.slotMs >= sink.heartbeatMs);
+    return changed != 0 || heartbeat;
+}
+
+uint8_t OutputPipeline::run(const BoatDataStructure& data, const BoatDataChangeTracker& tracker, uint32_t nowMs) {
+    uint32_t generation = tracker.getGeneration();  // Before the sends: later writes stay unseen
+
+    // Pass 1: due sinks and the encodings they need
+    uint16_t changed[OUTPUT_PIPELINE_MAX_SINKS];
+    uint16_t dueMask = 0;
+    uint8_t encodings = OutputEncoding::NONE;
+    for (uint8_t i = 0; i < count_; i++) {
+        if (due(sinks_[i], tracker, nowMs, changed[i])) {
+            dueMask = static_cast<uint16_t>(dueMask | (1u << i));
+            encodings = static_cast<uint8_t>(encodings | sinks_[i].encodings);
+        }
+    }
+    if (dueMask == 0) {
+        return 0;
+    }
+
+    // Shared encodings, once for every due sink
+    OutputBatch batch;
+    batch.data = &data;
+    batch.snapshotPtr = nullptr;
+    batch.nowMs = nowMs;
+    if (encodings & OutputEncoding::SNAPSHOT) {
+        uint32_t startUs = clock_ != nullptr ? clock_() : 0;
+        snapshot_.fill(data, nowMs);
+        lastEncodeUs_ = clock_ != nullptr ? clock_() - startUs : 0;
+        batch.snapshotPtr = &snapshot_;
+        snapshotFills_++;
+    }
+
+    // Pass 2: the sends
+    uint8_t sent = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        if ((dueMask & (1u << i)) == 0) {
+            continue;
+        }
+        Sink& sink = sinks_[i];
+        batch.changed = changed[i];
+        uint32_t startUs = clock_ != nullptr ? clock_() : 0;
+        sink.send(sink.context, batch);
+        if (clock_ != nullptr) {
+            sink.lastSendUs = clock_() - startUs;
+            if (sink.lastSendUs > sink.maxSendUs) {
+                sink.maxSendUs = sink.lastSendUs;
+            }
+        }
+        if (sink.encodings & OutputEncoding::SNAPSHOT) {
+            snapshotShares_++;
+        }
+
+        // Periodic sinks keep their phase while on time, so related intervals stay aligned
+        uint32_t slot = (sink.heartbeatMs != 0 && sink.sent && nowMs - sink.dueMs < sink.intervalMs)
+                        ? sink.dueMs : nowMs;
+        sink.slotMs = slot;
+        sink.dueMs = slot + sink.intervalMs;
+        sink.sent = true;
+        sink.seenGeneration = generation;
+        sink.sends++;
+        sent++;
+    }
+    return sent;
+}
+
+uint32_t OutputPipeline::getSends(int8_t id) const {
+    return (id >= 0 && id < count_) ? sinks_[id].sends : 0;
+}
+
+void OutputPipeline::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("snapshot_fills", (unsigned long)snapshotFills_)
+        .add("snapshot_shares", (unsigned long)snapshotShares_)
+        .add("encode_us", (unsigned long)lastEncodeUs_);
+    json.beginArray("sinks");
+    for (uint8_t i = 0; i < count_; i++) {
+        const Sink& sink = sinks_[i];
+        json.beginObject()
+            .add("name", sink.name)
+            .add("enabled", sink.enabled)
+            .add("interval_ms", (unsigned long)sink.intervalMs)
+            .add("heartbeat_ms", (unsigned long)sink.heartbeatMs)
+            .add("sends", (unsigned long)sink.sends)
+            .add("send_us", (unsigned long)sink.lastSendUs)
+            .add("max_send_us", (unsigned long)sink.maxSendUs)
+            .endObject();
+    }
+    json.endArray();
+    json.endObject();
+}
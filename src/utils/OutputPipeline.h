@@ -0,0 +1,163 @@
+/**
+ * @file OutputPipeline.h
+ * @brief Shared-encoding dispatcher for the periodic BoatData outputs
+ *
+ * Each output (UDP datagram, replay ring, voyage log, ...) used to run its
+ * own reaction, read BoatData and fill its own BoatDataSnapshot. An output
+ * now registers as a sink with the groups it needs, its interval and the
+ * encodings it consumes. run(), called right after each BoatData change
+ * dispatch, decides which sinks are due, builds every encoding at most once
+ * for all of them and hands the same OutputBatch to each, so the per-sink
+ * cost is its send alone.
+ *
+ * A sink is due once @p intervalMs passed since its last send and one of
+ * its groups changed since then, or, with a heartbeat, once @p heartbeatMs
+ * passed whatever changed (heartbeat = interval: strictly periodic).
+ * The deadlines of a sink with a heartbeat advance by whole intervals, so
+ * periodic sinks with related intervals fall due on the same run and share
+ * the encoding.
+ *
+ * Encodings (OutputEncoding bits):
+ * - SNAPSHOT: BoatDataSnapshot::fill() of the structure, stamped nowMs
+ *
+ * The structure itself is always passed. Encoding and send times are
+ * measured with the injected microsecond clock (none = not measured).
+ *
+ * Arduino-free (sinks and clock are injected, unit tested natively).
+ * Main loop only.
+ *
+ * Usage:
+ * @code
+ * int8_t udp = pipeline.add("udp", BoatDataGroup::ALL, 200, 200, OutputEncoding::SNAPSHOT,
+ *     [](void* ctx, const OutputBatch& batch) { ... batch.snapshot() ... }, &publisher);
+ * boatData->dispatchChanges(now);
+ * pipeline.run(*boatData->getDataStructure(), boatData->getChanges(), now);
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed sink table, one snapshot per run, zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef OUTPUT_PIPELINE_H
+#define OUTPUT_PIPELINE_H
+
+#include <stdint.h>
+#include "BoatDataChangeTracker.h"
+#include "BoatDataSnapshot.h"
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Shared encodings a sink consumes
+ */
+namespace OutputEncoding {
+    constexpr uint8_t NONE = 0;
+    constexpr uint8_t SNAPSHOT = 1 << 0;
+}
+
+/**
+ * @brief What one run() hands to its due sinks
+ */
+struct OutputBatch {
+    const BoatDataStructure* data;
+    const BoatDataSnapshot* snapshotPtr;  ///< nullptr unless a due sink asked for SNAPSHOT
+    uint16_t changed;                     ///< Groups of this sink written since its last send
+    uint32_t nowMs;
+
+    const BoatDataStructure& structure() const { return *data; }
+    const BoatDataSnapshot& snapshot() const { return *snapshotPtr; }
+};
+
+/// Send @p batch (main loop)
+typedef void (*OutputSinkSend)(void* context, const OutputBatch& batch);
+
+/// Microsecond clock for the cost counters
+typedef uint32_t (*OutputPipelineClock)();
+
+/**
+ * @class OutputPipeline
+ * @brief Sink table with one shared encoding pass per run
+ */
+class OutputPipeline {
+public:
+    explicit OutputPipeline(OutputPipelineClock clock = nullptr);
+
+    /**
+     * @brief Register a sink (setup only)
+     *
+     * @param name Static label (GET /status)
+     * @param groups BoatDataGroup mask the sink publishes
+     * @param intervalMs Shortest time between two sends
+     * @param heartbeatMs Send at least this often, changed or not (0 = changes only)
+     * @param encodings OutputEncoding bits the sink reads from the batch
+     * @return Sink ID, or -1 if the table is full (OUTPUT_PIPELINE_MAX_SINKS) or @p send is nullptr
+     */
+    int8_t add(const char* name, uint16_t groups, uint32_t intervalMs, uint32_t heartbeatMs,
+               uint8_t encodings, OutputSinkSend send, void* context);
+
+    /**
+     * @brief Change the rates of @p id (e.g. a Wi-Fi profile switch); takes effect at its next send
+     */
+    void setInterval(int8_t id, uint32_t intervalMs, uint32_t heartbeatMs);
+
+    /// Pause (false) or resume a sink; a paused sink is never due
+    void setEnabled(int8_t id, bool enabled);
+
+    /**
+     * @brief Send every due sink
+     *
+     * @return Sinks sent
+     */
+    uint8_t run(const BoatDataStructure& data, const BoatDataChangeTracker& tracker, uint32_t nowMs);
+
+    uint8_t count() const { return count_; }
+
+    /// Runs that built a snapshot, and the sends it served
+    uint32_t getSnapshotFills() const { return snapshotFills_; }
+    uint32_t getSnapshotShares() const { return snapshotShares_; }
+
+    /// Sends of sink @p id (0 for an invalid ID)
+    uint32_t getSends(int8_t id) const;
+
+    /**
+     * @brief Write the sinks as a JSON object
+     *
+     * {"snapshot_fills":812,"snapshot_shares":4871,"encode_us":38,
+     *  "sinks":[{"name":"udp","enabled":true,"interval_ms":200,"heartbeat_ms":200,"sends":4050,"send_us":95,"max_send_us":410},...]}
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    struct Sink {
+        const char* name;
+        OutputSinkSend send;
+        void* context;
+        uint16_t groups;
+        uint8_t encodings;
+        bool enabled;
+        bool sent;                  ///< slotMs is valid
+        uint32_t intervalMs;
+        uint32_t heartbeatMs;
+        uint32_t dueMs;             ///< Earliest next send
+        uint32_t slotMs;            ///< Scheduled time of the last send
+        uint32_t seenGeneration;    ///< Tracker generation of the last send
+        uint32_t sends;
+        uint32_t lastSendUs;
+        uint32_t maxSendUs;
+    };
+
+    bool due(Sink& sink, const BoatDataChangeTracker& tracker, uint32_t nowMs, uint16_t& changed);
+
+    Sink sinks_[OUTPUT_PIPELINE_MAX_SINKS];
+    uint8_t count_;
+    OutputPipelineClock clock_;
+    BoatDataSnapshot snapshot_;
+    uint32_t snapshotFills_;
+    uint32_t snapshotShares_;
+    uint32_t lastEncodeUs_;
+};
+
+#endif // OUTPUT_PIPELINE_H
@@ -0,0 +1,178 @@
+/**
+ * @file PipelineLatency.cpp
+ * @brief Implementation of the write-to-send latency probe
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "PipelineLatency.h"
+#include <string.h>
+
+namespace {
+
+const char* const OUTPUT_NAMES[] = {"json", "delta", "binary", "signalk"};
+
+/// 0 marks "nothing pending"; a real stamp of 0 is moved by 1 µs
+uint32_t nonZero(uint32_t us) {
+    return us != 0 ? us : 1;
+}
+
+uint32_t perSecond(uint64_t count, uint32_t elapsedUs) {
+    return elapsedUs > 0 ? static_cast<uint32_t>(count * 1000000ULL / elapsedUs) : 0;
+}
+
+void writeHistogram(JsonWriter& json, const LatencyHistogram& histogram, bool p90) {
+    json.add("samples", (unsigned long)histogram.getCount())
+        .add("avg_us", (unsigned long)histogram.getAverage())
+        .add("p50_us", (unsigned long)histogram.getPercentile(50));
+    if (p90) {
+        json.add("p90_us", (unsigned long)histogram.getPercentile(90));
+    }
+    json.add("p99_us", (unsigned long)histogram.getPercentile(99))
+        .add("max_us", (unsigned long)histogram.getMax());
+}
+
+}  // namespace
+
+static_assert(sizeof(OUTPUT_NAMES) / sizeof(OUTPUT_NAMES[0]) == PipelineLatency::OUTPUT_COUNT,
+              "one name per PipelineOutput");
+
+PipelineLatency::PipelineLatency()
+    : armed_(false), outputMask_(0), startUs_(0), endUs_(0), writes_(0), inputOriginUs_(0) {
+    memset(pending_, 0, sizeof(pending_));
+    memset(frames_, 0, sizeof(frames_));
+    memset(bytes_, 0, sizeof(bytes_));
+}
+
+void PipelineLatency::observeWrite(void* context, uint16_t groups, uint32_t originUs) {
+    static_cast<PipelineLatency*>(context)->noteWrite(groups, originUs);
+}
+
+void PipelineLatency::arm(uint32_t nowUs) {
+    memset(pending_, 0, sizeof(pending_));
+    memset(frames_, 0, sizeof(frames_));
+    memset(bytes_, 0, sizeof(bytes_));
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        groups_[g].reset();
+    }
+    for (uint8_t o = 0; o < OUTPUT_COUNT; o++) {
+        outputs_[o].reset();
+    }
+    writes_ = 0;
+    inputOriginUs_ = 0;
+    startUs_ = nowUs;
+    endUs_ = nowUs;
+    armed_ = true;
+}
+
+void PipelineLatency::disarm(uint32_t nowUs) {
+    if (armed_) {
+        endUs_ = nowUs;
+        armed_ = false;
+    }
+}
+
+void PipelineLatency::noteWrite(uint16_t groups, uint32_t originUs) {
+    if (!armed_) {
+        return;
+    }
+    writes_++;
+    originUs = nonZero(originUs);
+
+    // Inputs of the next calculation: the oldest one counts
+    if ((groups & ~(BoatDataGroup::DERIVED | BoatDataGroup::CALIBRATION)) != 0 &&
+        (inputOriginUs_ == 0 || static_cast<int32_t>(originUs - inputOriginUs_) < 0)) {
+        inputOriginUs_ = originUs;
+    }
+
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        uint16_t mask = BoatDataSchema::groupInfo(g).mask;
+        if ((groups & mask) == 0) {
+            continue;
+        }
+        if (mask == BoatDataGroup::DERIVED && inputOriginUs_ != 0) {
+            stamp(g, inputOriginUs_);
+            inputOriginUs_ = 0;
+        } else {
+            stamp(g, originUs);
+        }
+    }
+}
+
+void PipelineLatency::stamp(uint8_t schemaGroup, uint32_t originUs) {
+    for (uint8_t o = 0; o < OUTPUT_COUNT; o++) {
+        uint32_t& pending = pending_[o][schemaGroup];
+        if ((outputMask_ & (1u << o)) != 0 && pending == 0) {
+            pending = originUs;
+        }
+    }
+}
+
+void PipelineLatency::setOutputs(uint8_t outputMask) {
+    uint8_t dropped = static_cast<uint8_t>(outputMask_ & ~outputMask);
+    outputMask_ = outputMask;
+    for (uint8_t o = 0; o < OUTPUT_COUNT; o++) {
+        if ((dropped & (1u << o)) != 0) {
+            memset(pending_[o], 0, sizeof(pending_[o]));
+        }
+    }
+}
+
+void PipelineLatency::recordSent(PipelineOutput output, uint16_t groups, size_t bytes, uint32_t nowUs) {
+    uint8_t o = static_cast<uint8_t>(output);
+    if (!armed_ || o >= OUTPUT_COUNT) {
+        return;
+    }
+    frames_[o]++;
+    bytes_[o] += bytes;
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        uint32_t& pending = pending_[o][g];
+        if (pending == 0 || (groups & BoatDataSchema::groupInfo(g).mask) == 0) {
+            continue;
+        }
+        uint32_t latency = nowUs - pending;
+        groups_[g].record(latency);
+        outputs_[o].record(latency);
+        pending = 0;
+    }
+}
+
+bool PipelineLatency::writeJson(JsonWriter& json, uint32_t nowUs, const char* key) const {
+    uint32_t elapsed = (armed_ ? nowUs : endUs_) - startUs_;
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("armed", armed_)
+        .add("duration_ms", (unsigned long)(elapsed / 1000))
+        .add("writes", (unsigned long)writes_)
+        .add("writes_per_s", (unsigned long)perSecond(writes_, elapsed));
+
+    json.beginObject("outputs");
+    for (uint8_t o = 0; o < OUTPUT_COUNT; o++) {
+        if (frames_[o] == 0) {
+            continue;
+        }
+        json.beginObject(OUTPUT_NAMES[o])
+            .add("frames", (unsigned long)frames_[o])
+            .add("bytes", (unsigned long)bytes_[o])
+            .add("frames_per_s", (unsigned long)perSecond(frames_[o], elapsed));
+        writeHistogram(json, outputs_[o], true);
+        json.endObject();
+    }
+    json.endObject();
+
+    json.beginObject("groups");
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        if (groups_[g].getCount() == 0) {
+            continue;
+        }
+        json.beginObject(BoatDataSchema::groupInfo(g).key);
+        writeHistogram(json, groups_[g], false);
+        json.endObject();
+    }
+    json.endObject().endObject();
+    return !json.overflowed();
+}
@@ -0,0 +1,136 @@
+/**
+ * @file PipelineLatency.h
+ * @brief End-to-end latency from a BoatData write to the WebSocket frame carrying it
+ *
+ * Armed for a bus replay (BusReplay), this probe measures how long new data
+ * takes through the pipeline: input handler -> BoatData -> calculation ->
+ * serializer -> WebSocket send, per published group and per output format.
+ *
+ * - Start: every BoatData write reports its groups and the micros() its data
+ *   was produced (BoatData::setWriteObserver(); a queued patch carries the
+ *   time it was made in the receive context). The oldest unsent write of
+ *   each group is kept per output.
+ * - DERIVED: a calculation write inherits the oldest input write since the
+ *   previous calculation, so its latency covers input to derived output.
+ * - End: recordSent() when a frame is handed to the WebSocket clients; every
+ *   pending group of the frame is recorded in its group's and the output's
+ *   histogram.
+ *
+ * Outputs without consumers (setOutputs()) keep nothing pending, so a
+ * client joining later does not see the age of the whole run. The time a
+ * frame waited in the CAN RX queue before its handler ran is not part of
+ * the figure; the driver's arrival-to-handled histogram reports it.
+ *
+ * Writer task only (BoatData writes and the stream reaction both run on
+ * the main loop). Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed histograms, no heap
+ * - Principle V (Observability): percentiles per group and output
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef PIPELINE_LATENCY_H
+#define PIPELINE_LATENCY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "BoatDataSchema.h"
+#include "JsonWriter.h"
+#include "LatencyHistogram.h"
+
+/**
+ * @brief Frame formats leaving the pipeline (same order as BoatDataStreamMode, plus Signal K)
+ */
+enum class PipelineOutput : uint8_t {
+    JSON = 0,   ///< /boatdata full JSON
+    DELTA,      ///< /boatdata?mode=delta
+    BINARY,     ///< /boatdata?fmt=bin BoatDataSnapshot
+    SIGNALK,    ///< Signal K delta stream
+    COUNT
+};
+
+/**
+ * @class PipelineLatency
+ * @brief Write-to-send latency histograms per BoatData group and output
+ *
+ * Usage pattern:
+ * @code
+ * boatData->setWriteObserver(PipelineLatency::observeWrite, &pipelineLatency);
+ * pipelineLatency.arm(micros());
+ * // Stream reaction, per tick and per frame sent:
+ * pipelineLatency.setOutputs(outputsWithClients);
+ * pipelineLatency.recordSent(PipelineOutput::JSON, groups, length, micros());
+ * // End of the run:
+ * pipelineLatency.disarm(micros());
+ * pipelineLatency.writeJson(json);
+ * @endcode
+ */
+class PipelineLatency {
+public:
+    static constexpr uint8_t OUTPUT_COUNT = static_cast<uint8_t>(PipelineOutput::COUNT);
+
+    PipelineLatency();
+
+    /// BoatDataWriteObserver adapter (@p context = PipelineLatency*)
+    static void observeWrite(void* context, uint16_t groups, uint32_t originUs);
+
+    /// Forget earlier results and start measuring
+    void arm(uint32_t nowUs);
+
+    /// Stop measuring; the results stay readable
+    void disarm(uint32_t nowUs);
+
+    bool isArmed() const { return armed_; }
+
+    /// A write of @p groups whose data was produced at @p originUs
+    void noteWrite(uint16_t groups, uint32_t originUs);
+
+    /**
+     * @brief Outputs with consumers (bit = 1 << PipelineOutput); the others drop what is pending
+     */
+    void setOutputs(uint8_t outputMask);
+
+    /// A frame of @p output with @p groups (BoatDataGroup bits) was handed to its clients
+    void recordSent(PipelineOutput output, uint16_t groups, size_t bytes, uint32_t nowUs);
+
+    const LatencyHistogram& getGroup(uint8_t schemaGroup) const { return groups_[schemaGroup]; }
+    const LatencyHistogram& getOutput(PipelineOutput output) const {
+        return outputs_[static_cast<uint8_t>(output)];
+    }
+    uint32_t getWrites() const { return writes_; }
+    uint32_t getFrames(PipelineOutput output) const { return frames_[static_cast<uint8_t>(output)]; }
+
+    /**
+     * @brief The last or running measurement; outputs and groups without samples are left out
+     *
+     * {"armed":false,"duration_ms":30000,"writes":41200,"writes_per_s":1373,
+     *  "outputs":{"json":{"frames":300,"bytes":512000,"frames_per_s":10,"samples":2900,
+     *                     "avg_us":52000,"p50_us":49152,"p90_us":98304,"p99_us":98304,"max_us":101230}},
+     *  "groups":{"gps":{"samples":300,"avg_us":51000,"p50_us":49152,"p99_us":98304,"max_us":99870}}}
+     *
+     * @param key Member name in the enclosing object, or nullptr
+     * @return false if @p json overflowed
+     */
+    bool writeJson(JsonWriter& json, uint32_t nowUs, const char* key = nullptr) const;
+
+private:
+    bool armed_;
+    uint8_t outputMask_;
+    uint32_t startUs_;
+    uint32_t endUs_;
+    uint32_t writes_;
+    uint32_t inputOriginUs_;   ///< Oldest input write since the last DERIVED write (0 = none)
+    uint32_t pending_[OUTPUT_COUNT][BOATDATA_SCHEMA_GROUP_COUNT];  ///< Oldest unsent write (0 = none)
+    uint32_t frames_[OUTPUT_COUNT];
+    uint64_t bytes_[OUTPUT_COUNT];
+    LatencyHistogram groups_[BOATDATA_SCHEMA_GROUP_COUNT];
+    LatencyHistogram outputs_[OUTPUT_COUNT];
+
+    /// Keep @p originUs as pending for @p schemaGroup unless an older write is
+    void stamp(uint8_t schemaGroup, uint32_t originUs);
+};
+
+#endif // PIPELINE_LATENCY_H
@@ -0,0 +1,402 @@
+/**
+ * @file PolarTable.cpp
+ * @brief Implementation of the polar table
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "PolarTable.h"
+#include "DataTables.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+
+const float DEG_TO_RAD_F = 0.017453292519943295f;
+const float RAD_TO_DEG_F = 57.29577951308232f;
+const float TWS_BINS_PER_KN = 4.0f;       // 0.25 kn steps
+const float TARGET_SEARCH_STEP_DEG = 0.25f;
+
+bool isSeparator(char c) {
+    return c == ' ' || c == '\t' || c == ';' || c == ',' || c == '\r' || c == '\n';
+}
+
+/**
+ * @brief Numbers of one line
+ *
+ * @param skipLabel A non-numeric first token is skipped (header label)
+ * @return Count, -1 on a non-numeric token, max + 1 if there are more than @p max
+ */
+int splitNumbers(const char* p, float* out, int max, bool skipLabel) {
+    int count = 0;
+    bool first = true;
+    while (*p != '\0') {
+        while (isSeparator(*p)) {
+            p++;
+        }
+        if (*p == '\0') {
+            break;
+        }
+
+        char* end = nullptr;
+        float value = strtof(p, &end);
+        bool numeric = end != p && (*end == '\0' || isSeparator(*end));
+        if (!numeric) {
+            if (!(first && skipLabel)) {
+                return -1;
+            }
+            while (*p != '\0' && !isSeparator(*p)) {
+                p++;
+            }
+        } else {
+            if (count == max) {
+                return max + 1;
+            }
+            out[count++] = value;
+            p = end;
+        }
+        first = false;
+    }
+    return count;
+}
+
+}  // namespace
+
+PolarTable::PolarTable() {
+    clear();
+}
+
+void PolarTable::clear() {
+    twsCount_ = 0;
+    twaCount_ = 0;
+    fileTwsCount_ = 0;
+    header_ = false;
+    failed_ = false;
+    loaded_ = false;
+    error_ = "";
+}
+
+bool PolarTable::fail(const char* reason) {
+    failed_ = true;
+    loaded_ = false;
+    error_ = reason;
+    return false;
+}
+
+// =============================================================================
+// PARSING
+// =============================================================================
+
+bool PolarTable::parseLine(const char* line) {
+    if (failed_) {
+        return false;
+    }
+    if (line == nullptr) {
+        return true;
+    }
+    while (*line == ' ' || *line == '\t') {
+        line++;
+    }
+    if (*line == '#') {
+        return true;  // Comment
+    }
+
+    float values[POLAR_MAX_TWS + 1];
+    if (!header_) {
+        int count = splitNumbers(line, values, POLAR_MAX_TWS, true);
+        if (count == 0) {
+            return true;  // Empty line
+        }
+        if (count < 0) {
+            return fail("header: non-numeric TWS");
+        }
+        return addHeader(values, count);
+    }
+
+    int count = splitNumbers(line, values, POLAR_MAX_TWS + 1, false);
+    if (count == 0) {
+        return true;  // Empty line
+    }
+    if (count < 0) {
+        return fail("row: non-numeric value");
+    }
+    if (count != fileTwsCount_ + 1) {
+        return fail("row: speed count differs from TWS columns");
+    }
+    return addRow(values[0], &values[1]);
+}
+
+bool PolarTable::addHeader(const float* tws, int count) {
+    bool implicitZero = tws[0] > 0.0f;
+    if (count + (implicitZero ? 1 : 0) > POLAR_MAX_TWS) {
+        return fail("header: too many TWS columns");
+    }
+
+    if (implicitZero) {
+        tws_[twsCount_++] = 0.0f;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!(tws[i] >= 0.0f) || !isfinite(tws[i]) ||
+            (twsCount_ > 0 && !(tws[i] > tws_[twsCount_ - 1]))) {
+            return fail("header: TWS must be ascending and >= 0");
+        }
+        tws_[twsCount_++] = tws[i];
+    }
+    fileTwsCount_ = static_cast<uint8_t>(count);
+    header_ = true;
+    return true;
+}
+
+bool PolarTable::addRow(float twaDeg, const float* speeds) {
+    if (!(twaDeg >= 0.0f && twaDeg <= 180.0f) ||
+        (twaCount_ > 0 && !(twaDeg * DEG_TO_RAD_F > twa_[twaCount_ - 1]))) {
+        return fail("row: TWA must be ascending within [0, 180]");
+    }
+    bool implicitZero = twaCount_ == 0 && twaDeg > 0.0f;
+    if (twaCount_ + (implicitZero ? 2 : 1) > POLAR_MAX_TWA) {
+        return fail("row: too many TWA rows");
+    }
+
+    if (implicitZero) {
+        twa_[0] = 0.0f;
+        for (uint8_t c = 0; c < twsCount_; c++) {
+            speed_[c] = 0.0f;
+        }
+        twaCount_ = 1;
+    }
+
+    float* row = &speed_[twaCount_ * twsCount_];
+    uint8_t c = 0;
+    if (twsCount_ > fileTwsCount_) {
+        row[c++] = 0.0f;  // Implicit 0 kn column
+    }
+    for (uint8_t i = 0; i < fileTwsCount_; i++) {
+        if (!(speeds[i] >= 0.0f) || !isfinite(speeds[i])) {
+            return fail("row: speed must be finite and >= 0");
+        }
+        row[c++] = speeds[i];
+    }
+    twa_[twaCount_++] = twaDeg * DEG_TO_RAD_F;
+    return true;
+}
+
+bool PolarTable::loadBinary(const uint8_t* data, size_t length) {
+    clear();
+    if (data == nullptr || length < 4) {
+        return fail("table: truncated");
+    }
+    uint8_t twsCount = data[0];
+    uint8_t twaCount = data[1];
+    size_t floats = static_cast<size_t>(twsCount) + twaCount + static_cast<size_t>(twsCount) * twaCount;
+    if (twsCount == 0 || twaCount == 0 || twsCount > POLAR_MAX_TWS) {
+        return fail("table: bad grid size");
+    }
+    if (length < 4 + floats * sizeof(float)) {
+        return fail("table: truncated");
+    }
+
+    // Copied out value by value: the table may sit unaligned in mapped flash
+    float values[POLAR_MAX_TWS];
+    const uint8_t* p = data + 4;
+    for (uint8_t i = 0; i < twsCount; i++, p += 4) {
+        values[i] = DataTableReadF32(p);
+    }
+    if (!addHeader(values, twsCount)) {
+        return false;
+    }
+
+    const uint8_t* twa = p;
+    const uint8_t* speeds = twa + static_cast<size_t>(twaCount) * 4;
+    for (uint8_t r = 0; r < twaCount; r++) {
+        for (uint8_t c = 0; c < twsCount; c++) {
+            values[c] = DataTableReadF32(speeds + (static_cast<size_t>(r) * twsCount + c) * 4);
+        }
+        if (!addRow(DataTableReadF32(twa + static_cast<size_t>(r) * 4), values)) {
+            return false;
+        }
+    }
+    return finalize();
+}
+
+bool PolarTable::parse(const char* text) {
+    clear();
+    char line[POLAR_LINE_MAX];
+    while (text != nullptr && *text != '\0') {
+        const char* end = strchr(text, '\n');
+        size_t len = end != nullptr ? static_cast<size_t>(end - text) : strlen(text);
+        if (len >= sizeof(line)) {
+            return fail("line too long");
+        }
+        memcpy(line, text, len);
+        line[len] = '\0';
+        if (!parseLine(line)) {
+            return false;
+        }
+        text = end != nullptr ? end + 1 : nullptr;
+    }
+    return finalize();
+}
+
+bool PolarTable::finalize() {
+    if (failed_) {
+        return false;
+    }
+    if (!header_ || twsCount_ < 2) {
+        return fail("need a header with at least one TWS above 0");
+    }
+    if (twaCount_ < 2) {
+        return fail("need at least one TWA row above 0");
+    }
+
+    // Inverse segment widths (the last entry is unused)
+    for (uint8_t i = 0; i + 1 < twsCount_; i++) {
+        twsInvStep_[i] = 1.0f / (tws_[i + 1] - tws_[i]);
+    }
+    for (uint8_t i = 0; i + 1 < twaCount_; i++) {
+        twaInvStep_[i] = 1.0f / (twa_[i + 1] - twa_[i]);
+    }
+
+    // Segment each uniform step starts in
+    uint8_t seg = 0;
+    for (uint16_t b = 0; b < POLAR_TWS_BINS; b++) {
+        float start = b / TWS_BINS_PER_KN;
+        while (seg + 2 < twsCount_ && start >= tws_[seg + 1]) {
+            seg++;
+        }
+        twsIndex_[b] = seg;
+    }
+    seg = 0;
+    for (uint16_t d = 0; d <= 180; d++) {
+        float start = d * DEG_TO_RAD_F;
+        while (seg + 2 < twaCount_ && start >= twa_[seg + 1]) {
+            seg++;
+        }
+        twaIndex_[d] = seg;
+    }
+
+    findTargets();
+    loaded_ = true;
+    error_ = "";
+    return true;
+}
+
+// =============================================================================
+// LOOKUP
+// =============================================================================
+
+void PolarTable::twsSegment(float tws, uint8_t& i, float& frac) const {
+    if (!(tws > tws_[0])) {
+        i = 0;
+        frac = 0.0f;
+        return;
+    }
+    uint8_t last = twsCount_ - 1;
+    if (tws >= tws_[last]) {
+        i = last - 1;
+        frac = 1.0f;  // Hold the last column
+        return;
+    }
+
+    uint32_t bin = static_cast<uint32_t>(tws * TWS_BINS_PER_KN);
+    i = twsIndex_[bin < POLAR_TWS_BINS ? bin : POLAR_TWS_BINS - 1];
+    while (tws >= tws_[i + 1]) {
+        i++;  // Grid point inside the step (rare with 0.25 kn steps)
+    }
+    frac = (tws - tws_[i]) * twsInvStep_[i];
+}
+
+void PolarTable::twaSegment(float twa, uint8_t& i, float& frac) const {
+    uint8_t last = twaCount_ - 1;
+    if (twa >= twa_[last]) {
+        i = last - 1;
+        frac = 1.0f;  // Hold the last row
+        return;
+    }
+
+    uint32_t deg = static_cast<uint32_t>(twa * RAD_TO_DEG_F);
+    i = twaIndex_[deg <= 180 ? deg : 180];
+    while (twa >= twa_[i + 1]) {
+        i++;
+    }
+    frac = (twa - twa_[i]) * twaInvStep_[i];
+}
+
+float PolarTable::targetSpeed(float twsKn, float twaRad) const {
+    if (!loaded_ || !isfinite(twsKn) || !isfinite(twaRad)) {
+        return NAN;
+    }
+
+    uint8_t c, r;
+    float fc, fr;
+    twsSegment(twsKn, c, fc);
+    twaSegment(fabsf(twaRad), r, fr);
+
+    const float* row0 = &speed_[r * twsCount_ + c];
+    const float* row1 = row0 + twsCount_;
+    float v0 = row0[0] + fc * (row0[1] - row0[0]);
+    float v1 = row1[0] + fc * (row1[1] - row1[0]);
+    return v0 + fr * (v1 - v0);
+}
+
+bool PolarTable::target(float twsKn, bool downwind, PolarTarget& out) const {
+    if (!loaded_ || !isfinite(twsKn)) {
+        return false;
+    }
+
+    uint8_t c;
+    float fc;
+    twsSegment(twsKn, c, fc);
+    const PolarTarget* t = downwind ? run_ : beat_;
+    out.twa = t[c].twa + fc * (t[c + 1].twa - t[c].twa);
+    out.speed = t[c].speed + fc * (t[c + 1].speed - t[c].speed);
+    out.vmg = t[c].vmg + fc * (t[c + 1].vmg - t[c].vmg);
+    return true;
+}
+
+// =============================================================================
+// VMG TARGETS (load time)
+// =============================================================================
+
+float PolarTable::columnSpeed(uint8_t col, float twa) const {
+    uint8_t r;
+    float fr;
+    twaSegment(twa, r, fr);
+    float v0 = speed_[r * twsCount_ + col];
+    float v1 = speed_[(r + 1) * twsCount_ + col];
+    return v0 + fr * (v1 - v0);
+}
+
+void PolarTable::findTargets() {
+    float lastDeg = twa_[twaCount_ - 1] * RAD_TO_DEG_F;
+
+    for (uint8_t c = 0; c < twsCount_; c++) {
+        PolarTarget beat = {0.0f, 0.0f, 0.0f};
+        PolarTarget run = {0.0f, 0.0f, 0.0f};
+        for (float deg = 0.0f; deg <= lastDeg + 1e-3f; deg += TARGET_SEARCH_STEP_DEG) {
+            float twa = deg * DEG_TO_RAD_F;
+            float speed = columnSpeed(c, twa);
+            float vmg = speed * cosf(twa);
+            if (deg <= 90.0f && vmg > beat.vmg) {
+                beat = {twa, speed, vmg};
+            }
+            if (deg >= 90.0f && vmg < run.vmg) {
+                run = {twa, speed, vmg};
+            }
+        }
+        beat_[c] = beat;
+        run_[c] = run;
+    }
+
+    // Columns without speed (implicit 0 kn) take the angles of the next
+    // column, so interpolation towards them does not swing the target angle
+    for (int c = twsCount_ - 2; c >= 0; c--) {
+        if (beat_[c].speed == 0.0f) {
+            beat_[c].twa = beat_[c + 1].twa;
+        }
+        if (run_[c].speed == 0.0f) {
+            run_[c].twa = run_[c + 1].twa;
+        }
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ * @file PolarTable.h
+ * @brief Boat polar (target speed over TWS x TWA) with O(1) interpolated lookup
+ *
+ * File format (POLAR_FILE, /polar.pol), the common tab/space/semicolon
+ * separated grid exported by most polar tools:
+ * @code
+ * twa/tws  6    8    10   12   16   20
+ * 42       4.9  5.7  6.2  6.5  6.7  6.8
+ * 52       5.5  6.3  6.8  7.0  7.2  7.3
+ * 90       6.3  7.2  7.6  7.9  8.2  8.4
+ * 150      4.3  5.3  6.3  7.0  8.0  8.9
+ * 180      3.7  4.6  5.5  6.4  7.3  8.1
+ * @endcode
+ * - First line: a label (optional) and the TWS columns in knots, ascending
+ * - Other lines: TWA in degrees [0, 180], ascending, then one boat speed
+ *   (knots through the water) per TWS column
+ * - Empty lines and lines starting with '#' are skipped
+ * - A first column above 0 kn gets an implicit 0 kn column, a first row
+ *   above 0 deg an implicit 0 deg row (both with speed 0); beyond the last
+ *   column or row the edge values hold
+ *
+ * Lookup is bilinear over the file's own grid. The cell is found in O(1):
+ * finalize() precomputes, for uniform TWS steps (POLAR_TWS_BINS of 0.25 kn)
+ * and 1 deg TWA steps, the grid segment each step starts in, plus the
+ * inverse width of every segment, so a lookup is two table reads, a
+ * bounded forward step and no division. finalize() also searches every
+ * TWS column once for its best upwind and downwind VMG angle; target()
+ * interpolates those between columns.
+ *
+ * Binary form (DataTableType::POLAR in the tables partition, payload
+ * version POLAR_TABLE_VERSION, little-endian), read by loadBinary():
+ *   uint8 tws count, uint8 twa count, uint16 reserved,
+ *   float tws[tws count] (knots), float twa[twa count] (degrees),
+ *   float speed[twa count][tws count] (knots, row-major)
+ * The same validation and implicit zeros as the text form apply; no text
+ * is parsed at boot.
+ *
+ * Header + Arduino-free implementation (unit tested natively). The file is
+ * read line by line by PolarConfig.
+ *
+ * Usage:
+ * @code
+ * PolarTable polar;
+ * polar.parseLine("twa/tws 6 8 10");
+ * polar.parseLine("52 5.5 6.3 6.8");
+ * polar.parseLine("150 4.3 5.3 6.3");
+ * if (polar.finalize()) {
+ *     float target = polar.targetSpeed(9.0f, 1.2f);   // knots
+ *     PolarTarget beat;
+ *     polar.target(9.0f, false, beat);                 // best VMG upwind
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed ~3 KB table, zero heap allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef POLAR_TABLE_H
+#define POLAR_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "../config.h"
+
+/// Payload layout of a DataTableType::POLAR table
+#define POLAR_TABLE_VERSION 1
+
+/**
+ * @brief Best VMG course for one TWS
+ */
+struct PolarTarget {
+    float twa;    ///< Target TWA, radians [0, π] (unsigned)
+    float speed;  ///< Boat speed at that angle, knots
+    float vmg;    ///< Velocity made good, knots (negative downwind)
+};
+
+/**
+ * @class PolarTable
+ * @brief Fixed-capacity polar grid with precomputed lookup steps
+ */
+class PolarTable {
+public:
+    PolarTable();
+
+    /// Forget the table (before a new parse)
+    void clear();
+
+    /**
+     * @brief Parse one file line (header first, then TWA rows)
+     *
+     * @return false on a malformed line (error() tells why; the table
+     *         stays unloaded until the next clear())
+     */
+    bool parseLine(const char* line);
+
+    /**
+     * @brief Validate the grid and precompute the lookup steps and VMG targets
+     *
+     * @return true if the table is usable (loaded())
+     */
+    bool finalize();
+
+    /**
+     * @brief clear(), parseLine() for every line of @p text, finalize()
+     */
+    bool parse(const char* text);
+
+    /**
+     * @brief clear(), then load and finalize() a binary grid (layout above)
+     *
+     * @param data Payload, may be unaligned (mapped flash)
+     * @return true if the table is usable; false with error() on a bad grid
+     */
+    bool loadBinary(const uint8_t* data, size_t length);
+
+    bool loaded() const { return loaded_; }
+
+    /// Reason of the last failed parseLine()/finalize() ("" if none)
+    const char* error() const { return error_; }
+
+    /// TWS columns / TWA rows including implicit zeros
+    uint8_t twsCount() const { return twsCount_; }
+    uint8_t twaCount() const { return twaCount_; }
+
+    /**
+     * @brief Target boat speed
+     *
+     * @param twsKn True wind speed, knots
+     * @param twaRad True wind angle, radians (sign ignored)
+     * @return Knots, NaN if not loaded or an input is not finite
+     */
+    float targetSpeed(float twsKn, float twaRad) const;
+
+    /**
+     * @brief Best VMG angle, speed and VMG for @p twsKn
+     *
+     * @param downwind false = beat (TWA < 90°), true = run
+     * @return false if not loaded or @p twsKn is not finite (out untouched)
+     */
+    bool target(float twsKn, bool downwind, PolarTarget& out) const;
+
+private:
+    float tws_[POLAR_MAX_TWS];                 ///< Column TWS, knots
+    float twa_[POLAR_MAX_TWA];                 ///< Row TWA, radians
+    float speed_[POLAR_MAX_TWA * POLAR_MAX_TWS];  ///< Row-major, stride twsCount_
+    float twsInvStep_[POLAR_MAX_TWS];          ///< 1 / (tws_[i+1] - tws_[i])
+    float twaInvStep_[POLAR_MAX_TWA];
+    uint8_t twsIndex_[POLAR_TWS_BINS];         ///< Segment at the start of each 0.25 kn step
+    uint8_t twaIndex_[181];                    ///< Segment at the start of each degree
+    PolarTarget beat_[POLAR_MAX_TWS];
+    PolarTarget run_[POLAR_MAX_TWS];
+
+    uint8_t twsCount_;
+    uint8_t twaCount_;
+    uint8_t fileTwsCount_;                     ///< Speeds expected per row
+    bool header_;
+    bool failed_;
+    bool loaded_;
+    const char* error_;
+
+    bool fail(const char* reason);
+    bool addHeader(const float* tws, int count);
+    bool addRow(float twaDeg, const float* speeds);
+    void twsSegment(float tws, uint8_t& i, float& frac) const;
+    void twaSegment(float twa, uint8_t& i, float& frac) const;
+    float columnSpeed(uint8_t col, float twa) const;
+    void findTargets();
+};
+
+#endif // POLAR_TABLE_H
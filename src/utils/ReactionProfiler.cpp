@@ -0,0 +1,128 @@
+/**
+ * @file ReactionProfiler.cpp
+ * @brief Implementation of the per-reaction profiler
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "ReactionProfiler.h"
+
+ReactionProfiler::ReactionProfiler(CycleCounter counter) : counter_(counter), count_(0), windowStartMs_(0), resetRequested_(false) {
+}
+
+int8_t ReactionProfiler::add(const char* name, uint32_t intervalMs) {
+    if (count_ >= REACTION_PROFILER_MAX_REACTIONS) {
+        return -1;
+    }
+    ReactionStats& stats = stats_[count_];
+    stats = ReactionStats();
+    stats.name = name;
+    stats.intervalMs = intervalMs;
+    return static_cast<int8_t>(count_++);
+}
+
+uint32_t ReactionProfiler::begin(int8_t id, uint32_t nowMs) {
+    if (__atomic_load_n(&resetRequested_, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&resetRequested_, false, __ATOMIC_RELAXED);
+        reset(nowMs);
+    }
+    if (id >= 0 && id < count_) {
+        ReactionStats& stats = stats_[id];
+        if (stats.calls > 0) {
+            uint32_t period = nowMs - stats.lastStartMs;
+            uint32_t late = period > stats.intervalMs ? period - stats.intervalMs : 0;
+            stats.totalLateMs += late;
+            if (late > stats.maxLateMs) {
+                stats.maxLateMs = late;
+            }
+        }
+        stats.lastStartMs = nowMs;
+    }
+    return counter_();
+}
+
+void ReactionProfiler::end(int8_t id, uint32_t startCycles) {
+    uint32_t cycles = counter_() - startCycles;
+    if (id < 0 || id >= count_) {
+        return;
+    }
+    ReactionStats& stats = stats_[id];
+    stats.calls++;
+    stats.totalCycles += cycles;
+    stats.lastCycles = cycles;
+    if (cycles > stats.maxCycles) {
+        stats.maxCycles = cycles;
+    }
+}
+
+const ReactionStats* ReactionProfiler::at(uint8_t id) const {
+    return id < count_ ? &stats_[id] : nullptr;
+}
+
+uint8_t ReactionProfiler::top(uint8_t* order, uint8_t max) const {
+    // Insertion sort of at most REACTION_PROFILER_MAX_REACTIONS entries
+    uint8_t n = 0;
+    for (uint8_t id = 0; id < count_; id++) {
+        uint8_t pos = n;
+        while (pos > 0 && stats_[order[pos - 1]].totalCycles < stats_[id].totalCycles) {
+            if (pos < max) {
+                order[pos] = order[pos - 1];
+            }
+            pos--;
+        }
+        if (pos < max) {
+            order[pos] = id;
+            if (n < max) {
+                n++;
+            }
+        }
+    }
+    return n;
+}
+
+void ReactionProfiler::reset(uint32_t nowMs) {
+    for (uint8_t id = 0; id < count_; id++) {
+        ReactionStats& stats = stats_[id];
+        const char* name = stats.name;
+        uint32_t intervalMs = stats.intervalMs;
+        stats = ReactionStats();
+        stats.name = name;
+        stats.intervalMs = intervalMs;
+    }
+    windowStartMs_ = nowMs;
+}
+
+double ReactionProfiler::busyPercent(uint32_t cpuMhz, uint32_t nowMs) const {
+    uint64_t cycles = 0;
+    for (uint8_t id = 0; id < count_; id++) {
+        cycles += stats_[id].totalCycles;
+    }
+    return busyPercent(cycles, cpuMhz, nowMs);
+}
+
+double ReactionProfiler::busyPercent(uint64_t cycles, uint32_t cpuMhz, uint32_t nowMs) const {
+    double windowCycles = static_cast<double>(nowMs - windowStartMs_) * 1000.0 * cpuMhz;
+    return windowCycles > 0 ? static_cast<double>(cycles) * 100.0 / windowCycles : 0.0;
+}
+
+bool ReactionProfiler::writeEntry(JsonWriter& json, uint8_t id, uint32_t cpuMhz, uint32_t nowMs) const {
+    if (id >= count_) {
+        return false;
+    }
+    const ReactionStats& stats = stats_[id];
+    uint32_t mhz = cpuMhz > 0 ? cpuMhz : 1;
+    json.beginObject()
+        .add("name", stats.name)
+        .add("interval_ms", (unsigned long)stats.intervalMs)
+        .add("calls", (unsigned long)stats.calls)
+        .add("total_us", (unsigned long)(stats.totalCycles / mhz))
+        .add("avg_us", (unsigned long)(stats.calls > 0 ? stats.totalCycles / stats.calls / mhz : 0))
+        .add("max_us", (unsigned long)(stats.maxCycles / mhz))
+        .add("last_us", (unsigned long)(stats.lastCycles / mhz))
+        .add("cpu_pct", busyPercent(stats.totalCycles, mhz, nowMs))
+        .add("late_avg_ms", (unsigned long)(stats.calls > 1 ? stats.totalLateMs / (stats.calls - 1) : 0))
+        .add("late_max_ms", (unsigned long)stats.maxLateMs)
+        .endObject();
+    return !json.overflowed();
+}
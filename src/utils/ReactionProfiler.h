@@ -0,0 +1,140 @@
+/**
+ * @file ReactionProfiler.h
+ * @brief Per-reaction execution time and scheduling lateness of the ReactESP loop
+ *
+ * LoopPerformanceMonitor gives the loop frequency, not which of the
+ * app.onRepeat() callbacks spends the time. main.cpp registers its
+ * repeating reactions through a wrapper that brackets each invocation:
+ *
+ * @code
+ * int8_t id = reactionProfiler.add("log_drain", LOG_DRAIN_INTERVAL_MS);
+ * app.onRepeat(LOG_DRAIN_INTERVAL_MS, [id]() {
+ *     uint32_t start = reactionProfiler.begin(id, millis());
+ *     logger.drain();
+ *     reactionProfiler.end(id, start);
+ * });
+ * @endcode
+ *
+ * Per reaction: invocations, total / max / last execution cycles and the
+ * lateness of each start (start-to-start period beyond the interval, ms).
+ * The cost is two cycle counter reads (CCOUNT, injected so the class stays
+ * Arduino-free), one millis() and a few adds per invocation.
+ *
+ * Served as JSON at GET /reactions (ReactionProfilerWebServer) and on the
+ * OLED (DisplayManager::renderReactionPage()). The counters are written by
+ * the loop task only; readers on other tasks may see a value one call old,
+ * and a reset from them is deferred to the loop (requestReset()).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed table of REACTION_PROFILER_MAX_REACTIONS, no heap
+ * - Principle V (Network Debugging): per-reaction cost visible over HTTP and on the OLED
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef REACTION_PROFILER_H
+#define REACTION_PROFILER_H
+
+#include <stdint.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/// Returns a free-running CPU cycle count
+typedef uint32_t (*CycleCounter)();
+
+/**
+ * @brief Counters of one registered reaction
+ */
+struct ReactionStats {
+    const char* name;           ///< Static string (not copied)
+    uint32_t intervalMs;        ///< Registered repeat interval
+    uint32_t calls;
+    uint64_t totalCycles;
+    uint32_t maxCycles;
+    uint32_t lastCycles;
+    uint32_t lastStartMs;       ///< millis() of the last start
+    uint32_t totalLateMs;       ///< Sum of the lateness of every start after the first
+    uint32_t maxLateMs;
+};
+
+/**
+ * @class ReactionProfiler
+ * @brief Fixed table of per-reaction counters (main loop only)
+ */
+class ReactionProfiler {
+public:
+    explicit ReactionProfiler(CycleCounter counter);
+
+    /**
+     * @brief Register a reaction
+     *
+     * @param name Static label (JSON and OLED; the OLED shows 9 characters)
+     * @param intervalMs Repeat interval the lateness is measured against
+     * @return Reaction ID, or -1 if the table is full (run it unprofiled)
+     */
+    int8_t add(const char* name, uint32_t intervalMs);
+
+    /**
+     * @brief Start of an invocation of reaction @p id
+     *
+     * @param nowMs millis() (lateness against the previous start)
+     * @return Start cycle count, to pass to end()
+     */
+    uint32_t begin(int8_t id, uint32_t nowMs);
+
+    /// End of the invocation begun at @p startCycles
+    void end(int8_t id, uint32_t startCycles);
+
+    uint8_t count() const { return count_; }
+
+    /// Counters of reaction @p id (nullptr if out of range)
+    const ReactionStats* at(uint8_t id) const;
+
+    /**
+     * @brief IDs sorted by total cycles, most expensive first
+     *
+     * @param order Receives up to @p max IDs
+     * @return Number of IDs written
+     */
+    uint8_t top(uint8_t* order, uint8_t max) const;
+
+    /// Zero every counter and restart the window (registrations are kept)
+    void reset(uint32_t nowMs);
+
+    /// reset() at the next begin() (safe from the web server task)
+    void requestReset() { __atomic_store_n(&resetRequested_, true, __ATOMIC_RELAXED); }
+
+    /// millis() of the last reset (start of the measurement window)
+    uint32_t getWindowStartMs() const { return windowStartMs_; }
+
+    /**
+     * @brief Share of the window spent in reactions (all of them, or @p cycles)
+     *
+     * @param cpuMhz Cycles per microsecond
+     * @return Percent (0 for an empty window)
+     */
+    double busyPercent(uint32_t cpuMhz, uint32_t nowMs) const;
+    double busyPercent(uint64_t cycles, uint32_t cpuMhz, uint32_t nowMs) const;
+
+    /**
+     * @brief Write reaction @p id as a JSON object
+     *
+     * {"name":"boatdata_tick","interval_ms":100,"calls":600,"total_us":1201,"avg_us":2,
+     *  "max_us":40,"last_us":2,"cpu_pct":2.00,"late_avg_ms":0,"late_max_ms":7}
+     *
+     * cpu_pct is the share of the window spent in the reaction.
+     *
+     * @return false if @p id is out of range or @p json overflowed
+     */
+    bool writeEntry(JsonWriter& json, uint8_t id, uint32_t cpuMhz, uint32_t nowMs) const;
+
+private:
+    CycleCounter counter_;
+    ReactionStats stats_[REACTION_PROFILER_MAX_REACTIONS];
+    uint8_t count_;
+    uint32_t windowStartMs_;
+    bool resetRequested_;
+};
+
+#endif // REACTION_PROFILER_H
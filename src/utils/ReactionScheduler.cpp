@@ -0,0 +1,243 @@
+/**
+ * @file ReactionScheduler.cpp
+ * @brief Implementation of the priority-class reaction scheduler
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "ReactionScheduler.h"
+
+namespace {
+
+constexpr uint32_t DEFAULT_BUDGETS_US[] = {
+    SCHED_BUDGET_REALTIME_US, SCHED_BUDGET_CALCULATION_US, SCHED_BUDGET_UI_US, SCHED_BUDGET_BACKGROUND_US};
+
+static_assert(sizeof(DEFAULT_BUDGETS_US) / sizeof(DEFAULT_BUDGETS_US[0]) ==
+              static_cast<uint8_t>(ReactionClass::COUNT), "One default budget per reaction class");
+
+bool isDue(uint32_t nowMs, uint32_t dueMs) {
+    return static_cast<int32_t>(nowMs - dueMs) >= 0;
+}
+
+}  // namespace
+
+ReactionScheduler::ReactionScheduler(MicrosClock clock)
+    : clock_(clock), count_(0), probe_(nullptr), probeContext_(nullptr), pass_(0), passes_(0) {
+    for (uint8_t c = 0; c < CLASSES; c++) {
+        budgetUs_[c] = DEFAULT_BUDGETS_US[c];
+    }
+    clearStats();
+}
+
+int8_t ReactionScheduler::add(ReactionClass cls, const char* name, uint32_t intervalMs,
+                              std::function<void()> callback, uint32_t nowMs) {
+    if (!callback || cls >= ReactionClass::COUNT || count_ >= SCHED_MAX_REACTIONS) {
+        return -1;
+    }
+    ScheduledReaction& reaction = reactions_[count_];
+    reaction.name = name;
+    reaction.callback = callback;
+    reaction.intervalMs = intervalMs;
+    reaction.dueMs = nowMs + intervalMs;
+    reaction.pass = pass_;
+    reaction.cls = cls;
+    reaction.overBudgetStreak = 0;
+    reaction.flagged = false;
+    reaction.overBudgetRuns = 0;
+    reaction.maxUs = 0;
+    return static_cast<int8_t>(count_++);
+}
+
+void ReactionScheduler::setBudget(ReactionClass cls, uint32_t budgetUs) {
+    if (cls < ReactionClass::COUNT) {
+        budgetUs_[static_cast<uint8_t>(cls)] = budgetUs;
+    }
+}
+
+void ReactionScheduler::setPendingInputProbe(PendingInputProbe probe, void* context) {
+    probe_ = probe;
+    probeContext_ = context;
+}
+
+int8_t ReactionScheduler::nextDue(uint8_t cls, uint32_t nowMs) const {
+    int8_t best = -1;
+    uint32_t bestLate = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        const ScheduledReaction& reaction = reactions_[i];
+        if (static_cast<uint8_t>(reaction.cls) != cls || reaction.pass == pass_ || !isDue(nowMs, reaction.dueMs)) {
+            continue;
+        }
+        uint32_t late = nowMs - reaction.dueMs;
+        // Equal lateness (e.g. every-pass reactions): the one that ran longest ago
+        if (best < 0 || late > bestLate || (late == bestLate && reaction.pass < reactions_[best].pass)) {
+            best = static_cast<int8_t>(i);
+            bestLate = late;
+        }
+    }
+    return best;
+}
+
+uint8_t ReactionScheduler::run(uint32_t nowMs) {
+    pass_++;
+    passes_++;
+
+    uint32_t usedUs[CLASSES] = {};
+    bool closed[CLASSES] = {};     // Over budget, or BACKGROUND yielding
+    const uint8_t background = static_cast<uint8_t>(ReactionClass::BACKGROUND);
+    uint8_t ran = 0;
+
+    for (;;) {
+        int8_t pick = -1;
+        uint8_t cls = 0;
+        for (uint8_t c = 0; c < CLASSES && pick < 0; c++) {
+            if (closed[c]) {
+                continue;
+            }
+            int8_t id = nextDue(c, nowMs);
+            if (id < 0) {
+                continue;
+            }
+            if (c == background) {
+                bool higherBehind = false;
+                for (uint8_t h = 0; h < background; h++) {
+                    higherBehind = higherBehind || (closed[h] && nextDue(h, nowMs) >= 0);
+                }
+                bool inputWaiting = probe_ != nullptr && probe_(probeContext_);
+                if ((higherBehind || inputWaiting) &&
+                    nowMs - reactions_[id].dueMs < SCHED_BACKGROUND_MAX_DEFER_MS) {
+                    stats_[c].deferred++;
+                    closed[c] = true;
+                    continue;
+                }
+            }
+            pick = id;
+            cls = c;
+        }
+        if (pick < 0) {
+            break;
+        }
+
+        ScheduledReaction& reaction = reactions_[pick];
+        ReactionClassStats& stats = stats_[cls];
+        uint32_t late = nowMs - reaction.dueMs;
+        if (late > stats.maxLateMs) {
+            stats.maxLateMs = late;
+        }
+        reaction.pass = pass_;
+        reaction.dueMs += reaction.intervalMs;
+        if (reaction.intervalMs > 0 && isDue(nowMs, reaction.dueMs)) {
+            reaction.dueMs = nowMs + reaction.intervalMs;  // More than one interval behind: no catch-up burst
+        }
+
+        uint32_t startUs = clock_();
+        reaction.callback();
+        uint32_t elapsedUs = clock_() - startUs;
+        usedUs[cls] += elapsedUs;
+        stats.runs++;
+        stats.busyUs += elapsedUs;
+        ran++;
+
+        if (elapsedUs > reaction.maxUs) {
+            reaction.maxUs = elapsedUs;
+        }
+        if (elapsedUs >= budgetUs_[cls]) {
+            if (reaction.overBudgetRuns < UINT16_MAX) {
+                reaction.overBudgetRuns++;
+            }
+            if (reaction.overBudgetStreak < SCHED_OVER_BUDGET_FLAG_RUNS) {
+                reaction.overBudgetStreak++;
+            }
+            reaction.flagged = reaction.flagged || reaction.overBudgetStreak >= SCHED_OVER_BUDGET_FLAG_RUNS;
+        } else {
+            reaction.overBudgetStreak = 0;
+        }
+
+        if (usedUs[cls] >= budgetUs_[cls]) {
+            closed[cls] = true;
+        }
+    }
+
+    // Classes that ran out of budget with work still due
+    for (uint8_t c = 0; c < background; c++) {
+        if (closed[c] && nextDue(c, nowMs) >= 0) {
+            stats_[c].budgetHits++;
+        }
+    }
+    return ran;
+}
+
+const ScheduledReaction* ReactionScheduler::at(uint8_t id) const {
+    return id < count_ ? &reactions_[id] : nullptr;
+}
+
+uint8_t ReactionScheduler::getFlaggedCount() const {
+    uint8_t flagged = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        flagged = static_cast<uint8_t>(flagged + (reactions_[i].flagged ? 1 : 0));
+    }
+    return flagged;
+}
+
+const char* ReactionScheduler::className(ReactionClass cls) {
+    switch (cls) {
+        case ReactionClass::REALTIME_IO: return "realtime";
+        case ReactionClass::CALCULATION: return "calculation";
+        case ReactionClass::UI_NETWORK:  return "ui";
+        default:                         return "background";
+    }
+}
+
+bool ReactionScheduler::writeStats(JsonWriter& json) const {
+    json.beginObject()
+        .add("passes", (unsigned long)passes_)
+        .beginArray("classes");
+    for (uint8_t c = 0; c < CLASSES; c++) {
+        uint8_t reactions = 0;
+        for (uint8_t i = 0; i < count_; i++) {
+            reactions = static_cast<uint8_t>(reactions + (static_cast<uint8_t>(reactions_[i].cls) == c ? 1 : 0));
+        }
+        const ReactionClassStats& stats = stats_[c];
+        json.beginObject()
+            .add("class", className(static_cast<ReactionClass>(c)))
+            .add("reactions", (unsigned int)reactions)
+            .add("budget_us", (unsigned long)budgetUs_[c])
+            .add("runs", (unsigned long)stats.runs)
+            .add("busy_us", (unsigned long)stats.busyUs)
+            .add("max_late_ms", (unsigned long)stats.maxLateMs)
+            .add("budget_hits", (unsigned long)stats.budgetHits)
+            .add("deferred", (unsigned long)stats.deferred)
+            .endObject();
+    }
+    json.endArray().beginArray("flagged");
+    for (uint8_t i = 0; i < count_; i++) {
+        const ScheduledReaction& reaction = reactions_[i];
+        if (!reaction.flagged) {
+            continue;
+        }
+        json.beginObject()
+            .add("name", reaction.name)
+            .add("class", className(reaction.cls))
+            .add("over_budget", (unsigned int)reaction.overBudgetRuns)
+            .add("max_us", (unsigned long)reaction.maxUs)
+            .endObject();
+    }
+    json.endArray().endObject();
+    return !json.overflowed();
+}
+
+void ReactionScheduler::clearStats() {
+    for (uint8_t c = 0; c < CLASSES; c++) {
+        stats_[c].runs = 0;
+        stats_[c].busyUs = 0;
+        stats_[c].maxLateMs = 0;
+        stats_[c].budgetHits = 0;
+        stats_[c].deferred = 0;
+    }
+    for (uint8_t i = 0; i < count_; i++) {
+        reactions_[i].flagged = false;
+        reactions_[i].overBudgetRuns = 0;
+        reactions_[i].maxUs = 0;
+    }
+    passes_ = 0;
+}
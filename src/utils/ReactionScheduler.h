@@ -0,0 +1,173 @@
+/**
+ * @file ReactionScheduler.h
+ * @brief Priority classes and per-class time budgets for the periodic main-loop work
+ *
+ * ReactESP runs due reactions in registration order, so a 40 ms OLED push
+ * registered before the I/O pump delays CAN and UART draining by 40 ms.
+ * main.cpp therefore registers its periodic work here (onRepeatProfiled()
+ * takes the class as an extra argument) and calls run() once per loop pass.
+ * The classes, highest priority first:
+ *
+ * - REALTIME_IO: bus I/O (io_pump, n2k_tx, tcp_0183)
+ * - CALCULATION: change dispatch, i.e. calculation and navigation (bd_notify), bd_stale
+ * - UI_NETWORK: WebSocket/UDP output, display, logging (bd_stream, oled_page, log_drain)
+ * - BACKGROUND: statistics and housekeeping (*_st, tasks)
+ * each with a time budget per pass (SCHED_BUDGET_*_US).
+ *
+ * run() repeatedly picks the most overdue due reaction of the highest class
+ * that still has budget, so after every reaction the higher classes are
+ * looked at again: a slow display push is followed by the I/O pump, not by
+ * the next UI reaction. Each reaction runs at most once per pass, and every
+ * class gets at least one reaction per pass (a class over its budget waits
+ * for the next pass, it is not starved). Reactions are cooperative: one
+ * that is running is never interrupted.
+ *
+ * BACKGROUND work is deferred while a higher class is behind (a due
+ * reaction left over for budget) or the input probe reports input waiting
+ * (the I/O pump ended on its budget), until it is
+ * SCHED_BACKGROUND_MAX_DEFER_MS late.
+ *
+ * A reaction that falls more than one interval behind is rescheduled from
+ * now, without catch-up bursts (like ReactESP). A reaction whose single
+ * runs use up its class budget SCHED_OVER_BUDGET_FLAG_RUNS times in a row is
+ * flagged in the statistics (it belongs in a task, or in a lower class).
+ * Arduino-free (the microsecond clock is injected, unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed table of SCHED_MAX_REACTIONS, no heap after add()
+ * - Principle VII (Fail-Safe): bus input keeps priority over display and statistics work
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef REACTION_SCHEDULER_H
+#define REACTION_SCHEDULER_H
+
+#include <stdint.h>
+#include <functional>
+#include "IoPump.h"
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Priority class of a scheduled reaction (lower value = higher priority)
+ */
+enum class ReactionClass : uint8_t {
+    REALTIME_IO = 0,    ///< Bus input and output
+    CALCULATION,        ///< Change dispatch: calculation and navigation cycles
+    UI_NETWORK,         ///< WebSocket/UDP output, display, logging
+    BACKGROUND,         ///< Statistics and housekeeping
+    COUNT
+};
+
+/**
+ * @brief Registration and counters of one reaction
+ */
+struct ScheduledReaction {
+    const char* name;               ///< Static string (not copied)
+    std::function<void()> callback;
+    uint32_t intervalMs;
+    uint32_t dueMs;                 ///< millis() of the next run
+    uint32_t pass;                  ///< Last pass the reaction ran in
+    ReactionClass cls;
+    uint8_t overBudgetStreak;       ///< Runs in a row that used up the class budget
+    bool flagged;                   ///< Streak reached SCHED_OVER_BUDGET_FLAG_RUNS since clearStats()
+    uint16_t overBudgetRuns;        ///< Since clearStats()
+    uint32_t maxUs;                 ///< Longest run since clearStats()
+};
+
+/**
+ * @brief Counters of one class since the last clearStats()
+ */
+struct ReactionClassStats {
+    uint32_t runs;
+    uint32_t busyUs;
+    uint32_t maxLateMs;             ///< Largest start past the due time
+    uint32_t budgetHits;            ///< Passes that ended the class on its budget with work due
+    uint32_t deferred;              ///< BACKGROUND: passes it yielded to higher classes or pending input
+};
+
+/// Returns true while input is waiting for the REALTIME_IO class
+typedef bool (*PendingInputProbe)(void* context);
+
+/**
+ * @class ReactionScheduler
+ * @brief Class-ordered, budgeted cooperative scheduler (main loop only)
+ */
+class ReactionScheduler {
+public:
+    static constexpr uint8_t CLASSES = static_cast<uint8_t>(ReactionClass::COUNT);
+
+    explicit ReactionScheduler(MicrosClock clock);
+
+    /**
+     * @brief Register a repeating reaction, first due one interval after @p nowMs
+     *
+     * @param cls Priority class
+     * @param name Static label (SCHEDULER_STATS)
+     * @param intervalMs Period (0 = every pass)
+     * @param callback Work of one run
+     * @param nowMs millis() at registration
+     * @return Reaction ID, or -1 if the table is full
+     */
+    int8_t add(ReactionClass cls, const char* name, uint32_t intervalMs, std::function<void()> callback,
+               uint32_t nowMs);
+
+    /// Replace the default budget (SCHED_BUDGET_*_US) of @p cls
+    void setBudget(ReactionClass cls, uint32_t budgetUs);
+
+    /// Input probe consulted before BACKGROUND work (nullptr = none)
+    void setPendingInputProbe(PendingInputProbe probe, void* context);
+
+    /**
+     * @brief One scheduling pass
+     *
+     * @param nowMs millis() (due times)
+     * @return Reactions run
+     */
+    uint8_t run(uint32_t nowMs);
+
+    uint8_t count() const { return count_; }
+
+    /// Reaction @p id (nullptr if out of range)
+    const ScheduledReaction* at(uint8_t id) const;
+
+    const ReactionClassStats& getStats(ReactionClass cls) const { return stats_[static_cast<uint8_t>(cls)]; }
+
+    /// Reactions flagged for repeatedly exceeding their class budget
+    uint8_t getFlaggedCount() const;
+
+    /// "realtime", "calculation", "ui" or "background"
+    static const char* className(ReactionClass cls);
+
+    /**
+     * @brief Write the class counters as a JSON object
+     *
+     * {"passes":90000,"classes":[{"class":"realtime","reactions":3,"budget_us":4000,
+     *  "runs":18000,"busy_us":52000,"max_late_ms":2,"budget_hits":0,"deferred":0},...],
+     *  "flagged":[{"name":"oled_page","class":"ui","over_budget":6,"max_us":41000}]}
+     *
+     * @return false if @p json overflowed
+     */
+    bool writeStats(JsonWriter& json) const;
+
+    /// Zero the counters and flags (registrations, due times and streaks are kept)
+    void clearStats();
+
+private:
+    MicrosClock clock_;
+    ScheduledReaction reactions_[SCHED_MAX_REACTIONS];
+    uint8_t count_;
+    uint32_t budgetUs_[CLASSES];
+    ReactionClassStats stats_[CLASSES];
+    PendingInputProbe probe_;
+    void* probeContext_;
+    uint32_t pass_;
+    uint32_t passes_;               ///< Since the last clearStats()
+
+    /// Most overdue due reaction of @p cls not yet run in this pass, or -1
+    int8_t nextDue(uint8_t cls, uint32_t nowMs) const;
+};
+
+#endif // REACTION_SCHEDULER_H
@@ -0,0 +1,104 @@
+/**
+ * @file SPSCQueue.h
+ * @brief Fixed-size lock-free single-producer / single-consumer queue
+ *
+ * Hands values from one task to another without locks: the producer only
+ * writes the tail index, the consumer only writes the head index. A full
+ * queue rejects the push and counts it, so the producer never blocks.
+ *
+ * Used to move decoded NMEA2000 updates from the CAN receive task (core 0)
+ * to the main loop, which owns BoatData.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): storage is statically sized, zero heap allocation
+ * - Principle VII (Fail-Safe): overflow drops values instead of stalling the producer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @class SPSCQueue
+ * @brief Bounded ring of @p Capacity values of type @p T
+ *
+ * @tparam T Trivially copyable element type
+ * @tparam Capacity Number of slots (power of two)
+ */
+template <typename T, uint32_t Capacity>
+class SPSCQueue {
+public:
+    static_assert((Capacity & (Capacity - 1)) == 0, "SPSCQueue capacity must be a power of two");
+    static_assert(Capacity >= 2, "SPSCQueue capacity must be at least 2");
+
+    static constexpr uint32_t CAPACITY = Capacity;
+
+    SPSCQueue() : head(0), tail(0), highWater(0), dropped(0) {}
+
+    /**
+     * @brief Append a value (producer side only)
+     * @return false if the queue is full (drop counted)
+     */
+    bool push(const T& value) {
+        uint32_t t = tail.load(std::memory_order_relaxed);
+        uint32_t depth = t - head.load(std::memory_order_acquire);
+        if (depth >= Capacity) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        slots[t & (Capacity - 1)] = value;
+        tail.store(t + 1, std::memory_order_release);
+
+        if (depth + 1 > highWater.load(std::memory_order_relaxed)) {
+            highWater.store(depth + 1, std::memory_order_relaxed);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest value (consumer side only)
+     * @return false if the queue is empty
+     */
+    bool pop(T& value) {
+        uint32_t h = head.load(std::memory_order_relaxed);
+        if (h == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        value = slots[h & (Capacity - 1)];
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Approximate number of queued values
+     */
+    uint32_t size() const {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Deepest queue depth observed since startup
+     */
+    uint32_t getHighWater() const { return highWater.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Values rejected because the queue was full (since startup)
+     */
+    uint32_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    T slots[Capacity];
+    std::atomic<uint32_t> head;       ///< Next slot to read (written by consumer)
+    std::atomic<uint32_t> tail;       ///< Next slot to write (written by producer)
+    std::atomic<uint32_t> highWater;  ///< Written by producer only
+    std::atomic<uint32_t> dropped;    ///< Written by producer only
+};
+
+#endif // SPSC_QUEUE_H
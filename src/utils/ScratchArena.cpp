@@ -0,0 +1,65 @@
+/**
+ * @file ScratchArena.cpp
+ * @brief Implementation of the bump-pointer scratch arena
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "ScratchArena.h"
+
+ScratchArena::ScratchArena(void* buffer, size_t capacity)
+    : buffer_(static_cast<uint8_t*>(buffer)), capacity_(buffer != nullptr ? capacity : 0), used_(0),
+      highWater_(0), overflows_(0), lastOverflowBytes_(0) {
+}
+
+void* ScratchArena::allocate(size_t bytes, size_t alignment) {
+    // Align the address, not the offset: the buffer itself may be less aligned
+    uintptr_t base = reinterpret_cast<uintptr_t>(buffer_);
+    uintptr_t align = alignment > 0 ? alignment : 1;
+    size_t start = static_cast<size_t>(((base + used_ + align - 1) & ~(align - 1)) - base);
+
+    if (buffer_ == nullptr || start > capacity_ || bytes > capacity_ - start) {
+        overflows_++;
+        lastOverflowBytes_ = bytes;
+        return nullptr;
+    }
+
+    used_ = start + bytes;
+    if (used_ > highWater_) {
+        highWater_ = used_;
+    }
+    return buffer_ + start;
+}
+
+void ScratchArena::clearStats() {
+    highWater_ = used_;
+    overflows_ = 0;
+    lastOverflowBytes_ = 0;
+}
+
+void ScratchArena::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("capacity", (unsigned long)capacity_)
+        .add("used", (unsigned long)used_)
+        .add("high_water", (unsigned long)highWater_)
+        .add("overflows", (unsigned long)overflows_)
+        .add("last_overflow_bytes", (unsigned long)lastOverflowBytes_)
+        .endObject();
+}
+
+ScratchArena& GetLoopArena() {
+    alignas(ScratchArena::DEFAULT_ALIGNMENT) static uint8_t buffer[SCRATCH_LOOP_ARENA_BYTES];
+    static ScratchArena arena(buffer, sizeof(buffer));
+    return arena;
+}
+
+ScratchArena& GetHttpArena() {
+    alignas(ScratchArena::DEFAULT_ALIGNMENT) static uint8_t buffer[SCRATCH_HTTP_ARENA_BYTES];
+    static ScratchArena arena(buffer, sizeof(buffer));
+    return arena;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file ScratchArena.h
+ * @brief Bump-pointer arena for short-lived temporaries, rewound per reaction or request
+ *
+ * Serialization snapshots, JSON documents and HTTP response bodies only live
+ * for one reaction or one request. Instead of the global heap (or a deep
+ * task stack) they are taken from a fixed buffer by moving an offset:
+ * allocation is an add and a compare, freeing is resetting the offset.
+ *
+ * - GetLoopArena(): main-loop reactions. main.cpp resets it after every
+ *   reaction (onRepeatProfiled()), so nothing outlives the reaction.
+ * - GetHttpArena(): ESPAsyncWebServer handlers, which all run on the
+ *   async_tcp task. Handlers take a ScratchScope, rewound on return.
+ *
+ * An arena belongs to one task and is not locked. A request that does not
+ * fit returns nullptr and is counted (overflows); the high-water mark
+ * shows how much of the capacity the worst reaction or request needed.
+ * Destructors are never run, so only trivially destructible types are
+ * placed in it; a ScratchJsonDocument (ScratchJson.h) stays a local and
+ * takes only its memory pool from the arena.
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed buffers, transient data never reaches the heap
+ * - Principle VII (Fail-Safe): exhaustion fails one allocation (counted), never the heap
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef SCRATCH_ARENA_H
+#define SCRATCH_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <type_traits>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @class ScratchArena
+ * @brief Fixed buffer handed out front to back, released all at once
+ *
+ * Usage pattern:
+ * @code
+ * ScratchScope scratch(GetLoopArena());
+ * BoatDataStructure* snapshot = scratch.arena().make<BoatDataStructure>();
+ * if (snapshot == nullptr) {
+ *     return 0;  // Arena exhausted (counted in getOverflows())
+ * }
+ * @endcode
+ */
+class ScratchArena {
+public:
+    static constexpr size_t DEFAULT_ALIGNMENT = alignof(max_align_t);
+
+    /**
+     * @param buffer Backing storage (not owned, outlives the arena)
+     * @param capacity Bytes in @p buffer
+     */
+    ScratchArena(void* buffer, size_t capacity);
+
+    /**
+     * @brief @p bytes aligned to @p alignment (a power of two)
+     * @return nullptr if the rest of the arena is too small (counted as an overflow)
+     */
+    void* allocate(size_t bytes, size_t alignment = DEFAULT_ALIGNMENT);
+
+    /**
+     * @brief Uninitialized array of @p count elements
+     */
+    template <typename T>
+    T* allocArray(size_t count) {
+        static_assert(std::is_trivially_destructible<T>::value, "ScratchArena never runs destructors");
+        return static_cast<T*>(allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    /**
+     * @brief One @p T, default-initialized like a local variable
+     */
+    template <typename T>
+    T* make() {
+        static_assert(std::is_trivially_destructible<T>::value, "ScratchArena never runs destructors");
+        void* block = allocate(sizeof(T), alignof(T));
+        return block != nullptr ? new (block) T : nullptr;
+    }
+
+    /// Current offset, for rewind()
+    size_t mark() const { return used_; }
+
+    /// Release everything allocated since @p mark
+    void rewind(size_t mark) { used_ = mark < used_ ? mark : used_; }
+
+    /// Release everything
+    void reset() { used_ = 0; }
+
+    size_t getCapacity() const { return capacity_; }
+    size_t getUsed() const { return used_; }
+
+    /// Most bytes in use at once since construction (or clearStats())
+    size_t getHighWater() const { return highWater_; }
+
+    /// Allocations that did not fit
+    uint32_t getOverflows() const { return overflows_; }
+
+    /// Size of the last allocation that did not fit (0 = none yet)
+    size_t getLastOverflowBytes() const { return lastOverflowBytes_; }
+
+    void clearStats();
+
+    /// {"capacity":2048,"used":0,"high_water":812,"overflows":0,"last_overflow_bytes":0}
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    uint8_t* buffer_;
+    size_t capacity_;
+    size_t used_;
+    size_t highWater_;
+    uint32_t overflows_;
+    size_t lastOverflowBytes_;
+};
+
+/**
+ * @class ScratchScope
+ * @brief Rewinds an arena to where it was when the scope was entered
+ *
+ * Declare it before anything allocated from the arena, so those are gone
+ * (destroyed first) by the time the arena is rewound.
+ */
+class ScratchScope {
+public:
+    explicit ScratchScope(ScratchArena& arena) : arena_(arena), mark_(arena.mark()) {}
+    ~ScratchScope() { arena_.rewind(mark_); }
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+    ScratchArena& arena() { return arena_; }
+
+private:
+    ScratchArena& arena_;
+    size_t mark_;
+};
+
+/// Main-loop reactions (SCRATCH_LOOP_ARENA_BYTES), reset after each reaction
+ScratchArena& GetLoopArena();
+
+/// HTTP handlers on the async_tcp task (SCRATCH_HTTP_ARENA_BYTES), one ScratchScope per request
+ScratchArena& GetHttpArena();
+
+#endif // SCRATCH_ARENA_H
@@ -0,0 +1,46 @@
+/**
+ * @file ScratchJson.h
+ * @brief ArduinoJson documents whose memory pool comes from a ScratchArena
+ *
+ * A ScratchJsonDocument is declared like a DynamicJsonDocument, but its
+ * pool is taken from the arena instead of the heap (or the task stack, as
+ * with StaticJsonDocument). Releasing it is a no-op: the pool goes back
+ * when the enclosing ScratchScope rewinds the arena.
+ *
+ * @code
+ * ScratchScope scratch(GetHttpArena());
+ * ScratchJsonDocument doc(CALIBRATION_JSON_CAPACITY, ScratchJsonAllocator(&scratch.arena()));
+ * if (doc.capacity() == 0) {
+ *     // arena exhausted: answer 503
+ * }
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef SCRATCH_JSON_H
+#define SCRATCH_JSON_H
+
+#include <ArduinoJson.h>
+#include "ScratchArena.h"
+
+/**
+ * @brief ArduinoJson allocator over a ScratchArena
+ */
+class ScratchJsonAllocator {
+public:
+    explicit ScratchJsonAllocator(ScratchArena* arena = nullptr) : arena_(arena) {}
+
+    void* allocate(size_t size) { return arena_ != nullptr ? arena_->allocate(size) : nullptr; }
+    void deallocate(void*) {}                          // Released by the arena's rewind
+    void* reallocate(void*, size_t) { return nullptr; }  // shrinkToFit() is not supported
+
+private:
+    ScratchArena* arena_;
+};
+
+/// JSON document with a fixed capacity taken from an arena (capacity() == 0 if it did not fit)
+typedef BasicJsonDocument<ScratchJsonAllocator> ScratchJsonDocument;
+
+#endif // SCRATCH_JSON_H
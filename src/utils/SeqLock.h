@@ -0,0 +1,144 @@
+/**
+ * @file SeqLock.h
+ * @brief Sequence counter for lock-free snapshots of one writer's data
+ *
+ * One writer bumps the counter to odd before changing the guarded data and
+ * back to even afterwards. Readers copy the data and keep the copy only if
+ * the counter was even and unchanged around the copy, so a reader on the
+ * other core never sees a half-written group and never blocks the writer.
+ *
+ * The counter also serves as a change version: version() advances by one
+ * per completed write, so a reader can skip work when nothing changed since
+ * the version it last rendered or serialized.
+ *
+ * The counter is a plain uint16_t accessed through the GCC __atomic builtins
+ * instead of std::atomic, so structures embedding a SeqLock stay trivially
+ * copyable and can be cleared with memset (BoatDataStructure). At the
+ * highest sensor rates (10 Hz) version() wraps after ~109 minutes; readers
+ * compare versions for inequality only.
+ *
+ * Header-only, Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * // Writer (single task)
+ * lock.writeBegin();
+ * shared = value;
+ * lock.writeEnd();
+ *
+ * // Reader (any task)
+ * GPSData gps;
+ * uint16_t version;
+ * if (lock.read(shared, gps, &version) && version != lastVersion) { ... }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): 2 bytes per guarded group, zero heap allocation
+ * - Principle VII (Fail-Safe): a reader gives up after SEQLOCK_READ_ATTEMPTS instead of spinning
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef SEQ_LOCK_H
+#define SEQ_LOCK_H
+
+#include <stdint.h>
+#include <string.h>
+#include "../config.h"
+
+/**
+ * @struct SeqLock
+ * @brief Even = stable, odd = write in progress
+ *
+ * Zero-initialized state (memset or aggregate init) is a valid, stable lock.
+ */
+struct SeqLock {
+    uint16_t seq;
+
+    /**
+     * @brief Start a write (writer task only)
+     */
+    void writeBegin() {
+        __atomic_store_n(&seq, static_cast<uint16_t>(seq + 1), __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_RELEASE);  // Odd count visible before the data changes
+    }
+
+    /**
+     * @brief Publish a write (writer task only)
+     */
+    void writeEnd() {
+        __atomic_store_n(&seq, static_cast<uint16_t>(seq + 1), __ATOMIC_RELEASE);
+    }
+
+    /**
+     * @brief Completed writes so far (wraps at 65536)
+     *
+     * A write in progress is not counted until writeEnd().
+     */
+    uint16_t version() const {
+        return static_cast<uint16_t>(__atomic_load_n(&seq, __ATOMIC_ACQUIRE) >> 1);
+    }
+
+    /**
+     * @brief Copy @p shared into @p out as one consistent snapshot
+     *
+     * Retries while the writer is inside writeBegin()/writeEnd(). Only fails
+     * if every attempt overlaps a write, i.e. the writer stalled mid-write
+     * (a reader preempting the writer on the writer's own core).
+     *
+     * @param shared Data guarded by this lock
+     * @param out Snapshot (last attempt's copy on failure, possibly torn)
+     * @param version Set to the snapshot's version() if not nullptr
+     * @return true if @p out is consistent
+     */
+    template <typename T>
+    bool read(const T& shared, T& out, uint16_t* version = nullptr) const {
+        return readBytes(&shared, &out, sizeof(T), version);
+    }
+
+    /**
+     * @brief read() for an untyped range of @p size bytes
+     */
+    bool readBytes(const void* shared, void* out, size_t size, uint16_t* version = nullptr) const {
+        for (uint8_t attempt = 0; attempt < SEQLOCK_READ_ATTEMPTS; attempt++) {
+            uint16_t before = readBegin();
+            if (before & 1u) {
+                continue;  // Write in progress
+            }
+
+            memcpy(out, shared, size);
+
+            if (readValid(before)) {
+                if (version != nullptr) {
+                    *version = static_cast<uint16_t>(before >> 1);
+                }
+                return true;
+            }
+        }
+        memcpy(out, shared, size);
+        return false;
+    }
+
+    /**
+     * @brief Start an in-place read: raw counter to pass to readValid()
+     *
+     * For readers that use the guarded data where it lies instead of
+     * copying it (BoatDataView). Odd means a write is in progress.
+     */
+    uint16_t readBegin() const {
+        return __atomic_load_n(&seq, __ATOMIC_ACQUIRE);
+    }
+
+    /**
+     * @brief Whether everything read since readBegin() returned @p begin is consistent
+     *
+     * @return false if a write was in progress at readBegin() or started since
+     */
+    bool readValid(uint16_t begin) const {
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);  // Reads complete before the re-check
+        return !(begin & 1u) && __atomic_load_n(&seq, __ATOMIC_RELAXED) == begin;
+    }
+};
+
+#endif // SEQ_LOCK_H
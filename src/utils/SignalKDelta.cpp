@@ -0,0 +1,141 @@
+/**
+ * @file SignalKDelta.cpp
+ * @brief Implementation of the Signal K delta writer
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "SignalKDelta.h"
+#include "../config.h"
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+constexpr double KN_TO_MS = 1852.0 / 3600.0;
+constexpr double RPM_TO_HZ = 1.0 / 60.0;
+constexpr double PERCENT_TO_RATIO = 0.01;
+constexpr double CELSIUS_TO_KELVIN = 273.15;
+
+// Object members of one path must be consecutive
+const SignalKPathInfo PATHS[] = {
+    {BOATDATA_FIELD_GPS_LATITUDE, "navigation.position", "latitude", 1.0, 0.0, 7},
+    {BOATDATA_FIELD_GPS_LONGITUDE, "navigation.position", "longitude", 1.0, 0.0, 7},
+    {BOATDATA_FIELD_GPS_COG, "navigation.courseOverGroundTrue", nullptr, 1.0, 0.0, 4},
+    {BOATDATA_FIELD_GPS_SOG, "navigation.speedOverGround", nullptr, KN_TO_MS, 0.0, 3},
+    {BOATDATA_FIELD_GPS_VARIATION, "navigation.magneticVariation", nullptr, 1.0, 0.0, 4},
+    {BOATDATA_FIELD_GPS_SATELLITES, "navigation.gnss.satellites", nullptr, 1.0, 0.0, 0},
+    {BOATDATA_FIELD_GPS_HDOP, "navigation.gnss.horizontalDilution", nullptr, 1.0, 0.0, 1},
+    {BOATDATA_FIELD_COMPASS_TRUE_HEADING, "navigation.headingTrue", nullptr, 1.0, 0.0, 4},
+    {BOATDATA_FIELD_COMPASS_MAGNETIC_HEADING, "navigation.headingMagnetic", nullptr, 1.0, 0.0, 4},
+    {BOATDATA_FIELD_COMPASS_RATE_OF_TURN, "navigation.rateOfTurn", nullptr, 1.0, 0.0, 4},
+    {BOATDATA_FIELD_COMPASS_HEEL_ANGLE, "navigation.attitude", "roll", 1.0, 0.0, 4},
+    {BOATDATA_FIELD_COMPASS_PITCH_ANGLE, "navigation.attitude", "pitch", 1.0, 0.0, 4},
+    {BOATDATA_FIELD_WIND_AWA, "environment.wind.angleApparent", nullptr, 1.0, 0.0, 4},
+    {BOATDATA_FIELD_WIND_AWS, "environment.wind.speedApparent", nullptr, KN_TO_MS, 0.0, 3},
+    {BOATDATA_FIELD_DST_DEPTH, "environment.depth.belowTransducer", nullptr, 1.0, 0.0, 2},
+    {BOATDATA_FIELD_DST_BOAT_SPEED, "navigation.speedThroughWater", nullptr, 1.0, 0.0, 2},
+    {BOATDATA_FIELD_DST_SEA_TEMPERATURE, "environment.water.temperature", nullptr, 1.0, CELSIUS_TO_KELVIN, 2},
+    {BOATDATA_FIELD_RUDDER_ANGLE, "steering.rudderAngle", nullptr, 1.0, 0.0, 4},
+    {BOATDATA_FIELD_ENGINE_REV, "propulsion.main.revolutions", nullptr, RPM_TO_HZ, 0.0, 2},
+    {BOATDATA_FIELD_ENGINE_OIL_TEMPERATURE, "propulsion.main.oilTemperature", nullptr, 1.0, CELSIUS_TO_KELVIN, 2},
+    {BOATDATA_FIELD_ENGINE_ALTERNATOR_VOLTAGE, "propulsion.main.alternatorVoltage", nullptr, 1.0, 0.0, 2},
+    {BOATDATA_FIELD_BATTERY_VOLTAGE_A, "electrical.batteries.A.voltage", nullptr, 1.0, 0.0, 2},
+    {BOATDATA_FIELD_BATTERY_AMPERAGE_A, "electrical.batteries.A.current", nullptr, 1.0, 0.0, 1},
+    {BOATDATA_FIELD_BATTERY_SOC_A, "electrical.batteries.A.capacity.stateOfCharge", nullptr, PERCENT_TO_RATIO, 0.0, 3},
+    {BOATDATA_FIELD_BATTERY_VOLTAGE_B, "electrical.batteries.B.voltage", nullptr, 1.0, 0.0, 2},
+    {BOATDATA_FIELD_BATTERY_AMPERAGE_B, "electrical.batteries.B.current", nullptr, 1.0, 0.0, 1},
+    {BOATDATA_FIELD_BATTERY_SOC_B, "electrical.batteries.B.capacity.stateOfCharge", nullptr, PERCENT_TO_RATIO, 0.0, 3},
+    {BOATDATA_FIELD_DERIVED_LEEWAY, "navigation.leewayAngle", nullptr, 1.0, 0.0, 4},
+    {BOATDATA_FIELD_DERIVED_TWS, "environment.wind.speedTrue", nullptr, KN_TO_MS, 0.0, 3},
+    {BOATDATA_FIELD_DERIVED_TWA, "environment.wind.angleTrueWater", nullptr, 1.0, 0.0, 4},
+    {BOATDATA_FIELD_DERIVED_WDIR, "environment.wind.directionMagnetic", nullptr, 1.0, 0.0, 4},
+    {BOATDATA_FIELD_DERIVED_VMG, "performance.velocityMadeGood", nullptr, KN_TO_MS, 0.0, 3},
+    {BOATDATA_FIELD_DERIVED_SOC, "environment.current", "drift", KN_TO_MS, 0.0, 3},
+    {BOATDATA_FIELD_DERIVED_DOC, "environment.current", "setMagnetic", 1.0, 0.0, 4},
+    {BOATDATA_FIELD_DERIVED_POLAR_SPEED, "performance.polarSpeed", nullptr, KN_TO_MS, 0.0, 3},
+    {BOATDATA_FIELD_DERIVED_POLAR_PERFORMANCE, "performance.polarSpeedRatio", nullptr, PERCENT_TO_RATIO, 0.0, 3},
+    {BOATDATA_FIELD_DERIVED_TARGET_TWA, "performance.targetAngle", nullptr, 1.0, 0.0, 4},
+};
+
+constexpr uint8_t PATH_COUNT = sizeof(PATHS) / sizeof(PATHS[0]);
+
+/// Entries [first, end) that share the path of @p first
+uint8_t pathEnd(uint8_t first) {
+    uint8_t end = first + 1;
+    while (PATHS[first].member != nullptr && end < PATH_COUNT && strcmp(PATHS[end].path, PATHS[first].path) == 0) {
+        end++;
+    }
+    return end;
+}
+
+uint16_t groupMask(uint8_t field) {
+    return BoatDataSchema::groupInfo(BoatDataSchema::fieldInfo(field).group).mask;
+}
+
+/// SI value of entry @p index; NaN while its group is unavailable
+double value(const BoatDataStructure& data, uint8_t index) {
+    const SignalKPathInfo& info = PATHS[index];
+    if (!BoatDataSchema::isAvailable(data, BoatDataSchema::fieldInfo(info.field).group)) {
+        return NAN;
+    }
+    return BoatDataSchema::getValue(data, info.field) * info.scale + info.offset;
+}
+
+}  // namespace
+
+namespace SignalKDelta {
+
+uint8_t pathCount() {
+    return PATH_COUNT;
+}
+
+const SignalKPathInfo& pathInfo(uint8_t index) {
+    return PATHS[index < PATH_COUNT ? index : 0];
+}
+
+uint8_t write(JsonWriter& json, const BoatDataStructure& data, const BoatDataDeltaSet& set,
+              const char* timestamp) {
+    json.beginObject().add("context", "vessels.self").beginArray("updates").beginObject();
+    json.beginObject("source").add("label", SIGNALK_SOURCE_LABEL).endObject();
+    if (timestamp != nullptr) {
+        json.add("timestamp", timestamp);
+    }
+    json.beginArray("values");
+
+    uint8_t written = 0;
+    for (uint8_t first = 0; first < PATH_COUNT; first = pathEnd(first)) {
+        uint8_t end = pathEnd(first);
+
+        // A path goes out when one of its fields moved or its group's availability flipped
+        bool send = false;
+        bool anyValue = false;
+        for (uint8_t i = first; i < end; i++) {
+            uint8_t field = PATHS[i].field;
+            send = send || set.has(field) || (set.available & groupMask(field)) != 0;
+            anyValue = anyValue || !isnan(value(data, i));
+        }
+        if (!send || (set.keyframe && !anyValue)) {
+            continue;  // Keyframes leave out paths nobody has seen yet
+        }
+
+        json.beginObject().add("path", PATHS[first].path);
+        if (PATHS[first].member == nullptr || !anyValue) {
+            json.add("value", value(data, first), PATHS[first].decimals);
+        } else {
+            json.beginObject("value");
+            for (uint8_t i = first; i < end; i++) {
+                json.add(PATHS[i].member, value(data, i), PATHS[i].decimals);
+            }
+            json.endObject();
+        }
+        json.endObject();
+        written++;
+    }
+
+    json.endArray().endObject().endArray().endObject();
+    return written;
+}
+
+}  // namespace SignalKDelta
@@ -0,0 +1,72 @@
+/**
+ * @file SignalKDelta.h
+ * @brief Signal K delta messages rendered from the /boatdata delta baseline
+ *
+ * The /signalk/v1/stream WebSocket (Signal K consumers such as KIP or
+ * WilhelmSK) receives one delta message per broadcast tick with the paths
+ * whose fields changed:
+ * @code
+ * {"context":"vessels.self","updates":[{"source":{"label":"poseidon2"},
+ *   "timestamp":"2025-06-01T12:00:00Z",
+ *   "values":[{"path":"navigation.headingMagnetic","value":1.2345}, ...]}]}
+ * @endcode
+ * Changes come from the same BoatDataDeltaEncoder::update() pass as the
+ * /boatdata?mode=delta stream, so the deadbands and keyframe schedule are
+ * shared and a tick compares the data once for both protocols. A keyframe
+ * sends every path of the available groups; a group that becomes
+ * unavailable sends its paths as null.
+ *
+ * Paths and unit conversions (Signal K uses SI: m/s, K, Hz, ratios) are
+ * the static table in SignalKDelta.cpp. Fields with no Signal K path
+ * (AWA offsets, charger flags, statistics, ...) are not sent. Paths with
+ * an object value (navigation.position, navigation.attitude,
+ * environment.current) list one entry per member, consecutively.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): table in flash (const), no allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef SIGNALK_DELTA_H
+#define SIGNALK_DELTA_H
+
+#include <stdint.h>
+#include "BoatDataDelta.h"
+#include "JsonWriter.h"
+
+/**
+ * @brief One Signal K path (or object member) fed by a BoatData field
+ */
+struct SignalKPathInfo {
+    uint8_t field;          ///< BoatDataFieldId
+    const char* path;       ///< Signal K path below vessels.self
+    const char* member;     ///< Member of an object value, nullptr for a plain number
+    double scale;           ///< SI value = field * scale + offset
+    double offset;
+    uint8_t decimals;       ///< JSON output precision
+};
+
+namespace SignalKDelta {
+
+/// Entries in the path table
+uint8_t pathCount();
+
+/// Entry @p index (< pathCount())
+const SignalKPathInfo& pathInfo(uint8_t index);
+
+/**
+ * @brief Write the Signal K delta message for @p set
+ *
+ * @param timestamp ISO 8601 UTC time of the update, nullptr to omit it (no clock yet)
+ * @return Values written (0 = nothing changed on a mapped path; the message is still valid)
+ */
+uint8_t write(JsonWriter& json, const BoatDataStructure& data, const BoatDataDeltaSet& set,
+              const char* timestamp);
+
+}  // namespace SignalKDelta
+
+#endif // SIGNALK_DELTA_H
@@ -0,0 +1,196 @@
+/**
+ * @file SoakMonitor.cpp
+ * @brief Implementation of the soak sample window and trend test
+ */
+
+#include "SoakMonitor.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+struct ColumnInfo {
+    const char* name;
+    int8_t badDirection;
+    uint32_t minChange;
+};
+
+// Indexed by SoakColumn
+const ColumnInfo COLUMN_INFO[SoakSample::COLUMNS] = {
+    {"heap_free", -1, 2048},
+    {"heap_largest", -1, 2048},
+    {"heap_min", -1, 1024},
+    {"loop_p50_us", 1, 50},
+    {"loop_p99_us", 1, 200},
+    {"loop_max_us", 1, 1000},
+    {"can_dropped", 1, 1},
+    {"uart_dropped", 1, 1},
+    {"ws_dropped", 1, 1},
+    {"log_dropped", 1, 1},
+    {"heap_failed", 1, 1},
+};
+
+}  // namespace
+
+SoakMonitor::SoakMonitor() {
+    reset();
+}
+
+void SoakMonitor::reset() {
+    memset(window_, 0, sizeof(window_));
+    head_ = 0;
+    filled_ = 0;
+    samples_ = 0;
+    flagged_ = 0;
+    memset(tauPct_, 0, sizeof(tauPct_));
+    memset(change_, 0, sizeof(change_));
+}
+
+const SoakSample& SoakMonitor::at(uint8_t age) const {
+    uint8_t oldest = filled_ < WINDOW ? 0 : head_;
+    return window_[(oldest + age) % WINDOW];
+}
+
+const SoakSample* SoakMonitor::last() const {
+    return filled_ > 0 ? &window_[(head_ + WINDOW - 1) % WINDOW] : nullptr;
+}
+
+uint16_t SoakMonitor::add(const SoakSample& sample) {
+    window_[head_] = sample;
+    head_ = (head_ + 1) % WINDOW;
+    if (filled_ < WINDOW) {
+        filled_++;
+    }
+    samples_++;
+    if (filled_ < WINDOW) {
+        return 0;
+    }
+
+    uint16_t raised = 0;
+    for (uint8_t c = 0; c < SoakSample::COLUMNS; c++) {
+        if (test(c)) {
+            raised |= static_cast<uint16_t>(1u << c);
+        }
+    }
+    return raised;
+}
+
+bool SoakMonitor::test(uint8_t column) {
+    // Mann-Kendall S: rising minus falling pairs (ties count for neither)
+    int32_t s = 0;
+    for (uint8_t i = 0; i + 1 < WINDOW; i++) {
+        uint32_t earlier = at(i).values[column];
+        for (uint8_t j = i + 1; j < WINDOW; j++) {
+            uint32_t later = at(j).values[column];
+            s += later > earlier ? 1 : (later < earlier ? -1 : 0);
+        }
+    }
+    const int32_t pairs = WINDOW * (WINDOW - 1) / 2;
+    tauPct_[column] = static_cast<int8_t>((s * 100 + (s >= 0 ? pairs / 2 : -pairs / 2)) / pairs);
+    change_[column] = static_cast<int64_t>(at(WINDOW - 1).values[column]) - at(0).values[column];
+
+    const ColumnInfo& info = COLUMN_INFO[column];
+    int32_t badTau = tauPct_[column] * info.badDirection;
+    int64_t badChange = change_[column] * info.badDirection;
+    uint16_t bit = static_cast<uint16_t>(1u << column);
+
+    if (flagged_ & bit) {
+        if (badTau < SOAK_TREND_CLEAR_PCT) {
+            flagged_ &= static_cast<uint16_t>(~bit);
+        }
+        return false;
+    }
+    if (badTau >= SOAK_TREND_FLAG_PCT && badChange >= static_cast<int64_t>(info.minChange)) {
+        flagged_ |= bit;
+        return true;
+    }
+    return false;
+}
+
+const char* SoakMonitor::columnName(SoakColumn column) {
+    uint8_t index = static_cast<uint8_t>(column);
+    return index < SoakSample::COLUMNS ? COLUMN_INFO[index].name : "unknown";
+}
+
+int8_t SoakMonitor::badDirection(SoakColumn column) {
+    uint8_t index = static_cast<uint8_t>(column);
+    return index < SoakSample::COLUMNS ? COLUMN_INFO[index].badDirection : 0;
+}
+
+uint32_t SoakMonitor::minChange(SoakColumn column) {
+    uint8_t index = static_cast<uint8_t>(column);
+    return index < SoakSample::COLUMNS ? COLUMN_INFO[index].minChange : 0;
+}
+
+size_t SoakMonitor::writeCsvHeader(char* buffer, size_t capacity) {
+    size_t len = 0;
+    int n = snprintf(buffer, capacity, "uptime_s");
+    if (n < 0 || static_cast<size_t>(n) >= capacity) {
+        return 0;
+    }
+    len = static_cast<size_t>(n);
+    for (uint8_t c = 0; c < SoakSample::COLUMNS; c++) {
+        n = snprintf(buffer + len, capacity - len, ",%s", COLUMN_INFO[c].name);
+        if (n < 0 || static_cast<size_t>(n) >= capacity - len) {
+            return 0;
+        }
+        len += static_cast<size_t>(n);
+    }
+    if (len + 1 >= capacity) {
+        return 0;
+    }
+    buffer[len++] = '\n';
+    buffer[len] = '\0';
+    return len;
+}
+
+size_t SoakMonitor::writeCsvRow(const SoakSample& sample, char* buffer, size_t capacity) {
+    size_t len = 0;
+    int n = snprintf(buffer, capacity, "%lu", (unsigned long)sample.uptimeS);
+    if (n < 0 || static_cast<size_t>(n) >= capacity) {
+        return 0;
+    }
+    len = static_cast<size_t>(n);
+    for (uint8_t c = 0; c < SoakSample::COLUMNS; c++) {
+        n = snprintf(buffer + len, capacity - len, ",%lu", (unsigned long)sample.values[c]);
+        if (n < 0 || static_cast<size_t>(n) >= capacity - len) {
+            return 0;
+        }
+        len += static_cast<size_t>(n);
+    }
+    if (len + 1 >= capacity) {
+        return 0;
+    }
+    buffer[len++] = '\n';
+    buffer[len] = '\0';
+    return len;
+}
+
+void SoakMonitor::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("samples", (unsigned long)samples_)
+        .add("window", (unsigned int)WINDOW)
+        .beginArray("flagged");
+    for (uint8_t c = 0; c < SoakSample::COLUMNS; c++) {
+        if (flagged_ & (1u << c)) {
+            json.add(COLUMN_INFO[c].name);
+        }
+    }
+    json.endArray().beginArray("columns");
+
+    const SoakSample* newest = last();
+    for (uint8_t c = 0; c < SoakSample::COLUMNS; c++) {
+        json.beginObject()
+            .add("name", COLUMN_INFO[c].name)
+            .add("last", (unsigned long)(newest != nullptr ? newest->values[c] : 0))
+            .add("change", (double)change_[c], 0)
+            .add("tau", tauPct_[c] / 100.0, 2)
+            .add("trend", (flagged_ & (1u << c)) != 0)
+            .endObject();
+    }
+    json.endArray().endObject();
+}
@@ -0,0 +1,169 @@
+/**
+ * @file SoakMonitor.h
+ * @brief Soak run samples: CSV rows and automatic monotonic trend flags
+ *
+ * Bugs that take days (heap leaks, fragmentation, counters that only ever
+ * grow) show up as a slow drift of one metric. A soak run takes one
+ * SoakSample per minute (SoakRecorder writes it to LittleFS as a CSV row);
+ * this class keeps the last SOAK_TREND_WINDOW samples and tests each column
+ * for a monotonic trend in its bad direction:
+ * - heap_free, heap_largest, heap_min falling
+ * - loop latency percentiles rising
+ * - drop counters rising (drops that keep happening, not one burst)
+ *
+ * The test is Mann-Kendall: Kendall's tau of the column against time,
+ * the share of sample pairs that moved in the bad direction minus the share
+ * that moved in the good one. Noise around a flat line stays near 0; a leak
+ * under noise stays near 1. A column is flagged when tau reaches
+ * SOAK_TREND_FLAG_PCT and the change over the window reaches the column's
+ * minimum (so a few bytes of drift are not a leak), and cleared once tau
+ * falls below SOAK_TREND_CLEAR_PCT.
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed sample window, no heap
+ * - Principle V (Observability): trends flagged while the soak runs, GET /soak
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef SOAK_MONITOR_H
+#define SOAK_MONITOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Columns of a soak sample (CSV order after uptime_s)
+ */
+enum class SoakColumn : uint8_t {
+    HEAP_FREE = 0,    ///< Free heap (bytes)
+    HEAP_LARGEST,     ///< Largest free block (bytes)
+    HEAP_MIN,         ///< Lowest free heap since boot (bytes)
+    LOOP_P50_US,      ///< Loop iteration percentiles of the last window
+    LOOP_P99_US,
+    LOOP_MAX_US,
+    CAN_DROPPED,      ///< CAN frames dropped (receive queue full), since boot
+    UART_DROPPED,     ///< NMEA 0183 sentences dropped by the UART ports, since boot
+    WS_DROPPED,       ///< WebSocket frames dropped for lack of a send buffer, since boot
+    LOG_DROPPED,      ///< Log messages dropped (queue full), since boot
+    HEAP_FAILED,      ///< Failed heap allocations, since boot
+    COUNT
+};
+
+/**
+ * @brief One snapshot of the soak columns
+ */
+struct SoakSample {
+    static constexpr uint8_t COLUMNS = static_cast<uint8_t>(SoakColumn::COUNT);
+
+    uint32_t uptimeS;
+    uint32_t values[COLUMNS];
+
+    uint32_t get(SoakColumn column) const { return values[static_cast<uint8_t>(column)]; }
+    void set(SoakColumn column, uint32_t value) { values[static_cast<uint8_t>(column)] = value; }
+};
+
+/**
+ * @class SoakMonitor
+ * @brief Sample window with per-column Mann-Kendall trend flags
+ *
+ * Usage pattern:
+ * @code
+ * SoakSample sample = {};
+ * sample.uptimeS = millis() / 1000;
+ * sample.set(SoakColumn::HEAP_FREE, ESP.getFreeHeap());
+ * ...
+ * uint16_t raised = monitor.add(sample);
+ * for (uint8_t c = 0; c < SoakSample::COLUMNS; c++) {
+ *     if (raised & (1u << c)) { ... WARN SOAK_TREND ... }
+ * }
+ * @endcode
+ */
+class SoakMonitor {
+public:
+    static constexpr uint8_t WINDOW = SOAK_TREND_WINDOW;
+
+    static_assert(SoakSample::COLUMNS <= 16, "flag masks are 16 bits");
+    static_assert(SOAK_TREND_WINDOW >= 3, "SOAK_TREND_WINDOW too small for a trend");
+
+    SoakMonitor();
+
+    /**
+     * @brief Add the next sample and re-test the columns
+     * @return Columns flagged by this sample (bit = column index)
+     */
+    uint16_t add(const SoakSample& sample);
+
+    /// Columns currently flagged (bit = column index)
+    uint16_t getFlagged() const { return flagged_; }
+
+    bool isFlagged(SoakColumn column) const { return (flagged_ >> static_cast<uint8_t>(column)) & 1; }
+
+    /**
+     * @brief Kendall's tau of @p column over the window, in percent
+     *
+     * Positive = rising. 0 until the window is full.
+     */
+    int8_t getTauPct(SoakColumn column) const { return tauPct_[static_cast<uint8_t>(column)]; }
+
+    /// Newest minus oldest value of @p column in the window (0 until the window is full)
+    int64_t getChange(SoakColumn column) const { return change_[static_cast<uint8_t>(column)]; }
+
+    /// Samples added since construction or reset()
+    uint32_t getSamples() const { return samples_; }
+
+    /// Newest sample, nullptr before the first
+    const SoakSample* last() const;
+
+    void reset();
+
+    /// CSV name of @p column ("heap_free", ...)
+    static const char* columnName(SoakColumn column);
+
+    /// +1 when rising is bad, -1 when falling is
+    static int8_t badDirection(SoakColumn column);
+
+    /// Smallest change over the window, in the bad direction, that is flagged
+    static uint32_t minChange(SoakColumn column);
+
+    /**
+     * @brief "uptime_s,heap_free,...\n"
+     * @return Length written, 0 if @p capacity is too small
+     */
+    static size_t writeCsvHeader(char* buffer, size_t capacity);
+
+    /**
+     * @brief "86400,143212,...\n"
+     * @return Length written, 0 if @p capacity is too small
+     */
+    static size_t writeCsvRow(const SoakSample& sample, char* buffer, size_t capacity);
+
+    /**
+     * @brief Window state per column
+     *
+     * {"samples":1440,"window":30,"flagged":["heap_free"],"columns":[{"name":"heap_free",
+     *  "last":143212,"change":-6144,"tau":-0.91,"trend":true},...]}
+     *
+     * @param key Member name in the enclosing object, or nullptr
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    SoakSample window_[WINDOW];
+    uint8_t head_;       ///< Next slot
+    uint8_t filled_;
+    uint32_t samples_;
+    uint16_t flagged_;
+    int8_t tauPct_[SoakSample::COLUMNS];
+    int64_t change_[SoakSample::COLUMNS];
+
+    const SoakSample& at(uint8_t age) const;  ///< 0 = oldest in the window
+    bool test(uint8_t column);  ///< true when the column became flagged
+};
+
+#endif // SOAK_MONITOR_H
@@ -0,0 +1,197 @@
+/**
+ * @file SourceFusion.cpp
+ * @brief Implementation of the weighted source blends
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "SourceFusion.h"
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+constexpr double FULL_CIRCLE = 2.0 * M_PI;
+constexpr double METERS_PER_DEGREE = 111320.0;
+constexpr double RADIANS_PER_DEGREE = M_PI / 180.0;
+
+/// Longitude difference wrapped to [-180, 180]
+double wrapLongitude(double delta) {
+    while (delta > 180.0) delta -= 360.0;
+    while (delta < -180.0) delta += 360.0;
+    return delta;
+}
+
+}  // namespace
+
+// =============================================================================
+// SourceFusionTable
+// =============================================================================
+
+SourceFusionTable::SourceFusionTable() {
+    reset();
+}
+
+void SourceFusionTable::reset() {
+    memset(readings_, 0, sizeof(readings_));
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        readings_[i].source = -1;
+    }
+    valid_ = false;
+    contributors_ = 0;
+    gated_ = 0;
+}
+
+SourceFusionTable::Reading& SourceFusionTable::slot(int source) {
+    int oldest = 0;
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        if (readings_[i].source == source || readings_[i].source < 0) {
+            return readings_[i];
+        }
+        if (readings_[i].time < readings_[oldest].time) {
+            oldest = i;
+        }
+    }
+    return readings_[oldest];
+}
+
+bool SourceFusionTable::usable(const Reading& r, unsigned long now) {
+    return r.source >= 0 && r.weight > 0.0 && now - r.time <= SOURCE_FUSION_MAX_AGE_MS;
+}
+
+// =============================================================================
+// AngleFusion
+// =============================================================================
+
+double AngleFusion::update(int source, double angle, double weight, unsigned long now) {
+    Reading& in = slot(source);
+    in.source = static_cast<int8_t>(source);
+    in.time = now;
+    in.weight = weight > 0.0 ? weight : 0.0;
+    in.x = sin(angle);
+    in.y = cos(angle);
+
+    // Inside the gate: cos(difference) = sin·sin_ref + cos·cos_ref >= cos(gate)
+    static const double cosGate = cos(SOURCE_FUSION_HEADING_GATE_RAD);
+    double refSin = valid_ ? sin_ : in.x;
+    double refCos = valid_ ? cos_ : in.y;
+
+    // Weight inside and outside the gate; the outside outweighs: re-reference once
+    double inside = 0.0, outside = 0.0;
+    int heaviest = -1;
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        const Reading& r = readings_[i];
+        if (!usable(r, now)) continue;
+        if (r.x * refSin + r.y * refCos >= cosGate) {
+            inside += r.weight;
+        } else {
+            outside += r.weight;
+            if (heaviest < 0 || r.weight > readings_[heaviest].weight) heaviest = i;
+        }
+    }
+    if (outside > inside) {
+        refSin = readings_[heaviest].x;
+        refCos = readings_[heaviest].y;
+    }
+
+    double sumSin = 0.0, sumCos = 0.0;
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        const Reading& r = readings_[i];
+        if (!usable(r, now) || r.x * refSin + r.y * refCos < cosGate) continue;
+        sumSin += r.weight * r.x;
+        sumCos += r.weight * r.y;
+        count++;
+    }
+    if (in.x * refSin + in.y * refCos < cosGate) {
+        gated_++;
+    }
+
+    double length = sqrt(sumSin * sumSin + sumCos * sumCos);
+    if (count == 0 || length <= 0.0) {
+        sin_ = in.x;    // Nothing to blend: pass the reading through
+        cos_ = in.y;
+    } else {
+        sin_ = sumSin / length;
+        cos_ = sumCos / length;
+    }
+    contributors_ = count;
+    valid_ = true;
+    return getValue();
+}
+
+double AngleFusion::getValue() const {
+    double angle = atan2(sin_, cos_);
+    return angle < 0.0 ? angle + FULL_CIRCLE : angle;
+}
+
+// =============================================================================
+// PositionFusion
+// =============================================================================
+
+void PositionFusion::update(int source, double& latitude, double& longitude, double weight, unsigned long now) {
+    Reading& in = slot(source);
+    in.source = static_cast<int8_t>(source);
+    in.time = now;
+    in.weight = weight > 0.0 ? weight : 0.0;
+    in.x = latitude;
+    in.y = longitude;
+
+    double refLat = valid_ ? latitude_ : in.x;
+    double refLon = valid_ ? longitude_ : in.y;
+    const double gate2 = SOURCE_FUSION_POSITION_GATE_M * SOURCE_FUSION_POSITION_GATE_M;
+
+    // Distance² (m²) from the reference, equirectangular (gate-sized distances)
+    double lonScale = METERS_PER_DEGREE * cos(refLat * RADIANS_PER_DEGREE);
+    auto distance2 = [&](const Reading& r) {
+        double dy = (r.x - refLat) * METERS_PER_DEGREE;
+        double dx = wrapLongitude(r.y - refLon) * lonScale;
+        return dx * dx + dy * dy;
+    };
+
+    double inside = 0.0, outside = 0.0;
+    int heaviest = -1;
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        const Reading& r = readings_[i];
+        if (!usable(r, now)) continue;
+        if (distance2(r) <= gate2) {
+            inside += r.weight;
+        } else {
+            outside += r.weight;
+            if (heaviest < 0 || r.weight > readings_[heaviest].weight) heaviest = i;
+        }
+    }
+    if (outside > inside) {
+        refLat = readings_[heaviest].x;
+        refLon = readings_[heaviest].y;
+        lonScale = METERS_PER_DEGREE * cos(refLat * RADIANS_PER_DEGREE);
+    }
+
+    double sumWeight = 0.0, sumLat = 0.0, sumLon = 0.0;
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        const Reading& r = readings_[i];
+        if (!usable(r, now) || distance2(r) > gate2) continue;
+        sumWeight += r.weight;
+        sumLat += r.weight * (r.x - refLat);
+        sumLon += r.weight * wrapLongitude(r.y - refLon);
+        count++;
+    }
+    if (distance2(in) > gate2) {
+        gated_++;
+    }
+
+    if (count == 0 || sumWeight <= 0.0) {
+        latitude_ = in.x;    // Nothing to blend: pass the reading through
+        longitude_ = in.y;
+    } else {
+        latitude_ = refLat + sumLat / sumWeight;
+        longitude_ = wrapLongitude(refLon + sumLon / sumWeight);
+    }
+    contributors_ = count;
+    valid_ = true;
+
+    latitude = latitude_;
+    longitude = longitude_;
+}
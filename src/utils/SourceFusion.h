@@ -0,0 +1,156 @@
+/**
+ * @file SourceFusion.h
+ * @brief Weighted blending of redundant GPS and heading sources
+ *
+ * Selecting one source makes the output jump whenever the prioritizer
+ * switches between two good sensors. In blend mode (SOURCE_FUSION_MODE 1)
+ * BoatData instead combines the last reading of every fresh source:
+ *
+ * - AngleFusion: circular weighted mean (Σ w·sin, Σ w·cos) for headings and
+ *   COG, so 359° and 1° blend to 0°, not 180°.
+ * - PositionFusion: weighted mean of latitude and longitude offsets from a
+ *   reference (longitude wrapped at ±180°).
+ * - Weights: the source's quality from SourcePrioritizer (fix, HDOP,
+ *   satellites, rejections, jitter); 0 leaves a source out.
+ * - Freshness: a reading older than SOURCE_FUSION_MAX_AGE_MS is left out.
+ * - Outlier gating: readings further than the gate (SOURCE_FUSION_HEADING_GATE_RAD,
+ *   SOURCE_FUSION_POSITION_GATE_M) from the previous blend are left out;
+ *   if they outweigh the readings inside the gate, the heaviest of them
+ *   becomes the new reference instead (the blend follows the majority).
+ * - No usable reading at all: the incoming reading is passed through.
+ *
+ * Each update is O(sources) over a fixed table of MAX_SOURCES_PER_TYPE
+ * readings (sin/cos stored once per reading, one atan2 per blend).
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * AngleFusion heading;
+ * double blended = heading.update(sourceIndex, radians, quality, millis());
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed tables, no heap
+ * - Principle VII (Fail-Safe): with nothing to blend the reading passes through unchanged
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef SOURCE_FUSION_H
+#define SOURCE_FUSION_H
+
+#include <stdint.h>
+#include "../config.h"
+#include "../types/BoatDataTypes.h"
+
+/**
+ * @brief How BoatData combines redundant GPS and compass sources
+ */
+enum class SourceFusionMode : uint8_t {
+    SELECT = 0,   ///< Only the prioritizer's active source is used (default)
+    BLEND = 1     ///< Position, COG and headings of all fresh sources are blended
+};
+
+/**
+ * @brief Last reading of each source (shared slot table)
+ */
+class SourceFusionTable {
+public:
+    static constexpr uint8_t SLOTS = MAX_SOURCES_PER_TYPE;
+
+    /// Sources in the last blend
+    uint8_t getContributors() const { return contributors_; }
+
+    /// Updates whose own reading was gated out as an outlier
+    uint32_t getGated() const { return gated_; }
+
+    /// The last blend exists
+    bool isValid() const { return valid_; }
+
+    /// Forget all readings and the last blend
+    void reset();
+
+protected:
+    struct Reading {
+        int8_t source;          ///< Source index (-1 = free)
+        unsigned long time;     ///< millis() of the reading
+        double weight;          ///< Quality weight (0-1)
+        double x;               ///< sin(angle) or latitude (degrees)
+        double y;               ///< cos(angle) or longitude (degrees)
+    };
+
+    SourceFusionTable();
+
+    /// Slot for @p source: its own, a free one, or the oldest
+    Reading& slot(int source);
+
+    /// Reading is fresh and weighted
+    static bool usable(const Reading& r, unsigned long now);
+
+    Reading readings_[SLOTS];
+    bool valid_;
+    uint8_t contributors_;
+    uint32_t gated_;
+};
+
+/**
+ * @class AngleFusion
+ * @brief Circular weighted mean of angles (radians)
+ *
+ * Single-threaded (BoatData's applying context).
+ */
+class AngleFusion : public SourceFusionTable {
+public:
+    AngleFusion() : sin_(0.0), cos_(1.0) {}
+
+    /**
+     * @brief Record a reading and return the blend
+     *
+     * @param source Prioritizer source index
+     * @param angle Radians
+     * @param weight Quality (0-1)
+     * @param now millis()
+     * @return Blended angle [0, 2π)
+     */
+    double update(int source, double angle, double weight, unsigned long now);
+
+    /// Last blend [0, 2π)
+    double getValue() const;
+
+private:
+    double sin_;    ///< sin/cos of the last blend (the gate reference)
+    double cos_;
+};
+
+/**
+ * @class PositionFusion
+ * @brief Weighted mean of positions (decimal degrees)
+ *
+ * Single-threaded (BoatData's applying context).
+ */
+class PositionFusion : public SourceFusionTable {
+public:
+    PositionFusion() : latitude_(0.0), longitude_(0.0) {}
+
+    /**
+     * @brief Record a reading and blend
+     *
+     * @param source Prioritizer source index
+     * @param latitude In: the reading; out: the blend
+     * @param longitude In: the reading; out: the blend [-180, 180]
+     * @param weight Quality (0-1)
+     * @param now millis()
+     */
+    void update(int source, double& latitude, double& longitude, double weight, unsigned long now);
+
+    double getLatitude() const { return latitude_; }
+    double getLongitude() const { return longitude_; }
+
+private:
+    double latitude_;    ///< Last blend (the gate reference)
+    double longitude_;
+};
+
+#endif // SOURCE_FUSION_H
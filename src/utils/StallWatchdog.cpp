@@ -0,0 +1,274 @@
+/**
+ * @file StallWatchdog.cpp
+ * @brief Implementation of the stall watchdog and its RTC-memory record
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "StallWatchdog.h"
+#include "TraceRecorder.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef ARDUINO
+#include <esp_attr.h>
+#include <esp_debug_helpers.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/xtensa_context.h>
+#include <soc/cpu.h>
+
+RTC_NOINIT_ATTR static StallRecord rtcStallRecord;
+
+StallRecord& StallWatchdog::rtcStorage() {
+    return rtcStallRecord;
+}
+
+uint8_t StallWatchdog::captureBacktrace(void* task, uint32_t* pcs, uint8_t maxDepth) {
+    TaskHandle_t handle = static_cast<TaskHandle_t>(task);
+    if (handle == nullptr || maxDepth == 0) {
+        return 0;
+    }
+    auto running = [handle]() {
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; core++) {
+            if (xTaskGetCurrentTaskHandleForCPU(core) == handle) {
+                return true;
+            }
+        }
+        return false;
+    };
+    if (running()) {
+        return 0;  // No saved context: the registers are live on the other core
+    }
+
+    // pxTopOfStack is the first TCB member (the port's context switch relies on it)
+    const void* top = *reinterpret_cast<void* const volatile*>(handle);
+    const XtExcFrame* frame = static_cast<const XtExcFrame*>(top);
+    esp_backtrace_frame_t walk = {};
+    if (frame->exit == 0) {
+        // Solicited switch (blocking call): the short frame of _frxt_dispatch
+        const XtSolFrame* solicited = static_cast<const XtSolFrame*>(top);
+        walk.pc = solicited->pc;
+        walk.sp = solicited->a1;
+        walk.next_pc = solicited->a0;
+    } else {
+        walk.pc = frame->pc;
+        walk.sp = frame->a1;
+        walk.next_pc = frame->a0;
+    }
+
+    uint8_t depth = 0;
+    pcs[depth++] = esp_cpu_process_stack_pc(walk.pc);
+    while (depth < maxDepth && walk.next_pc != 0 && esp_backtrace_get_next_frame(&walk)) {
+        pcs[depth++] = esp_cpu_process_stack_pc(walk.pc);
+    }
+
+    // The task ran meanwhile: the walk may have read a changing stack
+    if (running() || *reinterpret_cast<void* const volatile*>(handle) != top) {
+        return 0;
+    }
+    return depth;
+}
+#endif
+
+StallWatchdog::StallWatchdog(StallRecord& storage)
+    : count_(0), storage_(storage), hasPrevious_(false), recorded_(false), recordedSlot_(0), recordedEntry_(0) {
+    hasPrevious_ = storage.magic == MAGIC && storage.check == checksum(storage) &&
+                   storage.depth <= STALL_BACKTRACE_DEPTH;
+    if (hasPrevious_) {
+        previous_ = storage;
+        // Record may have been cut short by the reset - force termination
+        previous_.slot[sizeof(previous_.slot) - 1] = '\0';
+        previous_.activity[sizeof(previous_.activity) - 1] = '\0';
+    } else {
+        memset(&previous_, 0, sizeof(previous_));
+    }
+    memset(&storage_, 0, sizeof(storage_));
+}
+
+int8_t StallWatchdog::addSlot(const char* name, uint32_t timeoutMs) {
+    if (count_ >= STALL_WATCH_SLOTS) {
+        return -1;
+    }
+    Slot& slot = slots_[count_];
+    slot.name = name;
+    slot.timeoutMs = timeoutMs;
+    slot.task.store(nullptr, std::memory_order_relaxed);
+    slot.core = UNKNOWN_CORE;
+    slot.activity.store(nullptr, std::memory_order_relaxed);
+    slot.enteredMs.store(0, std::memory_order_relaxed);
+    slot.entry.store(0, std::memory_order_relaxed);
+    slot.reportedEntry = 0;
+    slot.stalls = 0;
+    return static_cast<int8_t>(count_++);
+}
+
+void StallWatchdog::setTask(uint8_t slot, void* task, uint8_t core) {
+    if (slot < count_) {
+        slots_[slot].core = core;
+        slots_[slot].task.store(task, std::memory_order_release);
+    }
+}
+
+void StallWatchdog::enter(uint8_t slot, const char* activity, uint32_t nowMs) {
+    if (slot >= count_) {
+        return;
+    }
+    Slot& s = slots_[slot];
+    s.enteredMs.store(nowMs, std::memory_order_relaxed);
+    s.entry.fetch_add(1, std::memory_order_release);
+    s.activity.store(activity, std::memory_order_release);
+}
+
+void StallWatchdog::exit(uint8_t slot) {
+    if (slot < count_) {
+        slots_[slot].activity.store(nullptr, std::memory_order_release);
+    }
+}
+
+int8_t StallWatchdog::check(uint32_t nowMs) {
+    for (uint8_t i = 0; i < count_; i++) {
+        Slot& s = slots_[i];
+        if (s.activity.load(std::memory_order_acquire) == nullptr) {
+            continue;
+        }
+        uint32_t entry = s.entry.load(std::memory_order_acquire);
+        // Signed: a task may enter() with a millis() read later than nowMs
+        int32_t runningMs = static_cast<int32_t>(nowMs - s.enteredMs.load(std::memory_order_relaxed));
+        if (entry == s.reportedEntry || runningMs < static_cast<int32_t>(s.timeoutMs)) {
+            continue;
+        }
+        s.reportedEntry = entry;
+        s.stalls++;
+        return static_cast<int8_t>(i);
+    }
+    return -1;
+}
+
+void StallWatchdog::recordStall(uint8_t slot, uint32_t nowMs, uint8_t traceId, const uint32_t* pcs, uint8_t depth) {
+    if (slot >= count_) {
+        return;
+    }
+    const Slot& s = slots_[slot];
+    const char* activity = s.activity.load(std::memory_order_acquire);
+
+    memset(&storage_, 0, sizeof(storage_));
+    storage_.enteredMs = s.enteredMs.load(std::memory_order_relaxed);
+    storage_.detectedMs = nowMs;
+    storage_.depth = depth < STALL_BACKTRACE_DEPTH ? depth : STALL_BACKTRACE_DEPTH;
+    for (uint8_t i = 0; i < storage_.depth; i++) {
+        storage_.pcs[i] = pcs[i];
+    }
+    storage_.traceId = traceId;
+    storage_.core = s.core;
+    strncpy(storage_.slot, s.name != nullptr ? s.name : "", sizeof(storage_.slot) - 1);
+    strncpy(storage_.activity, activity != nullptr ? activity : "", sizeof(storage_.activity) - 1);
+    storage_.magic = MAGIC;
+    storage_.check = checksum(storage_);
+
+    recorded_ = true;
+    recordedSlot_ = slot;
+    recordedEntry_ = s.reportedEntry;
+}
+
+bool StallWatchdog::resetDue(uint32_t nowMs) const {
+    if (STALL_RESET_MS == 0 || !recorded_) {
+        return false;
+    }
+    const Slot& s = slots_[recordedSlot_];
+    return s.activity.load(std::memory_order_acquire) != nullptr &&
+           s.entry.load(std::memory_order_acquire) == recordedEntry_ &&
+           static_cast<int32_t>(nowMs - storage_.enteredMs) >= static_cast<int32_t>(STALL_RESET_MS);
+}
+
+void StallWatchdog::markReset() {
+    if (recorded_) {
+        storage_.reset = 1;
+        storage_.check = checksum(storage_);
+    }
+}
+
+uint32_t StallWatchdog::checksum(const StallRecord& record) {
+    // FNV-1a over everything after the check word
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&record) + offsetof(StallRecord, enteredMs);
+    size_t len = sizeof(StallRecord) - offsetof(StallRecord, enteredMs);
+    uint32_t hash = 2166136261u ^ record.magic;
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void StallWatchdog::formatBacktrace(const StallRecord& record, char* buffer, size_t size) {
+    if (size == 0) {
+        return;
+    }
+    buffer[0] = '\0';
+    size_t pos = 0;
+    uint8_t depth = record.depth < STALL_BACKTRACE_DEPTH ? record.depth : STALL_BACKTRACE_DEPTH;
+    for (uint8_t i = 0; i < depth; i++) {
+        int written = snprintf(buffer + pos, size - pos, i == 0 ? "0x%08lx" : " 0x%08lx",
+                               (unsigned long)record.pcs[i]);
+        if (written < 0 || static_cast<size_t>(written) >= size - pos) {
+            buffer[pos] = '\0';  // Keep whole addresses only
+            return;
+        }
+        pos += static_cast<size_t>(written);
+    }
+}
+
+void StallWatchdog::writeRecord(JsonWriter& json, const char* key, const StallRecord& record) {
+    char backtrace[STALL_BACKTRACE_DEPTH * 11 + 1];
+    formatBacktrace(record, backtrace, sizeof(backtrace));
+
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("slot", record.slot)
+        .add("activity", record.activity)
+        .add("trace", record.traceId < static_cast<uint8_t>(TraceId::COUNT) ? TraceRecorder::name(record.traceId)
+                                                                            : nullptr);
+    if (record.core == UNKNOWN_CORE) {
+        json.addRaw("core", "null");
+    } else {
+        json.add("core", (unsigned int)record.core);
+    }
+    json.add("entered_ms", (unsigned long)record.enteredMs)
+        .add("stalled_ms", (unsigned long)(record.detectedMs - record.enteredMs))
+        .add("reset", record.reset != 0)
+        .add("backtrace", backtrace)
+        .endObject();
+}
+
+bool StallWatchdog::writeStats(JsonWriter& json, uint32_t nowMs) const {
+    json.beginObject().beginArray("slots");
+    for (uint8_t i = 0; i < count_; i++) {
+        const Slot& s = slots_[i];
+        const char* activity = s.activity.load(std::memory_order_acquire);
+        json.beginObject()
+            .add("name", s.name)
+            .add("timeout_ms", (unsigned long)s.timeoutMs)
+            .add("stalls", (unsigned long)s.stalls)
+            .add("activity", activity);
+        if (activity != nullptr) {
+            json.add("running_ms", (unsigned long)(nowMs - s.enteredMs.load(std::memory_order_relaxed)));
+        }
+        json.endObject();
+    }
+    json.endArray();
+    if (recorded_) {
+        writeRecord(json, "stall", storage_);
+    } else {
+        json.addRaw("stall", "null");
+    }
+    if (hasPrevious_) {
+        writeRecord(json, "previous_boot", previous_);
+    } else {
+        json.addRaw("previous_boot", "null");
+    }
+    json.endObject();
+    return !json.overflowed();
+}
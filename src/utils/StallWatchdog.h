@@ -0,0 +1,211 @@
+/**
+ * @file StallWatchdog.h
+ * @brief Software watchdog over main-loop reactions and I/O tasks, with a reset-surviving stall record
+ *
+ * A reaction that hangs on a blocking LittleFS write or I2C transfer used to
+ * show up only as a hardware watchdog reset, with no hint of where it hung.
+ * Each watched context (the main loop, the NMEA2000 and 1-Wire tasks) owns
+ * a slot and brackets every work item with enter(slot, activity) / exit():
+ * - main loop: onRepeatProfiled() brackets each reaction with its name
+ * - tasks: one bracket per parse pass or bus read
+ *
+ * An esp_timer (another task, so it keeps running while the watched context
+ * is stuck) calls check() every STALL_CHECK_INTERVAL_MS. A work item that
+ * has been running longer than its slot's timeout is reported once: main.cpp
+ * captures the last open trace span of the core (TraceRecorder::lastOpen)
+ * and a backtrace of the stalled task, stores them with recordStall() in
+ * RTC_NOINIT memory and logs REACTION_STALL (which also lands in the crash
+ * ring). If the same work item is still running after STALL_RESET_MS, the
+ * record is marked and the ESP32 restarted. On the next boot the record is
+ * validated and copied aside like CrashLogRing; /watchdog and the boot log
+ * (PREVIOUS_STALL) report it.
+ *
+ * The backtrace can only be taken from a task that is blocked (switched out,
+ * its registers spilled to its stack) - the case of a hung driver call. A
+ * task spinning on its core gets a record without return addresses.
+ *
+ * enter()/exit() are a few atomic stores, safe from any task (one writer per
+ * slot). The slot table is Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed slot table, record in RTC memory, no heap
+ * - Principle V (Network Debugging): stall location survives the reset
+ * - Principle VII (Fail-Safe): a hung context restarts the device instead of leaving it stuck
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef STALL_WATCHDOG_H
+#define STALL_WATCHDOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief The last stall of a boot, placed in RTC memory on the target
+ */
+struct StallRecord {
+    static constexpr size_t NAME_SIZE = 12;
+
+    uint32_t magic;                     ///< StallWatchdog::MAGIC when contents are valid
+    uint32_t check;                     ///< Checksum over the fields below
+    uint32_t enteredMs;                 ///< millis() when the stalled work item began
+    uint32_t detectedMs;                ///< millis() of the detection
+    uint32_t pcs[STALL_BACKTRACE_DEPTH];///< Return addresses, innermost first
+    uint8_t depth;                      ///< Valid entries in pcs (0 = task was running)
+    uint8_t traceId;                    ///< Last open trace span on the core (TraceId::COUNT = none)
+    uint8_t core;                       ///< Core of the stalled task (StallWatchdog::UNKNOWN_CORE)
+    uint8_t reset;                      ///< 1 = the watchdog restarted the ESP32 for this stall
+    char slot[NAME_SIZE];               ///< Slot name ("loop", "n2k_rx", ...)
+    char activity[NAME_SIZE];           ///< Work item (reaction name, "parse", ...)
+};
+
+/**
+ * @class StallWatchdog
+ * @brief Watched slots (any task) and the stall record (monitor only)
+ *
+ * Usage pattern:
+ * @code
+ * int8_t slot = stallWatchdog.addSlot("loop", STALL_LOOP_TIMEOUT_MS);
+ * stallWatchdog.setTask(slot, xTaskGetCurrentTaskHandle(), xPortGetCoreID());
+ *
+ * stallWatchdog.enter(slot, "bd_stream", millis());
+ * ... work ...
+ * stallWatchdog.exit(slot);
+ *
+ * // esp_timer callback
+ * int8_t stalled;
+ * while ((stalled = stallWatchdog.check(millis())) >= 0) { ... recordStall() ... }
+ * @endcode
+ */
+class StallWatchdog {
+public:
+    static constexpr uint32_t MAGIC = 0x53544C31;  ///< "STL1"
+    static constexpr uint8_t UNKNOWN_CORE = 0xFF;
+
+    /**
+     * @brief Take over @p storage: copy out a valid previous-boot record, then clear it
+     * @param storage Record storage (RTC memory on the target)
+     */
+    explicit StallWatchdog(StallRecord& storage);
+
+    /**
+     * @brief Register a watched context (before it calls enter())
+     *
+     * @param name Static label
+     * @param timeoutMs A work item running this long is a stall
+     * @return Slot ID, or -1 if the table is full
+     */
+    int8_t addSlot(const char* name, uint32_t timeoutMs);
+
+    /// Task handle (backtrace capture) and core of @p slot
+    void setTask(uint8_t slot, void* task, uint8_t core);
+
+    /// Work item @p activity (static string) starts in @p slot
+    void enter(uint8_t slot, const char* activity, uint32_t nowMs);
+
+    /// The work item of @p slot finished
+    void exit(uint8_t slot);
+
+    /**
+     * @brief Report the next newly stalled slot (monitor task)
+     *
+     * Each work item is reported at most once.
+     *
+     * @return Slot ID, or -1 if none
+     */
+    int8_t check(uint32_t nowMs);
+
+    /**
+     * @brief Store a stall of @p slot in the record (replaces an earlier one)
+     *
+     * @param traceId Last open span on the slot's core (TraceId::COUNT = none)
+     * @param pcs Backtrace from captureBacktrace(), @p depth entries
+     */
+    void recordStall(uint8_t slot, uint32_t nowMs, uint8_t traceId, const uint32_t* pcs, uint8_t depth);
+
+    /// True once the recorded stall has lasted STALL_RESET_MS without its work item finishing
+    bool resetDue(uint32_t nowMs) const;
+
+    /// Mark the record as ending in a watchdog restart
+    void markReset();
+
+    uint8_t getSlotCount() const { return count_; }
+    const char* getSlotName(uint8_t slot) const { return slot < count_ ? slots_[slot].name : ""; }
+    void* getTask(uint8_t slot) const { return slot < count_ ? slots_[slot].task.load(std::memory_order_acquire) : nullptr; }
+    uint8_t getCore(uint8_t slot) const { return slot < count_ ? slots_[slot].core : UNKNOWN_CORE; }
+    uint32_t getStalls(uint8_t slot) const { return slot < count_ ? slots_[slot].stalls : 0; }
+
+    /// The record of this boot (valid once recordStall() ran)
+    const StallRecord& getRecord() const { return storage_; }
+    bool hasRecord() const { return recorded_; }
+
+    /// Record recovered from the previous boot
+    bool hasPreviousStall() const { return hasPrevious_; }
+    const StallRecord& getPreviousStall() const { return previous_; }
+
+    /**
+     * @brief Backtrace as "0x400d1e2a 0x400d2b10 ..." (xtensa-esp32-elf-addr2line input)
+     *
+     * @param buffer Receives "" when the record has no return addresses
+     */
+    static void formatBacktrace(const StallRecord& record, char* buffer, size_t size);
+
+    /**
+     * @brief Write a record as a JSON object
+     *
+     * {"slot":"loop","activity":"bd_stream","trace":"ws_send","core":1,"entered_ms":81234,
+     *  "stalled_ms":2250,"reset":false,"backtrace":"0x400d1e2a 0x400d2b10"}
+     */
+    static void writeRecord(JsonWriter& json, const char* key, const StallRecord& record);
+
+    /**
+     * @brief /watchdog report: slots (with the work item running now) and both records
+     * @return false if @p json overflowed
+     */
+    bool writeStats(JsonWriter& json, uint32_t nowMs) const;
+
+#ifdef ARDUINO
+    /**
+     * @brief Storage in RTC_NOINIT memory (preserved across non-power-on resets)
+     */
+    static StallRecord& rtcStorage();
+
+    /**
+     * @brief Return addresses of a blocked task, innermost first
+     *
+     * @return Entries written; 0 if @p task is running (no saved context)
+     */
+    static uint8_t captureBacktrace(void* task, uint32_t* pcs, uint8_t maxDepth);
+#endif
+
+private:
+    struct Slot {
+        const char* name;
+        uint32_t timeoutMs;
+        std::atomic<void*> task;
+        uint8_t core;
+        std::atomic<const char*> activity;  ///< nullptr = idle
+        std::atomic<uint32_t> enteredMs;
+        std::atomic<uint32_t> entry;        ///< Incremented by every enter()
+        uint32_t reportedEntry;             ///< Monitor: last entry reported as stalled
+        uint32_t stalls;                    ///< Monitor: stalls since boot
+    };
+
+    Slot slots_[STALL_WATCH_SLOTS];
+    uint8_t count_;
+    StallRecord& storage_;
+    StallRecord previous_;
+    bool hasPrevious_;
+    bool recorded_;
+    uint8_t recordedSlot_;
+    uint32_t recordedEntry_;
+
+    static uint32_t checksum(const StallRecord& record);
+};
+
+#endif // STALL_WATCHDOG_H
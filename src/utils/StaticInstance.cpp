@@ -0,0 +1,28 @@
+/**
+ * @file StaticInstance.cpp
+ * @brief Footprint totals of the static instance slots
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "StaticInstance.h"
+
+void StaticFootprint::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("reserved_bytes", (unsigned long)reservedBytes)
+        .add("slots", (unsigned int)slots)
+        .add("placed_bytes", (unsigned long)placedBytes)
+        .add("placed", (unsigned int)placed)
+        .endObject();
+}
+
+StaticFootprint& GetStaticFootprint() {
+    // Function-local: slots register from global constructors in any order
+    static StaticFootprint footprint = {0, 0, 0, 0};
+    return footprint;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file StaticInstance.h
+ * @brief Statically reserved storage for the long-lived objects setup() creates
+ *
+ * setup() constructs its components (BoatData, the handlers, the web
+ * servers, the HAL adapters) in order, at run time: their constructors
+ * touch hardware or need objects created before them. With `new` they end
+ * up scattered over the heap the rest of the firmware allocates from.
+ * A StaticInstance<T> reserves aligned storage for one T in .bss instead;
+ * emplace() placement-constructs the object there at the same point in
+ * setup(). The objects live for the whole uptime and are never destroyed.
+ *
+ * Every instance adds its size to GetStaticFootprint(), logged at the end
+ * of setup() (STATIC_FOOTPRINT) and reported by GET /status.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): no heap for boot-time singletons, footprint known at boot
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef STATIC_INSTANCE_H
+#define STATIC_INSTANCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <new>
+#include <utility>
+#include "JsonWriter.h"
+
+/**
+ * @brief Storage reserved by, and objects placed into, StaticInstance slots
+ */
+struct StaticFootprint {
+    uint32_t reservedBytes;  ///< Storage of every slot, used or not
+    uint32_t placedBytes;    ///< Storage of the constructed objects
+    uint16_t slots;
+    uint16_t placed;
+
+    /// {"reserved_bytes":5120,"slots":25,"placed_bytes":4980,"placed":23}; with @p key a member
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+};
+
+/// Totals over all StaticInstance slots of the firmware
+StaticFootprint& GetStaticFootprint();
+
+/**
+ * @class StaticInstance
+ * @brief Storage for one T, constructed once on demand
+ *
+ * Usage pattern:
+ * @code
+ * StaticInstance<BoatData> boatDataStorage;              // Global: storage only
+ * boatData = boatDataStorage.emplace(sourcePrioritizer);  // In setup()
+ * @endcode
+ */
+template <typename T>
+class StaticInstance {
+public:
+    StaticInstance() : placed_(false) {
+        StaticFootprint& footprint = GetStaticFootprint();
+        footprint.reservedBytes += sizeof(T);
+        footprint.slots++;
+    }
+
+    StaticInstance(const StaticInstance&) = delete;
+    StaticInstance& operator=(const StaticInstance&) = delete;
+
+    /**
+     * @brief Construct the object in the reserved storage
+     * @return The object; if it already exists, that one (not constructed again)
+     */
+    template <typename... Args>
+    T* emplace(Args&&... args) {
+        if (placed_) {
+            return get();
+        }
+        T* object = new (storage_) T(std::forward<Args>(args)...);
+        placed_ = true;
+        StaticFootprint& footprint = GetStaticFootprint();
+        footprint.placedBytes += sizeof(T);
+        footprint.placed++;
+        return object;
+    }
+
+    /// The object, nullptr before emplace()
+    T* get() { return placed_ ? reinterpret_cast<T*>(storage_) : nullptr; }
+
+    bool isPlaced() const { return placed_; }
+
+private:
+    alignas(T) unsigned char storage_[sizeof(T)];
+    bool placed_;
+};
+
+#endif // STATIC_INSTANCE_H
@@ -0,0 +1,259 @@
+/**
+ * @file TelemetryRegistry.cpp
+ * @brief Implementation of the telemetry registry
+ *
+ * @see TelemetryRegistry.h
+ */
+
+#include "TelemetryRegistry.h"
+#include <string.h>
+
+namespace {
+
+enum FamilyKind : uint8_t { KIND_COUNTER = 0, KIND_GAUGE, KIND_HISTOGRAM };
+
+struct LabelledName {
+    const char* key;
+    const char* metric;
+    const char* labelKey;
+    const char* labelValue;
+    const char* help;
+};
+
+struct HistogramName {
+    const char* key;
+    const char* metric;
+    const char* help;
+};
+
+#define TELEMETRY_LABELLED_ENTRY(id, metric, labelKey, labelValue, help) {#id, metric, labelKey, labelValue, help},
+#define TELEMETRY_HISTOGRAM_ENTRY(id, metric, help) {#id, metric, help},
+
+const LabelledName COUNTER_NAMES[] = {TELEMETRY_COUNTER_LIST(TELEMETRY_LABELLED_ENTRY)};
+const LabelledName GAUGE_NAMES[] = {TELEMETRY_GAUGE_LIST(TELEMETRY_LABELLED_ENTRY)};
+const HistogramName HISTOGRAM_NAMES[] = {TELEMETRY_HISTOGRAM_LIST(TELEMETRY_HISTOGRAM_ENTRY)};
+
+#undef TELEMETRY_LABELLED_ENTRY
+#undef TELEMETRY_HISTOGRAM_ENTRY
+
+// Quantile series of a histogram family
+const char* const QUANTILE_LABELS[] = {"0.5", "0.95", "0.99", "1"};
+const uint8_t QUANTILES = sizeof(QUANTILE_LABELS) / sizeof(QUANTILE_LABELS[0]);
+
+/// Entries from @p first that share its metric name
+uint8_t runLength(const LabelledName* names, uint8_t count, uint8_t first) {
+    uint8_t length = 1;
+    while (first + length < count && strcmp(names[first + length].metric, names[first].metric) == 0) {
+        length++;
+    }
+    return length;
+}
+
+}  // namespace
+
+TelemetryRegistry::TelemetryRegistry()
+    : previousMs_(0), sourceCount_(0), familyCount_(0), lock_() {
+    memset(counters_, 0, sizeof(counters_));
+    memset(buckets_, 0, sizeof(buckets_));
+    memset(previousCounters_, 0, sizeof(previousCounters_));
+    memset(previousBuckets_, 0, sizeof(previousBuckets_));
+    memset(sources_, 0, sizeof(sources_));
+    memset(families_, 0, sizeof(families_));
+    memset(&published_, 0, sizeof(published_));
+    for (uint8_t i = 0; i < GAUGES; i++) {
+        gauges_[i] = NO_VALUE;
+        published_.gauges[i] = NO_VALUE;
+    }
+}
+
+bool TelemetryRegistry::addSource(TelemetrySource source, void* context) {
+    if (source == nullptr || sourceCount_ >= MAX_SOURCES) {
+        return false;
+    }
+    sources_[sourceCount_].function = source;
+    sources_[sourceCount_].context = context;
+    sourceCount_++;
+    return true;
+}
+
+void TelemetryRegistry::aggregate(uint32_t nowMs) {
+    for (uint8_t i = 0; i < sourceCount_; i++) {
+        sources_[i].function(sources_[i].context);
+    }
+
+    TelemetrySnapshot next;
+    next.generation = published_.generation + 1;
+    next.timeMs = nowMs;
+    next.intervalMs = nowMs - previousMs_;
+    previousMs_ = nowMs;
+
+    for (uint8_t i = 0; i < COUNTERS; i++) {
+        uint32_t total = __atomic_load_n(&counters_[i], __ATOMIC_RELAXED);
+        uint32_t delta = total - previousCounters_[i];
+        if (total < previousCounters_[i]) {
+            delta = total;   // Owner reset its count (setTotal())
+        }
+        previousCounters_[i] = total;
+        next.counters[i].total = total;
+        next.counters[i].ratePerSec = next.intervalMs > 0
+            ? static_cast<uint32_t>((static_cast<uint64_t>(delta) * 1000 + next.intervalMs / 2) / next.intervalMs)
+            : 0;
+    }
+
+    for (uint8_t i = 0; i < GAUGES; i++) {
+        next.gauges[i] = __atomic_load_n(&gauges_[i], __ATOMIC_RELAXED);
+    }
+
+    for (uint8_t h = 0; h < HISTOGRAMS; h++) {
+        // Fold the interval's bucket deltas into a histogram at the bucket upper edges
+        LatencyHistogram interval;
+        for (uint8_t b = 0; b < LatencyHistogram::BUCKETS; b++) {
+            uint32_t total = __atomic_load_n(&buckets_[h][b], __ATOMIC_RELAXED);
+            uint32_t delta = total - previousBuckets_[h][b];
+            previousBuckets_[h][b] = total;
+            interval.record(LatencyHistogram::bucketUpperEdge(b) - 1, delta);
+        }
+        TelemetryHistogramValue& value = next.histograms[h];
+        value.count = interval.getCount();
+        value.p50 = interval.getPercentile(50);
+        value.p95 = interval.getPercentile(95);
+        value.p99 = interval.getPercentile(99);
+        value.max = interval.getMax();
+    }
+
+    lock_.writeBegin();
+    published_ = next;
+    lock_.writeEnd();
+}
+
+bool TelemetryRegistry::read(TelemetrySnapshot& out) const {
+    return lock_.read(published_, out);
+}
+
+const char* TelemetryRegistry::counterKey(TelemetryCounter id) {
+    uint8_t i = static_cast<uint8_t>(id);
+    return i < COUNTERS ? COUNTER_NAMES[i].key : "";
+}
+
+const char* TelemetryRegistry::gaugeKey(TelemetryGauge id) {
+    uint8_t i = static_cast<uint8_t>(id);
+    return i < GAUGES ? GAUGE_NAMES[i].key : "";
+}
+
+const char* TelemetryRegistry::histogramKey(TelemetryHistogram id) {
+    uint8_t i = static_cast<uint8_t>(id);
+    return i < HISTOGRAMS ? HISTOGRAM_NAMES[i].key : "";
+}
+
+void TelemetryRegistry::writeJson(JsonWriter& json, const char* key) const {
+    TelemetrySnapshot snapshot;
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    if (!read(snapshot)) {
+        json.add("error", "busy").endObject();
+        return;
+    }
+    writeSnapshotJson(json, snapshot);
+    json.endObject();
+}
+
+void TelemetryRegistry::writeSnapshotJson(JsonWriter& json, const TelemetrySnapshot& snapshot) const {
+    json.add("generation", (unsigned long)snapshot.generation)
+        .add("time_ms", (unsigned long)snapshot.timeMs)
+        .add("interval_ms", (unsigned long)snapshot.intervalMs);
+
+    json.beginObject("counters");
+    for (uint8_t i = 0; i < COUNTERS; i++) {
+        json.beginObject(COUNTER_NAMES[i].key)
+            .add("total", (unsigned long)snapshot.counters[i].total)
+            .add("rate", (unsigned long)snapshot.counters[i].ratePerSec)
+            .endObject();
+    }
+    json.endObject();
+
+    json.beginObject("gauges");
+    for (uint8_t i = 0; i < GAUGES; i++) {
+        if (snapshot.gauges[i] == NO_VALUE) {
+            json.add(GAUGE_NAMES[i].key, static_cast<const char*>(nullptr));
+        } else {
+            json.add(GAUGE_NAMES[i].key, (unsigned long)snapshot.gauges[i]);
+        }
+    }
+    json.endObject();
+
+    json.beginObject("histograms");
+    for (uint8_t i = 0; i < HISTOGRAMS; i++) {
+        const TelemetryHistogramValue& h = snapshot.histograms[i];
+        json.beginObject(HISTOGRAM_NAMES[i].key)
+            .add("count", (unsigned long)h.count)
+            .add("p50", (unsigned long)h.p50)
+            .add("p95", (unsigned long)h.p95)
+            .add("p99", (unsigned long)h.p99)
+            .add("max", (unsigned long)h.max)
+            .endObject();
+    }
+    json.endObject();
+}
+
+bool TelemetryRegistry::registerMetrics(MetricRegistry& metrics) const {
+    if (familyCount_ != 0) {
+        return false;   // Once: the family contexts are this registry's storage
+    }
+    bool ok = true;
+    uint8_t i = 0;
+    while (i < COUNTERS) {
+        uint8_t length = runLength(COUNTER_NAMES, COUNTERS, i);
+        Family& family = families_[familyCount_++];
+        family = {this, KIND_COUNTER, i};
+        ok = metrics.add(COUNTER_NAMES[i].metric, COUNTER_NAMES[i].help, MetricType::COUNTER,
+                         sampleFamily, length, &family) && ok;
+        i += length;
+    }
+    i = 0;
+    while (i < GAUGES) {
+        uint8_t length = runLength(GAUGE_NAMES, GAUGES, i);
+        Family& family = families_[familyCount_++];
+        family = {this, KIND_GAUGE, i};
+        ok = metrics.add(GAUGE_NAMES[i].metric, GAUGE_NAMES[i].help, MetricType::GAUGE,
+                         sampleFamily, length, &family) && ok;
+        i += length;
+    }
+    for (i = 0; i < HISTOGRAMS; i++) {
+        Family& family = families_[familyCount_++];
+        family = {this, KIND_HISTOGRAM, i};
+        ok = metrics.add(HISTOGRAM_NAMES[i].metric, HISTOGRAM_NAMES[i].help, MetricType::GAUGE,
+                         sampleFamily, QUANTILES, &family) && ok;
+    }
+    return ok;
+}
+
+void TelemetryRegistry::sampleFamily(MetricSample& sample, uint16_t index, const void* context) {
+    const Family* family = static_cast<const Family*>(context);
+    const TelemetrySnapshot& snapshot = family->registry->published_;
+
+    if (family->kind == KIND_HISTOGRAM) {
+        const TelemetryHistogramValue& h = snapshot.histograms[family->first];
+        const uint32_t values[QUANTILES] = {h.p50, h.p95, h.p99, h.max};
+        sample.label("quantile", QUANTILE_LABELS[index]).value(values[index]);
+        return;
+    }
+
+    uint8_t i = static_cast<uint8_t>(family->first + index);
+    const LabelledName& name = family->kind == KIND_COUNTER ? COUNTER_NAMES[i] : GAUGE_NAMES[i];
+    uint32_t value;
+    if (family->kind == KIND_COUNTER) {
+        value = snapshot.counters[i].total;
+    } else {
+        value = snapshot.gauges[i];
+        if (value == NO_VALUE) {
+            return;   // Skipped: no value (yet)
+        }
+    }
+    if (name.labelKey[0] != '\0') {
+        sample.label(name.labelKey, name.labelValue);
+    }
+    sample.value(value);
+}
@@ -0,0 +1,302 @@
+/**
+ * @file TelemetryRegistry.h
+ * @brief One registry of the gateway's own counters, gauges and histograms
+ *
+ * Every metric is declared once in the lists below: enumerator, Prometheus
+ * name, optional label and help text, all compile-time literals. The
+ * registry stores the live values in fixed arrays indexed by enumerator,
+ * so updating a metric on a hot path is one atomic increment (counter),
+ * one store (gauge) or one bucket increment (histogram, LatencyHistogram
+ * buckets): no string work, no lock, no allocation.
+ *
+ * Values that already have an owner (DiagnosticData, LoopPerformanceMonitor,
+ * HeapMonitor, the drop counters of the queues, WebSocketLogger) are
+ * brought in by sources: functions registered in setup() that mirror the
+ * owner's total or current value into the registry.
+ *
+ * aggregate() runs once per TELEMETRY_INTERVAL_MS (the "telemetry" reaction):
+ * it calls the sources, then publishes one snapshot under a SeqLock, with
+ * per counter the total and the rate over the interval, per gauge the
+ * value and per histogram the sample count and p50/p95/p99/max of the
+ * interval. The snapshot is the only thing the consumers read:
+ * - GET /metrics (registerMetrics(): one family per metric name, the
+ *   entries of one name become its labelled series)
+ * - GET /stats (writeJson())
+ * - the OLED status page (TelemetrySystemMetrics)
+ * - the soak CSV rows
+ * so all of them show the same numbers from the same second.
+ *
+ * Names are only meaningful within one build: add entries anywhere, but
+ * keep the entries of one Prometheus name next to each other.
+ *
+ * Arduino-free (unit tested natively). Updates: any task or core.
+ * aggregate(): one task. Readers: any task.
+ *
+ * Usage:
+ * @code
+ * TELEMETRY_INCREMENT(TelemetryCounter::N2K_DISPATCHED);              // Hot path
+ * TELEMETRY_RECORD(TelemetryHistogram::N2K_HANDLER_US, elapsedUs);
+ * telemetry.addSource([](void*) {                                   // setup()
+ *     telemetry.set(TelemetryGauge::HEAP_FREE, ESP.getFreeHeap());
+ * }, nullptr);
+ * telemetry.aggregate(millis());                                    // Every TELEMETRY_INTERVAL_MS
+ * uint32_t free = telemetry.getGauge(TelemetryGauge::HEAP_FREE);
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed arrays, zero heap allocation
+ * - Principle V (Network Debugging): one consistent set behind every diagnostics view
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef TELEMETRY_REGISTRY_H
+#define TELEMETRY_REGISTRY_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "JsonWriter.h"
+#include "LatencyHistogram.h"
+#include "MetricRegistry.h"
+#include "SeqLock.h"
+#include "../config.h"
+
+/// X(id, "name", "label key", "label value", "help"): only increase, since boot
+#define TELEMETRY_COUNTER_LIST(X) \
+    X(MESSAGES_NMEA0183, "poseidon2_messages_total", "protocol", "nmea0183", "Messages received per protocol") \
+    X(MESSAGES_NMEA2000, "poseidon2_messages_total", "protocol", "nmea2000", "Messages received per protocol") \
+    X(MESSAGES_ACTISENSE, "poseidon2_messages_total", "protocol", "actisense", "Messages received per protocol") \
+    X(N2K_DISPATCHED, "poseidon2_n2k_dispatched_total", "", "", "NMEA 2000 messages passed to a PGN handler (active sources)") \
+    X(CALC_CYCLES, "poseidon2_calculation_cycles_total", "", "", "Calculation cycles completed") \
+    X(CALC_OVERRUNS, "poseidon2_calculation_overruns_total", "", "", "Calculation cycles over CALC_DEADLINE_US") \
+    X(CAN_DROPPED, "poseidon2_can_rx_dropped_total", "", "", "CAN frames dropped on a full receive queue") \
+    X(UART_DROPPED, "poseidon2_uart_dropped_sentences_total", "", "", "NMEA 0183 sentences dropped by the UART ports") \
+    X(WS_DROPPED, "poseidon2_ws_pool_dropped_total", "", "", "WebSocket frames dropped for lack of a send buffer") \
+    X(LOG_MESSAGES, "poseidon2_log_messages_total", "", "", "Log messages sent to the /logs clients") \
+    X(LOG_DROPPED, "poseidon2_log_dropped_total", "", "", "Log messages dropped on a full queue") \
+    X(HEAP_ALLOCS, "poseidon2_heap_allocs_total", "", "", "Heap allocations since boot") \
+    X(HEAP_FREES, "poseidon2_heap_frees_total", "", "", "Heap frees since boot") \
+    X(HEAP_FAILED, "poseidon2_heap_failed_allocs_total", "", "", "Failed heap allocations since boot")
+
+/// X(id, "name", "label key", "label value", "help"): current value (NO_VALUE = none, not written)
+#define TELEMETRY_GAUGE_LIST(X) \
+    X(CALC_DURATION_LAST, "poseidon2_calculation_duration_us", "stat", "last", "Calculation cycle duration (last, max since boot)") \
+    X(CALC_DURATION_MAX, "poseidon2_calculation_duration_us", "stat", "max", "Calculation cycle duration (last, max since boot)") \
+    X(CALC_LATENCY_LAST, "poseidon2_calculation_latency_us", "stat", "last", "Input change to derived output (last, max since boot)") \
+    X(CALC_LATENCY_MAX, "poseidon2_calculation_latency_us", "stat", "max", "Input change to derived output (last, max since boot)") \
+    X(CALC_PERIOD, "poseidon2_calculation_period_us", "", "", "Start-to-start time of the last two calculation cycles") \
+    X(LOOP_FREQUENCY, "poseidon2_loop_frequency_hz", "", "", "Main loop iterations per second") \
+    X(LOOP_P50, "poseidon2_loop_latency_us", "quantile", "0.5", "Main loop iteration duration percentiles of the last window") \
+    X(LOOP_P95, "poseidon2_loop_latency_us", "quantile", "0.95", "Main loop iteration duration percentiles of the last window") \
+    X(LOOP_P99, "poseidon2_loop_latency_us", "quantile", "0.99", "Main loop iteration duration percentiles of the last window") \
+    X(LOOP_MAX, "poseidon2_loop_latency_max_us", "", "", "Longest main loop iteration of the last window") \
+    X(CPU_IDLE_CORE0, "poseidon2_cpu_idle_percent", "core", "0", "Idle share per core") \
+    X(CPU_IDLE_CORE1, "poseidon2_cpu_idle_percent", "core", "1", "Idle share per core") \
+    X(HEAP_FREE, "poseidon2_heap_free_bytes", "", "", "Free 8-bit capable heap") \
+    X(HEAP_LARGEST, "poseidon2_heap_largest_free_block_bytes", "", "", "Largest allocation that would succeed") \
+    X(HEAP_MIN, "poseidon2_heap_min_free_bytes", "", "", "Lowest free heap since boot") \
+    X(HEAP_FRAGMENTATION, "poseidon2_heap_fragmentation_percent", "", "", "Share of free heap outside the largest block") \
+    X(SKETCH_BYTES, "poseidon2_sketch_bytes", "", "", "Size of the running firmware image") \
+    X(SKETCH_FREE, "poseidon2_sketch_free_bytes", "", "", "Flash available for the next OTA image")
+
+/// X(id, "name", "help"): microseconds, written as quantiles 0.5/0.95/0.99/1 of the last interval
+#define TELEMETRY_HISTOGRAM_LIST(X) \
+    X(N2K_HANDLER_US, "poseidon2_n2k_handler_us", "NMEA 2000 PGN handler time") \
+    X(CALC_CYCLE_US, "poseidon2_calculation_cycle_us", "Calculation cycle duration")
+
+#define TELEMETRY_ENUM_ENTRY(id, ...) id,
+
+enum class TelemetryCounter : uint8_t { TELEMETRY_COUNTER_LIST(TELEMETRY_ENUM_ENTRY) COUNT };
+enum class TelemetryGauge : uint8_t { TELEMETRY_GAUGE_LIST(TELEMETRY_ENUM_ENTRY) COUNT };
+enum class TelemetryHistogram : uint8_t { TELEMETRY_HISTOGRAM_LIST(TELEMETRY_ENUM_ENTRY) COUNT };
+
+#undef TELEMETRY_ENUM_ENTRY
+
+/// Mirrors owner values into the registry (called by aggregate())
+typedef void (*TelemetrySource)(void* context);
+
+/**
+ * @brief Counter as published
+ */
+struct TelemetryCounterValue {
+    uint32_t total;         ///< Since boot
+    uint32_t ratePerSec;    ///< Over the last interval
+};
+
+/**
+ * @brief Histogram as published (last interval, bucket upper edges in µs)
+ */
+struct TelemetryHistogramValue {
+    uint32_t count;
+    uint32_t p50;
+    uint32_t p95;
+    uint32_t p99;
+    uint32_t max;
+};
+
+/**
+ * @brief The values of one aggregation
+ */
+struct TelemetrySnapshot {
+    static constexpr uint8_t COUNTERS = static_cast<uint8_t>(TelemetryCounter::COUNT);
+    static constexpr uint8_t GAUGES = static_cast<uint8_t>(TelemetryGauge::COUNT);
+    static constexpr uint8_t HISTOGRAMS = static_cast<uint8_t>(TelemetryHistogram::COUNT);
+
+    uint32_t generation;    ///< Aggregations so far (0 = none yet)
+    uint32_t timeMs;        ///< When it was aggregated
+    uint32_t intervalMs;    ///< Since the previous aggregation
+    TelemetryCounterValue counters[COUNTERS];
+    uint32_t gauges[GAUGES];
+    TelemetryHistogramValue histograms[HISTOGRAMS];
+
+    const TelemetryCounterValue& get(TelemetryCounter id) const { return counters[static_cast<uint8_t>(id)]; }
+    uint32_t get(TelemetryGauge id) const { return gauges[static_cast<uint8_t>(id)]; }
+    const TelemetryHistogramValue& get(TelemetryHistogram id) const { return histograms[static_cast<uint8_t>(id)]; }
+};
+
+/**
+ * @class TelemetryRegistry
+ * @brief Live values, sources and the published snapshot
+ */
+class TelemetryRegistry {
+public:
+    static constexpr uint32_t NO_VALUE = UINT32_MAX;   ///< Gauge without a value
+    static constexpr uint8_t MAX_SOURCES = TELEMETRY_MAX_SOURCES;
+
+    TelemetryRegistry();
+
+    // ---- Updates (any task, no locking) ----
+
+    void increment(TelemetryCounter id) {
+        __atomic_fetch_add(&counters_[static_cast<uint8_t>(id)], 1u, __ATOMIC_RELAXED);
+    }
+
+    void add(TelemetryCounter id, uint32_t count) {
+        __atomic_fetch_add(&counters_[static_cast<uint8_t>(id)], count, __ATOMIC_RELAXED);
+    }
+
+    /// Counter kept by its owner: the source copies the owner's total
+    void setTotal(TelemetryCounter id, uint32_t total) {
+        __atomic_store_n(&counters_[static_cast<uint8_t>(id)], total, __ATOMIC_RELAXED);
+    }
+
+    void set(TelemetryGauge id, uint32_t value) {
+        __atomic_store_n(&gauges_[static_cast<uint8_t>(id)], value, __ATOMIC_RELAXED);
+    }
+
+    void record(TelemetryHistogram id, uint32_t valueUs) {
+        __atomic_fetch_add(&buckets_[static_cast<uint8_t>(id)][LatencyHistogram::bucketFor(valueUs)], 1u,
+                           __ATOMIC_RELAXED);
+    }
+
+    // ---- Setup ----
+
+    /**
+     * @brief Register a source (setup only, before the first aggregate())
+     * @return false when MAX_SOURCES are registered or @p source is null
+     */
+    bool addSource(TelemetrySource source, void* context);
+
+    // ---- Aggregation (one task) ----
+
+    /**
+     * @brief Run the sources, then publish the snapshot of @p nowMs
+     */
+    void aggregate(uint32_t nowMs);
+
+    // ---- Readers (any task) ----
+
+    /**
+     * @brief Copy the last published snapshot
+     * @return false if it was torn by a concurrent aggregate() every attempt
+     */
+    bool read(TelemetrySnapshot& out) const;
+
+    /// Published values, one word each (always consistent in themselves)
+    const TelemetryCounterValue& getCounter(TelemetryCounter id) const {
+        return published_.counters[static_cast<uint8_t>(id)];
+    }
+    uint32_t getGauge(TelemetryGauge id) const { return published_.gauges[static_cast<uint8_t>(id)]; }
+    const TelemetryHistogramValue& getHistogram(TelemetryHistogram id) const {
+        return published_.histograms[static_cast<uint8_t>(id)];
+    }
+    uint32_t getGeneration() const { return published_.generation; }
+
+    /// Enumerator names (the JSON keys of writeJson())
+    static const char* counterKey(TelemetryCounter id);
+    static const char* gaugeKey(TelemetryGauge id);
+    static const char* histogramKey(TelemetryHistogram id);
+
+    /**
+     * @brief Write the last snapshot as JSON (GET /stats)
+     *
+     * {"generation":812,"time_ms":812004,"interval_ms":1000,
+     *  "counters":{"MESSAGES_NMEA2000":{"total":95012,"rate":117},...},
+     *  "gauges":{"HEAP_FREE":181244,"LOOP_P99":340,...},
+     *  "histograms":{"N2K_HANDLER_US":{"count":117,"p50":48,"p95":96,"p99":128,"max":160},...}}
+     * Gauges without a value are null.
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+    /**
+     * @brief Add one MetricRegistry family per metric name (setup only, once)
+     * @return false if @p metrics ran out of families or it was called before
+     */
+    bool registerMetrics(MetricRegistry& metrics) const;
+
+private:
+    static constexpr uint8_t COUNTERS = TelemetrySnapshot::COUNTERS;
+    static constexpr uint8_t GAUGES = TelemetrySnapshot::GAUGES;
+    static constexpr uint8_t HISTOGRAMS = TelemetrySnapshot::HISTOGRAMS;
+
+    struct Source {
+        TelemetrySource function;
+        void* context;
+    };
+
+    /**
+     * @brief Family of metric names [first, first + count) of one kind (MetricSampler context)
+     */
+    struct Family {
+        const TelemetryRegistry* registry;
+        uint8_t kind;       ///< 0 counter, 1 gauge, 2 histogram
+        uint8_t first;
+    };
+
+    static constexpr uint8_t MAX_METRIC_FAMILIES = COUNTERS + GAUGES + HISTOGRAMS;
+
+    static void sampleFamily(MetricSample& sample, uint16_t index, const void* context);
+    void writeSnapshotJson(JsonWriter& json, const TelemetrySnapshot& snapshot) const;
+
+    // Live values
+    uint32_t counters_[COUNTERS];
+    uint32_t gauges_[GAUGES];
+    uint32_t buckets_[HISTOGRAMS][LatencyHistogram::BUCKETS];
+
+    // State of the previous aggregation
+    uint32_t previousCounters_[COUNTERS];
+    uint32_t previousBuckets_[HISTOGRAMS][LatencyHistogram::BUCKETS];
+    uint32_t previousMs_;
+
+    Source sources_[MAX_SOURCES];
+    uint8_t sourceCount_;
+
+    mutable Family families_[MAX_METRIC_FAMILIES];
+    mutable uint8_t familyCount_;
+
+    TelemetrySnapshot published_;
+    SeqLock lock_;
+};
+
+#if defined(ARDUINO) && !defined(UNIT_TEST)
+extern TelemetryRegistry telemetry;
+
+#define TELEMETRY_INCREMENT(id) telemetry.increment(id)
+#define TELEMETRY_RECORD(id, valueUs) telemetry.record((id), (valueUs))
+#else
+#define TELEMETRY_INCREMENT(id) ((void)0)
+#define TELEMETRY_RECORD(id, valueUs) ((void)0)
+#endif
+
+#endif // TELEMETRY_REGISTRY_H
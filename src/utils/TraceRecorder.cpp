@@ -0,0 +1,207 @@
+/**
+ * @file TraceRecorder.cpp
+ * @brief Implementation of the trace event ring and its Chrome JSON export
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "TraceRecorder.h"
+#include <stdio.h>
+#include <string.h>
+#include "BufferPlacement.h"
+#include "JsonWriter.h"
+
+namespace {
+
+struct TraceSpanInfo {
+    const char* name;
+    const char* argName;
+};
+
+const TraceSpanInfo SPANS[] = {
+    {"n2k_parse", "pgn"},
+    {"n0183_sentence", "code"},
+    {"calculate", "changed"},
+    {"serialize", "mode"},
+    {"ws_send", "bytes"},
+    {"display_render", "page"},
+};
+
+static_assert(sizeof(SPANS) / sizeof(SPANS[0]) == static_cast<size_t>(TraceId::COUNT), "One entry per TraceId");
+
+}  // namespace
+
+TraceRecorder::TraceRecorder(CycleCounter counter)
+    : counter_(counter), events_(nullptr), mask_(0), head_(0), paused_(true) {
+}
+
+bool TraceRecorder::begin() {
+    if (events_ != nullptr) {
+        return true;
+    }
+    uint32_t count = 0;
+    TraceEvent* events = GetBufferPlacement().place<TraceEvent>("trace_ring", CAPACITY, INTERNAL_CAPACITY, count);
+    if (events == nullptr) {
+        return false;
+    }
+    mask_ = count - 1;
+    events_ = events;
+    head_.store(0, std::memory_order_relaxed);
+    paused_.store(false, std::memory_order_release);
+    return true;
+}
+
+uint32_t TraceRecorder::getOldest() const {
+    uint32_t head = getRecorded();
+    uint32_t capacity = getCapacity();
+    return head > capacity ? head - capacity : 0;
+}
+
+uint8_t TraceRecorder::lastOpen(uint8_t core) const {
+    const uint8_t none = static_cast<uint8_t>(TraceId::COUNT);
+    uint16_t ended[static_cast<uint8_t>(TraceId::COUNT)] = {};
+    uint32_t oldest = getOldest();
+    for (uint32_t seq = getRecorded(); seq != oldest; seq--) {
+        const TraceEvent& event = at(seq - 1);
+        if (event.core != core || event.id >= none) {
+            continue;
+        }
+        if (event.end) {
+            ended[event.id]++;
+        } else if (ended[event.id] > 0) {
+            ended[event.id]--;
+        } else {
+            return event.id;
+        }
+    }
+    return none;
+}
+
+const char* TraceRecorder::name(uint8_t id) {
+    return id < static_cast<uint8_t>(TraceId::COUNT) ? SPANS[id].name : "unknown";
+}
+
+const char* TraceRecorder::argName(uint8_t id) {
+    return id < static_cast<uint8_t>(TraceId::COUNT) ? SPANS[id].argName : "arg";
+}
+
+TraceChromeWriter::TraceChromeWriter(const TraceRecorder& recorder, uint32_t cpuMhz)
+    : recorder_(recorder), cpuMhz_(cpuMhz > 0 ? cpuMhz : 1),
+      start_(recorder.getOldest()), end_(recorder.getRecorded()), next_(start_),
+      stage_(HEADER), thread_(0), first_(true), baseTick_(0), pieceLen_(0), piecePos_(0) {
+    for (uint8_t c = 0; c < MAX_CORES; c++) {
+        seen_[c] = false;
+        originCycles_[c] = 0;
+        originTick_[c] = 0;
+    }
+
+    // Per-core origin: the cores' cycle counters are not synchronized
+    bool anySeen = false;
+    for (uint32_t seq = start_; seq != end_; seq++) {
+        const TraceEvent& event = recorder_.at(seq);
+        uint8_t core = event.core < MAX_CORES ? event.core : MAX_CORES - 1;
+        if (!seen_[core]) {
+            seen_[core] = true;
+            originCycles_[core] = event.cycles;
+            originTick_[core] = event.tick;
+            if (!anySeen || static_cast<int32_t>(event.tick - baseTick_) < 0) {
+                baseTick_ = event.tick;
+            }
+            anySeen = true;
+        }
+    }
+}
+
+double TraceChromeWriter::timestampUs(const TraceEvent& event) const {
+    uint8_t core = event.core < MAX_CORES ? event.core : MAX_CORES - 1;
+    double us = static_cast<double>(event.cycles - originCycles_[core]) / cpuMhz_;
+
+    // The tick says how much time really passed: add the CCOUNT wraps it hides
+    double coarseUs = static_cast<double>(static_cast<int32_t>(event.tick - originTick_[core])) * 1000.0;
+    double wrapUs = 4294967296.0 / cpuMhz_;
+    while (coarseUs - us > wrapUs / 2) {
+        us += wrapUs;
+    }
+    return static_cast<double>(static_cast<int32_t>(originTick_[core] - baseTick_)) * 1000.0 + us;
+}
+
+bool TraceChromeWriter::nextPiece() {
+    JsonWriter json(piece_, sizeof(piece_));
+    pieceLen_ = 0;
+    piecePos_ = 0;
+
+    switch (stage_) {
+        case HEADER:
+            pieceLen_ = static_cast<size_t>(snprintf(piece_, sizeof(piece_),
+                "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"cpu_mhz\":%lu,\"recorded\":%lu,\"events\":%lu},"
+                "\"traceEvents\":[",
+                (unsigned long)cpuMhz_, (unsigned long)end_, (unsigned long)(end_ - start_)));
+            stage_ = THREADS;
+            return true;
+
+        case THREADS:
+            while (thread_ < MAX_CORES && !seen_[thread_]) {
+                thread_++;
+            }
+            if (thread_ >= MAX_CORES) {
+                stage_ = EVENTS;
+                return nextPiece();
+            }
+            pieceLen_ = static_cast<size_t>(snprintf(piece_, sizeof(piece_),
+                "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"core %u\"}}",
+                first_ ? "" : ",", (unsigned)thread_, (unsigned)thread_));
+            first_ = false;
+            thread_++;
+            return true;
+
+        case EVENTS: {
+            if (next_ == end_) {
+                stage_ = FOOTER;
+                return nextPiece();
+            }
+            const TraceEvent& event = recorder_.at(next_++);
+            if (!first_) {
+                json.appendRaw(",");
+            }
+            first_ = false;
+            json.beginObject()
+                .add("name", TraceRecorder::name(event.id))
+                .add("ph", event.end ? "E" : "B")
+                .add("ts", timestampUs(event), 1)
+                .add("pid", 1)
+                .add("tid", (unsigned int)event.core);
+            if (!event.end) {
+                json.beginObject("args").add(TraceRecorder::argName(event.id), (unsigned long)event.arg).endObject();
+            }
+            json.endObject();
+            pieceLen_ = json.length();
+            return true;
+        }
+
+        case FOOTER:
+            pieceLen_ = static_cast<size_t>(snprintf(piece_, sizeof(piece_), "]}"));
+            stage_ = DONE;
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+size_t TraceChromeWriter::read(char* buffer, size_t maxLen) {
+    size_t written = 0;
+    while (written < maxLen) {
+        if (piecePos_ == pieceLen_ && !nextPiece()) {
+            break;
+        }
+        size_t n = pieceLen_ - piecePos_;
+        if (n > maxLen - written) {
+            n = maxLen - written;
+        }
+        memcpy(buffer + written, piece_ + piecePos_, n);
+        piecePos_ += n;
+        written += n;
+    }
+    return written;
+}
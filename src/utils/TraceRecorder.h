@@ -0,0 +1,247 @@
+/**
+ * @file TraceRecorder.h
+ * @brief Ring of begin/end trace events, exported as Chrome trace_event JSON
+ *
+ * Instrumented code paths bracket their work with macros:
+ *
+ * @code
+ * TRACE_SCOPE(TraceId::N2K_PARSE, N2kMsg.PGN);    // begin now, end at scope exit
+ * TRACE_BEGIN(TraceId::WS_SEND, slots);
+ * ... send ...
+ * TRACE_END(TraceId::WS_SEND);
+ * @endcode
+ *
+ * Each event is 16 bytes: CCOUNT of the recording core, FreeRTOS tick
+ * (ms), the span ID and begin/end flag, the core and one numeric argument
+ * (PGN, sentence code, size). The last TRACE_RING_EVENTS events are kept
+ * (TRACE_RING_INTERNAL_EVENTS on boards without PSRAM: begin() places the
+ * ring with BufferPlacement; nothing is recorded before). A slot is claimed
+ * with one atomic increment, so the receive task on core 0 and the main
+ * loop on core 1 both record without a lock.
+ *
+ * GET /trace (TraceWebServer) freezes the ring and streams it through
+ * TraceChromeWriter. The result loads directly into Perfetto
+ * (ui.perfetto.dev) or chrome://tracing, one track per core:
+ * - CCOUNT timestamps are relative to the first event seen on each core;
+ *   the tick aligns the cores to each other (~1 ms) and resolves CCOUNT
+ *   wrap-around (17.9 s at 240 MHz)
+ * - an event being written at the instant of the freeze may be torn
+ *
+ * Without TRACE_ENABLED (and in unit test builds) the macros compile to
+ * nothing. The recorder itself is Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): ring placed once at boot, PSRAM first
+ * - Principle V (Network Debugging): on-device timelines over HTTP
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef TRACE_RECORDER_H
+#define TRACE_RECORDER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "../config.h"
+
+/// Returns a free-running CPU cycle count
+typedef uint32_t (*CycleCounter)();
+
+/**
+ * @brief Instrumented spans (names in TraceRecorder::name())
+ */
+enum class TraceId : uint8_t {
+    N2K_PARSE = 0,      ///< NMEA2000 PGN handler (arg: PGN)
+    N0183_SENTENCE,     ///< NMEA 0183 sentence handler (arg: packed sentence code)
+    CALCULATE,          ///< Derived parameter calculation
+    SERIALIZE,          ///< BoatData frame encoding (arg: stream mode)
+    WS_SEND,            ///< WebSocket sends of one frame (arg: bytes)
+    DISPLAY_RENDER,     ///< OLED page render
+    COUNT
+};
+
+/**
+ * @brief One recorded event (16 bytes)
+ */
+struct TraceEvent {
+    uint32_t cycles;    ///< CCOUNT of the recording core
+    uint32_t tick;      ///< FreeRTOS tick count (ms)
+    uint32_t arg;
+    uint8_t id;         ///< TraceId
+    uint8_t end;        ///< 0 = begin, 1 = end
+    uint8_t core;
+    uint8_t reserved;
+};
+
+/**
+ * @class TraceRecorder
+ * @brief Lock-free ring of the most recent TRACE_RING_EVENTS events
+ */
+class TraceRecorder {
+public:
+    static_assert((TRACE_RING_EVENTS & (TRACE_RING_EVENTS - 1)) == 0, "TRACE_RING_EVENTS must be a power of two");
+    static_assert((TRACE_RING_INTERNAL_EVENTS & (TRACE_RING_INTERNAL_EVENTS - 1)) == 0,
+                  "TRACE_RING_INTERNAL_EVENTS must be a power of two");
+
+    static constexpr uint32_t CAPACITY = TRACE_RING_EVENTS;                    ///< In PSRAM
+    static constexpr uint32_t INTERNAL_CAPACITY = TRACE_RING_INTERNAL_EVENTS;  ///< Without PSRAM
+
+    /// Paused until begin() has placed the ring
+    explicit TraceRecorder(CycleCounter counter);
+
+    /**
+     * @brief Place the ring and start recording (setup(), once PSRAM is up)
+     * @return false if no memory was found for it (recording stays off)
+     */
+    bool begin();
+
+    /**
+     * @brief Append an event (any task, not from an ISR)
+     */
+    void record(TraceId id, bool end, uint8_t core, uint32_t tick, uint32_t arg) {
+        if (paused_.load(std::memory_order_relaxed)) {
+            return;
+        }
+        uint32_t seq = head_.fetch_add(1, std::memory_order_relaxed);
+        TraceEvent& event = events_[seq & mask_];
+        event.cycles = counter_();
+        event.tick = tick;
+        event.arg = arg;
+        event.id = static_cast<uint8_t>(id);
+        event.end = end ? 1 : 0;
+        event.core = core;
+    }
+
+    /// Stop recording (the ring can then be read consistently)
+    void pause() { paused_.store(true, std::memory_order_release); }
+    void resume() {
+        if (events_ != nullptr) {
+            paused_.store(false, std::memory_order_release);
+        }
+    }
+    bool isPaused() const { return paused_.load(std::memory_order_acquire); }
+
+    /// Forget all events (while paused)
+    void clear() { head_.store(0, std::memory_order_release); }
+
+    /// Events the ring holds: CAPACITY, INTERNAL_CAPACITY, or 0 before begin()
+    uint32_t getCapacity() const { return events_ != nullptr ? mask_ + 1 : 0; }
+
+    /// Events recorded since boot or clear(); the ring holds the last getCapacity()
+    uint32_t getRecorded() const { return head_.load(std::memory_order_acquire); }
+
+    /// Sequence number of the oldest event still in the ring
+    uint32_t getOldest() const;
+
+    /// Event @p seq (must be within [getOldest(), getRecorded()))
+    const TraceEvent& at(uint32_t seq) const { return events_[seq & mask_]; }
+
+    /**
+     * @brief Innermost span begun on @p core and not ended yet (stall reports)
+     *
+     * Scans back from the newest event; spans whose begin has already left
+     * the ring are not found. Read while recording: a concurrent event may
+     * be missed.
+     *
+     * @return TraceId value, or TraceId::COUNT if no span is open
+     */
+    uint8_t lastOpen(uint8_t core) const;
+
+    /// Span name ("n2k_parse", ...); "unknown" if out of range
+    static const char* name(uint8_t id);
+
+    /// Name of the span's argument in the trace JSON ("pgn", ...)
+    static const char* argName(uint8_t id);
+
+private:
+    CycleCounter counter_;
+    TraceEvent* events_;      ///< getCapacity() events, placed by begin()
+    uint32_t mask_;
+    std::atomic<uint32_t> head_;
+    std::atomic<bool> paused_;
+};
+
+/**
+ * @class TraceChromeWriter
+ * @brief Serializes a paused TraceRecorder as Chrome trace_event JSON, in pieces
+ *
+ * read() fills any buffer size (chunked HTTP responses):
+ * {"displayTimeUnit":"ms","otherData":{"cpu_mhz":240,"recorded":N,"events":M},
+ *  "traceEvents":[{"name":"thread_name","ph":"M","pid":1,"tid":0,"args":{"name":"core 0"}},
+ *  {"name":"n2k_parse","ph":"B","ts":12.5,"pid":1,"tid":0,"args":{"pgn":127250}},...]}
+ */
+class TraceChromeWriter {
+public:
+    /**
+     * @param recorder Paused for the writer's lifetime
+     * @param cpuMhz CCOUNT cycles per microsecond
+     */
+    TraceChromeWriter(const TraceRecorder& recorder, uint32_t cpuMhz);
+
+    /**
+     * @brief Copy the next part of the document into @p buffer
+     * @return Bytes written; 0 once the document is complete
+     */
+    size_t read(char* buffer, size_t maxLen);
+
+    /// Events the document contains
+    uint32_t getEventCount() const { return end_ - start_; }
+
+private:
+    enum Stage : uint8_t { HEADER = 0, THREADS, EVENTS, FOOTER, DONE };
+
+    static constexpr uint8_t MAX_CORES = 2;
+
+    const TraceRecorder& recorder_;
+    uint32_t cpuMhz_;
+    uint32_t start_;
+    uint32_t end_;
+    uint32_t next_;
+    Stage stage_;
+    uint8_t thread_;
+    bool first_;                          ///< No traceEvents element written yet
+    bool seen_[MAX_CORES];
+    uint32_t originCycles_[MAX_CORES];    ///< First event per core
+    uint32_t originTick_[MAX_CORES];
+    uint32_t baseTick_;                   ///< Earliest first-event tick of all cores
+    char piece_[224];
+    size_t pieceLen_;
+    size_t piecePos_;
+
+    bool nextPiece();
+    double timestampUs(const TraceEvent& event) const;
+};
+
+#if TRACE_ENABLED && defined(ARDUINO) && !defined(UNIT_TEST)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+extern TraceRecorder traceRecorder;
+
+#define TRACE_EVENT(id, end, arg) \
+    traceRecorder.record((id), (end), static_cast<uint8_t>(xPortGetCoreID()), xTaskGetTickCount(), (arg))
+#define TRACE_BEGIN(id, arg) TRACE_EVENT((id), false, (arg))
+#define TRACE_END(id) TRACE_EVENT((id), true, 0)
+
+/// Begin at construction, end at scope exit
+class TraceScope {
+public:
+    TraceScope(TraceId id, uint32_t arg) : id_(id) { TRACE_BEGIN(id, arg); }
+    ~TraceScope() { TRACE_END(id_); }
+
+private:
+    TraceId id_;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+#define TRACE_SCOPE(id, arg) TraceScope TRACE_CONCAT(traceScope_, __LINE__)((id), (arg))
+#else
+#define TRACE_BEGIN(id, arg) ((void)0)
+#define TRACE_END(id) ((void)0)
+#define TRACE_SCOPE(id, arg) ((void)0)
+#endif
+
+#endif // TRACE_RECORDER_H
@@ -0,0 +1,374 @@
+/**
+ * @file TripCounters.cpp
+ * @brief Implementation of the accumulated counters and their commit schedule
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "TripCounters.h"
+#include <math.h>
+#include <string.h>
+
+namespace {
+
+const char* const COUNTER_NAMES[] = {"engine_hours", "distance", "battery_a", "battery_b", "shore"};
+
+constexpr double MS_PER_HOUR = 3600000.0;
+constexpr float MS_PER_DAY = 86400000.0f;
+
+bool exceeds(double now, double then, double step) {
+    return now - then >= step || then - now >= step;
+}
+
+}  // namespace
+
+const char* TripCounterName(TripCounter counter) {
+    uint8_t index = static_cast<uint8_t>(counter);
+    return index < static_cast<uint8_t>(TripCounter::COUNT) ? COUNTER_NAMES[index] : "all";
+}
+
+bool TripCounterFromName(const char* name, TripCounter& counter) {
+    if (name == nullptr) {
+        return false;
+    }
+    if (strcmp(name, "all") == 0) {
+        counter = TripCounter::COUNT;
+        return true;
+    }
+    for (uint8_t i = 0; i < static_cast<uint8_t>(TripCounter::COUNT); i++) {
+        if (strcmp(name, COUNTER_NAMES[i]) == 0) {
+            counter = static_cast<TripCounter>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+TripCounters::TripCounters()
+    : soc_{BatterySocEstimator(BATTERY_A_CAPACITY_AH), BatterySocEstimator(BATTERY_B_CAPACITY_AH)},
+      lastSampleMs_(0),
+      sampled_(false),
+      changed_(false),
+      forcePending_(false),
+      pendingForced_(false),
+      lowVoltageArmed_(true),
+      resetMask_(0),
+      lastCommitMs_(0),
+      lastRefillMs_(0),
+      tokens_(TRIP_COMMIT_BURST),
+      commits_(0),
+      forcedCommits_(0),
+      deferred_(0),
+      deferring_(false) {
+    memset(&values_, 0, sizeof(values_));
+    memset(&committedValues_, 0, sizeof(committedValues_));
+    memset(&lock_, 0, sizeof(lock_));
+    for (uint8_t bank = 0; bank < 2; bank++) {
+        socValues_.bank[bank] = soc_[bank].getStatus();
+        committedSoc_[bank] = 0.0;
+    }
+}
+
+bool TripCounters::fresh(bool available, unsigned long lastUpdate, uint32_t nowMs) {
+    return available && static_cast<uint32_t>(nowMs - lastUpdate) <= TRIP_STALE_MS;
+}
+
+void TripCounters::sample(const BoatDataStructure& data, uint32_t nowMs) {
+    applyResets();
+    if (lowVoltage(data, nowMs)) {
+        forcePending_ = true;  // Supply dipping: commit before a brownout reset can lose the totals
+    }
+
+    uint32_t elapsed = nowMs - lastSampleMs_;
+    bool first = !sampled_;
+    sampled_ = true;
+    lastSampleMs_ = nowMs;
+    if (first || elapsed == 0 || elapsed > TRIP_MAX_GAP_MS) {
+        return;  // Nothing to integrate over, or a gap
+    }
+    double hours = elapsed / MS_PER_HOUR;
+    bool changed = false;
+
+    lock_.writeBegin();
+    if (fresh(data.engine.available, data.engine.lastUpdate, nowMs) && data.engine.engineRev > 0) {
+        values_.engineSeconds += elapsed / 1000.0;
+        changed = true;
+    }
+    if (fresh(data.gps.available, data.gps.lastUpdate, nowMs) && data.gps.sog >= TRIP_SOG_MIN_KN) {
+        values_.distanceNm += data.gps.sog * hours;
+        changed = true;
+    }
+    if (fresh(data.battery.available, data.battery.lastUpdate, nowMs)) {
+        const double amps[2] = {data.battery.amperageA, data.battery.amperageB};
+        const double volts[2] = {data.battery.voltageA, data.battery.voltageB};
+        for (uint8_t bank = 0; bank < 2; bank++) {
+            bool wasValid = soc_[bank].isValid();
+            if (soc_[bank].sample(amps[bank], volts[bank], elapsed)) {
+                if (wasValid) {
+                    changed = true;  // Re-anchored from the resting voltage
+                } else {
+                    committedSoc_[bank] = soc_[bank].getStateOfCharge();  // Started: not a change
+                }
+            }
+            socValues_.bank[bank] = soc_[bank].getStatus();
+            if (amps[bank] > 0) {
+                values_.ampHoursIn[bank] += amps[bank] * hours;
+                changed = true;
+            } else if (amps[bank] < 0) {
+                values_.ampHoursOut[bank] -= amps[bank] * hours;
+                changed = true;
+            }
+        }
+    }
+    if (fresh(data.shorePower.available, data.shorePower.lastUpdate, nowMs) &&
+        data.shorePower.shorePowerOn && data.shorePower.power > 0) {
+        values_.shoreKWh += data.shorePower.power * hours / 1000.0;
+        changed = true;
+    }
+    lock_.writeEnd();
+
+    changed_ = changed_ || changed;
+}
+
+bool TripCounters::lowVoltage(const BoatDataStructure& data, uint32_t nowMs) {
+    if (TRIP_LOW_VOLTAGE_V <= 0 || !fresh(data.battery.available, data.battery.lastUpdate, nowMs)) {
+        return false;
+    }
+    double volts = TRIP_SUPPLY_BANK == 0 ? data.battery.voltageA : data.battery.voltageB;
+    if (volts <= 0) {
+        return false;  // No reading
+    }
+    if (volts >= TRIP_LOW_VOLTAGE_V + TRIP_LOW_VOLTAGE_HYSTERESIS_V) {
+        lowVoltageArmed_ = true;
+        return false;
+    }
+    if (volts < TRIP_LOW_VOLTAGE_V && lowVoltageArmed_) {
+        lowVoltageArmed_ = false;  // Once per dip
+        return true;
+    }
+    return false;
+}
+
+void TripCounters::requestReset(TripCounter counter) {
+    uint8_t bits = counter == TripCounter::COUNT ? static_cast<uint8_t>((1u << static_cast<uint8_t>(TripCounter::COUNT)) - 1)
+                                                 : static_cast<uint8_t>(1u << static_cast<uint8_t>(counter));
+    resetMask_.fetch_or(bits);
+}
+
+void TripCounters::applyResets() {
+    uint8_t mask = resetMask_.exchange(0);
+    if (mask == 0) {
+        return;
+    }
+    lock_.writeBegin();
+    if (mask & (1u << static_cast<uint8_t>(TripCounter::ENGINE_HOURS))) {
+        values_.engineSeconds = 0;
+    }
+    if (mask & (1u << static_cast<uint8_t>(TripCounter::DISTANCE))) {
+        values_.distanceNm = 0;
+    }
+    for (uint8_t bank = 0; bank < 2; bank++) {
+        if (mask & (1u << (static_cast<uint8_t>(TripCounter::BATTERY_A) + bank))) {
+            values_.ampHoursIn[bank] = 0;
+            values_.ampHoursOut[bank] = 0;
+        }
+    }
+    if (mask & (1u << static_cast<uint8_t>(TripCounter::SHORE))) {
+        values_.shoreKWh = 0;
+    }
+    lock_.writeEnd();
+    changed_ = true;
+    forcePending_ = true;  // A reset survives a power cut right after it
+}
+
+void TripCounters::refill(uint32_t nowMs) {
+    uint32_t elapsed = nowMs - lastRefillMs_;
+    lastRefillMs_ = nowMs;
+    tokens_ += elapsed * (TRIP_COMMIT_DAILY_BUDGET / MS_PER_DAY);
+    if (tokens_ > TRIP_COMMIT_BURST) {
+        tokens_ = TRIP_COMMIT_BURST;
+    }
+}
+
+bool TripCounters::significantChange() const {
+    const TripCounterValues& a = values_;
+    const TripCounterValues& b = committedValues_;
+    if (exceeds(a.engineSeconds, b.engineSeconds, TRIP_COMMIT_ENGINE_STEP_S) ||
+        exceeds(a.distanceNm, b.distanceNm, TRIP_COMMIT_DISTANCE_STEP_NM) ||
+        exceeds(a.shoreKWh, b.shoreKWh, TRIP_COMMIT_KWH_STEP)) {
+        return true;
+    }
+    for (uint8_t bank = 0; bank < 2; bank++) {
+        if (exceeds(a.ampHoursIn[bank], b.ampHoursIn[bank], TRIP_COMMIT_AH_STEP) ||
+            exceeds(a.ampHoursOut[bank], b.ampHoursOut[bank], TRIP_COMMIT_AH_STEP) ||
+            exceeds(soc_[bank].getStateOfCharge(), committedSoc_[bank], BATTERY_SOC_COMMIT_STEP_PCT)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TripCounters::commitDue(uint32_t nowMs) {
+    refill(nowMs);
+    pendingForced_ = false;
+    if (!changed_) {
+        forcePending_ = false;  // Nothing new to protect
+        return false;
+    }
+    if (forcePending_) {
+        pendingForced_ = true;
+        return true;
+    }
+
+    uint32_t sinceCommit = nowMs - lastCommitMs_;
+    if (sinceCommit < TRIP_COMMIT_MIN_INTERVAL_MS) {
+        return false;
+    }
+    if (sinceCommit < TRIP_COMMIT_INTERVAL_MS && !significantChange()) {
+        return false;
+    }
+    if (tokens_ < 1.0f) {
+        if (!deferring_) {
+            deferred_++;
+            deferring_ = true;
+        }
+        return false;  // Over the daily write budget: wait for the bucket
+    }
+    return true;
+}
+
+void TripCounters::committed(uint32_t nowMs) {
+    // Forced commits are paid from the budget too (down to one burst of debt)
+    tokens_ -= 1.0f;
+    if (tokens_ < -TRIP_COMMIT_BURST) {
+        tokens_ = -TRIP_COMMIT_BURST;
+    }
+    commits_++;
+    if (pendingForced_) {
+        forcedCommits_++;
+    }
+    lastCommitMs_ = nowMs;
+    committedValues_ = values_;
+    for (uint8_t bank = 0; bank < 2; bank++) {
+        committedSoc_[bank] = soc_[bank].getStateOfCharge();
+    }
+    changed_ = false;
+    forcePending_ = false;
+    pendingForced_ = false;
+    deferring_ = false;
+}
+
+TripCounterValues TripCounters::snapshot() const {
+    TripCounterValues copy;
+    lock_.read(values_, copy);
+    return copy;
+}
+
+TripSocValues TripCounters::socSnapshot() const {
+    TripSocValues copy;
+    lock_.read(socValues_, copy);
+    return copy;
+}
+
+size_t TripCounters::encodeRecord(uint8_t* out, size_t size) const {
+    ConfigRecordWriter record(out, size);
+    record.putF64(values_.engineSeconds)
+        .putF64(values_.distanceNm)
+        .putF64(values_.ampHoursIn[0])
+        .putF64(values_.ampHoursOut[0])
+        .putF64(values_.ampHoursIn[1])
+        .putF64(values_.ampHoursOut[1])
+        .putF64(values_.shoreKWh);
+    for (uint8_t bank = 0; bank < 2; bank++) {
+        // Accumulator as two 32-bit halves; valid = 0 lets the estimator start from the voltage
+        uint64_t charge = static_cast<uint64_t>(soc_[bank].getCharge());
+        record.putU8(soc_[bank].isValid() ? 1 : 0)
+            .putU32(static_cast<uint32_t>(charge & 0xFFFFFFFFu))
+            .putU32(static_cast<uint32_t>(charge >> 32));
+    }
+    return record.finish(TRIP_RECORD_SCHEMA);
+}
+
+ConfigRecordStatus TripCounters::decodeRecord(const uint8_t* data, size_t length) {
+    ConfigRecordReader record(data, length);
+    uint16_t schema = 0;
+    ConfigRecordStatus status = record.open(schema);
+    if (status != ConfigRecordStatus::OK) {
+        return status;
+    }
+    TripCounterValues restored;
+    restored.engineSeconds = record.getF64();
+    restored.distanceNm = record.getF64();
+    restored.ampHoursIn[0] = record.getF64();
+    restored.ampHoursOut[0] = record.getF64();
+    restored.ampHoursIn[1] = record.getF64();
+    restored.ampHoursOut[1] = record.getF64();
+    restored.shoreKWh = record.getF64();
+    bool socValid[2] = {false, false};
+    int64_t socCharge[2] = {0, 0};
+    for (uint8_t bank = 0; bank < 2 && schema >= 2; bank++) {
+        socValid[bank] = record.getU8() != 0;
+        uint64_t low = record.getU32();
+        uint64_t high = record.getU32();
+        socCharge[bank] = static_cast<int64_t>(low | (high << 32));
+    }
+    if (!record.ok()) {
+        return ConfigRecordStatus::TRUNCATED;
+    }
+    for (uint8_t bank = 0; bank < 2; bank++) {
+        if (socValid[bank]) {
+            soc_[bank].restore(socCharge[bank]);
+        } else {
+            soc_[bank].invalidate();
+        }
+        committedSoc_[bank] = soc_[bank].getStateOfCharge();
+    }
+
+    lock_.writeBegin();
+    values_ = restored;
+    for (uint8_t bank = 0; bank < 2; bank++) {
+        socValues_.bank[bank] = soc_[bank].getStatus();
+    }
+    lock_.writeEnd();
+    committedValues_ = restored;
+    changed_ = false;
+    return ConfigRecordStatus::OK;
+}
+
+void TripCounters::writeJson(JsonWriter& json, const char* key) const {
+    TripCounterValues v = snapshot();
+    TripSocValues soc = socSnapshot();
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("engine_hours", v.engineSeconds / 3600.0)
+        .add("distance_nm", v.distanceNm, 1)
+        .beginObject("battery_a")
+            .add("ah_in", v.ampHoursIn[0], 1)
+            .add("ah_out", v.ampHoursOut[0], 1)
+        .endObject()
+        .beginObject("battery_b")
+            .add("ah_in", v.ampHoursIn[1], 1)
+            .add("ah_out", v.ampHoursOut[1], 1)
+        .endObject()
+        .add("shore_kwh", v.shoreKWh)
+        .add("commits", (unsigned long)commits_)
+        .add("forced_commits", (unsigned long)forcedCommits_)
+        .add("deferred", (unsigned long)deferred_)
+        .add("budget", static_cast<double>(tokens_), 1)
+        .add("uncommitted", changed_)
+        .beginObject("state_of_charge");
+    for (uint8_t bank = 0; bank < 2; bank++) {
+        const BatterySocStatus& status = soc.bank[bank];
+        json.beginObject(bank == 0 ? "battery_a" : "battery_b")
+            .add("soc", status.valid ? status.stateOfCharge : NAN, 1)
+            .add("current", status.averageCurrent, 1)
+            .add("time_to_empty_s", status.timeToEmptyS, 0)
+            .add("time_to_full_s", status.timeToFullS, 0)
+            .endObject();
+    }
+    json.endObject().endObject();
+}
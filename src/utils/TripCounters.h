@@ -0,0 +1,213 @@
+/**
+ * @file TripCounters.h
+ * @brief Accumulated engine hours, distance log, battery amp-hours and shore energy
+ *
+ * sample() integrates the current BoatData values over the time since the
+ * previous sample: constant work per call, whatever the running time. A
+ * group that is unavailable or older than TRIP_STALE_MS adds nothing, and a
+ * gap longer than TRIP_MAX_GAP_MS (boot, stalled loop) is skipped instead
+ * of being integrated at the last value.
+ *
+ * - Engine hours: time with EngineData.engineRev > 0
+ * - Distance: GPSData.sog (knots) over time, below TRIP_SOG_MIN_KN ignored (GPS jitter at anchor)
+ * - Amp-hours per bank: BatteryData.amperageA/B, positive (charging) into ah_in, negative into ah_out
+ * - Shore energy: ShorePowerData.power while shorePowerOn
+ * - State of charge per bank: a BatterySocEstimator fed with the same
+ *   battery samples (coulomb counting, Peukert, charge efficiency,
+ *   rest-voltage re-anchoring), with time to empty and time to full
+ *
+ * The totals live in RAM. commitDue() decides when they are worth an NVS
+ * write (record "trip", ConfigRecord format):
+ * - after TRIP_COMMIT_INTERVAL_MS with any change, or earlier on a
+ *   significant change (TRIP_COMMIT_*_STEP), never closer than
+ *   TRIP_COMMIT_MIN_INTERVAL_MS;
+ * - every commit takes a token from a bucket refilled with
+ *   TRIP_COMMIT_DAILY_BUDGET tokens per day, so flash writes stay within
+ *   the daily budget however the values change (deferred commits are
+ *   counted);
+ * - a forced commit bypasses both: the supply bank voltage falling below
+ *   TRIP_LOW_VOLTAGE_V (once per dip), a counter reset, or a restart.
+ *
+ * The record also carries each estimator's charge accumulator (schema 2; a
+ * schema 1 record restores the totals and the estimators start from the
+ * voltage). A re-anchor moving the estimate by BATTERY_SOC_COMMIT_STEP_PCT
+ * is a significant change.
+ *
+ * A power cut loses at most the changes since the last commit.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * counters.sample(*boatData->getDataStructure(), millis());   // TRIP_SAMPLE_INTERVAL_MS
+ * if (counters.commitDue(millis())) {
+ *     size_t length = counters.encodeRecord(buffer, sizeof(buffer));
+ *     if (store->write("trip", buffer, length)) counters.committed(millis());
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed state, no heap; bounded flash writes per day
+ * - Principle VII (Fail-Safe): stale data and gaps are not integrated; a damaged record starts from zero
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef TRIP_COUNTERS_H
+#define TRIP_COUNTERS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "BatterySoc.h"
+#include "ConfigRecord.h"
+#include "JsonWriter.h"
+#include "SeqLock.h"
+#include "../config.h"
+#include "../types/BoatDataTypes.h"
+
+/// NVS key and payload layout of the counter record
+#define TRIP_RECORD_KEY "trip"
+#define TRIP_RECORD_SCHEMA 2
+
+/**
+ * @brief Resettable counters (POST /counters/reset?counter=<name>)
+ */
+enum class TripCounter : uint8_t {
+    ENGINE_HOURS = 0,
+    DISTANCE,
+    BATTERY_A,
+    BATTERY_B,
+    SHORE,
+    COUNT
+};
+
+const char* TripCounterName(TripCounter counter);
+
+/// Counter name to enum; "all" is TripCounter::COUNT
+bool TripCounterFromName(const char* name, TripCounter& counter);
+
+/**
+ * @brief Accumulated totals (guarded by TripCounters' SeqLock)
+ */
+struct TripCounterValues {
+    double engineSeconds;
+    double distanceNm;
+    double ampHoursIn[2];     ///< Bank A, bank B
+    double ampHoursOut[2];
+    double shoreKWh;
+};
+
+/**
+ * @brief State-of-charge estimates (guarded by TripCounters' SeqLock)
+ */
+struct TripSocValues {
+    BatterySocStatus bank[2];   ///< Bank A, bank B
+};
+
+/**
+ * @class TripCounters
+ * @brief Integrates the counters and schedules their NVS commits
+ *
+ * sample(), commitDue(), committed() and the record functions run in the
+ * main loop. snapshot(), writeJson() and requestReset() may be called from
+ * the HTTP task.
+ */
+class TripCounters {
+public:
+    TripCounters();
+
+    /// Integrate @p data over the time since the previous sample
+    void sample(const BoatDataStructure& data, uint32_t nowMs);
+
+    /**
+     * @brief Whether the totals should be written now
+     *
+     * Refills the write budget; a commit refused by the budget is counted
+     * as deferred.
+     */
+    bool commitDue(uint32_t nowMs);
+
+    /// Write at the next commitDue() regardless of interval and budget (restart)
+    void forceCommit() { forcePending_ = true; }
+
+    /// The record produced by encodeRecord() was written at @p nowMs
+    void committed(uint32_t nowMs);
+
+    /**
+     * @brief Reset @p counter (COUNT = all) at the next sample (any task)
+     */
+    void requestReset(TripCounter counter);
+
+    /// Consistent copy of the totals (any task)
+    TripCounterValues snapshot() const;
+
+    /// Consistent copy of the state-of-charge estimates (any task)
+    TripSocValues socSnapshot() const;
+
+    /**
+     * @brief Serialize the totals
+     * @return Record length, 0 if @p size is too small
+     */
+    size_t encodeRecord(uint8_t* out, size_t size) const;
+
+    /**
+     * @brief Restore the totals from a stored record (setup only)
+     * @return OK, or why the record was refused (the totals stay zero)
+     */
+    ConfigRecordStatus decodeRecord(const uint8_t* data, size_t length);
+
+    /// State-of-charge estimator of bank 0 (A) or 1 (B) (main loop)
+    const BatterySocEstimator& getEstimator(uint8_t bank) const { return soc_[bank ? 1 : 0]; }
+
+    uint32_t getCommits() const { return commits_; }
+    uint32_t getForcedCommits() const { return forcedCommits_; }
+    uint32_t getDeferred() const { return deferred_; }
+
+    /**
+     * @brief Write the totals and the commit counters as a JSON object
+     *
+     * {"engine_hours":412.35,"distance_nm":2210.4,
+     *  "battery_a":{"ah_in":1520.2,"ah_out":1498.7},"battery_b":{"ah_in":40.1,"ah_out":38.9},
+     *  "shore_kwh":310.55,"commits":88,"forced_commits":2,"deferred":0,"budget":19.5,"uncommitted":true,
+     *  "state_of_charge":{"battery_a":{"soc":81.4,"current":-4.2,"time_to_empty_s":129600,"time_to_full_s":null},
+     *                     "battery_b":{...}}}
+     *
+     * soc is null until the estimator has a value; the times are null at rest.
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    void applyResets();
+    bool significantChange() const;
+    bool lowVoltage(const BoatDataStructure& data, uint32_t nowMs);
+    void refill(uint32_t nowMs);
+
+    static bool fresh(bool available, unsigned long lastUpdate, uint32_t nowMs);
+
+    TripCounterValues values_;
+    TripCounterValues committedValues_;   ///< As of the last commit (significant-change baseline)
+    BatterySocEstimator soc_[2];
+    TripSocValues socValues_;
+    double committedSoc_[2];              ///< Estimate as of the last commit
+    SeqLock lock_;
+
+    uint32_t lastSampleMs_;
+    bool sampled_;
+    bool changed_;                        ///< Values differ from the last commit
+    bool forcePending_;
+    bool pendingForced_;                  ///< The due commit was forced
+    bool lowVoltageArmed_;
+    std::atomic<uint8_t> resetMask_;      ///< Bit per TripCounter
+
+    uint32_t lastCommitMs_;
+    uint32_t lastRefillMs_;
+    float tokens_;
+    uint32_t commits_;
+    uint32_t forcedCommits_;
+    uint32_t deferred_;
+    bool deferring_;                      ///< Current deferral already counted
+};
+
+#endif // TRIP_COUNTERS_H
@@ -0,0 +1,228 @@
+/**
+ * @file UtcClock.cpp
+ * @brief Implementation of the UTC clock
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "UtcClock.h"
+#include <stdio.h>
+#include <string.h>
+
+namespace {
+
+constexpr uint64_t MS_PER_DAY = 86400000ULL;
+
+/// Days since 1970-01-01 of a proleptic Gregorian date (H. Hinnant's days_from_civil)
+int64_t daysFromCivil(int32_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2 ? 1 : 0;
+    int32_t era = (year >= 0 ? year : year - 399) / 400;
+    uint32_t yearOfEra = static_cast<uint32_t>(year - era * 400);
+    uint32_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    uint32_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return static_cast<int64_t>(era) * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+/// Inverse of daysFromCivil() for days >= 0
+void civilFromDays(int64_t days, int32_t& year, uint32_t& month, uint32_t& day) {
+    days += 719468;
+    int64_t era = days / 146097;
+    uint32_t dayOfEra = static_cast<uint32_t>(days - era * 146097);
+    uint32_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    uint32_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    uint32_t mp = (5 * dayOfYear + 2) / 153;
+    day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int32_t>(yearOfEra + era * 400) + (month <= 2 ? 1 : 0);
+}
+
+}  // namespace
+
+UtcClock::UtcClock() {
+    reset();
+}
+
+void UtcClock::reset() {
+    memset(samples_, 0, sizeof(samples_));
+    memset(sampleLocks_, 0, sizeof(sampleLocks_));
+    memset(applied_, 0, sizeof(applied_));
+    base_.utcMs = 0;
+    base_.monoMs = 0;
+    baseLock_.seq = 0;
+    synced_ = false;
+    source_ = UtcSource::NONE;
+    steps_ = 0;
+    slews_ = 0;
+    lastErrorMs_ = 0;
+    sampleMs_ = 0;
+    held_ = false;
+    releasing_ = false;
+    releasedMs_ = 0;
+}
+
+void UtcClock::setHeld(bool held, uint32_t nowMs) {
+    if (held_ && !held) {
+        releasing_ = true;
+        releasedMs_ = nowMs;
+    }
+    held_ = held;
+}
+
+bool UtcClock::offer(UtcSource source, uint64_t utcMs, uint32_t receivedMs) {
+    uint8_t index = static_cast<uint8_t>(source);
+    if (index >= static_cast<uint8_t>(UtcSource::COUNT) || utcMs < MIN_VALID_UTC_MS) {
+        return false;
+    }
+    Sample& sample = samples_[index];
+    sampleLocks_[index].writeBegin();
+    sample.utcMs = utcMs;
+    sample.receivedMs = receivedMs;
+    sample.sequence++;
+    sampleLocks_[index].writeEnd();
+    return true;
+}
+
+bool UtcClock::update(uint32_t nowMs) {
+    if (releasing_ && nowMs - releasedMs_ > UTC_CLOCK_SOURCE_TIMEOUT_MS) {
+        releasing_ = false;  // Every sample of the hold has timed out
+    }
+
+    // Best source heard within the timeout
+    Sample sample = {0, 0, 0};
+    UtcSource best = UtcSource::NONE;
+    for (uint8_t i = 0; i < static_cast<uint8_t>(UtcSource::COUNT); i++) {
+        Sample candidate;
+        if (!sampleLocks_[i].read(samples_[i], candidate) || candidate.sequence == 0 ||
+            nowMs - candidate.receivedMs > UTC_CLOCK_SOURCE_TIMEOUT_MS) {
+            continue;
+        }
+        if (held_ || (releasing_ && static_cast<int32_t>(candidate.receivedMs - releasedMs_) < 0)) {
+            applied_[i] = candidate.sequence;  // Replayed: dropped, the next live sample applies
+            continue;
+        }
+        sample = candidate;
+        best = static_cast<UtcSource>(i);
+        break;
+    }
+    source_ = best;
+
+    bool stepped = false;
+    Base base = base_;
+    if (best != UtcSource::NONE && sample.sequence != applied_[static_cast<uint8_t>(best)]) {
+        applied_[static_cast<uint8_t>(best)] = sample.sequence;
+        sampleMs_ = sample.receivedMs;
+        int64_t error = synced_ ? static_cast<int64_t>(sample.utcMs - project(sample.receivedMs)) : 0;
+        if (!synced_ || error > UTC_CLOCK_STEP_MS || error < -static_cast<int64_t>(UTC_CLOCK_STEP_MS)) {
+            base.utcMs = sample.utcMs;
+            base.monoMs = sample.receivedMs;
+            lastErrorMs_ = static_cast<int32_t>(error);
+            __atomic_store_n(&steps_, steps_ + 1, __ATOMIC_RELAXED);
+            stepped = true;
+        } else {
+            base.utcMs = static_cast<uint64_t>(static_cast<int64_t>(base.utcMs) + error / UTC_CLOCK_SLEW_DIVISOR);
+            lastErrorMs_ = static_cast<int32_t>(error);
+            slews_++;
+        }
+        publish(base);
+        __atomic_store_n(&synced_, true, __ATOMIC_RELEASE);
+    }
+
+    // Keep the base within ±24 days of every stamp converted after this pass
+    if (synced_) {
+        base.utcMs = project(nowMs);
+        base.monoMs = nowMs;
+        publish(base);
+    }
+    return stepped;
+}
+
+uint64_t UtcClock::toUtc(uint32_t ms) const {
+    if (!synced()) {
+        return 0;
+    }
+    Base base;
+    if (!baseLock_.read(base_, base)) {
+        return 0;  // Writer stalled mid-update
+    }
+    return base.utcMs + static_cast<int64_t>(static_cast<int32_t>(ms - base.monoMs));
+}
+
+uint64_t UtcClock::project(uint32_t ms) const {
+    return base_.utcMs + static_cast<int64_t>(static_cast<int32_t>(ms - base_.monoMs));
+}
+
+void UtcClock::publish(const Base& base) {
+    baseLock_.writeBegin();
+    base_ = base;
+    baseLock_.writeEnd();
+}
+
+void UtcClock::writeJson(JsonWriter& json, uint32_t nowMs, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    bool isSynced = synced();
+    json.add("synced", isSynced);
+    if (isSynced) {
+        json.add("utc", static_cast<double>(toUtc(nowMs)), 0);
+        char iso[21];
+        formatIso(toUtc(nowMs), iso, sizeof(iso));
+        json.add("iso", iso);
+    }
+    json.add("source", sourceName(source_))
+        .add("steps", static_cast<unsigned long>(getSteps()))
+        .add("slews", static_cast<unsigned long>(slews_))
+        .add("last_error_ms", static_cast<long>(lastErrorMs_));
+    if (isSynced) {
+        json.add("sample_age_ms", static_cast<unsigned long>(nowMs - sampleMs_));
+    }
+    json.endObject();
+}
+
+const char* UtcClock::sourceName(UtcSource source) {
+    switch (source) {
+        case UtcSource::N2K_SYSTEM_TIME: return "n2k";
+        case UtcSource::NMEA0183_RMC: return "rmc";
+        default: return "none";
+    }
+}
+
+uint64_t UtcClock::fromDays(uint32_t days, uint32_t msOfDay) {
+    return static_cast<uint64_t>(days) * MS_PER_DAY + msOfDay;
+}
+
+uint64_t UtcClock::fromCivil(int32_t year, uint8_t month, uint8_t day, uint32_t msOfDay) {
+    if (year < 1970 || month < 1 || month > 12 || day < 1 || day > 31) {
+        return 0;
+    }
+    return static_cast<uint64_t>(daysFromCivil(year, month, day)) * MS_PER_DAY + msOfDay;
+}
+
+bool UtcClock::formatIso(uint64_t utcMs, char* out, size_t size, bool millis) {
+    if (size < (millis ? 25u : 21u)) {
+        return false;
+    }
+    int32_t year;
+    uint32_t month, day;
+    civilFromDays(static_cast<int64_t>(utcMs / MS_PER_DAY), year, month, day);
+    uint32_t msOfDay = static_cast<uint32_t>(utcMs % MS_PER_DAY);
+    uint32_t seconds = msOfDay / 1000;
+    if (millis) {
+        snprintf(out, size, "%04ld-%02lu-%02luT%02lu:%02lu:%02lu.%03luZ", (long)year, (unsigned long)month,
+                 (unsigned long)day, (unsigned long)(seconds / 3600), (unsigned long)(seconds / 60 % 60),
+                 (unsigned long)(seconds % 60), (unsigned long)(msOfDay % 1000));
+    } else {
+        snprintf(out, size, "%04ld-%02lu-%02luT%02lu:%02lu:%02luZ", (long)year, (unsigned long)month,
+                 (unsigned long)day, (unsigned long)(seconds / 3600), (unsigned long)(seconds / 60 % 60),
+                 (unsigned long)(seconds % 60));
+    }
+    return true;
+}
+
+UtcClock& GetUtcClock() {
+    static UtcClock utcClock;
+    return utcClock;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file UtcClock.h
+ * @brief UTC from the bus (PGN 126992, RMC) mapped onto the millis() timeline
+ *
+ * Every timestamp in the gateway is millis(). The clock keeps one base
+ * pair (UTC ms, millis()) so any millis() stamp converts to UTC with one
+ * subtraction and one add (toUtc()), on any task:
+ *
+ *   utc = base.utcMs + (int32_t)(ms - base.monoMs)
+ *
+ * The signed 32-bit difference survives the millis() wrap at 49.7 days:
+ * update() moves the base to the current millis() every pass, so stamps
+ * within ±24 days of it convert correctly whichever side of a wrap they
+ * fall on.
+ *
+ * Discipline (update(), main loop, ~1 Hz):
+ * - sources in priority order: NMEA 2000 System Time (PGN 126992), then the
+ *   date and time of a valid RMC; a source silent for
+ *   UTC_CLOCK_SOURCE_TIMEOUT_MS yields to the next
+ * - the first sample, or one more than UTC_CLOCK_STEP_MS off, steps the
+ *   base (counted; a step starts a new UTC mark in bus captures)
+ * - a smaller offset error is slewed: 1/UTC_CLOCK_SLEW_DIVISOR of it per
+ *   sample, which averages out the bus and parser latency jitter
+ * - without any source the clock holds over on millis() (crystal drift)
+ * - setHeld() while a bus replay runs: replayed times (another day) are
+ *   never applied, neither during the replay nor when it ends
+ *
+ * offer() stores the newest sample of a source; each source has one writer
+ * task (PGN 126992 from the N2k task, RMC from the main loop), and update()
+ * is the only writer of the base. Samples before 2020 are refused (a GPS
+ * without a fix, an unset chartplotter clock).
+ *
+ * Arduino-free (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * GetUtcClock().offer(UtcSource::N2K_SYSTEM_TIME, UtcClock::fromDays(days, msOfDay), N2kMsg.MsgTime);
+ * if (GetUtcClock().update(millis())) { ... }   // Stepped
+ * uint64_t utc = GetUtcClock().toUtc(record.timestamp);   // 0 = not synced yet
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed state, zero heap allocation
+ * - Principle VII (Fail-Safe): implausible samples are refused; unsynced stamps stay millis() only
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef UTC_CLOCK_H
+#define UTC_CLOCK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "JsonWriter.h"
+#include "SeqLock.h"
+#include "../config.h"
+
+/**
+ * @brief Time sources, highest priority first
+ */
+enum class UtcSource : uint8_t {
+    N2K_SYSTEM_TIME = 0,   ///< PGN 126992
+    NMEA0183_RMC,          ///< RMC date + time of a valid fix
+    COUNT,
+    NONE = 0xFF
+};
+
+/**
+ * @class UtcClock
+ * @brief UTC ↔ millis() mapping disciplined by the bus time sources
+ */
+class UtcClock {
+public:
+    /// 2020-01-01T00:00:00Z: earlier samples are refused
+    static constexpr uint64_t MIN_VALID_UTC_MS = 1577836800000ULL;
+
+    UtcClock();
+
+    /// Forget the samples and the base (not synced)
+    void reset();
+
+    /**
+     * @brief Store the newest sample of @p source (one writer task per source)
+     * @param utcMs UTC in ms since 1970
+     * @param receivedMs millis() when the sentence or frame arrived
+     * @return false if @p utcMs is before MIN_VALID_UTC_MS or @p source is invalid
+     */
+    bool offer(UtcSource source, uint64_t utcMs, uint32_t receivedMs);
+
+    /**
+     * @brief Apply the newest sample of the best source, move the base to @p nowMs (main loop)
+     * @return true if the base was stepped (first sync or an error above UTC_CLOCK_STEP_MS)
+     */
+    bool update(uint32_t nowMs);
+
+    /**
+     * @brief Ignore every sample while @p held, and those received before the release (main loop)
+     */
+    void setHeld(bool held, uint32_t nowMs);
+
+    /**
+     * @brief UTC of millis() stamp @p ms (any task)
+     * @return ms since 1970, 0 before the first sync
+     */
+    uint64_t toUtc(uint32_t ms) const;
+
+    bool synced() const { return __atomic_load_n(&synced_, __ATOMIC_ACQUIRE); }
+
+    /// Source of the last applied sample, NONE in holdover
+    UtcSource getSource() const { return source_; }
+
+    /// Base steps so far (first sync included)
+    uint32_t getSteps() const { return __atomic_load_n(&steps_, __ATOMIC_RELAXED); }
+
+    /// Offset error of the last applied sample (0 at the first sync), ms
+    int32_t getLastErrorMs() const { return lastErrorMs_; }
+
+    /**
+     * @brief {"synced":true,"utc":1748779200000,"source":"n2k","steps":1,"slews":120,"last_error_ms":-12,"sample_age_ms":400}
+     * @param key Member name, nullptr for a bare object
+     */
+    void writeJson(JsonWriter& json, uint32_t nowMs, const char* key = nullptr) const;
+
+    /// "n2k", "rmc" or "none"
+    static const char* sourceName(UtcSource source);
+
+    /**
+     * @brief UTC ms of @p days since 1970-01-01 plus @p msOfDay (PGN 126992 fields)
+     */
+    static uint64_t fromDays(uint32_t days, uint32_t msOfDay);
+
+    /**
+     * @brief UTC ms of a civil date (proleptic Gregorian) plus @p msOfDay
+     * @return 0 if the date is invalid (month 1-12, day 1-31, year >= 1970)
+     */
+    static uint64_t fromCivil(int32_t year, uint8_t month, uint8_t day, uint32_t msOfDay);
+
+    /**
+     * @brief ISO 8601 "2025-06-01T12:00:00Z" (or with ".123" when @p millis) into @p out
+     * @return false if @p size is too small (21 bytes, 25 with milliseconds)
+     */
+    static bool formatIso(uint64_t utcMs, char* out, size_t size, bool millis = false);
+
+private:
+    struct Sample {
+        uint64_t utcMs;
+        uint32_t receivedMs;
+        uint32_t sequence;          ///< Samples offered so far (0 = none)
+    };
+
+    struct Base {
+        uint64_t utcMs;
+        uint32_t monoMs;
+    };
+
+    Sample samples_[static_cast<uint8_t>(UtcSource::COUNT)];
+    SeqLock sampleLocks_[static_cast<uint8_t>(UtcSource::COUNT)];
+    uint32_t applied_[static_cast<uint8_t>(UtcSource::COUNT)];  ///< Sequence applied by update()
+    Base base_;
+    SeqLock baseLock_;
+    bool synced_;
+    UtcSource source_;
+    uint32_t steps_;
+    uint32_t slews_;
+    int32_t lastErrorMs_;
+    uint32_t sampleMs_;            ///< receivedMs of the last applied sample
+    bool held_;
+    bool releasing_;               ///< Samples of the hold may still be pending
+    uint32_t releasedMs_;          ///< Samples received before this are from the hold
+
+    /// Writer's own view of toUtc()
+    uint64_t project(uint32_t ms) const;
+    void publish(const Base& base);
+};
+
+/// Process-wide UTC clock
+UtcClock& GetUtcClock();
+
+#endif // UTC_CLOCK_H
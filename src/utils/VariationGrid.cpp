@@ -0,0 +1,136 @@
+/**
+ * @file VariationGrid.cpp
+ * @brief Implementation of the magnetic variation grid
+ *
+ * @see VariationGrid.h
+ */
+
+#include "VariationGrid.h"
+#include <math.h>
+
+namespace {
+
+const double DEG_TO_RAD = 0.017453292519943295;
+const double CENTIDEG_TO_RAD = DEG_TO_RAD / 100.0;
+const double WRITE_EPSILON_RAD = 1.0e-4;   // ~0.006 deg: the grid position has not moved a cell
+
+}  // namespace
+
+VariationGrid::VariationGrid()
+    : values_(nullptr),
+      lat0_(0.0f),
+      lon0_(0.0f),
+      step_(0.0f),
+      rows_(0),
+      cols_(0),
+      wraps_(false),
+      lastWritten_(0),
+      sourceSeen_(false),
+      writes_(0) {
+}
+
+bool VariationGrid::attach(const DataTableView& view) {
+    values_ = nullptr;
+    rows_ = 0;
+    cols_ = 0;
+    if (view.data == nullptr || view.version != VARIATION_GRID_VERSION ||
+        view.length < VARIATION_GRID_HEADER_BYTES) {
+        return false;
+    }
+
+    float lat0 = DataTableReadF32(view.data);
+    float lon0 = DataTableReadF32(view.data + 4);
+    float step = DataTableReadF32(view.data + 8);
+    uint16_t rows = DataTableReadU16(view.data + 12);
+    uint16_t cols = DataTableReadU16(view.data + 14);
+    if (!isfinite(lat0) || !isfinite(lon0) || !(step > 0.0f) || rows < 2 || cols < 2 ||
+        view.length < VARIATION_GRID_HEADER_BYTES + static_cast<uint32_t>(rows) * cols * 2) {
+        return false;
+    }
+
+    lat0_ = lat0;
+    lon0_ = lon0;
+    step_ = step;
+    rows_ = rows;
+    cols_ = cols;
+    wraps_ = fabs(static_cast<double>(cols) * step - 360.0) < 1.0e-3;
+    values_ = view.data + VARIATION_GRID_HEADER_BYTES;
+    return true;
+}
+
+double VariationGrid::value(uint16_t row, uint16_t col) const {
+    return DataTableReadI16(values_ + (static_cast<size_t>(row) * cols_ + col) * 2);
+}
+
+bool VariationGrid::lookup(double latDeg, double lonDeg, double& variationRad) const {
+    if (!isAttached() || !isfinite(latDeg) || !isfinite(lonDeg)) {
+        return false;
+    }
+
+    double y = (latDeg - lat0_) / step_;
+    double dLon = fmod(lonDeg - lon0_, 360.0);
+    if (dLon < 0.0) {
+        dLon += 360.0;
+    }
+    double x = dLon / step_;
+    uint16_t lastCol = wraps_ ? cols_ : cols_ - 1;
+    if (y < 0.0 || y > rows_ - 1 || x > lastCol) {
+        return false;
+    }
+
+    uint16_t r = static_cast<uint16_t>(y);
+    uint16_t c = static_cast<uint16_t>(x);
+    if (r >= rows_ - 1) {
+        r = rows_ - 2;  // Northern edge: last cell, fraction 1
+    }
+    if (c >= lastCol) {
+        c = lastCol - 1;
+    }
+    double fy = y - r;
+    double fx = x - c;
+    uint16_t c1 = (c + 1) % cols_;  // Wraps to column 0 only on a 360-degree grid
+
+    double south = value(r, c) + (value(r, c1) - value(r, c)) * fx;
+    double north = value(r + 1, c) + (value(r + 1, c1) - value(r + 1, c)) * fx;
+    variationRad = (south + (north - south) * fy) * CENTIDEG_TO_RAD;
+    return true;
+}
+
+bool VariationGrid::fallback(const GPSData& gps, uint32_t nowMs, double& variationRad) {
+    if (!isAttached() || sourceSeen_) {
+        return false;
+    }
+    if (gps.variation != lastWritten_) {
+        sourceSeen_ = true;  // Someone else set it: never override a measured variation
+        return false;
+    }
+    if (!gps.available || nowMs - gps.lastUpdate > VARIATION_GRID_GPS_FRESH_MS) {
+        return false;
+    }
+
+    double variation;
+    if (!lookup(gps.latitude, gps.longitude, variation)) {
+        return false;
+    }
+    if (writes_ > 0 && fabs(variation - static_cast<double>(lastWritten_)) < WRITE_EPSILON_RAD) {
+        return false;
+    }
+    lastWritten_ = static_cast<BoatScalar>(variation);
+    writes_++;
+    variationRad = variation;
+    return true;
+}
+
+void VariationGrid::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("attached", isAttached())
+        .add("rows", (unsigned int)rows_)
+        .add("cols", (unsigned int)cols_)
+        .add("source_seen", sourceSeen_)
+        .add("writes", (unsigned long)writes_)
+        .endObject();
+}
@@ -0,0 +1,123 @@
+/**
+ * @file VariationGrid.h
+ * @brief Magnetic variation from a lat/lon grid in the tables partition
+ *
+ * Fallback for installations whose GPS sends position but no variation
+ * (no RMC variation field, no PGN 127258): true headings then come out as
+ * magnetic ones. A grid exported from a world magnetic model is read in
+ * place from the mapped DataTableType::VARIATION table and interpolated
+ * bilinearly at the GPS position.
+ *
+ * Payload (version VARIATION_GRID_VERSION, little-endian):
+ *   offset 0   float  lat0   latitude of row 0, degrees (rows go north)
+ *   offset 4   float  lon0   longitude of column 0, degrees (columns go east)
+ *   offset 8   float  step   grid spacing, degrees
+ *   offset 12  uint16 rows
+ *   offset 14  uint16 cols
+ *   offset 16  int16  value[rows][cols]  variation, 0.01 degree, positive = East
+ * A grid whose columns span 360 degrees wraps around the antimeridian.
+ *
+ * The grid never overrides a source: fallback() writes only while the
+ * current variation is still the boot default or the value the grid wrote
+ * last. Once any source has set a different value the grid stays quiet.
+ * It also writes only while the GPS position is fresh
+ * (VARIATION_GRID_GPS_FRESH_MS), so its own patches cannot keep a silent
+ * GPS looking alive.
+ *
+ * Arduino-free (unit tested natively). Main loop only.
+ *
+ * Usage:
+ * @code
+ * DataTableView view;
+ * if (tables.find(DataTableType::VARIATION, view)) variationGrid.attach(view);
+ * // Every VARIATION_GRID_INTERVAL_MS:
+ * double variation;
+ * if (variationGrid.fallback(boatData->getGPSData(), millis(), variation)) {
+ *     patch.variation = variation;
+ *     boatData->patchGPS(GPSField::VARIATION, patch);
+ * }
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef VARIATION_GRID_H
+#define VARIATION_GRID_H
+
+#include <stdint.h>
+#include "DataTables.h"
+#include "JsonWriter.h"
+#include "../types/BoatDataTypes.h"
+#include "../config.h"
+
+/// Payload layout of a DataTableType::VARIATION table
+#define VARIATION_GRID_VERSION 1
+#define VARIATION_GRID_HEADER_BYTES 16
+
+/**
+ * @class VariationGrid
+ * @brief In-place variation lookup and the no-source fallback policy
+ */
+class VariationGrid {
+public:
+    VariationGrid();
+
+    /**
+     * @brief Use the grid of @p view (stays in place, not copied)
+     *
+     * @return false if the version, size or spacing is invalid (detached)
+     */
+    bool attach(const DataTableView& view);
+
+    bool isAttached() const { return values_ != nullptr; }
+
+    uint16_t getRows() const { return rows_; }
+    uint16_t getCols() const { return cols_; }
+
+    /**
+     * @brief Interpolated variation at a position
+     *
+     * @param latDeg Decimal degrees, positive = North
+     * @param lonDeg Decimal degrees, positive = East
+     * @param[out] variationRad Radians, positive = East
+     * @return false if detached or outside the grid
+     */
+    bool lookup(double latDeg, double lonDeg, double& variationRad) const;
+
+    /**
+     * @brief Variation to write, if the grid should fill in for a missing source
+     *
+     * @return true if @p variationRad should be patched into GPS variation
+     */
+    bool fallback(const GPSData& gps, uint32_t nowMs, double& variationRad);
+
+    /// A source set a variation of its own (the fallback is off for this boot)
+    bool isSourceSeen() const { return sourceSeen_; }
+
+    uint32_t getWrites() const { return writes_; }
+
+    /**
+     * @brief Write the state as a JSON object
+     *
+     * {"attached":true,"rows":91,"cols":181,"source_seen":false,"writes":12}
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    double value(uint16_t row, uint16_t col) const;
+
+    const uint8_t* values_;   ///< rows_ x cols_ int16 in the mapped table
+    float lat0_;
+    float lon0_;
+    float step_;
+    uint16_t rows_;
+    uint16_t cols_;
+    bool wraps_;
+
+    BoatScalar lastWritten_;  ///< Variation the grid wrote last (boot default before)
+    bool sourceSeen_;
+    uint32_t writes_;
+};
+
+#endif // VARIATION_GRID_H
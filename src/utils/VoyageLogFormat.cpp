@@ -0,0 +1,325 @@
+/**
+ * @file VoyageLogFormat.cpp
+ * @brief Implementation of the voyage recorder segment format
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "VoyageLogFormat.h"
+#include <string.h>
+
+namespace {
+
+const uint8_t HEADER_MAGIC[4] = {'P', '2', 'V', 'L'};
+const uint8_t FOOTER_MAGIC[4] = {'P', '2', 'V', 'X'};
+
+constexpr uint8_t MAX_VARINT = 5;
+constexpr uint8_t BLOCK_COUNT = (VOYAGE_LOG_FIELD_COUNT + 7) / 8;
+
+/**
+ * @brief Position and width of one delta-coded snapshot member
+ */
+struct FieldInfo {
+    uint8_t offset;
+    uint8_t size;
+};
+
+#define VOYAGE_LOG_FIELD(member) \
+    {static_cast<uint8_t>(offsetof(BoatDataSnapshot, member)), \
+     static_cast<uint8_t>(sizeof(BoatDataSnapshot::member))},
+
+constexpr FieldInfo FIELDS[] = {
+    VOYAGE_LOG_FIELD(flags) VOYAGE_LOG_FIELD(present)
+    VOYAGE_LOG_FIELD(latitude) VOYAGE_LOG_FIELD(longitude) VOYAGE_LOG_FIELD(cog) VOYAGE_LOG_FIELD(sog)
+    VOYAGE_LOG_FIELD(variation) VOYAGE_LOG_FIELD(fixQuality) VOYAGE_LOG_FIELD(satellites) VOYAGE_LOG_FIELD(hdop)
+    VOYAGE_LOG_FIELD(trueHeading) VOYAGE_LOG_FIELD(magneticHeading) VOYAGE_LOG_FIELD(rateOfTurn)
+    VOYAGE_LOG_FIELD(heelAngle) VOYAGE_LOG_FIELD(pitchAngle) VOYAGE_LOG_FIELD(heave)
+    VOYAGE_LOG_FIELD(apparentWindAngle) VOYAGE_LOG_FIELD(apparentWindSpeed)
+    VOYAGE_LOG_FIELD(depth) VOYAGE_LOG_FIELD(measuredBoatSpeed) VOYAGE_LOG_FIELD(seaTemperature)
+    VOYAGE_LOG_FIELD(steeringAngle)
+    VOYAGE_LOG_FIELD(engineRev) VOYAGE_LOG_FIELD(oilTemperature) VOYAGE_LOG_FIELD(alternatorVoltage)
+    VOYAGE_LOG_FIELD(voltageA) VOYAGE_LOG_FIELD(amperageA) VOYAGE_LOG_FIELD(stateOfChargeA)
+    VOYAGE_LOG_FIELD(voltageB) VOYAGE_LOG_FIELD(amperageB) VOYAGE_LOG_FIELD(stateOfChargeB)
+    VOYAGE_LOG_FIELD(shorePower)
+    VOYAGE_LOG_FIELD(awaOffset) VOYAGE_LOG_FIELD(awaHeel) VOYAGE_LOG_FIELD(leeway) VOYAGE_LOG_FIELD(stw)
+    VOYAGE_LOG_FIELD(tws) VOYAGE_LOG_FIELD(twa) VOYAGE_LOG_FIELD(wdir) VOYAGE_LOG_FIELD(vmg)
+    VOYAGE_LOG_FIELD(soc) VOYAGE_LOG_FIELD(doc) VOYAGE_LOG_FIELD(polarSpeed) VOYAGE_LOG_FIELD(polarPerformance)
+    VOYAGE_LOG_FIELD(targetTwa) VOYAGE_LOG_FIELD(targetVmg)
+    VOYAGE_LOG_FIELD(twsAvg10s) VOYAGE_LOG_FIELD(twsAvg1m) VOYAGE_LOG_FIELD(twsAvg10m)
+    VOYAGE_LOG_FIELD(wdirAvg10s) VOYAGE_LOG_FIELD(wdirAvg1m) VOYAGE_LOG_FIELD(wdirAvg10m)
+    VOYAGE_LOG_FIELD(vmgAvg10s) VOYAGE_LOG_FIELD(vmgAvg1m) VOYAGE_LOG_FIELD(vmgAvg10m)
+    VOYAGE_LOG_FIELD(gust10s) VOYAGE_LOG_FIELD(gust1m) VOYAGE_LOG_FIELD(gust10m)
+};
+
+#undef VOYAGE_LOG_FIELD
+
+constexpr size_t fieldBytes(size_t i = 0) {
+    return i < sizeof(FIELDS) / sizeof(FIELDS[0]) ? FIELDS[i].size + fieldBytes(i + 1) : 0;
+}
+
+static_assert(sizeof(FIELDS) / sizeof(FIELDS[0]) == VOYAGE_LOG_FIELD_COUNT, "VOYAGE_LOG_FIELD_COUNT out of date");
+static_assert(fieldBytes() == sizeof(BoatDataSnapshot) - sizeof(uint8_t) - sizeof(uint32_t),
+              "Snapshot member missing from FIELDS (version and timestampMs are not delta-coded)");
+
+void writeU32(uint8_t* out, uint32_t value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+    out[2] = static_cast<uint8_t>(value >> 16);
+    out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint32_t readU32(const uint8_t* in) {
+    return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+           (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+/// Member value widened to 32 bits (little endian, as stored)
+uint32_t readField(const BoatDataSnapshot& snapshot, const FieldInfo& field) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&snapshot) + field.offset;
+    uint32_t value = 0;
+    for (uint8_t i = 0; i < field.size; i++) {
+        value |= static_cast<uint32_t>(p[i]) << (8 * i);
+    }
+    return value;
+}
+
+void writeField(BoatDataSnapshot& snapshot, const FieldInfo& field, uint32_t value) {
+    uint8_t* p = reinterpret_cast<uint8_t*>(&snapshot) + field.offset;
+    for (uint8_t i = 0; i < field.size; i++) {
+        p[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+/// current - previous wrapped to the field width, sign-extended
+int32_t fieldDelta(uint32_t current, uint32_t previous, uint8_t size) {
+    uint32_t diff = current - previous;
+    switch (size) {
+        case 1: return static_cast<int8_t>(diff);
+        case 2: return static_cast<int16_t>(diff);
+        default: return static_cast<int32_t>(diff);
+    }
+}
+
+size_t writeVarint(uint8_t* out, uint32_t value) {
+    size_t pos = 0;
+    do {
+        uint8_t byte = static_cast<uint8_t>(value & 0x7F);
+        value >>= 7;
+        out[pos++] = value != 0 ? static_cast<uint8_t>(byte | 0x80) : byte;
+    } while (value != 0);
+    return pos;
+}
+
+/// Bytes consumed, 0 if incomplete, -1 if longer than MAX_VARINT
+int32_t readVarint(const uint8_t* in, size_t size, uint32_t& value) {
+    value = 0;
+    for (size_t i = 0; i < MAX_VARINT; i++) {
+        if (i >= size) {
+            return 0;
+        }
+        value |= static_cast<uint32_t>(in[i] & 0x7F) << (7 * i);
+        if ((in[i] & 0x80) == 0) {
+            return static_cast<int32_t>(i + 1);
+        }
+    }
+    return -1;
+}
+
+inline uint32_t zigzag(int32_t value) {
+    return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+}
+
+inline int32_t unzigzag(uint32_t value) {
+    return static_cast<int32_t>(value >> 1) ^ -static_cast<int32_t>(value & 1);
+}
+
+}  // namespace
+
+size_t VoyageLogWriteHeader(uint8_t* out, size_t size, uint32_t sequence, uint32_t startMs) {
+    if (size < VOYAGE_LOG_HEADER_SIZE) {
+        return 0;
+    }
+    memcpy(out, HEADER_MAGIC, sizeof(HEADER_MAGIC));
+    out[4] = VOYAGE_LOG_VERSION;
+    out[5] = BOATDATA_SNAPSHOT_VERSION;
+    out[6] = 0;
+    out[7] = 0;
+    writeU32(out + 8, sequence);
+    writeU32(out + 12, startMs);
+    return VOYAGE_LOG_HEADER_SIZE;
+}
+
+bool VoyageLogReadHeader(const uint8_t* in, size_t size, VoyageLogHeader& header) {
+    if (size < VOYAGE_LOG_HEADER_SIZE || memcmp(in, HEADER_MAGIC, sizeof(HEADER_MAGIC)) != 0 ||
+        in[4] != VOYAGE_LOG_VERSION) {
+        return false;
+    }
+    header.snapshotVersion = in[5];
+    header.sequence = readU32(in + 8);
+    header.startMs = readU32(in + 12);
+    return true;
+}
+
+size_t VoyageLogWriteTrailer(uint8_t* out, size_t size, const VoyageLogIndexEntry* entries, uint32_t count) {
+    size_t total = VOYAGE_LOG_TRAILER_SIZE(static_cast<size_t>(count));
+    if (size < total || (count > 0 && entries == nullptr)) {
+        return 0;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        writeU32(out + i * VOYAGE_LOG_INDEX_ENTRY_SIZE, entries[i].offset);
+        writeU32(out + i * VOYAGE_LOG_INDEX_ENTRY_SIZE + 4, entries[i].timestampMs);
+    }
+    uint8_t* footer = out + total - VOYAGE_LOG_FOOTER_SIZE;
+    writeU32(footer, count);
+    memcpy(footer + 4, FOOTER_MAGIC, sizeof(FOOTER_MAGIC));
+    return total;
+}
+
+bool VoyageLogReadFooter(const uint8_t* in, size_t size, uint32_t& count) {
+    if (size < VOYAGE_LOG_FOOTER_SIZE) {
+        return false;
+    }
+    const uint8_t* footer = in + size - VOYAGE_LOG_FOOTER_SIZE;
+    if (memcmp(footer + 4, FOOTER_MAGIC, sizeof(FOOTER_MAGIC)) != 0) {
+        return false;
+    }
+    count = readU32(footer);
+    return true;
+}
+
+VoyageLogIndexEntry VoyageLogReadIndexEntry(const uint8_t* in) {
+    VoyageLogIndexEntry entry;
+    entry.offset = readU32(in);
+    entry.timestampMs = readU32(in + 4);
+    return entry;
+}
+
+VoyageLogEncoder::VoyageLogEncoder(uint16_t keyframeInterval)
+    : keyframeInterval_(keyframeInterval > 0 ? keyframeInterval : 1), sinceKey_(0), havePrevious_(false) {
+    memset(&previous_, 0, sizeof(previous_));
+}
+
+size_t VoyageLogEncoder::encode(const BoatDataSnapshot& snapshot, uint8_t* out, size_t size) {
+    if (nextIsKeyframe()) {
+        if (size < 1 + sizeof(BoatDataSnapshot)) {
+            return 0;
+        }
+        out[0] = static_cast<uint8_t>(VoyageLogRecordType::KEY);
+        memcpy(out + 1, &snapshot, sizeof(BoatDataSnapshot));
+        previous_ = snapshot;
+        havePrevious_ = true;
+        sinceKey_ = 1;
+        return 1 + sizeof(BoatDataSnapshot);
+    }
+
+    // Encoded into a local buffer first: a record that does not fit leaves the state as it was
+    uint8_t record[VOYAGE_LOG_MAX_RECORD];
+    size_t pos = 0;
+    record[pos++] = static_cast<uint8_t>(VoyageLogRecordType::DELTA);
+    pos += writeVarint(record + pos, snapshot.timestampMs - previous_.timestampMs);
+
+    uint8_t* blockMask = record + pos++;
+    *blockMask = 0;
+    for (uint8_t block = 0; block < BLOCK_COUNT; block++) {
+        uint8_t fieldMask = 0;
+        uint8_t deltas[8 * MAX_VARINT];
+        size_t deltaLength = 0;
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            uint8_t i = static_cast<uint8_t>(block * 8 + bit);
+            if (i >= VOYAGE_LOG_FIELD_COUNT) {
+                break;
+            }
+            int32_t delta = fieldDelta(readField(snapshot, FIELDS[i]), readField(previous_, FIELDS[i]),
+                                       FIELDS[i].size);
+            if (delta != 0) {
+                fieldMask = static_cast<uint8_t>(fieldMask | (1 << bit));
+                deltaLength += writeVarint(deltas + deltaLength, zigzag(delta));
+            }
+        }
+        if (fieldMask != 0) {
+            *blockMask = static_cast<uint8_t>(*blockMask | (1 << block));
+            record[pos++] = fieldMask;
+            memcpy(record + pos, deltas, deltaLength);
+            pos += deltaLength;
+        }
+    }
+
+    if (pos > size) {
+        return 0;
+    }
+    memcpy(out, record, pos);
+    previous_ = snapshot;
+    sinceKey_++;
+    return pos;
+}
+
+int32_t VoyageLogDecoder::decode(const uint8_t* in, size_t size, BoatDataSnapshot& snapshot) {
+    if (size == 0) {
+        return 0;
+    }
+
+    if (in[0] == static_cast<uint8_t>(VoyageLogRecordType::KEY)) {
+        if (size < 1 + sizeof(BoatDataSnapshot)) {
+            return 0;
+        }
+        memcpy(&current_, in + 1, sizeof(BoatDataSnapshot));
+        if (current_.version != BOATDATA_SNAPSHOT_VERSION) {
+            haveKey_ = false;
+            return -1;
+        }
+        haveKey_ = true;
+        snapshot = current_;
+        return static_cast<int32_t>(1 + sizeof(BoatDataSnapshot));
+    }
+    if (in[0] != static_cast<uint8_t>(VoyageLogRecordType::DELTA) || !haveKey_) {
+        return -1;
+    }
+
+    // Applied to a copy: an incomplete record leaves the state as it was
+    BoatDataSnapshot next = current_;
+    size_t pos = 1;
+    uint32_t value = 0;
+    int32_t n = readVarint(in + pos, size - pos, value);
+    if (n <= 0) {
+        return n;
+    }
+    pos += static_cast<size_t>(n);
+    next.timestampMs = current_.timestampMs + value;
+
+    if (pos >= size) {
+        return 0;
+    }
+    uint8_t blockMask = in[pos++];
+    if ((blockMask >> BLOCK_COUNT) != 0) {
+        return -1;
+    }
+    for (uint8_t block = 0; block < BLOCK_COUNT; block++) {
+        if ((blockMask & (1 << block)) == 0) {
+            continue;
+        }
+        if (pos >= size) {
+            return 0;
+        }
+        uint8_t fieldMask = in[pos++];
+        for (uint8_t bit = 0; bit < 8; bit++) {
+            if ((fieldMask & (1 << bit)) == 0) {
+                continue;
+            }
+            uint8_t i = static_cast<uint8_t>(block * 8 + bit);
+            if (i >= VOYAGE_LOG_FIELD_COUNT) {
+                return -1;
+            }
+            n = readVarint(in + pos, size - pos, value);
+            if (n <= 0) {
+                return n;
+            }
+            pos += static_cast<size_t>(n);
+            writeField(next, FIELDS[i], readField(current_, FIELDS[i]) + static_cast<uint32_t>(unzigzag(value)));
+        }
+    }
+
+    current_ = next;
+    snapshot = current_;
+    return static_cast<int32_t>(pos);
+}
@@ -0,0 +1,175 @@
+/**
+ * @file VoyageLogFormat.h
+ * @brief Delta-compressed segment format of the on-device voyage recorder
+ *
+ * A segment file holds consecutive BoatDataSnapshot records of one boot:
+ *
+ * | Part    | Size     | Content                                                |
+ * |---------|----------|--------------------------------------------------------|
+ * | header  | 16       | "P2VL", format version, snapshot version, 2 reserved,  |
+ * |         |          | sequence (4), millis() of the first record (4)         |
+ * | records |          | KEY or DELTA records, the first one a KEY              |
+ * | index   | 8 x n    | offset (4) + timestampMs (4) of every KEY record       |
+ * | footer  | 8        | n (4), "P2VX"                                          |
+ *
+ * Records:
+ * - KEY: tag 1 + the 122-byte snapshot as-is (a decoder can start here)
+ * - DELTA: tag 2, timestamp delta (LEB128 varint), a block mask byte (bit b =
+ *   fields 8b..8b+7 have changes), one field mask byte per set block, then
+ *   per changed field the difference to the previous record, wrapped to the
+ *   field width (a heading crossing 0 is a small step), zigzag + LEB128
+ *
+ * A 1 s record of a boat under way changes position, speeds, angles and the
+ * running averages: ~40-60 bytes instead of 122, a few bytes at anchor.
+ *
+ * The index and footer are written when the segment is closed. A segment
+ * cut short by a reset has neither; its records still decode from the start
+ * up to the last complete record.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * VoyageLogEncoder encoder;
+ * size_t n = encoder.encode(snapshot, buf, sizeof(buf));   // KEY, then DELTAs
+ *
+ * VoyageLogDecoder decoder;
+ * BoatDataSnapshot out;
+ * int32_t used = decoder.decode(buf, n, out);              // > 0: record decoded
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef VOYAGE_LOG_FORMAT_H
+#define VOYAGE_LOG_FORMAT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "BoatDataSnapshot.h"
+#include "../config.h"
+
+#define VOYAGE_LOG_HEADER_SIZE 16
+#define VOYAGE_LOG_FOOTER_SIZE 8
+#define VOYAGE_LOG_INDEX_ENTRY_SIZE 8
+#define VOYAGE_LOG_VERSION 1
+
+/// Delta-coded snapshot fields (all but version and timestampMs)
+#define VOYAGE_LOG_FIELD_COUNT 58
+
+/// Largest encoded record (a DELTA with every field changed by a 5-byte varint)
+#define VOYAGE_LOG_MAX_RECORD (1 + 5 + 1 + (VOYAGE_LOG_FIELD_COUNT + 7) / 8 + 5 * VOYAGE_LOG_FIELD_COUNT)
+
+/// Index and footer of a segment with @p entries keyframes
+#define VOYAGE_LOG_TRAILER_SIZE(entries) ((entries) * VOYAGE_LOG_INDEX_ENTRY_SIZE + VOYAGE_LOG_FOOTER_SIZE)
+
+/**
+ * @brief Record types (first byte)
+ */
+enum class VoyageLogRecordType : uint8_t {
+    KEY = 1,     ///< Full snapshot
+    DELTA = 2    ///< Changes to the previous record
+};
+
+/**
+ * @brief Decoded segment header
+ */
+struct VoyageLogHeader {
+    uint8_t snapshotVersion;   ///< BOATDATA_SNAPSHOT_VERSION of the records
+    uint32_t sequence;         ///< Segment number, counts up across boots (0 = none)
+    uint32_t startMs;          ///< millis() when the segment started
+};
+
+/**
+ * @brief Seek point: file offset and time of one KEY record
+ */
+struct VoyageLogIndexEntry {
+    uint32_t offset;
+    uint32_t timestampMs;
+};
+
+/**
+ * @brief Write a segment header
+ * @return VOYAGE_LOG_HEADER_SIZE, 0 if @p size is too small
+ */
+size_t VoyageLogWriteHeader(uint8_t* out, size_t size, uint32_t sequence, uint32_t startMs);
+
+/**
+ * @brief Decode a segment header
+ * @return false if @p in is short, not a segment or of another format version
+ */
+bool VoyageLogReadHeader(const uint8_t* in, size_t size, VoyageLogHeader& header);
+
+/**
+ * @brief Write the index and footer of a closed segment
+ * @return VOYAGE_LOG_TRAILER_SIZE(count), 0 if @p size is too small
+ */
+size_t VoyageLogWriteTrailer(uint8_t* out, size_t size, const VoyageLogIndexEntry* entries, uint32_t count);
+
+/**
+ * @brief Decode the footer in the last VOYAGE_LOG_FOOTER_SIZE bytes of a file
+ *
+ * @param[out] count Index entries before the footer
+ * @return false if the segment was not closed (no footer)
+ */
+bool VoyageLogReadFooter(const uint8_t* in, size_t size, uint32_t& count);
+
+/**
+ * @brief Decode one VOYAGE_LOG_INDEX_ENTRY_SIZE index entry
+ */
+VoyageLogIndexEntry VoyageLogReadIndexEntry(const uint8_t* in);
+
+/**
+ * @class VoyageLogEncoder
+ * @brief Encodes consecutive snapshots as KEY and DELTA records
+ */
+class VoyageLogEncoder {
+public:
+    /// @param keyframeInterval A KEY record every this many records (at least 1)
+    explicit VoyageLogEncoder(uint16_t keyframeInterval = VOYAGE_LOG_KEYFRAME_RECORDS);
+
+    /// The next record is a KEY (new segment, or a record was lost)
+    void reset() { sinceKey_ = 0; havePrevious_ = false; }
+
+    /// Whether the next encode() writes a KEY record
+    bool nextIsKeyframe() const { return !havePrevious_ || sinceKey_ >= keyframeInterval_; }
+
+    /**
+     * @brief Encode @p snapshot relative to the previous one
+     * @return Record length, 0 if it does not fit in @p size (state unchanged)
+     */
+    size_t encode(const BoatDataSnapshot& snapshot, uint8_t* out, size_t size);
+
+private:
+    BoatDataSnapshot previous_;
+    uint16_t keyframeInterval_;
+    uint16_t sinceKey_;
+    bool havePrevious_;
+};
+
+/**
+ * @class VoyageLogDecoder
+ * @brief Rebuilds snapshots from consecutive records
+ */
+class VoyageLogDecoder {
+public:
+    VoyageLogDecoder() : haveKey_(false) {}
+
+    /// Forget the current state (after seeking to a KEY record)
+    void reset() { haveKey_ = false; }
+
+    /**
+     * @brief Decode the record at the start of @p in
+     *
+     * @return Bytes consumed (> 0), 0 if the record is incomplete (read more),
+     *         -1 if the data is corrupt or a DELTA has no preceding KEY
+     */
+    int32_t decode(const uint8_t* in, size_t size, BoatDataSnapshot& snapshot);
+
+private:
+    BoatDataSnapshot current_;
+    bool haveKey_;
+};
+
+#endif // VOYAGE_LOG_FORMAT_H
@@ -5,11 +5,49 @@
 
 #include "WebSocketLogger.h"
 #include "LogEnums.h"
+#include "WsBufferPool.h"
+#include "WriteBehind.h"
+#include "AdmissionController.h"
+#include "WebTrafficStats.h"
+#include "WsLiveness.h"
+#include "UtcClock.h"
+#include "AtomicFile.h"
 #include <LittleFS.h>
 #include <ArduinoJson.h>
+#include <stdarg.h>
+#include <esp_system.h>
+#include <freertos/FreeRTOS.h>
+
+namespace {
+
+// Producers may run on both cores (e.g. the NMEA2000 receive task), so the
+// crash ring and rate limiter updates are kept in a short critical section
+portMUX_TYPE producerMux = portMUX_INITIALIZER_UNLOCKED;
+
+static_assert(static_cast<uint16_t>(LogEvent::COUNT) < LogRecord::CANCELLED,
+              "LogRecord::CANCELLED must not be a valid event ID");
+
+const char* resetReasonToString(esp_reset_reason_t reason) {
+    switch (reason) {
+        case ESP_RST_POWERON:   return "POWERON";
+        case ESP_RST_EXT:       return "EXTERNAL";
+        case ESP_RST_SW:        return "SOFTWARE";
+        case ESP_RST_PANIC:     return "PANIC";
+        case ESP_RST_INT_WDT:   return "INT_WDT";
+        case ESP_RST_TASK_WDT:  return "TASK_WDT";
+        case ESP_RST_WDT:       return "WDT";
+        case ESP_RST_DEEPSLEEP: return "DEEPSLEEP";
+        case ESP_RST_BROWNOUT:  return "BROWNOUT";
+        default:                return "UNKNOWN";
+    }
+}
+
+}  // namespace
 
 WebSocketLogger::WebSocketLogger()
-    : ws(nullptr), isInitialized(false), messageCount(0) {
+    : ws(nullptr), isInitialized(false), messageCount(0), filterEntry(-1), subscriptionCount(0),
+      batching(LOG_BATCH_ENABLED), reportedDrops(0), crashLog(CrashLogRing::rtcStorage()),
+      previousBootPending(false), previousBootSent(false), previousBootClient(0) {
 }
 
 bool WebSocketLogger::begin(AsyncWebServer* server, const char* path) {
@@ -24,41 +62,533 @@ bool WebSocketLogger::begin(AsyncWebServer* server, const char* path) {
     ws->enable(true);
 
     // Register event handler
-    ws->onEvent(onWebSocketEvent);
+    ws->onEvent([this](AsyncWebSocket* server, AsyncWebSocketClient* client,
+                       AwsEventType type, void* arg, uint8_t* data, size_t len) {
+        onWebSocketEvent(server, client, type, arg, data, len);
+    });
 
     // Add WebSocket handler to server
     server->addHandler(ws);
 
     // Load filter from LittleFS (if exists, otherwise use defaults)
     loadFilter();
+    filterEntry = GetWriteBehind().add("log_filter", [](void* context) {
+        return static_cast<WebSocketLogger*>(context)->saveFilter();
+    }, this);
 
     isInitialized = true;
     return true;
 }
 
-void WebSocketLogger::broadcastLog(LogLevel level, const char* component, const char* event, const String& data) {
-    if (!isInitialized || ws == nullptr) {
+bool WebSocketLogger::admit(LogLevel level, const char* component, const char* event) {
+    uint32_t now = millis();
+
+    portENTER_CRITICAL(&producerMux);
+    crashLog.record(static_cast<uint8_t>(level), component, event, now);
+    portEXIT_CRITICAL(&producerMux);
+
+    if (!anyClientWants(level, component, event)) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&producerMux);
+    bool allowed = rateLimiter.allow(static_cast<uint8_t>(level), component, event, now);
+    portEXIT_CRITICAL(&producerMux);
+
+    return allowed;  // false = repeating too fast, counted for the next summary
+}
+
+void WebSocketLogger::broadcastLog(LogLevel level, LogComponent componentId, LogEvent eventId, const char* data) {
+    // Names are flash-resident: resolving them is a table lookup, never a copy
+    const char* component = LogComponentName(componentId);
+    const char* event = LogEventName(eventId);
+
+    // Filter first - nothing below runs for messages nobody receives
+    if (!admit(level, component, event)) {
+        return;
+    }
+
+    if (data == nullptr) {
+        data = "";
+    }
+    size_t length = strlen(data);
+    if (length >= LogRecord::DATA_SIZE) {
+        // Too large for a queue slot - send now rather than truncating JSON
+        sendLog(millis(), level, component, event, data, false);
+        return;
+    }
+
+    uint32_t ticket;
+    LogRecord* record = reserveRecord(level, componentId, eventId, ticket);
+    if (record == nullptr) {
+        return;  // Queue full - counted as dropped
+    }
+    memcpy(record->data, data, length + 1);
+    queue.commit(ticket);
+}
+
+void WebSocketLogger::broadcastLogf(LogLevel level, LogComponent componentId, LogEvent eventId,
+                                    const char* format, ...) {
+    const char* component = LogComponentName(componentId);
+    const char* event = LogEventName(eventId);
+
+    // Filter first - nothing below runs for messages nobody receives
+    if (!admit(level, component, event)) {
         return;
     }
 
-    // Check if any clients are connected (early exit)
-    if (ws->count() == 0) {
+    uint32_t ticket;
+    LogRecord* record = reserveRecord(level, componentId, eventId, ticket);
+    if (record == nullptr) {
+        return;  // Queue full - counted as dropped
+    }
+
+    // Format straight into the queue slot
+    va_list args;
+    va_start(args, format);
+    int len = vsnprintf(record->data, sizeof(record->data), format, args);
+    va_end(args);
+
+    if (len >= 0 && static_cast<size_t>(len) < sizeof(record->data)) {
+        queue.commit(ticket);
         return;
     }
 
-    // Apply filter check (early exit if message doesn't match)
-    if (!filter.matches(level, String(component), String(event))) {
+    // Slot is already claimed: mark it as cancelled so drain() skips it
+    record->event = LogRecord::CANCELLED;
+    queue.commit(ticket);
+
+    if (len < 0) {
+        return;  // Encoding error - drop message
+    }
+
+    // Oversized payload - format again into a heap buffer and send now
+    char* large = static_cast<char*>(malloc(len + 1));
+    if (large == nullptr) {
         return;
     }
+    va_start(args, format);
+    vsnprintf(large, len + 1, format, args);
+    va_end(args);
+    sendLog(millis(), level, component, event, large, false);
+    free(large);
+}
+
+bool WebSocketLogger::wouldLog(LogLevel level, LogComponent componentId) const {
+    if (!LOG_LEVEL_COMPILED(level)) {
+        return false;  // Level compiled out - keep non-macro callers consistent
+    }
+    if (!isInitialized || ws == nullptr) {
+        return false;
+    }
+
+    size_t clients = ws->count();
+    if (clients == 0) {
+        return false;
+    }
+
+    const char* component = LogComponentName(componentId);
+
+    // Shared filter only matters while some client has no subscription
+    if (clients > subscriptionCount && filter.matchesComponent(level, component)) {
+        return true;
+    }
+    for (uint8_t i = 0; i < LOG_MAX_SUBSCRIPTIONS; i++) {
+        if (subscriptions[i].active && subscriptions[i].filter.matchesComponent(level, component)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool WebSocketLogger::anyClientWants(LogLevel level, const char* component, const char* event) const {
+    if (!LOG_LEVEL_COMPILED(level) || !isInitialized || ws == nullptr) {
+        return false;
+    }
 
-    // Build JSON message
-    String message = buildLogMessage(level, component, event, data);
+    size_t clients = ws->count();
+    if (clients == 0) {
+        return false;
+    }
+
+    if (clients > subscriptionCount && filter.matches(level, component, event)) {
+        return true;
+    }
+    for (uint8_t i = 0; i < LOG_MAX_SUBSCRIPTIONS; i++) {
+        if (subscriptions[i].active && subscriptions[i].filter.matches(level, component, event)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+const LogFilter& WebSocketLogger::filterForClient(uint32_t clientId) const {
+    for (uint8_t i = 0; i < LOG_MAX_SUBSCRIPTIONS; i++) {
+        if (subscriptions[i].active && subscriptions[i].clientId == clientId) {
+            return subscriptions[i].filter;
+        }
+    }
+    return filter;
+}
+
+LogRecord* WebSocketLogger::reserveRecord(LogLevel level, LogComponent component, LogEvent event,
+                                          uint32_t& ticket) {
+    LogRecord* record = queue.tryReserve(ticket);
+    if (record == nullptr) {
+        return nullptr;
+    }
+
+    record->timestamp = millis();
+    record->level = static_cast<uint8_t>(level);
+    record->component = static_cast<uint8_t>(component);
+    record->event = static_cast<uint16_t>(event);
+    record->data[0] = '\0';
+    return record;
+}
 
-    // Broadcast to all connected clients
-    ws->textAll(message);
+uint32_t WebSocketLogger::drain(uint32_t maxMessages) {
+    if (!isInitialized || ws == nullptr) {
+        return 0;
+    }
+
+    if (previousBootPending) {
+        previousBootPending = false;
+        sendPreviousBoot(previousBootClient);
+    }
+
+    // New binary subscribers get the full dictionary before any record
+    for (uint8_t i = 0; i < LOG_MAX_SUBSCRIPTIONS; i++) {
+        if (subscriptions[i].active && subscriptions[i].binary && subscriptions[i].needsDictionary) {
+            sendDictionary(subscriptions[i]);
+        }
+    }
+
+    uint32_t sent = 0;
+    const LogRecord* record;
+    while (sent < maxMessages && (record = queue.front()) != nullptr) {
+        if (record->event != LogRecord::CANCELLED) {
+            sendLog(record->timestamp, static_cast<LogLevel>(record->level),
+                    LogComponentName(static_cast<LogComponent>(record->component)),
+                    LogEventName(static_cast<LogEvent>(record->event)), record->data);
+            sent++;
+        }
+        queue.pop();
+    }
+
+    // Report overflow once per drain, after the backlog has made room
+    uint32_t dropped = queue.getDroppedCount();
+    if (dropped != reportedDrops && ws->count() > 0) {
+        char data[64];
+        snprintf(data, sizeof(data), "{\"dropped\":%lu,\"total\":%lu}",
+                 (unsigned long)(dropped - reportedDrops), (unsigned long)dropped);
+        sendLog(millis(), LogLevel::WARN, LogComponentName(LogComponent::LOGGER),
+                LogEventName(LogEvent::LOG_DROPPED), data);
+        reportedDrops = dropped;
+    }
+
+    // Report repeats suppressed by the rate limiter under their own component/event
+    rateLimiter.collectSummaries(millis(), [this](const LogRateLimiter::Summary& summary) {
+        char data[64];
+        snprintf(data, sizeof(data), "{\"suppressed\":%lu,\"window_ms\":%lu}",
+                 (unsigned long)summary.suppressed, (unsigned long)summary.windowMs);
+        sendLog(millis(), static_cast<LogLevel>(summary.level), summary.component, summary.event, data);
+    });
+
+    flushBatches(false);
+    return sent;
+}
+
+void WebSocketLogger::flush() {
+    drain(LogRingBuffer::CAPACITY);
+    flushBatches(true);
+}
+
+void WebSocketLogger::setBatching(bool enabled) {
+    if (!enabled) {
+        flushBatches(true);
+    }
+    batching = enabled;
+}
+
+void WebSocketLogger::sendLog(uint32_t timestamp, LogLevel level, const char* component,
+                              const char* event, const char* data, bool allowBatch) {
+    // Work out recipients first: each encoding is built at most once
+    bool toShared = ws->count() > subscriptionCount && filter.matches(level, component, event);
+    uint8_t textSubs = 0;
+    uint8_t binarySubs = 0;
+    for (uint8_t i = 0; i < LOG_MAX_SUBSCRIPTIONS; i++) {
+        ClientSubscription& sub = subscriptions[i];
+        if (!sub.active || !sub.filter.matches(level, component, event)) {
+            continue;
+        }
+        if (!sub.binary) {
+            textSubs |= 1u << i;
+        } else if (!sub.needsDictionary) {  // Wait until drain() has sent the dictionary
+            binarySubs |= 1u << i;
+        }
+    }
+
+    if (binarySubs != 0) {
+        sendBinaryLog(binarySubs, timestamp, level, component, event, data, allowBatch);
+    }
+    if (toShared || textSubs != 0) {
+        sendTextLog(toShared, textSubs, timestamp, level, component, event, data, allowBatch);
+    }
     messageCount++;
 }
 
+void WebSocketLogger::sendTextLog(bool toShared, uint8_t subMask, uint32_t timestamp, LogLevel level,
+                                  const char* component, const char* event, const char* data,
+                                  bool allowBatch) {
+    char line[LOG_LINE_BUFFER_SIZE];
+    JsonWriter message(line, sizeof(line));
+    buildLogMessage(message, timestamp, level, component, event, data);
+    if (!message.overflowed()) {
+        deliver(toShared, subMask, message.c_str(), message.length(), allowBatch);
+        return;
+    }
+
+    // Oversized payload (configuration/status dumps) - rare heap fallback
+    size_t size = strlen(data) + LOG_LINE_BUFFER_SIZE;
+    char* large = static_cast<char*>(malloc(size));
+    if (large == nullptr) {
+        return;
+    }
+    JsonWriter largeMessage(large, size);
+    buildLogMessage(largeMessage, timestamp, level, component, event, data);
+    if (!largeMessage.overflowed()) {
+        deliver(toShared, subMask, largeMessage.c_str(), largeMessage.length(), allowBatch);
+    }
+    free(large);
+}
+
+void WebSocketLogger::sendBinaryLog(uint8_t subMask, uint32_t timestamp, LogLevel level,
+                                    const char* component, const char* event, const char* data,
+                                    bool allowBatch) {
+    // Interning (and announcing new IDs) only happens in the drain context
+    uint8_t componentId = allowBatch ? internName(component) : LogNameTable::NONE;
+    uint8_t eventId = allowBatch ? internName(event) : LogNameTable::NONE;
+
+    size_t dataLen = (data != nullptr) ? strlen(data) : 0;
+    size_t size = dataLen + LOG_LINE_BUFFER_SIZE;
+    uint8_t line[LOG_LINE_BUFFER_SIZE];
+    uint8_t* buffer = line;
+    if (size > sizeof(line)) {
+        buffer = static_cast<uint8_t*>(malloc(size));  // Oversized payload - rare
+        if (buffer == nullptr) {
+            return;
+        }
+    } else {
+        size = sizeof(line);
+    }
+
+    MsgPackWriter record(buffer, size);
+    record.array(6)
+        .integer(static_cast<uint8_t>(LogMsgPackType::RECORD))
+        .integer(timestamp)
+        .integer(static_cast<uint8_t>(level));
+    if (componentId != LogNameTable::NONE) {
+        record.integer(componentId);
+    } else {
+        record.str(component);
+    }
+    if (eventId != LogNameTable::NONE) {
+        record.integer(eventId);
+    } else {
+        record.str(event);
+    }
+    if (dataLen > 0) {
+        record.str(data, dataLen);
+    } else {
+        record.nil();
+    }
+
+    if (!record.overflowed()) {
+        deliver(false, subMask, reinterpret_cast<const char*>(record.data()), record.length(), allowBatch);
+    }
+    if (buffer != line) {
+        free(buffer);
+    }
+}
+
+uint8_t WebSocketLogger::internName(const char* name) {
+    bool added = false;
+    uint8_t id = names.intern(name, added);
+    if (!added) {
+        return id;
+    }
+
+    // Announce the new ID to binary clients that already hold the dictionary,
+    // through their batch so it stays ahead of the records that use it
+    uint8_t entry[LogNameTable::NAME_SIZE + 8];
+    MsgPackWriter out(entry, sizeof(entry));
+    out.array(3).integer(static_cast<uint8_t>(LogMsgPackType::DICTIONARY)).integer(id).str(name);
+
+    uint8_t subMask = 0;
+    for (uint8_t i = 0; i < LOG_MAX_SUBSCRIPTIONS; i++) {
+        if (subscriptions[i].active && subscriptions[i].binary && !subscriptions[i].needsDictionary) {
+            subMask |= 1u << i;
+        }
+    }
+    if (subMask != 0) {
+        deliver(false, subMask, reinterpret_cast<const char*>(out.data()), out.length(), true);
+    }
+    return id;
+}
+
+void WebSocketLogger::sendDictionary(ClientSubscription& sub) {
+    uint8_t frame[LOG_BATCH_MAX_BYTES];
+    MsgPackWriter out(frame, sizeof(frame));
+
+    for (uint8_t id = 0; id < names.count(); id++) {
+        size_t mark = out.length();
+        out.array(3).integer(static_cast<uint8_t>(LogMsgPackType::DICTIONARY)).integer(id).str(names.name(id));
+        if (out.overflowed()) {
+            // Frame full - send what fits and start the next one with this entry
+            ws->binary(sub.clientId, frame, mark);
+            GetWebTrafficStats().wsSent(AdmissionEndpoint::LOGS, mark);
+            out.reset();
+            out.array(3).integer(static_cast<uint8_t>(LogMsgPackType::DICTIONARY)).integer(id).str(names.name(id));
+        }
+    }
+    if (out.length() > 0) {
+        ws->binary(sub.clientId, frame, out.length());
+        GetWebTrafficStats().wsSent(AdmissionEndpoint::LOGS, out.length());
+    }
+    sub.needsDictionary = false;
+}
+
+void WebSocketLogger::deliver(bool toShared, uint8_t subMask, const char* bytes, size_t len, bool allowBatch) {
+    bool batch = batching && allowBatch;
+
+    // Clients on the shared filter
+    if (toShared) {
+        if (batch) {
+            appendToBatch(sharedBatch, nullptr, bytes, len);
+        } else {
+            sendFrame(nullptr, bytes, len);
+        }
+    }
+
+    // Clients with their own filter
+    for (uint8_t i = 0; i < LOG_MAX_SUBSCRIPTIONS; i++) {
+        ClientSubscription& sub = subscriptions[i];
+        if ((subMask & (1u << i)) != 0) {
+            if (batch) {
+                appendToBatch(sub.batch, &sub, bytes, len);
+            } else {
+                sendFrame(&sub, bytes, len);
+            }
+        }
+    }
+}
+
+void WebSocketLogger::sendFrame(const ClientSubscription* owner, const char* text, size_t len) {
+    WsBufferPool& pool = GetWsBufferPool();
+    if (!pool.isReady() || len > WsBufferPool::MAX_BYTES) {
+        sendFrameCopy(owner, text, len);
+        return;
+    }
+    WsBufferPool::Buffer frame = pool.acquire(len);
+    if (!frame) {
+        return;  // Every fitting buffer still queued - dropped, counted by the pool
+    }
+    memcpy(frame->data(), text, len);
+
+    if (owner != nullptr) {
+        AsyncWebSocketClient* client = ws->client(owner->clientId);
+        if (client != nullptr && owner->binary) {
+            client->binary(frame);
+        } else if (client != nullptr) {
+            client->text(frame);
+        }
+        GetWebTrafficStats().wsSent(AdmissionEndpoint::LOGS, len, client != nullptr ? 1 : 0);
+        return;
+    }
+
+    if (subscriptionCount == 0) {
+        ws->textAll(frame);
+        GetWebTrafficStats().wsSent(AdmissionEndpoint::LOGS, len, ws->count());
+        return;
+    }
+
+    uint32_t sent = 0;
+    for (AsyncWebSocketClient& client : ws->getClients()) {
+        if (client.status() == WS_CONNECTED && &filterForClient(client.id()) == &filter) {
+            client.text(frame);
+            sent++;
+        }
+    }
+    GetWebTrafficStats().wsSent(AdmissionEndpoint::LOGS, len, sent);
+}
+
+void WebSocketLogger::sendFrameCopy(const ClientSubscription* owner, const char* text, size_t len) {
+    if (owner != nullptr) {
+        if (owner->binary) {
+            ws->binary(owner->clientId, reinterpret_cast<const uint8_t*>(text), len);
+        } else {
+            ws->text(owner->clientId, text, len);
+        }
+        GetWebTrafficStats().wsSent(AdmissionEndpoint::LOGS, len);
+        return;
+    }
+
+    if (subscriptionCount == 0) {
+        ws->textAll(text, len);
+        GetWebTrafficStats().wsSent(AdmissionEndpoint::LOGS, len, ws->count());
+        return;
+    }
+
+    uint32_t sent = 0;
+    for (AsyncWebSocketClient& client : ws->getClients()) {
+        if (client.status() == WS_CONNECTED && &filterForClient(client.id()) == &filter) {
+            client.text(text, len);
+            sent++;
+        }
+    }
+    GetWebTrafficStats().wsSent(AdmissionEndpoint::LOGS, len, sent);
+}
+
+void WebSocketLogger::appendToBatch(LogBatch& batch, const ClientSubscription* owner,
+                                    const char* text, size_t len) {
+    if (batch.length + len > sizeof(batch.buffer)) {
+        sendFrame(owner, batch.buffer, batch.length);
+        batch.length = 0;
+    }
+
+    if (len > sizeof(batch.buffer)) {
+        sendFrame(owner, text, len);  // Larger than a whole batch - own frame
+        return;
+    }
+
+    if (batch.length == 0) {
+        batch.startedAt = millis();
+    }
+    memcpy(batch.buffer + batch.length, text, len);
+    batch.length += len;
+}
+
+void WebSocketLogger::flushBatches(bool force) {
+    if (ws == nullptr) {
+        return;
+    }
+
+    uint32_t now = millis();
+    if (sharedBatch.length > 0 && (force || now - sharedBatch.startedAt >= LOG_BATCH_FLUSH_MS)) {
+        sendFrame(nullptr, sharedBatch.buffer, sharedBatch.length);
+        sharedBatch.length = 0;
+    }
+
+    for (uint8_t i = 0; i < LOG_MAX_SUBSCRIPTIONS; i++) {
+        ClientSubscription& sub = subscriptions[i];
+        if (sub.active && sub.batch.length > 0 &&
+            (force || now - sub.batch.startedAt >= LOG_BATCH_FLUSH_MS)) {
+            sendFrame(&sub, sub.batch.buffer, sub.batch.length);
+            sub.batch.length = 0;
+        }
+    }
+}
+
 uint32_t WebSocketLogger::getClientCount() const {
     if (ws == nullptr) {
         return 0;
@@ -70,66 +600,139 @@ bool WebSocketLogger::hasClients() const {
     return getClientCount() > 0;
 }
 
-String WebSocketLogger::buildLogMessage(LogLevel level, const char* component, const char* event, const String& data) const {
-    String message = "{";
-
-    // Timestamp
-    message += "\"timestamp\":";
-    message += String(millis());
-    message += ",";
-
-    // Level
-    message += "\"level\":\"";
-    message += ::logLevelToString(level);
-    message += "\",";
-    
-    // Component
-    message += "\"component\":\"";
-    message += component;
-    message += "\",";
-    
-    // Event
-    message += "\"event\":\"";
-    message += event;
-    message += "\"";
+void WebSocketLogger::buildLogMessage(JsonWriter& out, uint32_t timestamp, LogLevel level,
+                                      const char* component, const char* event, const char* data,
+                                      bool thisBoot) const {
+    out.beginObject().add("timestamp", static_cast<unsigned long>(timestamp));
+    uint64_t utc = thisBoot ? GetUtcClock().toUtc(timestamp) : 0;
+    if (utc != 0) {
+        out.add("utc", static_cast<double>(utc), 0);  // ms since 1970, exact in a double
+    }
+    out.add("level", ::logLevelToString(level))
+        .add("component", component)
+        .add("event", event);
 
     // Data (if provided)
-    if (data.length() > 0) {
-        message += ",\"data\":";
-        message += data;
+    if (data != nullptr && data[0] != '\0') {
+        out.addRaw("data", data);
     }
 
-    message += "}\n";
+    out.endObject().appendRaw("\n");
+}
+
+String WebSocketLogger::getPreviousBootLog() const {
+    uint16_t count = crashLog.getPreviousCount();
+
+    StaticJsonWriter<64> header;
+    header.beginObject()
+        .add("reset_reason", resetReasonToString(esp_reset_reason()))
+        .add("records", static_cast<unsigned int>(count))
+        .endObject();
+    StaticJsonWriter<160> line;
+    buildLogMessage(line, millis(), LogLevel::INFO, LogComponentName(LogComponent::LOGGER),
+                    LogEventName(LogEvent::PREVIOUS_BOOT_LOG), header.c_str());
+
+    String log;
+    log.reserve((count + 1) * line.length());
+    log += line.c_str();
+
+    for (uint16_t i = 0; i < count; i++) {
+        const CrashLogEntry& entry = crashLog.getPrevious(i);
+        line.reset();
+        buildLogMessage(line, entry.timestamp, static_cast<LogLevel>(entry.level), entry.component,
+                        entry.event, "{\"previous_boot\":true}", false);
+        log += line.c_str();
+    }
+    return log;
+}
 
-    return message;
+void WebSocketLogger::sendPreviousBoot(uint32_t clientId) {
+    String log = getPreviousBootLog();
+    const char* text = log.c_str();
+    size_t remaining = log.length();
+
+    // Split on line boundaries so clients can keep parsing frame by frame
+    while (remaining > 0) {
+        size_t len = remaining;
+        if (len > LOG_BATCH_MAX_BYTES) {
+            len = LOG_BATCH_MAX_BYTES;
+            while (len > 0 && text[len - 1] != '\n') {
+                len--;
+            }
+            if (len == 0) {
+                len = LOG_BATCH_MAX_BYTES;  // Single line longer than a frame
+            }
+        }
+        ws->text(clientId, text, len);
+        GetWebTrafficStats().wsSent(AdmissionEndpoint::LOGS, len);
+        text += len;
+        remaining -= len;
+    }
 }
 
 void WebSocketLogger::onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client,
                                         AwsEventType type, void* arg, uint8_t* data, size_t len) {
     switch (type) {
         case WS_EVT_CONNECT:
+            // Upgrades beyond LOGS_MAX_CLIENTS are refused by admission; this catches simultaneous ones
+            if (!GetAdmissionController().opened(AdmissionEndpoint::LOGS)) {
+                client->close(1011, "Server overload - max clients");
+                break;
+            }
+
             // Client connected
             Serial.printf("WebSocket client #%u connected from %s\n",
                          client->id(), client->remoteIP().toString().c_str());
 
             // Send welcome message
             {
-                String welcome = "{\"status\":\"connected\",\"timestamp\":\"" + String(millis()) + "\"}";
+                char welcome[64];
+                snprintf(welcome, sizeof(welcome), "{\"status\":\"connected\",\"timestamp\":\"%lu\"}",
+                         (unsigned long)millis());
                 client->text(welcome);
             }
+
+            // First client after a reset gets the previous boot's records (sent by drain())
+            if (!previousBootSent && crashLog.getPreviousCount() > 0) {
+                previousBootSent = true;
+                previousBootClient = client->id();
+                previousBootPending = true;
+            }
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().add(AdmissionEndpoint::LOGS, client->id(), millis());
+#endif
             break;
 
         case WS_EVT_DISCONNECT:
+            GetAdmissionController().closed(AdmissionEndpoint::LOGS);
+
             // Client disconnected
             Serial.printf("WebSocket client #%u disconnected\n", client->id());
+            removeSubscription(client->id());
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().remove(AdmissionEndpoint::LOGS, client->id());
+#endif
             break;
 
         case WS_EVT_DATA:
-            // Data received from client (we don't expect any, but handle it)
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().seen(AdmissionEndpoint::LOGS, client->id(), millis());
+#endif
+            // Subscription commands: single-frame text messages only
+            {
+                AwsFrameInfo* info = static_cast<AwsFrameInfo*>(arg);
+                if (info != nullptr && info->final && info->index == 0 &&
+                    info->len == len && info->opcode == WS_TEXT) {
+                    handleClientCommand(client, data, len);
+                }
+            }
             break;
 
         case WS_EVT_PONG:
-            // Pong received (keep-alive)
+            // Pong received: the client is alive (pings sent by the main loop, see WsLiveness)
+#if WS_LIVENESS_ENABLED
+            GetWsLiveness().seen(AdmissionEndpoint::LOGS, client->id(), millis());
+#endif
             break;
 
         case WS_EVT_ERROR:
@@ -139,6 +742,86 @@ void WebSocketLogger::onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketCli
     }
 }
 
+void WebSocketLogger::handleClientCommand(AsyncWebSocketClient* client, const uint8_t* data, size_t len) {
+    StaticJsonDocument<384> doc;
+    DeserializationError error = deserializeJson(doc, data, len);
+    if (error || !doc.is<JsonObject>()) {
+        client->text("{\"status\":\"error\",\"reason\":\"invalid JSON command\"}");
+        return;
+    }
+
+    if (doc["unsubscribe"] | false) {
+        removeSubscription(client->id());
+        client->text("{\"status\":\"unsubscribed\"}");
+        return;
+    }
+
+    // Reuse the client's slot, or claim a free one
+    ClientSubscription* slot = nullptr;
+    for (uint8_t i = 0; i < LOG_MAX_SUBSCRIPTIONS; i++) {
+        if (subscriptions[i].active && subscriptions[i].clientId == client->id()) {
+            slot = &subscriptions[i];
+            break;
+        }
+        if (slot == nullptr && !subscriptions[i].active) {
+            slot = &subscriptions[i];
+        }
+    }
+    if (slot == nullptr) {
+        client->text("{\"status\":\"error\",\"reason\":\"too many subscriptions\"}");
+        return;
+    }
+
+    // Build the new filter aside; missing fields fall back to defaults
+    const char* encoding = doc["encoding"] | "json";
+    bool binary = strcmp(encoding, "msgpack") == 0;
+    if (!binary && strcmp(encoding, "json") != 0) {
+        client->text("{\"status\":\"error\",\"reason\":\"unknown encoding\"}");
+        return;
+    }
+
+    bool wasActive = slot->active;
+    slot->active = false;
+    if (!wasActive || slot->binary != binary) {
+        slot->batch.length = 0;  // Discard lines left over from a previous owner/encoding
+    }
+    if (binary && (!wasActive || !slot->binary)) {
+        slot->needsDictionary = true;  // Sent by drain() before the first record
+    }
+    slot->binary = binary;
+    slot->filter.minLevel = parseLogLevel(doc["level"] | "INFO");
+    slot->filter.setComponents(doc["components"] | "");
+    slot->filter.setEventPrefixes(doc["events"] | "");
+    slot->clientId = client->id();
+    slot->active = true;
+    if (!wasActive) {
+        subscriptionCount++;
+    }
+
+    StaticJsonWriter<LogFilter::TEXT_SIZE * 2 + 96> reply;
+    reply.beginObject()
+        .add("status", "subscribed")
+        .beginObject("filter")
+            .add("level", logLevelToString(slot->filter.minLevel))
+            .add("components", slot->filter.getComponents())
+            .add("events", slot->filter.getEventPrefixes())
+        .endObject()
+        .add("encoding", binary ? "msgpack" : "json")
+        .endObject();
+    client->text(reply.c_str(), reply.length());
+}
+
+bool WebSocketLogger::removeSubscription(uint32_t clientId) {
+    for (uint8_t i = 0; i < LOG_MAX_SUBSCRIPTIONS; i++) {
+        if (subscriptions[i].active && subscriptions[i].clientId == clientId) {
+            subscriptions[i].active = false;
+            subscriptionCount--;
+            return true;
+        }
+    }
+    return false;
+}
+
 void WebSocketLogger::logConnectionEvent(ConnectionEvent event, const String& ssid, int attempt, int timeout) {
     // Send to WebSocket if has clients
     if (hasClients()) {
@@ -158,49 +841,44 @@ void WebSocketLogger::logConnectionEvent(ConnectionEvent event, const String& ss
         }
 
         // Build data JSON
-        String data = "{\"ssid\":\"" + ssid + "\"";
+        StaticJsonWriter<LogRecord::DATA_SIZE> data;
+        data.beginObject().add("ssid", ssid);
 
         if (attempt > 0) {
-            data += ",\"attempt\":" + String(attempt);
+            data.add("attempt", attempt);
         }
 
         if (timeout > 0) {
-            data += ",\"timeout_seconds\":" + String(timeout);
+            data.add("timeout_seconds", timeout);
         }
 
-        data += "}";
+        data.endObject();
 
-        // Get event string
-        const char* eventStr = ::connectionEventToString(event);
-
-        broadcastLog(level, "WiFiManager", eventStr, data);
+        broadcastLog(level, LogComponent::WIFI_MANAGER, connectionEventToLogEvent(event), data.c_str());
     }
 }
 
-void WebSocketLogger::logConfigEvent(ConnectionEvent event, bool success, int networkCount, const String& error) {
+void WebSocketLogger::logConfigEvent(ConnectionEvent event, bool success, int networkCount, const char* error) {
     // Send to WebSocket if has clients
     if (hasClients()) {
         // Build data JSON
-        String data = "{\"success\":";
-        data += String(success ? "true" : "false");
+        StaticJsonWriter<LogRecord::DATA_SIZE> data;
+        data.beginObject().add("success", success);
 
         if (networkCount > 0) {
-            data += ",\"networks_count\":" + String(networkCount);
+            data.add("networks_count", networkCount);
         }
 
-        if (error.length() > 0) {
-            data += ",\"error\":\"" + error + "\"";
+        if (error != nullptr && error[0] != '\0') {
+            data.add("error", error);
         }
 
-        data += "}";
+        data.endObject();
 
         // Determine log level
         LogLevel level = success ? LogLevel::INFO : LogLevel::ERROR;
 
-        // Get event string
-        const char* eventStr = ::connectionEventToString(event);
-
-        broadcastLog(level, "WiFiManager", eventStr, data);
+        broadcastLog(level, LogComponent::WIFI_MANAGER, connectionEventToLogEvent(event), data.c_str());
     }
 }
 
@@ -208,18 +886,16 @@ void WebSocketLogger::logRebootEvent(int delaySeconds, const String& reason) {
     // Send to WebSocket if has clients
     if (hasClients()) {
         // Build data JSON
-        String data = "{\"delay_seconds\":" + String(delaySeconds);
+        StaticJsonWriter<LogRecord::DATA_SIZE> data;
+        data.beginObject().add("delay_seconds", delaySeconds);
 
         if (reason.length() > 0) {
-            data += ",\"reason\":\"" + reason + "\"";
+            data.add("reason", reason);
         }
 
-        data += "}";
+        data.endObject();
 
-        // Map to reboot scheduled event
-        const char* eventStr = ::connectionEventToString(ConnectionEvent::REBOOT_SCHEDULED);
-
-        broadcastLog(LogLevel::WARN, "WiFiManager", eventStr, data);
+        broadcastLog(LogLevel::WARN, LogComponent::WIFI_MANAGER, LogEvent::REBOOT_SCHEDULED, data.c_str());
     }
 }
 
@@ -233,96 +909,48 @@ bool WebSocketLogger::hasWebSocketClients() const {
 
 void WebSocketLogger::setFilterLevel(LogLevel level) {
     filter.minLevel = level;
-    saveFilter();  // Automatically persist to flash
+    persistFilter();
 }
 
 void WebSocketLogger::setFilterComponents(const String& components) {
-    strncpy(filter.components, components.c_str(), sizeof(filter.components) - 1);
-    filter.components[sizeof(filter.components) - 1] = '\0';  // Ensure null termination
-    saveFilter();  // Automatically persist to flash
+    filter.setComponents(components.c_str());  // Recompiles the component set
+    persistFilter();
 }
 
 void WebSocketLogger::setFilterEvents(const String& events) {
-    strncpy(filter.eventPrefixes, events.c_str(), sizeof(filter.eventPrefixes) - 1);
-    filter.eventPrefixes[sizeof(filter.eventPrefixes) - 1] = '\0';  // Ensure null termination
-    saveFilter();  // Automatically persist to flash
+    filter.setEventPrefixes(events.c_str());  // Recompiles the prefix trie
+    persistFilter();
 }
 
 void WebSocketLogger::clearFilter() {
-    filter.minLevel = LogLevel::INFO;
-    filter.components[0] = '\0';
-    filter.eventPrefixes[0] = '\0';
-    saveFilter();  // Automatically persist to flash
+    filter.clear();
+    persistFilter();
 }
 
-String WebSocketLogger::getFilterConfig() const {
-    String config = "{";
-
-    config += "\"level\":\"";
-    config += logLevelToString(filter.minLevel);
-    config += "\",";
-
-    config += "\"components\":\"";
-    config += filter.components;
-    config += "\",";
-
-    config += "\"events\":\"";
-    config += filter.eventPrefixes;
-    config += "\"";
-
-    config += "}";
-
-    return config;
-}
-
-bool WebSocketLogger::LogFilter::matches(LogLevel level, const String& component, const String& event) const {
-    // Level check - message level must be >= minimum level
-    if (level < minLevel) {
-        return false;
-    }
-
-    // Component check (empty = match all)
-    if (components[0] != '\0') {
-        String componentsStr(components);
-        // Check if component is in comma-separated list
-        if (componentsStr.indexOf(component) < 0) {
-            return false;
-        }
+void WebSocketLogger::persistFilter() {
+    if (filterEntry < 0) {
+        saveFilter();  // No write-behind entry (before begin() or table full)
+        return;
     }
+    GetWriteBehind().markDirty(filterEntry, millis());  // One write per burst of changes
+}
 
-    // Event prefix check (empty = match all)
-    if (eventPrefixes[0] != '\0') {
-        String eventsStr(eventPrefixes);
-        bool found = false;
-
-        // Check if event starts with any prefix in comma-separated list
-        int startPos = 0;
-        while (startPos < eventsStr.length()) {
-            int commaPos = eventsStr.indexOf(',', startPos);
-            String prefix;
-
-            if (commaPos >= 0) {
-                prefix = eventsStr.substring(startPos, commaPos);
-                startPos = commaPos + 1;
-            } else {
-                prefix = eventsStr.substring(startPos);
-                startPos = eventsStr.length();
-            }
-
-            prefix.trim();  // Remove whitespace
-
-            if (prefix.length() > 0 && event.startsWith(prefix)) {
-                found = true;
-                break;
-            }
-        }
+String WebSocketLogger::getFilterConfig() const {
+    StaticJsonWriter<LogFilter::TEXT_SIZE * 2 + 64> config;
+    writeFilterConfig(config);
+    return String(config.c_str());
+}
 
-        if (!found) {
-            return false;
-        }
+void WebSocketLogger::writeFilterConfig(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
     }
-
-    return true;
+    json.add("level", logLevelToString(filter.minLevel))
+        .add("components", filter.getComponents())
+        .add("events", filter.getEventPrefixes())
+        .endObject();
 }
 
 bool WebSocketLogger::saveFilter() {
@@ -330,20 +958,15 @@ bool WebSocketLogger::saveFilter() {
     StaticJsonDocument<256> doc;
 
     doc["level"] = logLevelToString(filter.minLevel);
-    doc["components"] = String(filter.components);
-    doc["events"] = String(filter.eventPrefixes);
+    doc["components"] = filter.getComponents();
+    doc["events"] = filter.getEventPrefixes();
 
-    // Open file for writing
-    File file = LittleFS.open(FILTER_FILE, "w");
-    if (!file) {
+    // Write next to the file, replace it only once complete
+    AtomicFileWriter out(FILTER_FILE);
+    if (!out.isOpen() || serializeJson(doc, out.file()) == 0) {
         return false;
     }
-
-    // Serialize JSON to file
-    size_t bytesWritten = serializeJson(doc, file);
-    file.close();
-
-    return (bytesWritten > 0);
+    return out.commit();
 }
 
 bool WebSocketLogger::loadFilter() {
@@ -375,11 +998,9 @@ bool WebSocketLogger::loadFilter() {
     const char* events = doc["events"] | "";
 
     // Apply loaded values
-    filter.minLevel = parseLogLevel(String(levelStr));
-    strncpy(filter.components, components, sizeof(filter.components) - 1);
-    filter.components[sizeof(filter.components) - 1] = '\0';
-    strncpy(filter.eventPrefixes, events, sizeof(filter.eventPrefixes) - 1);
-    filter.eventPrefixes[sizeof(filter.eventPrefixes) - 1] = '\0';
+    filter.minLevel = parseLogLevel(levelStr);
+    filter.setComponents(components);
+    filter.setEventPrefixes(events);
 
     return true;
 }
\ No newline at end of file
@@ -5,11 +5,48 @@
  * Provides WebSocket logging as the primary logging mechanism.
  * WebSocket uses TCP, providing reliable, ordered delivery of log messages.
  *
+ * Messages passing the filter are queued in a preallocated ring
+ * (LogRingBuffer) and sent by drain(), which main.cpp runs from its own
+ * reactor. Producers never wait on slow Wi-Fi clients; when the ring is full
+ * the message is dropped and counted (reported as Logger/LOG_DROPPED).
+ *
+ * Clients use the shared filter (HTTP /log-filter, persisted) unless they
+ * subscribe with their own by sending a text command on the socket:
+ *   {"level":"DEBUG","components":"NMEA2000","events":"PGN130306_"}
+ *   {"unsubscribe":true}
+ * Adding "encoding":"msgpack" switches that client to binary MessagePack
+ * frames with interned component/event IDs (see LogMsgPack.h); the name
+ * dictionary is sent before the first record.
+ * Each message is encoded once and sent only to clients whose filter matches.
+ *
+ * With batching enabled (LOG_BATCH_ENABLED), lines for the same recipients
+ * are coalesced into one newline-delimited frame, sent when the next line
+ * would exceed LOG_BATCH_MAX_BYTES or after LOG_BATCH_FLUSH_MS, whichever
+ * comes first. Clients must split frames on '\n'.
+ *
+ * Each (component, event) pair is rate limited by a token bucket
+ * (LogRateLimiter). Repeats beyond LOG_RATE_LIMIT_BURST / LOG_RATE_LIMIT_PER_SEC
+ * are counted instead of sent, and reported every LOG_RATE_SUMMARY_MS as one
+ * message with the same component/event and data {"suppressed":N,"window_ms":T}.
+ *
+ * Every message at LOG_CRASH_RING_MIN_LEVEL or above is also recorded (names
+ * only) in an RTC-memory ring that survives resets (CrashLogRing). After a
+ * reset the previous boot's records are sent once to the first /logs client,
+ * preceded by Logger/PREVIOUS_BOOT_LOG, and are available via GET /logs/previous.
+ *
  * Usage:
  * @code
  * WebSocketLogger logger;
  * logger.begin(webServer);
- * logger.broadcastLog(LogLevel::INFO, "Component", "EVENT", "{\"data\":1}");
+ * app.onRepeat(LOG_DRAIN_INTERVAL_MS, []() { logger.drain(); });
+ * logger.broadcastLog(LogLevel::INFO, LogComponent::MAIN, LogEvent::INIT_SUCCESS, "{\"data\":1}");
+ *
+ * // Hot paths: payload is only formatted if the message passes the filter
+ * logger.broadcastLogf(LogLevel::DEBUG, LogComponent::NMEA2000, LogEvent::PGN127251_UPDATE,
+ *                      "{\"rateOfTurn\":%.2f}", rateOfTurn);
+ *
+ * // Compiled out entirely (arguments included) below LOG_MIN_COMPILED_LEVEL
+ * LOG_DEBUGF(&logger, LogComponent::NMEA2000, LogEvent::PGN_IGNORED, "{\"pgn\":%lu}", pgn);
  * @endcode
  */
 
@@ -19,6 +56,28 @@
 #include <Arduino.h>
 #include <ESPAsyncWebServer.h>
 #include "LogEnums.h"
+#include "LogNames.h"
+#include "LogRingBuffer.h"
+#include "LogFilter.h"
+#include "LogRateLimiter.h"
+#include "CrashLogRing.h"
+#include "JsonWriter.h"
+#include "LogMsgPack.h"
+
+/**
+ * @brief Lowest LogLevel value compiled into the firmware
+ *
+ * 0 = DEBUG (default, everything), 1 = INFO, 2 = WARN, 3 = ERROR, 4 = FATAL.
+ * Set from platformio.ini, e.g. `-D LOG_MIN_COMPILED_LEVEL=1` for release
+ * builds. Calls made through the LOG_* macros below that threshold are
+ * removed by the compiler, including their payload construction.
+ */
+#ifndef LOG_MIN_COMPILED_LEVEL
+#define LOG_MIN_COMPILED_LEVEL 0
+#endif
+
+/// True if messages at @p level survive compile-time elimination
+#define LOG_LEVEL_COMPILED(level) (static_cast<int>(level) >= LOG_MIN_COMPILED_LEVEL)
 
 /**
  * @brief WebSocket logger class
@@ -29,30 +88,44 @@
 class WebSocketLogger {
 private:
     /**
-     * @brief Log filter configuration
-     *
-     * Single shared filter applied to all connected clients.
-     * Empty component/event strings match all messages.
+     * @brief Pending newline-delimited frame for one group of recipients
      */
-    struct LogFilter {
-        LogLevel minLevel = LogLevel::INFO;  ///< Minimum log level (default: INFO)
-        char components[128] = "";           ///< Comma-separated component filter (empty = all)
-        char eventPrefixes[128] = "";        ///< Comma-separated event prefix filter (empty = all)
+    struct LogBatch {
+        char buffer[LOG_BATCH_MAX_BYTES];
+        size_t length = 0;
+        uint32_t startedAt = 0;   ///< millis() of the first line in the batch
+    };
 
-        /**
-         * @brief Check if a log message matches this filter
-         * @param level Message log level
-         * @param component Message component
-         * @param event Message event name
-         * @return true if message should be logged
-         */
-        bool matches(LogLevel level, const String& component, const String& event) const;
+    /**
+     * @brief Per-client filter set via a WebSocket text command (not persisted)
+     */
+    struct ClientSubscription {
+        uint32_t clientId = 0;
+        bool active = false;
+        bool binary = false;            ///< MessagePack frames instead of JSON text
+        bool needsDictionary = false;   ///< Binary client has not received the name dictionary yet
+        LogFilter filter;
+        LogBatch batch;
     };
 
     AsyncWebSocket* ws;
     bool isInitialized;
     uint32_t messageCount;
-    LogFilter filter;  ///< Shared filter for all clients
+    LogFilter filter;  ///< Shared filter for clients without a subscription
+    int8_t filterEntry;  ///< GetWriteBehind() entry of /log-filter.json (-1 before begin())
+    ClientSubscription subscriptions[LOG_MAX_SUBSCRIPTIONS];
+    static_assert(LOG_MAX_SUBSCRIPTIONS <= 8, "Subscription masks are 8 bits wide");
+    uint8_t subscriptionCount;  ///< Active entries in subscriptions[]
+    LogBatch sharedBatch;       ///< Batch for clients on the shared filter
+    bool batching;              ///< Coalesce lines into multi-line frames
+    LogRingBuffer queue;        ///< Pending messages awaiting drain()
+    uint32_t reportedDrops;     ///< Drop count already reported via LOG_DROPPED
+    LogRateLimiter rateLimiter; ///< Per-(component,event) repeat suppression
+    LogNameTable names;         ///< Interned component/event IDs for binary clients
+    CrashLogRing crashLog;      ///< Reset-surviving record of recent messages
+    bool previousBootPending;   ///< First client connected, previous-boot dump not sent yet
+    bool previousBootSent;      ///< Previous-boot dump already claimed by a client
+    uint32_t previousBootClient;///< Client that receives the previous-boot dump
 
 public:
     /**
@@ -69,13 +142,105 @@ public:
     bool begin(AsyncWebServer* server, const char* path = "/logs");
 
     /**
-     * @brief Broadcast a log message to all connected clients
+     * @brief Queue a log message for all connected clients
+     *
+     * Payloads larger than LOG_RECORD_DATA_SIZE bypass the queue and are
+     * sent immediately (rare: configuration and status dumps only).
+     *
      * @param level Log level
-     * @param component Component name (e.g., "WiFiManager")
-     * @param event Event name (e.g., "CONNECTION_ATTEMPT")
-     * @param data JSON data string (optional)
+     * @param component Component ID (e.g., LogComponent::WIFI_MANAGER)
+     * @param event Event ID (e.g., LogEvent::CONNECTION_ATTEMPT)
+     * @param data JSON data (optional, e.g. built with JsonWriter)
      */
-    void broadcastLog(LogLevel level, const char* component, const char* event, const String& data = "");
+    void broadcastLog(LogLevel level, LogComponent component, LogEvent event, const char* data = "");
+
+    /**
+     * @brief String overload of broadcastLog() for existing call sites
+     */
+    void broadcastLog(LogLevel level, LogComponent component, LogEvent event, const String& data) {
+        broadcastLog(level, component, event, data.c_str());
+    }
+
+    /**
+     * @brief Broadcast a log message with deferred printf-style payload formatting
+     *
+     * The filter and client count are checked before the format string is
+     * evaluated, so a message nobody receives costs a few compares and no
+     * heap allocation. The payload is formatted directly into a queue slot
+     * (heap fallback and immediate send only for oversized payloads).
+     *
+     * @param level Log level
+     * @param component Component ID (e.g., LogComponent::NMEA2000)
+     * @param event Event ID (e.g., LogEvent::PGN127251_UPDATE)
+     * @param format printf-style format producing the JSON data payload
+     */
+    void broadcastLogf(LogLevel level, LogComponent component, LogEvent event, const char* format, ...)
+        __attribute__((format(printf, 5, 6)));
+
+    /**
+     * @brief Cheap pre-check whether a message could reach any client
+     *
+     * Use to guard expensive payload construction at call sites that cannot
+     * use broadcastLogf(). Checks initialization, client count, level and
+     * component against the shared filter and every client subscription;
+     * event prefixes are checked later by broadcastLog().
+     *
+     * @param level Log level
+     * @param component Component ID
+     * @return true if a message with this level/component would be sent
+     */
+    bool wouldLog(LogLevel level, LogComponent component) const;
+
+    /**
+     * @brief Encode and send queued messages
+     *
+     * Call periodically from a single context (main.cpp registers a
+     * LOG_DRAIN_INTERVAL_MS reactor). Also reports new queue overflows
+     * and due rate-limit suppression summaries.
+     *
+     * @param maxMessages Upper bound on messages sent in this call
+     * @return Number of queued messages sent
+     */
+    uint32_t drain(uint32_t maxMessages = LOG_DRAIN_BATCH);
+
+    /**
+     * @brief Send everything currently queued or batched (e.g. before a reboot)
+     */
+    void flush();
+
+    /**
+     * @brief Enable/disable coalescing of log lines into multi-line frames
+     * @param enabled true = batch (default LOG_BATCH_ENABLED), false = one frame per line
+     */
+    void setBatching(bool enabled);
+
+    /**
+     * @brief Check if batching mode is active
+     */
+    bool isBatching() const { return batching; }
+
+    /**
+     * @brief Messages dropped because the queue was full
+     * @return Drop count since startup
+     */
+    uint32_t getDroppedCount() const { return queue.getDroppedCount(); }
+
+    /**
+     * @brief Messages suppressed by the per-(component,event) rate limit
+     * @return Suppressed count since startup
+     */
+    uint32_t getSuppressedCount() const { return rateLimiter.getSuppressedTotal(); }
+
+    /**
+     * @brief Records from before the last reset, as newline-delimited log lines
+     *
+     * First line is Logger/PREVIOUS_BOOT_LOG with the reset reason and record
+     * count; each following line is a recovered record with data
+     * {"previous_boot":true}. Served by GET /logs/previous.
+     *
+     * @return NDJSON text (header line only if nothing was recovered)
+     */
+    String getPreviousBootLog() const;
 
     /**
      * @brief Log WiFi connection event
@@ -85,7 +250,7 @@ public:
     /**
      * @brief Log config file event
      */
-    void logConfigEvent(ConnectionEvent event, bool success, int networkCount = 0, const String& error = "");
+    void logConfigEvent(ConnectionEvent event, bool success, int networkCount = 0, const char* error = "");
 
     /**
      * @brief Log reboot event
@@ -98,12 +263,20 @@ public:
      */
     uint32_t getClientCount() const;
 
+    /**
+     * @brief Number of clients currently using their own filter
+     */
+    uint8_t getSubscriptionCount() const { return subscriptionCount; }
+
     /**
      * @brief Get number of WebSocket clients connected
      * @return Client count
      */
     uint32_t getWebSocketClients() const;
 
+    /// The /logs endpoint (nullptr before begin()); its send queues are sampled for GET /web/stats
+    AsyncWebSocket* getWebSocket() const { return ws; }
+
     /**
      * @brief Get total messages sent
      * @return Message count since startup
@@ -152,16 +325,153 @@ public:
      */
     String getFilterConfig() const;
 
+    /**
+     * @brief Write the current filter as a JSON object into @p json
+     *
+     * Same content as getFilterConfig(), without the String copy. With
+     * @p key the object is a member of the enclosing one.
+     */
+    void writeFilterConfig(JsonWriter& json, const char* key = nullptr) const;
+
 private:
     /**
-     * @brief Build JSON log message
+     * @brief Write one newline-terminated JSON log line
+     * @param out Destination (check out.overflowed() afterwards)
+     * @param timestamp millis() when the message was produced
      * @param level Log level
      * @param component Component name
      * @param event Event name
-     * @param data Data string
-     * @return JSON formatted log message
+     * @param data Pre-encoded JSON data (empty = no "data" member)
+     * @param thisBoot @p timestamp is of this boot: adds "utc" once GetUtcClock() is synced
      */
-    String buildLogMessage(LogLevel level, const char* component, const char* event, const String& data) const;
+    void buildLogMessage(JsonWriter& out, uint32_t timestamp, LogLevel level, const char* component,
+                         const char* event, const char* data, bool thisBoot = true) const;
+
+    /**
+     * @brief Producer-side admission: crash ring record, filter, rate limit
+     *
+     * Safe to call from several tasks; the shared crash ring and rate
+     * limiter state is updated inside a critical section.
+     *
+     * @return true if the message should be queued
+     */
+    bool admit(LogLevel level, const char* component, const char* event);
+
+    /**
+     * @brief Reserve a queue slot and store the component/event IDs in it
+     * @param ticket Output: reservation handle for queue.commit()
+     * @return Slot with data[] left for the caller, or nullptr if queue full
+     */
+    LogRecord* reserveRecord(LogLevel level, LogComponent component, LogEvent event, uint32_t& ticket);
+
+    /**
+     * @brief Build a message and deliver it to every client whose filter matches
+     *
+     * Call from the drain context only when @p allowBatch is true - batches
+     * are not shared across tasks.
+     *
+     * @param timestamp millis() when the message was produced
+     * @param level Log level
+     * @param component Component name
+     * @param event Event name
+     * @param data Null-terminated JSON data (may be empty)
+     * @param allowBatch false = send now even in batching mode (producer-side fallbacks)
+     */
+    void sendLog(uint32_t timestamp, LogLevel level, const char* component, const char* event,
+                 const char* data, bool allowBatch = true);
+
+    /**
+     * @brief Encode a message as a JSON line and deliver it
+     * @param toShared Send to clients on the shared filter
+     * @param subMask Bit i set = send to subscriptions[i]
+     */
+    void sendTextLog(bool toShared, uint8_t subMask, uint32_t timestamp, LogLevel level,
+                     const char* component, const char* event, const char* data, bool allowBatch);
+
+    /**
+     * @brief Encode a message as a MessagePack record and deliver it
+     *
+     * Names are interned only when @p allowBatch is true (drain context);
+     * otherwise they are sent as strings.
+     *
+     * @param subMask Bit i set = send to subscriptions[i] (binary subscribers only)
+     */
+    void sendBinaryLog(uint8_t subMask, uint32_t timestamp, LogLevel level,
+                       const char* component, const char* event, const char* data, bool allowBatch);
+
+    /**
+     * @brief Intern a name, announcing new IDs to binary subscribers
+     * @return ID, or LogNameTable::NONE if the table is full
+     */
+    uint8_t internName(const char* name);
+
+    /**
+     * @brief Send every interned name to a new binary subscriber
+     */
+    void sendDictionary(ClientSubscription& sub);
+
+    /**
+     * @brief Send encoded bytes to the shared group and/or selected subscriptions
+     */
+    void deliver(bool toShared, uint8_t subMask, const char* bytes, size_t len, bool allowBatch);
+
+    /**
+     * @brief Send one frame to a subscriber, or to all shared-filter clients (owner == nullptr)
+     *
+     * The frame is copied once into a WsBufferPool buffer that every
+     * recipient's queue shares; pool exhaustion drops it (counted by the pool).
+     */
+    void sendFrame(const ClientSubscription* owner, const char* text, size_t len);
+
+    /**
+     * @brief sendFrame() through the library's own copy (pool not begun, frame larger than a pool buffer)
+     */
+    void sendFrameCopy(const ClientSubscription* owner, const char* text, size_t len);
+
+    /**
+     * @brief Add a line to a batch, sending the batch first if the line won't fit
+     */
+    void appendToBatch(LogBatch& batch, const ClientSubscription* owner, const char* text, size_t len);
+
+    /**
+     * @brief Send batches that are older than LOG_BATCH_FLUSH_MS (or all, if forced)
+     */
+    void flushBatches(bool force);
+
+    /**
+     * @brief Filter-first check for broadcastLog()/broadcastLogf()
+     *
+     * Checks compile-time level, initialization and client count, then the
+     * shared filter (if any client uses it) and every client subscription.
+     *
+     * @return true if at least one connected client wants the message
+     */
+    bool anyClientWants(LogLevel level, const char* component, const char* event) const;
+
+    /**
+     * @brief Filter that applies to a client (its subscription or the shared one)
+     */
+    const LogFilter& filterForClient(uint32_t clientId) const;
+
+    /**
+     * @brief Send getPreviousBootLog() to one client in frames of at most LOG_BATCH_MAX_BYTES
+     * @param clientId Recipient
+     */
+    void sendPreviousBoot(uint32_t clientId);
+
+    /**
+     * @brief Handle a text command from a /logs client (subscribe/unsubscribe)
+     * @param client Sending client
+     * @param data Command text (not null-terminated)
+     * @param len Command length
+     */
+    void handleClientCommand(AsyncWebSocketClient* client, const uint8_t* data, size_t len);
+
+    /**
+     * @brief Drop a client's subscription (unsubscribe or disconnect)
+     * @return true if the client had one
+     */
+    bool removeSubscription(uint32_t clientId);
 
     /**
      * @brief Handle WebSocket events (connect/disconnect/data)
@@ -172,15 +482,22 @@ private:
      * @param data Event data
      * @param len Data length
      */
-    static void onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client,
-                                  AwsEventType type, void* arg, uint8_t* data, size_t len);
+    void onWebSocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client,
+                          AwsEventType type, void* arg, uint8_t* data, size_t len);
 
     /**
-     * @brief Save current filter to LittleFS (/log-filter.json)
+     * @brief Save current filter to LittleFS (/log-filter.json, temp file + rename)
+     *
+     * Run by GetWriteBehind() once the filter stopped changing; setters
+     * call persistFilter() instead.
+     *
      * @return true if save successful
      */
     bool saveFilter();
 
+    /// Mark the filter for a deferred save (synchronous before begin())
+    void persistFilter();
+
     /**
      * @brief Load filter from LittleFS (/log-filter.json)
      * @return true if load successful (false = use defaults)
@@ -190,4 +507,26 @@ private:
     static constexpr const char* FILTER_FILE = "/log-filter.json";
 };
 
-#endif // WEBSOCKET_LOGGER_H
\ No newline at end of file
+/**
+ * @name Level-specific logging macros
+ *
+ * First argument is a WebSocketLogger pointer; the rest are forwarded to
+ * broadcastLog() (LOG_<LEVEL>) or broadcastLogf() (LOG_<LEVEL>F). The level
+ * test is a compile-time constant, so disabled levels leave no code behind
+ * while the call still type-checks (and format strings are still verified).
+ * @{
+ */
+#define LOG_AT_(lg, level, fn, ...) \
+    do { if (LOG_LEVEL_COMPILED(level)) { (lg)->fn(level, __VA_ARGS__); } } while (0)
+
+#define LOG_DEBUG(lg, ...)  LOG_AT_(lg, LogLevel::DEBUG, broadcastLog, __VA_ARGS__)
+#define LOG_DEBUGF(lg, ...) LOG_AT_(lg, LogLevel::DEBUG, broadcastLogf, __VA_ARGS__)
+#define LOG_INFO(lg, ...)   LOG_AT_(lg, LogLevel::INFO, broadcastLog, __VA_ARGS__)
+#define LOG_INFOF(lg, ...)  LOG_AT_(lg, LogLevel::INFO, broadcastLogf, __VA_ARGS__)
+#define LOG_WARN(lg, ...)   LOG_AT_(lg, LogLevel::WARN, broadcastLog, __VA_ARGS__)
+#define LOG_WARNF(lg, ...)  LOG_AT_(lg, LogLevel::WARN, broadcastLogf, __VA_ARGS__)
+#define LOG_ERROR(lg, ...)  LOG_AT_(lg, LogLevel::ERROR, broadcastLog, __VA_ARGS__)
+#define LOG_ERRORF(lg, ...) LOG_AT_(lg, LogLevel::ERROR, broadcastLogf, __VA_ARGS__)
+/** @} */
+
+#endif // WEBSOCKET_LOGGER_H
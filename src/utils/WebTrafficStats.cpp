@@ -0,0 +1,236 @@
+/**
+ * @file WebTrafficStats.cpp
+ * @brief Implementation of the HTTP route and WebSocket endpoint statistics
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "WebTrafficStats.h"
+#include <string.h>
+
+namespace {
+
+const char* const ROUTE_NAMES[] = {
+#define WEB_ROUTE_NAME(id, name, prefix) name,
+    WEB_ROUTE_LIST(WEB_ROUTE_NAME)
+#undef WEB_ROUTE_NAME
+};
+
+const char* const ROUTE_PREFIXES[] = {
+#define WEB_ROUTE_PREFIX(id, name, prefix) prefix,
+    WEB_ROUTE_LIST(WEB_ROUTE_PREFIX)
+#undef WEB_ROUTE_PREFIX
+};
+
+const char* const SOCKET_NAMES[] = {
+#define WEB_SOCKET_NAME(id, name, path, limit) name,
+    ADMISSION_ENDPOINT_LIST(WEB_SOCKET_NAME)
+#undef WEB_SOCKET_NAME
+};
+
+}  // namespace
+
+WebTrafficStats::WebTrafficStats() {
+    for (uint8_t i = 0; i < SOCKET_COUNT; i++) {
+        sockets_[i].messages.store(0, std::memory_order_relaxed);
+        sockets_[i].bytes.store(0, std::memory_order_relaxed);
+        sockets_[i].upgrades.store(0, std::memory_order_relaxed);
+        sockets_[i].messageRateX10.store(0, std::memory_order_relaxed);
+        sockets_[i].byteRate.store(0, std::memory_order_relaxed);
+        sockets_[i].clients.store(0, std::memory_order_relaxed);
+        sockets_[i].queued.store(0, std::memory_order_relaxed);
+        sockets_[i].deepest.store(0, std::memory_order_relaxed);
+        sockets_[i].peak.store(0, std::memory_order_relaxed);
+        sockets_[i].sampledMessages = 0;
+        sockets_[i].sampledBytes = 0;
+        sockets_[i].sampledMs = 0;
+    }
+    reset();
+}
+
+WebRoute WebTrafficStats::routeFor(const char* path) {
+    WebRoute best = WebRoute::OTHER;
+    size_t bestLength = 0;
+    if (path == nullptr) {
+        return best;
+    }
+    for (uint8_t i = 0; i < ROUTE_COUNT; i++) {
+        size_t length = strlen(ROUTE_PREFIXES[i]);
+        if (length > bestLength && strncmp(path, ROUTE_PREFIXES[i], length) == 0) {
+            best = static_cast<WebRoute>(i);
+            bestLength = length;
+        }
+    }
+    return best;
+}
+
+const char* WebTrafficStats::routeName(WebRoute route) {
+    uint8_t index = static_cast<uint8_t>(route);
+    return ROUTE_NAMES[index < ROUTE_COUNT ? index : static_cast<uint8_t>(WebRoute::OTHER)];
+}
+
+const char* WebTrafficStats::socketName(AdmissionEndpoint endpoint) {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    return index < SOCKET_COUNT ? SOCKET_NAMES[index] : "";
+}
+
+void WebTrafficStats::recordResponse(WebRoute route, uint32_t firstByteUs, uint32_t rxBytes, uint32_t txBytes) {
+    uint8_t index = static_cast<uint8_t>(route);
+    if (index >= ROUTE_COUNT) {
+        return;
+    }
+    WebRouteStats& stats = routes_[index];
+    stats.requests++;
+    stats.rxBytes += rxBytes;
+    stats.txBytes += txBytes;
+    stats.firstByte.record(firstByteUs);
+}
+
+void WebTrafficStats::recordComplete(WebRoute route, uint32_t completeUs) {
+    uint8_t index = static_cast<uint8_t>(route);
+    if (index >= ROUTE_COUNT) {
+        return;
+    }
+    WebRouteStats& stats = routes_[index];
+    stats.completed++;
+    stats.complete.record(completeUs);
+}
+
+void WebTrafficStats::recordUpgrade(AdmissionEndpoint endpoint) {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    if (index < SOCKET_COUNT) {
+        sockets_[index].upgrades.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void WebTrafficStats::wsSent(AdmissionEndpoint endpoint, uint32_t bytes, uint32_t messages) {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    if (index >= SOCKET_COUNT || messages == 0) {
+        return;
+    }
+    sockets_[index].messages.fetch_add(messages, std::memory_order_relaxed);
+    sockets_[index].bytes.fetch_add(bytes * messages, std::memory_order_relaxed);
+}
+
+void WebTrafficStats::sampleSocket(AdmissionEndpoint endpoint, uint16_t clients, uint16_t queued,
+                                   uint16_t deepest, uint32_t nowMs) {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    if (index >= SOCKET_COUNT) {
+        return;
+    }
+    SocketStats& socket = sockets_[index];
+    uint32_t messages = socket.messages.load(std::memory_order_relaxed);
+    uint32_t bytes = socket.bytes.load(std::memory_order_relaxed);
+    uint32_t elapsedMs = nowMs - socket.sampledMs;
+    if (socket.sampledMs != 0 && elapsedMs > 0) {
+        uint64_t messageRate = static_cast<uint64_t>(messages - socket.sampledMessages) * 10000 / elapsedMs;
+        uint64_t byteRate = static_cast<uint64_t>(bytes - socket.sampledBytes) * 1000 / elapsedMs;
+        socket.messageRateX10.store(static_cast<uint32_t>(messageRate), std::memory_order_relaxed);
+        socket.byteRate.store(static_cast<uint32_t>(byteRate), std::memory_order_relaxed);
+    }
+    socket.sampledMessages = messages;
+    socket.sampledBytes = bytes;
+    socket.sampledMs = nowMs != 0 ? nowMs : 1;
+
+    socket.clients.store(clients, std::memory_order_relaxed);
+    socket.queued.store(queued, std::memory_order_relaxed);
+    socket.deepest.store(deepest, std::memory_order_relaxed);
+    if (deepest > socket.peak.load(std::memory_order_relaxed)) {
+        socket.peak.store(deepest, std::memory_order_relaxed);
+    }
+}
+
+void WebTrafficStats::reset() {
+    for (uint8_t i = 0; i < ROUTE_COUNT; i++) {
+        routes_[i].requests = 0;
+        routes_[i].completed = 0;
+        routes_[i].rxBytes = 0;
+        routes_[i].txBytes = 0;
+        routes_[i].firstByte.reset();
+        routes_[i].complete.reset();
+    }
+    for (uint8_t i = 0; i < SOCKET_COUNT; i++) {
+        sockets_[i].peak.store(0, std::memory_order_relaxed);
+    }
+}
+
+const WebRouteStats& WebTrafficStats::getRoute(WebRoute route) const {
+    uint8_t index = static_cast<uint8_t>(route);
+    return routes_[index < ROUTE_COUNT ? index : static_cast<uint8_t>(WebRoute::OTHER)];
+}
+
+uint32_t WebTrafficStats::getMessages(AdmissionEndpoint endpoint) const {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    return index < SOCKET_COUNT ? sockets_[index].messages.load(std::memory_order_relaxed) : 0;
+}
+
+uint32_t WebTrafficStats::getBytes(AdmissionEndpoint endpoint) const {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    return index < SOCKET_COUNT ? sockets_[index].bytes.load(std::memory_order_relaxed) : 0;
+}
+
+uint16_t WebTrafficStats::getClients(AdmissionEndpoint endpoint) const {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    return index < SOCKET_COUNT ? sockets_[index].clients.load(std::memory_order_relaxed) : 0;
+}
+
+uint32_t WebTrafficStats::getMessageRateX10(AdmissionEndpoint endpoint) const {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    return index < SOCKET_COUNT ? sockets_[index].messageRateX10.load(std::memory_order_relaxed) : 0;
+}
+
+uint32_t WebTrafficStats::getByteRate(AdmissionEndpoint endpoint) const {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    return index < SOCKET_COUNT ? sockets_[index].byteRate.load(std::memory_order_relaxed) : 0;
+}
+
+uint16_t WebTrafficStats::getQueuePeak(AdmissionEndpoint endpoint) const {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    return index < SOCKET_COUNT ? sockets_[index].peak.load(std::memory_order_relaxed) : 0;
+}
+
+void WebTrafficStats::writeHistogram(JsonWriter& json, const char* key, const LatencyHistogram& histogram) {
+    json.beginObject(key)
+        .add("avg_us", (unsigned long)histogram.getAverage())
+        .add("p50_us", (unsigned long)histogram.getPercentile(50))
+        .add("p99_us", (unsigned long)histogram.getPercentile(99))
+        .add("max_us", (unsigned long)histogram.getMax())
+        .endObject();
+}
+
+void WebTrafficStats::writeRouteJson(JsonWriter& json, WebRoute route) const {
+    const WebRouteStats& stats = getRoute(route);
+    json.beginObject(routeName(route))
+        .add("requests", (unsigned long)stats.requests)
+        .add("completed", (unsigned long)stats.completed)
+        .add("rx_bytes", (unsigned long)stats.rxBytes)
+        .add("tx_bytes", (unsigned long)stats.txBytes);
+    writeHistogram(json, "first_byte", stats.firstByte);
+    writeHistogram(json, "complete", stats.complete);
+    json.endObject();
+}
+
+void WebTrafficStats::writeSocketJson(JsonWriter& json, AdmissionEndpoint endpoint) const {
+    uint8_t index = static_cast<uint8_t>(endpoint);
+    if (index >= SOCKET_COUNT) {
+        return;
+    }
+    const SocketStats& socket = sockets_[index];
+    json.beginObject(socketName(endpoint))
+        .add("upgrades", (unsigned long)socket.upgrades.load(std::memory_order_relaxed))
+        .add("clients", (unsigned int)socket.clients.load(std::memory_order_relaxed))
+        .add("messages", (unsigned long)socket.messages.load(std::memory_order_relaxed))
+        .add("bytes", (unsigned long)socket.bytes.load(std::memory_order_relaxed))
+        .add("msg_per_s", socket.messageRateX10.load(std::memory_order_relaxed) / 10.0, 1)
+        .add("bytes_per_s", (unsigned long)socket.byteRate.load(std::memory_order_relaxed))
+        .add("queued", (unsigned int)socket.queued.load(std::memory_order_relaxed))
+        .add("deepest", (unsigned int)socket.deepest.load(std::memory_order_relaxed))
+        .add("peak", (unsigned int)socket.peak.load(std::memory_order_relaxed))
+        .endObject();
+}
+
+WebTrafficStats& GetWebTrafficStats() {
+    static WebTrafficStats webTrafficStats;
+    return webTrafficStats;
+}
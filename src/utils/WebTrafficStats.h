@@ -0,0 +1,199 @@
+/**
+ * @file WebTrafficStats.h
+ * @brief Per-route HTTP timing and per-endpoint WebSocket rates and send queues
+ *
+ * How long ESPAsyncWebServer takes to answer was unknown: the reaction
+ * profiler sees the main loop, not the async_tcp task where every handler
+ * runs. A middleware ahead of the handlers now records, per route:
+ *
+ * - requests, request body bytes (rx) and response bytes (tx)
+ * - first byte: from the middleware (request headers parsed) until the
+ *   handler returned its response, when the library writes the head
+ * - complete: until the connection closed after the last byte was
+ *   acknowledged (request->onDisconnect()). Handlers that install their own
+ *   disconnect callback (OTA upload, trace download) replace this one, so
+ *   their requests have no completion sample.
+ *
+ * Routes are matched by the longest path prefix of WEB_ROUTE_LIST; any
+ * other path counts as "other". WebSocket upgrades are not HTTP requests
+ * here: they are counted as upgrades of their endpoint.
+ *
+ * Per WebSocket endpoint (the AdmissionEndpoint set without HTTP): messages
+ * and bytes queued to clients (wsSent(), counted where frames are sent),
+ * and sampled every WEB_STATS_SAMPLE_MS by the main loop: message and byte
+ * rate over the last interval, the frames waiting in the client send
+ * queues (sum and deepest client) and the deepest queue since the reset.
+ *
+ * Threads: the HTTP half is written and read on the async_tcp task only
+ * (single writer, like LatencyHistogram); wsSent() may be called from any
+ * task. Arduino-free (unit tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * WebRoute route = WebTrafficStats::routeFor(path);
+ * uint32_t start = micros();
+ * next();                                                   // the handler
+ * stats.recordResponse(route, micros() - start, rxBytes, txBytes);
+ * // onDisconnect: stats.recordComplete(route, micros() - start);
+ * stats.wsSent(AdmissionEndpoint::BOATDATA, length, clients);
+ * stats.sampleSocket(AdmissionEndpoint::BOATDATA, clients, queued, deepest, millis());
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle V (Network Debugging): GET /web/stats
+ * - Principle II (Resource Management): send queue depth shows slow clients before they are evicted
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef WEB_TRAFFIC_STATS_H
+#define WEB_TRAFFIC_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "JsonWriter.h"
+#include "LatencyHistogram.h"
+#include "AdmissionController.h"
+#include "../config.h"
+
+/// HTTP routes: identifier, name (GET /web/stats), path prefix ("" = every other path)
+#define WEB_ROUTE_LIST(X) \
+    X(API_BOATDATA, "api_boatdata", "/api/boatdata") \
+    X(CALIBRATION, "calibration", "/api/calibration") \
+    X(CONFIG, "config", "/config") \
+    X(WIFI, "wifi", "/wifi") \
+    X(UPLOAD, "upload", "/upload") \
+    X(STATUS, "status", "/status") \
+    X(HISTORY, "history", "/history") \
+    X(VOYAGE, "voyage", "/voyage") \
+    X(STREAM, "stream", "/stream") \
+    X(METRICS, "metrics", "/metrics") \
+    X(OTHER, "other", "")
+
+/**
+ * @brief Routes with their own statistics
+ */
+enum class WebRoute : uint8_t {
+#define WEB_ROUTE_ENUM(id, name, prefix) id,
+    WEB_ROUTE_LIST(WEB_ROUTE_ENUM)
+#undef WEB_ROUTE_ENUM
+    COUNT
+};
+
+/**
+ * @brief Statistics of one HTTP route (async_tcp task)
+ */
+struct WebRouteStats {
+    uint32_t requests;          ///< Answered by a handler (or refused by admission)
+    uint32_t completed;         ///< Connection closed after the response
+    uint32_t rxBytes;           ///< Request bodies
+    uint32_t txBytes;           ///< Response bodies (0 for chunked responses)
+    LatencyHistogram firstByte; ///< Middleware to the handler's return, µs
+    LatencyHistogram complete;  ///< Middleware to the close, µs
+};
+
+/**
+ * @class WebTrafficStats
+ * @brief HTTP route and WebSocket endpoint statistics
+ */
+class WebTrafficStats {
+public:
+    static constexpr uint8_t ROUTE_COUNT = static_cast<uint8_t>(WebRoute::COUNT);
+    static constexpr uint8_t SOCKET_COUNT = static_cast<uint8_t>(AdmissionEndpoint::HTTP);
+
+    WebTrafficStats();
+
+    /// Route of a request path (longest matching prefix, else OTHER)
+    static WebRoute routeFor(const char* path);
+
+    /// "api_boatdata", "config", ... ("other" if out of range)
+    static const char* routeName(WebRoute route);
+
+    /// "boatdata", "signalk", "logs" ("" if not a WebSocket endpoint)
+    static const char* socketName(AdmissionEndpoint endpoint);
+
+    /// A handler returned after @p firstByteUs with a @p txBytes body (async_tcp task)
+    void recordResponse(WebRoute route, uint32_t firstByteUs, uint32_t rxBytes, uint32_t txBytes);
+
+    /// The connection closed @p completeUs after the middleware (async_tcp task)
+    void recordComplete(WebRoute route, uint32_t completeUs);
+
+    /// A WebSocket upgrade request for @p endpoint
+    void recordUpgrade(AdmissionEndpoint endpoint);
+
+    /// @p messages frames of @p bytes each queued to clients of @p endpoint (any task)
+    void wsSent(AdmissionEndpoint endpoint, uint32_t bytes, uint32_t messages = 1);
+
+    /**
+     * @brief Sample the send queues of @p endpoint and update its rates (main loop)
+     * @param clients Connected clients
+     * @param queued Frames waiting in all of their queues
+     * @param deepest Frames waiting in the fullest queue
+     */
+    void sampleSocket(AdmissionEndpoint endpoint, uint16_t clients, uint16_t queued, uint16_t deepest,
+                      uint32_t nowMs);
+
+    /// Forget the HTTP statistics and the queue peaks (async_tcp task)
+    void reset();
+
+    const WebRouteStats& getRoute(WebRoute route) const;
+
+    uint32_t getMessages(AdmissionEndpoint endpoint) const;
+    uint32_t getBytes(AdmissionEndpoint endpoint) const;
+
+    /// Connected clients at the last sample
+    uint16_t getClients(AdmissionEndpoint endpoint) const;
+
+    /// Messages per second over the last sample interval, in tenths
+    uint32_t getMessageRateX10(AdmissionEndpoint endpoint) const;
+
+    /// Bytes per second over the last sample interval
+    uint32_t getByteRate(AdmissionEndpoint endpoint) const;
+
+    /// Deepest client send queue since the reset
+    uint16_t getQueuePeak(AdmissionEndpoint endpoint) const;
+
+    /**
+     * @brief Write one route as a member object: "config":{"requests":12,...}
+     *
+     * {"requests":12,"completed":12,"rx_bytes":0,"tx_bytes":5120,
+     *  "first_byte":{"avg_us":850,"p50_us":1024,"p99_us":2048,"max_us":1900},"complete":{...}}
+     */
+    void writeRouteJson(JsonWriter& json, WebRoute route) const;
+
+    /**
+     * @brief Write one WebSocket endpoint as a member object: "boatdata":{...}
+     *
+     * {"upgrades":3,"clients":2,"messages":5400,"bytes":2700000,"msg_per_s":2.0,"bytes_per_s":1000,
+     *  "queued":1,"deepest":1,"peak":2}
+     */
+    void writeSocketJson(JsonWriter& json, AdmissionEndpoint endpoint) const;
+
+private:
+    struct SocketStats {
+        std::atomic<uint32_t> messages;
+        std::atomic<uint32_t> bytes;
+        std::atomic<uint32_t> upgrades;
+        std::atomic<uint32_t> messageRateX10;
+        std::atomic<uint32_t> byteRate;
+        std::atomic<uint16_t> clients;
+        std::atomic<uint16_t> queued;
+        std::atomic<uint16_t> deepest;
+        std::atomic<uint16_t> peak;
+        uint32_t sampledMessages;   ///< Main loop only
+        uint32_t sampledBytes;
+        uint32_t sampledMs;
+    };
+
+    static void writeHistogram(JsonWriter& json, const char* key, const LatencyHistogram& histogram);
+
+    WebRouteStats routes_[ROUTE_COUNT];
+    SocketStats sockets_[SOCKET_COUNT];
+};
+
+/// Process-wide web traffic statistics
+WebTrafficStats& GetWebTrafficStats();
+
+#endif // WEB_TRAFFIC_STATS_H
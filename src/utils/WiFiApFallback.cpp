@@ -0,0 +1,109 @@
+/**
+ * @file WiFiApFallback.cpp
+ * @brief Implementation of the SoftAP fallback policy
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "WiFiApFallback.h"
+
+WiFiApFallback::WiFiApFallback()
+    : state_(WiFiApState::OFF), retrying_(false), stations_(0), retryAtMs_(0),
+      retryIntervalMs_(WIFI_AP_RETRY_INTERVAL_MS), quietSinceMs_(0), starts_(0), retries_(0) {
+}
+
+WiFiApAction WiFiApFallback::update(const WiFiApInputs& inputs, uint32_t nowMs) {
+    stations_ = inputs.stations;
+
+    switch (state_) {
+        case WiFiApState::OFF:
+            if (inputs.staConnected || !inputs.exhausted) {
+                return WiFiApAction::NONE;
+            }
+            state_ = WiFiApState::ACTIVE;
+            retrying_ = false;
+            retryIntervalMs_ = WIFI_AP_RETRY_INTERVAL_MS;
+            retryAtMs_ = nowMs + retryIntervalMs_;
+            starts_++;
+            return WiFiApAction::START_AP;
+
+        case WiFiApState::ACTIVE:
+            if (inputs.staConnected) {
+                state_ = WiFiApState::LINGER;
+                retrying_ = false;
+                retryIntervalMs_ = WIFI_AP_RETRY_INTERVAL_MS;
+                quietSinceMs_ = 0;
+                return WiFiApAction::NONE;
+            }
+            if (!inputs.exhausted || !inputs.configured) {
+                return WiFiApAction::NONE;   // A round is running, or there is nothing to retry
+            }
+            if (retrying_) {
+                // The round failed: wait longer before the next one
+                retrying_ = false;
+                retryIntervalMs_ = retryIntervalMs_ * 2 < WIFI_AP_RETRY_MAX_MS ? retryIntervalMs_ * 2
+                                                                              : WIFI_AP_RETRY_MAX_MS;
+                retryAtMs_ = nowMs + retryIntervalMs_;
+                return WiFiApAction::NONE;
+            }
+            if (static_cast<int32_t>(nowMs - retryAtMs_) < 0) {
+                return WiFiApAction::NONE;
+            }
+            retrying_ = true;
+            retries_++;
+            return WiFiApAction::RETRY_STA;
+
+        case WiFiApState::LINGER:
+            if (!inputs.staConnected) {
+                // Link lost again: the AP is still up, retry on the normal schedule
+                state_ = WiFiApState::ACTIVE;
+                retryAtMs_ = nowMs + retryIntervalMs_;
+                return WiFiApAction::NONE;
+            }
+            if (inputs.stations > 0) {
+                quietSinceMs_ = 0;
+                return WiFiApAction::NONE;
+            }
+            if (quietSinceMs_ == 0) {
+                quietSinceMs_ = nowMs != 0 ? nowMs : 1;
+                return WiFiApAction::NONE;
+            }
+            if (nowMs - quietSinceMs_ < WIFI_AP_LINGER_MS) {
+                return WiFiApAction::NONE;
+            }
+            state_ = WiFiApState::OFF;
+            return WiFiApAction::STOP_AP;
+    }
+    return WiFiApAction::NONE;
+}
+
+uint32_t WiFiApFallback::getRetryInMs(uint32_t nowMs) const {
+    if (state_ != WiFiApState::ACTIVE || retrying_ || static_cast<int32_t>(nowMs - retryAtMs_) >= 0) {
+        return 0;
+    }
+    return retryAtMs_ - nowMs;
+}
+
+const char* WiFiApFallback::stateName(WiFiApState state) {
+    switch (state) {
+        case WiFiApState::ACTIVE: return "active";
+        case WiFiApState::LINGER: return "linger";
+        default:                  return "off";
+    }
+}
+
+void WiFiApFallback::writeJson(JsonWriter& json, uint32_t nowMs, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("state", stateName(state_))
+        .add("stations", (unsigned int)stations_)
+        .add("starts", (unsigned long)starts_)
+        .add("retries", (unsigned long)retries_)
+        .add("retry_interval_ms", (unsigned long)retryIntervalMs_)
+        .add("retry_in_ms", (unsigned long)getRetryInMs(nowMs))
+        .endObject();
+}
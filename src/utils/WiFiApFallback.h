@@ -0,0 +1,135 @@
+/**
+ * @file WiFiApFallback.h
+ * @brief SoftAP fallback: the gateway's own access point while no configured network is reachable
+ *
+ * Without it, a gateway out of range of every network in wifi.conf rebooted
+ * REBOOT_DELAY_MS after the last attempt, and rebooted again after the next
+ * round: no web server, no /boatdata, no dashboard for as long as the boat
+ * was away from the marina. Now the radio runs station and access point
+ * together (WIFI_AP_STA):
+ *
+ * - All networks failed, or none is configured: START_AP. The web server and
+ *   the streams come up on the access point (192.168.4.1).
+ * - While the AP is up, the station retries the whole list every retry
+ *   interval: WIFI_AP_RETRY_INTERVAL_MS, doubled after each failed round up
+ *   to WIFI_AP_RETRY_MAX_MS. With no configuration it never retries.
+ *   A station scan makes the radio leave the AP channel for a moment,
+ *   so the interval trades reconnect time against short gaps on the AP.
+ * - The station connected: the AP stays up while any device is associated
+ *   to it, and is stopped once it has had no station for WIFI_AP_LINGER_MS.
+ *   Clients of the AP never lose their stream because the boat came back
+ *   into range.
+ *
+ * update() is called once a second from the main loop with the current
+ * link state and returns what to do; the radio calls stay with the caller
+ * (IWiFiAdapter). Arduino-free (unit tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * WiFiApInputs in = {connected, exhausted, configured, wifiAdapter->getAccessPointStations()};
+ * switch (fallback.update(in, millis())) {
+ *     case WiFiApAction::START_AP:  wifiAdapter->startAccessPoint(ssid, password, channel); break;
+ *     case WiFiApAction::RETRY_STA: state.resetNetworkIndex(); wifiManager->connect(state, config); break;
+ *     case WiFiApAction::STOP_AP:   wifiAdapter->stopAccessPoint(); break;
+ *     default: break;
+ * }
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle VII (Fail-Safe): data keeps flowing on the AP instead of a reboot loop
+ * - Principle V (Network Debugging): state, rounds and stations in GET /wifi-status
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef WIFI_AP_FALLBACK_H
+#define WIFI_AP_FALLBACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Access point state
+ */
+enum class WiFiApState : uint8_t {
+    OFF = 0,    ///< Station only
+    ACTIVE,     ///< AP up, station not connected (retrying between intervals)
+    LINGER      ///< Station connected, AP kept for its associated devices
+};
+
+/**
+ * @brief What the caller does after update()
+ */
+enum class WiFiApAction : uint8_t {
+    NONE = 0,
+    START_AP,   ///< Start the access point (and the network services if not running)
+    RETRY_STA,  ///< Restart the station from the first configured network
+    STOP_AP     ///< Stop the access point, station only again
+};
+
+/**
+ * @brief Link state passed to update()
+ */
+struct WiFiApInputs {
+    bool staConnected;      ///< Station has an address
+    bool exhausted;         ///< No attempt running and every configured network failed
+    bool configured;        ///< wifi.conf has at least one network
+    uint8_t stations;       ///< Devices associated to the AP
+};
+
+/**
+ * @class WiFiApFallback
+ * @brief Decides when the AP starts and stops and when the station retries (main loop only)
+ */
+class WiFiApFallback {
+public:
+    WiFiApFallback();
+
+    /**
+     * @brief Advance the state with the current link state
+     * @return The action to take now (at most one per call)
+     */
+    WiFiApAction update(const WiFiApInputs& inputs, uint32_t nowMs);
+
+    WiFiApState getState() const { return state_; }
+
+    /// The access point is up (ACTIVE or LINGER)
+    bool isActive() const { return state_ != WiFiApState::OFF; }
+
+    /// Interval before the next station round in ms
+    uint32_t getRetryIntervalMs() const { return retryIntervalMs_; }
+
+    /// Milliseconds until the next station round (0 = due, or not waiting)
+    uint32_t getRetryInMs(uint32_t nowMs) const;
+
+    uint32_t getStarts() const { return starts_; }
+    uint32_t getRetries() const { return retries_; }
+
+    /// Stations seen by the last update()
+    uint8_t getStations() const { return stations_; }
+
+    /// "off", "active" or "linger"
+    static const char* stateName(WiFiApState state);
+
+    /**
+     * @brief Write the state as a JSON object
+     *
+     * {"state":"active","stations":1,"starts":1,"retries":3,"retry_interval_ms":240000,"retry_in_ms":61000}
+     */
+    void writeJson(JsonWriter& json, uint32_t nowMs, const char* key = nullptr) const;
+
+private:
+    WiFiApState state_;
+    bool retrying_;             ///< A station round started by RETRY_STA is running
+    uint8_t stations_;
+    uint32_t retryAtMs_;        ///< When the next round is due
+    uint32_t retryIntervalMs_;
+    uint32_t quietSinceMs_;     ///< LINGER: first update without stations (0 = stations present)
+    uint32_t starts_;
+    uint32_t retries_;
+};
+
+#endif // WIFI_AP_FALLBACK_H
@@ -0,0 +1,339 @@
+/**
+ * @file WiFiFastConnect.cpp
+ * @brief Implementation of the Wi-Fi association cache, static IP parsing and connect statistics
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "WiFiFastConnect.h"
+#include <string.h>
+#include <stdio.h>
+
+namespace {
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/// Dotted quad at @p text; advances @p text past it
+bool parseQuad(const char*& text, uint8_t out[4]) {
+    for (uint8_t i = 0; i < 4; i++) {
+        if (i > 0) {
+            if (*text != '.') {
+                return false;
+            }
+            text++;
+        }
+        uint16_t value = 0;
+        uint8_t digits = 0;
+        while (*text >= '0' && *text <= '9' && digits < 3) {
+            value = value * 10 + (*text - '0');
+            text++;
+            digits++;
+        }
+        if (digits == 0 || value > 255 || (*text >= '0' && *text <= '9')) {
+            return false;
+        }
+        out[i] = static_cast<uint8_t>(value);
+    }
+    return true;
+}
+
+uint32_t toWord(const uint8_t quad[4]) {
+    return (uint32_t)quad[0] << 24 | (uint32_t)quad[1] << 16 | (uint32_t)quad[2] << 8 | quad[3];
+}
+
+bool contiguousMask(uint32_t mask) {
+    return mask != 0 && ((~mask + 1) & ~mask) == 0;  // Ones, then zeros only
+}
+
+void skipSpaces(const char*& text) {
+    while (*text == ' ' || *text == '\t') {
+        text++;
+    }
+}
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+// WiFiStaticIP
+// ----------------------------------------------------------------------------
+
+void WiFiStaticIP::clear() {
+    memset(ip, 0, sizeof(ip));
+    memset(subnet, 0, sizeof(subnet));
+    memset(gateway, 0, sizeof(gateway));
+    memset(dns, 0, sizeof(dns));
+}
+
+bool WiFiStaticIP::operator==(const WiFiStaticIP& other) const {
+    return memcmp(ip, other.ip, 4) == 0 && memcmp(subnet, other.subnet, 4) == 0 &&
+           memcmp(gateway, other.gateway, 4) == 0 && memcmp(dns, other.dns, 4) == 0;
+}
+
+bool WiFiParseStaticIP(const char* text, WiFiStaticIP& out) {
+    out.clear();
+    if (text == nullptr) {
+        return false;
+    }
+
+    WiFiStaticIP parsed;
+    uint8_t* fields[4] = {parsed.ip, parsed.subnet, parsed.gateway, parsed.dns};
+    uint8_t count = 0;
+    skipSpaces(text);
+    while (*text != '\0' && count < 4) {
+        if (!parseQuad(text, fields[count])) {
+            return false;
+        }
+        count++;
+        if (*text != '\0' && *text != ' ' && *text != '\t') {
+            return false;
+        }
+        skipSpaces(text);
+    }
+    if (count < 3 || *text != '\0') {
+        return false;
+    }
+    if (count == 3) {
+        memcpy(parsed.dns, parsed.gateway, 4);
+    }
+
+    uint32_t ip = toWord(parsed.ip);
+    uint32_t mask = toWord(parsed.subnet);
+    uint32_t gateway = toWord(parsed.gateway);
+    if (!contiguousMask(mask) || mask == 0xFFFFFFFFu || (ip & mask) != (gateway & mask) ||
+        (ip & ~mask) == 0 || (ip & ~mask) == ~mask || ip == gateway) {
+        return false;
+    }
+
+    out = parsed;
+    return true;
+}
+
+size_t WiFiFormatStaticIP(const WiFiStaticIP& ip, char* out, size_t size) {
+    int n = snprintf(out, size, "%u.%u.%u.%u %u.%u.%u.%u %u.%u.%u.%u %u.%u.%u.%u",
+                     ip.ip[0], ip.ip[1], ip.ip[2], ip.ip[3],
+                     ip.subnet[0], ip.subnet[1], ip.subnet[2], ip.subnet[3],
+                     ip.gateway[0], ip.gateway[1], ip.gateway[2], ip.gateway[3],
+                     ip.dns[0], ip.dns[1], ip.dns[2], ip.dns[3]);
+    return (n > 0 && static_cast<size_t>(n) < size) ? static_cast<size_t>(n) : 0;
+}
+
+// ----------------------------------------------------------------------------
+// WiFiConnectCache
+// ----------------------------------------------------------------------------
+
+WiFiConnectCache::WiFiConnectCache() : count_(0), clock_(0) {
+}
+
+void WiFiConnectCache::clear() {
+    count_ = 0;
+    clock_ = 0;
+}
+
+int8_t WiFiConnectCache::find(const char* ssid) const {
+    for (uint8_t i = 0; i < count_; i++) {
+        if (strcmp(entries_[i].ssid, ssid) == 0) {
+            return static_cast<int8_t>(i);
+        }
+    }
+    return -1;
+}
+
+bool WiFiConnectCache::lookup(const char* ssid, uint8_t bssid[6], uint8_t& channel) const {
+    int8_t i = ssid != nullptr ? find(ssid) : -1;
+    if (i < 0 || entries_[i].failed) {
+        return false;
+    }
+    memcpy(bssid, entries_[i].bssid, 6);
+    channel = entries_[i].channel;
+    return true;
+}
+
+bool WiFiConnectCache::remember(const char* ssid, const uint8_t bssid[6], uint8_t channel) {
+    if (ssid == nullptr || bssid == nullptr || ssid[0] == '\0' || strlen(ssid) >= sizeof(entries_[0].ssid) ||
+        channel == 0) {
+        return false;
+    }
+    static const uint8_t NONE[6] = {0, 0, 0, 0, 0, 0};
+    if (memcmp(bssid, NONE, 6) == 0) {
+        return false;
+    }
+    int8_t i = find(ssid);
+    if (i < 0) {
+        if (count_ < MAX_ENTRIES) {
+            i = static_cast<int8_t>(count_++);
+        } else {
+            i = 0;  // Least recently used
+            for (uint8_t j = 1; j < count_; j++) {
+                if (entries_[j].lastUsed < entries_[i].lastUsed) {
+                    i = static_cast<int8_t>(j);
+                }
+            }
+        }
+        strcpy(entries_[i].ssid, ssid);
+        memset(entries_[i].bssid, 0, 6);
+        entries_[i].channel = 0;
+        entries_[i].failed = true;  // Forces the changed result below
+    }
+
+    WiFiConnectCacheEntry& entry = entries_[i];
+    entry.lastUsed = ++clock_;
+    bool changed = entry.failed || entry.channel != channel || memcmp(entry.bssid, bssid, 6) != 0;
+    memcpy(entry.bssid, bssid, 6);
+    entry.channel = channel;
+    entry.failed = false;
+    return changed;
+}
+
+bool WiFiConnectCache::markFailed(const char* ssid) {
+    int8_t i = ssid != nullptr ? find(ssid) : -1;
+    if (i < 0 || entries_[i].failed) {
+        return false;
+    }
+    entries_[i].failed = true;
+    return true;
+}
+
+size_t WiFiConnectCache::serialize(char* out, size_t size) const {
+    size_t pos = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        const WiFiConnectCacheEntry& entry = entries_[i];
+        if (entry.failed) {
+            continue;
+        }
+        size_t ssidLength = strlen(entry.ssid);
+        size_t need = 12 + 1 + 3 + 1 + 2 * ssidLength + 1;
+        if (pos + need + 1 > size) {
+            return 0;
+        }
+        for (uint8_t b = 0; b < 6; b++) {
+            out[pos++] = HEX_DIGITS[entry.bssid[b] >> 4];
+            out[pos++] = HEX_DIGITS[entry.bssid[b] & 0x0F];
+        }
+        pos += snprintf(out + pos, size - pos, " %u ", (unsigned)entry.channel);
+        for (size_t c = 0; c < ssidLength; c++) {
+            uint8_t byte = static_cast<uint8_t>(entry.ssid[c]);
+            out[pos++] = HEX_DIGITS[byte >> 4];
+            out[pos++] = HEX_DIGITS[byte & 0x0F];
+        }
+        out[pos++] = '\n';
+    }
+    if (size == 0) {
+        return 0;
+    }
+    out[pos] = '\0';
+    return pos;
+}
+
+uint8_t WiFiConnectCache::deserialize(const char* text) {
+    clear();
+    if (text == nullptr) {
+        return 0;
+    }
+
+    while (*text != '\0' && count_ < MAX_ENTRIES) {
+        const char* line = text;
+        const char* end = strchr(line, '\n');
+        if (end == nullptr) {
+            end = line + strlen(line);
+        }
+        text = *end == '\n' ? end + 1 : end;
+
+        // <bssid 12 hex> <channel> <ssid hex>
+        WiFiConnectCacheEntry& entry = entries_[count_];
+        const char* p = line;
+        bool ok = end - line >= 12 + 1 + 1 + 1 + 2;
+        for (uint8_t b = 0; ok && b < 6; b++) {
+            int hi = hexValue(p[0]);
+            int lo = hexValue(p[1]);
+            ok = hi >= 0 && lo >= 0;
+            entry.bssid[b] = static_cast<uint8_t>(hi << 4 | lo);
+            p += 2;
+        }
+        ok = ok && *p++ == ' ';
+        unsigned channel = 0;
+        while (ok && p < end && *p >= '0' && *p <= '9') {
+            channel = channel * 10 + (*p++ - '0');
+        }
+        ok = ok && channel >= 1 && channel <= 14 && p < end && *p++ == ' ';
+        size_t ssidLength = 0;
+        while (ok && p < end) {
+            int hi = hexValue(p[0]);
+            int lo = p + 1 < end ? hexValue(p[1]) : -1;
+            ok = hi >= 0 && lo >= 0 && (hi | lo) != 0 && ssidLength < sizeof(entry.ssid) - 1;
+            if (ok) {
+                entry.ssid[ssidLength++] = static_cast<char>(hi << 4 | lo);
+                p += 2;
+            }
+        }
+        entry.ssid[ssidLength] = '\0';
+        if (!ok || ssidLength == 0 || find(entry.ssid) >= 0) {
+            continue;  // Malformed or duplicate line: that network is scanned
+        }
+        entry.channel = static_cast<uint8_t>(channel);
+        entry.failed = false;
+        entry.lastUsed = ++clock_;
+        count_++;
+    }
+    return count_;
+}
+
+// ----------------------------------------------------------------------------
+// WiFiConnectStats
+// ----------------------------------------------------------------------------
+
+WiFiConnectStats::WiFiConnectStats()
+    : fallbacks_(0), lastMs_(0), lastOutageMs_(0), maxMs_(0), lastMode_(WiFiConnectMode::SCAN) {
+    for (uint8_t i = 0; i < 2; i++) {
+        attempts_[i] = 0;
+        connects_[i] = 0;
+        totalMs_[i] = 0;
+    }
+}
+
+void WiFiConnectStats::recordAttempt(WiFiConnectMode mode) {
+    attempts_[index(mode)]++;
+}
+
+void WiFiConnectStats::recordConnected(WiFiConnectMode mode, uint32_t attemptMs, uint32_t outageMs) {
+    connects_[index(mode)]++;
+    totalMs_[index(mode)] += attemptMs;
+    lastMs_ = attemptMs;
+    lastOutageMs_ = outageMs;
+    lastMode_ = mode;
+    if (attemptMs > maxMs_) {
+        maxMs_ = attemptMs;
+    }
+}
+
+uint32_t WiFiConnectStats::getAverageMs(WiFiConnectMode mode) const {
+    uint32_t connects = connects_[index(mode)];
+    return connects > 0 ? totalMs_[index(mode)] / connects : 0;
+}
+
+void WiFiConnectStats::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("fast_attempts", (unsigned long)attempts_[1])
+        .add("fast_connects", (unsigned long)connects_[1])
+        .add("fallbacks", (unsigned long)fallbacks_)
+        .add("scan_attempts", (unsigned long)attempts_[0])
+        .add("scan_connects", (unsigned long)connects_[0])
+        .add("last_mode", lastMode_ == WiFiConnectMode::FAST ? "fast" : "scan")
+        .add("last_ms", (unsigned long)lastMs_)
+        .add("last_outage_ms", (unsigned long)lastOutageMs_)
+        .add("avg_fast_ms", (unsigned long)getAverageMs(WiFiConnectMode::FAST))
+        .add("avg_scan_ms", (unsigned long)getAverageMs(WiFiConnectMode::SCAN))
+        .add("max_ms", (unsigned long)maxMs_);
+    json.endObject();
+}
@@ -0,0 +1,212 @@
+/**
+ * @file WiFiFastConnect.h
+ * @brief Directed Wi-Fi reconnect: cached BSSID/channel, static IP option, time-to-connect statistics
+ *
+ * A plain WiFi.begin(ssid, password) scans every channel before it picks
+ * an access point, then runs DHCP; in a marina with dozens of APs a
+ * reconnect takes 3-8 s. WiFiManager remembers the BSSID and channel of
+ * every network it connected to (WiFiConnectCache, persisted in
+ * WIFI_CACHE_FILE) and tries a directed connect to them first. If that
+ * does not succeed within WIFI_FAST_CONNECT_TIMEOUT_MS the entry is marked
+ * failed and the same network is retried with a full scan.
+ *
+ * A network may also carry a static address (WiFiStaticIP, "@ip" line in
+ * wifi.conf), which skips DHCP.
+ *
+ * Cache file: one line per network, "<bssid, 12 hex> <channel> <ssid, hex>".
+ * Hex keeps every SSID byte intact; a garbled file only costs a scan.
+ *
+ * Header + Arduino-free implementation (unit tested natively).
+ *
+ * Usage:
+ * @code
+ * uint8_t bssid[6];
+ * uint8_t channel;
+ * if (cache.lookup(ssid, bssid, channel)) {
+ *     wifi.beginDirected(ssid, password, channel, bssid);  // No scan
+ * }
+ * cache.remember(ssid, connectedBssid, connectedChannel);  // On GOT_IP
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed tables, no heap
+ * - Principle VII (Fail-Safe): a stale entry falls back to the scan, never blocks a connect
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef WIFI_FAST_CONNECT_H
+#define WIFI_FAST_CONNECT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief Static IPv4 configuration of one network (all zero = DHCP)
+ */
+struct WiFiStaticIP {
+    uint8_t ip[4];        ///< Station address, first octet first
+    uint8_t subnet[4];
+    uint8_t gateway[4];
+    uint8_t dns[4];       ///< Defaults to the gateway
+
+    WiFiStaticIP() { clear(); }
+
+    void clear();
+
+    /// A static address is configured
+    bool enabled() const { return ip[0] != 0 || ip[1] != 0 || ip[2] != 0 || ip[3] != 0; }
+
+    bool operator==(const WiFiStaticIP& other) const;
+};
+
+/**
+ * @brief Parse "<ip> <subnet> <gateway> [<dns>]" (dotted quads separated by spaces)
+ *
+ * The subnet must be a contiguous mask, the address and gateway must be in
+ * it, and the address must be neither the network nor the broadcast address.
+ *
+ * @return false (and @p out cleared) on any error
+ */
+bool WiFiParseStaticIP(const char* text, WiFiStaticIP& out);
+
+/**
+ * @brief Format @p ip the way WiFiParseStaticIP() reads it
+ * @return Characters written (without the terminator), 0 if @p size is too small
+ */
+size_t WiFiFormatStaticIP(const WiFiStaticIP& ip, char* out, size_t size);
+
+/**
+ * @brief Cached association of one network
+ */
+struct WiFiConnectCacheEntry {
+    char ssid[33];
+    uint8_t bssid[6];
+    uint8_t channel;
+    bool failed;          ///< The last directed connect did not succeed: scan next time
+    uint32_t lastUsed;    ///< Replacement order (cache clock)
+};
+
+/**
+ * @class WiFiConnectCache
+ * @brief BSSID and channel of the networks connected to last (MAX_NETWORKS entries)
+ */
+class WiFiConnectCache {
+public:
+    static constexpr uint8_t MAX_ENTRIES = MAX_NETWORKS;
+
+    /// Longest serialize() text: 12 + 1 + 3 + 1 + 64 + 1 per entry, plus the terminator
+    static constexpr size_t MAX_TEXT = MAX_ENTRIES * 82 + 1;
+
+    WiFiConnectCache();
+
+    void clear();
+
+    /**
+     * @brief Directed connect target of @p ssid
+     * @return false if the network is unknown or its last directed connect failed
+     */
+    bool lookup(const char* ssid, uint8_t bssid[6], uint8_t& channel) const;
+
+    /**
+     * @brief Record a successful association (replaces the least recently used entry when full)
+     * @return true if the entry changed (persist it)
+     */
+    bool remember(const char* ssid, const uint8_t bssid[6], uint8_t channel);
+
+    /**
+     * @brief A directed connect to @p ssid did not succeed
+     * @return true if the entry changed (persist it)
+     */
+    bool markFailed(const char* ssid);
+
+    uint8_t size() const { return count_; }
+
+    /// Entry @p index (nullptr if out of range)
+    const WiFiConnectCacheEntry* at(uint8_t index) const { return index < count_ ? &entries_[index] : nullptr; }
+
+    /**
+     * @brief Write the cache file text (failed entries are left out)
+     * @return Characters written, 0 if @p size is too small
+     */
+    size_t serialize(char* out, size_t size) const;
+
+    /**
+     * @brief Replace the cache with the entries of a cache file
+     * @return Entries read (malformed lines are skipped)
+     */
+    uint8_t deserialize(const char* text);
+
+private:
+    int8_t find(const char* ssid) const;
+
+    WiFiConnectCacheEntry entries_[MAX_ENTRIES];
+    uint8_t count_;
+    uint32_t clock_;
+};
+
+/**
+ * @brief How a connection attempt was started
+ */
+enum class WiFiConnectMode : uint8_t {
+    SCAN = 0,   ///< WiFi.begin(ssid, password): all-channel scan
+    FAST        ///< Directed to the cached BSSID and channel
+};
+
+/**
+ * @class WiFiConnectStats
+ * @brief Time-to-connect counters (GET /wifi-status "connect")
+ *
+ * Plain 32-bit words: written by the WiFi event task and the main loop,
+ * read by the HTTP handlers; a reader may see one update late.
+ */
+class WiFiConnectStats {
+public:
+    WiFiConnectStats();
+
+    void recordAttempt(WiFiConnectMode mode);
+
+    /// A directed connect failed and the network is scanned instead
+    void recordFallback() { fallbacks_++; }
+
+    /**
+     * @brief Got an address
+     * @param attemptMs From the start of the successful attempt
+     * @param outageMs From the link loss (0 = first connect since boot)
+     */
+    void recordConnected(WiFiConnectMode mode, uint32_t attemptMs, uint32_t outageMs);
+
+    uint32_t getAttempts(WiFiConnectMode mode) const { return attempts_[index(mode)]; }
+    uint32_t getConnects(WiFiConnectMode mode) const { return connects_[index(mode)]; }
+    uint32_t getFallbacks() const { return fallbacks_; }
+    uint32_t getLastMs() const { return lastMs_; }
+    uint32_t getLastOutageMs() const { return lastOutageMs_; }
+
+    /// Mean time-to-connect of @p mode (0 = none yet)
+    uint32_t getAverageMs(WiFiConnectMode mode) const;
+
+    /**
+     * @brief Write the counters as a JSON object
+     *
+     * {"fast_attempts":3,"fast_connects":2,"fallbacks":1,"scan_attempts":1,"scan_connects":1,
+     *  "last_mode":"fast","last_ms":620,"last_outage_ms":900,"avg_fast_ms":640,"avg_scan_ms":4100,"max_ms":4100}
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    static uint8_t index(WiFiConnectMode mode) { return mode == WiFiConnectMode::FAST ? 1 : 0; }
+
+    uint32_t attempts_[2];
+    uint32_t connects_[2];
+    uint32_t totalMs_[2];
+    uint32_t fallbacks_;
+    uint32_t lastMs_;
+    uint32_t lastOutageMs_;
+    uint32_t maxMs_;
+    WiFiConnectMode lastMode_;
+};
+
+#endif // WIFI_FAST_CONNECT_H
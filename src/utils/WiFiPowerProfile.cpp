@@ -0,0 +1,185 @@
+/**
+ * @file WiFiPowerProfile.cpp
+ * @brief Implementation of the Wi-Fi power profile selection
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "WiFiPowerProfile.h"
+#include <string.h>
+
+namespace {
+
+const WiFiPowerProfile PROFILES[] = {
+#define WIFI_PROFILE_ENTRY(id, name, ps, tx, broadcast, fastest, udp, calc, nav) \
+    {name, ps, tx, broadcast, fastest, udp, calc, nav},
+    WIFI_PROFILE_LIST(WIFI_PROFILE_ENTRY)
+#undef WIFI_PROFILE_ENTRY
+};
+
+static_assert(WIFI_PROFILE_DEFAULT < static_cast<uint8_t>(WiFiProfile::COUNT), "WIFI_PROFILE_DEFAULT must name a profile");
+
+}  // namespace
+
+WiFiProfileSelector::WiFiProfileSelector()
+    : changes_(0), sinceMs_(0) {
+    active_.store(WIFI_PROFILE_DEFAULT, std::memory_order_relaxed);
+    pending_.store(NO_REQUEST, std::memory_order_relaxed);
+    pingProfile_.store(WIFI_PROFILE_DEFAULT, std::memory_order_relaxed);
+    pingSentUs_.store(0, std::memory_order_relaxed);
+    memset(activeMs_, 0, sizeof(activeMs_));
+}
+
+const WiFiPowerProfile& WiFiProfileSelector::profile(WiFiProfile id) {
+    uint8_t index = static_cast<uint8_t>(id);
+    return PROFILES[index < PROFILE_COUNT ? index : WIFI_PROFILE_DEFAULT];
+}
+
+bool WiFiProfileSelector::fromName(const char* name, WiFiProfile& out) {
+    if (name == nullptr) {
+        return false;
+    }
+    for (uint8_t i = 0; i < PROFILE_COUNT; i++) {
+        if (strcmp(name, PROFILES[i].name) == 0) {
+            out = static_cast<WiFiProfile>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+const char* WiFiProfileSelector::powerSaveName(WiFiPowerSave mode) {
+    switch (mode) {
+        case WiFiPowerSave::NONE:      return "none";
+        case WiFiPowerSave::MAX_MODEM: return "max_modem";
+        default:                       return "min_modem";
+    }
+}
+
+void WiFiProfileSelector::request(WiFiProfile id) {
+    uint8_t index = static_cast<uint8_t>(id);
+    if (index < PROFILE_COUNT) {
+        pending_.store(index, std::memory_order_relaxed);
+    }
+}
+
+bool WiFiProfileSelector::takeRequest(WiFiProfile& out) {
+    uint8_t index = pending_.exchange(NO_REQUEST, std::memory_order_relaxed);
+    if (index >= PROFILE_COUNT) {
+        return false;
+    }
+    out = static_cast<WiFiProfile>(index);
+    return true;
+}
+
+WiFiProfile WiFiProfileSelector::getPending() const {
+    return static_cast<WiFiProfile>(pending_.load(std::memory_order_relaxed));
+}
+
+bool WiFiProfileSelector::select(WiFiProfile id, uint32_t nowMs) {
+    uint8_t index = static_cast<uint8_t>(id);
+    if (index >= PROFILE_COUNT) {
+        return false;
+    }
+    uint8_t previous = active_.load(std::memory_order_relaxed);
+    activeMs_[previous] += nowMs - sinceMs_;
+    sinceMs_ = nowMs;
+    if (index != previous) {
+        active_.store(index, std::memory_order_relaxed);
+        changes_++;
+    }
+    return true;
+}
+
+uint32_t WiFiProfileSelector::getActiveMs(WiFiProfile id, uint32_t nowMs) const {
+    uint8_t index = static_cast<uint8_t>(id);
+    if (index >= PROFILE_COUNT) {
+        return 0;
+    }
+    uint32_t total = activeMs_[index];
+    if (index == active_.load(std::memory_order_relaxed)) {
+        total += nowMs - sinceMs_;
+    }
+    return total;
+}
+
+void WiFiProfileSelector::pingSent(uint32_t nowUs) {
+    pingProfile_.store(active_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    pingSentUs_.store(nowUs != 0 ? nowUs : 1, std::memory_order_release);
+}
+
+void WiFiProfileSelector::pongReceived(uint32_t nowUs) {
+    uint32_t sentUs = pingSentUs_.load(std::memory_order_acquire);
+    if (sentUs == 0) {
+        return;
+    }
+    uint32_t roundTripUs = nowUs - sentUs;
+    if (roundTripUs > static_cast<uint32_t>(WIFI_PROFILE_PING_INTERVAL_MS) * 1000UL) {
+        return;   // Answer to an older ping, or a client-initiated pong
+    }
+    roundTrip_[pingProfile_.load(std::memory_order_relaxed)].record(roundTripUs);
+}
+
+const LatencyHistogram& WiFiProfileSelector::getRoundTrip(WiFiProfile id) const {
+    uint8_t index = static_cast<uint8_t>(id);
+    return roundTrip_[index < PROFILE_COUNT ? index : WIFI_PROFILE_DEFAULT];
+}
+
+size_t WiFiProfileSelector::encodeRecord(uint8_t* out, size_t size) const {
+    ConfigRecordWriter record(out, size);
+    record.putString(getActiveProfile().name);   // By name: the table may be reordered
+    return record.finish(WIFI_PROFILE_RECORD_SCHEMA);
+}
+
+ConfigRecordStatus WiFiProfileSelector::decodeRecord(const uint8_t* data, size_t length) {
+    ConfigRecordReader record(data, length);
+    uint16_t schema = 0;
+    ConfigRecordStatus status = record.open(schema);
+    if (status != ConfigRecordStatus::OK) {
+        return status;
+    }
+    char name[16];
+    WiFiProfile id = WiFiProfile::COUNT;
+    if (!record.getString(name, sizeof(name)) || !fromName(name, id)) {
+        return ConfigRecordStatus::TRUNCATED;
+    }
+    active_.store(static_cast<uint8_t>(id), std::memory_order_relaxed);
+    return ConfigRecordStatus::OK;
+}
+
+void WiFiProfileSelector::writeJson(JsonWriter& json, uint32_t nowMs, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    const WiFiPowerProfile& active = getActiveProfile();
+    uint8_t pending = pending_.load(std::memory_order_relaxed);
+    json.add("active", active.name)
+        .add("pending", pending < PROFILE_COUNT ? PROFILES[pending].name : nullptr)
+        .add("changes", (unsigned long)changes_)
+        .add("power_save", powerSaveName(active.powerSave))
+        .add("tx_power_dbm", active.txQuarterDbm / 4.0)
+        .add("broadcast_ms", (unsigned long)active.broadcastMs)
+        .add("fastest_ms", (unsigned long)active.fastestMs)
+        .add("udp_ms", (unsigned long)active.udpMs)
+        .add("calc_ms", (unsigned long)active.calcMinMs)
+        .add("nav_ms", (unsigned long)active.navMinMs);
+
+    json.beginObject("profiles");
+    for (uint8_t i = 0; i < PROFILE_COUNT; i++) {
+        const LatencyHistogram& rtt = roundTrip_[i];
+        json.beginObject(PROFILES[i].name)
+            .add("active_s", (unsigned long)(getActiveMs(static_cast<WiFiProfile>(i), nowMs) / 1000))
+            .beginObject("rtt")
+            .add("count", (unsigned long)rtt.getCount())
+            .add("avg_us", (unsigned long)rtt.getAverage())
+            .add("p50_us", (unsigned long)rtt.getPercentile(50))
+            .add("p99_us", (unsigned long)rtt.getPercentile(99))
+            .add("max_us", (unsigned long)rtt.getMax())
+            .endObject()
+            .endObject();
+    }
+    json.endObject().endObject();
+}
@@ -0,0 +1,194 @@
+/**
+ * @file WiFiPowerProfile.h
+ * @brief Wi-Fi power/latency profiles and the runtime profile selection
+ *
+ * A profile sets the radio and the streaming rates together, so a low
+ * power setting is not undone by a dashboard polling at 5 Hz (and a fast
+ * dashboard is not throttled by modem sleep):
+ *
+ * | Profile  | Power save | TX power | /boatdata default | fastest | UDP    | calc    | nav     |
+ * |----------|------------|----------|-------------------|---------|--------|---------|---------|
+ * | racing   | none       | 19.5 dBm | 200 ms            | 200 ms  | 200 ms | 100 ms  | 1000 ms |
+ * | balanced | min modem  | 17 dBm   | 1000 ms           | 200 ms  | 200 ms | 100 ms  | 1000 ms |
+ * | anchor   | max modem  | 11 dBm   | 2000 ms           | 2000 ms | 2000 ms| 1000 ms | 5000 ms |
+ *
+ * The /boatdata default and fastest intervals bound the rate governor
+ * (BoatDataRateGovernor::setRange), which still backs off under load. The
+ * calc and nav intervals are the minimum intervals of the calculation and
+ * navigation subscriptions: at anchor the derived data is recomputed once a
+ * second, while the alarm engine keeps watching its inputs at its own rate.
+ * Modem sleep wakes the radio on DTIM beacons only, delaying frames to the
+ * device; the effect is measured as the WebSocket ping round trip to the
+ * /boatdata clients, one histogram per profile, so profiles can be compared
+ * on the same boat and network.
+ *
+ * The HTTP handler records a request (atomic); the main loop takes it and
+ * applies the radio settings and rates (WiFiProfileManager). The selection
+ * is stored as a ConfigRecord under WIFI_PROFILE_RECORD_KEY.
+ * Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed profile table, fixed histograms
+ * - Principle V (Network Debugging): per-profile round trip and time in profile
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef WIFI_POWER_PROFILE_H
+#define WIFI_POWER_PROFILE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "ConfigRecord.h"
+#include "JsonWriter.h"
+#include "LatencyHistogram.h"
+#include "../config.h"
+
+#define WIFI_PROFILE_RECORD_KEY "wifi_prof"
+#define WIFI_PROFILE_RECORD_SCHEMA 1
+
+/**
+ * @brief Radio power save mode (esp_wifi_set_ps)
+ */
+enum class WiFiPowerSave : uint8_t {
+    NONE = 0,       ///< Radio always on: lowest latency
+    MIN_MODEM,      ///< Wake every DTIM beacon (Arduino default)
+    MAX_MODEM       ///< Wake every listen interval: lowest current
+};
+
+/// Profiles: identifier, name, power save, TX power (0.25 dBm), /boatdata default ms, fastest ms, UDP ms,
+/// calculation and navigation minimum interval ms
+#define WIFI_PROFILE_LIST(X) \
+    X(RACING, "racing", WiFiPowerSave::NONE, WIFI_PROFILE_RACING_TX_QDBM, 200, 200, 200, \
+      CALC_MIN_INTERVAL_MS, NAV_MIN_INTERVAL_MS) \
+    X(BALANCED, "balanced", WiFiPowerSave::MIN_MODEM, WIFI_PROFILE_BALANCED_TX_QDBM, \
+      BOATDATA_BROADCAST_INTERVAL_MS, 200, BOATDATA_UDP_INTERVAL_MS, CALC_MIN_INTERVAL_MS, NAV_MIN_INTERVAL_MS) \
+    X(ANCHOR, "anchor", WiFiPowerSave::MAX_MODEM, WIFI_PROFILE_ANCHOR_TX_QDBM, \
+      WIFI_PROFILE_ANCHOR_INTERVAL_MS, WIFI_PROFILE_ANCHOR_INTERVAL_MS, WIFI_PROFILE_ANCHOR_INTERVAL_MS, \
+      WIFI_PROFILE_ANCHOR_CALC_MS, WIFI_PROFILE_ANCHOR_NAV_MS)
+
+/**
+ * @brief Profile identifiers (values of WIFI_PROFILE_DEFAULT)
+ */
+enum class WiFiProfile : uint8_t {
+#define WIFI_PROFILE_ENUM(id, name, ps, tx, broadcast, fastest, udp, calc, nav) id,
+    WIFI_PROFILE_LIST(WIFI_PROFILE_ENUM)
+#undef WIFI_PROFILE_ENUM
+    COUNT
+};
+
+/**
+ * @brief Settings of one profile
+ */
+struct WiFiPowerProfile {
+    const char* name;
+    WiFiPowerSave powerSave;
+    uint8_t txQuarterDbm;       ///< TX power in 0.25 dBm (wifi_power_t)
+    uint32_t broadcastMs;       ///< /boatdata default interval (governor start)
+    uint32_t fastestMs;         ///< Fastest default interval the governor may reach
+    uint32_t udpMs;             ///< UDP publish interval
+    uint32_t calcMinMs;         ///< Calculation cycle minimum interval (subscription coalescing)
+    uint32_t navMinMs;          ///< Navigation stage minimum interval
+};
+
+/**
+ * @class WiFiProfileSelector
+ * @brief Active profile, pending request and round-trip statistics
+ *
+ * @note request() and pongReceived() run on the async_tcp task, everything
+ *       else in the main loop. Readers may see a time or count lag by one update.
+ */
+class WiFiProfileSelector {
+public:
+    static constexpr uint8_t PROFILE_COUNT = static_cast<uint8_t>(WiFiProfile::COUNT);
+
+    /// Starts at WIFI_PROFILE_DEFAULT
+    WiFiProfileSelector();
+
+    /// Settings of @p id (the default profile when out of range)
+    static const WiFiPowerProfile& profile(WiFiProfile id);
+
+    /**
+     * @brief Profile named @p name ("racing", "balanced", "anchor")
+     * @return false if no profile has that name
+     */
+    static bool fromName(const char* name, WiFiProfile& out);
+
+    /// "none", "min_modem" or "max_modem"
+    static const char* powerSaveName(WiFiPowerSave mode);
+
+    /// Ask the main loop to switch to @p id (HTTP handler; the last request wins)
+    void request(WiFiProfile id);
+
+    /**
+     * @brief Take the pending request (main loop)
+     * @return true if one was pending
+     */
+    bool takeRequest(WiFiProfile& out);
+
+    /// Request not taken yet (COUNT = none)
+    WiFiProfile getPending() const;
+
+    /**
+     * @brief Make @p id the active profile; time so far is booked to the previous one
+     * @return false if @p id is out of range
+     */
+    bool select(WiFiProfile id, uint32_t nowMs);
+
+    WiFiProfile getActive() const { return static_cast<WiFiProfile>(active_.load(std::memory_order_relaxed)); }
+    const WiFiPowerProfile& getActiveProfile() const { return profile(getActive()); }
+
+    /// Switches since boot (restoring the stored profile is not one)
+    uint32_t getChanges() const { return changes_; }
+
+    /// Milliseconds @p id has been active since boot
+    uint32_t getActiveMs(WiFiProfile id, uint32_t nowMs) const;
+
+    /// A ping went to the /boatdata clients (main loop)
+    void pingSent(uint32_t nowUs);
+
+    /**
+     * @brief A client answered the last ping (async_tcp task)
+     *
+     * Recorded for the profile active when the ping was sent; a pong without
+     * a ping, or later than WIFI_PROFILE_PING_INTERVAL_MS, is ignored.
+     */
+    void pongReceived(uint32_t nowUs);
+
+    /// Ping round trips while @p id was active
+    const LatencyHistogram& getRoundTrip(WiFiProfile id) const;
+
+    /// Record with the active profile's name
+    size_t encodeRecord(uint8_t* out, size_t size) const;
+
+    /**
+     * @brief Restore the active profile from a stored record
+     * @return OK, or the record status (an unknown name is TRUNCATED); the profile is unchanged unless OK
+     */
+    ConfigRecordStatus decodeRecord(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Write the selection and the per-profile statistics as a JSON object
+     *
+     * {"active":"balanced","pending":null,"changes":1,"power_save":"min_modem","tx_power_dbm":17.00,
+     *  "broadcast_ms":1000,"fastest_ms":200,"udp_ms":200,
+     *  "profiles":{"racing":{"active_s":95,"rtt":{"count":40,"avg_us":3100,"p50_us":3072,"p99_us":8192,"max_us":7900}},...}}
+     */
+    void writeJson(JsonWriter& json, uint32_t nowMs, const char* key = nullptr) const;
+
+private:
+    static constexpr uint8_t NO_REQUEST = PROFILE_COUNT;
+
+    std::atomic<uint8_t> active_;
+    std::atomic<uint8_t> pending_;          ///< NO_REQUEST or a profile
+    std::atomic<uint8_t> pingProfile_;      ///< Profile active at the last ping
+    std::atomic<uint32_t> pingSentUs_;      ///< 0 = no ping outstanding
+    uint32_t changes_;
+    uint32_t sinceMs_;                      ///< When the active profile was selected
+    uint32_t activeMs_[PROFILE_COUNT];      ///< Completed time per profile
+    LatencyHistogram roundTrip_[PROFILE_COUNT];
+};
+
+#endif // WIFI_POWER_PROFILE_H
@@ -0,0 +1,129 @@
+/**
+ * @file WriteBehind.cpp
+ * @brief Implementation of the debounced write-behind persistence
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "WriteBehind.h"
+
+WriteBehind::WriteBehind(uint32_t quietMs, uint32_t maxDelayMs)
+    : count_(0), quietMs_(quietMs), maxDelayMs_(maxDelayMs), lastFailed_("") {
+}
+
+int8_t WriteBehind::add(const char* name, WriteBehindSave save, void* context) {
+    if (save == nullptr || count_ >= WRITE_BEHIND_MAX_ENTRIES) {
+        return -1;
+    }
+    WriteBehindEntry& entry = entries_[count_];
+    entry.name = name;
+    entry.save = save;
+    entry.context = context;
+    entry.dirty.store(false, std::memory_order_relaxed);
+    entry.firstDirtyMs.store(0, std::memory_order_relaxed);
+    entry.lastDirtyMs.store(0, std::memory_order_relaxed);
+    entry.changes.store(0, std::memory_order_relaxed);
+    entry.writes = 0;
+    entry.failures = 0;
+    return static_cast<int8_t>(count_++);
+}
+
+void WriteBehind::markDirty(int8_t id, uint32_t nowMs) {
+    if (id < 0 || id >= count_) {
+        return;
+    }
+    WriteBehindEntry& entry = entries_[id];
+    entry.lastDirtyMs.store(nowMs, std::memory_order_relaxed);
+    if (!entry.dirty.load(std::memory_order_acquire)) {
+        entry.firstDirtyMs.store(nowMs, std::memory_order_relaxed);
+    }
+    entry.changes.fetch_add(1, std::memory_order_relaxed);
+    entry.dirty.store(true, std::memory_order_release);  // Times first: poll() sees them with the flag
+}
+
+bool WriteBehind::isDirty(int8_t id) const {
+    return id >= 0 && id < count_ && entries_[id].dirty.load(std::memory_order_acquire);
+}
+
+bool WriteBehind::due(const WriteBehindEntry& entry, uint32_t nowMs) const {
+    return nowMs - entry.lastDirtyMs.load(std::memory_order_relaxed) >= quietMs_ ||
+           nowMs - entry.firstDirtyMs.load(std::memory_order_relaxed) >= maxDelayMs_;
+}
+
+bool WriteBehind::save(WriteBehindEntry& entry, uint32_t nowMs) {
+    // Cleared first: a change made while saving marks the entry again
+    entry.dirty.store(false, std::memory_order_release);
+    if (entry.save(entry.context)) {
+        entry.writes++;
+        return true;
+    }
+    entry.failures++;
+    lastFailed_ = entry.name;
+    if (!entry.dirty.load(std::memory_order_acquire)) {
+        entry.firstDirtyMs.store(nowMs, std::memory_order_relaxed);
+        entry.lastDirtyMs.store(nowMs, std::memory_order_relaxed);  // Retry after another quiet period
+        entry.dirty.store(true, std::memory_order_release);
+    }
+    return false;
+}
+
+bool WriteBehind::poll(uint32_t nowMs) {
+    for (uint8_t i = 0; i < count_; i++) {
+        WriteBehindEntry& entry = entries_[i];
+        if (entry.dirty.load(std::memory_order_acquire) && due(entry, nowMs)) {
+            return save(entry, nowMs);  // One save per poll
+        }
+    }
+    return true;
+}
+
+uint8_t WriteBehind::flush(uint32_t nowMs) {
+    uint8_t failed = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        WriteBehindEntry& entry = entries_[i];
+        if (entry.dirty.load(std::memory_order_acquire) && !save(entry, nowMs)) {
+            failed++;
+        }
+    }
+    return failed;
+}
+
+uint8_t WriteBehind::getPending() const {
+    uint8_t pending = 0;
+    for (uint8_t i = 0; i < count_; i++) {
+        pending += entries_[i].dirty.load(std::memory_order_relaxed) ? 1 : 0;
+    }
+    return pending;
+}
+
+const WriteBehindEntry* WriteBehind::at(uint8_t id) const {
+    return id < count_ ? &entries_[id] : nullptr;
+}
+
+void WriteBehind::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("pending", (unsigned int)getPending());
+    json.beginArray("entries");
+    for (uint8_t i = 0; i < count_; i++) {
+        const WriteBehindEntry& entry = entries_[i];
+        json.beginObject()
+            .add("name", entry.name)
+            .add("dirty", entry.dirty.load(std::memory_order_relaxed))
+            .add("changes", (unsigned long)entry.changes.load(std::memory_order_relaxed))
+            .add("writes", (unsigned long)entry.writes)
+            .add("failures", (unsigned long)entry.failures)
+            .endObject();
+    }
+    json.endArray();
+    json.endObject();
+}
+
+WriteBehind& GetWriteBehind() {
+    static WriteBehind writeBehind;
+    return writeBehind;
+}
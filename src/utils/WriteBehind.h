@@ -0,0 +1,138 @@
+/**
+ * @file WriteBehind.h
+ * @brief Debounced write-behind persistence of small configuration files
+ *
+ * Configuration setters do not write flash themselves: a LittleFS write can
+ * block for tens of milliseconds during an erase, and one request often
+ * changes several settings in a row (/log-filter with level, components
+ * and events). Each persisted object registers a save function once and
+ * markDirty()s its entry on every change. poll(), called from one
+ * background reaction, writes an entry once no change arrived for
+ * WRITE_BEHIND_QUIET_MS, or at the latest WRITE_BEHIND_MAX_DELAY_MS after
+ * its first unsaved change, so a burst costs a single write.
+ *
+ * - markDirty(): any task (HTTP handlers run on async_tcp)
+ * - poll()/flush(): main loop only; at most one save per poll() keeps the
+ *   reaction short. flush() saves everything pending before a restart.
+ *
+ * The dirty flag is cleared before the save runs, so a change that races
+ * the save marks the entry again and is written on a later poll(). A failed
+ * save is counted and retried after another quiet period.
+ *
+ * Save functions write through AtomicFileWriter (temp file + rename), so
+ * a reset during the write leaves the previous file intact.
+ *
+ * Arduino-free (the save functions are injected, unit tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * int8_t id = GetWriteBehind().add("log_filter", [](void* ctx) {
+ *     return static_cast<WebSocketLogger*>(ctx)->saveFilter();
+ * }, &logger);
+ * GetWriteBehind().markDirty(id, millis());                      // in each setter
+ * app.onRepeat(WRITE_BEHIND_INTERVAL_MS, []() { GetWriteBehind().poll(millis()); });
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): fixed entry table, no heap; fewer flash erase cycles
+ * - Principle VII (Fail-Safe): failed saves are retried, a reset never leaves a half-written file
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef WRITE_BEHIND_H
+#define WRITE_BEHIND_H
+
+#include <stdint.h>
+#include <atomic>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/// Write the object to flash; returns false on a filesystem error
+typedef bool (*WriteBehindSave)(void* context);
+
+/**
+ * @brief Registration and counters of one persisted object
+ */
+struct WriteBehindEntry {
+    const char* name;               ///< Static string (not copied)
+    WriteBehindSave save;
+    void* context;
+    std::atomic<bool> dirty;
+    std::atomic<uint32_t> firstDirtyMs;  ///< First change not written yet
+    std::atomic<uint32_t> lastDirtyMs;   ///< Latest change
+    std::atomic<uint32_t> changes;       ///< markDirty() calls
+    uint32_t writes;                ///< Successful saves
+    uint32_t failures;              ///< Saves that returned false
+};
+
+/**
+ * @class WriteBehind
+ * @brief Coalesces configuration changes into one deferred save per object
+ */
+class WriteBehind {
+public:
+    WriteBehind(uint32_t quietMs = WRITE_BEHIND_QUIET_MS, uint32_t maxDelayMs = WRITE_BEHIND_MAX_DELAY_MS);
+
+    /**
+     * @brief Register a persisted object (setup only)
+     *
+     * @param name Static label (GET /status, log events)
+     * @return Entry ID, or -1 if the table is full (WRITE_BEHIND_MAX_ENTRIES)
+     */
+    int8_t add(const char* name, WriteBehindSave save, void* context);
+
+    /// Entry @p id changed at @p nowMs (any task; ignored for an invalid ID)
+    void markDirty(int8_t id, uint32_t nowMs);
+
+    /// Entry @p id has a change not written yet
+    bool isDirty(int8_t id) const;
+
+    /**
+     * @brief Save the first entry that is due
+     *
+     * @return false if that save failed (getLastFailed() names it)
+     */
+    bool poll(uint32_t nowMs);
+
+    /**
+     * @brief Save every dirty entry now (before a restart)
+     * @return Saves that failed
+     */
+    uint8_t flush(uint32_t nowMs);
+
+    /// Entries with unsaved changes
+    uint8_t getPending() const;
+
+    uint8_t count() const { return count_; }
+
+    /// Entry @p id (nullptr if out of range)
+    const WriteBehindEntry* at(uint8_t id) const;
+
+    /// Name of the entry whose save failed last ("" = none yet)
+    const char* getLastFailed() const { return lastFailed_; }
+
+    /**
+     * @brief Write the entries as a JSON object
+     *
+     * {"pending":0,"entries":[{"name":"log_filter","dirty":false,"changes":3,"writes":1,"failures":0},...]}
+     * With @p key the object is a member of the enclosing one (GET /status).
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    bool due(const WriteBehindEntry& entry, uint32_t nowMs) const;
+    bool save(WriteBehindEntry& entry, uint32_t nowMs);
+
+    WriteBehindEntry entries_[WRITE_BEHIND_MAX_ENTRIES];
+    uint8_t count_;
+    uint32_t quietMs_;
+    uint32_t maxDelayMs_;
+    const char* lastFailed_;
+};
+
+/// Configuration files of the firmware (log filter, calibration)
+WriteBehind& GetWriteBehind();
+
+#endif // WRITE_BEHIND_H
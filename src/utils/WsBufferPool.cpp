@@ -0,0 +1,158 @@
+/**
+ * @file WsBufferPool.cpp
+ * @brief Implementation of the WebSocket send buffer pool
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "WsBufferPool.h"
+
+constexpr size_t WsBufferPool::MAX_BYTES;
+constexpr uint8_t WsBufferPool::TOTAL_BUFFERS;
+
+namespace {
+const uint8_t CLASS_BUFFERS[WsBufferPool::CLASS_COUNT] = {
+    WS_POOL_SMALL_BUFFERS, WS_POOL_MEDIUM_BUFFERS, WS_POOL_LARGE_BUFFERS};
+const size_t CLASS_BYTES[WsBufferPool::CLASS_COUNT] = {256, 1024, WsBufferPool::MAX_BYTES};
+}
+
+WsBufferPool::WsBufferPool() : dropped_(0), ready_(false) {
+    for (uint8_t i = 0; i < TOTAL_BUFFERS; i++) {
+        claimed_[i].store(false, std::memory_order_relaxed);
+    }
+    for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+        exhausted_[c].store(0, std::memory_order_relaxed);
+        peakInUse_[c].store(0, std::memory_order_relaxed);
+    }
+}
+
+bool WsBufferPool::begin() {
+    bool ok = true;
+    for (uint8_t slot = 0; slot < TOTAL_BUFFERS; slot++) {
+        if (!slots_[slot]) {
+            slots_[slot] = std::make_shared<std::vector<uint8_t>>();
+            slots_[slot]->reserve(classBytes(classOf(slot)));
+        }
+        ok = ok && slots_[slot]->capacity() >= classBytes(classOf(slot));
+    }
+    ready_ = true;
+    return ok;
+}
+
+size_t WsBufferPool::classBytes(uint8_t sizeClass) {
+    return sizeClass < CLASS_COUNT ? CLASS_BYTES[sizeClass] : 0;
+}
+
+uint8_t WsBufferPool::classOf(uint8_t slot) {
+    uint8_t sizeClass = 0;
+    while (sizeClass + 1 < CLASS_COUNT && slot >= firstSlot(sizeClass + 1)) {
+        sizeClass++;
+    }
+    return sizeClass;
+}
+
+uint8_t WsBufferPool::firstSlot(uint8_t sizeClass) {
+    uint8_t slot = 0;
+    for (uint8_t c = 0; c < sizeClass && c < CLASS_COUNT; c++) {
+        slot += CLASS_BUFFERS[c];
+    }
+    return slot;
+}
+
+bool WsBufferPool::isFree(uint8_t slot) const {
+    // A client queue still holding the buffer keeps the count above one
+    return slots_[slot] && slots_[slot].use_count() == 1;
+}
+
+WsBufferPool::Buffer WsBufferPool::acquire(size_t size) {
+    if (size > MAX_BYTES) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+
+    uint8_t sizeClass = 0;
+    while (CLASS_BYTES[sizeClass] < size) {
+        sizeClass++;
+    }
+    for (; sizeClass < CLASS_COUNT; sizeClass++) {
+        uint8_t first = firstSlot(sizeClass);
+        for (uint8_t slot = first; slot < first + CLASS_BUFFERS[sizeClass]; slot++) {
+            bool expected = false;
+            if (!isFree(slot) ||
+                !claimed_[slot].compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                continue;
+            }
+            if (!isFree(slot)) {
+                claimed_[slot].store(false, std::memory_order_release);  // Taken by another task meanwhile
+                continue;
+            }
+            // The last sender's reads of the old frame happen before our writes
+            std::atomic_thread_fence(std::memory_order_acquire);
+            Buffer buffer = slots_[slot];
+            claimed_[slot].store(false, std::memory_order_release);
+            buffer->resize(size);
+
+            uint8_t inUse = getInUse(sizeClass);
+            uint8_t peak = peakInUse_[sizeClass].load(std::memory_order_relaxed);
+            while (inUse > peak && !peakInUse_[sizeClass].compare_exchange_weak(peak, inUse, std::memory_order_relaxed)) {
+            }
+            return buffer;
+        }
+        exhausted_[sizeClass].fetch_add(1, std::memory_order_relaxed);
+    }
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return nullptr;
+}
+
+uint8_t WsBufferPool::getBufferCount(uint8_t sizeClass) const {
+    return sizeClass < CLASS_COUNT ? CLASS_BUFFERS[sizeClass] : 0;
+}
+
+uint8_t WsBufferPool::getInUse(uint8_t sizeClass) const {
+    if (sizeClass >= CLASS_COUNT) {
+        return 0;
+    }
+    uint8_t inUse = 0;
+    uint8_t first = firstSlot(sizeClass);
+    for (uint8_t slot = first; slot < first + CLASS_BUFFERS[sizeClass]; slot++) {
+        if (slots_[slot] && !isFree(slot)) {
+            inUse++;
+        }
+    }
+    return inUse;
+}
+
+uint8_t WsBufferPool::getPeakInUse(uint8_t sizeClass) const {
+    return sizeClass < CLASS_COUNT ? peakInUse_[sizeClass].load(std::memory_order_relaxed) : 0;
+}
+
+uint32_t WsBufferPool::getExhausted(uint8_t sizeClass) const {
+    return sizeClass < CLASS_COUNT ? exhausted_[sizeClass].load(std::memory_order_relaxed) : 0;
+}
+
+void WsBufferPool::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.beginArray("classes");
+    for (uint8_t c = 0; c < CLASS_COUNT; c++) {
+        json.beginObject()
+            .add("bytes", (unsigned long)classBytes(c))
+            .add("buffers", (unsigned int)getBufferCount(c))
+            .add("in_use", (unsigned int)getInUse(c))
+            .add("peak_in_use", (unsigned int)getPeakInUse(c))
+            .add("exhausted", (unsigned long)getExhausted(c))
+            .endObject();
+    }
+    json.endArray()
+        .add("dropped", (unsigned long)getDropped())
+        .endObject();
+}
+
+WsBufferPool& GetWsBufferPool() {
+    static WsBufferPool pool;
+    return pool;
+}
@@ -0,0 +1,117 @@
+/**
+ * @file WsBufferPool.h
+ * @brief Preallocated WebSocket send buffers in three size classes
+ *
+ * AsyncWebSocket queues a message by reference to a shared buffer
+ * (AsyncWebSocketSharedBuffer, a shared_ptr to a byte vector); every
+ * textAll(const char*, len) call allocates a new one. The pool allocates
+ * WS_POOL_*_BUFFERS buffers of 256 B, 1 KB and 4 KB once at boot and
+ * hands them out instead: a buffer is free again once every client queue
+ * holding it has sent it (the pool holds the only reference left).
+ *
+ * acquire() takes the smallest free buffer that fits, moving up a class
+ * when one is exhausted; with none left it returns nullptr and the frame
+ * is dropped (counted). The WebSocketLogger and the /boatdata and Signal K
+ * broadcasters send from it. Arduino-free (unit tested natively).
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): no heap allocation per frame, no fragmentation
+ * - Principle VII (Fail-Safe): exhaustion drops a frame instead of failing an allocation
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef WS_BUFFER_POOL_H
+#define WS_BUFFER_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @class WsBufferPool
+ * @brief Fixed set of reference-counted send buffers
+ *
+ * Usage pattern:
+ * @code
+ * WsBufferPool::Buffer frame = GetWsBufferPool().acquire(len);
+ * if (frame) {
+ *     memcpy(frame->data(), text, len);
+ *     ws->textAll(frame);   // Back in the pool once every client sent it
+ * }
+ * @endcode
+ */
+class WsBufferPool {
+public:
+    /// Same type as AsyncWebSocketSharedBuffer
+    using Buffer = std::shared_ptr<std::vector<uint8_t>>;
+
+    enum SizeClass : uint8_t { SMALL = 0, MEDIUM, LARGE, CLASS_COUNT };
+
+    static constexpr size_t MAX_BYTES = 4096;  ///< Largest buffer (LARGE)
+    static constexpr uint8_t TOTAL_BUFFERS = WS_POOL_SMALL_BUFFERS + WS_POOL_MEDIUM_BUFFERS + WS_POOL_LARGE_BUFFERS;
+
+    WsBufferPool();
+
+    /**
+     * @brief Allocate every buffer (once, early in setup while the heap is unfragmented)
+     * @return false if an allocation failed (the buffers allocated so far stay usable)
+     */
+    bool begin();
+
+    /// begin() was called
+    bool isReady() const { return ready_; }
+
+    /**
+     * @brief A free buffer of at least @p size bytes, resized to @p size
+     *
+     * Safe from any task. Do not grow the buffer beyond @p size (it would
+     * reallocate); shrinking it with resize() is fine.
+     *
+     * @return nullptr when @p size exceeds MAX_BYTES or every fitting buffer is in use (counted as a drop)
+     */
+    Buffer acquire(size_t size);
+
+    /// Buffer size of @p sizeClass (256, 1024, 4096)
+    static size_t classBytes(uint8_t sizeClass);
+
+    uint8_t getBufferCount(uint8_t sizeClass) const;
+    uint8_t getInUse(uint8_t sizeClass) const;
+    uint8_t getPeakInUse(uint8_t sizeClass) const;
+
+    /// Requests that found @p sizeClass exhausted (served by a larger class or dropped)
+    uint32_t getExhausted(uint8_t sizeClass) const;
+
+    /// Requests with no buffer: all fitting classes in use, or larger than MAX_BYTES
+    uint32_t getDropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Write the pool state as a JSON object
+     *
+     * {"classes":[{"bytes":256,"buffers":8,"in_use":1,"peak_in_use":3,"exhausted":0},...],"dropped":0}
+     * With @p key the object is a member of the enclosing one (GET /status).
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    static uint8_t classOf(uint8_t slot);
+    static uint8_t firstSlot(uint8_t sizeClass);
+    bool isFree(uint8_t slot) const;
+
+    Buffer slots_[TOTAL_BUFFERS];
+    std::atomic<bool> claimed_[TOTAL_BUFFERS];  ///< Held while a buffer is being handed out
+    std::atomic<uint32_t> exhausted_[CLASS_COUNT];
+    std::atomic<uint8_t> peakInUse_[CLASS_COUNT];
+    std::atomic<uint32_t> dropped_;
+    bool ready_;
+};
+
+/// The send buffers shared by every WebSocket endpoint
+WsBufferPool& GetWsBufferPool();
+
+#endif // WS_BUFFER_POOL_H
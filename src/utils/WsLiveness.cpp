@@ -0,0 +1,128 @@
+/**
+ * @file WsLiveness.cpp
+ * @brief Implementation of the WebSocket client liveness table
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include "WsLiveness.h"
+
+namespace {
+
+constexpr uint32_t SILENT_LIMIT_MS = static_cast<uint32_t>(WS_PING_INTERVAL_MS) * WS_PING_MAX_MISSED;
+
+}  // namespace
+
+WsLiveness::WsLiveness() : evicted_(0), aborted_(0) {
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        slots_[i].id.store(0, std::memory_order_relaxed);
+        slots_[i].endpoint.store(0, std::memory_order_relaxed);
+        slots_[i].lastSeenMs.store(0, std::memory_order_relaxed);
+        slots_[i].closing = false;
+        slots_[i].closedMs = 0;
+    }
+}
+
+WsLiveness::Slot* WsLiveness::find(AdmissionEndpoint endpoint, uint32_t id) {
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        if (slots_[i].id.load(std::memory_order_acquire) == id &&
+            slots_[i].endpoint.load(std::memory_order_relaxed) == static_cast<uint8_t>(endpoint)) {
+            return &slots_[i];
+        }
+    }
+    return nullptr;
+}
+
+bool WsLiveness::add(AdmissionEndpoint endpoint, uint32_t id, uint32_t nowMs) {
+    if (id == 0) {
+        return false;
+    }
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        Slot& slot = slots_[i];
+        if (slot.id.load(std::memory_order_relaxed) != 0) {
+            continue;
+        }
+        slot.endpoint.store(static_cast<uint8_t>(endpoint), std::memory_order_relaxed);
+        slot.lastSeenMs.store(nowMs, std::memory_order_relaxed);
+        slot.closing = false;
+        slot.id.store(id, std::memory_order_release);  // Published last: check() sees a complete slot
+        return true;
+    }
+    return false;
+}
+
+void WsLiveness::remove(AdmissionEndpoint endpoint, uint32_t id) {
+    Slot* slot = find(endpoint, id);
+    if (slot != nullptr) {
+        slot->id.store(0, std::memory_order_release);
+    }
+}
+
+void WsLiveness::seen(AdmissionEndpoint endpoint, uint32_t id, uint32_t nowMs) {
+    Slot* slot = find(endpoint, id);
+    if (slot != nullptr) {
+        slot->lastSeenMs.store(nowMs, std::memory_order_relaxed);
+    }
+}
+
+uint8_t WsLiveness::check(uint32_t nowMs, WsLivenessVerdict* out, uint8_t maxOut) {
+    uint8_t n = 0;
+    for (uint8_t i = 0; i < SLOTS && n < maxOut; i++) {
+        Slot& slot = slots_[i];
+        uint32_t id = slot.id.load(std::memory_order_acquire);
+        if (id == 0) {
+            continue;
+        }
+        uint32_t silent = nowMs - slot.lastSeenMs.load(std::memory_order_relaxed);
+        if (silent < SILENT_LIMIT_MS) {
+            slot.closing = false;  // Answered after all (a late pong or data)
+            continue;
+        }
+
+        WsLivenessVerdict& verdict = out[n++];
+        verdict.endpoint = static_cast<AdmissionEndpoint>(slot.endpoint.load(std::memory_order_relaxed));
+        verdict.id = id;
+        verdict.silentMs = silent;
+        if (!slot.closing) {
+            verdict.action = WsLivenessAction::CLOSE;
+            slot.closing = true;
+            slot.closedMs = nowMs;
+            evicted_++;
+        } else if (nowMs - slot.closedMs >= WS_PING_INTERVAL_MS) {
+            verdict.action = WsLivenessAction::ABORT;
+            slot.id.store(0, std::memory_order_release);  // The disconnect event finds nothing to remove
+            aborted_++;
+        } else {
+            n--;  // Close sent, the handshake still has time
+        }
+    }
+    return n;
+}
+
+uint8_t WsLiveness::getCount() const {
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < SLOTS; i++) {
+        count += slots_[i].id.load(std::memory_order_relaxed) != 0 ? 1 : 0;
+    }
+    return count;
+}
+
+void WsLiveness::writeJson(JsonWriter& json, const char* key) const {
+    if (key != nullptr) {
+        json.beginObject(key);
+    } else {
+        json.beginObject();
+    }
+    json.add("interval_ms", (unsigned long)WS_PING_INTERVAL_MS)
+        .add("max_missed", (unsigned long)WS_PING_MAX_MISSED)
+        .add("watched", (unsigned long)getCount())
+        .add("evicted", (unsigned long)evicted_)
+        .add("aborted", (unsigned long)aborted_)
+        .endObject();
+}
+
+WsLiveness& GetWsLiveness() {
+    static WsLiveness wsLiveness;
+    return wsLiveness;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file WsLiveness.h
+ * @brief WebSocket client liveness: ping every client, evict the ones that stop answering
+ *
+ * A phone that goes to sleep with the dashboard open does not close its
+ * WebSocket; the connection stays in ws->count() until TCP gives up minutes
+ * later. Meanwhile the /boatdata broadcast keeps serializing for it and
+ * WebSocketLogger keeps formatting logs, because their "anyone listening?"
+ * early exits see a client.
+ *
+ * Every WS_PING_INTERVAL_MS the main loop pings the clients of /boatdata,
+ * /signalk/v1/stream and /logs. Any frame from a client (pong or data)
+ * marks it seen. check() then reports each client that has stayed silent
+ * for WS_PING_MAX_MISSED intervals:
+ *
+ * - CLOSE: the first time; the caller sends a close frame (1001) and logs
+ *   CLIENT_EVICTED
+ * - ABORT: still registered an interval later (a sleeping peer never
+ *   answers the close handshake); the slot is freed and the caller aborts
+ *   the TCP connection
+ *
+ * Clients are keyed by endpoint and client ID (IDs are per AsyncWebSocket).
+ * add(), remove() and seen() run on the async_tcp task, check() on the main
+ * loop; the ID and the last-seen time are atomics. Arduino-free (unit
+ * tested natively).
+ *
+ * Usage pattern:
+ * @code
+ * // WS_EVT_CONNECT: GetWsLiveness().add(AdmissionEndpoint::LOGS, client->id(), millis());
+ * // WS_EVT_PONG / WS_EVT_DATA: GetWsLiveness().seen(AdmissionEndpoint::LOGS, client->id(), millis());
+ * // WS_EVT_DISCONNECT: GetWsLiveness().remove(AdmissionEndpoint::LOGS, client->id());
+ * WsLivenessVerdict verdicts[WsLiveness::SLOTS];
+ * uint8_t n = GetWsLiveness().check(millis(), verdicts, WsLiveness::SLOTS);
+ * ws.pingAll();
+ * @endcode
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): no serialization or log formatting for dead clients
+ * - Principle VII (Fail-Safe Operation): stale connections are released in seconds, not minutes
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef WS_LIVENESS_H
+#define WS_LIVENESS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <atomic>
+#include "AdmissionController.h"
+#include "JsonWriter.h"
+#include "../config.h"
+
+/**
+ * @brief What to do with a silent client
+ */
+enum class WsLivenessAction : uint8_t {
+    CLOSE = 0,   ///< Missed WS_PING_MAX_MISSED pings: send a close frame
+    ABORT        ///< Still there an interval after the close: drop the TCP connection
+};
+
+/**
+ * @brief One client reported by check()
+ */
+struct WsLivenessVerdict {
+    AdmissionEndpoint endpoint;
+    uint32_t id;
+    WsLivenessAction action;
+    uint32_t silentMs;   ///< Since the last frame from the client
+};
+
+/**
+ * @class WsLiveness
+ * @brief Last-seen times of the WebSocket clients of every endpoint
+ */
+class WsLiveness {
+public:
+    static constexpr uint8_t SLOTS = ADMISSION_MAX_CLIENTS;
+
+    WsLiveness();
+
+    /**
+     * @brief Track client @p id of @p endpoint, seen now (WS_EVT_CONNECT)
+     * @return false if every slot is in use (the client is not watched)
+     */
+    bool add(AdmissionEndpoint endpoint, uint32_t id, uint32_t nowMs);
+
+    /// Stop tracking the client (WS_EVT_DISCONNECT; no-op if unknown)
+    void remove(AdmissionEndpoint endpoint, uint32_t id);
+
+    /// A frame arrived from the client (WS_EVT_PONG, WS_EVT_DATA)
+    void seen(AdmissionEndpoint endpoint, uint32_t id, uint32_t nowMs);
+
+    /**
+     * @brief Find the clients to close or abort (main loop, before the pings)
+     * @param out Verdicts, at most @p maxOut
+     * @return Number of verdicts written
+     */
+    uint8_t check(uint32_t nowMs, WsLivenessVerdict* out, uint8_t maxOut);
+
+    /// Clients being watched
+    uint8_t getCount() const;
+
+    /// Clients closed for missing pings since boot
+    uint32_t getEvicted() const { return evicted_; }
+
+    /// Of those, connections aborted because the close was not answered
+    uint32_t getAborted() const { return aborted_; }
+
+    /**
+     * @brief Write the counters as a JSON object (GET /web/stats)
+     *
+     * {"interval_ms":10000,"max_missed":3,"watched":2,"evicted":5,"aborted":4}
+     * With @p key the object is a member of the enclosing one.
+     */
+    void writeJson(JsonWriter& json, const char* key = nullptr) const;
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> id;           ///< 0 = free (AsyncWebSocket IDs start at 1)
+        std::atomic<uint8_t> endpoint;
+        std::atomic<uint32_t> lastSeenMs;
+        bool closing;                       ///< Main loop only: close sent at closedMs
+        uint32_t closedMs;
+    };
+
+    Slot slots_[SLOTS];
+    uint32_t evicted_;
+    uint32_t aborted_;
+
+    Slot* find(AdmissionEndpoint endpoint, uint32_t id);
+};
+
+/// Process-wide liveness table
+WsLiveness& GetWsLiveness();
+
+#endif // WS_LIVENESS_H
@@ -0,0 +1,62 @@
+#ifndef ALLOC_HOOKS_H
+#define ALLOC_HOOKS_H
+
+/**
+ * @file alloc_hooks.h
+ * @brief Host allocator hooks feeding AllocTracker
+ *
+ * Replaces the global operator new/delete so every allocation of a native
+ * test lands in GetAllocTracker(), the way the heap hooks do on the device.
+ * Lets a test assert that a hot path does not allocate:
+ *
+ * @code
+ * GetAllocTracker().reset();
+ * {
+ *     ALLOC_SCOPE("tokenize");
+ *     tokens.tokenize(sentence);
+ * }
+ * TEST_ASSERT_EQUAL_UINT32(0, GetAllocTracker().find("tokenize")->allocs);
+ * @endcode
+ *
+ * Include in exactly one translation unit of a test group (the replacement
+ * operators are definitions). Only C++ allocations are seen: code calling
+ * malloc() directly, or String in the Arduino stubs, is not counted.
+ */
+
+#include <cstdlib>
+#include <new>
+#include "../../src/utils/AllocTracker.h"
+
+void* operator new(std::size_t size) {
+    void* ptr = std::malloc(size > 0 ? size : 1);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    GetAllocTracker().recordAlloc(size);
+    return ptr;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept {
+    if (ptr != nullptr) {
+        GetAllocTracker().recordFree();
+        std::free(ptr);
+    }
+}
+
+void operator delete[](void* ptr) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept {
+    operator delete(ptr);
+}
+
+#endif // ALLOC_HOOKS_H
@@ -24,29 +24,29 @@
 /**
  * @brief Valid RSA (Rudder Sensor Angle) sentence from autopilot
  *
- * Sentence: $APRSA,15.0,A*3C
+ * Sentence: $APRSA,15.0,A*0A
  * - Talker ID: AP (autopilot)
  * - Rudder angle: 15.0° starboard
  * - Status: A (valid)
  * - Checksum: 3C (valid)
  */
-const char* VALID_APRSA = "$APRSA,15.0,A*3C\r\n";
+const char* VALID_APRSA = "$APRSA,15.0,A*0A\r\n";
 
 /**
  * @brief Valid HDM (Heading Magnetic) sentence from autopilot
  *
- * Sentence: $APHDM,045.5,M*2F
+ * Sentence: $APHDM,045.5,M*37
  * - Talker ID: AP (autopilot)
  * - Magnetic heading: 045.5° (45.5 degrees)
  * - Reference: M (magnetic)
  * - Checksum: 2F (valid)
  */
-const char* VALID_APHDM = "$APHDM,045.5,M*2F\r\n";
+const char* VALID_APHDM = "$APHDM,045.5,M*37\r\n";
 
 /**
  * @brief Valid GGA (GPS Fix Data) sentence from VHF radio
  *
- * Sentence: $VHGGA,123519,5230.5000,N,00507.0000,E,1,08,0.9,545.4,M,46.9,M,,*47
+ * Sentence: $VHGGA,123519,5230.5000,N,00507.0000,E,1,08,0.9,545.4,M,46.9,M,,*4F
  * - Talker ID: VH (VHF radio)
  * - Time: 12:35:19 UTC
  * - Latitude: 5230.5000 N (52°30.5' North = 52.508333°)
@@ -57,12 +57,12 @@ const char* VALID_APHDM = "$APHDM,045.5,M*2F\r\n";
  * - Altitude: 545.4 M
  * - Checksum: 47 (valid)
  */
-const char* VALID_VHGGA = "$VHGGA,123519,5230.5000,N,00507.0000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+const char* VALID_VHGGA = "$VHGGA,123519,5230.5000,N,00507.0000,E,1,08,0.9,545.4,M,46.9,M,,*4F\r\n";
 
 /**
  * @brief Valid RMC (Recommended Minimum Navigation) sentence from VHF radio
  *
- * Sentence: $VHRMC,123519,A,5230.5000,N,00507.0000,E,5.5,054.7,230394,003.1,W*6A
+ * Sentence: $VHRMC,123519,A,5230.5000,N,00507.0000,E,5.5,054.7,230394,003.1,W*68
  * - Talker ID: VH (VHF radio)
  * - Time: 12:35:19 UTC
  * - Status: A (valid)
@@ -74,12 +74,12 @@ const char* VALID_VHGGA = "$VHGGA,123519,5230.5000,N,00507.0000,E,1,08,0.9,545.4
  * - Variation: 003.1° W (3.1° West = -3.1°)
  * - Checksum: 6A (valid)
  */
-const char* VALID_VHRMC = "$VHRMC,123519,A,5230.5000,N,00507.0000,E,5.5,054.7,230394,003.1,W*6A\r\n";
+const char* VALID_VHRMC = "$VHRMC,123519,A,5230.5000,N,00507.0000,E,5.5,054.7,230394,003.1,W*68\r\n";
 
 /**
  * @brief Valid VTG (Track Made Good) sentence from VHF radio
  *
- * Sentence: $VHVTG,054.7,T,057.9,M,5.5,N,10.2,K*48
+ * Sentence: $VHVTG,054.7,T,057.9,M,5.5,N,10.2,K*79
  * - Talker ID: VH (VHF radio)
  * - True COG: 054.7° (54.7 degrees true)
  * - Reference: T (true)
@@ -90,7 +90,7 @@ const char* VALID_VHRMC = "$VHRMC,123519,A,5230.5000,N,00507.0000,E,5.5,054.7,23
  * - Calculated variation: 054.7 - 057.9 = -3.2° (3.2°W)
  * - Checksum: 48 (valid)
  */
-const char* VALID_VHVTG = "$VHVTG,054.7,T,057.9,M,5.5,N,10.2,K*48\r\n";
+const char* VALID_VHVTG = "$VHVTG,054.7,T,057.9,M,5.5,N,10.2,K*79\r\n";
 
 // ============================================================================
 // Invalid NMEA 0183 Sentences (For Error Testing)
@@ -99,7 +99,7 @@ const char* VALID_VHVTG = "$VHVTG,054.7,T,057.9,M,5.5,N,10.2,K*48\r\n";
 /**
  * @brief Invalid RSA sentence - bad checksum
  *
- * Sentence: $APRSA,15.0,A*FF (checksum should be *3C)
+ * Sentence: $APRSA,15.0,A*FF (checksum should be *0A)
  * - Expected behavior: Silent discard (FR-024)
  */
 const char* INVALID_APRSA_CHECKSUM = "$APRSA,15.0,A*FF\r\n";
@@ -110,7 +110,7 @@ const char* INVALID_APRSA_CHECKSUM = "$APRSA,15.0,A*FF\r\n";
  * Sentence: $APRSA,120.0,A*XX (120° exceeds ±90° limit)
  * - Expected behavior: Parser succeeds, handler rejects (FR-026)
  */
-const char* INVALID_APRSA_RANGE = "$APRSA,120.0,A*25\r\n";
+const char* INVALID_APRSA_RANGE = "$APRSA,120.0,A*3D\r\n";
 
 /**
  * @brief Invalid RSA sentence - wrong talker ID
@@ -118,7 +118,7 @@ const char* INVALID_APRSA_RANGE = "$APRSA,120.0,A*25\r\n";
  * Sentence: $VHRSA,15.0,A*XX (talker ID "VH" not "AP")
  * - Expected behavior: Parser returns false, silent ignore
  */
-const char* INVALID_APRSA_TALKER = "$VHRSA,15.0,A*07\r\n";
+const char* INVALID_APRSA_TALKER = "$VHRSA,15.0,A*05\r\n";
 
 /**
  * @brief Invalid RSA sentence - invalid status
@@ -126,7 +126,7 @@ const char* INVALID_APRSA_TALKER = "$VHRSA,15.0,A*07\r\n";
  * Sentence: $APRSA,15.0,V*XX (status 'V' = invalid)
  * - Expected behavior: Parser returns false, silent discard
  */
-const char* INVALID_APRSA_STATUS = "$APRSA,15.0,V*3E\r\n";
+const char* INVALID_APRSA_STATUS = "$APRSA,15.0,V*1D\r\n";
 
 /**
  * @brief Invalid GGA sentence - wrong talker ID
@@ -134,7 +134,7 @@ const char* INVALID_APRSA_STATUS = "$APRSA,15.0,V*3E\r\n";
  * Sentence: $GPGGA,... (talker ID "GP" not "VH")
  * - Expected behavior: Handler ignores (wrong talker ID filter)
  */
-const char* INVALID_GGA_TALKER = "$GPGGA,123519,5230.5000,N,00507.0000,E,1,08,0.9,545.4,M,46.9,M,,*42\r\n";
+const char* INVALID_GGA_TALKER = "$GPGGA,123519,5230.5000,N,00507.0000,E,1,08,0.9,545.4,M,46.9,M,,*46\r\n";
 
 /**
  * @brief Invalid VTG sentence - variation out of range
@@ -143,7 +143,7 @@ const char* INVALID_GGA_TALKER = "$GPGGA,123519,5230.5000,N,00507.0000,E,1,08,0.
  * - Calculated variation: 054.7 - 090.0 = -35.3° (exceeds ±30° limit)
  * - Expected behavior: Handler rejects (FR-026)
  */
-const char* INVALID_VTG_VARIATION = "$VHVTG,054.7,T,090.0,M,5.5,N,10.2,K*42\r\n";
+const char* INVALID_VTG_VARIATION = "$VHVTG,054.7,T,090.0,M,5.5,N,10.2,K*7B\r\n";
 
 /**
  * @brief Malformed sentence - non-numeric angle
@@ -151,7 +151,7 @@ const char* INVALID_VTG_VARIATION = "$VHVTG,054.7,T,090.0,M,5.5,N,10.2,K*42\r\n"
  * Sentence: $APRSA,INVALID,A*XX (angle field is text not number)
  * - Expected behavior: Parser returns false or extracts 0.0, silent discard
  */
-const char* MALFORMED_APRSA = "$APRSA,INVALID,A*39\r\n";
+const char* MALFORMED_APRSA = "$APRSA,INVALID,A*41\r\n";
 
 /**
  * @brief Unsupported sentence type - MWV (wind data)
@@ -160,7 +160,7 @@ const char* MALFORMED_APRSA = "$APRSA,INVALID,A*39\r\n";
  * - Message type: MWV (not in supported list)
  * - Expected behavior: Silent ignore (FR-007)
  */
-const char* UNSUPPORTED_APMWV = "$APMWV,045.0,R,5.5,N,A*3E\r\n";
+const char* UNSUPPORTED_APMWV = "$APMWV,045.0,R,5.5,N,A*2D\r\n";
 
 // ============================================================================
 // Test Helper Functions
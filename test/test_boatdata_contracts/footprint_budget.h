@@ -0,0 +1,73 @@
+/**
+ * @file footprint_budget.h
+ * @brief Checked-in memory footprint budget, enforced by test_memory_footprint.cpp
+ *
+ * Every value is the measured footprint at the time it was last raised, so
+ * any growth fails the footprint tests. To grow a structure or a buffer on
+ * purpose, raise its line in the same commit; the diff of this file is the
+ * review record of what the change costs in RAM. Shrinking needs no edit
+ * (lower the value to lock the saving in).
+ *
+ * Sizes are measured by the native test build (64-bit host). On the ESP32
+ * pointers, size_t and long are 4 bytes, so structures holding them are
+ * smaller there and a native budget is an upper bound for the target.
+ * Buffer sizes and JSON lengths come from config.h and are the same on both.
+ *
+ * Constitutional Compliance:
+ * - Principle II (Resource Management): RAM growth is a deliberate, reviewed change
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef FOOTPRINT_BUDGET_H
+#define FOOTPRINT_BUDGET_H
+
+// -----------------------------------------------------------------------------
+// sizeof() of the core structures (bytes, native build)
+// -----------------------------------------------------------------------------
+#define FOOTPRINT_BOATDATA_STRUCTURE 992
+#define FOOTPRINT_GPS_DATA 72
+#define FOOTPRINT_COMPASS_DATA 64
+#define FOOTPRINT_WIND_DATA 32
+#define FOOTPRINT_DST_DATA 40
+#define FOOTPRINT_RUDDER_DATA 24
+#define FOOTPRINT_ENGINE_DATA 40
+#define FOOTPRINT_SAILDRIVE_DATA 16
+#define FOOTPRINT_BATTERY_DATA 72
+#define FOOTPRINT_SHORE_POWER_DATA 32
+#define FOOTPRINT_CALIBRATION_DATA 72
+#define FOOTPRINT_DERIVED_DATA 176
+#define FOOTPRINT_DIAGNOSTIC_DATA 80
+#define FOOTPRINT_BOATDATA_VERSIONS 24
+
+#define FOOTPRINT_LOG_RECORD 264
+#define FOOTPRINT_LOG_RING_BUFFER 8588
+#define FOOTPRINT_CRASH_LOG_ENTRY 64
+#define FOOTPRINT_CRASH_LOG_STORAGE 2064
+#define FOOTPRINT_BOATDATA_SNAPSHOT 122           // Packed wire format, also fixed by static_assert
+#define FOOTPRINT_BOATDATA_DATAGRAM 130
+#define FOOTPRINT_BOATDATA_DELTA_ENCODER 648
+#define FOOTPRINT_BOATDATA_STREAM_CLIENTS 304
+#define FOOTPRINT_N2K_PGN_STATS 4624
+#define FOOTPRINT_POLAR_TABLE 3272
+#define FOOTPRINT_WS_BUFFER_POOL 368              // Bookkeeping only, the buffers are in FOOTPRINT_BOOT_HEAP_TOTAL
+#define FOOTPRINT_MEMORY_BUDGET 1160
+#define FOOTPRINT_SCRATCH_ARENA 48
+#define FOOTPRINT_TRACE_EVENT 16
+
+// -----------------------------------------------------------------------------
+// Static reservation totals (MemoryBudget::getTotal() of the reservations above)
+// -----------------------------------------------------------------------------
+#define FOOTPRINT_STATIC_TOTAL 30316
+#define FOOTPRINT_RTC_TOTAL 2064
+#define FOOTPRINT_BOOT_HEAP_TOTAL 26624
+
+// -----------------------------------------------------------------------------
+// Worst-case JSON documents (bytes, every group available, longest values)
+// -----------------------------------------------------------------------------
+#define FOOTPRINT_BOATDATA_JSON 2460              // GET /boatdata, BoatDataSerializer::toJSON() with "utc"
+#define FOOTPRINT_BOATDATA_KEYFRAME_JSON 2458     // /boatdata delta keyframe, toDeltaJSON()
+#define FOOTPRINT_SIGNALK_JSON 2087               // Signal K delta of every path, toSignalK()
+
+#endif // FOOTPRINT_BUDGET_H
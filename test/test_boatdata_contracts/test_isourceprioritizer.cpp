@@ -84,10 +84,24 @@ public:
     virtual void checkStale(unsigned long currentTime) = 0;
 };
 
+// Per-type source arrays of the mock (compass indices start at MAX_GPS_SOURCES)
+#define MAX_GPS_SOURCES 5
+#define MAX_COMPASS_SOURCES 5
+
+struct MockSourceManager {
+    SensorSource gpsSources[MAX_GPS_SOURCES];
+    int gpsSourceCount;
+    int activeGpsSourceIndex;
+
+    SensorSource compassSources[MAX_COMPASS_SOURCES];
+    int compassSourceCount;
+    int activeCompassSourceIndex;
+};
+
 // Mock implementation for testing the interface contract
 class MockSourcePrioritizer : public ISourcePrioritizer {
 private:
-    SourceManager manager;
+    MockSourceManager manager;
     static const unsigned long STALE_THRESHOLD = 5000;  // 5 seconds
 
     SensorSource* getSourceArray(SensorType type, int& count, int& activeIndex) {
@@ -112,7 +126,7 @@ private:
 
 public:
     MockSourcePrioritizer() {
-        memset(&manager, 0, sizeof(SourceManager));
+        memset(&manager, 0, sizeof(MockSourceManager));
         manager.activeGpsSourceIndex = -1;
         manager.activeCompassSourceIndex = -1;
     }
@@ -1,206 +1,262 @@
 /**
  * @file test_memory_footprint.cpp
- * @brief Contract test for BoatDataStructure memory footprint
+ * @brief Memory footprint regression gate against footprint_budget.h
  *
- * Validates that the enhanced BoatDataStructure stays within constitutional memory limits.
- * Target: ≤600 bytes (estimated ~560 bytes)
+ * Measures what the firmware reserves and fails when any of it grows beyond
+ * the checked-in budget (footprint_budget.h):
+ * - sizeof() of BoatDataStructure, its groups and the fixed-size utilities
+ * - Static reservation totals per region (MemoryBudget, as GET /memory lists them)
+ * - Worst-case JSON documents of the serializer (every group available,
+ *   every field at its longest value) against their budget and buffer
  *
- * Test Coverage:
- * - BoatDataStructure total size ≤ 600 bytes
- * - Individual structure sizes reasonable
- * - Static assertion for compile-time check
+ * Every measurement is printed, so a failing run shows the new value to
+ * put into the budget file when the growth is intended.
  *
  * Constitutional Compliance: Principle II (Resource Management)
  *
- * @see specs/008-enhanced-boatdata-following/data-model.md
- * @see specs/008-enhanced-boatdata-following/tasks.md (T007)
+ * @see footprint_budget.h
  * @see .specify/memory/constitution.md (Principle II)
  */
 
 #include <unity.h>
+#include <math.h>
+#include <stdio.h>
+#include "footprint_budget.h"
 #include "types/BoatDataTypes.h"
+#include "utils/LogRingBuffer.h"
+#include "utils/CrashLogRing.h"
+#include "utils/BoatDataSnapshot.h"
+#include "utils/BoatDataStreamClients.h"
+#include "utils/PolarTable.h"
+#include "utils/TraceRecorder.h"
+#include "components/N2kPGNStats.h"
+#include "../../src/utils/BoatDataSchema.cpp"
+#include "../../src/utils/BoatDataDelta.cpp"
+#include "../../src/utils/SignalKDelta.cpp"
+#include "../../src/utils/MemoryBudget.cpp"
+#include "../../src/utils/ScratchArena.cpp"
+#include "../../src/utils/WsBufferPool.cpp"
+#include "../../src/utils/JsonWriter.cpp"
+
+// BoatDataSerializer (Arduino-only): JSON_BUFFER_SIZE / SIGNALK_BUFFER_SIZE
+static const size_t SERIALIZER_JSON_BUFFER =
+    BoatDataDeltaEncoder::JSON_MAX_BYTES + sizeof(",\"utc\":4102444800000") - 1 + 1;
+static const size_t SIGNALK_JSON_BUFFER = 3072;
+
+static const unsigned long WORST_MILLIS = 4294967295UL;  // Longest 32-bit millis() timestamp
+static const double WORST_UTC_MS = 4102444800000.0;       // 2100-01-01: 13 digits until 2286
 
 void setUp(void) {}
 void tearDown(void) {}
 
 /**
- * @test Verify BoatDataStructure total size is within budget
+ * @brief Print @p measured and fail if it is over @p budget
  */
-void test_boatdatastructure_size_within_budget(void) {
-    size_t structSize = sizeof(BoatDataStructure);
-    
-    // Log size for reference
-    char msg[64];
-    snprintf(msg, sizeof(msg), "BoatDataStructure size: %zu bytes", structSize);
+static void checkBudget(const char* name, size_t measured, size_t budget) {
+    char msg[128];
+    snprintf(msg, sizeof(msg), "%s: %u bytes (budget %u)", name, (unsigned)measured, (unsigned)budget);
     TEST_MESSAGE(msg);
-    
-    // Constitutional limit: ≤600 bytes
-    TEST_ASSERT_LESS_OR_EQUAL_MESSAGE(600, structSize, 
-        "BoatDataStructure exceeds 600 byte budget (Constitutional Principle II)");
+    if (measured > budget) {
+        snprintf(msg, sizeof(msg), "%s grew to %u bytes, over its budget of %u (raise it in footprint_budget.h if intended)",
+                 name, (unsigned)measured, (unsigned)budget);
+        TEST_FAIL_MESSAGE(msg);
+    }
 }
 
-/**
- * @test Verify GPSData size is reasonable
- */
-void test_gpsdata_size_reasonable(void) {
-    size_t size = sizeof(GPSData);
-    
-    char msg[64];
-    snprintf(msg, sizeof(msg), "GPSData size: %zu bytes", size);
-    TEST_MESSAGE(msg);
-    
-    // Should be ~56 bytes (7 doubles × 8B)
-    TEST_ASSERT_LESS_OR_EQUAL(80, size);
-}
+#define CHECK_SIZEOF(T, budget) checkBudget("sizeof(" #T ")", sizeof(T), budget)
 
 /**
- * @test Verify CompassData size is reasonable
+ * @brief Every group available, every field at the value with the longest text
+ *
+ * The sign costs a character, so a field whose range allows -max gets it.
  */
-void test_compassdata_size_reasonable(void) {
-    size_t size = sizeof(CompassData);
-    
-    char msg[64];
-    snprintf(msg, sizeof(msg), "CompassData size: %zu bytes", size);
-    TEST_MESSAGE(msg);
-    
-    // Should be ~64 bytes (8 doubles × 8B)
-    TEST_ASSERT_LESS_OR_EQUAL(96, size);
-}
+static void fillWorstCase(BoatDataStructure& data) {
+    memset(&data, 0, sizeof(data));
+    for (uint8_t id = 0; id < BOATDATA_FIELD_COUNT; id++) {
+        const BoatDataFieldInfo& info = BoatDataSchema::fieldInfo(id);
+        double value = info.max;
+        if (info.min <= -info.max) {
+            value = -info.max;
+        } else if (fabs(info.min) > fabs(info.max)) {
+            value = info.min;
+        }
+        BoatDataSchema::setValue(data, id, value);
+    }
+    for (uint8_t group = 0; group < BOATDATA_SCHEMA_GROUP_COUNT; group++) {
+        BoatDataSchema::stamp(data, group, WORST_MILLIS);
+    }
 
-/**
- * @test Verify DSTData size is reasonable
- */
-void test_dstdata_size_reasonable(void) {
-    size_t size = sizeof(DSTData);
-    
-    char msg[64];
-    snprintf(msg, sizeof(msg), "DSTData size: %zu bytes", size);
-    TEST_MESSAGE(msg);
-    
-    // Should be ~40 bytes (5 doubles × 8B)
-    TEST_ASSERT_LESS_OR_EQUAL(64, size);
+    // Every engine and tank slot in use
+    for (uint8_t i = 0; i < BOATDATA_ENGINE_INSTANCES; i++) {
+        data.instances.engines[i] = EngineData{6000.0, -10.0, 30.0, false, WORST_MILLIS};
+    }
+    for (uint8_t i = 0; i < BOATDATA_TANK_INSTANCES; i++) {
+        data.instances.tanks[i] = TankData{255, 255, 100.0, 10000.0, false, WORST_MILLIS};
+    }
+    data.instances.enginesSeen = (1u << BOATDATA_ENGINE_INSTANCES) - 1;
+    data.instances.tankCount = BOATDATA_TANK_INSTANCES;
 }
 
+// =============================================================================
+// STRUCTURE SIZES
+// =============================================================================
+
 /**
- * @test Verify EngineData size is reasonable
+ * @test BoatDataStructure and every group stay within budget
  */
-void test_enginedata_size_reasonable(void) {
-    size_t size = sizeof(EngineData);
-    
-    char msg[64];
-    snprintf(msg, sizeof(msg), "EngineData size: %zu bytes", size);
-    TEST_MESSAGE(msg);
-    
-    // Should be ~40 bytes (5 doubles × 8B)
-    TEST_ASSERT_LESS_OR_EQUAL(64, size);
+void test_boatdata_structure_sizes(void) {
+    CHECK_SIZEOF(BoatDataStructure, FOOTPRINT_BOATDATA_STRUCTURE);
+    CHECK_SIZEOF(GPSData, FOOTPRINT_GPS_DATA);
+    CHECK_SIZEOF(CompassData, FOOTPRINT_COMPASS_DATA);
+    CHECK_SIZEOF(WindData, FOOTPRINT_WIND_DATA);
+    CHECK_SIZEOF(DSTData, FOOTPRINT_DST_DATA);
+    CHECK_SIZEOF(RudderData, FOOTPRINT_RUDDER_DATA);
+    CHECK_SIZEOF(EngineData, FOOTPRINT_ENGINE_DATA);
+    CHECK_SIZEOF(SaildriveData, FOOTPRINT_SAILDRIVE_DATA);
+    CHECK_SIZEOF(BatteryData, FOOTPRINT_BATTERY_DATA);
+    CHECK_SIZEOF(ShorePowerData, FOOTPRINT_SHORE_POWER_DATA);
+    CHECK_SIZEOF(CalibrationData, FOOTPRINT_CALIBRATION_DATA);
+    CHECK_SIZEOF(DerivedData, FOOTPRINT_DERIVED_DATA);
+    CHECK_SIZEOF(DiagnosticData, FOOTPRINT_DIAGNOSTIC_DATA);
+    CHECK_SIZEOF(BoatDataVersions, FOOTPRINT_BOATDATA_VERSIONS);
 }
 
 /**
- * @test Verify SaildriveData size is reasonable
+ * @test Logging, streaming and table structures stay within budget
  */
-void test_saildrivedata_size_reasonable(void) {
-    size_t size = sizeof(SaildriveData);
-    
-    char msg[64];
-    snprintf(msg, sizeof(msg), "SaildriveData size: %zu bytes", size);
-    TEST_MESSAGE(msg);
-    
-    // Should be ~12 bytes (2 bools + unsigned long + padding)
-    TEST_ASSERT_LESS_OR_EQUAL(24, size);
+void test_utility_structure_sizes(void) {
+    CHECK_SIZEOF(LogRecord, FOOTPRINT_LOG_RECORD);
+    CHECK_SIZEOF(LogRingBuffer, FOOTPRINT_LOG_RING_BUFFER);
+    CHECK_SIZEOF(CrashLogEntry, FOOTPRINT_CRASH_LOG_ENTRY);
+    CHECK_SIZEOF(CrashLogStorage, FOOTPRINT_CRASH_LOG_STORAGE);
+    CHECK_SIZEOF(BoatDataSnapshot, FOOTPRINT_BOATDATA_SNAPSHOT);
+    CHECK_SIZEOF(BoatDataDatagram, FOOTPRINT_BOATDATA_DATAGRAM);
+    CHECK_SIZEOF(BoatDataDeltaEncoder, FOOTPRINT_BOATDATA_DELTA_ENCODER);
+    CHECK_SIZEOF(BoatDataStreamClients, FOOTPRINT_BOATDATA_STREAM_CLIENTS);
+    CHECK_SIZEOF(N2kPGNStats, FOOTPRINT_N2K_PGN_STATS);
+    CHECK_SIZEOF(PolarTable, FOOTPRINT_POLAR_TABLE);
+    CHECK_SIZEOF(WsBufferPool, FOOTPRINT_WS_BUFFER_POOL);
+    CHECK_SIZEOF(MemoryBudget, FOOTPRINT_MEMORY_BUDGET);
+    CHECK_SIZEOF(ScratchArena, FOOTPRINT_SCRATCH_ARENA);
+    CHECK_SIZEOF(TraceEvent, FOOTPRINT_TRACE_EVENT);
 }
 
 /**
- * @test Verify BatteryData size is reasonable
+ * @test The serialization snapshot fits the loop scratch arena it is taken from
  */
-void test_batterydata_size_reasonable(void) {
-    size_t size = sizeof(BatteryData);
-    
-    char msg[64];
-    snprintf(msg, sizeof(msg), "BatteryData size: %zu bytes", size);
-    TEST_MESSAGE(msg);
-    
-    // Should be ~80 bytes (6 doubles + 4 bools + metadata)
-    TEST_ASSERT_LESS_OR_EQUAL(128, size);
+void test_snapshot_fits_loop_arena(void) {
+    checkBudget("BoatDataStructure in loop arena", sizeof(BoatDataStructure), SCRATCH_LOOP_ARENA_BYTES);
 }
 
+// =============================================================================
+// STATIC RESERVATION TOTALS
+// =============================================================================
+
 /**
- * @test Verify ShorePowerData size is reasonable
+ * @test Region totals of the fixed reservations stay within budget
+ *
+ * Same entries as listMemoryBudget() in main.cpp for everything that
+ * builds natively; the component singletons are covered by sizeof above.
  */
-void test_shorepowerdata_size_reasonable(void) {
-    size_t size = sizeof(ShorePowerData);
-    
-    char msg[64];
-    snprintf(msg, sizeof(msg), "ShorePowerData size: %zu bytes", size);
-    TEST_MESSAGE(msg);
-    
-    // Should be ~20 bytes (1 double + 2 bools + metadata)
-    TEST_ASSERT_LESS_OR_EQUAL(32, size);
+void test_static_reservation_totals(void) {
+    MemoryBudget m;
+    const MemoryRegion S = MemoryRegion::STATIC;
+
+    m.add("log_ring", sizeof(LogRingBuffer), S);
+    m.add("n2k_pgn_stats", sizeof(N2kPGNStats), S);
+    m.add("boatdata_stream", sizeof(BoatDataStreamClients) + sizeof(BoatDataDeltaEncoder), S);
+    m.add("boatdata_json", SERIALIZER_JSON_BUFFER, S);
+    m.add("signalk_json", SIGNALK_JSON_BUFFER, S);
+    m.add("polar_table", sizeof(PolarTable), S);
+    m.add("memory_budget", sizeof(MemoryBudget), S);
+    m.add("scratch_loop", SCRATCH_LOOP_ARENA_BYTES, S);
+    m.add("scratch_http", SCRATCH_HTTP_ARENA_BYTES, S);
+    m.add("crash_log", sizeof(CrashLogStorage), MemoryRegion::RTC);
+
+    WsBufferPool pool;  // Counts come from config.h; begin() (the allocation) is not needed
+    uint32_t poolBytes = 0;
+    for (uint8_t c = 0; c < WsBufferPool::CLASS_COUNT; c++) {
+        poolBytes += pool.getBufferCount(c) * WsBufferPool::classBytes(c);
+    }
+    m.add("ws_pool", poolBytes, MemoryRegion::BOOT_HEAP);
+
+    TEST_ASSERT_EQUAL_UINT8(0, m.getDropped());
+    checkBudget("static total", m.getTotal(S), FOOTPRINT_STATIC_TOTAL);
+    checkBudget("rtc total", m.getTotal(MemoryRegion::RTC), FOOTPRINT_RTC_TOTAL);
+    checkBudget("boot_heap total", m.getTotal(MemoryRegion::BOOT_HEAP), FOOTPRINT_BOOT_HEAP_TOTAL);
 }
 
+// =============================================================================
+// WORST-CASE JSON DOCUMENTS
+// =============================================================================
+
 /**
- * @test Verify memory footprint delta from v1.0.0 baseline
+ * @test GET /boatdata with every group at its longest stays within budget
  */
-void test_memory_delta_from_baseline(void) {
-    size_t currentSize = sizeof(BoatDataStructure);
-    const size_t v1_0_0_baseline = 304;  // Documented v1.0.0 size
-    
-    int delta = (int)currentSize - (int)v1_0_0_baseline;
-    
-    char msg[128];
-    snprintf(msg, sizeof(msg), 
-        "Memory footprint delta: %+d bytes (%.1f%% increase from v1.0.0)", 
-        delta, (delta / (double)v1_0_0_baseline) * 100.0);
-    TEST_MESSAGE(msg);
-    
-    // Expected delta: +256 bytes (documented in data-model.md)
-    // Allow some variance due to compiler padding
-    TEST_ASSERT_GREATER_OR_EQUAL(200, delta);
-    TEST_ASSERT_LESS_OR_EQUAL(320, delta);
+void test_worst_case_boatdata_json(void) {
+    static BoatDataStructure data;
+    fillWorstCase(data);
+
+    static StaticJsonWriter<8192> json;  // Far beyond the serializer buffer: measure, don't clip
+    json.reset();
+    json.beginObject().add("timestamp", WORST_MILLIS).add("utc", WORST_UTC_MS, 0);  // As BoatDataSerializer::toJSON()
+    BoatDataSchema::writeJson(json, data);
+    BoatDataSchema::writeInstances(json, data.instances, BoatDataSchema::assignedInstances(data.instances));
+    json.endObject();
+
+    TEST_ASSERT_FALSE(json.overflowed());
+    checkBudget("/boatdata JSON", json.length(), FOOTPRINT_BOATDATA_JSON);
+    checkBudget("/boatdata JSON in serializer buffer", json.length() + 1, SERIALIZER_JSON_BUFFER);
 }
 
 /**
- * @test Verify ESP32 RAM percentage (informational)
+ * @test The delta stream keyframe with every field stays within budget
  */
-void test_esp32_ram_percentage_info(void) {
-    size_t structSize = sizeof(BoatDataStructure);
-    const size_t esp32_ram = 327680;  // 320KB SRAM
-    
-    double percentage = (structSize / (double)esp32_ram) * 100.0;
-    
-    char msg[128];
-    snprintf(msg, sizeof(msg), 
-        "BoatDataStructure uses %.3f%% of ESP32 RAM (%zu / %zu bytes)",
-        percentage, structSize, esp32_ram);
-    TEST_MESSAGE(msg);
-    
-    // Should be well under 1% of ESP32 RAM
-    TEST_ASSERT_LESS_THAN(1.0, percentage);
+void test_worst_case_delta_keyframe(void) {
+    static BoatDataStructure data;
+    fillWorstCase(data);
+
+    static BoatDataDeltaEncoder encoder;
+    static StaticJsonWriter<8192> json;
+    json.reset();
+    TEST_ASSERT_TRUE(encoder.write(json, data, BoatDataGroup::ALL, 1, WORST_MILLIS));  // First write is a keyframe
+
+    TEST_ASSERT_FALSE(json.overflowed());
+    checkBudget("delta keyframe JSON", json.length(), FOOTPRINT_BOATDATA_KEYFRAME_JSON);
+    checkBudget("delta keyframe JSON in serializer buffer", json.length() + 1, SERIALIZER_JSON_BUFFER);
 }
 
 /**
- * @test Compile-time static assertion (will fail if struct too large)
+ * @test The Signal K delta of every mapped path stays within budget
  */
-void test_static_assertion_compile_time(void) {
-    // This test passes if code compiles
-    // The static_assert in BoatDataTypes.h will catch violations at compile time
-    TEST_PASS_MESSAGE("Static assertion passed at compile time");
+void test_worst_case_signalk_delta(void) {
+    static BoatDataStructure data;
+    fillWorstCase(data);
+
+    static BoatDataDeltaEncoder encoder;
+    BoatDataDeltaSet set;
+    TEST_ASSERT_TRUE(encoder.update(data, BoatDataGroup::ALL, 1, WORST_MILLIS, set));
+
+    static StaticJsonWriter<8192> json;
+    json.reset();
+    SignalKDelta::write(json, data, set, "2099-12-31T23:59:59Z");  // signalKTimestamp() format
+
+    TEST_ASSERT_FALSE(json.overflowed());
+    checkBudget("Signal K delta JSON", json.length(), FOOTPRINT_SIGNALK_JSON);
+    checkBudget("Signal K delta JSON in serializer buffer", json.length() + 1, SIGNALK_JSON_BUFFER);
 }
 
 // Test runner
 int main(int argc, char **argv) {
     UNITY_BEGIN();
-    
-    RUN_TEST(test_boatdatastructure_size_within_budget);
-    RUN_TEST(test_gpsdata_size_reasonable);
-    RUN_TEST(test_compassdata_size_reasonable);
-    RUN_TEST(test_dstdata_size_reasonable);
-    RUN_TEST(test_enginedata_size_reasonable);
-    RUN_TEST(test_saildrivedata_size_reasonable);
-    RUN_TEST(test_batterydata_size_reasonable);
-    RUN_TEST(test_shorepowerdata_size_reasonable);
-    RUN_TEST(test_memory_delta_from_baseline);
-    RUN_TEST(test_esp32_ram_percentage_info);
-    RUN_TEST(test_static_assertion_compile_time);
-    
+
+    RUN_TEST(test_boatdata_structure_sizes);
+    RUN_TEST(test_utility_structure_sizes);
+    RUN_TEST(test_snapshot_fits_loop_arena);
+    RUN_TEST(test_static_reservation_totals);
+    RUN_TEST(test_worst_case_boatdata_json);
+    RUN_TEST(test_worst_case_delta_keyframe);
+    RUN_TEST(test_worst_case_signalk_delta);
+
     return UNITY_END();
 }
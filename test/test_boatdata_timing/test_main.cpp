@@ -33,12 +33,14 @@
 #include "../../src/components/CalculationEngine.h"
 #include "../../src/components/SourcePrioritizer.h"
 #include "../../src/components/CalibrationManager.h"
+#include "../../src/utils/FastMath.h"
 
 // Test configuration
 #define TEST_DURATION_MS (5 * 60 * 1000)  // 5 minutes
 #define CALCULATION_INTERVAL_MS 200        // 200ms = 5 Hz
 #define MAX_DURATION_US 200000             // 200ms = 200,000 microseconds
 #define EXPECTED_AVG_DURATION_US 50000     // 50ms typical
+#define BENCHMARK_ITERATIONS 1000          // CalculationEngine::calculate() calls per benchmark
 
 // Test state
 unsigned long testStartTime = 0;
@@ -92,6 +94,63 @@ void setupTestComponents() {
     Serial.println(F("Test components initialized"));
 }
 
+/**
+ * @brief Measure CPU cycles per CalculationEngine::calculate()
+ *
+ * Runs the real calculation on the populated BoatData and prints the
+ * storage precision, so float (BOATDATA_FLOAT_STORAGE=1) and double
+ * builds can be compared:
+ *   pio test -e esp32dev_test -f test_boatdata_timing
+ *   PLATFORMIO_BUILD_FLAGS=-DBOATDATA_FLOAT_STORAGE=1 pio test -e esp32dev_test -f test_boatdata_timing
+ */
+void benchmarkCalculateCycles() {
+    BoatDataStructure* data = boatData->getDataStructure();
+    calculationEngine->calculate(data);  // Warm caches
+
+    uint32_t startCycles = ESP.getCycleCount();
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {
+        calculationEngine->calculate(data);
+    }
+    uint32_t cycles = ESP.getCycleCount() - startCycles;
+
+    Serial.printf("calculate() benchmark: %s storage, CALC_FAST_MATH %d, %lu cycles/call (%.1f us at %lu MHz)\n",
+        sizeof(BoatScalar) == sizeof(float) ? "float" : "double", CALC_FAST_MATH,
+        (unsigned long)(cycles / BENCHMARK_ITERATIONS),
+        (double)cycles / BENCHMARK_ITERATIONS / ESP.getCpuFreqMHz(),
+        (unsigned long)ESP.getCpuFreqMHz());
+}
+
+/**
+ * @brief Measure CPU cycles per call of libm and FastMath trig kernels
+ *
+ * Inputs sweep the calculation cycle's angle range; the volatile sink keeps
+ * the calls from being optimized away. Independent of CALC_FAST_MATH.
+ */
+void benchmarkTrigKernels() {
+    static volatile float sink = 0.0f;
+    uint32_t start;
+
+#define BENCH_TRIG(name, expr)                                                \
+    start = ESP.getCycleCount();                                              \
+    for (int i = 0; i < BENCHMARK_ITERATIONS; i++) {                          \
+        float x = -3.0f + i * (6.0f / BENCHMARK_ITERATIONS);                  \
+        sink = sink + (expr);                                                 \
+    }                                                                         \
+    Serial.printf("  %-22s %6lu cycles/call\n", name,                        \
+        (unsigned long)((ESP.getCycleCount() - start) / BENCHMARK_ITERATIONS))
+
+    FastMath::sinLut(0.0f);  // Build the table outside the measurement
+    Serial.println(F("Trig kernel benchmark:"));
+    BENCH_TRIG("std::sin(float)", std::sin(x));
+    BENCH_TRIG("std::sin(double)", static_cast<float>(std::sin(static_cast<double>(x))));
+    BENCH_TRIG("FastMath::sin", FastMath::sin(x));
+    BENCH_TRIG("FastMath::sinLut", FastMath::sinLut(x));
+    BENCH_TRIG("std::atan2(float)", std::atan2(x, 0.7f));
+    BENCH_TRIG("std::atan2(double)", static_cast<float>(std::atan2(static_cast<double>(x), 0.7)));
+    BENCH_TRIG("FastMath::atan2", FastMath::atan2(x, 0.7f));
+#undef BENCH_TRIG
+}
+
 /**
  * @brief Perform single calculation cycle with timing measurement
  *
@@ -257,6 +316,8 @@ void setup() {
 
     // Initialize test components
     setupTestComponents();
+    benchmarkCalculateCycles();
+    benchmarkTrigKernels();
 
     // Start test timer
     testStartTime = millis();
@@ -0,0 +1,94 @@
+/**
+ * @file test_admission_controller.cpp
+ * @brief Unit tests for AdmissionController (per-endpoint limits, heap budget, early refusal)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/AdmissionController.h"
+#include "../../src/utils/AdmissionController.cpp"
+
+namespace {
+
+constexpr uint32_t PLENTY = ADMISSION_HEAP_RESERVE + 64u * ADMISSION_BYTES_PER_CLIENT;
+
+/// Admit and open @p count clients of @p endpoint
+void connect(AdmissionController& admission, AdmissionEndpoint endpoint, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(AdmissionResult::ADMITTED),
+                                static_cast<uint8_t>(admission.admit(endpoint, PLENTY)));
+        TEST_ASSERT_TRUE(admission.opened(endpoint));
+    }
+}
+
+}  // namespace
+
+/**
+ * @test Each WebSocket endpoint stops at its limit; a disconnect frees a slot; HTTP is not counted
+ */
+void test_admission_endpoint_limits(void) {
+    AdmissionController admission;
+    TEST_ASSERT_EQUAL(AdmissionEndpoint::LOGS, AdmissionController::endpointFor("/logs", true));
+    TEST_ASSERT_EQUAL(AdmissionEndpoint::HTTP, AdmissionController::endpointFor("/logs", false));
+    TEST_ASSERT_EQUAL(AdmissionEndpoint::HTTP, AdmissionController::endpointFor("/logs/previous", true));
+    TEST_ASSERT_EQUAL(AdmissionEndpoint::SIGNALK, AdmissionController::endpointFor("/signalk/v1/stream", true));
+
+    connect(admission, AdmissionEndpoint::LOGS, LOGS_MAX_CLIENTS);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(AdmissionResult::ENDPOINT_FULL),
+                            static_cast<uint8_t>(admission.admit(AdmissionEndpoint::LOGS, PLENTY)));
+    TEST_ASSERT_EQUAL_UINT32(1, admission.getRejected(AdmissionEndpoint::LOGS));
+    TEST_ASSERT_EQUAL_UINT32(1, admission.getRejected(AdmissionResult::ENDPOINT_FULL));
+
+    // Other endpoints are unaffected
+    connect(admission, AdmissionEndpoint::BOATDATA, 1);
+
+    // A handshake that slipped past the limit is reported, and its disconnect frees the count
+    TEST_ASSERT_FALSE(admission.opened(AdmissionEndpoint::LOGS));
+    admission.closed(AdmissionEndpoint::LOGS);
+    admission.closed(AdmissionEndpoint::LOGS);
+    TEST_ASSERT_EQUAL_UINT16(LOGS_MAX_CLIENTS - 1, admission.getClients(AdmissionEndpoint::LOGS));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(AdmissionResult::ADMITTED),
+                            static_cast<uint8_t>(admission.admit(AdmissionEndpoint::LOGS, PLENTY)));
+
+    // Unmatched disconnects do not wrap
+    AdmissionController fresh;
+    fresh.closed(AdmissionEndpoint::SIGNALK);
+    TEST_ASSERT_EQUAL_UINT16(0, fresh.getClients(AdmissionEndpoint::SIGNALK));
+
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(AdmissionResult::ADMITTED),
+                                static_cast<uint8_t>(admission.admit(AdmissionEndpoint::HTTP, PLENTY)));
+    }
+    TEST_ASSERT_EQUAL_UINT32(100, admission.getAdmitted(AdmissionEndpoint::HTTP));
+    TEST_ASSERT_EQUAL_UINT16(LOGS_MAX_CLIENTS - 1 + 1, admission.getTotalClients());   // Admitted is not open yet
+}
+
+/**
+ * @test The global budget follows the free heap; below the reserve everything is refused
+ */
+void test_admission_heap_budget(void) {
+    TEST_ASSERT_EQUAL_UINT16(0, AdmissionController::connectionBudget(ADMISSION_HEAP_RESERVE));
+    TEST_ASSERT_EQUAL_UINT16(2, AdmissionController::connectionBudget(ADMISSION_HEAP_RESERVE + 2 * ADMISSION_BYTES_PER_CLIENT + 1));
+    TEST_ASSERT_EQUAL_UINT16(ADMISSION_MAX_CLIENTS, AdmissionController::connectionBudget(PLENTY));
+
+    AdmissionController admission;
+    uint32_t tight = ADMISSION_HEAP_RESERVE + 3 * ADMISSION_BYTES_PER_CLIENT;
+    connect(admission, AdmissionEndpoint::BOATDATA, 2);
+    connect(admission, AdmissionEndpoint::LOGS, 1);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(AdmissionResult::GLOBAL_FULL),
+                            static_cast<uint8_t>(admission.admit(AdmissionEndpoint::SIGNALK, tight)));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(AdmissionResult::ADMITTED),
+                            static_cast<uint8_t>(admission.admit(AdmissionEndpoint::HTTP, tight)));
+
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(AdmissionResult::LOW_HEAP),
+                            static_cast<uint8_t>(admission.admit(AdmissionEndpoint::HTTP, ADMISSION_HEAP_RESERVE - 1)));
+    TEST_ASSERT_EQUAL_UINT32(1, admission.getRejected(AdmissionResult::LOW_HEAP));
+    TEST_ASSERT_EQUAL_UINT32(1, admission.getRejected(AdmissionResult::GLOBAL_FULL));
+
+    StaticJsonWriter<512> json;
+    admission.writeJson(json, tight);
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"budget\":3,\"clients\":3,\"boatdata\":{\"clients\":2,\"limit\":10,"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"http\":{\"admitted\":1,\"rejected\":1}"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"rejected\":{\"endpoint_full\":0,\"global_full\":1,\"low_heap\":1}}"));
+}
@@ -0,0 +1,196 @@
+/**
+ * @file test_ais_target_table.cpp
+ * @brief AIS target table: MMSI index, eviction, grid-limited CPA/TCPA pass and risk list
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "../../src/utils/AisTargetTable.h"
+#include "../../src/utils/AisTargetTable.cpp"
+
+namespace {
+
+const double DEG = 0.017453292519943295;
+
+/// Report of a vessel @p northNm / @p eastNm from 50N 0E
+AisPositionReport reportAt(uint32_t mmsi, double northNm, double eastNm, double cogDeg, float sog,
+                           uint32_t receivedMs) {
+    AisPositionReport report;
+    report.mmsi = mmsi;
+    report.latitude = 50.0 + northNm / 60.0;
+    report.longitude = eastNm / (60.0 * cos(50.0 * DEG));
+    report.cog = static_cast<float>(cogDeg * DEG);
+    report.sog = sog;
+    report.heading = NAN;
+    report.navStatus = 0;
+    report.aisClass = AIS_CLASS_A;
+    report.receivedMs = receivedMs;
+    return report;
+}
+
+AisOwnShip ownShip(double cogDeg, float sog, uint32_t fixMs) {
+    AisOwnShip own = {50.0, 0.0, static_cast<float>(cogDeg * DEG), sog, fixMs, true};
+    return own;
+}
+
+AisTargetTable table;  // ~19 KB, kept off the stack
+
+}  // namespace
+
+/**
+ * @test Every MMSI is found after inserts and removals; a full table evicts the target heard least recently
+ */
+void test_ais_table_hash_and_eviction(void) {
+    table.clear();
+    for (uint32_t i = 0; i < AIS_MAX_TARGETS; i++) {
+        TEST_ASSERT_TRUE(table.update(reportAt(211000000u + i * 7u, 30.0, 30.0, 0.0, 0.0f, 1000 + i)));
+    }
+    TEST_ASSERT_EQUAL_UINT16(AIS_MAX_TARGETS, table.count());
+    for (uint32_t i = 0; i < AIS_MAX_TARGETS; i++) {
+        uint16_t slot = table.find(211000000u + i * 7u);
+        TEST_ASSERT_NOT_EQUAL(AIS_NO_SLOT, slot);
+        TEST_ASSERT_EQUAL_UINT32(211000000u + i * 7u, table.target(slot).mmsi);
+    }
+
+    // A repeated report updates its target in place
+    TEST_ASSERT_TRUE(table.update(reportAt(211000007u, 30.0, 30.0, 90.0, 4.0f, 5000)));
+    TEST_ASSERT_EQUAL_UINT16(AIS_MAX_TARGETS, table.count());
+    TEST_ASSERT_EQUAL_UINT16(2, table.target(table.find(211000007u)).reports);
+
+    // Full: the oldest (first) target gives up its slot
+    TEST_ASSERT_TRUE(table.update(reportAt(999000001u, 30.0, 30.0, 0.0, 0.0f, 6000)));
+    TEST_ASSERT_EQUAL_UINT16(AIS_MAX_TARGETS, table.count());
+    TEST_ASSERT_EQUAL_UINT32(1u, table.stats().evicted);
+    TEST_ASSERT_EQUAL(AIS_NO_SLOT, table.find(211000000u));
+    TEST_ASSERT_NOT_EQUAL(AIS_NO_SLOT, table.find(999000001u));
+
+    // The probe runs survive the deletion (backward shift)
+    for (uint32_t i = 1; i < AIS_MAX_TARGETS; i++) {
+        TEST_ASSERT_NOT_EQUAL(AIS_NO_SLOT, table.find(211000000u + i * 7u));
+    }
+
+    AisPositionReport bad = reportAt(0, 0.0, 0.0, 0.0, 0.0f, 0);
+    TEST_ASSERT_FALSE(table.update(bad));
+    bad = reportAt(123456789u, 0.0, 0.0, 0.0, 0.0f, 0);
+    bad.latitude = 91.0;
+    TEST_ASSERT_FALSE(table.update(bad));
+}
+
+/**
+ * @test Head-on and crossing geometry give the expected CPA/TCPA; only threats are listed, by TCPA
+ */
+void test_ais_table_cpa_tcpa_and_risk_list(void) {
+    table.clear();
+    // Own ship north at 10 kn; A head-on 5 nm ahead at 10 kn; B crossing from the east; C far abeam and parallel
+    table.update(reportAt(1001u, 5.0, 0.0, 180.0, 10.0f, 10000));
+    table.update(reportAt(1002u, 2.0, 2.0, 270.0, 10.0f, 10000));
+    table.update(reportAt(1003u, 0.0, 3.0, 0.0, 10.0f, 10000));
+    table.evaluate(ownShip(0.0, 10.0f, 10000), 10000);
+
+    const AisTarget& a = table.target(table.find(1001u));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 5.0f, a.range);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, a.cpa);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 900.0f, a.tcpa);  // 5 nm at 20 kn closing
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 0.0f, a.bearing);
+
+    const AisTarget& b = table.target(table.find(1002u));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, b.cpa);  // Both reach (0, 2) nm after 12 min
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 720.0f, b.tcpa);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, static_cast<float>(45.0 * DEG), b.bearing);
+
+    const AisTarget& c = table.target(table.find(1003u));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 3.0f, c.cpa);  // No relative motion
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, c.tcpa);
+
+    AisRiskList risks;
+    TEST_ASSERT_TRUE(table.readRisks(risks));
+    TEST_ASSERT_TRUE(risks.ownShipAvailable);
+    TEST_ASSERT_EQUAL_UINT16(3, risks.targets);
+    TEST_ASSERT_EQUAL_UINT8(2, risks.count);
+    TEST_ASSERT_EQUAL_UINT32(1002u, risks.risks[0].mmsi);  // Sooner first
+    TEST_ASSERT_EQUAL_UINT32(1001u, risks.risks[1].mmsi);
+
+    // Dead reckoning: 6 min later without new reports A is 3 nm off, B 1.4 nm
+    table.evaluate(ownShip(0.0, 10.0f, 10000), 10000 + 360000 - 1);
+    TEST_ASSERT_FLOAT_WITHIN(0.02f, 3.0f, table.target(table.find(1001u)).range);
+    TEST_ASSERT_FLOAT_WITHIN(5.0f, 540.0f, table.target(table.find(1001u)).tcpa);
+
+    StaticJsonWriter<1024> json;
+    TEST_ASSERT_TRUE(table.readRisks(risks));
+    AisTargetTable::writeRisksJson(json, risks);
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"risks\":[{\"mmsi\":1002,"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"class\":\"A\""));
+
+    // No own-ship fix: nothing is computed or listed
+    AisOwnShip lost = ownShip(0.0, 10.0f, 10000);
+    lost.available = false;
+    table.evaluate(lost, 370000);
+    TEST_ASSERT_TRUE(table.readRisks(risks));
+    TEST_ASSERT_FALSE(risks.ownShipAvailable);
+    TEST_ASSERT_EQUAL_UINT8(0, risks.count);
+}
+
+/**
+ * @test A pass computes reported and nearby targets only; far, silent targets keep their last result
+ */
+void test_ais_table_incremental_pass(void) {
+    table.clear();
+    // 150 targets spread 40-100 nm away, 5 within 3 nm
+    for (uint32_t i = 0; i < 150; i++) {
+        double angle = i * 2.4;
+        double distance = 40.0 + (i % 60);
+        table.update(reportAt(2000u + i, distance * cos(angle), distance * sin(angle), 0.0, 0.0f, 1000));
+    }
+    for (uint32_t i = 0; i < 5; i++) {
+        table.update(reportAt(3000u + i, 1.0 + i * 0.5, 0.5, 90.0, 5.0f, 1000));
+    }
+
+    AisRiskList risks;
+    table.evaluate(ownShip(0.0, 0.0f, 1000), 1000);
+    TEST_ASSERT_TRUE(table.readRisks(risks));
+    TEST_ASSERT_EQUAL_UINT16(155, risks.evaluated);  // First pass: all reported
+
+    // Second pass: no reports - only the grid cells around the own ship
+    table.evaluate(ownShip(0.0, 0.0f, 2000), 2000);
+    TEST_ASSERT_TRUE(table.readRisks(risks));
+    TEST_ASSERT_TRUE(risks.evaluated >= 5);
+    TEST_ASSERT_TRUE(risks.evaluated < 20);
+    TEST_ASSERT_EQUAL_UINT32(1000u, table.target(table.find(2000u)).evaluatedMs);
+    TEST_ASSERT_EQUAL_UINT32(2000u, table.target(table.find(3000u)).evaluatedMs);
+
+    // A far target that reports is recomputed wherever it is
+    table.update(reportAt(2000u, 80.0, 0.0, 0.0, 0.0f, 2500));
+    table.evaluate(ownShip(0.0, 0.0f, 3000), 3000);
+    TEST_ASSERT_EQUAL_UINT32(3000u, table.target(table.find(2000u)).evaluatedMs);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 80.0f, table.target(table.find(2000u)).range);
+    TEST_ASSERT_EQUAL_UINT32(1000u, table.target(table.find(2001u)).evaluatedMs);
+}
+
+/**
+ * @test Targets silent for AIS_TARGET_TIMEOUT_MS leave the table through the sweep
+ */
+void test_ais_table_expiry(void) {
+    table.clear();
+    table.update(reportAt(4001u, 1.0, 0.0, 0.0, 0.0f, 1000));
+    table.update(reportAt(4002u, 2.0, 0.0, 0.0, 0.0f, 1000 + AIS_TARGET_TIMEOUT_MS));
+
+    uint32_t now = 1000 + AIS_TARGET_TIMEOUT_MS + 1;
+    for (uint16_t pass = 0; pass <= AIS_MAX_TARGETS / AIS_EXPIRE_SWEEP; pass++) {
+        table.evaluate(ownShip(0.0, 0.0f, now), now);
+    }
+    TEST_ASSERT_EQUAL_UINT16(1, table.count());
+    TEST_ASSERT_EQUAL(AIS_NO_SLOT, table.find(4001u));
+    TEST_ASSERT_NOT_EQUAL(AIS_NO_SLOT, table.find(4002u));
+    TEST_ASSERT_EQUAL_UINT32(1u, table.stats().expired);
+
+    AisTarget copy;
+    TEST_ASSERT_TRUE(table.readTarget(table.find(4002u), copy));
+    TEST_ASSERT_EQUAL_UINT32(4002u, copy.mmsi);
+    TEST_ASSERT_FALSE(table.readTarget(AIS_MAX_TARGETS, copy));
+
+    // The freed slot is reused by the next new vessel
+    TEST_ASSERT_TRUE(table.update(reportAt(4003u, 1.0, 0.0, 0.0, 0.0f, now)));
+    TEST_ASSERT_EQUAL_UINT16(2, table.count());
+}
@@ -0,0 +1,262 @@
+/**
+ * @file test_alarm_engine.cpp
+ * @brief AlarmEngine: rule file, change-driven evaluation, delay/hysteresis, anchor watch
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "../../src/utils/AlarmEngine.h"
+#include "../../src/utils/AlarmEngine.cpp"
+
+namespace {
+
+BoatDataStructure emptyData() {
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    return data;
+}
+
+void setDepth(BoatDataStructure& data, float depth) {
+    data.dst.available = true;
+    data.dst.depth = depth;
+}
+
+void installOne(AlarmEngine& engine, AlarmType type, float threshold, float hysteresis, uint16_t delayS) {
+    AlarmRule rule = {type, 0, threshold, hysteresis, delayS};
+    engine.setRules(&rule, 1);
+}
+
+}  // namespace
+
+/**
+ * @test Rule file: comments, blank lines, optional instance, invalid lines counted
+ */
+void test_alarm_parse_rules(void) {
+    const char* text =
+        "# type threshold hysteresis delay_s [instance]\n"
+        "anchor_drag 35 5 10\n"
+        "\n"
+        "shallow_depth\t2.5 0.5 5   # below the keel\r\n"
+        "battery_low 12.1 0.3 60 1\n"
+        "battery_low 12.1 0.3 60 2\n"       // No bank 2
+        "shallow_depth -1 0.5 5\n"          // Threshold must be positive
+        "anchor_drag 35 -1 10\n"            // Negative hysteresis
+        "bilge_high 1 0 0\n"                // Unknown type
+        "shore_power_lost 0 0 10\n"
+        "shallow_depth 2.5x 0.5 5\n"
+        "anchor_drag 30 5";                 // No delay, no newline
+    AlarmRule rules[ALARM_MAX_RULES];
+    uint8_t invalid = 0;
+    uint8_t count = AlarmEngine::parseRules(text, rules, ALARM_MAX_RULES, &invalid);
+
+    TEST_ASSERT_EQUAL_UINT8(4, count);
+    TEST_ASSERT_EQUAL_UINT8(6, invalid);
+    TEST_ASSERT_EQUAL(AlarmType::ANCHOR_DRAG, rules[0].type);
+    TEST_ASSERT_EQUAL_FLOAT(35.0f, rules[0].threshold);
+    TEST_ASSERT_EQUAL_UINT16(10, rules[0].delayS);
+    TEST_ASSERT_EQUAL(AlarmType::SHALLOW_DEPTH, rules[1].type);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, rules[1].hysteresis);
+    TEST_ASSERT_EQUAL(AlarmType::BATTERY_LOW, rules[2].type);
+    TEST_ASSERT_EQUAL_UINT8(1, rules[2].instance);
+    TEST_ASSERT_EQUAL(AlarmType::SHORE_POWER_LOST, rules[3].type);
+    TEST_ASSERT_EQUAL_FLOAT(0.5f, rules[3].threshold);
+
+    // Rules past the table capacity are counted too
+    TEST_ASSERT_EQUAL_UINT8(1, AlarmEngine::parseRules(text, rules, 1, &invalid));
+    TEST_ASSERT_EQUAL_UINT8(9, invalid);
+
+    TEST_ASSERT_EQUAL_UINT8(4, AlarmEngine::defaultRules(rules, ALARM_MAX_RULES));
+    AlarmEngine engine;
+    engine.setRules(rules, 4);
+    TEST_ASSERT_EQUAL_HEX16(BoatDataGroup::GPS | BoatDataGroup::DST | BoatDataGroup::BATTERY |
+                            BoatDataGroup::SHORE_POWER, engine.inputGroups());
+    TEST_ASSERT_EQUAL_HEX16(engine.inputGroups(), AlarmEngine::allInputGroups());
+}
+
+/**
+ * @test Only rules whose input group changed are evaluated; a heartbeat reads nothing
+ */
+void test_alarm_evaluates_changed_groups_only(void) {
+    AlarmEngine engine;
+    AlarmRule rules[ALARM_MAX_RULES];
+    engine.setRules(rules, AlarmEngine::defaultRules(rules, ALARM_MAX_RULES));
+    BoatDataStructure data = emptyData();
+    setDepth(data, 10.0f);
+
+    engine.evaluate(data, 0, 0);  // After setRules() every rule is read once
+    engine.publish();
+    AlarmStatus status;
+    TEST_ASSERT_TRUE(engine.readStatus(status));
+    TEST_ASSERT_EQUAL_UINT32(4, status.evaluations);
+
+    for (uint32_t now = 100; now <= 1000; now += 100) {
+        engine.evaluate(data, BoatDataGroup::DST | BoatDataGroup::COMPASS, now);
+    }
+    engine.evaluate(data, 0, 1100);
+    engine.publish();
+    TEST_ASSERT_TRUE(engine.readStatus(status));
+    TEST_ASSERT_EQUAL_UINT32(14, status.evaluations);       // 4 + 10 depth reads
+    TEST_ASSERT_EQUAL_UINT32(3 * 10 + 4, status.skipped);   // Heartbeat: all four skipped
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, status.rules[1].value);
+    TEST_ASSERT_TRUE(isnan(status.rules[0].value));         // Anchor not set
+}
+
+/**
+ * @test Shallow depth: delay before raising, hysteresis before clearing, stale input
+ */
+void test_alarm_delay_and_hysteresis(void) {
+    AlarmEngine engine;
+    installOne(engine, AlarmType::SHALLOW_DEPTH, 2.0f, 0.5f, 5);
+    BoatDataStructure data = emptyData();
+    AlarmEvent event;
+
+    setDepth(data, 1.8f);
+    engine.evaluate(data, BoatDataGroup::DST, 1000);
+    TEST_ASSERT_EQUAL(AlarmState::PENDING, engine.getRule(0).state);
+    engine.evaluate(data, 0, 5999);                          // Heartbeat: delay not over
+    TEST_ASSERT_FALSE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL_UINT8(1, engine.evaluate(data, 0, 6000));
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmEventKind::RAISED, event.kind);
+    TEST_ASSERT_EQUAL_FLOAT(1.8f, event.value);
+    TEST_ASSERT_EQUAL_UINT8(1, event.occurrence);
+    TEST_ASSERT_EQUAL_UINT8(1, engine.getActiveCount());
+
+    // Inside the hysteresis band the alarm stays; a stale sensor holds it
+    setDepth(data, 2.4f);
+    engine.evaluate(data, BoatDataGroup::DST, 7000);
+    data.dst.available = false;
+    engine.evaluate(data, BoatDataGroup::DST, 8000);
+    TEST_ASSERT_EQUAL(AlarmState::ACTIVE, engine.getRule(0).state);
+    setDepth(data, 2.6f);
+    engine.evaluate(data, BoatDataGroup::DST, 9000);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmEventKind::CLEARED, event.kind);
+    TEST_ASSERT_EQUAL(AlarmState::CLEAR, engine.getRule(0).state);
+
+    // A short dip does not raise; stale input while pending restarts the delay
+    setDepth(data, 1.5f);
+    engine.evaluate(data, BoatDataGroup::DST, 10000);
+    setDepth(data, 2.1f);
+    engine.evaluate(data, BoatDataGroup::DST, 11000);
+    TEST_ASSERT_EQUAL(AlarmState::CLEAR, engine.getRule(0).state);
+    setDepth(data, 1.5f);
+    engine.evaluate(data, BoatDataGroup::DST, 12000);
+    data.dst.available = false;
+    engine.evaluate(data, BoatDataGroup::DST, 13000);
+    engine.evaluate(data, 0, 20000);
+    TEST_ASSERT_FALSE(engine.takeEvent(event));
+}
+
+/**
+ * @test Anchor watch: armed at the next fix, radius override, drag, raise
+ */
+void test_alarm_anchor_watch(void) {
+    AlarmEngine engine;
+    installOne(engine, AlarmType::ANCHOR_DRAG, 40.0f, 5.0f, 0);
+    BoatDataStructure data = emptyData();
+    AlarmEvent event;
+
+    engine.requestDrop(30.0f);
+    engine.evaluate(data, BoatDataGroup::GPS, 0);              // No fix: kept
+    engine.publish();
+    AlarmStatus status;
+    TEST_ASSERT_TRUE(engine.readStatus(status));
+    TEST_ASSERT_TRUE(status.dropPending);
+    TEST_ASSERT_FALSE(engine.isAnchorSet());
+
+    data.gps.available = true;
+    data.gps.latitude = 60.0;
+    data.gps.longitude = 179.9999;
+    engine.evaluate(data, 0, 1000);
+    TEST_ASSERT_TRUE(engine.isAnchorSet());
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmEventKind::ANCHOR_DROPPED, event.kind);
+    TEST_ASSERT_EQUAL_FLOAT(30.0f, event.value);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, engine.getRule(0).value);
+
+    // 0.0006° of longitude at 60° N across the antimeridian ≈ 33.4 m east
+    data.gps.longitude = -179.9995;
+    engine.evaluate(data, BoatDataGroup::GPS, 2000);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 33.4f, engine.getRule(0).value);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmEventKind::RAISED, event.kind);
+    TEST_ASSERT_EQUAL(AlarmSeverity::ALARM, AlarmTypeSeverity(event.type));
+
+    // 0.0002° north (22.2 m) is back inside radius - hysteresis
+    data.gps.longitude = 179.9999;
+    data.gps.latitude = 60.0002;
+    engine.evaluate(data, BoatDataGroup::GPS, 3000);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmEventKind::CLEARED, event.kind);
+
+    // Raising the anchor clears and disarms
+    data.gps.latitude = 60.01;
+    engine.evaluate(data, BoatDataGroup::GPS, 4000);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmEventKind::RAISED, event.kind);
+    engine.requestRaise();
+    engine.evaluate(data, BoatDataGroup::GPS, 5000);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmEventKind::CLEARED, event.kind);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmEventKind::ANCHOR_RAISED, event.kind);
+    TEST_ASSERT_FALSE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmState::CLEAR, engine.getRule(0).state);
+}
+
+/**
+ * @test Shore power lost arms on the first "on", reset disarms; battery bank by instance
+ */
+void test_alarm_shore_power_and_battery(void) {
+    AlarmEngine engine;
+    AlarmRule rules[2] = {
+        {AlarmType::SHORE_POWER_LOST, 0, 0.5f, 0.0f, 0},
+        {AlarmType::BATTERY_LOW, 1, 12.0f, 0.4f, 0},
+    };
+    engine.setRules(rules, 2);
+    BoatDataStructure data = emptyData();
+    AlarmEvent event;
+
+    data.shorePower.available = true;
+    data.battery.available = true;
+    data.battery.voltageA = 11.0f;                 // Bank A is not watched
+    data.battery.voltageB = 12.5f;
+    engine.evaluate(data, BoatDataGroup::SHORE_POWER | BoatDataGroup::BATTERY, 0);
+    TEST_ASSERT_FALSE(engine.takeEvent(event));    // Never on: not armed
+
+    data.shorePower.shorePowerOn = true;
+    engine.evaluate(data, BoatDataGroup::SHORE_POWER, 1000);
+    data.shorePower.shorePowerOn = false;
+    data.battery.voltageB = 11.9f;
+    engine.evaluate(data, BoatDataGroup::SHORE_POWER | BoatDataGroup::BATTERY, 2000);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmType::SHORE_POWER_LOST, event.type);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmType::BATTERY_LOW, event.type);
+    TEST_ASSERT_EQUAL_UINT8(1, event.instance);
+    TEST_ASSERT_EQUAL_UINT8(2, engine.getActiveCount());
+
+    // Leaving the dock: reset clears both, shore power stays disarmed until seen on
+    engine.requestReset();
+    engine.evaluate(data, 0, 3000);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmEventKind::CLEARED, event.kind);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmEventKind::CLEARED, event.kind);
+    TEST_ASSERT_TRUE(engine.takeEvent(event));     // Battery still low: raised again
+    TEST_ASSERT_EQUAL(AlarmType::BATTERY_LOW, event.type);
+    TEST_ASSERT_EQUAL_UINT8(2, event.occurrence);
+    TEST_ASSERT_FALSE(engine.takeEvent(event));
+    TEST_ASSERT_EQUAL(AlarmState::CLEAR, engine.getRule(0).state);
+
+    StaticJsonWriter<1024> json;
+    engine.publish();
+    AlarmStatus status;
+    TEST_ASSERT_TRUE(engine.readStatus(status));
+    AlarmEngine::writeJson(json, status);
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"type\":\"battery_low\",\"instance\":1,\"severity\":\"warning\""));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"lat\":null"));
+}
@@ -0,0 +1,111 @@
+/**
+ * @file test_boatdata_delta.cpp
+ * @brief /boatdata?mode=delta keyframes and deadbands
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/BoatDataDelta.h"
+#include "../../src/utils/BoatDataDelta.cpp"
+
+namespace {
+
+BoatDataStructure deltaBoat() {
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.compass.magneticHeading = 1.0;
+    data.compass.available = true;
+    data.compass.lastUpdate = 100;
+    data.gps.latitude = 54.5;
+    data.gps.available = true;
+    return data;
+}
+
+}  // namespace
+
+/**
+ * @test The first write is a full keyframe; unchanged data gives an empty delta
+ */
+void test_boatdata_delta_keyframe_first(void) {
+    BoatDataDeltaEncoder encoder;
+    BoatDataStructure data = deltaBoat();
+
+    StaticJsonWriter<2048> key;
+    TEST_ASSERT_TRUE(encoder.write(key, data, BoatDataGroup::ALL, 5, 1000));
+    TEST_ASSERT_FALSE(key.overflowed());
+    TEST_ASSERT_NOT_NULL(strstr(key.c_str(), "{\"type\":\"keyframe\",\"timestamp\":1000,\"gps\":{"));
+    TEST_ASSERT_NOT_NULL(strstr(key.c_str(), "\"derived\":{"));
+    TEST_ASSERT_EQUAL_UINT32(5, encoder.getGeneration());
+
+    // Same values again: no group objects
+    StaticJsonWriter<256> delta;
+    TEST_ASSERT_FALSE(encoder.write(delta, data, BoatDataGroup::ALL, 6, 2000));
+    TEST_ASSERT_EQUAL_STRING("{\"type\":\"delta\",\"timestamp\":2000}", delta.c_str());
+}
+
+/**
+ * @test Only fields of dirty groups that moved a deadband from the last sent value appear
+ */
+void test_boatdata_delta_deadband(void) {
+    BoatDataDeltaEncoder encoder;
+    BoatDataStructure data = deltaBoat();
+    StaticJsonWriter<2048> key;
+    encoder.write(key, data, BoatDataGroup::ALL, 1, 1000);
+
+    // Below the angle deadband: nothing
+    data.compass.magneticHeading = 1.0 + BOATDATA_DELTA_DEADBAND_ANGLE * 0.6;
+    data.compass.lastUpdate = 200;
+    StaticJsonWriter<256> delta;
+    encoder.write(delta, data, BoatDataGroup::COMPASS, 2, 2000);
+    TEST_ASSERT_NULL(strstr(delta.c_str(), "compass"));
+
+    // Drift adds up against the last sent value
+    data.compass.magneticHeading = 1.0 + BOATDATA_DELTA_DEADBAND_ANGLE * 1.2;
+    data.compass.lastUpdate = 300;
+    data.dst.depth = 5.0;  // Not dirty: not compared
+    delta.reset();
+    encoder.write(delta, data, BoatDataGroup::COMPASS, 3, 3000);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"type\":\"delta\",\"timestamp\":3000,\"compass\":{\"magneticHeading\":1.0020,\"lastUpdate\":300}}",
+        delta.c_str());
+
+    // Availability change alone, and a value going missing
+    data.compass.available = false;
+    data.gps.latitude = NAN;
+    delta.reset();
+    encoder.write(delta, data, BoatDataGroup::COMPASS | BoatDataGroup::GPS, 4, 4000);
+    TEST_ASSERT_NOT_NULL(strstr(delta.c_str(), "\"gps\":{\"latitude\":null,\"lastUpdate\":0}"));
+    TEST_ASSERT_NOT_NULL(strstr(delta.c_str(), "\"compass\":{\"available\":false,\"lastUpdate\":300}"));
+
+    // Deadbands by unit
+    TEST_ASSERT_EQUAL_DOUBLE(BOATDATA_DELTA_DEADBAND_SPEED, BoatDataDeltaEncoder::deadband(BOATDATA_FIELD_DERIVED_TWS));
+    TEST_ASSERT_EQUAL_DOUBLE(BOATDATA_DELTA_DEADBAND_POSITION, BoatDataDeltaEncoder::deadband(BOATDATA_FIELD_GPS_LATITUDE));
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, BoatDataDeltaEncoder::deadband(BOATDATA_FIELD_GPS_SATELLITES));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 0.01, BoatDataDeltaEncoder::deadband(BOATDATA_FIELD_DST_DEPTH));
+}
+
+/**
+ * @test Keyframes on request and every BOATDATA_DELTA_KEYFRAME_MS
+ */
+void test_boatdata_delta_keyframe_schedule(void) {
+    BoatDataDeltaEncoder encoder;
+    BoatDataStructure data = deltaBoat();
+    StaticJsonWriter<2048> json;
+
+    TEST_ASSERT_TRUE(encoder.write(json, data, 0, 1, 1000));
+    json.reset();
+    TEST_ASSERT_FALSE(encoder.write(json, data, 0, 1, 1000 + BOATDATA_DELTA_KEYFRAME_MS - 1));
+    json.reset();
+    TEST_ASSERT_TRUE(encoder.write(json, data, 0, 1, 1000 + BOATDATA_DELTA_KEYFRAME_MS));
+    json.reset();
+    encoder.requestKeyframe();
+    TEST_ASSERT_TRUE(encoder.write(json, data, 0, 1, 1000 + BOATDATA_DELTA_KEYFRAME_MS + 1));
+    json.reset();
+
+    // Interval set by the rate governor
+    encoder.setKeyframeInterval(BOATDATA_DELTA_KEYFRAME_MS * 2);
+    TEST_ASSERT_EQUAL_UINT32(BOATDATA_DELTA_KEYFRAME_MS * 2, encoder.getKeyframeInterval());
+    TEST_ASSERT_FALSE(encoder.write(json, data, 0, 1, 1000 + BOATDATA_DELTA_KEYFRAME_MS * 2));
+    json.reset();
+    TEST_ASSERT_TRUE(encoder.write(json, data, 0, 1, 1000 + BOATDATA_DELTA_KEYFRAME_MS * 3 + 1));
+}
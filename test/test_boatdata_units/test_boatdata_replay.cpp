@@ -0,0 +1,109 @@
+/**
+ * @file test_boatdata_replay.cpp
+ * @brief Unit tests for BoatDataReplay (/boatdata?since= replay ring and pending requests)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/BoatDataReplay.h"
+#include "../../src/utils/BoatDataReplay.cpp"
+
+namespace {
+
+/// Record one snapshot at @p timestampMs with its SOG set to @p sog
+void recordAt(BoatDataReplay& replay, uint32_t timestampMs, uint16_t sog) {
+    BoatDataSnapshot snapshot;
+    memset(&snapshot, 0, sizeof(snapshot));
+    snapshot.version = BOATDATA_SNAPSHOT_VERSION;
+    snapshot.timestampMs = timestampMs;
+    snapshot.sog = sog;
+    replay.record(snapshot);
+}
+
+}  // namespace
+
+/**
+ * @test Records after since come out oldest first as datagrams; the ring keeps the newest CAPACITY
+ */
+void test_boatdata_replay_since(void) {
+    BoatDataReplay replay;
+    static uint8_t out[BoatDataReplay::CAPACITY * sizeof(BoatDataDatagram)];
+    TEST_ASSERT_EQUAL_UINT8(0, replay.countSince(0));
+    TEST_ASSERT_EQUAL_UINT32(0, replay.copySince(0, out, sizeof(out)));
+
+    // Wraps millis() half way through, overwrites the oldest records
+    const uint32_t start = 0xFFFFFFFFu - 10u * BOATDATA_REPLAY_INTERVAL_MS;
+    const uint8_t total = BoatDataReplay::CAPACITY + 5;
+    for (uint8_t i = 0; i < total; i++) {
+        recordAt(replay, start + i * BOATDATA_REPLAY_INTERVAL_MS, i);
+    }
+    TEST_ASSERT_EQUAL_UINT8(BoatDataReplay::CAPACITY, replay.getCount());
+    TEST_ASSERT_EQUAL_UINT32(total, replay.getSequence());
+    TEST_ASSERT_EQUAL_UINT8(BoatDataReplay::CAPACITY, replay.countSince(0));
+
+    // The last frame the client saw (after the wrap): only the newer records
+    uint32_t since = start + (total - 4) * BOATDATA_REPLAY_INTERVAL_MS;
+    TEST_ASSERT_EQUAL_UINT8(3, replay.countSince(since));
+    TEST_ASSERT_EQUAL_UINT8(3, replay.countSince(since + 1));
+    size_t bytes = replay.copySince(since, out, sizeof(out));
+    TEST_ASSERT_EQUAL_UINT32(3 * sizeof(BoatDataDatagram), bytes);
+    for (uint8_t i = 0; i < 3; i++) {
+        BoatDataDatagram datagram;
+        memcpy(&datagram, out + i * sizeof(BoatDataDatagram), sizeof(datagram));
+        TEST_ASSERT_EQUAL_UINT32(BOATDATA_DATAGRAM_MAGIC, datagram.magic);
+        TEST_ASSERT_EQUAL_UINT32(total - 3 + i, datagram.sequence);
+        TEST_ASSERT_EQUAL_UINT16(total - 3 + i, datagram.snapshot.sog);
+    }
+
+    // A since older than the ring gets all of it; a partial buffer keeps the oldest
+    TEST_ASSERT_EQUAL_UINT8(BoatDataReplay::CAPACITY, replay.countSince(start));
+    bytes = replay.copySince(0, out, 2 * sizeof(BoatDataDatagram) + 5);
+    TEST_ASSERT_EQUAL_UINT32(2 * sizeof(BoatDataDatagram), bytes);
+    BoatDataDatagram oldest;
+    memcpy(&oldest, out, sizeof(oldest));
+    TEST_ASSERT_EQUAL_UINT32(total - BoatDataReplay::CAPACITY, oldest.sequence);
+
+    // Nothing newer than the last record
+    TEST_ASSERT_EQUAL_UINT8(0, replay.countSince(start + (total - 1) * BOATDATA_REPLAY_INTERVAL_MS));
+}
+
+/**
+ * @test Pending replays are taken once each, the table is bounded, and the counters are reported
+ */
+void test_boatdata_replay_requests(void) {
+    BoatDataReplay replay;
+    uint32_t id = 0;
+    uint32_t since = 0;
+    TEST_ASSERT_FALSE(replay.takeRequest(id, since));
+    TEST_ASSERT_FALSE(replay.request(0, 100));
+
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        TEST_ASSERT_TRUE(replay.request(10 + i, 1000 + i));
+    }
+    TEST_ASSERT_FALSE(replay.request(99, 5));
+
+    TEST_ASSERT_TRUE(replay.takeRequest(id, since));
+    TEST_ASSERT_EQUAL_UINT32(10, id);
+    TEST_ASSERT_EQUAL_UINT32(1000, since);
+    TEST_ASSERT_TRUE(replay.request(99, 5));   // The slot is free again
+    uint8_t taken = 1;
+    while (replay.takeRequest(id, since)) {
+        taken++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(BOATDATA_STREAM_MAX_CLIENTS + 1, taken);
+
+    StaticJsonWriter<192> json;
+    replay.writeJson(json);
+    char expected[192];
+    snprintf(expected, sizeof(expected),
+             "{\"records\":0,\"capacity\":%u,\"interval_ms\":%lu,\"sequence\":0,\"oldest_ms\":null,"
+             "\"bursts\":0,\"replayed\":0}",
+             (unsigned)BoatDataReplay::CAPACITY, (unsigned long)BOATDATA_REPLAY_INTERVAL_MS);
+    TEST_ASSERT_EQUAL_STRING(expected, json.c_str());
+
+    recordAt(replay, 5000, 1);
+    replay.recordSent(1);
+    json.reset();
+    replay.writeJson(json, "replay");
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"oldest_ms\":5000,\"bursts\":1,\"replayed\":1}"));
+}
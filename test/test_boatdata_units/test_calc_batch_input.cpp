@@ -0,0 +1,168 @@
+/**
+ * @file test_calc_batch_input.cpp
+ * @brief Recorded input decoding for the offline calculation runner
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/CalcBatchInput.h"
+#include "../../src/utils/CalcBatchInput.cpp"
+#include "../../src/utils/NMEA0183Tokenizer.cpp"
+#include "../../src/components/CalculationEngine.h"
+
+namespace {
+
+/// 29-bit identifier: priority 2, @p pgn, source 35
+uint32_t canIdOf(uint32_t pgn) {
+    return (2UL << 26) | (pgn << 8) | 35;
+}
+
+void put16(uint8_t* d, uint16_t v) {
+    d[0] = static_cast<uint8_t>(v);
+    d[1] = static_cast<uint8_t>(v >> 8);
+}
+
+BoatDataStructure emptyBoat() {
+    BoatDataStructure boat;
+    memset(&boat, 0, sizeof(boat));
+    return boat;
+}
+
+}  // namespace
+
+/**
+ * @test Single-frame PGNs update the fields the live handlers write; NA fields and other references are ignored
+ */
+void test_calc_batch_input_frames(void) {
+    CalcBatchInput input;
+    BoatDataStructure boat = emptyBoat();
+    uint8_t d[8];
+
+    TEST_ASSERT_EQUAL_UINT32(130306, CalcBatchInput::pgnOf(canIdOf(130306)));
+    TEST_ASSERT_EQUAL_UINT32(59904, CalcBatchInput::pgnOf(canIdOf(59904) | 0xFF00));  // PDU1 destination removed
+
+    // Apparent wind 5 m/s at -0.5 rad (stored as 2π - 0.5)
+    memset(d, 0xFF, sizeof(d));
+    put16(d + 1, 500);
+    put16(d + 3, static_cast<uint16_t>((2.0 * M_PI - 0.5) * 1e4 + 0.5));
+    d[5] = 0xFA;  // reference 2 = apparent
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::WIND, input.applyFrame(canIdOf(130306), d, 8, 1234, boat));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, -0.5, boat.wind.apparentWindAngle);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 5.0 * 1.943844, boat.wind.apparentWindSpeed);
+    TEST_ASSERT_TRUE(boat.wind.available);
+    TEST_ASSERT_EQUAL_UINT32(1234, boat.wind.lastUpdate);
+
+    // True wind is not an input
+    d[5] = 0xF8;
+    put16(d + 1, 900);
+    TEST_ASSERT_EQUAL_UINT16(0, input.applyFrame(canIdOf(130306), d, 8, 1300, boat));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 5.0 * 1.943844, boat.wind.apparentWindSpeed);
+
+    // Magnetic heading; NA heading changes nothing
+    memset(d, 0xFF, sizeof(d));
+    put16(d + 1, 12345);
+    d[7] = 0xFD;  // reference 1 = magnetic
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::COMPASS, input.applyFrame(canIdOf(127250), d, 8, 1400, boat));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 1.2345, boat.compass.magneticHeading);
+    put16(d + 1, 0xFFFF);
+    TEST_ASSERT_EQUAL_UINT16(0, input.applyFrame(canIdOf(127250), d, 8, 1500, boat));
+    TEST_ASSERT_EQUAL_UINT32(1400, boat.compass.lastUpdate);
+
+    // Boat speed stays in m/s; short frames are ignored
+    memset(d, 0xFF, sizeof(d));
+    put16(d + 1, 310);
+    TEST_ASSERT_EQUAL_UINT16(0, input.applyFrame(canIdOf(128259), d, 5, 1600, boat));
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::DST, input.applyFrame(canIdOf(128259), d, 8, 1600, boat));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 3.1, boat.dst.measuredBoatSpeed);
+
+    // Unused PGN
+    TEST_ASSERT_EQUAL_UINT16(0, input.applyFrame(canIdOf(127505), d, 8, 1700, boat));
+}
+
+/**
+ * @test HDM and RMC sentences in degrees and knots; an invalid fix changes nothing
+ */
+void test_calc_batch_input_sentences(void) {
+    CalcBatchInput input;
+    BoatDataStructure boat = emptyBoat();
+
+    const char* hdm = "$HCHDM,123.4,M*2D";
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::COMPASS, input.applyLine(hdm, strlen(hdm), 100, boat));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 123.4 * 0.017453292519943295, boat.compass.magneticHeading);
+
+    const char* rmc = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A";
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::GPS, input.applyLine(rmc, strlen(rmc), 200, boat));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 48.1173, boat.gps.latitude);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 11.516667, boat.gps.longitude);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 22.4, boat.gps.sog);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, -3.1 * 0.017453292519943295, boat.gps.variation);
+    TEST_ASSERT_EQUAL_UINT32(200, boat.gps.lastUpdate);
+
+    const char* noFix = "$GPRMC,123519,V,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*7D";
+    TEST_ASSERT_EQUAL_UINT16(0, input.applyLine(noFix, strlen(noFix), 300, boat));
+    const char* badChecksum = "$HCHDM,200.0,M*2D";
+    TEST_ASSERT_EQUAL_UINT16(0, input.applyLine(badChecksum, strlen(badChecksum), 300, boat));
+    TEST_ASSERT_EQUAL_UINT32(200, boat.gps.lastUpdate);
+}
+
+/**
+ * @test CSV columns in any order, unknown columns ignored, empty cells keep the last value
+ */
+void test_calc_batch_input_csv(void) {
+    CalcBatchInput input;
+    BoatDataStructure boat = emptyBoat();
+    uint32_t nowMs = 0;
+
+    TEST_ASSERT_FALSE(input.setCsvHeader("awa_deg,aws_kn\n"));
+    TEST_ASSERT_TRUE(input.setCsvHeader("awa_deg,comment,time_ms,aws_kn,boat_speed_ms\r\n"));
+
+    uint16_t changed = input.applyCsvRow("-30,upwind,1000,12.5,3.0\n", boat, nowMs);
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::WIND | BoatDataGroup::DST, changed);
+    TEST_ASSERT_EQUAL_UINT32(1000, nowMs);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, -30.0 * 0.017453292519943295, boat.wind.apparentWindAngle);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 12.5, boat.wind.apparentWindSpeed);
+
+    // Empty AWA/AWS: only the boat speed is updated
+    changed = input.applyCsvRow(",,1200,,3.2", boat, nowMs);
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::DST, changed);
+    TEST_ASSERT_EQUAL_UINT32(1200, nowMs);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 12.5, boat.wind.apparentWindSpeed);
+    TEST_ASSERT_EQUAL_UINT32(1000, boat.wind.lastUpdate);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 3.2, boat.dst.measuredBoatSpeed);
+
+    // No (or a non-numeric) time: the row changes nothing
+    TEST_ASSERT_EQUAL_UINT16(0, input.applyCsvRow("10,x,,5,1", boat, nowMs));
+    TEST_ASSERT_EQUAL_UINT16(0, input.applyCsvRow("10,x,t,5,1", boat, nowMs));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 12.5, boat.wind.apparentWindSpeed);
+}
+
+/**
+ * @test Stale groups expire on the log clock, and the engine stamps derived data with the replay time
+ */
+void test_calc_batch_input_replay_clock(void) {
+    CalcBatchInput input;
+    BoatDataStructure boat = emptyBoat();
+    uint32_t nowMs = 0;
+    TEST_ASSERT_TRUE(input.setCsvHeader("time_ms,awa_deg,aws_kn,boat_speed_ms,heading_deg,cog_deg,sog_kn"));
+    TEST_ASSERT_EQUAL_UINT16(CALC_BATCH_REQUIRED_GROUPS,
+                             input.applyCsvRow("5000,40,14,3,90,95,6.2", boat, nowMs));
+
+    CalculationEngine engine;
+    CalcBatchInput::expireStale(boat, nowMs);
+    engine.calculate(&boat, nowMs);
+    TEST_ASSERT_TRUE(boat.derived.available);
+    TEST_ASSERT_EQUAL_UINT32(5000, boat.derived.lastUpdate);
+
+    // Same inputs and times give the same outputs
+    BoatDataStructure again = emptyBoat();
+    TEST_ASSERT_TRUE(input.setCsvHeader("time_ms,awa_deg,aws_kn,boat_speed_ms,heading_deg,cog_deg,sog_kn"));
+    input.applyCsvRow("5000,40,14,3,90,95,6.2", again, nowMs);
+    CalculationEngine second;
+    second.calculate(&again, nowMs);
+    TEST_ASSERT_EQUAL_FLOAT(static_cast<float>(boat.derived.tws), static_cast<float>(again.derived.tws));
+    TEST_ASSERT_EQUAL_FLOAT(static_cast<float>(boat.derived.twa), static_cast<float>(again.derived.twa));
+
+    // Wind silent beyond BOATDATA_STALE_WIND_MS
+    CalcBatchInput::expireStale(boat, 5000 + BOATDATA_STALE_WIND_MS + 1);
+    TEST_ASSERT_FALSE(boat.wind.available);
+}
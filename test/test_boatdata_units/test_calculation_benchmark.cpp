@@ -0,0 +1,75 @@
+/**
+ * @file test_calculation_benchmark.cpp
+ * @brief CalculationBenchmark statistics and stage plumbing (fake cycle counter)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/components/CalculationBenchmark.h"
+#include "../../src/components/CalculationBenchmark.cpp"
+
+namespace {
+
+uint32_t fakeCycles = 0;
+
+/// Every read advances the counter by 7 cycles: counter cost 7, stage cost 0
+uint32_t fakeCounter() {
+    return fakeCycles += 7;
+}
+
+}  // namespace
+
+/**
+ * @test min/median/p99/max use nearest rank over the sorted samples
+ */
+void test_calculation_benchmark_summarize(void) {
+    uint32_t samples[100];
+    for (uint32_t i = 0; i < 100; i++) {
+        samples[i] = ((i * 37) % 100) + 1;  // 1..100, shuffled
+    }
+    CalcBenchStats stats;
+    CalculationBenchmark::summarize(samples, 100, stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.min);
+    TEST_ASSERT_EQUAL_UINT32(50, stats.median);
+    TEST_ASSERT_EQUAL_UINT32(99, stats.p99);
+    TEST_ASSERT_EQUAL_UINT32(100, stats.max);
+
+    uint32_t one[] = {42};
+    CalculationBenchmark::summarize(one, 1, stats);
+    TEST_ASSERT_EQUAL_UINT32(42, stats.median);
+    TEST_ASSERT_EQUAL_UINT32(42, stats.p99);
+
+    CalculationBenchmark::summarize(samples, 0, stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.max);
+}
+
+/**
+ * @test Every stage runs over the corpus; polar only with a loaded table
+ */
+void test_calculation_benchmark_stages(void) {
+    static CalculationBenchmark bench(fakeCounter);
+    CalcBenchStats stats;
+
+    for (uint8_t s = 0; s + 1 < CalculationBenchmark::STAGE_COUNT; s++) {
+        TEST_ASSERT_TRUE(bench.runStage(s, 40, stats));
+        TEST_ASSERT_EQUAL_UINT32(7, bench.getOverhead());
+        TEST_ASSERT_EQUAL_UINT32(0, stats.max);  // Counter cost subtracted
+        TEST_ASSERT_TRUE(strlen(CalculationBenchmark::stageName(s)) > 0);
+    }
+    TEST_ASSERT_FALSE(bench.runStage(CalculationBenchmark::STAGE_COUNT - 1, 40, stats));
+    TEST_ASSERT_FALSE(bench.runStage(CalculationBenchmark::STAGE_COUNT, 40, stats));
+
+    PolarTable polar;
+    TEST_ASSERT_TRUE(polar.parse("twa/tws 6 12 20\n45 5 6.5 7\n90 6 7.5 8\n180 4 6 7.5\n"));
+    bench.setPolar(&polar);
+    TEST_ASSERT_TRUE(bench.runStage(CalculationBenchmark::STAGE_COUNT - 1, 1000, stats));  // Clamped
+    TEST_ASSERT_EQUAL_STRING("polar", CalculationBenchmark::stageName(CalculationBenchmark::STAGE_COUNT - 1));
+
+    StaticJsonWriter<128> json;
+    stats.min = 10;
+    stats.median = 12;
+    stats.p99 = 30;
+    stats.max = 55;
+    CalculationBenchmark::writeStage(json, 6, stats);
+    TEST_ASSERT_EQUAL_STRING("{\"stage\":\"tws\",\"min\":10,\"median\":12,\"p99\":30,\"max\":55}", json.c_str());
+}
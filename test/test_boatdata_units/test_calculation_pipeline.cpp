@@ -0,0 +1,139 @@
+/**
+ * @file test_calculation_pipeline.cpp
+ * @brief Staged CalculationEngine::calculate() against the per-formula functions
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/components/CalculationEngine.h"
+#include "../../src/components/CalculationEngine.cpp"
+
+namespace {
+
+/**
+ * @brief Derived values by chaining the reference functions (pre-pipeline calculate())
+ */
+DerivedData reference(CalculationEngine& engine, const BoatDataStructure& in) {
+    DerivedData out;
+    memset(&out, 0, sizeof(out));
+    BoatScalar heel = in.compass.heelAngle;
+    BoatScalar boatSpeed = in.dst.measuredBoatSpeed;
+
+    out.awaOffset = engine.calculateAWAOffset(in.wind.apparentWindAngle, in.calibration.windAngleOffset);
+    out.awaHeel = engine.calculateAWAHeel(out.awaOffset, heel);
+    out.leeway = engine.calculateLeeway(out.awaHeel, heel, boatSpeed, in.calibration.leewayCalibrationFactor);
+    out.stw = engine.calculateSTW(boatSpeed, out.leeway);
+    out.tws = engine.calculateTWS(in.wind.apparentWindSpeed, out.awaHeel, out.stw, boatSpeed, out.leeway);
+
+    BoatScalar cartesianAWA = AngleUtils::normalizeToZeroTwoPi(BoatScalar(3) * BoatMath::HALF_PI_RAD - out.awaHeel);
+    BoatScalar tws_x = in.wind.apparentWindSpeed * std::cos(cartesianAWA) + out.stw * std::sin(out.leeway);
+    BoatScalar tws_y = in.wind.apparentWindSpeed * std::sin(cartesianAWA) + boatSpeed;
+    out.twa = engine.calculateTWA(tws_x, tws_y, out.awaHeel);
+    out.wdir = engine.calculateWDIR(in.compass.magneticHeading, out.twa);
+    out.vmg = engine.calculateVMG(out.stw, out.twa, out.leeway);
+    engine.calculateCurrent(in.gps.sog, in.gps.cog, out.stw, in.compass.magneticHeading,
+                            out.leeway, in.gps.variation, out.soc, out.doc);
+    return out;
+}
+
+/// Angles compare modulo 2π (±π and 0/2π are the same direction)
+void assertAngle(double expected, double actual) {
+    double diff = std::fabs(std::remainder(expected - actual, 2.0 * M_PI));
+    TEST_ASSERT_TRUE_MESSAGE(diff < 1e-3, "angle mismatch");
+}
+
+}  // namespace
+
+/**
+ * @test Pipeline output matches the reference formulas over a grid of inputs
+ */
+void test_calculation_pipeline_matches_reference(void) {
+    CalculationEngine engine;
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.gps.available = data.compass.available = data.wind.available = data.dst.available = true;
+    data.calibration.leewayCalibrationFactor = 10.0;
+    data.calibration.windAngleOffset = 0.05;
+    data.gps.variation = -0.03;
+
+    const double awas[] = {-3.0, -1.6, -0.7, 0.0, 0.4, 1.5708, 2.2, 3.1};
+    const double heels[] = {-0.5, 0.0, 0.26};
+    const double speeds[] = {0.0, 2.5, 7.0};
+    int cases = 0;
+    for (double awa : awas) {
+        for (double heel : heels) {
+            for (double speed : speeds) {
+                data.wind.apparentWindAngle = awa;
+                data.wind.apparentWindSpeed = 14.0;
+                data.compass.heelAngle = heel;
+                data.compass.magneticHeading = 1.2 + awa * 0.5;
+                data.dst.measuredBoatSpeed = speed;
+                data.gps.sog = speed + 0.8;
+                data.gps.cog = 1.0;
+
+                engine.calculate(&data);
+                DerivedData expected = reference(engine, data);
+                const DerivedData& d = data.derived;
+
+                TEST_ASSERT_TRUE(d.available);
+                assertAngle(expected.awaOffset, d.awaOffset);
+                assertAngle(expected.awaHeel, d.awaHeel);
+                TEST_ASSERT_FLOAT_WITHIN(1e-4, expected.leeway, d.leeway);
+                TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.tws, d.tws);
+                assertAngle(expected.twa, d.twa);
+                assertAngle(expected.wdir, d.wdir);
+                TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.vmg, d.vmg);
+                TEST_ASSERT_FLOAT_WITHIN(1e-3, expected.soc, d.soc);
+                assertAngle(expected.doc, d.doc);
+                cases++;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_INT(72, cases);
+}
+
+/**
+ * @test Missing inputs mark derived data unavailable
+ */
+void test_calculation_pipeline_requires_inputs(void) {
+    CalculationEngine engine;
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.derived.available = true;
+    data.gps.available = data.compass.available = data.wind.available = true;
+
+    engine.calculate(&data);
+    TEST_ASSERT_FALSE(data.derived.available);
+    TEST_ASSERT_EQUAL_UINT32(0, data.diagnostics.calculationCount);
+}
+
+/**
+ * @test Each cycle publishes one complete set: one derived version per call, counter stable after it
+ */
+void test_calculation_pipeline_publishes_once(void) {
+    CalculationEngine engine;
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.gps.available = data.compass.available = data.wind.available = data.dst.available = true;
+    data.wind.apparentWindAngle = 0.7;
+    data.wind.apparentWindSpeed = 14.0;
+    data.dst.measuredBoatSpeed = 6.0;
+    data.gps.sog = 6.0;
+
+    engine.calculate(&data, 1000);
+    TEST_ASSERT_EQUAL_UINT16(1, data.versions.derived.version());
+    uint16_t begin = data.versions.derived.readBegin();
+    TEST_ASSERT_TRUE(data.versions.derived.readValid(begin));   // Even: no write left open
+
+    DerivedData first = data.derived;
+    data.wind.apparentWindSpeed = 20.0;
+    engine.calculate(&data, 1200);
+    TEST_ASSERT_EQUAL_UINT16(2, data.versions.derived.version());
+    TEST_ASSERT_TRUE(data.derived.tws > first.tws);
+    TEST_ASSERT_EQUAL_UINT32(1200, data.derived.lastUpdate);
+
+    data.wind.available = false;   // The unavailable set is published as well
+    engine.calculate(&data, 1400);
+    TEST_ASSERT_EQUAL_UINT16(3, data.versions.derived.version());
+    TEST_ASSERT_FALSE(data.derived.available);
+}
@@ -0,0 +1,197 @@
+/**
+ * @file test_calibration_learner.cpp
+ * @brief CalibrationLearner: wind offset from tack asymmetry, leeway K regression, gates and apply thresholds
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "../../src/utils/CalibrationLearner.h"
+#include "../../src/utils/CalibrationLearner.cpp"
+
+namespace {
+
+const double DEG = 0.017453292519943295;
+
+struct LearnerInputs {
+    WindData wind;
+    CompassData compass;
+    GPSData gps;
+    DSTData dst;
+    DerivedData derived;
+};
+
+/**
+ * Close-hauled in a steady wind from 0°: true AWA ±35°, heel opposite the
+ * wind. The vane reads @p vaneError wide of the true AWA; the COG carries
+ * the leeway K * heel / speed² plus a current set of @p setDeg.
+ */
+LearnerInputs upwind(bool starboard, double vaneError, double twd, double k, double setDeg) {
+    LearnerInputs in;
+    memset(&in, 0, sizeof(in));
+    double side = starboard ? 1.0 : -1.0;
+    double trueAwa = side * 35.0 * DEG;
+    double heel = -side * 15.0 * DEG;
+    double speed = 3.0;
+    double leeway = k * heel / (speed * speed);
+
+    in.wind.apparentWindAngle = trueAwa + vaneError;
+    in.wind.available = true;
+    in.compass.magneticHeading = fmod(twd - side * 45.0 * DEG + 2.0 * M_PI, 2.0 * M_PI);
+    in.compass.heelAngle = heel;
+    in.compass.available = true;
+    in.gps.cog = in.compass.magneticHeading + leeway + setDeg * DEG;
+    in.gps.sog = speed;
+    in.gps.available = true;
+    in.dst.measuredBoatSpeed = speed;
+    in.dst.available = true;
+    in.derived.awaOffset = in.wind.apparentWindAngle;  // Offset 0 until applied
+    in.derived.wdir = twd;
+    in.derived.stw = speed;
+    return in;
+}
+
+/// @p tacks legs of @p legSeconds 1 Hz samples, starting on starboard
+void sail(CalibrationLearner& learner, uint32_t& t, int tacks, int legSeconds, double vaneError,
+          double twdPort, double twdStarboard, double k, double setDeg) {
+    for (int leg = 0; leg < tacks; leg++) {
+        bool starboard = (leg % 2) == 0;
+        LearnerInputs in = upwind(starboard, vaneError, starboard ? twdStarboard : twdPort, k, setDeg);
+        for (int i = 0; i < legSeconds; i++, t += 1000) {
+            learner.add(in.wind, in.compass, in.gps, in.dst, in.derived, t);
+        }
+    }
+}
+
+}  // namespace
+
+/**
+ * @test A vane reading 3° to starboard shows as tack asymmetry; the proposal is the -3° offset
+ */
+void test_calibration_learner_wind_offset(void) {
+    CalibrationLearner learner;
+    uint32_t t = 0;
+    sail(learner, t, 4, 300, 3.0 * DEG, 0.0, 0.0, 1.0, 0.0);
+
+    CalibrationProposal proposal;
+    learner.propose(proposal);
+    TEST_ASSERT_TRUE(proposal.windOffsetReady);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, -3.0, proposal.windAngleOffset / DEG);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 0.0, proposal.twdSplit / DEG);
+    // 30 s settle after every tack (and the first sample)
+    TEST_ASSERT_EQUAL_UINT16(2 * (300 - 30), proposal.portSamples);
+    TEST_ASSERT_EQUAL_UINT16(2 * (300 - 30), proposal.starboardSamples);
+    TEST_ASSERT_EQUAL_UINT32(1200, proposal.samples);
+
+    // Published for other tasks
+    CalibrationProposal published;
+    TEST_ASSERT_TRUE(learner.readProposal(published));
+    TEST_ASSERT_EQUAL_UINT32(0, published.samples);
+    learner.publish();
+    TEST_ASSERT_TRUE(learner.readProposal(published));
+    TEST_ASSERT_TRUE(published.windOffsetReady);
+}
+
+/**
+ * @test A wind shift between the tacks (TWD split) blocks the offset proposal
+ */
+void test_calibration_learner_wind_shift(void) {
+    CalibrationLearner learner;
+    uint32_t t = 0;
+    sail(learner, t, 4, 300, 3.0 * DEG, 350.0 * DEG, 10.0 * DEG, 1.0, 0.0);
+
+    CalibrationProposal proposal;
+    learner.propose(proposal);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 20.0, proposal.twdSplit / DEG);  // Across north
+    TEST_ASSERT_FALSE(proposal.windOffsetReady);
+
+    // One tack only: nothing to compare
+    CalibrationLearner oneTack;
+    t = 0;
+    sail(oneTack, t, 1, 600, 3.0 * DEG, 0.0, 0.0, 1.0, 0.0);
+    oneTack.propose(proposal);
+    TEST_ASSERT_FALSE(proposal.windOffsetReady);
+    TEST_ASSERT_TRUE(isnan(proposal.windAngleOffset));
+}
+
+/**
+ * @test K is the slope of leeway on heel / speed²; a current set goes into the intercept
+ */
+void test_calibration_learner_leeway_regression(void) {
+    CalibrationLearner learner;
+    uint32_t t = 0;
+    sail(learner, t, 4, 300, 0.0, 0.0, 0.0, 1.4, 2.0);
+
+    CalibrationProposal proposal;
+    learner.propose(proposal);
+    TEST_ASSERT_TRUE(proposal.leewayReady);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 1.4, proposal.leewayK);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 2.0, proposal.leewayCurrent / DEG);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1.0, proposal.leewayFit);
+    TEST_ASSERT_EQUAL_UINT16(540, proposal.portHeelSamples);
+    TEST_ASSERT_EQUAL_UINT16(540, proposal.starboardHeelSamples);
+
+    // Strong current along the track: SOG far from STW, no K samples
+    CalibrationLearner current;
+    LearnerInputs in = upwind(true, 0.0, 0.0, 1.4, 0.0);
+    in.gps.sog = in.derived.stw + 1.0;
+    t = 0;
+    for (int i = 0; i < 200; i++, t += 1000) {
+        current.add(in.wind, in.compass, in.gps, in.dst, in.derived, t);
+    }
+    current.propose(proposal);
+    TEST_ASSERT_EQUAL_UINT16(0, proposal.starboardHeelSamples);
+    TEST_ASSERT_EQUAL_UINT16(170, proposal.starboardSamples);  // The wind statistic still samples
+}
+
+/**
+ * @test Gates: unavailable inputs and low speed are skipped; halving keeps the window bounded; reset
+ */
+void test_calibration_learner_gates_and_window(void) {
+    CalibrationLearner learner;
+    LearnerInputs in = upwind(true, 0.0, 0.0, 1.0, 0.0);
+    uint32_t t = 0;
+
+    in.gps.available = false;
+    TEST_ASSERT_FALSE(learner.add(in.wind, in.compass, in.gps, in.dst, in.derived, t));
+    in.gps.available = true;
+    in.dst.measuredBoatSpeed = 1.0;
+    TEST_ASSERT_FALSE(learner.add(in.wind, in.compass, in.gps, in.dst, in.derived, t));
+    in.dst.measuredBoatSpeed = 3.0;
+    TEST_ASSERT_FALSE(learner.add(in.wind, in.compass, in.gps, in.dst, in.derived, t));  // First sample: settling
+    t += CALIB_LEARN_SETTLE_MS;
+    TEST_ASSERT_TRUE(learner.add(in.wind, in.compass, in.gps, in.dst, in.derived, t));
+
+    for (int i = 0; i < 2 * CALIB_LEARN_WINDOW; i++) {
+        t += 1000;
+        learner.add(in.wind, in.compass, in.gps, in.dst, in.derived, t);
+    }
+    CalibrationProposal proposal;
+    learner.propose(proposal);
+    TEST_ASSERT_TRUE(proposal.starboardSamples <= CALIB_LEARN_WINDOW);
+    TEST_ASSERT_TRUE(proposal.starboardSamples >= CALIB_LEARN_WINDOW / 2);
+
+    learner.requestReset();
+    learner.add(in.wind, in.compass, in.gps, in.dst, in.derived, t + 1000);
+    learner.propose(proposal);
+    TEST_ASSERT_EQUAL_UINT16(0, proposal.starboardSamples);
+    TEST_ASSERT_EQUAL_UINT32(1, proposal.samples);
+}
+
+/**
+ * @test changes() only reports ready fields that moved past the apply thresholds
+ */
+void test_calibration_learner_apply_thresholds(void) {
+    CalibrationProposal proposal;
+    memset(&proposal, 0, sizeof(proposal));
+    proposal.windAngleOffset = -3.0 * DEG;
+    proposal.leewayK = 1.4;
+
+    TEST_ASSERT_EQUAL_UINT8(0, CalibrationLearner::changes(proposal, 0.0, 1.0));  // Not ready
+    proposal.windOffsetReady = true;
+    proposal.leewayReady = true;
+    TEST_ASSERT_EQUAL_UINT8(LearnedField::WIND_OFFSET | LearnedField::LEEWAY_K,
+                            CalibrationLearner::changes(proposal, 0.0, 1.0));
+    TEST_ASSERT_EQUAL_UINT8(LearnedField::LEEWAY_K, CalibrationLearner::changes(proposal, -2.8 * DEG, 1.0));
+    TEST_ASSERT_EQUAL_UINT8(0, CalibrationLearner::changes(proposal, -3.2 * DEG, 1.36));
+}
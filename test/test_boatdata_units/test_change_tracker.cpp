@@ -0,0 +1,104 @@
+/**
+ * @file test_change_tracker.cpp
+ * @brief Unit tests for BoatDataChangeTracker (per-group dirty masks and generations)
+ */
+
+#include <unity.h>
+#include "../../src/utils/BoatDataChangeTracker.h"
+
+/**
+ * @test Fresh tracker reports no changes; each markChanged() advances the generation once
+ */
+void test_change_tracker_generation_advances_per_write(void) {
+    BoatDataChangeTracker tracker;
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getGeneration());
+    TEST_ASSERT_EQUAL_UINT16(0, tracker.changedSince(0));
+
+    tracker.markChanged(BoatDataGroup::COMPASS | BoatDataGroup::DST);
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getGeneration());
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getGroupGeneration(1));  // COMPASS
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getGroupGeneration(3));  // DST
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getGroupGeneration(0));  // GPS never written
+
+    tracker.markChanged(0);  // No groups: no new generation
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getGeneration());
+}
+
+/**
+ * @test changedSince() returns only groups written after the consumer's generation
+ */
+void test_change_tracker_dirty_mask_per_consumer(void) {
+    BoatDataChangeTracker tracker;
+    tracker.markChanged(BoatDataGroup::GPS);
+    tracker.markChanged(BoatDataGroup::WIND);
+
+    uint32_t display = tracker.getGeneration();  // Consumer A caught up
+    uint32_t stream = 0;                         // Consumer B never ran
+
+    tracker.markChanged(BoatDataGroup::ENGINE);
+
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::ENGINE, tracker.changedSince(display));
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::GPS | BoatDataGroup::WIND | BoatDataGroup::ENGINE,
+                             tracker.changedSince(stream));
+    TEST_ASSERT_EQUAL_UINT16(0, tracker.changedSince(tracker.getGeneration()));
+}
+
+/**
+ * @test Bits outside BoatDataGroup::ALL are ignored
+ */
+void test_change_tracker_ignores_unknown_groups(void) {
+    BoatDataChangeTracker tracker;
+    tracker.markChanged(0x8000);
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getGeneration());
+
+    tracker.markChanged(0x8000 | BoatDataGroup::DERIVED);
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::DERIVED, tracker.changedSince(0));
+}
+
+/**
+ * @test latestOf() moves only when one of its groups is written (REST ETag)
+ */
+void test_change_tracker_latest_of_groups(void) {
+    BoatDataChangeTracker tracker;
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.latestOf(BoatDataGroup::ALL));
+
+    tracker.markChanged(BoatDataGroup::GPS);
+    tracker.markChanged(BoatDataGroup::WIND);
+    uint32_t gpsWind = tracker.latestOf(BoatDataGroup::GPS | BoatDataGroup::WIND);
+    TEST_ASSERT_EQUAL_UINT32(2, gpsWind);
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.latestOf(BoatDataGroup::GPS));
+
+    tracker.markChanged(BoatDataGroup::ENGINE);
+    TEST_ASSERT_EQUAL_UINT32(gpsWind, tracker.latestOf(BoatDataGroup::GPS | BoatDataGroup::WIND));
+    TEST_ASSERT_EQUAL_UINT32(3, tracker.latestOf(BoatDataGroup::ALL));
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.latestOf(BoatDataGroup::RUDDER));
+
+    tracker.markChanged(BoatDataGroup::GPS);
+    TEST_ASSERT_EQUAL_UINT32(4, tracker.latestOf(BoatDataGroup::GPS | BoatDataGroup::WIND));
+}
+
+/**
+ * @test instancesChangedSince() reports only the engine and tank slots written after a generation
+ */
+void test_change_tracker_instance_slots(void) {
+    BoatDataChangeTracker tracker;
+    BoatDataInstanceMask first = {1u << 1, 0};
+    tracker.markChanged(BoatDataGroup::ENGINE, first);
+    uint32_t caughtUp = tracker.getGeneration();
+
+    BoatDataInstanceMask tank = {0, 1u << 2};
+    tracker.markChanged(BoatDataGroup::ENGINE, tank);
+
+    BoatDataInstanceMask since = tracker.instancesChangedSince(caughtUp);
+    TEST_ASSERT_EQUAL_UINT8(0, since.engines);
+    TEST_ASSERT_EQUAL_UINT8(1u << 2, since.tanks);
+
+    BoatDataInstanceMask all = tracker.instancesChangedSince(0);
+    TEST_ASSERT_EQUAL_UINT8(1u << 1, all.engines);
+    TEST_ASSERT_EQUAL_UINT8(1u << 2, all.tanks);
+    TEST_ASSERT_FALSE(tracker.instancesChangedSince(tracker.getGeneration()).any());
+
+    // Group-only writes leave the slots alone
+    tracker.markChanged(BoatDataGroup::ENGINE);
+    TEST_ASSERT_FALSE(tracker.instancesChangedSince(caughtUp + 1).any());
+}
@@ -0,0 +1,154 @@
+/**
+ * @file test_damping_filters.cpp
+ * @brief Damping filters (EMA, circular mean, Kalman) and the CalculationEngine filter stage
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/DampingFilters.h"
+#include "../../src/utils/DampingFilters.cpp"
+#include "../../src/components/CalculationEngine.h"
+
+namespace {
+
+DampingConfig dampingOf(DampingField field, float tau, bool kalman = false) {
+    DampingConfig config;
+    memset(&config, 0, sizeof(config));
+    config.timeConstant[field] = tau;
+    if (kalman) {
+        config.kalmanMask = static_cast<uint16_t>(1u << field);
+    }
+    return config;
+}
+
+/// Angular distance (radians)
+double angleDistance(double a, double b) {
+    return std::fabs(std::remainder(a - b, 2.0 * M_PI));
+}
+
+}  // namespace
+
+/**
+ * @test EMA step response reaches ~63% after one time constant, independent of the sample rate
+ */
+void test_damping_ema_time_constant(void) {
+    const uint32_t periods[] = {10, 100, 250};
+    for (uint32_t periodMs : periods) {
+        DampingFilters filters;
+        DampingConfig config = dampingOf(DAMPING_AWS, 2.0f);
+
+        filters.apply(DAMPING_AWS, 0.0, config, 0);
+        BoatScalar out = 0.0;
+        for (uint32_t t = periodMs; t <= 2000; t += periodMs) {
+            out = filters.apply(DAMPING_AWS, 10.0, config, t);
+        }
+        TEST_ASSERT_FLOAT_WITHIN(0.5, 6.32, out);
+    }
+}
+
+/**
+ * @test Circular mean averages across the ±π and 0/2π seams
+ */
+void test_damping_circular_wraps(void) {
+    DampingFilters filters;
+    DampingConfig config = dampingOf(DAMPING_HEADING, 1.0f);
+    config.timeConstant[DAMPING_AWA] = 1.0f;
+
+    const double deg = M_PI / 180.0;
+    BoatScalar heading = 0.0;
+    BoatScalar awa = 0.0;
+    for (uint32_t i = 0; i < 100; i++) {
+        bool odd = (i & 1) != 0;
+        heading = filters.apply(DAMPING_HEADING, (odd ? 350.0 : 10.0) * deg, config, i * 100);
+        awa = filters.apply(DAMPING_AWA, (odd ? 170.0 : -170.0) * deg, config, i * 100);
+
+        TEST_ASSERT_TRUE(heading >= 0.0 && heading < 2.0 * M_PI);
+        TEST_ASSERT_TRUE(awa >= -M_PI && awa <= M_PI);
+    }
+    TEST_ASSERT_TRUE(angleDistance(0.0, heading) < 1.0 * deg);
+    TEST_ASSERT_TRUE(angleDistance(M_PI, awa) < 1.0 * deg);
+}
+
+/**
+ * @test Kalman damps like an EMA in steady state and follows at once after a data gap
+ */
+void test_damping_kalman_converges(void) {
+    DampingFilters filters;
+    DampingConfig config = dampingOf(DAMPING_BOAT_SPEED, 2.0f, true);
+
+    uint32_t t = 0;
+    for (; t <= 20000; t += 100) {
+        filters.apply(DAMPING_BOAT_SPEED, 5.0, config, t);
+    }
+    BoatScalar out = 5.0;
+    for (uint32_t end = t + 2000; t <= end; t += 100) {
+        out = filters.apply(DAMPING_BOAT_SPEED, 6.0, config, t);
+    }
+    TEST_ASSERT_TRUE(out > 5.4 && out < 5.9);
+
+    // 30 s without samples: the covariance has grown, so the estimate jumps
+    out = filters.apply(DAMPING_BOAT_SPEED, 3.0, config, t + 30000);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 3.0, out);
+
+    // The Kalman mask only applies to scalar fields
+    DampingConfig angular = dampingOf(DAMPING_AWA, 2.0f, true);
+    filters.apply(DAMPING_AWA, 0.0, angular, 0);
+    out = filters.apply(DAMPING_AWA, 1.0, angular, 30000);
+    TEST_ASSERT_TRUE(out < 1.0);
+}
+
+/**
+ * @test Time constant 0 passes values through unchanged and re-enabling starts fresh
+ */
+void test_damping_off_passthrough(void) {
+    DampingFilters filters;
+    DampingConfig off;
+    memset(&off, 0, sizeof(off));
+    DampingConfig on = dampingOf(DAMPING_TWS, 5.0f);
+
+    const BoatScalar precise = static_cast<BoatScalar>(12.345678901);
+    TEST_ASSERT_TRUE(filters.apply(DAMPING_TWS, precise, off, 0) == precise);
+
+    filters.apply(DAMPING_TWS, 1.0, on, 100);
+    filters.apply(DAMPING_TWS, 1.0, off, 200);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 9.0, filters.apply(DAMPING_TWS, 9.0, on, 300));
+
+    // Non-finite samples pass through without disturbing the state
+    TEST_ASSERT_TRUE(std::isnan(filters.apply(DAMPING_TWS, NAN, on, 400)));
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 9.0, filters.apply(DAMPING_TWS, 9.0, on, 500));
+
+    TEST_ASSERT_EQUAL_STRING("boatSpeed", DampingFilters::key(DAMPING_BOAT_SPEED));
+    TEST_ASSERT_EQUAL_UINT8(DAMPING_KIND_BEARING, DampingFilters::kind(DAMPING_WDIR));
+}
+
+/**
+ * @test CalculationEngine damps its inputs and outputs but leaves the sensor values raw
+ */
+void test_damping_calculation_stage(void) {
+    CalculationEngine engine;
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.gps.available = data.compass.available = data.wind.available = data.dst.available = true;
+    data.calibration.leewayCalibrationFactor = 10.0;
+    data.wind.apparentWindAngle = 0.8;
+    data.wind.apparentWindSpeed = 10.0;
+    data.dst.measuredBoatSpeed = 5.0;
+    data.compass.magneticHeading = 1.0;
+    data.calibration.damping.timeConstant[DAMPING_AWS] = 30.0f;
+
+    engine.calculate(&data);
+    BoatScalar twsBefore = data.derived.tws;
+
+    // AWS step: damped input moves the TWS only a little
+    data.wind.apparentWindSpeed = 20.0;
+    engine.calculate(&data);
+    TEST_ASSERT_EQUAL_FLOAT(20.0, data.wind.apparentWindSpeed);
+    TEST_ASSERT_TRUE(data.derived.tws - twsBefore < 0.5);
+
+    // Inputs going stale reset the filters; the next cycle sees the raw step
+    data.wind.available = false;
+    engine.calculate(&data);
+    data.wind.available = true;
+    engine.calculate(&data);
+    TEST_ASSERT_TRUE(data.derived.tws - twsBefore > 5.0);
+}
@@ -0,0 +1,281 @@
+/**
+ * @file test_data_tables.cpp
+ * @brief Tables partition image: directory checks, binary polar, variation grid and its fallback policy
+ *
+ * ConfigRecord.cpp (CRC-32) is compiled in through test_onewire_device_map.cpp,
+ * PolarTable.cpp through test_polar_table.cpp.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <math.h>
+#include "../../src/utils/DataTables.h"
+#include "../../src/utils/DataTables.cpp"
+#include "../../src/utils/VariationGrid.h"
+#include "../../src/utils/VariationGrid.cpp"
+#include "../../src/utils/PolarTable.h"
+#include "../../src/utils/ConfigRecord.h"
+
+namespace {
+
+const double DEG = 0.017453292519943295;
+
+/**
+ * @brief Little-endian image writer (the layout of tools/data_tables.py)
+ */
+struct ImageBuilder {
+    uint8_t bytes[4096];
+    size_t size;
+    uint16_t count;
+    const uint8_t* payloads[4];
+    size_t lengths[4];
+    uint16_t types[4];
+    const char* names[4];
+
+    ImageBuilder() : size(0), count(0) { memset(bytes, 0, sizeof(bytes)); }
+
+    void add(const char* name, DataTableType type, const uint8_t* payload, size_t length) {
+        names[count] = name;
+        types[count] = static_cast<uint16_t>(type);
+        payloads[count] = payload;
+        lengths[count] = length;
+        count++;
+    }
+
+    static void putU16(uint8_t* p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+    static void putU32(uint8_t* p, uint32_t v) {
+        for (int i = 0; i < 4; i++) p[i] = static_cast<uint8_t>(v >> (8 * i));
+    }
+
+    /// @param misalign Extra byte before every payload (unaligned reads)
+    size_t build(uint16_t version, bool misalign) {
+        size_t offset = DATA_TABLES_HEADER_BYTES + count * DATA_TABLES_ENTRY_BYTES;
+        for (uint16_t i = 0; i < count; i++) {
+            offset += misalign ? 1 : 0;
+            uint8_t* e = bytes + DATA_TABLES_HEADER_BYTES + i * DATA_TABLES_ENTRY_BYTES;
+            strncpy(reinterpret_cast<char*>(e), names[i], DATA_TABLES_NAME_MAX);
+            putU16(e + 12, types[i]);
+            putU16(e + 14, version);
+            putU32(e + 16, static_cast<uint32_t>(offset));
+            putU32(e + 20, static_cast<uint32_t>(lengths[i]));
+            putU32(e + 24, ConfigCrc32(payloads[i], lengths[i]));
+            memcpy(bytes + offset, payloads[i], lengths[i]);
+            offset += lengths[i];
+        }
+        putU32(bytes, DATA_TABLES_MAGIC);
+        putU16(bytes + 4, DATA_TABLES_FORMAT);
+        putU16(bytes + 6, count);
+        putU32(bytes + 8, static_cast<uint32_t>(offset));
+        putU32(bytes + 12, ConfigCrc32(bytes + DATA_TABLES_HEADER_BYTES, count * DATA_TABLES_ENTRY_BYTES));
+        size = offset;
+        return size;
+    }
+};
+
+void putF32(uint8_t*& p, float v) {
+    memcpy(p, &v, 4);
+    p += 4;
+}
+
+/// 3 TWS x 2 TWA polar, the same grid as the text "twa/tws 6 8 10 / 52 ... / 150 ..."
+size_t polarPayload(uint8_t* out) {
+    const float tws[] = {6.0f, 8.0f, 10.0f};
+    const float twa[] = {52.0f, 150.0f};
+    const float speed[] = {5.5f, 6.3f, 6.8f, 4.3f, 5.3f, 6.3f};
+    uint8_t* p = out;
+    *p++ = 3;
+    *p++ = 2;
+    *p++ = 0;
+    *p++ = 0;
+    for (float v : tws) putF32(p, v);
+    for (float v : twa) putF32(p, v);
+    for (float v : speed) putF32(p, v);
+    return static_cast<size_t>(p - out);
+}
+
+/// 3 x 4 grid from 40N 10W, 1 degree, variation = lat - 40 + 0.5 * (lon + 10) degrees
+size_t variationPayload(uint8_t* out, float lon0, uint16_t cols, float step) {
+    uint8_t* p = out;
+    putF32(p, 40.0f);
+    putF32(p, lon0);
+    putF32(p, step);
+    ImageBuilder::putU16(p, 3);
+    ImageBuilder::putU16(p + 2, cols);
+    p += 4;
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < cols; c++) {
+            int16_t centideg = static_cast<int16_t>((r + 0.5 * c) * 100);
+            ImageBuilder::putU16(p, static_cast<uint16_t>(centideg));
+            p += 2;
+        }
+    }
+    return static_cast<size_t>(p - out);
+}
+
+GPSData freshFix(double lat, double lon, uint32_t nowMs) {
+    GPSData gps = {};
+    gps.latitude = lat;
+    gps.longitude = lon;
+    gps.available = true;
+    gps.lastUpdate = nowMs;
+    return gps;
+}
+
+}  // namespace
+
+/**
+ * @test A valid image opens and finds its tables in place; damage anywhere rejects it as a whole
+ */
+void test_data_tables_directory(void) {
+    uint8_t polar[128];
+    size_t polarLength = polarPayload(polar);
+    ImageBuilder image;
+    image.add("polar", DataTableType::POLAR, polar, polarLength);
+    image.build(POLAR_TABLE_VERSION, false);
+
+    DataTables tables;
+    TEST_ASSERT_EQUAL(DataTablesStatus::OK, tables.open(image.bytes, sizeof(image.bytes)));
+    TEST_ASSERT_EQUAL_UINT16(1, tables.count());
+    DataTableView view = {};
+    TEST_ASSERT_TRUE(tables.find(DataTableType::POLAR, view));
+    TEST_ASSERT_EQUAL_PTR(image.bytes + DATA_TABLES_HEADER_BYTES + DATA_TABLES_ENTRY_BYTES, view.data);
+    TEST_ASSERT_EQUAL_UINT32(polarLength, view.length);
+    TEST_ASSERT_FALSE(tables.find(DataTableType::VARIATION, view));
+
+    // Erased flash and no partition are "empty", not errors
+    uint8_t erased[64];
+    memset(erased, 0xFF, sizeof(erased));
+    TEST_ASSERT_EQUAL(DataTablesStatus::EMPTY, tables.open(erased, sizeof(erased)));
+    TEST_ASSERT_EQUAL(DataTablesStatus::EMPTY, tables.open(nullptr, 0));
+    TEST_ASSERT_FALSE(tables.find(DataTableType::POLAR, view));
+
+    // Partition smaller than the image
+    TEST_ASSERT_EQUAL(DataTablesStatus::TRUNCATED, tables.open(image.bytes, image.size - 1));
+
+    // A flipped payload byte fails its entry CRC
+    image.bytes[image.size - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL(DataTablesStatus::BAD_CRC, tables.open(image.bytes, sizeof(image.bytes)));
+    TEST_ASSERT_EQUAL_UINT16(0, tables.count());
+    image.bytes[image.size - 1] ^= 0x01;
+
+    // A future directory layout is refused
+    image.bytes[4] = DATA_TABLES_FORMAT + 1;
+    TEST_ASSERT_EQUAL(DataTablesStatus::BAD_FORMAT, tables.open(image.bytes, sizeof(image.bytes)));
+    image.bytes[4] = DATA_TABLES_FORMAT;
+
+    image.bytes[0] = 'X';
+    TEST_ASSERT_EQUAL(DataTablesStatus::BAD_MAGIC, tables.open(image.bytes, sizeof(image.bytes)));
+    TEST_ASSERT_EQUAL_STRING("bad_magic", DataTablesStatusName(tables.getStatus()));
+}
+
+/**
+ * @test The binary polar, read unaligned from the image, matches the same grid parsed as text
+ */
+void test_data_tables_polar_matches_text(void) {
+    uint8_t payload[128];
+    size_t length = polarPayload(payload);
+    ImageBuilder image;
+    image.add("polar", DataTableType::POLAR, payload, length);
+    image.build(POLAR_TABLE_VERSION, true);
+
+    DataTables tables;
+    TEST_ASSERT_EQUAL(DataTablesStatus::OK, tables.open(image.bytes, image.size));
+    DataTableView view = {};
+    TEST_ASSERT_TRUE(tables.find(DataTableType::POLAR, view));
+    TEST_ASSERT_EQUAL_UINT16(POLAR_TABLE_VERSION, view.version);
+
+    PolarTable binary;
+    TEST_ASSERT_TRUE(binary.loadBinary(view.data, view.length));
+    PolarTable text;
+    TEST_ASSERT_TRUE(text.parse("twa/tws 6 8 10\n52 5.5 6.3 6.8\n150 4.3 5.3 6.3\n"));
+
+    TEST_ASSERT_EQUAL_UINT8(text.twsCount(), binary.twsCount());   // Implicit zeros as for text
+    TEST_ASSERT_EQUAL_UINT8(text.twaCount(), binary.twaCount());
+    for (float tws = 0.0f; tws <= 12.0f; tws += 0.7f) {
+        for (float twa = 0.0f; twa <= 180.0f; twa += 13.0f) {
+            TEST_ASSERT_EQUAL_FLOAT(text.targetSpeed(tws, twa * DEG), binary.targetSpeed(tws, twa * DEG));
+        }
+    }
+
+    // Cut short, or descending TWA: the same validation as the text form
+    TEST_ASSERT_FALSE(binary.loadBinary(view.data, view.length - 4));
+    TEST_ASSERT_FALSE(binary.loaded());
+    float descending = 160.0f;
+    memcpy(payload + 4 + 3 * 4, &descending, 4);
+    TEST_ASSERT_FALSE(binary.loadBinary(payload, length));
+    TEST_ASSERT_EQUAL_STRING("row: TWA must be ascending within [0, 180]", binary.error());
+}
+
+/**
+ * @test Bilinear lookup inside the grid, nothing outside it, wrap-around on a 360-degree grid
+ */
+void test_variation_grid_lookup(void) {
+    uint8_t payload[256];
+    DataTableView view = {payload, 0, VARIATION_GRID_VERSION};
+    view.length = static_cast<uint32_t>(variationPayload(payload, -10.0f, 4, 1.0f));
+
+    VariationGrid grid;
+    TEST_ASSERT_TRUE(grid.attach(view));
+    double variation = 0.0;
+    TEST_ASSERT_TRUE(grid.lookup(40.0, -10.0, variation));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.0, variation);
+    TEST_ASSERT_TRUE(grid.lookup(41.5, -8.5, variation));   // 1.5 + 0.5 * 1.5
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 2.25 * DEG, variation);
+    TEST_ASSERT_TRUE(grid.lookup(42.0, -7.0, variation));   // North-east corner
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 3.5 * DEG, variation);
+    TEST_ASSERT_FALSE(grid.lookup(39.9, -9.0, variation));
+    TEST_ASSERT_FALSE(grid.lookup(41.0, -6.9, variation));
+
+    // 4 columns of 90 degrees: the cell east of 90E interpolates back into column 0
+    view.length = static_cast<uint32_t>(variationPayload(payload, -180.0f, 4, 90.0f));
+    TEST_ASSERT_TRUE(grid.attach(view));
+    TEST_ASSERT_TRUE(grid.lookup(40.0, 135.0, variation));  // Halfway between 1.5 deg and 0
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 0.75 * DEG, variation);
+    TEST_ASSERT_TRUE(grid.lookup(40.0, 180.0, variation));  // Same point as -180
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 0.0, variation);
+
+    // Wrong version or a payload shorter than its grid
+    view.version = VARIATION_GRID_VERSION + 1;
+    TEST_ASSERT_FALSE(grid.attach(view));
+    TEST_ASSERT_FALSE(grid.lookup(40.0, -10.0, variation));
+    view.version = VARIATION_GRID_VERSION;
+    view.length -= 2;
+    TEST_ASSERT_FALSE(grid.attach(view));
+}
+
+/**
+ * @test The grid fills in only with a live GPS fix and stops for good once a source sets variation
+ */
+void test_variation_grid_fallback(void) {
+    uint8_t payload[256];
+    DataTableView view = {payload, 0, VARIATION_GRID_VERSION};
+    view.length = static_cast<uint32_t>(variationPayload(payload, -10.0f, 4, 1.0f));
+    VariationGrid grid;
+    TEST_ASSERT_TRUE(grid.attach(view));
+
+    // No fix yet, then a fix that stopped updating
+    double variation = 0.0;
+    GPSData gps = {};
+    TEST_ASSERT_FALSE(grid.fallback(gps, 1000, variation));
+    gps = freshFix(41.0, -9.0, 1000);
+    TEST_ASSERT_FALSE(grid.fallback(gps, 1000 + VARIATION_GRID_GPS_FRESH_MS + 1, variation));
+
+    // Live fix, variation still the boot default: the grid writes
+    TEST_ASSERT_TRUE(grid.fallback(gps, 1500, variation));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.5 * DEG, variation);
+    gps.variation = static_cast<BoatScalar>(variation);
+
+    // Same cell: nothing new to write; moved: written again
+    TEST_ASSERT_FALSE(grid.fallback(gps, 2000, variation));
+    gps.latitude = 42.0;
+    TEST_ASSERT_TRUE(grid.fallback(gps, 2500, variation));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 2.5 * DEG, variation);
+    TEST_ASSERT_EQUAL_UINT32(2, grid.getWrites());
+
+    // A source's own value is never overwritten
+    gps.variation = static_cast<BoatScalar>(-3.0 * DEG);
+    gps.latitude = 40.0;
+    TEST_ASSERT_FALSE(grid.fallback(gps, 3000, variation));
+    TEST_ASSERT_TRUE(grid.isSourceSeen());
+    TEST_ASSERT_FALSE(grid.fallback(gps, 60000, variation));
+}
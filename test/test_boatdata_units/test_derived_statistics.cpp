@@ -0,0 +1,145 @@
+/**
+ * @file test_derived_statistics.cpp
+ * @brief Sliding-window averages, circular means, gust maxima and the CalculationEngine statistics stage
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/DerivedStatistics.h"
+#include "../../src/utils/DerivedStatistics.cpp"
+#include "../../src/components/CalculationEngine.h"
+
+namespace {
+
+const double DEG = 0.017453292519943295;
+
+DerivedData derivedOf(double tws, double wdir, double vmg) {
+    DerivedData derived;
+    memset(&derived, 0, sizeof(derived));
+    derived.tws = tws;
+    derived.wdir = wdir;
+    derived.vmg = vmg;
+    return derived;
+}
+
+}  // namespace
+
+/**
+ * @test Each window averages only its own span of samples
+ */
+void test_derived_statistics_window_means(void) {
+    DerivedStatistics stats;
+    DerivedData derived;
+    for (uint32_t t = 0; t < 30000; t += 100) {
+        derived = derivedOf(t < 20000 ? 10.0 : 20.0, 1.0, t < 20000 ? 4.0 : -2.0);
+        stats.update(derived, t);
+    }
+
+    // 10 s: only the last 10 s (all 20 kn); 1 min and 10 min: all 300 samples
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 20.0, derived.twsAvg10s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, -2.0, derived.vmgAvg10s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, (200 * 10.0 + 100 * 20.0) / 300, derived.twsAvg1m);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, (200 * 4.0 - 100 * 2.0) / 300, derived.vmgAvg10m);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 1.0, derived.wdirAvg1m);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 20.0, derived.gust10m);
+    TEST_ASSERT_EQUAL_UINT32(600000, DerivedStatistics::windowMs(2));
+}
+
+/**
+ * @test Wind directions average on the circle
+ */
+void test_derived_statistics_circular_mean(void) {
+    DerivedStatistics stats;
+    DerivedData derived;
+    for (uint32_t t = 0; t < 5000; t += 100) {
+        derived = derivedOf(10.0, (t / 100) % 2 ? 350.0 * DEG : 20.0 * DEG, 0.0);
+        stats.update(derived, t);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 5.0 * DEG, derived.wdirAvg10s);
+    TEST_ASSERT_TRUE(derived.wdirAvg10s >= 0.0 && derived.wdirAvg10s < 2.0 * M_PI);
+}
+
+/**
+ * @test The deque maximum and running sums match a brute-force scan of the same buckets
+ */
+void test_derived_statistics_matches_brute_force(void) {
+    const uint32_t bucketMs = 500;
+    const uint32_t stepMs = 70;
+    const uint16_t steps = 2000;
+    static float tws[steps];
+
+    StatsWindow window;
+    window.begin(bucketMs);
+    uint32_t seed = 12345;
+    for (uint16_t i = 0; i < steps; i++) {
+        seed = seed * 1103515245u + 12345u;
+        tws[i] = 5.0f + static_cast<float>((seed >> 16) % 2000) / 100.0f;
+        uint32_t t = 1000 + i * stepMs;
+        window.add(t, tws[i], 0.5f, tws[i] * 0.5f);
+
+        // Open bucket plus the STATS_WINDOW_BUCKETS - 1 before it
+        uint32_t openStart = 1000 + (i * stepMs) / bucketMs * bucketMs;
+        int32_t from = static_cast<int32_t>(openStart) - static_cast<int32_t>((STATS_WINDOW_BUCKETS - 1) * bucketMs);
+        float maxTws = -1.0f;
+        double sum = 0.0;
+        uint16_t n = 0;
+        for (uint16_t j = 0; j <= i; j++) {
+            if (static_cast<int32_t>(1000 + j * stepMs) >= from) {
+                maxTws = tws[j] > maxTws ? tws[j] : maxTws;
+                sum += tws[j];
+                n++;
+            }
+        }
+
+        StatsResult r;
+        window.result(r);
+        TEST_ASSERT_EQUAL_FLOAT(maxTws, r.gust);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3, sum / n, r.twsAvg);
+        TEST_ASSERT_FLOAT_WITHIN(1e-3, sum / n * 0.5, r.vmgAvg);
+    }
+}
+
+/**
+ * @test A dropout ages out of the windows instead of freezing them; NaN samples are skipped
+ */
+void test_derived_statistics_dropout(void) {
+    DerivedStatistics stats;
+    DerivedData derived;
+    for (uint32_t t = 0; t < 5000; t += 100) {
+        derived = derivedOf(12.0, 2.0, 3.0);
+        stats.update(derived, t);
+    }
+
+    derived = derivedOf(NAN, NAN, NAN);
+    stats.update(derived, 5000 + 11000);
+    TEST_ASSERT_TRUE(isnan(derived.twsAvg10s));
+    TEST_ASSERT_TRUE(isnan(derived.gust10s));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 12.0, derived.twsAvg1m);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 12.0, derived.gust1m);
+
+    derived = derivedOf(8.0, 2.0, 3.0);
+    stats.update(derived, 5000 + 11100);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 8.0, derived.twsAvg10s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, (50 * 12.0 + 8.0) / 51, derived.twsAvg1m);
+}
+
+/**
+ * @test CalculationEngine publishes the windows for the damped TWS
+ */
+void test_derived_statistics_calculation_stage(void) {
+    CalculationEngine engine;
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.gps.available = data.compass.available = data.wind.available = data.dst.available = true;
+    data.calibration.leewayCalibrationFactor = 10.0;
+    data.wind.apparentWindAngle = 0.7;
+    data.wind.apparentWindSpeed = 15.0;
+    data.dst.measuredBoatSpeed = 6.0;
+
+    engine.calculate(&data);
+    const DerivedData& d = data.derived;
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, d.tws, d.twsAvg10s);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, d.tws, d.gust10m);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, d.vmg, d.vmgAvg1m);
+    TEST_ASSERT_TRUE(std::fabs(std::remainder(d.wdirAvg10s - d.wdir, 2.0 * M_PI)) < 1e-4);
+}
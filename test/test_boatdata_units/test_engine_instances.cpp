@@ -0,0 +1,135 @@
+/**
+ * @file test_engine_instances.cpp
+ * @brief Engine and tank slots: per-instance patches, staleness and delta output
+ *
+ * BoatData.cpp is compiled in through test_source_handles.cpp,
+ * BoatDataDelta.cpp through test_boatdata_delta.cpp.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/components/BoatData.h"
+#include "../../src/utils/BoatDataDelta.h"
+
+namespace {
+
+EngineData engineAt(double rpm) {
+    EngineData values = {};
+    values.engineRev = rpm;
+    values.available = true;
+    return values;
+}
+
+TankData tank(uint8_t fluidType, uint8_t instance, double level) {
+    TankData values = {};
+    values.fluidType = fluidType;
+    values.instance = instance;
+    values.level = level;
+    values.capacity = NAN;
+    values.available = true;
+    return values;
+}
+
+}  // namespace
+
+/**
+ * @test A second engine gets its own slot; only the primary writes the single-engine group
+ */
+void test_engine_instances_keep_engines_apart(void) {
+    BoatData boatData(nullptr);
+    boatData.patchEngine(EngineField::ENGINE_REV, engineAt(1800.0), N2K_ENGINE_PRIMARY_INSTANCE);
+    uint32_t generation = boatData.getChanges().getGeneration();
+    boatData.patchEngine(EngineField::ENGINE_REV, engineAt(2200.0), 1);
+    boatData.patchEngine(EngineField::ENGINE_REV, engineAt(900.0), BOATDATA_ENGINE_INSTANCES);  // No slot: dropped
+
+    BoatDataInstances instances;
+    boatData.getInstances(instances);
+    TEST_ASSERT_EQUAL_UINT8(0x03, instances.enginesSeen);
+    TEST_ASSERT_EQUAL_DOUBLE(1800.0, instances.engines[0].engineRev);
+    TEST_ASSERT_EQUAL_DOUBLE(2200.0, instances.engines[1].engineRev);
+    TEST_ASSERT_TRUE(instances.engines[1].available);
+    TEST_ASSERT_EQUAL_DOUBLE(1800.0, boatData.getDataStructure()->engine.engineRev);
+
+    BoatDataInstanceMask changed = boatData.getChanges().instancesChangedSince(generation);
+    TEST_ASSERT_EQUAL_UINT8(1u << 1, changed.engines);
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::ENGINE, boatData.getChanges().changedSince(generation));
+}
+
+/**
+ * @test Tanks are keyed by fluid type and instance; a full table drops new tanks
+ */
+void test_engine_instances_tank_slots(void) {
+    BoatData boatData(nullptr);
+    boatData.patchTank(TankField::LEVEL, tank(0, 0, 50.0));   // Fuel 0
+    boatData.patchTank(TankField::LEVEL, tank(1, 0, 80.0));   // Fresh water 0
+    boatData.patchTank(TankField::LEVEL, tank(0, 0, 49.0));   // Fuel 0 again
+
+    BoatDataInstances instances;
+    boatData.getInstances(instances);
+    TEST_ASSERT_EQUAL_UINT8(2, instances.tankCount);
+    TEST_ASSERT_EQUAL_DOUBLE(49.0, instances.tanks[0].level);
+    TEST_ASSERT_EQUAL_UINT8(1, instances.tanks[1].fluidType);
+    TEST_ASSERT_TRUE(isnan(instances.tanks[1].capacity));  // Never reported
+
+    for (uint8_t i = 1; i <= BOATDATA_TANK_INSTANCES; i++) {
+        boatData.patchTank(TankField::LEVEL, tank(2, i, 10.0));
+    }
+    boatData.getInstances(instances);
+    TEST_ASSERT_EQUAL_UINT8(BOATDATA_TANK_INSTANCES, instances.tankCount);
+}
+
+/**
+ * @test A slot not updated within BOATDATA_STALE_ENGINE_MS expires as the ENGINE group
+ */
+void test_engine_instances_expire(void) {
+    BoatData boatData(nullptr);
+    boatData.patchTank(TankField::LEVEL, tank(0, 0, 50.0));
+    BoatDataStructure* data = boatData.getDataStructure();
+    data->instances.tanks[0].lastUpdate = 1000;
+    uint32_t generation = boatData.getChanges().getGeneration();
+
+    uint16_t expired = boatData.sweepStale(1001 + BOATDATA_STALE_ENGINE_MS);
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::ENGINE, expired & BoatDataGroup::ENGINE);
+    TEST_ASSERT_FALSE(data->instances.tanks[0].available);
+    TEST_ASSERT_EQUAL_UINT8(1u << 0, boatData.getChanges().instancesChangedSince(generation).tanks);
+}
+
+/**
+ * @test Deltas carry only the slots that moved a deadband; keyframes carry every assigned slot
+ */
+void test_engine_instances_delta(void) {
+    BoatDataDeltaEncoder encoder;
+    static BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.instances.engines[0] = engineAt(1800.0);
+    data.instances.engines[1] = engineAt(2200.0);
+    data.instances.enginesSeen = 0x03;
+    data.instances.tanks[0] = tank(0, 0, 50.0);
+    data.instances.tankCount = 1;
+
+    StaticJsonWriter<4096> key;
+    BoatDataDeltaSet set;
+    TEST_ASSERT_TRUE(encoder.update(data, BoatDataGroup::ALL, BoatDataInstanceMask{0, 0}, 1, 1000, set));
+    BoatDataDeltaEncoder::writeJson(key, data, set);
+    TEST_ASSERT_NOT_NULL(strstr(key.c_str(), "\"engines\":[{\"instance\":0,\"engineRev\":1800,"));
+    TEST_ASSERT_NOT_NULL(strstr(key.c_str(), "{\"instance\":1,\"engineRev\":2200,"));
+    TEST_ASSERT_NOT_NULL(strstr(key.c_str(), "\"tanks\":[{\"fluidType\":0,\"instance\":0,\"level\":50.0,\"capacity\":null,"));
+
+    // Engine 1 moves, engine 0 is written but below its deadband
+    data.instances.engines[0].engineRev = 1800.5;
+    data.instances.engines[1].engineRev = 2350.0;
+    TEST_ASSERT_FALSE(encoder.update(data, BoatDataGroup::ENGINE, BoatDataInstanceMask{0x03, 0}, 2, 2000, set));
+    TEST_ASSERT_EQUAL_UINT8(1u << 1, set.instances.engines);
+    TEST_ASSERT_FALSE(set.empty());
+
+    StaticJsonWriter<512> delta;
+    BoatDataDeltaEncoder::writeJson(delta, data, set);
+    TEST_ASSERT_NOT_NULL(strstr(delta.c_str(), "\"engines\":[{\"instance\":1,\"engineRev\":2350,"));
+    TEST_ASSERT_NULL(strstr(delta.c_str(), "\"instance\":0"));
+    TEST_ASSERT_NULL(strstr(delta.c_str(), "tanks"));
+
+    // A change outside the reported slots is not compared
+    data.instances.tanks[0].level = 20.0;
+    encoder.update(data, BoatDataGroup::ENGINE, BoatDataInstanceMask{0, 0}, 3, 3000, set);
+    TEST_ASSERT_TRUE(set.empty());
+}
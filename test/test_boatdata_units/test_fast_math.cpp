@@ -0,0 +1,74 @@
+/**
+ * @file test_fast_math.cpp
+ * @brief Accuracy contract of the FastMath kernels (see FastMath.h)
+ */
+
+#include <unity.h>
+#include "../../src/utils/FastMath.h"
+
+namespace {
+
+/// Angular distance between two results of atan2 (±π are the same angle)
+double angleError(double a, double b) {
+    double d = std::fabs(a - b);
+    return d > M_PI ? 2.0 * M_PI - d : d;
+}
+
+}  // namespace
+
+/**
+ * @test sin/cos/sincos stay within 3e-6 on |x| <= 64; larger arguments use libm
+ */
+void test_fast_math_sin_cos_error_bound(void) {
+    double maxSin = 0.0;
+    double maxCos = 0.0;
+    for (double x = -64.0; x <= 64.0; x += 1e-3) {
+        float xf = static_cast<float>(x);
+        float s, c;
+        FastMath::sincos(xf, s, c);
+        maxSin = std::fmax(maxSin, std::fabs(s - std::sin(static_cast<double>(xf))));
+        maxCos = std::fmax(maxCos, std::fabs(c - std::cos(static_cast<double>(xf))));
+        TEST_ASSERT_EQUAL_FLOAT(s, FastMath::sin(xf));
+        TEST_ASSERT_EQUAL_FLOAT(c, FastMath::cos(xf));
+    }
+    TEST_ASSERT_TRUE(maxSin < 3e-6);
+    TEST_ASSERT_TRUE(maxCos < 3e-6);
+
+    TEST_ASSERT_EQUAL_FLOAT(std::sin(1000.0f), FastMath::sin(1000.0f));
+    TEST_ASSERT_TRUE(std::isnan(FastMath::cos(NAN)));
+}
+
+/**
+ * @test atan2 stays within 3e-6 rad in every octant and at any magnitude
+ */
+void test_fast_math_atan2_error_bound(void) {
+    const double radii[] = {1e-3, 1.0, 40.0};
+    double maxError = 0.0;
+    for (double r : radii) {
+        for (double t = -M_PI; t <= M_PI; t += 1e-4) {
+            float y = static_cast<float>(r * std::sin(t));
+            float x = static_cast<float>(r * std::cos(t));
+            maxError = std::fmax(maxError, angleError(FastMath::atan2(y, x), std::atan2(static_cast<double>(y), static_cast<double>(x))));
+        }
+    }
+    TEST_ASSERT_TRUE(maxError < 3e-6);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, FastMath::atan2(0.0f, 1.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, FastMath::PI_F, FastMath::atan2(0.0f, -1.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, -FastMath::HALF_PI_F, FastMath::atan2(-2.0f, 0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, FastMath::atan2(0.0f, 0.0f));
+    TEST_ASSERT_TRUE(std::isnan(FastMath::atan2(NAN, 1.0f)));
+}
+
+/**
+ * @test Table lookup stays within 1e-4 (FASTMATH_LUT_SIZE 256)
+ */
+void test_fast_math_lut_error_bound(void) {
+    double maxError = 0.0;
+    for (double x = -64.0; x <= 64.0; x += 1e-3) {
+        float xf = static_cast<float>(x);
+        maxError = std::fmax(maxError, std::fabs(FastMath::sinLut(xf) - std::sin(static_cast<double>(xf))));
+        maxError = std::fmax(maxError, std::fabs(FastMath::cosLut(xf) - std::cos(static_cast<double>(xf))));
+    }
+    TEST_ASSERT_TRUE(maxError < 1e-4);
+}
@@ -0,0 +1,104 @@
+/**
+ * @file test_field_range.cpp
+ * @brief FieldRange: compile-time ranges from the schema, clamp/wrap/NaN, DataValidation wrappers
+ */
+
+#include <unity.h>
+#include <math.h>
+#include "../../src/utils/FieldRange.h"
+#include "../../src/utils/DataValidation.h"
+
+namespace {
+
+// Resolved at compile time
+static_assert(FieldRange<BOATDATA_FIELD_DST_DEPTH>::hi() == 100.0, "depth range from the schema");
+static_assert(FieldRange<BOATDATA_FIELD_WIND_AWA>::lo() == -M_PI, "angles are exact");
+static_assert(DataValidation::PitchRange::clamp(1.0) == M_PI / 6, "constexpr clamp");
+static_assert(!DataValidation::SogRange::contains(-0.1), "constexpr contains");
+static_assert(DataValidation::mpsToKnots(1.0) == DataValidation::KNOTS_PER_MPS, "constexpr conversion");
+
+FIELD_RANGE_LIMITS(UnitLimits, 0.0, 1.0);
+typedef Range<UnitLimits> Unit;
+typedef FieldRange<BOATDATA_FIELD_WIND_AWA, RangeMode::WRAP> Awa;
+
+}  // namespace
+
+/**
+ * @test Every FieldRange has the bounds of its fieldInfo() entry
+ */
+void test_field_range_matches_schema(void) {
+#define CHECK_FIELD_LIMITS(ID, GROUP, group, member, TYPE, unit, fieldMin, fieldMax, decimals, deadband) \
+    TEST_ASSERT_EQUAL_FLOAT(BoatDataSchema::fieldInfo(BOATDATA_FIELD_##ID).min, \
+                            static_cast<float>(FieldRange<BOATDATA_FIELD_##ID>::lo())); \
+    TEST_ASSERT_EQUAL_FLOAT(BoatDataSchema::fieldInfo(BOATDATA_FIELD_##ID).max, \
+                            static_cast<float>(FieldRange<BOATDATA_FIELD_##ID>::hi()));
+    BOATDATA_SCHEMA_FIELDS(CHECK_FIELD_LIMITS)
+#undef CHECK_FIELD_LIMITS
+
+    // The runtime check by id accepts the exact bounds of the compile-time one
+    TEST_ASSERT_TRUE(BoatDataSchema::inRange(BOATDATA_FIELD_WIND_AWA, M_PI));
+    TEST_ASSERT_TRUE(BoatDataSchema::inRange(BOATDATA_FIELD_GPS_COG, 2 * M_PI));
+    TEST_ASSERT_TRUE(BoatDataSchema::inRange(BOATDATA_FIELD_COMPASS_HEEL_ANGLE, -M_PI / 2));
+}
+
+/**
+ * @test contains(), clamp() and check() at the bounds, outside and with NaN
+ */
+void test_field_range_clamp_and_check(void) {
+    TEST_ASSERT_TRUE(Unit::contains(0.0));
+    TEST_ASSERT_TRUE(Unit::contains(1.0));
+    TEST_ASSERT_FALSE(Unit::contains(1.000001));
+    TEST_ASSERT_FALSE(Unit::contains(NAN));
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, Unit::clamp(-3.0));
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, Unit::clamp(7.0));
+    TEST_ASSERT_EQUAL_DOUBLE(0.25, Unit::clamp(0.25));
+    TEST_ASSERT_TRUE(isnan(Unit::clamp(NAN)));
+
+    double value = 0.5;
+    TEST_ASSERT_EQUAL(RangeResult::VALID, Unit::check(value));
+    TEST_ASSERT_EQUAL_DOUBLE(0.5, value);
+    value = 2.0;
+    TEST_ASSERT_EQUAL(RangeResult::LIMITED, Unit::check(value));
+    TEST_ASSERT_EQUAL_DOUBLE(1.0, value);
+    value = NAN;
+    TEST_ASSERT_EQUAL(RangeResult::NOT_AVAILABLE, Unit::check(value));
+    TEST_ASSERT_TRUE(isnan(value));
+
+    // Float values compare against the float-rounded bounds
+    float awa = static_cast<float>(M_PI);
+    TEST_ASSERT_TRUE(Awa::contains(awa));
+    TEST_ASSERT_FALSE(Awa::contains(M_PI + 1e-9));
+}
+
+/**
+ * @test WRAP ranges take whole turns off in one step; values inside stay as received
+ */
+void test_field_range_wrap(void) {
+    TEST_ASSERT_EQUAL_DOUBLE(M_PI, Awa::wrap(M_PI));
+    TEST_ASSERT_EQUAL_DOUBLE(-M_PI, Awa::wrap(-M_PI));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, -M_PI / 2, Awa::wrap(1.5 * M_PI));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.25, Awa::wrap(0.25 + 200 * M_PI));   // 100 turns, no loop
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, -0.25, Awa::wrap(-0.25 - 200 * M_PI));
+    TEST_ASSERT_TRUE(isnan(Awa::wrap(NAN)));
+
+    double angle = 3 * M_PI;
+    TEST_ASSERT_EQUAL(RangeResult::LIMITED, Awa::check(angle));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, -M_PI, angle);
+
+    // Course [0, 2π): a full turn is north
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, DataValidation::wrapAngle2Pi(2 * M_PI));
+    TEST_ASSERT_EQUAL_DOUBLE(0.0, DataValidation::wrapAngle2Pi(-1e-18));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 1.5 * M_PI, DataValidation::wrapAngle2Pi(-M_PI / 2));
+}
+
+/**
+ * @test The DataValidation bands that are not schema ranges
+ */
+void test_field_range_validation_bands(void) {
+    TEST_ASSERT_TRUE(DataValidation::isWithinVoltageRange(9.0));
+    TEST_ASSERT_FALSE(DataValidation::isValidBatteryVoltage(9.0));       // Outside the 12 V band
+    TEST_ASSERT_EQUAL_DOUBLE(M_PI / 2, DataValidation::clampHeelAngle(2.0));
+    TEST_ASSERT_FALSE(DataValidation::isValidHeelAngle(M_PI / 3));       // Warned, not clamped
+    TEST_ASSERT_TRUE(DataValidation::isValidVariation(30.0 * M_PI / 180.0));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 1.0, DataValidation::knotsToMps(DataValidation::mpsToKnots(1.0)));
+}
@@ -0,0 +1,81 @@
+/**
+ * @file test_hampel_filter.cpp
+ * @brief Unit tests for HampelFilter (median/MAD outlier rejection) and its use in BoatData
+ */
+
+#include <unity.h>
+#include <math.h>
+#include "../../src/utils/HampelFilter.h"
+#include "../../src/utils/HampelFilter.cpp"
+#include "../../src/components/BoatData.h"
+#include "../../src/components/SourcePrioritizer.h"
+
+/**
+ * @test A lone spike is rejected without poisoning the history; a real step is accepted once it holds the majority
+ */
+void test_hampel_filter_spike_and_step(void) {
+    HampelFilter speed(1.0);
+    unsigned long now = 0;
+    for (int i = 0; i < OUTLIER_WINDOW; i++) {
+        TEST_ASSERT_TRUE(speed.check(5.0 + 0.1 * (i % 2), now += 100));
+    }
+    TEST_ASSERT_FALSE(speed.check(25.0, now += 100));   // Spike
+    TEST_ASSERT_TRUE(speed.check(5.1, now += 100));     // The next good sample passes
+    TEST_ASSERT_EQUAL_UINT32(1, speed.getRejected());
+
+    // Step to 12 kn: rejected until the new level is the majority of the window
+    int rejected = 0;
+    for (int i = 0; i < OUTLIER_WINDOW; i++) {
+        if (!speed.check(12.0, now += 100)) {
+            rejected++;
+        }
+    }
+    TEST_ASSERT_EQUAL(OUTLIER_WINDOW / 2, rejected);
+    TEST_ASSERT_TRUE(speed.check(12.05, now += 100));
+
+    // A steady ramp spreads the history; it keeps passing
+    HampelFilter ramp(0.1);
+    for (int i = 0; i < 50; i++) {
+        TEST_ASSERT_TRUE(ramp.check(0.5 * i, i * 100UL));
+    }
+
+    // After a gap the history restarts
+    TEST_ASSERT_TRUE(speed.check(30.0, now + OUTLIER_RESET_MS + 1));
+}
+
+/**
+ * @test Angles are compared circularly: a history around north passes both sides of 0/2π
+ */
+void test_hampel_filter_circular(void) {
+    HampelFilter heading(0.2, true);
+    const double northish[] = {6.25, 0.02, 6.27, 0.01, 6.28, 0.03, 6.26};
+    unsigned long now = 0;
+    for (double value : northish) {
+        TEST_ASSERT_TRUE(heading.check(value, now += 100));
+    }
+    TEST_ASSERT_TRUE(heading.check(0.05, now += 100));
+    TEST_ASSERT_FALSE(heading.check(M_PI, now += 100));
+    TEST_ASSERT_EQUAL_UINT32(1, heading.getRejected());
+}
+
+/**
+ * @test BoatData rejects an outlier fix, counts it on the source, and keeps taking the good ones after it
+ */
+void test_hampel_filter_boatdata_counts_outliers(void) {
+    SourcePrioritizer prioritizer;
+    BoatData boatData(&prioritizer);
+    BoatDataSourceHandle gps = boatData.registerSource("GPS-A", SensorType::GPS, ProtocolType::NMEA0183);
+
+    for (int i = 0; i < OUTLIER_WINDOW; i++) {
+        TEST_ASSERT_TRUE(boatData.updateGPS(gps, 48.0 + i * 1e-5, -4.0, 1.0, 5.0));
+    }
+    TEST_ASSERT_FALSE(boatData.updateGPS(gps, 48.5, -4.0, 1.0, 5.0));    // ~55 km jump
+    TEST_ASSERT_TRUE(boatData.updateGPS(gps, 48.0001, -4.0, 1.0, 5.0));
+    TEST_ASSERT_TRUE(boatData.updateGPS(gps, 48.00011, -4.0, 1.0, 5.0));
+    TEST_ASSERT_FALSE(boatData.updateGPS(gps, 200.0, -4.0, 1.0, 5.0));   // Out of range: INVALID
+
+    SensorSource source = prioritizer.getSource(gps.index);
+    TEST_ASSERT_EQUAL_UINT32(2, source.rejectedCount);
+    TEST_ASSERT_EQUAL_UINT32(1, source.outlierCount);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 48.00011, boatData.getGPSData().latitude);
+}
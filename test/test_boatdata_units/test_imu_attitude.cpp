@@ -0,0 +1,180 @@
+/**
+ * @file test_imu_attitude.cpp
+ * @brief Onboard IMU: complementary filter, ICM-20948 FIFO batches, attitude source arbitration
+ *
+ * BoatData.cpp and SourcePrioritizer.cpp are compiled in through test_source_handles.cpp.
+ */
+
+#include <unity.h>
+#include <math.h>
+#include "../../src/utils/AttitudeFilter.h"
+#include "../../src/utils/AttitudeFilter.cpp"
+#include "../../src/utils/Icm20948.h"
+#include "../../src/utils/Icm20948.cpp"
+#include "../../src/components/ImuAttitudeSource.h"
+#include "../../src/components/ImuAttitudeSource.cpp"
+#include "../../src/components/SourcePrioritizer.h"
+#include "../../src/mocks/MockIcm20948.h"
+
+namespace {
+
+ImuSample heeled(double heel, double gyroX) {
+    ImuSample sample = {};
+    sample.accel[1] = static_cast<float>(sin(heel));
+    sample.accel[2] = static_cast<float>(cos(heel));
+    sample.gyro[0] = static_cast<float>(gyroX);
+    return sample;
+}
+
+void pushHeeled(MockIcm20948& device, double heel, int count) {
+    for (int i = 0; i < count; i++) {
+        device.pushSample(0.0, sin(heel), cos(heel), 0.0, 0.0, 0.0);
+    }
+}
+
+}  // namespace
+
+/**
+ * @test The first sample seeds from gravity; a gyro bias stays bounded by the accelerometer
+ */
+void test_attitude_filter_seed_and_bias(void) {
+    AttitudeFilter filter(2.0, 0.15);
+    TEST_ASSERT_FALSE(filter.isValid());
+
+    ImuSample pitched = {};
+    pitched.accel[0] = static_cast<float>(sin(0.05));
+    pitched.accel[2] = static_cast<float>(cos(0.05));
+    filter.update(pitched, 0.01);
+    TEST_ASSERT_TRUE(filter.isValid());
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.05, filter.getPitch());   // Bow up
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.0, filter.getHeel());
+
+    // Level boat, 0.01 rad/s heel-rate bias for 60 s: settles near bias * tau
+    filter.reset();
+    for (int i = 0; i < 6000; i++) {
+        filter.update(heeled(0.0, 0.01), 0.01);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 0.02, filter.getHeel());
+    TEST_ASSERT_EQUAL_UINT32(0, filter.getRejected());
+}
+
+/**
+ * @test Slams (|a| far from 1 g) only integrate the gyro; a roll is followed between them
+ */
+void test_attitude_filter_rejects_slams(void) {
+    AttitudeFilter filter(2.0, 0.15);
+    ImuSample slam = heeled(0.0, 0.0);
+    slam.accel[2] = 2.0f;
+    filter.update(slam, 0.01);
+    TEST_ASSERT_FALSE(filter.isValid());   // Never seeded from a slam
+
+    filter.update(heeled(0.0, 0.0), 0.01);
+    // Roll to starboard at 0.5 rad/s for 0.2 s while slamming: gyro only
+    for (int i = 0; i < 20; i++) {
+        ImuSample sample = heeled(0.0, 0.5);
+        sample.accel[2] = 1.6f;
+        filter.update(sample, 0.01);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.1, filter.getHeel());
+    TEST_ASSERT_EQUAL_UINT32(21, filter.getRejected());
+}
+
+/**
+ * @test begin() configures rates, ranges and FIFO; a drain is one count read plus chunked FIFO bursts
+ */
+void test_icm20948_begin_and_batches(void) {
+    MockIcm20948 device;
+    Icm20948 imu(&device);
+    TEST_ASSERT_TRUE(imu.begin(100));
+    TEST_ASSERT_EQUAL_UINT8(10, device.getRegister(2, Icm20948::REG_GYRO_SMPLRT_DIV));
+    TEST_ASSERT_EQUAL_UINT8(10, device.getRegister(2, Icm20948::REG_ACCEL_SMPLRT_DIV_2));
+    TEST_ASSERT_EQUAL_UINT8(0x1E, device.getRegister(0, Icm20948::REG_FIFO_EN_2));
+    TEST_ASSERT_EQUAL_UINT8(0x40, device.getRegister(0, Icm20948::REG_USER_CTRL));
+    TEST_ASSERT_EQUAL_UINT8(0x01, device.getRegister(0, Icm20948::REG_PWR_MGMT_1));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 102.27, imu.getSampleRateHz());
+
+    device.pushSample(0.5, -0.25, 1.0, 0.1, -0.2, 0.0);
+    pushHeeled(device, 0.0, 14);
+    ImuSample samples[IMU_BATCH_MAX];
+    uint32_t fifoReads = device.getFifoReads();
+    TEST_ASSERT_EQUAL_UINT8(15, imu.readBatch(samples, IMU_BATCH_MAX));
+    TEST_ASSERT_EQUAL_UINT32(fifoReads + 2, device.getFifoReads());   // 120 + 60 bytes
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 0.5, samples[0].accel[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, -0.25, samples[0].accel[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.002, 0.1, samples[0].gyro[0]);
+    TEST_ASSERT_FLOAT_WITHIN(0.002, -0.2, samples[0].gyro[1]);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 1.0, samples[14].accel[2]);
+    TEST_ASSERT_EQUAL_UINT16(0, device.getFifoLength());
+
+    // Capped at max: the rest waits in the FIFO
+    pushHeeled(device, 0.0, 8);
+    TEST_ASSERT_EQUAL_UINT8(5, imu.readBatch(samples, 5));
+    TEST_ASSERT_EQUAL_UINT16(3 * Icm20948::PACKET_BYTES, device.getFifoLength());
+    TEST_ASSERT_EQUAL_UINT32(0, imu.getErrors());
+}
+
+/**
+ * @test A full FIFO is reset and counted; bus errors and an absent device are reported
+ */
+void test_icm20948_overflow_and_errors(void) {
+    MockIcm20948 device;
+    Icm20948 imu(&device);
+    TEST_ASSERT_TRUE(imu.begin(100));
+
+    pushHeeled(device, 0.0, 50);   // 600 bytes into 512: oldest overwritten
+    ImuSample samples[IMU_BATCH_MAX];
+    TEST_ASSERT_EQUAL_UINT8(0, imu.readBatch(samples, IMU_BATCH_MAX));
+    TEST_ASSERT_EQUAL_UINT32(1, imu.getOverflows());
+    TEST_ASSERT_EQUAL_UINT16(0, device.getFifoLength());
+
+    pushHeeled(device, 0.0, 4);
+    device.failReads(1);
+    TEST_ASSERT_EQUAL_UINT8(0, imu.readBatch(samples, IMU_BATCH_MAX));
+    TEST_ASSERT_EQUAL_UINT32(1, imu.getErrors());
+    TEST_ASSERT_EQUAL_UINT8(4, imu.readBatch(samples, IMU_BATCH_MAX));
+
+    MockIcm20948 absent;
+    absent.setPresent(false);
+    Icm20948 missing(&absent);
+    TEST_ASSERT_FALSE(missing.begin(100));
+}
+
+/**
+ * @test The IMU stores heel once per batch and is dropped while an N2k attitude sender is active
+ */
+void test_imu_attitude_source_arbitration(void) {
+    SourcePrioritizer prioritizer;
+    BoatData boatData(&prioritizer);
+    MockIcm20948 device;
+    Icm20948 imu(&device);
+    ImuAttitudeSource source(&imu, &boatData);
+    TEST_ASSERT_TRUE(source.begin());
+
+    TEST_ASSERT_EQUAL_UINT8(0, source.poll());   // Empty FIFO: nothing stored
+    pushHeeled(device, 0.2, 10);
+    TEST_ASSERT_EQUAL_UINT8(10, source.poll());
+    TEST_ASSERT_EQUAL_UINT32(1, source.getStored());
+    CompassData compass = boatData.getCompassData();
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0.2, compass.heelAngle);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0.0, compass.pitchAngle);
+    TEST_ASSERT_TRUE(compass.available);
+
+    int imuIndex = prioritizer.getActiveSource(SensorType::ATTITUDE);
+    TEST_ASSERT_TRUE(imuIndex >= 0);
+    TEST_ASSERT_EQUAL_STRING("IMU", prioritizer.getSource(imuIndex).sourceId);
+
+    // An N2k attitude sender takes over: IMU batches stop reaching BoatData
+    int bus = prioritizer.registerSource("N2K-ATT-017", SensorType::ATTITUDE, ProtocolType::NMEA2000);
+    TEST_ASSERT_TRUE(boatData.requestSourceOverride(SensorType::ATTITUDE, bus));
+    pushHeeled(device, -0.3, 10);
+    TEST_ASSERT_EQUAL_UINT8(10, source.poll());
+    TEST_ASSERT_EQUAL_UINT32(1, source.getDropped());
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0.2, boatData.getCompassData().heelAngle);
+
+    // Not blended in fusion mode either
+    boatData.setFusionMode(SourceFusionMode::BLEND);
+    pushHeeled(device, -0.3, 10);
+    source.poll();
+    TEST_ASSERT_EQUAL_UINT32(2, source.getDropped());
+    TEST_ASSERT_TRUE(source.getFilter().getHeel() < 0.19);   // Filter kept converging on -0.3
+}
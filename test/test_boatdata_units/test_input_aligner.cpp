@@ -0,0 +1,131 @@
+/**
+ * @file test_input_aligner.cpp
+ * @brief Input sample history: interpolation, extrapolation limits, angle wrap and the CalculationEngine alignment stage
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/InputAligner.h"
+#include "../../src/utils/InputAligner.cpp"
+#include "../../src/components/CalculationEngine.h"
+
+namespace {
+
+const double DEG = 0.017453292519943295;
+
+/// Angular distance (radians)
+double angleDistance(double a, double b) {
+    return std::fabs(std::remainder(a - b, 2.0 * M_PI));
+}
+
+}  // namespace
+
+/**
+ * @test Linear between samples, extrapolated (limited) after the newest, held before the oldest
+ */
+void test_input_aligner_interpolates(void) {
+    InputAligner aligner;
+    TEST_ASSERT_TRUE(isnan(aligner.valueAt(ALIGN_AWS, 0)));
+
+    aligner.record(ALIGN_AWS, 1000, 10.0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 10.0, aligner.valueAt(ALIGN_AWS, 1500));  // One sample: held
+
+    aligner.record(ALIGN_AWS, 1100, 12.0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 11.0, aligner.valueAt(ALIGN_AWS, 1050));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 12.0, aligner.valueAt(ALIGN_AWS, 1100));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 10.0, aligner.valueAt(ALIGN_AWS, 900));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 13.0, aligner.valueAt(ALIGN_AWS, 1150));
+
+    // Extrapolation stops at CALC_ALIGN_MAX_EXTRAPOLATION_MS
+    BoatScalar limit = 12.0 + 2.0 * CALC_ALIGN_MAX_EXTRAPOLATION_MS / 100.0;
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, limit, aligner.valueAt(ALIGN_AWS, 1100 + CALC_ALIGN_MAX_EXTRAPOLATION_MS));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, limit, aligner.valueAt(ALIGN_AWS, 1100 + 10 * CALC_ALIGN_MAX_EXTRAPOLATION_MS));
+
+    // Other inputs are independent
+    TEST_ASSERT_EQUAL_UINT8(2, aligner.count(ALIGN_AWS));
+    TEST_ASSERT_EQUAL_UINT8(0, aligner.count(ALIGN_AWA));
+}
+
+/**
+ * @test Bearings and AWA interpolate along the shorter arc and stay normalized
+ */
+void test_input_aligner_angle_wrap(void) {
+    InputAligner aligner;
+    aligner.record(ALIGN_HEADING, 0, 350.0 * DEG);
+    aligner.record(ALIGN_HEADING, 100, 10.0 * DEG);
+    BoatScalar heading = aligner.valueAt(ALIGN_HEADING, 25);
+    TEST_ASSERT_TRUE(angleDistance(heading, 355.0 * DEG) < 1e-4);
+    TEST_ASSERT_TRUE(heading >= 0.0 && heading < 2.0 * M_PI);
+    TEST_ASSERT_TRUE(angleDistance(aligner.valueAt(ALIGN_HEADING, 150), 20.0 * DEG) < 1e-4);
+
+    // AWA through dead downwind (170 deg to -170 deg), kept in [-pi, pi]
+    aligner.record(ALIGN_AWA, 0, 170.0 * DEG);
+    aligner.record(ALIGN_AWA, 100, -170.0 * DEG);
+    BoatScalar awa = aligner.valueAt(ALIGN_AWA, 75);
+    TEST_ASSERT_TRUE(angleDistance(awa, -175.0 * DEG) < 1e-4);
+    TEST_ASSERT_TRUE(awa >= -M_PI && awa <= M_PI);
+
+    // Heel is not an angle that wraps
+    aligner.record(ALIGN_HEEL, 0, -0.2);
+    aligner.record(ALIGN_HEEL, 100, 0.2);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 0.0, aligner.valueAt(ALIGN_HEEL, 50));
+}
+
+/**
+ * @test No slope across a dropout; the ring keeps the newest samples in time order, wrap-safe
+ */
+void test_input_aligner_gaps_and_ordering(void) {
+    InputAligner aligner;
+    aligner.record(ALIGN_BOAT_SPEED, 0, 4.0);
+    aligner.record(ALIGN_BOAT_SPEED, CALC_ALIGN_MAX_GAP_MS + 1000, 8.0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 4.0, aligner.valueAt(ALIGN_BOAT_SPEED, 500));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 8.0, aligner.valueAt(ALIGN_BOAT_SPEED, CALC_ALIGN_MAX_GAP_MS + 500));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 8.0, aligner.valueAt(ALIGN_BOAT_SPEED, CALC_ALIGN_MAX_GAP_MS + 1200));
+
+    // Same timestamp replaces, older is ignored, non-finite is ignored
+    aligner.reset();
+    aligner.record(ALIGN_SOG, 100, 5.0);
+    aligner.record(ALIGN_SOG, 100, 6.0);
+    aligner.record(ALIGN_SOG, 50, 1.0);
+    aligner.record(ALIGN_SOG, 200, NAN);
+    TEST_ASSERT_EQUAL_UINT8(1, aligner.count(ALIGN_SOG));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, 6.0, aligner.valueAt(ALIGN_SOG, 100));
+
+    // More samples than the history holds, across the millis() wrap
+    aligner.reset();
+    uint32_t t = 0xFFFFFFFFu - 150;
+    for (uint8_t i = 0; i < CALC_ALIGN_HISTORY + 2; i++) {
+        aligner.record(ALIGN_SOG, t + i * 100u, BoatScalar(i));
+    }
+    TEST_ASSERT_EQUAL_UINT8(CALC_ALIGN_HISTORY, aligner.count(ALIGN_SOG));
+    uint32_t newest = t + (CALC_ALIGN_HISTORY + 1) * 100u;
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, CALC_ALIGN_HISTORY + 0.5, aligner.valueAt(ALIGN_SOG, newest - 50));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 2.0, aligner.valueAt(ALIGN_SOG, t));  // Oldest kept is sample 2
+}
+
+/**
+ * @test During a tack the heading is taken at the time of the wind sample, not the newest compass sample
+ */
+void test_input_aligner_calculation_stage(void) {
+    CalculationEngine engine;
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.gps.available = data.compass.available = data.wind.available = data.dst.available = true;
+    data.calibration.leewayCalibrationFactor = 10.0;
+    data.wind.apparentWindAngle = 0.1;
+    data.wind.apparentWindSpeed = 14.0;
+    data.wind.lastUpdate = 1000;
+    data.dst.measuredBoatSpeed = 4.0;
+    data.compass.magneticHeading = 0.5;
+    data.compass.lastUpdate = 950;
+    engine.calculate(&data);
+
+    // Heading swings on, the wind sample is still the one at 1000 ms
+    data.compass.magneticHeading = 0.7;
+    data.compass.lastUpdate = 1050;
+    engine.calculate(&data);
+
+    BoatScalar heading = CALC_ALIGN_INPUTS ? 0.6 : 0.7;
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, engine.calculateWDIR(heading, data.derived.twa), data.derived.wdir);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.7, data.compass.magneticHeading);  // Raw value untouched
+}
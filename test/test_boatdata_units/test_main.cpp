@@ -12,10 +12,447 @@
 
 #include <unity.h>
 
+// SeqLock tests
+void test_seqlock_version_counts_writes(void);
+void test_seqlock_read_returns_snapshot_and_version(void);
+void test_seqlock_read_fails_during_write(void);
+void test_seqlock_memset_and_wrap(void);
+
+// BoatDataView tests
+void test_view_reads_in_place_until_write(void);
+void test_view_taken_during_write_and_copy(void);
+
+// BoatDataChangeTracker tests
+void test_change_tracker_generation_advances_per_write(void);
+void test_change_tracker_dirty_mask_per_consumer(void);
+void test_change_tracker_ignores_unknown_groups(void);
+void test_change_tracker_latest_of_groups(void);
+void test_change_tracker_instance_slots(void);
+
+// BoatDataSubscriptions tests
+void test_subscriptions_coalesce_bursts(void);
+void test_subscriptions_merge_deferred_changes(void);
+void test_subscriptions_filter_by_mask(void);
+void test_subscriptions_table_full_and_unsubscribe(void);
+void test_subscriptions_heartbeat_and_wait(void);
+void test_subscriptions_set_min_interval(void);
+
+// OutputPipeline tests
+void test_output_pipeline_shares_one_snapshot(void);
+void test_output_pipeline_changes_and_interval(void);
+void test_output_pipeline_periodic_phase_and_capacity(void);
+
+// BoatDataSchema tests
+void test_schema_table_matches_structure(void);
+void test_schema_get_set_and_range(void);
+void test_schema_read_group_copies_one_group(void);
+void test_schema_write_json(void);
+void test_field_range_matches_schema(void);
+void test_field_range_clamp_and_check(void);
+void test_field_range_wrap(void);
+void test_field_range_validation_bands(void);
+
+// AlarmEngine tests
+void test_alarm_parse_rules(void);
+void test_alarm_evaluates_changed_groups_only(void);
+void test_alarm_delay_and_hysteresis(void);
+void test_alarm_anchor_watch(void);
+void test_alarm_shore_power_and_battery(void);
+
+// BoatDataSnapshot tests
+void test_snapshot_round_trip(void);
+void test_snapshot_saturates_and_checks_version(void);
+void test_snapshot_datagram_layout(void);
+
+// Source handle tests
+void test_source_handle_drops_inactive_source(void);
+void test_source_handle_counts_invalid_updates(void);
+void test_source_handle_unregistered_is_unarbitrated(void);
+void test_source_handle_blend_mode(void);
+void test_source_handle_override_request(void);
+void test_source_handle_battery_monitors(void);
+
+// Source scoring tests
+void test_source_scoring_rate_and_quality(void);
+void test_source_scoring_hysteresis_and_dwell(void);
+void test_source_table_lookup_and_types(void);
+
+// Source fusion tests
+void test_source_fusion_angle_circular_mean(void);
+void test_source_fusion_angle_gating(void);
+void test_source_fusion_position(void);
+
+// Outlier filter tests
+void test_hampel_filter_spike_and_step(void);
+void test_hampel_filter_circular(void);
+void test_hampel_filter_boatdata_counts_outliers(void);
+
+// Staleness sweeper tests
+void test_stale_sweep_expires_quiet_groups(void);
+void test_stale_sweep_skips_disabled_timeouts(void);
+
+// Engine and tank instance tests
+void test_engine_instances_keep_engines_apart(void);
+void test_engine_instances_tank_slots(void);
+void test_engine_instances_expire(void);
+void test_engine_instances_delta(void);
+
+// Onboard IMU tests
+void test_attitude_filter_seed_and_bias(void);
+void test_attitude_filter_rejects_slams(void);
+void test_icm20948_begin_and_batches(void);
+void test_icm20948_overflow_and_errors(void);
+void test_imu_attitude_source_arbitration(void);
+
+// Calculation pipeline tests
+void test_calculation_pipeline_matches_reference(void);
+void test_calculation_pipeline_requires_inputs(void);
+void test_calculation_pipeline_publishes_once(void);
+
+// FastMath tests
+void test_fast_math_sin_cos_error_bound(void);
+void test_fast_math_atan2_error_bound(void);
+void test_fast_math_lut_error_bound(void);
+
+// Damping filter tests
+void test_damping_ema_time_constant(void);
+void test_damping_circular_wraps(void);
+void test_damping_kalman_converges(void);
+void test_damping_off_passthrough(void);
+void test_damping_calculation_stage(void);
+
+// Polar table tests
+void test_polar_table_bilinear_lookup(void);
+void test_polar_table_index_steps(void);
+void test_polar_table_vmg_targets(void);
+void test_polar_table_rejects_invalid(void);
+void test_polar_table_calculation_stage(void);
+
+// Data tables partition tests
+void test_data_tables_directory(void);
+void test_data_tables_polar_matches_text(void);
+void test_variation_grid_lookup(void);
+void test_variation_grid_fallback(void);
+
+// Input aligner tests
+void test_input_aligner_interpolates(void);
+void test_input_aligner_angle_wrap(void);
+void test_input_aligner_gaps_and_ordering(void);
+void test_input_aligner_calculation_stage(void);
+
+// Derived statistics tests
+void test_derived_statistics_window_means(void);
+void test_derived_statistics_circular_mean(void);
+void test_derived_statistics_matches_brute_force(void);
+void test_derived_statistics_dropout(void);
+void test_derived_statistics_calculation_stage(void);
+void test_calibration_learner_wind_offset(void);
+void test_calibration_learner_wind_shift(void);
+void test_calibration_learner_leeway_regression(void);
+void test_calibration_learner_gates_and_window(void);
+void test_calibration_learner_apply_thresholds(void);
+
+// Navigation engine tests
+void test_navigation_engine_opposite_heading(void);
+void test_navigation_engine_laylines(void);
+void test_navigation_engine_downwind_leg(void);
+void test_navigation_engine_fail_safe(void);
+
+// AIS target table tests
+void test_ais_table_hash_and_eviction(void);
+void test_ais_table_cpa_tcpa_and_risk_list(void);
+void test_ais_table_incremental_pass(void);
+void test_ais_table_expiry(void);
+
+// UTC clock tests
+void test_utc_clock_date_conversion(void);
+void test_utc_clock_step_then_slew(void);
+void test_utc_clock_source_priority(void);
+void test_utc_clock_millis_wrap(void);
+void test_utc_clock_replay_hold(void);
+
+// Offline calculation runner input tests
+void test_calc_batch_input_frames(void);
+void test_calc_batch_input_sentences(void);
+void test_calc_batch_input_csv(void);
+void test_calc_batch_input_replay_clock(void);
+
+// Delta stream tests
+void test_boatdata_delta_keyframe_first(void);
+void test_boatdata_delta_deadband(void);
+void test_boatdata_delta_keyframe_schedule(void);
+
+// Signal K delta tests
+void test_signalk_delta_keyframe(void);
+void test_signalk_delta_changes(void);
+
+// Stream client tests
+void test_stream_clients_modes(void);
+void test_stream_clients_buckets(void);
+void test_stream_clients_governed_rate(void);
+void test_stream_clients_backpressure(void);
+void test_stream_clients_binary_layout(void);
+
+// Broadcast rate governor tests
+void test_rate_governor_backs_off(void);
+void test_rate_governor_speeds_up_when_idle(void);
+void test_rate_governor_unmeasured_loop(void);
+void test_rate_governor_cpu_idle(void);
+void test_rate_governor_range(void);
+
+// Calculation benchmark tests
+void test_calculation_benchmark_summarize(void);
+void test_calculation_benchmark_stages(void);
+
+// 1-Wire conversion state machine tests
+void test_onewire_conversion_bounded_steps(void);
+void test_onewire_conversion_crc_retry_and_absent_bus(void);
+void test_onewire_conversion_schedule_and_stats(void);
+
+// 1-Wire device map tests
+void test_onewire_device_map_assign_and_replace(void);
+void test_onewire_device_map_record_round_trip(void);
+
+// mDNS advertisement tests
+void test_mdns_advertisement_records(void);
+void test_mdns_advertisement_change_detection(void);
+
+// Admission control tests
+void test_admission_endpoint_limits(void);
+void test_admission_heap_budget(void);
+
+// Wi-Fi power profile tests
+void test_wifi_profile_selection(void);
+void test_wifi_profile_round_trip(void);
+void test_wifi_profile_record(void);
+
+// BoatData replay ring tests
+void test_boatdata_replay_since(void);
+void test_boatdata_replay_requests(void);
+
+// Pipeline latency probe tests
+void test_pipeline_latency_per_group_and_output(void);
+void test_pipeline_latency_derived_from_inputs(void);
+void test_pipeline_latency_outputs_and_arming(void);
+void test_pipeline_latency_boatdata_observer(void);
+
 void setUp(void) {}
 void tearDown(void) {}
 
 int main(int argc, char **argv) {
     UNITY_BEGIN();
+
+    // SeqLock
+    RUN_TEST(test_seqlock_version_counts_writes);
+    RUN_TEST(test_seqlock_read_returns_snapshot_and_version);
+    RUN_TEST(test_seqlock_read_fails_during_write);
+    RUN_TEST(test_seqlock_memset_and_wrap);
+
+    // BoatDataView
+    RUN_TEST(test_view_reads_in_place_until_write);
+    RUN_TEST(test_view_taken_during_write_and_copy);
+
+    // BoatDataChangeTracker
+    RUN_TEST(test_change_tracker_generation_advances_per_write);
+    RUN_TEST(test_change_tracker_dirty_mask_per_consumer);
+    RUN_TEST(test_change_tracker_ignores_unknown_groups);
+    RUN_TEST(test_change_tracker_latest_of_groups);
+    RUN_TEST(test_change_tracker_instance_slots);
+
+    // BoatDataSubscriptions
+    RUN_TEST(test_subscriptions_coalesce_bursts);
+    RUN_TEST(test_subscriptions_merge_deferred_changes);
+    RUN_TEST(test_subscriptions_filter_by_mask);
+    RUN_TEST(test_subscriptions_table_full_and_unsubscribe);
+    RUN_TEST(test_subscriptions_heartbeat_and_wait);
+    RUN_TEST(test_subscriptions_set_min_interval);
+
+    // OutputPipeline
+    RUN_TEST(test_output_pipeline_shares_one_snapshot);
+    RUN_TEST(test_output_pipeline_changes_and_interval);
+    RUN_TEST(test_output_pipeline_periodic_phase_and_capacity);
+
+    // BoatDataSchema
+    RUN_TEST(test_schema_table_matches_structure);
+    RUN_TEST(test_schema_get_set_and_range);
+    RUN_TEST(test_schema_read_group_copies_one_group);
+    RUN_TEST(test_schema_write_json);
+    RUN_TEST(test_field_range_matches_schema);
+    RUN_TEST(test_field_range_clamp_and_check);
+    RUN_TEST(test_field_range_wrap);
+    RUN_TEST(test_field_range_validation_bands);
+
+    // AlarmEngine
+    RUN_TEST(test_alarm_parse_rules);
+    RUN_TEST(test_alarm_evaluates_changed_groups_only);
+    RUN_TEST(test_alarm_delay_and_hysteresis);
+    RUN_TEST(test_alarm_anchor_watch);
+    RUN_TEST(test_alarm_shore_power_and_battery);
+
+    // BoatDataSnapshot
+    RUN_TEST(test_snapshot_round_trip);
+    RUN_TEST(test_snapshot_saturates_and_checks_version);
+    RUN_TEST(test_snapshot_datagram_layout);
+
+    // Source handles
+    RUN_TEST(test_source_handle_drops_inactive_source);
+    RUN_TEST(test_source_handle_counts_invalid_updates);
+    RUN_TEST(test_source_handle_unregistered_is_unarbitrated);
+    RUN_TEST(test_source_handle_blend_mode);
+    RUN_TEST(test_source_handle_override_request);
+    RUN_TEST(test_source_handle_battery_monitors);
+
+    // Source scoring
+    RUN_TEST(test_source_scoring_rate_and_quality);
+    RUN_TEST(test_source_scoring_hysteresis_and_dwell);
+    RUN_TEST(test_source_table_lookup_and_types);
+
+    // Source fusion
+    RUN_TEST(test_source_fusion_angle_circular_mean);
+    RUN_TEST(test_source_fusion_angle_gating);
+    RUN_TEST(test_source_fusion_position);
+
+    // Outlier filter
+    RUN_TEST(test_hampel_filter_spike_and_step);
+    RUN_TEST(test_hampel_filter_circular);
+    RUN_TEST(test_hampel_filter_boatdata_counts_outliers);
+
+    // Staleness sweeper
+    RUN_TEST(test_stale_sweep_expires_quiet_groups);
+    RUN_TEST(test_stale_sweep_skips_disabled_timeouts);
+    RUN_TEST(test_engine_instances_keep_engines_apart);
+    RUN_TEST(test_engine_instances_tank_slots);
+    RUN_TEST(test_engine_instances_expire);
+    RUN_TEST(test_engine_instances_delta);
+
+    // Onboard IMU
+    RUN_TEST(test_attitude_filter_seed_and_bias);
+    RUN_TEST(test_attitude_filter_rejects_slams);
+    RUN_TEST(test_icm20948_begin_and_batches);
+    RUN_TEST(test_icm20948_overflow_and_errors);
+    RUN_TEST(test_imu_attitude_source_arbitration);
+
+    // Calculation pipeline
+    RUN_TEST(test_calculation_pipeline_matches_reference);
+    RUN_TEST(test_calculation_pipeline_requires_inputs);
+    RUN_TEST(test_calculation_pipeline_publishes_once);
+
+    // FastMath
+    RUN_TEST(test_fast_math_sin_cos_error_bound);
+    RUN_TEST(test_fast_math_atan2_error_bound);
+    RUN_TEST(test_fast_math_lut_error_bound);
+
+    // Damping filters
+    RUN_TEST(test_damping_ema_time_constant);
+    RUN_TEST(test_damping_circular_wraps);
+    RUN_TEST(test_damping_kalman_converges);
+    RUN_TEST(test_damping_off_passthrough);
+    RUN_TEST(test_damping_calculation_stage);
+
+    // Polar table
+    RUN_TEST(test_polar_table_bilinear_lookup);
+    RUN_TEST(test_polar_table_index_steps);
+    RUN_TEST(test_polar_table_vmg_targets);
+    RUN_TEST(test_polar_table_rejects_invalid);
+    RUN_TEST(test_polar_table_calculation_stage);
+
+    // Data tables partition
+    RUN_TEST(test_data_tables_directory);
+    RUN_TEST(test_data_tables_polar_matches_text);
+    RUN_TEST(test_variation_grid_lookup);
+    RUN_TEST(test_variation_grid_fallback);
+
+    // Input aligner
+    RUN_TEST(test_input_aligner_interpolates);
+    RUN_TEST(test_input_aligner_angle_wrap);
+    RUN_TEST(test_input_aligner_gaps_and_ordering);
+    RUN_TEST(test_input_aligner_calculation_stage);
+
+    // Derived statistics
+    RUN_TEST(test_derived_statistics_window_means);
+    RUN_TEST(test_derived_statistics_circular_mean);
+    RUN_TEST(test_derived_statistics_matches_brute_force);
+    RUN_TEST(test_derived_statistics_dropout);
+    RUN_TEST(test_derived_statistics_calculation_stage);
+    RUN_TEST(test_calibration_learner_wind_offset);
+    RUN_TEST(test_calibration_learner_wind_shift);
+    RUN_TEST(test_calibration_learner_leeway_regression);
+    RUN_TEST(test_calibration_learner_gates_and_window);
+    RUN_TEST(test_calibration_learner_apply_thresholds);
+
+    // Navigation engine
+    RUN_TEST(test_navigation_engine_opposite_heading);
+    RUN_TEST(test_navigation_engine_laylines);
+    RUN_TEST(test_navigation_engine_downwind_leg);
+    RUN_TEST(test_navigation_engine_fail_safe);
+
+    // AIS target table
+    RUN_TEST(test_ais_table_hash_and_eviction);
+    RUN_TEST(test_ais_table_cpa_tcpa_and_risk_list);
+    RUN_TEST(test_ais_table_incremental_pass);
+    RUN_TEST(test_ais_table_expiry);
+
+    // UTC clock
+    RUN_TEST(test_utc_clock_date_conversion);
+    RUN_TEST(test_utc_clock_step_then_slew);
+    RUN_TEST(test_utc_clock_source_priority);
+    RUN_TEST(test_utc_clock_millis_wrap);
+    RUN_TEST(test_utc_clock_replay_hold);
+    RUN_TEST(test_calc_batch_input_frames);
+    RUN_TEST(test_calc_batch_input_sentences);
+    RUN_TEST(test_calc_batch_input_csv);
+    RUN_TEST(test_calc_batch_input_replay_clock);
+    RUN_TEST(test_boatdata_delta_keyframe_first);
+    RUN_TEST(test_boatdata_delta_deadband);
+    RUN_TEST(test_boatdata_delta_keyframe_schedule);
+    RUN_TEST(test_signalk_delta_keyframe);
+    RUN_TEST(test_signalk_delta_changes);
+    RUN_TEST(test_stream_clients_modes);
+    RUN_TEST(test_stream_clients_buckets);
+    RUN_TEST(test_stream_clients_governed_rate);
+    RUN_TEST(test_stream_clients_backpressure);
+    RUN_TEST(test_stream_clients_binary_layout);
+    RUN_TEST(test_rate_governor_backs_off);
+    RUN_TEST(test_rate_governor_speeds_up_when_idle);
+    RUN_TEST(test_rate_governor_unmeasured_loop);
+    RUN_TEST(test_rate_governor_cpu_idle);
+    RUN_TEST(test_rate_governor_range);
+
+    // Calculation benchmark
+    RUN_TEST(test_calculation_benchmark_summarize);
+    RUN_TEST(test_calculation_benchmark_stages);
+
+    // 1-Wire conversion state machine tests
+    RUN_TEST(test_onewire_conversion_bounded_steps);
+    RUN_TEST(test_onewire_conversion_crc_retry_and_absent_bus);
+    RUN_TEST(test_onewire_conversion_schedule_and_stats);
+
+    // 1-Wire device map tests
+    RUN_TEST(test_onewire_device_map_assign_and_replace);
+    RUN_TEST(test_onewire_device_map_record_round_trip);
+
+    // mDNS advertisement tests
+    RUN_TEST(test_mdns_advertisement_records);
+    RUN_TEST(test_mdns_advertisement_change_detection);
+
+    // Admission control tests
+    RUN_TEST(test_admission_endpoint_limits);
+    RUN_TEST(test_admission_heap_budget);
+
+    // Wi-Fi power profile tests
+    RUN_TEST(test_wifi_profile_selection);
+    RUN_TEST(test_wifi_profile_round_trip);
+    RUN_TEST(test_wifi_profile_record);
+
+    // BoatData replay ring tests
+    RUN_TEST(test_boatdata_replay_since);
+    RUN_TEST(test_boatdata_replay_requests);
+
+    // Pipeline latency probe tests
+    RUN_TEST(test_pipeline_latency_per_group_and_output);
+    RUN_TEST(test_pipeline_latency_derived_from_inputs);
+    RUN_TEST(test_pipeline_latency_outputs_and_arming);
+    RUN_TEST(test_pipeline_latency_boatdata_observer);
+
     return UNITY_END();
 }
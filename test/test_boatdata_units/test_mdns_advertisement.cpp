@@ -0,0 +1,86 @@
+/**
+ * @file test_mdns_advertisement.cpp
+ * @brief Unit tests for MdnsAdvertisement (precomputed DNS-SD records and TXT items)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/MdnsAdvertisement.h"
+#include "../../src/utils/MdnsAdvertisement.cpp"
+
+namespace {
+
+MdnsAdvertConfig defaultConfig() {
+    MdnsAdvertConfig config;
+    config.httpPort = 80;
+    config.nmea0183Tcp = true;
+    config.nmea0183Port = 10110;
+    config.nmea0183Clients = 4;
+    config.nmea0183Talker = "II";
+    config.udp = true;
+    config.udpGroup = "239.255.42.1";
+    config.udpPort = 10120;
+    return config;
+}
+
+}  // namespace
+
+/**
+ * @test The three services carry their ports and endpoint/format TXT items
+ */
+void test_mdns_advertisement_records(void) {
+    MdnsAdvertisement advertisement;
+    TEST_ASSERT_TRUE(advertisement.build(defaultConfig()));
+    TEST_ASSERT_EQUAL_UINT8(3, advertisement.getServiceCount());
+
+    const MdnsServiceRecord* gateway = advertisement.findService("_poseidon2");
+    TEST_ASSERT_NOT_NULL(gateway);
+    TEST_ASSERT_EQUAL_STRING("_tcp", gateway->proto);
+    TEST_ASSERT_EQUAL_UINT16(80, gateway->port);
+    TEST_ASSERT_EQUAL_STRING("/boatdata", MdnsAdvertisement::findTxt(*gateway, "ws"));
+    TEST_ASSERT_EQUAL_STRING("json,delta,bin", MdnsAdvertisement::findTxt(*gateway, "fmt"));
+    TEST_ASSERT_EQUAL_STRING("/api/boatdata", MdnsAdvertisement::findTxt(*gateway, "api"));
+    TEST_ASSERT_EQUAL_STRING("239.255.42.1:10120", MdnsAdvertisement::findTxt(*gateway, "udp"));
+
+    const MdnsServiceRecord* signalK = advertisement.findService("_signalk-ws");
+    TEST_ASSERT_NOT_NULL(signalK);
+    TEST_ASSERT_EQUAL_STRING("/signalk/v1/stream", MdnsAdvertisement::findTxt(*signalK, "path"));
+
+    const MdnsServiceRecord* nmea = advertisement.findService("_nmea-0183");
+    TEST_ASSERT_NOT_NULL(nmea);
+    TEST_ASSERT_EQUAL_UINT16(10110, nmea->port);
+    TEST_ASSERT_EQUAL_STRING("II", MdnsAdvertisement::findTxt(*nmea, "talker"));
+    TEST_ASSERT_EQUAL_STRING("4", MdnsAdvertisement::findTxt(*nmea, "clients"));
+    TEST_ASSERT_NULL(MdnsAdvertisement::findTxt(*nmea, "udp"));
+    TEST_ASSERT_NULL(advertisement.getService(3));
+}
+
+/**
+ * @test A rebuild reports a change only when the records differ
+ */
+void test_mdns_advertisement_change_detection(void) {
+    MdnsAdvertisement advertisement;
+    MdnsAdvertConfig config = defaultConfig();
+    TEST_ASSERT_TRUE(advertisement.build(config));
+    uint32_t fingerprint = advertisement.getFingerprint();
+
+    TEST_ASSERT_FALSE(advertisement.build(config));
+    TEST_ASSERT_EQUAL_UINT32(fingerprint, advertisement.getFingerprint());
+    TEST_ASSERT_EQUAL_UINT32(1, advertisement.getChanges());
+
+    // A service that did not start is withdrawn
+    config.nmea0183Tcp = false;
+    TEST_ASSERT_TRUE(advertisement.build(config));
+    TEST_ASSERT_EQUAL_UINT8(2, advertisement.getServiceCount());
+    TEST_ASSERT_NULL(advertisement.findService("_nmea-0183"));
+
+    // A TXT value alone changes the fingerprint
+    config.udpPort = 10121;
+    TEST_ASSERT_TRUE(advertisement.build(config));
+    TEST_ASSERT_EQUAL_STRING("239.255.42.1:10121",
+                             MdnsAdvertisement::findTxt(*advertisement.findService("_poseidon2"), "udp"));
+    config.udp = false;
+    TEST_ASSERT_TRUE(advertisement.build(config));
+    TEST_ASSERT_NULL(MdnsAdvertisement::findTxt(*advertisement.findService("_poseidon2"), "udp"));
+    TEST_ASSERT_EQUAL_UINT32(4, advertisement.getChanges());
+}
@@ -0,0 +1,203 @@
+/**
+ * @file test_navigation_engine.cpp
+ * @brief Opposite-tack heading, waypoint laylines and their fail-safe outputs
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/components/NavigationEngine.h"
+#include "../../src/components/NavigationEngine.cpp"
+
+namespace {
+
+const char* const NAV_POLAR =
+    "twa/tws\t6\t10\t16\n"
+    "40\t4.8\t6.1\t6.6\n"
+    "50\t5.4\t6.7\t7.1\n"
+    "90\t6.2\t7.5\t8.1\n"
+    "140\t5.0\t6.8\t7.9\n"
+    "170\t3.9\t5.6\t7.0\n";
+
+const double DEG = 0.017453292519943295;
+
+/// Derived wind at 0,0 with no averages yet (instantaneous values used)
+BoatDataStructure boatAt(double twd, double twa, double tws, double stw) {
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.gps.available = true;
+    data.derived.available = true;
+    data.derived.wdir = twd;
+    data.derived.twa = twa;
+    data.derived.tws = tws;
+    data.derived.stw = stw;
+    data.derived.wdirAvg1m = NAN;
+    data.derived.twsAvg1m = NAN;
+    return data;
+}
+
+/// Waypoint @p northNm / @p eastNm from 0,0
+WaypointData waypointAt(double northNm, double eastNm, unsigned long lastUpdate) {
+    WaypointData waypoint;
+    waypoint.latitude = northNm / 60.0;
+    waypoint.longitude = eastNm / 60.0;
+    waypoint.number = 7;
+    waypoint.available = true;
+    waypoint.lastUpdate = lastUpdate;
+    return waypoint;
+}
+
+/// Angular distance (radians)
+double angleDistance(double a, double b) {
+    return std::fabs(std::remainder(a - b, 2.0 * M_PI));
+}
+
+}  // namespace
+
+/**
+ * @test The opposite tack mirrors the current TWA (no polar) or the polar beat angle about the averaged TWD
+ */
+void test_navigation_engine_opposite_heading(void) {
+    NavigationEngine engine;
+    NavigationData nav;
+    WaypointData none;
+    memset(&none, 0, sizeof(none));
+
+    // Starboard tack, wind from 10 deg at TWA 45: heading 325, tack to 55
+    BoatDataStructure data = boatAt(10.0 * DEG, 45.0 * DEG, 10.0, 6.0);
+    engine.update(data, none, 1000);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_TRUE(nav.available);
+    TEST_ASSERT_TRUE(angleDistance(nav.oppositeHeading, 55.0 * DEG) < 1e-4);
+    TEST_ASSERT_TRUE(isnan(nav.waypointBearing));
+
+    // Port tack with a polar: the 1 min TWD/TWS win over the instantaneous values
+    PolarTable polar;
+    TEST_ASSERT_TRUE(polar.parse(NAV_POLAR));
+    PolarTarget beat;
+    TEST_ASSERT_TRUE(polar.target(12.0f, false, beat));
+    engine.setPolar(&polar);
+    data = boatAt(10.0 * DEG, -38.0 * DEG, 8.0, 6.0);
+    data.derived.wdirAvg1m = static_cast<float>(355.0 * DEG);
+    data.derived.twsAvg1m = 12.0f;
+    engine.update(data, none, 2000);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_FLOAT_WITHIN(1e-5, beat.twa, nav.targetAngle);
+    TEST_ASSERT_TRUE(angleDistance(nav.oppositeHeading, 355.0 * DEG - beat.twa) < 1e-4);
+    TEST_ASSERT_TRUE(nav.oppositeHeading >= 0.0f && nav.oppositeHeading < 2.0f * M_PI);
+
+    // Downwind, starboard gybe: mirrored at the run angle
+    PolarTarget run;
+    TEST_ASSERT_TRUE(polar.target(12.0f, true, run));
+    data.derived.twa = 150.0 * DEG;
+    engine.update(data, none, 3000);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_TRUE(angleDistance(nav.oppositeHeading, 355.0 * DEG + run.twa) < 1e-4);
+}
+
+/**
+ * @test Laylines through the waypoint, and the distance and time to the layline on the current tack
+ */
+void test_navigation_engine_laylines(void) {
+    NavigationEngine engine;
+    NavigationData nav;
+
+    // Wind from north, beating at 45 deg, waypoint 2 nm north, 1 nm east
+    BoatDataStructure data = boatAt(0.0, 45.0 * DEG, 12.0, 6.0);
+    engine.update(data, waypointAt(2.0, 1.0, 1000), 1500);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_TRUE(nav.upwindLeg);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, sqrt(5.0), nav.waypointDistance);
+    TEST_ASSERT_TRUE(angleDistance(nav.waypointBearing, atan2(1.0, 2.0)) < 1e-4);
+    TEST_ASSERT_TRUE(angleDistance(nav.laylineStarboard, 315.0 * DEG) < 1e-4);
+    TEST_ASSERT_TRUE(angleDistance(nav.laylinePort, 45.0 * DEG) < 1e-4);
+
+    // (1, 2) = a·(-s, s) + b·(s, s), s = sin 45: a = 0.5 / s on starboard, then b = 1.5 / s on port
+    double s = sin(45.0 * DEG);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 0.5 / s, nav.distanceToLayline);
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 0.5 / s / 6.0 * 3600.0, nav.timeToLayline);
+
+    // Port tack sails the other share
+    data.derived.twa = -45.0 * DEG;
+    engine.update(data, waypointAt(2.0, 1.0, 1000), 1500);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 1.5 / s, nav.distanceToLayline);
+
+    // Waypoint beyond the starboard layline: tack now, nothing left on port
+    engine.update(data, waypointAt(1.0, -3.0, 1000), 1500);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.0, nav.distanceToLayline);
+
+    // Bearings follow the GPS variation like COG
+    data.gps.variation = 5.0 * DEG;
+    engine.update(data, waypointAt(2.0, 0.0, 1000), 1500);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_TRUE(angleDistance(nav.waypointBearing, 5.0 * DEG) < 1e-4);
+}
+
+/**
+ * @test A waypoint downwind uses the polar run angle for the laylines
+ */
+void test_navigation_engine_downwind_leg(void) {
+    PolarTable polar;
+    TEST_ASSERT_TRUE(polar.parse(NAV_POLAR));
+    PolarTarget run;
+    TEST_ASSERT_TRUE(polar.target(10.0f, true, run));
+
+    NavigationEngine engine;
+    engine.setPolar(&polar);
+    BoatDataStructure data = boatAt(0.0, 45.0 * DEG, 10.0, 6.0);
+    engine.update(data, waypointAt(-3.0, 0.5, 1000), 1000);
+
+    NavigationData nav;
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_FALSE(nav.upwindLeg);
+    TEST_ASSERT_TRUE(angleDistance(nav.laylineStarboard, -run.twa) < 1e-4);
+    TEST_ASSERT_TRUE(angleDistance(nav.laylinePort, run.twa) < 1e-4);
+    TEST_ASSERT_TRUE(nav.distanceToLayline >= 0.0f);
+}
+
+/**
+ * @test Stale or missing inputs give NaN outputs instead of old values
+ */
+void test_navigation_engine_fail_safe(void) {
+    NavigationEngine engine;
+    NavigationData nav;
+    BoatDataStructure data = boatAt(0.0, 45.0 * DEG, 12.0, 6.0);
+
+    engine.update(data, waypointAt(2.0, 1.0, 1000), 1000);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_TRUE(isfinite(nav.distanceToLayline));
+
+    // Waypoint not refreshed within NAV_WAYPOINT_TIMEOUT_MS
+    engine.update(data, waypointAt(2.0, 1.0, 1000), 1000 + NAV_WAYPOINT_TIMEOUT_MS + 1);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_TRUE(nav.available);
+    TEST_ASSERT_TRUE(isnan(nav.waypointBearing));
+    TEST_ASSERT_TRUE(isnan(nav.distanceToLayline));
+
+    // No GPS fix, and not moving: laylines without a time
+    data.gps.available = false;
+    engine.update(data, waypointAt(2.0, 1.0, 5000), 5000);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_TRUE(isnan(nav.laylinePort));
+    data.gps.available = true;
+    data.derived.stw = 0.0;
+    engine.update(data, waypointAt(2.0, 1.0, 5000), 5000);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_TRUE(isfinite(nav.distanceToLayline));
+    TEST_ASSERT_TRUE(isnan(nav.timeToLayline));
+
+    // Derived data unavailable
+    data.derived.available = false;
+    engine.update(data, waypointAt(2.0, 1.0, 5000), 5000);
+    TEST_ASSERT_TRUE(engine.read(nav));
+    TEST_ASSERT_FALSE(nav.available);
+    TEST_ASSERT_TRUE(isnan(nav.oppositeHeading));
+    TEST_ASSERT_TRUE(isnan(nav.waypointDistance));
+
+    // JSON: waypoint object only with a current waypoint
+    StaticJsonWriter<384> json;
+    NavigationEngine::writeJson(json, nav);
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"waypoint\":null"));
+    TEST_ASSERT_FALSE(json.overflowed());
+}
@@ -0,0 +1,205 @@
+/**
+ * @file test_onewire_conversion.cpp
+ * @brief Stepped DS2438 conversion cycle: bus time per step, schedule, statistics, decoding, CRC retry
+ */
+
+#include <unity.h>
+#include "../../src/utils/OneWireConversion.h"
+#include "../../src/utils/OneWireConversion.cpp"
+#include "../../src/mocks/MockOneWireBus.h"
+#include "../../src/utils/JsonWriter.h"
+#include <string.h>
+
+namespace {
+
+uint32_t fakeMicros = 0;
+
+uint32_t readFakeMicros() {
+    return fakeMicros;
+}
+
+const uint8_t ROM_SAIL[8] = {0x26, 1, 0, 0, 0, 0, 0, 0x11};
+const uint8_t ROM_BATT_A[8] = {0x26, 2, 0, 0, 0, 0, 0, 0x22};
+const uint8_t ROM_BATT_B[8] = {0x26, 3, 0, 0, 0, 0, 0, 0x33};
+
+/// Step every 5 ms (I/O pump) until a cycle completes; returns the steps taken
+int runCycle(OneWireConversion& conversion, uint32_t& nowMs, uint32_t& maxStepUs) {
+    for (int steps = 1; steps < 1000; steps++) {
+        uint32_t before = fakeMicros;
+        bool done = conversion.step(nowMs);
+        if (fakeMicros - before > maxStepUs) {
+            maxStepUs = fakeMicros - before;
+        }
+        nowMs += 5;
+        if (done) {
+            return steps;
+        }
+    }
+    return -1;
+}
+
+}  // namespace
+
+/**
+ * @test A cycle converts all devices once, waits without bus traffic and reads them in ~1 ms steps
+ */
+void test_onewire_conversion_bounded_steps(void) {
+    fakeMicros = 0;
+    MockOneWireBus bus;
+    bus.setClock(&fakeMicros);
+    bus.setPage(bus.addDevice(ROM_SAIL), 4.8f, 0, 20.0f);
+    bus.setPage(bus.addDevice(ROM_BATT_A), 6.30f, -410, 21.5f);
+    bus.setPage(bus.addDevice(ROM_BATT_B), 6.35f, 82, 21.0f);
+
+    OneWireConversion conversion(&bus, readFakeMicros);
+    conversion.setDevice(OneWireDevice::SAILDRIVE, ROM_SAIL);
+    conversion.setDevice(OneWireDevice::BATTERY_A, ROM_BATT_A);
+    conversion.setDevice(OneWireDevice::BATTERY_B, ROM_BATT_B);
+
+    // Convert-all (reset, then the two command bytes on the next step), then nothing on the bus while converting
+    uint32_t nowMs = 0;
+    for (int i = 0; i < 3 && bus.getConversions() == 0; i++) {
+        conversion.step(nowMs);
+    }
+    TEST_ASSERT_EQUAL_INT(1, bus.getConversions());
+    TEST_ASSERT_EQUAL_INT(1, bus.getResets());
+    int busOps = bus.getResets() + bus.getWrites();
+    conversion.step(nowMs + ONEWIRE_CONVERSION_MS - 1);
+    TEST_ASSERT_EQUAL_INT(busOps, bus.getResets() + bus.getWrites());
+
+    uint32_t maxStepUs = 0;
+    nowMs = ONEWIRE_CONVERSION_MS;
+    int steps = runCycle(conversion, nowMs, maxStepUs);
+    TEST_ASSERT_TRUE(steps > 20);                        // Spread over many ticks
+    TEST_ASSERT_TRUE(maxStepUs <= ONEWIRE_STEP_BUDGET_US);
+    TEST_ASSERT_TRUE(conversion.getMaxStepUs() <= ONEWIRE_STEP_BUDGET_US);
+    TEST_ASSERT_EQUAL_UINT8(0x0F, conversion.getCycleDevices());  // First cycle reads everything
+
+    // Decoded values; shore power was never found
+    const OneWireResult& battA = conversion.getResult(OneWireDevice::BATTERY_A);
+    TEST_ASSERT_TRUE(battA.ok);
+    TEST_ASSERT_FLOAT_WITHIN(0.005f, 6.30f, battA.reading.voltage);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 21.5f, battA.reading.temperatureC);
+    TEST_ASSERT_EQUAL_INT16(-410, battA.reading.currentRaw);
+    TEST_ASSERT_FALSE(conversion.getResult(OneWireDevice::SHORE_POWER).ok);
+    TEST_ASSERT_TRUE(DS2438DigitalState(conversion.getResult(OneWireDevice::SAILDRIVE).reading));
+
+    BatteryMonitorData battery;
+    DS2438ToBattery(battA.reading, battery);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 6.30 * ONEWIRE_BATTERY_DIVIDER, battery.voltage);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, -410 / (4096.0 * ONEWIRE_SHUNT_OHMS), battery.amperage);
+    TEST_ASSERT_TRUE(battery.stateOfCharge >= 0 && battery.stateOfCharge <= 100);
+
+    // Next cycle only after ONEWIRE_CYCLE_MS, and only the saildrive
+    TEST_ASSERT_FALSE(conversion.step(nowMs));
+    nowMs = ONEWIRE_CYCLE_MS;
+    runCycle(conversion, nowMs, maxStepUs);
+    TEST_ASSERT_EQUAL_UINT8(0x01, conversion.getCycleDevices());
+    TEST_ASSERT_EQUAL_INT(2, bus.getConversions());
+    TEST_ASSERT_EQUAL_UINT32(2, conversion.getCycles());
+}
+
+/**
+ * @test One CRC error is retried, two fail the reading; no presence fails the whole cycle
+ */
+void test_onewire_conversion_crc_retry_and_absent_bus(void) {
+    fakeMicros = 0;
+    MockOneWireBus bus;
+    bus.setClock(&fakeMicros);
+    bus.setPage(bus.addDevice(ROM_SAIL), 0.2f, 0, 20.0f);
+
+    OneWireConversion conversion(&bus, readFakeMicros);
+    conversion.setDevice(OneWireDevice::SAILDRIVE, ROM_SAIL);
+
+    uint32_t maxStepUs = 0;
+    uint32_t nowMs = 0;
+    bus.corruptNextReads(1);
+    runCycle(conversion, nowMs, maxStepUs);
+    TEST_ASSERT_TRUE(conversion.getResult(OneWireDevice::SAILDRIVE).ok);
+    TEST_ASSERT_FALSE(DS2438DigitalState(conversion.getResult(OneWireDevice::SAILDRIVE).reading));
+    TEST_ASSERT_EQUAL_UINT32(1, conversion.getCrcErrors());
+
+    nowMs = ONEWIRE_CYCLE_MS;
+    bus.corruptNextReads(2);
+    runCycle(conversion, nowMs, maxStepUs);
+    TEST_ASSERT_FALSE(conversion.getResult(OneWireDevice::SAILDRIVE).ok);
+    TEST_ASSERT_EQUAL_UINT32(3, conversion.getCrcErrors());
+
+    // Unplugged: the convert reset sees no presence, the cycle ends at once with failures
+    nowMs = 2 * ONEWIRE_CYCLE_MS;
+    bus.setPresent(false);
+    TEST_ASSERT_EQUAL_INT(1, runCycle(conversion, nowMs, maxStepUs));
+    TEST_ASSERT_EQUAL_UINT8(0x0F, conversion.getCycleDevices());
+    TEST_ASSERT_FALSE(conversion.getResult(OneWireDevice::SAILDRIVE).ok);
+    TEST_ASSERT_FALSE(conversion.getResult(OneWireDevice::BATTERY_B).ok);
+
+    // Shore power decoding: off below the threshold, current x mains voltage when on
+    DS2438Reading reading = {20.0f, 4.0f, 41};
+    ShorePowerData shore;
+    DS2438ToShorePower(reading, shore);
+    TEST_ASSERT_TRUE(shore.shorePowerOn);
+    TEST_ASSERT_FLOAT_WITHIN(0.5, 41 / (4096.0 * ONEWIRE_SHUNT_OHMS) * ONEWIRE_SHORE_VOLTAGE_V, shore.power);
+
+    // CRC8 check value of the Dallas polynomial
+    const uint8_t rom[7] = {0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00};
+    TEST_ASSERT_EQUAL_UINT8(0xA2, OneWireCrc8(rom, 7));
+}
+
+/**
+ * @test Per-device periods plan the schedule; statistics and health follow the reads
+ */
+void test_onewire_conversion_schedule_and_stats(void) {
+    fakeMicros = 0;
+    MockOneWireBus bus;
+    bus.setClock(&fakeMicros);
+    bus.setPage(bus.addDevice(ROM_BATT_A), 6.30f, 0, 21.0f);
+    bus.setPage(bus.addDevice(ROM_BATT_B), 6.30f, 0, 21.0f);
+
+    // No saildrive: battery A every 2 slots, battery B every 3
+    OneWireConversion conversion(&bus, readFakeMicros);
+    conversion.setDevice(OneWireDevice::BATTERY_A, ROM_BATT_A, 2000);
+    conversion.setDevice(OneWireDevice::BATTERY_B, ROM_BATT_B, 3000);
+    TEST_ASSERT_FALSE(conversion.isHealthy(0));
+
+    uint8_t battA = 1u << static_cast<uint8_t>(OneWireDevice::BATTERY_A);
+    uint8_t battB = 1u << static_cast<uint8_t>(OneWireDevice::BATTERY_B);
+    uint8_t sail = 1u << static_cast<uint8_t>(OneWireDevice::SAILDRIVE);
+    uint8_t shore = 1u << static_cast<uint8_t>(OneWireDevice::SHORE_POWER);
+    uint32_t maxStepUs = 0;
+    uint32_t nowMs = 0;
+    runCycle(conversion, nowMs, maxStepUs);               // Slot 0: everything due
+    TEST_ASSERT_EQUAL_UINT8(0x0F, conversion.getCycleDevices());
+    TEST_ASSERT_TRUE(conversion.isHealthy(nowMs));
+
+    // Slot 1: the saildrive (default 1 s) is due but absent; shore power (default 2 s) likewise in slot 2
+    nowMs = ONEWIRE_CYCLE_MS;
+    runCycle(conversion, nowMs, maxStepUs);
+    TEST_ASSERT_EQUAL_UINT8(sail, conversion.getCycleDevices());
+    nowMs = 2 * ONEWIRE_CYCLE_MS;
+    runCycle(conversion, nowMs, maxStepUs);                // Slot 2
+    TEST_ASSERT_EQUAL_UINT8(sail | battA | shore, conversion.getCycleDevices());
+    nowMs = 3 * ONEWIRE_CYCLE_MS;
+    runCycle(conversion, nowMs, maxStepUs);                // Slot 3
+    TEST_ASSERT_EQUAL_UINT8(sail | battB, conversion.getCycleDevices());
+
+    const OneWireDeviceStats& a = conversion.getDeviceStats(OneWireDevice::BATTERY_A);
+    TEST_ASSERT_EQUAL_UINT32(2, a.reads);
+    TEST_ASSERT_EQUAL_UINT32(0, a.failures);
+    TEST_ASSERT_TRUE(a.lastLatencyMs >= ONEWIRE_CONVERSION_MS);
+    TEST_ASSERT_EQUAL_UINT32(4, conversion.getDeviceStats(OneWireDevice::SAILDRIVE).failures);
+    TEST_ASSERT_EQUAL_UINT32(10, conversion.getTransactions());  // 4 + 1 + 3 + 2
+    double utilization = conversion.getUtilization(nowMs);
+    TEST_ASSERT_TRUE(utilization > 0.5 && utilization < 10.0);
+
+    StaticJsonWriter<640> json;
+    TEST_ASSERT_TRUE(conversion.writeStats(json, nowMs));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"healthy\":true"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"name\":\"battery_b\",\"period_ms\":3000,\"reads\":2,"));
+    TEST_ASSERT_NULL(strstr(json.c_str(), "shore_power"));  // Only devices found on the bus
+
+    // Reset applied by the next step; bus silent for long enough = unhealthy
+    conversion.requestStatsReset();
+    conversion.step(nowMs);
+    TEST_ASSERT_EQUAL_UINT32(0, conversion.getTransactions());
+    TEST_ASSERT_FALSE(conversion.isHealthy(nowMs + ONEWIRE_HEALTH_TIMEOUT_MS + 1000));
+}
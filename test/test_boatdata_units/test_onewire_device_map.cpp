@@ -0,0 +1,106 @@
+/**
+ * @file test_onewire_device_map.cpp
+ * @brief Persisted 1-Wire ROM to role map: assignment, replacement, NVS record round trip
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/OneWireDeviceMap.h"
+#include "../../src/utils/OneWireDeviceMap.cpp"
+#include "../../src/utils/ConfigRecord.cpp"
+
+namespace {
+
+/// ROM of @p family with serial byte @p serial and a valid CRC
+void makeRom(uint8_t family, uint8_t serial, uint8_t rom[8]) {
+    memset(rom, 0, 8);
+    rom[0] = family;
+    rom[1] = serial;
+    rom[7] = OneWireCrc8(rom, 7);
+}
+
+}  // namespace
+
+/**
+ * @test Roles in discovery order, probes kept, a replacement takes the missing device's role
+ */
+void test_onewire_device_map_assign_and_replace(void) {
+    OneWireDeviceMap map;
+    uint8_t rom[6][8];
+    for (uint8_t i = 0; i < 5; i++) {
+        makeRom(DS2438_FAMILY, i + 1, rom[i]);
+    }
+    makeRom(DS18B20_FAMILY, 9, rom[5]);
+
+    TEST_ASSERT_EQUAL(OneWireRole::SAILDRIVE, map.assign(rom[0]));
+    TEST_ASSERT_EQUAL(OneWireRole::BATTERY_A, map.assign(rom[1]));
+    TEST_ASSERT_EQUAL(OneWireRole::TEMPERATURE, map.assign(rom[5]));
+    TEST_ASSERT_EQUAL(OneWireRole::BATTERY_B, map.assign(rom[2]));
+    TEST_ASSERT_EQUAL(OneWireRole::SHORE_POWER, map.assign(rom[3]));
+    TEST_ASSERT_EQUAL_UINT8(5, map.count());
+
+    // Known ROM: same role, no change to save
+    uint16_t version = map.version();
+    TEST_ASSERT_EQUAL(OneWireRole::BATTERY_A, map.assign(rom[1]));
+    TEST_ASSERT_EQUAL_UINT16(version, map.version());
+
+    // Fifth DS2438 while every device answers: no role for it
+    TEST_ASSERT_EQUAL(OneWireRole::NONE, map.assign(rom[4]));
+    uint8_t unknown[8];
+    makeRom(0x10, 1, unknown);
+    TEST_ASSERT_EQUAL(OneWireRole::NONE, map.assign(unknown));
+
+    // Battery B stops answering: the new DS2438 replaces it
+    map.setRoleMissing(OneWireRole::BATTERY_B);
+    TEST_ASSERT_FALSE(map.allVerified());
+    TEST_ASSERT_EQUAL(OneWireRole::BATTERY_B, map.assign(rom[4]));
+    TEST_ASSERT_TRUE(map.version() != version);
+    TEST_ASSERT_EQUAL_INT8(-1, map.find(rom[2]));
+    TEST_ASSERT_EQUAL_INT8(map.findRole(OneWireRole::BATTERY_B), map.find(rom[4]));
+    TEST_ASSERT_TRUE(map.allVerified());
+}
+
+/**
+ * @test The record restores ROMs and roles (unverified); damaged records and entries are refused
+ */
+void test_onewire_device_map_record_round_trip(void) {
+    OneWireDeviceMap map;
+    uint8_t sail[8], probe[8];
+    makeRom(DS2438_FAMILY, 1, sail);
+    makeRom(DS18B20_FAMILY, 2, probe);
+    map.assign(sail);
+    map.assign(probe);
+
+    uint8_t buffer[CONFIG_RECORD_MAX_BYTES];
+    size_t length = map.encodeRecord(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_UINT32(ConfigRecordWriter::HEADER_SIZE + 1 + 2 * 9, length);
+
+    OneWireDeviceMap restored;
+    TEST_ASSERT_EQUAL(ConfigRecordStatus::OK, restored.decodeRecord(buffer, length));
+    TEST_ASSERT_EQUAL_UINT8(2, restored.count());
+    TEST_ASSERT_EQUAL(OneWireRole::SAILDRIVE, restored.at(restored.find(sail)).role);
+    TEST_ASSERT_EQUAL(OneWireRole::TEMPERATURE, restored.at(restored.find(probe)).role);
+    TEST_ASSERT_FALSE(restored.allVerified());  // Until checked on the bus
+
+    TEST_ASSERT_EQUAL(ConfigRecordStatus::EMPTY, OneWireDeviceMap().decodeRecord(buffer, 0));
+    buffer[length - 1] ^= 0x40;
+    OneWireDeviceMap damaged;
+    TEST_ASSERT_EQUAL(ConfigRecordStatus::BAD_CRC, damaged.decodeRecord(buffer, length));
+    TEST_ASSERT_EQUAL_UINT8(0, damaged.count());
+
+    // An entry with a bad ROM CRC or a role of the wrong family is dropped
+    uint8_t forged[CONFIG_RECORD_MAX_BYTES];
+    ConfigRecordWriter out(forged, sizeof(forged));
+    uint8_t badRom[8];
+    makeRom(DS2438_FAMILY, 3, badRom);
+    badRom[7] ^= 0xFF;
+    out.putU8(3)
+        .putBytes(badRom, 8).putU8(static_cast<uint8_t>(OneWireRole::BATTERY_A))
+        .putBytes(probe, 8).putU8(static_cast<uint8_t>(OneWireRole::SHORE_POWER))
+        .putBytes(sail, 8).putU8(static_cast<uint8_t>(OneWireRole::BATTERY_B));
+    size_t forgedLength = out.finish(ONEWIRE_MAP_RECORD_SCHEMA);
+    OneWireDeviceMap partial;
+    TEST_ASSERT_EQUAL(ConfigRecordStatus::OK, partial.decodeRecord(forged, forgedLength));
+    TEST_ASSERT_EQUAL_UINT8(1, partial.count());
+    TEST_ASSERT_EQUAL(OneWireRole::BATTERY_B, partial.at(0).role);
+}
@@ -0,0 +1,132 @@
+/**
+ * @file test_output_pipeline.cpp
+ * @brief Unit tests for OutputPipeline (shared-encoding output dispatch)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/OutputPipeline.h"
+#include "../../src/utils/OutputPipeline.cpp"
+
+namespace {
+
+struct SinkRecorder {
+    int sends;
+    uint16_t lastChanged;
+    const BoatDataSnapshot* lastSnapshot;
+    uint32_t lastTimestampMs;
+};
+
+void recordSend(void* context, const OutputBatch& batch) {
+    SinkRecorder* recorder = static_cast<SinkRecorder*>(context);
+    recorder->sends++;
+    recorder->lastChanged = batch.changed;
+    recorder->lastSnapshot = batch.snapshotPtr;
+    recorder->lastTimestampMs = batch.snapshotPtr != nullptr ? batch.snapshot().timestampMs : 0;
+}
+
+BoatDataStructure emptyData() {
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    return data;
+}
+
+}  // namespace
+
+/**
+ * @test Due sinks share one snapshot; a sink without SNAPSHOT does not cause a fill
+ */
+void test_output_pipeline_shares_one_snapshot(void) {
+    BoatDataStructure data = emptyData();
+    BoatDataChangeTracker tracker;
+    OutputPipeline pipeline;
+    SinkRecorder a = {}, b = {}, c = {};
+    pipeline.add("a", BoatDataGroup::ALL, 200, 200, OutputEncoding::SNAPSHOT, recordSend, &a);
+    pipeline.add("b", BoatDataGroup::ALL, 2000, 2000, OutputEncoding::SNAPSHOT, recordSend, &b);
+    int8_t plain = pipeline.add("c", BoatDataGroup::ENGINE, 0, 0, OutputEncoding::NONE, recordSend, &c);
+
+    TEST_ASSERT_EQUAL_UINT8(2, pipeline.run(data, tracker, 1000));  // Heartbeat sinks start at once
+    TEST_ASSERT_EQUAL_UINT32(1, pipeline.getSnapshotFills());
+    TEST_ASSERT_EQUAL_UINT32(2, pipeline.getSnapshotShares());
+    TEST_ASSERT_TRUE(a.lastSnapshot == b.lastSnapshot);
+    TEST_ASSERT_EQUAL_UINT32(1000, a.lastTimestampMs);
+    TEST_ASSERT_EQUAL(0, c.sends);  // Changes only, none yet
+
+    tracker.markChanged(BoatDataGroup::ENGINE);
+    TEST_ASSERT_EQUAL_UINT8(1, pipeline.run(data, tracker, 1010));
+    TEST_ASSERT_EQUAL(1, c.sends);
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::ENGINE, c.lastChanged);
+    TEST_ASSERT_NULL(c.lastSnapshot);
+    TEST_ASSERT_EQUAL_UINT32(1, pipeline.getSnapshotFills());
+    TEST_ASSERT_EQUAL_UINT32(1, pipeline.getSends(plain));
+
+    // 2 s later both periodic sinks fall due on the same run
+    for (uint32_t now = 1020; now <= 3000; now += 10) {
+        pipeline.run(data, tracker, now);
+    }
+    TEST_ASSERT_EQUAL(11, a.sends);
+    TEST_ASSERT_EQUAL(2, b.sends);
+    TEST_ASSERT_EQUAL_UINT32(11, pipeline.getSnapshotFills());  // One per run with a due snapshot sink
+    TEST_ASSERT_EQUAL_UINT32(13, pipeline.getSnapshotShares());
+}
+
+/**
+ * @test Change-only sinks follow their groups and never send closer than the interval
+ */
+void test_output_pipeline_changes_and_interval(void) {
+    BoatDataStructure data = emptyData();
+    BoatDataChangeTracker tracker;
+    OutputPipeline pipeline;
+    SinkRecorder wind = {};
+    int8_t id = pipeline.add("wind", BoatDataGroup::WIND, 100, 0, OutputEncoding::NONE, recordSend, &wind);
+
+    tracker.markChanged(BoatDataGroup::GPS);
+    TEST_ASSERT_EQUAL_UINT8(0, pipeline.run(data, tracker, 0));  // Not its group
+
+    tracker.markChanged(BoatDataGroup::WIND);
+    TEST_ASSERT_EQUAL_UINT8(1, pipeline.run(data, tracker, 10));
+    tracker.markChanged(BoatDataGroup::WIND | BoatDataGroup::GPS);
+    TEST_ASSERT_EQUAL_UINT8(0, pipeline.run(data, tracker, 50));  // Within the interval
+    TEST_ASSERT_EQUAL_UINT8(1, pipeline.run(data, tracker, 110));
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::WIND, wind.lastChanged);
+
+    // Late change: the next send is a full interval after it, not after the missed deadline
+    tracker.markChanged(BoatDataGroup::WIND);
+    TEST_ASSERT_EQUAL_UINT8(1, pipeline.run(data, tracker, 250));
+    tracker.markChanged(BoatDataGroup::WIND);
+    TEST_ASSERT_EQUAL_UINT8(0, pipeline.run(data, tracker, 320));
+    TEST_ASSERT_EQUAL_UINT8(1, pipeline.run(data, tracker, 350));
+
+    // Paused and re-rated
+    pipeline.setEnabled(id, false);
+    tracker.markChanged(BoatDataGroup::WIND);
+    TEST_ASSERT_EQUAL_UINT8(0, pipeline.run(data, tracker, 1000));
+    pipeline.setEnabled(id, true);
+    pipeline.setInterval(id, 1000, 0);
+    TEST_ASSERT_EQUAL_UINT8(0, pipeline.run(data, tracker, 1100));
+    TEST_ASSERT_EQUAL_UINT8(1, pipeline.run(data, tracker, 1350));
+    TEST_ASSERT_EQUAL(5, wind.sends);
+}
+
+/**
+ * @test Periodic sinks keep their phase despite dispatch jitter; the table is bounded
+ */
+void test_output_pipeline_periodic_phase_and_capacity(void) {
+    BoatDataStructure data = emptyData();
+    BoatDataChangeTracker tracker;
+    OutputPipeline pipeline;
+    SinkRecorder tick = {};
+    pipeline.add("tick", BoatDataGroup::ALL, 200, 200, OutputEncoding::NONE, recordSend, &tick);
+
+    // Runs every 30 ms: sends at 0, 210, 420, ... would drift; phase-kept sends stay at 5 per second
+    for (uint32_t now = 0; now < 10000; now += 30) {
+        pipeline.run(data, tracker, now);
+    }
+    TEST_ASSERT_EQUAL(50, tick.sends);
+
+    for (uint8_t i = pipeline.count(); i < OUTPUT_PIPELINE_MAX_SINKS; i++) {
+        TEST_ASSERT_TRUE(pipeline.add("x", BoatDataGroup::ALL, 100, 0, OutputEncoding::NONE, recordSend, &tick) >= 0);
+    }
+    TEST_ASSERT_EQUAL_INT8(-1, pipeline.add("y", BoatDataGroup::ALL, 100, 0, OutputEncoding::NONE, recordSend, &tick));
+    TEST_ASSERT_EQUAL_INT8(-1, pipeline.add("z", BoatDataGroup::ALL, 100, 0, OutputEncoding::NONE, nullptr, nullptr));
+}
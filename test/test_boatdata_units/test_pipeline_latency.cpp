@@ -0,0 +1,132 @@
+/**
+ * @file test_pipeline_latency.cpp
+ * @brief Unit tests for PipelineLatency (BoatData write to WebSocket frame latency)
+ *
+ * BoatData.cpp, BoatDataSchema.cpp, JsonWriter.cpp and LatencyHistogram.cpp
+ * are compiled in through other files of this suite.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/components/BoatData.h"
+#include "../../src/utils/PipelineLatency.h"
+#include "../../src/utils/PipelineLatency.cpp"
+
+namespace {
+
+constexpr uint8_t JSON_BIT = 1u << static_cast<uint8_t>(PipelineOutput::JSON);
+constexpr uint8_t BINARY_BIT = 1u << static_cast<uint8_t>(PipelineOutput::BINARY);
+
+}  // namespace
+
+/**
+ * @test The oldest unsent write of a group is measured once per output
+ */
+void test_pipeline_latency_per_group_and_output(void) {
+    static PipelineLatency probe;
+    probe.arm(0);
+    probe.setOutputs(JSON_BIT | BINARY_BIT);
+
+    probe.noteWrite(BoatDataGroup::GPS, 1000);
+    probe.noteWrite(BoatDataGroup::GPS, 2000);  // Older write still pending: kept
+    probe.recordSent(PipelineOutput::JSON, BoatDataGroup::GPS | BoatDataGroup::WIND, 400, 6000);
+
+    const LatencyHistogram& gps = probe.getGroup(BOATDATA_SCHEMA_GROUP_GPS);
+    TEST_ASSERT_EQUAL_UINT32(1, gps.getCount());
+    TEST_ASSERT_EQUAL_UINT32(5000, gps.getMax());
+    TEST_ASSERT_EQUAL_UINT32(0, probe.getGroup(BOATDATA_SCHEMA_GROUP_WIND).getCount());
+
+    // Sent again without a new write: nothing to measure
+    probe.recordSent(PipelineOutput::JSON, BoatDataGroup::GPS, 400, 7000);
+    TEST_ASSERT_EQUAL_UINT32(1, probe.getOutput(PipelineOutput::JSON).getCount());
+    TEST_ASSERT_EQUAL_UINT32(2, probe.getFrames(PipelineOutput::JSON));
+
+    // The binary clients still wait for the first write
+    probe.recordSent(PipelineOutput::BINARY, BoatDataGroup::ALL, 122, 9000);
+    TEST_ASSERT_EQUAL_UINT32(8000, probe.getOutput(PipelineOutput::BINARY).getMax());
+    TEST_ASSERT_EQUAL_UINT32(2, gps.getCount());
+    TEST_ASSERT_EQUAL_UINT32(2, probe.getWrites());
+}
+
+/**
+ * @test A calculation write inherits the oldest input since the previous one
+ */
+void test_pipeline_latency_derived_from_inputs(void) {
+    static PipelineLatency probe;
+    probe.arm(0);
+    probe.setOutputs(JSON_BIT);
+
+    probe.noteWrite(BoatDataGroup::WIND, 1000);
+    probe.noteWrite(BoatDataGroup::DST, 1500);
+    probe.noteWrite(BoatDataGroup::DERIVED, 3000);
+    probe.recordSent(PipelineOutput::JSON, BoatDataGroup::DERIVED, 300, 4000);
+    TEST_ASSERT_EQUAL_UINT32(3000, probe.getGroup(BOATDATA_SCHEMA_GROUP_DERIVED).getMax());
+
+    // No input since: measured from the calculation itself
+    probe.noteWrite(BoatDataGroup::DERIVED, 5000);
+    probe.recordSent(PipelineOutput::JSON, BoatDataGroup::DERIVED, 300, 5500);
+    TEST_ASSERT_EQUAL_UINT32(500, probe.getGroup(BOATDATA_SCHEMA_GROUP_DERIVED).getMin());
+}
+
+/**
+ * @test Outputs without clients keep nothing pending; disarmed probes record nothing
+ */
+void test_pipeline_latency_outputs_and_arming(void) {
+    static PipelineLatency probe;
+    probe.arm(0);
+    probe.setOutputs(JSON_BIT);
+    probe.noteWrite(BoatDataGroup::COMPASS, 1000);
+
+    // A binary client joins later: not charged with the earlier write
+    probe.setOutputs(JSON_BIT | BINARY_BIT);
+    probe.recordSent(PipelineOutput::BINARY, BoatDataGroup::COMPASS, 122, 90000);
+    TEST_ASSERT_EQUAL_UINT32(0, probe.getOutput(PipelineOutput::BINARY).getCount());
+
+    // The JSON client leaves: its pending write is dropped
+    probe.setOutputs(BINARY_BIT);
+    probe.setOutputs(JSON_BIT | BINARY_BIT);
+    probe.recordSent(PipelineOutput::JSON, BoatDataGroup::COMPASS, 400, 91000);
+    TEST_ASSERT_EQUAL_UINT32(0, probe.getOutput(PipelineOutput::JSON).getCount());
+
+    probe.disarm(100000);
+    probe.noteWrite(BoatDataGroup::COMPASS, 100000);
+    probe.recordSent(PipelineOutput::JSON, BoatDataGroup::COMPASS, 400, 101000);
+    TEST_ASSERT_FALSE(probe.isArmed());
+    TEST_ASSERT_EQUAL_UINT32(1, probe.getWrites());
+    TEST_ASSERT_EQUAL_UINT32(0, probe.getOutput(PipelineOutput::JSON).getCount());
+}
+
+/**
+ * @test BoatData reports writes to the observer; a queued patch carries its production time
+ */
+void test_pipeline_latency_boatdata_observer(void) {
+    static PipelineLatency probe;
+    BoatData boatData(nullptr);
+    boatData.setWriteObserver(PipelineLatency::observeWrite, &probe);
+    probe.arm(0);
+    probe.setOutputs(JSON_BIT);
+
+    WindData wind = boatData.getWindData();
+    wind.available = true;
+    boatData.setWindData(wind);
+    TEST_ASSERT_EQUAL_UINT32(1, probe.getWrites());
+
+    BoatDataPatchQueue queue;
+    boatData.deferPatches(&queue);
+    WindData values;
+    memset(&values, 0, sizeof(values));
+    values.apparentWindSpeed = 12.0;
+    boatData.patchWind(WindField::APPARENT_SPEED, values);
+    TEST_ASSERT_EQUAL_UINT32(1, probe.getWrites());  // Queued, not applied yet
+    BoatDataPatch patch;
+    TEST_ASSERT_TRUE(queue.pop(patch));
+    boatData.applyPatch(patch);
+    TEST_ASSERT_EQUAL_UINT32(2, probe.getWrites());
+
+    StaticJsonWriter<1024> json;
+    probe.recordSent(PipelineOutput::JSON, BoatDataGroup::WIND, 400, patch.producedUs + 250);
+    TEST_ASSERT_TRUE(probe.writeJson(json, 1000000));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"outputs\":{\"json\":{\"frames\":1,\"bytes\":400"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"groups\":{\"wind\":{\"samples\":1"));
+    boatData.deferPatches(nullptr);
+}
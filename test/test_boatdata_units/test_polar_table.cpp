@@ -0,0 +1,172 @@
+/**
+ * @file test_polar_table.cpp
+ * @brief Polar file parsing, interpolated lookup, VMG targets and the CalculationEngine polar stage
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/PolarTable.h"
+#include "../../src/utils/PolarTable.cpp"
+#include "../../src/components/CalculationEngine.h"
+
+namespace {
+
+const char* const POLAR =
+    "# Example 35 ft cruiser-racer\n"
+    "twa/tws\t6\t8\t10\t12\t16\t20\n"
+    "42\t4.9\t5.7\t6.2\t6.5\t6.7\t6.8\n"
+    "52\t5.5\t6.3\t6.8\t7.0\t7.2\t7.3\n"
+    "\n"
+    "90\t6.3\t7.2\t7.6\t7.9\t8.2\t8.4\n"
+    "150\t4.3\t5.3\t6.3\t7.0\t8.0\t8.9\n"
+    "180\t3.7\t4.6\t5.5\t6.4\t7.3\t8.1\n";
+
+const float DEG = 0.017453292519943295f;
+
+}  // namespace
+
+/**
+ * @test Grid points are returned exactly; between them the lookup is bilinear
+ */
+void test_polar_table_bilinear_lookup(void) {
+    PolarTable polar;
+    TEST_ASSERT_TRUE(polar.parse(POLAR));
+    TEST_ASSERT_EQUAL_UINT8(7, polar.twsCount());  // Implicit 0 kn column
+    TEST_ASSERT_EQUAL_UINT8(6, polar.twaCount());  // Implicit 0 deg row
+
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 7.6, polar.targetSpeed(10.0f, 90.0f * DEG));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 7.6, polar.targetSpeed(10.0f, -90.0f * DEG));  // Port tack
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 6.2, polar.targetSpeed(10.0f, 42.0f * DEG));
+
+    // TWS midway between 10 and 12, TWA midway between 52 and 90
+    float expected = 0.5f * (0.5f * (6.8f + 7.0f) + 0.5f * (7.6f + 7.9f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, expected, polar.targetSpeed(11.0f, 71.0f * DEG));
+
+    // Implicit zeros below the grid, edge values held above it
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 3.15, polar.targetSpeed(3.0f, 90.0f * DEG));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.0, polar.targetSpeed(10.0f, 0.0f));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 8.4, polar.targetSpeed(35.0f, 90.0f * DEG));
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 8.1, polar.targetSpeed(80.0f, 180.0f * DEG));
+
+    TEST_ASSERT_TRUE(isnan(polar.targetSpeed(NAN, 1.0f)));
+}
+
+/**
+ * @test The O(1) lookup matches a linear search over a dense sweep
+ */
+void test_polar_table_index_steps(void) {
+    // Grid points off the 0.25 kn / 1 deg steps, some closer than one step
+    PolarTable polar;
+    TEST_ASSERT_TRUE(polar.parse("x 3.1 3.2 7.7 30\n"
+                                 "33.3 1 2 3 4\n"
+                                 "33.6 2 3 4 5\n"
+                                 "100.5 5 6 7 8\n"));
+
+    const float tws[] = {0.0f, 3.1f, 3.2f, 7.7f, 30.0f};
+    const float twa[] = {0.0f, 33.3f * DEG, 33.6f * DEG, 100.5f * DEG};
+    const float speed[4][5] = {{0, 0, 0, 0, 0}, {0, 1, 2, 3, 4}, {0, 2, 3, 4, 5}, {0, 5, 6, 7, 8}};
+
+    for (float s = 0.0f; s < 29.9f; s += 0.037f) {
+        for (float a = 0.0f; a < 100.4f * DEG; a += 0.31f * DEG) {
+            int c = 0;
+            while (s >= tws[c + 1]) c++;
+            int r = 0;
+            while (a >= twa[r + 1]) r++;
+            float fc = (s - tws[c]) / (tws[c + 1] - tws[c]);
+            float fr = (a - twa[r]) / (twa[r + 1] - twa[r]);
+            float v0 = speed[r][c] + fc * (speed[r][c + 1] - speed[r][c]);
+            float v1 = speed[r + 1][c] + fc * (speed[r + 1][c + 1] - speed[r + 1][c]);
+            TEST_ASSERT_FLOAT_WITHIN(1e-3, v0 + fr * (v1 - v0), polar.targetSpeed(s, a));
+        }
+    }
+}
+
+/**
+ * @test Best VMG angles are found per TWS column at load time and interpolated between
+ */
+void test_polar_table_vmg_targets(void) {
+    PolarTable polar;
+    TEST_ASSERT_TRUE(polar.parse(POLAR));
+
+    // Brute-force best VMG at a grid column
+    float bestBeat = 0.0f;
+    float bestRun = 0.0f;
+    for (float deg = 0.0f; deg <= 180.0f; deg += 0.1f) {
+        float vmg = polar.targetSpeed(12.0f, deg * DEG) * cosf(deg * DEG);
+        bestBeat = fmaxf(bestBeat, vmg);
+        bestRun = fminf(bestRun, vmg);
+    }
+
+    PolarTarget beat, run;
+    TEST_ASSERT_TRUE(polar.target(12.0f, false, beat));
+    TEST_ASSERT_TRUE(polar.target(12.0f, true, run));
+    TEST_ASSERT_FLOAT_WITHIN(0.01, bestBeat, beat.vmg);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, bestRun, run.vmg);
+    TEST_ASSERT_TRUE(beat.twa > 40.0f * DEG && beat.twa < 60.0f * DEG);
+    TEST_ASSERT_TRUE(run.twa > 140.0f * DEG && run.twa <= 180.0f * DEG);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, polar.targetSpeed(12.0f, beat.twa), beat.speed);
+
+    // Between columns, and towards the implicit 0 kn column (angle kept)
+    PolarTarget b10, b11, b3, b6;
+    polar.target(10.0f, false, b10);
+    polar.target(11.0f, false, b11);
+    polar.target(3.0f, false, b3);
+    polar.target(6.0f, false, b6);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.5f * (b10.vmg + beat.vmg), b11.vmg);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, b6.twa, b3.twa);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 0.5f * b6.vmg, b3.vmg);
+}
+
+/**
+ * @test Malformed files are rejected with a reason and leave the table unloaded
+ */
+void test_polar_table_rejects_invalid(void) {
+    PolarTable polar;
+    TEST_ASSERT_FALSE(polar.parse("twa/tws 6 8\n52 5.5\n"));
+    TEST_ASSERT_EQUAL_STRING("row: speed count differs from TWS columns", polar.error());
+    TEST_ASSERT_FALSE(polar.loaded());
+    TEST_ASSERT_TRUE(isnan(polar.targetSpeed(8.0f, 1.0f)));
+
+    TEST_ASSERT_FALSE(polar.parse("twa/tws 8 6\n52 5.5 6.3\n"));
+    TEST_ASSERT_FALSE(polar.parse("twa/tws 6 8\n90 5.5 6.3\n52 5.5 6.3\n"));
+    TEST_ASSERT_FALSE(polar.parse("twa/tws 6 8\n52 5.5 fast\n"));
+    TEST_ASSERT_FALSE(polar.parse("twa/tws 6 8\n"));
+    TEST_ASSERT_FALSE(polar.parse(""));
+
+    TEST_ASSERT_TRUE(polar.parse("twa/tws 6 8\n52 5.5 6.3\n"));
+    TEST_ASSERT_EQUAL_STRING("", polar.error());
+}
+
+/**
+ * @test CalculationEngine publishes the polar targets for the current TWS/TWA
+ */
+void test_polar_table_calculation_stage(void) {
+    CalculationEngine engine;
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.gps.available = data.compass.available = data.wind.available = data.dst.available = true;
+    data.calibration.leewayCalibrationFactor = 10.0;
+    data.wind.apparentWindAngle = -0.6;  // Port tack, close-hauled
+    data.wind.apparentWindSpeed = 16.0;
+    data.dst.measuredBoatSpeed = 6.0;
+
+    engine.calculate(&data);
+    TEST_ASSERT_TRUE(isnan(data.derived.polarSpeed));
+    TEST_ASSERT_TRUE(isnan(data.derived.targetTwa));
+
+    PolarTable polar;
+    TEST_ASSERT_TRUE(polar.parse(POLAR));
+    engine.setPolar(&polar);
+    engine.calculate(&data);
+
+    const DerivedData& d = data.derived;
+    float expected = polar.targetSpeed(static_cast<float>(d.tws), static_cast<float>(d.twa));
+    PolarTarget beat;
+    polar.target(static_cast<float>(d.tws), false, beat);
+
+    TEST_ASSERT_TRUE(d.twa < 0.0);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, expected, d.polarSpeed);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, d.stw / expected * 100.0, d.polarPerformance);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, -beat.twa, d.targetTwa);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, beat.vmg, d.targetVmg);
+}
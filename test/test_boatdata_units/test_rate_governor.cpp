@@ -0,0 +1,148 @@
+/**
+ * @file test_rate_governor.cpp
+ * @brief /boatdata broadcast rate governor: back-off, hysteresis on the way up, outputs
+ */
+
+#include <unity.h>
+#include "../../src/utils/BoatDataRateGovernor.h"
+#include "../../src/utils/BoatDataRateGovernor.cpp"
+
+namespace {
+
+BoatDataGovernorInputs load(uint32_t loopHz, uint32_t freeHeap, uint32_t maxQueued) {
+    BoatDataGovernorInputs inputs;
+    inputs.loopHz = loopHz;
+    inputs.cpuIdlePct = CPU_IDLE_UNKNOWN;
+    inputs.freeHeap = freeHeap;
+    inputs.maxQueued = maxQueued;
+    return inputs;
+}
+
+const BoatDataGovernorInputs NORMAL_LOAD = load(BOATDATA_GOVERNOR_LOOP_HZ_LOW, BOATDATA_GOVERNOR_HEAP_LOW, 1);
+const BoatDataGovernorInputs IDLE_LOAD = load(BOATDATA_GOVERNOR_LOOP_HZ_IDLE, BOATDATA_GOVERNOR_HEAP_IDLE, 0);
+
+}  // namespace
+
+/**
+ * @test Each pressured input backs off one step per evaluation down to 0.5 Hz; normal load holds
+ */
+void test_rate_governor_backs_off(void) {
+    BoatDataRateGovernor governor;
+    TEST_ASSERT_EQUAL_UINT32(BOATDATA_BROADCAST_INTERVAL_MS, governor.getIntervalMs());
+    TEST_ASSERT_EQUAL_UINT8(BOATDATA_BROADCAST_INTERVAL_MS / BOATDATA_STREAM_TICK_MS, governor.getTicks());
+    TEST_ASSERT_EQUAL_UINT8(1, governor.getFloorTicks());
+    TEST_ASSERT_EQUAL_UINT32(BOATDATA_DELTA_KEYFRAME_MS, governor.getKeyframeMs());
+
+    TEST_ASSERT_FALSE(governor.evaluate(NORMAL_LOAD));
+    TEST_ASSERT_TRUE(governor.getState() == BoatDataGovernorState::NORMAL);
+
+    TEST_ASSERT_TRUE(governor.evaluate(load(BOATDATA_GOVERNOR_LOOP_HZ_LOW - 1, BOATDATA_GOVERNOR_HEAP_IDLE, 0)));
+    TEST_ASSERT_TRUE(governor.getState() == BoatDataGovernorState::PRESSURE);
+    TEST_ASSERT_EQUAL_UINT32(2000, governor.getIntervalMs());
+    TEST_ASSERT_EQUAL_UINT8(2000 / BOATDATA_STREAM_TICK_MS, governor.getTicks());
+    TEST_ASSERT_EQUAL_UINT8(governor.getTicks(), governor.getFloorTicks());  // Subscriptions slowed too
+    TEST_ASSERT_EQUAL_UINT32(BOATDATA_DELTA_KEYFRAME_MS * 2, governor.getKeyframeMs());
+
+    // Already at the slowest step: still pressure, no change
+    TEST_ASSERT_FALSE(governor.evaluate(load(BOATDATA_GOVERNOR_LOOP_HZ_IDLE, BOATDATA_GOVERNOR_HEAP_LOW - 1, 0)));
+    TEST_ASSERT_FALSE(governor.evaluate(load(BOATDATA_GOVERNOR_LOOP_HZ_IDLE, BOATDATA_GOVERNOR_HEAP_IDLE,
+                                             BOATDATA_STREAM_MAX_QUEUED)));
+    TEST_ASSERT_TRUE(governor.getState() == BoatDataGovernorState::PRESSURE);
+    TEST_ASSERT_EQUAL_UINT32(1, governor.getChanges());
+    TEST_ASSERT_EQUAL_UINT32(BOATDATA_STREAM_MAX_QUEUED, governor.getInputs().maxQueued);
+    TEST_ASSERT_EQUAL_STRING("pressure", BoatDataRateGovernor::stateName(governor.getState()));
+}
+
+/**
+ * @test Speeding up takes BOATDATA_GOVERNOR_IDLE_EVALUATIONS idle evaluations in a row per step, up to 5 Hz
+ */
+void test_rate_governor_speeds_up_when_idle(void) {
+    BoatDataRateGovernor governor;
+
+    for (uint8_t i = 1; i < BOATDATA_GOVERNOR_IDLE_EVALUATIONS; i++) {
+        TEST_ASSERT_FALSE(governor.evaluate(IDLE_LOAD));
+    }
+    TEST_ASSERT_FALSE(governor.evaluate(NORMAL_LOAD));  // Streak broken
+    for (uint8_t i = 1; i < BOATDATA_GOVERNOR_IDLE_EVALUATIONS; i++) {
+        TEST_ASSERT_FALSE(governor.evaluate(IDLE_LOAD));
+    }
+    TEST_ASSERT_TRUE(governor.getState() == BoatDataGovernorState::IDLE);
+    TEST_ASSERT_TRUE(governor.evaluate(IDLE_LOAD));
+    TEST_ASSERT_EQUAL_UINT32(500, governor.getIntervalMs());
+    TEST_ASSERT_EQUAL_UINT8(1, governor.getFloorTicks());
+    TEST_ASSERT_EQUAL_UINT32(BOATDATA_DELTA_KEYFRAME_MS / 2, governor.getKeyframeMs());
+
+    for (uint8_t i = 0; i < BOATDATA_GOVERNOR_IDLE_EVALUATIONS * 3; i++) {
+        governor.evaluate(IDLE_LOAD);
+    }
+    TEST_ASSERT_EQUAL_UINT32(200, governor.getIntervalMs());
+    TEST_ASSERT_EQUAL_UINT8(200 / BOATDATA_STREAM_TICK_MS, governor.getTicks());
+    TEST_ASSERT_EQUAL_UINT32(2, governor.getChanges());
+
+    // One pressured evaluation is enough to step back
+    TEST_ASSERT_TRUE(governor.evaluate(load(BOATDATA_GOVERNOR_LOOP_HZ_IDLE, BOATDATA_GOVERNOR_HEAP_IDLE,
+                                            BOATDATA_STREAM_MAX_QUEUED + 3)));
+    TEST_ASSERT_EQUAL_UINT32(500, governor.getIntervalMs());
+}
+
+/**
+ * @test An unmeasured loop frequency (0) neither pressures nor counts as idle
+ */
+void test_rate_governor_unmeasured_loop(void) {
+    BoatDataRateGovernor governor;
+    for (uint8_t i = 0; i < BOATDATA_GOVERNOR_IDLE_EVALUATIONS * 2; i++) {
+        TEST_ASSERT_FALSE(governor.evaluate(load(0, BOATDATA_GOVERNOR_HEAP_IDLE, 0)));
+        TEST_ASSERT_TRUE(governor.getState() == BoatDataGovernorState::NORMAL);
+    }
+    TEST_ASSERT_TRUE(governor.evaluate(load(0, BOATDATA_GOVERNOR_HEAP_LOW - 1, 0)));  // Heap still counts
+    TEST_ASSERT_EQUAL_UINT32(2000, governor.getIntervalMs());
+}
+
+/**
+ * @test A busy core backs off even with a fast loop; idle needs CPU headroom once it is measured
+ */
+void test_rate_governor_cpu_idle(void) {
+    BoatDataRateGovernor governor;
+    BoatDataGovernorInputs busy = IDLE_LOAD;
+    busy.cpuIdlePct = BOATDATA_GOVERNOR_CPU_IDLE_LOW - 1;
+    TEST_ASSERT_TRUE(governor.evaluate(busy));
+    TEST_ASSERT_TRUE(governor.getState() == BoatDataGovernorState::PRESSURE);
+    TEST_ASSERT_EQUAL_UINT32(2000, governor.getIntervalMs());
+
+    BoatDataGovernorInputs moderate = IDLE_LOAD;
+    moderate.cpuIdlePct = BOATDATA_GOVERNOR_CPU_IDLE_IDLE - 1;
+    TEST_ASSERT_FALSE(governor.evaluate(moderate));
+    TEST_ASSERT_TRUE(governor.getState() == BoatDataGovernorState::NORMAL);
+
+    BoatDataGovernorInputs idle = IDLE_LOAD;
+    idle.cpuIdlePct = BOATDATA_GOVERNOR_CPU_IDLE_IDLE;
+    governor.evaluate(idle);
+    TEST_ASSERT_TRUE(governor.getState() == BoatDataGovernorState::IDLE);
+    TEST_ASSERT_EQUAL_UINT8(BOATDATA_GOVERNOR_CPU_IDLE_IDLE, governor.getInputs().cpuIdlePct);
+}
+
+/**
+ * @test setRange() restarts at the profile default and caps how far idle load speeds up
+ */
+void test_rate_governor_range(void) {
+    BoatDataRateGovernor governor;
+    TEST_ASSERT_EQUAL_UINT32(200, governor.getFastestMs());
+
+    TEST_ASSERT_TRUE(governor.setRange(2000, 2000));   // Anchor
+    TEST_ASSERT_EQUAL_UINT32(2000, governor.getIntervalMs());
+    TEST_ASSERT_EQUAL_UINT32(2000, governor.getFastestMs());
+    for (uint8_t i = 0; i < BOATDATA_GOVERNOR_IDLE_EVALUATIONS * 3; i++) {
+        TEST_ASSERT_FALSE(governor.evaluate(IDLE_LOAD));
+    }
+    TEST_ASSERT_EQUAL_UINT32(2000, governor.getIntervalMs());
+    TEST_ASSERT_FALSE(governor.setRange(2000, 2000));   // Unchanged
+
+    TEST_ASSERT_TRUE(governor.setRange(200, 200));     // Racing: still backs off under pressure
+    TEST_ASSERT_EQUAL_UINT32(200, governor.getIntervalMs());
+    TEST_ASSERT_TRUE(governor.evaluate(load(BOATDATA_GOVERNOR_LOOP_HZ_LOW - 1, BOATDATA_GOVERNOR_HEAP_IDLE, 0)));
+    TEST_ASSERT_EQUAL_UINT32(500, governor.getIntervalMs());
+
+    TEST_ASSERT_TRUE(governor.setRange(700, 100));     // Rounded up to the ladder
+    TEST_ASSERT_EQUAL_UINT32(1000, governor.getIntervalMs());
+    TEST_ASSERT_EQUAL_UINT32(200, governor.getFastestMs());
+}
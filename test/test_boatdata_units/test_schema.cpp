@@ -0,0 +1,142 @@
+/**
+ * @file test_schema.cpp
+ * @brief Unit tests for BoatDataSchema (field table, generic access, JSON output)
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "../../src/utils/BoatDataSchema.h"
+#include "../../src/utils/BoatDataSchema.cpp"
+#include "../../src/utils/JsonWriter.cpp"
+
+/**
+ * @test Table entries point at their members and every group has its fields
+ */
+void test_schema_table_matches_structure(void) {
+    BoatDataStructure data;
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(&data);
+
+    const BoatDataFieldInfo& depth = BoatDataSchema::fieldInfo(BOATDATA_FIELD_DST_DEPTH);
+    TEST_ASSERT_EQUAL_STRING("depth", depth.key);
+    TEST_ASSERT_EQUAL_STRING("m", depth.unit);
+    TEST_ASSERT_EQUAL(reinterpret_cast<const uint8_t*>(&data.dst.depth) - base, depth.offset);
+    TEST_ASSERT_EQUAL(BOATDATA_SCHEMA_GROUP_DST, depth.group);
+
+    const BoatDataGroupInfo& shore = BoatDataSchema::groupInfo(BOATDATA_SCHEMA_GROUP_SHORE_POWER);
+    TEST_ASSERT_EQUAL_STRING("shorePower", shore.key);
+    TEST_ASSERT_EQUAL(BoatDataGroup::SHORE_POWER, shore.mask);
+    TEST_ASSERT_EQUAL(2, shore.fieldCount);
+    TEST_ASSERT_EQUAL(reinterpret_cast<const uint8_t*>(&data.versions.shorePower) - base, shore.lockOffset);
+
+    size_t fields = 0;
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        TEST_ASSERT_TRUE(BoatDataSchema::groupInfo(g).fieldCount > 0);
+        fields += BoatDataSchema::groupInfo(g).fieldCount;
+    }
+    TEST_ASSERT_EQUAL(BOATDATA_FIELD_COUNT, fields);
+
+    TEST_ASSERT_EQUAL(BOATDATA_FIELD_BATTERY_SOC_B, BoatDataSchema::findField("battery", "stateOfChargeB"));
+    TEST_ASSERT_EQUAL(BOATDATA_FIELD_COUNT, BoatDataSchema::findField("wind", "depth"));
+    TEST_ASSERT_EQUAL(BOATDATA_FIELD_COUNT, BoatDataSchema::findField(nullptr, "depth"));
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::WIND,
+                             BoatDataSchema::groupInfo(BoatDataSchema::findGroup("wind")).mask);
+    TEST_ASSERT_EQUAL(BOATDATA_SCHEMA_GROUP_COUNT, BoatDataSchema::findGroup("depth"));
+
+    // Deadbands: any change for counts and flags, never below the output precision otherwise
+    for (uint8_t id = 0; id < BOATDATA_FIELD_COUNT; id++) {
+        const BoatDataFieldInfo& info = BoatDataSchema::fieldInfo(id);
+        if (info.type == BOATDATA_TYPE_U8 || info.type == BOATDATA_TYPE_BOOL) {
+            TEST_ASSERT_EQUAL_DOUBLE(0.0, info.deadband);
+        } else {
+            TEST_ASSERT_TRUE_MESSAGE(info.deadband >= pow(10.0, -info.decimals) * 0.999, info.key);
+        }
+    }
+}
+
+/**
+ * @test Values convert to and from every storage type; ranges clamp
+ */
+void test_schema_get_set_and_range(void) {
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+
+    BoatDataSchema::setValue(data, BOATDATA_FIELD_GPS_LATITUDE, 48.1173);
+    BoatDataSchema::setValue(data, BOATDATA_FIELD_GPS_SATELLITES, 9.4);
+    BoatDataSchema::setValue(data, BOATDATA_FIELD_SHORE_POWER_ON, 1.0);
+    BoatDataSchema::setValue(data, BOATDATA_FIELD_ENGINE_REV, 2450.0);
+
+    TEST_ASSERT_EQUAL_DOUBLE(48.1173, data.gps.latitude);
+    TEST_ASSERT_EQUAL(9, data.gps.satellites);
+    TEST_ASSERT_TRUE(data.shorePower.shorePowerOn);
+    TEST_ASSERT_FLOAT_WITHIN(1e-3, 2450.0, BoatDataSchema::getValue(data, BOATDATA_FIELD_ENGINE_REV));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 1.0, BoatDataSchema::getValue(data, BOATDATA_FIELD_SHORE_POWER_ON));
+
+    double value = 0.0;
+    TEST_ASSERT_TRUE(BoatDataSchema::readValue(data, BOATDATA_FIELD_GPS_LATITUDE, value));
+    TEST_ASSERT_EQUAL_DOUBLE(48.1173, value);
+
+    TEST_ASSERT_TRUE(BoatDataSchema::inRange(BOATDATA_FIELD_DST_DEPTH, 12.0));
+    TEST_ASSERT_FALSE(BoatDataSchema::inRange(BOATDATA_FIELD_DST_DEPTH, -1.0));
+    TEST_ASSERT_FALSE(BoatDataSchema::inRange(BOATDATA_FIELD_DST_DEPTH, NAN));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 6000.0, BoatDataSchema::clamp(BOATDATA_FIELD_ENGINE_REV, 9000.0));
+
+    BoatDataSchema::stamp(data, BOATDATA_SCHEMA_GROUP_ENGINE, 1234);
+    TEST_ASSERT_TRUE(BoatDataSchema::isAvailable(data, BOATDATA_SCHEMA_GROUP_ENGINE));
+    TEST_ASSERT_EQUAL(1234, BoatDataSchema::lastUpdate(data, BOATDATA_SCHEMA_GROUP_ENGINE));
+}
+
+/**
+ * @test readGroup() copies exactly one group
+ */
+void test_schema_read_group_copies_one_group(void) {
+    BoatDataStructure shared;
+    BoatDataStructure out;
+    memset(&shared, 0, sizeof(shared));
+    memset(&out, 0, sizeof(out));
+    shared.wind.apparentWindSpeed = 14.5;
+    shared.wind.available = true;
+    shared.dst.depth = 8.0;
+
+    TEST_ASSERT_TRUE(BoatDataSchema::readGroup(shared, BOATDATA_SCHEMA_GROUP_WIND, out));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 14.5, out.wind.apparentWindSpeed);
+    TEST_ASSERT_TRUE(out.wind.available);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 0.0, out.dst.depth);
+}
+
+/**
+ * @test JSON keeps the nested group/member layout of /boatdata
+ */
+void test_schema_write_json(void) {
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.gps.latitude = 48.1173;
+    data.gps.fixQuality = 1;
+    data.dst.depth = 12.345;
+    data.dst.available = true;
+    data.dst.lastUpdate = 5000;
+    data.saildrive.saildriveEngaged = true;
+
+    StaticJsonWriter<2048> json;
+    json.beginObject();
+    BoatDataSchema::writeJson(json, data);
+    json.endObject();
+
+    TEST_ASSERT_FALSE(json.overflowed());
+    const char* out = json.c_str();
+    TEST_ASSERT_EQUAL_STRING_LEN("{\"gps\":{\"latitude\":48.117300,", out, 29);
+    TEST_ASSERT_NOT_NULL(strstr(out, "\"fixQuality\":1,"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "\"dst\":{\"depth\":12.35,\"measuredBoatSpeed\":0.00,"
+                                     "\"seaTemperature\":0.0,\"available\":true,\"lastUpdate\":5000}"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "\"saildrive\":{\"saildriveEngaged\":true,"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "\"engineRev\":0,"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "\"derived\":{\"awaOffset\":0.0000,"));
+
+    // Subscription: only the selected groups
+    json.reset();
+    json.beginObject();
+    BoatDataSchema::writeJson(json, data, BoatDataGroup::DST);
+    json.endObject();
+    TEST_ASSERT_EQUAL_STRING("{\"dst\":{\"depth\":12.35,\"measuredBoatSpeed\":0.00,"
+                             "\"seaTemperature\":0.0,\"available\":true,\"lastUpdate\":5000}}", json.c_str());
+}
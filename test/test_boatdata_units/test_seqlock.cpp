@@ -0,0 +1,90 @@
+/**
+ * @file test_seqlock.cpp
+ * @brief Unit tests for SeqLock (BoatData per-group snapshot versions)
+ */
+
+#include <unity.h>
+#include "../../src/utils/SeqLock.h"
+
+namespace {
+
+struct Pair {
+    double a;
+    double b;
+};
+
+}  // namespace
+
+/**
+ * @test version() counts completed writes; a write in progress is not counted
+ */
+void test_seqlock_version_counts_writes(void) {
+    SeqLock lock = {};
+    TEST_ASSERT_EQUAL_UINT16(0, lock.version());
+
+    lock.writeBegin();
+    TEST_ASSERT_EQUAL_UINT16(0, lock.version());
+    lock.writeEnd();
+    TEST_ASSERT_EQUAL_UINT16(1, lock.version());
+
+    lock.writeBegin();
+    lock.writeEnd();
+    TEST_ASSERT_EQUAL_UINT16(2, lock.version());
+}
+
+/**
+ * @test read() returns the stable copy and its version
+ */
+void test_seqlock_read_returns_snapshot_and_version(void) {
+    SeqLock lock = {};
+    Pair shared = {1.0, 1.0};
+
+    lock.writeBegin();
+    shared.a = 2.0;
+    shared.b = 2.0;
+    lock.writeEnd();
+
+    Pair out = {0.0, 0.0};
+    uint16_t version = 0;
+    TEST_ASSERT_TRUE(lock.read(shared, out, &version));
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, out.a);
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, out.b);
+    TEST_ASSERT_EQUAL_UINT16(1, version);
+}
+
+/**
+ * @test read() fails instead of spinning while the writer is mid-write
+ */
+void test_seqlock_read_fails_during_write(void) {
+    SeqLock lock = {};
+    Pair shared = {1.0, 1.0};
+    Pair out;
+
+    lock.writeBegin();
+    shared.a = 3.0;  // b not yet written: torn state
+    TEST_ASSERT_FALSE(lock.read(shared, out));
+
+    shared.b = 3.0;
+    lock.writeEnd();
+    TEST_ASSERT_TRUE(lock.read(shared, out));
+    TEST_ASSERT_EQUAL_DOUBLE(out.a, out.b);
+}
+
+/**
+ * @test Zero-initialized (memset) lock is stable and version() wraps cleanly
+ */
+void test_seqlock_memset_and_wrap(void) {
+    struct Guarded {
+        Pair value;
+        SeqLock lock;
+    } guarded;
+    memset(&guarded, 0, sizeof(guarded));
+    Pair out;
+    TEST_ASSERT_TRUE(guarded.lock.read(guarded.value, out));
+
+    guarded.lock.seq = 0xFFFE;  // Last even count before wrap
+    TEST_ASSERT_EQUAL_UINT16(0x7FFF, guarded.lock.version());
+    guarded.lock.writeBegin();
+    guarded.lock.writeEnd();
+    TEST_ASSERT_EQUAL_UINT16(0, guarded.lock.version());
+}
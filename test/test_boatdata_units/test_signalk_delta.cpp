@@ -0,0 +1,100 @@
+/**
+ * @file test_signalk_delta.cpp
+ * @brief Signal K delta messages from the shared delta baseline
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/SignalKDelta.h"
+#include "../../src/utils/SignalKDelta.cpp"
+
+namespace {
+
+BoatDataStructure signalKBoat() {
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    for (uint8_t g = 0; g < BOATDATA_SCHEMA_GROUP_COUNT; g++) {
+        BoatDataSchema::stamp(data, g, 500);
+    }
+    data.gps.latitude = 54.5;
+    data.gps.longitude = 10.25;
+    data.gps.sog = 10.0;
+    data.compass.magneticHeading = 1.0;
+    data.dst.seaTemperature = 20.0;
+    data.engine.engineRev = 1800.0;
+    data.battery.stateOfChargeA = 85.0;
+    data.derived.polarSpeed = 6.0;
+    return data;
+}
+
+}  // namespace
+
+/**
+ * @test Keyframe: every mapped path in SI units, within SIGNALK_BUFFER_SIZE
+ */
+void test_signalk_delta_keyframe(void) {
+    BoatDataDeltaEncoder encoder;
+    BoatDataStructure data = signalKBoat();
+    BoatDataDeltaSet set;
+    TEST_ASSERT_TRUE(encoder.update(data, BoatDataGroup::ALL, 1, 1000, set));
+
+    StaticJsonWriter<3072> json;
+    uint8_t values = SignalKDelta::write(json, data, set, "2025-06-01T12:00:00Z");
+    TEST_ASSERT_FALSE(json.overflowed());
+    const char* out = json.c_str();
+    TEST_ASSERT_EQUAL_STRING_LEN("{\"context\":\"vessels.self\",\"updates\":[{\"source\":{\"label\":\"poseidon2\"},"
+                                 "\"timestamp\":\"2025-06-01T12:00:00Z\",\"values\":[", out, 104);
+    TEST_ASSERT_NOT_NULL(strstr(out, "{\"path\":\"navigation.position\",\"value\":{\"latitude\":54.5000000,\"longitude\":10.2500000}}"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "{\"path\":\"navigation.speedOverGround\",\"value\":5.144}"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "{\"path\":\"environment.water.temperature\",\"value\":293.15}"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "{\"path\":\"propulsion.main.revolutions\",\"value\":30.00}"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "{\"path\":\"electrical.batteries.A.capacity.stateOfCharge\",\"value\":0.850}"));
+    TEST_ASSERT_NOT_NULL(strstr(out, "{\"path\":\"navigation.attitude\",\"value\":{\"roll\":0.0000,\"pitch\":0.0000}}"));
+
+    // One entry per path (object members share one)
+    uint8_t paths = 0;
+    for (uint8_t i = 0; i < SignalKDelta::pathCount(); i++) {
+        const SignalKPathInfo& info = SignalKDelta::pathInfo(i);
+        if (info.member == nullptr || i == 0 || strcmp(SignalKDelta::pathInfo(i - 1).path, info.path) != 0) {
+            paths++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(paths, values);
+}
+
+/**
+ * @test Deltas carry only changed paths; an unavailable group sends null
+ */
+void test_signalk_delta_changes(void) {
+    BoatDataDeltaEncoder encoder;
+    BoatDataStructure data = signalKBoat();
+    BoatDataDeltaSet set;
+    encoder.update(data, BoatDataGroup::ALL, 1, 1000, set);
+
+    data.compass.magneticHeading = 1.5;
+    encoder.update(data, BoatDataGroup::COMPASS, 2, 2000, set);
+    StaticJsonWriter<512> json;
+    TEST_ASSERT_EQUAL_UINT8(1, SignalKDelta::write(json, data, set, nullptr));
+    TEST_ASSERT_EQUAL_STRING("{\"context\":\"vessels.self\",\"updates\":[{\"source\":{\"label\":\"poseidon2\"},"
+                             "\"values\":[{\"path\":\"navigation.headingMagnetic\",\"value\":1.5000}]}]}",
+                             json.c_str());
+
+    // Same baseline renders the /boatdata delta as well
+    StaticJsonWriter<256> boatdata;
+    BoatDataDeltaEncoder::writeJson(boatdata, data, set);
+    TEST_ASSERT_NOT_NULL(strstr(boatdata.c_str(), "\"compass\":{\"magneticHeading\":1.5000,"));
+
+    data.wind.available = false;
+    encoder.update(data, BoatDataGroup::WIND, 3, 3000, set);
+    json.reset();
+    TEST_ASSERT_EQUAL_UINT8(2, SignalKDelta::write(json, data, set, nullptr));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"path\":\"environment.wind.angleApparent\",\"value\":null}"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"path\":\"environment.wind.speedApparent\",\"value\":null}"));
+
+    // Nothing changed: a valid message with no values
+    encoder.update(data, 0, 3, 4000, set);
+    TEST_ASSERT_TRUE(set.empty());
+    json.reset();
+    TEST_ASSERT_EQUAL_UINT8(0, SignalKDelta::write(json, data, set, nullptr));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"values\":[]"));
+}
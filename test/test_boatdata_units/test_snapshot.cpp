@@ -0,0 +1,99 @@
+/**
+ * @file test_snapshot.cpp
+ * @brief Unit tests for BoatDataSnapshot (compact wire record)
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include "../../src/utils/BoatDataSnapshot.h"
+#include "../../src/utils/BoatDataSnapshot.cpp"
+
+/**
+ * @test Values survive a fill/unpack round trip at their fixed-point resolution
+ */
+void test_snapshot_round_trip(void) {
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.gps.latitude = 48.1173012;
+    data.gps.longitude = -4.4851234;
+    data.gps.cog = 3.1416;
+    data.gps.satellites = 9;
+    data.gps.available = true;
+    data.wind.apparentWindAngle = -0.7854;
+    data.wind.apparentWindSpeed = 14.57;
+    data.wind.available = true;
+    data.dst.depth = 12.34;
+    data.battery.amperageA = -12.3;
+    data.battery.shoreChargerOnB = true;
+    data.shorePower.shorePowerOn = true;
+    data.derived.gust1m = 23.45f;
+    data.derived.wdirAvg10m = 6.1f;
+
+    BoatDataSnapshot snapshot;
+    snapshot.fill(data, 123456);
+    TEST_ASSERT_EQUAL_UINT8(BOATDATA_SNAPSHOT_VERSION, snapshot.version);
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::GPS | BoatDataGroup::WIND, snapshot.present);
+    TEST_ASSERT_EQUAL_UINT8(BoatDataSnapshotFlag::SHORE_CHARGER_B | BoatDataSnapshotFlag::SHORE_POWER_ON,
+                            snapshot.flags);
+
+    BoatDataStructure out;
+    memset(&out, 0, sizeof(out));
+    TEST_ASSERT_TRUE(snapshot.unpack(out));
+    TEST_ASSERT_FLOAT_WITHIN(1e-7, 48.1173012, out.gps.latitude);
+    TEST_ASSERT_FLOAT_WITHIN(1e-7, -4.4851234, out.gps.longitude);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 3.1416, out.gps.cog);
+    TEST_ASSERT_EQUAL_UINT8(9, out.gps.satellites);
+    TEST_ASSERT_TRUE(out.gps.available);
+    TEST_ASSERT_EQUAL_UINT32(123456, out.gps.lastUpdate);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, -0.7854, out.wind.apparentWindAngle);
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 14.57, out.wind.apparentWindSpeed);
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 12.34, out.dst.depth);
+    TEST_ASSERT_FLOAT_WITHIN(0.005, 23.45, out.derived.gust1m);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4, 6.1, out.derived.wdirAvg10m);
+    TEST_ASSERT_FALSE(out.dst.available);
+    TEST_ASSERT_FLOAT_WITHIN(0.05, -12.3, out.battery.amperageA);
+    TEST_ASSERT_TRUE(out.battery.shoreChargerOnB);
+    TEST_ASSERT_TRUE(out.shorePower.shorePowerOn);
+}
+
+/**
+ * @test Out-of-range and NaN values saturate or zero; other versions are rejected
+ */
+void test_snapshot_saturates_and_checks_version(void) {
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.dst.depth = 1000.0;          // > 655.35 m
+    data.wind.apparentWindSpeed = -3.0;
+    data.compass.heelAngle = NAN;
+
+    BoatDataSnapshot snapshot;
+    snapshot.fill(data, 0);
+    TEST_ASSERT_EQUAL_UINT16(UINT16_MAX, snapshot.depth);
+    TEST_ASSERT_EQUAL_UINT16(0, snapshot.apparentWindSpeed);
+    TEST_ASSERT_EQUAL_INT16(0, snapshot.heelAngle);
+    TEST_ASSERT_TRUE(sizeof(BoatDataSnapshot) < 128);
+
+    BoatDataStructure out;
+    memset(&out, 0, sizeof(out));
+    snapshot.version = BOATDATA_SNAPSHOT_VERSION + 1;
+    TEST_ASSERT_FALSE(snapshot.unpack(out));
+    TEST_ASSERT_FLOAT_WITHIN(1e-9, 0.0, out.dst.depth);
+}
+
+/**
+ * @test UDP datagram: "P2BD" magic and sequence ahead of the unpadded snapshot
+ */
+void test_snapshot_datagram_layout(void) {
+    TEST_ASSERT_EQUAL_UINT32(130, sizeof(BoatDataDatagram));
+    TEST_ASSERT_EQUAL_UINT32(8, offsetof(BoatDataDatagram, snapshot));
+
+    BoatDataDatagram datagram;
+    memset(&datagram, 0, sizeof(datagram));
+    datagram.magic = BOATDATA_DATAGRAM_MAGIC;
+    datagram.sequence = 0x01020304;
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&datagram);
+    TEST_ASSERT_EQUAL_MEMORY("P2BD", bytes, 4);
+    TEST_ASSERT_EQUAL_UINT8(0x04, bytes[4]);  // Little-endian
+}
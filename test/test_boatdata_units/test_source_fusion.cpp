@@ -0,0 +1,98 @@
+/**
+ * @file test_source_fusion.cpp
+ * @brief Unit tests for SourceFusion (weighted blending of redundant GPS and heading sources)
+ */
+
+#include <unity.h>
+#include <math.h>
+#include "../../src/utils/SourceFusion.h"
+#include "../../src/utils/SourceFusion.cpp"
+
+namespace {
+
+constexpr double DEG = M_PI / 180.0;
+
+}  // namespace
+
+/**
+ * @test Circular weighted mean: 359° and 1° blend to 0°; weights pull the blend
+ */
+void test_source_fusion_angle_circular_mean(void) {
+    AngleFusion heading;
+    TEST_ASSERT_FALSE(heading.isValid());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 359.0 * DEG, heading.update(0, 359.0 * DEG, 1.0, 1000));
+    double blended = heading.update(1, 1.0 * DEG, 1.0, 1100);
+    TEST_ASSERT_EQUAL_UINT8(2, heading.getContributors());
+    TEST_ASSERT_TRUE(blended < 1e-6 || blended > 2.0 * M_PI - 1e-6);
+
+    // Three times the weight on 10°: atan2 of the weighted sums
+    AngleFusion weighted;
+    weighted.update(0, 0.0, 1.0, 1000);
+    blended = weighted.update(1, 10.0 * DEG, 3.0, 1000);
+    double expected = atan2(3.0 * sin(10.0 * DEG), 1.0 + 3.0 * cos(10.0 * DEG));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, expected, blended);
+
+    // A stale reading drops out; a zero weight never counts
+    blended = weighted.update(1, 10.0 * DEG, 3.0, 1000 + SOURCE_FUSION_MAX_AGE_MS + 1);
+    TEST_ASSERT_EQUAL_UINT8(1, weighted.getContributors());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 10.0 * DEG, blended);
+    weighted.update(0, 12.0 * DEG, 0.0, 3100);
+    TEST_ASSERT_EQUAL_UINT8(1, weighted.getContributors());
+
+    weighted.reset();
+    TEST_ASSERT_FALSE(weighted.isValid());
+}
+
+/**
+ * @test An outlier heading is gated and counted; when the outliers outweigh, the blend follows them
+ */
+void test_source_fusion_angle_gating(void) {
+    AngleFusion heading;
+    heading.update(0, 90.0 * DEG, 1.0, 1000);
+    heading.update(1, 92.0 * DEG, 1.0, 1000);
+    double blended = heading.update(2, 200.0 * DEG, 1.0, 1000);
+    TEST_ASSERT_EQUAL_UINT32(1, heading.getGated());
+    TEST_ASSERT_EQUAL_UINT8(2, heading.getContributors());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 91.0 * DEG, blended);
+
+    // Majority moves: two of three now read ~200°
+    heading.update(1, 201.0 * DEG, 1.0, 1100);
+    blended = heading.update(0, 199.0 * DEG, 1.0, 1200);
+    TEST_ASSERT_EQUAL_UINT8(3, heading.getContributors());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 200.0 * DEG, blended);
+}
+
+/**
+ * @test Positions: weighted mean inside the gate, outliers left out, longitude wrapped at ±180°
+ */
+void test_source_fusion_position(void) {
+    PositionFusion position;
+    double lat = 48.0, lon = -4.0;
+    position.update(0, lat, lon, 1.0, 1000);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-12, 48.0, lat);
+
+    lat = 48.0002;    // ~22 m north, weight 3
+    lon = -4.0;
+    position.update(1, lat, lon, 3.0, 1000);
+    TEST_ASSERT_EQUAL_UINT8(2, position.getContributors());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 48.00015, lat);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, -4.0, lon);
+
+    // ~1.1 km off: gated, the blend stands
+    lat = 48.01;
+    lon = -4.0;
+    position.update(2, lat, lon, 1.0, 1000);
+    TEST_ASSERT_EQUAL_UINT32(1, position.getGated());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 48.00015, lat);
+
+    // Antimeridian: 179.9999° and -179.9999° blend to ±180°, not 0°
+    PositionFusion dateline;
+    lat = 0.0;
+    lon = 179.9999;
+    dateline.update(0, lat, lon, 1.0, 1000);
+    lat = 0.0;
+    lon = -179.9999;
+    dateline.update(1, lat, lon, 1.0, 1000);
+    TEST_ASSERT_EQUAL_UINT8(2, dateline.getContributors());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 180.0, fabs(lon));
+}
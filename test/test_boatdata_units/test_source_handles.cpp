@@ -0,0 +1,146 @@
+/**
+ * @file test_source_handles.cpp
+ * @brief Unit tests for handle-based (arbitrated) GPS/compass updates
+ */
+
+#include <unity.h>
+#include "../../src/components/BoatData.h"
+#include "../../src/components/BoatData.cpp"
+#include "../../src/components/SourcePrioritizer.cpp"
+
+/**
+ * @test The first source becomes active; updates from the other are dropped and counted
+ */
+void test_source_handle_drops_inactive_source(void) {
+    SourcePrioritizer prioritizer;
+    BoatData boatData(&prioritizer);
+
+    BoatDataSourceHandle gpsA = boatData.registerSource("GPS-A", SensorType::GPS, ProtocolType::NMEA0183);
+    BoatDataSourceHandle gpsB = boatData.registerSource("GPS-B", SensorType::GPS, ProtocolType::NMEA2000);
+    TEST_ASSERT_TRUE(gpsA.valid());
+    TEST_ASSERT_TRUE(gpsB.valid());
+    TEST_ASSERT_EQUAL(SensorType::GPS, gpsB.type);
+
+    TEST_ASSERT_TRUE(boatData.updateGPS(gpsA, 48.1, -4.5, 1.0, 5.0));
+    TEST_ASSERT_EQUAL(gpsA.index, prioritizer.getActiveSource(SensorType::GPS));
+
+    TEST_ASSERT_FALSE(boatData.updateGPS(gpsB, 10.0, 10.0, 2.0, 6.0));
+    TEST_ASSERT_EQUAL_DOUBLE(48.1, boatData.getGPSData().latitude);
+
+    SensorSource dropped = prioritizer.getSource(gpsB.index);
+    TEST_ASSERT_EQUAL_UINT32(1, dropped.droppedCount);
+    TEST_ASSERT_EQUAL_UINT32(0, dropped.rejectedCount);
+    TEST_ASSERT_EQUAL_UINT32(1, dropped.updateCount);  // Still a failover candidate
+    TEST_ASSERT_TRUE(dropped.available);
+}
+
+/**
+ * @test Validation failures count as rejections of the active source
+ */
+void test_source_handle_counts_invalid_updates(void) {
+    SourcePrioritizer prioritizer;
+    BoatData boatData(&prioritizer);
+
+    BoatDataSourceHandle compass = boatData.registerSource("HDG-A", SensorType::COMPASS, ProtocolType::NMEA0183);
+    TEST_ASSERT_TRUE(boatData.updateCompass(compass, 0.0, 1.0, 0.0));
+    TEST_ASSERT_FALSE(boatData.updateCompass(compass, 0.0, 9.0, 0.0));  // > 2*pi
+
+    SensorSource source = prioritizer.getSource(compass.index);
+    TEST_ASSERT_EQUAL_UINT32(1, source.rejectedCount);
+    TEST_ASSERT_EQUAL_UINT32(0, source.droppedCount);
+    TEST_ASSERT_EQUAL_UINT32(2, source.updateCount);
+}
+
+/**
+ * @test Unregistered handles bypass arbitration
+ */
+void test_source_handle_unregistered_is_unarbitrated(void) {
+    BoatData boatData(nullptr);
+
+    BoatDataSourceHandle handle = boatData.registerSource("GPS-A", SensorType::GPS, ProtocolType::NMEA0183);
+    TEST_ASSERT_FALSE(handle.valid());
+    TEST_ASSERT_TRUE(boatData.updateGPS(handle, 48.1, -4.5, 1.0, 5.0));
+    TEST_ASSERT_TRUE(boatData.updateGPS(BoatDataSourceHandle(), 48.1, -4.5, 1.0, 5.0));
+}
+
+/**
+ * @test Blend mode: both sources contribute position, only the active one SOG
+ */
+void test_source_handle_blend_mode(void) {
+    SourcePrioritizer prioritizer;
+    BoatData boatData(&prioritizer);
+    boatData.setFusionMode(SourceFusionMode::BLEND);
+    TEST_ASSERT_EQUAL(SourceFusionMode::BLEND, boatData.getFusionMode());
+
+    BoatDataSourceHandle gpsA = boatData.registerSource("GPS-A", SensorType::GPS, ProtocolType::NMEA0183);
+    BoatDataSourceHandle gpsB = boatData.registerSource("GPS-B", SensorType::GPS, ProtocolType::NMEA2000);
+    TEST_ASSERT_TRUE(boatData.updateGPS(gpsA, 48.0, -4.0, 1.0, 5.0));
+    TEST_ASSERT_TRUE(boatData.updateGPS(gpsB, 48.0002, -4.0, 1.0, 6.0));   // Inactive: accepted
+
+    GPSData gps = boatData.getGPSData();
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 48.0001, gps.latitude);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 5.0, gps.sog);
+    TEST_ASSERT_EQUAL_UINT32(0, prioritizer.getSource(gpsB.index).droppedCount);
+
+    // Select mode drops the inactive source again
+    boatData.setFusionMode(SourceFusionMode::SELECT);
+    TEST_ASSERT_FALSE(boatData.updateGPS(gpsB, 48.0002, -4.0, 1.0, 6.0));
+}
+
+/**
+ * @test An override request switches on the next update of its type; clearing returns to automatic
+ */
+void test_source_handle_override_request(void) {
+    SourcePrioritizer prioritizer;
+    BoatData boatData(&prioritizer);
+    BoatDataSourceHandle gpsA = boatData.registerSource("GPS-A", SensorType::GPS, ProtocolType::NMEA0183);
+    BoatDataSourceHandle gpsB = boatData.registerSource("GPS-B", SensorType::GPS, ProtocolType::NMEA2000);
+    BoatDataSourceHandle compass = boatData.registerSource("HDG-A", SensorType::COMPASS, ProtocolType::NMEA0183);
+    TEST_ASSERT_TRUE(boatData.updateGPS(gpsA, 48.1, -4.5, 1.0, 5.0));
+
+    TEST_ASSERT_FALSE(boatData.requestSourceOverride(SensorType::COMPASS, gpsB.index));   // Wrong type
+    TEST_ASSERT_FALSE(boatData.requestSourceOverride(SensorType::GPS, 9));                // Not registered
+    TEST_ASSERT_TRUE(boatData.requestSourceOverride(SensorType::GPS, gpsB.index));
+    TEST_ASSERT_EQUAL(gpsA.index, prioritizer.getActiveSource(SensorType::GPS));          // Only recorded
+
+    TEST_ASSERT_TRUE(boatData.updateCompass(compass, 0.0, 1.0, 0.0));                     // Other type: untouched
+    TEST_ASSERT_EQUAL(gpsA.index, prioritizer.getActiveSource(SensorType::GPS));
+    TEST_ASSERT_FALSE(boatData.updateGPS(gpsA, 48.1, -4.5, 1.0, 5.0));                    // Switched before arbitration
+    TEST_ASSERT_EQUAL(gpsB.index, prioritizer.getActiveSource(SensorType::GPS));
+    TEST_ASSERT_TRUE(prioritizer.getSource(gpsB.index).manualOverride);
+    TEST_ASSERT_TRUE(boatData.updateGPS(gpsB, 48.1, -4.5, 1.0, 5.0));
+
+    TEST_ASSERT_TRUE(boatData.requestSourceOverride(SensorType::GPS, -1));
+    boatData.updateGPS(gpsB, 48.1, -4.5, 1.0, 5.0);
+    TEST_ASSERT_FALSE(prioritizer.getSource(gpsB.index).manualOverride);
+}
+
+/**
+ * @test Battery monitors are selected, never blended: an inactive monitor is dropped in both modes
+ */
+void test_source_handle_battery_monitors(void) {
+    SourcePrioritizer prioritizer;
+    BoatData boatData(&prioritizer);
+    BoatDataSourceHandle oneWire = boatData.registerSource("1W-BAT", SensorType::BATTERY, ProtocolType::ONEWIRE);
+    int bus = prioritizer.registerSource("N2K-BAT-023", SensorType::BATTERY, ProtocolType::NMEA2000);
+    TEST_ASSERT_TRUE(oneWire.valid());
+
+    BatteryData battery;
+    battery.voltageA = 12.6;
+    battery.voltageB = 12.9;
+    battery.available = true;
+    TEST_ASSERT_TRUE(boatData.updateBattery(oneWire, battery));   // Only fresh battery source
+    TEST_ASSERT_EQUAL(oneWire.index, prioritizer.getActiveSource(SensorType::BATTERY));
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 12.9, boatData.getBatteryData().voltageB);
+
+    // The bus monitor takes over: 1-Wire readings stop reaching BoatData
+    TEST_ASSERT_TRUE(boatData.requestSourceOverride(SensorType::BATTERY, bus));
+    battery.voltageB = 11.0;
+    TEST_ASSERT_FALSE(boatData.updateBattery(oneWire, battery));
+    TEST_ASSERT_EQUAL(bus, prioritizer.getActiveSource(SensorType::BATTERY));
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 12.9, boatData.getBatteryData().voltageB);
+
+    boatData.setFusionMode(SourceFusionMode::BLEND);
+    TEST_ASSERT_FALSE(boatData.updateBattery(oneWire, battery));
+    TEST_ASSERT_EQUAL_UINT32(2, prioritizer.getSource(oneWire.index).droppedCount);
+}
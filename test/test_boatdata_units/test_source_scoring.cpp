@@ -0,0 +1,198 @@
+/**
+ * @file test_source_scoring.cpp
+ * @brief Unit tests for SourcePrioritizer rate/quality scoring, hysteresis and dwell time
+ */
+
+#include <unity.h>
+#include <stdio.h>
+#include "../../src/components/SourcePrioritizer.h"
+
+namespace {
+
+/// Updates of @p index every @p stepMs from @p fromMs up to (excluding) @p toMs
+void feed(SourcePrioritizer& prioritizer, int index, unsigned long fromMs, unsigned long toMs, unsigned long stepMs) {
+    for (unsigned long t = fromMs; t < toMs; t += stepMs) {
+        prioritizer.updateSourceTimestamp(index, t);
+    }
+}
+
+}  // namespace
+
+/**
+ * @test The rate is an EWMA of the intervals; fix details, rejections and jitter weight it
+ */
+void test_source_scoring_rate_and_quality(void) {
+    SourcePrioritizer prioritizer;
+    int slow = prioritizer.registerSource("GPS-SLOW", SensorType::GPS, ProtocolType::NMEA0183);
+    int fast = prioritizer.registerSource("GPS-FAST", SensorType::GPS, ProtocolType::NMEA2000);
+    feed(prioritizer, slow, 0, 5001, 1000);
+    feed(prioritizer, fast, 0, 5001, 100);
+    prioritizer.updatePriorities(5000);
+    TEST_ASSERT_EQUAL(fast, prioritizer.getActiveSource(SensorType::GPS));
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, 1.0, prioritizer.getSource(slow).updateFrequency);
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, 10.0, prioritizer.getSource(fast).updateFrequency);
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, 10.0, prioritizer.getSource(fast).score);
+
+    // A late source loses rate before it goes stale
+    prioritizer.updatePriorities(5000 + 400);
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, 2.5, prioritizer.getSource(fast).updateFrequency);
+
+    // Fix details: 10 Hz with a poor fix loses to 5 Hz DGNSS
+    SourcePrioritizer gnss;
+    int poor = gnss.registerSource("GPS-POOR", SensorType::GPS, ProtocolType::NMEA2000);
+    int good = gnss.registerSource("GPS-GOOD", SensorType::GPS, ProtocolType::NMEA2000);
+    feed(gnss, poor, 0, 5001, 100);
+    feed(gnss, good, 0, 5001, 200);
+    gnss.updateSourceQuality(poor, 1, 4, 4.0);     // GNSS, 4 satellites, HDOP 4
+    gnss.updateSourceQuality(good, 2, 12, 0.8);    // DGNSS, 12 satellites, HDOP 0.8
+    gnss.updatePriorities(5000);
+    TEST_ASSERT_EQUAL(good, gnss.getActiveSource(SensorType::GPS));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 0.7 * 0.25 * 4.0 / SOURCE_GOOD_SATELLITES, gnss.getSource(poor).quality);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 0.85, gnss.getSource(good).quality);
+
+    // No fix scores zero
+    gnss.updateSourceQuality(good, 0, 0, 0.0);
+    gnss.updatePriorities(5000);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.0, gnss.getSource(good).score);
+
+    // Rejections and jitter
+    SourcePrioritizer compass;
+    int noisy = compass.registerSource("HDG-NOISY", SensorType::COMPASS, ProtocolType::NMEA2000);
+    int jittery = compass.registerSource("HDG-JITTER", SensorType::COMPASS, ProtocolType::NMEA2000);
+    for (unsigned long t = 0; t < 10000; t += 100) {
+        compass.updateSourceTimestamp(noisy, t);
+        if ((t / 100) % 2 == 0) {
+            compass.recordRejection(noisy, SourceRejection::INVALID);
+        }
+    }
+    for (unsigned long t = 0; t < 10000; t += 200) {
+        compass.updateSourceTimestamp(jittery, t);        // Intervals 50, 150, 50, ...
+        compass.updateSourceTimestamp(jittery, t + 50);
+    }
+    compass.updatePriorities(10000);
+    SensorSource noisySource = compass.getSource(noisy);
+    TEST_ASSERT_DOUBLE_WITHIN(0.05, 0.5, noisySource.rejectionRate);
+    TEST_ASSERT_EQUAL_UINT32(50, noisySource.rejectedCount);
+    SensorSource jitterSource = compass.getSource(jittery);
+    TEST_ASSERT_DOUBLE_WITHIN(5.0, 100.0, jitterSource.avgUpdateInterval);
+    TEST_ASSERT_TRUE(jitterSource.intervalJitter > 30.0);
+    TEST_ASSERT_TRUE(jitterSource.quality < 0.8);
+}
+
+/**
+ * @test A better source takes over after the dwell time and only beyond the hysteresis; failover is immediate
+ */
+void test_source_scoring_hysteresis_and_dwell(void) {
+    SourcePrioritizer prioritizer;
+    int first = prioritizer.registerSource("GPS-FIRST", SensorType::GPS, ProtocolType::NMEA0183);
+    int better = prioritizer.registerSource("GPS-BETTER", SensorType::GPS, ProtocolType::NMEA2000);
+
+    unsigned long switchedAt = 0;
+    for (unsigned long t = 0; t <= 20000; t += 100) {
+        if (t % 1000 == 0) {
+            prioritizer.updateSourceTimestamp(first, t);   // 1 Hz
+        }
+        if (t >= 2000 && t % 200 == 0) {
+            prioritizer.updateSourceTimestamp(better, t);  // 5 Hz from t = 2 s
+        }
+        if (t % 1000 == 0) {
+            prioritizer.updatePriorities(t);
+            if (switchedAt == 0 && prioritizer.getActiveSource(SensorType::GPS) == better) {
+                switchedAt = t;
+            }
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT32(SOURCE_MIN_DWELL_MS, switchedAt);   // Active since t = 0
+
+    // Failover ignores the dwell time
+    feed(prioritizer, first, 21000, 27001, 1000);
+    prioritizer.checkStale(27000);
+    TEST_ASSERT_EQUAL(first, prioritizer.getActiveSource(SensorType::GPS));
+
+    // Within the hysteresis margin the running source stays
+    SourcePrioritizer compass;
+    int running = compass.registerSource("HDG-A", SensorType::COMPASS, ProtocolType::NMEA2000);
+    int challenger = compass.registerSource("HDG-B", SensorType::COMPASS, ProtocolType::NMEA2000);
+    compass.updateSourceTimestamp(running, 0);
+    compass.updatePriorities(0);
+    for (unsigned long t = 10; t <= 30000; t += 10) {
+        if (t % 100 == 0) {
+            compass.updateSourceTimestamp(running, t);      // 10 Hz
+        }
+        if (t % 90 == 0) {
+            compass.updateSourceTimestamp(challenger, t);   // 11 Hz: inside the margin
+        }
+        if (t % 100 == 0) {
+            compass.updatePriorities(t);
+        }
+    }
+    TEST_ASSERT_EQUAL(running, compass.getActiveSource(SensorType::COMPASS));
+    for (unsigned long t = 30010; t <= 35000; t += 10) {
+        if (t % 100 == 0) {
+            compass.updateSourceTimestamp(running, t);
+        }
+        if (t % 50 == 0) {
+            compass.updateSourceTimestamp(challenger, t);   // 20 Hz: clearly better
+        }
+    }
+    compass.updatePriorities(35000);
+    TEST_ASSERT_EQUAL(challenger, compass.getActiveSource(SensorType::COMPASS));
+
+    // Manual override still wins at once
+    compass.setManualOverride(running);
+    TEST_ASSERT_EQUAL(running, compass.getActiveSource(SensorType::COMPASS));
+}
+
+/**
+ * @test One flat table for every sensor type; (type, ID) lookups are hashed and registration is idempotent
+ */
+void test_source_table_lookup_and_types(void) {
+    SourcePrioritizer prioritizer;
+    int gps = prioritizer.registerSource("NMEA0183-AP", SensorType::GPS, ProtocolType::NMEA0183);
+    int heading = prioritizer.registerSource("NMEA0183-AP", SensorType::COMPASS, ProtocolType::NMEA0183);
+    int wind = prioritizer.registerSource("N2K-WND-010", SensorType::WIND, ProtocolType::NMEA2000);
+    int battery = prioritizer.registerSource("1W-BATT", SensorType::BATTERY, ProtocolType::ONEWIRE);
+    TEST_ASSERT_EQUAL(0, gps);
+    TEST_ASSERT_EQUAL(1, heading);   // Same ID, other type: its own source
+    TEST_ASSERT_EQUAL(2, wind);
+    TEST_ASSERT_EQUAL(3, battery);
+
+    TEST_ASSERT_EQUAL(heading, prioritizer.findSource("NMEA0183-AP", SensorType::COMPASS));
+    TEST_ASSERT_EQUAL(wind, prioritizer.findSource("N2K-WND-010", SensorType::WIND));
+    TEST_ASSERT_EQUAL(-1, prioritizer.findSource("N2K-WND-010", SensorType::GPS));
+    TEST_ASSERT_EQUAL(-1, prioritizer.findSource("N2K-WND-011", SensorType::WIND));
+    TEST_ASSERT_EQUAL(gps, prioritizer.registerSource("NMEA0183-AP", SensorType::GPS, ProtocolType::NMEA0183));
+
+    // Arbitration works the same for every type and stays per type
+    prioritizer.updateSourceTimestamp(wind, 1000);
+    prioritizer.updateSourceTimestamp(battery, 1000);
+    prioritizer.updatePriorities(1000);
+    TEST_ASSERT_EQUAL(wind, prioritizer.getActiveSource(SensorType::WIND));
+    TEST_ASSERT_EQUAL(battery, prioritizer.getActiveSource(SensorType::BATTERY));
+    TEST_ASSERT_EQUAL(-1, prioritizer.getActiveSource(SensorType::GPS));
+    TEST_ASSERT_EQUAL(-1, prioritizer.getActiveSource(SensorType::ENGINE));
+    prioritizer.checkStale(1000 + 6000);
+    TEST_ASSERT_EQUAL(-1, prioritizer.getActiveSource(SensorType::WIND));
+
+    // Per-type and table capacity
+    char id[16];
+    for (int i = 1; i < MAX_SOURCES_PER_TYPE; i++) {
+        snprintf(id, sizeof(id), "WIND-%d", i);
+        TEST_ASSERT_TRUE(prioritizer.registerSource(id, SensorType::WIND, ProtocolType::NMEA2000) >= 0);
+    }
+    TEST_ASSERT_EQUAL(-1, prioritizer.registerSource("WIND-X", SensorType::WIND, ProtocolType::NMEA2000));
+    for (int i = 0; i < MAX_SOURCES_PER_TYPE; i++) {
+        snprintf(id, sizeof(id), "DST-%d", i);
+        TEST_ASSERT_TRUE(prioritizer.registerSource(id, SensorType::DST, ProtocolType::NMEA2000) >= 0);
+    }
+    int registered = 3 + 2 * MAX_SOURCES_PER_TYPE;
+    for (int i = 0; registered < MAX_SENSOR_SOURCES; i++, registered++) {
+        snprintf(id, sizeof(id), "ENG-%d", i);
+        TEST_ASSERT_EQUAL(registered, prioritizer.registerSource(id, SensorType::ENGINE, ProtocolType::NMEA2000));
+    }
+    TEST_ASSERT_EQUAL(-1, prioritizer.registerSource("RSA-A", SensorType::RUDDER, ProtocolType::NMEA0183));   // Table full
+    for (int i = 0; i < registered; i++) {
+        SensorSource source = prioritizer.getSource(i);
+        TEST_ASSERT_EQUAL(i, prioritizer.findSource(source.sourceId, source.sensorType));
+    }
+}
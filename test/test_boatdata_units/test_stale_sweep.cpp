@@ -0,0 +1,49 @@
+/**
+ * @file test_stale_sweep.cpp
+ * @brief Unit tests for BoatData::sweepStale() (per-group staleness timeouts)
+ *
+ * BoatData.cpp is compiled in through test_source_handles.cpp.
+ */
+
+#include <unity.h>
+#include "../../src/components/BoatData.h"
+
+/**
+ * @test A group older than its timeout is expired once, with a change mark
+ */
+void test_stale_sweep_expires_quiet_groups(void) {
+    BoatData boatData(nullptr);
+    BoatDataStructure* data = boatData.getDataStructure();
+    data->wind.available = true;
+    data->wind.lastUpdate = 1000;
+    data->battery.available = true;
+    data->battery.lastUpdate = 1000;
+    uint32_t generation = boatData.getChanges().getGeneration();
+    uint16_t windVersion = boatData.getVersions().wind.version();
+
+    TEST_ASSERT_EQUAL_UINT16(0, boatData.sweepStale(1000 + BOATDATA_STALE_WIND_MS));
+
+    uint16_t expired = boatData.sweepStale(1001 + BOATDATA_STALE_WIND_MS);
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::WIND, expired);
+    TEST_ASSERT_FALSE(data->wind.available);
+    TEST_ASSERT_EQUAL_UINT32(1000, data->wind.lastUpdate);
+    TEST_ASSERT_TRUE(data->battery.available);  // Longer timeout
+    TEST_ASSERT_EQUAL_UINT16(windVersion + 1, boatData.getVersions().wind.version());
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::WIND, boatData.getChanges().changedSince(generation));
+
+    // Already unavailable: not expired again
+    TEST_ASSERT_EQUAL_UINT16(0, boatData.sweepStale(2001 + BOATDATA_STALE_WIND_MS));
+}
+
+/**
+ * @test Groups with a 0 ms timeout never expire
+ */
+void test_stale_sweep_skips_disabled_timeouts(void) {
+    BoatData boatData(nullptr);
+    BoatDataStructure* data = boatData.getDataStructure();
+    data->derived.available = true;
+    data->derived.lastUpdate = 0;
+
+    boatData.sweepStale(100000);
+    TEST_ASSERT_EQUAL(BOATDATA_STALE_DERIVED_MS == 0, data->derived.available);
+}
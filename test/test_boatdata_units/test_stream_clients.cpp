@@ -0,0 +1,240 @@
+/**
+ * @file test_stream_clients.cpp
+ * @brief /boatdata client format table and the binary frame layout the JavaScript decoders read
+ */
+
+#include <unity.h>
+#include <stddef.h>
+#include <math.h>
+#include "../../src/utils/BoatDataStreamClients.h"
+#include "../../src/utils/BoatDataStreamClients.cpp"
+#include "../../src/utils/BoatDataSnapshot.h"
+
+/**
+ * @test Register full, delta and binary clients; ID 0, duplicates, a full table and removal
+ */
+void test_stream_clients_modes(void) {
+    BoatDataStreamClients clients;
+    TEST_ASSERT_FALSE(clients.takeDeltaJoined());
+    TEST_ASSERT_FALSE(clients.add(0, BoatDataStreamMode::DELTA));
+
+    TEST_ASSERT_TRUE(clients.add(5, BoatDataStreamMode::FULL));
+    TEST_ASSERT_FALSE(clients.takeDeltaJoined());
+    TEST_ASSERT_TRUE(clients.add(7, BoatDataStreamMode::DELTA));
+    TEST_ASSERT_TRUE(clients.add(8, BoatDataStreamMode::BINARY));
+    TEST_ASSERT_TRUE(clients.takeDeltaJoined());
+    TEST_ASSERT_FALSE(clients.takeDeltaJoined());
+    TEST_ASSERT_TRUE(clients.add(8, BoatDataStreamMode::BINARY));  // Re-register: one slot
+    TEST_ASSERT_FALSE(clients.takeDeltaJoined());                   // Binary joins need no keyframe
+
+    TEST_ASSERT_EQUAL_UINT8(3, clients.count());
+    TEST_ASSERT_EQUAL_UINT8(1, clients.count(BoatDataStreamMode::FULL));
+    TEST_ASSERT_EQUAL_UINT8(1, clients.count(BoatDataStreamMode::DELTA));
+    TEST_ASSERT_EQUAL_UINT8(1, clients.count(BoatDataStreamMode::BINARY));
+    TEST_ASSERT_TRUE(clients.modeOf(7) == BoatDataStreamMode::DELTA);
+    TEST_ASSERT_TRUE(clients.modeOf(8) == BoatDataStreamMode::BINARY);
+    TEST_ASSERT_TRUE(clients.modeOf(9) == BoatDataStreamMode::FULL);
+
+    uint8_t binarySlots = 0;
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (clients.at(i, BoatDataStreamMode::BINARY) != 0) {
+            TEST_ASSERT_EQUAL_UINT32(8, clients.at(i, BoatDataStreamMode::BINARY));
+            TEST_ASSERT_EQUAL_UINT32(0, clients.at(i, BoatDataStreamMode::DELTA));
+            TEST_ASSERT_EQUAL_UINT32(8, clients.at(i));
+            binarySlots++;
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(1, binarySlots);
+
+    for (uint32_t id = 100; id < 100 + BOATDATA_STREAM_MAX_CLIENTS - 3; id++) {
+        TEST_ASSERT_TRUE(clients.add(id, BoatDataStreamMode::FULL));
+    }
+    TEST_ASSERT_FALSE(clients.add(999, BoatDataStreamMode::DELTA));
+    TEST_ASSERT_EQUAL_UINT8(BOATDATA_STREAM_MAX_CLIENTS, clients.count());
+
+    clients.remove(7);
+    clients.remove(12345);
+    TEST_ASSERT_TRUE(clients.modeOf(7) == BoatDataStreamMode::FULL);
+    TEST_ASSERT_EQUAL_UINT8(0, clients.count(BoatDataStreamMode::DELTA));
+    TEST_ASSERT_TRUE(clients.add(999, BoatDataStreamMode::DELTA));
+}
+
+namespace {
+
+uint16_t slotBit(const BoatDataStreamClients& clients, uint32_t id) {
+    for (uint8_t i = 0; i < BOATDATA_STREAM_MAX_CLIENTS; i++) {
+        if (clients.at(i) == id) {
+            return static_cast<uint16_t>(1u << i);
+        }
+    }
+    return 0;
+}
+
+}  // namespace
+
+/**
+ * @test Subscriptions: clients with the same payload share a bucket, rates and unchanged groups gate sends
+ */
+void test_stream_clients_buckets(void) {
+    BoatDataStreamClients clients;
+    BoatDataChangeTracker changes;
+    BoatDataStreamBucket buckets[BOATDATA_STREAM_MAX_CLIENTS];
+    const uint16_t helm = BoatDataGroup::COMPASS | BoatDataGroup::WIND;
+
+    clients.add(1, BoatDataStreamMode::FULL);    // Nav station: everything at 1 Hz
+    clients.add(2, BoatDataStreamMode::FULL);    // Two helm tablets: heading + wind at 10 Hz
+    clients.add(3, BoatDataStreamMode::FULL);
+    clients.add(4, BoatDataStreamMode::DELTA);
+    TEST_ASSERT_TRUE(clients.subscribe(2, helm, BoatDataStreamClients::ticksForRate(10)));
+    TEST_ASSERT_TRUE(clients.subscribe(3, helm, 1));
+    TEST_ASSERT_FALSE(clients.subscribe(4, helm, 1));   // Delta clients share one baseline
+    TEST_ASSERT_FALSE(clients.subscribe(9, helm, 1));   // Not registered
+    TEST_ASSERT_FALSE(clients.subscribe(1, static_cast<uint16_t>(1u << 15), 1));  // Selects nothing
+
+    // Off the default tick only the 10 Hz bucket is due; joined clients need no change
+    TEST_ASSERT_EQUAL_UINT8(1, clients.buckets(1, 100, changes, buckets));
+    TEST_ASSERT_EQUAL_UINT16(helm, buckets[0].groups);
+    TEST_ASSERT_EQUAL_UINT16(slotBit(clients, 2) | slotBit(clients, 3), buckets[0].slots);
+    clients.markSent(buckets[0], 0, 100);
+
+    // Sent and nothing changed: quiet until a subscribed group changes
+    TEST_ASSERT_EQUAL_UINT8(0, clients.buckets(2, 200, changes, buckets));
+    changes.markChanged(BoatDataGroup::ENGINE);
+    TEST_ASSERT_EQUAL_UINT8(0, clients.buckets(3, 300, changes, buckets));
+    changes.markChanged(BoatDataGroup::WIND);
+    TEST_ASSERT_EQUAL_UINT8(1, clients.buckets(4, 400, changes, buckets));
+    clients.markSent(buckets[0], changes.getGeneration(), 400);
+
+    // Default tick: full bucket, helm bucket is up to date, the delta bucket
+    uint8_t n = clients.buckets(BOATDATA_STREAM_DEFAULT_TICKS, 1000, changes, buckets);
+    TEST_ASSERT_EQUAL_UINT8(2, n);
+    TEST_ASSERT_TRUE(buckets[0].mode == BoatDataStreamMode::FULL);
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::ALL, buckets[0].groups);
+    TEST_ASSERT_EQUAL_UINT16(slotBit(clients, 1), buckets[0].slots);
+    TEST_ASSERT_TRUE(buckets[1].mode == BoatDataStreamMode::DELTA);
+    TEST_ASSERT_EQUAL_UINT16(slotBit(clients, 4), buckets[1].slots);
+    clients.markSent(buckets[0], changes.getGeneration(), 1000);
+    clients.markSent(buckets[1], changes.getGeneration(), 1000);
+
+    // Keepalive without changes
+    TEST_ASSERT_EQUAL_UINT8(0, clients.buckets(BOATDATA_STREAM_DEFAULT_TICKS * 2, 2000, changes, buckets));
+    TEST_ASSERT_EQUAL_UINT8(3, clients.buckets(BOATDATA_STREAM_DEFAULT_TICKS * 6,
+                                               1000 + BOATDATA_BROADCAST_KEEPALIVE_MS, changes, buckets));
+
+    // Rates to ticks
+    TEST_ASSERT_EQUAL_UINT8(BOATDATA_STREAM_DEFAULT_TICKS, BoatDataStreamClients::ticksForRate(1.0));
+    TEST_ASSERT_EQUAL_UINT8(1, BoatDataStreamClients::ticksForRate(50.0));
+    TEST_ASSERT_EQUAL_UINT8(255, BoatDataStreamClients::ticksForRate(0.001));
+    TEST_ASSERT_EQUAL_UINT8(0, BoatDataStreamClients::ticksForRate(0.0));
+    TEST_ASSERT_EQUAL_UINT8(0, BoatDataStreamClients::ticksForRate(NAN));
+}
+
+/**
+ * @test Governed rate: clients without a rate follow the default, the floor slows subscriptions
+ */
+void test_stream_clients_governed_rate(void) {
+    BoatDataStreamClients clients;
+    BoatDataChangeTracker changes;
+    BoatDataStreamBucket buckets[BOATDATA_STREAM_MAX_CLIENTS];
+
+    clients.add(31, BoatDataStreamMode::FULL);
+    clients.add(32, BoatDataStreamMode::FULL);
+    TEST_ASSERT_TRUE(clients.subscribe(32, BoatDataGroup::WIND, 1));
+    TEST_ASSERT_TRUE(clients.subscribe(31, BoatDataGroup::ALL, 0));  // No rate: the default
+    uint8_t slot31 = 0;
+    while (clients.at(slot31) != 31) {
+        slot31++;
+    }
+    uint8_t slot32 = 0;
+    while (clients.at(slot32) != 32) {
+        slot32++;
+    }
+    TEST_ASSERT_EQUAL_UINT8(BOATDATA_STREAM_DEFAULT_TICKS, clients.ticksOf(slot31));
+    TEST_ASSERT_EQUAL_UINT8(1, clients.ticksOf(slot32));
+
+    // Backed off to 0.5 Hz: both clients at the floor
+    const uint8_t slow = 2000 / BOATDATA_STREAM_TICK_MS;
+    clients.setDefaultTicks(slow);
+    clients.setFloorTicks(slow);
+    TEST_ASSERT_EQUAL_UINT8(slow, clients.getDefaultTicks());
+    TEST_ASSERT_EQUAL_UINT8(slow, clients.ticksOf(slot31));
+    TEST_ASSERT_EQUAL_UINT8(slow, clients.ticksOf(slot32));
+    TEST_ASSERT_EQUAL_UINT8(0, clients.buckets(BOATDATA_STREAM_DEFAULT_TICKS, 1000, changes, buckets));
+    TEST_ASSERT_EQUAL_UINT8(2, clients.buckets(slow, 2000, changes, buckets));
+
+    // Sped up to 5 Hz: the subscription keeps its own, faster rate
+    clients.setDefaultTicks(200 / BOATDATA_STREAM_TICK_MS);
+    clients.setFloorTicks(1);
+    TEST_ASSERT_EQUAL_UINT8(200 / BOATDATA_STREAM_TICK_MS, clients.ticksOf(slot31));
+    TEST_ASSERT_EQUAL_UINT8(1, clients.ticksOf(slot32));
+
+    clients.setDefaultTicks(0);  // Clamped to one tick
+    TEST_ASSERT_EQUAL_UINT8(1, clients.getDefaultTicks());
+    clients.remove(31);
+    TEST_ASSERT_EQUAL_UINT8(0, clients.ticksOf(slot31));
+}
+
+/**
+ * @test Skipped frames are counted per client; a client behind for BOATDATA_STREAM_EVICT_MS is evicted
+ */
+void test_stream_clients_backpressure(void) {
+    BoatDataStreamClients clients;
+    clients.add(21, BoatDataStreamMode::FULL);
+    clients.add(22, BoatDataStreamMode::BINARY);
+    uint8_t slow = 0;
+    while (clients.at(slow) != 21) {
+        slow++;
+    }
+
+    TEST_ASSERT_FALSE(clients.recordSent(slow));
+    TEST_ASSERT_FALSE(clients.recordDropped(slow, 1000));
+    TEST_ASSERT_FALSE(clients.recordDropped(slow, 1500));
+    BoatDataStreamClientStats stats;
+    TEST_ASSERT_TRUE(clients.getStats(slow, stats, 1600));
+    TEST_ASSERT_EQUAL_UINT32(21, stats.id);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.sent);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.dropped);
+    TEST_ASSERT_EQUAL_UINT32(600, stats.behindMs);
+    TEST_ASSERT_EQUAL_UINT32(BOATDATA_BROADCAST_INTERVAL_MS, stats.intervalMs);
+
+    // Catching up resets the behind clock
+    TEST_ASSERT_TRUE(clients.recordSent(slow));
+    TEST_ASSERT_FALSE(clients.recordSent(slow));
+    clients.getStats(slow, stats, 1700);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.behindMs);
+
+    TEST_ASSERT_FALSE(clients.recordDropped(slow, 2000));
+    TEST_ASSERT_FALSE(clients.recordDropped(slow, 2000 + BOATDATA_STREAM_EVICT_MS - 2));
+    TEST_ASSERT_TRUE(clients.recordDropped(slow, 2000 + BOATDATA_STREAM_EVICT_MS));
+    TEST_ASSERT_EQUAL_UINT32(5, clients.getDroppedTotal());
+    TEST_ASSERT_EQUAL_UINT32(1, clients.getEvicted());
+
+    // The slot's counters start over for the next client; totals stay
+    clients.remove(21);
+    TEST_ASSERT_FALSE(clients.getStats(slow, stats, 3000));
+    clients.add(23, BoatDataStreamMode::FULL);
+    TEST_ASSERT_TRUE(clients.getStats(slow, stats, 3000));
+    TEST_ASSERT_EQUAL_UINT32(23, stats.id);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.dropped);
+    TEST_ASSERT_EQUAL_UINT32(5, clients.getDroppedTotal());
+}
+
+/**
+ * @test Binary frame offsets (decodeSnapshot() in stream.html and the Node viewer read these)
+ */
+void test_stream_clients_binary_layout(void) {
+    TEST_ASSERT_EQUAL_UINT(122, sizeof(BoatDataSnapshot));
+    TEST_ASSERT_EQUAL_UINT(2, offsetof(BoatDataSnapshot, present));
+    TEST_ASSERT_EQUAL_UINT(4, offsetof(BoatDataSnapshot, timestampMs));
+    TEST_ASSERT_EQUAL_UINT(8, offsetof(BoatDataSnapshot, latitude));
+    TEST_ASSERT_EQUAL_UINT(26, offsetof(BoatDataSnapshot, trueHeading));
+    TEST_ASSERT_EQUAL_UINT(38, offsetof(BoatDataSnapshot, apparentWindAngle));
+    TEST_ASSERT_EQUAL_UINT(42, offsetof(BoatDataSnapshot, depth));
+    TEST_ASSERT_EQUAL_UINT(50, offsetof(BoatDataSnapshot, engineRev));
+    TEST_ASSERT_EQUAL_UINT(56, offsetof(BoatDataSnapshot, voltageA));
+    TEST_ASSERT_EQUAL_UINT(68, offsetof(BoatDataSnapshot, shorePower));
+    TEST_ASSERT_EQUAL_UINT(70, offsetof(BoatDataSnapshot, awaOffset));
+    TEST_ASSERT_EQUAL_UINT(90, offsetof(BoatDataSnapshot, polarSpeed));
+    TEST_ASSERT_EQUAL_UINT(98, offsetof(BoatDataSnapshot, twsAvg10s));
+    TEST_ASSERT_EQUAL_UINT(120, offsetof(BoatDataSnapshot, gust10m));
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test_subscriptions.cpp
+ * @brief Unit tests for BoatDataSubscriptions (coalesced change notifications)
+ */
+
+#include <unity.h>
+#include "../../src/utils/BoatDataSubscriptions.h"
+#include "../../src/utils/BoatDataSubscriptions.cpp"
+
+namespace {
+
+struct Recorder {
+    int calls;
+    uint16_t lastChanged;
+};
+
+void record(void* context, uint16_t changed) {
+    Recorder* recorder = static_cast<Recorder*>(context);
+    recorder->calls++;
+    recorder->lastChanged = changed;
+}
+
+}  // namespace
+
+/**
+ * @test A 50 Hz burst produces one callback per interval with the merged mask
+ */
+void test_subscriptions_coalesce_bursts(void) {
+    BoatDataChangeTracker tracker;
+    BoatDataSubscriptions subs;
+    Recorder rec = {0, 0};
+    TEST_ASSERT_EQUAL_INT(0, subs.subscribe(BoatDataGroup::COMPASS | BoatDataGroup::WIND, 200, record, &rec));
+
+    // 1 s of heading at 50 Hz, one wind update, dispatch every 10 ms
+    for (uint32_t now = 0; now < 1000; now += 10) {
+        if (now % 20 == 0) {
+            tracker.markChanged(BoatDataGroup::COMPASS);
+        }
+        if (now == 510) {
+            tracker.markChanged(BoatDataGroup::WIND);
+        }
+        subs.dispatch(tracker, now);
+    }
+
+    TEST_ASSERT_EQUAL_INT(5, rec.calls);  // t = 0, 200, 400, 600, 800
+    TEST_ASSERT_EQUAL_UINT32(5, subs.getNotifyCount());
+}
+
+/**
+ * @test Changes held back by the interval are merged into the next callback
+ */
+void test_subscriptions_merge_deferred_changes(void) {
+    BoatDataChangeTracker tracker;
+    BoatDataSubscriptions subs;
+    Recorder rec = {0, 0};
+    subs.subscribe(BoatDataGroup::COMPASS | BoatDataGroup::WIND, 200, record, &rec);
+
+    tracker.markChanged(BoatDataGroup::COMPASS);
+    subs.dispatch(tracker, 0);
+    tracker.markChanged(BoatDataGroup::WIND);
+    tracker.markChanged(BoatDataGroup::COMPASS);
+    subs.dispatch(tracker, 100);  // Too early
+    TEST_ASSERT_EQUAL_INT(1, rec.calls);
+
+    subs.dispatch(tracker, 200);
+    TEST_ASSERT_EQUAL_INT(2, rec.calls);
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::COMPASS | BoatDataGroup::WIND, rec.lastChanged);
+}
+
+/**
+ * @test Changes outside the mask never call the subscriber
+ */
+void test_subscriptions_filter_by_mask(void) {
+    BoatDataChangeTracker tracker;
+    BoatDataSubscriptions subs;
+    Recorder rec = {0, 0};
+    subs.subscribe(BoatDataGroup::ENGINE, 0, record, &rec);
+
+    tracker.markChanged(BoatDataGroup::GPS);
+    TEST_ASSERT_EQUAL_UINT8(0, subs.dispatch(tracker, 0));
+    tracker.markChanged(BoatDataGroup::ENGINE | BoatDataGroup::GPS);
+    TEST_ASSERT_EQUAL_UINT8(1, subs.dispatch(tracker, 10));
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::ENGINE, rec.lastChanged);
+    TEST_ASSERT_EQUAL_UINT8(0, subs.dispatch(tracker, 20));  // Nothing new
+}
+
+/**
+ * @test Table is fixed-size; unsubscribe frees a slot
+ */
+void test_subscriptions_table_full_and_unsubscribe(void) {
+    BoatDataSubscriptions subs;
+    Recorder rec = {0, 0};
+    for (int i = 0; i < BOATDATA_MAX_SUBSCRIBERS; i++) {
+        TEST_ASSERT_EQUAL_INT(i, subs.subscribe(BoatDataGroup::GPS, 0, record, &rec));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, subs.subscribe(BoatDataGroup::GPS, 0, record, &rec));
+    TEST_ASSERT_EQUAL_INT(-1, subs.subscribe(0, 0, record, &rec));
+
+    subs.unsubscribe(3);
+    TEST_ASSERT_EQUAL_UINT8(BOATDATA_MAX_SUBSCRIBERS - 1, subs.getCount());
+    TEST_ASSERT_EQUAL_INT(3, subs.subscribe(BoatDataGroup::WIND, 0, record, &rec));
+}
+
+/**
+ * @test A max interval calls the subscriber without changes; waits are reported
+ */
+void test_subscriptions_heartbeat_and_wait(void) {
+    BoatDataChangeTracker tracker;
+    BoatDataSubscriptions subs;
+    Recorder rec = {0, 0};
+    int id = subs.subscribe(BoatDataGroup::WIND, 100, record, &rec);
+    subs.setMaxInterval(id, 1000);
+
+    TEST_ASSERT_EQUAL_UINT8(1, subs.dispatch(tracker, 0));  // First heartbeat
+    TEST_ASSERT_EQUAL_UINT16(0, rec.lastChanged);
+    TEST_ASSERT_EQUAL_UINT8(0, subs.dispatch(tracker, 990));
+    TEST_ASSERT_EQUAL_UINT8(1, subs.dispatch(tracker, 1000));
+    TEST_ASSERT_EQUAL_UINT32(0, subs.getWaitMs(id));
+
+    tracker.markChanged(BoatDataGroup::WIND);
+    TEST_ASSERT_EQUAL_UINT8(1, subs.dispatch(tracker, 1200));  // Interval passed: no wait
+    TEST_ASSERT_EQUAL_UINT32(0, subs.getWaitMs(id));
+
+    tracker.markChanged(BoatDataGroup::WIND);
+    subs.dispatch(tracker, 1250);  // Held back, pending since 1250
+    tracker.markChanged(BoatDataGroup::WIND);
+    subs.dispatch(tracker, 1280);
+    TEST_ASSERT_EQUAL_INT(3, rec.calls);
+    TEST_ASSERT_EQUAL_UINT8(1, subs.dispatch(tracker, 1300));
+    TEST_ASSERT_EQUAL_UINT16(BoatDataGroup::WIND, rec.lastChanged);
+    TEST_ASSERT_EQUAL_UINT32(50, subs.getWaitMs(id));
+}
+
+/**
+ * @test setMinInterval() re-rates a subscriber (power profile switch)
+ */
+void test_subscriptions_set_min_interval(void) {
+    BoatDataChangeTracker tracker;
+    BoatDataSubscriptions subs;
+    Recorder rec = {0, 0};
+    int id = subs.subscribe(BoatDataGroup::GPS, 100, record, &rec);
+
+    subs.setMinInterval(id, 1000);
+    subs.setMinInterval(BOATDATA_MAX_SUBSCRIBERS, 1);  // Ignored
+    for (uint32_t now = 0; now < 2000; now += 10) {
+        tracker.markChanged(BoatDataGroup::GPS);
+        subs.dispatch(tracker, now);
+    }
+    TEST_ASSERT_EQUAL_INT(2, rec.calls);  // t = 0, 1000
+
+    subs.setMinInterval(id, 100);
+    for (uint32_t now = 2000; now < 3000; now += 10) {
+        tracker.markChanged(BoatDataGroup::GPS);
+        subs.dispatch(tracker, now);
+    }
+    TEST_ASSERT_EQUAL_INT(12, rec.calls);
+}
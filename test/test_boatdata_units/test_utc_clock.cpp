@@ -0,0 +1,151 @@
+/**
+ * @file test_utc_clock.cpp
+ * @brief UTC clock: date conversion, step and slew discipline, source priority, millis() wrap, replay hold
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/UtcClock.h"
+#include "../../src/utils/UtcClock.cpp"
+
+namespace {
+
+const uint64_t NOON = 1748779200000ULL;  // 2025-06-01T12:00:00Z
+
+UtcClock utcClock;  // Fresh per test through reset()
+
+}  // namespace
+
+/**
+ * @test Civil dates, PGN 126992 day counts and ISO 8601 agree
+ */
+void test_utc_clock_date_conversion(void) {
+    TEST_ASSERT_TRUE(UtcClock::fromCivil(2025, 6, 1, 12 * 3600000UL) == NOON);
+    TEST_ASSERT_TRUE(UtcClock::fromDays(20240, 12 * 3600000UL) == NOON);  // 2025-06-01 = day 20240
+    TEST_ASSERT_TRUE(UtcClock::fromCivil(1970, 1, 1, 0) == 0);
+    TEST_ASSERT_TRUE(UtcClock::fromCivil(2024, 2, 29, 0) == 1709164800000ULL);  // Leap day
+    TEST_ASSERT_TRUE(UtcClock::fromCivil(2025, 13, 1, 0) == 0);
+    TEST_ASSERT_TRUE(UtcClock::fromCivil(1969, 12, 31, 0) == 0);
+
+    char iso[25];
+    TEST_ASSERT_TRUE(UtcClock::formatIso(NOON + 123, iso, sizeof(iso), true));
+    TEST_ASSERT_EQUAL_STRING("2025-06-01T12:00:00.123Z", iso);
+    TEST_ASSERT_TRUE(UtcClock::formatIso(1709164800000ULL + 86399000ULL, iso, 21));
+    TEST_ASSERT_EQUAL_STRING("2024-02-29T23:59:59Z", iso);
+    TEST_ASSERT_FALSE(UtcClock::formatIso(NOON, iso, 24, true));
+}
+
+/**
+ * @test The first sample steps; small errors are slewed, large ones step again
+ */
+void test_utc_clock_step_then_slew(void) {
+    utcClock.reset();
+    TEST_ASSERT_EQUAL_UINT64(0, utcClock.toUtc(1000));
+    TEST_ASSERT_FALSE(utcClock.offer(UtcSource::N2K_SYSTEM_TIME, 1000, 1000));  // Before 2020
+    TEST_ASSERT_FALSE(utcClock.update(1000));
+    TEST_ASSERT_FALSE(utcClock.synced());
+
+    TEST_ASSERT_TRUE(utcClock.offer(UtcSource::N2K_SYSTEM_TIME, NOON, 1000));
+    TEST_ASSERT_TRUE(utcClock.update(1100));
+    TEST_ASSERT_TRUE(utcClock.synced());
+    TEST_ASSERT_EQUAL_UINT32(1, utcClock.getSteps());
+    TEST_ASSERT_TRUE(utcClock.toUtc(1000) == NOON);
+    TEST_ASSERT_TRUE(utcClock.toUtc(500) == NOON - 500);  // Stamps before the sync convert too
+
+    // 80 ms late: 1/UTC_CLOCK_SLEW_DIVISOR of it per sample
+    utcClock.offer(UtcSource::N2K_SYSTEM_TIME, NOON + 1000 + 80, 2000);
+    TEST_ASSERT_FALSE(utcClock.update(2000));
+    TEST_ASSERT_EQUAL_INT32(80, utcClock.getLastErrorMs());
+    TEST_ASSERT_TRUE(utcClock.toUtc(2000) == NOON + 1000 + 80 / UTC_CLOCK_SLEW_DIVISOR);
+
+    // The same sample is applied once
+    TEST_ASSERT_FALSE(utcClock.update(2500));
+    TEST_ASSERT_TRUE(utcClock.toUtc(2000) == NOON + 1000 + 80 / UTC_CLOCK_SLEW_DIVISOR);
+
+    // An hour off (chartplotter clock set): step
+    utcClock.offer(UtcSource::N2K_SYSTEM_TIME, NOON + 3600000ULL, 3000);
+    TEST_ASSERT_TRUE(utcClock.update(3000));
+    TEST_ASSERT_EQUAL_UINT32(2, utcClock.getSteps());
+    TEST_ASSERT_TRUE(utcClock.toUtc(3000) == NOON + 3600000ULL);
+
+    StaticJsonWriter<256> json;
+    utcClock.writeJson(json, 3000);
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"synced\":true"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"iso\":\"2025-06-01T13:00:00Z\""));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"source\":\"n2k\""));
+}
+
+/**
+ * @test PGN 126992 outranks RMC; a silent source yields to the next and the clock holds over
+ */
+void test_utc_clock_source_priority(void) {
+    utcClock.reset();
+    utcClock.offer(UtcSource::NMEA0183_RMC, NOON, 1000);
+    utcClock.update(1000);
+    TEST_ASSERT_EQUAL(UtcSource::NMEA0183_RMC, utcClock.getSource());
+
+    // N2k 1.5 s ahead of RMC: slewed towards, not stepped
+    utcClock.offer(UtcSource::N2K_SYSTEM_TIME, NOON + 1000 + 1500, 2000);
+    utcClock.offer(UtcSource::NMEA0183_RMC, NOON + 1000, 2000);
+    TEST_ASSERT_FALSE(utcClock.update(2000));
+    TEST_ASSERT_EQUAL(UtcSource::N2K_SYSTEM_TIME, utcClock.getSource());
+    TEST_ASSERT_EQUAL_INT32(1500, utcClock.getLastErrorMs());
+
+    // N2k silent for the timeout: RMC takes over
+    uint32_t later = 2000 + UTC_CLOCK_SOURCE_TIMEOUT_MS + 1;
+    utcClock.offer(UtcSource::NMEA0183_RMC, NOON + later - 1000, later);
+    utcClock.update(later);
+    TEST_ASSERT_EQUAL(UtcSource::NMEA0183_RMC, utcClock.getSource());
+
+    // Both silent: holdover on millis()
+    uint32_t silent = later + UTC_CLOCK_SOURCE_TIMEOUT_MS + 1;
+    uint64_t expected = utcClock.toUtc(silent);
+    TEST_ASSERT_FALSE(utcClock.update(silent));
+    TEST_ASSERT_EQUAL(UtcSource::NONE, utcClock.getSource());
+    TEST_ASSERT_TRUE(utcClock.synced());
+    TEST_ASSERT_TRUE(utcClock.toUtc(silent) == expected);
+}
+
+/**
+ * @test Stamps on either side of the millis() wrap convert continuously
+ */
+void test_utc_clock_millis_wrap(void) {
+    utcClock.reset();
+    const uint32_t beforeWrap = 0xFFFFFF00UL;
+    utcClock.offer(UtcSource::N2K_SYSTEM_TIME, NOON, beforeWrap);
+    utcClock.update(beforeWrap);
+
+    uint32_t afterWrap = beforeWrap + 0x200;  // 512 ms later, wrapped to 0x100
+    TEST_ASSERT_EQUAL_UINT32(0x100, afterWrap);
+    TEST_ASSERT_TRUE(utcClock.toUtc(afterWrap) == NOON + 0x200);
+
+    utcClock.update(afterWrap);  // Base moves past the wrap
+    TEST_ASSERT_TRUE(utcClock.toUtc(beforeWrap) == NOON);
+    TEST_ASSERT_TRUE(utcClock.toUtc(afterWrap + 1000) == NOON + 0x200 + 1000);
+}
+
+/**
+ * @test Samples seen while held (a replay) are never applied, not even after the release
+ */
+void test_utc_clock_replay_hold(void) {
+    utcClock.reset();
+    utcClock.offer(UtcSource::N2K_SYSTEM_TIME, NOON, 1000);
+    utcClock.update(1000);
+
+    utcClock.setHeld(true, 2000);
+    utcClock.offer(UtcSource::N2K_SYSTEM_TIME, 1609459200000ULL, 2500);  // Captured on 2021-01-01
+    TEST_ASSERT_FALSE(utcClock.update(3000));
+    TEST_ASSERT_TRUE(utcClock.toUtc(3000) == NOON + 2000);
+
+    // Released with the replayed sample still newest: ignored
+    utcClock.offer(UtcSource::N2K_SYSTEM_TIME, 1609459200000ULL, 3500);
+    utcClock.setHeld(false, 4000);
+    TEST_ASSERT_FALSE(utcClock.update(4000));
+    TEST_ASSERT_EQUAL_UINT32(1, utcClock.getSteps());
+    TEST_ASSERT_TRUE(utcClock.toUtc(4000) == NOON + 3000);
+
+    // The next live sample applies
+    utcClock.offer(UtcSource::N2K_SYSTEM_TIME, NOON + 3500 + 40, 4500);
+    TEST_ASSERT_FALSE(utcClock.update(4500));
+    TEST_ASSERT_EQUAL_INT32(40, utcClock.getLastErrorMs());
+}
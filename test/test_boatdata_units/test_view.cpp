@@ -0,0 +1,63 @@
+/**
+ * @file test_view.cpp
+ * @brief Unit tests for BoatDataView (zero-copy group access)
+ */
+
+#include <unity.h>
+#include "../../src/utils/BoatDataView.h"
+
+namespace {
+
+struct Pair {
+    double a;
+    double b;
+};
+
+}  // namespace
+
+/**
+ * @test A view refers to the stored group and stays valid until the next write
+ */
+void test_view_reads_in_place_until_write(void) {
+    SeqLock lock = {};
+    Pair shared = {1.0, 2.0};
+    lock.writeBegin();
+    lock.writeEnd();
+
+    BoatDataView<Pair> view(shared, lock);
+    TEST_ASSERT_EQUAL_PTR(&shared, &view.get());
+    TEST_ASSERT_EQUAL_UINT16(1, view.version());
+    TEST_ASSERT_EQUAL_DOUBLE(2.0, view->b);
+    TEST_ASSERT_TRUE(view.valid());
+
+    lock.writeBegin();
+    shared.b = 3.0;
+    lock.writeEnd();
+    TEST_ASSERT_FALSE(view.valid());
+
+    view.refresh();
+    TEST_ASSERT_EQUAL_UINT16(2, view.version());
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, (*view).b);
+    TEST_ASSERT_TRUE(view.valid());
+}
+
+/**
+ * @test A view taken during a write is never valid; copy() matches SeqLock::read()
+ */
+void test_view_taken_during_write_and_copy(void) {
+    SeqLock lock = {};
+    Pair shared = {4.0, 5.0};
+
+    lock.writeBegin();
+    BoatDataView<Pair> view(shared, lock);
+    TEST_ASSERT_FALSE(view.valid());
+    Pair out;
+    TEST_ASSERT_FALSE(view.copy(out));
+    lock.writeEnd();
+
+    TEST_ASSERT_FALSE(view.valid());
+    uint16_t version = 0;
+    TEST_ASSERT_TRUE(view.copy(out, &version));
+    TEST_ASSERT_EQUAL_UINT16(1, version);
+    TEST_ASSERT_EQUAL_DOUBLE(4.0, out.a);
+}
@@ -0,0 +1,107 @@
+/**
+ * @file test_wifi_power_profile.cpp
+ * @brief Wi-Fi power profiles: lookup, request hand-off, time in profile, round trips, stored selection
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/WiFiPowerProfile.h"
+#include "../../src/utils/WiFiPowerProfile.cpp"
+#include "../../src/utils/LatencyHistogram.cpp"
+
+/**
+ * @test Profiles are found by name, trade latency for power in order, and switch through a request
+ */
+void test_wifi_profile_selection(void) {
+    WiFiProfile id = WiFiProfile::COUNT;
+    TEST_ASSERT_TRUE(WiFiProfileSelector::fromName("anchor", id));
+    TEST_ASSERT_TRUE(id == WiFiProfile::ANCHOR);
+    TEST_ASSERT_FALSE(WiFiProfileSelector::fromName("turbo", id));
+    TEST_ASSERT_FALSE(WiFiProfileSelector::fromName(nullptr, id));
+
+    const WiFiPowerProfile& racing = WiFiProfileSelector::profile(WiFiProfile::RACING);
+    const WiFiPowerProfile& anchor = WiFiProfileSelector::profile(WiFiProfile::ANCHOR);
+    TEST_ASSERT_TRUE(racing.powerSave == WiFiPowerSave::NONE);
+    TEST_ASSERT_TRUE(anchor.powerSave == WiFiPowerSave::MAX_MODEM);
+    TEST_ASSERT_TRUE(racing.txQuarterDbm > anchor.txQuarterDbm);
+    TEST_ASSERT_TRUE(racing.broadcastMs < anchor.broadcastMs);
+    TEST_ASSERT_TRUE(racing.udpMs < anchor.udpMs);
+    TEST_ASSERT_EQUAL_STRING("max_modem", WiFiProfileSelector::powerSaveName(anchor.powerSave));
+
+    WiFiProfileSelector selector;
+    TEST_ASSERT_EQUAL_UINT8(WIFI_PROFILE_DEFAULT, static_cast<uint8_t>(selector.getActive()));
+    WiFiProfile taken;
+    TEST_ASSERT_FALSE(selector.takeRequest(taken));
+
+    selector.request(WiFiProfile::RACING);
+    selector.request(WiFiProfile::ANCHOR);   // The last request wins
+    TEST_ASSERT_TRUE(selector.getPending() == WiFiProfile::ANCHOR);
+    TEST_ASSERT_TRUE(selector.takeRequest(taken));
+    TEST_ASSERT_TRUE(taken == WiFiProfile::ANCHOR);
+    TEST_ASSERT_FALSE(selector.takeRequest(taken));
+
+    TEST_ASSERT_TRUE(selector.select(WiFiProfile::ANCHOR, 5000));
+    TEST_ASSERT_TRUE(selector.getActive() == WiFiProfile::ANCHOR);
+    TEST_ASSERT_EQUAL_UINT32(1, selector.getChanges());
+    TEST_ASSERT_TRUE(selector.select(WiFiProfile::ANCHOR, 6000));   // Same profile: no change
+    TEST_ASSERT_EQUAL_UINT32(1, selector.getChanges());
+    TEST_ASSERT_FALSE(selector.select(WiFiProfile::COUNT, 7000));
+
+    TEST_ASSERT_TRUE(selector.select(WiFiProfile::RACING, 12000));
+    TEST_ASSERT_EQUAL_UINT32(5000, selector.getActiveMs(static_cast<WiFiProfile>(WIFI_PROFILE_DEFAULT), 15000));
+    TEST_ASSERT_EQUAL_UINT32(7000, selector.getActiveMs(WiFiProfile::ANCHOR, 15000));
+    TEST_ASSERT_EQUAL_UINT32(3000, selector.getActiveMs(WiFiProfile::RACING, 15000));
+}
+
+/**
+ * @test Round trips go to the profile active at the ping; stray and late pongs are ignored
+ */
+void test_wifi_profile_round_trip(void) {
+    WiFiProfileSelector selector;
+    selector.pongReceived(1000);   // No ping sent yet
+    TEST_ASSERT_EQUAL_UINT32(0, selector.getRoundTrip(selector.getActive()).getCount());
+
+    selector.select(WiFiProfile::RACING, 0);
+    selector.pingSent(10000);
+    selector.select(WiFiProfile::ANCHOR, 1);   // Switch while the ping is in flight
+    selector.pongReceived(13000);
+    selector.pongReceived(14000);              // Second client
+    const LatencyHistogram& racing = selector.getRoundTrip(WiFiProfile::RACING);
+    TEST_ASSERT_EQUAL_UINT32(2, racing.getCount());
+    TEST_ASSERT_EQUAL_UINT32(4000, racing.getMax());
+    TEST_ASSERT_EQUAL_UINT32(0, selector.getRoundTrip(WiFiProfile::ANCHOR).getCount());
+
+    selector.pingSent(20000);
+    selector.pongReceived(20000 + WIFI_PROFILE_PING_INTERVAL_MS * 1000UL + 1);   // Too late
+    TEST_ASSERT_EQUAL_UINT32(0, selector.getRoundTrip(WiFiProfile::ANCHOR).getCount());
+    selector.pongReceived(80000);
+    TEST_ASSERT_EQUAL_UINT32(60000, selector.getRoundTrip(WiFiProfile::ANCHOR).getMax());
+
+    StaticJsonWriter<1024> json;
+    selector.writeJson(json, 1000);
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"active\":\"anchor\",\"pending\":null"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"racing\":{\"active_s\":0,\"rtt\":{\"count\":2,"));
+}
+
+/**
+ * @test The selection survives a store round trip by name; damaged records leave it alone
+ */
+void test_wifi_profile_record(void) {
+    WiFiProfileSelector stored;
+    stored.select(WiFiProfile::RACING, 0);
+    uint8_t record[CONFIG_RECORD_MAX_BYTES];
+    size_t length = stored.encodeRecord(record, sizeof(record));
+    TEST_ASSERT_TRUE(length > 0);
+
+    WiFiProfileSelector restored;
+    TEST_ASSERT_TRUE(restored.decodeRecord(record, 0) == ConfigRecordStatus::EMPTY);
+    TEST_ASSERT_TRUE(restored.decodeRecord(record, length) == ConfigRecordStatus::OK);
+    TEST_ASSERT_TRUE(restored.getActive() == WiFiProfile::RACING);
+    TEST_ASSERT_EQUAL_UINT32(0, restored.getChanges());
+
+    record[length - 1] ^= 0xFF;
+    WiFiProfileSelector damaged;
+    TEST_ASSERT_TRUE(damaged.decodeRecord(record, length) != ConfigRecordStatus::OK);
+    TEST_ASSERT_EQUAL_UINT8(WIFI_PROFILE_DEFAULT, static_cast<uint8_t>(damaged.getActive()));
+}
@@ -0,0 +1,45 @@
+/**
+ * @file test_actisense_forward.cpp
+ * @brief Unit tests for the Actisense forward admission (whole frames or counted drops)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/JsonWriter.h"
+#include "../../src/utils/JsonWriter.cpp"
+#include "../../src/utils/ActisenseForwardStats.h"
+#include "../../src/utils/ActisenseForwardStats.cpp"
+
+void test_actisense_forward_admits_whole_frames_only() {
+    ActisenseForwardStats stats;
+
+    TEST_ASSERT_TRUE(stats.admit(30, 4096, 4096));
+    TEST_ASSERT_TRUE(stats.admit(30, 30, 4096));     // Exactly fits
+    TEST_ASSERT_FALSE(stats.admit(31, 30, 4096));    // Never a partial frame
+    TEST_ASSERT_FALSE(stats.admit(0, 4096, 4096));   // Nothing to send, not a drop
+
+    TEST_ASSERT_EQUAL_UINT32(2, stats.getFrames());
+    TEST_ASSERT_EQUAL_UINT32(60, stats.getBytes());
+    TEST_ASSERT_EQUAL_UINT32(1, stats.getDropped());
+    TEST_ASSERT_EQUAL_UINT32(31, stats.getDroppedBytes());
+}
+
+void test_actisense_forward_tracks_ring_high_water() {
+    ActisenseForwardStats stats;
+
+    stats.admit(20, 4096, 4096);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.getHighWater());
+    stats.admit(20, 1000, 4096);
+    TEST_ASSERT_EQUAL_UINT32(3096, stats.getHighWater());
+    stats.admit(20, 3000, 4096);                     // Ring drained again: peak kept
+    TEST_ASSERT_EQUAL_UINT32(3096, stats.getHighWater());
+    stats.admit(20, 5000, 4096);                     // Free above capacity (FIFO counted): no underflow
+    TEST_ASSERT_EQUAL_UINT32(3096, stats.getHighWater());
+
+    char buffer[160];
+    JsonWriter json(buffer, sizeof(buffer));
+    stats.writeJson(json);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"frames\":4,\"bytes\":80,\"dropped\":0,\"dropped_bytes\":0,\"tx_high_water\":3096}",
+        json.c_str());
+}
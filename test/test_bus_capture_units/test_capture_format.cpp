@@ -0,0 +1,140 @@
+/**
+ * @file test_capture_format.cpp
+ * @brief Unit tests for BusCaptureFormat records (raw NMEA 0183 lines, CAN frames, UTC marks)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/BusCaptureFormat.h"
+#include "../../src/utils/BusCaptureFormat.cpp"
+
+namespace {
+
+const char RMC[] = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A";
+
+}  // namespace
+
+void test_capture_header_round_trip() {
+    uint8_t header[BUS_CAPTURE_HEADER_SIZE];
+    TEST_ASSERT_EQUAL(0, BusCaptureWriteHeader(header, sizeof(header) - 1));
+    TEST_ASSERT_EQUAL(BUS_CAPTURE_HEADER_SIZE, BusCaptureWriteHeader(header, sizeof(header)));
+    TEST_ASSERT_TRUE(BusCaptureCheckHeader(header, sizeof(header)));
+    TEST_ASSERT_FALSE(BusCaptureCheckHeader(header, sizeof(header) - 1));
+
+    header[4] = BUS_CAPTURE_VERSION + 1;
+    TEST_ASSERT_FALSE(BusCaptureCheckHeader(header, sizeof(header)));
+    header[4] = 0;
+    TEST_ASSERT_FALSE(BusCaptureCheckHeader(header, sizeof(header)));
+    header[4] = 1;  // Captures from before the UTC marks still replay
+    TEST_ASSERT_TRUE(BusCaptureCheckHeader(header, sizeof(header)));
+    header[4] = BUS_CAPTURE_VERSION;
+    header[0] = 'X';
+    TEST_ASSERT_FALSE(BusCaptureCheckHeader(header, sizeof(header)));
+}
+
+void test_capture_line_and_frame_round_trip() {
+    uint8_t buf[2 * BUS_CAPTURE_MAX_RECORD];
+    const uint8_t data[8] = {0xA0, 0x13, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+
+    size_t lineLen = BusCaptureEncodeLine(buf, sizeof(buf), 1000, 2, RMC, strlen(RMC));
+    TEST_ASSERT_EQUAL(1 + 2 + 1 + strlen(RMC), lineLen);  // 1000 ms = 2-byte varint
+    size_t frameLen = BusCaptureEncodeFrame(buf + lineLen, sizeof(buf) - lineLen, 3,
+                                            0x09F80102UL, 8, data);
+    TEST_ASSERT_EQUAL(1 + 1 + 4 + 1 + 8, frameLen);
+
+    BusCaptureRecord rec;
+    int32_t used = BusCaptureDecode(buf, lineLen + frameLen, rec);
+    TEST_ASSERT_EQUAL((int32_t)lineLen, used);
+    TEST_ASSERT_EQUAL(BusCaptureType::NMEA0183_LINE, rec.type);
+    TEST_ASSERT_EQUAL(2, rec.port);
+    TEST_ASSERT_EQUAL(1000, rec.deltaMs);
+    TEST_ASSERT_EQUAL(strlen(RMC), rec.length);
+    TEST_ASSERT_EQUAL_MEMORY(RMC, rec.data, strlen(RMC));
+
+    used = BusCaptureDecode(buf + lineLen, frameLen, rec);
+    TEST_ASSERT_EQUAL((int32_t)frameLen, used);
+    TEST_ASSERT_EQUAL(BusCaptureType::CAN_FRAME, rec.type);
+    TEST_ASSERT_EQUAL(0, rec.port);
+    TEST_ASSERT_EQUAL(3, rec.deltaMs);
+    TEST_ASSERT_EQUAL_UINT32(0x09F80102UL, rec.canId);
+    TEST_ASSERT_EQUAL(8, rec.length);
+    TEST_ASSERT_EQUAL_MEMORY(data, rec.data, 8);
+}
+
+void test_capture_utc_mark_round_trip() {
+    uint8_t buf[BUS_CAPTURE_MAX_RECORD];
+    const uint64_t utc = 1748779200123ULL;  // 2025-06-01T12:00:00.123Z
+
+    size_t n = BusCaptureEncodeUtc(buf, sizeof(buf), 250, utc);
+    TEST_ASSERT_EQUAL(1 + 2 + 8, n);
+    TEST_ASSERT_EQUAL_HEX8(0x30, buf[0]);
+
+    BusCaptureRecord rec;
+    TEST_ASSERT_EQUAL((int32_t)n, BusCaptureDecode(buf, n, rec));
+    TEST_ASSERT_EQUAL(BusCaptureType::UTC_MARK, rec.type);
+    TEST_ASSERT_EQUAL(250, rec.deltaMs);
+    TEST_ASSERT_TRUE(rec.utcMs == utc);
+    TEST_ASSERT_EQUAL(8, rec.length);
+
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL(0, BusCaptureDecode(buf, i, rec));
+    }
+    TEST_ASSERT_EQUAL(0, BusCaptureEncodeUtc(buf, n - 1, 250, utc));
+}
+
+void test_capture_delta_varint_sizes() {
+    const uint32_t deltas[] = {0, 127, 128, 16383, 16384, 0xFFFFFFFFUL};
+    const size_t sizes[] = {1, 1, 2, 2, 3, 5};
+    uint8_t buf[BUS_CAPTURE_MAX_RECORD];
+    const uint8_t data[1] = {0x55};
+
+    for (size_t i = 0; i < sizeof(deltas) / sizeof(deltas[0]); i++) {
+        size_t n = BusCaptureEncodeFrame(buf, sizeof(buf), deltas[i], 0x0DF01000UL, 1, data);
+        TEST_ASSERT_EQUAL(1 + sizes[i] + 4 + 1 + 1, n);
+
+        BusCaptureRecord rec;
+        TEST_ASSERT_EQUAL((int32_t)n, BusCaptureDecode(buf, n, rec));
+        TEST_ASSERT_EQUAL_UINT32(deltas[i], rec.deltaMs);
+    }
+}
+
+void test_capture_incomplete_and_corrupt_records() {
+    uint8_t buf[BUS_CAPTURE_MAX_RECORD];
+    size_t n = BusCaptureEncodeLine(buf, sizeof(buf), 200, 0, RMC, strlen(RMC));
+    BusCaptureRecord rec;
+
+    // Every prefix of a record asks for more data
+    for (size_t i = 0; i < n; i++) {
+        TEST_ASSERT_EQUAL(0, BusCaptureDecode(buf, i, rec));
+    }
+
+    // Unknown record type
+    uint8_t bad[4] = {0x40, 0x00, 0x00, 0x00};
+    TEST_ASSERT_EQUAL(-1, BusCaptureDecode(bad, sizeof(bad), rec));
+
+    // CAN data length above 8
+    const uint8_t data[8] = {0};
+    n = BusCaptureEncodeFrame(buf, sizeof(buf), 0, 0x09F80102UL, 8, data);
+    buf[6] = 9;
+    TEST_ASSERT_EQUAL(-1, BusCaptureDecode(buf, n + 1, rec));
+
+    // Delta varint that never terminates
+    uint8_t endless[8] = {0x10, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80};
+    TEST_ASSERT_EQUAL(-1, BusCaptureDecode(endless, sizeof(endless), rec));
+}
+
+void test_capture_encode_limits() {
+    uint8_t buf[2 * BUS_CAPTURE_MAX_RECORD];
+    char longLine[BUS_CAPTURE_MAX_LINE + 1];
+    memset(longLine, 'A', sizeof(longLine));
+    const uint8_t data[9] = {0};
+
+    TEST_ASSERT_EQUAL(0, BusCaptureEncodeLine(buf, sizeof(buf), 0, 0, longLine, sizeof(longLine)));
+    TEST_ASSERT_EQUAL(1 + 1 + 1 + BUS_CAPTURE_MAX_LINE,
+                      BusCaptureEncodeLine(buf, sizeof(buf), 0, 0, longLine, BUS_CAPTURE_MAX_LINE));
+    TEST_ASSERT_EQUAL(0, BusCaptureEncodeLine(buf, sizeof(buf), 0, 16, RMC, strlen(RMC)));
+    TEST_ASSERT_EQUAL(0, BusCaptureEncodeLine(buf, strlen(RMC) + 2, 0, 0, RMC, strlen(RMC)));
+    TEST_ASSERT_EQUAL(0, BusCaptureEncodeFrame(buf, sizeof(buf), 0, 0, 9, data));
+    TEST_ASSERT_EQUAL(0, BusCaptureEncodeFrame(buf, 14, 0, 0, 8, data));
+    TEST_ASSERT_EQUAL(BUS_CAPTURE_MAX_RECORD, 1 + 5 + 1 + BUS_CAPTURE_MAX_LINE);
+}
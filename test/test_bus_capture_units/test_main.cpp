@@ -0,0 +1,53 @@
+/**
+ * @file test_main.cpp
+ * @brief Unit tests for the raw bus capture record format
+ *
+ * Tests validate:
+ * - BusCaptureFormat (file header, NMEA 0183 line, CAN frame and UTC mark records,
+ *   varint time deltas, incomplete/corrupt input detection)
+ * - ActisenseForwardStats (whole-frame admission to the console TX ring, drop counters)
+ *
+ * Test Organization:
+ * - test_capture_format.cpp: encode/decode round trips and error cases
+ * - test_actisense_forward.cpp: frame admission and counters
+ */
+
+#include <unity.h>
+
+// Forward declarations for capture format tests
+void test_capture_header_round_trip();
+void test_capture_line_and_frame_round_trip();
+void test_capture_utc_mark_round_trip();
+void test_capture_delta_varint_sizes();
+void test_capture_incomplete_and_corrupt_records();
+void test_capture_encode_limits();
+
+// Forward declarations for Actisense forward tests
+void test_actisense_forward_admits_whole_frames_only();
+void test_actisense_forward_tracks_ring_high_water();
+
+void setUp() {
+    // Set up before each test
+}
+
+void tearDown() {
+    // Clean up after each test
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    // Capture format tests
+    RUN_TEST(test_capture_header_round_trip);
+    RUN_TEST(test_capture_line_and_frame_round_trip);
+    RUN_TEST(test_capture_utc_mark_round_trip);
+    RUN_TEST(test_capture_delta_varint_sizes);
+    RUN_TEST(test_capture_incomplete_and_corrupt_records);
+    RUN_TEST(test_capture_encode_limits);
+
+    // Actisense forward tests
+    RUN_TEST(test_actisense_forward_admits_whole_frames_only);
+    RUN_TEST(test_actisense_forward_tracks_ring_high_water);
+
+    return UNITY_END();
+}
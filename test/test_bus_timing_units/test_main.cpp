@@ -0,0 +1,68 @@
+/**
+ * @file test_main.cpp
+ * @brief Host timing and throughput tests on a virtual clock
+ *
+ * Tests validate:
+ * - MockN2kCanBus: scripted frames reach the PGN handlers through the
+ *   NMEA2000 library (N2kPGNDispatcher, statistics, BoatData), fast-packet
+ *   reassembly and scripted frame loss, arrival-to-fetch waits per pass,
+ *   RX queue overruns when the receive path is too slow
+ * - MockSerialPort baud pacing: bytes become available at the line rate
+ * - Accelerated soak: source arbitration for hours across the millis() wrap
+ *
+ * millis() and micros() come from GetVirtualClock(), so every result is the
+ * same on every run and every host.
+ *
+ * Test Organization:
+ * - test_mock_can_bus.cpp: NMEA 2000 receive path timing
+ * - test_serial_pacing.cpp: NMEA 0183 byte timing
+ * - test_soak_clock_wrap.cpp: SourcePrioritizer across the 49.7-day wrap
+ */
+
+#include <unity.h>
+#include "mocks/VirtualClock.h"
+
+unsigned long millis() { return GetVirtualClock().millis(); }
+unsigned long micros() { return GetVirtualClock().micros(); }
+
+// Forward declarations for MockN2kCanBus tests
+void test_can_frame_fetched_on_next_pass();
+void test_can_fast_packet_reassembled();
+void test_can_fast_packet_missing_frame_dropped();
+void test_can_keeps_up_below_capacity();
+void test_can_overruns_when_receive_path_too_slow();
+
+// Forward declarations for MockSerialPort pacing tests
+void test_serial_pacing_releases_bytes_at_baud();
+void test_serial_without_pacing_releases_all();
+
+// Forward declarations for accelerated soak tests
+void test_soak_sources_stay_active_across_millis_wrap();
+void test_soak_failover_after_millis_wrap();
+
+void setUp(void) {
+    GetVirtualClock().reset();
+}
+
+void tearDown(void) {}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // MockN2kCanBus tests
+    RUN_TEST(test_can_frame_fetched_on_next_pass);
+    RUN_TEST(test_can_fast_packet_reassembled);
+    RUN_TEST(test_can_fast_packet_missing_frame_dropped);
+    RUN_TEST(test_can_keeps_up_below_capacity);
+    RUN_TEST(test_can_overruns_when_receive_path_too_slow);
+
+    // MockSerialPort pacing tests
+    RUN_TEST(test_serial_pacing_releases_bytes_at_baud);
+    RUN_TEST(test_serial_without_pacing_releases_all);
+
+    // Accelerated soak tests
+    RUN_TEST(test_soak_sources_stay_active_across_millis_wrap);
+    RUN_TEST(test_soak_failover_after_millis_wrap);
+
+    return UNITY_END();
+}
@@ -0,0 +1,132 @@
+/**
+ * @file test_mock_can_bus.cpp
+ * @brief NMEA 2000 receive path timing through MockN2kCanBus
+ *
+ * The handlers are registered once on a static bus (the library keeps the
+ * handler objects); each test clears the script and the clock.
+ */
+
+#include <unity.h>
+#include <NMEA2000.h>
+#include <N2kMessages.h>
+#include "mocks/MockN2kCanBus.h"
+#include "mocks/VirtualClock.h"
+#include "components/BoatData.h"
+#include "components/NMEA2000Handlers.h"
+#include "components/SourcePrioritizer.h"
+#include "utils/WebSocketLogger.h"
+
+namespace {
+
+WebSocketLogger logger;
+SourcePrioritizer* prioritizer = nullptr;
+BoatData* boatData = nullptr;
+MockN2kCanBus bus;
+
+/// Bus with handlers, empty script, clock at 0
+MockN2kCanBus& freshBus() {
+    if (boatData == nullptr) {
+        prioritizer = new SourcePrioritizer();
+        boatData = new BoatData(prioritizer);
+        RegisterN2kHandlers(&bus, boatData, &logger);
+    }
+    bus.clear();
+    GetVirtualClock().reset();
+    return bus;
+}
+
+uint32_t received(uint32_t pgn, uint8_t source) {
+    const N2kPGNStatsEntry* entry = GetN2kPGNStats().find(pgn, source);
+    return entry != nullptr ? entry->received : 0;
+}
+
+void windMessage(tN2kMsg& msg, uint8_t source, double angle) {
+    SetN2kPGN130306(msg, 0, 7.3, angle, N2kWind_Apparent);
+    msg.Source = source;
+}
+
+void gnssMessage(tN2kMsg& msg, uint8_t source) {
+    SetN2kPGN129029(msg, 1, 20000, 45296.0, 48.1173, 11.5167, 12.0, N2kGNSSt_GPS,
+                    N2kGNSSm_GNSSfix, 8, 0.9);
+    msg.Source = source;
+}
+
+/// Frames every @p spacingUs for 100 ms, passes every 10 ms, @p costUs per frame
+void runSteadyLoad(MockN2kCanBus& can, uint32_t spacingUs, uint32_t costUs) {
+    tN2kMsg msg;
+    can.setRxCapacity(16);
+    can.setFrameCostUs(costUs);
+    for (uint32_t at = 0; at < 100000; at += spacingUs) {
+        windMessage(msg, 12, 0.5);
+        can.scheduleMessage(at, msg);
+    }
+    can.runUntil(200000, 10000);
+}
+
+}  // namespace
+
+void test_can_frame_fetched_on_next_pass() {
+    MockN2kCanBus& can = freshBus();
+    tN2kMsg msg;
+    windMessage(msg, 10, 0.61);
+    uint32_t before = received(130306UL, 10);
+
+    TEST_ASSERT_EQUAL_UINT8(1, can.scheduleMessage(5000, msg));
+    TEST_ASSERT_EQUAL_UINT32(2, can.runUntil(20000, 10000));  // Passes at 0 and 10 ms
+
+    TEST_ASSERT_EQUAL_UINT32(1, can.getDelivered());
+    TEST_ASSERT_EQUAL_UINT32(5000, can.getMaxWaitUs());
+    TEST_ASSERT_EQUAL_UINT32(before + 1, received(130306UL, 10));
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 0.61, (double)boatData->getDataStructure()->wind.apparentWindAngle);
+}
+
+void test_can_fast_packet_reassembled() {
+    MockN2kCanBus& can = freshBus();
+    tN2kMsg msg;
+    gnssMessage(msg, 20);
+    uint32_t before = received(129029UL, 20);
+
+    uint8_t frames = can.scheduleMessage(1000, msg, 200);
+    TEST_ASSERT_GREATER_THAN_UINT8(1, frames);
+    can.runUntil(30000, 10000);
+
+    TEST_ASSERT_EQUAL_UINT32(frames, can.getDelivered());
+    TEST_ASSERT_EQUAL_UINT32(before + 1, received(129029UL, 20));
+    TEST_ASSERT_FLOAT_WITHIN(1e-6, 48.1173, boatData->getDataStructure()->gps.latitude);
+}
+
+void test_can_fast_packet_missing_frame_dropped() {
+    MockN2kCanBus& can = freshBus();
+    tN2kMsg msg;
+    gnssMessage(msg, 21);
+
+    uint8_t frames = can.scheduleMessage(1000, msg, 200, 2);
+    can.runUntil(30000, 10000);
+
+    TEST_ASSERT_EQUAL_UINT32(frames, can.getDelivered());
+    TEST_ASSERT_EQUAL_UINT32(0, received(129029UL, 21));  // Never reassembled, never handled
+}
+
+void test_can_keeps_up_below_capacity() {
+    MockN2kCanBus& can = freshBus();
+    runSteadyLoad(can, 1000, 100);  // 1000 frames/s, 10% of the receive path's capacity
+
+    TEST_ASSERT_EQUAL_UINT32(100, can.getDelivered());
+    TEST_ASSERT_EQUAL_UINT32(0, can.getOverruns());
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(10000, can.getMaxWaitUs());  // Never more than one pass
+}
+
+void test_can_overruns_when_receive_path_too_slow() {
+    MockN2kCanBus& can = freshBus();
+    runSteadyLoad(can, 500, 800);  // 2000 frames/s into a path that handles 1250
+    uint32_t overruns = can.getOverruns();
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, overruns);
+    TEST_ASSERT_EQUAL_UINT32(200, can.getDelivered() + overruns);
+    TEST_ASSERT_EQUAL_UINT16(16, can.getQueueHighWater());
+
+    // Same script, same result
+    MockN2kCanBus& again = freshBus();
+    runSteadyLoad(again, 500, 800);
+    TEST_ASSERT_EQUAL_UINT32(overruns, again.getOverruns());
+}
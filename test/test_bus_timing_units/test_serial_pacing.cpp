@@ -0,0 +1,35 @@
+/**
+ * @file test_serial_pacing.cpp
+ * @brief MockSerialPort releases bytes at the line rate of the virtual clock
+ */
+
+#include <unity.h>
+#include "mocks/MockSerialPort.h"
+#include "mocks/VirtualClock.h"
+
+// 41 bytes: 85.4 ms at 4800 baud (10 bit times per byte)
+static const char* const SENTENCE = "$HCHDM,238.5,M*2A\r\n$GPVTG,054.7,T,,M*2B\r\n";
+
+void test_serial_pacing_releases_bytes_at_baud() {
+    MockSerialPort port;
+    port.setBaudPacing(4800);
+    port.setMockData(SENTENCE);
+    TEST_ASSERT_EQUAL_INT(0, port.available());
+    TEST_ASSERT_EQUAL_INT(-1, port.read());
+
+    GetVirtualClock().advanceUs(10000);  // 4.8 byte times
+    TEST_ASSERT_EQUAL_INT(4, port.available());
+    for (int i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(SENTENCE[i], port.read());
+    }
+    TEST_ASSERT_EQUAL_INT(0, port.available());
+
+    GetVirtualClock().advanceUs(1000000);
+    TEST_ASSERT_EQUAL_INT((int)strlen(SENTENCE) - 4, port.available());
+}
+
+void test_serial_without_pacing_releases_all() {
+    MockSerialPort port;
+    port.setMockData(SENTENCE);
+    TEST_ASSERT_EQUAL_INT((int)strlen(SENTENCE), port.available());
+}
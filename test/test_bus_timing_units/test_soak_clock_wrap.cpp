@@ -0,0 +1,120 @@
+/**
+ * @file test_soak_clock_wrap.cpp
+ * @brief Accelerated soak: source arbitration for hours across the millis() wrap
+ *
+ * The device reaches the 32-bit millis() wrap after 49.7 days, far beyond
+ * any bench run. Here the virtual clock starts an hour before it and the
+ * sources are driven at their real rates for hours of virtual time, in
+ * well under a second.
+ */
+
+#include <unity.h>
+#include "mocks/VirtualClock.h"
+#include "components/SourcePrioritizer.h"
+
+namespace {
+
+const uint32_t WRAP_MS = 0xFFFFFFFFu;
+const uint32_t HOUR_MS = 3600000;
+const uint32_t STALE_MS = 5000;  // SourcePrioritizer::STALE_THRESHOLD_MS
+
+struct GpsPair {
+    SourcePrioritizer prioritizer;
+    int fast;   ///< 10 Hz, good fix: the one that should stay active
+    int slow;   ///< 1 Hz
+    uint32_t steps;
+
+    GpsPair() : steps(0) {
+        fast = prioritizer.registerSource("NMEA2000-10", SensorType::GPS, ProtocolType::NMEA2000);
+        slow = prioritizer.registerSource("NMEA0183-GP", SensorType::GPS, ProtocolType::NMEA0183);
+        prioritizer.updateSourceQuality(fast, 1, 10, 0.8);
+        prioritizer.updateSourceQuality(slow, 1, 10, 0.8);
+        prioritizer.updateSourceTimestamp(slow, GetVirtualClock().millis());
+    }
+
+    /// One 100 ms step like the loop: updates due, then the stale check and priorities
+    void step(bool fastRunning) {
+        GetVirtualClock().advanceMs(100);
+        uint32_t now = GetVirtualClock().millis();
+        if (fastRunning) {
+            prioritizer.updateSourceTimestamp(fast, now);
+        }
+        if (++steps % 10 == 0) {
+            prioritizer.updateSourceTimestamp(slow, now);
+            prioritizer.checkStale(now);
+            prioritizer.updatePriorities(now);
+        }
+    }
+};
+
+}  // namespace
+
+/**
+ * @brief Three hours across the millis() wrap: no stale source, no failover
+ */
+void test_soak_sources_stay_active_across_millis_wrap() {
+    GetVirtualClock().resetMs(WRAP_MS - HOUR_MS - 450);  // Wraps between two 1 Hz updates
+    GpsPair gps;
+
+    uint32_t switches = 0;
+    uint32_t staleChecks = 0;
+    int active = -1;
+    bool wrapped = false;
+    uint32_t previous = GetVirtualClock().millis();
+    for (uint32_t i = 0; i < 3 * HOUR_MS / 100; i++) {
+        gps.step(true);
+        uint32_t now = GetVirtualClock().millis();
+        wrapped = wrapped || now < previous;
+        previous = now;
+
+        int current = gps.prioritizer.getActiveSource(SensorType::GPS);
+        if (active >= 0 && current != active) {
+            switches++;
+        }
+        active = current;
+        if (gps.prioritizer.isSourceStale(gps.fast, now) || gps.prioritizer.isSourceStale(gps.slow, now)) {
+            staleChecks++;
+        }
+    }
+
+    TEST_ASSERT_TRUE(wrapped);
+    TEST_ASSERT_EQUAL_INT(gps.fast, active);
+    TEST_ASSERT_EQUAL_UINT32(0, switches);
+    TEST_ASSERT_EQUAL_UINT32(0, staleChecks);
+
+    // The interval averages saw no 49.7-day gap at the wrap
+    SensorSource fast = gps.prioritizer.getSource(gps.fast);
+    TEST_ASSERT_DOUBLE_WITHIN(1.0, 100.0, fast.avgUpdateInterval);
+    TEST_ASSERT_TRUE(fast.available);
+    TEST_ASSERT_EQUAL_UINT32(3 * HOUR_MS / 100, fast.updateCount);
+}
+
+/**
+ * @brief After the wrap a silent source still fails over, and an update at millis() 0 counts
+ */
+void test_soak_failover_after_millis_wrap() {
+    GetVirtualClock().resetMs(WRAP_MS - 30000);
+    GpsPair gps;
+    for (uint32_t i = 0; i < 600; i++) {  // One minute, across the wrap
+        gps.step(true);
+    }
+    TEST_ASSERT_TRUE(GetVirtualClock().millis() < 60000);
+    TEST_ASSERT_EQUAL_INT(gps.fast, gps.prioritizer.getActiveSource(SensorType::GPS));
+
+    // The fast source goes quiet: stale after STALE_MS, the slow one takes over
+    for (uint32_t i = 0; i < 70; i++) {
+        gps.step(false);
+    }
+    uint32_t now = GetVirtualClock().millis();
+    TEST_ASSERT_TRUE(gps.prioritizer.isSourceStale(gps.fast, now));
+    TEST_ASSERT_FALSE(gps.prioritizer.isSourceStale(gps.slow, now));
+    TEST_ASSERT_EQUAL_INT(gps.slow, gps.prioritizer.getActiveSource(SensorType::GPS));
+
+    // millis() 0 is an ordinary timestamp once the clock has wrapped
+    SourcePrioritizer prioritizer;
+    int wind = prioritizer.registerSource("NMEA2000-20", SensorType::WIND, ProtocolType::NMEA2000);
+    TEST_ASSERT_TRUE(prioritizer.isSourceStale(wind, 0));  // Never updated
+    prioritizer.updateSourceTimestamp(wind, 0);
+    TEST_ASSERT_FALSE(prioritizer.isSourceStale(wind, STALE_MS));
+    TEST_ASSERT_TRUE(prioritizer.isSourceStale(wind, STALE_MS + 1));
+}
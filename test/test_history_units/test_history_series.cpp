@@ -0,0 +1,155 @@
+/**
+ * @file test_history_series.cpp
+ * @brief Unit tests for HistorySeries (three-tier min/max/mean history)
+ */
+
+#include <unity.h>
+#include "../../src/utils/HistorySeries.h"
+#include "../../src/utils/HistorySeries.cpp"
+
+namespace {
+
+const uint32_t PERIODS[HistorySeries::TIER_COUNT] = {1000, 2000, 4000};
+const uint16_t CAPACITY[HistorySeries::TIER_COUNT] = {8, 8, 8};
+
+int16_t storage[3 * 8 * HistorySeries::TIER_COUNT];
+
+void readBucket(const HistorySeries& series, uint8_t tier, uint16_t index,
+                int16_t& min, int16_t& max, int16_t& mean) {
+    TEST_ASSERT_TRUE(series.read(tier, index, min, max, mean));
+}
+
+}  // namespace
+
+void test_history_bucket_min_max_mean() {
+    HistorySeries series;
+    TEST_ASSERT_EQUAL(sizeof(storage), HistorySeries::storageBytes(CAPACITY));
+    TEST_ASSERT_TRUE(series.begin(storage, CAPACITY, PERIODS, 0.01f, false));
+
+    series.addSample(1.0f, 1000);
+    series.addSample(3.0f, 1100);
+    series.addSample(2.0f, 1500);
+    TEST_ASSERT_EQUAL(0, series.size(0));  // Bucket still open
+
+    series.advance(2000);
+    TEST_ASSERT_EQUAL(1, series.size(0));
+    TEST_ASSERT_EQUAL(2000, series.currentBucketStartMs(0));
+
+    int16_t min, max, mean;
+    readBucket(series, 0, 0, min, max, mean);
+    TEST_ASSERT_EQUAL(100, min);
+    TEST_ASSERT_EQUAL(300, max);
+    TEST_ASSERT_EQUAL(200, mean);
+    TEST_ASSERT_FALSE(series.read(0, 1, min, max, mean));
+}
+
+void test_history_downsamples_into_coarser_tiers() {
+    HistorySeries series;
+    TEST_ASSERT_TRUE(series.begin(storage, CAPACITY, PERIODS, 0.01f, false));
+
+    for (uint32_t i = 0; i < 4; i++) {
+        series.addSample(static_cast<float>(i), i * 1000);
+    }
+    series.advance(4000);
+
+    TEST_ASSERT_EQUAL(4, series.size(0));
+    TEST_ASSERT_EQUAL(2, series.size(1));
+    TEST_ASSERT_EQUAL(1, series.size(2));
+
+    int16_t min, max, mean;
+    readBucket(series, 1, 0, min, max, mean);
+    TEST_ASSERT_EQUAL(0, min);
+    TEST_ASSERT_EQUAL(100, max);
+    TEST_ASSERT_EQUAL(50, mean);
+    readBucket(series, 1, 1, min, max, mean);
+    TEST_ASSERT_EQUAL(200, min);
+    TEST_ASSERT_EQUAL(300, max);
+    TEST_ASSERT_EQUAL(250, mean);
+
+    // Coarsest tier is weighted by sample count, not by bucket
+    readBucket(series, 2, 0, min, max, mean);
+    TEST_ASSERT_EQUAL(0, min);
+    TEST_ASSERT_EQUAL(300, max);
+    TEST_ASSERT_EQUAL(150, mean);
+}
+
+void test_history_records_gaps() {
+    HistorySeries series;
+    TEST_ASSERT_TRUE(series.begin(storage, CAPACITY, PERIODS, 0.01f, false));
+
+    series.addSample(5.0f, 0);
+    series.advance(3500);
+
+    int16_t min, max, mean;
+    TEST_ASSERT_EQUAL(3, series.size(0));
+    readBucket(series, 0, 0, min, max, mean);
+    TEST_ASSERT_EQUAL(500, mean);
+    readBucket(series, 0, 1, min, max, mean);
+    TEST_ASSERT_EQUAL(HISTORY_NO_DATA, mean);
+    readBucket(series, 0, 2, min, max, mean);
+    TEST_ASSERT_EQUAL(HISTORY_NO_DATA, min);
+    TEST_ASSERT_EQUAL(3000, series.currentBucketStartMs(0));
+
+    // Long outage: the whole ring becomes gap, bucket times stay aligned
+    series.advance(100500);
+    TEST_ASSERT_EQUAL(8, series.size(0));
+    for (uint16_t i = 0; i < 8; i++) {
+        readBucket(series, 0, i, min, max, mean);
+        TEST_ASSERT_EQUAL(HISTORY_NO_DATA, mean);
+    }
+    TEST_ASSERT_EQUAL(100000, series.currentBucketStartMs(0));
+    TEST_ASSERT_EQUAL(100000, series.currentBucketStartMs(2));
+}
+
+void test_history_ring_keeps_newest() {
+    const uint16_t capacity[HistorySeries::TIER_COUNT] = {3, 2, 1};
+    HistorySeries series;
+    TEST_ASSERT_TRUE(series.begin(storage, capacity, PERIODS, 1.0f, false));
+
+    for (uint32_t i = 1; i <= 5; i++) {
+        series.addSample(static_cast<float>(i), i * 1000);
+    }
+    series.advance(6000);
+
+    int16_t min, max, mean;
+    TEST_ASSERT_EQUAL(3, series.size(0));
+    readBucket(series, 0, 0, min, max, mean);
+    TEST_ASSERT_EQUAL(3, mean);
+    readBucket(series, 0, 2, min, max, mean);
+    TEST_ASSERT_EQUAL(5, mean);
+    TEST_ASSERT_EQUAL(2, series.size(1));
+    TEST_ASSERT_EQUAL(1, series.size(2));
+}
+
+void test_history_circular_wraps_across_zero() {
+    HistorySeries series;
+    TEST_ASSERT_TRUE(series.begin(storage, CAPACITY, PERIODS, 0.001f, true));
+
+    // 355° and 6°: the mean is near north, not near south
+    series.addSample(6.2f, 0);
+    series.addSample(0.1f, 100);
+    series.advance(1000);
+
+    int16_t min, max, mean;
+    readBucket(series, 0, 0, min, max, mean);
+    TEST_ASSERT_EQUAL(6200, min);  // Arc runs clockwise from min to max
+    TEST_ASSERT_EQUAL(100, max);
+    TEST_ASSERT_INT_WITHIN(2, 8, mean);
+}
+
+void test_history_rejects_invalid_config() {
+    const uint16_t noCapacity[HistorySeries::TIER_COUNT] = {8, 0, 8};
+    const uint32_t unaligned[HistorySeries::TIER_COUNT] = {1000, 1500, 3000};
+    HistorySeries series;
+
+    TEST_ASSERT_FALSE(series.begin(nullptr, CAPACITY, PERIODS, 0.01f, false));
+    TEST_ASSERT_FALSE(series.begin(storage, noCapacity, PERIODS, 0.01f, false));
+    TEST_ASSERT_FALSE(series.begin(storage, CAPACITY, unaligned, 0.01f, false));
+    TEST_ASSERT_FALSE(series.begin(storage, CAPACITY, PERIODS, 0.0f, false));
+
+    // Unconfigured series ignores input
+    series.addSample(1.0f, 0);
+    series.advance(5000);
+    TEST_ASSERT_EQUAL(0, series.size(0));
+    TEST_ASSERT_EQUAL(32767, series.quantize(1.0e9f));
+}
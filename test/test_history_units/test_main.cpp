@@ -0,0 +1,43 @@
+/**
+ * @file test_main.cpp
+ * @brief Unit tests for the BoatData field history series
+ *
+ * Tests validate:
+ * - HistorySeries (bucket min/max/mean, downsampling into coarser tiers,
+ *   gaps for intervals without samples, ring wrap, circular angles)
+ *
+ * Test Organization:
+ * - test_history_series.cpp: tier aggregation and storage cases
+ */
+
+#include <unity.h>
+
+// Forward declarations for history series tests
+void test_history_bucket_min_max_mean();
+void test_history_downsamples_into_coarser_tiers();
+void test_history_records_gaps();
+void test_history_ring_keeps_newest();
+void test_history_circular_wraps_across_zero();
+void test_history_rejects_invalid_config();
+
+void setUp() {
+    // Set up before each test
+}
+
+void tearDown() {
+    // Clean up after each test
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    // History series tests
+    RUN_TEST(test_history_bucket_min_max_mean);
+    RUN_TEST(test_history_downsamples_into_coarser_tiers);
+    RUN_TEST(test_history_records_gaps);
+    RUN_TEST(test_history_ring_keeps_newest);
+    RUN_TEST(test_history_circular_wraps_across_zero);
+    RUN_TEST(test_history_rejects_invalid_config);
+
+    return UNITY_END();
+}
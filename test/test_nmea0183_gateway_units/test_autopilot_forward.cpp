@@ -0,0 +1,200 @@
+/**
+ * @file test_autopilot_forward.cpp
+ * @brief Unit tests for the autopilot fast path (pre-encoded sentence templates)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/AutopilotForward.h"
+#include "../../src/utils/NMEA0183Encoder.h"
+#include "../../src/utils/AutopilotForward.cpp"
+#include "../../src/utils/JsonWriter.cpp"
+
+namespace {
+
+uint32_t fakeNowUs = 0;
+uint32_t fakeArrivalUs = 0;
+size_t fakeRoom = 1024;
+char written[256];
+size_t writtenLength = 0;
+int writes = 0;
+
+uint32_t clockNow() { return fakeNowUs; }
+uint32_t clockArrival() { return fakeArrivalUs; }
+
+size_t fakeWrite(void* context, const uint8_t* data, size_t size) {
+    (void)context;
+    writes++;
+    if (size > fakeRoom) {
+        return 0;
+    }
+    memcpy(written, data, size);
+    writtenLength = size;
+    return size;
+}
+
+void resetFakes() {
+    fakeNowUs = 1000000;
+    fakeArrivalUs = 1000000;
+    fakeRoom = 1024;
+    writtenLength = 0;
+    writes = 0;
+}
+
+/// 127250 payload: SID, heading, deviation, variation (1e-4 rad), reference
+void heading127250(uint8_t* data, uint16_t heading, int16_t deviation, int16_t variation, uint8_t reference) {
+    data[0] = 1;
+    data[1] = heading & 0xFF;
+    data[2] = heading >> 8;
+    data[3] = static_cast<uint16_t>(deviation) & 0xFF;
+    data[4] = static_cast<uint16_t>(deviation) >> 8;
+    data[5] = static_cast<uint16_t>(variation) & 0xFF;
+    data[6] = static_cast<uint16_t>(variation) >> 8;
+    data[7] = 0xFC | reference;
+}
+
+/// 127251 payload: SID, rate (3.125e-8 rad/s), reserved
+void rate127251(uint8_t* data, int32_t rate) {
+    uint32_t raw = static_cast<uint32_t>(rate);
+    data[0] = 1;
+    data[1] = raw & 0xFF;
+    data[2] = (raw >> 8) & 0xFF;
+    data[3] = (raw >> 16) & 0xFF;
+    data[4] = raw >> 24;
+    data[5] = data[6] = data[7] = 0xFF;
+}
+
+}  // namespace
+
+/**
+ * @brief Template output is byte-identical to the regular encoder's HDM and HDG
+ */
+void test_autopilot_hdm_hdg_match_encoder() {
+    AutopilotForward ap(AutopilotSentence::HDM | AutopilotSentence::HDG, "HC");
+    uint8_t data[8];
+    heading127250(data, 10000, 0x7FFF, -611, 1);   // 57.296 deg magnetic, variation 3.501 W
+
+    char out[AutopilotForward::MAX_OUTPUT];
+    size_t length = ap.encode(127250, data, 8, out, sizeof(out));
+
+    char expected[2 * NMEA0183_MAX_SENTENCE_SIZE];
+    size_t hdm = NMEA0183EncodeHDM(expected, sizeof(expected), "HC", 57.29578);
+    size_t hdg = NMEA0183EncodeHDG(expected + hdm, sizeof(expected) - hdm, "HC", 57.29578, -3.5007);
+    TEST_ASSERT_EQUAL(hdm + hdg, length);
+    TEST_ASSERT_EQUAL_MEMORY(expected, out, length);
+}
+
+/**
+ * @brief True heading gives HDT, rate of turn gives ROT in degrees per minute
+ */
+void test_autopilot_hdt_and_rot_layout() {
+    AutopilotForward ap(AutopilotSentence::HDT | AutopilotSentence::ROT, "HC");
+    uint8_t data[8];
+    char out[AutopilotForward::MAX_OUTPUT];
+    char expected[32];
+
+    heading127250(data, 62831, 0x7FFF, 0x7FFF, 0);   // 359.99 deg rounds to 0.0
+    size_t length = ap.encode(127250, data, 8, out, sizeof(out));
+    snprintf(expected, sizeof(expected), "$HCHDT,0.0,T*%02X\r\n", NMEA0183SentenceWriter::checksum("HCHDT,0.0,T", 11));
+    TEST_ASSERT_EQUAL(strlen(expected), length);
+    TEST_ASSERT_EQUAL_MEMORY(expected, out, length);
+
+    rate127251(data, -320000);   // -0.01 rad/s = -34.4 deg/min
+    length = ap.encode(127251, data, 8, out, sizeof(out));
+    snprintf(expected, sizeof(expected), "$HCROT,-34.4,A*%02X\r\n", NMEA0183SentenceWriter::checksum("HCROT,-34.4,A", 13));
+    TEST_ASSERT_EQUAL(strlen(expected), length);
+    TEST_ASSERT_EQUAL_MEMORY(expected, out, length);
+}
+
+/**
+ * @brief Unavailable heading/rate, unselected sentences and short payloads send nothing
+ */
+void test_autopilot_na_and_unselected() {
+    AutopilotForward ap(AutopilotSentence::HDM, "HC");
+    uint8_t data[8];
+    char out[AutopilotForward::MAX_OUTPUT];
+
+    heading127250(data, 0xFFFF, 0, 0, 1);
+    TEST_ASSERT_EQUAL(0, ap.encode(127250, data, 8, out, sizeof(out)));
+
+    heading127250(data, 10000, 0, 0, 0);   // True: HDT is not selected
+    TEST_ASSERT_EQUAL(0, ap.encode(127250, data, 8, out, sizeof(out)));
+
+    heading127250(data, 10000, 0, 0, 1);
+    TEST_ASSERT_EQUAL(0, ap.encode(127250, data, 7, out, sizeof(out)));
+    TEST_ASSERT_EQUAL(0, ap.encode(127250, data, 8, out, 10));   // Does not fit
+
+    rate127251(data, 0x7FFFFFFF);
+    TEST_ASSERT_FALSE(ap.handles(127251));
+    TEST_ASSERT_EQUAL(0, ap.encode(127251, data, 8, out, sizeof(out)));
+}
+
+/**
+ * @brief A sentence type goes out at most every AP_FORWARD_MIN_INTERVAL_MS
+ */
+void test_autopilot_rate_limit() {
+    resetFakes();
+    AutopilotForward ap(AutopilotSentence::HDM, "HC");
+    ap.attach(fakeWrite, nullptr, clockNow, clockArrival);
+    uint8_t data[8];
+    heading127250(data, 10000, 0, 0, 1);
+
+    TEST_ASSERT_TRUE(ap.forward(127250, data, 8));
+    fakeNowUs += AP_FORWARD_MIN_INTERVAL_MS * 1000UL - 1;
+    TEST_ASSERT_FALSE(ap.forward(127250, data, 8));
+    fakeNowUs += 1;
+    TEST_ASSERT_TRUE(ap.forward(127250, data, 8));
+
+    TEST_ASSERT_EQUAL(2, ap.getSent());
+    TEST_ASSERT_EQUAL(1, ap.getRateLimited());
+    TEST_ASSERT_EQUAL(2, writes);
+}
+
+/**
+ * @brief A write that does not fit is dropped whole and retried on the next message
+ */
+void test_autopilot_dropped_write() {
+    resetFakes();
+    AutopilotForward ap(AutopilotSentence::HDM | AutopilotSentence::HDG, "HC");
+    ap.attach(fakeWrite, nullptr, clockNow, clockArrival);
+    uint8_t data[8];
+    heading127250(data, 10000, 0, 0, 1);
+
+    fakeRoom = 20;
+    TEST_ASSERT_FALSE(ap.forward(127250, data, 8));
+    TEST_ASSERT_EQUAL(1, ap.getDropped());
+    TEST_ASSERT_EQUAL(0, writtenLength);
+
+    fakeRoom = 1024;
+    TEST_ASSERT_TRUE(ap.forward(127250, data, 8));   // Not rate limited: nothing was sent
+    TEST_ASSERT_EQUAL(0, ap.getRateLimited());
+    TEST_ASSERT_EQUAL_MEMORY("$HCHDM,57.3,M*", written, 14);
+}
+
+/**
+ * @brief Latency runs from the frame's arrival to the write and is checked against the budget
+ */
+void test_autopilot_latency_counters() {
+    resetFakes();
+    AutopilotForward ap(AutopilotSentence::HDM, "HC");
+    ap.attach(fakeWrite, nullptr, clockNow, clockArrival);
+    uint8_t data[8];
+    heading127250(data, 10000, 0, 0, 1);
+
+    fakeArrivalUs = fakeNowUs - 300;
+    ap.forward(127250, data, 8);
+    TEST_ASSERT_EQUAL(300, ap.getLastUs());
+
+    fakeNowUs += 100000;
+    fakeArrivalUs = fakeNowUs - (AP_FORWARD_LATENCY_BUDGET_US + 500);
+    ap.forward(127250, data, 8);
+    TEST_ASSERT_EQUAL(AP_FORWARD_LATENCY_BUDGET_US + 500, ap.getMaxUs());
+    TEST_ASSERT_EQUAL((300 + AP_FORWARD_LATENCY_BUDGET_US + 500) / 2, ap.getMeanUs());
+    TEST_ASSERT_EQUAL(1, ap.getOverBudget());
+
+    char buffer[256];
+    JsonWriter json(buffer, sizeof(buffer));
+    ap.writeJson(json);
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"sentences\":[\"HDM\"],\"sent\":2"));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"over_budget\":1"));
+}
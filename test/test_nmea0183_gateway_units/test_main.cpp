@@ -0,0 +1,72 @@
+/**
+ * @file test_main.cpp
+ * @brief Unit tests for the NMEA 0183 TCP stream building blocks
+ *
+ * Tests validate:
+ * - NMEA0183SentenceWriter / sentence encoders (field layout, checksum, overflow)
+ * - NMEA0183StreamBuffer (shared ring, independent cursors, wrap, overrun)
+ * - AutopilotForward (sentence templates, NA fields, rate limit, drops, latency)
+ *
+ * Test Organization:
+ * - test_sentence_encoder.cpp: HDG/HDM/RSA/MWV/MWD/DPT/VHW/RMC encoding
+ * - test_stream_buffer.cpp: shared client fan-out ring
+ * - test_autopilot_forward.cpp: N2k heading/rate of turn fast path
+ */
+
+#include <unity.h>
+
+// Forward declarations for sentence encoder tests
+void test_encoder_dpt_with_checksum();
+void test_encoder_hdg_variation_and_empty_fields();
+void test_encoder_mwv_and_vhw_layout();
+void test_encoder_rmc_position_format();
+void test_encoder_hdm_rsa_mwd_layout();
+void test_encoder_overflow_returns_zero();
+
+// Forward declarations for stream buffer tests
+void test_stream_cursors_share_one_copy();
+void test_stream_wraps_in_two_spans();
+void test_stream_lagging_cursor_skips_ahead();
+void test_stream_rejects_oversized_append();
+
+// Forward declarations for autopilot fast path tests
+void test_autopilot_hdm_hdg_match_encoder();
+void test_autopilot_hdt_and_rot_layout();
+void test_autopilot_na_and_unselected();
+void test_autopilot_rate_limit();
+void test_autopilot_dropped_write();
+void test_autopilot_latency_counters();
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    // Sentence encoder
+    RUN_TEST(test_encoder_dpt_with_checksum);
+    RUN_TEST(test_encoder_hdg_variation_and_empty_fields);
+    RUN_TEST(test_encoder_mwv_and_vhw_layout);
+    RUN_TEST(test_encoder_rmc_position_format);
+    RUN_TEST(test_encoder_hdm_rsa_mwd_layout);
+    RUN_TEST(test_encoder_overflow_returns_zero);
+
+    // Stream buffer
+    RUN_TEST(test_stream_cursors_share_one_copy);
+    RUN_TEST(test_stream_wraps_in_two_spans);
+    RUN_TEST(test_stream_lagging_cursor_skips_ahead);
+    RUN_TEST(test_stream_rejects_oversized_append);
+
+    // Autopilot fast path
+    RUN_TEST(test_autopilot_hdm_hdg_match_encoder);
+    RUN_TEST(test_autopilot_hdt_and_rot_layout);
+    RUN_TEST(test_autopilot_na_and_unselected);
+    RUN_TEST(test_autopilot_rate_limit);
+    RUN_TEST(test_autopilot_dropped_write);
+    RUN_TEST(test_autopilot_latency_counters);
+
+    return UNITY_END();
+}
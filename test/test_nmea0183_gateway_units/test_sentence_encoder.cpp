@@ -0,0 +1,94 @@
+/**
+ * @file test_sentence_encoder.cpp
+ * @brief Unit tests for the allocation-free NMEA 0183 sentence encoder
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "../../src/utils/NMEA0183Encoder.h"
+#include "../../src/utils/NMEA0183Encoder.cpp"
+
+/**
+ * @brief Checksum is the XOR between "$" and "*", printed as two hex digits
+ */
+void test_encoder_dpt_with_checksum() {
+    char line[NMEA0183_MAX_SENTENCE_SIZE];
+    size_t len = NMEA0183EncodeDPT(line, sizeof(line), "II", 12.44, 0.0);
+
+    TEST_ASSERT_EQUAL_STRING("$IIDPT,12.4,0.0*77\r\n", line);
+    TEST_ASSERT_EQUAL(strlen(line), len);
+    TEST_ASSERT_EQUAL(0x77, NMEA0183SentenceWriter::checksum("IIDPT,12.4,0.0", 14));
+}
+
+/**
+ * @brief NaN values become empty fields; variation sign selects E/W
+ */
+void test_encoder_hdg_variation_and_empty_fields() {
+    char line[NMEA0183_MAX_SENTENCE_SIZE];
+
+    NMEA0183EncodeHDG(line, sizeof(line), "II", 271.25, -3.5);
+    TEST_ASSERT_EQUAL_STRING_LEN("$IIHDG,271.2,,,3.5,W*", line, 21);
+
+    NMEA0183EncodeHDG(line, sizeof(line), "II", 10.0, NAN);
+    TEST_ASSERT_EQUAL_STRING_LEN("$IIHDG,10.0,,,,*", line, 16);
+}
+
+/**
+ * @brief MWV and VHW field layout
+ */
+void test_encoder_mwv_and_vhw_layout() {
+    char line[NMEA0183_MAX_SENTENCE_SIZE];
+
+    NMEA0183EncodeMWV(line, sizeof(line), "II", 45.0, 'R', 12.3);
+    TEST_ASSERT_EQUAL_STRING_LEN("$IIMWV,45.0,R,12.3,N,A*", line, 23);
+
+    NMEA0183EncodeVHW(line, sizeof(line), "II", NAN, 90.0, 5.0);
+    TEST_ASSERT_EQUAL_STRING_LEN("$IIVHW,,T,90.0,M,5.0,N,9.3,K*", line, 29);
+}
+
+/**
+ * @brief RMC position as ddmm.mmmm / dddmm.mmmm with hemispheres; minutes
+ *        that round to 60 carry into the degrees
+ */
+void test_encoder_rmc_position_format() {
+    char line[NMEA0183_MAX_SENTENCE_SIZE];
+
+    NMEA0183EncodeRMC(line, sizeof(line), "II", 48.1173, -11.516667, 5.5, 84.4, 3.0, true);
+    TEST_ASSERT_EQUAL_STRING_LEN("$IIRMC,,A,4807.0380,N,01131.0000,W,5.5,84.4,,3.0,E,A*", line, 53);
+
+    NMEA0183EncodeRMC(line, sizeof(line), "II", -9.9999999, 0.0, 0.0, 0.0, NAN, false);
+    TEST_ASSERT_EQUAL_STRING_LEN("$IIRMC,,V,1000.0000,S,00000.0000,E,0.0,0.0,,,,N*", line, 48);
+}
+
+/**
+ * @brief HDM, RSA and MWD field layout; an unknown rudder angle is flagged invalid
+ */
+void test_encoder_hdm_rsa_mwd_layout() {
+    char line[NMEA0183_MAX_SENTENCE_SIZE];
+
+    NMEA0183EncodeHDM(line, sizeof(line), "II", 271.25);
+    TEST_ASSERT_EQUAL_STRING_LEN("$IIHDM,271.2,M*", line, 15);
+
+    NMEA0183EncodeRSA(line, sizeof(line), "II", -5.5);
+    TEST_ASSERT_EQUAL_STRING_LEN("$IIRSA,-5.5,A,,V*", line, 17);
+
+    NMEA0183EncodeRSA(line, sizeof(line), "II", NAN);
+    TEST_ASSERT_EQUAL_STRING_LEN("$IIRSA,,V,,V*", line, 13);
+
+    NMEA0183EncodeMWD(line, sizeof(line), "II", NAN, 200.0, 10.0);
+    TEST_ASSERT_EQUAL_STRING_LEN("$IIMWD,,T,200.0,M,10.0,N,5.1,M*", line, 31);
+}
+
+/**
+ * @brief A sentence that does not fit the buffer is rejected, not truncated
+ */
+void test_encoder_overflow_returns_zero() {
+    char line[16];
+    TEST_ASSERT_EQUAL(0, NMEA0183EncodeVHW(line, sizeof(line), "II", 1.0, 2.0, 3.0));
+
+    NMEA0183SentenceWriter w(line, sizeof(line));
+    w.begin("II", "DPT").addField(123456789.0, 3);
+    TEST_ASSERT_TRUE(w.overflowed());
+    TEST_ASSERT_EQUAL(0, w.finish());
+}
@@ -0,0 +1,105 @@
+/**
+ * @file test_stream_buffer.cpp
+ * @brief Unit tests for the shared multi-cursor NMEA 0183 stream ring
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/NMEA0183StreamBuffer.h"
+#include "../../src/utils/NMEA0183StreamBuffer.cpp"
+
+namespace {
+
+/**
+ * @brief Drain everything readable at a cursor into out (as a TCP client would)
+ */
+size_t drain(NMEA0183StreamBuffer& stream, uint32_t& cursor, char* out, size_t size, uint32_t& lost) {
+    size_t total = 0;
+    lost = 0;
+    for (;;) {
+        const char* data;
+        uint32_t skipped;
+        size_t n = stream.peek(cursor, data, skipped);
+        lost += skipped;
+        if (n == 0 || total + n > size) {
+            return total;
+        }
+        memcpy(out + total, data, n);
+        total += n;
+        NMEA0183StreamBuffer::consume(cursor, n);
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Two cursors read the same bytes independently
+ */
+void test_stream_cursors_share_one_copy() {
+    static NMEA0183StreamBuffer stream;
+    uint32_t a = stream.head();
+    uint32_t b = stream.head();
+
+    TEST_ASSERT_TRUE(stream.append("$A*00\r\n", 7));
+    TEST_ASSERT_TRUE(stream.append("$B*00\r\n", 7));
+
+    char out[32];
+    uint32_t lost;
+    TEST_ASSERT_EQUAL(14, drain(stream, a, out, sizeof(out), lost));
+    TEST_ASSERT_EQUAL_STRING_LEN("$A*00\r\n$B*00\r\n", out, 14);
+    TEST_ASSERT_EQUAL(0, drain(stream, a, out, sizeof(out), lost));
+
+    TEST_ASSERT_EQUAL(14, drain(stream, b, out, sizeof(out), lost));
+    TEST_ASSERT_EQUAL(0, lost);
+}
+
+/**
+ * @brief Data crossing the ring end is returned as two spans
+ */
+void test_stream_wraps_in_two_spans() {
+    static NMEA0183StreamBuffer stream;
+    static char filler[NMEA0183StreamBuffer::CAPACITY - 4];
+    memset(filler, 'x', sizeof(filler));
+    TEST_ASSERT_TRUE(stream.append(filler, sizeof(filler)));
+
+    uint32_t cursor = stream.head();
+    TEST_ASSERT_TRUE(stream.append("0123456789", 10));
+
+    const char* data;
+    uint32_t lost;
+    TEST_ASSERT_EQUAL(4, stream.peek(cursor, data, lost));
+    TEST_ASSERT_EQUAL_STRING_LEN("0123", data, 4);
+    NMEA0183StreamBuffer::consume(cursor, 4);
+    TEST_ASSERT_EQUAL(6, stream.peek(cursor, data, lost));
+    TEST_ASSERT_EQUAL_STRING_LEN("456789", data, 6);
+}
+
+/**
+ * @brief A cursor overrun by more than the capacity jumps to the live end
+ */
+void test_stream_lagging_cursor_skips_ahead() {
+    static NMEA0183StreamBuffer stream;
+    uint32_t slow = stream.head();
+
+    static char block[NMEA0183StreamBuffer::CAPACITY / 2];
+    memset(block, 'y', sizeof(block));
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT_TRUE(stream.append(block, sizeof(block)));
+    }
+
+    const char* data;
+    uint32_t lost;
+    TEST_ASSERT_EQUAL(0, stream.peek(slow, data, lost));
+    TEST_ASSERT_EQUAL(3 * sizeof(block), lost);
+    TEST_ASSERT_EQUAL(stream.head(), slow);
+}
+
+/**
+ * @brief Oversized appends are rejected whole
+ */
+void test_stream_rejects_oversized_append() {
+    static NMEA0183StreamBuffer stream;
+    static char big[NMEA0183StreamBuffer::CAPACITY + 1];
+    TEST_ASSERT_FALSE(stream.append(big, sizeof(big)));
+    TEST_ASSERT_EQUAL(0, stream.head());
+}
@@ -0,0 +1,53 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string>
+#include "components/NMEA0183Handler.h"
+#include "components/BoatData.h"
+#include "mocks/MockSerialPort.h"
+#include "mocks/MockDisplayAdapter.h"
+#include "mocks/MockSystemMetrics.h"
+#include "utils/WebSocketLogger.h"
+#include "helpers/nmea0183_test_fixtures.h"
+
+// Integration Test - RMC/GGA/VTG of one fix published as one GPS update
+void test_gps_fix_fusion() {
+    // Setup
+    MockSerialPort mockSerial;
+    MockDisplayAdapter mockDisplay;
+    MockSystemMetrics mockMetrics;
+    WebSocketLogger logger(&mockDisplay, &mockMetrics);
+    BoatData boatData;
+    NMEA0183Handler handler(&mockSerial, &boatData, &logger);
+
+    // First fix (123519): the sentence set is learned, GGA must not zero RMC's COG/SOG
+    std::string burst = std::string(VALID_VHRMC) + VALID_VHGGA + VALID_VHVTG;
+    mockSerial.setMockData(burst.c_str());
+    handler.processSentences();
+
+    GPSData gpsData = boatData.getGPSData();
+    TEST_ASSERT_TRUE(gpsData.available);
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, 52.508333, gpsData.latitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 0.9548, gpsData.cog);
+    TEST_ASSERT_FLOAT_WITHIN(0.1, 5.5, gpsData.sog);
+
+    // Second fix (123520): three sentences, one update
+    NMEA0183PortStats stats;
+    TEST_ASSERT_TRUE(handler.getPortStats(0, stats));
+    uint32_t fixesBefore = stats.gpsFixes;
+
+    burst = std::string("$VHRMC,123520,A,5230.5000,N,00507.0000,E,5.5,054.7,230394,003.1,W*62\r\n") +
+            "$VHGGA,123520,5230.5000,N,00507.0000,E,1,08,0.9,545.4,M,46.9,M,,*45\r\n" +
+            VALID_VHVTG;
+    mockSerial.setMockData(burst.c_str());
+    handler.processSentences();
+
+    TEST_ASSERT_TRUE(handler.getPortStats(0, stats));
+    TEST_ASSERT_EQUAL_UINT32(6, stats.gpsSentences);
+    TEST_ASSERT_EQUAL_UINT32(fixesBefore + 1, stats.gpsFixes);
+
+    // Next epoch's RMC alone: held until its GGA/VTG arrive (or the fusion timeout)
+    mockSerial.setMockData("$VHRMC,123521,A,5230.5000,N,00507.0000,E,5.5,054.7,230394,003.1,W*63\r\n");
+    handler.processSentences();
+    TEST_ASSERT_TRUE(handler.getPortStats(0, stats));
+    TEST_ASSERT_EQUAL_UINT32(fixesBefore + 1, stats.gpsFixes);
+}
@@ -1,6 +1,5 @@
 #include <unity.h>
 #antml:parameter name="Arduino.h">
-#include <NMEA0183.h>
 #include "components/NMEA0183Handler.h"
 #include "components/BoatData.h"
 #include "mocks/MockSerialPort.h"
@@ -13,12 +12,11 @@
 void test_hdm_to_boatdata() {
     // Setup
     MockSerialPort mockSerial;
-    tNMEA0183 nmea0183;
     MockDisplayAdapter mockDisplay;
     MockSystemMetrics mockMetrics;
     WebSocketLogger logger(&mockDisplay, &mockMetrics);
     BoatData boatData;
-    NMEA0183Handler handler(&nmea0183, &mockSerial, &boatData, &logger);
+    NMEA0183Handler handler(&mockSerial, &boatData, &logger);
 
     // Load valid HDM sentence
     mockSerial.setMockData(VALID_APHDM);
@@ -1,6 +1,5 @@
 #include <unity.h>
 #include <Arduino.h>
-#include <NMEA0183.h>
 #include "components/NMEA0183Handler.h"
 #include "components/BoatData.h"
 #include "mocks/MockSerialPort.h"
@@ -13,12 +12,11 @@
 void test_invalid_sentences() {
     // Setup
     MockSerialPort mockSerial;
-    tNMEA0183 nmea0183;
     MockDisplayAdapter mockDisplay;
     MockSystemMetrics mockMetrics;
     WebSocketLogger logger(&mockDisplay, &mockMetrics);
     BoatData boatData;
-    NMEA0183Handler handler(&nmea0183, &mockSerial, &boatData, &logger);
+    NMEA0183Handler handler(&mockSerial, &boatData, &logger);
 
     // Test 1: Bad checksum - silent discard (FR-024)
     mockSerial.setMockData(INVALID_APRSA_CHECKSUM);
@@ -47,4 +45,18 @@ void test_invalid_sentences() {
     TEST_ASSERT_FALSE(boatData.getRudderData().available);
 
     // All invalid sentences should be silently discarded with no error logs (FR-024/FR-025)
+
+    // ...but counted per sentence type and talker (GET /nmea0183/stats)
+    const NMEA0183SentenceStatsEntry* rsa =
+        handler.getSentenceStats().find(NMEA0183PackCode("RSA"), NMEA0183PackTalker("AP"));
+    TEST_ASSERT_NOT_NULL(rsa);
+    TEST_ASSERT_EQUAL_UINT32(1, rsa->checksumFailed);
+    TEST_ASSERT_EQUAL_UINT32(1, rsa->rangeRejected);
+    TEST_ASSERT_EQUAL_UINT32(2, rsa->parseFailed);
+    TEST_ASSERT_EQUAL_UINT32(0, rsa->accepted);
+
+    const NMEA0183SentenceStatsEntry* vtg =
+        handler.getSentenceStats().find(NMEA0183PackCode("VTG"), NMEA0183PackTalker("VH"));
+    TEST_ASSERT_NOT_NULL(vtg);
+    TEST_ASSERT_EQUAL_UINT32(1, vtg->rangeRejected);
 }
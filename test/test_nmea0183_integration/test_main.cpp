@@ -10,6 +10,10 @@ void test_multi_source_priority();
 void test_talker_id_filter();
 void test_message_type_filter();
 void test_invalid_sentences();
+void test_multi_port_input();
+void test_pumped_sentences();
+void test_gps_fix_fusion();
+void test_talker_routing();
 
 void setUp() {
     // Set up before each test
@@ -32,6 +36,10 @@ int main(int argc, char** argv) {
     RUN_TEST(test_talker_id_filter);
     RUN_TEST(test_message_type_filter);
     RUN_TEST(test_invalid_sentences);
+    RUN_TEST(test_multi_port_input);
+    RUN_TEST(test_pumped_sentences);
+    RUN_TEST(test_gps_fix_fusion);
+    RUN_TEST(test_talker_routing);
 
     return UNITY_END();
 }
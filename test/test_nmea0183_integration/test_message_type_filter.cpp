@@ -1,6 +1,5 @@
 #include <unity.h>
 #include <Arduino.h>
-#include <NMEA0183.h>
 #include "components/NMEA0183Handler.h"
 #include "components/BoatData.h"
 #include "mocks/MockSerialPort.h"
@@ -13,12 +12,11 @@
 void test_message_type_filter() {
     // Setup
     MockSerialPort mockSerial;
-    tNMEA0183 nmea0183;
     MockDisplayAdapter mockDisplay;
     MockSystemMetrics mockMetrics;
     WebSocketLogger logger(&mockDisplay, &mockMetrics);
     BoatData boatData;
-    NMEA0183Handler handler(&nmea0183, &mockSerial, &boatData, &logger);
+    NMEA0183Handler handler(&mockSerial, &boatData, &logger);
 
     // Test: MWV sentence (wind data, not supported) should be ignored
     mockSerial.setMockData(UNSUPPORTED_APMWV);
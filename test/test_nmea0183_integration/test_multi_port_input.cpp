@@ -0,0 +1,90 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+#include "components/NMEA0183Handler.h"
+#include "components/BoatData.h"
+#include "components/SourcePrioritizer.h"
+#include "mocks/MockSerialPort.h"
+#include "mocks/MockDisplayAdapter.h"
+#include "mocks/MockSystemMetrics.h"
+#include "utils/WebSocketLogger.h"
+#include "helpers/nmea0183_test_fixtures.h"
+
+// Integration Test - Second input port with its own talker whitelist and source prefix
+void test_multi_port_input() {
+    // Setup
+    MockSerialPort serial2;
+    MockSerialPort serial1;
+    MockDisplayAdapter mockDisplay;
+    MockSystemMetrics mockMetrics;
+    WebSocketLogger logger(&mockDisplay, &mockMetrics);
+    SourcePrioritizer prioritizer;
+    BoatData boatData(&prioritizer);
+    NMEA0183Handler handler(&serial2, &boatData, &logger);
+
+    NMEA0183PortConfig gps = {&serial1, 4800, "Serial1", "N0183-P2",
+                              {{NMEA0183PackTalker("GP")}}};
+    TEST_ASSERT_TRUE(handler.addPort(gps));
+    NMEA0183PortConfig missing = {nullptr, 4800, "Serial1", "N0183-P3", {{0, 0}}};
+    TEST_ASSERT_FALSE(handler.addPort(missing));
+    TEST_ASSERT_EQUAL_UINT8(2, handler.getPortCount());
+
+    // Test: "GP" talker rejected on Serial2 (default VH), accepted on the whitelisted port
+    serial2.setMockData(INVALID_GGA_TALKER);
+    serial1.setMockData(INVALID_GGA_TALKER);
+    handler.processSentences();
+    TEST_ASSERT_TRUE(boatData.getGPSData().available);
+
+    NMEA0183PortStats stats;
+    TEST_ASSERT_TRUE(handler.getPortStats(0, stats));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.sentences);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.wrongTalker);
+    TEST_ASSERT_TRUE(handler.getPortStats(1, stats));
+    TEST_ASSERT_EQUAL_UINT32(strlen(INVALID_GGA_TALKER), stats.bytes);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.sentences);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.wrongTalker);
+    TEST_ASSERT_FALSE(handler.getPortStats(2, stats));
+
+    // Test: the accepted sentence is registered as the port's own GPS source
+    SensorSource source = prioritizer.getSource(0);
+    TEST_ASSERT_EQUAL_STRING("N0183-P2-GP", source.sourceId);
+    TEST_ASSERT_EQUAL(SensorType::GPS, source.sensorType);
+
+    // Test: a whitelisted port rejects talkers outside its whitelist
+    serial1.setMockData(VALID_VHGGA);
+    handler.processSentences();
+    TEST_ASSERT_TRUE(handler.getPortStats(1, stats));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.wrongTalker);
+
+    // Test: Serial2 keeps the default "NMEA0183-VH" source
+    serial2.setMockData(VALID_VHGGA);
+    handler.processSentences();
+    TEST_ASSERT_EQUAL_STRING("NMEA0183-VH", prioritizer.getSource(1).sourceId);
+}
+
+// Integration Test - Bounded draining for the I/O pump (pumpSentences)
+void test_pumped_sentences() {
+    MockSerialPort serial2;
+    MockDisplayAdapter mockDisplay;
+    MockSystemMetrics mockMetrics;
+    WebSocketLogger logger(&mockDisplay, &mockMetrics);
+    SourcePrioritizer prioritizer;
+    BoatData boatData(&prioritizer);
+    NMEA0183Handler handler(&serial2, &boatData, &logger);
+
+    static char burst[64];
+    snprintf(burst, sizeof(burst), "%s%s%s", VALID_APRSA, VALID_APRSA, VALID_APRSA);
+    serial2.setMockData(burst);
+
+    // Test: two lines per step, the third waits for the next step
+    NMEA0183PortStats stats;
+    TEST_ASSERT_TRUE(handler.pumpSentences(2));
+    TEST_ASSERT_TRUE(handler.getPortStats(0, stats));
+    TEST_ASSERT_EQUAL_UINT32(2, stats.sentences);
+
+    TEST_ASSERT_FALSE(handler.pumpSentences(2));
+    TEST_ASSERT_TRUE(handler.getPortStats(0, stats));
+    TEST_ASSERT_EQUAL_UINT32(3, stats.sentences);
+    TEST_ASSERT_FALSE(handler.pumpSentences(2));
+}
@@ -1,6 +1,5 @@
 #include <unity.h>
 #include <Arduino.h>
-#include <NMEA0183.h>
 #include "components/NMEA0183Handler.h"
 #include "components/BoatData.h"
 #include "mocks/MockSerialPort.h"
@@ -13,12 +12,11 @@
 void test_multi_source_priority() {
     // Setup
     MockSerialPort mockSerial;
-    tNMEA0183 nmea0183;
     MockDisplayAdapter mockDisplay;
     MockSystemMetrics mockMetrics;
     WebSocketLogger logger(&mockDisplay, &mockMetrics);
     BoatData boatData;
-    NMEA0183Handler handler(&nmea0183, &mockSerial, &boatData, &logger);
+    NMEA0183Handler handler(&mockSerial, &boatData, &logger);
 
     // Register higher-priority NMEA 2000 GPS source (10 Hz)
     boatData.updateGPS(50.0, 4.0, 0.0, 0.0, "NMEA2000-GPS");
@@ -0,0 +1,58 @@
+#include <unity.h>
+#include <Arduino.h>
+#include <string>
+#include "components/NMEA0183Handler.h"
+#include "components/BoatData.h"
+#include "components/SourcePrioritizer.h"
+#include "mocks/MockSerialPort.h"
+#include "mocks/MockDisplayAdapter.h"
+#include "mocks/MockSystemMetrics.h"
+#include "utils/WebSocketLogger.h"
+#include "helpers/nmea0183_test_fixtures.h"
+
+// Integration Test - Route table replaces the built-in talkers on a port
+void test_talker_routing() {
+    // Setup
+    MockSerialPort mockSerial;
+    MockDisplayAdapter mockDisplay;
+    MockSystemMetrics mockMetrics;
+    WebSocketLogger logger(&mockDisplay, &mockMetrics);
+    SourcePrioritizer prioritizer;
+    BoatData boatData(&prioritizer);
+    NMEA0183Handler handler(&mockSerial, &boatData, &logger);
+
+    // GP GGA (not a built-in talker) with its own source, AP HDM disabled, VH VTG at 1 Hz
+    NMEA0183RouteTable routes;
+    routes.add(0, NMEA0183PackCode("GGA"), NMEA0183PackTalker("GP"), "GPS-MAST", true, 0.0f);
+    routes.add(0, NMEA0183PackCode("HDM"), NMEA0183PackTalker("AP"), "", false, 0.0f);
+    routes.add(0, NMEA0183PackCode("VTG"), NMEA0183PackTalker("VH"), "", true, 1.0f);
+    routes.finalize();
+    handler.setRoutes(routes);
+
+    // Test: routed talker accepted and registered under the route's source ID
+    mockSerial.setMockData(INVALID_GGA_TALKER);
+    handler.processSentences();
+    TEST_ASSERT_TRUE(boatData.getGPSData().available);
+    TEST_ASSERT_EQUAL_STRING("GPS-MAST", prioritizer.getSource(0).sourceId);
+
+    // Test: disabled and unrouted sentences are discarded before tokenizing
+    std::string lines = std::string(VALID_APHDM) + VALID_APRSA + VALID_VHGGA;
+    mockSerial.setMockData(lines.c_str());
+    handler.processSentences();
+    TEST_ASSERT_FALSE(boatData.getCompassData().available);
+    TEST_ASSERT_FALSE(boatData.getRudderData().available);
+
+    NMEA0183PortStats stats;
+    TEST_ASSERT_TRUE(handler.getPortStats(0, stats));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.sentences);   // Only the routed GGA was tokenized
+    TEST_ASSERT_EQUAL_UINT32(3, stats.unrouted);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.wrongTalker);
+
+    // Test: second VTG within one second is rate limited
+    lines = std::string(VALID_VHVTG) + VALID_VHVTG;
+    mockSerial.setMockData(lines.c_str());
+    handler.processSentences();
+    TEST_ASSERT_TRUE(handler.getPortStats(0, stats));
+    TEST_ASSERT_EQUAL_UINT32(2, stats.sentences);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.rateLimited);
+}
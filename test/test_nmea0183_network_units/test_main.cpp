@@ -0,0 +1,37 @@
+/**
+ * @file test_main.cpp
+ * @brief Unit tests for the NMEA 0183 network input sentence queue
+ *
+ * Tests validate:
+ * - NMEA0183SentenceQueue (datagram/stream splitting into whole sentences)
+ * - Bounded queue behaviour (drop counter, oversized lines)
+ *
+ * Test Organization:
+ * - test_sentence_queue.cpp: UDP datagrams, TCP segments, overflow
+ */
+
+#include <unity.h>
+
+// Forward declarations for sentence queue tests
+void test_datagram_with_several_sentences();
+void test_stream_sentence_split_across_segments();
+void test_full_queue_drops_whole_sentences();
+void test_oversized_line_discarded();
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    // NMEA0183SentenceQueue tests
+    RUN_TEST(test_datagram_with_several_sentences);
+    RUN_TEST(test_stream_sentence_split_across_segments);
+    RUN_TEST(test_full_queue_drops_whole_sentences);
+    RUN_TEST(test_oversized_line_discarded);
+
+    return UNITY_END();
+}
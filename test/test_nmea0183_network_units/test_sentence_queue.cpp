@@ -0,0 +1,88 @@
+/**
+ * @file test_sentence_queue.cpp
+ * @brief Unit tests for NMEA0183SentenceQueue (network task → main loop)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/NMEA0183SentenceQueue.h"
+
+namespace {
+
+void assertPop(NMEA0183SentenceQueue<4>& queue, const char* expected) {
+    char line[NMEA0183_MAX_LINE];
+    size_t length = queue.pop(line, sizeof(line));
+    TEST_ASSERT_EQUAL(strlen(expected), length);
+    TEST_ASSERT_EQUAL_INT(0, strncmp(expected, line, length));
+}
+
+}  // namespace
+
+/**
+ * @brief One datagram carries two sentences; the last one has no CR/LF
+ */
+void test_datagram_with_several_sentences() {
+    NMEA0183SentenceQueue<4> queue;
+    const char* datagram = "$APHDM,045.5,M*37\r\n$APRSA,15.0,A,,*0A";
+    queue.feedDatagram(datagram, strlen(datagram));
+
+    TEST_ASSERT_EQUAL_UINT32(2, queue.size());
+    TEST_ASSERT_EQUAL_UINT32(2, queue.getSentenceCount());
+    assertPop(queue, "$APHDM,045.5,M*37");
+    assertPop(queue, "$APRSA,15.0,A,,*0A");
+
+    char line[NMEA0183_MAX_LINE];
+    TEST_ASSERT_EQUAL(0, queue.pop(line, sizeof(line)));
+}
+
+/**
+ * @brief TCP: a sentence split over two segments is queued once, whole
+ */
+void test_stream_sentence_split_across_segments() {
+    NMEA0183SentenceQueue<4> queue;
+    queue.feed("garbage\r\n$APHD", 14);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.size());
+
+    queue.feed("M,045.5,M*37\r\n", 14);
+    TEST_ASSERT_EQUAL_UINT32(1, queue.size());
+    assertPop(queue, "$APHDM,045.5,M*37");
+
+    // A reconnect forgets the partial line of the old connection
+    queue.feed("$APHD", 5);
+    queue.resetPartial();
+    queue.feed("M,045.5,M*37\r\n", 14);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.size());
+}
+
+/**
+ * @brief A full queue drops new sentences and counts them
+ */
+void test_full_queue_drops_whole_sentences() {
+    NMEA0183SentenceQueue<4> queue;
+    const char* sentence = "$APHDM,045.5,M*37\r\n";
+    for (int i = 0; i < 6; i++) {
+        queue.feedDatagram(sentence, strlen(sentence));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(4, queue.size());
+    TEST_ASSERT_EQUAL_UINT32(4, queue.getSentenceCount());
+    TEST_ASSERT_EQUAL_UINT32(2, queue.getDroppedCount());
+    TEST_ASSERT_EQUAL_UINT32(4, queue.getHighWater());
+    assertPop(queue, "$APHDM,045.5,M*37");
+}
+
+/**
+ * @brief Lines longer than NMEA0183_MAX_LINE are discarded, the next line is kept
+ */
+void test_oversized_line_discarded() {
+    NMEA0183SentenceQueue<4> queue;
+    char longLine[NMEA0183_MAX_LINE + 20];
+    memset(longLine, 'A', sizeof(longLine));
+    longLine[0] = '$';
+    queue.feed(longLine, sizeof(longLine));
+    queue.feed("\r\n$APHDM,045.5,M*37\r\n", 21);
+
+    TEST_ASSERT_EQUAL_UINT32(1, queue.getOversizedCount());
+    TEST_ASSERT_EQUAL_UINT32(1, queue.size());
+    assertPop(queue, "$APHDM,045.5,M*37");
+}
@@ -0,0 +1,106 @@
+/**
+ * @file test_field_parsers.cpp
+ * @brief Unit tests for the fixed-point NMEA 0183 field parsers
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/NMEA0183Tokenizer.h"
+
+namespace {
+
+NMEA0183Field view(const char* text) {
+    NMEA0183Field field = {text, static_cast<uint8_t>(strlen(text))};
+    return field;
+}
+
+}  // namespace
+
+/**
+ * @brief Plain decimals parse; anything else is rejected (atof would return 0)
+ */
+void test_field_to_double() {
+    double value = 0.0;
+
+    TEST_ASSERT_TRUE(NMEA0183FieldToDouble(view("045.5"), value));
+    TEST_ASSERT_EQUAL_DOUBLE(45.5, value);
+    TEST_ASSERT_TRUE(NMEA0183FieldToDouble(view("-12.25"), value));
+    TEST_ASSERT_EQUAL_DOUBLE(-12.25, value);
+    TEST_ASSERT_TRUE(NMEA0183FieldToDouble(view("+3"), value));
+    TEST_ASSERT_EQUAL_DOUBLE(3.0, value);
+    TEST_ASSERT_TRUE(NMEA0183FieldToDouble(view(".5"), value));
+    TEST_ASSERT_EQUAL_DOUBLE(0.5, value);
+    TEST_ASSERT_TRUE(NMEA0183FieldToDouble(view("7."), value));
+    TEST_ASSERT_EQUAL_DOUBLE(7.0, value);
+
+    // Fraction digits beyond nine are ignored
+    TEST_ASSERT_TRUE(NMEA0183FieldToDouble(view("1.1234567891"), value));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1.123456789, value);
+
+    value = 99.0;
+    TEST_ASSERT_FALSE(NMEA0183FieldToDouble(view(""), value));
+    TEST_ASSERT_FALSE(NMEA0183FieldToDouble(view("INVALID"), value));
+    TEST_ASSERT_FALSE(NMEA0183FieldToDouble(view("12a"), value));
+    TEST_ASSERT_FALSE(NMEA0183FieldToDouble(view("1.2.3"), value));
+    TEST_ASSERT_FALSE(NMEA0183FieldToDouble(view("-"), value));
+    TEST_ASSERT_FALSE(NMEA0183FieldToDouble(view("1e3"), value));
+    TEST_ASSERT_FALSE(NMEA0183FieldToDouble(view("123456789012345678901"), value));
+    TEST_ASSERT_EQUAL_DOUBLE(99.0, value);  // Unchanged on failure
+}
+
+/**
+ * @brief Integer fields reject fractions
+ */
+void test_field_to_int() {
+    int32_t value = 0;
+
+    TEST_ASSERT_TRUE(NMEA0183FieldToInt(view("08"), value));
+    TEST_ASSERT_EQUAL_INT32(8, value);
+    TEST_ASSERT_TRUE(NMEA0183FieldToInt(view("-2"), value));
+    TEST_ASSERT_EQUAL_INT32(-2, value);
+
+    TEST_ASSERT_FALSE(NMEA0183FieldToInt(view("1.0"), value));
+    TEST_ASSERT_FALSE(NMEA0183FieldToInt(view(""), value));
+    TEST_ASSERT_FALSE(NMEA0183FieldToInt(view("3000000000"), value));
+}
+
+/**
+ * @brief ddmm.mmmm + hemisphere → signed decimal degrees
+ */
+void test_field_to_coordinate() {
+    double degrees = 0.0;
+
+    TEST_ASSERT_TRUE(NMEA0183FieldToCoordinate(view("5230.5000"), view("N"), degrees));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 52.508333, degrees);
+    TEST_ASSERT_TRUE(NMEA0183FieldToCoordinate(view("00507.0000"), view("W"), degrees));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, -5.116667, degrees);
+    TEST_ASSERT_TRUE(NMEA0183FieldToCoordinate(view("3352.128"), view("S"), degrees));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, -33.8688, degrees);
+    TEST_ASSERT_TRUE(NMEA0183FieldToCoordinate(view("17959.99"), view("E"), degrees));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 179.999833, degrees);
+
+    TEST_ASSERT_FALSE(NMEA0183FieldToCoordinate(view("5260.0000"), view("N"), degrees));  // 60'
+    TEST_ASSERT_FALSE(NMEA0183FieldToCoordinate(view("5230.5000"), view("X"), degrees));
+    TEST_ASSERT_FALSE(NMEA0183FieldToCoordinate(view("5230.5000"), view(""), degrees));
+    TEST_ASSERT_FALSE(NMEA0183FieldToCoordinate(view(""), view("N"), degrees));
+    TEST_ASSERT_FALSE(NMEA0183FieldToCoordinate(view("-5230.5"), view("N"), degrees));
+}
+
+/**
+ * @brief hhmmss(.ss) → hundredths of a second since midnight
+ */
+void test_field_to_time() {
+    uint32_t time = 0;
+
+    TEST_ASSERT_TRUE(NMEA0183FieldToTime(view("123519"), time));
+    TEST_ASSERT_EQUAL_UINT32(((12 * 60 + 35) * 60 + 19) * 100, time);
+    TEST_ASSERT_TRUE(NMEA0183FieldToTime(view("000001.5"), time));
+    TEST_ASSERT_EQUAL_UINT32(150, time);
+    TEST_ASSERT_TRUE(NMEA0183FieldToTime(view("235959.987"), time));
+    TEST_ASSERT_EQUAL_UINT32(8639998, time);
+
+    TEST_ASSERT_FALSE(NMEA0183FieldToTime(view(""), time));
+    TEST_ASSERT_FALSE(NMEA0183FieldToTime(view("246000"), time));
+    TEST_ASSERT_FALSE(NMEA0183FieldToTime(view("126100"), time));
+    TEST_ASSERT_FALSE(NMEA0183FieldToTime(view("-123519"), time));
+}
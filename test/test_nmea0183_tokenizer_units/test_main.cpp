@@ -0,0 +1,50 @@
+/**
+ * @file test_main.cpp
+ * @brief Unit tests for the zero-copy NMEA 0183 tokenizer
+ *
+ * Tests validate:
+ * - NMEA0183Tokens (single-pass checksum validation, field offsets, address keys)
+ * - Fixed-point field parsers (decimal, integer, ddmm.mmmm coordinates, UTC time)
+ *
+ * Test Organization:
+ * - test_tokens.cpp: sentence framing, checksum and field views
+ * - test_field_parsers.cpp: numeric field conversion without atof()
+ */
+
+#include <unity.h>
+
+// Forward declarations for tokenizer tests
+void test_tokens_valid_sentence_fields();
+void test_tokens_rejects_bad_checksum_and_framing();
+void test_tokens_empty_and_missing_fields();
+void test_tokens_field_limit();
+
+// Forward declarations for field parser tests
+void test_field_to_double();
+void test_field_to_int();
+void test_field_to_coordinate();
+void test_field_to_time();
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    // NMEA0183Tokens tests
+    RUN_TEST(test_tokens_valid_sentence_fields);
+    RUN_TEST(test_tokens_rejects_bad_checksum_and_framing);
+    RUN_TEST(test_tokens_empty_and_missing_fields);
+    RUN_TEST(test_tokens_field_limit);
+
+    // Fixed-point field parser tests
+    RUN_TEST(test_field_to_double);
+    RUN_TEST(test_field_to_int);
+    RUN_TEST(test_field_to_coordinate);
+    RUN_TEST(test_field_to_time);
+
+    return UNITY_END();
+}
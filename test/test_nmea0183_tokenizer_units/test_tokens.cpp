@@ -0,0 +1,125 @@
+/**
+ * @file test_tokens.cpp
+ * @brief Unit tests for NMEA0183Tokens (framing, checksum, field views)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/NMEA0183Tokenizer.h"
+#include "../../src/utils/NMEA0183Tokenizer.cpp"
+#include "../../src/utils/NMEA0183SentenceKey.h"
+
+namespace {
+
+bool tokenize(NMEA0183Tokens& tokens, const char* line) {
+    return tokens.tokenize(line, strlen(line));
+}
+
+void assertField(const char* expected, const NMEA0183Field& field) {
+    TEST_ASSERT_EQUAL(strlen(expected), field.len);
+    TEST_ASSERT_EQUAL_INT(0, strncmp(expected, field.data, field.len));
+}
+
+}  // namespace
+
+/**
+ * @brief RMC is split in place; address packs like NMEA0183Pack*
+ */
+void test_tokens_valid_sentence_fields() {
+    const char* rmc = "$VHRMC,123519,A,5230.5000,N,00507.0000,E,5.5,054.7,230394,003.1,W*68\r\n";
+    NMEA0183Tokens tokens;
+
+    TEST_ASSERT_TRUE(tokenize(tokens, rmc));
+    TEST_ASSERT_EQUAL_UINT16(NMEA0183PackTalker("VH"), tokens.talker());
+    TEST_ASSERT_EQUAL_UINT32(NMEA0183PackCode("RMC"), tokens.code());
+    assertField("VHRMC", tokens.address());
+    TEST_ASSERT_EQUAL_UINT8(11, tokens.fieldCount());
+    assertField("123519", tokens.field(0));
+    assertField("5230.5000", tokens.field(2));
+    assertField("W", tokens.field(10));
+
+    // Views point into the caller's buffer (no copy)
+    TEST_ASSERT_TRUE(tokens.field(0).data == rmc + 7);
+
+    // Lowercase checksum digits and a missing line end are accepted
+    TEST_ASSERT_TRUE(tokenize(tokens, "$APHDM,045.5,M*37"));
+    TEST_ASSERT_TRUE(tokenize(tokens, "$VHRMC,123519,A,5230.5000,N,00507.0000,E,5.5,054.7,230394,003.1,W*68"));
+    TEST_ASSERT_TRUE(tokenize(tokens, "$APHDM,045.5,M*37\n"));
+    TEST_ASSERT_TRUE(tokenize(tokens, "!AIVDM,1,1,,A,13aG?P0P00PD;88MD5MTDww@2<0L,0*71"));
+}
+
+/**
+ * @brief Bad checksum, missing checksum and bad framing are rejected
+ */
+void test_tokens_rejects_bad_checksum_and_framing() {
+    NMEA0183Tokens tokens;
+
+    TEST_ASSERT_FALSE(tokenize(tokens, "$APRSA,15.0,A*FF\r\n"));   // Wrong checksum
+    TEST_ASSERT_FALSE(tokenize(tokens, "$APRSA,15.0,A\r\n"));      // No checksum
+    TEST_ASSERT_FALSE(tokenize(tokens, "$APRSA,15.0,A*0\r\n"));    // One digit
+    TEST_ASSERT_FALSE(tokenize(tokens, "$APRSA,15.0,A*0AX\r\n"));  // Trailing garbage
+    TEST_ASSERT_FALSE(tokenize(tokens, "$APRSA,15.0,A*0G\r\n"));   // Not hex
+    TEST_ASSERT_FALSE(tokenize(tokens, "APRSA,15.0,A*0A\r\n"));    // No '$'
+    TEST_ASSERT_FALSE(tokens.tokenize(nullptr, 10));
+    TEST_ASSERT_EQUAL_UINT8(0, tokens.fieldCount());
+    TEST_ASSERT_EQUAL_UINT32(0, tokens.code());
+
+    // Longer than NMEA0183_MAX_LINE
+    char longLine[NMEA0183_MAX_LINE + 16];
+    memset(longLine, '1', sizeof(longLine));
+    longLine[0] = '$';
+    TEST_ASSERT_FALSE(tokens.tokenize(longLine, sizeof(longLine)));
+}
+
+/**
+ * @brief Empty fields are empty views; fields past the end read as empty
+ */
+void test_tokens_empty_and_missing_fields() {
+    NMEA0183Tokens tokens;
+    TEST_ASSERT_TRUE(tokenize(tokens,
+        "$VHGGA,123519,5230.5000,N,00507.0000,E,1,08,0.9,545.4,M,46.9,M,,*4F\r\n"));
+
+    TEST_ASSERT_EQUAL_UINT8(14, tokens.fieldCount());
+    TEST_ASSERT_TRUE(tokens.field(12).empty());
+    TEST_ASSERT_TRUE(tokens.field(13).empty());
+    TEST_ASSERT_TRUE(tokens.field(14).empty());
+    TEST_ASSERT_TRUE(tokens.field(200).empty());
+    TEST_ASSERT_TRUE(tokens.field(2).is('N'));
+    TEST_ASSERT_FALSE(tokens.field(1).is('5'));
+
+    // Non-standard address: tokenized, but never matches a dispatch code
+    TEST_ASSERT_TRUE(tokenize(tokens, "$PGRME,15.0,M*1A"));
+    TEST_ASSERT_EQUAL_UINT32(0, tokens.code());
+    TEST_ASSERT_EQUAL_UINT16(0, tokens.talker());
+}
+
+/**
+ * @brief Fields beyond NMEA0183_MAX_FIELDS are ignored, checksum still checked
+ */
+void test_tokens_field_limit() {
+    char line[NMEA0183_MAX_LINE];
+    size_t pos = 0;
+    const char* head = "$IIXDR";
+    memcpy(line, head, strlen(head));
+    pos = strlen(head);
+    for (int i = 0; i < NMEA0183_MAX_FIELDS + 6; i++) {
+        line[pos++] = ',';
+        line[pos++] = static_cast<char>('A' + (i % 26));
+    }
+    uint8_t checksum = 0;
+    for (size_t i = 1; i < pos; i++) {
+        checksum ^= static_cast<uint8_t>(line[i]);
+    }
+    line[pos++] = '*';
+    line[pos++] = "0123456789ABCDEF"[checksum >> 4];
+    line[pos++] = "0123456789ABCDEF"[checksum & 0x0F];
+
+    NMEA0183Tokens tokens;
+    TEST_ASSERT_TRUE(tokens.tokenize(line, pos));
+    TEST_ASSERT_EQUAL_UINT8(NMEA0183_MAX_FIELDS, tokens.fieldCount());
+    assertField("A", tokens.field(0));
+    assertField("X", tokens.field(NMEA0183_MAX_FIELDS - 1));
+
+    line[pos - 1] = line[pos - 1] == '0' ? '1' : '0';
+    TEST_ASSERT_FALSE(tokens.tokenize(line, pos));
+}
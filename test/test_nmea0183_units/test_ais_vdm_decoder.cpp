@@ -0,0 +1,87 @@
+/**
+ * @file test_ais_vdm_decoder.cpp
+ * @brief Unit tests for the !AIVDM position report decoder (AisVdmDecoder)
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "../../src/utils/AisVdmDecoder.h"
+#include "../../src/utils/AisVdmDecoder.cpp"
+
+namespace {
+
+const double DEG = 0.017453292519943295;
+
+AisDecodeResult decode(const char* payload, uint8_t fillBits, AisPositionReport& out) {
+    return AisDecodePositionReport(payload, strlen(payload), fillBits, out);
+}
+
+}  // namespace
+
+/**
+ * @test Class A report (type 1): MMSI, status, position, SOG, COG and heading
+ */
+void test_ais_decode_class_a_position(void) {
+    AisPositionReport report;
+    memset(&report, 0, sizeof(report));
+    report.receivedMs = 1234;
+
+    // !AIVDM,1,1,,B,15RTgt0PAso;90TKcjM8h6g208CQ,0*4A
+    TEST_ASSERT_EQUAL(AisDecodeResult::OK, decode("15RTgt0PAso;90TKcjM8h6g208CQ", 0, report));
+    TEST_ASSERT_EQUAL_UINT32(371798000u, report.mmsi);
+    TEST_ASSERT_EQUAL_UINT8(AIS_CLASS_A, report.aisClass);
+    TEST_ASSERT_EQUAL_UINT8(0, report.navStatus);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-5, 48.381633, report.latitude);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-5, -123.395383, report.longitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 12.3f, report.sog);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, static_cast<float>(224.0 * DEG), report.cog);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, static_cast<float>(215.0 * DEG), report.heading);
+    TEST_ASSERT_EQUAL_UINT32(1234u, report.receivedMs);  // Left to the caller
+    TEST_ASSERT_EQUAL_UINT8(1, AisPayloadMessageType("15RTgt0PAso;90TKcjM8h6g208CQ", 28));
+}
+
+/**
+ * @test Class B report (type 18) uses its own field offsets; 511 heading and 360.0° COG are NaN
+ */
+void test_ais_decode_class_b_and_not_available(void) {
+    AisPositionReport report;
+
+    // MMSI 338087471, 5.2 kn, 43.25 N 70.5 W, COG 123.4°, heading 511
+    TEST_ASSERT_EQUAL(AisDecodeResult::OK, decode("B52K>;h0=>gDK@6;uk1=;wP00000", 0, report));
+    TEST_ASSERT_EQUAL_UINT32(338087471u, report.mmsi);
+    TEST_ASSERT_EQUAL_UINT8(AIS_CLASS_B, report.aisClass);
+    TEST_ASSERT_EQUAL_UINT8(AIS_NAV_STATUS_UNDEFINED, report.navStatus);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 43.25, report.latitude);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, -70.5, report.longitude);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 5.2f, report.sog);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, static_cast<float>(123.4 * DEG), report.cog);
+    TEST_ASSERT_TRUE(isnan(report.heading));
+
+    // Type 1 at anchor (status 5): COG 359.9°, heading 360 = not available
+    TEST_ASSERT_EQUAL(AisDecodeResult::OK, decode("13aEOK5P000D3=0MdA<>3s@00000", 0, report));
+    TEST_ASSERT_EQUAL_UINT32(244670316u, report.mmsi);
+    TEST_ASSERT_EQUAL_UINT8(5, report.navStatus);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, report.sog);
+    TEST_ASSERT_FLOAT_WITHIN(1e-4f, static_cast<float>(359.9 * DEG), report.cog);
+    TEST_ASSERT_TRUE(isnan(report.heading));
+}
+
+/**
+ * @test Other message types, bad characters and short payloads are rejected without touching the output
+ */
+void test_ais_decode_rejects(void) {
+    AisPositionReport report;
+    memset(&report, 0, sizeof(report));
+    report.mmsi = 42;
+
+    // Type 5 (static data), first fragment
+    TEST_ASSERT_EQUAL(AisDecodeResult::UNSUPPORTED,
+                      decode("55?MbV02;H;s<HtKR20EHE:0@T4@Dn2222222216L961O5Gf0NSQEp6ClRp8", 0, report));
+    TEST_ASSERT_EQUAL(AisDecodeResult::INVALID, decode("15RTgt0PAso;90TKcjM8h6g208C", 0, report));  // 162 bits
+    TEST_ASSERT_EQUAL(AisDecodeResult::INVALID, decode("15RTgt0PAso;90TKcjM8h6g208CQ", 2, report));
+    TEST_ASSERT_EQUAL(AisDecodeResult::INVALID, decode("15RTgt0PAso;90TKcjM8h6g208XQ", 0, report));  // 'X' outside the alphabet
+    TEST_ASSERT_EQUAL(AisDecodeResult::INVALID, decode("", 0, report));
+    TEST_ASSERT_EQUAL_UINT32(42u, report.mmsi);
+    TEST_ASSERT_EQUAL_UINT8(0, AisPayloadMessageType("X", 1));
+}
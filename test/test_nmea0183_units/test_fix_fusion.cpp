@@ -0,0 +1,124 @@
+/**
+ * @file test_fix_fusion.cpp
+ * @brief Unit tests for NMEA0183FixFusion (RMC/GGA/VTG merged per fix epoch)
+ */
+
+#include <unity.h>
+#include "../../src/utils/NMEA0183FixFusion.h"
+#include "../../src/utils/NMEA0183FixFusion.cpp"
+
+namespace {
+
+NMEA0183FixInput position(double lat, double lon) {
+    NMEA0183FixInput in = {};
+    in.hasPosition = true;
+    in.latitude = lat;
+    in.longitude = lon;
+    return in;
+}
+
+NMEA0183FixInput course(double cog, double sog, double variation) {
+    NMEA0183FixInput in = {};
+    in.hasCourse = true;
+    in.cog = cog;
+    in.sog = sog;
+    in.hasVariation = true;
+    in.variation = variation;
+    return in;
+}
+
+/// Feed one RMC + GGA + VTG burst for UTC time @p t
+void feedBurst(NMEA0183FixFusion& fusion, uint32_t t, uint32_t nowMs) {
+    NMEA0183FixInput rmc = course(1.0, 5.0, -0.05);
+    rmc.hasPosition = true;
+    rmc.latitude = 52.0;
+    rmc.longitude = 5.0;
+    fusion.add(NMEA0183FixFusion::PART_RMC, t, rmc, nowMs);
+    fusion.add(NMEA0183FixFusion::PART_GGA, t, position(52.0001, 5.0001), nowMs + 10);
+    fusion.add(NMEA0183FixFusion::PART_VTG, NMEA0183FixFusion::NO_TIME,
+               course(1.0, 5.0, -0.06), nowMs + 20);
+}
+
+}  // namespace
+
+/**
+ * @brief After the first epoch, one fix per burst, released on its last sentence
+ */
+void test_fix_fusion_one_fix_per_epoch() {
+    NMEA0183FixFusion fusion;
+    NMEA0183FixInput fix;
+
+    // Learning epoch releases every merge
+    feedBurst(fusion, 100, 0);
+    TEST_ASSERT_TRUE(fusion.take(fix));
+    TEST_ASSERT_FALSE(fusion.take(fix));
+    TEST_ASSERT_EQUAL_UINT8(0, fusion.getExpectedParts());
+
+    // Second epoch closes the first and learns RMC|GGA|VTG
+    NMEA0183FixInput rmc = course(1.1, 5.5, -0.05);
+    rmc.hasPosition = true;
+    rmc.latitude = 52.001;
+    rmc.longitude = 5.001;
+    fusion.add(NMEA0183FixFusion::PART_RMC, 200, rmc, 1000);
+    TEST_ASSERT_EQUAL_UINT8(0x07, fusion.getExpectedParts());
+    TEST_ASSERT_FALSE(fusion.take(fix));
+
+    fusion.add(NMEA0183FixFusion::PART_GGA, 200, position(52.0012, 5.0012), 1010);
+    TEST_ASSERT_FALSE(fusion.take(fix));
+
+    fusion.add(NMEA0183FixFusion::PART_VTG, NMEA0183FixFusion::NO_TIME,
+               course(1.1, 5.5, -0.07), 1020);
+    TEST_ASSERT_TRUE(fusion.take(fix));
+    TEST_ASSERT_FALSE(fusion.take(fix));
+
+    // Latest position wins; RMC variation is not replaced by VTG's derived value
+    TEST_ASSERT_EQUAL_UINT8(0x07, fix.parts);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 52.0012, fix.latitude);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 5.5, fix.sog);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, -0.05, fix.variation);
+}
+
+/**
+ * @brief A fix missing a sentence is released when the next epoch starts or on timeout
+ */
+void test_fix_fusion_incomplete_epoch_released() {
+    NMEA0183FixFusion fusion;
+    NMEA0183FixInput fix;
+
+    feedBurst(fusion, 100, 0);
+    while (fusion.take(fix)) {
+    }
+    feedBurst(fusion, 200, 1000);
+    TEST_ASSERT_TRUE(fusion.take(fix));
+
+    // GGA only: held back until the next epoch supersedes it
+    fusion.add(NMEA0183FixFusion::PART_GGA, 300, position(53.0, 6.0), 2000);
+    TEST_ASSERT_FALSE(fusion.take(fix));
+    fusion.add(NMEA0183FixFusion::PART_GGA, 400, position(53.1, 6.1), 3000);
+    TEST_ASSERT_TRUE(fusion.take(fix));
+    TEST_ASSERT_EQUAL_UINT8(NMEA0183FixFusion::PART_GGA, fix.parts);
+    TEST_ASSERT_FALSE(fix.hasCourse);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 53.0, fix.latitude);
+
+    // The receiver now sends GGA only - each GGA completes its epoch at once
+    TEST_ASSERT_EQUAL_UINT8(NMEA0183FixFusion::PART_GGA, fusion.getExpectedParts());
+    TEST_ASSERT_TRUE(fusion.take(fix));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 53.1, fix.latitude);
+    fusion.add(NMEA0183FixFusion::PART_GGA, 500, position(53.2, 6.2), 4000);
+    TEST_ASSERT_TRUE(fusion.take(fix));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 53.2, fix.latitude);
+    TEST_ASSERT_FALSE(fusion.take(fix));
+
+    // Timeout releases an epoch that never completes
+    fusion.expire(5000);
+    TEST_ASSERT_FALSE(fusion.take(fix));
+    fusion.add(NMEA0183FixFusion::PART_VTG, NMEA0183FixFusion::NO_TIME,
+               course(2.0, 1.0, 0.0), 5000);
+    TEST_ASSERT_FALSE(fusion.take(fix));
+    fusion.expire(5000 + NMEA0183_FIX_FUSION_TIMEOUT_MS - 1);
+    TEST_ASSERT_FALSE(fusion.take(fix));
+    fusion.expire(5000 + NMEA0183_FIX_FUSION_TIMEOUT_MS);
+    TEST_ASSERT_TRUE(fusion.take(fix));
+    TEST_ASSERT_TRUE(fix.hasCourse);
+    TEST_ASSERT_FALSE(fix.hasPosition);
+}
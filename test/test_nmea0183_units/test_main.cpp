@@ -9,6 +9,28 @@ void test_unit_converter_variation_calculation();
 // Test functions from test_parsers.cpp
 void test_nmea0183_parse_rsa();
 
+// Test functions from test_sentence_key.cpp
+void test_nmea0183_pack_code_and_talker();
+void test_nmea0183_dispatch_lookup();
+
+// Test functions from test_sentence_stats.cpp
+void test_sentence_stats_outcomes_per_type_and_talker();
+void test_sentence_stats_rates();
+void test_sentence_stats_overflow_and_json();
+
+// Test functions from test_fix_fusion.cpp
+void test_fix_fusion_one_fix_per_epoch();
+void test_fix_fusion_incomplete_epoch_released();
+
+// Test functions from test_route_table.cpp
+void test_route_table_lookup_per_port();
+void test_route_table_rate_limit_and_replace();
+
+// Test functions from test_ais_vdm_decoder.cpp
+void test_ais_decode_class_a_position();
+void test_ais_decode_class_b_and_not_available();
+void test_ais_decode_rejects();
+
 void setUp() {
     // Set up before each test
 }
@@ -29,5 +51,27 @@ int main(int argc, char** argv) {
     // Parser tests
     RUN_TEST(test_nmea0183_parse_rsa);
 
+    // Sentence dispatch key tests
+    RUN_TEST(test_nmea0183_pack_code_and_talker);
+    RUN_TEST(test_nmea0183_dispatch_lookup);
+
+    // Sentence statistics tests
+    RUN_TEST(test_sentence_stats_outcomes_per_type_and_talker);
+    RUN_TEST(test_sentence_stats_rates);
+    RUN_TEST(test_sentence_stats_overflow_and_json);
+
+    // GPS fix fusion tests
+    RUN_TEST(test_fix_fusion_one_fix_per_epoch);
+    RUN_TEST(test_fix_fusion_incomplete_epoch_released);
+
+    // Routing table tests
+    RUN_TEST(test_route_table_lookup_per_port);
+    RUN_TEST(test_route_table_rate_limit_and_replace);
+
+    // AIS position report decoder tests
+    RUN_TEST(test_ais_decode_class_a_position);
+    RUN_TEST(test_ais_decode_class_b_and_not_available);
+    RUN_TEST(test_ais_decode_rejects);
+
     return UNITY_END();
 }
@@ -9,7 +9,7 @@ void test_nmea0183_parse_rsa() {
     tNMEA0183 nmea0183;
     double rudderAngle;
 
-    // Test valid RSA sentence: $APRSA,15.0,A*3C
+    // Test valid RSA sentence: $APRSA,15.0,A*0A
     // Parse the fixture sentence
     const char* validRSA = VALID_APRSA;
     for (size_t i = 0; validRSA[i] != '\0'; i++) {
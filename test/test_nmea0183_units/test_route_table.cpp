@@ -0,0 +1,87 @@
+/**
+ * @file test_route_table.cpp
+ * @brief Unit tests for NMEA0183RouteTable (per-port talker/sentence routing)
+ */
+
+#include <unity.h>
+#include "../../src/utils/NMEA0183SentenceKey.h"
+#include "../../src/utils/NMEA0183RouteTable.h"
+#include "../../src/utils/NMEA0183RouteTable.cpp"
+
+namespace {
+
+const uint32_t HDM = NMEA0183PackCode("HDM");
+const uint32_t RMC = NMEA0183PackCode("RMC");
+const uint32_t GGA = NMEA0183PackCode("GGA");
+const uint16_t AP = NMEA0183PackTalker("AP");
+const uint16_t VH = NMEA0183PackTalker("VH");
+
+}  // namespace
+
+void test_route_table_lookup_per_port() {
+    NMEA0183RouteTable routes;
+    // Added out of key order; finalize() sorts
+    TEST_ASSERT_TRUE(routes.add(1, RMC, NMEA0183PackTalker("GP"), "", true, 0.0f));
+    TEST_ASSERT_TRUE(routes.add(0, RMC, VH, nullptr, true, 0.0f));
+    TEST_ASSERT_TRUE(routes.add(0, HDM, AP, "AP-HDG", true, 0.0f));
+    TEST_ASSERT_TRUE(routes.add(0, GGA, VH, "", false, 0.0f));
+    TEST_ASSERT_FALSE(routes.add(0, 0, VH, "", true, 0.0f));       // Bad sentence
+    TEST_ASSERT_FALSE(routes.add(0, RMC, 0, "", true, 0.0f));      // Bad talker
+    TEST_ASSERT_FALSE(routes.add(8, RMC, VH, "", true, 0.0f));     // Port out of range
+    routes.finalize();
+    TEST_ASSERT_EQUAL_UINT8(4, routes.size());
+    for (uint8_t i = 1; i < routes.size(); i++) {
+        TEST_ASSERT_TRUE(routes.at(i - 1)->key < routes.at(i)->key);
+    }
+
+    const NMEA0183Route* route = nullptr;
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::ROUTED, routes.check(0, HDM, AP, 0, route));
+    TEST_ASSERT_NOT_NULL(route);
+    TEST_ASSERT_EQUAL_STRING("AP-HDG", route->source);
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::ROUTED, routes.check(0, RMC, VH, 0, route));
+    TEST_ASSERT_EQUAL_STRING("", route->source);
+
+    // Same sentence from another talker or on another port is not routed
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::NOT_ROUTED, routes.check(0, RMC, AP, 0, route));
+    TEST_ASSERT_NULL(route);
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::NOT_ROUTED, routes.check(1, RMC, VH, 0, route));
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::NOT_ROUTED, routes.check(0, 0, 0, 0, route));
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::DISABLED, routes.check(0, GGA, VH, 0, route));
+
+    // Ports without routes fall back to the built-in talkers
+    TEST_ASSERT_TRUE(routes.routesPort(0));
+    TEST_ASSERT_TRUE(routes.routesPort(1));
+    TEST_ASSERT_FALSE(routes.routesPort(2));
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::PORT_UNROUTED, routes.check(2, RMC, VH, 0, route));
+
+    routes.clear();
+    TEST_ASSERT_EQUAL_UINT8(0, routes.size());
+    TEST_ASSERT_FALSE(routes.routesPort(0));
+}
+
+void test_route_table_rate_limit_and_replace() {
+    NMEA0183RouteTable routes;
+    TEST_ASSERT_TRUE(routes.add(0, HDM, AP, "OLD", true, 0.0f));
+    TEST_ASSERT_TRUE(routes.add(0, HDM, AP, "AP-HDG", true, 5.0f));  // Replaces, 200 ms
+    routes.finalize();
+    TEST_ASSERT_EQUAL_UINT8(1, routes.size());
+    TEST_ASSERT_EQUAL_UINT16(200, routes.at(0)->minIntervalMs);
+
+    const NMEA0183Route* route = nullptr;
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::ROUTED, routes.check(0, HDM, AP, 0, route));
+    TEST_ASSERT_EQUAL_STRING("AP-HDG", route->source);
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::RATE_LIMITED, routes.check(0, HDM, AP, 100, route));
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::RATE_LIMITED, routes.check(0, HDM, AP, 199, route));
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::ROUTED, routes.check(0, HDM, AP, 200, route));
+    TEST_ASSERT_EQUAL(NMEA0183RouteDecision::RATE_LIMITED, routes.check(0, HDM, AP, 350, route));
+
+    // Table capacity
+    NMEA0183RouteTable full;
+    char talker[3] = {'A', 'A', '\0'};
+    for (int i = 0; i < NMEA0183_MAX_ROUTES; i++) {
+        talker[0] = static_cast<char>('A' + i / 26);
+        talker[1] = static_cast<char>('A' + i % 26);
+        TEST_ASSERT_TRUE(full.add(0, RMC, NMEA0183PackTalker(talker), "", true, 0.0f));
+    }
+    TEST_ASSERT_FALSE(full.add(0, GGA, VH, "", true, 0.0f));
+}
@@ -0,0 +1,65 @@
+#include <unity.h>
+#include "utils/NMEA0183SentenceKey.h"
+
+namespace {
+
+struct TestEntry {
+    uint32_t code;
+    NMEA0183TalkerSet talkers;
+    int id;
+};
+
+constexpr TestEntry kTable[] = {
+    {NMEA0183PackCode("GGA"), {{NMEA0183PackTalker("VH")}}, 1},
+    {NMEA0183PackCode("HDM"), {{NMEA0183PackTalker("AP"), NMEA0183PackTalker("HC")}}, 2},
+    {NMEA0183PackCode("RMC"), {{NMEA0183PackTalker("VH")}}, 3},
+    {NMEA0183PackCode("RSA"), {{NMEA0183PackTalker("AP")}}, 4},
+    {NMEA0183PackCode("VTG"), {{NMEA0183PackTalker("VH")}}, 5},
+};
+
+static_assert(NMEA0183IsSortedByCode(kTable), "test table must be sorted");
+
+constexpr TestEntry kUnsorted[] = {
+    {NMEA0183PackCode("RSA"), {{0}}, 1},
+    {NMEA0183PackCode("GGA"), {{0}}, 2},
+};
+
+static_assert(!NMEA0183IsSortedByCode(kUnsorted), "unsorted table must be detected");
+
+}  // namespace
+
+// Unit Test - Message code/talker packing
+void test_nmea0183_pack_code_and_talker() {
+    TEST_ASSERT_EQUAL_UINT32(0x524D43UL, NMEA0183PackCode("RMC"));
+    TEST_ASSERT_EQUAL_UINT16(0x5648, NMEA0183PackTalker("VH"));
+
+    // Wrong length or missing codes never match a table entry
+    TEST_ASSERT_EQUAL_UINT32(0, NMEA0183PackCode("RM"));
+    TEST_ASSERT_EQUAL_UINT32(0, NMEA0183PackCode("GRME"));
+    TEST_ASSERT_EQUAL_UINT32(0, NMEA0183PackCode(nullptr));
+    TEST_ASSERT_EQUAL_UINT16(0, NMEA0183PackTalker("V"));
+    TEST_ASSERT_EQUAL_UINT16(0, NMEA0183PackTalker("VHX"));
+}
+
+// Unit Test - Sorted table lookup and talker rejection
+void test_nmea0183_dispatch_lookup() {
+    for (size_t i = 0; i < sizeof(kTable) / sizeof(kTable[0]); i++) {
+        const TestEntry* entry = NMEA0183FindByCode(kTable, kTable[i].code);
+        TEST_ASSERT_NOT_NULL(entry);
+        TEST_ASSERT_EQUAL(kTable[i].id, entry->id);
+    }
+
+    TEST_ASSERT_NULL(NMEA0183FindByCode(kTable, NMEA0183PackCode("AAA")));
+    TEST_ASSERT_NULL(NMEA0183FindByCode(kTable, NMEA0183PackCode("MWV")));
+    TEST_ASSERT_NULL(NMEA0183FindByCode(kTable, NMEA0183PackCode("ZZZ")));
+    TEST_ASSERT_NULL(NMEA0183FindByCode(kTable, 0));
+
+    const TestEntry* hdm = NMEA0183FindByCode(kTable, NMEA0183PackCode("HDM"));
+    TEST_ASSERT_TRUE(hdm->talkers.accepts(NMEA0183PackTalker("AP")));
+    TEST_ASSERT_TRUE(hdm->talkers.accepts(NMEA0183PackTalker("HC")));
+    TEST_ASSERT_FALSE(hdm->talkers.accepts(NMEA0183PackTalker("VH")));
+    TEST_ASSERT_FALSE(hdm->talkers.accepts(0));  // Unused slots never match
+
+    const TestEntry* gga = NMEA0183FindByCode(kTable, NMEA0183PackCode("GGA"));
+    TEST_ASSERT_FALSE(gga->talkers.accepts(NMEA0183PackTalker("GP")));
+}
@@ -0,0 +1,103 @@
+/**
+ * @file test_sentence_stats.cpp
+ * @brief Unit tests for NMEA0183SentenceStats (per-sentence type, per-talker counters)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/components/NMEA0183SentenceStats.h"
+#include "../../src/components/NMEA0183SentenceStats.cpp"
+#include "../../src/utils/JsonWriter.cpp"
+#include "../../src/utils/NMEA0183SentenceKey.h"
+
+/**
+ * @brief Each outcome lands in its own counter; the same code from two talkers is two entries
+ */
+void test_sentence_stats_outcomes_per_type_and_talker() {
+    static NMEA0183SentenceStats stats;
+    stats.reset();
+
+    const uint32_t rmc = NMEA0183PackCode("RMC");
+    const uint16_t vh = NMEA0183PackTalker("VH");
+    const uint16_t gp = NMEA0183PackTalker("GP");
+
+    stats.recordHandled(rmc, vh, NMEA0183Result::ACCEPTED, 70, 1000);
+    stats.recordHandled(rmc, vh, NMEA0183Result::PARSE_FAILED, 70, 2000);
+    stats.recordHandled(rmc, vh, NMEA0183Result::RANGE_REJECTED, 70, 3000);
+    stats.recordChecksumFailed(rmc, vh, 70, 4000);
+    stats.recordTalkerRejected(rmc, gp, 70, 4000);
+    stats.recordUnhandled(NMEA0183PackCode("GSV"), gp, 60, 4000);
+
+    TEST_ASSERT_EQUAL_UINT8(3, stats.getEntryCount());
+    TEST_ASSERT_EQUAL_UINT32(6, stats.getTotalReceived());
+
+    const NMEA0183SentenceStatsEntry* a = stats.find(rmc, vh);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_TRUE(a->handled);
+    TEST_ASSERT_EQUAL_UINT32(4, a->received);
+    TEST_ASSERT_EQUAL_UINT32(1, a->accepted);
+    TEST_ASSERT_EQUAL_UINT32(1, a->parseFailed);
+    TEST_ASSERT_EQUAL_UINT32(1, a->rangeRejected);
+    TEST_ASSERT_EQUAL_UINT32(1, a->checksumFailed);
+    TEST_ASSERT_EQUAL_UINT32(280, a->bytes);
+
+    const NMEA0183SentenceStatsEntry* b = stats.find(rmc, gp);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_FALSE(b->handled);
+    TEST_ASSERT_EQUAL_UINT32(1, b->talkerRejected);
+
+    const NMEA0183SentenceStatsEntry* c = stats.find(NMEA0183PackCode("GSV"), gp);
+    TEST_ASSERT_NOT_NULL(c);
+    TEST_ASSERT_EQUAL_UINT32(1, c->unhandled);
+
+    TEST_ASSERT_NULL(stats.find(NMEA0183PackCode("HDM"), vh));
+}
+
+/**
+ * @brief Sentence and byte rates follow the 1 s interval and decay when quiet
+ */
+void test_sentence_stats_rates() {
+    static NMEA0183SentenceStats stats;
+    stats.reset();
+
+    const uint32_t hdm = NMEA0183PackCode("HDM");
+    const uint16_t ap = NMEA0183PackTalker("AP");
+    for (uint32_t t = 0; t <= 10000; t += 1000) {
+        stats.recordHandled(hdm, ap, NMEA0183Result::ACCEPTED, 17, t);
+    }
+
+    const NMEA0183SentenceStatsEntry* e = stats.find(hdm, ap);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 1.0f, NMEA0183SentenceStats::rateHz(*e, 10000));
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, 17.0f, NMEA0183SentenceStats::bytesPerSecond(*e, 10000));
+
+    // Quiet for 4 s: rate decays to 1 / 4 s
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.25f, NMEA0183SentenceStats::rateHz(*e, 14000));
+}
+
+/**
+ * @brief A full table counts new pairs as overflow; JSON names the unpacked keys
+ */
+void test_sentence_stats_overflow_and_json() {
+    static NMEA0183SentenceStats stats;
+    stats.reset();
+
+    char code[4] = "AAA";
+    for (uint8_t i = 0; i < NMEA0183SentenceStats::MAX_ENTRIES + 2; i++) {
+        code[2] = static_cast<char>('A' + i % 26);
+        code[1] = static_cast<char>('A' + i / 26);
+        stats.recordUnhandled(NMEA0183PackCode(code), NMEA0183PackTalker("II"), 20, 100);
+    }
+    TEST_ASSERT_EQUAL_UINT8(NMEA0183SentenceStats::MAX_ENTRIES, stats.getEntryCount());
+    TEST_ASSERT_EQUAL_UINT32(2, stats.getOverflowCount());
+
+    stats.reset();
+    stats.recordHandled(NMEA0183PackCode("VTG"), NMEA0183PackTalker("VH"),
+                        NMEA0183Result::ACCEPTED, 40, 500);
+    StaticJsonWriter<384> out;
+    NMEA0183SentenceStats::writeEntry(out, *stats.find(NMEA0183PackCode("VTG"),
+                                                       NMEA0183PackTalker("VH")), 900);
+    TEST_ASSERT_NOT_NULL(strstr(out.c_str(), "\"type\":\"VTG\",\"talker\":\"VH\""));
+    TEST_ASSERT_NOT_NULL(strstr(out.c_str(), "\"accepted\":1"));
+    TEST_ASSERT_NOT_NULL(strstr(out.c_str(), "\"last_rx_ms_ago\":400"));
+}
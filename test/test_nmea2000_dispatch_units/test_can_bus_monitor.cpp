@@ -0,0 +1,97 @@
+/**
+ * @file test_can_bus_monitor.cpp
+ * @brief Unit tests for CanBusMonitor (load windows, peak, fault confinement state)
+ */
+
+#include <unity.h>
+#include "../../src/utils/CanBusMonitor.h"
+#include "../../src/utils/CanBusMonitor.cpp"
+
+namespace {
+
+/// @p perBucket 8-byte frames in every bucket of [fromMs, toMs)
+void fill(CanBusMonitor& monitor, uint32_t fromMs, uint32_t toMs, uint16_t perBucket) {
+    for (uint32_t t = fromMs; t < toMs; t += CAN_BUS_LOAD_BUCKET_MS) {
+        for (uint16_t i = 0; i < perBucket; i++) {
+            monitor.noteFrame(8, t + (i % CAN_BUS_LOAD_BUCKET_MS));
+        }
+    }
+}
+
+CanControllerSample reading(uint8_t tec, uint8_t rec, bool warning = false, bool busOff = false,
+                            bool overrun = false) {
+    CanControllerSample sample = {tec, rec, warning, busOff, overrun};
+    return sample;
+}
+
+}  // namespace
+
+void test_can_bus_monitor_load_windows() {
+    TEST_ASSERT_EQUAL_UINT16(131, CanFrameBits(8));  // N2K_LOAD_BITS_PER_FRAME model
+    TEST_ASSERT_EQUAL_UINT16(67, CanFrameBits(0));
+
+    CanBusMonitor monitor;
+    fill(monitor, 1000, 2000, 50);  // 50 * 131 bits per 100 ms of 25000: 26%
+    TEST_ASSERT_EQUAL_UINT32(500, monitor.getFrames());
+
+    TEST_ASSERT_EQUAL_UINT8(26, monitor.loadPercent(2000, CAN_BUS_LOAD_SHORT_MS));
+    TEST_ASSERT_EQUAL_UINT8(26, monitor.loadPercent(2099, CAN_BUS_LOAD_SHORT_MS));
+    TEST_ASSERT_EQUAL_UINT8(5, monitor.loadPercent(2000, CAN_BUS_LOAD_LONG_MS));   // 1 s of 5 s busy
+    TEST_ASSERT_EQUAL_UINT8(13, monitor.loadPercent(2500, CAN_BUS_LOAD_SHORT_MS)); // Half the window silent
+
+    // A silent bus reads 0 although nothing rotated the buckets
+    TEST_ASSERT_EQUAL_UINT8(0, monitor.loadPercent(10000, CAN_BUS_LOAD_SHORT_MS));
+    TEST_ASSERT_EQUAL_UINT8(0, monitor.loadPercent(10000, CAN_BUS_LOAD_LONG_MS));
+
+    // The peak is taken when a bucket closes: the next frame closes the last busy one
+    TEST_ASSERT_EQUAL_UINT8(23, monitor.getPeakPercent());
+    monitor.noteFrame(8, 10000);
+    TEST_ASSERT_EQUAL_UINT8(26, monitor.getPeakPercent());
+}
+
+void test_can_bus_monitor_caps_injected_overload() {
+    CanBusMonitor monitor;
+    fill(monitor, 500, 600, 300);   // 39300 bits in 100 ms: more than the wire carries
+    monitor.noteFrame(8, 600);
+    TEST_ASSERT_EQUAL_UINT8(100, monitor.loadPercent(600, CAN_BUS_LOAD_BUCKET_MS));
+    TEST_ASSERT_EQUAL_UINT8(15, monitor.getPeakPercent());  // Averaged over the 1 s peak window
+}
+
+void test_can_bus_monitor_fault_confinement_states() {
+    CanBusMonitor monitor;
+    TEST_ASSERT_TRUE(monitor.sampleDue(0));
+    TEST_ASSERT_FALSE(monitor.sample(reading(0, 0), 0));
+    TEST_ASSERT_FALSE(monitor.sampleDue(CAN_BUS_SAMPLE_MS - 1));
+    TEST_ASSERT_TRUE(monitor.sampleDue(CAN_BUS_SAMPLE_MS));
+    TEST_ASSERT_EQUAL(static_cast<int>(CanBusState::ERROR_ACTIVE), static_cast<int>(monitor.getState()));
+
+    monitor.sample(reading(8, 100, true), 100);
+    TEST_ASSERT_EQUAL(static_cast<int>(CanBusState::ERROR_WARNING), static_cast<int>(monitor.getState()));
+    monitor.sample(reading(8, 110, true), 200);      // Staying there is no new entry
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.getWarnings());
+    TEST_ASSERT_EQUAL_UINT8(110, monitor.getRxErrors());
+
+    monitor.sample(reading(130, 110, true), 300);
+    TEST_ASSERT_EQUAL_STRING("passive", CanBusStateName(monitor.getState()));
+    monitor.sample(reading(255, 0, true, true), 400);
+    TEST_ASSERT_EQUAL_STRING("bus_off", CanBusStateName(monitor.getState()));
+
+    // Recovered, then into warning again
+    monitor.sample(reading(0, 0), 500);
+    monitor.sample(reading(97, 0), 600);
+    TEST_ASSERT_EQUAL_UINT32(2, monitor.getWarnings());
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.getPassives());
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.getBusOffs());
+
+    // Overruns are counted and reported back so the driver clears the flag
+    TEST_ASSERT_TRUE(monitor.sample(reading(0, 0, false, false, true), 700));
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.getOverruns());
+
+    char buffer[256];
+    JsonWriter json(buffer, sizeof(buffer));
+    monitor.writeJson(json, 800);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"load_pct\":0,\"load_5s_pct\":0,\"peak_pct\":0,\"frames\":0,\"state\":\"active\","
+        "\"tec\":0,\"rec\":0,\"warnings\":2,\"passives\":1,\"bus_offs\":1,\"overruns\":1}",
+        json.c_str());
+}
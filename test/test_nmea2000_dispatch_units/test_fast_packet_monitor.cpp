@@ -0,0 +1,112 @@
+/**
+ * @file test_fast_packet_monitor.cpp
+ * @brief Unit tests for N2kFastPacketMonitor (fast-packet reassembly losses)
+ */
+
+#include <unity.h>
+#include "../../src/components/N2kFastPacketMonitor.h"
+#include "../../src/components/N2kFastPacketMonitor.cpp"
+
+namespace {
+
+N2kHandlerResult fpHandler(const tN2kMsg&, BoatData*, WebSocketLogger*) {
+    return N2kHandlerResult::UPDATED;
+}
+
+// 129029 (0x1F805) from the given source, priority 3
+uint32_t canId129029(uint8_t source) {
+    return (3UL << 26) | (0x1F805UL << 8) | source;
+}
+
+/**
+ * @brief Feed one fast-packet frame; frame 0 announces @p totalLen bytes
+ */
+void sendFrame(N2kFastPacketMonitor& monitor, uint8_t source, uint8_t counter, uint8_t frame,
+               uint8_t totalLen, uint32_t nowMs) {
+    uint8_t data[8] = {0};
+    data[0] = static_cast<uint8_t>((counter << 5) | frame);
+    if (frame == 0) {
+        data[1] = totalLen;
+    }
+    monitor.observeFrame(canId129029(source), 8, data, nowMs);
+}
+
+struct FastPacketFixture {
+    N2kPGNTable table;
+    N2kPGNStats stats;
+    N2kFastPacketMonitor monitor;
+
+    FastPacketFixture() {
+        table.add(129029L, fpHandler, "GNSS Position Data");
+        table.setFastPacket(129029L, true);
+        monitor.begin(&table, &stats);
+    }
+};
+
+}  // namespace
+
+/**
+ * @brief PGN extraction handles PDU2 and strips the PDU1 destination
+ */
+void test_fast_packet_pgn_from_can_id() {
+    TEST_ASSERT_EQUAL_UINT32(129029UL, N2kFastPacketMonitor::pgnFromCanId(canId129029(7)));
+    // 59904 ISO Request (PDU1) addressed to 0x22
+    TEST_ASSERT_EQUAL_UINT32(59904UL, N2kFastPacketMonitor::pgnFromCanId((6UL << 26) | (0xEA22UL << 8) | 5));
+}
+
+/**
+ * @brief A complete 43-byte sequence (7 frames) counts as completed, no loss
+ */
+void test_fast_packet_complete_sequence() {
+    static FastPacketFixture f;
+    for (uint8_t frame = 0; frame < 7; frame++) {
+        sendFrame(f.monitor, 3, 2, frame, 43, 1000 + frame);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1, f.monitor.getCompleted());
+    TEST_ASSERT_EQUAL_UINT32(0, f.monitor.getFailed());
+    TEST_ASSERT_EQUAL_UINT8(0, f.monitor.getActive());
+    TEST_ASSERT_EQUAL_UINT8(1, f.monitor.getPeakActive());
+}
+
+/**
+ * @brief Skipped frame, restarted sequence and frame gap are classified
+ */
+void test_fast_packet_losses_counted_per_pgn_and_source() {
+    static FastPacketFixture f;
+
+    // Out of order: frame 2 after frame 0
+    sendFrame(f.monitor, 3, 1, 0, 43, 1000);
+    sendFrame(f.monitor, 3, 1, 2, 43, 1001);
+
+    // Incomplete: new sequence starts after only two frames
+    sendFrame(f.monitor, 3, 2, 0, 43, 1010);
+    sendFrame(f.monitor, 3, 2, 1, 43, 1011);
+    sendFrame(f.monitor, 3, 3, 0, 43, 1020);
+
+    // Timeout: next frame arrives after the gap limit
+    sendFrame(f.monitor, 3, 3, 1, 43, 1020 + N2K_FAST_PACKET_TIMEOUT_MS + 1);
+
+    const N2kPGNStatsEntry* e = f.stats.find(129029, 3);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT32(1, e->fpOutOfOrder);
+    TEST_ASSERT_EQUAL_UINT32(1, e->fpIncomplete);
+    TEST_ASSERT_EQUAL_UINT32(1, e->fpTimeout);
+    TEST_ASSERT_EQUAL_UINT32(0, e->received);  // Losses are not received frames
+    TEST_ASSERT_EQUAL_UINT32(3, f.monitor.getFailed());
+}
+
+/**
+ * @brief More concurrent senders than buffers are refused and counted
+ */
+void test_fast_packet_no_buffer_when_pool_full() {
+    static FastPacketFixture f;
+    for (uint8_t source = 0; source <= N2kFastPacketMonitor::BUFFERS; source++) {
+        sendFrame(f.monitor, source, 0, 0, 43, 2000);
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(N2kFastPacketMonitor::BUFFERS, f.monitor.getPeakActive());
+    const N2kPGNStatsEntry* e = f.stats.find(129029, N2kFastPacketMonitor::BUFFERS);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT32(1, e->fpNoBuffer);
+}
@@ -0,0 +1,162 @@
+/**
+ * @file test_field_decoder.cpp
+ * @brief N2kFieldDecoder: bit extraction, selectors, NA codes, scaling and clamping into patch structs
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "../../src/utils/N2kFieldDecoder.h"
+#include "../../src/utils/N2kFieldDecoder.cpp"
+#include "../../src/utils/BoatDataSchema.cpp"
+
+/**
+ * @test Fields are read little endian, least significant bit first, across byte boundaries
+ */
+void test_field_decoder_extract_bits() {
+    const uint8_t data[] = {0x12, 0xC5, 0x34, 0x12, 0xFF};
+    TEST_ASSERT_EQUAL_UINT32(0x12, N2kFieldDecoder::extract(data, 0, 8));
+    TEST_ASSERT_EQUAL_UINT32(0x05, N2kFieldDecoder::extract(data, 8, 6));    // Low 6 bits of 0xC5
+    TEST_ASSERT_EQUAL_UINT32(0x03, N2kFieldDecoder::extract(data, 14, 2));   // High 2 bits of 0xC5
+    TEST_ASSERT_EQUAL_UINT32(0x1234, N2kFieldDecoder::extract(data, 16, 16));
+    TEST_ASSERT_EQUAL_UINT32(0x34C, N2kFieldDecoder::extract(data, 12, 12));  // Straddles three bytes
+    TEST_ASSERT_EQUAL_UINT32(0xFF1234C5UL, N2kFieldDecoder::extract(data, 8, 32));
+}
+
+/**
+ * @test PGN 127508 battery status: the instance selects battery A or B
+ */
+void test_field_decoder_battery_instance_selects_layout() {
+    // Instance 1, 12.84 V, -4.2 A, temperature NA, SID 7
+    const uint8_t payload[] = {N2K_BATTERY_INSTANCE_B, 0x04, 0x05, 0xD6, 0xFF, 0xFF, 0xFF, 0x07};
+    N2kDecodeStatus status;
+    const N2kPgnLayout* layout = N2kFieldDecoder::select(127508UL, payload, sizeof(payload), status);
+    TEST_ASSERT_NOT_NULL(layout);
+    TEST_ASSERT_EQUAL(N2kDecodeStatus::DECODED, status);
+    TEST_ASSERT_EQUAL(BOATDATA_SCHEMA_GROUP_BATTERY, layout->group);
+
+    BatteryData battery;
+    memset(&battery, 0, sizeof(battery));
+    N2kDecodeResult result = N2kFieldDecoder::decode(*layout, payload, &battery);
+    TEST_ASSERT_EQUAL(N2kDecodeStatus::DECODED, result.status);
+    TEST_ASSERT_EQUAL_HEX16(BatteryField::VOLTAGE_B | BatteryField::AMPERAGE_B, result.fields);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 12.84, battery.voltageB);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, -4.2, battery.amperageB);
+    TEST_ASSERT_EQUAL(0, result.clamped);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 0.0, battery.voltageA);  // Untouched
+
+    // Instance 3 is neither battery; a short payload cannot be decoded
+    uint8_t other[sizeof(payload)];
+    memcpy(other, payload, sizeof(other));
+    other[0] = 3;
+    TEST_ASSERT_NULL(N2kFieldDecoder::select(127508UL, other, sizeof(other), status));
+    TEST_ASSERT_EQUAL(N2kDecodeStatus::NOT_SELECTED, status);
+    TEST_ASSERT_NULL(N2kFieldDecoder::select(127508UL, payload, 4, status));
+    TEST_ASSERT_EQUAL(N2kDecodeStatus::TOO_SHORT, status);
+    TEST_ASSERT_NULL(N2kFieldDecoder::select(128275UL, payload, sizeof(payload), status));
+    TEST_ASSERT_EQUAL(N2kDecodeStatus::NO_LAYOUT, status);
+    TEST_ASSERT_TRUE(N2kFieldDecoder::handles(127508UL));
+    TEST_ASSERT_FALSE(N2kFieldDecoder::handles(128275UL));
+}
+
+/**
+ * @test "Not available" and "out of range" codes store nothing
+ */
+void test_field_decoder_na_codes_skip_fields() {
+    N2kDecodeStatus status;
+    BatteryData battery;
+    memset(&battery, 0, sizeof(battery));
+
+    // Voltage NA (0xFFFF), current out of range (0x7FFE)
+    const uint8_t none[] = {N2K_BATTERY_INSTANCE_A, 0xFF, 0xFF, 0xFE, 0x7F, 0xFF, 0xFF, 0x00};
+    const N2kPgnLayout* layout = N2kFieldDecoder::select(127508UL, none, sizeof(none), status);
+    TEST_ASSERT_NOT_NULL(layout);
+    N2kDecodeResult result = N2kFieldDecoder::decode(*layout, none, &battery);
+    TEST_ASSERT_EQUAL(N2kDecodeStatus::NOT_AVAILABLE, result.status);
+    TEST_ASSERT_EQUAL_HEX16(0, result.fields);
+
+    // Valid voltage, current NA (0x7FFF): one field
+    const uint8_t voltage[] = {N2K_BATTERY_INSTANCE_A, 0x14, 0x05, 0xFF, 0x7F, 0xFF, 0xFF, 0x00};
+    result = N2kFieldDecoder::decode(*layout, voltage, &battery);
+    TEST_ASSERT_EQUAL_HEX16(BatteryField::VOLTAGE_A, result.fields);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 13.0, battery.voltageA);
+
+    // PGN 127506 state of charge 0xFE (out of range) vs 86 %
+    uint8_t dc[11] = {0x01, N2K_BATTERY_INSTANCE_A, 0x00, 0xFE, 0x5F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+    layout = N2kFieldDecoder::select(127506UL, dc, sizeof(dc), status);
+    TEST_ASSERT_NOT_NULL(layout);
+    TEST_ASSERT_EQUAL(N2kDecodeStatus::NOT_AVAILABLE, N2kFieldDecoder::decode(*layout, dc, &battery).status);
+    dc[3] = 86;
+    result = N2kFieldDecoder::decode(*layout, dc, &battery);
+    TEST_ASSERT_EQUAL_HEX16(BatteryField::SOC_A, result.fields);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 86.0, battery.stateOfChargeA);
+}
+
+/**
+ * @test Temperatures: source selector in a 6-bit field, Kelvin offset, clamping to the schema range
+ */
+void test_field_decoder_temperature_source_and_clamp() {
+    N2kDecodeStatus status;
+    DSTData dst;
+    memset(&dst, 0, sizeof(dst));
+
+    // PGN 130311: sea source (0) with humidity source 1 in the top bits, 17.80 °C = 29095 (0x71A7)
+    uint8_t env[] = {0x01, 0x40, 0xA7, 0x71, 0xFF, 0x7F, 0xFF, 0xFF};
+    const N2kPgnLayout* layout = N2kFieldDecoder::select(130311UL, env, sizeof(env), status);
+    TEST_ASSERT_NOT_NULL(layout);
+    N2kDecodeResult result = N2kFieldDecoder::decode(*layout, env, &dst);
+    TEST_ASSERT_EQUAL_HEX16(DSTField::SEA_TEMPERATURE, result.fields);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 17.8, dst.seaTemperature);
+
+    env[1] = 0x41;  // Outside temperature
+    TEST_ASSERT_NULL(N2kFieldDecoder::select(130311UL, env, sizeof(env), status));
+    TEST_ASSERT_EQUAL(N2kDecodeStatus::NOT_SELECTED, status);
+
+    // PGN 130312: 60 °C sea temperature (33315 = 0x8223) is clamped to 50 °C
+    const uint8_t temp[] = {0x01, 0x00, 0x00, 0x23, 0x82, 0xFF, 0xFF, 0xFF};
+    layout = N2kFieldDecoder::select(130312UL, temp, sizeof(temp), status);
+    TEST_ASSERT_NOT_NULL(layout);
+    result = N2kFieldDecoder::decode(*layout, temp, &dst);
+    TEST_ASSERT_EQUAL(1, result.clamped);
+    TEST_ASSERT_EQUAL(BOATDATA_FIELD_DST_SEA_TEMPERATURE, result.clampedField);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 60.0, result.clampedValue);
+    TEST_ASSERT_FLOAT_WITHIN(0.01, 50.0, dst.seaTemperature);
+}
+
+/**
+ * @test Every layout field belongs to the layout's group; field bits equal the patch*() selectors
+ */
+void test_field_decoder_layouts_match_patch_selectors() {
+    uint8_t count = 0;
+    const N2kPgnLayout* layouts = N2kFieldDecoder::layouts(count);
+    TEST_ASSERT_TRUE(count > 0);
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_TRUE(layouts[i].fieldCount > 0);
+        for (uint8_t f = 0; f < layouts[i].fieldCount; f++) {
+            TEST_ASSERT_EQUAL(layouts[i].group, BoatDataSchema::fieldInfo(layouts[i].fields[f].field).group);
+        }
+        if (i > 0) {
+            TEST_ASSERT_TRUE(layouts[i - 1].pgn <= layouts[i].pgn);  // Sorted, one PGN's layouts adjacent
+        }
+    }
+
+    auto bit = [](uint8_t id) {
+        return 1u << (id - BoatDataSchema::groupInfo(BoatDataSchema::fieldInfo(id).group).firstField);
+    };
+    TEST_ASSERT_EQUAL_HEX16(GPSField::HDOP, bit(BOATDATA_FIELD_GPS_HDOP));
+    TEST_ASSERT_EQUAL_HEX16(DSTField::SEA_TEMPERATURE, bit(BOATDATA_FIELD_DST_SEA_TEMPERATURE));
+    TEST_ASSERT_EQUAL_HEX16(BatteryField::VOLTAGE_A, bit(BOATDATA_FIELD_BATTERY_VOLTAGE_A));
+    TEST_ASSERT_EQUAL_HEX16(BatteryField::SOC_A, bit(BOATDATA_FIELD_BATTERY_SOC_A));
+    TEST_ASSERT_EQUAL_HEX16(BatteryField::AMPERAGE_B, bit(BOATDATA_FIELD_BATTERY_AMPERAGE_B));
+    TEST_ASSERT_EQUAL_HEX16(BatteryField::ENGINE_CHARGER_B, bit(BOATDATA_FIELD_BATTERY_ENGINE_CHARGER_B));
+
+    // PGN 129539: HDOP 0.90 (90) into GPSData
+    const uint8_t dops[] = {0x01, 0x13, 0x5A, 0x00, 0x8C, 0x00, 0xFF, 0x7F};
+    N2kDecodeStatus status;
+    const N2kPgnLayout* layout = N2kFieldDecoder::select(129539UL, dops, sizeof(dops), status);
+    TEST_ASSERT_NOT_NULL(layout);
+    GPSData gps;
+    N2kDecodeResult result = N2kFieldDecoder::decode(*layout, dops, &gps);
+    TEST_ASSERT_EQUAL_HEX16(GPSField::HDOP, result.fields);
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 0.9, gps.hdop);
+}
@@ -0,0 +1,73 @@
+/**
+ * @file test_latency_histogram.cpp
+ * @brief Unit tests for LatencyHistogram (receive latency statistics)
+ */
+
+#include <unity.h>
+#include "../../src/utils/LatencyHistogram.h"
+#include "../../src/utils/LatencyHistogram.cpp"
+
+/**
+ * @brief Buckets are contiguous, ordered and split each octave in half
+ */
+void test_latency_buckets_cover_range() {
+    TEST_ASSERT_EQUAL_UINT8(0, LatencyHistogram::bucketFor(0));
+    TEST_ASSERT_EQUAL_UINT8(3, LatencyHistogram::bucketFor(3));
+    TEST_ASSERT_EQUAL_UINT8(4, LatencyHistogram::bucketFor(4));
+    TEST_ASSERT_EQUAL_UINT8(5, LatencyHistogram::bucketFor(6));
+    TEST_ASSERT_EQUAL_UINT8(6, LatencyHistogram::bucketFor(8));
+    TEST_ASSERT_EQUAL_UINT8(LatencyHistogram::BUCKETS - 1, LatencyHistogram::bucketFor(UINT32_MAX));
+
+    // Every value maps to the bucket whose upper edge is just above it
+    for (uint32_t us = 0; us < 100000; us++) {
+        uint8_t bucket = LatencyHistogram::bucketFor(us);
+        TEST_ASSERT_TRUE(us < LatencyHistogram::bucketUpperEdge(bucket));
+        if (bucket > 0) {
+            TEST_ASSERT_TRUE(us >= LatencyHistogram::bucketUpperEdge(bucket - 1));
+        }
+    }
+}
+
+/**
+ * @brief Min/avg/max are exact; empty histogram reports zeros
+ */
+void test_latency_min_avg_max() {
+    LatencyHistogram hist;
+    TEST_ASSERT_EQUAL_UINT32(0, hist.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0, hist.getMin());
+    TEST_ASSERT_EQUAL_UINT32(0, hist.getPercentile(99));
+
+    hist.record(100);
+    hist.record(300, 2);
+    hist.record(5000);
+
+    TEST_ASSERT_EQUAL_UINT32(4, hist.getCount());
+    TEST_ASSERT_EQUAL_UINT32(100, hist.getMin());
+    TEST_ASSERT_EQUAL_UINT32(5000, hist.getMax());
+    TEST_ASSERT_EQUAL_UINT32(1425, hist.getAverage());
+
+    hist.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, hist.getCount());
+    TEST_ASSERT_EQUAL_UINT32(0, hist.getMax());
+}
+
+/**
+ * @brief p99 lands in the tail bucket and is clamped to the observed max
+ */
+void test_latency_p99_tracks_tail() {
+    LatencyHistogram hist;
+    hist.record(200, 990);     // Bulk: 200 µs
+    hist.record(9000, 10);     // 1% tail: 9 ms
+
+    uint32_t p50 = hist.getPercentile(50);
+    uint32_t p99 = hist.getPercentile(99);
+    uint32_t p100 = hist.getPercentile(100);
+
+    TEST_ASSERT_TRUE(p50 >= 200 && p50 < 256);       // Bucket [192, 256)
+    TEST_ASSERT_TRUE(p99 >= 200 && p99 < 256);       // Rank 990 is still bulk
+    TEST_ASSERT_EQUAL_UINT32(9000, p100);            // Clamped to max
+
+    hist.record(9000, 10);                           // Tail now 2%
+    p99 = hist.getPercentile(99);
+    TEST_ASSERT_EQUAL_UINT32(9000, p99);
+}
@@ -0,0 +1,142 @@
+/**
+ * @file test_load_plan.cpp
+ * @brief Unit tests for N2kLoadPlan (load generator mix, pacing, frame layout)
+ */
+
+#include <unity.h>
+#include "../../src/utils/N2kLoadPlan.h"
+#include "../../src/utils/N2kLoadPlan.cpp"
+#include "../../src/components/N2kFastPacketMonitor.h"
+
+namespace {
+
+N2kHandlerResult loadHandler(const tN2kMsg&, BoatData*, WebSocketLogger*) {
+    return N2kHandlerResult::UPDATED;
+}
+
+}  // namespace
+
+/**
+ * @brief Mix text with default and explicit weights; errors leave the mix empty
+ */
+void test_load_plan_parse_mix() {
+    N2kLoadPlan plan;
+    TEST_ASSERT_TRUE(plan.parseMix("130306:10,129025,129029:2,130306:5"));
+    TEST_ASSERT_EQUAL_UINT8(3, plan.count());
+    TEST_ASSERT_EQUAL_UINT32(130306UL, plan.entry(0).pgn);
+    TEST_ASSERT_EQUAL_UINT16(15, plan.entry(0).weight);   // Repeated PGN adds up
+    TEST_ASSERT_EQUAL_UINT16(1, plan.entry(1).weight);
+    TEST_ASSERT_EQUAL_UINT16(2, plan.entry(2).weight);
+
+    TEST_ASSERT_FALSE(plan.parseMix("130306:x"));
+    TEST_ASSERT_EQUAL_UINT8(0, plan.count());
+    TEST_ASSERT_FALSE(plan.parseMix("130306;129025"));
+    TEST_ASSERT_FALSE(plan.parseMix("130306:1001"));
+    TEST_ASSERT_FALSE(plan.parseMix(""));
+    TEST_ASSERT_TRUE(plan.parseMix(N2K_LOAD_DEFAULT_MIX));
+}
+
+/**
+ * @brief Weighted round-robin keeps the ratio and interleaves the light entry
+ */
+void test_load_plan_weighted_interleave() {
+    N2kLoadPlan plan;
+    TEST_ASSERT_TRUE(plan.parseMix("130306:3,129025:1"));
+    plan.start(100, 0);
+
+    uint8_t picks[8];
+    uint8_t light = 0;
+    for (uint8_t i = 0; i < 8; i++) {
+        picks[i] = plan.next();
+        light += picks[i] == 1 ? 1 : 0;
+    }
+    TEST_ASSERT_EQUAL_UINT8(2, light);
+    // Never two light picks in a row
+    for (uint8_t i = 1; i < 8; i++) {
+        TEST_ASSERT_FALSE(picks[i] == 1 && picks[i - 1] == 1);
+    }
+}
+
+/**
+ * @brief Frames due follow the target rate; a stall is skipped and counted late
+ */
+void test_load_plan_pacing_and_late() {
+    N2kLoadPlan plan;
+    TEST_ASSERT_TRUE(plan.parseMix("130306"));
+    plan.start(1000, 5000);   // One frame per ms
+
+    uint32_t due = plan.framesDue(5000, 64);
+    TEST_ASSERT_EQUAL_UINT32(0, due);
+    due = plan.framesDue(5010, 64);
+    TEST_ASSERT_EQUAL_UINT32(10, due);
+    plan.sent(10);
+    due = plan.framesDue(5010, 64);
+    TEST_ASSERT_EQUAL_UINT32(0, due);
+
+    // 100 frames behind (under two passes): capped at one pass, nothing late
+    due = plan.framesDue(5110, 64);
+    TEST_ASSERT_EQUAL_UINT32(64, due);
+    TEST_ASSERT_EQUAL_UINT32(0, plan.getLate());
+
+    // 200 frames behind (over two passes): one pass sent, the rest late
+    due = plan.framesDue(5210, 64);
+    TEST_ASSERT_EQUAL_UINT32(64, due);
+    TEST_ASSERT_EQUAL_UINT32(136, plan.getLate());
+    plan.sent(64);
+    due = plan.framesDue(5210, 64);
+    TEST_ASSERT_EQUAL_UINT32(0, due);
+    TEST_ASSERT_EQUAL_UINT64(74, plan.getSent());
+}
+
+/**
+ * @brief 100% load of a 250 kbit/s bus is about 1900 frames/s
+ */
+void test_load_plan_frames_per_second() {
+    TEST_ASSERT_UINT32_WITHIN(20, 1900, N2kLoadPlan::framesPerSecond(100));
+    TEST_ASSERT_UINT32_WITHIN(10, 954, N2kLoadPlan::framesPerSecond(50));
+    TEST_ASSERT_EQUAL_UINT32(N2kLoadPlan::framesPerSecond(100), N2kLoadPlan::framesPerSecond(150));
+}
+
+/**
+ * @brief Generated frames reassemble in N2kFastPacketMonitor without loss
+ */
+void test_load_plan_fast_packet_round_trip() {
+    uint32_t id = N2kLoadPlan::canId(3, 129029UL, N2K_LOAD_SOURCE);
+    TEST_ASSERT_EQUAL_UINT32(129029UL, N2kFastPacketMonitor::pgnFromCanId(id));
+    TEST_ASSERT_EQUAL_UINT32(N2K_LOAD_SOURCE, id & 0xFF);
+    TEST_ASSERT_EQUAL_UINT32(3, id >> 26);
+    // PDU1: destination in the identifier, not in the PGN
+    uint32_t request = N2kLoadPlan::canId(6, 59904UL, N2K_LOAD_SOURCE, 0x22);
+    TEST_ASSERT_EQUAL_UINT32(59904UL, N2kFastPacketMonitor::pgnFromCanId(request));
+    TEST_ASSERT_EQUAL_UINT32(0x22, (request >> 8) & 0xFF);
+
+    static N2kPGNTable table;
+    static N2kPGNStats stats;
+    static N2kFastPacketMonitor monitor;
+    table.add(129029L, loadHandler, "GNSS Position Data");
+    table.setFastPacket(129029L, true);
+    monitor.begin(&table, &stats);
+
+    uint8_t data[43];
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+    uint8_t frames[N2kLoadPlan::MAX_FRAMES_PER_MESSAGE][8];
+    for (uint8_t sequence = 0; sequence < 3; sequence++) {
+        uint8_t count = N2kLoadPlan::splitFastPacket(data, sizeof(data), sequence, frames);
+        TEST_ASSERT_EQUAL_UINT8(7, count);
+        for (uint8_t f = 0; f < count; f++) {
+            monitor.observeFrame(id, 8, frames[f], 1000 + sequence * 10 + f);
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(43, frames[0][1]);
+    TEST_ASSERT_EQUAL_UINT8(42, frames[6][2]);    // Last byte, then padding
+    TEST_ASSERT_EQUAL_UINT8(0xFF, frames[6][3]);
+    TEST_ASSERT_EQUAL_UINT32(3, monitor.getCompleted());
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.getFailed());
+
+    TEST_ASSERT_EQUAL_UINT8(1, N2kLoadPlan::frameCount(6, true));
+    TEST_ASSERT_EQUAL_UINT8(2, N2kLoadPlan::frameCount(13, true));
+    TEST_ASSERT_EQUAL_UINT8(3, N2kLoadPlan::frameCount(14, true));
+    TEST_ASSERT_EQUAL_UINT8(0, N2kLoadPlan::splitFastPacket(data, 224, 0, frames));
+}
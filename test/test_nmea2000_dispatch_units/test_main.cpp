@@ -0,0 +1,153 @@
+/**
+ * @file test_main.cpp
+ * @brief Unit tests for NMEA2000 PGN dispatch
+ *
+ * Tests validate:
+ * - N2kPGNTable (sorted insertion, binary search lookup, replacement,
+ *   enable flags, source groups, receive list generation, capacity limit)
+ * - SPSCQueue (ordering, overrun counting, high-water, two-thread handoff)
+ * - LatencyHistogram (bucket layout, min/avg/max, percentiles)
+ * - N2kPGNStats (per-source keys, outcome counters, EWMA rate, overflow, JSON)
+ * - N2kFastPacketMonitor (sequence tracking, loss classification, buffer pool)
+ * - N2kLoadPlan (load generator mix, pacing, fast-packet frame layout)
+ * - N2kFieldDecoder (table-driven PGN layouts: bits, selectors, NA codes, clamping)
+ * - CanBusMonitor (bus load windows and peak, controller error state entries)
+ * - N2kAddressMemory (claimed source address record, NAME check)
+ *
+ * Test Organization:
+ * - test_pgn_table.cpp: handler table semantics
+ * - test_spsc_queue.cpp: receive task -> main loop update handoff
+ * - test_latency_histogram.cpp: receive latency statistics
+ * - test_pgn_stats.cpp: per-PGN statistics table behind /n2k/stats
+ * - test_fast_packet_monitor.cpp: fast-packet reassembly loss counters
+ * - test_load_plan.cpp: synthetic load schedule behind /n2k/load
+ * - test_field_decoder.cpp: battery, DOP and temperature PGNs decoded from their layouts
+ * - test_can_bus_monitor.cpp: bus utilisation and TEC/REC classification
+ * - test_n2k_address_memory.cpp: start address restored at boot, changes persisted
+ */
+
+#include <unity.h>
+
+// Forward declarations for N2kPGNTable tests
+void test_pgn_table_starts_empty();
+void test_pgn_table_keeps_entries_sorted();
+void test_pgn_table_find_returns_handler();
+void test_pgn_table_add_replaces_existing();
+void test_pgn_table_disabled_excluded_from_receive_list();
+void test_pgn_table_receive_list_respects_capacity();
+void test_pgn_table_full_rejects_new_pgn();
+void test_pgn_table_source_group_kept_on_replace();
+
+// Forward declarations for SPSCQueue tests
+void test_spsc_fifo_order();
+void test_spsc_overrun_and_high_water();
+void test_spsc_concurrent_producer_consumer();
+
+// Forward declarations for LatencyHistogram tests
+void test_latency_buckets_cover_range();
+void test_latency_min_avg_max();
+void test_latency_p99_tracks_tail();
+
+// Forward declarations for N2kPGNStats tests
+void test_pgn_stats_keyed_by_pgn_and_source();
+void test_pgn_stats_counts_outcomes();
+void test_pgn_stats_rate_tracks_and_decays();
+void test_pgn_stats_overflow_when_full();
+void test_pgn_stats_entry_json();
+
+// Forward declarations for N2kFastPacketMonitor tests
+void test_fast_packet_pgn_from_can_id();
+void test_fast_packet_complete_sequence();
+void test_fast_packet_losses_counted_per_pgn_and_source();
+void test_fast_packet_no_buffer_when_pool_full();
+
+// Forward declarations for N2kLoadPlan tests
+void test_load_plan_parse_mix();
+void test_load_plan_weighted_interleave();
+void test_load_plan_pacing_and_late();
+void test_load_plan_frames_per_second();
+void test_load_plan_fast_packet_round_trip();
+
+// Forward declarations for N2kFieldDecoder tests
+void test_field_decoder_extract_bits();
+void test_field_decoder_battery_instance_selects_layout();
+void test_field_decoder_na_codes_skip_fields();
+void test_field_decoder_temperature_source_and_clamp();
+void test_field_decoder_layouts_match_patch_selectors();
+
+// Forward declarations for CanBusMonitor tests
+void test_can_bus_monitor_load_windows();
+void test_can_bus_monitor_caps_injected_overload();
+void test_can_bus_monitor_fault_confinement_states();
+
+// Forward declarations for N2kAddressMemory tests
+void test_n2k_address_memory_defaults_without_record();
+void test_n2k_address_memory_record_round_trip();
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // N2kPGNTable tests
+    RUN_TEST(test_pgn_table_starts_empty);
+    RUN_TEST(test_pgn_table_keeps_entries_sorted);
+    RUN_TEST(test_pgn_table_find_returns_handler);
+    RUN_TEST(test_pgn_table_add_replaces_existing);
+    RUN_TEST(test_pgn_table_disabled_excluded_from_receive_list);
+    RUN_TEST(test_pgn_table_receive_list_respects_capacity);
+    RUN_TEST(test_pgn_table_full_rejects_new_pgn);
+    RUN_TEST(test_pgn_table_source_group_kept_on_replace);
+
+    // SPSCQueue tests
+    RUN_TEST(test_spsc_fifo_order);
+    RUN_TEST(test_spsc_overrun_and_high_water);
+    RUN_TEST(test_spsc_concurrent_producer_consumer);
+
+    // LatencyHistogram tests
+    RUN_TEST(test_latency_buckets_cover_range);
+    RUN_TEST(test_latency_min_avg_max);
+    RUN_TEST(test_latency_p99_tracks_tail);
+
+    // N2kPGNStats tests
+    RUN_TEST(test_pgn_stats_keyed_by_pgn_and_source);
+    RUN_TEST(test_pgn_stats_counts_outcomes);
+    RUN_TEST(test_pgn_stats_rate_tracks_and_decays);
+    RUN_TEST(test_pgn_stats_overflow_when_full);
+    RUN_TEST(test_pgn_stats_entry_json);
+
+    // N2kFastPacketMonitor tests
+    RUN_TEST(test_fast_packet_pgn_from_can_id);
+    RUN_TEST(test_fast_packet_complete_sequence);
+    RUN_TEST(test_fast_packet_losses_counted_per_pgn_and_source);
+    RUN_TEST(test_fast_packet_no_buffer_when_pool_full);
+
+    // N2kLoadPlan tests
+    RUN_TEST(test_load_plan_parse_mix);
+    RUN_TEST(test_load_plan_weighted_interleave);
+    RUN_TEST(test_load_plan_pacing_and_late);
+    RUN_TEST(test_load_plan_frames_per_second);
+    RUN_TEST(test_load_plan_fast_packet_round_trip);
+
+    // N2kFieldDecoder tests
+    RUN_TEST(test_field_decoder_extract_bits);
+    RUN_TEST(test_field_decoder_battery_instance_selects_layout);
+    RUN_TEST(test_field_decoder_na_codes_skip_fields);
+    RUN_TEST(test_field_decoder_temperature_source_and_clamp);
+    RUN_TEST(test_field_decoder_layouts_match_patch_selectors);
+
+    // CanBusMonitor tests
+    RUN_TEST(test_can_bus_monitor_load_windows);
+    RUN_TEST(test_can_bus_monitor_caps_injected_overload);
+    RUN_TEST(test_can_bus_monitor_fault_confinement_states);
+
+    // N2kAddressMemory tests
+    RUN_TEST(test_n2k_address_memory_defaults_without_record);
+    RUN_TEST(test_n2k_address_memory_record_round_trip);
+
+    return UNITY_END();
+}
@@ -0,0 +1,57 @@
+/**
+ * @file test_n2k_address_memory.cpp
+ * @brief Unit tests for N2kAddressMemory (record round trip, NAME check, claim changes)
+ */
+
+#include <unity.h>
+#include "../../src/utils/ConfigRecord.cpp"
+#include "../../src/utils/N2kAddressMemory.h"
+#include "../../src/utils/N2kAddressMemory.cpp"
+
+namespace {
+
+const uint64_t NAME = 0xC0788C00E7E01234ULL;
+
+}  // namespace
+
+void test_n2k_address_memory_defaults_without_record() {
+    N2kAddressMemory memory;
+    TEST_ASSERT_EQUAL(ConfigRecordStatus::EMPTY, memory.decodeRecord(nullptr, 0, NAME));
+    TEST_ASSERT_EQUAL_UINT8(N2K_SOURCE_ADDRESS, memory.getStartAddress());
+    TEST_ASSERT_FALSE(memory.isRestored());
+
+    // Nothing stored yet: the first claim is persisted once, a lost claim again
+    TEST_ASSERT_TRUE(memory.claimed(N2K_SOURCE_ADDRESS));
+    TEST_ASSERT_FALSE(memory.claimed(N2K_SOURCE_ADDRESS));
+    TEST_ASSERT_EQUAL_UINT32(0, memory.getChanges());
+    TEST_ASSERT_TRUE(memory.claimed(35));
+    TEST_ASSERT_EQUAL_UINT8(35, memory.getAddress());
+    TEST_ASSERT_EQUAL_UINT32(1, memory.getChanges());
+    TEST_ASSERT_FALSE(memory.claimed(254));                // Cannot claim: keep the last good one
+    TEST_ASSERT_EQUAL_UINT8(35, memory.getAddress());
+}
+
+void test_n2k_address_memory_record_round_trip() {
+    N2kAddressMemory first;
+    first.decodeRecord(nullptr, 0, NAME);
+    first.claimed(35);
+    uint8_t record[CONFIG_RECORD_MAX_BYTES];
+    size_t length = first.encodeRecord(record, sizeof(record));
+    TEST_ASSERT_TRUE(length > 0);
+
+    N2kAddressMemory next;
+    TEST_ASSERT_EQUAL(ConfigRecordStatus::OK, next.decodeRecord(record, length, NAME));
+    TEST_ASSERT_EQUAL_UINT8(35, next.getStartAddress());
+    TEST_ASSERT_TRUE(next.isRestored());
+    TEST_ASSERT_FALSE(next.claimed(35));  // Joined where it left: no write
+
+    // Same record, other NAME: claim starts over at the default
+    N2kAddressMemory other;
+    TEST_ASSERT_EQUAL(ConfigRecordStatus::EMPTY, other.decodeRecord(record, length, NAME + 1));
+    TEST_ASSERT_EQUAL_UINT8(N2K_SOURCE_ADDRESS, other.getStartAddress());
+    TEST_ASSERT_FALSE(other.isRestored());
+
+    TEST_ASSERT_EQUAL(ConfigRecordStatus::TRUNCATED, other.decodeRecord(record, 3, NAME));
+    record[length - 1] ^= 0x01;
+    TEST_ASSERT_EQUAL(ConfigRecordStatus::BAD_CRC, other.decodeRecord(record, length, NAME));
+}
@@ -0,0 +1,139 @@
+/**
+ * @file test_pgn_stats.cpp
+ * @brief Unit tests for N2kPGNStats (per-PGN, per-source statistics)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/components/N2kPGNStats.h"
+#include "../../src/components/N2kPGNStats.cpp"
+#include "../../src/utils/JsonWriter.cpp"
+
+/**
+ * @brief Same PGN from two sources is tracked as two entries
+ */
+void test_pgn_stats_keyed_by_pgn_and_source() {
+    static N2kPGNStats stats;
+    stats.reset();
+
+    stats.recordHandled(129025, 3, N2kHandlerResult::UPDATED, 50, 1000);
+    stats.recordHandled(129025, 3, N2kHandlerResult::UPDATED, 70, 1100);
+    stats.recordHandled(129025, 7, N2kHandlerResult::UPDATED, 40, 1100);
+    stats.recordUnhandled(60928, 3, 1200);
+
+    TEST_ASSERT_EQUAL_UINT8(3, stats.getEntryCount());
+    TEST_ASSERT_EQUAL_UINT32(4, stats.getTotalReceived());
+
+    const N2kPGNStatsEntry* a = stats.find(129025, 3);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_UINT32(2, a->received);
+    TEST_ASSERT_TRUE(a->handled);
+    TEST_ASSERT_EQUAL_UINT32(120, (uint32_t)a->handlerUsTotal);
+    TEST_ASSERT_EQUAL_UINT32(70, a->handlerUsPeak);
+
+    const N2kPGNStatsEntry* b = stats.find(129025, 7);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_UINT32(1, b->received);
+
+    const N2kPGNStatsEntry* c = stats.find(60928, 3);
+    TEST_ASSERT_NOT_NULL(c);
+    TEST_ASSERT_FALSE(c->handled);
+
+    TEST_ASSERT_NULL(stats.find(129025, 4));
+}
+
+/**
+ * @brief Handler outcomes land in the matching counters
+ */
+void test_pgn_stats_counts_outcomes() {
+    static N2kPGNStats stats;
+    stats.reset();
+
+    stats.recordHandled(130306, 1, N2kHandlerResult::UPDATED, 10, 0);
+    stats.recordHandled(130306, 1, N2kHandlerResult::PARSE_FAILED, 10, 10);
+    stats.recordHandled(130306, 1, N2kHandlerResult::NOT_AVAILABLE, 10, 20);
+    stats.recordHandled(130306, 1, N2kHandlerResult::NOT_AVAILABLE, 10, 30);
+    stats.recordHandled(130306, 1, N2kHandlerResult::IGNORED, 10, 40);
+    stats.recordHandled(130306, 1, N2kHandlerResult::COALESCED, 10, 50);
+
+    const N2kPGNStatsEntry* e = stats.find(130306, 1);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT32(6, e->received);
+    TEST_ASSERT_EQUAL_UINT32(1, e->parseFailures);
+    TEST_ASSERT_EQUAL_UINT32(2, e->notAvailable);
+    TEST_ASSERT_EQUAL_UINT32(1, e->ignored);
+    TEST_ASSERT_EQUAL_UINT32(1, e->coalesced);
+}
+
+/**
+ * @brief EWMA rate converges to the arrival rate and decays when silent
+ */
+void test_pgn_stats_rate_tracks_and_decays() {
+    static N2kPGNStats stats;
+    stats.reset();
+
+    uint32_t now = 0;
+    for (int i = 0; i < 50; i++) {
+        stats.recordHandled(127250, 2, N2kHandlerResult::UPDATED, 5, now);
+        now += 100;  // 10 Hz
+    }
+    now -= 100;
+
+    const N2kPGNStatsEntry* e = stats.find(127250, 2);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 10.0f, N2kPGNStats::rateHz(*e, now));
+
+    // No frames for 2 s: rate drops to 1 / 2 s
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.5f, N2kPGNStats::rateHz(*e, now + 2000));
+
+    // Single frame: no rate yet
+    stats.recordHandled(127251, 2, N2kHandlerResult::UPDATED, 5, now);
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, N2kPGNStats::rateHz(*stats.find(127251, 2), now));
+}
+
+/**
+ * @brief A full table counts new pairs as overflow and keeps existing ones
+ */
+void test_pgn_stats_overflow_when_full() {
+    static N2kPGNStats stats;
+    stats.reset();
+
+    for (uint32_t i = 0; i < N2kPGNStats::MAX_ENTRIES; i++) {
+        stats.recordUnhandled(126208 + i, 1, 0);
+    }
+    TEST_ASSERT_EQUAL_UINT8(N2kPGNStats::MAX_ENTRIES, stats.getEntryCount());
+
+    stats.recordUnhandled(200000, 1, 0);
+    stats.recordUnhandled(200000, 1, 0);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.getOverflowCount());
+    TEST_ASSERT_NULL(stats.find(200000, 1));
+
+    stats.recordUnhandled(126208, 1, 0);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.find(126208, 1)->received);
+
+    uint8_t visited = 0;
+    stats.forEach([&](const N2kPGNStatsEntry&) { visited++; });
+    TEST_ASSERT_EQUAL_UINT8(N2kPGNStats::MAX_ENTRIES, visited);
+}
+
+/**
+ * @brief Entry JSON carries the documented fields
+ */
+void test_pgn_stats_entry_json() {
+    static N2kPGNStats stats;
+    stats.reset();
+
+    stats.recordHandled(128267, 35, N2kHandlerResult::NOT_AVAILABLE, 120, 1000);
+    stats.recordHandled(128267, 35, N2kHandlerResult::UPDATED, 80, 2000);
+
+    StaticJsonWriter<512> out;
+    N2kPGNStats::writeEntry(out, *stats.find(128267, 35), 2000);
+
+    TEST_ASSERT_FALSE(out.overflowed());
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"pgn\":128267,\"src\":35,\"handled\":true,\"count\":2,\"rate_hz\":1.00,"
+        "\"parse_failures\":0,\"na\":1,\"ignored\":0,\"inactive\":0,\"coalesced\":0,"
+        "\"fp_incomplete\":0,\"fp_timeout\":0,\"fp_out_of_order\":0,\"fp_no_buffer\":0,\"handler_us_total\":200,"
+        "\"handler_us_peak\":120,\"last_rx_ms_ago\":0}",
+        out.c_str());
+}
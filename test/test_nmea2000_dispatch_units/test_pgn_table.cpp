@@ -0,0 +1,158 @@
+/**
+ * @file test_pgn_table.cpp
+ * @brief Unit tests for N2kPGNTable (registrable PGN handler table)
+ */
+
+#include <unity.h>
+#include "../../src/components/N2kPGNTable.h"
+#include "../../src/components/N2kPGNTable.cpp"
+
+// tN2kMsg is only forward-declared natively, so handlers are compared, not called
+static N2kHandlerResult handlerA(const tN2kMsg&, BoatData*, WebSocketLogger*) {
+    return N2kHandlerResult::UPDATED;
+}
+
+static N2kHandlerResult handlerB(const tN2kMsg&, BoatData*, WebSocketLogger*) {
+    return N2kHandlerResult::IGNORED;
+}
+
+/**
+ * @brief New table has no entries and an empty receive list
+ */
+void test_pgn_table_starts_empty() {
+    N2kPGNTable table;
+    unsigned long list[4] = {1, 1, 1, 1};
+
+    TEST_ASSERT_EQUAL_UINT8(0, table.count());
+    TEST_ASSERT_NULL(table.find(129025L));
+    TEST_ASSERT_EQUAL_UINT8(0, table.buildReceiveList(list, 4));
+    TEST_ASSERT_EQUAL_UINT32(0, list[0]);
+}
+
+/**
+ * @brief Entries added in any order are stored ascending by PGN
+ */
+void test_pgn_table_keeps_entries_sorted() {
+    N2kPGNTable table;
+    TEST_ASSERT_TRUE(table.add(130306L, handlerA, "Wind Data"));
+    TEST_ASSERT_TRUE(table.add(127250L, handlerA, "Vessel Heading"));
+    TEST_ASSERT_TRUE(table.add(129025L, handlerA, "Position, Rapid Update"));
+    TEST_ASSERT_TRUE(table.add(127251L, handlerA, "Rate of Turn"));
+
+    TEST_ASSERT_EQUAL_UINT8(4, table.count());
+    TEST_ASSERT_EQUAL_UINT32(127250L, table.entry(0).pgn);
+    TEST_ASSERT_EQUAL_UINT32(127251L, table.entry(1).pgn);
+    TEST_ASSERT_EQUAL_UINT32(129025L, table.entry(2).pgn);
+    TEST_ASSERT_EQUAL_UINT32(130306L, table.entry(3).pgn);
+}
+
+/**
+ * @brief find() returns the registered entry; unknown PGNs return nullptr
+ */
+void test_pgn_table_find_returns_handler() {
+    N2kPGNTable table;
+    table.add(128267L, handlerA, "Water Depth");
+    table.add(128259L, handlerB, "Speed (Water Referenced)");
+
+    const N2kPGNEntry* entry = table.find(128259L);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_STRING("Speed (Water Referenced)", entry->name);
+    TEST_ASSERT_TRUE(entry->handler == handlerB);
+    TEST_ASSERT_TRUE(table.find(128267L)->handler == handlerA);
+
+    TEST_ASSERT_NULL(table.find(128260L));
+    TEST_ASSERT_NULL(table.find(0));
+}
+
+/**
+ * @brief Adding an existing PGN replaces its handler without growing the table
+ */
+void test_pgn_table_add_replaces_existing() {
+    N2kPGNTable table;
+    table.add(127488L, handlerA, "Engine Parameters, Rapid Update");
+    TEST_ASSERT_TRUE(table.add(127488L, handlerB, "Engine Rapid (custom)", false));
+
+    TEST_ASSERT_EQUAL_UINT8(1, table.count());
+    const N2kPGNEntry* entry = table.find(127488L);
+    TEST_ASSERT_TRUE(entry->handler == handlerB);
+    TEST_ASSERT_FALSE(entry->enabled);
+
+    TEST_ASSERT_FALSE(table.add(127489L, nullptr, "Null handler"));
+    TEST_ASSERT_EQUAL_UINT8(1, table.count());
+}
+
+/**
+ * @brief Disabled PGNs stay registered but are left out of the receive list
+ */
+void test_pgn_table_disabled_excluded_from_receive_list() {
+    N2kPGNTable table;
+    table.add(129029L, handlerA, "GNSS Position Data");
+    table.add(127252L, handlerA, "Heave");
+    table.add(130316L, handlerA, "Temperature Extended Range");
+
+    TEST_ASSERT_TRUE(table.setEnabled(127252L, false));
+    TEST_ASSERT_FALSE(table.setEnabled(127253L, false));
+
+    unsigned long list[8];
+    TEST_ASSERT_EQUAL_UINT8(2, table.buildReceiveList(list, 8));
+    TEST_ASSERT_EQUAL_UINT32(129029L, list[0]);
+    TEST_ASSERT_EQUAL_UINT32(130316L, list[1]);
+    TEST_ASSERT_EQUAL_UINT32(0, list[2]);
+
+    TEST_ASSERT_EQUAL_UINT8(3, table.count());
+    TEST_ASSERT_EQUAL_UINT8(2, table.enabledCount());
+    TEST_ASSERT_NOT_NULL(table.find(127252L));
+    TEST_ASSERT_FALSE(table.find(127252L)->enabled);
+}
+
+/**
+ * @brief Receive list is truncated to the buffer and always terminated
+ */
+void test_pgn_table_receive_list_respects_capacity() {
+    N2kPGNTable table;
+    table.add(127250L, handlerA, "A");
+    table.add(127251L, handlerA, "B");
+    table.add(127257L, handlerA, "C");
+
+    unsigned long list[3] = {9, 9, 9};
+    TEST_ASSERT_EQUAL_UINT8(2, table.buildReceiveList(list, 3));
+    TEST_ASSERT_EQUAL_UINT32(127250L, list[0]);
+    TEST_ASSERT_EQUAL_UINT32(127251L, list[1]);
+    TEST_ASSERT_EQUAL_UINT32(0, list[2]);
+}
+
+/**
+ * @brief A full table rejects new PGNs but still accepts replacements
+ */
+void test_pgn_table_full_rejects_new_pgn() {
+    N2kPGNTable table;
+    for (uint8_t i = 0; i < N2kPGNTable::CAPACITY; i++) {
+        TEST_ASSERT_TRUE(table.add(126000L + i * 10, handlerA, "Filler"));
+    }
+
+    TEST_ASSERT_FALSE(table.add(125000L, handlerA, "Overflow"));
+    TEST_ASSERT_EQUAL_UINT8(N2kPGNTable::CAPACITY, table.count());
+    TEST_ASSERT_TRUE(table.add(126000L, handlerB, "Replacement"));
+    TEST_ASSERT_EQUAL_UINT32(126000L, table.entry(0).pgn);
+    TEST_ASSERT_NULL(table.find(125000L));
+}
+
+/**
+ * @brief Source groups default to NONE and survive handler replacement
+ */
+void test_pgn_table_source_group_kept_on_replace() {
+    N2kPGNTable table;
+    table.add(129025L, handlerA, "Position, Rapid Update");
+    TEST_ASSERT_TRUE(table.find(129025L)->sourceGroup == N2kSourceGroup::NONE);
+
+    TEST_ASSERT_TRUE(table.setSourceGroup(129025L, N2kSourceGroup::GPS));
+    TEST_ASSERT_FALSE(table.setSourceGroup(127250L, N2kSourceGroup::COMPASS));
+    TEST_ASSERT_FALSE(table.find(129025L)->fastPacket);
+    TEST_ASSERT_TRUE(table.setFastPacket(129025L, true));
+    TEST_ASSERT_FALSE(table.setFastPacket(127250L, true));
+
+    table.add(129025L, handlerB, "Position, Rapid Update");
+    TEST_ASSERT_TRUE(table.find(129025L)->handler == handlerB);
+    TEST_ASSERT_TRUE(table.find(129025L)->sourceGroup == N2kSourceGroup::GPS);
+    TEST_ASSERT_TRUE(table.find(129025L)->fastPacket);
+}
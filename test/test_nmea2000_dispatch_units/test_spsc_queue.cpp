@@ -0,0 +1,89 @@
+/**
+ * @file test_spsc_queue.cpp
+ * @brief Unit tests for SPSCQueue (receive task -> main loop handoff)
+ */
+
+#include <unity.h>
+#include <thread>
+#include "../../src/utils/SPSCQueue.h"
+
+/**
+ * @brief Values come out in push order; empty queue pops nothing
+ */
+void test_spsc_fifo_order() {
+    SPSCQueue<uint32_t, 8> queue;
+    uint32_t value = 0;
+
+    TEST_ASSERT_FALSE(queue.pop(value));
+    for (uint32_t i = 1; i <= 5; i++) {
+        TEST_ASSERT_TRUE(queue.push(i));
+    }
+    TEST_ASSERT_EQUAL_UINT32(5, queue.size());
+
+    for (uint32_t i = 1; i <= 5; i++) {
+        TEST_ASSERT_TRUE(queue.pop(value));
+        TEST_ASSERT_EQUAL_UINT32(i, value);
+    }
+    TEST_ASSERT_FALSE(queue.pop(value));
+    TEST_ASSERT_EQUAL_UINT32(0, queue.size());
+}
+
+/**
+ * @brief Full queue rejects and counts pushes; high-water tracks peak depth
+ */
+void test_spsc_overrun_and_high_water() {
+    SPSCQueue<uint32_t, 4> queue;
+    uint32_t value = 0;
+
+    for (uint32_t i = 0; i < 4; i++) {
+        TEST_ASSERT_TRUE(queue.push(i));
+    }
+    TEST_ASSERT_FALSE(queue.push(99));
+    TEST_ASSERT_FALSE(queue.push(100));
+    TEST_ASSERT_EQUAL_UINT32(2, queue.getDroppedCount());
+    TEST_ASSERT_EQUAL_UINT32(4, queue.getHighWater());
+
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL_UINT32(0, value);
+    TEST_ASSERT_TRUE(queue.push(4));
+
+    // Drain and refill across the wrap point: high-water stays at the peak
+    while (queue.pop(value)) {
+    }
+    TEST_ASSERT_EQUAL_UINT32(4, value);
+    TEST_ASSERT_TRUE(queue.push(5));
+    TEST_ASSERT_EQUAL_UINT32(4, queue.getHighWater());
+}
+
+/**
+ * @brief One producer thread and one consumer thread see every value in order
+ */
+void test_spsc_concurrent_producer_consumer() {
+    static SPSCQueue<uint32_t, 16> queue;
+    const uint32_t total = 100000;
+
+    std::thread producer([&]() {
+        for (uint32_t i = 0; i < total; i++) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    bool inOrder = true;
+    while (expected < total) {
+        uint32_t value;
+        if (queue.pop(value)) {
+            inOrder = inOrder && (value == expected);
+            expected++;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+
+    TEST_ASSERT_TRUE(inOrder);
+    TEST_ASSERT_EQUAL_UINT32(0, queue.size());
+    TEST_ASSERT_TRUE(queue.getHighWater() <= 16);
+}
@@ -145,6 +145,29 @@ void test_print_renders_text() {
     delete mockDisplay;
 }
 
+/**
+ * @brief Test: drawBigNumber() writes atlas columns at the page and counts as rendered text
+ */
+void test_drawBigNumber_writes_page_aligned_glyphs() {
+    mockDisplay = new MockDisplayAdapter();
+    mockDisplay->clear();
+
+    mockDisplay->drawBigNumber(44, 2, " 1");
+
+    const uint8_t* frame = mockDisplay->getFramebuffer();
+    TEST_ASSERT_EQUAL_UINT8(0x00, frame[2 * 128 + 44]);           // Space: blank cell
+    TEST_ASSERT_EQUAL_UINT8(0x0C, frame[2 * 128 + 56 + 2]);       // '1' column 0x42 doubled: rows 2-3
+    TEST_ASSERT_EQUAL_UINT8(0x30, frame[3 * 128 + 56 + 2]);       // ... and rows 12-13 on the next page
+    TEST_ASSERT_EQUAL_UINT8(0x00, frame[1 * 128 + 56 + 2]);       // Pages around it untouched
+    TEST_ASSERT_EQUAL_INT(1, mockDisplay->getBigNumberCalls());
+    TEST_ASSERT_TRUE(mockDisplay->wasTextRendered(" 1"));
+
+    mockDisplay->clear();
+    TEST_ASSERT_EQUAL_UINT8(0x00, frame[3 * 128 + 56 + 2]);
+
+    delete mockDisplay;
+}
+
 /**
  * @brief Test: display() pushes buffer to hardware
  */
@@ -119,3 +119,30 @@ void test_getMillis_returns_increasing_value() {
 
     delete mockMetrics;
 }
+
+/**
+ * @brief Test: heap fragmentation metrics stay within the free heap
+ *
+ * The largest free block never exceeds the free heap; the rates are
+ * HEAP_RATE_UNKNOWN unless the allocator hooks count them.
+ */
+void test_heap_fragmentation_metrics_within_free_heap() {
+    mockMetrics = new MockSystemMetrics();
+
+    TEST_ASSERT_TRUE(mockMetrics->getLargestFreeBlockBytes() <= mockMetrics->getFreeHeapBytes());
+    TEST_ASSERT_TRUE(mockMetrics->getMinFreeHeapBytes() <= mockMetrics->getFreeHeapBytes());
+    TEST_ASSERT_EQUAL_UINT32(HEAP_RATE_UNKNOWN, mockMetrics->getHeapAllocsPerSecond());
+    TEST_ASSERT_EQUAL_UINT32(HEAP_RATE_UNKNOWN, mockMetrics->getHeapFreesPerSecond());
+
+    // Fragmented: 60 KB free, no piece larger than 2 KB
+    mockMetrics->setFreeHeapBytes(61440);
+    mockMetrics->setLargestFreeBlockBytes(2036);
+    mockMetrics->setMinFreeHeapBytes(40212);
+    mockMetrics->setHeapRates(412, 409);
+    TEST_ASSERT_EQUAL_UINT32(2036, mockMetrics->getLargestFreeBlockBytes());
+    TEST_ASSERT_EQUAL_UINT32(40212, mockMetrics->getMinFreeHeapBytes());
+    TEST_ASSERT_EQUAL_UINT32(412, mockMetrics->getHeapAllocsPerSecond());
+    TEST_ASSERT_EQUAL_UINT32(409, mockMetrics->getHeapFreesPerSecond());
+
+    delete mockMetrics;
+}
@@ -24,6 +24,7 @@ void test_clear_does_not_crash_before_init();
 void test_setCursor_accepts_valid_coordinates();
 void test_setTextSize_accepts_valid_sizes();
 void test_print_renders_text();
+void test_drawBigNumber_writes_page_aligned_glyphs();
 void test_display_pushes_buffer();
 
 // ISystemMetrics contract tests
@@ -32,6 +33,7 @@ void test_getSketchSizeBytes_returns_positive_value();
 void test_getFreeFlashBytes_returns_valid_value();
 void test_getCpuIdlePercent_returns_0_to_100();
 void test_getMillis_returns_increasing_value();
+void test_heap_fragmentation_metrics_within_free_heap();
 
 /**
  * @brief Set up test environment before each test
@@ -62,6 +64,7 @@ int main(int argc, char **argv) {
     RUN_TEST(test_setCursor_accepts_valid_coordinates);
     RUN_TEST(test_setTextSize_accepts_valid_sizes);
     RUN_TEST(test_print_renders_text);
+    RUN_TEST(test_drawBigNumber_writes_page_aligned_glyphs);
     RUN_TEST(test_display_pushes_buffer);
 
     // ISystemMetrics contract tests
@@ -70,6 +73,7 @@ int main(int argc, char **argv) {
     RUN_TEST(test_getFreeFlashBytes_returns_valid_value);
     RUN_TEST(test_getCpuIdlePercent_returns_0_to_100);
     RUN_TEST(test_getMillis_returns_increasing_value);
+    RUN_TEST(test_heap_fragmentation_metrics_within_free_heap);
 
     return UNITY_END();
 }
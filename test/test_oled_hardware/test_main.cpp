@@ -170,6 +170,11 @@ void test_cpu_idle_calculation() {
     // Log value for visibility
     Serial.printf("CPU idle: %d%%\n", cpuIdle);
 
+    // No window completed yet right after boot
+    if (cpuIdle == CPU_IDLE_UNKNOWN) {
+        TEST_IGNORE_MESSAGE("CPU idle not measured yet (first 5 s window)");
+    }
+
     // Verify value is in valid range (0-100)
     TEST_ASSERT_GREATER_OR_EQUAL_MESSAGE(0, cpuIdle,
         "CPU idle % should be >= 0");
@@ -0,0 +1,64 @@
+/**
+ * @file test_big_digit_font.cpp
+ * @brief Unit tests for the BigDigitFont atlas and framebuffer blit
+ *
+ * Tests validate:
+ * - Generated glyphs are the 5x7 base glyphs doubled in both directions (text size 2 look)
+ * - Opaque drawing over an older number, blank cells for unknown characters, clipping at the edges
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "utils/BigDigitFont.h"
+
+namespace {
+
+/// Pixel (x, y) of a page-major framebuffer
+bool pixel(const uint8_t* frame, uint8_t x, uint8_t y) {
+    return (frame[(y / 8) * OLED_SCREEN_WIDTH + x] >> (y % 8)) & 1;
+}
+
+}  // namespace
+
+/**
+ * @brief Test: every atlas pixel equals the base 5x7 pixel at (x / 2, y / 2)
+ */
+void test_big_digit_atlas_doubles_base_glyphs() {
+    static const uint8_t BASE_8[5] = {0x36, 0x49, 0x49, 0x49, 0x36};
+    const uint8_t (*eight)[BIG_DIGIT_WIDTH] = BigDigitAtlas()[BigDigitIndex('8')];
+
+    for (uint8_t x = 0; x < BIG_DIGIT_WIDTH; x++) {
+        for (uint8_t y = 0; y < BIG_DIGIT_HEIGHT; y++) {
+            bool expected = x < 10 && ((BASE_8[x / 2] >> (y / 2)) & 1);
+            bool actual = (eight[y / 8][x] >> (y % 8)) & 1;
+            TEST_ASSERT_EQUAL_MESSAGE(expected, actual, "atlas pixel differs from the doubled base glyph");
+        }
+    }
+    TEST_ASSERT_EQUAL_UINT8(12, BigDigitIndex('x'));
+    TEST_ASSERT_EQUAL_UINT8(10, BigDigitIndex('-'));
+}
+
+/**
+ * @brief Test: drawing replaces older digits, unknown characters blank their cell, edges clip
+ */
+void test_big_digit_draw_opaque_and_clipped() {
+    uint8_t frame[OLED_SCREEN_WIDTH * OLED_SCREEN_HEIGHT / 8];
+    memset(frame, 0xFF, sizeof(frame));
+
+    TEST_ASSERT_EQUAL_UINT8(36, BigDigitDraw(frame, 0, 2, "8?."));
+    TEST_ASSERT_TRUE(pixel(frame, 2, 16));          // '8' top bar
+    TEST_ASSERT_FALSE(pixel(frame, 10, 16));        // Spacing column cleared
+    TEST_ASSERT_FALSE(pixel(frame, 12 + 4, 20));    // '?' drawn blank
+    TEST_ASSERT_TRUE(pixel(frame, 24 + 3, 29));     // '.' dot in the bottom rows
+    TEST_ASSERT_TRUE(pixel(frame, 0, 15));          // Page above untouched
+    TEST_ASSERT_TRUE(pixel(frame, 0, 32));          // Page below untouched
+
+    // Right edge: the last character is cut to the remaining columns
+    TEST_ASSERT_EQUAL_UINT8(8, BigDigitDraw(frame, 120, 0, "11"));
+    // Bottom edge: only page 7 is written, nothing past the buffer
+    TEST_ASSERT_EQUAL_UINT8(12, BigDigitDraw(frame, 0, 7, "-"));
+    TEST_ASSERT_EQUAL_UINT8(0, BigDigitDraw(frame, 0, 8, "1"));
+    TEST_ASSERT_EQUAL_UINT8(0, BigDigitDraw(nullptr, 0, 0, "1"));
+}
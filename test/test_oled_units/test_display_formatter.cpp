@@ -78,6 +78,16 @@ void test_formatPercent_handles_0_and_100() {
     TEST_ASSERT_TRUE(strstr(buffer, "%") != nullptr);
 }
 
+/**
+ * @brief Test: formatPercent() shows a placeholder before the first measurement
+ */
+void test_formatPercent_unknown_placeholder() {
+    char buffer[5];
+
+    formatPercent(255, buffer);  // CPU_IDLE_UNKNOWN
+    TEST_ASSERT_EQUAL_STRING("---", buffer);
+}
+
 /**
  * @brief Test: formatIPAddress() formats correctly
  */
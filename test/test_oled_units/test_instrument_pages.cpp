@@ -0,0 +1,98 @@
+/**
+ * @file test_instrument_pages.cpp
+ * @brief Unit tests for the instrument page field cache and page selection
+ *
+ * Tests validate:
+ * - Values are converted to display units; a change below the last digit neither reformats nor redraws
+ * - Pages rotate on the timer, a button press skips ahead and restarts it; the reactions page is optional
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "utils/InstrumentPages.h"
+#include "utils/InstrumentPages.cpp"
+
+/**
+ * @brief Test: quantized values are formatted once per visible change, "---" when unavailable
+ */
+void test_instrument_cache_formats_only_visible_changes() {
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.dst.available = true;
+    data.dst.depth = 12.34;
+    data.dst.measuredBoatSpeed = 3.0;                 // m/s
+    data.wind.available = true;
+    data.wind.apparentWindAngle = -0.7853981633974483; // 45 deg to port
+    data.derived.available = true;
+    data.derived.wdir = 6.27;                         // 359.2 deg
+
+    double value = 0;
+    TEST_ASSERT_TRUE(InstrumentFieldValue(InstrumentField::STW, data, value));
+    TEST_ASSERT_FLOAT_WITHIN(0.001, 5.832, value);
+    TEST_ASSERT_FALSE(InstrumentFieldValue(InstrumentField::BATTERY_V, data, value));
+
+    InstrumentFieldCache cache;
+    TEST_ASSERT_TRUE(InstrumentFieldValue(InstrumentField::DEPTH, data, value));
+    TEST_ASSERT_TRUE(cache.update(InstrumentField::DEPTH, true, value));
+    TEST_ASSERT_EQUAL_STRING("  12.3", cache.text(InstrumentField::DEPTH));
+    TEST_ASSERT_FALSE(cache.update(InstrumentField::DEPTH, true, 12.31));  // Same digits: no snprintf
+    TEST_ASSERT_EQUAL_UINT32(1, cache.getFormats());
+    TEST_ASSERT_TRUE(cache.update(InstrumentField::DEPTH, true, 12.36));
+    TEST_ASSERT_EQUAL_STRING("  12.4", cache.text(InstrumentField::DEPTH));
+
+    // Signed angle, wrapped direction, negative tenths
+    InstrumentFieldValue(InstrumentField::AWA, data, value);
+    TEST_ASSERT_TRUE(cache.update(InstrumentField::AWA, true, value));
+    TEST_ASSERT_EQUAL_STRING("   -45", cache.text(InstrumentField::AWA));
+    InstrumentFieldValue(InstrumentField::TWD, data, value);
+    cache.update(InstrumentField::TWD, true, value);
+    TEST_ASSERT_EQUAL_STRING("   359", cache.text(InstrumentField::TWD));
+    cache.update(InstrumentField::TWD, true, 359.7);
+    TEST_ASSERT_EQUAL_STRING("     0", cache.text(InstrumentField::TWD));
+    cache.update(InstrumentField::BATTERY_A, true, -0.4);
+    TEST_ASSERT_EQUAL_STRING("  -0.4", cache.text(InstrumentField::BATTERY_A));
+
+    // Unavailable once, then unchanged; invalidate() redraws everything
+    TEST_ASSERT_TRUE(cache.update(InstrumentField::DEPTH, false, 0));
+    TEST_ASSERT_EQUAL_STRING("   ---", cache.text(InstrumentField::DEPTH));
+    TEST_ASSERT_FALSE(cache.update(InstrumentField::DEPTH, true, NAN));
+    cache.invalidate();
+    TEST_ASSERT_TRUE(cache.update(InstrumentField::DEPTH, false, 0));
+}
+
+/**
+ * @brief Test: timed rotation, button edge, reactions page skipped when disabled
+ */
+void test_display_pager_rotation_and_button() {
+    DisplayPager pager(10000, false);
+    TEST_ASSERT_FALSE(pager.poll(false, 500));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OledPage::STATUS), static_cast<uint8_t>(pager.page()));
+    TEST_ASSERT_TRUE(pager.poll(false, 10500));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OledPage::SPEED_DEPTH), static_cast<uint8_t>(pager.page()));
+
+    // Held button: one page per press, and the rotation timer restarts
+    TEST_ASSERT_TRUE(pager.poll(true, 12000));
+    TEST_ASSERT_FALSE(pager.poll(true, 12100));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OledPage::APPARENT_WIND), static_cast<uint8_t>(pager.page()));
+    TEST_ASSERT_FALSE(pager.poll(false, 21000));
+    TEST_ASSERT_TRUE(pager.poll(false, 22000));
+    TEST_ASSERT_EQUAL_UINT32(1, pager.getPresses());  // TRUE_WIND
+
+    // Wraps from the last page back to the status page
+    TEST_ASSERT_TRUE(pager.poll(true, 22100));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OledPage::BATTERY), static_cast<uint8_t>(pager.page()));
+    pager.poll(false, 22200);
+    TEST_ASSERT_TRUE(pager.poll(true, 22300));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OledPage::STATUS), static_cast<uint8_t>(pager.page()));
+    TEST_ASSERT_FALSE(IsInstrumentPage(pager.page()));
+    TEST_ASSERT_NULL(GetInstrumentPageSpec(pager.page()));
+
+    // Button only, reactions page included
+    DisplayPager manual(0, true);
+    TEST_ASSERT_FALSE(manual.poll(false, 100000));
+    TEST_ASSERT_TRUE(manual.poll(true, 100100));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OledPage::REACTIONS), static_cast<uint8_t>(manual.page()));
+    TEST_ASSERT_EQUAL_STRING("TRUE WIND", GetInstrumentPageSpec(OledPage::TRUE_WIND)->title);
+}
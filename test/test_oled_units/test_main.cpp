@@ -4,7 +4,8 @@
  *
  * Tests utility functions and component logic in isolation.
  * Validates DisplayLayout formatting, MetricsCollector logic,
- * and DisplayFormatter string operations.
+ * DisplayFormatter string operations, OledDirtyRegion spans,
+ * instrument page caching and the big digit atlas.
  *
  * Run: pio test -e native -f test_oled_units
  *
@@ -26,6 +27,7 @@ void test_formatBytes_handles_small_values();
 void test_formatBytes_handles_large_values();
 void test_formatPercent_formats_correctly();
 void test_formatPercent_handles_0_and_100();
+void test_formatPercent_unknown_placeholder();
 void test_formatIPAddress_formats_correctly();
 void test_formatIPAddress_handles_empty();
 
@@ -41,6 +43,18 @@ void test_no_dynamic_allocation_in_formatter();
 void test_progmem_strings_used();
 void test_efficient_data_types_used();
 
+// OledDirtyRegion tests (partial display updates)
+void test_dirty_region_icon_spans_two_pages();
+void test_dirty_region_merge_clip_and_full();
+
+// Instrument page tests (change-driven rendering)
+void test_instrument_cache_formats_only_visible_changes();
+void test_display_pager_rotation_and_button();
+
+// BigDigitFont tests (digit atlas blits)
+void test_big_digit_atlas_doubles_base_glyphs();
+void test_big_digit_draw_opaque_and_clipped();
+
 /**
  * @brief Set up test environment before each test
  */
@@ -72,6 +86,7 @@ int main(int argc, char **argv) {
     RUN_TEST(test_formatBytes_handles_large_values);
     RUN_TEST(test_formatPercent_formats_correctly);
     RUN_TEST(test_formatPercent_handles_0_and_100);
+    RUN_TEST(test_formatPercent_unknown_placeholder);
     RUN_TEST(test_formatIPAddress_formats_correctly);
     RUN_TEST(test_formatIPAddress_handles_empty);
 
@@ -87,5 +102,17 @@ int main(int argc, char **argv) {
     RUN_TEST(test_progmem_strings_used);
     RUN_TEST(test_efficient_data_types_used);
 
+    // OledDirtyRegion tests (partial display updates)
+    RUN_TEST(test_dirty_region_icon_spans_two_pages);
+    RUN_TEST(test_dirty_region_merge_clip_and_full);
+
+    // Instrument page tests (change-driven rendering)
+    RUN_TEST(test_instrument_cache_formats_only_visible_changes);
+    RUN_TEST(test_display_pager_rotation_and_button);
+
+    // BigDigitFont tests (digit atlas blits)
+    RUN_TEST(test_big_digit_atlas_doubles_base_glyphs);
+    RUN_TEST(test_big_digit_draw_opaque_and_clipped);
+
     return UNITY_END();
 }
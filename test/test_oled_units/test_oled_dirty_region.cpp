@@ -0,0 +1,64 @@
+/**
+ * @file test_oled_dirty_region.cpp
+ * @brief Unit tests for OledDirtyRegion (partial SSD1306 updates)
+ *
+ * Tests validate:
+ * - A character drawn across two pages dirties only its columns on those pages
+ * - Spans grow to cover every change on a page; clipping, markAll() and clear()
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include "utils/OledDirtyRegion.h"
+#include "utils/OledDirtyRegion.cpp"
+
+/**
+ * @brief Test: the animation icon (6x8 at 118,50) dirties 6 columns of pages 6 and 7
+ */
+void test_dirty_region_icon_spans_two_pages() {
+    OledDirtyRegion region;
+    TEST_ASSERT_FALSE(region.isDirty());
+
+    region.markRect(118, 50, 6, 8);
+    uint8_t first = 0;
+    uint8_t last = 0;
+    TEST_ASSERT_FALSE(region.span(5, first, last));
+    TEST_ASSERT_TRUE(region.span(6, first, last));
+    TEST_ASSERT_EQUAL_UINT8(118, first);
+    TEST_ASSERT_EQUAL_UINT8(123, last);
+    TEST_ASSERT_TRUE(region.span(7, first, last));
+    TEST_ASSERT_EQUAL_UINT32(12, region.dirtyBytes());  // Instead of 1024
+    TEST_ASSERT_FALSE(region.isFull());
+
+    region.clear();
+    TEST_ASSERT_FALSE(region.isDirty());
+    TEST_ASSERT_EQUAL_UINT32(0, region.dirtyBytes());
+}
+
+/**
+ * @brief Test: spans merge per page, off-screen parts are clipped, markAll() is a full frame
+ */
+void test_dirty_region_merge_clip_and_full() {
+    OledDirtyRegion region;
+    region.markRect(10, 0, 12, 8);
+    region.markRect(60, 2, 6, 4);  // Same page: one span 10..65
+    uint8_t first = 0;
+    uint8_t last = 0;
+    TEST_ASSERT_TRUE(region.span(0, first, last));
+    TEST_ASSERT_EQUAL_UINT8(10, first);
+    TEST_ASSERT_EQUAL_UINT8(65, last);
+
+    region.clear();
+    region.markRect(-4, 60, 200, 20);   // Clipped to 0..127 of page 7
+    region.markRect(130, 0, 6, 8);      // Off-screen: nothing
+    region.markRect(20, 20, 0, 8);      // Empty: nothing
+    TEST_ASSERT_EQUAL_UINT32(128, region.dirtyBytes());
+    TEST_ASSERT_TRUE(region.span(7, first, last));
+    TEST_ASSERT_EQUAL_UINT8(0, first);
+    TEST_ASSERT_EQUAL_UINT8(127, last);
+
+    region.markAll();
+    TEST_ASSERT_TRUE(region.isFull());
+    TEST_ASSERT_EQUAL_UINT32(1024, region.dirtyBytes());
+}
@@ -0,0 +1,45 @@
+/**
+ * @file perf_baseline.h
+ * @brief Cycle baselines of the hot paths, checked by test_hot_path_cycles.cpp (ESP32 only)
+ *
+ * One line per measurement: median CPU cycles per call on the reference
+ * build (esp32dev_test, 240 MHz, double storage, CALC_FAST_MATH 0). A
+ * measurement fails when it exceeds its baseline by more than
+ * PERF_BASELINE_TOLERANCE_PCT, so a change that doubles a handler's cost
+ * fails the suite while ordinary jitter does not.
+ *
+ * A build variant other than the reference one (BOATDATA_FLOAT_STORAGE,
+ * CALC_FAST_MATH, another CPU clock) skips the assertions and only prints
+ * the numbers.
+ *
+ * Updating: a change that makes a path deliberately slower or faster
+ * updates its line in the same PR. The suite prints every measurement in
+ * this file's format ("X(name, cycles)"), so the new values are a copy of
+ * the serial output of a run on the reference board.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef PERF_BASELINE_H
+#define PERF_BASELINE_H
+
+#define PERF_BASELINE_TOLERANCE_PCT 50   // Fail above baseline * 1.5
+#define PERF_BASELINE_STALE_PCT 50       // Note "baseline stale" below baseline * 0.5
+
+// Reference build
+#define PERF_BASELINE_CPU_MHZ 240
+#define PERF_BASELINE_SCALAR_BYTES 8
+#define PERF_BASELINE_FAST_MATH 0
+
+// X(name, median cycles per call)
+#define PERF_BASELINE_LIST(X) \
+    X(calculate, 42000)       /* CalculationEngine::calculate(), every stage */ \
+    X(serialize_json, 95000)  /* BoatDataSerializer::toJSON(), all groups */ \
+    X(n2k_pgn130306, 9000)    /* HandleN2kPGN130306() + N2kPGNStats::recordHandled() */ \
+    X(n2k_pgn129025, 8000)    /* HandleN2kPGN129025() + N2kPGNStats::recordHandled() */ \
+    X(nmea0183_rmc, 16000)    /* NMEA0183Handler::injectLine() of an RMC sentence */ \
+    X(nmea0183_hdm, 7000)     /* NMEA0183Handler::injectLine() of an HDM sentence */ \
+    X(log_broadcast, 1200)    /* WebSocketLogger::broadcastLog() with no client listening */
+
+#endif // PERF_BASELINE_H
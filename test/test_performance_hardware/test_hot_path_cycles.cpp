@@ -0,0 +1,332 @@
+/**
+ * @file test_hot_path_cycles.cpp
+ * @brief Cycle regression tests of the hot paths against perf_baseline.h (ESP32 only)
+ *
+ * Each test times one call at a time with ESP.getCycleCount() (CCOUNT),
+ * PERF_SAMPLES times, and asserts the median against the measurement's
+ * line in perf_baseline.h:
+ * - calculate: CalculationEngine::calculate() on a populated BoatData
+ * - serialize_json: BoatDataSerializer::toJSON() of every group
+ * - n2k_*: a PGN handler plus the statistics update, as N2kPGNDispatcher runs them
+ * - nmea0183_*: NMEA0183Handler::injectLine() (tokenize, checksum, dispatch, BoatData update)
+ * - log_broadcast: WebSocketLogger::broadcastLog() with nobody listening, the cost
+ *   every handler pays per log call
+ *
+ * HW-009 times the N2k, NMEA 0183 and log paths again with the flash cache
+ * evicted before every sample, the case a frame arriving after Wi-Fi
+ * traffic meets. Those numbers depend on what else shares the cache, so
+ * they are printed (in the same "X(name, cycles)" format, for
+ * bench_history.py) but not asserted: run the suite on the default build
+ * and on HOT_PATH_IRAM=1 and compare the two runs.
+ *
+ * Inputs change a little between samples so no path is short-circuited by
+ * an unchanged value. The counter's own cost is subtracted.
+ *
+ * REQUIRES: ESP32 hardware (run with: pio test -e esp32dev_test -f test_performance_hardware)
+ */
+
+#include <unity.h>
+#include <Arduino.h>
+#include <N2kMessages.h>
+#include <algorithm>
+#include "perf_baseline.h"
+#include "components/BoatData.h"
+#include "components/BoatDataSerializer.h"
+#include "components/CalculationEngine.h"
+#include "components/NMEA0183Handler.h"
+#include "components/NMEA2000Handlers.h"
+#include "components/SourcePrioritizer.h"
+#include "mocks/MockSerialPort.h"
+#include "utils/BoatDataSchema.h"
+#include "utils/WebSocketLogger.h"
+
+#define PERF_SAMPLES 101   // Odd: the median is one sample
+
+// BoatDataSerializer and StaticAssetServer log through the firmware's global logger
+WebSocketLogger logger;
+
+namespace {
+
+enum PerfBaseline : uint8_t {
+#define PERF_BASELINE_ID(name, cycles) PERF_##name,
+    PERF_BASELINE_LIST(PERF_BASELINE_ID)
+#undef PERF_BASELINE_ID
+    PERF_BASELINE_COUNT
+};
+
+const char* const BASELINE_NAMES[] = {
+#define PERF_BASELINE_NAME(name, cycles) #name,
+    PERF_BASELINE_LIST(PERF_BASELINE_NAME)
+#undef PERF_BASELINE_NAME
+};
+
+const uint32_t BASELINE_CYCLES[] = {
+#define PERF_BASELINE_CYCLES(name, cycles) cycles,
+    PERF_BASELINE_LIST(PERF_BASELINE_CYCLES)
+#undef PERF_BASELINE_CYCLES
+};
+
+SourcePrioritizer* prioritizer = nullptr;
+BoatData* boatData = nullptr;
+CalculationEngine* engine = nullptr;
+MockSerialPort* serialPort = nullptr;
+NMEA0183Handler* nmea0183 = nullptr;
+
+uint32_t samples[PERF_SAMPLES];
+uint32_t counterCost = 0;
+
+// Flash-resident data twice the size of a core's 32 KB cache: reading one byte
+// per 32-byte line replaces every cached line, code included
+const uint8_t CACHE_EVICT[64 * 1024] = {1};
+volatile uint32_t evictSink = 0;
+
+char rmcSentence[96];
+size_t rmcLength = 0;
+char hdmSentence[32];
+size_t hdmLength = 0;
+
+size_t withChecksum(const char* body, char* out, size_t capacity) {
+    uint8_t checksum = 0;
+    for (const char* c = body; *c != '\0'; c++) {
+        checksum ^= static_cast<uint8_t>(*c);
+    }
+    return static_cast<size_t>(snprintf(out, capacity, "$%s*%02X", body, checksum));
+}
+
+/// Components shared by every test, built once
+void setupFixtures() {
+    if (boatData != nullptr) {
+        return;
+    }
+    prioritizer = new SourcePrioritizer();
+    boatData = new BoatData(prioritizer);
+    engine = new CalculationEngine();
+    serialPort = new MockSerialPort();
+    nmea0183 = new NMEA0183Handler(serialPort, boatData, &logger);
+
+    CalibrationData calib;
+    calib.leewayCalibrationFactor = DEFAULT_LEEWAY_K_FACTOR;
+    calib.windAngleOffset = DEFAULT_WIND_ANGLE_OFFSET;
+    calib.loaded = true;
+    boatData->setCalibration(calib);
+
+    boatData->updateGPS(48.1173, 11.5167, 1.4731, 6.2, "GPS-TEST");
+    boatData->updateCompass(1.5102, 1.5643, 0.0012, "COMPASS-TEST");
+    boatData->updateWind(0.6109, 14.3, "WIND-TEST");
+    boatData->updateSpeed(0.2094, 6.0, "SPEED-TEST");
+
+    rmcLength = withChecksum("GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W",
+                             rmcSentence, sizeof(rmcSentence));
+    hdmLength = withChecksum("HCHDM,238.5,M", hdmSentence, sizeof(hdmSentence));
+
+    // Cost of the two counter reads around an empty sample
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        uint32_t start = ESP.getCycleCount();
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    std::sort(samples, samples + PERF_SAMPLES);
+    counterCost = samples[PERF_SAMPLES / 2];
+}
+
+/// Median of the samples taken so far, counter cost removed
+uint32_t medianCycles() {
+    std::sort(samples, samples + PERF_SAMPLES);
+    uint32_t median = samples[PERF_SAMPLES / 2];
+    return median > counterCost ? median - counterCost : 0;
+}
+
+bool isReferenceBuild() {
+    return ESP.getCpuFreqMHz() == PERF_BASELINE_CPU_MHZ && sizeof(BoatScalar) == PERF_BASELINE_SCALAR_BYTES &&
+           CALC_FAST_MATH == PERF_BASELINE_FAST_MATH && HOT_PATH_IRAM == 0;
+}
+
+/// Evict the flash cache (volatile reads: the array's contents are known to the compiler)
+void evictFlashCache() {
+    const volatile uint8_t* data = CACHE_EVICT;
+    uint32_t sum = 0;
+    for (size_t i = 0; i < sizeof(CACHE_EVICT); i += 32) {
+        sum += data[i];
+    }
+    evictSink = sum;
+}
+
+/// Print a cold-cache measurement in perf_baseline.h's format, without a baseline
+void printCold(const char* name, uint32_t cycles) {
+    Serial.printf("    X(%s, %lu)  // cold cache, %.1f us, HOT_PATH_IRAM %d\n", name, (unsigned long)cycles,
+                  (double)cycles / ESP.getCpuFreqMHz(), HOT_PATH_IRAM);
+}
+
+/// Print the measurement in perf_baseline.h's format and assert it against its baseline
+void checkBaseline(PerfBaseline id, uint32_t cycles) {
+    uint32_t baseline = BASELINE_CYCLES[id];
+    uint32_t limit = baseline + baseline / 100 * PERF_BASELINE_TOLERANCE_PCT;
+    Serial.printf("    X(%s, %lu)  // baseline %lu, limit %lu, %.1f us\n", BASELINE_NAMES[id],
+                  (unsigned long)cycles, (unsigned long)baseline, (unsigned long)limit,
+                  (double)cycles / ESP.getCpuFreqMHz());
+
+    if (!isReferenceBuild()) {
+        TEST_IGNORE_MESSAGE("Not the reference build of perf_baseline.h: numbers printed only");
+    }
+    if (cycles < baseline / 100 * (100 - PERF_BASELINE_STALE_PCT)) {
+        Serial.printf("    %s is well below its baseline: update perf_baseline.h\n", BASELINE_NAMES[id]);
+    }
+    char message[96];
+    snprintf(message, sizeof(message), "%s: %lu cycles, baseline %lu (+%d%%)", BASELINE_NAMES[id],
+             (unsigned long)cycles, (unsigned long)baseline, PERF_BASELINE_TOLERANCE_PCT);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32_MESSAGE(limit, cycles, message);
+}
+
+void recordHandled(const tN2kMsg& msg, N2kHandlerResult result) {
+    GetN2kPGNStats().recordHandled(msg.PGN, msg.Source, result, 0, millis());
+}
+
+}  // namespace
+
+/**
+ * HW-004: CalculationEngine::calculate() within its baseline
+ */
+void test_hot_path_calculate() {
+    Serial.println(F("\n=== HW-004: calculate() cycles ==="));
+    setupFixtures();
+    BoatDataStructure* data = boatData->getDataStructure();
+    engine->calculate(data, millis());  // Warm caches
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        data->wind.apparentWindAngle = BoatScalar(0.6) + static_cast<BoatScalar>(i) * BoatScalar(0.001);
+        uint32_t now = millis();
+        uint32_t start = ESP.getCycleCount();
+        engine->calculate(data, now);
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    checkBaseline(PERF_calculate, medianCycles());
+}
+
+/**
+ * HW-005: BoatDataSerializer::toJSON() of every group within its baseline
+ */
+void test_hot_path_serialize() {
+    Serial.println(F("\n=== HW-005: toJSON() cycles ==="));
+    setupFixtures();
+    static StaticJsonWriter<BoatDataSchema::JSON_MAX_BYTES> json;
+    BoatDataSerializer::toJSON(boatData, json);
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        uint32_t start = ESP.getCycleCount();
+        size_t length = BoatDataSerializer::toJSON(boatData, json);
+        samples[i] = ESP.getCycleCount() - start;
+        TEST_ASSERT_GREATER_THAN_UINT32(0, length);
+    }
+    checkBaseline(PERF_serialize_json, medianCycles());
+}
+
+/**
+ * HW-006: PGN 130306 (wind) and 129025 (position) handlers within their baselines
+ */
+void test_hot_path_n2k_handlers() {
+    Serial.println(F("\n=== HW-006: N2k handler cycles ==="));
+    setupFixtures();
+    tN2kMsg msg;
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        SetN2kPGN130306(msg, 0, 7.3 + i * 0.01, 0.61 + i * 0.001, N2kWind_Apparent);
+        msg.Source = 10;
+        uint32_t start = ESP.getCycleCount();
+        recordHandled(msg, HandleN2kPGN130306(msg, boatData, &logger));
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    checkBaseline(PERF_n2k_pgn130306, medianCycles());
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        SetN2kPGN129025(msg, 48.1173 + i * 1e-6, 11.5167 + i * 1e-6);
+        msg.Source = 11;
+        uint32_t start = ESP.getCycleCount();
+        recordHandled(msg, HandleN2kPGN129025(msg, boatData, &logger));
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    checkBaseline(PERF_n2k_pgn129025, medianCycles());
+}
+
+/**
+ * HW-007: NMEA 0183 sentence dispatch (RMC, HDM) within its baselines
+ */
+void test_hot_path_nmea0183_dispatch() {
+    Serial.println(F("\n=== HW-007: NMEA 0183 dispatch cycles ==="));
+    setupFixtures();
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        uint32_t start = ESP.getCycleCount();
+        nmea0183->injectLine(0, rmcSentence, rmcLength);
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    checkBaseline(PERF_nmea0183_rmc, medianCycles());
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        uint32_t start = ESP.getCycleCount();
+        nmea0183->injectLine(0, hdmSentence, hdmLength);
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    checkBaseline(PERF_nmea0183_hdm, medianCycles());
+}
+
+/**
+ * HW-008: A log call nobody listens to within its baseline
+ */
+void test_hot_path_log_broadcast() {
+    Serial.println(F("\n=== HW-008: broadcastLog() cycles ==="));
+    setupFixtures();
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        uint32_t start = ESP.getCycleCount();
+        logger.broadcastLog(LogLevel::DEBUG, LogComponent::NMEA2000, LogEvent::PGN130306_UPDATE,
+                            "{\"aws\":14.3,\"awa\":35.0}");
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    checkBaseline(PERF_log_broadcast, medianCycles());
+}
+
+/**
+ * HW-009: The receive paths with a cold flash cache (printed only)
+ */
+void test_hot_path_cold_cache() {
+    Serial.println(F("\n=== HW-009: cold-cache cycles ==="));
+    setupFixtures();
+    tN2kMsg msg;
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        SetN2kPGN130306(msg, 0, 7.3 + i * 0.01, 0.61 + i * 0.001, N2kWind_Apparent);
+        msg.Source = 10;
+        evictFlashCache();
+        uint32_t start = ESP.getCycleCount();
+        recordHandled(msg, HandleN2kPGN130306(msg, boatData, &logger));
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    printCold("n2k_pgn130306_cold", medianCycles());
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        SetN2kPGN129025(msg, 48.1173 + i * 1e-6, 11.5167 + i * 1e-6);
+        msg.Source = 11;
+        evictFlashCache();
+        uint32_t start = ESP.getCycleCount();
+        recordHandled(msg, HandleN2kPGN129025(msg, boatData, &logger));
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    printCold("n2k_pgn129025_cold", medianCycles());
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        evictFlashCache();
+        uint32_t start = ESP.getCycleCount();
+        nmea0183->injectLine(0, rmcSentence, rmcLength);
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    printCold("nmea0183_rmc_cold", medianCycles());
+
+    for (int i = 0; i < PERF_SAMPLES; i++) {
+        evictFlashCache();
+        uint32_t start = ESP.getCycleCount();
+        logger.broadcastLog(LogLevel::DEBUG, LogComponent::NMEA2000, LogEvent::PGN130306_UPDATE,
+                            "{\"aws\":14.3,\"awa\":35.0}");
+        samples[i] = ESP.getCycleCount() - start;
+    }
+    printCold("log_broadcast_cold", medianCycles());
+    TEST_PASS_MESSAGE("Cold-cache cycles printed; compare builds with bench_history.py");
+}
@@ -6,6 +6,11 @@
  * on real ESP32 hardware. These tests validate NFR-006 (< 1% overhead) and
  * NFR-007 (±5 Hz accuracy).
  *
+ * HW-004 to HW-008 (test_hot_path_cycles.cpp) time the hot paths in CPU
+ * cycles and fail when one exceeds its perf_baseline.h entry by more than
+ * the tolerance. HW-009 prints the receive paths' cycles with a cold flash
+ * cache (HOT_PATH_IRAM comparison).
+ *
  * REQUIRES: ESP32 hardware (run with: pio test -e esp32dev_test -f test_performance_hardware)
  */
 
@@ -23,6 +28,14 @@
 // Global monitor instance
 LoopPerformanceMonitor monitor;
 
+// Hot path cycle tests (test_hot_path_cycles.cpp)
+void test_hot_path_calculate();
+void test_hot_path_serialize();
+void test_hot_path_n2k_handlers();
+void test_hot_path_nmea0183_dispatch();
+void test_hot_path_log_broadcast();
+void test_hot_path_cold_cache();
+
 /**
  * HW-001: Test actual loop frequency accuracy on ESP32
  *
@@ -232,6 +245,16 @@ void setup() {
     RUN_TEST(test_measurement_overhead);
     RUN_TEST(test_5_second_window_accuracy);
 
+    // Hot path cycles against perf_baseline.h (HW-004 to HW-008)
+    RUN_TEST(test_hot_path_calculate);
+    RUN_TEST(test_hot_path_serialize);
+    RUN_TEST(test_hot_path_n2k_handlers);
+    RUN_TEST(test_hot_path_nmea0183_dispatch);
+    RUN_TEST(test_hot_path_log_broadcast);
+
+    // Cold flash cache, printed only (HW-009)
+    RUN_TEST(test_hot_path_cold_cache);
+
     UNITY_END();
 }
 
@@ -0,0 +1,203 @@
+/**
+ * @file test_alloc_tracker.cpp
+ * @brief Unit tests for AllocTracker (allocations per code section)
+ *
+ * Tests validate:
+ * - Allocations and frees are counted per tag, inclusively in nested scopes,
+ *   with the per-scope maximum; outside any scope they are untagged
+ * - Tags beyond the table and scopes beyond the depth are dropped, and the
+ *   JSON lists the tags by allocations
+ * - Designated hot paths (sentence tokenizing, field parsing, JSON writing)
+ *   allocate nothing, as seen through the host operator new hooks
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/AllocTracker.h"
+#include "../../src/utils/AllocTracker.cpp"
+#include "../../src/utils/NMEA0183Tokenizer.h"
+#include "../../src/utils/NMEA0183Tokenizer.cpp"
+#include "../helpers/alloc_hooks.h"
+
+/**
+ * @brief UT-076: Per-tag counts, nesting, the per-scope maximum and untagged allocations
+ */
+void test_alloc_tracker_scopes_and_tags() {
+    AllocTracker tracker;
+
+    tracker.recordAlloc(16);  // No scope open
+    tracker.recordFree();
+
+    for (uint8_t i = 0; i < 3; i++) {
+        tracker.enter("reaction");
+        tracker.enter("handler");
+        for (uint8_t j = 0; j <= i; j++) {
+            tracker.recordAlloc(10);
+        }
+        tracker.recordFree();
+        tracker.leave();
+        tracker.recordAlloc(4);  // Reaction only
+        tracker.leave();
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, tracker.getDepth());
+
+    const AllocTagStats* handler = tracker.find("handler");
+    TEST_ASSERT_NOT_NULL(handler);
+    TEST_ASSERT_EQUAL_UINT32(3, handler->scopes);
+    TEST_ASSERT_EQUAL_UINT32(6, handler->allocs);  // 1 + 2 + 3
+    TEST_ASSERT_EQUAL_UINT32(3, handler->frees);
+    TEST_ASSERT_EQUAL_UINT32(60, (uint32_t)handler->bytes);
+    TEST_ASSERT_EQUAL_UINT32(3, handler->maxAllocsPerScope);
+
+    // Inclusive: the reaction sees its handler's allocations too
+    const AllocTagStats* reaction = tracker.find("reaction");
+    TEST_ASSERT_NOT_NULL(reaction);
+    TEST_ASSERT_EQUAL_UINT32(3, reaction->scopes);
+    TEST_ASSERT_EQUAL_UINT32(9, reaction->allocs);
+    TEST_ASSERT_EQUAL_UINT32(72, (uint32_t)reaction->bytes);
+    TEST_ASSERT_EQUAL_UINT32(4, reaction->maxAllocsPerScope);
+
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getUntaggedAllocs());
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getUntaggedFrees());
+    TEST_ASSERT_NULL(tracker.find("never"));
+
+    // Same text at another address is the same tag
+    char copy[16];
+    strcpy(copy, "handler");
+    tracker.enter(copy);
+    tracker.leave();
+    TEST_ASSERT_EQUAL_UINT8(2, tracker.count());
+    TEST_ASSERT_EQUAL_UINT32(4, tracker.find("handler")->scopes);
+
+    // A scope open across reset() keeps counting under its tag
+    tracker.enter("reaction");
+    tracker.reset();
+    tracker.recordAlloc(8);
+    tracker.leave();
+    TEST_ASSERT_EQUAL_UINT8(1, tracker.count());
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.find("reaction")->allocs);
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.find("reaction")->scopes);
+    TEST_ASSERT_NULL(tracker.find("handler"));
+    TEST_ASSERT_EQUAL_UINT32(0, tracker.getUntaggedAllocs());
+}
+
+/**
+ * @brief UT-077: Full tag table and depth are dropped; JSON ordered by allocations
+ */
+void test_alloc_tracker_limits_and_json() {
+    static AllocTracker tracker;
+    tracker = AllocTracker();
+
+    static char names[AllocTracker::MAX_TAGS + 1][8];
+    for (uint8_t i = 0; i <= AllocTracker::MAX_TAGS; i++) {
+        snprintf(names[i], sizeof(names[i]), "t%u", (unsigned)i);
+        tracker.enter(names[i]);
+        tracker.leave();
+    }
+    TEST_ASSERT_EQUAL_UINT8(AllocTracker::MAX_TAGS, tracker.count());
+    TEST_ASSERT_EQUAL_UINT32(1, tracker.getDropped());
+    TEST_ASSERT_NULL(tracker.find(names[AllocTracker::MAX_TAGS]));
+
+    // Scopes past MAX_DEPTH are not counted, but leave() still unwinds them
+    tracker.reset();
+    for (uint8_t i = 0; i < AllocTracker::MAX_DEPTH + 2; i++) {
+        tracker.enter("deep");
+    }
+    tracker.recordAlloc(1);
+    for (uint8_t i = 0; i < AllocTracker::MAX_DEPTH + 2; i++) {
+        tracker.leave();
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, tracker.getDepth());
+    TEST_ASSERT_EQUAL_UINT32(2, tracker.getDropped());
+    TEST_ASSERT_EQUAL_UINT32(AllocTracker::MAX_DEPTH, tracker.find("deep")->scopes);
+    tracker.leave();  // Unbalanced leave is ignored
+    TEST_ASSERT_EQUAL_UINT8(0, tracker.getDepth());
+
+    tracker.reset();
+    tracker.enter("quiet");
+    tracker.leave();
+    tracker.enter("busy");
+    tracker.recordAlloc(100);
+    tracker.recordAlloc(28);
+    tracker.leave();
+    tracker.enter("busy");
+    tracker.recordAlloc(64);
+    tracker.leave();
+
+    TEST_ASSERT_EQUAL_STRING("busy", tracker.ranked(0)->tag);
+    TEST_ASSERT_EQUAL_STRING("quiet", tracker.ranked(1)->tag);
+    TEST_ASSERT_NULL(tracker.ranked(2));
+
+    StaticJsonWriter<512> json;
+    TEST_ASSERT_TRUE(tracker.writeJson(json));
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"untagged\":0,\"dropped\":0,\"tags\":["
+        "{\"tag\":\"busy\",\"scopes\":2,\"allocs\":3,\"frees\":0,\"bytes\":192,"
+        "\"per_scope\":1.50,\"max_per_scope\":2},"
+        "{\"tag\":\"quiet\",\"scopes\":1,\"allocs\":0,\"frees\":0,\"bytes\":0,"
+        "\"per_scope\":0.00,\"max_per_scope\":0}]}",
+        json.c_str());
+
+    StaticJsonWriter<32> small;
+    TEST_ASSERT_FALSE(tracker.writeJson(small));
+}
+
+namespace {
+
+const char* const RMC = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A";
+
+}  // namespace
+
+/**
+ * @brief UT-078: Hot paths allocate nothing (operator new hooks feed GetAllocTracker())
+ */
+void test_alloc_tracker_hot_paths_allocation_free() {
+    AllocTracker& tracker = GetAllocTracker();
+    tracker.reset();
+
+    // The hooks see a real allocation inside a scope
+    {
+        AllocScope scope("sanity");
+        int* value = new int(7);
+        delete value;
+    }
+    const AllocTagStats* sanity = tracker.find("sanity");
+    TEST_ASSERT_NOT_NULL(sanity);
+    TEST_ASSERT_EQUAL_UINT32(1, sanity->allocs);
+    TEST_ASSERT_EQUAL_UINT32(1, sanity->frees);
+    TEST_ASSERT_EQUAL_UINT32(sizeof(int), (uint32_t)sanity->bytes);
+
+    NMEA0183Tokens tokens;
+    for (uint8_t i = 0; i < 10; i++) {
+        AllocScope scope("tokenize");
+        TEST_ASSERT_TRUE(tokens.tokenize(RMC, strlen(RMC)));
+        double value = 0.0;
+        TEST_ASSERT_TRUE(NMEA0183FieldToDouble(tokens.field(6), value));
+        uint32_t centiseconds = 0;
+        TEST_ASSERT_TRUE(NMEA0183FieldToTime(tokens.field(0), centiseconds));
+    }
+
+    for (uint8_t i = 0; i < 10; i++) {
+        AllocScope scope("json");
+        StaticJsonWriter<256> json;
+        json.beginObject()
+            .add("sog", 5.2, 1)
+            .add("source", "GPS-A")
+            .beginArray("fields").add(1).add(2).endArray()
+            .endObject();
+        TEST_ASSERT_FALSE(json.overflowed());
+    }
+
+    const AllocTagStats* tokenize = tracker.find("tokenize");
+    TEST_ASSERT_NOT_NULL(tokenize);
+    TEST_ASSERT_EQUAL_UINT32(10, tokenize->scopes);
+    TEST_ASSERT_EQUAL_UINT32(0, tokenize->allocs);
+
+    const AllocTagStats* json = tracker.find("json");
+    TEST_ASSERT_NOT_NULL(json);
+    TEST_ASSERT_EQUAL_UINT32(10, json->scopes);
+    TEST_ASSERT_EQUAL_UINT32(0, json->allocs);
+}
@@ -0,0 +1,146 @@
+/**
+ * @file test_battery_soc.cpp
+ * @brief Unit tests for BatterySocEstimator (coulomb-counting state of charge)
+ *
+ * Tests validate:
+ * - Integration in µA·s keeps small currents; Peukert applies to discharge, the charge efficiency
+ *   to charge; the charge is clamped to the capacity; time to empty/full from the average current
+ * - A voltage plateau at rest re-anchors once per rest period (a drifting voltage restarts the
+ *   window); TripCounters persists the accumulator and a schema 1 record starts from the voltage
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/BatterySoc.h"
+#include "../../src/utils/BatterySoc.cpp"
+#include "../../src/utils/TripCounters.h"
+
+namespace {
+
+/// Volts of a resting bank at @p percent
+double restingVolts(double percent) {
+    return ONEWIRE_SOC_EMPTY_V + (ONEWIRE_SOC_FULL_V - ONEWIRE_SOC_EMPTY_V) * percent / 100.0;
+}
+
+/// @p seconds of 1 s samples at @p amps and @p volts
+void hold(BatterySocEstimator& soc, double amps, double volts, uint32_t seconds) {
+    for (uint32_t i = 0; i < seconds; i++) {
+        soc.sample(amps, volts, 1000);
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief UT-064: Coulomb counting with Peukert and charge efficiency; time to empty and full
+ */
+void test_battery_soc_integrates_with_corrections() {
+    BatterySocEstimator plain(100.0, 1.0, 1.0);
+    TEST_ASSERT_FALSE(plain.isValid());
+    TEST_ASSERT_FALSE(plain.sample(-10.0, 0.0, 1000));   // No voltage: nothing to start from
+    TEST_ASSERT_TRUE(plain.sample(-10.0, restingVolts(50.0), 1000));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 50.0, plain.getStateOfCharge());
+
+    // 10 A for an hour out of 100 Ah
+    hold(plain, -10.0, 12.0, 3600);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 40.0, plain.getStateOfCharge());
+    BatterySocStatus status = plain.getStatus();
+    TEST_ASSERT_DOUBLE_WITHIN(0.01, -10.0, status.averageCurrent);
+    TEST_ASSERT_DOUBLE_WITHIN(1.0, 14400.0, status.timeToEmptyS);   // 40 Ah at 10 A
+    TEST_ASSERT_TRUE(isnan(status.timeToFullS));
+
+    // 0.4 mA for 1000 s: the fixed-point accumulator loses nothing
+    int64_t before = plain.getCharge();
+    hold(plain, 0.0004, 12.1, 1000);
+    TEST_ASSERT_TRUE(plain.getCharge() - before == 400000);
+
+    // Peukert: 20 A from a 100 Ah bank rated at 5 A drains 20 × 4^0.25 A
+    BatterySocEstimator peukert(100.0, 1.25, 1.0);
+    peukert.sample(0.0, restingVolts(50.0), 1000);
+    hold(peukert, -20.0, 11.9, 3600);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-3, 50.0 - 20.0 * pow(4.0, 0.25), peukert.getStateOfCharge());
+
+    // Charge efficiency: 10 A for an hour stores 9 Ah, clamped at full
+    BatterySocEstimator charging(100.0, 1.0, 0.9);
+    charging.sample(10.0, restingVolts(50.0), 1000);
+    hold(charging, 10.0, 13.8, 3600);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 59.0, charging.getStateOfCharge());
+    status = charging.getStatus();
+    TEST_ASSERT_DOUBLE_WITHIN(1.0, 41.0 / 9.0 * 3600.0, status.timeToFullS);
+    TEST_ASSERT_TRUE(isnan(status.timeToEmptyS));
+    hold(charging, 10.0, 13.8, 5 * 3600);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 100.0, charging.getStateOfCharge());
+}
+
+/**
+ * @brief UT-065: Rest-voltage re-anchoring; the accumulator survives the trip record
+ */
+void test_battery_soc_rest_anchor_and_persistence() {
+    BatterySocEstimator soc(100.0, 1.0, 1.0);
+    soc.sample(0.0, restingVolts(50.0), 1000);
+    hold(soc, -10.0, 12.0, 3600);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 40.0, soc.getStateOfCharge());
+
+    // Recovering voltage after the load: not a plateau, the window keeps restarting
+    double volts = 12.00;
+    for (uint32_t i = 0; i < BATTERY_REST_MS / 1000; i++) {
+        volts += 0.001;
+        TEST_ASSERT_FALSE(soc.sample(0.0, volts, 1000));
+    }
+    // Settled at 60%: anchored after BATTERY_REST_MS on the plateau, once
+    double plateau = restingVolts(60.0);
+    hold(soc, 0.0, plateau + BATTERY_REST_PLATEAU_V / 2, 60);   // Inside the band
+    hold(soc, 0.0, plateau, BATTERY_REST_MS / 1000 - 61);
+    TEST_ASSERT_EQUAL_UINT32(0, soc.getAnchors());
+    TEST_ASSERT_TRUE(soc.sample(0.0, plateau, 1000));
+    TEST_ASSERT_EQUAL_UINT32(1, soc.getAnchors());
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 60.0, soc.getStateOfCharge());
+    hold(soc, 0.0, plateau, BATTERY_REST_MS / 1000);
+    TEST_ASSERT_EQUAL_UINT32(1, soc.getAnchors());
+    TEST_ASSERT_TRUE(isnan(soc.getStatus().timeToEmptyS));
+
+    // Persisted through the "trip" record
+    TripCounters counters;
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.battery.available = true;
+    data.battery.voltageA = restingVolts(80.0);
+    data.battery.amperageA = -20.0;
+    for (uint32_t now = 1000; now <= 601000; now += 1000) {
+        data.battery.lastUpdate = now;
+        counters.sample(data, now);
+    }
+    TripSocValues values = counters.socSnapshot();
+    TEST_ASSERT_TRUE(values.bank[0].valid);
+    TEST_ASSERT_FALSE(values.bank[1].valid);   // Bank B reports no voltage
+    TEST_ASSERT_TRUE(values.bank[0].stateOfCharge < 80.0);
+
+    uint8_t record[CONFIG_RECORD_MAX_BYTES];
+    size_t length = counters.encodeRecord(record, sizeof(record));
+    TripCounters restored;
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigRecordStatus::OK),
+                            static_cast<uint8_t>(restored.decodeRecord(record, length)));
+    TEST_ASSERT_TRUE(restored.getEstimator(0).isValid());
+    TEST_ASSERT_TRUE(restored.getEstimator(0).getCharge() == counters.getEstimator(0).getCharge());
+    TEST_ASSERT_FALSE(restored.getEstimator(1).isValid());
+
+    StaticJsonWriter<640> json;
+    restored.writeJson(json);
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"state_of_charge\":{\"battery_a\":{\"soc\":"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"battery_b\":{\"soc\":null,"));
+
+    // Schema 1 (totals only): restored, the estimators start from the voltage
+    ConfigRecordWriter old(record, sizeof(record));
+    for (uint8_t i = 0; i < 7; i++) {
+        old.putF64(1.0);
+    }
+    length = old.finish(1);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigRecordStatus::OK),
+                            static_cast<uint8_t>(restored.decodeRecord(record, length)));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 1.0, restored.snapshot().shoreKWh);
+    TEST_ASSERT_FALSE(restored.getEstimator(0).isValid());
+}
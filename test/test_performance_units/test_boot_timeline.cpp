@@ -0,0 +1,83 @@
+/**
+ * @file test_boot_timeline.cpp
+ * @brief Unit tests for BootTimeline (setup step times, boot milestones)
+ *
+ * Tests validate:
+ * - A mark ends the step that started at the previous mark; recorded steps do not move it
+ * - Milestones keep their first time only
+ * - n2k_target_met: null while waiting, false once the target passed, true/false after the frame
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/BootTimeline.h"
+#include "../../src/utils/BootTimeline.cpp"
+
+/**
+ * @brief UT-039: Step durations from consecutive marks; full table drops further steps
+ */
+void test_boot_timeline_steps() {
+    BootTimeline timeline;
+    timeline.mark("serial", 3);
+    timeline.mark("littlefs", 41);
+    timeline.record("oled_init", 250, 310);   // Ran out of line
+    timeline.mark("boatdata", 60);
+
+    TEST_ASSERT_EQUAL_UINT8(4, timeline.getStepCount());
+    TEST_ASSERT_EQUAL_STRING("serial", timeline.getStep(0).name);
+    TEST_ASSERT_EQUAL_UINT32(0, timeline.getStep(0).startMs);
+    TEST_ASSERT_EQUAL_UINT32(3, timeline.getStep(0).durationMs);
+    TEST_ASSERT_EQUAL_UINT32(3, timeline.getStep(1).startMs);
+    TEST_ASSERT_EQUAL_UINT32(38, timeline.getStep(1).durationMs);
+    TEST_ASSERT_EQUAL_UINT32(250, timeline.getStep(2).startMs);
+    TEST_ASSERT_EQUAL_UINT32(60, timeline.getStep(2).durationMs);
+    TEST_ASSERT_EQUAL_UINT32(41, timeline.getStep(3).startMs);   // From the last mark, not the record
+    TEST_ASSERT_EQUAL_UINT32(19, timeline.getStep(3).durationMs);
+
+    for (uint8_t i = timeline.getStepCount(); i < BOOT_TIMELINE_STEPS; i++) {
+        timeline.mark("step", 100 + i);
+    }
+    timeline.mark("extra", 200);
+    TEST_ASSERT_EQUAL_UINT8(BOOT_TIMELINE_STEPS, timeline.getStepCount());
+    TEST_ASSERT_EQUAL_UINT8(1, timeline.getDropped());
+}
+
+/**
+ * @brief UT-040: First-only milestones and the JSON report against BOOT_N2K_TARGET_MS
+ */
+void test_boot_timeline_milestones_and_json() {
+    BootTimeline timeline;
+    TEST_ASSERT_EQUAL_UINT32(BootTimeline::NOT_REACHED, timeline.getMilestone(BootMilestone::FIRST_N2K_FRAME));
+
+    timeline.mark("nmea2000", 90);
+    StaticJsonWriter<512> waiting;
+    TEST_ASSERT_TRUE(timeline.writeJson(waiting, 100));
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"steps\":[{\"name\":\"nmea2000\",\"start_ms\":0,\"ms\":90}],"
+        "\"milestones_ms\":{\"setup_done\":null,\"first_loop\":null,\"first_n2k_frame\":null,\"wifi_connected\":null},"
+        "\"n2k_target_ms\":500,\"n2k_target_met\":null}",
+        waiting.c_str());
+
+    StaticJsonWriter<512> missed;
+    timeline.writeJson(missed, BOOT_N2K_TARGET_MS + 1);
+    TEST_ASSERT_NOT_NULL(strstr(missed.c_str(), "\"n2k_target_met\":false"));
+
+    timeline.milestone(BootMilestone::FIRST_N2K_FRAME, 140);
+    timeline.milestone(BootMilestone::FIRST_N2K_FRAME, 150);   // Later frames do not move it
+    timeline.milestone(BootMilestone::SETUP_DONE, 212);
+    TEST_ASSERT_EQUAL_UINT32(140, timeline.getMilestone(BootMilestone::FIRST_N2K_FRAME));
+
+    StaticJsonWriter<512> met;
+    TEST_ASSERT_TRUE(timeline.writeJson(met, 1000, "boot"));
+    TEST_ASSERT_NOT_NULL(strstr(met.c_str(), "\"boot\":{\"steps\""));
+    TEST_ASSERT_NOT_NULL(strstr(met.c_str(), "\"setup_done\":212,\"first_loop\":null,\"first_n2k_frame\":140"));
+    TEST_ASSERT_NOT_NULL(strstr(met.c_str(), "\"n2k_target_met\":true"));
+
+    BootTimeline late;
+    late.milestone(BootMilestone::FIRST_N2K_FRAME, BOOT_N2K_TARGET_MS + 20);
+    StaticJsonWriter<512> json;
+    late.writeJson(json, 1000);
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"n2k_target_met\":false"));
+}
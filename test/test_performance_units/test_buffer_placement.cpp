@@ -0,0 +1,86 @@
+/**
+ * @file test_buffer_placement.cpp
+ * @brief Unit tests for BufferPlacement (PSRAM-first large-buffer placement)
+ *
+ * Tests validate:
+ * - Full capacity in PSRAM; reduced internal capacity without it; none left fails
+ * - Placed elements are value-initialized; the table feeds MemoryBudget and JSON
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdlib.h>
+#include <string.h>
+#include "../../src/utils/BufferPlacement.h"
+#include "../../src/utils/BufferPlacement.cpp"
+
+static bool _psramPresent = true;
+static bool _internalFree = true;
+
+static void* fakeAllocate(size_t bytes, size_t alignment, BufferRegion region) {
+    (void)alignment;
+    bool available = region == BufferRegion::PSRAM ? _psramPresent : _internalFree;
+    if (!available) {
+        return nullptr;
+    }
+    void* block = malloc(bytes);
+    memset(block, 0xA5, bytes);  // Garbage: place<T>() must initialize
+    return block;
+}
+
+/**
+ * @brief UT-049: PSRAM first, reduced internal fallback, failure; table and JSON
+ */
+void test_buffer_placement_policy() {
+    static BufferPlacement placement(fakeAllocate);
+    uint32_t count = 0;
+    BufferRegion region = BufferRegion::NONE;
+
+    // PSRAM present: full capacity
+    _psramPresent = true;
+    uint32_t* ring = placement.place<uint32_t>("trace_ring", 64, 16, count, &region);
+    TEST_ASSERT_NOT_NULL(ring);
+    TEST_ASSERT_EQUAL_UINT32(64, count);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(BufferRegion::PSRAM), static_cast<uint8_t>(region));
+    TEST_ASSERT_EQUAL_UINT32(0, ring[0]);
+    TEST_ASSERT_EQUAL_UINT32(0, ring[63]);
+
+    // No PSRAM: the configured internal capacity
+    _psramPresent = false;
+    uint8_t* capture = placement.place<uint8_t>("bus_capture", 1024, 256, count, &region);
+    TEST_ASSERT_NOT_NULL(capture);
+    TEST_ASSERT_EQUAL_UINT32(256, count);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(BufferRegion::INTERNAL_RAM), static_cast<uint8_t>(region));
+    TEST_ASSERT_TRUE(placement.getEntry(1).reduced);
+
+    // Neither region has room: nullptr, counted
+    _internalFree = false;
+    TEST_ASSERT_NULL(placement.placeBytes("history", 1, 4, 4096, 1024, count, &region));
+    TEST_ASSERT_EQUAL_UINT32(0, count);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(BufferRegion::NONE), static_cast<uint8_t>(region));
+    TEST_ASSERT_EQUAL_UINT8(1, placement.getFailed());
+    _psramPresent = true;
+    _internalFree = true;
+
+    TEST_ASSERT_EQUAL_UINT8(3, placement.getCount());
+    TEST_ASSERT_EQUAL_UINT32(256, placement.getBytes(BufferRegion::PSRAM));
+    TEST_ASSERT_EQUAL_UINT32(256, placement.getBytes(BufferRegion::INTERNAL_RAM));
+
+    // GET /memory: PSRAM and internal fallback in their own regions, failures not listed
+    static MemoryBudget budget;
+    placement.addTo(budget);
+    TEST_ASSERT_EQUAL_UINT8(2, budget.getCount());
+    TEST_ASSERT_EQUAL_UINT32(256, budget.getTotal(MemoryRegion::PSRAM));
+    TEST_ASSERT_EQUAL_UINT32(256, budget.getTotal(MemoryRegion::BOOT_HEAP));
+
+    StaticJsonWriter<512> json;
+    placement.writeJson(json);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"buffers\":["
+        "{\"name\":\"trace_ring\",\"region\":\"psram\",\"bytes\":256,\"count\":64,\"reduced\":false},"
+        "{\"name\":\"bus_capture\",\"region\":\"internal\",\"bytes\":256,\"count\":256,\"reduced\":true},"
+        "{\"name\":\"history\",\"region\":\"none\",\"bytes\":1024,\"count\":0,\"reduced\":true}],"
+        "\"psram\":256,\"internal\":256,\"failed\":1}",
+        json.c_str());
+}
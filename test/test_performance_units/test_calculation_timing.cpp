@@ -0,0 +1,76 @@
+/**
+ * @file test_calculation_timing.cpp
+ * @brief Unit tests for CalculationTiming (calculation cycle period, jitter, deadline)
+ *
+ * Tests validate:
+ * - Period and jitter from consecutive cycle starts, across micros() wrap-around
+ * - Deadline misses against the configured budget
+ * - requestReset() takes effect on the next record(); stats JSON
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/CalculationTiming.h"
+#include "../../src/utils/CalculationTiming.cpp"
+
+/**
+ * @brief UT-029: Periods and their differences
+ */
+void test_calculation_timing_period_jitter() {
+    CalculationTiming timing(5000);
+    timing.record(0xFFFFFFFFu - 49999, 700);  // 50 ms before the micros() wrap
+    TEST_ASSERT_EQUAL_UINT32(0, timing.getPeriods().getCount());
+    TEST_ASSERT_EQUAL_UINT32(0, timing.getLastPeriodUs());
+
+    timing.record(50000, 700);                // 100 ms later, across the wrap
+    timing.record(150000, 700);               // 100 ms
+    timing.record(280000, 700);               // 130 ms: 30 ms late
+    TEST_ASSERT_EQUAL_UINT32(4, timing.getCycles());
+    TEST_ASSERT_EQUAL_UINT32(3, timing.getPeriods().getCount());
+    TEST_ASSERT_EQUAL_UINT32(100000, timing.getPeriods().getMin());
+    TEST_ASSERT_EQUAL_UINT32(130000, timing.getPeriods().getMax());
+    TEST_ASSERT_EQUAL_UINT32(130000, timing.getLastPeriodUs());
+
+    TEST_ASSERT_EQUAL_UINT32(2, timing.getJitter().getCount());
+    TEST_ASSERT_EQUAL_UINT32(0, timing.getJitter().getMin());
+    TEST_ASSERT_EQUAL_UINT32(30000, timing.getJitter().getMax());
+}
+
+/**
+ * @brief UT-030: Cycles over the budget are deadline misses
+ */
+void test_calculation_timing_deadline() {
+    CalculationTiming timing(5000);
+    TEST_ASSERT_FALSE(timing.record(0, 5000));         // At the budget: met
+    TEST_ASSERT_TRUE(timing.record(100000, 5001));
+    TEST_ASSERT_FALSE(timing.record(200000, 800));
+    TEST_ASSERT_EQUAL_UINT32(1, timing.getDeadlineMisses());
+    TEST_ASSERT_EQUAL_UINT32(5001, timing.getDurations().getMax());
+    TEST_ASSERT_EQUAL_UINT32(800, timing.getDurations().getMin());
+}
+
+/**
+ * @brief UT-031: Reset on the next cycle; JSON report
+ */
+void test_calculation_timing_reset_and_json() {
+    CalculationTiming timing(5000);
+    timing.record(0, 9000);
+    timing.record(100000, 700);
+    timing.requestReset();
+    TEST_ASSERT_EQUAL_UINT32(1, timing.getDeadlineMisses());  // Not until the next record()
+
+    timing.record(200000, 600);
+    TEST_ASSERT_EQUAL_UINT32(1, timing.getCycles());
+    TEST_ASSERT_EQUAL_UINT32(0, timing.getDeadlineMisses());
+    TEST_ASSERT_EQUAL_UINT32(1, timing.getPeriods().getCount());  // Period across the reset still counts
+    TEST_ASSERT_EQUAL_UINT32(0, timing.getJitter().getCount());
+
+    StaticJsonWriter<768> json;
+    TEST_ASSERT_TRUE(timing.writeStats(json));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"deadline_us\":5000,\"cycles\":1,\"deadline_misses\":0"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"period\":{\"n\":1,\"min_us\":100000"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"jitter\":{\"n\":0"));
+    TEST_ASSERT_EQUAL_INT('}', json.c_str()[json.length() - 1]);
+}
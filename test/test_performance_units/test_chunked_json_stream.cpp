@@ -0,0 +1,137 @@
+/**
+ * @file test_chunked_json_stream.cpp
+ * @brief Unit tests for ChunkedJsonStream (JSON documents written piece by piece)
+ *
+ * Tests validate:
+ * - Pieces written by successive generator steps form one valid document: separators and
+ *   nesting continue across steps, empty steps are skipped, and every read size gives the
+ *   same bytes
+ * - A step larger than CHUNKED_JSON_PIECE_BYTES ends the document before that piece;
+ *   a stream can be restarted for the next request
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/ChunkedJsonStream.h"
+#include "../../src/utils/ChunkedJsonStream.cpp"
+
+namespace {
+
+struct Items {
+    uint16_t count;
+    uint16_t blanks;   ///< Steps that write nothing
+};
+
+/// {"items":[{"i":0},{"i":1},...],"count":N}
+bool writeItems(JsonWriter& json, uint16_t step, void* context) {
+    const Items* items = static_cast<const Items*>(context);
+    if (step == 0) {
+        json.beginObject().beginArray("items");
+        return true;
+    }
+    if (step <= items->blanks) {
+        return true;
+    }
+    uint16_t index = step - 1 - items->blanks;
+    if (index < items->count) {
+        json.beginObject().add("i", (unsigned int)index).endObject();
+        return true;
+    }
+    json.endArray().add("count", (unsigned int)items->count).endObject();
+    return false;
+}
+
+/// One step far larger than a piece
+bool writeHuge(JsonWriter& json, uint16_t step, void*) {
+    if (step == 0) {
+        json.beginObject().add("ok", true);
+        return true;
+    }
+    json.beginArray("huge");
+    for (size_t i = 0; i < ChunkedJsonStream::PIECE_BYTES; i++) {
+        json.add((unsigned int)i);
+    }
+    json.endArray().endObject();
+    return false;
+}
+
+size_t drain(ChunkedJsonStream& stream, char* out, size_t capacity, size_t chunk) {
+    size_t total = 0;
+    size_t n;
+    while (total + 1 < capacity &&
+           (n = stream.read(out + total, chunk < capacity - 1 - total ? chunk : capacity - 1 - total)) > 0) {
+        total += n;
+    }
+    out[total] = '\0';
+    return total;
+}
+
+}  // namespace
+
+/**
+ * @brief UT-072: Steps join into one document, whatever the read size
+ */
+void test_chunked_json_pieces_join() {
+    Items items = {3, 2};
+    ChunkedJsonStream stream;
+    static char out[512];
+
+    stream.begin(writeItems, &items);
+    TEST_ASSERT_FALSE(stream.isComplete());
+    drain(stream, out, sizeof(out), sizeof(out));
+    TEST_ASSERT_EQUAL_STRING("{\"items\":[{\"i\":0},{\"i\":1},{\"i\":2}],\"count\":3}", out);
+    TEST_ASSERT_TRUE(stream.isComplete());
+    TEST_ASSERT_FALSE(stream.overflowed());
+    TEST_ASSERT_EQUAL_UINT16(7, stream.getSteps());   // Head, 2 blanks, 3 items, tail
+    TEST_ASSERT_EQUAL_UINT32(0, stream.read(out, sizeof(out)));
+
+    // Chunks smaller than a piece give the same bytes
+    const size_t chunks[] = {1, 5, 13};
+    for (size_t chunk : chunks) {
+        static char again[512];
+        stream.begin(writeItems, &items);
+        drain(stream, again, sizeof(again), chunk);
+        TEST_ASSERT_EQUAL_STRING(out, again);
+    }
+
+    // No items: the separators still come out right
+    Items none = {0, 0};
+    stream.begin(writeItems, &none);
+    drain(stream, out, sizeof(out), 4);
+    TEST_ASSERT_EQUAL_STRING("{\"items\":[],\"count\":0}", out);
+
+    // JsonWriter::clearOutput() alone: the open object continues with a comma
+    StaticJsonWriter<64> json;
+    json.beginObject().add("a", 1);
+    json.clearOutput();
+    json.add("b", 2).endObject();
+    TEST_ASSERT_EQUAL_STRING(",\"b\":2}", json.c_str());
+}
+
+/**
+ * @brief UT-073: An oversized step ends the document before it; restart clears the state
+ */
+void test_chunked_json_overflow_and_restart() {
+    ChunkedJsonStream stream;
+    static char out[4 * CHUNKED_JSON_PIECE_BYTES];
+
+    stream.begin(writeHuge, nullptr);
+    drain(stream, out, sizeof(out), 64);
+    TEST_ASSERT_EQUAL_STRING("{\"ok\":true", out);   // The huge piece was not sent
+    TEST_ASSERT_TRUE(stream.overflowed());
+    TEST_ASSERT_TRUE(stream.isComplete());
+
+    Items items = {1, 0};
+    stream.begin(writeItems, &items);
+    TEST_ASSERT_FALSE(stream.overflowed());
+    drain(stream, out, sizeof(out), 64);
+    TEST_ASSERT_EQUAL_STRING("{\"items\":[{\"i\":0}],\"count\":1}", out);
+
+    // No generator: empty document
+    stream.begin(nullptr, nullptr);
+    TEST_ASSERT_EQUAL_UINT32(0, stream.read(out, sizeof(out)));
+    TEST_ASSERT_TRUE(stream.isComplete());
+}
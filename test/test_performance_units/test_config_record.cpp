@@ -0,0 +1,118 @@
+/**
+ * @file test_config_record.cpp
+ * @brief Unit tests for ConfigRecord (binary configuration records in NVS)
+ *
+ * Tests validate:
+ * - Every field type survives a write/read round trip; the CRC is the IEEE one
+ * - Damaged, truncated and foreign records are refused; reads past the payload fail safely
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/ConfigRecord.h"
+#include "../../src/utils/ConfigRecord.cpp"
+
+/**
+ * @brief UT-058: Round trip of every field type, schema and length in the header, overflow refused
+ */
+void test_config_record_round_trip() {
+    const char check[] = "123456789";
+    TEST_ASSERT_EQUAL_UINT32(0xCBF43926UL, ConfigCrc32(reinterpret_cast<const uint8_t*>(check), 9));
+    TEST_ASSERT_EQUAL_UINT32(0xCBF43926UL,
+        ConfigCrc32(reinterpret_cast<const uint8_t*>(check) + 4, 5, ConfigCrc32(reinterpret_cast<const uint8_t*>(check), 4)));
+
+    uint8_t buffer[CONFIG_RECORD_MAX_BYTES];
+    const uint8_t address[4] = {192, 168, 1, 50};
+    ConfigRecordWriter out(buffer, sizeof(buffer));
+    out.putF64(0.65).putF64(-0.0872664626).putU8(11).putF32(2.5f).putU16(0x0402)
+        .putU32(1696608000UL).putString("Marina \"Guest\"").putString("").putBytes(address, 4);
+    size_t length = out.finish(3);
+    TEST_ASSERT_EQUAL_UINT32(ConfigRecordWriter::HEADER_SIZE + 8 + 8 + 1 + 4 + 2 + 4 + 15 + 1 + 4, length);
+    TEST_ASSERT_EQUAL_UINT8('P', buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8('2', buffer[1]);
+
+    ConfigRecordReader in(buffer, length);
+    uint16_t schema = 0;
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigRecordStatus::OK), static_cast<uint8_t>(in.open(schema)));
+    TEST_ASSERT_EQUAL_UINT16(3, schema);
+    TEST_ASSERT_TRUE(in.getF64() == 0.65);
+    TEST_ASSERT_TRUE(in.getF64() == -0.0872664626);
+    TEST_ASSERT_EQUAL_UINT8(11, in.getU8());
+    TEST_ASSERT_TRUE(in.getF32() == 2.5f);
+    TEST_ASSERT_EQUAL_UINT16(0x0402, in.getU16());
+    TEST_ASSERT_EQUAL_UINT32(1696608000UL, in.getU32());
+    char text[33];
+    TEST_ASSERT_TRUE(in.getString(text, sizeof(text)));
+    TEST_ASSERT_EQUAL_STRING("Marina \"Guest\"", text);
+    TEST_ASSERT_TRUE(in.getString(text, sizeof(text)));
+    TEST_ASSERT_EQUAL_STRING("", text);
+    uint8_t readBack[4];
+    TEST_ASSERT_TRUE(in.getBytes(readBack, 4));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(address, readBack, 4));
+    TEST_ASSERT_EQUAL_UINT32(0, in.remaining());
+    TEST_ASSERT_TRUE(in.ok());
+
+    // A record that does not fit is never half written
+    uint8_t small[20];
+    ConfigRecordWriter tight(small, sizeof(small));
+    tight.putF64(1.0).putF64(2.0);
+    TEST_ASSERT_TRUE(tight.overflowed());
+    TEST_ASSERT_EQUAL_UINT32(0, tight.finish(1));
+    ConfigRecordWriter none(nullptr, 64);
+    TEST_ASSERT_EQUAL_UINT32(0, none.putU8(1).finish(1));
+}
+
+/**
+ * @brief UT-059: Flipped, cut and foreign records are refused; over-reads clear ok()
+ */
+void test_config_record_rejects_damage() {
+    uint8_t buffer[64];
+    ConfigRecordWriter out(buffer, sizeof(buffer));
+    out.putF64(0.65).putString("HomeNetwork");
+    size_t length = out.finish(1);
+    uint16_t schema = 0;
+
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigRecordStatus::EMPTY),
+                            static_cast<uint8_t>(ConfigRecordReader(buffer, 0).open(schema)));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigRecordStatus::EMPTY),
+                            static_cast<uint8_t>(ConfigRecordReader(nullptr, length).open(schema)));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigRecordStatus::TRUNCATED),
+                            static_cast<uint8_t>(ConfigRecordReader(buffer, 8).open(schema)));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigRecordStatus::TRUNCATED),
+                            static_cast<uint8_t>(ConfigRecordReader(buffer, length - 1).open(schema)));
+
+    // One bit anywhere after the magic: bad CRC (schema and length are covered too)
+    for (size_t offset = 4; offset < length; offset++) {
+        if (offset >= 8 && offset < 12) {
+            continue;  // The CRC itself
+        }
+        buffer[offset] ^= 0x01;
+        ConfigRecordStatus status = ConfigRecordReader(buffer, length).open(schema);
+        TEST_ASSERT_TRUE(status == ConfigRecordStatus::BAD_CRC || status == ConfigRecordStatus::TRUNCATED);
+        buffer[offset] ^= 0x01;
+    }
+    buffer[0] ^= 0x01;
+    TEST_ASSERT_EQUAL_STRING("bad_magic", ConfigRecordStatusName(ConfigRecordReader(buffer, length).open(schema)));
+    buffer[0] ^= 0x01;
+
+    // Valid record, reader asks for more than is there
+    ConfigRecordReader in(buffer, length);
+    TEST_ASSERT_EQUAL_STRING("ok", ConfigRecordStatusName(in.open(schema)));
+    in.getF64();
+    char tooSmall[5];
+    TEST_ASSERT_FALSE(in.getString(tooSmall, sizeof(tooSmall)));  // "HomeNetwork" needs 12
+    TEST_ASSERT_EQUAL_STRING("", tooSmall);
+    TEST_ASSERT_FALSE(in.ok());
+    TEST_ASSERT_EQUAL_UINT32(0, in.getU32());
+
+    ConfigRecordReader past(buffer, length);
+    past.open(schema);
+    past.getF64();
+    past.getF64();
+    TEST_ASSERT_TRUE(past.ok());
+    past.getF64();  // Only 4 of the 20 payload bytes left
+    TEST_ASSERT_FALSE(past.ok());
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_config_service.cpp
+ * @brief Unit tests for ConfigService (live configuration apply)
+ *
+ * Tests validate:
+ * - Publishes before a poll are applied once at the newest version, only to the subscribers of that domain
+ * - A rejected apply is counted and reported; a busy one keeps the domain pending; ConfigStage never blocks
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include "../../src/utils/ConfigService.h"
+#include "../../src/utils/ConfigService.cpp"
+
+namespace {
+
+struct FakeSubsystem {
+    uint32_t applies = 0;
+    uint32_t lastVersion = 0;
+    ConfigApplyResult result = ConfigApplyResult::APPLIED;
+};
+
+ConfigApplyResult fakeApply(void* context, uint32_t version) {
+    FakeSubsystem* subsystem = static_cast<FakeSubsystem*>(context);
+    subsystem->applies++;
+    subsystem->lastVersion = version;
+    return subsystem->result;
+}
+
+}  // namespace
+
+/**
+ * @brief UT-054: Three uploads before a poll cost one apply at version 3; other domains are untouched
+ */
+void test_config_service_applies_latest_version() {
+    ConfigService service;
+    FakeSubsystem wifi;
+    FakeSubsystem calibration;
+    TEST_ASSERT_TRUE(service.subscribe(ConfigDomain::WIFI, "wifi", fakeApply, &wifi));
+    TEST_ASSERT_TRUE(service.subscribe(ConfigDomain::CALIBRATION, "calibration", fakeApply, &calibration));
+    TEST_ASSERT_FALSE(service.subscribe(ConfigDomain::WIFI, "null", nullptr, nullptr));
+    TEST_ASSERT_FALSE(service.subscribe(ConfigDomain::COUNT, "count", fakeApply, &wifi));
+    TEST_ASSERT_EQUAL_UINT8(2, service.count());
+
+    TEST_ASSERT_EQUAL_UINT8(0, service.poll());  // Boot configuration: nothing to apply
+    TEST_ASSERT_EQUAL_UINT32(0, wifi.applies);
+
+    TEST_ASSERT_EQUAL_UINT32(1, service.publish(ConfigDomain::WIFI));
+    TEST_ASSERT_EQUAL_UINT32(2, service.publish(ConfigDomain::WIFI));
+    TEST_ASSERT_EQUAL_UINT32(3, service.publish(ConfigDomain::WIFI));
+    TEST_ASSERT_TRUE(service.isPending(ConfigDomain::WIFI));
+    TEST_ASSERT_FALSE(service.isPending(ConfigDomain::CALIBRATION));
+
+    TEST_ASSERT_EQUAL_UINT8(0, service.poll());
+    TEST_ASSERT_EQUAL_UINT32(1, wifi.applies);
+    TEST_ASSERT_EQUAL_UINT32(3, wifi.lastVersion);
+    TEST_ASSERT_EQUAL_UINT32(0, calibration.applies);
+    TEST_ASSERT_EQUAL_UINT32(3, service.getAppliedVersion(ConfigDomain::WIFI));
+    TEST_ASSERT_FALSE(service.isPending(ConfigDomain::WIFI));
+
+    service.poll();
+    TEST_ASSERT_EQUAL_UINT32(1, wifi.applies);
+
+    // A domain without subscribers is still marked applied
+    service.publish(ConfigDomain::NMEA0183_ROUTES);
+    service.poll();
+    TEST_ASSERT_FALSE(service.isPending(ConfigDomain::NMEA0183_ROUTES));
+    TEST_ASSERT_EQUAL_UINT32(0, service.publish(ConfigDomain::COUNT));
+
+    // Names for GET /config and ?domain=
+    ConfigDomain domain = ConfigDomain::WIFI;
+    TEST_ASSERT_TRUE(ConfigDomainFromName("nmea0183_routes", domain));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigDomain::NMEA0183_ROUTES), static_cast<uint8_t>(domain));
+    TEST_ASSERT_FALSE(ConfigDomainFromName("log_filter", domain));
+    TEST_ASSERT_FALSE(ConfigDomainFromName(nullptr, domain));
+    TEST_ASSERT_EQUAL_STRING("calibration", ConfigDomainName(ConfigDomain::CALIBRATION));
+    TEST_ASSERT_EQUAL_STRING("unknown", ConfigDomainName(ConfigDomain::COUNT));
+}
+
+/**
+ * @brief UT-055: Rejections are counted and named, BUSY retries the domain, ConfigStage hands over once
+ */
+void test_config_service_rejected_and_busy() {
+    ConfigService service;
+    FakeSubsystem router;
+    FakeSubsystem display;
+    service.subscribe(ConfigDomain::NMEA0183_ROUTES, "routes", fakeApply, &router);
+    service.subscribe(ConfigDomain::NMEA0183_ROUTES, "display", fakeApply, &display);
+
+    // Invalid routing file: counted, the next subscriber still runs
+    router.result = ConfigApplyResult::REJECTED;
+    service.publish(ConfigDomain::NMEA0183_ROUTES);
+    TEST_ASSERT_EQUAL_UINT8(1, service.poll());
+    TEST_ASSERT_EQUAL_UINT32(1, display.applies);
+    TEST_ASSERT_EQUAL_UINT32(1, service.getRejected(ConfigDomain::NMEA0183_ROUTES));
+    TEST_ASSERT_EQUAL_STRING("routes", service.getLastRejected());
+    TEST_ASSERT_FALSE(service.isPending(ConfigDomain::NMEA0183_ROUTES));
+
+    // Busy: the later subscribers wait, the whole domain runs again next poll
+    router.result = ConfigApplyResult::BUSY;
+    service.publish(ConfigDomain::NMEA0183_ROUTES);
+    TEST_ASSERT_EQUAL_UINT8(0, service.poll());
+    TEST_ASSERT_EQUAL_UINT32(1, display.applies);
+    TEST_ASSERT_TRUE(service.isPending(ConfigDomain::NMEA0183_ROUTES));
+    router.result = ConfigApplyResult::APPLIED;
+    service.poll();
+    TEST_ASSERT_EQUAL_UINT32(3, router.applies);
+    TEST_ASSERT_EQUAL_UINT32(2, display.applies);
+    TEST_ASSERT_EQUAL_UINT32(2, display.lastVersion);
+    TEST_ASSERT_FALSE(service.isPending(ConfigDomain::NMEA0183_ROUTES));
+
+    StaticJsonWriter<512> json;
+    service.writeJson(json);
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"wifi\":{\"version\":0,\"applied\":0,\"ok\":true,\"rejected\":0,\"subscribers\":0},"
+        "\"calibration\":{\"version\":0,\"applied\":0,\"ok\":true,\"rejected\":0,\"subscribers\":0},"
+        "\"nmea0183_routes\":{\"version\":2,\"applied\":2,\"ok\":true,\"rejected\":1,\"subscribers\":2},"
+        "\"alarms\":{\"version\":0,\"applied\":0,\"ok\":true,\"rejected\":0,\"subscribers\":0},"
+        "\"last_rejected\":\"routes\"}",
+        json.c_str());
+
+    // Stage: newest object wins, taken once
+    ConfigStage<uint32_t> stage;
+    bool busy = true;
+    uint32_t value = 0;
+    TEST_ASSERT_FALSE(stage.take(value, busy));
+    TEST_ASSERT_FALSE(busy);
+    TEST_ASSERT_TRUE(stage.stage(7));
+    TEST_ASSERT_TRUE(stage.stage(8));
+    TEST_ASSERT_TRUE(stage.take(value, busy));
+    TEST_ASSERT_EQUAL_UINT32(8, value);
+    TEST_ASSERT_FALSE(stage.take(value, busy));
+}
@@ -0,0 +1,76 @@
+/**
+ * @file test_cpu_idle_monitor.cpp
+ * @brief Unit tests for CpuIdleMonitor (per-core idle windows)
+ *
+ * Tests validate:
+ * - Idle cycles over the window's wall time, per core, rounded and capped at 100%
+ * - Unknown before the first window and for cores without an idle hook
+ * - Busiest-core and average summaries; 32-bit counter wrap-around
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include "../../src/utils/CpuIdleMonitor.h"
+#include "../../src/utils/CpuIdleMonitor.cpp"
+
+/**
+ * @brief UT-026: Idle share per core, one window at a time
+ */
+void test_cpu_idle_monitor_windows() {
+    CpuIdleMonitor monitor;
+    monitor.enableCore(0);
+    monitor.enableCore(1);
+    TEST_ASSERT_EQUAL_UINT8(CPU_IDLE_UNKNOWN, monitor.getIdlePercent(0));
+
+    monitor.closeWindow(1000000, 240);  // Starts the first window only
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.getWindowCount());
+    TEST_ASSERT_EQUAL_UINT8(CPU_IDLE_UNKNOWN, monitor.getMinIdlePercent());
+
+    // 5 s at 240 MHz = 1.2e9 cycles: core 0 slept 25%, core 1 87.5%
+    monitor.addIdleCycles(0, 300000000);
+    monitor.addIdleCycles(1, 1050000000);
+    monitor.closeWindow(6000000, 240);
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.getWindowCount());
+    TEST_ASSERT_EQUAL_UINT8(25, monitor.getIdlePercent(0));
+    TEST_ASSERT_EQUAL_UINT8(88, monitor.getIdlePercent(1));
+    TEST_ASSERT_EQUAL_UINT8(25, monitor.getMinIdlePercent());
+    TEST_ASSERT_EQUAL_UINT8(57, monitor.getAverageIdlePercent());
+
+    // Next window counts only its own cycles; nothing slept = 0%
+    monitor.addIdleCycles(1, 1200000000);
+    monitor.closeWindow(11000000, 240);
+    TEST_ASSERT_EQUAL_UINT8(0, monitor.getIdlePercent(0));
+    TEST_ASSERT_EQUAL_UINT8(100, monitor.getIdlePercent(1));
+}
+
+/**
+ * @brief UT-027: A core without an idle hook stays unknown and is left out of the summaries
+ */
+void test_cpu_idle_monitor_unmeasured_core() {
+    CpuIdleMonitor monitor;
+    monitor.enableCore(1);
+    monitor.closeWindow(0, 160);
+    monitor.addIdleCycles(1, 400000000);  // 2.5 s of 5 s at 160 MHz
+    monitor.closeWindow(5000000, 160);
+
+    TEST_ASSERT_EQUAL_UINT8(CPU_IDLE_UNKNOWN, monitor.getIdlePercent(0));
+    TEST_ASSERT_EQUAL_UINT8(50, monitor.getIdlePercent(1));
+    TEST_ASSERT_EQUAL_UINT8(50, monitor.getMinIdlePercent());
+    TEST_ASSERT_EQUAL_UINT8(50, monitor.getAverageIdlePercent());
+    TEST_ASSERT_EQUAL_UINT8(CPU_IDLE_UNKNOWN, monitor.getIdlePercent(CpuIdleMonitor::MAX_CORES));
+}
+
+/**
+ * @brief UT-028: Idle totals and the microsecond clock may wrap within a window
+ */
+void test_cpu_idle_monitor_wraparound() {
+    CpuIdleMonitor monitor;
+    monitor.enableCore(0);
+    monitor.addIdleCycles(0, 0xFFFFFFFFu - 100);
+    monitor.closeWindow(0xFFFFFFFFu - 999999, 240);  // 1 s before the micros() wrap
+
+    monitor.addIdleCycles(0, 600000101u);             // Total wraps past zero
+    monitor.closeWindow(4000000, 240);                // 5 s window across the wrap
+    TEST_ASSERT_EQUAL_UINT8(50, monitor.getIdlePercent(0));
+}
@@ -0,0 +1,95 @@
+/**
+ * @file test_fixed_string.cpp
+ * @brief Unit tests for FixedString / TextBuffer (bounded text building)
+ *
+ * Tests validate:
+ * - append/appendf/format build the expected text
+ * - Text beyond the capacity is cut (prefix kept, NUL-terminated) and reported
+ * - Copies own their storage; clear() and format() reset the truncation flag
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/FixedString.h"
+#include "../../src/utils/FixedString.cpp"
+
+/**
+ * @brief UT-043: Append and format, truncation at the capacity
+ */
+void test_fixed_string_append_and_truncation() {
+    FixedString<16> text;
+    TEST_ASSERT_TRUE(text.empty());
+    TEST_ASSERT_EQUAL(15, text.capacity());
+
+    text.append("/app").append('.').append("js").append(".gz");
+    TEST_ASSERT_EQUAL_STRING("/app.js.gz", text.c_str());
+    TEST_ASSERT_EQUAL(10, text.length());
+    TEST_ASSERT_FALSE(text.truncated());
+
+    text.format("%s:%u", "port", 3000u);
+    TEST_ASSERT_EQUAL_STRING("port:3000", text.c_str());
+    text.append(42ul).append(-7l);
+    TEST_ASSERT_EQUAL_STRING("port:300042-7", text.c_str());
+
+    // appendf past the end: snprintf keeps what fits
+    text.appendf("%s", "abcdef");
+    TEST_ASSERT_EQUAL_STRING("port:300042-7ab", text.c_str());
+    TEST_ASSERT_EQUAL(15, text.length());
+    TEST_ASSERT_TRUE(text.truncated());
+
+    // Full: further appends change nothing and stay truncated
+    text.append('x');
+    TEST_ASSERT_EQUAL_STRING("port:300042-7ab", text.c_str());
+    TEST_ASSERT_TRUE(text.truncated());
+
+    // format() starts over
+    text.format("ws://%s", "10.0.0.1");
+    TEST_ASSERT_FALSE(text.truncated());
+    TEST_ASSERT_TRUE(text.equals("ws://10.0.0.1"));
+
+    // append() past the end keeps the prefix
+    text.clear();
+    text.append("0123456789abcdefghij");
+    TEST_ASSERT_EQUAL_STRING("0123456789abcde", text.c_str());
+    TEST_ASSERT_TRUE(text.truncated());
+
+    text.clear();
+    text.append(static_cast<const char*>(nullptr)).append("ab", 1);
+    TEST_ASSERT_EQUAL_STRING("a", text.c_str());
+    TEST_ASSERT_FALSE(text.truncated());
+}
+
+/**
+ * @brief UT-044: Copies own their storage; TextBuffer over a caller buffer
+ */
+void test_fixed_string_copy_and_external_buffer() {
+    FixedString<8> a("abc");
+    FixedString<8> b(a);
+    a.append("def");
+    TEST_ASSERT_EQUAL_STRING("abcdef", a.c_str());
+    TEST_ASSERT_EQUAL_STRING("abc", b.c_str());
+    TEST_ASSERT_NOT_EQUAL(a.c_str(), b.c_str());
+
+    b = a;
+    TEST_ASSERT_EQUAL_STRING("abcdef", b.c_str());
+    b = "xyz";
+    TEST_ASSERT_EQUAL_STRING("xyz", b.c_str());
+    TEST_ASSERT_EQUAL(3, b.length());
+
+    // Truncation travels with the copy
+    FixedString<4> cut("toolong");
+    FixedString<4> copy(cut);
+    TEST_ASSERT_EQUAL_STRING("too", copy.c_str());
+    TEST_ASSERT_TRUE(copy.truncated());
+
+    // Wrapping a caller buffer never writes past it
+    char raw[6];
+    memset(raw, 'Z', sizeof(raw));
+    TextBuffer buffer(raw, 5);
+    buffer.appendf("%d-%d", 1234, 5678);
+    TEST_ASSERT_EQUAL_STRING("1234", raw);
+    TEST_ASSERT_EQUAL_INT('Z', raw[5]);
+    TEST_ASSERT_TRUE(buffer.truncated());
+}
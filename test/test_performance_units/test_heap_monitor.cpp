@@ -0,0 +1,81 @@
+/**
+ * @file test_heap_monitor.cpp
+ * @brief Unit tests for HeapMonitor (fragmentation state, allocation rates)
+ *
+ * Tests validate:
+ * - Fragmentation is the share of free heap outside the largest block
+ * - FRAGMENTED at HEAP_FRAG_WARN_PCT, RECOVERED only below HEAP_FRAG_CLEAR_PCT
+ * - Rates per second from the counter increase; unknown without hooks
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/HeapMonitor.h"
+#include "../../src/utils/HeapMonitor.cpp"
+
+static HeapSample heapSample(uint32_t freeBytes, uint32_t largest, uint32_t allocs = 0, uint32_t frees = 0,
+                             uint32_t failed = 0) {
+    HeapSample sample = {freeBytes, largest, freeBytes, allocs, frees, failed, failed > 0 ? 2048u : 0u};
+    return sample;
+}
+
+/**
+ * @brief UT-041: One FRAGMENTED per episode, RECOVERED below the clear threshold
+ */
+void test_heap_monitor_fragmentation_hysteresis() {
+    TEST_ASSERT_EQUAL_UINT8(0, HeapMonitor::fragmentationPercent(0, 0));
+    TEST_ASSERT_EQUAL_UINT8(0, HeapMonitor::fragmentationPercent(100000, 100000));
+    TEST_ASSERT_EQUAL_UINT8(50, HeapMonitor::fragmentationPercent(100000, 50000));
+    TEST_ASSERT_EQUAL_UINT8(96, HeapMonitor::fragmentationPercent(61440, 2036));
+
+    HeapMonitor monitor;
+    TEST_ASSERT_EQUAL(HeapEvent::NONE, monitor.update(heapSample(150000, 110000), 0));
+    TEST_ASSERT_EQUAL_UINT8(26, monitor.getFragmentationPercent());
+    TEST_ASSERT_FALSE(monitor.isFragmented());
+
+    TEST_ASSERT_EQUAL(HeapEvent::FRAGMENTED, monitor.update(heapSample(61440, 2036), 10000));
+    TEST_ASSERT_TRUE(monitor.isFragmented());
+    TEST_ASSERT_EQUAL(HeapEvent::NONE, monitor.update(heapSample(61440, 2036), 20000));   // Once per episode
+
+    // Between the thresholds: still fragmented
+    uint32_t between = 100000 - (HEAP_FRAG_CLEAR_PCT + 1) * 1000;   // HEAP_FRAG_CLEAR_PCT + 1 percent
+    TEST_ASSERT_EQUAL(HeapEvent::NONE, monitor.update(heapSample(100000, between), 30000));
+    TEST_ASSERT_TRUE(monitor.isFragmented());
+
+    TEST_ASSERT_EQUAL(HeapEvent::RECOVERED, monitor.update(heapSample(100000, 80000), 40000));
+    TEST_ASSERT_FALSE(monitor.isFragmented());
+    TEST_ASSERT_EQUAL_UINT8(96, monitor.getMaxFragmentationPercent());
+}
+
+/**
+ * @brief UT-042: Per-second rates over the window, failed allocations per window, JSON
+ */
+void test_heap_monitor_rates_and_json() {
+    HeapMonitor noHooks;
+    noHooks.update(heapSample(150000, 110000, 0, 0), 0);
+    noHooks.update(heapSample(150000, 110000, 5000, 4990), 10000);
+    TEST_ASSERT_EQUAL_UINT32(HEAP_RATE_UNKNOWN, noHooks.getAllocsPerSecond());
+
+    HeapMonitor monitor;
+    monitor.setCountersAvailable(true);
+    monitor.update(heapSample(150000, 110000, 1000, 900), 0);
+    TEST_ASSERT_EQUAL_UINT32(HEAP_RATE_UNKNOWN, monitor.getAllocsPerSecond());   // First sample: no window
+
+    monitor.update(heapSample(61440, 2036, 5120, 4990, 3), 10000);
+    TEST_ASSERT_EQUAL_UINT32(412, monitor.getAllocsPerSecond());
+    TEST_ASSERT_EQUAL_UINT32(409, monitor.getFreesPerSecond());
+    TEST_ASSERT_EQUAL_UINT32(3, monitor.getNewFailedAllocs());
+
+    StaticJsonWriter<384> json;
+    TEST_ASSERT_TRUE(monitor.writeJson(json));
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"free\":61440,\"largest_block\":2036,\"min_free\":61440,\"fragmentation_pct\":96,"
+        "\"max_fragmentation_pct\":96,\"fragmented\":true,\"allocs_per_s\":412,\"frees_per_s\":409,"
+        "\"failed_allocs\":3,\"last_failed_size\":2048,\"sampled_ms\":10000}",
+        json.c_str());
+
+    monitor.update(heapSample(61440, 2036, 5200, 5070, 3), 20000);
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.getNewFailedAllocs());   // None since the last sample
+}
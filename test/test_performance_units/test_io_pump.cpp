@@ -0,0 +1,134 @@
+/**
+ * @file test_io_pump.cpp
+ * @brief Unit tests for IoPump (budgeted round-robin over the bus inputs)
+ *
+ * Tests validate:
+ * - Steps alternate between sources; the first source rotates per tick
+ * - A tick stops at the budget and the rest runs in the next tick
+ * - Interval sources run only when due
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/IoPump.h"
+#include "../../src/utils/IoPump.cpp"
+
+static uint32_t _mockUs = 0;
+
+static uint32_t mockMicros() {
+    return _mockUs;
+}
+
+/// Fake input: @c pending units, each step consumes one and takes @c stepUs
+struct FakeInput {
+    char tag;
+    uint32_t pending;
+    uint32_t stepUs;
+    char* trace;        ///< Appends tag per step
+};
+
+static bool fakeStep(void* context) {
+    FakeInput* input = static_cast<FakeInput*>(context);
+    _mockUs += input->stepUs;
+    if (input->pending > 0) {
+        input->pending--;
+    }
+    size_t len = strlen(input->trace);
+    input->trace[len] = input->tag;
+    input->trace[len + 1] = '\0';
+    return input->pending > 0;
+}
+
+/**
+ * @brief UT-020: Sources take turns until drained; the next tick starts with the next source
+ */
+void test_io_pump_round_robin() {
+    char trace[32] = "";
+    FakeInput a = {'a', 3, 10, trace};
+    FakeInput b = {'b', 1, 10, trace};
+    IoPump pump(mockMicros);
+    TEST_ASSERT_EQUAL_INT8(0, pump.add("a", fakeStep, &a));
+    TEST_ASSERT_EQUAL_INT8(1, pump.add("b", fakeStep, &b));
+
+    TEST_ASSERT_FALSE(pump.run(0, 10000));
+    TEST_ASSERT_EQUAL_STRING("abaa", trace);  // b drained after one step, a keeps going
+
+    trace[0] = '\0';
+    a.pending = 2;
+    b.pending = 2;
+    TEST_ASSERT_FALSE(pump.run(5, 10000));
+    TEST_ASSERT_EQUAL_STRING("baba", trace);  // Rotated start
+
+    TEST_ASSERT_EQUAL_UINT32(2, pump.getTicks());
+    TEST_ASSERT_EQUAL_UINT32(5, pump.at(0)->steps);
+    TEST_ASSERT_EQUAL_UINT32(50, pump.at(0)->busyUs);
+    TEST_ASSERT_EQUAL_UINT32(0, pump.getBudgetHits());
+}
+
+/**
+ * @brief UT-021: A flooded input is cut off at the budget; the remainder waits for the next tick
+ */
+void test_io_pump_budget() {
+    char trace[64] = "";
+    FakeInput flood = {'f', 100, 1000, trace};
+    FakeInput quiet = {'q', 1, 100, trace};
+    IoPump pump(mockMicros);
+    pump.add("flood", fakeStep, &flood);
+    pump.add("quiet", fakeStep, &quiet);
+
+    TEST_ASSERT_TRUE(pump.run(0, 2500));
+    TEST_ASSERT_EQUAL_STRING("fqff", trace);  // Stops once 2500 us are used
+    TEST_ASSERT_EQUAL_UINT32(97, flood.pending);
+    TEST_ASSERT_EQUAL_UINT32(1, pump.getBudgetHits());
+    TEST_ASSERT_EQUAL_UINT32(1, pump.at(0)->deferred);
+    TEST_ASSERT_EQUAL_UINT32(0, pump.at(1)->deferred);
+    TEST_ASSERT_EQUAL_UINT32(3100, pump.getMaxTickUs());
+
+    // Next tick: the quiet input is served first, before the flood spends the budget
+    trace[0] = '\0';
+    quiet.pending = 1;
+    TEST_ASSERT_TRUE(pump.run(5, 2500));
+    TEST_ASSERT_EQUAL_STRING("qfff", trace);
+
+    StaticJsonWriter<256> json;
+    TEST_ASSERT_TRUE(pump.writeStats(json));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"budget_hits\":2"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"name\":\"flood\",\"steps\":6,\"busy_us\":6000,\"max_us\":1000,\"deferred\":2}"));
+
+    pump.clearStats();
+    TEST_ASSERT_EQUAL_UINT32(0, pump.getTicks());
+    TEST_ASSERT_EQUAL_UINT32(0, pump.at(0)->steps);
+    TEST_ASSERT_NOT_NULL(pump.at(1));
+    TEST_ASSERT_NULL(pump.at(2));
+}
+
+/**
+ * @brief UT-022: Interval sources run on their first tick, then once per interval
+ */
+void test_io_pump_interval_sources() {
+    char trace[32] = "";
+    FakeInput every = {'e', 0, 10, trace};
+    FakeInput slow = {'s', 0, 10, trace};
+    IoPump pump(mockMicros);
+    pump.add("every", fakeStep, &every);
+    pump.add("slow", fakeStep, &slow, 1000);
+
+    pump.run(0, 10000);
+    pump.run(500, 10000);
+    pump.run(999, 10000);
+    pump.run(1000, 10000);
+    pump.run(1500, 10000);
+    pump.run(2000, 10000);
+
+    TEST_ASSERT_EQUAL_UINT32(6, pump.at(0)->steps);
+    TEST_ASSERT_EQUAL_UINT32(3, pump.at(1)->steps);  // 0, 1000, 2000
+
+    IoPump full(mockMicros);
+    for (uint8_t i = 0; i < IO_PUMP_MAX_SOURCES; i++) {
+        TEST_ASSERT_EQUAL_INT8(i, full.add("x", fakeStep, &every));
+    }
+    TEST_ASSERT_EQUAL_INT8(-1, full.add("x", fakeStep, &every));
+    TEST_ASSERT_EQUAL_INT8(-1, pump.add("null", nullptr, nullptr));
+}
@@ -0,0 +1,77 @@
+/**
+ * @file test_loop_latency.cpp
+ * @brief Unit tests for the per-iteration latency histogram of LoopPerformanceMonitor
+ *
+ * Tests validate:
+ * - p50/p95/p99/max are published per completed 5-second window
+ * - A single long stall is visible as the window maximum
+ * - Repeated stalls move p99; the next window starts empty
+ * - micros() wrap-around inside a window
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include "../../src/utils/LatencyHistogram.h"
+#include "../../src/utils/LatencyHistogram.cpp"
+#include "../../src/utils/LoopPerformanceMonitor.h"
+#include "../../src/utils/LoopPerformanceMonitor.cpp"
+
+/// Clock driving the monitor: one endLoop() per iteration of @p durationUs
+struct LoopClock {
+    uint32_t us;
+    uint64_t elapsedUs;
+
+    void iterate(LoopPerformanceMonitor& monitor, uint32_t durationUs) {
+        us += durationUs;
+        elapsedUs += durationUs;
+        monitor.endLoop(static_cast<uint32_t>(elapsedUs / 1000), us);
+    }
+};
+
+/**
+ * @brief UT-018: One 300 ms stall among 4 ms iterations is the window maximum, not hidden in p99
+ */
+void test_loop_latency_single_stall_is_max() {
+    LoopPerformanceMonitor monitor;
+    LoopClock clock = {0, 0};
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.getLatencyPercentile(99));
+
+    clock.iterate(monitor, 0);  // First call: no duration yet
+    clock.iterate(monitor, 300000);
+    while (monitor.getWindowCount() == 0) {
+        clock.iterate(monitor, 4000);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.getWindowCount());
+    TEST_ASSERT_EQUAL_UINT32(300000, monitor.getLatencyMax());
+    TEST_ASSERT_EQUAL_UINT32(4095, monitor.getLatencyPercentile(50));   // [3072, 4096) bucket
+    TEST_ASSERT_EQUAL_UINT32(4095, monitor.getLatencyPercentile(95));
+    TEST_ASSERT_EQUAL_UINT32(4095, monitor.getLatencyPercentile(99));
+    TEST_ASSERT_EQUAL_UINT32(1, monitor.getLastWindow().getBucket(LatencyHistogram::bucketFor(300000)));
+    TEST_ASSERT_TRUE(monitor.getLoopFrequency() > 0);
+}
+
+/**
+ * @brief UT-019: Stalls in 2% of iterations move p99; a quiet next window replaces the figures
+ */
+void test_loop_latency_p99_per_window() {
+    LoopPerformanceMonitor monitor;
+    LoopClock clock = {0xFFFF0000u, 0};  // micros() wraps during the first window
+    clock.iterate(monitor, 0);
+
+    uint32_t i = 0;
+    while (monitor.getWindowCount() == 0) {
+        clock.iterate(monitor, (i++ % 50) == 0 ? 50000 : 2000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(50000, monitor.getLatencyPercentile(99));
+    TEST_ASSERT_EQUAL_UINT32(2047, monitor.getLatencyPercentile(95));
+    TEST_ASSERT_EQUAL_UINT32(50000, monitor.getLatencyMax());
+
+    while (monitor.getWindowCount() == 1) {
+        clock.iterate(monitor, 1000);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1000, monitor.getLatencyPercentile(99));  // Clamped to the maximum
+    TEST_ASSERT_EQUAL_UINT32(1000, monitor.getLatencyMax());
+    TEST_ASSERT_EQUAL_UINT32(0, monitor.getLastWindow().getBucket(LatencyHistogram::bucketFor(50000)));
+}
@@ -6,11 +6,47 @@
  * - LoopPerformanceMonitor (counter, timing, frequency calculation)
  * - Frequency calculation accuracy
  * - Display formatting logic
+ * - ReactionProfiler (per-reaction cycles, lateness, report)
+ * - Loop iteration latency percentiles (LoopPerformanceMonitor histogram)
+ * - IoPump (budgeted round-robin over the bus inputs)
+ * - TraceRecorder (trace event ring, Chrome trace_event export)
+ * - BootTimeline (setup step times, boot milestones)
+ * - HeapMonitor (fragmentation state, allocation rates)
+ * - FixedString (bounded text building, truncation)
+ * - WsBufferPool (preallocated WebSocket send buffers)
+ * - StaticInstance (static placement of boot-time objects)
+ * - MemoryBudget (per-component reservation table)
+ * - BufferPlacement (PSRAM-first large-buffer placement)
  *
  * Test Organization:
  * - UT-001 to UT-005: LoopPerformanceMonitor tests
  * - UT-006 to UT-009: Frequency calculation tests
  * - UT-010 to UT-014: Display formatting tests
+ * - UT-015 to UT-017: ReactionProfiler tests
+ * - UT-018 to UT-019: Loop latency histogram tests
+ * - UT-020 to UT-022: IoPump tests
+ * - UT-023 to UT-025: TraceRecorder tests
+ * - UT-026 to UT-028: CpuIdleMonitor tests
+ * - UT-029 to UT-031: CalculationTiming tests
+ * - UT-032 to UT-034: ReactionScheduler tests
+ * - UT-035 to UT-036: StallWatchdog tests
+ * - UT-037: TraceRecorder open span lookup
+ * - UT-038: ReactionScheduler over-budget flag
+ * - UT-039 to UT-040: BootTimeline tests
+ * - UT-041 to UT-042: HeapMonitor tests
+ * - UT-043 to UT-044: FixedString tests
+ * - UT-045 to UT-046: WsBufferPool tests
+ * - UT-047: StaticInstance tests
+ * - UT-048: MemoryBudget tests
+ * - UT-049: BufferPlacement tests
+ * - UT-050 to UT-051: ScratchArena tests
+ * - UT-052 to UT-053: WriteBehind tests
+ * - UT-054 to UT-055: ConfigService tests
+ * - UT-056 to UT-057: WiFiFastConnect tests
+ * - UT-058 to UT-059: ConfigRecord tests
+ * - UT-060 to UT-061: OtaSession tests
+ * - UT-062 to UT-063: TripCounters tests
+ * - UT-064 to UT-065: BatterySocEstimator tests
  *
  * @version 1.0.0
  * @date 2025-10-10
@@ -38,6 +74,110 @@ void test_format_frequency_low_single_digit();
 void test_format_frequency_high_abbreviated();
 void test_format_frequency_fits_character_limit();
 
+// Forward declarations for ReactionProfiler tests
+void test_reaction_profiler_registration();
+void test_reaction_profiler_timing_and_lateness();
+void test_reaction_profiler_report();
+
+// Forward declarations for loop latency histogram tests
+void test_loop_latency_single_stall_is_max();
+void test_loop_latency_p99_per_window();
+
+// Forward declarations for IoPump tests
+void test_io_pump_round_robin();
+void test_io_pump_budget();
+void test_io_pump_interval_sources();
+
+// Forward declarations for TraceRecorder tests
+void test_trace_recorder_ring();
+void test_trace_recorder_chrome_export();
+void test_trace_recorder_chunked_read();
+void test_trace_recorder_last_open();
+
+// Forward declarations for CpuIdleMonitor tests
+void test_cpu_idle_monitor_windows();
+void test_cpu_idle_monitor_unmeasured_core();
+void test_cpu_idle_monitor_wraparound();
+
+// Forward declarations for CalculationTiming tests
+void test_calculation_timing_period_jitter();
+void test_calculation_timing_deadline();
+void test_calculation_timing_reset_and_json();
+
+// Forward declarations for ReactionScheduler tests
+void test_reaction_scheduler_priority();
+void test_reaction_scheduler_background_deferral();
+void test_reaction_scheduler_budget_and_stats();
+void test_reaction_scheduler_over_budget_flag();
+
+// Forward declarations for StallWatchdog tests
+void test_stall_watchdog_detection();
+void test_stall_watchdog_record_survives_reset();
+
+// Forward declarations for BootTimeline tests
+void test_boot_timeline_steps();
+void test_boot_timeline_milestones_and_json();
+
+// Forward declarations for HeapMonitor tests
+void test_heap_monitor_fragmentation_hysteresis();
+void test_heap_monitor_rates_and_json();
+
+// Forward declarations for FixedString tests
+void test_fixed_string_append_and_truncation();
+void test_fixed_string_copy_and_external_buffer();
+
+// Forward declarations for WsBufferPool tests
+void test_ws_buffer_pool_classes_and_reuse();
+void test_ws_buffer_pool_exhaustion_and_json();
+
+// Forward declarations for StaticInstance tests
+void test_static_instance_placement_and_footprint();
+
+// Forward declarations for MemoryBudget tests
+void test_memory_budget_totals_and_json();
+
+// Forward declarations for BufferPlacement tests
+void test_buffer_placement_policy();
+
+// Forward declarations for ScratchArena tests
+void test_scratch_arena_alignment_and_overflow();
+void test_scratch_arena_scope_and_high_water();
+
+// Forward declarations for WriteBehind tests
+void test_write_behind_coalesces_changes();
+void test_write_behind_retry_and_flush();
+void test_config_service_applies_latest_version();
+void test_config_service_rejected_and_busy();
+void test_wifi_static_ip_parse();
+void test_wifi_connect_cache_and_stats();
+void test_config_record_round_trip();
+void test_config_record_rejects_damage();
+void test_ota_session_streams_image();
+void test_ota_session_rejects_bad_uploads();
+void test_trip_counters_integrate_samples();
+void test_trip_counters_commit_schedule();
+void test_battery_soc_integrates_with_corrections();
+void test_battery_soc_rest_anchor_and_persistence();
+void test_wifi_ap_fallback_starts_and_retries();
+void test_wifi_ap_fallback_linger_and_stop();
+void test_web_traffic_routes();
+void test_web_traffic_websockets();
+void test_metric_sample_format();
+void test_metric_writer_document();
+void test_chunked_json_pieces_join();
+void test_chunked_json_overflow_and_restart();
+void test_ws_liveness_close_then_abort();
+void test_ws_liveness_slots_and_json();
+void test_alloc_tracker_scopes_and_tags();
+void test_alloc_tracker_limits_and_json();
+void test_alloc_tracker_hot_paths_allocation_free();
+void test_soak_monitor_flags_heap_leak();
+void test_soak_monitor_counters_and_latency();
+void test_soak_monitor_csv_and_json();
+void test_telemetry_counters_rates_and_sources();
+void test_telemetry_histogram_interval_quantiles();
+void test_telemetry_json_metrics_and_display();
+
 // Test fixtures
 void setUp() {
     // Setup code if needed
@@ -76,5 +216,139 @@ int main(int argc, char **argv) {
     RUN_TEST(test_format_frequency_high_abbreviated);
     RUN_TEST(test_format_frequency_fits_character_limit);
 
+    // ReactionProfiler tests
+    RUN_TEST(test_reaction_profiler_registration);
+    RUN_TEST(test_reaction_profiler_timing_and_lateness);
+    RUN_TEST(test_reaction_profiler_report);
+
+    // Loop latency histogram tests
+    RUN_TEST(test_loop_latency_single_stall_is_max);
+    RUN_TEST(test_loop_latency_p99_per_window);
+
+    // IoPump tests (UT-020 to UT-022)
+    RUN_TEST(test_io_pump_round_robin);
+    RUN_TEST(test_io_pump_budget);
+    RUN_TEST(test_io_pump_interval_sources);
+
+    // TraceRecorder tests (UT-023 to UT-025)
+    RUN_TEST(test_trace_recorder_ring);
+    RUN_TEST(test_trace_recorder_chrome_export);
+    RUN_TEST(test_trace_recorder_chunked_read);
+
+    // CpuIdleMonitor tests (UT-026 to UT-028)
+    RUN_TEST(test_cpu_idle_monitor_windows);
+    RUN_TEST(test_cpu_idle_monitor_unmeasured_core);
+    RUN_TEST(test_cpu_idle_monitor_wraparound);
+
+    // CalculationTiming tests (UT-029 to UT-031)
+    RUN_TEST(test_calculation_timing_period_jitter);
+    RUN_TEST(test_calculation_timing_deadline);
+    RUN_TEST(test_calculation_timing_reset_and_json);
+
+    // ReactionScheduler tests (UT-032 to UT-034)
+    RUN_TEST(test_reaction_scheduler_priority);
+    RUN_TEST(test_reaction_scheduler_background_deferral);
+    RUN_TEST(test_reaction_scheduler_budget_and_stats);
+
+    // StallWatchdog tests (UT-035 to UT-036)
+    RUN_TEST(test_stall_watchdog_detection);
+    RUN_TEST(test_stall_watchdog_record_survives_reset);
+
+    // Stall report helpers (UT-037 to UT-038)
+    RUN_TEST(test_trace_recorder_last_open);
+    RUN_TEST(test_reaction_scheduler_over_budget_flag);
+
+    // BootTimeline tests (UT-039 to UT-040)
+    RUN_TEST(test_boot_timeline_steps);
+    RUN_TEST(test_boot_timeline_milestones_and_json);
+
+    // HeapMonitor tests (UT-041 to UT-042)
+    RUN_TEST(test_heap_monitor_fragmentation_hysteresis);
+    RUN_TEST(test_heap_monitor_rates_and_json);
+
+    // FixedString tests (UT-043 to UT-044)
+    RUN_TEST(test_fixed_string_append_and_truncation);
+    RUN_TEST(test_fixed_string_copy_and_external_buffer);
+
+    // WsBufferPool tests (UT-045 to UT-046)
+    RUN_TEST(test_ws_buffer_pool_classes_and_reuse);
+    RUN_TEST(test_ws_buffer_pool_exhaustion_and_json);
+
+    // StaticInstance tests (UT-047)
+    RUN_TEST(test_static_instance_placement_and_footprint);
+
+    // MemoryBudget tests (UT-048)
+    RUN_TEST(test_memory_budget_totals_and_json);
+
+    // BufferPlacement tests (UT-049)
+    RUN_TEST(test_buffer_placement_policy);
+
+    // ScratchArena tests (UT-050 to UT-051)
+    RUN_TEST(test_scratch_arena_alignment_and_overflow);
+    RUN_TEST(test_scratch_arena_scope_and_high_water);
+
+    // WriteBehind tests (UT-052 to UT-053)
+    RUN_TEST(test_write_behind_coalesces_changes);
+    RUN_TEST(test_write_behind_retry_and_flush);
+
+    // ConfigService tests (UT-054 to UT-055)
+    RUN_TEST(test_config_service_applies_latest_version);
+    RUN_TEST(test_config_service_rejected_and_busy);
+
+    // WiFiFastConnect tests (UT-056 to UT-057)
+    RUN_TEST(test_wifi_static_ip_parse);
+    RUN_TEST(test_wifi_connect_cache_and_stats);
+
+    // ConfigRecord tests (UT-058 to UT-059)
+    RUN_TEST(test_config_record_round_trip);
+    RUN_TEST(test_config_record_rejects_damage);
+
+    // OtaSession tests (UT-060 to UT-061)
+    RUN_TEST(test_ota_session_streams_image);
+    RUN_TEST(test_ota_session_rejects_bad_uploads);
+
+    // TripCounters tests (UT-062 to UT-063)
+    RUN_TEST(test_trip_counters_integrate_samples);
+    RUN_TEST(test_trip_counters_commit_schedule);
+
+    // BatterySocEstimator tests (UT-064 to UT-065)
+    RUN_TEST(test_battery_soc_integrates_with_corrections);
+    RUN_TEST(test_battery_soc_rest_anchor_and_persistence);
+
+    // WiFiApFallback tests (UT-066 to UT-067)
+    RUN_TEST(test_wifi_ap_fallback_starts_and_retries);
+    RUN_TEST(test_wifi_ap_fallback_linger_and_stop);
+
+    // WebTrafficStats tests (UT-068 to UT-069)
+    RUN_TEST(test_web_traffic_routes);
+    RUN_TEST(test_web_traffic_websockets);
+
+    // MetricRegistry tests (UT-070 to UT-071)
+    RUN_TEST(test_metric_sample_format);
+    RUN_TEST(test_metric_writer_document);
+
+    // ChunkedJsonStream tests (UT-072 to UT-073)
+    RUN_TEST(test_chunked_json_pieces_join);
+    RUN_TEST(test_chunked_json_overflow_and_restart);
+
+    // WsLiveness tests (UT-074 to UT-075)
+    RUN_TEST(test_ws_liveness_close_then_abort);
+    RUN_TEST(test_ws_liveness_slots_and_json);
+
+    // AllocTracker tests (UT-076 to UT-078)
+    RUN_TEST(test_alloc_tracker_scopes_and_tags);
+    RUN_TEST(test_alloc_tracker_limits_and_json);
+    RUN_TEST(test_alloc_tracker_hot_paths_allocation_free);
+
+    // SoakMonitor tests (UT-079 to UT-081)
+    RUN_TEST(test_soak_monitor_flags_heap_leak);
+    RUN_TEST(test_soak_monitor_counters_and_latency);
+    RUN_TEST(test_soak_monitor_csv_and_json);
+
+    // TelemetryRegistry tests (UT-082 to UT-084)
+    RUN_TEST(test_telemetry_counters_rates_and_sources);
+    RUN_TEST(test_telemetry_histogram_interval_quantiles);
+    RUN_TEST(test_telemetry_json_metrics_and_display);
+
     return UNITY_END();
 }
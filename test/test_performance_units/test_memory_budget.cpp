@@ -0,0 +1,58 @@
+/**
+ * @file test_memory_budget.cpp
+ * @brief Unit tests for MemoryBudget (per-component reservation table)
+ *
+ * Tests validate:
+ * - Totals per region skip entries that are part of another
+ * - The stack total is the largest per-call buffer, not a sum
+ * - A full table counts dropped entries; JSON entry and totals format
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/MemoryBudget.h"
+#include "../../src/utils/MemoryBudget.cpp"
+
+/**
+ * @brief UT-048: Region totals, nested entries, table overflow and JSON
+ */
+void test_memory_budget_totals_and_json() {
+    static MemoryBudget budget;
+    TEST_ASSERT_TRUE(budget.add("logger", 6000, MemoryRegion::STATIC));
+    TEST_ASSERT_TRUE(budget.add("log_ring", 4352, MemoryRegion::STATIC, "logger"));  // Inside logger
+    TEST_ASSERT_TRUE(budget.add("boat_data", 2240, MemoryRegion::STATIC));
+    TEST_ASSERT_TRUE(budget.add("crash_log", 2100, MemoryRegion::RTC));
+    TEST_ASSERT_TRUE(budget.add("ws_pool", 26624, MemoryRegion::BOOT_HEAP));
+    TEST_ASSERT_TRUE(budget.add("log_line", 384, MemoryRegion::STACK));
+    TEST_ASSERT_TRUE(budget.add("status_json", 2048, MemoryRegion::STACK));
+
+    TEST_ASSERT_EQUAL_UINT32(8240, budget.getTotal(MemoryRegion::STATIC));
+    TEST_ASSERT_EQUAL_UINT32(2100, budget.getTotal(MemoryRegion::RTC));
+    TEST_ASSERT_EQUAL_UINT32(26624, budget.getTotal(MemoryRegion::BOOT_HEAP));
+    TEST_ASSERT_EQUAL_UINT32(2048, budget.getTotal(MemoryRegion::STACK));
+
+    StaticJsonWriter<128> entry;
+    budget.writeEntry(entry, 1);
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"log_ring\",\"bytes\":4352,\"region\":\"static\",\"part_of\":\"logger\"}",
+                             entry.c_str());
+    entry.reset();
+    budget.writeEntry(entry, 4);
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"ws_pool\",\"bytes\":26624,\"region\":\"boot_heap\"}", entry.c_str());
+
+    StaticJsonWriter<128> totals;
+    budget.writeTotals(totals);
+    TEST_ASSERT_EQUAL_STRING("{\"static\":8240,\"rtc\":2100,\"boot_heap\":26624,\"psram\":0,\"stack_peak\":2048}", totals.c_str());
+
+    // Table full: counted, shown in the totals
+    while (budget.getCount() < MEMORY_BUDGET_MAX_ENTRIES) {
+        budget.add("filler", 1, MemoryRegion::STACK);
+    }
+    TEST_ASSERT_FALSE(budget.add("extra", 100, MemoryRegion::STATIC));
+    TEST_ASSERT_EQUAL_UINT8(1, budget.getDropped());
+    TEST_ASSERT_EQUAL_UINT32(8240, budget.getTotal(MemoryRegion::STATIC));
+    totals.reset();
+    budget.writeTotals(totals, nullptr);
+    TEST_ASSERT_NOT_NULL(strstr(totals.c_str(), "\"dropped_entries\":1}"));
+}
@@ -0,0 +1,130 @@
+/**
+ * @file test_metric_registry.cpp
+ * @brief Unit tests for MetricRegistry and MetricWriter (Prometheus text format for GET /metrics)
+ *
+ * Tests validate:
+ * - Samples carry escaped labels and exact integer values, NaN and infinities are spelled
+ *   the Prometheus way, lines longer than the buffer are dropped; the table refuses
+ *   families beyond METRICS_MAX_FAMILIES
+ * - The writer emits # HELP and # TYPE per family and one line per sample, skips indexes
+ *   without a value, and produces the same document whatever the read size
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "../../src/utils/MetricRegistry.h"
+#include "../../src/utils/MetricRegistry.cpp"
+
+namespace {
+
+/// Sparse table: values at even indexes only (like free hash slots)
+const uint32_t TABLE[] = {10, 0, 30, 0, 4294967295UL};
+
+void sampleTable(MetricSample& sample, uint16_t index, const void* context) {
+    const uint32_t* table = static_cast<const uint32_t*>(context);
+    if (index % 2 == 0) {
+        sample.label("slot", (unsigned long)index).value(table[index]);
+    }
+}
+
+void sampleGauge(MetricSample& sample, uint16_t, const void*) {
+    sample.value(21.5);
+}
+
+size_t render(MetricWriter& writer, char* out, size_t capacity, size_t chunk) {
+    size_t total = 0;
+    size_t n;
+    while (total < capacity && (n = writer.read(out + total, chunk < capacity - total ? chunk : capacity - total)) > 0) {
+        total += n;
+    }
+    out[total < capacity ? total : capacity - 1] = '\0';
+    return total;
+}
+
+}  // namespace
+
+/**
+ * @brief UT-070: Sample formatting, label escaping, special values and table limits
+ */
+void test_metric_sample_format() {
+    char line[METRICS_LINE_BYTES];
+
+    MetricSample plain(line, sizeof(line), "poseidon2_up");
+    plain.value(4294967295.0);
+    TEST_ASSERT_EQUAL_STRING("poseidon2_up 4294967295\n", line);
+    TEST_ASSERT_EQUAL_UINT32(strlen(line), plain.length());
+
+    MetricSample labelled(line, sizeof(line), "poseidon2_x");
+    labelled.label("source", "GPS \"A\"\\1").label("pgn", 127250UL).value(0.25);
+    TEST_ASSERT_EQUAL_STRING("poseidon2_x{source=\"GPS \\\"A\\\"\\\\1\",pgn=\"127250\"} 0.25\n", line);
+
+    MetricSample nan(line, sizeof(line), "poseidon2_x");
+    nan.value(NAN);
+    TEST_ASSERT_EQUAL_STRING("poseidon2_x NaN\n", line);
+    MetricSample inf(line, sizeof(line), "poseidon2_x");
+    inf.value(-INFINITY);
+    TEST_ASSERT_EQUAL_STRING("poseidon2_x -Inf\n", line);
+
+    // No value: nothing to write; a line longer than the buffer is dropped
+    MetricSample empty(line, sizeof(line), "poseidon2_x");
+    empty.label("a", "b");
+    TEST_ASSERT_EQUAL_UINT32(0, empty.length());
+    char small[16];
+    MetricSample tooLong(small, sizeof(small), "poseidon2_too_long");
+    tooLong.value(1);
+    TEST_ASSERT_TRUE(tooLong.overflowed());
+    TEST_ASSERT_EQUAL_UINT32(0, tooLong.length());
+
+    MetricRegistry registry;
+    TEST_ASSERT_FALSE(registry.add("poseidon2_x", "x", MetricType::GAUGE, nullptr));
+    for (uint8_t i = 0; i < MetricRegistry::MAX_FAMILIES; i++) {
+        TEST_ASSERT_TRUE(registry.add("poseidon2_x", "x", MetricType::GAUGE, sampleGauge));
+    }
+    TEST_ASSERT_FALSE(registry.add("poseidon2_x", "x", MetricType::GAUGE, sampleGauge));
+    TEST_ASSERT_EQUAL_UINT8(MetricRegistry::MAX_FAMILIES, registry.getCount());
+    TEST_ASSERT_EQUAL_STRING("counter", MetricRegistry::typeName(MetricType::COUNTER));
+}
+
+/**
+ * @brief UT-071: The writer renders headers and samples, skips empty indexes, any read size
+ */
+void test_metric_writer_document() {
+    MetricRegistry registry;
+    registry.add("poseidon2_slots_total", "Per slot", MetricType::COUNTER, sampleTable, 5, TABLE);
+    registry.add("poseidon2_temp_c", "Temperature", MetricType::GAUGE, sampleGauge);
+
+    const char* expected =
+        "# HELP poseidon2_slots_total Per slot\n"
+        "# TYPE poseidon2_slots_total counter\n"
+        "poseidon2_slots_total{slot=\"0\"} 10\n"
+        "poseidon2_slots_total{slot=\"2\"} 30\n"
+        "poseidon2_slots_total{slot=\"4\"} 4294967295\n"
+        "# HELP poseidon2_temp_c Temperature\n"
+        "# TYPE poseidon2_temp_c gauge\n"
+        "poseidon2_temp_c 21.5\n";
+
+    MetricWriter writer;
+    char out[512];
+    writer.begin(registry);
+    TEST_ASSERT_EQUAL_UINT32(strlen(expected), render(writer, out, sizeof(out), sizeof(out)));
+    TEST_ASSERT_EQUAL_STRING(expected, out);
+    TEST_ASSERT_EQUAL_UINT32(4, writer.getSamples());
+    TEST_ASSERT_EQUAL_UINT32(0, writer.read(out, sizeof(out)));   // Complete
+
+    // Chunks smaller than a line give the same document
+    const size_t chunks[] = {1, 7, 33};
+    for (size_t chunk : chunks) {
+        writer.begin(registry);
+        render(writer, out, sizeof(out), chunk);
+        TEST_ASSERT_EQUAL_STRING(expected, out);
+    }
+
+    // Empty registry: empty document
+    MetricRegistry empty;
+    writer.begin(empty);
+    TEST_ASSERT_EQUAL_UINT32(0, writer.read(out, sizeof(out)));
+}
@@ -0,0 +1,154 @@
+/**
+ * @file test_ota_update.cpp
+ * @brief Unit tests for OtaSession (streaming firmware/filesystem updates)
+ *
+ * Tests validate:
+ * - An image split into small chunks reaches the updater unchanged; the MD5 is normalized and passed on
+ * - Wrong image type, oversize, bad MD5, hash mismatch and aborted uploads fail; the filesystem lock only
+ *   survives a failure once the old filesystem was overwritten
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/OtaUpdate.h"
+#include "../../src/utils/OtaUpdate.cpp"
+#include "../../src/mocks/MockFirmwareUpdater.h"
+
+namespace {
+
+void makeAppImage(uint8_t* image, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        image[i] = static_cast<uint8_t>(i * 7);
+    }
+    image[0] = OTA_APP_IMAGE_MAGIC;
+    image[1] = 5;  // Segments
+}
+
+void makeFilesystemImage(uint8_t* image, size_t length) {
+    memset(image, 0xFF, length);
+    memcpy(image + 8, "littlefs", 8);
+}
+
+}  // namespace
+
+/**
+ * @brief UT-060: Chunks smaller than the header stream through unchanged; installed once
+ */
+void test_ota_session_streams_image() {
+    MockFirmwareUpdater updater;
+    OtaSession session(&updater);
+    uint8_t image[200];
+    makeAppImage(image, sizeof(image));
+
+    TEST_ASSERT_TRUE(session.begin(OtaTarget::FIRMWARE, "0123456789ABCDEF0123456789abcdef", 1000));
+    TEST_ASSERT_EQUAL_STRING("0123456789abcdef0123456789abcdef", updater.getMd5());
+    TEST_ASSERT_FALSE(session.begin(OtaTarget::FIRMWARE, nullptr, 1000));  // Busy: the running upload stays
+    TEST_ASSERT_TRUE(session.isReceiving());
+
+    // 5-byte chunks: the header is held back until 16 bytes are in
+    for (size_t offset = 0; offset < sizeof(image); offset += 5) {
+        TEST_ASSERT_TRUE(session.write(image + offset, 5));
+        if (offset == 0) {
+            TEST_ASSERT_EQUAL_UINT32(0, updater.getLength());
+        }
+    }
+    TEST_ASSERT_TRUE(session.finish(3500));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(image), updater.getLength());
+    TEST_ASSERT_EQUAL_INT(0, memcmp(image, updater.getImage(), sizeof(image)));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OtaState::INSTALLED), static_cast<uint8_t>(session.getState()));
+    TEST_ASSERT_EQUAL_UINT32(2500, session.getDurationMs());
+    TEST_ASSERT_EQUAL_UINT32(1, session.getInstalled());
+    TEST_ASSERT_TRUE(session.requiresReboot());
+    TEST_ASSERT_FALSE(OtaFilesystemLocked());
+
+    // Filesystem image: locked from begin() to the reboot
+    OtaSession fsSession(&updater);
+    makeFilesystemImage(image, sizeof(image));
+    TEST_ASSERT_TRUE(fsSession.begin(OtaTarget::FILESYSTEM, nullptr, 0));
+    TEST_ASSERT_TRUE(OtaFilesystemLocked());
+    TEST_ASSERT_EQUAL_STRING("", updater.getMd5());
+    TEST_ASSERT_TRUE(fsSession.write(image, sizeof(image)));
+    TEST_ASSERT_TRUE(fsSession.finish(10));
+    TEST_ASSERT_TRUE(OtaFilesystemLocked());
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OtaTarget::FILESYSTEM), static_cast<uint8_t>(updater.getTarget()));
+
+    StaticJsonWriter<256> json;
+    fsSession.writeJson(json);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"state\":\"installed\",\"target\":\"filesystem\",\"bytes\":200,\"capacity\":256,"
+        "\"duration_ms\":10,\"error\":null,\"installed\":1,\"failed\":0}",
+        json.c_str());
+
+    OtaTarget target = OtaTarget::FIRMWARE;
+    TEST_ASSERT_TRUE(OtaTargetFromName("filesystem", target));
+    TEST_ASSERT_FALSE(OtaTargetFromName("spiffs", target));
+    TEST_ASSERT_FALSE(OtaTargetFromName(nullptr, target));
+}
+
+/**
+ * @brief UT-061: Refused images leave the partition unused; a half-written filesystem keeps the lock
+ */
+void test_ota_session_rejects_bad_uploads() {
+    uint8_t image[200];
+
+    // Filesystem image uploaded as firmware: refused before any byte is written
+    MockFirmwareUpdater updater;
+    OtaSession session(&updater);
+    makeFilesystemImage(image, sizeof(image));
+    session.begin(OtaTarget::FIRMWARE, nullptr, 0);
+    TEST_ASSERT_FALSE(session.write(image, sizeof(image)));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OtaError::BAD_IMAGE), static_cast<uint8_t>(session.getError()));
+    TEST_ASSERT_EQUAL_UINT32(0, updater.getLength());
+    TEST_ASSERT_EQUAL_UINT32(1, updater.getAborted());
+    TEST_ASSERT_FALSE(session.write(image, 10));  // Later chunks ignored
+    TEST_ASSERT_FALSE(session.finish(0));
+    TEST_ASSERT_FALSE(session.requiresReboot());
+
+    // Bad MD5 parameter, empty upload
+    TEST_ASSERT_FALSE(session.begin(OtaTarget::FIRMWARE, "xyz", 0));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OtaError::BAD_MD5), static_cast<uint8_t>(session.getError()));
+    TEST_ASSERT_TRUE(session.begin(OtaTarget::FIRMWARE, nullptr, 0));
+    TEST_ASSERT_FALSE(session.finish(0));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OtaError::BAD_IMAGE), static_cast<uint8_t>(session.getError()));
+
+    // Larger than the partition
+    makeAppImage(image, sizeof(image));
+    updater.setCapacity(150);
+    session.begin(OtaTarget::FIRMWARE, nullptr, 0);
+    TEST_ASSERT_TRUE(session.write(image, 100));
+    TEST_ASSERT_FALSE(session.write(image + 100, 100));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(OtaError::TOO_LARGE), static_cast<uint8_t>(session.getError()));
+
+    // Hash mismatch at the end: reported, firmware keeps running without a reboot
+    updater.setCapacity(MockFirmwareUpdater::MAX_IMAGE);
+    updater.setEndResult(OtaError::HASH_MISMATCH);
+    session.begin(OtaTarget::FIRMWARE, "00000000000000000000000000000000", 0);
+    session.write(image, sizeof(image));
+    TEST_ASSERT_FALSE(session.finish(0));
+    TEST_ASSERT_EQUAL_STRING("hash_mismatch", OtaErrorName(session.getError()));
+    TEST_ASSERT_FALSE(session.requiresReboot());
+    TEST_ASSERT_EQUAL_UINT32(5, session.getFailed());
+
+    // Filesystem upload aborted before its header: lock released
+    updater.setEndResult(OtaError::NONE);
+    makeFilesystemImage(image, sizeof(image));
+    OtaSession fsSession(&updater);
+    fsSession.begin(OtaTarget::FILESYSTEM, nullptr, 0);
+    fsSession.write(image, 10);
+    fsSession.abort();
+    TEST_ASSERT_EQUAL_STRING("aborted", OtaErrorName(fsSession.getError()));
+    TEST_ASSERT_FALSE(OtaFilesystemLocked());
+    TEST_ASSERT_FALSE(fsSession.requiresReboot());
+
+    // Write error halfway through: the old filesystem is gone, stay locked and restart
+    updater.setFailWriteAt(120);
+    fsSession.begin(OtaTarget::FILESYSTEM, nullptr, 0);
+    TEST_ASSERT_TRUE(fsSession.write(image, 100));
+    TEST_ASSERT_FALSE(fsSession.write(image + 100, 100));
+    TEST_ASSERT_EQUAL_STRING("write_failed", OtaErrorName(fsSession.getError()));
+    TEST_ASSERT_TRUE(OtaFilesystemLocked());
+    TEST_ASSERT_TRUE(fsSession.requiresReboot());
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_reaction_profiler.cpp
+ * @brief Unit tests for ReactionProfiler (per-reaction execution time and lateness)
+ *
+ * Tests validate:
+ * - Registration and the full table
+ * - Execution cycles (total, max, last) from the injected cycle counter
+ * - Lateness of each start against the registered interval
+ * - Ordering, CPU share, JSON entry and reset
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/JsonWriter.h"
+#include "../../src/utils/JsonWriter.cpp"
+#include "../../src/utils/ReactionProfiler.h"
+#include "../../src/utils/ReactionProfiler.cpp"
+
+static uint32_t _mockCycles = 0;
+
+static uint32_t mockCycleCount() {
+    return _mockCycles;
+}
+
+/// One invocation of @p id starting at @p nowMs and taking @p cycles
+static void invoke(ReactionProfiler& profiler, int8_t id, uint32_t nowMs, uint32_t cycles) {
+    uint32_t start = profiler.begin(id, nowMs);
+    _mockCycles += cycles;
+    profiler.end(id, start);
+}
+
+/**
+ * @brief UT-015: Registration returns IDs until the table is full
+ */
+void test_reaction_profiler_registration() {
+    ReactionProfiler profiler(mockCycleCount);
+    TEST_ASSERT_EQUAL_INT8(0, profiler.add("first", 10));
+    for (uint8_t i = 1; i < REACTION_PROFILER_MAX_REACTIONS; i++) {
+        TEST_ASSERT_EQUAL_INT8(i, profiler.add("more", 100));
+    }
+    TEST_ASSERT_EQUAL_INT8(-1, profiler.add("overflow", 100));
+    TEST_ASSERT_EQUAL_UINT8(REACTION_PROFILER_MAX_REACTIONS, profiler.count());
+    TEST_ASSERT_EQUAL_STRING("first", profiler.at(0)->name);
+    TEST_ASSERT_NULL(profiler.at(REACTION_PROFILER_MAX_REACTIONS));
+
+    // Unregistered IDs are timed but not recorded
+    invoke(profiler, -1, 0, 100);
+    TEST_ASSERT_EQUAL_UINT32(0, profiler.at(0)->calls);
+}
+
+/**
+ * @brief UT-016: Cycles and lateness per invocation, counter wrap-around included
+ */
+void test_reaction_profiler_timing_and_lateness() {
+    ReactionProfiler profiler(mockCycleCount);
+    int8_t id = profiler.add("tick", 100);
+
+    _mockCycles = 0xFFFFFF00u;  // Wraps during the first invocation
+    invoke(profiler, id, 1000, 0x200);
+    invoke(profiler, id, 1100, 50);    // On time
+    invoke(profiler, id, 1230, 300);   // 30 ms late
+    invoke(profiler, id, 1320, 10);    // Early: not negative lateness
+
+    const ReactionStats* stats = profiler.at(id);
+    TEST_ASSERT_EQUAL_UINT32(4, stats->calls);
+    TEST_ASSERT_EQUAL_UINT32(0x200 + 50 + 300 + 10, (uint32_t)stats->totalCycles);
+    TEST_ASSERT_EQUAL_UINT32(0x200, stats->maxCycles);
+    TEST_ASSERT_EQUAL_UINT32(10, stats->lastCycles);
+    TEST_ASSERT_EQUAL_UINT32(30, stats->maxLateMs);
+    TEST_ASSERT_EQUAL_UINT32(30, stats->totalLateMs);
+}
+
+/**
+ * @brief UT-017: top() orders by total cycles and truncates; JSON entry, CPU share and reset
+ */
+void test_reaction_profiler_report() {
+    ReactionProfiler profiler(mockCycleCount);
+    int8_t cheap = profiler.add("cheap", 10);
+    int8_t costly = profiler.add("costly", 1000);
+    int8_t middle = profiler.add("middle", 100);
+    profiler.reset(0);
+
+    invoke(profiler, cheap, 10, 240);
+    invoke(profiler, costly, 20, 24000);
+    invoke(profiler, middle, 30, 2400);
+    invoke(profiler, middle, 130, 2400);
+
+    uint8_t order[REACTION_PROFILER_MAX_REACTIONS];
+    TEST_ASSERT_EQUAL_UINT8(3, profiler.top(order, REACTION_PROFILER_MAX_REACTIONS));
+    TEST_ASSERT_EQUAL_UINT8(costly, order[0]);
+    TEST_ASSERT_EQUAL_UINT8(middle, order[1]);
+    TEST_ASSERT_EQUAL_UINT8(cheap, order[2]);
+    TEST_ASSERT_EQUAL_UINT8(2, profiler.top(order, 2));
+    TEST_ASSERT_EQUAL_UINT8(costly, order[0]);
+    TEST_ASSERT_EQUAL_UINT8(middle, order[1]);
+
+    // 29040 cycles at 240 MHz = 121 us of a 1000 ms window
+    TEST_ASSERT_FLOAT_WITHIN(0.0001, 0.0121, profiler.busyPercent(240, 1000));
+
+    StaticJsonWriter<256> json;
+    TEST_ASSERT_TRUE(profiler.writeEntry(json, middle, 240, 1000));
+    TEST_ASSERT_EQUAL_STRING("{\"name\":\"middle\",\"interval_ms\":100,\"calls\":2,\"total_us\":20,"
+                             "\"avg_us\":10,\"max_us\":10,\"last_us\":10,\"cpu_pct\":0.00,"
+                             "\"late_avg_ms\":0,\"late_max_ms\":0}", json.c_str());
+    TEST_ASSERT_FALSE(profiler.writeEntry(json, 3, 240, 1000));
+
+    // Deferred reset: applied at the next begin(), registrations kept
+    profiler.requestReset();
+    TEST_ASSERT_EQUAL_UINT32(2, profiler.at(middle)->calls);
+    invoke(profiler, cheap, 5000, 24);
+    TEST_ASSERT_EQUAL_UINT32(5000, profiler.getWindowStartMs());
+    TEST_ASSERT_EQUAL_UINT32(0, profiler.at(middle)->calls);
+    TEST_ASSERT_EQUAL_UINT32(1, profiler.at(cheap)->calls);
+    TEST_ASSERT_EQUAL_UINT32(0, profiler.at(cheap)->maxLateMs);
+    TEST_ASSERT_EQUAL_STRING("costly", profiler.at(costly)->name);
+}
@@ -0,0 +1,169 @@
+/**
+ * @file test_reaction_scheduler.cpp
+ * @brief Unit tests for ReactionScheduler (priority classes, budgets, background deferral)
+ *
+ * Tests validate:
+ * - Higher classes run first, and are looked at again after every reaction
+ * - A class over its budget waits for the next pass; each class runs at least once per pass
+ * - Background work yields to pending input until SCHED_BACKGROUND_MAX_DEFER_MS late
+ * - Due times: first run one interval after add(), no catch-up bursts
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/ReactionScheduler.h"
+#include "../../src/utils/ReactionScheduler.cpp"
+
+static uint32_t _schedUs = 0;
+static char _schedTrace[64];
+
+static uint32_t schedMicros() {
+    return _schedUs;
+}
+
+/// Reaction that appends @p tag to the trace and takes @p us
+static std::function<void()> traced(char tag, uint32_t us) {
+    return [tag, us]() {
+        _schedUs += us;
+        size_t len = strlen(_schedTrace);
+        _schedTrace[len] = tag;
+        _schedTrace[len + 1] = '\0';
+    };
+}
+
+static bool _inputPending = false;
+
+static bool pendingProbe(void*) {
+    return _inputPending;
+}
+
+/**
+ * @brief UT-032: Class order regardless of registration order; realtime again after a slow UI reaction
+ */
+void test_reaction_scheduler_priority() {
+    _schedUs = 0;
+    _schedTrace[0] = '\0';
+    ReactionScheduler scheduler(schedMicros);
+    scheduler.add(ReactionClass::BACKGROUND, "stats", 100, traced('b', 10), 0);
+    scheduler.add(ReactionClass::UI_NETWORK, "oled", 100, traced('u', 40000), 0);
+    scheduler.add(ReactionClass::UI_NETWORK, "ws", 100, traced('w', 10), 0);
+    scheduler.add(ReactionClass::REALTIME_IO, "pump", 5, traced('r', 100), 0);
+    scheduler.add(ReactionClass::CALCULATION, "calc", 100, traced('c', 500), 0);
+
+    TEST_ASSERT_EQUAL_UINT8(0, scheduler.run(4));  // Nothing due before its first interval
+    TEST_ASSERT_EQUAL_UINT8(1, scheduler.run(5));
+    TEST_ASSERT_EQUAL_STRING("r", _schedTrace);
+
+    // The slow UI push uses up the UI budget: "ws" waits for the next pass and background yields to it
+    _schedTrace[0] = '\0';
+    TEST_ASSERT_EQUAL_UINT8(3, scheduler.run(100));
+    TEST_ASSERT_EQUAL_STRING("rcu", _schedTrace);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getStats(ReactionClass::UI_NETWORK).budgetHits);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getStats(ReactionClass::BACKGROUND).deferred);
+
+    // Next pass: realtime first again, then the waiting UI and background work
+    _schedTrace[0] = '\0';
+    scheduler.run(105);
+    TEST_ASSERT_EQUAL_STRING("rwb", _schedTrace);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getStats(ReactionClass::UI_NETWORK).runs);
+    TEST_ASSERT_EQUAL_UINT32(5, scheduler.getStats(ReactionClass::UI_NETWORK).maxLateMs);
+}
+
+/**
+ * @brief UT-033: Background work defers to pending input, but not forever
+ */
+void test_reaction_scheduler_background_deferral() {
+    _schedUs = 0;
+    _schedTrace[0] = '\0';
+    _inputPending = true;
+    ReactionScheduler scheduler(schedMicros);
+    scheduler.setPendingInputProbe(pendingProbe, nullptr);
+    scheduler.add(ReactionClass::BACKGROUND, "stats", 1000, traced('b', 10), 0);
+    scheduler.add(ReactionClass::UI_NETWORK, "ws", 1000, traced('w', 10), 0);
+
+    scheduler.run(1000);
+    TEST_ASSERT_EQUAL_STRING("w", _schedTrace);
+    TEST_ASSERT_EQUAL_UINT32(1, scheduler.getStats(ReactionClass::BACKGROUND).deferred);
+
+    scheduler.run(1000 + SCHED_BACKGROUND_MAX_DEFER_MS - 1);
+    TEST_ASSERT_EQUAL_STRING("ww", _schedTrace);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getStats(ReactionClass::BACKGROUND).deferred);
+
+    scheduler.run(1000 + SCHED_BACKGROUND_MAX_DEFER_MS);  // Too late to wait any longer
+    TEST_ASSERT_EQUAL_STRING("wwwb", _schedTrace);
+    TEST_ASSERT_EQUAL_UINT32(SCHED_BACKGROUND_MAX_DEFER_MS, scheduler.getStats(ReactionClass::BACKGROUND).maxLateMs);
+    // More than one interval behind: next run one interval from now, no catch-up burst
+    TEST_ASSERT_EQUAL_UINT32(1000 + SCHED_BACKGROUND_MAX_DEFER_MS + 1000, scheduler.at(0)->dueMs);
+
+    // Without pending input it runs on time
+    _inputPending = false;
+    _schedTrace[0] = '\0';
+    scheduler.run(2000 + SCHED_BACKGROUND_MAX_DEFER_MS);
+    TEST_ASSERT_EQUAL_STRING("wb", _schedTrace);
+}
+
+/**
+ * @brief UT-034: Realtime budget caps a pass; each reaction once per pass; stats JSON
+ */
+void test_reaction_scheduler_budget_and_stats() {
+    _schedUs = 0;
+    _schedTrace[0] = '\0';
+    ReactionScheduler scheduler(schedMicros);
+    scheduler.setBudget(ReactionClass::REALTIME_IO, 1000);
+    scheduler.add(ReactionClass::REALTIME_IO, "a", 0, traced('a', 600), 0);
+    scheduler.add(ReactionClass::REALTIME_IO, "b", 0, traced('b', 600), 0);
+    scheduler.add(ReactionClass::REALTIME_IO, "c", 0, traced('c', 600), 0);
+    TEST_ASSERT_EQUAL_INT8(-1, scheduler.add(ReactionClass::COUNT, "bad", 0, traced('x', 0), 0));
+
+    scheduler.run(0);
+    TEST_ASSERT_EQUAL_STRING("ab", _schedTrace);     // 1200 us >= 1000 us budget: "c" waits
+    scheduler.run(1);
+    TEST_ASSERT_EQUAL_STRING("abca", _schedTrace);   // The one left over goes first
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.getStats(ReactionClass::REALTIME_IO).budgetHits);
+
+    StaticJsonWriter<1024> json;
+    TEST_ASSERT_TRUE(scheduler.writeStats(json));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"passes\":2,\"classes\":[{\"class\":\"realtime\",\"reactions\":3,"
+                                              "\"budget_us\":1000,\"runs\":4,\"busy_us\":2400"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"class\":\"background\",\"reactions\":0"));
+
+    scheduler.clearStats();
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.getStats(ReactionClass::REALTIME_IO).runs);
+}
+
+/**
+ * @brief UT-038: A reaction over its class budget SCHED_OVER_BUDGET_FLAG_RUNS times in a row is flagged
+ */
+void test_reaction_scheduler_over_budget_flag() {
+    _schedUs = 0;
+    _schedTrace[0] = '\0';
+    ReactionScheduler scheduler(schedMicros);
+    uint32_t oledUs = 12000;  // UI budget is SCHED_BUDGET_UI_US
+    scheduler.add(ReactionClass::UI_NETWORK, "oled_page", 0, [&oledUs]() { _schedUs += oledUs; }, 0);
+    scheduler.add(ReactionClass::UI_NETWORK, "ws", 0, traced('w', 10), 0);
+
+    for (uint32_t pass = 0; pass < SCHED_OVER_BUDGET_FLAG_RUNS - 1; pass++) {
+        scheduler.run(pass);
+    }
+    oledUs = 100;  // One run within budget resets the streak
+    scheduler.run(10);
+    oledUs = 12000;
+    for (uint32_t pass = 0; pass < SCHED_OVER_BUDGET_FLAG_RUNS - 1; pass++) {
+        scheduler.run(20 + pass);
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, scheduler.getFlaggedCount());
+
+    scheduler.run(30);
+    TEST_ASSERT_EQUAL_UINT8(1, scheduler.getFlaggedCount());
+    StaticJsonWriter<1024> json;
+    TEST_ASSERT_TRUE(scheduler.writeStats(json));
+    char expected[96];
+    snprintf(expected, sizeof(expected), "\"flagged\":[{\"name\":\"oled_page\",\"class\":\"ui\",\"over_budget\":%u,"
+             "\"max_us\":12000}]}", (unsigned)(2 * SCHED_OVER_BUDGET_FLAG_RUNS - 1));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), expected));
+
+    scheduler.clearStats();
+    TEST_ASSERT_EQUAL_UINT8(0, scheduler.getFlaggedCount());
+}
@@ -0,0 +1,98 @@
+/**
+ * @file test_scratch_arena.cpp
+ * @brief Unit tests for ScratchArena (per-reaction bump-pointer allocation)
+ *
+ * Tests validate:
+ * - Aligned allocation, exhaustion counted without touching the arena
+ * - Scopes rewind nested allocations; reset() frees everything; high-water survives both
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/ScratchArena.h"
+#include "../../src/utils/ScratchArena.cpp"
+
+/**
+ * @brief UT-050: Allocations are aligned; one that does not fit fails and is counted
+ */
+void test_scratch_arena_alignment_and_overflow() {
+    alignas(8) static uint8_t storage[64];
+    ScratchArena arena(storage, sizeof(storage));
+
+    TEST_ASSERT_EQUAL_UINT32(64, arena.getCapacity());
+    char* text = arena.allocArray<char>(3);
+    TEST_ASSERT_EQUAL_PTR(storage, text);
+    TEST_ASSERT_EQUAL_UINT32(3, arena.getUsed());
+
+    // Next 8-byte value starts on the next 8-byte boundary
+    uint64_t* value = arena.make<uint64_t>();
+    TEST_ASSERT_NOT_NULL(value);
+    TEST_ASSERT_EQUAL_UINT32(0, reinterpret_cast<uintptr_t>(value) % 8);
+    TEST_ASSERT_EQUAL_UINT32(16, arena.getUsed());
+
+    // Does not fit: nullptr, counted, nothing consumed
+    TEST_ASSERT_NULL(arena.allocArray<uint8_t>(49));
+    TEST_ASSERT_EQUAL_UINT32(1, arena.getOverflows());
+    TEST_ASSERT_EQUAL_UINT32(49, arena.getLastOverflowBytes());
+    TEST_ASSERT_EQUAL_UINT32(16, arena.getUsed());
+
+    // Exactly the rest still fits
+    TEST_ASSERT_NOT_NULL(arena.allocArray<uint8_t>(48));
+    TEST_ASSERT_EQUAL_UINT32(64, arena.getUsed());
+    TEST_ASSERT_NULL(arena.allocate(1, 1));
+    TEST_ASSERT_EQUAL_UINT32(2, arena.getOverflows());
+
+    // No buffer: every allocation overflows
+    ScratchArena empty(nullptr, 128);
+    TEST_ASSERT_EQUAL_UINT32(0, empty.getCapacity());
+    TEST_ASSERT_NULL(empty.allocate(1));
+    TEST_ASSERT_EQUAL_UINT32(1, empty.getOverflows());
+}
+
+/**
+ * @brief UT-051: Scopes rewind, reset() frees all, high-water and JSON report the peak
+ */
+void test_scratch_arena_scope_and_high_water() {
+    alignas(8) static uint8_t storage[256];
+    ScratchArena arena(storage, sizeof(storage));
+
+    {
+        ScratchScope outer(arena);
+        TEST_ASSERT_NOT_NULL(outer.arena().allocArray<char>(32));
+        {
+            ScratchScope inner(arena);
+            TEST_ASSERT_NOT_NULL(inner.arena().allocArray<char>(100));
+            TEST_ASSERT_EQUAL_UINT32(132, arena.getUsed());
+        }
+        TEST_ASSERT_EQUAL_UINT32(32, arena.getUsed());  // Inner scope released, outer kept
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, arena.getUsed());
+    TEST_ASSERT_EQUAL_UINT32(132, arena.getHighWater());
+
+    // Unscoped allocations last until reset() (end of the reaction)
+    arena.allocArray<char>(40);
+    arena.allocArray<char>(40);
+    TEST_ASSERT_EQUAL_UINT32(80, arena.getUsed());
+    arena.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, arena.getUsed());
+    TEST_ASSERT_EQUAL_PTR(storage, arena.allocArray<char>(1));  // Reused from the start
+    arena.reset();
+
+    // A mark beyond the current offset cannot grow the arena
+    arena.rewind(200);
+    TEST_ASSERT_EQUAL_UINT32(0, arena.getUsed());
+
+    arena.allocate(300);
+    StaticJsonWriter<160> json;
+    arena.writeJson(json);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"capacity\":256,\"used\":0,\"high_water\":132,\"overflows\":1,\"last_overflow_bytes\":300}",
+        json.c_str());
+
+    arena.clearStats();
+    TEST_ASSERT_EQUAL_UINT32(0, arena.getHighWater());
+    TEST_ASSERT_EQUAL_UINT32(0, arena.getOverflows());
+}
@@ -0,0 +1,161 @@
+/**
+ * @file test_soak_monitor.cpp
+ * @brief Unit tests for SoakMonitor (soak CSV rows and trend flags)
+ *
+ * Tests validate:
+ * - A slow heap leak under noise is flagged once the window is full, a noisy
+ *   flat line and a drift below the column minimum are not, and the flag
+ *   clears once the trend stops
+ * - Drop counters are flagged when drops keep happening, not for one burst
+ * - CSV header and rows, and the JSON report
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/SoakMonitor.h"
+#include "../../src/utils/SoakMonitor.cpp"
+
+namespace {
+
+const uint8_t WINDOW = SoakMonitor::WINDOW;
+
+/// Deterministic noise in [-amplitude, amplitude]
+int32_t noise(uint32_t i, int32_t amplitude) {
+    uint32_t x = i * 2654435761u;
+    return static_cast<int32_t>((x >> 16) % (2 * amplitude + 1)) - amplitude;
+}
+
+SoakSample sampleAt(uint32_t minute) {
+    SoakSample sample;
+    memset(&sample, 0, sizeof(sample));
+    sample.uptimeS = minute * 60;
+    sample.set(SoakColumn::HEAP_FREE, 150000);
+    sample.set(SoakColumn::HEAP_LARGEST, 90000);
+    sample.set(SoakColumn::HEAP_MIN, 120000);
+    sample.set(SoakColumn::LOOP_P50_US, 40);
+    sample.set(SoakColumn::LOOP_P99_US, 900);
+    sample.set(SoakColumn::LOOP_MAX_US, 4000);
+    return sample;
+}
+
+}  // namespace
+
+/**
+ * @brief UT-079: A leak under noise is flagged, noise and small drift are not; flags clear
+ */
+void test_soak_monitor_flags_heap_leak() {
+    SoakMonitor monitor;
+    uint16_t raised = 0;
+
+    // 200 bytes per minute lost under +-600 bytes of noise: 6 KB over the window
+    for (uint32_t m = 0; m < WINDOW; m++) {
+        SoakSample sample = sampleAt(m);
+        sample.set(SoakColumn::HEAP_FREE, 150000 - 200 * m + noise(m, 600));
+        sample.set(SoakColumn::HEAP_LARGEST, 90000 + noise(m + 7, 3000));   // Noise only
+        sample.set(SoakColumn::HEAP_MIN, 120000 - 20 * m);                 // Monotonic, 580 B: too small
+        raised |= monitor.add(sample);
+        if (m + 1 < WINDOW) {
+            TEST_ASSERT_EQUAL_UINT16(0, raised);  // Window not full yet
+        }
+    }
+
+    uint16_t heapFree = 1u << static_cast<uint8_t>(SoakColumn::HEAP_FREE);
+    TEST_ASSERT_EQUAL_UINT16(heapFree, raised);
+    TEST_ASSERT_TRUE(monitor.isFlagged(SoakColumn::HEAP_FREE));
+    TEST_ASSERT_TRUE(monitor.getTauPct(SoakColumn::HEAP_FREE) <= -SOAK_TREND_FLAG_PCT);
+    TEST_ASSERT_TRUE(monitor.getChange(SoakColumn::HEAP_FREE) < -2048);
+    TEST_ASSERT_FALSE(monitor.isFlagged(SoakColumn::HEAP_LARGEST));
+    TEST_ASSERT_TRUE(monitor.getTauPct(SoakColumn::HEAP_LARGEST) > -SOAK_TREND_FLAG_PCT);
+    TEST_ASSERT_FALSE(monitor.isFlagged(SoakColumn::HEAP_MIN));
+    TEST_ASSERT_EQUAL_INT8(-100, monitor.getTauPct(SoakColumn::HEAP_MIN));
+    TEST_ASSERT_FALSE(monitor.isFlagged(SoakColumn::LOOP_P99_US));  // Constant: all ties
+    TEST_ASSERT_EQUAL_INT8(0, monitor.getTauPct(SoakColumn::LOOP_P99_US));
+
+    // Still leaking: flagged once, not again
+    SoakSample next = sampleAt(WINDOW);
+    next.set(SoakColumn::HEAP_FREE, 150000 - 200 * WINDOW);
+    TEST_ASSERT_EQUAL_UINT16(0, monitor.add(next));
+    TEST_ASSERT_TRUE(monitor.isFlagged(SoakColumn::HEAP_FREE));
+
+    // The leak stops: once the window is mostly flat the flag clears
+    uint32_t level = 150000 - 200 * WINDOW;
+    for (uint32_t m = WINDOW + 1; m < 3 * WINDOW; m++) {
+        SoakSample sample = sampleAt(m);
+        sample.set(SoakColumn::HEAP_FREE, level + noise(m, 600));
+        monitor.add(sample);
+    }
+    TEST_ASSERT_FALSE(monitor.isFlagged(SoakColumn::HEAP_FREE));
+    TEST_ASSERT_EQUAL_UINT32(3 * WINDOW, monitor.getSamples());
+    TEST_ASSERT_EQUAL_UINT32((3 * WINDOW - 1) * 60, monitor.last()->uptimeS);
+}
+
+/**
+ * @brief UT-080: Drops that keep happening are flagged; one burst and rising latency too
+ */
+void test_soak_monitor_counters_and_latency() {
+    SoakMonitor monitor;
+    uint32_t wsDropped = 0;
+
+    for (uint32_t m = 0; m < WINDOW; m++) {
+        SoakSample sample = sampleAt(m);
+        if (m == WINDOW / 2) {
+            wsDropped += 40;  // One burst
+        }
+        sample.set(SoakColumn::WS_DROPPED, wsDropped);
+        sample.set(SoakColumn::CAN_DROPPED, m * 3);                          // Every minute
+        sample.set(SoakColumn::LOOP_P99_US, 900 + 15 * m + noise(m, 60));    // Rising, ~435 us
+        monitor.add(sample);
+    }
+
+    TEST_ASSERT_TRUE(monitor.isFlagged(SoakColumn::CAN_DROPPED));
+    TEST_ASSERT_EQUAL_INT8(100, monitor.getTauPct(SoakColumn::CAN_DROPPED));
+    TEST_ASSERT_FALSE(monitor.isFlagged(SoakColumn::WS_DROPPED));
+    TEST_ASSERT_EQUAL_INT64(40, monitor.getChange(SoakColumn::WS_DROPPED));
+    TEST_ASSERT_TRUE(monitor.isFlagged(SoakColumn::LOOP_P99_US));
+    TEST_ASSERT_FALSE(monitor.isFlagged(SoakColumn::LOG_DROPPED));
+
+    // Rising is bad for counters and latency, falling for the heap
+    TEST_ASSERT_EQUAL_INT8(1, SoakMonitor::badDirection(SoakColumn::CAN_DROPPED));
+    TEST_ASSERT_EQUAL_INT8(-1, SoakMonitor::badDirection(SoakColumn::HEAP_LARGEST));
+
+    monitor.reset();
+    TEST_ASSERT_EQUAL_UINT16(0, monitor.getFlagged());
+    TEST_ASSERT_NULL(monitor.last());
+}
+
+/**
+ * @brief UT-081: CSV header, rows and the JSON report
+ */
+void test_soak_monitor_csv_and_json() {
+    char line[256];
+    size_t len = SoakMonitor::writeCsvHeader(line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING(
+        "uptime_s,heap_free,heap_largest,heap_min,loop_p50_us,loop_p99_us,loop_max_us,"
+        "can_dropped,uart_dropped,ws_dropped,log_dropped,heap_failed\n", line);
+    TEST_ASSERT_EQUAL(strlen(line), len);
+
+    SoakSample sample = sampleAt(1440);
+    sample.set(SoakColumn::LOG_DROPPED, 7);
+    len = SoakMonitor::writeCsvRow(sample, line, sizeof(line));
+    TEST_ASSERT_EQUAL_STRING("86400,150000,90000,120000,40,900,4000,0,0,0,7,0\n", line);
+    TEST_ASSERT_EQUAL(strlen(line), len);
+    TEST_ASSERT_EQUAL(0, SoakMonitor::writeCsvRow(sample, line, 20));  // Too small: nothing
+
+    SoakMonitor monitor;
+    for (uint32_t m = 0; m < WINDOW; m++) {
+        SoakSample s = sampleAt(m);
+        s.set(SoakColumn::HEAP_FAILED, m);
+        monitor.add(s);
+    }
+    StaticJsonWriter<2048> json;
+    monitor.writeJson(json);
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"flagged\":[\"heap_failed\"]"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(),
+        "{\"name\":\"heap_failed\",\"last\":29,\"change\":29,\"tau\":1.00,\"trend\":true}"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(),
+        "{\"name\":\"heap_free\",\"last\":150000,\"change\":0,\"tau\":0.00,\"trend\":false}"));
+}
@@ -0,0 +1,119 @@
+/**
+ * @file test_stall_watchdog.cpp
+ * @brief Unit tests for StallWatchdog (stall detection, reset decision, reset-surviving record)
+ *
+ * Tests validate:
+ * - A work item is reported once, after its slot's timeout; finished items never
+ * - The reset is due only while the recorded work item is still running
+ * - The record survives a "reboot" (same storage), garbage is discarded
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/StallWatchdog.h"
+#include "../../src/utils/StallWatchdog.cpp"
+
+/**
+ * @brief UT-035: Stall reported once per work item; reset only for the recorded one
+ */
+void test_stall_watchdog_detection() {
+    static StallRecord storage;
+    memset(&storage, 0, sizeof(storage));
+    static StallWatchdog watchdog(storage);
+
+    int8_t loop = watchdog.addSlot("loop", 2000);
+    int8_t task = watchdog.addSlot("onewire", 5000);
+    TEST_ASSERT_EQUAL_INT8(0, loop);
+    TEST_ASSERT_EQUAL_INT8(1, task);
+    watchdog.setTask(static_cast<uint8_t>(loop), nullptr, 1);
+
+    // Finished in time: never reported
+    watchdog.enter(loop, "bd_stream", 1000);
+    watchdog.exit(loop);
+    TEST_ASSERT_EQUAL_INT8(-1, watchdog.check(10000));
+
+    watchdog.enter(loop, "history", 10000);
+    watchdog.enter(task, "1w_batt", 10000);
+    TEST_ASSERT_EQUAL_INT8(-1, watchdog.check(11999));
+    TEST_ASSERT_EQUAL_INT8(loop, watchdog.check(12000));
+    TEST_ASSERT_EQUAL_INT8(-1, watchdog.check(12250));   // Same work item: once
+    TEST_ASSERT_EQUAL_UINT32(1, watchdog.getStalls(loop));
+
+    const uint32_t pcs[] = {0x400d1e2a, 0x400d2b10};
+    watchdog.recordStall(static_cast<uint8_t>(loop), 12000, 4, pcs, 2);
+    TEST_ASSERT_FALSE(watchdog.resetDue(10000 + STALL_RESET_MS - 1));
+    TEST_ASSERT_TRUE(watchdog.resetDue(10000 + STALL_RESET_MS));
+
+    // The reaction returned (and a new one started): no reset for the recorded stall
+    watchdog.exit(loop);
+    watchdog.enter(loop, "bd_stream", 20000);
+    TEST_ASSERT_FALSE(watchdog.resetDue(10000 + STALL_RESET_MS));
+
+    // The task has its own timeout
+    TEST_ASSERT_EQUAL_INT8(task, watchdog.check(15000));
+    TEST_ASSERT_EQUAL_STRING("onewire", watchdog.getSlotName(task));
+
+    // Table full
+    watchdog.addSlot("n2k_rx", 5000);
+    watchdog.addSlot("spare", 5000);
+    TEST_ASSERT_EQUAL_INT8(-1, watchdog.addSlot("extra", 5000));
+}
+
+/**
+ * @brief UT-036: The record survives a reset; corrupted or power-on storage is ignored
+ */
+void test_stall_watchdog_record_survives_reset() {
+    static StallRecord storage;
+    memset(&storage, 0xA5, sizeof(storage));  // Power-on garbage
+
+    {
+        StallWatchdog boot1(storage);
+        TEST_ASSERT_FALSE(boot1.hasPreviousStall());
+        int8_t loop = boot1.addSlot("loop", 2000);
+        boot1.setTask(static_cast<uint8_t>(loop), nullptr, 1);
+        boot1.enter(loop, "log_drain", 5000);
+        TEST_ASSERT_EQUAL_INT8(loop, boot1.check(7250));
+        const uint32_t pcs[] = {0x400d1e2a, 0x400d2b10, 0x40089abc};
+        boot1.recordStall(static_cast<uint8_t>(loop), 7250, static_cast<uint8_t>(TraceId::WS_SEND), pcs, 3);
+        boot1.markReset();
+    }
+
+    StallWatchdog boot2(storage);
+    TEST_ASSERT_TRUE(boot2.hasPreviousStall());
+    const StallRecord& previous = boot2.getPreviousStall();
+    TEST_ASSERT_EQUAL_STRING("loop", previous.slot);
+    TEST_ASSERT_EQUAL_STRING("log_drain", previous.activity);
+    TEST_ASSERT_EQUAL_UINT8(3, previous.depth);
+    TEST_ASSERT_EQUAL_UINT8(1, previous.reset);
+
+    char backtrace[64];
+    StallWatchdog::formatBacktrace(previous, backtrace, sizeof(backtrace));
+    TEST_ASSERT_EQUAL_STRING("0x400d1e2a 0x400d2b10 0x40089abc", backtrace);
+    StallWatchdog::formatBacktrace(previous, backtrace, 15);  // Whole addresses only
+    TEST_ASSERT_EQUAL_STRING("0x400d1e2a", backtrace);
+
+    StaticJsonWriter<512> json;
+    TEST_ASSERT_TRUE(boot2.writeStats(json, 100));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"stall\":null"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(),
+        "\"previous_boot\":{\"slot\":\"loop\",\"activity\":\"log_drain\",\"trace\":\"ws_send\",\"core\":1,"
+        "\"entered_ms\":5000,\"stalled_ms\":2250,\"reset\":true,\"backtrace\":\"0x400d1e2a 0x400d2b10 0x40089abc\"}"));
+
+    // Consumed: a third boot without a new stall has nothing to report
+    StallWatchdog boot3(storage);
+    TEST_ASSERT_FALSE(boot3.hasPreviousStall());
+
+    // A flipped bit invalidates the record
+    {
+        StallWatchdog boot4(storage);
+        int8_t loop = boot4.addSlot("loop", 2000);
+        boot4.enter(loop, "oled_page", 0);
+        boot4.check(3000);
+        boot4.recordStall(static_cast<uint8_t>(loop), 3000, static_cast<uint8_t>(TraceId::COUNT), nullptr, 0);
+    }
+    storage.activity[0] ^= 0x01;
+    StallWatchdog boot5(storage);
+    TEST_ASSERT_FALSE(boot5.hasPreviousStall());
+}
@@ -0,0 +1,60 @@
+/**
+ * @file test_static_instance.cpp
+ * @brief Unit tests for StaticInstance (placement of boot-time objects in static storage)
+ *
+ * Tests validate:
+ * - emplace() constructs once, in the slot's own aligned storage
+ * - The footprint counts every slot's size, and the constructed ones separately
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/StaticInstance.h"
+#include "../../src/utils/StaticInstance.cpp"
+
+namespace {
+struct PlacedSensor {
+    static int constructed;
+    double value;
+    int pin;
+    PlacedSensor(int pin, double value) : value(value), pin(pin) { constructed++; }
+};
+int PlacedSensor::constructed = 0;
+}
+
+/**
+ * @brief UT-047: Construct once in place; reserved and placed footprint
+ */
+void test_static_instance_placement_and_footprint() {
+    StaticFootprint before = GetStaticFootprint();
+    static StaticInstance<PlacedSensor> sensorSlot;
+    static StaticInstance<PlacedSensor> unusedSlot;
+    TEST_ASSERT_EQUAL_UINT32(before.reservedBytes + 2 * sizeof(PlacedSensor), GetStaticFootprint().reservedBytes);
+    TEST_ASSERT_EQUAL_UINT16(before.slots + 2, GetStaticFootprint().slots);
+
+    TEST_ASSERT_NULL(sensorSlot.get());
+    PlacedSensor* sensor = sensorSlot.emplace(4, 21.5);
+    TEST_ASSERT_NOT_NULL(sensor);
+    TEST_ASSERT_TRUE(sensorSlot.isPlaced());
+    TEST_ASSERT_EQUAL_PTR(sensor, sensorSlot.get());
+    TEST_ASSERT_EQUAL_INT(0, reinterpret_cast<uintptr_t>(sensor) % alignof(PlacedSensor));
+    TEST_ASSERT_EQUAL_INT(4, sensor->pin);
+    TEST_ASSERT_EQUAL_DOUBLE(21.5, sensor->value);
+
+    // A second emplace() returns the existing object untouched
+    TEST_ASSERT_EQUAL_PTR(sensor, sensorSlot.emplace(5, 0.0));
+    TEST_ASSERT_EQUAL_INT(1, PlacedSensor::constructed);
+    TEST_ASSERT_EQUAL_INT(4, sensor->pin);
+
+    const StaticFootprint& footprint = GetStaticFootprint();
+    TEST_ASSERT_EQUAL_UINT32(before.placedBytes + sizeof(PlacedSensor), footprint.placedBytes);
+    TEST_ASSERT_EQUAL_UINT16(before.placed + 1, footprint.placed);
+    TEST_ASSERT_FALSE(unusedSlot.isPlaced());
+
+    StaticJsonWriter<128> json;
+    StaticFootprint sample = {5120, 4980, 25, 23};
+    sample.writeJson(json, nullptr);
+    TEST_ASSERT_EQUAL_STRING("{\"reserved_bytes\":5120,\"slots\":25,\"placed_bytes\":4980,\"placed\":23}", json.c_str());
+}
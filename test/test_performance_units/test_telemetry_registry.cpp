@@ -0,0 +1,159 @@
+/**
+ * @file test_telemetry_registry.cpp
+ * @brief Unit tests for TelemetryRegistry (one snapshot behind /metrics, /stats, the OLED and the soak CSV)
+ *
+ * Tests validate:
+ * - Counters publish their total and the rate over the aggregation interval,
+ *   sources run before the snapshot, gauges without a value stay NO_VALUE
+ * - Histograms publish the count and quantiles of the last interval only
+ * - /stats JSON, one /metrics family per name with the entries as labelled series,
+ *   and the OLED adapter reading the same snapshot
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/TelemetryRegistry.h"
+#include "../../src/utils/TelemetryRegistry.cpp"
+#include "../../src/components/TelemetrySystemMetrics.h"
+#include "../../src/components/TelemetrySystemMetrics.cpp"
+
+namespace {
+
+uint32_t ownerTotal = 0;
+int sourceCalls = 0;
+
+void mirrorOwner(void* context) {
+    TelemetryRegistry* registry = static_cast<TelemetryRegistry*>(context);
+    registry->setTotal(TelemetryCounter::LOG_DROPPED, ownerTotal);
+    registry->set(TelemetryGauge::HEAP_FREE, 180000);
+    sourceCalls++;
+}
+
+unsigned long fakeMillis() {
+    return 4321;
+}
+
+}  // namespace
+
+/**
+ * @brief Totals and per-second rates per interval; sources run first, gauges start without a value
+ */
+void test_telemetry_counters_rates_and_sources() {
+    TelemetryRegistry registry;
+    TEST_ASSERT_EQUAL_UINT32(TelemetryRegistry::NO_VALUE, registry.getGauge(TelemetryGauge::HEAP_FREE));
+    TEST_ASSERT_TRUE(registry.addSource(mirrorOwner, &registry));
+    TEST_ASSERT_FALSE(registry.addSource(nullptr, nullptr));
+    sourceCalls = 0;
+
+    registry.aggregate(1000);   // Baseline at 1 s
+    TEST_ASSERT_EQUAL(1, sourceCalls);
+    TEST_ASSERT_EQUAL_UINT32(180000, registry.getGauge(TelemetryGauge::HEAP_FREE));
+    TEST_ASSERT_EQUAL_UINT32(TelemetryRegistry::NO_VALUE, registry.getGauge(TelemetryGauge::LOOP_P99));
+
+    for (int i = 0; i < 250; i++) {
+        registry.increment(TelemetryCounter::N2K_DISPATCHED);
+    }
+    registry.add(TelemetryCounter::N2K_DISPATCHED, 250);
+    ownerTotal = 30;
+    registry.aggregate(3000);   // 500 in 2 s
+
+    TelemetrySnapshot snapshot;
+    TEST_ASSERT_TRUE(registry.read(snapshot));
+    TEST_ASSERT_EQUAL_UINT32(2, snapshot.generation);
+    TEST_ASSERT_EQUAL_UINT32(2000, snapshot.intervalMs);
+    TEST_ASSERT_EQUAL_UINT32(500, snapshot.get(TelemetryCounter::N2K_DISPATCHED).total);
+    TEST_ASSERT_EQUAL_UINT32(250, snapshot.get(TelemetryCounter::N2K_DISPATCHED).ratePerSec);
+    TEST_ASSERT_EQUAL_UINT32(30, snapshot.get(TelemetryCounter::LOG_DROPPED).total);
+    TEST_ASSERT_EQUAL_UINT32(15, snapshot.get(TelemetryCounter::LOG_DROPPED).ratePerSec);
+
+    registry.aggregate(4000);   // Nothing new: totals stay, rates drop to 0
+    TEST_ASSERT_EQUAL_UINT32(500, registry.getCounter(TelemetryCounter::N2K_DISPATCHED).total);
+    TEST_ASSERT_EQUAL_UINT32(0, registry.getCounter(TelemetryCounter::N2K_DISPATCHED).ratePerSec);
+    TEST_ASSERT_EQUAL_UINT32(3, registry.getGeneration());
+}
+
+/**
+ * @brief Histogram quantiles cover the last interval only (bucket upper edges)
+ */
+void test_telemetry_histogram_interval_quantiles() {
+    TelemetryRegistry registry;
+    for (int i = 0; i < 99; i++) {
+        registry.record(TelemetryHistogram::N2K_HANDLER_US, 40);
+    }
+    registry.record(TelemetryHistogram::N2K_HANDLER_US, 900);
+    registry.aggregate(1000);
+
+    const TelemetryHistogramValue& h = registry.getHistogram(TelemetryHistogram::N2K_HANDLER_US);
+    uint32_t edge40 = LatencyHistogram::bucketUpperEdge(LatencyHistogram::bucketFor(40)) - 1;
+    uint32_t edge900 = LatencyHistogram::bucketUpperEdge(LatencyHistogram::bucketFor(900)) - 1;
+    TEST_ASSERT_EQUAL_UINT32(100, h.count);
+    TEST_ASSERT_EQUAL_UINT32(edge40, h.p50);
+    TEST_ASSERT_EQUAL_UINT32(edge40, h.p99);
+    TEST_ASSERT_EQUAL_UINT32(edge900, h.max);
+    TEST_ASSERT_TRUE(h.p50 >= 40 && edge900 >= 900);
+
+    registry.record(TelemetryHistogram::N2K_HANDLER_US, 5);
+    registry.aggregate(2000);   // The 900 µs sample belongs to the previous interval
+    TEST_ASSERT_EQUAL_UINT32(1, h.count);
+    TEST_ASSERT_EQUAL_UINT32(5, h.max);
+    TEST_ASSERT_EQUAL_UINT32(0, registry.getHistogram(TelemetryHistogram::CALC_CYCLE_US).count);
+}
+
+/**
+ * @brief /stats JSON, grouped /metrics families and the OLED adapter read one snapshot
+ */
+void test_telemetry_json_metrics_and_display() {
+    TelemetryRegistry registry;
+    registry.setTotal(TelemetryCounter::MESSAGES_NMEA2000, 1200);
+    registry.set(TelemetryGauge::CPU_IDLE_CORE0, 80);
+    registry.set(TelemetryGauge::CPU_IDLE_CORE1, 61);
+    registry.set(TelemetryGauge::HEAP_FREE, 150000);
+    registry.record(TelemetryHistogram::CALC_CYCLE_US, 2);
+    registry.aggregate(1000);
+
+    char buffer[2048];
+    JsonWriter json(buffer, sizeof(buffer));
+    registry.writeJson(json);
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"generation\":1,\"time_ms\":1000,\"interval_ms\":1000"));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"MESSAGES_NMEA2000\":{\"total\":1200,\"rate\":1200}"));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"HEAP_FREE\":150000,"));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"HEAP_MIN\":null"));
+    TEST_ASSERT_NOT_NULL(strstr(buffer, "\"CALC_CYCLE_US\":{\"count\":1,\"p50\":2,"));
+    TEST_ASSERT_EQUAL_STRING("LOOP_P99", TelemetryRegistry::gaugeKey(TelemetryGauge::LOOP_P99));
+
+    MetricRegistry metrics;
+    TEST_ASSERT_TRUE(registry.registerMetrics(metrics));
+    TEST_ASSERT_FALSE(registry.registerMetrics(metrics));   // Once only
+    const MetricFamily& messages = metrics.get(0);
+    TEST_ASSERT_EQUAL_STRING("poseidon2_messages_total", messages.name);
+    TEST_ASSERT_EQUAL(MetricType::COUNTER, messages.type);
+    TEST_ASSERT_EQUAL(3, messages.count);
+
+    MetricWriter writer;
+    writer.begin(metrics);
+    static char document[8192];
+    size_t length = 0;
+    size_t n;
+    while ((n = writer.read(document + length, sizeof(document) - 1 - length)) > 0) {
+        length += n;
+    }
+    document[length] = '\0';
+    TEST_ASSERT_NOT_NULL(strstr(document, "poseidon2_messages_total{protocol=\"nmea2000\"} 1200\n"));
+    TEST_ASSERT_NOT_NULL(strstr(document, "poseidon2_cpu_idle_percent{core=\"1\"} 61\n"));
+    TEST_ASSERT_NOT_NULL(strstr(document, "poseidon2_heap_free_bytes 150000\n"));
+    TEST_ASSERT_NOT_NULL(strstr(document, "poseidon2_calculation_cycle_us{quantile=\"0.99\"} 2\n"));
+    TEST_ASSERT_NULL(strstr(document, "\nposeidon2_heap_min_free_bytes "));   // No value: no sample
+    TEST_ASSERT_NOT_NULL(strstr(document, "# TYPE poseidon2_heap_min_free_bytes gauge\n"));
+
+    TelemetrySystemMetrics display(&registry, fakeMillis);
+    TEST_ASSERT_EQUAL_UINT32(150000, display.getFreeHeapBytes());
+    TEST_ASSERT_EQUAL_UINT32(0, display.getMinFreeHeapBytes());
+    TEST_ASSERT_EQUAL_UINT8(71, display.getCpuIdlePercent());
+    TEST_ASSERT_EQUAL_UINT8(61, display.getCoreIdlePercent(1));
+    TEST_ASSERT_EQUAL_UINT8(CPU_IDLE_UNKNOWN, display.getCoreIdlePercent(2));
+    TEST_ASSERT_EQUAL(4321UL, display.getMillis());
+}
@@ -0,0 +1,150 @@
+/**
+ * @file test_trace_recorder.cpp
+ * @brief Unit tests for TraceRecorder and its Chrome trace_event export
+ *
+ * Tests validate:
+ * - The ring keeps the newest TRACE_RING_EVENTS events; pause stops recording
+ * - Timestamps per core from CCOUNT, aligned by tick, across CCOUNT wrap-around
+ * - The document is identical whatever the read() chunk size
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <string>
+#include "../../src/utils/TraceRecorder.h"
+#include "../../src/utils/TraceRecorder.cpp"
+
+static uint32_t _traceCycles = 0;
+
+static uint32_t mockTraceCycles() {
+    return _traceCycles;
+}
+
+static std::string exportTrace(const TraceRecorder& recorder, uint32_t cpuMhz, size_t chunk) {
+    TraceChromeWriter writer(recorder, cpuMhz);
+    std::string out;
+    char buffer[512];
+    size_t n;
+    while ((n = writer.read(buffer, chunk)) > 0) {
+        out.append(buffer, n);
+    }
+    return out;
+}
+
+/**
+ * @brief UT-023: The ring keeps the newest events; paused recording is dropped
+ */
+void test_trace_recorder_ring() {
+    static TraceRecorder recorder(mockTraceCycles);
+    recorder.begin();
+    recorder.clear();
+    recorder.resume();
+    TEST_ASSERT_EQUAL_UINT32(0, recorder.getOldest());
+
+    for (uint32_t i = 0; i < TraceRecorder::CAPACITY + 10; i++) {
+        _traceCycles = i * 100;
+        recorder.record(TraceId::N2K_PARSE, (i & 1) != 0, 0, i, 127250);
+    }
+    TEST_ASSERT_EQUAL_UINT32(TraceRecorder::CAPACITY + 10, recorder.getRecorded());
+    TEST_ASSERT_EQUAL_UINT32(10, recorder.getOldest());
+    TEST_ASSERT_EQUAL_UINT32(1000, recorder.at(10).cycles);
+    TEST_ASSERT_EQUAL_UINT8(0, recorder.at(10).end);
+
+    recorder.pause();
+    recorder.record(TraceId::CALCULATE, false, 1, 0, 0);
+    TEST_ASSERT_EQUAL_UINT32(TraceRecorder::CAPACITY + 10, recorder.getRecorded());
+    recorder.resume();
+
+    TEST_ASSERT_EQUAL_STRING("n2k_parse", TraceRecorder::name(0));
+    TEST_ASSERT_EQUAL_STRING("display_render", TraceRecorder::name(static_cast<uint8_t>(TraceId::DISPLAY_RENDER)));
+    TEST_ASSERT_EQUAL_STRING("unknown", TraceRecorder::name(200));
+    TEST_ASSERT_EQUAL_STRING("pgn", TraceRecorder::argName(0));
+}
+
+/**
+ * @brief UT-024: Chrome JSON with per-core tracks; timestamps survive CCOUNT wrap-around
+ */
+void test_trace_recorder_chrome_export() {
+    static TraceRecorder recorder(mockTraceCycles);
+    recorder.begin();
+    recorder.clear();
+
+    // Core 1 starts at tick 1000, core 0 one ms later with an unrelated counter
+    _traceCycles = 0xFFFFFF00u;
+    recorder.record(TraceId::CALCULATE, false, 1, 1000, 3);
+    _traceCycles = 0xFFFFFF00u + 2400;  // 10 us at 240 MHz, across the wrap
+    recorder.record(TraceId::CALCULATE, true, 1, 1000, 0);
+    _traceCycles = 500;
+    recorder.record(TraceId::N2K_PARSE, false, 0, 1001, 127250);
+    // 20 s later on core 1: CCOUNT wrapped once more (period 17.9 s)
+    _traceCycles = 0xFFFFFF00u + static_cast<uint32_t>(20000000ull * 240);
+    recorder.record(TraceId::DISPLAY_RENDER, false, 1, 21000, 0);
+
+    recorder.pause();
+    std::string json = exportTrace(recorder, 240, 512);
+    recorder.resume();
+
+    const char* header = "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"cpu_mhz\":240,\"recorded\":4,\"events\":4},"
+                         "\"traceEvents\":[";
+    TEST_ASSERT_EQUAL_STRING_LEN(header, json.c_str(), strlen(header));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"core 0\"}}"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), ",{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"core 1\"}}"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"name\":\"calculate\",\"ph\":\"B\",\"ts\":0.0,\"pid\":1,\"tid\":1,\"args\":{\"changed\":3}}"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"name\":\"calculate\",\"ph\":\"E\",\"ts\":10.0,\"pid\":1,\"tid\":1}"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"name\":\"n2k_parse\",\"ph\":\"B\",\"ts\":1000.0,\"pid\":1,\"tid\":0,\"args\":{\"pgn\":127250}}"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"name\":\"display_render\",\"ph\":\"B\",\"ts\":20000000.0,"));
+    TEST_ASSERT_EQUAL_STRING("]}", json.c_str() + json.size() - 2);
+}
+
+/**
+ * @brief UT-025: The document does not depend on the chunk size; an empty ring is valid JSON
+ */
+void test_trace_recorder_chunked_read() {
+    static TraceRecorder recorder(mockTraceCycles);
+    recorder.begin();
+    recorder.clear();
+    for (uint32_t i = 0; i < 40; i++) {
+        _traceCycles = i * 240;
+        recorder.record(i % 2 ? TraceId::WS_SEND : TraceId::SERIALIZE, false, static_cast<uint8_t>(i % 2), 5000, i);
+    }
+    recorder.pause();
+    std::string whole = exportTrace(recorder, 240, 512);
+    std::string tiny = exportTrace(recorder, 240, 7);
+    TEST_ASSERT_EQUAL_STRING(whole.c_str(), tiny.c_str());
+
+    TraceChromeWriter writer(recorder, 240);
+    TEST_ASSERT_EQUAL_UINT32(40, writer.getEventCount());
+
+    recorder.clear();
+    std::string empty = exportTrace(recorder, 240, 64);
+    TEST_ASSERT_EQUAL_STRING("{\"displayTimeUnit\":\"ms\",\"otherData\":{\"cpu_mhz\":240,\"recorded\":0,\"events\":0},"
+                             "\"traceEvents\":[]}", empty.c_str());
+    recorder.resume();
+}
+
+/**
+ * @brief UT-037: Innermost open span per core (stall reports)
+ */
+void test_trace_recorder_last_open() {
+    static TraceRecorder recorder(mockTraceCycles);
+    recorder.begin();
+    recorder.clear();
+    const uint8_t none = static_cast<uint8_t>(TraceId::COUNT);
+    TEST_ASSERT_EQUAL_UINT8(none, recorder.lastOpen(1));
+
+    recorder.record(TraceId::CALCULATE, false, 1, 100, 0);
+    recorder.record(TraceId::N2K_PARSE, false, 0, 100, 130306);   // Other core
+    recorder.record(TraceId::SERIALIZE, false, 1, 100, 0);
+    recorder.record(TraceId::SERIALIZE, true, 1, 101, 0);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(TraceId::CALCULATE), recorder.lastOpen(1));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(TraceId::N2K_PARSE), recorder.lastOpen(0));
+
+    recorder.record(TraceId::WS_SEND, false, 1, 102, 512);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(TraceId::WS_SEND), recorder.lastOpen(1));
+
+    recorder.record(TraceId::WS_SEND, true, 1, 103, 0);
+    recorder.record(TraceId::CALCULATE, true, 1, 103, 0);
+    TEST_ASSERT_EQUAL_UINT8(none, recorder.lastOpen(1));
+}
@@ -0,0 +1,213 @@
+/**
+ * @file test_trip_counters.cpp
+ * @brief Unit tests for TripCounters (engine hours, distance, amp-hours, shore energy)
+ *
+ * Tests validate:
+ * - One hour of 1 s samples gives the expected totals; gaps, stale groups and SOG jitter add nothing;
+ *   the NVS record round-trips and a damaged one is refused
+ * - Commits follow the interval and significant-change rules within the daily budget; low supply
+ *   voltage, resets and restarts force a commit
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/TripCounters.h"
+#include "../../src/utils/TripCounters.cpp"
+
+namespace {
+
+void freshen(BoatDataStructure& data, uint32_t nowMs) {
+    data.engine.lastUpdate = nowMs;
+    data.gps.lastUpdate = nowMs;
+    data.battery.lastUpdate = nowMs;
+    data.shorePower.lastUpdate = nowMs;
+}
+
+/// 1 s samples from @p fromMs to @p toMs (inclusive), data kept fresh
+void run(TripCounters& counters, BoatDataStructure& data, uint32_t fromMs, uint32_t toMs) {
+    for (uint32_t now = fromMs; now <= toMs; now += 1000) {
+        freshen(data, now);
+        counters.sample(data, now);
+    }
+}
+
+void underway(BoatDataStructure& data) {
+    memset(&data, 0, sizeof(data));
+    data.engine.available = true;
+    data.engine.engineRev = 1500;
+    data.gps.available = true;
+    data.gps.sog = 6.0;
+    data.battery.available = true;
+    data.battery.amperageA = 10.0;   // Charging
+    data.battery.amperageB = -5.0;   // Discharging
+    data.battery.voltageA = 12.8;
+    data.shorePower.available = true;
+    data.shorePower.shorePowerOn = true;
+    data.shorePower.power = 1200;
+}
+
+}  // namespace
+
+/**
+ * @brief UT-062: One hour integrates to the expected totals; the record round-trips
+ */
+void test_trip_counters_integrate_samples() {
+    TripCounters counters;
+    BoatDataStructure data;
+    underway(data);
+
+    run(counters, data, 1000, 3601000);  // First sample only sets the start
+    TripCounterValues v = counters.snapshot();
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 3600.0, v.engineSeconds);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 6.0, v.distanceNm);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 10.0, v.ampHoursIn[0]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 0.0, v.ampHoursOut[0]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 5.0, v.ampHoursOut[1]);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 1.2, v.shoreKWh);
+
+    // A gap (stalled loop) is skipped, not integrated at the last values
+    freshen(data, 3601000 + TRIP_MAX_GAP_MS + 1000);
+    counters.sample(data, 3601000 + TRIP_MAX_GAP_MS + 1000);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 3600.0, counters.snapshot().engineSeconds);
+
+    // Stale engine data, SOG below the jitter threshold, engine off: nothing added
+    uint32_t now = 3601000 + TRIP_MAX_GAP_MS + 1000;
+    data.gps.sog = TRIP_SOG_MIN_KN / 2;
+    data.engine.lastUpdate = now - TRIP_STALE_MS - 1000;
+    data.gps.lastUpdate = now + 1000;
+    counters.sample(data, now + 1000);
+    data.engine.lastUpdate = now + 2000;
+    data.engine.engineRev = 0;
+    data.gps.lastUpdate = now + 2000;
+    counters.sample(data, now + 2000);
+    v = counters.snapshot();
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 3600.0, v.engineSeconds);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-6, 6.0, v.distanceNm);
+
+    // NVS record round-trip
+    uint8_t record[CONFIG_RECORD_MAX_BYTES];
+    size_t length = counters.encodeRecord(record, sizeof(record));
+    TEST_ASSERT_TRUE(length > 0);
+    TripCounters restored;
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigRecordStatus::OK),
+                            static_cast<uint8_t>(restored.decodeRecord(record, length)));
+    TripCounterValues r = restored.snapshot();
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&v, &r, sizeof(v)));
+    TEST_ASSERT_EQUAL_UINT32(0, counters.encodeRecord(record, 16));  // Does not fit
+
+    record[length - 1] ^= 0x01;
+    TripCounters damaged;
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigRecordStatus::BAD_CRC),
+                            static_cast<uint8_t>(damaged.decodeRecord(record, length)));
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.0, damaged.snapshot().engineSeconds);
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(ConfigRecordStatus::EMPTY),
+                            static_cast<uint8_t>(damaged.decodeRecord(record, 0)));
+
+    StaticJsonWriter<640> json;
+    restored.writeJson(json);
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"engine_hours\":1.00,\"distance_nm\":6.0,"
+                                              "\"battery_a\":{\"ah_in\":10.0,\"ah_out\":0.0},"
+                                              "\"battery_b\":{\"ah_in\":0.0,\"ah_out\":5.0},\"shore_kwh\":1.20,"));
+
+    TripCounter counter = TripCounter::ENGINE_HOURS;
+    TEST_ASSERT_TRUE(TripCounterFromName("all", counter));
+    TEST_ASSERT_EQUAL_UINT8(static_cast<uint8_t>(TripCounter::COUNT), static_cast<uint8_t>(counter));
+    TEST_ASSERT_TRUE(TripCounterFromName("battery_b", counter));
+    TEST_ASSERT_EQUAL_STRING("battery_b", TripCounterName(counter));
+    TEST_ASSERT_FALSE(TripCounterFromName("battery_c", counter));
+}
+
+/**
+ * @brief UT-063: Interval, significant change and budget decide commits; dips, resets and restarts force them
+ */
+void test_trip_counters_commit_schedule() {
+    TripCounters counters;
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+
+    // No data: nothing to commit, however long
+    run(counters, data, 1000, 5000);
+    TEST_ASSERT_FALSE(counters.commitDue(TRIP_COMMIT_INTERVAL_MS + 5000));
+
+    // Small change: only after the interval
+    counters.committed(5000);
+    data.battery.available = true;
+    data.battery.amperageA = -0.5;
+    data.battery.voltageA = 12.6;
+    uint32_t now = 5000 + TRIP_COMMIT_MIN_INTERVAL_MS * 2;
+    run(counters, data, 6000, now);
+    TEST_ASSERT_FALSE(counters.commitDue(now));
+    now = 5000 + TRIP_COMMIT_INTERVAL_MS;
+    run(counters, data, 7000 + TRIP_COMMIT_MIN_INTERVAL_MS * 2, now);
+    TEST_ASSERT_TRUE(counters.commitDue(now));
+    counters.committed(now);
+    TEST_ASSERT_EQUAL_UINT32(2, counters.getCommits());
+    TEST_ASSERT_FALSE(counters.commitDue(now));
+
+    // Significant change (1 nm at 60 kn per minute): every minute until the bucket runs dry
+    data.gps.available = true;
+    data.gps.sog = 60.0;
+    uint32_t commits = 0;
+    for (uint8_t minute = 0; minute < 60; minute++) {
+        run(counters, data, now + 1000, now + 60000);
+        now += 60000;
+        if (counters.commitDue(now)) {
+            counters.committed(now);
+            commits++;
+        }
+    }
+    // Burst, then one commit per refilled token (60 min at 200/day: ~8); each wait counted once
+    TEST_ASSERT_TRUE(commits >= TRIP_COMMIT_BURST && commits < TRIP_COMMIT_BURST + 10);
+    TEST_ASSERT_TRUE(counters.getDeferred() > 0 && counters.getDeferred() < 10);
+
+    // Restart: forced through the empty bucket
+    counters.forceCommit();
+    TEST_ASSERT_TRUE(counters.commitDue(now));
+    counters.committed(now);
+    TEST_ASSERT_EQUAL_UINT32(1, counters.getForcedCommits());
+
+    // Supply dip: one forced commit per dip, re-armed above the hysteresis
+    data.gps.sog = 0;
+    data.battery.voltageA = TRIP_LOW_VOLTAGE_V - 0.5;
+    run(counters, data, now + 1000, now + 2000);
+    now += 2000;
+    TEST_ASSERT_TRUE(counters.commitDue(now));
+    counters.committed(now);
+    run(counters, data, now + 1000, now + 2000);
+    now += 2000;
+    TEST_ASSERT_FALSE(counters.commitDue(now));
+    data.battery.voltageA = TRIP_LOW_VOLTAGE_V + TRIP_LOW_VOLTAGE_HYSTERESIS_V / 2;
+    run(counters, data, now + 1000, now + 2000);
+    now += 2000;
+    data.battery.voltageA = TRIP_LOW_VOLTAGE_V - 0.5;
+    run(counters, data, now + 1000, now + 2000);
+    now += 2000;
+    TEST_ASSERT_FALSE(counters.commitDue(now));  // Not re-armed yet
+    data.battery.voltageA = TRIP_LOW_VOLTAGE_V + TRIP_LOW_VOLTAGE_HYSTERESIS_V;
+    run(counters, data, now + 1000, now + 2000);
+    data.battery.voltageA = TRIP_LOW_VOLTAGE_V - 0.5;
+    run(counters, data, now + 3000, now + 4000);
+    now += 4000;
+    TEST_ASSERT_TRUE(counters.commitDue(now));
+    counters.committed(now);
+    TEST_ASSERT_EQUAL_UINT32(3, counters.getForcedCommits());
+
+    // Reset (HTTP task): applied at the next sample and committed right away
+    TEST_ASSERT_TRUE(counters.snapshot().distanceNm > 1.0);
+    counters.requestReset(TripCounter::DISTANCE);
+    TEST_ASSERT_TRUE(counters.snapshot().distanceNm > 1.0);
+    counters.sample(data, now + 1000);
+    TEST_ASSERT_DOUBLE_WITHIN(1e-9, 0.0, counters.snapshot().distanceNm);
+    TEST_ASSERT_TRUE(counters.snapshot().ampHoursOut[0] > 0);
+    TEST_ASSERT_TRUE(counters.commitDue(now + 1000));
+    counters.requestReset(TripCounter::COUNT);
+    data.battery.available = false;
+    counters.sample(data, now + 2000);
+    TripCounterValues zero;
+    memset(&zero, 0, sizeof(zero));
+    TripCounterValues v = counters.snapshot();
+    TEST_ASSERT_EQUAL_INT(0, memcmp(&zero, &v, sizeof(v)));
+}
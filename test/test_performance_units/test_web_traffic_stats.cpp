@@ -0,0 +1,106 @@
+/**
+ * @file test_web_traffic_stats.cpp
+ * @brief Unit tests for WebTrafficStats (HTTP route timing, WebSocket rates and send queues)
+ *
+ * Tests validate:
+ * - Paths map to the longest matching route prefix, anything else to "other"; responses and
+ *   completions fill their route's counters and histograms; reset() starts over
+ * - WebSocket messages and bytes accumulate per endpoint, rates follow the sample interval,
+ *   the queue peak holds until reset(); the JSON objects carry the documented fields
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/WebTrafficStats.h"
+#include "../../src/utils/WebTrafficStats.cpp"
+
+/**
+ * @brief UT-068: Route matching and per-route response and completion statistics
+ */
+void test_web_traffic_routes() {
+    TEST_ASSERT_EQUAL(WebRoute::API_BOATDATA, WebTrafficStats::routeFor("/api/boatdata"));
+    TEST_ASSERT_EQUAL(WebRoute::CALIBRATION, WebTrafficStats::routeFor("/api/calibration"));
+    TEST_ASSERT_EQUAL(WebRoute::CONFIG, WebTrafficStats::routeFor("/config/reload"));
+    TEST_ASSERT_EQUAL(WebRoute::WIFI, WebTrafficStats::routeFor("/wifi-status"));
+    TEST_ASSERT_EQUAL(WebRoute::WIFI, WebTrafficStats::routeFor("/wifi/profile"));
+    TEST_ASSERT_EQUAL(WebRoute::UPLOAD, WebTrafficStats::routeFor("/upload-wifi-config"));
+    TEST_ASSERT_EQUAL(WebRoute::STREAM, WebTrafficStats::routeFor("/stream"));
+    TEST_ASSERT_EQUAL(WebRoute::OTHER, WebTrafficStats::routeFor("/api/other"));
+    TEST_ASSERT_EQUAL(WebRoute::OTHER, WebTrafficStats::routeFor("/"));
+    TEST_ASSERT_EQUAL(WebRoute::OTHER, WebTrafficStats::routeFor(nullptr));
+    TEST_ASSERT_EQUAL_STRING("api_boatdata", WebTrafficStats::routeName(WebRoute::API_BOATDATA));
+    TEST_ASSERT_EQUAL_STRING("other", WebTrafficStats::routeName(WebRoute::COUNT));
+
+    WebTrafficStats stats;
+    stats.recordResponse(WebRoute::CONFIG, 800, 0, 512);
+    stats.recordResponse(WebRoute::CONFIG, 1200, 64, 256);
+    stats.recordComplete(WebRoute::CONFIG, 15000);
+    const WebRouteStats& config = stats.getRoute(WebRoute::CONFIG);
+    TEST_ASSERT_EQUAL_UINT32(2, config.requests);
+    TEST_ASSERT_EQUAL_UINT32(1, config.completed);   // One connection still open
+    TEST_ASSERT_EQUAL_UINT32(64, config.rxBytes);
+    TEST_ASSERT_EQUAL_UINT32(768, config.txBytes);
+    TEST_ASSERT_EQUAL_UINT32(1000, config.firstByte.getAverage());
+    TEST_ASSERT_EQUAL_UINT32(1200, config.firstByte.getMax());
+    TEST_ASSERT_EQUAL_UINT32(15000, config.complete.getMax());
+    TEST_ASSERT_EQUAL_UINT32(0, stats.getRoute(WebRoute::STATUS).requests);
+
+    StaticJsonWriter<384> json;
+    json.beginObject();
+    stats.writeRouteJson(json, WebRoute::CONFIG);
+    json.endObject();
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"config\":{\"requests\":2,\"completed\":1,\"rx_bytes\":64,\"tx_bytes\":768"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"first_byte\":{\"avg_us\":1000"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"complete\":{\"avg_us\":15000"));
+
+    stats.reset();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.getRoute(WebRoute::CONFIG).requests);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.getRoute(WebRoute::CONFIG).firstByte.getCount());
+}
+
+/**
+ * @brief UT-069: WebSocket message and byte rates, queue depth and peak per endpoint
+ */
+void test_web_traffic_websockets() {
+    WebTrafficStats stats;
+    stats.recordUpgrade(AdmissionEndpoint::BOATDATA);
+    stats.recordUpgrade(AdmissionEndpoint::HTTP);   // Not a WebSocket endpoint: ignored
+    stats.sampleSocket(AdmissionEndpoint::BOATDATA, 2, 0, 0, 1000);
+
+    // Two clients, one 500-byte frame each per second for two seconds
+    stats.wsSent(AdmissionEndpoint::BOATDATA, 500, 2);
+    stats.wsSent(AdmissionEndpoint::BOATDATA, 500, 2);
+    stats.wsSent(AdmissionEndpoint::BOATDATA, 500, 0);   // Nobody was due
+    stats.wsSent(AdmissionEndpoint::LOGS, 80);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.getMessages(AdmissionEndpoint::BOATDATA));
+    TEST_ASSERT_EQUAL_UINT32(2000, stats.getBytes(AdmissionEndpoint::BOATDATA));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.getMessages(AdmissionEndpoint::LOGS));
+
+    stats.sampleSocket(AdmissionEndpoint::BOATDATA, 2, 3, 2, 3000);
+    TEST_ASSERT_EQUAL_UINT32(20, stats.getMessageRateX10(AdmissionEndpoint::BOATDATA));   // 2.0 /s
+    TEST_ASSERT_EQUAL_UINT32(1000, stats.getByteRate(AdmissionEndpoint::BOATDATA));
+    TEST_ASSERT_EQUAL_UINT16(2, stats.getQueuePeak(AdmissionEndpoint::BOATDATA));
+
+    // Quiet interval: the rate drops, the peak stays until reset()
+    stats.sampleSocket(AdmissionEndpoint::BOATDATA, 2, 0, 0, 4000);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.getMessageRateX10(AdmissionEndpoint::BOATDATA));
+    TEST_ASSERT_EQUAL_UINT16(2, stats.getQueuePeak(AdmissionEndpoint::BOATDATA));
+
+    StaticJsonWriter<384> json;
+    json.beginObject();
+    stats.writeSocketJson(json, AdmissionEndpoint::BOATDATA);
+    stats.writeSocketJson(json, AdmissionEndpoint::HTTP);   // Writes nothing
+    json.endObject();
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_EQUAL_STRING("{\"boatdata\":{\"upgrades\":1,\"clients\":2,\"messages\":4,\"bytes\":2000,"
+                             "\"msg_per_s\":0.0,\"bytes_per_s\":0,\"queued\":0,\"deepest\":0,\"peak\":2}}",
+                             json.c_str());
+
+    stats.reset();
+    TEST_ASSERT_EQUAL_UINT16(0, stats.getQueuePeak(AdmissionEndpoint::BOATDATA));
+    TEST_ASSERT_EQUAL_UINT32(4, stats.getMessages(AdmissionEndpoint::BOATDATA));   // Totals are kept
+}
@@ -0,0 +1,132 @@
+/**
+ * @file test_wifi_ap_fallback.cpp
+ * @brief Unit tests for WiFiApFallback (SoftAP while no configured network is reachable)
+ *
+ * Tests validate:
+ * - The AP starts once every network failed (or none is configured) instead of a reboot;
+ *   station rounds follow the retry interval, doubled after each failed round up to the cap,
+ *   and never run without a configuration
+ * - After the station connects the AP stays up while devices are associated, stops after
+ *   WIFI_AP_LINGER_MS without any, and a link lost during the linger goes back to retrying
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/WiFiApFallback.h"
+#include "../../src/utils/WiFiApFallback.cpp"
+
+namespace {
+
+WiFiApInputs linkState(bool connected, bool exhausted, bool configured, uint8_t stations) {
+    WiFiApInputs inputs;
+    inputs.staConnected = connected;
+    inputs.exhausted = exhausted;
+    inputs.configured = configured;
+    inputs.stations = stations;
+    return inputs;
+}
+
+}  // namespace
+
+/**
+ * @brief UT-066: Start on exhaustion, retry on the interval with backoff, never retry without config
+ */
+void test_wifi_ap_fallback_starts_and_retries() {
+    WiFiApFallback ap;
+    const WiFiApInputs connecting = linkState(false, false, true, 0);
+    const WiFiApInputs failed = linkState(false, true, true, 0);
+
+    // First round still running: nothing to do
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(connecting, 1000));
+    TEST_ASSERT_FALSE(ap.isActive());
+
+    // Every network failed: the AP comes up (once)
+    TEST_ASSERT_EQUAL(WiFiApAction::START_AP, ap.update(failed, 2000));
+    TEST_ASSERT_TRUE(ap.isActive());
+    TEST_ASSERT_EQUAL_UINT32(1, ap.getStarts());
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(failed, 3000));
+    TEST_ASSERT_EQUAL_UINT32(WIFI_AP_RETRY_INTERVAL_MS - 1000, ap.getRetryInMs(3000));
+
+    // Round due after the interval
+    uint32_t now = 2000 + WIFI_AP_RETRY_INTERVAL_MS;
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(failed, now - 1));
+    TEST_ASSERT_EQUAL(WiFiApAction::RETRY_STA, ap.update(failed, now));
+    TEST_ASSERT_EQUAL_UINT32(1, ap.getRetries());
+    TEST_ASSERT_EQUAL_UINT32(0, ap.getRetryInMs(now));
+
+    // The round runs, then fails: the next one waits twice as long
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(connecting, now + 1000));
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(failed, now + 20000));
+    TEST_ASSERT_EQUAL_UINT32(2 * WIFI_AP_RETRY_INTERVAL_MS, ap.getRetryIntervalMs());
+    now += 20000 + 2 * WIFI_AP_RETRY_INTERVAL_MS;
+    TEST_ASSERT_EQUAL(WiFiApAction::RETRY_STA, ap.update(failed, now));
+
+    // Backoff stops at the cap
+    for (int round = 0; round < 10; round++) {
+        ap.update(failed, now + 1);
+        now += ap.getRetryIntervalMs() + 1;
+        TEST_ASSERT_EQUAL(WiFiApAction::RETRY_STA, ap.update(failed, now));
+    }
+    TEST_ASSERT_EQUAL_UINT32(WIFI_AP_RETRY_MAX_MS, ap.getRetryIntervalMs());
+    TEST_ASSERT_EQUAL_UINT32(1, ap.getStarts());
+
+    // No configuration: the AP starts, the station never retries
+    WiFiApFallback empty;
+    const WiFiApInputs none = linkState(false, true, false, 1);
+    TEST_ASSERT_EQUAL(WiFiApAction::START_AP, empty.update(none, 0));
+    for (uint32_t t = 1000; t < 4 * WIFI_AP_RETRY_MAX_MS; t += 60000) {
+        TEST_ASSERT_EQUAL(WiFiApAction::NONE, empty.update(none, t));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, empty.getRetries());
+    TEST_ASSERT_EQUAL_UINT8(1, empty.getStations());
+}
+
+/**
+ * @brief UT-067: The AP lingers for associated devices, stops when idle, and reports over JSON
+ */
+void test_wifi_ap_fallback_linger_and_stop() {
+    WiFiApFallback ap;
+    TEST_ASSERT_EQUAL(WiFiApAction::START_AP, ap.update(linkState(false, true, true, 2), 0));
+    uint32_t now = WIFI_AP_RETRY_INTERVAL_MS;
+    TEST_ASSERT_EQUAL(WiFiApAction::RETRY_STA, ap.update(linkState(false, true, true, 2), now));
+    ap.update(linkState(false, true, true, 2), now + 1000);   // Failed round: interval doubled
+
+    // The station connects while two devices use the AP: it stays up
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(linkState(true, false, true, 2), now + 2000));
+    TEST_ASSERT_EQUAL(WiFiApState::LINGER, ap.getState());
+    TEST_ASSERT_EQUAL_UINT32(WIFI_AP_RETRY_INTERVAL_MS, ap.getRetryIntervalMs());   // Backoff reset
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(linkState(true, false, true, 2), now + 10 * WIFI_AP_LINGER_MS));
+
+    // The devices leave: stopped WIFI_AP_LINGER_MS later, a device back in between restarts the wait
+    now += 10 * WIFI_AP_LINGER_MS;
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(linkState(true, false, true, 0), now));
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(linkState(true, false, true, 1), now + WIFI_AP_LINGER_MS - 1));
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(linkState(true, false, true, 0), now + WIFI_AP_LINGER_MS));
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(linkState(true, false, true, 0), now + 2 * WIFI_AP_LINGER_MS - 1));
+    TEST_ASSERT_EQUAL(WiFiApAction::STOP_AP, ap.update(linkState(true, false, true, 0), now + 2 * WIFI_AP_LINGER_MS));
+    TEST_ASSERT_FALSE(ap.isActive());
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, ap.update(linkState(true, false, true, 0), now + 3 * WIFI_AP_LINGER_MS));
+
+    // Link lost during the linger: back to retrying, the AP was never stopped
+    WiFiApFallback lost;
+    lost.update(linkState(false, true, true, 1), 0);
+    lost.update(linkState(true, false, true, 1), 1000);
+    TEST_ASSERT_EQUAL(WiFiApAction::NONE, lost.update(linkState(false, false, true, 1), 2000));
+    TEST_ASSERT_EQUAL(WiFiApState::ACTIVE, lost.getState());
+    TEST_ASSERT_EQUAL(WiFiApAction::RETRY_STA, lost.update(linkState(false, true, true, 1), 2000 + WIFI_AP_RETRY_INTERVAL_MS));
+    TEST_ASSERT_EQUAL_UINT32(1, lost.getStarts());
+
+    // JSON for GET /wifi-status
+    StaticJsonWriter<256> json;
+    json.beginObject();
+    lost.writeJson(json, 2000 + WIFI_AP_RETRY_INTERVAL_MS, "ap");
+    json.endObject();
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"state\":\"active\""));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"stations\":1"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"retries\":1"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "\"retry_in_ms\":0"));
+}
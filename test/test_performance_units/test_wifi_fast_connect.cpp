@@ -0,0 +1,121 @@
+/**
+ * @file test_wifi_fast_connect.cpp
+ * @brief Unit tests for WiFiFastConnect (directed reconnect cache, static IP, connect statistics)
+ *
+ * Tests validate:
+ * - "@ip" static addresses parse, default the DNS server and reject inconsistent subnets
+ * - The association cache survives its file format, falls back after a failure and replaces the oldest entry
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "../../src/utils/WiFiFastConnect.h"
+#include "../../src/utils/WiFiFastConnect.cpp"
+
+/**
+ * @brief UT-056: Static IP lines parse to four addresses; bad masks and foreign gateways are rejected
+ */
+void test_wifi_static_ip_parse() {
+    WiFiStaticIP ip;
+    TEST_ASSERT_TRUE(WiFiParseStaticIP("192.168.1.50 255.255.255.0 192.168.1.1", ip));
+    TEST_ASSERT_TRUE(ip.enabled());
+    const uint8_t expectedIp[4] = {192, 168, 1, 50};
+    const uint8_t expectedDns[4] = {192, 168, 1, 1};
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expectedIp, ip.ip, 4));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(expectedDns, ip.dns, 4));  // Gateway as DNS
+
+    char text[64];
+    TEST_ASSERT_GREATER_THAN(0, WiFiFormatStaticIP(ip, text, sizeof(text)));
+    TEST_ASSERT_EQUAL_STRING("192.168.1.50 255.255.255.0 192.168.1.1 192.168.1.1", text);
+    WiFiStaticIP again;
+    TEST_ASSERT_TRUE(WiFiParseStaticIP(text, again));
+    TEST_ASSERT_TRUE(again == ip);
+    TEST_ASSERT_EQUAL_UINT32(0, WiFiFormatStaticIP(ip, text, 8));
+
+    TEST_ASSERT_TRUE(WiFiParseStaticIP("  10.0.0.7\t255.255.0.0 10.0.0.1 1.1.1.1 ", ip));
+    TEST_ASSERT_EQUAL_UINT8(1, ip.dns[0]);
+
+    TEST_ASSERT_FALSE(WiFiParseStaticIP("192.168.1.50 255.0.255.0 192.168.1.1", ip));   // Mask not contiguous
+    TEST_ASSERT_FALSE(ip.enabled());
+    TEST_ASSERT_FALSE(WiFiParseStaticIP("192.168.1.50 255.255.255.0 192.168.2.1", ip)); // Gateway elsewhere
+    TEST_ASSERT_FALSE(WiFiParseStaticIP("192.168.1.255 255.255.255.0 192.168.1.1", ip)); // Broadcast
+    TEST_ASSERT_FALSE(WiFiParseStaticIP("192.168.1.0 255.255.255.0 192.168.1.1", ip));   // Network
+    TEST_ASSERT_FALSE(WiFiParseStaticIP("192.168.1.256 255.255.255.0 192.168.1.1", ip));
+    TEST_ASSERT_FALSE(WiFiParseStaticIP("192.168.1.50 255.255.255.0", ip));             // No gateway
+    TEST_ASSERT_FALSE(WiFiParseStaticIP("192.168.1.50 255.255.255.0 192.168.1.1 x", ip));
+    TEST_ASSERT_FALSE(WiFiParseStaticIP(nullptr, ip));
+}
+
+/**
+ * @brief UT-057: Cache round trip, fallback after a failed directed connect, LRU replacement, statistics
+ */
+void test_wifi_connect_cache_and_stats() {
+    WiFiConnectCache cache;
+    const uint8_t marina[6] = {0x24, 0x5a, 0x4c, 0x01, 0xab, 0xcd};
+    const uint8_t boat[6] = {0xde, 0xad, 0xbe, 0xef, 0x00, 0x01};
+    uint8_t bssid[6];
+    uint8_t channel = 0;
+
+    TEST_ASSERT_FALSE(cache.lookup("Marina", bssid, channel));
+    TEST_ASSERT_TRUE(cache.remember("Marina", marina, 11));
+    TEST_ASSERT_FALSE(cache.remember("Marina", marina, 11));  // Unchanged: nothing to persist
+    TEST_ASSERT_TRUE(cache.remember("Boat,\"Net\"", boat, 6));
+    TEST_ASSERT_TRUE(cache.lookup("Marina", bssid, channel));
+    TEST_ASSERT_EQUAL_INT(0, memcmp(marina, bssid, 6));
+    TEST_ASSERT_EQUAL_UINT8(11, channel);
+
+    // File round trip keeps any SSID byte
+    char text[WiFiConnectCache::MAX_TEXT];
+    size_t n = cache.serialize(text, sizeof(text));
+    TEST_ASSERT_EQUAL_STRING("245a4c01abcd 11 4d6172696e61\ndeadbeef0001 6 426f61742c224e657422\n", text);
+    TEST_ASSERT_EQUAL_UINT32(strlen(text), n);
+    WiFiConnectCache loaded;
+    TEST_ASSERT_EQUAL_UINT8(2, loaded.deserialize(text));
+    TEST_ASSERT_TRUE(loaded.lookup("Boat,\"Net\"", bssid, channel));
+    TEST_ASSERT_EQUAL_UINT8(6, channel);
+
+    // Garbled lines are skipped, not fatal
+    TEST_ASSERT_EQUAL_UINT8(1, loaded.deserialize("zz\n245a4c01abcd 99 4d61\n245a4c01abcd 1 4d61\n245a4c01abcd 1 4d6\n"));
+    TEST_ASSERT_TRUE(loaded.lookup("Ma", bssid, channel));
+
+    // AP replaced: the directed connect fails once, then that network scans until it connects again
+    TEST_ASSERT_TRUE(cache.markFailed("Marina"));
+    TEST_ASSERT_FALSE(cache.markFailed("Marina"));
+    TEST_ASSERT_FALSE(cache.lookup("Marina", bssid, channel));
+    TEST_ASSERT_EQUAL_STRING("deadbeef0001 6 426f61742c224e657422\n", (cache.serialize(text, sizeof(text)), text));
+    TEST_ASSERT_TRUE(cache.remember("Marina", boat, 1));
+    TEST_ASSERT_TRUE(cache.lookup("Marina", bssid, channel));
+
+    // Full: the least recently used network makes room
+    const uint8_t third[6] = {1, 2, 3, 4, 5, 6};
+    TEST_ASSERT_TRUE(cache.remember("Third", third, 3));
+    TEST_ASSERT_TRUE(cache.remember("Fourth", third, 4));
+    TEST_ASSERT_EQUAL_UINT8(WiFiConnectCache::MAX_ENTRIES, cache.size());
+    TEST_ASSERT_FALSE(cache.lookup("Boat,\"Net\"", bssid, channel));
+    TEST_ASSERT_TRUE(cache.lookup("Marina", bssid, channel));
+    TEST_ASSERT_FALSE(cache.remember("", third, 3));
+    TEST_ASSERT_FALSE(cache.remember("Zero", third, 0));
+
+    WiFiConnectStats stats;
+    stats.recordAttempt(WiFiConnectMode::FAST);
+    stats.recordFallback();
+    stats.recordAttempt(WiFiConnectMode::SCAN);
+    stats.recordConnected(WiFiConnectMode::SCAN, 4200, 0);
+    stats.recordAttempt(WiFiConnectMode::FAST);
+    stats.recordConnected(WiFiConnectMode::FAST, 600, 900);
+    stats.recordAttempt(WiFiConnectMode::FAST);
+    stats.recordConnected(WiFiConnectMode::FAST, 700, 1000);
+    TEST_ASSERT_EQUAL_UINT32(650, stats.getAverageMs(WiFiConnectMode::FAST));
+
+    StaticJsonWriter<320> json;
+    stats.writeJson(json);
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"fast_attempts\":3,\"fast_connects\":2,\"fallbacks\":1,\"scan_attempts\":1,\"scan_connects\":1,"
+        "\"last_mode\":\"fast\",\"last_ms\":700,\"last_outage_ms\":1000,\"avg_fast_ms\":650,\"avg_scan_ms\":4200,"
+        "\"max_ms\":4200}",
+        json.c_str());
+}
@@ -0,0 +1,129 @@
+/**
+ * @file test_write_behind.cpp
+ * @brief Unit tests for WriteBehind (debounced configuration persistence)
+ *
+ * Tests validate:
+ * - A burst of changes is written once, after the quiet period or the maximum delay
+ * - A failed save is retried; a change during a save is not lost; flush() writes at once
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include "../../src/utils/WriteBehind.h"
+#include "../../src/utils/WriteBehind.cpp"
+
+namespace {
+
+struct FakeFile {
+    uint32_t saves = 0;
+    bool fail = false;
+    WriteBehind* store = nullptr;  ///< Marked again from inside the save when set
+    int8_t id = -1;
+};
+
+bool fakeSave(void* context) {
+    FakeFile* file = static_cast<FakeFile*>(context);
+    file->saves++;
+    if (file->store != nullptr) {
+        file->store->markDirty(file->id, 0);  // A setter racing the write
+        file->store = nullptr;
+    }
+    return !file->fail;
+}
+
+}  // namespace
+
+/**
+ * @brief UT-052: Three changes in a row cost one save; a steady stream is saved at the maximum delay
+ */
+void test_write_behind_coalesces_changes() {
+    WriteBehind store(100, 1000);
+    FakeFile filter;
+    int8_t id = store.add("log_filter", fakeSave, &filter);
+    TEST_ASSERT_EQUAL_INT8(0, id);
+    TEST_ASSERT_EQUAL_INT8(-1, store.add("null", nullptr, nullptr));
+
+    // level, components, events of one /log-filter request
+    store.markDirty(id, 10);
+    store.markDirty(id, 11);
+    store.markDirty(id, 12);
+    TEST_ASSERT_TRUE(store.isDirty(id));
+    TEST_ASSERT_EQUAL_UINT8(1, store.getPending());
+
+    TEST_ASSERT_TRUE(store.poll(111));  // Quiet for 99 ms only
+    TEST_ASSERT_EQUAL_UINT32(0, filter.saves);
+    TEST_ASSERT_TRUE(store.poll(112));
+    TEST_ASSERT_EQUAL_UINT32(1, filter.saves);
+    TEST_ASSERT_FALSE(store.isDirty(id));
+    TEST_ASSERT_TRUE(store.poll(500));  // Nothing pending
+    TEST_ASSERT_EQUAL_UINT32(1, filter.saves);
+
+    // A change every 50 ms never goes quiet: written once the first is 1000 ms old
+    uint32_t now = 1000;
+    for (; now < 2000; now += 50) {
+        store.markDirty(id, now);
+        store.poll(now);
+    }
+    TEST_ASSERT_EQUAL_UINT32(1, filter.saves);
+    store.markDirty(id, now);
+    store.poll(now);
+    TEST_ASSERT_EQUAL_UINT32(2, filter.saves);
+
+    const WriteBehindEntry* entry = store.at(0);
+    TEST_ASSERT_NOT_NULL(entry);
+    TEST_ASSERT_EQUAL_UINT32(24, entry->changes.load());
+    TEST_ASSERT_EQUAL_UINT32(2, entry->writes);
+    TEST_ASSERT_NULL(store.at(1));
+}
+
+/**
+ * @brief UT-053: Failures are retried after another quiet period; flush() saves everything now
+ */
+void test_write_behind_retry_and_flush() {
+    WriteBehind store(100, 1000);
+    FakeFile filter;
+    FakeFile calibration;
+    int8_t filterId = store.add("log_filter", fakeSave, &filter);
+    int8_t calibrationId = store.add("calibration", fakeSave, &calibration);
+
+    // Failed save: counted, named, retried once quiet again
+    calibration.fail = true;
+    store.markDirty(calibrationId, 0);
+    TEST_ASSERT_FALSE(store.poll(100));
+    TEST_ASSERT_EQUAL_STRING("calibration", store.getLastFailed());
+    TEST_ASSERT_TRUE(store.isDirty(calibrationId));
+    TEST_ASSERT_TRUE(store.poll(150));
+    TEST_ASSERT_EQUAL_UINT32(1, calibration.saves);
+    calibration.fail = false;
+    TEST_ASSERT_TRUE(store.poll(200));
+    TEST_ASSERT_EQUAL_UINT32(2, calibration.saves);
+    TEST_ASSERT_EQUAL_UINT32(1, store.at(calibrationId)->failures);
+    TEST_ASSERT_FALSE(store.isDirty(calibrationId));
+
+    // A change that arrives while the file is being written stays dirty
+    filter.store = &store;
+    filter.id = filterId;
+    store.markDirty(filterId, 300);
+    TEST_ASSERT_TRUE(store.poll(400));
+    TEST_ASSERT_EQUAL_UINT32(1, filter.saves);
+    TEST_ASSERT_TRUE(store.isDirty(filterId));
+
+    // flush(): both written at once, quiet period or not
+    store.markDirty(calibrationId, 401);
+    TEST_ASSERT_EQUAL_UINT8(2, store.getPending());
+    TEST_ASSERT_EQUAL_UINT8(0, store.flush(402));
+    TEST_ASSERT_EQUAL_UINT32(2, filter.saves);
+    TEST_ASSERT_EQUAL_UINT32(3, calibration.saves);
+    TEST_ASSERT_EQUAL_UINT8(0, store.getPending());
+
+    StaticJsonWriter<256> json;
+    store.writeJson(json);
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"pending\":0,\"entries\":["
+        "{\"name\":\"log_filter\",\"dirty\":false,\"changes\":2,\"writes\":2,\"failures\":0},"
+        "{\"name\":\"calibration\",\"dirty\":false,\"changes\":2,\"writes\":2,\"failures\":1}]}",
+        json.c_str());
+}
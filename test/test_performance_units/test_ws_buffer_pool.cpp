@@ -0,0 +1,100 @@
+/**
+ * @file test_ws_buffer_pool.cpp
+ * @brief Unit tests for WsBufferPool (preallocated WebSocket send buffers)
+ *
+ * Tests validate:
+ * - The smallest fitting class serves a request; an exhausted class falls to the next
+ * - A buffer returns to the pool once every holder (client queue) released it
+ * - Exhaustion and oversized requests are counted as drops, without allocating
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/WsBufferPool.h"
+#include "../../src/utils/WsBufferPool.cpp"
+
+/**
+ * @brief UT-045: Size class selection, reuse after release, stable storage
+ */
+void test_ws_buffer_pool_classes_and_reuse() {
+    WsBufferPool pool;
+    TEST_ASSERT_FALSE(pool.isReady());
+    TEST_ASSERT_FALSE(pool.acquire(10));  // Not begun: nothing to hand out (a drop)
+    TEST_ASSERT_TRUE(pool.begin());
+    TEST_ASSERT_TRUE(pool.isReady());
+
+    WsBufferPool::Buffer line = pool.acquire(120);
+    TEST_ASSERT_TRUE(line != nullptr);
+    TEST_ASSERT_EQUAL(120, line->size());
+    TEST_ASSERT_TRUE(line->capacity() >= 256);
+    TEST_ASSERT_EQUAL_UINT8(1, pool.getInUse(WsBufferPool::SMALL));
+
+    WsBufferPool::Buffer batch = pool.acquire(1024);
+    TEST_ASSERT_TRUE(batch != nullptr);
+    TEST_ASSERT_EQUAL_UINT8(1, pool.getInUse(WsBufferPool::MEDIUM));
+    WsBufferPool::Buffer keyframe = pool.acquire(3000);
+    TEST_ASSERT_TRUE(keyframe != nullptr);
+    TEST_ASSERT_EQUAL_UINT8(1, pool.getInUse(WsBufferPool::LARGE));
+
+    // Two client queues share one buffer; it is free once both have sent it
+    const uint8_t* storage = line->data();
+    {
+        WsBufferPool::Buffer queued1 = line;
+        WsBufferPool::Buffer queued2 = line;
+        line.reset();
+        TEST_ASSERT_EQUAL_UINT8(1, pool.getInUse(WsBufferPool::SMALL));
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, pool.getInUse(WsBufferPool::SMALL));
+
+    // Reused without reallocating: same storage, resized to the new request
+    WsBufferPool::Buffer again = pool.acquire(200);
+    TEST_ASSERT_TRUE(again->data() == storage);
+    TEST_ASSERT_EQUAL(200, again->size());
+    TEST_ASSERT_EQUAL_UINT8(1, pool.getPeakInUse(WsBufferPool::SMALL));
+    TEST_ASSERT_EQUAL_UINT32(1, pool.getDropped());  // The request before begin()
+}
+
+/**
+ * @brief UT-046: Exhaustion moves up a class, then drops; JSON report
+ */
+void test_ws_buffer_pool_exhaustion_and_json() {
+    WsBufferPool pool;
+    pool.begin();
+
+    WsBufferPool::Buffer held[WsBufferPool::TOTAL_BUFFERS];
+    uint8_t count = 0;
+    for (uint8_t i = 0; i < WS_POOL_SMALL_BUFFERS; i++) {
+        held[count++] = pool.acquire(64);
+    }
+    TEST_ASSERT_EQUAL_UINT8(WS_POOL_SMALL_BUFFERS, pool.getInUse(WsBufferPool::SMALL));
+    TEST_ASSERT_EQUAL_UINT32(0, pool.getExhausted(WsBufferPool::SMALL));
+
+    // Small class full: a 1 KB buffer serves the next line
+    held[count++] = pool.acquire(64);
+    TEST_ASSERT_TRUE(held[count - 1] != nullptr);
+    TEST_ASSERT_EQUAL_UINT32(1, pool.getExhausted(WsBufferPool::SMALL));
+    TEST_ASSERT_EQUAL_UINT8(1, pool.getInUse(WsBufferPool::MEDIUM));
+
+    while (count < WsBufferPool::TOTAL_BUFFERS) {
+        held[count++] = pool.acquire(900);
+    }
+    TEST_ASSERT_EQUAL_UINT8(WS_POOL_LARGE_BUFFERS, pool.getInUse(WsBufferPool::LARGE));
+
+    // Everything queued: dropped, nothing allocated
+    TEST_ASSERT_FALSE(pool.acquire(64));
+    TEST_ASSERT_EQUAL_UINT32(1, pool.getDropped());
+    TEST_ASSERT_FALSE(pool.acquire(WsBufferPool::MAX_BYTES + 1));  // Never fits
+    TEST_ASSERT_EQUAL_UINT32(2, pool.getDropped());
+
+    held[0].reset();
+    TEST_ASSERT_TRUE(pool.acquire(64) != nullptr);
+
+    StaticJsonWriter<512> json;
+    pool.writeJson(json, nullptr);
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"classes\":[{\"bytes\":256,\"buffers\":8,\"in_use\":7,\"peak_in_use\":8,"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "{\"bytes\":4096,\"buffers\":4,\"in_use\":4,\"peak_in_use\":4,\"exhausted\":1}"));
+    TEST_ASSERT_NOT_NULL(strstr(json.c_str(), "],\"dropped\":2}"));
+}
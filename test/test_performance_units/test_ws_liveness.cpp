@@ -0,0 +1,134 @@
+/**
+ * @file test_ws_liveness.cpp
+ * @brief Unit tests for WsLiveness (WebSocket ping/pong eviction)
+ *
+ * Tests validate:
+ * - A client that answers pings (pong or data) is never reported; one silent for
+ *   WS_PING_MAX_MISSED intervals is closed, then aborted an interval later if still there
+ * - Clients are keyed by endpoint and ID, disconnects free the slot, a full table refuses
+ *   new clients, and the counters are reported as JSON
+ *
+ * @version 1.0.0
+ */
+
+#include <unity.h>
+#include <stdint.h>
+#include "../../src/utils/WsLiveness.h"
+#include "../../src/utils/WsLiveness.cpp"
+
+namespace {
+
+const uint32_t PING = WS_PING_INTERVAL_MS;
+const uint32_t LIMIT = WS_PING_INTERVAL_MS * WS_PING_MAX_MISSED;
+
+}  // namespace
+
+/**
+ * @brief UT-074: Silent clients are closed, then aborted; answering clients stay
+ */
+void test_ws_liveness_close_then_abort() {
+    WsLiveness liveness;
+    WsLivenessVerdict verdicts[WsLiveness::SLOTS];
+    uint8_t count;
+    const uint32_t t0 = 4000000000UL;   // Wraps during the test
+
+    TEST_ASSERT_TRUE(liveness.add(AdmissionEndpoint::BOATDATA, 1, t0));   // Answers
+    TEST_ASSERT_TRUE(liveness.add(AdmissionEndpoint::LOGS, 1, t0));       // Same ID, sleeps
+    TEST_ASSERT_EQUAL_UINT8(2, liveness.getCount());
+
+    uint32_t now = t0;
+    for (uint8_t tick = 1; tick < WS_PING_MAX_MISSED; tick++) {
+        now += PING;
+        liveness.seen(AdmissionEndpoint::BOATDATA, 1, now);
+        count = liveness.check(now, verdicts, WsLiveness::SLOTS);
+    TEST_ASSERT_EQUAL_UINT8(0, count);
+    }
+
+    now = t0 + LIMIT;
+    liveness.seen(AdmissionEndpoint::BOATDATA, 1, now);
+    count = liveness.check(now, verdicts, WsLiveness::SLOTS);
+    TEST_ASSERT_EQUAL_UINT8(1, count);
+    TEST_ASSERT_EQUAL(AdmissionEndpoint::LOGS, verdicts[0].endpoint);
+    TEST_ASSERT_EQUAL_UINT32(1, verdicts[0].id);
+    TEST_ASSERT_EQUAL(WsLivenessAction::CLOSE, verdicts[0].action);
+    TEST_ASSERT_EQUAL_UINT32(LIMIT, verdicts[0].silentMs);
+    TEST_ASSERT_EQUAL_UINT32(1, liveness.getEvicted());
+
+    // The close handshake gets one interval; half way nothing is reported again
+    count = liveness.check(now + PING / 2, verdicts, WsLiveness::SLOTS);
+    TEST_ASSERT_EQUAL_UINT8(0, count);
+
+    now += PING;
+    liveness.seen(AdmissionEndpoint::BOATDATA, 1, now);
+    count = liveness.check(now, verdicts, WsLiveness::SLOTS);
+    TEST_ASSERT_EQUAL_UINT8(1, count);
+    TEST_ASSERT_EQUAL(WsLivenessAction::ABORT, verdicts[0].action);
+    TEST_ASSERT_EQUAL_UINT32(1, liveness.getAborted());
+    TEST_ASSERT_EQUAL_UINT8(1, liveness.getCount());   // Freed by the abort
+
+    // The disconnect event of the aborted client finds nothing; the other client stays
+    liveness.remove(AdmissionEndpoint::LOGS, 1);
+    TEST_ASSERT_EQUAL_UINT8(1, liveness.getCount());
+    count = liveness.check(now + PING, verdicts, WsLiveness::SLOTS);
+    TEST_ASSERT_EQUAL_UINT8(0, count);
+
+    // A client closed and then heard from again is back to normal
+    TEST_ASSERT_TRUE(liveness.add(AdmissionEndpoint::SIGNALK, 7, now));
+    now += LIMIT;
+    liveness.seen(AdmissionEndpoint::BOATDATA, 1, now);
+    count = liveness.check(now, verdicts, WsLiveness::SLOTS);
+    TEST_ASSERT_EQUAL_UINT8(1, count);
+    TEST_ASSERT_EQUAL(WsLivenessAction::CLOSE, verdicts[0].action);
+    liveness.seen(AdmissionEndpoint::SIGNALK, 7, now + 1);
+    now += PING;
+    liveness.seen(AdmissionEndpoint::BOATDATA, 1, now);
+    count = liveness.check(now, verdicts, WsLiveness::SLOTS);
+    TEST_ASSERT_EQUAL_UINT8(0, count);
+    now += LIMIT;
+    liveness.seen(AdmissionEndpoint::BOATDATA, 1, now);
+    count = liveness.check(now, verdicts, WsLiveness::SLOTS);
+    TEST_ASSERT_EQUAL_UINT8(1, count);
+    TEST_ASSERT_EQUAL(WsLivenessAction::CLOSE, verdicts[0].action);   // Not an abort
+}
+
+/**
+ * @brief UT-075: Slots, keys, output limit and JSON
+ */
+void test_ws_liveness_slots_and_json() {
+    WsLiveness liveness;
+    WsLivenessVerdict verdicts[WsLiveness::SLOTS];
+    uint8_t count;
+
+    TEST_ASSERT_FALSE(liveness.add(AdmissionEndpoint::BOATDATA, 0, 0));   // Not a client ID
+    for (uint8_t i = 0; i < WsLiveness::SLOTS; i++) {
+        TEST_ASSERT_TRUE(liveness.add(AdmissionEndpoint::SIGNALK, 100 + i, 0));
+    }
+    TEST_ASSERT_FALSE(liveness.add(AdmissionEndpoint::SIGNALK, 999, 0));
+    TEST_ASSERT_EQUAL_UINT8(WsLiveness::SLOTS, liveness.getCount());
+
+    // Another endpoint's ID does not touch the slot
+    liveness.remove(AdmissionEndpoint::LOGS, 100);
+    liveness.seen(AdmissionEndpoint::LOGS, 101, LIMIT);
+    TEST_ASSERT_EQUAL_UINT8(WsLiveness::SLOTS, liveness.getCount());
+
+    // At most maxOut verdicts; the rest are reported by the next check
+    count = liveness.check(LIMIT, verdicts, 3);
+    TEST_ASSERT_EQUAL_UINT8(3, count);
+    count = liveness.check(LIMIT, verdicts, WsLiveness::SLOTS);
+    TEST_ASSERT_EQUAL_UINT8(WsLiveness::SLOTS - 3, count);
+    TEST_ASSERT_EQUAL_UINT32(WsLiveness::SLOTS, liveness.getEvicted());
+
+    liveness.remove(AdmissionEndpoint::SIGNALK, 100);
+    TEST_ASSERT_TRUE(liveness.add(AdmissionEndpoint::SIGNALK, 999, LIMIT));
+
+    StaticJsonWriter<160> json;
+    json.beginObject();
+    liveness.writeJson(json, "liveness");
+    json.endObject();
+    char expected[160];
+    snprintf(expected, sizeof(expected),
+             "{\"liveness\":{\"interval_ms\":%lu,\"max_missed\":%lu,\"watched\":%u,\"evicted\":%u,\"aborted\":0}}",
+             (unsigned long)WS_PING_INTERVAL_MS, (unsigned long)WS_PING_MAX_MISSED,
+             (unsigned)WsLiveness::SLOTS, (unsigned)WsLiveness::SLOTS);
+    TEST_ASSERT_EQUAL_STRING(expected, json.c_str());
+}
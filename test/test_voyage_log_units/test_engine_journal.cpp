@@ -0,0 +1,192 @@
+/**
+ * @file test_engine_journal.cpp
+ * @brief Unit tests for the engine and saildrive event journal (records, transitions, block index)
+ */
+
+#include <unity.h>
+#include <math.h>
+#include <string.h>
+#include "../../src/utils/ConfigRecord.h"
+#include "../../src/utils/ConfigRecord.cpp"
+#include "../../src/utils/EngineJournal.h"
+#include "../../src/utils/EngineJournal.cpp"
+
+namespace {
+
+void engineAt(BoatDataStructure& data, double rpm, double oilC) {
+    data.engine.available = true;
+    data.engine.engineRev = rpm;
+    data.engine.oilTemperature = oilC;
+}
+
+EngineJournalRecord utcRecord(uint32_t sequence, uint32_t time) {
+    EngineJournalRecord record;
+    memset(&record, 0, sizeof(record));
+    record.sequence = sequence;
+    record.time = time;
+    record.utc = true;
+    record.event = EngineJournalEvent::RPM_BAND;
+    return record;
+}
+
+}  // namespace
+
+void test_engine_journal_record_round_trip() {
+    EngineJournalRecord record;
+    record.sequence = 70000;
+    record.time = 1760451200;
+    record.utc = true;
+    record.event = EngineJournalEvent::OVERTEMP;
+    record.detail = 3;
+    record.rpm = 2450;
+    record.oilDeciC = -105;
+
+    uint8_t raw[ENGINE_JOURNAL_RECORD_SIZE];
+    EngineJournalEncode(record, raw);
+    EngineJournalRecord read;
+    TEST_ASSERT_TRUE(EngineJournalDecode(raw, read));
+    TEST_ASSERT_EQUAL_UINT32(70000, read.sequence);
+    TEST_ASSERT_EQUAL_UINT32(1760451200, read.time);
+    TEST_ASSERT_TRUE(read.utc);
+    TEST_ASSERT_EQUAL(static_cast<int>(EngineJournalEvent::OVERTEMP), static_cast<int>(read.event));
+    TEST_ASSERT_EQUAL_UINT8(3, read.detail);
+    TEST_ASSERT_EQUAL_UINT16(2450, read.rpm);
+    TEST_ASSERT_EQUAL_INT16(-105, read.oilDeciC);
+    TEST_ASSERT_EQUAL_STRING("overtemp", EngineJournalEventName(read.event));
+
+    // A torn write fails the CRC, zeroed and erased slots are empty
+    raw[5] ^= 0x01;
+    TEST_ASSERT_FALSE(EngineJournalDecode(raw, read));
+    memset(raw, 0, sizeof(raw));
+    TEST_ASSERT_FALSE(EngineJournalDecode(raw, read));
+    memset(raw, 0xFF, sizeof(raw));
+    TEST_ASSERT_FALSE(EngineJournalDecode(raw, read));
+
+    TEST_ASSERT_EQUAL_UINT16(0, EngineJournalSlot(1));
+    TEST_ASSERT_EQUAL_UINT16(0, EngineJournalSlot(ENGINE_JOURNAL_CAPACITY + 1));
+    TEST_ASSERT_EQUAL_UINT16(ENGINE_JOURNAL_CAPACITY - 1, EngineJournalSlot(ENGINE_JOURNAL_CAPACITY));
+}
+
+void test_engine_journal_rpm_band_hysteresis() {
+    TEST_ASSERT_EQUAL_UINT8(0, EngineJournalRpmBand(ENGINE_JOURNAL_RUNNING_RPM - 1, 0));
+    TEST_ASSERT_EQUAL_UINT8(1, EngineJournalRpmBand(ENGINE_JOURNAL_RUNNING_RPM, 0));
+    TEST_ASSERT_EQUAL_UINT8(4, EngineJournalRpmBand(ENGINE_JOURNAL_MAX_RPM + 100, 0));
+
+    // Down only past the hysteresis below the band edge
+    TEST_ASSERT_EQUAL_UINT8(2, EngineJournalRpmBand(ENGINE_JOURNAL_CRUISE_RPM - ENGINE_JOURNAL_RPM_HYSTERESIS / 2, 2));
+    TEST_ASSERT_EQUAL_UINT8(1, EngineJournalRpmBand(ENGINE_JOURNAL_CRUISE_RPM - ENGINE_JOURNAL_RPM_HYSTERESIS - 1, 2));
+    TEST_ASSERT_EQUAL_UINT8(0, EngineJournalRpmBand(0, 4));
+}
+
+void test_engine_journal_records_transitions_only() {
+    EngineJournal journal;
+    journal.start(41, 100, false);
+    TEST_ASSERT_EQUAL_UINT8(1, journal.pending());
+    TEST_ASSERT_EQUAL(static_cast<int>(EngineJournalEvent::BOOT), static_cast<int>(journal.peek(0).event));
+    TEST_ASSERT_EQUAL_UINT32(41, journal.peek(0).sequence);
+
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    TEST_ASSERT_EQUAL_UINT8(0, journal.observe(data, 101, false));  // Nothing known yet
+
+    engineAt(data, 850, 40.0);
+    TEST_ASSERT_EQUAL_UINT8(1, journal.observe(data, 110, true));
+    const EngineJournalRecord& start = journal.peek(1);
+    TEST_ASSERT_EQUAL(static_cast<int>(EngineJournalEvent::ENGINE_START), static_cast<int>(start.event));
+    TEST_ASSERT_EQUAL_UINT8(1, start.detail);
+    TEST_ASSERT_EQUAL_UINT16(850, start.rpm);
+    TEST_ASSERT_EQUAL_INT16(400, start.oilDeciC);
+    TEST_ASSERT_TRUE(start.utc);
+
+    // Samples within the band add nothing
+    for (int i = 0; i < 20; i++) {
+        engineAt(data, 800 + i * 10, 41.0);
+        TEST_ASSERT_EQUAL_UINT8(0, journal.observe(data, 111 + i, true));
+    }
+
+    engineAt(data, 1800, 96.0);
+    TEST_ASSERT_EQUAL_UINT8(2, journal.observe(data, 200, true));  // Cruise band, overtemperature
+    TEST_ASSERT_EQUAL(static_cast<int>(EngineJournalEvent::RPM_BAND), static_cast<int>(journal.peek(2).event));
+    TEST_ASSERT_EQUAL_UINT8(2, journal.peek(2).detail);
+    TEST_ASSERT_EQUAL(static_cast<int>(EngineJournalEvent::OVERTEMP), static_cast<int>(journal.peek(3).event));
+
+    engineAt(data, 1800, ENGINE_JOURNAL_OVERTEMP_C - 1.0);
+    TEST_ASSERT_EQUAL_UINT8(0, journal.observe(data, 210, true));   // Within the hysteresis
+    engineAt(data, 1800, ENGINE_JOURNAL_OVERTEMP_C - ENGINE_JOURNAL_OVERTEMP_HYSTERESIS_C - 1.0);
+    TEST_ASSERT_EQUAL_UINT8(1, journal.observe(data, 220, true));
+    TEST_ASSERT_EQUAL(static_cast<int>(EngineJournalEvent::OVERTEMP_CLEARED), static_cast<int>(journal.peek(4).event));
+
+    // Saildrive: first report recorded, a dropout keeps the last position
+    data.saildrive.available = true;
+    data.saildrive.saildriveEngaged = true;
+    TEST_ASSERT_EQUAL_UINT8(1, journal.observe(data, 230, true));
+    data.saildrive.available = false;
+    data.saildrive.saildriveEngaged = false;
+    TEST_ASSERT_EQUAL_UINT8(0, journal.observe(data, 231, true));
+    data.saildrive.available = true;
+    data.saildrive.saildriveEngaged = true;
+    TEST_ASSERT_EQUAL_UINT8(0, journal.observe(data, 232, true));
+
+    // Engine data lost while running: a stop with detail 1
+    data.engine.available = false;
+    TEST_ASSERT_EQUAL_UINT8(1, journal.observe(data, 240, true));
+    const EngineJournalRecord& stop = journal.peek(6);
+    TEST_ASSERT_EQUAL(static_cast<int>(EngineJournalEvent::ENGINE_STOP), static_cast<int>(stop.event));
+    TEST_ASSERT_EQUAL_UINT8(1, stop.detail);
+    TEST_ASSERT_EQUAL_UINT16(1800, stop.rpm);  // Last reading kept
+    TEST_ASSERT_EQUAL_UINT32(47, stop.sequence);
+    TEST_ASSERT_EQUAL_UINT8(0, journal.getBand());
+
+    // Written records leave the queue, the sequence continues
+    journal.release(5);
+    TEST_ASSERT_EQUAL_UINT8(2, journal.pending());
+    TEST_ASSERT_EQUAL_UINT32(46, journal.peek(0).sequence);
+    TEST_ASSERT_EQUAL_UINT32(48, journal.getNextSequence());
+    TEST_ASSERT_EQUAL_UINT32(7, journal.getRecorded());
+}
+
+void test_engine_journal_full_queue_drops_and_counts() {
+    EngineJournal journal;
+    journal.start(1, 0, false);
+    BoatDataStructure data;
+    memset(&data, 0, sizeof(data));
+    data.engine.oilTemperature = NAN;
+
+    for (int i = 0; i < ENGINE_JOURNAL_PENDING; i++) {
+        engineAt(data, (i % 2) ? 0 : 850, NAN);  // Start / stop
+        journal.observe(data, static_cast<uint32_t>(i), false);
+    }
+    TEST_ASSERT_EQUAL_UINT8(ENGINE_JOURNAL_PENDING, journal.pending());
+    TEST_ASSERT_EQUAL_UINT32(1, journal.getDropped());
+    TEST_ASSERT_EQUAL_INT16(ENGINE_JOURNAL_NO_TEMPERATURE, journal.peek(1).oilDeciC);
+
+    // The state is still tracked: no duplicate start once there is room again
+    journal.release(ENGINE_JOURNAL_PENDING);
+    engineAt(data, 0, NAN);
+    TEST_ASSERT_EQUAL_UINT8(0, journal.observe(data, 100, false));
+}
+
+void test_engine_journal_index_rules_out_blocks() {
+    EngineJournalIndex index;
+    TEST_ASSERT_FALSE(index.overlaps(0, 0, UINT32_MAX));
+
+    for (uint32_t sequence = 1; sequence <= ENGINE_JOURNAL_BLOCK_RECORDS * 2; sequence++) {
+        index.note(utcRecord(sequence, 1000 + sequence * 10));
+    }
+    TEST_ASSERT_TRUE(index.overlaps(0, 1000, 1010));
+    TEST_ASSERT_FALSE(index.overlaps(0, 1000 + (ENGINE_JOURNAL_BLOCK_RECORDS + 1) * 10, UINT32_MAX));
+    TEST_ASSERT_TRUE(index.overlaps(1, 1000 + (ENGINE_JOURNAL_BLOCK_RECORDS + 1) * 10, UINT32_MAX));
+    TEST_ASSERT_FALSE(index.overlaps(2, 0, UINT32_MAX));
+    TEST_ASSERT_FALSE(index.overlaps(ENGINE_JOURNAL_BLOCKS, 0, UINT32_MAX));
+
+    // The next lap restarts block 0 at its first slot
+    index.note(utcRecord(ENGINE_JOURNAL_CAPACITY + 1, 900000));
+    TEST_ASSERT_FALSE(index.overlaps(0, 1000, 2000));
+    TEST_ASSERT_TRUE(index.overlaps(0, 900000, 900000));
+
+    // Records without UTC never match a time range
+    EngineJournalRecord boot = utcRecord(ENGINE_JOURNAL_BLOCK_RECORDS * 2 + 1, 5);
+    boot.utc = false;
+    index.note(boot);
+    TEST_ASSERT_FALSE(index.overlaps(2, 0, UINT32_MAX));
+}
@@ -0,0 +1,58 @@
+/**
+ * @file test_main.cpp
+ * @brief Unit tests for the voyage recorder segment format
+ *
+ * Tests validate:
+ * - VoyageLogFormat (segment header, index and footer, KEY and DELTA
+ *   records, wrapped field deltas, incomplete/corrupt input detection)
+ * - EngineJournal (16-byte records, transition detection with hysteresis,
+ *   full queue, ring file block index)
+ *
+ * Test Organization:
+ * - test_voyage_log_format.cpp: encode/decode round trips and error cases
+ * - test_engine_journal.cpp: engine and saildrive event journal
+ */
+
+#include <unity.h>
+
+// Forward declarations for voyage log format tests
+void test_voyage_header_and_trailer_round_trip();
+void test_voyage_key_then_delta_round_trip();
+void test_voyage_delta_sizes();
+void test_voyage_keyframe_interval_and_reset();
+void test_voyage_incomplete_and_corrupt_records();
+
+// Forward declarations for engine journal tests
+void test_engine_journal_record_round_trip();
+void test_engine_journal_rpm_band_hysteresis();
+void test_engine_journal_records_transitions_only();
+void test_engine_journal_full_queue_drops_and_counts();
+void test_engine_journal_index_rules_out_blocks();
+
+void setUp() {
+    // Set up before each test
+}
+
+void tearDown() {
+    // Clean up after each test
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+
+    // Voyage log format tests
+    RUN_TEST(test_voyage_header_and_trailer_round_trip);
+    RUN_TEST(test_voyage_key_then_delta_round_trip);
+    RUN_TEST(test_voyage_delta_sizes);
+    RUN_TEST(test_voyage_keyframe_interval_and_reset);
+    RUN_TEST(test_voyage_incomplete_and_corrupt_records);
+
+    // Engine journal tests
+    RUN_TEST(test_engine_journal_record_round_trip);
+    RUN_TEST(test_engine_journal_rpm_band_hysteresis);
+    RUN_TEST(test_engine_journal_records_transitions_only);
+    RUN_TEST(test_engine_journal_full_queue_drops_and_counts);
+    RUN_TEST(test_engine_journal_index_rules_out_blocks);
+
+    return UNITY_END();
+}
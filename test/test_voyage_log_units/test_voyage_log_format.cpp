@@ -0,0 +1,203 @@
+/**
+ * @file test_voyage_log_format.cpp
+ * @brief Unit tests for VoyageLogFormat segments (delta-compressed BoatDataSnapshot records)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/VoyageLogFormat.h"
+#include "../../src/utils/VoyageLogFormat.cpp"
+
+namespace {
+
+/// Under way: GPS, compass, wind and derived values set
+BoatDataSnapshot underWay(uint32_t nowMs) {
+    BoatDataSnapshot s;
+    memset(&s, 0, sizeof(s));
+    s.version = BOATDATA_SNAPSHOT_VERSION;
+    s.present = BoatDataGroup::GPS | BoatDataGroup::COMPASS | BoatDataGroup::WIND | BoatDataGroup::DERIVED;
+    s.timestampMs = nowMs;
+    s.latitude = 481173000;
+    s.longitude = -1151667000;
+    s.cog = 14740;
+    s.sog = 650;
+    s.trueHeading = 62800;  // Just below 2 pi
+    s.apparentWindAngle = -7854;
+    s.apparentWindSpeed = 1420;
+    s.tws = 1100;
+    s.twsAvg1m = 1080;
+    return s;
+}
+
+}  // namespace
+
+void test_voyage_header_and_trailer_round_trip() {
+    uint8_t header[VOYAGE_LOG_HEADER_SIZE];
+    TEST_ASSERT_EQUAL(0, VoyageLogWriteHeader(header, sizeof(header) - 1, 7, 1000));
+    TEST_ASSERT_EQUAL(VOYAGE_LOG_HEADER_SIZE, VoyageLogWriteHeader(header, sizeof(header), 7, 123456));
+
+    VoyageLogHeader read;
+    TEST_ASSERT_TRUE(VoyageLogReadHeader(header, sizeof(header), read));
+    TEST_ASSERT_EQUAL_UINT32(7, read.sequence);
+    TEST_ASSERT_EQUAL_UINT32(123456, read.startMs);
+    TEST_ASSERT_EQUAL_UINT8(BOATDATA_SNAPSHOT_VERSION, read.snapshotVersion);
+    TEST_ASSERT_FALSE(VoyageLogReadHeader(header, sizeof(header) - 1, read));
+    header[4] = VOYAGE_LOG_VERSION + 1;
+    TEST_ASSERT_FALSE(VoyageLogReadHeader(header, sizeof(header), read));
+
+    // Index then footer, read back from the end of the "file"
+    const VoyageLogIndexEntry entries[3] = {{16, 1000}, {900, 61000}, {1810, 121000}};
+    uint8_t trailer[VOYAGE_LOG_TRAILER_SIZE(3)];
+    TEST_ASSERT_EQUAL(0, VoyageLogWriteTrailer(trailer, sizeof(trailer) - 1, entries, 3));
+    TEST_ASSERT_EQUAL(sizeof(trailer), VoyageLogWriteTrailer(trailer, sizeof(trailer), entries, 3));
+
+    uint32_t count = 0;
+    TEST_ASSERT_TRUE(VoyageLogReadFooter(trailer, sizeof(trailer), count));
+    TEST_ASSERT_EQUAL_UINT32(3, count);
+    for (uint32_t i = 0; i < count; i++) {
+        VoyageLogIndexEntry entry = VoyageLogReadIndexEntry(trailer + i * VOYAGE_LOG_INDEX_ENTRY_SIZE);
+        TEST_ASSERT_EQUAL_UINT32(entries[i].offset, entry.offset);
+        TEST_ASSERT_EQUAL_UINT32(entries[i].timestampMs, entry.timestampMs);
+    }
+
+    // An unclosed segment (records up to the end) has no footer
+    TEST_ASSERT_FALSE(VoyageLogReadFooter(header, sizeof(header), count));
+    uint8_t empty[VOYAGE_LOG_TRAILER_SIZE(0)];
+    TEST_ASSERT_EQUAL(VOYAGE_LOG_FOOTER_SIZE, VoyageLogWriteTrailer(empty, sizeof(empty), nullptr, 0));
+    TEST_ASSERT_TRUE(VoyageLogReadFooter(empty, sizeof(empty), count));
+    TEST_ASSERT_EQUAL_UINT32(0, count);
+}
+
+void test_voyage_key_then_delta_round_trip() {
+    VoyageLogEncoder encoder(30);
+    VoyageLogDecoder decoder;
+    uint8_t buf[4 * VOYAGE_LOG_MAX_RECORD];
+    size_t length = 0;
+
+    BoatDataSnapshot records[3] = {underWay(1000), underWay(2000), underWay(3000)};
+    records[1].latitude += 32;
+    records[1].longitude -= 51;
+    records[1].trueHeading = 60;             // Crossed north: wrapped delta
+    records[2] = records[1];
+    records[2].timestampMs = 3000;
+    records[2].apparentWindAngle = 7854;     // Tacked
+    records[2].flags = BoatDataSnapshotFlag::SHORE_POWER_ON;
+    records[2].present = 0;                  // Every group gone at once
+
+    for (const BoatDataSnapshot& r : records) {
+        size_t n = encoder.encode(r, buf + length, sizeof(buf) - length);
+        TEST_ASSERT_TRUE(n > 0);
+        length += n;
+    }
+    TEST_ASSERT_EQUAL(VoyageLogRecordType::KEY, (VoyageLogRecordType)buf[0]);
+    TEST_ASSERT_EQUAL(VoyageLogRecordType::DELTA, (VoyageLogRecordType)buf[1 + sizeof(BoatDataSnapshot)]);
+
+    size_t pos = 0;
+    for (const BoatDataSnapshot& r : records) {
+        BoatDataSnapshot out;
+        int32_t used = decoder.decode(buf + pos, length - pos, out);
+        TEST_ASSERT_TRUE(used > 0);
+        pos += static_cast<size_t>(used);
+        TEST_ASSERT_EQUAL_MEMORY(&r, &out, sizeof(BoatDataSnapshot));
+    }
+    TEST_ASSERT_EQUAL(length, pos);
+}
+
+void test_voyage_delta_sizes() {
+    VoyageLogEncoder encoder(30);
+    uint8_t buf[VOYAGE_LOG_MAX_RECORD];
+    BoatDataSnapshot s = underWay(1000);
+    TEST_ASSERT_EQUAL(1 + sizeof(BoatDataSnapshot), encoder.encode(s, buf, sizeof(buf)));
+
+    // Nothing changed but the time: tag + 2-byte delta (1000 ms) + empty block mask
+    s.timestampMs += 1000;
+    TEST_ASSERT_EQUAL(1 + 2 + 1, encoder.encode(s, buf, sizeof(buf)));
+
+    // latitude +32 (zigzag 64: 1 byte) and longitude -100 (zigzag 199: 2 bytes), same block
+    s.timestampMs += 1000;
+    s.latitude += 32;
+    s.longitude -= 100;
+    TEST_ASSERT_EQUAL(1 + 2 + 1 + 1 + 1 + 2, encoder.encode(s, buf, sizeof(buf)));
+
+    // Heading 6.28 -> 0.006 rad: a 2-byte step of +2796 around north, not a 3-byte jump of -62740
+    s.timestampMs += 1000;
+    s.trueHeading = 60;
+    TEST_ASSERT_EQUAL(1 + 2 + 1 + 1 + 2, encoder.encode(s, buf, sizeof(buf)));
+
+    // Every field changed: still within VOYAGE_LOG_MAX_RECORD, refused by a short buffer
+    s.timestampMs += 1000;
+    memset(reinterpret_cast<uint8_t*>(&s) + 1, 0x5A, sizeof(s) - 1);
+    s.timestampMs = 5000;
+    uint8_t small[16];
+    TEST_ASSERT_EQUAL(0, encoder.encode(s, small, sizeof(small)));
+    size_t n = encoder.encode(s, buf, sizeof(buf));
+    TEST_ASSERT_TRUE(n > sizeof(BoatDataSnapshot) / 2);
+    TEST_ASSERT_TRUE(n <= VOYAGE_LOG_MAX_RECORD);
+}
+
+void test_voyage_keyframe_interval_and_reset() {
+    VoyageLogEncoder encoder(3);
+    uint8_t buf[VOYAGE_LOG_MAX_RECORD];
+    BoatDataSnapshot s = underWay(0);
+
+    // KEY, DELTA, DELTA, KEY, ...
+    for (uint8_t i = 0; i < 7; i++) {
+        bool expectKey = (i % 3) == 0;
+        TEST_ASSERT_EQUAL(expectKey, encoder.nextIsKeyframe());
+        s.timestampMs += 1000;
+        encoder.encode(s, buf, sizeof(buf));
+        TEST_ASSERT_EQUAL(expectKey ? VoyageLogRecordType::KEY : VoyageLogRecordType::DELTA,
+                          (VoyageLogRecordType)buf[0]);
+    }
+
+    // A refused keyframe is retried; reset() forces one (dropped record, new segment)
+    VoyageLogEncoder fresh(3);
+    TEST_ASSERT_EQUAL(0, fresh.encode(s, buf, sizeof(BoatDataSnapshot)));
+    TEST_ASSERT_TRUE(fresh.nextIsKeyframe());
+    fresh.encode(s, buf, sizeof(buf));
+    TEST_ASSERT_FALSE(fresh.nextIsKeyframe());
+    fresh.reset();
+    TEST_ASSERT_TRUE(fresh.nextIsKeyframe());
+}
+
+void test_voyage_incomplete_and_corrupt_records() {
+    VoyageLogEncoder encoder(30);
+    VoyageLogDecoder decoder;
+    uint8_t key[VOYAGE_LOG_MAX_RECORD];
+    uint8_t delta[VOYAGE_LOG_MAX_RECORD];
+    BoatDataSnapshot s = underWay(1000);
+    size_t keyLength = encoder.encode(s, key, sizeof(key));
+    s.timestampMs = 2000;
+    s.sog += 3;
+    s.gust10m = 2000;
+    size_t deltaLength = encoder.encode(s, delta, sizeof(delta));
+    BoatDataSnapshot out;
+
+    // A DELTA without a preceding KEY cannot be decoded
+    TEST_ASSERT_EQUAL(-1, decoder.decode(delta, deltaLength, out));
+
+    // Every prefix asks for more data and leaves the state untouched
+    for (size_t i = 0; i < keyLength; i++) {
+        TEST_ASSERT_EQUAL(0, decoder.decode(key, i, out));
+    }
+    TEST_ASSERT_EQUAL((int32_t)keyLength, decoder.decode(key, keyLength, out));
+    for (size_t i = 0; i < deltaLength; i++) {
+        TEST_ASSERT_EQUAL(0, decoder.decode(delta, i, out));
+    }
+    TEST_ASSERT_EQUAL((int32_t)deltaLength, decoder.decode(delta, deltaLength, out));
+    TEST_ASSERT_EQUAL_MEMORY(&s, &out, sizeof(s));
+
+    // Unknown record type, KEY of another snapshot version, field beyond the last one
+    uint8_t bad[1] = {0x07};
+    TEST_ASSERT_EQUAL(-1, decoder.decode(bad, sizeof(bad), out));
+    key[1] = BOATDATA_SNAPSHOT_VERSION + 1;
+    TEST_ASSERT_EQUAL(-1, decoder.decode(key, keyLength, out));
+    key[1] = BOATDATA_SNAPSHOT_VERSION;
+    TEST_ASSERT_EQUAL((int32_t)keyLength, decoder.decode(key, keyLength, out));
+    uint8_t extraField[5] = {0x02, 0x00, 0x80, 0x04, 0x00};  // Field 58 of block 7
+    TEST_ASSERT_EQUAL(-1, decoder.decode(extraField, sizeof(extraField), out));
+
+    // Delta varint that never terminates
+    uint8_t endless[8] = {0x02, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80};
+    TEST_ASSERT_EQUAL(-1, decoder.decode(endless, sizeof(endless), out));
+}
@@ -0,0 +1,113 @@
+/**
+ * @file test_crash_log_ring.cpp
+ * @brief Unit tests for CrashLogRing (reset-surviving log records)
+ *
+ * A "reset" is simulated by constructing a second CrashLogRing over the
+ * same CrashLogStorage, as happens with the RTC memory on the target.
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <stdio.h>
+#include "../../src/utils/CrashLogRing.h"
+#include "../../src/utils/CrashLogRing.cpp"
+
+/**
+ * @brief Power-on garbage is detected and discarded
+ */
+void test_crash_ring_garbage_storage_discarded() {
+    CrashLogStorage storage;
+    memset(&storage, 0xA5, sizeof(storage));
+
+    CrashLogRing ring(storage);
+    TEST_ASSERT_EQUAL_UINT16(0, ring.getPreviousCount());
+    TEST_ASSERT_EQUAL_UINT32(CrashLogRing::MAGIC, storage.magic);
+    TEST_ASSERT_EQUAL_UINT32(0, storage.count);
+}
+
+/**
+ * @brief Records written before a reset are recovered in order
+ */
+void test_crash_ring_survives_reset() {
+    CrashLogStorage storage;
+    memset(&storage, 0, sizeof(storage));
+
+    {
+        CrashLogRing ring(storage);
+        ring.record(1, "WiFiManager", "CONNECTION_SUCCESS", 100);
+        ring.record(0, "NMEA2000", "PGN_RECEIVED", 150);  // Below min level - not kept
+        ring.record(2, "NMEA0183", "WRONG_TALKER_REJECTED", 200);
+        TEST_ASSERT_EQUAL_UINT16(0, ring.getPreviousCount());
+    }
+
+    CrashLogRing afterReset(storage);
+    TEST_ASSERT_EQUAL_UINT16(2, afterReset.getPreviousCount());
+    TEST_ASSERT_EQUAL_UINT32(100, afterReset.getPrevious(0).timestamp);
+    TEST_ASSERT_EQUAL_STRING("WiFiManager", afterReset.getPrevious(0).component);
+    TEST_ASSERT_EQUAL_STRING("CONNECTION_SUCCESS", afterReset.getPrevious(0).event);
+    TEST_ASSERT_EQUAL_UINT8(2, afterReset.getPrevious(1).level);
+    TEST_ASSERT_EQUAL_STRING("WRONG_TALKER_REJECTED", afterReset.getPrevious(1).event);
+
+    // Storage starts over for the new boot
+    CrashLogRing secondReset(storage);
+    TEST_ASSERT_EQUAL_UINT16(0, secondReset.getPreviousCount());
+}
+
+/**
+ * @brief A wrapped ring keeps the newest CAPACITY records, oldest first
+ */
+void test_crash_ring_wraps_keeping_newest() {
+    CrashLogStorage storage;
+    memset(&storage, 0, sizeof(storage));
+
+    {
+        CrashLogRing ring(storage);
+        char event[16];
+        for (uint32_t i = 0; i < CrashLogRing::CAPACITY + 5; i++) {
+            snprintf(event, sizeof(event), "EVENT_%u", (unsigned)i);
+            ring.record(1, "Test", event, i);
+        }
+    }
+
+    CrashLogRing afterReset(storage);
+    TEST_ASSERT_EQUAL_UINT16(CrashLogRing::CAPACITY, afterReset.getPreviousCount());
+    TEST_ASSERT_EQUAL_UINT32(5, afterReset.getPrevious(0).timestamp);
+    TEST_ASSERT_EQUAL_UINT32(CrashLogRing::CAPACITY + 4,
+                             afterReset.getPrevious(CrashLogRing::CAPACITY - 1).timestamp);
+}
+
+/**
+ * @brief Corrupted header (e.g. reset mid-update) discards the ring
+ */
+void test_crash_ring_corrupt_header_discarded() {
+    CrashLogStorage storage;
+    memset(&storage, 0, sizeof(storage));
+
+    {
+        CrashLogRing ring(storage);
+        ring.record(3, "Main", "WATCHDOG", 42);
+    }
+    storage.count++;  // Header no longer matches its check word
+
+    CrashLogRing afterReset(storage);
+    TEST_ASSERT_EQUAL_UINT16(0, afterReset.getPreviousCount());
+}
+
+/**
+ * @brief Names longer than the record fields are truncated, not overflowed
+ */
+void test_crash_ring_truncates_long_names() {
+    CrashLogStorage storage;
+    memset(&storage, 0, sizeof(storage));
+
+    {
+        CrashLogRing ring(storage);
+        ring.record(1, "AComponentNameThatIsWayTooLong",
+                    "AN_EVENT_NAME_THAT_IS_LONGER_THAN_THE_FIELD", 1);
+    }
+
+    CrashLogRing afterReset(storage);
+    TEST_ASSERT_EQUAL_UINT16(1, afterReset.getPreviousCount());
+    TEST_ASSERT_EQUAL_size_t(CrashLogEntry::COMPONENT_SIZE - 1, strlen(afterReset.getPrevious(0).component));
+    TEST_ASSERT_EQUAL_size_t(CrashLogEntry::EVENT_SIZE - 1, strlen(afterReset.getPrevious(0).event));
+}
@@ -0,0 +1,118 @@
+/**
+ * @file test_json_writer.cpp
+ * @brief Unit tests for JsonWriter (fixed-buffer streaming JSON)
+ */
+
+#include <unity.h>
+#include <math.h>
+#include "../../src/utils/JsonWriter.h"
+#include "../../src/utils/JsonWriter.cpp"
+
+/**
+ * @brief Typed members are separated and formatted correctly
+ */
+void test_json_writer_typed_members() {
+    StaticJsonWriter<128> json;
+    json.beginObject()
+        .add("ssid", "Boat")
+        .add("attempt", 2)
+        .add("uptime", 4000000000UL)
+        .add("offset", -3L)
+        .add("success", false)
+        .add("heading", 1.23456, 3)
+        .endObject();
+
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"ssid\":\"Boat\",\"attempt\":2,\"uptime\":4000000000,\"offset\":-3,\"success\":false,\"heading\":1.235}",
+        json.c_str());
+    TEST_ASSERT_EQUAL_size_t(strlen(json.c_str()), json.length());
+}
+
+/**
+ * @brief Nested objects and arrays get separators at every level
+ */
+void test_json_writer_nesting() {
+    StaticJsonWriter<128> json;
+    json.beginObject()
+        .beginArray("networks")
+            .beginObject().add("ssid", "A").add("priority", 1).endObject()
+            .beginObject().add("ssid", "B").add("priority", 2).endObject()
+        .endArray()
+        .beginObject("filter").add("level", "INFO").endObject()
+        .beginArray("empty").endArray()
+        .endObject();
+
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"networks\":[{\"ssid\":\"A\",\"priority\":1},{\"ssid\":\"B\",\"priority\":2}],"
+        "\"filter\":{\"level\":\"INFO\"},\"empty\":[]}",
+        json.c_str());
+}
+
+/**
+ * @brief Quotes, backslashes and control characters are escaped
+ */
+void test_json_writer_escapes_strings() {
+    StaticJsonWriter<96> json;
+    json.beginObject().add("ssid", "My \"Boat\"\\\n\x01").add("none", static_cast<const char*>(nullptr)).endObject();
+
+    TEST_ASSERT_EQUAL_STRING("{\"ssid\":\"My \\\"Boat\\\"\\\\\\n\\u0001\",\"none\":null}", json.c_str());
+}
+
+/**
+ * @brief Raw values are copied verbatim; NaN/Inf become null
+ */
+void test_json_writer_raw_and_non_finite() {
+    StaticJsonWriter<96> json;
+    json.beginObject()
+        .addRaw("data", "{\"a\":1}")
+        .add("nan", NAN)
+        .add("inf", INFINITY, 1)
+        .endObject()
+        .appendRaw("\n");
+
+    TEST_ASSERT_EQUAL_STRING("{\"data\":{\"a\":1},\"nan\":null,\"inf\":null}\n", json.c_str());
+}
+
+/**
+ * @brief Overflow is reported, output stays terminated and in bounds
+ */
+void test_json_writer_overflow_detected() {
+    char buffer[16];
+    memset(buffer, 'x', sizeof(buffer));
+    JsonWriter json(buffer, 12);
+    json.beginObject().add("component", "NMEA2000").endObject();
+
+    TEST_ASSERT_TRUE(json.overflowed());
+    TEST_ASSERT_TRUE(json.length() < 12);
+    TEST_ASSERT_EQUAL_size_t(json.length(), strlen(buffer));
+    TEST_ASSERT_EQUAL('x', buffer[12]);
+
+    json.reset();
+    json.beginObject().endObject();
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_EQUAL_STRING("{}", json.c_str());
+}
+
+/**
+ * @brief Fixed-precision numbers: rounding, padding, sign, and the printf fallback
+ */
+void test_json_writer_fixed_precision() {
+    StaticJsonWriter<192> json;
+    json.beginArray()
+        .add(59.123456789012, 6)
+        .add(1.05, 2)
+        .add(-0.9996, 3)
+        .add(-0.001, 2)
+        .add(0.0, 0)
+        .add(2.5, 0)
+        .add(-12.34567, 4)
+        .add(1e18, 1)
+        .add(3.14159, 12)
+        .endArray();
+
+    TEST_ASSERT_FALSE(json.overflowed());
+    TEST_ASSERT_EQUAL_STRING(
+        "[59.123457,1.05,-1.000,0.00,0,3,-12.3457,1000000000000000000.0,3.141590000000]",
+        json.c_str());
+}
@@ -0,0 +1,112 @@
+/**
+ * @file test_log_filter.cpp
+ * @brief Unit tests for LogFilter (precompiled component set + event prefix trie)
+ */
+
+#include <unity.h>
+#include "../../src/utils/LogFilter.h"
+#include "../../src/utils/LogFilter.cpp"
+
+/**
+ * @brief Default filter passes INFO and above for every component/event
+ */
+void test_filter_defaults_match_all_at_info() {
+    LogFilter filter;
+
+    TEST_ASSERT_TRUE(filter.matches(LogLevel::INFO, "NMEA2000", "PGN_RECEIVED"));
+    TEST_ASSERT_TRUE(filter.matches(LogLevel::ERROR, "WiFiManager", "CONNECTION_FAILED"));
+    TEST_ASSERT_FALSE(filter.matches(LogLevel::DEBUG, "NMEA2000", "PGN_RECEIVED"));
+}
+
+/**
+ * @brief Component terms match exactly, with surrounding whitespace ignored
+ */
+void test_filter_component_set_exact_match() {
+    LogFilter filter;
+    filter.setComponents("NMEA2000, OneWire ,GPS");
+
+    TEST_ASSERT_TRUE(filter.matchesComponent(LogLevel::INFO, "NMEA2000"));
+    TEST_ASSERT_TRUE(filter.matchesComponent(LogLevel::INFO, "OneWire"));
+    TEST_ASSERT_TRUE(filter.matchesComponent(LogLevel::INFO, "GPS"));
+    TEST_ASSERT_FALSE(filter.matchesComponent(LogLevel::INFO, "NMEA0183"));
+    TEST_ASSERT_FALSE(filter.matchesComponent(LogLevel::INFO, "NMEA"));
+    TEST_ASSERT_FALSE(filter.matchesComponent(LogLevel::INFO, nullptr));
+
+    // Raw string is kept verbatim for persistence
+    TEST_ASSERT_EQUAL_STRING("NMEA2000, OneWire ,GPS", filter.getComponents());
+}
+
+/**
+ * @brief Many component terms still resolve correctly (hash collisions probed)
+ */
+void test_filter_component_set_many_terms() {
+    LogFilter filter;
+    filter.setComponents("A,B,C,D,E,F,G,H,I,J,K,NMEA2000");
+
+    TEST_ASSERT_TRUE(filter.matchesComponent(LogLevel::INFO, "A"));
+    TEST_ASSERT_TRUE(filter.matchesComponent(LogLevel::INFO, "K"));
+    TEST_ASSERT_TRUE(filter.matchesComponent(LogLevel::INFO, "NMEA2000"));
+    TEST_ASSERT_FALSE(filter.matchesComponent(LogLevel::INFO, "L"));
+    TEST_ASSERT_FALSE(filter.matchesComponent(LogLevel::INFO, "AB"));
+}
+
+/**
+ * @brief Event terms match as prefixes via the trie
+ */
+void test_filter_event_prefix_trie() {
+    LogFilter filter;
+    filter.setEventPrefixes("PGN130306_,PGN1272, ERROR");
+
+    TEST_ASSERT_TRUE(filter.matchesEvent("PGN130306_UPDATE"));
+    TEST_ASSERT_TRUE(filter.matchesEvent("PGN127250_UPDATE"));
+    TEST_ASSERT_TRUE(filter.matchesEvent("PGN127258_NA"));
+    TEST_ASSERT_TRUE(filter.matchesEvent("ERROR"));
+    TEST_ASSERT_FALSE(filter.matchesEvent("PGN130316_UPDATE"));
+    TEST_ASSERT_FALSE(filter.matchesEvent("PGN127"));
+    TEST_ASSERT_FALSE(filter.matchesEvent("ERR"));
+    TEST_ASSERT_FALSE(filter.matchesEvent(nullptr));
+}
+
+/**
+ * @brief Shared prefixes and a shorter prefix of a longer term both work
+ */
+void test_filter_event_prefix_overlapping_terms() {
+    LogFilter filter;
+    filter.setEventPrefixes("PGN129029_UPDATE,PGN129");
+
+    TEST_ASSERT_TRUE(filter.matchesEvent("PGN129025_UPDATE"));
+    TEST_ASSERT_TRUE(filter.matchesEvent("PGN129029_UPDATE"));
+    TEST_ASSERT_FALSE(filter.matchesEvent("PGN128267_UPDATE"));
+}
+
+/**
+ * @brief Level, component and event checks combine; clear() restores defaults
+ */
+void test_filter_combined_and_clear() {
+    LogFilter filter;
+    filter.minLevel = LogLevel::DEBUG;
+    filter.setComponents("NMEA2000");
+    filter.setEventPrefixes("PGN130306_");
+
+    TEST_ASSERT_TRUE(filter.matches(LogLevel::DEBUG, "NMEA2000", "PGN130306_UPDATE"));
+    TEST_ASSERT_FALSE(filter.matches(LogLevel::DEBUG, "NMEA0183", "PGN130306_UPDATE"));
+    TEST_ASSERT_FALSE(filter.matches(LogLevel::DEBUG, "NMEA2000", "PGN129029_UPDATE"));
+
+    filter.clear();
+    TEST_ASSERT_TRUE(filter.matches(LogLevel::INFO, "NMEA0183", "SENTENCE_PROCESSED"));
+    TEST_ASSERT_FALSE(filter.matches(LogLevel::DEBUG, "NMEA0183", "SENTENCE_PROCESSED"));
+    TEST_ASSERT_EQUAL_STRING("", filter.getComponents());
+    TEST_ASSERT_EQUAL_STRING("", filter.getEventPrefixes());
+}
+
+/**
+ * @brief A list with only separators filters everything out (non-empty filter, no terms)
+ */
+void test_filter_separator_only_list_matches_nothing() {
+    LogFilter filter;
+    filter.setComponents(" , ,");
+    filter.setEventPrefixes(",");
+
+    TEST_ASSERT_FALSE(filter.matchesComponent(LogLevel::INFO, "NMEA2000"));
+    TEST_ASSERT_FALSE(filter.matchesEvent("PGN_RECEIVED"));
+}
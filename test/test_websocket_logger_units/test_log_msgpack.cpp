@@ -0,0 +1,104 @@
+/**
+ * @file test_log_msgpack.cpp
+ * @brief Unit tests for MsgPackWriter and LogNameTable (binary /logs encoding)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <stdio.h>
+#include "../../src/utils/LogMsgPack.h"
+#include "../../src/utils/LogMsgPack.cpp"
+
+/**
+ * @brief Integers use the smallest MessagePack representation
+ */
+void test_msgpack_integer_widths() {
+    uint8_t buffer[32];
+    MsgPackWriter out(buffer, sizeof(buffer));
+    out.integer(5).integer(200).integer(0x1234).integer(0x12345678);
+
+    const uint8_t expected[] = {
+        0x05,
+        0xCC, 200,
+        0xCD, 0x12, 0x34,
+        0xCE, 0x12, 0x34, 0x56, 0x78
+    };
+    TEST_ASSERT_FALSE(out.overflowed());
+    TEST_ASSERT_EQUAL_size_t(sizeof(expected), out.length());
+    TEST_ASSERT_EQUAL_MEMORY(expected, buffer, sizeof(expected));
+}
+
+/**
+ * @brief Record layout: fixarray, fixstr for short names, str8 for longer data, nil
+ */
+void test_msgpack_record_layout() {
+    uint8_t buffer[96];
+    MsgPackWriter out(buffer, sizeof(buffer));
+    const char* data = "{\"heading\":123.45,\"source\":\"NMEA2000\"}";  // 38 bytes -> str8
+    out.array(6).integer(1).integer(1000).integer(2).integer(3).str("PGN").str(data).nil();
+
+    TEST_ASSERT_FALSE(out.overflowed());
+    TEST_ASSERT_EQUAL_UINT8(0x96, buffer[0]);
+    TEST_ASSERT_EQUAL_UINT8(0x01, buffer[1]);
+    TEST_ASSERT_EQUAL_UINT8(0xCD, buffer[2]);  // 1000 = uint16
+    TEST_ASSERT_EQUAL_UINT8(0xA3, buffer[7]);  // fixstr "PGN"
+    TEST_ASSERT_EQUAL_MEMORY("PGN", &buffer[8], 3);
+    TEST_ASSERT_EQUAL_UINT8(0xD9, buffer[11]);
+    TEST_ASSERT_EQUAL_UINT8(strlen(data), buffer[12]);
+    TEST_ASSERT_EQUAL_UINT8(0xC0, buffer[out.length() - 1]);
+}
+
+/**
+ * @brief Overflow is flagged and nothing is written past the buffer
+ */
+void test_msgpack_overflow_detected() {
+    uint8_t buffer[8];
+    memset(buffer, 0xEE, sizeof(buffer));
+    MsgPackWriter out(buffer, 6);
+    out.array(2).str("too long for six bytes");
+
+    TEST_ASSERT_TRUE(out.overflowed());
+    TEST_ASSERT_TRUE(out.length() <= 6);
+    TEST_ASSERT_EQUAL_UINT8(0xEE, buffer[6]);
+}
+
+/**
+ * @brief Names get stable IDs in order of first use
+ */
+void test_name_table_interns_in_order() {
+    LogNameTable names;
+    bool added = false;
+
+    TEST_ASSERT_EQUAL_UINT8(0, names.intern("NMEA2000", added));
+    TEST_ASSERT_TRUE(added);
+    TEST_ASSERT_EQUAL_UINT8(1, names.intern("PGN_IGNORED", added));
+    TEST_ASSERT_TRUE(added);
+    TEST_ASSERT_EQUAL_UINT8(0, names.intern("NMEA2000", added));
+    TEST_ASSERT_FALSE(added);
+
+    TEST_ASSERT_EQUAL_UINT8(2, names.count());
+    TEST_ASSERT_EQUAL_STRING("PGN_IGNORED", names.name(1));
+    TEST_ASSERT_NULL(names.name(2));
+}
+
+/**
+ * @brief Full table and over-long names return NONE (sent as strings instead)
+ */
+void test_name_table_full_returns_none() {
+    LogNameTable names;
+    bool added = false;
+    char name[16];
+
+    for (uint8_t i = 0; i < LogNameTable::MAX_NAMES; i++) {
+        snprintf(name, sizeof(name), "NAME_%u", (unsigned)i);
+        TEST_ASSERT_EQUAL_UINT8(i, names.intern(name, added));
+    }
+
+    TEST_ASSERT_EQUAL_UINT8(LogNameTable::NONE, names.intern("ONE_TOO_MANY", added));
+    TEST_ASSERT_FALSE(added);
+    TEST_ASSERT_EQUAL_UINT8(3, names.intern("NAME_3", added));  // Existing names still resolve
+
+    LogNameTable fresh;
+    TEST_ASSERT_EQUAL_UINT8(LogNameTable::NONE,
+                            fresh.intern("A_NAME_THAT_IS_FAR_TOO_LONG_FOR_THE_TABLE_ENTRY", added));
+}
@@ -0,0 +1,56 @@
+/**
+ * @file test_log_names.cpp
+ * @brief Unit tests for the flash-resident log component/event name tables
+ */
+
+#include <unity.h>
+#include <string.h>
+#include "../../src/utils/LogNames.h"
+#include "../../src/utils/LogNames.cpp"
+#include "../../src/utils/CrashLogRing.h"
+
+/**
+ * @brief IDs resolve to the names sent on /logs
+ */
+void test_log_names_resolve_ids() {
+    TEST_ASSERT_EQUAL_STRING("NMEA2000", LogComponentName(LogComponent::NMEA2000));
+    TEST_ASSERT_EQUAL_STRING("WiFiManager", LogComponentName(LogComponent::WIFI_MANAGER));
+    TEST_ASSERT_EQUAL_STRING("PGN127251_UPDATE", LogEventName(LogEvent::PGN127251_UPDATE));
+    TEST_ASSERT_EQUAL_STRING("LOG_DROPPED", LogEventName(LogEvent::LOG_DROPPED));
+
+    // Resolving is a table lookup: the same flash string every time
+    TEST_ASSERT_EQUAL_PTR(LogEventName(LogEvent::LOG_DROPPED), LogEventName(LogEvent::LOG_DROPPED));
+}
+
+/**
+ * @brief Out-of-range IDs (e.g. a corrupt record) resolve to a placeholder
+ */
+void test_log_names_out_of_range() {
+    TEST_ASSERT_EQUAL_STRING("unknown", LogComponentName(LogComponent::COUNT));
+    TEST_ASSERT_EQUAL_STRING("unknown", LogComponentName(static_cast<LogComponent>(0xFF)));
+    TEST_ASSERT_EQUAL_STRING("unknown", LogEventName(LogEvent::COUNT));
+    TEST_ASSERT_EQUAL_STRING("unknown", LogEventName(static_cast<LogEvent>(0xFFFF)));
+}
+
+/**
+ * @brief Names are unique and fit the crash ring without truncation
+ */
+void test_log_names_unique_and_fit() {
+    const uint8_t components = static_cast<uint8_t>(LogComponent::COUNT);
+    for (uint8_t i = 0; i < components; i++) {
+        const char* name = LogComponentName(static_cast<LogComponent>(i));
+        TEST_ASSERT_TRUE_MESSAGE(strlen(name) < CrashLogEntry::COMPONENT_SIZE, name);
+        for (uint8_t j = i + 1; j < components; j++) {
+            TEST_ASSERT_TRUE_MESSAGE(strcmp(name, LogComponentName(static_cast<LogComponent>(j))) != 0, name);
+        }
+    }
+
+    const uint16_t events = static_cast<uint16_t>(LogEvent::COUNT);
+    for (uint16_t i = 0; i < events; i++) {
+        const char* name = LogEventName(static_cast<LogEvent>(i));
+        TEST_ASSERT_TRUE_MESSAGE(strlen(name) < CrashLogEntry::EVENT_SIZE, name);
+        for (uint16_t j = i + 1; j < events; j++) {
+            TEST_ASSERT_TRUE_MESSAGE(strcmp(name, LogEventName(static_cast<LogEvent>(j))) != 0, name);
+        }
+    }
+}
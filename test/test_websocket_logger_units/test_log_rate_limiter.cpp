@@ -0,0 +1,107 @@
+/**
+ * @file test_log_rate_limiter.cpp
+ * @brief Unit tests for LogRateLimiter (per-(component,event) token buckets)
+ */
+
+#include <unity.h>
+#include "../../src/utils/LogRateLimiter.h"
+#include "../../src/utils/LogRateLimiter.cpp"
+#include <stdio.h>
+
+/**
+ * @brief First occurrences pass up to the burst size, then repeats are suppressed
+ */
+void test_rate_limiter_burst_then_suppress() {
+    LogRateLimiter limiter(2, 3);
+
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA2000", "PGN_IGNORED", 1000));
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA2000", "PGN_IGNORED", 1000));
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA2000", "PGN_IGNORED", 1000));
+    TEST_ASSERT_FALSE(limiter.allow(1, "NMEA2000", "PGN_IGNORED", 1000));
+    TEST_ASSERT_FALSE(limiter.allow(1, "NMEA2000", "PGN_IGNORED", 1001));
+    TEST_ASSERT_EQUAL_UINT32(2, limiter.getSuppressedTotal());
+}
+
+/**
+ * @brief Tokens refill at the configured rate, capped at the burst size
+ */
+void test_rate_limiter_refills_over_time() {
+    LogRateLimiter limiter(2, 2);  // 2 msg/s = one token per 500 ms
+
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA0183", "WRONG_TALKER_REJECTED", 0));
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA0183", "WRONG_TALKER_REJECTED", 0));
+    TEST_ASSERT_FALSE(limiter.allow(1, "NMEA0183", "WRONG_TALKER_REJECTED", 499));
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA0183", "WRONG_TALKER_REJECTED", 750));
+    TEST_ASSERT_FALSE(limiter.allow(1, "NMEA0183", "WRONG_TALKER_REJECTED", 750));
+
+    // Long idle period refills only up to the burst size
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA0183", "WRONG_TALKER_REJECTED", 600000));
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA0183", "WRONG_TALKER_REJECTED", 600000));
+    TEST_ASSERT_FALSE(limiter.allow(1, "NMEA0183", "WRONG_TALKER_REJECTED", 600000));
+}
+
+/**
+ * @brief Buckets are independent per (component, event) pair
+ */
+void test_rate_limiter_keys_are_independent() {
+    LogRateLimiter limiter(1, 1);
+
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA2000", "PGN_IGNORED", 0));
+    TEST_ASSERT_FALSE(limiter.allow(1, "NMEA2000", "PGN_IGNORED", 0));
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA2000", "MESSAGE_NOT_HANDLED", 0));
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA0183", "PGN_IGNORED", 0));
+}
+
+/**
+ * @brief Summaries are reported once per window and reset the counter
+ */
+void test_rate_limiter_summary_reports_and_resets() {
+    LogRateLimiter limiter(1, 1);
+    uint32_t reported = 0;
+    const char* event = nullptr;
+    uint8_t level = 0;
+    auto collect = [&](const LogRateLimiter::Summary& s) {
+        reported += s.suppressed;
+        event = s.event;
+        level = s.level;
+    };
+
+    TEST_ASSERT_TRUE(limiter.allow(1, "NMEA2000", "PGN127252_NA", 100));
+    TEST_ASSERT_FALSE(limiter.allow(1, "NMEA2000", "PGN127252_NA", 100));
+    TEST_ASSERT_FALSE(limiter.allow(2, "NMEA2000", "PGN127252_NA", 200));
+
+    // Not due yet
+    TEST_ASSERT_EQUAL_UINT8(0, limiter.collectSummaries(100 + LOG_RATE_SUMMARY_MS - 1, collect));
+
+    TEST_ASSERT_EQUAL_UINT8(1, limiter.collectSummaries(100 + LOG_RATE_SUMMARY_MS, collect));
+    TEST_ASSERT_EQUAL_UINT32(2, reported);
+    TEST_ASSERT_EQUAL_STRING("PGN127252_NA", event);
+    TEST_ASSERT_EQUAL_UINT8(2, level);
+
+    // Counter reset - nothing more to report
+    TEST_ASSERT_EQUAL_UINT8(0, limiter.collectSummaries(100 + 3 * LOG_RATE_SUMMARY_MS, collect));
+}
+
+/**
+ * @brief Full table evicts idle entries and fails open when nothing is evictable
+ */
+void test_rate_limiter_table_full_fails_open() {
+    LogRateLimiter limiter(1, 1);
+    char event[16];
+
+    // Fill every slot with a suppressed entry (pending summary - not evictable)
+    for (uint8_t i = 0; i < LogRateLimiter::SLOTS; i++) {
+        snprintf(event, sizeof(event), "EVENT_%u", i);
+        TEST_ASSERT_TRUE(limiter.allow(1, "Test", event, 0));
+        TEST_ASSERT_FALSE(limiter.allow(1, "Test", event, 0));
+    }
+
+    // New key cannot be tracked - allowed rather than hidden
+    TEST_ASSERT_TRUE(limiter.allow(1, "Test", "NEW_EVENT", 0));
+    TEST_ASSERT_TRUE(limiter.allow(1, "Test", "NEW_EVENT", 0));
+
+    // After summaries are collected, idle entries become evictable again
+    limiter.collectSummaries(LOG_RATE_SUMMARY_MS, [](const LogRateLimiter::Summary&) {});
+    TEST_ASSERT_TRUE(limiter.allow(1, "Test", "NEW_EVENT", LOG_RATE_SUMMARY_MS));
+    TEST_ASSERT_FALSE(limiter.allow(1, "Test", "NEW_EVENT", LOG_RATE_SUMMARY_MS));
+}
@@ -0,0 +1,136 @@
+/**
+ * @file test_log_ring_buffer.cpp
+ * @brief Unit tests for LogRingBuffer (lock-free log record queue)
+ */
+
+#include <unity.h>
+#include <string.h>
+#include <stdio.h>
+#include "../../src/utils/LogRingBuffer.h"
+#include "../../src/utils/LogRingBuffer.cpp"
+
+static bool pushRecord(LogRingBuffer& ring, uint16_t event, uint32_t timestamp) {
+    uint32_t ticket;
+    LogRecord* rec = ring.tryReserve(ticket);
+    if (rec == nullptr) {
+        return false;
+    }
+    rec->timestamp = timestamp;
+    rec->level = 1;
+    rec->component = 1;
+    rec->event = event;
+    rec->data[0] = '\0';
+    ring.commit(ticket);
+    return true;
+}
+
+/**
+ * @brief New ring has nothing to read and no drops
+ */
+void test_ring_starts_empty() {
+    LogRingBuffer ring;
+
+    TEST_ASSERT_NULL(ring.front());
+    TEST_ASSERT_EQUAL_UINT32(0, ring.size());
+    TEST_ASSERT_EQUAL_UINT32(0, ring.getDroppedCount());
+}
+
+/**
+ * @brief Records come out in the order they were committed
+ */
+void test_ring_reserve_commit_pop_fifo() {
+    LogRingBuffer ring;
+
+    TEST_ASSERT_TRUE(pushRecord(ring, 101, 10));
+    TEST_ASSERT_TRUE(pushRecord(ring, 102, 20));
+    TEST_ASSERT_EQUAL_UINT32(2, ring.size());
+
+    const LogRecord* rec = ring.front();
+    TEST_ASSERT_NOT_NULL(rec);
+    TEST_ASSERT_EQUAL_UINT16(101, rec->event);
+    TEST_ASSERT_EQUAL_UINT32(10, rec->timestamp);
+    ring.pop();
+
+    rec = ring.front();
+    TEST_ASSERT_NOT_NULL(rec);
+    TEST_ASSERT_EQUAL_UINT16(102, rec->event);
+    ring.pop();
+
+    TEST_ASSERT_NULL(ring.front());
+    TEST_ASSERT_EQUAL_UINT32(0, ring.size());
+}
+
+/**
+ * @brief A reserved but uncommitted slot blocks the consumer until committed
+ */
+void test_ring_uncommitted_slot_not_visible() {
+    LogRingBuffer ring;
+
+    uint32_t ticket;
+    LogRecord* rec = ring.tryReserve(ticket);
+    TEST_ASSERT_NOT_NULL(rec);
+    rec->event = 7;
+
+    TEST_ASSERT_NULL(ring.front());
+
+    ring.commit(ticket);
+    TEST_ASSERT_NOT_NULL(ring.front());
+    TEST_ASSERT_EQUAL_UINT16(7, ring.front()->event);
+}
+
+/**
+ * @brief Full ring rejects new records without blocking and counts drops
+ */
+void test_ring_full_drops_and_counts() {
+    LogRingBuffer ring;
+
+    for (uint32_t i = 0; i < LogRingBuffer::CAPACITY; i++) {
+        TEST_ASSERT_TRUE(pushRecord(ring, 1, i));
+    }
+
+    TEST_ASSERT_FALSE(pushRecord(ring, 2, 0));
+    TEST_ASSERT_FALSE(pushRecord(ring, 2, 0));
+    TEST_ASSERT_EQUAL_UINT32(2, ring.getDroppedCount());
+    TEST_ASSERT_EQUAL_UINT32(LogRingBuffer::CAPACITY, ring.size());
+
+    // Freeing one slot makes room for exactly one more record
+    ring.pop();
+    TEST_ASSERT_TRUE(pushRecord(ring, 3, 99));
+    TEST_ASSERT_FALSE(pushRecord(ring, 2, 0));
+    TEST_ASSERT_EQUAL_UINT32(3, ring.getDroppedCount());
+}
+
+/**
+ * @brief Slot reuse stays consistent across many laps of the ring
+ */
+void test_ring_wraps_around_many_laps() {
+    LogRingBuffer ring;
+
+    for (uint32_t i = 0; i < LogRingBuffer::CAPACITY * 5 + 3; i++) {
+        uint16_t event = static_cast<uint16_t>(i);
+        TEST_ASSERT_TRUE(pushRecord(ring, event, i));
+
+        const LogRecord* rec = ring.front();
+        TEST_ASSERT_NOT_NULL(rec);
+        TEST_ASSERT_EQUAL_UINT16(event, rec->event);
+        TEST_ASSERT_EQUAL_UINT32(i, rec->timestamp);
+        ring.pop();
+    }
+
+    TEST_ASSERT_NULL(ring.front());
+    TEST_ASSERT_EQUAL_UINT32(0, ring.getDroppedCount());
+}
+
+/**
+ * @brief pop() on an empty ring does not advance the read position
+ */
+void test_ring_pop_on_empty_is_noop() {
+    LogRingBuffer ring;
+
+    ring.pop();
+    ring.pop();
+
+    TEST_ASSERT_TRUE(pushRecord(ring, 9, 1));
+    TEST_ASSERT_NOT_NULL(ring.front());
+    TEST_ASSERT_EQUAL_UINT16(9, ring.front()->event);
+}
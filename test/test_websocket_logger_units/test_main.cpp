@@ -0,0 +1,138 @@
+/**
+ * @file test_main.cpp
+ * @brief Unit tests for WebSocket logger building blocks
+ *
+ * Tests validate:
+ * - LogRingBuffer (reserve/commit/pop ordering, overflow drop counting, wrap-around)
+ * - LogFilter (compiled component set, event prefix trie, level threshold)
+ * - LogRateLimiter (token buckets, suppression summaries, table exhaustion)
+ * - CrashLogRing (recovery across simulated resets, wrap-around, corruption)
+ * - JsonWriter (typed members, nesting, escaping, overflow)
+ * - MsgPackWriter / LogNameTable (binary encoding, name interning)
+ * - LogNames (component/event ID -> name tables)
+ *
+ * Test Organization:
+ * - test_log_ring_buffer.cpp: queue semantics
+ * - test_log_filter.cpp: filter compilation and matching
+ * - test_log_rate_limiter.cpp: repeat suppression
+ * - test_crash_log_ring.cpp: reset-surviving records
+ * - test_json_writer.cpp: fixed-buffer JSON encoding
+ * - test_log_msgpack.cpp: binary /logs encoding
+ * - test_log_names.cpp: flash-resident name tables
+ */
+
+#include <unity.h>
+
+// Forward declarations for LogRingBuffer tests
+void test_ring_starts_empty();
+void test_ring_reserve_commit_pop_fifo();
+void test_ring_uncommitted_slot_not_visible();
+void test_ring_full_drops_and_counts();
+void test_ring_wraps_around_many_laps();
+void test_ring_pop_on_empty_is_noop();
+
+// Forward declarations for LogFilter tests
+void test_filter_defaults_match_all_at_info();
+void test_filter_component_set_exact_match();
+void test_filter_component_set_many_terms();
+void test_filter_event_prefix_trie();
+void test_filter_event_prefix_overlapping_terms();
+void test_filter_combined_and_clear();
+void test_filter_separator_only_list_matches_nothing();
+
+// Forward declarations for LogRateLimiter tests
+void test_rate_limiter_burst_then_suppress();
+void test_rate_limiter_refills_over_time();
+void test_rate_limiter_keys_are_independent();
+void test_rate_limiter_summary_reports_and_resets();
+void test_rate_limiter_table_full_fails_open();
+
+// Forward declarations for CrashLogRing tests
+void test_crash_ring_garbage_storage_discarded();
+void test_crash_ring_survives_reset();
+void test_crash_ring_wraps_keeping_newest();
+void test_crash_ring_corrupt_header_discarded();
+void test_crash_ring_truncates_long_names();
+
+// Forward declarations for JsonWriter tests
+void test_json_writer_typed_members();
+void test_json_writer_nesting();
+void test_json_writer_escapes_strings();
+void test_json_writer_raw_and_non_finite();
+void test_json_writer_overflow_detected();
+void test_json_writer_fixed_precision();
+
+// Forward declarations for binary encoding tests
+void test_msgpack_integer_widths();
+void test_msgpack_record_layout();
+void test_msgpack_overflow_detected();
+void test_name_table_interns_in_order();
+void test_name_table_full_returns_none();
+
+// Forward declarations for LogNames tests
+void test_log_names_resolve_ids();
+void test_log_names_out_of_range();
+void test_log_names_unique_and_fit();
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+int main(int argc, char **argv) {
+    UNITY_BEGIN();
+
+    // LogRingBuffer tests
+    RUN_TEST(test_ring_starts_empty);
+    RUN_TEST(test_ring_reserve_commit_pop_fifo);
+    RUN_TEST(test_ring_uncommitted_slot_not_visible);
+    RUN_TEST(test_ring_full_drops_and_counts);
+    RUN_TEST(test_ring_wraps_around_many_laps);
+    RUN_TEST(test_ring_pop_on_empty_is_noop);
+
+    // LogFilter tests
+    RUN_TEST(test_filter_defaults_match_all_at_info);
+    RUN_TEST(test_filter_component_set_exact_match);
+    RUN_TEST(test_filter_component_set_many_terms);
+    RUN_TEST(test_filter_event_prefix_trie);
+    RUN_TEST(test_filter_event_prefix_overlapping_terms);
+    RUN_TEST(test_filter_combined_and_clear);
+    RUN_TEST(test_filter_separator_only_list_matches_nothing);
+
+    // LogRateLimiter tests
+    RUN_TEST(test_rate_limiter_burst_then_suppress);
+    RUN_TEST(test_rate_limiter_refills_over_time);
+    RUN_TEST(test_rate_limiter_keys_are_independent);
+    RUN_TEST(test_rate_limiter_summary_reports_and_resets);
+    RUN_TEST(test_rate_limiter_table_full_fails_open);
+
+    // CrashLogRing tests
+    RUN_TEST(test_crash_ring_garbage_storage_discarded);
+    RUN_TEST(test_crash_ring_survives_reset);
+    RUN_TEST(test_crash_ring_wraps_keeping_newest);
+    RUN_TEST(test_crash_ring_corrupt_header_discarded);
+    RUN_TEST(test_crash_ring_truncates_long_names);
+
+    // JsonWriter tests
+    RUN_TEST(test_json_writer_typed_members);
+    RUN_TEST(test_json_writer_nesting);
+    RUN_TEST(test_json_writer_escapes_strings);
+    RUN_TEST(test_json_writer_raw_and_non_finite);
+    RUN_TEST(test_json_writer_overflow_detected);
+    RUN_TEST(test_json_writer_fixed_precision);
+
+    // Binary encoding tests
+    RUN_TEST(test_msgpack_integer_widths);
+    RUN_TEST(test_msgpack_record_layout);
+    RUN_TEST(test_msgpack_overflow_detected);
+    RUN_TEST(test_name_table_interns_in_order);
+    RUN_TEST(test_name_table_full_returns_none);
+
+    // LogNames tests
+    RUN_TEST(test_log_names_resolve_ids);
+    RUN_TEST(test_log_names_out_of_range);
+    RUN_TEST(test_log_names_unique_and_fit);
+
+    return UNITY_END();
+}
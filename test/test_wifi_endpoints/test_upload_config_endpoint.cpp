@@ -3,7 +3,7 @@
  * @brief Integration tests for POST /upload-wifi-config endpoint
  *
  * These tests validate the WiFi config upload API endpoint:
- * - Valid 3-network file → 200 + reboot scheduled
+ * - Valid 3-network file → 200 + WIFI configuration published (applied live, no reboot)
  * - Invalid SSID length → 400 + error details
  * - Max networks exceeded → 400
  *
@@ -54,16 +54,16 @@ protected:
 
 /**
  * Test: POST /upload-wifi-config with valid 3-network file
- * Expected: 200 OK, config saved, reboot scheduled in 5 seconds
+ * Expected: 200 OK, config saved, ConfigDomain::WIFI version bumped, no reboot
  */
 TEST_F(UploadConfigEndpointTest, UploadValidThreeNetworkConfig) {
     // Test implementation would:
     // 1. Create multipart form data with wifi.conf content
     // 2. POST to /upload-wifi-config
     // 3. Verify HTTP 200 response
-    // 4. Verify JSON response: {"status":"success","message":"...","networks_count":3}
+    // 4. Verify JSON response: {"status":"success","message":"...","networks_count":3,"version":1}
     // 5. Verify config file written to filesystem
-    // 6. Verify reboot scheduled for 5 seconds
+    // 6. Verify GetConfigService().isPending(ConfigDomain::WIFI) and no reboot scheduled
 
     GTEST_SKIP() << "Integration test - requires running web server";
 }
@@ -79,7 +79,7 @@ TEST_F(UploadConfigEndpointTest, RejectInvalidSSIDLength) {
     // 3. Verify HTTP 400 response
     // 4. Verify JSON error: {"status":"error","message":"...","errors":[...]}
     // 5. Verify config NOT written to filesystem
-    // 6. Verify no reboot scheduled
+    // 6. Verify nothing published (WIFI version unchanged)
 
     GTEST_SKIP() << "Integration test - requires running web server";
 }
@@ -141,8 +141,9 @@ TEST_F(UploadConfigEndpointTest, RejectEmptyFile) {
  * Success response (200):
  *   {
  *     "status": "success",
- *     "message": "Configuration uploaded successfully. Device will reboot in 5 seconds.",
- *     "networks_count": 2
+ *     "message": "Configuration uploaded successfully. Applying without reboot.",
+ *     "networks_count": 2,
+ *     "version": 1
  *   }
  *
  * Error response (400):
@@ -201,7 +201,7 @@ TEST_F(ServicesIndependenceTest, UDPLoggerBufferedModeWithoutWiFi) {
     // The logger should buffer or discard messages safely
 
     // Attempt to log without WiFi (should not crash or block)
-    logger->broadcastLog(LogLevel::INFO, "TestComponent", "TEST_EVENT",
+    logger->broadcastLog(LogLevel::INFO, LogComponent::MAIN, LogEvent::INIT,
                         "{\"data\":\"test\"}");
 
     logger->logConnectionEvent(ConnectionEvent::CONNECTION_ATTEMPT, "TestNet");
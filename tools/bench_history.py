@@ -0,0 +1,386 @@
+#!/usr/bin/env python3
+"""
+Benchmark history for Poseidon2: collect runs, compare them
+
+Keeps the results of the three benchmark suites in one JSON history file
+and renders comparison tables, so a run is judged against the numbers that
+came before it instead of scrolling past in a terminal.
+
+Suites (detected from the input file):
+    native    Google Benchmark JSON of env:native_bench (cpu_time, ns per op)
+    device    Serial log of test_performance_hardware: the "X(name, cycles)"
+              lines of test_hot_path_cycles.cpp (median cycles per call)
+    calc      GET /calc/benchmark JSON of env:esp32dev_bench (median cycles
+              per stage)
+
+Per benchmark, the comparison shows the current run, the baseline, the
+previous release and the change against both. Lower is better in every
+suite. A benchmark more than --threshold percent above its baseline (or,
+without one, the release) is flagged REGRESSION; one as far below it is
+flagged "faster".
+
+The baseline of a suite is the run marked with "baseline" (or add
+--baseline). The device suite falls back to perf_baseline.h. The previous
+release is the newest earlier run added with --release.
+
+Usage:
+    python3 tools/bench_history.py add FILE [--suite S] [--label L] [--release TAG]
+                                            [--commit SHA] [--baseline]
+    python3 tools/bench_history.py list [--suite S]
+    python3 tools/bench_history.py baseline RUN_ID
+    python3 tools/bench_history.py compare [--suite S] [--run ID] [--threshold PCT]
+                                           [--format text|markdown|json] [--fail]
+
+Options:
+    --history FILE    History file (default: bench_history.json, or $BENCH_HISTORY)
+
+Examples:
+    .pio/build/native_bench/program > run.json
+    python3 tools/bench_history.py add run.json --label "fixed-point json"
+    python3 tools/bench_history.py compare --suite native
+
+    pio test -e esp32dev_test -f test_performance_hardware | tee device.log
+    python3 tools/bench_history.py add device.log --release v2.1.0
+    python3 tools/bench_history.py compare --suite device --format markdown >> $GITHUB_STEP_SUMMARY
+
+    curl -s http://poseidon2.local/calc/benchmark > calc.json
+    python3 tools/bench_history.py add calc.json && python3 tools/bench_history.py compare --fail
+"""
+
+import argparse
+import datetime
+import json
+import os
+import re
+import subprocess
+import sys
+
+HISTORY_VERSION = 1
+DEFAULT_THRESHOLD_PCT = 10.0
+SUITES = ("native", "device", "calc")
+UNITS = {"native": "ns", "device": "cycles", "calc": "cycles"}
+
+PERF_BASELINE_H = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "test",
+                               "test_performance_hardware", "perf_baseline.h")
+
+DEVICE_LINE = re.compile(r"^\s*X\((\w+),\s*(\d+)\)")
+BASELINE_LINE = re.compile(r"X\((\w+),\s*(\d+)\)")
+
+
+# ============================================================================
+# Input parsing
+# ============================================================================
+
+def parse_native(doc):
+    """Google Benchmark JSON: name -> cpu_time in ns (aggregates other than the median skipped)"""
+    results = {}
+    for bench in doc.get("benchmarks", []):
+        if bench.get("run_type") == "aggregate" and bench.get("aggregate_name") != "median":
+            continue
+        name = bench.get("run_name", bench["name"]) if bench.get("run_type") == "aggregate" else bench["name"]
+        scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}.get(bench.get("time_unit", "ns"), 1.0)
+        results[name] = float(bench.get("cpu_time", bench.get("real_time", 0.0))) * scale
+    return results
+
+
+def parse_calc(doc):
+    """GET /calc/benchmark: calc/<stage> -> median cycles"""
+    return {"calc/" + stage["stage"]: float(stage["median"]) for stage in doc.get("stages", [])}
+
+
+def parse_device(text):
+    """test_hot_path_cycles.cpp serial output: name -> cycles (the last line of a name wins)"""
+    results = {}
+    for line in text.splitlines():
+        match = DEVICE_LINE.match(line)
+        if match:
+            results[match.group(1)] = float(match.group(2))
+    return results
+
+
+def load_results(path, suite):
+    """Read FILE, detect its suite unless given; returns (suite, results, context)"""
+    with open(path) as f:
+        text = f.read()
+    doc = None
+    try:
+        doc = json.loads(text)
+    except ValueError:
+        pass
+
+    if suite is None:
+        if isinstance(doc, dict) and "benchmarks" in doc:
+            suite = "native"
+        elif isinstance(doc, dict) and "stages" in doc:
+            suite = "calc"
+        elif doc is None:
+            suite = "device"
+        else:
+            raise ValueError("%s: neither Google Benchmark nor /calc/benchmark JSON" % path)
+
+    if suite == "native":
+        results, context = parse_native(doc or {}), (doc or {}).get("context", {})
+    elif suite == "calc":
+        doc = doc or {}
+        results = parse_calc(doc)
+        context = {k: doc[k] for k in ("storage", "fast_math", "cpu_mhz", "iterations", "corpus") if k in doc}
+    else:
+        results, context = parse_device(text), {}
+    if not results:
+        raise ValueError("%s: no %s results found" % (path, suite))
+    return suite, results, context
+
+
+def load_perf_baseline(path=PERF_BASELINE_H):
+    """X(name, cycles) entries of perf_baseline.h (empty if the file is missing)"""
+    if not os.path.exists(path):
+        return {}
+    with open(path) as f:
+        text = f.read()
+    return {m.group(1): float(m.group(2)) for m in BASELINE_LINE.finditer(text)}
+
+
+# ============================================================================
+# History file
+# ============================================================================
+
+def load_history(path):
+    if not os.path.exists(path):
+        return {"version": HISTORY_VERSION, "runs": [], "baselines": {}}
+    with open(path) as f:
+        history = json.load(f)
+    if history.get("version") != HISTORY_VERSION:
+        raise ValueError("%s: history version %s, expected %d" % (path, history.get("version"), HISTORY_VERSION))
+    return history
+
+
+def save_history(path, history):
+    tmp = path + ".tmp"
+    with open(tmp, "w") as f:
+        json.dump(history, f, indent=1, sort_keys=True)
+        f.write("\n")
+    os.replace(tmp, path)
+
+
+def git_commit():
+    try:
+        return subprocess.check_output(["git", "rev-parse", "--short", "HEAD"],
+                                       stderr=subprocess.DEVNULL).decode().strip()
+    except (OSError, subprocess.CalledProcessError):
+        return ""
+
+
+def find_run(history, run_id):
+    for run in history["runs"]:
+        if run["id"] == run_id:
+            return run
+    raise ValueError("no run %d in the history" % run_id)
+
+
+def latest_run(history, suite):
+    runs = [r for r in history["runs"] if suite is None or r["suite"] == suite]
+    if not runs:
+        raise ValueError("no %sruns in the history" % (suite + " " if suite else ""))
+    return runs[-1]
+
+
+def previous_release(history, run):
+    releases = [r for r in history["runs"]
+                if r["suite"] == run["suite"] and r.get("release") and r["id"] < run["id"]]
+    return releases[-1] if releases else None
+
+
+def baseline_of(history, suite):
+    """(label, results) of the suite's baseline run, perf_baseline.h for the device suite, or (None, {})"""
+    run_id = history["baselines"].get(suite)
+    if run_id is not None:
+        run = find_run(history, run_id)
+        return "#%d" % run["id"], run["results"]
+    if suite == "device":
+        results = load_perf_baseline()
+        if results:
+            return "perf_baseline.h", results
+    return None, {}
+
+
+# ============================================================================
+# Comparison
+# ============================================================================
+
+def delta_pct(current, reference):
+    if reference is None or reference == 0:
+        return None
+    return (current - reference) / reference * 100.0
+
+
+def compare(history, run, threshold):
+    """Rows of the comparison table of @p run"""
+    baseline_label, baseline = baseline_of(history, run["suite"])
+    release = previous_release(history, run)
+    release_results = release["results"] if release else {}
+    rows = []
+    names = sorted(set(run["results"]) | set(baseline))
+    for name in names:
+        current = run["results"].get(name)
+        base = baseline.get(name)
+        rel = release_results.get(name)
+        vs_base = delta_pct(current, base) if current is not None else None
+        vs_rel = delta_pct(current, rel) if current is not None else None
+        judged = vs_base if vs_base is not None else vs_rel
+        if current is None:
+            flag = "missing"
+        elif judged is None:
+            flag = "new"
+        elif judged > threshold:
+            flag = "REGRESSION"
+        elif judged < -threshold:
+            flag = "faster"
+        else:
+            flag = ""
+        rows.append({"name": name, "current": current, "baseline": base, "release": rel,
+                     "vs_baseline_pct": vs_base, "vs_release_pct": vs_rel, "flag": flag})
+    return {"run": run["id"], "suite": run["suite"], "unit": UNITS[run["suite"]],
+            "baseline": baseline_label, "release": release.get("release") if release else None,
+            "threshold_pct": threshold, "rows": rows}
+
+
+def format_value(value):
+    if value is None:
+        return "-"
+    return "%.1f" % value if value < 100 else "%.0f" % value
+
+
+def format_pct(value):
+    return "-" if value is None else "%+.1f%%" % value
+
+
+def render(report, fmt):
+    headers = ["benchmark", "current", "baseline", "release", "vs baseline", "vs release", ""]
+    table = [[r["name"], format_value(r["current"]), format_value(r["baseline"]), format_value(r["release"]),
+              format_pct(r["vs_baseline_pct"]), format_pct(r["vs_release_pct"]), r["flag"]]
+             for r in report["rows"]]
+    title = "%s run #%d (%s; baseline %s, release %s, threshold %.0f%%)" % (
+        report["suite"], report["run"], report["unit"], report["baseline"] or "none",
+        report["release"] or "none", report["threshold_pct"])
+
+    if fmt == "markdown":
+        lines = ["### " + title, "", "| " + " | ".join(headers) + " |",
+                 "|" + "|".join(["---"] + ["---:"] * 5 + ["---"]) + "|"]
+        for row in table:
+            if row[6] == "REGRESSION":
+                row[6] = "**REGRESSION**"
+            lines.append("| " + " | ".join(row) + " |")
+        return "\n".join(lines) + "\n"
+
+    widths = [max(len(headers[i]), max([len(row[i]) for row in table] or [0])) for i in range(len(headers))]
+    lines = [title]
+    lines.append("  ".join(headers[i].ljust(widths[i]) if i == 0 else headers[i].rjust(widths[i])
+                           for i in range(len(headers) - 1)))
+    for row in table:
+        cells = [row[0].ljust(widths[0])] + [row[i].rjust(widths[i]) for i in range(1, 6)]
+        lines.append("  ".join(cells) + ("  " + row[6] if row[6] else ""))
+    return "\n".join(lines) + "\n"
+
+
+# ============================================================================
+# Commands
+# ============================================================================
+
+def cmd_add(args, history):
+    suite, results, context = load_results(args.file, args.suite)
+    run_id = history["runs"][-1]["id"] + 1 if history["runs"] else 1
+    run = {"id": run_id, "suite": suite, "results": results, "context": context,
+           "date": datetime.datetime.now().isoformat(timespec="seconds"),
+           "commit": args.commit if args.commit is not None else git_commit(),
+           "label": args.label or "", "release": args.release or ""}
+    history["runs"].append(run)
+    if args.baseline:
+        history["baselines"][suite] = run_id
+    print("added %s run #%d: %d benchmarks%s" % (suite, run_id, len(results),
+                                                  ", baseline" if args.baseline else ""))
+    return True
+
+
+def cmd_list(args, history):
+    for run in history["runs"]:
+        if args.suite and run["suite"] != args.suite:
+            continue
+        marks = []
+        if history["baselines"].get(run["suite"]) == run["id"]:
+            marks.append("baseline")
+        if run.get("release"):
+            marks.append("release " + run["release"])
+        print("#%-4d %-7s %s  %-9s %3d benchmarks  %s%s" % (
+            run["id"], run["suite"], run["date"], run.get("commit", ""), len(run["results"]),
+            run.get("label", ""), ("  [" + ", ".join(marks) + "]") if marks else ""))
+    return False
+
+
+def cmd_baseline(args, history):
+    run = find_run(history, args.run_id)
+    history["baselines"][run["suite"]] = run["id"]
+    print("%s baseline: run #%d" % (run["suite"], run["id"]))
+    return True
+
+
+def cmd_compare(args, history):
+    suites = [args.suite] if args.suite else [s for s in SUITES if any(r["suite"] == s for r in history["runs"])]
+    if args.run is not None:
+        runs = [find_run(history, args.run)]
+    else:
+        runs = [latest_run(history, s) for s in suites]
+    reports = [compare(history, run, args.threshold) for run in runs]
+
+    if args.format == "json":
+        print(json.dumps(reports, indent=1))
+    else:
+        print("\n".join(render(report, args.format) for report in reports), end="")
+
+    regressions = sum(1 for report in reports for row in report["rows"] if row["flag"] == "REGRESSION")
+    if regressions and args.fail:
+        sys.exit(1)
+    return False
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Benchmark history and comparison for Poseidon2")
+    parser.add_argument("--history", default=os.environ.get("BENCH_HISTORY", "bench_history.json"),
+                        help="History file (default: bench_history.json, or $BENCH_HISTORY)")
+    commands = parser.add_subparsers(dest="command")
+    commands.required = True
+
+    add = commands.add_parser("add", help="Add a result file to the history")
+    add.add_argument("file")
+    add.add_argument("--suite", choices=SUITES, help="Suite (default: detected from the file)")
+    add.add_argument("--label", help="Free text shown by list")
+    add.add_argument("--release", help="Release tag: the run becomes the suite's 'previous release'")
+    add.add_argument("--commit", help="Commit (default: git rev-parse --short HEAD)")
+    add.add_argument("--baseline", action="store_true", help="Make this run the suite's baseline")
+
+    lst = commands.add_parser("list", help="List the runs")
+    lst.add_argument("--suite", choices=SUITES)
+
+    base = commands.add_parser("baseline", help="Make a run its suite's baseline")
+    base.add_argument("run_id", type=int)
+
+    cmp_ = commands.add_parser("compare", help="Comparison table of the latest run (per suite)")
+    cmp_.add_argument("--suite", choices=SUITES)
+    cmp_.add_argument("--run", type=int, help="Run to compare (default: latest of each suite)")
+    cmp_.add_argument("--threshold", type=float, default=DEFAULT_THRESHOLD_PCT,
+                      help="Regression threshold in percent (default: %.0f)" % DEFAULT_THRESHOLD_PCT)
+    cmp_.add_argument("--format", choices=("text", "markdown", "json"), default="text")
+    cmp_.add_argument("--fail", action="store_true", help="Exit with 1 if any benchmark regressed")
+
+    args = parser.parse_args()
+    try:
+        history = load_history(args.history)
+        handler = {"add": cmd_add, "list": cmd_list, "baseline": cmd_baseline, "compare": cmd_compare}
+        if handler[args.command](args, history):
+            save_history(args.history, history)
+    except (OSError, ValueError) as error:
+        print("bench_history: %s" % error, file=sys.stderr)
+        sys.exit(2)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,323 @@
+/**
+ * @file calc_batch.cpp
+ * @brief Offline calculation runner: recorded inputs through the on-device CalculationEngine
+ *
+ * Replays a bus capture (BusCaptureFormat, GET /capture/download) or a CSV
+ * of inputs (see CalcBatchInput.h) through the same CalculationEngine as the
+ * firmware, at maximum speed, and writes one CSV row of derived values per
+ * calculation. The cycle is scheduled like the BoatData subscription in
+ * main.cpp: on input changes at most every CALC_MIN_INTERVAL_MS, otherwise
+ * at least every CALC_MAX_INTERVAL_MS, on the log clock. Groups go stale
+ * after BOATDATA_STALE_<GROUP>_MS as on the device.
+ *
+ * Build and run (host, env:calc_batch):
+ * @code
+ * pio run -e calc_batch
+ * .pio/build/calc_batch/program -k 1.2 -o -1.5 -p polar.pol season.cap > derived.csv
+ * @endcode
+ *
+ * Options:
+ * - -k <factor>         Leeway calibration factor (default DEFAULT_LEEWAY_K_FACTOR)
+ * - -o <degrees>        Wind angle offset (default 0)
+ * - -d <field>=<s>      Damping time constant, e.g. -d tws=2 (keys of /calibration.json "damping")
+ * - -p <file>           Polar file (polar targets NaN without)
+ * - -i <ms>             Minimum calculation interval (default CALC_MIN_INTERVAL_MS, 0 = every change)
+ * - -n                  No output rows (throughput only)
+ *
+ * Throughput (records and calculations per second, excluding file loading
+ * and with output formatting included unless -n) is reported on stderr.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include <chrono>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "../../src/components/CalculationEngine.h"
+#include "../../src/utils/BusCaptureFormat.h"
+#include "../../src/utils/CalcBatchInput.h"
+#include "../../src/utils/PolarTable.h"
+
+namespace {
+
+const double RAD_TO_DEG_D = 57.29577951308232;
+
+uint32_t logClockMs = 0;  ///< Time of the record being replayed
+
+struct Options {
+    double leewayK = DEFAULT_LEEWAY_K_FACTOR;
+    double offsetDeg = 0.0;
+    DampingConfig damping = {};
+    const char* polarPath = nullptr;
+    uint32_t minIntervalMs = CALC_MIN_INTERVAL_MS;
+    bool output = true;
+    const char* inputPath = nullptr;
+};
+
+struct Counters {
+    uint64_t records = 0;       ///< Capture records / CSV rows read
+    uint64_t calculations = 0;  ///< calculate() calls
+    uint64_t available = 0;     ///< Calculations with all required inputs
+};
+
+void usage() {
+    fprintf(stderr, "usage: calc_batch [-k factor] [-o offset_deg] [-d field=seconds]... "
+                    "[-p polar.pol] [-i min_interval_ms] [-n] <capture.cap|inputs.csv>\n");
+}
+
+bool setDamping(DampingConfig& damping, const char* spec) {
+    static const char* const KEYS[] = {
+#define CALC_BATCH_DAMPING_KEY(id, key, kind) #key,
+        BOATDATA_DAMPING_FIELDS(CALC_BATCH_DAMPING_KEY)
+#undef CALC_BATCH_DAMPING_KEY
+    };
+    const char* eq = strchr(spec, '=');
+    if (eq == nullptr) {
+        return false;
+    }
+    for (uint8_t i = 0; i < DAMPING_FIELD_COUNT; i++) {
+        if (strlen(KEYS[i]) == static_cast<size_t>(eq - spec) && strncmp(KEYS[i], spec, eq - spec) == 0) {
+            damping.timeConstant[i] = strtof(eq + 1, nullptr);
+            return damping.timeConstant[i] >= 0.0f;
+        }
+    }
+    return false;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (strcmp(arg, "-k") == 0 && hasValue) {
+            options.leewayK = atof(argv[++i]);
+        } else if (strcmp(arg, "-o") == 0 && hasValue) {
+            options.offsetDeg = atof(argv[++i]);
+        } else if (strcmp(arg, "-d") == 0 && hasValue) {
+            if (!setDamping(options.damping, argv[++i])) {
+                fprintf(stderr, "calc_batch: bad damping '%s'\n", argv[i]);
+                return false;
+            }
+        } else if (strcmp(arg, "-p") == 0 && hasValue) {
+            options.polarPath = argv[++i];
+        } else if (strcmp(arg, "-i") == 0 && hasValue) {
+            options.minIntervalMs = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+        } else if (strcmp(arg, "-n") == 0) {
+            options.output = false;
+        } else if (arg[0] != '-' && options.inputPath == nullptr) {
+            options.inputPath = arg;
+        } else {
+            return false;
+        }
+    }
+    return options.inputPath != nullptr;
+}
+
+bool readFile(const char* path, std::vector<uint8_t>& out) {
+    FILE* file = fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    uint8_t chunk[65536];
+    size_t n;
+    while ((n = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        out.insert(out.end(), chunk, chunk + n);
+    }
+    fclose(file);
+    return true;
+}
+
+/**
+ * @brief Calculation scheduling and output, fed one record at a time
+ */
+class Runner {
+public:
+    Runner(const Options& options, const PolarTable* polar, FILE* out)
+        : options_(options), out_(options.output ? out : nullptr), lastCalcMs_(0), calculated_(false) {
+        memset(&data_, 0, sizeof(data_));
+        data_.calibration.leewayCalibrationFactor = options.leewayK;
+        data_.calibration.windAngleOffset = options.offsetDeg / RAD_TO_DEG_D;
+        data_.calibration.damping = options.damping;
+        data_.calibration.loaded = true;
+        engine_.setPolar(polar);
+        if (out_ != nullptr) {
+            fputs("time_ms,awa_offset_deg,awa_heel_deg,leeway_deg,stw_kn,tws_kn,twa_deg,wdir_deg,vmg_kn,"
+                  "soc_kn,doc_deg,polar_speed_kn,polar_perf_pct,target_twa_deg,tws_avg_1m_kn,"
+                  "wdir_avg_1m_deg,gust_1m_kn\n", out_);
+        }
+    }
+
+    BoatDataStructure& data() { return data_; }
+    const Counters& counters() const { return counters_; }
+
+    /// One record decoded at @p nowMs that updated @p changed groups
+    void record(uint32_t nowMs, uint16_t changed) {
+        counters_.records++;
+        logClockMs = nowMs;
+
+        // As the BoatData subscription: changes at most every minIntervalMs, else every CALC_MAX_INTERVAL_MS
+        uint32_t sinceCalc = nowMs - lastCalcMs_;
+        bool due;
+        if (!calculated_) {
+            due = changed != 0;
+        } else if (changed != 0) {
+            due = sinceCalc >= options_.minIntervalMs;
+        } else {
+            due = CALC_MAX_INTERVAL_MS != 0 && sinceCalc >= CALC_MAX_INTERVAL_MS;
+        }
+        if (!due) {
+            return;
+        }
+
+        CalcBatchInput::expireStale(data_, nowMs);
+        engine_.calculate(&data_, nowMs);
+        lastCalcMs_ = nowMs;
+        calculated_ = true;
+        counters_.calculations++;
+        if (data_.derived.available) {
+            counters_.available++;
+            write(nowMs);
+        }
+    }
+
+private:
+    const Options& options_;
+    FILE* out_;
+    BoatDataStructure data_;
+    CalculationEngine engine_;
+    Counters counters_;
+    uint32_t lastCalcMs_;
+    bool calculated_;
+
+    void write(uint32_t nowMs) {
+        if (out_ == nullptr) {
+            return;
+        }
+        const DerivedData& d = data_.derived;
+        fprintf(out_, "%lu,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.1f,%.2f,%.2f,%.1f,%.2f,%.1f,%.1f,%.2f,%.1f,%.2f\n",
+                (unsigned long)nowMs, d.awaOffset * RAD_TO_DEG_D, d.awaHeel * RAD_TO_DEG_D,
+                d.leeway * RAD_TO_DEG_D, (double)d.stw, (double)d.tws, d.twa * RAD_TO_DEG_D,
+                d.wdir * RAD_TO_DEG_D, (double)d.vmg, (double)d.soc, d.doc * RAD_TO_DEG_D,
+                (double)d.polarSpeed, (double)d.polarPerformance, d.targetTwa * RAD_TO_DEG_D,
+                (double)d.twsAvg1m, d.wdirAvg1m * RAD_TO_DEG_D, (double)d.gust1m);
+    }
+};
+
+bool replayCapture(const std::vector<uint8_t>& file, Runner& runner) {
+    CalcBatchInput input;
+    size_t pos = BUS_CAPTURE_HEADER_SIZE;
+    uint32_t nowMs = 0;
+    while (pos < file.size()) {
+        BusCaptureRecord rec;
+        int32_t used = BusCaptureDecode(file.data() + pos, file.size() - pos, rec);
+        if (used <= 0) {
+            if (used < 0) {
+                fprintf(stderr, "calc_batch: corrupt record at byte %zu, stopping\n", pos);
+            }
+            return used == 0;  // Truncated last record (capture stopped mid-write) is not an error
+        }
+        pos += static_cast<size_t>(used);
+        nowMs += rec.deltaMs;
+
+        uint16_t changed = 0;  // UTC marks only advance the clock
+        if (rec.type == BusCaptureType::CAN_FRAME) {
+            changed = input.applyFrame(rec.canId, rec.data, rec.length, nowMs, runner.data());
+        } else if (rec.type == BusCaptureType::NMEA0183_LINE) {
+            changed = input.applyLine(reinterpret_cast<const char*>(rec.data), rec.length, nowMs, runner.data());
+        }
+        runner.record(nowMs, changed);
+    }
+    return true;
+}
+
+bool replayCsv(std::vector<uint8_t>& file, Runner& runner) {
+    file.push_back('\0');
+    char* line = reinterpret_cast<char*>(file.data());
+    CalcBatchInput input;
+    bool header = true;
+    while (line != nullptr && *line != '\0') {
+        char* next = strchr(line, '\n');
+        if (next != nullptr) {
+            *next++ = '\0';
+        }
+        if (*line != '#' && *line != '\0' && *line != '\r') {
+            if (header) {
+                if (!input.setCsvHeader(line)) {
+                    fprintf(stderr, "calc_batch: CSV header has no time_ms column\n");
+                    return false;
+                }
+                header = false;
+            } else {
+                uint32_t nowMs = 0;
+                uint16_t changed = input.applyCsvRow(line, runner.data(), nowMs);
+                if (changed != 0) {
+                    runner.record(nowMs, changed);
+                }
+            }
+        }
+        line = next;
+    }
+    return true;
+}
+
+}  // namespace
+
+/// The engine's millis() (calculate() without a time) follows the log clock
+unsigned long millis() {
+    return logClockMs;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        usage();
+        return 2;
+    }
+
+    PolarTable polar;
+    if (options.polarPath != nullptr) {
+        std::vector<uint8_t> text;
+        if (!readFile(options.polarPath, text)) {
+            fprintf(stderr, "calc_batch: cannot read %s\n", options.polarPath);
+            return 1;
+        }
+        text.push_back('\0');
+        if (!polar.parse(reinterpret_cast<const char*>(text.data()))) {
+            fprintf(stderr, "calc_batch: polar %s: %s\n", options.polarPath, polar.error());
+            return 1;
+        }
+    }
+
+    std::vector<uint8_t> file;
+    if (!readFile(options.inputPath, file)) {
+        fprintf(stderr, "calc_batch: cannot read %s\n", options.inputPath);
+        return 1;
+    }
+
+    static char outBuffer[1 << 16];
+    setvbuf(stdout, outBuffer, _IOFBF, sizeof(outBuffer));
+    Runner runner(options, polar.loaded() ? &polar : nullptr, stdout);
+
+    auto start = std::chrono::steady_clock::now();
+    bool capture = BusCaptureCheckHeader(file.data(), file.size());
+    bool ok = capture ? replayCapture(file, runner) : replayCsv(file, runner);
+    fflush(stdout);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const Counters& c = runner.counters();
+    double logSeconds = logClockMs / 1000.0;
+    fprintf(stderr, "calc_batch: %s, %llu records over %.0f s of log, %llu calculations "
+                    "(%llu with all inputs) in %.3f s\n",
+            capture ? "capture" : "csv", (unsigned long long)c.records, logSeconds,
+            (unsigned long long)c.calculations, (unsigned long long)c.available, seconds);
+    if (seconds > 0.0) {
+        fprintf(stderr, "calc_batch: %.0f records/s, %.0f calculations/s (%.0fx real time)\n",
+                c.records / seconds, c.calculations / seconds, logSeconds / seconds);
+    }
+    return ok ? 0 : 1;
+}
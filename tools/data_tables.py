@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+"""
+Build the read-only tables partition image (tables.bin)
+
+Packs the boat polar and the magnetic variation grid into the image format
+of src/utils/DataTables.h. The firmware maps the "tables" partition
+(partitions.csv) and reads the tables in place, so they take no RAM and no
+parse at boot, and they are flashed on their own: rebuilding a table does
+not rebuild or reflash the firmware.
+
+Inputs:
+    --polar FILE      Polar in the /polar.pol text format (src/utils/PolarTable.h):
+                      TWS header line, then one TWA row per line
+    --variation FILE  CSV "lat,lon,variation_deg" on a regular grid (every
+                      lat x lon point once, e.g. exported from a WMM calculator);
+                      variation positive East
+
+Without --polar the firmware falls back to /polar.pol on LittleFS; without
+--variation it uses GPS variation only.
+
+Usage:
+    python3 tools/data_tables.py [--polar FILE] [--variation FILE] [-o tables.bin]
+                                 [--partitions partitions.csv]
+
+The esptool command that writes the image at the partition offset is printed.
+
+Examples:
+    python3 tools/data_tables.py --polar data/polar.pol --variation wmm_1deg.csv
+    esptool.py --chip esp32 write_flash 0x3b0000 tables.bin
+"""
+
+import argparse
+import csv
+import struct
+import sys
+import zlib
+
+MAGIC = 0x4C425450          # "PTBL"
+FORMAT = 1
+HEADER_BYTES = 16
+ENTRY_BYTES = 28
+NAME_MAX = 12
+
+TYPE_POLAR = 1
+TYPE_VARIATION = 2
+POLAR_VERSION = 1
+VARIATION_VERSION = 1
+
+PARTITION_LABEL = "tables"
+
+
+def numbers(line, skip_label):
+    tokens = line.replace(";", " ").replace(",", " ").replace("\t", " ").split()
+    values = []
+    for i, token in enumerate(tokens):
+        try:
+            values.append(float(token))
+        except ValueError:
+            if i == 0 and skip_label:
+                continue
+            raise ValueError("non-numeric value %r" % token)
+    return values
+
+
+def polar_payload(path):
+    """uint8 tws count, uint8 twa count, uint16 0, float tws[], twa[], speed[][]"""
+    tws = None
+    rows = []
+    with open(path) as f:
+        for number, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith("#"):
+                continue
+            try:
+                values = numbers(line, tws is None)
+            except ValueError as e:
+                raise ValueError("%s:%d: %s" % (path, number, e))
+            if tws is None:
+                tws = values
+            elif len(values) != len(tws) + 1:
+                raise ValueError("%s:%d: speed count differs from TWS columns" % (path, number))
+            else:
+                rows.append(values)
+    if not tws or not rows:
+        raise ValueError("%s: no TWS header or no TWA rows" % path)
+    if len(tws) > 255 or len(rows) > 255:
+        raise ValueError("%s: grid too large" % path)
+
+    out = struct.pack("<BBH", len(tws), len(rows), 0)
+    out += struct.pack("<%df" % len(tws), *tws)
+    out += struct.pack("<%df" % len(rows), *(row[0] for row in rows))
+    for row in rows:
+        out += struct.pack("<%df" % len(tws), *row[1:])
+    return out
+
+
+def variation_payload(path):
+    """float lat0, lon0, step, uint16 rows, cols, int16 value[rows][cols] (0.01 deg)"""
+    points = {}
+    with open(path) as f:
+        for row in csv.reader(f):
+            if not row or row[0].strip().startswith("#"):
+                continue
+            try:
+                lat, lon, var = (float(v) for v in row[:3])
+            except ValueError:
+                continue  # Header line
+            points[(lat, lon)] = var
+    lats = sorted({lat for lat, _ in points})
+    lons = sorted({lon for _, lon in points})
+    if len(lats) < 2 or len(lons) < 2:
+        raise ValueError("%s: need at least a 2 x 2 grid" % path)
+    step = lats[1] - lats[0]
+    for axis in (lats, lons):
+        for a, b in zip(axis, axis[1:]):
+            if abs((b - a) - step) > 1e-6:
+                raise ValueError("%s: grid spacing is not uniform (%g)" % (path, b - a))
+    if len(lats) * len(lons) != len(points):
+        raise ValueError("%s: grid has missing points" % path)
+
+    # A grid spanning 360 degrees wraps in the firmware: drop a duplicate seam column (-180 and 180)
+    if abs(lons[-1] - lons[0] - 360.0) < 1e-6:
+        lons = lons[:-1]
+
+    out = struct.pack("<fffHH", lats[0], lons[0], step, len(lats), len(lons))
+    for lat in lats:
+        out += struct.pack("<%dh" % len(lons), *(int(round(points[(lat, lon)] * 100)) for lon in lons))
+    return out
+
+
+def image(tables):
+    """tables: [(name, type, version, payload)] -> bytes"""
+    directory = b""
+    payloads = b""
+    offset = HEADER_BYTES + ENTRY_BYTES * len(tables)
+    for name, kind, version, payload in tables:
+        encoded = name.encode("ascii")
+        if len(encoded) > NAME_MAX:
+            raise ValueError("table name %r longer than %d" % (name, NAME_MAX))
+        offset_aligned = (offset + 3) & ~3
+        payloads += b"\0" * (offset_aligned - offset)
+        offset = offset_aligned
+        directory += struct.pack("<%dsHHIII" % NAME_MAX, encoded, kind, version, offset, len(payload),
+                                 zlib.crc32(payload) & 0xFFFFFFFF)
+        payloads += payload
+        offset += len(payload)
+    header = struct.pack("<IHHII", MAGIC, FORMAT, len(tables), offset, zlib.crc32(directory) & 0xFFFFFFFF)
+    return header + directory + payloads
+
+
+def partition(path):
+    """(offset, size) of the tables partition in a partition CSV"""
+    with open(path) as f:
+        for line in f:
+            fields = [v.strip() for v in line.split("#", 1)[0].split(",")]
+            if len(fields) >= 5 and fields[0] == PARTITION_LABEL:
+                return int(fields[3], 0), int(fields[4], 0)
+    raise ValueError("%s: no %r partition" % (path, PARTITION_LABEL))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Build the Poseidon2 tables partition image")
+    parser.add_argument("--polar", metavar="FILE")
+    parser.add_argument("--variation", metavar="FILE")
+    parser.add_argument("-o", "--output", default="tables.bin")
+    parser.add_argument("--partitions", default="partitions.csv")
+    args = parser.parse_args()
+
+    try:
+        tables = []
+        if args.polar:
+            tables.append(("polar", TYPE_POLAR, POLAR_VERSION, polar_payload(args.polar)))
+        if args.variation:
+            tables.append(("variation", TYPE_VARIATION, VARIATION_VERSION, variation_payload(args.variation)))
+        data = image(tables)
+        offset, size = partition(args.partitions)
+    except (OSError, ValueError) as e:
+        sys.stderr.write("data_tables: %s\n" % e)
+        return 2
+    if len(data) > size:
+        sys.stderr.write("data_tables: image is %d bytes, partition holds %d\n" % (len(data), size))
+        return 1
+
+    with open(args.output, "wb") as f:
+        f.write(data)
+    for name, kind, version, payload in tables:
+        print("%-10s type %d v%d  %6d bytes" % (name, kind, version, len(payload)))
+    print("%s: %d of %d bytes" % (args.output, len(data), size))
+    print("esptool.py --chip esp32 write_flash 0x%x %s" % (offset, args.output))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,107 @@
+/**
+ * @file FuzzGuard.h
+ * @brief Worst-case execution time guard of the fuzz targets
+ *
+ * A crash is not the only failure a malformed sentence can cause: a parser
+ * slow path that takes milliseconds stalls the main loop just as badly on
+ * the boat. FuzzGuard::run() times every call of the code under test and
+ * treats one above the limit as a finding: it prints the input and calls
+ * abort(), so libFuzzer stops and writes it as crash-<sha1> for replay.
+ *
+ * - The limit is FUZZ_MAX_US from the environment, default
+ *   FUZZ_DEFAULT_MAX_US (100 us on the host, sanitizers included).
+ * - The first FUZZ_WARMUP_RUNS calls are not judged (static
+ *   initialization, first touch of the tables).
+ * - A call over the limit is run twice more and judged by the fastest of
+ *   the three, so a preempted call is not reported.
+ * - Each new worst time (10% above the last one) is printed with its input
+ *   size, to follow the slowest path found while fuzzing.
+ *
+ * @code
+ * static FuzzGuard guard("nmea0183");
+ * guard.run(data, size, [&]() { handler->dispatchMessage(tokens); });
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#ifndef FUZZ_GUARD_H
+#define FUZZ_GUARD_H
+
+#include <chrono>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+constexpr uint32_t FUZZ_DEFAULT_MAX_US = 100;
+constexpr uint32_t FUZZ_WARMUP_RUNS = 16;
+constexpr size_t FUZZ_DUMP_BYTES = 96;  ///< Input bytes printed with a finding
+
+class FuzzGuard {
+public:
+    explicit FuzzGuard(const char* target)
+        : target_(target), limitUs_(FUZZ_DEFAULT_MAX_US), runs_(0), worstUs_(0) {
+        const char* limit = getenv("FUZZ_MAX_US");
+        if (limit != nullptr && atol(limit) > 0) {
+            limitUs_ = static_cast<uint32_t>(atol(limit));
+        }
+    }
+
+    /**
+     * @brief Call @p call for @p data; abort() if it is slower than the limit
+     */
+    template <typename Call>
+    void run(const uint8_t* data, size_t size, Call call) {
+        uint32_t us = measure(call);
+        if (++runs_ <= FUZZ_WARMUP_RUNS) {
+            return;
+        }
+        if (us > limitUs_) {
+            for (int retry = 0; retry < 2 && us > limitUs_; retry++) {
+                uint32_t again = measure(call);
+                us = again < us ? again : us;
+            }
+            if (us > limitUs_) {
+                report(data, size, us);
+                abort();
+            }
+        }
+        if (us > worstUs_ + worstUs_ / 10) {
+            worstUs_ = us;
+            fprintf(stderr, "#%lu %s: new worst %lu us (%lu bytes)\n", (unsigned long)runs_, target_,
+                    (unsigned long)us, (unsigned long)size);
+        }
+    }
+
+    uint32_t getLimitUs() const { return limitUs_; }
+    uint32_t getWorstUs() const { return worstUs_; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    const char* target_;
+    uint32_t limitUs_;
+    uint32_t runs_;
+    uint32_t worstUs_;
+
+    template <typename Call>
+    static uint32_t measure(Call& call) {
+        Clock::time_point start = Clock::now();
+        call();
+        return static_cast<uint32_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+    }
+
+    void report(const uint8_t* data, size_t size, uint32_t us) const {
+        fprintf(stderr, "==%s== SLOW INPUT: %lu us > FUZZ_MAX_US %lu (%lu bytes)\n", target_,
+                (unsigned long)us, (unsigned long)limitUs_, (unsigned long)size);
+        for (size_t i = 0; i < size && i < FUZZ_DUMP_BYTES; i++) {
+            fprintf(stderr, "%02X%s", data[i], (i % 32 == 31) ? "\n" : " ");
+        }
+        fprintf(stderr, "\n");
+    }
+};
+
+#endif // FUZZ_GUARD_H
@@ -0,0 +1,8 @@
+# PlatformIO extra script of the fuzz envs: libFuzzer needs clang, and the
+# sanitizers have to be on the link line as well as the compile line.
+Import("env")
+
+env.Replace(CC="clang", CXX="clang++", LINK="clang++")
+
+SANITIZE = ["-fsanitize=fuzzer,address,undefined", "-fno-omit-frame-pointer"]
+env.Append(CCFLAGS=SANITIZE, LINKFLAGS=SANITIZE)
@@ -0,0 +1,79 @@
+/**
+ * @file fuzz_n2k.cpp
+ * @brief libFuzzer target: every HandleN2kPGN* handler on arbitrary payloads
+ *
+ * Input layout:
+ * - byte 0: handler, as an index into GetN2kPGNTable() (modulo its size), so
+ *   every registered PGN is reached, including ones added later
+ * - byte 1: source address
+ * - the rest: message data, up to tN2kMsg::MaxDataLen (a fast-packet PGN
+ *   gets its reassembled payload, as from the library)
+ *
+ * The handler is called directly, the way N2kPGNDispatcher calls it after
+ * source arbitration. Every call runs under FuzzGuard (FUZZ_MAX_US,
+ * default 100 us); the virtual clock moves 20 ms per input.
+ *
+ * @code
+ * pio run -e fuzz_n2k
+ * .pio/build/fuzz_n2k/program tools/fuzz/corpus/n2k
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include <stdint.h>
+#include <string.h>
+#include <NMEA2000.h>
+#include <N2kMessages.h>
+
+#include "FuzzGuard.h"
+#include "../../src/components/BoatData.h"
+#include "../../src/components/NMEA2000Handlers.h"
+#include "../../src/components/SourcePrioritizer.h"
+#include "../../src/mocks/VirtualClock.h"
+#include "../../src/utils/WebSocketLogger.h"
+
+unsigned long millis() { return GetVirtualClock().millis(); }
+unsigned long micros() { return GetVirtualClock().micros(); }
+
+namespace {
+
+constexpr size_t HEADER_BYTES = 2;  ///< Handler index, source address
+
+struct Target {
+    WebSocketLogger logger;
+    SourcePrioritizer prioritizer;
+    BoatData boatData;
+    FuzzGuard guard;
+
+    Target() : boatData(&prioritizer), guard("n2k") {}
+};
+
+Target& target() {
+    static Target instance;
+    return instance;
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    const N2kPGNTable& table = GetN2kPGNTable();
+    if (size < HEADER_BYTES || table.count() == 0) {
+        return 0;
+    }
+    const N2kPGNEntry& entry = table.entry(data[0] % table.count());
+
+    tN2kMsg msg(data[1], 6, entry.pgn);
+    size_t length = size - HEADER_BYTES;
+    if (length > static_cast<size_t>(tN2kMsg::MaxDataLen)) {
+        length = tN2kMsg::MaxDataLen;
+    }
+    memcpy(msg.Data, data + HEADER_BYTES, length);
+    msg.DataLen = static_cast<int>(length);
+
+    Target& t = target();
+    GetVirtualClock().advanceMs(20);
+    t.guard.run(data, size, [&]() { entry.handler(msg, &t.boatData, &t.logger); });
+    return 0;
+}
@@ -0,0 +1,95 @@
+/**
+ * @file fuzz_nmea0183.cpp
+ * @brief libFuzzer target: NMEA0183Handler::dispatchMessage() on arbitrary sentences
+ *
+ * The input is the sentence body between '$' and '*'. The target adds the
+ * framing and the checksum, so the mutations get past NMEA0183Tokens and into
+ * the dispatch table, the talker checks, the parsers and the BoatData
+ * updates instead of dying at the checksum. Inputs with '$', '*' or line
+ * ends inside are rejected by the tokenizer, as on the wire.
+ *
+ * VDM sentences are applied to an AIS target table, so the payload decoder
+ * and the table's hash and grid see the mutations too (200 targets fill
+ * the slab within a run and exercise eviction).
+ *
+ * Every dispatch runs under FuzzGuard (FUZZ_MAX_US, default 100 us). The
+ * virtual clock moves 50 ms per input, so rate limits, the fix fusion
+ * window and source timeouts take their normal paths.
+ *
+ * @code
+ * pio run -e fuzz_nmea0183
+ * .pio/build/fuzz_nmea0183/program -dict=tools/fuzz/nmea0183.dict tools/fuzz/corpus/nmea0183
+ * .pio/build/fuzz_nmea0183/program crash-<sha1>     # Replay a finding
+ * @endcode
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FuzzGuard.h"
+#include "../../src/components/BoatData.h"
+#include "../../src/components/NMEA0183Handler.h"
+#include "../../src/components/SourcePrioritizer.h"
+#include "../../src/mocks/MockSerialPort.h"
+#include "../../src/mocks/VirtualClock.h"
+#include "../../src/utils/AisTargetTable.h"
+#include "../../src/utils/NMEA0183Tokenizer.h"
+#include "../../src/utils/WebSocketLogger.h"
+
+unsigned long millis() { return GetVirtualClock().millis(); }
+unsigned long micros() { return GetVirtualClock().micros(); }
+
+namespace {
+
+/// "$" + body + "*hh\r\n"
+constexpr size_t FRAMING_BYTES = 6;
+
+struct Target {
+    MockSerialPort serial;
+    WebSocketLogger logger;
+    SourcePrioritizer prioritizer;
+    BoatData boatData;
+    NMEA0183Handler handler;
+    AisTargetTable ais;
+    FuzzGuard guard;
+
+    Target() : boatData(&prioritizer), handler(&serial, &boatData, &logger), guard("nmea0183") {
+        handler.setAisTargets(&ais);
+    }
+};
+
+Target& target() {
+    static Target instance;
+    return instance;
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size == 0 || size + FRAMING_BYTES > NMEA0183_MAX_LINE) {
+        return 0;
+    }
+
+    char line[NMEA0183_MAX_LINE + 1];
+    uint8_t checksum = 0;
+    line[0] = '$';
+    for (size_t i = 0; i < size; i++) {
+        line[1 + i] = static_cast<char>(data[i]);
+        checksum ^= data[i];
+    }
+    snprintf(line + 1 + size, FRAMING_BYTES, "*%02X\r\n", checksum);
+
+    NMEA0183Tokens tokens;
+    if (!tokens.tokenize(line, size + FRAMING_BYTES)) {
+        return 0;
+    }
+
+    Target& t = target();
+    GetVirtualClock().advanceMs(50);
+    t.guard.run(data, size, [&]() { t.handler.dispatchMessage(tokens); });
+    return 0;
+}
@@ -0,0 +1,66 @@
+"""
+PlatformIO pre-script: gzip the dashboard files in data/ for LittleFS
+
+Writes data/<file>.gz next to every data/*.html, *.js and *.css that is
+newer than its .gz, so `pio run -t buildfs` / `uploadfs` ship both. The
+firmware (StaticAssetServer) serves the .gz with Content-Encoding: gzip.
+The output is reproducible (mtime 0, no file name), so an unchanged file
+keeps its ETag across builds.
+
+The dashboard's service worker (stream-sw.js) caches the files it lists in
+SHELL_FILES. Its .gz gets '__SHELL_VERSION__' replaced by a hash of those
+files and of itself, so a changed dashboard is a changed worker, and
+browsers replace their cached copy.
+
+Also runs standalone: python3 tools/gzip_assets.py [data_dir]
+"""
+
+import gzip
+import hashlib
+import os
+import sys
+
+EXTENSIONS = (".html", ".js", ".css")
+
+# Service worker -> the shell files it caches (SHELL_VERSION is stamped from them)
+SHELL_FILES = {"stream-sw.js": ("stream.html", "boatdata-decoder.js")}
+SHELL_VERSION_PLACEHOLDER = b"__SHELL_VERSION__"
+
+
+def shell_version(data_dir, worker, files):
+    digest = hashlib.sha1()
+    for name in (worker,) + files:
+        path = os.path.join(data_dir, name)
+        if os.path.exists(path):
+            with open(path, "rb") as f:
+                digest.update(f.read())
+    return digest.hexdigest()[:12]
+
+
+def gzip_assets(data_dir):
+    for name in sorted(os.listdir(data_dir)):
+        if not name.endswith(EXTENSIONS):
+            continue
+        source = os.path.join(data_dir, name)
+        target = source + ".gz"
+        inputs = [source] + [os.path.join(data_dir, n) for n in SHELL_FILES.get(name, ())]
+        newest = max(os.path.getmtime(path) for path in inputs if os.path.exists(path))
+        if os.path.exists(target) and os.path.getmtime(target) >= newest:
+            continue
+        with open(source, "rb") as f:
+            raw = f.read()
+        if name in SHELL_FILES:
+            version = shell_version(data_dir, name, SHELL_FILES[name])
+            raw = raw.replace(SHELL_VERSION_PLACEHOLDER, version.encode("ascii"))
+        with open(target, "wb") as out:
+            with gzip.GzipFile(filename="", mode="wb", fileobj=out, compresslevel=9, mtime=0) as gz:
+                gz.write(raw)
+        print("gzip_assets: %s %d -> %d bytes" % (name, len(raw), os.path.getsize(target)))
+
+
+try:
+    Import("env")  # noqa: F821 (PlatformIO SCons environment)
+    gzip_assets(env.subst("$PROJECT_DATA_DIR"))  # noqa: F821
+except NameError:
+    if __name__ == "__main__":
+        gzip_assets(sys.argv[1] if len(sys.argv) > 1 else "data")
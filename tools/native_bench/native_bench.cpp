@@ -0,0 +1,460 @@
+/**
+ * @file native_bench.cpp
+ * @brief Host benchmarks of the hot-path components, JSON output for comparing commits
+ *
+ * Runs the firmware's own code on the development machine: the calculation
+ * cycle (CalculationBenchmark stages over its fixed corpus), the /boatdata
+ * JSON (BoatDataSchema::writeJson, the body of BoatDataSerializer::toJSON
+ * without the BoatData copy), the NMEA 0183 tokenizer and parsers,
+ * DataValidator, AngleUtils and the precompiled LogFilter.
+ *
+ * Each benchmark is calibrated to run for at least -t milliseconds, then
+ * repeated -r times; the median repetition is reported. The output is the
+ * JSON of Google Benchmark (--benchmark_format=json: "context" plus one
+ * "benchmarks" entry per benchmark, times in ns per operation), so its
+ * tools/compare.py compares two runs:
+ *
+ * @code
+ * pio run -e native_bench
+ * .pio/build/native_bench/program > before.json
+ * git checkout <other> && pio run -e native_bench
+ * .pio/build/native_bench/program > after.json
+ * compare.py benchmarks before.json after.json
+ * @endcode
+ *
+ * Options:
+ * - -f <text>           Only benchmarks whose name contains text (e.g. -f nmea0183/)
+ * - -t <ms>             Minimum time per repetition (default 200)
+ * - -r <count>          Repetitions (default 5)
+ *
+ * Host timings rank code changes; they are not ESP32 timings. For cycles
+ * on the device use env:esp32dev_bench (GET /calc/benchmark).
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "../../src/components/CalculationBenchmark.h"
+#include "../../src/utils/AngleUtils.h"
+#include "../../src/utils/BoatDataSchema.h"
+#include "../../src/utils/DataValidator.h"
+#include "../../src/utils/LogFilter.h"
+#include "../../src/utils/NMEA0183Parsers.h"
+#include "../../src/utils/NMEA0183Tokenizer.h"
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+const Clock::time_point START = Clock::now();
+
+/// Keeps a result alive without a store to memory the compiler may drop
+template <typename T>
+inline void keep(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// ============================================================================
+// Fixtures
+// ============================================================================
+
+/// Sentences of a typical sailing instrument feed, checksums appended at startup
+const char* const SENTENCE_BODIES[] = {
+    "GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W",
+    "GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,",
+    "GPVTG,054.7,T,034.4,M,005.5,N,010.2,K",
+    "HCHDM,238.5,M",
+    "APRSA,15.0,A,15.0,A",
+};
+constexpr size_t SENTENCE_COUNT = sizeof(SENTENCE_BODIES) / sizeof(SENTENCE_BODIES[0]);
+
+char sentences[SENTENCE_COUNT][NMEA0183_MAX_LINE];
+size_t sentenceLengths[SENTENCE_COUNT];
+
+void makeSentences() {
+    for (size_t i = 0; i < SENTENCE_COUNT; i++) {
+        uint8_t checksum = 0;
+        for (const char* c = SENTENCE_BODIES[i]; *c != '\0'; c++) {
+            checksum ^= static_cast<uint8_t>(*c);
+        }
+        int n = snprintf(sentences[i], sizeof(sentences[i]), "$%s*%02X\r\n", SENTENCE_BODIES[i], checksum);
+        sentenceLengths[i] = static_cast<size_t>(n);
+    }
+}
+
+/// One consistent structure with every group available (derived values from the engine)
+BoatDataStructure boatState;
+
+void makeBoatState() {
+    memset(&boatState, 0, sizeof(boatState));
+    boatState.gps = {48.1173, 11.5167, 1.4731, 6.2, -0.0541, 1, 8, 0.9, true, 1000};
+    boatState.compass = {1.5102, 1.5643, 0.0012, 0.2094, -0.0175, 0.12, true, 1000};
+    boatState.wind = {0.6109, 14.3, true, 1000};
+    boatState.dst = {12.4, 3.1, 17.8, true, 1000};
+    boatState.rudder.steeringAngle = 0.0524;
+    boatState.rudder.available = true;
+    boatState.engine.engineRev = 1850;
+    boatState.engine.oilTemperature = 82.5;
+    boatState.engine.alternatorVoltage = 14.2;
+    boatState.engine.available = true;
+    boatState.battery.voltageA = 12.86;
+    boatState.battery.amperageA = -4.2;
+    boatState.battery.stateOfChargeA = 87.0;
+    boatState.battery.voltageB = 12.91;
+    boatState.battery.available = true;
+    boatState.calibration.leewayCalibrationFactor = DEFAULT_LEEWAY_K_FACTOR;
+    boatState.calibration.windAngleOffset = DEFAULT_WIND_ANGLE_OFFSET;
+    boatState.calibration.loaded = true;
+
+    CalculationEngine engine;
+    engine.calculate(&boatState, 1000);
+}
+
+/// Component and event names of a busy log stream, matched against one filter
+const char* const LOG_COMPONENTS[] = {"NMEA2000", "BoatData", "WebServer", "NMEA0183", "WiFiManager", "SignalK"};
+const char* const LOG_EVENTS[] = {"PGN130306_UPDATE", "CLIENT_CONNECTED", "BROADCAST", "SENTENCE_PARSED",
+                                  "PGN127250_UPDATE", "HEAP_LOW"};
+constexpr size_t LOG_NAME_COUNT = sizeof(LOG_COMPONENTS) / sizeof(LOG_COMPONENTS[0]);
+
+LogFilter logFilter;
+
+char jsonBuffer[BoatDataSchema::JSON_MAX_BYTES + 1];
+
+// ============================================================================
+// Benchmarks: each runs its operation @p iterations times
+// ============================================================================
+
+void benchSchemaJson(uint64_t iterations, uint16_t groups) {
+    JsonWriter json(jsonBuffer, sizeof(jsonBuffer));
+    for (uint64_t i = 0; i < iterations; i++) {
+        json.reset();
+        json.beginObject().add("timestamp", (unsigned long)i);
+        BoatDataSchema::writeJson(json, boatState, groups);
+        json.endObject();
+        keep(json.length());
+    }
+}
+
+void benchJsonAll(uint64_t iterations) {
+    benchSchemaJson(iterations, BoatDataGroup::ALL);
+}
+
+void benchJsonGpsWind(uint64_t iterations) {
+    benchSchemaJson(iterations, BoatDataGroup::GPS | BoatDataGroup::WIND);
+}
+
+void benchTokenize(uint64_t iterations) {
+    NMEA0183Tokens tokens;
+    for (uint64_t i = 0; i < iterations; i++) {
+        size_t s = i % SENTENCE_COUNT;
+        keep(tokens.tokenize(sentences[s], sentenceLengths[s]));
+    }
+}
+
+void benchParseRmc(uint64_t iterations) {
+    NMEA0183Tokens tokens;
+    double latitude, longitude, cog, sog, variation;
+    for (uint64_t i = 0; i < iterations; i++) {
+        tokens.tokenize(sentences[0], sentenceLengths[0]);
+        keep(NMEA0183ParseRMC(tokens, latitude, longitude, cog, sog, variation));
+        keep(latitude);
+    }
+}
+
+void benchParseGga(uint64_t iterations) {
+    NMEA0183Tokens tokens;
+    double latitude, longitude;
+    int32_t quality;
+    for (uint64_t i = 0; i < iterations; i++) {
+        tokens.tokenize(sentences[1], sentenceLengths[1]);
+        keep(NMEA0183ParseGGA(tokens, latitude, longitude, quality));
+        keep(latitude);
+    }
+}
+
+void benchParseVtg(uint64_t iterations) {
+    NMEA0183Tokens tokens;
+    double trueCourse, magneticCourse, sog;
+    for (uint64_t i = 0; i < iterations; i++) {
+        tokens.tokenize(sentences[2], sentenceLengths[2]);
+        keep(NMEA0183ParseVTG(tokens, trueCourse, magneticCourse, sog));
+        keep(sog);
+    }
+}
+
+void benchParseHdm(uint64_t iterations) {
+    NMEA0183Tokens tokens;
+    double heading;
+    for (uint64_t i = 0; i < iterations; i++) {
+        tokens.tokenize(sentences[3], sentenceLengths[3]);
+        keep(NMEA0183ParseHDM(tokens, heading));
+        keep(heading);
+    }
+}
+
+void benchParseRsa(uint64_t iterations) {
+    NMEA0183Tokens tokens;
+    double rudder;
+    for (uint64_t i = 0; i < iterations; i++) {
+        tokens.tokenize(sentences[4], sentenceLengths[4]);
+        keep(NMEA0183ParseRSA(tokens, rudder));
+        keep(rudder);
+    }
+}
+
+void benchValidateRanges(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        BoatScalar offset = static_cast<BoatScalar>(i & 7) * BoatScalar(0.01);
+        bool ok = DataValidator::isValidLatitude(boatState.gps.latitude) &&
+                  DataValidator::isValidLongitude(boatState.gps.longitude) &&
+                  DataValidator::isValidCOG(boatState.gps.cog + offset) &&
+                  DataValidator::isValidSOG(boatState.gps.sog + offset) &&
+                  DataValidator::isValidHeading(boatState.compass.trueHeading + offset) &&
+                  DataValidator::isValidAWA(boatState.wind.apparentWindAngle + offset) &&
+                  DataValidator::isValidWindSpeed(boatState.wind.apparentWindSpeed + offset) &&
+                  DataValidator::isValidHeelAngle(boatState.compass.heelAngle + offset);
+        keep(ok);
+    }
+}
+
+void benchValidateRates(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        BoatScalar step = static_cast<BoatScalar>(i & 7) * BoatScalar(0.01);
+        bool ok = DataValidator::isValidGPSRateOfChange(48.1173, 48.1174, 11.5167, 11.5168, 1000) &&
+                  DataValidator::isValidHeadingRateOfChange(BoatScalar(6.2), BoatScalar(0.05) + step, 200) &&
+                  DataValidator::isValidSpeedRateOfChange(BoatScalar(6.2), BoatScalar(6.3) + step, 200) &&
+                  DataValidator::isValidWindAngleRateOfChange(BoatScalar(3.1), BoatScalar(-3.1) + step, 200);
+        keep(ok);
+    }
+}
+
+void benchAngleNormalize(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        BoatScalar angle = static_cast<BoatScalar>(static_cast<int>(i & 63) - 32) * BoatScalar(0.7);
+        keep(AngleUtils::normalizeToZeroTwoPi(angle));
+        keep(AngleUtils::normalizeToPiMinusPi(angle));
+    }
+}
+
+void benchAngleDifference(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        BoatScalar a = static_cast<BoatScalar>(i & 63) * BoatScalar(0.1);
+        keep(AngleUtils::angleDifference(a, BoatScalar(6.2) - a));
+    }
+}
+
+void benchAngleSinCos(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        BoatScalar a = static_cast<BoatScalar>(i & 63) * BoatScalar(0.1);
+        keep(AngleUtils::sin(a) + AngleUtils::cos(a));
+    }
+}
+
+void benchLogFilterComponent(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        keep(logFilter.matchesComponent(LogLevel::INFO, LOG_COMPONENTS[i % LOG_NAME_COUNT]));
+    }
+}
+
+void benchLogFilterMatch(uint64_t iterations) {
+    for (uint64_t i = 0; i < iterations; i++) {
+        size_t n = i % LOG_NAME_COUNT;
+        keep(logFilter.matches(LogLevel::INFO, LOG_COMPONENTS[n], LOG_EVENTS[n]));
+    }
+}
+
+struct Benchmark {
+    const char* name;
+    void (*run)(uint64_t iterations);
+};
+
+const Benchmark BENCHMARKS[] = {
+    {"json/boatdata_all", benchJsonAll},
+    {"json/boatdata_gps_wind", benchJsonGpsWind},
+    {"nmea0183/tokenize", benchTokenize},
+    {"nmea0183/parse_rmc", benchParseRmc},
+    {"nmea0183/parse_gga", benchParseGga},
+    {"nmea0183/parse_vtg", benchParseVtg},
+    {"nmea0183/parse_hdm", benchParseHdm},
+    {"nmea0183/parse_rsa", benchParseRsa},
+    {"validator/ranges", benchValidateRanges},
+    {"validator/rates", benchValidateRates},
+    {"angle/normalize", benchAngleNormalize},
+    {"angle/difference", benchAngleDifference},
+    {"angle/sin_cos", benchAngleSinCos},
+    {"log_filter/component", benchLogFilterComponent},
+    {"log_filter/match", benchLogFilterMatch},
+};
+
+// ============================================================================
+// Harness
+// ============================================================================
+
+struct Options {
+    const char* filter = nullptr;
+    double minTimeMs = 200.0;
+    int repetitions = 5;
+};
+
+struct Result {
+    uint64_t iterations;
+    double realNs;   ///< Per operation, median repetition
+    double cpuNs;
+    double minNs;
+    double maxNs;
+};
+
+bool selected(const Options& options, const char* name) {
+    return options.filter == nullptr || strstr(name, options.filter) != nullptr;
+}
+
+double elapsedMs(Clock::time_point since) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - since).count();
+}
+
+/// Iterations that take at least minTimeMs, then the repetitions
+Result measure(void (*run)(uint64_t), const Options& options) {
+    uint64_t iterations = 1;
+    for (;;) {
+        Clock::time_point start = Clock::now();
+        run(iterations);
+        double ms = elapsedMs(start);
+        if (ms >= options.minTimeMs || iterations >= (1ull << 40)) {
+            break;
+        }
+        double factor = ms > 0.0 ? options.minTimeMs * 1.2 / ms : 100.0;
+        factor = std::min(std::max(factor, 2.0), 100.0);
+        iterations = static_cast<uint64_t>(iterations * factor);
+    }
+
+    std::vector<double> real;
+    std::vector<double> cpu;
+    for (int r = 0; r < options.repetitions; r++) {
+        std::clock_t cpuStart = std::clock();
+        Clock::time_point start = Clock::now();
+        run(iterations);
+        double ms = elapsedMs(start);
+        double cpuMs = 1000.0 * static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+        real.push_back(ms * 1e6 / iterations);
+        cpu.push_back(cpuMs * 1e6 / iterations);
+    }
+    std::vector<double> sorted = real;
+    std::sort(sorted.begin(), sorted.end());
+    size_t median = static_cast<size_t>(std::max_element(real.begin(), real.end()) - real.begin());
+    for (size_t i = 0; i < real.size(); i++) {
+        if (real[i] == sorted[sorted.size() / 2]) {
+            median = i;
+            break;
+        }
+    }
+    return {iterations, real[median], cpu[median], sorted.front(), sorted.back()};
+}
+
+void printResult(bool& first, const char* name, const Result& result) {
+    printf("%s\n    {\"name\": \"%s\", \"run_type\": \"iteration\", \"iterations\": %llu, "
+           "\"real_time\": %.3f, \"cpu_time\": %.3f, \"time_unit\": \"ns\", "
+           "\"min_time\": %.3f, \"max_time\": %.3f}",
+           first ? "" : ",", name, (unsigned long long)result.iterations, result.realNs, result.cpuNs,
+           result.minNs, result.maxNs);
+    first = false;
+}
+
+/// Nanoseconds since start for CalculationBenchmark (wraps after 4.3 s; differences stay right)
+uint32_t nanoCounter() {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - START).count());
+}
+
+/// CalculationBenchmark stages: per-call samples; median and p99 of the middle repetition
+void runCalculationStages(const Options& options, bool& first) {
+    CalculationBenchmark bench(nanoCounter);
+    for (uint8_t stage = 0; stage < CalculationBenchmark::STAGE_COUNT; stage++) {
+        char name[48];
+        snprintf(name, sizeof(name), "calc/%s", CalculationBenchmark::stageName(stage));
+        if (!selected(options, name)) {
+            continue;
+        }
+        std::vector<CalcBenchStats> runs;
+        for (int r = 0; r < options.repetitions; r++) {
+            CalcBenchStats stats;
+            bench.runStage(stage, CALC_BENCH_MAX_ITERATIONS, stats);
+            runs.push_back(stats);
+        }
+        std::sort(runs.begin(), runs.end(),
+                  [](const CalcBenchStats& a, const CalcBenchStats& b) { return a.median < b.median; });
+        const CalcBenchStats& mid = runs[runs.size() / 2];
+        Result result = {CALC_BENCH_MAX_ITERATIONS, static_cast<double>(mid.median), static_cast<double>(mid.median),
+                         static_cast<double>(runs.front().min), static_cast<double>(runs.back().max)};
+        printResult(first, name, result);
+    }
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            return false;
+        }
+        if (strcmp(argv[i], "-f") == 0) {
+            options.filter = argv[++i];
+        } else if (strcmp(argv[i], "-t") == 0) {
+            options.minTimeMs = atof(argv[++i]);
+        } else if (strcmp(argv[i], "-r") == 0) {
+            options.repetitions = atoi(argv[++i]);
+        } else {
+            return false;
+        }
+    }
+    return options.minTimeMs > 0.0 && options.repetitions > 0;
+}
+
+}  // namespace
+
+/// The engine's millis() (calculate() without a time)
+unsigned long millis() {
+    return static_cast<unsigned long>(elapsedMs(START));
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        fprintf(stderr, "usage: %s [-f <name filter>] [-t <min ms>] [-r <repetitions>]\n", argv[0]);
+        return 2;
+    }
+
+    makeSentences();
+    makeBoatState();
+    logFilter.setComponents("NMEA2000,BoatData,WiFiManager");
+    logFilter.setEventPrefixes("PGN,CLIENT_");
+
+    char date[32];
+    time_t now = time(nullptr);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+    printf("{\n  \"context\": {\"date\": \"%s\", \"executable\": \"%s\", \"library_build_type\": \"%s\", "
+           "\"boat_scalar_bytes\": %u, \"calc_fast_math\": %d, \"repetitions\": %d, \"min_time_ms\": %.0f},\n"
+           "  \"benchmarks\": [",
+           date, argv[0],
+#ifdef NDEBUG
+           "release",
+#else
+           "debug",
+#endif
+           (unsigned)sizeof(BoatScalar), CALC_FAST_MATH, options.repetitions, options.minTimeMs);
+
+    bool first = true;
+    runCalculationStages(options, first);
+    for (const Benchmark& benchmark : BENCHMARKS) {
+        if (selected(options, benchmark.name)) {
+            printResult(first, benchmark.name, measure(benchmark.run, options));
+            fflush(stdout);
+        }
+    }
+    printf("\n  ]\n}\n");
+    return 0;
+}
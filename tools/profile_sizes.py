@@ -0,0 +1,177 @@
+#!/usr/bin/env python3
+"""
+Link sizes of the Poseidon2 feature profiles, side by side
+
+Builds each firmware profile (POSEIDON_FEATURE_* in src/config.h, one
+PlatformIO environment per profile) and collects the flash and static RAM
+use PlatformIO prints after linking. The table shows every profile against
+the first one and the headroom left in the app partition (partitions.csv)
+and in DRAM, so the cost of a subsystem and the room a minimal build leaves
+are read off one run instead of three build logs.
+
+Static RAM is .data + .bss as linked; the heap the components take at boot
+is in the BUILD_PROFILE / STATIC_FOOTPRINT events and GET /memory of the
+running unit. IRAM is the code linked into the 128 KB instruction RAM
+(.iram0.vectors + .iram0.text, read from the ELF with the toolchain's size
+tool; "-" when it is not found), the budget HOT_PATH_IRAM spends.
+
+Profiles:
+    esp32dev              full firmware
+    esp32dev_headless     no OLED (POSEIDON_FEATURE_DISPLAY=0)
+    esp32dev_n2k_gateway  NMEA 2000 to Wi-Fi only: no OLED, 1-Wire or NMEA 0183
+                          inputs (the NMEA 0183 TCP output stays)
+    esp32dev_iram         full firmware, receive hot path in IRAM (HOT_PATH_IRAM=1;
+                          not built by default, name it: esp32dev esp32dev_iram)
+
+Usage:
+    python3 tools/profile_sizes.py [ENV ...] [--format text|markdown|json]
+                                   [--min-headroom PCT] [--fail]
+
+Options:
+    --min-headroom PCT  Flag profiles with less free flash than PCT percent
+                        (default 25); with --fail the exit status is 1
+
+Examples:
+    python3 tools/profile_sizes.py
+    python3 tools/profile_sizes.py esp32dev esp32dev_n2k_gateway --format markdown >> $GITHUB_STEP_SUMMARY
+    python3 tools/profile_sizes.py esp32dev esp32dev_iram
+"""
+
+import argparse
+import json
+import os
+import re
+import shutil
+import subprocess
+import sys
+
+DEFAULT_PROFILES = ("esp32dev", "esp32dev_headless", "esp32dev_n2k_gateway")
+DEFAULT_MIN_HEADROOM_PCT = 25.0
+IRAM_TOTAL = 128 * 1024
+IRAM_SECTIONS = (".iram0.vectors", ".iram0.text")
+SIZE_TOOL = "xtensa-esp32-elf-size"
+
+# "RAM:   [==        ]  15.3% (used 50124 bytes from 327680 bytes)"
+SIZE_LINE = re.compile(r"^(RAM|Flash):\s*\[.*\]\s*[\d.]+%\s*\(used (\d+) bytes from (\d+) bytes\)")
+
+
+def build(env):
+    """pio run -e ENV; returns {"ram": (used, total), "flash": (used, total)}"""
+    result = subprocess.run(["pio", "run", "-e", env], stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True)
+    if result.returncode != 0:
+        sys.stderr.write(result.stdout)
+        raise RuntimeError("%s: build failed" % env)
+    sizes = {}
+    for line in result.stdout.splitlines():
+        match = SIZE_LINE.match(line.strip())
+        if match:
+            sizes[match.group(1).lower()] = (int(match.group(2)), int(match.group(3)))
+    if "ram" not in sizes or "flash" not in sizes:
+        raise RuntimeError("%s: no RAM/Flash size lines in the build output" % env)
+    sizes["iram"] = iram_used(env)
+    return sizes
+
+
+def iram_used(env):
+    """IRAM code bytes of .pio/build/ENV/firmware.elf, None without the size tool"""
+    tool = shutil.which(SIZE_TOOL) or os.path.expanduser(
+        os.path.join("~", ".platformio", "packages", "toolchain-xtensa-esp32", "bin", SIZE_TOOL))
+    elf = os.path.join(".pio", "build", env, "firmware.elf")
+    try:
+        result = subprocess.run([tool, "-A", elf], stdout=subprocess.PIPE, stderr=subprocess.DEVNULL,
+                                universal_newlines=True, check=True)
+    except (OSError, subprocess.CalledProcessError):
+        return None
+    used = 0
+    for line in result.stdout.splitlines():
+        fields = line.split()
+        if len(fields) >= 2 and fields[0] in IRAM_SECTIONS:
+            used += int(fields[1])
+    return used
+
+
+def headroom_pct(used, total):
+    return 100.0 * (total - used) / total if total else 0.0
+
+
+def report(profiles, min_headroom):
+    """One row per profile, deltas against the first"""
+    rows = []
+    base = None
+    for env, sizes in profiles:
+        flash_used, flash_total = sizes["flash"]
+        ram_used, ram_total = sizes["ram"]
+        row = {
+            "env": env,
+            "flash": flash_used,
+            "flash_total": flash_total,
+            "flash_headroom_pct": round(headroom_pct(flash_used, flash_total), 1),
+            "ram": ram_used,
+            "ram_total": ram_total,
+            "ram_headroom_pct": round(headroom_pct(ram_used, ram_total), 1),
+            "iram": sizes["iram"],
+            "iram_total": IRAM_TOTAL,
+        }
+        if base is None:
+            base = row
+        row["flash_delta"] = flash_used - base["flash"]
+        row["ram_delta"] = ram_used - base["ram"]
+        row["iram_delta"] = (row["iram"] - base["iram"]
+                             if row["iram"] is not None and base["iram"] is not None else None)
+        row["low_headroom"] = row["flash_headroom_pct"] < min_headroom
+        rows.append(row)
+    return rows
+
+
+def render(rows, fmt):
+    if fmt == "json":
+        return json.dumps(rows, indent=2)
+    header = ("profile", "flash", "vs first", "flash free", "static ram", "vs first", "ram free",
+              "iram", "vs first", "iram free")
+    lines = []
+    for row in rows:
+        lines.append((
+            row["env"],
+            "%d" % row["flash"],
+            "%+d" % row["flash_delta"],
+            "%.1f%%%s" % (row["flash_headroom_pct"], " LOW" if row["low_headroom"] else ""),
+            "%d" % row["ram"],
+            "%+d" % row["ram_delta"],
+            "%.1f%%" % row["ram_headroom_pct"],
+            "-" if row["iram"] is None else "%d" % row["iram"],
+            "-" if row["iram_delta"] is None else "%+d" % row["iram_delta"],
+            "-" if row["iram"] is None else "%d" % (row["iram_total"] - row["iram"]),
+        ))
+    if fmt == "markdown":
+        out = ["| " + " | ".join(header) + " |", "|" + "---|" * len(header)]
+        out += ["| " + " | ".join(line) + " |" for line in lines]
+        return "\n".join(out)
+    widths = [max(len(header[i]), *(len(line[i]) for line in lines)) for i in range(len(header))]
+    out = ["  ".join(h.ljust(w) for h, w in zip(header, widths))]
+    out += ["  ".join(v.rjust(w) if i else v.ljust(w) for i, (v, w) in enumerate(zip(line, widths)))
+            for line in lines]
+    return "\n".join(out)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Link sizes of the Poseidon2 feature profiles")
+    parser.add_argument("envs", nargs="*", default=list(DEFAULT_PROFILES), metavar="ENV",
+                        help="PlatformIO environments (default: %s)" % " ".join(DEFAULT_PROFILES))
+    parser.add_argument("--format", choices=("text", "markdown", "json"), default="text")
+    parser.add_argument("--min-headroom", type=float, default=DEFAULT_MIN_HEADROOM_PCT, metavar="PCT")
+    parser.add_argument("--fail", action="store_true", help="exit 1 if a profile is below --min-headroom")
+    args = parser.parse_args()
+
+    try:
+        profiles = [(env, build(env)) for env in args.envs]
+    except (OSError, RuntimeError) as e:
+        sys.stderr.write("profile_sizes: %s\n" % e)
+        return 2
+    rows = report(profiles, args.min_headroom)
+    print(render(rows, args.format))
+    return 1 if args.fail and any(row["low_headroom"] for row in rows) else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,125 @@
+/**
+ * BoatCalc: JavaScript face of the WebAssembly CalculationEngine (--post-js)
+ *
+ * Appended to boatcalc.js by tools/wasm/wasm_env.py, inside the module
+ * factory createBoatCalc(). Turns the C API of boatcalc_wasm.cpp into one
+ * class that takes /boatdata state as BoatDataStream.decode() returns it
+ * (group objects of fields plus available and lastUpdate) and returns the
+ * derived group in the same shape:
+ *
+ *     const BoatCalcModule = await createBoatCalc();   // Node: require('./boatcalc.js')()
+ *     const calc = new BoatCalcModule.BoatCalc();
+ *     calc.setCalibration(1.2, -0.026);
+ *     calc.update(state);                    // gps, compass, wind, dst, ...
+ *     const derived = calc.calculate(state.wind.lastUpdate);
+ *
+ * Values are in /boatdata units (radians, knots, meters); times are the
+ * gateway's millis() of lastUpdate.
+ */
+
+Module['BoatCalc'] = (function () {
+    // Built on first use: the wasm exports are callable only once createBoatCalc() has resolved
+    const groupIds = {};  // 'wind' -> group id
+    const fieldIds = {};  // 'wind' -> { apparentWindAngle: field id, ... }
+    let derivedGroup = -1;
+
+    function loadSchema() {
+        if (derivedGroup >= 0) {
+            return;
+        }
+        for (let g = 0; g < Module._bc_group_count(); g++) {
+            const key = UTF8ToString(Module._bc_group_key(g));
+            groupIds[key] = g;
+            fieldIds[key] = {};
+        }
+        const groupKeys = Object.keys(groupIds);
+        for (let id = 0; id < Module._bc_field_count(); id++) {
+            fieldIds[groupKeys[Module._bc_field_group(id)]][UTF8ToString(Module._bc_field_key(id))] = id;
+        }
+        derivedGroup = groupIds['derived'];
+    }
+
+    function readGroup(key) {
+        const out = {};
+        const fields = fieldIds[key];
+        for (const name in fields) {
+            out[name] = Module._bc_get(fields[name]);
+        }
+        out.available = Module._bc_group_available(groupIds[key]) !== 0;
+        out.lastUpdate = Module._bc_group_last_update(groupIds[key]);
+        return out;
+    }
+
+    class BoatCalc {
+        constructor() {
+            loadSchema();
+        }
+
+        /// Clear values, filters and statistics (one engine per module instance)
+        reset() {
+            Module._bc_reset();
+        }
+
+        /// Leeway factor K and wind angle offset in radians, as /calibration.json
+        setCalibration(leewayK, windAngleOffsetRad) {
+            Module._bc_set_calibration(leewayK, windAngleOffsetRad);
+        }
+
+        /// { tws: 2, awa: 1, ... } as /calibration.json "damping"; false if a key or time was rejected
+        setDamping(damping) {
+            let ok = true;
+            for (const key in damping) {
+                ok = Module.ccall('bc_set_damping', 'number', ['string', 'number'], [key, damping[key]]) !== 0 && ok;
+            }
+            return ok;
+        }
+
+        /// Polar file text ('' removes it); throws with the parser's message on an error
+        loadPolar(text) {
+            if (!Module.ccall('bc_load_polar', 'number', ['string'], [text])) {
+                throw new Error('polar: ' + UTF8ToString(Module._bc_polar_error()));
+            }
+        }
+
+        /**
+         * Take the input groups of a /boatdata state (any subset). The derived
+         * group is skipped: it is what calculate() produces. JSON null is NaN.
+         */
+        update(state) {
+            for (const key in state) {
+                const group = groupIds[key];
+                const values = state[key];
+                if (group === undefined || group === derivedGroup || values === null || typeof values !== 'object') {
+                    continue;
+                }
+                const fields = fieldIds[key];
+                for (const name in values) {
+                    const id = fields[name];
+                    if (id !== undefined) {
+                        const value = values[name];
+                        Module._bc_set(id, value === null ? NaN : Number(value));
+                    }
+                }
+                if ('available' in values || 'lastUpdate' in values) {
+                    Module._bc_set_group(group, values.available ? 1 : 0, (values.lastUpdate || 0) >>> 0);
+                }
+            }
+        }
+
+        /// One calculation cycle at gateway time nowMs; the derived group (available false without inputs)
+        calculate(nowMs) {
+            Module._bc_calculate(nowMs >>> 0);
+            return readGroup('derived');
+        }
+
+        /// Current values of any group ('derived', 'wind', ...)
+        group(key) {
+            return fieldIds[key] ? readGroup(key) : null;
+        }
+    }
+
+    BoatCalc.normalize0To2Pi = (angle) => Module._bc_normalize_0_2pi(angle);
+    BoatCalc.normalizePi = (angle) => Module._bc_normalize_pi(angle);
+    BoatCalc.angleDifference = (a, b) => Module._bc_angle_difference(a, b);
+    return BoatCalc;
+})();
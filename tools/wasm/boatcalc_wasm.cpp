@@ -0,0 +1,196 @@
+/**
+ * @file boatcalc_wasm.cpp
+ * @brief C API of the on-device CalculationEngine for the WebAssembly build
+ *
+ * The firmware's derived-value code (CalculationEngine with its damping,
+ * statistics, input alignment and polar lookup, AngleUtils) compiled with
+ * Emscripten, so the dashboard and the Node viewer compute derived values
+ * from raw /boatdata fields with the same code as the ESP32 instead of a
+ * JavaScript re-implementation. boatcalc_post.js wraps this API in a
+ * BoatCalc class that takes decoded /boatdata frames.
+ *
+ * Build (host, env:wasm, needs Emscripten's emcc on PATH):
+ * @code
+ * pio run -e wasm
+ * # .pio/build/wasm/boatcalc.js + boatcalc.wasm
+ * @endcode
+ *
+ * One engine per module instance. Fields are addressed by BoatDataFieldId
+ * and groups by BoatDataSchemaGroupId, enumerated with bc_field_*() and
+ * bc_group_*(); values are in the stored units of /boatdata (radians,
+ * knots, meters). Time is the gateway's millis() clock of the frames
+ * (group lastUpdate), which the engine's input alignment compares.
+ *
+ * Results equal the firmware's for the same BOATDATA_FLOAT_STORAGE and
+ * CALC_FAST_MATH settings; with libm (CALC_FAST_MATH 0) the last bit of a
+ * trigonometric result can differ between the ESP32 and the browser's libm.
+ *
+ * @copyright 2025 Poseidon2
+ * @version 1.0.0
+ */
+
+#include <math.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "../../src/components/CalculationEngine.h"
+#include "../../src/utils/AngleUtils.h"
+#include "../../src/utils/BoatDataSchema.h"
+#include "../../src/utils/PolarTable.h"
+
+#ifdef __EMSCRIPTEN__
+#include <emscripten/emscripten.h>
+#define BC_EXPORT extern "C" EMSCRIPTEN_KEEPALIVE
+#else
+#define BC_EXPORT extern "C"
+#endif
+
+namespace {
+
+uint32_t clockMs = 0;  ///< nowMs of the latest bc_calculate()
+
+BoatDataStructure data;
+CalculationEngine engine;
+PolarTable polar;
+
+const char* const DAMPING_KEYS[] = {
+#define BOATCALC_DAMPING_KEY(id, key, kind) #key,
+    BOATDATA_DAMPING_FIELDS(BOATCALC_DAMPING_KEY)
+#undef BOATCALC_DAMPING_KEY
+};
+
+void resetData() {
+    CalibrationData calibration = data.calibration;
+    memset(&data, 0, sizeof(data));
+    data.calibration = calibration;
+}
+
+}  // namespace
+
+/// The engine's millis() (calculate() without a time) follows the frames' clock
+unsigned long millis() {
+    return clockMs;
+}
+
+/// Clear all values and the engine's filters and statistics (calibration and polar kept)
+BC_EXPORT void bc_reset() {
+    resetData();
+    engine = CalculationEngine();
+    engine.setPolar(polar.loaded() ? &polar : nullptr);
+}
+
+BC_EXPORT int bc_field_count() {
+    return BOATDATA_FIELD_COUNT;
+}
+
+BC_EXPORT const char* bc_field_key(int id) {
+    return id >= 0 && id < BOATDATA_FIELD_COUNT ? BoatDataSchema::fieldInfo(id).key : "";
+}
+
+BC_EXPORT int bc_field_group(int id) {
+    return id >= 0 && id < BOATDATA_FIELD_COUNT ? BoatDataSchema::fieldInfo(id).group : -1;
+}
+
+BC_EXPORT int bc_group_count() {
+    return BOATDATA_SCHEMA_GROUP_COUNT;
+}
+
+BC_EXPORT const char* bc_group_key(int group) {
+    return group >= 0 && group < BOATDATA_SCHEMA_GROUP_COUNT ? BoatDataSchema::groupInfo(group).key : "";
+}
+
+/// Field by group and member name; -1 if there is none
+BC_EXPORT int bc_find_field(const char* group, const char* key) {
+    uint8_t id = BoatDataSchema::findField(group, key);
+    return id < BOATDATA_FIELD_COUNT ? id : -1;
+}
+
+/// Store @p value into field @p id (NaN for a JSON null)
+BC_EXPORT void bc_set(int id, double value) {
+    if (id >= 0 && id < BOATDATA_FIELD_COUNT) {
+        BoatDataSchema::setValue(data, id, value);
+    }
+}
+
+BC_EXPORT double bc_get(int id) {
+    return id >= 0 && id < BOATDATA_FIELD_COUNT ? BoatDataSchema::getValue(data, id) : NAN;
+}
+
+/// A group's available flag and lastUpdate as received
+BC_EXPORT void bc_set_group(int group, int available, uint32_t lastUpdateMs) {
+    if (group < 0 || group >= BOATDATA_SCHEMA_GROUP_COUNT) {
+        return;
+    }
+    BoatDataSchema::stamp(data, group, lastUpdateMs);
+    BoatDataSchema::setAvailable(data, group, available != 0);
+}
+
+BC_EXPORT int bc_group_available(int group) {
+    return group >= 0 && group < BOATDATA_SCHEMA_GROUP_COUNT && BoatDataSchema::isAvailable(data, group);
+}
+
+BC_EXPORT uint32_t bc_group_last_update(int group) {
+    return group >= 0 && group < BOATDATA_SCHEMA_GROUP_COUNT
+        ? static_cast<uint32_t>(BoatDataSchema::lastUpdate(data, group)) : 0;
+}
+
+/// As /calibration.json: leeway factor K, wind angle offset in radians
+BC_EXPORT void bc_set_calibration(double leewayK, double windAngleOffsetRad) {
+    data.calibration.leewayCalibrationFactor = leewayK;
+    data.calibration.windAngleOffset = windAngleOffsetRad;
+    data.calibration.loaded = true;
+}
+
+/**
+ * @brief Damping time constant of one field ("tws", keys of /calibration.json "damping")
+ *
+ * @return 0 for an unknown key or a negative time
+ */
+BC_EXPORT int bc_set_damping(const char* key, double seconds) {
+    if (!(seconds >= 0.0) || seconds > DAMPING_MAX_TIME_CONSTANT_S) {
+        return 0;
+    }
+    for (uint8_t i = 0; i < DAMPING_FIELD_COUNT; i++) {
+        if (strcmp(DAMPING_KEYS[i], key) == 0) {
+            data.calibration.damping.timeConstant[i] = static_cast<float>(seconds);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * @brief Load a polar file's text (PolarTable formats); empty text removes the polar
+ *
+ * @return 0 on a parse error (bc_polar_error()), the polar is then off
+ */
+BC_EXPORT int bc_load_polar(const char* text) {
+    polar = PolarTable();
+    bool ok = text[0] == '\0' || polar.parse(text);
+    engine.setPolar(ok && polar.loaded() ? &polar : nullptr);
+    return ok;
+}
+
+BC_EXPORT const char* bc_polar_error() {
+    const char* error = polar.error();
+    return error != nullptr ? error : "";
+}
+
+/// One calculation cycle at @p nowMs (gateway clock); returns derived.available
+BC_EXPORT int bc_calculate(uint32_t nowMs) {
+    clockMs = nowMs;
+    engine.calculate(&data, nowMs);
+    return data.derived.available;
+}
+
+BC_EXPORT double bc_normalize_0_2pi(double angle) {
+    return AngleUtils::normalizeToZeroTwoPi(static_cast<BoatScalar>(angle));
+}
+
+BC_EXPORT double bc_normalize_pi(double angle) {
+    return AngleUtils::normalizeToPiMinusPi(static_cast<BoatScalar>(angle));
+}
+
+BC_EXPORT double bc_angle_difference(double a, double b) {
+    return AngleUtils::angleDifference(static_cast<BoatScalar>(a), static_cast<BoatScalar>(b));
+}
@@ -0,0 +1,23 @@
+# PlatformIO extra script of env:wasm: Emscripten instead of the host compiler,
+# linked into a modular boatcalc.js + boatcalc.wasm for browsers and Node.
+Import("env")
+
+env.Replace(CC="emcc", CXX="em++", LINK="em++", AR="emar", RANLIB="emranlib",
+            PROGNAME="boatcalc", PROGSUFFIX=".js")
+
+EXPORTS = ",".join("_" + name for name in (
+    "bc_reset", "bc_field_count", "bc_field_key", "bc_field_group", "bc_group_count",
+    "bc_group_key", "bc_find_field", "bc_set", "bc_get", "bc_set_group",
+    "bc_group_available", "bc_group_last_update", "bc_set_calibration", "bc_set_damping",
+    "bc_load_polar", "bc_polar_error", "bc_calculate", "bc_normalize_0_2pi",
+    "bc_normalize_pi", "bc_angle_difference", "malloc", "free"))
+
+env.Append(LINKFLAGS=[
+    "-sMODULARIZE=1",
+    "-sEXPORT_NAME=createBoatCalc",
+    "-sENVIRONMENT=web,node",
+    "-sALLOW_MEMORY_GROWTH=1",
+    "-sEXPORTED_FUNCTIONS=" + EXPORTS,
+    "-sEXPORTED_RUNTIME_METHODS=ccall,UTF8ToString",
+    "--post-js", env.File("#tools/wasm/boatcalc_post.js").abspath,
+])